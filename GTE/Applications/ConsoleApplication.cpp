@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Applications/GTApplicationsPCH.h>
 #include <Applications/ConsoleApplication.h>
@@ -12,14 +12,16 @@ using namespace gte;
 ConsoleApplication::Parameters::Parameters()
     :
     title(L""),
-    created(false)
+    created(false),
+    requireHardwareDevice(false)
 {
 }
 
 ConsoleApplication::Parameters::Parameters(std::wstring const& inTitle)
     :
     title(inTitle),
-    created(false)
+    created(false),
+    requireHardwareDevice(false)
 {
 }
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -22,6 +22,12 @@ namespace gte
 
             std::wstring title;
             bool created;
+
+            // The GPU compute programs must run on a hardware device. When
+            // set, the creation of the engine fails instead of using a
+            // software device such as WARP for DX11 or llvmpipe for the
+            // headless OpenGL engine. The default value is false.
+            bool requireHardwareDevice;
         };
 
     public:
@@ -0,0 +1,307 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Applications/GTApplicationsPCH.h>
+#include <Applications/FramePacer.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+using namespace gte;
+
+FramePacer::FramePacer()
+    :
+    mTargetFrameRate(0.0),
+    mRefreshRate(0.0),
+    mWakeMargin(0.0),
+    mFirstFrame(true),
+    mFixedTimeStep(0.0),
+    mAccumulator(0.0),
+    mFrameTime(0.0),
+    mMaxStepsPerFrame(8),
+    mNumSteps(0),
+    mStopSimulation(false),
+    mLastStepTime(0)
+{
+    mFrameStageTime.fill(0.0);
+    for (auto& averageTime : mAverageStageTime)
+    {
+        averageTime.store(0.0);
+    }
+}
+
+FramePacer::~FramePacer()
+{
+    StopSimulation();
+}
+
+void FramePacer::SetTargetFrameRate(double framesPerSecond)
+{
+    LogAssert(framesPerSecond >= 0.0, "Invalid frame rate.");
+    mTargetFrameRate = framesPerSecond;
+    mNextFrame = Clock::now();
+}
+
+void FramePacer::SetVerticalSync(double refreshRate, double wakeMargin)
+{
+    LogAssert(refreshRate >= 0.0 && wakeMargin >= 0.0, "Invalid input.");
+    mRefreshRate = refreshRate;
+    mWakeMargin = wakeMargin;
+    mNextFrame = Clock::now();
+}
+
+void FramePacer::SetFixedTimeStep(double seconds, unsigned int maxStepsPerFrame)
+{
+    LogAssert(!IsSimulating(), "The time step cannot change while the simulation thread runs.");
+    LogAssert(seconds >= 0.0 && maxStepsPerFrame > 0, "Invalid input.");
+    mFixedTimeStep = seconds;
+    mMaxStepsPerFrame = maxStepsPerFrame;
+    mAccumulator = 0.0;
+}
+
+double FramePacer::GetTimeUntilFrame() const
+{
+    if (mFirstFrame)
+    {
+        return 0.0;
+    }
+    return std::chrono::duration<double>(mNextFrame - Clock::now()).count();
+}
+
+void FramePacer::WaitForFrame()
+{
+    if (GetTimeUntilFrame() > 0.0)
+    {
+        BeginStage(STAGE_WAIT);
+        std::this_thread::sleep_until(mNextFrame);
+        EndStage(STAGE_WAIT);
+    }
+}
+
+void FramePacer::BeginFrame()
+{
+    Clock::time_point now = Clock::now();
+    if (mFirstFrame)
+    {
+        mFirstFrame = false;
+        mFrameTime = 0.0;
+        mNextFrame = now;
+    }
+    else
+    {
+        mFrameTime = std::chrono::duration<double>(now - mFrameStart).count();
+        UpdateAverage(STAGE_FRAME, mFrameTime);
+        for (int stage = STAGE_FRAME + 1; stage < NUM_STAGES; ++stage)
+        {
+            // The simulation thread measures its own steps.
+            if (stage != STAGE_SIMULATE || !IsSimulating())
+            {
+                UpdateAverage(stage, mFrameStageTime[stage]);
+            }
+        }
+    }
+    mFrameStageTime.fill(0.0);
+    mFrameStart = now;
+
+    // Without vertical synchronization, the deadlines are multiples of
+    // the frame period. A frame that starts more than a period late does
+    // not cause a burst of frames to catch up.
+    if (mRefreshRate == 0.0)
+    {
+        if (mTargetFrameRate > 0.0)
+        {
+            mNextFrame += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / mTargetFrameRate));
+            if (mNextFrame <= now)
+            {
+                mNextFrame = now + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(1.0 / mTargetFrameRate));
+            }
+        }
+        else
+        {
+            mNextFrame = now;
+        }
+    }
+
+    if (IsSimulating())
+    {
+        mNumSteps = 0;
+    }
+    else if (mFixedTimeStep > 0.0)
+    {
+        mAccumulator += mFrameTime;
+        double numSteps = std::floor(mAccumulator / mFixedTimeStep);
+        mAccumulator -= numSteps * mFixedTimeStep;
+        mNumSteps = static_cast<unsigned int>(std::min(numSteps, static_cast<double>(mMaxStepsPerFrame)));
+    }
+    else
+    {
+        mNumSteps = 1;
+    }
+}
+
+void FramePacer::EndFrame()
+{
+    // With vertical synchronization, the frame ends when the swap returns
+    // at a vertical blank. The next frame is presented n vertical blanks
+    // later, so it is started shortly after the vertical blank before
+    // that one. For n = 1 there is no sleep, because the swap paces the
+    // frames.
+    if (mRefreshRate > 0.0)
+    {
+        Clock::time_point now = Clock::now();
+        mNextFrame = now;
+        if (mTargetFrameRate > 0.0)
+        {
+            double n = std::max(std::floor(mRefreshRate / mTargetFrameRate + 0.5), 1.0);
+            if (n > 1.0)
+            {
+                mNextFrame += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>((n - 1.0) / mRefreshRate + mWakeMargin));
+            }
+        }
+    }
+}
+
+void FramePacer::RunSteps(std::function<void(double)> const& step)
+{
+    LogAssert(!IsSimulating(), "The simulation thread runs the steps.");
+    BeginStage(STAGE_SIMULATE);
+    if (mFixedTimeStep > 0.0)
+    {
+        for (unsigned int i = 0; i < mNumSteps; ++i)
+        {
+            step(mFixedTimeStep);
+        }
+    }
+    else
+    {
+        step(mFrameTime);
+    }
+    EndStage(STAGE_SIMULATE);
+}
+
+void FramePacer::StartSimulation(std::function<void(double)> const& step)
+{
+    LogAssert(!IsSimulating(), "The simulation thread is already running.");
+    LogAssert(mFixedTimeStep > 0.0, "The simulation thread requires a fixed time step.");
+    mStopSimulation = false;
+    mLastStepTime.store(Clock::now().time_since_epoch().count());
+    mSimulationThread = std::thread(&FramePacer::SimulationLoop, this, step);
+}
+
+void FramePacer::StopSimulation()
+{
+    if (IsSimulating())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mWakeMutex);
+            mStopSimulation = true;
+        }
+        mWake.notify_one();
+        mSimulationThread.join();
+    }
+}
+
+double FramePacer::GetInterpolation() const
+{
+    if (mFixedTimeStep == 0.0)
+    {
+        return 1.0;
+    }
+
+    double elapsed;
+    if (IsSimulating())
+    {
+        Clock::time_point lastStepTime{ Clock::duration(mLastStepTime.load()) };
+        elapsed = std::chrono::duration<double>(Clock::now() - lastStepTime).count();
+    }
+    else
+    {
+        elapsed = mAccumulator;
+    }
+    return std::min(std::max(elapsed / mFixedTimeStep, 0.0), 1.0);
+}
+
+void FramePacer::BeginStage(Stage stage)
+{
+    mStageStart[stage] = Clock::now();
+}
+
+void FramePacer::EndStage(Stage stage)
+{
+    mFrameStageTime[stage] += std::chrono::duration<double>(Clock::now() - mStageStart[stage]).count();
+}
+
+double FramePacer::GetStageTime(Stage stage) const
+{
+    return mAverageStageTime[stage].load();
+}
+
+std::string FramePacer::GetTimings() const
+{
+    char const* names[NUM_STAGES] =
+    {
+        "frame",
+        "events",
+        "wait",
+        "simulate",
+        "render"
+    };
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2);
+    for (int stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        stream << (stage > 0 ? ", " : "") << names[stage] << ": "
+            << 1000.0 * mAverageStageTime[stage].load() << " ms";
+    }
+    return stream.str();
+}
+
+void FramePacer::UpdateAverage(int stage, double seconds)
+{
+    // An exponential moving average over about 16 samples.
+    double average = mAverageStageTime[stage].load();
+    mAverageStageTime[stage].store(average + (seconds - average) / 16.0);
+}
+
+void FramePacer::SimulationLoop(std::function<void(double)> step)
+{
+    Clock::duration const timeStep = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(mFixedTimeStep));
+    Clock::duration const maxLag = timeStep * static_cast<int>(mMaxStepsPerFrame);
+
+    std::unique_lock<std::mutex> wakeLock(mWakeMutex);
+    Clock::time_point next{ Clock::duration(mLastStepTime.load()) };
+    for (;;)
+    {
+        next += timeStep;
+        if (mWake.wait_until(wakeLock, next, [this]() { return mStopSimulation; }))
+        {
+            break;
+        }
+
+        // When the steps take longer than the time step, the thread falls
+        // behind and runs the steps without sleeping. After maxLag, the
+        // time that cannot be simulated is dropped.
+        Clock::time_point start = Clock::now();
+        if (start - next > maxLag)
+        {
+            next = start;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mSimulationMutex);
+            step(mFixedTimeStep);
+            mLastStepTime.store(next.time_since_epoch().count());
+        }
+        UpdateAverage(STAGE_SIMULATE, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+}
@@ -0,0 +1,190 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// The frame pacing of a WindowApplication. The message pump calls OnIdle()
+// only when a frame is due according to the target frame rate, and between
+// frames it waits for window events instead of polling, so an application
+// that renders at 60 frames per second uses only the processor time needed
+// to draw 60 frames. The default target frame rate of 0 draws frames as
+// fast as possible, which is the behavior of the samples.
+//
+// The simulation can be advanced by a fixed time step independently of the
+// frame rate, either in OnIdle() by calling RunSteps() or in a thread of
+// its own started by StartSimulation(). In both cases GetInterpolation()
+// is the fraction of a time step by which the rendering time is past the
+// time of the last simulation step, to be used to interpolate between the
+// previous and current simulation states.
+//
+// When the application presents with vertical synchronization,
+// DisplayColorBuffer(1), the swap blocks until a vertical blank, which
+// already limits the frame rate to the refresh rate. Call
+// SetVerticalSync() with the refresh rate so that the pacer does not sleep
+// in addition to the swap. The frame deadlines are then measured from the
+// ends of the frames, when the swap returns at a vertical blank, and the
+// target frame rate is rounded to the refresh rate divided by an integer.
+// For example, a target of 30 frames per second on a 60 Hz display sleeps
+// until shortly after the first vertical blank, so the frame is presented
+// at the second one.
+
+namespace gte
+{
+    class FramePacer
+    {
+    public:
+        // The stages whose times are measured. STAGE_FRAME is the time
+        // between the starts of consecutive frames. STAGE_EVENTS and
+        // STAGE_WAIT are measured by the message pump. STAGE_SIMULATE is
+        // measured by RunSteps() and by the simulation thread, and
+        // STAGE_RENDER is measured by the application calling BeginStage()
+        // and EndStage() around its drawing.
+        enum Stage
+        {
+            STAGE_FRAME,
+            STAGE_EVENTS,
+            STAGE_WAIT,
+            STAGE_SIMULATE,
+            STAGE_RENDER,
+            NUM_STAGES
+        };
+
+        FramePacer();
+        ~FramePacer();
+
+        // The target frame rate in frames per second. A rate of 0 draws
+        // frames as fast as possible.
+        void SetTargetFrameRate(double framesPerSecond);
+
+        inline double GetTargetFrameRate() const
+        {
+            return mTargetFrameRate;
+        }
+
+        // The refresh rate of the display when the application presents
+        // with vertical synchronization, 0 otherwise. The wake margin is
+        // the time after a vertical blank at which a frame that must be
+        // presented at a later vertical blank is started.
+        void SetVerticalSync(double refreshRate, double wakeMargin = 0.001);
+
+        inline double GetRefreshRate() const
+        {
+            return mRefreshRate;
+        }
+
+        // The fixed time step of the simulation in seconds. A time step of
+        // 0 advances the simulation once per frame by the time between
+        // frames. When the simulation falls behind by more than
+        // maxStepsPerFrame steps, the time that cannot be simulated is
+        // dropped, so a slow simulation runs slower than real time instead
+        // of taking longer and longer to catch up.
+        void SetFixedTimeStep(double seconds, unsigned int maxStepsPerFrame = 8);
+
+        inline double GetFixedTimeStep() const
+        {
+            return mFixedTimeStep;
+        }
+
+        inline unsigned int GetMaxStepsPerFrame() const
+        {
+            return mMaxStepsPerFrame;
+        }
+
+        // The frames, which are started and ended by the message pump. An
+        // application with its own loop instead calls WaitForFrame(),
+        // BeginFrame() and EndFrame() for each frame. The time until the
+        // next frame is nonpositive when a frame is due.
+        double GetTimeUntilFrame() const;
+        void WaitForFrame();
+        void BeginFrame();
+        void EndFrame();
+
+        // The simulation in OnIdle(). The function RunSteps() calls
+        // step(dt) for each fixed time step due in the current frame, or
+        // once with the time since the previous frame when the time step
+        // is 0.
+        inline unsigned int GetNumSteps() const
+        {
+            return mNumSteps;
+        }
+
+        void RunSteps(std::function<void(double)> const& step);
+
+        // The simulation in a thread of its own, which calls step(dt) at
+        // the times of the fixed time steps and sleeps in between. Each
+        // call is made while the simulation mutex is locked, so OnIdle()
+        // must lock the mutex while it reads the simulation state. The
+        // fixed time step must be positive, and it cannot be changed while
+        // the thread is running.
+        void StartSimulation(std::function<void(double)> const& step);
+        void StopSimulation();
+
+        inline bool IsSimulating() const
+        {
+            return mSimulationThread.joinable();
+        }
+
+        inline std::mutex& GetSimulationMutex()
+        {
+            return mSimulationMutex;
+        }
+
+        // The interpolation parameter in [0,1] for the state of the
+        // simulation at the current time. For the simulation thread, call
+        // this function while the simulation mutex is locked so that the
+        // parameter is consistent with the state.
+        double GetInterpolation() const;
+
+        // The stage times are averages over recent frames, measured in
+        // seconds per frame except for STAGE_SIMULATE of the simulation
+        // thread, which is measured in seconds per step.
+        void BeginStage(Stage stage);
+        void EndStage(Stage stage);
+        double GetStageTime(Stage stage) const;
+
+        // For convenience in displaying the stage times in milliseconds.
+        std::string GetTimings() const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void UpdateAverage(int stage, double seconds);
+        void SimulationLoop(std::function<void(double)> step);
+
+        // Frame pacing.
+        double mTargetFrameRate, mRefreshRate, mWakeMargin;
+        Clock::time_point mNextFrame, mFrameStart;
+        bool mFirstFrame;
+
+        // Fixed-step simulation. The time of the last simulation step of
+        // the thread is stored as ticks of the clock, because it is
+        // read by the thread that renders.
+        double mFixedTimeStep, mAccumulator, mFrameTime;
+        unsigned int mMaxStepsPerFrame, mNumSteps;
+        std::thread mSimulationThread;
+        std::mutex mSimulationMutex, mWakeMutex;
+        std::condition_variable mWake;
+        bool mStopSimulation;
+        std::atomic<int64_t> mLastStepTime;
+
+        // Stage times. The times of a frame are accumulated and then
+        // averaged when the next frame begins.
+        std::array<Clock::time_point, NUM_STAGES> mStageStart;
+        std::array<double, NUM_STAGES> mFrameStageTime;
+        std::array<std::atomic<double>, NUM_STAGES> mAverageStageTime;
+    };
+}
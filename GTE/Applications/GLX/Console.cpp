@@ -3,17 +3,19 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Applications/GTApplicationsPCH.h>
 #include <Applications/GLX/Console.h>
+#include <cstdlib>
 using namespace gte;
 
 Console::Parameters::Parameters()
     :
     display(nullptr),
     window(0),
-    deviceCreationFlags(0)
+    deviceCreationFlags(0),
+    headless(std::getenv("DISPLAY") == nullptr)
 {
 }
 
@@ -22,7 +24,8 @@ Console::Parameters::Parameters(std::wstring const& inTitle)
     ConsoleApplication::Parameters(inTitle),
     display(nullptr),
     window(0),
-    deviceCreationFlags(0)
+    deviceCreationFlags(0),
+    headless(std::getenv("DISPLAY") == nullptr)
 {
 }
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -28,6 +28,11 @@ namespace gte
             _XDisplay* display;
             unsigned long window;
             unsigned int deviceCreationFlags;
+
+            // Create the engine through EGL without a window, so that no X
+            // server is required. The default value is true when the
+            // DISPLAY environment variable is not set, as on batch servers.
+            bool headless;
         };
 
     public:
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Applications/GTApplicationsPCH.h>
 #include <Applications/GLX/Console.h>
@@ -21,6 +21,13 @@ void ConsoleSystem::CreateEngineAndProgramFactory(Console::Parameters& parameter
     auto engine = std::make_shared<DX11Engine>(nullptr, D3D_DRIVER_TYPE_HARDWARE,
         nullptr, parameters.deviceCreationFlags);
 
+    // DX11Engine falls back to WARP when the only adapter is the software
+    // adapter.
+    if (parameters.requireHardwareDevice && engine->GetDriverType() == D3D_DRIVER_TYPE_WARP)
+    {
+        LogError("A hardware device is required.");
+    }
+
     if (engine->GetDevice())
     {
         parameters.engine = engine;
@@ -61,6 +68,23 @@ void ConsoleSystem::CreateEngineAndProgramFactory(Console::Parameters& parameter
 #if defined(GTE_USE_LINUX)
 void ConsoleSystem::CreateEngineAndProgramFactory(Console::Parameters& parameters)
 {
+    if (parameters.headless)
+    {
+        bool saveDriverInfo = ((parameters.deviceCreationFlags & 0x00000001) != 0);
+        auto engine = std::make_shared<EGLEngine>(parameters.requireHardwareDevice, saveDriverInfo);
+        if (!engine->MeetsRequirements())
+        {
+            LogError("OpenGL 4.5 or later is required.");
+        }
+
+        parameters.display = nullptr;
+        parameters.window = 0;
+        parameters.engine = engine;
+        parameters.factory = std::make_shared<GLSLProgramFactory>();
+        parameters.created = true;
+        return;
+    }
+
     // The construction of GLXEngine requires a depth24-stencil8 buffer
     // in order for X Windows to succeed in the call to glXChooseVisual.
     bool saveDriverInfo = ((parameters.deviceCreationFlags & 0x00000001) != 0);
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Applications/GTApplicationsPCH.h>
 #include <Applications/GLX/Window.h>
 #include <X11/Xlib.h>
+#include <sys/select.h>
 
 // XWindows has a Window data structure, so the implementations of the
 // Geometric Tools class Window must be enclosed in "namespace gte".
@@ -84,6 +85,29 @@ namespace gte
         XDestroyWindow(mDisplay, mWindow);
     }
 
+    void Window::WaitForEvent(double timeout)
+    {
+        // The events are read from the connection to the X server, so
+        // waiting for the connection to be readable does not poll.
+        // ProcessedEvent() has called XPending, which flushes the output
+        // buffer and reads the events that have already arrived.
+        int connection = ConnectionNumber(mDisplay);
+        fd_set readSet;
+        FD_ZERO(&readSet);
+        FD_SET(connection, &readSet);
+        if (timeout >= 0.0)
+        {
+            timeval interval;
+            interval.tv_sec = static_cast<time_t>(timeout);
+            interval.tv_usec = static_cast<suseconds_t>(1000000.0 * (timeout - static_cast<double>(interval.tv_sec)));
+            select(connection + 1, &readSet, nullptr, nullptr, &interval);
+        }
+        else
+        {
+            select(connection + 1, &readSet, nullptr, nullptr, nullptr);
+        }
+    }
+
     int Window::ProcessedEvent()
     {
         if (!XPending(mDisplay))
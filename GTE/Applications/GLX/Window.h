@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -60,6 +60,10 @@ namespace gte
         };
         int ProcessedEvent();
 
+        // Block until an event is pending or the timeout in seconds has
+        // elapsed. A negative timeout waits indefinitely.
+        void WaitForEvent(double timeout);
+
     protected:
         _XDisplay* mDisplay;
         unsigned long mWindow;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -91,9 +91,15 @@ namespace gte
         {
             window->ShowWindow();
 
+            // Between frames the pump waits for events instead of polling
+            // for them. The wait ends when an event arrives or when the
+            // frame pacer reports that the next frame is due.
+            FramePacer& pacer = window->GetFramePacer();
             for (;;)
             {
+                pacer.BeginStage(FramePacer::STAGE_EVENTS);
                 int result = window->ProcessedEvent();
+                pacer.EndStage(FramePacer::STAGE_EVENTS);
                 if (result == Window::EVT_QUIT)
                 {
                     return;
@@ -101,12 +107,24 @@ namespace gte
 
                 if (result == Window::EVT_NONE_PENDING)
                 {
-                    if (!(flags & NO_IDLE_LOOP))
+                    if ((flags & NO_IDLE_LOOP) || window->IsMinimized())
                     {
-                        if (!window->IsMinimized())
-                        {
-                            window->OnIdle();
-                        }
+                        window->WaitForEvent(-1.0);
+                        continue;
+                    }
+
+                    double timeUntilFrame = pacer.GetTimeUntilFrame();
+                    if (timeUntilFrame > 0.0)
+                    {
+                        pacer.BeginStage(FramePacer::STAGE_WAIT);
+                        window->WaitForEvent(timeUntilFrame);
+                        pacer.EndStage(FramePacer::STAGE_WAIT);
+                    }
+                    else
+                    {
+                        pacer.BeginFrame();
+                        window->OnIdle();
+                        pacer.EndFrame();
                     }
                 }
             }
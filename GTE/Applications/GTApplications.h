@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -14,6 +14,7 @@
 #include <Applications/Console.h>
 #include <Applications/ConsoleApplication.h>
 #include <Applications/Environment.h>
+#include <Applications/FramePacer.h>
 #include <Applications/LogReporter.h>
 #include <Applications/OnIdleTimer.h>
 #include <Applications/Timer.h>
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Applications/GTApplicationsPCH.h>
 #include <Applications/MSW/Console.h>
@@ -21,6 +21,13 @@ void ConsoleSystem::CreateEngineAndProgramFactory(Console::Parameters& parameter
     auto engine = std::make_shared<DX11Engine>(nullptr, D3D_DRIVER_TYPE_HARDWARE,
         nullptr, parameters.deviceCreationFlags);
 
+    // DX11Engine falls back to WARP when the only adapter is the software
+    // adapter.
+    if (parameters.requireHardwareDevice && engine->GetDriverType() == D3D_DRIVER_TYPE_WARP)
+    {
+        LogError("A hardware device is required.");
+    }
+
     if (engine->GetDevice())
     {
         parameters.engine = engine;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -73,15 +73,18 @@ namespace gte
                 ShowWindow(handle, SW_SHOW);
                 UpdateWindow(handle);
 
+                // Between frames the pump waits for messages instead of
+                // polling for them. The wait ends when a message arrives or
+                // when the frame pacer reports that the next frame is due.
+                // The timeout is rounded down to milliseconds, so the pump
+                // polls only during the last millisecond before a frame.
+                FramePacer& pacer = window->GetFramePacer();
                 for (;;)
                 {
-                    if (flags & NO_IDLE_LOOP)
-                    {
-                        WaitMessage();
-                    }
-
                     MSG msg;
-                    if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+                    pacer.BeginStage(FramePacer::STAGE_EVENTS);
+                    BOOL hasMessage = PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE);
+                    if (hasMessage)
                     {
                         if (msg.message == WM_QUIT)
                         {
@@ -91,14 +94,29 @@ namespace gte
                         TranslateMessage(&msg);
                         DispatchMessage(&msg);
                     }
-                    else
+                    pacer.EndStage(FramePacer::STAGE_EVENTS);
+
+                    if (!hasMessage)
                     {
-                        if (!(flags & NO_IDLE_LOOP))
+                        if ((flags & NO_IDLE_LOOP) || window->IsMinimized())
+                        {
+                            WaitMessage();
+                            continue;
+                        }
+
+                        double timeUntilFrame = pacer.GetTimeUntilFrame();
+                        if (timeUntilFrame > 0.0)
+                        {
+                            pacer.BeginStage(FramePacer::STAGE_WAIT);
+                            MsgWaitForMultipleObjects(0, nullptr, FALSE,
+                                static_cast<DWORD>(1000.0 * timeUntilFrame), QS_ALLINPUT);
+                            pacer.EndStage(FramePacer::STAGE_WAIT);
+                        }
+                        else
                         {
-                            if (!window->IsMinimized())
-                            {
-                                window->OnIdle();
-                            }
+                            pacer.BeginFrame();
+                            window->OnIdle();
+                            pacer.EndFrame();
                         }
                     }
                 }
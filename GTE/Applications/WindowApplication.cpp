@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Applications/GTApplicationsPCH.h>
 #include <Applications/WindowApplication.h>
@@ -18,7 +18,8 @@ WindowApplication::Parameters::Parameters()
     ySize(0),
     allowResize(false),
     useDepth24Stencil8(true),
-    created(false)
+    created(false),
+    targetFrameRate(0.0)
 {
 }
 
@@ -32,7 +33,8 @@ WindowApplication::Parameters::Parameters(std::wstring const& inTitle,
     ySize(inYSize),
     allowResize(false),
     useDepth24Stencil8(true),
-    created(false)
+    created(false),
+    targetFrameRate(0.0)
 {
 }
 
@@ -48,6 +50,7 @@ WindowApplication::WindowApplication(Parameters& parameters)
     mIsMinimized(false),
     mIsMaximized(false)
 {
+    mPacer.SetTargetFrameRate(parameters.targetFrameRate);
 }
 
 void WindowApplication::OnMove(int x, int y)
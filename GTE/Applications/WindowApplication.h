@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Applications/Application.h>
+#include <Applications/FramePacer.h>
 #include <Applications/OnIdleTimer.h>
 
 namespace gte
@@ -25,6 +26,10 @@ namespace gte
             std::wstring title;
             int xOrigin, yOrigin, xSize, ySize;
             bool allowResize, useDepth24Stencil8, created;
+
+            // The target frame rate of the FramePacer. The default of 0
+            // calls OnIdle() as often as possible.
+            double targetFrameRate;
         };
 
     public:
@@ -80,6 +85,13 @@ namespace gte
             return static_cast<float>(mXSize) / static_cast<float>(mYSize);
         }
 
+        // The message pump calls OnIdle() when the frame pacer reports that
+        // a frame is due.
+        inline FramePacer& GetFramePacer()
+        {
+            return mPacer;
+        }
+
         // Display callbacks.
         virtual void OnMove(int x, int y);
         virtual bool OnResize(int xSize, int ySize);
@@ -174,5 +186,6 @@ namespace gte
         bool mIsMaximized;
 
         OnIdleTimer mTimer;
+        FramePacer mPacer;
     };
 }
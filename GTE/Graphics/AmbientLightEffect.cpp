@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/AmbientLightEffect.h>
@@ -43,10 +43,20 @@ void AmbientLightEffect::UpdateLightingConstant()
 
 std::string const AmbientLightEffect::msGLSLVSSource =
 R"(
+#if GTE_USE_PVW_BATCH
+    uniform PVWMatrix
+    {
+        uvec4 pvwIndex;
+    };
+
+    buffer pvwMatrices { mat4 data[]; } pvwMatricesSB;
+#define pvwMatrix pvwMatricesSB.data[pvwIndex.x]
+#else
     uniform PVWMatrix
     {
         mat4 pvwMatrix;
     };
+#endif
 
     uniform Material
     {
@@ -61,17 +71,31 @@ R"(
     };
 
     layout(location = 0) in vec3 modelPosition;
+#if GTE_USE_INSTANCING
+    layout(location = 1) in vec4 instanceRow0;
+    layout(location = 2) in vec4 instanceRow1;
+    layout(location = 3) in vec4 instanceRow2;
+#endif
     layout(location = 0) out vec4 vertexColor;
 
     void main()
     {
+    #if GTE_USE_INSTANCING
+        vec3 position = vec3(
+            dot(instanceRow0, vec4(modelPosition, 1.0f)),
+            dot(instanceRow1, vec4(modelPosition, 1.0f)),
+            dot(instanceRow2, vec4(modelPosition, 1.0f)));
+    #else
+        vec3 position = modelPosition;
+    #endif
+
         vec3 ambient = lightingAttenuation.w * lightingAmbient.rgb;
         vertexColor.rgb = materialEmissive.rgb + materialAmbient.rgb * ambient;
         vertexColor.a = 1.0f;
     #if GTE_USE_MAT_VEC
-        gl_Position = pvwMatrix * vec4(modelPosition, 1.0f);
+        gl_Position = pvwMatrix * vec4(position, 1.0f);
     #else
-        gl_Position = vec4(modelPosition, 1.0f) * pvwMatrix;
+        gl_Position = vec4(position, 1.0f) * pvwMatrix;
     #endif
     };
 )";
@@ -89,10 +113,20 @@ R"(
 
 std::string const AmbientLightEffect::msHLSLVSSource =
 R"(
+#if GTE_USE_PVW_BATCH
+    cbuffer PVWMatrix
+    {
+        uint4 pvwIndex;
+    };
+
+    StructuredBuffer<float4x4> pvwMatrices;
+#define pvwMatrix pvwMatrices[pvwIndex.x]
+#else
     cbuffer PVWMatrix
     {
         float4x4 pvwMatrix;
     };
+#endif
 
     cbuffer Material
     {
@@ -109,6 +143,11 @@ R"(
     struct VS_INPUT
     {
         float3 modelPosition : POSITION;
+    #if GTE_USE_INSTANCING
+        float4 instanceRow0 : TEXCOORD5;
+        float4 instanceRow1 : TEXCOORD6;
+        float4 instanceRow2 : TEXCOORD7;
+    #endif
     };
 
     struct VS_OUTPUT
@@ -119,6 +158,13 @@ R"(
 
     VS_OUTPUT VSMain(VS_INPUT input)
     {
+    #if GTE_USE_INSTANCING
+        input.modelPosition = float3(
+            dot(input.instanceRow0, float4(input.modelPosition, 1.0f)),
+            dot(input.instanceRow1, float4(input.modelPosition, 1.0f)),
+            dot(input.instanceRow2, float4(input.modelPosition, 1.0f)));
+    #endif
+
         VS_OUTPUT output;
 
         float3 ambient = lightingAttenuation.w * lightingAmbient.rgb;
@@ -0,0 +1,223 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/AnimationClip.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/SlerpEstimate.h>
+#include <algorithm>
+using namespace gte;
+
+AnimationClip::AnimationClip()
+    :
+    mTranslationOffsets(1, 0),
+    mRotationOffsets(1, 0),
+    mScaleOffsets(1, 0)
+{
+}
+
+int AnimationClip::AddTrack(int numTranslations, float const* translationTimes,
+    Vector4<float> const* translations, int numRotations,
+    float const* rotationTimes, Quaternion<float> const* rotations,
+    int numScales, float const* scaleTimes, float const* scales)
+{
+    LogAssert(numTranslations >= 0 && numRotations >= 0 && numScales >= 0,
+        "Invalid number of keys.");
+    LogAssert((numTranslations == 0 || std::is_sorted(translationTimes, translationTimes + numTranslations))
+        && (numRotations == 0 || std::is_sorted(rotationTimes, rotationTimes + numRotations))
+        && (numScales == 0 || std::is_sorted(scaleTimes, scaleTimes + numScales)),
+        "The key times must be increasing.");
+
+    for (int i = 0; i < numTranslations; ++i)
+    {
+        mTranslationTimes.push_back(translationTimes[i]);
+        mTranslationX.push_back(translations[i][0]);
+        mTranslationY.push_back(translations[i][1]);
+        mTranslationZ.push_back(translations[i][2]);
+    }
+    mTranslationOffsets.push_back(static_cast<int>(mTranslationTimes.size()));
+
+    // Negate rotations as needed so that consecutive keys form an acute
+    // angle, the restriction of SLERP<float>::EstimateR.
+    Quaternion<float> previous;
+    for (int i = 0; i < numRotations; ++i)
+    {
+        Quaternion<float> q = rotations[i];
+        if (i > 0 && Dot(previous, q) < 0.0f)
+        {
+            q = -q;
+        }
+        mRotationTimes.push_back(rotationTimes[i]);
+        mRotationX.push_back(q[0]);
+        mRotationY.push_back(q[1]);
+        mRotationZ.push_back(q[2]);
+        mRotationW.push_back(q[3]);
+        previous = q;
+    }
+    mRotationOffsets.push_back(static_cast<int>(mRotationTimes.size()));
+
+    for (int i = 0; i < numScales; ++i)
+    {
+        mScaleTimes.push_back(scaleTimes[i]);
+        mScales.push_back(scales[i]);
+    }
+    mScaleOffsets.push_back(static_cast<int>(mScaleTimes.size()));
+
+    return GetNumTracks() - 1;
+}
+
+int AnimationClip::AddTrack(KeyframeController& controller)
+{
+    return AddTrack(
+        controller.GetNumTranslations(), controller.GetTranslationTimes(), controller.GetTranslations(),
+        controller.GetNumRotations(), controller.GetRotationTimes(), controller.GetRotations(),
+        controller.GetNumScales(), controller.GetScaleTimes(), controller.GetScales());
+}
+
+void AnimationClip::GetTimeRange(int track, float& minTime, float& maxTime) const
+{
+    bool hasKeys = false;
+    minTime = 0.0f;
+    maxTime = 0.0f;
+    auto include = [&](std::vector<int> const& offsets, std::vector<float> const& times)
+    {
+        if (offsets[track + 1] > offsets[track])
+        {
+            float first = times[offsets[track]];
+            float last = times[offsets[track + 1] - 1];
+            minTime = (hasKeys ? std::min(minTime, first) : first);
+            maxTime = (hasKeys ? std::max(maxTime, last) : last);
+            hasKeys = true;
+        }
+    };
+    include(mTranslationOffsets, mTranslationTimes);
+    include(mRotationOffsets, mRotationTimes);
+    include(mScaleOffsets, mScaleTimes);
+}
+
+bool AnimationClip::GetTranslation(int track, float time, Cursor& cursor,
+    Vector4<float>& translation) const
+{
+    int const first = mTranslationOffsets[track];
+    int const numKeys = mTranslationOffsets[track + 1] - first;
+    if (numKeys == 0)
+    {
+        return false;
+    }
+
+    float normTime;
+    int i0, i1;
+    GetKeyInfo(time, numKeys, &mTranslationTimes[first], cursor.translation, normTime, i0, i1);
+    i0 += first;
+    i1 += first;
+    translation[0] = mTranslationX[i0] + normTime * (mTranslationX[i1] - mTranslationX[i0]);
+    translation[1] = mTranslationY[i0] + normTime * (mTranslationY[i1] - mTranslationY[i0]);
+    translation[2] = mTranslationZ[i0] + normTime * (mTranslationZ[i1] - mTranslationZ[i0]);
+    translation[3] = 0.0f;
+    return true;
+}
+
+bool AnimationClip::GetRotation(int track, float time, Cursor& cursor,
+    Quaternion<float>& rotation) const
+{
+    float normTime;
+    int i0, i1;
+    if (!GetRotationKeys(track, time, cursor, i0, i1, normTime))
+    {
+        return false;
+    }
+
+    if (i0 == i1)
+    {
+        rotation = GetRotationKey(i0);
+    }
+    else
+    {
+        rotation = SLERP<float>::EstimateR<SLERP_DEGREE>(normTime,
+            GetRotationKey(i0), GetRotationKey(i1));
+    }
+    return true;
+}
+
+bool AnimationClip::GetScale(int track, float time, Cursor& cursor, float& scale) const
+{
+    int const first = mScaleOffsets[track];
+    int const numKeys = mScaleOffsets[track + 1] - first;
+    if (numKeys == 0)
+    {
+        return false;
+    }
+
+    float normTime;
+    int i0, i1;
+    GetKeyInfo(time, numKeys, &mScaleTimes[first], cursor.scale, normTime, i0, i1);
+    i0 += first;
+    i1 += first;
+    scale = mScales[i0] + normTime * (mScales[i1] - mScales[i0]);
+    return true;
+}
+
+bool AnimationClip::GetRotationKeys(int track, float time, Cursor& cursor,
+    int& i0, int& i1, float& normTime) const
+{
+    int const first = mRotationOffsets[track];
+    int const numKeys = mRotationOffsets[track + 1] - first;
+    if (numKeys == 0)
+    {
+        return false;
+    }
+
+    GetKeyInfo(time, numKeys, &mRotationTimes[first], cursor.rotation, normTime, i0, i1);
+    i0 += first;
+    i1 += first;
+    return true;
+}
+
+void AnimationClip::GetKeyInfo(float time, int numTimes, float const* times,
+    int& cursor, float& normTime, int& i0, int& i1)
+{
+    if (time <= times[0])
+    {
+        cursor = 0;
+        normTime = 0.0f;
+        i0 = 0;
+        i1 = 0;
+        return;
+    }
+
+    if (time >= times[numTimes - 1])
+    {
+        cursor = numTimes - 1;
+        normTime = 0.0f;
+        i0 = cursor;
+        i1 = cursor;
+        return;
+    }
+
+    // Now times[0] < time < times[numTimes-1], so the key interval
+    // [times[i], times[i+1]) containing the time exists.
+    int i = std::min(cursor, numTimes - 2);
+    if (times[i] <= time && time < times[i + 1])
+    {
+        // The time is in the interval of the previous lookup.
+    }
+    else if (i + 2 < numTimes && times[i + 1] <= time && time < times[i + 2])
+    {
+        // The time is in the next interval, the typical case when the
+        // time increases by less than the time between keys.
+        ++i;
+    }
+    else
+    {
+        i = static_cast<int>(std::upper_bound(times, times + numTimes, time) - times) - 1;
+    }
+
+    cursor = i;
+    i0 = i;
+    i1 = i + 1;
+    normTime = (time - times[i0]) / (times[i1] - times[i0]);
+}
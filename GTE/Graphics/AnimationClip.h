@@ -0,0 +1,137 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/KeyframeController.h>
+#include <vector>
+
+// The keyframes of an animation stored as structure-of-arrays, for crowds
+// of characters that play the same animations. A clip has one track per
+// animated node (a bone of a skeleton, for example), and each track has
+// translation, rotation and uniform-scale channels with the semantics of
+// KeyframeController. The keys of all the tracks of a channel are stored in
+// contiguous arrays of times and of components (x, y, z and w of the
+// rotations in separate arrays), the keys of track k being those with
+// indices offsets[k] through offsets[k+1]-1. The clip is shared by the
+// ClipController objects that play it, each of which stores only a track
+// index and its cursors into the key arrays.
+//
+// The rotations of each track are preprocessed so that consecutive keys
+// form an angle of at most pi/2, which allows the slerp to be computed by
+// the polynomial estimate of ChebyshevRatio, either one at a time or four
+// at a time by AnimationEvaluator.
+
+namespace gte
+{
+    class AnimationClip
+    {
+    public:
+        // The key indices of the previous evaluation of a track, relative
+        // to the first key of the track. For a sequence of increasing
+        // times, they make the key lookup O(1).
+        struct Cursor
+        {
+            Cursor()
+                :
+                translation(0),
+                rotation(0),
+                scale(0)
+            {
+            }
+
+            int translation, rotation, scale;
+        };
+
+        // Construction. The clip is created empty and the tracks are added
+        // by AddTrack.
+        AnimationClip();
+
+        // Add a track and return its index. The times of each channel must
+        // be increasing. A channel with no keys is not animated; the
+        // ClipController keeps that channel of its local transform.
+        int AddTrack(int numTranslations, float const* translationTimes,
+            Vector4<float> const* translations, int numRotations,
+            float const* rotationTimes, Quaternion<float> const* rotations,
+            int numScales, float const* scaleTimes, float const* scales);
+
+        // Add a track with the keys of a KeyframeController.
+        int AddTrack(KeyframeController& controller);
+
+        // Member access.
+        inline int GetNumTracks() const
+        {
+            return static_cast<int>(mTranslationOffsets.size()) - 1;
+        }
+
+        inline bool HasTranslations(int track) const
+        {
+            return mTranslationOffsets[track + 1] > mTranslationOffsets[track];
+        }
+
+        inline bool HasRotations(int track) const
+        {
+            return mRotationOffsets[track + 1] > mRotationOffsets[track];
+        }
+
+        inline bool HasScales(int track) const
+        {
+            return mScaleOffsets[track + 1] > mScaleOffsets[track];
+        }
+
+        // The smallest and largest key times of a track, which are 0 for a
+        // track without keys.
+        void GetTimeRange(int track, float& minTime, float& maxTime) const;
+
+        // Evaluate the channels of a track at the specified time. Each
+        // function returns false, and does not modify its output, when the
+        // track does not have the channel.
+        bool GetTranslation(int track, float time, Cursor& cursor,
+            Vector4<float>& translation) const;
+
+        bool GetRotation(int track, float time, Cursor& cursor,
+            Quaternion<float>& rotation) const;
+
+        bool GetScale(int track, float time, Cursor& cursor, float& scale) const;
+
+        // Support for AnimationEvaluator. Look up the rotation keys i0 and
+        // i1 (absolute indices) and the interpolation parameter in [0,1].
+        // When the time is outside the key times, i0 = i1.
+        bool GetRotationKeys(int track, float time, Cursor& cursor,
+            int& i0, int& i1, float& normTime) const;
+
+        inline Quaternion<float> GetRotationKey(int i) const
+        {
+            return Quaternion<float>(mRotationX[i], mRotationY[i], mRotationZ[i], mRotationW[i]);
+        }
+
+        // The degree of the slerp estimate. The maximum error of the
+        // quaternion components is about 3e-7 for this degree, compared to
+        // about 4e-5 for degree 8.
+        static int constexpr SLERP_DEGREE = 16;
+
+    private:
+        // Look up the keys first+i0 and first+i1 for the time, as
+        // KeyframeController::GetKeyInfo does. The cursor is the i0 of the
+        // previous lookup; a binary search is used when the time is not in
+        // the interval of the cursor or the next one.
+        static void GetKeyInfo(float time, int numTimes, float const* times,
+            int& cursor, float& normTime, int& i0, int& i1);
+
+        std::vector<int> mTranslationOffsets;
+        std::vector<float> mTranslationTimes;
+        std::vector<float> mTranslationX, mTranslationY, mTranslationZ;
+
+        std::vector<int> mRotationOffsets;
+        std::vector<float> mRotationTimes;
+        std::vector<float> mRotationX, mRotationY, mRotationZ, mRotationW;
+
+        std::vector<int> mScaleOffsets;
+        std::vector<float> mScaleTimes;
+        std::vector<float> mScales;
+    };
+}
@@ -0,0 +1,136 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/AnimationEvaluator.h>
+#include <Mathematics/ChebyshevRatio.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+using namespace gte;
+
+void AnimationEvaluator::Attach(std::shared_ptr<ClipController> const& controller)
+{
+    LogAssert(controller != nullptr, "Invalid input.");
+    mControllers.push_back(controller);
+}
+
+void AnimationEvaluator::Detach(std::shared_ptr<ClipController> const& controller)
+{
+    auto iter = std::find(mControllers.begin(), mControllers.end(), controller);
+    if (iter != mControllers.end())
+    {
+        mControllers.erase(iter);
+    }
+}
+
+void AnimationEvaluator::DetachAll()
+{
+    mControllers.clear();
+}
+
+size_t AnimationEvaluator::Update(double applicationTime)
+{
+    mEvaluated.clear();
+    mControlTime.clear();
+    mSlerpController.clear();
+    mNormTime.clear();
+    for (int c = 0; c < 4; ++c)
+    {
+        mQ0[c].clear();
+        mQ1[c].clear();
+    }
+
+    // Look up the keys of the controllers whose times have changed. The
+    // translations and scales are interpolated here, and the rotations
+    // that need a slerp are gathered.
+    for (auto const& controller : mControllers)
+    {
+        float ctrlTime;
+        if (!controller->BeginUpdate(applicationTime, ctrlTime))
+        {
+            continue;
+        }
+
+        ClipController* clipController = controller.get();
+        AnimationClip const& clip = *clipController->mClip;
+        mEvaluated.push_back(clipController);
+        mControlTime.push_back(ctrlTime);
+        clipController->EvaluateTranslationScale(ctrlTime);
+
+        int i0, i1;
+        float normTime;
+        if (clip.GetRotationKeys(clipController->mTrack, ctrlTime, clipController->mCursor,
+            i0, i1, normTime))
+        {
+            if (i0 == i1)
+            {
+                clipController->mLocalTransform.SetRotation(clip.GetRotationKey(i0));
+            }
+            else
+            {
+                Quaternion<float> q0 = clip.GetRotationKey(i0);
+                Quaternion<float> q1 = clip.GetRotationKey(i1);
+                mSlerpController.push_back(clipController);
+                mNormTime.push_back(normTime);
+                for (int c = 0; c < 4; ++c)
+                {
+                    mQ0[c].push_back(q0[c]);
+                    mQ1[c].push_back(q1[c]);
+                }
+            }
+        }
+    }
+
+    // Slerp the rotations four at a time. The arrays are padded to a
+    // multiple of 4 by repeating the last slerp.
+    size_t const numSlerps = mSlerpController.size();
+    if (numSlerps > 0)
+    {
+        size_t const numPadded = (numSlerps + 3) & ~static_cast<size_t>(3);
+        mNormTime.resize(numPadded, mNormTime.back());
+        for (int c = 0; c < 4; ++c)
+        {
+            mQ0[c].resize(numPadded, mQ0[c].back());
+            mQ1[c].resize(numPadded, mQ1[c].back());
+            mQ[c].resize(numPadded);
+        }
+
+        typedef SIMD4Value<float> V;
+        typedef SIMD4<float> S;
+        for (size_t i = 0; i < numPadded; i += 4)
+        {
+            std::array<V, 4> q0, q1;
+            for (int c = 0; c < 4; ++c)
+            {
+                q0[c] = V(S::Load(&mQ0[c][i]));
+                q1[c] = V(S::Load(&mQ1[c][i]));
+            }
+
+            // The operations are those of SLERP<float>::EstimateR.
+            V dot = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+            V f0, f1;
+            ChebyshevRatio<float>::GetEstimate<AnimationClip::SLERP_DEGREE>(
+                V(S::Load(&mNormTime[i])), V(1.0f) - dot, f0, f1);
+            for (int c = 0; c < 4; ++c)
+            {
+                S::Store(&mQ[c][i], (q0[c] * f0 + q1[c] * f1).value);
+            }
+        }
+
+        for (size_t i = 0; i < numSlerps; ++i)
+        {
+            mSlerpController[i]->mLocalTransform.SetRotation(
+                Quaternion<float>(mQ[0][i], mQ[1][i], mQ[2][i], mQ[3][i]));
+        }
+    }
+
+    for (size_t i = 0; i < mEvaluated.size(); ++i)
+    {
+        mEvaluated[i]->EndUpdate(mControlTime[i]);
+    }
+    return mEvaluated.size();
+}
@@ -0,0 +1,64 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/ClipController.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+// The batch evaluation of many ClipController objects, for example those of
+// all the bones of a crowd of characters. Update finds the controllers
+// whose control times have changed, looks up their keys and interpolates
+// the translations and scales, gathers the pairs of rotation keys into
+// structure-of-arrays form and slerps them four at a time with the SIMD4
+// evaluation of the ChebyshevRatio estimate, which computes the same
+// values as ClipController::Update. The controllers whose times have not
+// changed are skipped.
+//
+// Call Update with the application time before the geometric update of the
+// scene; the controllers then find their transforms current when the scene
+// updates them.
+
+namespace gte
+{
+    class AnimationEvaluator
+    {
+    public:
+        // Construction.
+        AnimationEvaluator() = default;
+
+        // Member access. A controller must be attached to an object before
+        // the evaluator is updated.
+        void Attach(std::shared_ptr<ClipController> const& controller);
+        void Detach(std::shared_ptr<ClipController> const& controller);
+        void DetachAll();
+
+        inline size_t GetNumControllers() const
+        {
+            return mControllers.size();
+        }
+
+        // Evaluate the controllers at the application time (in
+        // milliseconds). The function returns the number of controllers
+        // whose tracks were evaluated.
+        size_t Update(double applicationTime);
+
+    private:
+        std::vector<std::shared_ptr<ClipController>> mControllers;
+
+        // The controllers evaluated by Update, their control times and the
+        // data of the slerps. The rotation of mSlerpController[i] is the slerp of keys with
+        // components mQ0[c][i] and mQ1[c][i] at mNormTime[i].
+        std::vector<ClipController*> mEvaluated;
+        std::vector<float> mControlTime;
+        std::vector<ClipController*> mSlerpController;
+        std::vector<float> mNormTime;
+        std::array<std::vector<float>, 4> mQ0, mQ1, mQ;
+    };
+}
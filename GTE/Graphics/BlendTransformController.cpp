@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/BlendTransformController.h>
@@ -21,7 +21,11 @@ BlendTransformController::BlendTransformController(
     mController1(controller1),
     mWeight(0.0f),
     mGeometricRotation(geometricRotation),
-    mGeometricScale(geometricScale)
+    mGeometricScale(geometricScale),
+    mLastVersion0(0),
+    mLastVersion1(0),
+    mLastWeight(0.0f),
+    mIsCurrent(false)
 {
 }
 
@@ -35,6 +39,16 @@ bool BlendTransformController::Update(double applicationTime)
     mController0->Update(applicationTime);
     mController1->Update(applicationTime);
 
+    auto spatial = static_cast<Spatial*>(mObject);
+    unsigned int version0 = mController0->GetVersion();
+    unsigned int version1 = mController1->GetVersion();
+    if (mIsCurrent && version0 == mLastVersion0 && version1 == mLastVersion1
+        && mWeight == mLastWeight)
+    {
+        spatial->localTransform = mLocalTransform;
+        return true;
+    }
+
     Transform<float> const& xfrm0 = mController0->GetTransform();
     Transform<float> const& xfrm1 = mController1->GetTransform();
     float oneMinusWeight = 1.0f - mWeight;
@@ -101,7 +115,11 @@ bool BlendTransformController::Update(double applicationTime)
     }
     mLocalTransform.SetScale(blendSca);
 
-    auto spatial = static_cast<Spatial*>(mObject);
+    mLastVersion0 = version0;
+    mLastVersion1 = version1;
+    mLastWeight = mWeight;
+    mIsCurrent = true;
+    ++mVersion;
     spatial->localTransform = mLocalTransform;
     return true;
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -61,6 +61,8 @@ namespace gte
         }
 
         // The animation update.  The application time is in milliseconds.
+        // The blend is not recomputed when the weight and the transforms of
+        // the managed controllers are the same as in the previous update.
         virtual bool Update(double applicationTime) override;
 
     protected:
@@ -70,5 +72,10 @@ namespace gte
         std::shared_ptr<TransformController> mController0, mController1;
         float mWeight;
         bool mRSMatrices, mGeometricRotation, mGeometricScale;
+
+        // The inputs of the last blend.
+        unsigned int mLastVersion0, mLastVersion1;
+        float mLastWeight;
+        bool mIsCurrent;
     };
 }
@@ -3,17 +3,22 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.10
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/BspNode.h>
+#include <Graphics/BspVisibility.h>
 #include <Graphics/Camera.h>
 using namespace gte;
 
 BspNode::BspNode()
     :
     mModelPlane{ 0.0f, 0.0f, 0.0f, 0.0f },
-    mWorldPlane{ 0.0f, 0.0f, 0.0f, 0.0f }
+    mWorldPlane{ 0.0f, 0.0f, 0.0f, 0.0f },
+    mVisibility(nullptr),
+    mFirstCell(0),
+    mMiddleCell(0),
+    mEndCell(0)
 {
     mChild.push_back(nullptr);  // left child
     mChild.push_back(nullptr);  // middle child
@@ -21,6 +26,11 @@ BspNode::BspNode()
 }
 
 BspNode::BspNode(Plane3<float> const& modelPlane)
+    :
+    mVisibility(nullptr),
+    mFirstCell(0),
+    mMiddleCell(0),
+    mEndCell(0)
 {
     SetModelPlane(modelPlane);
     SetWorldPlane(modelPlane);
@@ -137,6 +147,33 @@ void BspNode::GetVisibleSet(Culler& culler,
     std::shared_ptr<Spatial> copChild = GetCoplanarChild();
     std::shared_ptr<Spatial> negChild = GetNegativeChild();
 
+    // With precomputed visible sets, the subtrees that contain no cell
+    // visible from the cell of the camera are skipped without plane tests.
+    // The coplanar child is on the boundary of the cells of both subtrees,
+    // so it is skipped only when both are.
+    if (mVisibility)
+    {
+        if (mVisibility->GetRoot() == this)
+        {
+            mVisibility->SetViewpoint(camera->GetPosition());
+        }
+
+        bool posVisible = mVisibility->IsRangeVisible(mFirstCell, mMiddleCell);
+        bool negVisible = mVisibility->IsRangeVisible(mMiddleCell, mEndCell);
+        if (!posVisible && !negVisible)
+        {
+            return;
+        }
+        if (!posVisible)
+        {
+            posChild = nullptr;
+        }
+        if (!negVisible)
+        {
+            negChild = nullptr;
+        }
+    }
+
     int positionSide = WhichSide(camera->GetPosition());
     int frustumSide = WhichSide(camera);
 
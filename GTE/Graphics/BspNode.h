@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -16,6 +16,8 @@
 
 namespace gte
 {
+    class BspVisibility;
+
     class BspNode : public Node
     {
     public:
@@ -85,6 +87,25 @@ namespace gte
         // Determine the portion of the scene that contains the point.
         Spatial* GetContainingNode(Vector4<float> const& point);
 
+        // The precomputed visible sets of the tree that contains this node,
+        // or null when there are none. See BspVisibility.
+        inline BspVisibility* GetVisibility() const
+        {
+            return mVisibility;
+        }
+
+        // The children are drawn in an order that depends on the camera.
+        inline virtual bool CanFlattenChildren() const override
+        {
+            return false;
+        }
+
+        // The world plane is computed by UpdateWorldData.
+        inline virtual bool CanFlattenUpdate() const override
+        {
+            return false;
+        }
+
     protected:
         // Support for conversions from planes to 4-tuples.
         void NormalizePlane(Vector4<float>& plane);
@@ -112,5 +133,14 @@ namespace gte
         int WhichSide(std::shared_ptr<Camera> const& camera) const;
 
         Vector4<float> mModelPlane, mWorldPlane;
+
+    private:
+        friend class BspVisibility;
+
+        // The cells of the positive subtree are [mFirstCell,mMiddleCell)
+        // and those of the negative subtree are [mMiddleCell,mEndCell).
+        // They are set by BspVisibility.
+        BspVisibility* mVisibility;
+        int mFirstCell, mMiddleCell, mEndCell;
     };
 }
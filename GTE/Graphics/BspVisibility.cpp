@@ -0,0 +1,300 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/BspVisibility.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+using namespace gte;
+
+namespace
+{
+    struct Header
+    {
+        char magic[8];  // "GTEPVS" and null terminators
+        uint32_t version;
+        uint32_t numCells;
+        uint32_t numBytes;
+        uint32_t reserved;
+    };
+
+    char const gMagic[8] = { 'G', 'T', 'E', 'P', 'V', 'S', 0, 0 };
+    uint32_t constexpr gVersion = 1;
+}
+
+BspVisibility::~BspVisibility()
+{
+    Detach(mRoot.get());
+}
+
+BspVisibility::BspVisibility(std::shared_ptr<BspNode> const& root)
+    :
+    mRoot(root),
+    mViewpointCell(-1)
+{
+    LogAssert(root != nullptr, "The tree must have a root.");
+    LogAssert(root->mVisibility == nullptr, "The tree already has visible sets.");
+    Enumerate(mRoot.get());
+    SetAllVisible();
+}
+
+int BspVisibility::GetCell(Vector4<float> const& point) const
+{
+    BspNode* node = mRoot.get();
+    for (;;)
+    {
+        int i = (node->WhichSide(point) < 0 ? 2 : 0);
+        BspNode* child = dynamic_cast<BspNode*>(node->GetChild(i).get());
+        if (!child)
+        {
+            return (i == 0 ? node->mFirstCell : node->mMiddleCell);
+        }
+        node = child;
+    }
+}
+
+void BspVisibility::Build(std::function<bool(int, int)> const& isVisible)
+{
+    int const numCells = GetNumCells();
+    size_t const rowBytes = (static_cast<size_t>(numCells) + 7) / 8;
+    std::vector<uint8_t> bits(numCells * rowBytes, 0);
+    for (int c0 = 0; c0 < numCells; ++c0)
+    {
+        uint8_t* row0 = &bits[c0 * rowBytes];
+        row0[c0 >> 3] |= static_cast<uint8_t>(1 << (c0 & 7));
+        for (int c1 = c0 + 1; c1 < numCells; ++c1)
+        {
+            if (isVisible(c0, c1))
+            {
+                row0[c1 >> 3] |= static_cast<uint8_t>(1 << (c1 & 7));
+                bits[c1 * rowBytes + (c0 >> 3)] |= static_cast<uint8_t>(1 << (c0 & 7));
+            }
+        }
+    }
+
+    mCompressed.clear();
+    mOffsets.resize(static_cast<size_t>(numCells) + 1);
+    for (int c = 0; c < numCells; ++c)
+    {
+        mOffsets[c] = static_cast<uint32_t>(mCompressed.size());
+        uint8_t const* row = &bits[c * rowBytes];
+        for (size_t i = 0; i < rowBytes; ++i)
+        {
+            mCompressed.push_back(row[i]);
+            if (row[i] == 0)
+            {
+                uint8_t run = 1;
+                while (i + 1 < rowBytes && row[i + 1] == 0 && run < 255)
+                {
+                    ++i;
+                    ++run;
+                }
+                mCompressed.push_back(run);
+            }
+        }
+    }
+    mOffsets[numCells] = static_cast<uint32_t>(mCompressed.size());
+    mViewpointCell = -1;
+}
+
+bool BspVisibility::IsVisible(int cell0, int cell1) const
+{
+    LogAssert(0 <= cell0 && cell0 < GetNumCells() && 0 <= cell1 && cell1 < GetNumCells(),
+        "Invalid cell.");
+    std::vector<uint8_t> row;
+    Decompress(cell0, row);
+    return (row[cell1 >> 3] & (1 << (cell1 & 7))) != 0;
+}
+
+bool BspVisibility::Save(std::string const& filename) const
+{
+    std::ofstream output(filename, std::ios::out | std::ios::binary);
+    if (!output)
+    {
+        LogWarning("Cannot open " + filename + ".");
+        return false;
+    }
+
+    Header header;
+    std::memcpy(header.magic, gMagic, sizeof(gMagic));
+    header.version = gVersion;
+    header.numCells = static_cast<uint32_t>(mCells.size());
+    header.numBytes = static_cast<uint32_t>(mCompressed.size());
+    header.reserved = 0;
+    output.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    output.write(reinterpret_cast<char const*>(mOffsets.data()),
+        static_cast<std::streamsize>(mOffsets.size() * sizeof(uint32_t)));
+    output.write(reinterpret_cast<char const*>(mCompressed.data()),
+        static_cast<std::streamsize>(mCompressed.size()));
+    if (!output)
+    {
+        LogWarning("Cannot write " + filename + ".");
+        return false;
+    }
+    return true;
+}
+
+bool BspVisibility::Load(std::string const& filename)
+{
+    std::ifstream input(filename, std::ios::in | std::ios::binary);
+    if (!input)
+    {
+        LogWarning("Cannot open " + filename + ".");
+        return false;
+    }
+
+    Header header;
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, gMagic, sizeof(gMagic)) != 0)
+    {
+        LogWarning("The file " + filename + " is not a visibility file.");
+        return false;
+    }
+
+    if (header.version != gVersion)
+    {
+        LogWarning("The visibility file " + filename + " has unsupported version " +
+            std::to_string(header.version) + ".");
+        return false;
+    }
+
+    if (header.numCells != static_cast<uint32_t>(mCells.size()))
+    {
+        LogWarning("The visibility file " + filename + " is for a different tree.");
+        return false;
+    }
+
+    std::vector<uint32_t> offsets(static_cast<size_t>(header.numCells) + 1);
+    std::vector<uint8_t> compressed(header.numBytes);
+    input.read(reinterpret_cast<char*>(offsets.data()),
+        static_cast<std::streamsize>(offsets.size() * sizeof(uint32_t)));
+    input.read(reinterpret_cast<char*>(compressed.data()),
+        static_cast<std::streamsize>(compressed.size()));
+    if (!input || offsets.front() != 0 || offsets.back() != header.numBytes
+        || !std::is_sorted(offsets.begin(), offsets.end()))
+    {
+        LogWarning("The visibility file " + filename + " is truncated or invalid.");
+        return false;
+    }
+
+    // Validate the rows so that the decompression cannot overrun.
+    size_t const rowBytes = (static_cast<size_t>(header.numCells) + 7) / 8;
+    for (uint32_t c = 0; c < header.numCells; ++c)
+    {
+        bool valid = true;
+        size_t numRowBytes = 0;
+        for (uint32_t i = offsets[c]; valid && i < offsets[c + 1]; ++i)
+        {
+            if (compressed[i] != 0)
+            {
+                ++numRowBytes;
+            }
+            else if (++i < offsets[c + 1] && compressed[i] != 0)
+            {
+                numRowBytes += compressed[i];
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+        if (!valid || numRowBytes != rowBytes)
+        {
+            LogWarning("The visibility file " + filename + " is truncated or invalid.");
+            return false;
+        }
+    }
+
+    mOffsets = std::move(offsets);
+    mCompressed = std::move(compressed);
+    mViewpointCell = -1;
+    return true;
+}
+
+void BspVisibility::SetViewpoint(Vector4<float> const& point)
+{
+    int cell = GetCell(point);
+    if (cell != mViewpointCell)
+    {
+        std::vector<uint8_t> row;
+        Decompress(cell, row);
+        int const numCells = GetNumCells();
+        mVisiblePrefix.resize(static_cast<size_t>(numCells) + 1);
+        mVisiblePrefix[0] = 0;
+        for (int i = 0; i < numCells; ++i)
+        {
+            mVisiblePrefix[i + 1] = mVisiblePrefix[i] + ((row[i >> 3] >> (i & 7)) & 1);
+        }
+        mViewpointCell = cell;
+    }
+}
+
+void BspVisibility::Enumerate(BspNode* node)
+{
+    node->mVisibility = this;
+    node->mFirstCell = GetNumCells();
+    for (int i = 0; i <= 2; i += 2)
+    {
+        if (i == 2)
+        {
+            node->mMiddleCell = GetNumCells();
+        }
+
+        Spatial* child = node->GetChild(i).get();
+        BspNode* bspChild = dynamic_cast<BspNode*>(child);
+        if (bspChild)
+        {
+            LogAssert(bspChild->mVisibility == nullptr, "The tree already has visible sets.");
+            Enumerate(bspChild);
+        }
+        else
+        {
+            mCells.push_back(child);
+        }
+    }
+    node->mEndCell = GetNumCells();
+}
+
+void BspVisibility::Detach(BspNode* node)
+{
+    node->mVisibility = nullptr;
+    for (int i = 0; i <= 2; i += 2)
+    {
+        BspNode* bspChild = dynamic_cast<BspNode*>(node->GetChild(i).get());
+        if (bspChild)
+        {
+            Detach(bspChild);
+        }
+    }
+}
+
+void BspVisibility::Decompress(int cell, std::vector<uint8_t>& row) const
+{
+    size_t const rowBytes = (mCells.size() + 7) / 8;
+    row.resize(rowBytes);
+    size_t j = 0;
+    for (uint32_t i = mOffsets[cell]; i < mOffsets[cell + 1]; ++i)
+    {
+        if (mCompressed[i] != 0)
+        {
+            row[j++] = mCompressed[i];
+        }
+        else
+        {
+            uint8_t run = mCompressed[++i];
+            std::memset(&row[j], 0, run);
+            j += run;
+        }
+    }
+}
+
+void BspVisibility::SetAllVisible()
+{
+    Build([](int, int) { return true; });
+}
@@ -0,0 +1,125 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/BspNode.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Precomputed potentially visible sets (PVS) for a BSP tree. The cells are
+// the leaves of the tree, that is, the positive and negative child slots of
+// the BspNode objects whose children are not BspNode objects, including
+// empty slots, so that every point of space is in exactly one cell. The
+// cells are numbered in depth-first order, positive subtree first, so the
+// cells of any subtree have consecutive indices. Each BspNode of the tree
+// stores the index ranges of its positive and negative subtrees.
+//
+// The set of cells visible from each cell is computed offline, typically by
+// a tool that floods through the portals between the cells or that casts
+// rays between samples of the cells, and is passed to Build as a
+// predicate. The sets are stored as bit rows compressed by run-length
+// encoding of the zero bytes, which for indoor scenes is a small fraction
+// of the numCells^2 bits, and they can be saved to and loaded from a file.
+//
+// During culling, the root BspNode locates the cell of the camera once per
+// frame and decompresses its row into prefix counts, after which every
+// BspNode skips a child subtree whose cell range contains no visible cell
+// in constant time, without testing its plane against the frustum.
+//
+// The object keeps the tree alive. If the tree structure changes, create a
+// new BspVisibility object; the sets of the old one no longer apply.
+
+namespace gte
+{
+    class BspVisibility
+    {
+    public:
+        // Construction and destruction. The constructor numbers the cells
+        // of the tree and attaches the object to its BspNode objects.
+        // Initially every cell is visible from every cell. The destructor
+        // detaches the object from the nodes.
+        ~BspVisibility();
+        BspVisibility(std::shared_ptr<BspNode> const& root);
+
+        // Member access. The Spatial of a cell is null for an empty slot.
+        inline BspNode* GetRoot() const
+        {
+            return mRoot.get();
+        }
+
+        inline int GetNumCells() const
+        {
+            return static_cast<int>(mCells.size());
+        }
+
+        inline Spatial* GetCellSpatial(int cell) const
+        {
+            return mCells[cell];
+        }
+
+        // The cell that contains the point (in world coordinates). A point
+        // on a plane belongs to the positive side, as in
+        // BspNode::GetContainingNode.
+        int GetCell(Vector4<float> const& point) const;
+
+        // Compute the visible sets. The function isVisible(cell0, cell1) is
+        // called for cell0 < cell1, and visibility is symmetric. A cell is
+        // always visible from itself.
+        void Build(std::function<bool(int, int)> const& isVisible);
+
+        // Query the visible sets. This decompresses the row of cell0, so it
+        // is intended for tools, not for per-frame use.
+        bool IsVisible(int cell0, int cell1) const;
+
+        // The compressed rows, for inspection of the storage cost.
+        inline std::vector<uint8_t> const& GetCompressed() const
+        {
+            return mCompressed;
+        }
+
+        // Save and load the visible sets. The file stores the number of
+        // cells, which must match that of the tree when loading. The
+        // functions return false and report a warning on failure.
+        bool Save(std::string const& filename) const;
+        bool Load(std::string const& filename);
+
+    private:
+        friend class BspNode;
+
+        // Support for BspNode::GetVisibleSet. SetViewpoint locates the cell
+        // of the point and, when the cell has changed, decompresses its row
+        // into mVisiblePrefix, where mVisiblePrefix[i] is the number of
+        // visible cells with index smaller than i.
+        void SetViewpoint(Vector4<float> const& point);
+
+        inline bool IsRangeVisible(int first, int end) const
+        {
+            return mVisiblePrefix[end] > mVisiblePrefix[first];
+        }
+
+        void Enumerate(BspNode* node);
+        void Detach(BspNode* node);
+        void Decompress(int cell, std::vector<uint8_t>& row) const;
+        void SetAllVisible();
+
+        std::shared_ptr<BspNode> mRoot;
+        std::vector<Spatial*> mCells;
+
+        // The rows of cell i are mCompressed[mOffsets[i]] through
+        // mCompressed[mOffsets[i+1]-1]. In a row, a nonzero byte is 8 bits
+        // of the row and a zero byte is followed by the number (1 to 255)
+        // of zero bytes it represents.
+        std::vector<uint8_t> mCompressed;
+        std::vector<uint32_t> mOffsets;
+
+        int mViewpointCell;
+        std::vector<int> mVisiblePrefix;
+    };
+}
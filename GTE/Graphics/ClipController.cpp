@@ -0,0 +1,99 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/ClipController.h>
+#include <Graphics/Spatial.h>
+#include <Mathematics/Logger.h>
+using namespace gte;
+
+ClipController::ClipController(std::shared_ptr<AnimationClip> const& clip, int track,
+    Transform<float> const& localTransform)
+    :
+    TransformController(localTransform),
+    mTrack(0),
+    mLastControlTime(0.0f),
+    mIsCurrent(false)
+{
+    SetTrack(clip, track);
+}
+
+void ClipController::SetTrack(std::shared_ptr<AnimationClip> const& clip, int track)
+{
+    LogAssert(clip != nullptr && 0 <= track && track < clip->GetNumTracks(), "Invalid track.");
+    mClip = clip;
+    mTrack = track;
+    mCursor = AnimationClip::Cursor();
+    mIsCurrent = false;
+
+    float trackMinTime, trackMaxTime;
+    mClip->GetTimeRange(mTrack, trackMinTime, trackMaxTime);
+    minTime = static_cast<double>(trackMinTime);
+    maxTime = static_cast<double>(trackMaxTime);
+}
+
+bool ClipController::Update(double applicationTime)
+{
+    float ctrlTime;
+    if (!active)
+    {
+        return false;
+    }
+
+    if (BeginUpdate(applicationTime, ctrlTime))
+    {
+        EvaluateTranslationScale(ctrlTime);
+
+        Quaternion<float> rotation;
+        if (mClip->GetRotation(mTrack, ctrlTime, mCursor, rotation))
+        {
+            mLocalTransform.SetRotation(rotation);
+        }
+
+        EndUpdate(ctrlTime);
+    }
+    return true;
+}
+
+bool ClipController::BeginUpdate(double applicationTime, float& ctrlTime)
+{
+    if (!Controller::Update(applicationTime))
+    {
+        return false;
+    }
+
+    ctrlTime = static_cast<float>(GetControlTime(applicationTime));
+    if (mIsCurrent && ctrlTime == mLastControlTime)
+    {
+        static_cast<Spatial*>(mObject)->localTransform = mLocalTransform;
+        return false;
+    }
+    return true;
+}
+
+void ClipController::EvaluateTranslationScale(float ctrlTime)
+{
+    Vector4<float> translation;
+    if (mClip->GetTranslation(mTrack, ctrlTime, mCursor, translation))
+    {
+        mLocalTransform.SetTranslation(translation);
+    }
+
+    float scale;
+    if (mClip->GetScale(mTrack, ctrlTime, mCursor, scale))
+    {
+        mLocalTransform.SetUniformScale(scale);
+    }
+}
+
+void ClipController::EndUpdate(float ctrlTime)
+{
+    mLastControlTime = ctrlTime;
+    mIsCurrent = true;
+    ++mVersion;
+    static_cast<Spatial*>(mObject)->localTransform = mLocalTransform;
+}
@@ -0,0 +1,84 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/AnimationClip.h>
+#include <memory>
+
+// A keyframe controller whose keys are a track of an AnimationClip shared
+// with other controllers, which is the KeyframeController of the
+// characters of a crowd. The controller stores only the clip, the track
+// index and the cursors of the key lookups. The keys are not evaluated
+// when the control time is the same as that of the previous evaluation,
+// so a character that is paused or clamped at the end of its animation
+// costs only the copy of its local transform.
+//
+// The controller evaluates its track in Update, or the controllers are
+// attached to an AnimationEvaluator that evaluates them in a batch with the
+// rotations slerped four at a time. When the evaluator is updated before
+// the scene, the Update calls by the scene find the transforms current.
+
+namespace gte
+{
+    class AnimationEvaluator;
+
+    class ClipController : public TransformController
+    {
+    public:
+        // Construction. The local transform provides the channels that the
+        // track does not animate. The minimum and maximum times of the
+        // controller are set to the time range of the track; change them
+        // and the other Controller parameters as needed.
+        virtual ~ClipController() = default;
+        ClipController(std::shared_ptr<AnimationClip> const& clip, int track,
+            Transform<float> const& localTransform);
+
+        // Member access.
+        inline std::shared_ptr<AnimationClip> const& GetClip() const
+        {
+            return mClip;
+        }
+
+        inline int GetTrack() const
+        {
+            return mTrack;
+        }
+
+        // Play a different track, typically of a different clip with the
+        // same skeleton. The next update evaluates the new track.
+        void SetTrack(std::shared_ptr<AnimationClip> const& clip, int track);
+
+        // If the keys of the clip are modified, call this so that the next
+        // update evaluates them even when the time has not changed.
+        inline void InvalidateCache()
+        {
+            mIsCurrent = false;
+        }
+
+        // The animation update.  The application time is in milliseconds.
+        virtual bool Update(double applicationTime) override;
+
+    private:
+        friend class AnimationEvaluator;
+
+        // Support for Update and AnimationEvaluator. BeginUpdate returns
+        // true when the controller is active and the track must be
+        // evaluated at the returned control time. EvaluateTranslationScale
+        // sets those channels, and EndUpdate records the evaluation and
+        // copies the local transform to the controlled object.
+        bool BeginUpdate(double applicationTime, float& ctrlTime);
+        void EvaluateTranslationScale(float ctrlTime);
+        void EndUpdate(float ctrlTime);
+
+        std::shared_ptr<AnimationClip> mClip;
+        int mTrack;
+        AnimationClip::Cursor mCursor;
+        float mLastControlTime;
+        bool mIsCurrent;
+    };
+}
@@ -0,0 +1,344 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/ClusteredLightEffect.h>
+using namespace gte;
+
+ClusteredLightEffect::ClusteredLightEffect(std::shared_ptr<ProgramFactory> const& factory,
+    BufferUpdater const& updater, std::shared_ptr<Material> const& material,
+    std::shared_ptr<ClusteredLighting> const& clusteredLighting)
+    :
+    LightEffect(factory, updater, msVSSource, msPSSource, material, nullptr, nullptr),
+    mClusteredLighting(clusteredLighting)
+{
+    LogAssert(clusteredLighting != nullptr, "Invalid input.");
+
+    mMaterialConstant = std::make_shared<ConstantBuffer>(sizeof(InternalMaterial), true);
+    UpdateMaterialConstant();
+
+    mViewWorldMatrixConstant = std::make_shared<ConstantBuffer>(sizeof(Matrix4x4<float>), true);
+    *mViewWorldMatrixConstant->Get<Matrix4x4<float>>() = Matrix4x4<float>::Identity();
+
+    mProgram->GetVertexShader()->Set("ViewWorldMatrix", mViewWorldMatrixConstant);
+
+    auto pshader = mProgram->GetPixelShader();
+    pshader->Set("Material", mMaterialConstant);
+    pshader->Set("Clusters", clusteredLighting->GetClustersConstant());
+    pshader->Set("lights", clusteredLighting->GetLightBuffer());
+    pshader->Set("clusterCounts", clusteredLighting->GetClusterCounts());
+    pshader->Set("clusterLights", clusteredLighting->GetClusterLights());
+}
+
+void ClusteredLightEffect::UpdateViewWorldMatrix(Matrix4x4<float> const& viewWorldMatrix)
+{
+    *mViewWorldMatrixConstant->Get<Matrix4x4<float>>() = viewWorldMatrix;
+    mBufferUpdater(mViewWorldMatrixConstant);
+}
+
+void ClusteredLightEffect::UpdateMaterialConstant()
+{
+    InternalMaterial* internalMaterial = mMaterialConstant->Get<InternalMaterial>();
+    internalMaterial->emissive = mMaterial->emissive;
+    internalMaterial->ambient = mMaterial->ambient;
+    internalMaterial->diffuse = mMaterial->diffuse;
+    internalMaterial->specular = mMaterial->specular;
+    LightEffect::UpdateMaterialConstant();
+}
+
+
+std::string const ClusteredLightEffect::msGLSLVSSource =
+R"(
+#if GTE_USE_PVW_BATCH
+    uniform PVWMatrix
+    {
+        uvec4 pvwIndex;
+    };
+
+    buffer pvwMatrices { mat4 data[]; } pvwMatricesSB;
+#define pvwMatrix pvwMatricesSB.data[pvwIndex.x]
+#else
+    uniform PVWMatrix
+    {
+        mat4 pvwMatrix;
+    };
+#endif
+
+    uniform ViewWorldMatrix
+    {
+        mat4 viewWorldMatrix;
+    };
+
+    layout(location = 0) in vec3 modelPosition;
+    layout(location = 1) in vec3 modelNormal;
+    layout(location = 0) out vec3 vertexPosition;
+    layout(location = 1) out vec3 vertexNormal;
+
+    void main()
+    {
+    #if GTE_USE_MAT_VEC
+        vertexPosition = (viewWorldMatrix * vec4(modelPosition, 1.0f)).xyz;
+        vertexNormal = (viewWorldMatrix * vec4(modelNormal, 0.0f)).xyz;
+        gl_Position = pvwMatrix * vec4(modelPosition, 1.0f);
+    #else
+        vertexPosition = (vec4(modelPosition, 1.0f) * viewWorldMatrix).xyz;
+        vertexNormal = (vec4(modelNormal, 0.0f) * viewWorldMatrix).xyz;
+        gl_Position = vec4(modelPosition, 1.0f) * pvwMatrix;
+    #endif
+    }
+)";
+
+std::string const ClusteredLightEffect::msGLSLPSSource =
+LightEffect::GetGLSLLitFunction() +
+R"(
+    uniform Material
+    {
+        vec4 materialEmissive;
+        vec4 materialAmbient;
+        vec4 materialDiffuse;
+        vec4 materialSpecular;
+    };
+
+    uniform Clusters
+    {
+        vec4 frustum;
+        vec4 depth;
+        uvec4 grid;
+        uvec4 numLights;
+    };
+
+    struct Light
+    {
+        vec4 position;
+        vec4 direction;
+        vec4 ambient;
+        vec4 diffuse;
+        vec4 specular;
+        vec4 attenuation;
+        vec4 spotCutoff;
+    };
+
+    buffer lights { Light data[]; } lightsSB;
+    buffer clusterCounts { uint data[]; } clusterCountsSB;
+    buffer clusterLights { uint data[]; } clusterLightsSB;
+
+    layout(location = 0) in vec3 vertexPosition;
+    layout(location = 1) in vec3 vertexNormal;
+    layout(location = 0) out vec4 pixelColor;
+
+    void main()
+    {
+        // Locate the cluster from the projection of the position onto the
+        // near plane and the logarithm of its depth.
+        float z = max(vertexPosition.z, depth.x);
+        vec2 nearPoint = vertexPosition.xy * (depth.x / z);
+        vec3 maxIndex = vec3(grid.xyz) - 1.0f;
+        uint ix = uint(clamp(floor((nearPoint.x - frustum.x) / (frustum.y - frustum.x) * float(grid.x)), 0.0f, maxIndex.x));
+        uint iy = uint(clamp(floor((nearPoint.y - frustum.z) / (frustum.w - frustum.z) * float(grid.y)), 0.0f, maxIndex.y));
+        uint iz = uint(clamp(floor(log(z / depth.x) * depth.z), 0.0f, maxIndex.z));
+        uint c = ix + grid.x * (iy + grid.y * iz);
+        uint base = c * grid.w;
+        uint count = clusterCountsSB.data[c];
+
+        vec3 normal = normalize(vertexNormal);
+        vec3 viewVector = normalize(-vertexPosition);
+        vec3 color = vec3(0.0f);
+        for (uint k = 0u; k < count; ++k)
+        {
+            Light light = lightsSB.data[clusterLightsSB.data[base + k]];
+            vec3 diff = vertexPosition - light.position.xyz;
+            float distance = length(diff);
+            if (distance < light.position.w)
+            {
+                vec3 vertexDirection = diff / max(distance, 1e-06f);
+                float NDotL = -dot(normal, vertexDirection);
+                vec3 halfVector = normalize(viewVector - vertexDirection);
+                float NDotH = dot(normal, halfVector);
+                vec4 lighting = lit(NDotL, NDotH, materialSpecular.a);
+
+                float spotFactor = 1.0f;
+                if (light.direction.w > 0.0f)
+                {
+                    float cosAngle = dot(light.direction.xyz, vertexDirection);
+                    spotFactor = (cosAngle >= light.spotCutoff.y ?
+                        pow(abs(cosAngle), light.spotCutoff.w) : 0.0f);
+                }
+
+                float attenuation = light.attenuation.w / (light.attenuation.x + distance *
+                    (light.attenuation.y + distance * light.attenuation.z));
+
+                color += attenuation * (materialAmbient.rgb * light.ambient.rgb + spotFactor *
+                    (lighting.y * materialDiffuse.rgb * light.diffuse.rgb +
+                    lighting.z * materialSpecular.rgb * light.specular.rgb));
+            }
+        }
+
+        pixelColor.rgb = materialEmissive.rgb + color;
+        pixelColor.a = materialDiffuse.a;
+    }
+)";
+
+std::string const ClusteredLightEffect::msHLSLVSSource =
+R"(
+#if GTE_USE_PVW_BATCH
+    cbuffer PVWMatrix
+    {
+        uint4 pvwIndex;
+    };
+
+    StructuredBuffer<float4x4> pvwMatrices;
+#define pvwMatrix pvwMatrices[pvwIndex.x]
+#else
+    cbuffer PVWMatrix
+    {
+        float4x4 pvwMatrix;
+    };
+#endif
+
+    cbuffer ViewWorldMatrix
+    {
+        float4x4 viewWorldMatrix;
+    };
+
+    struct VS_INPUT
+    {
+        float3 modelPosition : POSITION;
+        float3 modelNormal : NORMAL;
+    };
+
+    struct VS_OUTPUT
+    {
+        float3 vertexPosition : TEXCOORD0;
+        float3 vertexNormal : TEXCOORD1;
+        float4 clipPosition : SV_POSITION;
+    };
+
+    VS_OUTPUT VSMain(VS_INPUT input)
+    {
+        VS_OUTPUT output;
+    #if GTE_USE_MAT_VEC
+        output.vertexPosition = mul(viewWorldMatrix, float4(input.modelPosition, 1.0f)).xyz;
+        output.vertexNormal = mul(viewWorldMatrix, float4(input.modelNormal, 0.0f)).xyz;
+        output.clipPosition = mul(pvwMatrix, float4(input.modelPosition, 1.0f));
+    #else
+        output.vertexPosition = mul(float4(input.modelPosition, 1.0f), viewWorldMatrix).xyz;
+        output.vertexNormal = mul(float4(input.modelNormal, 0.0f), viewWorldMatrix).xyz;
+        output.clipPosition = mul(float4(input.modelPosition, 1.0f), pvwMatrix);
+    #endif
+        return output;
+    }
+)";
+
+std::string const ClusteredLightEffect::msHLSLPSSource =
+R"(
+    cbuffer Material
+    {
+        float4 materialEmissive;
+        float4 materialAmbient;
+        float4 materialDiffuse;
+        float4 materialSpecular;
+    };
+
+    cbuffer Clusters
+    {
+        float4 frustum;
+        float4 depth;
+        uint4 grid;
+        uint4 numLights;
+    };
+
+    struct Light
+    {
+        float4 position;
+        float4 direction;
+        float4 ambient;
+        float4 diffuse;
+        float4 specular;
+        float4 attenuation;
+        float4 spotCutoff;
+    };
+
+    StructuredBuffer<Light> lights;
+    StructuredBuffer<uint> clusterCounts;
+    StructuredBuffer<uint> clusterLights;
+
+    struct PS_INPUT
+    {
+        float3 vertexPosition : TEXCOORD0;
+        float3 vertexNormal : TEXCOORD1;
+    };
+
+    struct PS_OUTPUT
+    {
+        float4 pixelColor : SV_TARGET0;
+    };
+
+    PS_OUTPUT PSMain(PS_INPUT input)
+    {
+        // Locate the cluster from the projection of the position onto the
+        // near plane and the logarithm of its depth.
+        float z = max(input.vertexPosition.z, depth.x);
+        float2 nearPoint = input.vertexPosition.xy * (depth.x / z);
+        float3 maxIndex = (float3)grid.xyz - 1.0f;
+        uint ix = (uint)clamp(floor((nearPoint.x - frustum.x) / (frustum.y - frustum.x) * grid.x), 0.0f, maxIndex.x);
+        uint iy = (uint)clamp(floor((nearPoint.y - frustum.z) / (frustum.w - frustum.z) * grid.y), 0.0f, maxIndex.y);
+        uint iz = (uint)clamp(floor(log(z / depth.x) * depth.z), 0.0f, maxIndex.z);
+        uint c = ix + grid.x * (iy + grid.y * iz);
+        uint base = c * grid.w;
+        uint count = clusterCounts[c];
+
+        float3 normal = normalize(input.vertexNormal);
+        float3 viewVector = normalize(-input.vertexPosition);
+        float3 color = 0.0f;
+        for (uint k = 0; k < count; ++k)
+        {
+            Light light = lights[clusterLights[base + k]];
+            float3 diff = input.vertexPosition - light.position.xyz;
+            float distance = length(diff);
+            if (distance < light.position.w)
+            {
+                float3 vertexDirection = diff / max(distance, 1e-06f);
+                float NDotL = -dot(normal, vertexDirection);
+                float3 halfVector = normalize(viewVector - vertexDirection);
+                float NDotH = dot(normal, halfVector);
+                float4 lighting = lit(NDotL, NDotH, materialSpecular.a);
+
+                float spotFactor = 1.0f;
+                if (light.direction.w > 0.0f)
+                {
+                    float cosAngle = dot(light.direction.xyz, vertexDirection);
+                    spotFactor = (cosAngle >= light.spotCutoff.y ?
+                        pow(abs(cosAngle), light.spotCutoff.w) : 0.0f);
+                }
+
+                float attenuation = light.attenuation.w / (light.attenuation.x + distance *
+                    (light.attenuation.y + distance * light.attenuation.z));
+
+                color += attenuation * (materialAmbient.rgb * light.ambient.rgb + spotFactor *
+                    (lighting.y * materialDiffuse.rgb * light.diffuse.rgb +
+                    lighting.z * materialSpecular.rgb * light.specular.rgb));
+            }
+        }
+
+        PS_OUTPUT output;
+        output.pixelColor.rgb = materialEmissive.rgb + color;
+        output.pixelColor.a = materialDiffuse.a;
+        return output;
+    }
+)";
+
+ProgramSources const ClusteredLightEffect::msVSSource =
+{
+    &msGLSLVSSource,
+    &msHLSLVSSource
+};
+
+ProgramSources const ClusteredLightEffect::msPSSource =
+{
+    &msGLSLPSSource,
+    &msHLSLPSSource
+};
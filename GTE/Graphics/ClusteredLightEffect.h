@@ -0,0 +1,75 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/LightEffect.h>
+#include <Graphics/ClusteredLighting.h>
+
+// A per-pixel effect that evaluates all the point and spot lights of a
+// ClusteredLighting object in one draw. The pixel shader finds the cluster
+// that contains the pixel and loops over the lights assigned to the
+// cluster by ClusteredLighting::Update, using the lighting model of
+// SpotLightEffect (a point light has a spot factor of 1). The lighting is
+// computed in view coordinates, so in addition to the PVW matrix the
+// effect needs the view-world matrix of its visual, which must be set
+// whenever the camera or the visual moves. The world transform is assumed
+// to have uniform scale so that the normals can be transformed by the same
+// matrix as the positions. The members 'lighting' and 'geometry' of
+// LightEffect are not used.
+
+namespace gte
+{
+    class ClusteredLightEffect : public LightEffect
+    {
+    public:
+        // Construction.
+        ClusteredLightEffect(std::shared_ptr<ProgramFactory> const& factory,
+            BufferUpdater const& updater, std::shared_ptr<Material> const& material,
+            std::shared_ptr<ClusteredLighting> const& clusteredLighting);
+
+        // Member access.
+        inline std::shared_ptr<ClusteredLighting> const& GetClusteredLighting() const
+        {
+            return mClusteredLighting;
+        }
+
+        inline std::shared_ptr<ConstantBuffer> const& GetViewWorldMatrixConstant() const
+        {
+            return mViewWorldMatrixConstant;
+        }
+
+        // Set the view-world matrix, typically
+        //   DoTransform(camera->GetViewMatrix(), visual->worldTransform.GetHMatrix())
+        // and inform the listener that the constant buffer has changed.
+        void UpdateViewWorldMatrix(Matrix4x4<float> const& viewWorldMatrix);
+
+        // After you set or modify 'material', call the update to inform any
+        // listener that the corresponding constant buffer has changed.
+        virtual void UpdateMaterialConstant() override;
+
+    private:
+        struct InternalMaterial
+        {
+            Vector4<float> emissive;
+            Vector4<float> ambient;
+            Vector4<float> diffuse;
+            Vector4<float> specular;
+        };
+
+        std::shared_ptr<ClusteredLighting> mClusteredLighting;
+        std::shared_ptr<ConstantBuffer> mViewWorldMatrixConstant;
+
+        // Shader source code as strings.
+        static std::string const msGLSLVSSource;
+        static std::string const msGLSLPSSource;
+        static std::string const msHLSLVSSource;
+        static std::string const msHLSLPSSource;
+        static ProgramSources const msVSSource;
+        static ProgramSources const msPSSource;
+    };
+}
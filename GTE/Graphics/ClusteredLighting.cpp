@@ -0,0 +1,257 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/ClusteredLighting.h>
+#include <Mathematics/Logger.h>
+#include <cmath>
+#include <cstring>
+using namespace gte;
+
+ClusteredLighting::Light::Light()
+    :
+    lighting{},
+    position{ 0.0f, 0.0f, 0.0f, 1.0f },
+    direction{ 0.0f, 0.0f, -1.0f, 0.0f },
+    radius(1.0f),
+    isSpot(false)
+{
+}
+
+ClusteredLighting::ClusteredLighting(std::shared_ptr<ProgramFactory> const& factory,
+    unsigned int maxLights, unsigned int numX, unsigned int numY,
+    unsigned int numZ, unsigned int maxLightsPerCluster)
+    :
+    mMaxLights(maxLights),
+    mNumX(numX),
+    mNumY(numY),
+    mNumZ(numZ),
+    mMaxLightsPerCluster(maxLightsPerCluster)
+{
+    LogAssert(maxLights > 0, "At least one light is required.");
+    LogAssert(numX > 0 && numY > 0 && numZ > 0 && maxLightsPerCluster > 0,
+        "Invalid cluster grid.");
+
+    mLights.reserve(maxLights);
+
+    mClusters = std::make_shared<ConstantBuffer>(sizeof(InternalClusters), true);
+    std::memset(mClusters->GetData(), 0, mClusters->GetNumBytes());
+    auto clusters = mClusters->Get<InternalClusters>();
+    clusters->grid[0] = numX;
+    clusters->grid[1] = numY;
+    clusters->grid[2] = numZ;
+    clusters->grid[3] = maxLightsPerCluster;
+
+    mLightBuffer = std::make_shared<StructuredBuffer>(maxLights, sizeof(InternalLight));
+    mLightBuffer->SetUsage(Resource::DYNAMIC_UPDATE);
+    std::memset(mLightBuffer->GetData(), 0, mLightBuffer->GetNumBytes());
+
+    unsigned int const numClusters = GetNumClusters();
+    mClusterCounts = std::make_shared<StructuredBuffer>(numClusters, sizeof(uint32_t));
+    mClusterCounts->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mClusterCounts->GetData(), 0, mClusterCounts->GetNumBytes());
+
+    mClusterLights = std::make_shared<StructuredBuffer>(numClusters * maxLightsPerCluster,
+        sizeof(uint32_t));
+    mClusterLights->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mClusterLights->GetData(), 0, mClusterLights->GetNumBytes());
+
+    mAssign = factory->CreateFromSource(*msAssignSource[factory->GetAPI()]);
+    if (mAssign)
+    {
+        auto cshader = mAssign->GetComputeShader();
+        cshader->Set("Clusters", mClusters);
+        cshader->Set("lights", mLightBuffer);
+        cshader->Set("clusterCounts", mClusterCounts);
+        cshader->Set("clusterLights", mClusterLights);
+    }
+    else
+    {
+        LogError("Failed to compile shader programs.");
+    }
+}
+
+void ClusteredLighting::Update(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Camera> const& camera)
+{
+    LogAssert(engine != nullptr && camera != nullptr, "Invalid input.");
+    LogAssert(camera->IsPerspective(), "The camera must have a perspective projection.");
+    LogAssert(mLights.size() <= mMaxLights, "Too many lights.");
+
+    // The lights are transformed on the CPU, which is cheap for the
+    // numbers of lights that fit in the clusters, so that the compute
+    // shader and the pixel shaders work in view coordinates.
+    Matrix4x4<float> const& viewMatrix = camera->GetViewMatrix();
+    auto lights = mLightBuffer->Get<InternalLight>();
+    for (auto const& light : mLights)
+    {
+        lights->position = DoTransform(viewMatrix, light.position);
+        lights->position[3] = light.radius;
+        lights->direction = DoTransform(viewMatrix, light.direction);
+        lights->direction[3] = (light.isSpot ? 1.0f : 0.0f);
+        lights->ambient = light.lighting.ambient;
+        lights->diffuse = light.lighting.diffuse;
+        lights->specular = light.lighting.specular;
+        lights->attenuation = light.lighting.attenuation;
+        lights->spotCutoff = light.lighting.spotCutoff;
+        ++lights;
+    }
+    if (mLights.size() > 0)
+    {
+        mLightBuffer->SetNumActiveElements(static_cast<unsigned int>(mLights.size()));
+        engine->Update(mLightBuffer);
+    }
+
+    float dMin, dMax, uMin, uMax, rMin, rMax;
+    camera->GetFrustum(dMin, dMax, uMin, uMax, rMin, rMax);
+    auto clusters = mClusters->Get<InternalClusters>();
+    clusters->frustum = { rMin, rMax, uMin, uMax };
+    clusters->depth = { dMin, dMax, static_cast<float>(mNumZ) / std::log(dMax / dMin), 0.0f };
+    clusters->numLights = static_cast<uint32_t>(mLights.size());
+    engine->Update(mClusters);
+
+    engine->Execute(mAssign, (GetNumClusters() + 63) / 64, 1, 1);
+}
+
+
+std::string const ClusteredLighting::msGLSLAssignSource =
+R"(
+    uniform Clusters
+    {
+        vec4 frustum;
+        vec4 depth;
+        uvec4 grid;
+        uvec4 numLights;
+    };
+
+    struct Light
+    {
+        vec4 position;
+        vec4 direction;
+        vec4 ambient;
+        vec4 diffuse;
+        vec4 specular;
+        vec4 attenuation;
+        vec4 spotCutoff;
+    };
+
+    buffer lights { Light data[]; } lightsSB;
+    buffer clusterCounts { uint data[]; } clusterCountsSB;
+    buffer clusterLights { uint data[]; } clusterLightsSB;
+
+    layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        uint c = gl_GlobalInvocationID.x;
+        if (c >= grid.x * grid.y * grid.z)
+        {
+            return;
+        }
+
+        // The cluster is the part of the frustum between two depth slices
+        // that projects onto a tile of the near plane. Its view-space box
+        // is the bound of the tile corners scaled to the two depths.
+        uint ix = c % grid.x;
+        uint iy = (c / grid.x) % grid.y;
+        uint iz = c / (grid.x * grid.y);
+        vec2 rExtent = vec2(float(ix), float(ix + 1u)) / float(grid.x);
+        vec2 uExtent = vec2(float(iy), float(iy + 1u)) / float(grid.y);
+        vec2 r = frustum.x + (frustum.y - frustum.x) * rExtent;
+        vec2 u = frustum.z + (frustum.w - frustum.z) * uExtent;
+        vec2 z = depth.x * pow(vec2(depth.y / depth.x),
+            vec2(float(iz), float(iz + 1u)) / float(grid.z));
+        vec2 s = z / depth.x;
+        vec3 boxMin = vec3(min(r.x * s.x, r.x * s.y), min(u.x * s.x, u.x * s.y), z.x);
+        vec3 boxMax = vec3(max(r.y * s.x, r.y * s.y), max(u.y * s.x, u.y * s.y), z.y);
+
+        uint base = c * grid.w;
+        uint count = 0u;
+        for (uint i = 0u; i < numLights.x && count < grid.w; ++i)
+        {
+            vec4 position = lightsSB.data[i].position;
+            vec3 diff = max(boxMin - position.xyz, vec3(0.0f)) +
+                max(position.xyz - boxMax, vec3(0.0f));
+            if (dot(diff, diff) <= position.w * position.w)
+            {
+                clusterLightsSB.data[base + count] = i;
+                ++count;
+            }
+        }
+        clusterCountsSB.data[c] = count;
+    }
+)";
+
+std::string const ClusteredLighting::msHLSLAssignSource =
+R"(
+    cbuffer Clusters
+    {
+        float4 frustum;
+        float4 depth;
+        uint4 grid;
+        uint4 numLights;
+    };
+
+    struct Light
+    {
+        float4 position;
+        float4 direction;
+        float4 ambient;
+        float4 diffuse;
+        float4 specular;
+        float4 attenuation;
+        float4 spotCutoff;
+    };
+
+    StructuredBuffer<Light> lights;
+    RWStructuredBuffer<uint> clusterCounts;
+    RWStructuredBuffer<uint> clusterLights;
+
+    [numthreads(64, 1, 1)]
+    void CSMain(uint3 id : SV_DispatchThreadID)
+    {
+        uint c = id.x;
+        if (c >= grid.x * grid.y * grid.z)
+        {
+            return;
+        }
+
+        // The cluster is the part of the frustum between two depth slices
+        // that projects onto a tile of the near plane. Its view-space box
+        // is the bound of the tile corners scaled to the two depths.
+        uint ix = c % grid.x;
+        uint iy = (c / grid.x) % grid.y;
+        uint iz = c / (grid.x * grid.y);
+        float2 rExtent = float2(ix, ix + 1) / (float)grid.x;
+        float2 uExtent = float2(iy, iy + 1) / (float)grid.y;
+        float2 r = frustum.x + (frustum.y - frustum.x) * rExtent;
+        float2 u = frustum.z + (frustum.w - frustum.z) * uExtent;
+        float2 z = depth.x * pow(depth.y / depth.x, float2(iz, iz + 1) / (float)grid.z);
+        float2 s = z / depth.x;
+        float3 boxMin = float3(min(r.x * s.x, r.x * s.y), min(u.x * s.x, u.x * s.y), z.x);
+        float3 boxMax = float3(max(r.y * s.x, r.y * s.y), max(u.y * s.x, u.y * s.y), z.y);
+
+        uint base = c * grid.w;
+        uint count = 0;
+        for (uint i = 0; i < numLights.x && count < grid.w; ++i)
+        {
+            float4 position = lights[i].position;
+            float3 diff = max(boxMin - position.xyz, 0.0f) + max(position.xyz - boxMax, 0.0f);
+            if (dot(diff, diff) <= position.w * position.w)
+            {
+                clusterLights[base + count] = i;
+                ++count;
+            }
+        }
+        clusterCounts[c] = count;
+    }
+)";
+
+ProgramSources const ClusteredLighting::msAssignSource =
+{
+    &msGLSLAssignSource,
+    &msHLSLAssignSource
+};
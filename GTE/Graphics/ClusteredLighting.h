@@ -0,0 +1,157 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/Camera.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/Lighting.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/StructuredBuffer.h>
+#include <vector>
+
+// The lights of a scene for clustered forward shading, for scenes with many
+// point and spot lights, where a Visual with a PointLightEffect or
+// SpotLightEffect per light would have to be drawn once per light. The
+// view frustum is partitioned into numX-by-numY tiles of the near plane and
+// numZ slices of depth, the slices being exponentially spaced between dmin
+// and dmax so that the clusters are roughly cubical. Each frame, Update
+// transforms the lights to view space and executes a compute shader that
+// tests each cluster against the sphere of influence of each light,
+// storing the indices of the lights that touch the cluster in a list of
+// at most maxLightsPerCluster entries. A ClusteredLightEffect then finds
+// the cluster of each pixel and evaluates only the lights of that cluster.
+//
+// A light contributes nothing outside its sphere of influence, so the
+// radius should be chosen where the attenuated intensity is negligible.
+// A spot light is tested with the sphere of its cone, which is
+// conservative. The camera must have a perspective projection.
+
+namespace gte
+{
+    class ClusteredLighting
+    {
+    public:
+        // A point or spot light. The position and direction are in world
+        // coordinates; the direction is unit length and used only by spot
+        // lights. The members of 'lighting' are those of the single-light
+        // effects, spotCutoff being used only by spot lights.
+        struct Light
+        {
+            Light();
+
+            Lighting lighting;
+            Vector4<float> position;
+            Vector4<float> direction;
+            float radius;
+            bool isSpot;
+        };
+
+        // Construction. The light buffer has room for maxLights lights.
+        virtual ~ClusteredLighting() = default;
+        ClusteredLighting(std::shared_ptr<ProgramFactory> const& factory,
+            unsigned int maxLights, unsigned int numX = 16, unsigned int numY = 9,
+            unsigned int numZ = 24, unsigned int maxLightsPerCluster = 64);
+
+        // Member access. The lights are copied to the GPU by Update. The
+        // number of lights must not exceed GetMaxLights().
+        inline std::vector<Light>& GetLights()
+        {
+            return mLights;
+        }
+
+        inline std::vector<Light> const& GetLights() const
+        {
+            return mLights;
+        }
+
+        inline unsigned int GetMaxLights() const
+        {
+            return mMaxLights;
+        }
+
+        inline unsigned int GetNumClusters() const
+        {
+            return mNumX * mNumY * mNumZ;
+        }
+
+        inline unsigned int GetMaxLightsPerCluster() const
+        {
+            return mMaxLightsPerCluster;
+        }
+
+        // The resources that ClusteredLightEffect attaches to its pixel
+        // shader, "Clusters", "lights", "clusterCounts" and
+        // "clusterLights".
+        inline std::shared_ptr<ConstantBuffer> const& GetClustersConstant() const
+        {
+            return mClusters;
+        }
+
+        inline std::shared_ptr<StructuredBuffer> const& GetLightBuffer() const
+        {
+            return mLightBuffer;
+        }
+
+        inline std::shared_ptr<StructuredBuffer> const& GetClusterCounts() const
+        {
+            return mClusterCounts;
+        }
+
+        inline std::shared_ptr<StructuredBuffer> const& GetClusterLights() const
+        {
+            return mClusterLights;
+        }
+
+        // Transform the lights to the view space of the camera and assign
+        // them to the clusters. Call this after the camera or lights move
+        // and before drawing the visuals that use ClusteredLightEffect.
+        void Update(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Camera> const& camera);
+
+    private:
+        // The layout of the elements of mLightBuffer. The position is
+        // (x,y,z,radius) and the direction is (x,y,z,isSpot) in view
+        // coordinates.
+        struct InternalLight
+        {
+            Vector4<float> position;
+            Vector4<float> direction;
+            Vector4<float> ambient;
+            Vector4<float> diffuse;
+            Vector4<float> specular;
+            Vector4<float> attenuation;
+            Vector4<float> spotCutoff;
+        };
+
+        // The layout of the constant buffer "Clusters". The frustum is
+        // (rmin,rmax,umin,umax) and depth is (dmin,dmax,numZ/log(dmax/dmin),
+        // *). The grid is (numX,numY,numZ,maxLightsPerCluster).
+        struct InternalClusters
+        {
+            Vector4<float> frustum;
+            Vector4<float> depth;
+            uint32_t grid[4];
+            uint32_t numLights, padding[3];
+        };
+
+        std::vector<Light> mLights;
+        unsigned int mMaxLights;
+        unsigned int mNumX, mNumY, mNumZ, mMaxLightsPerCluster;
+        std::shared_ptr<ConstantBuffer> mClusters;
+        std::shared_ptr<StructuredBuffer> mLightBuffer;
+        std::shared_ptr<StructuredBuffer> mClusterCounts;
+        std::shared_ptr<StructuredBuffer> mClusterLights;
+        std::shared_ptr<ComputeProgram> mAssign;
+
+        // Shader source code as strings.
+        static std::string const msGLSLAssignSource;
+        static std::string const msHLSLAssignSource;
+        static ProgramSources const msAssignSource;
+    };
+}
@@ -3,12 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Camera.h>
+#include <Graphics/Node.h>
 #include <Graphics/Spatial.h>
+#include <Graphics/Visual.h>
 #include <Mathematics/Logger.h>
+#include <Mathematics/SIMD4.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
 using namespace gte;
 
 Culler::~Culler()
@@ -17,7 +22,8 @@ Culler::~Culler()
 
 Culler::Culler()
     :
-    mPlaneQuantity(6)
+    mPlaneQuantity(6),
+    mScheduler(nullptr)
 {
     // The data members mFrustum, mPlane, and mPlaneState are
     // uninitialized.  They are initialized in the GetVisibleSet call.
@@ -101,6 +107,20 @@ void Culler::Insert(Visual* visible)
 }
 
 void Culler::PushViewFrustumPlanes(std::shared_ptr<Camera> const& camera)
+{
+    std::array<CullingPlane<float>, Camera::VF_QUANTITY> planes;
+    GetViewFrustumPlanes(camera, planes);
+    for (int i = 0; i < Camera::VF_QUANTITY; ++i)
+    {
+        mPlane[i] = planes[i];
+    }
+
+    // All planes are active initially.
+    mPlaneState = 0xFFFFFFFFu;
+}
+
+void Culler::GetViewFrustumPlanes(std::shared_ptr<Camera> const& camera,
+    std::array<CullingPlane<float>, Camera::VF_QUANTITY>& planes)
 {
     // Get the frustum values.
     float dMax = camera->GetDMax();
@@ -123,11 +143,11 @@ void Culler::PushViewFrustumPlanes(std::shared_ptr<Camera> const& camera)
 
     // Compute the near plane, N = D.
     c = -(dirDotEye + dMin);
-    mPlane[Camera::VF_DMIN].Set(D, c);
+    planes[Camera::VF_DMIN].Set(D, c);
 
     // Compute the far plane, N = -D.
     c = dirDotEye + dMax;
-    mPlane[Camera::VF_DMAX].Set(-D, c);
+    planes[Camera::VF_DMAX].Set(-D, c);
 
     // Compute the bottom plane
     invLength = 1.0f / std::sqrt(dMin2 + uMin2);
@@ -135,7 +155,7 @@ void Culler::PushViewFrustumPlanes(std::shared_ptr<Camera> const& camera)
     a1 = +dMin*invLength;  // U component
     N = a0*D + a1*U;
     c = -Dot(N, P);
-    mPlane[Camera::VF_UMIN].Set(N, c);
+    planes[Camera::VF_UMIN].Set(N, c);
 
     // Compute the top plane.
     invLength = 1.0f / std::sqrt(dMin2 + uMax2);
@@ -143,7 +163,7 @@ void Culler::PushViewFrustumPlanes(std::shared_ptr<Camera> const& camera)
     a1 = -dMin*invLength;  // U component
     N = a0*D + a1*U;
     c = -Dot(N, P);
-    mPlane[Camera::VF_UMAX].Set(N, c);
+    planes[Camera::VF_UMAX].Set(N, c);
 
     // Compute the left plane.
     invLength = 1.0f / std::sqrt(dMin2 + rMin2);
@@ -151,7 +171,7 @@ void Culler::PushViewFrustumPlanes(std::shared_ptr<Camera> const& camera)
     a1 = +dMin*invLength;  // R component
     N = a0*D + a1*R;
     c = -Dot(N, P);
-    mPlane[Camera::VF_RMIN].Set(N, c);
+    planes[Camera::VF_RMIN].Set(N, c);
 
     // Compute the right plane.
     invLength = 1.0f / std::sqrt(dMin2 + rMax2);
@@ -159,8 +179,327 @@ void Culler::PushViewFrustumPlanes(std::shared_ptr<Camera> const& camera)
     a1 = -dMin*invLength;  // R component
     N = a0*D + a1*R;
     c = -Dot(N, P);
-    mPlane[Camera::VF_RMAX].Set(N, c);
+    planes[Camera::VF_RMAX].Set(N, c);
+}
 
-    // All planes are active initially.
-    mPlaneState = 0xFFFFFFFFu;
+void Culler::Flatten(std::shared_ptr<Spatial> const& scene)
+{
+    LogAssert(scene != nullptr, "A scene is required for culling.");
+    mFlatScene = scene;
+    mFlatSpatial.clear();
+    mFlatEnd.clear();
+    mFlatKind.clear();
+    FlattenSubtree(scene.get());
+
+    size_t const numObjects = mFlatSpatial.size();
+    mFlatCenterX.resize(numObjects);
+    mFlatCenterY.resize(numObjects);
+    mFlatCenterZ.resize(numObjects);
+    mFlatRadius.resize(numObjects);
+    mFlatCulling.resize(numObjects);
+}
+
+void Culler::ComputeFlattenedVisibleSet(std::shared_ptr<Camera> const& camera,
+    unsigned int numThreads)
+{
+    LogAssert(mFlatScene != nullptr, "Flatten must be called first.");
+    PushViewFrustumPlanes(camera);
+    mVisibleSet.clear();
+
+    // Store the planes for the SIMD comparisons. The unused planes of the
+    // last group are never active.
+    for (int p = 0; p < MAX_PLANE_QUANTITY; ++p)
+    {
+        auto& group = mFlatPlanes[p / 4];
+        if (p < mPlaneQuantity)
+        {
+            Vector4<float> N = mPlane[p].GetNormal();
+            group[0][p % 4] = N[0];
+            group[1][p % 4] = N[1];
+            group[2][p % 4] = N[2];
+            group[3][p % 4] = mPlane[p].GetConstant();
+        }
+        else
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                group[j][p % 4] = 0.0f;
+            }
+        }
+    }
+
+    if (mScheduler != nullptr)
+    {
+        numThreads = mScheduler->GetNumThreads();
+    }
+    numThreads = std::max(numThreads, 1u);
+
+    // Copy the world bounds and culling modes.
+    size_t const numObjects = mFlatSpatial.size();
+    size_t numChunks = std::max(std::min(static_cast<size_t>(numThreads), numObjects),
+        static_cast<size_t>(1));
+    TaskScheduler::ParallelFor(mScheduler, numChunks,
+        [this, numObjects, numChunks](size_t chunk)
+        {
+            size_t const imin = numObjects * chunk / numChunks;
+            size_t const imax = numObjects * (chunk + 1) / numChunks;
+            for (size_t i = imin; i < imax; ++i)
+            {
+                Spatial const* spatial = mFlatSpatial[i];
+                Vector3<float> center = spatial->worldBound.GetCenter();
+                mFlatCenterX[i] = center[0];
+                mFlatCenterY[i] = center[1];
+                mFlatCenterZ[i] = center[2];
+                mFlatRadius[i] = spatial->worldBound.GetRadius();
+                mFlatCulling[i] = spatial->culling;
+            }
+        });
+
+    // Cull the top of the hierarchy in this thread, replacing a visible
+    // node of the list of subtrees by its children, until the list has
+    // enough subtrees for the threads. The list remains in depth-first
+    // order.
+    struct Subtree
+    {
+        int index;
+        unsigned int planeState;
+        bool noCull;
+    };
+
+    unsigned int const initialPlaneState = mPlaneState;
+    size_t const minSubtrees = (numThreads > 1 ? 4 * static_cast<size_t>(numThreads) : 1);
+    std::vector<Subtree> subtrees{ { 0, initialPlaneState, false } };
+    std::vector<Subtree> expanded;
+    bool expandable = true;
+    while (subtrees.size() < minSubtrees && expandable)
+    {
+        expandable = false;
+        expanded.clear();
+        for (auto const& subtree : subtrees)
+        {
+            int const i = subtree.index;
+            if (mFlatKind[i] != FLAT_NODE || mFlatEnd[i] == i + 1)
+            {
+                expanded.push_back(subtree);
+                continue;
+            }
+
+            if (mFlatCulling[i] == CULL_ALWAYS)
+            {
+                continue;
+            }
+
+            bool noCull = (subtree.noCull || mFlatCulling[i] == CULL_NEVER);
+            unsigned int planeState = subtree.planeState;
+            if (noCull || IsFlatVisible(i, planeState))
+            {
+                for (int child = i + 1; child < mFlatEnd[i]; child = mFlatEnd[child])
+                {
+                    expanded.push_back({ child, planeState, noCull });
+                }
+                expandable = true;
+            }
+        }
+        std::swap(subtrees, expanded);
+    }
+
+    // Partition the subtrees into contiguous ranges with approximately
+    // equal numbers of objects.
+    size_t const numSubtrees = subtrees.size();
+    numChunks = std::max(std::min(static_cast<size_t>(numThreads), numSubtrees),
+        static_cast<size_t>(1));
+    std::vector<size_t> first(numChunks + 1, numSubtrees);
+    first[0] = 0;
+    if (numSubtrees > 0)
+    {
+        size_t total = 0;
+        for (auto const& subtree : subtrees)
+        {
+            total += static_cast<size_t>(mFlatEnd[subtree.index] - subtree.index);
+        }
+
+        size_t sum = 0, chunk = 1;
+        for (size_t s = 0; s < numSubtrees && chunk < numChunks; ++s)
+        {
+            sum += static_cast<size_t>(mFlatEnd[subtrees[s].index] - subtrees[s].index);
+            while (chunk < numChunks && sum * numChunks >= total * chunk)
+            {
+                first[chunk++] = s + 1;
+            }
+        }
+    }
+
+    std::vector<std::vector<FlatRecord>> records(numChunks);
+    TaskScheduler::ParallelFor(mScheduler, numChunks,
+        [this, &subtrees, &first, &records](size_t chunk)
+        {
+            for (size_t s = first[chunk]; s < first[chunk + 1]; ++s)
+            {
+                CullSubtree(subtrees[s].index, subtrees[s].planeState,
+                    subtrees[s].noCull, records[chunk]);
+            }
+        });
+
+    // Merge the visible objects in depth-first order.
+    for (auto const& chunkRecords : records)
+    {
+        for (auto const& record : chunkRecords)
+        {
+            Spatial* spatial = mFlatSpatial[record.index];
+            if (mFlatKind[record.index] == FLAT_VISUAL)
+            {
+                Insert(static_cast<Visual*>(spatial));
+            }
+            else
+            {
+                mPlaneState = record.planeState;
+                spatial->GetVisibleSet(*this, camera, record.noCull);
+            }
+        }
+    }
+    mPlaneState = initialPlaneState;
+}
+
+void Culler::FlattenSubtree(Spatial* spatial)
+{
+    int const index = static_cast<int>(mFlatSpatial.size());
+    mFlatSpatial.push_back(spatial);
+    mFlatEnd.push_back(index + 1);
+
+    if (dynamic_cast<Visual*>(spatial))
+    {
+        mFlatKind.push_back(FLAT_VISUAL);
+        return;
+    }
+
+    Node* node = dynamic_cast<Node*>(spatial);
+    if (node && node->CanFlattenChildren())
+    {
+        mFlatKind.push_back(FLAT_NODE);
+        int const numChildren = node->GetNumChildren();
+        for (int c = 0; c < numChildren; ++c)
+        {
+            std::shared_ptr<Spatial> child = node->GetChild(c);
+            if (child)
+            {
+                FlattenSubtree(child.get());
+            }
+        }
+        mFlatEnd[index] = static_cast<int>(mFlatSpatial.size());
+        return;
+    }
+
+    mFlatKind.push_back(FLAT_OTHER);
+}
+
+bool Culler::IsFlatVisible(int i, unsigned int& planeState) const
+{
+    // This is IsVisible(sphere) with the spheres compared to 4 planes at a
+    // time. The signed distances are computed as in WhichSide, so the
+    // results are the same.
+    float const radius = mFlatRadius[i];
+    if (radius == 0.0f)
+    {
+        return false;
+    }
+
+    typedef SIMD4Value<float> V;
+    typedef SIMD4<float> S;
+    V const cx(mFlatCenterX[i]), cy(mFlatCenterY[i]), cz(mFlatCenterZ[i]);
+    V const r(radius), negR(-radius), one(1.0f), zero(0.0f);
+    unsigned int state = planeState;
+    int const numGroups = (mPlaneQuantity + 3) / 4;
+    for (int g = 0; g < numGroups; ++g)
+    {
+        unsigned int const groupState = (state >> (4 * g)) & 0xFu;
+        if (groupState == 0)
+        {
+            continue;
+        }
+
+        auto const& group = mFlatPlanes[g];
+        V distance = V(S::Load(group[0].data())) * cx + V(S::Load(group[1].data())) * cy +
+            V(S::Load(group[2].data())) * cz + V(S::Load(group[3].data()));
+
+        // The sphere is on the negative side of a plane when
+        // distance <= -radius, and it is on the positive side when
+        // distance >= radius.
+        std::array<float, 4> intersects, negative;
+        S::Store(intersects.data(), V::Select(distance < r, one, zero).value);
+        S::Store(negative.data(), V::Select(negR < distance, zero, one).value);
+        for (int k = 0; k < 4; ++k)
+        {
+            unsigned int const mask = (1u << (4 * g + k));
+            if ((groupState & (1u << k)) == 0 || 4 * g + k >= mPlaneQuantity)
+            {
+                continue;
+            }
+
+            if (negative[k] != 0.0f)
+            {
+                return false;
+            }
+
+            if (intersects[k] == 0.0f)
+            {
+                state &= ~mask;
+            }
+        }
+    }
+
+    planeState = state;
+    return true;
+}
+
+void Culler::CullSubtree(int i, unsigned int planeState, bool noCull,
+    std::vector<FlatRecord>& records) const
+{
+    // This is OnGetVisibleSet and Node::GetVisibleSet without recursion.
+    // The plane states and noCull values of the ancestors of the current
+    // object are restored when the traversal leaves their subtrees.
+    struct Ancestor
+    {
+        int end;
+        unsigned int planeState;
+        bool noCull;
+    };
+
+    std::vector<Ancestor> ancestors;
+    int const end = mFlatEnd[i];
+    while (i < end)
+    {
+        while (!ancestors.empty() && ancestors.back().end <= i)
+        {
+            planeState = ancestors.back().planeState;
+            noCull = ancestors.back().noCull;
+            ancestors.pop_back();
+        }
+
+        if (mFlatCulling[i] == CULL_ALWAYS)
+        {
+            i = mFlatEnd[i];
+            continue;
+        }
+
+        bool const objectNoCull = (noCull || mFlatCulling[i] == CULL_NEVER);
+        unsigned int objectPlaneState = planeState;
+        if (!objectNoCull && !IsFlatVisible(i, objectPlaneState))
+        {
+            i = mFlatEnd[i];
+            continue;
+        }
+
+        if (mFlatKind[i] == FLAT_NODE)
+        {
+            ancestors.push_back({ mFlatEnd[i], planeState, noCull });
+            planeState = objectPlaneState;
+            noCull = objectNoCull;
+            ++i;
+        }
+        else
+        {
+            records.push_back({ i, objectPlaneState, objectNoCull });
+            i = mFlatEnd[i];
+        }
+    }
 }
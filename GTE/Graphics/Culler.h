@@ -3,12 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/BoundingSphere.h>
 #include <Graphics/Camera.h>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -24,6 +25,7 @@
 namespace gte
 {
     class Spatial;
+    class TaskScheduler;
     class Visual;
 
     enum CullingMode
@@ -75,6 +77,44 @@ namespace gte
             return mVisibleSet;
         }
 
+        // Culling of large scenes. Flatten(scene) stores the objects of the
+        // scene in depth-first order in arrays, each object with the index
+        // one past the last object of its subtree. The children of a Node
+        // are stored when Node::CanFlattenChildren() returns 'true'. Call
+        // Flatten again after objects are attached to or detached from the
+        // scene. The world bounds and culling modes are copied from the
+        // objects by each call to ComputeFlattenedVisibleSet, so the scene
+        // is updated as usual.
+        void Flatten(std::shared_ptr<Spatial> const& scene);
+
+        // Compute the potentially visible set of the flattened scene. The
+        // top of the hierarchy is culled until there are enough subtrees
+        // for the threads, and the subtrees are culled in numThreads
+        // threads or as tasks of the scheduler when it is not null. Each
+        // thread stores the visible objects of its subtrees in its own
+        // list, and the lists are merged in subtree order by calling Insert
+        // in the calling thread. The spheres are compared to 4 planes at a
+        // time using SIMD4<float>. The visible set and the order of the
+        // Insert calls are the same as those of ComputeVisibleSet(camera,
+        // scene).
+        void ComputeFlattenedVisibleSet(std::shared_ptr<Camera> const& camera,
+            unsigned int numThreads = 1);
+
+        // Compute the world planes of the camera's view frustum, indexed by
+        // the Camera::VF_* values. The normals point into the frustum.
+        static void GetViewFrustumPlanes(std::shared_ptr<Camera> const& camera,
+            std::array<CullingPlane<float>, Camera::VF_QUANTITY>& planes);
+
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
     protected:
         enum { INITIALLY_VISIBLE = 128 };
 
@@ -126,5 +166,46 @@ namespace gte
 
         // The potentially visible set generated by ComputeVisibleSet(scene).
         VisibleSet mVisibleSet;
+
+    private:
+        enum FlatKind
+        {
+            FLAT_NODE,
+            FLAT_VISUAL,
+            FLAT_OTHER
+        };
+
+        // A visible object found by a thread, which is a Visual or an
+        // object whose GetVisibleSet function must be called, with the
+        // plane state and noCull value for that call.
+        struct FlatRecord
+        {
+            int index;
+            unsigned int planeState;
+            bool noCull;
+        };
+
+        void FlattenSubtree(Spatial* spatial);
+        bool IsFlatVisible(int i, unsigned int& planeState) const;
+        void CullSubtree(int i, unsigned int planeState, bool noCull,
+            std::vector<FlatRecord>& records) const;
+
+        // The flattened scene.
+        std::shared_ptr<Spatial> mFlatScene;
+        std::vector<Spatial*> mFlatSpatial;
+        std::vector<int> mFlatEnd;
+        std::vector<FlatKind> mFlatKind;
+
+        // The world bounds and culling modes of the flattened scene, copied
+        // from the objects by ComputeFlattenedVisibleSet.
+        std::vector<float> mFlatCenterX, mFlatCenterY, mFlatCenterZ, mFlatRadius;
+        std::vector<CullingMode> mFlatCulling;
+
+        // The culling planes, 4 at a time, with the components stored
+        // contiguously: mFlatPlanes[g][j] is component j (N[0], N[1], N[2]
+        // or the constant) of planes 4*g through 4*g+3.
+        std::array<std::array<std::array<float, 4>, 4>, MAX_PLANE_QUANTITY / 4> mFlatPlanes;
+
+        TaskScheduler* mScheduler;
     };
 }
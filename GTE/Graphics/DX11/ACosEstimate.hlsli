@@ -0,0 +1,468 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Approximations to acos(x) = sqrt(1-x)*p(x) for x in [0,1].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/ACosEstimate.h. Do not edit it.
+
+#ifndef GTE_ACOSESTIMATE_HLSLI
+#define GTE_ACOSESTIMATE_HLSLI
+
+#define GTE_C_ACOS_DEG1_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG1_C1 -1.56582764421801413e-01
+#define GTE_C_ACOS_DEG1_MAX_ERROR +1.16590028037381055e-02
+#define GTE_C_ACOS_DEG2_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG2_C1 -2.03470538657983646e-01
+#define GTE_C_ACOS_DEG2_C2 +4.68877742361822336e-02
+#define GTE_C_ACOS_DEG2_MAX_ERROR +9.03116024900292580e-04
+#define GTE_C_ACOS_DEG3_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG3_C1 -2.12532918991902853e-01
+#define GTE_C_ACOS_DEG3_C2 +7.47737896394842227e-02
+#define GTE_C_ACOS_DEG3_C3 -1.88236350693824495e-02
+#define GTE_C_ACOS_DEG3_MAX_ERROR +9.30663969542881719e-05
+#define GTE_C_ACOS_DEG4_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG4_C1 -2.14222588352758647e-01
+#define GTE_C_ACOS_DEG4_C2 +8.49366751428441979e-02
+#define GTE_C_ACOS_DEG4_C3 -3.59914751209577943e-02
+#define GTE_C_ACOS_DEG4_C4 +8.69462390907127514e-03
+#define GTE_C_ACOS_DEG4_MAX_ERROR +1.09305958044814133e-05
+#define GTE_C_ACOS_DEG5_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG5_C1 -2.14532921398055243e-01
+#define GTE_C_ACOS_DEG5_C2 +8.79730892828893829e-02
+#define GTE_C_ACOS_DEG5_C3 -4.51302663821664396e-02
+#define GTE_C_ACOS_DEG5_C4 +1.94674666872813873e-02
+#define GTE_C_ACOS_DEG5_C5 -4.36013261176348976e-03
+#define GTE_C_ACOS_DEG5_MAX_ERROR +1.38610702572414257e-06
+#define GTE_C_ACOS_DEG6_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG6_C1 -2.14589392856773253e-01
+#define GTE_C_ACOS_DEG6_C2 +8.87849605636414907e-02
+#define GTE_C_ACOS_DEG6_C3 -4.88871314531564849e-02
+#define GTE_C_ACOS_DEG6_C4 +2.70115199600127198e-02
+#define GTE_C_ACOS_DEG6_C5 -1.12105373234783201e-02
+#define GTE_C_ACOS_DEG6_C6 +2.30781668791024686e-03
+#define GTE_C_ACOS_DEG6_MAX_ERROR +1.84912913304274840e-07
+#define GTE_C_ACOS_DEG7_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG7_C1 -2.14599600769298293e-01
+#define GTE_C_ACOS_DEG7_C2 +8.89869465733461595e-02
+#define GTE_C_ACOS_DEG7_C3 -5.02078430528456465e-02
+#define GTE_C_ACOS_DEG7_C4 +3.09615949776116395e-02
+#define GTE_C_ACOS_DEG7_C5 -1.71620311843980744e-02
+#define GTE_C_ACOS_DEG7_C6 +6.70723046766852349e-03
+#define GTE_C_ACOS_DEG7_C7 -1.26906143395899562e-03
+#define GTE_C_ACOS_DEG7_MAX_ERROR +2.55746209279483772e-08
+#define GTE_C_ACOS_DEG8_C0 +1.57079632679489656e+00
+#define GTE_C_ACOS_DEG8_C1 -2.14601436486880348e-01
+#define GTE_C_ACOS_DEG8_C2 +8.90347001079341283e-02
+#define GTE_C_ACOS_DEG8_C3 -5.06252799623894134e-02
+#define GTE_C_ACOS_DEG8_C4 +3.26837629431793175e-02
+#define GTE_C_ACOS_DEG8_C5 -2.09492787662384217e-02
+#define GTE_C_ACOS_DEG8_C6 +1.12729009169925121e-02
+#define GTE_C_ACOS_DEG8_C7 -4.11609810589652625e-03
+#define GTE_C_ACOS_DEG8_C8 +7.17964933414805273e-04
+#define GTE_C_ACOS_DEG8_MAX_ERROR +3.63400151290327322e-09
+
+float ACosEstimateDegree1(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG1_C1;
+    poly = GTE_C_ACOS_DEG1_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree1(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG1_C1;
+    poly = GTE_C_ACOS_DEG1_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree1(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG1_C1;
+    poly = GTE_C_ACOS_DEG1_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree1(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG1_C1;
+    poly = GTE_C_ACOS_DEG1_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree2(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG2_C2;
+    poly = GTE_C_ACOS_DEG2_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG2_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree2(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG2_C2;
+    poly = GTE_C_ACOS_DEG2_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG2_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree2(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG2_C2;
+    poly = GTE_C_ACOS_DEG2_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG2_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree2(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG2_C2;
+    poly = GTE_C_ACOS_DEG2_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG2_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree3(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG3_C3;
+    poly = GTE_C_ACOS_DEG3_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree3(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG3_C3;
+    poly = GTE_C_ACOS_DEG3_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree3(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG3_C3;
+    poly = GTE_C_ACOS_DEG3_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree3(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG3_C3;
+    poly = GTE_C_ACOS_DEG3_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG3_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree4(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG4_C4;
+    poly = GTE_C_ACOS_DEG4_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree4(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG4_C4;
+    poly = GTE_C_ACOS_DEG4_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree4(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG4_C4;
+    poly = GTE_C_ACOS_DEG4_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree4(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG4_C4;
+    poly = GTE_C_ACOS_DEG4_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG4_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree5(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG5_C5;
+    poly = GTE_C_ACOS_DEG5_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree5(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG5_C5;
+    poly = GTE_C_ACOS_DEG5_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree5(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG5_C5;
+    poly = GTE_C_ACOS_DEG5_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree5(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG5_C5;
+    poly = GTE_C_ACOS_DEG5_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG5_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree6(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG6_C6;
+    poly = GTE_C_ACOS_DEG6_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree6(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG6_C6;
+    poly = GTE_C_ACOS_DEG6_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree6(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG6_C6;
+    poly = GTE_C_ACOS_DEG6_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree6(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG6_C6;
+    poly = GTE_C_ACOS_DEG6_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG6_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree7(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG7_C7;
+    poly = GTE_C_ACOS_DEG7_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree7(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG7_C7;
+    poly = GTE_C_ACOS_DEG7_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree7(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG7_C7;
+    poly = GTE_C_ACOS_DEG7_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree7(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG7_C7;
+    poly = GTE_C_ACOS_DEG7_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG7_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float ACosEstimateDegree8(float x)
+{
+    float poly;
+    poly = GTE_C_ACOS_DEG8_C8;
+    poly = GTE_C_ACOS_DEG8_C7 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float2 ACosEstimateDegree8(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_ACOS_DEG8_C8;
+    poly = GTE_C_ACOS_DEG8_C7 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float3 ACosEstimateDegree8(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_ACOS_DEG8_C8;
+    poly = GTE_C_ACOS_DEG8_C7 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+float4 ACosEstimateDegree8(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_ACOS_DEG8_C8;
+    poly = GTE_C_ACOS_DEG8_C7 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C6 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C5 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C4 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C3 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C2 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C1 + poly * x;
+    poly = GTE_C_ACOS_DEG8_C0 + poly * x;
+    poly = poly * sqrt(1.0 - x);
+    return poly;
+}
+
+#endif
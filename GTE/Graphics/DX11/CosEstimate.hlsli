@@ -0,0 +1,455 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to cos(x) for x in [-pi/2,pi/2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/CosEstimate.h. Do not edit it.
+
+#ifndef GTE_COSESTIMATE_HLSLI
+#define GTE_COSESTIMATE_HLSLI
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_COS_DEG2_C0 +1.00000000000000000e+00
+#define GTE_C_COS_DEG2_C1 -4.05284734569351046e-01
+#define GTE_C_COS_DEG2_MAX_ERROR +5.48709468784040477e-02
+#define GTE_C_COS_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_COS_DEG4_C1 -4.96071819586472618e-01
+#define GTE_C_COS_DEG4_C2 +3.67946196534892356e-02
+#define GTE_C_COS_DEG4_MAX_ERROR +9.18799324497121539e-04
+#define GTE_C_COS_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_COS_DEG6_C1 -4.99927462170574044e-01
+#define GTE_C_COS_DEG6_C2 +4.14939203483533081e-02
+#define GTE_C_COS_DEG6_C3 -1.27124350119878216e-03
+#define GTE_C_COS_DEG6_MAX_ERROR +9.20284701330653654e-06
+#define GTE_C_COS_DEG8_C0 +1.00000000000000000e+00
+#define GTE_C_COS_DEG8_C1 -4.99999251213582907e-01
+#define GTE_C_COS_DEG8_C2 +4.16637801178056932e-02
+#define GTE_C_COS_DEG8_C3 -1.38542394053109419e-03
+#define GTE_C_COS_DEG8_C4 +2.31541715755012589e-05
+#define GTE_C_COS_DEG8_MAX_ERROR +5.98045330202356951e-08
+#define GTE_C_COS_DEG10_C0 +1.00000000000000000e+00
+#define GTE_C_COS_DEG10_C1 -4.99999995086958693e-01
+#define GTE_C_COS_DEG10_C2 +4.16666388653386122e-02
+#define GTE_C_COS_DEG10_C3 -1.38883776610398968e-03
+#define GTE_C_COS_DEG10_C4 +2.47604950889268594e-05
+#define GTE_C_COS_DEG10_C5 -2.60516154648726683e-07
+#define GTE_C_COS_DEG10_MAX_ERROR +2.70067690433251073e-10
+
+void CosEstimateReduce(float x, out float y, out float sgn)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with cos(y) = sgn*cos(x).
+    sgn = ((abs(y) > GTE_C_HALF_PI) ? -1.0 : 1.0);
+    y = ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+void CosEstimateReduce(float2 x, out float2 y, out float2 sgn)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float2 quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with cos(y) = sgn*cos(x).
+    sgn = ((abs(y) > GTE_C_HALF_PI) ? -1.0 : 1.0);
+    y = ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+void CosEstimateReduce(float3 x, out float3 y, out float3 sgn)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float3 quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with cos(y) = sgn*cos(x).
+    sgn = ((abs(y) > GTE_C_HALF_PI) ? -1.0 : 1.0);
+    y = ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+void CosEstimateReduce(float4 x, out float4 y, out float4 sgn)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float4 quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with cos(y) = sgn*cos(x).
+    sgn = ((abs(y) > GTE_C_HALF_PI) ? -1.0 : 1.0);
+    y = ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+float CosEstimateDegree2(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_COS_DEG2_C1;
+    poly = GTE_C_COS_DEG2_C0 + poly * xsqr;
+    return poly;
+}
+
+float CosEstimateDegree2RR(float x)
+{
+    float y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree2(y);
+}
+
+float2 CosEstimateDegree2(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_COS_DEG2_C1;
+    poly = GTE_C_COS_DEG2_C0 + poly * xsqr;
+    return poly;
+}
+
+float2 CosEstimateDegree2RR(float2 x)
+{
+    float2 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree2(y);
+}
+
+float3 CosEstimateDegree2(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_COS_DEG2_C1;
+    poly = GTE_C_COS_DEG2_C0 + poly * xsqr;
+    return poly;
+}
+
+float3 CosEstimateDegree2RR(float3 x)
+{
+    float3 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree2(y);
+}
+
+float4 CosEstimateDegree2(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_COS_DEG2_C1;
+    poly = GTE_C_COS_DEG2_C0 + poly * xsqr;
+    return poly;
+}
+
+float4 CosEstimateDegree2RR(float4 x)
+{
+    float4 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree2(y);
+}
+
+float CosEstimateDegree4(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_COS_DEG4_C2;
+    poly = GTE_C_COS_DEG4_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG4_C0 + poly * xsqr;
+    return poly;
+}
+
+float CosEstimateDegree4RR(float x)
+{
+    float y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree4(y);
+}
+
+float2 CosEstimateDegree4(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_COS_DEG4_C2;
+    poly = GTE_C_COS_DEG4_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG4_C0 + poly * xsqr;
+    return poly;
+}
+
+float2 CosEstimateDegree4RR(float2 x)
+{
+    float2 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree4(y);
+}
+
+float3 CosEstimateDegree4(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_COS_DEG4_C2;
+    poly = GTE_C_COS_DEG4_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG4_C0 + poly * xsqr;
+    return poly;
+}
+
+float3 CosEstimateDegree4RR(float3 x)
+{
+    float3 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree4(y);
+}
+
+float4 CosEstimateDegree4(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_COS_DEG4_C2;
+    poly = GTE_C_COS_DEG4_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG4_C0 + poly * xsqr;
+    return poly;
+}
+
+float4 CosEstimateDegree4RR(float4 x)
+{
+    float4 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree4(y);
+}
+
+float CosEstimateDegree6(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_COS_DEG6_C3;
+    poly = GTE_C_COS_DEG6_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C0 + poly * xsqr;
+    return poly;
+}
+
+float CosEstimateDegree6RR(float x)
+{
+    float y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree6(y);
+}
+
+float2 CosEstimateDegree6(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_COS_DEG6_C3;
+    poly = GTE_C_COS_DEG6_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C0 + poly * xsqr;
+    return poly;
+}
+
+float2 CosEstimateDegree6RR(float2 x)
+{
+    float2 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree6(y);
+}
+
+float3 CosEstimateDegree6(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_COS_DEG6_C3;
+    poly = GTE_C_COS_DEG6_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C0 + poly * xsqr;
+    return poly;
+}
+
+float3 CosEstimateDegree6RR(float3 x)
+{
+    float3 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree6(y);
+}
+
+float4 CosEstimateDegree6(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_COS_DEG6_C3;
+    poly = GTE_C_COS_DEG6_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG6_C0 + poly * xsqr;
+    return poly;
+}
+
+float4 CosEstimateDegree6RR(float4 x)
+{
+    float4 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree6(y);
+}
+
+float CosEstimateDegree8(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_COS_DEG8_C4;
+    poly = GTE_C_COS_DEG8_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C0 + poly * xsqr;
+    return poly;
+}
+
+float CosEstimateDegree8RR(float x)
+{
+    float y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree8(y);
+}
+
+float2 CosEstimateDegree8(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_COS_DEG8_C4;
+    poly = GTE_C_COS_DEG8_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C0 + poly * xsqr;
+    return poly;
+}
+
+float2 CosEstimateDegree8RR(float2 x)
+{
+    float2 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree8(y);
+}
+
+float3 CosEstimateDegree8(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_COS_DEG8_C4;
+    poly = GTE_C_COS_DEG8_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C0 + poly * xsqr;
+    return poly;
+}
+
+float3 CosEstimateDegree8RR(float3 x)
+{
+    float3 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree8(y);
+}
+
+float4 CosEstimateDegree8(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_COS_DEG8_C4;
+    poly = GTE_C_COS_DEG8_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG8_C0 + poly * xsqr;
+    return poly;
+}
+
+float4 CosEstimateDegree8RR(float4 x)
+{
+    float4 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree8(y);
+}
+
+float CosEstimateDegree10(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_COS_DEG10_C5;
+    poly = GTE_C_COS_DEG10_C4 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C0 + poly * xsqr;
+    return poly;
+}
+
+float CosEstimateDegree10RR(float x)
+{
+    float y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree10(y);
+}
+
+float2 CosEstimateDegree10(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_COS_DEG10_C5;
+    poly = GTE_C_COS_DEG10_C4 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C0 + poly * xsqr;
+    return poly;
+}
+
+float2 CosEstimateDegree10RR(float2 x)
+{
+    float2 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree10(y);
+}
+
+float3 CosEstimateDegree10(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_COS_DEG10_C5;
+    poly = GTE_C_COS_DEG10_C4 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C0 + poly * xsqr;
+    return poly;
+}
+
+float3 CosEstimateDegree10RR(float3 x)
+{
+    float3 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree10(y);
+}
+
+float4 CosEstimateDegree10(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_COS_DEG10_C5;
+    poly = GTE_C_COS_DEG10_C4 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C3 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C2 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C1 + poly * xsqr;
+    poly = GTE_C_COS_DEG10_C0 + poly * xsqr;
+    return poly;
+}
+
+float4 CosEstimateDegree10RR(float4 x)
+{
+    float4 y, sgn;
+    CosEstimateReduce(x, y, sgn);
+    return sgn * CosEstimateDegree10(y);
+}
+
+#endif
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.05.28
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11Buffer.h>
@@ -21,6 +21,26 @@ bool DX11Buffer::Update(ID3D11DeviceContext* context)
     Buffer* buffer = GetBuffer();
     LogAssert(buffer->GetUsage() == Resource::DYNAMIC_UPDATE, "Buffer must be dynamic-update.");
 
+    if (buffer->HasDirtyRanges() && mUpdateMapMode == D3D11_MAP_WRITE_NO_OVERWRITE)
+    {
+        // Copy only the modified ranges from CPU memory. The caller has
+        // guaranteed by the map mode that the GPU is not reading them. With
+        // D3D11_MAP_WRITE_DISCARD the entire buffer must be copied, which
+        // the code after this block does.
+        ID3D11Buffer* dxBuffer = GetDXBuffer();
+        D3D11_MAPPED_SUBRESOURCE sub;
+        DX11Log(context->Map(dxBuffer, 0, D3D11_MAP_WRITE_NO_OVERWRITE, 0, &sub));
+        for (auto const& range : buffer->GetDirtyRanges())
+        {
+            std::memcpy(static_cast<char*>(sub.pData) + range.first,
+                buffer->GetData() + range.first, range.second - range.first);
+        }
+        context->Unmap(dxBuffer, 0);
+        buffer->ClearDirtyRanges();
+        return true;
+    }
+    buffer->ClearDirtyRanges();
+
     UINT numActiveBytes = buffer->GetNumActiveBytes();
     if (numActiveBytes > 0)
     {
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -27,6 +27,8 @@ namespace gte
 
         // Copy data from CPU to GPU via mapped memory.  Buffers use only
         // subresource 0, so the subresource index (sri) is not exposed.
+        // Update copies only the dirty ranges of the buffer when the map
+        // mode is D3D11_MAP_WRITE_NO_OVERWRITE; see mUpdateMapMode.
         virtual bool Update(ID3D11DeviceContext* context) override;
         virtual bool CopyCpuToGpu(ID3D11DeviceContext* context) override;
         virtual bool CopyGpuToCpu(ID3D11DeviceContext* context) override;
@@ -35,6 +37,20 @@ namespace gte
         // subresource.  The second function copies all subresources.
         virtual void CopyGpuToGpu(ID3D11DeviceContext* context, ID3D11Resource* target) override;
 
+        // The map mode of Update, D3D11_MAP_WRITE_DISCARD by default.  An
+        // application that does not modify the ranges read by the draws
+        // in flight may select D3D11_MAP_WRITE_NO_OVERWRITE for vertex and
+        // index buffers (constant buffers require D3D11.1).
+        inline void SetUpdateMapMode(D3D11_MAP mode)
+        {
+            mUpdateMapMode = mode;
+        }
+
+        inline D3D11_MAP GetUpdateMapMode() const
+        {
+            return mUpdateMapMode;
+        }
+
     private:
         // Buffers use only subresource 0, so these overrides are stubbed out.
         virtual bool Update(ID3D11DeviceContext* context, unsigned int sri) override;
@@ -0,0 +1,178 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/DX11/GTGraphicsDX11PCH.h>
+#include <Graphics/DX11/DX11DeferredContext.h>
+#include <Graphics/DX11/DX11BlendState.h>
+#include <Graphics/DX11/DX11Buffer.h>
+#include <Graphics/DX11/DX11ComputeShader.h>
+#include <Graphics/DX11/DX11DepthStencilState.h>
+#include <Graphics/DX11/DX11Engine.h>
+#include <Graphics/DX11/DX11RasterizerState.h>
+#include <Graphics/DX11/HLSLComputeProgram.h>
+#include <Graphics/InstancedVisual.h>
+#include <array>
+using namespace gte;
+
+DX11DeferredContext::~DX11DeferredContext()
+{
+    DX11::SafeRelease(mCommandList);
+    DX11::FinalRelease(mContext);
+}
+
+DX11DeferredContext::DX11DeferredContext(DX11Engine* engine)
+    :
+    mEngine(engine),
+    mContext(nullptr),
+    mCommandList(nullptr)
+{
+    LogAssert(engine != nullptr && engine->GetDevice() != nullptr, "Invalid engine.");
+    DX11Log(engine->GetDevice()->CreateDeferredContext(0, &mContext));
+}
+
+void DX11DeferredContext::Begin()
+{
+    DX11::SafeRelease(mCommandList);
+
+    // A deferred context starts with the default state. Copy the state that
+    // the engine set in the immediate context. The Get* functions increment
+    // the reference counts of the returned interfaces.
+    ID3D11DeviceContext* immediate = mEngine->GetImmediate();
+
+    std::array<ID3D11RenderTargetView*, D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT> rtViews{};
+    ID3D11DepthStencilView* dsView = nullptr;
+    immediate->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, rtViews.data(), &dsView);
+    mContext->OMSetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, rtViews.data(), dsView);
+    for (auto& rtView : rtViews)
+    {
+        DX11::SafeRelease(rtView);
+    }
+    DX11::SafeRelease(dsView);
+
+    UINT numViewports = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+    std::array<D3D11_VIEWPORT, D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE> viewports;
+    immediate->RSGetViewports(&numViewports, viewports.data());
+    mContext->RSSetViewports(numViewports, viewports.data());
+
+    ID3D11BlendState* blendState = nullptr;
+    std::array<FLOAT, 4> blendFactor{};
+    UINT sampleMask = 0;
+    immediate->OMGetBlendState(&blendState, blendFactor.data(), &sampleMask);
+    mContext->OMSetBlendState(blendState, blendFactor.data(), sampleMask);
+    DX11::SafeRelease(blendState);
+
+    ID3D11DepthStencilState* depthStencilState = nullptr;
+    UINT stencilRef = 0;
+    immediate->OMGetDepthStencilState(&depthStencilState, &stencilRef);
+    mContext->OMSetDepthStencilState(depthStencilState, stencilRef);
+    DX11::SafeRelease(depthStencilState);
+
+    ID3D11RasterizerState* rasterizerState = nullptr;
+    immediate->RSGetState(&rasterizerState);
+    mContext->RSSetState(rasterizerState);
+    DX11::SafeRelease(rasterizerState);
+}
+
+bool DX11DeferredContext::Update(std::shared_ptr<Buffer> const& buffer)
+{
+    DX11Buffer* dxBuffer = static_cast<DX11Buffer*>(mEngine->Bind(buffer));
+    return dxBuffer->Update(mContext);
+}
+
+void DX11DeferredContext::SetBlendState(std::shared_ptr<BlendState> const& state)
+{
+    LogAssert(state != nullptr, "Input state is null.");
+    DX11BlendState* dxState = static_cast<DX11BlendState*>(mEngine->Bind(state));
+    dxState->Enable(mContext);
+}
+
+void DX11DeferredContext::SetDepthStencilState(std::shared_ptr<DepthStencilState> const& state)
+{
+    LogAssert(state != nullptr, "Input state is null.");
+    DX11DepthStencilState* dxState = static_cast<DX11DepthStencilState*>(mEngine->Bind(state));
+    dxState->Enable(mContext);
+}
+
+void DX11DeferredContext::SetRasterizerState(std::shared_ptr<RasterizerState> const& state)
+{
+    LogAssert(state != nullptr, "Input state is null.");
+    DX11RasterizerState* dxState = static_cast<DX11RasterizerState*>(mEngine->Bind(state));
+    dxState->Enable(mContext);
+}
+
+uint64_t DX11DeferredContext::Draw(Visual* visual)
+{
+    LogAssert(visual != nullptr, "Input visual is null.");
+    auto const& vbuffer = visual->GetVertexBuffer();
+    auto const& ibuffer = visual->GetIndexBuffer();
+    auto const& effect = visual->GetEffect();
+    if (vbuffer && ibuffer && effect)
+    {
+        InstancedVisual* instanced = dynamic_cast<InstancedVisual*>(visual);
+        if (instanced && instanced->GetInstanceBuffer())
+        {
+            return mEngine->DrawPrimitive(mContext, vbuffer, ibuffer, effect,
+                instanced->GetInstanceBuffer());
+        }
+        return mEngine->DrawPrimitive(mContext, vbuffer, ibuffer, effect);
+    }
+    return 0;
+}
+
+uint64_t DX11DeferredContext::Draw(std::vector<Visual*> const& visuals)
+{
+    for (auto visual : visuals)
+    {
+        Draw(visual);
+    }
+    return 0;
+}
+
+uint64_t DX11DeferredContext::Draw(std::shared_ptr<Visual> const& visual)
+{
+    return Draw(visual.get());
+}
+
+uint64_t DX11DeferredContext::Draw(std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<IndexBuffer> const& ibuffer, std::shared_ptr<VisualEffect> const& effect)
+{
+    return mEngine->DrawPrimitive(mContext, vbuffer, ibuffer, effect);
+}
+
+void DX11DeferredContext::Execute(std::shared_ptr<ComputeProgram> const& program,
+    unsigned int numXGroups, unsigned int numYGroups, unsigned int numZGroups)
+{
+    auto hlslProgram = std::dynamic_pointer_cast<HLSLComputeProgram>(program);
+    if (hlslProgram && numXGroups > 0 && numYGroups > 0 && numZGroups > 0)
+    {
+        auto cshader = hlslProgram->GetComputeShader();
+        if (cshader)
+        {
+            DX11ComputeShader* dxCShader = static_cast<DX11ComputeShader*>(mEngine->Bind(cshader));
+            mEngine->Enable(mContext, cshader.get(), dxCShader);
+            mContext->Dispatch(numXGroups, numYGroups, numZGroups);
+            mEngine->Disable(mContext, cshader.get(), dxCShader);
+        }
+        else
+        {
+            LogError("Invalid input parameter.");
+        }
+    }
+}
+
+bool DX11DeferredContext::End()
+{
+    DX11::SafeRelease(mCommandList);
+    HRESULT hr = mContext->FinishCommandList(FALSE, &mCommandList);
+    if (FAILED(hr))
+    {
+        LogWarning("FinishCommandList failed.");
+        mCommandList = nullptr;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,87 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/DX11/DX11.h>
+#include <Graphics/BlendState.h>
+#include <Graphics/Buffer.h>
+#include <Graphics/ComputeProgram.h>
+#include <Graphics/DepthStencilState.h>
+#include <Graphics/RasterizerState.h>
+#include <Graphics/Visual.h>
+#include <memory>
+#include <vector>
+
+// Support for recording draws and compute dispatches in a thread other than
+// that of the immediate context. The objects are created by
+// DX11Engine::CreateDeferredContext. Begin is called in the thread of the
+// immediate context, which is not thread safe, and copies its render
+// targets, viewport and global states to the deferred context. The other
+// recording functions may be called in one worker thread per deferred
+// context. End finishes the command list, which is executed by
+// DX11Engine::ExecuteCommandLists in the thread of the immediate context.
+// The graphics objects used by the recording functions must have been bound
+// by the engine (see DX11Engine::BindForRecording).
+
+namespace gte
+{
+    class DX11Engine;
+
+    class DX11DeferredContext
+    {
+    public:
+        // Construction and destruction.
+        ~DX11DeferredContext();
+        DX11DeferredContext(DX11Engine* engine);
+
+        // Access to the deferred context for DX11-specific recording.
+        inline ID3D11DeviceContext* GetContext() const
+        {
+            return mContext;
+        }
+
+        // Start recording a command list. This function must be called in
+        // the thread of the immediate context.
+        void Begin();
+
+        // Copy the CPU data of a DYNAMIC_UPDATE buffer to the GPU in the
+        // order of the recorded commands.
+        bool Update(std::shared_ptr<Buffer> const& buffer);
+
+        // Global drawing state.
+        void SetBlendState(std::shared_ptr<BlendState> const& state);
+        void SetDepthStencilState(std::shared_ptr<DepthStencilState> const& state);
+        void SetRasterizerState(std::shared_ptr<RasterizerState> const& state);
+
+        // Record draws. The return values are 0, because occlusion queries
+        // are not supported by deferred contexts.
+        uint64_t Draw(Visual* visual);
+        uint64_t Draw(std::vector<Visual*> const& visuals);
+        uint64_t Draw(std::shared_ptr<Visual> const& visual);
+        uint64_t Draw(std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect);
+
+        // Record a compute dispatch.
+        void Execute(std::shared_ptr<ComputeProgram> const& program,
+            unsigned int numXGroups, unsigned int numYGroups, unsigned int numZGroups);
+
+        // Finish the command list. The function returns 'false' when the
+        // command list could not be created.
+        bool End();
+
+    private:
+        // Allow the engine to access the members directly to avoid exposing
+        // internals via the public interface.
+        friend class DX11Engine;
+
+        DX11Engine* mEngine;
+        ID3D11DeviceContext* mContext;
+        ID3D11CommandList* mCommandList;
+    };
+}
@@ -3,13 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.12.25
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11Engine.h>
+#include <Graphics/InstancedVisual.h>
 #include <Graphics/DX11/DX11BlendState.h>
 #include <Graphics/DX11/DX11ComputeShader.h>
 #include <Graphics/DX11/DX11ConstantBuffer.h>
+#include <Graphics/DX11/DX11DeferredContext.h>
 #include <Graphics/DX11/DX11DepthStencilState.h>
 #include <Graphics/DX11/DX11DrawTarget.h>
 #include <Graphics/DX11/DX11GeometryShader.h>
@@ -37,6 +39,19 @@ using namespace gte;
 DX11Engine::~DX11Engine()
 {
     DX11::FinalRelease(mWaitQuery);
+    for (auto& query : mQueries)
+    {
+        DX11::SafeRelease(query.first);
+        DX11::SafeRelease(query.second);
+    }
+    for (auto& timestampSet : mTimestampSets)
+    {
+        DX11::SafeRelease(timestampSet.disjoint);
+        for (auto& timestamp : timestampSet.timestamps)
+        {
+            DX11::SafeRelease(timestamp);
+        }
+    }
 
     // The render state objects (and fonts) are destroyed first so that the
     // render state objects are removed from the bridges before they are
@@ -331,6 +346,85 @@ void DX11Engine::EndTimer(DX11PerformanceCounter& counter)
     }
 }
 
+std::shared_ptr<DX11DeferredContext> DX11Engine::CreateDeferredContext()
+{
+    return std::make_shared<DX11DeferredContext>(this);
+}
+
+void DX11Engine::BindForRecording(std::vector<Visual*> const& visuals)
+{
+    DX11InputLayoutManager* manager = static_cast<DX11InputLayoutManager*>(mILMap.get());
+    for (auto visual : visuals)
+    {
+        auto const& vbuffer = visual->GetVertexBuffer();
+        auto const& ibuffer = visual->GetIndexBuffer();
+        auto const& effect = visual->GetEffect();
+        if (!vbuffer || !ibuffer || !effect)
+        {
+            continue;
+        }
+
+        std::array<std::shared_ptr<Shader>, 3> shaders =
+        {
+            effect->GetVertexShader(),
+            effect->GetGeometryShader(),
+            effect->GetPixelShader()
+        };
+
+        for (auto const& shader : shaders)
+        {
+            if (shader)
+            {
+                Bind(shader);
+                for (int lookup = 0; lookup < Shader::NUM_LOOKUP_INDICES; ++lookup)
+                {
+                    for (auto const& data : shader->GetData(lookup))
+                    {
+                        if (data.object)
+                        {
+                            Bind(data.object);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (vbuffer->StandardUsage())
+        {
+            Bind(vbuffer);
+            InstancedVisual* instanced = dynamic_cast<InstancedVisual*>(visual);
+            if (instanced && instanced->GetInstanceBuffer())
+            {
+                auto const& instanceBuffer = instanced->GetInstanceBuffer();
+                Bind(instanceBuffer);
+                manager->Bind(mDevice, vbuffer.get(), shaders[0].get(), instanceBuffer.get());
+            }
+            else
+            {
+                manager->Bind(mDevice, vbuffer.get(), shaders[0].get());
+            }
+        }
+
+        if (ibuffer->IsIndexed())
+        {
+            Bind(ibuffer);
+        }
+    }
+}
+
+void DX11Engine::ExecuteCommandLists(
+    std::vector<std::shared_ptr<DX11DeferredContext>> const& contexts)
+{
+    for (auto const& context : contexts)
+    {
+        if (context && context->mCommandList)
+        {
+            mImmediate->ExecuteCommandList(context->mCommandList, TRUE);
+            DX11::SafeRelease(context->mCommandList);
+        }
+    }
+}
+
 void DX11Engine::Initialize(IDXGIAdapter* adapter, D3D_DRIVER_TYPE driverType,
     HMODULE softwareModule, UINT flags, bool useDepth24Stencil8)
 {
@@ -366,6 +460,16 @@ void DX11Engine::Initialize(IDXGIAdapter* adapter, D3D_DRIVER_TYPE driverType,
     mSaveDS = nullptr;
     mWaitQuery = nullptr;
 
+    mInDrawBatch = false;
+    mBatchInputIsSet = false;
+    mBatchEffect = nullptr;
+    mBatchVShader = nullptr;
+    mBatchGShader = nullptr;
+    mBatchPShader = nullptr;
+    mBatchVBuffer = nullptr;
+    mBatchLayout = nullptr;
+    mBatchIBuffer = nullptr;
+
     mBackBufferStaging = nullptr;
 
     // Initialization of GraphicsEngine members that depend on DX11.
@@ -749,7 +853,9 @@ bool DX11Engine::DestroyBackBuffer()
         && DX11::FinalRelease(mDepthStencilBuffer) == 0;
 }
 
-uint64_t DX11Engine::DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer const* ibuffer)
+uint64_t DX11Engine::DrawPrimitive(ID3D11DeviceContext* context, VertexBuffer const* vbuffer,
+    IndexBuffer const* ibuffer, VertexBuffer const* instanceBuffer, ID3D11Buffer* arguments,
+    UINT offset, UINT numDraws)
 {
     UINT numActiveVertices = vbuffer->GetNumActiveElements();
     UINT vertexOffset = vbuffer->GetOffset();
@@ -761,63 +867,130 @@ uint64_t DX11Engine::DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer cons
     switch (type)
     {
     case IPType::IP_POLYPOINT:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_POINTLIST);
         break;
     case IPType::IP_POLYSEGMENT_DISJOINT:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
         break;
     case IPType::IP_POLYSEGMENT_CONTIGUOUS:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP);
         break;
     case IPType::IP_TRIMESH:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
         break;
     case IPType::IP_TRISTRIP:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
         break;
     case IPType::IP_POLYSEGMENT_DISJOINT_ADJ:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST_ADJ);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST_ADJ);
         break;
     case IPType::IP_POLYSEGMENT_CONTIGUOUS_ADJ:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP_ADJ);
         break;
     case IPType::IP_TRIMESH_ADJ:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST_ADJ);
         break;
     case IPType::IP_TRISTRIP_ADJ:
-        mImmediate->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ);
+        context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP_ADJ);
         break;
     default:
         LogError("Unknown primitive topology = " + std::to_string(type));
     }
 
+    // The draws recorded in deferred contexts are not counted in the frame
+    // statistics, because they can be recorded by other threads.
+    bool const countDraws = (context == mImmediate);
+    uint64_t numDrawsIssued = 0, numPrimitivesDrawn = 0;
+
     ID3D11Query* occlusionQuery = nullptr;
     uint64_t numPixelsDrawn = 0;
-    if (mAllowOcclusionQuery)
+    bool const useOcclusionQuery = (mAllowOcclusionQuery && context == mImmediate);
+    if (useOcclusionQuery)
     {
         occlusionQuery = BeginOcclusionQuery();
     }
 
-    if (ibuffer->IsIndexed())
+    if (arguments && numDraws > 0)
+    {
+        // The records are 5 UINTs for DrawIndexedInstancedIndirect and
+        // 4 UINTs for DrawInstancedIndirect.
+        if (ibuffer->IsIndexed())
+        {
+            UINT const stride = static_cast<UINT>(5 * sizeof(UINT));
+            for (UINT d = 0; d < numDraws; ++d)
+            {
+                context->DrawIndexedInstancedIndirect(arguments, offset + stride * d);
+            }
+        }
+        else
+        {
+            UINT const stride = static_cast<UINT>(4 * sizeof(UINT));
+            for (UINT d = 0; d < numDraws; ++d)
+            {
+                context->DrawInstancedIndirect(arguments, offset + stride * d);
+            }
+        }
+        numDrawsIssued = numDraws;
+    }
+    else if (instanceBuffer)
+    {
+        // The offset of the instance buffer is the first instance.
+        UINT numInstances = instanceBuffer->GetNumActiveElements();
+        UINT firstInstance = instanceBuffer->GetOffset();
+        if (numInstances > 0)
+        {
+            if (ibuffer->IsIndexed())
+            {
+                if (numActiveIndices > 0)
+                {
+                    context->DrawIndexedInstanced(numActiveIndices, numInstances,
+                        firstIndex, vertexOffset, firstInstance);
+                    numDrawsIssued = 1;
+                    numPrimitivesDrawn = static_cast<uint64_t>(ibuffer->GetNumActivePrimitives()) * numInstances;
+                }
+            }
+            else
+            {
+                if (numActiveVertices > 0)
+                {
+                    context->DrawInstanced(numActiveVertices, numInstances,
+                        vertexOffset, firstInstance);
+                    numDrawsIssued = 1;
+                    numPrimitivesDrawn = static_cast<uint64_t>(ibuffer->GetNumActivePrimitives()) * numInstances;
+                }
+            }
+        }
+    }
+    else if (ibuffer->IsIndexed())
     {
         if (numActiveIndices > 0)
         {
-            mImmediate->DrawIndexed(numActiveIndices, firstIndex, vertexOffset);
+            context->DrawIndexed(numActiveIndices, firstIndex, vertexOffset);
+            numDrawsIssued = 1;
+            numPrimitivesDrawn = ibuffer->GetNumActivePrimitives();
         }
     }
     else
     {
         if (numActiveVertices > 0)
         {
-            mImmediate->Draw(numActiveVertices, vertexOffset);
+            context->Draw(numActiveVertices, vertexOffset);
+            numDrawsIssued = 1;
+            numPrimitivesDrawn = ibuffer->GetNumActivePrimitives();
         }
     }
 
-    if (mAllowOcclusionQuery)
+    if (useOcclusionQuery)
     {
         numPixelsDrawn = EndOcclusionQuery(occlusionQuery);
     }
 
+    if (countDraws)
+    {
+        mStatistics.numDraws += numDrawsIssued;
+        mStatistics.numPrimitives += numPrimitivesDrawn;
+    }
+
     return numPixelsDrawn;
 }
 
@@ -855,8 +1028,9 @@ uint64_t DX11Engine::EndOcclusionQuery(ID3D11Query* occlusionQuery)
     LogError("No query provided.");
 }
 
-bool DX11Engine::EnableShaders(std::shared_ptr<VisualEffect> const& effect,
-    DX11VertexShader*& dxVShader, DX11GeometryShader*& dxGShader, DX11PixelShader*& dxPShader)
+bool DX11Engine::EnableShaders(ID3D11DeviceContext* context,
+    std::shared_ptr<VisualEffect> const& effect, DX11VertexShader*& dxVShader,
+    DX11GeometryShader*& dxGShader, DX11PixelShader*& dxPShader)
 {
     dxVShader = nullptr;
     dxGShader = nullptr;
@@ -877,52 +1051,68 @@ bool DX11Engine::EnableShaders(std::shared_ptr<VisualEffect> const& effect,
     dxPShader = static_cast<DX11PixelShader*>(Bind(effect->GetPixelShader()));
 
     // Enable the shaders and resources.
-    Enable(effect->GetVertexShader().get(), dxVShader);
-    Enable(effect->GetPixelShader().get(), dxPShader);
+    Enable(context, effect->GetVertexShader().get(), dxVShader);
+    Enable(context, effect->GetPixelShader().get(), dxPShader);
     if (dxGShader)
     {
-        Enable(effect->GetGeometryShader().get(), dxGShader);
+        Enable(context, effect->GetGeometryShader().get(), dxGShader);
+    }
+
+    if (context == mImmediate)
+    {
+        ++mStatistics.numProgramBinds;
     }
 
     return true;
 }
 
-void DX11Engine::DisableShaders(std::shared_ptr<VisualEffect> const& effect,
-    DX11VertexShader* dxVShader, DX11GeometryShader* dxGShader, DX11PixelShader* dxPShader)
+void DX11Engine::DisableShaders(ID3D11DeviceContext* context,
+    std::shared_ptr<VisualEffect> const& effect, DX11VertexShader* dxVShader,
+    DX11GeometryShader* dxGShader, DX11PixelShader* dxPShader)
 {
     if (dxGShader)
     {
-        Disable(effect->GetGeometryShader().get(), dxGShader);
+        Disable(context, effect->GetGeometryShader().get(), dxGShader);
     }
-    Disable(effect->GetPixelShader().get(), dxPShader);
-    Disable(effect->GetVertexShader().get(), dxVShader);
+    Disable(context, effect->GetPixelShader().get(), dxPShader);
+    Disable(context, effect->GetVertexShader().get(), dxVShader);
 }
 
-void DX11Engine::Enable(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::Enable(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
-    dxShader->Enable(mImmediate);
-    EnableCBuffers(shader, dxShader);
-    EnableTBuffers(shader, dxShader);
-    EnableSBuffers(shader, dxShader);
-    EnableRBuffers(shader, dxShader);
-    EnableTextures(shader, dxShader);
-    EnableTextureArrays(shader, dxShader);
-    EnableSamplers(shader, dxShader);
+    dxShader->Enable(context);
+    EnableCBuffers(context, shader, dxShader);
+    EnableTBuffers(context, shader, dxShader);
+    EnableSBuffers(context, shader, dxShader);
+    EnableRBuffers(context, shader, dxShader);
+    EnableTextures(context, shader, dxShader);
+    EnableTextureArrays(context, shader, dxShader);
+    EnableSamplers(context, shader, dxShader);
+
+    if (context == mImmediate)
+    {
+        mStatistics.numBufferBinds += shader->GetData(ConstantBuffer::shaderDataLookup).size()
+            + shader->GetData(TextureBuffer::shaderDataLookup).size()
+            + shader->GetData(StructuredBuffer::shaderDataLookup).size()
+            + shader->GetData(RawBuffer::shaderDataLookup).size();
+        mStatistics.numTextureBinds += shader->GetData(TextureSingle::shaderDataLookup).size()
+            + shader->GetData(TextureArray::shaderDataLookup).size();
+    }
 }
 
-void DX11Engine::Disable(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::Disable(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
-    DisableSamplers(shader, dxShader);
-    DisableTextureArrays(shader, dxShader);
-    DisableTextures(shader, dxShader);
-    DisableRBuffers(shader, dxShader);
-    DisableSBuffers(shader, dxShader);
-    DisableTBuffers(shader, dxShader);
-    DisableCBuffers(shader, dxShader);
-    dxShader->Disable(mImmediate);
+    DisableSamplers(context, shader, dxShader);
+    DisableTextureArrays(context, shader, dxShader);
+    DisableTextures(context, shader, dxShader);
+    DisableRBuffers(context, shader, dxShader);
+    DisableSBuffers(context, shader, dxShader);
+    DisableTBuffers(context, shader, dxShader);
+    DisableCBuffers(context, shader, dxShader);
+    dxShader->Disable(context);
 }
 
-void DX11Engine::EnableCBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableCBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = ConstantBuffer::shaderDataLookup;
     for (auto const& cb : shader->GetData(index))
@@ -932,7 +1122,7 @@ void DX11Engine::EnableCBuffers(Shader const* shader, DX11Shader* dxShader)
             DX11ConstantBuffer* dxCB = static_cast<DX11ConstantBuffer*>(Bind(cb.object));
             if (dxCB)
             {
-                dxShader->EnableCBuffer(mImmediate, cb.bindPoint, dxCB->GetDXBuffer());
+                dxShader->EnableCBuffer(context, cb.bindPoint, dxCB->GetDXBuffer());
             }
             else
             {
@@ -946,16 +1136,16 @@ void DX11Engine::EnableCBuffers(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableCBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::DisableCBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = ConstantBuffer::shaderDataLookup;
     for (auto const& cb : shader->GetData(index))
     {
-        dxShader->DisableCBuffer(mImmediate, cb.bindPoint);
+        dxShader->DisableCBuffer(context, cb.bindPoint);
     }
 }
 
-void DX11Engine::EnableTBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableTBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = TextureBuffer::shaderDataLookup;
     for (auto const& tb : shader->GetData(index))
@@ -965,7 +1155,7 @@ void DX11Engine::EnableTBuffers(Shader const* shader, DX11Shader* dxShader)
             DX11TextureBuffer* dxTB = static_cast<DX11TextureBuffer*>(Bind(tb.object));
             if (dxTB)
             {
-                dxShader->EnableSRView(mImmediate, tb.bindPoint, dxTB->GetSRView());
+                dxShader->EnableSRView(context, tb.bindPoint, dxTB->GetSRView());
             }
             else
             {
@@ -979,16 +1169,16 @@ void DX11Engine::EnableTBuffers(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableTBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::DisableTBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = TextureBuffer::shaderDataLookup;
     for (auto const& tb : shader->GetData(index))
     {
-        dxShader->DisableSRView(mImmediate, tb.bindPoint);
+        dxShader->DisableSRView(context, tb.bindPoint);
     }
 }
 
-void DX11Engine::EnableSBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableSBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = StructuredBuffer::shaderDataLookup;
     for (auto const& sb : shader->GetData(index))
@@ -1004,11 +1194,11 @@ void DX11Engine::EnableSBuffers(Shader const* shader, DX11Shader* dxShader)
 
                     unsigned int numActive = (gtSB->GetKeepInternalCount() ?
                         0xFFFFFFFFu : gtSB->GetNumActiveElements());
-                    dxShader->EnableUAView(mImmediate, sb.bindPoint, dxSB->GetUAView(), numActive);
+                    dxShader->EnableUAView(context, sb.bindPoint, dxSB->GetUAView(), numActive);
                 }
                 else
                 {
-                    dxShader->EnableSRView(mImmediate, sb.bindPoint, dxSB->GetSRView());
+                    dxShader->EnableSRView(context, sb.bindPoint, dxSB->GetSRView());
                 }
             }
             else
@@ -1023,23 +1213,23 @@ void DX11Engine::EnableSBuffers(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableSBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::DisableSBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = StructuredBuffer::shaderDataLookup;
     for (auto const& sb : shader->GetData(index))
     {
         if (sb.isGpuWritable)
         {
-            dxShader->DisableUAView(mImmediate, sb.bindPoint);
+            dxShader->DisableUAView(context, sb.bindPoint);
         }
         else
         {
-            dxShader->DisableSRView(mImmediate, sb.bindPoint);
+            dxShader->DisableSRView(context, sb.bindPoint);
         }
     }
 }
 
-void DX11Engine::EnableRBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableRBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = RawBuffer::shaderDataLookup;
     for (auto const& rb : shader->GetData(index))
@@ -1051,11 +1241,11 @@ void DX11Engine::EnableRBuffers(Shader const* shader, DX11Shader* dxShader)
             {
                 if (rb.isGpuWritable)
                 {
-                    dxShader->EnableUAView(mImmediate, rb.bindPoint, dxRB->GetUAView(), 0xFFFFFFFFu);
+                    dxShader->EnableUAView(context, rb.bindPoint, dxRB->GetUAView(), 0xFFFFFFFFu);
                 }
                 else
                 {
-                    dxShader->EnableSRView(mImmediate, rb.bindPoint, dxRB->GetSRView());
+                    dxShader->EnableSRView(context, rb.bindPoint, dxRB->GetSRView());
                 }
             }
             else
@@ -1070,23 +1260,23 @@ void DX11Engine::EnableRBuffers(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableRBuffers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::DisableRBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = RawBuffer::shaderDataLookup;
     for (auto const& rb : shader->GetData(index))
     {
         if (rb.isGpuWritable)
         {
-            dxShader->DisableUAView(mImmediate, rb.bindPoint);
+            dxShader->DisableUAView(context, rb.bindPoint);
         }
         else
         {
-            dxShader->DisableSRView(mImmediate, rb.bindPoint);
+            dxShader->DisableSRView(context, rb.bindPoint);
         }
     }
 }
 
-void DX11Engine::EnableTextures(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableTextures(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = TextureSingle::shaderDataLookup;
     for (auto const& tx : shader->GetData(index))
@@ -1098,11 +1288,11 @@ void DX11Engine::EnableTextures(Shader const* shader, DX11Shader* dxShader)
             {
                 if (tx.isGpuWritable)
                 {
-                    dxShader->EnableUAView(mImmediate, tx.bindPoint, dxTX->GetUAView(), 0xFFFFFFFFu);
+                    dxShader->EnableUAView(context, tx.bindPoint, dxTX->GetUAView(), 0xFFFFFFFFu);
                 }
                 else
                 {
-                    dxShader->EnableSRView(mImmediate, tx.bindPoint, dxTX->GetSRView());
+                    dxShader->EnableSRView(context, tx.bindPoint, dxTX->GetSRView());
                 }
             }
             else
@@ -1117,23 +1307,23 @@ void DX11Engine::EnableTextures(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableTextures(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::DisableTextures(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = TextureSingle::shaderDataLookup;
     for (auto const& tx : shader->GetData(index))
     {
         if (tx.isGpuWritable)
         {
-            dxShader->DisableUAView(mImmediate, tx.bindPoint);
+            dxShader->DisableUAView(context, tx.bindPoint);
         }
         else
         {
-            dxShader->DisableSRView(mImmediate, tx.bindPoint);
+            dxShader->DisableSRView(context, tx.bindPoint);
         }
     }
 }
 
-void DX11Engine::EnableTextureArrays(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableTextureArrays(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = TextureArray::shaderDataLookup;
     for (auto const& ta : shader->GetData(index))
@@ -1145,11 +1335,11 @@ void DX11Engine::EnableTextureArrays(Shader const* shader, DX11Shader* dxShader)
             {
                 if (ta.isGpuWritable)
                 {
-                    dxShader->EnableUAView(mImmediate, ta.bindPoint, dxTA->GetUAView(), 0xFFFFFFFFu);
+                    dxShader->EnableUAView(context, ta.bindPoint, dxTA->GetUAView(), 0xFFFFFFFFu);
                 }
                 else
                 {
-                    dxShader->EnableSRView(mImmediate, ta.bindPoint, dxTA->GetSRView());
+                    dxShader->EnableSRView(context, ta.bindPoint, dxTA->GetSRView());
                 }
             }
             else
@@ -1164,7 +1354,7 @@ void DX11Engine::EnableTextureArrays(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableTextureArrays(Shader const* shader,
+void DX11Engine::DisableTextureArrays(ID3D11DeviceContext* context, Shader const* shader,
     DX11Shader* dxShader)
 {
     int const index = TextureArray::shaderDataLookup;
@@ -1172,16 +1362,16 @@ void DX11Engine::DisableTextureArrays(Shader const* shader,
     {
         if (ta.isGpuWritable)
         {
-            dxShader->DisableUAView(mImmediate, ta.bindPoint);
+            dxShader->DisableUAView(context, ta.bindPoint);
         }
         else
         {
-            dxShader->DisableSRView(mImmediate, ta.bindPoint);
+            dxShader->DisableSRView(context, ta.bindPoint);
         }
     }
 }
 
-void DX11Engine::EnableSamplers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::EnableSamplers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = SamplerState::shaderDataLookup;
     for (auto const& ss : shader->GetData(index))
@@ -1191,7 +1381,7 @@ void DX11Engine::EnableSamplers(Shader const* shader, DX11Shader* dxShader)
             DX11SamplerState* dxSS = static_cast<DX11SamplerState*>(Bind(ss.object));
             if (dxSS)
             {
-                dxShader->EnableSampler(mImmediate, ss.bindPoint, dxSS->GetDXSamplerState());
+                dxShader->EnableSampler(context, ss.bindPoint, dxSS->GetDXSamplerState());
             }
             else
             {
@@ -1205,12 +1395,12 @@ void DX11Engine::EnableSamplers(Shader const* shader, DX11Shader* dxShader)
     }
 }
 
-void DX11Engine::DisableSamplers(Shader const* shader, DX11Shader* dxShader)
+void DX11Engine::DisableSamplers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader)
 {
     int const index = SamplerState::shaderDataLookup;
     for (auto const& ss : shader->GetData(index))
     {
-        dxShader->DisableSampler(mImmediate, ss.bindPoint);
+        dxShader->DisableSampler(context, ss.bindPoint);
     }
 }
 
@@ -1367,6 +1557,7 @@ void DX11Engine::DisplayColorBuffer(unsigned int syncInterval)
 {
     // The swap must occur on the thread in which the device was created.
     mSwapChain->Present(syncInterval, 0);
+    EndFrameStatistics();
 }
 
 void DX11Engine::SetBlendState(std::shared_ptr<BlendState> const& state)
@@ -1441,6 +1632,192 @@ void DX11Engine::SetRasterizerState(std::shared_ptr<RasterizerState> const& stat
     }
 }
 
+unsigned int DX11Engine::CreateOcclusionQuery()
+{
+    // The counting query reports the number of samples and the predicate
+    // is used for conditional drawing.
+    D3D11_QUERY_DESC desc;
+    desc.Query = D3D11_QUERY_OCCLUSION;
+    desc.MiscFlags = D3D11_QUERY_MISC_NONE;
+    ID3D11Query* occlusionQuery = nullptr;
+    DX11Log(mDevice->CreateQuery(&desc, &occlusionQuery));
+
+    desc.Query = D3D11_QUERY_OCCLUSION_PREDICATE;
+    desc.MiscFlags = D3D11_QUERY_MISC_PREDICATEHINT;
+    ID3D11Predicate* predicate = nullptr;
+    HRESULT hr = mDevice->CreatePredicate(&desc, &predicate);
+    if (FAILED(hr))
+    {
+        DX11::SafeRelease(occlusionQuery);
+        DX11Log(hr);
+    }
+
+    // Reuse the slot of a destroyed query.
+    size_t i = 0;
+    for (; i < mQueries.size(); ++i)
+    {
+        if (!mQueries[i].first)
+        {
+            break;
+        }
+    }
+    if (i == mQueries.size())
+    {
+        mQueries.push_back(std::make_pair(nullptr, nullptr));
+    }
+    mQueries[i] = std::make_pair(occlusionQuery, predicate);
+    return static_cast<unsigned int>(i + 1);
+}
+
+void DX11Engine::DestroyOcclusionQuery(unsigned int query)
+{
+    LogAssert(0 < query && query <= mQueries.size(), "Invalid query.");
+    DX11::SafeRelease(mQueries[query - 1].first);
+    DX11::SafeRelease(mQueries[query - 1].second);
+}
+
+void DX11Engine::BeginQuery(unsigned int query)
+{
+    LogAssert(0 < query && query <= mQueries.size(), "Invalid query.");
+    mImmediate->Begin(mQueries[query - 1].first);
+    mImmediate->Begin(mQueries[query - 1].second);
+}
+
+void DX11Engine::EndQuery(unsigned int query)
+{
+    LogAssert(0 < query && query <= mQueries.size(), "Invalid query.");
+    mImmediate->End(mQueries[query - 1].first);
+    mImmediate->End(mQueries[query - 1].second);
+}
+
+bool DX11Engine::GetQueryResult(unsigned int query, uint64_t& numSamples)
+{
+    LogAssert(0 < query && query <= mQueries.size(), "Invalid query.");
+    UINT64 data = 0;
+    HRESULT hr = mImmediate->GetData(mQueries[query - 1].first, &data,
+        sizeof(UINT64), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+    if (hr == S_OK)
+    {
+        numSamples = data;
+        return true;
+    }
+    return false;
+}
+
+void DX11Engine::BeginConditionalDraw(unsigned int query)
+{
+    LogAssert(0 < query && query <= mQueries.size(), "Invalid query.");
+
+    // The draws are discarded when the predicate is FALSE, that is, when
+    // no samples passed.
+    mImmediate->SetPredication(mQueries[query - 1].second, FALSE);
+}
+
+void DX11Engine::EndConditionalDraw()
+{
+    mImmediate->SetPredication(nullptr, FALSE);
+}
+
+unsigned int DX11Engine::CreateTimestampSet(unsigned int numTimestamps)
+{
+    LogAssert(numTimestamps > 0, "Invalid number of timestamps.");
+
+    size_t i = 0;
+    for (; i < mTimestampSets.size(); ++i)
+    {
+        if (!mTimestampSets[i].disjoint)
+        {
+            break;
+        }
+    }
+    if (i == mTimestampSets.size())
+    {
+        mTimestampSets.push_back({ nullptr, {} });
+    }
+
+    TimestampSet& timestampSet = mTimestampSets[i];
+    D3D11_QUERY_DESC desc;
+    desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    desc.MiscFlags = D3D11_QUERY_MISC_NONE;
+    DX11Log(mDevice->CreateQuery(&desc, &timestampSet.disjoint));
+
+    desc.Query = D3D11_QUERY_TIMESTAMP;
+    timestampSet.timestamps.resize(numTimestamps);
+    for (auto& timestamp : timestampSet.timestamps)
+    {
+        DX11Log(mDevice->CreateQuery(&desc, &timestamp));
+    }
+    return static_cast<unsigned int>(i + 1);
+}
+
+void DX11Engine::DestroyTimestampSet(unsigned int set)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    TimestampSet& timestampSet = mTimestampSets[set - 1];
+    DX11::SafeRelease(timestampSet.disjoint);
+    for (auto& timestamp : timestampSet.timestamps)
+    {
+        DX11::SafeRelease(timestamp);
+    }
+    timestampSet.timestamps.clear();
+}
+
+void DX11Engine::BeginTimestamps(unsigned int set)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    mImmediate->Begin(mTimestampSets[set - 1].disjoint);
+}
+
+void DX11Engine::WriteTimestamp(unsigned int set, unsigned int i)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    mImmediate->End(mTimestampSets[set - 1].timestamps[i]);
+}
+
+void DX11Engine::EndTimestamps(unsigned int set)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    mImmediate->End(mTimestampSets[set - 1].disjoint);
+}
+
+bool DX11Engine::GetTimestamps(unsigned int set, unsigned int numWritten,
+    std::vector<uint64_t>& nanoseconds)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    TimestampSet const& timestampSet = mTimestampSets[set - 1];
+    LogAssert(numWritten <= timestampSet.timestamps.size(), "Invalid number of timestamps.");
+
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+    if (S_OK != mImmediate->GetData(timestampSet.disjoint, &disjoint,
+        sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH))
+    {
+        return false;
+    }
+
+    std::vector<UINT64> ticks(numWritten);
+    for (unsigned int i = 0; i < numWritten; ++i)
+    {
+        if (S_OK != mImmediate->GetData(timestampSet.timestamps[i], &ticks[i],
+            sizeof(UINT64), D3D11_ASYNC_GETDATA_DONOTFLUSH))
+        {
+            return false;
+        }
+    }
+
+    nanoseconds.clear();
+    if (!disjoint.Disjoint && disjoint.Frequency > 0)
+    {
+        double const nanosecondsPerTick = 1.0e9 / static_cast<double>(disjoint.Frequency);
+        nanoseconds.resize(numWritten);
+        for (unsigned int i = 0; i < numWritten; ++i)
+        {
+            nanoseconds[i] = static_cast<uint64_t>(
+                static_cast<double>(ticks[i] - ticks[0]) * nanosecondsPerTick);
+        }
+    }
+    return true;
+}
+
 void DX11Engine::Enable(std::shared_ptr<DrawTarget> const& target)
 {
     DX11DrawTarget* dxTarget = static_cast<DX11DrawTarget*>(Bind(target));
@@ -1504,6 +1881,7 @@ bool DX11Engine::Update(std::shared_ptr<Buffer> const& buffer)
     }
 
     DX11Buffer* dxBuffer = static_cast<DX11Buffer*>(Bind(buffer));
+    mStatistics.numBytesUploaded += GetNumUpdateBytes(buffer.get());
     return dxBuffer->Update(mImmediate);
 }
 
@@ -1516,6 +1894,7 @@ bool DX11Engine::Update(std::shared_ptr<TextureSingle> const& texture)
     }
 
     DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    mStatistics.numBytesUploaded += texture->GetNumBytes();
     return dxTexture->Update(mImmediate);
 }
 
@@ -1529,6 +1908,7 @@ bool DX11Engine::Update(std::shared_ptr<TextureSingle> const& texture, unsigned
 
     DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
     unsigned int sri = texture->GetIndex(0, level);
+    mStatistics.numBytesUploaded += texture->GetNumBytesFor(level);
     return dxTexture->Update(mImmediate, sri);
 }
 
@@ -1542,6 +1922,7 @@ bool DX11Engine::Update(std::shared_ptr<TextureArray> const& textureArray)
 
     DX11TextureArray* dxTextureArray = static_cast<DX11TextureArray*>(
         Bind(textureArray));
+    mStatistics.numBytesUploaded += textureArray->GetNumBytes();
     return dxTextureArray->Update(mImmediate);
 }
 
@@ -1556,6 +1937,7 @@ bool DX11Engine::Update(std::shared_ptr<TextureArray> const& textureArray, unsig
     DX11TextureArray* dxTextureArray = static_cast<DX11TextureArray*>(
         Bind(textureArray));
     unsigned int sri = textureArray->GetIndex(item, level);
+    mStatistics.numBytesUploaded += textureArray->GetNumBytesFor(level);
     return dxTextureArray->Update(mImmediate, sri);
 }
 
@@ -1568,6 +1950,7 @@ bool DX11Engine::CopyCpuToGpu(std::shared_ptr<Buffer> const& buffer)
     }
 
     DX11Buffer* dxBuffer = static_cast<DX11Buffer*>(Bind(buffer));
+    mStatistics.numBytesUploaded += buffer->GetNumActiveBytes();
     return dxBuffer->CopyCpuToGpu(mImmediate);
 }
 
@@ -1580,6 +1963,7 @@ bool DX11Engine::CopyCpuToGpu(std::shared_ptr<TextureSingle> const& texture)
     }
 
     DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    mStatistics.numBytesUploaded += texture->GetNumBytes();
     return dxTexture->CopyCpuToGpu(mImmediate);
 }
 
@@ -1593,6 +1977,7 @@ bool DX11Engine::CopyCpuToGpu(std::shared_ptr<TextureSingle> const& texture, uns
 
     DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
     unsigned int sri = texture->GetIndex(0, level);
+    mStatistics.numBytesUploaded += texture->GetNumBytesFor(level);
     return dxTexture->CopyCpuToGpu(mImmediate, sri);
 }
 
@@ -1606,6 +1991,7 @@ bool DX11Engine::CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray)
 
     DX11TextureArray* dxTextureArray = static_cast<DX11TextureArray*>(
         Bind(textureArray));
+    mStatistics.numBytesUploaded += textureArray->GetNumBytes();
     return dxTextureArray->CopyCpuToGpu(mImmediate);
 }
 
@@ -1620,9 +2006,33 @@ bool DX11Engine::CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray,
     DX11TextureArray* dxTextureArray = static_cast<DX11TextureArray*>(
         Bind(textureArray));
     unsigned int sri = textureArray->GetIndex(item, level);
+    mStatistics.numBytesUploaded += textureArray->GetNumBytesFor(level);
     return dxTextureArray->CopyCpuToGpu(mImmediate, sri);
 }
 
+bool DX11Engine::UpdateResidency(std::shared_ptr<TextureSingle> const& texture)
+{
+    // D3D11 (without tiled resources) allocates all the levels, so only the
+    // sampling is restricted to the resident levels by the minimum LOD.
+    DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    ID3D11Resource* dxResource = dxTexture->GetDXResource();
+    unsigned int const level = texture->GetMinResidentLevel();
+    unsigned int const residentLevel = static_cast<unsigned int>(
+        mImmediate->GetResourceMinLOD(dxResource));
+    if (texture->GetData())
+    {
+        for (unsigned int i = level; i < residentLevel; ++i)
+        {
+            unsigned int const sri = texture->GetIndex(0, i);
+            auto sr = texture->GetSubresource(sri);
+            mImmediate->UpdateSubresource(dxResource, sri, nullptr,
+                sr.data, sr.rowPitch, sr.slicePitch);
+        }
+    }
+    mImmediate->SetResourceMinLOD(dxResource, static_cast<float>(level));
+    return true;
+}
+
 bool DX11Engine::CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer)
 {
     if (!buffer->GetData())
@@ -1632,6 +2042,7 @@ bool DX11Engine::CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer)
     }
 
     DX11Buffer* dxBuffer = static_cast<DX11Buffer*>(Bind(buffer));
+    mStatistics.numBytesReadBack += buffer->GetNumActiveBytes();
     return dxBuffer->CopyGpuToCpu(mImmediate);
 }
 
@@ -1644,6 +2055,7 @@ bool DX11Engine::CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture)
     }
 
     DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    mStatistics.numBytesReadBack += texture->GetNumBytes();
     return dxTexture->CopyGpuToCpu(mImmediate);
 }
 
@@ -1657,9 +2069,50 @@ bool DX11Engine::CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture, uns
 
     DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
     unsigned int sri = texture->GetIndex(0, level);
+    mStatistics.numBytesReadBack += texture->GetNumBytesFor(level);
     return dxTexture->CopyGpuToCpu(mImmediate, sri);
 }
 
+bool DX11Engine::StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture)
+{
+    DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    return dxTexture->StageGpuToCpu(mImmediate);
+}
+
+bool DX11Engine::StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level)
+{
+    DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    unsigned int sri = texture->GetIndex(0, level);
+    return dxTexture->StageGpuToCpu(mImmediate, sri);
+}
+
+bool DX11Engine::CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture)
+{
+    if (!texture->GetData())
+    {
+        LogWarning("Texture does not have system memory, creating it.");
+        texture->CreateStorage();
+    }
+
+    DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    mStatistics.numBytesReadBack += texture->GetNumBytes();
+    return dxTexture->CopyStagingToCpu(mImmediate);
+}
+
+bool DX11Engine::CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level)
+{
+    if (!texture->GetData())
+    {
+        LogWarning("Texture does not have system memory, creating it.");
+        texture->CreateStorage();
+    }
+
+    DX11Texture* dxTexture = static_cast<DX11Texture*>(Bind(texture));
+    unsigned int sri = texture->GetIndex(0, level);
+    mStatistics.numBytesReadBack += texture->GetNumBytesFor(level);
+    return dxTexture->CopyStagingToCpu(mImmediate, sri);
+}
+
 bool DX11Engine::CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray)
 {
     if (!textureArray->GetData())
@@ -1670,6 +2123,7 @@ bool DX11Engine::CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray)
 
     DX11TextureArray* dxTextureArray = static_cast<DX11TextureArray*>(
         Bind(textureArray));
+    mStatistics.numBytesReadBack += textureArray->GetNumBytes();
     return dxTextureArray->CopyGpuToCpu(mImmediate);
 }
 
@@ -1684,6 +2138,7 @@ bool DX11Engine::CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray,
     DX11TextureArray* dxTextureArray = static_cast<DX11TextureArray*>(
         Bind(textureArray));
     unsigned int sri = textureArray->GetIndex(item, level);
+    mStatistics.numBytesReadBack += textureArray->GetNumBytesFor(level);
     return dxTextureArray->CopyGpuToCpu(mImmediate, sri);
 }
 
@@ -1772,9 +2227,36 @@ void DX11Engine::Execute(std::shared_ptr<ComputeProgram> const& program,
         if (cshader)
         {
             DX11ComputeShader* dxCShader = static_cast<DX11ComputeShader*>(Bind(cshader));
-            Enable(cshader.get(), dxCShader);
+            Enable(mImmediate, cshader.get(), dxCShader);
             mImmediate->Dispatch(numXGroups, numYGroups, numZGroups);
-            Disable(cshader.get(), dxCShader);
+            ++mStatistics.numProgramBinds;
+            ++mStatistics.numDispatches;
+            Disable(mImmediate, cshader.get(), dxCShader);
+        }
+        else
+        {
+            LogError("Invalid input parameter.");
+        }
+    }
+}
+
+void DX11Engine::Execute(std::shared_ptr<ComputeProgram> const& program,
+    std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset)
+{
+    auto hlslProgram = std::dynamic_pointer_cast<HLSLComputeProgram>(program);
+    if (hlslProgram && arguments)
+    {
+        auto cshader = hlslProgram->GetComputeShader();
+        if (cshader)
+        {
+            DX11ComputeShader* dxCShader = static_cast<DX11ComputeShader*>(Bind(cshader));
+            DX11IndirectArgumentsBuffer* dxArguments =
+                static_cast<DX11IndirectArgumentsBuffer*>(Bind(arguments));
+            Enable(mImmediate, cshader.get(), dxCShader);
+            mImmediate->DispatchIndirect(dxArguments->GetDXBuffer(), offset);
+            ++mStatistics.numProgramBinds;
+            ++mStatistics.numDispatches;
+            Disable(mImmediate, cshader.get(), dxCShader);
         }
         else
         {
@@ -1846,27 +2328,101 @@ void DX11Engine::CopyBackBuffer(std::shared_ptr<Texture2>& texture)
 
 uint64_t DX11Engine::DrawPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
     std::shared_ptr<IndexBuffer> const& ibuffer, std::shared_ptr<VisualEffect> const& effect)
+{
+    if (mInDrawBatch)
+    {
+        return DrawBatchPrimitive(vbuffer, ibuffer, effect);
+    }
+    return DrawPrimitive(mImmediate, vbuffer, ibuffer, effect);
+}
+
+uint64_t DX11Engine::DrawInstancedPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<VertexBuffer> const& instanceBuffer, std::shared_ptr<IndexBuffer> const& ibuffer,
+    std::shared_ptr<VisualEffect> const& effect)
+{
+    LogAssert(vbuffer->StandardUsage() && instanceBuffer->StandardUsage(),
+        "Instanced drawing requires standard vertex and instance buffers.");
+
+    // The instanced input layout and the instance buffer in slot 1 are not
+    // part of the draw batch state, so the batch state is unbound and the
+    // batch is restarted after the draw.
+    if (mInDrawBatch)
+    {
+        EndDrawBatch();
+        uint64_t numPixelsDrawn = DrawPrimitive(mImmediate, vbuffer, ibuffer, effect, instanceBuffer);
+        BeginDrawBatch();
+        return numPixelsDrawn;
+    }
+    return DrawPrimitive(mImmediate, vbuffer, ibuffer, effect, instanceBuffer);
+}
+
+uint64_t DX11Engine::DrawIndirect(std::shared_ptr<InstancedVisual> const& visual,
+    std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset,
+    unsigned int numDraws)
+{
+    LogAssert(visual != nullptr && arguments != nullptr, "Invalid input.");
+    auto const& vbuffer = visual->GetVertexBuffer();
+    auto const& instanceBuffer = visual->GetInstanceBuffer();
+    auto const& ibuffer = visual->GetIndexBuffer();
+    auto const& effect = visual->GetEffect();
+    if (!vbuffer || !instanceBuffer || !ibuffer || !effect || numDraws == 0)
+    {
+        return 0;
+    }
+
+    LogAssert(vbuffer->StandardUsage() && instanceBuffer->StandardUsage(),
+        "Indirect drawing requires standard vertex and instance buffers.");
+
+    // See the comments in DrawInstancedPrimitive about the draw batch.
+    if (mInDrawBatch)
+    {
+        EndDrawBatch();
+        uint64_t numPixelsDrawn = DrawPrimitive(mImmediate, vbuffer, ibuffer, effect,
+            instanceBuffer, arguments, offset, numDraws);
+        BeginDrawBatch();
+        return numPixelsDrawn;
+    }
+    return DrawPrimitive(mImmediate, vbuffer, ibuffer, effect, instanceBuffer,
+        arguments, offset, numDraws);
+}
+
+uint64_t DX11Engine::DrawPrimitive(ID3D11DeviceContext* context,
+    std::shared_ptr<VertexBuffer> const& vbuffer, std::shared_ptr<IndexBuffer> const& ibuffer,
+    std::shared_ptr<VisualEffect> const& effect, std::shared_ptr<VertexBuffer> const& instanceBuffer,
+    std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset,
+    unsigned int numDraws)
 {
     uint64_t numPixelsDrawn = 0;
     DX11VertexShader* dxVShader;
     DX11GeometryShader* dxGShader;
     DX11PixelShader* dxPShader;
-    if (EnableShaders(effect, dxVShader, dxGShader, dxPShader))
+    if (EnableShaders(context, effect, dxVShader, dxGShader, dxPShader))
     {
-        // Enable the vertex buffer and input layout.
+        // Enable the vertex buffer, instance buffer and input layout.
         DX11VertexBuffer* dxVBuffer = nullptr;
+        DX11VertexBuffer* dxInstances = nullptr;
         DX11InputLayout* dxLayout = nullptr;
         if (vbuffer->StandardUsage())
         {
             dxVBuffer = static_cast<DX11VertexBuffer*>(Bind(vbuffer));
             DX11InputLayoutManager* manager = static_cast<DX11InputLayoutManager*>(mILMap.get());
-            dxLayout = manager->Bind(mDevice, vbuffer.get(), effect->GetVertexShader().get());
-            dxVBuffer->Enable(mImmediate);
-            dxLayout->Enable(mImmediate);
+            dxLayout = manager->Bind(mDevice, vbuffer.get(), effect->GetVertexShader().get(),
+                instanceBuffer.get());
+            dxVBuffer->Enable(context);
+            if (instanceBuffer)
+            {
+                dxInstances = static_cast<DX11VertexBuffer*>(Bind(instanceBuffer));
+                dxInstances->Enable(context, 1);
+            }
+            dxLayout->Enable(context);
+            if (context == mImmediate)
+            {
+                mStatistics.numBufferBinds += (dxInstances ? 2 : 1);
+            }
         }
         else
         {
-            mImmediate->IASetInputLayout(nullptr);
+            context->IASetInputLayout(nullptr);
         }
 
         // Enable the index buffer.
@@ -1874,25 +2430,156 @@ uint64_t DX11Engine::DrawPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
         if (ibuffer->IsIndexed())
         {
             dxIBuffer = static_cast<DX11IndexBuffer*>(Bind(ibuffer));
-            dxIBuffer->Enable(mImmediate);
+            dxIBuffer->Enable(context);
+            if (context == mImmediate)
+            {
+                ++mStatistics.numBufferBinds;
+            }
         }
 
-        numPixelsDrawn = DrawPrimitive(vbuffer.get(), ibuffer.get());
+        if (arguments)
+        {
+            DX11IndirectArgumentsBuffer* dxArguments =
+                static_cast<DX11IndirectArgumentsBuffer*>(Bind(arguments));
+            numPixelsDrawn = DrawPrimitive(context, vbuffer.get(), ibuffer.get(),
+                instanceBuffer.get(), dxArguments->GetDXBuffer(), offset, numDraws);
+        }
+        else
+        {
+            numPixelsDrawn = DrawPrimitive(context, vbuffer.get(), ibuffer.get(),
+                instanceBuffer.get());
+        }
 
-        // Disable the vertex buffer and input layout.
+        // Disable the vertex buffer, instance buffer and input layout.
         if (vbuffer->StandardUsage())
         {
-            dxVBuffer->Disable(mImmediate);
-            dxLayout->Disable(mImmediate);
+            dxVBuffer->Disable(context);
+            if (dxInstances)
+            {
+                dxInstances->Disable(context, 1);
+            }
+            dxLayout->Disable(context);
         }
 
         // Disable the index buffer.
         if (dxIBuffer)
         {
-            dxIBuffer->Disable(mImmediate);
+            dxIBuffer->Disable(context);
         }
 
-        DisableShaders(effect, dxVShader, dxGShader, dxPShader);
+        DisableShaders(context, effect, dxVShader, dxGShader, dxPShader);
     }
     return numPixelsDrawn;
 }
+
+void DX11Engine::BeginDrawBatch()
+{
+    mInDrawBatch = true;
+    mBatchInputIsSet = false;
+    mBatchEffect = nullptr;
+    mBatchVShader = nullptr;
+    mBatchGShader = nullptr;
+    mBatchPShader = nullptr;
+    mBatchVBuffer = nullptr;
+    mBatchLayout = nullptr;
+    mBatchIBuffer = nullptr;
+}
+
+void DX11Engine::EndDrawBatch()
+{
+    if (mBatchVBuffer)
+    {
+        mBatchVBuffer->Disable(mImmediate);
+    }
+
+    if (mBatchLayout)
+    {
+        mBatchLayout->Disable(mImmediate);
+    }
+
+    if (mBatchIBuffer)
+    {
+        mBatchIBuffer->Disable(mImmediate);
+    }
+
+    if (mBatchEffect)
+    {
+        DisableShaders(mImmediate, mBatchEffect, mBatchVShader, mBatchGShader, mBatchPShader);
+    }
+
+    mInDrawBatch = false;
+    mBatchInputIsSet = false;
+    mBatchEffect = nullptr;
+    mBatchVShader = nullptr;
+    mBatchGShader = nullptr;
+    mBatchPShader = nullptr;
+    mBatchVBuffer = nullptr;
+    mBatchLayout = nullptr;
+    mBatchIBuffer = nullptr;
+}
+
+uint64_t DX11Engine::DrawBatchPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<IndexBuffer> const& ibuffer, std::shared_ptr<VisualEffect> const& effect)
+{
+    // Enable the shaders and their resources when they differ from those
+    // of the previous draw.
+    if (effect != mBatchEffect)
+    {
+        if (mBatchEffect)
+        {
+            DisableShaders(mImmediate, mBatchEffect, mBatchVShader, mBatchGShader, mBatchPShader);
+            mBatchEffect = nullptr;
+        }
+
+        if (!EnableShaders(mImmediate, effect, mBatchVShader, mBatchGShader, mBatchPShader))
+        {
+            return 0;
+        }
+        mBatchEffect = effect;
+    }
+
+    // Enable the vertex buffer and input layout.
+    DX11VertexBuffer* dxVBuffer = nullptr;
+    DX11InputLayout* dxLayout = nullptr;
+    if (vbuffer->StandardUsage())
+    {
+        dxVBuffer = static_cast<DX11VertexBuffer*>(Bind(vbuffer));
+        DX11InputLayoutManager* manager = static_cast<DX11InputLayoutManager*>(mILMap.get());
+        dxLayout = manager->Bind(mDevice, vbuffer.get(), effect->GetVertexShader().get());
+    }
+
+    if (!mBatchInputIsSet || dxVBuffer != mBatchVBuffer || dxLayout != mBatchLayout)
+    {
+        if (dxVBuffer)
+        {
+            dxVBuffer->Enable(mImmediate);
+            dxLayout->Enable(mImmediate);
+            ++mStatistics.numBufferBinds;
+        }
+        else
+        {
+            if (mBatchVBuffer)
+            {
+                mBatchVBuffer->Disable(mImmediate);
+            }
+            mImmediate->IASetInputLayout(nullptr);
+        }
+        mBatchVBuffer = dxVBuffer;
+        mBatchLayout = dxLayout;
+        mBatchInputIsSet = true;
+    }
+
+    // Enable the index buffer.
+    if (ibuffer->IsIndexed())
+    {
+        DX11IndexBuffer* dxIBuffer = static_cast<DX11IndexBuffer*>(Bind(ibuffer));
+        if (dxIBuffer != mBatchIBuffer)
+        {
+            dxIBuffer->Enable(mImmediate);
+            mBatchIBuffer = dxIBuffer;
+            ++mStatistics.numBufferBinds;
+        }
+    }
+
+    return DrawPrimitive(mImmediate, vbuffer.get(), ibuffer.get());
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.04.12
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -14,12 +14,16 @@
 
 namespace gte
 {
+    class DX11DeferredContext;
     class DX11DrawTarget;
     class DX11GeometryShader;
     class DX11GraphicsObject;
+    class DX11IndexBuffer;
+    class DX11InputLayout;
     class DX11PixelShader;
     class DX11Shader;
     class DX11Texture2;
+    class DX11VertexBuffer;
     class DX11VertexShader;
 
     class DX11Engine : public GraphicsEngine
@@ -118,7 +122,23 @@ namespace gte
         void BeginTimer(DX11PerformanceCounter& counter);
         void EndTimer(DX11PerformanceCounter& counter);
 
+        // Support for recording draws and compute dispatches on multiple
+        // threads.  Each thread records into its own deferred context, and
+        // the command lists are executed by the immediate context in the
+        // order of the input array.  The engine maps that create the
+        // graphics objects are not designed for concurrent creation, so
+        // BindForRecording must be called (in the thread of the immediate
+        // context) for the visuals before they are drawn by deferred
+        // contexts; it binds the buffers, shaders, shader resources and
+        // input layouts of the visuals.  ExecuteCommandLists restores the
+        // state of the immediate context after each command list.
+        std::shared_ptr<DX11DeferredContext> CreateDeferredContext();
+        void BindForRecording(std::vector<Visual*> const& visuals);
+        void ExecuteCommandLists(std::vector<std::shared_ptr<DX11DeferredContext>> const& contexts);
+
     private:
+        friend class DX11DeferredContext;
+
         // Helpers for construction and destruction.
         void Initialize(IDXGIAdapter* adapter, D3D_DRIVER_TYPE driverType,
             HMODULE softwareModule, UINT flags, bool useDepth24Stencil8);
@@ -132,30 +152,55 @@ namespace gte
         bool DestroySwapChain();
         bool DestroyBackBuffer();
 
-        // Support for drawing.
-        uint64_t DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer const* ibuffer);
+        // Support for drawing.  The draws are recorded in the immediate
+        // context or in a deferred context (see DX11DeferredContext).
+        // Occlusion queries are issued only for the immediate context.
+        // The primitive is drawn once for each active element of the
+        // instance buffer when it is not null.  When numDraws is positive,
+        // the draw arguments are instead read from numDraws records of the
+        // indirect arguments buffer starting at byte 'offset'.
+        uint64_t DrawPrimitive(ID3D11DeviceContext* context, VertexBuffer const* vbuffer,
+            IndexBuffer const* ibuffer, VertexBuffer const* instanceBuffer = nullptr,
+            ID3D11Buffer* arguments = nullptr, UINT offset = 0, UINT numDraws = 0);
+        uint64_t DrawPrimitive(ID3D11DeviceContext* context,
+            std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect,
+            std::shared_ptr<VertexBuffer> const& instanceBuffer = nullptr,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments = nullptr,
+            unsigned int offset = 0, unsigned int numDraws = 0);
         ID3D11Query* BeginOcclusionQuery();
         uint64_t EndOcclusionQuery(ID3D11Query* occlusionQuery);
 
+        // Support for the draw batches of GraphicsEngine.  The shaders and
+        // their resources, the vertex buffer, input layout and index buffer
+        // of the last draw remain bound and are bound again only when a draw
+        // uses different ones.
+        virtual void BeginDrawBatch() override;
+        virtual void EndDrawBatch() override;
+        uint64_t DrawBatchPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect);
+
         // Support for enabling and disabling resources used by shaders.
-        bool EnableShaders(std::shared_ptr<VisualEffect> const& effect, DX11VertexShader*& dxVShader, DX11GeometryShader*& dxGShader, DX11PixelShader*& dxPShader);
-        void DisableShaders(std::shared_ptr<VisualEffect> const& effect, DX11VertexShader* dxVShader, DX11GeometryShader* dxGShader, DX11PixelShader* dxPShader);
-        void Enable(Shader const* shader, DX11Shader* dxShader);
-        void Disable(Shader const* shader, DX11Shader* dxShader);
-        void EnableCBuffers(Shader const* shader, DX11Shader* dxShader);
-        void DisableCBuffers(Shader const* shader, DX11Shader* dxShader);
-        void EnableTBuffers(Shader const* shader, DX11Shader* dxShader);
-        void DisableTBuffers(Shader const* shader, DX11Shader* dxShader);
-        void EnableSBuffers(Shader const* shader, DX11Shader* dxShader);
-        void DisableSBuffers(Shader const* shader, DX11Shader* dxShader);
-        void EnableRBuffers(Shader const* shader, DX11Shader* dxShader);
-        void DisableRBuffers(Shader const* shader, DX11Shader* dxShader);
-        void EnableTextures(Shader const* shader, DX11Shader* dxShader);
-        void DisableTextures(Shader const* shader, DX11Shader* dxShader);
-        void EnableTextureArrays(Shader const* shader, DX11Shader* dxShader);
-        void DisableTextureArrays(Shader const* shader, DX11Shader* dxShader);
-        void EnableSamplers(Shader const* shader, DX11Shader* dxShader);
-        void DisableSamplers(Shader const* shader, DX11Shader* dxShader);
+        bool EnableShaders(ID3D11DeviceContext* context, std::shared_ptr<VisualEffect> const& effect, DX11VertexShader*& dxVShader, DX11GeometryShader*& dxGShader, DX11PixelShader*& dxPShader);
+        void DisableShaders(ID3D11DeviceContext* context, std::shared_ptr<VisualEffect> const& effect, DX11VertexShader* dxVShader, DX11GeometryShader* dxGShader, DX11PixelShader* dxPShader);
+        void Enable(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void Disable(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableCBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableCBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableTBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableTBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableSBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableSBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableRBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableRBuffers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableTextures(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableTextures(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableTextureArrays(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableTextureArrays(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void EnableSamplers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
+        void DisableSamplers(ID3D11DeviceContext* context, Shader const* shader, DX11Shader* dxShader);
 
         // Inputs to the constructors.  If mUseDepth24Stencil8 is 'true', the
         // back buffer has a 24-bit depth and 8-bit stencil buffer.  If the
@@ -197,6 +242,34 @@ namespace gte
         // WaitForFinish is called).
         ID3D11Query* mWaitQuery;
 
+        // The asynchronous occlusion queries. The handle of a query is its
+        // index plus 1. A predicate reports only whether samples passed, so
+        // each query has a counting query and a predicate that are issued
+        // together. The slots of destroyed queries are null and reused.
+        std::vector<std::pair<ID3D11Query*, ID3D11Predicate*>> mQueries;
+
+        // The timestamp sets. The handle of a set is its index plus 1. The
+        // disjoint query brackets the timestamps and reports the frequency of
+        // their ticks. The slots of destroyed sets are empty and reused.
+        struct TimestampSet
+        {
+            ID3D11Query* disjoint;
+            std::vector<ID3D11Query*> timestamps;
+        };
+
+        std::vector<TimestampSet> mTimestampSets;
+
+        // The state bound by the last draw of a draw batch.
+        bool mInDrawBatch;
+        bool mBatchInputIsSet;
+        std::shared_ptr<VisualEffect> mBatchEffect;
+        DX11VertexShader* mBatchVShader;
+        DX11GeometryShader* mBatchGShader;
+        DX11PixelShader* mBatchPShader;
+        DX11VertexBuffer* mBatchVBuffer;
+        DX11InputLayout* mBatchLayout;
+        DX11IndexBuffer* mBatchIBuffer;
+
         // Keep track of whether the window is fullscreen or normal mode.  As
         // recommended by MSDN documentation, we do not use
         // swapChainDesc.Windowed to control this; rather, we create a
@@ -252,6 +325,25 @@ namespace gte
         virtual void SetDepthStencilState(std::shared_ptr<DepthStencilState> const& state) override;
         virtual void SetRasterizerState(std::shared_ptr<RasterizerState> const& state) override;
 
+        // Support for asynchronous occlusion queries and conditional
+        // drawing.
+        virtual unsigned int CreateOcclusionQuery() override;
+        virtual void DestroyOcclusionQuery(unsigned int query) override;
+        virtual void BeginQuery(unsigned int query) override;
+        virtual void EndQuery(unsigned int query) override;
+        virtual bool GetQueryResult(unsigned int query, uint64_t& numSamples) override;
+        virtual void BeginConditionalDraw(unsigned int query) override;
+        virtual void EndConditionalDraw() override;
+
+        // Support for GPU timing with timestamp queries.
+        virtual unsigned int CreateTimestampSet(unsigned int numTimestamps) override;
+        virtual void DestroyTimestampSet(unsigned int set) override;
+        virtual void BeginTimestamps(unsigned int set) override;
+        virtual void WriteTimestamp(unsigned int set, unsigned int i) override;
+        virtual void EndTimestamps(unsigned int set) override;
+        virtual bool GetTimestamps(unsigned int set, unsigned int numWritten,
+            std::vector<uint64_t>& nanoseconds) override;
+
         // Support for drawing to offscreen memory (i.e. not to the back
         // buffer).  The DrawTarget object encapsulates render targets (color
         // information) and depth-stencil target.
@@ -276,6 +368,9 @@ namespace gte
         virtual bool CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray) override;
         virtual bool CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray, unsigned int item, unsigned int level) override;
 
+        // Support for mipmap streaming.
+        virtual bool UpdateResidency(std::shared_ptr<TextureSingle> const& texture) override;
+
         // Support for copying from GPU to CPU via staging memory.
         virtual bool CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer) override;
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture) override;
@@ -283,6 +378,12 @@ namespace gte
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray) override;
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray, unsigned int item, unsigned int level) override;
 
+        // Support for copying from GPU to CPU in two steps.
+        virtual bool StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture) override;
+        virtual bool StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level) override;
+        virtual bool CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture) override;
+        virtual bool CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level) override;
+
         // Support for copying from GPU to GPU directly.  TODO: We will
         // improve on the feature set for such copies later.  For now, the
         // restrictions are that the resources are different, of the same
@@ -305,6 +406,14 @@ namespace gte
         // stall the CPU before obtaining the GPU results.
         virtual bool BindProgram(std::shared_ptr<ComputeProgram> const& program) override;
         virtual void Execute(std::shared_ptr<ComputeProgram> const& program, unsigned int numXGroups, unsigned int numYGroups, unsigned int numZGroups) override;
+        virtual void Execute(std::shared_ptr<ComputeProgram> const& program, std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset) override;
+
+        // Draw with arguments read from the indirect arguments buffer.
+        // DirectX 11 has no multidraw, so each record is drawn by its own
+        // DrawIndexedInstancedIndirect or DrawInstancedIndirect call.
+        virtual uint64_t DrawIndirect(std::shared_ptr<InstancedVisual> const& visual,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments,
+            unsigned int offset, unsigned int numDraws) override;
 
         // Have the CPU wait until the GPU finishes its current command
         // buffer.
@@ -323,6 +432,12 @@ namespace gte
             std::shared_ptr<IndexBuffer> const& ibuffer,
             std::shared_ptr<VisualEffect> const& effect) override;
 
+        virtual uint64_t DrawInstancedPrimitive(
+            std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<VertexBuffer> const& instanceBuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect) override;
+
     public:
         // If the input texture does not match the back-buffer format and
         // dimensions, it will be recreated.
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11InputLayout.h>
@@ -23,25 +23,28 @@ DX11InputLayout::DX11InputLayout(ID3D11Device* device,
     LogAssert(vbuffer != nullptr && vshader != nullptr, "Invalid inputs.");
 
     std::memset(&mElements[0], 0, VA_MAX_ATTRIBUTES*sizeof(mElements[0]));
+    AddElements(vbuffer, 0);
 
-    VertexFormat const& format = vbuffer->GetFormat();
-    mNumElements = format.GetNumAttributes();
-    for (int i = 0; i < mNumElements; ++i)
-    {
-        VASemantic semantic;
-        DFType type;
-        unsigned int unit, offset;
-        format.GetAttribute(i, semantic, type, unit, offset);
+    auto const& compiledCode = vshader->GetCompiledCode();
+    DX11Log(device->CreateInputLayout(mElements, (UINT)mNumElements,
+        &compiledCode[0], compiledCode.size(), &mLayout));
+}
 
-        D3D11_INPUT_ELEMENT_DESC& element = mElements[i];
-        element.SemanticName = msSemantic[semantic];
-        element.SemanticIndex = unit;
-        element.Format = static_cast<DXGI_FORMAT>(type);
-        element.InputSlot = 0;  // TODO: Streams not yet supported.
-        element.AlignedByteOffset = offset;
-        element.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-        element.InstanceDataStepRate = 0;
-    }
+DX11InputLayout::DX11InputLayout(ID3D11Device* device, VertexBuffer const* vbuffer,
+    VertexBuffer const* instanceBuffer, Shader const* vshader)
+    :
+    mLayout(nullptr),
+    mNumElements(0)
+{
+    LogAssert(vbuffer != nullptr && instanceBuffer != nullptr && vshader != nullptr,
+        "Invalid inputs.");
+    LogAssert(vbuffer->GetFormat().GetNumAttributes() +
+        instanceBuffer->GetFormat().GetNumAttributes() <= VA_MAX_ATTRIBUTES,
+        "Too many vertex and instance attributes.");
+
+    std::memset(&mElements[0], 0, VA_MAX_ATTRIBUTES*sizeof(mElements[0]));
+    AddElements(vbuffer, 0);
+    AddElements(instanceBuffer, 1);
 
     auto const& compiledCode = vshader->GetCompiledCode();
     DX11Log(device->CreateInputLayout(mElements, (UINT)mNumElements,
@@ -71,6 +74,36 @@ HRESULT DX11InputLayout::SetName(std::string const& name)
     return DX11::SetPrivateName(mLayout, mName);
 }
 
+void DX11InputLayout::AddElements(VertexBuffer const* buffer, UINT inputSlot)
+{
+    VertexFormat const& format = buffer->GetFormat();
+    int const numAttributes = format.GetNumAttributes();
+    for (int i = 0; i < numAttributes; ++i)
+    {
+        VASemantic semantic;
+        DFType type;
+        unsigned int unit, offset;
+        format.GetAttribute(i, semantic, type, unit, offset);
+
+        D3D11_INPUT_ELEMENT_DESC& element = mElements[mNumElements++];
+        element.SemanticName = msSemantic[semantic];
+        element.SemanticIndex = unit;
+        element.Format = static_cast<DXGI_FORMAT>(type);
+        element.InputSlot = inputSlot;
+        element.AlignedByteOffset = offset;
+        if (inputSlot == 0)
+        {
+            element.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+            element.InstanceDataStepRate = 0;
+        }
+        else
+        {
+            element.InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+            element.InstanceDataStepRate = 1;
+        }
+    }
+}
+
 
 char const* DX11InputLayout::msSemantic[VA_NUM_SEMANTICS] =
 {
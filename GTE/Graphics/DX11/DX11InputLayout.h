@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -20,6 +20,12 @@ namespace gte
         ~DX11InputLayout();
         DX11InputLayout(ID3D11Device* device, VertexBuffer const* vbuffer, Shader const* vshader);
 
+        // Construction for instanced drawing.  The elements of the instance
+        // buffer follow those of the vertex buffer, are read from input
+        // slot 1 and advance once per instance.
+        DX11InputLayout(ID3D11Device* device, VertexBuffer const* vbuffer,
+            VertexBuffer const* instanceBuffer, Shader const* vshader);
+
         // Support for drawing geometric primitives.
         void Enable(ID3D11DeviceContext* context);
         void Disable(ID3D11DeviceContext* context);
@@ -34,6 +40,9 @@ namespace gte
         }
 
     private:
+        // Append the elements of the buffer to mElements.
+        void AddElements(VertexBuffer const* buffer, UINT inputSlot);
+
         ID3D11InputLayout* mLayout;
         int mNumElements;
         D3D11_INPUT_ELEMENT_DESC mElements[VA_MAX_ATTRIBUTES];
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11InputLayoutManager.h>
@@ -19,17 +19,25 @@ DX11InputLayoutManager::~DX11InputLayoutManager()
 }
 
 DX11InputLayout* DX11InputLayoutManager::Bind(ID3D11Device* device,
-    VertexBuffer const* vbuffer, Shader const* vshader)
+    VertexBuffer const* vbuffer, Shader const* vshader, VertexBuffer const* instanceBuffer)
 {
     LogAssert(vshader != nullptr, "Invalid input.");
 
     std::shared_ptr<DX11InputLayout> layout;
     if (vbuffer)
     {
-        if (!mMap.Get(std::make_pair(vbuffer, vshader), layout))
+        LayoutKey const key(vbuffer, instanceBuffer, vshader);
+        if (!mMap.Get(key, layout))
         {
-            layout = std::make_shared<DX11InputLayout>(device, vbuffer, vshader);
-            mMap.Insert(std::make_pair(vbuffer, vshader), layout);
+            if (instanceBuffer)
+            {
+                layout = std::make_shared<DX11InputLayout>(device, vbuffer, instanceBuffer, vshader);
+            }
+            else
+            {
+                layout = std::make_shared<DX11InputLayout>(device, vbuffer, vshader);
+            }
+            mMap.Insert(key, layout);
 
 #if defined(GTE_GRAPHICS_USE_NAMED_OBJECTS)
             std::string vbname = vbuffer->GetName();
@@ -51,7 +59,7 @@ bool DX11InputLayoutManager::Unbind(VertexBuffer const* vbuffer)
 {
     LogAssert(vbuffer != nullptr, "Invalid input.");
 
-    std::vector<VBSPair> matches;
+    std::vector<LayoutKey> matches;
     mMap.GatherMatch(vbuffer, matches);
     for (auto match : matches)
     {
@@ -65,7 +73,7 @@ bool DX11InputLayoutManager::Unbind(Shader const* vshader)
 {
     LogAssert(vshader != nullptr, "Invalid input.");
 
-    std::vector<VBSPair> matches;
+    std::vector<LayoutKey> matches;
     mMap.GatherMatch(vshader, matches);
     for (auto match : matches)
     {
@@ -86,13 +94,13 @@ bool DX11InputLayoutManager::HasElements() const
 }
 
 void DX11InputLayoutManager::LayoutMap::GatherMatch(
-    VertexBuffer const* vbuffer, std::vector<VBSPair>& matches)
+    VertexBuffer const* vbuffer, std::vector<LayoutKey>& matches)
 {
     this->mMutex.lock();
     {
         for (auto vbs : this->mMap)
         {
-            if (vbuffer == vbs.first.first)
+            if (vbuffer == std::get<0>(vbs.first) || vbuffer == std::get<1>(vbs.first))
             {
                 matches.push_back(vbs.first);
             }
@@ -102,13 +110,13 @@ void DX11InputLayoutManager::LayoutMap::GatherMatch(
 }
 
 void DX11InputLayoutManager::LayoutMap::GatherMatch(Shader const* vshader,
-    std::vector<VBSPair>& matches)
+    std::vector<LayoutKey>& matches)
 {
     this->mMutex.lock();
     {
         for (auto vbs : this->mMap)
         {
-            if (vshader == vbs.first.second)
+            if (vshader == std::get<2>(vbs.first))
             {
                 matches.push_back(vbs.first);
             }
@@ -3,13 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/GEInputLayoutManager.h>
 #include <Graphics/DX11/DX11InputLayout.h>
 #include <Mathematics/ThreadSafeMap.h>
+#include <tuple>
 
 namespace gte
 {
@@ -20,26 +21,28 @@ namespace gte
         virtual ~DX11InputLayoutManager();
         DX11InputLayoutManager() = default;
 
-        // Management functions.  The Unbind(vbuffer) removes all pairs that
-        // involve vbuffer.  The Unbind(vshader) removes all pairs that
-        // involve vshader.
-        DX11InputLayout* Bind(ID3D11Device* device, VertexBuffer const* vbuffer, Shader const* vshader);
+        // Management functions.  The Unbind(vbuffer) removes all layouts that
+        // involve vbuffer, whether as vertex buffer or instance buffer.  The
+        // Unbind(vshader) removes all layouts that involve vshader.  The
+        // instance buffer is null for layouts without instancing.
+        DX11InputLayout* Bind(ID3D11Device* device, VertexBuffer const* vbuffer, Shader const* vshader,
+            VertexBuffer const* instanceBuffer = nullptr);
         virtual bool Unbind(VertexBuffer const* vbuffer) override;
         virtual bool Unbind(Shader const* vshader) override;
         virtual void UnbindAll() override;
         virtual bool HasElements() const override;
 
     private:
-        typedef std::pair<VertexBuffer const*, Shader const*> VBSPair;
+        typedef std::tuple<VertexBuffer const*, VertexBuffer const*, Shader const*> LayoutKey;
 
-        class LayoutMap : public ThreadSafeMap<VBSPair, std::shared_ptr<DX11InputLayout>>
+        class LayoutMap : public ThreadSafeMap<LayoutKey, std::shared_ptr<DX11InputLayout>>
         {
         public:
             virtual ~LayoutMap() = default;
             LayoutMap() = default;
 
-            void GatherMatch(VertexBuffer const* vbuffer, std::vector<VBSPair>& matches);
-            void GatherMatch(Shader const* vshader, std::vector<VBSPair>& matches);
+            void GatherMatch(VertexBuffer const* vbuffer, std::vector<LayoutKey>& matches);
+            void GatherMatch(Shader const* vshader, std::vector<LayoutKey>& matches);
         };
 
         LayoutMap mMap;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11Texture.h>
@@ -43,12 +43,12 @@ bool DX11Texture::Update(ID3D11DeviceContext* context, unsigned int sri)
     }
     else if (numDimensions == 2)
     {
-        CopyPitched2(texture->GetDimensionFor(sr.level, 1), sr.rowPitch,
+        CopyPitched2(texture->GetNumRowsFor(sr.level), sr.rowPitch,
             sr.data, sub.RowPitch, sub.pData);
     }
     else  // numDimensions == 3
     {
-        CopyPitched3(texture->GetDimensionFor(sr.level, 1),
+        CopyPitched3(texture->GetNumRowsFor(sr.level),
             texture->GetDimensionFor(sr.level, 2), sr.rowPitch, sr.slicePitch,
             sr.data, sub.RowPitch, sub.DepthPitch, sub.pData);
     }
@@ -89,12 +89,12 @@ bool DX11Texture::CopyCpuToGpu(ID3D11DeviceContext* context, unsigned int sri)
     }
     else if (numDimensions == 2)
     {
-        CopyPitched2(texture->GetDimensionFor(sr.level, 1), sr.rowPitch,
+        CopyPitched2(texture->GetNumRowsFor(sr.level), sr.rowPitch,
             sr.data, sub.RowPitch, sub.pData);
     }
     else  // numDimensions == 3
     {
-        CopyPitched3(texture->GetDimensionFor(sr.level, 1),
+        CopyPitched3(texture->GetNumRowsFor(sr.level),
             texture->GetDimensionFor(sr.level, 2), sr.rowPitch,
             sr.slicePitch, sr.data, sub.RowPitch, sub.DepthPitch,
             sub.pData);
@@ -128,6 +128,25 @@ bool DX11Texture::CopyCpuToGpu(ID3D11DeviceContext* context)
 }
 
 bool DX11Texture::CopyGpuToCpu(ID3D11DeviceContext* context, unsigned int sri)
+{
+    return StageGpuToCpu(context, sri) && CopyStagingToCpu(context, sri);
+}
+
+bool DX11Texture::CopyGpuToCpu(ID3D11DeviceContext* context)
+{
+    Texture* texture = GetTexture();
+    unsigned int const numSubresources = texture->GetNumSubresources();
+    for (unsigned int index = 0; index < numSubresources; ++index)
+    {
+        if (!CopyGpuToCpu(context, index))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DX11Texture::StageGpuToCpu(ID3D11DeviceContext* context, unsigned int sri)
 {
     Texture* texture = GetTexture();
     LogAssert(sri < texture->GetNumSubresources(), "Subresource index out of range.");
@@ -136,8 +155,30 @@ bool DX11Texture::CopyGpuToCpu(ID3D11DeviceContext* context, unsigned int sri)
     // Copy from GPU memory to staging texture.
     ID3D11Resource* dxTexture = GetDXResource();
     context->CopySubresourceRegion(mStaging, sri, 0, 0, 0, dxTexture, sri, nullptr);
+    return true;
+}
 
-    // Map the staging texture.
+bool DX11Texture::StageGpuToCpu(ID3D11DeviceContext* context)
+{
+    Texture* texture = GetTexture();
+    unsigned int const numSubresources = texture->GetNumSubresources();
+    for (unsigned int index = 0; index < numSubresources; ++index)
+    {
+        if (!StageGpuToCpu(context, index))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DX11Texture::CopyStagingToCpu(ID3D11DeviceContext* context, unsigned int sri)
+{
+    Texture* texture = GetTexture();
+    LogAssert(sri < texture->GetNumSubresources(), "Subresource index out of range.");
+    PreparedForCopy(D3D11_CPU_ACCESS_READ);
+
+    // Map the staging texture. This waits for the staging copy to finish.
     D3D11_MAPPED_SUBRESOURCE sub;
     DX11Log(context->Map(mStaging, sri, D3D11_MAP_READ, 0, &sub));
 
@@ -150,12 +191,12 @@ bool DX11Texture::CopyGpuToCpu(ID3D11DeviceContext* context, unsigned int sri)
     }
     else if (numDimensions == 2)
     {
-        CopyPitched2(texture->GetDimensionFor(sr.level, 1), sub.RowPitch,
+        CopyPitched2(texture->GetNumRowsFor(sr.level), sub.RowPitch,
             sub.pData, sr.rowPitch, sr.data);
     }
     else  // numDimensions == 3
     {
-        CopyPitched3(texture->GetDimensionFor(sr.level, 1),
+        CopyPitched3(texture->GetNumRowsFor(sr.level),
             texture->GetDimensionFor(sr.level, 2), sub.RowPitch,
             sub.DepthPitch, sub.pData, sr.rowPitch, sr.slicePitch, sr.data);
     }
@@ -163,13 +204,13 @@ bool DX11Texture::CopyGpuToCpu(ID3D11DeviceContext* context, unsigned int sri)
     return true;
 }
 
-bool DX11Texture::CopyGpuToCpu(ID3D11DeviceContext* context)
+bool DX11Texture::CopyStagingToCpu(ID3D11DeviceContext* context)
 {
     Texture* texture = GetTexture();
     unsigned int const numSubresources = texture->GetNumSubresources();
     for (unsigned int index = 0; index < numSubresources; ++index)
     {
-        if (!CopyGpuToCpu(context, index))
+        if (!CopyStagingToCpu(context, index))
         {
             return false;
         }
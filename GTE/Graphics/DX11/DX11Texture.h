@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -49,6 +49,14 @@ namespace gte
         virtual void CopyGpuToGpu(ID3D11DeviceContext* context,
             ID3D11Resource* target) override;
 
+        // Copy of data from GPU to CPU in two steps, see the comments in
+        // GraphicsEngine.h. CopyGpuToCpu is StageGpuToCpu followed by
+        // CopyStagingToCpu.
+        bool StageGpuToCpu(ID3D11DeviceContext* context, unsigned int sri);
+        bool StageGpuToCpu(ID3D11DeviceContext* context);
+        bool CopyStagingToCpu(ID3D11DeviceContext* context, unsigned int sri);
+        bool CopyStagingToCpu(ID3D11DeviceContext* context);
+
         // Support for the DX11 debug layer; see comments in the file
         // DX11GraphicsObject.h about usage.
         virtual void SetName(std::string const& name) override;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.04.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11Texture3.h>
@@ -40,6 +40,13 @@ DX11Texture3::DX11Texture3(ID3D11Device* device, Texture3 const* texture)
         desc.CPUAccessFlags = D3D11_CPU_ACCESS_NONE;
     }
 
+    if (texture->IsPartiallyResident() && usage == Resource::IMMUTABLE)
+    {
+        // The levels of a streamed texture are copied when they become
+        // resident, so the texture cannot be immutable.
+        desc.Usage = D3D11_USAGE_DEFAULT;
+    }
+
     if (texture->WantAutogenerateMipmaps())
     {
         desc.Usage = D3D11_USAGE_DEFAULT;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/DX11VertexBuffer.h>
@@ -32,11 +32,12 @@ DX11VertexBuffer::DX11VertexBuffer(ID3D11Device* device, VertexBuffer const* vbu
     }
     else  // usage == Resource::SHADER_OUTPUT
     {
-        LogError("Vertex output streams are not yet tested.");
-        // TODO: Write a sample application to test this case.
-        //desc.Usage = D3D11_USAGE_DEFAULT;
-        //desc.BindFlags |= D3D11_BIND_STREAM_OUTPUT;
-        //desc.CPUAccessFlags = D3D11_CPU_ACCESS_NONE;
+        // The buffer is written by the GPU, for example by CopyGpuToGpu
+        // from a structured buffer (see InstanceCuller).
+        // TODO: Vertex output streams (D3D11_BIND_STREAM_OUTPUT) are not yet
+        // tested. Write a sample application to test this case.
+        desc.Usage = D3D11_USAGE_DEFAULT;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_NONE;
     }
 
     // Create the buffer.
@@ -73,7 +74,7 @@ std::shared_ptr<GEObject> DX11VertexBuffer::Create(void* device, GraphicsObject
     LogError("Invalid object type.");
 }
 
-void DX11VertexBuffer::Enable(ID3D11DeviceContext* context)
+void DX11VertexBuffer::Enable(ID3D11DeviceContext* context, UINT slot)
 {
     if (mDXObject)
     {
@@ -91,17 +92,17 @@ void DX11VertexBuffer::Enable(ID3D11DeviceContext* context)
         VertexBuffer* vbuffer = GetVertexBuffer();
         UINT strides[1] = { vbuffer->GetElementSize() };
         UINT offsets[1] = { 0 };
-        context->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+        context->IASetVertexBuffers(slot, 1, buffers, strides, offsets);
     }
 }
 
-void DX11VertexBuffer::Disable(ID3D11DeviceContext* context)
+void DX11VertexBuffer::Disable(ID3D11DeviceContext* context, UINT slot)
 {
     if (mDXObject)
     {
         ID3D11Buffer* buffers[1] = { nullptr };
         UINT strides[1] = { 0 };
         UINT offsets[1] = { 0 };
-        context->IASetVertexBuffers(0, 1, buffers, strides, offsets);
+        context->IASetVertexBuffers(slot, 1, buffers, strides, offsets);
     }
 }
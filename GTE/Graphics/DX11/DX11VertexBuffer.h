@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -26,8 +26,9 @@ namespace gte
             return static_cast<VertexBuffer*>(mGTObject);
         }
 
-        // Drawing support.
-        void Enable(ID3D11DeviceContext* context);
-        void Disable(ID3D11DeviceContext* context);
+        // Drawing support.  The slot is 0 for vertex buffers and 1 for the
+        // instance buffers of instanced drawing.
+        void Enable(ID3D11DeviceContext* context, UINT slot = 0);
+        void Disable(ID3D11DeviceContext* context, UINT slot = 0);
     };
 }
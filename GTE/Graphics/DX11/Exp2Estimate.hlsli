@@ -0,0 +1,562 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to 2^x for x in [0,1].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/Exp2Estimate.h. Do not edit it.
+
+#ifndef GTE_EXP2ESTIMATE_HLSLI
+#define GTE_EXP2ESTIMATE_HLSLI
+
+#define GTE_C_EXP2_DEG1_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG1_C1 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG1_MAX_ERROR +8.60713320559343131e-02
+#define GTE_C_EXP2_DEG2_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG2_C1 +6.55713326057415280e-01
+#define GTE_C_EXP2_DEG2_C2 +3.44286673942584720e-01
+#define GTE_C_EXP2_DEG2_MAX_ERROR +3.81324768310603579e-03
+#define GTE_C_EXP2_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG3_C1 +6.95890120844562254e-01
+#define GTE_C_EXP2_DEG3_C2 +2.24864949001101877e-01
+#define GTE_C_EXP2_DEG3_C3 +7.92449301543349804e-02
+#define GTE_C_EXP2_DEG3_MAX_ERROR +1.46948777551864085e-04
+#define GTE_C_EXP2_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG4_C1 +6.93003923584591952e-01
+#define GTE_C_EXP2_DEG4_C2 +2.41549817224555596e-01
+#define GTE_C_EXP2_DEG4_C3 +5.17442603314890448e-02
+#define GTE_C_EXP2_DEG4_C4 +1.37019988593678477e-02
+#define GTE_C_EXP2_DEG4_MAX_ERROR +4.76177926245213712e-06
+#define GTE_C_EXP2_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG5_C1 +6.93152980102749616e-01
+#define GTE_C_EXP2_DEG5_C2 +2.40147123130221019e-01
+#define GTE_C_EXP2_DEG5_C3 +5.58552964131990848e-02
+#define GTE_C_EXP2_DEG5_C4 +8.94775030968730789e-03
+#define GTE_C_EXP2_DEG5_C5 +1.89685004413320257e-03
+#define GTE_C_EXP2_DEG5_MAX_ERROR +1.31620983334634900e-07
+#define GTE_C_EXP2_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG6_C1 +6.93146989148375248e-01
+#define GTE_C_EXP2_DEG6_C2 +2.40230134409529228e-01
+#define GTE_C_EXP2_DEG6_C3 +5.54812768982060334e-02
+#define GTE_C_EXP2_DEG6_C4 +9.68384430370861082e-03
+#define GTE_C_EXP2_DEG6_C5 +1.23883240485156421e-03
+#define GTE_C_EXP2_DEG6_C6 +2.18922835017565376e-04
+#define GTE_C_EXP2_DEG6_MAX_ERROR +3.15891682256541628e-09
+#define GTE_C_EXP2_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_EXP2_DEG7_C1 +6.93147185887506900e-01
+#define GTE_C_EXP2_DEG7_C2 +2.40226373631656998e-01
+#define GTE_C_EXP2_DEG7_C3 +5.55052355705356604e-02
+#define GTE_C_EXP2_DEG7_C4 +9.61362653879405116e-03
+#define GTE_C_EXP2_DEG7_C5 +1.34292345046560513e-03
+#define GTE_C_EXP2_DEG7_C6 +1.42992027576838154e-04
+#define GTE_C_EXP2_DEG7_C7 +2.16628927773854230e-05
+#define GTE_C_EXP2_DEG7_MAX_ERROR +6.68645139256796028e-11
+
+float Exp2EstimateDegree1(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG1_C1;
+    poly = GTE_C_EXP2_DEG1_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree1RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree1(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree1(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG1_C1;
+    poly = GTE_C_EXP2_DEG1_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree1RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree1(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree1(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG1_C1;
+    poly = GTE_C_EXP2_DEG1_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree1RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree1(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree1(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG1_C1;
+    poly = GTE_C_EXP2_DEG1_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree1RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree1(x - p);
+    return ldexp(poly, p);
+}
+
+float Exp2EstimateDegree2(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG2_C2;
+    poly = GTE_C_EXP2_DEG2_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG2_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree2RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree2(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree2(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG2_C2;
+    poly = GTE_C_EXP2_DEG2_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG2_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree2RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree2(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree2(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG2_C2;
+    poly = GTE_C_EXP2_DEG2_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG2_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree2RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree2(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree2(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG2_C2;
+    poly = GTE_C_EXP2_DEG2_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG2_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree2RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree2(x - p);
+    return ldexp(poly, p);
+}
+
+float Exp2EstimateDegree3(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG3_C3;
+    poly = GTE_C_EXP2_DEG3_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree3RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree3(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree3(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG3_C3;
+    poly = GTE_C_EXP2_DEG3_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree3RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree3(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree3(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG3_C3;
+    poly = GTE_C_EXP2_DEG3_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree3RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree3(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree3(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG3_C3;
+    poly = GTE_C_EXP2_DEG3_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG3_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree3RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree3(x - p);
+    return ldexp(poly, p);
+}
+
+float Exp2EstimateDegree4(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG4_C4;
+    poly = GTE_C_EXP2_DEG4_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree4RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree4(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree4(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG4_C4;
+    poly = GTE_C_EXP2_DEG4_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree4RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree4(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree4(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG4_C4;
+    poly = GTE_C_EXP2_DEG4_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree4RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree4(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree4(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG4_C4;
+    poly = GTE_C_EXP2_DEG4_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG4_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree4RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree4(x - p);
+    return ldexp(poly, p);
+}
+
+float Exp2EstimateDegree5(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG5_C5;
+    poly = GTE_C_EXP2_DEG5_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree5RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree5(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree5(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG5_C5;
+    poly = GTE_C_EXP2_DEG5_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree5RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree5(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree5(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG5_C5;
+    poly = GTE_C_EXP2_DEG5_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree5RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree5(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree5(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG5_C5;
+    poly = GTE_C_EXP2_DEG5_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG5_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree5RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree5(x - p);
+    return ldexp(poly, p);
+}
+
+float Exp2EstimateDegree6(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG6_C6;
+    poly = GTE_C_EXP2_DEG6_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree6RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree6(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree6(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG6_C6;
+    poly = GTE_C_EXP2_DEG6_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree6RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree6(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree6(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG6_C6;
+    poly = GTE_C_EXP2_DEG6_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree6RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree6(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree6(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG6_C6;
+    poly = GTE_C_EXP2_DEG6_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG6_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree6RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree6(x - p);
+    return ldexp(poly, p);
+}
+
+float Exp2EstimateDegree7(float x)
+{
+    float poly;
+    poly = GTE_C_EXP2_DEG7_C7;
+    poly = GTE_C_EXP2_DEG7_C6 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C0 + poly * x;
+    return poly;
+}
+
+float Exp2EstimateDegree7RR(float x)
+{
+    float p = floor(x);
+    float poly = Exp2EstimateDegree7(x - p);
+    return ldexp(poly, p);
+}
+
+float2 Exp2EstimateDegree7(float2 x)
+{
+    float2 poly;
+    poly = GTE_C_EXP2_DEG7_C7;
+    poly = GTE_C_EXP2_DEG7_C6 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C0 + poly * x;
+    return poly;
+}
+
+float2 Exp2EstimateDegree7RR(float2 x)
+{
+    float2 p = floor(x);
+    float2 poly = Exp2EstimateDegree7(x - p);
+    return ldexp(poly, p);
+}
+
+float3 Exp2EstimateDegree7(float3 x)
+{
+    float3 poly;
+    poly = GTE_C_EXP2_DEG7_C7;
+    poly = GTE_C_EXP2_DEG7_C6 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C0 + poly * x;
+    return poly;
+}
+
+float3 Exp2EstimateDegree7RR(float3 x)
+{
+    float3 p = floor(x);
+    float3 poly = Exp2EstimateDegree7(x - p);
+    return ldexp(poly, p);
+}
+
+float4 Exp2EstimateDegree7(float4 x)
+{
+    float4 poly;
+    poly = GTE_C_EXP2_DEG7_C7;
+    poly = GTE_C_EXP2_DEG7_C6 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C5 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C4 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C3 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C2 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C1 + poly * x;
+    poly = GTE_C_EXP2_DEG7_C0 + poly * x;
+    return poly;
+}
+
+float4 Exp2EstimateDegree7RR(float4 x)
+{
+    float4 p = floor(x);
+    float4 poly = Exp2EstimateDegree7(x - p);
+    return ldexp(poly, p);
+}
+
+#endif
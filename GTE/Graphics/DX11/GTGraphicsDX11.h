@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -13,6 +13,7 @@
 
 // DX11/Engine
 #include <Graphics/DX11/DX11.h>
+#include <Graphics/DX11/DX11DeferredContext.h>
 #include <Graphics/DX11/DX11Engine.h>
 #include <Graphics/DX11/DX11GraphicsObject.h>
 #include <Graphics/DX11/DX11PerformanceCounter.h>
@@ -3,16 +3,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/DX11/GTGraphicsDX11PCH.h>
 #include <Graphics/DX11/HLSLComputeProgram.h>
 #include <Graphics/DX11/HLSLProgramFactory.h>
 #include <Graphics/DX11/HLSLShaderFactory.h>
 #include <Graphics/DX11/HLSLVisualProgram.h>
+#include <algorithm>
+#include <thread>
 using namespace gte;
 
 HLSLProgramFactory::HLSLProgramFactory()
+    :
+    mNumRunningAsync(0)
 {
     version = defaultVersion;
     vsEntry = defaultVSEntry;
@@ -91,10 +95,29 @@ std::shared_ptr<ComputeProgram> HLSLProgramFactory::CreateFromNamedSource(
 {
     LogAssert(csSource != "", "A program must have a compute shader.");
 
+    std::string cacheFilename = GetCacheFilename({ "cs", csName, csEntry, csSource });
+    if (cacheFilename != "")
+    {
+        std::vector<std::vector<unsigned char>> blobs;
+        if (LoadCacheFile(cacheFilename, blobs) && blobs.size() == 1 && blobs[0].size() > 0)
+        {
+            auto program = CreateFromBytecode(blobs[0]);
+            if (program)
+            {
+                return program;
+            }
+        }
+    }
+
     HLSLReflection hlslCShader = HLSLShaderFactory::CreateFromString(csName,
         csSource, csEntry, std::string("cs_") + version, defines, flags);
     if (hlslCShader.IsValid())
     {
+        if (cacheFilename != "")
+        {
+            SaveCacheFile(cacheFilename, { hlslCShader.GetCompiledCode() });
+        }
+
         auto cshader = std::make_shared<HLSLShader>(hlslCShader, GT_COMPUTE_SHADER);
         auto program = std::make_shared<HLSLComputeProgram>();
         program->SetComputeShader(cshader);
@@ -114,6 +137,23 @@ std::shared_ptr<VisualProgram> HLSLProgramFactory::CreateFromNamedSources(
     LogAssert(vsSource != "" && psSource != "",
         "A program must have a vertex shader and a pixel shader.");
 
+    std::string cacheFilename = GetCacheFilename({ "vs", vsName, vsEntry, vsSource,
+        "ps", psName, psEntry, psSource, "gs", gsName, gsEntry, gsSource });
+    if (cacheFilename != "")
+    {
+        std::vector<std::vector<unsigned char>> blobs;
+        if (LoadCacheFile(cacheFilename, blobs) && blobs.size() == 3
+            && blobs[0].size() > 0 && blobs[1].size() > 0
+            && (blobs[2].size() > 0) == (gsSource != ""))
+        {
+            auto program = CreateFromBytecode(blobs[0], blobs[1], blobs[2]);
+            if (program)
+            {
+                return program;
+            }
+        }
+    }
+
     std::shared_ptr<HLSLShader> vshader;
     std::shared_ptr<HLSLShader> pshader;
     std::shared_ptr<HLSLShader> gshader;
@@ -155,6 +195,12 @@ std::shared_ptr<VisualProgram> HLSLProgramFactory::CreateFromNamedSources(
         }
     }
 
+    if (cacheFilename != "")
+    {
+        SaveCacheFile(cacheFilename, { hlslVShader.GetCompiledCode(),
+            hlslPShader.GetCompiledCode(), hlslGShader.GetCompiledCode() });
+    }
+
     auto program = std::make_shared<HLSLVisualProgram>();
     program->SetVertexShader(vshader);
     program->SetPixelShader(pshader);
@@ -184,6 +230,91 @@ std::shared_ptr<ComputeProgram> HLSLProgramFactory::CreateFromBytecode(
 }
 
 
+HLSLProgramFactory::HLSLAsyncRequest::HLSLAsyncRequest()
+    :
+    started(false)
+{
+}
+
+std::shared_ptr<ProgramFactory::AsyncRequest> HLSLProgramFactory::CreateAsyncRequest()
+{
+    return std::make_shared<HLSLAsyncRequest>();
+}
+
+void HLSLProgramFactory::StartAsync(AsyncRequest& request)
+{
+    unsigned int const maxRunning = std::max(std::thread::hardware_concurrency(), 1u);
+    if (mNumRunningAsync < maxRunning)
+    {
+        LaunchAsync(static_cast<HLSLAsyncRequest&>(request));
+    }
+}
+
+bool HLSLProgramFactory::PollAsync(AsyncRequest& request)
+{
+    auto& hlslRequest = static_cast<HLSLAsyncRequest&>(request);
+    if (!hlslRequest.started)
+    {
+        StartAsync(request);
+        return false;
+    }
+
+    if (hlslRequest.task.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return false;
+    }
+
+    --mNumRunningAsync;
+    try
+    {
+        // The get() rethrows the exception of a failed compilation.
+        hlslRequest.task.get();
+        if (request.isCompute)
+        {
+            request.computePromise.set_value(hlslRequest.computeProgram);
+        }
+        else
+        {
+            request.visualPromise.set_value(hlslRequest.visualProgram);
+        }
+    }
+    catch (...)
+    {
+        if (request.isCompute)
+        {
+            request.computePromise.set_exception(std::current_exception());
+        }
+        else
+        {
+            request.visualPromise.set_exception(std::current_exception());
+        }
+    }
+    return true;
+}
+
+void HLSLProgramFactory::LaunchAsync(HLSLAsyncRequest& request)
+{
+    request.started = true;
+    ++mNumRunningAsync;
+    request.task = std::async(std::launch::async, [&request]()
+    {
+        HLSLProgramFactory factory;
+        factory.SetState(request);
+        auto const& names = request.names;
+        auto const& sources = request.sources;
+        if (request.isCompute)
+        {
+            request.computeProgram = factory.CreateFromNamedSource(
+                names[0], sources[0]);
+        }
+        else
+        {
+            request.visualProgram = factory.CreateFromNamedSources(
+                names[0], sources[0], names[1], sources[1], names[2], sources[2]);
+        }
+    });
+}
+
 std::string HLSLProgramFactory::defaultVersion = "5_0";
 std::string HLSLProgramFactory::defaultVSEntry = "VSMain";
 std::string HLSLProgramFactory::defaultPSEntry = "PSMain";
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -34,7 +34,11 @@ namespace gte
         // corresponding to shader programs.
         virtual int GetAPI() const;
 
-        // Create a program for GPU display.
+        // Create a program for GPU display. The programs created from
+        // sources are stored in the program cache (see ProgramFactory) as
+        // the compiled bytecode of their shaders and are created by these
+        // functions on a cache hit; the shader reflection runs on the
+        // bytecode without compiling.
         std::shared_ptr<VisualProgram> CreateFromBytecode(
             std::vector<unsigned char> const& vsBytecode,
             std::vector<unsigned char> const& psBytecode,
@@ -60,5 +64,29 @@ namespace gte
         // this for #include path searches.
         virtual std::shared_ptr<ComputeProgram> CreateFromNamedSource(
             std::string const& csName, std::string const& csSource);
+
+        // Support for asynchronous creation. D3DCompile and the shader
+        // reflection do not use the device, so the programs are created by
+        // worker tasks, each with its own factory that has the state of the
+        // request. At most std::thread::hardware_concurrency() tasks run at
+        // a time; the other requests are started by PollAsync when tasks
+        // finish. The task is the last member so that it is joined before
+        // the program members it writes are destroyed.
+        struct HLSLAsyncRequest : public AsyncRequest
+        {
+            HLSLAsyncRequest();
+
+            bool started;
+            std::shared_ptr<VisualProgram> visualProgram;
+            std::shared_ptr<ComputeProgram> computeProgram;
+            std::future<void> task;
+        };
+
+        virtual std::shared_ptr<AsyncRequest> CreateAsyncRequest() override;
+        virtual void StartAsync(AsyncRequest& request) override;
+        virtual bool PollAsync(AsyncRequest& request) override;
+        void LaunchAsync(HLSLAsyncRequest& request);
+
+        unsigned int mNumRunningAsync;
     };
 }
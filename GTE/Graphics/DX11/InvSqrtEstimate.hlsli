@@ -0,0 +1,794 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to 1/sqrt(x) for x in [1,2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/InvSqrtEstimate.h. Do not edit it.
+
+#ifndef GTE_INVSQRTESTIMATE_HLSLI
+#define GTE_INVSQRTESTIMATE_HLSLI
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_INVSQRT_DEG1_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG1_C1 -2.92893218813452538e-01
+#define GTE_C_INVSQRT_DEG1_MAX_ERROR +3.78143145527019831e-02
+#define GTE_C_INVSQRT_DEG2_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG2_C1 -4.45398121045668005e-01
+#define GTE_C_INVSQRT_DEG2_C2 +1.52504902232215467e-01
+#define GTE_C_INVSQRT_DEG2_MAX_ERROR +4.19534463305812344e-03
+#define GTE_C_INVSQRT_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG3_C1 -4.87032309930687912e-01
+#define GTE_C_INVSQRT_DEG3_C2 +2.81637104866698351e-01
+#define GTE_C_INVSQRT_DEG3_C3 -8.74980137494634214e-02
+#define GTE_C_INVSQRT_DEG3_MAX_ERROR +5.63077020072667855e-04
+#define GTE_C_INVSQRT_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG4_C1 -4.97100615580487792e-01
+#define GTE_C_INVSQRT_DEG4_C2 +3.42662475976768022e-01
+#define GTE_C_INVSQRT_DEG4_C3 -1.91063565362934895e-01
+#define GTE_C_INVSQRT_DEG4_C4 +5.26084861531987968e-02
+#define GTE_C_INVSQRT_DEG4_MAX_ERROR +8.15139199876052656e-05
+#define GTE_C_INVSQRT_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG5_C1 -4.99377605860041429e-01
+#define GTE_C_INVSQRT_DEG5_C2 +3.65087412951339729e-01
+#define GTE_C_INVSQRT_DEG5_C3 -2.58848902818535009e-01
+#define GTE_C_INVSQRT_DEG5_C4 +1.32757822213207533e-01
+#define GTE_C_INVSQRT_DEG5_C5 -3.25119452994044877e-02
+#define GTE_C_INVSQRT_DEG5_MAX_ERROR +1.22893674755833460e-05
+#define GTE_C_INVSQRT_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG6_C1 -4.99870292295474528e-01
+#define GTE_C_INVSQRT_DEG6_C2 +3.72209236044952263e-01
+#define GTE_C_INVSQRT_DEG6_C3 -2.91930677132569372e-01
+#define GTE_C_INVSQRT_DEG6_C4 +1.99376059910946424e-01
+#define GTE_C_INVSQRT_DEG6_C5 -9.31357121309019931e-02
+#define GTE_C_INVSQRT_DEG6_C6 +2.04581667895666897e-02
+#define GTE_C_INVSQRT_DEG6_MAX_ERROR +1.90014512237504651e-06
+#define GTE_C_INVSQRT_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG7_C1 -4.99973572507049768e-01
+#define GTE_C_INVSQRT_DEG7_C2 +3.74262168849988086e-01
+#define GTE_C_INVSQRT_DEG7_C3 -3.05398824982489714e-01
+#define GTE_C_INVSQRT_DEG7_C4 +2.39760056070053906e-01
+#define GTE_C_INVSQRT_DEG7_C5 -1.54103263516844891e-01
+#define GTE_C_INVSQRT_DEG7_C6 +6.55988097230419953e-02
+#define GTE_C_INVSQRT_DEG7_C7 -1.30385924504707873e-02
+#define GTE_C_INVSQRT_DEG7_MAX_ERROR +2.98877249931689404e-07
+#define GTE_C_INVSQRT_DEG8_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG8_C1 -4.99994710661203712e-01
+#define GTE_C_INVSQRT_DEG8_C2 +3.74814157457940667e-01
+#define GTE_C_INVSQRT_DEG8_C3 -3.10238043874221603e-01
+#define GTE_C_INVSQRT_DEG8_C4 +2.59770026829301059e-01
+#define GTE_C_INVSQRT_DEG8_C5 -1.98187907177270972e-01
+#define GTE_C_INVSQRT_DEG8_C6 +1.18824142526136711e-01
+#define GTE_C_INVSQRT_DEG8_C7 -4.62700380885507911e-02
+#define GTE_C_INVSQRT_DEG8_C8 +8.38915417557473120e-03
+#define GTE_C_INVSQRT_DEG8_MAX_ERROR +4.75969261469477711e-08
+
+void InvSqrtEstimateReduce(float x, out float adj, out float y, out float p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_INV_SQRT_2 : 1.0);
+    p = -half;
+}
+
+float InvSqrtEstimateCombine(float adj, float y, float p)
+{
+    return adj * ldexp(y, p);
+}
+
+void InvSqrtEstimateReduce(float2 x, out float2 adj, out float2 y, out float2 p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float2 half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_INV_SQRT_2 : 1.0);
+    p = -half;
+}
+
+float2 InvSqrtEstimateCombine(float2 adj, float2 y, float2 p)
+{
+    return adj * ldexp(y, p);
+}
+
+void InvSqrtEstimateReduce(float3 x, out float3 adj, out float3 y, out float3 p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float3 half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_INV_SQRT_2 : 1.0);
+    p = -half;
+}
+
+float3 InvSqrtEstimateCombine(float3 adj, float3 y, float3 p)
+{
+    return adj * ldexp(y, p);
+}
+
+void InvSqrtEstimateReduce(float4 x, out float4 adj, out float4 y, out float4 p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float4 half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_INV_SQRT_2 : 1.0);
+    p = -half;
+}
+
+float4 InvSqrtEstimateCombine(float4 adj, float4 y, float4 p)
+{
+    return adj * ldexp(y, p);
+}
+
+float InvSqrtEstimateDegree1(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG1_C1;
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree1RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree1(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG1_C1;
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree1RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree1(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG1_C1;
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree1RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree1(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG1_C1;
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree1RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree2(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG2_C2;
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree2RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree2(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG2_C2;
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree2RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree2(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG2_C2;
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree2RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree2(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG2_C2;
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree2RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree3(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG3_C3;
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree3RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree3(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG3_C3;
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree3RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree3(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG3_C3;
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree3RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree3(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG3_C3;
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree3RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree4(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG4_C4;
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree4RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree4(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG4_C4;
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree4RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree4(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG4_C4;
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree4RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree4(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG4_C4;
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree4RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree5(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG5_C5;
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree5RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree5(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG5_C5;
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree5RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree5(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG5_C5;
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree5RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree5(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG5_C5;
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree5RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree6(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG6_C6;
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree6RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree6(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG6_C6;
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree6RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree6(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG6_C6;
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree6RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree6(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG6_C6;
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree6RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree7(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG7_C7;
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree7RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree7(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG7_C7;
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree7RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree7(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG7_C7;
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree7RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree7(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG7_C7;
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree7RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree8(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG8_C8;
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree8RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float2 InvSqrtEstimateDegree8(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_INVSQRT_DEG8_C8;
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float2 InvSqrtEstimateDegree8RR(float2 x)
+{
+    float2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float2 poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float3 InvSqrtEstimateDegree8(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_INVSQRT_DEG8_C8;
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float3 InvSqrtEstimateDegree8RR(float3 x)
+{
+    float3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float3 poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float4 InvSqrtEstimateDegree8(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_INVSQRT_DEG8_C8;
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float4 InvSqrtEstimateDegree8RR(float4 x)
+{
+    float4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float4 poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+#endif
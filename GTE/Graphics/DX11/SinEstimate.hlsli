@@ -0,0 +1,431 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to sin(x) for x in [-pi/2,pi/2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/SinEstimate.h. Do not edit it.
+
+#ifndef GTE_SINESTIMATE_HLSLI
+#define GTE_SINESTIMATE_HLSLI
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_SIN_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_SIN_DEG3_C1 -1.47272459103755193e-01
+#define GTE_C_SIN_DEG3_MAX_ERROR +1.34819036391458646e-02
+#define GTE_C_SIN_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_SIN_DEG5_C1 -1.66005999238122093e-01
+#define GTE_C_SIN_DEG5_C2 +7.59241784090119998e-03
+#define GTE_C_SIN_DEG5_MAX_ERROR +1.40012093846397789e-04
+#define GTE_C_SIN_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_SIN_DEG7_C1 -1.66655780847321244e-01
+#define GTE_C_SIN_DEG7_C2 +8.31093788300285574e-03
+#define GTE_C_SIN_DEG7_C3 -1.84474861034622517e-04
+#define GTE_C_SIN_DEG7_MAX_ERROR +1.02058789366865632e-06
+#define GTE_C_SIN_DEG9_C0 +1.00000000000000000e+00
+#define GTE_C_SIN_DEG9_C1 -1.66666562353088965e-01
+#define GTE_C_SIN_DEG9_C2 +8.33299625098860020e-03
+#define GTE_C_SIN_DEG9_C3 -1.98051006752741898e-04
+#define GTE_C_SIN_DEG9_C4 +2.59672002794752999e-06
+#define GTE_C_SIN_DEG9_MAX_ERROR +5.20107462653740527e-09
+#define GTE_C_SIN_DEG11_C0 +1.00000000000000000e+00
+#define GTE_C_SIN_DEG11_C1 -1.66666666017212695e-01
+#define GTE_C_SIN_DEG11_C2 +8.33333031835259419e-03
+#define GTE_C_SIN_DEG11_C3 -1.98407824262503141e-04
+#define GTE_C_SIN_DEG11_C4 +2.75215577705267833e-06
+#define GTE_C_SIN_DEG11_C5 -2.38285446929609179e-08
+#define GTE_C_SIN_DEG11_MAX_ERROR +1.92958704570145301e-11
+
+float SinEstimateReduce(float x)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    float y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with sin(y) = sin(x).
+    return ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+float2 SinEstimateReduce(float2 x)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float2 quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    float2 y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with sin(y) = sin(x).
+    return ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+float3 SinEstimateReduce(float3 x)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float3 quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    float3 y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with sin(y) = sin(x).
+    return ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+float4 SinEstimateReduce(float4 x)
+{
+    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.
+    float4 quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));
+    float4 y = x - GTE_C_TWO_PI * quotient;
+
+    // Map y to [-pi/2,pi/2] with sin(y) = sin(x).
+    return ((y > GTE_C_HALF_PI) ? GTE_C_PI - y : ((y < -GTE_C_HALF_PI) ? -GTE_C_PI - y : y));
+}
+
+float SinEstimateDegree3(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_SIN_DEG3_C1;
+    poly = GTE_C_SIN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float SinEstimateDegree3RR(float x)
+{
+    return SinEstimateDegree3(SinEstimateReduce(x));
+}
+
+float2 SinEstimateDegree3(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_SIN_DEG3_C1;
+    poly = GTE_C_SIN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 SinEstimateDegree3RR(float2 x)
+{
+    return SinEstimateDegree3(SinEstimateReduce(x));
+}
+
+float3 SinEstimateDegree3(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_SIN_DEG3_C1;
+    poly = GTE_C_SIN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 SinEstimateDegree3RR(float3 x)
+{
+    return SinEstimateDegree3(SinEstimateReduce(x));
+}
+
+float4 SinEstimateDegree3(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_SIN_DEG3_C1;
+    poly = GTE_C_SIN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 SinEstimateDegree3RR(float4 x)
+{
+    return SinEstimateDegree3(SinEstimateReduce(x));
+}
+
+float SinEstimateDegree5(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_SIN_DEG5_C2;
+    poly = GTE_C_SIN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float SinEstimateDegree5RR(float x)
+{
+    return SinEstimateDegree5(SinEstimateReduce(x));
+}
+
+float2 SinEstimateDegree5(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_SIN_DEG5_C2;
+    poly = GTE_C_SIN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 SinEstimateDegree5RR(float2 x)
+{
+    return SinEstimateDegree5(SinEstimateReduce(x));
+}
+
+float3 SinEstimateDegree5(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_SIN_DEG5_C2;
+    poly = GTE_C_SIN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 SinEstimateDegree5RR(float3 x)
+{
+    return SinEstimateDegree5(SinEstimateReduce(x));
+}
+
+float4 SinEstimateDegree5(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_SIN_DEG5_C2;
+    poly = GTE_C_SIN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 SinEstimateDegree5RR(float4 x)
+{
+    return SinEstimateDegree5(SinEstimateReduce(x));
+}
+
+float SinEstimateDegree7(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_SIN_DEG7_C3;
+    poly = GTE_C_SIN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float SinEstimateDegree7RR(float x)
+{
+    return SinEstimateDegree7(SinEstimateReduce(x));
+}
+
+float2 SinEstimateDegree7(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_SIN_DEG7_C3;
+    poly = GTE_C_SIN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 SinEstimateDegree7RR(float2 x)
+{
+    return SinEstimateDegree7(SinEstimateReduce(x));
+}
+
+float3 SinEstimateDegree7(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_SIN_DEG7_C3;
+    poly = GTE_C_SIN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 SinEstimateDegree7RR(float3 x)
+{
+    return SinEstimateDegree7(SinEstimateReduce(x));
+}
+
+float4 SinEstimateDegree7(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_SIN_DEG7_C3;
+    poly = GTE_C_SIN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 SinEstimateDegree7RR(float4 x)
+{
+    return SinEstimateDegree7(SinEstimateReduce(x));
+}
+
+float SinEstimateDegree9(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_SIN_DEG9_C4;
+    poly = GTE_C_SIN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float SinEstimateDegree9RR(float x)
+{
+    return SinEstimateDegree9(SinEstimateReduce(x));
+}
+
+float2 SinEstimateDegree9(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_SIN_DEG9_C4;
+    poly = GTE_C_SIN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 SinEstimateDegree9RR(float2 x)
+{
+    return SinEstimateDegree9(SinEstimateReduce(x));
+}
+
+float3 SinEstimateDegree9(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_SIN_DEG9_C4;
+    poly = GTE_C_SIN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 SinEstimateDegree9RR(float3 x)
+{
+    return SinEstimateDegree9(SinEstimateReduce(x));
+}
+
+float4 SinEstimateDegree9(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_SIN_DEG9_C4;
+    poly = GTE_C_SIN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 SinEstimateDegree9RR(float4 x)
+{
+    return SinEstimateDegree9(SinEstimateReduce(x));
+}
+
+float SinEstimateDegree11(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_SIN_DEG11_C5;
+    poly = GTE_C_SIN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float SinEstimateDegree11RR(float x)
+{
+    return SinEstimateDegree11(SinEstimateReduce(x));
+}
+
+float2 SinEstimateDegree11(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_SIN_DEG11_C5;
+    poly = GTE_C_SIN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 SinEstimateDegree11RR(float2 x)
+{
+    return SinEstimateDegree11(SinEstimateReduce(x));
+}
+
+float3 SinEstimateDegree11(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_SIN_DEG11_C5;
+    poly = GTE_C_SIN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 SinEstimateDegree11RR(float3 x)
+{
+    return SinEstimateDegree11(SinEstimateReduce(x));
+}
+
+float4 SinEstimateDegree11(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_SIN_DEG11_C5;
+    poly = GTE_C_SIN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_SIN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 SinEstimateDegree11RR(float4 x)
+{
+    return SinEstimateDegree11(SinEstimateReduce(x));
+}
+
+#endif
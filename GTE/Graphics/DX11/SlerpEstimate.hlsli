@@ -0,0 +1,1009 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Estimates of sin(t*A)/sin(A) and of the slerp of unit quaternions.
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/SlerpEstimate.h. Do not edit it.
+
+#ifndef GTE_SLERPESTIMATE_HLSLI
+#define GTE_SLERPESTIMATE_HLSLI
+
+#define GTE_C_CHEBYSHEV_RATIO_A0 +3.33333333333333315e-01
+#define GTE_C_CHEBYSHEV_RATIO_B0 +3.33333333333333315e-01
+#define GTE_C_CHEBYSHEV_RATIO_A1 +1.00000000000000006e-01
+#define GTE_C_CHEBYSHEV_RATIO_B1 +4.00000000000000022e-01
+#define GTE_C_CHEBYSHEV_RATIO_A2 +4.76190476190476164e-02
+#define GTE_C_CHEBYSHEV_RATIO_B2 +4.28571428571428548e-01
+#define GTE_C_CHEBYSHEV_RATIO_A3 +2.77777777777777762e-02
+#define GTE_C_CHEBYSHEV_RATIO_B3 +4.44444444444444420e-01
+#define GTE_C_CHEBYSHEV_RATIO_A4 +1.81818181818181809e-02
+#define GTE_C_CHEBYSHEV_RATIO_B4 +4.54545454545454530e-01
+#define GTE_C_CHEBYSHEV_RATIO_A5 +1.28205128205128201e-02
+#define GTE_C_CHEBYSHEV_RATIO_B5 +4.61538461538461564e-01
+#define GTE_C_CHEBYSHEV_RATIO_A6 +9.52380952380952467e-03
+#define GTE_C_CHEBYSHEV_RATIO_B6 +4.66666666666666674e-01
+#define GTE_C_CHEBYSHEV_RATIO_A7 +7.35294117647058813e-03
+#define GTE_C_CHEBYSHEV_RATIO_B7 +4.70588235294117641e-01
+#define GTE_C_CHEBYSHEV_RATIO_A8 +5.84795321637426868e-03
+#define GTE_C_CHEBYSHEV_RATIO_B8 +4.73684210526315763e-01
+#define GTE_C_CHEBYSHEV_RATIO_A9 +4.76190476190476233e-03
+#define GTE_C_CHEBYSHEV_RATIO_B9 +4.76190476190476164e-01
+#define GTE_C_CHEBYSHEV_RATIO_A10 +3.95256916996047404e-03
+#define GTE_C_CHEBYSHEV_RATIO_B10 +4.78260869565217406e-01
+#define GTE_C_CHEBYSHEV_RATIO_A11 +3.33333333333333355e-03
+#define GTE_C_CHEBYSHEV_RATIO_B11 +4.79999999999999982e-01
+#define GTE_C_CHEBYSHEV_RATIO_A12 +2.84900284900284914e-03
+#define GTE_C_CHEBYSHEV_RATIO_B12 +4.81481481481481455e-01
+#define GTE_C_CHEBYSHEV_RATIO_A13 +2.46305418719211825e-03
+#define GTE_C_CHEBYSHEV_RATIO_B13 +4.82758620689655193e-01
+#define GTE_C_CHEBYSHEV_RATIO_A14 +2.15053763440860215e-03
+#define GTE_C_CHEBYSHEV_RATIO_B14 +4.83870967741935498e-01
+#define GTE_C_CHEBYSHEV_RATIO_A15 +1.89393939393939399e-03
+#define GTE_C_CHEBYSHEV_RATIO_B15 +4.84848484848484862e-01
+
+#define GTE_C_CHEBYSHEV_RATIO_DEG1_A +5.43144787027448506e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG1_B +5.43144787027448506e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG2_A +1.73965850021313956e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG2_B +6.95863400085255823e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG3_A +8.55719369664603852e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG3_B +7.70147432698143453e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG4_A +5.09143945862043923e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG4_B +8.14630313379270277e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG5_A +3.37768141598254537e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG5_B +8.44420353995636308e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG6_A +2.40508763716544595e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG6_B +8.65831549379560528e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG7_A +1.79998518971153515e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG7_B +8.81992742958652376e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG8_A +1.39787312758625024e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG8_B +8.94638801655200155e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG9_A +1.11705193678334706e-02
+#define GTE_C_CHEBYSHEV_RATIO_DEG9_B +9.04812068794511037e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG10_A +9.13177833014510408e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG10_B +9.13177833014510387e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG11_A +7.60480399976913406e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG11_B +9.20181283972065223e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG12_A +6.43147142226709392e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG12_B +9.26131884806461469e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG13_A +5.51036448356384805e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG13_B +9.31251597722290270e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG14_A +4.77399929218127496e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG14_B +9.35703861267529913e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG15_A +4.17605217996569293e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG15_B +9.39611740492280911e-01
+#define GTE_C_CHEBYSHEV_RATIO_DEG16_A +3.68386602220638825e-03
+#define GTE_C_CHEBYSHEV_RATIO_DEG16_B +9.43069701684835393e-01
+
+void ChebyshevRatioEstimateDegree1(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG1_B - GTE_C_CHEBYSHEV_RATIO_DEG1_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG1_B - GTE_C_CHEBYSHEV_RATIO_DEG1_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree1(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree1(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree1(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree1(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree2(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG2_B - GTE_C_CHEBYSHEV_RATIO_DEG2_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG2_B - GTE_C_CHEBYSHEV_RATIO_DEG2_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree2(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree2(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree2(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree2(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree3(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG3_B - GTE_C_CHEBYSHEV_RATIO_DEG3_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG3_B - GTE_C_CHEBYSHEV_RATIO_DEG3_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree3(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree3(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree3(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree3(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree4(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG4_B - GTE_C_CHEBYSHEV_RATIO_DEG4_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG4_B - GTE_C_CHEBYSHEV_RATIO_DEG4_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree4(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree4(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree4(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree4(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree5(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG5_B - GTE_C_CHEBYSHEV_RATIO_DEG5_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG5_B - GTE_C_CHEBYSHEV_RATIO_DEG5_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree5(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree5(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree5(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree5(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree6(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG6_B - GTE_C_CHEBYSHEV_RATIO_DEG6_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG6_B - GTE_C_CHEBYSHEV_RATIO_DEG6_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree6(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree6(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree6(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree6(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree7(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG7_B - GTE_C_CHEBYSHEV_RATIO_DEG7_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG7_B - GTE_C_CHEBYSHEV_RATIO_DEG7_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree7(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree7(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree7(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree7(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree8(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG8_B - GTE_C_CHEBYSHEV_RATIO_DEG8_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG8_B - GTE_C_CHEBYSHEV_RATIO_DEG8_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree8(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree8(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree8(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree8(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree9(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG9_B - GTE_C_CHEBYSHEV_RATIO_DEG9_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG9_B - GTE_C_CHEBYSHEV_RATIO_DEG9_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree9(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree9(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree9(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree9(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree10(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG10_B - GTE_C_CHEBYSHEV_RATIO_DEG10_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG10_B - GTE_C_CHEBYSHEV_RATIO_DEG10_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree10(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree10(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree10(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree10(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree11(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG11_B - GTE_C_CHEBYSHEV_RATIO_DEG11_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG11_B - GTE_C_CHEBYSHEV_RATIO_DEG11_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree11(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree11(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree11(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree11(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree12(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG12_B - GTE_C_CHEBYSHEV_RATIO_DEG12_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG12_B - GTE_C_CHEBYSHEV_RATIO_DEG12_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree12(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree12(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree12(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree12(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree13(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG13_B - GTE_C_CHEBYSHEV_RATIO_DEG13_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG13_B - GTE_C_CHEBYSHEV_RATIO_DEG13_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree13(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree13(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree13(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree13(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree14(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B12 - GTE_C_CHEBYSHEV_RATIO_A12 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B12 - GTE_C_CHEBYSHEV_RATIO_A12 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG14_B - GTE_C_CHEBYSHEV_RATIO_DEG14_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG14_B - GTE_C_CHEBYSHEV_RATIO_DEG14_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree14(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree14(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree14(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree14(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree15(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B12 - GTE_C_CHEBYSHEV_RATIO_A12 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B12 - GTE_C_CHEBYSHEV_RATIO_A12 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B13 - GTE_C_CHEBYSHEV_RATIO_A13 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B13 - GTE_C_CHEBYSHEV_RATIO_A13 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG15_B - GTE_C_CHEBYSHEV_RATIO_DEG15_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG15_B - GTE_C_CHEBYSHEV_RATIO_DEG15_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree15(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree15(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree15(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree15(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+void ChebyshevRatioEstimateDegree16(float t, float y, out float f0, out float f1)
+{
+    float term0 = 1.0 - t, term1 = t;
+    float sqr0 = term0 * term0, sqr1 = term1 * term1;
+    f0 = term0;
+    f1 = term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B0 - GTE_C_CHEBYSHEV_RATIO_A0 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B1 - GTE_C_CHEBYSHEV_RATIO_A1 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B2 - GTE_C_CHEBYSHEV_RATIO_A2 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B3 - GTE_C_CHEBYSHEV_RATIO_A3 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B4 - GTE_C_CHEBYSHEV_RATIO_A4 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B5 - GTE_C_CHEBYSHEV_RATIO_A5 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B6 - GTE_C_CHEBYSHEV_RATIO_A6 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B7 - GTE_C_CHEBYSHEV_RATIO_A7 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B8 - GTE_C_CHEBYSHEV_RATIO_A8 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B9 - GTE_C_CHEBYSHEV_RATIO_A9 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B10 - GTE_C_CHEBYSHEV_RATIO_A10 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B11 - GTE_C_CHEBYSHEV_RATIO_A11 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B12 - GTE_C_CHEBYSHEV_RATIO_A12 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B12 - GTE_C_CHEBYSHEV_RATIO_A12 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B13 - GTE_C_CHEBYSHEV_RATIO_A13 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B13 - GTE_C_CHEBYSHEV_RATIO_A13 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_B14 - GTE_C_CHEBYSHEV_RATIO_A14 * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_B14 - GTE_C_CHEBYSHEV_RATIO_A14 * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+    term0 *= (GTE_C_CHEBYSHEV_RATIO_DEG16_B - GTE_C_CHEBYSHEV_RATIO_DEG16_A * sqr0) * y;
+    term1 *= (GTE_C_CHEBYSHEV_RATIO_DEG16_B - GTE_C_CHEBYSHEV_RATIO_DEG16_A * sqr1) * y;
+    f0 += term0;
+    f1 += term1;
+}
+
+float4 SlerpEstimateDegree16(float t, float4 q0, float4 q1)
+{
+    float cs = dot(q0, q1);
+    float sgn = (cs >= 0.0 ? 1.0 : -1.0);
+    float f0, f1;
+    ChebyshevRatioEstimateDegree16(t, 1.0 - sgn * cs, f0, f1);
+    return q0 * f0 + q1 * (sgn * f1);
+}
+
+float4 SlerpEstimateRDegree16(float t, float4 q0, float4 q1)
+{
+    float f0, f1;
+    ChebyshevRatioEstimateDegree16(t, 1.0 - dot(q0, q1), f0, f1);
+    return q0 * f0 + q1 * f1;
+}
+
+#endif
@@ -3,123 +3,792 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
-
-#define GT1_USE_IN_HLSL
-#include "Gt1Constants.h"
-#include "Gt1DoubleFunction.hlsli"
-
-// Minimax polynomial approximations to sqrt(x).  The polynomial p(x) of
-// degree D minimizes the quantity maximum{|sqrt(x) - p(x)| : x in [1,2]}
-// over all polynomials of degree D.
-
-//----------------------------------------------------------------------------
-#define TSqrtEstimateReduceF(Dim)\
-    void SqrtEstimateReduce(vector<float,Dim> x, out vector<float,Dim> adj,\
-        out vector<float,Dim> y, out vector<int,Dim> p)\
-    {\
-        y = frexp(x, p);\
-        y = 2.0*y;\
-        --p;\
-        adj = (1 & p)*GT1_C_SQRT_2 + (1 & ~p)*1.0;\
-        p >>= 1;\
-    }
-
-#define TSqrtEstimateReduceD(Dim)\
-    void SqrtEstimateReduce(vector<double,Dim> x, out vector<double,Dim> adj,\
-        out vector<double,Dim> y, out vector<int,Dim> p)\
-    {\
-        y = frexp_d(x, p);\
-        y = 2.0*y;\
-        --p;\
-        adj = (1 & p)*GT1_C_SQRT_2 + (1 & ~p)*1.0;\
-        p >>= 1;\
-    }
-
-TSqrtEstimateReduceF(1)
-TSqrtEstimateReduceF(2)
-TSqrtEstimateReduceF(3)
-TSqrtEstimateReduceF(4)
-//TSqrtEstimateReduceD(1)
-//TSqrtEstimateReduce(double,2)
-//TSqrtEstimateReduce(double,3)
-//TSqrtEstimateReduce(double,4)
-//----------------------------------------------------------------------------
-
-//----------------------------------------------------------------------------
-#define TSqrtEstimateCombine(Real,Dim)\
-    vector<Real,Dim> SqrtEstimateCombine(vector<Real,Dim> adj,\
-        vector<Real,Dim> y, vector<int,Dim> p)\
-    {\
-        return adj*ldexp(y, p);\
-    }
-
-TSqrtEstimateCombine(float,1)
-TSqrtEstimateCombine(float,2)
-TSqrtEstimateCombine(float,3)
-TSqrtEstimateCombine(float,4)
-//TSqrtEstimateCombine(double,1)
-//TSqrtEstimateCombine(double,2)
-//TSqrtEstimateCombine(double,3)
-//TSqrtEstimateCombine(double,4)
-//----------------------------------------------------------------------------
-
-//----------------------------------------------------------------------------
-#define TSqrtEstimateDegree1Evaluate(Real,Dim)\
-    vector<Real,Dim> SqrtEstimateDegree1Evaluate(vector<Real,Dim> t)\
-    {\
-        vector<Real,Dim> poly;\
-        poly = GT1_C_SQRT_DEG1_C1;\
-        poly = GT1_C_SQRT_DEG1_C0 + poly * t;\
-        return poly;\
-    }
-
-TSqrtEstimateDegree1Evaluate(float,1)
-TSqrtEstimateDegree1Evaluate(float,2)
-TSqrtEstimateDegree1Evaluate(float,3)
-TSqrtEstimateDegree1Evaluate(float,4)
-//TSqrtEstimateDegree1Evaluate(double,1)
-//TSqrtEstimateDegree1Evaluate(double,2)
-//TSqrtEstimateDegree1Evaluate(double,3)
-//TSqrtEstimateDegree1Evaluate(double,4)
-//----------------------------------------------------------------------------
-
-//----------------------------------------------------------------------------
-#define TSqrtEstimateDegree1(Real,Dim)\
-    vector<Real,Dim> SqrtEstimateDegree1(vector<Real,Dim> x)\
-    {\
-        vector<Real,Dim> t = x - 1.0;\
-        return SqrtEstimateDegree1Evaluate(t);\
-    }
-
-TSqrtEstimateDegree1(float,1)
-TSqrtEstimateDegree1(float,2)
-TSqrtEstimateDegree1(float,3)
-TSqrtEstimateDegree1(float,4)
-//TSqrtEstimateDegree1(double,1)
-//TSqrtEstimateDegree1(double,2)
-//TSqrtEstimateDegree1(double,3)
-//TSqrtEstimateDegree1(double,4)
-//----------------------------------------------------------------------------
-
-//----------------------------------------------------------------------------
-#define TSqrtEstimateDegree1RR(Real,Dim)\
-    vector<Real,Dim> SqrtEstimateDegree1RR(vector<Real,Dim> x)\
-    {\
-        vector<Real,Dim> adj, y;\
-        vector<int,Dim> p;\
-        SqrtEstimateReduce(x, adj, y, p);\
-        vector<Real,Dim> poly = SqrtEstimateDegree1Evaluate(y);\
-        vector<Real,Dim> result = SqrtEstimateCombine(adj, poly, p);\
-        return result;\
-    }
-
-TSqrtEstimateDegree1RR(float, 1)
-TSqrtEstimateDegree1RR(float, 2)
-TSqrtEstimateDegree1RR(float, 3)
-TSqrtEstimateDegree1RR(float, 4)
-TSqrtEstimateDegree1RR(double, 1)
-//TSqrtEstimateDegree1RR(double, 2)
-//TSqrtEstimateDegree1RR(double, 3)
-//TSqrtEstimateDegree1RR(double, 4)
-//----------------------------------------------------------------------------
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to sqrt(x) for x in [1,2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/SqrtEstimate.h. Do not edit it.
+
+#ifndef GTE_SQRTESTIMATE_HLSLI
+#define GTE_SQRTESTIMATE_HLSLI
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_SQRT_DEG1_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG1_C1 +4.14213562373095034e-01
+#define GTE_C_SQRT_DEG1_MAX_ERROR +1.77669529663687931e-02
+#define GTE_C_SQRT_DEG2_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG2_C1 +4.85631830761252603e-01
+#define GTE_C_SQRT_DEG2_C2 -7.14182683881574576e-02
+#define GTE_C_SQRT_DEG2_MAX_ERROR +1.17956951631087437e-03
+#define GTE_C_SQRT_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG3_C1 +4.97500453202422310e-01
+#define GTE_C_SQRT_DEG3_C2 -1.07873080444778502e-01
+#define GTE_C_SQRT_DEG3_C3 +2.45861896154511150e-02
+#define GTE_C_SQRT_DEG3_MAX_ERROR +1.13096201164689103e-04
+#define GTE_C_SQRT_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG4_C1 +4.99559398329188165e-01
+#define GTE_C_SQRT_DEG4_C2 -1.20240661519430247e-01
+#define GTE_C_SQRT_DEG4_C3 +4.54615072576984858e-02
+#define GTE_C_SQRT_DEG4_C4 -1.05666816943621455e-02
+#define GTE_C_SQRT_DEG4_MAX_ERROR +1.27411701515561804e-05
+#define GTE_C_SQRT_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG5_C1 +4.99921976600319118e-01
+#define GTE_C_SQRT_DEG5_C2 -1.23785067192450526e-01
+#define GTE_C_SQRT_DEG5_C3 +5.61227769726997394e-02
+#define GTE_C_SQRT_DEG5_C4 -2.31288362811454817e-02
+#define GTE_C_SQRT_DEG5_C5 +5.08271227370471479e-03
+#define GTE_C_SQRT_DEG5_MAX_ERROR +1.57255689407082011e-06
+#define GTE_C_SQRT_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG6_C1 +4.99986166957849143e-01
+#define GTE_C_SQRT_DEG6_C2 -1.24707333232784379e-01
+#define GTE_C_SQRT_DEG6_C3 +6.03885873569822706e-02
+#define GTE_C_SQRT_DEG6_C4 -3.16920535518079305e-02
+#define GTE_C_SQRT_DEG6_C5 +1.28565903051480745e-02
+#define GTE_C_SQRT_DEG6_C6 -2.61839546243436416e-03
+#define GTE_C_SQRT_DEG6_MAX_ERROR +2.05841555356300887e-07
+#define GTE_C_SQRT_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG7_C1 +4.99997548178092277e-01
+#define GTE_C_SQRT_DEG7_C2 -1.24932434763536548e-01
+#define GTE_C_SQRT_DEG7_C3 +6.18599541463709102e-02
+#define GTE_C_SQRT_DEG7_C4 -3.60915950232083560e-02
+#define GTE_C_SQRT_DEG7_C5 +1.94839465234508680e-02
+#define GTE_C_SQRT_DEG7_C6 -7.51661345680076920e-03
+#define GTE_C_SQRT_DEG7_C7 +1.41275676878649392e-03
+#define GTE_C_SQRT_DEG7_MAX_ERROR +2.80723029197349483e-08
+#define GTE_C_SQRT_DEG8_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG8_C1 +4.99999565830567594e-01
+#define GTE_C_SQRT_DEG8_C2 -1.24984903699143501e-01
+#define GTE_C_SQRT_DEG8_C3 +6.23184946675792162e-02
+#define GTE_C_SQRT_DEG8_C4 -3.79829618964322435e-02
+#define GTE_C_SQRT_DEG8_C5 +2.36426123128694599e-02
+#define GTE_C_SQRT_DEG8_C6 -1.25293775872705737e-02
+#define GTE_C_SQRT_DEG8_C7 +4.53824269607139286e-03
+#define GTE_C_SQRT_DEG8_C8 -7.88109952736704145e-04
+#define GTE_C_SQRT_DEG8_MAX_ERROR +3.94606056858259890e-09
+
+void SqrtEstimateReduce(float x, out float adj, out float y, out float p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_SQRT_2 : 1.0);
+    p = half;
+}
+
+float SqrtEstimateCombine(float adj, float y, float p)
+{
+    return adj * ldexp(y, p);
+}
+
+void SqrtEstimateReduce(float2 x, out float2 adj, out float2 y, out float2 p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float2 half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_SQRT_2 : 1.0);
+    p = half;
+}
+
+float2 SqrtEstimateCombine(float2 adj, float2 y, float2 p)
+{
+    return adj * ldexp(y, p);
+}
+
+void SqrtEstimateReduce(float3 x, out float3 adj, out float3 y, out float3 p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float3 half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_SQRT_2 : 1.0);
+    p = half;
+}
+
+float3 SqrtEstimateCombine(float3 adj, float3 y, float3 p)
+{
+    return adj * ldexp(y, p);
+}
+
+void SqrtEstimateReduce(float4 x, out float4 adj, out float4 y, out float4 p)
+{
+    y = frexp(x, p);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float4 half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_SQRT_2 : 1.0);
+    p = half;
+}
+
+float4 SqrtEstimateCombine(float4 adj, float4 y, float4 p)
+{
+    return adj * ldexp(y, p);
+}
+
+float SqrtEstimateDegree1(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG1_C1;
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree1RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree1(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG1_C1;
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree1RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree1(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG1_C1;
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree1RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree1(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG1_C1;
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree1RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree2(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG2_C2;
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree2RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree2(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG2_C2;
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree2RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree2(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG2_C2;
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree2RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree2(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG2_C2;
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree2RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree3(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG3_C3;
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree3RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree3(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG3_C3;
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree3RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree3(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG3_C3;
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree3RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree3(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG3_C3;
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree3RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree4(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG4_C4;
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree4RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree4(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG4_C4;
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree4RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree4(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG4_C4;
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree4RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree4(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG4_C4;
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree4RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree5(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG5_C5;
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree5RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree5(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG5_C5;
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree5RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree5(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG5_C5;
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree5RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree5(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG5_C5;
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree5RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree6(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG6_C6;
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree6RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree6(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG6_C6;
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree6RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree6(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG6_C6;
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree6RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree6(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG6_C6;
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree6RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree7(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG7_C7;
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree7RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree7(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG7_C7;
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree7RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree7(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG7_C7;
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree7RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree7(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG7_C7;
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree7RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree8(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG8_C8;
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree8RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float2 SqrtEstimateDegree8(float2 x)
+{
+    float2 t = x - 1.0;
+    float2 poly;
+    poly = GTE_C_SQRT_DEG8_C8;
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float2 SqrtEstimateDegree8RR(float2 x)
+{
+    float2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float2 poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float3 SqrtEstimateDegree8(float3 x)
+{
+    float3 t = x - 1.0;
+    float3 poly;
+    poly = GTE_C_SQRT_DEG8_C8;
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float3 SqrtEstimateDegree8RR(float3 x)
+{
+    float3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float3 poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float4 SqrtEstimateDegree8(float4 x)
+{
+    float4 t = x - 1.0;
+    float4 poly;
+    poly = GTE_C_SQRT_DEG8_C8;
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float4 SqrtEstimateDegree8RR(float4 x)
+{
+    float4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float4 poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+#endif
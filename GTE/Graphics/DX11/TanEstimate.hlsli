@@ -0,0 +1,587 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to tan(x) for x in [-pi/4,pi/4].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/TanEstimate.h. Do not edit it.
+
+#ifndef GTE_TANESTIMATE_HLSLI
+#define GTE_TANESTIMATE_HLSLI
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_TAN_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG3_C1 +4.42959265447362860e-01
+#define GTE_C_TAN_DEG3_MAX_ERROR +1.16618922562047311e-02
+#define GTE_C_TAN_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG5_C1 +3.14013204035424209e-01
+#define GTE_C_TAN_DEG5_C2 +2.09039481092403445e-01
+#define GTE_C_TAN_DEG5_MAX_ERROR +5.84318543901431176e-04
+#define GTE_C_TAN_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG7_C1 +3.36072132844225546e-01
+#define GTE_C_TAN_DEG7_C2 +1.12610373051849066e-01
+#define GTE_C_TAN_DEG7_C3 +9.83520994705244789e-02
+#define GTE_C_TAN_DEG7_MAX_ERROR +3.54186883977231082e-05
+#define GTE_C_TAN_DEG9_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG9_C1 +3.32992328439417840e-01
+#define GTE_C_TAN_DEG9_C2 +1.37478434324748378e-01
+#define GTE_C_TAN_DEG9_C3 +3.76963448130283041e-02
+#define GTE_C_TAN_DEG9_C4 +4.60973772792812042e-02
+#define GTE_C_TAN_DEG9_MAX_ERROR +2.29881732421999274e-06
+#define GTE_C_TAN_DEG11_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG11_C1 +3.33372244562242237e-01
+#define GTE_C_TAN_DEG11_C2 +1.32645160538245932e-01
+#define GTE_C_TAN_DEG11_C3 +5.81452376459310472e-02
+#define GTE_C_TAN_DEG11_C4 +1.07321932375725737e-02
+#define GTE_C_TAN_DEG11_C5 +2.15584567935138693e-02
+#define GTE_C_TAN_DEG11_MAX_ERROR +1.54262579401404087e-07
+#define GTE_C_TAN_DEG13_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG13_C1 +3.33329164263945543e-01
+#define GTE_C_TAN_DEG13_C2 +1.33434046251124983e-01
+#define GTE_C_TAN_DEG13_C3 +5.31045653431192477e-02
+#define GTE_C_TAN_DEG13_C4 +2.53550383126821544e-02
+#define GTE_C_TAN_DEG13_C5 +1.82532559665560257e-03
+#define GTE_C_TAN_DEG13_C6 +1.00694071766156412e-02
+#define GTE_C_TAN_DEG13_MAX_ERROR +1.05502642490373777e-08
+
+float TanEstimateReduce(float x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    float y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return ((y > GTE_C_HALF_PI) ? y - GTE_C_PI : ((y < -GTE_C_HALF_PI) ? y + GTE_C_PI : y));
+}
+
+float2 TanEstimateReduce(float2 x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    float2 y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return ((y > GTE_C_HALF_PI) ? y - GTE_C_PI : ((y < -GTE_C_HALF_PI) ? y + GTE_C_PI : y));
+}
+
+float3 TanEstimateReduce(float3 x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    float3 y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return ((y > GTE_C_HALF_PI) ? y - GTE_C_PI : ((y < -GTE_C_HALF_PI) ? y + GTE_C_PI : y));
+}
+
+float4 TanEstimateReduce(float4 x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    float4 y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return ((y > GTE_C_HALF_PI) ? y - GTE_C_PI : ((y < -GTE_C_HALF_PI) ? y + GTE_C_PI : y));
+}
+
+float TanEstimateDegree3(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG3_C1;
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree3RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree3(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float2 TanEstimateDegree3(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_TAN_DEG3_C1;
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 TanEstimateDegree3RR(float2 x)
+{
+    float2 y = TanEstimateReduce(x);
+    float2 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float2 poly = TanEstimateDegree3(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float3 TanEstimateDegree3(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_TAN_DEG3_C1;
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 TanEstimateDegree3RR(float3 x)
+{
+    float3 y = TanEstimateReduce(x);
+    float3 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float3 poly = TanEstimateDegree3(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float4 TanEstimateDegree3(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_TAN_DEG3_C1;
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 TanEstimateDegree3RR(float4 x)
+{
+    float4 y = TanEstimateReduce(x);
+    float4 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float4 poly = TanEstimateDegree3(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float TanEstimateDegree5(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG5_C2;
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree5RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree5(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float2 TanEstimateDegree5(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_TAN_DEG5_C2;
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 TanEstimateDegree5RR(float2 x)
+{
+    float2 y = TanEstimateReduce(x);
+    float2 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float2 poly = TanEstimateDegree5(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float3 TanEstimateDegree5(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_TAN_DEG5_C2;
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 TanEstimateDegree5RR(float3 x)
+{
+    float3 y = TanEstimateReduce(x);
+    float3 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float3 poly = TanEstimateDegree5(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float4 TanEstimateDegree5(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_TAN_DEG5_C2;
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 TanEstimateDegree5RR(float4 x)
+{
+    float4 y = TanEstimateReduce(x);
+    float4 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float4 poly = TanEstimateDegree5(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float TanEstimateDegree7(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG7_C3;
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree7RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree7(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float2 TanEstimateDegree7(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_TAN_DEG7_C3;
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 TanEstimateDegree7RR(float2 x)
+{
+    float2 y = TanEstimateReduce(x);
+    float2 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float2 poly = TanEstimateDegree7(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float3 TanEstimateDegree7(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_TAN_DEG7_C3;
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 TanEstimateDegree7RR(float3 x)
+{
+    float3 y = TanEstimateReduce(x);
+    float3 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float3 poly = TanEstimateDegree7(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float4 TanEstimateDegree7(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_TAN_DEG7_C3;
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 TanEstimateDegree7RR(float4 x)
+{
+    float4 y = TanEstimateReduce(x);
+    float4 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float4 poly = TanEstimateDegree7(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float TanEstimateDegree9(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG9_C4;
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree9RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree9(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float2 TanEstimateDegree9(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_TAN_DEG9_C4;
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 TanEstimateDegree9RR(float2 x)
+{
+    float2 y = TanEstimateReduce(x);
+    float2 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float2 poly = TanEstimateDegree9(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float3 TanEstimateDegree9(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_TAN_DEG9_C4;
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 TanEstimateDegree9RR(float3 x)
+{
+    float3 y = TanEstimateReduce(x);
+    float3 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float3 poly = TanEstimateDegree9(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float4 TanEstimateDegree9(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_TAN_DEG9_C4;
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 TanEstimateDegree9RR(float4 x)
+{
+    float4 y = TanEstimateReduce(x);
+    float4 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float4 poly = TanEstimateDegree9(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float TanEstimateDegree11(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG11_C5;
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree11RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree11(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float2 TanEstimateDegree11(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_TAN_DEG11_C5;
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 TanEstimateDegree11RR(float2 x)
+{
+    float2 y = TanEstimateReduce(x);
+    float2 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float2 poly = TanEstimateDegree11(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float3 TanEstimateDegree11(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_TAN_DEG11_C5;
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 TanEstimateDegree11RR(float3 x)
+{
+    float3 y = TanEstimateReduce(x);
+    float3 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float3 poly = TanEstimateDegree11(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float4 TanEstimateDegree11(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_TAN_DEG11_C5;
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 TanEstimateDegree11RR(float4 x)
+{
+    float4 y = TanEstimateReduce(x);
+    float4 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float4 poly = TanEstimateDegree11(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float TanEstimateDegree13(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG13_C6;
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree13RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree13(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float2 TanEstimateDegree13(float2 x)
+{
+    float2 xsqr = x * x;
+    float2 poly;
+    poly = GTE_C_TAN_DEG13_C6;
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float2 TanEstimateDegree13RR(float2 x)
+{
+    float2 y = TanEstimateReduce(x);
+    float2 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float2 poly = TanEstimateDegree13(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float3 TanEstimateDegree13(float3 x)
+{
+    float3 xsqr = x * x;
+    float3 poly;
+    poly = GTE_C_TAN_DEG13_C6;
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float3 TanEstimateDegree13RR(float3 x)
+{
+    float3 y = TanEstimateReduce(x);
+    float3 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float3 poly = TanEstimateDegree13(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+float4 TanEstimateDegree13(float4 x)
+{
+    float4 xsqr = x * x;
+    float4 poly;
+    poly = GTE_C_TAN_DEG13_C6;
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float4 TanEstimateDegree13RR(float4 x)
+{
+    float4 y = TanEstimateReduce(x);
+    float4 z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float4 poly = TanEstimateDegree13(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+#endif
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.12.23
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -186,6 +186,11 @@ namespace gte
         // The struct has a depth format.
         static bool IsDepth(DFType type);
 
+        // The struct is a 4x4 block of texels of a block-compressed format
+        // (BC1 through BC7), so GetNumBytesPerStruct is the number of bytes
+        // per block, 8 for BC1 and BC4 and 16 for the others.
+        static bool IsCompressed(DFType type);
+
     private:
         // Texel information.
         static std::string const msName[DF_NUM_FORMATS];
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/DirectionalLightEffect.h>
@@ -74,10 +74,20 @@ std::string const DirectionalLightEffect::msGLSLVSSource[2] =
 {
     LightEffect::GetGLSLLitFunction() +
     R"(
+    #if GTE_USE_PVW_BATCH
+        uniform PVWMatrix
+        {
+            uvec4 pvwIndex;
+        };
+
+        buffer pvwMatrices { mat4 data[]; } pvwMatricesSB;
+    #define pvwMatrix pvwMatricesSB.data[pvwIndex.x]
+    #else
         uniform PVWMatrix
         {
             mat4 pvwMatrix;
         };
+    #endif
     
         uniform Material
         {
@@ -103,14 +113,33 @@ std::string const DirectionalLightEffect::msGLSLVSSource[2] =
     
         layout(location = 0) in vec3 modelPosition;
         layout(location = 1) in vec3 modelNormal;
+    #if GTE_USE_INSTANCING
+        layout(location = 2) in vec4 instanceRow0;
+        layout(location = 3) in vec4 instanceRow1;
+        layout(location = 4) in vec4 instanceRow2;
+    #endif
         layout(location = 0) out vec4 vertexColor;
     
         void main()
         {
-            float NDotL = -dot(modelNormal, lightModelDirection.xyz);
-            vec3 viewVector = normalize(cameraModelPosition.xyz - modelPosition);
+        #if GTE_USE_INSTANCING
+            vec3 position = vec3(
+                dot(instanceRow0, vec4(modelPosition, 1.0f)),
+                dot(instanceRow1, vec4(modelPosition, 1.0f)),
+                dot(instanceRow2, vec4(modelPosition, 1.0f)));
+            vec3 normal = normalize(vec3(
+                dot(instanceRow0.xyz, modelNormal),
+                dot(instanceRow1.xyz, modelNormal),
+                dot(instanceRow2.xyz, modelNormal)));
+        #else
+            vec3 position = modelPosition;
+            vec3 normal = modelNormal;
+        #endif
+
+            float NDotL = -dot(normal, lightModelDirection.xyz);
+            vec3 viewVector = normalize(cameraModelPosition.xyz - position);
             vec3 halfVector = normalize(viewVector - lightModelDirection.xyz);
-            float NDotH = dot(modelNormal, halfVector);
+            float NDotH = dot(normal, halfVector);
             vec4 lighting = lit(NDotL, NDotH, materialSpecular.a);
     
             vec3 color = materialAmbient.rgb * lightingAmbient.rgb +
@@ -120,32 +149,61 @@ std::string const DirectionalLightEffect::msGLSLVSSource[2] =
             vertexColor.rgb = materialEmissive.rgb + lightingAttenuation.w * color;
             vertexColor.a = materialDiffuse.a;
         #if GTE_USE_MAT_VEC
-            gl_Position = pvwMatrix * vec4(modelPosition, 1.0f);
+            gl_Position = pvwMatrix * vec4(position, 1.0f);
         #else
-            gl_Position = vec4(modelPosition, 1.0f) * pvwMatrix;
+            gl_Position = vec4(position, 1.0f) * pvwMatrix;
         #endif
         }
     )"
     ,
     R"(
+    #if GTE_USE_PVW_BATCH
+        uniform PVWMatrix
+        {
+            uvec4 pvwIndex;
+        };
+
+        buffer pvwMatrices { mat4 data[]; } pvwMatricesSB;
+    #define pvwMatrix pvwMatricesSB.data[pvwIndex.x]
+    #else
         uniform PVWMatrix
         {
             mat4 pvwMatrix;
         };
+    #endif
     
         layout(location = 0) in vec3 modelPosition;
         layout(location = 1) in vec3 modelNormal;
+    #if GTE_USE_INSTANCING
+        layout(location = 2) in vec4 instanceRow0;
+        layout(location = 3) in vec4 instanceRow1;
+        layout(location = 4) in vec4 instanceRow2;
+    #endif
         layout(location = 0) out vec3 vertexPosition;
         layout(location = 1) out vec3 vertexNormal;
     
         void main()
         {
-            vertexPosition = modelPosition;
-            vertexNormal = modelNormal;
+        #if GTE_USE_INSTANCING
+            vec3 position = vec3(
+                dot(instanceRow0, vec4(modelPosition, 1.0f)),
+                dot(instanceRow1, vec4(modelPosition, 1.0f)),
+                dot(instanceRow2, vec4(modelPosition, 1.0f)));
+            vec3 normal = normalize(vec3(
+                dot(instanceRow0.xyz, modelNormal),
+                dot(instanceRow1.xyz, modelNormal),
+                dot(instanceRow2.xyz, modelNormal)));
+        #else
+            vec3 position = modelPosition;
+            vec3 normal = modelNormal;
+        #endif
+
+            vertexPosition = position;
+            vertexNormal = normal;
         #if GTE_USE_MAT_VEC
-            gl_Position = pvwMatrix * vec4(modelPosition, 1.0f);
+            gl_Position = pvwMatrix * vec4(position, 1.0f);
         #else
-            gl_Position = vec4(modelPosition, 1.0f) * pvwMatrix;
+            gl_Position = vec4(position, 1.0f) * pvwMatrix;
         #endif
         }
     )"
@@ -213,10 +271,20 @@ std::string const DirectionalLightEffect::msGLSLPSSource[2] =
 std::string const DirectionalLightEffect::msHLSLVSSource[2] =
 {
     R"(
+    #if GTE_USE_PVW_BATCH
+        cbuffer PVWMatrix
+        {
+            uint4 pvwIndex;
+        };
+
+        StructuredBuffer<float4x4> pvwMatrices;
+    #define pvwMatrix pvwMatrices[pvwIndex.x]
+    #else
         cbuffer PVWMatrix
         {
             float4x4 pvwMatrix;
         };
+    #endif
     
         cbuffer Material
         {
@@ -244,6 +312,11 @@ std::string const DirectionalLightEffect::msHLSLVSSource[2] =
         {
             float3 modelPosition : POSITION;
             float3 modelNormal : NORMAL;
+        #if GTE_USE_INSTANCING
+            float4 instanceRow0 : TEXCOORD5;
+            float4 instanceRow1 : TEXCOORD6;
+            float4 instanceRow2 : TEXCOORD7;
+        #endif
         };
     
         struct VS_OUTPUT
@@ -254,6 +327,17 @@ std::string const DirectionalLightEffect::msHLSLVSSource[2] =
     
         VS_OUTPUT VSMain(VS_INPUT input)
         {
+        #if GTE_USE_INSTANCING
+            input.modelPosition = float3(
+                dot(input.instanceRow0, float4(input.modelPosition, 1.0f)),
+                dot(input.instanceRow1, float4(input.modelPosition, 1.0f)),
+                dot(input.instanceRow2, float4(input.modelPosition, 1.0f)));
+            input.modelNormal = normalize(float3(
+                dot(input.instanceRow0.xyz, input.modelNormal),
+                dot(input.instanceRow1.xyz, input.modelNormal),
+                dot(input.instanceRow2.xyz, input.modelNormal)));
+        #endif
+
             VS_OUTPUT output;
     
             float NDotL = -dot(input.modelNormal, lightModelDirection.xyz);
@@ -278,15 +362,30 @@ std::string const DirectionalLightEffect::msHLSLVSSource[2] =
     )"
     ,
     R"(
+    #if GTE_USE_PVW_BATCH
+        cbuffer PVWMatrix
+        {
+            uint4 pvwIndex;
+        };
+
+        StructuredBuffer<float4x4> pvwMatrices;
+    #define pvwMatrix pvwMatrices[pvwIndex.x]
+    #else
         cbuffer PVWMatrix
         {
             float4x4 pvwMatrix;
         };
+    #endif
 
         struct VS_INPUT
         {
             float3 modelPosition : POSITION;
             float3 modelNormal : NORMAL;
+        #if GTE_USE_INSTANCING
+            float4 instanceRow0 : TEXCOORD5;
+            float4 instanceRow1 : TEXCOORD6;
+            float4 instanceRow2 : TEXCOORD7;
+        #endif
         };
 
         struct VS_OUTPUT
@@ -298,6 +397,17 @@ std::string const DirectionalLightEffect::msHLSLVSSource[2] =
 
         VS_OUTPUT VSMain(VS_INPUT input)
         {
+        #if GTE_USE_INSTANCING
+            input.modelPosition = float3(
+                dot(input.instanceRow0, float4(input.modelPosition, 1.0f)),
+                dot(input.instanceRow1, float4(input.modelPosition, 1.0f)),
+                dot(input.instanceRow2, float4(input.modelPosition, 1.0f)));
+            input.modelNormal = normalize(float3(
+                dot(input.instanceRow0.xyz, input.modelNormal),
+                dot(input.instanceRow1.xyz, input.modelNormal),
+                dot(input.instanceRow2.xyz, input.modelNormal)));
+        #endif
+
             VS_OUTPUT output;
 
             output.vertexPosition = input.modelPosition;
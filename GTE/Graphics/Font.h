@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.03.25
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -41,6 +41,18 @@ namespace gte
             return mIndexBuffer;
         }
 
+        inline std::shared_ptr<Texture2> const& GetTexture() const
+        {
+            return mTexture;
+        }
+
+        // The texture x-coordinates of the glyphs. Glyph c occupies the
+        // texture columns [data[c],data[c+1]).
+        inline float const* GetCharacterData() const
+        {
+            return mCharacterData;
+        }
+
         int GetHeight() const;
         int GetWidth(std::string const& message) const;
 
@@ -0,0 +1,300 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/FrameProfiler.h>
+#include <Mathematics/Logger.h>
+#include <iomanip>
+#include <sstream>
+using namespace gte;
+
+FrameProfiler::~FrameProfiler()
+{
+    for (auto const& slot : mSlots)
+    {
+        mEngine->DestroyTimestampSet(slot.set);
+    }
+}
+
+FrameProfiler::FrameProfiler(std::shared_ptr<GraphicsEngine> const& engine,
+    unsigned int maxScopes, unsigned int numFrames)
+    :
+    mEngine(engine),
+    mMaxScopes(maxScopes),
+    mFrame(0),
+    mInFrame(false),
+    mGpuFrame(false),
+    mSlot(nullptr),
+    mFrameBegin(0),
+    mNumGpuScopes(0)
+{
+    LogAssert(mEngine != nullptr && numFrames > 0, "Invalid input.");
+
+    // Timestamps 0 and 1 are the beginning and the end of the frame, and
+    // timestamps 2+2*i and 3+2*i are those of the GPU scope i.
+    mSlots.resize(numFrames);
+    for (auto& slot : mSlots)
+    {
+        slot.set = mEngine->CreateTimestampSet(2 + 2 * mMaxScopes);
+        slot.pending = false;
+        slot.frame = 0;
+        slot.numWritten = 0;
+        slot.cpuTime = 0;
+    }
+
+    mCpuSlot.set = 0;
+    mCpuSlot.pending = false;
+    mCpuSlot.frame = 0;
+    mCpuSlot.numWritten = 0;
+    mCpuSlot.cpuTime = 0;
+
+    mReport.frame = 0;
+    mReport.gpu = false;
+    mReport.cpuTime = 0.0;
+    mReport.gpuTime = 0.0;
+}
+
+void FrameProfiler::BeginFrame()
+{
+    LogAssert(!mInFrame, "EndFrame was not called.");
+
+    Collect();
+
+    ++mFrame;
+    mInFrame = true;
+    mNumGpuScopes = 0;
+    mOpen.clear();
+
+    // The GPU is not timed when the slot of the frame is still in use.
+    mSlot = &mSlots[static_cast<size_t>(mFrame % mSlots.size())];
+    mGpuFrame = !mSlot->pending;
+    if (!mGpuFrame)
+    {
+        mSlot = &mCpuSlot;
+    }
+    mSlot->frame = mFrame;
+    mSlot->numWritten = 0;
+    mSlot->entries.clear();
+    if (mGpuFrame)
+    {
+        mEngine->BeginTimestamps(mSlot->set);
+        mEngine->WriteTimestamp(mSlot->set, 0);
+    }
+    mFrameBegin = mTimer.GetNanoseconds();
+}
+
+void FrameProfiler::EndFrame()
+{
+    LogAssert(mInFrame, "BeginFrame was not called.");
+    LogAssert(mOpen.size() == 0, "A scope was not ended.");
+
+    Slot& slot = *mSlot;
+    slot.cpuTime = mTimer.GetNanoseconds() - mFrameBegin;
+    mInFrame = false;
+    if (mGpuFrame)
+    {
+        mEngine->WriteTimestamp(slot.set, 1);
+        mEngine->EndTimestamps(slot.set);
+        slot.numWritten = 2 + 2 * mNumGpuScopes;
+        slot.pending = true;
+    }
+    else
+    {
+        Finalize(slot, nullptr);
+    }
+}
+
+void FrameProfiler::BeginScope(std::string const& name)
+{
+    BeginEntry(name, true);
+}
+
+void FrameProfiler::EndScope()
+{
+    EndEntry(true);
+}
+
+void FrameProfiler::BeginCpuScope(std::string const& name)
+{
+    BeginEntry(name, false);
+}
+
+void FrameProfiler::EndCpuScope()
+{
+    EndEntry(false);
+}
+
+std::string FrameProfiler::ToJSON() const
+{
+    auto escape = [](std::string const& name)
+    {
+        std::string escaped;
+        for (auto c : name)
+        {
+            if (c == '"' || c == '\\')
+            {
+                escaped += '\\';
+                escaped += c;
+            }
+            else if (static_cast<unsigned char>(c) >= 0x20)
+            {
+                escaped += c;
+            }
+        }
+        return escaped;
+    };
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    auto event = [&stream](std::string const& name, int tid, double begin, double end)
+    {
+        stream << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"ts\":" << 1000.0 * begin
+            << ",\"dur\":" << 1000.0 * (end - begin) << ",\"pid\":1,\"tid\":" << tid << "}";
+    };
+
+    std::string const frame = "frame " + std::to_string(mReport.frame);
+    stream << "{\"traceEvents\":[";
+    event(frame, 1, 0.0, mReport.cpuTime);
+    if (mReport.gpu)
+    {
+        stream << ",";
+        event(frame, 2, 0.0, mReport.gpuTime);
+    }
+    for (auto const& scope : mReport.scopes)
+    {
+        std::string name = escape(scope.name);
+        stream << ",";
+        event(name, 1, scope.cpuBegin, scope.cpuEnd);
+        if (scope.gpu)
+        {
+            stream << ",";
+            event(name, 2, scope.gpuBegin, scope.gpuEnd);
+        }
+    }
+    stream << "],\"displayTimeUnit\":\"ms\"}";
+    return stream.str();
+}
+
+void FrameProfiler::DrawReport(int x, int y, std::array<float, 4> const& color,
+    int lineHeight) const
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2);
+    stream << "frame " << mReport.frame << ": cpu " << mReport.cpuTime << " ms";
+    if (mReport.gpu)
+    {
+        stream << ", gpu " << mReport.gpuTime << " ms";
+    }
+    mEngine->Draw(x, y, color, stream.str());
+
+    for (auto const& scope : mReport.scopes)
+    {
+        y += lineHeight;
+        stream.str("");
+        stream << std::string(2 * scope.depth + 2, ' ') << scope.name
+            << ": cpu " << scope.cpuEnd - scope.cpuBegin << " ms";
+        if (scope.gpu)
+        {
+            stream << ", gpu " << scope.gpuEnd - scope.gpuBegin << " ms";
+        }
+        mEngine->Draw(x, y, color, stream.str());
+    }
+}
+
+void FrameProfiler::BeginEntry(std::string const& name, bool gpu)
+{
+    LogAssert(mInFrame, "Scopes must be inside a frame.");
+
+    Slot& slot = *mSlot;
+    Entry entry;
+    entry.name = name;
+    entry.depth = static_cast<unsigned int>(mOpen.size());
+    entry.gpu = gpu;
+    entry.gpuIndex = -1;
+    if (gpu && mGpuFrame && mNumGpuScopes < mMaxScopes)
+    {
+        entry.gpuIndex = static_cast<int>(mNumGpuScopes++);
+        mEngine->WriteTimestamp(slot.set, 2 + 2 * entry.gpuIndex);
+    }
+    entry.cpuBegin = mTimer.GetNanoseconds() - mFrameBegin;
+    entry.cpuEnd = entry.cpuBegin;
+    mOpen.push_back(slot.entries.size());
+    slot.entries.push_back(entry);
+}
+
+void FrameProfiler::EndEntry(bool gpu)
+{
+    LogAssert(mOpen.size() > 0, "There is no scope to end.");
+
+    Slot& slot = *mSlot;
+    Entry& entry = slot.entries[mOpen.back()];
+    LogAssert(entry.gpu == gpu, "The scope was begun with the other type.");
+    mOpen.pop_back();
+    entry.cpuEnd = mTimer.GetNanoseconds() - mFrameBegin;
+    if (entry.gpuIndex >= 0)
+    {
+        mEngine->WriteTimestamp(slot.set, 3 + 2 * entry.gpuIndex);
+    }
+}
+
+void FrameProfiler::Collect()
+{
+    // The slots are visited from the oldest frame so that the report is that
+    // of the most recent complete frame.
+    std::vector<uint64_t> nanoseconds;
+    for (size_t i = 1; i <= mSlots.size(); ++i)
+    {
+        Slot& slot = mSlots[static_cast<size_t>((mFrame + i) % mSlots.size())];
+        if (slot.pending && mEngine->GetTimestamps(slot.set, slot.numWritten, nanoseconds))
+        {
+            slot.pending = false;
+            Finalize(slot, &nanoseconds);
+        }
+    }
+}
+
+void FrameProfiler::Finalize(Slot const& slot, std::vector<uint64_t> const* nanoseconds)
+{
+    if (slot.frame < mReport.frame)
+    {
+        return;
+    }
+
+    // The GPU results are empty when they are not reliable, for example
+    // when the clock frequency of the GPU changed during the frame.
+    bool gpu = (nanoseconds != nullptr && nanoseconds->size() == slot.numWritten);
+    auto ms = [](int64_t ns)
+    {
+        return static_cast<double>(ns) * 1.0e-6;
+    };
+
+    mReport.frame = slot.frame;
+    mReport.gpu = gpu;
+    mReport.cpuTime = ms(slot.cpuTime);
+    mReport.gpuTime = (gpu ? ms((*nanoseconds)[1]) : 0.0);
+    mReport.scopes.resize(slot.entries.size());
+    for (size_t i = 0; i < slot.entries.size(); ++i)
+    {
+        Entry const& entry = slot.entries[i];
+        ScopeTime& scope = mReport.scopes[i];
+        scope.name = entry.name;
+        scope.depth = entry.depth;
+        scope.gpu = (gpu && entry.gpuIndex >= 0);
+        scope.cpuBegin = ms(entry.cpuBegin);
+        scope.cpuEnd = ms(entry.cpuEnd);
+        if (scope.gpu)
+        {
+            scope.gpuBegin = ms((*nanoseconds)[2 + 2 * entry.gpuIndex]);
+            scope.gpuEnd = ms((*nanoseconds)[3 + 2 * entry.gpuIndex]);
+        }
+        else
+        {
+            scope.gpuBegin = 0.0;
+            scope.gpuEnd = 0.0;
+        }
+    }
+}
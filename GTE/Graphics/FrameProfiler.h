@@ -0,0 +1,176 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Mathematics/Timer.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Profiling of the frames of an application with named scopes timed on the
+// CPU and on the GPU. The GPU times are measured with timestamp queries that
+// are written into a ring of timestamp sets, one per frame, and read when
+// their results are available several frames later, so the CPU never waits
+// for the GPU. When the set of a frame is still pending because the GPU lags
+// by more than the number of frames of the ring, the frame is profiled only
+// on the CPU. The report of a frame is therefore available once its GPU
+// results arrive; GetReport returns the most recent complete report.
+//
+// The scopes nest. BeginScope/EndScope time a scope on the CPU and on the
+// GPU, and BeginCpuScope/EndCpuScope time it only on the CPU, for example
+// the culling or the update of a scene. At most maxScopes scopes per frame
+// are timed on the GPU; the others are timed only on the CPU.
+//
+//   profiler.BeginFrame();
+//   {
+//       FrameProfiler::Scope scope(profiler, "scene");
+//       engine->Draw(visual);
+//   }
+//   profiler.EndFrame();
+//   profiler.DrawReport(8, 24, { 1.0f, 1.0f, 1.0f, 1.0f });
+
+namespace gte
+{
+    class FrameProfiler
+    {
+    public:
+        // The times are in milliseconds relative to the beginning of the
+        // frame. The GPU times are valid only when 'gpu' is 'true'.
+        struct ScopeTime
+        {
+            std::string name;
+            unsigned int depth;
+            bool gpu;
+            double cpuBegin, cpuEnd, gpuBegin, gpuEnd;
+        };
+
+        struct Report
+        {
+            uint64_t frame;
+            bool gpu;
+            double cpuTime, gpuTime;
+            std::vector<ScopeTime> scopes;
+        };
+
+        // Construction and destruction.
+        ~FrameProfiler();
+        FrameProfiler(std::shared_ptr<GraphicsEngine> const& engine,
+            unsigned int maxScopes = 64, unsigned int numFrames = 4);
+
+        // Bracket the commands of a frame, including the Scope objects.
+        void BeginFrame();
+        void EndFrame();
+
+        // Time a scope on the CPU and on the GPU.
+        void BeginScope(std::string const& name);
+        void EndScope();
+
+        // Time a scope only on the CPU.
+        void BeginCpuScope(std::string const& name);
+        void EndCpuScope();
+
+        // A scope that ends when the object is destroyed.
+        class Scope
+        {
+        public:
+            Scope(FrameProfiler& profiler, std::string const& name, bool gpu = true)
+                :
+                mProfiler(profiler),
+                mGpu(gpu)
+            {
+                if (mGpu)
+                {
+                    mProfiler.BeginScope(name);
+                }
+                else
+                {
+                    mProfiler.BeginCpuScope(name);
+                }
+            }
+
+            ~Scope()
+            {
+                if (mGpu)
+                {
+                    mProfiler.EndScope();
+                }
+                else
+                {
+                    mProfiler.EndCpuScope();
+                }
+            }
+
+        private:
+            FrameProfiler& mProfiler;
+            bool mGpu;
+        };
+
+        // The most recent complete report. Before the first report is
+        // complete, the frame number is 0 and there are no scopes.
+        inline Report const& GetReport() const
+        {
+            return mReport;
+        }
+
+        // The report in the Chrome trace event format, which is loaded by
+        // chrome://tracing and by Perfetto. The CPU scopes are on thread 1
+        // and the GPU scopes are on thread 2, with the times in microseconds.
+        std::string ToJSON() const;
+
+        // Draw the report as lines of text, one per scope indented by its
+        // depth, with the text drawing of the engine.
+        void DrawReport(int x, int y, std::array<float, 4> const& color,
+            int lineHeight = 18) const;
+
+    private:
+        struct Entry
+        {
+            std::string name;
+            unsigned int depth;
+            bool gpu;
+            int gpuIndex;
+            int64_t cpuBegin, cpuEnd;
+        };
+
+        struct Slot
+        {
+            unsigned int set;
+            bool pending;
+            uint64_t frame;
+            unsigned int numWritten;
+            int64_t cpuTime;
+            std::vector<Entry> entries;
+        };
+
+        void BeginEntry(std::string const& name, bool gpu);
+        void EndEntry(bool gpu);
+
+        // Collect the GPU results of the pending slots that are available.
+        void Collect();
+        void Finalize(Slot const& slot, std::vector<uint64_t> const* nanoseconds);
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        unsigned int mMaxScopes;
+        std::vector<Slot> mSlots;
+        Timer mTimer;
+
+        // The state of the current frame. The slot of a frame that is not
+        // timed on the GPU is mCpuSlot.
+        uint64_t mFrame;
+        bool mInFrame, mGpuFrame;
+        Slot mCpuSlot;
+        Slot* mSlot;
+        int64_t mFrameBegin;
+        unsigned int mNumGpuScopes;
+        std::vector<size_t> mOpen;
+
+        Report mReport;
+    };
+}
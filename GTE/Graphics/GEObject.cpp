@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/GEObject.h>
@@ -11,11 +11,15 @@ using namespace gte;
 
 GEObject::~GEObject()
 {
+    mGTObject->ClearGEObject(this);
 }
 
 GEObject::GEObject(GraphicsObject const* gtObject)
     :
     mGTObject(const_cast<GraphicsObject*>(gtObject)),  // conceptual constness
-    mName("")
+    mName(""),
+    mResidentBytes(0),
+    mLastUse(0),
+    mEngine(nullptr)
 {
 }
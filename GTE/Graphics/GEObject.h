@@ -3,14 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/GraphicsObject.h>
+#include <cstdint>
 
 namespace gte
 {
+    class GraphicsEngine;
+
     class GEObject
     {
     public:
@@ -34,8 +37,47 @@ namespace gte
             return mName;
         }
 
+        // Support for the memory budget of GraphicsEngine. The resident
+        // bytes are those of the resource when the object was created, 0
+        // for objects that are not buffers or textures. The last use is the
+        // frame of the last GraphicsEngine::Bind call for the object.
+        inline void SetResidentBytes(uint64_t numBytes)
+        {
+            mResidentBytes = numBytes;
+        }
+
+        inline uint64_t GetResidentBytes() const
+        {
+            return mResidentBytes;
+        }
+
+        inline void SetLastUse(uint64_t frame)
+        {
+            mLastUse = frame;
+        }
+
+        inline uint64_t GetLastUse() const
+        {
+            return mLastUse;
+        }
+
+        // The engine whose Bind created the object, or null when the
+        // object was inserted into the bridge map of the engine directly.
+        inline void SetEngine(GraphicsEngine const* engine)
+        {
+            mEngine = engine;
+        }
+
+        inline GraphicsEngine const* GetEngine() const
+        {
+            return mEngine;
+        }
+
     protected:
         GraphicsObject* mGTObject;
         std::string mName;
+        uint64_t mResidentBytes;
+        uint64_t mLastUse;
+        GraphicsEngine const* mEngine;
     };
 }
@@ -0,0 +1,185 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Approximations to asin(x) = pi/2 - acos(x) for x in [0,1].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/ASinEstimate.h. Do not edit it.
+
+#ifndef GTE_ASINESTIMATE_GLSL
+#define GTE_ASINESTIMATE_GLSL
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+float ASinEstimateDegree1(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree1(x);
+}
+
+vec2 ASinEstimateDegree1(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree1(x);
+}
+
+vec3 ASinEstimateDegree1(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree1(x);
+}
+
+vec4 ASinEstimateDegree1(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree1(x);
+}
+
+float ASinEstimateDegree2(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree2(x);
+}
+
+vec2 ASinEstimateDegree2(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree2(x);
+}
+
+vec3 ASinEstimateDegree2(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree2(x);
+}
+
+vec4 ASinEstimateDegree2(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree2(x);
+}
+
+float ASinEstimateDegree3(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree3(x);
+}
+
+vec2 ASinEstimateDegree3(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree3(x);
+}
+
+vec3 ASinEstimateDegree3(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree3(x);
+}
+
+vec4 ASinEstimateDegree3(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree3(x);
+}
+
+float ASinEstimateDegree4(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree4(x);
+}
+
+vec2 ASinEstimateDegree4(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree4(x);
+}
+
+vec3 ASinEstimateDegree4(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree4(x);
+}
+
+vec4 ASinEstimateDegree4(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree4(x);
+}
+
+float ASinEstimateDegree5(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree5(x);
+}
+
+vec2 ASinEstimateDegree5(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree5(x);
+}
+
+vec3 ASinEstimateDegree5(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree5(x);
+}
+
+vec4 ASinEstimateDegree5(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree5(x);
+}
+
+float ASinEstimateDegree6(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree6(x);
+}
+
+vec2 ASinEstimateDegree6(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree6(x);
+}
+
+vec3 ASinEstimateDegree6(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree6(x);
+}
+
+vec4 ASinEstimateDegree6(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree6(x);
+}
+
+float ASinEstimateDegree7(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree7(x);
+}
+
+vec2 ASinEstimateDegree7(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree7(x);
+}
+
+vec3 ASinEstimateDegree7(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree7(x);
+}
+
+vec4 ASinEstimateDegree7(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree7(x);
+}
+
+float ASinEstimateDegree8(float x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree8(x);
+}
+
+vec2 ASinEstimateDegree8(vec2 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree8(x);
+}
+
+vec3 ASinEstimateDegree8(vec3 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree8(x);
+}
+
+vec4 ASinEstimateDegree8(vec4 x)
+{
+    return GTE_C_HALF_PI - ACosEstimateDegree8(x);
+}
+
+#endif
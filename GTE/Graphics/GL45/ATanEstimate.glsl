@@ -0,0 +1,503 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to atan(x) for x in [-1,1].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/ATanEstimate.h. Do not edit it.
+
+#ifndef GTE_ATANESTIMATE_GLSL
+#define GTE_ATANESTIMATE_GLSL
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_ATAN_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_ATAN_DEG3_C1 -2.14601836602551721e-01
+#define GTE_C_ATAN_DEG3_MAX_ERROR +1.59703263926142397e-02
+#define GTE_C_ATAN_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_ATAN_DEG5_C1 -3.01894783121449461e-01
+#define GTE_C_ATAN_DEG5_C2 +8.72929465188977405e-02
+#define GTE_C_ATAN_DEG5_MAX_ERROR +1.35098322473726357e-03
+#define GTE_C_ATAN_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_ATAN_DEG7_C1 -3.25701575993565307e-01
+#define GTE_C_ATAN_DEG7_C2 +1.53429948842066732e-01
+#define GTE_C_ATAN_DEG7_C3 -4.23302094510535909e-02
+#define GTE_C_ATAN_DEG7_MAX_ERROR +1.50512272155144122e-04
+#define GTE_C_ATAN_DEG9_C0 +1.00000000000000000e+00
+#define GTE_C_ATAN_DEG9_C1 -3.31578782364395863e-01
+#define GTE_C_ATAN_DEG9_C2 +1.83830347380180115e-01
+#define GTE_C_ATAN_DEG9_C3 -8.92530375872446768e-02
+#define GTE_C_ATAN_DEG9_C4 +2.23996359689095925e-02
+#define GTE_C_ATAN_DEG9_MAX_ERROR +1.89215986245820644e-05
+#define GTE_C_ATAN_DEG11_C0 +1.00000000000000000e+00
+#define GTE_C_ATAN_DEG11_C1 -3.32945276853740868e-01
+#define GTE_C_ATAN_DEG11_C2 +1.94986571653835483e-01
+#define GTE_C_ATAN_DEG11_C3 -1.19215762704754979e-01
+#define GTE_C_ATAN_DEG11_C4 +5.50633513669680497e-02
+#define GTE_C_ATAN_DEG11_C5 -1.24907200648678440e-02
+#define GTE_C_ATAN_DEG11_MAX_ERROR +2.54777249741877654e-06
+#define GTE_C_ATAN_DEG13_C0 +1.00000000000000000e+00
+#define GTE_C_ATAN_DEG13_C1 -3.33249985792021697e-01
+#define GTE_C_ATAN_DEG13_C2 +1.98565635057171619e-01
+#define GTE_C_ATAN_DEG13_C3 -1.33746573254512668e-01
+#define GTE_C_ATAN_DEG13_C4 +8.16758828599404296e-02
+#define GTE_C_ATAN_DEG13_C5 -3.50596808364116441e-02
+#define GTE_C_ATAN_DEG13_C6 +7.21288536334441233e-03
+#define GTE_C_ATAN_DEG13_MAX_ERROR +3.58591046918654843e-07
+
+float ATanEstimateDegree3(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_ATAN_DEG3_C1;
+    poly = GTE_C_ATAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float ATanEstimateDegree3RR(float x)
+{
+    float poly = ATanEstimateDegree3(((abs(x) <= 1.0) ? x : 1.0 / x));
+    return ((abs(x) <= 1.0) ? poly : ((x > 0.0) ? GTE_C_HALF_PI - poly : -GTE_C_HALF_PI - poly));
+}
+
+vec2 ATanEstimateDegree3(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_ATAN_DEG3_C1);
+    poly = GTE_C_ATAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 ATanEstimateDegree3RR(vec2 x)
+{
+    vec2 poly = ATanEstimateDegree3(mix(1.0 / x, x, lessThanEqual(abs(x), vec2(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec2(0.0))), poly, lessThanEqual(abs(x), vec2(1.0)));
+}
+
+vec3 ATanEstimateDegree3(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_ATAN_DEG3_C1);
+    poly = GTE_C_ATAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 ATanEstimateDegree3RR(vec3 x)
+{
+    vec3 poly = ATanEstimateDegree3(mix(1.0 / x, x, lessThanEqual(abs(x), vec3(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec3(0.0))), poly, lessThanEqual(abs(x), vec3(1.0)));
+}
+
+vec4 ATanEstimateDegree3(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_ATAN_DEG3_C1);
+    poly = GTE_C_ATAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 ATanEstimateDegree3RR(vec4 x)
+{
+    vec4 poly = ATanEstimateDegree3(mix(1.0 / x, x, lessThanEqual(abs(x), vec4(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec4(0.0))), poly, lessThanEqual(abs(x), vec4(1.0)));
+}
+
+float ATanEstimateDegree5(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_ATAN_DEG5_C2;
+    poly = GTE_C_ATAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float ATanEstimateDegree5RR(float x)
+{
+    float poly = ATanEstimateDegree5(((abs(x) <= 1.0) ? x : 1.0 / x));
+    return ((abs(x) <= 1.0) ? poly : ((x > 0.0) ? GTE_C_HALF_PI - poly : -GTE_C_HALF_PI - poly));
+}
+
+vec2 ATanEstimateDegree5(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_ATAN_DEG5_C2);
+    poly = GTE_C_ATAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 ATanEstimateDegree5RR(vec2 x)
+{
+    vec2 poly = ATanEstimateDegree5(mix(1.0 / x, x, lessThanEqual(abs(x), vec2(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec2(0.0))), poly, lessThanEqual(abs(x), vec2(1.0)));
+}
+
+vec3 ATanEstimateDegree5(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_ATAN_DEG5_C2);
+    poly = GTE_C_ATAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 ATanEstimateDegree5RR(vec3 x)
+{
+    vec3 poly = ATanEstimateDegree5(mix(1.0 / x, x, lessThanEqual(abs(x), vec3(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec3(0.0))), poly, lessThanEqual(abs(x), vec3(1.0)));
+}
+
+vec4 ATanEstimateDegree5(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_ATAN_DEG5_C2);
+    poly = GTE_C_ATAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 ATanEstimateDegree5RR(vec4 x)
+{
+    vec4 poly = ATanEstimateDegree5(mix(1.0 / x, x, lessThanEqual(abs(x), vec4(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec4(0.0))), poly, lessThanEqual(abs(x), vec4(1.0)));
+}
+
+float ATanEstimateDegree7(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_ATAN_DEG7_C3;
+    poly = GTE_C_ATAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float ATanEstimateDegree7RR(float x)
+{
+    float poly = ATanEstimateDegree7(((abs(x) <= 1.0) ? x : 1.0 / x));
+    return ((abs(x) <= 1.0) ? poly : ((x > 0.0) ? GTE_C_HALF_PI - poly : -GTE_C_HALF_PI - poly));
+}
+
+vec2 ATanEstimateDegree7(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_ATAN_DEG7_C3);
+    poly = GTE_C_ATAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 ATanEstimateDegree7RR(vec2 x)
+{
+    vec2 poly = ATanEstimateDegree7(mix(1.0 / x, x, lessThanEqual(abs(x), vec2(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec2(0.0))), poly, lessThanEqual(abs(x), vec2(1.0)));
+}
+
+vec3 ATanEstimateDegree7(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_ATAN_DEG7_C3);
+    poly = GTE_C_ATAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 ATanEstimateDegree7RR(vec3 x)
+{
+    vec3 poly = ATanEstimateDegree7(mix(1.0 / x, x, lessThanEqual(abs(x), vec3(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec3(0.0))), poly, lessThanEqual(abs(x), vec3(1.0)));
+}
+
+vec4 ATanEstimateDegree7(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_ATAN_DEG7_C3);
+    poly = GTE_C_ATAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 ATanEstimateDegree7RR(vec4 x)
+{
+    vec4 poly = ATanEstimateDegree7(mix(1.0 / x, x, lessThanEqual(abs(x), vec4(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec4(0.0))), poly, lessThanEqual(abs(x), vec4(1.0)));
+}
+
+float ATanEstimateDegree9(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_ATAN_DEG9_C4;
+    poly = GTE_C_ATAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float ATanEstimateDegree9RR(float x)
+{
+    float poly = ATanEstimateDegree9(((abs(x) <= 1.0) ? x : 1.0 / x));
+    return ((abs(x) <= 1.0) ? poly : ((x > 0.0) ? GTE_C_HALF_PI - poly : -GTE_C_HALF_PI - poly));
+}
+
+vec2 ATanEstimateDegree9(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_ATAN_DEG9_C4);
+    poly = GTE_C_ATAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 ATanEstimateDegree9RR(vec2 x)
+{
+    vec2 poly = ATanEstimateDegree9(mix(1.0 / x, x, lessThanEqual(abs(x), vec2(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec2(0.0))), poly, lessThanEqual(abs(x), vec2(1.0)));
+}
+
+vec3 ATanEstimateDegree9(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_ATAN_DEG9_C4);
+    poly = GTE_C_ATAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 ATanEstimateDegree9RR(vec3 x)
+{
+    vec3 poly = ATanEstimateDegree9(mix(1.0 / x, x, lessThanEqual(abs(x), vec3(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec3(0.0))), poly, lessThanEqual(abs(x), vec3(1.0)));
+}
+
+vec4 ATanEstimateDegree9(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_ATAN_DEG9_C4);
+    poly = GTE_C_ATAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 ATanEstimateDegree9RR(vec4 x)
+{
+    vec4 poly = ATanEstimateDegree9(mix(1.0 / x, x, lessThanEqual(abs(x), vec4(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec4(0.0))), poly, lessThanEqual(abs(x), vec4(1.0)));
+}
+
+float ATanEstimateDegree11(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_ATAN_DEG11_C5;
+    poly = GTE_C_ATAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float ATanEstimateDegree11RR(float x)
+{
+    float poly = ATanEstimateDegree11(((abs(x) <= 1.0) ? x : 1.0 / x));
+    return ((abs(x) <= 1.0) ? poly : ((x > 0.0) ? GTE_C_HALF_PI - poly : -GTE_C_HALF_PI - poly));
+}
+
+vec2 ATanEstimateDegree11(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_ATAN_DEG11_C5);
+    poly = GTE_C_ATAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 ATanEstimateDegree11RR(vec2 x)
+{
+    vec2 poly = ATanEstimateDegree11(mix(1.0 / x, x, lessThanEqual(abs(x), vec2(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec2(0.0))), poly, lessThanEqual(abs(x), vec2(1.0)));
+}
+
+vec3 ATanEstimateDegree11(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_ATAN_DEG11_C5);
+    poly = GTE_C_ATAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 ATanEstimateDegree11RR(vec3 x)
+{
+    vec3 poly = ATanEstimateDegree11(mix(1.0 / x, x, lessThanEqual(abs(x), vec3(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec3(0.0))), poly, lessThanEqual(abs(x), vec3(1.0)));
+}
+
+vec4 ATanEstimateDegree11(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_ATAN_DEG11_C5);
+    poly = GTE_C_ATAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 ATanEstimateDegree11RR(vec4 x)
+{
+    vec4 poly = ATanEstimateDegree11(mix(1.0 / x, x, lessThanEqual(abs(x), vec4(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec4(0.0))), poly, lessThanEqual(abs(x), vec4(1.0)));
+}
+
+float ATanEstimateDegree13(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_ATAN_DEG13_C6;
+    poly = GTE_C_ATAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float ATanEstimateDegree13RR(float x)
+{
+    float poly = ATanEstimateDegree13(((abs(x) <= 1.0) ? x : 1.0 / x));
+    return ((abs(x) <= 1.0) ? poly : ((x > 0.0) ? GTE_C_HALF_PI - poly : -GTE_C_HALF_PI - poly));
+}
+
+vec2 ATanEstimateDegree13(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_ATAN_DEG13_C6);
+    poly = GTE_C_ATAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 ATanEstimateDegree13RR(vec2 x)
+{
+    vec2 poly = ATanEstimateDegree13(mix(1.0 / x, x, lessThanEqual(abs(x), vec2(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec2(0.0))), poly, lessThanEqual(abs(x), vec2(1.0)));
+}
+
+vec3 ATanEstimateDegree13(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_ATAN_DEG13_C6);
+    poly = GTE_C_ATAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 ATanEstimateDegree13RR(vec3 x)
+{
+    vec3 poly = ATanEstimateDegree13(mix(1.0 / x, x, lessThanEqual(abs(x), vec3(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec3(0.0))), poly, lessThanEqual(abs(x), vec3(1.0)));
+}
+
+vec4 ATanEstimateDegree13(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_ATAN_DEG13_C6);
+    poly = GTE_C_ATAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_ATAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 ATanEstimateDegree13RR(vec4 x)
+{
+    vec4 poly = ATanEstimateDegree13(mix(1.0 / x, x, lessThanEqual(abs(x), vec4(1.0))));
+    return mix(mix(-GTE_C_HALF_PI - poly, GTE_C_HALF_PI - poly, greaterThan(x, vec4(0.0))), poly, lessThanEqual(abs(x), vec4(1.0)));
+}
+
+#endif
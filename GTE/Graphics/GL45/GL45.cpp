@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GL45.h>
 #include <cassert>
@@ -10223,6 +10223,31 @@ static void Initialize_OPENGL_VERSION_4_5()
     }
 }
 
+// GL_ARB_sparse_texture
+
+static PFNGLTEXPAGECOMMITMENTARBPROC sglTexPageCommitmentARB = nullptr;
+
+void APIENTRY glTexPageCommitmentARB(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLboolean commit)
+{
+    if (sglTexPageCommitmentARB)
+    {
+        sglTexPageCommitmentARB(target, level, xoffset, yoffset, zoffset, width, height, depth, commit);
+        ReportGLError("glTexPageCommitmentARB");
+    }
+    else
+    {
+        ReportGLNullFunction("glTexPageCommitmentARB");
+    }
+}
+
+static void Initialize_ARB_sparse_texture()
+{
+    // The function is not in the core profile. Its pointer is null when the
+    // driver does not support the extension, so the callers must check for
+    // the extension before calling it.
+    GetOpenGLFunction("glTexPageCommitmentARB", sglTexPageCommitmentARB);
+}
+
 void InitializeOpenGL(int& major, int& minor, char const* infofile)
 {
 #if !defined(GTE_USE_MSWINDOWS)
@@ -10246,6 +10271,7 @@ void InitializeOpenGL(int& major, int& minor, char const* infofile)
     Initialize_OPENGL_VERSION_4_3();
     Initialize_OPENGL_VERSION_4_4();
     Initialize_OPENGL_VERSION_4_5();
+    Initialize_ARB_sparse_texture();
 
     if (infofile)
     {
@@ -3,10 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45Buffer.h>
+#include <Graphics/GL45/GL45RingBuffer.h>
+#include <cstring>
 using namespace gte;
 
 GL45Buffer::~GL45Buffer()
@@ -17,9 +19,13 @@ GL45Buffer::~GL45Buffer()
 GL45Buffer::GL45Buffer(Buffer const* buffer, GLenum type)
     :
     GL45Resource(buffer),
-    mType(type)
+    mType(type),
+    mDrawHandle(0),
+    mDrawOffset(0),
+    mRingFrame(0)
 {
     glGenBuffers(1, &mGLHandle);
+    mDrawHandle = mGLHandle;
 
     Resource::Usage usage = buffer->GetUsage();
     if (usage == Resource::IMMUTABLE)
@@ -72,12 +78,28 @@ bool GL45Buffer::Update()
         return false;
     }
 
+    if (buffer->HasDirtyRanges())
+    {
+        // Copy only the modified ranges from CPU memory to GPU memory.
+        UseOwnStorage();
+        glBindBuffer(mType, mGLHandle);
+        for (auto const& range : buffer->GetDirtyRanges())
+        {
+            glBufferSubData(mType, range.first, range.second - range.first,
+                buffer->GetData() + range.first);
+        }
+        glBindBuffer(mType, 0);
+        buffer->ClearDirtyRanges();
+        return true;
+    }
+
     GLuint numActiveBytes = buffer->GetNumActiveBytes();
     if (numActiveBytes > 0)
     {
         // Copy from CPU memory to GPU memory.
         GLintptr offsetInBytes = buffer->GetOffset() * buffer->GetElementSize();
         char const* source = buffer->GetData() + offsetInBytes;
+        UseOwnStorage();
         glBindBuffer(mType, mGLHandle);
         glBufferSubData(mType, offsetInBytes, numActiveBytes, source);
         glBindBuffer(mType, 0);
@@ -103,6 +125,7 @@ bool GL45Buffer::CopyCpuToGpu()
         // Copy from CPU memory to GPU memory.
         GLintptr offsetInBytes = buffer->GetOffset() * buffer->GetElementSize();
         char const* source = buffer->GetData() + offsetInBytes;
+        UseOwnStorage();
         glBindBuffer(mType, mGLHandle);
         glBufferSubData(mType, offsetInBytes, numActiveBytes, source);
         glBindBuffer(mType, 0);
@@ -138,3 +161,79 @@ bool GL45Buffer::CopyGpuToCpu()
     }
     return true;
 }
+
+bool GL45Buffer::Update(GL45RingBuffer* ring)
+{
+    // The ring copies the entire buffer, so a buffer with dirty ranges is
+    // updated in its own storage.
+    if (!ring || !CanUseRing() || GetBuffer()->HasDirtyRanges())
+    {
+        return Update();
+    }
+
+    if (GetBuffer()->GetNumActiveBytes() == 0)
+    {
+        LogInformation("Buffer has zero active bytes.");
+        return true;
+    }
+
+    return CopyToRing(ring) || Update();
+}
+
+void GL45Buffer::RefreshRingCopy(GL45RingBuffer* ring)
+{
+    // The allocation of an earlier frame might have been overwritten. The
+    // data are copied to the buffer when the ring does not have enough
+    // bytes remaining.
+    if (mDrawHandle != mGLHandle && (!ring || mRingFrame != ring->GetFrame()))
+    {
+        if (!ring || !CopyToRing(ring))
+        {
+            UseOwnStorage();
+        }
+    }
+}
+
+bool GL45Buffer::CanUseRing() const
+{
+    Buffer* buffer = GetBuffer();
+    return buffer->GetUsage() == Resource::DYNAMIC_UPDATE
+        && buffer->GetCopyType() == Resource::COPY_NONE
+        && (mType == GL_UNIFORM_BUFFER || mType == GL_ARRAY_BUFFER
+        || mType == GL_ELEMENT_ARRAY_BUFFER);
+}
+
+bool GL45Buffer::CopyToRing(GL45RingBuffer* ring)
+{
+    // The draws access the buffer at offsets relative to the allocation,
+    // so the entire buffer is copied.
+    Buffer* buffer = GetBuffer();
+    GLsizeiptr const numBytes = static_cast<GLsizeiptr>(buffer->GetNumBytes());
+    GLintptr offset = 0;
+    char* data = nullptr;
+    if (!ring->Allocate(numBytes, offset, data))
+    {
+        return false;
+    }
+
+    std::memcpy(data, buffer->GetData(), static_cast<size_t>(numBytes));
+    mDrawHandle = ring->GetGLHandle();
+    mDrawOffset = offset;
+    mRingFrame = ring->GetFrame();
+    return true;
+}
+
+void GL45Buffer::UseOwnStorage()
+{
+    if (mDrawHandle != mGLHandle)
+    {
+        // The buffer has not received the updates that were copied to the
+        // ring.
+        mDrawHandle = mGLHandle;
+        mDrawOffset = 0;
+        Buffer* buffer = GetBuffer();
+        glBindBuffer(mType, mGLHandle);
+        glBufferSubData(mType, 0, buffer->GetNumBytes(), buffer->GetData());
+        glBindBuffer(mType, 0);
+    }
+}
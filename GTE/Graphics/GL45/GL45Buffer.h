@@ -3,15 +3,18 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/Buffer.h>
 #include <Graphics/GL45/GL45Resource.h>
+#include <cstdint>
 
 namespace gte
 {
+    class GL45RingBuffer;
+
     class GL45Buffer : public GL45Resource
     {
     protected:
@@ -47,8 +50,41 @@ namespace gte
         virtual bool CopyCpuToGpu();
         virtual bool CopyGpuToCpu();
 
+        // Support for the ring buffer of GL45Engine. Update(ring) copies the
+        // buffer data to an allocation of the current frame of the ring
+        // instead of to the buffer, and the draws read the data from the
+        // allocation, which avoids the synchronization of glBufferSubData
+        // with the draws of earlier frames that read the buffer. The data
+        // are copied to a new allocation when the buffer is used in a later
+        // frame (RefreshRingCopy). When the ring does not have enough bytes
+        // remaining, the data are copied to the buffer. The draws bind
+        // GetDrawHandle() and add GetDrawOffset() to the buffer offsets.
+        bool Update(GL45RingBuffer* ring);
+        void RefreshRingCopy(GL45RingBuffer* ring);
+
+        inline GLuint GetDrawHandle() const
+        {
+            return mDrawHandle;
+        }
+
+        inline GLintptr GetDrawOffset() const
+        {
+            return mDrawOffset;
+        }
+
+        // The ring is used only for DYNAMIC_UPDATE buffers that are not
+        // copied to the CPU, because the data of the allocation are not
+        // copied back to the buffer.
+        bool CanUseRing() const;
+
     protected:
+        bool CopyToRing(GL45RingBuffer* ring);
+        void UseOwnStorage();
+
         GLenum mType;
         GLenum mUsage;
+        GLuint mDrawHandle;
+        GLintptr mDrawOffset;
+        uint64_t mRingFrame;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45ConstantBuffer.h>
@@ -29,5 +29,6 @@ std::shared_ptr<GEObject> GL45ConstantBuffer::Create(void*, GraphicsObject const
 
 void GL45ConstantBuffer::AttachToUnit(GLint uniformBufferUnit)
 {
-    glBindBufferBase(GL_UNIFORM_BUFFER, uniformBufferUnit, mGLHandle);
+    glBindBufferRange(GL_UNIFORM_BUFFER, uniformBufferUnit, mDrawHandle, mDrawOffset,
+        static_cast<GLsizeiptr>(GetBuffer()->GetNumBytes()));
 }
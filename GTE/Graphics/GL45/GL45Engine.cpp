@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/FontArialW400H18.h>
@@ -14,6 +14,7 @@
 #include <Graphics/GL45/GL45DepthStencilState.h>
 #include <Graphics/GL45/GL45DrawTarget.h>
 #include <Graphics/GL45/GL45IndexBuffer.h>
+#include <Graphics/GL45/GL45IndirectArgumentsBuffer.h>
 #include <Graphics/GL45/GL45RasterizerState.h>
 #include <Graphics/GL45/GL45SamplerState.h>
 #include <Graphics/GL45/GL45StructuredBuffer.h>
@@ -28,13 +29,21 @@
 #include <Graphics/GL45/GLSLProgramFactory.h>
 #include <Graphics/GL45/GLSLComputeProgram.h>
 #include <Graphics/GL45/GLSLVisualProgram.h>
+#include <algorithm>
 using namespace gte;
 
 GL45Engine::GL45Engine()
     :
     mMajor(0),
     mMinor(0),
-    mMeetsRequirements(false)
+    mMeetsRequirements(false),
+    mInDrawBatch(false),
+    mBatchEffect{},
+    mBatchProgram(0),
+    mBatchLayout(nullptr),
+    mBatchIBuffer(nullptr),
+    mBatchIBufferHandle(0),
+    mUseMultiBind(false)
 {
     // Initialization of GraphicsEngine members that depend on GL45.
     mILMap = std::make_unique<GL45InputLayoutManager>();
@@ -51,7 +60,7 @@ GL45Engine::GL45Engine()
         &GL45StructuredBuffer::Create,
         nullptr, // TODO:  Implement TypedBuffer
         nullptr, // &DX11RawBuffer::Create,
-        nullptr, // &DX11IndirectArgumentsBuffer::Create,
+        &GL45IndirectArgumentsBuffer::Create,
         nullptr, // GT_TEXTURE (abstract base)
         nullptr, // GT_TEXTURE_SINGLE (abstract base)
         &GL45Texture1::Create,
@@ -109,6 +118,10 @@ bool GL45Engine::Initialize(int requiredMajor, int requiredMinor, bool, bool sav
     mMeetsRequirements = (mMajor > requiredMajor ||
         (mMajor == requiredMajor && mMinor >= requiredMinor));
 
+    // The multi-bind functions glBind{BuffersBase,Samplers,Textures} are
+    // available in OpenGL 4.4 and later.
+    mUseMultiBind = (mMajor > 4 || (mMajor == 4 && mMinor >= 4));
+
     if (mMeetsRequirements)
     {
         SetViewport(0, 0, mXSize, mYSize);
@@ -137,6 +150,9 @@ void GL45Engine::Terminate()
     // counter buffers.
     mAtomicCounterRawBuffers.clear();
 
+    // The ring buffer is unmapped and deleted while the context exists.
+    mRingBuffer = nullptr;
+
     GraphicsObject::UnsubscribeForDestruction(mGOListener);
     mGOListener = nullptr;
 
@@ -175,7 +191,46 @@ void GL45Engine::Terminate()
     mILMap = nullptr;
 }
 
-uint64_t GL45Engine::DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer const* ibuffer)
+bool GL45Engine::CreateRingBuffer(size_t numBytesPerFrame, unsigned int numFrames)
+{
+    if (mRingBuffer)
+    {
+        LogWarning("The ring buffer already exists.");
+        return false;
+    }
+
+    // Persistently mapped buffers (glBufferStorage) are available in
+    // OpenGL 4.4 and later.
+    if (mMajor < 4 || (mMajor == 4 && mMinor < 4))
+    {
+        LogWarning("The ring buffer requires OpenGL 4.4 or later.");
+        return false;
+    }
+
+    mRingBuffer = std::make_unique<GL45RingBuffer>(
+        static_cast<GLsizeiptr>(numBytesPerFrame), numFrames);
+    return true;
+}
+
+void GL45Engine::BeginFrame()
+{
+    if (mRingBuffer)
+    {
+        mRingBuffer->BeginFrame();
+    }
+}
+
+void GL45Engine::EndFrame()
+{
+    if (mRingBuffer)
+    {
+        mRingBuffer->EndFrame();
+    }
+}
+
+uint64_t GL45Engine::DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer const* ibuffer,
+    GLintptr ibufferDrawOffset, VertexBuffer const* instanceBuffer, GLuint argumentsHandle,
+    GLintptr argumentsOffset, GLsizei numDraws)
 {
     unsigned int numActiveVertices = vbuffer->GetNumActiveElements();
     unsigned int vertexOffset = vbuffer->GetOffset();
@@ -220,9 +275,49 @@ uint64_t GL45Engine::DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer cons
     }
 
     unsigned int offset = ibuffer->GetOffset();
-    if (ibuffer->IsIndexed())
+    if (argumentsHandle)
+    {
+        // The arguments might have been written by a shader or a copy.  The
+        // first index and the base vertex of a record are relative to the
+        // start of the index and vertex data.
+        glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, argumentsHandle);
+        void const* indirect = (char*)0 + argumentsOffset;
+        mStatistics.numDraws += static_cast<uint64_t>(numDraws);
+        if (ibuffer->IsIndexed())
+        {
+            glMultiDrawElementsIndirect(topology, indexType, indirect, numDraws, 0);
+        }
+        else
+        {
+            glMultiDrawArraysIndirect(topology, indirect, numDraws, 0);
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+    else if (instanceBuffer)
+    {
+        // The offset of the instance buffer is the first instance.
+        GLsizei numInstances = static_cast<GLsizei>(instanceBuffer->GetNumActiveElements());
+        GLuint firstInstance = static_cast<GLuint>(instanceBuffer->GetOffset());
+        ++mStatistics.numDraws;
+        mStatistics.numPrimitives += static_cast<uint64_t>(ibuffer->GetNumActivePrimitives()) * numInstances;
+        if (ibuffer->IsIndexed())
+        {
+            void const* data = (char*)0 + ibufferDrawOffset + indexSize * offset;
+            glDrawElementsInstancedBaseInstance(topology, static_cast<GLsizei>(numActiveIndices),
+                indexType, data, numInstances, firstInstance);
+        }
+        else
+        {
+            glDrawArraysInstancedBaseInstance(topology, static_cast<GLint>(vertexOffset),
+                static_cast<GLsizei>(numActiveVertices), numInstances, firstInstance);
+        }
+    }
+    else if (ibuffer->IsIndexed())
     {
-        void const* data = (char*)0 + indexSize * offset;
+        ++mStatistics.numDraws;
+        mStatistics.numPrimitives += ibuffer->GetNumActivePrimitives();
+        void const* data = (char*)0 + ibufferDrawOffset + indexSize * offset;
         glDrawRangeElements(topology, 0, numActiveVertices - 1,
             static_cast<GLsizei>(numActiveIndices), indexType, data);
     }
@@ -235,6 +330,8 @@ uint64_t GL45Engine::DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer cons
         // the content of the GL_ELEMENT_ARRAY_BUFFER, or explicitly generated
         // from the content of the GL_ELEMENT_ARRAY_BUFFER by commands such as
         // glDrawElements."
+        ++mStatistics.numDraws;
+        mStatistics.numPrimitives += ibuffer->GetNumActivePrimitives();
         glDrawArrays(topology, static_cast<GLint>(vertexOffset),
             static_cast<GLint>(numActiveVertices));
     }
@@ -291,6 +388,7 @@ void GL45Engine::Enable(Shader const* shader, GLuint program)
     EnableTextures(shader, program);
     EnableTextureArrays(shader, program);
     EnableSamplers(shader, program);
+    CommitBindings();
 }
 
 void GL45Engine::Disable(Shader const* shader, GLuint program)
@@ -319,7 +417,10 @@ void GL45Engine::EnableCBuffers(Shader const* shader, GLuint program)
                 {
                     auto const unit = mUniformUnitMap.AcquireUnit(program, blockIndex);
                     glUniformBlockBinding(program, blockIndex, unit);
-                    gl4CB->AttachToUnit(unit);
+                    gl4CB->RefreshRingCopy(mRingBuffer.get());
+                    RequestBinding(mUniformBufferUnits, mPendingUniformBuffers,
+                        unit, GL_UNIFORM_BUFFER, gl4CB->GetDrawHandle(), gl4CB->GetDrawOffset(),
+                        static_cast<GLsizeiptr>(gl4CB->GetBuffer()->GetNumBytes()));
                 }
             }
             else
@@ -342,8 +443,8 @@ void GL45Engine::DisableCBuffers(Shader const* shader, GLuint program)
         auto const blockIndex = cb.bindPoint;
         if (GL_INVALID_INDEX != static_cast<unsigned int>(blockIndex))
         {
+            // The buffer remains bound to the unit (see CommitBindings).
             auto const unit = mUniformUnitMap.GetUnit(program, blockIndex);
-            glBindBufferBase(GL_UNIFORM_BUFFER, unit, 0);
             mUniformUnitMap.ReleaseUnit(unit);
         }
     }
@@ -413,6 +514,7 @@ void GL45Engine::EnableSBuffers(Shader const* shader, GLuint program)
 
         // Bind this atomic counter buffer
         gl4ACB->AttachToUnit(acb.bindPoint);
+        ++mStatistics.numBufferBinds;
     }
 
     int const indexSB = StructuredBuffer::shaderDataLookup;
@@ -432,6 +534,7 @@ void GL45Engine::EnableSBuffers(Shader const* shader, GLuint program)
                     // Do not use glBindBufferBase here.  Use AttachToUnit
                     // method in GL4StructuredBuffer.
                     gl4SB->AttachToUnit(unit);
+                    ++mStatistics.numBufferBinds;
 
                     // The sb.isGpuWritable flag is used to indicate whether
                     // or not there is atomic counter associated with this
@@ -568,13 +671,13 @@ void GL45Engine::EnableTextures(Shader const* shader, GLuint program)
             DFType format = texture->GetTexture()->GetFormat();
             GLuint internalFormat = texture->GetInternalFormat(format);
             glBindImageTexture(unit, handle, 0, GL_TRUE, 0, GL_READ_WRITE, internalFormat);
+            ++mStatistics.numTextureBinds;
         }
         else
         {
             GLint unit = mTextureSamplerUnitMap.AcquireUnit(program, ts.bindPoint);
             glUniform1i(ts.bindPoint, unit);
-            glActiveTexture(GL_TEXTURE0 + unit);
-            glBindTexture(texture->GetTarget(), handle);
+            RequestBinding(mTextureUnits, mPendingTextures, unit, texture->GetTarget(), handle);
         }
     }
 }
@@ -610,9 +713,8 @@ void GL45Engine::DisableTextures(Shader const* shader, GLuint program)
         }
         else
         {
+            // The texture remains bound to the unit (see CommitBindings).
             GLint unit = mTextureSamplerUnitMap.GetUnit(program, ts.bindPoint);
-            glActiveTexture(GL_TEXTURE0 + unit);
-            glBindTexture(texture->GetTarget(), 0);
             mTextureSamplerUnitMap.ReleaseUnit(unit);
         }
     }
@@ -648,13 +750,13 @@ void GL45Engine::EnableTextureArrays(Shader const* shader, GLuint program)
             DFType format = texture->GetTexture()->GetFormat();
             GLuint internalFormat = texture->GetInternalFormat(format);
             glBindImageTexture(unit, handle, 0, GL_TRUE, 0, GL_READ_WRITE, internalFormat);
+            ++mStatistics.numTextureBinds;
         }
         else
         {
             GLint unit = mTextureSamplerUnitMap.AcquireUnit(program, ta.bindPoint);
             glUniform1i(ta.bindPoint, unit);
-            glActiveTexture(GL_TEXTURE0 + unit);
-            glBindTexture(texture->GetTarget(), handle);
+            RequestBinding(mTextureUnits, mPendingTextures, unit, texture->GetTarget(), handle);
         }
     }
 }
@@ -692,9 +794,8 @@ void GL45Engine::DisableTextureArrays(Shader const* shader, GLuint program)
         }
         else
         {
+            // The texture remains bound to the unit (see CommitBindings).
             GLint unit = mTextureSamplerUnitMap.GetUnit(program, ta.bindPoint);
-            glActiveTexture(GL_TEXTURE0 + unit);
-            glBindTexture(texture->GetTarget(), 0);
             mTextureSamplerUnitMap.ReleaseUnit(unit);
         }
     }
@@ -712,7 +813,7 @@ void GL45Engine::EnableSamplers(Shader const* shader, GLuint program)
             {
                 auto const location = ts.bindPoint;
                 auto const unit = mTextureSamplerUnitMap.AcquireUnit(program, location);
-                glBindSampler(unit, gl4Sampler->GetGLHandle());
+                RequestBinding(mSamplerUnits, mPendingSamplers, unit, 0, gl4Sampler->GetGLHandle());
             }
             else
             {
@@ -738,8 +839,8 @@ void GL45Engine::DisableSamplers(Shader const* shader, GLuint program)
             if (gl4Sampler)
             {
                 auto const location = ts.bindPoint;
+                // The sampler remains bound to the unit (see CommitBindings).
                 auto const unit = mTextureSamplerUnitMap.GetUnit(program, location);
-                glBindSampler(unit, 0);
                 mTextureSamplerUnitMap.ReleaseUnit(unit);
             }
             else
@@ -754,6 +855,164 @@ void GL45Engine::DisableSamplers(Shader const* shader, GLuint program)
     }
 }
 
+void GL45Engine::RequestBinding(std::vector<Binding>& units, std::vector<Binding>& pending,
+    GLuint unit, GLenum target, GLuint handle, GLintptr offset, GLsizeiptr size)
+{
+    if (unit >= units.size())
+    {
+        units.resize(static_cast<size_t>(unit) + 1, Binding{ 0, 0, 0, 0, 0 });
+    }
+
+    // Texture operations outside the draws (creation, updates, mipmap
+    // generation) bind textures to the active unit 0, so the shadow state of
+    // texture unit 0 is not trusted.
+    Binding const& current = units[unit];
+    if (current.handle != handle || current.offset != offset || current.size != size
+        || (&units == &mTextureUnits && unit == 0))
+    {
+        pending.push_back({ unit, target, handle, offset, size });
+    }
+}
+
+void GL45Engine::CommitBindings()
+{
+    // The bindings are sorted by unit, so consecutive units are bound by
+    // one multi-bind call.
+    auto commit = [this](std::vector<Binding>& units, std::vector<Binding>& pending,
+        uint64_t* numBinds, auto const& multiBind, auto const& bind)
+    {
+        if (pending.size() == 0)
+        {
+            return;
+        }
+
+        // A unit requested more than once (by two shaders of a program) is
+        // bound to the object of the last request.
+        std::stable_sort(pending.begin(), pending.end(),
+            [](Binding const& b0, Binding const& b1) { return b0.unit < b1.unit; });
+        size_t numBindings = 0;
+        for (auto const& binding : pending)
+        {
+            if (numBindings > 0 && pending[numBindings - 1].unit == binding.unit)
+            {
+                pending[numBindings - 1] = binding;
+            }
+            else
+            {
+                pending[numBindings++] = binding;
+            }
+        }
+        pending.resize(numBindings);
+        if (numBinds)
+        {
+            *numBinds += numBindings;
+        }
+
+        for (size_t i = 0; i < numBindings; )
+        {
+            size_t j = i + 1;
+            if (mUseMultiBind)
+            {
+                while (j < numBindings && pending[j].unit == pending[j - 1].unit + 1)
+                {
+                    ++j;
+                }
+
+                multiBind(&pending[i], static_cast<GLsizei>(j - i));
+            }
+            else
+            {
+                bind(pending[i]);
+            }
+
+            for (size_t k = i; k < j; ++k)
+            {
+                units[pending[k].unit] = pending[k];
+            }
+            i = j;
+        }
+        pending.clear();
+    };
+
+    auto gatherHandles = [this](Binding const* bindings, GLsizei count)
+    {
+        mMultiBindHandles.clear();
+        for (GLsizei k = 0; k < count; ++k)
+        {
+            mMultiBindHandles.push_back(bindings[k].handle);
+        }
+    };
+
+    commit(mUniformBufferUnits, mPendingUniformBuffers, &mStatistics.numBufferBinds,
+        [this, &gatherHandles](Binding const* bindings, GLsizei count)
+        {
+            gatherHandles(bindings, count);
+            mMultiBindOffsets.clear();
+            mMultiBindSizes.clear();
+            for (GLsizei k = 0; k < count; ++k)
+            {
+                mMultiBindOffsets.push_back(bindings[k].offset);
+                mMultiBindSizes.push_back(bindings[k].size);
+            }
+            glBindBuffersRange(GL_UNIFORM_BUFFER, bindings[0].unit, count,
+                mMultiBindHandles.data(), mMultiBindOffsets.data(), mMultiBindSizes.data());
+        },
+        [](Binding const& binding)
+        {
+            glBindBufferRange(GL_UNIFORM_BUFFER, binding.unit, binding.handle,
+                binding.offset, binding.size);
+        });
+
+    bool const restoreActiveTexture = (!mUseMultiBind && mPendingTextures.size() > 0);
+    commit(mTextureUnits, mPendingTextures, &mStatistics.numTextureBinds,
+        [this, &gatherHandles](Binding const* bindings, GLsizei count)
+        {
+            gatherHandles(bindings, count);
+            glBindTextures(bindings[0].unit, count, mMultiBindHandles.data());
+        },
+        [](Binding const& binding)
+        {
+            glActiveTexture(GL_TEXTURE0 + binding.unit);
+            glBindTexture(binding.target, binding.handle);
+        });
+    if (restoreActiveTexture)
+    {
+        glActiveTexture(GL_TEXTURE0);
+    }
+
+    commit(mSamplerUnits, mPendingSamplers, nullptr,
+        [this, &gatherHandles](Binding const* bindings, GLsizei count)
+        {
+            gatherHandles(bindings, count);
+            glBindSamplers(bindings[0].unit, count, mMultiBindHandles.data());
+        },
+        [](Binding const& binding)
+        {
+            glBindSampler(binding.unit, binding.handle);
+        });
+}
+
+void GL45Engine::OnUnbind(GEObject* geObject)
+{
+    // Deleting an OpenGL object unbinds it from the units, and its name
+    // may be reused for a new object.
+    auto glObject = dynamic_cast<GL45GraphicsObject*>(geObject);
+    if (glObject)
+    {
+        GLuint const handle = glObject->GetGLHandle();
+        for (auto units : { &mUniformBufferUnits, &mTextureUnits, &mSamplerUnits })
+        {
+            for (auto& binding : *units)
+            {
+                if (binding.handle == handle)
+                {
+                    binding.handle = 0;
+                }
+            }
+        }
+    }
+}
+
 int GL45Engine::ProgramIndexUnitMap::AcquireUnit(GLint program, GLint index)
 {
     int availUnit = -1;
@@ -979,6 +1238,131 @@ void GL45Engine::SetRasterizerState(std::shared_ptr<RasterizerState> const& stat
     }
 }
 
+unsigned int GL45Engine::CreateOcclusionQuery()
+{
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void GL45Engine::DestroyOcclusionQuery(unsigned int query)
+{
+    GLuint handle = query;
+    glDeleteQueries(1, &handle);
+}
+
+void GL45Engine::BeginQuery(unsigned int query)
+{
+    glBeginQuery(GL_SAMPLES_PASSED, query);
+}
+
+void GL45Engine::EndQuery(unsigned int)
+{
+    glEndQuery(GL_SAMPLES_PASSED);
+}
+
+bool GL45Engine::GetQueryResult(unsigned int query, uint64_t& numSamples)
+{
+    GLuint available = 0;
+    glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available)
+    {
+        GLuint result = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &result);
+        numSamples = result;
+        return true;
+    }
+    return false;
+}
+
+void GL45Engine::BeginConditionalDraw(unsigned int query)
+{
+    glBeginConditionalRender(query, GL_QUERY_NO_WAIT);
+}
+
+void GL45Engine::EndConditionalDraw()
+{
+    glEndConditionalRender();
+}
+
+unsigned int GL45Engine::CreateTimestampSet(unsigned int numTimestamps)
+{
+    LogAssert(numTimestamps > 0, "Invalid number of timestamps.");
+
+    size_t i = 0;
+    for (; i < mTimestampSets.size(); ++i)
+    {
+        if (mTimestampSets[i].size() == 0)
+        {
+            break;
+        }
+    }
+    if (i == mTimestampSets.size())
+    {
+        mTimestampSets.push_back(std::vector<GLuint>());
+    }
+
+    auto& queries = mTimestampSets[i];
+    queries.resize(numTimestamps);
+    glGenQueries(static_cast<GLsizei>(numTimestamps), queries.data());
+    return static_cast<unsigned int>(i + 1);
+}
+
+void GL45Engine::DestroyTimestampSet(unsigned int set)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    auto& queries = mTimestampSets[set - 1];
+    glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    queries.clear();
+}
+
+void GL45Engine::BeginTimestamps(unsigned int)
+{
+    // OpenGL timestamps are in nanoseconds and need no bracketing query.
+}
+
+void GL45Engine::WriteTimestamp(unsigned int set, unsigned int i)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    glQueryCounter(mTimestampSets[set - 1][i], GL_TIMESTAMP);
+}
+
+void GL45Engine::EndTimestamps(unsigned int)
+{
+}
+
+bool GL45Engine::GetTimestamps(unsigned int set, unsigned int numWritten,
+    std::vector<uint64_t>& nanoseconds)
+{
+    LogAssert(0 < set && set <= mTimestampSets.size(), "Invalid timestamp set.");
+    auto const& queries = mTimestampSets[set - 1];
+    LogAssert(numWritten <= queries.size(), "Invalid number of timestamps.");
+
+    for (unsigned int i = 0; i < numWritten; ++i)
+    {
+        GLuint available = 0;
+        glGetQueryObjectuiv(queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            return false;
+        }
+    }
+
+    nanoseconds.resize(numWritten);
+    GLuint64 time0 = 0;
+    for (unsigned int i = 0; i < numWritten; ++i)
+    {
+        GLuint64 time = 0;
+        glGetQueryObjectui64v(queries[i], GL_QUERY_RESULT, &time);
+        if (i == 0)
+        {
+            time0 = time;
+        }
+        nanoseconds[i] = static_cast<uint64_t>(time - time0);
+    }
+    return true;
+}
+
 void GL45Engine::Enable(std::shared_ptr<DrawTarget> const& target)
 {
     auto gl4Target = static_cast<GL45DrawTarget*>(Bind(target));
@@ -1003,7 +1387,8 @@ bool GL45Engine::Update(std::shared_ptr<Buffer> const& buffer)
     }
 
     auto glBuffer = static_cast<GL45Buffer*>(Bind(buffer));
-    return glBuffer->Update();
+    mStatistics.numBytesUploaded += GetNumUpdateBytes(buffer.get());
+    return glBuffer->Update(mRingBuffer.get());
 }
 
 bool GL45Engine::Update(std::shared_ptr<TextureSingle> const& texture)
@@ -1015,6 +1400,7 @@ bool GL45Engine::Update(std::shared_ptr<TextureSingle> const& texture)
     }
 
     auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesUploaded += texture->GetNumBytes();
     return glTexture->Update();
 }
 
@@ -1027,6 +1413,7 @@ bool GL45Engine::Update(std::shared_ptr<TextureSingle> const& texture, unsigned
     }
 
     auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesUploaded += texture->GetNumBytesFor(level);
     return glTexture->Update(level);
 }
 
@@ -1039,6 +1426,7 @@ bool GL45Engine::Update(std::shared_ptr<TextureArray> const& textureArray)
     }
 
     auto glTextureArray = static_cast<GL45TextureArray*>(Bind(textureArray));
+    mStatistics.numBytesUploaded += textureArray->GetNumBytes();
     return glTextureArray->Update();
 }
 
@@ -1051,6 +1439,7 @@ bool GL45Engine::Update(std::shared_ptr<TextureArray> const& textureArray, unsig
     }
 
     auto glTextureArray = static_cast<GL45TextureArray*>(Bind(textureArray));
+    mStatistics.numBytesUploaded += textureArray->GetNumBytesFor(level);
     return glTextureArray->Update(item, level);
 }
 
@@ -1063,6 +1452,7 @@ bool GL45Engine::CopyCpuToGpu(std::shared_ptr<Buffer> const& buffer)
     }
 
     auto glBuffer = static_cast<GL45Buffer*>(Bind(buffer));
+    mStatistics.numBytesUploaded += buffer->GetNumActiveBytes();
     return glBuffer->CopyCpuToGpu();
 }
 
@@ -1075,6 +1465,7 @@ bool GL45Engine::CopyCpuToGpu(std::shared_ptr<TextureSingle> const& texture)
     }
 
     auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesUploaded += texture->GetNumBytes();
     return glTexture->CopyCpuToGpu();
 }
 
@@ -1087,6 +1478,7 @@ bool GL45Engine::CopyCpuToGpu(std::shared_ptr<TextureSingle> const& texture, uns
     }
 
     auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesUploaded += texture->GetNumBytesFor(level);
     return glTexture->CopyCpuToGpu(level);
 }
 
@@ -1099,6 +1491,7 @@ bool GL45Engine::CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray)
     }
 
     auto glTextureArray = static_cast<GL45TextureArray*>(Bind(textureArray));
+    mStatistics.numBytesUploaded += textureArray->GetNumBytes();
     return glTextureArray->CopyCpuToGpu();
 }
 
@@ -1111,9 +1504,16 @@ bool GL45Engine::CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray,
     }
 
     auto glTextureArray = static_cast<GL45TextureArray*>(Bind(textureArray));
+    mStatistics.numBytesUploaded += textureArray->GetNumBytesFor(level);
     return glTextureArray->CopyCpuToGpu(item, level);
 }
 
+bool GL45Engine::UpdateResidency(std::shared_ptr<TextureSingle> const& texture)
+{
+    auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    return glTexture->UpdateResidency();
+}
+
 bool GL45Engine::CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer)
 {
     if (!buffer->GetData())
@@ -1123,6 +1523,7 @@ bool GL45Engine::CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer)
     }
 
     auto glBuffer = static_cast<GL45Buffer*>(Bind(buffer));
+    mStatistics.numBytesReadBack += buffer->GetNumActiveBytes();
     return glBuffer->CopyGpuToCpu();
 }
 
@@ -1135,6 +1536,7 @@ bool GL45Engine::CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture)
     }
 
     auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesReadBack += texture->GetNumBytes();
     return glTexture->CopyGpuToCpu();
 }
 
@@ -1147,9 +1549,48 @@ bool GL45Engine::CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture, uns
     }
 
     auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesReadBack += texture->GetNumBytesFor(level);
     return glTexture->CopyGpuToCpu(level);
 }
 
+bool GL45Engine::StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture)
+{
+    auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    return glTexture->StageGpuToCpu();
+}
+
+bool GL45Engine::StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level)
+{
+    auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    return glTexture->StageGpuToCpu(level);
+}
+
+bool GL45Engine::CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture)
+{
+    if (!texture->GetData())
+    {
+        LogWarning("Texture does not have system memory, creating it.");
+        texture->CreateStorage();
+    }
+
+    auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesReadBack += texture->GetNumBytes();
+    return glTexture->CopyStagingToCpu();
+}
+
+bool GL45Engine::CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level)
+{
+    if (!texture->GetData())
+    {
+        LogWarning("Texture does not have system memory, creating it.");
+        texture->CreateStorage();
+    }
+
+    auto glTexture = static_cast<GL45TextureSingle*>(Bind(texture));
+    mStatistics.numBytesReadBack += texture->GetNumBytesFor(level);
+    return glTexture->CopyStagingToCpu(level);
+}
+
 bool GL45Engine::CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray)
 {
     if (!textureArray->GetData())
@@ -1159,6 +1600,7 @@ bool GL45Engine::CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray)
     }
 
     auto glTextureArray = static_cast<GL45TextureArray*>(Bind(textureArray));
+    mStatistics.numBytesReadBack += textureArray->GetNumBytes();
     return glTextureArray->CopyGpuToCpu();
 }
 
@@ -1171,6 +1613,7 @@ bool GL45Engine::CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray,
     }
 
     auto glTextureArray = static_cast<GL45TextureArray*>(Bind(textureArray));
+    mStatistics.numBytesReadBack += textureArray->GetNumBytesFor(level);
     return glTextureArray->CopyGpuToCpu(item, level);
 }
 
@@ -1178,18 +1621,28 @@ void GL45Engine::CopyGpuToGpu(
     std::shared_ptr<Buffer> const& buffer0,
     std::shared_ptr<Buffer> const& buffer1)
 {
-    (void)buffer0;
-    (void)buffer1;
-    LogError("This function is not yet implemented.");
+    auto glBuffer0 = static_cast<GL45Buffer*>(Bind(buffer0));
+    auto glBuffer1 = static_cast<GL45Buffer*>(Bind(buffer1));
+
+    // The source might have been written by a shader.
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    glBindBuffer(GL_COPY_READ_BUFFER, glBuffer0->GetGLHandle());
+    glBindBuffer(GL_COPY_WRITE_BUFFER, glBuffer1->GetGLHandle());
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+        static_cast<GLsizeiptr>(buffer0->GetNumBytes()));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 }
 
 void GL45Engine::CopyGpuToGpu(
     std::shared_ptr<TextureSingle> const& texture0,
     std::shared_ptr<TextureSingle> const& texture1)
 {
-    (void)texture0;
-    (void)texture1;
-    LogError("This function is not yet implemented.");
+    unsigned int const numLevels = texture0->GetNumLevels();
+    for (unsigned int level = 0; level < numLevels; ++level)
+    {
+        CopyGpuToGpu(texture0, texture1, level);
+    }
 }
 
 void GL45Engine::CopyGpuToGpu(
@@ -1197,10 +1650,21 @@ void GL45Engine::CopyGpuToGpu(
     std::shared_ptr<TextureSingle> const& texture1,
     unsigned int level)
 {
-    (void)texture0;
-    (void)texture1;
-    (void)level;
-    LogError("This function is not yet implemented.");
+    auto glTexture0 = static_cast<GL45TextureSingle*>(Bind(texture0));
+    auto glTexture1 = static_cast<GL45TextureSingle*>(Bind(texture1));
+
+    unsigned int const numDimensions = texture0->GetNumDimensions();
+    GLsizei size[3] = { 1, 1, 1 };
+    for (unsigned int i = 0; i < numDimensions; ++i)
+    {
+        size[i] = static_cast<GLsizei>(texture0->GetDimensionFor(level, i));
+    }
+
+    GLint const glLevel = static_cast<GLint>(level);
+    glCopyImageSubData(
+        glTexture0->GetGLHandle(), glTexture0->GetTarget(), glLevel, 0, 0, 0,
+        glTexture1->GetGLHandle(), glTexture1->GetTarget(), glLevel, 0, 0, 0,
+        size[0], size[1], size[2]);
 }
 
 void GL45Engine::CopyGpuToGpu(
@@ -1254,6 +1718,44 @@ void GL45Engine::Execute(std::shared_ptr<ComputeProgram> const& program,
             glUseProgram(programHandle);
             Enable(cshader.get(), programHandle);
             glDispatchCompute(numXGroups, numYGroups, numZGroups);
+            // The shader storage written by the dispatch is read by the
+            // shaders of later draws and dispatches.
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            ++mStatistics.numProgramBinds;
+            ++mStatistics.numDispatches;
+            Disable(cshader.get(), programHandle);
+            glUseProgram(0);
+        }
+    }
+    else
+    {
+        LogError("Invalid input parameter.");
+    }
+}
+
+void GL45Engine::Execute(std::shared_ptr<ComputeProgram> const& program,
+    std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset)
+{
+    auto glslProgram = std::dynamic_pointer_cast<GLSLComputeProgram>(program);
+    if (glslProgram && arguments)
+    {
+        auto cshader = glslProgram->GetComputeShader();
+        auto programHandle = glslProgram->GetProgramHandle();
+        if (cshader && programHandle > 0)
+        {
+            auto glArguments = static_cast<GL45IndirectArgumentsBuffer*>(Bind(arguments));
+            glUseProgram(programHandle);
+            Enable(cshader.get(), programHandle);
+
+            // The arguments might have been written by a shader or a copy.
+            glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+            glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, glArguments->GetGLHandle());
+            glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+            ++mStatistics.numProgramBinds;
+            ++mStatistics.numDispatches;
+            glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+
             Disable(cshader.get(), programHandle);
             glUseProgram(0);
         }
@@ -1288,7 +1790,13 @@ uint64_t GL45Engine::DrawPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
 
     uint64_t numPixelsDrawn = 0;
     auto programHandle = gl4program->GetProgramHandle();
+    if (mInDrawBatch)
+    {
+        return DrawBatchPrimitive(vbuffer, ibuffer, effect, programHandle);
+    }
+
     glUseProgram(programHandle);
+    ++mStatistics.numProgramBinds;
 
     if (EnableShaders(effect, programHandle))
     {
@@ -1298,20 +1806,29 @@ uint64_t GL45Engine::DrawPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
         if (vbuffer->StandardUsage())
         {
             gl4VBuffer = static_cast<GL45VertexBuffer*>(Bind(vbuffer));
+            gl4VBuffer->RefreshRingCopy(mRingBuffer.get());
             GL45InputLayoutManager* manager = static_cast<GL45InputLayoutManager*>(mILMap.get());
             gl4Layout = manager->Bind(programHandle, gl4VBuffer->GetGLHandle(), vbuffer.get());
             gl4Layout->Enable();
+            if (gl4Layout->SetVertexData(gl4VBuffer->GetDrawHandle(), gl4VBuffer->GetDrawOffset()))
+            {
+                ++mStatistics.numBufferBinds;
+            }
         }
 
         // Enable the index buffer.
         GL45IndexBuffer* gl4IBuffer = nullptr;
+        GLintptr ibufferDrawOffset = 0;
         if (ibuffer->IsIndexed())
         {
             gl4IBuffer = static_cast<GL45IndexBuffer*>(Bind(ibuffer));
+            gl4IBuffer->RefreshRingCopy(mRingBuffer.get());
             gl4IBuffer->Enable();
+            ++mStatistics.numBufferBinds;
+            ibufferDrawOffset = gl4IBuffer->GetDrawOffset();
         }
 
-        numPixelsDrawn = DrawPrimitive(vbuffer.get(), ibuffer.get());
+        numPixelsDrawn = DrawPrimitive(vbuffer.get(), ibuffer.get(), ibufferDrawOffset);
 
         // Disable the vertex buffer and input layout.
         if (vbuffer->StandardUsage())
@@ -1332,3 +1849,239 @@ uint64_t GL45Engine::DrawPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
 
     return numPixelsDrawn;
 }
+
+uint64_t GL45Engine::DrawInstancedPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<VertexBuffer> const& instanceBuffer, std::shared_ptr<IndexBuffer> const& ibuffer,
+    std::shared_ptr<VisualEffect> const& effect)
+{
+    return DrawInstances(vbuffer, instanceBuffer, ibuffer, effect, nullptr, 0, 0);
+}
+
+uint64_t GL45Engine::DrawIndirect(std::shared_ptr<InstancedVisual> const& visual,
+    std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset,
+    unsigned int numDraws)
+{
+    LogAssert(visual != nullptr && arguments != nullptr, "Invalid input.");
+    auto const& vbuffer = visual->GetVertexBuffer();
+    auto const& instanceBuffer = visual->GetInstanceBuffer();
+    auto const& ibuffer = visual->GetIndexBuffer();
+    auto const& effect = visual->GetEffect();
+    if (vbuffer && instanceBuffer && ibuffer && effect && numDraws > 0)
+    {
+        return DrawInstances(vbuffer, instanceBuffer, ibuffer, effect, arguments, offset, numDraws);
+    }
+    return 0;
+}
+
+uint64_t GL45Engine::DrawInstances(std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<VertexBuffer> const& instanceBuffer, std::shared_ptr<IndexBuffer> const& ibuffer,
+    std::shared_ptr<VisualEffect> const& effect,
+    std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset,
+    unsigned int numDraws)
+{
+    GLSLVisualProgram* gl4program = dynamic_cast<GLSLVisualProgram*>(effect->GetProgram().get());
+    if (!gl4program)
+    {
+        LogError("A visual program must exist.");
+    }
+
+    LogAssert(vbuffer->StandardUsage() && instanceBuffer->StandardUsage(),
+        "Instanced drawing requires standard vertex and instance buffers.");
+
+    // The instanced input layout differs from the layouts of the draw
+    // batch, so the batch state is unbound and the batch is restarted
+    // after the draw.
+    bool const inDrawBatch = mInDrawBatch;
+    if (inDrawBatch)
+    {
+        EndDrawBatch();
+    }
+
+    uint64_t numPixelsDrawn = 0;
+    auto programHandle = gl4program->GetProgramHandle();
+    glUseProgram(programHandle);
+    ++mStatistics.numProgramBinds;
+
+    if (EnableShaders(effect, programHandle))
+    {
+        // Enable the vertex buffer, instance buffer and input layout.
+        GL45VertexBuffer* gl4VBuffer = static_cast<GL45VertexBuffer*>(Bind(vbuffer));
+        gl4VBuffer->RefreshRingCopy(mRingBuffer.get());
+        GL45VertexBuffer* gl4Instances = static_cast<GL45VertexBuffer*>(Bind(instanceBuffer));
+        gl4Instances->RefreshRingCopy(mRingBuffer.get());
+        GL45InputLayoutManager* manager = static_cast<GL45InputLayoutManager*>(mILMap.get());
+        GL45InputLayout* gl4Layout = manager->Bind(programHandle, gl4VBuffer->GetGLHandle(),
+            vbuffer.get(), gl4Instances->GetGLHandle(), instanceBuffer.get());
+        gl4Layout->Enable();
+        if (gl4Layout->SetVertexData(gl4VBuffer->GetDrawHandle(), gl4VBuffer->GetDrawOffset()))
+        {
+            ++mStatistics.numBufferBinds;
+        }
+        if (gl4Layout->SetInstanceData(gl4Instances->GetDrawHandle(), gl4Instances->GetDrawOffset()))
+        {
+            ++mStatistics.numBufferBinds;
+        }
+
+        // Enable the index buffer.
+        GL45IndexBuffer* gl4IBuffer = nullptr;
+        GLintptr ibufferDrawOffset = 0;
+        if (ibuffer->IsIndexed())
+        {
+            gl4IBuffer = static_cast<GL45IndexBuffer*>(Bind(ibuffer));
+            gl4IBuffer->RefreshRingCopy(mRingBuffer.get());
+            gl4IBuffer->Enable();
+            ++mStatistics.numBufferBinds;
+            ibufferDrawOffset = gl4IBuffer->GetDrawOffset();
+        }
+
+        if (arguments)
+        {
+            // The records refer to the start of the index data, so the
+            // index buffer cannot be drawn from the ring buffer.
+            LogAssert(ibufferDrawOffset == 0, "Indirect draws require an index buffer without a ring copy.");
+            auto gl4Arguments = static_cast<GL45IndirectArgumentsBuffer*>(Bind(arguments));
+            numPixelsDrawn = DrawPrimitive(vbuffer.get(), ibuffer.get(), 0, instanceBuffer.get(),
+                gl4Arguments->GetGLHandle(), static_cast<GLintptr>(offset),
+                static_cast<GLsizei>(numDraws));
+        }
+        else
+        {
+            numPixelsDrawn = DrawPrimitive(vbuffer.get(), ibuffer.get(), ibufferDrawOffset,
+                instanceBuffer.get());
+        }
+
+        gl4Layout->Disable();
+        if (gl4IBuffer)
+        {
+            gl4IBuffer->Disable();
+        }
+
+        DisableShaders(effect, programHandle);
+    }
+
+    glUseProgram(0);
+
+    if (inDrawBatch)
+    {
+        BeginDrawBatch();
+    }
+    return numPixelsDrawn;
+}
+
+void GL45Engine::BeginDrawBatch()
+{
+    mInDrawBatch = true;
+    mBatchEffect = nullptr;
+    mBatchProgram = 0;
+    mBatchLayout = nullptr;
+    mBatchIBuffer = nullptr;
+    mBatchIBufferHandle = 0;
+}
+
+void GL45Engine::EndDrawBatch()
+{
+    if (mBatchLayout)
+    {
+        mBatchLayout->Disable();
+    }
+
+    if (mBatchIBuffer)
+    {
+        mBatchIBuffer->Disable();
+    }
+
+    if (mBatchEffect)
+    {
+        DisableShaders(mBatchEffect, mBatchProgram);
+    }
+
+    glUseProgram(0);
+
+    mInDrawBatch = false;
+    mBatchEffect = nullptr;
+    mBatchProgram = 0;
+    mBatchLayout = nullptr;
+    mBatchIBuffer = nullptr;
+    mBatchIBufferHandle = 0;
+}
+
+uint64_t GL45Engine::DrawBatchPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<IndexBuffer> const& ibuffer, std::shared_ptr<VisualEffect> const& effect,
+    GLuint program)
+{
+    // Enable the program and the shader resources when they differ from
+    // those of the previous draw.
+    if (effect != mBatchEffect || program != mBatchProgram)
+    {
+        if (mBatchEffect)
+        {
+            DisableShaders(mBatchEffect, mBatchProgram);
+            mBatchEffect = nullptr;
+        }
+
+        if (program != mBatchProgram)
+        {
+            glUseProgram(program);
+            ++mStatistics.numProgramBinds;
+            mBatchProgram = program;
+        }
+
+        if (!EnableShaders(effect, program))
+        {
+            return 0;
+        }
+        mBatchEffect = effect;
+    }
+
+    // Enable the vertex buffer and input layout.  The index buffer binding
+    // is part of the vertex array state, so it must be enabled again when
+    // the input layout changes.
+    GL45InputLayout* gl4Layout = nullptr;
+    GL45VertexBuffer* gl4VBuffer = nullptr;
+    if (vbuffer->StandardUsage())
+    {
+        gl4VBuffer = static_cast<GL45VertexBuffer*>(Bind(vbuffer));
+        gl4VBuffer->RefreshRingCopy(mRingBuffer.get());
+        GL45InputLayoutManager* manager = static_cast<GL45InputLayoutManager*>(mILMap.get());
+        gl4Layout = manager->Bind(program, gl4VBuffer->GetGLHandle(), vbuffer.get());
+    }
+
+    if (gl4Layout != mBatchLayout)
+    {
+        if (gl4Layout)
+        {
+            gl4Layout->Enable();
+        }
+        else
+        {
+            mBatchLayout->Disable();
+        }
+        mBatchLayout = gl4Layout;
+        mBatchIBuffer = nullptr;
+        mBatchIBufferHandle = 0;
+    }
+
+    if (gl4Layout && gl4Layout->SetVertexData(gl4VBuffer->GetDrawHandle(), gl4VBuffer->GetDrawOffset()))
+    {
+        ++mStatistics.numBufferBinds;
+    }
+
+    // Enable the index buffer.  Its data can move between the buffer and
+    // the ring buffer, so the bound buffer is compared with its handle.
+    GLintptr ibufferDrawOffset = 0;
+    if (ibuffer->IsIndexed())
+    {
+        auto gl4IBuffer = static_cast<GL45IndexBuffer*>(Bind(ibuffer));
+        gl4IBuffer->RefreshRingCopy(mRingBuffer.get());
+        if (gl4IBuffer != mBatchIBuffer || gl4IBuffer->GetDrawHandle() != mBatchIBufferHandle)
+        {
+            gl4IBuffer->Enable();
+            ++mStatistics.numBufferBinds;
+            mBatchIBuffer = gl4IBuffer;
+            mBatchIBufferHandle = gl4IBuffer->GetDrawHandle();
+        }
+        ibufferDrawOffset = gl4IBuffer->GetDrawOffset();
+    }
+
+    return DrawPrimitive(vbuffer.get(), ibuffer.get(), ibufferDrawOffset);
+}
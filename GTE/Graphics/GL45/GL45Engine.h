@@ -3,17 +3,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/GraphicsEngine.h>
 #include <Graphics/GL45/GL45InputLayoutManager.h>
+#include <Graphics/GL45/GL45RingBuffer.h>
 
 namespace gte
 {
     class GL45GraphicsObject;
     class GL45DrawTarget;
+    class GL45IndexBuffer;
+    class GL45InputLayout;
 
     class GL45Engine : public GraphicsEngine
     {
@@ -39,6 +42,27 @@ namespace gte
         virtual bool IsActive() const = 0;
         virtual void MakeActive() = 0;
 
+        // Support for a persistently mapped ring buffer (see GL45RingBuffer)
+        // that receives the updates of the DYNAMIC_UPDATE constant, vertex
+        // and index buffers instead of glBufferSubData. Call
+        // CreateRingBuffer once after initialization, with numBytesPerFrame
+        // at least the total size of the dynamic buffers used in a frame,
+        // and call BeginFrame before the updates and draws of each frame and
+        // EndFrame after them (for example, after DisplayColorBuffer). A
+        // dynamic buffer used in a frame in which it was not updated is
+        // copied to the ring again. When the ring of a frame is full, the
+        // updates are copied to the buffers. Applications can also
+        // allocate per-frame data of their own with GetRingBuffer.
+        bool CreateRingBuffer(size_t numBytesPerFrame, unsigned int numFrames = 3);
+
+        inline GL45RingBuffer* GetRingBuffer() const
+        {
+            return mRingBuffer.get();
+        }
+
+        void BeginFrame();
+        void EndFrame();
+
     protected:
         // Helpers for construction and destruction.
         virtual bool Initialize(int requiredMajor, int requiredMinor, bool useDepth24Stencil8, bool saveDriverInfo);
@@ -52,8 +76,44 @@ namespace gte
         bool mMeetsRequirements;
 
     private:
-        // Support for drawing.
-        uint64_t DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer const* ibuffer);
+        // Support for drawing.  The primitive is drawn once for each active
+        // element of the instance buffer when it is not null.  When the
+        // handle of an indirect arguments buffer is not 0, the numDraws
+        // records starting at argumentsOffset are drawn instead.
+        uint64_t DrawPrimitive(VertexBuffer const* vbuffer, IndexBuffer const* ibuffer,
+            GLintptr ibufferDrawOffset, VertexBuffer const* instanceBuffer = nullptr,
+            GLuint argumentsHandle = 0, GLintptr argumentsOffset = 0, GLsizei numDraws = 0);
+
+        // Support for DrawInstancedPrimitive and DrawIndirect.
+        uint64_t DrawInstances(std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<VertexBuffer> const& instanceBuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments,
+            unsigned int offset, unsigned int numDraws);
+
+        // Support for the draw batches of GraphicsEngine.  The program,
+        // shader resources, input layout and index buffer of the last draw
+        // remain bound and are bound again only when a draw uses different
+        // ones.
+        virtual void BeginDrawBatch() override;
+        virtual void EndDrawBatch() override;
+        uint64_t DrawBatchPrimitive(std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect, GLuint program);
+
+        bool mInDrawBatch;
+        std::shared_ptr<VisualEffect> mBatchEffect;
+        GLuint mBatchProgram;
+        GL45InputLayout* mBatchLayout;
+        GL45IndexBuffer* mBatchIBuffer;
+        GLuint mBatchIBufferHandle;
+
+        std::unique_ptr<GL45RingBuffer> mRingBuffer;
+
+        // The query objects of the timestamp sets. The handle of a set is its
+        // index plus 1. The slots of destroyed sets are empty and reused.
+        std::vector<std::vector<GLuint>> mTimestampSets;
 
         // Support for enabling and disabling resources used by shaders.
         bool EnableShaders(std::shared_ptr<VisualEffect> const& effect, GLuint program);
@@ -75,6 +135,37 @@ namespace gte
         void EnableSamplers(Shader const* shader, GLuint program);
         void DisableSamplers(Shader const* shader, GLuint program);
 
+        // Shadow state of the uniform buffer, texture and sampler units.
+        // The Enable* functions request the bindings of a shader, which
+        // CommitBindings issues for the units whose bound objects differ,
+        // using multi-bind calls for consecutive units when available. The
+        // Disable* functions release the units but leave the objects bound,
+        // so the next draw that uses the same objects does not bind them
+        // again. A handle of 0 is an unbound or unknown unit. The uniform
+        // buffers are bound to ranges [offset,offset+size) of the buffers,
+        // because the data of several constant buffers can be in the ring
+        // buffer.
+        struct Binding
+        {
+            GLuint unit;
+            GLenum target;
+            GLuint handle;
+            GLintptr offset;
+            GLsizeiptr size;
+        };
+
+        void RequestBinding(std::vector<Binding>& units, std::vector<Binding>& pending,
+            GLuint unit, GLenum target, GLuint handle, GLintptr offset = 0, GLsizeiptr size = 0);
+        void CommitBindings();
+        virtual void OnUnbind(GEObject* geObject) override;
+
+        std::vector<Binding> mUniformBufferUnits, mTextureUnits, mSamplerUnits;
+        std::vector<Binding> mPendingUniformBuffers, mPendingTextures, mPendingSamplers;
+        std::vector<GLuint> mMultiBindHandles;
+        std::vector<GLintptr> mMultiBindOffsets;
+        std::vector<GLsizeiptr> mMultiBindSizes;
+        bool mUseMultiBind;
+
         // A front-end object (hidden from the user) is created for each
         // atomic counter buffer object declared in use for a shader that is
         // executed.  After execution, these objects are left for use the
@@ -164,6 +255,25 @@ namespace gte
         virtual void SetDepthStencilState(std::shared_ptr<DepthStencilState> const& state) override;
         virtual void SetRasterizerState(std::shared_ptr<RasterizerState> const& state) override;
 
+        // Support for asynchronous occlusion queries and conditional
+        // drawing.
+        virtual unsigned int CreateOcclusionQuery() override;
+        virtual void DestroyOcclusionQuery(unsigned int query) override;
+        virtual void BeginQuery(unsigned int query) override;
+        virtual void EndQuery(unsigned int query) override;
+        virtual bool GetQueryResult(unsigned int query, uint64_t& numSamples) override;
+        virtual void BeginConditionalDraw(unsigned int query) override;
+        virtual void EndConditionalDraw() override;
+
+        // Support for GPU timing with timestamp queries.
+        virtual unsigned int CreateTimestampSet(unsigned int numTimestamps) override;
+        virtual void DestroyTimestampSet(unsigned int set) override;
+        virtual void BeginTimestamps(unsigned int set) override;
+        virtual void WriteTimestamp(unsigned int set, unsigned int i) override;
+        virtual void EndTimestamps(unsigned int set) override;
+        virtual bool GetTimestamps(unsigned int set, unsigned int numWritten,
+            std::vector<uint64_t>& nanoseconds) override;
+
         // Support for drawing to offscreen memory (i.e. not to the back
         // buffer).  The DrawTarget object encapsulates render targets (color
         // information) and depth-stencil target.
@@ -184,6 +294,9 @@ namespace gte
         virtual bool CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray) override;
         virtual bool CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray, unsigned int item, unsigned int level) override;
 
+        // Support for mipmap streaming.
+        virtual bool UpdateResidency(std::shared_ptr<TextureSingle> const& texture) override;
+
         // Support for copying from GPU to CPU via staging memory.
         virtual bool CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer) override;
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture) override;
@@ -191,6 +304,12 @@ namespace gte
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray) override;
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray, unsigned int item, unsigned int level) override;
 
+        // Support for copying from GPU to CPU in two steps.
+        virtual bool StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture) override;
+        virtual bool StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level) override;
+        virtual bool CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture) override;
+        virtual bool CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level) override;
+
         // Support for copying from GPU to GPU directly.  TODO: We will
         // improve on the feature set for such copies later.  For now, the
         // restrictions are that the resources are different, of the same
@@ -231,6 +350,16 @@ namespace gte
         virtual void Execute(std::shared_ptr<ComputeProgram> const& program,
             unsigned int numXGroups, unsigned int numYGroups, unsigned int numZGroups) override;
 
+        virtual void Execute(std::shared_ptr<ComputeProgram> const& program,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset) override;
+
+        // Draw with arguments read from the indirect arguments buffer.  The
+        // records are drawn by glMultiDrawElementsIndirect or
+        // glMultiDrawArraysIndirect.
+        virtual uint64_t DrawIndirect(std::shared_ptr<InstancedVisual> const& visual,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments,
+            unsigned int offset, unsigned int numDraws) override;
+
         // Have the CPU wait until the GPU finishes its current command
         // buffer.
         virtual void WaitForFinish() override;
@@ -247,5 +376,11 @@ namespace gte
             std::shared_ptr<VertexBuffer> const& vbuffer,
             std::shared_ptr<IndexBuffer> const& ibuffer,
             std::shared_ptr<VisualEffect> const& effect) override;
+
+        virtual uint64_t DrawInstancedPrimitive(
+            std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<VertexBuffer> const& instanceBuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect) override;
     };
 }
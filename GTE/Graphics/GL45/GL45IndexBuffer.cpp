@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45IndexBuffer.h>
@@ -29,7 +29,7 @@ std::shared_ptr<GEObject> GL45IndexBuffer::Create(void*, GraphicsObject const* o
 
 void GL45IndexBuffer::Enable()
 {
-    glBindBuffer(mType, mGLHandle);
+    glBindBuffer(mType, mDrawHandle);
 }
 
 void GL45IndexBuffer::Disable()
@@ -0,0 +1,28 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GL45/GTGraphicsGL45PCH.h>
+#include <Graphics/GL45/GL45IndirectArgumentsBuffer.h>
+using namespace gte;
+
+GL45IndirectArgumentsBuffer::GL45IndirectArgumentsBuffer(IndirectArgumentsBuffer const* iabuffer)
+    :
+    GL45Buffer(iabuffer, GL_DISPATCH_INDIRECT_BUFFER)
+{
+    Initialize();
+}
+
+std::shared_ptr<GEObject> GL45IndirectArgumentsBuffer::Create(void*, GraphicsObject const* object)
+{
+    if (object->GetType() == GT_INDIRECT_ARGUMENTS_BUFFER)
+    {
+        return std::make_shared<GL45IndirectArgumentsBuffer>(
+            static_cast<IndirectArgumentsBuffer const*>(object));
+    }
+
+    LogError("Invalid object type.");
+}
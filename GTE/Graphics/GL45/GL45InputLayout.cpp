@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Mathematics/Logger.h>
@@ -21,6 +21,10 @@ GL45InputLayout::GL45InputLayout(GLuint programHandle, GLuint vbufferHandle,
     :
     mProgramHandle(programHandle),
     mVBufferHandle(vbufferHandle),
+    mVBufferOffset(0),
+    mInstanceHandle(0),
+    mInstanceOffset(0),
+    mNumVertexAttributes(0),
     mNumAttributes(0)
 {
     glGenVertexArrays(1, &mVArrayHandle);
@@ -29,33 +33,40 @@ GL45InputLayout::GL45InputLayout(GLuint programHandle, GLuint vbufferHandle,
     std::memset(&mAttributes[0], 0, VA_MAX_ATTRIBUTES*sizeof(mAttributes[0]));
     if (vbuffer)
     {
-        VertexFormat const& format = vbuffer->GetFormat();
-        mNumAttributes = format.GetNumAttributes();
-        for (int i = 0; i < mNumAttributes; ++i)
-        {
-            Attribute& attribute = mAttributes[i];
-
-            DFType type;
-            unsigned int unit, offset;
-            format.GetAttribute(i, attribute.semantic, type, unit, offset);
-
-            attribute.numChannels = static_cast<GLint>(
-                DataFormat::GetNumChannels(type));
-            attribute.channelType =
-                msChannelType[DataFormat::GetChannelType(type)];
-            attribute.normalize = static_cast<GLboolean>(
-                DataFormat::ConvertChannel(type) ? 1 : 0);
-            attribute.location = i;  // layouts must be zero-based sequential
-            attribute.offset = static_cast<GLintptr>(offset);
-            attribute.stride = static_cast<GLsizei>(format.GetVertexSize());
-
-            glEnableVertexAttribArray(attribute.location);
-            glBindVertexBuffer(i, mVBufferHandle, attribute.offset,
-                attribute.stride);
-            glVertexAttribFormat(attribute.location, attribute.numChannels,
-                attribute.channelType, attribute.normalize, 0);
-            glVertexAttribBinding(attribute.location, i);
-        }
+        AddAttributes(mVBufferHandle, vbuffer, 0);
+        mNumVertexAttributes = mNumAttributes;
+        glBindVertexArray(0);
+    }
+    else
+    {
+        LogError("Invalid inputs to GL45InputLayout constructor.");
+    }
+}
+
+GL45InputLayout::GL45InputLayout(GLuint programHandle, GLuint vbufferHandle,
+    VertexBuffer const* vbuffer, GLuint instanceHandle, VertexBuffer const* instanceBuffer)
+    :
+    mProgramHandle(programHandle),
+    mVBufferHandle(vbufferHandle),
+    mVBufferOffset(0),
+    mInstanceHandle(instanceHandle),
+    mInstanceOffset(0),
+    mNumVertexAttributes(0),
+    mNumAttributes(0)
+{
+    glGenVertexArrays(1, &mVArrayHandle);
+    glBindVertexArray(mVArrayHandle);
+
+    std::memset(&mAttributes[0], 0, VA_MAX_ATTRIBUTES*sizeof(mAttributes[0]));
+    if (vbuffer && instanceBuffer)
+    {
+        LogAssert(vbuffer->GetFormat().GetNumAttributes() +
+            instanceBuffer->GetFormat().GetNumAttributes() <= VA_MAX_ATTRIBUTES,
+            "Too many vertex and instance attributes.");
+
+        AddAttributes(mVBufferHandle, vbuffer, 0);
+        mNumVertexAttributes = mNumAttributes;
+        AddAttributes(mInstanceHandle, instanceBuffer, 1);
         glBindVertexArray(0);
     }
     else
@@ -74,6 +85,74 @@ void GL45InputLayout::Disable()
     glBindVertexArray(0);
 }
 
+bool GL45InputLayout::SetVertexData(GLuint vbufferHandle, GLintptr vbufferOffset)
+{
+    if (vbufferHandle != mVBufferHandle || vbufferOffset != mVBufferOffset)
+    {
+        mVBufferHandle = vbufferHandle;
+        mVBufferOffset = vbufferOffset;
+        for (int i = 0; i < mNumVertexAttributes; ++i)
+        {
+            Attribute const& attribute = mAttributes[i];
+            glBindVertexBuffer(i, mVBufferHandle, mVBufferOffset + attribute.offset,
+                attribute.stride);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool GL45InputLayout::SetInstanceData(GLuint instanceHandle, GLintptr instanceOffset)
+{
+    if (instanceHandle != mInstanceHandle || instanceOffset != mInstanceOffset)
+    {
+        mInstanceHandle = instanceHandle;
+        mInstanceOffset = instanceOffset;
+        for (int i = mNumVertexAttributes; i < mNumAttributes; ++i)
+        {
+            Attribute const& attribute = mAttributes[i];
+            glBindVertexBuffer(i, mInstanceHandle, mInstanceOffset + attribute.offset,
+                attribute.stride);
+        }
+        return true;
+    }
+    return false;
+}
+
+void GL45InputLayout::AddAttributes(GLuint bufferHandle, VertexBuffer const* buffer,
+    GLuint divisor)
+{
+    VertexFormat const& format = buffer->GetFormat();
+    int const numAttributes = format.GetNumAttributes();
+    for (int j = 0; j < numAttributes; ++j)
+    {
+        int const i = mNumAttributes++;
+        Attribute& attribute = mAttributes[i];
+
+        DFType type;
+        unsigned int unit, offset;
+        format.GetAttribute(j, attribute.semantic, type, unit, offset);
+
+        attribute.numChannels = static_cast<GLint>(
+            DataFormat::GetNumChannels(type));
+        attribute.channelType =
+            msChannelType[DataFormat::GetChannelType(type)];
+        attribute.normalize = static_cast<GLboolean>(
+            DataFormat::ConvertChannel(type) ? 1 : 0);
+        attribute.location = i;  // layouts must be zero-based sequential
+        attribute.offset = static_cast<GLintptr>(offset);
+        attribute.stride = static_cast<GLsizei>(format.GetVertexSize());
+
+        glEnableVertexAttribArray(attribute.location);
+        glBindVertexBuffer(i, bufferHandle, attribute.offset,
+            attribute.stride);
+        glVertexAttribFormat(attribute.location, attribute.numChannels,
+            attribute.channelType, attribute.normalize, 0);
+        glVertexAttribBinding(attribute.location, i);
+        glVertexBindingDivisor(i, divisor);
+    }
+}
+
 
 GLenum const GL45InputLayout::msChannelType[] =
 {
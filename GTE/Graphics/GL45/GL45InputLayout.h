@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -19,13 +19,37 @@ namespace gte
         ~GL45InputLayout();
         GL45InputLayout(GLuint programHandle, GLuint vbufferHandle, VertexBuffer const* vbuffer);
 
+        // Construction for instanced drawing. The attributes of the
+        // instance buffer follow those of the vertex buffer, so their
+        // locations are sequential starting at the number of vertex
+        // attributes, and they advance once per instance.
+        GL45InputLayout(GLuint programHandle, GLuint vbufferHandle, VertexBuffer const* vbuffer,
+            GLuint instanceHandle, VertexBuffer const* instanceBuffer);
+
         // Support for drawing geometric primitives.
         void Enable();
         void Disable();
 
+        // Bind the vertex data at the specified offset of the specified
+        // buffer, which is the vertex buffer or the ring buffer of the
+        // engine (see GL45Buffer::GetDrawHandle). The input layout must be
+        // enabled. The return value is 'false' when the data is already
+        // bound.
+        bool SetVertexData(GLuint vbufferHandle, GLintptr vbufferOffset);
+
+        // The same as SetVertexData but for the instance buffer.
+        bool SetInstanceData(GLuint instanceHandle, GLintptr instanceOffset);
+
     private:
+        // Append the attributes of the buffer and bind them to the vertex
+        // array.
+        void AddAttributes(GLuint bufferHandle, VertexBuffer const* buffer, GLuint divisor);
+
         GLuint mProgramHandle;
         GLuint mVBufferHandle;
+        GLintptr mVBufferOffset;
+        GLuint mInstanceHandle;
+        GLintptr mInstanceOffset;
         GLuint mVArrayHandle;
 
         struct Attribute
@@ -39,6 +63,7 @@ namespace gte
             GLsizei stride;
         };
 
+        int mNumVertexAttributes;
         int mNumAttributes;
         Attribute mAttributes[VA_MAX_ATTRIBUTES];
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Mathematics/Logger.h>
@@ -27,10 +27,11 @@ GL45InputLayout* GL45InputLayoutManager::Bind(GLuint programHandle,
     {
         if (vbuffer)
         {
-            if (!mMap.Get(std::make_pair(vbuffer, programHandle), layout))
+            LayoutKey const key(vbuffer, nullptr, programHandle);
+            if (!mMap.Get(key, layout))
             {
                 layout = std::make_shared<GL45InputLayout>(programHandle, vbufferHandle, vbuffer);
-                mMap.Insert(std::make_pair(vbuffer, programHandle), layout);
+                mMap.Insert(key, layout);
             }
         }
         // else: A null vertex buffer is passed when an effect wants to
@@ -43,11 +44,40 @@ GL45InputLayout* GL45InputLayoutManager::Bind(GLuint programHandle,
     }
 }
 
+GL45InputLayout* GL45InputLayoutManager::Bind(GLuint programHandle,
+    GLuint vbufferHandle, VertexBuffer const* vbuffer, GLuint instanceHandle,
+    VertexBuffer const* instanceBuffer)
+{
+    std::shared_ptr<GL45InputLayout> layout;
+    if (programHandle)
+    {
+        if (vbuffer && instanceBuffer)
+        {
+            LayoutKey const key(vbuffer, instanceBuffer, programHandle);
+            if (!mMap.Get(key, layout))
+            {
+                layout = std::make_shared<GL45InputLayout>(programHandle, vbufferHandle,
+                    vbuffer, instanceHandle, instanceBuffer);
+                mMap.Insert(key, layout);
+            }
+            return layout.get();
+        }
+        else
+        {
+            LogError("Vertex buffer and instance buffer must be nonnull.");
+        }
+    }
+    else
+    {
+        LogError("Program must exist.");
+    }
+}
+
 bool GL45InputLayoutManager::Unbind(VertexBuffer const* vbuffer)
 {
     if (vbuffer)
     {
-        std::vector<VBPPair> matches;
+        std::vector<LayoutKey> matches;
         mMap.GatherMatch(vbuffer, matches);
         for (auto match : matches)
         {
@@ -78,13 +108,13 @@ bool GL45InputLayoutManager::HasElements() const
 }
 
 void GL45InputLayoutManager::LayoutMap::GatherMatch(
-    VertexBuffer const* vbuffer, std::vector<VBPPair>& matches)
+    VertexBuffer const* vbuffer, std::vector<LayoutKey>& matches)
 {
     mMutex.lock();
     {
         for (auto vbp : mMap)
         {
-            if (vbuffer == vbp.first.first)
+            if (vbuffer == std::get<0>(vbp.first) || vbuffer == std::get<1>(vbp.first))
             {
                 matches.push_back(vbp.first);
             }
@@ -3,13 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/GEInputLayoutManager.h>
 #include <Graphics/GL45/GL45InputLayout.h>
 #include <Mathematics/ThreadSafeMap.h>
+#include <tuple>
 
 namespace gte
 {
@@ -21,26 +22,30 @@ namespace gte
         GL45InputLayoutManager() = default;
 
         // Management functions.  The Unbind(vbuffer) removes all layouts that
-        // involve vbuffer.  The Unbind(vshader) is stubbed out because GL45
+        // involve vbuffer, whether as vertex buffer or instance buffer.  The Unbind(vshader) is stubbed out because GL45
         // does not require it, but we wish to have
         // Unbind(GraphicsObject const*) as a base-class GraphicsEngine
         // function.
         GL45InputLayout* Bind(GLuint programHandle, GLuint vbufferHandle, VertexBuffer const* vbuffer);
+        GL45InputLayout* Bind(GLuint programHandle, GLuint vbufferHandle, VertexBuffer const* vbuffer,
+            GLuint instanceHandle, VertexBuffer const* instanceBuffer);
         virtual bool Unbind(VertexBuffer const* vbuffer) override;
         virtual bool Unbind(Shader const* vshader) override;
         virtual void UnbindAll() override;
         virtual bool HasElements() const override;
 
     private:
-        typedef std::pair<VertexBuffer const*, GLuint> VBPPair;
+        // The key is (vertex buffer, instance buffer, program), where the
+        // instance buffer is null for layouts without instancing.
+        typedef std::tuple<VertexBuffer const*, VertexBuffer const*, GLuint> LayoutKey;
 
-        class LayoutMap : public ThreadSafeMap<VBPPair, std::shared_ptr<GL45InputLayout>>
+        class LayoutMap : public ThreadSafeMap<LayoutKey, std::shared_ptr<GL45InputLayout>>
         {
         public:
             virtual ~LayoutMap() = default;
             LayoutMap() = default;
 
-            void GatherMatch(VertexBuffer const* vbuffer, std::vector<VBPPair>& matches);
+            void GatherMatch(VertexBuffer const* vbuffer, std::vector<LayoutKey>& matches);
         };
 
         LayoutMap mMap;
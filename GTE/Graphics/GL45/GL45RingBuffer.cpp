@@ -0,0 +1,114 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GL45/GTGraphicsGL45PCH.h>
+#include <Graphics/GL45/GL45RingBuffer.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+using namespace gte;
+
+GL45RingBuffer::~GL45RingBuffer()
+{
+    for (auto fence : mFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mGLHandle);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &mGLHandle);
+}
+
+GL45RingBuffer::GL45RingBuffer(GLsizeiptr numBytesPerFrame, unsigned int numFrames)
+    :
+    mGLHandle(0),
+    mData(nullptr),
+    mNumBytesPerFrame(0),
+    mAlignment(16),
+    mNumFrames(std::max(numFrames, 1u)),
+    mFrame(0),
+    mRegionBegin(0),
+    mNumBytesUsed(0),
+    mFences(mNumFrames, nullptr)
+{
+    LogAssert(numBytesPerFrame > 0, "Invalid number of bytes.");
+
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    mAlignment = std::max(mAlignment, static_cast<GLintptr>(alignment));
+    mNumBytesPerFrame = (numBytesPerFrame + mAlignment - 1) / mAlignment * mAlignment;
+
+    GLsizeiptr const numBytes = mNumBytesPerFrame * static_cast<GLsizeiptr>(mNumFrames);
+    GLbitfield const flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glGenBuffers(1, &mGLHandle);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mGLHandle);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, numBytes, nullptr, flags);
+    mData = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, numBytes, flags));
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    LogAssert(mData != nullptr, "Failed to map the ring buffer.");
+}
+
+void GL45RingBuffer::BeginFrame()
+{
+    ++mFrame;
+    size_t const region = static_cast<size_t>(mFrame % mNumFrames);
+    mRegionBegin = static_cast<GLintptr>(region) * mNumBytesPerFrame;
+    mNumBytesUsed = 0;
+
+    GLsync& fence = mFences[region];
+    if (fence)
+    {
+        // The first wait flushes the commands so that the fence is
+        // eventually signaled.
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        GLuint64 const timeout = 1000000000;  // nanoseconds
+        for (;;)
+        {
+            GLenum result = glClientWaitSync(fence, flags, timeout);
+            if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+            {
+                break;
+            }
+            if (result == GL_WAIT_FAILED)
+            {
+                LogWarning("Failed to wait for the ring buffer fence.");
+                break;
+            }
+            flags = 0;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
+void GL45RingBuffer::EndFrame()
+{
+    GLsync& fence = mFences[static_cast<size_t>(mFrame % mNumFrames)];
+    if (fence)
+    {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool GL45RingBuffer::Allocate(GLsizeiptr numBytes, GLintptr& offset, char*& data)
+{
+    GLsizeiptr const alignedNumBytes = (numBytes + mAlignment - 1) / mAlignment * mAlignment;
+    if (numBytes <= 0 || alignedNumBytes > mNumBytesPerFrame - mNumBytesUsed)
+    {
+        return false;
+    }
+
+    offset = mRegionBegin + mNumBytesUsed;
+    data = mData + offset;
+    mNumBytesUsed += alignedNumBytes;
+    return true;
+}
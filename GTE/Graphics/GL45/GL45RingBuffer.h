@@ -0,0 +1,87 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GL45/GL45.h>
+#include <cstdint>
+#include <vector>
+
+// A buffer that is persistently mapped (glBufferStorage and
+// glMapBufferRange with GL_MAP_PERSISTENT_BIT and GL_MAP_COHERENT_BIT) and
+// partitioned into numFrames regions, one region per frame. The data of a
+// frame are written directly to the mapped memory of its region without
+// glBufferSubData calls, and each frame allocates from its region in
+// increasing order. EndFrame places a fence after the commands of the
+// frame, and BeginFrame waits for the fence of the region it is about to
+// reuse, which was placed numFrames frames earlier, so the GPU is never
+// reading the data that the CPU overwrites. The allocations of a frame are
+// valid only during that frame. OpenGL 4.4 or later is required.
+
+namespace gte
+{
+    class GL45RingBuffer
+    {
+    public:
+        // Construction and destruction. The offsets of the allocations are
+        // multiples of the uniform buffer offset alignment, so an allocation
+        // can be bound as a uniform buffer, vertex buffer or index buffer.
+        ~GL45RingBuffer();
+        GL45RingBuffer(GLsizeiptr numBytesPerFrame, unsigned int numFrames = 3);
+
+        // Member access.
+        inline GLuint GetGLHandle() const
+        {
+            return mGLHandle;
+        }
+
+        inline GLsizeiptr GetNumBytesPerFrame() const
+        {
+            return mNumBytesPerFrame;
+        }
+
+        inline unsigned int GetNumFrames() const
+        {
+            return mNumFrames;
+        }
+
+        // The number of calls to BeginFrame.
+        inline uint64_t GetFrame() const
+        {
+            return mFrame;
+        }
+
+        // Start a new frame, waiting for the GPU to finish reading the
+        // region of the frame when necessary.
+        void BeginFrame();
+
+        // Place the fence for the region of the current frame after the
+        // commands that read it.
+        void EndFrame();
+
+        // Allocate numBytes bytes from the region of the current frame. The
+        // function returns 'true' and the offset of the allocation in the
+        // buffer and a pointer to its mapped memory when the region has
+        // enough bytes remaining; otherwise, it returns 'false'.
+        bool Allocate(GLsizeiptr numBytes, GLintptr& offset, char*& data);
+
+    private:
+        GLuint mGLHandle;
+        char* mData;
+        GLsizeiptr mNumBytesPerFrame;
+        GLintptr mAlignment;
+        unsigned int mNumFrames;
+        uint64_t mFrame;
+
+        // The allocations of the current frame are in
+        // [mRegionBegin,mRegionBegin+mNumBytesPerFrame), of which
+        // mNumBytesUsed bytes have been allocated.
+        GLintptr mRegionBegin;
+        GLsizeiptr mNumBytesUsed;
+        std::vector<GLsync> mFences;
+    };
+}
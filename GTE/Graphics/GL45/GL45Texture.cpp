@@ -3,12 +3,26 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45Texture.h>
 using namespace gte;
 
+// The S3TC formats are not in the core profile. They are provided by the
+// extensions GL_EXT_texture_compression_s3tc and GL_EXT_texture_sRGB that
+// all desktop drivers support.
+#if !defined(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT)
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#if !defined(GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT)
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT 0x8C4E
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 GL45Texture::GL45Texture(Texture const* texture, GLenum target, GLenum targetBinding)
     :
     GL45Resource(texture),
@@ -93,21 +107,21 @@ GLuint const GL45Texture::msGLTextureInternalFormat[DF_NUM_FORMATS]
     GL_RGB9_E5,  // DF_R9G9B9E5_SHAREDEXP
     0,  // DF_R8G8_B8G8_UNORM
     0,  // DF_G8R8_G8B8_UNORM
-    0,  // DF_BC1_TYPELESS
-    0,  // DF_BC1_UNORM
-    0,  // DF_BC1_UNORM_SRGB
-    0,  // DF_BC2_TYPELESS
-    0,  // DF_BC2_UNORM
-    0,  // DF_BC2_UNORM_SRGB
-    0,  // DF_BC3_TYPELESS
-    0,  // DF_BC3_UNORM
-    0,  // DF_BC3_UNORM_SRGB
-    0,  // DF_BC4_TYPELESS
-    0,  // DF_BC4_UNORM
-    0,  // DF_BC4_SNORM
-    0,  // DF_BC5_TYPELESS
-    0,  // DF_BC5_UNORM
-    0,  // DF_BC5_SNORM
+    GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,  // DF_BC1_TYPELESS
+    GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,  // DF_BC1_UNORM
+    GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,  // DF_BC1_UNORM_SRGB
+    GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,  // DF_BC2_TYPELESS
+    GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,  // DF_BC2_UNORM
+    GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3_EXT,  // DF_BC2_UNORM_SRGB
+    GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,  // DF_BC3_TYPELESS
+    GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,  // DF_BC3_UNORM
+    GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,  // DF_BC3_UNORM_SRGB
+    GL_COMPRESSED_RED_RGTC1,  // DF_BC4_TYPELESS
+    GL_COMPRESSED_RED_RGTC1,  // DF_BC4_UNORM
+    GL_COMPRESSED_SIGNED_RED_RGTC1,  // DF_BC4_SNORM
+    GL_COMPRESSED_RG_RGTC2,  // DF_BC5_TYPELESS
+    GL_COMPRESSED_RG_RGTC2,  // DF_BC5_UNORM
+    GL_COMPRESSED_SIGNED_RG_RGTC2,  // DF_BC5_SNORM
     GL_RGB565,  // DF_B5G6R5_UNORM
     GL_RGB5_A1,  // DF_B5G5R5A1_UNORM
     GL_RGBA8,  // DF_B8G8R8A8_UNORM
@@ -117,12 +131,12 @@ GLuint const GL45Texture::msGLTextureInternalFormat[DF_NUM_FORMATS]
     GL_RGBA8,  // DF_B8G8R8A8_UNORM_SRGB
     0,  // DF_B8G8R8X8_TYPELESS
     GL_RGBA8,  // DF_B8G8R8X8_UNORM_SRGB
-    0,  // DF_BC6H_TYPELESS
-    0,  // DF_BC6H_UF16
-    0,  // DF_BC6H_SF16
-    0,  // DF_BC7_TYPELESS
-    0,  // DF_BC7_UNORM
-    0,  // DF_BC7_UNORM_SRGB
+    GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,  // DF_BC6H_TYPELESS
+    GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,  // DF_BC6H_UF16
+    GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT,  // DF_BC6H_SF16
+    GL_COMPRESSED_RGBA_BPTC_UNORM,  // DF_BC7_TYPELESS
+    GL_COMPRESSED_RGBA_BPTC_UNORM,  // DF_BC7_UNORM
+    GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,  // DF_BC7_UNORM_SRGB
     // DX11.1 formats (TODO: Determine number of channels)
     0,  // DF_AYUV
     0,  // DF_Y410
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45Texture2.h>
@@ -22,6 +22,9 @@ GL45Texture2::GL45Texture2(Texture2 const* texture)
     glGenTextures(1, &mGLHandle);
     glBindTexture(GL_TEXTURE_2D, mGLHandle);
 
+    // Request sparse storage for a partially resident texture.
+    PrepareSparseStorage();
+
     // Allocate (immutable) texture storage for all levels.
     auto const width = texture->GetDimension(0);
     auto const height = texture->GetDimension(1);
@@ -62,10 +65,18 @@ void GL45Texture2::LoadTextureLevel(unsigned int level, void const* data)
     auto texture = GetTexture();
     if (texture && level < texture->GetNumLevels())
     {
-        auto width = texture->GetDimension(0);
-        auto height = texture->GetDimension(1);
+        auto width = texture->GetDimensionFor(level, 0);
+        auto height = texture->GetDimensionFor(level, 1);
 
-        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height,
-            mExternalFormat, mExternalType, data);
+        if (texture->IsCompressed())
+        {
+            glCompressedTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height,
+                mInternalFormat, texture->GetNumBytesFor(level), data);
+        }
+        else
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, width, height,
+                mExternalFormat, mExternalType, data);
+        }
     }
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45Texture2Array.h>
@@ -66,7 +66,15 @@ void GL45Texture2Array::LoadTextureLevel(unsigned int item, unsigned int level,
         // For Texture2Array, use the 3D calls where the slice (or item) is
         // the third dimension.  Only updating one slice for the specified
         // level.
-        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, item, width, height, 1,
-            mExternalFormat, mExternalType, data);
+        if (texture->IsCompressed())
+        {
+            glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, item, width, height, 1,
+                mInternalFormat, texture->GetNumBytesFor(level), data);
+        }
+        else
+        {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, item, width, height, 1,
+                mExternalFormat, mExternalType, data);
+        }
     }
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45Texture3.h>
@@ -22,6 +22,9 @@ GL45Texture3::GL45Texture3(Texture3 const* texture)
     glGenTextures(1, &mGLHandle);
     glBindTexture(GL_TEXTURE_3D, mGLHandle);
 
+    // Request sparse storage for a partially resident texture.
+    PrepareSparseStorage();
+
     // Allocate (immutable) texture storage for all levels.
     auto const width = texture->GetDimension(0);
     auto const height = texture->GetDimension(1);
@@ -64,7 +67,15 @@ void GL45Texture3::LoadTextureLevel(unsigned int level, void const* data)
         auto height = texture->GetDimensionFor(level, 1);
         auto depth = texture->GetDimensionFor(level, 2);
 
-        glTexSubImage3D(GL_TEXTURE_3D, level, 0, 0, 0, width, height, depth,
-            mExternalFormat, mExternalType, data);
+        if (texture->IsCompressed())
+        {
+            glCompressedTexSubImage3D(GL_TEXTURE_3D, level, 0, 0, 0, width, height, depth,
+                mInternalFormat, texture->GetNumBytesFor(level), data);
+        }
+        else
+        {
+            glTexSubImage3D(GL_TEXTURE_3D, level, 0, 0, 0, width, height, depth,
+                mExternalFormat, mExternalType, data);
+        }
     }
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45TextureArray.h>
@@ -240,7 +240,14 @@ bool GL45TextureArray::CopyGpuToCpu(unsigned int item, unsigned int level)
     glBindTexture(target, mGLHandle);
 
     glBindBuffer(GL_PIXEL_PACK_BUFFER, pixBuffer);
-    glGetTexImage(target, level, mExternalFormat, mExternalType, 0);
+    if (texture->IsCompressed())
+    {
+        glGetCompressedTexImage(target, level, 0);
+    }
+    else
+    {
+        glGetTexImage(target, level, mExternalFormat, mExternalType, 0);
+    }
     glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, numBytes, data);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
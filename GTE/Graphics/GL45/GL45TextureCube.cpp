@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45TextureCube.h>
@@ -59,13 +59,21 @@ void GL45TextureCube::LoadTextureLevel(unsigned int item, unsigned int level, vo
     auto texture = GetTexture();
     if (texture && level < texture->GetNumLevels())
     {
-        auto const width = texture->GetDimension(0);
-        auto const height = texture->GetDimension(1);
+        auto const width = texture->GetDimensionFor(level, 0);
+        auto const height = texture->GetDimensionFor(level, 1);
 
         // Each face in the TextureCube has a unique GL target.
         GLenum targetFace = msCubeFaceTarget[item];
 
-        glTexSubImage2D(targetFace, level, 0, 0, width, height,
-            mExternalFormat, mExternalType, data);
+        if (texture->IsCompressed())
+        {
+            glCompressedTexSubImage2D(targetFace, level, 0, 0, width, height,
+                mInternalFormat, texture->GetNumBytesFor(level), data);
+        }
+        else
+        {
+            glTexSubImage2D(targetFace, level, 0, 0, width, height,
+                mExternalFormat, mExternalType, data);
+        }
     }
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45TextureCubeArray.h>
@@ -123,7 +123,15 @@ void GL45TextureCubeArray::LoadTextureLevel(unsigned int item, unsigned int leve
         // For TextureCubeArray, use the 3D calls where the cube index is the
         // third dimension.  Only updating one cube-face for the specified
         // level.
-        glTexSubImage3D(targetFace, level, 0, 0, cube, width, height, 1,
-            mExternalFormat, mExternalType, data);
+        if (texture->IsCompressed())
+        {
+            glCompressedTexSubImage3D(targetFace, level, 0, 0, cube, width, height, 1,
+                mInternalFormat, texture->GetNumBytesFor(level), data);
+        }
+        else
+        {
+            glTexSubImage3D(targetFace, level, 0, 0, cube, width, height, 1,
+                mExternalFormat, mExternalType, data);
+        }
     }
 }
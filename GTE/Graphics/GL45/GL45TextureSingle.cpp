@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GL45TextureSingle.h>
+#include <cstring>
 using namespace gte;
 
 GL45TextureSingle::~GL45TextureSingle()
@@ -20,7 +21,10 @@ GL45TextureSingle::~GL45TextureSingle()
 
 GL45TextureSingle::GL45TextureSingle(TextureSingle const* gtTexture, GLenum target, GLenum targetBinding)
     :
-    GL45Texture(gtTexture, target, targetBinding)
+    GL45Texture(gtTexture, target, targetBinding),
+    mResidentLevel(0),
+    mNumSparseLevels(0),
+    mSparse(false)
 {
     // Initially no staging buffers.
     std::fill(std::begin(mLevelPixelUnpackBuffer), std::end(mLevelPixelUnpackBuffer), 0);
@@ -41,12 +45,21 @@ void GL45TextureSingle::Initialize()
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
 
-    // Set the range of levels.
-    glTexParameteri(mTarget, GL_TEXTURE_BASE_LEVEL, 0);
+    // Set the range of levels. Only the resident levels are sampled, and
+    // only they are committed for sparse storage.
+    auto texture = GetTexture();
+    mResidentLevel = texture->GetMinResidentLevel();
+    glTexParameteri(mTarget, GL_TEXTURE_BASE_LEVEL, mResidentLevel);
     glTexParameteri(mTarget, GL_TEXTURE_MAX_LEVEL, mNumLevels-1);
+    if (mSparse)
+    {
+        for (int level = mResidentLevel; level < mNumLevels; ++level)
+        {
+            CommitLevel(level, true);
+        }
+    }
 
     // Initialize with data?
-    auto texture = GetTexture();
     if (texture->GetData())
     {
         if (CanAutoGenerateMipmaps())
@@ -62,8 +75,8 @@ void GL45TextureSingle::Initialize()
         }
         else
         {
-            // Initialize with each mipmap level.
-            for (int level = 0; level < mNumLevels; ++level)
+            // Initialize with each resident mipmap level.
+            for (int level = mResidentLevel; level < mNumLevels; ++level)
             {
                 auto data = texture->GetDataFor(level);
                 if (data)
@@ -93,10 +106,10 @@ bool GL45TextureSingle::Update()
     }
     else
     {
-        // Automatic generation of mipmaps is not enabled, so all mipmap
-        // levels must be copied to the GPU.
+        // Automatic generation of mipmaps is not enabled, so all resident
+        // mipmap levels must be copied to the GPU.
         auto const numLevels = texture->GetNumLevels();
-        for (unsigned int level = 0; level < numLevels; ++level)
+        for (unsigned int level = mResidentLevel; level < numLevels; ++level)
         {
             if (!Update(level))
             {
@@ -124,10 +137,10 @@ bool GL45TextureSingle::CopyCpuToGpu()
     }
     else
     {
-        // Automatic generation of mipmaps is not enabled, so all mipmap
-        // levels must be copied to the GPU.
+        // Automatic generation of mipmaps is not enabled, so all resident
+        // mipmap levels must be copied to the GPU.
         auto const numLevels = texture->GetNumLevels();
-        for (unsigned int level = 0; level < numLevels; ++level)
+        for (unsigned int level = mResidentLevel; level < numLevels; ++level)
         {
             if (!CopyCpuToGpu(level))
             {
@@ -176,6 +189,83 @@ bool GL45TextureSingle::CopyCpuToGpu(unsigned int level)
 }
 
 bool GL45TextureSingle::CopyGpuToCpu(unsigned int level)
+{
+    return StageGpuToCpu(level) && CopyStagingToCpu(level);
+}
+
+bool GL45TextureSingle::StageGpuToCpu()
+{
+    auto texture = GetTexture();
+    auto const numLevels = texture->GetNumLevels();
+    for (unsigned int level = 0; level < numLevels; ++level)
+    {
+        if (!StageGpuToCpu(level))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GL45TextureSingle::StageGpuToCpu(unsigned int level)
+{
+    if (!PreparedForCopy(GL_READ_ONLY))
+    {
+        return false;
+    }
+
+    auto texture = GetTexture();
+
+    // Make sure level is valid.
+    auto const numLevels = texture->GetNumLevels();
+    if (level >= numLevels)
+    {
+        LogError("Level for Texture is out of range");
+    }
+
+    auto pixBuffer = mLevelPixelPackBuffer[level];
+    if (0 == pixBuffer)
+    {
+        LogError("Staging buffer not defined for level " + level);
+    }
+
+    // The read into the pixel pack buffer is executed asynchronously.
+    auto const target = GetTarget();
+    glBindTexture(target, mGLHandle);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixBuffer);
+    if (texture->IsCompressed())
+    {
+        glGetCompressedTexImage(target, level, 0);
+    }
+    else
+    {
+        glGetTexImage(target, level, mExternalFormat, mExternalType, 0);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glBindTexture(target, 0);
+
+    return true;
+}
+
+bool GL45TextureSingle::CopyStagingToCpu()
+{
+    auto texture = GetTexture();
+    auto const numLevels = texture->GetNumLevels();
+    for (unsigned int level = 0; level < numLevels; ++level)
+    {
+        if (!CopyStagingToCpu(level))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool GL45TextureSingle::CopyStagingToCpu(unsigned int level)
 {
     if (!PreparedForCopy(GL_READ_ONLY))
     {
@@ -204,16 +294,11 @@ bool GL45TextureSingle::CopyGpuToCpu(unsigned int level)
         LogError("No target data for texture level " + level);
     }
 
-    auto const target = GetTarget();
-    glBindTexture(target, mGLHandle);
-
+    // This waits for the read into the pixel pack buffer to finish.
     glBindBuffer(GL_PIXEL_PACK_BUFFER, pixBuffer);
-    glGetTexImage(target, level, mExternalFormat, mExternalType, 0);
     glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, numBytes, data);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 
-    glBindTexture(target, 0);
-
     return true;
 }
 
@@ -338,3 +423,118 @@ void GL45TextureSingle::CreateStaging()
         }
     }
 }
+
+bool GL45TextureSingle::UpdateResidency()
+{
+    auto texture = GetTexture();
+    unsigned int const level = texture->GetMinResidentLevel();
+    if (level == mResidentLevel)
+    {
+        return true;
+    }
+
+    auto const target = GetTarget();
+    glBindTexture(target, mGLHandle);
+    if (level < mResidentLevel)
+    {
+        // Commit the finer levels before their data is copied, and sample
+        // them only after the copies.
+        if (mSparse)
+        {
+            for (unsigned int i = level; i < mResidentLevel; ++i)
+            {
+                CommitLevel(i, true);
+            }
+        }
+        glBindTexture(target, 0);
+
+        if (texture->GetData())
+        {
+            for (unsigned int i = level; i < mResidentLevel; ++i)
+            {
+                if (!DoCopyCpuToGpu(i))
+                {
+                    return false;
+                }
+            }
+        }
+
+        glBindTexture(target, mGLHandle);
+        glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, level);
+    }
+    else
+    {
+        // Stop sampling the levels before their memory is released.
+        glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, level);
+        if (mSparse)
+        {
+            for (unsigned int i = mResidentLevel; i < level; ++i)
+            {
+                CommitLevel(i, false);
+            }
+        }
+    }
+    glBindTexture(target, 0);
+
+    mResidentLevel = level;
+    return true;
+}
+
+void GL45TextureSingle::PrepareSparseStorage()
+{
+    auto texture = GetTexture();
+    if (!texture->IsPartiallyResident() || !texture->HasMipmaps())
+    {
+        return;
+    }
+
+    bool hasExtension = false;
+    GLint numExtensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+    for (GLint i = 0; i < numExtensions; ++i)
+    {
+        char const* name = reinterpret_cast<char const*>(
+            glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (name && std::strcmp(name, "GL_ARB_sparse_texture") == 0)
+        {
+            hasExtension = true;
+            break;
+        }
+    }
+    if (!hasExtension)
+    {
+        return;
+    }
+
+    GLint numPageSizes = 0;
+    glGetInternalformativ(mTarget, mInternalFormat, GL_NUM_VIRTUAL_PAGE_SIZES_ARB,
+        1, &numPageSizes);
+    if (numPageSizes > 0)
+    {
+        glTexParameteri(mTarget, GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+        glTexParameteri(mTarget, GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, 0);
+        mSparse = true;
+    }
+}
+
+void GL45TextureSingle::CommitLevel(unsigned int level, bool commit)
+{
+    if (mNumSparseLevels == 0)
+    {
+        // The number of levels that are not in the tail is known only after
+        // the storage is allocated.
+        GLint numSparseLevels = 0;
+        glGetTexParameteriv(mTarget, GL_NUM_SPARSE_LEVELS_ARB, &numSparseLevels);
+        mNumSparseLevels = static_cast<unsigned int>(numSparseLevels);
+    }
+
+    if (commit || level < mNumSparseLevels)
+    {
+        auto texture = GetTexture();
+        glTexPageCommitmentARB(mTarget, level, 0, 0, 0,
+            texture->GetDimensionFor(level, 0),
+            texture->GetDimensionFor(level, 1),
+            texture->GetDimensionFor(level, 2),
+            commit ? GL_TRUE : GL_FALSE);
+    }
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -41,6 +41,14 @@ namespace gte
         bool CopyCpuToGpu(unsigned int level);
         bool CopyGpuToCpu(unsigned int level);
 
+        // Copy of data from GPU to CPU in two steps, see the comments in
+        // GraphicsEngine.h. CopyGpuToCpu is StageGpuToCpu followed by
+        // CopyStagingToCpu.
+        bool StageGpuToCpu();
+        bool StageGpuToCpu(unsigned int level);
+        bool CopyStagingToCpu();
+        bool CopyStagingToCpu(unsigned int level);
+
         void CopyLevelGpuToGpu(GL45TextureSingle* texture, unsigned int level)
         {
             (void)texture;
@@ -55,6 +63,17 @@ namespace gte
         // returns true.
         virtual bool GenerateMipmaps();
 
+        // Apply the minimum resident level of the texture. The levels that
+        // become resident are committed (for sparse storage) and their CPU
+        // data is copied to the GPU; the levels that are no longer resident
+        // are decommitted. Sampling is restricted to the resident levels.
+        bool UpdateResidency();
+
+        inline bool IsSparse() const
+        {
+            return mSparse;
+        }
+
     protected:
         // Called by Update and CopyCpuToGpu.
         bool DoCopyCpuToGpu(unsigned int level);
@@ -63,6 +82,15 @@ namespace gte
         // COPY_NONE.
         void CreateStaging();
 
+        // Only call from derived class constructor before texture storage
+        // is allocated, with the texture bound. The storage is sparse when
+        // the texture is partially resident and the driver supports
+        // GL_ARB_sparse_texture for the format.
+        void PrepareSparseStorage();
+
+        // Commit or decommit the GPU memory of a level of sparse storage.
+        void CommitLevel(unsigned int level, bool commit);
+
         // This is called to copy the data from the CPU buffer to the GPU
         // for the specified level.  If a pixel unpack buffer is being used
         // then data needs to be passed as 0 which is used as an offset.
@@ -72,5 +100,12 @@ namespace gte
         // Data associated with each mip level
         GLuint mLevelPixelUnpackBuffer[Texture::MAX_MIPMAP_LEVELS];
         GLuint mLevelPixelPackBuffer[Texture::MAX_MIPMAP_LEVELS];
+
+        // Residency of the levels. The levels starting at mNumSparseLevels
+        // form the mipmap tail, which is committed as a whole and remains
+        // committed.
+        unsigned int mResidentLevel;
+        unsigned int mNumSparseLevels;
+        bool mSparse;
     };
 }
@@ -3,15 +3,22 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GLSLComputeProgram.h>
 #include <Graphics/GL45/GLSLProgramFactory.h>
 #include <Graphics/GL45/GLSLVisualProgram.h>
 #include <Graphics/GL45/GLSLShader.h>
+#include <algorithm>
+#include <cstring>
 using namespace gte;
 
+// GL_KHR_parallel_shader_compile is not in glcorearb.h.
+#if !defined(GL_COMPLETION_STATUS_KHR)
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 std::string GLSLProgramFactory::defaultVersion = "#version 430";
 std::string GLSLProgramFactory::defaultVSEntry = "main";
 std::string GLSLProgramFactory::defaultPSEntry = "main";
@@ -20,6 +27,8 @@ std::string GLSLProgramFactory::defaultCSEntry = "main";
 unsigned int GLSLProgramFactory::defaultFlags = 0;  // unused in GLSL for now
 
 GLSLProgramFactory::GLSLProgramFactory()
+    :
+    mParallelShaderCompile(-1)
 {
     version = defaultVersion;
     vsEntry = defaultVSEntry;
@@ -39,6 +48,16 @@ std::shared_ptr<VisualProgram> GLSLProgramFactory::CreateFromNamedSources(
         LogError("A program must have a vertex shader and a pixel shader.");
     }
 
+    std::string cacheFilename = GetCacheFilename(vsSource, psSource, gsSource);
+    if (cacheFilename != "")
+    {
+        GLuint programHandle = LoadProgramBinary(cacheFilename);
+        if (programHandle > 0)
+        {
+            return CreateVisualProgram(programHandle, 0, 0, 0, gsSource != "");
+        }
+    }
+
     GLuint vsHandle = Compile(GL_VERTEX_SHADER, vsSource);
     if (vsHandle == 0)
     {
@@ -73,6 +92,10 @@ std::shared_ptr<VisualProgram> GLSLProgramFactory::CreateFromNamedSources(
     {
         glAttachShader(programHandle, gsHandle);
     }
+    if (cacheFilename != "")
+    {
+        glProgramParameteri(programHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
     if (!Link(programHandle))
     {
@@ -89,21 +112,11 @@ std::shared_ptr<VisualProgram> GLSLProgramFactory::CreateFromNamedSources(
         return nullptr;
     }
 
-    std::shared_ptr<GLSLVisualProgram> program =
-        std::make_shared<GLSLVisualProgram>(programHandle, vsHandle,
-        psHandle, gsHandle);
-
-    GLSLReflection const& reflector = program->GetReflector();
-    auto vshader = std::make_shared<GLSLShader>(reflector, GT_VERTEX_SHADER, GLSLReflection::ST_VERTEX);
-    auto pshader = std::make_shared<GLSLShader>(reflector, GT_PIXEL_SHADER, GLSLReflection::ST_PIXEL);
-    program->SetVertexShader(vshader);
-    program->SetPixelShader(pshader);
-    if (gsHandle > 0)
+    if (cacheFilename != "")
     {
-        auto gshader = std::make_shared<GLSLShader>(reflector, GT_GEOMETRY_SHADER, GLSLReflection::ST_GEOMETRY);
-        program->SetGeometryShader(gshader);
+        SaveProgramBinary(cacheFilename, programHandle);
     }
-    return program;
+    return CreateVisualProgram(programHandle, vsHandle, psHandle, gsHandle, gsHandle > 0);
 }
 
 std::shared_ptr<ComputeProgram> GLSLProgramFactory::CreateFromNamedSource(
@@ -114,6 +127,16 @@ std::shared_ptr<ComputeProgram> GLSLProgramFactory::CreateFromNamedSource(
         LogError("A program must have a compute shader.");
     }
 
+    std::string cacheFilename = GetCacheFilename(csSource, "", "");
+    if (cacheFilename != "")
+    {
+        GLuint programHandle = LoadProgramBinary(cacheFilename);
+        if (programHandle > 0)
+        {
+            return CreateComputeProgram(programHandle, 0);
+        }
+    }
+
     GLuint csHandle = Compile(GL_COMPUTE_SHADER, csSource);
     if (csHandle == 0)
     {
@@ -127,6 +150,10 @@ std::shared_ptr<ComputeProgram> GLSLProgramFactory::CreateFromNamedSource(
     }
 
     glAttachShader(programHandle, csHandle);
+    if (cacheFilename != "")
+    {
+        glProgramParameteri(programHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
     if (!Link(programHandle))
     {
@@ -136,14 +163,25 @@ std::shared_ptr<ComputeProgram> GLSLProgramFactory::CreateFromNamedSource(
         return nullptr;
     }
 
-    auto program = std::make_shared<GLSLComputeProgram>(programHandle, csHandle);
-    GLSLReflection const& reflector = program->GetReflector();
-    auto cshader = std::make_shared<GLSLShader>(reflector, GT_COMPUTE_SHADER, GLSLReflection::ST_COMPUTE);
-    program->SetComputeShader(cshader);
-    return program;
+    if (cacheFilename != "")
+    {
+        SaveProgramBinary(cacheFilename, programHandle);
+    }
+    return CreateComputeProgram(programHandle, csHandle);
 }
 
 GLuint GLSLProgramFactory::Compile(GLenum shaderType, std::string const& source)
+{
+    GLuint handle = StartCompile(shaderType, source);
+    if (handle == 0)
+    {
+        LogError("Cannot create shader.");
+    }
+    CheckCompile(handle);
+    return handle;
+}
+
+GLuint GLSLProgramFactory::StartCompile(GLenum shaderType, std::string const& source)
 {
     GLuint handle = glCreateShader(shaderType);
     if (handle > 0)
@@ -193,42 +231,49 @@ GLuint GLSLProgramFactory::Compile(GLenum shaderType, std::string const& source)
         glShaderSource(handle, static_cast<GLsizei>(code.size()), &code[0], nullptr);
 
         glCompileShader(handle);
-        GLint status;
-        glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
-        if (status == GL_TRUE)
-        {
-            return handle;
-        }
+    }
+    return handle;
+}
 
-        GLint logLength;
-        glGetShaderiv(handle, GL_INFO_LOG_LENGTH, &logLength);
-        if (logLength > 0)
-        {
-            std::vector<GLchar> log(logLength);
-            GLsizei numWritten;
-            glGetShaderInfoLog(handle, static_cast<GLsizei>(logLength), &numWritten, log.data());
-            std::string message(log.data());
-            LogError("Compile failed:\n" + message);
-        }
-        else
-        {
-            LogError("Invalid info log length.");
-        }
+void GLSLProgramFactory::CheckCompile(GLuint handle)
+{
+    GLint status;
+    glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
+    if (status == GL_TRUE)
+    {
+        return;
+    }
+
+    GLint logLength;
+    glGetShaderiv(handle, GL_INFO_LOG_LENGTH, &logLength);
+    if (logLength > 0)
+    {
+        std::vector<GLchar> log(logLength);
+        GLsizei numWritten;
+        glGetShaderInfoLog(handle, static_cast<GLsizei>(logLength), &numWritten, log.data());
+        std::string message(log.data());
+        LogError("Compile failed:\n" + message);
     }
     else
     {
-        LogError("Cannot create shader.");
+        LogError("Invalid info log length.");
     }
 }
 
 bool GLSLProgramFactory::Link(GLuint programHandle)
 {
     glLinkProgram(programHandle);
+    CheckLink(programHandle);
+    return true;
+}
+
+void GLSLProgramFactory::CheckLink(GLuint programHandle)
+{
     int status;
     glGetProgramiv(programHandle, GL_LINK_STATUS, &status);
     if (status == GL_TRUE)
     {
-        return true;
+        return;
     }
 
     int logLength;
@@ -246,3 +291,316 @@ bool GLSLProgramFactory::Link(GLuint programHandle)
         LogError("Invalid info log length.");
     }
 }
+
+std::string GLSLProgramFactory::GetCacheFilename(std::string const& vsSource,
+    std::string const& psSource, std::string const& gsSource) const
+{
+    if (cacheDirectory == "")
+    {
+        return "";
+    }
+
+    std::vector<std::string> keyParts;
+    GLenum const names[3] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    for (auto name : names)
+    {
+        GLubyte const* info = glGetString(name);
+        keyParts.push_back(info ? reinterpret_cast<char const*>(info) : "");
+    }
+    keyParts.push_back(vsSource);
+    keyParts.push_back(psSource);
+    keyParts.push_back(gsSource);
+    return ProgramFactory::GetCacheFilename(keyParts);
+}
+
+GLuint GLSLProgramFactory::LoadProgramBinary(std::string const& filename)
+{
+    // The blobs are the binary format and the program binary.
+    std::vector<std::vector<unsigned char>> blobs;
+    if (!LoadCacheFile(filename, blobs) || blobs.size() != 2
+        || blobs[0].size() != sizeof(GLenum) || blobs[1].size() == 0)
+    {
+        return 0;
+    }
+
+    GLenum format = *reinterpret_cast<GLenum const*>(blobs[0].data());
+    GLint numFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+    if (numFormats <= 0)
+    {
+        return 0;
+    }
+    std::vector<GLint> formats(static_cast<size_t>(numFormats));
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+    if (std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) == formats.end())
+    {
+        return 0;
+    }
+
+    GLuint programHandle = glCreateProgram();
+    if (programHandle == 0)
+    {
+        return 0;
+    }
+
+    // The driver rejects a binary that it cannot load, for example after a
+    // driver update, in which case the program is compiled from source.
+    glProgramBinary(programHandle, format, blobs[1].data(),
+        static_cast<GLsizei>(blobs[1].size()));
+    GLint status = GL_FALSE;
+    glGetProgramiv(programHandle, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE)
+    {
+        glDeleteProgram(programHandle);
+        return 0;
+    }
+    return programHandle;
+}
+
+void GLSLProgramFactory::SaveProgramBinary(std::string const& filename, GLuint programHandle)
+{
+    GLint length = 0;
+    glGetProgramiv(programHandle, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    std::vector<std::vector<unsigned char>> blobs(2);
+    blobs[0].resize(sizeof(GLenum));
+    blobs[1].resize(static_cast<size_t>(length));
+    GLsizei numWritten = 0;
+    GLenum format = 0;
+    glGetProgramBinary(programHandle, length, &numWritten, &format, blobs[1].data());
+    if (numWritten > 0)
+    {
+        *reinterpret_cast<GLenum*>(blobs[0].data()) = format;
+        blobs[1].resize(static_cast<size_t>(numWritten));
+        SaveCacheFile(filename, blobs);
+    }
+}
+
+std::shared_ptr<VisualProgram> GLSLProgramFactory::CreateVisualProgram(GLuint programHandle,
+    GLuint vsHandle, GLuint psHandle, GLuint gsHandle, bool hasGeometryShader)
+{
+    std::shared_ptr<GLSLVisualProgram> program =
+        std::make_shared<GLSLVisualProgram>(programHandle, vsHandle,
+        psHandle, gsHandle);
+
+    GLSLReflection const& reflector = program->GetReflector();
+    auto vshader = std::make_shared<GLSLShader>(reflector, GT_VERTEX_SHADER, GLSLReflection::ST_VERTEX);
+    auto pshader = std::make_shared<GLSLShader>(reflector, GT_PIXEL_SHADER, GLSLReflection::ST_PIXEL);
+    program->SetVertexShader(vshader);
+    program->SetPixelShader(pshader);
+    if (hasGeometryShader)
+    {
+        auto gshader = std::make_shared<GLSLShader>(reflector, GT_GEOMETRY_SHADER, GLSLReflection::ST_GEOMETRY);
+        program->SetGeometryShader(gshader);
+    }
+    return program;
+}
+
+std::shared_ptr<ComputeProgram> GLSLProgramFactory::CreateComputeProgram(GLuint programHandle,
+    GLuint csHandle)
+{
+    auto program = std::make_shared<GLSLComputeProgram>(programHandle, csHandle);
+    GLSLReflection const& reflector = program->GetReflector();
+    auto cshader = std::make_shared<GLSLShader>(reflector, GT_COMPUTE_SHADER, GLSLReflection::ST_COMPUTE);
+    program->SetComputeShader(cshader);
+    return program;
+}
+
+GLSLProgramFactory::GLSLAsyncRequest::GLSLAsyncRequest()
+    :
+    programHandle(0),
+    shaderHandles{ 0, 0, 0 },
+    fromCache(false)
+{
+}
+
+std::shared_ptr<ProgramFactory::AsyncRequest> GLSLProgramFactory::CreateAsyncRequest()
+{
+    return std::make_shared<GLSLAsyncRequest>();
+}
+
+void GLSLProgramFactory::StartAsync(AsyncRequest& request)
+{
+    // The factory state is that of the request, because StartAsync is
+    // called by the Create*Async functions. Invalid requests are left
+    // without a program handle, in which case PollAsync uses the
+    // synchronous creation to report the error.
+    auto& glslRequest = static_cast<GLSLAsyncRequest&>(request);
+    auto const& sources = request.sources;
+    GLenum shaderTypes[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+    size_t numShaders = 2;
+    if (request.isCompute)
+    {
+        if (sources[0] == "")
+        {
+            return;
+        }
+        shaderTypes[0] = GL_COMPUTE_SHADER;
+        numShaders = 1;
+        glslRequest.cacheFilename = GetCacheFilename(sources[0], "", "");
+    }
+    else
+    {
+        if (sources[0] == "" || sources[1] == "")
+        {
+            return;
+        }
+        if (sources[2] != "")
+        {
+            numShaders = 3;
+        }
+        glslRequest.cacheFilename = GetCacheFilename(sources[0], sources[1], sources[2]);
+    }
+
+    if (glslRequest.cacheFilename != "")
+    {
+        glslRequest.programHandle = LoadProgramBinary(glslRequest.cacheFilename);
+        if (glslRequest.programHandle > 0)
+        {
+            glslRequest.fromCache = true;
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < numShaders; ++i)
+    {
+        glslRequest.shaderHandles[i] = StartCompile(shaderTypes[i], sources[i]);
+        if (glslRequest.shaderHandles[i] == 0)
+        {
+            DeleteAsyncHandles(glslRequest);
+            return;
+        }
+    }
+
+    glslRequest.programHandle = glCreateProgram();
+    if (glslRequest.programHandle == 0)
+    {
+        DeleteAsyncHandles(glslRequest);
+        return;
+    }
+
+    for (size_t i = 0; i < numShaders; ++i)
+    {
+        glAttachShader(glslRequest.programHandle, glslRequest.shaderHandles[i]);
+    }
+    if (glslRequest.cacheFilename != "")
+    {
+        glProgramParameteri(glslRequest.programHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(glslRequest.programHandle);
+}
+
+bool GLSLProgramFactory::PollAsync(AsyncRequest& request)
+{
+    auto& glslRequest = static_cast<GLSLAsyncRequest&>(request);
+    if (glslRequest.programHandle == 0)
+    {
+        CreateFromRequest(request);
+        return true;
+    }
+
+    if (!glslRequest.fromCache && HasParallelShaderCompile())
+    {
+        GLint completed = GL_FALSE;
+        glGetProgramiv(glslRequest.programHandle, GL_COMPLETION_STATUS_KHR, &completed);
+        if (completed != GL_TRUE)
+        {
+            return false;
+        }
+    }
+
+    auto const& handles = glslRequest.shaderHandles;
+    try
+    {
+        if (!glslRequest.fromCache)
+        {
+            // Check the shaders first for the compiler messages, because a
+            // failed compilation also fails the link.
+            for (auto handle : handles)
+            {
+                if (handle > 0)
+                {
+                    CheckCompile(handle);
+                }
+            }
+            CheckLink(glslRequest.programHandle);
+
+            if (glslRequest.cacheFilename != "")
+            {
+                SaveProgramBinary(glslRequest.cacheFilename, glslRequest.programHandle);
+            }
+        }
+
+        if (request.isCompute)
+        {
+            request.computePromise.set_value(CreateComputeProgram(
+                glslRequest.programHandle, handles[0]));
+        }
+        else
+        {
+            request.visualPromise.set_value(CreateVisualProgram(
+                glslRequest.programHandle, handles[0], handles[1], handles[2],
+                request.sources[2] != ""));
+        }
+    }
+    catch (...)
+    {
+        DeleteAsyncHandles(glslRequest);
+        if (request.isCompute)
+        {
+            request.computePromise.set_exception(std::current_exception());
+        }
+        else
+        {
+            request.visualPromise.set_exception(std::current_exception());
+        }
+    }
+    return true;
+}
+
+void GLSLProgramFactory::DeleteAsyncHandles(GLSLAsyncRequest& request)
+{
+    for (auto& handle : request.shaderHandles)
+    {
+        if (handle > 0)
+        {
+            if (request.programHandle > 0)
+            {
+                glDetachShader(request.programHandle, handle);
+            }
+            glDeleteShader(handle);
+            handle = 0;
+        }
+    }
+    if (request.programHandle > 0)
+    {
+        glDeleteProgram(request.programHandle);
+        request.programHandle = 0;
+    }
+}
+
+bool GLSLProgramFactory::HasParallelShaderCompile()
+{
+    if (mParallelShaderCompile < 0)
+    {
+        mParallelShaderCompile = 0;
+        GLint numExtensions = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+        for (GLint i = 0; i < numExtensions; ++i)
+        {
+            char const* name = reinterpret_cast<char const*>(
+                glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (name && (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0
+                || std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0))
+            {
+                mParallelShaderCompile = 1;
+                break;
+            }
+        }
+    }
+    return mParallelShaderCompile == 1;
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -63,7 +63,56 @@ namespace gte
         virtual std::shared_ptr<ComputeProgram> CreateFromNamedSource(
             std::string const& csName, std::string const& csSource) override;
 
+        // Compile is StartCompile followed by CheckCompile. The check
+        // blocks until the driver has finished compiling the shader.
         GLuint Compile(GLenum shaderType, std::string const& source);
+        GLuint StartCompile(GLenum shaderType, std::string const& source);
+        void CheckCompile(GLuint handle);
         bool Link(GLuint programHandle);
+        void CheckLink(GLuint programHandle);
+
+        // Support for the program cache. The cache stores the program
+        // binaries of glGetProgramBinary, which are specific to the driver,
+        // so the vendor, renderer and version strings of the driver are part
+        // of the cache key. LoadProgramBinary returns 0 when the file does
+        // not exist or the driver does not accept the binary.
+        std::string GetCacheFilename(std::string const& vsSource,
+            std::string const& psSource, std::string const& gsSource) const;
+        GLuint LoadProgramBinary(std::string const& filename);
+        void SaveProgramBinary(std::string const& filename, GLuint programHandle);
+
+        std::shared_ptr<VisualProgram> CreateVisualProgram(GLuint programHandle,
+            GLuint vsHandle, GLuint psHandle, GLuint gsHandle, bool hasGeometryShader);
+        std::shared_ptr<ComputeProgram> CreateComputeProgram(GLuint programHandle,
+            GLuint csHandle);
+
+        // Support for asynchronous creation. StartAsync calls glCompileShader
+        // and glLinkProgram without querying their status, so the driver
+        // compiles the shaders of the pending requests in parallel when it
+        // supports GL_KHR_parallel_shader_compile. PollAsync then returns
+        // 'false' until GL_COMPLETION_STATUS_KHR of the program is true.
+        // Without the extension, PollAsync blocks until the program is
+        // linked, which still overlaps the compilation of all the requests
+        // started since the previous ProcessAsync with the CPU work of the
+        // application.
+        struct GLSLAsyncRequest : public AsyncRequest
+        {
+            GLSLAsyncRequest();
+
+            std::string cacheFilename;
+            GLuint programHandle;
+            std::array<GLuint, 3> shaderHandles;
+            bool fromCache;
+        };
+
+        virtual std::shared_ptr<AsyncRequest> CreateAsyncRequest() override;
+        virtual void StartAsync(AsyncRequest& request) override;
+        virtual bool PollAsync(AsyncRequest& request) override;
+        void DeleteAsyncHandles(GLSLAsyncRequest& request);
+        bool HasParallelShaderCompile();
+
+        // 0 when the extension is not supported, 1 when it is supported and
+        // -1 when the extensions have not yet been queried.
+        int mParallelShaderCompile;
     };
 }
@@ -0,0 +1,276 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GL45/GTGraphicsGL45PCH.h>
+#include <Graphics/GL45/GLX/EGLEngine.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <vector>
+using namespace gte;
+
+// The OpenGL function pointers are obtained by GetOpenGLFunctionPointer in
+// GLXExtensions.cpp, which uses eglGetProcAddress when this flag is set.
+extern bool gUseEGLGetProcAddress;
+
+namespace
+{
+    bool HasExtension(char const* extensions, char const* name)
+    {
+        if (extensions)
+        {
+            size_t const length = std::strlen(name);
+            for (char const* found = std::strstr(extensions, name); found;
+                found = std::strstr(found + length, name))
+            {
+                if ((found == extensions || found[-1] == ' ')
+                    && (found[length] == ' ' || found[length] == '\0'))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    EGLDisplay InitializeDisplay(EGLDisplay display)
+    {
+        EGLint major = 0, minor = 0;
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, &major, &minor))
+        {
+            return display;
+        }
+        return EGL_NO_DISPLAY;
+    }
+}
+
+EGLEngine::~EGLEngine()
+{
+    Terminate();
+}
+
+EGLEngine::EGLEngine(bool requireHardwareDevice, bool saveDriverInfo, int requiredMajor, int requiredMinor)
+    :
+    GL45Engine(),
+    mDisplay(nullptr),
+    mSurface(nullptr),
+    mImmediate(nullptr),
+    mIsSoftwareDevice(false)
+{
+    if (!CreateDisplay(requireHardwareDevice) || !CreateContext(requiredMajor, requiredMinor))
+    {
+        DestroyContext();
+        LogError("Cannot create the EGL context.");
+    }
+
+    Initialize(requiredMajor, requiredMinor, false, saveDriverInfo);
+
+    if (requireHardwareDevice && mIsSoftwareDevice)
+    {
+        Terminate();
+        LogError("The OpenGL renderer is a software renderer.");
+    }
+}
+
+bool EGLEngine::IsActive() const
+{
+    return mImmediate == eglGetCurrentContext();
+}
+
+void EGLEngine::MakeActive()
+{
+    if (mImmediate != eglGetCurrentContext())
+    {
+        eglMakeCurrent(mDisplay, mSurface, mSurface, mImmediate);
+    }
+}
+
+void EGLEngine::DisplayColorBuffer(unsigned int)
+{
+    EndFrameStatistics();
+}
+
+bool EGLEngine::CreateDisplay(bool requireHardwareDevice)
+{
+    // The client extensions are queried without a display. The query
+    // returns null when EGL_EXT_client_extensions is not supported.
+    char const* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+    // Prefer a GPU enumerated as an EGL device. The hardware devices are
+    // tried before the software devices, which Mesa marks with
+    // EGL_MESA_device_software.
+    if (getPlatformDisplay
+        && HasExtension(clientExtensions, "EGL_EXT_device_enumeration")
+        && HasExtension(clientExtensions, "EGL_EXT_platform_device"))
+    {
+        auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(
+            eglGetProcAddress("eglQueryDevicesEXT"));
+        auto queryDeviceString = reinterpret_cast<PFNEGLQUERYDEVICESTRINGEXTPROC>(
+            eglGetProcAddress("eglQueryDeviceStringEXT"));
+        EGLint numDevices = 0;
+        if (queryDevices && queryDeviceString && queryDevices(0, nullptr, &numDevices) && numDevices > 0)
+        {
+            std::vector<EGLDeviceEXT> devices(static_cast<size_t>(numDevices));
+            queryDevices(numDevices, devices.data(), &numDevices);
+            int const numPasses = (requireHardwareDevice ? 1 : 2);
+            for (int pass = 0; pass < numPasses; ++pass)
+            {
+                for (EGLint i = 0; i < numDevices; ++i)
+                {
+                    bool isSoftware = HasExtension(queryDeviceString(devices[i], EGL_EXTENSIONS),
+                        "EGL_MESA_device_software");
+                    if (isSoftware == (pass == 1))
+                    {
+                        mDisplay = InitializeDisplay(getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr));
+                        if (mDisplay != EGL_NO_DISPLAY)
+                        {
+                            mIsSoftwareDevice = isSoftware;
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            LogWarning(requireHardwareDevice ? "No hardware EGL device is available." : "No EGL device is available.");
+            return false;
+        }
+    }
+
+    // Without device enumeration, use the surfaceless platform of Mesa or
+    // the default display. The renderer is tested after the context is
+    // created.
+    if (getPlatformDisplay && HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        mDisplay = InitializeDisplay(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr));
+    }
+    if (mDisplay == EGL_NO_DISPLAY)
+    {
+        mDisplay = InitializeDisplay(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+    }
+    if (mDisplay == EGL_NO_DISPLAY)
+    {
+        LogWarning("eglInitialize failed.");
+        return false;
+    }
+    return true;
+}
+
+bool EGLEngine::CreateContext(int requiredMajor, int requiredMinor)
+{
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        LogWarning("eglBindAPI failed.");
+        return false;
+    }
+
+    EGLint const configAttributes[] =
+    {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(mDisplay, configAttributes, &config, 1, &numConfigs) || numConfigs == 0)
+    {
+        LogWarning("eglChooseConfig failed.");
+        return false;
+    }
+
+    // Request the compatibility profile, which is what glXCreateContext and
+    // wglCreateContext provide, and fall back to the core profile for
+    // drivers that support compute programs only in the core profile.
+    EGLint contextAttributes[] =
+    {
+        EGL_CONTEXT_MAJOR_VERSION, requiredMajor,
+        EGL_CONTEXT_MINOR_VERSION, requiredMinor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        EGL_NONE
+    };
+    mImmediate = eglCreateContext(mDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (mImmediate == EGL_NO_CONTEXT)
+    {
+        contextAttributes[5] = EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT;
+        mImmediate = eglCreateContext(mDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+        if (mImmediate == EGL_NO_CONTEXT)
+        {
+            LogWarning("eglCreateContext failed.");
+            return false;
+        }
+    }
+
+    // A context is made current without a surface when the display
+    // supports EGL_KHR_surfaceless_context. Otherwise a 1x1 pbuffer is the
+    // surface.
+    if (!HasExtension(eglQueryString(mDisplay, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+    {
+        EGLint const surfaceAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        mSurface = eglCreatePbufferSurface(mDisplay, config, surfaceAttributes);
+        if (mSurface == EGL_NO_SURFACE)
+        {
+            LogWarning("eglCreatePbufferSurface failed.");
+            return false;
+        }
+    }
+    return true;
+}
+
+void EGLEngine::DestroyContext()
+{
+    if (mDisplay != EGL_NO_DISPLAY)
+    {
+        eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (mImmediate != EGL_NO_CONTEXT)
+        {
+            eglDestroyContext(mDisplay, mImmediate);
+        }
+        if (mSurface != EGL_NO_SURFACE)
+        {
+            eglDestroySurface(mDisplay, mSurface);
+        }
+        eglTerminate(mDisplay);
+    }
+    mDisplay = nullptr;
+    mSurface = nullptr;
+    mImmediate = nullptr;
+}
+
+bool EGLEngine::Initialize(int requiredMajor, int requiredMinor, bool useDepth24Stencil8, bool saveDriverInfo)
+{
+    if (!eglMakeCurrent(mDisplay, mSurface, mSurface, mImmediate))
+    {
+        DestroyContext();
+        LogError("eglMakeCurrent failed.");
+    }
+
+    // Get the function pointers for OpenGL; initialize the viewport,
+    // default global state, and default font.
+    gUseEGLGetProcAddress = true;
+    bool success = GL45Engine::Initialize(requiredMajor, requiredMinor, useDepth24Stencil8, saveDriverInfo);
+
+    // Without device enumeration, a software renderer is recognized by
+    // the renderer names of Mesa.
+    if (success && !mIsSoftwareDevice)
+    {
+        char const* renderer = reinterpret_cast<char const*>(glGetString(GL_RENDERER));
+        mIsSoftwareDevice = (renderer != nullptr
+            && (std::strstr(renderer, "llvmpipe") || std::strstr(renderer, "softpipe")
+            || std::strstr(renderer, "swrast")));
+    }
+    return success;
+}
+
+void EGLEngine::Terminate()
+{
+    if (mDisplay)
+    {
+        GL45Engine::Terminate();
+        DestroyContext();
+    }
+}
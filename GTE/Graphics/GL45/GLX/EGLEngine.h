@@ -0,0 +1,75 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GL45/GL45Engine.h>
+
+// A windowless engine for compute-program applications that does not
+// require an X server, such as jobs on batch servers. The OpenGL context is
+// created through EGL without a surface. The display is that of a GPU
+// enumerated by EGL_EXT_device_enumeration when available, otherwise the
+// display of the EGL_MESA_platform_surfaceless platform, otherwise the
+// default display. The context has no default framebuffer, so drawing must
+// be to DrawTarget objects.
+//
+// When requireHardwareDevice is true, software renderers such as llvmpipe
+// are rejected and the construction fails instead of running the compute
+// programs much slower than the CPU code they replace.
+
+namespace gte
+{
+    class EGLEngine : public GL45Engine
+    {
+    public:
+        // Construction and destruction. The caller must test
+        // MeetsRequirements() after construction.
+        virtual ~EGLEngine();
+        EGLEngine(bool requireHardwareDevice = false, bool saveDriverInfo = false,
+            int requiredMajor = 4, int requiredMinor = 3);
+
+        // Member access. The EGLDisplay and EGLContext handles are stored as
+        // void* to avoid exposing EGL/egl.h. The display is null when the
+        // construction fails.
+        inline void* GetDisplay() const
+        {
+            return mDisplay;
+        }
+
+        inline void* GetImmediate() const
+        {
+            return mImmediate;
+        }
+
+        inline bool IsSoftwareDevice() const
+        {
+            return mIsSoftwareDevice;
+        }
+
+        // Allow the user to switch between OpenGL contexts when there are
+        // multiple instances of GL45Engine in an application.
+        virtual bool IsActive() const override;
+        virtual void MakeActive() override;
+
+        // There is no color buffer to display, but the frame statistics are
+        // updated.
+        virtual void DisplayColorBuffer(unsigned int syncInterval) override;
+
+    private:
+        // Helpers for construction and destruction.
+        bool CreateDisplay(bool requireHardwareDevice);
+        bool CreateContext(int requiredMajor, int requiredMinor);
+        void DestroyContext();
+        virtual bool Initialize(int requiredMajor, int requiredMinor, bool useDepth24Stencil8, bool saveDriverInfo) override;
+        void Terminate();
+
+        void* mDisplay;
+        void* mSurface;
+        void* mImmediate;
+        bool mIsSoftwareDevice;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.12.05
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/GLX/GLXEngine.h>
@@ -189,6 +189,7 @@ void GLXEngine::DisplayColorBuffer(unsigned int syncInterval)
     (void)syncInterval;
 
     glXSwapBuffers(mDisplay, mWindow);
+    EndFrameStatistics();
 }
 
 bool GLXEngine::Initialize(int requiredMajor, int requiredMinor, bool useDepth24Stencil8, bool saveDriverInfo)
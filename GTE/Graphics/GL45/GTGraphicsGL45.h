@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -24,6 +24,8 @@
 #include <Graphics/GL45/GL45Buffer.h>
 #include <Graphics/GL45/GL45ConstantBuffer.h>
 #include <Graphics/GL45/GL45IndexBuffer.h>
+#include <Graphics/GL45/GL45IndirectArgumentsBuffer.h>
+#include <Graphics/GL45/GL45RingBuffer.h>
 #include <Graphics/GL45/GL45StructuredBuffer.h>
 #include <Graphics/GL45/GL45VertexBuffer.h>
 
@@ -61,5 +63,6 @@
 #endif
 
 #if defined(GTE_USE_LINUX)
+#include <Graphics/GL45/GLX/EGLEngine.h>
 #include <Graphics/GL45/GLX/GLXEngine.h>
 #endif
@@ -0,0 +1,802 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to 1/sqrt(x) for x in [1,2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/InvSqrtEstimate.h. Do not edit it.
+
+#ifndef GTE_INVSQRTESTIMATE_GLSL
+#define GTE_INVSQRTESTIMATE_GLSL
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_INVSQRT_DEG1_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG1_C1 -2.92893218813452538e-01
+#define GTE_C_INVSQRT_DEG1_MAX_ERROR +3.78143145527019831e-02
+#define GTE_C_INVSQRT_DEG2_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG2_C1 -4.45398121045668005e-01
+#define GTE_C_INVSQRT_DEG2_C2 +1.52504902232215467e-01
+#define GTE_C_INVSQRT_DEG2_MAX_ERROR +4.19534463305812344e-03
+#define GTE_C_INVSQRT_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG3_C1 -4.87032309930687912e-01
+#define GTE_C_INVSQRT_DEG3_C2 +2.81637104866698351e-01
+#define GTE_C_INVSQRT_DEG3_C3 -8.74980137494634214e-02
+#define GTE_C_INVSQRT_DEG3_MAX_ERROR +5.63077020072667855e-04
+#define GTE_C_INVSQRT_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG4_C1 -4.97100615580487792e-01
+#define GTE_C_INVSQRT_DEG4_C2 +3.42662475976768022e-01
+#define GTE_C_INVSQRT_DEG4_C3 -1.91063565362934895e-01
+#define GTE_C_INVSQRT_DEG4_C4 +5.26084861531987968e-02
+#define GTE_C_INVSQRT_DEG4_MAX_ERROR +8.15139199876052656e-05
+#define GTE_C_INVSQRT_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG5_C1 -4.99377605860041429e-01
+#define GTE_C_INVSQRT_DEG5_C2 +3.65087412951339729e-01
+#define GTE_C_INVSQRT_DEG5_C3 -2.58848902818535009e-01
+#define GTE_C_INVSQRT_DEG5_C4 +1.32757822213207533e-01
+#define GTE_C_INVSQRT_DEG5_C5 -3.25119452994044877e-02
+#define GTE_C_INVSQRT_DEG5_MAX_ERROR +1.22893674755833460e-05
+#define GTE_C_INVSQRT_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG6_C1 -4.99870292295474528e-01
+#define GTE_C_INVSQRT_DEG6_C2 +3.72209236044952263e-01
+#define GTE_C_INVSQRT_DEG6_C3 -2.91930677132569372e-01
+#define GTE_C_INVSQRT_DEG6_C4 +1.99376059910946424e-01
+#define GTE_C_INVSQRT_DEG6_C5 -9.31357121309019931e-02
+#define GTE_C_INVSQRT_DEG6_C6 +2.04581667895666897e-02
+#define GTE_C_INVSQRT_DEG6_MAX_ERROR +1.90014512237504651e-06
+#define GTE_C_INVSQRT_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG7_C1 -4.99973572507049768e-01
+#define GTE_C_INVSQRT_DEG7_C2 +3.74262168849988086e-01
+#define GTE_C_INVSQRT_DEG7_C3 -3.05398824982489714e-01
+#define GTE_C_INVSQRT_DEG7_C4 +2.39760056070053906e-01
+#define GTE_C_INVSQRT_DEG7_C5 -1.54103263516844891e-01
+#define GTE_C_INVSQRT_DEG7_C6 +6.55988097230419953e-02
+#define GTE_C_INVSQRT_DEG7_C7 -1.30385924504707873e-02
+#define GTE_C_INVSQRT_DEG7_MAX_ERROR +2.98877249931689404e-07
+#define GTE_C_INVSQRT_DEG8_C0 +1.00000000000000000e+00
+#define GTE_C_INVSQRT_DEG8_C1 -4.99994710661203712e-01
+#define GTE_C_INVSQRT_DEG8_C2 +3.74814157457940667e-01
+#define GTE_C_INVSQRT_DEG8_C3 -3.10238043874221603e-01
+#define GTE_C_INVSQRT_DEG8_C4 +2.59770026829301059e-01
+#define GTE_C_INVSQRT_DEG8_C5 -1.98187907177270972e-01
+#define GTE_C_INVSQRT_DEG8_C6 +1.18824142526136711e-01
+#define GTE_C_INVSQRT_DEG8_C7 -4.62700380885507911e-02
+#define GTE_C_INVSQRT_DEG8_C8 +8.38915417557473120e-03
+#define GTE_C_INVSQRT_DEG8_MAX_ERROR +4.75969261469477711e-08
+
+void InvSqrtEstimateReduce(float x, out float adj, out float y, out float p)
+{
+    int exponent;
+    y = frexp(x, exponent);
+    p = float(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_INV_SQRT_2 : 1.0);
+    p = -half;
+}
+
+float InvSqrtEstimateCombine(float adj, float y, float p)
+{
+    return adj * ldexp(y, int(p));
+}
+
+void InvSqrtEstimateReduce(vec2 x, out vec2 adj, out vec2 y, out vec2 p)
+{
+    ivec2 exponent;
+    y = frexp(x, exponent);
+    p = vec2(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    vec2 half = floor(0.5 * p);
+    adj = mix(vec2(1.0), vec2(GTE_C_INV_SQRT_2), greaterThan(p - 2.0 * half, vec2(0.0)));
+    p = -half;
+}
+
+vec2 InvSqrtEstimateCombine(vec2 adj, vec2 y, vec2 p)
+{
+    return adj * ldexp(y, ivec2(p));
+}
+
+void InvSqrtEstimateReduce(vec3 x, out vec3 adj, out vec3 y, out vec3 p)
+{
+    ivec3 exponent;
+    y = frexp(x, exponent);
+    p = vec3(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    vec3 half = floor(0.5 * p);
+    adj = mix(vec3(1.0), vec3(GTE_C_INV_SQRT_2), greaterThan(p - 2.0 * half, vec3(0.0)));
+    p = -half;
+}
+
+vec3 InvSqrtEstimateCombine(vec3 adj, vec3 y, vec3 p)
+{
+    return adj * ldexp(y, ivec3(p));
+}
+
+void InvSqrtEstimateReduce(vec4 x, out vec4 adj, out vec4 y, out vec4 p)
+{
+    ivec4 exponent;
+    y = frexp(x, exponent);
+    p = vec4(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    vec4 half = floor(0.5 * p);
+    adj = mix(vec4(1.0), vec4(GTE_C_INV_SQRT_2), greaterThan(p - 2.0 * half, vec4(0.0)));
+    p = -half;
+}
+
+vec4 InvSqrtEstimateCombine(vec4 adj, vec4 y, vec4 p)
+{
+    return adj * ldexp(y, ivec4(p));
+}
+
+float InvSqrtEstimateDegree1(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG1_C1;
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree1RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree1(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG1_C1);
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree1RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree1(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG1_C1);
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree1RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree1(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG1_C1);
+    poly = GTE_C_INVSQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree1RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree1(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree2(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG2_C2;
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree2RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree2(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG2_C2);
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree2RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree2(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG2_C2);
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree2RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree2(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG2_C2);
+    poly = GTE_C_INVSQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree2RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree2(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree3(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG3_C3;
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree3RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree3(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG3_C3);
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree3RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree3(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG3_C3);
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree3RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree3(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG3_C3);
+    poly = GTE_C_INVSQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree3RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree3(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree4(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG4_C4;
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree4RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree4(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG4_C4);
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree4RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree4(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG4_C4);
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree4RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree4(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG4_C4);
+    poly = GTE_C_INVSQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree4RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree4(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree5(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG5_C5;
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree5RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree5(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG5_C5);
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree5RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree5(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG5_C5);
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree5RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree5(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG5_C5);
+    poly = GTE_C_INVSQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree5RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree5(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree6(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG6_C6;
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree6RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree6(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG6_C6);
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree6RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree6(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG6_C6);
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree6RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree6(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG6_C6);
+    poly = GTE_C_INVSQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree6RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree6(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree7(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG7_C7;
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree7RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree7(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG7_C7);
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree7RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree7(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG7_C7);
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree7RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree7(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG7_C7);
+    poly = GTE_C_INVSQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree7RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree7(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+float InvSqrtEstimateDegree8(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_INVSQRT_DEG8_C8;
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float InvSqrtEstimateDegree8RR(float x)
+{
+    float adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    float poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 InvSqrtEstimateDegree8(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_INVSQRT_DEG8_C8);
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+vec2 InvSqrtEstimateDegree8RR(vec2 x)
+{
+    vec2 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 InvSqrtEstimateDegree8(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_INVSQRT_DEG8_C8);
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+vec3 InvSqrtEstimateDegree8RR(vec3 x)
+{
+    vec3 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 InvSqrtEstimateDegree8(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_INVSQRT_DEG8_C8);
+    poly = GTE_C_INVSQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_INVSQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+vec4 InvSqrtEstimateDegree8RR(vec4 x)
+{
+    vec4 adj, y, p;
+    InvSqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = InvSqrtEstimateDegree8(y);
+    return InvSqrtEstimateCombine(adj, poly, p);
+}
+
+#endif
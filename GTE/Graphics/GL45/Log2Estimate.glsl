@@ -0,0 +1,716 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to log2(x) for x in [1,2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/Log2Estimate.h. Do not edit it.
+
+#ifndef GTE_LOG2ESTIMATE_GLSL
+#define GTE_LOG2ESTIMATE_GLSL
+
+#define GTE_C_LOG2_DEG1_C1 +1.00000000000000000e+00
+#define GTE_C_LOG2_DEG1_MAX_ERROR +8.60713320559342021e-02
+#define GTE_C_LOG2_DEG2_C1 +1.34655538563778032e+00
+#define GTE_C_LOG2_DEG2_C2 -3.46555385637780322e-01
+#define GTE_C_LOG2_DEG2_MAX_ERROR +7.63628689066581101e-03
+#define GTE_C_LOG2_DEG3_C1 +1.42286537566812266e+00
+#define GTE_C_LOG2_DEG3_C2 -5.82085569164496164e-01
+#define GTE_C_LOG2_DEG3_C3 +1.59220193496372175e-01
+#define GTE_C_LOG2_DEG3_MAX_ERROR +8.79029026528838076e-04
+#define GTE_C_LOG2_DEG4_C1 +1.43872574781715468e+00
+#define GTE_C_LOG2_DEG4_C2 -6.77784013599186608e-01
+#define GTE_C_LOG2_DEG4_C3 +3.21188983777133785e-01
+#define GTE_C_LOG2_DEG4_C4 -8.21307179950885313e-02
+#define GTE_C_LOG2_DEG4_MAX_ERROR +1.13185513553604178e-04
+#define GTE_C_LOG2_DEG5_C1 +1.44191704086337413e+00
+#define GTE_C_LOG2_DEG5_C2 -7.09096459276125302e-01
+#define GTE_C_LOG2_DEG5_C3 +4.15606093991641501e-01
+#define GTE_C_LOG2_DEG5_C4 -1.93575737295589079e-01
+#define GTE_C_LOG2_DEG5_C5 +4.51490617166996344e-02
+#define GTE_C_LOG2_DEG5_MAX_ERROR +1.55212744787358581e-05
+#define GTE_C_LOG2_DEG6_C1 +1.44254494359509167e+00
+#define GTE_C_LOG2_DEG6_C2 -7.18145256750389649e-01
+#define GTE_C_LOG2_DEG6_C3 +4.57549196925640445e-01
+#define GTE_C_LOG2_DEG6_C4 -2.77905344628493367e-01
+#define GTE_C_LOG2_DEG6_C5 +1.21797910687632793e-01
+#define GTE_C_LOG2_DEG6_C6 -2.58414498296701822e-02
+#define GTE_C_LOG2_DEG6_MAX_ERROR +2.21620512166897932e-06
+#define GTE_C_LOG2_DEG7_C1 +1.44266644015360779e+00
+#define GTE_C_LOG2_DEG7_C2 -7.20554237261623598e-01
+#define GTE_C_LOG2_DEG7_C3 +4.73324191625010826e-01
+#define GTE_C_LOG2_DEG7_C4 -3.25140187529541436e-01
+#define GTE_C_LOG2_DEG7_C5 +1.93029655290956725e-01
+#define GTE_C_LOG2_DEG7_C6 -7.85349706411579973e-02
+#define GTE_C_LOG2_DEG7_C7 +1.52091083630239154e-02
+#define GTE_C_LOG2_DEG7_MAX_ERROR +3.25465317002615606e-07
+#define GTE_C_LOG2_DEG8_C1 +1.44268964536218824e+00
+#define GTE_C_LOG2_DEG8_C2 -7.21158939125359666e-01
+#define GTE_C_LOG2_DEG8_C3 +4.78617166167850883e-01
+#define GTE_C_LOG2_DEG8_C4 -3.46999353950195655e-01
+#define GTE_C_LOG2_DEG8_C5 +2.41140487654774915e-01
+#define GTE_C_LOG2_DEG8_C6 -1.36573986928851809e-01
+#define GTE_C_LOG2_DEG8_C7 +5.14213828719221056e-02
+#define GTE_C_LOG2_DEG8_C8 -9.13640204998955596e-03
+#define GTE_C_LOG2_DEG8_MAX_ERROR +4.87962192180502186e-08
+
+float Log2EstimateDegree1(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG1_C1;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree1RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree1(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree1(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG1_C1);
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree1RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree1(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree1(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG1_C1);
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree1RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree1(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree1(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG1_C1);
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree1RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree1(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree2(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG2_C2;
+    poly = GTE_C_LOG2_DEG2_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree2RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree2(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree2(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG2_C2);
+    poly = GTE_C_LOG2_DEG2_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree2RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree2(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree2(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG2_C2);
+    poly = GTE_C_LOG2_DEG2_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree2RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree2(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree2(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG2_C2);
+    poly = GTE_C_LOG2_DEG2_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree2RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree2(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree3(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG3_C3;
+    poly = GTE_C_LOG2_DEG3_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG3_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree3RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree3(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree3(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG3_C3);
+    poly = GTE_C_LOG2_DEG3_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG3_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree3RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree3(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree3(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG3_C3);
+    poly = GTE_C_LOG2_DEG3_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG3_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree3RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree3(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree3(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG3_C3);
+    poly = GTE_C_LOG2_DEG3_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG3_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree3RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree3(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree4(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG4_C4;
+    poly = GTE_C_LOG2_DEG4_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree4RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree4(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree4(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG4_C4);
+    poly = GTE_C_LOG2_DEG4_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree4RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree4(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree4(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG4_C4);
+    poly = GTE_C_LOG2_DEG4_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree4RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree4(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree4(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG4_C4);
+    poly = GTE_C_LOG2_DEG4_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG4_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree4RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree4(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree5(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG5_C5;
+    poly = GTE_C_LOG2_DEG5_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree5RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree5(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree5(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG5_C5);
+    poly = GTE_C_LOG2_DEG5_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree5RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree5(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree5(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG5_C5);
+    poly = GTE_C_LOG2_DEG5_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree5RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree5(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree5(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG5_C5);
+    poly = GTE_C_LOG2_DEG5_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG5_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree5RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree5(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree6(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG6_C6;
+    poly = GTE_C_LOG2_DEG6_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree6RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree6(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree6(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG6_C6);
+    poly = GTE_C_LOG2_DEG6_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree6RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree6(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree6(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG6_C6);
+    poly = GTE_C_LOG2_DEG6_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree6RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree6(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree6(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG6_C6);
+    poly = GTE_C_LOG2_DEG6_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG6_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree6RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree6(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree7(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG7_C7;
+    poly = GTE_C_LOG2_DEG7_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree7RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree7(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree7(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG7_C7);
+    poly = GTE_C_LOG2_DEG7_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree7RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree7(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree7(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG7_C7);
+    poly = GTE_C_LOG2_DEG7_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree7RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree7(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree7(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG7_C7);
+    poly = GTE_C_LOG2_DEG7_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG7_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree7RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree7(2.0 * y) + (p - 1.0);
+}
+
+float Log2EstimateDegree8(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_LOG2_DEG8_C8;
+    poly = GTE_C_LOG2_DEG8_C7 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+float Log2EstimateDegree8RR(float x)
+{
+    int exponent;
+    float y = frexp(x, exponent);
+    float p = float(exponent);
+    return Log2EstimateDegree8(2.0 * y) + (p - 1.0);
+}
+
+vec2 Log2EstimateDegree8(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_LOG2_DEG8_C8);
+    poly = GTE_C_LOG2_DEG8_C7 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec2 Log2EstimateDegree8RR(vec2 x)
+{
+    ivec2 exponent;
+    vec2 y = frexp(x, exponent);
+    vec2 p = vec2(exponent);
+    return Log2EstimateDegree8(2.0 * y) + (p - 1.0);
+}
+
+vec3 Log2EstimateDegree8(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_LOG2_DEG8_C8);
+    poly = GTE_C_LOG2_DEG8_C7 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec3 Log2EstimateDegree8RR(vec3 x)
+{
+    ivec3 exponent;
+    vec3 y = frexp(x, exponent);
+    vec3 p = vec3(exponent);
+    return Log2EstimateDegree8(2.0 * y) + (p - 1.0);
+}
+
+vec4 Log2EstimateDegree8(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_LOG2_DEG8_C8);
+    poly = GTE_C_LOG2_DEG8_C7 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C6 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C5 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C4 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C3 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C2 + poly * t;
+    poly = GTE_C_LOG2_DEG8_C1 + poly * t;
+    poly = poly * t;
+    return poly;
+}
+
+vec4 Log2EstimateDegree8RR(vec4 x)
+{
+    ivec4 exponent;
+    vec4 y = frexp(x, exponent);
+    vec4 p = vec4(exponent);
+    return Log2EstimateDegree8(2.0 * y) + (p - 1.0);
+}
+
+#endif
@@ -0,0 +1,712 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Estimates of the rotation coefficients and of rotation matrices.
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/RotationEstimate.h. Do not edit it.
+
+#ifndef GTE_ROTATIONESTIMATE_GLSL
+#define GTE_ROTATIONESTIMATE_GLSL
+
+#define GTE_C_ROTC0_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG4_C1 -1.58971650732578684e-01
+#define GTE_C_ROTC0_DEG4_C2 +5.84121356311684790e-03
+#define GTE_C_ROTC0_DEG4_MAX_ERROR +6.96563711867499973e-03
+#define GTE_C_ROTC0_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG6_C1 -1.66218398161274539e-01
+#define GTE_C_ROTC0_DEG6_C2 +8.06129151017077016e-03
+#define GTE_C_ROTC0_DEG6_C3 -1.50545944866583496e-04
+#define GTE_C_ROTC0_DEG6_MAX_ERROR +2.23795060895800007e-04
+#define GTE_C_ROTC0_DEG8_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG8_C1 -1.66651290458553397e-01
+#define GTE_C_ROTC0_DEG8_C2 +8.31836205080888937e-03
+#define GTE_C_ROTC0_DEG8_C3 -1.93853969255209339e-04
+#define GTE_C_ROTC0_DEG8_C4 +2.19921657358978346e-06
+#define GTE_C_ROTC0_DEG8_MAX_ERROR +4.86700964347220021e-06
+#define GTE_C_ROTC0_DEG10_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG10_C1 -1.66666320608302304e-01
+#define GTE_C_ROTC0_DEG10_C2 +8.33284074932796014e-03
+#define GTE_C_ROTC0_DEG10_C3 -1.98184457544372085e-04
+#define GTE_C_ROTC0_DEG10_C4 +2.70931602688878442e-06
+#define GTE_C_ROTC0_DEG10_C5 -2.07033154672609224e-08
+#define GTE_C_ROTC0_DEG10_MAX_ERROR +7.56547116065320059e-08
+#define GTE_C_ROTC0_DEG12_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG12_C1 -1.66666661172424985e-01
+#define GTE_C_ROTC0_DEG12_C2 +8.33332258782319701e-03
+#define GTE_C_ROTC0_DEG12_C3 -1.98405693280704135e-04
+#define GTE_C_ROTC0_DEG12_C4 +2.75362742468406608e-06
+#define GTE_C_ROTC0_DEG12_C5 -2.47308402190765123e-08
+#define GTE_C_ROTC0_DEG12_C6 +1.36149932075244694e-10
+#define GTE_C_ROTC0_DEG12_MAX_ERROR +8.79391726105180023e-10
+#define GTE_C_ROTC0_DEG14_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG14_C1 -1.66666666601880786e-01
+#define GTE_C_ROTC0_DEG14_C2 +8.33333316679120591e-03
+#define GTE_C_ROTC0_DEG14_C3 -1.98412553530683797e-04
+#define GTE_C_ROTC0_DEG14_C4 +2.75567210003238900e-06
+#define GTE_C_ROTC0_DEG14_C5 -2.50388692626200884e-08
+#define GTE_C_ROTC0_DEG14_C6 +1.58972932135933544e-10
+#define GTE_C_ROTC0_DEG14_C7 -6.61111627233688785e-13
+#define GTE_C_ROTC0_DEG14_MAX_ERROR +7.91996156157549986e-12
+#define GTE_C_ROTC0_DEG16_C0 +1.00000000000000000e+00
+#define GTE_C_ROTC0_DEG16_C1 -1.66666666666648478e-01
+#define GTE_C_ROTC0_DEG16_C2 +8.33333333318112164e-03
+#define GTE_C_ROTC0_DEG16_C3 -1.98412698077537775e-04
+#define GTE_C_ROTC0_DEG16_C4 +2.75573162083557394e-06
+#define GTE_C_ROTC0_DEG16_C5 -2.50519743096581360e-08
+#define GTE_C_ROTC0_DEG16_C6 +1.60558314470477309e-10
+#define GTE_C_ROTC0_DEG16_C7 -7.60488921303402553e-13
+#define GTE_C_ROTC0_DEG16_C8 +2.52255089807125025e-15
+#define GTE_C_ROTC0_DEG16_MAX_ERROR +6.80011602582909959e-16
+
+#define GTE_C_ROTC1_DEG4_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG4_C1 -4.06593520914583922e-02
+#define GTE_C_ROTC1_DEG4_C2 +1.06698549928666312e-03
+#define GTE_C_ROTC1_DEG4_MAX_ERROR +9.21190101505379956e-04
+#define GTE_C_ROTC1_DEG6_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG6_C1 -4.16202835017619524e-02
+#define GTE_C_ROTC1_DEG6_C2 +1.36087417563353699e-03
+#define GTE_C_ROTC1_DEG6_C3 -1.99122437404000405e-05
+#define GTE_C_ROTC1_DEG6_MAX_ERROR +2.32512618063009984e-05
+#define GTE_C_ROTC1_DEG8_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG8_C1 -4.16653520191245796e-02
+#define GTE_C_ROTC1_DEG8_C2 +1.38761160375298095e-03
+#define GTE_C_ROTC1_DEG8_C3 -2.44138380330618480e-05
+#define GTE_C_ROTC1_DEG8_C4 +2.28499434819148172e-07
+#define GTE_C_ROTC1_DEG8_MAX_ERROR +4.16931608848699986e-07
+#define GTE_C_ROTC1_DEG10_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG10_C1 -4.16666414534321572e-02
+#define GTE_C_ROTC1_DEG10_C2 +1.38885303988537192e-03
+#define GTE_C_ROTC1_DEG10_C3 -2.47850001122705350e-05
+#define GTE_C_ROTC1_DEG10_C4 +2.72207208413898425e-07
+#define GTE_C_ROTC1_DEG10_C5 -1.77358008600681907e-09
+#define GTE_C_ROTC1_DEG10_MAX_ERROR +5.51778875368389998e-09
+#define GTE_C_ROTC1_DEG12_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG12_C1 -4.16666663178411334e-02
+#define GTE_C_ROTC1_DEG12_C2 +1.38888820709641924e-03
+#define GTE_C_ROTC1_DEG12_C3 -2.48011431705518285e-05
+#define GTE_C_ROTC1_DEG12_C4 +2.75439902962340229e-07
+#define GTE_C_ROTC1_DEG12_C5 -2.06736081122602257e-09
+#define GTE_C_ROTC1_DEG12_C6 +9.93003618302030503e-12
+#define GTE_C_ROTC1_DEG12_MAX_ERROR +5.58657009541720000e-11
+#define GTE_C_ROTC1_DEG14_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG14_C1 -4.16666666664263635e-02
+#define GTE_C_ROTC1_DEG14_C2 +1.38888888750799658e-03
+#define GTE_C_ROTC1_DEG14_C3 -2.48015851902670717e-05
+#define GTE_C_ROTC1_DEG14_C4 +2.75571871163332658e-07
+#define GTE_C_ROTC1_DEG14_C5 -2.08727380201649381e-09
+#define GTE_C_ROTC1_DEG14_C6 +1.14076763269827225e-11
+#define GTE_C_ROTC1_DEG14_C7 -4.28619236995285237e-14
+#define GTE_C_ROTC1_DEG14_MAX_ERROR +7.16093850883230071e-15
+#define GTE_C_ROTC1_DEG16_C0 +5.00000000000000000e-01
+#define GTE_C_ROTC1_DEG16_C1 -4.16666666666571719e-02
+#define GTE_C_ROTC1_DEG16_C2 +1.38888888885105744e-03
+#define GTE_C_ROTC1_DEG16_C3 -2.48015872513761947e-05
+#define GTE_C_ROTC1_DEG16_C4 +2.75573160474227648e-07
+#define GTE_C_ROTC1_DEG16_C5 -2.08766469798137579e-09
+#define GTE_C_ROTC1_DEG16_C6 +1.14685460418668139e-11
+#define GTE_C_ROTC1_DEG16_C7 -4.75415775440997119e-14
+#define GTE_C_ROTC1_DEG16_C8 +1.40555891469552795e-16
+#define GTE_C_ROTC1_DEG16_MAX_ERROR +7.21644966006349976e-16
+
+#define GTE_C_ROTC2_DEG4_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG4_C1 -3.24417271573718483e-02
+#define GTE_C_ROTC2_DEG4_C2 +9.05201583387763454e-04
+#define GTE_C_ROTC2_DEG4_MAX_ERROR +8.14615084602289996e-04
+#define GTE_C_ROTC2_DEG6_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG6_C1 -3.32912781805089902e-02
+#define GTE_C_ROTC2_DEG6_C2 +1.16506615743456146e-03
+#define GTE_C_ROTC2_DEG6_C3 -1.76083105011587047e-05
+#define GTE_C_ROTC2_DEG6_MAX_ERROR +2.10750257848560015e-05
+#define GTE_C_ROTC2_DEG8_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG8_C1 -3.33321218985461534e-02
+#define GTE_C_ROTC2_DEG8_C2 +1.18929901553194335e-03
+#define GTE_C_ROTC2_DEG8_C3 -2.16884239911580259e-05
+#define GTE_C_ROTC2_DEG8_C4 +2.07111898922214621e-07
+#define GTE_C_ROTC2_DEG8_MAX_ERROR +3.84148386128880011e-07
+#define GTE_C_ROTC2_DEG10_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG10_C1 -3.33333098285273563e-02
+#define GTE_C_ROTC2_DEG10_C2 +1.19044276839748377e-03
+#define GTE_C_ROTC2_DEG10_C3 -2.20303898188601926e-05
+#define GTE_C_ROTC2_DEG10_C4 +2.47382309397892291e-07
+#define GTE_C_ROTC2_DEG10_C5 -1.63412179599052932e-09
+#define GTE_C_ROTC2_DEG10_MAX_ERROR +5.14359671521799999e-09
+#define GTE_C_ROTC2_DEG12_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG12_C1 -3.33333330053029661e-02
+#define GTE_C_ROTC2_DEG12_C2 +1.19047554930589209e-03
+#define GTE_C_ROTC2_DEG12_C3 -2.20454376925152508e-05
+#define GTE_C_ROTC2_DEG12_C4 +2.50395723787030737e-07
+#define GTE_C_ROTC2_DEG12_C5 -1.90797721719554658e-09
+#define GTE_C_ROTC2_DEG12_C6 +9.25661051509749896e-12
+#define GTE_C_ROTC2_DEG12_MAX_ERROR +5.25335885903640007e-11
+#define GTE_C_ROTC2_DEG14_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG14_C1 -3.33333333331133561e-02
+#define GTE_C_ROTC2_DEG14_C2 +1.19047618918715682e-03
+#define GTE_C_ROTC2_DEG14_C3 -2.20458533943125258e-05
+#define GTE_C_ROTC2_DEG14_C4 +2.50519837811549507e-07
+#define GTE_C_ROTC2_DEG14_C5 -1.92670551155064303e-09
+#define GTE_C_ROTC2_DEG14_C6 +1.06463697865186991e-11
+#define GTE_C_ROTC2_DEG14_C7 -4.03135292145519115e-14
+#define GTE_C_ROTC2_DEG14_MAX_ERROR +7.77156117237610052e-15
+#define GTE_C_ROTC2_DEG16_C0 +3.33333333333333315e-01
+#define GTE_C_ROTC2_DEG16_C1 -3.33333333333034956e-02
+#define GTE_C_ROTC2_DEG16_C2 +1.19047619036920628e-03
+#define GTE_C_ROTC2_DEG16_C3 -2.20458552540489507e-05
+#define GTE_C_ROTC2_DEG16_C4 +2.50521015434838418e-07
+#define GTE_C_ROTC2_DEG16_C5 -1.92706504721931338e-09
+#define GTE_C_ROTC2_DEG16_C6 +1.07026043656398707e-11
+#define GTE_C_ROTC2_DEG16_C7 -4.46498739610373537e-14
+#define GTE_C_ROTC2_DEG16_C8 +1.30526089083317312e-16
+#define GTE_C_ROTC2_DEG16_MAX_ERROR +2.27595720048160010e-15
+
+#define GTE_C_ROTC3_DEG4_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG4_C1 -5.46357009138465424e-03
+#define GTE_C_ROTC3_DEG4_C2 +1.19638433962248889e-04
+#define GTE_C_ROTC3_DEG4_MAX_ERROR +8.46120368888859980e-05
+#define GTE_C_ROTC3_DEG6_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG6_C1 -5.55196372993948303e-03
+#define GTE_C_ROTC3_DEG6_C2 +1.46646667516630680e-04
+#define GTE_C_ROTC3_DEG6_C3 -1.82905866698780768e-06
+#define GTE_C_ROTC3_DEG6_MAX_ERROR +1.80519731859949996e-06
+#define GTE_C_ROTC3_DEG8_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG8_C1 -5.55546733314307706e-03
+#define GTE_C_ROTC3_DEG8_C2 +1.48723933698110248e-04
+#define GTE_C_ROTC3_DEG8_C3 -2.17865651989456709e-06
+#define GTE_C_ROTC3_DEG8_C4 +1.77408035681006169e-08
+#define GTE_C_ROTC3_DEG8_MAX_ERROR +2.80161039506449991e-08
+#define GTE_C_ROTC3_DEG10_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG10_C1 -5.55555406357728914e-03
+#define GTE_C_ROTC3_DEG10_C2 +1.48807404153008735e-04
+#define GTE_C_ROTC3_DEG10_C3 -2.20360578108261882e-06
+#define GTE_C_ROTC3_DEG10_C4 +2.06782449582308932e-08
+#define GTE_C_ROTC3_DEG10_C5 -1.19178562817913197e-10
+#define GTE_C_ROTC3_DEG10_MAX_ERROR +3.26754151513950018e-10
+#define GTE_C_ROTC3_DEG12_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG12_C1 -5.55555555324832757e-03
+#define GTE_C_ROTC3_DEG12_C2 +1.48809514798423797e-04
+#define GTE_C_ROTC3_DEG12_C3 -2.20457622072950518e-06
+#define GTE_C_ROTC3_DEG12_C4 +2.08728631685852690e-08
+#define GTE_C_ROTC3_DEG12_C5 -1.36888190776165574e-10
+#define GTE_C_ROTC3_DEG12_C6 +5.99292681875750821e-13
+#define GTE_C_ROTC3_DEG12_MAX_ERROR +1.37140299116819988e-13
+#define GTE_C_ROTC3_DEG14_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG14_C1 -5.55555555528319030e-03
+#define GTE_C_ROTC3_DEG14_C2 +1.48809523101214977e-04
+#define GTE_C_ROTC3_DEG14_C3 -2.20458493798151629e-06
+#define GTE_C_ROTC3_DEG14_C4 +2.08765224186559757e-08
+#define GTE_C_ROTC3_DEG14_C5 -1.37600800115177215e-10
+#define GTE_C_ROTC3_DEG14_C6 +6.63762129016229865e-13
+#define GTE_C_ROTC3_DEG14_C7 -2.19044013684859942e-15
+#define GTE_C_ROTC3_DEG14_MAX_ERROR +3.20785065177629969e-14
+#define GTE_C_ROTC3_DEG16_C0 +8.33333333333333287e-02
+#define GTE_C_ROTC3_DEG16_C1 -5.55555555501025672e-03
+#define GTE_C_ROTC3_DEG16_C2 +1.48809521898935978e-04
+#define GTE_C_ROTC3_DEG16_C3 -2.20458342827337994e-06
+#define GTE_C_ROTC3_DEG16_C4 +2.08757075326674457e-08
+#define GTE_C_ROTC3_DEG16_C5 -1.37379825035843510e-10
+#define GTE_C_ROTC3_DEG16_C6 +6.32209097599974706e-13
+#define GTE_C_ROTC3_DEG16_C7 +7.39204014316007136e-17
+#define GTE_C_ROTC3_DEG16_C8 -6.43236558920699052e-17
+#define GTE_C_ROTC3_DEG16_MAX_ERROR +4.77742845284010023e-14
+
+float RotC0EstimateDegree4(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG4_C2;
+    poly = GTE_C_ROTC0_DEG4_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG4_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree4(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG4_C2;
+    poly = GTE_C_ROTC1_DEG4_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG4_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree4(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG4_C2;
+    poly = GTE_C_ROTC2_DEG4_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG4_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree4(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG4_C2;
+    poly = GTE_C_ROTC3_DEG4_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG4_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree4(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree4(t);
+    float b = RotC1EstimateDegree4(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+float RotC0EstimateDegree6(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG6_C3;
+    poly = GTE_C_ROTC0_DEG6_C2 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG6_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG6_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree6(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG6_C3;
+    poly = GTE_C_ROTC1_DEG6_C2 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG6_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG6_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree6(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG6_C3;
+    poly = GTE_C_ROTC2_DEG6_C2 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG6_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG6_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree6(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG6_C3;
+    poly = GTE_C_ROTC3_DEG6_C2 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG6_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG6_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree6(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree6(t);
+    float b = RotC1EstimateDegree6(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+float RotC0EstimateDegree8(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG8_C4;
+    poly = GTE_C_ROTC0_DEG8_C3 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG8_C2 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG8_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG8_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree8(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG8_C4;
+    poly = GTE_C_ROTC1_DEG8_C3 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG8_C2 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG8_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG8_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree8(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG8_C4;
+    poly = GTE_C_ROTC2_DEG8_C3 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG8_C2 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG8_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG8_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree8(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG8_C4;
+    poly = GTE_C_ROTC3_DEG8_C3 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG8_C2 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG8_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG8_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree8(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree8(t);
+    float b = RotC1EstimateDegree8(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+float RotC0EstimateDegree10(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG10_C5;
+    poly = GTE_C_ROTC0_DEG10_C4 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG10_C3 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG10_C2 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG10_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG10_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree10(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG10_C5;
+    poly = GTE_C_ROTC1_DEG10_C4 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG10_C3 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG10_C2 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG10_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG10_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree10(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG10_C5;
+    poly = GTE_C_ROTC2_DEG10_C4 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG10_C3 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG10_C2 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG10_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG10_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree10(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG10_C5;
+    poly = GTE_C_ROTC3_DEG10_C4 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG10_C3 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG10_C2 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG10_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG10_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree10(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree10(t);
+    float b = RotC1EstimateDegree10(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+float RotC0EstimateDegree12(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG12_C6;
+    poly = GTE_C_ROTC0_DEG12_C5 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG12_C4 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG12_C3 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG12_C2 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG12_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG12_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree12(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG12_C6;
+    poly = GTE_C_ROTC1_DEG12_C5 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG12_C4 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG12_C3 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG12_C2 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG12_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG12_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree12(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG12_C6;
+    poly = GTE_C_ROTC2_DEG12_C5 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG12_C4 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG12_C3 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG12_C2 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG12_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG12_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree12(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG12_C6;
+    poly = GTE_C_ROTC3_DEG12_C5 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG12_C4 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG12_C3 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG12_C2 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG12_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG12_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree12(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree12(t);
+    float b = RotC1EstimateDegree12(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+float RotC0EstimateDegree14(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG14_C7;
+    poly = GTE_C_ROTC0_DEG14_C6 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG14_C5 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG14_C4 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG14_C3 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG14_C2 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG14_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG14_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree14(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG14_C7;
+    poly = GTE_C_ROTC1_DEG14_C6 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG14_C5 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG14_C4 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG14_C3 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG14_C2 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG14_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG14_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree14(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG14_C7;
+    poly = GTE_C_ROTC2_DEG14_C6 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG14_C5 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG14_C4 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG14_C3 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG14_C2 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG14_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG14_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree14(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG14_C7;
+    poly = GTE_C_ROTC3_DEG14_C6 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG14_C5 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG14_C4 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG14_C3 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG14_C2 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG14_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG14_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree14(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree14(t);
+    float b = RotC1EstimateDegree14(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+float RotC0EstimateDegree16(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC0_DEG16_C8;
+    poly = GTE_C_ROTC0_DEG16_C7 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C6 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C5 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C4 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C3 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C2 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C1 + poly * tsqr;
+    poly = GTE_C_ROTC0_DEG16_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC1EstimateDegree16(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC1_DEG16_C8;
+    poly = GTE_C_ROTC1_DEG16_C7 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C6 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C5 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C4 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C3 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C2 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C1 + poly * tsqr;
+    poly = GTE_C_ROTC1_DEG16_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC2EstimateDegree16(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC2_DEG16_C8;
+    poly = GTE_C_ROTC2_DEG16_C7 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C6 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C5 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C4 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C3 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C2 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C1 + poly * tsqr;
+    poly = GTE_C_ROTC2_DEG16_C0 + poly * tsqr;
+    return poly;
+}
+
+float RotC3EstimateDegree16(float t)
+{
+    float tsqr = t * t;
+    float poly;
+    poly = GTE_C_ROTC3_DEG16_C8;
+    poly = GTE_C_ROTC3_DEG16_C7 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C6 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C5 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C4 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C3 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C2 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C1 + poly * tsqr;
+    poly = GTE_C_ROTC3_DEG16_C0 + poly * tsqr;
+    return poly;
+}
+
+mat3 RotationEstimateDegree16(vec3 p)
+{
+    float t = length(p);
+    float a = RotC0EstimateDegree16(t);
+    float b = RotC1EstimateDegree16(t);
+    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;
+    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;
+    float r00 = 1.0 - b * (p1p1 + p2p2);
+    float r01 = -a * p.z + b * p0p1;
+    float r02 = a * p.y + b * p0p2;
+    float r10 = a * p.z + b * p0p1;
+    float r11 = 1.0 - b * (p0p0 + p2p2);
+    float r12 = -a * p.x + b * p1p2;
+    float r20 = -a * p.y + b * p0p2;
+    float r21 = a * p.x + b * p1p2;
+    float r22 = 1.0 - b * (p0p0 + p1p1);
+    return mat3(r00, r10, r20, r01, r11, r21, r02, r12, r22);
+}
+
+#endif
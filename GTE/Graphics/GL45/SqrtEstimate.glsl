@@ -0,0 +1,802 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to sqrt(x) for x in [1,2].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/SqrtEstimate.h. Do not edit it.
+
+#ifndef GTE_SQRTESTIMATE_GLSL
+#define GTE_SQRTESTIMATE_GLSL
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_SQRT_DEG1_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG1_C1 +4.14213562373095034e-01
+#define GTE_C_SQRT_DEG1_MAX_ERROR +1.77669529663687931e-02
+#define GTE_C_SQRT_DEG2_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG2_C1 +4.85631830761252603e-01
+#define GTE_C_SQRT_DEG2_C2 -7.14182683881574576e-02
+#define GTE_C_SQRT_DEG2_MAX_ERROR +1.17956951631087437e-03
+#define GTE_C_SQRT_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG3_C1 +4.97500453202422310e-01
+#define GTE_C_SQRT_DEG3_C2 -1.07873080444778502e-01
+#define GTE_C_SQRT_DEG3_C3 +2.45861896154511150e-02
+#define GTE_C_SQRT_DEG3_MAX_ERROR +1.13096201164689103e-04
+#define GTE_C_SQRT_DEG4_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG4_C1 +4.99559398329188165e-01
+#define GTE_C_SQRT_DEG4_C2 -1.20240661519430247e-01
+#define GTE_C_SQRT_DEG4_C3 +4.54615072576984858e-02
+#define GTE_C_SQRT_DEG4_C4 -1.05666816943621455e-02
+#define GTE_C_SQRT_DEG4_MAX_ERROR +1.27411701515561804e-05
+#define GTE_C_SQRT_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG5_C1 +4.99921976600319118e-01
+#define GTE_C_SQRT_DEG5_C2 -1.23785067192450526e-01
+#define GTE_C_SQRT_DEG5_C3 +5.61227769726997394e-02
+#define GTE_C_SQRT_DEG5_C4 -2.31288362811454817e-02
+#define GTE_C_SQRT_DEG5_C5 +5.08271227370471479e-03
+#define GTE_C_SQRT_DEG5_MAX_ERROR +1.57255689407082011e-06
+#define GTE_C_SQRT_DEG6_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG6_C1 +4.99986166957849143e-01
+#define GTE_C_SQRT_DEG6_C2 -1.24707333232784379e-01
+#define GTE_C_SQRT_DEG6_C3 +6.03885873569822706e-02
+#define GTE_C_SQRT_DEG6_C4 -3.16920535518079305e-02
+#define GTE_C_SQRT_DEG6_C5 +1.28565903051480745e-02
+#define GTE_C_SQRT_DEG6_C6 -2.61839546243436416e-03
+#define GTE_C_SQRT_DEG6_MAX_ERROR +2.05841555356300887e-07
+#define GTE_C_SQRT_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG7_C1 +4.99997548178092277e-01
+#define GTE_C_SQRT_DEG7_C2 -1.24932434763536548e-01
+#define GTE_C_SQRT_DEG7_C3 +6.18599541463709102e-02
+#define GTE_C_SQRT_DEG7_C4 -3.60915950232083560e-02
+#define GTE_C_SQRT_DEG7_C5 +1.94839465234508680e-02
+#define GTE_C_SQRT_DEG7_C6 -7.51661345680076920e-03
+#define GTE_C_SQRT_DEG7_C7 +1.41275676878649392e-03
+#define GTE_C_SQRT_DEG7_MAX_ERROR +2.80723029197349483e-08
+#define GTE_C_SQRT_DEG8_C0 +1.00000000000000000e+00
+#define GTE_C_SQRT_DEG8_C1 +4.99999565830567594e-01
+#define GTE_C_SQRT_DEG8_C2 -1.24984903699143501e-01
+#define GTE_C_SQRT_DEG8_C3 +6.23184946675792162e-02
+#define GTE_C_SQRT_DEG8_C4 -3.79829618964322435e-02
+#define GTE_C_SQRT_DEG8_C5 +2.36426123128694599e-02
+#define GTE_C_SQRT_DEG8_C6 -1.25293775872705737e-02
+#define GTE_C_SQRT_DEG8_C7 +4.53824269607139286e-03
+#define GTE_C_SQRT_DEG8_C8 -7.88109952736704145e-04
+#define GTE_C_SQRT_DEG8_MAX_ERROR +3.94606056858259890e-09
+
+void SqrtEstimateReduce(float x, out float adj, out float y, out float p)
+{
+    int exponent;
+    y = frexp(x, exponent);
+    p = float(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    float half = floor(0.5 * p);
+    adj = ((p - 2.0 * half > 0.0) ? GTE_C_SQRT_2 : 1.0);
+    p = half;
+}
+
+float SqrtEstimateCombine(float adj, float y, float p)
+{
+    return adj * ldexp(y, int(p));
+}
+
+void SqrtEstimateReduce(vec2 x, out vec2 adj, out vec2 y, out vec2 p)
+{
+    ivec2 exponent;
+    y = frexp(x, exponent);
+    p = vec2(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    vec2 half = floor(0.5 * p);
+    adj = mix(vec2(1.0), vec2(GTE_C_SQRT_2), greaterThan(p - 2.0 * half, vec2(0.0)));
+    p = half;
+}
+
+vec2 SqrtEstimateCombine(vec2 adj, vec2 y, vec2 p)
+{
+    return adj * ldexp(y, ivec2(p));
+}
+
+void SqrtEstimateReduce(vec3 x, out vec3 adj, out vec3 y, out vec3 p)
+{
+    ivec3 exponent;
+    y = frexp(x, exponent);
+    p = vec3(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    vec3 half = floor(0.5 * p);
+    adj = mix(vec3(1.0), vec3(GTE_C_SQRT_2), greaterThan(p - 2.0 * half, vec3(0.0)));
+    p = half;
+}
+
+vec3 SqrtEstimateCombine(vec3 adj, vec3 y, vec3 p)
+{
+    return adj * ldexp(y, ivec3(p));
+}
+
+void SqrtEstimateReduce(vec4 x, out vec4 adj, out vec4 y, out vec4 p)
+{
+    ivec4 exponent;
+    y = frexp(x, exponent);
+    p = vec4(exponent);
+    y = 2.0 * y;
+    p = p - 1.0;
+    vec4 half = floor(0.5 * p);
+    adj = mix(vec4(1.0), vec4(GTE_C_SQRT_2), greaterThan(p - 2.0 * half, vec4(0.0)));
+    p = half;
+}
+
+vec4 SqrtEstimateCombine(vec4 adj, vec4 y, vec4 p)
+{
+    return adj * ldexp(y, ivec4(p));
+}
+
+float SqrtEstimateDegree1(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG1_C1;
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree1RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree1(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG1_C1);
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree1RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree1(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG1_C1);
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree1RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree1(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG1_C1);
+    poly = GTE_C_SQRT_DEG1_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree1RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree1(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree2(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG2_C2;
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree2RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree2(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG2_C2);
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree2RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree2(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG2_C2);
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree2RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree2(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG2_C2);
+    poly = GTE_C_SQRT_DEG2_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG2_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree2RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree2(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree3(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG3_C3;
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree3RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree3(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG3_C3);
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree3RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree3(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG3_C3);
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree3RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree3(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG3_C3);
+    poly = GTE_C_SQRT_DEG3_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG3_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree3RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree3(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree4(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG4_C4;
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree4RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree4(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG4_C4);
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree4RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree4(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG4_C4);
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree4RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree4(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG4_C4);
+    poly = GTE_C_SQRT_DEG4_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG4_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree4RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree4(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree5(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG5_C5;
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree5RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree5(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG5_C5);
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree5RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree5(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG5_C5);
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree5RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree5(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG5_C5);
+    poly = GTE_C_SQRT_DEG5_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG5_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree5RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree5(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree6(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG6_C6;
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree6RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree6(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG6_C6);
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree6RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree6(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG6_C6);
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree6RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree6(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG6_C6);
+    poly = GTE_C_SQRT_DEG6_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG6_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree6RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree6(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree7(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG7_C7;
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree7RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree7(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG7_C7);
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree7RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree7(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG7_C7);
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree7RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree7(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG7_C7);
+    poly = GTE_C_SQRT_DEG7_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG7_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree7RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree7(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+float SqrtEstimateDegree8(float x)
+{
+    float t = x - 1.0;
+    float poly;
+    poly = GTE_C_SQRT_DEG8_C8;
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+float SqrtEstimateDegree8RR(float x)
+{
+    float adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    float poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec2 SqrtEstimateDegree8(vec2 x)
+{
+    vec2 t = x - 1.0;
+    vec2 poly;
+    poly = vec2(GTE_C_SQRT_DEG8_C8);
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+vec2 SqrtEstimateDegree8RR(vec2 x)
+{
+    vec2 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec2 poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec3 SqrtEstimateDegree8(vec3 x)
+{
+    vec3 t = x - 1.0;
+    vec3 poly;
+    poly = vec3(GTE_C_SQRT_DEG8_C8);
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+vec3 SqrtEstimateDegree8RR(vec3 x)
+{
+    vec3 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec3 poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+vec4 SqrtEstimateDegree8(vec4 x)
+{
+    vec4 t = x - 1.0;
+    vec4 poly;
+    poly = vec4(GTE_C_SQRT_DEG8_C8);
+    poly = GTE_C_SQRT_DEG8_C7 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C6 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C5 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C4 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C3 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C2 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C1 + poly * t;
+    poly = GTE_C_SQRT_DEG8_C0 + poly * t;
+    return poly;
+}
+
+vec4 SqrtEstimateDegree8RR(vec4 x)
+{
+    vec4 adj, y, p;
+    SqrtEstimateReduce(x, adj, y, p);
+    vec4 poly = SqrtEstimateDegree8(y);
+    return SqrtEstimateCombine(adj, poly, p);
+}
+
+#endif
@@ -0,0 +1,587 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+// Minimax polynomial approximations to tan(x) for x in [-pi/4,pi/4].
+// This file is generated by Tools/GenerateApproximations from the
+// coefficients used by Mathematics/TanEstimate.h. Do not edit it.
+
+#ifndef GTE_TANESTIMATE_GLSL
+#define GTE_TANESTIMATE_GLSL
+
+#ifndef GTE_C_PI
+#define GTE_C_PI +3.14159265358979312e+00
+#define GTE_C_HALF_PI +1.57079632679489656e+00
+#define GTE_C_QUARTER_PI +7.85398163397448279e-01
+#define GTE_C_TWO_PI +6.28318530717958623e+00
+#define GTE_C_INV_TWO_PI +1.59154943091895290e-01
+#define GTE_C_SQRT_2 +1.41421356237309515e+00
+#define GTE_C_INV_SQRT_2 +7.07106781186547462e-01
+#endif
+
+#define GTE_C_TAN_DEG3_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG3_C1 +4.42959265447362860e-01
+#define GTE_C_TAN_DEG3_MAX_ERROR +1.16618922562047311e-02
+#define GTE_C_TAN_DEG5_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG5_C1 +3.14013204035424209e-01
+#define GTE_C_TAN_DEG5_C2 +2.09039481092403445e-01
+#define GTE_C_TAN_DEG5_MAX_ERROR +5.84318543901431176e-04
+#define GTE_C_TAN_DEG7_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG7_C1 +3.36072132844225546e-01
+#define GTE_C_TAN_DEG7_C2 +1.12610373051849066e-01
+#define GTE_C_TAN_DEG7_C3 +9.83520994705244789e-02
+#define GTE_C_TAN_DEG7_MAX_ERROR +3.54186883977231082e-05
+#define GTE_C_TAN_DEG9_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG9_C1 +3.32992328439417840e-01
+#define GTE_C_TAN_DEG9_C2 +1.37478434324748378e-01
+#define GTE_C_TAN_DEG9_C3 +3.76963448130283041e-02
+#define GTE_C_TAN_DEG9_C4 +4.60973772792812042e-02
+#define GTE_C_TAN_DEG9_MAX_ERROR +2.29881732421999274e-06
+#define GTE_C_TAN_DEG11_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG11_C1 +3.33372244562242237e-01
+#define GTE_C_TAN_DEG11_C2 +1.32645160538245932e-01
+#define GTE_C_TAN_DEG11_C3 +5.81452376459310472e-02
+#define GTE_C_TAN_DEG11_C4 +1.07321932375725737e-02
+#define GTE_C_TAN_DEG11_C5 +2.15584567935138693e-02
+#define GTE_C_TAN_DEG11_MAX_ERROR +1.54262579401404087e-07
+#define GTE_C_TAN_DEG13_C0 +1.00000000000000000e+00
+#define GTE_C_TAN_DEG13_C1 +3.33329164263945543e-01
+#define GTE_C_TAN_DEG13_C2 +1.33434046251124983e-01
+#define GTE_C_TAN_DEG13_C3 +5.31045653431192477e-02
+#define GTE_C_TAN_DEG13_C4 +2.53550383126821544e-02
+#define GTE_C_TAN_DEG13_C5 +1.82532559665560257e-03
+#define GTE_C_TAN_DEG13_C6 +1.00694071766156412e-02
+#define GTE_C_TAN_DEG13_MAX_ERROR +1.05502642490373777e-08
+
+float TanEstimateReduce(float x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    float y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return ((y > GTE_C_HALF_PI) ? y - GTE_C_PI : ((y < -GTE_C_HALF_PI) ? y + GTE_C_PI : y));
+}
+
+vec2 TanEstimateReduce(vec2 x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    vec2 y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return mix(mix(y, y + GTE_C_PI, lessThan(y, vec2(-GTE_C_HALF_PI))), y - GTE_C_PI, greaterThan(y, vec2(GTE_C_HALF_PI)));
+}
+
+vec3 TanEstimateReduce(vec3 x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    vec3 y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return mix(mix(y, y + GTE_C_PI, lessThan(y, vec3(-GTE_C_HALF_PI))), y - GTE_C_PI, greaterThan(y, vec3(GTE_C_HALF_PI)));
+}
+
+vec4 TanEstimateReduce(vec4 x)
+{
+    // Map x to y in [-pi,pi], x = pi*quotient + remainder.
+    vec4 y = x - GTE_C_PI * trunc(x / GTE_C_PI);
+
+    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).
+    return mix(mix(y, y + GTE_C_PI, lessThan(y, vec4(-GTE_C_HALF_PI))), y - GTE_C_PI, greaterThan(y, vec4(GTE_C_HALF_PI)));
+}
+
+float TanEstimateDegree3(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG3_C1;
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree3RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree3(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+vec2 TanEstimateDegree3(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_TAN_DEG3_C1);
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 TanEstimateDegree3RR(vec2 x)
+{
+    vec2 y = TanEstimateReduce(x);
+    vec2 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec2(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+    vec2 poly = TanEstimateDegree3(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec2(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+}
+
+vec3 TanEstimateDegree3(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_TAN_DEG3_C1);
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 TanEstimateDegree3RR(vec3 x)
+{
+    vec3 y = TanEstimateReduce(x);
+    vec3 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec3(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+    vec3 poly = TanEstimateDegree3(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec3(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+}
+
+vec4 TanEstimateDegree3(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_TAN_DEG3_C1);
+    poly = GTE_C_TAN_DEG3_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 TanEstimateDegree3RR(vec4 x)
+{
+    vec4 y = TanEstimateReduce(x);
+    vec4 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec4(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+    vec4 poly = TanEstimateDegree3(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec4(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+}
+
+float TanEstimateDegree5(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG5_C2;
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree5RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree5(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+vec2 TanEstimateDegree5(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_TAN_DEG5_C2);
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 TanEstimateDegree5RR(vec2 x)
+{
+    vec2 y = TanEstimateReduce(x);
+    vec2 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec2(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+    vec2 poly = TanEstimateDegree5(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec2(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+}
+
+vec3 TanEstimateDegree5(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_TAN_DEG5_C2);
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 TanEstimateDegree5RR(vec3 x)
+{
+    vec3 y = TanEstimateReduce(x);
+    vec3 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec3(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+    vec3 poly = TanEstimateDegree5(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec3(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+}
+
+vec4 TanEstimateDegree5(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_TAN_DEG5_C2);
+    poly = GTE_C_TAN_DEG5_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG5_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 TanEstimateDegree5RR(vec4 x)
+{
+    vec4 y = TanEstimateReduce(x);
+    vec4 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec4(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+    vec4 poly = TanEstimateDegree5(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec4(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+}
+
+float TanEstimateDegree7(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG7_C3;
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree7RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree7(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+vec2 TanEstimateDegree7(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_TAN_DEG7_C3);
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 TanEstimateDegree7RR(vec2 x)
+{
+    vec2 y = TanEstimateReduce(x);
+    vec2 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec2(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+    vec2 poly = TanEstimateDegree7(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec2(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+}
+
+vec3 TanEstimateDegree7(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_TAN_DEG7_C3);
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 TanEstimateDegree7RR(vec3 x)
+{
+    vec3 y = TanEstimateReduce(x);
+    vec3 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec3(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+    vec3 poly = TanEstimateDegree7(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec3(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+}
+
+vec4 TanEstimateDegree7(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_TAN_DEG7_C3);
+    poly = GTE_C_TAN_DEG7_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG7_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 TanEstimateDegree7RR(vec4 x)
+{
+    vec4 y = TanEstimateReduce(x);
+    vec4 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec4(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+    vec4 poly = TanEstimateDegree7(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec4(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+}
+
+float TanEstimateDegree9(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG9_C4;
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree9RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree9(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+vec2 TanEstimateDegree9(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_TAN_DEG9_C4);
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 TanEstimateDegree9RR(vec2 x)
+{
+    vec2 y = TanEstimateReduce(x);
+    vec2 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec2(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+    vec2 poly = TanEstimateDegree9(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec2(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+}
+
+vec3 TanEstimateDegree9(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_TAN_DEG9_C4);
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 TanEstimateDegree9RR(vec3 x)
+{
+    vec3 y = TanEstimateReduce(x);
+    vec3 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec3(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+    vec3 poly = TanEstimateDegree9(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec3(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+}
+
+vec4 TanEstimateDegree9(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_TAN_DEG9_C4);
+    poly = GTE_C_TAN_DEG9_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG9_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 TanEstimateDegree9RR(vec4 x)
+{
+    vec4 y = TanEstimateReduce(x);
+    vec4 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec4(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+    vec4 poly = TanEstimateDegree9(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec4(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+}
+
+float TanEstimateDegree11(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG11_C5;
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree11RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree11(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+vec2 TanEstimateDegree11(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_TAN_DEG11_C5);
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 TanEstimateDegree11RR(vec2 x)
+{
+    vec2 y = TanEstimateReduce(x);
+    vec2 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec2(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+    vec2 poly = TanEstimateDegree11(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec2(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+}
+
+vec3 TanEstimateDegree11(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_TAN_DEG11_C5);
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 TanEstimateDegree11RR(vec3 x)
+{
+    vec3 y = TanEstimateReduce(x);
+    vec3 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec3(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+    vec3 poly = TanEstimateDegree11(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec3(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+}
+
+vec4 TanEstimateDegree11(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_TAN_DEG11_C5);
+    poly = GTE_C_TAN_DEG11_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG11_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 TanEstimateDegree11RR(vec4 x)
+{
+    vec4 y = TanEstimateReduce(x);
+    vec4 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec4(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+    vec4 poly = TanEstimateDegree11(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec4(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+}
+
+float TanEstimateDegree13(float x)
+{
+    float xsqr = x * x;
+    float poly;
+    poly = GTE_C_TAN_DEG13_C6;
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+float TanEstimateDegree13RR(float x)
+{
+    float y = TanEstimateReduce(x);
+    float z = ((y > GTE_C_QUARTER_PI) ? y - GTE_C_QUARTER_PI : ((y < -GTE_C_QUARTER_PI) ? y + GTE_C_QUARTER_PI : y));
+    float poly = TanEstimateDegree13(z);
+    return ((y > GTE_C_QUARTER_PI) ? (1.0 + poly) / (1.0 - poly) : ((y < -GTE_C_QUARTER_PI) ? -(1.0 - poly) / (1.0 + poly) : poly));
+}
+
+vec2 TanEstimateDegree13(vec2 x)
+{
+    vec2 xsqr = x * x;
+    vec2 poly;
+    poly = vec2(GTE_C_TAN_DEG13_C6);
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec2 TanEstimateDegree13RR(vec2 x)
+{
+    vec2 y = TanEstimateReduce(x);
+    vec2 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec2(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+    vec2 poly = TanEstimateDegree13(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec2(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec2(GTE_C_QUARTER_PI)));
+}
+
+vec3 TanEstimateDegree13(vec3 x)
+{
+    vec3 xsqr = x * x;
+    vec3 poly;
+    poly = vec3(GTE_C_TAN_DEG13_C6);
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec3 TanEstimateDegree13RR(vec3 x)
+{
+    vec3 y = TanEstimateReduce(x);
+    vec3 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec3(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+    vec3 poly = TanEstimateDegree13(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec3(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec3(GTE_C_QUARTER_PI)));
+}
+
+vec4 TanEstimateDegree13(vec4 x)
+{
+    vec4 xsqr = x * x;
+    vec4 poly;
+    poly = vec4(GTE_C_TAN_DEG13_C6);
+    poly = GTE_C_TAN_DEG13_C5 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C4 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C3 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C2 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C1 + poly * xsqr;
+    poly = GTE_C_TAN_DEG13_C0 + poly * xsqr;
+    poly = poly * x;
+    return poly;
+}
+
+vec4 TanEstimateDegree13RR(vec4 x)
+{
+    vec4 y = TanEstimateReduce(x);
+    vec4 z = mix(mix(y, y + GTE_C_QUARTER_PI, lessThan(y, vec4(-GTE_C_QUARTER_PI))), y - GTE_C_QUARTER_PI, greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+    vec4 poly = TanEstimateDegree13(z);
+    return mix(mix(poly, -(1.0 - poly) / (1.0 + poly), lessThan(y, vec4(-GTE_C_QUARTER_PI))), (1.0 + poly) / (1.0 - poly), greaterThan(y, vec4(GTE_C_QUARTER_PI)));
+}
+
+#endif
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GL45/GTGraphicsGL45PCH.h>
 #include <Graphics/GL45/WGL/WGLEngine.h>
@@ -90,6 +90,7 @@ void WGLEngine::DisplayColorBuffer(unsigned int syncInterval)
 {
     wglSwapIntervalEXT(syncInterval > 0 ? 1 : 0);
     SwapBuffers(mDevice);
+    EndFrameStatistics();
 }
 
 bool WGLEngine::Initialize(int requiredMajor, int requiredMinor, bool useDepth24Stencil8, bool saveDriverInfo)
@@ -0,0 +1,689 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/GPUParticles.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstring>
+using namespace gte;
+
+GPUParticles::GPUParticles(std::shared_ptr<ProgramFactory> const& factory,
+    unsigned int maxParticles, float sizeAdjust)
+    :
+    mMaxParticles(maxParticles),
+    mSizeAdjust(sizeAdjust),
+    mFrame(0)
+{
+    LogAssert(maxParticles > 0, "At least one particle is required.");
+    LogAssert(sizeAdjust > 0.0f, "Invalid size-adjust parameter.");
+
+    // The quadrilateral whose instances are the billboards. The position
+    // of a vertex stores the coefficients of the camera vectors U+R and
+    // U-R, and the texture coordinates are those of Particles.
+    struct Vertex
+    {
+        Vector2<float> corner, tcoord;
+    };
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32_FLOAT, 0);
+    vformat.Bind(VA_TEXCOORD, DF_R32G32_FLOAT, 0);
+    mVBuffer = std::make_shared<VertexBuffer>(vformat, 4);
+    auto vertices = mVBuffer->Get<Vertex>();
+    vertices[0] = { { -1.0f, 0.0f }, { 0.0f, 0.0f } };
+    vertices[1] = { { 0.0f, -1.0f }, { 1.0f, 0.0f } };
+    vertices[2] = { { 1.0f, 0.0f }, { 1.0f, 1.0f } };
+    vertices[3] = { { 0.0f, 1.0f }, { 0.0f, 1.0f } };
+
+    mIBuffer = std::make_shared<IndexBuffer>(IP_TRIMESH, 2, sizeof(unsigned int));
+    auto indices = mIBuffer->Get<unsigned int>();
+    indices[0] = 0;  indices[1] = 1;  indices[2] = 2;
+    indices[3] = 0;  indices[4] = 2;  indices[5] = 3;
+
+    VertexFormat iformat;
+    iformat.Bind(VA_TEXCOORD, DF_R32G32B32A32_FLOAT, 5);
+    iformat.Bind(VA_TEXCOORD, DF_R32G32B32A32_FLOAT, 6);
+    mInstanceBuffer = std::make_shared<VertexBuffer>(iformat, maxParticles);
+    mInstanceBuffer->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mInstanceBuffer->GetData(), 0, mInstanceBuffer->GetNumBytes());
+
+    mEmitter = std::make_shared<ConstantBuffer>(sizeof(Emitter), true);
+    Emitter& emitter = GetEmitter();
+    emitter.emitterPosition = { 0.0f, 0.0f, 0.0f, 0.0f };
+    emitter.emitterVelocity = { 0.0f, 0.0f, 0.0f, 1.0f };
+    emitter.acceleration = { 0.0f, 0.0f, 0.0f, 0.0f };
+    emitter.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+    emitter.colorChange = { 0.0f, 0.0f, 0.0f, 0.0f };
+    emitter.size = 1.0f;
+    emitter.sizeChange = 0.0f;
+    emitter.lifetime = 1.0f;
+    emitter.lifetimeSpread = 0.0f;
+
+    mFrameConstant = std::make_shared<ConstantBuffer>(sizeof(Frame), true);
+    mBillboard = std::make_shared<ConstantBuffer>(sizeof(Billboard), true);
+    std::memset(mBillboard->GetData(), 0, mBillboard->GetNumBytes());
+
+    // The particles are dead (zero lifetime) and all their indices are in
+    // the dead list.
+    mParticles = std::make_shared<StructuredBuffer>(maxParticles, sizeof(Particle));
+    mParticles->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mParticles->GetData(), 0, mParticles->GetNumBytes());
+
+    mDead = std::make_shared<StructuredBuffer>(maxParticles, sizeof(uint32_t));
+    mDead->MakeAppendConsume();
+    auto dead = mDead->Get<uint32_t>();
+    for (unsigned int i = 0; i < maxParticles; ++i)
+    {
+        dead[i] = i;
+    }
+
+    mCounts = std::make_shared<StructuredBuffer>(NUM_COUNTS, sizeof(uint32_t));
+    mCounts->SetUsage(Resource::SHADER_OUTPUT);
+    auto counts = mCounts->Get<uint32_t>();
+    std::memset(counts, 0, mCounts->GetNumBytes());
+    counts[0] = 6;
+    counts[NUM_DEAD] = maxParticles;
+    mArguments = std::make_shared<IndirectArgumentsBuffer>(NUM_COUNTS);
+    std::memcpy(mArguments->GetData(), counts, mCounts->GetNumBytes());
+
+    mVisible = std::make_shared<StructuredBuffer>(maxParticles, sizeof(Instance));
+    mVisible->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mVisible->GetData(), 0, mVisible->GetNumBytes());
+
+    int api = factory->GetAPI();
+    mEmit = factory->CreateFromSource(*msEmitSource[api]);
+    if (mEmit)
+    {
+        auto cshader = mEmit->GetComputeShader();
+        cshader->Set("Emitter", mEmitter);
+        cshader->Set("Frame", mFrameConstant);
+        cshader->Set("particles", mParticles);
+        cshader->Set("deadList", mDead);
+        cshader->Set("counts", mCounts);
+    }
+
+    mSimulate = factory->CreateFromSource(*msSimulateSource[api]);
+    if (mSimulate)
+    {
+        auto cshader = mSimulate->GetComputeShader();
+        cshader->Set("Emitter", mEmitter);
+        cshader->Set("Frame", mFrameConstant);
+        cshader->Set("particles", mParticles);
+        cshader->Set("deadList", mDead);
+        cshader->Set("counts", mCounts);
+        cshader->Set("visible", mVisible);
+    }
+
+    auto program = factory->CreateFromSources(*msVSSource[api], *msPSSource[api], "");
+    if (program)
+    {
+        mEffect = std::make_shared<VisualEffect>(program);
+        program->GetVertexShader()->Set("PVWMatrix", mEffect->GetPVWMatrixConstant());
+        program->GetVertexShader()->Set("Billboard", mBillboard);
+    }
+    else
+    {
+        LogError("Failed to compile shader programs.");
+    }
+
+    culling = CULL_NEVER;
+}
+
+void GPUParticles::SetSizeAdjust(float sizeAdjust)
+{
+    LogAssert(sizeAdjust > 0.0f, "Invalid size-adjust parameter.");
+    mSizeAdjust = sizeAdjust;
+}
+
+void GPUParticles::Update(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Camera> const& camera, float deltaTime, unsigned int numEmit)
+{
+    LogAssert(engine != nullptr && camera != nullptr, "Invalid input.");
+
+    // Get the camera axis directions in the model space of the particles.
+    Matrix4x4<float> inverse = worldTransform.GetHInverse();
+    auto billboard = mBillboard->Get<Billboard>();
+    billboard->upPlusRight = mSizeAdjust * DoTransform(inverse,
+        camera->GetUVector() + camera->GetRVector());
+    billboard->upMinusRight = mSizeAdjust * DoTransform(inverse,
+        camera->GetUVector() - camera->GetRVector());
+    engine->Update(mBillboard);
+
+    // The seed varies per frame so that the emitted particles differ.
+    auto frame = mFrameConstant->Get<Frame>();
+    frame->deltaTime = deltaTime;
+    frame->numEmit = std::min(numEmit, mMaxParticles);
+    frame->seed = ++mFrame;
+    frame->maxParticles = mMaxParticles;
+    engine->Update(mFrameConstant);
+    engine->Update(mEmitter);
+
+    // The emission pass also resets the instance count, so it is executed
+    // even when no particles are emitted. The first pass sets the counter
+    // of the dead list to the initial number of dead particles, and the
+    // later passes keep the counter of the GPU.
+    engine->Execute(mEmit, std::max((frame->numEmit + 63) / 64, 1u), 1, 1);
+    mDead->SetKeepInternalCount(true);
+
+    engine->Execute(mSimulate, (mMaxParticles + 255) / 256, 1, 1);
+    engine->CopyGpuToGpu(mVisible, mInstanceBuffer);
+    engine->CopyGpuToGpu(mCounts, mArguments);
+}
+
+bool GPUParticles::UpdateModelBound()
+{
+    return false;
+}
+
+
+std::string const GPUParticles::msGLSLEmitSource =
+R"(
+    uniform Emitter
+    {
+        vec4 emitterPosition;   // (center, radius)
+        vec4 emitterVelocity;   // (velocity, random length)
+        vec4 acceleration;
+        vec4 color;
+        vec4 colorChange;
+        float size;
+        float sizeChange;
+        float lifetime;
+        float lifetimeSpread;
+    };
+
+    uniform Frame
+    {
+        float deltaTime;
+        uint numEmit;
+        uint seed;
+        uint maxParticles;
+    };
+
+    struct Particle
+    {
+        vec4 positionSize;
+        vec4 velocityLife;
+        vec4 color;
+    };
+
+    buffer particles { Particle data[]; } particlesSB;
+    buffer counts { uint data[]; } countsSB;
+
+    // HLSL equivalent:
+    // ConsumeStructuredBuffer<uint> deadList;
+    buffer deadList { uint data[]; } deadListAC;
+    layout(binding = 0, offset = 0) uniform atomic_uint deadListCounter;
+
+    uint deadListConsume()
+    {
+        uint index = atomicCounterDecrement(deadListCounter);
+        return deadListAC.data[index];
+    }
+
+    uint Hash(uint x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // A random number in [0,1).
+    float Random(inout uint state)
+    {
+        state = Hash(state);
+        return float(state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // A random unit-length vector.
+    vec3 RandomDirection(inout uint state)
+    {
+        float z = 2.0f * Random(state) - 1.0f;
+        float angle = 6.28318531f * Random(state);
+        float r = sqrt(max(1.0f - z * z, 0.0f));
+        return vec3(r * cos(angle), r * sin(angle), z);
+    }
+
+    layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        uint t = gl_GlobalInvocationID.x;
+        if (t == 0u)
+        {
+            countsSB.data[1] = 0u;
+        }
+
+        if (t < numEmit)
+        {
+            // Reserve a dead particle before consuming it. The reservation
+            // fails when the dead list is empty.
+            uint numDead = atomicAdd(countsSB.data[5], 0xFFFFFFFFu);
+            if (int(numDead) <= 0)
+            {
+                atomicAdd(countsSB.data[5], 1u);
+                return;
+            }
+
+            uint i = deadListConsume();
+            uint state = Hash(seed ^ Hash(t));
+            Particle p;
+            vec3 offset = RandomDirection(state) * (emitterPosition.w * pow(Random(state), 1.0f / 3.0f));
+            p.positionSize = vec4(emitterPosition.xyz + offset, size);
+            vec3 velocity = emitterVelocity.xyz + emitterVelocity.w * RandomDirection(state);
+            float life = lifetime + lifetimeSpread * (2.0f * Random(state) - 1.0f);
+            p.velocityLife = vec4(velocity, max(life, 1e-6f));
+            p.color = color;
+            particlesSB.data[i] = p;
+        }
+    }
+)";
+
+std::string const GPUParticles::msGLSLSimulateSource =
+R"(
+    uniform Emitter
+    {
+        vec4 emitterPosition;
+        vec4 emitterVelocity;
+        vec4 acceleration;
+        vec4 color;
+        vec4 colorChange;
+        float size;
+        float sizeChange;
+        float lifetime;
+        float lifetimeSpread;
+    };
+
+    uniform Frame
+    {
+        float deltaTime;
+        uint numEmit;
+        uint seed;
+        uint maxParticles;
+    };
+
+    struct Particle
+    {
+        vec4 positionSize;
+        vec4 velocityLife;
+        vec4 color;
+    };
+
+    struct Instance
+    {
+        vec4 positionSize;
+        vec4 color;
+    };
+
+    buffer particles { Particle data[]; } particlesSB;
+    buffer counts { uint data[]; } countsSB;
+    buffer visible { Instance data[]; } visibleSB;
+
+    // HLSL equivalent:
+    // AppendStructuredBuffer<uint> deadList;
+    buffer deadList { uint data[]; } deadListAC;
+    layout(binding = 0, offset = 0) uniform atomic_uint deadListCounter;
+
+    void deadListAppend(uint i)
+    {
+        uint index = atomicCounterIncrement(deadListCounter);
+        deadListAC.data[index] = i;
+    }
+
+    layout (local_size_x = 256, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        uint i = gl_GlobalInvocationID.x;
+        if (i >= maxParticles)
+        {
+            return;
+        }
+
+        Particle p = particlesSB.data[i];
+        if (p.velocityLife.w <= 0.0f)
+        {
+            return;
+        }
+
+        p.velocityLife.w -= deltaTime;
+        if (p.velocityLife.w <= 0.0f)
+        {
+            particlesSB.data[i].velocityLife.w = 0.0f;
+            deadListAppend(i);
+            atomicAdd(countsSB.data[5], 1u);
+            return;
+        }
+
+        p.velocityLife.xyz += deltaTime * acceleration.xyz;
+        p.positionSize.xyz += deltaTime * p.velocityLife.xyz;
+        p.positionSize.w = max(p.positionSize.w + deltaTime * sizeChange, 0.0f);
+        p.color = clamp(p.color + deltaTime * colorChange, 0.0f, 1.0f);
+        particlesSB.data[i] = p;
+
+        uint k = atomicAdd(countsSB.data[1], 1u);
+        visibleSB.data[k].positionSize = p.positionSize;
+        visibleSB.data[k].color = p.color;
+    }
+)";
+
+std::string const GPUParticles::msGLSLVSSource =
+R"(
+    uniform PVWMatrix
+    {
+        mat4 pvwMatrix;
+    };
+
+    uniform Billboard
+    {
+        vec4 upPlusRight;
+        vec4 upMinusRight;
+    };
+
+    layout(location = 0) in vec2 modelCorner;
+    layout(location = 1) in vec2 modelTCoord;
+    layout(location = 2) in vec4 instancePositionSize;
+    layout(location = 3) in vec4 instanceColor;
+    layout(location = 0) out vec2 vertexTCoord;
+    layout(location = 1) out vec4 vertexColor;
+
+    void main()
+    {
+        vec3 offset = modelCorner.x * upPlusRight.xyz + modelCorner.y * upMinusRight.xyz;
+        vec3 position = instancePositionSize.xyz + instancePositionSize.w * offset;
+
+        vertexTCoord = modelTCoord;
+        vertexColor = instanceColor;
+    #if GTE_USE_MAT_VEC
+        gl_Position = pvwMatrix * vec4(position, 1.0f);
+    #else
+        gl_Position = vec4(position, 1.0f) * pvwMatrix;
+    #endif
+    }
+)";
+
+std::string const GPUParticles::msGLSLPSSource =
+R"(
+    layout(location = 0) in vec2 vertexTCoord;
+    layout(location = 1) in vec4 vertexColor;
+    layout(location = 0) out vec4 pixelColor;
+
+    void main()
+    {
+        vec2 d = 2.0f * vertexTCoord - 1.0f;
+        float falloff = clamp(1.0f - dot(d, d), 0.0f, 1.0f);
+        pixelColor = vec4(vertexColor.rgb, vertexColor.a * falloff);
+    }
+)";
+
+std::string const GPUParticles::msHLSLEmitSource =
+R"(
+    cbuffer Emitter
+    {
+        float4 emitterPosition; // (center, radius)
+        float4 emitterVelocity; // (velocity, random length)
+        float4 acceleration;
+        float4 color;
+        float4 colorChange;
+        float size;
+        float sizeChange;
+        float lifetime;
+        float lifetimeSpread;
+    };
+
+    cbuffer Frame
+    {
+        float deltaTime;
+        uint numEmit;
+        uint seed;
+        uint maxParticles;
+    };
+
+    struct Particle
+    {
+        float4 positionSize;
+        float4 velocityLife;
+        float4 color;
+    };
+
+    RWStructuredBuffer<Particle> particles;
+    RWStructuredBuffer<uint> counts;
+    ConsumeStructuredBuffer<uint> deadList;
+
+    uint Hash(uint x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // A random number in [0,1).
+    float Random(inout uint state)
+    {
+        state = Hash(state);
+        return float(state >> 8) * (1.0f / 16777216.0f);
+    }
+
+    // A random unit-length vector.
+    float3 RandomDirection(inout uint state)
+    {
+        float z = 2.0f * Random(state) - 1.0f;
+        float angle = 6.28318531f * Random(state);
+        float r = sqrt(max(1.0f - z * z, 0.0f));
+        return float3(r * cos(angle), r * sin(angle), z);
+    }
+
+    [numthreads(64, 1, 1)]
+    void CSMain(uint3 id : SV_DispatchThreadID)
+    {
+        uint t = id.x;
+        if (t == 0)
+        {
+            counts[1] = 0;
+        }
+
+        if (t < numEmit)
+        {
+            // Reserve a dead particle before consuming it. The reservation
+            // fails when the dead list is empty.
+            uint numDead;
+            InterlockedAdd(counts[5], 0xFFFFFFFFu, numDead);
+            if (int(numDead) <= 0)
+            {
+                InterlockedAdd(counts[5], 1);
+                return;
+            }
+
+            uint i = deadList.Consume();
+            uint state = Hash(seed ^ Hash(t));
+            Particle p;
+            float3 offset = RandomDirection(state) * (emitterPosition.w * pow(Random(state), 1.0f / 3.0f));
+            p.positionSize = float4(emitterPosition.xyz + offset, size);
+            float3 velocity = emitterVelocity.xyz + emitterVelocity.w * RandomDirection(state);
+            float life = lifetime + lifetimeSpread * (2.0f * Random(state) - 1.0f);
+            p.velocityLife = float4(velocity, max(life, 1e-6f));
+            p.color = color;
+            particles[i] = p;
+        }
+    }
+)";
+
+std::string const GPUParticles::msHLSLSimulateSource =
+R"(
+    cbuffer Emitter
+    {
+        float4 emitterPosition;
+        float4 emitterVelocity;
+        float4 acceleration;
+        float4 color;
+        float4 colorChange;
+        float size;
+        float sizeChange;
+        float lifetime;
+        float lifetimeSpread;
+    };
+
+    cbuffer Frame
+    {
+        float deltaTime;
+        uint numEmit;
+        uint seed;
+        uint maxParticles;
+    };
+
+    struct Particle
+    {
+        float4 positionSize;
+        float4 velocityLife;
+        float4 color;
+    };
+
+    struct Instance
+    {
+        float4 positionSize;
+        float4 color;
+    };
+
+    RWStructuredBuffer<Particle> particles;
+    RWStructuredBuffer<uint> counts;
+    RWStructuredBuffer<Instance> visible;
+    AppendStructuredBuffer<uint> deadList;
+
+    [numthreads(256, 1, 1)]
+    void CSMain(uint3 id : SV_DispatchThreadID)
+    {
+        uint i = id.x;
+        if (i >= maxParticles)
+        {
+            return;
+        }
+
+        Particle p = particles[i];
+        if (p.velocityLife.w <= 0.0f)
+        {
+            return;
+        }
+
+        p.velocityLife.w -= deltaTime;
+        if (p.velocityLife.w <= 0.0f)
+        {
+            particles[i].velocityLife.w = 0.0f;
+            deadList.Append(i);
+            InterlockedAdd(counts[5], 1);
+            return;
+        }
+
+        p.velocityLife.xyz += deltaTime * acceleration.xyz;
+        p.positionSize.xyz += deltaTime * p.velocityLife.xyz;
+        p.positionSize.w = max(p.positionSize.w + deltaTime * sizeChange, 0.0f);
+        p.color = saturate(p.color + deltaTime * colorChange);
+        particles[i] = p;
+
+        uint k;
+        InterlockedAdd(counts[1], 1, k);
+        Instance instance;
+        instance.positionSize = p.positionSize;
+        instance.color = p.color;
+        visible[k] = instance;
+    }
+)";
+
+std::string const GPUParticles::msHLSLVSSource =
+R"(
+    cbuffer PVWMatrix
+    {
+        float4x4 pvwMatrix;
+    };
+
+    cbuffer Billboard
+    {
+        float4 upPlusRight;
+        float4 upMinusRight;
+    };
+
+    struct VS_INPUT
+    {
+        float2 modelCorner : POSITION;
+        float2 modelTCoord : TEXCOORD0;
+        float4 instancePositionSize : TEXCOORD5;
+        float4 instanceColor : TEXCOORD6;
+    };
+
+    struct VS_OUTPUT
+    {
+        float2 vertexTCoord : TEXCOORD0;
+        float4 vertexColor : COLOR0;
+        float4 clipPosition : SV_POSITION;
+    };
+
+    VS_OUTPUT VSMain(VS_INPUT input)
+    {
+        float3 offset = input.modelCorner.x * upPlusRight.xyz + input.modelCorner.y * upMinusRight.xyz;
+        float3 position = input.instancePositionSize.xyz + input.instancePositionSize.w * offset;
+
+        VS_OUTPUT output;
+    #if GTE_USE_MAT_VEC
+        output.clipPosition = mul(pvwMatrix, float4(position, 1.0f));
+    #else
+        output.clipPosition = mul(float4(position, 1.0f), pvwMatrix);
+    #endif
+        output.vertexTCoord = input.modelTCoord;
+        output.vertexColor = input.instanceColor;
+        return output;
+    }
+)";
+
+std::string const GPUParticles::msHLSLPSSource =
+R"(
+    struct PS_INPUT
+    {
+        float2 vertexTCoord : TEXCOORD0;
+        float4 vertexColor : COLOR0;
+    };
+
+    struct PS_OUTPUT
+    {
+        float4 pixelColor : SV_TARGET0;
+    };
+
+    PS_OUTPUT PSMain(PS_INPUT input)
+    {
+        float2 d = 2.0f * input.vertexTCoord - 1.0f;
+        float falloff = saturate(1.0f - dot(d, d));
+
+        PS_OUTPUT output;
+        output.pixelColor = float4(input.vertexColor.rgb, input.vertexColor.a * falloff);
+        return output;
+    }
+)";
+
+ProgramSources const GPUParticles::msEmitSource =
+{
+    &msGLSLEmitSource,
+    &msHLSLEmitSource
+};
+
+ProgramSources const GPUParticles::msSimulateSource =
+{
+    &msGLSLSimulateSource,
+    &msHLSLSimulateSource
+};
+
+ProgramSources const GPUParticles::msVSSource =
+{
+    &msGLSLVSSource,
+    &msHLSLVSSource
+};
+
+ProgramSources const GPUParticles::msPSSource =
+{
+    &msGLSLPSSource,
+    &msHLSLPSSource
+};
@@ -0,0 +1,186 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/Camera.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/IndirectArgumentsBuffer.h>
+#include <Graphics/InstancedVisual.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/StructuredBuffer.h>
+
+// A particle system that is simulated and drawn entirely on the GPU, for
+// numbers of particles (a million or more) for which the CPU expansion of
+// Particles and the vertex buffer upload of ParticleController are too
+// expensive. The particle states are stored in a structured buffer and the
+// indices of the dead particles in an append-consume buffer. Each frame, a
+// compute shader consumes dead indices to emit new particles from the
+// emitter, and a second compute shader integrates the live particles,
+// appends the indices of the particles whose lifetimes expire to the dead
+// list and writes the (position,size) and color of the others to a compact
+// buffer, counting them in the indirect arguments of the draw. The compact
+// buffer is copied to the instance buffer of this visual, and the particles
+// are drawn as instances of one quadrilateral whose corners are expanded
+// into camera-facing billboards by the vertex shader, the same billboards
+// that Particles::GenerateParticles computes on the CPU.
+//
+// The positions are in the model space of this visual and are not known on
+// the CPU, so the culling mode is CULL_NEVER and UpdateModelBound does not
+// compute a bound. The effect has a PVW matrix constant that is updated
+// like that of any visual (for example, by a PVWUpdater subscription). The
+// pixel shader outputs the particle color with an alpha that falls off
+// from the billboard center, so the application typically enables alpha or
+// additive blending while drawing the particles.
+
+namespace gte
+{
+    class GPUParticles : public InstancedVisual
+    {
+    public:
+        // The emission and motion parameters, the layout of the constant
+        // buffer "Emitter". A particle is emitted at a random point of the
+        // ball with center emitterPosition and radius emitterPosition[3],
+        // with velocity emitterVelocity plus a random vector of length
+        // emitterVelocity[3], with the size 'size' and the color 'color'.
+        // Its lifetime is lifetime plus a random number in
+        // [-lifetimeSpread,lifetimeSpread]. The velocity, size and color
+        // change by acceleration, sizeChange and colorChange per unit of
+        // time; the color is clamped to [0,1].
+        struct Emitter
+        {
+            Vector4<float> emitterPosition;
+            Vector4<float> emitterVelocity;
+            Vector4<float> acceleration;
+            Vector4<float> color;
+            Vector4<float> colorChange;
+            float size, sizeChange, lifetime, lifetimeSpread;
+        };
+
+        // Construction. All particles are initially dead. The billboard
+        // size of a particle is sizeAdjust times its size.
+        virtual ~GPUParticles() = default;
+        GPUParticles(std::shared_ptr<ProgramFactory> const& factory,
+            unsigned int maxParticles, float sizeAdjust);
+
+        // Member access.
+        inline unsigned int GetMaxParticles() const
+        {
+            return mMaxParticles;
+        }
+
+        // The emitter parameters are copied to the GPU by Update.
+        inline Emitter& GetEmitter()
+        {
+            return *mEmitter->Get<Emitter>();
+        }
+
+        inline Emitter const& GetEmitter() const
+        {
+            return *mEmitter->Get<Emitter>();
+        }
+
+        void SetSizeAdjust(float sizeAdjust);
+
+        inline float GetSizeAdjust() const
+        {
+            return mSizeAdjust;
+        }
+
+        // The indirect arguments of the draw. The instanceCount (element 1)
+        // is the number of live particles after the last Update. The live
+        // particles are drawn by
+        //   engine->DrawIndirect(particles, particles->GetArguments(), 0, 1);
+        inline std::shared_ptr<IndirectArgumentsBuffer> const& GetArguments() const
+        {
+            return mArguments;
+        }
+
+        // Emit up to numEmit particles (fewer when not enough particles are
+        // dead) and advance the simulation by deltaTime. The camera is used
+        // to orient the billboards.
+        void Update(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Camera> const& camera, float deltaTime, unsigned int numEmit);
+
+        // The particle positions are on the GPU, so the function does not
+        // modify the model bound and returns 'false'.
+        virtual bool UpdateModelBound() override;
+
+    private:
+        // The layout of the elements of mParticles.
+        struct Particle
+        {
+            Vector4<float> positionSize;
+            Vector4<float> velocityLife;
+            Vector4<float> color;
+        };
+
+        // The layout of the elements of mVisible and of the instances.
+        struct Instance
+        {
+            Vector4<float> positionSize;
+            Vector4<float> color;
+        };
+
+        // The layout of the constant buffer "Frame".
+        struct Frame
+        {
+            float deltaTime;
+            uint32_t numEmit, seed, maxParticles;
+        };
+
+        // The layout of the constant buffer "Billboard". The vectors are
+        // the sums and differences of the camera up and right vectors in
+        // the model space of the visual, scaled by the size adjustment.
+        struct Billboard
+        {
+            Vector4<float> upPlusRight;
+            Vector4<float> upMinusRight;
+        };
+
+        // The elements of mCounts are the indexed-draw arguments (indices
+        // 0 through 4), the number of dead particles and padding. The
+        // number of dead particles mirrors the counter of mDead so that the
+        // emission does not consume from an empty buffer.
+        enum
+        {
+            NUM_COUNTS = 8,
+            INSTANCE_COUNT = 1,
+            NUM_DEAD = 5
+        };
+
+        unsigned int mMaxParticles;
+        float mSizeAdjust;
+        uint32_t mFrame;
+        std::shared_ptr<ConstantBuffer> mEmitter;
+        std::shared_ptr<ConstantBuffer> mFrameConstant;
+        std::shared_ptr<ConstantBuffer> mBillboard;
+        std::shared_ptr<StructuredBuffer> mParticles;
+        std::shared_ptr<StructuredBuffer> mDead;
+        std::shared_ptr<StructuredBuffer> mCounts;
+        std::shared_ptr<StructuredBuffer> mVisible;
+        std::shared_ptr<IndirectArgumentsBuffer> mArguments;
+
+        std::shared_ptr<ComputeProgram> mEmit;
+        std::shared_ptr<ComputeProgram> mSimulate;
+
+        // Shader source code as strings.
+        static std::string const msGLSLEmitSource;
+        static std::string const msGLSLSimulateSource;
+        static std::string const msGLSLVSSource;
+        static std::string const msGLSLPSSource;
+        static std::string const msHLSLEmitSource;
+        static std::string const msHLSLSimulateSource;
+        static std::string const msHLSLVSSource;
+        static std::string const msHLSLPSSource;
+        static ProgramSources const msEmitSource;
+        static ProgramSources const msSimulateSource;
+        static ProgramSources const msVSSource;
+        static ProgramSources const msPSSource;
+    };
+}
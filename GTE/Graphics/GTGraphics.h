@@ -3,12 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 // Base
 #include <Graphics/BaseEngine.h>
+#include <Graphics/FrameProfiler.h>
 #include <Graphics/GEDrawTarget.h>
 #include <Graphics/GEInputLayoutManager.h>
 #include <Graphics/GEObject.h>
@@ -20,6 +21,8 @@
 #include <Graphics/AmbientLightEffect.h>
 #include <Graphics/AreaLightEffect.h>
 #include <Graphics/BumpMapEffect.h>
+#include <Graphics/ClusteredLightEffect.h>
+#include <Graphics/ClusteredLighting.h>
 #include <Graphics/ConstantColorEffect.h>
 #include <Graphics/CubeMapEffect.h>
 #include <Graphics/DirectionalLightEffect.h>
@@ -45,6 +48,7 @@
 #include <Graphics/ProjectedTextureEffect.h>
 #include <Graphics/SphereMapEffect.h>
 #include <Graphics/SpotLightEffect.h>
+#include <Graphics/TextBatch.h>
 #include <Graphics/TextEffect.h>
 #include <Graphics/Texture2Effect.h>
 #include <Graphics/Texture3Effect.h>
@@ -81,14 +85,21 @@
 #include <Graphics/TextureCube.h>
 #include <Graphics/TextureCubeArray.h>
 #include <Graphics/TextureDS.h>
+#include <Graphics/TextureFileIO.h>
 #include <Graphics/TextureRT.h>
 #include <Graphics/TextureSingle.h>
+#include <Graphics/TextureStream.h>
+#include <Graphics/MipmapStreamer.h>
 
 // SceneGraph
 #include <Graphics/MeshFactory.h>
+#include <Graphics/MeshFileIO.h>
 
 // SceneGraph/Controllers
+#include <Graphics/AnimationClip.h>
+#include <Graphics/AnimationEvaluator.h>
 #include <Graphics/BlendTransformController.h>
+#include <Graphics/ClipController.h>
 #include <Graphics/Controller.h>
 #include <Graphics/ControlledObject.h>
 #include <Graphics/IKController.h>
@@ -105,10 +116,13 @@
 // SceneGraph/Hierarchy
 #include <Graphics/BoundingSphere.h>
 #include <Graphics/Camera.h>
+#include <Graphics/GPUParticles.h>
+#include <Graphics/InstancedVisual.h>
 #include <Graphics/Light.h>
 #include <Graphics/Node.h>
 #include <Graphics/Particles.h>
 #include <Graphics/PVWUpdater.h>
+#include <Graphics/SceneUpdater.h>
 #include <Graphics/Spatial.h>
 #include <Graphics/ViewVolume.h>
 #include <Graphics/ViewVolumeNode.h>
@@ -120,13 +134,18 @@
 
 // SceneGraph/Sorting
 #include <Graphics/BspNode.h>
+#include <Graphics/BspVisibility.h>
 
 // SceneGraph/Terrain
+#include <Graphics/StreamingTerrain.h>
 #include <Graphics/Terrain.h>
 
 // SceneGraph/Visibility
 #include <Graphics/CullingPlane.h>
 #include <Graphics/Culler.h>
+#include <Graphics/HiZBuffer.h>
+#include <Graphics/InstanceCuller.h>
+#include <Graphics/OcclusionCuller.h>
 
 // Shaders
 #include <Graphics/ComputeProgram.h>
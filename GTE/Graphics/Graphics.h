@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -22,6 +22,7 @@
 #endif
 
 #if defined(GTE_USE_LINUX)
+#include <Graphics/GL45/GLX/EGLEngine.h>
 #include <Graphics/GL45/GLX/GLXEngine.h>
 #include <Graphics/GL45/GLSLProgramFactory.h>
 #endif
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/GraphicsEngine.h>
 #include <Mathematics/Logger.h>
+#include <algorithm>
 using namespace gte;
 
 GraphicsEngine::GraphicsEngine()
@@ -15,7 +16,11 @@ GraphicsEngine::GraphicsEngine()
     mCreateGEDrawTarget(nullptr),
     mGEObjectCreator(nullptr),
     mAllowOcclusionQuery(false),
-    mWarnOnNonemptyBridges(true)
+    mWarnOnNonemptyBridges(true),
+    mSortDraws(false),
+    mFrame(0),
+    mMemoryBudget(0),
+    mResidentBytes(0)
 {
     mCreateGEObject.fill(nullptr);
 
@@ -63,6 +68,11 @@ uint64_t GraphicsEngine::Draw(Visual* visual)
     auto const& effect = visual->GetEffect();
     if (vbuffer && ibuffer && effect)
     {
+        InstancedVisual* instanced = dynamic_cast<InstancedVisual*>(visual);
+        if (instanced && instanced->GetInstanceBuffer())
+        {
+            return DrawInstancedPrimitive(vbuffer, instanced->GetInstanceBuffer(), ibuffer, effect);
+        }
         return DrawPrimitive(vbuffer, ibuffer, effect);
     }
     return 0;
@@ -70,11 +80,20 @@ uint64_t GraphicsEngine::Draw(Visual* visual)
 
 uint64_t GraphicsEngine::Draw(std::vector<Visual*> const& visuals)
 {
+    std::vector<Visual*> const* queue = &visuals;
+    if (mSortDraws)
+    {
+        SortVisuals(visuals);
+        queue = &mDrawQueue;
+    }
+
     uint64_t numPixelsDrawn = 0;
-    for (auto const& visual : visuals)
+    BeginDrawBatch();
+    for (auto const& visual : *queue)
     {
         numPixelsDrawn += Draw(visual);
     }
+    EndDrawBatch();
     return numPixelsDrawn;
 }
 
@@ -85,12 +104,12 @@ uint64_t GraphicsEngine::Draw(std::shared_ptr<Visual> const& visual)
 
 uint64_t GraphicsEngine::Draw(std::vector<std::shared_ptr<Visual>> const& visuals)
 {
-    uint64_t numPixelsDrawn = 0;
-    for (auto const& visual : visuals)
+    mDrawInput.resize(visuals.size());
+    for (size_t i = 0; i < visuals.size(); ++i)
     {
-        numPixelsDrawn += Draw(visual);
+        mDrawInput[i] = visuals[i].get();
     }
-    return numPixelsDrawn;
+    return Draw(mDrawInput);
 }
 
 uint64_t GraphicsEngine::Draw(int x, int y, std::array<float, 4> const& color, std::string const& message)
@@ -131,6 +150,31 @@ uint64_t GraphicsEngine::Draw(int x, int y, std::array<float, 4> const& color, s
     return numPixelsDrawn;
 }
 
+uint64_t GraphicsEngine::Draw(std::shared_ptr<TextBatch> const& batch)
+{
+    LogAssert(batch != nullptr, "Input batch is null.");
+    uint64_t numPixelsDrawn = 0;
+    if (batch->GetNumCharacters() > 0 && batch->GetEffect())
+    {
+        Update(batch->GetVertexBuffer());
+
+        std::shared_ptr<BlendState> bState = GetBlendState();
+        std::shared_ptr<DepthStencilState> dState = GetDepthStencilState();
+        std::shared_ptr<RasterizerState> rState = GetRasterizerState();
+        SetDefaultBlendState();
+        SetDefaultDepthStencilState();
+        SetDefaultRasterizerState();
+
+        numPixelsDrawn = DrawPrimitive(batch->GetVertexBuffer(),
+            batch->GetIndexBuffer(), batch->GetEffect());
+
+        SetBlendState(bState);
+        SetDepthStencilState(dState);
+        SetRasterizerState(rState);
+    }
+    return numPixelsDrawn;
+}
+
 uint64_t GraphicsEngine::Draw(std::shared_ptr<OverlayEffect> const& overlay)
 {
     LogAssert(overlay != nullptr, "Input overlay is null.");
@@ -144,11 +188,73 @@ uint64_t GraphicsEngine::Draw(std::shared_ptr<OverlayEffect> const& overlay)
     return 0;
 }
 
+void GraphicsEngine::BeginDrawBatch()
+{
+}
+
+void GraphicsEngine::EndDrawBatch()
+{
+}
+
+void GraphicsEngine::OnUnbind(GEObject*)
+{
+}
+
+void GraphicsEngine::SortVisuals(std::vector<Visual*> const& visuals)
+{
+    // Map a pointer to its index in the order of first occurrence.
+    auto GetIndex = [](std::unordered_map<void const*, uint64_t>& indices, void const* object)
+    {
+        auto result = indices.insert(std::make_pair(object, static_cast<uint64_t>(indices.size())));
+        return result.first->second;
+    };
+
+    for (auto& indices : mDrawKeyIndices)
+    {
+        indices.clear();
+    }
+
+    size_t const numVisuals = visuals.size();
+    mDrawKeys.resize(numVisuals);
+    for (size_t i = 0; i < numVisuals; ++i)
+    {
+        LogAssert(visuals[i] != nullptr, "Input visual is null.");
+        auto const& effect = visuals[i]->GetEffect();
+        void const* program = (effect ? effect->GetProgram().get() : nullptr);
+        uint64_t programIndex = GetIndex(mDrawKeyIndices[0], program) & 0xFFFFull;
+        uint64_t effectIndex = GetIndex(mDrawKeyIndices[1], effect.get()) & 0xFFFFFFull;
+        uint64_t vbufferIndex = GetIndex(mDrawKeyIndices[2],
+            visuals[i]->GetVertexBuffer().get()) & 0xFFFFFFull;
+        mDrawKeys[i].first = (programIndex << 48) | (effectIndex << 24) | vbufferIndex;
+        mDrawKeys[i].second = i;
+    }
+
+    // The pairs are distinct, so sorting them preserves the order of
+    // visuals with equal keys.
+    std::sort(mDrawKeys.begin(), mDrawKeys.end());
+
+    mDrawQueue.resize(numVisuals);
+    for (size_t i = 0; i < numVisuals; ++i)
+    {
+        mDrawQueue[i] = visuals[mDrawKeys[i].second];
+    }
+}
+
 GEObject* GraphicsEngine::Bind(std::shared_ptr<GraphicsObject> const& object)
 {
     LogAssert(object != nullptr, "Attempt to bind a null object.");
 
+    // The draws bind every resource they use, so the object cached by the
+    // front-end object is tried before the bridge map, whose lookups lock
+    // its mutex.
     GraphicsObject const* gtObject = object.get();
+    GEObject* cached = gtObject->GetGEObject();
+    if (cached && cached->GetEngine() == this)
+    {
+        cached->SetLastUse(mFrame);
+        return cached;
+    }
+
     std::shared_ptr<GEObject> geObject;
     if (!mGOMap.Get(gtObject, geObject))
     {
@@ -165,11 +271,32 @@ GEObject* GraphicsEngine::Bind(std::shared_ptr<GraphicsObject> const& object)
 
         geObject = create(mGEObjectCreator, gtObject);
         LogAssert(geObject != nullptr, "Unexpected condition.");
+        ++mStatistics.numResourcesCreated;
+
+        bool const isResource = (object->IsBuffer() || object->IsTexture() || object->IsTextureArray());
+        if (isResource)
+        {
+            uint64_t numBytes = static_cast<Resource const*>(gtObject)->GetNumBytes();
+            geObject->SetResidentBytes(numBytes);
+            mResidentBytes += numBytes;
+        }
+        geObject->SetLastUse(mFrame);
+        geObject->SetEngine(this);
 
         mGOMap.Insert(gtObject, geObject);
+        gtObject->SetGEObject(geObject.get());
 #if defined(GTE_GRAPHICS_USE_NAMED_OBJECTS)
         geObject->SetName(object->GetName());
 #endif
+
+        if (isResource && mMemoryBudget > 0 && mResidentBytes > mMemoryBudget)
+        {
+            EvictResources(mMemoryBudget);
+        }
+    }
+    else
+    {
+        geObject->SetLastUse(mFrame);
     }
     return geObject.get();
 }
@@ -207,6 +334,12 @@ GEDrawTarget* GraphicsEngine::Bind(std::shared_ptr<DrawTarget> const& target)
 GEObject* GraphicsEngine::Get(std::shared_ptr<GraphicsObject> const& object) const
 {
     GraphicsObject const* gtObject = object.get();
+    GEObject* cached = gtObject->GetGEObject();
+    if (cached && cached->GetEngine() == this)
+    {
+        return cached;
+    }
+
     std::shared_ptr<GEObject> geObject;
     if (mGOMap.Get(gtObject, geObject))
     {
@@ -246,6 +379,225 @@ void GraphicsEngine::GetTotalAllocation(size_t& numBytes, size_t& numObjects) co
     }
 }
 
+void GraphicsEngine::EndFrameStatistics()
+{
+    mFrameStatistics = mStatistics;
+    mStatistics = FrameStatistics();
+    ++mFrame;
+}
+
+uint64_t GraphicsEngine::EvictResources(uint64_t maxResidentBytes)
+{
+    if (mResidentBytes <= maxResidentBytes)
+    {
+        return 0;
+    }
+
+    // The candidates are sorted from the least recently used. The gathered
+    // objects keep the candidates alive while they are unbound.
+    std::vector<std::shared_ptr<GEObject>> objects;
+    mGOMap.GatherAll(objects);
+    std::vector<std::pair<uint64_t, GEObject*>> candidates;
+    for (auto const& object : objects)
+    {
+        if (object && object->GetResidentBytes() > 0 && object->GetLastUse() < mFrame)
+        {
+            auto resource = static_cast<Resource const*>(object->GetGraphicsObject());
+            GraphicsObjectType type = resource->GetType();
+            if (type != GT_TEXTURE_RT && type != GT_TEXTURE_DS && resource->GetData()
+                && resource->GetUsage() != Resource::SHADER_OUTPUT)
+            {
+                candidates.push_back(std::make_pair(object->GetLastUse(), object.get()));
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](std::pair<uint64_t, GEObject*> const& item0, std::pair<uint64_t, GEObject*> const& item1)
+        {
+            return item0.first < item1.first;
+        });
+
+    uint64_t numEvicted = 0;
+    for (auto const& candidate : candidates)
+    {
+        if (mResidentBytes <= maxResidentBytes)
+        {
+            break;
+        }
+
+        uint64_t numBytes = candidate.second->GetResidentBytes();
+        if (Unbind(candidate.second->GetGraphicsObject()))
+        {
+            numEvicted += numBytes;
+            ++mStatistics.numResourcesEvicted;
+        }
+    }
+    return numEvicted;
+}
+
+uint64_t GraphicsEngine::GetNumUpdateBytes(Buffer const* buffer)
+{
+    if (buffer->HasDirtyRanges())
+    {
+        uint64_t numBytes = 0;
+        for (auto const& range : buffer->GetDirtyRanges())
+        {
+            numBytes += static_cast<uint64_t>(range.second) - static_cast<uint64_t>(range.first);
+        }
+        return numBytes;
+    }
+    return buffer->GetNumActiveBytes();
+}
+
+void GraphicsEngine::EnqueueUpload(std::shared_ptr<Resource> const& resource,
+    UploadCallback const& callback)
+{
+    LogAssert(resource != nullptr && resource->GetData() != nullptr,
+        "The resource must have CPU data.");
+    LogAssert(resource->GetCopyType() == Resource::COPY_CPU_TO_STAGING
+        || resource->GetCopyType() == Resource::COPY_BIDIRECTIONAL,
+        "The resource must have a staging copy type.");
+    LogAssert(resource->IsBuffer() || resource->IsTexture() || resource->IsTextureArray(),
+        "The resource must be a buffer or a texture.");
+
+    Upload upload;
+    upload.resource = resource;
+    upload.callback = callback;
+    upload.bound = false;
+    upload.next = 0;
+
+    std::lock_guard<std::mutex> lock(mUploadMutex);
+    mEnqueuedUploads.push_back(upload);
+}
+
+size_t GraphicsEngine::ProcessUploads(size_t maxBytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mUploadMutex);
+        mUploads.insert(mUploads.end(), mEnqueuedUploads.begin(), mEnqueuedUploads.end());
+        mEnqueuedUploads.clear();
+    }
+
+    size_t numBytes = 0;
+    while (mUploads.size() > 0 && (numBytes == 0 || numBytes < maxBytes))
+    {
+        Upload& upload = mUploads.front();
+        size_t const remaining = (numBytes < maxBytes ? maxBytes - numBytes : 0);
+        numBytes += UploadStep(upload, remaining);
+
+        bool finished;
+        if (upload.resource->IsBuffer())
+        {
+            finished = (upload.next >= upload.resource->GetNumElements());
+        }
+        else
+        {
+            auto texture = std::static_pointer_cast<Texture>(upload.resource);
+            finished = (upload.next >= texture->GetNumSubresources());
+        }
+
+        if (finished)
+        {
+            // The upload is removed before the callback, which may enqueue
+            // another upload.
+            Upload completed = upload;
+            mUploads.pop_front();
+            if (completed.callback)
+            {
+                completed.callback(completed.resource);
+            }
+        }
+    }
+    return numBytes;
+}
+
+size_t GraphicsEngine::GetNumPendingUploads()
+{
+    std::lock_guard<std::mutex> lock(mUploadMutex);
+    return mEnqueuedUploads.size() + mUploads.size();
+}
+
+size_t GraphicsEngine::UploadStep(Upload& upload, size_t maxBytes)
+{
+    auto const& resource = upload.resource;
+    if (!upload.bound)
+    {
+        // Create the GPU object without copying the CPU data.
+        char* data = resource->GetData();
+        resource->SetData(nullptr);
+        Bind(resource);
+        resource->SetData(data);
+        upload.bound = true;
+    }
+
+    if (resource->IsBuffer())
+    {
+        // Copy the largest range of elements that fits in maxBytes, at
+        // least one element, by temporarily setting the active elements.
+        auto buffer = std::static_pointer_cast<Buffer>(resource);
+        unsigned int const elementSize = buffer->GetElementSize();
+        unsigned int const numRemaining = buffer->GetNumElements() - upload.next;
+        size_t numElements = std::max(maxBytes / elementSize, static_cast<size_t>(1));
+        numElements = std::min(numElements, static_cast<size_t>(numRemaining));
+
+        unsigned int const saveOffset = buffer->GetOffset();
+        unsigned int const saveNumActive = buffer->GetNumActiveElements();
+        buffer->SetOffset(upload.next);
+        buffer->SetNumActiveElements(static_cast<unsigned int>(numElements));
+        CopyCpuToGpu(buffer);
+        buffer->SetOffset(saveOffset);
+        buffer->SetNumActiveElements(saveNumActive);
+
+        upload.next += static_cast<unsigned int>(numElements);
+        return numElements * elementSize;
+    }
+
+    auto texture = std::static_pointer_cast<Texture>(resource);
+    unsigned int const numSubresources = texture->GetNumSubresources();
+    if (texture->WantAutogenerateMipmaps())
+    {
+        // The mipmaps of level 0 are generated by the GPU.
+        size_t numBytes = 0;
+        if (texture->IsTextureArray())
+        {
+            auto textureArray = std::static_pointer_cast<TextureArray>(texture);
+            CopyCpuToGpu(textureArray);
+            numBytes = static_cast<size_t>(texture->GetNumBytesFor(0)) * textureArray->GetNumItems();
+        }
+        else
+        {
+            CopyCpuToGpu(std::static_pointer_cast<TextureSingle>(texture));
+            numBytes = texture->GetNumBytesFor(0);
+        }
+        upload.next = numSubresources;
+        return numBytes;
+    }
+
+    // Copy the subresources that fit in maxBytes, at least one.
+    size_t numBytes = 0;
+    while (upload.next < numSubresources)
+    {
+        auto sr = texture->GetSubresource(upload.next);
+        size_t const srBytes = texture->GetNumBytesFor(sr.level);
+        if (numBytes > 0 && numBytes + srBytes > maxBytes)
+        {
+            break;
+        }
+
+        if (texture->IsTextureArray())
+        {
+            CopyCpuToGpu(std::static_pointer_cast<TextureArray>(texture), sr.item, sr.level);
+        }
+        else
+        {
+            CopyCpuToGpu(std::static_pointer_cast<TextureSingle>(texture), sr.level);
+        }
+        numBytes += srBytes;
+        ++upload.next;
+    }
+    return numBytes;
+}
+
 void GraphicsEngine::DestroyDefaultGlobalState()
 {
     if (mDefaultBlendState)
@@ -281,8 +633,11 @@ bool GraphicsEngine::Unbind(GraphicsObject const* object)
             mILMap->Unbind(static_cast<Shader const*>(object));
         }
 
+        OnUnbind(dxObject.get());
+
         if (mGOMap.Remove(object, dxObject))
         {
+            mResidentBytes -= dxObject->GetResidentBytes();
             return true;
         }
     }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -13,9 +13,17 @@
 #include <Graphics/GEObject.h>
 #include <Graphics/DrawTarget.h>
 #include <Graphics/FontArialW400H18.h>
-#include <Graphics/Visual.h>
+#include <Graphics/IndirectArgumentsBuffer.h>
+#include <Graphics/InstancedVisual.h>
+#include <Graphics/TextBatch.h>
 #include <Mathematics/ThreadSafeMap.h>
 #include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 // TODO: It appears that BaseEngine was separated out from GraphicsEngine
 // in order for the listener system of GraphicsEngine to function properly
@@ -58,9 +66,27 @@ namespace gte
         uint64_t Draw(std::shared_ptr<Visual> const& visual);
         uint64_t Draw(std::vector<std::shared_ptr<Visual>> const& visuals);
 
+        // Draw an instanced visual with the arguments read by the GPU from
+        // 'arguments', numDraws records starting at byte 'offset'. A record
+        // has the layout of DrawIndexedInstancedIndirect when the index
+        // buffer is indexed and of DrawInstancedIndirect otherwise (see
+        // IndirectArgumentsBuffer). The start instance of a record is the
+        // index of its first element in the instance buffer. The records are
+        // drawn by one multidraw call in OpenGL and by one call per record in
+        // DirectX 11, so the CPU cost does not depend on the number of
+        // instances. The arguments can be generated on the GPU, for example
+        // by InstanceCuller.
+        virtual uint64_t DrawIndirect(std::shared_ptr<InstancedVisual> const& visual,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments,
+            unsigned int offset, unsigned int numDraws) = 0;
+
         // Draw 2D text.
         uint64_t Draw(int x, int y, std::array<float, 4> const& color, std::string const& message);
 
+        // Draw the strings of a text batch with one draw call, using the
+        // same states as the 2D text drawing.
+        uint64_t Draw(std::shared_ptr<TextBatch> const& batch);
+
         // Draw a 2D rectangular overlay.  This is useful for adding buttons,
         // controls, thumbnails, and other GUI objects to an application
         // window.
@@ -75,6 +101,161 @@ namespace gte
             mAllowOcclusionQuery = allow;
         }
 
+        // Support for asynchronous occlusion queries, which do not stall the
+        // CPU. A query counts the samples that pass the depth and stencil
+        // tests for the draws between BeginQuery and EndQuery.
+        // GetQueryResult returns 'false' without waiting when the GPU has
+        // not finished the draws of the query, typically until a frame
+        // later; it must not be called for a query that was never ended. A
+        // query is issued again by another BeginQuery/EndQuery pair, after
+        // which GetQueryResult reports the new count. The draws between
+        // BeginConditionalDraw and EndConditionalDraw are discarded by the
+        // GPU when the last issue of the query counted no samples, again
+        // without waiting; when the count is not yet available, the draws
+        // are made. CreateOcclusionQuery returns a nonzero handle.
+        virtual unsigned int CreateOcclusionQuery() = 0;
+        virtual void DestroyOcclusionQuery(unsigned int query) = 0;
+        virtual void BeginQuery(unsigned int query) = 0;
+        virtual void EndQuery(unsigned int query) = 0;
+        virtual bool GetQueryResult(unsigned int query, uint64_t& numSamples) = 0;
+        virtual void BeginConditionalDraw(unsigned int query) = 0;
+        virtual void EndConditionalDraw() = 0;
+
+        // Support for GPU timing with timestamp queries, which do not stall
+        // the CPU. A timestamp set has numTimestamps timestamps that are
+        // written between BeginTimestamps and EndTimestamps; timestamp i is
+        // the GPU time at which the commands submitted before
+        // WriteTimestamp(set, i) have finished. GetTimestamps returns
+        // 'false' without waiting when the GPU has not finished the first
+        // numWritten timestamps, typically until a frame or two later.
+        // Otherwise it stores their times in nanoseconds relative to
+        // timestamp 0 and returns 'true'; the times are empty when they are
+        // unreliable, for example when the GPU clock frequency changed (a
+        // disjoint interval in Direct3D). CreateTimestampSet returns a
+        // nonzero handle.
+        virtual unsigned int CreateTimestampSet(unsigned int numTimestamps) = 0;
+        virtual void DestroyTimestampSet(unsigned int set) = 0;
+        virtual void BeginTimestamps(unsigned int set) = 0;
+        virtual void WriteTimestamp(unsigned int set, unsigned int i) = 0;
+        virtual void EndTimestamps(unsigned int set) = 0;
+        virtual bool GetTimestamps(unsigned int set, unsigned int numWritten,
+            std::vector<uint64_t>& nanoseconds) = 0;
+
+        // Support for render queues.  When enabled, the Draw functions for
+        // arrays of visuals draw them sorted by program, effect and vertex
+        // buffer, so consecutive draws share state.  The order of visuals
+        // with equal keys is preserved.  Sorting changes the drawing order,
+        // so it must not be enabled for visuals that require an order, such
+        // as semitransparent objects drawn back to front.  The default value
+        // is 'false'.  Regardless of the mode, the engines skip redundant
+        // binding of the state shared by consecutive draws of an array.
+        inline void SortDraws(bool sort)
+        {
+            mSortDraws = sort;
+        }
+
+        inline bool SortsDraws() const
+        {
+            return mSortDraws;
+        }
+
+        // Support for frame statistics, counters of the work submitted by
+        // the engine that are always maintained. A draw call is a draw of a
+        // primitive, instanced or not, or a record of an indirect draw, and
+        // the primitives of a draw are its active primitives times its
+        // instances; the primitives of indirect draws are determined by the
+        // GPU and are not counted. The binds are those issued to the
+        // graphics API, after the redundant binds of consecutive draws are
+        // skipped, with vertex, index, constant and structured buffers
+        // counted as buffer binds. The uploaded bytes are those copied by
+        // Update and CopyCpuToGpu, which for a buffer with dirty ranges are
+        // the bytes of the ranges, and the read-back bytes are those copied
+        // by CopyGpuToCpu and CopyStagingToCpu. The created resources are
+        // the engine-specific objects created by Bind, and the evicted
+        // resources are those unbound by the memory budget. DisplayColorBuffer
+        // ends the frame, after which GetFrameStatistics returns the
+        // counters of the frame. Applications that do not display the back
+        // buffer call EndFrameStatistics instead.
+        struct FrameStatistics
+        {
+            FrameStatistics()
+                :
+                numDraws(0),
+                numPrimitives(0),
+                numDispatches(0),
+                numProgramBinds(0),
+                numBufferBinds(0),
+                numTextureBinds(0),
+                numBytesUploaded(0),
+                numBytesReadBack(0),
+                numResourcesCreated(0),
+                numResourcesEvicted(0)
+            {
+            }
+
+            uint64_t numDraws;
+            uint64_t numPrimitives;
+            uint64_t numDispatches;
+            uint64_t numProgramBinds;
+            uint64_t numBufferBinds;
+            uint64_t numTextureBinds;
+            uint64_t numBytesUploaded;
+            uint64_t numBytesReadBack;
+            uint64_t numResourcesCreated;
+            uint64_t numResourcesEvicted;
+        };
+
+        // The counters of the last completed frame.
+        inline FrameStatistics const& GetFrameStatistics() const
+        {
+            return mFrameStatistics;
+        }
+
+        // The counters of the current frame so far.
+        inline FrameStatistics const& GetCurrentFrameStatistics() const
+        {
+            return mStatistics;
+        }
+
+        void EndFrameStatistics();
+
+        // Support for a budget of GPU memory. The engine counts the bytes of
+        // the buffers and textures that have engine-specific objects, the
+        // resident bytes, and records the frame of the last Bind of each
+        // object, which the draws and compute executions call for every
+        // resource they use. When the creation of an object makes the
+        // resident bytes exceed the budget, the least recently used buffers
+        // and textures are unbound until the resident bytes are within the
+        // budget, and their objects are created again from their CPU data
+        // by the next Bind. A resource is evicted only when it was not used
+        // in the current frame, has CPU data and has usage IMMUTABLE or
+        // DYNAMIC_UPDATE, so its CPU data is a copy of its GPU data; render
+        // targets, depth-stencil textures and SHADER_OUTPUT resources are
+        // never evicted. The frames end with DisplayColorBuffer or
+        // EndFrameStatistics. The staging memory of the resources is not
+        // counted. A budget of 0, the default, disables the eviction.
+        inline void SetMemoryBudget(uint64_t numBytes)
+        {
+            mMemoryBudget = numBytes;
+        }
+
+        inline uint64_t GetMemoryBudget() const
+        {
+            return mMemoryBudget;
+        }
+
+        inline uint64_t GetResidentBytes() const
+        {
+            return mResidentBytes;
+        }
+
+        // Evict resources as described above until the resident bytes are
+        // at most maxResidentBytes, for example when the application
+        // detects that memory is low. The return value is the number of
+        // bytes evicted, which is smaller than requested when there are not
+        // enough resources that can be evicted.
+        uint64_t EvictResources(uint64_t maxResidentBytes);
+
         // Support for drawing to offscreen memory (i.e. not to the back
         // buffer).  The DrawTarget object encapsulates render targets (color
         // information) and depth-stencil target.
@@ -119,6 +300,43 @@ namespace gte
         virtual bool CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray) = 0;
         virtual bool CopyCpuToGpu(std::shared_ptr<TextureArray> const& textureArray, unsigned int item, unsigned int level) = 0;
 
+        // Support for mipmap streaming. Apply the minimum resident level of
+        // the texture (see TextureSingle::SetMinResidentLevel), copying the
+        // CPU data of the levels that become resident to the GPU.
+        virtual bool UpdateResidency(std::shared_ptr<TextureSingle> const& texture) = 0;
+
+        // Support for uploading resources over several frames. Loading a
+        // large texture with Bind copies all its data to the GPU at once,
+        // which stalls the frame. Instead, a loader thread fills the CPU
+        // data of the resource and calls EnqueueUpload, which may be called
+        // from any thread. ProcessUploads, called once per frame on the
+        // thread of the engine, creates the GPU object of a queued resource
+        // without data and then copies the data in steps through the
+        // staging memory of the resource (pixel unpack buffers for OpenGL,
+        // staging textures and buffers for Direct3D), a subresource of a
+        // texture or a range of elements of a buffer per step, until
+        // maxBytes bytes are copied in the frame. At least one step is
+        // performed per call, so a subresource larger than maxBytes is still
+        // uploaded. The callback of a resource is called by ProcessUploads
+        // after its last step; the resource must not be used for drawing
+        // before then. The return value is the number of bytes copied.
+        //
+        // The copy type of the resource must be COPY_CPU_TO_STAGING or
+        // COPY_BIDIRECTIONAL. Direct3D does not allow creating an IMMUTABLE
+        // resource without data, so the usage must be SHADER_OUTPUT for
+        // textures and DYNAMIC_UPDATE or SHADER_OUTPUT for buffers. A
+        // texture with autogenerated mipmaps is uploaded in one step. The
+        // CPU data of the resource must not be modified until the callback.
+        typedef std::function<void(std::shared_ptr<Resource> const&)> UploadCallback;
+
+        void EnqueueUpload(std::shared_ptr<Resource> const& resource,
+            UploadCallback const& callback = nullptr);
+
+        size_t ProcessUploads(size_t maxBytes);
+
+        // The number of resources enqueued and not yet fully uploaded.
+        size_t GetNumPendingUploads();
+
         // Support for copying from GPU to CPU via staging memory.
         virtual bool CopyGpuToCpu(std::shared_ptr<Buffer> const& buffer) = 0;
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureSingle> const& texture) = 0;
@@ -126,6 +344,19 @@ namespace gte
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray) = 0;
         virtual bool CopyGpuToCpu(std::shared_ptr<TextureArray> const& textureArray, unsigned int item, unsigned int level) = 0;
 
+        // Support for copying from GPU to CPU in two steps. StageGpuToCpu
+        // enqueues the copy from GPU memory to staging memory and returns
+        // without waiting for the GPU. CopyStagingToCpu copies the staging
+        // memory to CPU memory, waiting only if the GPU has not finished the
+        // staged copy. GPU work submitted between the calls, including
+        // writes to the texture, overlaps the copy and does not affect the
+        // staged data. The texture copy type must be COPY_STAGING_TO_CPU or
+        // COPY_BIDIRECTIONAL.
+        virtual bool StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture) = 0;
+        virtual bool StageGpuToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level) = 0;
+        virtual bool CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture) = 0;
+        virtual bool CopyStagingToCpu(std::shared_ptr<TextureSingle> const& texture, unsigned int level) = 0;
+
         // Support for copying from GPU to GPU directly.  TODO: We will
         // improve on the feature set for such copies later.  For now, the
         // restrictions are that the resources are different, of the same
@@ -165,6 +396,15 @@ namespace gte
         virtual void Execute(std::shared_ptr<ComputeProgram> const& program,
             unsigned int numXGroups, unsigned int numYGroups, unsigned int numZGroups) = 0;
 
+        // Execute the compute program with the numbers of groups read by
+        // the GPU from 'arguments', the three 4-byte values (numXGroups,
+        // numYGroups, numZGroups) starting at byte 'offset'. The arguments
+        // can be generated on the GPU, for example by a compute program
+        // writing a structured buffer that is copied to 'arguments' by
+        // CopyGpuToGpu, so that the CPU does not wait for them.
+        virtual void Execute(std::shared_ptr<ComputeProgram> const& program,
+            std::shared_ptr<IndirectArgumentsBuffer> const& arguments, unsigned int offset) = 0;
+
         // Have the CPU wait until the GPU finishes its current command
         // buffer.
         virtual void WaitForFinish() = 0;
@@ -195,6 +435,35 @@ namespace gte
             std::shared_ptr<IndexBuffer> const& ibuffer,
             std::shared_ptr<VisualEffect> const& effect) = 0;
 
+        // Draw the active elements of the instance buffer as instances of
+        // the primitive. The attributes of the instance buffer follow those
+        // of the vertex buffer in the input layout and advance once per
+        // instance. This is called by Draw for an InstancedVisual.
+        virtual uint64_t DrawInstancedPrimitive(
+            std::shared_ptr<VertexBuffer> const& vbuffer,
+            std::shared_ptr<VertexBuffer> const& instanceBuffer,
+            std::shared_ptr<IndexBuffer> const& ibuffer,
+            std::shared_ptr<VisualEffect> const& effect) = 0;
+
+        // The Draw functions for arrays of visuals call BeginDrawBatch
+        // before the first DrawPrimitive call and EndDrawBatch after the
+        // last one.  Between the calls, an engine may keep the program,
+        // resources and buffers of a draw bound and skip binding them again
+        // for the next draw, unbinding them in EndDrawBatch.
+        virtual void BeginDrawBatch();
+        virtual void EndDrawBatch();
+
+        // Unbind calls this function before the engine-specific object of
+        // a front-end object is destroyed, so an engine can discard the
+        // state that refers to it.
+        virtual void OnUnbind(GEObject* geObject);
+
+        // Sort the visuals by a 64-bit key, the concatenation of indices of
+        // the program (16 bits), effect (24 bits) and vertex buffer (24
+        // bits), assigned in the order of first occurrence in the array.
+        // The sorted visuals are stored in mDrawQueue.
+        void SortVisuals(std::vector<Visual*> const& visuals);
+
         // Support for GOListener::OnDestroy and DTListener::OnDestroy,
         // because they are passed raw pointers from resource destructors.
         // These are also used by the Unbind calls whose inputs are
@@ -202,10 +471,17 @@ namespace gte
         bool Unbind(GraphicsObject const* object);
         bool Unbind(DrawTarget const* target);
 
+        // The number of bytes copied by Update for a buffer, the bytes of
+        // its dirty ranges when it has any and its active bytes otherwise.
+        static uint64_t GetNumUpdateBytes(Buffer const* buffer);
+
 
         // Bridge pattern to create graphics API-specific objects that
         // correspond to front-end objects.  The Bind, Get, and Unbind
-        // operations act on these maps.
+        // operations act on these maps.  The maps own the objects; Bind and
+        // Get first try the object cached by the front-end object (see
+        // GraphicsObject::GetGEObject), so the lookups of the draws do not
+        // lock the mutex of mGOMap.
         ThreadSafeMap<GraphicsObject const*, std::shared_ptr<GEObject>> mGOMap;
         ThreadSafeMap<DrawTarget const*, std::shared_ptr<GEDrawTarget>> mDTMap;
         std::unique_ptr<GEInputLayoutManager> mILMap;
@@ -249,5 +525,39 @@ namespace gte
 
         bool mAllowOcclusionQuery;
         bool mWarnOnNonemptyBridges;
+
+        // Storage for the render queue, retained between draws.
+        std::vector<Visual*> mDrawInput, mDrawQueue;
+        std::vector<std::pair<uint64_t, size_t>> mDrawKeys;
+        std::unordered_map<void const*, uint64_t> mDrawKeyIndices[3];
+        bool mSortDraws;
+
+        // The statistics of the current frame and of the last frame.
+        FrameStatistics mStatistics, mFrameStatistics;
+
+        // Support for the memory budget. The resident bytes are atomic
+        // because objects can be unbound by the destruction of their
+        // front-end objects in other threads.
+        uint64_t mFrame;
+        uint64_t mMemoryBudget;
+        std::atomic<uint64_t> mResidentBytes;
+
+        // Support for the upload queue. The enqueued uploads are moved from
+        // mEnqueuedUploads, which is shared with the loader threads, to
+        // mUploads by ProcessUploads. The next step of an upload is the
+        // index of a subresource for a texture or of an element for a buffer.
+        struct Upload
+        {
+            std::shared_ptr<Resource> resource;
+            UploadCallback callback;
+            bool bound;
+            unsigned int next;
+        };
+
+        size_t UploadStep(Upload& upload, size_t maxBytes);
+
+        std::mutex mUploadMutex;
+        std::vector<Upload> mEnqueuedUploads;
+        std::deque<Upload> mUploads;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/GraphicsObject.h>
@@ -23,13 +23,15 @@ GraphicsObject::~GraphicsObject()
 
 GraphicsObject::GraphicsObject()
     :
-    mType(GT_GRAPHICS_OBJECT)
+    mType(GT_GRAPHICS_OBJECT),
+    mGEObject(nullptr)
 {
 }
 
 GraphicsObject::GraphicsObject(GraphicsObjectType type)
     :
-    mType(type)
+    mType(type),
+    mGEObject(nullptr)
 {
 }
 
@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -15,6 +16,8 @@
 
 namespace gte
 {
+    class GEObject;
+
     // The current hierarchy of graphics objects is
     //  GraphicsObject
     //      Resource
@@ -159,9 +162,32 @@ namespace gte
         static void SubscribeForDestruction(std::shared_ptr<ListenerForDestruction> const& listener);
         static void UnsubscribeForDestruction(std::shared_ptr<ListenerForDestruction> const& listener);
 
+        // The engine-specific object created for this object by the first
+        // engine that binds it, so that GraphicsEngine::Bind and Get find
+        // it without searching the bridge map of the engine. The bridge map
+        // owns the engine-specific object, which clears this pointer when
+        // it is destroyed.
+        inline GEObject* GetGEObject() const
+        {
+            return mGEObject.load(std::memory_order_acquire);
+        }
+
+        inline void SetGEObject(GEObject* geObject) const
+        {
+            GEObject* expected = nullptr;
+            mGEObject.compare_exchange_strong(expected, geObject, std::memory_order_acq_rel);
+        }
+
+        inline void ClearGEObject(GEObject* geObject) const
+        {
+            GEObject* expected = geObject;
+            mGEObject.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+        }
+
     protected:
         GraphicsObjectType mType;
         std::string mName;
+        mutable std::atomic<GEObject*> mGEObject;
 
     private:
         // Support for listeners for destruction (LFD).
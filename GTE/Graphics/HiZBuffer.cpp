@@ -0,0 +1,256 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/HiZBuffer.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstring>
+using namespace gte;
+
+HiZBuffer::HiZBuffer(std::shared_ptr<ProgramFactory> const& factory,
+    unsigned int width, unsigned int height)
+    :
+    mWidth(width),
+    mHeight(height),
+    mNumLevels(0)
+{
+    LogAssert(width > 0 && height > 0, "Invalid dimensions.");
+
+    // The level dimensions are halved, rounding down, until both are 1.
+    mLevels = std::make_shared<ConstantBuffer>(HIZ_MAX_LEVELS * 4 * sizeof(uint32_t), false);
+    auto levels = mLevels->Get<uint32_t>();
+    std::memset(levels, 0, mLevels->GetNumBytes());
+    unsigned int numTexels = 0;
+    for (unsigned int w = width, h = height; ; w = std::max(w / 2, 1u), h = std::max(h / 2, 1u))
+    {
+        LogAssert(mNumLevels < HIZ_MAX_LEVELS, "The dimensions are too large.");
+        uint32_t* level = levels + 4 * mNumLevels;
+        level[0] = numTexels;
+        level[1] = w;
+        level[2] = h;
+        numTexels += w * h;
+        ++mNumLevels;
+        if (w == 1 && h == 1)
+        {
+            break;
+        }
+    }
+    levels[3] = mNumLevels;
+
+    mPyramid = std::make_shared<StructuredBuffer>(numTexels, sizeof(float));
+    mPyramid->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mPyramid->GetData(), 0, mPyramid->GetNumBytes());
+
+    mReductions.resize(mNumLevels);
+    for (unsigned int i = 1; i < mNumLevels; ++i)
+    {
+        mReductions[i] = std::make_shared<ConstantBuffer>(4 * sizeof(uint32_t), false);
+        auto reduction = mReductions[i]->Get<uint32_t>();
+        reduction[0] = i;
+        reduction[1] = 0;
+        reduction[2] = 0;
+        reduction[3] = 0;
+    }
+
+    mSampler = std::make_shared<SamplerState>();
+    mSampler->filter = SamplerState::MIN_P_MAG_P_MIP_P;
+    mSampler->mode[0] = SamplerState::CLAMP;
+    mSampler->mode[1] = SamplerState::CLAMP;
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("HIZ_MAX_LEVELS", static_cast<int>(HIZ_MAX_LEVELS));
+
+    mCopyDepth = factory->CreateFromSource(*msCopyDepthSource[api]);
+    if (mCopyDepth)
+    {
+        auto cshader = mCopyDepth->GetComputeShader();
+        cshader->Set("HiZLevels", mLevels);
+        cshader->Set("pyramid", mPyramid);
+    }
+
+    mReduce = factory->CreateFromSource(*msReduceSource[api]);
+    if (mReduce)
+    {
+        auto cshader = mReduce->GetComputeShader();
+        cshader->Set("HiZLevels", mLevels);
+        cshader->Set("pyramid", mPyramid);
+    }
+
+    factory->PopDefines();
+}
+
+void HiZBuffer::Execute(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<TextureSingle> const& depth)
+{
+    LogAssert(engine != nullptr && depth != nullptr, "Invalid input.");
+    LogAssert(depth->GetDimension(0) == mWidth && depth->GetDimension(1) == mHeight,
+        "The depth texture must have the dimensions of the buffer.");
+
+    mCopyDepth->GetComputeShader()->Set("depthTexture", depth, "depthSampler", mSampler);
+    engine->Execute(mCopyDepth, (mWidth + 7) / 8, (mHeight + 7) / 8, 1);
+
+    auto cshader = mReduce->GetComputeShader();
+    auto levels = mLevels->Get<uint32_t>();
+    for (unsigned int i = 1; i < mNumLevels; ++i)
+    {
+        cshader->Set("Reduction", mReductions[i]);
+        engine->Execute(mReduce, (levels[4 * i + 1] + 7) / 8, (levels[4 * i + 2] + 7) / 8, 1);
+    }
+}
+
+
+std::string const HiZBuffer::msGLSLCopyDepthSource =
+R"(
+    uniform HiZLevels
+    {
+        uvec4 levels[HIZ_MAX_LEVELS];   // (offset, width, height, numLevels)
+    };
+
+    uniform sampler2D depthSampler;
+    buffer pyramid { float data[]; } pyramidSB;
+
+    layout (local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+    void main()
+    {
+        uvec2 t = gl_GlobalInvocationID.xy;
+        if (t.x < levels[0].y && t.y < levels[0].z)
+        {
+            pyramidSB.data[t.y * levels[0].y + t.x] = texelFetch(depthSampler, ivec2(t), 0).r;
+        }
+    }
+)";
+
+std::string const HiZBuffer::msGLSLReduceSource =
+R"(
+    uniform HiZLevels
+    {
+        uvec4 levels[HIZ_MAX_LEVELS];   // (offset, width, height, numLevels)
+    };
+
+    uniform Reduction
+    {
+        uvec4 reduction;                // (level, 0, 0, 0)
+    };
+
+    buffer pyramid { float data[]; } pyramidSB;
+
+    layout (local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+    void main()
+    {
+        uvec4 dst = levels[reduction.x];
+        uvec4 src = levels[reduction.x - 1u];
+        uvec2 t = gl_GlobalInvocationID.xy;
+        if (t.x < dst.y && t.y < dst.z)
+        {
+            // The last row or column covers the odd row or column of the
+            // previous level.
+            uvec2 t0 = min(2u * t, src.yz - 1u);
+            uvec2 t1 = min(2u * t + 1u, src.yz - 1u);
+            if (t.x + 1u == dst.y)
+            {
+                t1.x = src.y - 1u;
+            }
+            if (t.y + 1u == dst.z)
+            {
+                t1.y = src.z - 1u;
+            }
+
+            float depth = 0.0f;
+            for (uint y = t0.y; y <= t1.y; ++y)
+            {
+                for (uint x = t0.x; x <= t1.x; ++x)
+                {
+                    depth = max(depth, pyramidSB.data[src.x + y * src.y + x]);
+                }
+            }
+            pyramidSB.data[dst.x + t.y * dst.y + t.x] = depth;
+        }
+    }
+)";
+
+std::string const HiZBuffer::msHLSLCopyDepthSource =
+R"(
+    cbuffer HiZLevels
+    {
+        uint4 levels[HIZ_MAX_LEVELS];   // (offset, width, height, numLevels)
+    };
+
+    Texture2D<float> depthTexture;
+    SamplerState depthSampler;
+    RWStructuredBuffer<float> pyramid;
+
+    [numthreads(8, 8, 1)]
+    void CSMain(uint3 t : SV_DispatchThreadID)
+    {
+        if (t.x < levels[0].y && t.y < levels[0].z)
+        {
+            float2 tcoord = (float2(t.xy) + 0.5f) / float2(levels[0].yz);
+            pyramid[t.y * levels[0].y + t.x] = depthTexture.SampleLevel(depthSampler, tcoord, 0.0f);
+        }
+    }
+)";
+
+std::string const HiZBuffer::msHLSLReduceSource =
+R"(
+    cbuffer HiZLevels
+    {
+        uint4 levels[HIZ_MAX_LEVELS];   // (offset, width, height, numLevels)
+    };
+
+    cbuffer Reduction
+    {
+        uint4 reduction;                // (level, 0, 0, 0)
+    };
+
+    RWStructuredBuffer<float> pyramid;
+
+    [numthreads(8, 8, 1)]
+    void CSMain(uint3 t : SV_DispatchThreadID)
+    {
+        uint4 dst = levels[reduction.x];
+        uint4 src = levels[reduction.x - 1];
+        if (t.x < dst.y && t.y < dst.z)
+        {
+            // The last row or column covers the odd row or column of the
+            // previous level.
+            uint2 t0 = min(2 * t.xy, src.yz - 1);
+            uint2 t1 = min(2 * t.xy + 1, src.yz - 1);
+            if (t.x + 1 == dst.y)
+            {
+                t1.x = src.y - 1;
+            }
+            if (t.y + 1 == dst.z)
+            {
+                t1.y = src.z - 1;
+            }
+
+            float depth = 0.0f;
+            for (uint y = t0.y; y <= t1.y; ++y)
+            {
+                for (uint x = t0.x; x <= t1.x; ++x)
+                {
+                    depth = max(depth, pyramid[src.x + y * src.y + x]);
+                }
+            }
+            pyramid[dst.x + t.y * dst.y + t.x] = depth;
+        }
+    }
+)";
+
+ProgramSources const HiZBuffer::msCopyDepthSource =
+{
+    &msGLSLCopyDepthSource,
+    &msHLSLCopyDepthSource
+};
+
+ProgramSources const HiZBuffer::msReduceSource =
+{
+    &msGLSLReduceSource,
+    &msHLSLReduceSource
+};
@@ -0,0 +1,104 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/SamplerState.h>
+#include <Graphics/StructuredBuffer.h>
+#include <Graphics/TextureSingle.h>
+#include <vector>
+
+// A hierarchical depth buffer (hi-Z) built by compute shaders for GPU
+// occlusion culling. Level 0 is a copy of a depth texture and each next
+// level stores the maximum depth of the 2x2 texels of the previous level
+// that it covers (3 texels along an odd dimension at the last row or
+// column), so a level-l texel bounds the depth of the scene in its region.
+// An object whose nearest depth is larger than the maximum depth of the
+// texels that its screen rectangle covers is occluded. The levels are
+// stored consecutively in a structured buffer of floats, row by row in the
+// order of the rows of the depth texture, and their offsets and dimensions
+// are stored in a constant buffer "HiZLevels" of HIZ_MAX_LEVELS uint4
+// values (offset, width, height, number of levels). InstanceCuller tests
+// its instances against the buffer when it is passed one.
+//
+// The depth texture is that of a draw target whose depth-stencil texture
+// is a shader input (see TextureDS::MakeShaderInput), with format
+// DF_D32_FLOAT or DF_D24_UNORM_S8_UINT, read after the target is disabled.
+// It contains the depth of the occluders drawn in the current frame before
+// Execute, for example the large objects near the camera, or the depth of
+// the previous frame, in which case objects that become visible with a
+// camera motion appear a frame late.
+
+namespace gte
+{
+    class HiZBuffer
+    {
+    public:
+        enum
+        {
+            HIZ_MAX_LEVELS = 16
+        };
+
+        // Construction for depth textures of the specified dimensions.
+        HiZBuffer(std::shared_ptr<ProgramFactory> const& factory,
+            unsigned int width, unsigned int height);
+
+        // Member access.
+        inline unsigned int GetWidth() const
+        {
+            return mWidth;
+        }
+
+        inline unsigned int GetHeight() const
+        {
+            return mHeight;
+        }
+
+        inline unsigned int GetNumLevels() const
+        {
+            return mNumLevels;
+        }
+
+        inline std::shared_ptr<StructuredBuffer> const& GetPyramid() const
+        {
+            return mPyramid;
+        }
+
+        inline std::shared_ptr<ConstantBuffer> const& GetLevels() const
+        {
+            return mLevels;
+        }
+
+        // Build the levels from the depth texture.
+        void Execute(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<TextureSingle> const& depth);
+
+    private:
+        unsigned int mWidth, mHeight, mNumLevels;
+        std::shared_ptr<StructuredBuffer> mPyramid;
+        std::shared_ptr<ConstantBuffer> mLevels;
+        std::shared_ptr<SamplerState> mSampler;
+
+        // The constant buffers "Reduction" store the index of the level
+        // written by a reduction, one per level after level 0.
+        std::vector<std::shared_ptr<ConstantBuffer>> mReductions;
+
+        std::shared_ptr<ComputeProgram> mCopyDepth;
+        std::shared_ptr<ComputeProgram> mReduce;
+
+        // Shader source code as strings.
+        static std::string const msGLSLCopyDepthSource;
+        static std::string const msGLSLReduceSource;
+        static std::string const msHLSLCopyDepthSource;
+        static std::string const msHLSLReduceSource;
+        static ProgramSources const msCopyDepthSource;
+        static ProgramSources const msReduceSource;
+    };
+}
@@ -3,14 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/Buffer.h>
 
-// IndirectArgumentsBuffer is currently supported only in the DirectX graphics
-// engine.
+// IndirectArgumentsBuffer is supported in the DirectX graphics engine and,
+// for GraphicsEngine::Execute with indirect arguments, in the OpenGL
+// graphics engine.
 
 namespace gte
 {
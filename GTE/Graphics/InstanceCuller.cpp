@@ -0,0 +1,523 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/InstanceCuller.h>
+#include <Graphics/Culler.h>
+#include <Mathematics/Logger.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+using namespace gte;
+
+InstanceCuller::InstanceCuller(std::shared_ptr<ProgramFactory> const& factory,
+    std::vector<DrawInfo> const& draws, bool indexed, std::shared_ptr<HiZBuffer> const& hiZ)
+    :
+    mNumDraws(static_cast<unsigned int>(draws.size())),
+    mNumInstances(0),
+    mNumCullGroups(0),
+    mFirstInstance(draws.size()),
+    mHiZ(hiZ)
+{
+    LogAssert(mNumDraws > 0, "At least one draw is required.");
+
+    for (unsigned int d = 0; d < mNumDraws; ++d)
+    {
+        mFirstInstance[d] = mNumInstances;
+        mNumInstances += draws[d].numInstances;
+    }
+    LogAssert(mNumInstances > 0, "At least one instance is required.");
+    mNumCullGroups = (mNumInstances + 63) / 64;
+
+    mFrustum = std::make_shared<ConstantBuffer>(sizeof(Frustum), true);
+    std::memset(mFrustum->GetData(), 0, mFrustum->GetNumBytes());
+    mFrustum->Get<Frustum>()->numInstances[0] = mNumInstances;
+
+    // The instances have the identity transform and are assigned to their
+    // draws.
+    mInstances = std::make_shared<StructuredBuffer>(mNumInstances, sizeof(Instance));
+    mInstances->SetUsage(Resource::DYNAMIC_UPDATE);
+    auto instances = mInstances->Get<Instance>();
+    for (unsigned int d = 0; d < mNumDraws; ++d)
+    {
+        for (unsigned int i = 0; i < draws[d].numInstances; ++i)
+        {
+            Instance& instance = instances[mFirstInstance[d] + i];
+            instance.row[0] = { 1.0f, 0.0f, 0.0f, 0.0f };
+            instance.row[1] = { 0.0f, 1.0f, 0.0f, 0.0f };
+            instance.row[2] = { 0.0f, 0.0f, 1.0f, 0.0f };
+            instance.draw = d;
+            instance.padding[0] = 0;
+            instance.padding[1] = 0;
+            instance.padding[2] = 0;
+        }
+    }
+
+    // The instanceCount of a record is at index 1 for both layouts, and the
+    // startInstance is at the last index.
+    unsigned int const stride = (indexed ? 5 : 4);
+    mDraws = std::make_shared<StructuredBuffer>(mNumDraws, sizeof(DrawBound));
+    mCounts = std::make_shared<StructuredBuffer>(stride * mNumDraws, sizeof(uint32_t));
+    mCounts->SetUsage(Resource::SHADER_OUTPUT);
+    mArguments = std::make_shared<IndirectArgumentsBuffer>(stride * mNumDraws);
+    auto bounds = mDraws->Get<DrawBound>();
+    auto counts = mCounts->Get<uint32_t>();
+    for (unsigned int d = 0; d < mNumDraws; ++d, counts += stride)
+    {
+        DrawInfo const& draw = draws[d];
+        bounds[d].sphere = HLift(draw.center, draw.radius);
+        bounds[d].region[0] = mFirstInstance[d];
+        bounds[d].region[1] = stride * d + 1;
+        bounds[d].region[2] = 0;
+        bounds[d].region[3] = 0;
+
+        counts[0] = draw.numElements;
+        counts[1] = 0;
+        counts[2] = draw.firstElement;
+        if (indexed)
+        {
+            counts[3] = static_cast<uint32_t>(draw.baseVertex);
+        }
+        counts[stride - 1] = mFirstInstance[d];
+    }
+    std::memcpy(mArguments->GetData(), mCounts->GetData(), mCounts->GetNumBytes());
+
+    mVisible = std::make_shared<StructuredBuffer>(3 * mNumInstances, sizeof(Vector4<float>));
+    mVisible->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mVisible->GetData(), 0, mVisible->GetNumBytes());
+    mTransforms = InstancedVisual::CreateTransformBuffer(mNumInstances);
+    mTransforms->SetUsage(Resource::SHADER_OUTPUT);
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_DRAWS", mNumDraws);
+    factory->defines.Set("ARGUMENTS_STRIDE", stride);
+    factory->defines.Set("HIZ_CULLING", (mHiZ ? 1 : 0));
+    factory->defines.Set("HIZ_MAX_LEVELS", static_cast<int>(HiZBuffer::HIZ_MAX_LEVELS));
+
+    mResetCounts = factory->CreateFromSource(*msResetCountsSource[api]);
+    if (mResetCounts)
+    {
+        mResetCounts->GetComputeShader()->Set("counts", mCounts);
+    }
+
+    mCull = factory->CreateFromSource(*msCullSource[api]);
+    if (mCull)
+    {
+        auto cshader = mCull->GetComputeShader();
+        cshader->Set("Frustum", mFrustum);
+        cshader->Set("instances", mInstances);
+        cshader->Set("draws", mDraws);
+        cshader->Set("visible", mVisible);
+        cshader->Set("counts", mCounts);
+        if (mHiZ)
+        {
+            cshader->Set("HiZLevels", mHiZ->GetLevels());
+            cshader->Set("hiZ", mHiZ->GetPyramid());
+        }
+    }
+
+    factory->PopDefines();
+}
+
+void InstanceCuller::SetInstance(unsigned int draw, unsigned int i,
+    Transform<float> const& transform)
+{
+    LogAssert(draw < mNumDraws, "Invalid draw.");
+    unsigned int const end = (draw + 1 < mNumDraws ? mFirstInstance[draw + 1] : mNumInstances);
+    LogAssert(mFirstInstance[draw] + i < end, "Invalid instance.");
+
+    // The rows are those of InstancedVisual::SetInstanceTransform.
+    Matrix4x4<float> const& hmatrix = transform.GetHMatrix();
+    Instance& instance = mInstances->Get<Instance>()[mFirstInstance[draw] + i];
+    for (int r = 0; r < 3; ++r)
+    {
+#if defined(GTE_USE_MAT_VEC)
+        instance.row[r] = hmatrix.GetRow(r);
+#else
+        instance.row[r] = hmatrix.GetCol(r);
+#endif
+    }
+}
+
+void InstanceCuller::Execute(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Camera> const& camera, std::shared_ptr<InstancedVisual> const& visual)
+{
+    LogAssert(engine != nullptr && camera != nullptr && visual != nullptr, "Invalid input.");
+
+    // Transform the world planes (n,c), with signed distance Dot((n,c),
+    // (X,1)), to the model space of the visual and normalize them.
+    std::array<CullingPlane<float>, Camera::VF_QUANTITY> planes;
+    Culler::GetViewFrustumPlanes(camera, planes);
+    Matrix4x4<float> const& hmatrix = visual->worldTransform.GetHMatrix();
+    auto frustum = mFrustum->Get<Frustum>();
+    for (int i = 0; i < Camera::VF_QUANTITY; ++i)
+    {
+        Vector4<float> plane = planes[i].GetNormal();
+        plane[3] = planes[i].GetConstant();
+#if defined(GTE_USE_MAT_VEC)
+        plane = plane * hmatrix;
+#else
+        plane = hmatrix * plane;
+#endif
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        frustum->plane[i] = plane / length;
+    }
+
+#if defined(GTE_USE_MAT_VEC)
+    frustum->pvwMatrix = camera->GetProjectionViewMatrix() * hmatrix;
+#else
+    frustum->pvwMatrix = hmatrix * camera->GetProjectionViewMatrix();
+#endif
+    if (camera->IsDepthRangeZeroOne())
+    {
+        frustum->depthMap = { 1.0f, 0.0f, 0.0f, 0.0f };
+    }
+    else
+    {
+        frustum->depthMap = { 0.5f, 0.5f, 0.0f, 0.0f };
+    }
+    engine->Update(mFrustum);
+
+    engine->Execute(mResetCounts, (mNumDraws + 63) / 64, 1, 1);
+    engine->Execute(mCull, mNumCullGroups, 1, 1);
+    engine->CopyGpuToGpu(mVisible, mTransforms);
+    engine->CopyGpuToGpu(mCounts, mArguments);
+}
+
+uint64_t InstanceCuller::Draw(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Camera> const& camera, std::shared_ptr<InstancedVisual> const& visual)
+{
+    LogAssert(visual->GetInstanceBuffer() == mTransforms,
+        "The instance buffer of the visual must be GetTransforms().");
+
+    Execute(engine, camera, visual);
+    return engine->DrawIndirect(visual, mArguments, 0, mNumDraws);
+}
+
+
+std::string const InstanceCuller::msGLSLResetCountsSource =
+R"(
+    buffer counts { uint data[]; } countsSB;
+
+    layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        uint d = gl_GlobalInvocationID.x;
+        if (d < uint(NUM_DRAWS))
+        {
+            countsSB.data[uint(ARGUMENTS_STRIDE) * d + 1u] = 0u;
+        }
+    }
+)";
+
+std::string const InstanceCuller::msGLSLCullSource =
+R"(
+    uniform Frustum
+    {
+        vec4 planes[6];
+        uvec4 numInstances;     // (numInstances, 0, 0, 0)
+        mat4 pvwMatrix;
+        vec4 depthMap;          // window depth = depthMap.x * z + depthMap.y
+    };
+
+    struct Instance
+    {
+        vec4 row[3];
+        uvec4 draw;             // (draw, 0, 0, 0)
+    };
+
+    struct DrawBound
+    {
+        vec4 sphere;            // (center, radius)
+        uvec4 region;           // (firstInstance, index of instanceCount, 0, 0)
+    };
+
+    buffer instances { Instance data[]; } instancesSB;
+    buffer draws { DrawBound data[]; } drawsSB;
+    buffer visible { vec4 data[]; } visibleSB;
+    buffer counts { uint data[]; } countsSB;
+
+#if HIZ_CULLING
+    uniform HiZLevels
+    {
+        uvec4 levels[HIZ_MAX_LEVELS];   // (offset, width, height, numLevels)
+    };
+
+    buffer hiZ { float data[]; } hiZSB;
+
+    bool IsOccluded(vec3 center, float radius)
+    {
+        // Compute the texture rectangle and the nearest depth of the cube
+        // that bounds the sphere. In OpenGL the first row of the depth
+        // texture is at the bottom of the window.
+        vec2 tmin = vec2(1.0f), tmax = vec2(0.0f);
+        float zmin = 1.0f;
+        for (int i = 0; i < 8; ++i)
+        {
+            vec3 sign = vec3((i & 1) != 0 ? 1.0f : -1.0f, (i & 2) != 0 ? 1.0f : -1.0f,
+                (i & 4) != 0 ? 1.0f : -1.0f);
+            vec4 corner = vec4(center + radius * sign, 1.0f);
+#if GTE_USE_MAT_VEC
+            vec4 clip = pvwMatrix * corner;
+#else
+            vec4 clip = corner * pvwMatrix;
+#endif
+            if (clip.w <= 0.0f)
+            {
+                // The cube is not entirely in front of the eye.
+                return false;
+            }
+            vec3 ndc = clip.xyz / clip.w;
+            vec2 tcoord = 0.5f * ndc.xy + 0.5f;
+            tmin = min(tmin, tcoord);
+            tmax = max(tmax, tcoord);
+            zmin = min(zmin, depthMap.x * ndc.z + depthMap.y);
+        }
+        tmin = clamp(tmin, 0.0f, 1.0f);
+        tmax = clamp(tmax, 0.0f, 1.0f);
+
+        // Select the level at which the rectangle covers at most 2x2
+        // texels. A texel (x,y) of level 0 is covered by the texel
+        // (x,y)/2^level of a level, or by the last row or column.
+        uint numLevels = levels[0].w;
+        vec2 size = (tmax - tmin) * vec2(levels[0].yz);
+        uint level = uint(clamp(ceil(log2(max(max(size.x, size.y), 1.0f))), 0.0f,
+            float(numLevels - 1u)));
+        uvec2 r0 = min(uvec2(tmin * vec2(levels[0].yz)), levels[0].yz - 1u);
+        uvec2 r1 = min(uvec2(tmax * vec2(levels[0].yz)), levels[0].yz - 1u);
+        uvec2 t0, t1;
+        for (;;)
+        {
+            t0 = min(r0 >> level, levels[level].yz - 1u);
+            t1 = min(r1 >> level, levels[level].yz - 1u);
+            if ((t1.x - t0.x <= 1u && t1.y - t0.y <= 1u) || level + 1u == numLevels)
+            {
+                break;
+            }
+            ++level;
+        }
+
+        float depth = 0.0f;
+        for (uint y = t0.y; y <= t1.y; ++y)
+        {
+            for (uint x = t0.x; x <= t1.x; ++x)
+            {
+                depth = max(depth, hiZSB.data[levels[level].x + y * levels[level].y + x]);
+            }
+        }
+        return zmin > depth;
+    }
+#endif
+
+    layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        uint i = gl_GlobalInvocationID.x;
+        if (i < numInstances.x)
+        {
+            Instance instance = instancesSB.data[i];
+            DrawBound bound = drawsSB.data[instance.draw.x];
+
+            // The radius is scaled by the largest column length of the
+            // linear part, exact for a rotation with scaling.
+            vec4 center = vec4(bound.sphere.xyz, 1.0f);
+            vec3 c = vec3(dot(instance.row[0], center), dot(instance.row[1], center),
+                dot(instance.row[2], center));
+            vec3 col0 = vec3(instance.row[0].x, instance.row[1].x, instance.row[2].x);
+            vec3 col1 = vec3(instance.row[0].y, instance.row[1].y, instance.row[2].y);
+            vec3 col2 = vec3(instance.row[0].z, instance.row[1].z, instance.row[2].z);
+            float scale = sqrt(max(dot(col0, col0), max(dot(col1, col1), dot(col2, col2))));
+            float radius = bound.sphere.w * scale;
+
+            bool isVisible = (scale > 0.0f);
+            for (int p = 0; p < 6 && isVisible; ++p)
+            {
+                isVisible = (dot(planes[p].xyz, c) + planes[p].w >= -radius);
+            }
+#if HIZ_CULLING
+            isVisible = isVisible && !IsOccluded(c, radius);
+#endif
+
+            if (isVisible)
+            {
+                uint k = atomicAdd(countsSB.data[bound.region.y], 1u);
+                uint j = 3u * (bound.region.x + k);
+                visibleSB.data[j] = instance.row[0];
+                visibleSB.data[j + 1u] = instance.row[1];
+                visibleSB.data[j + 2u] = instance.row[2];
+            }
+        }
+    }
+)";
+
+std::string const InstanceCuller::msHLSLResetCountsSource =
+R"(
+    RWStructuredBuffer<uint> counts;
+
+    [numthreads(64, 1, 1)]
+    void CSMain(uint3 t : SV_DispatchThreadID)
+    {
+        if (t.x < NUM_DRAWS)
+        {
+            counts[ARGUMENTS_STRIDE * t.x + 1] = 0;
+        }
+    }
+)";
+
+std::string const InstanceCuller::msHLSLCullSource =
+R"(
+    cbuffer Frustum
+    {
+        float4 planes[6];
+        uint4 numInstances;     // (numInstances, 0, 0, 0)
+        float4x4 pvwMatrix;
+        float4 depthMap;        // window depth = depthMap.x * z + depthMap.y
+    };
+
+    struct Instance
+    {
+        float4 row0, row1, row2;
+        uint4 draw;             // (draw, 0, 0, 0)
+    };
+
+    struct DrawBound
+    {
+        float4 sphere;          // (center, radius)
+        uint4 region;           // (firstInstance, index of instanceCount, 0, 0)
+    };
+
+    StructuredBuffer<Instance> instances;
+    StructuredBuffer<DrawBound> draws;
+    RWStructuredBuffer<float4> visible;
+    RWStructuredBuffer<uint> counts;
+
+#if HIZ_CULLING
+    cbuffer HiZLevels
+    {
+        uint4 levels[HIZ_MAX_LEVELS];   // (offset, width, height, numLevels)
+    };
+
+    StructuredBuffer<float> hiZ;
+
+    bool IsOccluded(float3 center, float radius)
+    {
+        // Compute the texture rectangle and the nearest depth of the cube
+        // that bounds the sphere. In Direct3D the first row of the depth
+        // texture is at the top of the window.
+        float2 tmin = float2(1.0f, 1.0f), tmax = float2(0.0f, 0.0f);
+        float zmin = 1.0f;
+        for (int i = 0; i < 8; ++i)
+        {
+            float3 sign = float3((i & 1) != 0 ? 1.0f : -1.0f, (i & 2) != 0 ? 1.0f : -1.0f,
+                (i & 4) != 0 ? 1.0f : -1.0f);
+            float4 corner = float4(center + radius * sign, 1.0f);
+#if GTE_USE_MAT_VEC
+            float4 clip = mul(pvwMatrix, corner);
+#else
+            float4 clip = mul(corner, pvwMatrix);
+#endif
+            if (clip.w <= 0.0f)
+            {
+                // The cube is not entirely in front of the eye.
+                return false;
+            }
+            float3 ndc = clip.xyz / clip.w;
+            float2 tcoord = float2(0.5f * ndc.x + 0.5f, 0.5f - 0.5f * ndc.y);
+            tmin = min(tmin, tcoord);
+            tmax = max(tmax, tcoord);
+            zmin = min(zmin, depthMap.x * ndc.z + depthMap.y);
+        }
+        tmin = saturate(tmin);
+        tmax = saturate(tmax);
+
+        // Select the level at which the rectangle covers at most 2x2
+        // texels. A texel (x,y) of level 0 is covered by the texel
+        // (x,y)/2^level of a level, or by the last row or column.
+        uint numLevels = levels[0].w;
+        float2 size = (tmax - tmin) * float2(levels[0].yz);
+        uint level = (uint)clamp(ceil(log2(max(max(size.x, size.y), 1.0f))), 0.0f,
+            (float)(numLevels - 1));
+        uint2 r0 = min((uint2)(tmin * float2(levels[0].yz)), levels[0].yz - 1);
+        uint2 r1 = min((uint2)(tmax * float2(levels[0].yz)), levels[0].yz - 1);
+        uint2 t0, t1;
+        for (;;)
+        {
+            t0 = min(r0 >> level, levels[level].yz - 1);
+            t1 = min(r1 >> level, levels[level].yz - 1);
+            if ((t1.x - t0.x <= 1 && t1.y - t0.y <= 1) || level + 1 == numLevels)
+            {
+                break;
+            }
+            ++level;
+        }
+
+        float depth = 0.0f;
+        for (uint y = t0.y; y <= t1.y; ++y)
+        {
+            for (uint x = t0.x; x <= t1.x; ++x)
+            {
+                depth = max(depth, hiZ[levels[level].x + y * levels[level].y + x]);
+            }
+        }
+        return zmin > depth;
+    }
+#endif
+
+    [numthreads(64, 1, 1)]
+    void CSMain(uint3 t : SV_DispatchThreadID)
+    {
+        uint i = t.x;
+        if (i < numInstances.x)
+        {
+            Instance instance = instances[i];
+            DrawBound bound = draws[instance.draw.x];
+
+            // The radius is scaled by the largest column length of the
+            // linear part, exact for a rotation with scaling.
+            float4 center = float4(bound.sphere.xyz, 1.0f);
+            float3 c = float3(dot(instance.row0, center), dot(instance.row1, center),
+                dot(instance.row2, center));
+            float3 col0 = float3(instance.row0.x, instance.row1.x, instance.row2.x);
+            float3 col1 = float3(instance.row0.y, instance.row1.y, instance.row2.y);
+            float3 col2 = float3(instance.row0.z, instance.row1.z, instance.row2.z);
+            float scale = sqrt(max(dot(col0, col0), max(dot(col1, col1), dot(col2, col2))));
+            float radius = bound.sphere.w * scale;
+
+            bool isVisible = (scale > 0.0f);
+            for (int p = 0; p < 6 && isVisible; ++p)
+            {
+                isVisible = (dot(planes[p].xyz, c) + planes[p].w >= -radius);
+            }
+#if HIZ_CULLING
+            isVisible = isVisible && !IsOccluded(c, radius);
+#endif
+
+            if (isVisible)
+            {
+                uint k;
+                InterlockedAdd(counts[bound.region.y], 1, k);
+                uint j = 3 * (bound.region.x + k);
+                visible[j] = instance.row0;
+                visible[j + 1] = instance.row1;
+                visible[j + 2] = instance.row2;
+            }
+        }
+    }
+)";
+
+ProgramSources const InstanceCuller::msResetCountsSource =
+{
+    &msGLSLResetCountsSource,
+    &msHLSLResetCountsSource
+};
+
+ProgramSources const InstanceCuller::msCullSource =
+{
+    &msGLSLCullSource,
+    &msHLSLCullSource
+};
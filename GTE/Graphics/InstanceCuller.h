@@ -0,0 +1,183 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/Camera.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/HiZBuffer.h>
+#include <Graphics/IndirectArgumentsBuffer.h>
+#include <Graphics/InstancedVisual.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/StructuredBuffer.h>
+#include <Mathematics/Transform.h>
+#include <vector>
+
+// GPU-driven culling and drawing of instanced meshes. The meshes ("draws")
+// share the vertex and index buffers of an InstancedVisual, and each draw
+// has a range of the index buffer (of the vertex buffer when the index
+// buffer is not indexed), a model-space bounding sphere and a maximum number
+// of instances. The instance transforms and draw indices are stored in a
+// structured buffer that is read by a compute shader. The shader tests the
+// bounding sphere of each instance against the view frustum and appends the
+// transforms of the visible instances to the region of their draw, counting
+// them in the indirect arguments of the draw. The transforms are copied to
+// the instance buffer of the visual, and the draws are issued by one
+// GraphicsEngine::DrawIndirect call, so the CPU cost does not depend on the
+// number of instances. One culler and visual are used per material.
+//
+// The visual must have been created with GetTransforms() as its instance
+// buffer and an effect compiled with GTE_USE_INSTANCING set to 1 (see
+// InstancedVisual). The instance transforms map the model space of a mesh
+// to the model space of the visual. The bounding sphere of an instance is
+// computed for a rotation with scaling, the Transform<float> of
+// SetInstance. The CPU data of the instance buffer are not the visible
+// transforms, so the model bound of the visual must be set by the
+// application or its culling mode set to CULL_NEVER.
+//
+// When the culler is constructed with a HiZBuffer, the instances in the
+// frustum are also tested against the hierarchical depth buffer, and those
+// behind the depth of the buffer are culled. The screen rectangle and the
+// nearest depth of an instance are those of the cube that bounds its
+// sphere, and the rectangle is tested at the level where it covers at most
+// 2x2 texels. The buffer must be built by HiZBuffer::Execute for the camera
+// passed to Execute or Draw before they are called.
+
+namespace gte
+{
+    class InstanceCuller
+    {
+    public:
+        struct DrawInfo
+        {
+            // The number of indices and the first index when the index
+            // buffer is indexed; otherwise, the number of vertices and the
+            // first vertex, and baseVertex is ignored.
+            uint32_t numElements;
+            uint32_t firstElement;
+            int32_t baseVertex;
+
+            // The model-space bounding sphere of the mesh.
+            Vector3<float> center;
+            float radius;
+
+            // The maximum number of instances of the mesh.
+            uint32_t numInstances;
+        };
+
+        // Construction. The instance transforms are initially the identity.
+        // The hi-Z buffer is optional.
+        InstanceCuller(std::shared_ptr<ProgramFactory> const& factory,
+            std::vector<DrawInfo> const& draws, bool indexed,
+            std::shared_ptr<HiZBuffer> const& hiZ = nullptr);
+
+        // Member access. The instances of a draw are stored in the instance
+        // buffer starting at GetFirstInstance(draw). The arguments are
+        // records of 5 uint32_t (indexed) or 4 uint32_t (not indexed), one
+        // record per draw.
+        inline std::shared_ptr<VertexBuffer> const& GetTransforms() const
+        {
+            return mTransforms;
+        }
+
+        inline std::shared_ptr<StructuredBuffer> const& GetInstances() const
+        {
+            return mInstances;
+        }
+
+        inline std::shared_ptr<IndirectArgumentsBuffer> const& GetArguments() const
+        {
+            return mArguments;
+        }
+
+        inline unsigned int GetNumDraws() const
+        {
+            return mNumDraws;
+        }
+
+        inline unsigned int GetNumInstances() const
+        {
+            return mNumInstances;
+        }
+
+        inline unsigned int GetFirstInstance(unsigned int draw) const
+        {
+            return mFirstInstance[draw];
+        }
+
+        // Set the transform of instance i of a draw. A zero scale hides the
+        // instance. The engine must update GetInstances() after the
+        // transforms change.
+        void SetInstance(unsigned int draw, unsigned int i, Transform<float> const& transform);
+
+        // Cull the instances against the view frustum of the camera, and
+        // against the hi-Z buffer when there is one, and write the transforms and the indirect arguments of the visible
+        // instances.
+        void Execute(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Camera> const& camera, std::shared_ptr<InstancedVisual> const& visual);
+
+        // Execute followed by the indirect draw of the visual.
+        uint64_t Draw(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Camera> const& camera, std::shared_ptr<InstancedVisual> const& visual);
+
+    private:
+        // The layout of the elements of mInstances.
+        struct Instance
+        {
+            Vector4<float> row[3];
+            uint32_t draw, padding[3];
+        };
+
+        // The layout of the elements of mDraws. The region is
+        // (firstInstance, index of instanceCount in the arguments, 0, 0).
+        struct DrawBound
+        {
+            Vector4<float> sphere;
+            uint32_t region[4];
+        };
+
+        // The layout of the constant buffer "Frustum". The planes are in the
+        // model space of the visual with unit-length normals that point into
+        // the frustum. The matrix maps the model space of the visual to clip
+        // space, and the window depth of an NDC depth z is
+        // depthMap[0] * z + depthMap[1]; they are used by the hi-Z test.
+        struct Frustum
+        {
+            Vector4<float> plane[Camera::VF_QUANTITY];
+            uint32_t numInstances[4];
+            Matrix4x4<float> pvwMatrix;
+            Vector4<float> depthMap;
+        };
+
+        unsigned int mNumDraws, mNumInstances, mNumCullGroups;
+        std::vector<unsigned int> mFirstInstance;
+        std::shared_ptr<ConstantBuffer> mFrustum;
+        std::shared_ptr<StructuredBuffer> mInstances;
+        std::shared_ptr<StructuredBuffer> mDraws;
+        std::shared_ptr<HiZBuffer> mHiZ;
+
+        // The visible transforms, 3 rows per instance, and the draw
+        // arguments are written by the shaders and copied to mTransforms and
+        // mArguments.
+        std::shared_ptr<StructuredBuffer> mVisible;
+        std::shared_ptr<StructuredBuffer> mCounts;
+        std::shared_ptr<VertexBuffer> mTransforms;
+        std::shared_ptr<IndirectArgumentsBuffer> mArguments;
+
+        std::shared_ptr<ComputeProgram> mResetCounts;
+        std::shared_ptr<ComputeProgram> mCull;
+
+        // Shader source code as strings.
+        static std::string const msGLSLResetCountsSource;
+        static std::string const msGLSLCullSource;
+        static std::string const msHLSLResetCountsSource;
+        static std::string const msHLSLCullSource;
+        static ProgramSources const msResetCountsSource;
+        static ProgramSources const msCullSource;
+    };
+}
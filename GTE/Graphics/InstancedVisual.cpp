@@ -0,0 +1,139 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/InstancedVisual.h>
+#include <Mathematics/Logger.h>
+using namespace gte;
+
+InstancedVisual::InstancedVisual(
+    std::shared_ptr<VertexBuffer> const& vbuffer,
+    std::shared_ptr<IndexBuffer> const& ibuffer,
+    std::shared_ptr<VisualEffect> const& effect,
+    std::shared_ptr<VertexBuffer> const& instanceBuffer)
+    :
+    Visual(vbuffer, ibuffer, effect),
+    mInstanceBuffer(instanceBuffer)
+{
+}
+
+VertexFormat InstancedVisual::GetTransformFormat()
+{
+    VertexFormat format;
+    format.Bind(VA_TEXCOORD, DF_R32G32B32A32_FLOAT, 5);
+    format.Bind(VA_TEXCOORD, DF_R32G32B32A32_FLOAT, 6);
+    format.Bind(VA_TEXCOORD, DF_R32G32B32A32_FLOAT, 7);
+    return format;
+}
+
+std::shared_ptr<VertexBuffer> InstancedVisual::CreateTransformBuffer(
+    unsigned int numInstances, bool dynamicUpdate)
+{
+    auto instanceBuffer = std::make_shared<VertexBuffer>(GetTransformFormat(), numInstances);
+    if (dynamicUpdate)
+    {
+        instanceBuffer->SetUsage(Resource::DYNAMIC_UPDATE);
+    }
+
+    // Initialize the instances to the identity transform.
+    Vector4<float>* rows = instanceBuffer->Get<Vector4<float>>();
+    for (unsigned int i = 0; i < numInstances; ++i, rows += 3)
+    {
+        rows[0] = { 1.0f, 0.0f, 0.0f, 0.0f };
+        rows[1] = { 0.0f, 1.0f, 0.0f, 0.0f };
+        rows[2] = { 0.0f, 0.0f, 1.0f, 0.0f };
+    }
+    return instanceBuffer;
+}
+
+void InstancedVisual::SetInstanceTransform(unsigned int i, Transform<float> const& transform)
+{
+    LogAssert(HasTransformFormat(), "The instance buffer must have the transform format.");
+    LogAssert(i < mInstanceBuffer->GetNumElements(), "Invalid instance.");
+
+    // The shaders compute dot products of the rows with (x,y,z,1), the
+    // product of the matrix and the point for the vector-on-the-right
+    // convention. For the vector-on-the-left convention, the rows are the
+    // columns of the homogeneous matrix.
+    Matrix4x4<float> const& hmatrix = transform.GetHMatrix();
+    Vector4<float>* rows = mInstanceBuffer->Get<Vector4<float>>() + 3 * static_cast<size_t>(i);
+    for (int r = 0; r < 3; ++r)
+    {
+#if defined(GTE_USE_MAT_VEC)
+        rows[r] = hmatrix.GetRow(r);
+#else
+        rows[r] = hmatrix.GetCol(r);
+#endif
+    }
+}
+
+bool InstancedVisual::UpdateModelBound()
+{
+    if (!Visual::UpdateModelBound())
+    {
+        return false;
+    }
+
+    if (HasTransformFormat())
+    {
+        unsigned int const numInstances = mInstanceBuffer->GetNumActiveElements();
+        if (numInstances > 0)
+        {
+            BoundingSphere<float> const meshBound = modelBound;
+            Vector4<float> const* rows = mInstanceBuffer->Get<Vector4<float>>() +
+                3 * static_cast<size_t>(mInstanceBuffer->GetOffset());
+            Matrix4x4<float> hmatrix = Matrix4x4<float>::Identity();
+            BoundingSphere<float> instanceBound;
+            for (unsigned int i = 0; i < numInstances; ++i, rows += 3)
+            {
+                for (int r = 0; r < 3; ++r)
+                {
+#if defined(GTE_USE_MAT_VEC)
+                    hmatrix.SetRow(r, rows[r]);
+#else
+                    hmatrix.SetCol(r, rows[r]);
+#endif
+                }
+
+                meshBound.TransformBy(hmatrix, instanceBound);
+                if (i == 0)
+                {
+                    modelBound = instanceBound;
+                }
+                else
+                {
+                    modelBound.GrowToContain(instanceBound);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool InstancedVisual::HasTransformFormat() const
+{
+    if (!mInstanceBuffer)
+    {
+        return false;
+    }
+
+    VertexFormat const& format = mInstanceBuffer->GetFormat();
+    if (format.GetNumAttributes() != 3 || format.GetVertexSize() != 3 * sizeof(Vector4<float>))
+    {
+        return false;
+    }
+
+    for (unsigned int unit = 5; unit <= 7; ++unit)
+    {
+        int const i = format.GetIndex(VA_TEXCOORD, unit);
+        if (i < 0 || format.GetType(i) != DF_R32G32B32A32_FLOAT)
+        {
+            return false;
+        }
+    }
+    return true;
+}
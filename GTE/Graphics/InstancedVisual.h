@@ -0,0 +1,83 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/Visual.h>
+#include <Mathematics/Transform.h>
+
+// A visual that is drawn with hardware instancing. The instance buffer is a
+// vertex buffer whose elements are per-instance data; its attributes follow
+// those of the vertex buffer in the input layout and advance once per
+// instance. The active elements of the instance buffer (see
+// Buffer::SetNumActiveElements and Buffer::SetOffset) are the instances that
+// are drawn, so the number of instances can change without reallocating the
+// buffer.
+//
+// Texture2Effect, AmbientLightEffect, DirectionalLightEffect,
+// PointLightEffect and SpotLightEffect have instanced shaders, compiled when
+// the define GTE_USE_INSTANCING is set to 1 in the program factory,
+//   factory->defines.Set("GTE_USE_INSTANCING", 1);
+// before the effect is created. The instanced shaders use the transform
+// format of CreateTransformBuffer, the rows of the upper 3x4 block of the
+// affine matrix that maps the model space of the mesh to the model space of
+// this visual. The mesh is transformed per instance before the effect's own
+// computations, so the world transform of the visual and the model-space
+// quantities of the effects (light positions and directions, camera
+// position) apply to all instances. The normals are transformed by the
+// same matrix and normalized, which is correct for rotations with uniform
+// scaling.
+
+namespace gte
+{
+    class InstancedVisual : public Visual
+    {
+    public:
+        // Construction and destruction.
+        virtual ~InstancedVisual() = default;
+        InstancedVisual(
+            std::shared_ptr<VertexBuffer> const& vbuffer = std::shared_ptr<VertexBuffer>(),
+            std::shared_ptr<IndexBuffer> const& ibuffer = std::shared_ptr<IndexBuffer>(),
+            std::shared_ptr<VisualEffect> const& effect = std::shared_ptr<VisualEffect>(),
+            std::shared_ptr<VertexBuffer> const& instanceBuffer = std::shared_ptr<VertexBuffer>());
+
+        // Member access.
+        inline void SetInstanceBuffer(std::shared_ptr<VertexBuffer> const& instanceBuffer)
+        {
+            mInstanceBuffer = instanceBuffer;
+        }
+
+        inline std::shared_ptr<VertexBuffer> const& GetInstanceBuffer() const
+        {
+            return mInstanceBuffer;
+        }
+
+        // Support for the instanced shaders of the effects. The format has
+        // three 4-channel float attributes with semantic VA_TEXCOORD and
+        // units 5, 6 and 7. The GLSL locations of the attributes are those
+        // that follow the vertex attributes of the mesh.
+        static VertexFormat GetTransformFormat();
+
+        static std::shared_ptr<VertexBuffer> CreateTransformBuffer(
+            unsigned int numInstances, bool dynamicUpdate = false);
+
+        // Store the transform of instance i in a buffer that has the
+        // transform format. The engine must update the buffer after the
+        // transforms change.
+        void SetInstanceTransform(unsigned int i, Transform<float> const& transform);
+
+        // The model bound contains the mesh for all active instances when
+        // the instance buffer has the transform format; otherwise, it is
+        // the bound of the mesh.
+        virtual bool UpdateModelBound() override;
+
+    protected:
+        bool HasTransformFormat() const;
+
+        std::shared_ptr<VertexBuffer> mInstanceBuffer;
+    };
+}
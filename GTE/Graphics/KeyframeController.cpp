@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/KeyframeController.h>
@@ -22,7 +22,9 @@ KeyframeController::KeyframeController(int numCommonTimes, int numTranslations,
     mTLastIndex(0),
     mRLastIndex(0),
     mSLastIndex(0),
-    mCLastIndex(0)
+    mCLastIndex(0),
+    mLastControlTime(0.0f),
+    mIsCurrent(false)
 {
     if (numCommonTimes > 0)
     {
@@ -82,7 +84,14 @@ bool KeyframeController::Update(double applicationTime)
         return false;
     }
 
+    Spatial* spatial = reinterpret_cast<Spatial*>(mObject);
     float ctrlTime = static_cast<float>(GetControlTime(applicationTime));
+    if (mIsCurrent && ctrlTime == mLastControlTime)
+    {
+        spatial->localTransform = mLocalTransform;
+        return true;
+    }
+
     float normTime = 0.0f;
     int i0 = 0, i1 = 0;
     Vector4<float> trn;
@@ -141,7 +150,9 @@ bool KeyframeController::Update(double applicationTime)
         }
     }
 
-    Spatial* spatial = reinterpret_cast<Spatial*>(mObject);
+    mLastControlTime = ctrlTime;
+    mIsCurrent = true;
+    ++mVersion;
     spatial->localTransform = mLocalTransform;
     return true;
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -91,8 +91,17 @@ namespace gte
         }
 
         // The animation update.  The application time is in milliseconds.
+        // The keys are not evaluated when the control time is the same as
+        // that of the previous update.
         virtual bool Update(double applicationTime) override;
 
+        // If you modify the keys after an update, call this so that the
+        // next update evaluates them even when the time has not changed.
+        inline void InvalidateCache()
+        {
+            mIsCurrent = false;
+        }
+
     protected:
         // Support for looking up keyframes given the specified time.
         static void GetKeyInfo(float ctrlTime, int numTimes, float* times,
@@ -123,5 +132,9 @@ namespace gte
         // interpolation.  For a sequence of times, this guarantees an
         // O(1) lookup.
         int mTLastIndex, mRLastIndex, mSLastIndex, mCLastIndex;
+
+        // The control time of the last evaluation.
+        float mLastControlTime;
+        bool mIsCurrent;
     };
 }
@@ -0,0 +1,429 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/MeshFileIO.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#if defined(GTE_USE_MSWINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace gte;
+
+namespace
+{
+    char const gsMagic[8] = { 'G', 'T', 'E', 'M', 'E', 'S', 'H', '\0' };
+
+    static_assert(sizeof(MeshFileIO::Header) == 80, "Unexpected header size.");
+    static_assert(sizeof(MeshFileIO::Attribute) == 16, "Unexpected attribute size.");
+
+    uint64_t AlignSection(uint64_t offset)
+    {
+        uint64_t const mask = MeshFileIO::SECTION_ALIGNMENT - 1;
+        return (offset + mask) & ~mask;
+    }
+
+    // A file mapped into memory copy-on-write, so the buffers that use the
+    // mapping as their data may modify it.
+    class MappedFile
+    {
+    public:
+        MappedFile(std::string const& filename)
+            :
+            mData(nullptr),
+            mSize(0)
+#if defined(GTE_USE_MSWINDOWS)
+            ,
+            mFileHandle(nullptr),
+            mMappingHandle(nullptr)
+#endif
+        {
+#if defined(GTE_USE_MSWINDOWS)
+            HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                LogWarning("Cannot open " + filename + ".");
+                return;
+            }
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+            {
+                LogWarning("The file " + filename + " is empty.");
+                CloseHandle(file);
+                return;
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (!mapping)
+            {
+                LogWarning("Cannot map " + filename + ".");
+                CloseHandle(file);
+                return;
+            }
+
+            void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            if (!data)
+            {
+                LogWarning("Cannot map " + filename + ".");
+                CloseHandle(mapping);
+                CloseHandle(file);
+                return;
+            }
+
+            mFileHandle = file;
+            mMappingHandle = mapping;
+            mData = static_cast<char*>(data);
+            mSize = static_cast<size_t>(size.QuadPart);
+#else
+            int file = open(filename.c_str(), O_RDONLY);
+            if (file < 0)
+            {
+                LogWarning("Cannot open " + filename + ".");
+                return;
+            }
+
+            struct stat info;
+            if (fstat(file, &info) != 0 || info.st_size == 0)
+            {
+                LogWarning("The file " + filename + " is empty.");
+                close(file);
+                return;
+            }
+
+            // The mapping remains valid after the file is closed.
+            size_t const size = static_cast<size_t>(info.st_size);
+            void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            close(file);
+            if (data == MAP_FAILED)
+            {
+                LogWarning("Cannot map " + filename + ".");
+                return;
+            }
+
+            mData = static_cast<char*>(data);
+            mSize = size;
+#endif
+        }
+
+        ~MappedFile()
+        {
+            if (mData)
+            {
+#if defined(GTE_USE_MSWINDOWS)
+                UnmapViewOfFile(mData);
+                CloseHandle(static_cast<HANDLE>(mMappingHandle));
+                CloseHandle(static_cast<HANDLE>(mFileHandle));
+#else
+                munmap(mData, mSize);
+#endif
+            }
+        }
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        inline char* GetData() const
+        {
+            return mData;
+        }
+
+        inline size_t GetSize() const
+        {
+            return mSize;
+        }
+
+    private:
+        char* mData;
+        size_t mSize;
+#if defined(GTE_USE_MSWINDOWS)
+        void* mFileHandle;
+        void* mMappingHandle;
+#endif
+    };
+
+    // Buffers whose data are in a mapped file. They have the types of the
+    // base classes, so the graphics engines treat them as ordinary buffers.
+    class MappedVertexBuffer : public VertexBuffer
+    {
+    public:
+        MappedVertexBuffer(VertexFormat const& vformat, unsigned int numVertices,
+            std::shared_ptr<MappedFile> const& file, uint64_t offset)
+            :
+            VertexBuffer(vformat, numVertices, false),
+            mFile(file)
+        {
+            SetData(mFile->GetData() + offset);
+        }
+
+    private:
+        std::shared_ptr<MappedFile> mFile;
+    };
+
+    class MappedIndexBuffer : public IndexBuffer
+    {
+    public:
+        MappedIndexBuffer(IPType type, uint32_t numPrimitives, size_t indexSize,
+            std::shared_ptr<MappedFile> const& file, uint64_t offset)
+            :
+            IndexBuffer(type, numPrimitives, indexSize, false),
+            mFile(file)
+        {
+            SetData(mFile->GetData() + offset);
+        }
+
+    private:
+        std::shared_ptr<MappedFile> mFile;
+    };
+
+    // Validate the header and the attributes against the file size and
+    // create the vertex format.
+    bool GetFormat(std::string const& filename, char const* data, uint64_t size,
+        MeshFileIO::Header& header, VertexFormat& vformat)
+    {
+        if (size < sizeof(header))
+        {
+            LogWarning("The file " + filename + " is too small.");
+            return false;
+        }
+
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, gsMagic, sizeof(gsMagic)) != 0)
+        {
+            LogWarning("The file " + filename + " is not a mesh file.");
+            return false;
+        }
+
+        if (header.version != MeshFileIO::VERSION)
+        {
+            LogWarning("The mesh file " + filename + " has unsupported version " +
+                std::to_string(header.version) + ".");
+            return false;
+        }
+
+        uint64_t const attributesEnd = sizeof(header) +
+            static_cast<uint64_t>(header.numAttributes) * sizeof(MeshFileIO::Attribute);
+        uint32_t const type = header.primitiveType;
+        bool const valid =
+            header.numAttributes > 0 &&
+            header.numAttributes <= VA_MAX_ATTRIBUTES &&
+            header.numVertices > 0 &&
+            header.numPrimitives > 0 &&
+            type != 0 && (type & (type - 1)) == 0 && type <= IP_TRISTRIP_ADJ &&
+            (header.indexSize == 0 || header.indexSize == 2 || header.indexSize == 4) &&
+            header.vertexOffset >= attributesEnd &&
+            header.vertexOffset % MeshFileIO::SECTION_ALIGNMENT == 0 &&
+            header.vertexBytes == static_cast<uint64_t>(header.numVertices) * header.vertexSize &&
+            header.vertexBytes <= size && header.vertexOffset <= size - header.vertexBytes &&
+            header.indexBytes == static_cast<uint64_t>(header.numIndices) * header.indexSize &&
+            (header.indexBytes == 0 || (
+                header.indexOffset >= header.vertexOffset + header.vertexBytes &&
+                header.indexOffset % MeshFileIO::SECTION_ALIGNMENT == 0 &&
+                header.indexBytes <= size && header.indexOffset <= size - header.indexBytes));
+        if (!valid)
+        {
+            LogWarning("The mesh file " + filename + " has an invalid header.");
+            return false;
+        }
+
+        for (uint32_t i = 0; i < header.numAttributes; ++i)
+        {
+            MeshFileIO::Attribute attribute;
+            std::memcpy(&attribute, data + sizeof(header) + i * sizeof(attribute),
+                sizeof(attribute));
+
+            bool const validUnit =
+                (attribute.semantic == VA_COLOR ? attribute.unit < VA_MAX_COLOR_UNITS :
+                (attribute.semantic == VA_TEXCOORD ? attribute.unit < VA_MAX_TCOORD_UNITS :
+                attribute.unit == 0));
+            if (attribute.semantic == VA_NO_SEMANTIC || attribute.semantic >= VA_NUM_SEMANTICS ||
+                attribute.type == DF_UNKNOWN || attribute.type >= DF_NUM_FORMATS ||
+                DataFormat::IsCompressed(static_cast<DFType>(attribute.type)) || !validUnit ||
+                attribute.offset != vformat.GetVertexSize())
+            {
+                LogWarning("The mesh file " + filename + " has an invalid attribute.");
+                return false;
+            }
+
+            vformat.Bind(static_cast<VASemantic>(attribute.semantic),
+                static_cast<DFType>(attribute.type), attribute.unit);
+        }
+
+        if (vformat.GetVertexSize() != header.vertexSize)
+        {
+            LogWarning("The mesh file " + filename + " has an invalid vertex size.");
+            return false;
+        }
+        return true;
+    }
+}
+
+bool MeshFileIO::Save(std::string const& filename, VertexBuffer const& vbuffer,
+    IndexBuffer const& ibuffer)
+{
+    VertexFormat const& vformat = vbuffer.GetFormat();
+    if (!vbuffer.StandardUsage() || !vbuffer.GetData() || vformat.GetNumAttributes() == 0)
+    {
+        LogWarning("The vertex buffer must have a vertex format and data.");
+        return false;
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, gsMagic, sizeof(gsMagic));
+    header.version = VERSION;
+    header.numAttributes = static_cast<uint32_t>(vformat.GetNumAttributes());
+    header.numVertices = vbuffer.GetNumElements();
+    header.vertexSize = vformat.GetVertexSize();
+    header.primitiveType = static_cast<uint32_t>(ibuffer.GetPrimitiveType());
+    header.numPrimitives = ibuffer.GetNumPrimitives();
+    header.numIndices = ibuffer.GetNumElements();
+    header.indexSize = (ibuffer.GetData() ? static_cast<uint32_t>(ibuffer.GetElementSize()) : 0);
+    header.vertexOffset = AlignSection(sizeof(header) + header.numAttributes * sizeof(Attribute));
+    header.vertexBytes = static_cast<uint64_t>(header.numVertices) * header.vertexSize;
+    header.indexOffset = (header.indexSize > 0 ?
+        AlignSection(header.vertexOffset + header.vertexBytes) : 0);
+    header.indexBytes = static_cast<uint64_t>(header.numIndices) * header.indexSize;
+
+    std::vector<Attribute> attributes(header.numAttributes);
+    for (uint32_t i = 0; i < header.numAttributes; ++i)
+    {
+        VASemantic semantic;
+        DFType type;
+        unsigned int unit, offset;
+        vformat.GetAttribute(static_cast<int>(i), semantic, type, unit, offset);
+        attributes[i].semantic = static_cast<uint32_t>(semantic);
+        attributes[i].type = static_cast<uint32_t>(type);
+        attributes[i].unit = unit;
+        attributes[i].offset = offset;
+    }
+
+    std::ofstream output(filename, std::ios::out | std::ios::binary);
+    if (!output)
+    {
+        LogWarning("Cannot open " + filename + ".");
+        return false;
+    }
+
+    char const padding[SECTION_ALIGNMENT] = {};
+    uint64_t const attributesEnd = sizeof(header) + attributes.size() * sizeof(Attribute);
+    output.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    output.write(reinterpret_cast<char const*>(attributes.data()),
+        attributes.size() * sizeof(Attribute));
+    output.write(padding, static_cast<std::streamsize>(header.vertexOffset - attributesEnd));
+    output.write(vbuffer.GetData(), static_cast<std::streamsize>(header.vertexBytes));
+    if (header.indexBytes > 0)
+    {
+        output.write(padding, static_cast<std::streamsize>(header.indexOffset -
+            (header.vertexOffset + header.vertexBytes)));
+        output.write(ibuffer.GetData(), static_cast<std::streamsize>(header.indexBytes));
+    }
+    return !output.fail();
+}
+
+bool MeshFileIO::Load(std::string const& filename, std::shared_ptr<VertexBuffer>& vbuffer,
+    std::shared_ptr<IndexBuffer>& ibuffer, bool memoryMap)
+{
+    vbuffer = nullptr;
+    ibuffer = nullptr;
+
+    Header header;
+    VertexFormat vformat;
+    if (memoryMap)
+    {
+        auto file = std::make_shared<MappedFile>(filename);
+        if (!file->GetData() ||
+            !GetFormat(filename, file->GetData(), file->GetSize(), header, vformat))
+        {
+            return false;
+        }
+
+        IPType const type = static_cast<IPType>(header.primitiveType);
+        if (header.indexSize > 0)
+        {
+            ibuffer = std::make_shared<MappedIndexBuffer>(type, header.numPrimitives,
+                header.indexSize, file, header.indexOffset);
+        }
+        else
+        {
+            ibuffer = std::make_shared<IndexBuffer>(type, header.numPrimitives);
+        }
+        if (ibuffer->GetNumElements() != header.numIndices)
+        {
+            LogWarning("The mesh file " + filename + " has an invalid number of indices.");
+            ibuffer = nullptr;
+            return false;
+        }
+
+        vbuffer = std::make_shared<MappedVertexBuffer>(vformat, header.numVertices,
+            file, header.vertexOffset);
+        return true;
+    }
+
+    std::ifstream input(filename, std::ios::in | std::ios::binary);
+    if (!input)
+    {
+        LogWarning("Cannot open " + filename + ".");
+        return false;
+    }
+
+    // Only the header and the attributes are needed to validate the
+    // layout, so they are read first and the sections are read directly
+    // into the buffers.
+    input.seekg(0, std::ios::end);
+    uint64_t const size = static_cast<uint64_t>(input.tellg());
+    input.seekg(0, std::ios::beg);
+    size_t const maxPrefix = sizeof(Header) + VA_MAX_ATTRIBUTES * sizeof(Attribute);
+    std::vector<char> prefix(static_cast<size_t>(std::min<uint64_t>(size, maxPrefix)));
+    input.read(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+    if (input.fail() || !GetFormat(filename, prefix.data(), size, header, vformat))
+    {
+        return false;
+    }
+
+    IPType const type = static_cast<IPType>(header.primitiveType);
+    if (header.indexSize > 0)
+    {
+        ibuffer = std::make_shared<IndexBuffer>(type, header.numPrimitives, header.indexSize);
+    }
+    else
+    {
+        ibuffer = std::make_shared<IndexBuffer>(type, header.numPrimitives);
+    }
+    if (ibuffer->GetNumElements() != header.numIndices)
+    {
+        LogWarning("The mesh file " + filename + " has an invalid number of indices.");
+        ibuffer = nullptr;
+        return false;
+    }
+
+    vbuffer = std::make_shared<VertexBuffer>(vformat, header.numVertices);
+    input.seekg(static_cast<std::streamoff>(header.vertexOffset), std::ios::beg);
+    input.read(vbuffer->GetData(), static_cast<std::streamsize>(header.vertexBytes));
+    if (header.indexBytes > 0)
+    {
+        input.seekg(static_cast<std::streamoff>(header.indexOffset), std::ios::beg);
+        input.read(ibuffer->GetData(), static_cast<std::streamsize>(header.indexBytes));
+    }
+    if (input.fail())
+    {
+        LogWarning("Cannot read " + filename + ".");
+        vbuffer = nullptr;
+        ibuffer = nullptr;
+        return false;
+    }
+    return true;
+}
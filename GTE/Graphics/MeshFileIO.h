@@ -0,0 +1,91 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/IndexBuffer.h>
+#include <Graphics/VertexBuffer.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// A binary mesh file whose vertex and index sections have the layouts of
+// the data of VertexBuffer and IndexBuffer, so that a memory-mapped file
+// is used as the data of the buffers without reading or copying. The
+// values are little endian. The file layout is
+//
+//   Header header;                       // 80 bytes
+//   Attribute attributes[numAttributes]; // 16 bytes each
+//   <padding to a multiple of 16 bytes>
+//   char vertices[vertexBytes];          // at vertexOffset
+//   <padding to a multiple of 16 bytes>
+//   char indices[indexBytes];            // at indexOffset
+//
+// The vertex format is packed in the order of the attributes, which is the
+// format created by VertexFormat::Bind. The attribute semantic is a
+// VASemantic and the type is a DFType. The primitive type is an IPType.
+// The index size is 2 or 4, or it is 0 for a mesh without indices, in
+// which case the index section is empty and the index buffer is created
+// by the IndexBuffer constructor that has no index data.
+//
+// Load maps the file into memory copy-on-write and creates buffers whose
+// data point into the mapping; the buffers keep the mapping alive, so it
+// is unmapped when the last of the two buffers is destroyed. Modifying the
+// buffer data changes only the pages of this process, not the file. When
+// memoryMap is false, Load reads the sections into buffers with their own
+// storage instead. If the load is not successful, the function returns
+// false and the buffers are set to null.
+
+namespace gte
+{
+    class MeshFileIO
+    {
+    public:
+        static uint32_t constexpr VERSION = 1;
+
+        // The vertex buffer must have been created by the constructor for
+        // standard usage and have system memory data. The index buffer may
+        // be one without indices.
+        static bool Save(std::string const& filename,
+            VertexBuffer const& vbuffer, IndexBuffer const& ibuffer);
+
+        static bool Load(std::string const& filename,
+            std::shared_ptr<VertexBuffer>& vbuffer,
+            std::shared_ptr<IndexBuffer>& ibuffer,
+            bool memoryMap = true);
+
+        // The file header. The offsets are multiples of 16 bytes from the
+        // beginning of the file.
+        struct Header
+        {
+            char magic[8];  // "GTEMESH" and a null terminator
+            uint32_t version;
+            uint32_t numAttributes;
+            uint32_t numVertices;
+            uint32_t vertexSize;
+            uint32_t primitiveType;
+            uint32_t numPrimitives;
+            uint32_t numIndices;
+            uint32_t indexSize;
+            uint32_t reserved[2];
+            uint64_t vertexOffset;
+            uint64_t vertexBytes;
+            uint64_t indexOffset;
+            uint64_t indexBytes;
+        };
+
+        struct Attribute
+        {
+            uint32_t semantic;
+            uint32_t type;
+            uint32_t unit;
+            uint32_t offset;
+        };
+
+        static size_t constexpr SECTION_ALIGNMENT = 16;
+    };
+}
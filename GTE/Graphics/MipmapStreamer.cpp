@@ -0,0 +1,274 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/MipmapStreamer.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+using namespace gte;
+
+MipmapStreamer::~MipmapStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+    mWorker.join();
+}
+
+MipmapStreamer::MipmapStreamer(std::shared_ptr<GraphicsEngine> const& engine, size_t budget)
+    :
+    mEngine(engine),
+    mBudget(budget),
+    mResidentBytes(0),
+    mFrame(0),
+    mStop(false)
+{
+    LogAssert(mEngine != nullptr, "Invalid input.");
+    mWorker = std::thread(&MipmapStreamer::WorkerThread, this);
+}
+
+bool MipmapStreamer::Insert(std::shared_ptr<TextureSingle> const& texture,
+    Loader const& loader, unsigned int coarseLevel)
+{
+    LogAssert(texture != nullptr && loader != nullptr, "Invalid input.");
+    LogAssert(texture->HasMipmaps() && texture->GetData() != nullptr,
+        "The texture must have mipmaps and CPU storage.");
+    LogAssert(coarseLevel < texture->GetNumLevels(), "Invalid level.");
+    LogAssert(mEntries.find(texture.get()) == mEntries.end(), "The texture is already streamed.");
+
+    for (unsigned int level = texture->GetNumLevels(); level > coarseLevel; --level)
+    {
+        if (!loader(*texture, level - 1))
+        {
+            return false;
+        }
+    }
+
+    texture->SetPartiallyResident(true);
+    texture->SetMinResidentLevel(coarseLevel);
+    mEngine->UpdateResidency(texture);
+
+    Entry entry;
+    entry.texture = texture;
+    entry.loader = loader;
+    entry.coarseLevel = coarseLevel;
+    entry.loadedLevel = coarseLevel;
+    entry.requestedLevel = coarseLevel;
+    entry.requestFrame = mFrame;
+    entry.loading = false;
+    entry.failed = false;
+    mEntries.insert(std::make_pair(texture.get(), entry));
+    return true;
+}
+
+void MipmapStreamer::Remove(std::shared_ptr<TextureSingle> const& texture)
+{
+    auto iter = mEntries.find(texture.get());
+    if (iter != mEntries.end())
+    {
+        mResidentBytes -= GetStreamedBytes(iter->second, texture->GetMinResidentLevel());
+        mEntries.erase(iter);
+    }
+}
+
+void MipmapStreamer::Request(std::shared_ptr<TextureSingle> const& texture, float level)
+{
+    auto iter = mEntries.find(texture.get());
+    LogAssert(iter != mEntries.end(), "The texture is not streamed.");
+
+    Entry& entry = iter->second;
+    unsigned int const requested = (level > 0.0f ?
+        std::min(static_cast<unsigned int>(level), entry.coarseLevel) : 0);
+    entry.requestedLevel = std::min(entry.requestedLevel, requested);
+    entry.requestFrame = mFrame;
+}
+
+float MipmapStreamer::ComputeLevel(TextureSingle const& texture, float numPixels)
+{
+    float const maxLevel = static_cast<float>(texture.GetNumLevels() - 1);
+    if (numPixels <= 0.0f)
+    {
+        return maxLevel;
+    }
+
+    float const size = static_cast<float>(std::max(texture.GetDimension(0),
+        texture.GetDimension(1)));
+    float const level = std::log2(size / numPixels);
+    return std::min(std::max(level, 0.0f), maxLevel);
+}
+
+size_t MipmapStreamer::Update(size_t maxBytes)
+{
+    // Collect the finished loads. A load that finished after its texture
+    // was removed is ignored.
+    std::deque<Load> finished;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        finished.swap(mFinishedLoads);
+    }
+    for (auto const& load : finished)
+    {
+        auto iter = mEntries.find(load.texture.get());
+        if (iter != mEntries.end() && iter->second.loading
+            && load.level + 1 == iter->second.loadedLevel)
+        {
+            Entry& entry = iter->second;
+            entry.loading = false;
+            if (load.loaded)
+            {
+                entry.loadedLevel = load.level;
+            }
+            else
+            {
+                LogWarning("Failed to load a texture level.");
+                entry.failed = true;
+            }
+        }
+    }
+
+    // Partition the textures into those that request finer levels and
+    // those whose resident levels are finer than requested.
+    std::vector<Entry*> finer, coarser;
+    size_t numNeededBytes = 0;
+    for (auto& element : mEntries)
+    {
+        Entry& entry = element.second;
+        unsigned int const resident = entry.texture->GetMinResidentLevel();
+        if (entry.requestedLevel < resident)
+        {
+            finer.push_back(&entry);
+            numNeededBytes += entry.texture->GetNumBytesFor(resident - 1);
+        }
+        else if (entry.requestedLevel > resident)
+        {
+            coarser.push_back(&entry);
+        }
+    }
+
+    // Evict the levels that are not requested, those of the textures that
+    // were requested least recently first, until the next levels fit in
+    // the budget.
+    std::sort(coarser.begin(), coarser.end(),
+        [](Entry const* entry0, Entry const* entry1)
+        {
+            return entry0->requestFrame < entry1->requestFrame;
+        });
+    for (auto entry : coarser)
+    {
+        if (mResidentBytes + numNeededBytes <= mBudget)
+        {
+            break;
+        }
+        SetResidentLevel(*entry, entry->requestedLevel);
+    }
+
+    // Make the next levels resident, those of the textures that miss the
+    // most levels first, and queue the loads of the levels that follow.
+    std::sort(finer.begin(), finer.end(),
+        [](Entry const* entry0, Entry const* entry1)
+        {
+            return entry0->texture->GetMinResidentLevel() - entry0->requestedLevel
+                > entry1->texture->GetMinResidentLevel() - entry1->requestedLevel;
+        });
+    size_t numBytes = 0;
+    bool queued = false;
+    for (auto entry : finer)
+    {
+        unsigned int const level = entry->texture->GetMinResidentLevel() - 1;
+        if (entry->loadedLevel <= level)
+        {
+            size_t const levelBytes = entry->texture->GetNumBytesFor(level);
+            if ((numBytes == 0 || numBytes + levelBytes <= maxBytes)
+                && mResidentBytes + levelBytes <= mBudget)
+            {
+                SetResidentLevel(*entry, level);
+                numBytes += levelBytes;
+            }
+        }
+
+        if (!entry->loading && !entry->failed && entry->loadedLevel > entry->requestedLevel)
+        {
+            entry->loading = true;
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueuedLoads.push_back({ entry->texture, entry->loader,
+                entry->loadedLevel - 1, false });
+            queued = true;
+        }
+    }
+    if (queued)
+    {
+        mCondition.notify_one();
+    }
+
+    // The requests are for one frame.
+    for (auto& element : mEntries)
+    {
+        element.second.requestedLevel = element.second.coarseLevel;
+    }
+    ++mFrame;
+    return numBytes;
+}
+
+size_t MipmapStreamer::GetNumPendingLoads() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueuedLoads.size() + mFinishedLoads.size();
+}
+
+size_t MipmapStreamer::GetStreamedBytes(Entry const& entry, unsigned int residentLevel)
+{
+    size_t numBytes = 0;
+    for (unsigned int level = residentLevel; level < entry.coarseLevel; ++level)
+    {
+        numBytes += entry.texture->GetNumBytesFor(level);
+    }
+    return numBytes;
+}
+
+void MipmapStreamer::SetResidentLevel(Entry& entry, unsigned int level)
+{
+    mResidentBytes -= GetStreamedBytes(entry, entry.texture->GetMinResidentLevel());
+    entry.texture->SetMinResidentLevel(level);
+    mEngine->UpdateResidency(entry.texture);
+    mResidentBytes += GetStreamedBytes(entry, level);
+}
+
+void MipmapStreamer::WorkerThread()
+{
+    for (;;)
+    {
+        Load load;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStop || mQueuedLoads.size() > 0; });
+            if (mStop)
+            {
+                return;
+            }
+            load = std::move(mQueuedLoads.front());
+            mQueuedLoads.pop_front();
+        }
+
+        // LogError and LogAssert throw, so a failed loader is reported as
+        // an unsuccessful load.
+        try
+        {
+            load.loaded = load.loader(*load.texture, load.level);
+        }
+        catch (std::exception const&)
+        {
+            load.loaded = false;
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFinishedLoads.push_back(std::move(load));
+    }
+}
@@ -0,0 +1,134 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/TextureSingle.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// Streaming of the mipmap levels of a set of textures whose total size is
+// larger than the GPU memory. A texture is inserted with its coarse levels
+// loaded, so it can be drawn immediately. Each frame the application
+// reports the level at which each visible texture is sampled, for example
+// from the screen-space size of the textured objects (see ComputeLevel),
+// and Update streams the finer levels of the requested textures, one level
+// at a time from coarse to fine. A worker thread calls the loaders of the
+// levels, which fill the CPU data of the textures, for example by reading
+// the levels from files, and Update makes the loaded levels resident (see
+// TextureSingle::SetMinResidentLevel). When the resident levels exceed the
+// budget, the fine levels of the textures that were requested least
+// recently are evicted; their CPU data remains loaded, so they become
+// resident again without being reloaded.
+//
+// The inserted textures are partially resident, so with OpenGL sparse
+// textures only the resident levels use GPU memory. Otherwise the budget
+// limits the detail that is sampled and not the GPU memory.
+
+namespace gte
+{
+    class MipmapStreamer
+    {
+    public:
+        // A loader fills the CPU data of a level of a texture and returns
+        // 'true' when successful. It is called on the worker thread for the
+        // streamed levels and on the calling thread of Insert for the
+        // coarse levels.
+        typedef std::function<bool(TextureSingle& texture, unsigned int level)> Loader;
+
+        // Construction and destruction. The budget is the maximum number of
+        // bytes of the resident levels of the streamed textures, excluding
+        // their coarse levels, which are always resident.
+        ~MipmapStreamer();
+        MipmapStreamer(std::shared_ptr<GraphicsEngine> const& engine, size_t budget);
+
+        // Insert a texture that is not yet bound, with mipmaps and CPU
+        // storage. The levels coarseLevel through the last are loaded
+        // before the texture is bound. The return value is 'false' when the
+        // loader fails, in which case the texture is not inserted.
+        bool Insert(std::shared_ptr<TextureSingle> const& texture,
+            Loader const& loader, unsigned int coarseLevel);
+
+        // Remove a texture. Its resident levels remain resident.
+        void Remove(std::shared_ptr<TextureSingle> const& texture);
+
+        // Report that the texture is sampled at the specified level in the
+        // current frame. When a texture is requested several times in a
+        // frame, the finest level is used. Textures that are not requested
+        // in a frame request their coarse level.
+        void Request(std::shared_ptr<TextureSingle> const& texture, float level);
+
+        // The level at which a texture is sampled when its larger dimension
+        // covers the specified number of pixels on the screen.
+        static float ComputeLevel(TextureSingle const& texture, float numPixels);
+
+        // Call once per frame on the thread of the engine, after the
+        // requests of the frame. The loaded levels are made resident,
+        // copying at most maxBytes of them to the GPU (but at least one
+        // level), and the loads of the next levels are queued. The return
+        // value is the number of bytes copied.
+        size_t Update(size_t maxBytes);
+
+        // Member access.
+        inline size_t GetBudget() const
+        {
+            return mBudget;
+        }
+
+        inline size_t GetResidentBytes() const
+        {
+            return mResidentBytes;
+        }
+
+        size_t GetNumPendingLoads() const;
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<TextureSingle> texture;
+            Loader loader;
+            unsigned int coarseLevel;
+            unsigned int loadedLevel;
+            unsigned int requestedLevel;
+            uint64_t requestFrame;
+            bool loading;
+            bool failed;
+        };
+
+        struct Load
+        {
+            std::shared_ptr<TextureSingle> texture;
+            Loader loader;
+            unsigned int level;
+            bool loaded;
+        };
+
+        // The bytes of the resident levels finer than the coarse level.
+        static size_t GetStreamedBytes(Entry const& entry, unsigned int residentLevel);
+
+        void SetResidentLevel(Entry& entry, unsigned int level);
+        void WorkerThread();
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        size_t mBudget, mResidentBytes;
+        std::map<TextureSingle const*, Entry> mEntries;
+        uint64_t mFrame;
+
+        // The loads shared with the worker thread.
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<Load> mQueuedLoads, mFinishedLoads;
+        std::thread mWorker;
+        bool mStop;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.26
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -86,6 +86,28 @@ namespace gte
         // the function returns null.
         std::shared_ptr<Spatial> GetChild(int i);
 
+        // Culler::Flatten stores the children of a node in the flattened
+        // hierarchy, so the culling visits them directly instead of calling
+        // GetVisibleSet for the node. A class derived from Node that
+        // overrides GetVisibleSet must override this function to return
+        // 'false', in which case the flattened culling calls GetVisibleSet
+        // for the node when it is visible.
+        inline virtual bool CanFlattenChildren() const
+        {
+            return true;
+        }
+
+        // SceneUpdater::Flatten stores the children of a node in the
+        // flattened hierarchy, and the incremental update computes their
+        // world data directly. A class derived from Node that overrides
+        // UpdateWorldData must override this function to return 'false',
+        // in which case the incremental update calls Update for the node
+        // every time.
+        inline virtual bool CanFlattenUpdate() const
+        {
+            return true;
+        }
+
     protected:
         // Support for geometric updates.
         virtual void UpdateWorldData(double applicationTime) override;
@@ -0,0 +1,325 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/OcclusionCuller.h>
+#include <Graphics/Culler.h>
+#include <Graphics/MeshFactory.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+using namespace gte;
+
+OcclusionCuller::~OcclusionCuller()
+{
+    for (auto const& element : mObjects)
+    {
+        mEngine->DestroyOcclusionQuery(element.second.query);
+    }
+}
+
+OcclusionCuller::OcclusionCuller(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory)
+    :
+    mEngine(engine),
+    mThreshold(0),
+    mInterval(8),
+    mNumInserted(0),
+    mConditionalDraws(false),
+    mFrame(0),
+    mNumDrawn(0),
+    mNumOccluded(0),
+    mNumOutsideFrustum(0),
+    mNumQueries(0)
+{
+    LogAssert(mEngine != nullptr && factory != nullptr, "Invalid input.");
+
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32B32_FLOAT, 0);
+    MeshFactory mf;
+    mf.SetVertexFormat(vformat);
+    mBox = mf.CreateBox(1.0f, 1.0f, 1.0f);
+    mBoxEffect = std::make_shared<ConstantColorEffect>(factory, Vector4<float>{ 0.0f, 0.0f, 0.0f, 0.0f });
+    mBox->SetEffect(mBoxEffect);
+
+    mBoxBlendState = std::make_shared<BlendState>();
+    mBoxBlendState->target[0].mask = 0;
+
+    mBoxDepthStencilState = std::make_shared<DepthStencilState>();
+    mBoxDepthStencilState->writeMask = DepthStencilState::MASK_ZERO;
+
+    // The back faces are drawn so that a box is queried correctly when its
+    // front faces are clipped by the far plane.
+    mBoxRasterizerState = std::make_shared<RasterizerState>();
+    mBoxRasterizerState->cullMode = RasterizerState::CULL_NONE;
+}
+
+void OcclusionCuller::Insert(std::shared_ptr<Visual> const& visual)
+{
+    LogAssert(visual != nullptr, "Invalid input.");
+
+    AlignedBox3<float> box;
+    std::set<DFType> required;
+    required.insert(DF_R32G32B32_FLOAT);
+    required.insert(DF_R32G32B32A32_FLOAT);
+    auto const& vbuffer = visual->GetVertexBuffer();
+    char const* positions = (vbuffer ? vbuffer->GetChannel(VA_POSITION, 0, required) : nullptr);
+    if (positions && vbuffer->GetNumElements() > 0)
+    {
+        unsigned int const numElements = vbuffer->GetNumElements();
+        unsigned int const vertexSize = vbuffer->GetElementSize();
+        for (int j = 0; j < 3; ++j)
+        {
+            box.min[j] = std::numeric_limits<float>::max();
+            box.max[j] = -std::numeric_limits<float>::max();
+        }
+        for (unsigned int i = 0; i < numElements; ++i, positions += vertexSize)
+        {
+            Vector3<float> const& position = *reinterpret_cast<Vector3<float> const*>(positions);
+            for (int j = 0; j < 3; ++j)
+            {
+                box.min[j] = std::min(box.min[j], position[j]);
+                box.max[j] = std::max(box.max[j], position[j]);
+            }
+        }
+    }
+    else
+    {
+        Vector3<float> center = visual->modelBound.GetCenter();
+        float radius = visual->modelBound.GetRadius();
+        for (int j = 0; j < 3; ++j)
+        {
+            box.min[j] = center[j] - radius;
+            box.max[j] = center[j] + radius;
+        }
+    }
+    Insert(visual, box);
+}
+
+void OcclusionCuller::Insert(std::shared_ptr<Visual> const& visual, AlignedBox3<float> const& box)
+{
+    LogAssert(visual != nullptr, "Invalid input.");
+    LogAssert(mObjects.find(visual.get()) == mObjects.end(), "The visual is already inserted.");
+
+    Object object;
+    object.visual = visual;
+    box.GetCenteredForm(object.center, object.extent);
+    object.query = mEngine->CreateOcclusionQuery();
+    object.nextQueryFrame = mFrame + (mNumInserted++ % mInterval);
+    object.visible = true;
+    object.pending = false;
+    mObjects.insert(std::make_pair(visual.get(), object));
+}
+
+void OcclusionCuller::Remove(std::shared_ptr<Visual> const& visual)
+{
+    auto iter = mObjects.find(visual.get());
+    if (iter != mObjects.end())
+    {
+        mEngine->DestroyOcclusionQuery(iter->second.query);
+        mObjects.erase(iter);
+    }
+}
+
+void OcclusionCuller::SetQueryInterval(unsigned int numFrames)
+{
+    LogAssert(numFrames > 0, "Invalid interval.");
+    mInterval = numFrames;
+}
+
+void OcclusionCuller::Draw(std::shared_ptr<Camera> const& camera)
+{
+    LogAssert(camera != nullptr, "Invalid input.");
+
+    ++mFrame;
+    mNumDrawn = 0;
+    mNumOccluded = 0;
+    mNumOutsideFrustum = 0;
+    mNumQueries = 0;
+
+    // Collect the results of the queries issued in earlier frames.
+    for (auto& element : mObjects)
+    {
+        Object& object = element.second;
+        uint64_t numSamples = 0;
+        if (object.pending && mEngine->GetQueryResult(object.query, numSamples))
+        {
+            object.pending = false;
+            bool visible = (numSamples > mThreshold);
+            if (visible && !object.visible)
+            {
+                object.nextQueryFrame = mFrame + mInterval;
+            }
+            object.visible = visible;
+        }
+    }
+
+    // Cull the boxes against the view frustum and sort the remaining
+    // objects front to back by the distances of the box centers along the
+    // view direction. The radius of a box relative to a plane with unit
+    // normal N is sum_i |Dot(N,A[i])| for the box axes A[i] scaled by the
+    // extents.
+    std::array<CullingPlane<float>, Camera::VF_QUANTITY> planes;
+    Culler::GetViewFrustumPlanes(camera, planes);
+    mSorted.clear();
+    for (auto& element : mObjects)
+    {
+        Object& object = element.second;
+        Matrix4x4<float> const& hmatrix = object.visual->worldTransform.GetHMatrix();
+        Vector4<float> center = HLift(object.center, 1.0f);
+        std::array<Vector4<float>, 3> axis;
+#if defined(GTE_USE_MAT_VEC)
+        center = hmatrix * center;
+        for (int i = 0; i < 3; ++i)
+        {
+            axis[i] = hmatrix.GetCol(i) * object.extent[i];
+        }
+#else
+        center = center * hmatrix;
+        for (int i = 0; i < 3; ++i)
+        {
+            axis[i] = hmatrix.GetRow(i) * object.extent[i];
+        }
+#endif
+
+        bool inside = true;
+        bool crossesNear = false;
+        for (int p = 0; p < Camera::VF_QUANTITY && inside; ++p)
+        {
+            Vector4<float> normal = planes[p].GetNormal();
+            float radius = std::fabs(Dot(normal, axis[0])) + std::fabs(Dot(normal, axis[1]))
+                + std::fabs(Dot(normal, axis[2]));
+            float distance = planes[p].DistanceTo(center);
+            inside = (distance >= -radius);
+            if (p == Camera::VF_DMIN)
+            {
+                crossesNear = (distance <= radius);
+            }
+        }
+
+        if (!inside)
+        {
+            // An object that enters the frustum is drawn and its draw is
+            // queried, so it does not appear a frame late.
+            object.visible = true;
+            object.nextQueryFrame = mFrame;
+            ++mNumOutsideFrustum;
+            continue;
+        }
+
+        if (crossesNear)
+        {
+            // The box would be clipped by the near plane, so its query
+            // is not reliable.
+            object.visible = true;
+        }
+
+        float distance = planes[Camera::VF_DMIN].DistanceTo(center);
+        mSorted.push_back(std::make_pair(distance, &object));
+    }
+    std::sort(mSorted.begin(), mSorted.end(),
+        [](std::pair<float, Object*> const& item0, std::pair<float, Object*> const& item1)
+        {
+            return item0.first < item1.first;
+        });
+
+    // Draw the visible objects. The draw of an object is queried when its
+    // interval has elapsed.
+    mOccluded.clear();
+    for (auto const& item : mSorted)
+    {
+        Object& object = *item.second;
+        if (object.visible)
+        {
+            if (!object.pending && mFrame >= object.nextQueryFrame)
+            {
+                mEngine->BeginQuery(object.query);
+                mEngine->Draw(object.visual);
+                mEngine->EndQuery(object.query);
+                object.pending = true;
+                object.nextQueryFrame = mFrame + mInterval;
+                ++mNumQueries;
+            }
+            else
+            {
+                mEngine->Draw(object.visual);
+            }
+            ++mNumDrawn;
+        }
+        else
+        {
+            mOccluded.push_back(&object);
+        }
+    }
+    mNumOccluded = static_cast<unsigned int>(mOccluded.size());
+    if (mOccluded.size() == 0)
+    {
+        return;
+    }
+
+    // Query the boxes of the occluded objects against the depth buffer of
+    // the visible objects. An object whose query is pending keeps it.
+    Matrix4x4<float> pvMatrix = camera->GetProjectionViewMatrix();
+    std::shared_ptr<BlendState> saveBlendState = mEngine->GetBlendState();
+    std::shared_ptr<DepthStencilState> saveDepthStencilState = mEngine->GetDepthStencilState();
+    std::shared_ptr<RasterizerState> saveRasterizerState = mEngine->GetRasterizerState();
+    mEngine->SetBlendState(mBoxBlendState);
+    mEngine->SetDepthStencilState(mBoxDepthStencilState);
+    mEngine->SetRasterizerState(mBoxRasterizerState);
+    for (auto object : mOccluded)
+    {
+        if (!object->pending)
+        {
+            QueryBox(*object, pvMatrix);
+        }
+    }
+    mEngine->SetBlendState(saveBlendState);
+    mEngine->SetDepthStencilState(saveDepthStencilState);
+    mEngine->SetRasterizerState(saveRasterizerState);
+
+    if (mConditionalDraws)
+    {
+        for (auto object : mOccluded)
+        {
+            mEngine->BeginConditionalDraw(object->query);
+            mEngine->Draw(object->visual);
+            mEngine->EndConditionalDraw();
+        }
+    }
+}
+
+void OcclusionCuller::QueryBox(Object& object, Matrix4x4<float> const& pvMatrix)
+{
+    // The matrix maps the cube [-1,1]^3 to the model-space box.
+    Matrix4x4<float> boxMatrix = Matrix4x4<float>::Identity();
+    for (int i = 0; i < 3; ++i)
+    {
+        boxMatrix(i, i) = object.extent[i];
+#if defined(GTE_USE_MAT_VEC)
+        boxMatrix(i, 3) = object.center[i];
+#else
+        boxMatrix(3, i) = object.center[i];
+#endif
+    }
+
+    Matrix4x4<float> const& wMatrix = object.visual->worldTransform.GetHMatrix();
+#if defined(GTE_USE_MAT_VEC)
+    mBoxEffect->SetPVWMatrix(pvMatrix * wMatrix * boxMatrix);
+#else
+    mBoxEffect->SetPVWMatrix(boxMatrix * wMatrix * pvMatrix);
+#endif
+    mEngine->Update(mBoxEffect->GetPVWMatrixConstant());
+
+    mEngine->BeginQuery(object.query);
+    mEngine->Draw(mBox);
+    mEngine->EndQuery(object.query);
+    object.pending = true;
+    ++mNumQueries;
+}
@@ -0,0 +1,157 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/Camera.h>
+#include <Graphics/ConstantColorEffect.h>
+#include <Graphics/ProgramFactory.h>
+#include <Mathematics/AlignedBox.h>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+// Occlusion culling of visuals with asynchronous occlusion queries whose
+// results are used in later frames, so the CPU never waits for the GPU, in
+// the style of coherent hierarchical culling (CHC++) applied to a list of
+// visuals. Each frame the visuals in the view frustum are drawn front to
+// back when they were visible in the last frame for which a query result is
+// available. The draw of a visible visual is itself the query of its
+// visibility, issued only every few frames. After the visible visuals, the
+// bounding boxes of the occluded visuals are queried against the depth
+// buffer without writing color or depth, and a visual whose box passes
+// becomes visible when the result arrives, typically in the next frame. The
+// box is the model-space bounding box of the visual transformed by its world
+// transform. Visuals whose boxes intersect the near plane are always drawn.
+//
+// An occluded visual that becomes visible appears a frame late. With
+// conditional drawing enabled, occluded visuals are also drawn
+// conditionally on their box queries, so the GPU discards them unless their
+// boxes passed; they then appear without delay at the cost of submitting
+// their draws.
+//
+// The application updates the world transforms, world bounds and
+// projection-view-world matrices of the visuals as usual (for example,
+// with PVWUpdater) before calling Draw, and draws the visuals that are not
+// inserted, such as semitransparent objects, after Draw.
+
+namespace gte
+{
+    class OcclusionCuller
+    {
+    public:
+        // Construction and destruction.
+        ~OcclusionCuller();
+        OcclusionCuller(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory);
+
+        // Insert a visual with the bounding box of the positions of its
+        // vertex buffer, or with the bounding sphere of its model bound when
+        // the vertex buffer has no positions in CPU memory. A visual is
+        // initially visible.
+        void Insert(std::shared_ptr<Visual> const& visual);
+
+        // Insert a visual with the specified model-space bounding box.
+        void Insert(std::shared_ptr<Visual> const& visual, AlignedBox3<float> const& box);
+
+        void Remove(std::shared_ptr<Visual> const& visual);
+
+        // A visual is visible when its query counts more samples than the
+        // threshold. The default value is 0.
+        inline void SetVisibilityThreshold(uint64_t numSamples)
+        {
+            mThreshold = numSamples;
+        }
+
+        inline uint64_t GetVisibilityThreshold() const
+        {
+            return mThreshold;
+        }
+
+        // The number of frames between the queries of a visible visual. The
+        // queries of the visuals are staggered over the interval. The
+        // default value is 8.
+        void SetQueryInterval(unsigned int numFrames);
+
+        inline unsigned int GetQueryInterval() const
+        {
+            return mInterval;
+        }
+
+        // Draw the occluded visuals conditionally on their box queries. The
+        // default value is 'false'.
+        inline void UseConditionalDraws(bool use)
+        {
+            mConditionalDraws = use;
+        }
+
+        inline bool UsesConditionalDraws() const
+        {
+            return mConditionalDraws;
+        }
+
+        // Draw the visuals for the current frame of the camera.
+        void Draw(std::shared_ptr<Camera> const& camera);
+
+        // Statistics for the last Draw call. The drawn visuals do not
+        // include the conditional draws, which are counted as occluded.
+        inline unsigned int GetNumDrawn() const
+        {
+            return mNumDrawn;
+        }
+
+        inline unsigned int GetNumOccluded() const
+        {
+            return mNumOccluded;
+        }
+
+        inline unsigned int GetNumOutsideFrustum() const
+        {
+            return mNumOutsideFrustum;
+        }
+
+        inline unsigned int GetNumQueries() const
+        {
+            return mNumQueries;
+        }
+
+    private:
+        struct Object
+        {
+            std::shared_ptr<Visual> visual;
+            Vector3<float> center, extent;
+            unsigned int query;
+            uint64_t nextQueryFrame;
+            bool visible, pending;
+        };
+
+        // Query the bounding box of an object.
+        void QueryBox(Object& object, Matrix4x4<float> const& pvMatrix);
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        std::map<Visual const*, Object> mObjects;
+        uint64_t mThreshold;
+        unsigned int mInterval, mNumInserted;
+        bool mConditionalDraws;
+        uint64_t mFrame;
+
+        // The unit cube [-1,1]^3 drawn for the box queries, and the states
+        // that disable the color and depth writes of its draws.
+        std::shared_ptr<Visual> mBox;
+        std::shared_ptr<ConstantColorEffect> mBoxEffect;
+        std::shared_ptr<BlendState> mBoxBlendState;
+        std::shared_ptr<DepthStencilState> mBoxDepthStencilState;
+        std::shared_ptr<RasterizerState> mBoxRasterizerState;
+
+        // Storage retained between frames.
+        std::vector<std::pair<float, Object*>> mSorted;
+        std::vector<Object*> mOccluded;
+
+        unsigned int mNumDrawn, mNumOccluded, mNumOutsideFrustum, mNumQueries;
+    };
+}
@@ -3,18 +3,23 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/PVWUpdater.h>
+#include <cstring>
 using namespace gte;
 
 PVWUpdater::PVWUpdater()
+    :
+    mNumBatchSlots(0)
 {
     Set(nullptr, [](std::shared_ptr<Buffer> const&) {});
 }
 
 PVWUpdater::PVWUpdater(std::shared_ptr<Camera> const& camera, BufferUpdater const& updater)
+    :
+    mNumBatchSlots(0)
 {
     Set(camera, updater);
 }
@@ -51,7 +56,44 @@ bool PVWUpdater::Subscribe(std::shared_ptr<Visual> const& visual,
         {
             auto const& worldMatrix = visual->worldTransform.GetHMatrix();
             auto const& cbuffer = effect->GetPVWMatrixConstant();
-            return Subscribe(worldMatrix, cbuffer, pvwMatrixName);
+            auto const& vshader = effect->GetVertexShader();
+            if (!mBatch || !vshader || vshader->Get("pvwMatrices") < 0)
+            {
+                return Subscribe(worldMatrix, cbuffer, pvwMatrixName);
+            }
+
+            if (!cbuffer || mBatchSubscribers.find(&worldMatrix) != mBatchSubscribers.end())
+            {
+                return false;
+            }
+
+            unsigned int slot;
+            if (!mFreeBatchSlots.empty())
+            {
+                slot = mFreeBatchSlots.back();
+                mFreeBatchSlots.pop_back();
+            }
+            else if (mNumBatchSlots < mBatch->GetNumElements())
+            {
+                slot = mNumBatchSlots++;
+                mBatch->SetNumActiveElements(mNumBatchSlots);
+            }
+            else
+            {
+                return false;
+            }
+            mBatchSubscribers.insert(std::make_pair(&worldMatrix, slot));
+
+            // The shader reads the slot from the first component of the
+            // constant buffer, so the buffer is uploaded only here.
+            uint32_t* index = cbuffer->Get<uint32_t>();
+            index[0] = slot;
+            index[1] = 0;
+            index[2] = 0;
+            index[3] = 0;
+            mUpdater(cbuffer);
+            vshader->Set("pvwMatrices", mBatch);
+            return true;
         }
     }
     return false;
@@ -59,6 +101,13 @@ bool PVWUpdater::Subscribe(std::shared_ptr<Visual> const& visual,
 
 bool PVWUpdater::Unsubscribe(Matrix4x4<float> const& worldMatrix)
 {
+    auto iter = mBatchSubscribers.find(&worldMatrix);
+    if (iter != mBatchSubscribers.end())
+    {
+        mFreeBatchSlots.push_back(iter->second);
+        mBatchSubscribers.erase(iter);
+        return true;
+    }
     return mSubscribers.erase(&worldMatrix) > 0;
 }
 
@@ -75,6 +124,26 @@ bool PVWUpdater::Unsubscribe(std::shared_ptr<Visual> const& visual)
 void PVWUpdater::UnsubscribeAll()
 {
     mSubscribers.clear();
+    mBatchSubscribers.clear();
+    mFreeBatchSlots.clear();
+    mNumBatchSlots = 0;
+}
+
+void PVWUpdater::SetBatchCapacity(unsigned int capacity)
+{
+    mBatchSubscribers.clear();
+    mFreeBatchSlots.clear();
+    mNumBatchSlots = 0;
+    if (capacity > 0)
+    {
+        mBatch = std::make_shared<StructuredBuffer>(capacity, sizeof(Matrix4x4<float>));
+        mBatch->SetUsage(Resource::DYNAMIC_UPDATE);
+        std::memset(mBatch->GetData(), 0, mBatch->GetNumBytes());
+    }
+    else
+    {
+        mBatch = nullptr;
+    }
 }
 
 void PVWUpdater::Update()
@@ -102,6 +171,24 @@ void PVWUpdater::Update()
             // Allow the caller to update GPU memory as desired.
             mUpdater(cbuffer);
         }
+
+        if (!mBatchSubscribers.empty())
+        {
+            Matrix4x4<float>* pvwMatrices = mBatch->Get<Matrix4x4<float>>();
+            for (auto const& element : mBatchSubscribers)
+            {
+                auto const& wMatrix = *element.first;
+#if defined(GTE_USE_MAT_VEC)
+                pvwMatrices[element.second] = pvMatrix * wMatrix;
+#else
+                pvwMatrices[element.second] = wMatrix * pvMatrix;
+#endif
+            }
+
+            // The matrices of all the batched subscribers are uploaded by
+            // one call.
+            mUpdater(mBatch);
+        }
     }
 }
 
@@ -112,7 +199,8 @@ void PVWUpdater::Update(std::vector<Visual*> const& updateSet)
         Matrix4x4<float> pvMatrix = mCamera->GetProjectionViewMatrix();
         for (auto& visual : updateSet)
         {
-            if (visual)
+            if (visual && (mBatchSubscribers.empty() ||
+                mBatchSubscribers.find(&visual->worldTransform.GetHMatrix()) == mBatchSubscribers.end()))
             {
                 auto const& effect = visual->GetEffect();
                 if (effect)
@@ -3,14 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/Camera.h>
 #include <Graphics/ConstantBuffer.h>
+#include <Graphics/StructuredBuffer.h>
 #include <Graphics/Visual.h>
 #include <map>
+#include <vector>
 
 // The PVWUpdater class is responsible for managing memory associated with
 // projection-view-world matrices stored in ConstantBuffer objects that are
@@ -47,6 +49,19 @@
 //      of a static set of matrix-buffer pairs (for example, the stationary
 //      background objects in the world) and a dynamic set of matrix-buffer
 //      pairs (for example, the moving objects in the world).
+//
+// Scenario 1 has a batched mode for Visual objects, enabled by
+// SetBatchCapacity, that replaces the BufferUpdater call per subscriber by
+// one call per Update(). The PVW matrices are stored in a single structured
+// buffer, one slot per subscribed Visual object. A vertex shader compiled
+// with the define GTE_USE_PVW_BATCH set to 1,
+//   factory->defines.Set("GTE_USE_PVW_BATCH", 1);
+// reads its matrix from the structured buffer "pvwMatrices" at the slot
+// stored in the first component of its "PVWMatrix" constant buffer. The
+// slot is written and uploaded once when the Visual object is subscribed.
+// Texture2Effect and the Ambient, Directional, Point and Spot light effects
+// have such shaders. An effect must not be shared by Visual objects that are
+// subscribed in batched mode.
 
 namespace gte
 {
@@ -99,7 +114,10 @@ namespace gte
         // The world matrix is visual->worldTransform and the constant buffer
         // is visual->GetEffect()->GetPVWMatrixConstant().  If you subscribe
         // a Visual object, it must exist at least as long as the PVWUpdater
-        // object that is managing its CPU-to-GPU memory copies.
+        // object that is managing its CPU-to-GPU memory copies.  In batched
+        // mode, the Visual object is batched when its vertex shader has the
+        // structured buffer "pvwMatrices".  The return value is 'false' when
+        // all the slots of the batch are in use.
         bool Subscribe(std::shared_ptr<Visual> const& visual,
             std::string const& pvwMatrixName = "pvwMatrix");
 
@@ -107,6 +125,22 @@ namespace gte
         bool Unsubscribe(std::shared_ptr<Visual> const& visual);
         void UnsubscribeAll();
 
+        // Support for the batched mode.  A positive capacity is the maximum
+        // number of batched Visual objects, and a capacity of 0 disables the
+        // batched mode, which is the default.  Changing the capacity
+        // unsubscribes the batched Visual objects.
+        void SetBatchCapacity(unsigned int capacity);
+
+        inline unsigned int GetBatchCapacity() const
+        {
+            return (mBatch ? mBatch->GetNumElements() : 0);
+        }
+
+        inline std::shared_ptr<StructuredBuffer> const& GetBatchBuffer() const
+        {
+            return mBatch;
+        }
+
         // After any camera modifictions that change the projection or view
         // matrices, or after any modifications to world matrices of the
         // subscribed pairs, call this function to recompute the PVW matrices
@@ -117,7 +151,9 @@ namespace gte
         // Function supporting a dynamic set of matrix-buffer pairs based on
         // the potentially visible set.  Although you can create the visible
         // set using Culler::ComputeVisibleSet, you can equally manage any set
-        // of Visual objects to update if you so choose.
+        // of Visual objects to update if you so choose.  The Visual objects
+        // subscribed in batched mode are skipped, because their matrices
+        // are updated by Update().
         void Update(std::vector<Visual*> const& updateSet);
 
     protected:
@@ -127,5 +163,13 @@ namespace gte
         typedef Matrix4x4<float> const* PVWKey;
         typedef std::pair<std::shared_ptr<ConstantBuffer>, std::string> PVWValue;
         std::map<PVWKey, PVWValue> mSubscribers;
+
+        // The batched mode.  The slots [0,mNumBatchSlots) of mBatch have been
+        // assigned, and the unassigned slots of that range are in
+        // mFreeBatchSlots.
+        std::shared_ptr<StructuredBuffer> mBatch;
+        std::map<PVWKey, unsigned int> mBatchSubscribers;
+        std::vector<unsigned int> mFreeBatchSlots;
+        unsigned int mNumBatchSlots;
     };
 }
@@ -3,20 +3,21 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Picker.h>
 #include <Mathematics/Logger.h>
-#include <Mathematics/IntrLine3Triangle3.h>
 #include <Mathematics/DistLineSegment.h>
 #include <Mathematics/DistPointLine.h>
+#include <atomic>
 #include <thread>
 using namespace gte;
 
 Picker::Picker(unsigned int numThreads)
     :
     mNumThreads(numThreads > 1 ? numThreads : 1),
+    mBVHThreshold(1024),
     mMaxDistance(0.0f),
     mOrigin{ 0.0f, 0.0f, 0.0f, 1.0f },
     mDirection{ 0.0f, 0.0f, 0.0f, 0.0f },
@@ -35,6 +36,26 @@ float Picker::GetMaxDistance() const
     return mMaxDistance;
 }
 
+void Picker::SetBVHThreshold(unsigned int minTriangles)
+{
+    mBVHThreshold = minTriangles;
+}
+
+unsigned int Picker::GetBVHThreshold() const
+{
+    return mBVHThreshold;
+}
+
+void Picker::InvalidateCache(std::shared_ptr<Visual> const& visual)
+{
+    mBVHCache.erase(visual.get());
+}
+
+void Picker::ClearCache()
+{
+    mBVHCache.clear();
+}
+
 void Picker::operator()(std::shared_ptr<Spatial> const& scene,
     Vector4<float> const& origin, Vector4<float> const& direction, float tmin, float tmax)
 {
@@ -54,7 +75,68 @@ void Picker::operator()(std::shared_ptr<Spatial> const& scene,
     mTMax = tmax;
 
     records.clear();
-    ExecuteRecursive(scene);
+
+    // Remove the hierarchies of the destroyed Visual objects.
+    for (auto iter = mBVHCache.begin(); iter != mBVHCache.end(); /**/)
+    {
+        if (iter->second.visual.expired())
+        {
+            iter = mBVHCache.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    std::vector<std::shared_ptr<Visual>> visuals;
+    GetVisuals(scene, visuals);
+    unsigned int const numVisuals = static_cast<unsigned int>(visuals.size());
+    unsigned int const numThreads = std::min(numVisuals, mNumThreads);
+    if (numThreads > 1)
+    {
+        // The cache entries are created before the threads are launched so
+        // that each thread modifies only the entries of its own objects.
+        for (auto const& visual : visuals)
+        {
+            mBVHCache.insert(std::make_pair(visual.get(), BVHEntry{}));
+        }
+
+        // The threads pick the next unprocessed object. The records of each
+        // object are stored separately and concatenated in the traversal
+        // order, so the records are the same as for a single thread.
+        std::vector<std::vector<PickRecord>> outputs(numVisuals);
+        std::atomic<unsigned int> next(0);
+        std::vector<std::thread> process(numThreads);
+        for (unsigned int t = 0; t < numThreads; ++t)
+        {
+            process[t] = std::thread(
+                [this, &visuals, &outputs, &next, numVisuals]()
+                {
+                    for (unsigned int i = next++; i < numVisuals; i = next++)
+                    {
+                        Pick(visuals[i], 1, outputs[i]);
+                    }
+                });
+        }
+
+        for (unsigned int t = 0; t < numThreads; ++t)
+        {
+            process[t].join();
+        }
+
+        for (auto const& output : outputs)
+        {
+            std::copy(output.begin(), output.end(), std::back_inserter(records));
+        }
+    }
+    else
+    {
+        for (auto const& visual : visuals)
+        {
+            Pick(visual, mNumThreads, records);
+        }
+    }
 }
 
 PickRecord const& Picker::GetClosestToZero() const
@@ -162,56 +244,15 @@ PickRecord const& Picker::GetClosestNonpositive() const
     }
 }
 
-void Picker::ExecuteRecursive(std::shared_ptr<Spatial> const& object)
+void Picker::GetVisuals(std::shared_ptr<Spatial> const& object,
+    std::vector<std::shared_ptr<Visual>>& visuals) const
 {
     auto visual = std::dynamic_pointer_cast<Visual>(object);
     if (visual)
     {
         if (visual->worldBound.TestIntersection(HProject(mOrigin), HProject(mDirection), mTMin, mTMax))
         {
-            // Convert the linear component to model-space coordinates.
-            Matrix4x4<float> const& invWorldMatrix = visual->worldTransform.GetHInverse();
-            Line3<float> line;
-            Vector4<float> temp;
-#if defined (GTE_USE_MAT_VEC)
-            temp = invWorldMatrix * mOrigin;
-            line.origin = { temp[0], temp[1], temp[2] };
-            temp = invWorldMatrix * mDirection;
-            line.direction = { temp[0], temp[1], temp[2] };
-#else
-            temp = mOrigin * invWorldMatrix;
-            line.origin = { temp[0], temp[1], temp[2] };
-            temp = mDirection * invWorldMatrix;
-            line.direction = { temp[0], temp[1], temp[2] };
-#endif
-            // The world transformation might have non-unit scales, in which case the
-            // model-space line direction is not unit length.
-            Normalize(line.direction);
-
-            // Get the position data.
-            VertexBuffer* vbuffer = visual->GetVertexBuffer().get();
-            std::set<DFType> required;
-            required.insert(DF_R32G32B32_FLOAT);
-            required.insert(DF_R32G32B32A32_FLOAT);
-            char const* positions = vbuffer->GetChannel(VA_POSITION, 0, required);
-            LogAssert(positions != nullptr, "Expecting 3D positions.");
-
-            // The picking algorithm depends on the primitive type.
-            unsigned int vstride = vbuffer->GetElementSize();
-            IndexBuffer* ibuffer = visual->GetIndexBuffer().get();
-            IPType primitiveType = ibuffer->GetPrimitiveType();
-            if (primitiveType & IP_HAS_TRIANGLES)
-            {
-                PickTriangles(visual, positions, vstride, ibuffer, line);
-            }
-            else if (primitiveType & IP_HAS_SEGMENTS)
-            {
-                PickSegments(visual, positions, vstride, ibuffer, line);
-            }
-            else if (primitiveType & IP_HAS_POINTS)
-            {
-                PickPoints(visual, positions, vstride, ibuffer, line);
-            }
+            visuals.push_back(visual);
         }
         return;
     }
@@ -227,7 +268,7 @@ void Picker::ExecuteRecursive(std::shared_ptr<Spatial> const& object)
                 std::shared_ptr<Spatial> child = node->GetChild(i);
                 if (child)
                 {
-                    ExecuteRecursive(child);
+                    GetVisuals(child, visuals);
                 }
             }
         }
@@ -240,14 +281,178 @@ void Picker::ExecuteRecursive(std::shared_ptr<Spatial> const& object)
     LogError("Invalid object type.");
 }
 
+void Picker::Pick(std::shared_ptr<Visual> const& visual, unsigned int numThreads,
+    std::vector<PickRecord>& output)
+{
+    // Convert the linear component to model-space coordinates.
+    Matrix4x4<float> const& invWorldMatrix = visual->worldTransform.GetHInverse();
+    Line3<float> line;
+    Vector4<float> temp;
+#if defined (GTE_USE_MAT_VEC)
+    temp = invWorldMatrix * mOrigin;
+    line.origin = { temp[0], temp[1], temp[2] };
+    temp = invWorldMatrix * mDirection;
+    line.direction = { temp[0], temp[1], temp[2] };
+#else
+    temp = mOrigin * invWorldMatrix;
+    line.origin = { temp[0], temp[1], temp[2] };
+    temp = mDirection * invWorldMatrix;
+    line.direction = { temp[0], temp[1], temp[2] };
+#endif
+    // The world transformation might have non-unit scales, in which case the
+    // model-space line direction is not unit length.
+    Normalize(line.direction);
+
+    // Get the position data.
+    VertexBuffer* vbuffer = visual->GetVertexBuffer().get();
+    std::set<DFType> required;
+    required.insert(DF_R32G32B32_FLOAT);
+    required.insert(DF_R32G32B32A32_FLOAT);
+    char const* positions = vbuffer->GetChannel(VA_POSITION, 0, required);
+    LogAssert(positions != nullptr, "Expecting 3D positions.");
+
+    // The picking algorithm depends on the primitive type.
+    unsigned int vstride = vbuffer->GetElementSize();
+    IndexBuffer* ibuffer = visual->GetIndexBuffer().get();
+    IPType primitiveType = ibuffer->GetPrimitiveType();
+    if (primitiveType & IP_HAS_TRIANGLES)
+    {
+        if (ibuffer->GetNumActivePrimitives() >= mBVHThreshold)
+        {
+            auto const& tree = GetBVH(visual, positions, vstride, numThreads);
+            PickTriangles(visual, tree, ibuffer, line, output);
+        }
+        else
+        {
+            PickTriangles(visual, positions, vstride, ibuffer, line, numThreads, output);
+        }
+    }
+    else if (primitiveType & IP_HAS_SEGMENTS)
+    {
+        PickSegments(visual, positions, vstride, ibuffer, line, output);
+    }
+    else if (primitiveType & IP_HAS_POINTS)
+    {
+        PickPoints(visual, positions, vstride, ibuffer, line, output);
+    }
+}
+
+AABBTreeForTriangles<float> const& Picker::GetBVH(std::shared_ptr<Visual> const& visual,
+    char const* positions, unsigned int vstride, unsigned int numThreads)
+{
+    VertexBuffer const* vbuffer = visual->GetVertexBuffer().get();
+    IndexBuffer* ibuffer = visual->GetIndexBuffer().get();
+    unsigned int const numVertices = vbuffer->GetNumElements();
+    unsigned int const firstTriangle = ibuffer->GetFirstPrimitive();
+    unsigned int const numTriangles = ibuffer->GetNumActivePrimitives();
+
+    // The entry exists when the objects are picked by multiple threads.
+    auto iter = mBVHCache.find(visual.get());
+    if (iter == mBVHCache.end())
+    {
+        iter = mBVHCache.insert(std::make_pair(visual.get(), BVHEntry{})).first;
+    }
+    BVHEntry& entry = iter->second;
+    if (entry.tree && entry.vbuffer == vbuffer && entry.ibuffer == ibuffer
+        && entry.numVertices == numVertices && entry.firstPrimitive == firstTriangle
+        && entry.numPrimitives == numTriangles)
+    {
+        return *entry.tree;
+    }
+
+    std::vector<Vector3<float>> vertices(numVertices);
+    for (unsigned int v = 0; v < numVertices; ++v)
+    {
+        vertices[v] = *reinterpret_cast<Vector3<float> const*>(positions + v * vstride);
+    }
+
+    // The triangles of the hierarchy are the active triangles, so triangle
+    // k of the hierarchy is primitive firstTriangle + k.
+    std::vector<int> indices(3 * static_cast<size_t>(numTriangles));
+    for (unsigned int k = 0, j = 0; k < numTriangles; ++k)
+    {
+        unsigned int v0, v1, v2;
+        GetTriangle(ibuffer, firstTriangle + k, v0, v1, v2);
+        indices[j++] = static_cast<int>(v0);
+        indices[j++] = static_cast<int>(v1);
+        indices[j++] = static_cast<int>(v2);
+    }
+
+    entry.visual = visual;
+    entry.vbuffer = vbuffer;
+    entry.ibuffer = ibuffer;
+    entry.numVertices = numVertices;
+    entry.firstPrimitive = firstTriangle;
+    entry.numPrimitives = numTriangles;
+    entry.tree = std::make_shared<AABBTreeForTriangles<float>>(
+        static_cast<int>(numVertices), vertices.data(), static_cast<int>(numTriangles),
+        indices.data(), 4, static_cast<size_t>(numThreads));
+    return *entry.tree;
+}
+
+void Picker::GetTriangle(IndexBuffer* ibuffer, unsigned int i,
+    unsigned int& v0, unsigned int& v1, unsigned int& v2)
+{
+    if (ibuffer->IsIndexed())
+    {
+        ibuffer->GetTriangle(i, v0, v1, v2);
+    }
+    else if (ibuffer->GetPrimitiveType() == IP_TRIMESH)
+    {
+        v0 = 3 * i;
+        v1 = v0 + 1;
+        v2 = v0 + 2;
+    }
+    else  // primitiveType == IP_TRISTRIP
+    {
+        unsigned int offset = (i & 1);
+        v0 = i + offset;
+        v1 = i + 1 + offset;
+        v2 = i + 2 - offset;
+    }
+}
+
+PickRecord Picker::CreateTriangleRecord(std::shared_ptr<Visual> const& visual,
+    IPType primitiveType, unsigned int i, unsigned int v0, unsigned int v1,
+    unsigned int v2, FIQuery<float, Line3<float>, Triangle3<float>>::Result const& result) const
+{
+    PickRecord record;
+    record.visual = visual;
+    record.primitiveType = primitiveType;
+    record.primitiveIndex = i;
+    record.vertexIndex[0] = static_cast<int>(v0);
+    record.vertexIndex[1] = static_cast<int>(v1);
+    record.vertexIndex[2] = static_cast<int>(v2);
+    record.t = result.parameter;
+    record.bary[0] = result.triangleBary[0];
+    record.bary[1] = result.triangleBary[1];
+    record.bary[2] = result.triangleBary[2];
+    record.linePoint = HLift(result.point, 1.0f);
+
+#if defined (GTE_USE_MAT_VEC)
+    record.linePoint = visual->worldTransform * record.linePoint;
+#else
+    record.linePoint = record.linePoint * visual->worldTransform;
+#endif
+    record.primitivePoint = record.linePoint;
+
+    record.distanceToLinePoint =
+        Length(record.linePoint - mOrigin);
+    record.distanceToPrimitivePoint =
+        Length(record.primitivePoint - mOrigin);
+    record.distanceBetweenLinePrimitive =
+        Length(record.linePoint - record.primitivePoint);
+    return record;
+}
 
 void Picker::PickTriangles(std::shared_ptr<Visual> const& visual, char const* positions,
-    unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line)
+    unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
+    unsigned int maxThreads, std::vector<PickRecord>& output) const
 {
     // Partition the items for multiple threads.
     auto const firstTriangle = ibuffer->GetFirstPrimitive();
     auto const numTriangles = ibuffer->GetNumActivePrimitives();
-    auto const numThreads = std::min(numTriangles, mNumThreads);
+    auto const numThreads = std::min(numTriangles, maxThreads);
 
     if (numThreads > 1)
     {
@@ -279,13 +484,13 @@ void Picker::PickTriangles(std::shared_ptr<Visual> const& visual, char const* po
         for (unsigned int t = 0; t < numThreads; ++t)
         {
             process[t].join();
-            std::copy(threadOutputs[t].begin(), threadOutputs[t].end(), std::back_inserter(records));
+            std::copy(threadOutputs[t].begin(), threadOutputs[t].end(), std::back_inserter(output));
         }
     }
-    else
+    else if (numTriangles > 0)
     {
         PickTriangles(visual, positions, vstride, ibuffer, line,
-            firstTriangle, firstTriangle + numTriangles - 1, records);
+            firstTriangle, firstTriangle + numTriangles - 1, output);
     }
 }
 
@@ -294,29 +499,12 @@ void Picker::PickTriangles(std::shared_ptr<Visual> const& visual, char const* po
     unsigned int i0, unsigned int i1, std::vector<PickRecord>& output) const
 {
     // Compute intersections with the model-space triangles.
-    bool isIndexed = ibuffer->IsIndexed();
     IPType primitiveType = ibuffer->GetPrimitiveType();
     for (unsigned int i = i0; i <= i1; ++i)
     {
         // Get the vertex indices for the triangle.
         unsigned int v0, v1, v2;
-        if (isIndexed)
-        {
-            ibuffer->GetTriangle(i, v0, v1, v2);
-        }
-        else if (primitiveType == IP_TRIMESH)
-        {
-            v0 = 3 * i;
-            v1 = v0 + 1;
-            v2 = v0 + 2;
-        }
-        else  // primitiveType == IP_TRISTRIP
-        {
-            int offset = (i & 1);
-            v0 = i + offset;
-            v1 = i + 1 + offset;
-            v2 = i + 2 - offset;
-        }
+        GetTriangle(ibuffer, i, v0, v1, v2);
 
         // Get the vertex positions.
         Vector3<float> const& p0 = *(Vector3<float> const*)(positions + v0 * vstride);
@@ -333,40 +521,91 @@ void Picker::PickTriangles(std::shared_ptr<Visual> const& visual, char const* po
             && mTMin <= result.parameter
             && result.parameter <= mTMax)
         {
-            PickRecord record;
-            record.visual = visual;
-            record.primitiveType = primitiveType;
-            record.primitiveIndex = i;
-            record.vertexIndex[0] = static_cast<int>(v0);
-            record.vertexIndex[1] = static_cast<int>(v1);
-            record.vertexIndex[2] = static_cast<int>(v2);
-            record.t = result.parameter;
-            record.bary[0] = result.triangleBary[0];
-            record.bary[1] = result.triangleBary[1];
-            record.bary[2] = result.triangleBary[2];
-            record.linePoint = HLift(result.point, 1.0f);
+            output.push_back(CreateTriangleRecord(visual, primitiveType, i, v0, v1, v2, result));
+        }
+    }
+}
 
-#if defined (GTE_USE_MAT_VEC)
-            record.linePoint = visual->worldTransform * record.linePoint;
-#else
-            record.linePoint = record.linePoint * visual->worldTransform;
-#endif
-            record.primitivePoint = record.linePoint;
+void Picker::PickTriangles(std::shared_ptr<Visual> const& visual,
+    AABBTreeForTriangles<float> const& tree, IndexBuffer* ibuffer,
+    Line3<float> const& line, std::vector<PickRecord>& output) const
+{
+    auto const& nodes = tree.GetNodes();
+    auto const& triangles = tree.GetTriangles();
+    auto const& indices = tree.GetIndices();
+    auto const& order = tree.GetOrder();
+    unsigned int const firstTriangle = ibuffer->GetFirstPrimitive();
+    IPType primitiveType = ibuffer->GetPrimitiveType();
+    size_t const numPrevious = output.size();
+
+    // Visit the nodes whose boxes are intersected by the line for t in
+    // [mTMin,mTMax], using the slab method.
+    FIQuery<float, Line3<float>, Triangle3<float>> query;
+    std::vector<uint32_t> stack;
+    stack.push_back(0);
+    while (stack.size() > 0)
+    {
+        uint32_t current = stack.back();
+        stack.pop_back();
+        auto const& node = nodes[current];
 
-            record.distanceToLinePoint =
-                Length(record.linePoint - mOrigin);
-            record.distanceToPrimitivePoint =
-                Length(record.primitivePoint - mOrigin);
-            record.distanceBetweenLinePrimitive =
-                Length(record.linePoint - record.primitivePoint);
+        float t0 = mTMin, t1 = mTMax;
+        for (int d = 0; d < 3 && t0 <= t1; ++d)
+        {
+            if (line.direction[d] != 0.0f)
+            {
+                float invDirection = 1.0f / line.direction[d];
+                float s0 = (node.min[d] - line.origin[d]) * invDirection;
+                float s1 = (node.max[d] - line.origin[d]) * invDirection;
+                t0 = std::max(t0, std::min(s0, s1));
+                t1 = std::min(t1, std::max(s0, s1));
+            }
+            else if (line.origin[d] < node.min[d] || line.origin[d] > node.max[d])
+            {
+                t1 = t0 - 1.0f;
+            }
+        }
+        if (t0 > t1)
+        {
+            continue;
+        }
 
-            output.push_back(record);
+        if (node.count > 0)
+        {
+            for (uint32_t k = node.offset; k < node.offset + node.count; ++k)
+            {
+                auto result = query(line, triangles[k]);
+                if (result.intersect
+                    && mTMin <= result.parameter
+                    && result.parameter <= mTMax)
+                {
+                    unsigned int i = firstTriangle + static_cast<unsigned int>(order[k]);
+                    output.push_back(CreateTriangleRecord(visual, primitiveType, i,
+                        static_cast<unsigned int>(indices[k][0]),
+                        static_cast<unsigned int>(indices[k][1]),
+                        static_cast<unsigned int>(indices[k][2]), result));
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(node.offset);
+            stack.push_back(current + 1);
         }
     }
+
+    // Store the records in the order of the primitives, as for the picking
+    // without the hierarchy.
+    std::sort(output.begin() + numPrevious, output.end(),
+        [](PickRecord const& record0, PickRecord const& record1)
+        {
+            return record0.primitiveIndex < record1.primitiveIndex;
+        });
 }
 
 void Picker::PickSegments(std::shared_ptr<Visual> const& visual, char const* positions,
-    unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line)
+    unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
+    std::vector<PickRecord>& output) const
 {
     // Compute distances from the model-space segments to the line.
     unsigned int const firstSegment = ibuffer->GetFirstPrimitive();
@@ -429,13 +668,14 @@ void Picker::PickSegments(std::shared_ptr<Visual> const& visual, char const* pos
             record.distanceToPrimitivePoint = Length(record.primitivePoint - mOrigin);
             record.distanceBetweenLinePrimitive = Length(record.linePoint - record.primitivePoint);
 
-            records.push_back(record);
+            output.push_back(record);
         }
     }
 }
 
 void Picker::PickPoints(std::shared_ptr<Visual> const& visual, char const* positions,
-    unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line)
+    unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
+    std::vector<PickRecord>& output) const
 {
     // Compute distances from the model-space points to the line.
     unsigned int const firstPoint = ibuffer->GetFirstPrimitive();
@@ -487,7 +727,7 @@ void Picker::PickPoints(std::shared_ptr<Visual> const& visual, char const* posit
             record.distanceToPrimitivePoint = Length(record.primitivePoint - mOrigin);
             record.distanceBetweenLinePrimitive = Length(record.linePoint - record.primitivePoint);
 
-            records.push_back(record);
+            output.push_back(record);
         }
     }
 }
@@ -3,14 +3,18 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/PickRecord.h>
 #include <Graphics/Node.h>
 #include <Graphics/Visual.h>
+#include <Mathematics/AABBTreeOfTriangles.h>
+#include <Mathematics/IntrLine3Triangle3.h>
 #include <Mathematics/Line.h>
+#include <map>
+#include <memory>
 
 namespace gte
 {
@@ -18,11 +22,28 @@ namespace gte
     {
     public:
         // Construction and destruction. Set the numThreads parameter to a
-        // value larger than 1 for multithreaded picking of triangle
-        // primitives.
+        // value larger than 1 for multithreaded picking. The Visual objects
+        // whose world bounds are intersected by the pick line are picked
+        // concurrently, and when there is only one such object, its
+        // triangles are partitioned among the threads.
         ~Picker() = default;
         Picker(unsigned int numThreads = 1);
 
+        // Triangle primitives of a Visual with at least this number of
+        // active triangles are picked using a bounding volume hierarchy
+        // (AABBTreeForTriangles) of the model-space triangles, so only the
+        // triangles in the leaves intersected by the pick line are tested.
+        // The hierarchy is built on the first pick of the Visual and cached
+        // by the picker. It is rebuilt when the vertex buffer, the index
+        // buffer or the active primitives of the Visual change. When the
+        // positions or indices are modified in place, call InvalidateCache
+        // for the Visual. The default threshold is 1024; a threshold of
+        // std::numeric_limits<unsigned int>::max() disables the hierarchies.
+        void SetBVHThreshold(unsigned int minTriangles);
+        unsigned int GetBVHThreshold() const;
+        void InvalidateCache(std::shared_ptr<Visual> const& visual);
+        void ClearCache();
+
         // Set the maximum distance when the 'scene' contains point or segment
         // primitives.  Such primitives are selected when they are within the
         // specified distance of the pick line.  The default is 0.0f.
@@ -60,26 +81,64 @@ namespace gte
         std::vector<PickRecord> records;
 
     private:
-        // The picking occurs recursively by traversing the input scene.
-        void ExecuteRecursive(std::shared_ptr<Spatial> const& object);
+        // The Visual objects whose world bounds are intersected by the pick
+        // line are gathered recursively by traversing the input scene and
+        // are then picked in the order of the traversal.
+        void GetVisuals(std::shared_ptr<Spatial> const& object,
+            std::vector<std::shared_ptr<Visual>>& visuals) const;
+
+        void Pick(std::shared_ptr<Visual> const& visual, unsigned int numThreads,
+            std::vector<PickRecord>& output);
 
         void PickTriangles(std::shared_ptr<Visual> const& visual, char const* positions,
-            unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line);
+            unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
+            unsigned int maxThreads, std::vector<PickRecord>& output) const;
 
         void PickTriangles(std::shared_ptr<Visual> const& visual, char const* positions,
             unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
             unsigned int i0, unsigned int i1, std::vector<PickRecord>& output) const;
 
+        void PickTriangles(std::shared_ptr<Visual> const& visual,
+            AABBTreeForTriangles<float> const& tree, IndexBuffer* ibuffer,
+            Line3<float> const& line, std::vector<PickRecord>& output) const;
+
         void PickSegments(std::shared_ptr<Visual> const& visual, char const* positions,
-            unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line);
+            unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
+            std::vector<PickRecord>& output) const;
 
         void PickPoints(std::shared_ptr<Visual> const& visual, char const* positions,
-            unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line);
+            unsigned int vstride, IndexBuffer* ibuffer, Line3<float> const& line,
+            std::vector<PickRecord>& output) const;
+
+        static void GetTriangle(IndexBuffer* ibuffer, unsigned int i,
+            unsigned int& v0, unsigned int& v1, unsigned int& v2);
+
+        PickRecord CreateTriangleRecord(std::shared_ptr<Visual> const& visual,
+            IPType primitiveType, unsigned int i, unsigned int v0, unsigned int v1,
+            unsigned int v2, FIQuery<float, Line3<float>, Triangle3<float>>::Result const& result) const;
+
+        // Support for the cached hierarchies. The buffers and active
+        // primitives are those for which the hierarchy was built.
+        struct BVHEntry
+        {
+            std::weak_ptr<Visual> visual;
+            VertexBuffer const* vbuffer;
+            IndexBuffer const* ibuffer;
+            unsigned int numVertices, firstPrimitive, numPrimitives;
+            std::shared_ptr<AABBTreeForTriangles<float>> tree;
+        };
+
+        AABBTreeForTriangles<float> const& GetBVH(std::shared_ptr<Visual> const& visual,
+            char const* positions, unsigned int vstride, unsigned int numThreads);
 
         // The maximum number of threads that may be used to perform picking
-        // requests for triangle primitives.
+        // requests.
         unsigned int mNumThreads;
 
+        // The cached hierarchies, one per Visual.
+        unsigned int mBVHThreshold;
+        std::map<Visual const*, BVHEntry> mBVHCache;
+
         // The maximum distance from the pick line used to select point or
         // segment primitives.
         float mMaxDistance;
@@ -3,11 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/ProgramFactory.h>
 #include <Mathematics/Logger.h>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
 using namespace gte;
 
 ProgramFactory::ProgramFactory()
@@ -18,7 +21,8 @@ ProgramFactory::ProgramFactory()
     gsEntry(""),
     csEntry(""),
     defines(),
-    flags(0)
+    flags(0),
+    cacheDirectory("")
 {
 }
 
@@ -68,6 +72,112 @@ std::shared_ptr<ComputeProgram> ProgramFactory::CreateFromSource(std::string con
     return CreateFromNamedSource("cs", csSource);
 }
 
+std::shared_future<std::shared_ptr<VisualProgram>> ProgramFactory::CreateFromFilesAsync(
+    std::string const& vsFile, std::string const& psFile,
+    std::string const& gsFile)
+{
+    LogAssert(vsFile != "" && psFile != "",
+        "A program must have a vertex shader and a pixel shader.");
+
+    std::string vsSource = GetStringFromFile(vsFile);
+    LogAssert(vsSource != "", "Empty vertex shader source string.");
+
+    std::string psSource = GetStringFromFile(psFile);
+    LogAssert(psSource != "", "Empty pixel shader source string.");
+
+    std::string gsSource = "";
+    if (gsFile != "")
+    {
+        gsSource = GetStringFromFile(gsFile);
+        LogAssert(gsSource != "", "Empty geometry shader source string.");
+    }
+
+    auto request = CreateAsyncRequest();
+    request->isCompute = false;
+    request->names = { vsFile, psFile, gsFile };
+    request->sources = { vsSource, psSource, gsSource };
+    std::shared_future<std::shared_ptr<VisualProgram>> future =
+        request->visualPromise.get_future().share();
+    AddAsyncRequest(request);
+    return future;
+}
+
+std::shared_future<std::shared_ptr<VisualProgram>> ProgramFactory::CreateFromSourcesAsync(
+    std::string const& vsSource, std::string const& psSource,
+    std::string const& gsSource)
+{
+    auto request = CreateAsyncRequest();
+    request->isCompute = false;
+    request->names = { "vs", "ps", "gs" };
+    request->sources = { vsSource, psSource, gsSource };
+    std::shared_future<std::shared_ptr<VisualProgram>> future =
+        request->visualPromise.get_future().share();
+    AddAsyncRequest(request);
+    return future;
+}
+
+std::shared_future<std::shared_ptr<ComputeProgram>> ProgramFactory::CreateFromFileAsync(
+    std::string const& csFile)
+{
+    LogAssert(csFile != "", "A program must have a compute shader.");
+
+    std::string csSource = GetStringFromFile(csFile);
+    LogAssert(csSource != "", "Empty compute shader source string.");
+
+    auto request = CreateAsyncRequest();
+    request->isCompute = true;
+    request->names[0] = csFile;
+    request->sources[0] = csSource;
+    std::shared_future<std::shared_ptr<ComputeProgram>> future =
+        request->computePromise.get_future().share();
+    AddAsyncRequest(request);
+    return future;
+}
+
+std::shared_future<std::shared_ptr<ComputeProgram>> ProgramFactory::CreateFromSourceAsync(
+    std::string const& csSource)
+{
+    auto request = CreateAsyncRequest();
+    request->isCompute = true;
+    request->names[0] = "cs";
+    request->sources[0] = csSource;
+    std::shared_future<std::shared_ptr<ComputeProgram>> future =
+        request->computePromise.get_future().share();
+    AddAsyncRequest(request);
+    return future;
+}
+
+void ProgramFactory::ProcessAsync()
+{
+    // The requests are polled in the order of the calls. The requests are
+    // moved out of the member so that PollAsync may start new requests.
+    std::vector<std::shared_ptr<AsyncRequest>> requests;
+    requests.swap(mAsyncRequests);
+    std::vector<std::shared_ptr<AsyncRequest>> pending;
+    for (auto const& request : requests)
+    {
+        if (!PollAsync(*request))
+        {
+            pending.push_back(request);
+        }
+    }
+    pending.insert(pending.end(), mAsyncRequests.begin(), mAsyncRequests.end());
+    mAsyncRequests.swap(pending);
+}
+
+void ProgramFactory::WaitAsync()
+{
+    for (;;)
+    {
+        ProcessAsync();
+        if (mAsyncRequests.size() == 0)
+        {
+            break;
+        }
+        std::this_thread::yield();
+    }
+}
+
 std::string ProgramFactory::GetStringFromFile(std::string const& filename)
 {
     std::ifstream input(filename);
@@ -112,3 +222,231 @@ void ProgramFactory::PopFlags()
         mFlagsStack.pop();
     }
 }
+
+ProgramFactory::AsyncRequest::AsyncRequest()
+    :
+    flags(0),
+    isCompute(false)
+{
+}
+
+std::shared_ptr<ProgramFactory::AsyncRequest> ProgramFactory::CreateAsyncRequest()
+{
+    return std::make_shared<AsyncRequest>();
+}
+
+void ProgramFactory::StartAsync(AsyncRequest&)
+{
+}
+
+bool ProgramFactory::PollAsync(AsyncRequest& request)
+{
+    CreateFromRequest(request);
+    return true;
+}
+
+void ProgramFactory::CreateFromRequest(AsyncRequest& request)
+{
+    AsyncRequest current;
+    GetState(current);
+    SetState(request);
+    try
+    {
+        if (request.isCompute)
+        {
+            request.computePromise.set_value(CreateFromNamedSource(
+                request.names[0], request.sources[0]));
+        }
+        else
+        {
+            request.visualPromise.set_value(CreateFromNamedSources(
+                request.names[0], request.sources[0],
+                request.names[1], request.sources[1],
+                request.names[2], request.sources[2]));
+        }
+    }
+    catch (...)
+    {
+        if (request.isCompute)
+        {
+            request.computePromise.set_exception(std::current_exception());
+        }
+        else
+        {
+            request.visualPromise.set_exception(std::current_exception());
+        }
+    }
+    SetState(current);
+}
+
+void ProgramFactory::GetState(AsyncRequest& request) const
+{
+    request.version = version;
+    request.vsEntry = vsEntry;
+    request.psEntry = psEntry;
+    request.gsEntry = gsEntry;
+    request.csEntry = csEntry;
+    request.defines = defines;
+    request.flags = flags;
+    request.cacheDirectory = cacheDirectory;
+}
+
+void ProgramFactory::SetState(AsyncRequest const& request)
+{
+    version = request.version;
+    vsEntry = request.vsEntry;
+    psEntry = request.psEntry;
+    gsEntry = request.gsEntry;
+    csEntry = request.csEntry;
+    defines = request.defines;
+    flags = request.flags;
+    cacheDirectory = request.cacheDirectory;
+}
+
+void ProgramFactory::AddAsyncRequest(std::shared_ptr<AsyncRequest> const& request)
+{
+    GetState(*request);
+    StartAsync(*request);
+    mAsyncRequests.push_back(request);
+}
+
+uint32_t const ProgramFactory::msCacheMagic = 0x50475447;  // "GTGP"
+
+std::string ProgramFactory::GetCacheFilename(std::vector<std::string> const& keyParts) const
+{
+    if (cacheDirectory == "")
+    {
+        return "";
+    }
+
+    // The key is the concatenation of the key parts and the factory state,
+    // each string preceded by its length so that different partitions of
+    // the same characters have different keys.
+    std::vector<std::string> parts = keyParts;
+    parts.push_back(version);
+    parts.push_back(std::to_string(flags));
+    for (auto const& definition : defines.Get())
+    {
+        parts.push_back(definition.first);
+        parts.push_back(definition.second);
+    }
+#if defined(GTE_USE_MAT_VEC)
+    parts.push_back("GTE_USE_MAT_VEC");
+#else
+    parts.push_back("GTE_USE_VEC_MAT");
+#endif
+#if defined(GTE_USE_ROW_MAJOR)
+    parts.push_back("GTE_USE_ROW_MAJOR");
+#else
+    parts.push_back("GTE_USE_COL_MAJOR");
+#endif
+
+    // 64-bit FNV-1a hash.
+    uint64_t hash = 0xCBF29CE484222325ull;
+    auto combine = [&hash](char const* data, size_t numBytes)
+    {
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            hash ^= static_cast<uint64_t>(static_cast<unsigned char>(data[i]));
+            hash *= 0x100000001B3ull;
+        }
+    };
+    for (auto const& part : parts)
+    {
+        uint64_t length = static_cast<uint64_t>(part.length());
+        combine(reinterpret_cast<char const*>(&length), sizeof(length));
+        combine(part.data(), part.length());
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.gtprogram",
+        static_cast<unsigned long long>(hash));
+    std::string filename = cacheDirectory;
+    char last = filename.back();
+    if (last != '/' && last != '\\')
+    {
+        filename += "/";
+    }
+    return filename + name;
+}
+
+bool ProgramFactory::LoadCacheFile(std::string const& filename,
+    std::vector<std::vector<unsigned char>>& blobs)
+{
+    // The file is the magic number, the number of blobs and then the
+    // number of bytes and the bytes of each blob.
+    blobs.clear();
+    std::ifstream input(filename, std::ios::in | std::ios::binary);
+    if (!input)
+    {
+        return false;
+    }
+
+    uint32_t magic = 0, numBlobs = 0;
+    input.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    input.read(reinterpret_cast<char*>(&numBlobs), sizeof(numBlobs));
+    if (!input || magic != msCacheMagic || numBlobs > 16)
+    {
+        return false;
+    }
+
+    blobs.resize(numBlobs);
+    for (auto& blob : blobs)
+    {
+        uint32_t numBytes = 0;
+        input.read(reinterpret_cast<char*>(&numBytes), sizeof(numBytes));
+        if (!input)
+        {
+            blobs.clear();
+            return false;
+        }
+        blob.resize(numBytes);
+        if (numBytes > 0)
+        {
+            input.read(reinterpret_cast<char*>(blob.data()), numBytes);
+        }
+        if (!input)
+        {
+            blobs.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void ProgramFactory::SaveCacheFile(std::string const& filename,
+    std::vector<std::vector<unsigned char>> const& blobs)
+{
+    // The file is written with a temporary name and then renamed, so that
+    // other processes sharing the cache never read a partial file. A
+    // failure to write the file is not an error; the program is compiled
+    // again the next time.
+    std::string temporary = filename + ".tmp";
+    std::ofstream output(temporary, std::ios::out | std::ios::binary);
+    if (!output)
+    {
+        return;
+    }
+
+    uint32_t magic = msCacheMagic;
+    uint32_t numBlobs = static_cast<uint32_t>(blobs.size());
+    output.write(reinterpret_cast<char const*>(&magic), sizeof(magic));
+    output.write(reinterpret_cast<char const*>(&numBlobs), sizeof(numBlobs));
+    for (auto const& blob : blobs)
+    {
+        uint32_t numBytes = static_cast<uint32_t>(blob.size());
+        output.write(reinterpret_cast<char const*>(&numBytes), sizeof(numBytes));
+        output.write(reinterpret_cast<char const*>(blob.data()), numBytes);
+    }
+    output.close();
+
+    if (output)
+    {
+        std::remove(filename.c_str());
+        if (std::rename(temporary.c_str(), filename.c_str()) == 0)
+        {
+            return;
+        }
+    }
+    std::remove(temporary.c_str());
+}
@@ -3,15 +3,18 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/ProgramDefines.h>
 #include <Graphics/VisualProgram.h>
 #include <Graphics/ComputeProgram.h>
+#include <array>
 #include <fstream>
+#include <future>
 #include <stack>
+#include <vector>
 
 namespace gte
 {
@@ -34,6 +37,19 @@ namespace gte
         ProgramDefines defines;
         unsigned int flags;
 
+        // Support for a persistent cache of compiled programs. When the
+        // directory is not empty, the Create(...) functions look up a file
+        // of the directory whose name is a hash of the shader sources, the
+        // entry points, 'version', 'flags', 'defines', the matrix
+        // conventions and graphics driver information. When the file exists,
+        // the program is created from the compiled code in the file without
+        // invoking the shader compiler; otherwise, the sources are compiled
+        // and the compiled code is written to the file. The directory must
+        // exist. Files included by #include directives are not part of the
+        // hash, so the cache must be cleared when they are modified. The
+        // default is the empty string, which disables the cache.
+        std::string cacheDirectory;
+
         // The returned value is used as a lookup index into arrays of strings
         // corresponding to shader programs.  Currently, GLSLProgramFactory
         // returns PF_GLSL and HLSLProgramFactory returns PF_HLSL.
@@ -65,6 +81,43 @@ namespace gte
 
         std::shared_ptr<ComputeProgram> CreateFromSource(std::string const& csSource);
 
+        // Asynchronous creation of programs. The functions return
+        // immediately with a future for the program, which is the program
+        // returned by the corresponding synchronous function. The programs
+        // are created with the values of the members at the time of the
+        // call, so the members can be modified before the programs are
+        // finished. HLSLProgramFactory compiles the shaders on worker
+        // threads and GLSLProgramFactory lets the driver compile them in
+        // parallel (GL_KHR_parallel_shader_compile) when it supports it.
+        // The futures become ready only in ProcessAsync, which must be
+        // called on the thread of the graphics engine, typically once per
+        // frame, so that finished programs are attached to effects at a
+        // frame boundary. A compile or link error is reported by the get()
+        // of the future. WaitAsync calls ProcessAsync until all the programs
+        // are finished and must be called before the factory is destroyed
+        // when programs are pending.
+        std::shared_future<std::shared_ptr<VisualProgram>> CreateFromFilesAsync(
+            std::string const& vsFile, std::string const& psFile,
+            std::string const& gsFile);
+
+        std::shared_future<std::shared_ptr<VisualProgram>> CreateFromSourcesAsync(
+            std::string const& vsSource, std::string const& psSource,
+            std::string const& gsSource);
+
+        std::shared_future<std::shared_ptr<ComputeProgram>> CreateFromFileAsync(
+            std::string const& csFile);
+
+        std::shared_future<std::shared_ptr<ComputeProgram>> CreateFromSourceAsync(
+            std::string const& csSource);
+
+        void ProcessAsync();
+        void WaitAsync();
+
+        inline size_t GetNumPendingAsync() const
+        {
+            return mAsyncRequests.size();
+        }
+
         // In public scope in case an effect needs a source-code string from
         // a file; for example, OverlayEffect can use this.
         static std::string GetStringFromFile(std::string const& filename);
@@ -82,6 +135,20 @@ namespace gte
         void PopFlags();
 
     protected:
+        // Support for the program cache. The key parts are the
+        // API-specific strings that identify the program, typically the
+        // shader sources and entry points. GetCacheFilename returns the
+        // empty string when the cache is disabled. A cache file stores an
+        // array of binary blobs. LoadCacheFile returns 'false' when the file
+        // does not exist or is not a valid cache file.
+        std::string GetCacheFilename(std::vector<std::string> const& keyParts) const;
+
+        static bool LoadCacheFile(std::string const& filename,
+            std::vector<std::vector<unsigned char>>& blobs);
+
+        static void SaveCacheFile(std::string const& filename,
+            std::vector<std::vector<unsigned char>> const& blobs);
+
         virtual std::shared_ptr<VisualProgram> CreateFromNamedSources(
             std::string const& vsName, std::string const& vsSource,
             std::string const& psName, std::string const& psSource,
@@ -90,9 +157,52 @@ namespace gte
         virtual std::shared_ptr<ComputeProgram> CreateFromNamedSource(
             std::string const& csName, std::string const& csSource) = 0;
 
+        // Support for asynchronous creation. A request stores the state of
+        // the factory at the time of the call, the shader names and sources
+        // (the vertex, pixel and geometry shaders of a visual program or the
+        // compute shader in element 0) and the promise of the program.
+        struct AsyncRequest
+        {
+            AsyncRequest();
+            virtual ~AsyncRequest() = default;
+
+            std::string version, vsEntry, psEntry, gsEntry, csEntry;
+            ProgramDefines defines;
+            unsigned int flags;
+            std::string cacheDirectory;
+            bool isCompute;
+            std::array<std::string, 3> names, sources;
+            std::promise<std::shared_ptr<VisualProgram>> visualPromise;
+            std::promise<std::shared_ptr<ComputeProgram>> computePromise;
+        };
+
+        // A derived class creates a request of a derived type to store its
+        // API-specific data, starts the creation in StartAsync and finishes
+        // it in PollAsync, which returns 'true' when the promise of the
+        // request is satisfied. The defaults create the program
+        // synchronously in PollAsync.
+        virtual std::shared_ptr<AsyncRequest> CreateAsyncRequest();
+        virtual void StartAsync(AsyncRequest& request);
+        virtual bool PollAsync(AsyncRequest& request);
+
+        // Create the program of a request synchronously with the factory
+        // state of the request and satisfy its promise with the program or
+        // with the exception thrown by the creation.
+        void CreateFromRequest(AsyncRequest& request);
+
+        // Copy the factory state to or from a request.
+        void GetState(AsyncRequest& request) const;
+        void SetState(AsyncRequest const& request);
+
     private:
+        void AddAsyncRequest(std::shared_ptr<AsyncRequest> const& request);
+
         std::stack<ProgramDefines> mDefinesStack;
         std::stack<unsigned int> mFlagsStack;
+        std::vector<std::shared_ptr<AsyncRequest>> mAsyncRequests;
+
+        // The first 4 bytes of a cache file.
+        static uint32_t const msCacheMagic;
     };
 
     typedef std::array<std::string const*, ProgramFactory::PF_NUM_API> ProgramSources;
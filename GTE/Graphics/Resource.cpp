@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Resource.h>
 #include <Mathematics/Logger.h>
+#include <algorithm>
 using namespace gte;
 
 Resource::~Resource()
@@ -118,3 +119,37 @@ void Resource::SetNumActiveElements(unsigned int numActiveElements)
         mNumActiveElements = static_cast<unsigned int>(mNumElements - mOffset);
     }
 }
+
+void Resource::MarkDirty(unsigned int offsetInBytes, unsigned int numBytes)
+{
+    unsigned int const begin = std::min(offsetInBytes, mNumBytes);
+    unsigned int const end = std::min(offsetInBytes + numBytes, mNumBytes);
+    if (begin == end)
+    {
+        return;
+    }
+
+    // Insert the range and merge it with the ranges it overlaps or touches.
+    auto first = std::lower_bound(mDirtyRanges.begin(), mDirtyRanges.end(), begin,
+        [](std::pair<unsigned int, unsigned int> const& range, unsigned int value)
+        {
+            return range.second < value;
+        });
+    auto last = first;
+    std::pair<unsigned int, unsigned int> merged(begin, end);
+    while (last != mDirtyRanges.end() && last->first <= end)
+    {
+        merged.first = std::min(merged.first, last->first);
+        merged.second = std::max(merged.second, last->second);
+        ++last;
+    }
+    first = mDirtyRanges.erase(first, last);
+    mDirtyRanges.insert(first, merged);
+
+    if (mDirtyRanges.size() > maxDirtyRanges)
+    {
+        merged = std::make_pair(mDirtyRanges.front().first, mDirtyRanges.back().second);
+        mDirtyRanges.clear();
+        mDirtyRanges.push_back(merged);
+    }
+}
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.06.02
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/GraphicsObject.h>
+#include <utility>
 #include <vector>
 
 namespace gte
@@ -167,6 +168,37 @@ namespace gte
             return mNumActiveElements * mElementSize;
         }
 
+        // Dirty-range tracking for the CPU-to-GPU copies of buffers by
+        // GraphicsEngine::Update.  When ranges have been marked, the next
+        // update copies only the bytes of the ranges, instead of the active
+        // bytes, and clears the ranges.  A range [begin,end) is measured in
+        // bytes from the beginning of the data.  Overlapping and adjacent
+        // ranges are merged, and when there are more than maxDirtyRanges
+        // ranges, they are replaced by the range that contains them.
+        void MarkDirty(unsigned int offsetInBytes, unsigned int numBytes);
+
+        inline void MarkDirtyElements(unsigned int firstElement, unsigned int numElements)
+        {
+            MarkDirty(firstElement * mElementSize, numElements * mElementSize);
+        }
+
+        inline std::vector<std::pair<unsigned int, unsigned int>> const& GetDirtyRanges() const
+        {
+            return mDirtyRanges;
+        }
+
+        inline bool HasDirtyRanges() const
+        {
+            return mDirtyRanges.size() > 0;
+        }
+
+        inline void ClearDirtyRanges()
+        {
+            mDirtyRanges.clear();
+        }
+
+        static size_t const maxDirtyRanges = 16;
+
     protected:
         unsigned int mNumElements;
         unsigned int mElementSize;
@@ -177,5 +209,8 @@ namespace gte
         unsigned int mNumActiveElements;
         std::vector<char> mStorage;
         char* mData;
+
+        // The dirty ranges [begin,end), sorted by begin.
+        std::vector<std::pair<unsigned int, unsigned int>> mDirtyRanges;
     };
 }
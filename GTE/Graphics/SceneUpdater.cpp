@@ -0,0 +1,249 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/SceneUpdater.h>
+#include <Graphics/Node.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <numeric>
+using namespace gte;
+
+SceneUpdater::SceneUpdater()
+    :
+    mScheduler(nullptr),
+    mNumUpdated(0),
+    mUpdateAll(true)
+{
+}
+
+void SceneUpdater::Flatten(std::shared_ptr<Spatial> const& scene)
+{
+    LogAssert(scene != nullptr, "A scene is required for updating.");
+    mScene = scene;
+    mSpatial.clear();
+    mParent.clear();
+    mEnd.clear();
+    mKind.clear();
+    mVolatile.clear();
+    FlattenSubtree(scene.get(), -1);
+
+    size_t const numObjects = mSpatial.size();
+    mTransformChanged.assign(numObjects, 0);
+    mBoundChanged.assign(numObjects, 0);
+    mUpdateAll = true;
+}
+
+void SceneUpdater::Update(double applicationTime, unsigned int numThreads)
+{
+    LogAssert(mScene != nullptr, "Flatten must be called first.");
+
+    if (mScheduler != nullptr)
+    {
+        numThreads = mScheduler->GetNumThreads();
+    }
+    numThreads = std::max(numThreads, 1u);
+
+    // Update the top of the hierarchy in this thread, replacing a node of
+    // the list of subtrees by its children, until the list has enough
+    // subtrees for the threads. The subtrees of the list have not been
+    // visited. The nodes of the top are visited before their children.
+    size_t const minSubtrees = (numThreads > 1 ? 4 * static_cast<size_t>(numThreads) : 1);
+    std::vector<int> subtrees{ 0 }, expanded, top;
+    mNumUpdated = 0;
+    bool expandable = true;
+    while (subtrees.size() < minSubtrees && expandable)
+    {
+        expandable = false;
+        expanded.clear();
+        for (auto i : subtrees)
+        {
+            if (mKind[i] != FLAT_NODE || mEnd[i] == i + 1)
+            {
+                expanded.push_back(i);
+                continue;
+            }
+
+            bool const visitChildren = UpdateDownward(i, applicationTime);
+            mNumUpdated += mTransformChanged[i];
+            if (visitChildren)
+            {
+                top.push_back(i);
+                for (int child = i + 1; child < mEnd[i]; child = mEnd[child])
+                {
+                    expanded.push_back(child);
+                }
+                expandable = true;
+            }
+        }
+        std::swap(subtrees, expanded);
+    }
+
+    // Partition the subtrees into contiguous ranges with approximately
+    // equal numbers of objects.
+    size_t const numSubtrees = subtrees.size();
+    size_t const numChunks = std::max(std::min(static_cast<size_t>(numThreads), numSubtrees),
+        static_cast<size_t>(1));
+    std::vector<size_t> first(numChunks + 1, numSubtrees);
+    first[0] = 0;
+    if (numSubtrees > 0)
+    {
+        size_t total = 0;
+        for (auto i : subtrees)
+        {
+            total += static_cast<size_t>(mEnd[i] - i);
+        }
+
+        size_t sum = 0, chunk = 1;
+        for (size_t s = 0; s < numSubtrees && chunk < numChunks; ++s)
+        {
+            sum += static_cast<size_t>(mEnd[subtrees[s]] - subtrees[s]);
+            while (chunk < numChunks && sum * numChunks >= total * chunk)
+            {
+                first[chunk++] = s + 1;
+            }
+        }
+    }
+
+    // Each thread visits the objects of its subtrees in depth-first order
+    // and then computes the world bounds of the visited nodes in reverse
+    // order, so the children are visited before their parents.
+    mVisited.resize(std::max(mVisited.size(), numChunks));
+    std::vector<size_t> counts(numChunks, 0);
+    TaskScheduler::ParallelFor(mScheduler, numChunks,
+        [this, applicationTime, &subtrees, &first, &counts](size_t chunk)
+        {
+            std::vector<int>& visited = mVisited[chunk];
+            visited.clear();
+            for (size_t s = first[chunk]; s < first[chunk + 1]; ++s)
+            {
+                int const root = subtrees[s];
+                for (int i = root; i < mEnd[root]; )
+                {
+                    bool const visitChildren = UpdateDownward(i, applicationTime);
+                    counts[chunk] += mTransformChanged[i];
+                    if (visitChildren)
+                    {
+                        visited.push_back(i);
+                        ++i;
+                    }
+                    else
+                    {
+                        i = mEnd[i];
+                    }
+                }
+            }
+
+            for (auto iter = visited.rbegin(); iter != visited.rend(); ++iter)
+            {
+                UpdateUpward(*iter);
+            }
+        });
+
+    for (auto iter = top.rbegin(); iter != top.rend(); ++iter)
+    {
+        UpdateUpward(*iter);
+    }
+
+    if (mBoundChanged[0])
+    {
+        mSpatial[0]->PropagateBoundToRoot();
+    }
+
+    mNumUpdated = std::accumulate(counts.begin(), counts.end(), mNumUpdated);
+    mUpdateAll = false;
+}
+
+void SceneUpdater::FlattenSubtree(Spatial* spatial, int parent)
+{
+    int const index = static_cast<int>(mSpatial.size());
+    mSpatial.push_back(spatial);
+    mParent.push_back(parent);
+    mEnd.push_back(index + 1);
+    mVolatile.push_back(spatial->GetControllers().empty() ? 0 : 1);
+
+    Node* node = dynamic_cast<Node*>(spatial);
+    if (node && node->CanFlattenUpdate())
+    {
+        mKind.push_back(FLAT_NODE);
+        int const numChildren = node->GetNumChildren();
+        for (int c = 0; c < numChildren; ++c)
+        {
+            std::shared_ptr<Spatial> child = node->GetChild(c);
+            if (child)
+            {
+                int const childIndex = static_cast<int>(mSpatial.size());
+                FlattenSubtree(child.get(), index);
+                mVolatile[index] |= mVolatile[childIndex];
+            }
+        }
+        mEnd[index] = static_cast<int>(mSpatial.size());
+        return;
+    }
+
+    if (node)
+    {
+        mKind.push_back(FLAT_OTHER);
+        mVolatile[index] = 1;
+        return;
+    }
+
+    mKind.push_back(FLAT_LEAF);
+}
+
+bool SceneUpdater::UpdateDownward(int i, double applicationTime)
+{
+    Spatial* spatial = mSpatial[i];
+    int const parent = mParent[i];
+    bool const parentChanged = (parent >= 0 && mTransformChanged[parent] != 0);
+    if (!mUpdateAll && !parentChanged && !spatial->mSubtreeDirty && !mVolatile[i])
+    {
+        mTransformChanged[i] = 0;
+        mBoundChanged[i] = 0;
+        return false;
+    }
+
+    if (mKind[i] == FLAT_OTHER)
+    {
+        spatial->Update(applicationTime, false);
+        mTransformChanged[i] = 1;
+        mBoundChanged[i] = 1;
+        return false;
+    }
+
+    bool changed = spatial->UpdateControllers(applicationTime);
+    changed = (changed || mUpdateAll || parentChanged || spatial->mDirty);
+    if (changed)
+    {
+        spatial->UpdateWorldTransform();
+        if (mKind[i] == FLAT_LEAF)
+        {
+            spatial->UpdateWorldBound();
+        }
+    }
+    spatial->mDirty = false;
+    spatial->mSubtreeDirty = false;
+    mTransformChanged[i] = (changed ? 1 : 0);
+    mBoundChanged[i] = (changed ? 1 : 0);
+    return mKind[i] == FLAT_NODE;
+}
+
+void SceneUpdater::UpdateUpward(int i)
+{
+    bool changed = (mBoundChanged[i] != 0);
+    for (int child = i + 1; child < mEnd[i] && !changed; child = mEnd[child])
+    {
+        changed = (mBoundChanged[child] != 0);
+    }
+
+    if (changed)
+    {
+        mSpatial[i]->UpdateWorldBound();
+        mBoundChanged[i] = 1;
+    }
+}
@@ -0,0 +1,115 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+// Incremental update of the geometric state of a scene. Spatial::Update
+// recomputes the world transforms and world bounds of all the objects of a
+// subtree. SceneUpdater stores the objects of the scene in depth-first
+// order, which is a topological order of the hierarchy, and recomputes
+// only the world transforms of the objects marked by Spatial::MarkDirty and
+// of their descendants, and the world bounds of those objects and of their
+// ancestors. Subtrees without dirty objects are skipped in constant time,
+// so the update of a static scene costs almost nothing. The subtrees near
+// the root are partitioned among threads, which update them independently.
+//
+// Objects with controllers are visited on every update, and an object
+// whose controllers report an update is treated as dirty. A Node for which
+// CanFlattenUpdate() returns 'false' is updated by Spatial::Update on every
+// update, including its subtree. The controllers of different objects are
+// updated concurrently when more than one thread is used.
+
+namespace gte
+{
+    class Spatial;
+    class TaskScheduler;
+
+    class SceneUpdater
+    {
+    public:
+        // Construction and destruction.
+        virtual ~SceneUpdater() = default;
+        SceneUpdater();
+
+        // Store the objects of the scene. Call Flatten again after objects
+        // are attached to or detached from the scene or after controllers
+        // are attached to or detached from its objects. The first update
+        // after Flatten recomputes the world data of all the objects.
+        void Flatten(std::shared_ptr<Spatial> const& scene);
+
+        // Update the world data of the flattened scene. The subtrees are
+        // partitioned into numThreads groups, each updated by a std::thread
+        // object or, when a scheduler is set, into groups for the threads
+        // of the scheduler. The results are the same as those of
+        // Spatial::Update for the dirty objects.
+        void Update(double applicationTime = 0.0, unsigned int numThreads = 1);
+
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // The number of objects whose world data were computed by the last
+        // call to Update.
+        inline size_t GetNumUpdated() const
+        {
+            return mNumUpdated;
+        }
+
+    private:
+        enum FlatKind
+        {
+            FLAT_NODE,      // a Node whose children are stored
+            FLAT_LEAF,      // an object without children
+            FLAT_OTHER      // a Node updated by Spatial::Update
+        };
+
+        void FlattenSubtree(Spatial* spatial, int parent);
+
+        // Compute the world transform of object i, and the world bound of
+        // a leaf, when the object or its parent changed. The return value
+        // is 'true' when the children of the object must be visited.
+        bool UpdateDownward(int i, double applicationTime);
+
+        // Compute the world bound of node i when the bound of a child
+        // changed.
+        void UpdateUpward(int i);
+
+        // The objects in depth-first order. The subtree of object i
+        // consists of objects i through mEnd[i]-1 and its parent is
+        // mParent[i], which is -1 for the root.
+        std::shared_ptr<Spatial> mScene;
+        std::vector<Spatial*> mSpatial;
+        std::vector<int> mParent, mEnd;
+        std::vector<FlatKind> mKind;
+
+        // The subtree of object i has objects that must be visited on
+        // every update.
+        std::vector<unsigned char> mVolatile;
+
+        // The world transform (mTransformChanged) or world bound
+        // (mBoundChanged) of object i was recomputed by the current update.
+        // The flags are valid only for visited objects.
+        std::vector<unsigned char> mTransformChanged, mBoundChanged;
+
+        // The visited nodes of each group in depth-first order, for the
+        // upward pass.
+        std::vector<std::vector<int>> mVisited;
+
+        TaskScheduler* mScheduler;
+        size_t mNumUpdated;
+        bool mUpdateAll;
+    };
+}
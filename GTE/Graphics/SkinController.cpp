@@ -3,12 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/SkinController.h>
+#include <Graphics/GraphicsEngine.h>
 #include <Graphics/Node.h>
 #include <Graphics/Visual.h>
+#include <algorithm>
+#include <cstring>
 using namespace gte;
 
 SkinController::SkinController(int numVertices, int numBones, BufferUpdater const& postUpdate)
@@ -22,10 +25,20 @@ SkinController::SkinController(int numVertices, int numBones, BufferUpdater cons
     mPosition(nullptr),
     mStride(0),
     mFirstUpdate(true),
-    mCanUpdate(false)
+    mCanUpdate(false),
+    mNumSkinGroups(0)
 {
 }
 
+void SkinController::EnableGpuSkinning(std::shared_ptr<ProgramFactory> const& factory,
+    std::shared_ptr<GraphicsEngine> const& engine)
+{
+    LogAssert(factory != nullptr && engine != nullptr, "Invalid input.");
+    LogAssert(mFirstUpdate, "GPU skinning must be enabled before the first update.");
+    mFactory = factory;
+    mEngine = engine;
+}
+
 bool SkinController::Update(double applicationTime)
 {
     if (!Controller::Update(applicationTime))
@@ -55,6 +68,12 @@ bool SkinController::Update(double applicationTime)
             worldTransforms[bone] = mBones[bone].lock()->worldTransform;
         }
 
+        if (mEngine)
+        {
+            UpdateGpuSkinning(worldTransforms);
+            return true;
+        }
+
         // Compute the skin vertex locations.  The typecasting to raw 'float'
         // pointers increases the frame rate dramatically, both in Debug and
         // Release builds.  Without this in Debug builds, the lack of inlining
@@ -130,6 +149,10 @@ void SkinController::OnFirstUpdate()
                 mPosition = vbuffer->GetData() + offset;
                 mStride = vformat.GetVertexSize();
                 mCanUpdate = true;
+                if (mEngine)
+                {
+                    CreateGpuSkinning(vbuffer, offset);
+                }
                 break;
             }
         }
@@ -137,3 +160,214 @@ void SkinController::OnFirstUpdate()
 
     mCanUpdate = (mPosition != nullptr);
 }
+
+void SkinController::CreateGpuSkinning(VertexBuffer* vbuffer, unsigned int positionOffset)
+{
+    LogAssert(mStride % sizeof(uint32_t) == 0 && positionOffset % sizeof(uint32_t) == 0,
+        "The vertex layout must be 4-byte aligned.");
+
+    // Pack the nonzero weights, their offsets and bones, and compute the
+    // bounds of the offsets for the bones.
+    struct Influence
+    {
+        Vector4<float> offsetWeight;
+        uint32_t bone[4];
+    };
+
+    std::vector<Influence> influences;
+    std::vector<uint32_t> ranges(2 * static_cast<size_t>(mNumVertices));
+    std::vector<float> boneRadius(mNumBones, 0.0f);
+    float const* weights = mWeights.data();
+    Vector4<float> const* offsets = mOffsets.data();
+    for (int vertex = 0; vertex < mNumVertices; ++vertex)
+    {
+        ranges[2 * static_cast<size_t>(vertex)] = static_cast<uint32_t>(influences.size());
+        for (int bone = 0; bone < mNumBones; ++bone, ++weights, ++offsets)
+        {
+            if (*weights != 0.0f)
+            {
+                Influence influence;
+                influence.offsetWeight = { (*offsets)[0], (*offsets)[1], (*offsets)[2], *weights };
+                influence.bone[0] = static_cast<uint32_t>(bone);
+                influence.bone[1] = 0;
+                influence.bone[2] = 0;
+                influence.bone[3] = 0;
+                influences.push_back(influence);
+
+                Vector3<float> offset = HProject(*offsets);
+                boneRadius[bone] = std::max(boneRadius[bone], Length(offset));
+            }
+        }
+        ranges[2 * static_cast<size_t>(vertex) + 1] = static_cast<uint32_t>(influences.size()) -
+            ranges[2 * static_cast<size_t>(vertex)];
+    }
+
+    mBoneBounds.resize(mNumBones);
+    for (int bone = 0; bone < mNumBones; ++bone)
+    {
+        mBoneBounds[bone].SetCenter({ 0.0f, 0.0f, 0.0f });
+        mBoneBounds[bone].SetRadius(boneRadius[bone]);
+    }
+
+    unsigned int const numInfluences = std::max(static_cast<unsigned int>(influences.size()), 1u);
+    mInfluences = std::make_shared<StructuredBuffer>(numInfluences, sizeof(Influence));
+    std::memset(mInfluences->GetData(), 0, mInfluences->GetNumBytes());
+    if (influences.size() > 0)
+    {
+        std::memcpy(mInfluences->GetData(), influences.data(), influences.size() * sizeof(Influence));
+    }
+
+    mRanges = std::make_shared<StructuredBuffer>(static_cast<unsigned int>(ranges.size()),
+        sizeof(uint32_t));
+    std::memcpy(mRanges->GetData(), ranges.data(), mRanges->GetNumBytes());
+
+    mBoneTransforms = std::make_shared<StructuredBuffer>(mNumBones, sizeof(Matrix4x4<float>));
+    mBoneTransforms->SetUsage(Resource::DYNAMIC_UPDATE);
+
+    // The shader writes only the positions, so the other attributes of the
+    // vertices are those of the vertex buffer.
+    mSkinned = std::make_shared<StructuredBuffer>(
+        vbuffer->GetNumBytes() / sizeof(uint32_t), sizeof(uint32_t));
+    mSkinned->SetUsage(Resource::SHADER_OUTPUT);
+    std::memcpy(mSkinned->GetData(), vbuffer->GetData(), mSkinned->GetNumBytes());
+    vbuffer->SetUsage(Resource::SHADER_OUTPUT);
+
+    mNumSkinGroups = static_cast<unsigned int>((mNumVertices + 63) / 64);
+    int api = mFactory->GetAPI();
+    mFactory->PushDefines();
+    mFactory->defines.Set("NUM_VERTICES", mNumVertices);
+    mFactory->defines.Set("VERTEX_STRIDE", mStride / sizeof(uint32_t));
+    mFactory->defines.Set("POSITION_OFFSET", positionOffset / sizeof(uint32_t));
+    mSkinProgram = mFactory->CreateFromSource(*msSkinSource[api]);
+    mFactory->PopDefines();
+    mFactory = nullptr;
+
+    if (mSkinProgram)
+    {
+        auto cshader = mSkinProgram->GetComputeShader();
+        cshader->Set("influences", mInfluences);
+        cshader->Set("ranges", mRanges);
+        cshader->Set("boneTransforms", mBoneTransforms);
+        cshader->Set("skinned", mSkinned);
+    }
+    else
+    {
+        // Fall back to CPU skinning.
+        LogWarning("Failed to compile the skinning shader.");
+        mEngine = nullptr;
+    }
+}
+
+void SkinController::UpdateGpuSkinning(std::vector<Matrix4x4<float>> const& worldTransforms)
+{
+    std::memcpy(mBoneTransforms->GetData(), worldTransforms.data(), mBoneTransforms->GetNumBytes());
+    mEngine->Update(mBoneTransforms);
+    mEngine->Execute(mSkinProgram, mNumSkinGroups, 1, 1);
+
+    auto visual = static_cast<Visual*>(mObject);
+    mEngine->CopyGpuToGpu(mSkinned, visual->GetVertexBuffer());
+
+    // A skin vertex is a convex combination of points in the bounds of its
+    // bones.
+    BoundingSphere<float> modelBound, boneBound;
+    for (int bone = 0; bone < mNumBones; ++bone)
+    {
+        if (mBoneBounds[bone].GetRadius() > 0.0f)
+        {
+            mBoneBounds[bone].TransformBy(worldTransforms[bone], boneBound);
+            modelBound.GrowToContain(boneBound);
+        }
+    }
+    visual->modelBound = modelBound;
+}
+
+
+std::string const SkinController::msGLSLSkinSource =
+R"(
+    struct Influence
+    {
+        vec4 offsetWeight;      // (offset, weight)
+        uvec4 bone;             // (bone, 0, 0, 0)
+    };
+
+    buffer influences { Influence data[]; } influencesSB;
+    buffer ranges { uint data[]; } rangesSB;
+    buffer boneTransforms { mat4 data[]; } boneTransformsSB;
+    buffer skinned { uint data[]; } skinnedSB;
+
+    layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        uint v = gl_GlobalInvocationID.x;
+        if (v < uint(NUM_VERTICES))
+        {
+            uint first = rangesSB.data[2u * v];
+            uint last = first + rangesSB.data[2u * v + 1u];
+            vec3 position = vec3(0.0f);
+            for (uint i = first; i < last; ++i)
+            {
+                Influence influence = influencesSB.data[i];
+                vec4 offset = vec4(influence.offsetWeight.xyz, 1.0f);
+                mat4 transform = boneTransformsSB.data[influence.bone.x];
+            #if GTE_USE_MAT_VEC
+                position += influence.offsetWeight.w * (transform * offset).xyz;
+            #else
+                position += influence.offsetWeight.w * (offset * transform).xyz;
+            #endif
+            }
+
+            uint j = uint(VERTEX_STRIDE) * v + uint(POSITION_OFFSET);
+            skinnedSB.data[j] = floatBitsToUint(position.x);
+            skinnedSB.data[j + 1u] = floatBitsToUint(position.y);
+            skinnedSB.data[j + 2u] = floatBitsToUint(position.z);
+        }
+    }
+)";
+
+std::string const SkinController::msHLSLSkinSource =
+R"(
+    struct Influence
+    {
+        float4 offsetWeight;    // (offset, weight)
+        uint4 bone;             // (bone, 0, 0, 0)
+    };
+
+    StructuredBuffer<Influence> influences;
+    StructuredBuffer<uint> ranges;
+    StructuredBuffer<float4x4> boneTransforms;
+    RWStructuredBuffer<uint> skinned;
+
+    [numthreads(64, 1, 1)]
+    void CSMain(uint3 t : SV_DispatchThreadID)
+    {
+        uint v = t.x;
+        if (v < NUM_VERTICES)
+        {
+            uint first = ranges[2 * v];
+            uint last = first + ranges[2 * v + 1];
+            float3 position = float3(0.0f, 0.0f, 0.0f);
+            for (uint i = first; i < last; ++i)
+            {
+                Influence influence = influences[i];
+                float4 offset = float4(influence.offsetWeight.xyz, 1.0f);
+                float4x4 transform = boneTransforms[influence.bone.x];
+            #if GTE_USE_MAT_VEC
+                position += influence.offsetWeight.w * mul(transform, offset).xyz;
+            #else
+                position += influence.offsetWeight.w * mul(offset, transform).xyz;
+            #endif
+            }
+
+            uint j = VERTEX_STRIDE * v + POSITION_OFFSET;
+            skinned[j] = asuint(position.x);
+            skinned[j + 1] = asuint(position.y);
+            skinned[j + 2] = asuint(position.z);
+        }
+    }
+)";
+
+ProgramSources const SkinController::msSkinSource =
+{
+    &msGLSLSkinSource,
+    &msHLSLSkinSource
+};
@@ -3,16 +3,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Graphics/Controller.h>
+#include <Graphics/BoundingSphere.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/StructuredBuffer.h>
 #include <Graphics/VertexBuffer.h>
 #include <Mathematics/Vector4.h>
 
 namespace gte
 {
+    class GraphicsEngine;
     class Node;
 
     class SkinController : public Controller
@@ -55,6 +59,27 @@ namespace gte
             return mOffsets;
         }
 
+        // GPU skinning.  The blending is performed by a compute shader that
+        // writes the positions to a structured buffer, which is copied to the
+        // vertex buffer of the controlled object, so the CPU cost of an
+        // update is proportional to the number of bones and the vertex
+        // buffer is not uploaded.  The nonzero weights and their offsets are
+        // packed into GPU buffers on the first update, so the weights and
+        // offsets must be set before that update and are not read after it.
+        // The first update also sets the usage of the vertex buffer to
+        // SHADER_OUTPUT, so it must occur before the object is drawn.  The
+        // model bound is the union of the bounds of the bones, which
+        // contains the skin because the weights of a vertex sum to 1.  The
+        // CPU data of the vertex buffer and the model normals are not
+        // updated, and the post-update function is not called.
+        void EnableGpuSkinning(std::shared_ptr<ProgramFactory> const& factory,
+            std::shared_ptr<GraphicsEngine> const& engine);
+
+        inline bool IsGpuSkinning() const
+        {
+            return mEngine != nullptr;
+        }
+
         // The animation update.  The application time is in milliseconds.
         virtual bool Update(double applicationTime) override;
 
@@ -65,6 +90,10 @@ namespace gte
         // is constructed.
         void OnFirstUpdate();
 
+        // Support for GPU skinning.
+        void CreateGpuSkinning(VertexBuffer* vbuffer, unsigned int positionOffset);
+        void UpdateGpuSkinning(std::vector<Matrix4x4<float>> const& worldTransforms);
+
         int mNumVertices;
         int mNumBones;
 
@@ -81,5 +110,26 @@ namespace gte
         char* mPosition;
         unsigned int mStride;
         bool mFirstUpdate, mCanUpdate;
+
+        // GPU skinning.  The influences of vertex v are the elements
+        // [ranges[2*v],ranges[2*v]+ranges[2*v+1]) of mInfluences.  The
+        // skinned vertices are a copy of the vertex buffer data whose
+        // positions are written by the shader.  The bone bound is the bound
+        // of the offsets of the bone, with radius 0 when the bone has no
+        // influence.
+        std::shared_ptr<ProgramFactory> mFactory;
+        std::shared_ptr<GraphicsEngine> mEngine;
+        std::shared_ptr<StructuredBuffer> mInfluences;
+        std::shared_ptr<StructuredBuffer> mRanges;
+        std::shared_ptr<StructuredBuffer> mBoneTransforms;
+        std::shared_ptr<StructuredBuffer> mSkinned;
+        std::shared_ptr<ComputeProgram> mSkinProgram;
+        std::vector<BoundingSphere<float>> mBoneBounds;
+        unsigned int mNumSkinGroups;
+
+        // Shader source code as strings.
+        static std::string const msGLSLSkinSource;
+        static std::string const msHLSLSkinSource;
+        static ProgramSources const msSkinSource;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Spatial.h>
@@ -21,7 +21,9 @@ Spatial::Spatial()
     worldTransformIsCurrent(false),
     culling(CULL_DYNAMIC),
     worldBoundIsCurrent(false),
-    mParent(nullptr)
+    mParent(nullptr),
+    mDirty(true),
+    mSubtreeDirty(true)
 {
 }
 
@@ -33,6 +35,17 @@ void Spatial::Update(double applicationTime, bool initiator)
     {
         PropagateBoundToRoot();
     }
+    mDirty = false;
+    mSubtreeDirty = false;
+}
+
+void Spatial::MarkDirty()
+{
+    mDirty = true;
+    for (Spatial* spatial = this; spatial && !spatial->mSubtreeDirty; spatial = spatial->mParent)
+    {
+        spatial->mSubtreeDirty = true;
+    }
 }
 
 void Spatial::OnGetVisibleSet(Culler& culler, std::shared_ptr<Camera> const& camera,
@@ -62,6 +75,11 @@ void Spatial::UpdateWorldData(double applicationTime)
     UpdateControllers(applicationTime);
 
     // Update world transforms.
+    UpdateWorldTransform();
+}
+
+void Spatial::UpdateWorldTransform()
+{
     if (!worldTransformIsCurrent)
     {
         if (mParent)
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -36,6 +36,20 @@ namespace gte
         // time is in milliseconds.
         void Update(double applicationTime = 0.0, bool initiator = true);
 
+        // Support for incremental updates by SceneUpdater, which recomputes
+        // only the world data of objects that are marked as dirty, of their
+        // descendants and of the world bounds of their ancestors. Call
+        // MarkDirty after modifying localTransform, or worldTransform when
+        // worldTransformIsCurrent is 'true', or the modelBound of a Visual.
+        // The function marks the ancestors as having a dirty descendant.
+        // Update clears the flags of the objects it visits.
+        void MarkDirty();
+
+        inline bool IsDirty() const
+        {
+            return mDirty;
+        }
+
         // Access to the parent object, which is null for the root of the
         // hierarchy.
         inline Spatial* GetParent()
@@ -83,6 +97,7 @@ namespace gte
         // Support for geometric updates.
         virtual void UpdateWorldData(double applicationTime);
         virtual void UpdateWorldBound() = 0;
+        void UpdateWorldTransform();
         void PropagateBoundToRoot();
 
     private:
@@ -94,5 +109,12 @@ namespace gte
         // std::weak_ptr to avoid the cycle because we do not know the
         // shared_ptr object that owns mParent.
         Spatial* mParent;
+
+        // Support for incremental updates. The object was modified since
+        // its last update (mDirty) or the object or one of its descendants
+        // was modified (mSubtreeDirty).
+        friend class SceneUpdater;
+        bool mDirty;
+        bool mSubtreeDirty;
     };
 }
@@ -0,0 +1,704 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/StreamingTerrain.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+using namespace gte;
+
+StreamingTerrain::Tile::Tile()
+    :
+    level(0),
+    x(0),
+    y(0),
+    minHeight(0.0f),
+    maxHeight(0.0f),
+    lastUsed(0),
+    minMorph(0.0f),
+    maxMorph(0.0f)
+{
+}
+
+StreamingTerrain::~StreamingTerrain()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+    for (auto& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+StreamingTerrain::StreamingTerrain(unsigned int numLevels, unsigned int size,
+    float minElevation, float maxElevation, float spacing,
+    VertexFormat const& vformat, std::shared_ptr<Camera> const& camera,
+    std::shared_ptr<VisualEffect> const& effect, TileLoader const& loader,
+    BufferUpdater const& updater, size_t memoryBudget, unsigned int numThreads)
+    :
+    mNumLevels(numLevels),
+    mSize(size),
+    mMinElevation(minElevation),
+    mMaxElevation(maxElevation),
+    mElevationScale((maxElevation - minElevation) / 65535.0f),
+    mSpacing(spacing),
+    mLength(0.0f),
+    mLODFactor(2.5f),
+    mMemoryBudget(memoryBudget),
+    mTileBytes(0),
+    mVFormat(vformat),
+    mNormalOffset(-1),
+    mTCoordOffset(-1),
+    mCamera(camera),
+    mEffect(effect),
+    mLoader(loader),
+    mUpdater(updater),
+    mFrame(0),
+    mStop(false)
+{
+    LogAssert(numLevels >= 1 && numLevels <= 16, "Invalid number of levels.");
+    LogAssert(mSize == 3 || mSize == 5 || mSize == 9 || mSize == 17 || mSize == 33
+        || mSize == 65 || mSize == 129 || mSize == 257, "Invalid tile size.");
+    LogAssert(minElevation <= maxElevation, "Invalid ordering of elevation extremes.");
+    LogAssert(spacing > 0.0f, "Spacing must be positive.");
+    LogAssert(mCamera != nullptr && mEffect != nullptr && mLoader && mUpdater,
+        "Camera, effect, loader and updater must exist.");
+    LogAssert(numThreads > 0, "At least one thread is required.");
+
+    int index = vformat.GetIndex(VA_POSITION, 0);
+    LogAssert(index >= 0, "Vertex format does not have VA_POSITION.");
+
+    DFType type = vformat.GetType(index);
+    LogAssert(type == DF_R32G32B32_FLOAT || type == DF_R32G32B32A32_FLOAT,
+        "VertexFormat type is not supported.");
+
+    unsigned int offset = vformat.GetOffset(index);
+    LogAssert(offset == 0, "VertexFormat offset must be 0.");
+
+    index = vformat.GetIndex(VA_NORMAL, 0);
+    if (index >= 0)
+    {
+        LogAssert(vformat.GetType(index) == DF_R32G32B32_FLOAT,
+            "VertexFormat normal type is not supported.");
+        mNormalOffset = static_cast<int>(vformat.GetOffset(index));
+    }
+
+    index = vformat.GetIndex(VA_TEXCOORD, 0);
+    if (index >= 0)
+    {
+        LogAssert(vformat.GetType(index) == DF_R32G32_FLOAT,
+            "VertexFormat texture coordinate type is not supported.");
+        mTCoordOffset = static_cast<int>(vformat.GetOffset(index));
+    }
+
+    mLength = GetTileLength(0);
+
+    // A tile has Size*Size heights, Size*Size grid vertices and 4*Size
+    // skirt vertices.
+    size_t numVertices = static_cast<size_t>(mSize) * static_cast<size_t>(mSize + 4);
+    mTileBytes = static_cast<size_t>(mSize) * static_cast<size_t>(mSize) * sizeof(unsigned short)
+        + numVertices * static_cast<size_t>(vformat.GetVertexSize());
+
+    CreateIndexBuffer();
+
+    // The root tile is required for the selection, so it is loaded by the
+    // caller thread.
+    mRoot = LoadTile(0, 0, 0);
+    LogAssert(mRoot != nullptr, "The root tile cannot be loaded.");
+    mTiles.insert(std::make_pair(GetKey(0, 0, 0), mRoot));
+
+    mThreads.reserve(numThreads);
+    for (unsigned int i = 0; i < numThreads; ++i)
+    {
+        mThreads.push_back(std::thread([this]() { WorkerThread(); }));
+    }
+}
+
+void StreamingTerrain::SetLODFactor(float lodFactor)
+{
+    LogAssert(lodFactor >= 2.0f, "The LOD factor must be at least 2.");
+    mLODFactor = lodFactor;
+}
+
+void StreamingTerrain::SetMemoryBudget(size_t memoryBudget)
+{
+    mMemoryBudget = memoryBudget;
+}
+
+size_t StreamingTerrain::GetNumPendingTiles() const
+{
+    return mRequested.size();
+}
+
+float StreamingTerrain::GetHeight(float x, float y) const
+{
+    x = std::min(std::max(x, 0.0f), mLength);
+    y = std::min(std::max(y, 0.0f), mLength);
+
+    // Descend to the finest loaded tile containing (x,y).
+    Tile const* tile = mRoot.get();
+    for (unsigned int level = 1; level < mNumLevels; ++level)
+    {
+        float length = GetTileLength(level);
+        unsigned int maxIndex = (1u << level) - 1u;
+        unsigned int tx = std::min(static_cast<unsigned int>(x / length), maxIndex);
+        unsigned int ty = std::min(static_cast<unsigned int>(y / length), maxIndex);
+        auto iter = mTiles.find(GetKey(level, tx, ty));
+        if (iter == mTiles.end())
+        {
+            break;
+        }
+        tile = iter->second.get();
+    }
+
+    // Interpolate on the triangle of the tile mesh that contains (x,y).
+    // The cell (row,col) is split by the diagonal from (row,col) to
+    // (row+1,col+1).
+    float length = GetTileLength(tile->level);
+    float step = length / static_cast<float>(mSize - 1);
+    float xGrid = (x - static_cast<float>(tile->x) * length) / step;
+    float yGrid = (y - static_cast<float>(tile->y) * length) / step;
+    float maxGrid = static_cast<float>(mSize - 2);
+    float fCol = std::min(std::max(std::floor(xGrid), 0.0f), maxGrid);
+    float fRow = std::min(std::max(std::floor(yGrid), 0.0f), maxGrid);
+    float dx = xGrid - fCol;
+    float dy = yGrid - fRow;
+    size_t i = static_cast<size_t>(fCol) + mSize * static_cast<size_t>(fRow);
+    float h00 = GetElevation(tile->heights[i]);
+    float h11 = GetElevation(tile->heights[i + mSize + 1]);
+    if (dx >= dy)
+    {
+        float h10 = GetElevation(tile->heights[i + 1]);
+        return (1.0f - dx) * h00 + (dx - dy) * h10 + dy * h11;
+    }
+    else
+    {
+        float h01 = GetElevation(tile->heights[i + mSize]);
+        return (1.0f - dy) * h00 + (dy - dx) * h01 + dx * h11;
+    }
+}
+
+void StreamingTerrain::OnCameraMotion()
+{
+    // Get the camera location in the model space of the terrain.
+    Vector4<float> worldEye = mCamera->GetPosition();
+#if defined(GTE_USE_MAT_VEC)
+    Vector4<float> modelEye = worldTransform.Inverse() * worldEye;
+#else
+    Vector4<float> modelEye = worldEye * worldTransform.Inverse();
+#endif
+    Vector3<float> eye{ modelEye[0], modelEye[1], modelEye[2] };
+
+    ++mFrame;
+    ReceiveTiles();
+
+    // Select the tiles to draw and collect the tiles to load.
+    std::vector<Tile*> previous = std::move(mSelected);
+    mSelected.clear();
+    std::vector<std::pair<float, TileKey>> requests;
+    Select(*mRoot, eye, requests);
+
+    // Morph the vertices of the selected tiles. A tile whose vertices all
+    // have the same morph factor as the last time they were computed is
+    // not modified.
+    for (auto tile : mSelected)
+    {
+        float minMorph = GetMorph(tile->level, GetDistanceToBox(*tile, eye));
+        float maxMorph = GetMorph(tile->level, GetMaxDistanceToBox(*tile, eye));
+        if (minMorph != maxMorph || minMorph != tile->minMorph || maxMorph != tile->maxMorph)
+        {
+            SetVertices(*tile, eye, true);
+            mUpdater(tile->visual->GetVertexBuffer());
+        }
+    }
+
+    if (mSelected != previous)
+    {
+        DetachAllChildren();
+        for (auto tile : mSelected)
+        {
+            AttachChild(tile->visual);
+        }
+        Update();
+    }
+
+    RequestTiles(requests);
+}
+
+std::shared_ptr<StreamingTerrain::Tile> StreamingTerrain::LoadTile(
+    unsigned int level, unsigned int x, unsigned int y) const
+{
+    auto tile = std::make_shared<Tile>();
+    tile->level = level;
+    tile->x = x;
+    tile->y = y;
+    if (!mLoader(level, x, y, tile->heights) || tile->heights.size() < mSize * mSize)
+    {
+        return nullptr;
+    }
+    tile->heights.resize(mSize * mSize);
+
+    auto extremes = std::minmax_element(tile->heights.begin(), tile->heights.end());
+    tile->minHeight = GetElevation(*extremes.first);
+    tile->maxHeight = GetElevation(*extremes.second);
+
+    unsigned int numVertices = mSize * (mSize + 4);
+    auto vbuffer = std::make_shared<VertexBuffer>(mVFormat, numVertices);
+    vbuffer->SetUsage(Resource::DYNAMIC_UPDATE);
+    std::memset(vbuffer->GetData(), 0, vbuffer->GetNumBytes());
+    tile->visual = std::make_shared<Visual>(vbuffer, mIBuffer, mEffect);
+    SetVertices(*tile, Vector3<float>::Zero(), false);
+
+    // The normals and texture coordinates do not depend on the morphing.
+    // The skirt vertices copy those of the edge vertices.
+    if (mNormalOffset >= 0 || mTCoordOffset >= 0)
+    {
+        int n = static_cast<int>(mSize);
+        float length = GetTileLength(level);
+        float step = length / static_cast<float>(n - 1);
+        char* data = vbuffer->GetData();
+        size_t vertexSize = static_cast<size_t>(mVFormat.GetVertexSize());
+        auto H = [this, &tile, n](int row, int col)
+        {
+            row = std::min(std::max(row, 0), n - 1);
+            col = std::min(std::max(col, 0), n - 1);
+            return GetElevation(tile->heights[static_cast<size_t>(col + n * row)]);
+        };
+
+        auto setAttributes = [&](unsigned int v, int row, int col)
+        {
+            char* vertex = data + v * vertexSize;
+            if (mNormalOffset >= 0)
+            {
+                float dx = static_cast<float>(std::min(col + 1, n - 1) - std::max(col - 1, 0));
+                float dy = static_cast<float>(std::min(row + 1, n - 1) - std::max(row - 1, 0));
+                Vector3<float> normal
+                {
+                    (H(row, col - 1) - H(row, col + 1)) / (dx * step),
+                    (H(row - 1, col) - H(row + 1, col)) / (dy * step),
+                    1.0f
+                };
+                Normalize(normal);
+                *reinterpret_cast<Vector3<float>*>(vertex + mNormalOffset) = normal;
+            }
+            if (mTCoordOffset >= 0)
+            {
+                Vector2<float>& tcoord = *reinterpret_cast<Vector2<float>*>(vertex + mTCoordOffset);
+                tcoord[0] = (static_cast<float>(x) * length + static_cast<float>(col) * step) / mLength;
+                tcoord[1] = (static_cast<float>(y) * length + static_cast<float>(row) * step) / mLength;
+            }
+        };
+
+        unsigned int const skirt = mSize * mSize;
+        for (int row = 0; row < n; ++row)
+        {
+            for (int col = 0; col < n; ++col)
+            {
+                setAttributes(static_cast<unsigned int>(col + n * row), row, col);
+            }
+        }
+        for (unsigned int i = 0; i < mSize; ++i)
+        {
+            int k = static_cast<int>(i);
+            setAttributes(skirt + i, 0, k);
+            setAttributes(skirt + mSize + i, n - 1, k);
+            setAttributes(skirt + 2 * mSize + i, k, 0);
+            setAttributes(skirt + 3 * mSize + i, k, n - 1);
+        }
+    }
+
+    // The morphed heights are between the extremes of the tile heights, so
+    // the bound of the unmorphed vertices contains the morphed vertices.
+    tile->visual->UpdateModelBound();
+    return tile;
+}
+
+void StreamingTerrain::WorkerThread()
+{
+    for (;;)
+    {
+        TileKey key;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStop || !mQueue.empty(); });
+            if (mStop)
+            {
+                return;
+            }
+            key = mQueue.front();
+            mQueue.pop_front();
+        }
+
+        unsigned int level = static_cast<unsigned int>(key >> 48);
+        unsigned int y = static_cast<unsigned int>((key >> 24) & 0xFFFFFF);
+        unsigned int x = static_cast<unsigned int>(key & 0xFFFFFF);
+        auto tile = LoadTile(level, x, y);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mResults.push_back({ key, tile });
+    }
+}
+
+float StreamingTerrain::GetTileLength(unsigned int level) const
+{
+    // The samples of level L have spacing 2^(numLevels-1-L) times the
+    // finest spacing.
+    float scale = static_cast<float>(1u << (mNumLevels - 1 - level));
+    return mSpacing * scale * static_cast<float>(mSize - 1);
+}
+
+float StreamingTerrain::GetDistanceToBox(Tile const& tile, Vector3<float> const& eye) const
+{
+    float length = GetTileLength(tile.level);
+    float xmin = static_cast<float>(tile.x) * length;
+    float ymin = static_cast<float>(tile.y) * length;
+    Vector3<float> boxMin{ xmin, ymin, tile.minHeight };
+    Vector3<float> boxMax{ xmin + length, ymin + length, tile.maxHeight };
+    float sqrDistance = 0.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float diff = 0.0f;
+        if (eye[i] < boxMin[i])
+        {
+            diff = boxMin[i] - eye[i];
+        }
+        else if (eye[i] > boxMax[i])
+        {
+            diff = eye[i] - boxMax[i];
+        }
+        sqrDistance += diff * diff;
+    }
+    return std::sqrt(sqrDistance);
+}
+
+float StreamingTerrain::GetMaxDistanceToBox(Tile const& tile, Vector3<float> const& eye) const
+{
+    float length = GetTileLength(tile.level);
+    float xmin = static_cast<float>(tile.x) * length;
+    float ymin = static_cast<float>(tile.y) * length;
+    Vector3<float> boxMin{ xmin, ymin, tile.minHeight };
+    Vector3<float> boxMax{ xmin + length, ymin + length, tile.maxHeight };
+    float sqrDistance = 0.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        float diff = std::max(std::fabs(eye[i] - boxMin[i]), std::fabs(eye[i] - boxMax[i]));
+        sqrDistance += diff * diff;
+    }
+    return std::sqrt(sqrDistance);
+}
+
+float StreamingTerrain::GetMorph(unsigned int level, float distance) const
+{
+    if (level == 0)
+    {
+        return 0.0f;
+    }
+
+    // The tile is selected only when the distance to its parent is smaller
+    // than the range of the parent. The morph factor increases from 0 to 1
+    // on the last 15 percent of that range, so the vertices match those of
+    // the parent at the distance where the parent is no longer refined.
+    // The vertices of the tile are closer than 1.7 times that range when
+    // the LOD factor is at least 2, so a coarser neighbor that starts
+    // morphing at 0.85 times its own range (twice the range of the parent)
+    // is not morphed along the shared edge.
+    float range = mLODFactor * GetTileLength(level - 1);
+    float morph = (distance - 0.85f * range) / (0.15f * range);
+    return std::min(std::max(morph, 0.0f), 1.0f);
+}
+
+void StreamingTerrain::SetVertices(Tile& tile, Vector3<float> const& eye, bool morph) const
+{
+    int n = static_cast<int>(mSize);
+    float length = GetTileLength(tile.level);
+    float step = length / static_cast<float>(n - 1);
+    float xOrigin = static_cast<float>(tile.x) * length;
+    float yOrigin = static_cast<float>(tile.y) * length;
+    float skirtDepth = tile.maxHeight - tile.minHeight + step;
+    morph = morph && tile.level > 0;
+
+    auto vbuffer = tile.visual->GetVertexBuffer();
+    char* data = vbuffer->GetData();
+    size_t vertexSize = static_cast<size_t>(mVFormat.GetVertexSize());
+    auto H = [this, &tile, n](int row, int col)
+    {
+        return GetElevation(tile.heights[static_cast<size_t>(col + n * row)]);
+    };
+
+    auto position = [data, vertexSize](unsigned int v) -> Vector3<float>&
+    {
+        return *reinterpret_cast<Vector3<float>*>(data + v * vertexSize);
+    };
+
+    float minMorph = 1.0f, maxMorph = 0.0f;
+    for (int row = 0; row < n; ++row)
+    {
+        float y = yOrigin + step * static_cast<float>(row);
+        for (int col = 0; col < n; ++col)
+        {
+            float x = xOrigin + step * static_cast<float>(col);
+            float z = H(row, col);
+            if (morph)
+            {
+                // The height of the parent surface at the vertex. The parent
+                // has the even samples, and its triangles are split along the
+                // same diagonal as those of the tile, so the surface at an
+                // odd sample is the average of the samples at the ends of the
+                // parent edge that contains it.
+                float parentZ;
+                if ((row & 1) == 0)
+                {
+                    parentZ = ((col & 1) == 0 ? z : 0.5f * (H(row, col - 1) + H(row, col + 1)));
+                }
+                else if ((col & 1) == 0)
+                {
+                    parentZ = 0.5f * (H(row - 1, col) + H(row + 1, col));
+                }
+                else
+                {
+                    parentZ = 0.5f * (H(row - 1, col - 1) + H(row + 1, col + 1));
+                }
+
+                float distance = Length(Vector3<float>{ x, y, z } - eye);
+                float t = GetMorph(tile.level, distance);
+                minMorph = std::min(minMorph, t);
+                maxMorph = std::max(maxMorph, t);
+                z += t * (parentZ - z);
+            }
+            position(static_cast<unsigned int>(col + n * row)) = { x, y, z };
+        }
+    }
+
+    if (!morph)
+    {
+        minMorph = 0.0f;
+        maxMorph = 0.0f;
+    }
+    tile.minMorph = minMorph;
+    tile.maxMorph = maxMorph;
+
+    // The skirt vertices are below the edge vertices.
+    unsigned int const size = mSize;
+    unsigned int const skirt = size * size;
+    for (unsigned int i = 0; i < size; ++i)
+    {
+        unsigned int edge[4] = { i, i + size * (size - 1), size * i, size * i + size - 1 };
+        for (unsigned int j = 0; j < 4; ++j)
+        {
+            Vector3<float> const& p = position(edge[j]);
+            position(skirt + j * size + i) = { p[0], p[1], p[2] - skirtDepth };
+        }
+    }
+}
+
+void StreamingTerrain::ReceiveTiles()
+{
+    std::vector<LoadResult> results;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        results.swap(mResults);
+    }
+
+    for (auto const& result : results)
+    {
+        mRequested.erase(result.key);
+        if (result.tile)
+        {
+            result.tile->lastUsed = mFrame;
+            mTiles.insert(std::make_pair(result.key, result.tile));
+        }
+        else
+        {
+            mFailed.insert(result.key);
+        }
+    }
+}
+
+void StreamingTerrain::Select(Tile& tile, Vector3<float> const& eye,
+    std::vector<std::pair<float, TileKey>>& requests)
+{
+    tile.lastUsed = mFrame;
+
+    unsigned int childLevel = tile.level + 1;
+    if (childLevel < mNumLevels)
+    {
+        float distance = GetDistanceToBox(tile, eye);
+        if (distance < mLODFactor * GetTileLength(tile.level))
+        {
+            // Refine when the 4 children are loaded; otherwise, request the
+            // missing children. The loaded children are marked as used so
+            // that they are not evicted while their siblings are loading.
+            std::array<Tile*, 4> children{};
+            bool loaded = true;
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                TileKey key = GetKey(childLevel, 2 * tile.x + (i & 1), 2 * tile.y + (i >> 1));
+                auto iter = mTiles.find(key);
+                if (iter != mTiles.end())
+                {
+                    children[i] = iter->second.get();
+                    children[i]->lastUsed = mFrame;
+                }
+                else
+                {
+                    loaded = false;
+                    if (mFailed.find(key) == mFailed.end()
+                        && mRequested.find(key) == mRequested.end())
+                    {
+                        requests.push_back(std::make_pair(distance, key));
+                    }
+                }
+            }
+
+            if (loaded)
+            {
+                for (auto child : children)
+                {
+                    Select(*child, eye, requests);
+                }
+                return;
+            }
+        }
+    }
+
+    mSelected.push_back(&tile);
+}
+
+void StreamingTerrain::EvictTiles(size_t numRequests)
+{
+    size_t numTiles = mTiles.size() + mRequested.size() + numRequests;
+    if (numTiles * mTileBytes <= mMemoryBudget)
+    {
+        return;
+    }
+
+    // Evict the least recently used tiles, the finer tiles first when they
+    // were last used in the same frame. The root and the tiles used in this
+    // frame are kept.
+    std::vector<std::pair<std::pair<uint64_t, unsigned int>, TileKey>> candidates;
+    for (auto const& element : mTiles)
+    {
+        Tile const& tile = *element.second;
+        if (tile.lastUsed < mFrame && tile.level > 0)
+        {
+            candidates.push_back(std::make_pair(
+                std::make_pair(tile.lastUsed, mNumLevels - tile.level), element.first));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (auto const& candidate : candidates)
+    {
+        if (numTiles * mTileBytes <= mMemoryBudget)
+        {
+            break;
+        }
+        mTiles.erase(candidate.second);
+        --numTiles;
+    }
+}
+
+void StreamingTerrain::RequestTiles(std::vector<std::pair<float, TileKey>>& requests)
+{
+    // The queued tiles that have not been started are replaced by the
+    // requests of this frame, the closest tiles first. The number of
+    // pending tiles is limited so that the queue follows the camera.
+    std::sort(requests.begin(), requests.end());
+    size_t const maxPending = 4 * mThreads.size();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto key : mQueue)
+    {
+        mRequested.erase(key);
+    }
+    mQueue.clear();
+
+    size_t numRequests = 0;
+    if (mRequested.size() < maxPending)
+    {
+        numRequests = std::min(requests.size(), maxPending - mRequested.size());
+    }
+    EvictTiles(numRequests);
+
+    for (size_t i = 0; i < numRequests; ++i)
+    {
+        size_t numTiles = mTiles.size() + mRequested.size() + 1;
+        if (numTiles * mTileBytes > mMemoryBudget)
+        {
+            break;
+        }
+        mQueue.push_back(requests[i].second);
+        mRequested.insert(requests[i].second);
+    }
+
+    if (!mQueue.empty())
+    {
+        mCondition.notify_all();
+    }
+}
+
+void StreamingTerrain::CreateIndexBuffer()
+{
+    // The grid triangles are those of MeshFactory::CreateRectangle. The
+    // skirt triangles face away from the tile.
+    uint32_t const n = mSize;
+    uint32_t numTriangles = 2 * (n - 1) * (n - 1) + 8 * (n - 1);
+    mIBuffer = std::make_shared<IndexBuffer>(IP_TRIMESH, numTriangles, sizeof(uint32_t));
+
+    uint32_t t = 0;
+    for (uint32_t row = 0; row + 1 < n; ++row)
+    {
+        for (uint32_t col = 0; col + 1 < n; ++col)
+        {
+            uint32_t v0 = col + n * row;
+            uint32_t v1 = v0 + 1;
+            uint32_t v2 = v1 + n;
+            uint32_t v3 = v0 + n;
+            mIBuffer->SetTriangle(t++, v0, v1, v2);
+            mIBuffer->SetTriangle(t++, v0, v2, v3);
+        }
+    }
+
+    uint32_t const skirt = n * n;
+    for (uint32_t i = 0; i + 1 < n; ++i)
+    {
+        // The edge at row 0 faces -y.
+        uint32_t e0 = i, e1 = i + 1, s0 = skirt + i, s1 = s0 + 1;
+        mIBuffer->SetTriangle(t++, e0, s0, s1);
+        mIBuffer->SetTriangle(t++, e0, s1, e1);
+
+        // The edge at row n-1 faces +y.
+        e0 = i + n * (n - 1);
+        e1 = e0 + 1;
+        s0 = skirt + n + i;
+        s1 = s0 + 1;
+        mIBuffer->SetTriangle(t++, e0, s1, s0);
+        mIBuffer->SetTriangle(t++, e0, e1, s1);
+
+        // The edge at column 0 faces -x.
+        e0 = n * i;
+        e1 = e0 + n;
+        s0 = skirt + 2 * n + i;
+        s1 = s0 + 1;
+        mIBuffer->SetTriangle(t++, e0, s1, s0);
+        mIBuffer->SetTriangle(t++, e0, e1, s1);
+
+        // The edge at column n-1 faces +x.
+        e0 = n * i + n - 1;
+        e1 = e0 + n;
+        s0 = skirt + 3 * n + i;
+        s1 = s0 + 1;
+        mIBuffer->SetTriangle(t++, e0, s0, s1);
+        mIBuffer->SetTriangle(t++, e0, s1, e1);
+    }
+}
@@ -0,0 +1,284 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/Node.h>
+#include <Graphics/Buffer.h>
+#include <Graphics/Camera.h>
+#include <Graphics/Visual.h>
+#include <Mathematics/Vector2.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// A terrain whose heights are too large to be stored in memory. The height
+// field is partitioned into a quadtree of tiles, each tile a Size-by-Size
+// array of heights. The root tile (level 0) covers the entire terrain and
+// the tiles of level numLevels-1 have the finest spacing; a tile of level L
+// has 4 children of level L+1 that cover its quadrants with twice the
+// sample density. The terrain has (Size-1)*2^(numLevels-1)+1 samples per
+// side at the finest level, so Size = 129 and numLevels = 10 is a terrain
+// of 65537-by-65537 samples.
+//
+// The tiles are loaded on demand by worker threads that call an
+// application-provided loader, typically reading files, and that create the
+// vertex buffers of the tiles. OnCameraMotion must be called once per
+// frame. It selects the tiles to draw using the distance from the camera
+// to the tiles (a tile is refined when the camera is closer than
+// lodFactor times the tile width and its 4 children are loaded), requests
+// the tiles needed to refine further and evicts the least recently used
+// tiles when the loaded tiles exceed the memory budget. The vertices of a
+// selected tile are morphed toward the surface of its parent tile as the
+// distance approaches the range of the parent, so that tiles appear and
+// disappear without popping and the shared edges of tiles of adjacent
+// levels match. Each tile has skirts, vertical strips hanging from its
+// edges, to hide the cracks that remain while the finer tiles are still
+// loading.
+//
+// The tiles are the children of the terrain node and share the effect
+// passed to the constructor, so the PVW matrix of the effect is updated
+// with a subscription of the world matrix of the terrain node, for example
+//   pvwMatrices.Subscribe(terrain->worldTransform, effect->GetPVWMatrixConstant());
+// The graphics engine objects of a tile are created the first time it is
+// drawn. The morphed vertex buffers are copied to the GPU by the updater
+// passed to the constructor, and the graphics engine objects of evicted
+// tiles are released by the application when it tracks them (for example,
+// with GraphicsObject listeners).
+
+namespace gte
+{
+    class StreamingTerrain : public Node
+    {
+    public:
+        // The loader stores the Size*Size heights of tile (x,y) of the
+        // specified level in row-major order; x and y are in
+        // {0,...,2^level-1}. The sample (row,col) of the tile is the sample
+        // (y*(Size-1)+row, x*(Size-1)+col)*2^(numLevels-1-level) of the
+        // finest level. The return value is 'false' when the tile cannot be
+        // loaded; the tile is then not refined. The loader is called
+        // concurrently by the worker threads.
+        typedef std::function<bool(unsigned int, unsigned int, unsigned int,
+            std::vector<unsigned short>&)> TileLoader;
+
+        // Construction and destruction. The following preconditions must be
+        // satisfied:
+        //   1. numLevels is in {1,...,16}.
+        //   2. Size = 2^p + 1 for 1 <= p <= 8.
+        //   3. The elevation extremes satisfy minElevation <= maxElevation.
+        //      A height h is mapped to the elevation
+        //      minElevation + (maxElevation-minElevation)*h/65535.
+        //   4. The samples of the finest level are square with spacing > 0.
+        //   5. The vformat has first Bind call using VA_POSITION. The data
+        //      type can be DF_R32G32B32_FLOAT or DF_R32G32B32A32_FLOAT. The
+        //      unit must be 0. A VA_NORMAL (DF_R32G32B32_FLOAT) and a
+        //      VA_TEXCOORD of unit 0 (DF_R32G32_FLOAT) are optional; the
+        //      normals are computed from the heights and the texture
+        //      coordinates are in [0,1]^2 over the entire terrain.
+        //   6. The camera, effect, loader and updater are not null.
+        //   7. numThreads > 0.
+        // The memory budget is for the heights and the vertices of the
+        // loaded tiles; the root tile is always loaded. The root tile is
+        // loaded by the constructor.
+        virtual ~StreamingTerrain();
+
+        StreamingTerrain(unsigned int numLevels, unsigned int size,
+            float minElevation, float maxElevation, float spacing,
+            VertexFormat const& vformat, std::shared_ptr<Camera> const& camera,
+            std::shared_ptr<VisualEffect> const& effect, TileLoader const& loader,
+            BufferUpdater const& updater, size_t memoryBudget,
+            unsigned int numThreads = 2);
+
+        // Member access.
+        inline unsigned int GetNumLevels() const
+        {
+            return mNumLevels;
+        }
+
+        inline unsigned int GetSize() const
+        {
+            return mSize;
+        }
+
+        inline float GetMinElevation() const
+        {
+            return mMinElevation;
+        }
+
+        inline float GetMaxElevation() const
+        {
+            return mMaxElevation;
+        }
+
+        inline float GetSpacing() const
+        {
+            return mSpacing;
+        }
+
+        // The terrain covers [0,length]^2 in the xy-plane of its model
+        // space.
+        inline float GetLength() const
+        {
+            return mLength;
+        }
+
+        inline std::shared_ptr<VisualEffect> const& GetEffect() const
+        {
+            return mEffect;
+        }
+
+        // A tile is refined when the distance from the camera to its
+        // bounding box is smaller than lodFactor times its width. The
+        // factor must be at least 2 for the levels of adjacent tiles to
+        // differ by at most 1. The default is 2.5.
+        void SetLODFactor(float lodFactor);
+
+        inline float GetLODFactor() const
+        {
+            return mLODFactor;
+        }
+
+        void SetMemoryBudget(size_t memoryBudget);
+
+        inline size_t GetMemoryBudget() const
+        {
+            return mMemoryBudget;
+        }
+
+        // Statistics about the loaded tiles.
+        inline size_t GetNumLoadedTiles() const
+        {
+            return mTiles.size();
+        }
+
+        size_t GetNumPendingTiles() const;
+
+        inline size_t GetNumSelectedTiles() const
+        {
+            return mSelected.size();
+        }
+
+        inline size_t GetLoadedBytes() const
+        {
+            return mTiles.size() * mTileBytes;
+        }
+
+        // Compute the terrain height at the model (x,y) coordinate using the
+        // finest loaded tile that contains it. The coordinate is clamped to
+        // the terrain.
+        float GetHeight(float x, float y) const;
+
+        // Select, load and evict tiles for the current camera. The function
+        // must be called once per frame.
+        void OnCameraMotion();
+
+        // The selected tiles change every frame, so the culler and the
+        // scene updater must not flatten the children of the terrain.
+        virtual bool CanFlattenChildren() const override
+        {
+            return false;
+        }
+
+        virtual bool CanFlattenUpdate() const override
+        {
+            return false;
+        }
+
+    private:
+        typedef uint64_t TileKey;
+
+        struct Tile
+        {
+            Tile();
+
+            unsigned int level, x, y;
+            float minHeight, maxHeight;
+            std::vector<unsigned short> heights;
+            std::shared_ptr<Visual> visual;
+
+            // The frame in which the tile was last used for the selection
+            // and the range of the morph factors of its vertices the last
+            // time the vertices were computed.
+            uint64_t lastUsed;
+            float minMorph, maxMorph;
+        };
+
+        // The result of a worker thread. The tile is null when the loader
+        // failed.
+        struct LoadResult
+        {
+            TileKey key;
+            std::shared_ptr<Tile> tile;
+        };
+
+        static inline TileKey GetKey(unsigned int level, unsigned int x, unsigned int y)
+        {
+            return (static_cast<TileKey>(level) << 48)
+                | (static_cast<TileKey>(y) << 24) | static_cast<TileKey>(x);
+        }
+
+        // Support for tile creation, called by the worker threads.
+        std::shared_ptr<Tile> LoadTile(unsigned int level, unsigned int x, unsigned int y) const;
+        void WorkerThread();
+
+        // Tile geometry.
+        inline float GetElevation(unsigned short height) const
+        {
+            return mMinElevation + mElevationScale * static_cast<float>(height);
+        }
+
+        float GetTileLength(unsigned int level) const;
+        float GetDistanceToBox(Tile const& tile, Vector3<float> const& eye) const;
+        float GetMaxDistanceToBox(Tile const& tile, Vector3<float> const& eye) const;
+        float GetMorph(unsigned int level, float distance) const;
+        void SetVertices(Tile& tile, Vector3<float> const& eye, bool morph) const;
+
+        // Support for OnCameraMotion.
+        void ReceiveTiles();
+        void Select(Tile& tile, Vector3<float> const& eye,
+            std::vector<std::pair<float, TileKey>>& requests);
+        void EvictTiles(size_t numRequests);
+        void RequestTiles(std::vector<std::pair<float, TileKey>>& requests);
+        void CreateIndexBuffer();
+
+        // Terrain information.
+        unsigned int mNumLevels, mSize;
+        float mMinElevation, mMaxElevation, mElevationScale, mSpacing, mLength;
+        float mLODFactor;
+        size_t mMemoryBudget, mTileBytes;
+        VertexFormat mVFormat;
+        int mNormalOffset, mTCoordOffset;
+        std::shared_ptr<Camera> mCamera;
+        std::shared_ptr<VisualEffect> mEffect;
+        std::shared_ptr<IndexBuffer> mIBuffer;
+        TileLoader mLoader;
+        BufferUpdater mUpdater;
+
+        // The loaded tiles, the root tile and the tiles selected for the
+        // current frame.
+        std::map<TileKey, std::shared_ptr<Tile>> mTiles;
+        std::shared_ptr<Tile> mRoot;
+        std::vector<Tile*> mSelected;
+        std::set<TileKey> mFailed;
+        uint64_t mFrame;
+
+        // The tiles that are queued or being loaded are in mRequested. The
+        // queue and the results are shared with the worker threads.
+        std::set<TileKey> mRequested;
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<TileKey> mQueue;
+        std::vector<LoadResult> mResults;
+        std::vector<std::thread> mThreads;
+        bool mStop;
+    };
+}
@@ -0,0 +1,225 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/TextBatch.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstring>
+using namespace gte;
+
+TextBatch::TextBatch(std::shared_ptr<ProgramFactory> const& factory,
+    std::shared_ptr<Font> const& font, unsigned int maxCharacters)
+    :
+    mFont(font),
+    mMaxCharacters(maxCharacters),
+    mNumCharacters(0)
+{
+    LogAssert(mFont != nullptr && mMaxCharacters > 0, "Invalid input.");
+
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32_FLOAT, 0);
+    vformat.Bind(VA_TEXCOORD, DF_R32G32_FLOAT, 0);
+    vformat.Bind(VA_COLOR, DF_R32G32B32A32_FLOAT, 0);
+    mVertexBuffer = std::make_shared<VertexBuffer>(vformat, 4 * mMaxCharacters);
+    mVertexBuffer->SetUsage(Resource::DYNAMIC_UPDATE);
+    std::memset(mVertexBuffer->GetData(), 0, mVertexBuffer->GetNumBytes());
+    mVertexBuffer->SetNumActiveElements(0);
+
+    // The quads are indexed as in Font.
+    // 0 -- 2   4 -- 6  ...
+    // | \  |   | \  |
+    // |  \ |   |  \ |
+    // 1 -- 3   5 -- 7  ...
+    mIndexBuffer = std::make_shared<IndexBuffer>(IP_TRIMESH, 2 * mMaxCharacters, sizeof(unsigned int));
+    auto indices = mIndexBuffer->Get<unsigned int>();
+    for (unsigned int i = 0; i < mMaxCharacters; ++i)
+    {
+        indices[6 * i + 0] = 4 * i;
+        indices[6 * i + 1] = 4 * i + 3;
+        indices[6 * i + 2] = 4 * i + 1;
+        indices[6 * i + 3] = 4 * i;
+        indices[6 * i + 4] = 4 * i + 2;
+        indices[6 * i + 5] = 4 * i + 3;
+    }
+    mIndexBuffer->SetNumActivePrimitives(0);
+
+    int api = factory->GetAPI();
+    auto program = factory->CreateFromSources(*msVSSource[api], *msPSSource[api], "");
+    if (program)
+    {
+        mSamplerState = std::make_shared<SamplerState>();
+        program->GetPixelShader()->Set("baseTexture", mFont->GetTexture(),
+            "baseSampler", mSamplerState);
+        mEffect = std::make_shared<VisualEffect>(program);
+    }
+}
+
+void TextBatch::Clear()
+{
+    mNumCharacters = 0;
+    mVertexBuffer->SetNumActiveElements(0);
+    mIndexBuffer->SetNumActivePrimitives(0);
+}
+
+bool TextBatch::Add(int viewportWidth, int viewportHeight, int x, int y,
+    Vector4<float> const& color, std::string const& message)
+{
+    unsigned int const available = mMaxCharacters - mNumCharacters;
+    unsigned int const length = std::min(static_cast<unsigned int>(message.length()), available);
+    if (length > 0)
+    {
+        // The positions are those that Font::Typeset computes, including
+        // the translation of the text effect.
+        float const vdx = 1.0f / static_cast<float>(viewportWidth);
+        float const vdy = 1.0f / static_cast<float>(viewportHeight);
+        float const tw = static_cast<float>(mFont->GetTexture()->GetWidth());
+        float const th = static_cast<float>(mFont->GetTexture()->GetHeight());
+        float const* characterData = mFont->GetCharacterData();
+        float const y0 = 1.0f - vdy * static_cast<float>(y);
+        float const y1 = y0 + vdy * th;
+
+        Vertex* vertices = mVertexBuffer->Get<Vertex>() + 4 * mNumCharacters;
+        float x0 = vdx * static_cast<float>(x);
+        for (unsigned int i = 0; i < length; ++i, vertices += 4)
+        {
+            int c = static_cast<int>(message[i]);
+            float const tx0 = characterData[c];
+            float const tx1 = characterData[c + 1];
+            float const x1 = x0 + ((tx1 - tx0) * tw - 1.0f) * vdx;
+
+            vertices[0].position = { x0, y0 };
+            vertices[1].position = { x0, y1 };
+            vertices[2].position = { x1, y0 };
+            vertices[3].position = { x1, y1 };
+            vertices[0].tcoord = { tx0, 0.0f };
+            vertices[1].tcoord = { tx0, 1.0f };
+            vertices[2].tcoord = { tx1, 0.0f };
+            vertices[3].tcoord = { tx1, 1.0f };
+            for (int j = 0; j < 4; ++j)
+            {
+                vertices[j].color = color;
+            }
+            x0 = x1;
+        }
+
+        mVertexBuffer->MarkDirtyElements(4 * mNumCharacters, 4 * length);
+        mNumCharacters += length;
+        mVertexBuffer->SetNumActiveElements(4 * mNumCharacters);
+        mIndexBuffer->SetNumActivePrimitives(2 * mNumCharacters);
+    }
+    return length == message.length();
+}
+
+
+std::string const TextBatch::msGLSLVSSource =
+R"(
+    layout(location = 0) in vec2 modelPosition;
+    layout(location = 1) in vec2 modelTCoord;
+    layout(location = 2) in vec4 modelColor;
+    layout(location = 0) out vec2 vertexTCoord;
+    layout(location = 1) out vec4 vertexColor;
+
+    void main()
+    {
+        vertexTCoord = modelTCoord;
+        vertexColor = modelColor;
+        gl_Position.x = 2.0f * modelPosition.x - 1.0f;
+        gl_Position.y = 2.0f * modelPosition.y - 1.0f;
+        gl_Position.z = -1.0f;
+        gl_Position.w = 1.0f;
+    }
+)";
+
+std::string const TextBatch::msGLSLPSSource =
+R"(
+    layout(location = 0) in vec2 vertexTCoord;
+    layout(location = 1) in vec4 vertexColor;
+    layout(location = 0) out vec4 pixelColor;
+
+    uniform sampler2D baseSampler;
+
+    void main()
+    {
+        float bitmapAlpha = texture(baseSampler, vertexTCoord).r;
+        if (bitmapAlpha > 0.5f)
+        {
+            discard;
+        }
+        pixelColor = vertexColor;
+    }
+)";
+
+std::string const TextBatch::msHLSLVSSource =
+R"(
+    struct VS_INPUT
+    {
+        float2 modelPosition : POSITION;
+        float2 modelTCoord : TEXCOORD0;
+        float4 modelColor : COLOR0;
+    };
+
+    struct VS_OUTPUT
+    {
+        float2 vertexTCoord : TEXCOORD0;
+        float4 vertexColor : COLOR0;
+        float4 clipPosition : SV_POSITION;
+    };
+
+    VS_OUTPUT VSMain(VS_INPUT input)
+    {
+        VS_OUTPUT output;
+        output.vertexTCoord = input.modelTCoord;
+        output.vertexColor = input.modelColor;
+        output.clipPosition.x = 2.0f * input.modelPosition.x - 1.0f;
+        output.clipPosition.y = 2.0f * input.modelPosition.y - 1.0f;
+        output.clipPosition.z = 0.0f;
+        output.clipPosition.w = 1.0f;
+        return output;
+    }
+)";
+
+std::string const TextBatch::msHLSLPSSource =
+R"(
+    Texture2D baseTexture;
+    SamplerState baseSampler;
+
+    struct PS_INPUT
+    {
+        float2 vertexTCoord : TEXCOORD0;
+        float4 vertexColor : COLOR0;
+    };
+
+    struct PS_OUTPUT
+    {
+        float4 pixelColor : SV_TARGET0;
+    };
+
+    PS_OUTPUT PSMain(PS_INPUT input)
+    {
+        PS_OUTPUT output;
+        float bitmapAlpha = baseTexture.Sample(baseSampler, input.vertexTCoord).r;
+        if (bitmapAlpha > 0.5f)
+        {
+            discard;
+        }
+        output.pixelColor = input.vertexColor;
+        return output;
+    }
+)";
+
+ProgramSources const TextBatch::msVSSource =
+{
+    &msGLSLVSSource,
+    &msHLSLVSSource
+};
+
+ProgramSources const TextBatch::msPSSource =
+{
+    &msGLSLPSSource,
+    &msHLSLPSSource
+};
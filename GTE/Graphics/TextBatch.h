@@ -0,0 +1,99 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/Font.h>
+#include <Graphics/VisualEffect.h>
+#include <Graphics/SamplerState.h>
+#include <Mathematics/Vector2.h>
+
+// A batch of 2D text strings that are drawn with one call. The strings are
+// typeset with the glyphs of a Font, as GraphicsEngine::Draw(x,y,color,
+// message) does for one string, but the quads of all the strings are stored
+// in one dynamic vertex buffer with a color per vertex. A typical frame is
+//   batch->Clear();
+//   batch->Add(vw, vh, x0, y0, color0, message0);
+//   batch->Add(vw, vh, x1, y1, color1, message1);
+//   ...
+//   engine->Draw(batch);
+// The Add calls mark the modified vertices dirty, so the engine copies only
+// the vertices of the strings of the frame to the GPU.
+
+namespace gte
+{
+    class TextBatch
+    {
+    public:
+        // Construction. The batch stores up to maxCharacters characters.
+        TextBatch(std::shared_ptr<ProgramFactory> const& factory,
+            std::shared_ptr<Font> const& font, unsigned int maxCharacters);
+
+        // Member access.
+        inline std::shared_ptr<Font> const& GetFont() const
+        {
+            return mFont;
+        }
+
+        inline unsigned int GetMaxCharacters() const
+        {
+            return mMaxCharacters;
+        }
+
+        inline unsigned int GetNumCharacters() const
+        {
+            return mNumCharacters;
+        }
+
+        inline std::shared_ptr<VertexBuffer> const& GetVertexBuffer() const
+        {
+            return mVertexBuffer;
+        }
+
+        inline std::shared_ptr<IndexBuffer> const& GetIndexBuffer() const
+        {
+            return mIndexBuffer;
+        }
+
+        inline std::shared_ptr<VisualEffect> const& GetEffect() const
+        {
+            return mEffect;
+        }
+
+        // Remove all the strings from the batch.
+        void Clear();
+
+        // Append a string whose upper-left corner is at pixel (x,y) of the
+        // viewport. The return value is 'false' when the string does not
+        // fit in the batch, in which case its leading characters that fit
+        // are appended.
+        bool Add(int viewportWidth, int viewportHeight, int x, int y,
+            Vector4<float> const& color, std::string const& message);
+
+    private:
+        struct Vertex
+        {
+            Vector2<float> position, tcoord;
+            Vector4<float> color;
+        };
+
+        std::shared_ptr<Font> mFont;
+        unsigned int mMaxCharacters, mNumCharacters;
+        std::shared_ptr<VertexBuffer> mVertexBuffer;
+        std::shared_ptr<IndexBuffer> mIndexBuffer;
+        std::shared_ptr<SamplerState> mSamplerState;
+        std::shared_ptr<VisualEffect> mEffect;
+
+        // Shader source code as strings.
+        static std::string const msGLSLVSSource;
+        static std::string const msGLSLPSSource;
+        static std::string const msHLSLVSSource;
+        static std::string const msHLSLPSSource;
+        static ProgramSources const msVSSource;
+        static ProgramSources const msPSSource;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Mathematics/BitHacks.h>
@@ -14,7 +14,7 @@ Texture::Texture(unsigned int numItems, DFType format, unsigned int numDimension
     unsigned int dim0, unsigned int dim1, unsigned int dim2, bool hasMipmaps,
     bool createStorage)
     :
-    Resource(GetTotalElements(numItems, dim0, dim1, dim2, hasMipmaps),
+    Resource(GetTotalElements(numItems, format, dim0, dim1, dim2, hasMipmaps),
         DataFormat::GetNumBytesPerStruct(format), createStorage),
     mNumItems(numItems),
     mFormat(format),
@@ -22,9 +22,12 @@ Texture::Texture(unsigned int numItems, DFType format, unsigned int numDimension
     mNumLevels(1),
     mLOffset(numItems),
     mHasMipmaps(hasMipmaps),
-    mAutogenerateMipmaps(false)
+    mAutogenerateMipmaps(false),
+    mCompressed(DataFormat::IsCompressed(format))
 {
     LogAssert(mNumDimensions >= 1 && mNumDimensions <= 3, "Invalid number of dimensions.");
+    LogAssert(!mCompressed || (mNumDimensions >= 2 && dim0 % 4 == 0 && dim1 % 4 == 0),
+        "Compressed textures must have 2 or 3 dimensions that are multiples of 4.");
     mType = GT_TEXTURE;
 
     // Zero-out all the level information.
@@ -48,7 +51,7 @@ Texture::Texture(unsigned int numItems, DFType format, unsigned int numDimension
     mLDimension[0][0] = dim0;
     mLDimension[0][1] = dim1;
     mLDimension[0][2] = dim2;
-    mLNumBytes[0] = dim0*dim1*dim2*mElementSize;
+    mLNumBytes[0] = GetLevelNumElements(format, dim0, dim1, dim2) * mElementSize;
 
     if (mHasMipmaps)
     {
@@ -73,7 +76,7 @@ Texture::Texture(unsigned int numItems, DFType format, unsigned int numDimension
                 dim2 >>= 1;
             }
 
-            mLNumBytes[level] = dim0 * dim1 * dim2 * mElementSize;
+            mLNumBytes[level] = GetLevelNumElements(format, dim0, dim1, dim2) * mElementSize;
             mLDimension[level][0] = dim0;
             mLDimension[level][1] = dim1;
             mLDimension[level][2] = dim2;
@@ -111,14 +114,16 @@ Texture::Subresource Texture::GetSubresource(unsigned int index) const
     sr.item = index / mNumLevels;
     sr.level = index % mNumLevels;
     sr.data = const_cast<char*>(GetDataFor(sr.item, sr.level));
-    sr.rowPitch = mLDimension[sr.level][0] * mElementSize;
-    sr.slicePitch = mLDimension[sr.level][1] * sr.rowPitch;
+    sr.rowPitch = (mCompressed ? (mLDimension[sr.level][0] + 3) / 4 :
+        mLDimension[sr.level][0]) * mElementSize;
+    sr.slicePitch = GetNumRowsFor(sr.level) * sr.rowPitch;
     return sr;
 }
 
 void Texture::AutogenerateMipmaps()
 {
-    if (mHasMipmaps)
+    // The GPU cannot generate the mipmaps of compressed formats.
+    if (mHasMipmaps && !mCompressed)
     {
         // Mipmaps are generated internally on the GPU, so mUsage is
         // SHADER_OUTPUT.
@@ -127,9 +132,10 @@ void Texture::AutogenerateMipmaps()
 }
 
 unsigned int Texture::GetTotalElements(unsigned int numItems,
-    unsigned int dim0, unsigned int dim1, unsigned int dim2, bool hasMipmaps)
+    DFType format, unsigned int dim0, unsigned int dim1, unsigned int dim2,
+    bool hasMipmaps)
 {
-    unsigned int numElementsPerItem = dim0 * dim1 * dim2;
+    unsigned int numElementsPerItem = GetLevelNumElements(format, dim0, dim1, dim2);
     if (hasMipmaps)
     {
         unsigned int log0 = BitHacks::Log2OfPowerOfTwo(BitHacks::RoundDownToPowerOfTwo(dim0));
@@ -153,10 +159,21 @@ unsigned int Texture::GetTotalElements(unsigned int numItems,
                 dim2 >>= 1;
             }
 
-            numElementsPerItem += dim0 * dim1 * dim2;
+            numElementsPerItem += GetLevelNumElements(format, dim0, dim1, dim2);
         }
     }
 
     unsigned int totalElements = numItems * numElementsPerItem;
     return totalElements;
 }
+
+unsigned int Texture::GetLevelNumElements(DFType format, unsigned int dim0,
+    unsigned int dim1, unsigned int dim2)
+{
+    if (DataFormat::IsCompressed(format))
+    {
+        // The levels smaller than a block occupy one block.
+        return ((dim0 + 3) / 4) * ((dim1 + 3) / 4) * dim2;
+    }
+    return dim0 * dim1 * dim2;
+}
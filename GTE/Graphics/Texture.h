@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -47,6 +47,16 @@ namespace gte
             return mLDimension[0][i];
         }
 
+        // A texture of a block-compressed format stores 4x4 blocks of
+        // texels. Its elements are the blocks, a row of a level is a row of
+        // blocks and the dimensions of the base level must be multiples of
+        // 4. The compressed formats are supported only for textures of 2 or
+        // 3 dimensions.
+        inline bool IsCompressed() const
+        {
+            return mCompressed;
+        }
+
         // Subresource information.
         struct Subresource
         {
@@ -75,6 +85,13 @@ namespace gte
             return mLDimension[level][i];
         }
 
+        // The number of rows of texels of a level, or the number of rows
+        // of blocks for a compressed format.
+        inline unsigned int GetNumRowsFor(unsigned int level) const
+        {
+            return mCompressed ? (mLDimension[level][1] + 3) / 4 : mLDimension[level][1];
+        }
+
         inline unsigned int GetNumElementsFor(unsigned int level) const
         {
             return mLNumBytes[level] / mElementSize;
@@ -137,8 +154,12 @@ namespace gte
         // Support for computing the numElements parameter for the Resource
         // constructor.  This is necessary when mipmaps are requested.
         static unsigned int GetTotalElements(unsigned int numItems,
-            unsigned int dim0, unsigned int dim1, unsigned int dim2,
-            bool hasMipmaps);
+            DFType format, unsigned int dim0, unsigned int dim1,
+            unsigned int dim2, bool hasMipmaps);
+
+        // The number of elements of a level with the specified dimensions.
+        static unsigned int GetLevelNumElements(DFType format, unsigned int dim0,
+            unsigned int dim1, unsigned int dim2);
 
         unsigned int mNumItems;
         DFType mFormat;
@@ -149,6 +170,7 @@ namespace gte
         std::vector<std::array<unsigned int, MAX_MIPMAP_LEVELS>> mLOffset;
         bool mHasMipmaps;
         bool mAutogenerateMipmaps;
+        bool mCompressed;
     };
 
     typedef std::function<void(std::shared_ptr<Texture> const&)> TextureUpdater;
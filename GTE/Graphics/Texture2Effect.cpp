@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/Texture2Effect.h>
@@ -42,22 +42,46 @@ void Texture2Effect::SetPVWMatrixConstant(std::shared_ptr<ConstantBuffer> const&
 
 std::string const Texture2Effect::msGLSLVSSource =
 R"(
+#if GTE_USE_PVW_BATCH
+    uniform PVWMatrix
+    {
+        uvec4 pvwIndex;
+    };
+
+    buffer pvwMatrices { mat4 data[]; } pvwMatricesSB;
+#define pvwMatrix pvwMatricesSB.data[pvwIndex.x]
+#else
     uniform PVWMatrix
     {
         mat4 pvwMatrix;
     };
+#endif
 
     layout(location = 0) in vec3 modelPosition;
     layout(location = 1) in vec2 modelTCoord;
+#if GTE_USE_INSTANCING
+    layout(location = 2) in vec4 instanceRow0;
+    layout(location = 3) in vec4 instanceRow1;
+    layout(location = 4) in vec4 instanceRow2;
+#endif
     layout(location = 0) out vec2 vertexTCoord;
 
     void main()
     {
+    #if GTE_USE_INSTANCING
+        vec3 position = vec3(
+            dot(instanceRow0, vec4(modelPosition, 1.0f)),
+            dot(instanceRow1, vec4(modelPosition, 1.0f)),
+            dot(instanceRow2, vec4(modelPosition, 1.0f)));
+    #else
+        vec3 position = modelPosition;
+    #endif
+
         vertexTCoord = modelTCoord;
     #if GTE_USE_MAT_VEC
-        gl_Position = pvwMatrix * vec4(modelPosition, 1.0f);
+        gl_Position = pvwMatrix * vec4(position, 1.0f);
     #else
-        gl_Position = vec4(modelPosition, 1.0f) * pvwMatrix;
+        gl_Position = vec4(position, 1.0f) * pvwMatrix;
     #endif
     }
 )";
@@ -77,15 +101,30 @@ R"(
 
 std::string const Texture2Effect::msHLSLVSSource =
 R"(
+#if GTE_USE_PVW_BATCH
+    cbuffer PVWMatrix
+    {
+        uint4 pvwIndex;
+    };
+
+    StructuredBuffer<float4x4> pvwMatrices;
+#define pvwMatrix pvwMatrices[pvwIndex.x]
+#else
     cbuffer PVWMatrix
     {
         float4x4 pvwMatrix;
     };
+#endif
 
     struct VS_INPUT
     {
         float3 modelPosition : POSITION;
         float2 modelTCoord : TEXCOORD0;
+    #if GTE_USE_INSTANCING
+        float4 instanceRow0 : TEXCOORD5;
+        float4 instanceRow1 : TEXCOORD6;
+        float4 instanceRow2 : TEXCOORD7;
+    #endif
     };
 
     struct VS_OUTPUT
@@ -96,6 +135,13 @@ R"(
 
     VS_OUTPUT VSMain(VS_INPUT input)
     {
+    #if GTE_USE_INSTANCING
+        input.modelPosition = float3(
+            dot(input.instanceRow0, float4(input.modelPosition, 1.0f)),
+            dot(input.instanceRow1, float4(input.modelPosition, 1.0f)),
+            dot(input.instanceRow2, float4(input.modelPosition, 1.0f)));
+    #endif
+
         VS_OUTPUT output;
     #if GTE_USE_MAT_VEC
         output.clipPosition = mul(pvwMatrix, float4(input.modelPosition, 1.0f));
@@ -0,0 +1,500 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/TextureFileIO.h>
+#include <Graphics/Texture2.h>
+#include <Graphics/Texture2Array.h>
+#include <Graphics/Texture3.h>
+#include <Graphics/TextureCube.h>
+#include <Graphics/TextureCubeArray.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+using namespace gte;
+
+namespace
+{
+    bool ReadFile(std::string const& filename, std::vector<char>& buffer)
+    {
+        std::ifstream input(filename, std::ios::in | std::ios::binary);
+        if (!input)
+        {
+            LogWarning("Cannot open " + filename + ".");
+            return false;
+        }
+
+        input.seekg(0, std::ios::end);
+        auto const size = input.tellg();
+        input.seekg(0, std::ios::beg);
+        buffer.resize(static_cast<size_t>(size));
+        input.read(buffer.data(), size);
+        return !input.fail();
+    }
+
+    template <typename T>
+    T ReadValue(std::vector<char> const& buffer, size_t offset)
+    {
+        T value;
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+        return value;
+    }
+
+    unsigned int GetNumFullLevels(unsigned int width, unsigned int height,
+        unsigned int depth)
+    {
+        unsigned int maxDimension = std::max(width, std::max(height, depth));
+        unsigned int numLevels = 1;
+        while (maxDimension > 1)
+        {
+            maxDimension >>= 1;
+            ++numLevels;
+        }
+        return numLevels;
+    }
+
+    // The number of bytes of a level, including those levels that are in a
+    // file but not in the texture.
+    size_t GetNumLevelBytes(DFType format, unsigned int width,
+        unsigned int height, unsigned int depth, unsigned int level)
+    {
+        size_t const w = std::max(width >> level, 1u);
+        size_t const h = std::max(height >> level, 1u);
+        size_t const d = std::max(depth >> level, 1u);
+        size_t const numBytesPerStruct = DataFormat::GetNumBytesPerStruct(format);
+        if (DataFormat::IsCompressed(format))
+        {
+            return ((w + 3) / 4) * ((h + 3) / 4) * d * numBytesPerStruct;
+        }
+        return w * h * d * numBytesPerStruct;
+    }
+
+    // DDS constants.
+    uint32_t const DDS_MAGIC = 0x20534444;  // "DDS "
+    size_t const DDS_HEADER_SIZE = 124;
+    size_t const DDS_HEADER_DX10_SIZE = 20;
+    uint32_t const DDSD_MIPMAPCOUNT = 0x00020000;
+    uint32_t const DDSD_DEPTH = 0x00800000;
+    uint32_t const DDPF_ALPHAPIXELS = 0x00000001;
+    uint32_t const DDPF_FOURCC = 0x00000004;
+    uint32_t const DDPF_RGB = 0x00000040;
+    uint32_t const DDSCAPS2_CUBEMAP = 0x00000200;
+    uint32_t const DDSCAPS2_CUBEMAP_ALLFACES = 0x0000FC00;
+    uint32_t const DDSCAPS2_VOLUME = 0x00200000;
+    uint32_t const DDS_DIMENSION_TEXTURE2D = 3;
+    uint32_t const DDS_DIMENSION_TEXTURE3D = 4;
+    uint32_t const DDS_RESOURCE_MISC_TEXTURECUBE = 0x00000004;
+
+    uint32_t MakeFourCC(char c0, char c1, char c2, char c3)
+    {
+        return static_cast<uint32_t>(static_cast<uint8_t>(c0))
+            | (static_cast<uint32_t>(static_cast<uint8_t>(c1)) << 8)
+            | (static_cast<uint32_t>(static_cast<uint8_t>(c2)) << 16)
+            | (static_cast<uint32_t>(static_cast<uint8_t>(c3)) << 24);
+    }
+
+    DFType GetLegacyDDSFormat(std::vector<char> const& buffer, size_t pfOffset)
+    {
+        uint32_t const flags = ReadValue<uint32_t>(buffer, pfOffset + 4);
+        if (flags & DDPF_FOURCC)
+        {
+            // DXT2 and DXT4 are the premultiplied-alpha variants of DXT3
+            // and DXT5. The blocks are the same.
+            uint32_t const fourCC = ReadValue<uint32_t>(buffer, pfOffset + 8);
+            struct { uint32_t fourCC; DFType format; } const table[] =
+            {
+                { MakeFourCC('D', 'X', 'T', '1'), DF_BC1_UNORM },
+                { MakeFourCC('D', 'X', 'T', '2'), DF_BC2_UNORM },
+                { MakeFourCC('D', 'X', 'T', '3'), DF_BC2_UNORM },
+                { MakeFourCC('D', 'X', 'T', '4'), DF_BC3_UNORM },
+                { MakeFourCC('D', 'X', 'T', '5'), DF_BC3_UNORM },
+                { MakeFourCC('A', 'T', 'I', '1'), DF_BC4_UNORM },
+                { MakeFourCC('B', 'C', '4', 'U'), DF_BC4_UNORM },
+                { MakeFourCC('B', 'C', '4', 'S'), DF_BC4_SNORM },
+                { MakeFourCC('A', 'T', 'I', '2'), DF_BC5_UNORM },
+                { MakeFourCC('B', 'C', '5', 'U'), DF_BC5_UNORM },
+                { MakeFourCC('B', 'C', '5', 'S'), DF_BC5_SNORM }
+            };
+            for (auto const& entry : table)
+            {
+                if (entry.fourCC == fourCC)
+                {
+                    return entry.format;
+                }
+            }
+            return DF_UNKNOWN;
+        }
+
+        if ((flags & DDPF_RGB) && ReadValue<uint32_t>(buffer, pfOffset + 12) == 32)
+        {
+            uint32_t const rMask = ReadValue<uint32_t>(buffer, pfOffset + 16);
+            uint32_t const gMask = ReadValue<uint32_t>(buffer, pfOffset + 20);
+            uint32_t const bMask = ReadValue<uint32_t>(buffer, pfOffset + 24);
+            uint32_t const aMask = ReadValue<uint32_t>(buffer, pfOffset + 28);
+            bool const hasAlpha = (flags & DDPF_ALPHAPIXELS) && aMask == 0xFF000000u;
+            if (rMask == 0x000000FFu && gMask == 0x0000FF00u && bMask == 0x00FF0000u && hasAlpha)
+            {
+                return DF_R8G8B8A8_UNORM;
+            }
+            if (rMask == 0x00FF0000u && gMask == 0x0000FF00u && bMask == 0x000000FFu)
+            {
+                return (hasAlpha ? DF_B8G8R8A8_UNORM : DF_B8G8R8X8_UNORM);
+            }
+        }
+        return DF_UNKNOWN;
+    }
+
+    // KTX2 constants.
+    char const KTX2_IDENTIFIER[12] =
+    {
+        '\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n'
+    };
+    size_t const KTX2_HEADER_SIZE = 80;
+    size_t const KTX2_LEVEL_INDEX_SIZE = 24;
+
+    DFType GetKTX2Format(uint32_t vkFormat)
+    {
+        switch (vkFormat)
+        {
+        case 37:  return DF_R8G8B8A8_UNORM;         // VK_FORMAT_R8G8B8A8_UNORM
+        case 43:  return DF_R8G8B8A8_UNORM_SRGB;    // VK_FORMAT_R8G8B8A8_SRGB
+        case 44:  return DF_B8G8R8A8_UNORM;         // VK_FORMAT_B8G8R8A8_UNORM
+        case 50:  return DF_B8G8R8A8_UNORM_SRGB;    // VK_FORMAT_B8G8R8A8_SRGB
+        case 97:  return DF_R16G16B16A16_FLOAT;     // VK_FORMAT_R16G16B16A16_SFLOAT
+        case 109: return DF_R32G32B32A32_FLOAT;     // VK_FORMAT_R32G32B32A32_SFLOAT
+        case 131: return DF_BC1_UNORM;              // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132: return DF_BC1_UNORM_SRGB;         // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+        case 133: return DF_BC1_UNORM;              // VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134: return DF_BC1_UNORM_SRGB;         // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+        case 135: return DF_BC2_UNORM;              // VK_FORMAT_BC2_UNORM_BLOCK
+        case 136: return DF_BC2_UNORM_SRGB;         // VK_FORMAT_BC2_SRGB_BLOCK
+        case 137: return DF_BC3_UNORM;              // VK_FORMAT_BC3_UNORM_BLOCK
+        case 138: return DF_BC3_UNORM_SRGB;         // VK_FORMAT_BC3_SRGB_BLOCK
+        case 139: return DF_BC4_UNORM;              // VK_FORMAT_BC4_UNORM_BLOCK
+        case 140: return DF_BC4_SNORM;              // VK_FORMAT_BC4_SNORM_BLOCK
+        case 141: return DF_BC5_UNORM;              // VK_FORMAT_BC5_UNORM_BLOCK
+        case 142: return DF_BC5_SNORM;              // VK_FORMAT_BC5_SNORM_BLOCK
+        case 143: return DF_BC6H_UF16;              // VK_FORMAT_BC6H_UFLOAT_BLOCK
+        case 144: return DF_BC6H_SF16;              // VK_FORMAT_BC6H_SFLOAT_BLOCK
+        case 145: return DF_BC7_UNORM;              // VK_FORMAT_BC7_UNORM_BLOCK
+        case 146: return DF_BC7_UNORM_SRGB;         // VK_FORMAT_BC7_SRGB_BLOCK
+        default:  return DF_UNKNOWN;
+        }
+    }
+}
+
+std::shared_ptr<Texture> TextureFileIO::LoadDDS(std::string const& filename)
+{
+    std::vector<char> buffer;
+    if (!ReadFile(filename, buffer))
+    {
+        return nullptr;
+    }
+
+    if (buffer.size() < 4 + DDS_HEADER_SIZE
+        || ReadValue<uint32_t>(buffer, 0) != DDS_MAGIC
+        || ReadValue<uint32_t>(buffer, 4) != DDS_HEADER_SIZE)
+    {
+        LogWarning("The file " + filename + " is not a DDS file.");
+        return nullptr;
+    }
+
+    // The DDS_HEADER follows the magic number.
+    size_t const header = 4;
+    uint32_t const flags = ReadValue<uint32_t>(buffer, header + 4);
+    unsigned int const height = ReadValue<uint32_t>(buffer, header + 8);
+    unsigned int const width = ReadValue<uint32_t>(buffer, header + 12);
+    unsigned int depth = 1;
+    if (flags & DDSD_DEPTH)
+    {
+        depth = std::max(ReadValue<uint32_t>(buffer, header + 20), 1u);
+    }
+    unsigned int numLevels = 1;
+    if (flags & DDSD_MIPMAPCOUNT)
+    {
+        numLevels = std::max(ReadValue<uint32_t>(buffer, header + 24), 1u);
+    }
+    size_t const pfOffset = header + 72;
+    uint32_t const caps2 = ReadValue<uint32_t>(buffer, header + 108);
+
+    DFType format = DF_UNKNOWN;
+    unsigned int numLayers = 1;
+    bool isCube = false;
+    size_t dataOffset = header + DDS_HEADER_SIZE;
+    uint32_t const pfFlags = ReadValue<uint32_t>(buffer, pfOffset + 4);
+    uint32_t const fourCC = ReadValue<uint32_t>(buffer, pfOffset + 8);
+    if ((pfFlags & DDPF_FOURCC) && fourCC == MakeFourCC('D', 'X', '1', '0'))
+    {
+        if (buffer.size() < dataOffset + DDS_HEADER_DX10_SIZE)
+        {
+            LogWarning("The file " + filename + " is too small.");
+            return nullptr;
+        }
+
+        // The DXGI_FORMAT values are the DFType values.
+        uint32_t const dxgiFormat = ReadValue<uint32_t>(buffer, dataOffset);
+        uint32_t const dimension = ReadValue<uint32_t>(buffer, dataOffset + 4);
+        uint32_t const miscFlag = ReadValue<uint32_t>(buffer, dataOffset + 8);
+        numLayers = std::max(ReadValue<uint32_t>(buffer, dataOffset + 12), 1u);
+        dataOffset += DDS_HEADER_DX10_SIZE;
+
+        if (dxgiFormat > DF_UNKNOWN && dxgiFormat < DF_NUM_FORMATS)
+        {
+            format = static_cast<DFType>(dxgiFormat);
+        }
+        if (dimension == DDS_DIMENSION_TEXTURE2D)
+        {
+            depth = 1;
+            isCube = ((miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0);
+        }
+        else if (dimension != DDS_DIMENSION_TEXTURE3D)
+        {
+            LogWarning("The file " + filename + " is not a 2D, cube or 3D texture.");
+            return nullptr;
+        }
+    }
+    else
+    {
+        format = GetLegacyDDSFormat(buffer, pfOffset);
+        if (caps2 & DDSCAPS2_CUBEMAP)
+        {
+            if ((caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+            {
+                LogWarning("The cube map of " + filename + " does not have all faces.");
+                return nullptr;
+            }
+            isCube = true;
+        }
+        if (!(caps2 & DDSCAPS2_VOLUME))
+        {
+            depth = 1;
+        }
+    }
+
+    if (format == DF_UNKNOWN || DataFormat::GetNumBytesPerStruct(format) == 0)
+    {
+        LogWarning("The format of " + filename + " is not supported.");
+        return nullptr;
+    }
+
+    auto texture = CreateTexture(format, width, height, depth, numLayers,
+        isCube, numLevels);
+    if (!texture)
+    {
+        LogWarning("The texture of " + filename + " is not supported.");
+        return nullptr;
+    }
+
+    // The images are stored by item (array element and cube face) and then
+    // by level.
+    size_t numItemBytes = 0;
+    for (unsigned int level = 0; level < numLevels; ++level)
+    {
+        numItemBytes += GetNumLevelBytes(format, width, height, depth, level);
+    }
+    unsigned int const numItems = texture->GetNumItems();
+    if (buffer.size() < dataOffset + numItems * numItemBytes)
+    {
+        LogWarning("The file " + filename + " is too small for its images.");
+        return nullptr;
+    }
+
+    unsigned int const numTextureLevels = texture->GetNumLevels();
+    for (unsigned int item = 0; item < numItems; ++item)
+    {
+        char const* source = buffer.data() + dataOffset + item * numItemBytes;
+        for (unsigned int level = 0; level < numTextureLevels; ++level)
+        {
+            size_t const numBytes = texture->GetNumBytesFor(level);
+            std::memcpy(texture->GetDataFor(item, level), source, numBytes);
+            source += numBytes;
+        }
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureFileIO::LoadKTX2(std::string const& filename)
+{
+    std::vector<char> buffer;
+    if (!ReadFile(filename, buffer))
+    {
+        return nullptr;
+    }
+
+    if (buffer.size() < KTX2_HEADER_SIZE
+        || std::memcmp(buffer.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+    {
+        LogWarning("The file " + filename + " is not a KTX2 file.");
+        return nullptr;
+    }
+
+    uint32_t const vkFormat = ReadValue<uint32_t>(buffer, 12);
+    unsigned int const width = ReadValue<uint32_t>(buffer, 20);
+    unsigned int const height = ReadValue<uint32_t>(buffer, 24);
+    unsigned int const depth = std::max(ReadValue<uint32_t>(buffer, 28), 1u);
+    unsigned int const numLayers = std::max(ReadValue<uint32_t>(buffer, 32), 1u);
+    unsigned int const numFaces = ReadValue<uint32_t>(buffer, 36);
+    unsigned int const numLevels = ReadValue<uint32_t>(buffer, 40);
+    uint32_t const supercompression = ReadValue<uint32_t>(buffer, 44);
+
+    if (supercompression != 0)
+    {
+        LogWarning("The supercompression of " + filename + " is not supported.");
+        return nullptr;
+    }
+
+    if (height == 0 || (numFaces != 1 && numFaces != 6))
+    {
+        LogWarning("The file " + filename + " is not a 2D, cube or 3D texture.");
+        return nullptr;
+    }
+
+    DFType const format = GetKTX2Format(vkFormat);
+    if (format == DF_UNKNOWN)
+    {
+        LogWarning("The format of " + filename + " is not supported.");
+        return nullptr;
+    }
+
+    // A level count of 0 requests that the mipmaps be generated, in which
+    // case the file stores the base level only.
+    unsigned int const numFileLevels = std::max(numLevels, 1u);
+    if (buffer.size() < KTX2_HEADER_SIZE + numFileLevels * KTX2_LEVEL_INDEX_SIZE)
+    {
+        LogWarning("The file " + filename + " is too small.");
+        return nullptr;
+    }
+
+    auto texture = CreateTexture(format, width, height, depth, numLayers,
+        numFaces == 6, numLevels);
+    if (!texture)
+    {
+        LogWarning("The texture of " + filename + " is not supported.");
+        return nullptr;
+    }
+
+    // Each level is stored by layer, then by face, then by slice. The level
+    // index starts with the base level.
+    unsigned int const numItems = texture->GetNumItems();
+    unsigned int const numTextureLevels = (texture->WantAutogenerateMipmaps() ?
+        1 : texture->GetNumLevels());
+    for (unsigned int level = 0; level < numTextureLevels; ++level)
+    {
+        size_t const index = KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_SIZE;
+        uint64_t const byteOffset = ReadValue<uint64_t>(buffer, index);
+        uint64_t const byteLength = ReadValue<uint64_t>(buffer, index + 8);
+        size_t const numBytes = texture->GetNumBytesFor(level);
+        if (byteLength < static_cast<uint64_t>(numItems) * numBytes
+            || byteOffset + byteLength > buffer.size())
+        {
+            LogWarning("The file " + filename + " is too small for its images.");
+            return nullptr;
+        }
+
+        char const* source = buffer.data() + byteOffset;
+        for (unsigned int item = 0; item < numItems; ++item)
+        {
+            std::memcpy(texture->GetDataFor(item, level), source, numBytes);
+            source += numBytes;
+        }
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureFileIO::Load(std::string const& filename)
+{
+    std::string extension;
+    auto const dot = filename.find_last_of('.');
+    if (dot != std::string::npos)
+    {
+        extension = filename.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    }
+
+    if (extension == "dds")
+    {
+        return LoadDDS(filename);
+    }
+    if (extension == "ktx2")
+    {
+        return LoadKTX2(filename);
+    }
+
+    LogWarning("The file " + filename + " is not a DDS or KTX2 file.");
+    return nullptr;
+}
+
+std::shared_ptr<Texture> TextureFileIO::CreateTexture(DFType format,
+    unsigned int width, unsigned int height, unsigned int depth,
+    unsigned int numLayers, bool isCube, unsigned int numLevels)
+{
+    if (width == 0 || height == 0)
+    {
+        return nullptr;
+    }
+
+    bool const compressed = DataFormat::IsCompressed(format);
+    if (compressed && (width % 4 != 0 || height % 4 != 0))
+    {
+        return nullptr;
+    }
+
+    // A partial mipmap chain is reduced to the base level. When the file
+    // requests generated mipmaps, they are generated for the formats that
+    // the GPU can filter.
+    unsigned int const numFullLevels = GetNumFullLevels(width, height, depth);
+    if (numLevels > numFullLevels)
+    {
+        return nullptr;
+    }
+    bool const autogenerate = (numLevels == 0 && !compressed);
+    bool const hasMipmaps = (numLevels == numFullLevels && numFullLevels > 1) || autogenerate;
+
+    std::shared_ptr<Texture> texture;
+    if (depth > 1)
+    {
+        if (numLayers > 1 || isCube)
+        {
+            return nullptr;
+        }
+        texture = std::make_shared<Texture3>(format, width, height, depth, hasMipmaps);
+    }
+    else if (isCube)
+    {
+        if (width != height)
+        {
+            return nullptr;
+        }
+        if (numLayers > 1)
+        {
+            texture = std::make_shared<TextureCubeArray>(numLayers, format, width, hasMipmaps);
+        }
+        else
+        {
+            texture = std::make_shared<TextureCube>(format, width, hasMipmaps);
+        }
+    }
+    else if (numLayers > 1)
+    {
+        texture = std::make_shared<Texture2Array>(numLayers, format, width, height, hasMipmaps);
+    }
+    else
+    {
+        texture = std::make_shared<Texture2>(format, width, height, hasMipmaps);
+    }
+
+    if (autogenerate)
+    {
+        texture->AutogenerateMipmaps();
+    }
+    return texture;
+}
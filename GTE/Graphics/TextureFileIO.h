@@ -0,0 +1,56 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/Texture.h>
+#include <memory>
+#include <string>
+
+// Loading of textures from DDS and KTX2 files, the container formats for
+// textures that are block compressed offline (BC1 through BC7). The images
+// are copied to the texture unchanged, so compressed textures remain
+// compressed in CPU and GPU memory. The loaders create a Texture2,
+// Texture2Array, TextureCube, TextureCubeArray or Texture3 according to the
+// file; call GetType() on the returned texture to determine which. A file
+// that stores the full mipmap chain produces a texture with mipmaps. A file
+// with a partial mipmap chain produces a texture with the base level only,
+// because the textures of the engine have either 1 level or all levels.
+//
+// DDS: The legacy header is supported for the FourCC codes DXT1, DXT2,
+// DXT3, DXT4, DXT5, ATI1, BC4U, BC4S, ATI2, BC5U and BC5S and for 32-bit
+// RGBA and BGRA images. The DX10 extended header is supported for all DXGI
+// formats that have a DFType, which are all of them, because DFType has the
+// values of DXGI_FORMAT.
+//
+// KTX2: The Vulkan formats of BC1 through BC7 and the common 8-bit, 16-bit
+// float and 32-bit float RGBA formats are supported. Files with
+// supercompression (Basis Universal, Zstandard, zlib) are not supported.
+//
+// If the load is not successful, the functions return a null object.
+
+namespace gte
+{
+    class TextureFileIO
+    {
+    public:
+        static std::shared_ptr<Texture> LoadDDS(std::string const& filename);
+        static std::shared_ptr<Texture> LoadKTX2(std::string const& filename);
+
+        // Select the loader from the file extension, ".dds" or ".ktx2"
+        // (case insensitive).
+        static std::shared_ptr<Texture> Load(std::string const& filename);
+
+    private:
+        // Create the texture for the description in a file. The number of
+        // levels in the file is 0 when the mipmaps are to be generated by
+        // the GPU.
+        static std::shared_ptr<Texture> CreateTexture(DFType format,
+            unsigned int width, unsigned int height, unsigned int depth,
+            unsigned int numLayers, bool isCube, unsigned int numLevels);
+    };
+}
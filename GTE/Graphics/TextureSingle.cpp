@@ -3,17 +3,28 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/TextureSingle.h>
+#include <Mathematics/Logger.h>
 using namespace gte;
 
 TextureSingle::TextureSingle(DFType format, unsigned int numDimensions,
     unsigned int dim0, unsigned int dim1, unsigned int dim2, bool hasMipmaps,
     bool createStorage)
     :
-    Texture(1, format, numDimensions, dim0, dim1, dim2, hasMipmaps, createStorage)
+    Texture(1, format, numDimensions, dim0, dim1, dim2, hasMipmaps, createStorage),
+    mMinResidentLevel(0),
+    mPartiallyResident(false)
 {
     mType = GT_TEXTURE_SINGLE;
 }
+
+void TextureSingle::SetMinResidentLevel(unsigned int level)
+{
+    LogAssert(level < mNumLevels, "Invalid level.");
+    LogAssert(level == 0 || !mAutogenerateMipmaps,
+        "Streamed textures cannot autogenerate mipmaps.");
+    mMinResidentLevel = level;
+}
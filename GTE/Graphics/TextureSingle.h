@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -48,8 +48,44 @@ namespace gte
             return Texture::GetFor<T>(0, level);
         }
 
+        // Mipmap streaming. The levels finer than the minimum resident
+        // level are not sampled and need not be in GPU memory, so a large
+        // set of textures can be drawn with their coarse levels while the
+        // finer levels are loaded on demand (see MipmapStreamer). After a
+        // bound texture's minimum resident level is changed, call
+        // GraphicsEngine::UpdateResidency to apply it; that call copies the
+        // CPU data of the levels that become resident to the GPU. The
+        // default minimum resident level is 0, all levels. Streamed
+        // textures must not autogenerate their mipmaps.
+        void SetMinResidentLevel(unsigned int level);
+
+        inline unsigned int GetMinResidentLevel() const
+        {
+            return mMinResidentLevel;
+        }
+
+        // Request that the GPU memory of the levels that are not resident
+        // not be committed. This is supported by OpenGL when the driver has
+        // GL_ARB_sparse_texture and the format has sparse page sizes. When
+        // not supported, all levels are allocated and only sampling is
+        // restricted to the resident levels. The function must be called
+        // before the texture is bound to an engine.
+        inline void SetPartiallyResident(bool partiallyResident)
+        {
+            mPartiallyResident = partiallyResident;
+        }
+
+        inline bool IsPartiallyResident() const
+        {
+            return mPartiallyResident;
+        }
+
     public:
         // For use by the Shader class for storing reflection information.
         static int const shaderDataLookup = 4;
+
+    private:
+        unsigned int mMinResidentLevel;
+        bool mPartiallyResident;
     };
 }
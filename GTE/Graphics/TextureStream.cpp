@@ -0,0 +1,362 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/GTGraphicsPCH.h>
+#include <Graphics/TextureStream.h>
+#include <Mathematics/Logger.h>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#if defined(GTE_USE_MSWINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace gte;
+
+TextureStream::~TextureStream()
+{
+    Stop();
+
+    // The textures may outlive the stream, so they must not point to the
+    // mapped file after it is unmapped.
+    for (auto const& texture : mTextures)
+    {
+        texture->SetData(nullptr);
+    }
+    UnmapFile();
+}
+
+TextureStream::TextureStream(std::string const& filename,
+    std::shared_ptr<GraphicsEngine> const& engine, unsigned int numBuffers)
+    :
+    mMapping(nullptr),
+    mMappingSize(0),
+#if defined(GTE_USE_MSWINDOWS)
+    mFileHandle(nullptr),
+    mMappingHandle(nullptr),
+#endif
+    mType(DF_UNKNOWN),
+    mWidth(0),
+    mHeight(0),
+    mNumImages(0),
+    mRecordSize(0),
+    mEngine(engine),
+    mNextTexture(0),
+    mStop(true),
+    mNumDroppedFrames(0),
+    mPerformanceFrames(0),
+    mPerformanceMicroseconds(0)
+{
+    LogAssert(mEngine != nullptr && numBuffers >= 2, "Invalid input.");
+
+    MapFile(filename);
+    if (!mMapping)
+    {
+        return;
+    }
+
+    unsigned int header[4];
+    std::memcpy(header, mMapping, sizeof(header));
+    mNumImages = header[0];
+    mType = static_cast<DFType>(header[1]);
+    mWidth = header[2];
+    mHeight = header[3];
+    if (mNumImages == 0 || mType <= DF_UNKNOWN || mType >= DF_NUM_FORMATS
+        || mWidth == 0 || mHeight == 0)
+    {
+        LogWarning("Invalid header in " + filename + ".");
+        UnmapFile();
+        return;
+    }
+
+    size_t const numImageBytes = static_cast<size_t>(mWidth) * mHeight *
+        DataFormat::GetNumBytesPerStruct(mType);
+    mRecordSize = sizeof(unsigned int) + numImageBytes;
+    if (mMappingSize < msHeaderSize + mNumImages * mRecordSize)
+    {
+        LogWarning("The file " + filename + " is too small for its images.");
+        UnmapFile();
+        return;
+    }
+
+    // Create the textures without system memory and bind them, so the
+    // graphics objects exist before the first frame. The data pointers are
+    // set to the mapped images by Update.
+    mTextures.resize(numBuffers);
+    for (auto& texture : mTextures)
+    {
+        texture = std::make_shared<Texture2>(mType, mWidth, mHeight, false, false);
+        texture->SetUsage(Resource::DYNAMIC_UPDATE);
+        texture->SetCopyType(Resource::COPY_CPU_TO_STAGING);
+        mEngine->Bind(texture);
+    }
+}
+
+void TextureStream::Start(double framesPerSecond)
+{
+    LogAssert(framesPerSecond >= 0.0, "Invalid frame rate.");
+    if (!IsValid())
+    {
+        return;
+    }
+
+    Stop();
+    mStop = false;
+    mProducer = std::thread(&TextureStream::ProducerThread, this, framesPerSecond);
+}
+
+void TextureStream::Stop()
+{
+    if (mProducer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCondition.notify_all();
+        mProducer.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.clear();
+}
+
+bool TextureStream::Update()
+{
+    QueuedImage image;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mQueue.size() == 0)
+        {
+            return false;
+        }
+        image = mQueue.front();
+        mQueue.pop_front();
+    }
+    mCondition.notify_all();
+
+    char* record = GetImageRecord(image.index);
+    auto const& texture = mTextures[mNextTexture];
+    mNextTexture = (mNextTexture + 1) % mTextures.size();
+    texture->SetData(record + sizeof(unsigned int));
+    mEngine->Update(texture);
+
+    std::memcpy(&mFrame.number, record, sizeof(mFrame.number));
+    mFrame.image = texture;
+    mFrame.microseconds = mProductionTimer.GetMicroseconds() - image.microseconds;
+
+    mPerformanceMicroseconds = mPerformanceTimer.GetMicroseconds();
+    ++mPerformanceFrames;
+    return true;
+}
+
+void TextureStream::ResetPerformanceMeasurements()
+{
+    mPerformanceFrames = 0;
+    mPerformanceMicroseconds = 0;
+    mPerformanceTimer.Reset();
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mNumDroppedFrames = 0;
+}
+
+double TextureStream::GetFramesPerSecond() const
+{
+    if (mPerformanceMicroseconds > 0)
+    {
+        double seconds = static_cast<double>(mPerformanceMicroseconds) / 1000000.0;
+        return static_cast<double>(mPerformanceFrames) / seconds;
+    }
+    return 0.0;
+}
+
+double TextureStream::GetSecondsPerFrame() const
+{
+    if (mPerformanceFrames > 0)
+    {
+        double seconds = static_cast<double>(mPerformanceMicroseconds) / 1000000.0;
+        return seconds / static_cast<double>(mPerformanceFrames);
+    }
+    return 0.0;
+}
+
+unsigned int TextureStream::GetNumDroppedFrames() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNumDroppedFrames;
+}
+
+void TextureStream::MapFile(std::string const& filename)
+{
+#if defined(GTE_USE_MSWINDOWS)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LogWarning("Cannot open " + filename + ".");
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(msHeaderSize))
+    {
+        LogWarning("The file " + filename + " is too small.");
+        CloseHandle(file);
+        return;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        LogWarning("Cannot map " + filename + ".");
+        CloseHandle(file);
+        return;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        LogWarning("Cannot map " + filename + ".");
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mMapping = static_cast<char*>(data);
+    mMappingSize = static_cast<size_t>(size.QuadPart);
+#else
+    int file = open(filename.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        LogWarning("Cannot open " + filename + ".");
+        return;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(msHeaderSize))
+    {
+        LogWarning("The file " + filename + " is too small.");
+        close(file);
+        return;
+    }
+
+    // The mapping remains valid after the file is closed.
+    size_t const size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        LogWarning("Cannot map " + filename + ".");
+        return;
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    mMapping = static_cast<char*>(data);
+    mMappingSize = size;
+#endif
+}
+
+void TextureStream::UnmapFile()
+{
+    if (mMapping)
+    {
+#if defined(GTE_USE_MSWINDOWS)
+        UnmapViewOfFile(mMapping);
+        CloseHandle(static_cast<HANDLE>(mMappingHandle));
+        CloseHandle(static_cast<HANDLE>(mFileHandle));
+        mMappingHandle = nullptr;
+        mFileHandle = nullptr;
+#else
+        munmap(mMapping, mMappingSize);
+#endif
+        mMapping = nullptr;
+        mMappingSize = 0;
+    }
+}
+
+void TextureStream::ProducerThread(double framesPerSecond)
+{
+    int64_t const microsecondsPerFrame = (framesPerSecond > 0.0 ?
+        static_cast<int64_t>(std::llround(1000000.0 / framesPerSecond)) : 0);
+    size_t const maxQueued = mTextures.size();
+    size_t const pageSize = 4096;
+    unsigned int index = 0;
+    int64_t nextMicroseconds = mProductionTimer.GetMicroseconds();
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            if (microsecondsPerFrame > 0)
+            {
+                int64_t const wait = nextMicroseconds - mProductionTimer.GetMicroseconds();
+                if (wait > 0)
+                {
+                    mCondition.wait_for(lock, std::chrono::microseconds(wait),
+                        [this]() { return mStop; });
+                }
+            }
+            else
+            {
+                mCondition.wait(lock, [this, maxQueued]()
+                {
+                    return mStop || mQueue.size() < maxQueued;
+                });
+            }
+            if (mStop)
+            {
+                return;
+            }
+        }
+
+        // Touch a byte of each page of the image, so that the pages are
+        // resident when the engine thread copies the image.
+        char const* record = GetImageRecord(index);
+        unsigned int sum = 0;
+        for (size_t i = 0; i < mRecordSize; i += pageSize)
+        {
+            sum += static_cast<unsigned char>(record[i]);
+        }
+        sum += static_cast<unsigned char>(record[mRecordSize - 1]);
+        volatile unsigned int touched = sum;
+        (void)touched;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueue.push_back({ index, mProductionTimer.GetMicroseconds() });
+            if (mQueue.size() > maxQueued)
+            {
+                mQueue.pop_front();
+                ++mNumDroppedFrames;
+            }
+        }
+
+        if (++index == mNumImages)
+        {
+            index = 0;
+        }
+
+        if (microsecondsPerFrame > 0)
+        {
+            // When the producer falls behind by more than a frame, the
+            // schedule restarts from the current time instead of producing
+            // a burst of frames.
+            nextMicroseconds += microsecondsPerFrame;
+            int64_t const current = mProductionTimer.GetMicroseconds();
+            if (nextMicroseconds + microsecondsPerFrame < current)
+            {
+                nextMicroseconds = current;
+            }
+        }
+    }
+}
@@ -0,0 +1,198 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/Texture2.h>
+#include <Mathematics/Timer.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A stream of 2D images, for example the frames of a camera, read from a
+// file and copied to textures for drawing. The file is binary with the
+// structure
+//   unsigned int numImages;
+//   DFType type;
+//   unsigned int width;
+//   unsigned int height;
+//   struct { unsigned int frameNumber; char data[N]; } image[numImages];
+// where N = width*height*DataFormat::GetNumBytesPerStruct(type), the format
+// of the FileVideoStream of the VideoStreams sample.
+//
+// The file is memory mapped, so no image is copied on the CPU: the textures
+// point to the images in the mapped file and the engine copies them
+// directly to the staging memory of the textures (a pixel unpack buffer for
+// OpenGL, a D3D11_MAP_WRITE_DISCARD mapping for Direct3D). A producer thread
+// started by Start selects the images at the specified frame rate and
+// touches their pages, so that the engine thread does not wait for the
+// disk, and queues them for the engine thread. Update, called once per
+// frame on the engine thread, copies the oldest queued image to the next
+// texture of a pool of numBuffers textures that are bound at construction.
+// Consecutive frames use different textures, so the copy of a frame does
+// not wait for the GPU to finish drawing the textures of the previous
+// numBuffers-1 frames (double buffering for 2 textures, triple buffering
+// for 3). The queue holds at most numBuffers images; when the engine thread
+// falls behind, the oldest images are dropped and counted.
+//
+// For several cameras, create a TextureStream per camera and call Update
+// for each of them every frame.
+
+namespace gte
+{
+    class TextureStream
+    {
+    public:
+        // Construction and destruction. The engine must be nonnull and
+        // numBuffers must be at least 2. IsValid() returns 'false' when the
+        // file cannot be mapped or is not of the correct format.
+        ~TextureStream();
+        TextureStream(std::string const& filename,
+            std::shared_ptr<GraphicsEngine> const& engine,
+            unsigned int numBuffers = 3);
+
+        // Member access.
+        inline bool IsValid() const
+        {
+            return mMapping != nullptr;
+        }
+
+        inline DFType GetType() const
+        {
+            return mType;
+        }
+
+        inline unsigned int GetWidth() const
+        {
+            return mWidth;
+        }
+
+        inline unsigned int GetHeight() const
+        {
+            return mHeight;
+        }
+
+        inline unsigned int GetNumImages() const
+        {
+            return mNumImages;
+        }
+
+        inline unsigned int GetNumBuffers() const
+        {
+            return static_cast<unsigned int>(mTextures.size());
+        }
+
+        // Start the producer thread with the specified frame rate. When
+        // framesPerSecond is 0, the producer queues images as fast as the
+        // engine thread consumes them and no images are dropped. Stop
+        // destroys the producer thread and empties the queue.
+        void Start(double framesPerSecond);
+        void Stop();
+
+        // A frame consists of a frame number (unique identifier), the
+        // texture that stores the image and the time (in microseconds) from
+        // the selection of the image by the producer to the end of its copy
+        // to the GPU.
+        struct Frame
+        {
+            Frame()
+                :
+                number(0xFFFFFFFF),
+                microseconds(0)
+            {
+            }
+
+            unsigned int number;
+            std::shared_ptr<Texture2> image;
+            int64_t microseconds;
+        };
+
+        // Copy the oldest queued image to a texture of the pool. The return
+        // value is 'true' when an image was queued, in which case GetFrame()
+        // returns the new frame. The texture of a frame is overwritten
+        // numBuffers frames later.
+        bool Update();
+
+        inline Frame const& GetFrame() const
+        {
+            return mFrame;
+        }
+
+        // Performance measurements. These are accumulated measurements
+        // starting from a call to ResetPerformanceMeasurements().
+        void ResetPerformanceMeasurements();
+
+        inline unsigned int GetPerformanceFrames() const
+        {
+            return mPerformanceFrames;
+        }
+
+        inline int64_t GetPerformanceMicroseconds() const
+        {
+            return mPerformanceMicroseconds;
+        }
+
+        double GetFramesPerSecond() const;
+        double GetSecondsPerFrame() const;
+        unsigned int GetNumDroppedFrames() const;
+
+    private:
+        // An image selected by the producer and the time of its selection.
+        struct QueuedImage
+        {
+            unsigned int index;
+            int64_t microseconds;
+        };
+
+        void MapFile(std::string const& filename);
+        void UnmapFile();
+        void ProducerThread(double framesPerSecond);
+
+        inline char* GetImageRecord(unsigned int index) const
+        {
+            return mMapping + msHeaderSize + static_cast<size_t>(index) * mRecordSize;
+        }
+
+        static size_t const msHeaderSize = 4 * sizeof(unsigned int);
+
+        // The mapped file.
+        char* mMapping;
+        size_t mMappingSize;
+#if defined(GTE_USE_MSWINDOWS)
+        void* mFileHandle;
+        void* mMappingHandle;
+#endif
+
+        // The image information.
+        DFType mType;
+        unsigned int mWidth, mHeight, mNumImages;
+        size_t mRecordSize;
+
+        // The textures of the frames.
+        std::shared_ptr<GraphicsEngine> mEngine;
+        std::vector<std::shared_ptr<Texture2>> mTextures;
+        size_t mNextTexture;
+        Frame mFrame;
+
+        // The queue of images shared with the producer thread.
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::deque<QueuedImage> mQueue;
+        std::thread mProducer;
+        bool mStop;
+        unsigned int mNumDroppedFrames;
+        Timer mProductionTimer;
+
+        // Performance measurements.
+        Timer mPerformanceTimer;
+        unsigned int mPerformanceFrames;
+        int64_t mPerformanceMicroseconds;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #include <Graphics/GTGraphicsPCH.h>
 #include <Graphics/TransformController.h>
@@ -12,7 +12,8 @@ using namespace gte;
 
 TransformController::TransformController(Transform<float> const& localTransform)
     :
-    mLocalTransform(localTransform)
+    mLocalTransform(localTransform),
+    mVersion(0)
 {
 }
 
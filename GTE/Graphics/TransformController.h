@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -21,6 +21,7 @@ namespace gte
         inline void SetTransform(Transform<float> const& localTransform)
         {
             mLocalTransform = localTransform;
+            ++mVersion;
         }
 
         inline Transform<float> const& GetTransform() const
@@ -34,7 +35,17 @@ namespace gte
         // transform that is constant for all time.
         virtual bool Update(double applicationTime) override;
 
+        // The version is incremented whenever mLocalTransform changes, so
+        // a controller that combines the transforms of other controllers
+        // can skip its work when none of them has changed. A derived class
+        // that modifies mLocalTransform must increment mVersion.
+        inline unsigned int GetVersion() const
+        {
+            return mVersion;
+        }
+
     protected:
         Transform<float> mLocalTransform;
+        unsigned int mVersion;
     };
 }
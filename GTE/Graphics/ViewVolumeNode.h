@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -55,6 +55,12 @@ namespace gte
             return mOnUpdate;
         }
 
+        // The view volume is updated by UpdateWorldData.
+        inline virtual bool CanFlattenUpdate() const override
+        {
+            return false;
+        }
+
     protected:
         // Geometric updates.
         virtual void UpdateWorldData(double applicationTime) override;
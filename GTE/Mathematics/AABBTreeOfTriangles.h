@@ -0,0 +1,1020 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/AlignedBox.h>
+#include <Mathematics/DistPointTriangle.h>
+#include <Mathematics/IntrRay3Triangle3.h>
+#include <Mathematics/IntrTriangle3OrientedBox3.h>
+#include <Mathematics/IntrTriangle3Triangle3.h>
+#include <Mathematics/Segment.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// A bounding volume hierarchy of axis-aligned boxes for the triangles of a
+// mesh. The tree is built top down. A node is split at one of the
+// boundaries of 16 bins of the triangle centroids along the axis of their
+// largest extent, selecting the boundary that minimizes the surface area
+// heuristic (the sum over both children of the number of triangles times
+// the surface area of the bounding box). A node with at most 'maxLeafSize'
+// triangles is a leaf. The subtrees below the top levels are built
+// concurrently when more than one thread is requested, and the tree is the
+// same for any number of threads.
+//
+// The nodes are stored in depth-first order. The left child of an interior
+// node immediately follows it and the right child is stored in the node.
+// The triangles are stored in leaf order, so the triangles of a leaf are
+// contiguous. The ray-box tests use the slab method with precomputed
+// reciprocals of the direction components, written as fixed-length loops
+// without branches that the compiler can vectorize.
+//
+// The queries are
+//   1. Ray and segment casts that find the first triangle hit, using the
+//      FIQuery for Ray3 and Triangle3. A segment P0,P1 is cast as the ray
+//      P0 + t*(P1-P0) with t in [0,1], so the parameter of its result is
+//      in [0,1]. As in the FIQuery, a ray parallel to a triangle does not
+//      hit the triangle.
+//   2. The closest point on the mesh to a point, using the DCPQuery for a
+//      point and Triangle3.
+//   3. The triangles that intersect an aligned box, using the TIQuery for
+//      Triangle3 and OrientedBox3.
+//   4. The pairs of intersecting triangles of two meshes, or of one mesh
+//      with itself, using the TIQuery for Triangle3 and Triangle3. For a
+//      single mesh, the pairs of triangles that share a vertex are not
+//      tested.
+// The batch versions of the queries distribute the inputs among threads
+// and return the same results as the single queries. The threads are
+// std::thread objects created for each call unless a scheduler is passed
+// to the constructor or specified by SetScheduler(*). The triangle indices
+// in the results are those of the 'indices' array passed to the
+// constructor.
+
+namespace gte
+{
+    template <typename Real>
+    class AABBTreeForTriangles
+    {
+    public:
+        // An interior node has count 0, its left child is the next node and
+        // its right child is 'offset'. A leaf node has count > 0 and stores
+        // the triangles offset through offset+count-1 of the leaf order.
+        struct Node
+        {
+            Node()
+                :
+                min{ (Real)0, (Real)0, (Real)0 },
+                max{ (Real)0, (Real)0, (Real)0 },
+                offset(0),
+                count(0),
+                axis(0)
+            {
+            }
+
+            std::array<Real, 3> min, max;
+            uint32_t offset, count, axis;
+        };
+
+        struct RayResult
+        {
+            RayResult()
+                :
+                intersect(false),
+                triangle(-1),
+                parameter((Real)0),
+                triangleBary{ (Real)0, (Real)0, (Real)0 },
+                point{ (Real)0, (Real)0, (Real)0 }
+            {
+            }
+
+            bool intersect;
+            int triangle;
+            Real parameter;
+            std::array<Real, 3> triangleBary;
+            Vector3<Real> point;
+        };
+
+        struct ClosestResult
+        {
+            ClosestResult()
+                :
+                triangle(-1),
+                distance((Real)0),
+                sqrDistance((Real)0),
+                triangleBary{ (Real)0, (Real)0, (Real)0 },
+                closest{ (Real)0, (Real)0, (Real)0 }
+            {
+            }
+
+            int triangle;
+            Real distance, sqrDistance;
+            std::array<Real, 3> triangleBary;
+            Vector3<Real> closest;
+        };
+
+        // Construction. The mesh has 'numTriangles' triangles whose vertex
+        // indices are indices[3*t], indices[3*t+1] and indices[3*t+2].
+        // The tree is built by 'numThreads' threads, which are tasks of the
+        // scheduler when it is not null.
+        AABBTreeForTriangles(int numVertices, Vector3<Real> const* vertices,
+            int numTriangles, int const* indices, int maxLeafSize = 4,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+            :
+            mMaxLeafSize(maxLeafSize),
+            mNumThreads(numThreads),
+            mScheduler(scheduler)
+        {
+            LogAssert(numVertices > 0 && vertices != nullptr && numTriangles > 0
+                && indices != nullptr && maxLeafSize > 0, "Invalid input.");
+
+            // Compute the bounding boxes and centroids of the triangles.
+            std::vector<std::array<Real, 3>> boxMin(numTriangles), boxMax(numTriangles);
+            std::vector<std::array<Real, 3>> centroid(numTriangles);
+            Execute(mNumThreads, static_cast<size_t>(numTriangles),
+                [numVertices, vertices, indices, &boxMin, &boxMax, &centroid](size_t begin, size_t end)
+                {
+                    for (size_t t = begin; t < end; ++t)
+                    {
+                        std::array<Vector3<Real> const*, 3> v;
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            int index = indices[3 * t + j];
+                            LogAssert(0 <= index && index < numVertices, "Invalid index.");
+                            v[j] = &vertices[index];
+                        }
+                        for (int d = 0; d < 3; ++d)
+                        {
+                            boxMin[t][d] = std::min(std::min((*v[0])[d], (*v[1])[d]), (*v[2])[d]);
+                            boxMax[t][d] = std::max(std::max((*v[0])[d], (*v[1])[d]), (*v[2])[d]);
+                            centroid[t][d] = (boxMin[t][d] + boxMax[t][d]) * (Real)0.5;
+                        }
+                    }
+                });
+
+            mOrder.resize(numTriangles);
+            for (int t = 0; t < numTriangles; ++t)
+            {
+                mOrder[t] = t;
+            }
+
+            BuildContext context{ boxMin, boxMax, centroid };
+            if (mNumThreads <= 1)
+            {
+                Build(context, 0, static_cast<uint32_t>(numTriangles), mNodes, nullptr, 0);
+            }
+            else
+            {
+                // Build the top levels of the tree in the calling thread.
+                // A subtree with at most 'maxTaskTriangles' triangles is
+                // represented by a placeholder node and built by a thread
+                // into its own array. The arrays are then spliced into
+                // the depth-first order.
+                uint32_t const maxTaskTriangles = std::max(static_cast<uint32_t>(numTriangles) /
+                    static_cast<uint32_t>(4 * mNumThreads), 1024u);
+                std::vector<Node> top;
+                std::vector<std::array<uint32_t, 2>> tasks;
+                Build(context, 0, static_cast<uint32_t>(numTriangles), top, &tasks, maxTaskTriangles);
+
+                std::vector<std::vector<Node>> subtrees(tasks.size());
+                Execute(mNumThreads, tasks.size(),
+                    [this, &context, &tasks, &subtrees](size_t begin, size_t end)
+                    {
+                        for (size_t k = begin; k < end; ++k)
+                        {
+                            Build(context, tasks[k][0], tasks[k][1], subtrees[k], nullptr, 0);
+                        }
+                    }, 1);
+
+                mNodes.reserve(top.size() + [&subtrees]()
+                    {
+                        size_t numNodes = 0;
+                        for (auto const& subtree : subtrees)
+                        {
+                            numNodes += subtree.size();
+                        }
+                        return numNodes;
+                    }());
+                Splice(top, 0, subtrees);
+            }
+
+            // Store the triangles in leaf order.
+            mTriangles.resize(numTriangles);
+            mIndices.resize(numTriangles);
+            for (int k = 0; k < numTriangles; ++k)
+            {
+                int t = mOrder[k];
+                for (int j = 0; j < 3; ++j)
+                {
+                    mIndices[k][j] = indices[3 * t + j];
+                    mTriangles[k].v[j] = vertices[mIndices[k][j]];
+                }
+            }
+        }
+
+        // Execute the batch queries as tasks of the scheduler, which can be
+        // shared with other computations, instead of creating threads for
+        // each call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // Member access.
+        inline int GetMaxLeafSize() const
+        {
+            return mMaxLeafSize;
+        }
+
+        inline std::vector<Node> const& GetNodes() const
+        {
+            return mNodes;
+        }
+
+        // The triangles in leaf order. The leaf-order triangle k is the
+        // input triangle GetOrder()[k].
+        inline std::vector<Triangle3<Real>> const& GetTriangles() const
+        {
+            return mTriangles;
+        }
+
+        inline std::vector<int> const& GetOrder() const
+        {
+            return mOrder;
+        }
+
+        // The vertex indices of the triangles in leaf order.
+        inline std::vector<std::array<int, 3>> const& GetIndices() const
+        {
+            return mIndices;
+        }
+
+        // Find the first triangle hit by the ray with parameter t in
+        // [0,tmax].
+        RayResult Intersect(Ray3<Real> const& ray,
+            Real tmax = std::numeric_limits<Real>::max()) const
+        {
+            std::vector<uint32_t> stack;
+            return Intersect(ray, tmax, stack);
+        }
+
+        // Find the first triangle hit by the segment.
+        RayResult Intersect(Segment3<Real> const& segment) const
+        {
+            std::vector<uint32_t> stack;
+            return Intersect(Ray3<Real>(segment.p[0], segment.p[1] - segment.p[0]), (Real)1, stack);
+        }
+
+        void Intersect(std::vector<Ray3<Real>> const& rays, std::vector<RayResult>& results,
+            size_t numThreads = 1, Real tmax = std::numeric_limits<Real>::max()) const
+        {
+            results.resize(rays.size());
+            Execute(numThreads, rays.size(),
+                [this, &rays, &results, tmax](size_t begin, size_t end)
+                {
+                    std::vector<uint32_t> stack;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        results[i] = Intersect(rays[i], tmax, stack);
+                    }
+                }, msBatchBlockSize);
+        }
+
+        void Intersect(std::vector<Segment3<Real>> const& segments, std::vector<RayResult>& results,
+            size_t numThreads = 1) const
+        {
+            results.resize(segments.size());
+            Execute(numThreads, segments.size(),
+                [this, &segments, &results](size_t begin, size_t end)
+                {
+                    std::vector<uint32_t> stack;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        Segment3<Real> const& segment = segments[i];
+                        results[i] = Intersect(Ray3<Real>(segment.p[0], segment.p[1] - segment.p[0]),
+                            (Real)1, stack);
+                    }
+                }, msBatchBlockSize);
+        }
+
+        // Find the closest point on the mesh to the point.
+        ClosestResult GetClosest(Vector3<Real> const& point) const
+        {
+            std::vector<std::pair<uint32_t, Real>> stack;
+            return GetClosest(point, stack);
+        }
+
+        void GetClosest(std::vector<Vector3<Real>> const& points, std::vector<ClosestResult>& results,
+            size_t numThreads = 1) const
+        {
+            results.resize(points.size());
+            Execute(numThreads, points.size(),
+                [this, &points, &results](size_t begin, size_t end)
+                {
+                    std::vector<std::pair<uint32_t, Real>> stack;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        results[i] = GetClosest(points[i], stack);
+                    }
+                }, msBatchBlockSize);
+        }
+
+        // Find the triangles that intersect the box, in increasing order.
+        void FindTriangles(AlignedBox3<Real> const& box, std::vector<int>& triangles) const
+        {
+            triangles.clear();
+            OrientedBox3<Real> obox;
+            box.GetCenteredForm(obox.center, obox.extent);
+            TIQuery<Real, Triangle3<Real>, OrientedBox3<Real>> query;
+
+            std::vector<uint32_t> stack;
+            stack.push_back(0);
+            while (stack.size() > 0)
+            {
+                Node const& node = mNodes[stack.back()];
+                uint32_t current = stack.back();
+                stack.pop_back();
+                if (!Overlaps(node, box.min, box.max))
+                {
+                    continue;
+                }
+
+                if (node.count > 0)
+                {
+                    for (uint32_t k = node.offset; k < node.offset + node.count; ++k)
+                    {
+                        if (query(mTriangles[k], obox).intersect)
+                        {
+                            triangles.push_back(mOrder[k]);
+                        }
+                    }
+                }
+                else
+                {
+                    stack.push_back(node.offset);
+                    stack.push_back(current + 1);
+                }
+            }
+            std::sort(triangles.begin(), triangles.end());
+        }
+
+        // The triangles that intersect boxes[i] are stored in
+        // triangles[offsets[i]] through triangles[offsets[i+1]-1].
+        void FindTriangles(std::vector<AlignedBox3<Real>> const& boxes, std::vector<int>& offsets,
+            std::vector<int>& triangles, size_t numThreads = 1) const
+        {
+            std::vector<std::vector<int>> boxTriangles(boxes.size());
+            Execute(numThreads, boxes.size(),
+                [this, &boxes, &boxTriangles](size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        FindTriangles(boxes[i], boxTriangles[i]);
+                    }
+                }, msBatchBlockSize);
+
+            offsets.resize(boxes.size() + 1);
+            offsets[0] = 0;
+            for (size_t i = 0; i < boxes.size(); ++i)
+            {
+                offsets[i + 1] = offsets[i] + static_cast<int>(boxTriangles[i].size());
+            }
+            triangles.resize(static_cast<size_t>(offsets.back()));
+            for (size_t i = 0; i < boxes.size(); ++i)
+            {
+                std::copy(boxTriangles[i].begin(), boxTriangles[i].end(), triangles.begin() + offsets[i]);
+            }
+        }
+
+        // Find the pairs (i,j) of intersecting triangles, where i is a
+        // triangle of this mesh and j is a triangle of the other mesh. The
+        // pairs are sorted.
+        void FindIntersections(AABBTreeForTriangles const& other,
+            std::vector<std::array<int, 2>>& pairs, size_t numThreads = 1) const
+        {
+            FindIntersections(other, false, pairs, numThreads);
+        }
+
+        // Find the pairs (i,j), i < j, of intersecting triangles of this
+        // mesh that do not share a vertex. The pairs are sorted.
+        void FindSelfIntersections(std::vector<std::array<int, 2>>& pairs,
+            size_t numThreads = 1) const
+        {
+            FindIntersections(*this, true, pairs, numThreads);
+        }
+
+        // The broadphase of FindIntersections and FindSelfIntersections,
+        // which finds the pairs (a,b) of leaf nodes with overlapping boxes,
+        // where a is a node of this tree and b is a node of the other tree.
+        // When 'self' is true, the other tree must be this tree, and a pair
+        // (a,a) stands for the pairs of distinct triangles of the leaf. The
+        // triangle pairs of the leaf pairs can then be tested by another
+        // narrowphase, for example the one of GPUAllPairsTriangles.
+        void FindOverlappingLeaves(AABBTreeForTriangles const& other, bool self,
+            std::vector<std::array<uint32_t, 2>>& leafPairs) const
+        {
+            LogAssert(!self || &other == this, "Invalid input.");
+
+            leafPairs.clear();
+            std::vector<std::array<uint32_t, 2>> stack;
+            stack.push_back({ 0, 0 });
+            while (stack.size() > 0)
+            {
+                std::array<uint32_t, 2> nodePair = stack.back();
+                stack.pop_back();
+                Node const& node0 = mNodes[nodePair[0]];
+                Node const& node1 = other.mNodes[nodePair[1]];
+                if (!Overlaps(node0, node1))
+                {
+                    continue;
+                }
+
+                if (node0.count > 0 && node1.count > 0)
+                {
+                    leafPairs.push_back(nodePair);
+                }
+                else
+                {
+                    Expand(other, self, nodePair, stack);
+                }
+            }
+        }
+
+    private:
+        // The number of bins of the surface area heuristic.
+        enum { msNumBins = 16 };
+
+        // The number of queries fetched at a time by the batch queries.
+        enum { msBatchBlockSize = 64 };
+
+        struct BuildContext
+        {
+            std::vector<std::array<Real, 3>> const& boxMin;
+            std::vector<std::array<Real, 3>> const& boxMax;
+            std::vector<std::array<Real, 3>> const& centroid;
+        };
+
+        static Real GetArea(std::array<Real, 3> const& min, std::array<Real, 3> const& max)
+        {
+            Real dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+            return dx * dy + dy * dz + dz * dx;
+        }
+
+        static void Grow(std::array<Real, 3>& min, std::array<Real, 3>& max,
+            std::array<Real, 3> const& otherMin, std::array<Real, 3> const& otherMax)
+        {
+            for (int d = 0; d < 3; ++d)
+            {
+                min[d] = std::min(min[d], otherMin[d]);
+                max[d] = std::max(max[d], otherMax[d]);
+            }
+        }
+
+        // Build the subtree for the triangles mOrder[i0] through
+        // mOrder[i1-1], appending its nodes in depth-first order. When
+        // 'tasks' is not null, a subtree with at most 'maxTaskTriangles'
+        // triangles is deferred. Its placeholder node has count
+        // std::numeric_limits<uint32_t>::max() and offset equal to the task
+        // index.
+        void Build(BuildContext const& context, uint32_t i0, uint32_t i1, std::vector<Node>& nodes,
+            std::vector<std::array<uint32_t, 2>>* tasks, uint32_t maxTaskTriangles)
+        {
+            uint32_t const nodeIndex = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(Node());
+            uint32_t const numTriangles = i1 - i0;
+            if (tasks && numTriangles <= maxTaskTriangles)
+            {
+                nodes[nodeIndex].count = std::numeric_limits<uint32_t>::max();
+                nodes[nodeIndex].offset = static_cast<uint32_t>(tasks->size());
+                tasks->push_back({ i0, i1 });
+                return;
+            }
+
+            // Compute the bounding box of the triangles and of the
+            // centroids.
+            std::array<Real, 3> min = context.boxMin[mOrder[i0]];
+            std::array<Real, 3> max = context.boxMax[mOrder[i0]];
+            std::array<Real, 3> cmin = context.centroid[mOrder[i0]];
+            std::array<Real, 3> cmax = cmin;
+            for (uint32_t i = i0 + 1; i < i1; ++i)
+            {
+                int t = mOrder[i];
+                Grow(min, max, context.boxMin[t], context.boxMax[t]);
+                Grow(cmin, cmax, context.centroid[t], context.centroid[t]);
+            }
+            nodes[nodeIndex].min = min;
+            nodes[nodeIndex].max = max;
+
+            uint32_t axis = 0;
+            for (uint32_t d = 1; d < 3; ++d)
+            {
+                if (cmax[d] - cmin[d] > cmax[axis] - cmin[axis])
+                {
+                    axis = d;
+                }
+            }
+
+            if (numTriangles <= static_cast<uint32_t>(mMaxLeafSize) || !(cmax[axis] > cmin[axis]))
+            {
+                // The triangles are few or their centroids coincide.
+                nodes[nodeIndex].offset = i0;
+                nodes[nodeIndex].count = numTriangles;
+                return;
+            }
+
+            // Accumulate the triangles in bins of the centroids.
+            Real const binScale = static_cast<Real>(msNumBins) / (cmax[axis] - cmin[axis]);
+            auto getBin = [&context, axis, &cmin, binScale](int t)
+            {
+                int bin = static_cast<int>((context.centroid[t][axis] - cmin[axis]) * binScale);
+                return std::min(std::max(bin, 0), static_cast<int>(msNumBins) - 1);
+            };
+
+            std::array<uint32_t, msNumBins> binCount;
+            std::array<std::array<Real, 3>, msNumBins> binMin, binMax;
+            binCount.fill(0);
+            for (uint32_t i = i0; i < i1; ++i)
+            {
+                int t = mOrder[i];
+                int bin = getBin(t);
+                if (binCount[bin]++ == 0)
+                {
+                    binMin[bin] = context.boxMin[t];
+                    binMax[bin] = context.boxMax[t];
+                }
+                else
+                {
+                    Grow(binMin[bin], binMax[bin], context.boxMin[t], context.boxMax[t]);
+                }
+            }
+
+            // Sweep from the right to get the costs of the right sides,
+            // then from the left to select the best split. The split k
+            // places bins 0 through k-1 on the left.
+            std::array<Real, msNumBins> rightCost;
+            std::array<Real, 3> sideMin{}, sideMax{};
+            uint32_t sideCount = 0;
+            for (int k = msNumBins - 1; k > 0; --k)
+            {
+                if (binCount[k] > 0)
+                {
+                    if (sideCount == 0)
+                    {
+                        sideMin = binMin[k];
+                        sideMax = binMax[k];
+                    }
+                    else
+                    {
+                        Grow(sideMin, sideMax, binMin[k], binMax[k]);
+                    }
+                    sideCount += binCount[k];
+                }
+                rightCost[k] = (sideCount > 0 ? static_cast<Real>(sideCount) * GetArea(sideMin, sideMax) : (Real)0);
+            }
+
+            int bestSplit = -1;
+            Real bestCost = std::numeric_limits<Real>::max();
+            sideCount = 0;
+            for (int k = 1; k < msNumBins; ++k)
+            {
+                if (binCount[k - 1] > 0)
+                {
+                    if (sideCount == 0)
+                    {
+                        sideMin = binMin[k - 1];
+                        sideMax = binMax[k - 1];
+                    }
+                    else
+                    {
+                        Grow(sideMin, sideMax, binMin[k - 1], binMax[k - 1]);
+                    }
+                    sideCount += binCount[k - 1];
+                }
+
+                if (sideCount > 0 && sideCount < numTriangles)
+                {
+                    Real cost = static_cast<Real>(sideCount) * GetArea(sideMin, sideMax) + rightCost[k];
+                    if (cost < bestCost)
+                    {
+                        bestCost = cost;
+                        bestSplit = k;
+                    }
+                }
+            }
+
+            // The first and last bins are not empty, so a split exists.
+            auto mid = std::partition(mOrder.begin() + i0, mOrder.begin() + i1,
+                [&getBin, bestSplit](int t) { return getBin(t) < bestSplit; });
+            uint32_t const im = static_cast<uint32_t>(mid - mOrder.begin());
+
+            nodes[nodeIndex].axis = axis;
+            Build(context, i0, im, nodes, tasks, maxTaskTriangles);
+            nodes[nodeIndex].offset = static_cast<uint32_t>(nodes.size());
+            Build(context, im, i1, nodes, tasks, maxTaskTriangles);
+        }
+
+        // Append the subtree of 'top' at index i to mNodes, replacing the
+        // placeholders by the subtrees built by the threads.
+        void Splice(std::vector<Node> const& top, uint32_t i, std::vector<std::vector<Node>> const& subtrees)
+        {
+            Node const& node = top[i];
+            uint32_t const base = static_cast<uint32_t>(mNodes.size());
+            if (node.count == std::numeric_limits<uint32_t>::max())
+            {
+                for (auto subnode : subtrees[node.offset])
+                {
+                    if (subnode.count == 0)
+                    {
+                        subnode.offset += base;
+                    }
+                    mNodes.push_back(subnode);
+                }
+            }
+            else if (node.count > 0)
+            {
+                mNodes.push_back(node);
+            }
+            else
+            {
+                mNodes.push_back(node);
+                Splice(top, i + 1, subtrees);
+                mNodes[base].offset = static_cast<uint32_t>(mNodes.size());
+                Splice(top, node.offset, subtrees);
+            }
+        }
+
+        // Slab test of the node box against the ray segment with t in
+        // [0,tmax]. The entry parameter is returned in 'tmin'.
+        inline static bool Overlaps(Node const& node, std::array<Real, 3> const& origin,
+            std::array<Real, 3> const& invDirection, Real tmax, Real& tmin)
+        {
+            std::array<Real, 3> t0, t1;
+            for (int d = 0; d < 3; ++d)
+            {
+                t0[d] = (node.min[d] - origin[d]) * invDirection[d];
+                t1[d] = (node.max[d] - origin[d]) * invDirection[d];
+            }
+            Real tnear = (Real)0, tfar = tmax;
+            for (int d = 0; d < 3; ++d)
+            {
+                tnear = std::max(tnear, std::min(t0[d], t1[d]));
+                tfar = std::min(tfar, std::max(t0[d], t1[d]));
+            }
+            tmin = tnear;
+            return tnear <= tfar;
+        }
+
+        inline static bool Overlaps(Node const& node, Vector3<Real> const& min, Vector3<Real> const& max)
+        {
+            return node.min[0] <= max[0] && node.max[0] >= min[0]
+                && node.min[1] <= max[1] && node.max[1] >= min[1]
+                && node.min[2] <= max[2] && node.max[2] >= min[2];
+        }
+
+        inline static bool Overlaps(Node const& node0, Node const& node1)
+        {
+            return node0.min[0] <= node1.max[0] && node0.max[0] >= node1.min[0]
+                && node0.min[1] <= node1.max[1] && node0.max[1] >= node1.min[1]
+                && node0.min[2] <= node1.max[2] && node0.max[2] >= node1.min[2];
+        }
+
+        inline static Real GetSqrDistance(Node const& node, Vector3<Real> const& point)
+        {
+            Real sqrDistance = (Real)0;
+            for (int d = 0; d < 3; ++d)
+            {
+                Real diff = std::max(std::max(node.min[d] - point[d], point[d] - node.max[d]), (Real)0);
+                sqrDistance += diff * diff;
+            }
+            return sqrDistance;
+        }
+
+        RayResult Intersect(Ray3<Real> const& ray, Real tmax, std::vector<uint32_t>& stack) const
+        {
+            // A zero direction component has an infinite reciprocal, for
+            // which the slab test still produces the correct interval.
+            std::array<Real, 3> origin, invDirection;
+            for (int d = 0; d < 3; ++d)
+            {
+                origin[d] = ray.origin[d];
+                invDirection[d] = (Real)1 / ray.direction[d];
+            }
+
+            RayResult result;
+            FIQuery<Real, Ray3<Real>, Triangle3<Real>> query;
+            stack.clear();
+            stack.push_back(0);
+            while (stack.size() > 0)
+            {
+                uint32_t current = stack.back();
+                stack.pop_back();
+                Node const& node = mNodes[current];
+                Real tmin;
+                if (!Overlaps(node, origin, invDirection, tmax, tmin))
+                {
+                    continue;
+                }
+
+                if (node.count > 0)
+                {
+                    for (uint32_t k = node.offset; k < node.offset + node.count; ++k)
+                    {
+                        auto hit = query(ray, mTriangles[k]);
+                        if (hit.intersect && hit.parameter <= tmax &&
+                            (!result.intersect || hit.parameter < result.parameter))
+                        {
+                            result.intersect = true;
+                            result.triangle = mOrder[k];
+                            result.parameter = hit.parameter;
+                            result.triangleBary = hit.triangleBary;
+                            result.point = hit.point;
+                            tmax = hit.parameter;
+                        }
+                    }
+                }
+                else
+                {
+                    // Visit first the child on the side the ray enters.
+                    if (ray.direction[node.axis] >= (Real)0)
+                    {
+                        stack.push_back(node.offset);
+                        stack.push_back(current + 1);
+                    }
+                    else
+                    {
+                        stack.push_back(current + 1);
+                        stack.push_back(node.offset);
+                    }
+                }
+            }
+            return result;
+        }
+
+        ClosestResult GetClosest(Vector3<Real> const& point,
+            std::vector<std::pair<uint32_t, Real>>& stack) const
+        {
+            ClosestResult result;
+            result.sqrDistance = std::numeric_limits<Real>::max();
+            DCPQuery<Real, Vector3<Real>, Triangle3<Real>> query;
+
+            // Each stack element stores a node and the squared distance
+            // from the point to its box.
+            stack.clear();
+            stack.push_back(std::make_pair(0u, GetSqrDistance(mNodes[0], point)));
+            while (stack.size() > 0)
+            {
+                uint32_t current = stack.back().first;
+                Real sqrDistance = stack.back().second;
+                stack.pop_back();
+                if (sqrDistance >= result.sqrDistance)
+                {
+                    continue;
+                }
+
+                Node const& node = mNodes[current];
+                if (node.count > 0)
+                {
+                    for (uint32_t k = node.offset; k < node.offset + node.count; ++k)
+                    {
+                        auto dcp = query(point, mTriangles[k]);
+                        if (dcp.sqrDistance < result.sqrDistance)
+                        {
+                            result.triangle = mOrder[k];
+                            result.distance = dcp.distance;
+                            result.sqrDistance = dcp.sqrDistance;
+                            for (int j = 0; j < 3; ++j)
+                            {
+                                result.triangleBary[j] = dcp.parameter[j];
+                            }
+                            result.closest = dcp.closest;
+                        }
+                    }
+                }
+                else
+                {
+                    // Visit the nearer child first by pushing it last.
+                    uint32_t left = current + 1, right = node.offset;
+                    Real sqrDistanceL = GetSqrDistance(mNodes[left], point);
+                    Real sqrDistanceR = GetSqrDistance(mNodes[right], point);
+                    if (sqrDistanceL <= sqrDistanceR)
+                    {
+                        stack.push_back(std::make_pair(right, sqrDistanceR));
+                        stack.push_back(std::make_pair(left, sqrDistanceL));
+                    }
+                    else
+                    {
+                        stack.push_back(std::make_pair(left, sqrDistanceL));
+                        stack.push_back(std::make_pair(right, sqrDistanceR));
+                    }
+                }
+            }
+            return result;
+        }
+
+        static bool ShareVertex(std::array<int, 3> const& t0, std::array<int, 3> const& t1)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    if (t0[i] == t1[j])
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Simultaneous traversal of the trees. For a self query, only the
+        // node pairs (a,b) with a <= b are visited.
+        void FindIntersections(AABBTreeForTriangles const& other, bool self,
+            std::vector<std::array<int, 2>>& pairs, size_t numThreads) const
+        {
+            pairs.clear();
+
+            // Expand the node pairs breadth first until there are enough of
+            // them to distribute among the threads.
+            std::vector<std::array<uint32_t, 2>> frontier, next;
+            frontier.push_back({ 0, 0 });
+            size_t const minFrontier = (numThreads > 1 ? 16 * numThreads : 1);
+            while (frontier.size() > 0 && frontier.size() < minFrontier)
+            {
+                next.clear();
+                bool expanded = false;
+                for (auto const& nodePair : frontier)
+                {
+                    expanded = Expand(other, self, nodePair, next) || expanded;
+                }
+                frontier.swap(next);
+                if (!expanded)
+                {
+                    break;
+                }
+            }
+
+            std::vector<std::vector<std::array<int, 2>>> framePairs(frontier.size());
+            Execute(numThreads, frontier.size(),
+                [this, &other, self, &frontier, &framePairs](size_t begin, size_t end)
+                {
+                    TIQuery<Real, Triangle3<Real>, Triangle3<Real>> query;
+                    std::vector<std::array<uint32_t, 2>> stack;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        stack.clear();
+                        stack.push_back(frontier[i]);
+                        while (stack.size() > 0)
+                        {
+                            std::array<uint32_t, 2> nodePair = stack.back();
+                            stack.pop_back();
+                            Node const& node0 = mNodes[nodePair[0]];
+                            Node const& node1 = other.mNodes[nodePair[1]];
+                            if (!Overlaps(node0, node1))
+                            {
+                                continue;
+                            }
+
+                            if (node0.count > 0 && node1.count > 0)
+                            {
+                                TestLeaves(other, self, node0, node1, query, framePairs[i]);
+                            }
+                            else
+                            {
+                                Expand(other, self, nodePair, stack);
+                            }
+                        }
+                    }
+                }, 1);
+
+            for (auto& output : framePairs)
+            {
+                pairs.insert(pairs.end(), output.begin(), output.end());
+            }
+            std::sort(pairs.begin(), pairs.end());
+        }
+
+        // Append the overlapping child pairs of an overlapping node pair.
+        // Leaf pairs are appended unchanged. The function returns 'false'
+        // when the pair is a leaf pair or its boxes do not overlap.
+        bool Expand(AABBTreeForTriangles const& other, bool self,
+            std::array<uint32_t, 2> const& nodePair, std::vector<std::array<uint32_t, 2>>& output) const
+        {
+            uint32_t a = nodePair[0], b = nodePair[1];
+            Node const& node0 = mNodes[a];
+            Node const& node1 = other.mNodes[b];
+            if (!Overlaps(node0, node1))
+            {
+                return false;
+            }
+
+            if (node0.count > 0 && node1.count > 0)
+            {
+                output.push_back(nodePair);
+                return false;
+            }
+
+            if (self && a == b)
+            {
+                uint32_t left = a + 1, right = node0.offset;
+                output.push_back({ left, left });
+                output.push_back({ left, right });
+                output.push_back({ right, right });
+            }
+            else if (node1.count > 0 || (node0.count == 0 &&
+                GetArea(node0.min, node0.max) >= GetArea(node1.min, node1.max)))
+            {
+                // Descend the first tree.
+                output.push_back({ a + 1, b });
+                output.push_back({ node0.offset, b });
+            }
+            else
+            {
+                // Descend the second tree.
+                output.push_back({ a, b + 1 });
+                output.push_back({ a, node1.offset });
+            }
+            return true;
+        }
+
+        void TestLeaves(AABBTreeForTriangles const& other, bool self, Node const& node0, Node const& node1,
+            TIQuery<Real, Triangle3<Real>, Triangle3<Real>>& query,
+            std::vector<std::array<int, 2>>& output) const
+        {
+            for (uint32_t k0 = node0.offset; k0 < node0.offset + node0.count; ++k0)
+            {
+                uint32_t k1 = node1.offset;
+                if (self && &node0 == &node1)
+                {
+                    k1 = k0 + 1;
+                }
+                for (; k1 < node1.offset + node1.count; ++k1)
+                {
+                    if (self && ShareVertex(mIndices[k0], mIndices[k1]))
+                    {
+                        continue;
+                    }
+
+                    if (query(mTriangles[k0], other.mTriangles[k1]).intersect)
+                    {
+                        int t0 = mOrder[k0], t1 = other.mOrder[k1];
+                        if (self && t0 > t1)
+                        {
+                            std::swap(t0, t1);
+                        }
+                        output.push_back({ t0, t1 });
+                    }
+                }
+            }
+        }
+
+        // Apply function(begin, end) to blocks of 'blockSize' consecutive
+        // items of [0,numItems). The threads fetch the blocks in increasing
+        // order.
+        template <typename Function>
+        void Execute(size_t numThreads, size_t numItems, Function const& function,
+            size_t blockSize = 0) const
+        {
+            if (blockSize == 0)
+            {
+                blockSize = std::max(numItems / std::max(numThreads, static_cast<size_t>(1)),
+                    static_cast<size_t>(1));
+            }
+            size_t const numBlocks = (numItems + blockSize - 1) / blockSize;
+            numThreads = std::min(numThreads, numBlocks);
+            if (numThreads <= 1)
+            {
+                function(0, numItems);
+                return;
+            }
+
+            TaskScheduler::ParallelForDynamic(mScheduler, numBlocks, numThreads,
+                [&function, numItems, blockSize](size_t block)
+                {
+                    size_t begin = block * blockSize;
+                    function(begin, std::min(begin + blockSize, numItems));
+                });
+        }
+
+        int mMaxLeafSize;
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
+        std::vector<Node> mNodes;
+        std::vector<int> mOrder;
+        std::vector<Triangle3<Real>> mTriangles;
+        std::vector<std::array<int, 3>> mIndices;
+    };
+}
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Approximations to acos(x) of the form f(x) = sqrt(1-x)*p(x)
 // where the polynomial p(x) of degree D minimizes the quantity
@@ -29,69 +30,92 @@ namespace gte
             return Evaluate(degree<D>(), x);
         }
 
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Evaluate(degree<D>(), x);
+        }
+
+        // Evaluate the estimates for an array, result[i] = Degree<D>(x[i]),
+        // 4 elements at a time. The arrays may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
     private:
         // Metaprogramming and private implementation to allow specialization
         // of a template member function.
         template <int D> struct degree {};
 
-        inline static Real Evaluate(degree<1>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<1>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG1_C1;
             poly = (Real)GTE_C_ACOS_DEG1_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<2>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<2>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG2_C2;
             poly = (Real)GTE_C_ACOS_DEG2_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG2_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<3>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<3>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG3_C3;
             poly = (Real)GTE_C_ACOS_DEG3_C2 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG3_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG3_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<4>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<4>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG4_C4;
             poly = (Real)GTE_C_ACOS_DEG4_C3 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG4_C2 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG4_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG4_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<5>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<5>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG5_C5;
             poly = (Real)GTE_C_ACOS_DEG5_C4 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG5_C3 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG5_C2 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG5_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG5_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<6>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<6>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG6_C6;
             poly = (Real)GTE_C_ACOS_DEG6_C5 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG6_C4 + poly * x;
@@ -99,13 +123,14 @@ namespace gte
             poly = (Real)GTE_C_ACOS_DEG6_C2 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG6_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG6_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<7>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<7>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG7_C7;
             poly = (Real)GTE_C_ACOS_DEG7_C6 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG7_C5 + poly * x;
@@ -114,13 +139,14 @@ namespace gte
             poly = (Real)GTE_C_ACOS_DEG7_C2 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG7_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG7_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
 
-        inline static Real Evaluate(degree<8>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<8>, T const& x)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_ACOS_DEG8_C8;
             poly = (Real)GTE_C_ACOS_DEG8_C7 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG8_C6 + poly * x;
@@ -130,8 +156,18 @@ namespace gte
             poly = (Real)GTE_C_ACOS_DEG8_C2 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG8_C1 + poly * x;
             poly = (Real)GTE_C_ACOS_DEG8_C0 + poly * x;
-            poly = poly * std::sqrt((Real)1 - x);
+            poly = poly * Sqrt((Real)1 - x);
             return poly;
         }
+
+        inline static Real Sqrt(Real x)
+        {
+            return std::sqrt(x);
+        }
+
+        inline static SIMD4Value<Real> Sqrt(SIMD4Value<Real> const& x)
+        {
+            return SIMD4Value<Real>::Sqrt(x);
+        }
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -26,7 +26,24 @@ namespace gte
         template <int D>
         inline static Real Degree(Real x)
         {
-            return (Real)GTE_C_HALF_PI - ACosEstimate<Real>::Degree<D>(x);
+            return (Real)GTE_C_HALF_PI - ACosEstimate<Real>::template Degree<D>(x);
+        }
+
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return (Real)GTE_C_HALF_PI - ACosEstimate<Real>::template Degree<D>(x);
+        }
+
+        // Evaluate the estimates for an array, result[i] = Degree<D>(x[i]),
+        // 4 elements at a time. The arrays may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
         }
     };
 }
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Minimax polynomial approximations to atan(x).  The polynomial p(x) of
 // degree D has only odd-power terms, is required to have linear term x,
@@ -52,25 +53,63 @@ namespace gte
             }
         }
 
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Evaluate(degree<D>(), x);
+        }
+
+        template <int D>
+        inline static SIMD4Value<Real> DegreeRR(SIMD4Value<Real> const& x)
+        {
+            typedef SIMD4Value<Real> V;
+            V const one = (Real)1;
+            V above = one < x, below = x < -one;
+            V poly = Degree<D>(V::Select(one < V::Abs(x), one / x, x));
+            return V::Select(above, (Real)GTE_C_HALF_PI - poly,
+                V::Select(below, (Real)-GTE_C_HALF_PI - poly, poly));
+        }
+
+        // Evaluate the estimates for arrays, result[i] = Degree<D>(x[i]) or
+        // result[i] = DegreeRR<D>(x[i]), 4 elements at a time. The arrays
+        // may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
+        template <int D>
+        static void DegreeRR(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return DegreeRR<D>(v); });
+        }
+
     private:
         // Metaprogramming and private implementation to allow specialization
         // of a template member function.
         template <int D> struct degree {};
 
-        inline static Real Evaluate(degree<3>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<3>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_ATAN_DEG3_C1;
             poly = (Real)GTE_C_ATAN_DEG3_C0 + poly * xsqr;
             poly = poly * x;
             return poly;
         }
 
-        inline static Real Evaluate(degree<5>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<5>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_ATAN_DEG5_C2;
             poly = (Real)GTE_C_ATAN_DEG5_C1 + poly * xsqr;
             poly = (Real)GTE_C_ATAN_DEG5_C0 + poly * xsqr;
@@ -78,10 +117,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<7>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<7>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_ATAN_DEG7_C3;
             poly = (Real)GTE_C_ATAN_DEG7_C2 + poly * xsqr;
             poly = (Real)GTE_C_ATAN_DEG7_C1 + poly * xsqr;
@@ -90,10 +130,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<9>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<9>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_ATAN_DEG9_C4;
             poly = (Real)GTE_C_ATAN_DEG9_C3 + poly * xsqr;
             poly = (Real)GTE_C_ATAN_DEG9_C2 + poly * xsqr;
@@ -103,10 +144,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<11>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<11>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_ATAN_DEG11_C5;
             poly = (Real)GTE_C_ATAN_DEG11_C4 + poly * xsqr;
             poly = (Real)GTE_C_ATAN_DEG11_C3 + poly * xsqr;
@@ -117,10 +159,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<13>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<13>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_ATAN_DEG13_C6;
             poly = (Real)GTE_C_ATAN_DEG13_C5 + poly * xsqr;
             poly = (Real)GTE_C_ATAN_DEG13_C4 + poly * xsqr;
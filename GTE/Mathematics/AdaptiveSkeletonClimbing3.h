@@ -3,14 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.14
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/Array2.h>
 #include <Mathematics/Math.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/TriangleKey.h>
+#include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -22,6 +25,11 @@
 //   Computer Graphics forum, volume 17, issue 3, September 1998
 //   pages 137-147
 // https://onlinelibrary.wiley.com/doi/abs/10.1111/1467-8659.00261
+//
+// ExtractTiled processes an image of any dimensions by partitioning it into
+// tiles of (2^N+1)-by-(2^N+1)-by-(2^N+1) voxels that share their boundary
+// planes, as described for the 'fixBoundary' parameter of the constructor,
+// and extracts the tiles concurrently.
 
 namespace gte
 {
@@ -51,7 +59,6 @@ namespace gte
             mSizeSqr(mSize * mSize),
             mInputVoxels(inputVoxels),
             mLevel((Real)0),
-            mFixBoundary(fixBoundary),
             mXMerge(mSize, mSize),
             mYMerge(mSize, mSize),
             mZMerge(mSize, mSize)
@@ -63,6 +70,13 @@ namespace gte
                 LogError("Invalid input.");
             }
 
+            for (int i = 0; i < 3; ++i)
+            {
+                mFixMin[i] = fixBoundary;
+                mFixMax[i] = (fixBoundary ? mTwoPowerN : -1);
+                mClip[i] = mTwoPowerN;
+            }
+
             for (int i = 0; i < mSize; ++i)
             {
                 for (int j = 0; j < mSize; ++j)
@@ -94,6 +108,140 @@ namespace gte
             triangles = std::move(localTriangles);
         }
 
+        // Extract the level surface of an xBound-by-yBound-by-zBound image,
+        // organized in lexicographic order for (x,y,z), where each bound is
+        // at least 2. The image is partitioned into tiles whose voxel
+        // indices are [k*2^N, (k+1)*2^N] along each axis, so adjacent tiles
+        // share a plane of voxels. The tiles are distributed among
+        // 'numThreads' threads, which are tasks of the scheduler when it is
+        // not null, and each tile is extracted with its own
+        // AdaptiveSkeletonClimbing3 object. The voxels adjacent to a
+        // shared plane are not merged, so the tessellations of the two
+        // tiles agree on the plane, and the vertices on the shared planes
+        // are assigned the same coordinates in both tiles. As for Extract,
+        // the triangles do not share vertices; call MakeUnique to weld the
+        // vertices. A tile that extends beyond the image uses copies of the
+        // last voxels of the image, and its boxes beyond the image are not
+        // tessellated. The vertices are in image coordinates.
+        static void ExtractTiled(int xBound, int yBound, int zBound, T const* inputVoxels,
+            int N, Real level, int depth, std::vector<Vertex>& vertices,
+            std::vector<Triangle>& triangles, size_t numThreads,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(xBound >= 2 && yBound >= 2 && zBound >= 2 && N > 0 && inputVoxels != nullptr,
+                "Invalid input.");
+
+            int const twoPowerN = (1 << N), size = twoPowerN + 1;
+            std::array<int, 3> const bound = { xBound, yBound, zBound };
+            std::array<int, 3> numTiles;
+            for (int i = 0; i < 3; ++i)
+            {
+                numTiles[i] = (bound[i] - 2) / twoPowerN + 1;
+            }
+            size_t const totalTiles = static_cast<size_t>(numTiles[0]) * numTiles[1] * numTiles[2];
+            std::vector<std::vector<Vertex>> tileVertices(totalTiles);
+            std::vector<std::vector<Triangle>> tileTriangles(totalTiles);
+
+            TaskScheduler::ParallelForDynamic(scheduler, totalTiles, numThreads,
+                [&](size_t tile)
+                {
+                    std::vector<T> voxels(static_cast<size_t>(size) * size * size);
+                    AdaptiveSkeletonClimbing3 extractor(N, voxels.data(), false);
+
+                    std::array<int, 3> const index = {
+                        static_cast<int>(tile % numTiles[0]),
+                        static_cast<int>((tile / numTiles[0]) % numTiles[1]),
+                        static_cast<int>(tile / (static_cast<size_t>(numTiles[0]) * numTiles[1])) };
+                    std::array<int, 3> origin;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        origin[i] = index[i] * twoPowerN;
+                        extractor.mFixMin[i] = (index[i] > 0);
+                        extractor.mClip[i] = std::min(twoPowerN, bound[i] - 1 - origin[i]);
+                        extractor.mFixMax[i] = (index[i] + 1 < numTiles[i] ||
+                            extractor.mClip[i] < twoPowerN ? extractor.mClip[i] : -1);
+                    }
+
+                    // Copy the voxels of the tile, clamping the indices to
+                    // the image.
+                    T* voxel = voxels.data();
+                    for (int z = 0; z < size; ++z)
+                    {
+                        int const gz = std::min(origin[2] + z, zBound - 1);
+                        for (int y = 0; y < size; ++y)
+                        {
+                            int const gy = std::min(origin[1] + y, yBound - 1);
+                            T const* row = inputVoxels + static_cast<size_t>(xBound) *
+                                (gy + static_cast<size_t>(yBound) * gz);
+                            for (int x = 0; x < size; ++x)
+                            {
+                                *voxel++ = row[std::min(origin[0] + x, xBound - 1)];
+                            }
+                        }
+                    }
+
+                    extractor.Extract(level, depth, tileVertices[tile], tileTriangles[tile]);
+                });
+
+            // Translate the vertices to image coordinates. The vertices on
+            // shared planes are keyed by the integer parts of their tile
+            // coordinates translated to the image and by which coordinates
+            // are not integers, so the vertices of adjacent tiles that
+            // interpolate the same voxels have the same key, and they are
+            // assigned the coordinates of the first tile with the key.
+            std::map<std::array<int, 4>, Vertex> shared;
+            vertices.clear();
+            triangles.clear();
+            for (size_t tile = 0; tile < totalTiles; ++tile)
+            {
+                std::array<int, 3> const index = {
+                    static_cast<int>(tile % numTiles[0]),
+                    static_cast<int>((tile / numTiles[0]) % numTiles[1]),
+                    static_cast<int>(tile / (static_cast<size_t>(numTiles[0]) * numTiles[1])) };
+                int const base = static_cast<int>(vertices.size());
+                for (auto const& local : tileVertices[tile])
+                {
+                    bool onSharedPlane = false;
+                    std::array<int, 4> key;
+                    key[3] = 0;
+                    Vertex position;
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        Real const floorLocal = std::floor(local[i]);
+                        key[i] = static_cast<int>(floorLocal) + index[i] * twoPowerN;
+                        if (local[i] != floorLocal)
+                        {
+                            key[3] |= (1 << i);
+                        }
+                        position[i] = local[i] + static_cast<Real>(index[i] * twoPowerN);
+                        if ((local[i] == (Real)0 && index[i] > 0)
+                            || (local[i] == static_cast<Real>(twoPowerN) && index[i] + 1 < numTiles[i]))
+                        {
+                            onSharedPlane = true;
+                        }
+                    }
+
+                    if (onSharedPlane)
+                    {
+                        auto result = shared.insert(std::make_pair(key, position));
+                        position = result.first->second;
+                    }
+                    vertices.push_back(position);
+                }
+
+                for (auto triangle : tileTriangles[tile])
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        triangle.V[j] += base;
+                    }
+                    triangles.push_back(triangle);
+                }
+                std::vector<Vertex>().swap(tileVertices[tile]);
+                std::vector<Triangle>().swap(tileTriangles[tile]);
+            }
+        }
+
         void MakeUnique(std::vector<Vertex>& vertices,
             std::vector<Triangle>& triangles)
         {
@@ -1015,7 +1163,9 @@ namespace gte
             }
             else  // leaf nodes
             {
-                if (mFixBoundary)
+                if ((mFixMin[0] && x0 == 0) || x0 + 1 == mFixMax[0]
+                    || (mFixMin[1] && y0 == 0) || y0 + 1 == mFixMax[1]
+                    || (mFixMin[2] && z0 == 0) || z0 + 1 == mFixMax[2])
                 {
                     // Do not allow boundary voxels to merge with any other
                     // voxels.
@@ -1234,6 +1384,11 @@ namespace gte
             for (size_t i = 0; i < mBoxes.size(); ++i)
             {
                 OctBox const& box = mBoxes[i];
+                if (box.x0 >= mClip[0] || box.y0 >= mClip[1] || box.z0 >= mClip[2])
+                {
+                    // The box is outside the image of a tile.
+                    continue;
+                }
 
                 // Get vertices on edges of box.
                 VETable table;
@@ -2881,7 +3036,12 @@ namespace gte
         T const* mInputVoxels;
         Real mLevel;
 
-        bool mFixBoundary;
+        // The voxels with x = 0 when mFixMin[0] is true and the voxels
+        // with x + 1 = mFixMax[0] are not merged, and similarly for y and z.
+        // The boxes with x >= mClip[0] are not tessellated, and similarly
+        // for y and z.
+        std::array<bool, 3> mFixMin;
+        std::array<int, 3> mFixMax, mClip;
 
         // Trees for linear merging.
         Array2<std::shared_ptr<LinearMergeTree>> mXMerge, mYMerge, mZMerge;
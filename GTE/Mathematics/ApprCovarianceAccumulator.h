@@ -0,0 +1,181 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/Vector.h>
+#include <array>
+#include <cstddef>
+
+// Incremental computation of the mean and covariance matrix of a set of
+// points, which are the statistics of the fits ApprGaussian3,
+// ApprOrthogonalLine3, ApprOrthogonalPlane3 and ApprHeightPlane3. Each of
+// those classes has a Fit(accumulator) function. Points can be added and
+// removed one at a time, and the statistics of two accumulators can be
+// merged, which supports online fits and the parallel reduction of the
+// statistics of large data sets.
+//
+// The updates are those of Welford's algorithm, and Merge uses the
+// pairwise formula of Chan, Golub and LeVeque. The accumulator stores the
+// mean and the sums of the products of the differences from the mean,
+//   S[i][j] = sum_k (P[k][i] - mean[i]) * (P[k][j] - mean[j])
+// so the covariance matrix is S/n. Unlike sums of the products of the
+// point coordinates, these sums do not suffer from cancellation when the
+// points are far from the origin relative to their spread. Removing points
+// is the reverse of adding them and accumulates rounding errors, so for
+// long-running sliding windows, see ApprSlidingWindow.h, which rebuilds the
+// statistics periodically.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class ApprCovarianceAccumulator
+    {
+    public:
+        using PointType = Vector<N, Real>;
+
+        // The number of unique elements of the symmetric matrix S, stored in
+        // row-major order of its upper triangle. For N = 3, the order is
+        // S00, S01, S02, S11, S12 and S22.
+        static size_t constexpr numSums = N * (N + 1) / 2;
+
+        ApprCovarianceAccumulator()
+        {
+            Clear();
+        }
+
+        void Clear()
+        {
+            mNumPoints = 0;
+            mMean.MakeZero();
+            mSums.fill((Real)0);
+        }
+
+        void Add(PointType const& point)
+        {
+            ++mNumPoints;
+            PointType diff = point - mMean;
+            Real invNumPoints = (Real)1 / (Real)mNumPoints;
+            mMean += diff * invNumPoints;
+
+            // S += diff * (point - newMean)^T, where
+            // point - newMean = diff * (n - 1) / n.
+            Real weight = (Real)(mNumPoints - 1) * invNumPoints;
+            UpdateSums(diff, weight);
+        }
+
+        // The point must have been added to the accumulator. This is not
+        // verified, but removing all points leads to the zero statistics of
+        // an empty accumulator.
+        void Remove(PointType const& point)
+        {
+            LogAssert(mNumPoints > 0, "The accumulator has no points.");
+            if (mNumPoints == 1)
+            {
+                Clear();
+                return;
+            }
+
+            // Reverse the update of Add. With the current mean, the mean
+            // before adding the point was mean - diff / (n - 1) and the
+            // sums were S - diff * diff^T * n / (n - 1).
+            PointType diff = point - mMean;
+            Real numPoints = (Real)mNumPoints;
+            --mNumPoints;
+            Real invNumPoints = (Real)1 / (Real)mNumPoints;
+            mMean -= diff * invNumPoints;
+            UpdateSums(diff, -numPoints * invNumPoints);
+
+            // The diagonal sums are nonnegative in exact arithmetic.
+            for (int i = 0, k = 0; i < N; k += N - i, ++i)
+            {
+                if (mSums[k] < (Real)0)
+                {
+                    mSums[k] = (Real)0;
+                }
+            }
+        }
+
+        // Combine the statistics of the points of 'other' with those of
+        // 'this'.
+        void Merge(ApprCovarianceAccumulator const& other)
+        {
+            if (other.mNumPoints == 0)
+            {
+                return;
+            }
+            if (mNumPoints == 0)
+            {
+                *this = other;
+                return;
+            }
+
+            size_t numPoints = mNumPoints + other.mNumPoints;
+            Real invNumPoints = (Real)1 / (Real)numPoints;
+            PointType delta = other.mMean - mMean;
+            mMean += delta * ((Real)other.mNumPoints * invNumPoints);
+            for (size_t k = 0; k < numSums; ++k)
+            {
+                mSums[k] += other.mSums[k];
+            }
+            UpdateSums(delta, (Real)mNumPoints * (Real)other.mNumPoints * invNumPoints);
+            mNumPoints = numPoints;
+        }
+
+        // Member access.
+        inline size_t GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline PointType const& GetMean() const
+        {
+            return mMean;
+        }
+
+        inline std::array<Real, numSums> const& GetSums() const
+        {
+            return mSums;
+        }
+
+        // The covariance matrix S/n in the order of the sums. It is zero
+        // when the accumulator has no points.
+        std::array<Real, numSums> GetCovariance() const
+        {
+            std::array<Real, numSums> covariance;
+            covariance.fill((Real)0);
+            if (mNumPoints > 0)
+            {
+                Real invNumPoints = (Real)1 / (Real)mNumPoints;
+                for (size_t k = 0; k < numSums; ++k)
+                {
+                    covariance[k] = mSums[k] * invNumPoints;
+                }
+            }
+            return covariance;
+        }
+
+    private:
+        // S += weight * diff * diff^T
+        void UpdateSums(PointType const& diff, Real weight)
+        {
+            for (int i = 0, k = 0; i < N; ++i)
+            {
+                Real weightedDiff = weight * diff[i];
+                for (int j = i; j < N; ++j, ++k)
+                {
+                    mSums[k] += weightedDiff * diff[j];
+                }
+            }
+        }
+
+        size_t mNumPoints;
+        PointType mMean;
+        std::array<Real, numSums> mSums;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.05.27
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -11,9 +11,9 @@
 #include <Mathematics/Matrix3x3.h>
 #include <Mathematics/SymmetricEigensolver3x3.h>
 #include <Mathematics/ApprCircle2.h>
+#include <Mathematics/TaskScheduler.h>
 #include <cstdint>
 #include <vector>
-#include <thread>
 
 // The algorithm for least-squares fitting of a point set by a cylinder is
 // described in
@@ -42,7 +42,9 @@ namespace gte
         // quite large and the number of points to be fitted is large, you
         // most likely will want to run multithreaded. Set numThreads to 0
         // to run single-threaded in the main process. Set numThreads > 0 to
-        // run multithreaded.
+        // run multithreaded. The hemisphere is partitioned into numThreads
+        // subsets that are searched by std::thread objects created for each
+        // call unless a scheduler is specified by SetScheduler(*).
         //
         // Set fitPoints to 'true' to use the algorithm described in the
         // aforementioned PDF file. Set fitPoints to 'false' if you want to
@@ -56,6 +58,7 @@ namespace gte
                 ConstructorType::FIT_BY_HEMISPHERE_SEARCH :
                 ConstructorType::FIT_TO_MESH),
             mNumThreads(numThreads),
+            mScheduler(nullptr),
             mNumThetaSamples(numThetaSamples),
             mNumPhiSamples(numPhiSamples),
             mEigenIndex(0),
@@ -80,6 +83,7 @@ namespace gte
             :
             mConstructorType(ConstructorType::FIT_USING_COVARIANCE_EIGENVECTOR),
             mNumThreads(0),
+            mScheduler(nullptr),
             mNumThetaSamples(0),
             mNumPhiSamples(0),
             mEigenIndex(eigenIndex),
@@ -98,6 +102,7 @@ namespace gte
             :
             mConstructorType(ConstructorType::FIT_USING_SPECIFIED_AXIS),
             mNumThreads(0),
+            mScheduler(nullptr),
             mNumThetaSamples(0),
             mNumPhiSamples(0),
             mEigenIndex(0),
@@ -111,6 +116,20 @@ namespace gte
             Normalize(mCylinderAxis, true);
         }
 
+        // Search the subsets of the hemisphere as tasks of the scheduler,
+        // which can be shared with other computations, instead of creating
+        // threads for each call. The results do not depend on the scheduler.
+        // Set the scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // The algorithm must estimate 6 parameters, so the number of points
         // must be at least 6 but preferably larger. The returned value is
         // the root-mean-square of the least-squares error.
@@ -452,12 +471,8 @@ namespace gte
             }
             local[mNumThreads - 1].jmax = mNumPhiSamples + 1;
 
-            std::vector<std::thread> process(mNumThreads);
-            for (size_t t = 0; t < mNumThreads; ++t)
-            {
-                process[t] = std::thread
-                (
-                    [this, t, iMultiplier, jMultiplier, &local]()
+            TaskScheduler::ParallelFor(mScheduler, mNumThreads,
+                [this, iMultiplier, jMultiplier, &local](size_t t)
                 {
                     for (size_t j = local[t].jmin; j < local[t].jmax; ++j)
                     {
@@ -484,14 +499,10 @@ namespace gte
                             }
                         }
                     }
-                }
-                );
-            }
+                });
 
             for (size_t t = 0; t < mNumThreads; ++t)
             {
-                process[t].join();
-
                 if (local[t].error < minError)
                 {
                     minError = local[t].error;
@@ -618,50 +629,42 @@ namespace gte
             }
             local[mNumThreads - 1].jmax = mNumPhiSamples + 1;
 
-            std::vector<std::thread> process(mNumThreads);
-            for (size_t t = 0; t < mNumThreads; ++t)
-            {
-                process[t] = std::thread
-                (
-                    [this, t, iMultiplier, jMultiplier, &local,
-                        numPoints, points, numTriangles, indices]()
+            TaskScheduler::ParallelFor(mScheduler, mNumThreads,
+                [this, iMultiplier, jMultiplier, &local,
+                    numPoints, points, numTriangles, indices](size_t t)
+                {
+                    for (size_t j = local[t].jmin; j < local[t].jmax; ++j)
                     {
-                        for (size_t j = local[t].jmin; j < local[t].jmax; ++j)
+                        // phi in [0,pi/2]
+                        T phi = jMultiplier * static_cast<T>(j);
+                        T csphi = std::cos(phi);
+                        T snphi = std::sin(phi);
+                        for (size_t i = 0; i < mNumThetaSamples; ++i)
                         {
-                            // phi in [0,pi/2]
-                            T phi = jMultiplier * static_cast<T>(j);
-                            T csphi = std::cos(phi);
-                            T snphi = std::sin(phi);
-                            for (size_t i = 0; i < mNumThetaSamples; ++i)
+                            // theta in [0,2*pi)
+                            T theta = iMultiplier * static_cast<T>(i);
+                            T cstheta = std::cos(theta);
+                            T sntheta = std::sin(theta);
+                            Vector3<T> direction
                             {
-                                // theta in [0,2*pi)
-                                T theta = iMultiplier * static_cast<T>(i);
-                                T cstheta = std::cos(theta);
-                                T sntheta = std::sin(theta);
-                                Vector3<T> direction
-                                {
-                                    cstheta * snphi,
-                                    sntheta * snphi,
-                                    csphi
-                                };
-
-                                T measure = GetProjectionMeasure(direction,
-                                    numPoints, points, numTriangles, indices);
-                                if (measure < local[t].measure)
-                                {
-                                    local[t].direction = direction;
-                                    local[t].measure = measure;
-                                }
+                                cstheta * snphi,
+                                sntheta * snphi,
+                                csphi
+                            };
+
+                            T measure = GetProjectionMeasure(direction,
+                                numPoints, points, numTriangles, indices);
+                            if (measure < local[t].measure)
+                            {
+                                local[t].direction = direction;
+                                local[t].measure = measure;
                             }
                         }
                     }
-                );
-            }
+                });
 
             for (size_t t = 0; t < mNumThreads; ++t)
             {
-                process[t].join();
-
                 if (local[t].measure < minMeasure)
                 {
                     minMeasure = local[t].measure;
@@ -739,6 +742,7 @@ namespace gte
 
         // Parameters for the hemisphere-search constructor.
         size_t mNumThreads;
+        TaskScheduler* mScheduler;
         size_t mNumThetaSamples;
         size_t mNumPhiSamples;
 
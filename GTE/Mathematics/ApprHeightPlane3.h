@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.07.20
+// Version: 4.0.2026.10.14
 
 #pragma once
 
+#include <Mathematics/ApprCovarianceAccumulator.h>
 #include <Mathematics/ApprQuery.h>
 #include <Mathematics/Vector3.h>
 
@@ -50,29 +51,24 @@ namespace gte
 
                 if (std::isfinite(mean[0]) && std::isfinite(mean[1]))
                 {
-                    // Compute the covariance matrix of the points.
-                    Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-                    Real covar11 = (Real)0, covar12 = (Real)0;
+                    // Compute the covariance matrix of the points. The
+                    // elements of the array are the covariances 00, 01, 02,
+                    // 11 and 12. The covariance 22 is not needed.
+                    std::array<Real, 6> covar;
+                    covar.fill((Real)0);
                     currentIndex = indices;
                     for (size_t i = 0; i < numIndices; ++i)
                     {
                         Vector3<Real> diff = points[*currentIndex++] - mean;
-                        covar00 += diff[0] * diff[0];
-                        covar01 += diff[0] * diff[1];
-                        covar02 += diff[0] * diff[2];
-                        covar11 += diff[1] * diff[1];
-                        covar12 += diff[1] * diff[2];
+                        covar[0] += diff[0] * diff[0];
+                        covar[1] += diff[0] * diff[1];
+                        covar[2] += diff[0] * diff[2];
+                        covar[3] += diff[1] * diff[1];
+                        covar[4] += diff[1] * diff[2];
                     }
 
-                    // Decompose the covariance matrix.
-                    Real det = covar00 * covar11 - covar01 * covar01;
-                    if (det != (Real)0)
+                    if (SetParameters(mean, covar))
                     {
-                        Real invDet = (Real)1 / det;
-                        mParameters.first = mean;
-                        mParameters.second[0] = (covar11 * covar02 - covar01 * covar12) * invDet;
-                        mParameters.second[1] = (covar00 * covar12 - covar01 * covar02) * invDet;
-                        mParameters.second[2] = (Real)-1;
                         return true;
                     }
                 }
@@ -83,6 +79,25 @@ namespace gte
             return false;
         }
 
+        using ApprQuery<Real, Vector3<Real>>::Fit;
+
+        // Fit the points whose mean and covariance sums are stored by an
+        // accumulator, for example the statistics of a sliding window.
+        bool Fit(ApprCovarianceAccumulator<3, Real> const& accumulator)
+        {
+            Vector3<Real> const& mean = accumulator.GetMean();
+            if (accumulator.GetNumPoints() >= GetMinimumRequired() &&
+                std::isfinite(mean[0]) && std::isfinite(mean[1]) &&
+                SetParameters(mean, accumulator.GetSums()))
+            {
+                return true;
+            }
+
+            mParameters.first = Vector3<Real>::Zero();
+            mParameters.second = Vector3<Real>::Zero();
+            return false;
+        }
+
         // Get the parameters for the best fit.
         std::pair<Vector3<Real>, Vector3<Real>> const& GetParameters() const
         {
@@ -101,6 +116,22 @@ namespace gte
             return error;
         }
 
+        // The errors for an array of points. The loop has no branches, so
+        // the compiler can vectorize it. ApprRANSAC uses this function for
+        // the evaluation of hypotheses.
+        void Errors(Vector3<Real> const* points, size_t numPoints, Real* errors) const
+        {
+            Vector3<Real> const& origin = mParameters.first;
+            Vector3<Real> const& coefficients = mParameters.second;
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                Real d = (points[i][0] - origin[0]) * coefficients[0] +
+                    (points[i][1] - origin[1]) * coefficients[1] +
+                    (points[i][2] - origin[2]) * coefficients[2];
+                errors[i] = d * d;
+            }
+        }
+
         virtual void CopyParameters(ApprQuery<Real, Vector3<Real>> const* input) override
         {
             auto source = dynamic_cast<ApprHeightPlane3<Real> const*>(input);
@@ -111,6 +142,24 @@ namespace gte
         }
 
     private:
+        bool SetParameters(Vector3<Real> const& mean, std::array<Real, 6> const& covar)
+        {
+            // Decompose the covariance matrix.
+            Real covar00 = covar[0], covar01 = covar[1], covar02 = covar[2];
+            Real covar11 = covar[3], covar12 = covar[4];
+            Real det = covar00 * covar11 - covar01 * covar01;
+            if (det != (Real)0)
+            {
+                Real invDet = (Real)1 / det;
+                mParameters.first = mean;
+                mParameters.second[0] = (covar11 * covar02 - covar01 * covar12) * invDet;
+                mParameters.second[1] = (covar00 * covar12 - covar01 * covar02) * invDet;
+                mParameters.second[2] = (Real)-1;
+                return true;
+            }
+            return false;
+        }
+
         std::pair<Vector3<Real>, Vector3<Real>> mParameters;
     };
 }
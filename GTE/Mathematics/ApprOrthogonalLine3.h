@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
+#include <Mathematics/ApprCovarianceAccumulator.h>
 #include <Mathematics/ApprQuery.h>
 #include <Mathematics/Line.h>
 #include <Mathematics/SymmetricEigensolver3x3.h>
@@ -52,41 +53,22 @@ namespace gte
                 if (std::isfinite(mean[0]) && std::isfinite(mean[1]))
                 {
                     // Compute the covariance matrix of the points.
-                    Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-                    Real covar11 = (Real)0, covar12 = (Real)0, covar22 = (Real)0;
+                    // The elements of the array are the covariances 00, 01,
+                    // 02, 11, 12 and 22.
+                    std::array<Real, 6> covar;
+                    covar.fill((Real)0);
                     currentIndex = indices;
                     for (size_t i = 0; i < numIndices; ++i)
                     {
                         Vector3<Real> diff = points[*currentIndex++] - mean;
-                        covar00 += diff[0] * diff[0];
-                        covar01 += diff[0] * diff[1];
-                        covar02 += diff[0] * diff[2];
-                        covar11 += diff[1] * diff[1];
-                        covar12 += diff[1] * diff[2];
-                        covar22 += diff[2] * diff[2];
+                        covar[0] += diff[0] * diff[0];
+                        covar[1] += diff[0] * diff[1];
+                        covar[2] += diff[0] * diff[2];
+                        covar[3] += diff[1] * diff[1];
+                        covar[4] += diff[1] * diff[2];
+                        covar[5] += diff[2] * diff[2];
                     }
-                    covar00 *= invSize;
-                    covar01 *= invSize;
-                    covar02 *= invSize;
-                    covar11 *= invSize;
-                    covar12 *= invSize;
-                    covar22 *= invSize;
-
-                    // Solve the eigensystem.
-                    SymmetricEigensolver3x3<Real> es;
-                    std::array<Real, 3> eval;
-                    std::array<std::array<Real, 3>, 3> evec;
-                    es(covar00, covar01, covar02, covar11, covar12, covar22,
-                        false, +1, eval, evec);
-
-                    // The line direction is the eigenvector in the direction
-                    // of largest variance of the points.
-                    mParameters.origin = mean;
-                    mParameters.direction = evec[2];
-
-                    // The fitted line is unique when the maximum eigenvalue
-                    // has multiplicity 1.
-                    return eval[1] < eval[2];
+                    return SetParameters(mean, covar, invSize);
                 }
             }
 
@@ -94,6 +76,24 @@ namespace gte
             return false;
         }
 
+        using ApprQuery<Real, Vector3<Real>>::Fit;
+
+        // Fit the points whose mean and covariance sums are stored by an
+        // accumulator, for example the statistics of a sliding window.
+        bool Fit(ApprCovarianceAccumulator<3, Real> const& accumulator)
+        {
+            size_t const numPoints = accumulator.GetNumPoints();
+            Vector3<Real> const& mean = accumulator.GetMean();
+            if (numPoints >= GetMinimumRequired() &&
+                std::isfinite(mean[0]) && std::isfinite(mean[1]))
+            {
+                return SetParameters(mean, accumulator.GetSums(), (Real)1 / (Real)numPoints);
+            }
+
+            mParameters = Line3<Real>(Vector3<Real>::Zero(), Vector3<Real>::Zero());
+            return false;
+        }
+
         // Get the parameters for the best fit.
         Line3<Real> const& GetParameters() const
         {
@@ -114,6 +114,24 @@ namespace gte
             return error;
         }
 
+        // The errors for an array of points. The loop has no branches, so
+        // the compiler can vectorize it. ApprRANSAC uses this function for
+        // the evaluation of hypotheses.
+        void Errors(Vector3<Real> const* points, size_t numPoints, Real* errors) const
+        {
+            Vector3<Real> const& origin = mParameters.origin;
+            Vector3<Real> const& direction = mParameters.direction;
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                Real diff0 = points[i][0] - origin[0];
+                Real diff1 = points[i][1] - origin[1];
+                Real diff2 = points[i][2] - origin[2];
+                Real sqrlen = diff0 * diff0 + diff1 * diff1 + diff2 * diff2;
+                Real dot = diff0 * direction[0] + diff1 * direction[1] + diff2 * direction[2];
+                errors[i] = std::fabs(sqrlen - dot * dot);
+            }
+        }
+
         virtual void CopyParameters(ApprQuery<Real, Vector3<Real>> const* input) override
         {
             auto source = dynamic_cast<ApprOrthogonalLine3<Real> const*>(input);
@@ -124,6 +142,26 @@ namespace gte
         }
 
     private:
+        bool SetParameters(Vector3<Real> const& mean, std::array<Real, 6> const& covar, Real invSize)
+        {
+            // Solve the eigensystem.
+            SymmetricEigensolver3x3<Real> es;
+            std::array<Real, 3> eval;
+            std::array<std::array<Real, 3>, 3> evec;
+            es(covar[0] * invSize, covar[1] * invSize, covar[2] * invSize,
+                covar[3] * invSize, covar[4] * invSize, covar[5] * invSize,
+                false, +1, eval, evec);
+
+            // The line direction is the eigenvector in the direction of
+            // largest variance of the points.
+            mParameters.origin = mean;
+            mParameters.direction = evec[2];
+
+            // The fitted line is unique when the maximum eigenvalue has
+            // multiplicity 1.
+            return eval[1] < eval[2];
+        }
+
         Line3<Real> mParameters;
     };
 }
@@ -3,11 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <Mathematics/ApprCovarianceAccumulator.h>
 #include <Mathematics/ApprQuery.h>
+#include <Mathematics/ParallelReduction.h>
 #include <Mathematics/SymmetricEigensolver3x3.h>
 #include <Mathematics/Vector3.h>
 
@@ -15,7 +17,7 @@
 // orthogonal to the proposed plane. The return value is 'true' if and only if
 // the fit is unique (always successful, 'true' when a minimum eigenvalue is
 // unique). The mParameters value is (P,N) = (origin,normal).  The error for
-// S = (x0,y0,z0) is (S-P)^T*(I - N*N^T)*(S-P).
+// S = (x0,y0,z0) is (N^T*(S-P))^2, the squared distance from S to the plane.
 
 namespace gte
 {
@@ -23,13 +25,36 @@ namespace gte
     class ApprOrthogonalPlane3 : public ApprQuery<Real, Vector3<Real>>
     {
     public:
-        // Initialize the model parameters to zero.
-        ApprOrthogonalPlane3()
+        // Initialize the model parameters to zero. The sums of the mean and
+        // the covariance matrix are computed in numThreads threads using
+        // ParallelReduction, which is useful for arbitrary-precision Real
+        // and large numbers of points. Set numThreads to 0 or 1 to compute
+        // the sums in the calling thread. The threads are std::thread
+        // objects created for each call unless a scheduler is specified by
+        // SetScheduler(*).
+        ApprOrthogonalPlane3(size_t numThreads = 0)
+            :
+            mNumThreads(numThreads),
+            mScheduler(nullptr)
         {
             mParameters.first = Vector3<Real>::Zero();
             mParameters.second = Vector3<Real>::Zero();
         }
 
+        // Compute the sums as tasks of the scheduler, which can be shared
+        // with other computations, instead of creating threads for each
+        // call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // Basic fitting algorithm. See ApprQuery.h for the various Fit(...)
         // functions that you can call.
         virtual bool FitIndexed(
@@ -39,58 +64,74 @@ namespace gte
             if (this->ValidIndices(numPoints, points, numIndices, indices))
             {
                 // Compute the mean of the points.
-                Vector3<Real> mean = Vector3<Real>::Zero();
-                int const* currentIndex = indices;
-                for (size_t i = 0; i < numIndices; ++i)
-                {
-                    mean += points[*currentIndex++];
-                }
+                Vector3<Real> mean = ParallelReduction<Vector3<Real>>::Execute(
+                    numIndices, mNumThreads, Vector3<Real>::Zero(),
+                    [points, indices](size_t imin, size_t imax, Vector3<Real>& sum)
+                    {
+                        for (size_t i = imin; i < imax; ++i)
+                        {
+                            sum += points[indices[i]];
+                        }
+                    },
+                    [](Vector3<Real>& sum0, Vector3<Real> const& sum1)
+                    {
+                        sum0 += sum1;
+                    }, mScheduler);
                 Real invSize = (Real)1 / (Real)numIndices;
                 mean *= invSize;
 
                 if (std::isfinite(mean[0]) && std::isfinite(mean[1]))
                 {
                     // Compute the covariance matrix of the points.
-                    Real covar00 = (Real)0, covar01 = (Real)0, covar02 = (Real)0;
-                    Real covar11 = (Real)0, covar12 = (Real)0, covar22 = (Real)0;
-                    currentIndex = indices;
-                    for (size_t i = 0; i < numIndices; ++i)
-                    {
-                        Vector3<Real> diff = points[*currentIndex++] - mean;
-                        covar00 += diff[0] * diff[0];
-                        covar01 += diff[0] * diff[1];
-                        covar02 += diff[0] * diff[2];
-                        covar11 += diff[1] * diff[1];
-                        covar12 += diff[1] * diff[2];
-                        covar22 += diff[2] * diff[2];
-                    }
-                    covar00 *= invSize;
-                    covar01 *= invSize;
-                    covar02 *= invSize;
-                    covar11 *= invSize;
-                    covar12 *= invSize;
-                    covar22 *= invSize;
-
-                    // Solve the eigensystem.
-                    SymmetricEigensolver3x3<Real> es;
-                    std::array<Real, 3> eval;
-                    std::array<std::array<Real, 3>, 3> evec;
-                    es(covar00, covar01, covar02, covar11, covar12, covar22,
-                        false, +1, eval, evec);
-
-                    // The plane normal is the eigenvector in the direction of
-                    // smallest variance of the points.
-                    mParameters.first = mean;
-                    mParameters.second = evec[0];
-
-                    // The fitted plane is unique when the minimum eigenvalue
-                    // has multiplicity 1.
-                    return eval[0] < eval[1];
+                    // The elements of the array are the covariances 00, 01,
+                    // 02, 11, 12 and 22.
+                    std::array<Real, 6> zero;
+                    zero.fill((Real)0);
+                    std::array<Real, 6> covar = ParallelReduction<std::array<Real, 6>>::Execute(
+                        numIndices, mNumThreads, zero,
+                        [points, indices, &mean](size_t imin, size_t imax, std::array<Real, 6>& sum)
+                        {
+                            for (size_t i = imin; i < imax; ++i)
+                            {
+                                Vector3<Real> diff = points[indices[i]] - mean;
+                                sum[0] += diff[0] * diff[0];
+                                sum[1] += diff[0] * diff[1];
+                                sum[2] += diff[0] * diff[2];
+                                sum[3] += diff[1] * diff[1];
+                                sum[4] += diff[1] * diff[2];
+                                sum[5] += diff[2] * diff[2];
+                            }
+                        },
+                        [](std::array<Real, 6>& sum0, std::array<Real, 6> const& sum1)
+                        {
+                            for (size_t j = 0; j < 6; ++j)
+                            {
+                                sum0[j] += sum1[j];
+                            }
+                        }, mScheduler);
+                    return SetParameters(mean, covar, invSize);
                 }
             }
 
-            mParameters.first = Vector3<Real>::Zero();
-            mParameters.second = Vector3<Real>::Zero();
+            SetZeroParameters();
+            return false;
+        }
+
+        using ApprQuery<Real, Vector3<Real>>::Fit;
+
+        // Fit the points whose mean and covariance sums are stored by an
+        // accumulator, for example the statistics of a sliding window.
+        bool Fit(ApprCovarianceAccumulator<3, Real> const& accumulator)
+        {
+            size_t const numPoints = accumulator.GetNumPoints();
+            Vector3<Real> const& mean = accumulator.GetMean();
+            if (numPoints >= GetMinimumRequired() &&
+                std::isfinite(mean[0]) && std::isfinite(mean[1]))
+            {
+                return SetParameters(mean, accumulator.GetSums(), (Real)1 / (Real)numPoints);
+            }
+
+            SetZeroParameters();
             return false;
         }
 
@@ -107,13 +148,27 @@ namespace gte
 
         virtual Real Error(Vector3<Real> const& point) const override
         {
-            Vector3<Real> diff = point - mParameters.first;
-            Real sqrlen = Dot(diff, diff);
-            Real dot = Dot(diff, mParameters.second);
-            Real error = std::fabs(sqrlen - dot * dot);
+            Real dot = Dot(point - mParameters.first, mParameters.second);
+            Real error = dot * dot;
             return error;
         }
 
+        // The errors for an array of points. The loop has no branches, so
+        // the compiler can vectorize it. ApprRANSAC uses this function for
+        // the evaluation of hypotheses.
+        void Errors(Vector3<Real> const* points, size_t numPoints, Real* errors) const
+        {
+            Vector3<Real> const& origin = mParameters.first;
+            Vector3<Real> const& normal = mParameters.second;
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                Real dot = (points[i][0] - origin[0]) * normal[0] +
+                    (points[i][1] - origin[1]) * normal[1] +
+                    (points[i][2] - origin[2]) * normal[2];
+                errors[i] = dot * dot;
+            }
+        }
+
         virtual void CopyParameters(ApprQuery<Real, Vector3<Real>> const* input) override
         {
             auto source = dynamic_cast<ApprOrthogonalPlane3<Real> const*>(input);
@@ -124,6 +179,42 @@ namespace gte
         }
 
     private:
+        bool SetParameters(Vector3<Real> const& mean, std::array<Real, 6> const& covar, Real invSize)
+        {
+            Real covar00 = covar[0], covar01 = covar[1], covar02 = covar[2];
+            Real covar11 = covar[3], covar12 = covar[4], covar22 = covar[5];
+            covar00 *= invSize;
+            covar01 *= invSize;
+            covar02 *= invSize;
+            covar11 *= invSize;
+            covar12 *= invSize;
+            covar22 *= invSize;
+
+            // Solve the eigensystem.
+            SymmetricEigensolver3x3<Real> es;
+            std::array<Real, 3> eval;
+            std::array<std::array<Real, 3>, 3> evec;
+            es(covar00, covar01, covar02, covar11, covar12, covar22,
+                false, +1, eval, evec);
+
+            // The plane normal is the eigenvector in the direction of
+            // smallest variance of the points.
+            mParameters.first = mean;
+            mParameters.second = evec[0];
+
+            // The fitted plane is unique when the minimum eigenvalue has
+            // multiplicity 1.
+            return eval[0] < eval[1];
+        }
+
+        void SetZeroParameters()
+        {
+            mParameters.first = Vector3<Real>::Zero();
+            mParameters.second = Vector3<Real>::Zero();
+        }
+
         std::pair<Vector3<Real>, Vector3<Real>> mParameters;
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
     };
 }
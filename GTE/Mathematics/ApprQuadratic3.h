@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
-#include <Mathematics/Matrix.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/Matrix3x3.h>
 #include <Mathematics/Vector3.h>
 #include <Mathematics/Hypersphere.h>
 #include <Mathematics/SymmetricEigensolver.h>
@@ -42,6 +43,9 @@ namespace gte
     //   d0 v0^2 + d1 v1^2 + d2 v^2 + e0 v0 + e1 v1 + e2 v2 + f = 0
     // The characterization depends on the signs of the d_i.
 
+    template <typename Real>
+    class ApprQuadraticAccumulator3;
+
     template <typename Real>
     class ApprQuadratic3
     {
@@ -51,79 +55,143 @@ namespace gte
             Matrix<10, 10, Real> A;  // constructor sets A to zero
             for (int i = 0; i < numPoints; ++i)
             {
-                Real x = points[i][0];
-                Real y = points[i][1];
-                Real z = points[i][2];
-                Real x2 = x * x;
-                Real y2 = y * y;
-                Real z2 = z * z;
-                Real xy = x * y;
-                Real xz = x * z;
-                Real yz = y * z;
-                Real x3 = x * x2;
-                Real xy2 = x * y2;
-                Real xz2 = x * z2;
-                Real x2y = x * xy;
-                Real x2z = x * xz;
-                Real xyz = x * y * z;
-                Real y3 = y * y2;
-                Real yz2 = y * z2;
-                Real y2z = y * yz;
-                Real z3 = z * z2;
-                Real x4 = x * x3;
-                Real x2y2 = x * xy2;
-                Real x2z2 = x * xz2;
-                Real x3y = x * x2y;
-                Real x3z = x * x2z;
-                Real x2yz = x * xyz;
-                Real y4 = y * y3;
-                Real y2z2 = y * yz2;
-                Real xy3 = x * y3;
-                Real xy2z = x * y2z;
-                Real y3z = y * y2z;
-                Real z4 = z * z3;
-                Real xyz2 = x * yz2;
-                Real xz3 = x * z3;
-                Real yz3 = y * z3;
+                AccumulateMoments(points[i], (Real)1, A);
+            }
+            return Solve(A, static_cast<Real>(numPoints), coefficients);
+        }
 
-                A(0, 1) += x;
-                A(0, 2) += y;
-                A(0, 3) += z;
-                A(0, 4) += x2;
-                A(0, 5) += y2;
-                A(0, 6) += z2;
-                A(0, 7) += xy;
-                A(0, 8) += xz;
-                A(0, 9) += yz;
-                A(1, 4) += x3;
-                A(1, 5) += xy2;
-                A(1, 6) += xz2;
-                A(1, 7) += x2y;
-                A(1, 8) += x2z;
-                A(1, 9) += xyz;
-                A(2, 5) += y3;
-                A(2, 6) += yz2;
-                A(2, 9) += y2z;
-                A(3, 6) += z3;
-                A(4, 4) += x4;
-                A(4, 5) += x2y2;
-                A(4, 6) += x2z2;
-                A(4, 7) += x3y;
-                A(4, 8) += x3z;
-                A(4, 9) += x2yz;
-                A(5, 5) += y4;
-                A(5, 6) += y2z2;
-                A(5, 7) += xy3;
-                A(5, 8) += xy2z;
-                A(5, 9) += y3z;
-                A(6, 6) += z4;
-                A(6, 7) += xyz2;
-                A(6, 8) += xz3;
-                A(6, 9) += yz3;
-                A(9, 9) += y2z2;
+        // Fit the points whose moments are stored by an accumulator, for
+        // example the moments of a sliding window. The moments are those
+        // of the points relative to the origin of the accumulator. The
+        // coefficients of the fit relative to that origin are transformed
+        // to the coordinates of the points and normalized to unit length.
+        // The return value is the minimum eigenvalue for the fit relative
+        // to the origin. The accumulator must have at least one point.
+        Real operator()(ApprQuadraticAccumulator3<Real> const& accumulator, Real coefficients[10])
+        {
+            LogAssert(accumulator.GetNumPoints() > 0, "The accumulator has no points.");
+            Real eigenvalue = Solve(accumulator.GetMoments(),
+                static_cast<Real>(accumulator.GetNumPoints()), coefficients);
+
+            // The quadratic relative to the origin O is
+            // Y^T*A*Y + B^T*Y + K with Y = X - O. In terms of X, the
+            // quadratic is X^T*A*X + (B - 2*A*O)^T*X + (O^T*A*O - B^T*O + K).
+            Vector3<Real> const& origin = accumulator.GetOrigin();
+            Real const half = (Real)0.5;
+            Matrix3x3<Real> quadratic
+            {
+                coefficients[4], half * coefficients[7], half * coefficients[8],
+                half * coefficients[7], coefficients[5], half * coefficients[9],
+                half * coefficients[8], half * coefficients[9], coefficients[6]
+            };
+            Vector3<Real> linear{ coefficients[1], coefficients[2], coefficients[3] };
+            Vector3<Real> quadraticOrigin = quadratic * origin;
+            coefficients[0] += Dot(origin, quadraticOrigin) - Dot(linear, origin);
+            for (int i = 0; i < 3; ++i)
+            {
+                coefficients[i + 1] -= (Real)2 * quadraticOrigin[i];
             }
 
-            A(0, 0) = static_cast<Real>(numPoints);
+            Real sqrLength = (Real)0;
+            for (int i = 0; i < 10; ++i)
+            {
+                sqrLength += coefficients[i] * coefficients[i];
+            }
+            if (sqrLength > (Real)0)
+            {
+                Real invLength = (Real)1 / std::sqrt(sqrLength);
+                for (int i = 0; i < 10; ++i)
+                {
+                    coefficients[i] *= invLength;
+                }
+            }
+            return eigenvalue;
+        }
+
+        // Add weight*V*V^T to the upper-triangular elements of A that are
+        // not duplicates of other elements, where V is the vector of the
+        // monomials for the point. The weight -1 removes a point.
+        static void AccumulateMoments(Vector3<Real> const& point, Real weight,
+            Matrix<10, 10, Real>& A)
+        {
+            Real x = point[0];
+            Real y = point[1];
+            Real z = point[2];
+            Real x2 = x * x;
+            Real y2 = y * y;
+            Real z2 = z * z;
+            Real xy = x * y;
+            Real xz = x * z;
+            Real yz = y * z;
+            Real x3 = x * x2;
+            Real xy2 = x * y2;
+            Real xz2 = x * z2;
+            Real x2y = x * xy;
+            Real x2z = x * xz;
+            Real xyz = x * y * z;
+            Real y3 = y * y2;
+            Real yz2 = y * z2;
+            Real y2z = y * yz;
+            Real z3 = z * z2;
+            Real x4 = x * x3;
+            Real x2y2 = x * xy2;
+            Real x2z2 = x * xz2;
+            Real x3y = x * x2y;
+            Real x3z = x * x2z;
+            Real x2yz = x * xyz;
+            Real y4 = y * y3;
+            Real y2z2 = y * yz2;
+            Real xy3 = x * y3;
+            Real xy2z = x * y2z;
+            Real y3z = y * y2z;
+            Real z4 = z * z3;
+            Real xyz2 = x * yz2;
+            Real xz3 = x * z3;
+            Real yz3 = y * z3;
+
+            A(0, 1) += weight * x;
+            A(0, 2) += weight * y;
+            A(0, 3) += weight * z;
+            A(0, 4) += weight * x2;
+            A(0, 5) += weight * y2;
+            A(0, 6) += weight * z2;
+            A(0, 7) += weight * xy;
+            A(0, 8) += weight * xz;
+            A(0, 9) += weight * yz;
+            A(1, 4) += weight * x3;
+            A(1, 5) += weight * xy2;
+            A(1, 6) += weight * xz2;
+            A(1, 7) += weight * x2y;
+            A(1, 8) += weight * x2z;
+            A(1, 9) += weight * xyz;
+            A(2, 5) += weight * y3;
+            A(2, 6) += weight * yz2;
+            A(2, 9) += weight * y2z;
+            A(3, 6) += weight * z3;
+            A(4, 4) += weight * x4;
+            A(4, 5) += weight * x2y2;
+            A(4, 6) += weight * x2z2;
+            A(4, 7) += weight * x3y;
+            A(4, 8) += weight * x3z;
+            A(4, 9) += weight * x2yz;
+            A(5, 5) += weight * y4;
+            A(5, 6) += weight * y2z2;
+            A(5, 7) += weight * xy3;
+            A(5, 8) += weight * xy2z;
+            A(5, 9) += weight * y3z;
+            A(6, 6) += weight * z4;
+            A(6, 7) += weight * xyz2;
+            A(6, 8) += weight * xz3;
+            A(6, 9) += weight * yz3;
+            A(9, 9) += weight * y2z2;
+        }
+
+    private:
+        // Complete the symmetric matrix of moments, normalize it by the
+        // number of points and compute its minimum eigenvector.
+        static Real Solve(Matrix<10, 10, Real> A, Real numPoints, Real coefficients[10])
+        {
+            A(0, 0) = numPoints;
             A(1, 1) = A(0, 4);
             A(1, 2) = A(0, 7);
             A(1, 3) = A(0, 8);
@@ -153,7 +221,7 @@ namespace gte
                 }
             }
 
-            Real invNumPoints = (Real)1 / static_cast<Real>(numPoints);
+            Real invNumPoints = (Real)1 / numPoints;
             for (int row = 0; row < 10; ++row)
             {
                 for (int col = 0; col < 10; ++col)
@@ -174,6 +242,90 @@ namespace gte
         }
     };
 
+    // Incremental computation of the moments for ApprQuadratic3. Points
+    // can be added and removed one at a time, and the moments of
+    // accumulators with the same origin can be merged, which supports online
+    // fits and the parallel reduction of the moments of large data sets.
+    // The moments are those of the points relative to an origin specified
+    // at construction, which should be near the points; for example, the
+    // first sample of a stream. The moments have degree up to 4, so when
+    // the points are far from the origin relative to their spread, sums of
+    // large terms cancel and the fit loses precision. Removing points is
+    // the reverse of adding them; see ApprSlidingWindow.h for rebuilding
+    // the moments of a sliding window periodically.
+    template <typename Real>
+    class ApprQuadraticAccumulator3
+    {
+    public:
+        using PointType = Vector3<Real>;
+
+        ApprQuadraticAccumulator3(Vector3<Real> const& origin = Vector3<Real>::Zero())
+            :
+            mOrigin(origin)
+        {
+            Clear();
+        }
+
+        // The origin is unchanged.
+        void Clear()
+        {
+            mNumPoints = 0;
+            mMoments.MakeZero();
+        }
+
+        void Add(Vector3<Real> const& point)
+        {
+            ++mNumPoints;
+            ApprQuadratic3<Real>::AccumulateMoments(point - mOrigin, (Real)1, mMoments);
+        }
+
+        // The point must have been added to the accumulator. This is not
+        // verified, but removing all points leads to the zero moments of an
+        // empty accumulator.
+        void Remove(Vector3<Real> const& point)
+        {
+            LogAssert(mNumPoints > 0, "The accumulator has no points.");
+            if (--mNumPoints > 0)
+            {
+                ApprQuadratic3<Real>::AccumulateMoments(point - mOrigin, (Real)-1, mMoments);
+            }
+            else
+            {
+                mMoments.MakeZero();
+            }
+        }
+
+        // Combine the moments of the points of 'other' with those of 'this'.
+        // The accumulators must have the same origin.
+        void Merge(ApprQuadraticAccumulator3 const& other)
+        {
+            LogAssert(mOrigin == other.mOrigin, "The accumulators must have the same origin.");
+            mNumPoints += other.mNumPoints;
+            mMoments += other.mMoments;
+        }
+
+        // Member access.
+        inline Vector3<Real> const& GetOrigin() const
+        {
+            return mOrigin;
+        }
+
+        inline size_t GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline Matrix<10, 10, Real> const& GetMoments() const
+        {
+            return mMoments;
+        }
+
+    private:
+        Vector3<Real> mOrigin;
+        size_t mNumPoints;
+        Matrix<10, 10, Real> mMoments;
+    };
+
 
     // If you think your points are nearly spherical, use this. The sphere is
     // of form C'[0]+C'[1]*X+C'[2]*Y+C'[3]*Z+C'[4]*(X^2+Y^2+Z^2) where
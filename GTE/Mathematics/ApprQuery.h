@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -134,6 +134,10 @@ namespace gte
         // candidate-model parameters to the current best-fit model.
         virtual void CopyParameters(ApprQuery const* input) = 0;
 
+        // This implementation fits a fixed number of hypotheses and counts
+        // the inliers of each for all observations. For large numbers of
+        // observations, see ApprRANSAC.h for early rejection of hypotheses
+        // and parallel evaluation.
         static bool RANSAC(ApprQuery& candidateModel, std::vector<ObservationType> const& observations,
             size_t numRequiredForGoodFit, Real maxErrorForGoodFit, size_t numIterations,
             std::vector<int>& bestConsensus, ApprQuery& bestModel)
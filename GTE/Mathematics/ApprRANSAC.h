@@ -0,0 +1,448 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/ApprQuery.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// The RANdom SAmple Consensus algorithm for any model derived from
+// ApprQuery<Real, ObservationType>, designed for large numbers of
+// observations. ApprQuery::RANSAC fits a fixed number of hypotheses and
+// counts the inliers of each against all observations, so its cost is
+// dominated by the evaluation of bad hypotheses. ApprRANSAC differs in
+// the following ways.
+//
+// 1. The evaluation of a hypothesis is the sequential probability ratio
+//    test (SPRT) of Matas and Chum, "Randomized RANSAC with Sequential
+//    Probability Ratio Test". The observations are visited in random order
+//    and the likelihood ratio of the hypothesis being bad is updated for
+//    each one. The hypothesis is rejected as soon as the ratio exceeds the
+//    threshold A, which is computed from the estimated inlier ratio
+//    epsilon of good hypotheses and the estimated probability delta that
+//    an observation is consistent with a bad hypothesis. A bad hypothesis
+//    is typically rejected after a few tens of observations. A hypothesis
+//    that is not rejected is evaluated against all observations, and its
+//    inlier count updates epsilon. The rejected hypotheses update delta.
+//
+// 2. The number of hypotheses is adaptive. The algorithm terminates when
+//    the probability of not having sampled an all-inlier set, with the
+//    inlier ratio of the best hypothesis, is smaller than 1 - confidence,
+//    where the probability that SPRT rejects a good hypothesis is taken
+//    into account. The maximum number of hypotheses is a bound for data
+//    without a good fit.
+//
+// 3. The hypotheses are generated and evaluated in batches by the threads
+//    of a scheduler when it is not null. Each chunk of hypotheses has its
+//    own copy of the model and random number generator. The estimates of
+//    epsilon and delta are updated between batches.
+//
+// 4. The errors of the observations are computed for blocks of
+//    consecutive observations. If Model has a member function
+//      void Errors(ObservationType const* observations,
+//          size_t numObservations, Real* errors) const;
+//    it is called for each block; otherwise the virtual function Error is
+//    called per observation. Errors should be a loop without branches that
+//    the compiler can vectorize, as in ApprOrthogonalLine3,
+//    ApprOrthogonalPlane3 and ApprHeightPlane3. The observations are
+//    copied once in a random order, so the blocks are contiguous.
+//
+// The result depends on the seed and on the number of chunks, which is
+// determined by the number of threads of the scheduler.
+
+namespace gte
+{
+    template <typename Real, typename ObservationType, typename Model>
+    class ApprRANSAC
+    {
+    public:
+        struct Parameters
+        {
+            Parameters()
+                :
+                maxHypotheses(10000),
+                confidence((Real)0.99),
+                modelCost((Real)200),
+                initialInlierRatio((Real)0.01),
+                initialConsistentRatio((Real)0.001),
+                hypothesesPerChunk(8),
+                seed(0)
+            {
+            }
+
+            // The upper bound on the number of hypotheses.
+            size_t maxHypotheses;
+
+            // The probability that an all-inlier sample is drawn, which
+            // determines the adaptive number of hypotheses.
+            Real confidence;
+
+            // The time to fit a model to a minimal sample in units of the
+            // time to compute the error of one observation.
+            Real modelCost;
+
+            // The initial estimates of epsilon and delta for SPRT.
+            Real initialInlierRatio, initialConsistentRatio;
+
+            // The number of hypotheses per chunk in each batch.
+            size_t hypothesesPerChunk;
+
+            // The seed of the random number generators.
+            uint32_t seed;
+        };
+
+        ApprRANSAC(Parameters const& parameters = Parameters())
+            :
+            mParameters(parameters),
+            mNumHypotheses(0),
+            mNumRejected(0)
+        {
+            static_assert(std::is_base_of<ApprQuery<Real, ObservationType>, Model>::value,
+                "The model must be derived from ApprQuery.");
+            LogAssert(mParameters.maxHypotheses > 0 && mParameters.hypothesesPerChunk > 0,
+                "Invalid hypothesis counts.");
+            LogAssert((Real)0 < mParameters.confidence && mParameters.confidence < (Real)1,
+                "The confidence must be in (0,1).");
+        }
+
+        // The input 'model' is copied for each chunk of hypotheses, so the
+        // model can have construction parameters. On return, it is fitted to
+        // the consensus set of the best hypothesis, and the indices of the
+        // observations of that set are stored in bestConsensus. The return
+        // value is 'true' when the consensus set has at least
+        // numRequiredForGoodFit observations and the final fit succeeds.
+        bool operator()(Model& model, size_t numObservations,
+            ObservationType const* observations, size_t numRequiredForGoodFit,
+            Real maxErrorForGoodFit, std::vector<int>& bestConsensus,
+            TaskScheduler* scheduler = nullptr)
+        {
+            mNumHypotheses = 0;
+            mNumRejected = 0;
+            bestConsensus.clear();
+
+            size_t const minRequired = model.GetMinimumRequired();
+            if (numObservations < minRequired || observations == nullptr)
+            {
+                // Too few observations for model fitting.
+                return false;
+            }
+
+            if (numObservations == minRequired)
+            {
+                // RANSAC cannot be used. Compute the model with the entire
+                // set of observations.
+                bestConsensus.resize(numObservations);
+                std::iota(bestConsensus.begin(), bestConsensus.end(), 0);
+                return model.Fit(numObservations, observations);
+            }
+
+            // Copy the observations in a random order, which makes the
+            // blocks of the SPRT evaluation random subsets.
+            std::default_random_engine dre(mParameters.seed);
+            mPermutation.resize(numObservations);
+            std::iota(mPermutation.begin(), mPermutation.end(), 0);
+            std::shuffle(mPermutation.begin(), mPermutation.end(), dre);
+            mObservations.resize(numObservations);
+            for (size_t i = 0; i < numObservations; ++i)
+            {
+                mObservations[i] = observations[mPermutation[i]];
+            }
+
+            size_t const numChunks = (scheduler ?
+                std::max(4 * scheduler->GetNumThreads(), static_cast<size_t>(1)) : 1);
+            std::vector<Worker> workers;
+            workers.reserve(numChunks);
+            for (size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                workers.emplace_back(model, mParameters.seed + 1 + static_cast<uint32_t>(chunk));
+            }
+
+            Real const n = static_cast<Real>(numObservations);
+            Real epsilon = mParameters.initialInlierRatio;
+            Real delta = mParameters.initialConsistentRatio;
+            size_t bestCount = 0;
+            size_t sumRejectedTested = 0, sumRejectedConsistent = 0;
+            Model best(model);
+
+            size_t maxHypotheses = mParameters.maxHypotheses;
+            while (mNumHypotheses < maxHypotheses)
+            {
+                Real const threshold = GetSPRTThreshold(epsilon, delta);
+                Real const ratioInlier = delta / epsilon;
+                Real const ratioOutlier = ((Real)1 - delta) / ((Real)1 - epsilon);
+                size_t const remaining = maxHypotheses - mNumHypotheses;
+                size_t const perChunk = std::min(mParameters.hypothesesPerChunk,
+                    (remaining + numChunks - 1) / numChunks);
+
+                TaskScheduler::ParallelFor(scheduler, numChunks,
+                    [this, &workers, perChunk, minRequired, maxErrorForGoodFit,
+                    threshold, ratioInlier, ratioOutlier](size_t chunk)
+                    {
+                        Evaluate(workers[chunk], perChunk, minRequired, maxErrorForGoodFit,
+                            threshold, ratioInlier, ratioOutlier);
+                    });
+
+                // Reduce the results of the chunks in chunk order.
+                for (auto& worker : workers)
+                {
+                    mNumHypotheses += worker.numHypotheses;
+                    mNumRejected += worker.numRejected;
+                    sumRejectedTested += worker.rejectedTested;
+                    sumRejectedConsistent += worker.rejectedConsistent;
+                    if (worker.bestCount > bestCount)
+                    {
+                        bestCount = worker.bestCount;
+                        best.CopyParameters(&worker.best);
+                    }
+                    worker.ResetStatistics();
+                }
+
+                // Update the SPRT estimates. The inlier ratio of the best
+                // hypothesis is a lower bound for that of the model. The
+                // consistent ratio of bad hypotheses is estimated from the
+                // rejected hypotheses. SPRT requires delta < epsilon.
+                if (bestCount > 0)
+                {
+                    epsilon = std::max(epsilon, static_cast<Real>(bestCount) / n);
+                }
+                if (sumRejectedTested > 0)
+                {
+                    delta = std::max(static_cast<Real>(sumRejectedConsistent) /
+                        static_cast<Real>(sumRejectedTested), (Real)1 / n);
+                }
+                epsilon = std::min(epsilon, (Real)1 - (Real)1 / n);
+
+                // Update the number of hypotheses. The probability that a
+                // sample is all-inlier and its hypothesis is accepted by
+                // SPRT is at least epsilon^m * (1 - 1/A).
+                if (bestCount > 0)
+                {
+                    Real const accept = GetSPRTThreshold(epsilon, delta);
+                    Real pGood = std::pow(epsilon, static_cast<Real>(minRequired));
+                    if (std::isfinite(accept))
+                    {
+                        pGood *= (Real)1 - (Real)1 / accept;
+                    }
+                    if (pGood >= (Real)1)
+                    {
+                        maxHypotheses = std::min(maxHypotheses, mNumHypotheses);
+                    }
+                    else if (pGood > (Real)0)
+                    {
+                        Real required = std::log((Real)1 - mParameters.confidence) /
+                            std::log((Real)1 - pGood);
+                        if (required < static_cast<Real>(maxHypotheses))
+                        {
+                            maxHypotheses = static_cast<size_t>(std::ceil(required));
+                        }
+                    }
+                }
+            }
+
+            if (bestCount == 0)
+            {
+                return false;
+            }
+
+            // Compute the consensus set of the best hypothesis for all
+            // observations in the original order, and fit the model to it.
+            std::vector<Real> errors(numObservations);
+            ComputeErrors(best, observations, numObservations, errors.data());
+            for (size_t i = 0; i < numObservations; ++i)
+            {
+                if (errors[i] <= maxErrorForGoodFit)
+                {
+                    bestConsensus.push_back(static_cast<int>(i));
+                }
+            }
+
+            model.CopyParameters(&best);
+            if (bestConsensus.size() < numRequiredForGoodFit || bestConsensus.size() < minRequired)
+            {
+                return false;
+            }
+            return model.FitIndexed(numObservations, observations,
+                bestConsensus.size(), bestConsensus.data());
+        }
+
+        // The statistics of the last call to operator().
+        inline size_t GetNumHypotheses() const
+        {
+            return mNumHypotheses;
+        }
+
+        inline size_t GetNumRejected() const
+        {
+            return mNumRejected;
+        }
+
+    private:
+        static size_t constexpr blockSize = 64;
+
+        struct Worker
+        {
+            Worker(Model const& model, uint32_t seed)
+                :
+                model(model),
+                best(model),
+                dre(seed)
+            {
+                ResetStatistics();
+                bestCount = 0;
+            }
+
+            void ResetStatistics()
+            {
+                numHypotheses = 0;
+                numRejected = 0;
+                rejectedTested = 0;
+                rejectedConsistent = 0;
+            }
+
+            Model model, best;
+            std::default_random_engine dre;
+            std::vector<int> sample;
+            std::array<Real, blockSize> errors;
+            size_t bestCount;
+            size_t numHypotheses, numRejected;
+            size_t rejectedTested, rejectedConsistent;
+        };
+
+        // Detect whether Model has the member function Errors.
+        template <typename M, typename = void>
+        struct HasErrors : std::false_type {};
+
+        template <typename M>
+        struct HasErrors<M, decltype(std::declval<M const&>().Errors(
+            std::declval<ObservationType const*>(), std::declval<size_t>(),
+            std::declval<Real*>()), void())> : std::true_type {};
+
+        template <typename M = Model>
+        static typename std::enable_if<HasErrors<M>::value>::type
+        ComputeErrors(M const& model, ObservationType const* observations,
+            size_t numObservations, Real* errors)
+        {
+            model.Errors(observations, numObservations, errors);
+        }
+
+        template <typename M = Model>
+        static typename std::enable_if<!HasErrors<M>::value>::type
+        ComputeErrors(M const& model, ObservationType const* observations,
+            size_t numObservations, Real* errors)
+        {
+            for (size_t i = 0; i < numObservations; ++i)
+            {
+                errors[i] = model.Error(observations[i]);
+            }
+        }
+
+        // The threshold A of SPRT is the solution of
+        //   A = modelCost / C + 1 + log(A)
+        // where C = (1-delta)*log((1-delta)/(1-epsilon))
+        //   + delta*log(delta/epsilon)
+        // is the expected increment of the logarithm of the likelihood ratio
+        // for a bad hypothesis. The fixed-point iteration converges quickly.
+        // The threshold is infinite, so no hypothesis is rejected, when
+        // delta >= epsilon.
+        Real GetSPRTThreshold(Real epsilon, Real delta) const
+        {
+            if (delta >= epsilon || delta <= (Real)0 || epsilon >= (Real)1)
+            {
+                return std::numeric_limits<Real>::infinity();
+            }
+
+            Real const C = ((Real)1 - delta) * std::log(((Real)1 - delta) / ((Real)1 - epsilon)) +
+                delta * std::log(delta / epsilon);
+            Real const K = mParameters.modelCost / C + (Real)1;
+            Real A = K;
+            for (int i = 0; i < 16; ++i)
+            {
+                A = K + std::log(A);
+            }
+            return A;
+        }
+
+        void Evaluate(Worker& worker, size_t numHypotheses, size_t minRequired,
+            Real maxErrorForGoodFit, Real threshold, Real ratioInlier, Real ratioOutlier)
+        {
+            size_t const numObservations = mObservations.size();
+            std::uniform_int_distribution<int> rnd(0, static_cast<int>(numObservations) - 1);
+            worker.sample.resize(minRequired);
+
+            for (size_t h = 0; h < numHypotheses; ++h)
+            {
+                // Draw a sample of distinct observations.
+                for (size_t j = 0; j < minRequired; ++j)
+                {
+                    int index;
+                    do
+                    {
+                        index = rnd(worker.dre);
+                    } while (std::find(worker.sample.begin(), worker.sample.begin() + j, index)
+                        != worker.sample.begin() + j);
+                    worker.sample[j] = index;
+                }
+
+                ++worker.numHypotheses;
+                if (!worker.model.FitIndexed(numObservations, mObservations.data(),
+                    minRequired, worker.sample.data()))
+                {
+                    continue;
+                }
+
+                // The SPRT test is applied after each block, which allows
+                // the errors and the likelihood ratio of a block to be
+                // computed without branches.
+                Real lambda = (Real)1;
+                size_t count = 0;
+                bool rejected = false;
+                for (size_t i = 0; i < numObservations; i += blockSize)
+                {
+                    size_t const numBlock = std::min(blockSize, numObservations - i);
+                    ComputeErrors(worker.model, &mObservations[i], numBlock, worker.errors.data());
+                    for (size_t j = 0; j < numBlock; ++j)
+                    {
+                        bool const inlier = (worker.errors[j] <= maxErrorForGoodFit);
+                        count += (inlier ? 1 : 0);
+                        lambda *= (inlier ? ratioInlier : ratioOutlier);
+                    }
+
+                    if (lambda > threshold)
+                    {
+                        ++worker.numRejected;
+                        worker.rejectedTested += i + numBlock;
+                        worker.rejectedConsistent += count;
+                        rejected = true;
+                        break;
+                    }
+                }
+
+                if (!rejected && count > worker.bestCount)
+                {
+                    worker.bestCount = count;
+                    worker.best.CopyParameters(&worker.model);
+                }
+            }
+        }
+
+        Parameters mParameters;
+        size_t mNumHypotheses, mNumRejected;
+        std::vector<int> mPermutation;
+        std::vector<ObservationType> mObservations;
+    };
+}
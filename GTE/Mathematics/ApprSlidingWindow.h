@@ -0,0 +1,129 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <cstddef>
+#include <vector>
+
+// The statistics of the most recent points of a stream, for example the
+// samples of a sensor, for fitting with ApprCovarianceAccumulator or
+// ApprQuadraticAccumulator3. The window stores at most 'capacity' points in
+// a ring buffer. Push adds a point and, when the window is full, removes
+// the oldest point from the accumulator, so the cost per point is constant.
+//
+// Each removal introduces rounding errors that do not cancel those of the
+// corresponding addition. To bound the drift of the statistics, the
+// accumulator is rebuilt from the points of the window after every
+// 'rebuildPeriod' removals. Set rebuildPeriod to 0 to disable the rebuilds,
+// which is reasonable for exact arithmetic or short streams. The amortized
+// cost of a rebuild is capacity/rebuildPeriod additions per point, so the
+// default period 'capacity' doubles the cost of Push.
+
+namespace gte
+{
+    template <typename Accumulator>
+    class ApprSlidingWindow
+    {
+    public:
+        using PointType = typename Accumulator::PointType;
+
+        ApprSlidingWindow(size_t capacity, Accumulator const& accumulator = Accumulator())
+            :
+            mRebuildPeriod(capacity),
+            mAccumulator(accumulator),
+            mPoints(capacity),
+            mNumPoints(0),
+            mOldest(0),
+            mNumRemovals(0)
+        {
+            LogAssert(capacity > 0, "The capacity must be positive.");
+        }
+
+        ApprSlidingWindow(size_t capacity, size_t rebuildPeriod,
+            Accumulator const& accumulator = Accumulator())
+            :
+            ApprSlidingWindow(capacity, accumulator)
+        {
+            mRebuildPeriod = rebuildPeriod;
+        }
+
+        void Clear()
+        {
+            mAccumulator.Clear();
+            mNumPoints = 0;
+            mOldest = 0;
+            mNumRemovals = 0;
+        }
+
+        void Push(PointType const& point)
+        {
+            size_t const capacity = mPoints.size();
+            if (mNumPoints < capacity)
+            {
+                mPoints[(mOldest + mNumPoints) % capacity] = point;
+                ++mNumPoints;
+                mAccumulator.Add(point);
+                return;
+            }
+
+            // The window is full, so the new point replaces the oldest.
+            mAccumulator.Remove(mPoints[mOldest]);
+            mPoints[mOldest] = point;
+            mOldest = (mOldest + 1) % capacity;
+            if (mRebuildPeriod > 0 && ++mNumRemovals >= mRebuildPeriod)
+            {
+                Rebuild();
+            }
+            else
+            {
+                mAccumulator.Add(point);
+            }
+        }
+
+        // Recompute the statistics from the points of the window.
+        void Rebuild()
+        {
+            size_t const capacity = mPoints.size();
+            mAccumulator.Clear();
+            for (size_t i = 0; i < mNumPoints; ++i)
+            {
+                mAccumulator.Add(mPoints[(mOldest + i) % capacity]);
+            }
+            mNumRemovals = 0;
+        }
+
+        // Member access. The points are ordered from oldest to newest for
+        // i = 0 through GetNumPoints()-1.
+        inline Accumulator const& GetAccumulator() const
+        {
+            return mAccumulator;
+        }
+
+        inline size_t GetCapacity() const
+        {
+            return mPoints.size();
+        }
+
+        inline size_t GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline PointType const& GetPoint(size_t i) const
+        {
+            return mPoints[(mOldest + i) % mPoints.size()];
+        }
+
+    private:
+        size_t mRebuildPeriod;
+        Accumulator mAccumulator;
+        std::vector<PointType> mPoints;
+        size_t mNumPoints, mOldest, mNumRemovals;
+    };
+}
@@ -10,6 +10,9 @@
 #include <Mathematics/UIntegerALU32.h>
 #include <Mathematics/UIntegerAP32.h>
 #include <Mathematics/UIntegerFP32.h>
+#include <Mathematics/UIntegerSB32.h>
+#include <Mathematics/UIntegerArena32.h>
 #include <Mathematics/BSNumber.h>
 #include <Mathematics/BSRational.h>
+#include <Mathematics/BSFusedArithmetic.h>
 #include <Mathematics/BSPrecision.h>
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -164,7 +164,7 @@ namespace gte
             mIndirect2.resize(mBound2 * mBound3);
             mIndirect3.resize(mBound3);
 
-            if (mBound0 > 0)
+            if (mObjects.size() > 0)
             {
                 // The objects are owned.
                 SetPointers(mObjects.data());
@@ -0,0 +1,343 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BSNumber.h>
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Fused evaluation of sums of products of BSNumber objects. An expression
+// such as a*b - c*d written with the BSNumber operators creates a normalized
+// BSNumber temporary for each product and for each partial sum, and each
+// addition or subtraction shifts one operand to align it with the other.
+// The functions here compute the products as UInteger objects, add them in
+// place, aligned to the minimum exponent, to accumulators for the positive
+// and the negative terms and normalize only once at the end, directly into
+// the output. The product and accumulator storage are members of the class,
+// so when an object of this class is reused for many predicates, the storage
+// is reused. The output is the exact value of the expression.
+//
+// The supported shapes are those at the core of exact predicates:
+//   SumOfProducts: sum_{i} s[i]*x[i]*y[i] with s[i] in {-1,+1}
+//   Dot:           Dot(u,v) for Vector<N,BSNumber>
+//   Det2:          a00*a11 - a01*a10
+//   Det3:          DotCross(r0,r1,r2), the determinant of the rows r0,r1,r2
+//   Det4:          the determinant of the rows r0,r1,r2,r3
+// Det3 and Det4 use fused 2x2 minors followed by a fused sum of products,
+// so the number of multiplications is the same as that of the cofactor
+// expansions in PrimalQuery2 and PrimalQuery3.
+//
+// An object of this class is not thread-safe. Use one object per thread.
+
+namespace gte
+{
+    template <typename UInteger>
+    class BSFusedArithmetic
+    {
+    public:
+        using Number = BSNumber<UInteger>;
+
+        BSFusedArithmetic() = default;
+
+        // Compute sum_{i=0}^{numTerms-1} s[i]*x[i]*y[i]. If 'signs' is null,
+        // all s[i] are +1; otherwise, each s[i] must be -1 or +1.
+        Number SumOfProducts(size_t numTerms, Number const* x, Number const* y,
+            int32_t const* signs = nullptr)
+        {
+            if (mX.size() < numTerms)
+            {
+                mX.resize(numTerms);
+                mY.resize(numTerms);
+            }
+            for (size_t i = 0; i < numTerms; ++i)
+            {
+                mX[i] = &x[i];
+                mY[i] = &y[i];
+            }
+            return SumOfProducts(numTerms, mX.data(), mY.data(), signs);
+        }
+
+        // The same as the previous function but the factors are passed by
+        // pointer, which avoids copying them to contiguous arrays.
+        Number SumOfProducts(size_t numTerms, Number const* const* x, Number const* const* y,
+            int32_t const* signs = nullptr)
+        {
+            if (mTerms.size() < numTerms)
+            {
+                mTerms.resize(numTerms);
+            }
+
+            // Compute the nonzero products as UInteger objects.
+            size_t numNonzero = 0;
+            int32_t minExponent = 0;
+            for (size_t i = 0; i < numTerms; ++i)
+            {
+                Number const& xi = *x[i];
+                Number const& yi = *y[i];
+                int32_t sign = xi.GetSign() * yi.GetSign();
+                if (sign != 0)
+                {
+                    Term& term = mTerms[numNonzero++];
+                    term.sign = (signs ? sign * signs[i] : sign);
+                    term.biasedExponent = xi.GetBiasedExponent() + yi.GetBiasedExponent();
+                    term.product.Mul(xi.GetUInteger(), yi.GetUInteger());
+                    if (numNonzero == 1 || term.biasedExponent < minExponent)
+                    {
+                        minExponent = term.biasedExponent;
+                    }
+                }
+            }
+
+            if (numNonzero == 0)
+            {
+                return Number();
+            }
+
+            // Accumulate the positive and negative terms aligned to the
+            // minimum exponent. The accumulators are arrays of 32-bit blocks
+            // large enough to store the sums without overflow, and the
+            // aligned products are added in place.
+            size_t numBlocks = 0;
+            for (size_t i = 0; i < numNonzero; ++i)
+            {
+                Term const& term = mTerms[i];
+                size_t numBits = static_cast<size_t>(term.biasedExponent - minExponent) +
+                    static_cast<size_t>(term.product.GetNumBits());
+                numBlocks = std::max(numBlocks, numBits / 32 + 1);
+            }
+            // Each carry-out of the sums requires at most one more bit.
+            numBlocks += 1 + numNonzero / 32;
+            mPositive.assign(numBlocks, 0u);
+            mNegative.assign(numBlocks, 0u);
+            for (size_t i = 0; i < numNonzero; ++i)
+            {
+                Term const& term = mTerms[i];
+                std::vector<uint32_t>& accumulator = (term.sign > 0 ? mPositive : mNegative);
+                AddShifted(accumulator, term.product, term.biasedExponent - minExponent);
+            }
+
+            // Compute the difference of the accumulators and normalize the
+            // result so that its UInteger is odd.
+            int32_t order = Compare(mPositive, mNegative);
+            Number result;
+            if (order > 0)
+            {
+                Subtract(mPositive, mNegative);
+                Normalize(+1, minExponent, mPositive, result);
+            }
+            else if (order < 0)
+            {
+                Subtract(mNegative, mPositive);
+                Normalize(-1, minExponent, mNegative, result);
+            }
+            return result;
+        }
+
+        template <int N>
+        Number Dot(Vector<N, Number> const& u, Vector<N, Number> const& v)
+        {
+            return SumOfProducts(N, &u[0], &v[0]);
+        }
+
+        // Compute a00*a11 - a01*a10.
+        Number Det2(Number const& a00, Number const& a01, Number const& a10, Number const& a11)
+        {
+            std::array<Number const*, 2> const x = { &a00, &a01 };
+            std::array<Number const*, 2> const y = { &a11, &a10 };
+            return SumOfProducts(2, x.data(), y.data(), msSigns2);
+        }
+
+        // Compute DotCross(r0,r1,r2), which is the determinant of the 3x3
+        // matrix whose rows are r0, r1 and r2.
+        Number Det3(Vector<3, Number> const& r0, Vector<3, Number> const& r1,
+            Vector<3, Number> const& r2)
+        {
+            std::array<Number, 3> cofactor =
+            {
+                Det2(r1[1], r1[2], r2[1], r2[2]),
+                Det2(r1[2], r1[0], r2[2], r2[0]),
+                Det2(r1[0], r1[1], r2[0], r2[1])
+            };
+            return SumOfProducts(3, &r0[0], cofactor.data());
+        }
+
+        // Compute the determinant of the 4x4 matrix whose rows are r0, r1, r2
+        // and r3. The determinant is expanded using the 2x2 minors of rows
+        // r0 and r1 and the complementary 2x2 minors of rows r2 and r3.
+        Number Det4(Vector<4, Number> const& r0, Vector<4, Number> const& r1,
+            Vector<4, Number> const& r2, Vector<4, Number> const& r3)
+        {
+            std::array<Number, 6> a =
+            {
+                Det2(r0[0], r0[1], r1[0], r1[1]),
+                Det2(r0[0], r0[2], r1[0], r1[2]),
+                Det2(r0[0], r0[3], r1[0], r1[3]),
+                Det2(r0[1], r0[2], r1[1], r1[2]),
+                Det2(r0[1], r0[3], r1[1], r1[3]),
+                Det2(r0[2], r0[3], r1[2], r1[3])
+            };
+            std::array<Number, 6> b =
+            {
+                Det2(r2[2], r2[3], r3[2], r3[3]),
+                Det2(r2[1], r2[3], r3[1], r3[3]),
+                Det2(r2[1], r2[2], r3[1], r3[2]),
+                Det2(r2[0], r2[3], r3[0], r3[3]),
+                Det2(r2[0], r2[2], r3[0], r3[2]),
+                Det2(r2[0], r2[1], r3[0], r3[1])
+            };
+            return SumOfProducts(6, a.data(), b.data(), msSigns6);
+        }
+
+    private:
+        struct Term
+        {
+            Term()
+                :
+                sign(0),
+                biasedExponent(0)
+            {
+            }
+
+            int32_t sign, biasedExponent;
+            UInteger product;
+        };
+
+        // Compute accumulator += number*2^shift.
+        static void AddShifted(std::vector<uint32_t>& accumulator, UInteger const& number,
+            int32_t shift)
+        {
+            auto const& bits = number.GetBits();
+            int32_t const numElements = number.GetSize();
+            size_t i = static_cast<size_t>(shift / 32);
+            int32_t const lshift = shift % 32;
+            uint64_t carry = 0, sum;
+            if (lshift > 0)
+            {
+                int32_t const rshift = 32 - lshift;
+                uint32_t prev = 0, curr;
+                for (int32_t j = 0; j < numElements; ++i, ++j)
+                {
+                    curr = bits[j];
+                    sum = (uint64_t)accumulator[i] + (uint64_t)((curr << lshift) | (prev >> rshift)) + carry;
+                    accumulator[i] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                    carry = (sum >> 32);
+                    prev = curr;
+                }
+                sum = (uint64_t)accumulator[i] + (uint64_t)(prev >> rshift) + carry;
+                accumulator[i++] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                carry = (sum >> 32);
+            }
+            else
+            {
+                for (int32_t j = 0; j < numElements; ++i, ++j)
+                {
+                    sum = (uint64_t)accumulator[i] + (uint64_t)bits[j] + carry;
+                    accumulator[i] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                    carry = (sum >> 32);
+                }
+            }
+            for (/**/; carry > 0; ++i)
+            {
+                sum = (uint64_t)accumulator[i] + carry;
+                accumulator[i] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                carry = (sum >> 32);
+            }
+        }
+
+        // Compare two nonnegative integers with the same number of blocks.
+        // The return value is -1 when n0 < n1, 0 when n0 = n1 or +1 when
+        // n0 > n1.
+        static int32_t Compare(std::vector<uint32_t> const& n0, std::vector<uint32_t> const& n1)
+        {
+            for (size_t i = n0.size(); i > 0; --i)
+            {
+                if (n0[i - 1] != n1[i - 1])
+                {
+                    return (n0[i - 1] < n1[i - 1] ? -1 : +1);
+                }
+            }
+            return 0;
+        }
+
+        // Compute n0 -= n1, where n0 > n1 and both have the same number of
+        // blocks.
+        static void Subtract(std::vector<uint32_t>& n0, std::vector<uint32_t> const& n1)
+        {
+            int64_t borrow = 0, diff;
+            for (size_t i = 0; i < n0.size(); ++i)
+            {
+                diff = (int64_t)n0[i] - (int64_t)n1[i] - borrow;
+                borrow = (diff < 0 ? 1 : 0);
+                n0[i] = (uint32_t)(diff + (borrow << 32));
+            }
+        }
+
+        // Copy the positive integer 'number', shifted right to be odd, to
+        // the UInteger of 'result'.
+        static void Normalize(int32_t sign, int32_t biasedExponent,
+            std::vector<uint32_t> const& number, Number& result)
+        {
+            int32_t last = static_cast<int32_t>(number.size()) - 1;
+            while (number[last] == 0)
+            {
+                --last;
+            }
+            int32_t first = 0;
+            while (number[first] == 0)
+            {
+                ++first;
+            }
+            int32_t const rshift = BitHacks::GetTrailingBit(number[first]);
+            int32_t const firstBitIndex = 32 * last + BitHacks::GetLeadingBit(number[last]);
+            int32_t const lastBitIndex = 32 * first + rshift;
+
+            UInteger& uinteger = result.GetUInteger();
+            uinteger.SetNumBits(firstBitIndex - lastBitIndex + 1);
+            auto& bits = uinteger.GetBits();
+            int32_t const numBlocks = uinteger.GetSize();
+            if (rshift > 0)
+            {
+                int32_t const lshift = 32 - rshift;
+                for (int32_t i = 0, j = first; i < numBlocks; ++i, ++j)
+                {
+                    uint32_t next = (j + 1 <= last ? number[j + 1] : 0u);
+                    bits[i] = (number[j] >> rshift) | (next << lshift);
+                }
+            }
+            else
+            {
+                for (int32_t i = 0, j = first; i < numBlocks; ++i, ++j)
+                {
+                    bits[i] = number[j];
+                }
+            }
+
+            result.SetBiasedExponent(biasedExponent + lastBitIndex);
+            result.SetSign(sign);
+#if defined (GTE_VALIDATE_BSNUMBER)
+            LogAssert(result.IsValid(), "Invalid BSNumber.");
+#endif
+        }
+
+        std::vector<Term> mTerms;
+        std::vector<uint32_t> mPositive, mNegative;
+        std::vector<Number const*> mX, mY;
+
+        static int32_t constexpr msSigns2[2] = { +1, -1 };
+        static int32_t constexpr msSigns6[6] = { +1, -1, +1, +1, -1, +1 };
+    };
+
+    template <typename UInteger>
+    int32_t constexpr BSFusedArithmetic<UInteger>::msSigns2[2];
+
+    template <typename UInteger>
+    int32_t constexpr BSFusedArithmetic<UInteger>::msSigns6[6];
+}
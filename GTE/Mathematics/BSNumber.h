@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.03.08
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -47,8 +47,10 @@
 //
 // GTEngine currently has 32-bits-per-word storage for UInteger. See the
 // classes UIntegerAP32 (arbitrary precision), UIntegerFP32<N> (fixed
-// precision), and UIntegerALU32 (arithmetic logic unit shared by the previous
-// two classes). The document at the following link describes the design,
+// precision), UIntegerSB32<N> (arbitrary precision with small-buffer storage
+// of N words), UIntegerArena32 (arbitrary precision with per-thread arena
+// storage) and UIntegerALU32 (arithmetic logic unit shared by the previous
+// four classes). The document at the following link describes the design,
 // implementation, and use of BSNumber and BSRational.
 //   https://www.geometrictools.com/Documentation/ArbitraryPrecision.pdf
 
@@ -606,6 +608,47 @@ namespace gte
             return *this;
         }
 
+        // Arithmetic that stores the result in an existing object. The
+        // operators above return new objects, so each operation allocates
+        // the storage of its result when UInteger is UIntegerAP32. The
+        // functions here reuse the storage of 'result' and of 'temp', which
+        // is a scratch object for the alignment of the operands. When the
+        // objects are reused for many evaluations of the same expression,
+        // for example, by PrimalQueryEvaluator3, the storage grows to the
+        // required size once and then is not reallocated. The object
+        // 'result' must not be n0 or n1, and 'temp' must be distinct from
+        // the other arguments.
+        static void Add(BSNumber const& n0, BSNumber const& n1, BSNumber& result, BSNumber& temp)
+        {
+            AddSigned(n0, n1, n1.mSign, result, temp);
+        }
+
+        static void Sub(BSNumber const& n0, BSNumber const& n1, BSNumber& result, BSNumber& temp)
+        {
+            AddSigned(n0, n1, -n1.mSign, result, temp);
+        }
+
+        static void Mul(BSNumber const& n0, BSNumber const& n1, BSNumber& result)
+        {
+            int32_t sign = n0.mSign * n1.mSign;
+            if (sign != 0)
+            {
+                result.mSign = sign;
+                result.mBiasedExponent = n0.mBiasedExponent + n1.mBiasedExponent;
+                result.mUInteger.Mul(n0.mUInteger, n1.mUInteger);
+#if defined(GTE_BINARY_SCIENTIFIC_SHOW_DOUBLE)
+                result.mValue = (double)result;
+#endif
+#if defined (GTE_VALIDATE_BSNUMBER)
+                LogAssert(result.IsValid(), "Invalid BSNumber.");
+#endif
+            }
+            else
+            {
+                result.SetToZero();
+            }
+        }
+
         // Disk input/output. The fstream objects should be created using
         // std::ios::binary. The return value is 'true' iff the operation
         // was successful.
@@ -715,7 +758,13 @@ namespace gte
         static BSNumber AddIgnoreSign(BSNumber const& n0, BSNumber const& n1, int32_t resultSign)
         {
             BSNumber result, temp;
+            AddIgnoreSign(n0, n1, resultSign, result, temp);
+            return result;
+        }
 
+        static void AddIgnoreSign(BSNumber const& n0, BSNumber const& n1, int32_t resultSign,
+            BSNumber& result, BSNumber& temp)
+        {
             int32_t diff = n0.mBiasedExponent - n1.mBiasedExponent;
             if (diff > 0)
             {
@@ -743,14 +792,19 @@ namespace gte
 #if defined(GTE_BINARY_SCIENTIFIC_SHOW_DOUBLE)
             result.mValue = (double)result;
 #endif
-            return result;
         }
 
         // Subtract two positive numbers where n0 > n1.
         static BSNumber SubIgnoreSign(BSNumber const& n0, BSNumber const& n1, int32_t resultSign)
         {
             BSNumber result, temp;
+            SubIgnoreSign(n0, n1, resultSign, result, temp);
+            return result;
+        }
 
+        static void SubIgnoreSign(BSNumber const& n0, BSNumber const& n1, int32_t resultSign,
+            BSNumber& result, BSNumber& temp)
+        {
             int32_t diff = n0.mBiasedExponent - n1.mBiasedExponent;
             if (diff > 0)
             {
@@ -778,7 +832,51 @@ namespace gte
 #if defined(GTE_BINARY_SCIENTIFIC_SHOW_DOUBLE)
             result.mValue = (double)result;
 #endif
-            return result;
+        }
+
+        // Compute n0 + n1, where the sign of n1 is replaced by sign1, and
+        // store it in 'result'.
+        static void AddSigned(BSNumber const& n0, BSNumber const& n1, int32_t sign1,
+            BSNumber& result, BSNumber& temp)
+        {
+            if (n0.mSign == 0)
+            {
+                result = n1;
+                result.mSign = sign1;
+            }
+            else if (sign1 == 0)
+            {
+                result = n0;
+            }
+            else if (n0.mSign == sign1)
+            {
+                AddIgnoreSign(n0, n1, sign1, result, temp);
+            }
+            else if (!EqualIgnoreSign(n0, n1))
+            {
+                if (LessThanIgnoreSign(n1, n0))
+                {
+                    SubIgnoreSign(n0, n1, n0.mSign, result, temp);
+                }
+                else
+                {
+                    SubIgnoreSign(n1, n0, sign1, result, temp);
+                }
+            }
+            else
+            {
+                result.SetToZero();
+            }
+        }
+
+        void SetToZero()
+        {
+            mSign = 0;
+            mBiasedExponent = 0;
+            mUInteger.SetNumBits(0);
+#if defined(GTE_BINARY_SCIENTIFIC_SHOW_DOUBLE)
+            mValue = 0.0;
+#endif
         }
 
         // Support for conversions from floating-point numbers to BSNumber.
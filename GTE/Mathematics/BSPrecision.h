@@ -3,16 +3,27 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.08.22
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 // Support for determining the number of bits of precision required to compute
-// an expression using BSNumber or BSRational.
+// an expression using BSNumber or BSRational.  All the operations are
+// constexpr, so the number of 32-bit words for UIntegerFP32<N> can be
+// computed at compile time from an expression tree.  For example,
+//   template <typename T>
+//   constexpr int32_t GetDet2Words()
+//   {
+//       constexpr BSPrecision input(BSPrecision::GetType<T>());
+//       return (input * input - input * input).bsn.maxWords;
+//   }
+//   using Rational = BSNumber<UIntegerFP32<GetDet2Words<double>()>>;
+// See BSPrecisionPredicates.h for the expressions of the exact predicates.
 
 namespace gte
 {
@@ -31,7 +42,7 @@ namespace gte
 
         struct Parameters
         {
-            Parameters()
+            constexpr Parameters()
                 :
                 minExponent(0),
                 maxExponent(0),
@@ -40,7 +51,7 @@ namespace gte
             {
             }
 
-            Parameters(int inMinExponent, int inMaxExponent, int inMaxBits)
+            constexpr Parameters(int inMinExponent, int inMaxExponent, int inMaxBits)
                 :
                 minExponent(inMinExponent),
                 maxExponent(inMaxExponent),
@@ -49,7 +60,7 @@ namespace gte
             {
             }
 
-            inline int GetMaxWords() const
+            inline constexpr int GetMaxWords() const
             {
                 return maxBits / 32 + ((maxBits % 32) > 0 ? 1 : 0);
             }
@@ -59,9 +70,9 @@ namespace gte
 
         Parameters bsn, bsr;
 
-        BSPrecision() = default;
+        constexpr BSPrecision() = default;
 
-        BSPrecision(Type type)
+        constexpr BSPrecision(Type type)
         {
             switch (type)
             {
@@ -87,15 +98,44 @@ namespace gte
             bsr = bsn;
         }
 
-        BSPrecision(int minExponent, int maxExponent, int maxBits)
+        constexpr BSPrecision(int minExponent, int maxExponent, int maxBits)
             :
             bsn(minExponent, maxExponent, maxBits),
             bsr(minExponent, maxExponent, maxBits)
         {
         }
+
+        // The number of 32-bit words N for UIntegerFP32<N> when the
+        // expression is computed using BSNumber (forBSNumber is 'true') or
+        // BSRational (forBSNumber is 'false').
+        inline constexpr int GetMaxWords(bool forBSNumber) const
+        {
+            return (forBSNumber ? bsn.maxWords : bsr.maxWords);
+        }
+
+        // Map a native type to its Type value.  The type T must be one of
+        // float, double, int32_t, int64_t, uint32_t or uint64_t.
+        template <typename T>
+        static constexpr Type GetType()
+        {
+            static_assert(
+                std::is_same<T, float>::value ||
+                std::is_same<T, double>::value ||
+                std::is_same<T, int32_t>::value ||
+                std::is_same<T, int64_t>::value ||
+                std::is_same<T, uint32_t>::value ||
+                std::is_same<T, uint64_t>::value,
+                "Invalid type.");
+
+            return (std::is_same<T, float>::value ? IS_FLOAT :
+                std::is_same<T, double>::value ? IS_DOUBLE :
+                std::is_same<T, int32_t>::value ? IS_INT32 :
+                std::is_same<T, int64_t>::value ? IS_INT64 :
+                std::is_same<T, uint32_t>::value ? IS_UINT32 : IS_UINT64);
+        }
     };
 
-    inline BSPrecision operator+(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator+(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         BSPrecision result;
 
@@ -154,12 +194,12 @@ namespace gte
         return result;
     }
 
-    inline BSPrecision operator-(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator-(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         return bsp0 + bsp1;
     }
 
-    inline BSPrecision operator*(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator*(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         BSPrecision result;
 
@@ -178,7 +218,7 @@ namespace gte
         return result;
     }
 
-    inline BSPrecision operator/(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator/(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         BSPrecision result;
 
@@ -198,7 +238,7 @@ namespace gte
     // Comparisons for BSNumber do not involve dynamic allocations, so
     // the results are the extremes of the inputs. Comparisons for BSRational
     // involve multiplications of numerators and denominators.
-    inline BSPrecision operator==(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator==(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         BSPrecision result;
 
@@ -215,27 +255,27 @@ namespace gte
         return result;
     }
 
-    inline BSPrecision operator!=(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator!=(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         return operator==(bsp0, bsp1);
     }
 
-    inline BSPrecision operator<(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator<(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         return operator==(bsp0, bsp1);
     }
 
-    inline BSPrecision operator<=(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator<=(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         return operator==(bsp0, bsp1);
     }
 
-    inline BSPrecision operator>(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator>(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         return operator==(bsp0, bsp1);
     }
 
-    inline BSPrecision operator>=(BSPrecision const& bsp0, BSPrecision const& bsp1)
+    inline constexpr BSPrecision operator>=(BSPrecision const& bsp0, BSPrecision const& bsp1)
     {
         return operator==(bsp0, bsp1);
     }
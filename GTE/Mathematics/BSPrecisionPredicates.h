@@ -0,0 +1,272 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BSNumber.h>
+#include <Mathematics/BSPrecision.h>
+#include <Mathematics/BSRational.h>
+#include <Mathematics/UIntegerFP32.h>
+
+// Compile-time selection of N for UIntegerFP32<N> for the exact predicates
+// of PrimalQuery2, PrimalQuery3 and the classes that use them, and for the
+// exact constructions of the minimum-area bounding algorithms. The
+// expression trees are those of the worst-case computational paths of the
+// predicates; see GeometricTools/GTE/Tools/PrecisionCalculator, which
+// prints the same numbers at runtime. The template parameter T is the input
+// type of the vertex components, one of the types supported by
+// BSPrecision::GetType<T>(). For example,
+//   using Rational = BSPrecisionPredicates::ToPlaneNumber<double>;
+// is BSNumber<UIntegerFP32<197>>.
+
+namespace gte
+{
+    class BSPrecisionPredicates
+    {
+    public:
+        // det2 = a00 * a11 - a01 * a10
+        //   float : BSNumber 18, BSRational 35
+        //   double: BSNumber 132, BSRational 263
+        template <typename T>
+        static constexpr int Determinant2(bool forBSNumber)
+        {
+            BSPrecision const input(BSPrecision::GetType<T>());
+            BSPrecision const prod = input * input;
+            BSPrecision const det2 = prod - prod;
+            return det2.GetMaxWords(forBSNumber);
+        }
+
+        // det3 = a00 * c0 - a01 * c1 + a02 * c2, where the c-terms are
+        // 2x2 determinants
+        //   float : BSNumber 27, BSRational 130
+        //   double: BSNumber 197, BSRational 984
+        template <typename T>
+        static constexpr int Determinant3(bool forBSNumber)
+        {
+            BSPrecision const input(BSPrecision::GetType<T>());
+            BSPrecision const prod = input * input;
+            BSPrecision const det2 = prod - prod;
+            BSPrecision const term1 = input * det2;
+            BSPrecision const term2 = term1 + term1;
+            BSPrecision const det3 = term1 + term2;
+            return det3.GetMaxWords(forBSNumber);
+        }
+
+        // PrimalQuery2::ToLine and ToLineExtended
+        //   float : BSNumber 18, BSRational 70
+        //   double: BSNumber 132, BSRational 525
+        template <typename T>
+        static constexpr int ToLine(bool forBSNumber)
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u + u;
+            BSPrecision const mul = add0 * add0;
+            BSPrecision const add1 = mul + mul;
+            return add1.GetMaxWords(forBSNumber);
+        }
+
+        // PrimalQuery2::ToCircumcircle
+        //   float : BSNumber 35, BSRational 573
+        //   double: BSNumber 263, BSRational 4329
+        template <typename T>
+        static constexpr int ToCircumcircle(bool forBSNumber)
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u + u;
+            BSPrecision const mul0 = add0 * add0;
+            BSPrecision const add1 = mul0 + mul0;
+            BSPrecision const mul1 = add0 * add1;
+            BSPrecision const add2 = mul1 + mul1;
+            BSPrecision const mul2 = add0 * add2;
+            BSPrecision const add3 = mul2 + mul2;
+            BSPrecision const add4 = add3 + mul2;
+            return add4.GetMaxWords(forBSNumber);
+        }
+
+        // PrimalQuery3::ToPlane
+        //   float : BSNumber 27, BSRational 261
+        //   double: BSNumber 197, BSRational 1968
+        template <typename T>
+        static constexpr int ToPlane(bool forBSNumber)
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u + u;
+            BSPrecision const mul0 = add0 * add0;
+            BSPrecision const add1 = mul0 + mul0;
+            BSPrecision const mul1 = add0 * add1;
+            BSPrecision const add2 = mul1 + mul1;
+            BSPrecision const add3 = add2 + mul1;
+            return add3.GetMaxWords(forBSNumber);
+        }
+
+        // PrimalQuery3::ToCircumsphere
+        //   float : BSNumber 44, BSRational 1875
+        //   double: BSNumber 329, BSRational 14167
+        template <typename T>
+        static constexpr int ToCircumsphere(bool forBSNumber)
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u + u;
+            BSPrecision const mul0 = add0 * add0;
+            BSPrecision const add1 = mul0 + mul0;
+            BSPrecision const add2 = add1 + mul0;
+            BSPrecision const mul1 = add0 * add0;
+            BSPrecision const add3 = mul1 + mul1;
+            BSPrecision const mul2 = add0 * add2;
+            BSPrecision const add4 = mul2 + mul2;
+            BSPrecision const mul3 = add3 * add4;
+            BSPrecision const add5 = mul3 + mul3;
+            BSPrecision const add6 = add5 + mul3;
+            BSPrecision const add7 = add6 + mul3;
+            BSPrecision const add8 = add7 + mul3;
+            BSPrecision const add9 = add8 + mul3;
+            return add9.GetMaxWords(forBSNumber);
+        }
+
+        // MinimumAreaBox2 with ComputeType BSRational. The worst-case path
+        // is the comparison of box areas w*h/|U|^2, where U is an edge
+        // direction and w and h are dot products of U or Perp(U) with
+        // vertex differences. BSNumber does not support the divisions, so
+        // only the BSRational count is available.
+        //   float : BSRational 556
+        //   double: BSRational 4198
+        template <typename T>
+        static constexpr int MinimumAreaBox2()
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u - u;
+            BSPrecision const mul0 = add0 * add0;
+            BSPrecision const add1 = mul0 + mul0;
+            BSPrecision const add2 = add1 - add1;
+            BSPrecision const mul1 = add2 * add1;
+            BSPrecision const div0 = mul1 / add1;
+            BSPrecision const cmp0 = (div0 < div0);
+            return cmp0.GetMaxWords(false);
+        }
+
+        // The circumcircle of three points P0, P1 and P2 in the homogeneous
+        // form C = P2 + N/D and r^2 = |N|^2/D^2, where E0 = P0 - P2,
+        // E1 = P1 - P2, D = 2*DotPerp(E0,E1) and N is a linear combination
+        // of E0 and E1 with coefficients |E0|^2 and |E1|^2. The numbers are
+        // computed with BSNumber; the count includes the subtraction of the
+        // denominator from the numerator that occurs in the conversion of
+        // n/d to floating-point.
+        //   float : BSNumber 43
+        //   double: BSNumber 327
+        template <typename T>
+        static constexpr int Circumcircle2()
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u - u;
+            BSPrecision const mul0 = add0 * add0;
+            BSPrecision const add1 = mul0 + mul0;
+            BSPrecision const add2 = mul0 - mul0;
+            BSPrecision const add3 = add2 + add2;
+            BSPrecision const mul1 = add1 * add0;
+            BSPrecision const add4 = mul1 - mul1;
+            BSPrecision const mul2 = add4 * add4;
+            BSPrecision const add5 = mul2 + mul2;
+            BSPrecision const mul3 = add3 * add3;
+            BSPrecision const add6 = add5 - mul3;
+            BSPrecision const mul4 = u * add3;
+            BSPrecision const add7 = mul4 + add4;
+            BSPrecision const add8 = add7 - add3;
+            return std::max(add6.GetMaxWords(true), add8.GetMaxWords(true));
+        }
+
+        // The spheres of MinimumVolumeSphere3Filtered with 3 or 4 support
+        // points in the homogeneous form C = A + N/D and r^2 = |N|^2/D^2,
+        // where A is a support point. For 3 support points, D = 2*|W|^2 and
+        // N = |U|^2*Cross(V,W) + |V|^2*Cross(W,U), where U and V are support
+        // point differences and W = Cross(U,V). For 4 support points,
+        // D = 2*Dot(U,Cross(V,W)) and N = |U|^2*Cross(V,W) + |V|^2*Cross(W,U)
+        // + |W|^2*Cross(U,V). The containment test for a point P is the sign
+        // of D*(D*|Q|^2 - 2*Dot(Q,N)), where Q = P - A. The numbers are
+        // computed with BSNumber; the counts include the subtractions of the
+        // denominators from the numerators that occur in the conversions of
+        // the center and squared radius to floating-point.
+        //   float : BSNumber 78
+        //   double: BSNumber 590
+        template <typename T>
+        static constexpr int MinimumVolumeSphere3()
+        {
+            BSPrecision const u(BSPrecision::GetType<T>());
+            BSPrecision const add0 = u - u;
+            BSPrecision const mul0 = add0 * add0;
+            BSPrecision const add1 = mul0 - mul0;
+            BSPrecision const add2 = mul0 + mul0 + mul0;
+
+            // 3 support points: the test, the squared radius and the center.
+            BSPrecision const mul1 = add1 * add1;
+            BSPrecision const add3 = mul1 + mul1 + mul1;
+            BSPrecision const add4 = add3 + add3;
+            BSPrecision const mul2 = add0 * add1;
+            BSPrecision const add5 = mul2 - mul2;
+            BSPrecision const mul3 = add2 * add5;
+            BSPrecision const add6 = mul3 + mul3;
+            BSPrecision const mul4 = add0 * add6;
+            BSPrecision const add7 = mul4 + mul4 + mul4;
+            BSPrecision const add8 = add4 * add2 - (add7 + add7);
+            BSPrecision const mul5 = add6 * add6;
+            BSPrecision const add9 = (mul5 + mul5 + mul5) - add4 * add4;
+            BSPrecision const add10 = u * add4 + add6 - add4;
+
+            // 4 support points: the test, the squared radius and the center.
+            BSPrecision const add11 = mul2 + mul2 + mul2;
+            BSPrecision const add12 = add11 + add11;
+            BSPrecision const mul6 = add2 * add1;
+            BSPrecision const add13 = mul6 + mul6 + mul6;
+            BSPrecision const mul7 = add0 * add13;
+            BSPrecision const add14 = mul7 + mul7 + mul7;
+            BSPrecision const add15 = add12 * add2 - (add14 + add14);
+            BSPrecision const mul8 = add13 * add13;
+            BSPrecision const add16 = (mul8 + mul8 + mul8) - add12 * add12;
+            BSPrecision const add17 = u * add12 + add13 - add12;
+
+            int const words3 = std::max(std::max(add8.GetMaxWords(true),
+                add9.GetMaxWords(true)), add10.GetMaxWords(true));
+            int const words4 = std::max(std::max(add15.GetMaxWords(true),
+                add16.GetMaxWords(true)), add17.GetMaxWords(true));
+            return std::max(words3, words4);
+        }
+
+        // The BSNumber and BSRational types with the minimal N for the
+        // predicates.
+        template <typename T>
+        using ToLineNumber = BSNumber<UIntegerFP32<ToLine<T>(true)>>;
+
+        template <typename T>
+        using ToLineRational = BSRational<UIntegerFP32<ToLine<T>(false)>>;
+
+        template <typename T>
+        using ToCircumcircleNumber = BSNumber<UIntegerFP32<ToCircumcircle<T>(true)>>;
+
+        template <typename T>
+        using ToCircumcircleRational = BSRational<UIntegerFP32<ToCircumcircle<T>(false)>>;
+
+        template <typename T>
+        using ToPlaneNumber = BSNumber<UIntegerFP32<ToPlane<T>(true)>>;
+
+        template <typename T>
+        using ToPlaneRational = BSRational<UIntegerFP32<ToPlane<T>(false)>>;
+
+        template <typename T>
+        using ToCircumsphereNumber = BSNumber<UIntegerFP32<ToCircumsphere<T>(true)>>;
+
+        template <typename T>
+        using ToCircumsphereRational = BSRational<UIntegerFP32<ToCircumsphere<T>(false)>>;
+
+        template <typename T>
+        using MinimumAreaBox2Rational = BSRational<UIntegerFP32<MinimumAreaBox2<T>()>>;
+
+        template <typename T>
+        using Circumcircle2Number = BSNumber<UIntegerFP32<Circumcircle2<T>()>>;
+
+        template <typename T>
+        using MinimumVolumeSphere3Number = BSNumber<UIntegerFP32<MinimumVolumeSphere3<T>()>>;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.07.21
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -595,6 +595,189 @@ namespace gte
     };
 
 
+    // Support for the fast path of Convert(BSRational,precision,...). The
+    // functions are not intended to be called by applications.
+    class BSRationalConvert
+    {
+    public:
+        // Get the leading 64 bits of |x| = prefix * 2^exponent + tail, where
+        // the leading bit of 'prefix' is at index 63. The return value is
+        // 'true' when the tail is nonzero. The integer part of a BSNumber
+        // is odd, so the tail is nonzero if and only if the number has more
+        // than 64 bits.
+        template <typename UInteger>
+        static bool GetPrefix(BSNumber<UInteger> const& x, uint64_t& prefix, int32_t& exponent)
+        {
+            UInteger const& u = x.GetUInteger();
+            int32_t const numBits = u.GetNumBits();
+            auto const& bits = u.GetBits();
+            int32_t const size = u.GetSize();
+            uint64_t value = bits[size - 1];
+            if (size >= 2)
+            {
+                value = (value << 32) | bits[size - 2];
+            }
+            int32_t numValueBits = numBits - 32 * (size - std::min(size, 2));
+            prefix = (value << (64 - numValueBits));
+            if (size >= 3 && numValueBits < 64)
+            {
+                prefix |= (static_cast<uint64_t>(bits[size - 3]) >> (numValueBits - 32));
+            }
+            exponent = x.GetBiasedExponent() + numBits - 64;
+            return numBits > 64;
+        }
+
+        // Compute floor(n*2^{63}/d) when 'ceiling' is 'false' or
+        // ceil(n*2^{63}/d) when 'ceiling' is 'true'. The numerator is
+        // formally nHigh*2^{64} + n, where nHigh is 0 or 1. The return value
+        // is 'false' when the quotient does not fit in 64 bits.
+        static bool Divide(uint64_t nHigh, uint64_t n, uint64_t d, bool ceiling, uint64_t& quotient)
+        {
+            // The 128-bit numerator is (hi,lo).
+            uint64_t hi = (nHigh << 63) | (n >> 1);
+            uint64_t lo = (n << 63);
+            if (hi >= d)
+            {
+                return false;
+            }
+
+#if defined(GTE_UINTEGERALU32_USE_INT128)
+            unsigned __int128 numer = (static_cast<unsigned __int128>(hi) << 64) | lo;
+            quotient = static_cast<uint64_t>(numer / d);
+            bool remainder = (numer % d) != 0;
+#else
+            // Restoring division, one quotient bit per iteration. The
+            // partial remainder r is less than d, so 2*r + 1 might exceed
+            // 64 bits; the bit shifted out of r is tracked in 'carry'.
+            uint64_t r = hi;
+            quotient = 0;
+            for (int32_t i = 63; i >= 0; --i)
+            {
+                uint64_t carry = (r >> 63);
+                r = (r << 1) | ((lo >> i) & 1);
+                quotient <<= 1;
+                if (carry != 0 || r >= d)
+                {
+                    r -= d;
+                    quotient |= 1;
+                }
+            }
+            bool remainder = (r != 0);
+#endif
+            if (ceiling && remainder)
+            {
+                if (quotient == std::numeric_limits<uint64_t>::max())
+                {
+                    return false;
+                }
+                ++quotient;
+            }
+            return true;
+        }
+
+        // Round the positive q to 'precision' bits using the rounding mode
+        // applied to sign*q. The rounded value is m*2^shift, where m is odd.
+        static void Round(uint64_t q, int32_t precision, int32_t roundingMode,
+            int32_t sign, uint64_t& m, int32_t& shift)
+        {
+            int32_t const numBits = BitHacks::GetLeadingBit(q) + 1;
+            shift = numBits - precision;
+            m = (q >> shift);
+            uint64_t const remainder = q & ((1ull << shift) - 1);
+            uint64_t const half = (1ull << (shift - 1));
+            bool roundUp;
+            if (roundingMode == FE_TONEAREST)
+            {
+                roundUp = (remainder > half || (remainder == half && (m & 1) != 0));
+            }
+            else if (roundingMode == FE_UPWARD)
+            {
+                roundUp = (remainder > 0 && sign > 0);
+            }
+            else if (roundingMode == FE_DOWNWARD)
+            {
+                roundUp = (remainder > 0 && sign < 0);
+            }
+            else
+            {
+                roundUp = false;
+            }
+
+            if (roundUp)
+            {
+                ++m;
+            }
+            int32_t const trailing = BitHacks::GetTrailingBit(m);
+            m >>= trailing;
+            shift += trailing;
+        }
+
+        // Convert n/d to 'precision' bits, 1 <= precision <= 62, using only
+        // the leading 64 bits of n and d. The quotient is bounded by an
+        // interval computed from the prefixes. Rounding is monotonic, so
+        // when both interval endpoints round to the same number, that number
+        // is the correctly rounded quotient. The return value is 'false'
+        // when the endpoints round differently, which for 'double' occurs
+        // with probability about 2^{-9}, or for the rounding modes that are
+        // not supported by Convert(BSRational,precision,...).
+        template <typename UInteger>
+        static bool ConvertUsingPrefixes(BSRational<UInteger> const& input,
+            int32_t precision, int32_t roundingMode, BSNumber<UInteger>& output)
+        {
+            if (roundingMode != FE_TONEAREST && roundingMode != FE_UPWARD &&
+                roundingMode != FE_DOWNWARD && roundingMode != FE_TOWARDZERO)
+            {
+                return false;
+            }
+
+            uint64_t nPrefix, dPrefix;
+            int32_t nExponent, dExponent;
+            uint64_t const nTail = (GetPrefix(input.GetNumerator(), nPrefix, nExponent) ? 1 : 0);
+            uint64_t const dTail = (GetPrefix(input.GetDenominator(), dPrefix, dExponent) ? 1 : 0);
+
+            // The quotient is in [nPrefix/(dPrefix+dTail), (nPrefix+nTail)/dPrefix]
+            // times 2^{nExponent-dExponent}. The lower bound is computed
+            // with divisor 2^{64} when dPrefix+dTail overflows.
+            uint64_t qMin, qMax;
+            if (dTail == 0 || dPrefix != std::numeric_limits<uint64_t>::max())
+            {
+                if (!Divide(0, nPrefix, dPrefix + dTail, false, qMin))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                qMin = (nPrefix >> 1);
+            }
+
+            uint64_t const nMax = nPrefix + nTail;
+            uint64_t const nMaxHigh = (nMax < nPrefix ? 1 : 0);
+            if (!Divide(nMaxHigh, nMax, dPrefix, true, qMax))
+            {
+                return false;
+            }
+
+            int32_t const sign = input.GetSign();
+            uint64_t mMin, mMax;
+            int32_t shiftMin, shiftMax;
+            Round(qMin, precision, roundingMode, sign, mMin, shiftMin);
+            Round(qMax, precision, roundingMode, sign, mMax, shiftMax);
+            if (mMin != mMax || shiftMin != shiftMax)
+            {
+                return false;
+            }
+
+            output = BSNumber<UInteger>(mMin);
+            output.SetSign(sign);
+            output.SetBiasedExponent(shiftMin + nExponent - dExponent - 63);
+#if defined(GTE_BINARY_SCIENTIFIC_SHOW_DOUBLE)
+            output.mValue = (double)output;
+#endif
+            return true;
+        }
+    };
+
     // Explicit conversion to a user-specified precision. The rounding
     // mode is one of the flags provided in <cfenv>. The modes are
     //   FE_TONEAREST:  round to nearest ties to even
@@ -623,6 +806,16 @@ namespace gte
             return;
         }
 
+        // The conversions to 'float' and 'double' are the common case. For
+        // them, the leading 64 bits of the numerator and denominator almost
+        // always determine the result, which avoids the bit-by-bit division
+        // that follows.
+        if (precision <= 62 && BSRationalConvert::ConvertUsingPrefixes(
+            input, precision, roundingMode, output))
+        {
+            return;
+        }
+
         BSNumber<UInteger> n = input.GetNumerator();
         BSNumber<UInteger> d = input.GetDenominator();
 
@@ -3,12 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/BasisFunction.h>
 #include <Mathematics/ParametricCurve.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <vector>
 
 namespace gte
 {
@@ -73,6 +76,7 @@ namespace gte
             if (0 <= i && i < GetNumControls())
             {
                 mControls[i] = control;
+                this->InvalidateArcLengthTable();
             }
         }
 
@@ -108,30 +112,75 @@ namespace gte
                 return;
             }
 
-            int imin, imax;
-            mBasisFunction.Evaluate(t, order, imin, imax);
+            // The basis function values are stored per thread, so the
+            // function can be called concurrently.
+            thread_local BasisFunctionValues<Real> values;
+            mBasisFunction.Evaluate(t, order, values);
+            int imin = values.minIndex, imax = values.maxIndex;
 
             // Compute position.
-            jet[0] = Compute(0, imin, imax);
+            jet[0] = Compute(values, 0, imin, imax);
             if (order >= 1)
             {
                 // Compute first derivative.
-                jet[1] = Compute(1, imin, imax);
+                jet[1] = Compute(values, 1, imin, imax);
                 if (order >= 2)
                 {
                     // Compute second derivative.
-                    jet[2] = Compute(2, imin, imax);
+                    jet[2] = Compute(values, 2, imin, imax);
                     if (order == 3)
                     {
-                        jet[3] = Compute(3, imin, imax);
+                        jet[3] = Compute(values, 3, imin, imax);
                     }
                 }
             }
         }
 
+        // Evaluate the curve and its derivatives through the specified order
+        // at numTimes times. The output 'jets' must have
+        // numTimes * (order + 1) elements, and jets[(order + 1) * m + k] is
+        // the derivative of order k at times[m]; the values are the same as
+        // those of Evaluate(...). Like Evaluate(...), the function may be
+        // called concurrently for the same curve. The knot span of a time is
+        // searched starting at the span of the previous time, so sorted times
+        // are the most efficient. The times are partitioned among the threads
+        // of an optional TaskScheduler.
+        void EvaluateBatch(size_t numTimes, Real const* times, unsigned int order,
+            Vector<N, Real>* jets, TaskScheduler* scheduler = nullptr) const
+        {
+            LogAssert(order < static_cast<unsigned int>(ParametricCurve<N, Real>::SUP_ORDER),
+                "Invalid order.");
+
+            size_t numChunks = 1;
+            if (scheduler != nullptr)
+            {
+                numChunks = std::max(std::min(numTimes,
+                    static_cast<size_t>(scheduler->GetNumThreads())), static_cast<size_t>(1));
+            }
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numTimes, times, order, jets, numChunks](size_t chunk)
+                {
+                    BasisFunctionValues<Real> values;
+                    size_t const first = numTimes * chunk / numChunks;
+                    size_t const last = numTimes * (chunk + 1) / numChunks;
+                    for (size_t m = first; m < last; ++m)
+                    {
+                        mBasisFunction.Evaluate(times[m], order, values);
+                        int imin = values.minIndex, imax = values.maxIndex;
+                        Vector<N, Real>* jet = jets + (order + 1) * m;
+                        for (unsigned int k = 0; k <= order; ++k)
+                        {
+                            jet[k] = Compute(values, k, imin, imax);
+                        }
+                    }
+                });
+        }
+
     private:
         // Support for Evaluate(...).
-        Vector<N, Real> Compute(unsigned int order, int imin, int imax) const
+        Vector<N, Real> Compute(BasisFunctionValues<Real> const& values,
+            unsigned int order, int imin, int imax) const
         {
             // The j-index introduces a tiny amount of overhead in order to handle
             // both aperiodic and periodic splines.  For aperiodic splines, j = i
@@ -142,7 +191,7 @@ namespace gte
             result.MakeZero();
             for (int i = imin; i <= imax; ++i)
             {
-                Real tmp = mBasisFunction.GetValue(order, i);
+                Real tmp = values.Get(order, i);
                 int j = (i >= numControls ? i - numControls : i);
                 result += tmp * mControls[j];
             }
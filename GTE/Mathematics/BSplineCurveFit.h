@@ -3,12 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/BasisFunction.h>
 #include <Mathematics/BandedMatrix.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
 
 // The algorithm implemented here is based on the document
 // https://www.geometrictools.com/Documentation/BSplineCurveLeastSquaresFit.pdf
@@ -19,12 +24,25 @@ namespace gte
     class BSplineCurveFit
     {
     public:
+        // The function for out-of-core fitting. It must store the samples
+        // first through first+count-1 as contiguous blocks of 'dimension'
+        // real values in samples[], which has count*dimension elements.
+        typedef std::function<void(int first, int count, Real* samples)> SampleFunction;
+
         // Construction.  The preconditions for calling the constructor are
         //   1 <= degree && degree < numControls <= numSamples
         // The samples points are contiguous blocks of 'dimension' real values
         // stored in sampleData.
+        //
+        // The normal equations are accumulated in a single pass over the
+        // samples, which costs O(numSamples*(degree+1)^2) time and
+        // O(numControls*(degree+dimension)) memory. When a task scheduler is
+        // passed, the rows of the normal equations are partitioned among
+        // its threads, each thread visiting the samples that influence its
+        // rows. The sums are in sample order for any number of threads, so
+        // the results do not depend on the scheduler.
         BSplineCurveFit(int dimension, int numSamples, Real const* sampleData,
-            int degree, int numControls)
+            int degree, int numControls, TaskScheduler* scheduler = nullptr)
             :
             mDimension(dimension),
             mNumSamples(numSamples),
@@ -33,128 +51,34 @@ namespace gte
             mNumControls(numControls),
             mControlData(dimension * numControls)
         {
-            LogAssert(dimension >= 1, "Invalid dimension.");
-            LogAssert(1 <= degree && degree < numControls, "Invalid degree.");
             LogAssert(sampleData, "Invalid sample data.");
-            LogAssert(numControls <= numSamples, "Invalid number of controls.");
-
-            BasisFunctionInput<Real> input;
-            input.numControls = numControls;
-            input.degree = degree;
-            input.uniform = true;
-            input.periodic = false;
-            input.numUniqueKnots = numControls - degree + 1;
-            input.uniqueKnots.resize(input.numUniqueKnots);
-            input.uniqueKnots[0].t = (Real)0;
-            input.uniqueKnots[0].multiplicity = degree + 1;
-            int last = input.numUniqueKnots - 1;
-            Real factor = ((Real)1) / (Real)last;
-            for (int i = 1; i < last; ++i)
-            {
-                input.uniqueKnots[i].t = factor * (Real)i;
-                input.uniqueKnots[i].multiplicity = 1;
-            }
-            input.uniqueKnots[last].t = (Real)1;
-            input.uniqueKnots[last].multiplicity = degree + 1;
-            mBasis.Create(input);
-
-            // Fit the data points with a B-spline curve using a least-squares
-            // error metric.  The problem is of the form A^T*A*Q = A^T*P,
-            // where A^T*A is a banded matrix, P contains the sample data, and
-            // Q is the unknown vector of control points.
-            Real tMultiplier = ((Real)1) / (Real)(mNumSamples - 1);
-            Real t;
-            int i0, i1, i2, imin, imax, j;
-
-            // Construct the matrix A^T*A.
-            int degp1 = mDegree + 1;
-            int numBands = (mNumControls > degp1 ? degp1 : mDegree);
-            BandedMatrix<Real> ATAMat(mNumControls, numBands, numBands);
-            for (i0 = 0; i0 < mNumControls; ++i0)
-            {
-                for (i1 = 0; i1 < i0; ++i1)
-                {
-                    ATAMat(i0, i1) = ATAMat(i1, i0);
-                }
-
-                int i1Max = i0 + mDegree;
-                if (i1Max >= mNumControls)
-                {
-                    i1Max = mNumControls - 1;
-                }
-
-                for (i1 = i0; i1 <= i1Max; ++i1)
-                {
-                    Real value = (Real)0;
-                    for (i2 = 0; i2 < mNumSamples; ++i2)
-                    {
-                        t = tMultiplier * (Real)i2;
-                        mBasis.Evaluate(t, 0, imin, imax);
-                        if (imin <= i0 && i0 <= imax && imin <= i1 && i1 <= imax)
-                        {
-                            Real b0 = mBasis.GetValue(0, i0);
-                            Real b1 = mBasis.GetValue(0, i1);
-                            value += b0 * b1;
-                        }
-                    }
-                    ATAMat(i0, i1) = value;
-                }
-            }
-
-            // Construct the matrix A^T.
-            Array2<Real> ATMat(mNumSamples, mNumControls);
-            std::memset(ATMat[0], 0, mNumControls * mNumSamples * sizeof(Real));
-            for (i0 = 0; i0 < mNumControls; ++i0)
-            {
-                for (i1 = 0; i1 < mNumSamples; ++i1)
-                {
-                    t = tMultiplier * (Real)i1;
-                    mBasis.Evaluate(t, 0, imin, imax);
-                    if (imin <= i0 && i0 <= imax)
-                    {
-                        ATMat[i0][i1] = mBasis.GetValue(0, i0);
-                    }
-                }
-            }
-
-            // Compute X0 = (A^T*A)^{-1}*A^T by solving the linear system
-            // A^T*A*X = A^T.
-            bool solved = ATAMat.template SolveSystem<true>(ATMat[0], mNumSamples);
-            LogAssert(solved, "Failed to solve linear system.");
-
-            // The control points for the fitted curve are stored in the
-            // vector Q = X0*P, where P is the vector of sample data.
-            std::fill(mControlData.begin(), mControlData.end(), (Real)0);
-            for (i0 = 0; i0 < mNumControls; ++i0)
-            {
-                Real* Q = &mControlData[i0 * mDimension];
-                for (i1 = 0; i1 < mNumSamples; ++i1)
-                {
-                    Real const* P = mSampleData + i1 * mDimension;
-                    Real xValue = ATMat[i0][i1];
-                    for (j = 0; j < mDimension; ++j)
-                    {
-                        Q[j] += xValue * P[j];
-                    }
-                }
-            }
+            Fit(nullptr, scheduler);
+        }
 
-            // Set the first and last output control points to match the first
-            // and last input samples.  This supports the application of
-            // fitting keyframe data with B-spline curves.  The user expects
-            // that the curve passes through the first and last positions in
-            // order to support matching two consecutive keyframe sequences.
-            Real* cEnd0 = &mControlData[0];
-            Real const* sEnd0 = mSampleData;
-            Real* cEnd1 = &mControlData[mDimension * (mNumControls - 1)];
-            Real const* sEnd1 = &mSampleData[mDimension * (mNumSamples - 1)];
-            for (j = 0; j < mDimension; ++j)
-            {
-                *cEnd0++ = *sEnd0++;
-                *cEnd1++ = *sEnd1++;
-            }
+        // Construction for samples that are not in memory, for example,
+        // samples that are read from a file. The sample function is called
+        // for consecutive blocks of at most BLOCK_SIZE samples. When a task
+        // scheduler is passed, the function is called concurrently by the
+        // threads of the scheduler, so it must be thread-safe; the samples
+        // near the boundaries of the partition of the controls are
+        // requested by two threads. GetSampleData() returns null for a
+        // curve constructed this way.
+        BSplineCurveFit(int dimension, int numSamples, SampleFunction const& sampleFunction,
+            int degree, int numControls, TaskScheduler* scheduler = nullptr)
+            :
+            mDimension(dimension),
+            mNumSamples(numSamples),
+            mSampleData(nullptr),
+            mDegree(degree),
+            mNumControls(numControls),
+            mControlData(dimension * numControls)
+        {
+            LogAssert(sampleFunction, "Invalid sample function.");
+            Fit(&sampleFunction, scheduler);
         }
 
+        enum { BLOCK_SIZE = 4096 };
+
         // Access to input sample information.
         inline int GetDimension() const
         {
@@ -166,6 +90,7 @@ namespace gte
             return mNumSamples;
         }
 
+        // The sample data is null when the out-of-core constructor is used.
         inline Real const* GetSampleData() const
         {
             return mSampleData;
@@ -224,6 +149,141 @@ namespace gte
         }
 
     private:
+        void Fit(SampleFunction const* sampleFunction, TaskScheduler* scheduler)
+        {
+            LogAssert(mDimension >= 1, "Invalid dimension.");
+            LogAssert(1 <= mDegree && mDegree < mNumControls, "Invalid degree.");
+            LogAssert(mNumControls <= mNumSamples, "Invalid number of controls.");
+
+            BasisFunctionInput<Real> input;
+            input.numControls = mNumControls;
+            input.degree = mDegree;
+            input.uniform = true;
+            input.periodic = false;
+            input.numUniqueKnots = mNumControls - mDegree + 1;
+            input.uniqueKnots.resize(input.numUniqueKnots);
+            input.uniqueKnots[0].t = (Real)0;
+            input.uniqueKnots[0].multiplicity = mDegree + 1;
+            int last = input.numUniqueKnots - 1;
+            Real factor = ((Real)1) / (Real)last;
+            for (int i = 1; i < last; ++i)
+            {
+                input.uniqueKnots[i].t = factor * (Real)i;
+                input.uniqueKnots[i].multiplicity = 1;
+            }
+            input.uniqueKnots[last].t = (Real)1;
+            input.uniqueKnots[last].multiplicity = mDegree + 1;
+            mBasis.Create(input);
+
+            // Fit the data points with a B-spline curve using a least-squares
+            // error metric.  The problem is of the form A^T*A*Q = A^T*P,
+            // where A^T*A is a banded matrix, P contains the sample data, and
+            // Q is the unknown vector of control points.  Row i0 of A^T*A
+            // and of A^T*P is a sum over the samples whose times are in the
+            // support [knot[i0],knot[i0+degree+1]] of basis function i0.
+            Real const tMultiplier = ((Real)1) / (Real)(mNumSamples - 1);
+            Real const* knots = mBasis.GetKnots();
+            int degp1 = mDegree + 1;
+            int numBands = (mNumControls > degp1 ? degp1 : mDegree);
+            BandedMatrix<Real> ATAMat(mNumControls, numBands, numBands);
+            std::fill(mControlData.begin(), mControlData.end(), (Real)0);
+
+            size_t numChunks = 1;
+            if (scheduler != nullptr)
+            {
+                numChunks = std::max(std::min(static_cast<size_t>(mNumControls),
+                    static_cast<size_t>(scheduler->GetNumThreads())), static_cast<size_t>(1));
+            }
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, sampleFunction, numChunks, tMultiplier, knots, &ATAMat](size_t chunk)
+                {
+                    // Accumulate the rows c0 <= i0 < c1 of the upper
+                    // triangle of A^T*A and of A^T*P, where the latter is
+                    // stored in mControlData.
+                    int const c0 = static_cast<int>(mNumControls * chunk / numChunks);
+                    int const c1 = static_cast<int>(mNumControls * (chunk + 1) / numChunks);
+                    Real const scale = (Real)(mNumSamples - 1);
+                    int const jmin = std::max(static_cast<int>(std::floor(scale * knots[c0])) - 1, 0);
+                    int const jmax = std::min(static_cast<int>(std::ceil(scale * knots[c1 + mDegree])) + 1,
+                        mNumSamples - 1);
+
+                    BasisFunctionValues<Real> values;
+                    std::vector<Real> block;
+                    for (int first = jmin; first <= jmax; first += BLOCK_SIZE)
+                    {
+                        int const count = std::min(static_cast<int>(BLOCK_SIZE), jmax - first + 1);
+                        Real const* P;
+                        if (sampleFunction)
+                        {
+                            block.resize(static_cast<size_t>(count) * mDimension);
+                            (*sampleFunction)(first, count, block.data());
+                            P = block.data();
+                        }
+                        else
+                        {
+                            P = mSampleData + static_cast<size_t>(first) * mDimension;
+                        }
+
+                        for (int k = 0; k < count; ++k, P += mDimension)
+                        {
+                            mBasis.Evaluate(tMultiplier * (Real)(first + k), 0, values);
+                            int const imin = std::max(values.minIndex, c0);
+                            int const imax = std::min(values.maxIndex, c1 - 1);
+                            for (int i0 = imin; i0 <= imax; ++i0)
+                            {
+                                Real b0 = values.Get(0, i0);
+                                for (int i1 = i0; i1 <= values.maxIndex; ++i1)
+                                {
+                                    ATAMat(i0, i1) += b0 * values.Get(0, i1);
+                                }
+
+                                Real* Q = &mControlData[static_cast<size_t>(i0) * mDimension];
+                                for (int j = 0; j < mDimension; ++j)
+                                {
+                                    Q[j] += b0 * P[j];
+                                }
+                            }
+                        }
+                    }
+                });
+
+            for (int i0 = 1; i0 < mNumControls; ++i0)
+            {
+                for (int i1 = std::max(i0 - mDegree, 0); i1 < i0; ++i1)
+                {
+                    ATAMat(i0, i1) = ATAMat(i1, i0);
+                }
+            }
+
+            // Solve A^T*A*Q = A^T*P for the control points Q.
+            bool solved = ATAMat.template SolveSystem<true>(&mControlData[0], mDimension);
+            LogAssert(solved, "Failed to solve linear system.");
+
+            // Set the first and last output control points to match the first
+            // and last input samples.  This supports the application of
+            // fitting keyframe data with B-spline curves.  The user expects
+            // that the curve passes through the first and last positions in
+            // order to support matching two consecutive keyframe sequences.
+            Real* cEnd0 = &mControlData[0];
+            Real* cEnd1 = &mControlData[mDimension * (mNumControls - 1)];
+            if (sampleFunction)
+            {
+                (*sampleFunction)(0, 1, cEnd0);
+                (*sampleFunction)(mNumSamples - 1, 1, cEnd1);
+            }
+            else
+            {
+                Real const* sEnd0 = mSampleData;
+                Real const* sEnd1 = &mSampleData[mDimension * (mNumSamples - 1)];
+                for (int j = 0; j < mDimension; ++j)
+                {
+                    *cEnd0++ = *sEnd0++;
+                    *cEnd1++ = *sEnd1++;
+                }
+            }
+        }
+
         // Input sample information.
         int mDimension;
         int mNumSamples;
@@ -0,0 +1,517 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/MinHeap.h>
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <vector>
+
+// The BSplineKnotRemoval class reduces an open B-spline curve by removing
+// interior knots, one at a time, while the distance between the reduced
+// curve and the input curve is bounded by a user-specified tolerance. It is
+// an alternative to BSplineReduction, which fits a curve with a prescribed
+// number of control points to the entire input curve. The knot removal is
+// the algorithm of "The NURBS Book" (Piegl and Tiller, 2nd edition,
+// algorithms A5.8 and A9.8) for simple knots.
+//
+// Removing knot u[r] replaces the controls P[r-degree] through P[r-1] by
+// degree-1 controls, which changes the curve only on the interval
+// [u[r-degree],u[r+degree]]. The removal error is the maximum distance
+// between the old controls and the controls obtained by inserting u[r]
+// back into the new curve. By the convex hull property, this is a bound on
+// the distance between the old and new curves. Each knot span stores the
+// sum of the removal errors of the knots removed so far whose intervals
+// contain the span, so it is a bound on the distance between the reduced
+// and input curves on the span. The cost of removing a knot is its error
+// plus the largest bound of the spans it changes, and the knots are stored
+// in a min-heap ordered by cost. Reduce(tolerance) removes the knot of
+// minimum cost until that cost exceeds the tolerance. A removal changes the
+// costs of only the knots within 2*degree positions, so each removal takes
+// O(degree^2 + log(numKnots)) time.
+//
+// SetControl modifies a control point of the input curve. The knots
+// removed near the control are inserted again, which is exact, and the
+// controls of the reduced curve whose support contains the modified
+// control are replaced by input controls. The span bounds are updated
+// locally and a subsequent call to Reduce(tolerance) removes the knots
+// near the edit again. The remainder of the reduced curve is unchanged, so
+// an edit costs O(degree^2 * log(numKnots)) plus the cost of the removals.
+// The span bounds next to an edit mix reduced and input controls; they
+// remain bounds on the distance between the curves but, unlike those
+// produced by Reduce, can be larger than the tolerance.
+//
+// The input curve must be open with interior knots of multiplicity 1. The
+// degree must satisfy 1 <= degree <= controls.size()-1. The degree of the
+// reduced curve is that of the input curve, and the reduced curve has at
+// least degree+1 controls.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class BSplineKnotRemoval
+    {
+    public:
+        // Construction for an input curve with uniform knots, which is the
+        // curve that BSplineReduction accepts.
+        BSplineKnotRemoval(std::vector<Vector<N, Real>> const& controls, int degree)
+            :
+            mDegree(degree),
+            mNumInputControls(static_cast<int>(controls.size()))
+        {
+            LogAssert(mNumInputControls >= 2 && 1 <= degree && degree < mNumInputControls,
+                "Invalid input.");
+
+            int const numKnots = mNumInputControls + mDegree + 1;
+            std::vector<Real> knots(numKnots);
+            Real factor = (Real)1 / static_cast<Real>(mNumInputControls - mDegree);
+            for (int i = 0; i < numKnots; ++i)
+            {
+                int j = std::min(std::max(i - mDegree, 0), mNumInputControls - mDegree);
+                knots[i] = factor * static_cast<Real>(j);
+            }
+            Initialize(controls, knots);
+        }
+
+        // Construction for an input curve with arbitrary knots. The number
+        // of knots must be controls.size()+degree+1. The first degree+1
+        // knots must be equal, the last degree+1 knots must be equal and the
+        // interior knots must be increasing.
+        BSplineKnotRemoval(std::vector<Vector<N, Real>> const& controls, int degree,
+            std::vector<Real> const& knots)
+            :
+            mDegree(degree),
+            mNumInputControls(static_cast<int>(controls.size()))
+        {
+            LogAssert(mNumInputControls >= 2 && 1 <= degree && degree < mNumInputControls,
+                "Invalid input.");
+            LogAssert(static_cast<int>(knots.size()) == mNumInputControls + mDegree + 1,
+                "Invalid number of knots.");
+            Initialize(controls, knots);
+        }
+
+        // Remove knots while the distance between the reduced curve and the
+        // input curve is at most 'tolerance'. The return value is the number
+        // of knots removed by the call.
+        int Reduce(Real tolerance)
+        {
+            int numRemoved = 0;
+            int slot;
+            Real cost;
+            while (mNumControls > mDegree + 1 && mHeap.GetMinimum(slot, cost) && cost <= tolerance)
+            {
+                mHeap.Remove(slot, cost);
+                mRecord[slot] = nullptr;
+                Remove(slot);
+                ++numRemoved;
+            }
+            return numRemoved;
+        }
+
+        // Modify control i of the input curve, 0 <= i < GetNumInputControls().
+        // Call Reduce after one or more modifications.
+        void SetControl(int i, Vector<N, Real> const& control)
+        {
+            LogAssert(0 <= i && i < mNumInputControls, "Invalid index.");
+            int const p = mDegree;
+            int const n = mNumInputControls - 1;
+            mInput[i + mOffset] = control;
+
+            // Insert the removed knots u[i-2*p] through u[i+3*p+1], so the
+            // controls i-2*p through i+2*p of the reduced curve are those of
+            // its representation with the input knots.
+            int const sMin = std::max(p + 1, i - 2 * p);
+            int const sMax = std::min(n, i + 3 * p + 1);
+            for (int s = sMin; s <= sMax; ++s)
+            {
+                if (!mAlive[s])
+                {
+                    Insert(s);
+                }
+            }
+
+            int const jMin = std::max(0, i - 2 * p), jMax = std::min(n, i + 2 * p);
+            std::vector<Vector<N, Real>> reduced(static_cast<size_t>(jMax - jMin) + 1);
+            for (int j = jMin; j <= jMax; ++j)
+            {
+                reduced[j - jMin] = mControl[j + mOffset];
+            }
+
+            // The controls i-p through i+p, whose supports contain a span of
+            // the support of control i, are replaced by input controls. On
+            // the spans of the support of control i, the reduced curve is
+            // then the input curve. On the other spans that the replaced
+            // controls influence, the distance is bounded by the maximum
+            // distance between the controls that were not replaced and the
+            // input controls, and also by the old bound plus the maximum
+            // displacement of the replaced controls.
+            int const rMin = std::max(0, i - p), rMax = std::min(n, i + p);
+            for (int k = std::max(p, i - p); k <= std::min(n, i + 2 * p); ++k)
+            {
+                Real bound = (Real)0;
+                if (k < i || k > i + p)
+                {
+                    Real kept = (Real)0, replaced = (Real)0;
+                    for (int j = std::max(0, k - p); j <= k; ++j)
+                    {
+                        Real distance = Length(reduced[j - jMin] - mInput[j + mOffset]);
+                        if (rMin <= j && j <= rMax)
+                        {
+                            replaced = std::max(replaced, distance);
+                        }
+                        else
+                        {
+                            kept = std::max(kept, distance);
+                        }
+                    }
+                    bound = std::min(kept, mSpanError[k] + replaced);
+                }
+                mSpanError[k] = bound;
+            }
+
+            for (int j = rMin; j <= rMax; ++j)
+            {
+                mControl[j + mOffset] = mInput[j + mOffset];
+            }
+
+            int first = Walk(std::max(0, i - 2 * p), -2 * p);
+            int last = Walk(std::min(n + p + 1, i + 3 * p + 1), 2 * p);
+            for (int t = first; ; t = mNext[t])
+            {
+                UpdateCost(t);
+                if (t == last)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Access to the input curve.
+        inline int GetDegree() const
+        {
+            return mDegree;
+        }
+
+        inline int GetNumInputControls() const
+        {
+            return mNumInputControls;
+        }
+
+        inline Vector<N, Real> const& GetInputControl(int i) const
+        {
+            return mInput[i + mOffset];
+        }
+
+        // Access to the reduced curve. GetControls and GetKnots take time
+        // linear in the number of input controls.
+        inline int GetNumControls() const
+        {
+            return mNumControls;
+        }
+
+        void GetControls(std::vector<Vector<N, Real>>& controls) const
+        {
+            controls.resize(mNumControls);
+            int slot = Walk(0, mOffset);
+            for (int i = 0; i < mNumControls; ++i, slot = mNext[slot])
+            {
+                controls[i] = mControl[slot];
+            }
+        }
+
+        void GetKnots(std::vector<Real>& knots) const
+        {
+            knots.resize(static_cast<size_t>(mNumControls) + mDegree + 1);
+            int slot = 0;
+            for (auto& knot : knots)
+            {
+                knot = mKnot[slot];
+                slot = mNext[slot];
+            }
+        }
+
+        // The maximum of the bounds on the distance between the reduced
+        // curve and the input curve.
+        Real GetMaxError() const
+        {
+            Real maxError = (Real)0;
+            for (int slot = 0; slot >= 0; slot = mNext[slot])
+            {
+                maxError = std::max(maxError, mSpanError[slot]);
+            }
+            return maxError;
+        }
+
+    private:
+        // The knots are stored in slots indexed by their input indices. The
+        // slots of the knots of the reduced curve are in a doubly linked
+        // list. Control j of a curve is stored in the slot of knot
+        // j+mOffset, which is invariant under knot removal and insertion:
+        // removing u[r] removes control r-mOffset.
+        void Initialize(std::vector<Vector<N, Real>> const& controls, std::vector<Real> const& knots)
+        {
+            int const p = mDegree;
+            int const n = mNumInputControls - 1;
+            int const numSlots = n + p + 2;
+            for (int k = 0; k < p; ++k)
+            {
+                LogAssert(knots[k] == knots[k + 1] && knots[n + 1 + k] == knots[n + 2 + k],
+                    "The curve must be open.");
+            }
+            for (int k = p; k <= n; ++k)
+            {
+                LogAssert(knots[k] < knots[k + 1], "Interior knots must be increasing.");
+            }
+
+            mOffset = p / 2 + 1;
+            mNumControls = mNumInputControls;
+            mKnot = knots;
+            mControl.resize(numSlots);
+            for (int j = 0; j <= n; ++j)
+            {
+                mControl[j + mOffset] = controls[j];
+            }
+            mInput = mControl;
+
+            mPrev.resize(numSlots);
+            mNext.resize(numSlots);
+            for (int s = 0; s < numSlots; ++s)
+            {
+                mPrev[s] = s - 1;
+                mNext[s] = s + 1;
+            }
+            mNext[numSlots - 1] = -1;
+            mAlive.assign(numSlots, true);
+            mSpanError.assign(numSlots, (Real)0);
+            mScratch.resize(2 * static_cast<size_t>(p) + 1);
+            mNewControls.resize(static_cast<size_t>(p) + 1);
+
+            mHeap.Reset(std::max(n - p, 1));
+            mRecord.assign(numSlots, nullptr);
+            for (int s = p + 1; s <= n; ++s)
+            {
+                UpdateCost(s);
+            }
+        }
+
+        // Return the slot 'steps' positions after (steps > 0) or before
+        // (steps < 0) the alive slot s, clamped to the first and last slots.
+        int Walk(int s, int steps) const
+        {
+            for (; steps > 0 && mNext[s] >= 0; --steps)
+            {
+                s = mNext[s];
+            }
+            for (; steps < 0 && mPrev[s] >= 0; ++steps)
+            {
+                s = mPrev[s];
+            }
+            return s;
+        }
+
+        // Store in mScratch[k+p] the slot k positions from slot s for
+        // -p <= k <= p.
+        void GatherWindow(int s)
+        {
+            int const p = mDegree;
+            mScratch[p] = s;
+            for (int k = 1; k <= p; ++k)
+            {
+                mScratch[p - k] = mPrev[mScratch[p - k + 1]];
+                mScratch[p + k] = mNext[mScratch[p + k - 1]];
+            }
+        }
+
+        // Compute the controls P'[r-p-1] through P'[r-1] of the curve
+        // without knot u[r], stored in mNewControls[0] through
+        // mNewControls[p], and return the removal error. The input is the
+        // window of slot s gathered by GatherWindow(s).
+        Real ComputeRemoval()
+        {
+            int const p = mDegree;
+            int const h = p / 2;
+            auto knot = [this, p](int k) { return mKnot[mScratch[k + p]]; };
+            auto control = [this, p](int q) -> Vector<N, Real> const&
+            {
+                return mControl[mScratch[q + mOffset + p]];
+            };
+            auto newControl = [this, p](int q) -> Vector<N, Real>&
+            {
+                return mNewControls[q + p + 1];
+            };
+            Real const u = knot(0);
+
+            // Solve P[i] = alpha[i]*P'[i] + (1-alpha[i])*P'[i-1] from both
+            // ends of the changed controls. For even degree the middle
+            // control is computed from both ends and the average is used.
+            newControl(-p - 1) = control(-p - 1);
+            newControl(-1) = control(0);
+            for (int i = -p; i < -p + h; ++i)
+            {
+                Real alpha = (u - knot(i)) / (knot(i + p + 1) - knot(i));
+                newControl(i) = (control(i) - ((Real)1 - alpha) * newControl(i - 1)) / alpha;
+            }
+            Vector<N, Real> right = control(0);
+            for (int j = -1; j > -1 - h; --j)
+            {
+                Real alpha = (u - knot(j)) / (knot(j + p + 1) - knot(j));
+                right = (control(j) - alpha * right) / ((Real)1 - alpha);
+                if (j - 1 >= -p + h)
+                {
+                    newControl(j - 1) = right;
+                }
+                else
+                {
+                    newControl(j - 1) = (Real)0.5 * (newControl(j - 1) + right);
+                }
+            }
+
+            // Insert u[r] into the new curve and compare the controls.
+            Real error = (Real)0;
+            for (int i = -p; i <= -1; ++i)
+            {
+                Real alpha = (u - knot(i)) / (knot(i + p + 1) - knot(i));
+                Vector<N, Real> inserted = alpha * newControl(i) + ((Real)1 - alpha) * newControl(i - 1);
+                error = std::max(error, Length(control(i) - inserted));
+            }
+            return error;
+        }
+
+        void UpdateCost(int s)
+        {
+            int const p = mDegree;
+            if (s <= p || s >= mNumInputControls || !mAlive[s])
+            {
+                return;
+            }
+
+            GatherWindow(s);
+            Real cost = ComputeRemoval();
+            Real spanError = (Real)0;
+            for (int k = 0; k < 2 * p; ++k)
+            {
+                spanError = std::max(spanError, mSpanError[mScratch[k]]);
+            }
+            cost += spanError;
+
+            if (mRecord[s])
+            {
+                mHeap.Update(mRecord[s], cost);
+            }
+            else
+            {
+                mRecord[s] = mHeap.Insert(s, cost);
+            }
+        }
+
+        // Remove the knot in slot s.
+        void Remove(int s)
+        {
+            int const p = mDegree;
+            GatherWindow(s);
+            Real error = ComputeRemoval();
+
+            // Store P'[r-p] through P'[r-2]; P'[r-1] = P[r] is already in
+            // place.
+            for (int q = -p; q <= -2; ++q)
+            {
+                int d = q + mOffset;
+                if (d >= 0)
+                {
+                    ++d;
+                }
+                mControl[mScratch[d + p]] = mNewControls[q + p + 1];
+            }
+
+            int prev = mPrev[s], next = mNext[s];
+            mNext[prev] = next;
+            mPrev[next] = prev;
+            mAlive[s] = false;
+            mSpanError[prev] = std::max(mSpanError[prev], mSpanError[s]);
+            for (int k = 0; k < 2 * p; ++k)
+            {
+                if (k != p)
+                {
+                    mSpanError[mScratch[k]] += error;
+                }
+            }
+            --mNumControls;
+
+            int first = Walk(prev, 1 - 2 * p);
+            int last = Walk(next, 2 * p - 1);
+            for (int t = first; ; t = mNext[t])
+            {
+                UpdateCost(t);
+                if (t == last)
+                {
+                    break;
+                }
+            }
+        }
+
+        // Insert the knot of slot s, which was removed, by Boehm's
+        // algorithm. The curve is unchanged.
+        void Insert(int s)
+        {
+            int const p = mDegree;
+            int a = s - 1;
+            while (!mAlive[a])
+            {
+                --a;
+            }
+
+            // The window of a, whose knot has index r-1 where r is the index
+            // of the inserted knot. Compute the controls Q[r-p] through
+            // Q[r-1] of the refined curve.
+            GatherWindow(a);
+            Real const u = mKnot[s];
+            for (int x = -p; x <= -1; ++x)
+            {
+                Real u0 = mKnot[mScratch[x + 1 + p]];
+                Real u1 = mKnot[mScratch[x + p + 1 + p]];
+                Real alpha = (u - u0) / (u1 - u0);
+                mNewControls[x + p] = alpha * mControl[mScratch[x + mOffset + 1 + p]] +
+                    ((Real)1 - alpha) * mControl[mScratch[x + mOffset + p]];
+            }
+
+            int b = mNext[a];
+            mNext[a] = s;
+            mPrev[s] = a;
+            mNext[s] = b;
+            mPrev[b] = s;
+            mAlive[s] = true;
+            mSpanError[s] = mSpanError[a];
+            ++mNumControls;
+
+            // Q[i] belongs in the slot offset i-r+mOffset from s.
+            for (int x = -p; x <= -1; ++x)
+            {
+                int d = x + mOffset;
+                int slot = (d < 0 ? mScratch[d + 1 + p] : (d == 0 ? s : mScratch[d + p]));
+                mControl[slot] = mNewControls[x + p];
+            }
+        }
+
+        int mDegree, mNumInputControls, mNumControls, mOffset;
+        std::vector<Real> mKnot;
+        std::vector<Vector<N, Real>> mControl, mInput;
+        std::vector<int> mPrev, mNext;
+        std::vector<bool> mAlive;
+
+        // The bound on the distance between the curves on the span that
+        // starts at an alive slot.
+        std::vector<Real> mSpanError;
+
+        MinHeap<int, Real> mHeap;
+        std::vector<typename MinHeap<int, Real>::Record*> mRecord;
+
+        std::vector<int> mScratch;
+        std::vector<Vector<N, Real>> mNewControls;
+    };
+}
@@ -21,7 +21,9 @@
 // The intended use for this class is to take an open B-spline curve,
 // defined by its control points and degree, and reducing the number of
 // control points dramatically to obtain another curve that is close to
-// the original one.
+// the original one.  To reduce a curve until it is within a distance
+// tolerance of the original one, or to update a reduction after the
+// original curve is modified, see BSplineKnotRemoval.h.
 
 namespace gte
 {
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -118,30 +118,35 @@ namespace gte
                 return;
             }
 
-            int iumin, iumax, ivmin, ivmax;
-            mBasisFunction[0].Evaluate(u, order, iumin, iumax);
-            mBasisFunction[1].Evaluate(v, order, ivmin, ivmax);
+            // The basis function values are stored per thread, so the
+            // function can be called concurrently.
+            thread_local std::array<BasisFunctionValues<Real>, 2> values;
+            mBasisFunction[0].Evaluate(u, order, values[0]);
+            mBasisFunction[1].Evaluate(v, order, values[1]);
+            int iumin = values[0].minIndex, iumax = values[0].maxIndex;
+            int ivmin = values[1].minIndex, ivmax = values[1].maxIndex;
 
             // Compute position.
-            jet[0] = Compute(0, 0, iumin, iumax, ivmin, ivmax);
+            jet[0] = Compute(values, 0, 0, iumin, iumax, ivmin, ivmax);
             if (order >= 1)
             {
                 // Compute first-order derivatives.
-                jet[1] = Compute(1, 0, iumin, iumax, ivmin, ivmax);
-                jet[2] = Compute(0, 1, iumin, iumax, ivmin, ivmax);
+                jet[1] = Compute(values, 1, 0, iumin, iumax, ivmin, ivmax);
+                jet[2] = Compute(values, 0, 1, iumin, iumax, ivmin, ivmax);
                 if (order >= 2)
                 {
                     // Compute second-order derivatives.
-                    jet[3] = Compute(2, 0, iumin, iumax, ivmin, ivmax);
-                    jet[4] = Compute(1, 1, iumin, iumax, ivmin, ivmax);
-                    jet[5] = Compute(0, 2, iumin, iumax, ivmin, ivmax);
+                    jet[3] = Compute(values, 2, 0, iumin, iumax, ivmin, ivmax);
+                    jet[4] = Compute(values, 1, 1, iumin, iumax, ivmin, ivmax);
+                    jet[5] = Compute(values, 0, 2, iumin, iumax, ivmin, ivmax);
                 }
             }
         }
 
     private:
         // Support for Evaluate(...).
-        Vector<N, Real> Compute(unsigned int uOrder, unsigned int vOrder,
+        Vector<N, Real> Compute(std::array<BasisFunctionValues<Real>, 2> const& values,
+            unsigned int uOrder, unsigned int vOrder,
             int iumin, int iumax, int ivmin, int ivmax) const
         {
             // The j*-indices introduce a tiny amount of overhead in order to
@@ -154,11 +159,11 @@ namespace gte
             result.MakeZero();
             for (int iv = ivmin; iv <= ivmax; ++iv)
             {
-                Real tmpv = mBasisFunction[1].GetValue(vOrder, iv);
+                Real tmpv = values[1].Get(vOrder, iv);
                 int jv = (iv >= numControls1 ? iv - numControls1 : iv);
                 for (int iu = iumin; iu <= iumax; ++iu)
                 {
-                    Real tmpu = mBasisFunction[0].GetValue(uOrder, iu);
+                    Real tmpu = values[0].Get(uOrder, iu);
                     int ju = (iu >= numControls0 ? iu - numControls0 : iu);
                     result += (tmpu * tmpv) * mControls[ju + numControls0 * jv];
                 }
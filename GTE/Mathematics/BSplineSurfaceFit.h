@@ -3,13 +3,18 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/BandedMatrix.h>
 #include <Mathematics/BasisFunction.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
 
 // The algorithm implemented here is based on the document
 // https://www.geometrictools.com/Documentation/BSplineSurfaceLeastSquaresFit.pdf
@@ -20,22 +25,122 @@ namespace gte
     class BSplineSurfaceFit
     {
     public:
+        // The function for out-of-core fitting. It must store the samples
+        // (j0,row) for 0 <= j0 < numSamples0 in samples[j0].
+        typedef std::function<void(int row, Vector3<Real>* samples)> SampleFunction;
+
         // Construction.  The preconditions for calling the constructor are
         //   1 <= degree0 && degree0 + 1 < numControls0 <= numSamples0
         //   1 <= degree1 && degree1 + 1 < numControls1 <= numSamples1
         // The sample data must be in row-major order.  The control data is
         // also stored in row-major order.
+        //
+        // The right-hand side A0^T*P*A1 of the normal equations is
+        // accumulated in a single pass over the samples, which costs
+        // O(numSamples0*numSamples1*(degree0+1)) time for the sums of the
+        // rows and O(numSamples1*numControls0*(degree1+1)) time to add
+        // them. When a task scheduler is passed, the columns i1 of the
+        // controls are partitioned among its threads, each thread visiting
+        // the sample rows that influence its columns. The sums are in
+        // sample order for any number of threads, so the results do not
+        // depend on the scheduler.
         BSplineSurfaceFit(int degree0, int numControls0, int numSamples0,
-            int degree1, int numControls1, int numSamples1, Vector3<Real> const* sampleData)
+            int degree1, int numControls1, int numSamples1, Vector3<Real> const* sampleData,
+            TaskScheduler* scheduler = nullptr)
             :
             mSampleData(sampleData),
             mControlData(numControls0 * numControls1)
+        {
+            LogAssert(sampleData, "Invalid sample data.");
+            Fit(degree0, numControls0, numSamples0, degree1, numControls1, numSamples1,
+                nullptr, scheduler);
+        }
+
+        // Construction for samples that are not in memory, for example,
+        // samples that are read from a file. The sample function is called
+        // for the rows of samples in increasing order. When a task scheduler
+        // is passed, the function is called concurrently by the threads of
+        // the scheduler, so it must be thread-safe; the rows near the
+        // boundaries of the partition of the controls are requested by two
+        // threads. GetSampleData() returns null for a surface constructed
+        // this way.
+        BSplineSurfaceFit(int degree0, int numControls0, int numSamples0,
+            int degree1, int numControls1, int numSamples1,
+            SampleFunction const& sampleFunction, TaskScheduler* scheduler = nullptr)
+            :
+            mSampleData(nullptr),
+            mControlData(numControls0 * numControls1)
+        {
+            LogAssert(sampleFunction, "Invalid sample function.");
+            Fit(degree0, numControls0, numSamples0, degree1, numControls1, numSamples1,
+                &sampleFunction, scheduler);
+        }
+
+        // Access to input sample information.
+        inline int GetNumSamples(int dimension) const
+        {
+            return mNumSamples[dimension];
+        }
+
+        // The sample data is null when the out-of-core constructor is used.
+        inline Vector3<Real> const* GetSampleData() const
+        {
+            return mSampleData;
+        }
+
+        // Access to output control point and surface information.
+        inline int GetDegree(int dimension) const
+        {
+            return mDegree[dimension];
+        }
+
+        inline int GetNumControls(int dimension) const
+        {
+            return mNumControls[dimension];
+        }
+
+        inline Vector3<Real> const* GetControlData() const
+        {
+            return &mControlData[0];
+        }
+
+        inline BasisFunction<Real> const& GetBasis(int dimension) const
+        {
+            return mBasis[dimension];
+        }
+
+        // Evaluation of the B-spline surface.  It is defined for
+        // 0 <= u <= 1 and 0 <= v <= 1.  If a parameter value is outside
+        // [0,1], it is clamped to [0,1].
+        Vector3<Real> GetPosition(Real u, Real v) const
+        {
+            int iumin, iumax, ivmin, ivmax;
+            mBasis[0].Evaluate(u, 0, iumin, iumax);
+            mBasis[1].Evaluate(v, 0, ivmin, ivmax);
+
+            Vector3<Real> position = Vector3<Real>::Zero();
+            for (int iv = ivmin; iv <= ivmax; ++iv)
+            {
+                Real value1 = mBasis[1].GetValue(0, iv);
+                for (int iu = iumin; iu <= iumax; ++iu)
+                {
+                    Real value0 = mBasis[0].GetValue(0, iu);
+                    Vector3<Real> control = mControlData[iu + mNumControls[0] * iv];
+                    position += (value0 * value1) * control;
+                }
+            }
+            return position;
+        }
+
+    private:
+        void Fit(int degree0, int numControls0, int numSamples0, int degree1,
+            int numControls1, int numSamples1, SampleFunction const* sampleFunction,
+            TaskScheduler* scheduler)
         {
             LogAssert(1 <= degree0 && degree0 + 1 < numControls0, "Invalid degree.");
             LogAssert(numControls0 <= numSamples0, "Invalid number of controls.");
             LogAssert(1 <= degree1 && degree1 + 1 < numControls1, "Invalid degree.");
             LogAssert(numControls1 <= numSamples1, "Invalid number of controls.");
-            LogAssert(sampleData, "Invalid sample data.");
 
             mDegree[0] = degree0;
             mNumSamples[0] = numSamples0;
@@ -76,160 +181,161 @@ namespace gte
             // A0^T*A0*Q*A1^T*A1 = A0^T*P*A1, where A0^T*A0 and A1^T*A1 are
             // banded matrices, P contains the sample data, and Q is the
             // unknown matrix of control points.
-            Real t;
-            int i0, i1, i2, imin, imax;
+            int i0, i1;
+            BasisFunctionValues<Real> values;
 
-            // Construct the matrices A0^T*A0 and A1^T*A1.
+            // Construct the matrices A0^T*A0 and A1^T*A1.  Store the basis
+            // values of the samples of dimension 0, which are used for each
+            // row of samples.
             BandedMatrix<Real> ATAMat[2] =
             {
                 BandedMatrix<Real>(mNumControls[0], mDegree[0] + 1, mDegree[0] + 1),
                 BandedMatrix<Real>(mNumControls[1], mDegree[1] + 1, mDegree[1] + 1)
             };
 
+            int const degp10 = mDegree[0] + 1;
+            std::vector<int> imin0(mNumSamples[0]);
+            std::vector<Real> basis0(static_cast<size_t>(mNumSamples[0]) * degp10);
             for (dim = 0; dim < 2; ++dim)
             {
-                for (i0 = 0; i0 < mNumControls[dim]; ++i0)
+                for (int j = 0; j < mNumSamples[dim]; ++j)
                 {
-                    for (i1 = 0; i1 < i0; ++i1)
+                    mBasis[dim].Evaluate(tMultiplier[dim] * (Real)j, 0, values);
+                    for (i0 = values.minIndex; i0 <= values.maxIndex; ++i0)
                     {
-                        ATAMat[dim](i0, i1) = ATAMat[dim](i1, i0);
-                    }
-
-                    int i1Max = i0 + mDegree[dim];
-                    if (i1Max >= mNumControls[dim])
-                    {
-                        i1Max = mNumControls[dim] - 1;
+                        Real b0 = values.Get(0, i0);
+                        for (i1 = i0; i1 <= values.maxIndex; ++i1)
+                        {
+                            ATAMat[dim](i0, i1) += b0 * values.Get(0, i1);
+                        }
                     }
 
-                    for (i1 = i0; i1 <= i1Max; ++i1)
+                    if (dim == 0)
                     {
-                        Real value = (Real)0;
-                        for (i2 = 0; i2 < mNumSamples[dim]; ++i2)
+                        imin0[j] = values.minIndex;
+                        for (int r = 0; r < degp10; ++r)
                         {
-                            t = tMultiplier[dim] * (Real)i2;
-                            mBasis[dim].Evaluate(t, 0, imin, imax);
-                            if (imin <= i0 && i0 <= imax && imin <= i1 && i1 <= imax)
-                            {
-                                Real b0 = mBasis[dim].GetValue(0, i0);
-                                Real b1 = mBasis[dim].GetValue(0, i1);
-                                value += b0 * b1;
-                            }
+                            basis0[static_cast<size_t>(j) * degp10 + r] =
+                                values.Get(0, values.minIndex + r);
                         }
-                        ATAMat[dim](i0, i1) = value;
                     }
                 }
-            }
 
-            // Construct the matrices A0^T and A1^T.  A[d]^T has
-            // mNumControls[d] rows and mNumSamples[d] columns.
-            Array2<Real> ATMat[2];
-            for (dim = 0; dim < 2; dim++)
-            {
-                ATMat[dim] = Array2<Real>(mNumSamples[dim], mNumControls[dim]);
-                size_t numBytes = mNumControls[dim] * mNumSamples[dim] * sizeof(Real);
-                std::memset(ATMat[dim][0], 0, numBytes);
-                for (i0 = 0; i0 < mNumControls[dim]; ++i0)
+                for (i0 = 1; i0 < mNumControls[dim]; ++i0)
                 {
-                    for (i1 = 0; i1 < mNumSamples[dim]; ++i1)
+                    for (i1 = std::max(i0 - mDegree[dim], 0); i1 < i0; ++i1)
                     {
-                        t = tMultiplier[dim] * (Real)i1;
-                        mBasis[dim].Evaluate(t, 0, imin, imax);
-                        if (imin <= i0 && i0 <= imax)
-                        {
-                            ATMat[dim][i0][i1] = mBasis[dim].GetValue(0, i0);
-                        }
+                        ATAMat[dim](i0, i1) = ATAMat[dim](i1, i0);
                     }
                 }
             }
 
-            // Compute X0 = (A0^T*A0)^{-1}*A0^T and X1 = (A1^T*A1)^{-1}*A1^T
-            // by solving the linear systems A0^T*A0*X0 = A0^T and
-            // A1^T*A1*X1 = A1^T.
-            for (dim = 0; dim < 2; ++dim)
+            // Construct B = A0^T*P*A1 as a numControls0-by-(3*numControls1)
+            // matrix in row-major order, the element (i0,3*i1+k) storing
+            // component k of B(i0,i1).  Column i1 of B is a sum over the
+            // sample rows whose parameters are in the support
+            // [knot[i1],knot[i1+degree1+1]] of basis function i1.
+            size_t const numBColumns = 3 * static_cast<size_t>(mNumControls[1]);
+            std::vector<Real> BMat(mNumControls[0] * numBColumns, (Real)0);
+
+            size_t numChunks = 1;
+            if (scheduler != nullptr)
             {
-                bool solved = ATAMat[dim].template SolveSystem<true>(ATMat[dim][0], mNumSamples[dim]);
-                LogAssert(solved, "Failed to solve linear system in BSplineSurfaceFit constructor.");
+                numChunks = std::max(std::min(static_cast<size_t>(mNumControls[1]),
+                    static_cast<size_t>(scheduler->GetNumThreads())), static_cast<size_t>(1));
             }
 
-            // The control points for the fitted surface are stored in the matrix
-            // Q = X0*P*X1^T, where P is the matrix of sample data.
-            for (i1 = 0; i1 < mNumControls[1]; ++i1)
-            {
-                for (i0 = 0; i0 < mNumControls[0]; ++i0)
+            Real const* knots1 = mBasis[1].GetKnots();
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, sampleFunction, numChunks, &tMultiplier, knots1, &imin0,
+                &basis0, degp10, numBColumns, &BMat](size_t chunk)
                 {
-                    Vector3<Real> sum = Vector3<Real>::Zero();
-                    for (int j1 = 0; j1 < mNumSamples[1]; ++j1)
+                    // Accumulate the columns c0 <= i1 < c1 of B.
+                    int const c0 = static_cast<int>(mNumControls[1] * chunk / numChunks);
+                    int const c1 = static_cast<int>(mNumControls[1] * (chunk + 1) / numChunks);
+                    Real const scale = (Real)(mNumSamples[1] - 1);
+                    int const jmin = std::max(static_cast<int>(std::floor(scale * knots1[c0])) - 1, 0);
+                    int const jmax = std::min(static_cast<int>(std::ceil(scale * knots1[c1 + mDegree[1]])) + 1,
+                        mNumSamples[1] - 1);
+
+                    BasisFunctionValues<Real> values1;
+                    std::vector<Vector3<Real>> row(sampleFunction ? mNumSamples[0] : 0);
+                    std::vector<Vector3<Real>> rowSum(mNumControls[0]);
+                    for (int j1 = jmin; j1 <= jmax; ++j1)
                     {
-                        Real x1Value = ATMat[1][i1][j1];
-                        for (int j0 = 0; j0 < mNumSamples[0]; ++j0)
+                        mBasis[1].Evaluate(tMultiplier[1] * (Real)j1, 0, values1);
+                        int const imin = std::max(values1.minIndex, c0);
+                        int const imax = std::min(values1.maxIndex, c1 - 1);
+                        if (imin > imax)
                         {
-                            Real x0Value = ATMat[0][i0][j0];
-                            Vector3<Real> sample =
-                                mSampleData[j0 + mNumSamples[0] * j1];
-                            sum += (x0Value * x1Value) * sample;
+                            continue;
                         }
-                    }
-                    mControlData[i0 + mNumControls[0] * i1] = sum;
-                }
-            }
-        }
-
-        // Access to input sample information.
-        inline int GetNumSamples(int dimension) const
-        {
-            return mNumSamples[dimension];
-        }
 
-        inline Vector3<Real> const* GetSampleData() const
-        {
-            return mSampleData;
-        }
-
-        // Access to output control point and surface information.
-        inline int GetDegree(int dimension) const
-        {
-            return mDegree[dimension];
-        }
-
-        inline int GetNumControls(int dimension) const
-        {
-            return mNumControls[dimension];
-        }
+                        Vector3<Real> const* P;
+                        if (sampleFunction)
+                        {
+                            (*sampleFunction)(j1, row.data());
+                            P = row.data();
+                        }
+                        else
+                        {
+                            P = mSampleData + static_cast<size_t>(j1) * mNumSamples[0];
+                        }
 
-        inline Vector3<Real> const* GetControlData() const
-        {
-            return &mControlData[0];
-        }
+                        // Compute row j1 of A0^T*P.
+                        std::fill(rowSum.begin(), rowSum.end(), Vector3<Real>::Zero());
+                        for (int j0 = 0; j0 < mNumSamples[0]; ++j0)
+                        {
+                            Real const* b0 = &basis0[static_cast<size_t>(j0) * degp10];
+                            Vector3<Real>* sum = &rowSum[imin0[j0]];
+                            for (int r = 0; r < degp10; ++r)
+                            {
+                                sum[r] += b0[r] * P[j0];
+                            }
+                        }
 
-        inline BasisFunction<Real> const& GetBasis(int dimension) const
-        {
-            return mBasis[dimension];
-        }
+                        for (int i1 = imin; i1 <= imax; ++i1)
+                        {
+                            Real b1 = values1.Get(0, i1);
+                            Real* B = &BMat[3 * static_cast<size_t>(i1)];
+                            for (int i0 = 0; i0 < mNumControls[0]; ++i0, B += numBColumns)
+                            {
+                                for (int k = 0; k < 3; ++k)
+                                {
+                                    B[k] += b1 * rowSum[i0][k];
+                                }
+                            }
+                        }
+                    }
+                });
 
-        // Evaluation of the B-spline surface.  It is defined for
-        // 0 <= u <= 1 and 0 <= v <= 1.  If a parameter value is outside
-        // [0,1], it is clamped to [0,1].
-        Vector3<Real> GetPosition(Real u, Real v) const
-        {
-            int iumin, iumax, ivmin, ivmax;
-            mBasis[0].Evaluate(u, 0, iumin, iumax);
-            mBasis[1].Evaluate(v, 0, ivmin, ivmax);
+            // The control points are Q = (A0^T*A0)^{-1}*B*(A1^T*A1)^{-1}.
+            // Solve (A0^T*A0)*Y = B, transpose Y and solve
+            // (A1^T*A1)*Q^T = Y^T.  The element (i1,3*i0+k) of Q^T is
+            // component k of control (i0,i1), which is the storage order of
+            // the control data.
+            bool solved = ATAMat[0].template SolveSystem<true>(BMat.data(),
+                static_cast<int>(numBColumns));
+            LogAssert(solved, "Failed to solve linear system in BSplineSurfaceFit constructor.");
 
-            Vector3<Real> position = Vector3<Real>::Zero();
-            for (int iv = ivmin; iv <= ivmax; ++iv)
+            Real* Q = &mControlData[0][0];
+            for (i1 = 0; i1 < mNumControls[1]; ++i1)
             {
-                Real value1 = mBasis[1].GetValue(0, iv);
-                for (int iu = iumin; iu <= iumax; ++iu)
+                for (i0 = 0; i0 < mNumControls[0]; ++i0, Q += 3)
                 {
-                    Real value0 = mBasis[0].GetValue(0, iu);
-                    Vector3<Real> control = mControlData[iu + mNumControls[0] * iv];
-                    position += (value0 * value1) * control;
+                    Real const* Y = &BMat[i0 * numBColumns + 3 * static_cast<size_t>(i1)];
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        Q[k] = Y[k];
+                    }
                 }
             }
-            return position;
+
+            solved = ATAMat[1].template SolveSystem<true>(&mControlData[0][0],
+                3 * mNumControls[0]);
+            LogAssert(solved, "Failed to solve linear system in BSplineSurfaceFit constructor.");
         }
 
-    private:
         // Input sample information.
         int mNumSamples[2];
         Vector3<Real> const* mSampleData;
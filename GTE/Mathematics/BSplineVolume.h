@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -134,35 +134,41 @@ namespace gte
                 return;
             }
 
-            int iumin, iumax, ivmin, ivmax, iwmin, iwmax;
-            mBasisFunction[0].Evaluate(u, order, iumin, iumax);
-            mBasisFunction[1].Evaluate(v, order, ivmin, ivmax);
-            mBasisFunction[2].Evaluate(w, order, iwmin, iwmax);
+            // The basis function values are stored per thread, so the
+            // function can be called concurrently.
+            thread_local std::array<BasisFunctionValues<Real>, 3> values;
+            mBasisFunction[0].Evaluate(u, order, values[0]);
+            mBasisFunction[1].Evaluate(v, order, values[1]);
+            mBasisFunction[2].Evaluate(w, order, values[2]);
+            int iumin = values[0].minIndex, iumax = values[0].maxIndex;
+            int ivmin = values[1].minIndex, ivmax = values[1].maxIndex;
+            int iwmin = values[2].minIndex, iwmax = values[2].maxIndex;
 
             // Compute position.
-            jet[0] = Compute(0, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+            jet[0] = Compute(values, 0, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
             if (order >= 1)
             {
                 // Compute first-order derivatives.
-                jet[1] = Compute(1, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                jet[2] = Compute(0, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                jet[3] = Compute(0, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                jet[1] = Compute(values, 1, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                jet[2] = Compute(values, 0, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                jet[3] = Compute(values, 0, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
                 if (order >= 2)
                 {
                     // Compute second-order derivatives.
-                    jet[4] = Compute(2, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                    jet[5] = Compute(0, 2, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                    jet[6] = Compute(0, 0, 2, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                    jet[7] = Compute(1, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                    jet[8] = Compute(1, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
-                    jet[9] = Compute(0, 1, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                    jet[4] = Compute(values, 2, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                    jet[5] = Compute(values, 0, 2, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                    jet[6] = Compute(values, 0, 0, 2, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                    jet[7] = Compute(values, 1, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                    jet[8] = Compute(values, 1, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
+                    jet[9] = Compute(values, 0, 1, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax);
                 }
             }
         }
 
     private:
         // Support for Evaluate(...).
-        Vector<N, Real> Compute(unsigned int uOrder, unsigned int vOrder,
+        Vector<N, Real> Compute(std::array<BasisFunctionValues<Real>, 3> const& values,
+            unsigned int uOrder, unsigned int vOrder,
             unsigned int wOrder, int iumin, int iumax, int ivmin, int ivmax,
             int iwmin, int iwmax) const
         {
@@ -177,16 +183,16 @@ namespace gte
             result.MakeZero();
             for (int iw = iwmin; iw <= iwmax; ++iw)
             {
-                Real tmpw = mBasisFunction[2].GetValue(wOrder, iw);
+                Real tmpw = values[2].Get(wOrder, iw);
                 int jw = (iw >= numControls2 ? iw - numControls2 : iw);
                 for (int iv = ivmin; iv <= ivmax; ++iv)
                 {
-                    Real tmpv = mBasisFunction[1].GetValue(vOrder, iv);
+                    Real tmpv = values[1].Get(vOrder, iv);
                     Real tmpvw = tmpv * tmpw;
                     int jv = (iv >= numControls1 ? iv - numControls1 : iv);
                     for (int iu = iumin; iu <= iumax; ++iu)
                     {
-                        Real tmpu = mBasisFunction[0].GetValue(uOrder, iu);
+                        Real tmpu = values[0].Get(uOrder, iu);
                         int ju = (iu >= numControls0 ? iu - numControls0 : iu);
                         result += (tmpu * tmpvw) *
                             mControls[ju + numControls0 * (jv + numControls1 * jw)];
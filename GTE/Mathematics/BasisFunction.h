@@ -3,15 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/Math.h>
 #include <Mathematics/Array2.h>
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <vector>
 
 namespace gte
 {
@@ -59,6 +61,36 @@ namespace gte
         std::vector<UniqueKnot<Real>> uniqueKnots;
     };
 
+    // Storage for the results of the BasisFunction::Evaluate(...) function
+    // that does not modify the BasisFunction object. The nonzero basis
+    // functions at t are those with indices minIndex <= i <= maxIndex.
+    template <typename Real>
+    class BasisFunctionValues
+    {
+    public:
+        BasisFunctionValues()
+            :
+            span(-1),
+            minIndex(0),
+            maxIndex(-1),
+            order(0),
+            stride(0)
+        {
+        }
+
+        // The derivative of order k <= 'order' of basis function i, where
+        // minIndex <= i <= maxIndex.
+        inline Real Get(unsigned int k, int i) const
+        {
+            return values[stride * k + static_cast<size_t>(i - minIndex)];
+        }
+
+        int span, minIndex, maxIndex;
+        unsigned int order;
+        size_t stride;
+        std::vector<Real> values, workspace;
+    };
+
     template <typename Real>
     class BasisFunction
     {
@@ -394,7 +426,9 @@ namespace gte
         // satisfy minIndex <= i <= maxIndex.  If it is not, the function
         // returns zero.  The separation of evaluation and access is based on
         // local control of the basis function; that is, only the accessible
-        // values are (potentially) not zero.
+        // values are (potentially) not zero.  Evaluate(...) and GetValue(...)
+        // share storage in the object, so they cannot be used concurrently;
+        // use Evaluate(...) with a BasisFunctionValues output instead.
         Real GetValue(unsigned int order, int i) const
         {
             if (order < 4)
@@ -408,11 +442,147 @@ namespace gte
             LogError("Invalid order.");
         }
 
+        // Evaluation of the basis functions and their derivatives through
+        // order 3 that does not modify the object, so it can be called
+        // concurrently with different 'values' objects. The span of the
+        // previous evaluation for the same 'values' is used as the starting
+        // point of the knot search, so reuse the object for sorted t.
+        void Evaluate(Real t, unsigned int order, BasisFunctionValues<Real>& values) const
+        {
+            LogAssert(order <= 3, "Invalid order.");
+            values.span = GetSpan(t, values.span);
+            values.minIndex = values.span - mDegree;
+            values.maxIndex = values.span;
+            values.order = order;
+            values.stride = static_cast<size_t>(mDegree) + 1;
+            values.values.resize((order + 1) * values.stride);
+            EvaluateSpan(t, values.span, order, values.workspace, values.values.data());
+        }
+
+        // The building blocks of the previous function, for callers that
+        // evaluate at many t. GetSpan returns the index i
+        // for which knot[i] <= t < knot[i+1] and modifies t as Evaluate(...)
+        // does. The search starts at 'hint', typically the span of the
+        // previous t, so the spans of sorted t-values are found in constant
+        // time on average. Pass a negative hint when there is none.
+        int GetSpan(Real& t, int hint) const
+        {
+            int i = WrapAndClamp(t);
+            if (i >= 0)
+            {
+                return i;
+            }
+
+            for (i = hint; mDegree <= i && i < mNumControls && i <= hint + 1; ++i)
+            {
+                if (mKnots[i] <= t && t < mKnots[static_cast<size_t>(i) + 1])
+                {
+                    return i;
+                }
+            }
+            return Search(t);
+        }
+
+        // Compute the basis functions with indices minIndex = span - d
+        // through maxIndex = span and their derivatives through the
+        // specified order at t, where span = GetSpan(t, hint). The output
+        // 'basis' must have (order + 1) * (d + 1) elements, and on return
+        // the derivative of order k of basis function i is
+        // basis[(d + 1) * k + i - minIndex]. The workspace is resized as
+        // needed, so pass the same object in repeated calls. The values are
+        // the same as those of Evaluate(...) followed by GetValue(...).
+        void EvaluateSpan(Real t, int span, unsigned int order,
+            std::vector<Real>& workspace, Real* basis) const
+        {
+            LogAssert(order <= 3, "Invalid order.");
+
+            // The jet of order k is J[k][(d+1) * j + (m - i + d)] for the
+            // basis function m of degree j.
+            size_t const d = static_cast<size_t>(mDegree), d1 = d + 1;
+            workspace.resize((order + 1) * d1 * d1);
+            std::array<Real*, 4> J = { nullptr, nullptr, nullptr, nullptr };
+            for (unsigned int k = 0; k <= order; ++k)
+            {
+                J[k] = workspace.data() + k * d1 * d1;
+            }
+
+            int const i = span;
+            auto const& knots = mKnots;
+            size_t const top = d;
+            J[0][top] = (Real)1;
+            for (unsigned int k = 1; k <= order; ++k)
+            {
+                J[k][top] = (Real)0;
+            }
+
+            Real n0 = t - knots[i], n1 = knots[i + 1] - t;
+            Real e0, e1, d0, dd1, invD0, invD1;
+            for (size_t j = 1; j <= d; ++j)
+            {
+                int const ij = static_cast<int>(j);
+                d0 = knots[i + ij] - knots[i];
+                dd1 = knots[i + 1] - knots[i - ij + 1];
+                invD0 = (d0 > (Real)0 ? (Real)1 / d0 : (Real)0);
+                invD1 = (dd1 > (Real)0 ? (Real)1 / dd1 : (Real)0);
+
+                // Local indices of m = i, i-j+1 and i-j in rows j-1 and j.
+                size_t const prev = d1 * (j - 1), cur = d1 * j;
+                size_t const lTop = top, lLow = top - j + 1, lBottom = top - j;
+
+                e0 = n0 * J[0][prev + lTop];
+                J[0][cur + lTop] = e0 * invD0;
+                e1 = n1 * J[0][prev + lLow];
+                J[0][cur + lBottom] = e1 * invD1;
+
+                for (unsigned int k = 1; k <= order; ++k)
+                {
+                    Real const rk = (Real)k;
+                    e0 = n0 * J[k][prev + lTop] + rk * J[k - 1][prev + lTop];
+                    J[k][cur + lTop] = e0 * invD0;
+                    e1 = n1 * J[k][prev + lLow] - rk * J[k - 1][prev + lLow];
+                    J[k][cur + lBottom] = e1 * invD1;
+                }
+            }
+
+            for (size_t j = 2; j <= d; ++j)
+            {
+                int const ij = static_cast<int>(j);
+                size_t const prev = d1 * (j - 1), cur = d1 * j;
+                for (int m = i - ij + 1; m < i; ++m)
+                {
+                    size_t const l = static_cast<size_t>(m - i) + top;
+                    n0 = t - knots[m];
+                    n1 = knots[m + ij + 1] - t;
+                    d0 = knots[m + ij] - knots[m];
+                    dd1 = knots[m + ij + 1] - knots[m + 1];
+                    invD0 = (d0 > (Real)0 ? (Real)1 / d0 : (Real)0);
+                    invD1 = (dd1 > (Real)0 ? (Real)1 / dd1 : (Real)0);
+
+                    e0 = n0 * J[0][prev + l];
+                    e1 = n1 * J[0][prev + l + 1];
+                    J[0][cur + l] = e0 * invD0 + e1 * invD1;
+
+                    for (unsigned int k = 1; k <= order; ++k)
+                    {
+                        Real const rk = (Real)k;
+                        e0 = n0 * J[k][prev + l] + rk * J[k - 1][prev + l];
+                        e1 = n1 * J[k][prev + l + 1] - rk * J[k - 1][prev + l + 1];
+                        J[k][cur + l] = e0 * invD0 + e1 * invD1;
+                    }
+                }
+            }
+
+            for (unsigned int k = 0; k <= order; ++k)
+            {
+                std::copy(J[k] + d1 * d, J[k] + d1 * d1, basis + d1 * k);
+            }
+        }
+
     private:
-        // Determine the index i for which knot[i] <= t < knot[i+1].  The
-        // t-value is modified (wrapped for periodic splines, clamped for
-        // nonperiodic splines).
-        int GetIndex(Real& t) const
+        // Wrap t for periodic splines and clamp t to [tmin,tmax]. The
+        // function returns the index i for which knot[i] <= t < knot[i+1]
+        // when t is clamped to an endpoint, or -1 otherwise.
+        int WrapAndClamp(Real& t) const
         {
             // Find the index i for which knot[i] <= t < knot[i+1].
             if (mPeriodic)
@@ -438,18 +608,26 @@ namespace gte
                 t = mTMax;
                 return mNumControls - 1;
             }
+            return -1;
+        }
 
-            // At this point, tmin < t < tmax.
-            for (auto const& key : mKeys)
-            {
-                if (t < key.first)
-                {
-                    return key.second;
-                }
-            }
+        // Determine the index i for which knot[i] <= t < knot[i+1] for
+        // tmin < t < tmax.
+        int Search(Real t) const
+        {
+            auto iter = std::upper_bound(mKeys.begin(), mKeys.end(), t,
+                [](Real value, std::pair<Real, int> const& key) { return value < key.first; });
+            LogAssert(iter != mKeys.end(), "Unexpected condition.");
+            return iter->second;
+        }
 
-            // We should not reach this code.
-            LogError("Unexpected condition.");
+        // Determine the index i for which knot[i] <= t < knot[i+1].  The
+        // t-value is modified (wrapped for periodic splines, clamped for
+        // nonperiodic splines).
+        int GetIndex(Real& t) const
+        {
+            int i = WrapAndClamp(t);
+            return (i >= 0 ? i : Search(t));
         }
 
         // Constructor inputs and values derived from them.
@@ -0,0 +1,224 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// The cache-blocked matrix product C = C + A*B used by the GMatrix products
+// for large matrices, where A is numRows-by-numCommon, B is
+// numCommon-by-numCols and C is numRows-by-numCols. The matrices are
+// accessed through their storage with strides, element (r,c) of A being
+// A[r * aRowStride + c * aColStride], so row-major, column-major and
+// transposed matrices are handled by the same code.
+//
+// The computation is organized as in
+//   K. Goto and R.A. van de Geijn, Anatomy of high-performance matrix
+//   multiplication, ACM Transactions on Mathematical Software 34 (2008)
+// Blocks of KC columns of A and KC rows of B are packed into contiguous
+// panels of MR rows of A and NR columns of B, and a micro-kernel computes
+// MR-by-NR blocks of C with the elements accumulated in local variables.
+// The loops of the micro-kernel have compile-time bounds so compilers can
+// vectorize them and keep the accumulators in registers. The packing makes
+// the accesses contiguous whatever the storage order of the inputs.
+//
+// An accumulator is initialized with its element of C and the terms are
+// added in the order of the common index, so every element of C is
+// computed with the additions of the triple loop
+//   for (i = 0; i < numCommon; ++i) { C(r,c) += A(r,i) * B(i,c); }
+// and the result is the same as that of the triple loop, for any number of
+// threads. The rows of C are partitioned into numThreads contiguous ranges
+// that are computed concurrently, each thread with its own packed panels.
+// The ranges are tasks of the scheduler passed to Execute when it is not
+// null; otherwise, std::thread objects are created for each call.
+
+namespace gte
+{
+    template <typename Real>
+    class BlockedMatrixProduct
+    {
+    public:
+        // The register block is MR-by-NR and the cache blocks are
+        // MC-by-KC for A and KC-by-NC for B.
+        enum
+        {
+            MR = 4,
+            NR = 8,
+            MC = 64,
+            KC = 256,
+            NC = 512
+        };
+
+        // The GMatrix products use the blocked computation when the number
+        // of multiply-adds is at least this threshold; the packing costs
+        // more than it saves for smaller products.
+        enum
+        {
+            THRESHOLD = 32 * 32 * 32
+        };
+
+        static void Execute(int numRows, int numCols, int numCommon,
+            Real const* A, int aRowStride, int aColStride,
+            Real const* B, int bRowStride, int bColStride,
+            Real* C, int cRowStride, int cColStride, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            if (numRows <= 0 || numCols <= 0 || numCommon <= 0)
+            {
+                return;
+            }
+
+            Operands ops{ numCols, numCommon, A, aRowStride, aColStride,
+                B, bRowStride, bColStride, C, cRowStride, cColStride };
+
+            // Every thread has at least MC rows.
+            size_t const maxThreads = static_cast<size_t>((numRows + MC - 1) / MC);
+            numThreads = std::max(std::min(numThreads, maxThreads), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numThreads, [&ops, numRows, numThreads](size_t t)
+            {
+                int r0 = static_cast<int>(numRows * t / numThreads);
+                int r1 = static_cast<int>(numRows * (t + 1) / numThreads);
+                ExecuteRows(ops, r0, r1);
+            });
+        }
+
+    private:
+        struct Operands
+        {
+            int numCols, numCommon;
+            Real const* A;
+            int aRowStride, aColStride;
+            Real const* B;
+            int bRowStride, bColStride;
+            Real* C;
+            int cRowStride, cColStride;
+        };
+
+        // Compute rows r0 <= r < r1 of C.
+        static void ExecuteRows(Operands const& ops, int r0, int r1)
+        {
+            std::vector<Real> packedA(static_cast<size_t>(MC) * KC, (Real)0);
+            std::vector<Real> packedB(static_cast<size_t>(NC) * KC, (Real)0);
+
+            for (int c0 = 0; c0 < ops.numCols; c0 += NC)
+            {
+                int nc = std::min(static_cast<int>(NC), ops.numCols - c0);
+                for (int k0 = 0; k0 < ops.numCommon; k0 += KC)
+                {
+                    int kc = std::min(static_cast<int>(KC), ops.numCommon - k0);
+                    PackB(ops, k0, kc, c0, nc, packedB.data());
+                    for (int rb = r0; rb < r1; rb += MC)
+                    {
+                        int mc = std::min(static_cast<int>(MC), r1 - rb);
+                        PackA(ops, rb, mc, k0, kc, packedA.data());
+                        for (int j = 0; j < nc; j += NR)
+                        {
+                            int nr = std::min(static_cast<int>(NR), nc - j);
+                            Real const* panelB = packedB.data() + static_cast<size_t>(j) * kc;
+                            for (int i = 0; i < mc; i += MR)
+                            {
+                                int mr = std::min(static_cast<int>(MR), mc - i);
+                                Real const* panelA = packedA.data() + static_cast<size_t>(i) * kc;
+                                MicroKernel(ops, kc, panelA, panelB, rb + i, mr, c0 + j, nr);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Pack the mc-by-kc block of A at (r0,k0) into panels of MR rows,
+        // element (i,k) of the panel at packed[k * MR + i]. Rows beyond mc
+        // are zero.
+        static void PackA(Operands const& ops, int r0, int mc, int k0, int kc, Real* packed)
+        {
+            for (int i0 = 0; i0 < mc; i0 += MR, packed += static_cast<size_t>(MR) * kc)
+            {
+                int mr = std::min(static_cast<int>(MR), mc - i0);
+                for (int k = 0; k < kc; ++k)
+                {
+                    Real const* a = ops.A + static_cast<size_t>(k0 + k) * ops.aColStride;
+                    for (int i = 0; i < mr; ++i)
+                    {
+                        packed[k * MR + i] = a[static_cast<size_t>(r0 + i0 + i) * ops.aRowStride];
+                    }
+                    for (int i = mr; i < MR; ++i)
+                    {
+                        packed[k * MR + i] = (Real)0;
+                    }
+                }
+            }
+        }
+
+        // Pack the kc-by-nc block of B at (k0,c0) into panels of NR
+        // columns, element (k,j) of the panel at packed[k * NR + j].
+        // Columns beyond nc are zero.
+        static void PackB(Operands const& ops, int k0, int kc, int c0, int nc, Real* packed)
+        {
+            for (int j0 = 0; j0 < nc; j0 += NR, packed += static_cast<size_t>(NR) * kc)
+            {
+                int nr = std::min(static_cast<int>(NR), nc - j0);
+                for (int k = 0; k < kc; ++k)
+                {
+                    Real const* b = ops.B + static_cast<size_t>(k0 + k) * ops.bRowStride;
+                    for (int j = 0; j < nr; ++j)
+                    {
+                        packed[k * NR + j] = b[static_cast<size_t>(c0 + j0 + j) * ops.bColStride];
+                    }
+                    for (int j = nr; j < NR; ++j)
+                    {
+                        packed[k * NR + j] = (Real)0;
+                    }
+                }
+            }
+        }
+
+        // C(r0+i,c0+j) += sum_k panelA(i,k) * panelB(k,j) for 0 <= i < mr and
+        // 0 <= j < nr.
+        static void MicroKernel(Operands const& ops, int kc, Real const* panelA,
+            Real const* panelB, int r0, int mr, int c0, int nr)
+        {
+            std::array<std::array<Real, NR>, MR> acc;
+            for (int i = 0; i < MR; ++i)
+            {
+                for (int j = 0; j < NR; ++j)
+                {
+                    acc[i][j] = (i < mr && j < nr ? Element(ops, r0 + i, c0 + j) : (Real)0);
+                }
+            }
+
+            for (int k = 0; k < kc; ++k, panelA += MR, panelB += NR)
+            {
+                for (int i = 0; i < MR; ++i)
+                {
+                    Real a = panelA[i];
+                    for (int j = 0; j < NR; ++j)
+                    {
+                        acc[i][j] += a * panelB[j];
+                    }
+                }
+            }
+
+            for (int i = 0; i < mr; ++i)
+            {
+                for (int j = 0; j < nr; ++j)
+                {
+                    Element(ops, r0 + i, c0 + j) = acc[i][j];
+                }
+            }
+        }
+
+        static inline Real& Element(Operands const& ops, int r, int c)
+        {
+            return ops.C[static_cast<size_t>(r) * ops.cRowStride +
+                static_cast<size_t>(c) * ops.cColStride];
+        }
+    };
+}
@@ -3,25 +3,63 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/IntrAlignedBox3AlignedBox3.h>
 #include <Mathematics/EdgeKey.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <set>
 #include <vector>
 
+// The manager supports two modes. Mode::INCREMENTAL is the sort-and-sweep
+// on all three axes. The overlap set is updated by the swaps of an
+// insertion sort of the endpoints, which is fast when the motion is
+// coherent and the number of boxes is small. With multiple threads the
+// three axes are sorted concurrently; the swaps are recorded and then
+// applied to the overlap set in the order x, y, z, so the set is the same
+// as for one thread.
+//
+// Mode::SWEEP is for large numbers of boxes. Each update selects the axis
+// along which the box centers have the largest variance, sorts the boxes
+// by their minima on that axis (an insertion sort when the axis is that of
+// the previous update and the order has not changed much) and sweeps the
+// sorted boxes. The sweep is partitioned into blocks of boxes that are
+// processed concurrently. The overlapping pairs are stored in an array
+// whose order does not depend on the number of threads, and a flat hash
+// table of the pairs supports HasOverlap(i,j).
+
 namespace gte
 {
     template <typename Real>
     class BoxManager
     {
     public:
-        // Construction.
-        BoxManager(std::vector<AlignedBox3<Real>>& boxes)
+        enum class Mode
+        {
+            INCREMENTAL,
+            SWEEP
+        };
+
+        // Construction. The parallel parts of the updates are executed by
+        // numThreads threads, which are std::thread objects created for each
+        // call unless a scheduler is passed to the constructor or specified
+        // by SetScheduler(*).
+        BoxManager(std::vector<AlignedBox3<Real>>& boxes,
+            Mode mode = Mode::INCREMENTAL, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
             :
-            mBoxes(boxes)
+            mBoxes(boxes),
+            mMode(mode),
+            mNumThreads(numThreads),
+            mScheduler(scheduler),
+            mSweepAxis(-1),
+            mHashShift(60)
         {
             Initialize();
         }
@@ -32,6 +70,21 @@ namespace gte
         BoxManager(BoxManager const&) = delete;
         BoxManager& operator=(BoxManager const&) = delete;
 
+        // Execute the parallel parts of the updates as tasks of the
+        // scheduler, which can be shared with other computations, instead
+        // of creating threads for each call. The results do not depend on
+        // the scheduler. Set the scheduler to null to use std::thread
+        // objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // This function is called by the constructor and does the
         // sort-and-sweep to initialize the update system.  However, if you
         // add or remove items from the array of boxes after the constructor
@@ -39,6 +92,13 @@ namespace gte
         // multiple calls of the update function.
         void Initialize()
         {
+            if (mMode == Mode::SWEEP)
+            {
+                mSweepAxis = -1;
+                Sweep();
+                return;
+            }
+
             // Get the box endpoints.
             int intrSize = static_cast<int>(mBoxes.size()), endpSize = 2 * intrSize;
             mXEndpoints.resize(endpSize);
@@ -140,6 +200,11 @@ namespace gte
         void SetBox(int i, AlignedBox3<Real> const& box)
         {
             mBoxes[i] = box;
+            if (mMode == Mode::SWEEP)
+            {
+                return;
+            }
+
             mXEndpoints[mXLookup[2 * i]].value = box.min[0];
             mXEndpoints[mXLookup[2 * i + 1]].value = box.max[0];
             mYEndpoints[mYLookup[2 * i]].value = box.min[1];
@@ -158,19 +223,108 @@ namespace gte
         // determine the new set of overlapping boxes.
         void Update()
         {
-            InsertionSort(mXEndpoints, mXLookup);
-            InsertionSort(mYEndpoints, mYLookup);
-            InsertionSort(mZEndpoints, mZLookup);
+            if (mMode == Mode::SWEEP)
+            {
+                Sweep();
+                return;
+            }
+
+            if (mNumThreads <= 1)
+            {
+                InsertionSort(mXEndpoints, mXLookup, nullptr);
+                InsertionSort(mYEndpoints, mYLookup, nullptr);
+                InsertionSort(mZEndpoints, mZLookup, nullptr);
+                return;
+            }
+
+            std::array<std::vector<OverlapEvent>, 3> events;
+            TaskScheduler::ParallelForDynamic(mScheduler, 3, mNumThreads,
+                [this, &events](size_t axis)
+                {
+                    if (axis == 0)
+                    {
+                        InsertionSort(mXEndpoints, mXLookup, &events[0]);
+                    }
+                    else if (axis == 1)
+                    {
+                        InsertionSort(mYEndpoints, mYLookup, &events[1]);
+                    }
+                    else
+                    {
+                        InsertionSort(mZEndpoints, mZLookup, &events[2]);
+                    }
+                });
+
+            for (auto const& axisEvents : events)
+            {
+                for (auto const& event : axisEvents)
+                {
+                    if (event.insert)
+                    {
+                        mOverlap.insert(event.key);
+                    }
+                    else
+                    {
+                        mOverlap.erase(event.key);
+                    }
+                }
+            }
+        }
+
+        inline Mode GetMode() const
+        {
+            return mMode;
         }
 
         // If (i,j) is in the overlap set, then box i and box j are
         // overlapping.  The indices are those for the the input array.  The
-        // set elements (i,j) are stored so that i < j.
+        // set elements (i,j) are stored so that i < j.  The set is used
+        // only for Mode::INCREMENTAL.
         inline std::set<EdgeKey<false>> const& GetOverlap() const
         {
             return mOverlap;
         }
 
+        // The overlapping pairs (i,j), i < j, for Mode::SWEEP.
+        inline std::vector<EdgeKey<false>> const& GetOverlapPairs() const
+        {
+            return mOverlapPairs;
+        }
+
+        // The axis used by the last sweep of Mode::SWEEP.
+        inline int GetSweepAxis() const
+        {
+            return mSweepAxis;
+        }
+
+        // Test whether boxes i and j overlap, for either mode.
+        bool HasOverlap(int i, int j) const
+        {
+            EdgeKey<false> key(i, j);
+            if (mMode == Mode::INCREMENTAL)
+            {
+                return mOverlap.find(key) != mOverlap.end();
+            }
+
+            if (mHashKeys.size() == 0)
+            {
+                return false;
+            }
+            uint64_t hashKey = GetHashKey(key);
+            size_t const mask = mHashKeys.size() - 1;
+            for (size_t slot = GetHashSlot(hashKey); ; slot = (slot + 1) & mask)
+            {
+                if (mHashKeys[slot] == hashKey)
+                {
+                    return true;
+                }
+                if (mHashKeys[slot] == msEmptyHashKey)
+                {
+                    return false;
+                }
+            }
+        }
+
     private:
         class Endpoint
         {
@@ -194,7 +348,17 @@ namespace gte
             }
         };
 
-        void InsertionSort(std::vector<Endpoint>& endpoint, std::vector<int>& lookup)
+        // A change to the overlap set found by InsertionSort.
+        struct OverlapEvent
+        {
+            EdgeKey<false> key;
+            bool insert;
+        };
+
+        // The overlap set is modified directly when 'events' is null;
+        // otherwise, the changes are appended to 'events'.
+        void InsertionSort(std::vector<Endpoint>& endpoint, std::vector<int>& lookup,
+            std::vector<OverlapEvent>* events)
         {
             // Apply an insertion sort.  Under the assumption that the
             // rectangles have not changed much since the last call, the
@@ -228,7 +392,14 @@ namespace gte
                             // operation, so there is no real time savings in
                             // testing for existence first, then deleting if
                             // it does.
-                            mOverlap.erase(EdgeKey<false>(e0.index, e1.index));
+                            if (events)
+                            {
+                                events->push_back(OverlapEvent{ EdgeKey<false>(e0.index, e1.index), false });
+                            }
+                            else
+                            {
+                                mOverlap.erase(EdgeKey<false>(e0.index, e1.index));
+                            }
                         }
                     }
                     else
@@ -243,7 +414,14 @@ namespace gte
                             // and then insert.
                             if (query(mBoxes[e0.index], mBoxes[e1.index]).intersect)
                             {
-                                mOverlap.insert(EdgeKey<false>(e0.index, e1.index));
+                                if (events)
+                                {
+                                    events->push_back(OverlapEvent{ EdgeKey<false>(e0.index, e1.index), true });
+                                }
+                                else
+                                {
+                                    mOverlap.insert(EdgeKey<false>(e0.index, e1.index));
+                                }
                             }
                         }
                     }
@@ -260,6 +438,195 @@ namespace gte
             }
         }
 
+        // The sweep of Mode::SWEEP.
+        void Sweep()
+        {
+            int const numBoxes = static_cast<int>(mBoxes.size());
+            mOverlapPairs.clear();
+            if (numBoxes == 0)
+            {
+                mHashKeys.clear();
+                return;
+            }
+
+            // Select the axis along which the box centers have the largest
+            // variance. The centers are scaled by 2 to avoid divisions.
+            std::array<Real, 3> sum{ (Real)0, (Real)0, (Real)0 };
+            std::array<Real, 3> sumSqr{ (Real)0, (Real)0, (Real)0 };
+            for (auto const& box : mBoxes)
+            {
+                for (int d = 0; d < 3; ++d)
+                {
+                    Real center = box.min[d] + box.max[d];
+                    sum[d] += center;
+                    sumSqr[d] += center * center;
+                }
+            }
+            Real const numBoxesReal = static_cast<Real>(numBoxes);
+            int axis = 0;
+            Real maxVariance = sumSqr[0] - sum[0] * sum[0] / numBoxesReal;
+            for (int d = 1; d < 3; ++d)
+            {
+                Real variance = sumSqr[d] - sum[d] * sum[d] / numBoxesReal;
+                if (variance > maxVariance)
+                {
+                    maxVariance = variance;
+                    axis = d;
+                }
+            }
+
+            // Sort the boxes by their minima on the sweep axis. When the
+            // axis has not changed, the previous order is nearly sorted.
+            bool presorted = (axis == mSweepAxis && mSweepOrder.size() == mBoxes.size());
+            if (!presorted)
+            {
+                mSweepOrder.resize(mBoxes.size());
+                for (int i = 0; i < numBoxes; ++i)
+                {
+                    mSweepOrder[i].second = i;
+                }
+            }
+            for (auto& element : mSweepOrder)
+            {
+                element.first = mBoxes[element.second].min[axis];
+            }
+            if (!presorted || !InsertionSort(mSweepOrder))
+            {
+                std::sort(mSweepOrder.begin(), mSweepOrder.end());
+            }
+            mSweepAxis = axis;
+
+            // Copy the box extremes in sorted order for the sweep.
+            for (int d = 0; d < 3; ++d)
+            {
+                mSortedMin[d].resize(mBoxes.size());
+                mSortedMax[d].resize(mBoxes.size());
+            }
+            for (int r = 0; r < numBoxes; ++r)
+            {
+                AlignedBox3<Real> const& box = mBoxes[mSweepOrder[r].second];
+                for (int d = 0; d < 3; ++d)
+                {
+                    mSortedMin[d][r] = box.min[d];
+                    mSortedMax[d][r] = box.max[d];
+                }
+            }
+
+            // Sweep blocks of boxes concurrently. The box of rank r overlaps
+            // on the sweep axis the boxes of ranks r+1, r+2, ... whose
+            // minima are not larger than its maximum.
+            int const b0 = (axis + 1) % 3, b1 = (axis + 2) % 3;
+            size_t const numBlocks = (static_cast<size_t>(numBoxes) + msBlockSize - 1) / msBlockSize;
+            std::vector<std::vector<EdgeKey<false>>> blockPairs(numBlocks);
+            TaskScheduler::ParallelForDynamic(mScheduler, numBlocks, mNumThreads,
+                [this, numBoxes, axis, b0, b1, &blockPairs](size_t block)
+                {
+                    Real const* min0 = mSortedMin[axis].data();
+                    Real const* max0 = mSortedMax[axis].data();
+                    Real const* min1 = mSortedMin[b0].data();
+                    Real const* max1 = mSortedMax[b0].data();
+                    Real const* min2 = mSortedMin[b1].data();
+                    Real const* max2 = mSortedMax[b1].data();
+                    std::vector<EdgeKey<false>>& pairs = blockPairs[block];
+                    int rmin = static_cast<int>(block * msBlockSize);
+                    int rmax = std::min(rmin + static_cast<int>(msBlockSize), numBoxes);
+                    for (int r = rmin; r < rmax; ++r)
+                    {
+                        // The candidates are tested without early outs so
+                        // that the compiler can vectorize the loop.
+                        int qmax = r + 1;
+                        while (qmax < numBoxes && min0[qmax] <= max0[r])
+                        {
+                            ++qmax;
+                        }
+                        Real const rmin1 = min1[r], rmax1 = max1[r];
+                        Real const rmin2 = min2[r], rmax2 = max2[r];
+                        for (int q = r + 1; q < qmax; ++q)
+                        {
+                            if ((rmax1 >= min1[q]) & (rmin1 <= max1[q])
+                                & (rmax2 >= min2[q]) & (rmin2 <= max2[q]))
+                            {
+                                pairs.push_back(EdgeKey<false>(
+                                    mSweepOrder[r].second, mSweepOrder[q].second));
+                            }
+                        }
+                    }
+                });
+
+            size_t numPairs = 0;
+            for (auto const& pairs : blockPairs)
+            {
+                numPairs += pairs.size();
+            }
+            mOverlapPairs.reserve(numPairs);
+            for (auto const& pairs : blockPairs)
+            {
+                mOverlapPairs.insert(mOverlapPairs.end(), pairs.begin(), pairs.end());
+            }
+
+            // Build the hash table of pairs with load factor at most 1/2.
+            size_t capacity = 16;
+            mHashShift = 60;
+            while (capacity < 2 * numPairs)
+            {
+                capacity *= 2;
+                --mHashShift;
+            }
+            mHashKeys.assign(capacity, static_cast<uint64_t>(msEmptyHashKey));
+            size_t const mask = capacity - 1;
+            for (auto const& key : mOverlapPairs)
+            {
+                uint64_t hashKey = GetHashKey(key);
+                size_t slot = GetHashSlot(hashKey);
+                while (mHashKeys[slot] != msEmptyHashKey)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                mHashKeys[slot] = hashKey;
+            }
+        }
+
+        // Sort nearly sorted (value,index) pairs. The function returns
+        // 'false' without completing the sort when the number of moves
+        // indicates that the order has changed too much.
+        static bool InsertionSort(std::vector<std::pair<Real, int>>& elements)
+        {
+            size_t const maxMoves = 8 * elements.size();
+            size_t numMoves = 0;
+            for (size_t j = 1; j < elements.size(); ++j)
+            {
+                std::pair<Real, int> key = elements[j];
+                size_t i = j;
+                while (i > 0 && key < elements[i - 1])
+                {
+                    elements[i] = elements[i - 1];
+                    --i;
+                }
+                elements[i] = key;
+                numMoves += j - i;
+                if (numMoves > maxMoves)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline static uint64_t GetHashKey(EdgeKey<false> const& key)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(key.V[0])) << 32)
+                | static_cast<uint64_t>(static_cast<uint32_t>(key.V[1]));
+        }
+
+        inline size_t GetHashSlot(uint64_t hashKey) const
+        {
+            return static_cast<size_t>((hashKey * 0x9E3779B97F4A7C15ull) >> mHashShift);
+        }
+
+        // The number of sorted boxes in a block of the sweep.
+        enum { msBlockSize = 256 };
+        static uint64_t constexpr msEmptyHashKey = std::numeric_limits<uint64_t>::max();
+
         std::vector<AlignedBox3<Real>>& mBoxes;
         std::vector<Endpoint> mXEndpoints, mYEndpoints, mZEndpoints;
         std::set<EdgeKey<false>> mOverlap;
@@ -275,5 +642,20 @@ namespace gte
         // endpoint array.  The value mLookup[2*i+1] is the index of e[i]
         // in the endpoint array.
         std::vector<int> mXLookup, mYLookup, mZLookup;
+
+        Mode mMode;
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
+
+        // The data of Mode::SWEEP. The (value,index) pairs are the minima
+        // on the sweep axis of the boxes in sorted order. The hash table
+        // stores pairs (i,j) as (i << 32) | j, and the slot of a key is
+        // given by the high-order bits of a multiplicative hash.
+        int mSweepAxis;
+        std::vector<std::pair<Real, int>> mSweepOrder;
+        std::array<std::vector<Real>, 3> mSortedMin, mSortedMax;
+        std::vector<EdgeKey<false>> mOverlapPairs;
+        std::vector<uint64_t> mHashKeys;
+        int mHashShift;
     };
 }
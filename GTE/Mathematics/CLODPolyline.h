@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -91,6 +91,19 @@ namespace gte
             return mNumVertices;
         }
 
+        // The change of the level of detail from L0 to L1 vertices modifies
+        // |L1-L0| elements of the edge array, one for each vertex collapse
+        // or split. When vertex v >= GetMinLevelOfDetail() is collapsed,
+        // the endpoint GetCollapseIndices()[v] of the edge array is
+        // replaced by the last endpoint and the last edge is removed. When
+        // v is split, the last edge is restored and the endpoint is set
+        // to v. The vertices are ordered so that vertex v is the one that
+        // is removed when the level of detail decreases from v+1 to v.
+        inline std::vector<int> const& GetCollapseIndices() const
+        {
+            return mIndices;
+        }
+
         void SetLevelOfDetail(int numVertices)
         {
             if (numVertices < mVMin || numVertices > mVMax)
@@ -239,9 +252,11 @@ namespace gte
                         edges[eIndex--] = vIndex;
                     }
 
-                    vIndex = collapses[0];
-                    edges[0] = vIndex;
-                    edges[1] = vIndex + 1;
+                    // The end vertices are collapses[0] and collapses[1],
+                    // in either order, so the remaining segment is the
+                    // one that starts at vertex 0.
+                    edges[0] = 0;
+                    edges[1] = 1;
                 }
 
                 // In the given edge order, find the index in the edge array
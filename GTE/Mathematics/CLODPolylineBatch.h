@@ -0,0 +1,237 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/CLODPolyline.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Continuous level of detail for many polylines, for example the
+// coastlines or contours of a map. The polylines are reduced by the
+// algorithm of CLODPolyline, and their vertices and edges are stored in
+// shared arrays instead of one CLODPolyline object per polyline. The
+// vertices of polyline p are
+//   GetVertices()[GetVertexOffsets()[p]] through
+//   GetVertices()[GetVertexOffsets()[p+1]-1]
+// in the collapse order of CLODPolyline, and its edges are the first
+// 2*GetNumEdges(p) elements of the edge array starting at GetEdges(p). The
+// edges store indices into the shared vertex array, so the vertices can be
+// stored in one vertex buffer and the edges of all polylines drawn from
+// one index buffer. As for CLODPolyline, a change of the level of detail
+// of a polyline modifies only the edges of the vertices that are collapsed
+// or split, so the cost is proportional to the change in the number of
+// vertices.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class CLODPolylineBatch
+    {
+    public:
+        // The polylines are vertices[p] for 0 <= p < vertices.size(), and
+        // closed[p] specifies whether polyline p is closed. The vertex
+        // requirements are those of CLODPolyline. The collapse sequences of
+        // the polylines are computed in numThreads threads or as tasks of
+        // the scheduler when it is not null. The polylines start at their
+        // maximum levels of detail.
+        CLODPolylineBatch(std::vector<std::vector<Vector<N, Real>>> const& vertices,
+            std::vector<bool> const& closed, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+            :
+            mVertexOffsets(vertices.size() + 1, 0),
+            mVertices{},
+            mCollapseIndices{},
+            mEdgeOffsets(vertices.size() + 1, 0),
+            mEdges{},
+            mNumEdges(vertices.size(), 0),
+            mMinLevels(vertices.size(), 0),
+            mLevels(vertices.size(), 0),
+            mScheduler(scheduler),
+            mNumThreads(std::max(numThreads, static_cast<size_t>(1)))
+        {
+            LogAssert(closed.size() == vertices.size(), "Invalid inputs.");
+
+            size_t const numPolylines = vertices.size();
+            for (size_t p = 0; p < numPolylines; ++p)
+            {
+                size_t const numVertices = vertices[p].size();
+                size_t const numEdges = (closed[p] ? numVertices : numVertices - 1);
+                mVertexOffsets[p + 1] = mVertexOffsets[p] + numVertices;
+                mEdgeOffsets[p + 1] = mEdgeOffsets[p] + 2 * numEdges;
+            }
+            mVertices.resize(mVertexOffsets[numPolylines]);
+            mCollapseIndices.resize(mVertexOffsets[numPolylines]);
+            mEdges.resize(mEdgeOffsets[numPolylines]);
+
+            Execute(numPolylines, [this, &vertices, &closed](size_t p)
+            {
+                CLODPolyline<N, Real> polyline(vertices[p], closed[p]);
+                int const vertexOffset = static_cast<int>(mVertexOffsets[p]);
+                std::copy(polyline.GetVertices().begin(), polyline.GetVertices().end(),
+                    mVertices.begin() + mVertexOffsets[p]);
+                std::copy(polyline.GetCollapseIndices().begin(),
+                    polyline.GetCollapseIndices().end(),
+                    mCollapseIndices.begin() + mVertexOffsets[p]);
+                auto const& edges = polyline.GetEdges();
+                for (size_t e = 0; e < edges.size(); ++e)
+                {
+                    mEdges[mEdgeOffsets[p] + e] = edges[e] + vertexOffset;
+                }
+                mNumEdges[p] = polyline.GetNumEdges();
+                mMinLevels[p] = polyline.GetMinLevelOfDetail();
+                mLevels[p] = polyline.GetMaxLevelOfDetail();
+            });
+        }
+
+        // Member access.
+        inline size_t GetNumPolylines() const
+        {
+            return mLevels.size();
+        }
+
+        inline std::vector<Vector<N, Real>> const& GetVertices() const
+        {
+            return mVertices;
+        }
+
+        inline std::vector<size_t> const& GetVertexOffsets() const
+        {
+            return mVertexOffsets;
+        }
+
+        inline int GetNumEdges(size_t p) const
+        {
+            return mNumEdges[p];
+        }
+
+        inline int const* GetEdges(size_t p) const
+        {
+            return mEdges.data() + mEdgeOffsets[p];
+        }
+
+        // Accessors to the level of detail of polyline p, which is its
+        // number of vertices (MinLOD <= LOD <= MaxLOD is required).
+        inline int GetMinLevelOfDetail(size_t p) const
+        {
+            return mMinLevels[p];
+        }
+
+        inline int GetMaxLevelOfDetail(size_t p) const
+        {
+            return static_cast<int>(mVertexOffsets[p + 1] - mVertexOffsets[p]);
+        }
+
+        inline int GetLevelOfDetail(size_t p) const
+        {
+            return mLevels[p];
+        }
+
+        // Set the level of detail of polyline p. The call is ignored when
+        // the level is out of range.
+        void SetLevelOfDetail(size_t p, int numVertices)
+        {
+            if (numVertices < mMinLevels[p] || numVertices > GetMaxLevelOfDetail(p))
+            {
+                return;
+            }
+
+            int* edges = mEdges.data() + mEdgeOffsets[p];
+            int const* collapseIndices = mCollapseIndices.data() + mVertexOffsets[p];
+            int const vertexOffset = static_cast<int>(mVertexOffsets[p]);
+            int& level = mLevels[p];
+            int& numEdges = mNumEdges[p];
+
+            // Decrease the level of detail.
+            while (level > numVertices)
+            {
+                --level;
+                edges[collapseIndices[level]] = edges[2 * numEdges - 1];
+                --numEdges;
+            }
+
+            // Increase the level of detail.
+            while (level < numVertices)
+            {
+                ++numEdges;
+                edges[collapseIndices[level]] = level + vertexOffset;
+                ++level;
+            }
+        }
+
+        // Set the levels of detail of all polylines, levels[p] for
+        // polyline p. The polylines are partitioned among the threads.
+        void SetLevelsOfDetail(int const* levels)
+        {
+            Execute(GetNumPolylines(), [this, levels](size_t p)
+            {
+                SetLevelOfDetail(p, levels[p]);
+            });
+        }
+
+        // Set the level of detail of each polyline to the fraction t in
+        // [0,1] of its range, rounded to the nearest level: t = 0 selects
+        // the minimum levels and t = 1 selects the maximum levels.
+        void SetLevelsOfDetail(Real t)
+        {
+            t = std::min(std::max(t, (Real)0), (Real)1);
+            Execute(GetNumPolylines(), [this, t](size_t p)
+            {
+                int const minLevel = mMinLevels[p];
+                int const maxLevel = GetMaxLevelOfDetail(p);
+                Real const delta = t * static_cast<Real>(maxLevel - minLevel);
+                SetLevelOfDetail(p, minLevel + static_cast<int>(std::floor(delta + (Real)0.5)));
+            });
+        }
+
+    private:
+        // Execute function(p) for 0 <= p < numPolylines, the polylines
+        // partitioned into contiguous ranges.
+        template <typename Function>
+        void Execute(size_t numPolylines, Function const& function)
+        {
+            size_t numChunks = mNumThreads;
+            if (mScheduler != nullptr)
+            {
+                numChunks = static_cast<size_t>(mScheduler->GetNumThreads());
+            }
+            numChunks = std::max(std::min(numChunks, numPolylines), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [numPolylines, numChunks, &function](size_t chunk)
+                {
+                    size_t const pmin = numPolylines * chunk / numChunks;
+                    size_t const pmax = numPolylines * (chunk + 1) / numChunks;
+                    for (size_t p = pmin; p < pmax; ++p)
+                    {
+                        function(p);
+                    }
+                });
+        }
+
+        // The vertices of the polylines, in the collapse order of each
+        // polyline, and the positions in the edge array of the endpoints
+        // modified by the collapses.
+        std::vector<size_t> mVertexOffsets;
+        std::vector<Vector<N, Real>> mVertices;
+        std::vector<int> mCollapseIndices;
+
+        // The edges of the polylines, storing indices into mVertices.
+        std::vector<size_t> mEdgeOffsets;
+        std::vector<int> mEdges;
+        std::vector<int> mNumEdges;
+
+        // The level of detail information.
+        std::vector<int> mMinLevels;
+        std::vector<int> mLevels;
+
+        TaskScheduler* mScheduler;
+        size_t mNumThreads;
+    };
+}
@@ -0,0 +1,304 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <vector>
+
+// A sparse matrix in compressed sparse row (CSR) format. The column indices
+// and values of the nonzero entries of row r are at the indices i of the
+// arrays GetColumns() and GetValues() with GetRowOffsets()[r] <= i <
+// GetRowOffsets()[r+1], sorted by column. The compressed sparse column
+// (CSC) format of a matrix is the CSR format of its transpose, which is
+// computed by GetTranspose().
+//
+// The sparsity structure is fixed at construction. The values may be
+// modified through GetValues(), which allows a matrix with a fixed
+// structure but time-varying values (for example, the Jacobian of an
+// implicit integrator) to be assembled without reallocation; use
+// GetIndex(r,c) to locate the entries.
+//
+// The matrix-vector products partition the rows among the threads of an
+// optional TaskScheduler. Each element of the output is computed by one
+// thread with the terms added in column order, so the results do not
+// depend on the number of threads.
+
+namespace gte
+{
+    template <typename Real>
+    class CSRMatrix
+    {
+    public:
+        // An entry (row,column,value) of the matrix.
+        struct Triplet
+        {
+            Triplet() = default;
+
+            Triplet(int inRow, int inColumn, Real const& inValue)
+                :
+                row(inRow),
+                column(inColumn),
+                value(inValue)
+            {
+            }
+
+            int row, column;
+            Real value;
+        };
+
+        // The matrix is 0-by-0.
+        CSRMatrix()
+            :
+            mNumRows(0),
+            mNumCols(0),
+            mRowOffsets(1, 0)
+        {
+        }
+
+        // Create the matrix from its entries. The triplets may be in any
+        // order, and the values of triplets with the same row and column
+        // are added. Entries with zero values are stored.
+        CSRMatrix(int numRows, int numCols, std::vector<Triplet> const& triplets)
+        {
+            Create(numRows, numCols, triplets);
+        }
+
+        // Create the matrix from the std::map representation used by
+        // LinearSystem::SolveSymmetricCG. When 'symmetric' is 'true', only
+        // one of the entries (i,j) and (j,i) is stored in the map and both
+        // are created.
+        CSRMatrix(int numRows, int numCols, std::map<std::array<int, 2>, Real> const& entries,
+            bool symmetric)
+        {
+            std::vector<Triplet> triplets;
+            triplets.reserve(symmetric ? 2 * entries.size() : entries.size());
+            for (auto const& element : entries)
+            {
+                int i = element.first[0];
+                int j = element.first[1];
+                triplets.push_back(Triplet(i, j, element.second));
+                if (symmetric && i != j)
+                {
+                    triplets.push_back(Triplet(j, i, element.second));
+                }
+            }
+            Create(numRows, numCols, triplets);
+        }
+
+        void Create(int numRows, int numCols, std::vector<Triplet> const& triplets)
+        {
+            LogAssert(numRows >= 0 && numCols >= 0, "Invalid input.");
+            mNumRows = numRows;
+            mNumCols = numCols;
+
+            // Sort the triplets by row with a counting sort and then each
+            // row by column.
+            mRowOffsets.assign(static_cast<size_t>(numRows) + 1, 0);
+            for (auto const& triplet : triplets)
+            {
+                LogAssert(0 <= triplet.row && triplet.row < numRows &&
+                    0 <= triplet.column && triplet.column < numCols, "Invalid index.");
+                ++mRowOffsets[static_cast<size_t>(triplet.row) + 1];
+            }
+            for (int r = 0; r < numRows; ++r)
+            {
+                mRowOffsets[r + 1] += mRowOffsets[r];
+            }
+
+            std::vector<size_t> next(mRowOffsets.begin(), mRowOffsets.end() - 1);
+            std::vector<std::pair<int, Real>> sorted(triplets.size());
+            for (auto const& triplet : triplets)
+            {
+                sorted[next[triplet.row]++] = std::make_pair(triplet.column, triplet.value);
+            }
+
+            // Combine the duplicates.
+            mColumns.clear();
+            mValues.clear();
+            mColumns.reserve(sorted.size());
+            mValues.reserve(sorted.size());
+            size_t first = 0;
+            for (int r = 0; r < numRows; ++r)
+            {
+                size_t last = mRowOffsets[r + 1];
+                std::stable_sort(sorted.begin() + first, sorted.begin() + last,
+                    [](std::pair<int, Real> const& e0, std::pair<int, Real> const& e1)
+                    {
+                        return e0.first < e1.first;
+                    });
+
+                mRowOffsets[r] = mColumns.size();
+                for (size_t i = first; i < last; ++i)
+                {
+                    if (i > first && sorted[i].first == mColumns.back())
+                    {
+                        mValues.back() += sorted[i].second;
+                    }
+                    else
+                    {
+                        mColumns.push_back(sorted[i].first);
+                        mValues.push_back(sorted[i].second);
+                    }
+                }
+                first = last;
+            }
+            mRowOffsets[numRows] = mColumns.size();
+        }
+
+        // Member access.
+        inline int GetNumRows() const
+        {
+            return mNumRows;
+        }
+
+        inline int GetNumCols() const
+        {
+            return mNumCols;
+        }
+
+        inline size_t GetNumNonzeros() const
+        {
+            return mColumns.size();
+        }
+
+        inline std::vector<size_t> const& GetRowOffsets() const
+        {
+            return mRowOffsets;
+        }
+
+        inline std::vector<int> const& GetColumns() const
+        {
+            return mColumns;
+        }
+
+        inline std::vector<Real> const& GetValues() const
+        {
+            return mValues;
+        }
+
+        inline std::vector<Real>& GetValues()
+        {
+            return mValues;
+        }
+
+        // The index of entry (r,c) in GetColumns() and GetValues(), or
+        // GetNumNonzeros() when the entry is not stored.
+        size_t GetIndex(int r, int c) const
+        {
+            if (0 <= r && r < mNumRows)
+            {
+                auto begin = mColumns.begin() + mRowOffsets[r];
+                auto end = mColumns.begin() + mRowOffsets[static_cast<size_t>(r) + 1];
+                auto iter = std::lower_bound(begin, end, c);
+                if (iter != end && *iter == c)
+                {
+                    return static_cast<size_t>(iter - mColumns.begin());
+                }
+            }
+            return mColumns.size();
+        }
+
+        // The value of entry (r,c), which is 0 when it is not stored.
+        Real operator()(int r, int c) const
+        {
+            size_t i = GetIndex(r, c);
+            return (i < mValues.size() ? mValues[i] : (Real)0);
+        }
+
+        // The diagonal entries, 0 for those not stored.
+        void GetDiagonal(std::vector<Real>& diagonal) const
+        {
+            int const numDiagonal = std::min(mNumRows, mNumCols);
+            diagonal.resize(numDiagonal);
+            for (int i = 0; i < numDiagonal; ++i)
+            {
+                diagonal[i] = operator()(i, i);
+            }
+        }
+
+        // The transpose, which is the CSC format of the matrix.
+        CSRMatrix GetTranspose() const
+        {
+            std::vector<Triplet> triplets(mColumns.size());
+            for (int r = 0; r < mNumRows; ++r)
+            {
+                for (size_t i = mRowOffsets[r]; i < mRowOffsets[static_cast<size_t>(r) + 1]; ++i)
+                {
+                    triplets[i] = Triplet(mColumns[i], r, mValues[i]);
+                }
+            }
+            return CSRMatrix(mNumCols, mNumRows, triplets);
+        }
+
+        // Compute Y = A*X, where X has GetNumCols() elements and Y has
+        // GetNumRows() elements. The rows are partitioned among the threads
+        // of the scheduler when it is not null.
+        void Multiply(Real const* X, Real* Y, TaskScheduler* scheduler = nullptr) const
+        {
+            ExecuteRows(scheduler, [this, X, Y](int r0, int r1)
+            {
+                for (int r = r0; r < r1; ++r)
+                {
+                    Real sum = (Real)0;
+                    for (size_t i = mRowOffsets[r]; i < mRowOffsets[static_cast<size_t>(r) + 1]; ++i)
+                    {
+                        sum += mValues[i] * X[mColumns[i]];
+                    }
+                    Y[r] = sum;
+                }
+            });
+        }
+
+        // Execute function(r0,r1) for subranges [r0,r1) of the rows, in
+        // parallel when the scheduler is not null. The subranges have
+        // approximately the same number of nonzero entries.
+        template <typename Function>
+        void ExecuteRows(TaskScheduler* scheduler, Function const& function) const
+        {
+            size_t const numChunks = (scheduler ? 4 * scheduler->GetNumThreads() : 1);
+            if (numChunks <= 1 || mColumns.size() < 4096)
+            {
+                function(0, mNumRows);
+                return;
+            }
+
+            // Chunk c starts at the first row whose offset is at least
+            // c * numNonzeros / numChunks.
+            std::vector<int> start(numChunks + 1);
+            for (size_t c = 0; c < numChunks; ++c)
+            {
+                size_t offset = c * mColumns.size() / numChunks;
+                start[c] = static_cast<int>(std::upper_bound(mRowOffsets.begin(),
+                    mRowOffsets.end() - 1, offset) - mRowOffsets.begin()) - 1;
+            }
+            start[numChunks] = mNumRows;
+
+            TaskScheduler::TaskGroup group;
+            for (size_t c = 1; c < numChunks; ++c)
+            {
+                int r0 = start[c], r1 = start[c + 1];
+                if (r0 < r1)
+                {
+                    scheduler->Spawn(group, [&function, r0, r1]() { function(r0, r1); });
+                }
+            }
+            function(start[0], start[1]);
+            scheduler->Wait(group);
+        }
+
+    private:
+        int mNumRows, mNumCols;
+        std::vector<size_t> mRowOffsets;
+        std::vector<int> mColumns;
+        std::vector<Real> mValues;
+    };
+}
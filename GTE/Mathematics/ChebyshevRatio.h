@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Let f(t,A) = sin(t*A)/sin(A).  The slerp of quaternions q0 and q1 is
 //   slerp(t,q0,q1) = f(1-t,A)*q0 + f(t,A)*q1.
@@ -71,6 +72,21 @@ namespace gte
         // {1..16}.  The degree in t is 2*N+1 and the degree in Y is N.
         template <int N>
         static void GetEstimate(Real t, Real y, Real & f0, Real & f1)
+        {
+            Estimate<N>(t, y, f0, f1);
+        }
+
+        // Compute the estimates in the 4 lanes of a SIMD4Value.
+        template <int N>
+        static void GetEstimate(SIMD4Value<Real> const& t, SIMD4Value<Real> const& y,
+            SIMD4Value<Real>& f0, SIMD4Value<Real>& f1)
+        {
+            Estimate<N>(t, y, f0, f1);
+        }
+
+    private:
+        template <int N, typename T>
+        static void Estimate(T const& t, T const& y, T& f0, T& f1)
         {
             static_assert(1 <= N && N <= 16, "Invalid degree.");
 
@@ -139,16 +155,16 @@ namespace gte
                 (N != 16 ? (Real)1 : onePlusMu[15]) * (Real)16 / (Real)33
             };
 
-            Real term0 = (Real)1 - t, term1 = t;
-            Real sqr0 = term0 * term0, sqr1 = term1 * term1;
+            T term0 = (Real)1 - t, term1 = t;
+            T sqr0 = term0 * term0, sqr1 = term1 * term1;
             f0 = term0;
             f1 = term1;
             for (int i = 0; i < N; ++i)
             {
-                term0 *= (b[i] - a[i] * sqr0) * y;
-                term1 *= (b[i] - a[i] * sqr1) * y;
-                f0 += term0;
-                f1 += term1;
+                term0 = term0 * ((b[i] - a[i] * sqr0) * y);
+                term1 = term1 * ((b[i] - a[i] * sqr1) * y);
+                f0 = f0 + term0;
+                f1 = f1 + term1;
             }
         }
     };
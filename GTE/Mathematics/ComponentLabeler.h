@@ -0,0 +1,264 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Image.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Connected component labeling of binary images using a block-parallel
+// two-pass union-find algorithm. ImageUtility2::GetComponents4/8 and
+// ImageUtility3::GetComponents6/18/26 use this when they are passed more
+// than one thread. The output is the same as that of the single-threaded
+// depth-first search: the components are labeled 1, 2, ... in the order of
+// their first pixels in lexicographical order, and components[k], k >= 1,
+// contains the sorted indices of the pixels with label k.
+//
+// The pixels are partitioned into blocks of consecutive indices. Each
+// pixel is united with its neighbors that precede it, where the sets are
+// represented by their smallest pixel index.
+//   1. In parallel, each block unites the neighbors within the block and
+//      flattens its trees, so each pixel points to its block-local root.
+//   2. Serially, the pixels at the start of each block are united with
+//      their neighbors in preceding blocks. Only the parents of the
+//      block-local roots change.
+//   3. Serially, the block-local roots are labeled in increasing order.
+//   4. In parallel, each block copies the labels of its roots to the
+//      remaining pixels.
+// The blocks are processed by numThreads threads, which are tasks of the
+// scheduler when it is not null. The neighbor offsets must be those of
+// Image2::GetNeighborhood or Image3::GetNeighborhood, and the image must
+// have zeros on its boundary.
+
+namespace gte
+{
+    class ComponentLabeler
+    {
+    public:
+        static void GetComponents(int numNeighbors, int const* delta, Image<int>& image,
+            std::vector<std::vector<size_t>>& components, size_t numThreads,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(numNeighbors > 0 && delta != nullptr, "Invalid input.");
+
+            // The neighbors that precede a pixel have negative offsets.
+            std::vector<std::ptrdiff_t> backward;
+            std::ptrdiff_t maxBackward = 0;
+            for (int j = 0; j < numNeighbors; ++j)
+            {
+                if (delta[j] < 0)
+                {
+                    backward.push_back(delta[j]);
+                    maxBackward = std::max(maxBackward, static_cast<std::ptrdiff_t>(-delta[j]));
+                }
+            }
+            LogAssert(backward.size() <= 32, "Invalid input.");
+
+            // Two preceding neighbors of a pixel that are neighbors of each
+            // other are already in the same set when they are in the same
+            // block, so after the pixel is united with one of them, the
+            // other is skipped. adjacent[j] is the bit mask of the preceding
+            // neighbors that are neighbors of preceding neighbor j. The
+            // differences of the offsets correspond to unique coordinate
+            // differences only when the dimensions, except the last, are at
+            // least 5; otherwise, no neighbors are skipped.
+            std::vector<uint32_t> adjacent(backward.size(), 0);
+            bool canSkip = true;
+            for (int d = 0; d + 1 < image.GetNumDimensions(); ++d)
+            {
+                canSkip = canSkip && image.GetDimension(d) >= 5;
+            }
+            if (canSkip)
+            {
+                for (size_t j0 = 0; j0 < backward.size(); ++j0)
+                {
+                    for (size_t j1 = 0; j1 < backward.size(); ++j1)
+                    {
+                        std::ptrdiff_t const diff = backward[j1] - backward[j0];
+                        for (int j = 0; j < numNeighbors; ++j)
+                        {
+                            if (diff == delta[j])
+                            {
+                                adjacent[j0] |= (1u << j1);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            size_t const numPixels = image.GetNumPixels();
+            size_t const numBlocks = std::max(std::min(msBlocksPerThread * numThreads,
+                numPixels / msMinBlockSize), static_cast<size_t>(1));
+            size_t const blockSize = (numPixels + numBlocks - 1) / numBlocks;
+            int* pixels = image.GetPixels().data();
+            std::vector<size_t> parent(numPixels);
+            std::vector<std::vector<size_t>> roots(numBlocks);
+
+            // Pass 1: unite the pixels within each block.
+            TaskScheduler::ParallelForDynamic(scheduler, numBlocks, numThreads, [&](size_t b)
+            {
+                size_t const begin = b * blockSize;
+                size_t const end = std::min(begin + blockSize, numPixels);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (pixels[i] == 1)
+                    {
+                        // The root of the set of i is tracked, so each
+                        // neighbor that is not skipped costs one find.
+                        size_t root = i;
+                        uint32_t skip = 0;
+                        for (size_t j = 0; j < backward.size(); ++j)
+                        {
+                            size_t const k = static_cast<size_t>(static_cast<std::ptrdiff_t>(i) + backward[j]);
+                            if ((skip & (1u << j)) == 0 && k >= begin && pixels[k] == 1)
+                            {
+                                root = Link(parent, root, Find(parent, k));
+                                skip |= adjacent[j];
+                            }
+                        }
+                        parent[i] = root;
+                    }
+                }
+
+                // The parent of a pixel precedes it, so the pixels in
+                // increasing order point to their roots after one pass.
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (pixels[i] == 1)
+                    {
+                        parent[i] = parent[parent[i]];
+                        if (parent[i] == i)
+                        {
+                            roots[b].push_back(i);
+                        }
+                    }
+                }
+            });
+
+            // Pass 2: unite the pixels with their neighbors in the preceding
+            // blocks. A pixel points to its block-local root, so the finds
+            // start at the roots and compress only the paths of roots.
+            for (size_t b = 1; b < numBlocks; ++b)
+            {
+                size_t const begin = b * blockSize;
+                size_t const end = std::min(begin + static_cast<size_t>(maxBackward), numPixels);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (pixels[i] == 1)
+                    {
+                        for (auto d : backward)
+                        {
+                            size_t const k = static_cast<size_t>(static_cast<std::ptrdiff_t>(i) + d);
+                            if (k < begin && pixels[k] == 1)
+                            {
+                                Unite(parent, parent[i], parent[k]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Pass 3: label the block-local roots. The parent of a root is
+            // a root that precedes it, so its label is already known.
+            int numComponents = 0;
+            for (auto const& blockRoots : roots)
+            {
+                for (auto r : blockRoots)
+                {
+                    pixels[r] = (parent[r] == r ? ++numComponents : pixels[parent[r]]);
+                }
+            }
+
+            // Pass 4: copy the labels of the roots to the other pixels. The
+            // parent of a non-root pixel is a root in the same block. A root
+            // whose parent is in the block is relabeled with the same label.
+            TaskScheduler::ParallelForDynamic(scheduler, numBlocks, numThreads, [&](size_t b)
+            {
+                size_t const begin = b * blockSize;
+                size_t const end = std::min(begin + blockSize, numPixels);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (pixels[i] != 0 && parent[i] != i && parent[i] >= begin)
+                    {
+                        pixels[i] = pixels[parent[i]];
+                    }
+                }
+            });
+
+            if (numComponents > 0)
+            {
+                std::vector<size_t> numElements(static_cast<size_t>(numComponents) + 1, 0);
+                for (size_t i = 0; i < numPixels; ++i)
+                {
+                    ++numElements[pixels[i]];
+                }
+
+                components.resize(static_cast<size_t>(numComponents) + 1);
+                for (size_t k = 1; k < components.size(); ++k)
+                {
+                    components[k].resize(numElements[k]);
+                    numElements[k] = 0;
+                }
+
+                for (size_t i = 0; i < numPixels; ++i)
+                {
+                    int const label = pixels[i];
+                    if (label != 0)
+                    {
+                        components[label][numElements[label]++] = i;
+                    }
+                }
+            }
+        }
+
+    private:
+        enum
+        {
+            msBlocksPerThread = 4,
+            msMinBlockSize = 4096
+        };
+
+        // Unite the sets of i and k, where the root with the larger index
+        // is attached to the root with the smaller index. The finds use path
+        // halving.
+        static void Unite(std::vector<size_t>& parent, size_t i, size_t k)
+        {
+            Link(parent, Find(parent, i), Find(parent, k));
+        }
+
+        // Attach the root with the larger index to the root with the
+        // smaller index and return the smaller index.
+        static size_t Link(std::vector<size_t>& parent, size_t ri, size_t rk)
+        {
+            if (ri < rk)
+            {
+                parent[rk] = ri;
+                return ri;
+            }
+            else
+            {
+                parent[ri] = rk;
+                return rk;
+            }
+        }
+
+        static size_t Find(std::vector<size_t>& parent, size_t i)
+        {
+            while (parent[i] != i)
+            {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -11,6 +11,7 @@
 #include <Mathematics/ETManifoldMesh.h>
 #include <Mathematics/LinearSystem.h>
 #include <Mathematics/Polynomial1.h>
+#include <Mathematics/SparseCholesky.h>
 #include <Mathematics/Vector2.h>
 #include <Mathematics/Vector3.h>
 
@@ -41,9 +42,11 @@ namespace gte
         {
         }
 
-        // The returned 'bool' value is 'true' whenever the conjugate gradient
-        // algorithm converged.  Even if it did not, the results might still
-        // be acceptable.
+        // The returned 'bool' value is 'true' whenever the linear systems
+        // were solved, either by the sparse Cholesky factorization or by the
+        // conjugate gradient algorithm when the factorization fails.  Even if
+        // the conjugate gradient algorithm did not converge, the results
+        // might still be acceptable.
         bool operator()(int numPositions, Vector3<Real> const* positions,
             int numTriangles, int const* indices, int punctureTriangle)
         {
@@ -134,41 +137,55 @@ namespace gte
             Real re2 = (Real)0;
             Real im2 = -len10 * invLenNormal;
 
-            // Solve the sparse system for the real parts.
-            unsigned int const maxIterations = 1024;
-            Real const tolerance = 1e-06f;
-            std::fill(tmp.begin(), tmp.end(), (Real)0);
-            tmp[v0] = re0;
-            tmp[v1] = re1;
-            tmp[v2] = re2;
-            std::vector<Real> result(numPositions);
-            unsigned int iterations = LinearSystem<Real>().SolveSymmetricCG(
-                numPositions, A, tmp.data(), result.data(), maxIterations, tolerance);
-            if (iterations >= maxIterations)
+            // Solve the sparse systems for the real parts and the imaginary
+            // parts, which have the same matrix. The sparse Cholesky
+            // factorization is computed once for both right-hand sides. The
+            // conjugate gradient method is used when the factorization
+            // fails, which happens only for degenerate meshes.
+            int const N = numPositions;
+            std::vector<Real> rhs(2 * static_cast<size_t>(N), (Real)0);
+            std::vector<Real> result(rhs.size());
+            rhs[v0] = re0;
+            rhs[v1] = re1;
+            rhs[v2] = re2;
+            rhs[static_cast<size_t>(N) + v0] = -im0;
+            rhs[static_cast<size_t>(N) + v1] = -im1;
+            rhs[static_cast<size_t>(N) + v2] = -im2;
+
+            SparseCholesky<Real> cholesky;
+            if (FactorGrounded(N, A, cholesky))
             {
-                LogWarning("Conjugate gradient solver did not converge.");
-                converged = false;
+                std::vector<Real> groundedRHS(rhs);
+                groundedRHS[0] = (Real)0;
+                groundedRHS[N] = (Real)0;
+                cholesky.Solve(2, groundedRHS.data(), result.data());
+                RemoveMean(N, result.data());
+                RemoveMean(N, result.data() + N);
             }
-            for (i = 0; i < numPositions; ++i)
+            else
             {
-                mPlaneCoordinates[i][0] = result[i];
+                unsigned int const maxIterations = 1024;
+                Real const tolerance = 1e-06f;
+                CSRMatrix<Real> sparseA(N, N, A, true);
+                for (int part = 0; part < 2; ++part)
+                {
+                    Real* X = result.data() + static_cast<size_t>(part) * N;
+                    unsigned int iterations = LinearSystem<Real>::SolveSymmetricCG(sparseA,
+                        rhs.data() + static_cast<size_t>(part) * N, X, maxIterations, tolerance,
+                        LinearSystem<Real>::Preconditioner::JACOBI);
+                    if (iterations > maxIterations)
+                    {
+                        LogWarning("Conjugate gradient solver did not converge.");
+                        converged = false;
+                    }
+                    RemoveMean(N, X);
+                }
             }
 
-            // Solve the sparse system for the imaginary parts.
-            std::fill(tmp.begin(), tmp.end(), (Real)0);
-            tmp[v0] = -im0;
-            tmp[v1] = -im1;
-            tmp[v2] = -im2;
-            iterations = LinearSystem<Real>().SolveSymmetricCG(numPositions, A,
-                tmp.data(), result.data(), maxIterations, tolerance);
-            if (iterations >= maxIterations)
-            {
-                LogWarning("Conjugate gradient solver did not converge.");
-                converged = false;
-            }
             for (i = 0; i < numPositions; ++i)
             {
-                mPlaneCoordinates[i][1] = result[i];
+                mPlaneCoordinates[i][0] = result[i];
+                mPlaneCoordinates[i][1] = result[static_cast<size_t>(N) + i];
             }
 
             // Scale to [-1,1]^2 for numerical conditioning in later steps.
@@ -307,6 +324,49 @@ namespace gte
         }
 
     private:
+        // The Laplacian A is singular with the constant vectors as its null
+        // space. The matrix obtained by replacing row and column 0 of A by
+        // those of the identity matrix is positive definite for a connected
+        // mesh. The rows of A and the right-hand sides sum to zero, so the
+        // solution of the modified system with B[0] = 0 is a solution of
+        // A*X = B. The solution with zero mean, which is the one computed by
+        // the conjugate gradient method started at zero, is obtained by
+        // subtracting its mean.
+        static bool FactorGrounded(int N, typename LinearSystem<Real>::SparseMatrix const& A,
+            SparseCholesky<Real>& cholesky)
+        {
+            std::vector<typename CSRMatrix<Real>::Triplet> triplets;
+            triplets.reserve(2 * A.size());
+            triplets.push_back(typename CSRMatrix<Real>::Triplet(0, 0, (Real)1));
+            for (auto const& element : A)
+            {
+                int r = element.first[0], c = element.first[1];
+                if (r != 0 && c != 0)
+                {
+                    triplets.push_back(typename CSRMatrix<Real>::Triplet(r, c, element.second));
+                    if (r != c)
+                    {
+                        triplets.push_back(typename CSRMatrix<Real>::Triplet(c, r, element.second));
+                    }
+                }
+            }
+            return cholesky.Factor(CSRMatrix<Real>(N, N, triplets));
+        }
+
+        static void RemoveMean(int N, Real* X)
+        {
+            Real mean = (Real)0;
+            for (int i = 0; i < N; ++i)
+            {
+                mean += X[i];
+            }
+            mean /= static_cast<Real>(N);
+            for (int i = 0; i < N; ++i)
+            {
+                X[i] -= mean;
+            }
+        }
+
         void ComputeSphereRadius(int v0, int v1, int v2, Real areaFraction)
         {
             Vector2<Real> V0 = mPlaneCoordinates[v0];
@@ -3,11 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Delaunay2.h>
+#include <Mathematics/TaskScheduler.h>
+#include <numeric>
 
 // Compute the Delaunay triangulation of the input point and then insert
 // edges that are constrained to be in the triangulation. For each such
@@ -17,6 +19,11 @@
 // with the retriangulation of the first edge. Although the code here
 // will do what is requested, a pair of such edges usually indicates the
 // upstream process that generated the edges is not doing what it should.
+//
+// For many constrained edges, such as the polylines of a GIS dataset, use
+// the batch Insert(edges, partitionedEdges, numThreads) of the class
+// ConstrainedDelaunay2<T>. The edges whose triangle strips do not overlap
+// are retriangulated in parallel.
 
 namespace gte
 {
@@ -556,7 +563,11 @@ namespace gte
             :
             Delaunay2<T>(),
             mInsertedEdges{},
-            mCRPool(maxNumCRPool)
+            mWorkspace{},
+            mStep{},
+            mWorkspaces{},
+            mSteps{},
+            mClaimedTriangles{}
         {
         }
 
@@ -587,11 +598,7 @@ namespace gte
         // partitionedEdge.back() = edge[1].
         void Insert(std::array<int32_t, 2> edge, std::vector<int32_t>& partitionedEdge)
         {
-            LogAssert(
-                edge[0] != edge[1] &&
-                0 <= edge[0] && edge[0] < static_cast<int32_t>(this->GetNumVertices()) &&
-                0 <= edge[1] && edge[1] < static_cast<int32_t>(this->GetNumVertices()),
-                "Invalid edge.");
+            ValidateEdge(edge);
 
             // The partitionedEdge vector stores the endpoints of the incoming
             // edge if that edge does not contain interior points that are
@@ -600,94 +607,146 @@ namespace gte
             // into subedges, each subedge having vertex endpoints but no
             // interior point is a vertex. The partition is stored in the
             // partitionedEdge vector.
-            std::vector<std::array<int32_t, 2>> partition;
+            partitionedEdge.clear();
+            partitionedEdge.push_back(edge[0]);
 
             // When using exact arithmetic, a while(!edgeConsumed) loop
             // suffices. Just in case the code has a bug, guard against an
             // infinite loop.
-            bool edgeConsumed = false;
             size_t const numTriangles = this->mGraph.GetTriangles().size();
             size_t t;
-            for (t = 0; t < numTriangles && !edgeConsumed; ++t)
+            for (t = 0; t < numTriangles; ++t)
             {
-                EdgeKey<false> ekey(edge[0], edge[1]);
-                if (this->mGraph.GetEdges().find(ekey) != this->mGraph.GetEdges().end())
+                ComputeStep(edge, mStep, mWorkspace);
+                ApplyStep(mStep);
+                partitionedEdge.push_back(mStep.subedge[1]);
+                if (mStep.edgeConsumed)
                 {
-                    // The edge already exists in the triangulation.
-                    mInsertedEdges.insert(ekey);
-                    partition.push_back(edge);
                     break;
                 }
+                edge = mStep.edge;
+            }
+            LogAssert(t < numTriangles, CDTMessage());
+        }
 
-                // Get the link edges for the vertex edge[0]. These edges are
-                // opposite the link vertex.
-                std::vector<std::array<int32_t, 2>> linkEdges;
-                GetLinkEdges(edge[0], linkEdges);
+        // Insert a batch of constrained edges, which is faster than calling
+        // Insert(edge, partitionedEdge) for each edge when there are many
+        // edges. The output partitionedEdges[i] is the partition of edges[i]
+        // as described for the single-edge Insert(...).
+        //
+        // The edges are inserted in rounds. In each round, the first pending
+        // subedge of each edge is located and the retriangulation of its
+        // triangle strip is computed; this is the expensive part of the
+        // insertion because of the exact arithmetic, and it does not modify
+        // the triangulation, so the pending edges are partitioned into
+        // numThreads contiguous subsets that are processed in parallel, as
+        // tasks of the scheduler when it is not null. The retriangulations
+        // are then applied in the order of the edges, skipping those whose
+        // triangle strips overlap the strip of an earlier edge of the round.
+        // The skipped edges are processed in a later round. Set numThreads to
+        // 0 or 1 to insert the edges one at a time in the calling thread,
+        // which avoids recomputing the steps of skipped edges.
+        //
+        // The resulting triangulation contains all the edges. When the
+        // triangle strips of the edges overlap, it can differ from that
+        // obtained by inserting the edges one at a time, because an edge
+        // with interior vertices has its subedges inserted in different
+        // rounds.
+        void Insert(std::vector<std::array<int32_t, 2>> const& edges,
+            std::vector<std::vector<int32_t>>& partitionedEdges, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            for (auto const& edge : edges)
+            {
+                ValidateEdge(edge);
+            }
 
-                // Determine which link triangle contains the to-be-inserted
-                // edge.
-                for (auto const& linkEdge : linkEdges)
+            size_t const numEdges = edges.size();
+            partitionedEdges.resize(numEdges);
+            if (numThreads <= 1)
+            {
+                for (size_t i = 0; i < numEdges; ++i)
                 {
-                    // Compute on which side of the to-be-inserted edge the
-                    // link vertices live. The triangles are not degenerate,
-                    // so it is not possible for sign0 = sign1 = 0.
-                    size_t e0Index = static_cast<size_t>(edge[0]);
-                    size_t e1Index = static_cast<size_t>(edge[1]);
-                    size_t v0Index = static_cast<size_t>(linkEdge[0]);
-                    size_t v1Index = static_cast<size_t>(linkEdge[1]);
-                    int32_t sign0 = ToLine(v0Index, e0Index, e1Index);
-                    int32_t sign1 = ToLine(v1Index, e0Index, e1Index);
-                    if (sign0 >= 0 && sign1 <= 0)
+                    Insert(edges[i], partitionedEdges[i]);
+                }
+                return;
+            }
+
+            std::vector<std::array<int32_t, 2>> remaining(edges);
+            std::vector<size_t> pending(numEdges), next;
+            std::iota(pending.begin(), pending.end(), 0);
+            next.reserve(numEdges);
+            for (size_t i = 0; i < numEdges; ++i)
+            {
+                partitionedEdges[i].clear();
+                partitionedEdges[i].push_back(edges[i][0]);
+            }
+
+            if (mWorkspaces.size() < numThreads)
+            {
+                mWorkspaces.resize(numThreads);
+            }
+
+            // The first pending step of each round is always applied, so
+            // every round makes progress.
+            while (pending.size() > 0)
+            {
+                size_t const numPending = pending.size();
+                if (mSteps.size() < numPending)
+                {
+                    mSteps.resize(numPending);
+                }
+                ComputeSteps(remaining, pending, numThreads, scheduler);
+
+                mClaimedTriangles.clear();
+                next.clear();
+                for (size_t j = 0; j < numPending; ++j)
+                {
+                    InsertionStep const& step = mSteps[j];
+                    size_t i = pending[j];
+
+                    bool deferred = false;
+                    if (step.strip.size() > 0)
                     {
-                        if (sign0 > 0)
+                        // The strip triangles are claimed even when the step
+                        // is deferred, so later edges that overlap the strip
+                        // are deferred also and the order of insertion of
+                        // the overlapping edges is preserved.
+                        for (auto const& tkey : step.strip)
                         {
-                            if (sign1 < 0)
+                            if (!mClaimedTriangles.insert(tkey).second)
                             {
-                                // The triangle <edge[0], v0, v1> strictly
-                                // contains the to-be-inserted edge. Gather
-                                // the triangles in the triangle strip
-                                // containing the edge.
-                                edgeConsumed = ProcessTriangleStrip(edge, v0Index, v1Index, partition);
-                            }
-                            else  // sign1 == 0 && sign0 > 0
-                            {
-                                // The to-be-inserted edge is coincident with
-                                // the triangle edge <edge[0], v1>, and it is
-                                // guaranteed that the vertex at v1 is an
-                                // interior point of <edge[0],edge[1]> because
-                                // we previously tested whether edge[] is in
-                                // the triangulation.
-                                edgeConsumed = ProcessCoincidentEdge(edge, v1Index, partition);
+                                deferred = true;
                             }
                         }
-                        else  // sign0 == 0 && sign1 < 0
-                        {
-                            // The to-be-inserted edge is coincident with
-                            // the triangle edge <edge[0], v0>, and it is
-                            // guaranteed that the vertex at v0 is an
-                            // interior point of <edge[0],edge[1]> because
-                            // we previously tested whether edge[] is in
-                            // the triangulation.
-                            edgeConsumed = ProcessCoincidentEdge(edge, v0Index, partition);
-                        }
-                        break;
                     }
-                }
-            }
+                    else
+                    {
+                        // The subedge is an edge of the triangulation used
+                        // when computing the step. It can have been removed
+                        // only by a retriangulation for an edge that crosses
+                        // it.
+                        auto const& emap = this->mGraph.GetEdges();
+                        EdgeKey<false> ekey(step.subedge[0], step.subedge[1]);
+                        deferred = (emap.find(ekey) == emap.end());
+                    }
 
-            // If the following assertion is triggered, ComputeType was chosen
-            // to be 'float' or 'double'. Floating-point rounding errors led to
-            // misclassification of signs. The linkEdges-loop exited without
-            // ever calling the ProcessTriangleStrip or ProcessCoincidentEdge
-            // functions.
-            LogAssert(partition.size() > 0, CDTMessage());
+                    if (deferred)
+                    {
+                        next.push_back(i);
+                        continue;
+                    }
 
-            partitionedEdge.resize(partition.size() + 1);
-            for (size_t i = 0; i < partition.size(); ++i)
-            {
-                partitionedEdge[i] = partition[i][0];
+                    ApplyStep(step);
+                    partitionedEdges[i].push_back(step.subedge[1]);
+                    if (!step.edgeConsumed)
+                    {
+                        remaining[i] = step.edge;
+                        next.push_back(i);
+                    }
+                }
+                pending.swap(next);
             }
-            partitionedEdge.back() = partition.back()[1];
         }
 
         // All edges inserted via the Insert(...) call are stored for use
@@ -724,10 +783,194 @@ namespace gte
         using Edge = VETManifoldMesh::Edge;
         using Triangle = VETManifoldMesh::Triangle;
 
+        // Sufficient storage for the expression trees related to computing
+        // the exact pseudosquared distances in SelectSplit and ComputePSD.
+        static size_t constexpr maxNumCRPool = 19;
+
+        // The buffers used to compute an insertion step. The buffers are
+        // reused by the steps, so their memory is allocated only when a step
+        // requires more than any previous step. Each thread of the batch
+        // Insert(...) has its own workspace.
+        struct Workspace
+        {
+            Workspace()
+                :
+                linkEdges{},
+                rightPolygon{},
+                leftPolygon{},
+                stack{},
+                crPool(maxNumCRPool)
+            {
+            }
+
+            std::vector<std::array<int32_t, 2>> linkEdges;
+            std::vector<int32_t> rightPolygon, leftPolygon;
+            std::vector<std::array<size_t, 2>> stack;
+            std::vector<ComputeRational> crPool;
+        };
+
+        // An insertion step inserts the first subedge of the to-be-inserted
+        // edge. The step is computed without modifying the triangulation.
+        // When the subedge is not already in the triangulation, applying the
+        // step removes the strip triangles and inserts the retriangulation
+        // triangles. The member 'edge' is the remainder of the edge that
+        // must be inserted by the next step when edgeConsumed is false.
+        struct InsertionStep
+        {
+            InsertionStep()
+                :
+                edge{ 0, 0 },
+                subedge{ 0, 0 },
+                edgeConsumed(false),
+                strip{},
+                triangles{}
+            {
+            }
+
+            std::array<int32_t, 2> edge, subedge;
+            bool edgeConsumed;
+            std::vector<TriangleKey<true>> strip;
+            std::vector<std::array<int32_t, 3>> triangles;
+        };
+
+        using TriangleKeySet = std::unordered_set<TriangleKey<true>,
+            TriangleKey<true>, TriangleKey<true>>;
+
+        void ValidateEdge(std::array<int32_t, 2> const& edge) const
+        {
+            LogAssert(
+                edge[0] != edge[1] &&
+                0 <= edge[0] && edge[0] < static_cast<int32_t>(this->GetNumVertices()) &&
+                0 <= edge[1] && edge[1] < static_cast<int32_t>(this->GetNumVertices()),
+                "Invalid edge.");
+        }
+
+        // Compute the steps for the pending edges of a round of the batch
+        // Insert(...).
+        void ComputeSteps(std::vector<std::array<int32_t, 2>> const& remaining,
+            std::vector<size_t> const& pending, size_t numThreads, TaskScheduler* scheduler)
+        {
+            size_t const numPending = pending.size();
+            size_t const numChunks = std::max(std::min(numThreads, numPending), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, &remaining, &pending, numPending, numChunks](size_t c)
+                {
+                    size_t const jmin = numPending * c / numChunks;
+                    size_t const jmax = numPending * (c + 1) / numChunks;
+                    Workspace& workspace = mWorkspaces[c];
+                    for (size_t j = jmin; j < jmax; ++j)
+                    {
+                        ComputeStep(remaining[pending[j]], mSteps[j], workspace);
+                    }
+                });
+        }
+
+        // Compute the step that inserts the first subedge of 'edge'. The
+        // triangulation is not modified.
+        void ComputeStep(std::array<int32_t, 2> const& edge, InsertionStep& step,
+            Workspace& workspace) const
+        {
+            step.edge = edge;
+            step.strip.clear();
+            step.triangles.clear();
+
+            EdgeKey<false> ekey(edge[0], edge[1]);
+            if (this->mGraph.GetEdges().find(ekey) != this->mGraph.GetEdges().end())
+            {
+                // The edge already exists in the triangulation.
+                step.subedge = edge;
+                step.edgeConsumed = true;
+                return;
+            }
+
+            // Get the link edges for the vertex edge[0]. These edges are
+            // opposite the link vertex.
+            workspace.linkEdges.clear();
+            GetLinkEdges(edge[0], workspace.linkEdges);
+
+            // Determine which link triangle contains the to-be-inserted
+            // edge.
+            for (auto const& linkEdge : workspace.linkEdges)
+            {
+                // Compute on which side of the to-be-inserted edge the
+                // link vertices live. The triangles are not degenerate,
+                // so it is not possible for sign0 = sign1 = 0.
+                size_t e0Index = static_cast<size_t>(edge[0]);
+                size_t e1Index = static_cast<size_t>(edge[1]);
+                size_t v0Index = static_cast<size_t>(linkEdge[0]);
+                size_t v1Index = static_cast<size_t>(linkEdge[1]);
+                int32_t sign0 = ToLine(v0Index, e0Index, e1Index, workspace.crPool);
+                int32_t sign1 = ToLine(v1Index, e0Index, e1Index, workspace.crPool);
+                if (sign0 >= 0 && sign1 <= 0)
+                {
+                    if (sign0 > 0)
+                    {
+                        if (sign1 < 0)
+                        {
+                            // The triangle <edge[0], v0, v1> strictly
+                            // contains the to-be-inserted edge. Gather
+                            // the triangles in the triangle strip
+                            // containing the edge.
+                            ComputeTriangleStrip(v0Index, v1Index, step, workspace);
+                        }
+                        else  // sign1 == 0 && sign0 > 0
+                        {
+                            // The to-be-inserted edge is coincident with
+                            // the triangle edge <edge[0], v1>, and it is
+                            // guaranteed that the vertex at v1 is an
+                            // interior point of <edge[0],edge[1]> because
+                            // we previously tested whether edge[] is in
+                            // the triangulation.
+                            ComputeCoincidentEdge(v1Index, step);
+                        }
+                    }
+                    else  // sign0 == 0 && sign1 < 0
+                    {
+                        // The to-be-inserted edge is coincident with
+                        // the triangle edge <edge[0], v0>, and it is
+                        // guaranteed that the vertex at v0 is an
+                        // interior point of <edge[0],edge[1]> because
+                        // we previously tested whether edge[] is in
+                        // the triangulation.
+                        ComputeCoincidentEdge(v0Index, step);
+                    }
+                    return;
+                }
+            }
+
+            // If the following assertion is triggered, ComputeType was chosen
+            // to be 'float' or 'double'. Floating-point rounding errors led to
+            // misclassification of signs. The linkEdges-loop exited without
+            // ever calling the ComputeTriangleStrip or ComputeCoincidentEdge
+            // functions.
+            LogAssert(false, CDTMessage());
+        }
+
+        // Insert the subedge of the step into the triangulation.
+        void ApplyStep(InsertionStep const& step)
+        {
+            // Update the inserted edges.
+            mInsertedEdges.insert(EdgeKey<false>(step.subedge[0], step.subedge[1]));
+
+            // Remove the triangle strip from the full triangulation. This
+            // must occur before the retriangulation which inserts new
+            // triangles into the full triangulation.
+            for (auto const& tkey : step.strip)
+            {
+                this->mGraph.Remove(tkey.V[0], tkey.V[1], tkey.V[2]);
+            }
+
+            // Retriangulate the tristrip region.
+            for (auto const& tri : step.triangles)
+            {
+                this->mGraph.Insert(tri[0], tri[1], tri[2]);
+            }
+        }
+
         // For a vertex at index v, return the edges of the adjacent triangles,
         // each triangle having v as a vertex and the returned edge is
         // opposite v.
-        void GetLinkEdges(int32_t v, std::vector<std::array<int32_t, 2>>& linkEdges)
+        void GetLinkEdges(int32_t v, std::vector<std::array<int32_t, 2>>& linkEdges) const
         {
             auto const& vmap = this->mGraph.GetVertices();
             auto viter = vmap.find(v);
@@ -756,7 +999,8 @@ namespace gte
         //   +1, P on right of line
         //   -1, P on left of line
         //    0, P on the line
-        int32_t ToLine(size_t pIndex, size_t v0Index, size_t v1Index) const
+        int32_t ToLine(size_t pIndex, size_t v0Index, size_t v1Index,
+            std::vector<ComputeRational>& crPool) const
         {
             // The expression tree has 13 nodes consisting of 6 input
             // leaves and 7 compute nodes.
@@ -792,19 +1036,19 @@ namespace gte
             auto const& irV0 = this->mIRVertices[v0Index];
             auto const& irV1 = this->mIRVertices[v1Index];
 
-            auto const& crP0 = Copy(irP[0], mCRPool[0]);
-            auto const& crP1 = Copy(irP[1], mCRPool[1]);
-            auto const& crV00 = Copy(irV0[0], mCRPool[2]);
-            auto const& crV01 = Copy(irV0[1], mCRPool[3]);
-            auto const& crV10 = Copy(irV1[0], mCRPool[4]);
-            auto const& crV11 = Copy(irV1[1], mCRPool[5]);
-            auto& crX0 = mCRPool[6];
-            auto& crY0 = mCRPool[7];
-            auto& crX1 = mCRPool[8];
-            auto& crY1 = mCRPool[9];
-            auto& crX0Y1 = mCRPool[10];
-            auto& crX1Y0 = mCRPool[11];
-            auto& crDet = mCRPool[12];
+            auto const& crP0 = Copy(irP[0], crPool[0]);
+            auto const& crP1 = Copy(irP[1], crPool[1]);
+            auto const& crV00 = Copy(irV0[0], crPool[2]);
+            auto const& crV01 = Copy(irV0[1], crPool[3]);
+            auto const& crV10 = Copy(irV1[0], crPool[4]);
+            auto const& crV11 = Copy(irV1[1], crPool[5]);
+            auto& crX0 = crPool[6];
+            auto& crY0 = crPool[7];
+            auto& crX1 = crPool[8];
+            auto& crY1 = crPool[9];
+            auto& crX0Y1 = crPool[10];
+            auto& crX1Y0 = crPool[11];
+            auto& crDet = crPool[12];
 
             // Evaluate the expression tree.
             crX0 = crP0 - crV00;
@@ -817,26 +1061,25 @@ namespace gte
             return crDet.GetSign();
         }
 
-        // The return value is 'true' if the edge did not have to be
-        // subdivided because it has an interior point that is a vertex.
-        // The return value is 'false' if it does have such a point, in
-        // which case edge[0] is updated to the index of that vertex. The
-        // caller must process the new edge.
-        bool ProcessTriangleStrip(std::array<int32_t, 2>& edge, size_t v0Index,
-            size_t v1Index, std::vector<std::array<int32_t, 2>>& partitionedEdge)
+        // Gather the triangles of the triangle strip containing the edge of
+        // the step and compute the retriangulation of the strip. If the edge
+        // has an interior point that is a vertex, the subedge of the step
+        // ends at that vertex and step.edge[0] is updated to the index of
+        // that vertex. The next step must process the new edge.
+        void ComputeTriangleStrip(size_t v0Index, size_t v1Index, InsertionStep& step,
+            Workspace& workspace) const
         {
             int32_t v0 = static_cast<int32_t>(v0Index);
             int32_t v1 = static_cast<int32_t>(v1Index);
-            bool edgeConsumed = true;
-            std::array<int32_t, 2> localEdge = edge;
+            step.edgeConsumed = true;
+            std::array<int32_t, 2> localEdge = step.edge;
 
             // Locate and store the triangles in the triangle strip containing
             // the edge.
-            ETManifoldMesh tristrip;
-            tristrip.Insert(localEdge[0], v0, v1);
+            step.strip.push_back(TriangleKey<true>(localEdge[0], v0, v1));
 
             auto const& tmap = this->mGraph.GetTriangles();
-            auto titer = tmap.find(TriangleKey<true>(localEdge[0], v0, v1));
+            auto titer = tmap.find(step.strip.back());
             LogAssert(titer != tmap.end(), CDTMessage());
             auto tri = titer->second.get();
             LogAssert(tri, CDTMessage());
@@ -847,7 +1090,10 @@ namespace gte
             // strip shares an edge with a previous triangle in the strip
             // and the previous triangle is not the immediate predecessor
             // to the current triangle.
-            std::vector<int32_t> rightPolygon, leftPolygon;
+            auto& rightPolygon = workspace.rightPolygon;
+            auto& leftPolygon = workspace.leftPolygon;
+            rightPolygon.clear();
+            leftPolygon.clear();
             rightPolygon.push_back(localEdge[0]);
             rightPolygon.push_back(v0);
             leftPolygon.push_back(localEdge[0]);
@@ -864,7 +1110,7 @@ namespace gte
                 // the triangle adj that is adjacent to tri via this edge.
                 auto adj = tri->GetAdjacentOfEdge(v0, v1);
                 LogAssert(adj, CDTMessage());
-                tristrip.Insert(adj->V[0], adj->V[1], adj->V[2]);
+                step.strip.push_back(TriangleKey<true>(adj->V[0], adj->V[1], adj->V[2]));
 
                 // Get the vertex of adj that is opposite edge <v0,v1>.
                 int32_t vOpposite = 0;
@@ -880,7 +1126,8 @@ namespace gte
                 // opposite vertex is left-of the edge, right-of the edge
                 // or on the edge.
                 int32_t querySign = ToLine(static_cast<size_t>(vOpposite),
-                    static_cast<size_t>(localEdge[0]), static_cast<size_t>(localEdge[1]));
+                    static_cast<size_t>(localEdge[0]), static_cast<size_t>(localEdge[1]),
+                    workspace.crPool);
                 if (querySign > 0)
                 {
                     tri = adj;
@@ -900,10 +1147,10 @@ namespace gte
                     // subdivided. The first subedge is in a triangle strip
                     // that is processed by code below that is outside the
                     // loop. The second subedge must be processed by the
-                    // caller.
+                    // next step.
                     localEdge[1] = vOpposite;
-                    edge[0] = vOpposite;
-                    edgeConsumed = false;
+                    step.edge[0] = vOpposite;
+                    step.edgeConsumed = false;
                     break;
                 }
             }
@@ -919,46 +1166,33 @@ namespace gte
             // clockwise ordered, so reverse it.
             std::reverse(leftPolygon.begin(), leftPolygon.end());
 
-            // Update the inserted edges.
-            mInsertedEdges.insert(EdgeKey<false>(localEdge[0], localEdge[1]));
-            partitionedEdge.push_back(localEdge);
-
-            // Remove the triangle strip from the full triangulation. This
-            // must occur before the retriangulation which inserts new
-            // triangles into the full triangulation.
-            for (auto const& element : tristrip.GetTriangles())
-            {
-                auto const& tkey = element.first;
-                this->mGraph.Remove(tkey.V[0], tkey.V[1], tkey.V[2]);
-            }
+            step.subedge = localEdge;
 
             // Retriangulate the tristrip region.
-            Retriangulate(leftPolygon);
-            Retriangulate(rightPolygon);
-
-            return edgeConsumed;
+            Retriangulate(leftPolygon, step.triangles, workspace);
+            Retriangulate(rightPolygon, step.triangles, workspace);
         }
 
         // Process a to-be-inserted edge that is coincident with an already
         // existing triangulation edge.
-        bool ProcessCoincidentEdge(std::array<int32_t, 2>& edge, size_t vIndex,
-            std::vector<std::array<int32_t, 2>>& partitionedEdge)
+        void ComputeCoincidentEdge(size_t vIndex, InsertionStep& step) const
         {
             int32_t v = static_cast<int32_t>(vIndex);
-            mInsertedEdges.insert(EdgeKey<false>(edge[0], v));
-            partitionedEdge.push_back({ edge[0], v });
-            edge[0] = v;
-            bool edgeConsumed = (v == edge[1]);
-            return edgeConsumed;
+            step.subedge = { step.edge[0], v };
+            step.edge[0] = v;
+            step.edgeConsumed = (v == step.edge[1]);
         }
 
         // Retriangulate the polygon via a bisection-like method that finds
         // vertices closest to the current polygon base edge. The function
         // is naturally recursive, but simulated recursion is used to avoid
-        // a large program stack by instead using the heap.
-        void Retriangulate(std::vector<int32_t> const& polygon)
+        // a large program stack by instead using the heap. The triangles
+        // are appended to the 'triangles' array.
+        void Retriangulate(std::vector<int32_t> const& polygon,
+            std::vector<std::array<int32_t, 3>>& triangles, Workspace& workspace) const
         {
-            std::vector<std::array<size_t, 2>> stack(polygon.size());
+            auto& stack = workspace.stack;
+            stack.resize(polygon.size());
             size_t top = std::numeric_limits<size_t>::max();
             stack[++top] = { 0, polygon.size() - 1 };
             while (top != std::numeric_limits<size_t>::max())
@@ -974,11 +1208,12 @@ namespace gte
                     // that the vertex at index polygon[isplit] attains the
                     // minimum distance to the edge with vertices at the
                     // indices polygon[i[0]] and polygon[i[1]].
-                    size_t isplit = SelectSplit(polygon, i[0], i[1]);
+                    size_t isplit = SelectSplit(polygon, i[0], i[1], workspace.crPool);
                     int32_t vsplit = polygon[isplit];
 
-                    // Insert the triangle into the Delaunay graph.
-                    this->mGraph.Insert(v0, vsplit, v1);
+                    // The triangle is inserted into the Delaunay graph
+                    // when the step is applied.
+                    triangles.push_back({ v0, vsplit, v1 });
 
                     stack[++top] = { i[0], isplit };
                     stack[++top] = { isplit, i[1] };
@@ -998,7 +1233,8 @@ namespace gte
         // Determine the polygon vertex with index strictly between i0 and i1
         // that minimizes the pseudosquared distance from that vertex to the
         // line segment whose endpoints are at indices i0 and i1.
-        size_t SelectSplit(std::vector<int32_t> const& polygon, size_t i0, size_t i1)
+        size_t SelectSplit(std::vector<int32_t> const& polygon, size_t i0, size_t i1,
+            std::vector<ComputeRational>& crPool) const
         {
             size_t i2;
             if (i1 == i0 + 2)
@@ -1022,17 +1258,17 @@ namespace gte
                 auto const& irV0 = this->mIRVertices[v0];
                 auto const& irV1 = this->mIRVertices[v1];
                 auto const& irV2 = this->mIRVertices[v2];
-                auto const& crV0x = Copy(irV0[0], mCRPool[0]);
-                auto const& crV0y = Copy(irV0[1], mCRPool[1]);
-                auto const& crV1x = Copy(irV1[0], mCRPool[2]);
-                auto const& crV1y = Copy(irV1[1], mCRPool[3]);
-                auto const& crV2x = Copy(irV2[0], mCRPool[4]);
-                auto const& crV2y = Copy(irV2[1], mCRPool[5]);
-                auto& crV1mV0x = mCRPool[6];
-                auto& crV1mV0y = mCRPool[7];
-                auto& crSqrLen10 = mCRPool[8];
-                auto& crPSD = mCRPool[9];
-                auto& crMinPSD = mCRPool[10];
+                auto const& crV0x = Copy(irV0[0], crPool[0]);
+                auto const& crV0y = Copy(irV0[1], crPool[1]);
+                auto const& crV1x = Copy(irV1[0], crPool[2]);
+                auto const& crV1y = Copy(irV1[1], crPool[3]);
+                auto const& crV2x = Copy(irV2[0], crPool[4]);
+                auto const& crV2y = Copy(irV2[1], crPool[5]);
+                auto& crV1mV0x = crPool[6];
+                auto& crV1mV0y = crPool[7];
+                auto& crSqrLen10 = crPool[8];
+                auto& crPSD = crPool[9];
+                auto& crMinPSD = crPool[10];
 
                 crV1mV0x = crV1x - crV0x;
                 crV1mV0y = crV1y - crV0y;
@@ -1040,15 +1276,15 @@ namespace gte
 
                 // Locate the minimum pseudosquared distance.
                 ComputePSD(crV0x, crV0y, crV1x, crV1y, crV2x, crV2y,
-                    crV1mV0x, crV1mV0y, crSqrLen10, crMinPSD);
+                    crV1mV0x, crV1mV0y, crSqrLen10, crMinPSD, crPool);
                 for (size_t i = i2 + 1; i < i1; ++i)
                 {
                     v2 = polygon[i];
                     auto const& irNextV2 = this->mIRVertices[v2];
-                    this->Copy(irNextV2[0], mCRPool[4]);
-                    this->Copy(irNextV2[1], mCRPool[5]);
+                    Copy(irNextV2[0], crPool[4]);
+                    Copy(irNextV2[1], crPool[5]);
                     ComputePSD(crV0x, crV0y, crV1x, crV1y, crV2x, crV2y,
-                        crV1mV0x, crV1mV0y, crSqrLen10, crPSD);
+                        crV1mV0x, crV1mV0y, crSqrLen10, crPSD, crPool);
                     if (crPSD < crMinPSD)
                     {
                         crMinPSD = crPSD;
@@ -1064,7 +1300,7 @@ namespace gte
         // involve division. This allows ComputeType to be BSNumber<UInteger>
         // rather than BSRational<UInteger>, which leads to better
         // performance.
-        void ComputePSD(
+        static void ComputePSD(
             ComputeRational const& crV0x,
             ComputeRational const& crV0y,
             ComputeRational const& crV1x,
@@ -1074,16 +1310,17 @@ namespace gte
             ComputeRational const& crV1mV0x,
             ComputeRational const& crV1mV0y,
             ComputeRational const& crSqrLen10,
-            ComputeRational& crPSD)
+            ComputeRational& crPSD,
+            std::vector<ComputeRational>& crPool)
         {
-            auto& crV2mV0x = mCRPool[11];
-            auto& crV2mV0y = mCRPool[12];
-            auto& crV2mV1x = mCRPool[13];
-            auto& crV2mV1y = mCRPool[14];
-            auto& crDot1020 = mCRPool[15];
-            auto& crSqrLen20 = mCRPool[16];
-            auto& crDot1021 = mCRPool[17];
-            auto& crSqrLen21 = mCRPool[18];
+            auto& crV2mV0x = crPool[11];
+            auto& crV2mV0y = crPool[12];
+            auto& crV2mV1x = crPool[13];
+            auto& crV2mV1y = crPool[14];
+            auto& crDot1020 = crPool[15];
+            auto& crSqrLen20 = crPool[16];
+            auto& crDot1021 = crPool[17];
+            auto& crSqrLen21 = crPool[18];
 
             crV2mV0x = crV2x - crV0x;
             crV2mV0y = crV2y - crV0y;
@@ -1126,9 +1363,15 @@ function.
         // into subedges, the subedges are inserted into this member.
         EdgeKeySet mInsertedEdges;
 
-        // Sufficient storage for the expression trees related to computing
-        // the exact pseudosquared distances in SelectSplit and ComputePSD.
-        static size_t constexpr maxNumCRPool = 19;
-        mutable std::vector<ComputeRational> mCRPool;
+        // The workspace and step of the single-edge Insert(...).
+        Workspace mWorkspace;
+        InsertionStep mStep;
+
+        // The workspaces (one per thread), the steps of a round and the
+        // triangles claimed by the steps of a round for the batch
+        // Insert(...).
+        std::vector<Workspace> mWorkspaces;
+        std::vector<InsertionStep> mSteps;
+        TriangleKeySet mClaimedTriangles;
     };
 }
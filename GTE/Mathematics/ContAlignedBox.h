@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/AlignedBox.h>
+#include <Mathematics/PointCloud.h>
 
 namespace gte
 {
@@ -19,6 +20,12 @@ namespace gte
         return ComputeExtremes(numPoints, points, box.min, box.max);
     }
 
+    template <int N, typename Real>
+    bool GetContainer(PointCloudView<N, Real> const& cloud, AlignedBox<N, Real>& box)
+    {
+        return ComputeExtremes(cloud, 0, cloud.GetNumPoints(), box.min, box.max);
+    }
+
     // Test for containment.
     template <int N, typename Real>
     bool InContainer(Vector<N, Real> const& point, AlignedBox<N, Real> const& box)
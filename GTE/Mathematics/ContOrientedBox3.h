@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -70,6 +70,30 @@ namespace gte
         return GetContainer(static_cast<int>(points.size()), points.data(), box);
     }
 
+    // The same box for a point cloud stored as structure of arrays, using
+    // the vectorizable accumulations of PointCloud.h.
+    template <typename Real>
+    bool GetContainer(PointCloudView<3, Real> const& cloud, OrientedBox3<Real>& box)
+    {
+        ApprGaussian3<Real> fitter;
+        if (fitter.Fit(cloud))
+        {
+            box = fitter.GetParameters();
+
+            std::array<Real, 3> pmin, pmax;
+            ComputeProjectionExtremes(cloud, box.center, 3, box.axis.data(),
+                0, cloud.GetNumPoints(), pmin.data(), pmax.data());
+            for (int j = 0; j < 3; ++j)
+            {
+                box.center += ((Real)0.5 * (pmin[j] + pmax[j])) * box.axis[j];
+                box.extent[j] = (Real)0.5 * (pmax[j] - pmin[j]);
+            }
+            return true;
+        }
+
+        return false;
+    }
+
     // Test for containment.  Let X = C + y0*U0 + y1*U1 + y2*U2 where C is the
     // box center and U0, U1, U2 are the orthonormal axes of the box.  X is in
     // the box if |y_i| <= E_i for all i where E_i are the extents of the box.
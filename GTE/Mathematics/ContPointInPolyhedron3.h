@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -11,6 +11,11 @@
 #include <Mathematics/ContPointInPolygon2.h>
 #include <Mathematics/IntrRay3Plane3.h>
 #include <Mathematics/IntrRay3Triangle3.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 // This class contains various implementations for point-in-polyhedron
@@ -29,6 +34,14 @@
 // Whichever result occurs N+1 or more times is the "winner".  The input
 // rayQuantity is 2*N+1.  The input array Direction must have rayQuantity
 // elements.  If you are feeling lucky, choose rayQuantity to be 1.
+//
+// Each ray is tested against all the faces unless CreateTree is called.
+// CreateTree builds a bounding volume hierarchy of axis-aligned boxes of
+// the faces, and each ray is then tested only against the faces whose
+// bounding boxes the ray intersects, which for a point set on a grid is
+// typically a small number of faces per ray.  The results are the same
+// with or without the tree.  The batch Contains query classifies an array
+// of points concurrently.
 
 namespace gte
 {
@@ -158,6 +171,106 @@ namespace gte
         // This function will select the actual algorithm based on which
         // constructor you used for this class.
         bool Contains(Vector3<Real> const& p) const
+        {
+            return Contains(p, mProjVertices);
+        }
+
+        // Classify the points, setting inside[i] to 1 when points[i] is
+        // inside the polyhedron and to 0 otherwise.  The points are
+        // distributed among 'numThreads' threads, which are tasks of the
+        // scheduler when it is not null.
+        void Contains(std::vector<Vector3<Real>> const& points,
+            std::vector<uint8_t>& inside, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            enum { msBlockSize = 256 };
+            inside.resize(points.size());
+            size_t const numBlocks = (points.size() + msBlockSize - 1) / msBlockSize;
+            TaskScheduler::ParallelForDynamic(scheduler, numBlocks, numThreads,
+                [this, &points, &inside](size_t block)
+                {
+                    std::vector<Vector2<Real>> projVertices;
+                    size_t const i1 = std::min((block + 1) * msBlockSize, points.size());
+                    for (size_t i = block * msBlockSize; i < i1; ++i)
+                    {
+                        inside[i] = (Contains(points[i], projVertices) ? 1 : 0);
+                    }
+                });
+        }
+
+        // Build the bounding volume hierarchy of the faces.  The points and
+        // faces passed to the constructor must not change after the call.
+        // A leaf of the tree has at most 'maxLeafSize' faces.
+        void CreateTree(int maxLeafSize = 4)
+        {
+            LogAssert(maxLeafSize > 0, "Invalid input.");
+
+            mNodes.clear();
+            mFaceOrder.resize(static_cast<size_t>(mNumFaces));
+            if (mNumFaces <= 0)
+            {
+                return;
+            }
+
+            // Compute the face bounding boxes, expanded by a small multiple
+            // of the size of the polyhedron so that rounding errors in the
+            // ray-box tests do not reject faces that the ray-face tests
+            // report as intersected.
+            std::vector<std::array<Real, 6>> faceBoxes(mFaceOrder.size());
+            std::vector<std::array<Real, 3>> centers(mFaceOrder.size());
+            for (int i = 0; i < mNumFaces; ++i)
+            {
+                mFaceOrder[i] = i;
+                ComputeFaceBox(i, faceBoxes[i]);
+            }
+
+            std::array<Real, 6> bounds = faceBoxes[0];
+            for (auto const& box : faceBoxes)
+            {
+                for (int d = 0; d < 3; ++d)
+                {
+                    bounds[d] = std::min(bounds[d], box[d]);
+                    bounds[d + 3] = std::max(bounds[d + 3], box[d + 3]);
+                }
+            }
+            Real epsilon = (Real)0;
+            for (int d = 0; d < 3; ++d)
+            {
+                epsilon = std::max(epsilon, bounds[d + 3] - bounds[d]);
+            }
+            epsilon *= static_cast<Real>(1e-6);
+            for (size_t i = 0; i < faceBoxes.size(); ++i)
+            {
+                for (int d = 0; d < 3; ++d)
+                {
+                    faceBoxes[i][d] -= epsilon;
+                    faceBoxes[i][d + 3] += epsilon;
+                    centers[i][d] = (Real)0.5 * (faceBoxes[i][d] + faceBoxes[i][d + 3]);
+                }
+            }
+
+            mNodes.reserve(2 * mFaceOrder.size());
+            BuildTree(0, mNumFaces, faceBoxes, centers, maxLeafSize);
+        }
+
+        inline bool HasTree() const
+        {
+            return mNodes.size() > 0;
+        }
+
+    private:
+        // A node of the bounding volume hierarchy.  The nodes are stored in
+        // depth-first order, so the left child of an interior node is the
+        // next node.  A leaf has faces mFaceOrder[offset] through
+        // mFaceOrder[offset + count - 1].  An interior node has count 0, and
+        // 'offset' is the index of its right child.
+        struct Node
+        {
+            std::array<Real, 3> min, max;
+            int offset, count;
+        };
+
+        bool Contains(Vector3<Real> const& p, std::vector<Vector2<Real>>& projVertices) const
         {
             if (mTFaces)
             {
@@ -171,7 +284,7 @@ namespace gte
                     return ContainsC0(p);
                 }
 
-                return ContainsC1C2(p, mMethod);
+                return ContainsC1C2(p, mMethod, projVertices);
             }
 
             if (mSFaces)
@@ -183,14 +296,183 @@ namespace gte
 
                 if (mMethod == 1)
                 {
-                    return ContainsS1(p);
+                    return ContainsS1(p, projVertices);
                 }
             }
 
             return false;
         }
 
-    private:
+        void ComputeFaceBox(int i, std::array<Real, 6>& box) const
+        {
+            auto update = [this, &box](int index, bool first)
+            {
+                Vector3<Real> const& point = mPoints[index];
+                for (int d = 0; d < 3; ++d)
+                {
+                    box[d] = (first ? point[d] : std::min(box[d], point[d]));
+                    box[d + 3] = (first ? point[d] : std::max(box[d + 3], point[d]));
+                }
+            };
+
+            if (mTFaces)
+            {
+                for (int k = 0; k < 3; ++k)
+                {
+                    update(mTFaces[i].indices[k], k == 0);
+                }
+            }
+            else if (mCFaces)
+            {
+                for (size_t k = 0; k < mCFaces[i].indices.size(); ++k)
+                {
+                    update(mCFaces[i].indices[k], k == 0);
+                }
+            }
+            else
+            {
+                SimpleFace const& face = mSFaces[i];
+                for (size_t k = 0; k < face.indices.size(); ++k)
+                {
+                    update(face.indices[k], k == 0);
+                }
+                for (size_t k = 0; k < face.triangles.size(); ++k)
+                {
+                    update(face.triangles[k], k == 0 && face.indices.size() == 0);
+                }
+            }
+        }
+
+        // Build the subtree of faces mFaceOrder[i0] through
+        // mFaceOrder[i1 - 1], splitting at the median of the box centers
+        // along the axis of largest extent of the centers.
+        void BuildTree(int i0, int i1, std::vector<std::array<Real, 6>> const& faceBoxes,
+            std::vector<std::array<Real, 3>> const& centers, int maxLeafSize)
+        {
+            int const nodeIndex = static_cast<int>(mNodes.size());
+            mNodes.push_back(Node());
+            Node node;
+            std::array<Real, 3> cmin{}, cmax{};
+            for (int k = i0; k < i1; ++k)
+            {
+                int const i = mFaceOrder[k];
+                for (int d = 0; d < 3; ++d)
+                {
+                    node.min[d] = (k > i0 ? std::min(node.min[d], faceBoxes[i][d]) : faceBoxes[i][d]);
+                    node.max[d] = (k > i0 ? std::max(node.max[d], faceBoxes[i][d + 3]) : faceBoxes[i][d + 3]);
+                    cmin[d] = (k > i0 ? std::min(cmin[d], centers[i][d]) : centers[i][d]);
+                    cmax[d] = (k > i0 ? std::max(cmax[d], centers[i][d]) : centers[i][d]);
+                }
+            }
+
+            if (i1 - i0 <= maxLeafSize)
+            {
+                node.offset = i0;
+                node.count = i1 - i0;
+                mNodes[nodeIndex] = node;
+                return;
+            }
+
+            int axis = 0;
+            for (int d = 1; d < 3; ++d)
+            {
+                if (cmax[d] - cmin[d] > cmax[axis] - cmin[axis])
+                {
+                    axis = d;
+                }
+            }
+
+            int const iMid = i0 + (i1 - i0) / 2;
+            std::nth_element(mFaceOrder.begin() + i0, mFaceOrder.begin() + iMid,
+                mFaceOrder.begin() + i1, [&centers, axis](int j0, int j1)
+                {
+                    return centers[j0][axis] < centers[j1][axis];
+                });
+
+            BuildTree(i0, iMid, faceBoxes, centers, maxLeafSize);
+            node.offset = static_cast<int>(mNodes.size());
+            node.count = 0;
+            BuildTree(iMid, i1, faceBoxes, centers, maxLeafSize);
+            mNodes[nodeIndex] = node;
+        }
+
+        // Test for intersection of the ray and the node box using slabs.
+        static bool Intersects(Ray3<Real> const& ray, Node const& node)
+        {
+            Real tmin = (Real)0, tmax = std::numeric_limits<Real>::max();
+            for (int d = 0; d < 3; ++d)
+            {
+                Real const origin = ray.origin[d], direction = ray.direction[d];
+                if (direction == (Real)0)
+                {
+                    if (origin < node.min[d] || origin > node.max[d])
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    Real const invDirection = (Real)1 / direction;
+                    Real t0 = (node.min[d] - origin) * invDirection;
+                    Real t1 = (node.max[d] - origin) * invDirection;
+                    if (t0 > t1)
+                    {
+                        std::swap(t0, t1);
+                    }
+                    tmin = std::max(tmin, t0);
+                    tmax = std::min(tmax, t1);
+                    if (tmin > tmax)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Execute function(i) for the faces that the ray might intersect,
+        // which are all the faces when there is no tree.
+        template <typename Function>
+        void VisitFaces(Ray3<Real> const& ray, Function const& function) const
+        {
+            if (mNodes.size() == 0)
+            {
+                for (int i = 0; i < mNumFaces; ++i)
+                {
+                    function(i);
+                }
+                return;
+            }
+
+            // The tree is balanced, so its height is at most the number of
+            // bits of an int.
+            std::array<int, 8 * sizeof(int)> stack;
+            int top = 0;
+            stack[0] = 0;
+            while (top >= 0)
+            {
+                Node const& node = mNodes[stack[top--]];
+                if (!Intersects(ray, node))
+                {
+                    continue;
+                }
+
+                if (node.count > 0)
+                {
+                    for (int k = node.offset; k < node.offset + node.count; ++k)
+                    {
+                        function(mFaceOrder[k]);
+                    }
+                }
+                else
+                {
+                    int const left = static_cast<int>(&node - mNodes.data()) + 1;
+                    stack[++top] = node.offset;
+                    stack[++top] = left;
+                }
+            }
+        }
+
         // For all types of faces.  The ray origin is the test point.  The ray
         // direction is one of those passed to the constructors.  The plane
         // origin is a point on the plane of the face.  The plane normal is a
@@ -241,13 +523,14 @@ namespace gte
                 // Zero intersections to start with.
                 bool odd = false;
 
-                TriangleFace const* face = mTFaces;
-                for (int i = 0; i < mNumFaces; ++i, ++face)
+                VisitFaces(ray, [&](int i)
                 {
+                    TriangleFace const* face = &mTFaces[i];
+
                     // Attempt to quickly cull the triangle.
                     if (FastNoIntersect(ray, face->plane))
                     {
-                        continue;
+                        return;
                     }
 
                     // Get the triangle vertices.
@@ -262,7 +545,7 @@ namespace gte
                         // The ray intersects the triangle.
                         odd = !odd;
                     }
-                }
+                });
 
                 if (odd)
                 {
@@ -290,13 +573,14 @@ namespace gte
                 // Zero intersections to start with.
                 bool odd = false;
 
-                ConvexFace const* face = mCFaces;
-                for (int i = 0; i < mNumFaces; ++i, ++face)
+                VisitFaces(ray, [&](int i)
                 {
+                    ConvexFace const* face = &mCFaces[i];
+
                     // Attempt to quickly cull the triangle.
                     if (FastNoIntersect(ray, face->plane))
                     {
-                        continue;
+                        return;
                     }
 
                     // Process the triangles in a trifan of the face.
@@ -313,7 +597,7 @@ namespace gte
                             odd = !odd;
                         }
                     }
-                }
+                });
 
                 if (odd)
                 {
@@ -324,7 +608,8 @@ namespace gte
             return insideCount > mNumRays / 2;
         }
 
-        bool ContainsC1C2(Vector3<Real> const& p, unsigned int method) const
+        bool ContainsC1C2(Vector3<Real> const& p, unsigned int method,
+            std::vector<Vector2<Real>>& projVertices) const
         {
             int insideCount = 0;
 
@@ -339,13 +624,14 @@ namespace gte
                 // Zero intersections to start with.
                 bool odd = false;
 
-                ConvexFace const* face = mCFaces;
-                for (int i = 0; i < mNumFaces; ++i, ++face)
+                VisitFaces(ray, [&](int i)
                 {
+                    ConvexFace const* face = &mCFaces[i];
+
                     // Attempt to quickly cull the triangle.
                     if (FastNoIntersect(ray, face->plane))
                     {
-                        continue;
+                        return;
                     }
 
                     // Compute the ray-plane intersection.
@@ -368,26 +654,26 @@ namespace gte
                     Vector2<Real> projIntersect{ Dot(basis[1], diff), Dot(basis[2], diff) };
 
                     // Project the face vertices onto the plane of the face.
-                    if (face->indices.size() > mProjVertices.size())
+                    if (face->indices.size() > projVertices.size())
                     {
-                        mProjVertices.resize(face->indices.size());
+                        projVertices.resize(face->indices.size());
                     }
 
                     // Project the remaining vertices.  Vertex 0 is always the
                     // origin.
                     size_t numIndices = face->indices.size();
-                    mProjVertices[0] = Vector2<Real>::Zero();
+                    projVertices[0] = Vector2<Real>::Zero();
                     for (size_t k = 1; k < numIndices; ++k)
                     {
                         diff = mPoints[face->indices[k]] - V0;
-                        mProjVertices[k][0] = Dot(basis[1], diff);
-                        mProjVertices[k][1] = Dot(basis[2], diff);
+                        projVertices[k][0] = Dot(basis[1], diff);
+                        projVertices[k][1] = Dot(basis[2], diff);
                     }
 
                     // Test whether the intersection point is in the convex
                     // polygon.
-                    PointInPolygon2<Real> PIP(static_cast<int>(mProjVertices.size()),
-                        &mProjVertices[0]);
+                    PointInPolygon2<Real> PIP(static_cast<int>(numIndices),
+                        &projVertices[0]);
 
                     if (method == 1)
                     {
@@ -405,7 +691,7 @@ namespace gte
                             odd = !odd;
                         }
                     }
-                }
+                });
 
                 if (odd)
                 {
@@ -433,13 +719,14 @@ namespace gte
                 // Zero intersections to start with.
                 bool odd = false;
 
-                SimpleFace const* face = mSFaces;
-                for (int i = 0; i < mNumFaces; ++i, ++face)
+                VisitFaces(ray, [&](int i)
                 {
+                    SimpleFace const* face = &mSFaces[i];
+
                     // Attempt to quickly cull the triangle.
                     if (FastNoIntersect(ray, face->plane))
                     {
-                        continue;
+                        return;
                     }
 
                     // The triangulation must exist to use it.
@@ -463,7 +750,7 @@ namespace gte
                             odd = !odd;
                         }
                     }
-                }
+                });
 
                 if (odd)
                 {
@@ -474,7 +761,8 @@ namespace gte
             return insideCount > mNumRays / 2;
         }
 
-        bool ContainsS1(Vector3<Real> const& p) const
+        bool ContainsS1(Vector3<Real> const& p,
+            std::vector<Vector2<Real>>& projVertices) const
         {
             int insideCount = 0;
 
@@ -489,13 +777,14 @@ namespace gte
                 // Zero intersections to start with.
                 bool odd = false;
 
-                SimpleFace const* face = mSFaces;
-                for (int i = 0; i < mNumFaces; ++i, ++face)
+                VisitFaces(ray, [&](int i)
                 {
+                    SimpleFace const* face = &mSFaces[i];
+
                     // Attempt to quickly cull the triangle.
                     if (FastNoIntersect(ray, face->plane))
                     {
-                        continue;
+                        return;
                     }
 
                     // Compute the ray-plane intersection.
@@ -518,33 +807,33 @@ namespace gte
                     Vector2<Real> projIntersect{ Dot(basis[1], diff), Dot(basis[2], diff) };
 
                     // Project the face vertices onto the plane of the face.
-                    if (face->indices.size() > mProjVertices.size())
+                    if (face->indices.size() > projVertices.size())
                     {
-                        mProjVertices.resize(face->indices.size());
+                        projVertices.resize(face->indices.size());
                     }
 
                     // Project the remaining vertices.  Vertex 0 is always the
                     // origin.
                     size_t numIndices = face->indices.size();
-                    mProjVertices[0] = Vector2<Real>::Zero();
+                    projVertices[0] = Vector2<Real>::Zero();
                     for (size_t k = 1; k < numIndices; ++k)
                     {
                         diff = mPoints[face->indices[k]] - V0;
-                        mProjVertices[k][0] = Dot(basis[1], diff);
-                        mProjVertices[k][1] = Dot(basis[2], diff);
+                        projVertices[k][0] = Dot(basis[1], diff);
+                        projVertices[k][1] = Dot(basis[2], diff);
                     }
 
                     // Test whether the intersection point is in the convex
                     // polygon.
-                    PointInPolygon2<Real> PIP(static_cast<int>(mProjVertices.size()),
-                        &mProjVertices[0]);
+                    PointInPolygon2<Real> PIP(static_cast<int>(numIndices),
+                        &projVertices[0]);
 
                     if (PIP.Contains(projIntersect))
                     {
                         // The ray intersects the triangle.
                         odd = !odd;
                     }
-                }
+                });
 
                 if (odd)
                 {
@@ -571,5 +860,10 @@ namespace gte
         // point-in-polygon queries.  The array stores the projections of
         // face vertices onto the plane of the face.  It is resized as needed.
         mutable std::vector<Vector2<Real>> mProjVertices;
+
+        // The bounding volume hierarchy, which is empty until CreateTree is
+        // called.
+        std::vector<Node> mNodes;
+        std::vector<int> mFaceOrder;
     };
 }
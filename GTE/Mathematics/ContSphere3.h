@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Hypersphere.h>
+#include <Mathematics/PointCloud.h>
 #include <Mathematics/Vector3.h>
 #include <vector>
 
@@ -46,6 +47,18 @@ namespace gte
         return GetContainer(static_cast<int>(points.size()), points.data(), sphere);
     }
 
+    // The same sphere for a point cloud stored as structure of arrays,
+    // using the vectorizable accumulations of PointCloud.h.
+    template <typename Real>
+    bool GetContainer(PointCloudView<3, Real> const& cloud, Sphere3<Real>& sphere)
+    {
+        size_t const numPoints = cloud.GetNumPoints();
+        LogAssert(numPoints > 0, "Invalid input.");
+        sphere.center = ComputeSum(cloud, 0, numPoints) / (Real)numPoints;
+        sphere.radius = std::sqrt(ComputeMaxSqrDistance(cloud, sphere.center, 0, numPoints));
+        return true;
+    }
+
     // Test for containment of a point inside a sphere.
     template <typename Real>
     bool InContainer(Vector3<Real> const& point, Sphere3<Real> const& sphere)
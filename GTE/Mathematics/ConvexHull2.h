@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.01
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -14,6 +14,7 @@
 // arithmetic and rational arithmetic for the predicate.
 
 #include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/BSPrecisionPredicates.h>
 #include <Mathematics/FPInterval.h>
 #include <Mathematics/Line.h>
 #include <Mathematics/Vector2.h>
@@ -31,7 +32,7 @@ namespace gte
     public:
         // Supporting constants and types for rational arithmetic used in
         // the exact predicate for sign computations.
-        static int constexpr NumWords = std::is_same<Real, float>::value ? 18 : 132;
+        static int constexpr NumWords = BSPrecisionPredicates::ToLine<Real>(true);
         using Rational = BSNumber<UIntegerFP32<NumWords>>;
         using Interval = FPInterval<Real>;
 
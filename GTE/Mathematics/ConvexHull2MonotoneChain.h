@@ -0,0 +1,469 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+// Compute the convex hull of 2D points using Andrew's monotone chain
+// algorithm,
+//   A. M. Andrew, "Another efficient algorithm for convex hulls in two
+//   dimensions", Information Processing Letters 9(5):216-219, 1979.
+// The points are passed as separate arrays of x-components and
+// y-components. Before the points are sorted, the Akl-Toussaint heuristic
+// discards the points strictly inside the polygon whose vertices are the
+// extreme points in the directions (+-1,0), (0,+-1) and (+-1,+-1),
+//   S. G. Akl and G. T. Toussaint, "A fast convex hull algorithm",
+//   Information Processing Letters 7(5):219-222, 1978.
+// For points that fill a region, most of the points are discarded, so the
+// O(N log N) sort and the chain construction are applied to a small subset
+// of the points. The discarding is a pass over the coordinate arrays whose
+// loop body has no branches, so the compiler can vectorize it. A point is
+// discarded only when a floating-point filter, derived from that of
+// FilteredPrimalQuery2, certifies that it is strictly inside all the
+// polygon edges. The other
+// points are kept, so the heuristic never requires exact arithmetic. The
+// turn tests of the monotone chain are FilteredPrimalQuery2 queries, which
+// fall back to rational arithmetic when the filter does not certify the
+// sign.
+//
+// The hull is the same convex polygon as that computed by ConvexHull2. The
+// vertices are listed in counterclockwise order starting with the point of
+// minimum x-component, ties broken by minimum y-component. Points in the
+// interior of hull edges are not hull vertices.
+
+#include <Mathematics/BSPrecisionPredicates.h>
+#include <Mathematics/FilteredPrimalQuery2.h>
+#include <Mathematics/Line.h>
+#include <Mathematics/Vector2.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace gte
+{
+    // The Real must be 'float' or 'double'.
+    template <typename Real>
+    class ConvexHull2MonotoneChain
+    {
+    public:
+        // Supporting types for the exact turn tests.
+        using Rational = BSPrecisionPredicates::ToLineNumber<Real>;
+        using Query = FilteredPrimalQuery2<Real, Rational>;
+
+        // The class is a functor to support computing the convex hull of
+        // multiple data sets using the same class object.
+        ConvexHull2MonotoneChain()
+            :
+            mEpsilon(static_cast<Real>(0)),
+            mDimension(0),
+            mLine(Vector2<Real>::Zero(), Vector2<Real>::Zero()),
+            mNumPoints(0),
+            mX(nullptr),
+            mY(nullptr),
+            mQuery{},
+            mMin{},
+            mMax{},
+            mInside{},
+            mCandidates{},
+            mHull{}
+        {
+            static_assert(std::is_floating_point<Real>::value,
+                "The input type must be 'float' or 'double'.");
+        }
+
+        // The input point i is (x[i],y[i]) for 0 <= i < numPoints. The
+        // epsilon value is used to determine the intrinsic dimensionality
+        // of the points (d = 0, 1, or 2) as in ConvexHull2. The return value
+        // is 'true' if and only if the hull construction is successful. If
+        // epsilon is zero and the points are exactly collinear, the
+        // dimension is set to 1 and the return value is 'false'.
+        bool operator()(int numPoints, Real const* x, Real const* y, Real epsilon)
+        {
+            mEpsilon = std::max(epsilon, static_cast<Real>(0));
+            mDimension = 0;
+            mLine.origin = Vector2<Real>::Zero();
+            mLine.direction = Vector2<Real>::Zero();
+            mNumPoints = numPoints;
+            mX = x;
+            mY = y;
+            mCandidates.clear();
+            mHull.clear();
+
+            if (mNumPoints < 3)
+            {
+                // ConvexHull2MonotoneChain should be called with at least
+                // three points.
+                return false;
+            }
+
+            ComputeDimension();
+            if (mDimension < 2)
+            {
+                return false;
+            }
+
+            DiscardInteriorPoints();
+
+            // Sort the remaining points and remove duplicates.
+            std::sort(mCandidates.begin(), mCandidates.end(),
+                [x, y](int i0, int i1)
+                {
+                    if (x[i0] < x[i1])
+                    {
+                        return true;
+                    }
+                    if (x[i0] > x[i1])
+                    {
+                        return false;
+                    }
+                    return y[i0] < y[i1];
+                }
+            );
+
+            auto newEnd = std::unique(mCandidates.begin(), mCandidates.end(),
+                [x, y](int i0, int i1)
+                {
+                    return x[i0] == x[i1] && y[i0] == y[i1];
+                }
+            );
+            mCandidates.erase(newEnd, mCandidates.end());
+
+            ComputeChain();
+            if (mHull.size() < 3)
+            {
+                // The points are exactly collinear.
+                Vector2<Real> origin = GetPoint(mHull[0]);
+                Vector2<Real> direction = GetPoint(mHull[1]) - origin;
+                Normalize(direction, false);
+                mDimension = 1;
+                mLine = Line2<Real>(origin, direction);
+                mHull.clear();
+                return false;
+            }
+            return true;
+        }
+
+        // Dimensional information. If GetDimension() returns 1, the points
+        // lie on a line P+t*D (fuzzy comparison when epsilon > 0).
+        inline Real GetEpsilon() const
+        {
+            return mEpsilon;
+        }
+
+        inline int GetDimension() const
+        {
+            return mDimension;
+        }
+
+        inline Line2<Real> const& GetLine() const
+        {
+            return mLine;
+        }
+
+        // Member access.
+        inline int GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline Real const* GetX() const
+        {
+            return mX;
+        }
+
+        inline Real const* GetY() const
+        {
+            return mY;
+        }
+
+        // The number of unique points that were not discarded by the
+        // Akl-Toussaint heuristic, which is the input size of the monotone
+        // chain construction.
+        inline int GetNumCandidates() const
+        {
+            return static_cast<int>(mCandidates.size());
+        }
+
+        // The convex hull is a convex polygon whose vertices are listed in
+        // counterclockwise order.
+        inline std::vector<int> const& GetHull() const
+        {
+            return mHull;
+        }
+
+    private:
+        inline Vector2<Real> GetPoint(int i) const
+        {
+            return Vector2<Real>{ mX[i], mY[i] };
+        }
+
+        // The same classification as that of IntrinsicsVector2, but the
+        // points are stored as separate coordinate arrays.
+        void ComputeDimension()
+        {
+            Real const* coordinate[2] = { mX, mY };
+            std::array<Real, 2>& vmin = mMin;
+            std::array<Real, 2>& vmax = mMax;
+            std::array<int, 2> indexMin{}, indexMax{};
+            for (int j = 0; j < 2; ++j)
+            {
+                vmin[j] = coordinate[j][0];
+                vmax[j] = vmin[j];
+                indexMin[j] = 0;
+                indexMax[j] = 0;
+                for (int i = 1; i < mNumPoints; ++i)
+                {
+                    Real value = coordinate[j][i];
+                    if (value < vmin[j])
+                    {
+                        vmin[j] = value;
+                        indexMin[j] = i;
+                    }
+                    else if (value > vmax[j])
+                    {
+                        vmax[j] = value;
+                        indexMax[j] = i;
+                    }
+                }
+            }
+
+            Real maxRange = vmax[0] - vmin[0];
+            int extreme0 = indexMin[0], extreme1 = indexMax[0];
+            Real range = vmax[1] - vmin[1];
+            if (range > maxRange)
+            {
+                maxRange = range;
+                extreme0 = indexMin[1];
+                extreme1 = indexMax[1];
+            }
+
+            Vector2<Real> origin = GetPoint(extreme0);
+            if (maxRange <= mEpsilon)
+            {
+                // The points are (nearly) the same point.
+                mDimension = 0;
+                return;
+            }
+
+            Vector2<Real> direction = GetPoint(extreme1) - origin;
+            Normalize(direction, false);
+            Real maxDistance = static_cast<Real>(0);
+            for (int i = 0; i < mNumPoints; ++i)
+            {
+                Real distance = std::fabs((mX[i] - origin[0]) * direction[1] -
+                    (mY[i] - origin[1]) * direction[0]);
+                maxDistance = std::max(maxDistance, distance);
+            }
+
+            if (maxDistance <= mEpsilon * maxRange)
+            {
+                // The points are (nearly) on the line origin+t*direction.
+                mDimension = 1;
+                mLine = Line2<Real>(origin, direction);
+                return;
+            }
+
+            mDimension = 2;
+        }
+
+        // The Akl-Toussaint heuristic. The indices of the points that are
+        // not discarded are stored in increasing order in mCandidates.
+        void DiscardInteriorPoints()
+        {
+            // Compute the extreme points in the 8 directions, listed in
+            // counterclockwise order of the directions. The results are
+            // not affected by rounding errors in x+y and x-y, because any
+            // polygon whose vertices are input points can be used. If the
+            // polygon is not convex, the points strictly inside all its
+            // edges are still inside the convex hull of its vertices.
+            std::array<int, 8> extreme{};
+            std::array<Real, 8> maxValue{};
+            GetDirectionalValues(0, maxValue);
+            for (int i = 1; i < mNumPoints; ++i)
+            {
+                std::array<Real, 8> value;
+                GetDirectionalValues(i, value);
+                for (size_t d = 0; d < 8; ++d)
+                {
+                    if (value[d] > maxValue[d])
+                    {
+                        maxValue[d] = value[d];
+                        extreme[d] = i;
+                    }
+                }
+            }
+
+            std::vector<int> polygon;
+            polygon.reserve(8);
+            for (size_t d = 0; d < 8; ++d)
+            {
+                int v = extreme[d];
+                if (polygon.size() == 0 || GetPoint(v) != GetPoint(polygon.back()))
+                {
+                    polygon.push_back(v);
+                }
+            }
+            while (polygon.size() > 1 && GetPoint(polygon.front()) == GetPoint(polygon.back()))
+            {
+                polygon.pop_back();
+            }
+
+            mCandidates.resize(mNumPoints);
+            if (polygon.size() < 3)
+            {
+                for (int i = 0; i < mNumPoints; ++i)
+                {
+                    mCandidates[i] = i;
+                }
+                return;
+            }
+
+            // The edges are padded to 8 by repeating the last edge, so the
+            // inner loop has a constant number of iterations and can be
+            // unrolled. A point on the left of an edge of the
+            // counterclockwise polygon has a negative ToLine determinant.
+            size_t const numEdges = polygon.size();
+            std::array<double, 8> x0{}, y0{}, x1{}, y1{}, errorBound{};
+            for (size_t e = 0; e < 8; ++e)
+            {
+                size_t const e0 = std::min(e, numEdges - 1);
+                size_t const e1 = (e0 + 1 < numEdges ? e0 + 1 : 0);
+                x0[e] = static_cast<double>(mX[polygon[e0]]);
+                y0[e] = static_cast<double>(mY[polygon[e0]]);
+                x1[e] = static_cast<double>(mX[polygon[e1]]) - x0[e];
+                y1[e] = static_cast<double>(mY[polygon[e1]]) - y0[e];
+            }
+
+            // The filter of FilteredPrimalQuery2::ToLine bounds the rounding
+            // error of the determinant by (3 + 16 * u) * u * permanent, where
+            // u is the unit roundoff of 'double' and the permanent is
+            // |dx * y1| + |x1 * dy| for the differences dx = px - x0 and
+            // dy = py - y0. The differences are bounded by the size of the
+            // bounding box of the points, so the error bound of each edge is
+            // a constant, and the loop needs no absolute values. The factor
+            // 4 * u also covers the rounding errors of the bound itself. The
+            // term 8 * denorm_min covers the absolute errors of products
+            // that are subnormal, so the bound is also valid on underflow.
+            double const u = 0.5 * std::numeric_limits<double>::epsilon();
+            double const width = static_cast<double>(mMax[0]) - static_cast<double>(mMin[0]);
+            double const height = static_cast<double>(mMax[1]) - static_cast<double>(mMin[1]);
+            double const coefficient = 4.0 * u;
+            double const minError = 8.0 * std::numeric_limits<double>::denorm_min();
+            for (size_t e = 0; e < 8; ++e)
+            {
+                errorBound[e] = coefficient * (width * std::fabs(y1[e]) +
+                    height * std::fabs(x1[e])) + minError;
+            }
+
+            // The loops use local copies of the members so that the
+            // compiler can determine that the stores do not modify them.
+            int const numPoints = mNumPoints;
+            Real const* x = mX;
+            Real const* y = mY;
+            mInside.resize(numPoints);
+            uint32_t* discard = mInside.data();
+            for (int i = 0; i < numPoints; ++i)
+            {
+                double const px = static_cast<double>(x[i]);
+                double const py = static_cast<double>(y[i]);
+                uint32_t inside = 1;
+                for (size_t e = 0; e < 8; ++e)
+                {
+                    double const det = (px - x0[e]) * y1[e] - x1[e] * (py - y0[e]);
+                    inside &= static_cast<uint32_t>(-det > errorBound[e]);
+                }
+                discard[i] = inside;
+            }
+
+            // Append the indices of the points that are not discarded
+            // without branching.
+            int* candidates = mCandidates.data();
+            size_t numCandidates = 0;
+            for (int i = 0; i < numPoints; ++i)
+            {
+                candidates[numCandidates] = i;
+                numCandidates += static_cast<size_t>(discard[i] ^ 1u);
+            }
+            mCandidates.resize(numCandidates);
+        }
+
+        // The signed components of point i in the directions (1,0), (1,1),
+        // (0,1), (-1,1), (-1,0), (-1,-1), (0,-1) and (1,-1).
+        inline void GetDirectionalValues(int i, std::array<Real, 8>& value) const
+        {
+            Real const x = mX[i], y = mY[i];
+            value[0] = x;
+            value[1] = x + y;
+            value[2] = y;
+            value[3] = y - x;
+            value[4] = -x;
+            value[5] = -(x + y);
+            value[6] = -y;
+            value[7] = x - y;
+        }
+
+        // The lower chain is computed from left to right and the upper
+        // chain from right to left. A vertex is removed from the chain
+        // unless the turn at it is strictly counterclockwise.
+        void ComputeChain()
+        {
+            int const numCandidates = static_cast<int>(mCandidates.size());
+            mHull.resize(2 * static_cast<size_t>(numCandidates));
+            int k = 0;
+            for (int i = 0; i < numCandidates; ++i)
+            {
+                int const c = mCandidates[i];
+                while (k >= 2 && !IsLeftTurn(mHull[k - 2], mHull[k - 1], c))
+                {
+                    --k;
+                }
+                mHull[k++] = c;
+            }
+
+            for (int i = numCandidates - 2, lower = k + 1; i >= 0; --i)
+            {
+                int const c = mCandidates[i];
+                while (k >= lower && !IsLeftTurn(mHull[k - 2], mHull[k - 1], c))
+                {
+                    --k;
+                }
+                mHull[k++] = c;
+            }
+
+            // The last vertex is the first one.
+            mHull.resize(static_cast<size_t>(k) - 1);
+        }
+
+        // The function returns 'true' when <V0,V1,V2> is a counterclockwise
+        // triangle.
+        inline bool IsLeftTurn(int v0, int v1, int v2) const
+        {
+            return mQuery.ToLineExtended(GetPoint(v2), GetPoint(v0), GetPoint(v1)) ==
+                PrimalQuery2<Rational>::ORDER_POSITIVE;
+        }
+
+        Real mEpsilon;
+        int mDimension;
+        Line2<Real> mLine;
+
+        int mNumPoints;
+        Real const* mX;
+        Real const* mY;
+        Query mQuery;
+
+        // The axis-aligned bounding box of the points.
+        std::array<Real, 2> mMin, mMax;
+
+        // Storage for the Akl-Toussaint heuristic, where mInside[i] is 1
+        // when point i is discarded and 0 otherwise.
+        std::vector<uint32_t> mInside;
+        std::vector<int> mCandidates, mHull;
+    };
+}
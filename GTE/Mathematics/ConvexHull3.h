@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -31,15 +31,18 @@
 // if possible. If that test fails, rational arithmetic is used. For typical
 // datasets, the indeterminate sign from interval arithmetic happens rarely.
 
+#include <Mathematics/BSPrecisionPredicates.h>
 #include <Mathematics/ConvexHull2.h>
+#include <Mathematics/Profiler.h>
 #include <Mathematics/SWInterval.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/Vector3.h>
 #include <Mathematics/VETManifoldMesh.h>
 #include <algorithm>
+#include <memory>
 #include <numeric>
 #include <queue>
 #include <set>
-#include <thread>
 
 namespace gte
 {
@@ -49,7 +52,7 @@ namespace gte
     public:
         // Supporting constants and types for rational arithmetic used in
         // the exact predicate for sign computations.
-        static int constexpr NumWords = std::is_same<Real, float>::value ? 27 : 197;
+        static int constexpr NumWords = BSPrecisionPredicates::ToPlane<Real>(true);
         using Rational = BSNumber<UIntegerFP32<NumWords>>;
 
         // The class is a functor to support computing the convex hull of
@@ -62,111 +65,90 @@ namespace gte
             mDimension(0),
             mVertices{},
             mHull{},
-            mHullMesh{}
+            mHullMesh{},
+            mScheduler{},
+            mRetainCapacity(false),
+            mSorted{}
         {
         }
 
         // Compute the exact convex hull using a blend of interval arithmetic
         // and rational arithmetic. The code runs single-threaded when
         // lgNumThreads = 0. It runs multithreaded when lgNumThreads > 0,
-        // where the number of threads is 2^{lgNumThreads} > 1.
+        // where the number of threads is 2^{lgNumThreads} > 1. The threads
+        // are owned by a TaskScheduler that is created on the first
+        // multithreaded call and reused by later calls with the same number
+        // of threads.
         void operator()(size_t numPoints, Vector3<Real> const* points,
             size_t lgNumThreads)
         {
-            LogAssert(numPoints > 0 && points != nullptr, "Invalid argument.");
-
-            // Allocate storage for any rational points that must be computed
-            // in the exact sign predicates. The rational points are memoized.
-            mPoints = points;
-            mRPoints.resize(numPoints);
-            mConverted.resize(numPoints);
-            std::fill(mConverted.begin(), mConverted.end(), 0);
-
-            // Sort all the points indirectly.
-            auto lessThanPoints = [this](size_t s0, size_t s1)
-            {
-                return mPoints[s0] < mPoints[s1];
-            };
-
-            auto equalPoints = [this](size_t s0, size_t s1)
-            {
-                return mPoints[s0] == mPoints[s1];
-            };
-
-            std::vector<size_t> sorted(numPoints);
-            std::iota(sorted.begin(), sorted.end(), 0);
-            std::sort(sorted.begin(), sorted.end(), lessThanPoints);
-            auto newEnd = std::unique(sorted.begin(), sorted.end(), equalPoints);
-            sorted.erase(newEnd, sorted.end());
-
             if (lgNumThreads > 0)
             {
                 size_t numThreads = (static_cast<size_t>(1) << lgNumThreads);
-                size_t load = sorted.size() / numThreads;
-                std::vector<size_t> inNumSorted(numThreads);
-                std::vector<size_t*> inSorted(numThreads);
-                std::vector<std::vector<size_t>> outVertices(numThreads);
-                std::vector<std::thread> process(numThreads);
-                inNumSorted.back() = sorted.size();
-                inSorted.front() = sorted.data();
-                for (size_t i0 = 0, i1 = 1; i1 < numThreads; i0 = i1++)
+                if (!mScheduler || mScheduler->GetNumThreads() != numThreads)
                 {
-                    inNumSorted[i0] = load;
-                    inNumSorted.back() -= load;
-                    inSorted[i1] = inSorted[i0] + load;
+                    mScheduler = std::make_shared<TaskScheduler>(numThreads);
                 }
-
-                while (numThreads > 1)
+                operator()(numPoints, points, *mScheduler);
+            }
+            else
+            {
+                GTE_PROFILE_ZONE("ConvexHull3");
                 {
-                    for (size_t i = 0; i < numThreads; ++i)
-                    {
-                        process[i] = std::thread(
-                            [this, i, &inNumSorted, &inSorted, &outVertices]()
-                            {
-                                size_t dimension = 0;
-                                std::vector<size_t> hull;
-                                VETManifoldMesh hullMesh;
-                                ComputeHull(inNumSorted[i], inSorted[i], dimension,
-                                    outVertices[i], hull, hullMesh);
-                            });
-                    }
-
-                    numThreads /= 2;
+                    GTE_PROFILE_ZONE("ConvexHull3::SortPoints");
+                    SortPoints(numPoints, points, mSorted);
+                }
+                {
+                    GTE_PROFILE_ZONE("ConvexHull3::ComputeHull");
+                    ComputeHull(mSorted.size(), mSorted.data(), mDimension, mVertices,
+                        mHull, mHullMesh);
+                }
+                ReleaseWorkspace();
+            }
+        }
 
-                    auto target = sorted.begin();
-                    inSorted[0] = sorted.data();
-                    for (size_t i = 0, k = 0; i < numThreads; ++i)
-                    {
-                        process[2 * i].join();
-                        process[2 * i + 1].join();
+        void operator()(std::vector<Vector3<Real>> const& points, size_t lgNumThreads)
+        {
+            operator()(points.size(), points.data(), lgNumThreads);
+        }
 
-                        inNumSorted[i] = 0;
-                        auto begin = target;
-                        for (size_t j = 0; j < 2; ++j, ++k)
-                        {
-                            size_t numVertices = outVertices[k].size();
-                            inNumSorted[i] += numVertices;
-                            std::copy(outVertices[k].begin(), outVertices[k].end(), target);
-                            target += numVertices;
-                        }
-                        inSorted[i + 1] = inSorted[i] + inNumSorted[i];
-                        std::sort(begin, target, lessThanPoints);
-                    }
-                }
+        // Compute the exact convex hull using the threads of a scheduler,
+        // which can have any number of threads and can be shared with other
+        // computations. The sorted points are partitioned into subsets,
+        // several per thread, whose hulls are computed and merged
+        // recursively as tasks of the scheduler. Idle threads steal pending
+        // tasks, so the load is balanced by the actual costs of the hulls
+        // rather than by the numbers of points.
+        void operator()(size_t numPoints, Vector3<Real> const* points,
+            TaskScheduler& scheduler)
+        {
+            GTE_PROFILE_ZONE("ConvexHull3");
+            std::vector<size_t>& sorted = mSorted;
+            {
+                GTE_PROFILE_ZONE("ConvexHull3::SortPoints");
+                SortPoints(numPoints, points, sorted);
+            }
 
-                ComputeHull(inNumSorted[0], inSorted[0], mDimension, mVertices,
-                    mHull, mHullMesh);
+            GTE_PROFILE_ZONE("ConvexHull3::ComputeHull");
+            size_t numLeaves = std::min(
+                LeavesPerThread * scheduler.GetNumThreads(),
+                sorted.size() / MinLeafSize);
+            if (numLeaves > 1)
+            {
+                ComputeHull(scheduler, numLeaves, sorted.size(), sorted.data(),
+                    mDimension, mVertices, mHull, mHullMesh);
             }
             else
             {
                 ComputeHull(sorted.size(), sorted.data(), mDimension, mVertices,
                     mHull, mHullMesh);
             }
+            ReleaseWorkspace();
         }
 
-        void operator()(std::vector<Vector3<Real>> const& points, size_t lgNumThreads)
+        void operator()(std::vector<Vector3<Real>> const& points, TaskScheduler& scheduler)
         {
-            operator()(points.size(), points.data(), lgNumThreads);
+            operator()(points.size(), points.data(), scheduler);
         }
 
         // The dimension is 0 (hull is a single point), 1 (hull is a line
@@ -223,7 +205,125 @@ namespace gte
             return mHullMesh;
         }
 
+        // Memory reuse when the functor is called for many data sets. By
+        // default, the temporary array of sorted point indices is released
+        // when a call returns. When the capacity is retained, it is kept for
+        // the next call, and the vertex, edge and triangle objects of the
+        // hull mesh are recycled rather than deleted; see
+        // ETManifoldMesh::RetainCapacity. The subhull meshes of the
+        // multithreaded calls are not retained. Disabling the retention
+        // releases the kept memory.
+        void RetainCapacity(bool retain)
+        {
+            mRetainCapacity = retain;
+            mHullMesh.RetainCapacity(retain);
+            ReleaseWorkspace();
+        }
+
+        inline bool RetainsCapacity() const
+        {
+            return mRetainCapacity;
+        }
+
+        // Allocate storage for data sets of at most maxNumPoints points,
+        // including the hash-table buckets of the hull mesh. A convex
+        // polyhedron with V vertices has at most 2*V-4 triangles and 3*V-6
+        // edges. This is useful only when the capacity is retained.
+        void Reserve(size_t maxNumPoints)
+        {
+            size_t const maxNumTriangles = 2 * maxNumPoints;
+            size_t const maxNumEdges = 3 * maxNumPoints;
+            mRPoints.reserve(maxNumPoints);
+            mConverted.reserve(maxNumPoints);
+            mSorted.reserve(maxNumPoints);
+            mVertices.reserve(maxNumPoints);
+            mHull.reserve(3 * maxNumTriangles);
+            mHullMesh.Reserve(maxNumPoints, maxNumEdges, maxNumTriangles);
+        }
+
     private:
+        // The multithreaded partition of the points has LeavesPerThread
+        // subsets per thread, each with at least MinLeafSize points.
+        static size_t constexpr LeavesPerThread = 4;
+        static size_t constexpr MinLeafSize = 256;
+
+        // Sort the points indirectly and remove duplicates. The storage for
+        // the memoized rational points is allocated.
+        void SortPoints(size_t numPoints, Vector3<Real> const* points,
+            std::vector<size_t>& sorted)
+        {
+            LogAssert(numPoints > 0 && points != nullptr, "Invalid argument.");
+
+            // Allocate storage for any rational points that must be computed
+            // in the exact sign predicates. The rational points are memoized.
+            mPoints = points;
+            mRPoints.resize(numPoints);
+            mConverted.resize(numPoints);
+            std::fill(mConverted.begin(), mConverted.end(), 0);
+
+            sorted.resize(numPoints);
+            std::iota(sorted.begin(), sorted.end(), 0);
+            std::sort(sorted.begin(), sorted.end(),
+                [this](size_t s0, size_t s1)
+                {
+                    return mPoints[s0] < mPoints[s1];
+                });
+            auto newEnd = std::unique(sorted.begin(), sorted.end(),
+                [this](size_t s0, size_t s1)
+                {
+                    return mPoints[s0] == mPoints[s1];
+                });
+            sorted.erase(newEnd, sorted.end());
+        }
+
+        // Compute the hulls of the first and second halves of the leaf
+        // subsets of sorted[], the first half as a task of the scheduler and
+        // the second half in the calling thread. The hull of the union of
+        // the hull vertices of the halves is the hull of sorted[]. The
+        // subsets have disjoint indices, so their tasks access disjoint
+        // elements of mRPoints and mConverted.
+        void ComputeHull(TaskScheduler& scheduler, size_t numLeaves,
+            size_t numSorted, size_t* sorted, size_t& dimension,
+            std::vector<size_t>& vertices, std::vector<size_t>& hull,
+            VETManifoldMesh& hullMesh)
+        {
+            if (numLeaves > 1)
+            {
+                size_t numLeaves0 = numLeaves / 2;
+                size_t numSorted0 = numSorted * numLeaves0 / numLeaves;
+                std::vector<size_t> vertices0, vertices1;
+
+                TaskScheduler::TaskGroup group;
+                scheduler.Spawn(group,
+                    [this, &scheduler, numLeaves0, numSorted0, sorted, &vertices0]()
+                    {
+                        size_t subDimension = 0;
+                        std::vector<size_t> subHull;
+                        VETManifoldMesh subHullMesh;
+                        ComputeHull(scheduler, numLeaves0, numSorted0, sorted,
+                            subDimension, vertices0, subHull, subHullMesh);
+                    });
+
+                ComputeHull(scheduler, numLeaves - numLeaves0, numSorted - numSorted0,
+                    sorted + numSorted0, dimension, vertices1, hull, hullMesh);
+                scheduler.Wait(group);
+
+                // The hull vertices of each half are a subset of the indices
+                // of that half, so they can be copied to the front of
+                // sorted[] in order.
+                std::copy(vertices0.begin(), vertices0.end(), sorted);
+                std::copy(vertices1.begin(), vertices1.end(), sorted + vertices0.size());
+                numSorted = vertices0.size() + vertices1.size();
+                std::sort(sorted, sorted + numSorted,
+                    [this](size_t s0, size_t s1)
+                    {
+                        return mPoints[s0] < mPoints[s1];
+                    });
+            }
+
+            ComputeHull(numSorted, sorted, dimension, vertices, hull, hullMesh);
+        }
+
         void ComputeHull(size_t numSorted, size_t* sorted, size_t& dimension,
             std::vector<size_t>& vertices, std::vector<size_t>& hull,
             VETManifoldMesh& hullMesh)
@@ -652,5 +752,20 @@ namespace gte
         std::vector<size_t> mVertices;
         std::vector<size_t> mHull;
         VETManifoldMesh mHullMesh;
+
+        // The scheduler for the lgNumThreads > 0 calls of operator().
+        std::shared_ptr<TaskScheduler> mScheduler;
+
+        // Support for reusing memory across calls of operator().
+        void ReleaseWorkspace()
+        {
+            if (!mRetainCapacity)
+            {
+                std::vector<size_t>().swap(mSorted);
+            }
+        }
+
+        bool mRetainCapacity;
+        std::vector<size_t> mSorted;
     };
 }
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Minimax polynomial approximations to cos(x).  The polynomial p(x) of
 // degree D has only even-power terms, is required to have constant term 1,
@@ -44,34 +45,70 @@ namespace gte
             return poly;
         }
 
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Evaluate(degree<D>(), x);
+        }
+
+        template <int D>
+        inline static SIMD4Value<Real> DegreeRR(SIMD4Value<Real> const& x)
+        {
+            SIMD4Value<Real> y, sign;
+            Reduce(x, y, sign);
+            return sign * Degree<D>(y);
+        }
+
+        // Evaluate the estimates for arrays, result[i] = Degree<D>(x[i]) or
+        // result[i] = DegreeRR<D>(x[i]), 4 elements at a time. The arrays
+        // may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
+        template <int D>
+        static void DegreeRR(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return DegreeRR<D>(v); });
+        }
+
     private:
         // Metaprogramming and private implementation to allow specialization
         // of a template member function.
         template <int D> struct degree {};
 
-        inline static Real Evaluate(degree<2>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<2>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_COS_DEG2_C1;
             poly = (Real)GTE_C_COS_DEG2_C0 + poly * xsqr;
             return poly;
         }
 
-        inline static Real Evaluate(degree<4>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<4>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_COS_DEG4_C2;
             poly = (Real)GTE_C_COS_DEG4_C1 + poly * xsqr;
             poly = (Real)GTE_C_COS_DEG4_C0 + poly * xsqr;
             return poly;
         }
 
-        inline static Real Evaluate(degree<6>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<6>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_COS_DEG6_C3;
             poly = (Real)GTE_C_COS_DEG6_C2 + poly * xsqr;
             poly = (Real)GTE_C_COS_DEG6_C1 + poly * xsqr;
@@ -79,10 +116,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<8>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<8>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_COS_DEG8_C4;
             poly = (Real)GTE_C_COS_DEG8_C3 + poly * xsqr;
             poly = (Real)GTE_C_COS_DEG8_C2 + poly * xsqr;
@@ -91,10 +129,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<10>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<10>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_COS_DEG10_C5;
             poly = (Real)GTE_C_COS_DEG10_C4 + poly * xsqr;
             poly = (Real)GTE_C_COS_DEG10_C3 + poly * xsqr;
@@ -135,5 +174,19 @@ namespace gte
                 sign = (Real)1;
             }
         }
+
+        inline static void Reduce(SIMD4Value<Real> const& x, SIMD4Value<Real>& y,
+            SIMD4Value<Real>& sign)
+        {
+            typedef SIMD4Value<Real> V;
+            V quotient = (Real)GTE_C_INV_TWO_PI * x;
+            quotient = V::Truncate(V::Select(x < (Real)0,
+                quotient - (Real)0.5, quotient + (Real)0.5));
+            y = x - (Real)GTE_C_TWO_PI * quotient;
+            V above = (Real)GTE_C_HALF_PI < y, below = y < (Real)-GTE_C_HALF_PI;
+            sign = V::Select(above, (Real)-1, V::Select(below, (Real)-1, (Real)1));
+            y = V::Select(above, (Real)GTE_C_PI - y,
+                V::Select(below, (Real)-GTE_C_PI - y, y));
+        }
     };
 }
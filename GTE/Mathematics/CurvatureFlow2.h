@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -31,13 +31,14 @@ namespace gte
     protected:
         virtual void OnUpdateSingle(int x, int y) override
         {
-            this->LookUp9(x, y);
+            typename PdeFilter2<Real>::Neighborhood u;
+            this->LookUp9(x, y, u);
 
-            Real ux = this->mHalfInvDx * (this->mUpz - this->mUmz);
-            Real uy = this->mHalfInvDy * (this->mUzp - this->mUzm);
-            Real uxx = this->mInvDxDx * (this->mUpz - (Real)2 * this->mUzz + this->mUmz);
-            Real uxy = this->mFourthInvDxDy * (this->mUmm + this->mUpp - this->mUmp - this->mUpm);
-            Real uyy = this->mInvDyDy * (this->mUzp - (Real)2 * this->mUzz + this->mUzm);
+            Real ux = this->mHalfInvDx * (u.pz - u.mz);
+            Real uy = this->mHalfInvDy * (u.zp - u.zm);
+            Real uxx = this->mInvDxDx * (u.pz - (Real)2 * u.zz + u.mz);
+            Real uxy = this->mFourthInvDxDy * (u.mm + u.pp - u.mp - u.pm);
+            Real uyy = this->mInvDyDy * (u.zp - (Real)2 * u.zz + u.zm);
 
             Real sqrUx = ux * ux;
             Real sqrUy = uy * uy;
@@ -45,11 +46,11 @@ namespace gte
             if (denom > (Real)0)
             {
                 Real numer = uxx * sqrUy + uyy * sqrUx - (Real)0.5 * uxy * ux * uy;
-                this->mBuffer[this->mDst][y][x] = this->mUzz + this->mTimeStep * numer / denom;
+                this->mBuffer[this->mDst][y][x] = u.zz + this->mTimeStep * numer / denom;
             }
             else
             {
-                this->mBuffer[this->mDst][y][x] = this->mUzz;
+                this->mBuffer[this->mDst][y][x] = u.zz;
             }
         }
     };
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -31,17 +31,18 @@ namespace gte
     protected:
         virtual void OnUpdateSingle(int x, int y, int z) override
         {
-            this->LookUp27(x, y, z);
+            typename PdeFilter3<Real>::Neighborhood u;
+            this->LookUp27(x, y, z, u);
 
-            Real ux = this->mHalfInvDx * (this->mUpzz - this->mUmzz);
-            Real uy = this->mHalfInvDy * (this->mUzpz - this->mUzmz);
-            Real uz = this->mHalfInvDz * (this->mUzzp - this->mUzzm);
-            Real uxx = this->mInvDxDx * (this->mUpzz - (Real)2 * this->mUzzz + this->mUmzz);
-            Real uxy = this->mFourthInvDxDy * (this->mUmmz + this->mUppz - this->mUpmz - this->mUmpz);
-            Real uxz = this->mFourthInvDxDz * (this->mUmzm + this->mUpzp - this->mUpzm - this->mUmzp);
-            Real uyy = this->mInvDyDy * (this->mUzpz - (Real)2 * this->mUzzz + this->mUzmz);
-            Real uyz = this->mFourthInvDyDz * (this->mUzmm + this->mUzpp - this->mUzpm - this->mUzmp);
-            Real uzz = this->mInvDzDz * (this->mUzzp - (Real)2 * this->mUzzz + this->mUzzm);
+            Real ux = this->mHalfInvDx * (u.pzz - u.mzz);
+            Real uy = this->mHalfInvDy * (u.zpz - u.zmz);
+            Real uz = this->mHalfInvDz * (u.zzp - u.zzm);
+            Real uxx = this->mInvDxDx * (u.pzz - (Real)2 * u.zzz + u.mzz);
+            Real uxy = this->mFourthInvDxDy * (u.mmz + u.ppz - u.pmz - u.mpz);
+            Real uxz = this->mFourthInvDxDz * (u.mzm + u.pzp - u.pzm - u.mzp);
+            Real uyy = this->mInvDyDy * (u.zpz - (Real)2 * u.zzz + u.zmz);
+            Real uyz = this->mFourthInvDyDz * (u.zmm + u.zpp - u.zpm - u.zmp);
+            Real uzz = this->mInvDzDz * (u.zzp - (Real)2 * u.zzz + u.zzm);
 
             Real denom = ux * ux + uy * uy + uz * uz;
             if (denom > (Real)0)
@@ -50,11 +51,11 @@ namespace gte
                 Real numer1 = uz * (uxx*uz - uxz * ux) + ux * (uzz*ux - uxz * uz);
                 Real numer2 = uz * (uyy*uz - uyz * uy) + uy * (uzz*uy - uyz * uz);
                 Real numer = numer0 + numer1 + numer2;
-                this->mBuffer[this->mDst][z][y][x] = this->mUzzz + this->mTimeStep * numer / denom;
+                this->mBuffer[this->mDst][z][y][x] = u.zzz + this->mTimeStep * numer / denom;
             }
             else
             {
-                this->mBuffer[this->mDst][z][y][x] = this->mUzzz;
+                this->mBuffer[this->mDst][z][y][x] = u.zzz;
             }
         }
     };
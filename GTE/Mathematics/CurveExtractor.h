@@ -3,15 +3,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace gte
@@ -161,13 +166,124 @@ namespace gte
             Convert(rationalVertices, vertices);
         }
 
+        // Extract the level curves for each level of a set of levels in one
+        // pass over the image. The outputs vertices[i] and edges[i] are the
+        // level curves for levels[i] without duplicate vertices and edges.
+        // They are those of Extract(levels[i], vertices[i], edges[i])
+        // followed by MakeUnique(vertices[i], edges[i]), independently of
+        // the number of threads. The image is partitioned into tiles of
+        // TILE_ROWS rows of squares. The tiles are extracted and their
+        // duplicates removed by numThreads threads, which are owned by a
+        // TaskScheduler that is created on the first multithreaded call and
+        // reused by later calls with the same number of threads. The tiles
+        // are then welded in order, matching the vertices and edges on the
+        // rows shared by consecutive tiles, so the welding is deterministic.
+        enum { TILE_ROWS = 64 };
+
+        void Extract(std::vector<T> const& levels, size_t numThreads,
+            std::vector<std::vector<Vertex>>& vertices,
+            std::vector<std::vector<Edge>>& edges)
+        {
+            // Sort the levels so that the levels for a square can be found
+            // by binary search on the range of its pixel values.
+            size_t const numLevels = levels.size();
+            std::vector<std::pair<int64_t, size_t>> sortedLevels(numLevels);
+            for (size_t i = 0; i < numLevels; ++i)
+            {
+                sortedLevels[i] = std::make_pair(static_cast<int64_t>(levels[i]), i);
+            }
+            std::sort(sortedLevels.begin(), sortedLevels.end());
+            std::vector<int64_t> sortedValues(numLevels);
+            for (size_t i = 0; i < numLevels; ++i)
+            {
+                sortedValues[i] = sortedLevels[i].first;
+            }
+
+            // Extract the tiles, tileVertices[tile][k] and tileEdges[tile][k]
+            // for sorted level k.
+            int const numRows = mYBound - 1;
+            int const numTiles = (numRows + TILE_ROWS - 1) / TILE_ROWS;
+            std::vector<std::vector<std::vector<Vertex>>> tileVertices(numTiles,
+                std::vector<std::vector<Vertex>>(numLevels));
+            std::vector<std::vector<std::vector<Edge>>> tileEdges(numTiles,
+                std::vector<std::vector<Edge>>(numLevels));
+            auto ExtractTile = [this, numRows, &sortedValues, &tileVertices, &tileEdges](int tile)
+            {
+                int y0 = tile * TILE_ROWS;
+                int y1 = std::min(y0 + TILE_ROWS, numRows);
+                ExtractRows(sortedValues, y0, y1, tileVertices[tile], tileEdges[tile]);
+                for (size_t k = 0; k < tileVertices[tile].size(); ++k)
+                {
+                    MakeUnique(tileVertices[tile][k], tileEdges[tile][k]);
+                }
+            };
+
+            vertices.resize(numLevels);
+            edges.resize(numLevels);
+            auto WeldLevel = [this, numRows, numTiles, &sortedLevels, &tileVertices,
+                &tileEdges, &vertices, &edges](size_t k)
+            {
+                size_t i = sortedLevels[k].second;
+                Weld(numRows, numTiles, k, tileVertices, tileEdges, vertices[i], edges[i]);
+            };
+
+            if (numThreads <= 1)
+            {
+                for (int tile = 0; tile < numTiles; ++tile)
+                {
+                    ExtractTile(tile);
+                }
+                for (size_t k = 0; k < numLevels; ++k)
+                {
+                    WeldLevel(k);
+                }
+                return;
+            }
+
+            if (!mScheduler || mScheduler->GetNumThreads() != numThreads)
+            {
+                mScheduler = std::make_shared<TaskScheduler>(numThreads);
+            }
+
+            TaskScheduler::TaskGroup group;
+            for (int tile = 1; tile < numTiles; ++tile)
+            {
+                mScheduler->Spawn(group, [&ExtractTile, tile]() { ExtractTile(tile); });
+            }
+            ExtractTile(0);
+            mScheduler->Wait(group);
+
+            // The levels are welded independently.
+            for (size_t k = 1; k < numLevels; ++k)
+            {
+                mScheduler->Spawn(group, [&WeldLevel, k]() { WeldLevel(k); });
+            }
+            if (numLevels > 0)
+            {
+                WeldLevel(0);
+            }
+            mScheduler->Wait(group);
+        }
+
+        // Extract the level curve for a single level with tiled extraction.
+        // The output has no duplicate vertices or edges.
+        void Extract(T level, size_t numThreads, std::vector<Vertex>& vertices,
+            std::vector<Edge>& edges)
+        {
+            std::vector<std::vector<Vertex>> levelVertices;
+            std::vector<std::vector<Edge>> levelEdges;
+            Extract(std::vector<T>{ level }, numThreads, levelVertices, levelEdges);
+            vertices = std::move(levelVertices[0]);
+            edges = std::move(levelEdges[0]);
+        }
+
         // The extraction has duplicate vertices on edges shared by pixels.
         // This function will eliminate the duplicates.
         void MakeUnique(std::vector<Vertex>& vertices, std::vector<Edge>& edges)
         {
             size_t numVertices = vertices.size();
             size_t numEdges = edges.size();
-            if (numVertices == 0 || numEdges == 0)
+            if (numVertices == 0)
             {
                 return;
             }
@@ -192,14 +308,18 @@ namespace gte
             int nextEdge = 0;
             for (size_t e = 0; e < numEdges; ++e)
             {
-                // Replace old vertex indices by new vertex indices.
+                // Replace old vertex indices by new vertex indices. The
+                // edge is constructed again so that its indices are ordered,
+                // which is required for the duplicate test.
                 Edge& edge = edges[e];
+                std::array<int, 2> v;
                 for (int i = 0; i < 2; ++i)
                 {
                     auto iter = vmap.find(vertices[edge.v[i]]);
                     LogAssert(iter != vmap.end(), "Expecting the vertex to be in the vmap.");
-                    edge.v[i] = iter->second;
+                    v[i] = iter->second;
                 }
+                edge = Edge(v[0], v[1]);
 
                 // Keep only unique edges.
                 auto result = emap.insert(std::make_pair(edge, nextEdge));
@@ -255,7 +375,104 @@ namespace gte
             static_assert(std::is_integral<T>::value && sizeof(T) <= 4,
                 "Type T must be int{8,16,32}_t or uint{8,16,32}_t.");
             LogAssert(mXBound > 1 && mYBound > 1 && mInputPixels != nullptr, "Invalid input.");
-            mPixels.resize(static_cast<size_t>(mXBound * mYBound));
+        }
+
+        // Extract the level curves in the squares of rows y0 <= y < y1 for
+        // the sorted levels, appending the vertices and edges for levels[k]
+        // to vertices[k] and edges[k]. A square is processed only for the
+        // levels in the range of its pixel values; for the other levels its
+        // pixel values have the same sign and it contains no level curve.
+        virtual void ExtractRows(std::vector<int64_t> const& levels, int y0, int y1,
+            std::vector<std::vector<Vertex>>& vertices,
+            std::vector<std::vector<Edge>>& edges) = 0;
+
+        // Get the range [first,last) of sorted levels for the pixel values
+        // of a square.
+        static inline std::pair<size_t, size_t> GetLevelRange(
+            std::vector<int64_t> const& levels, int64_t f00, int64_t f10, int64_t f11, int64_t f01)
+        {
+            int64_t fmin = std::min(std::min(f00, f10), std::min(f11, f01));
+            int64_t fmax = std::max(std::max(f00, f10), std::max(f11, f01));
+            auto first = std::lower_bound(levels.begin(), levels.end(), fmin);
+            auto last = std::upper_bound(first, levels.end(), fmax);
+            return std::make_pair(static_cast<size_t>(first - levels.begin()),
+                static_cast<size_t>(last - levels.begin()));
+        }
+
+        // Weld the duplicate-free tiles for sorted level k. A vertex or an
+        // edge can occur in two tiles only when it is on the row shared by
+        // consecutive tiles, so only those are looked up. The vertices and
+        // edges are numbered by their first occurrence in the tiles, which
+        // is the numbering of MakeUnique for the untiled extraction.
+        void Weld(int numRows, int numTiles, size_t k,
+            std::vector<std::vector<std::vector<Vertex>>> const& tileVertices,
+            std::vector<std::vector<std::vector<Edge>>> const& tileEdges,
+            std::vector<Vertex>& vertices, std::vector<Edge>& edges) const
+        {
+            auto OnRow = [](Vertex const& vertex, int64_t y)
+            {
+                return vertex.yNumer == y * vertex.yDenom;
+            };
+
+            vertices.clear();
+            edges.clear();
+            std::map<Vertex, int> borderVertices;
+            std::set<Edge> borderEdges;
+            std::vector<int> global;
+            for (int tile = 0; tile < numTiles; ++tile)
+            {
+                std::vector<Vertex> const& tv = tileVertices[tile][k];
+                std::vector<Edge> const& te = tileEdges[tile][k];
+                int64_t y0 = static_cast<int64_t>(tile) * TILE_ROWS;
+                int64_t y1 = std::min(y0 + TILE_ROWS, static_cast<int64_t>(numRows));
+
+                // Map the tile vertices to the global vertices.
+                global.resize(tv.size());
+                for (size_t i = 0; i < tv.size(); ++i)
+                {
+                    if (tile > 0 && OnRow(tv[i], y0))
+                    {
+                        auto iter = borderVertices.find(tv[i]);
+                        if (iter != borderVertices.end())
+                        {
+                            global[i] = iter->second;
+                            continue;
+                        }
+                    }
+                    global[i] = static_cast<int>(vertices.size());
+                    vertices.push_back(tv[i]);
+                }
+
+                for (auto const& edge : te)
+                {
+                    Edge globalEdge(global[edge.v[0]], global[edge.v[1]]);
+                    if (tile > 0 && OnRow(tv[edge.v[0]], y0) && OnRow(tv[edge.v[1]], y0)
+                        && borderEdges.find(globalEdge) != borderEdges.end())
+                    {
+                        continue;
+                    }
+                    edges.push_back(globalEdge);
+                }
+
+                // Save the vertices and edges on the row shared with the
+                // next tile.
+                borderVertices.clear();
+                borderEdges.clear();
+                for (size_t i = 0; i < tv.size(); ++i)
+                {
+                    if (OnRow(tv[i], y1))
+                    {
+                        borderVertices.insert(std::make_pair(tv[i], global[i]));
+                    }
+                }
+                for (auto const& edge : te)
+                {
+                    if (OnRow(tv[edge.v[0]], y1) && OnRow(tv[edge.v[1]], y1))
+                    {
+                        borderEdges.insert(Edge(global[edge.v[0]], global[edge.v[1]]));
+                    }
+                }
+            }
         }
 
         void AddVertex(std::vector<Vertex>& vertices,
@@ -277,6 +494,6 @@ namespace gte
 
         int mXBound, mYBound;
         T const* mInputPixels;
-        std::vector<int64_t> mPixels;
+        std::shared_ptr<TaskScheduler> mScheduler;
     };
 }
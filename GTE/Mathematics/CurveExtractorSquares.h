@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -44,40 +44,53 @@ namespace gte
         virtual void Extract(T level, std::vector<Vertex>& vertices,
             std::vector<Edge>& edges) override
         {
-            // Adjust the image so that the level set is F(x,y) = 0.
-            int64_t levelI64 = static_cast<int64_t>(level);
-            for (size_t i = 0; i < this->mPixels.size(); ++i)
-            {
-                int64_t inputI64 = static_cast<int64_t>(this->mInputPixels[i]);
-                this->mPixels[i] = inputI64 - levelI64;
-            }
+            std::vector<std::vector<Vertex>> levelVertices(1);
+            std::vector<std::vector<Edge>> levelEdges(1);
+            ExtractRows(std::vector<int64_t>{ static_cast<int64_t>(level) }, 0,
+                this->mYBound - 1, levelVertices, levelEdges);
+            vertices = std::move(levelVertices[0]);
+            edges = std::move(levelEdges[0]);
+        }
 
-            vertices.clear();
-            edges.clear();
-            for (int y = 0, yp = 1; yp < this->mYBound; ++y, ++yp)
+        // The base-class Extract functions, including the tiled and
+        // multilevel extraction.
+        using CurveExtractor<T, Real>::Extract;
+
+    protected:
+        virtual void ExtractRows(std::vector<int64_t> const& levels, int y0, int y1,
+            std::vector<std::vector<Vertex>>& vertices,
+            std::vector<std::vector<Edge>>& edges) override
+        {
+            for (int y = y0, yp = y0 + 1; y < y1; ++y, ++yp)
             {
                 for (int x = 0, xp = 1; xp < this->mXBound; ++x, ++xp)
                 {
                     // Get the image values at the corners of the square.
-                    int i00 = x + this->mXBound * y;
-                    int i10 = i00 + 1;
-                    int i01 = i00 + this->mXBound;
-                    int i11 = i10 + this->mXBound;
-                    int64_t f00 = this->mPixels[i00];
-                    int64_t f10 = this->mPixels[i10];
-                    int64_t f01 = this->mPixels[i01];
-                    int64_t f11 = this->mPixels[i11];
+                    size_t i00 = static_cast<size_t>(x) +
+                        static_cast<size_t>(this->mXBound) * static_cast<size_t>(y);
+                    size_t i10 = i00 + 1;
+                    size_t i01 = i00 + static_cast<size_t>(this->mXBound);
+                    size_t i11 = i10 + static_cast<size_t>(this->mXBound);
+                    int64_t f00 = static_cast<int64_t>(this->mInputPixels[i00]);
+                    int64_t f10 = static_cast<int64_t>(this->mInputPixels[i10]);
+                    int64_t f01 = static_cast<int64_t>(this->mInputPixels[i01]);
+                    int64_t f11 = static_cast<int64_t>(this->mInputPixels[i11]);
+                    auto range = this->GetLevelRange(levels, f00, f10, f11, f01);
 
-                    // Construct the vertices and edges of the level curve in
+                    // Construct the vertices and edges of the level curves in
                     // the square.  The x, xp, y and yp values are implicitly
                     // converted from int to int64_t (which is guaranteed to
                     // be correct).
-                    ProcessSquare(vertices, edges, x, xp, y, yp, f00, f10, f11, f01);
+                    for (size_t k = range.first; k < range.second; ++k)
+                    {
+                        int64_t level = levels[k];
+                        ProcessSquare(vertices[k], edges[k], x, xp, y, yp,
+                            f00 - level, f10 - level, f11 - level, f01 - level);
+                    }
                 }
             }
         }
 
-    protected:
         void ProcessSquare(std::vector<Vertex>& vertices, std::vector<Edge>& edges,
             int64_t x, int64_t xp, int64_t y, int64_t yp,
             int64_t f00, int64_t f10, int64_t f11, int64_t f01)
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -44,17 +44,24 @@ namespace gte
         virtual void Extract(T level, std::vector<Vertex>& vertices,
             std::vector<Edge>& edges) override
         {
-            // Adjust the image so that the level set is F(x,y) = 0.
-            int64_t levelI64 = static_cast<int64_t>(level);
-            for (size_t i = 0; i < this->mPixels.size(); ++i)
-            {
-                int64_t inputI64 = static_cast<int64_t>(this->mInputPixels[i]);
-                this->mPixels[i] = inputI64 - levelI64;
-            }
+            std::vector<std::vector<Vertex>> levelVertices(1);
+            std::vector<std::vector<Edge>> levelEdges(1);
+            ExtractRows(std::vector<int64_t>{ static_cast<int64_t>(level) }, 0,
+                this->mYBound - 1, levelVertices, levelEdges);
+            vertices = std::move(levelVertices[0]);
+            edges = std::move(levelEdges[0]);
+        }
 
-            vertices.clear();
-            edges.clear();
-            for (int y = 0, yp = 1; yp < this->mYBound; ++y, ++yp)
+        // The base-class Extract functions, including the tiled and
+        // multilevel extraction.
+        using CurveExtractor<T, Real>::Extract;
+
+    protected:
+        virtual void ExtractRows(std::vector<int64_t> const& levels, int y0, int y1,
+            std::vector<std::vector<Vertex>>& vertices,
+            std::vector<std::vector<Edge>>& edges) override
+        {
+            for (int y = y0, yp = y0 + 1; y < y1; ++y, ++yp)
             {
                 int yParity = (y & 1);
 
@@ -63,34 +70,41 @@ namespace gte
                     int xParity = (x & 1);
 
                     // Get the image values at the corners of the square.
-                    int i00 = x + this->mXBound * y;
-                    int i10 = i00 + 1;
-                    int i01 = i00 + this->mXBound;
-                    int i11 = i10 + this->mXBound;
-                    int64_t f00 = this->mPixels[i00];
-                    int64_t f10 = this->mPixels[i10];
-                    int64_t f01 = this->mPixels[i01];
-                    int64_t f11 = this->mPixels[i11];
-
-                    // Construct the vertices and edges of the level curve in
+                    size_t i00 = static_cast<size_t>(x) +
+                        static_cast<size_t>(this->mXBound) * static_cast<size_t>(y);
+                    size_t i10 = i00 + 1;
+                    size_t i01 = i00 + static_cast<size_t>(this->mXBound);
+                    size_t i11 = i10 + static_cast<size_t>(this->mXBound);
+                    int64_t f00 = static_cast<int64_t>(this->mInputPixels[i00]);
+                    int64_t f10 = static_cast<int64_t>(this->mInputPixels[i10]);
+                    int64_t f01 = static_cast<int64_t>(this->mInputPixels[i01]);
+                    int64_t f11 = static_cast<int64_t>(this->mInputPixels[i11]);
+                    auto range = this->GetLevelRange(levels, f00, f10, f11, f01);
+
+                    // Construct the vertices and edges of the level curves in
                     // the square.  The x, xp, y and yp values are implicitly
                     // converted from int to int64_t (which is guaranteed to
                     // be correct).
-                    if (xParity == yParity)
+                    for (size_t k = range.first; k < range.second; ++k)
                     {
-                        ProcessTriangle(vertices, edges, x, y, f00, x, yp, f01, xp, y, f10);
-                        ProcessTriangle(vertices, edges, xp, yp, f11, xp, y, f10, x, yp, f01);
-                    }
-                    else
-                    {
-                        ProcessTriangle(vertices, edges, x, yp, f01, xp, yp, f11, x, y, f00);
-                        ProcessTriangle(vertices, edges, xp, y, f10, x, y, f00, xp, yp, f11);
+                        int64_t level = levels[k];
+                        int64_t g00 = f00 - level, g10 = f10 - level;
+                        int64_t g01 = f01 - level, g11 = f11 - level;
+                        if (xParity == yParity)
+                        {
+                            ProcessTriangle(vertices[k], edges[k], x, y, g00, x, yp, g01, xp, y, g10);
+                            ProcessTriangle(vertices[k], edges[k], xp, yp, g11, xp, y, g10, x, yp, g01);
+                        }
+                        else
+                        {
+                            ProcessTriangle(vertices[k], edges[k], x, yp, g01, xp, yp, g11, x, y, g00);
+                            ProcessTriangle(vertices[k], edges[k], xp, y, g10, x, y, g00, xp, yp, g11);
+                        }
                     }
                 }
             }
         }
 
-    protected:
         void ProcessTriangle(std::vector<Vertex>& vertices, std::vector<Edge>& edges,
             int64_t x0, int64_t y0, int64_t f0,
             int64_t x1, int64_t y1, int64_t f1,
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -16,6 +16,8 @@
 #include <Mathematics/Line.h>
 #include <Mathematics/PrimalQuery2.h>
 #include <Mathematics/SWInterval.h>
+#include <Mathematics/SpatialSort.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/Vector2.h>
 #include <Mathematics/VETManifoldMesh.h>
 #include <numeric>
@@ -857,10 +859,21 @@ namespace gte
             mNumTriangles(0),
             mIndices{},
             mAdjacencies{},
+            mUseSpatialOrder(false),
+            mLastTriangle(nullptr),
             mIndex{ { { 0, 1 }, { 1, 2 }, { 2, 0 } } },
             mQueryPoint(Vector2<T>::Zero()),
             mIRQueryPoint(Vector2<InputRational>::Zero()),
-            mCRPool(maxNumCRPool)
+            mCRPool(maxNumCRPool),
+            mRetainCapacity(false),
+            mProcessed{},
+            mOrder{},
+            mPolygon(),
+            mCandidates{},
+            mBoundary{},
+            mHull{},
+            mVisible{},
+            mPermute{}
         {
             static_assert(std::is_floating_point<T>::value,
                 "The input type must be float or double.");
@@ -894,6 +907,7 @@ namespace gte
             mGraph.Clear();
             mIndices.clear();
             mAdjacencies.clear();
+            mLastTriangle = nullptr;
             mQueryPoint = Vector2<T>::Zero();
             mIRQueryPoint = Vector2<InputRational>::Zero();
 
@@ -944,29 +958,67 @@ namespace gte
 
             auto inserted = mGraph.Insert(info.extreme[0], info.extreme[1], info.extreme[2]);
             LogAssert(inserted != nullptr, "The triangle should not be degenerate.");
+            mLastTriangle = inserted;
 
             // Incrementally update the triangulation. The set of processed
             // points is maintained to eliminate duplicates.
-            ProcessedVertexSet processed;
+            ProcessedVertexSet& processed = mProcessed;
+            processed.clear();
+            processed.reserve(mNumVertices);
             for (size_t i = 0; i < 3; ++i)
             {
                 int32_t j = info.extreme[i];
                 processed.insert(ProcessedVertex(mVertices[j], j));
                 mDuplicates[j] = j;
             }
-            for (size_t i = 0; i < mNumVertices; ++i)
+
+            if (mUseSpatialOrder)
             {
-                ProcessedVertex v(mVertices[i], i);
-                auto iter = processed.find(v);
-                if (iter == processed.end())
+                // Eliminate the duplicates in the input order, so that
+                // mDuplicates[] is the same as for the input order, and then
+                // insert the unique vertices in a biased randomized
+                // insertion order.
+                std::vector<size_t>& order = mOrder;
+                order.clear();
+                order.reserve(mNumVertices);
+                for (size_t i = 0; i < mNumVertices; ++i)
+                {
+                    ProcessedVertex v(mVertices[i], i);
+                    auto iter = processed.find(v);
+                    if (iter == processed.end())
+                    {
+                        order.push_back(i);
+                        processed.insert(v);
+                        mDuplicates[i] = i;
+                    }
+                    else
+                    {
+                        mDuplicates[i] = iter->location;
+                    }
+                }
+
+                SpatialSort::BRIO(mVertices, order);
+                for (auto i : order)
                 {
                     Update(i);
-                    processed.insert(v);
-                    mDuplicates[i] = i;
                 }
-                else
+            }
+            else
+            {
+                for (size_t i = 0; i < mNumVertices; ++i)
                 {
-                    mDuplicates[i] = iter->location;
+                    ProcessedVertex v(mVertices[i], i);
+                    auto iter = processed.find(v);
+                    if (iter == processed.end())
+                    {
+                        Update(i);
+                        processed.insert(v);
+                        mDuplicates[i] = i;
+                    }
+                    else
+                    {
+                        mDuplicates[i] = iter->location;
+                    }
                 }
             }
             mNumUniqueVertices = processed.size();
@@ -976,9 +1028,73 @@ namespace gte
             // and mAdjacencies.
             UpdateIndicesAdjacencies();
 
+            if (!mRetainCapacity)
+            {
+                ReleaseWorkspace();
+            }
             return true;
         }
 
+        // The vertices are inserted in the input order by default. For large
+        // inputs, enable the spatial order to insert them in a biased
+        // randomized insertion order with the rounds sorted along a Hilbert
+        // curve; see SpatialSort. Each point location starts at the most
+        // recently inserted triangle, so the spatial order makes the walks
+        // to the containing triangles short. For points in general position
+        // the triangulation is the same for both orders. For cocircular
+        // points the triangulations can differ, but both are Delaunay.
+        void UseSpatialOrder(bool useSpatialOrder)
+        {
+            mUseSpatialOrder = useSpatialOrder;
+        }
+
+        inline bool UsesSpatialOrder() const
+        {
+            return mUseSpatialOrder;
+        }
+
+        // Memory reuse when the functor is called for many data sets. By
+        // default, the hash tables and the temporary containers of a call
+        // are released when the call returns. When the capacity is retained,
+        // they are kept for the next call, and the vertex, edge and triangle
+        // objects of the graph are recycled rather than deleted; see
+        // ETManifoldMesh::RetainCapacity. The memory is then bounded by the
+        // largest data set processed. Disabling the retention releases the
+        // kept memory.
+        void RetainCapacity(bool retain)
+        {
+            mRetainCapacity = retain;
+            mGraph.RetainCapacity(retain);
+            mPolygon.RetainCapacity(retain);
+            if (!retain)
+            {
+                ReleaseWorkspace();
+            }
+        }
+
+        inline bool RetainsCapacity() const
+        {
+            return mRetainCapacity;
+        }
+
+        // Allocate storage for data sets of at most maxNumVertices vertices,
+        // including the hash-table buckets of the graph, so that the first
+        // calls of operator()(...) do not grow the containers repeatedly.
+        // This is useful only when the capacity is retained.
+        void Reserve(size_t maxNumVertices)
+        {
+            size_t const maxNumTriangles = 2 * maxNumVertices;
+            size_t const maxNumEdges = 3 * maxNumVertices;
+            mIRVertices.reserve(maxNumVertices);
+            mDuplicates.reserve(maxNumVertices);
+            mIndices.reserve(3 * maxNumTriangles);
+            mAdjacencies.reserve(3 * maxNumTriangles);
+            mGraph.Reserve(maxNumVertices, maxNumEdges, maxNumTriangles);
+            mProcessed.reserve(maxNumVertices);
+            mOrder.reserve(maxNumVertices);
+            mPermute.reserve(maxNumTriangles + 1);
+        }
+
         // Dimensional information. If GetDimension() returns 1, the points
         // lie on a line P+t*D. You can sort these if you need a polyline
         // output by projecting onto the line each vertex X = P+t*D, where
@@ -1094,7 +1210,9 @@ namespace gte
         {
             // Assign integer values to the triangles.
             auto const& tmap = mGraph.GetTriangles();
-            std::unordered_map<Triangle*, int32_t> permute;
+            auto& permute = mPermute;
+            permute.clear();
+            permute.reserve(tmap.size() + 1);
             int32_t i = -1;
             permute[nullptr] = i++;
             for (auto const& element : tmap)
@@ -1208,80 +1326,55 @@ namespace gte
 
             mQueryPoint = inP;
             mIRQueryPoint = { inP[0], inP[1] };
+            return GetContainingTriangle(mQueryPoint, mIRQueryPoint, info, mCRPool);
+        }
 
-            size_t const numTriangles = mIndices.size() / 3;
-            info.path.resize(numTriangles);
-            info.numPath = 0;
-            size_t triangle;
-            if (info.initialTriangle < numTriangles)
-            {
-                triangle = info.initialTriangle;
-            }
-            else
-            {
-                info.initialTriangle = 0;
-                triangle = 0;
-            }
-
-            // Use triangle edges as binary separating lines.
-            int32_t adjacent;
-            for (size_t i = 0; i < numTriangles; ++i)
-            {
-                size_t ibase = 3 * triangle;
-                int32_t const* v = &mIndices[ibase];
-
-                info.path[info.numPath++] = triangle;
-                info.finalTriangle = triangle;
-                info.finalV[0] = v[0];
-                info.finalV[1] = v[1];
-                info.finalV[2] = v[2];
-
-                if (ToLine(negOne, v[0], v[1]) > 0)
-                {
-                    adjacent = mAdjacencies[ibase];
-                    if (adjacent == -1)
-                    {
-                        info.finalV[0] = v[0];
-                        info.finalV[1] = v[1];
-                        info.finalV[2] = v[2];
-                        return negOne;
-                    }
-                    triangle = static_cast<size_t>(adjacent);
-                    continue;
-                }
+        // Batch point location. On return, triangles[i] is the index of the
+        // triangle containing points[i] or negOne when the point is outside
+        // the triangulation. The points are sorted along a Hilbert curve and
+        // each search starts at the final triangle of the previous search,
+        // so the searches for spatially coherent points are short. The
+        // sorted points are partitioned into numThreads contiguous subsets
+        // that are located in parallel, as tasks of the scheduler when it is
+        // not null. Set numThreads to 0 or 1 to locate the points in the
+        // calling thread.
+        void GetContainingTriangles(size_t numPoints, Vector2<T> const* points,
+            size_t* triangles, size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
+        {
+            LogAssert(mDimension == 2, "Invalid dimension for triangle search.");
+            LogAssert(numPoints == 0 || (points != nullptr && triangles != nullptr),
+                "Invalid argument.");
 
-                if (ToLine(negOne, v[1], v[2]) > 0)
-                {
-                    adjacent = mAdjacencies[ibase + 1];
-                    if (adjacent == -1)
-                    {
-                        info.finalV[0] = v[1];
-                        info.finalV[1] = v[2];
-                        info.finalV[2] = v[0];
-                        return negOne;
-                    }
-                    triangle = static_cast<size_t>(adjacent);
-                    continue;
-                }
+            std::vector<size_t> order(numPoints);
+            std::iota(order.begin(), order.end(), 0);
+            SpatialSort::SortHilbert(points, order);
 
-                if (ToLine(negOne, v[2], v[0]) > 0)
+            size_t const numChunks = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numPoints, points, triangles, &order, numChunks](size_t c)
                 {
-                    adjacent = mAdjacencies[ibase + 2];
-                    if (adjacent == -1)
+                    size_t const imin = numPoints * c / numChunks;
+                    size_t const imax = numPoints * (c + 1) / numChunks;
+                    SearchInfo info;
+                    Vector2<InputRational> irP;
+                    std::vector<ComputeRational> crPool(maxNumCRPool);
+                    for (size_t k = imin; k < imax; ++k)
                     {
-                        info.finalV[0] = v[2];
-                        info.finalV[1] = v[0];
-                        info.finalV[2] = v[1];
-                        return negOne;
+                        size_t i = order[k];
+                        irP = { points[i][0], points[i][1] };
+                        triangles[i] = GetContainingTriangle(points[i], irP, info, crPool);
+                        info.initialTriangle = info.finalTriangle;
                     }
-                    triangle = static_cast<size_t>(adjacent);
-                    continue;
-                }
-
-                return triangle;
-            }
+                });
+        }
 
-            LogError("Unexpected termination of loop while searching for a triangle.");
+        void GetContainingTriangles(std::vector<Vector2<T>> const& points,
+            std::vector<size_t>& triangles, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            triangles.resize(points.size());
+            GetContainingTriangles(points.size(), points.data(), triangles.data(), numThreads,
+                scheduler);
         }
 
     protected:
@@ -1352,18 +1445,106 @@ namespace gte
             return target;
         }
 
+        // The search for GetContainingTriangle. The query point and the
+        // storage for the rational arithmetic are passed explicitly so that
+        // searches can be executed concurrently.
+        size_t GetContainingTriangle(Vector2<T> const& inP, Vector2<InputRational> const& irP,
+            SearchInfo& info, std::vector<ComputeRational>& crPool) const
+        {
+            size_t const numTriangles = mIndices.size() / 3;
+            info.path.resize(numTriangles);
+            info.numPath = 0;
+            size_t triangle;
+            if (info.initialTriangle < numTriangles)
+            {
+                triangle = info.initialTriangle;
+            }
+            else
+            {
+                info.initialTriangle = 0;
+                triangle = 0;
+            }
+
+            // Use triangle edges as binary separating lines.
+            int32_t adjacent;
+            for (size_t i = 0; i < numTriangles; ++i)
+            {
+                size_t ibase = 3 * triangle;
+                int32_t const* v = &mIndices[ibase];
+
+                info.path[info.numPath++] = triangle;
+                info.finalTriangle = triangle;
+                info.finalV[0] = v[0];
+                info.finalV[1] = v[1];
+                info.finalV[2] = v[2];
+
+                if (ToLine(inP, irP, v[0], v[1], crPool) > 0)
+                {
+                    adjacent = mAdjacencies[ibase];
+                    if (adjacent == -1)
+                    {
+                        info.finalV[0] = v[0];
+                        info.finalV[1] = v[1];
+                        info.finalV[2] = v[2];
+                        return negOne;
+                    }
+                    triangle = static_cast<size_t>(adjacent);
+                    continue;
+                }
+
+                if (ToLine(inP, irP, v[1], v[2], crPool) > 0)
+                {
+                    adjacent = mAdjacencies[ibase + 1];
+                    if (adjacent == -1)
+                    {
+                        info.finalV[0] = v[1];
+                        info.finalV[1] = v[2];
+                        info.finalV[2] = v[0];
+                        return negOne;
+                    }
+                    triangle = static_cast<size_t>(adjacent);
+                    continue;
+                }
+
+                if (ToLine(inP, irP, v[2], v[0], crPool) > 0)
+                {
+                    adjacent = mAdjacencies[ibase + 2];
+                    if (adjacent == -1)
+                    {
+                        info.finalV[0] = v[2];
+                        info.finalV[1] = v[0];
+                        info.finalV[2] = v[1];
+                        return negOne;
+                    }
+                    triangle = static_cast<size_t>(adjacent);
+                    continue;
+                }
+
+                return triangle;
+            }
+
+            LogError("Unexpected termination of loop while searching for a triangle.");
+        }
+
         // Given a line with origin V0 and direction <V0,V1> and a query
         // point P, ToLine returns
         //   +1, P on right of line
         //   -1, P on left of line
         //    0, P on the line
         int32_t ToLine(size_t pIndex, size_t v0Index, size_t v1Index) const
+        {
+            auto const& inP = (pIndex != negOne ? mVertices[pIndex] : mQueryPoint);
+            auto const& irP = (pIndex != negOne ? mIRVertices[pIndex] : mIRQueryPoint);
+            return ToLine(inP, irP, v0Index, v1Index, mCRPool);
+        }
+
+        int32_t ToLine(Vector2<T> const& inP, Vector2<InputRational> const& irP,
+            size_t v0Index, size_t v1Index, std::vector<ComputeRational>& crPool) const
         {
             // The expression tree has 13 nodes consisting of 6 input
             // leaves and 7 compute nodes.
 
             // Use interval arithmetic to determine the sign if possible.
-            auto const& inP = (pIndex != negOne ? mVertices[pIndex] : mQueryPoint);
             Vector2<T> const& inV0 = mVertices[v0Index];
             Vector2<T> const& inV1 = mVertices[v1Index];
 
@@ -1389,23 +1570,22 @@ namespace gte
             // the determinant using rational arithmetic.
 
             // Name the nodes of the expression tree.
-            auto const& irP = (pIndex != negOne ? mIRVertices[pIndex] : mIRQueryPoint);
             Vector2<InputRational> const& irV0 = mIRVertices[v0Index];
             Vector2<InputRational> const& irV1 = mIRVertices[v1Index];
 
-            auto const& crP0 = Copy(irP[0], mCRPool[0]);
-            auto const& crP1 = Copy(irP[1], mCRPool[1]);
-            auto const& crV00 = Copy(irV0[0], mCRPool[2]);
-            auto const& crV01 = Copy(irV0[1], mCRPool[3]);
-            auto const& crV10 = Copy(irV1[0], mCRPool[4]);
-            auto const& crV11 = Copy(irV1[1], mCRPool[5]);
-            auto& crX0 = mCRPool[6];
-            auto& crY0 = mCRPool[7];
-            auto& crX1 = mCRPool[8];
-            auto& crY1 = mCRPool[9];
-            auto& crX0Y1 = mCRPool[10];
-            auto& crX1Y0 = mCRPool[11];
-            auto& crDet = mCRPool[12];
+            auto const& crP0 = Copy(irP[0], crPool[0]);
+            auto const& crP1 = Copy(irP[1], crPool[1]);
+            auto const& crV00 = Copy(irV0[0], crPool[2]);
+            auto const& crV01 = Copy(irV0[1], crPool[3]);
+            auto const& crV10 = Copy(irV1[0], crPool[4]);
+            auto const& crV11 = Copy(irV1[1], crPool[5]);
+            auto& crX0 = crPool[6];
+            auto& crY0 = crPool[7];
+            auto& crX1 = crPool[8];
+            auto& crY1 = crPool[9];
+            auto& crX0Y1 = crPool[10];
+            auto& crX1Y0 = crPool[11];
+            auto& crDet = crPool[12];
 
             // Evaluate the expression tree.
             crX0 = crP0 - crV00;
@@ -1625,7 +1805,8 @@ namespace gte
             TrianglePtrSet& candidates, DirectedEdgeKeySet& boundary)
         {
             // Locate the triangles that make up the insertion polygon.
-            ETManifoldMesh polygon;
+            ETManifoldMesh& polygon = mPolygon;
+            polygon.Clear();
             while (candidates.size() > 0)
             {
                 Triangle* tri = *candidates.begin();
@@ -1670,8 +1851,11 @@ namespace gte
 
         void Update(size_t pIndex)
         {
+            // The walk to the containing triangle starts at the most
+            // recently inserted triangle, which is near pIndex when the
+            // vertices are spatially coherent.
             auto const& tmap = mGraph.GetTriangles();
-            Triangle* tri = tmap.begin()->second.get();
+            Triangle* tri = mLastTriangle;
             if (GetContainingTriangle(pIndex, tri))
             {
                 // The point is inside the convex hull. The insertion polygon
@@ -1680,13 +1864,15 @@ namespace gte
 
                 // Use a depth-first search for those triangles whose
                 // circumcircles contain point P.
-                TrianglePtrSet candidates;
+                TrianglePtrSet& candidates = mCandidates;
+                candidates.clear();
                 candidates.insert(tri);
 
                 // Get the boundary of the insertion polygon C that contains
                 // the triangles whose circumcircles contain point P. Polygon
                 // Polygon C contains this point.
-                DirectedEdgeKeySet boundary;
+                DirectedEdgeKeySet& boundary = mBoundary;
+                boundary.clear();
                 GetAndRemoveInsertionPolygon(pIndex, candidates, boundary);
 
                 // The insertion polygon consists of the triangles formed by
@@ -1700,6 +1886,7 @@ namespace gte
                         auto inserted = mGraph.Insert(static_cast<int32_t>(pIndex),
                             key.V[0], key.V[1]);
                         LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+                        mLastTriangle = inserted;
                     }
                 }
             }
@@ -1710,7 +1897,8 @@ namespace gte
                 // current triangulation whose circumcircles contain point P.
 
                 // Locate the convex hull of the triangles.
-                DirectedEdgeKeySet hull;
+                DirectedEdgeKeySet& hull = mHull;
+                hull.clear();
                 for (auto const& element : tmap)
                 {
                     Triangle* t = element.second.get();
@@ -1726,8 +1914,10 @@ namespace gte
                 // Iterate over all the hull edges and use the ones visible to
                 // point P to locate the insertion polygon.
                 auto const& emap = mGraph.GetEdges();
-                TrianglePtrSet candidates;
-                DirectedEdgeKeySet visible;
+                TrianglePtrSet& candidates = mCandidates;
+                candidates.clear();
+                DirectedEdgeKeySet& visible = mVisible;
+                visible.clear();
                 for (auto const& key : hull)
                 {
                     size_t v0Index = static_cast<size_t>(key.V[0]);
@@ -1765,7 +1955,8 @@ namespace gte
 
                 // Get the boundary of the insertion subpolygon C that
                 // contains the triangles whose circumcircles contain point P.
-                DirectedEdgeKeySet boundary;
+                DirectedEdgeKeySet& boundary = mBoundary;
+                boundary.clear();
                 GetAndRemoveInsertionPolygon(pIndex, candidates, boundary);
 
                 // The insertion polygon P consists of the triangles formed by
@@ -1781,6 +1972,7 @@ namespace gte
                         auto inserted = mGraph.Insert(static_cast<int32_t>(pIndex),
                             key.V[0], key.V[1]);
                         LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+                        mLastTriangle = inserted;
                     }
                 }
                 for (auto const& key : visible)
@@ -1788,6 +1980,7 @@ namespace gte
                     auto inserted = mGraph.Insert(static_cast<int32_t>(pIndex),
                         key.V[1], key.V[0]);
                     LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+                    mLastTriangle = inserted;
                 }
             }
         }
@@ -1815,6 +2008,11 @@ namespace gte
         std::vector<int32_t> mIndices;
         std::vector<int32_t> mAdjacencies;
 
+        // Support for the insertion order and the point location during
+        // the incremental construction.
+        bool mUseSpatialOrder;
+        ETManifoldMesh::Triangle* mLastTriangle;
+
     private:
         // Indexing for the vertices of the triangle adjacent to a vertex.
         // The edge adjacent to vertex j is <mIndex[j][0], mIndex[j][1]> and
@@ -1835,5 +2033,28 @@ namespace gte
         // the exact signs in ToLine(...) and ToCircumcircle(...).
         static size_t constexpr maxNumCRPool = 43;
         mutable std::vector<ComputeRational> mCRPool;
+
+        // The temporary containers of operator()(...), which are members so
+        // that they are reused by the insertions of a call and, when the
+        // capacity is retained, by later calls.
+        void ReleaseWorkspace()
+        {
+            ProcessedVertexSet().swap(mProcessed);
+            std::vector<size_t>().swap(mOrder);
+            mPolygon.Clear();
+            TrianglePtrSet().swap(mCandidates);
+            DirectedEdgeKeySet().swap(mBoundary);
+            DirectedEdgeKeySet().swap(mHull);
+            DirectedEdgeKeySet().swap(mVisible);
+            std::unordered_map<Triangle*, int32_t>().swap(mPermute);
+        }
+
+        bool mRetainCapacity;
+        ProcessedVertexSet mProcessed;
+        std::vector<size_t> mOrder;
+        ETManifoldMesh mPolygon;
+        TrianglePtrSet mCandidates;
+        DirectedEdgeKeySet mBoundary, mHull, mVisible;
+        std::unordered_map<Triangle*, int32_t> mPermute;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -155,7 +155,8 @@ namespace gte
         // Construction.
         Delaunay2Mesh(Delaunay2<T> const& delaunay)
             :
-            mDelaunay(&delaunay)
+            mDelaunay(&delaunay),
+            mScheduler(nullptr)
         {
         }
 
@@ -170,7 +171,7 @@ namespace gte
             return mDelaunay->GetNumTriangles();
         }
 
-        inline std::vector<Vector2<T>> const* GetVertices() const
+        inline Vector2<T> const* GetVertices() const
         {
             return mDelaunay->GetVertices();
         }
@@ -195,6 +196,27 @@ namespace gte
             return mDelaunay->GetContainingTriangle(P, info);
         }
 
+        // Execute the batch containment queries as tasks of the scheduler,
+        // which can be shared with other computations, instead of creating
+        // threads for each call. The results do not depend on the scheduler.
+        // Set the scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // Batch containment queries; see Delaunay2<T>::GetContainingTriangles.
+        void GetContainingTriangles(size_t numPoints, Vector2<T> const* points,
+            size_t* triangles, size_t numThreads = 1) const
+        {
+            mDelaunay->GetContainingTriangles(numPoints, points, triangles, numThreads, mScheduler);
+        }
+
         inline size_t GetInvalidIndex() const
         {
             return mDelaunay->negOne;
@@ -207,7 +229,7 @@ namespace gte
                 std::array<int32_t, 3> indices = { 0, 0, 0 };
                 if (mDelaunay->GetIndices(t, indices))
                 {
-                    auto const& delaunayVertices = *mDelaunay->GetVertices();
+                    Vector2<T> const* delaunayVertices = mDelaunay->GetVertices();
                     for (size_t i = 0; i < 3; ++i)
                     {
                         vertices[i] = delaunayVertices[indices[i]];
@@ -233,7 +255,7 @@ namespace gte
             std::array<int32_t, 3> indices = { 0, 0, 0 };
             if (mDelaunay->GetIndices(t, indices))
             {
-                auto const& delaunayVertices = *mDelaunay->GetVertices();
+                Vector2<T> const* delaunayVertices = mDelaunay->GetVertices();
 
                 std::array<Vector2<Rational>, 3> rtV;
                 for (size_t i = 0; i < 3; ++i)
@@ -262,5 +284,6 @@ namespace gte
     private:
         using Rational = BSRational<UIntegerAP32>;
         Delaunay2<T> const* mDelaunay;
+        TaskScheduler* mScheduler;
     };
 }
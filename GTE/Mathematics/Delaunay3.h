@@ -3,15 +3,25 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/PrimalQuery3.h>
+#include <Mathematics/PrimalQueryEvaluator3.h>
+#include <Mathematics/Profiler.h>
+#include <Mathematics/SpatialSort.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/TSCompactMesh.h>
 #include <Mathematics/TSManifoldMesh.h>
 #include <Mathematics/Line.h>
 #include <Mathematics/Hyperplane.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
 #include <set>
 #include <vector>
 
@@ -86,10 +96,30 @@ namespace gte
             mNumVertices(0),
             mNumUniqueVertices(0),
             mNumTetrahedra(0),
-            mVertices(nullptr)
+            mVertices(nullptr),
+            mUseCompactStorage(false),
+            mCompactLast(-1)
         {
         }
 
+        // The incremental construction stores the tetrahedra in a
+        // TSManifoldMesh by default, which GetGraph() returns. Call this
+        // function with 'true' to store them instead in a TSCompactMesh,
+        // which uses much less memory and has contiguous, index-based
+        // adjacency for the point location walks. GetCompactGraph() returns
+        // the mesh, and GetGraph() returns an empty mesh. The outputs
+        // GetIndices() and GetAdjacencies() are the same for both storage
+        // types. The parallel construction always uses TSManifoldMesh.
+        inline void UseCompactStorage(bool useCompactStorage)
+        {
+            mUseCompactStorage = useCompactStorage;
+        }
+
+        inline bool UsesCompactStorage() const
+        {
+            return mUseCompactStorage;
+        }
+
         // The input is the array of vertices whose Delaunay
         // tetrahedralization is required.  The epsilon value is used to
         // determine the intrinsic dimensionality of the vertices
@@ -98,131 +128,34 @@ namespace gte
         // a line, approximately planar, or volumetric.
         bool operator()(int numVertices, Vector3<InputType> const* vertices, InputType epsilon)
         {
-            mEpsilon = std::max(epsilon, (InputType)0);
-            mDimension = 0;
-            mLine.origin = Vector3<InputType>::Zero();
-            mLine.direction = Vector3<InputType>::Zero();
-            mPlane.normal = Vector3<InputType>::Zero();
-            mPlane.constant = (InputType)0;
-            mNumVertices = numVertices;
-            mNumUniqueVertices = 0;
-            mNumTetrahedra = 0;
-            mVertices = vertices;
-            mGraph = TSManifoldMesh();
-            mIndices.clear();
-            mAdjacencies.clear();
-
-            int i, j;
-            if (mNumVertices < 4)
-            {
-                // Delaunay3 should be called with at least four points.
-                return false;
-            }
-
-            IntrinsicsVector3<InputType> info(mNumVertices, vertices, mEpsilon);
-            if (info.dimension == 0)
-            {
-                // mDimension is 0; mGraph, mIndices, and mAdjacencies are
-                // empty
-                return false;
-            }
-
-            if (info.dimension == 1)
-            {
-                // The set is (nearly) collinear.
-                mDimension = 1;
-                mLine = Line3<InputType>(info.origin, info.direction[0]);
-                return false;
-            }
-
-            if (info.dimension == 2)
-            {
-                // The set is (nearly) coplanar.
-                mDimension = 2;
-                mPlane = Plane3<InputType>(UnitCross(info.direction[0],
-                    info.direction[1]), info.origin);
-                return false;
-            }
-
-            mDimension = 3;
-
-            // Compute the vertices for the queries.
-            mComputeVertices.resize(mNumVertices);
-            mQuery.Set(mNumVertices, &mComputeVertices[0]);
-            for (i = 0; i < mNumVertices; ++i)
-            {
-                for (j = 0; j < 3; ++j)
-                {
-                    mComputeVertices[i][j] = vertices[i][j];
-                }
-            }
-
-            // Insert the (nondegenerate) tetrahedron constructed by the call
-            // to GetInformation. This is necessary for the circumsphere
-            // visibility algorithm to work correctly.
-            if (!info.extremeCCW)
-            {
-                std::swap(info.extreme[2], info.extreme[3]);
-            }
-            if (!mGraph.Insert(info.extreme[0], info.extreme[1], info.extreme[2], info.extreme[3]))
-            {
-                return false;
-            }
-
-            // Incrementally update the tetrahedralization.  The set of
-            // processed points is maintained to eliminate duplicates, either
-            // in the original input points or in the points obtained by snap
-            // rounding.
-            std::set<Vector3<InputType>> processed;
-            for (i = 0; i < 4; ++i)
-            {
-                processed.insert(vertices[info.extreme[i]]);
-            }
-            for (i = 0; i < mNumVertices; ++i)
-            {
-                if (processed.find(vertices[i]) == processed.end())
-                {
-                    if (!Update(i))
-                    {
-                        // A failure can occur if ComputeType is not an exact
-                        // arithmetic type.
-                        return false;
-                    }
-                    processed.insert(vertices[i]);
-                }
-            }
-            mNumUniqueVertices = static_cast<int>(processed.size());
-
-            // Assign integer values to the tetrahedra for use by the caller.
-            std::map<std::shared_ptr<Tetrahedron>, int> permute;
-            i = -1;
-            permute[nullptr] = i++;
-            for (auto const& element : mGraph.GetTetrahedra())
-            {
-                permute[element.second] = i++;
-            }
-
-            // Put Delaunay tetrahedra into an array (vertices and adjacency
-            // info).
-            mNumTetrahedra = static_cast<int>(mGraph.GetTetrahedra().size());
-            int numIndices = 4 * mNumTetrahedra;
-            if (mNumTetrahedra > 0)
-            {
-                mIndices.resize(numIndices);
-                mAdjacencies.resize(numIndices);
-                i = 0;
-                for (auto const& element : mGraph.GetTetrahedra())
-                {
-                    std::shared_ptr<Tetrahedron> tetra = element.second;
-                    for (j = 0; j < 4; ++j, ++i)
-                    {
-                        mIndices[i] = tetra->V[j];
-                        mAdjacencies[i] = permute[tetra->S[j].lock()];
-                    }
-                }
-            }
+            return Compute(numVertices, vertices, epsilon, nullptr);
+        }
 
-            return true;
+        // The same as the previous function but the points are inserted in
+        // parallel using the threads of the scheduler. The points are
+        // inserted in a biased randomized insertion order (BRIO): the points
+        // are shuffled into rounds of doubling size, and the points of each
+        // round are sorted along a Morton curve. The sorted points of a
+        // round are split into lanes of consecutive points, so the lanes
+        // are in disjoint regions of space. The next point of every lane is
+        // located and its insertion polyhedron (cavity) is computed in
+        // parallel without modifying the mesh. The cavities are then
+        // committed in lane order. A cavity is committed only when none of
+        // its tetrahedra or their neighbors were removed by the commits of
+        // earlier lanes, so it is exactly the cavity that an incremental
+        // insertion would compute. Otherwise the point is retried with the
+        // next batch. Points outside the current hull are inserted with the
+        // incremental algorithm. All signs are computed by the same
+        // PrimalQuery3 expressions as the incremental construction, so the
+        // result is a Delaunay tetrahedralization when ComputeType is exact.
+        // The insertion order does not depend on the number of threads, so
+        // neither does the result. When points are cospherical, the
+        // tetrahedralization can differ from that of the previous function,
+        // which inserts the points in the input order.
+        bool operator()(int numVertices, Vector3<InputType> const* vertices, InputType epsilon,
+            TaskScheduler& scheduler)
+        {
+            return Compute(numVertices, vertices, epsilon, &scheduler);
         }
 
         // Dimensional information.  If GetDimension() returns 1, the points
@@ -284,6 +217,11 @@ namespace gte
             return mGraph;
         }
 
+        inline TSCompactMesh const& GetCompactGraph() const
+        {
+            return mCompactGraph;
+        }
+
         inline std::vector<int> const& GetIndices() const
         {
             return mIndices;
@@ -552,119 +490,331 @@ namespace gte
             return -1;
         }
 
-    private:
-        // Support for incremental Delaunay tetrahedralization.
-        typedef TSManifoldMesh::Tetrahedron Tetrahedron;
-
-        bool GetContainingTetrahedron(int i, std::shared_ptr<Tetrahedron>& tetra) const
+        // Batch point location. On return, tetrahedra[i] is the index of the
+        // tetrahedron containing points[i] or -1 when the point is outside
+        // the tetrahedralization. The points are sorted along a Hilbert
+        // curve and each search starts at the final tetrahedron of the
+        // previous search, so the searches for spatially coherent points are
+        // short. The sorted points are partitioned into numThreads
+        // contiguous subsets that are located in parallel, as tasks of the
+        // scheduler when it is not null. Set numThreads to 0 or 1 to locate
+        // the points in the calling thread.
+        void GetContainingTetrahedra(int numPoints, Vector3<InputType> const* points,
+            int* tetrahedra, size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
         {
-            int numTetrahedra = static_cast<int>(mGraph.GetTetrahedra().size());
-            for (int t = 0; t < numTetrahedra; ++t)
-            {
-                int j;
-                for (j = 0; j < 4; ++j)
-                {
-                    auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
-                    int v0 = tetra->V[opposite[j][0]];
-                    int v1 = tetra->V[opposite[j][1]];
-                    int v2 = tetra->V[opposite[j][2]];
-                    if (mQuery.ToPlane(i, v0, v1, v2) > 0)
-                    {
-                        // Point i sees face <v0,v1,v2> from outside the
-                        // tetrahedron.
-                        auto adjTetra = tetra->S[j].lock();
-                        if (adjTetra)
-                        {
-                            // Traverse to the tetrahedron sharing the face.
-                            tetra = adjTetra;
-                            break;
-                        }
-                        else
-                        {
-                            // We reached a hull face, so the point is outside
-                            // the hull.  TODO:  Once a hull data structure is
-                            // in place, return tetra->S[j] as the candidate
-                            // for starting a search for visible hull faces.
-                            return false;
-                        }
-                    }
+            LogAssert(mDimension == 3, "The dimension must be 3.");
+            LogAssert(numPoints >= 0 && (numPoints == 0 || (points != nullptr && tetrahedra != nullptr)),
+                "Invalid argument.");
 
-                }
+            size_t const numElements = static_cast<size_t>(numPoints);
+            std::vector<size_t> order(numElements);
+            std::iota(order.begin(), order.end(), 0);
+            SpatialSort::SortHilbert(points, order);
 
-                if (j == 4)
+            size_t const numChunks = std::max(std::min(numThreads, numElements), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numElements, points, tetrahedra, &order, numChunks](size_t c)
                 {
-                    // The point is inside all four faces, so the point is inside
-                    // a tetrahedron.
-                    return true;
-                }
-            }
+                    size_t const imin = numElements * c / numChunks;
+                    size_t const imax = numElements * (c + 1) / numChunks;
+                    SearchInfo info;
+                    info.initialTetrahedron = 0;
+                    for (size_t k = imin; k < imax; ++k)
+                    {
+                        size_t i = order[k];
+                        tetrahedra[i] = GetContainingTetrahedron(points[i], info);
+                        info.initialTetrahedron = info.finalTetrahedron;
+                    }
+                });
+        }
 
-            LogError("Unexpected termination of loop.");
+        void GetContainingTetrahedra(std::vector<Vector3<InputType>> const& points,
+            std::vector<int>& tetrahedra, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            tetrahedra.resize(points.size());
+            GetContainingTetrahedra(static_cast<int>(points.size()), points.data(),
+                tetrahedra.data(), numThreads, scheduler);
         }
 
-        bool GetAndRemoveInsertionPolyhedron(int i, std::set<std::shared_ptr<Tetrahedron>>& candidates,
-            std::set<TriangleKey<true>>& boundary)
+    private:
+        // Support for incremental Delaunay tetrahedralization.
+        typedef TSManifoldMesh::Tetrahedron Tetrahedron;
+
+        bool Compute(int numVertices, Vector3<InputType> const* vertices, InputType epsilon,
+            TaskScheduler* scheduler)
         {
-            // Locate the tetrahedra that make up the insertion polyhedron.
-            TSManifoldMesh polyhedron;
-            while (candidates.size() > 0)
-            {
-                std::shared_ptr<Tetrahedron> tetra = *candidates.begin();
-                candidates.erase(candidates.begin());
+            GTE_PROFILE_ZONE("Delaunay3");
 
-                for (int j = 0; j < 4; ++j)
-                {
-                    auto adj = tetra->S[j].lock();
-                    if (adj && candidates.find(adj) == candidates.end())
-                    {
-                        int a0 = adj->V[0];
-                        int a1 = adj->V[1];
-                        int a2 = adj->V[2];
-                        int a3 = adj->V[3];
-                        if (mQuery.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
-                        {
-                            // Point i is in the circumsphere.
-                            candidates.insert(adj);
-                        }
-                    }
-                }
+            mEpsilon = std::max(epsilon, (InputType)0);
+            mDimension = 0;
+            mLine.origin = Vector3<InputType>::Zero();
+            mLine.direction = Vector3<InputType>::Zero();
+            mPlane.normal = Vector3<InputType>::Zero();
+            mPlane.constant = (InputType)0;
+            mNumVertices = numVertices;
+            mNumUniqueVertices = 0;
+            mNumTetrahedra = 0;
+            mVertices = vertices;
+            mGraph = TSManifoldMesh();
+            mCompactGraph.Clear();
+            mCompactLast = -1;
+            mIndices.clear();
+            mAdjacencies.clear();
 
-                int v0 = tetra->V[0];
-                int v1 = tetra->V[1];
-                int v2 = tetra->V[2];
-                int v3 = tetra->V[3];
-                if (!polyhedron.Insert(v0, v1, v2, v3))
-                {
-                    return false;
-                }
-                if (!mGraph.Remove(v0, v1, v2, v3))
-                {
-                    return false;
-                }
+            int i, j;
+            if (mNumVertices < 4)
+            {
+                // Delaunay3 should be called with at least four points.
+                return false;
             }
 
-            // Get the boundary triangles of the insertion polyhedron.
-            for (auto const& element : polyhedron.GetTetrahedra())
+            IntrinsicsVector3<InputType> info(mNumVertices, vertices, mEpsilon);
+            if (info.dimension == 0)
             {
-                std::shared_ptr<Tetrahedron> tetra = element.second;
-                for (int j = 0; j < 4; ++j)
-                {
-                    if (!tetra->S[j].lock())
-                    {
-                        auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
-                        int v0 = tetra->V[opposite[j][0]];
-                        int v1 = tetra->V[opposite[j][1]];
-                        int v2 = tetra->V[opposite[j][2]];
-                        boundary.insert(TriangleKey<true>(v0, v1, v2));
-                    }
-                }
+                // mDimension is 0; mGraph, mIndices, and mAdjacencies are
+                // empty
+                return false;
             }
-            return true;
-        }
 
-        bool Update(int i)
-        {
-            auto const& smap = mGraph.GetTetrahedra();
+            if (info.dimension == 1)
+            {
+                // The set is (nearly) collinear.
+                mDimension = 1;
+                mLine = Line3<InputType>(info.origin, info.direction[0]);
+                return false;
+            }
+
+            if (info.dimension == 2)
+            {
+                // The set is (nearly) coplanar.
+                mDimension = 2;
+                mPlane = Plane3<InputType>(UnitCross(info.direction[0],
+                    info.direction[1]), info.origin);
+                return false;
+            }
+
+            mDimension = 3;
+
+            // Compute the vertices for the queries.
+            mComputeVertices.resize(mNumVertices);
+            mQuery.Set(mNumVertices, &mComputeVertices[0]);
+            mEvaluator.Set(mNumVertices, &mComputeVertices[0]);
+            for (i = 0; i < mNumVertices; ++i)
+            {
+                for (j = 0; j < 3; ++j)
+                {
+                    mComputeVertices[i][j] = vertices[i][j];
+                }
+            }
+
+            // Insert the (nondegenerate) tetrahedron constructed by the call
+            // to GetInformation. This is necessary for the circumsphere
+            // visibility algorithm to work correctly.
+            if (!info.extremeCCW)
+            {
+                std::swap(info.extreme[2], info.extreme[3]);
+            }
+            bool const compact = (mUseCompactStorage && !scheduler);
+            if (compact)
+            {
+                mCompactLast = mCompactGraph.Insert(info.extreme[0], info.extreme[1],
+                    info.extreme[2], info.extreme[3]);
+            }
+            else if (!mGraph.Insert(info.extreme[0], info.extreme[1], info.extreme[2], info.extreme[3]))
+            {
+                return false;
+            }
+
+            // Incrementally update the tetrahedralization.  The set of
+            // processed points is maintained to eliminate duplicates, either
+            // in the original input points or in the points obtained by snap
+            // rounding.
+            std::set<Vector3<InputType>> processed;
+            for (i = 0; i < 4; ++i)
+            {
+                processed.insert(vertices[info.extreme[i]]);
+            }
+            if (scheduler)
+            {
+                GTE_PROFILE_ZONE("Delaunay3::UpdateParallel");
+                if (!UpdateParallel(*scheduler, processed))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                GTE_PROFILE_ZONE("Delaunay3::Update");
+                for (i = 0; i < mNumVertices; ++i)
+                {
+                    if (processed.find(vertices[i]) == processed.end())
+                    {
+                        if (!(compact ? UpdateCompact(i) : Update(i)))
+                        {
+                            // A failure can occur if ComputeType is not an
+                            // exact arithmetic type.
+                            return false;
+                        }
+                        processed.insert(vertices[i]);
+                    }
+                }
+            }
+            mNumUniqueVertices = static_cast<int>(processed.size());
+
+            if (compact)
+            {
+                GetCompactOutput();
+                return true;
+            }
+
+            // Assign integer values to the tetrahedra for use by the caller.
+            std::map<std::shared_ptr<Tetrahedron>, int> permute;
+            i = -1;
+            permute[nullptr] = i++;
+            for (auto const& element : mGraph.GetTetrahedra())
+            {
+                permute[element.second] = i++;
+            }
+
+            // Put Delaunay tetrahedra into an array (vertices and adjacency
+            // info).
+            mNumTetrahedra = static_cast<int>(mGraph.GetTetrahedra().size());
+            int numIndices = 4 * mNumTetrahedra;
+            if (mNumTetrahedra > 0)
+            {
+                mIndices.resize(numIndices);
+                mAdjacencies.resize(numIndices);
+                i = 0;
+                for (auto const& element : mGraph.GetTetrahedra())
+                {
+                    std::shared_ptr<Tetrahedron> tetra = element.second;
+                    for (j = 0; j < 4; ++j, ++i)
+                    {
+                        mIndices[i] = tetra->V[j];
+                        mAdjacencies[i] = permute[tetra->S[j].lock()];
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        bool GetContainingTetrahedron(int i, std::shared_ptr<Tetrahedron>& tetra) const
+        {
+            int numTetrahedra = static_cast<int>(mGraph.GetTetrahedra().size());
+            for (int t = 0; t < numTetrahedra; ++t)
+            {
+                int j;
+                for (j = 0; j < 4; ++j)
+                {
+                    auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+                    int v0 = tetra->V[opposite[j][0]];
+                    int v1 = tetra->V[opposite[j][1]];
+                    int v2 = tetra->V[opposite[j][2]];
+                    if (mEvaluator.ToPlane(i, v0, v1, v2) > 0)
+                    {
+                        // Point i sees face <v0,v1,v2> from outside the
+                        // tetrahedron.
+                        auto adjTetra = tetra->S[j].lock();
+                        if (adjTetra)
+                        {
+                            // Traverse to the tetrahedron sharing the face.
+                            tetra = adjTetra;
+                            break;
+                        }
+                        else
+                        {
+                            // We reached a hull face, so the point is outside
+                            // the hull.  TODO:  Once a hull data structure is
+                            // in place, return tetra->S[j] as the candidate
+                            // for starting a search for visible hull faces.
+                            return false;
+                        }
+                    }
+
+                }
+
+                if (j == 4)
+                {
+                    // The point is inside all four faces, so the point is inside
+                    // a tetrahedron.
+                    return true;
+                }
+            }
+
+            LogError("Unexpected termination of loop.");
+        }
+
+        // When 'removed' is not null, the removed tetrahedra are inserted
+        // into it.
+        bool GetAndRemoveInsertionPolyhedron(int i, std::set<std::shared_ptr<Tetrahedron>>& candidates,
+            std::set<TriangleKey<true>>& boundary, std::set<Tetrahedron const*>* removed)
+        {
+            // Locate the tetrahedra that make up the insertion polyhedron.
+            TSManifoldMesh polyhedron;
+            while (candidates.size() > 0)
+            {
+                std::shared_ptr<Tetrahedron> tetra = *candidates.begin();
+                candidates.erase(candidates.begin());
+
+                for (int j = 0; j < 4; ++j)
+                {
+                    auto adj = tetra->S[j].lock();
+                    if (adj && candidates.find(adj) == candidates.end())
+                    {
+                        int a0 = adj->V[0];
+                        int a1 = adj->V[1];
+                        int a2 = adj->V[2];
+                        int a3 = adj->V[3];
+                        if (mEvaluator.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
+                        {
+                            // Point i is in the circumsphere.
+                            candidates.insert(adj);
+                        }
+                    }
+                }
+
+                int v0 = tetra->V[0];
+                int v1 = tetra->V[1];
+                int v2 = tetra->V[2];
+                int v3 = tetra->V[3];
+                if (!polyhedron.Insert(v0, v1, v2, v3))
+                {
+                    return false;
+                }
+                if (!mGraph.Remove(v0, v1, v2, v3))
+                {
+                    return false;
+                }
+                if (removed)
+                {
+                    removed->insert(tetra.get());
+                }
+            }
+
+            // Get the boundary triangles of the insertion polyhedron.
+            for (auto const& element : polyhedron.GetTetrahedra())
+            {
+                std::shared_ptr<Tetrahedron> tetra = element.second;
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (!tetra->S[j].lock())
+                    {
+                        auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+                        int v0 = tetra->V[opposite[j][0]];
+                        int v1 = tetra->V[opposite[j][1]];
+                        int v2 = tetra->V[opposite[j][2]];
+                        boundary.insert(TriangleKey<true>(v0, v1, v2));
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool Update(int i, std::set<Tetrahedron const*>* removed = nullptr)
+        {
+            auto const& smap = mGraph.GetTetrahedra();
             std::shared_ptr<Tetrahedron> tetra = smap.begin()->second;
             if (GetContainingTetrahedron(i, tetra))
             {
@@ -681,7 +831,7 @@ namespace gte
                 // contains the tetrahedra whose circumspheres contain point
                 // i.  Polyhedron C contains the point i.
                 std::set<TriangleKey<true>> boundary;
-                if (!GetAndRemoveInsertionPolyhedron(i, candidates, boundary))
+                if (!GetAndRemoveInsertionPolyhedron(i, candidates, boundary, removed))
                 {
                     return false;
                 }
@@ -693,7 +843,7 @@ namespace gte
                     int v0 = key.V[0];
                     int v1 = key.V[1];
                     int v2 = key.V[2];
-                    if (mQuery.ToPlane(i, v0, v1, v2) < 0)
+                    if (mEvaluator.ToPlane(i, v0, v1, v2) < 0)
                     {
                         if (!mGraph.Insert(i, v0, v1, v2))
                         {
@@ -741,7 +891,7 @@ namespace gte
                     int v0 = key.V[0];
                     int v1 = key.V[1];
                     int v2 = key.V[2];
-                    if (mQuery.ToPlane(i, v0, v1, v2) > 0)
+                    if (mEvaluator.ToPlane(i, v0, v1, v2) > 0)
                     {
                         auto iter = tmap.find(TriangleKey<false>(v0, v1, v2));
                         if (iter != tmap.end() && iter->second->T[1].lock() == nullptr)
@@ -753,7 +903,7 @@ namespace gte
                                 int a1 = adj->V[1];
                                 int a2 = adj->V[2];
                                 int a3 = adj->V[3];
-                                if (mQuery.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
+                                if (mEvaluator.ToCircumsphere(i, a0, a1, a2, a3) <= 0)
                                 {
                                     // Point i is in the circumsphere.
                                     candidates.insert(adj);
@@ -783,7 +933,7 @@ namespace gte
                 // contains the tetrahedra whose circumspheres contain
                 // point i.
                 std::set<TriangleKey<true>> boundary;
-                if (!GetAndRemoveInsertionPolyhedron(i, candidates, boundary))
+                if (!GetAndRemoveInsertionPolyhedron(i, candidates, boundary, removed))
                 {
                     return false;
                 }
@@ -796,7 +946,7 @@ namespace gte
                     int v0 = key.V[0];
                     int v1 = key.V[1];
                     int v2 = key.V[2];
-                    if (mQuery.ToPlane(i, v0, v1, v2) < 0)
+                    if (mEvaluator.ToPlane(i, v0, v1, v2) < 0)
                     {
                         // This is a back face of the boundary.
                         if (!mGraph.Insert(i, v0, v1, v2))
@@ -817,33 +967,681 @@ namespace gte
             return true;
         }
 
-        // The epsilon value is used for fuzzy determination of intrinsic
-        // dimensionality.  If the dimension is 0, 1, or 2, the constructor
-        // returns early.  The caller is responsible for retrieving the
-        // dimension and taking an alternate path should the dimension be
-        // smaller than 3.  If the dimension is 0, the caller may as well
-        // treat all vertices[] as a single point, say, vertices[0].  If the
-        // dimension is 1, the caller can query for the approximating line
-        // and project vertices[] onto it for further processing.  If the
-        // dimension is 2, the caller can query for the approximating plane
-        // and project vertices[] onto it for further processing.
-        InputType mEpsilon;
-        int mDimension;
-        Line3<InputType> mLine;
-        Plane3<InputType> mPlane;
+        // Support for the incremental construction with TSCompactMesh. The
+        // algorithm is that of Update, GetContainingTetrahedron and
+        // GetAndRemoveInsertionPolyhedron. The walk starts at the last
+        // inserted tetrahedron, and the hull faces of a point outside the
+        // hull are the open faces of the mesh.
+        bool UpdateCompact(int i)
+        {
+            int tetra = mCompactLast;
+            if (!mCompactGraph.IsValid(tetra))
+            {
+                for (tetra = 0; !mCompactGraph.IsValid(tetra); ++tetra)
+                {
+                }
+            }
 
-        // The array of vertices used for geometric queries.  If you want to
-        // be certain of a correct result, choose ComputeType to be BSNumber.
-        std::vector<Vector3<ComputeType>> mComputeVertices;
-        PrimalQuery3<ComputeType> mQuery;
+            std::set<int> candidates;
+            std::set<TriangleKey<true>> visible;
+            if (GetContainingTetrahedronCompact(i, tetra))
+            {
+                candidates.insert(tetra);
+            }
+            else
+            {
+                // Use the hull faces visible to point i to locate the
+                // insertion polyhedron.
+                std::set<TriangleKey<true>> hull;
+                std::map<TriangleKey<true>, int> hullTetra;
+                auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+                for (auto const& element : mCompactGraph.GetOpenFaces())
+                {
+                    int t = element.second / 4;
+                    int j = element.second % 4;
+                    auto const& V = mCompactGraph.GetVertices(t);
+                    TriangleKey<true> key(V[opposite[j][0]], V[opposite[j][1]], V[opposite[j][2]]);
+                    hull.insert(key);
+                    hullTetra[key] = t;
+                }
 
-        // The graph information.
-        int mNumVertices;
-        int mNumUniqueVertices;
-        int mNumTetrahedra;
-        Vector3<InputType> const* mVertices;
-        TSManifoldMesh mGraph;
-        std::vector<int> mIndices;
-        std::vector<int> mAdjacencies;
+                for (auto const& key : hull)
+                {
+                    if (mEvaluator.ToPlane(i, key.V[0], key.V[1], key.V[2]) > 0)
+                    {
+                        int adj = hullTetra[key];
+                        if (candidates.find(adj) == candidates.end())
+                        {
+                            auto const& A = mCompactGraph.GetVertices(adj);
+                            if (mEvaluator.ToCircumsphere(i, A[0], A[1], A[2], A[3]) <= 0)
+                            {
+                                // Point i is in the circumsphere.
+                                candidates.insert(adj);
+                            }
+                            else
+                            {
+                                // Point i is not in the circumsphere but
+                                // the hull face is visible.
+                                visible.insert(key);
+                            }
+                        }
+                    }
+                }
+            }
+
+            std::set<TriangleKey<true>> boundary;
+            if (!GetAndRemoveInsertionPolyhedronCompact(i, candidates, boundary))
+            {
+                return false;
+            }
+
+            // The insertion polyhedron consists of the tetrahedra formed by
+            // point i and the back faces of C and the visible faces of the
+            // hull that are not faces of C.
+            for (auto const& key : boundary)
+            {
+                int v0 = key.V[0];
+                int v1 = key.V[1];
+                int v2 = key.V[2];
+                if (mEvaluator.ToPlane(i, v0, v1, v2) < 0)
+                {
+                    mCompactLast = mCompactGraph.Insert(i, v0, v1, v2);
+                    if (mCompactLast < 0)
+                    {
+                        return false;
+                    }
+                }
+                // else:  Point i is on an edge or face of 'tetra', so the
+                // subdivision has degenerate tetrahedra.  Ignore these.
+            }
+            for (auto const& key : visible)
+            {
+                mCompactLast = mCompactGraph.Insert(i, key.V[0], key.V[2], key.V[1]);
+                if (mCompactLast < 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool GetContainingTetrahedronCompact(int i, int& tetra) const
+        {
+            auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+            int numTetrahedra = mCompactGraph.GetNumTetrahedra();
+            for (int t = 0; t < numTetrahedra; ++t)
+            {
+                auto const& V = mCompactGraph.GetVertices(tetra);
+                int j;
+                for (j = 0; j < 4; ++j)
+                {
+                    int v0 = V[opposite[j][0]];
+                    int v1 = V[opposite[j][1]];
+                    int v2 = V[opposite[j][2]];
+                    if (mEvaluator.ToPlane(i, v0, v1, v2) > 0)
+                    {
+                        // Point i sees face <v0,v1,v2> from outside the
+                        // tetrahedron.
+                        int adjTetra = mCompactGraph.GetAdjacents(tetra)[j];
+                        if (adjTetra >= 0)
+                        {
+                            // Traverse to the tetrahedron sharing the face.
+                            tetra = adjTetra;
+                            break;
+                        }
+                        else
+                        {
+                            // We reached a hull face, so the point is outside
+                            // the hull.
+                            return false;
+                        }
+                    }
+                }
+
+                if (j == 4)
+                {
+                    // The point is inside all four faces, so the point is
+                    // inside a tetrahedron.
+                    return true;
+                }
+            }
+
+            LogError("Unexpected termination of loop.");
+        }
+
+        bool GetAndRemoveInsertionPolyhedronCompact(int i, std::set<int>& candidates,
+            std::set<TriangleKey<true>>& boundary)
+        {
+            // Locate the tetrahedra that make up the insertion polyhedron.
+            std::vector<int> polyhedron;
+            std::set<int> inPolyhedron;
+            while (candidates.size() > 0)
+            {
+                int tetra = *candidates.begin();
+                candidates.erase(candidates.begin());
+                polyhedron.push_back(tetra);
+                inPolyhedron.insert(tetra);
+
+                for (int j = 0; j < 4; ++j)
+                {
+                    int adj = mCompactGraph.GetAdjacents(tetra)[j];
+                    if (adj >= 0 && candidates.find(adj) == candidates.end()
+                        && inPolyhedron.find(adj) == inPolyhedron.end())
+                    {
+                        auto const& A = mCompactGraph.GetVertices(adj);
+                        if (mEvaluator.ToCircumsphere(i, A[0], A[1], A[2], A[3]) <= 0)
+                        {
+                            // Point i is in the circumsphere.
+                            candidates.insert(adj);
+                        }
+                    }
+                }
+            }
+
+            // Get the boundary triangles of the insertion polyhedron, which
+            // are the faces not shared with other tetrahedra of the
+            // polyhedron.
+            auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+            for (auto tetra : polyhedron)
+            {
+                auto const& V = mCompactGraph.GetVertices(tetra);
+                auto const& S = mCompactGraph.GetAdjacents(tetra);
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (inPolyhedron.find(S[j]) == inPolyhedron.end())
+                    {
+                        int v0 = V[opposite[j][0]];
+                        int v1 = V[opposite[j][1]];
+                        int v2 = V[opposite[j][2]];
+                        boundary.insert(TriangleKey<true>(v0, v1, v2));
+                    }
+                }
+            }
+
+            for (auto tetra : polyhedron)
+            {
+                if (!mCompactGraph.Remove(tetra))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Put the tetrahedra of the compact mesh into mIndices and
+        // mAdjacencies, ordered by TetrahedronKey as those of mGraph are.
+        void GetCompactOutput()
+        {
+            std::map<TetrahedronKey<true>, int> sorted;
+            for (int t = 0; t < mCompactGraph.GetNumSlots(); ++t)
+            {
+                if (mCompactGraph.IsValid(t))
+                {
+                    auto const& V = mCompactGraph.GetVertices(t);
+                    sorted.insert(std::make_pair(TetrahedronKey<true>(V[0], V[1], V[2], V[3]), t));
+                }
+            }
+
+            std::vector<int> permute(mCompactGraph.GetNumSlots(), -1);
+            int i = 0;
+            for (auto const& element : sorted)
+            {
+                permute[element.second] = i++;
+            }
+
+            mNumTetrahedra = mCompactGraph.GetNumTetrahedra();
+            mIndices.resize(4 * static_cast<size_t>(mNumTetrahedra));
+            mAdjacencies.resize(4 * static_cast<size_t>(mNumTetrahedra));
+            i = 0;
+            for (auto const& element : sorted)
+            {
+                auto const& V = mCompactGraph.GetVertices(element.second);
+                auto const& S = mCompactGraph.GetAdjacents(element.second);
+                for (int j = 0; j < 4; ++j, ++i)
+                {
+                    mIndices[i] = V[j];
+                    mAdjacencies[i] = (S[j] >= 0 ? permute[S[j]] : -1);
+                }
+            }
+        }
+
+        // Support for the parallel insertion.
+        enum
+        {
+            // The minimum number of points of a BRIO round. The first round
+            // has all remaining points when there are fewer.
+            MinRoundSize = 64,
+
+            // The number of points per lane of a round, so the number of
+            // points per batch is about 1/LaneLength of the round.
+            LaneLength = 32
+        };
+
+        // The state of the insertion of the next point of a lane.
+        struct Insertion
+        {
+            enum Status
+            {
+                INSIDE,     // The point is inside the hull.
+                OUTSIDE,    // The point is outside the hull.
+                DUPLICATE,  // The point was already inserted.
+                FAILED      // The walk did not terminate.
+            };
+
+            Insertion()
+                :
+                vertex(-1),
+                status(FAILED),
+                touchesHull(false)
+            {
+            }
+
+            int vertex;
+            Status status;
+
+            // The tetrahedra whose circumspheres contain the point.
+            std::vector<std::shared_ptr<Tetrahedron>> cavity;
+
+            // The cavity tetrahedra and their adjacent tetrahedra, which
+            // are all the tetrahedra whose data were used to compute the
+            // cavity. The value is 'true' for the cavity tetrahedra.
+            std::map<Tetrahedron const*, bool> region;
+
+            // The boundary faces of the cavity that form tetrahedra with
+            // the point.
+            std::vector<std::array<int, 3>> faces;
+
+            // The cavity has a face on the hull.
+            bool touchesHull;
+        };
+
+        bool UpdateParallel(TaskScheduler& scheduler, std::set<Vector3<InputType>>& processed)
+        {
+            std::vector<int> order;
+            std::vector<size_t> rounds;
+            ComputeInsertionOrder(processed, order, rounds);
+
+            size_t const numThreads = scheduler.GetNumThreads();
+            mEvaluators.resize(numThreads);
+            for (auto& evaluator : mEvaluators)
+            {
+                evaluator.Set(mNumVertices, &mComputeVertices[0]);
+            }
+
+            std::vector<Insertion> insertions;
+            std::vector<size_t> laneBegin, laneEnd, batch;
+            std::vector<std::shared_ptr<Tetrahedron>> laneHint;
+            std::set<Tetrahedron const*> removed;
+            for (size_t r = 0; r + 1 < rounds.size(); ++r)
+            {
+                // Split the round into lanes of consecutive points.
+                size_t const roundSize = rounds[r + 1] - rounds[r];
+                size_t const numLanes = std::max(roundSize / LaneLength, static_cast<size_t>(1));
+                laneBegin.resize(numLanes);
+                laneEnd.resize(numLanes);
+                laneHint.assign(numLanes, nullptr);
+                insertions.resize(numLanes);
+                for (size_t m = 0; m < numLanes; ++m)
+                {
+                    laneBegin[m] = rounds[r] + roundSize * m / numLanes;
+                    laneEnd[m] = rounds[r] + roundSize * (m + 1) / numLanes;
+                }
+
+                for (;;)
+                {
+                    batch.clear();
+                    for (size_t m = 0; m < numLanes; ++m)
+                    {
+                        if (laneBegin[m] < laneEnd[m])
+                        {
+                            batch.push_back(m);
+                        }
+                    }
+                    if (batch.empty())
+                    {
+                        break;
+                    }
+
+                    // Locate the points and compute their cavities. The mesh
+                    // is not modified, so the tasks only read shared data.
+                    size_t const numTasks = std::min(numThreads, batch.size());
+                    auto prepare = [this, &processed, &order, &batch, &laneBegin, &laneHint,
+                        &insertions, numTasks](size_t t)
+                    {
+                        for (size_t k = t; k < batch.size(); k += numTasks)
+                        {
+                            size_t const m = batch[k];
+                            PrepareInsertion(mEvaluators[t], processed, order[laneBegin[m]],
+                                laneHint[m], insertions[m]);
+                        }
+                    };
+
+                    TaskScheduler::TaskGroup group;
+                    for (size_t t = 1; t < numTasks; ++t)
+                    {
+                        scheduler.Spawn(group, [&prepare, t]() { prepare(t); });
+                    }
+                    prepare(0);
+                    scheduler.Wait(group);
+
+                    // Commit the cavities in lane order.
+                    removed.clear();
+                    bool hullChanged = false;
+                    for (auto m : batch)
+                    {
+                        Insertion& insertion = insertions[m];
+                        int const i = insertion.vertex;
+                        if (insertion.status == Insertion::DUPLICATE)
+                        {
+                            ++laneBegin[m];
+                            continue;
+                        }
+
+                        if (insertion.status == Insertion::FAILED)
+                        {
+                            return false;
+                        }
+
+                        // An OUTSIDE insertion adds tetrahedra on the hull
+                        // faces, which can change the cavities with faces on
+                        // the hull.
+                        if ((hullChanged && insertion.touchesHull) || Conflicts(insertion, removed)
+                            || processed.find(mVertices[i]) != processed.end())
+                        {
+                            continue;
+                        }
+
+                        if (insertion.status == Insertion::OUTSIDE)
+                        {
+                            if (!Update(i, &removed))
+                            {
+                                return false;
+                            }
+                            hullChanged = true;
+                        }
+                        else
+                        {
+                            for (auto const& tetra : insertion.cavity)
+                            {
+                                if (!mGraph.Remove(tetra->V[0], tetra->V[1], tetra->V[2], tetra->V[3]))
+                                {
+                                    return false;
+                                }
+                                removed.insert(tetra.get());
+                            }
+
+                            for (auto const& face : insertion.faces)
+                            {
+                                auto tetra = mGraph.Insert(i, face[0], face[1], face[2]);
+                                if (!tetra)
+                                {
+                                    return false;
+                                }
+                                laneHint[m] = tetra;
+                            }
+                        }
+
+                        processed.insert(mVertices[i]);
+                        ++laneBegin[m];
+                    }
+
+                    for (auto m : batch)
+                    {
+                        insertions[m].cavity.clear();
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Shuffle the points that are not yet processed and partition them
+        // into rounds of doubling size, the last round having about half of
+        // the points. The points of each round are sorted along a Morton
+        // curve. Round r contains order[rounds[r]] through
+        // order[rounds[r+1]-1].
+        void ComputeInsertionOrder(std::set<Vector3<InputType>> const& processed,
+            std::vector<int>& order, std::vector<size_t>& rounds) const
+        {
+            order.clear();
+            order.reserve(mNumVertices);
+            for (int i = 0; i < mNumVertices; ++i)
+            {
+                if (processed.find(mVertices[i]) == processed.end())
+                {
+                    order.push_back(i);
+                }
+            }
+
+            // The seed is fixed so that the insertion order is
+            // reproducible.
+            std::mt19937 mte(static_cast<std::mt19937::result_type>(order.size()));
+            std::shuffle(order.begin(), order.end(), mte);
+
+            rounds.clear();
+            rounds.push_back(order.size());
+            for (size_t begin = order.size() / 2; begin >= MinRoundSize; begin /= 2)
+            {
+                rounds.push_back(begin);
+            }
+            rounds.push_back(0);
+            std::reverse(rounds.begin(), rounds.end());
+
+            // Compute the Morton codes of the points on a grid of 2^16 cells
+            // per dimension that covers the bounding box.
+            std::array<double, 3> vmin, vmax;
+            vmin.fill(std::numeric_limits<double>::max());
+            vmax.fill(-std::numeric_limits<double>::max());
+            for (int i = 0; i < mNumVertices; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    double value = static_cast<double>(mVertices[i][j]);
+                    vmin[j] = std::min(vmin[j], value);
+                    vmax[j] = std::max(vmax[j], value);
+                }
+            }
+
+            std::vector<uint64_t> code(mNumVertices, 0);
+            for (auto i : order)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    double range = vmax[j] - vmin[j];
+                    double t = (range > 0.0 ? (static_cast<double>(mVertices[i][j]) - vmin[j]) / range : 0.0);
+                    uint64_t cell = static_cast<uint64_t>(t * 65535.0);
+                    for (int b = 0; b < 16; ++b)
+                    {
+                        code[i] |= ((cell >> b) & 1) << (3 * b + j);
+                    }
+                }
+            }
+
+            for (size_t r = 0; r + 1 < rounds.size(); ++r)
+            {
+                std::sort(order.begin() + rounds[r], order.begin() + rounds[r + 1],
+                    [&code](int i0, int i1)
+                    {
+                        return code[i0] < code[i1];
+                    });
+            }
+        }
+
+        // Locate point i and compute its cavity. The walk starts at the
+        // tetrahedron hint when it is still in the mesh. The function reads
+        // the mesh but does not modify it.
+        void PrepareInsertion(PrimalQueryEvaluator3<ComputeType>& evaluator,
+            std::set<Vector3<InputType>> const& processed, int i,
+            std::shared_ptr<Tetrahedron> const& hint, Insertion& insertion) const
+        {
+            insertion.vertex = i;
+            insertion.cavity.clear();
+            insertion.region.clear();
+            insertion.faces.clear();
+            insertion.touchesHull = false;
+            if (processed.find(mVertices[i]) != processed.end())
+            {
+                insertion.status = Insertion::DUPLICATE;
+                return;
+            }
+
+            auto const& smap = mGraph.GetTetrahedra();
+            std::shared_ptr<Tetrahedron> tetra = smap.begin()->second;
+            if (hint)
+            {
+                auto iter = smap.find(TetrahedronKey<true>(hint->V[0], hint->V[1], hint->V[2], hint->V[3]));
+                if (iter != smap.end() && iter->second == hint)
+                {
+                    tetra = hint;
+                }
+            }
+
+            // The walk of GetContainingTetrahedron.
+            auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+            int const numTetrahedra = static_cast<int>(smap.size());
+            int t;
+            for (t = 0; t < numTetrahedra; ++t)
+            {
+                int j;
+                for (j = 0; j < 4; ++j)
+                {
+                    int v0 = tetra->V[opposite[j][0]];
+                    int v1 = tetra->V[opposite[j][1]];
+                    int v2 = tetra->V[opposite[j][2]];
+                    if (evaluator.ToPlane(i, v0, v1, v2) > 0)
+                    {
+                        auto adjTetra = tetra->S[j].lock();
+                        if (adjTetra)
+                        {
+                            tetra = adjTetra;
+                            break;
+                        }
+                        else
+                        {
+                            insertion.status = Insertion::OUTSIDE;
+                            return;
+                        }
+                    }
+                }
+
+                if (j == 4)
+                {
+                    break;
+                }
+            }
+            if (t == numTetrahedra)
+            {
+                insertion.status = Insertion::FAILED;
+                return;
+            }
+
+            // The search of GetAndRemoveInsertionPolyhedron for the
+            // tetrahedra whose circumspheres contain point i.
+            insertion.cavity.push_back(tetra);
+            insertion.region[tetra.get()] = true;
+            for (size_t k = 0; k < insertion.cavity.size(); ++k)
+            {
+                std::shared_ptr<Tetrahedron> current = insertion.cavity[k];
+                for (int j = 0; j < 4; ++j)
+                {
+                    auto adj = current->S[j].lock();
+                    if (adj && insertion.region.find(adj.get()) == insertion.region.end())
+                    {
+                        int a0 = adj->V[0];
+                        int a1 = adj->V[1];
+                        int a2 = adj->V[2];
+                        int a3 = adj->V[3];
+                        bool inside = (evaluator.ToCircumsphere(i, a0, a1, a2, a3) <= 0);
+                        insertion.region[adj.get()] = inside;
+                        if (inside)
+                        {
+                            insertion.cavity.push_back(adj);
+                        }
+                    }
+                }
+            }
+
+            // The boundary faces of the cavity. As in Update, the faces for
+            // which point i is on the plane of the face are ignored.
+            for (auto const& current : insertion.cavity)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    auto adj = current->S[j].lock();
+                    if (!adj)
+                    {
+                        insertion.touchesHull = true;
+                    }
+                    if (!adj || !insertion.region[adj.get()])
+                    {
+                        int v0 = current->V[opposite[j][0]];
+                        int v1 = current->V[opposite[j][1]];
+                        int v2 = current->V[opposite[j][2]];
+                        if (evaluator.ToPlane(i, v0, v1, v2) < 0)
+                        {
+                            insertion.faces.push_back({ v0, v1, v2 });
+                        }
+                    }
+                }
+            }
+            insertion.status = Insertion::INSIDE;
+        }
+
+        // The cavity is valid when none of the tetrahedra used to compute
+        // it were removed by the earlier commits of the batch. The OUTSIDE
+        // insertions are computed by Update from the current mesh, so these
+        // do not conflict.
+        static bool Conflicts(Insertion const& insertion, std::set<Tetrahedron const*> const& removed)
+        {
+            for (auto const& element : insertion.region)
+            {
+                if (removed.find(element.first) != removed.end())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The epsilon value is used for fuzzy determination of intrinsic
+        // dimensionality.  If the dimension is 0, 1, or 2, the constructor
+        // returns early.  The caller is responsible for retrieving the
+        // dimension and taking an alternate path should the dimension be
+        // smaller than 3.  If the dimension is 0, the caller may as well
+        // treat all vertices[] as a single point, say, vertices[0].  If the
+        // dimension is 1, the caller can query for the approximating line
+        // and project vertices[] onto it for further processing.  If the
+        // dimension is 2, the caller can query for the approximating plane
+        // and project vertices[] onto it for further processing.
+        InputType mEpsilon;
+        int mDimension;
+        Line3<InputType> mLine;
+        Plane3<InputType> mPlane;
+
+        // The array of vertices used for geometric queries.  If you want to
+        // be certain of a correct result, choose ComputeType to be BSNumber.
+        std::vector<Vector3<ComputeType>> mComputeVertices;
+        PrimalQuery3<ComputeType> mQuery;
+
+        // The queries of the incremental construction are evaluated with
+        // reusable scratch registers, which avoids the allocations of the
+        // temporaries of PrimalQuery3 when ComputeType is BSNumber.
+        mutable PrimalQueryEvaluator3<ComputeType> mEvaluator;
+
+        // The evaluators of the threads of UpdateParallel.
+        std::vector<PrimalQueryEvaluator3<ComputeType>> mEvaluators;
+
+        // The graph information.
+        int mNumVertices;
+        int mNumUniqueVertices;
+        int mNumTetrahedra;
+        Vector3<InputType> const* mVertices;
+        TSManifoldMesh mGraph;
+        std::vector<int> mIndices;
+        std::vector<int> mAdjacencies;
+
+        // The compact storage of the incremental construction.
+        bool mUseCompactStorage;
+        TSCompactMesh mCompactGraph;
+        int mCompactLast;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -18,7 +18,8 @@ namespace gte
         // Construction.
         Delaunay3Mesh(Delaunay3<InputType, ComputeType> const& delaunay)
             :
-            mDelaunay(&delaunay)
+            mDelaunay(&delaunay),
+            mScheduler(nullptr)
         {
         }
 
@@ -56,6 +57,28 @@ namespace gte
             return mDelaunay->GetContainingTetrahedron(P, info);
         }
 
+        // Execute the batch containment queries as tasks of the scheduler,
+        // which can be shared with other computations, instead of creating
+        // threads for each call. The results do not depend on the scheduler.
+        // Set the scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // Batch containment queries; see Delaunay3::GetContainingTetrahedra.
+        void GetContainingTetrahedra(int numPoints, Vector3<InputType> const* points,
+            int* tetrahedra, size_t numThreads = 1) const
+        {
+            mDelaunay->GetContainingTetrahedra(numPoints, points, tetrahedra, numThreads,
+                mScheduler);
+        }
+
         bool GetVertices(int t, std::array<Vector3<InputType>, 4>& vertices) const
         {
             if (mDelaunay->GetDimension() == 3)
@@ -122,5 +145,6 @@ namespace gte
 
     private:
         Delaunay3<InputType, ComputeType> const* mDelaunay;
+        TaskScheduler* mScheduler;
     };
 }
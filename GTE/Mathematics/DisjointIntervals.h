@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.05.24
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -94,13 +95,25 @@ namespace gte
 
         // Insert [xmin,xmax) into the set.  This is a Boolean 'union'
         // operation.  The operation is successful only when xmin < xmax.
+        // An interval that is not to the left of the intervals of the set
+        // is appended without merging.
         bool Insert(Scalar const& xmin, Scalar const& xmax)
         {
             if (xmin < xmax)
             {
-                DisjointIntervals input(xmin, xmax);
-                DisjointIntervals output = *this | input;
-                mEndpoints = std::move(output.mEndpoints);
+                if (mEndpoints.size() == 0 || mEndpoints.back() < xmin)
+                {
+                    mEndpoints.push_back(xmin);
+                    mEndpoints.push_back(xmax);
+                }
+                else if (mEndpoints.back() == xmin)
+                {
+                    mEndpoints.back() = xmax;
+                }
+                else
+                {
+                    *this |= DisjointIntervals(xmin, xmax);
+                }
                 return true;
             }
             return false;
@@ -112,289 +125,323 @@ namespace gte
         {
             if (xmin < xmax)
             {
-                DisjointIntervals input(xmin, xmax);
-                DisjointIntervals output = std::move(*this - input);
-                mEndpoints = std::move(output.mEndpoints);
+                *this -= DisjointIntervals(xmin, xmax);
                 return true;
             }
             return false;
         }
 
+        // The Boolean operations are computed by a single pass over the
+        // sorted endpoints of the operands. The compound assignments merge
+        // into the storage of this set when its capacity is large enough,
+        // so repeated operations on the same set do not allocate memory.
+        // The operators whose first operand is an rvalue use the compound
+        // assignments, so a chain such as a | b | c creates only one set.
+
         // Get the union of the interval sets, input0 union input1.
         friend DisjointIntervals operator|(DisjointIntervals const& input0, DisjointIntervals const& input1)
         {
-            DisjointIntervals output;
+            return Execute(UNION, input0, input1);
+        }
 
-            size_t const numEndpoints0 = input0.mEndpoints.size();
-            size_t const numEndpoints1 = input1.mEndpoints.size();
-            size_t i0 = 0, i1 = 0;
-            int parity0 = 0, parity1 = 0;
-            while (i0 < numEndpoints0 && i1 < numEndpoints1)
-            {
-                Scalar const& value0 = input0.mEndpoints[i0];
-                Scalar const& value1 = input1.mEndpoints[i1];
+        friend DisjointIntervals operator|(DisjointIntervals&& input0, DisjointIntervals const& input1)
+        {
+            input0 |= input1;
+            return std::move(input0);
+        }
 
-                if (value0 < value1)
-                {
-                    if (parity0 == 0)
-                    {
-                        parity0 = 1;
-                        if (parity1 == 0)
-                        {
-                            output.mEndpoints.push_back(value0);
-                        }
-                    }
-                    else
-                    {
-                        if (parity1 == 0)
-                        {
-                            output.mEndpoints.push_back(value0);
-                        }
-                        parity0 = 0;
-                    }
-                    ++i0;
-                }
-                else if (value1 < value0)
-                {
-                    if (parity1 == 0)
-                    {
-                        parity1 = 1;
-                        if (parity0 == 0)
-                        {
-                            output.mEndpoints.push_back(value1);
-                        }
-                    }
-                    else
-                    {
-                        if (parity0 == 0)
-                        {
-                            output.mEndpoints.push_back(value1);
-                        }
-                        parity1 = 0;
-                    }
-                    ++i1;
-                }
-                else  // value0 == value1
-                {
-                    if (parity0 == parity1)
-                    {
-                        output.mEndpoints.push_back(value0);
-                    }
-                    parity0 ^= 1;
-                    parity1 ^= 1;
-                    ++i0;
-                    ++i1;
-                }
-            }
+        DisjointIntervals& operator|=(DisjointIntervals const& input)
+        {
+            Execute(UNION, input);
+            return *this;
+        }
 
-            while (i0 < numEndpoints0)
-            {
-                output.mEndpoints.push_back(input0.mEndpoints[i0]);
-                ++i0;
-            }
+        // Get the intersection of the interval sets, input0 intersect is1.
+        friend DisjointIntervals operator&(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        {
+            return Execute(INTERSECTION, input0, input1);
+        }
+
+        friend DisjointIntervals operator&(DisjointIntervals&& input0, DisjointIntervals const& input1)
+        {
+            input0 &= input1;
+            return std::move(input0);
+        }
+
+        DisjointIntervals& operator&=(DisjointIntervals const& input)
+        {
+            Execute(INTERSECTION, input);
+            return *this;
+        }
+
+        // Get the differences of the interval sets, input0 minus input1.
+        friend DisjointIntervals operator-(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        {
+            return Execute(DIFFERENCE, input0, input1);
+        }
+
+        friend DisjointIntervals operator-(DisjointIntervals&& input0, DisjointIntervals const& input1)
+        {
+            input0 -= input1;
+            return std::move(input0);
+        }
+
+        DisjointIntervals& operator-=(DisjointIntervals const& input)
+        {
+            Execute(DIFFERENCE, input);
+            return *this;
+        }
+
+        // Get the exclusive or of the interval sets, input0 xor input1 =
+        // (input0 minus input1) or (input1 minus input0).
+        friend DisjointIntervals operator^(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        {
+            return Execute(EXCLUSIVE_OR, input0, input1);
+        }
+
+        friend DisjointIntervals operator^(DisjointIntervals&& input0, DisjointIntervals const& input1)
+        {
+            input0 ^= input1;
+            return std::move(input0);
+        }
 
-            while (i1 < numEndpoints1)
+        DisjointIntervals& operator^=(DisjointIntervals const& input)
+        {
+            Execute(EXCLUSIVE_OR, input);
+            return *this;
+        }
+
+        // Comparisons of the sets.
+        friend bool operator==(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        {
+            return input0.mEndpoints == input1.mEndpoints;
+        }
+
+        friend bool operator!=(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        {
+            return input0.mEndpoints != input1.mEndpoints;
+        }
+
+        // Get the union of many interval sets. The endpoints of all the
+        // sets are merged at once using a heap of the sets ordered by their
+        // next endpoints, which for k sets with a total of n endpoints is
+        // O(n log k) rather than the O(n k) of a sequence of unions.
+        static DisjointIntervals Union(std::vector<DisjointIntervals> const& inputs)
+        {
+            std::vector<DisjointIntervals const*> pointers(inputs.size());
+            for (size_t i = 0; i < inputs.size(); ++i)
             {
-                output.mEndpoints.push_back(input1.mEndpoints[i1]);
-                ++i1;
+                pointers[i] = &inputs[i];
             }
-
-            return output;
+            return Union(pointers);
         }
 
-        // Get the intersection of the interval sets, input0 intersect is1.
-        friend DisjointIntervals operator&(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        static DisjointIntervals Union(std::vector<DisjointIntervals const*> const& inputs)
         {
             DisjointIntervals output;
-
-            size_t const numEndpoints0 = input0.mEndpoints.size();
-            size_t const numEndpoints1 = input1.mEndpoints.size();
-            size_t i0 = 0, i1 = 0;
-            int parity0 = 0, parity1 = 0;
-            while (i0 < numEndpoints0 && i1 < numEndpoints1)
+            if (inputs.size() == 1)
             {
-                Scalar const& value0 = input0.mEndpoints[i0];
-                Scalar const& value1 = input1.mEndpoints[i1];
+                output = *inputs[0];
+                return output;
+            }
 
-                if (value0 < value1)
+            // The heap contains the indices of the sets that have endpoints
+            // not yet processed, with the smallest next endpoint at the top.
+            std::vector<size_t> next(inputs.size(), 0);
+            std::vector<size_t> heap;
+            heap.reserve(inputs.size());
+            size_t numEndpoints = 0;
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                if (inputs[i]->mEndpoints.size() > 0)
                 {
-                    if (parity0 == 0)
+                    heap.push_back(i);
+                    numEndpoints += inputs[i]->mEndpoints.size();
+                }
+            }
+            auto greater = [&inputs, &next](size_t i0, size_t i1)
+            {
+                return inputs[i1]->mEndpoints[next[i1]] < inputs[i0]->mEndpoints[next[i0]];
+            };
+            std::make_heap(heap.begin(), heap.end(), greater);
+            output.mEndpoints.reserve(numEndpoints);
+
+            // The depth is the number of sets that contain the points
+            // immediately to the right of the current endpoint. A point is
+            // in the union when the depth is positive.
+            size_t depth = 0;
+            while (heap.size() > 0)
+            {
+                size_t i = heap.front();
+                Scalar const& value = inputs[i]->mEndpoints[next[i]];
+                size_t previousDepth = depth;
+                do
+                {
+                    std::pop_heap(heap.begin(), heap.end(), greater);
+                    i = heap.back();
+                    if ((next[i] & 1) == 0)
                     {
-                        parity0 = 1;
-                        if (parity1 == 1)
-                        {
-                            output.mEndpoints.push_back(value0);
-                        }
+                        ++depth;
                     }
                     else
                     {
-                        if (parity1 == 1)
-                        {
-                            output.mEndpoints.push_back(value0);
-                        }
-                        parity0 = 0;
+                        --depth;
                     }
-                    ++i0;
-                }
-                else if (value1 < value0)
-                {
-                    if (parity1 == 0)
+
+                    if (++next[i] < inputs[i]->mEndpoints.size())
                     {
-                        parity1 = 1;
-                        if (parity0 == 1)
-                        {
-                            output.mEndpoints.push_back(value1);
-                        }
+                        std::push_heap(heap.begin(), heap.end(), greater);
                     }
                     else
                     {
-                        if (parity0 == 1)
-                        {
-                            output.mEndpoints.push_back(value1);
-                        }
-                        parity1 = 0;
+                        heap.pop_back();
                     }
-                    ++i1;
                 }
-                else  // value0 == value1
+                while (heap.size() > 0 && !(value < inputs[heap.front()]->mEndpoints[next[heap.front()]]));
+
+                if ((previousDepth == 0) != (depth == 0))
                 {
-                    if (parity0 == parity1)
-                    {
-                        output.mEndpoints.push_back(value0);
-                    }
-                    parity0 ^= 1;
-                    parity1 ^= 1;
-                    ++i0;
-                    ++i1;
+                    output.mEndpoints.push_back(value);
                 }
             }
-
             return output;
         }
 
-        // Get the differences of the interval sets, input0 minus input1.
-        friend DisjointIntervals operator-(DisjointIntervals const& input0, DisjointIntervals const& input1)
+    private:
+        // The operations are truth tables indexed by 2*inside0+inside1,
+        // where inside0 and inside1 are 1 when a point is in the first and
+        // second sets, respectively.
+        enum : unsigned int
+        {
+            UNION = 0xEu,
+            INTERSECTION = 0x8u,
+            DIFFERENCE = 0x4u,
+            EXCLUSIVE_OR = 0x6u
+        };
+
+        static DisjointIntervals Execute(unsigned int operation,
+            DisjointIntervals const& input0, DisjointIntervals const& input1)
         {
-            DisjointIntervals output;
-
             size_t const numEndpoints0 = input0.mEndpoints.size();
             size_t const numEndpoints1 = input1.mEndpoints.size();
-            size_t i0 = 0, i1 = 0;
-            int parity0 = 0, parity1 = 1;
-            while (i0 < numEndpoints0 && i1 < numEndpoints1)
-            {
-                Scalar const& value0 = input0.mEndpoints[i0];
-                Scalar const& value1 = input1.mEndpoints[i1];
+            DisjointIntervals output;
+            output.mEndpoints.resize(numEndpoints0 + numEndpoints1);
+            size_t numEndpoints = Merge(operation,
+                input0.mEndpoints.data(), numEndpoints0,
+                input1.mEndpoints.data(), numEndpoints1,
+                output.mEndpoints.data());
+            output.mEndpoints.resize(numEndpoints);
+            return output;
+        }
 
-                if (value0 < value1)
-                {
-                    if (parity0 == 0)
-                    {
-                        parity0 = 1;
-                        if (parity1 == 1)
-                        {
-                            output.mEndpoints.push_back(value0);
-                        }
-                    }
-                    else
-                    {
-                        if (parity1 == 1)
-                        {
-                            output.mEndpoints.push_back(value0);
-                        }
-                        parity0 = 0;
-                    }
-                    ++i0;
-                }
-                else if (value1 < value0)
-                {
-                    if (parity1 == 0)
-                    {
-                        parity1 = 1;
-                        if (parity0 == 1)
-                        {
-                            output.mEndpoints.push_back(value1);
-                        }
-                    }
-                    else
-                    {
-                        if (parity0 == 1)
-                        {
-                            output.mEndpoints.push_back(value1);
-                        }
-                        parity1 = 0;
-                    }
-                    ++i1;
-                }
-                else  // value0 == value1
+        void Execute(unsigned int operation, DisjointIntervals const& input)
+        {
+            if (&input == this)
+            {
+                // The result is this set or the empty set.
+                if ((operation & 0x8u) == 0)
                 {
-                    if (parity0 == parity1)
-                    {
-                        output.mEndpoints.push_back(value0);
-                    }
-                    parity0 ^= 1;
-                    parity1 ^= 1;
-                    ++i0;
-                    ++i1;
+                    mEndpoints.clear();
                 }
+                return;
             }
 
-            while (i0 < numEndpoints0)
+            size_t const numEndpoints0 = mEndpoints.size();
+            size_t const numEndpoints1 = input.mEndpoints.size();
+            size_t const maxNumEndpoints = numEndpoints0 + numEndpoints1;
+            size_t numEndpoints;
+            if (mEndpoints.capacity() >= maxNumEndpoints)
             {
-                output.mEndpoints.push_back(input0.mEndpoints[i0]);
-                ++i0;
+                // Shift the endpoints of this set to the end of the storage
+                // and merge into the front. The merge never writes past the
+                // endpoints of this set that remain to be read.
+                mEndpoints.resize(maxNumEndpoints);
+                std::move_backward(mEndpoints.begin(), mEndpoints.begin() + numEndpoints0, mEndpoints.end());
+                numEndpoints = Merge(operation,
+                    mEndpoints.data() + numEndpoints1, numEndpoints0,
+                    input.mEndpoints.data(), numEndpoints1,
+                    mEndpoints.data());
+                mEndpoints.resize(numEndpoints);
+            }
+            else
+            {
+                std::vector<Scalar> output(maxNumEndpoints);
+                numEndpoints = Merge(operation,
+                    mEndpoints.data(), numEndpoints0,
+                    input.mEndpoints.data(), numEndpoints1,
+                    output.data());
+                output.resize(numEndpoints);
+                mEndpoints = std::move(output);
             }
-
-            return output;
         }
 
-        // Get the exclusive or of the interval sets, input0 xor input1 =
-        // (input0 minus input1) or (input1 minus input0).
-        friend DisjointIntervals operator^(DisjointIntervals const& input0, DisjointIntervals const& input1)
+        // Merge the endpoints and store the endpoints of the result in
+        // output, which has room for numEndpoints0+numEndpoints1 elements.
+        // The return value is the number of endpoints of the result. An
+        // endpoint is stored when the membership of the points to its
+        // right differs from that of the points to its left. The output
+        // may overlap endpoints0 when it starts numEndpoints1 elements
+        // before endpoints0.
+        static size_t Merge(unsigned int operation,
+            Scalar const* endpoints0, size_t numEndpoints0,
+            Scalar const* endpoints1, size_t numEndpoints1,
+            Scalar* output)
         {
-            DisjointIntervals output;
-
-            size_t const numEndpoints0 = input0.mEndpoints.size();
-            size_t const numEndpoints1 = input1.mEndpoints.size();
-            size_t i0 = 0, i1 = 0;
+            size_t i0 = 0, i1 = 0, numEndpoints = 0;
+            unsigned int parity0 = 0, parity1 = 0, inside = 0;
             while (i0 < numEndpoints0 && i1 < numEndpoints1)
             {
-                Scalar const& value0 = input0.mEndpoints[i0];
-                Scalar const& value1 = input1.mEndpoints[i1];
-
+                Scalar const& value0 = endpoints0[i0];
+                Scalar const& value1 = endpoints1[i1];
+                Scalar const* value;
                 if (value0 < value1)
                 {
-                    output.mEndpoints.push_back(value0);
+                    value = &value0;
+                    parity0 ^= 1;
                     ++i0;
                 }
                 else if (value1 < value0)
                 {
-                    output.mEndpoints.push_back(value1);
+                    value = &value1;
+                    parity1 ^= 1;
                     ++i1;
                 }
                 else  // value0 == value1
                 {
+                    value = &value0;
+                    parity0 ^= 1;
+                    parity1 ^= 1;
                     ++i0;
                     ++i1;
                 }
+
+                unsigned int nextInside = (operation >> (2 * parity0 + parity1)) & 1u;
+                if (nextInside != inside)
+                {
+                    output[numEndpoints++] = *value;
+                    inside = nextInside;
+                }
             }
 
-            while (i0 < numEndpoints0)
+            // One of the sets has no more endpoints, so its parity is 0.
+            // The remaining endpoints of the other set are copied when
+            // the operation with an empty set is the identity.
+            if (i0 < numEndpoints0 && (operation & 0x4u) != 0)
             {
-                output.mEndpoints.push_back(input0.mEndpoints[i0]);
-                ++i0;
+                if (output + numEndpoints != endpoints0 + i0)
+                {
+                    std::copy(endpoints0 + i0, endpoints0 + numEndpoints0, output + numEndpoints);
+                }
+                numEndpoints += numEndpoints0 - i0;
             }
-
-            while (i1 < numEndpoints1)
+            else if (i1 < numEndpoints1 && (operation & 0x2u) != 0)
             {
-                output.mEndpoints.push_back(input1.mEndpoints[i1]);
-                ++i1;
+                std::copy(endpoints1 + i1, endpoints1 + numEndpoints1, output + numEndpoints);
+                numEndpoints += numEndpoints1 - i1;
             }
-
-            return output;
+            return numEndpoints;
         }
 
-    private:
         // The array of endpoints has an even number of elements.  The i-th
         // interval is [mEndPoints[2*i],mEndPoints[2*i+1]).
         std::vector<Scalar> mEndpoints;
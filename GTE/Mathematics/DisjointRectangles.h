@@ -3,12 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/DisjointIntervals.h>
-#include <functional>
+#include <algorithm>
 
 namespace gte
 {
@@ -92,6 +92,14 @@ namespace gte
             {
             }
 
+            Strip(Scalar const& inYMin, Scalar const& inYMax, ISet&& inIntervalSet)
+                :
+                ymin(inYMin),
+                ymax(inYMax),
+                intervalSet(std::move(inIntervalSet))
+            {
+            }
+
             ~Strip()
             {
             }
@@ -195,9 +203,36 @@ namespace gte
         {
             if (xmin < xmax && ymin < ymax)
             {
-                DisjointRectangles input(xmin, xmax, ymin, ymax);
-                DisjointRectangles output = *this | input;
-                *this = std::move(output);
+                *this |= DisjointRectangles(xmin, xmax, ymin, ymax);
+                return true;
+            }
+            return false;
+        }
+
+        // Insert the strip [ymin,ymax) of the x-intervals into the set.  This
+        // is a Boolean union operation.  The operation is successful only
+        // when ymin < ymax.  A strip that is not below the strips of the set
+        // is appended without merging, so a set is built in constant time
+        // per strip by inserting the strips in order of increasing y.
+        bool Insert(Scalar const& ymin, Scalar const& ymax, ISet intervalSet)
+        {
+            if (ymin < ymax)
+            {
+                if (intervalSet.GetNumIntervals() > 0)
+                {
+                    if (mStrips.size() == 0 || !(ymin < mStrips.back().ymax))
+                    {
+                        mNumRectangles += intervalSet.GetNumIntervals();
+                        mStrips.push_back(Strip(ymin, ymax, std::move(intervalSet)));
+                    }
+                    else
+                    {
+                        DisjointRectangles input;
+                        input.mNumRectangles = intervalSet.GetNumIntervals();
+                        input.mStrips.push_back(Strip(ymin, ymax, std::move(intervalSet)));
+                        *this |= input;
+                    }
+                }
                 return true;
             }
             return false;
@@ -210,57 +245,231 @@ namespace gte
         {
             if (xmin < xmax && ymin < ymax)
             {
-                DisjointRectangles input(xmin, xmax, ymin, ymax);
-                DisjointRectangles output = *this - input;
-                *this = std::move(output);
+                *this -= DisjointRectangles(xmin, xmax, ymin, ymax);
                 return true;
             }
             return false;
         }
 
+        // The compound assignments move the interval sets of this set into
+        // the result rather than copying them, and the operators whose first
+        // operand is an rvalue use the compound assignments.
+
         // Get the union of the rectangle sets sets, input0 union input1.
         friend DisjointRectangles operator|(DisjointRectangles const& input0, DisjointRectangles const& input1)
         {
-            return Execute(
-                [](ISet const& i0, ISet const& i1) { return i0 | i1; },
-                true, true, input0, input1);
+            return Execute(Operation::UNION, input0.mStrips, input1.mStrips);
+        }
+
+        friend DisjointRectangles operator|(DisjointRectangles&& input0, DisjointRectangles const& input1)
+        {
+            input0 |= input1;
+            return std::move(input0);
+        }
+
+        DisjointRectangles& operator|=(DisjointRectangles const& input)
+        {
+            if (&input != this)
+            {
+                *this = Execute(Operation::UNION, mStrips, input.mStrips);
+            }
+            return *this;
         }
 
         // Get the intersection of the rectangle sets, input0 intersect is1.
         friend DisjointRectangles operator&(DisjointRectangles const& input0, DisjointRectangles const& input1)
         {
-            return Execute(
-                [](ISet const& i0, ISet const& i1) { return i0 & i1; },
-                false, false, input0, input1);
+            return Execute(Operation::INTERSECTION, input0.mStrips, input1.mStrips);
+        }
+
+        friend DisjointRectangles operator&(DisjointRectangles&& input0, DisjointRectangles const& input1)
+        {
+            input0 &= input1;
+            return std::move(input0);
+        }
+
+        DisjointRectangles& operator&=(DisjointRectangles const& input)
+        {
+            if (&input != this)
+            {
+                *this = Execute(Operation::INTERSECTION, mStrips, input.mStrips);
+            }
+            return *this;
         }
 
         // Get the differences of the rectangle sets, input0 minus input1.
         friend DisjointRectangles operator-(DisjointRectangles const& input0, DisjointRectangles const& input1)
         {
-            return Execute(
-                [](ISet const& i0, ISet const& i1) { return i0 - i1; },
-                false, true, input0, input1);
+            return Execute(Operation::DIFFERENCE, input0.mStrips, input1.mStrips);
+        }
+
+        friend DisjointRectangles operator-(DisjointRectangles&& input0, DisjointRectangles const& input1)
+        {
+            input0 -= input1;
+            return std::move(input0);
+        }
+
+        DisjointRectangles& operator-=(DisjointRectangles const& input)
+        {
+            if (&input != this)
+            {
+                *this = Execute(Operation::DIFFERENCE, mStrips, input.mStrips);
+            }
+            else
+            {
+                Clear();
+            }
+            return *this;
         }
 
         // Get the exclusive or of the rectangle sets, input0 xor input1 =
         // (input0 minus input1) or (input1 minus input0).
         friend DisjointRectangles operator^(DisjointRectangles const& input0, DisjointRectangles const& input1)
         {
-            return Execute(
-                [](ISet const& i0, ISet const& i1) { return i0 ^ i1; },
-                true, true, input0, input1);
+            return Execute(Operation::EXCLUSIVE_OR, input0.mStrips, input1.mStrips);
+        }
+
+        friend DisjointRectangles operator^(DisjointRectangles&& input0, DisjointRectangles const& input1)
+        {
+            input0 ^= input1;
+            return std::move(input0);
+        }
+
+        DisjointRectangles& operator^=(DisjointRectangles const& input)
+        {
+            if (&input != this)
+            {
+                *this = Execute(Operation::EXCLUSIVE_OR, mStrips, input.mStrips);
+            }
+            else
+            {
+                Clear();
+            }
+            return *this;
+        }
+
+        // Get the union of many rectangle sets in a single sweep over the
+        // strip boundaries of all the sets. The x-intervals of each
+        // elementary strip are the union of the x-interval sets of the
+        // strips that contain it, computed by ISet::Union. Adjacent strips
+        // with the same x-intervals are combined and empty strips are
+        // discarded, so the result can have fewer rectangles than a
+        // sequence of unions produces for the same set.
+        static DisjointRectangles Union(std::vector<DisjointRectangles> const& inputs)
+        {
+            struct Event
+            {
+                Scalar y;
+                ISet const* intervalSet;
+                bool isStart;
+            };
+
+            std::vector<Event> events;
+            for (auto const& input : inputs)
+            {
+                for (auto const& strip : input.mStrips)
+                {
+                    events.push_back({ strip.ymin, &strip.intervalSet, true });
+                    events.push_back({ strip.ymax, &strip.intervalSet, false });
+                }
+            }
+            std::sort(events.begin(), events.end(),
+                [](Event const& event0, Event const& event1)
+                {
+                    return event0.y < event1.y;
+                });
+
+            DisjointRectangles output;
+            std::vector<ISet const*> active;
+            for (size_t i = 0; i < events.size(); )
+            {
+                Scalar const& ymin = events[i].y;
+                for (; i < events.size() && !(ymin < events[i].y); ++i)
+                {
+                    if (events[i].isStart)
+                    {
+                        active.push_back(events[i].intervalSet);
+                    }
+                    else
+                    {
+                        auto iter = std::find(active.begin(), active.end(), events[i].intervalSet);
+                        *iter = active.back();
+                        active.pop_back();
+                    }
+                }
+
+                if (active.size() > 0)
+                {
+                    Scalar const& ymax = events[i].y;
+                    ISet intervalSet = ISet::Union(active);
+                    if (output.mStrips.size() > 0 && output.mStrips.back().ymax == ymin &&
+                        output.mStrips.back().intervalSet == intervalSet)
+                    {
+                        output.mStrips.back().ymax = ymax;
+                    }
+                    else if (intervalSet.GetNumIntervals() > 0)
+                    {
+                        output.mStrips.push_back(Strip(ymin, ymax, std::move(intervalSet)));
+                    }
+                }
+            }
+
+            output.ComputeRectangleQuantity();
+            return output;
         }
 
     private:
-        static DisjointRectangles Execute(
-            std::function<ISet(ISet const&, ISet const&)> const& operation,
-            bool unionExclusiveOr, bool unionExclusiveOrDifference,
-            DisjointRectangles const& input0, DisjointRectangles const& input1)
+        enum class Operation
+        {
+            UNION,
+            INTERSECTION,
+            DIFFERENCE,
+            EXCLUSIVE_OR
+        };
+
+        // The first operand of Execute is a strip array whose interval sets
+        // are moved into the output when they are used for the last time,
+        // or a const strip array whose interval sets are copied.
+        static inline ISet const& Take(ISet const& intervalSet)
         {
+            return intervalSet;
+        }
+
+        static inline ISet&& Take(ISet& intervalSet)
+        {
+            return std::move(intervalSet);
+        }
+
+        template <typename ISet0>
+        static ISet Apply(Operation operation, ISet0&& intr0, ISet const& intr1)
+        {
+            switch (operation)
+            {
+            case Operation::UNION:
+                return std::forward<ISet0>(intr0) | intr1;
+            case Operation::INTERSECTION:
+                return std::forward<ISet0>(intr0) & intr1;
+            case Operation::DIFFERENCE:
+                return std::forward<ISet0>(intr0) - intr1;
+            default:  // Operation::EXCLUSIVE_OR
+                return std::forward<ISet0>(intr0) ^ intr1;
+            }
+        }
+
+        template <typename Strips0>
+        static DisjointRectangles Execute(Operation operation,
+            Strips0& strips0, std::vector<Strip> const& strips1)
+        {
+            bool const unionExclusiveOr =
+                (operation == Operation::UNION || operation == Operation::EXCLUSIVE_OR);
+            bool const unionExclusiveOrDifference =
+                (operation != Operation::INTERSECTION);
+
             DisjointRectangles output;
+            output.mStrips.reserve(strips0.size() + strips1.size());
 
-            size_t const numStrips0 = input0.GetNumStrips();
-            size_t const numStrips1 = input1.GetNumStrips();
+            size_t const numStrips0 = strips0.size();
+            size_t const numStrips1 = strips1.size();
             size_t i0 = 0, i1 = 0;
             bool getOriginal0 = true, getOriginal1 = true;
             Scalar ymin0 = (Scalar)0;
@@ -270,18 +479,18 @@ namespace gte
 
             while (i0 < numStrips0 && i1 < numStrips1)
             {
-                ISet const& intr0 = input0.mStrips[i0].intervalSet;
+                auto& intr0 = strips0[i0].intervalSet;
                 if (getOriginal0)
                 {
-                    ymin0 = input0.mStrips[i0].ymin;
-                    ymax0 = input0.mStrips[i0].ymax;
+                    ymin0 = strips0[i0].ymin;
+                    ymax0 = strips0[i0].ymax;
                 }
 
-                ISet const& intr1 = input1.mStrips[i1].intervalSet;
+                ISet const& intr1 = strips1[i1].intervalSet;
                 if (getOriginal1)
                 {
-                    ymin1 = input1.mStrips[i1].ymin;
-                    ymax1 = input1.mStrips[i1].ymax;
+                    ymin1 = strips1[i1].ymin;
+                    ymax1 = strips1[i1].ymax;
                 }
 
                 // Case 1.
@@ -305,7 +514,7 @@ namespace gte
                     // operator(strip0,empty)
                     if (unionExclusiveOrDifference)
                     {
-                        output.mStrips.push_back(Strip(ymin0, ymax0, intr0));
+                        output.mStrips.push_back(Strip(ymin0, ymax0, Take(intr0)));
                     }
 
                     ++i0;
@@ -344,8 +553,7 @@ namespace gte
                 if (ymax1 < ymax0)
                 {
                     // operator(strip0,[ymin1,ymax1))
-                    auto result = operation(intr0, intr1);
-                    output.mStrips.push_back(Strip(ymin1, ymax1, result));
+                    output.mStrips.push_back(Strip(ymin1, ymax1, Apply(operation, intr0, intr1)));
 
                     ymin0 = ymax1;
                     ++i1;
@@ -358,8 +566,7 @@ namespace gte
                 if (ymax1 == ymax0)
                 {
                     // operator(strip0,[ymin1,ymax1))
-                    auto result = operation(intr0, intr1);
-                    output.mStrips.push_back(Strip(ymin1, ymax1, result));
+                    output.mStrips.push_back(Strip(ymin1, ymax1, Apply(operation, Take(intr0), intr1)));
 
                     ++i0;
                     ++i1;
@@ -372,8 +579,7 @@ namespace gte
                 if (ymax1 > ymax0)
                 {
                     // operator(strip0,[ymin1,ymax0))
-                    auto result = operation(intr0, intr1);
-                    output.mStrips.push_back(Strip(ymin1, ymax0, result));
+                    output.mStrips.push_back(Strip(ymin1, ymax0, Apply(operation, Take(intr0), intr1)));
 
                     ymin1 = ymax0;
                     ++i0;
@@ -389,8 +595,8 @@ namespace gte
                 {
                     if (getOriginal0)
                     {
-                        ymin0 = input0.mStrips[i0].ymin;
-                        ymax0 = input0.mStrips[i0].ymax;
+                        ymin0 = strips0[i0].ymin;
+                        ymax0 = strips0[i0].ymax;
                     }
                     else
                     {
@@ -399,7 +605,7 @@ namespace gte
 
                     // operator(strip0,empty)
                     output.mStrips.push_back(Strip(ymin0, ymax0,
-                        input0.mStrips[i0].intervalSet));
+                        Take(strips0[i0].intervalSet)));
 
                     ++i0;
                 }
@@ -411,8 +617,8 @@ namespace gte
                 {
                     if (getOriginal1)
                     {
-                        ymin1 = input1.mStrips[i1].ymin;
-                        ymax1 = input1.mStrips[i1].ymax;
+                        ymin1 = strips1[i1].ymin;
+                        ymax1 = strips1[i1].ymax;
                     }
                     else
                     {
@@ -421,7 +627,7 @@ namespace gte
 
                     // operator(empty,strip1)
                     output.mStrips.push_back(Strip(ymin1, ymax1,
-                        input1.mStrips[i1].intervalSet));
+                        strips1[i1].intervalSet));
 
                     ++i1;
                 }
@@ -434,7 +640,7 @@ namespace gte
         void ComputeRectangleQuantity()
         {
             mNumRectangles = 0;
-            for (auto strip : mStrips)
+            for (auto const& strip : mStrips)
             {
                 mNumRectangles += strip.intervalSet.GetNumIntervals();
             }
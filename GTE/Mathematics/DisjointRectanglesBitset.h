@@ -0,0 +1,317 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/BitHacks.h>
+#include <Mathematics/DisjointRectangles.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Boolean operations of sets of half-open rectangles with integer
+// coordinates in a bounded domain [xmin,xmax)x[ymin,ymax). The set is
+// stored as a bitmap with one bit per unit square, one row of 64-bit words
+// per y-value, so the Boolean operations are word operations whose cost
+// depends only on the size of the domain, not on the number of rectangles.
+// This is faster than DisjointRectangles when many operations are applied
+// to sets of many rectangles in a small domain, such as the layout of
+// widgets on a screen. The sets are converted to and from DisjointRectangles
+// for the queries that need rectangles. The operands of a Boolean operation
+// must have the same domain.
+
+namespace gte
+{
+    template <typename Integer>
+    class DisjointRectanglesBitset
+    {
+    public:
+        static_assert(std::is_integral<Integer>::value, "Integer type required.");
+
+        // Convenient type definition.
+        typedef DisjointRectangles<Integer> RSet;
+
+        // Construction of an empty set. The default constructor creates an
+        // empty domain.
+        DisjointRectanglesBitset()
+            :
+            mXMin(0), mXMax(0), mYMin(0), mYMax(0),
+            mNumWordsPerRow(0)
+        {
+        }
+
+        DisjointRectanglesBitset(Integer const& xmin, Integer const& xmax,
+            Integer const& ymin, Integer const& ymax)
+            :
+            mXMin(xmin), mXMax(xmax), mYMin(ymin), mYMax(ymax),
+            mNumWordsPerRow(0)
+        {
+            LogAssert(xmin <= xmax && ymin <= ymax, "Invalid domain.");
+            mNumWordsPerRow = (static_cast<size_t>(xmax - xmin) + 63) / 64;
+            mBits.resize(mNumWordsPerRow * static_cast<size_t>(ymax - ymin), 0);
+        }
+
+        // Construction from rectangles, which are clipped to the domain.
+        DisjointRectanglesBitset(Integer const& xmin, Integer const& xmax,
+            Integer const& ymin, Integer const& ymax, RSet const& rectangles)
+            :
+            DisjointRectanglesBitset(xmin, xmax, ymin, ymax)
+        {
+            typename RSet::ISet intervalSet;
+            Integer rxmin = 0, rxmax = 0, rymin = 0, rymax = 0;
+            for (int i = 0; i < rectangles.GetNumStrips(); ++i)
+            {
+                rectangles.GetStrip(i, rymin, rymax, intervalSet);
+                for (int j = 0; j < intervalSet.GetNumIntervals(); ++j)
+                {
+                    intervalSet.GetInterval(j, rxmin, rxmax);
+                    Insert(rxmin, rxmax, rymin, rymax);
+                }
+            }
+        }
+
+        // Member access.
+        inline void GetDomain(Integer& xmin, Integer& xmax, Integer& ymin, Integer& ymax) const
+        {
+            xmin = mXMin;
+            xmax = mXMax;
+            ymin = mYMin;
+            ymax = mYMax;
+        }
+
+        bool IsEmpty() const
+        {
+            for (auto word : mBits)
+            {
+                if (word != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Make this set empty. The domain is unchanged.
+        inline void Clear()
+        {
+            std::fill(mBits.begin(), mBits.end(), static_cast<uint64_t>(0));
+        }
+
+        // The unit square [x,x+1)x[y,y+1) is in the set. The function
+        // returns false for points outside the domain.
+        bool Contains(Integer const& x, Integer const& y) const
+        {
+            if (mXMin <= x && x < mXMax && mYMin <= y && y < mYMax)
+            {
+                size_t column = static_cast<size_t>(x - mXMin);
+                uint64_t word = mBits[GetRow(y) + column / 64];
+                return (word & (static_cast<uint64_t>(1) << (column % 64))) != 0;
+            }
+            return false;
+        }
+
+        // Insert or remove [xmin,xmax)x[ymin,ymax), clipped to the domain.
+        // The operation is successful only when xmin < xmax and ymin < ymax.
+        bool Insert(Integer const& xmin, Integer const& xmax, Integer const& ymin, Integer const& ymax)
+        {
+            return Modify(xmin, xmax, ymin, ymax,
+                [](uint64_t& word, uint64_t mask) { word |= mask; });
+        }
+
+        bool Remove(Integer const& xmin, Integer const& xmax, Integer const& ymin, Integer const& ymax)
+        {
+            return Modify(xmin, xmax, ymin, ymax,
+                [](uint64_t& word, uint64_t mask) { word &= ~mask; });
+        }
+
+        // The Boolean operations.
+        DisjointRectanglesBitset& operator|=(DisjointRectanglesBitset const& input)
+        {
+            return Execute(input, [](uint64_t word0, uint64_t word1) { return word0 | word1; });
+        }
+
+        DisjointRectanglesBitset& operator&=(DisjointRectanglesBitset const& input)
+        {
+            return Execute(input, [](uint64_t word0, uint64_t word1) { return word0 & word1; });
+        }
+
+        DisjointRectanglesBitset& operator-=(DisjointRectanglesBitset const& input)
+        {
+            return Execute(input, [](uint64_t word0, uint64_t word1) { return word0 & ~word1; });
+        }
+
+        DisjointRectanglesBitset& operator^=(DisjointRectanglesBitset const& input)
+        {
+            return Execute(input, [](uint64_t word0, uint64_t word1) { return word0 ^ word1; });
+        }
+
+        friend DisjointRectanglesBitset operator|(DisjointRectanglesBitset input0, DisjointRectanglesBitset const& input1)
+        {
+            input0 |= input1;
+            return input0;
+        }
+
+        friend DisjointRectanglesBitset operator&(DisjointRectanglesBitset input0, DisjointRectanglesBitset const& input1)
+        {
+            input0 &= input1;
+            return input0;
+        }
+
+        friend DisjointRectanglesBitset operator-(DisjointRectanglesBitset input0, DisjointRectanglesBitset const& input1)
+        {
+            input0 -= input1;
+            return input0;
+        }
+
+        friend DisjointRectanglesBitset operator^(DisjointRectanglesBitset input0, DisjointRectanglesBitset const& input1)
+        {
+            input0 ^= input1;
+            return input0;
+        }
+
+        friend bool operator==(DisjointRectanglesBitset const& input0, DisjointRectanglesBitset const& input1)
+        {
+            return input0.mXMin == input1.mXMin && input0.mXMax == input1.mXMax
+                && input0.mYMin == input1.mYMin && input0.mYMax == input1.mYMax
+                && input0.mBits == input1.mBits;
+        }
+
+        friend bool operator!=(DisjointRectanglesBitset const& input0, DisjointRectanglesBitset const& input1)
+        {
+            return !(input0 == input1);
+        }
+
+        // Convert the set to rectangles. Each row is converted to the
+        // x-intervals of its runs of bits, and consecutive rows with the
+        // same bits are combined into one strip.
+        RSet GetRectangles() const
+        {
+            RSet rectangles;
+            Integer const numRows = mYMax - mYMin;
+            Integer y0 = 0;
+            while (y0 < numRows)
+            {
+                uint64_t const* row0 = &mBits[static_cast<size_t>(y0) * mNumWordsPerRow];
+                Integer y1 = y0 + 1;
+                for (; y1 < numRows; ++y1)
+                {
+                    uint64_t const* row1 = &mBits[static_cast<size_t>(y1) * mNumWordsPerRow];
+                    if (!std::equal(row0, row0 + mNumWordsPerRow, row1))
+                    {
+                        break;
+                    }
+                }
+
+                typename RSet::ISet intervalSet;
+                size_t const numColumns = static_cast<size_t>(mXMax - mXMin);
+                size_t column = FindBit(row0, 0, 0);
+                while (column < numColumns)
+                {
+                    size_t end = std::min(FindBit(row0, column, ~static_cast<uint64_t>(0)), numColumns);
+                    intervalSet.Insert(mXMin + static_cast<Integer>(column), mXMin + static_cast<Integer>(end));
+                    column = FindBit(row0, end, 0);
+                }
+                rectangles.Insert(mYMin + y0, mYMin + y1, std::move(intervalSet));
+                y0 = y1;
+            }
+            return rectangles;
+        }
+
+    private:
+        inline size_t GetRow(Integer const& y) const
+        {
+            return static_cast<size_t>(y - mYMin) * mNumWordsPerRow;
+        }
+
+        // Get the index of the first bit at or after the specified column
+        // that differs from the bits of the complement mask. The function
+        // returns 64*mNumWordsPerRow when there is no such bit.
+        size_t FindBit(uint64_t const* row, size_t column, uint64_t complement) const
+        {
+            size_t i = column / 64;
+            if (i >= mNumWordsPerRow)
+            {
+                return 64 * mNumWordsPerRow;
+            }
+
+            uint64_t word = (row[i] ^ complement) & (~static_cast<uint64_t>(0) << (column % 64));
+            while (word == 0)
+            {
+                if (++i == mNumWordsPerRow)
+                {
+                    return 64 * mNumWordsPerRow;
+                }
+                word = row[i] ^ complement;
+            }
+            return 64 * i + static_cast<size_t>(BitHacks::GetTrailingBit(word));
+        }
+
+        template <typename Modifier>
+        bool Modify(Integer xmin, Integer xmax, Integer ymin, Integer ymax, Modifier const& modifier)
+        {
+            if (xmin < xmax && ymin < ymax)
+            {
+                xmin = std::max(xmin, mXMin);
+                xmax = std::min(xmax, mXMax);
+                ymin = std::max(ymin, mYMin);
+                ymax = std::min(ymax, mYMax);
+                if (xmin < xmax && ymin < ymax)
+                {
+                    size_t const column0 = static_cast<size_t>(xmin - mXMin);
+                    size_t const column1 = static_cast<size_t>(xmax - mXMin) - 1;
+                    size_t const i0 = column0 / 64, i1 = column1 / 64;
+                    uint64_t const ones = ~static_cast<uint64_t>(0);
+                    uint64_t const mask0 = ones << (column0 % 64);
+                    uint64_t const mask1 = ones >> (63 - column1 % 64);
+                    for (Integer y = ymin; y < ymax; ++y)
+                    {
+                        uint64_t* row = &mBits[GetRow(y)];
+                        if (i0 == i1)
+                        {
+                            modifier(row[i0], mask0 & mask1);
+                        }
+                        else
+                        {
+                            modifier(row[i0], mask0);
+                            for (size_t i = i0 + 1; i < i1; ++i)
+                            {
+                                modifier(row[i], ones);
+                            }
+                            modifier(row[i1], mask1);
+                        }
+                    }
+                }
+                return true;
+            }
+            return false;
+        }
+
+        template <typename Operation>
+        DisjointRectanglesBitset& Execute(DisjointRectanglesBitset const& input, Operation const& operation)
+        {
+            LogAssert(mXMin == input.mXMin && mXMax == input.mXMax && mYMin == input.mYMin && mYMax == input.mYMax,
+                "The domains must be the same.");
+
+            // The bits beyond the domain in the last word of each row are
+            // zero, and the operations preserve this.
+            uint64_t* bits = mBits.data();
+            uint64_t const* inputBits = input.mBits.data();
+            size_t const numWords = mBits.size();
+            for (size_t i = 0; i < numWords; ++i)
+            {
+                bits[i] = operation(bits[i], inputBits[i]);
+            }
+            return *this;
+        }
+
+        Integer mXMin, mXMax, mYMin, mYMax;
+        size_t mNumWordsPerRow;
+        std::vector<uint64_t> mBits;
+    };
+}
@@ -0,0 +1,448 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/AlignedBox.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/OrientedBox.h>
+#include <Mathematics/PointCloud.h>
+#include <Mathematics/Segment.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Triangle.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Batch distance queries of points to segments, triangles, aligned boxes and
+// oriented boxes: many points with one primitive, which is the inner loop of
+// signed-distance-field generation, or one point with many triangles, which
+// is the leaf test of a point-to-mesh query using a bounding volume
+// hierarchy. The points and the triangles of a batch are stored as
+// structure of arrays using PointCloudView.
+//
+// The Distance functions write the distances of the query pairs to the
+// array 'distance'. The Closest functions also write the closest points of
+// the primitives to the coordinate arrays closest[0..2]. The results are
+// those of the single-pair DCPQuery objects, up to rounding errors. For a
+// point equidistant from several features of a triangle, the closest point
+// can be a different one of the features.
+//
+// As in IntrRay3Batch, the loops over the pairs have no branches, so the
+// compiler can vectorize them when the vectorizer is enabled, for example
+// by -O3 -fno-math-errno for GCC. The triangle kernel computes the closest
+// points of the plane and of the three edges and selects the nearest of the
+// valid ones rather than branching on the region of the point. When
+// 'scheduler' is not null, the pairs are partitioned into chunks that are
+// processed by its threads.
+
+namespace gte
+{
+    template <typename T>
+    class DistPoint3Batch
+    {
+    public:
+        // Many points with one segment.
+        static void Distance(PointCloudView<3, T> const& points, Segment3<T> const& segment,
+            T* distance, TaskScheduler* scheduler = nullptr)
+        {
+            ForSegment(points, segment, scheduler,
+                [distance](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                });
+        }
+
+        static void Closest(PointCloudView<3, T> const& points, Segment3<T> const& segment,
+            T* distance, std::array<T*, 3> const& closest, TaskScheduler* scheduler = nullptr)
+        {
+            ForSegment(points, segment, scheduler,
+                [distance, closest](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                    StoreClosest(i, count, block, closest);
+                });
+        }
+
+        // Many points with one triangle.
+        static void Distance(PointCloudView<3, T> const& points, Triangle3<T> const& triangle,
+            T* distance, TaskScheduler* scheduler = nullptr)
+        {
+            ForTriangle(points, triangle, scheduler,
+                [distance](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                });
+        }
+
+        static void Closest(PointCloudView<3, T> const& points, Triangle3<T> const& triangle,
+            T* distance, std::array<T*, 3> const& closest, TaskScheduler* scheduler = nullptr)
+        {
+            ForTriangle(points, triangle, scheduler,
+                [distance, closest](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                    StoreClosest(i, count, block, closest);
+                });
+        }
+
+        // One point with many triangles.
+        static void Distance(Vector3<T> const& point, PointCloudView<3, T> const& v0,
+            PointCloudView<3, T> const& v1, PointCloudView<3, T> const& v2,
+            T* distance, TaskScheduler* scheduler = nullptr)
+        {
+            ForTriangles(point, v0, v1, v2, scheduler,
+                [distance](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                });
+        }
+
+        static void Closest(Vector3<T> const& point, PointCloudView<3, T> const& v0,
+            PointCloudView<3, T> const& v1, PointCloudView<3, T> const& v2,
+            T* distance, std::array<T*, 3> const& closest, TaskScheduler* scheduler = nullptr)
+        {
+            ForTriangles(point, v0, v1, v2, scheduler,
+                [distance, closest](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                    StoreClosest(i, count, block, closest);
+                });
+        }
+
+        // Many points with one aligned box.
+        static void Distance(PointCloudView<3, T> const& points, AlignedBox3<T> const& box,
+            T* distance, TaskScheduler* scheduler = nullptr)
+        {
+            ForAlignedBox(points, box, scheduler,
+                [distance](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                });
+        }
+
+        static void Closest(PointCloudView<3, T> const& points, AlignedBox3<T> const& box,
+            T* distance, std::array<T*, 3> const& closest, TaskScheduler* scheduler = nullptr)
+        {
+            ForAlignedBox(points, box, scheduler,
+                [distance, closest](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                    StoreClosest(i, count, block, closest);
+                });
+        }
+
+        // Many points with one oriented box.
+        static void Distance(PointCloudView<3, T> const& points, OrientedBox3<T> const& box,
+            T* distance, TaskScheduler* scheduler = nullptr)
+        {
+            ForOrientedBox(points, box, scheduler,
+                [distance](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                });
+        }
+
+        static void Closest(PointCloudView<3, T> const& points, OrientedBox3<T> const& box,
+            T* distance, std::array<T*, 3> const& closest, TaskScheduler* scheduler = nullptr)
+        {
+            ForOrientedBox(points, box, scheduler,
+                [distance, closest](size_t i, size_t count, Block const& block)
+                {
+                    StoreDistances(i, count, block, distance);
+                    StoreClosest(i, count, block, closest);
+                });
+        }
+
+    private:
+        // The blocks are those of IntrRay3Batch. The kernels write the
+        // closest points to the arrays of a local block, which allows the
+        // compiler to vectorize the loop over its lanes, and the results
+        // are then copied to the output arrays.
+        static size_t constexpr blockSize = 8;
+
+        struct Block
+        {
+            std::array<T, blockSize> distance, closest0, closest1, closest2;
+        };
+
+        // Process the pairs in chunks of whole blocks, one chunk per task of
+        // the scheduler.
+        template <typename Lane, typename Output>
+        static void ForBlocks(size_t numPairs, TaskScheduler* scheduler,
+            Lane const& lane, Output const& output)
+        {
+            size_t const numBlocks = (numPairs + blockSize - 1) / blockSize;
+            size_t const numChunks = (scheduler ?
+                std::max(std::min(numBlocks, 4 * scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [numPairs, numBlocks, numChunks, &lane, &output](size_t chunk)
+                {
+                    size_t const imin = blockSize * (numBlocks * chunk / numChunks);
+                    size_t const imax = std::min(
+                        blockSize * (numBlocks * (chunk + 1) / numChunks), numPairs);
+                    Block block;
+                    size_t i = imin;
+                    for (; i + blockSize <= imax; i += blockSize)
+                    {
+                        for (size_t j = 0; j < blockSize; ++j)
+                        {
+                            lane(i + j, j, block);
+                        }
+                        output(i, blockSize, block);
+                    }
+                    if (i < imax)
+                    {
+                        size_t const count = imax - i;
+                        for (size_t j = 0; j < count; ++j)
+                        {
+                            lane(i + j, j, block);
+                        }
+                        output(i, count, block);
+                    }
+                });
+        }
+
+        static inline void StoreDistances(size_t i, size_t count, Block const& block,
+            T* distance)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                distance[i + j] = block.distance[j];
+            }
+        }
+
+        static inline void StoreClosest(size_t i, size_t count, Block const& block,
+            std::array<T*, 3> const& closest)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                closest[0][i + j] = block.closest0[j];
+                closest[1][i + j] = block.closest1[j];
+                closest[2][i + j] = block.closest2[j];
+            }
+        }
+
+        static inline T Clamp(T x, T xmin, T xmax)
+        {
+            return (x < xmin ? xmin : (x > xmax ? xmax : x));
+        }
+
+        // Store the closest point c and the distance sqrt(r0^2+r1^2+r2^2),
+        // where the residual r is the difference of the query point and c,
+        // possibly in the coordinate system of a box.
+        static inline void StoreLane(T r0, T r1, T r2, T c0, T c1, T c2,
+            Block& block, size_t j)
+        {
+            block.distance[j] = std::sqrt(r0 * r0 + r1 * r1 + r2 * r2);
+            block.closest0[j] = c0;
+            block.closest1[j] = c1;
+            block.closest2[j] = c2;
+        }
+
+        // The query point is p, the segment is q0 + t * (q1 - q0) for t in
+        // [0,1] and e = q1 - q0.
+        static inline void SegmentKernel(T p0, T p1, T p2, T q00, T q01, T q02,
+            T q10, T q11, T q12, T e0, T e1, T e2, T sqrLength, Block& block, size_t j)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const numer = (p0 - q00) * e0 + (p1 - q01) * e1 + (p2 - q02) * e2;
+            T const t = Clamp(numer / (sqrLength > zero ? sqrLength : one), zero, one);
+            bool const atEnd = (t == one);
+            T const c0 = (atEnd ? q10 : q00 + t * e0);
+            T const c1 = (atEnd ? q11 : q01 + t * e1);
+            T const c2 = (atEnd ? q12 : q02 + t * e2);
+            StoreLane(p0 - c0, p1 - c1, p2 - c2, c0, c1, c2, block, j);
+        }
+
+        // The triangle is v + s * e + t * f for s >= 0, t >= 0 and s + t <= 1,
+        // and d = p - v for the query point p. Each candidate is the closest
+        // point of the plane of the triangle or of one of its edges, with the
+        // squared length of the residual d - s * e - t * f. The plane
+        // candidate is valid only when it is inside the triangle, in which
+        // case it is the closest point.
+        static inline void TriangleKernel(T p0, T p1, T p2, T v0, T v1, T v2,
+            T e0, T e1, T e2, T f0, T f1, T f2, Block& block, size_t j)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const d0 = p0 - v0, d1 = p1 - v1, d2 = p2 - v2;
+            T const a00 = e0 * e0 + e1 * e1 + e2 * e2;
+            T const a01 = e0 * f0 + e1 * f1 + e2 * f2;
+            T const a11 = f0 * f0 + f1 * f1 + f2 * f2;
+            T const b0 = d0 * e0 + d1 * e1 + d2 * e2;
+            T const b1 = d0 * f0 + d1 * f1 + d2 * f2;
+
+            // The edge from v to v + e has parameters (s,0).
+            T const sE = Clamp(b0 / (a00 > zero ? a00 : one), zero, one);
+            T const rE0 = d0 - sE * e0, rE1 = d1 - sE * e1, rE2 = d2 - sE * e2;
+            T const sqrE = rE0 * rE0 + rE1 * rE1 + rE2 * rE2;
+
+            // The edge from v to v + f has parameters (0,t).
+            T const tF = Clamp(b1 / (a11 > zero ? a11 : one), zero, one);
+            T const rF0 = d0 - tF * f0, rF1 = d1 - tF * f1, rF2 = d2 - tF * f2;
+            T const sqrF = rF0 * rF0 + rF1 * rF1 + rF2 * rF2;
+
+            // The edge from v + e to v + f has parameters (1-t,t), where the
+            // numerator is Dot(d - e, f - e) and the denominator is
+            // Dot(f - e, f - e).
+            T const numerG = b1 - b0 - a01 + a00;
+            T const denomG = a00 - a01 - a01 + a11;
+            T const tG = Clamp(numerG / (denomG > zero ? denomG : one), zero, one);
+            T const sG = one - tG;
+            T const rG0 = d0 - sG * e0 - tG * f0;
+            T const rG1 = d1 - sG * e1 - tG * f1;
+            T const rG2 = d2 - sG * e2 - tG * f2;
+            T const sqrG = rG0 * rG0 + rG1 * rG1 + rG2 * rG2;
+
+            // The plane has parameters (s,t) that solve the normal equations.
+            T const det = a00 * a11 - a01 * a01;
+            T const invDet = one / (det > zero ? det : one);
+            T const sP = (a11 * b0 - a01 * b1) * invDet;
+            T const tP = (a00 * b1 - a01 * b0) * invDet;
+            bool const inside = (det > zero) & (sP >= zero) & (tP >= zero) & (sP + tP <= one);
+
+            bool const useF = (sqrF < sqrE);
+            T const sqrEF = (useF ? sqrF : sqrE);
+            bool const useG = (sqrG < sqrEF);
+            T s = (useG ? sG : (useF ? zero : sE));
+            T t = (useG ? tG : (useF ? tF : zero));
+            s = (inside ? sP : s);
+            t = (inside ? tP : t);
+            T const c0 = v0 + s * e0 + t * f0;
+            T const c1 = v1 + s * e1 + t * f1;
+            T const c2 = v2 + s * e2 + t * f2;
+            StoreLane(p0 - c0, p1 - c1, p2 - c2, c0, c1, c2, block, j);
+        }
+
+        template <typename Output>
+        static void ForSegment(PointCloudView<3, T> const& points, Segment3<T> const& segment,
+            TaskScheduler* scheduler, Output const& output)
+        {
+            Vector3<T> const direction = segment.p[1] - segment.p[0];
+            T const q00 = segment.p[0][0], q01 = segment.p[0][1], q02 = segment.p[0][2];
+            T const q10 = segment.p[1][0], q11 = segment.p[1][1], q12 = segment.p[1][2];
+            T const e0 = direction[0], e1 = direction[1], e2 = direction[2];
+            T const sqrLength = Dot(direction, direction);
+            T const* px = points.GetCoordinates(0);
+            T const* py = points.GetCoordinates(1);
+            T const* pz = points.GetCoordinates(2);
+            ForBlocks(points.GetNumPoints(), scheduler,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    SegmentKernel(px[i], py[i], pz[i], q00, q01, q02, q10, q11, q12,
+                        e0, e1, e2, sqrLength, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForTriangle(PointCloudView<3, T> const& points, Triangle3<T> const& triangle,
+            TaskScheduler* scheduler, Output const& output)
+        {
+            Vector3<T> const E = triangle.v[1] - triangle.v[0];
+            Vector3<T> const F = triangle.v[2] - triangle.v[0];
+            T const v0 = triangle.v[0][0], v1 = triangle.v[0][1], v2 = triangle.v[0][2];
+            T const e0 = E[0], e1 = E[1], e2 = E[2];
+            T const f0 = F[0], f1 = F[1], f2 = F[2];
+            T const* px = points.GetCoordinates(0);
+            T const* py = points.GetCoordinates(1);
+            T const* pz = points.GetCoordinates(2);
+            ForBlocks(points.GetNumPoints(), scheduler,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    TriangleKernel(px[i], py[i], pz[i], v0, v1, v2,
+                        e0, e1, e2, f0, f1, f2, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForTriangles(Vector3<T> const& point, PointCloudView<3, T> const& v0,
+            PointCloudView<3, T> const& v1, PointCloudView<3, T> const& v2,
+            TaskScheduler* scheduler, Output const& output)
+        {
+            size_t const numTriangles = v0.GetNumPoints();
+            LogAssert(v1.GetNumPoints() == numTriangles && v2.GetNumPoints() == numTriangles,
+                "Mismatched triangle arrays.");
+            T const* x0 = v0.GetCoordinates(0);
+            T const* y0 = v0.GetCoordinates(1);
+            T const* z0 = v0.GetCoordinates(2);
+            T const* x1 = v1.GetCoordinates(0);
+            T const* y1 = v1.GetCoordinates(1);
+            T const* z1 = v1.GetCoordinates(2);
+            T const* x2 = v2.GetCoordinates(0);
+            T const* y2 = v2.GetCoordinates(1);
+            T const* z2 = v2.GetCoordinates(2);
+            T const p0 = point[0], p1 = point[1], p2 = point[2];
+            ForBlocks(numTriangles, scheduler,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    TriangleKernel(p0, p1, p2, x0[i], y0[i], z0[i],
+                        x1[i] - x0[i], y1[i] - y0[i], z1[i] - z0[i],
+                        x2[i] - x0[i], y2[i] - y0[i], z2[i] - z0[i], block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForAlignedBox(PointCloudView<3, T> const& points, AlignedBox3<T> const& box,
+            TaskScheduler* scheduler, Output const& output)
+        {
+            T const min0 = box.min[0], min1 = box.min[1], min2 = box.min[2];
+            T const max0 = box.max[0], max1 = box.max[1], max2 = box.max[2];
+            T const* px = points.GetCoordinates(0);
+            T const* py = points.GetCoordinates(1);
+            T const* pz = points.GetCoordinates(2);
+            ForBlocks(points.GetNumPoints(), scheduler,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    T const c0 = Clamp(px[i], min0, max0);
+                    T const c1 = Clamp(py[i], min1, max1);
+                    T const c2 = Clamp(pz[i], min2, max2);
+                    StoreLane(px[i] - c0, py[i] - c1, pz[i] - c2, c0, c1, c2, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForOrientedBox(PointCloudView<3, T> const& points, OrientedBox3<T> const& box,
+            TaskScheduler* scheduler, Output const& output)
+        {
+            T const c0 = box.center[0], c1 = box.center[1], c2 = box.center[2];
+            T const u00 = box.axis[0][0], u01 = box.axis[0][1], u02 = box.axis[0][2];
+            T const u10 = box.axis[1][0], u11 = box.axis[1][1], u12 = box.axis[1][2];
+            T const u20 = box.axis[2][0], u21 = box.axis[2][1], u22 = box.axis[2][2];
+            T const x0 = box.extent[0], x1 = box.extent[1], x2 = box.extent[2];
+            T const* px = points.GetCoordinates(0);
+            T const* py = points.GetCoordinates(1);
+            T const* pz = points.GetCoordinates(2);
+            ForBlocks(points.GetNumPoints(), scheduler,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    // The query point in the coordinate system of the box
+                    // is q and its closest point is k.
+                    T const d0 = px[i] - c0, d1 = py[i] - c1, d2 = pz[i] - c2;
+                    T const q0 = d0 * u00 + d1 * u01 + d2 * u02;
+                    T const q1 = d0 * u10 + d1 * u11 + d2 * u12;
+                    T const q2 = d0 * u20 + d1 * u21 + d2 * u22;
+                    T const k0 = Clamp(q0, -x0, x0);
+                    T const k1 = Clamp(q1, -x1, x1);
+                    T const k2 = Clamp(q2, -x2, x2);
+                    StoreLane(q0 - k0, q1 - k1, q2 - k2,
+                        c0 + k0 * u00 + k1 * u10 + k2 * u20,
+                        c1 + k0 * u01 + k1 * u11 + k2 * u21,
+                        c2 + k0 * u02 + k1 * u12 + k2 * u22,
+                        block, j);
+                },
+                output);
+        }
+    };
+}
@@ -0,0 +1,440 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/AlignedBox.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// A bounding volume hierarchy of axis-aligned boxes that supports insertion,
+// removal and motion of the boxes, for broad-phase collision detection of
+// moving objects. The leaves store the boxes of the objects enlarged by a
+// margin, so an object that moves by less than the margin does not change
+// the tree. A box is inserted as the sibling of the node that minimizes the
+// increase of the sum of the surface areas of the interior nodes (the
+// surface-area heuristic), and the tree is rebalanced by rotations along
+// the path to the root, as for an AVL tree. Querying the boxes that overlap
+// a box is O(log n + k) for k overlaps in a balanced tree, which avoids the
+// O(n^2) pair tests of BoxManager for large numbers of objects.
+//
+// A leaf is identified by a proxy, the index of its node, that is valid
+// until the leaf is removed. The user data of a leaf is an integer, usually
+// the index of the object that the box bounds.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class DynamicAABBTree
+    {
+    public:
+        static int constexpr invalid = -1;
+
+        DynamicAABBTree()
+            :
+            mRoot(invalid),
+            mFreeList(invalid),
+            mNumLeaves(0)
+        {
+        }
+
+        // Insert a leaf for the box enlarged by the margin in all
+        // directions and return its proxy.
+        int Insert(AlignedBox<N, Real> const& box, Real margin, int userData)
+        {
+            int leaf = AllocateNode();
+            Node& node = mNodes[leaf];
+            node.box = Enlarge(box, margin);
+            node.userData = userData;
+            node.height = 0;
+            InsertLeaf(leaf);
+            ++mNumLeaves;
+            return leaf;
+        }
+
+        void Remove(int proxy)
+        {
+            LogAssert(IsLeaf(proxy), "Invalid proxy.");
+            RemoveLeaf(proxy);
+            FreeNode(proxy);
+            --mNumLeaves;
+        }
+
+        // The box of the leaf is updated only when the input box is not
+        // contained in it, in which case the leaf is reinserted with the box
+        // enlarged by the margin and the function returns true.
+        bool Move(int proxy, AlignedBox<N, Real> const& box, Real margin)
+        {
+            LogAssert(IsLeaf(proxy), "Invalid proxy.");
+            if (Contains(mNodes[proxy].box, box))
+            {
+                return false;
+            }
+
+            RemoveLeaf(proxy);
+            mNodes[proxy].box = Enlarge(box, margin);
+            InsertLeaf(proxy);
+            return true;
+        }
+
+        // Member access.
+        inline AlignedBox<N, Real> const& GetBox(int proxy) const
+        {
+            return mNodes[proxy].box;
+        }
+
+        inline int GetUserData(int proxy) const
+        {
+            return mNodes[proxy].userData;
+        }
+
+        inline int GetNumLeaves() const
+        {
+            return mNumLeaves;
+        }
+
+        inline int GetHeight() const
+        {
+            return (mRoot != invalid ? mNodes[mRoot].height : 0);
+        }
+
+        // Call callback(proxy) for each leaf whose box overlaps the input
+        // box. The query stops when the callback returns false. The tree
+        // must not be modified by the callback, but queries may be executed
+        // concurrently.
+        template <typename Callback>
+        void Query(AlignedBox<N, Real> const& box, Callback&& callback) const
+        {
+            if (mRoot == invalid)
+            {
+                return;
+            }
+
+            std::vector<int> stack;
+            stack.reserve(64);
+            stack.push_back(mRoot);
+            while (stack.size() > 0)
+            {
+                int i = stack.back();
+                stack.pop_back();
+                Node const& node = mNodes[i];
+                if (Overlaps(node.box, box))
+                {
+                    if (node.height == 0)
+                    {
+                        if (!callback(i))
+                        {
+                            return;
+                        }
+                    }
+                    else
+                    {
+                        stack.push_back(node.child[0]);
+                        stack.push_back(node.child[1]);
+                    }
+                }
+            }
+        }
+
+        // Box utilities.
+        static bool Overlaps(AlignedBox<N, Real> const& box0, AlignedBox<N, Real> const& box1)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                if (box0.max[i] < box1.min[i] || box1.max[i] < box0.min[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool Contains(AlignedBox<N, Real> const& outer, AlignedBox<N, Real> const& inner)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                if (inner.min[i] < outer.min[i] || outer.max[i] < inner.max[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static AlignedBox<N, Real> Merge(AlignedBox<N, Real> const& box0, AlignedBox<N, Real> const& box1)
+        {
+            AlignedBox<N, Real> merged;
+            for (int i = 0; i < N; ++i)
+            {
+                merged.min[i] = std::min(box0.min[i], box1.min[i]);
+                merged.max[i] = std::max(box0.max[i], box1.max[i]);
+            }
+            return merged;
+        }
+
+        // The surface area of the box up to a factor of 2, which is the sum
+        // of the products of N-1 edge lengths. For N = 2 it is half the
+        // perimeter.
+        static Real Area(AlignedBox<N, Real> const& box)
+        {
+            Real area = (Real)0;
+            for (int i = 0; i < N; ++i)
+            {
+                Real product = (Real)1;
+                for (int j = 0; j < N; ++j)
+                {
+                    if (j != i)
+                    {
+                        product *= box.max[j] - box.min[j];
+                    }
+                }
+                area += product;
+            }
+            return area;
+        }
+
+    private:
+        struct Node
+        {
+            AlignedBox<N, Real> box;
+            int parent;     // or the next free node
+            int child[2];
+            int userData;
+            int height;     // 0 for a leaf, -1 for a free node
+        };
+
+        inline bool IsLeaf(int i) const
+        {
+            return 0 <= i && i < static_cast<int>(mNodes.size()) && mNodes[i].height == 0;
+        }
+
+        static AlignedBox<N, Real> Enlarge(AlignedBox<N, Real> const& box, Real margin)
+        {
+            AlignedBox<N, Real> enlarged;
+            for (int i = 0; i < N; ++i)
+            {
+                enlarged.min[i] = box.min[i] - margin;
+                enlarged.max[i] = box.max[i] + margin;
+            }
+            return enlarged;
+        }
+
+        int AllocateNode()
+        {
+            int i;
+            if (mFreeList != invalid)
+            {
+                i = mFreeList;
+                mFreeList = mNodes[i].parent;
+            }
+            else
+            {
+                i = static_cast<int>(mNodes.size());
+                mNodes.push_back(Node());
+            }
+
+            Node& node = mNodes[i];
+            node.parent = invalid;
+            node.child[0] = invalid;
+            node.child[1] = invalid;
+            node.userData = invalid;
+            node.height = 0;
+            return i;
+        }
+
+        void FreeNode(int i)
+        {
+            mNodes[i].parent = mFreeList;
+            mNodes[i].height = -1;
+            mFreeList = i;
+        }
+
+        void InsertLeaf(int leaf)
+        {
+            if (mRoot == invalid)
+            {
+                mRoot = leaf;
+                mNodes[leaf].parent = invalid;
+                return;
+            }
+
+            // Descend to the sibling of least cost. The cost of making node i
+            // the sibling is the area of the new parent plus the increase of
+            // the areas of the ancestors of i.
+            AlignedBox<N, Real> const leafBox = mNodes[leaf].box;
+            int i = mRoot;
+            while (mNodes[i].height > 0)
+            {
+                Node const& node = mNodes[i];
+                Real const area = Area(node.box);
+                Real const mergedArea = Area(Merge(node.box, leafBox));
+
+                // The cost of creating a new parent of i and the leaf, and
+                // the minimum cost of pushing the leaf further down.
+                Real const cost = (Real)2 * mergedArea;
+                Real const inheritance = (Real)2 * (mergedArea - area);
+
+                Real childCost[2];
+                for (int k = 0; k < 2; ++k)
+                {
+                    Node const& child = mNodes[node.child[k]];
+                    Real const childMergedArea = Area(Merge(child.box, leafBox));
+                    childCost[k] = (child.height == 0 ? childMergedArea :
+                        childMergedArea - Area(child.box)) + inheritance;
+                }
+
+                if (cost < childCost[0] && cost < childCost[1])
+                {
+                    break;
+                }
+                i = node.child[childCost[0] < childCost[1] ? 0 : 1];
+            }
+
+            // Create a parent of the sibling and the leaf.
+            int sibling = i;
+            int oldParent = mNodes[sibling].parent;
+            int newParent = AllocateNode();
+            Node& parent = mNodes[newParent];
+            parent.parent = oldParent;
+            parent.box = Merge(leafBox, mNodes[sibling].box);
+            parent.height = mNodes[sibling].height + 1;
+            parent.child[0] = sibling;
+            parent.child[1] = leaf;
+            mNodes[sibling].parent = newParent;
+            mNodes[leaf].parent = newParent;
+            if (oldParent != invalid)
+            {
+                Node& grandParent = mNodes[oldParent];
+                grandParent.child[grandParent.child[0] == sibling ? 0 : 1] = newParent;
+            }
+            else
+            {
+                mRoot = newParent;
+            }
+
+            Refit(mNodes[leaf].parent);
+        }
+
+        void RemoveLeaf(int leaf)
+        {
+            if (leaf == mRoot)
+            {
+                mRoot = invalid;
+                return;
+            }
+
+            int parent = mNodes[leaf].parent;
+            int grandParent = mNodes[parent].parent;
+            int sibling = mNodes[parent].child[mNodes[parent].child[0] == leaf ? 1 : 0];
+            if (grandParent != invalid)
+            {
+                // Replace the parent by the sibling.
+                Node& node = mNodes[grandParent];
+                node.child[node.child[0] == parent ? 0 : 1] = sibling;
+                mNodes[sibling].parent = grandParent;
+                FreeNode(parent);
+                Refit(grandParent);
+            }
+            else
+            {
+                mRoot = sibling;
+                mNodes[sibling].parent = invalid;
+                FreeNode(parent);
+            }
+        }
+
+        // Rebalance and update the boxes and heights of node i and its
+        // ancestors.
+        void Refit(int i)
+        {
+            while (i != invalid)
+            {
+                i = Balance(i);
+                Node& node = mNodes[i];
+                Node const& child0 = mNodes[node.child[0]];
+                Node const& child1 = mNodes[node.child[1]];
+                node.height = 1 + std::max(child0.height, child1.height);
+                node.box = Merge(child0.box, child1.box);
+                i = node.parent;
+            }
+        }
+
+        // If the subtrees of node a differ in height by more than 1, rotate
+        // the taller child c up to replace a, and return the index of the
+        // node now at the position of a.
+        int Balance(int a)
+        {
+            Node& A = mNodes[a];
+            if (A.height < 2)
+            {
+                return a;
+            }
+
+            int b = A.child[0], c = A.child[1];
+            int balance = mNodes[c].height - mNodes[b].height;
+            if (balance > 1)
+            {
+                return Rotate(a, 1);
+            }
+            if (balance < -1)
+            {
+                return Rotate(a, 0);
+            }
+            return a;
+        }
+
+        // Rotate the child a.child[k] up. Its taller child stays below it
+        // and its shorter child becomes a child of a.
+        int Rotate(int a, int k)
+        {
+            Node& A = mNodes[a];
+            int c = A.child[k];
+            Node& C = mNodes[c];
+            int f = C.child[0], g = C.child[1];
+            Node& F = mNodes[f];
+            Node& G = mNodes[g];
+
+            // Swap a and c.
+            C.child[0] = a;
+            C.parent = A.parent;
+            A.parent = c;
+            if (C.parent != invalid)
+            {
+                Node& P = mNodes[C.parent];
+                P.child[P.child[0] == a ? 0 : 1] = c;
+            }
+            else
+            {
+                mRoot = c;
+            }
+
+            // The taller of f and g stays a child of c.
+            int keep = f, move = g;
+            if (F.height < G.height)
+            {
+                std::swap(keep, move);
+            }
+            C.child[1] = keep;
+            A.child[k] = move;
+            mNodes[move].parent = a;
+
+            Node const& A0 = mNodes[A.child[0]];
+            Node const& A1 = mNodes[A.child[1]];
+            A.box = Merge(A0.box, A1.box);
+            A.height = 1 + std::max(A0.height, A1.height);
+            Node const& K = mNodes[keep];
+            C.box = Merge(A.box, K.box);
+            C.height = 1 + std::max(A.height, K.height);
+            return c;
+        }
+
+        std::vector<Node> mNodes;
+        int mRoot, mFreeList, mNumLeaves;
+    };
+}
@@ -0,0 +1,669 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+// A nearest neighbor query for a point set that changes over time. The
+// NearestNeighborQuery class must be rebuilt when its sites change, whereas
+// this class supports inserting, removing and moving points. The points are
+// stored in a kd-tree whose nodes have axis-aligned bounding boxes, so the
+// queries prune by box distance. A new point is routed to a leaf by the
+// splitting planes, and the leaf is split at its median along the axis of
+// largest extent when it has more than 'maxLeafSize' points. When one child
+// of a node gets more than 3/4 of the node's points, the subtree at the
+// highest such node is rebuilt with median splits. The whole tree is rebuilt
+// when the number of points drops to half of the largest number since the
+// last full rebuild.
+// The bounding boxes are enlarged by insertions but not shrunk by removals;
+// they are recomputed when a subtree is rebuilt.
+//
+// Insert returns an identifier for the point that stays valid until the
+// point is removed. Identifiers of removed points are reused. As in
+// NearestNeighborQuery, the coordinates of the leaf points are stored in
+// structure-of-arrays form so that the distance computations for full
+// blocks of points are fixed-length loops the compiler can vectorize.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class DynamicNearestNeighborQuery
+    {
+    public:
+        // Construction.
+        DynamicNearestNeighborQuery(int maxLeafSize = 16)
+            :
+            mMaxLeafSize(maxLeafSize),
+            mRoot(-1),
+            mNumPoints(0),
+            mRebuildNumPoints(0)
+        {
+            LogAssert(mMaxLeafSize > 0, "Invalid max leaf size.");
+        }
+
+        // Member access.
+        inline int GetMaxLeafSize() const
+        {
+            return mMaxLeafSize;
+        }
+
+        inline int GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline bool IsValid(int id) const
+        {
+            return 0 <= id && id < static_cast<int>(mLeaf.size()) && mLeaf[id] != -1;
+        }
+
+        inline Vector<N, Real> const& GetPosition(int id) const
+        {
+            LogAssert(IsValid(id), "Invalid identifier.");
+            return mPositions[id];
+        }
+
+        // Insert a point and return its identifier.
+        int Insert(Vector<N, Real> const& point)
+        {
+            int id;
+            if (mFreeIds.size() > 0)
+            {
+                id = mFreeIds.back();
+                mFreeIds.pop_back();
+                mPositions[id] = point;
+            }
+            else
+            {
+                id = static_cast<int>(mPositions.size());
+                mPositions.push_back(point);
+                mLeaf.push_back(-1);
+                mSlot.push_back(-1);
+            }
+
+            InsertId(id);
+            ++mNumPoints;
+            mRebuildNumPoints = std::max(mRebuildNumPoints, mNumPoints);
+            return id;
+        }
+
+        // Remove the point with the specified identifier. The function
+        // returns 'false' when the identifier is not valid.
+        bool Remove(int id)
+        {
+            if (!IsValid(id))
+            {
+                return false;
+            }
+
+            RemoveId(id);
+            mFreeIds.push_back(id);
+            --mNumPoints;
+
+            if (mNumPoints == 0)
+            {
+                Clear();
+            }
+            else if (2 * mNumPoints <= mRebuildNumPoints && mNumPoints > mMaxLeafSize)
+            {
+                Rebuild();
+            }
+            return true;
+        }
+
+        // Move the point with the specified identifier. The identifier is
+        // unchanged. The function returns 'false' when the identifier is not
+        // valid.
+        bool Update(int id, Vector<N, Real> const& point)
+        {
+            if (!IsValid(id))
+            {
+                return false;
+            }
+
+            int leaf = mLeaf[id];
+            Node const& node = mNodes[leaf];
+            if (Contains(node, point))
+            {
+                // The point stays in the same leaf.
+                int slot = mSlot[id];
+                mPositions[id] = point;
+                for (int d = 0; d < N; ++d)
+                {
+                    mNodes[leaf].coordinates[d][slot] = point[d];
+                }
+                return true;
+            }
+
+            RemoveId(id);
+            mPositions[id] = point;
+            InsertId(id);
+            return true;
+        }
+
+        // Rebuild the tree with median splits and tight bounding boxes.
+        void Rebuild()
+        {
+            if (mRoot != -1)
+            {
+                RebuildSubtree(mRoot);
+            }
+            mRebuildNumPoints = mNumPoints;
+        }
+
+        // Remove all the points.
+        void Clear()
+        {
+            mPositions.clear();
+            mLeaf.clear();
+            mSlot.clear();
+            mFreeIds.clear();
+            mNodes.clear();
+            mFreeNodes.clear();
+            mRoot = -1;
+            mNumPoints = 0;
+            mRebuildNumPoints = 0;
+        }
+
+        // Compute up to MaxNeighbors nearest neighbors within the specified
+        // radius of the point. The returned integer is the number of
+        // neighbors found, possibly zero. The neighbors array stores point
+        // identifiers sorted by increasing distance.
+        template <int MaxNeighbors>
+        int FindNeighbors(Vector<N, Real> const& point, Real radius, std::array<int, MaxNeighbors>& neighbors) const
+        {
+            static_assert(MaxNeighbors > 0, "Invalid number of neighbors.");
+
+            int numNeighbors = 0;
+            std::array<Real, MaxNeighbors> neighborSqrLength;
+            Real sqrBound = radius * radius;
+            if (mRoot == -1)
+            {
+                return 0;
+            }
+
+            std::vector<int> stack;
+            stack.reserve(64);
+            stack.push_back(mRoot);
+            std::array<Real, msBlockSize> sqrLengths;
+            while (stack.size() > 0)
+            {
+                Node const& node = mNodes[stack.back()];
+                stack.pop_back();
+                if (node.numPoints == 0 || GetSqrDistance(node, point) > sqrBound)
+                {
+                    continue;
+                }
+
+                if (node.left == -1)
+                {
+                    int const numPoints = node.numPoints;
+                    for (int i0 = 0; i0 < numPoints; i0 += msBlockSize)
+                    {
+                        int const numBlock = ComputeSqrLengths(node, point, i0, sqrLengths);
+                        for (int i = 0; i < numBlock; ++i)
+                        {
+                            Real sqrLength = sqrLengths[i];
+                            if (sqrLength <= sqrBound)
+                            {
+                                // Maintain the nearest neighbors sorted by
+                                // distance. The search bound shrinks to the
+                                // last distance once the array is full.
+                                int k = std::min(numNeighbors, MaxNeighbors - 1);
+                                for (; k > 0 && sqrLength < neighborSqrLength[k - 1]; --k)
+                                {
+                                    neighbors[k] = neighbors[k - 1];
+                                    neighborSqrLength[k] = neighborSqrLength[k - 1];
+                                }
+                                neighbors[k] = node.ids[i0 + i];
+                                neighborSqrLength[k] = sqrLength;
+                                if (numNeighbors < MaxNeighbors)
+                                {
+                                    ++numNeighbors;
+                                }
+                                if (numNeighbors == MaxNeighbors)
+                                {
+                                    sqrBound = neighborSqrLength[MaxNeighbors - 1];
+                                }
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    // Visit the nearer child first by pushing it last.
+                    if (point[node.axis] < node.split)
+                    {
+                        stack.push_back(node.right);
+                        stack.push_back(node.left);
+                    }
+                    else
+                    {
+                        stack.push_back(node.left);
+                        stack.push_back(node.right);
+                    }
+                }
+            }
+            return numNeighbors;
+        }
+
+        // Compute all the neighbors within the specified radius of the
+        // point, regardless of their number. The identifiers are not sorted
+        // by distance.
+        void FindAllNeighbors(Vector<N, Real> const& point, Real radius, std::vector<int>& neighbors) const
+        {
+            neighbors.clear();
+            if (mRoot == -1)
+            {
+                return;
+            }
+
+            Real const sqrRadius = radius * radius;
+            std::vector<int> stack;
+            stack.reserve(64);
+            stack.push_back(mRoot);
+            std::array<Real, msBlockSize> sqrLengths;
+            while (stack.size() > 0)
+            {
+                Node const& node = mNodes[stack.back()];
+                stack.pop_back();
+                if (node.numPoints == 0 || GetSqrDistance(node, point) > sqrRadius)
+                {
+                    continue;
+                }
+
+                if (node.left == -1)
+                {
+                    int const numPoints = node.numPoints;
+                    for (int i0 = 0; i0 < numPoints; i0 += msBlockSize)
+                    {
+                        int const numBlock = ComputeSqrLengths(node, point, i0, sqrLengths);
+                        for (int i = 0; i < numBlock; ++i)
+                        {
+                            if (sqrLengths[i] <= sqrRadius)
+                            {
+                                neighbors.push_back(node.ids[i0 + i]);
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    stack.push_back(node.left);
+                    stack.push_back(node.right);
+                }
+            }
+        }
+
+    private:
+        // The leaf points are processed in blocks of this size.
+        enum { msBlockSize = 8 };
+
+        // An interior node has children 'left' and 'right' and routes a
+        // point p to 'left' when p[axis] < split. A leaf node has left and
+        // right equal to -1 and stores the identifiers and coordinates of
+        // its points. The box contains all points of the subtree.
+        struct Node
+        {
+            Node()
+                :
+                min(Vector<N, Real>::Zero()),
+                max(Vector<N, Real>::Zero()),
+                split((Real)0),
+                axis(-1),
+                left(-1),
+                right(-1),
+                parent(-1),
+                numPoints(0)
+            {
+            }
+
+            Vector<N, Real> min, max;
+            Real split;
+            int axis;
+            int left, right, parent;
+            int numPoints;
+            std::vector<int> ids;
+            std::array<std::vector<Real>, N> coordinates;
+        };
+
+        int NewNode(int parent)
+        {
+            int index;
+            if (mFreeNodes.size() > 0)
+            {
+                index = mFreeNodes.back();
+                mFreeNodes.pop_back();
+                mNodes[index] = Node();
+            }
+            else
+            {
+                index = static_cast<int>(mNodes.size());
+                mNodes.push_back(Node());
+            }
+            mNodes[index].parent = parent;
+            return index;
+        }
+
+        static bool Contains(Node const& node, Vector<N, Real> const& point)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                if (point[d] < node.min[d] || point[d] > node.max[d])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static Real GetSqrDistance(Node const& node, Vector<N, Real> const& point)
+        {
+            Real sqrDistance = (Real)0;
+            for (int d = 0; d < N; ++d)
+            {
+                Real diff;
+                if (point[d] < node.min[d])
+                {
+                    diff = node.min[d] - point[d];
+                }
+                else if (point[d] > node.max[d])
+                {
+                    diff = point[d] - node.max[d];
+                }
+                else
+                {
+                    continue;
+                }
+                sqrDistance += diff * diff;
+            }
+            return sqrDistance;
+        }
+
+        // Compute the squared distances from the point to the leaf points
+        // i0 through i0+numBlock-1, where numBlock = min(numPoints - i0,
+        // msBlockSize). Full blocks use a fixed trip count.
+        int ComputeSqrLengths(Node const& node, Vector<N, Real> const& point, int i0,
+            std::array<Real, msBlockSize>& sqrLengths) const
+        {
+            int const numRemaining = node.numPoints - i0;
+            int const numBlock = (numRemaining >= msBlockSize ? msBlockSize : numRemaining);
+            if (numBlock == msBlockSize)
+            {
+                sqrLengths.fill((Real)0);
+                for (int d = 0; d < N; ++d)
+                {
+                    Real const* coordinates = node.coordinates[d].data() + i0;
+                    Real const p = point[d];
+                    for (int i = 0; i < msBlockSize; ++i)
+                    {
+                        Real diff = coordinates[i] - p;
+                        sqrLengths[i] += diff * diff;
+                    }
+                }
+            }
+            else
+            {
+                for (int i = 0; i < numBlock; ++i)
+                {
+                    Real sqrLength = (Real)0;
+                    for (int d = 0; d < N; ++d)
+                    {
+                        Real diff = node.coordinates[d][i0 + i] - point[d];
+                        sqrLength += diff * diff;
+                    }
+                    sqrLengths[i] = sqrLength;
+                }
+            }
+            return numBlock;
+        }
+
+        void AppendToLeaf(int leaf, int id)
+        {
+            Node& node = mNodes[leaf];
+            mLeaf[id] = leaf;
+            mSlot[id] = static_cast<int>(node.ids.size());
+            node.ids.push_back(id);
+            for (int d = 0; d < N; ++d)
+            {
+                node.coordinates[d].push_back(mPositions[id][d]);
+            }
+        }
+
+        void InsertId(int id)
+        {
+            Vector<N, Real> const& point = mPositions[id];
+            if (mRoot == -1)
+            {
+                mRoot = NewNode(-1);
+                mNodes[mRoot].min = point;
+                mNodes[mRoot].max = point;
+            }
+
+            // Route the point to a leaf, enlarging the boxes and counts of
+            // the nodes on the path.
+            int current = mRoot;
+            for (;;)
+            {
+                Node& node = mNodes[current];
+                if (node.numPoints == 0)
+                {
+                    node.min = point;
+                    node.max = point;
+                }
+                else
+                {
+                    for (int d = 0; d < N; ++d)
+                    {
+                        node.min[d] = std::min(node.min[d], point[d]);
+                        node.max[d] = std::max(node.max[d], point[d]);
+                    }
+                }
+                ++node.numPoints;
+
+                if (node.left == -1)
+                {
+                    break;
+                }
+                current = (point[node.axis] < node.split ? node.left : node.right);
+            }
+
+            AppendToLeaf(current, id);
+            int const leaf = current;
+
+            // Rebuild the subtree at the highest unbalanced node on the
+            // path. Otherwise split the leaf when it is too large.
+            int scapegoat = -1;
+            for (int child = leaf, parent = mNodes[leaf].parent; parent != -1;
+                child = parent, parent = mNodes[parent].parent)
+            {
+                Node const& node = mNodes[parent];
+                if (node.numPoints > 2 * mMaxLeafSize &&
+                    4 * mNodes[child].numPoints > 3 * node.numPoints)
+                {
+                    scapegoat = parent;
+                }
+            }
+
+            if (scapegoat != -1)
+            {
+                RebuildSubtree(scapegoat);
+            }
+            else if (mNodes[leaf].numPoints > mMaxLeafSize)
+            {
+                std::vector<int> ids = std::move(mNodes[leaf].ids);
+                Build(leaf, ids.begin(), ids.end());
+            }
+        }
+
+        void RemoveId(int id)
+        {
+            int const leaf = mLeaf[id];
+            int const slot = mSlot[id];
+            Node& node = mNodes[leaf];
+            int const last = node.numPoints - 1;
+            if (slot != last)
+            {
+                int moved = node.ids[last];
+                node.ids[slot] = moved;
+                for (int d = 0; d < N; ++d)
+                {
+                    node.coordinates[d][slot] = node.coordinates[d][last];
+                }
+                mSlot[moved] = slot;
+            }
+            node.ids.pop_back();
+            for (int d = 0; d < N; ++d)
+            {
+                node.coordinates[d].pop_back();
+            }
+
+            for (int current = leaf; current != -1; current = mNodes[current].parent)
+            {
+                --mNodes[current].numPoints;
+            }
+
+            mLeaf[id] = -1;
+            mSlot[id] = -1;
+        }
+
+        void RebuildSubtree(int root)
+        {
+            // Gather the identifiers and release the descendant nodes.
+            std::vector<int> ids;
+            ids.reserve(static_cast<size_t>(mNodes[root].numPoints));
+            std::vector<int> stack;
+            stack.push_back(root);
+            while (stack.size() > 0)
+            {
+                int current = stack.back();
+                stack.pop_back();
+                Node& node = mNodes[current];
+                if (node.left == -1)
+                {
+                    ids.insert(ids.end(), node.ids.begin(), node.ids.end());
+                }
+                else
+                {
+                    stack.push_back(node.left);
+                    stack.push_back(node.right);
+                }
+
+                if (current != root)
+                {
+                    node = Node();
+                    mFreeNodes.push_back(current);
+                }
+            }
+
+            Build(root, ids.begin(), ids.end());
+        }
+
+        // Populate the node with the points [begin,end) split at the median
+        // along the axis of largest extent.
+        void Build(int nodeIndex, std::vector<int>::iterator begin, std::vector<int>::iterator end)
+        {
+            int const parent = mNodes[nodeIndex].parent;
+            mNodes[nodeIndex] = Node();
+            mNodes[nodeIndex].parent = parent;
+
+            Node& node = mNodes[nodeIndex];
+            node.numPoints = static_cast<int>(end - begin);
+            if (node.numPoints == 0)
+            {
+                return;
+            }
+
+            node.min = mPositions[*begin];
+            node.max = node.min;
+            for (auto iter = begin + 1; iter != end; ++iter)
+            {
+                Vector<N, Real> const& point = mPositions[*iter];
+                for (int d = 0; d < N; ++d)
+                {
+                    node.min[d] = std::min(node.min[d], point[d]);
+                    node.max[d] = std::max(node.max[d], point[d]);
+                }
+            }
+
+            int axis = 0;
+            for (int d = 1; d < N; ++d)
+            {
+                if (node.max[d] - node.min[d] > node.max[axis] - node.min[axis])
+                {
+                    axis = d;
+                }
+            }
+
+            if (node.numPoints > mMaxLeafSize && node.max[axis] > node.min[axis])
+            {
+                // The points not less than the median are routed to the
+                // right child, so the median is the smallest point of the
+                // right half. At least one point is less than the largest
+                // value, so both children are nonempty.
+                auto less = [this, axis](int id0, int id1)
+                {
+                    return mPositions[id0][axis] < mPositions[id1][axis];
+                };
+                auto mid = begin + (end - begin) / 2;
+                std::nth_element(begin, mid, end, less);
+                Real split = mPositions[*mid][axis];
+                if (split == node.min[axis])
+                {
+                    // Many points share the minimum value, so split above it.
+                    split = node.max[axis];
+                    for (auto iter = begin; iter != end; ++iter)
+                    {
+                        Real value = mPositions[*iter][axis];
+                        if (value > node.min[axis] && value < split)
+                        {
+                            split = value;
+                        }
+                    }
+                }
+                mid = std::partition(begin, end,
+                    [this, axis, split](int id) { return mPositions[id][axis] < split; });
+
+                node.axis = axis;
+                node.split = split;
+                int left = NewNode(nodeIndex);
+                int right = NewNode(nodeIndex);
+                mNodes[nodeIndex].left = left;
+                mNodes[nodeIndex].right = right;
+                Build(left, begin, mid);
+                Build(right, mid, end);
+            }
+            else
+            {
+                node.ids.reserve(static_cast<size_t>(node.numPoints));
+                for (int d = 0; d < N; ++d)
+                {
+                    node.coordinates[d].reserve(static_cast<size_t>(node.numPoints));
+                }
+                for (auto iter = begin; iter != end; ++iter)
+                {
+                    AppendToLeaf(nodeIndex, *iter);
+                }
+            }
+        }
+
+        int mMaxLeafSize;
+        std::vector<Vector<N, Real>> mPositions;
+        std::vector<int> mLeaf, mSlot, mFreeIds;
+        std::vector<Node> mNodes;
+        std::vector<int> mFreeNodes;
+        int mRoot;
+        int mNumPoints;
+        int mRebuildNumPoints;
+    };
+}
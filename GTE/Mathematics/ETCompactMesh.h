@@ -0,0 +1,594 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/EdgeKey.h>
+#include <Mathematics/TriangleKey.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A manifold triangle mesh with index-based storage, an alternative to
+// ETManifoldMesh for large meshes. ETManifoldMesh allocates an Edge and a
+// Triangle object per element, each stored in a std::unordered_map node,
+// and hashes the keys of the triangle and its edges on every insertion.
+// ETCompactMesh stores the vertex indices and the adjacent triangle indices
+// of the triangles in contiguous arrays, 24 bytes per triangle. The slots
+// of removed triangles are kept on a free list and reused by later
+// insertions. The only hash table is the set of open edges, those edges
+// shared by one triangle, which is used to connect a new triangle to its
+// neighbors. For a mesh of a surface with boundary, after all triangles
+// are inserted, these are the edges of the boundary.
+//
+// The vertex and edge orderings are those of ETManifoldMesh. Edge j of
+// triangle t is <V[j],V[(j+1)%3]> and T[j] is the index of the triangle
+// sharing edge j or -1 when edge j is open. As with ETManifoldMesh,
+// adjacent triangles are not required to have consistent orientations;
+// use IsOriented() to test for this.
+//
+// Create(...) builds the mesh from an index buffer with a single sort of
+// the 3*n half-edges, so no hash table lookups are required for the
+// shared edges. The sort is a linear-time counting sort when the vertex
+// indices are in a range of at most 3*n consecutive integers, which is the
+// case for index buffers. Create(...) detects all nonmanifold edges.
+// Insert(...) detects a nonmanifold edge only when the edge is open. The
+// mesh does not store the edges shared by two triangles, so the insertion
+// of a third triangle at such an edge cannot be detected; the edge becomes
+// open for the new triangle. Insert the triangles of possibly nonmanifold
+// inputs using Create(...).
+
+namespace gte
+{
+    class ETCompactMesh
+    {
+    public:
+        // The open edges are keyed by their unordered vertices. The value
+        // 3*t+j identifies edge j of triangle t.
+        using OpenEdgeMap = std::unordered_map<EdgeKey<false>, int,
+            EdgeKey<false>, EdgeKey<false>>;
+
+        ETCompactMesh()
+            :
+            mNumTriangles(0)
+        {
+        }
+
+        void Clear()
+        {
+            mV.clear();
+            mT.clear();
+            mFree.clear();
+            mOpenEdges.clear();
+            mNumTriangles = 0;
+        }
+
+        // Preallocate storage for the specified number of triangles.
+        void Reserve(size_t numTriangles)
+        {
+            mV.reserve(numTriangles);
+            mT.reserve(numTriangles);
+        }
+
+        // Build the mesh from triangles[] in a single pass. Triangle t of
+        // the mesh is triangles[t]. The function returns 'false' and the
+        // mesh is empty when a triangle is degenerate (has a repeated
+        // vertex), when an edge is shared by more than two triangles or
+        // when a triangle occurs twice with the same ordering.
+        bool Create(size_t numTriangles, std::array<int, 3> const* triangles)
+        {
+            Clear();
+            if (numTriangles == 0)
+            {
+                return true;
+            }
+            if (triangles == nullptr ||
+                numTriangles > static_cast<size_t>(std::numeric_limits<int>::max() / 3))
+            {
+                return false;
+            }
+
+            mV.assign(triangles, triangles + numTriangles);
+            mT.resize(numTriangles);
+            mNumTriangles = static_cast<int>(numTriangles);
+
+            int vmin = std::numeric_limits<int>::max();
+            int vmax = std::numeric_limits<int>::min();
+            for (auto const& V : mV)
+            {
+                if (V[0] == V[1] || V[1] == V[2] || V[2] == V[0])
+                {
+                    Clear();
+                    return false;
+                }
+                vmin = std::min(vmin, std::min(V[0], std::min(V[1], V[2])));
+                vmax = std::max(vmax, std::max(V[0], std::max(V[1], V[2])));
+            }
+
+            if (!(static_cast<int64_t>(vmax) - static_cast<int64_t>(vmin) < 3 * static_cast<int64_t>(numTriangles)
+                ? LinkByBuckets(vmin, vmax) : LinkBySort()))
+            {
+                Clear();
+                return false;
+            }
+            return true;
+        }
+
+        bool Create(std::vector<std::array<int, 3>> const& triangles)
+        {
+            return Create(triangles.size(), triangles.data());
+        }
+
+        // The index buffer has 3*numTriangles elements.
+        bool Create(size_t numTriangles, int const* indices)
+        {
+            static_assert(sizeof(std::array<int, 3>) == 3 * sizeof(int),
+                "Unexpected padding of std::array.");
+            return Create(numTriangles, reinterpret_cast<std::array<int, 3> const*>(indices));
+        }
+
+        // Insert the triangle <v0,v1,v2> and return its index. The insertion
+        // fails when the triangle is degenerate or when it is already in
+        // the mesh with this ordering of vertices and has an open edge, in
+        // which case -1 is returned and the mesh is unchanged.
+        int Insert(int v0, int v1, int v2)
+        {
+            if (v0 == v1 || v1 == v2 || v2 == v0)
+            {
+                return -1;
+            }
+
+            std::array<int, 3> const V = { v0, v1, v2 };
+            std::array<OpenEdgeMap::iterator, 3> iters;
+            for (int j = 0; j < 3; ++j)
+            {
+                iters[j] = mOpenEdges.find(EdgeKey<false>(V[j], V[(j + 1) % 3]));
+            }
+
+            // A triangle that is in the mesh has each of its edges either
+            // open or shared with a triangle other than itself.
+            for (int j = 0; j < 3; ++j)
+            {
+                if (iters[j] != mOpenEdges.end())
+                {
+                    int adj = iters[j]->second / 3;
+                    if (TriangleKey<true>(v0, v1, v2) ==
+                        TriangleKey<true>(mV[adj][0], mV[adj][1], mV[adj][2]))
+                    {
+                        return -1;
+                    }
+                }
+            }
+
+            int t;
+            if (mFree.size() > 0)
+            {
+                t = mFree.back();
+                mFree.pop_back();
+                mV[t] = V;
+            }
+            else
+            {
+                t = static_cast<int>(mV.size());
+                mV.push_back(V);
+                mT.push_back(std::array<int, 3>{});
+            }
+            ++mNumTriangles;
+
+            for (int j = 0; j < 3; ++j)
+            {
+                if (iters[j] != mOpenEdges.end())
+                {
+                    int adj = iters[j]->second / 3;
+                    int k = iters[j]->second % 3;
+                    mT[t][j] = adj;
+                    mT[adj][k] = t;
+                    mOpenEdges.erase(iters[j]);
+                }
+                else
+                {
+                    mT[t][j] = -1;
+                    mOpenEdges.insert(std::make_pair(GetEdgeKey(t, j), 3 * t + j));
+                }
+            }
+            return t;
+        }
+
+        // Remove the triangle with index t. The edges shared with adjacent
+        // triangles become open edges of those triangles.
+        bool Remove(int t)
+        {
+            if (!IsValid(t))
+            {
+                return false;
+            }
+
+            for (int j = 0; j < 3; ++j)
+            {
+                int adj = mT[t][j];
+                if (adj >= 0)
+                {
+                    // Two triangles can share more than one edge, so the
+                    // edge of the adjacent triangle is found by its
+                    // vertices.
+                    int k = GetEdgeIndex(adj, mV[t][j], mV[t][(j + 1) % 3]);
+                    mT[adj][k] = -1;
+                    mOpenEdges.insert(std::make_pair(GetEdgeKey(adj, k), 3 * adj + k));
+                }
+                else
+                {
+                    mOpenEdges.erase(GetEdgeKey(t, j));
+                }
+            }
+
+            mV[t][0] = -1;
+            mV[t][1] = -1;
+            mFree.push_back(t);
+            --mNumTriangles;
+            return true;
+        }
+
+        // Member access. The indices of the triangles are in
+        // [0,GetNumSlots()), where the slots of removed triangles are not
+        // valid.
+        inline int GetNumSlots() const
+        {
+            return static_cast<int>(mV.size());
+        }
+
+        inline int GetNumTriangles() const
+        {
+            return mNumTriangles;
+        }
+
+        inline bool IsValid(int t) const
+        {
+            return 0 <= t && t < static_cast<int>(mV.size()) && mV[t][0] != mV[t][1];
+        }
+
+        inline std::array<int, 3> const& GetVertices(int t) const
+        {
+            return mV[t];
+        }
+
+        inline std::array<int, 3> const& GetAdjacents(int t) const
+        {
+            return mT[t];
+        }
+
+        inline OpenEdgeMap const& GetOpenEdges() const
+        {
+            return mOpenEdges;
+        }
+
+        // The adjacency queries of ETManifoldMesh::Triangle for triangle t.
+        // The edge <u0,u1> is directed. WhichSideOfEdge returns +1 when t
+        // has the edge <u0,u1>, -1 when t has the edge <u1,u0> or 0 when t
+        // has neither edge.
+        int WhichSideOfEdge(int t, int u0, int u1) const
+        {
+            std::array<int, 3> const& V = mV[t];
+            for (int i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+            {
+                if (V[i0] == u0 && V[i1] == u1)
+                {
+                    return +1;
+                }
+                if (V[i0] == u1 && V[i1] == u0)
+                {
+                    return -1;
+                }
+            }
+            return 0;
+        }
+
+        int GetAdjacentOfEdge(int t, int u0, int u1) const
+        {
+            int j = GetEdgeIndex(t, u0, u1);
+            return (j >= 0 ? mT[t][j] : -1);
+        }
+
+        bool GetOppositeVertexOfEdge(int t, int u0, int u1, int& uOpposite) const
+        {
+            int j = GetEdgeIndex(t, u0, u1);
+            if (j >= 0)
+            {
+                uOpposite = mV[t][(j + 2) % 3];
+                return true;
+            }
+            return false;
+        }
+
+        // The index j of the edge <V[j],V[(j+1)%3]> of triangle t whose
+        // unordered vertices are {u0,u1}, or -1 when there is no such edge.
+        int GetEdgeIndex(int t, int u0, int u1) const
+        {
+            std::array<int, 3> const& V = mV[t];
+            for (int j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+            {
+                if ((V[j0] == u0 && V[j1] == u1) || (V[j0] == u1 && V[j1] == u0))
+                {
+                    return j0;
+                }
+            }
+            return -1;
+        }
+
+        // The mesh is closed when each edge is shared by two triangles.
+        inline bool IsClosed() const
+        {
+            return mOpenEdges.size() == 0;
+        }
+
+        // Test whether all triangles in the mesh are oriented consistently
+        // and that no two triangles are coincident. This is the test of
+        // ETManifoldMesh::IsOriented().
+        bool IsOriented() const
+        {
+            int const numSlots = GetNumSlots();
+            for (int t = 0; t < numSlots; ++t)
+            {
+                if (!IsValid(t))
+                {
+                    continue;
+                }
+
+                std::array<int, 3> const& V = mV[t];
+                for (int j = 0; j < 3; ++j)
+                {
+                    int adj = mT[t][j];
+                    if (adj > t)
+                    {
+                        int a = V[j], b = V[(j + 1) % 3];
+                        int uOpposite = -1;
+                        bool found = GetOppositeVertexOfEdge(adj, a, b, uOpposite);
+                        (void)found;
+                        if (WhichSideOfEdge(adj, b, a) != +1 || uOpposite == V[(j + 2) % 3])
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Compute the connected components of the edge-triangle graph. Each
+        // component is an array of triangle indices.
+        void GetComponents(std::vector<std::vector<int>>& components) const
+        {
+            components.clear();
+            int const numSlots = GetNumSlots();
+            std::vector<uint8_t> visited(static_cast<size_t>(numSlots), 0);
+            std::vector<int> stack;
+            for (int t = 0; t < numSlots; ++t)
+            {
+                if (visited[t] == 0 && IsValid(t))
+                {
+                    std::vector<int> component;
+                    visited[t] = 1;
+                    stack.push_back(t);
+                    while (stack.size() > 0)
+                    {
+                        int current = stack.back();
+                        stack.pop_back();
+                        component.push_back(current);
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            int adj = mT[current][j];
+                            if (adj >= 0 && visited[adj] == 0)
+                            {
+                                visited[adj] = 1;
+                                stack.push_back(adj);
+                            }
+                        }
+                    }
+                    components.push_back(std::move(component));
+                }
+            }
+        }
+
+        // Create the compact graph of ETManifoldMesh::CreateCompactGraph,
+        // which can be passed to ETManifoldMesh::
+        // GetComponentsConsistentChirality. The valid triangles are listed
+        // in increasing order of their indices, so the output is the same
+        // as the mesh itself when no triangles were removed. An open edge
+        // has adjacent std::numeric_limits<size_t>::max().
+        void CreateCompactGraph(
+            std::vector<std::array<size_t, 3>>& triangles,
+            std::vector<std::array<size_t, 3>>& adjacents) const
+        {
+            size_t const invalid = std::numeric_limits<size_t>::max();
+            int const numSlots = GetNumSlots();
+            std::vector<size_t> compact(static_cast<size_t>(numSlots), invalid);
+            size_t index = 0;
+            for (int t = 0; t < numSlots; ++t)
+            {
+                if (IsValid(t))
+                {
+                    compact[t] = index++;
+                }
+            }
+
+            triangles.resize(index);
+            adjacents.resize(index);
+            for (int t = 0; t < numSlots; ++t)
+            {
+                if (IsValid(t))
+                {
+                    size_t i = compact[t];
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        triangles[i][j] = static_cast<size_t>(mV[t][j]);
+                        adjacents[i][j] = (mT[t][j] >= 0 ? compact[mT[t][j]] : invalid);
+                    }
+                }
+            }
+        }
+
+    private:
+        // Connect the two half-edges of each shared edge and insert the
+        // open edges into mOpenEdges. The half-edges are distributed to the
+        // buckets of their minimum vertices by a counting sort. The
+        // half-edges of an edge are in the same bucket and are matched by
+        // their maximum vertices using arrays indexed by vertex.
+        bool LinkByBuckets(int vmin, int vmax)
+        {
+            int const numHalfEdges = 3 * mNumTriangles;
+            size_t const range = static_cast<size_t>(static_cast<int64_t>(vmax) - vmin + 1);
+            std::vector<int> offsets(range + 1, 0);
+            for (auto const& V : mV)
+            {
+                for (int j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                {
+                    ++offsets[std::min(V[j0], V[j1]) - vmin + 1];
+                }
+            }
+            for (size_t i = 1; i <= range; ++i)
+            {
+                offsets[i] += offsets[i - 1];
+            }
+
+            std::vector<int> buckets(static_cast<size_t>(numHalfEdges));
+            std::vector<int> next(offsets.begin(), offsets.end() - 1);
+            for (int h = 0; h < numHalfEdges; ++h)
+            {
+                std::array<int, 3> const& V = mV[h / 3];
+                int j = h % 3;
+                buckets[next[std::min(V[j], V[(j + 1) % 3]) - vmin]++] = h;
+            }
+            next.clear();
+            next.shrink_to_fit();
+
+            // first[v] and second[v] are the half-edges of the current
+            // bucket whose maximum vertex is v.
+            std::vector<int> first(range, -1), second(range, -1);
+            for (size_t i = 0; i < range; ++i)
+            {
+                int const b0 = offsets[i], b1 = offsets[i + 1];
+                for (int b = b0; b < b1; ++b)
+                {
+                    int h = buckets[b];
+                    int v = GetMaxVertex(h) - vmin;
+                    if (first[v] < 0)
+                    {
+                        first[v] = h;
+                    }
+                    else if (second[v] < 0)
+                    {
+                        second[v] = h;
+                    }
+                    else
+                    {
+                        // The edge is nonmanifold.
+                        return false;
+                    }
+                }
+
+                for (int b = b0; b < b1; ++b)
+                {
+                    int h = buckets[b];
+                    int v = GetMaxVertex(h) - vmin;
+                    if (first[v] == h)
+                    {
+                        bool linked = Link(first[v], second[v]);
+                        first[v] = -1;
+                        second[v] = -1;
+                        if (!linked)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        // The same as LinkByBuckets, but with a comparison sort of the
+        // half-edges for vertex indices in large ranges.
+        bool LinkBySort()
+        {
+            int const numHalfEdges = 3 * mNumTriangles;
+            std::vector<std::pair<uint64_t, int>> halfEdges(static_cast<size_t>(numHalfEdges));
+            for (int h = 0; h < numHalfEdges; ++h)
+            {
+                std::array<int, 3> const& V = mV[h / 3];
+                int v0 = V[h % 3], v1 = V[(h % 3 + 1) % 3];
+                uint64_t u0 = static_cast<uint32_t>(std::min(v0, v1));
+                uint64_t u1 = static_cast<uint32_t>(std::max(v0, v1));
+                halfEdges[h] = std::make_pair((u0 << 32) | u1, h);
+            }
+            std::sort(halfEdges.begin(), halfEdges.end());
+
+            for (int i0 = 0; i0 < numHalfEdges; )
+            {
+                int i1 = i0 + 1;
+                while (i1 < numHalfEdges && halfEdges[i1].first == halfEdges[i0].first)
+                {
+                    ++i1;
+                }
+
+                if (i1 > i0 + 2)
+                {
+                    // The edge is nonmanifold.
+                    return false;
+                }
+
+                if (!Link(halfEdges[i0].second, (i1 == i0 + 2 ? halfEdges[i0 + 1].second : -1)))
+                {
+                    return false;
+                }
+                i0 = i1;
+            }
+            return true;
+        }
+
+        // Connect the half-edges h0 and h1 of an edge, or make h0 an open
+        // edge when h1 is -1. The function returns 'false' when the two
+        // triangles are duplicates, which is the case when they have the
+        // same ordered vertices.
+        bool Link(int h0, int h1)
+        {
+            int t0 = h0 / 3, j0 = h0 % 3;
+            if (h1 < 0)
+            {
+                mT[t0][j0] = -1;
+                mOpenEdges.insert(std::make_pair(GetEdgeKey(t0, j0), h0));
+                return true;
+            }
+
+            int t1 = h1 / 3, j1 = h1 % 3;
+            if (mV[t0][j0] == mV[t1][j1] && mV[t0][(j0 + 2) % 3] == mV[t1][(j1 + 2) % 3])
+            {
+                return false;
+            }
+            mT[t0][j0] = t1;
+            mT[t1][j1] = t0;
+            return true;
+        }
+
+        inline int GetMaxVertex(int h) const
+        {
+            std::array<int, 3> const& V = mV[h / 3];
+            return std::max(V[h % 3], V[(h % 3 + 1) % 3]);
+        }
+
+        EdgeKey<false> GetEdgeKey(int t, int j) const
+        {
+            return EdgeKey<false>(mV[t][j], mV[t][(j + 1) % 3]);
+        }
+
+        std::vector<std::array<int, 3>> mV, mT;
+        std::vector<int> mFree;
+        OpenEdgeMap mOpenEdges;
+        int mNumTriangles;
+    };
+}
@@ -3,14 +3,19 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/EdgeKey.h>
 #include <Mathematics/HashCombine.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/TriangleKey.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
 #include <queue>
@@ -133,7 +138,8 @@ namespace gte
             :
             mECreator(eCreator ? eCreator : CreateEdge),
             mTCreator(tCreator ? tCreator : CreateTriangle),
-            mThrowOnNonmanifoldInsertion(true)
+            mThrowOnNonmanifoldInsertion(true),
+            mRetainCapacity(false)
         {
         }
 
@@ -141,6 +147,11 @@ namespace gte
         // have dynamically allocated memory for edges and triangles.  A
         // shallow copy of the pointers isn't possible with unique_ptr.
         ETManifoldMesh(ETManifoldMesh const& mesh)
+            :
+            mECreator(mesh.mECreator),
+            mTCreator(mesh.mTCreator),
+            mThrowOnNonmanifoldInsertion(true),
+            mRetainCapacity(false)
         {
             *this = mesh;
         }
@@ -149,9 +160,16 @@ namespace gte
         {
             Clear();
 
+            if (mECreator != mesh.mECreator || mTCreator != mesh.mTCreator)
+            {
+                // The kept objects were created by the previous creators.
+                mEFree.clear();
+                mTFree.clear();
+            }
             mECreator = mesh.mECreator;
             mTCreator = mesh.mTCreator;
             mThrowOnNonmanifoldInsertion = mesh.mThrowOnNonmanifoldInsertion;
+            RetainCapacity(mesh.mRetainCapacity);
             for (auto const& element : mesh.mTMap)
             {
                 // The typecast avoids warnings about not storing the return
@@ -184,6 +202,60 @@ namespace gte
             return doException;  // return the previous state
         }
 
+        // Support for building, clearing and rebuilding a mesh many times,
+        // which is what functors such as Delaunay2 and ConvexHull3 do for
+        // each data set. When the capacity is retained, Remove() and Clear()
+        // keep the removed edge and triangle objects for reuse by Insert()
+        // instead of deleting them. Only the objects of the default creators
+        // are reused because those of user-specified creators can have
+        // additional state. Clear() does not release the hash-table buckets
+        // in either case. Disabling the retention deletes the kept objects.
+        // The default is not to retain the capacity.
+        virtual void RetainCapacity(bool retain)
+        {
+            mRetainCapacity = retain;
+            if (!retain)
+            {
+                mEFree.clear();
+                mEFree.shrink_to_fit();
+                mTFree.clear();
+                mTFree.shrink_to_fit();
+            }
+        }
+
+        inline bool RetainsCapacity() const
+        {
+            return mRetainCapacity;
+        }
+
+        // Allocate the hash-table buckets for the specified numbers of edges
+        // and triangles so that Insert() does not rehash. A triangulation of
+        // n points has fewer than 2*n triangles and 3*n edges.
+        void Reserve(size_t numEdges, size_t numTriangles)
+        {
+            mEMap.reserve(numEdges);
+            mTMap.reserve(numTriangles);
+        }
+
+        // Build the mesh from an index buffer of numTriangles triangles
+        // <indices[3*t],indices[3*t+1],indices[3*t+2]>. The mesh is the same
+        // as the one obtained by Clear() followed by Insert(...) of the
+        // triangles in buffer order, including the duplicate triangles
+        // being ignored. The shared edges are matched by sorting the
+        // edges instead of by hash-table lookups, and the sorting and the
+        // linking of the edges and triangles are partitioned among
+        // numThreads threads, which are tasks of the scheduler when it is not
+        // null. If the mesh would be nonmanifold, the mesh is
+        // cleared and then an exception is thrown or, when exceptions are
+        // disabled by ThrowOnNonmanifoldInsertion(false), 'false' is
+        // returned.
+        virtual bool Create(size_t numTriangles, int const* indices, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            std::vector<Triangle*> triangles;
+            return CreateEdgesAndTriangles(numTriangles, indices, numThreads, scheduler, triangles);
+        }
+
         // If <v0,v1,v2> is not in the mesh, a Triangle object is created and
         // returned; otherwise, <v0,v1,v2> is in the mesh and nullptr is
         // returned.  If the insertion leads to a nonmanifold mesh, the call
@@ -202,7 +274,7 @@ namespace gte
             // of the function so that if an assertion is triggered and the
             // function returns early, the (bad) triangle will not be part of
             // the mesh.
-            std::unique_ptr<Triangle> newTri = mTCreator(v0, v1, v2);
+            std::unique_ptr<Triangle> newTri = AcquireTriangle(v0, v1, v2);
             Triangle* tri = newTri.get();
 
             // Add the edges to the mesh if they do not already exist.
@@ -214,7 +286,7 @@ namespace gte
                 if (eiter == mEMap.end())
                 {
                     // This is the first time the edge is encountered.
-                    std::unique_ptr<Edge> newEdge = mECreator(tri->V[i0], tri->V[i1]);
+                    std::unique_ptr<Edge> newEdge = AcquireEdge(tri->V[i0], tri->V[i1]);
                     edge = newEdge.get();
                     mEMap[ekey] = std::move(newEdge);
 
@@ -305,8 +377,9 @@ namespace gte
                 // Remove the edge if you have the last reference to it.
                 if (!edge->T[0] && !edge->T[1])
                 {
-                    EdgeKey<false> ekey(edge->V[0], edge->V[1]);
-                    mEMap.erase(ekey);
+                    auto eiter = mEMap.find(EdgeKey<false>(edge->V[0], edge->V[1]));
+                    ReleaseEdge(eiter->second);
+                    mEMap.erase(eiter);
                 }
 
                 // Inform adjacent triangles the triangle is being deleted.
@@ -324,13 +397,26 @@ namespace gte
                 }
             }
 
-            mTMap.erase(tkey);
+            ReleaseTriangle(titer->second);
+            mTMap.erase(titer);
             return true;
         }
 
-        // Destroy the edges and triangles to obtain an empty mesh.
+        // Destroy the edges and triangles to obtain an empty mesh. When the
+        // capacity is retained, the objects are kept for reuse.
         virtual void Clear()
         {
+            if (mRetainCapacity)
+            {
+                for (auto& element : mEMap)
+                {
+                    ReleaseEdge(element.second);
+                }
+                for (auto& element : mTMap)
+                {
+                    ReleaseTriangle(element.second);
+                }
+            }
             mEMap.clear();
             mTMap.clear();
         }
@@ -482,9 +568,15 @@ namespace gte
         // std::numeric_limits<size_t>::max()). Similar assignments are made
         // for the other two edges which produces A[0][1] for E[1] and
         // A[0][2] for E[2].
+        //
+        // The triangle indices are looked up in an open-addressing hash
+        // table of the triangle pointers, and the arrays are filled by
+        // numThreads threads, which are tasks of the scheduler when it is
+        // not null.
         void CreateCompactGraph(
             std::vector<std::array<size_t, 3>>& triangles,
-            std::vector<std::array<size_t, 3>>& adjacents) const
+            std::vector<std::array<size_t, 3>>& adjacents,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
         {
             size_t const numTriangles = mTMap.size();
             LogAssert(numTriangles > 0, "Invalid input.");
@@ -492,26 +584,149 @@ namespace gte
             triangles.resize(numTriangles);
             adjacents.resize(numTriangles);
 
-            TrianglePtrSizeTMap triIndexMap;
-            triIndexMap.insert(std::make_pair(nullptr, std::numeric_limits<size_t>::max()));
+            // The table size is a power of two that is at least twice the
+            // number of triangles, so the linear probing is short.
+            size_t mask = 1;
+            while (mask < 2 * numTriangles)
+            {
+                mask <<= 1;
+            }
+            --mask;
+            auto getSlot = [mask](Triangle const* tri)
+            {
+                uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(tri));
+                return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+            };
+
+            std::vector<Triangle const*> triPtrs(numTriangles);
+            std::vector<std::pair<Triangle const*, size_t>> triIndices(mask + 1,
+                std::make_pair(nullptr, std::numeric_limits<size_t>::max()));
             size_t index = 0;
             for (auto const& element : mTMap)
             {
-                triIndexMap.insert(std::make_pair(element.second.get(), index++));
+                Triangle const* tri = element.second.get();
+                size_t slot = getSlot(tri);
+                while (triIndices[slot].first)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                triIndices[slot] = std::make_pair(tri, index);
+                triPtrs[index++] = tri;
             }
 
-            index = 0;
-            for (auto const& element : mTMap)
+            size_t const numChunks = std::max(std::min(numThreads, numTriangles), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [&triPtrs, &triIndices, &triangles, &adjacents, &getSlot, mask, numTriangles, numChunks](size_t c)
             {
-                auto const& triPtr = element.second;
-                auto& tri = triangles[index];
-                auto& adj = adjacents[index];
-                for (size_t j = 0; j < 3; ++j)
+                size_t const tmin = numTriangles * c / numChunks;
+                size_t const tmax = numTriangles * (c + 1) / numChunks;
+                for (size_t t = tmin; t < tmax; ++t)
                 {
-                    tri[j] = triPtr->V[j];
-                    adj[j] = triIndexMap[triPtr->T[j]];
+                    Triangle const* tri = triPtrs[t];
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        triangles[t][j] = tri->V[j];
+                        adjacents[t][j] = std::numeric_limits<size_t>::max();
+                        if (tri->T[j])
+                        {
+                            size_t slot = getSlot(tri->T[j]);
+                            while (triIndices[slot].first != tri->T[j])
+                            {
+                                slot = (slot + 1) & mask;
+                            }
+                            adjacents[t][j] = triIndices[slot].second;
+                        }
+                    }
                 }
-                ++index;
+            });
+        }
+
+        // Compute the connected components of the compact graph produced by
+        // CreateCompactGraph(...). The output has the format of that of
+        // GetComponentsConsistentChirality(...), but the triangles are not
+        // modified. The components are ordered by their smallest triangle
+        // index and the triangles of a component are listed in increasing
+        // order. The labeling uses a lock-free union-find of the triangles
+        // shared by numThreads threads, which are tasks of the scheduler when
+        // it is not null.
+        static void GetComponents(
+            std::vector<std::array<size_t, 3>> const& adjacents,
+            std::vector<size_t>& components,
+            std::vector<size_t>& numComponentTriangles,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            size_t const numTriangles = adjacents.size();
+            components.clear();
+            numComponentTriangles.clear();
+            if (numTriangles == 0)
+            {
+                return;
+            }
+
+            // The root of a set is its smallest triangle index.
+            std::vector<std::atomic<size_t>> parents(numTriangles);
+            size_t const numChunks = std::max(std::min(numThreads, numTriangles), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks, [&parents, numTriangles, numChunks](size_t c)
+            {
+                size_t const tmin = numTriangles * c / numChunks;
+                size_t const tmax = numTriangles * (c + 1) / numChunks;
+                for (size_t t = tmin; t < tmax; ++t)
+                {
+                    parents[t] = t;
+                }
+            });
+
+            TaskScheduler::ParallelFor(scheduler, numChunks, [&adjacents, &parents, numTriangles, numChunks](size_t c)
+            {
+                size_t const tmin = numTriangles * c / numChunks;
+                size_t const tmax = numTriangles * (c + 1) / numChunks;
+                for (size_t t = tmin; t < tmax; ++t)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        size_t a = adjacents[t][j];
+                        if (a > t && a != std::numeric_limits<size_t>::max())
+                        {
+                            Union(parents, t, a);
+                        }
+                    }
+                }
+            });
+
+            std::vector<size_t> roots(numTriangles);
+            TaskScheduler::ParallelFor(scheduler, numChunks, [&parents, &roots, numTriangles, numChunks](size_t c)
+            {
+                size_t const tmin = numTriangles * c / numChunks;
+                size_t const tmax = numTriangles * (c + 1) / numChunks;
+                for (size_t t = tmin; t < tmax; ++t)
+                {
+                    roots[t] = Find(parents, t);
+                }
+            });
+
+            // Map the roots to component indices, count the triangles of
+            // the components and distribute the triangles.
+            std::vector<size_t> labels(numTriangles);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                if (roots[t] == t)
+                {
+                    labels[t] = numComponentTriangles.size();
+                    numComponentTriangles.push_back(0);
+                }
+                ++numComponentTriangles[labels[roots[t]]];
+            }
+
+            std::vector<size_t> offsets(numComponentTriangles.size(), 0);
+            for (size_t c = 1; c < offsets.size(); ++c)
+            {
+                offsets[c] = offsets[c - 1] + numComponentTriangles[c - 1];
+            }
+
+            components.resize(numTriangles);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                components[offsets[labels[roots[t]]]++] = t;
             }
         }
 
@@ -956,6 +1171,263 @@ namespace gte
         TMap mTMap;
         bool mThrowOnNonmanifoldInsertion;  // default: true
 
+        // Reuse of the edge and triangle objects when the capacity is
+        // retained.
+        std::unique_ptr<Edge> AcquireEdge(int v0, int v1)
+        {
+            if (mEFree.size() > 0)
+            {
+                std::unique_ptr<Edge> edge = std::move(mEFree.back());
+                mEFree.pop_back();
+                edge->V = { v0, v1 };
+                edge->T.fill(nullptr);
+                return edge;
+            }
+            return mECreator(v0, v1);
+        }
+
+        std::unique_ptr<Triangle> AcquireTriangle(int v0, int v1, int v2)
+        {
+            if (mTFree.size() > 0)
+            {
+                std::unique_ptr<Triangle> tri = std::move(mTFree.back());
+                mTFree.pop_back();
+                tri->V = { v0, v1, v2 };
+                tri->E.fill(nullptr);
+                tri->T.fill(nullptr);
+                return tri;
+            }
+            return mTCreator(v0, v1, v2);
+        }
+
+        void ReleaseEdge(std::unique_ptr<Edge>& edge)
+        {
+            if (mRetainCapacity && mECreator == CreateEdge)
+            {
+                mEFree.push_back(std::move(edge));
+            }
+        }
+
+        void ReleaseTriangle(std::unique_ptr<Triangle>& tri)
+        {
+            if (mRetainCapacity && mTCreator == CreateTriangle)
+            {
+                mTFree.push_back(std::move(tri));
+            }
+        }
+
+        bool mRetainCapacity;  // default: false
+        std::vector<std::unique_ptr<Edge>> mEFree;
+        std::vector<std::unique_ptr<Triangle>> mTFree;
+
+        // Support for Create(...). The triangles that are not duplicates are
+        // returned in buffer order, which derived classes use to build
+        // their own adjacency information.
+        using SortElement = std::pair<uint64_t, size_t>;
+
+        bool CreateEdgesAndTriangles(size_t numTriangles, int const* indices,
+            size_t numThreads, TaskScheduler* scheduler, std::vector<Triangle*>& triangles)
+        {
+            LogAssert(numTriangles == 0 || indices != nullptr, "Invalid input.");
+
+            Clear();
+            triangles.clear();
+
+            // Create the triangles, ignoring the duplicates.
+            mTMap.reserve(numTriangles);
+            triangles.reserve(numTriangles);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                int const* v = &indices[3 * t];
+                auto result = mTMap.emplace(TriangleKey<true>(v[0], v[1], v[2]), nullptr);
+                if (result.second)
+                {
+                    result.first->second = AcquireTriangle(v[0], v[1], v[2]);
+                    triangles.push_back(result.first->second.get());
+                }
+            }
+
+            // Sort the half-edges h = 3*t+i, where half-edge i of
+            // triangles[t] is <V[i],V[(i+1)%3]>, by their unordered
+            // vertices. The half-edges of an edge are contiguous and in
+            // triangle order.
+            size_t const numUnique = triangles.size();
+            size_t const numHalfEdges = 3 * numUnique;
+            std::vector<SortElement> halfEdges(numHalfEdges);
+            size_t numChunks = std::max(std::min(numThreads, numUnique), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks, [&triangles, &halfEdges, numUnique, numChunks](size_t c)
+            {
+                size_t const tmin = numUnique * c / numChunks;
+                size_t const tmax = numUnique * (c + 1) / numChunks;
+                for (size_t t = tmin, h = 3 * tmin; t < tmax; ++t)
+                {
+                    auto const& V = triangles[t]->V;
+                    for (size_t i0 = 0, i1 = 1; i0 < 3; ++i0, ++h, i1 = (i1 + 1) % 3)
+                    {
+                        uint64_t u0 = static_cast<uint32_t>(std::min(V[i0], V[i1]));
+                        uint64_t u1 = static_cast<uint32_t>(std::max(V[i0], V[i1]));
+                        halfEdges[h] = std::make_pair((u0 << 32) | u1, h);
+                    }
+                }
+            });
+            SortElements(numThreads, scheduler, halfEdges);
+
+            // Locate the edges, each a range [groups[e],groups[e+1]) of
+            // sorted half-edges.
+            std::vector<size_t> groups;
+            groups.reserve(numHalfEdges / 2 + 1);
+            for (size_t i0 = 0; i0 < numHalfEdges; )
+            {
+                size_t i1 = i0 + 1;
+                while (i1 < numHalfEdges && halfEdges[i1].first == halfEdges[i0].first)
+                {
+                    ++i1;
+                }
+
+                if (i1 > i0 + 2)
+                {
+                    Clear();
+                    triangles.clear();
+                    if (mThrowOnNonmanifoldInsertion)
+                    {
+                        LogError("Attempt to create nonmanifold mesh.");
+                    }
+                    return false;
+                }
+
+                groups.push_back(i0);
+                i0 = i1;
+            }
+            groups.push_back(numHalfEdges);
+
+            // Create the edges. The vertex order of an edge is that of its
+            // first triangle, as it is for Insert(...).
+            size_t const numEdges = groups.size() - 1;
+            std::vector<Edge*> edges(numEdges);
+            mEMap.reserve(numEdges);
+            for (size_t e = 0; e < numEdges; ++e)
+            {
+                size_t h = halfEdges[groups[e]].second;
+                auto const& V = triangles[h / 3]->V;
+                int v0 = V[h % 3], v1 = V[(h % 3 + 1) % 3];
+                std::unique_ptr<Edge> newEdge = AcquireEdge(v0, v1);
+                edges[e] = newEdge.get();
+                mEMap.emplace(EdgeKey<false>(v0, v1), std::move(newEdge));
+            }
+
+            // Link the edges and triangles. Each (triangle, index) slot is
+            // written by exactly one edge.
+            numChunks = std::max(std::min(numThreads, numEdges), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [&triangles, &halfEdges, &groups, &edges, numEdges, numChunks](size_t c)
+            {
+                size_t const emin = numEdges * c / numChunks;
+                size_t const emax = numEdges * (c + 1) / numChunks;
+                for (size_t e = emin; e < emax; ++e)
+                {
+                    Edge* edge = edges[e];
+                    size_t h0 = halfEdges[groups[e]].second;
+                    Triangle* tri0 = triangles[h0 / 3];
+                    edge->T[0] = tri0;
+                    tri0->E[h0 % 3] = edge;
+                    if (groups[e + 1] == groups[e] + 2)
+                    {
+                        size_t h1 = halfEdges[groups[e] + 1].second;
+                        Triangle* tri1 = triangles[h1 / 3];
+                        edge->T[1] = tri1;
+                        tri1->E[h1 % 3] = edge;
+                        tri0->T[h0 % 3] = tri1;
+                        tri1->T[h1 % 3] = tri0;
+                    }
+                }
+            });
+            return true;
+        }
+
+        // Sort blocks of the elements concurrently and then merge pairs of
+        // adjacent blocks concurrently until one block remains.
+        static void SortElements(size_t numThreads, TaskScheduler* scheduler,
+            std::vector<SortElement>& elements)
+        {
+            size_t const numElements = elements.size();
+            size_t const numBlocks = std::max(std::min(numThreads, numElements / 2), static_cast<size_t>(1));
+            std::vector<size_t> bounds(numBlocks + 1);
+            for (size_t b = 0; b <= numBlocks; ++b)
+            {
+                bounds[b] = numElements * b / numBlocks;
+            }
+
+            auto begin = elements.begin();
+            TaskScheduler::ParallelFor(scheduler, numBlocks, [&bounds, begin](size_t b)
+            {
+                std::sort(begin + bounds[b], begin + bounds[b + 1]);
+            });
+
+            while (bounds.size() > 2)
+            {
+                size_t const numMerges = (bounds.size() - 1) / 2;
+                TaskScheduler::ParallelFor(scheduler, numMerges, [&bounds, begin](size_t m)
+                {
+                    std::inplace_merge(begin + bounds[2 * m],
+                        begin + bounds[2 * m + 1], begin + bounds[2 * m + 2]);
+                });
+
+                std::vector<size_t> merged;
+                merged.reserve(numMerges + 2);
+                for (size_t b = 0; b < bounds.size(); b += 2)
+                {
+                    merged.push_back(bounds[b]);
+                }
+                if (merged.back() != numElements)
+                {
+                    merged.push_back(numElements);
+                }
+                bounds = std::move(merged);
+            }
+        }
+
+        // Support for the parallel union-find of GetComponents(...). Find
+        // uses path halving. Union links the larger root to the smaller
+        // root, retrying when another thread has changed the root.
+        static size_t Find(std::vector<std::atomic<size_t>>& parents, size_t t)
+        {
+            size_t parent = parents[t].load();
+            while (parent != t)
+            {
+                size_t grandparent = parents[parent].load();
+                if (grandparent != parent)
+                {
+                    size_t expected = parent;
+                    parents[t].compare_exchange_weak(expected, grandparent);
+                }
+                t = parent;
+                parent = grandparent;
+            }
+            return t;
+        }
+
+        static void Union(std::vector<std::atomic<size_t>>& parents, size_t t0, size_t t1)
+        {
+            for (;;)
+            {
+                t0 = Find(parents, t0);
+                t1 = Find(parents, t1);
+                if (t0 == t1)
+                {
+                    return;
+                }
+                if (t0 < t1)
+                {
+                    std::swap(t0, t1);
+                }
+                size_t expected = t0;
+                if (parents[t0].compare_exchange_strong(expected, t1))
+                {
+                    return;
+                }
+            }
+        }
+
         // Support for computing connected components.  This is a
         // straightforward depth-first search of the graph but uses a
         // preallocated stack rather than a recursive function that could
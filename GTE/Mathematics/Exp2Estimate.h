@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Minimax polynomial approximations to 2^x.  The polynomial p(x) of
 // degree D minimizes the quantity maximum{|2^x - p(x)| : x in [0,1]}
@@ -43,31 +44,71 @@ namespace gte
             return result;
         }
 
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        // The range reduction of the SIMD versions requires the integer part
+        // of x to be smaller than 2^31 in magnitude.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Evaluate(degree<D>(), x);
+        }
+
+        template <int D>
+        inline static SIMD4Value<Real> DegreeRR(SIMD4Value<Real> const& x)
+        {
+            typedef SIMD4Value<Real> V;
+            V p = V::Floor(x);
+            V y = x - p;
+            V poly = Degree<D>(y);
+            return V::LdExp(poly, p);
+        }
+
+        // Evaluate the estimates for arrays, result[i] = Degree<D>(x[i]) or
+        // result[i] = DegreeRR<D>(x[i]), 4 elements at a time. The arrays
+        // may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
+        template <int D>
+        static void DegreeRR(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return DegreeRR<D>(v); });
+        }
+
     private:
         // Metaprogramming and private implementation to allow specialization
         // of a template member function.
         template <int D> struct degree {};
 
-        inline static Real Evaluate(degree<1>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<1>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG1_C1;
             poly = (Real)GTE_C_EXP2_DEG1_C0 + poly * t;
             return poly;
         }
 
-        inline static Real Evaluate(degree<2>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<2>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG2_C2;
             poly = (Real)GTE_C_EXP2_DEG2_C1 + poly * t;
             poly = (Real)GTE_C_EXP2_DEG2_C0 + poly * t;
             return poly;
         }
 
-        inline static Real Evaluate(degree<3>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<3>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG3_C3;
             poly = (Real)GTE_C_EXP2_DEG3_C2 + poly * t;
             poly = (Real)GTE_C_EXP2_DEG3_C1 + poly * t;
@@ -75,9 +116,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<4>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<4>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG4_C4;
             poly = (Real)GTE_C_EXP2_DEG4_C3 + poly * t;
             poly = (Real)GTE_C_EXP2_DEG4_C2 + poly * t;
@@ -86,9 +128,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<5>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<5>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG5_C5;
             poly = (Real)GTE_C_EXP2_DEG5_C4 + poly * t;
             poly = (Real)GTE_C_EXP2_DEG5_C3 + poly * t;
@@ -98,9 +141,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<6>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<6>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG6_C6;
             poly = (Real)GTE_C_EXP2_DEG6_C5 + poly * t;
             poly = (Real)GTE_C_EXP2_DEG6_C4 + poly * t;
@@ -111,9 +155,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<7>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<7>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_EXP2_DEG7_C7;
             poly = (Real)GTE_C_EXP2_DEG7_C6 + poly * t;
             poly = (Real)GTE_C_EXP2_DEG7_C5 + poly * t;
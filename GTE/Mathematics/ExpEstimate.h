@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.12.23
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -27,7 +27,7 @@ namespace gte
         template <int D>
         inline static Real Degree(Real x)
         {
-            return Exp2Estimate<Real>::Degree<D>(x * (Real)GTE_C_INV_LN_2);
+            return Exp2Estimate<Real>::template Degree<D>(x * (Real)GTE_C_INV_LN_2);
         }
 
         // The input x can be any real number.  Range reduction is used to
@@ -38,7 +38,38 @@ namespace gte
         template <int D>
         inline static Real DegreeRR(Real x)
         {
-            return Exp2Estimate<Real>::DegreeRR<D>(x * (Real)GTE_C_INV_LN_2);
+            return Exp2Estimate<Real>::template DegreeRR<D>(x * (Real)GTE_C_INV_LN_2);
+        }
+
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Exp2Estimate<Real>::template Degree<D>(x * (Real)GTE_C_INV_LN_2);
+        }
+
+        template <int D>
+        inline static SIMD4Value<Real> DegreeRR(SIMD4Value<Real> const& x)
+        {
+            return Exp2Estimate<Real>::template DegreeRR<D>(x * (Real)GTE_C_INV_LN_2);
+        }
+
+        // Evaluate the estimates for arrays, result[i] = Degree<D>(x[i]) or
+        // result[i] = DegreeRR<D>(x[i]), 4 elements at a time. The arrays
+        // may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
+        template <int D>
+        static void DegreeRR(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return DegreeRR<D>(v); });
         }
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -38,6 +38,32 @@ namespace gte
         virtual void GetExtremeVertices(Vector3<Real> const& direction,
             int& positiveDirection, int& negativeDirection) = 0;
 
+        // Compute the extreme vertices for each of the directions. The
+        // derived classes override this when the directions can share
+        // work.
+        virtual void GetExtremeVertices(int numDirections, Vector3<Real> const* directions,
+            int* positiveDirections, int* negativeDirections)
+        {
+            for (int i = 0; i < numDirections; ++i)
+            {
+                GetExtremeVertices(directions[i], positiveDirections[i], negativeDirections[i]);
+            }
+        }
+
+        // Compute the extreme vertices of several polyhedra for a single
+        // direction, which is the pattern of a support-function loop over
+        // many shapes. The indices are into the vertex arrays of the
+        // respective polyhedra.
+        static void GetExtremeVertices(Vector3<Real> const& direction, int numQueries,
+            ExtremalQuery3* const* queries, int* positiveDirections, int* negativeDirections)
+        {
+            for (int i = 0; i < numQueries; ++i)
+            {
+                queries[i]->GetExtremeVertices(direction, positiveDirections[i],
+                    negativeDirections[i]);
+            }
+        }
+
     protected:
         // The caller must ensure that the input polyhedron is convex.
         ExtremalQuery3(Polyhedron3<Real> const& polytope)
@@ -45,7 +71,7 @@ namespace gte
             mPolytope(polytope)
         {
             // Create the face normals.
-            auto vertexPool = mPolytope.GetVertices();
+            auto const& vertexPool = mPolytope.GetVertices();
             auto const& indices = mPolytope.GetIndices();
             int const numTriangles = static_cast<int>(indices.size()) / 3;
             mFaceNormals.resize(numTriangles);
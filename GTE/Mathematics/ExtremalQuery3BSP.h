@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.11.16
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -52,6 +52,8 @@ namespace gte
         ExtremalQuery3BSP(ExtremalQuery3BSP const&) = delete;
         ExtremalQuery3BSP& operator=(ExtremalQuery3BSP const&) = delete;
 
+        using ExtremalQuery3<Real>::GetExtremeVertices;
+
         // Compute the extreme vertices in the specified direction and return
         // the indices of the vertices in the polyhedron vertex array.
         virtual void GetExtremeVertices(Vector3<Real> const& direction,
@@ -0,0 +1,183 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/ExtremalQuery3.h>
+#include <algorithm>
+
+// The query climbs the vertex-edge graph of the polyhedron, moving from a
+// vertex to the neighbor with the largest projection onto the direction
+// until no neighbor has a larger projection. Because the polyhedron is
+// convex, the vertex at which the climb stops is extreme. The climb starts
+// at the extreme vertices of the previous query, so when the directions of
+// consecutive queries are close, as they are in a GJK or collision loop
+// over the frames of an animation, only a few vertices are visited. When
+// several vertices have the same extreme projection, the one found depends
+// on the starting vertex, so it can differ from the one found by the other
+// queries.
+
+namespace gte
+{
+    template <typename Real>
+    class ExtremalQuery3HC : public ExtremalQuery3<Real>
+    {
+    public:
+        // Construction.
+        ExtremalQuery3HC(Polyhedron3<Real> const& polytope)
+            :
+            ExtremalQuery3<Real>(polytope),
+            mPositive(0),
+            mNegative(0)
+        {
+            // The vertices of the polyhedron are the referenced ones of the
+            // vertex pool, stored locally in the order of the pool.
+            auto const& vertexPool = this->mPolytope.GetVertices();
+            auto const& uniqueIndices = this->mPolytope.GetUniqueIndices();
+            mIndices.assign(uniqueIndices.begin(), uniqueIndices.end());
+            int const numVertices = static_cast<int>(mIndices.size());
+            mVertices.resize(numVertices);
+            for (int i = 0; i < numVertices; ++i)
+            {
+                mVertices[i] = vertexPool[mIndices[i]];
+            }
+
+            // Create the adjacency of the vertices in compressed row
+            // storage. The adjacent vertices of vertex i are
+            // mAdjacent[mOffsets[i]] through mAdjacent[mOffsets[i+1]-1].
+            auto const& indices = this->mPolytope.GetIndices();
+            std::vector<std::pair<int, int>> edges;
+            edges.reserve(2 * indices.size());
+            for (size_t t = 0; t + 2 < indices.size(); t += 3)
+            {
+                for (size_t i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+                {
+                    int v0 = GetLocalIndex(indices[t + i0]);
+                    int v1 = GetLocalIndex(indices[t + i1]);
+                    edges.push_back(std::make_pair(v0, v1));
+                    edges.push_back(std::make_pair(v1, v0));
+                }
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            mOffsets.resize(static_cast<size_t>(numVertices) + 1);
+            mAdjacent.resize(edges.size());
+            std::fill(mOffsets.begin(), mOffsets.end(), 0);
+            for (size_t e = 0; e < edges.size(); ++e)
+            {
+                ++mOffsets[static_cast<size_t>(edges[e].first) + 1];
+                mAdjacent[e] = edges[e].second;
+            }
+            for (int i = 0; i < numVertices; ++i)
+            {
+                mOffsets[static_cast<size_t>(i) + 1] += mOffsets[i];
+            }
+        }
+
+        // Disallow copying and assignment.
+        ExtremalQuery3HC(ExtremalQuery3HC const&) = delete;
+        ExtremalQuery3HC& operator=(ExtremalQuery3HC const&) = delete;
+
+        using ExtremalQuery3<Real>::GetExtremeVertices;
+
+        // Compute the extreme vertices in the specified direction and return
+        // the indices of the vertices in the polyhedron vertex array. The
+        // climbs start at the vertices returned by the previous query.
+        virtual void GetExtremeVertices(Vector3<Real> const& direction,
+            int& positiveDirection, int& negativeDirection) override
+        {
+            if (mVertices.size() == 0)
+            {
+                positiveDirection = -1;
+                negativeDirection = -1;
+                return;
+            }
+
+            mPositive = Climb(direction, mPositive);
+            mNegative = Climb(-direction, mNegative);
+            positiveDirection = mIndices[mPositive];
+            negativeDirection = mIndices[mNegative];
+        }
+
+        // The query with explicit starting vertices, which are indices into
+        // the polyhedron vertex array, for callers that keep their own warm
+        // starts, such as one per pair of objects. The starting vertices are
+        // replaced by the extreme vertices. The function does not modify
+        // the state of the query, so it may be called concurrently.
+        void GetExtremeVertices(Vector3<Real> const& direction,
+            int& positiveDirection, int& negativeDirection,
+            int& positiveStart, int& negativeStart) const
+        {
+            if (mVertices.size() == 0)
+            {
+                positiveDirection = -1;
+                negativeDirection = -1;
+                return;
+            }
+
+            int positive = Climb(direction, GetLocalIndex(positiveStart));
+            int negative = Climb(-direction, GetLocalIndex(negativeStart));
+            positiveStart = mIndices[positive];
+            negativeStart = mIndices[negative];
+            positiveDirection = positiveStart;
+            negativeDirection = negativeStart;
+        }
+
+    private:
+        // Map an index of the polyhedron vertex array to the local index.
+        // An index that is not a vertex of the polyhedron is mapped to
+        // vertex 0.
+        int GetLocalIndex(int index) const
+        {
+            auto iter = std::lower_bound(mIndices.begin(), mIndices.end(), index);
+            if (iter != mIndices.end() && *iter == index)
+            {
+                return static_cast<int>(iter - mIndices.begin());
+            }
+            return 0;
+        }
+
+        // Steepest ascent of Dot(direction, vertex) from the start vertex.
+        int Climb(Vector3<Real> const& direction, int start) const
+        {
+            int current = start;
+            Real currentValue = Dot(direction, mVertices[current]);
+            for (;;)
+            {
+                int next = current;
+                Real nextValue = currentValue;
+                for (int k = mOffsets[current]; k < mOffsets[current + 1]; ++k)
+                {
+                    int adjacent = mAdjacent[k];
+                    Real value = Dot(direction, mVertices[adjacent]);
+                    if (value > nextValue)
+                    {
+                        next = adjacent;
+                        nextValue = value;
+                    }
+                }
+
+                if (next == current)
+                {
+                    return current;
+                }
+                current = next;
+                currentValue = nextValue;
+            }
+        }
+
+        // The indices of the vertices in the polyhedron vertex array, the
+        // vertices and their adjacency.
+        std::vector<int> mIndices;
+        std::vector<Vector3<Real>> mVertices;
+        std::vector<int> mOffsets, mAdjacent;
+
+        // The local indices of the extreme vertices of the previous query.
+        int mPositive, mNegative;
+    };
+}
@@ -3,11 +3,19 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/ExtremalQuery3.h>
+#include <Mathematics/SIMD4.h>
+
+// The query projects the vertices onto the direction. The vertices relative
+// to the centroid are stored by the constructor as arrays of x-, y- and
+// z-components, so the projections are computed 4 at a time with SIMD4. The
+// arrays are padded to a multiple of 4 by repeating the last vertex. The
+// projections are those of the scalar Dot(direction, vertex - centroid), and
+// ties are broken in favor of the smallest vertex index.
 
 namespace gte
 {
@@ -21,40 +29,106 @@ namespace gte
             ExtremalQuery3<Real>(polytope)
         {
             mCentroid = this->mPolytope.ComputeVertexAverage();
+
+            auto const& vertexPool = this->mPolytope.GetVertices();
+            auto const& uniqueIndices = this->mPolytope.GetUniqueIndices();
+            mIndices.assign(uniqueIndices.begin(), uniqueIndices.end());
+            size_t const numVertices = mIndices.size();
+            size_t const numPadded = 4 * ((numVertices + 3) / 4);
+            mX.resize(numPadded);
+            mY.resize(numPadded);
+            mZ.resize(numPadded);
+            for (size_t i = 0; i < numPadded; ++i)
+            {
+                size_t j = std::min(i, numVertices - 1);
+                Vector3<Real> diff = vertexPool[mIndices[j]] - mCentroid;
+                mX[i] = diff[0];
+                mY[i] = diff[1];
+                mZ[i] = diff[2];
+            }
         }
 
         // Disallow copying and assignment.
         ExtremalQuery3PRJ(ExtremalQuery3PRJ const&) = delete;
         ExtremalQuery3PRJ& operator=(ExtremalQuery3PRJ const&) = delete;
 
+        using ExtremalQuery3<Real>::GetExtremeVertices;
+
         // Compute the extreme vertices in the specified direction and return
         // the indices of the vertices in the polyhedron vertex array.
         virtual void GetExtremeVertices(Vector3<Real> const& direction,
             int& positiveDirection, int& negativeDirection) override
         {
-            Real minValue = std::numeric_limits<Real>::max(), maxValue = -minValue;
+            typedef SIMD4<Real> S;
+
             negativeDirection = -1;
             positiveDirection = -1;
+            if (mX.size() == 0)
+            {
+                return;
+            }
+
+            Real const* x = mX.data();
+            Real const* y = mY.data();
+            Real const* z = mZ.data();
+            auto dx = S::Set(direction[0]);
+            auto dy = S::Set(direction[1]);
+            auto dz = S::Set(direction[2]);
+            auto four = S::Set((Real)4);
+
+            // Each lane keeps the first of its largest and smallest
+            // projections and the position where it occurs.
+            auto position = S::Set((Real)0, (Real)1, (Real)2, (Real)3);
+            auto dot = S::Add(S::Add(S::Mul(dx, S::Load(x)), S::Mul(dy, S::Load(y))),
+                S::Mul(dz, S::Load(z)));
+            auto maxValue = dot, minValue = dot;
+            auto maxPosition = position, minPosition = position;
+            size_t const numPadded = mX.size();
+            for (size_t i = 4; i < numPadded; i += 4)
+            {
+                position = S::Add(position, four);
+                dot = S::Add(S::Add(S::Mul(dx, S::Load(x + i)), S::Mul(dy, S::Load(y + i))),
+                    S::Mul(dz, S::Load(z + i)));
+                auto mask = S::Less(maxValue, dot);
+                maxValue = S::Select(mask, dot, maxValue);
+                maxPosition = S::Select(mask, position, maxPosition);
+                mask = S::Less(dot, minValue);
+                minValue = S::Select(mask, dot, minValue);
+                minPosition = S::Select(mask, position, minPosition);
+            }
 
-            auto vertexPool = this->mPolytope.GetVertexPool();
-            for (auto i : this->mPolytope.GetUniqueIndices())
+            // Reduce the lanes. The positions of a lane increase, so the
+            // smallest position among the equal projections is the first
+            // occurrence of the extreme value.
+            std::array<Real, 4> maxV, minV, maxP, minP;
+            S::Store(maxV.data(), maxValue);
+            S::Store(minV.data(), minValue);
+            S::Store(maxP.data(), maxPosition);
+            S::Store(minP.data(), minPosition);
+            int maxLane = 0, minLane = 0;
+            for (int lane = 1; lane < 4; ++lane)
             {
-                Vector3<Real> diff = vertexPool.get()->at(i) - mCentroid;
-                Real dot = Dot(direction, diff);
-                if (dot < minValue)
+                if (maxV[maxLane] < maxV[lane] ||
+                    (maxV[lane] == maxV[maxLane] && maxP[lane] < maxP[maxLane]))
                 {
-                    negativeDirection = i;
-                    minValue = dot;
+                    maxLane = lane;
                 }
-                if (dot > maxValue)
+                if (minV[lane] < minV[minLane] ||
+                    (minV[lane] == minV[minLane] && minP[lane] < minP[minLane]))
                 {
-                    positiveDirection = i;
-                    maxValue = dot;
+                    minLane = lane;
                 }
             }
+            positiveDirection = mIndices[static_cast<size_t>(maxP[maxLane])];
+            negativeDirection = mIndices[static_cast<size_t>(minP[minLane])];
         }
 
     private:
         Vector3<Real> mCentroid;
+
+        // The indices of the vertices in the polyhedron vertex array and
+        // the components of the vertices relative to the centroid.
+        std::vector<int> mIndices;
+        std::vector<Real> mX, mY, mZ;
     };
 }
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/RecursiveGaussian.h>
 
 // The algorithms here are based on solving the linear heat equation using
 // finite differences in scale, not in time.  The following document has
@@ -44,6 +45,11 @@
 // the image.  The upper bound on b guarantees stability of the finite
 // difference method used to approximate the partial differential equation.
 // The method assumes a pixel size of h = 1.
+//
+// ExecuteRecursive is an alternative for a single large blur. It convolves
+// the image with a Gaussian of standard deviation sigma using the recursive
+// filter of RecursiveGaussian, so the cost per pixel does
+// not depend on sigma. The filter is computed in float.
 
 namespace gte
 {
@@ -96,5 +102,31 @@ namespace gte
                 output[x] = static_cast<T>(center + logBase * xsum);
             }
         }
+
+        // The standard deviation must satisfy sigma >= 0.5. The input and
+        // output can be the same array.
+        void ExecuteRecursive(int xBound, T const* input, T* output, double sigma)
+        {
+            LogAssert(xBound > 0 && input != nullptr && output != nullptr,
+                "Invalid input.");
+
+            RecursiveGaussian<float> filter(sigma);
+            mImage.resize(static_cast<size_t>(xBound));
+            for (int x = 0; x < xBound; ++x)
+            {
+                mImage[x] = static_cast<float>(input[x]);
+            }
+
+            float workspace[3];
+            filter(xBound, 1, 1, 1, mImage.data(), workspace);
+
+            for (int x = 0; x < xBound; ++x)
+            {
+                output[x] = RecursiveGaussian<float>::Convert<T>(mImage[x]);
+            }
+        }
+
+    private:
+        std::vector<float> mImage;
     };
 }
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/RecursiveGaussian.h>
 
 // The algorithms here are based on solving the linear heat equation using
 // finite differences in scale, not in time.  The following document has
@@ -44,6 +45,13 @@
 // the image.  The upper bound on b guarantees stability of the finite
 // difference method used to approximate the partial differential equation.
 // The method assumes a pixel size of h = 1.
+//
+// ExecuteRecursive is an alternative for a single large blur. It convolves
+// the image with a Gaussian of standard deviation sigma using the recursive
+// filter of RecursiveGaussian along each axis, so the cost per pixel does
+// not depend on sigma. The filter is computed in float, and the lines of
+// each axis are distributed among numThreads threads, which are tasks of the
+// scheduler when it is not null.
 
 namespace gte
 {
@@ -142,6 +150,57 @@ namespace gte
             mOutput = nullptr;
         }
 
+        // The standard deviation must satisfy sigma >= 0.5. The input and
+        // output can be the same array.
+        void ExecuteRecursive(int xBound, int yBound, T const* input, T* output,
+            double sigma, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(xBound > 0 && yBound > 0 && input != nullptr && output != nullptr,
+                "Invalid input.");
+
+            int const numRows = RecursiveGaussian<float>::NUM_INTERLEAVED_ROWS;
+            int const numColumns = RecursiveGaussian<float>::NUM_INTERLEAVED_COLUMNS;
+            RecursiveGaussian<float> filter(sigma);
+            mImage.resize(static_cast<size_t>(xBound) * static_cast<size_t>(yBound));
+            float* image = mImage.data();
+
+            // Filter the rows, copying them from the input.
+            RecursiveGaussian<float>::Execute(numThreads, scheduler, 0, yBound,
+                [&](int y0, int y1)
+                {
+                    std::vector<float> workspace(3 * numRows);
+                    for (int i = xBound * y0; i < xBound * y1; ++i)
+                    {
+                        image[i] = static_cast<float>(input[i]);
+                    }
+                    for (int y = y0; y < y1; y += numRows)
+                    {
+                        filter(xBound, 1, std::min(numRows, y1 - y), xBound,
+                            image + xBound * y, workspace.data());
+                    }
+                }, numRows);
+
+            // Filter the columns, copying them to the output.
+            RecursiveGaussian<float>::Execute(numThreads, scheduler, 0, xBound,
+                [&](int x0, int x1)
+                {
+                    std::vector<float> workspace(3 * numColumns);
+                    for (int x = x0; x < x1; x += numColumns)
+                    {
+                        filter(yBound, xBound, std::min(numColumns, x1 - x), 1,
+                            image + x, workspace.data());
+                    }
+                    for (int y = 0; y < yBound; ++y)
+                    {
+                        for (int x = x0, i = x0 + xBound * y; x < x1; ++x, ++i)
+                        {
+                            output[i] = RecursiveGaussian<float>::Convert<T>(image[i]);
+                        }
+                    }
+                }, numColumns);
+        }
+
     private:
         inline double Input(int x, int y) const
         {
@@ -156,5 +215,6 @@ namespace gte
         int mXBound, mYBound;
         T const* mInput;
         T* mOutput;
+        std::vector<float> mImage;
     };
 }
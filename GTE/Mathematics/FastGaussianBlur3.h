@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/RecursiveGaussian.h>
 
 // The algorithms here are based on solving the linear heat equation using
 // finite differences in scale, not in time.  The following document has
@@ -44,6 +45,13 @@
 // the image.  The upper bound on b guarantees stability of the finite
 // difference method used to approximate the partial differential equation.
 // The method assumes a pixel size of h = 1.
+//
+// ExecuteRecursive is an alternative for a single large blur. It convolves
+// the image with a Gaussian of standard deviation sigma using the recursive
+// filter of RecursiveGaussian along each axis, so the cost per pixel does
+// not depend on sigma. The filter is computed in float, and the lines of
+// each axis are distributed among numThreads threads, which are tasks of the
+// scheduler when it is not null.
 
 namespace gte
 {
@@ -166,6 +174,70 @@ namespace gte
             }
         }
 
+        // The standard deviation must satisfy sigma >= 0.5. The input and
+        // output can be the same array.
+        void ExecuteRecursive(int xBound, int yBound, int zBound, T const* input,
+            T* output, double sigma, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(xBound > 0 && yBound > 0 && zBound > 0 && input != nullptr
+                && output != nullptr, "Invalid input.");
+
+            int const numRows = RecursiveGaussian<float>::NUM_INTERLEAVED_ROWS;
+            int const numColumns = RecursiveGaussian<float>::NUM_INTERLEAVED_COLUMNS;
+            RecursiveGaussian<float> filter(sigma);
+            size_t const xyBound = static_cast<size_t>(xBound) * static_cast<size_t>(yBound);
+            mImage.resize(xyBound * static_cast<size_t>(zBound));
+            float* image = mImage.data();
+
+            // Filter the rows and the columns of each slice, copying the
+            // slice from the input.
+            RecursiveGaussian<float>::Execute(numThreads, scheduler, 0, zBound,
+                [&](int z0, int z1)
+                {
+                    std::vector<float> workspace(3 * std::max(numRows, numColumns));
+                    for (int z = z0; z < z1; ++z)
+                    {
+                        size_t const offset = xyBound * static_cast<size_t>(z);
+                        float* slice = image + offset;
+                        for (size_t i = 0; i < xyBound; ++i)
+                        {
+                            slice[i] = static_cast<float>(input[offset + i]);
+                        }
+                        for (int y = 0; y < yBound; y += numRows)
+                        {
+                            filter(xBound, 1, std::min(numRows, yBound - y), xBound,
+                                slice + xBound * y, workspace.data());
+                        }
+                        for (int x = 0; x < xBound; x += numColumns)
+                        {
+                            filter(yBound, xBound, std::min(numColumns, xBound - x), 1,
+                                slice + x, workspace.data());
+                        }
+                    }
+                });
+
+            // Filter the lines along z, copying them to the output.
+            RecursiveGaussian<float>::Execute(numThreads, scheduler, 0, static_cast<int>(xyBound),
+                [&](int i0, int i1)
+                {
+                    std::vector<float> workspace(3 * numColumns);
+                    for (int i = i0; i < i1; i += numColumns)
+                    {
+                        filter(zBound, static_cast<int>(xyBound), std::min(numColumns, i1 - i), 1,
+                            image + i, workspace.data());
+                    }
+                    for (int z = 0; z < zBound; ++z)
+                    {
+                        size_t const offset = xyBound * static_cast<size_t>(z);
+                        for (int i = i0; i < i1; ++i)
+                        {
+                            output[offset + i] = RecursiveGaussian<float>::Convert<T>(image[offset + i]);
+                        }
+                    }
+                }, numColumns);
+        }
+
     private:
         inline double Input(int x, int y, int z) const
         {
@@ -180,5 +252,6 @@ namespace gte
         int mXBound, mYBound, mZBound;
         T const* mInput;
         T* mOutput;
+        std::vector<float> mImage;
     };
 }
@@ -3,11 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
+#include <Mathematics/Logger.h>
 #include <Mathematics/MinHeap.h>
+#include <algorithm>
 #include <limits>
 
 // The topic of fast marching methods are discussed in the book
@@ -16,6 +18,20 @@
 //     Computer Vision, and Materials Science
 //   J.A. Sethian,
 //   Cambridge University Press, 1999
+//
+// The trial elements are stored by default in a min-heap, so the march
+// over n elements is O(n log n). SetBucketWidth selects instead the
+// untidy priority queue of
+//   L. Yatziv, A. Bartesaghi and G. Sapiro,
+//   O(N) implementation of the fast marching algorithm,
+//   Journal of Computational Physics 212 (2006), 393-399
+// which is a circular array of buckets of times, each bucket covering an
+// interval of length bucketWidth. The elements of a bucket are removed in
+// arbitrary order, so the march is O(n) but the times have errors of the
+// order of bucketWidth.
+//
+// March(maxTime) stops the march at a given time, which is sufficient for
+// narrow-band level-set methods that need the times only near the seeds.
 
 namespace gte
 {
@@ -52,7 +68,10 @@ namespace gte
             mTimes(quantity, std::numeric_limits<Real>::max()),
             mInvSpeeds(quantity),
             mHeap(static_cast<int>(quantity)),
-            mTrials(quantity, nullptr)
+            mTrials(quantity, nullptr),
+            mBucketWidth((Real)0),
+            mCurrentBucket(0),
+            mNumBucketTrials(0)
         {
             for (auto seed : seeds)
             {
@@ -79,7 +98,10 @@ namespace gte
             mTimes(quantity, std::numeric_limits<Real>::max()),
             mInvSpeeds(quantity, (Real)1 / speed),
             mHeap(static_cast<int>(quantity)),
-            mTrials(quantity, nullptr)
+            mTrials(quantity, nullptr),
+            mBucketWidth((Real)0),
+            mCurrentBucket(0),
+            mNumBucketTrials(0)
         {
             for (auto seed : seeds)
             {
@@ -147,7 +169,8 @@ namespace gte
 
         inline bool IsTrial(size_t i) const
         {
-            return mTrials[i] != nullptr;
+            return mTrials[i] != nullptr
+                || (mBucketWidth > (Real)0 && mBucketKeys[i] != msInvalidKey);
         }
 
         inline bool IsFar(size_t i) const
@@ -180,14 +203,232 @@ namespace gte
         virtual void GetBoundary(std::vector<size_t>& boundary) const = 0;
         virtual bool IsBoundary(size_t i) const = 0;
 
-        // Run one step of the fast marching algorithm.
+        inline size_t GetNumTrials() const
+        {
+            return (mBucketWidth > (Real)0 ? mNumBucketTrials :
+                static_cast<size_t>(mHeap.GetNumElements()));
+        }
+
+        // Select the queue of trial elements. A bucketWidth of 0 selects the
+        // min-heap, which is the default. A positive bucketWidth selects the
+        // untidy priority queue. The current trial elements are moved to the
+        // selected queue, so the function can be called at any time. The
+        // times of the untidy queue are as accurate as those of the
+        // min-heap when bucketWidth is at most half the minimum inverse
+        // speed (the minimum time between neighbors).
+        void SetBucketWidth(Real bucketWidth)
+        {
+            LogAssert(bucketWidth >= (Real)0, "Invalid bucket width.");
+
+            std::vector<size_t> trials;
+            trials.reserve(GetNumTrials());
+            size_t i;
+            while (RemoveTrial(i))
+            {
+                trials.push_back(i);
+            }
+
+            mBucketWidth = bucketWidth;
+            if (mBucketWidth > (Real)0)
+            {
+                // A trial time is at most the time of the last known
+                // element plus the inverse speed, so the keys are within
+                // maxInvSpeed/bucketWidth+1 of the current key.
+                Real maxInvSpeed = (Real)0;
+                for (auto invSpeed : mInvSpeeds)
+                {
+                    if (invSpeed < std::numeric_limits<Real>::max())
+                    {
+                        maxInvSpeed = std::max(maxInvSpeed, invSpeed);
+                    }
+                }
+
+                size_t minKey = msInvalidKey, maxKey = 0;
+                for (auto j : trials)
+                {
+                    size_t key = GetBucketKey(mTimes[j]);
+                    minKey = std::min(minKey, key);
+                    maxKey = std::max(maxKey, key);
+                }
+                mCurrentBucket = (trials.size() > 0 ? minKey : 0);
+                size_t numBuckets = GetBucketKey(maxInvSpeed) + 2;
+                if (trials.size() > 0)
+                {
+                    numBuckets += maxKey - minKey;
+                }
+
+                mBuckets.assign(numBuckets, std::vector<size_t>());
+                mBucketKeys.assign(mQuantity, msInvalidKey);
+                mNumBucketTrials = 0;
+            }
+            else
+            {
+                mBuckets.clear();
+                mBucketKeys.clear();
+                mCurrentBucket = 0;
+                mNumBucketTrials = 0;
+            }
+
+            for (auto j : trials)
+            {
+                InsertTrial(j);
+            }
+        }
+
+        inline Real GetBucketWidth() const
+        {
+            return mBucketWidth;
+        }
+
+        // Run one step of the fast marching algorithm. The function does
+        // nothing when there are no trial elements.
         virtual void Iterate() = 0;
 
+        // Iterate until there are no trial elements or until the minimum
+        // trial time is larger than maxTime; for the untidy queue, the
+        // minimum trial time is the smallest time of the current bucket.
+        // The elements with times at most maxTime are then known, the
+        // trial elements have estimated times larger than maxTime and the
+        // elements farther from the seeds are not visited. The time
+        // estimates use the times of trial neighbors, so marching farther
+        // can lower a few of the times near maxTime. The function returns
+        // the number of iterations.
+        size_t March(Real maxTime = std::numeric_limits<Real>::max())
+        {
+            size_t numIterations = 0;
+            size_t i;
+            while (GetMinimumTrial(i))
+            {
+                Real minTime = (mBucketWidth > (Real)0 ?
+                    mBucketWidth * static_cast<Real>(mCurrentBucket) : mTimes[i]);
+                if (minTime > maxTime)
+                {
+                    break;
+                }
+                Iterate();
+                ++numIterations;
+            }
+            return numIterations;
+        }
+
     protected:
+        // Insert element i into the queue of trial elements using its
+        // current time, or update its position when it is a trial element.
+        void InsertTrial(size_t i)
+        {
+            if (mBucketWidth > (Real)0)
+            {
+                // A trial time does not increase, so the element is moved
+                // only to the same or an earlier bucket. The entry in the
+                // later bucket is discarded when that bucket is reached.
+                size_t key = std::max(GetBucketKey(mTimes[i]), mCurrentBucket);
+                if (mBucketKeys[i] != key)
+                {
+                    LogAssert(key - mCurrentBucket < mBuckets.size(), "Unexpected bucket.");
+                    if (mBucketKeys[i] == msInvalidKey)
+                    {
+                        ++mNumBucketTrials;
+                    }
+                    mBucketKeys[i] = key;
+                    mBuckets[key % mBuckets.size()].push_back(i);
+                }
+            }
+            else if (mTrials[i])
+            {
+                mHeap.Update(mTrials[i], mTimes[i]);
+            }
+            else
+            {
+                mTrials[i] = mHeap.Insert(i, mTimes[i]);
+            }
+        }
+
+        // Get the trial element to be removed next. The function returns
+        // 'false' when there are no trial elements.
+        bool GetMinimumTrial(size_t& i)
+        {
+            if (mBucketWidth > (Real)0)
+            {
+                if (mNumBucketTrials == 0)
+                {
+                    return false;
+                }
+
+                for (;;)
+                {
+                    auto& bucket = mBuckets[mCurrentBucket % mBuckets.size()];
+                    while (bucket.size() > 0)
+                    {
+                        size_t j = bucket.back();
+                        if (mBucketKeys[j] == mCurrentBucket)
+                        {
+                            i = j;
+                            return true;
+                        }
+
+                        // The element was removed or moved to an earlier
+                        // bucket.
+                        bucket.pop_back();
+                    }
+                    ++mCurrentBucket;
+                }
+            }
+            else
+            {
+                Real value;
+                return mHeap.GetMinimum(i, value);
+            }
+        }
+
+        // Remove the trial element returned by GetMinimumTrial, which
+        // becomes a known element.
+        bool RemoveTrial(size_t& i)
+        {
+            if (mBucketWidth > (Real)0)
+            {
+                if (!GetMinimumTrial(i))
+                {
+                    return false;
+                }
+                mBuckets[mCurrentBucket % mBuckets.size()].pop_back();
+                mBucketKeys[i] = msInvalidKey;
+                --mNumBucketTrials;
+                return true;
+            }
+            else
+            {
+                Real value;
+                if (!mHeap.Remove(i, value))
+                {
+                    return false;
+                }
+                mTrials[i] = nullptr;
+                return true;
+            }
+        }
+
+        inline size_t GetBucketKey(Real time) const
+        {
+            return static_cast<size_t>(time / mBucketWidth);
+        }
+
         size_t mQuantity;
         std::vector<Real> mTimes;
         std::vector<Real> mInvSpeeds;
         MinHeap<size_t, Real> mHeap;
         std::vector<typename MinHeap<size_t, Real>::Record*> mTrials;
+
+        // The untidy priority queue. The element i is a trial element when
+        // mBucketKeys[i] is not msInvalidKey, in which case it is stored in
+        // bucket mBucketKeys[i] modulo the number of buckets.
+        Real mBucketWidth;
+        std::vector<std::vector<size_t>> mBuckets;
+        std::vector<size_t> mBucketKeys;
+        size_t mCurrentBucket, mNumBucketTrials;
+
+        static size_t const msInvalidKey = std::numeric_limits<size_t>::max();
     };
+
+    template <typename Real>
+    size_t const FastMarch<Real>::msInvalidKey;
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -106,65 +106,20 @@ namespace gte
         // Run one step of the fast marching algorithm.
         virtual void Iterate() override
         {
-            // Remove the minimum trial value from the heap.
+            // Remove the minimum trial value from the queue, which promotes
+            // the trial pixel to a known pixel.
             size_t i;
-            Real value;
-            this->mHeap.Remove(i, value);
-
-            // Promote the trial value to a known value.  The value was
-            // negative but is now nonnegative (the heap stores only
-            // nonnegative numbers).
-            this->mTrials[i] = nullptr;
-
-            // All trial pixels must be updated.  All far neighbors must become trial
-            // pixels.
-            size_t iM1 = i - 1;
-            if (this->IsTrial(iM1))
-            {
-                ComputeTime(iM1);
-                this->mHeap.Update(this->mTrials[iM1], this->mTimes[iM1]);
-            }
-            else if (this->IsFar(iM1))
-            {
-                ComputeTime(iM1);
-                this->mTrials[iM1] = this->mHeap.Insert(iM1, this->mTimes[iM1]);
-            }
-
-            size_t iP1 = i + 1;
-            if (this->IsTrial(iP1))
-            {
-                ComputeTime(iP1);
-                this->mHeap.Update(this->mTrials[iP1], this->mTimes[iP1]);
-            }
-            else if (this->IsFar(iP1))
+            if (!this->RemoveTrial(i))
             {
-                ComputeTime(iP1);
-                this->mTrials[iP1] = this->mHeap.Insert(iP1, this->mTimes[iP1]);
+                return;
             }
 
-            size_t iMXB = i - mXBound;
-            if (this->IsTrial(iMXB))
-            {
-                ComputeTime(iMXB);
-                this->mHeap.Update(this->mTrials[iMXB], this->mTimes[iMXB]);
-            }
-            else if (this->IsFar(iMXB))
-            {
-                ComputeTime(iMXB);
-                this->mTrials[iMXB] = this->mHeap.Insert(iMXB, this->mTimes[iMXB]);
-            }
-
-            size_t iPXB = i + mXBound;
-            if (this->IsTrial(iPXB))
-            {
-                ComputeTime(iPXB);
-                this->mHeap.Update(this->mTrials[iPXB], this->mTimes[iPXB]);
-            }
-            else if (this->IsFar(iPXB))
-            {
-                ComputeTime(iPXB);
-                this->mTrials[iPXB] = this->mHeap.Insert(iPXB, this->mTimes[iPXB]);
-            }
+            // All trial pixels must be updated.  All far neighbors must
+            // become trial pixels.
+            UpdateNeighbor(i - 1);
+            UpdateNeighbor(i + 1);
+            UpdateNeighbor(i - mXBound);
+            UpdateNeighbor(i + mXBound);
         }
 
     protected:
@@ -242,7 +197,7 @@ namespace gte
                             || (this->IsValid(i + mXBound) && !this->IsTrial(i + mXBound)))
                         {
                             ComputeTime(i);
-                            this->mTrials[i] = this->mHeap.Insert(i, this->mTimes[i]);
+                            this->InsertTrial(i);
                         }
                     }
                 }
@@ -250,6 +205,15 @@ namespace gte
         }
 
         // Called by Iterate().
+        void UpdateNeighbor(size_t i)
+        {
+            if (this->IsTrial(i) || this->IsFar(i))
+            {
+                ComputeTime(i);
+                this->InsertTrial(i);
+            }
+        }
+
         void ComputeTime(size_t i)
         {
             bool hasXTerm;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -122,89 +122,22 @@ namespace gte
         // Run one step of the fast marching algorithm.
         virtual void Iterate() override
         {
-            // Remove the minimum trial value from the heap.
+            // Remove the minimum trial value from the queue, which promotes
+            // the trial voxel to a known voxel.
             size_t i;
-            Real value;
-            this->mHeap.Remove(i, value);
-
-            // Promote the trial value to a known value.  The value was
-            // negative but is now nonnegative (the heap stores only
-            // nonnegative numbers).
-            this->mTrials[i] = nullptr;
-
-            // All trial pixels must be updated.  All far neighbors must
-            // become trial pixels.
-            size_t iM1 = i - 1;
-            if (this->IsTrial(iM1))
-            {
-                ComputeTime(iM1);
-                this->mHeap.Update(this->mTrials[iM1], this->mTimes[iM1]);
-            }
-            else if (this->IsFar(iM1))
-            {
-                ComputeTime(iM1);
-                this->mTrials[iM1] = this->mHeap.Insert(iM1, this->mTimes[iM1]);
-            }
-
-            size_t iP1 = i + 1;
-            if (this->IsTrial(iP1))
-            {
-                ComputeTime(iP1);
-                this->mHeap.Update(this->mTrials[iP1], this->mTimes[iP1]);
-            }
-            else if (this->IsFar(iP1))
-            {
-                ComputeTime(iP1);
-                this->mTrials[iP1] = this->mHeap.Insert(iP1, this->mTimes[iP1]);
-            }
-
-            size_t iMXB = i - mXBound;
-            if (this->IsTrial(iMXB))
-            {
-                ComputeTime(iMXB);
-                this->mHeap.Update(this->mTrials[iMXB], this->mTimes[iMXB]);
-            }
-            else if (this->IsFar(iMXB))
-            {
-                ComputeTime(iMXB);
-                this->mTrials[iMXB] = this->mHeap.Insert(iMXB, this->mTimes[iMXB]);
-            }
-
-            size_t iPXB = i + mXBound;
-            if (this->IsTrial(iPXB))
-            {
-                ComputeTime(iPXB);
-                this->mHeap.Update(this->mTrials[iPXB], this->mTimes[iPXB]);
-            }
-            else if (this->IsFar(iPXB))
-            {
-                ComputeTime(iPXB);
-                this->mTrials[iPXB] = this->mHeap.Insert(iPXB, this->mTimes[iPXB]);
-            }
-
-            size_t iMXYB = i - mXYBound;
-            if (this->IsTrial(iMXYB))
-            {
-                ComputeTime(iMXYB);
-                this->mHeap.Update(this->mTrials[iMXYB], this->mTimes[iMXYB]);
-            }
-            else if (this->IsFar(iMXYB))
+            if (!this->RemoveTrial(i))
             {
-                ComputeTime(iMXYB);
-                this->mTrials[iMXYB] = this->mHeap.Insert(iMXYB, this->mTimes[iMXYB]);
+                return;
             }
 
-            size_t iPXYB = i + mXYBound;
-            if (this->IsTrial(iPXYB))
-            {
-                ComputeTime(iPXYB);
-                this->mHeap.Update(this->mTrials[iPXYB], this->mTimes[iPXYB]);
-            }
-            else if (this->IsFar(iPXYB))
-            {
-                ComputeTime(iPXYB);
-                this->mTrials[iPXYB] = this->mHeap.Insert(iPXYB, this->mTimes[iPXYB]);
-            }
+            // All trial voxels must be updated.  All far neighbors must
+            // become trial voxels.
+            UpdateNeighbor(i - 1);
+            UpdateNeighbor(i + 1);
+            UpdateNeighbor(i - mXBound);
+            UpdateNeighbor(i + mXBound);
+            UpdateNeighbor(i - mXYBound);
+            UpdateNeighbor(i + mXYBound);
         }
 
     protected:
@@ -226,115 +159,29 @@ namespace gte
             mInvYSpacing = (Real)1 / ySpacing;
             mInvZSpacing = (Real)1 / zSpacing;
 
-            // Boundary pixels are marked as zero speed to allow us to avoid
-            // having to process the boundary pixels separately during the
-            // iteration.
+            // Boundary voxels are marked as zero speed to allow us to avoid
+            // having to process the boundary voxels separately during the
+            // iteration. All voxels of the six faces must be marked, because
+            // the six neighbors of every voxel reached by the front are
+            // accessed.
             size_t x, y, z, i;
 
-            // vertex (0,0,0)
-            i = Index(0, 0, 0);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (xmax,0,0)
-            i = Index(mXBoundM1, 0, 0);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (0,ymax,0)
-            i = Index(0, mYBoundM1, 0);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (xmax,ymax,0)
-            i = Index(mXBoundM1, mYBoundM1, 0);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (0,0,zmax)
-            i = Index(0, 0, mZBoundM1);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (xmax,0,zmax)
-            i = Index(mXBoundM1, 0, mZBoundM1);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (0,ymax,zmax)
-            i = Index(0, mYBoundM1, mZBoundM1);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // vertex (xmax,ymax,zmax)
-            i = Index(mXBoundM1, mYBoundM1, mZBoundM1);
-            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-            this->mTimes[i] = -std::numeric_limits<Real>::max();
-
-            // edges (x,0,0) and (x,ymax,0)
-            for (x = 0; x < mXBound; ++x)
-            {
-                i = Index(x, 0, 0);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-                i = Index(x, mYBoundM1, 0);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-            }
-
-            // edges (0,y,0) and (xmax,y,0)
-            for (y = 0; y < mYBound; ++y)
-            {
-                i = Index(0, y, 0);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-                i = Index(mXBoundM1, y, 0);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-            }
-
-            // edges (x,0,zmax) and (x,ymax,zmax)
-            for (x = 0; x < mXBound; ++x)
-            {
-                i = Index(x, 0, mZBoundM1);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-                i = Index(x, mYBoundM1, mZBoundM1);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-            }
-
-            // edges (0,y,zmax) and (xmax,y,zmax)
-            for (y = 0; y < mYBound; ++y)
-            {
-                i = Index(0, y, mZBoundM1);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-                i = Index(mXBoundM1, y, mZBoundM1);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-            }
-
-            // edges (0,0,z) and (xmax,0,z)
             for (z = 0; z < mZBound; ++z)
             {
-                i = Index(0, 0, z);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-                i = Index(mXBoundM1, 0, z);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-            }
-
-            // edges (0,ymax,z) and (xmax,ymax,z)
-            for (z = 0; z < mZBound; ++z)
-            {
-                i = Index(0, mYBoundM1, z);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
-                i = Index(mXBoundM1, mYBoundM1, z);
-                this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
-                this->mTimes[i] = -std::numeric_limits<Real>::max();
+                bool zFace = (z == 0 || z == mZBoundM1);
+                for (y = 0; y < mYBound; ++y)
+                {
+                    bool yzFace = (zFace || y == 0 || y == mYBoundM1);
+                    for (x = 0; x < mXBound; ++x)
+                    {
+                        if (yzFace || x == 0 || x == mXBoundM1)
+                        {
+                            i = Index(x, y, z);
+                            this->mInvSpeeds[i] = std::numeric_limits<Real>::max();
+                            this->mTimes[i] = -std::numeric_limits<Real>::max();
+                        }
+                    }
+                }
             }
 
             // Compute the first batch of trial pixels.  These are pixels a grid
@@ -356,7 +203,7 @@ namespace gte
                                 || (this->IsValid(i + mXYBound) && !this->IsTrial(i + mXYBound)))
                             {
                                 ComputeTime(i);
-                                this->mTrials[i] = this->mHeap.Insert(i, this->mTimes[i]);
+                                this->InsertTrial(i);
                             }
                         }
                     }
@@ -365,6 +212,15 @@ namespace gte
         }
 
         // Called by Iterate().
+        void UpdateNeighbor(size_t i)
+        {
+            if (this->IsTrial(i) || this->IsFar(i))
+            {
+                ComputeTime(i);
+                this->InsertTrial(i);
+            }
+        }
+
         void ComputeTime(size_t i)
         {
             bool hasXTerm;
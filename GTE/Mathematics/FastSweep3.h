@@ -0,0 +1,459 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// A fast sweeping solver of the eikonal equation |grad(T)| = 1/speed on a
+// 3D grid, an alternative to FastMarch3 with the same construction and the
+// same time conventions. The method is described in
+//   H. Zhao,
+//   A fast sweeping method for eikonal equations,
+//   Mathematics of Computation 74 (2005), 603-627
+// An iteration visits the voxels in each of the 8 diagonal orderings of the
+// grid and replaces the time of each voxel by the minimum of its time and
+// the Godunov upwind solution computed from its 6 neighbors. The sweeps
+// converge after a few iterations for which the number depends on the
+// shape of the fronts and not on the grid size.
+//
+// The voxels of a sweep are visited in the order of the planes
+// x'+y'+z' = L, where (x',y',z') are the voxel coordinates reflected for
+// the sweep direction. This is the ordering of
+//   M. Detrixhe, F. Gibou and C. Min,
+//   A parallel fast sweeping method for the eikonal equation,
+//   Journal of Computational Physics 237 (2013), 46-55
+// The neighbors of a voxel are in the planes L-1 and L+1, so the voxels of
+// a plane are updated independently and the planes are distributed among
+// the threads. The results do not depend on the number of threads.
+//
+// The differences from FastMarch3 are that the times are computed with the
+// spacings (FastMarch3 computes them in grid units) and the voxels of the
+// grid faces are not marked as zero speed; neighbors outside the grid are
+// ignored.
+
+namespace gte
+{
+    template <typename Real>
+    class FastSweep3
+    {
+    public:
+        // Construction. The seed voxels have time 0. The speeds must be
+        // nonnegative; a voxel of speed 0 has time -maxReal and is never
+        // visited, where maxReal is std::numeric_limits<Real>::max(). All
+        // other voxels have time maxReal until they are reached by a sweep.
+        FastSweep3(size_t xBound, size_t yBound, size_t zBound,
+            Real xSpacing, Real ySpacing, Real zSpacing,
+            std::vector<size_t> const& seeds, std::vector<Real> const& speeds)
+            :
+            mXBound(xBound),
+            mYBound(yBound),
+            mZBound(zBound),
+            mXYBound(xBound * yBound),
+            mQuantity(xBound * yBound * zBound),
+            mTimes(mQuantity, std::numeric_limits<Real>::max()),
+            mInvSpeeds(mQuantity)
+        {
+            LogAssert(mQuantity > 0 && speeds.size() == mQuantity, "Invalid input.");
+
+            Initialize(xSpacing, ySpacing, zSpacing);
+            for (size_t i = 0; i < mQuantity; ++i)
+            {
+                if (speeds[i] > (Real)0)
+                {
+                    mInvSpeeds[i] = (Real)1 / speeds[i];
+                }
+                else
+                {
+                    mInvSpeeds[i] = std::numeric_limits<Real>::max();
+                    mTimes[i] = -std::numeric_limits<Real>::max();
+                }
+            }
+            InitializeSeeds(seeds);
+        }
+
+        FastSweep3(size_t xBound, size_t yBound, size_t zBound,
+            Real xSpacing, Real ySpacing, Real zSpacing,
+            std::vector<size_t> const& seeds, Real speed)
+            :
+            mXBound(xBound),
+            mYBound(yBound),
+            mZBound(zBound),
+            mXYBound(xBound * yBound),
+            mQuantity(xBound * yBound * zBound),
+            mTimes(mQuantity, std::numeric_limits<Real>::max()),
+            mInvSpeeds(mQuantity, (Real)1 / speed)
+        {
+            LogAssert(mQuantity > 0 && speed > (Real)0, "Invalid input.");
+
+            Initialize(xSpacing, ySpacing, zSpacing);
+            InitializeSeeds(seeds);
+        }
+
+        // Member access.
+        inline size_t GetXBound() const
+        {
+            return mXBound;
+        }
+
+        inline size_t GetYBound() const
+        {
+            return mYBound;
+        }
+
+        inline size_t GetZBound() const
+        {
+            return mZBound;
+        }
+
+        inline Real GetXSpacing() const
+        {
+            return mSpacing[0];
+        }
+
+        inline Real GetYSpacing() const
+        {
+            return mSpacing[1];
+        }
+
+        inline Real GetZSpacing() const
+        {
+            return mSpacing[2];
+        }
+
+        inline size_t GetQuantity() const
+        {
+            return mQuantity;
+        }
+
+        inline size_t Index(size_t x, size_t y, size_t z) const
+        {
+            return x + mXBound * (y + mYBound * z);
+        }
+
+        // A voxel with time 0 is treated as a seed and is not modified by
+        // the sweeps.
+        inline void SetTime(size_t i, Real time)
+        {
+            mTimes[i] = time;
+        }
+
+        inline Real GetTime(size_t i) const
+        {
+            return mTimes[i];
+        }
+
+        inline std::vector<Real> const& GetTimes() const
+        {
+            return mTimes;
+        }
+
+        // Voxel classification.
+        inline bool IsValid(size_t i) const
+        {
+            return (Real)0 <= mTimes[i] && mTimes[i] < std::numeric_limits<Real>::max();
+        }
+
+        inline bool IsFar(size_t i) const
+        {
+            return mTimes[i] == std::numeric_limits<Real>::max();
+        }
+
+        inline bool IsZeroSpeed(size_t i) const
+        {
+            return mTimes[i] == -std::numeric_limits<Real>::max();
+        }
+
+        void GetTimeExtremes(Real& minValue, Real& maxValue) const
+        {
+            minValue = std::numeric_limits<Real>::max();
+            maxValue = -std::numeric_limits<Real>::max();
+            for (size_t i = 0; i < mQuantity; ++i)
+            {
+                if (IsValid(i))
+                {
+                    minValue = std::min(minValue, mTimes[i]);
+                    maxValue = std::max(maxValue, mTimes[i]);
+                }
+            }
+        }
+
+        // Execute iterations of 8 sweeps until the maximum change of the
+        // times during an iteration is at most 'tolerance' or until
+        // maxIterations iterations have been executed. A voxel reached for
+        // the first time counts as an infinite change, so tolerance = 0
+        // iterates until no time changes. The function returns the number
+        // of iterations. The code runs single-threaded when numThreads <= 1.
+        // Otherwise the planes of voxels are partitioned among numThreads
+        // threads, which are owned by a TaskScheduler that is created on the
+        // first multithreaded call and reused by later calls with the same
+        // number of threads.
+        size_t Sweep(size_t maxIterations, Real tolerance, size_t numThreads = 1)
+        {
+            if (numThreads > 1)
+            {
+                if (!mScheduler || mScheduler->GetNumThreads() != numThreads)
+                {
+                    mScheduler = std::make_shared<TaskScheduler>(numThreads);
+                }
+            }
+            else
+            {
+                numThreads = 1;
+            }
+            mChanges.resize(numThreads * NUM_CHUNKS_PER_THREAD);
+
+            size_t iteration = 0;
+            while (iteration < maxIterations)
+            {
+                ++iteration;
+                Real maxChange = (Real)0;
+                for (int direction = 0; direction < 8; ++direction)
+                {
+                    maxChange = std::max(maxChange, SweepDirection(direction, numThreads));
+                }
+                if (maxChange <= tolerance)
+                {
+                    break;
+                }
+            }
+            return iteration;
+        }
+
+    private:
+        // The planes with fewer voxels than this are updated by the calling
+        // thread; the planes with more voxels are split into chunks of
+        // contiguous x'-values, several per thread to balance the loads.
+        enum
+        {
+            MIN_PARALLEL_VOXELS = 4096,
+            NUM_CHUNKS_PER_THREAD = 4
+        };
+
+        void Initialize(Real xSpacing, Real ySpacing, Real zSpacing)
+        {
+            LogAssert(xSpacing > (Real)0 && ySpacing > (Real)0 && zSpacing > (Real)0,
+                "Invalid input.");
+
+            mSpacing[0] = xSpacing;
+            mSpacing[1] = ySpacing;
+            mSpacing[2] = zSpacing;
+            for (int j = 0; j < 3; ++j)
+            {
+                mInvSqrSpacing[j] = (Real)1 / (mSpacing[j] * mSpacing[j]);
+            }
+        }
+
+        void InitializeSeeds(std::vector<size_t> const& seeds)
+        {
+            for (auto seed : seeds)
+            {
+                LogAssert(seed < mQuantity, "Invalid input.");
+                mTimes[seed] = (Real)0;
+            }
+        }
+
+        // Execute the sweep in the direction whose bit j is 1 when the
+        // sweep visits coordinate j in decreasing order. The function
+        // returns the maximum change of the times.
+        Real SweepDirection(int direction, size_t numThreads)
+        {
+            std::array<bool, 3> reflect =
+            {
+                (direction & 1) != 0,
+                (direction & 2) != 0,
+                (direction & 4) != 0
+            };
+
+            size_t const numPlanes = mXBound + mYBound + mZBound - 2;
+            size_t const numChunks = mChanges.size();
+            Real maxChange = (Real)0;
+            for (size_t level = 0; level < numPlanes; ++level)
+            {
+                // The plane x'+y'+z' = level contains the voxels with x' in
+                // [xmin,xmax] and, for each x', y' in [ymin,ymax].
+                size_t yzMax = (mYBound - 1) + (mZBound - 1);
+                size_t xmin = (level > yzMax ? level - yzMax : 0);
+                size_t xmax = std::min(mXBound - 1, level);
+
+                // An estimate of the number of voxels from the bound of
+                // the y'z'-diagonal lengths.
+                size_t numX = xmax - xmin + 1;
+                size_t numVoxels = numX * std::min(mYBound, mZBound);
+                if (numThreads == 1 || numVoxels < MIN_PARALLEL_VOXELS || numX < 2)
+                {
+                    maxChange = std::max(maxChange,
+                        SweepPlane(level, xmin, xmax + 1, reflect));
+                }
+                else
+                {
+                    size_t n = std::min(numChunks, numX);
+                    TaskScheduler::TaskGroup group;
+                    for (size_t c = 1; c < n; ++c)
+                    {
+                        size_t x0 = xmin + c * numX / n;
+                        size_t x1 = xmin + (c + 1) * numX / n;
+                        mScheduler->Spawn(group, [this, c, level, x0, x1, &reflect]()
+                        {
+                            mChanges[c] = SweepPlane(level, x0, x1, reflect);
+                        });
+                    }
+                    mChanges[0] = SweepPlane(level, xmin, xmin + numX / n, reflect);
+                    mScheduler->Wait(group);
+
+                    for (size_t c = 0; c < n; ++c)
+                    {
+                        maxChange = std::max(maxChange, mChanges[c]);
+                    }
+                }
+            }
+            return maxChange;
+        }
+
+        // Update the voxels of the plane x'+y'+z' = level with x' in
+        // [x0,x1). The function returns the maximum change of the times.
+        Real SweepPlane(size_t level, size_t x0, size_t x1,
+            std::array<bool, 3> const& reflect)
+        {
+            Real maxChange = (Real)0;
+            for (size_t xr = x0; xr < x1; ++xr)
+            {
+                size_t yzLevel = level - xr;
+                size_t ymin = (yzLevel > mZBound - 1 ? yzLevel - (mZBound - 1) : 0);
+                size_t ymax = std::min(mYBound - 1, yzLevel);
+                size_t x = (reflect[0] ? mXBound - 1 - xr : xr);
+                for (size_t yr = ymin; yr <= ymax; ++yr)
+                {
+                    size_t zr = yzLevel - yr;
+                    size_t y = (reflect[1] ? mYBound - 1 - yr : yr);
+                    size_t z = (reflect[2] ? mZBound - 1 - zr : zr);
+                    maxChange = std::max(maxChange, Update(x, y, z));
+                }
+            }
+            return maxChange;
+        }
+
+        // Minimum of the valid times of the neighbors i-delta and i+delta,
+        // where the 'hasMinus' and 'hasPlus' indicate whether the neighbors
+        // are in the grid. The function returns maxReal when neither
+        // neighbor has a valid time.
+        inline Real GetNeighborMinimum(size_t i, size_t delta, bool hasMinus,
+            bool hasPlus) const
+        {
+            Real minTime = std::numeric_limits<Real>::max();
+            if (hasMinus)
+            {
+                Real time = mTimes[i - delta];
+                if (time >= (Real)0)
+                {
+                    minTime = time;
+                }
+            }
+            if (hasPlus)
+            {
+                Real time = mTimes[i + delta];
+                if (time >= (Real)0 && time < minTime)
+                {
+                    minTime = time;
+                }
+            }
+            return minTime;
+        }
+
+        // Replace the time of voxel (x,y,z) by the minimum of the time and
+        // the Godunov upwind solution T of
+        //   sum_j max(T - a[j], 0)^2 / h[j]^2 = invSpeed^2
+        // where a[j] is the minimum of the neighbor times along axis j. The
+        // solution is computed for the smallest a[j] first, adding the next
+        // a[j] while the solution is larger than it.
+        Real Update(size_t x, size_t y, size_t z)
+        {
+            size_t const i = Index(x, y, z);
+            Real const oldTime = mTimes[i];
+            if (oldTime <= (Real)0)
+            {
+                // Seeds and zero-speed voxels are not modified.
+                return (Real)0;
+            }
+
+            std::array<Real, 3> a =
+            {
+                GetNeighborMinimum(i, 1, x > 0, x + 1 < mXBound),
+                GetNeighborMinimum(i, mXBound, y > 0, y + 1 < mYBound),
+                GetNeighborMinimum(i, mXYBound, z > 0, z + 1 < mZBound)
+            };
+            std::array<Real, 3> w = mInvSqrSpacing;
+
+            // Sort the (a,w) pairs by increasing a.
+            for (int j0 = 0; j0 < 2; ++j0)
+            {
+                for (int j1 = j0 + 1; j1 < 3; ++j1)
+                {
+                    if (a[j1] < a[j0])
+                    {
+                        std::swap(a[j0], a[j1]);
+                        std::swap(w[j0], w[j1]);
+                    }
+                }
+            }
+
+            Real const maxReal = std::numeric_limits<Real>::max();
+            if (a[0] == maxReal)
+            {
+                // No neighbor has been reached.
+                return (Real)0;
+            }
+
+            Real const invSpeed = mInvSpeeds[i];
+            Real const sqrInvSpeed = invSpeed * invSpeed;
+            Real newTime = a[0] + invSpeed / std::sqrt(w[0]);
+            Real sumW = w[0], sumWA = w[0] * a[0], sumWAA = w[0] * a[0] * a[0];
+            for (int j = 1; j < 3; ++j)
+            {
+                if (newTime <= a[j])
+                {
+                    break;
+                }
+
+                // Solve sumW*T^2 - 2*sumWA*T + sumWAA - invSpeed^2 = 0 for
+                // the larger root.
+                sumW += w[j];
+                sumWA += w[j] * a[j];
+                sumWAA += w[j] * a[j] * a[j];
+                Real discr = sumWA * sumWA - sumW * (sumWAA - sqrInvSpeed);
+                if (discr < (Real)0)
+                {
+                    break;
+                }
+                newTime = (sumWA + std::sqrt(discr)) / sumW;
+            }
+
+            if (newTime < oldTime)
+            {
+                mTimes[i] = newTime;
+                return (oldTime == maxReal ? maxReal : oldTime - newTime);
+            }
+            return (Real)0;
+        }
+
+        size_t mXBound, mYBound, mZBound, mXYBound, mQuantity;
+        std::array<Real, 3> mSpacing, mInvSqrSpacing;
+        std::vector<Real> mTimes;
+        std::vector<Real> mInvSpeeds;
+
+        // Support for multithreading.
+        std::shared_ptr<TaskScheduler> mScheduler;
+        std::vector<Real> mChanges;
+    };
+}
@@ -0,0 +1,549 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/PrimalQuery2.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// Queries about the relation of a point to various geometric objects. The
+// queries have the same semantics as those of PrimalQuery2, but they are
+// filtered. The determinant of each query is computed in double precision
+// together with an a priori bound on the rounding error. When the magnitude
+// of the determinant is larger than the error bound, the sign is certified
+// and returned. Otherwise, the query is computed exactly using the Rational
+// type, which is typically BSNumber or BSRational. The error bounds are the
+// stage-A bounds of
+//   Jonathan Richard Shewchuk, "Adaptive Precision Floating-Point Arithmetic
+//   and Fast Robust Geometric Predicates", Discrete & Computational Geometry
+//   18(3):305-363, October 1997.
+// The bounds are valid only when no underflow occurs. The queries fall back
+// to exact arithmetic when a nonzero coordinate difference is small enough
+// that intermediate products might be subnormal. Overflow produces an
+// infinite or not-a-number determinant or error bound, which also forces
+// the exact computation.
+//
+// The Real type must be 'float' or 'double'; 'float' inputs are converted
+// exactly to 'double'. For typical data, nearly all queries are decided by
+// the filter, so the Rational arithmetic is rarely used. The N values listed
+// in PrimalQuery2 apply to UIntegerFP32<N> when Rational uses that type.
+
+namespace gte
+{
+    template <typename Real, typename Rational = BSNumber<UIntegerAP32>>
+    class FilteredPrimalQuery2
+    {
+    public:
+        // The caller is responsible for ensuring that the array is not empty
+        // before calling queries and that the indices passed to the queries
+        // are valid.  The class does no range checking.
+        FilteredPrimalQuery2()
+            :
+            mNumVertices(0),
+            mVertices(nullptr)
+        {
+            static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value,
+                "Real must be 'float' or 'double'.");
+        }
+
+        FilteredPrimalQuery2(int numVertices, Vector2<Real> const* vertices)
+            :
+            mNumVertices(numVertices),
+            mVertices(vertices)
+        {
+            static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value,
+                "Real must be 'float' or 'double'.");
+        }
+
+        // Member access.
+        inline void Set(int numVertices, Vector2<Real> const* vertices)
+        {
+            mNumVertices = numVertices;
+            mVertices = vertices;
+        }
+
+        inline int GetNumVertices() const
+        {
+            return mNumVertices;
+        }
+
+        inline Vector2<Real> const* GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // In the following, point P refers to vertices[i] or 'test' and Vi
+        // refers to vertices[vi].
+
+        // For a line with origin V0 and direction <V0,V1>, ToLine returns
+        //   +1, P on right of line
+        //   -1, P on left of line
+        //    0, P on the line
+        int ToLine(int i, int v0, int v1) const
+        {
+            return ToLine(mVertices[i], v0, v1);
+        }
+
+        int ToLine(Vector2<Real> const& test, int v0, int v1) const
+        {
+            int sign;
+            if (ToLineFilter(test, mVertices[v0], mVertices[v1], sign))
+            {
+                return sign;
+            }
+
+            std::array<Vector2<Rational>, 3> rVertices =
+            {
+                ToRational(test), ToRational(mVertices[v0]), ToRational(mVertices[v1])
+            };
+            PrimalQuery2<Rational> query(3, rVertices.data());
+            return query.ToLine(0, 1, 2);
+        }
+
+        // For a line with origin V0 and direction <V0,V1>, ToLine returns
+        //   +1, P on right of line
+        //   -1, P on left of line
+        //    0, P on the line
+        // The 'order' parameter is
+        //   -3, points not collinear, P on left of line
+        //   -2, P strictly left of V0 on the line
+        //   -1, P = V0
+        //    0, P interior to line segment [V0,V1]
+        //   +1, P = V1
+        //   +2, P strictly right of V0 on the line
+        int ToLine(int i, int v0, int v1, int& order) const
+        {
+            return ToLine(mVertices[i], v0, v1, order);
+        }
+
+        int ToLine(Vector2<Real> const& test, int v0, int v1, int& order) const
+        {
+            int sign;
+            if (ToLineFilter(test, mVertices[v0], mVertices[v1], sign))
+            {
+                order = 3 * sign;
+                return sign;
+            }
+
+            std::array<Vector2<Rational>, 3> rVertices =
+            {
+                ToRational(test), ToRational(mVertices[v0]), ToRational(mVertices[v1])
+            };
+            PrimalQuery2<Rational> query(3, rVertices.data());
+            return query.ToLine(0, 1, 2, order);
+        }
+
+        // For a triangle with counterclockwise vertices V0, V1, and V2,
+        // ToTriangle returns
+        //   +1, P outside triangle
+        //   -1, P inside triangle
+        //    0, P on triangle
+        int ToTriangle(int i, int v0, int v1, int v2) const
+        {
+            return ToTriangle(mVertices[i], v0, v1, v2);
+        }
+
+        int ToTriangle(Vector2<Real> const& test, int v0, int v1, int v2) const
+        {
+            int sign0 = ToLine(test, v1, v2);
+            if (sign0 > 0)
+            {
+                return +1;
+            }
+
+            int sign1 = ToLine(test, v0, v2);
+            if (sign1 < 0)
+            {
+                return +1;
+            }
+
+            int sign2 = ToLine(test, v0, v1);
+            if (sign2 > 0)
+            {
+                return +1;
+            }
+
+            return ((sign0 && sign1 && sign2) ? -1 : 0);
+        }
+
+        // For a triangle with counterclockwise vertices V0, V1, and V2,
+        // ToCircumcircle returns
+        //   +1, P outside circumcircle of triangle
+        //   -1, P inside circumcircle of triangle
+        //    0, P on circumcircle of triangle
+        int ToCircumcircle(int i, int v0, int v1, int v2) const
+        {
+            return ToCircumcircle(mVertices[i], v0, v1, v2);
+        }
+
+        int ToCircumcircle(Vector2<Real> const& test, int v0, int v1, int v2) const
+        {
+            Vector2<Real> const& vec0 = mVertices[v0];
+            Vector2<Real> const& vec1 = mVertices[v1];
+            Vector2<Real> const& vec2 = mVertices[v2];
+
+            double const tx = static_cast<double>(test[0]);
+            double const ty = static_cast<double>(test[1]);
+            double const x0 = static_cast<double>(vec0[0]) - tx;
+            double const y0 = static_cast<double>(vec0[1]) - ty;
+            double const x1 = static_cast<double>(vec1[0]) - tx;
+            double const y1 = static_cast<double>(vec1[1]) - ty;
+            double const x2 = static_cast<double>(vec2[0]) - tx;
+            double const y2 = static_cast<double>(vec2[1]) - ty;
+
+            // The determinant is that of PrimalQuery2::ToCircumcircle. The
+            // third column is written as the squared length of the row
+            // differences, which differs from the PrimalQuery2 column by a
+            // linear combination of the first two columns.
+            std::array<double, 6> const diff = { x0, y0, x1, y1, x2, y2 };
+            if (IsFilterable(diff, GetCircumcircleMinMagnitude()))
+            {
+                double const x1y2 = x1 * y2, x2y1 = x2 * y1;
+                double const x2y0 = x2 * y0, x0y2 = x0 * y2;
+                double const x0y1 = x0 * y1, x1y0 = x1 * y0;
+                double const lift0 = x0 * x0 + y0 * y0;
+                double const lift1 = x1 * x1 + y1 * y1;
+                double const lift2 = x2 * x2 + y2 * y2;
+                double const det =
+                    lift0 * (x1y2 - x2y1) +
+                    lift1 * (x2y0 - x0y2) +
+                    lift2 * (x0y1 - x1y0);
+                double const permanent =
+                    (std::fabs(x1y2) + std::fabs(x2y1)) * lift0 +
+                    (std::fabs(x2y0) + std::fabs(x0y2)) * lift1 +
+                    (std::fabs(x0y1) + std::fabs(x1y0)) * lift2;
+                double const epsilon = GetEpsilon();
+                double const errorBound = (10.0 + 96.0 * epsilon) * epsilon * permanent;
+                if (det > errorBound)
+                {
+                    return -1;
+                }
+                if (-det > errorBound)
+                {
+                    return +1;
+                }
+            }
+
+            std::array<Vector2<Rational>, 4> rVertices =
+            {
+                ToRational(test), ToRational(vec0), ToRational(vec1), ToRational(vec2)
+            };
+            PrimalQuery2<Rational> query(4, rVertices.data());
+            return query.ToCircumcircle(0, 1, 2, 3);
+        }
+
+        // For the circle with diameter segment <V0,V1>, ToDiametralCircle
+        // returns
+        //   +1, P outside the circle
+        //   -1, P inside the circle
+        //    0, P on the circle
+        // The sign is that of Dot(P-V0,P-V1), which has the expression tree
+        // of ToLine, so the N values for Rational are those of ToLine.
+        int ToDiametralCircle(int i, int v0, int v1) const
+        {
+            return ToDiametralCircle(mVertices[i], v0, v1);
+        }
+
+        int ToDiametralCircle(Vector2<Real> const& test, int v0, int v1) const
+        {
+            Vector2<Real> const& vec0 = mVertices[v0];
+            Vector2<Real> const& vec1 = mVertices[v1];
+            double const x0 = static_cast<double>(test[0]) - static_cast<double>(vec0[0]);
+            double const y0 = static_cast<double>(test[1]) - static_cast<double>(vec0[1]);
+            double const x1 = static_cast<double>(test[0]) - static_cast<double>(vec1[0]);
+            double const y1 = static_cast<double>(test[1]) - static_cast<double>(vec1[1]);
+            std::array<double, 4> const diff = { x0, y0, x1, y1 };
+            if (IsFilterable(diff, GetLineMinMagnitude()))
+            {
+                double const x0x1 = x0 * x1;
+                double const y0y1 = y0 * y1;
+                double const dot = x0x1 + y0y1;
+                double const permanent = std::fabs(x0x1) + std::fabs(y0y1);
+                double const epsilon = GetEpsilon();
+                double const errorBound = (3.0 + 16.0 * epsilon) * epsilon * permanent;
+                if (dot > errorBound)
+                {
+                    return +1;
+                }
+                if (-dot > errorBound)
+                {
+                    return -1;
+                }
+            }
+
+            Vector2<Rational> rTest = ToRational(test);
+            Rational rDot = Dot(rTest - ToRational(vec0), rTest - ToRational(vec1));
+            return rDot.GetSign();
+        }
+
+        // An extended classification of the relationship of a point to a line
+        // segment. See PrimalQuery2::ToLineExtended for the descriptions.
+        using OrderType = typename PrimalQuery2<Rational>::OrderType;
+
+        OrderType ToLineExtended(Vector2<Real> const& P, Vector2<Real> const& Q0, Vector2<Real> const& Q1) const
+        {
+            // The differences of floating-point numbers are zero if and only
+            // if the numbers are equal, so the equality tests are exact.
+            if (Q0 == Q1)
+            {
+                return PrimalQuery2<Rational>::ORDER_Q0_EQUALS_Q1;
+            }
+
+            if (P == Q0)
+            {
+                return PrimalQuery2<Rational>::ORDER_P_EQUALS_Q0;
+            }
+
+            if (P == Q1)
+            {
+                return PrimalQuery2<Rational>::ORDER_P_EQUALS_Q1;
+            }
+
+            // ToLineExtended computes det = Dot(Q1-Q0,Perp(P-Q0)), which is
+            // the negative of the ToLine determinant for test P and line
+            // origin Q0 and direction Q1-Q0.
+            int sign;
+            if (ToLineFilter(P, Q0, Q1, sign))
+            {
+                return (sign < 0 ? PrimalQuery2<Rational>::ORDER_POSITIVE :
+                    PrimalQuery2<Rational>::ORDER_NEGATIVE);
+            }
+
+            PrimalQuery2<Rational> query;
+            return query.ToLineExtended(ToRational(P), ToRational(Q0), ToRational(Q1));
+        }
+
+        // Batch queries for classifying many points against the same line
+        // or circle. The Filter* functions evaluate the determinant of each
+        // point and its error bound, which is the radius of an interval
+        // centered at the computed determinant. This midpoint-radius
+        // interval arithmetic needs neither the rounding-mode changes of
+        // FPInterval nor the nextafter calls of SWInterval, and the loops
+        // are free of branches so that the compiler can vectorize them. On
+        // return, signs[i] is +1 or -1 when the sign of the query for
+        // points[i] is certified and 0 when the query must be computed
+        // exactly. The return value is the number of points that need the
+        // exact computation. The ToLine and ToCircumcircle batch functions
+        // apply the filter and then compute the uncertified signs exactly,
+        // so on return all signs are those of the single-point queries.
+        static size_t FilterToLine(size_t numPoints, Vector2<Real> const* points,
+            Vector2<Real> const& vec0, Vector2<Real> const& vec1, int* signs)
+        {
+            double const v00 = static_cast<double>(vec0[0]);
+            double const v01 = static_cast<double>(vec0[1]);
+            double const x1 = static_cast<double>(vec1[0]) - v00;
+            double const y1 = static_cast<double>(vec1[1]) - v01;
+            double const minMagnitude = GetLineMinMagnitude();
+            std::array<double, 2> const diff = { x1, y1 };
+            if (!IsFilterable(diff, minMagnitude))
+            {
+                std::fill(signs, signs + numPoints, 0);
+                return numPoints;
+            }
+
+            double const epsilon = GetEpsilon();
+            double const coefficient = (3.0 + 16.0 * epsilon) * epsilon;
+            size_t numUnknown = 0;
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                double const x0 = static_cast<double>(points[i][0]) - v00;
+                double const y0 = static_cast<double>(points[i][1]) - v01;
+                double const x0y1 = x0 * y1;
+                double const x1y0 = x1 * y0;
+                double const det = x0y1 - x1y0;
+                double const errorBound = coefficient * (std::fabs(x0y1) + std::fabs(x1y0));
+                int const valid = static_cast<int>(IsNotSmall(x0, minMagnitude) & IsNotSmall(y0, minMagnitude));
+                int const sign = static_cast<int>(det > errorBound) - static_cast<int>(-det > errorBound);
+                signs[i] = sign * valid;
+                numUnknown += static_cast<size_t>(signs[i] == 0);
+            }
+            return numUnknown;
+        }
+
+        static size_t FilterToCircumcircle(size_t numPoints, Vector2<Real> const* points,
+            Vector2<Real> const& vec0, Vector2<Real> const& vec1, Vector2<Real> const& vec2,
+            int* signs)
+        {
+            double const v00 = static_cast<double>(vec0[0]);
+            double const v01 = static_cast<double>(vec0[1]);
+            double const v10 = static_cast<double>(vec1[0]);
+            double const v11 = static_cast<double>(vec1[1]);
+            double const v20 = static_cast<double>(vec2[0]);
+            double const v21 = static_cast<double>(vec2[1]);
+            double const minMagnitude = GetCircumcircleMinMagnitude();
+            double const epsilon = GetEpsilon();
+            double const coefficient = (10.0 + 96.0 * epsilon) * epsilon;
+            size_t numUnknown = 0;
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                double const tx = static_cast<double>(points[i][0]);
+                double const ty = static_cast<double>(points[i][1]);
+                double const x0 = v00 - tx, y0 = v01 - ty;
+                double const x1 = v10 - tx, y1 = v11 - ty;
+                double const x2 = v20 - tx, y2 = v21 - ty;
+                double const x1y2 = x1 * y2, x2y1 = x2 * y1;
+                double const x2y0 = x2 * y0, x0y2 = x0 * y2;
+                double const x0y1 = x0 * y1, x1y0 = x1 * y0;
+                double const lift0 = x0 * x0 + y0 * y0;
+                double const lift1 = x1 * x1 + y1 * y1;
+                double const lift2 = x2 * x2 + y2 * y2;
+                double const det =
+                    lift0 * (x1y2 - x2y1) +
+                    lift1 * (x2y0 - x0y2) +
+                    lift2 * (x0y1 - x1y0);
+                double const permanent =
+                    (std::fabs(x1y2) + std::fabs(x2y1)) * lift0 +
+                    (std::fabs(x2y0) + std::fabs(x0y2)) * lift1 +
+                    (std::fabs(x0y1) + std::fabs(x1y0)) * lift2;
+                double const errorBound = coefficient * permanent;
+                int const valid = static_cast<int>(
+                    IsNotSmall(x0, minMagnitude) & IsNotSmall(y0, minMagnitude) &
+                    IsNotSmall(x1, minMagnitude) & IsNotSmall(y1, minMagnitude) &
+                    IsNotSmall(x2, minMagnitude) & IsNotSmall(y2, minMagnitude));
+
+                // A positive determinant means P is inside the circle.
+                int const sign = static_cast<int>(-det > errorBound) - static_cast<int>(det > errorBound);
+                signs[i] = sign * valid;
+                numUnknown += static_cast<size_t>(signs[i] == 0);
+            }
+            return numUnknown;
+        }
+
+        void ToLine(size_t numPoints, Vector2<Real> const* points, int v0, int v1,
+            int* signs) const
+        {
+            Vector2<Real> const& vec0 = mVertices[v0];
+            Vector2<Real> const& vec1 = mVertices[v1];
+            if (FilterToLine(numPoints, points, vec0, vec1, signs) > 0)
+            {
+                std::array<Vector2<Rational>, 3> rVertices =
+                {
+                    Vector2<Rational>{}, ToRational(vec0), ToRational(vec1)
+                };
+                PrimalQuery2<Rational> query(3, rVertices.data());
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    if (signs[i] == 0)
+                    {
+                        rVertices[0] = ToRational(points[i]);
+                        signs[i] = query.ToLine(0, 1, 2);
+                    }
+                }
+            }
+        }
+
+        void ToCircumcircle(size_t numPoints, Vector2<Real> const* points, int v0, int v1,
+            int v2, int* signs) const
+        {
+            Vector2<Real> const& vec0 = mVertices[v0];
+            Vector2<Real> const& vec1 = mVertices[v1];
+            Vector2<Real> const& vec2 = mVertices[v2];
+            if (FilterToCircumcircle(numPoints, points, vec0, vec1, vec2, signs) > 0)
+            {
+                std::array<Vector2<Rational>, 4> rVertices =
+                {
+                    Vector2<Rational>{}, ToRational(vec0), ToRational(vec1), ToRational(vec2)
+                };
+                PrimalQuery2<Rational> query(4, rVertices.data());
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    if (signs[i] == 0)
+                    {
+                        rVertices[0] = ToRational(points[i]);
+                        signs[i] = query.ToCircumcircle(0, 1, 2, 3);
+                    }
+                }
+            }
+        }
+
+    private:
+        // The unit roundoff for 'double', 2^{-53}.
+        inline static double GetEpsilon()
+        {
+            return 0.5 * std::numeric_limits<double>::epsilon();
+        }
+
+        // The filters are applied only when all nonzero coordinate
+        // differences have magnitudes at least these values. The values
+        // guarantee that no product in the determinant evaluation, including
+        // those of differences with cancellation, is subnormal.
+        inline static double GetLineMinMagnitude()
+        {
+            return std::ldexp(1.0, -480);
+        }
+
+        inline static double GetCircumcircleMinMagnitude()
+        {
+            return std::ldexp(1.0, -225);
+        }
+
+        template <size_t NumDiff>
+        static bool IsFilterable(std::array<double, NumDiff> const& diff, double minMagnitude)
+        {
+            for (auto const& d : diff)
+            {
+                if (d != 0.0 && std::fabs(d) < minMagnitude)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // The branch-free form of the IsFilterable test for one difference.
+        inline static bool IsNotSmall(double d, double minMagnitude)
+        {
+            return (d == 0.0) | (std::fabs(d) >= minMagnitude);
+        }
+
+        // The function returns 'true' when the sign of the ToLine
+        // determinant is certified, in which case 'sign' is +1 or -1.
+        static bool ToLineFilter(Vector2<Real> const& test, Vector2<Real> const& vec0,
+            Vector2<Real> const& vec1, int& sign)
+        {
+            double const x0 = static_cast<double>(test[0]) - static_cast<double>(vec0[0]);
+            double const y0 = static_cast<double>(test[1]) - static_cast<double>(vec0[1]);
+            double const x1 = static_cast<double>(vec1[0]) - static_cast<double>(vec0[0]);
+            double const y1 = static_cast<double>(vec1[1]) - static_cast<double>(vec0[1]);
+            std::array<double, 4> const diff = { x0, y0, x1, y1 };
+            if (IsFilterable(diff, GetLineMinMagnitude()))
+            {
+                double const x0y1 = x0 * y1;
+                double const x1y0 = x1 * y0;
+                double const det = x0y1 - x1y0;
+                double const permanent = std::fabs(x0y1) + std::fabs(x1y0);
+                double const epsilon = GetEpsilon();
+                double const errorBound = (3.0 + 16.0 * epsilon) * epsilon * permanent;
+                if (det > errorBound)
+                {
+                    sign = +1;
+                    return true;
+                }
+                if (-det > errorBound)
+                {
+                    sign = -1;
+                    return true;
+                }
+            }
+            sign = 0;
+            return false;
+        }
+
+        inline static Vector2<Rational> ToRational(Vector2<Real> const& v)
+        {
+            return Vector2<Rational>{ Rational(v[0]), Rational(v[1]) };
+        }
+
+        int mNumVertices;
+        Vector2<Real> const* mVertices;
+    };
+}
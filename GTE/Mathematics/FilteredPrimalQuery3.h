@@ -0,0 +1,324 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/PrimalQuery3.h>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// Queries about the relation of a point to various geometric objects. The
+// queries have the same semantics as those of PrimalQuery3, but they are
+// filtered. The determinant of each query is computed in double precision
+// together with an a priori bound on the rounding error. When the magnitude
+// of the determinant is larger than the error bound, the sign is certified
+// and returned. Otherwise, the query is computed exactly using the Rational
+// type. See FilteredPrimalQuery2.h for a description of the error bounds and
+// of the handling of underflow and overflow.
+//
+// The Real type must be 'float' or 'double'; 'float' inputs are converted
+// exactly to 'double'. The N values listed in PrimalQuery3 apply to
+// UIntegerFP32<N> when Rational uses that type.
+
+namespace gte
+{
+    template <typename Real, typename Rational = BSNumber<UIntegerAP32>>
+    class FilteredPrimalQuery3
+    {
+    public:
+        // The caller is responsible for ensuring that the array is not empty
+        // before calling queries and that the indices passed to the queries
+        // are valid.  The class does no range checking.
+        FilteredPrimalQuery3()
+            :
+            mNumVertices(0),
+            mVertices(nullptr)
+        {
+            static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value,
+                "Real must be 'float' or 'double'.");
+        }
+
+        FilteredPrimalQuery3(int numVertices, Vector3<Real> const* vertices)
+            :
+            mNumVertices(numVertices),
+            mVertices(vertices)
+        {
+            static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value,
+                "Real must be 'float' or 'double'.");
+        }
+
+        // Member access.
+        inline void Set(int numVertices, Vector3<Real> const* vertices)
+        {
+            mNumVertices = numVertices;
+            mVertices = vertices;
+        }
+
+        inline int GetNumVertices() const
+        {
+            return mNumVertices;
+        }
+
+        inline Vector3<Real> const* GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // In the following, point P refers to vertices[i] or 'test' and Vi
+        // refers to vertices[vi].
+
+        // For a plane with origin V0 and normal N = Cross(V1-V0,V2-V0),
+        // ToPlane returns
+        //   +1, P on positive side of plane (side to which N points)
+        //   -1, P on negative side of plane (side to which -N points)
+        //    0, P on the plane
+        int ToPlane(int i, int v0, int v1, int v2) const
+        {
+            return ToPlane(mVertices[i], v0, v1, v2);
+        }
+
+        int ToPlane(Vector3<Real> const& test, int v0, int v1, int v2) const
+        {
+            Vector3<Real> const& vec0 = mVertices[v0];
+            Vector3<Real> const& vec1 = mVertices[v1];
+            Vector3<Real> const& vec2 = mVertices[v2];
+
+            double const ox = static_cast<double>(vec0[0]);
+            double const oy = static_cast<double>(vec0[1]);
+            double const oz = static_cast<double>(vec0[2]);
+            double const x0 = static_cast<double>(test[0]) - ox;
+            double const y0 = static_cast<double>(test[1]) - oy;
+            double const z0 = static_cast<double>(test[2]) - oz;
+            double const x1 = static_cast<double>(vec1[0]) - ox;
+            double const y1 = static_cast<double>(vec1[1]) - oy;
+            double const z1 = static_cast<double>(vec1[2]) - oz;
+            double const x2 = static_cast<double>(vec2[0]) - ox;
+            double const y2 = static_cast<double>(vec2[1]) - oy;
+            double const z2 = static_cast<double>(vec2[2]) - oz;
+
+            std::array<double, 9> const diff = { x0, y0, z0, x1, y1, z1, x2, y2, z2 };
+            if (IsFilterable(diff, GetPlaneMinMagnitude()))
+            {
+                double const y1z2 = y1 * z2, y2z1 = y2 * z1;
+                double const y2z0 = y2 * z0, y0z2 = y0 * z2;
+                double const y0z1 = y0 * z1, y1z0 = y1 * z0;
+                double const det =
+                    x0 * (y1z2 - y2z1) +
+                    x1 * (y2z0 - y0z2) +
+                    x2 * (y0z1 - y1z0);
+                double const permanent =
+                    (std::fabs(y1z2) + std::fabs(y2z1)) * std::fabs(x0) +
+                    (std::fabs(y2z0) + std::fabs(y0z2)) * std::fabs(x1) +
+                    (std::fabs(y0z1) + std::fabs(y1z0)) * std::fabs(x2);
+                double const epsilon = GetEpsilon();
+                double const errorBound = (7.0 + 56.0 * epsilon) * epsilon * permanent;
+                if (det > errorBound)
+                {
+                    return +1;
+                }
+                if (-det > errorBound)
+                {
+                    return -1;
+                }
+            }
+
+            std::array<Vector3<Rational>, 4> rVertices =
+            {
+                ToRational(test), ToRational(vec0), ToRational(vec1), ToRational(vec2)
+            };
+            PrimalQuery3<Rational> query(4, rVertices.data());
+            return query.ToPlane(0, 1, 2, 3);
+        }
+
+        // For a tetrahedron with vertices ordered as described in the file
+        // TetrahedronKey.h, the function returns
+        //   +1, P outside tetrahedron
+        //   -1, P inside tetrahedron
+        //    0, P on tetrahedron
+        int ToTetrahedron(int i, int v0, int v1, int v2, int v3) const
+        {
+            return ToTetrahedron(mVertices[i], v0, v1, v2, v3);
+        }
+
+        int ToTetrahedron(Vector3<Real> const& test, int v0, int v1, int v2, int v3) const
+        {
+            int sign0 = ToPlane(test, v1, v2, v3);
+            if (sign0 > 0)
+            {
+                return +1;
+            }
+
+            int sign1 = ToPlane(test, v0, v2, v3);
+            if (sign1 < 0)
+            {
+                return +1;
+            }
+
+            int sign2 = ToPlane(test, v0, v1, v3);
+            if (sign2 > 0)
+            {
+                return +1;
+            }
+
+            int sign3 = ToPlane(test, v0, v1, v2);
+            if (sign3 < 0)
+            {
+                return +1;
+            }
+
+            return ((sign0 && sign1 && sign2 && sign3) ? -1 : 0);
+        }
+
+        // For a tetrahedron with vertices ordered as described in the file
+        // TetrahedronKey.h, the function returns
+        //   +1, P outside circumsphere of tetrahedron
+        //   -1, P inside circumsphere of tetrahedron
+        //    0, P on circumsphere of tetrahedron
+        int ToCircumsphere(int i, int v0, int v1, int v2, int v3) const
+        {
+            return ToCircumsphere(mVertices[i], v0, v1, v2, v3);
+        }
+
+        int ToCircumsphere(Vector3<Real> const& test, int v0, int v1, int v2, int v3) const
+        {
+            Vector3<Real> const& vec0 = mVertices[v0];
+            Vector3<Real> const& vec1 = mVertices[v1];
+            Vector3<Real> const& vec2 = mVertices[v2];
+            Vector3<Real> const& vec3 = mVertices[v3];
+
+            double const tx = static_cast<double>(test[0]);
+            double const ty = static_cast<double>(test[1]);
+            double const tz = static_cast<double>(test[2]);
+            double const x0 = static_cast<double>(vec0[0]) - tx;
+            double const y0 = static_cast<double>(vec0[1]) - ty;
+            double const z0 = static_cast<double>(vec0[2]) - tz;
+            double const x1 = static_cast<double>(vec1[0]) - tx;
+            double const y1 = static_cast<double>(vec1[1]) - ty;
+            double const z1 = static_cast<double>(vec1[2]) - tz;
+            double const x2 = static_cast<double>(vec2[0]) - tx;
+            double const y2 = static_cast<double>(vec2[1]) - ty;
+            double const z2 = static_cast<double>(vec2[2]) - tz;
+            double const x3 = static_cast<double>(vec3[0]) - tx;
+            double const y3 = static_cast<double>(vec3[1]) - ty;
+            double const z3 = static_cast<double>(vec3[2]) - tz;
+
+            // The determinant is that of PrimalQuery3::ToCircumsphere. The
+            // fourth column is written as the squared length of the row
+            // differences, which differs from the PrimalQuery3 column by a
+            // linear combination of the first three columns.
+            std::array<double, 12> const diff =
+            {
+                x0, y0, z0, x1, y1, z1, x2, y2, z2, x3, y3, z3
+            };
+            if (IsFilterable(diff, GetCircumsphereMinMagnitude()))
+            {
+                double const x0y1 = x0 * y1, x1y0 = x1 * y0;
+                double const x1y2 = x1 * y2, x2y1 = x2 * y1;
+                double const x2y3 = x2 * y3, x3y2 = x3 * y2;
+                double const x3y0 = x3 * y0, x0y3 = x0 * y3;
+                double const x0y2 = x0 * y2, x2y0 = x2 * y0;
+                double const x1y3 = x1 * y3, x3y1 = x3 * y1;
+                double const a01 = x0y1 - x1y0;
+                double const a12 = x1y2 - x2y1;
+                double const a23 = x2y3 - x3y2;
+                double const a30 = x3y0 - x0y3;
+                double const a02 = x0y2 - x2y0;
+                double const a13 = x1y3 - x3y1;
+
+                double const c012 = z0 * a12 - z1 * a02 + z2 * a01;
+                double const c123 = z1 * a23 - z2 * a13 + z3 * a12;
+                double const c230 = z2 * a30 + z3 * a02 + z0 * a23;
+                double const c301 = z3 * a01 + z0 * a13 + z1 * a30;
+
+                double const lift0 = x0 * x0 + y0 * y0 + z0 * z0;
+                double const lift1 = x1 * x1 + y1 * y1 + z1 * z1;
+                double const lift2 = x2 * x2 + y2 * y2 + z2 * z2;
+                double const lift3 = x3 * x3 + y3 * y3 + z3 * z3;
+
+                double const det = (lift3 * c012 - lift2 * c301) + (lift1 * c230 - lift0 * c123);
+
+                double const az0 = std::fabs(z0), az1 = std::fabs(z1);
+                double const az2 = std::fabs(z2), az3 = std::fabs(z3);
+                double const p01 = std::fabs(x0y1) + std::fabs(x1y0);
+                double const p12 = std::fabs(x1y2) + std::fabs(x2y1);
+                double const p23 = std::fabs(x2y3) + std::fabs(x3y2);
+                double const p30 = std::fabs(x3y0) + std::fabs(x0y3);
+                double const p02 = std::fabs(x0y2) + std::fabs(x2y0);
+                double const p13 = std::fabs(x1y3) + std::fabs(x3y1);
+                double const permanent =
+                    (p23 * az1 + p13 * az2 + p12 * az3) * lift0 +
+                    (p30 * az2 + p02 * az3 + p23 * az0) * lift1 +
+                    (p01 * az3 + p13 * az0 + p30 * az1) * lift2 +
+                    (p12 * az0 + p02 * az1 + p01 * az2) * lift3;
+                double const epsilon = GetEpsilon();
+                double const errorBound = (16.0 + 224.0 * epsilon) * epsilon * permanent;
+
+                if (det > errorBound)
+                {
+                    return +1;
+                }
+                if (-det > errorBound)
+                {
+                    return -1;
+                }
+            }
+
+            std::array<Vector3<Rational>, 5> rVertices =
+            {
+                ToRational(test), ToRational(vec0), ToRational(vec1),
+                ToRational(vec2), ToRational(vec3)
+            };
+            PrimalQuery3<Rational> query(5, rVertices.data());
+            return query.ToCircumsphere(0, 1, 2, 3, 4);
+        }
+
+    private:
+        // The unit roundoff for 'double', 2^{-53}.
+        inline static double GetEpsilon()
+        {
+            return 0.5 * std::numeric_limits<double>::epsilon();
+        }
+
+        // The filters are applied only when all nonzero coordinate
+        // differences have magnitudes at least these values. The values
+        // guarantee that no product in the determinant evaluation, including
+        // those of differences with cancellation, is subnormal.
+        inline static double GetPlaneMinMagnitude()
+        {
+            return std::ldexp(1.0, -300);
+        }
+
+        inline static double GetCircumsphereMinMagnitude()
+        {
+            return std::ldexp(1.0, -160);
+        }
+
+        template <size_t NumDiff>
+        static bool IsFilterable(std::array<double, NumDiff> const& diff, double minMagnitude)
+        {
+            for (auto const& d : diff)
+            {
+                if (d != 0.0 && std::fabs(d) < minMagnitude)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline static Vector3<Rational> ToRational(Vector3<Real> const& v)
+        {
+            return Vector3<Rational>{ Rational(v[0]), Rational(v[1]), Rational(v[2]) };
+        }
+
+        int mNumVertices;
+        Vector3<Real> const* mVertices;
+    };
+}
@@ -0,0 +1,980 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BSPrecisionPredicates.h>
+#include <Mathematics/ConvexHull2MonotoneChain.h>
+#include <Mathematics/FilteredPrimalQuery2.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// Delaunay triangulation of 2D points by rounds of parallel point insertion
+// and parallel edge flipping, followed by a serial fix-up pass with exact
+// predicates. The parallel part is designed for a GPU; the class
+// GPUFlipDelaunay2 in MathematicsGPU derives from FlipDelaunay2 and
+// replaces InsertPoints() with compute shaders. The FlipDelaunay2
+// implementation of InsertPoints() executes the same kernels serially, one
+// loop iteration per GPU thread, and is the reference for the shaders. The
+// algorithm is similar to that of
+//   Meng Qi, Thanh-Tung Cao and Tiow-Seng Tan, "Computing 2D Constrained
+//   Delaunay Triangulation Using the GPU", IEEE Transactions on
+//   Visualization and Computer Graphics 19(5):736-748, 2013.
+//
+// The convex hull of the points is computed first and fan-triangulated.
+// Each round, every triangle that contains uninserted points is split into
+// three triangles at one of them, the one with minimum key. The keys are a
+// pseudorandom permutation of the point indices, so the selection behaves
+// like a randomized insertion order even for gridded input. The triangles
+// are then made locally Delaunay by passes of edge flips; a pass flips a set
+// of edges that share no triangles. After each split or flip pass, the
+// uninserted points in the modified triangles are relocated to the new
+// triangles. The splits and flips use only floating-point predicates with
+// an error bound (the stage-A filters of FilteredPrimalQuery2), and an
+// operation is applied only when its predicates are certified. A point
+// whose location is uncertain, for example a duplicate, is not inserted,
+// and an edge whose circumcircle test is uncertain is not flipped. When the
+// coordinates are such that the orientation determinant is exact in
+// 'double', as for points sampled from a grid, a point on an edge is
+// inserted by splitting the triangles that share the edge; otherwise, the
+// point is not inserted. The parallel phase therefore always produces a
+// valid triangulation of the points it inserted. The fix-up pass flips the
+// edges that are not locally Delaunay and inserts the remaining points,
+// using exact predicates.
+//
+// The triangle and adjacency arrays are compatible with ETManifoldMesh and
+// with the Delaunay2 arrays. The triangle vertices are counterclockwise. The
+// adjacent triangle of index 3*t+j shares the edge <V[j],V[(j+1)%3]> of
+// triangle t, where V[] are the vertices of triangle t, and is -1 when the
+// edge is on the convex hull. Duplicated input points occur only once in
+// the triangulation. The Delaunay triangulation of cocircular points is not
+// unique; the triangulation is one of them.
+
+namespace gte
+{
+    class FlipDelaunay2
+    {
+    public:
+        // Supporting types for the exact predicates of the fix-up pass.
+        using Rational = BSPrecisionPredicates::ToCircumcircleNumber<float>;
+        using Query = FilteredPrimalQuery2<float, Rational>;
+
+        // The number of flip passes after each insertion round is at most
+        // maxFlipPasses. The fix-up pass repairs the edges that are still
+        // not locally Delaunay at the end of the parallel phase.
+        FlipDelaunay2(int maxFlipPasses = 16)
+            :
+            mMaxFlipPasses(maxFlipPasses),
+            mNumPoints(0),
+            mPoints(nullptr),
+            mExactOrient(false),
+            mNumTriangles(0),
+            mNumFixupFlips(0),
+            mNumFixupInsertions(0)
+        {
+            LogAssert(maxFlipPasses >= 0, "Invalid number of flip passes.");
+        }
+
+        virtual ~FlipDelaunay2() = default;
+
+        // The points are not copied; the array must persist during the call.
+        // The number of points must be at most 2^30. The return value
+        // is 'true' when the points are not collinear. Otherwise, there are
+        // no triangles.
+        bool operator()(int numPoints, Vector2<float> const* points)
+        {
+            LogAssert(numPoints >= 0 && (numPoints == 0 || points != nullptr),
+                "Invalid argument.");
+
+            mNumPoints = numPoints;
+            mPoints = points;
+            mQuery.Set(numPoints, points);
+            mNumTriangles = 0;
+            mNumFixupFlips = 0;
+            mNumFixupInsertions = 0;
+            mIndices.clear();
+            mAdjacencies.clear();
+
+            if (!CreateHullFan())
+            {
+                return false;
+            }
+
+            InsertPoints();
+            FixupTriangulation();
+
+            mIndices.resize(3 * static_cast<size_t>(mNumTriangles));
+            mAdjacencies.resize(3 * static_cast<size_t>(mNumTriangles));
+            for (int32_t t = 0, k = 0; t < mNumTriangles; ++t)
+            {
+                for (int32_t j = 0; j < 3; ++j, ++k)
+                {
+                    mIndices[k] = mTriangles[t][j];
+                    mAdjacencies[k] = mAdjacent[t][j];
+                }
+            }
+            return true;
+        }
+
+        // Member access.
+        inline int GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline Vector2<float> const* GetPoints() const
+        {
+            return mPoints;
+        }
+
+        inline int GetNumTriangles() const
+        {
+            return static_cast<int>(mNumTriangles);
+        }
+
+        inline std::vector<int> const& GetIndices() const
+        {
+            return mIndices;
+        }
+
+        inline std::vector<int> const& GetAdjacencies() const
+        {
+            return mAdjacencies;
+        }
+
+        // The work of the fix-up pass, which measures how much of the
+        // triangulation was done by the parallel phase.
+        inline size_t GetNumFixupFlips() const
+        {
+            return mNumFixupFlips;
+        }
+
+        inline size_t GetNumFixupInsertions() const
+        {
+            return mNumFixupInsertions;
+        }
+
+    protected:
+        // The triangle has no vote and the triangle has no flip lock.
+        static uint32_t constexpr msNone = 0xFFFFFFFFu;
+
+        // The vote key of point p is p*msKeyMultiplier (mod 2^31), a
+        // bijection of the 31-bit integers whose inverse is multiplication
+        // by msKeyInverse (mod 2^31). Bit 31 of the key is set for a point
+        // on an edge, so a point inside the triangle always wins the vote.
+        // The key msNone belongs to p = 1903481007, which is larger than
+        // any valid point index.
+        static uint32_t constexpr msKeyMultiplier = 0x9E3779B1u;
+        static uint32_t constexpr msKeyInverse = 0x0E8B2F51u;
+
+        // The parallel phase. On entry, mTriangles[t] and mAdjacent[t] for
+        // 0 <= t < mNumTriangles are a fan triangulation of the convex hull,
+        // and mLocations[p] is the triangle that contains point p or -1 when
+        // p is a hull vertex. The other arrays are initialized by
+        // CreateHullFan. On exit, the arrays must describe a triangulation of
+        // the points p with mLocations[p] = -1. The mLocations[p] of the
+        // other points are hints for the fix-up pass; each must be a valid
+        // triangle index. Every array has mTriangles.size() elements except
+        // mLocations and mNeighbors, which have mNumPoints elements. The
+        // flag mExactOrient is also set by CreateHullFan. The last component
+        // of the mTriangles and mAdjacent elements is unused and exists so
+        // that the elements are 16-byte aligned on the GPU.
+        virtual void InsertPoints()
+        {
+            int32_t stamp = 0;
+            for (;;)
+            {
+                for (int32_t p = 0; p < mNumPoints; ++p)
+                {
+                    Vote(p);
+                }
+
+                int32_t const numTriangles = mNumTriangles;
+                int32_t numSplits = 0;
+                for (int32_t t = 0; t < numTriangles; ++t)
+                {
+                    numSplits += Split(t, stamp);
+                }
+                if (numSplits == 0)
+                {
+                    break;
+                }
+
+                UpdatePass(stamp++);
+
+                for (int pass = 0; pass < mMaxFlipPasses; ++pass)
+                {
+                    for (int32_t t = 0; t < mNumTriangles; ++t)
+                    {
+                        MarkFlip(t);
+                    }
+
+                    int32_t numFlips = 0;
+                    for (int32_t t = 0; t < mNumTriangles; ++t)
+                    {
+                        numFlips += Flip(t, stamp);
+                    }
+                    if (numFlips == 0)
+                    {
+                        break;
+                    }
+
+                    UpdatePass(stamp++);
+                }
+            }
+        }
+
+        // The kernels of the parallel phase. The shaders of GPUFlipDelaunay2
+        // are translations of these functions. In each kernel, a thread
+        // writes only the data of its own point or triangle, except that
+        // Split writes the two triangles it allocates, Flip writes the
+        // neighbor across the flipped edge (locked by MarkFlip) and the
+        // atomic operations on mVotes, mLocks and mNumTriangles.
+
+        // The point votes for its triangle when it is certified to be
+        // strictly inside the triangle. When the orientations are exact
+        // (see mExactOrient), a point in the interior of an edge votes for
+        // both triangles that share the edge, and mNeighbors[p] is the
+        // triangle across the edge, or -1 for a hull edge. Otherwise,
+        // mNeighbors[p] is -1.
+        void Vote(int32_t p)
+        {
+            int32_t const t = mLocations[p];
+            if (t < 0)
+            {
+                return;
+            }
+
+            auto const& tri = mTriangles[t];
+            int32_t numPositive = 0, zero = -1;
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                int const sign = Orient(tri[j], tri[(j + 1) % 3], p);
+                if (sign > 0)
+                {
+                    ++numPositive;
+                }
+                else if (sign == 0 && mExactOrient)
+                {
+                    zero = j;
+                }
+            }
+
+            uint32_t key = (static_cast<uint32_t>(p) * msKeyMultiplier) & 0x7FFFFFFFu;
+            if (numPositive == 3)
+            {
+                mNeighbors[p] = -1;
+                mVotes[t] = std::min(mVotes[t], key);
+            }
+            else if (numPositive == 2 && zero >= 0)
+            {
+                int32_t const n = mAdjacent[t][zero];
+                mNeighbors[p] = n;
+                key |= 0x80000000u;
+                mVotes[t] = std::min(mVotes[t], key);
+                if (n >= 0)
+                {
+                    mVotes[n] = std::min(mVotes[n], key);
+                }
+            }
+        }
+
+        // Insert the winner q of the vote of triangle t. A triangle
+        // <v0,v1,v2> that contains q is split into <v0,v1,q>, <v1,v2,q> and
+        // <v2,v0,q>; the first triangle reuses the slot t, and the event
+        // records the stamp, the two new slots and q. When q is on an edge,
+        // see SplitEdge. The votes are read-only during the pass, so a
+        // thread can determine whether the neighbor also elected q without
+        // reading triangles that another thread might be modifying. The
+        // return value is 1 when q is inserted, 0 otherwise.
+        int32_t Split(int32_t t, int32_t stamp)
+        {
+            uint32_t const key = mVotes[t];
+            if (key == msNone)
+            {
+                return 0;
+            }
+
+            int32_t const q = static_cast<int32_t>((key * msKeyInverse) & 0x7FFFFFFFu);
+            int32_t const neighbor = mNeighbors[q];
+            if (neighbor >= 0)
+            {
+                // The point is on the edge shared with the other triangle,
+                // which must also have elected q. The triangle with smaller
+                // index splits both.
+                int32_t const other = (mLocations[q] == t ? neighbor : mLocations[q]);
+                if (other < t || mVotes[other] != key)
+                {
+                    return 0;
+                }
+                int32_t j = 0;
+                while (mAdjacent[t][j] != other)
+                {
+                    ++j;
+                }
+                SplitEdge(t, j, q, stamp);
+                return 1;
+            }
+
+            auto const tri = mTriangles[t];
+            if (mExactOrient)
+            {
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    if (Orient(tri[j], tri[(j + 1) % 3], q) == 0)
+                    {
+                        // The point is on a hull edge.
+                        SplitEdge(t, j, q, stamp);
+                        return 1;
+                    }
+                }
+            }
+
+            int32_t const s1 = mNumTriangles;
+            int32_t const s2 = s1 + 1;
+            mNumTriangles += 2;
+
+            auto const adj = mAdjacent[t];
+            mTriangles[t] = { tri[0], tri[1], q, -1 };
+            mTriangles[s1] = { tri[1], tri[2], q, -1 };
+            mTriangles[s2] = { tri[2], tri[0], q, -1 };
+            mAdjacent[t] = { adj[0], s1, s2, -1 };
+            mAdjacent[s1] = { adj[1], s2, t, -1 };
+            mAdjacent[s2] = { adj[2], t, s1, -1 };
+            mEvents[t] = { stamp, s1, s2, q };
+            return 1;
+        }
+
+        // Split the edge <a,b> = <V[j],V[(j+1)%3]> of triangle t = <a,b,c>
+        // at q. The triangle becomes t = <a,q,c> and s = <q,b,c>. The
+        // adjacent triangle n = <b,a,d>, if any, becomes n = <b,q,d> and
+        // m = <q,a,d>. The events of t and n record the stamp, the new
+        // sibling and q. In both t and n, the new edge is <q,V[2]>.
+        void SplitEdge(int32_t t, int32_t j, int32_t q, int32_t stamp)
+        {
+            int32_t const j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            int32_t const a = mTriangles[t][j];
+            int32_t const b = mTriangles[t][j1];
+            int32_t const c = mTriangles[t][j2];
+            int32_t const adjBC = mAdjacent[t][j1];
+            int32_t const adjCA = mAdjacent[t][j2];
+            int32_t const n = mAdjacent[t][j];
+            int32_t const s = mNumTriangles++;
+            if (n >= 0)
+            {
+                int32_t const k = GetEdge(n, b, a);
+                int32_t const d = mTriangles[n][(k + 2) % 3];
+                int32_t const adjAD = mAdjacent[n][(k + 1) % 3];
+                int32_t const adjDB = mAdjacent[n][(k + 2) % 3];
+                int32_t const m = mNumTriangles++;
+                mTriangles[n] = { b, q, d, -1 };
+                mTriangles[m] = { q, a, d, -1 };
+                mAdjacent[n] = { s, m, adjDB, -1 };
+                mAdjacent[m] = { t, adjAD, n, -1 };
+                mAdjacent[t] = { m, s, adjCA, -1 };
+                mAdjacent[s] = { n, adjBC, t, -1 };
+                mEvents[n] = { stamp, m, -1, q };
+            }
+            else
+            {
+                mAdjacent[t] = { -1, s, adjCA, -1 };
+                mAdjacent[s] = { -1, adjBC, t, -1 };
+            }
+            mTriangles[t] = { a, q, c, -1 };
+            mTriangles[s] = { q, b, c, -1 };
+            mEvents[t] = { stamp, s, -1, q };
+        }
+
+        // Each thread tests one edge <a,b> of triangle t, with c the third
+        // vertex of t, for which the adjacent triangle n has larger index.
+        // When the opposite vertex d of n is certified to be strictly inside
+        // the circumcircle of <a,b,c>, the edge requests the locks of t and
+        // n. The edge with the minimum identifier 3*t+j wins each lock.
+        void MarkFlip(int32_t t)
+        {
+            auto const& tri = mTriangles[t];
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                int32_t const n = mAdjacent[t][j];
+                if (n > t)
+                {
+                    int32_t const a = tri[j];
+                    int32_t const b = tri[(j + 1) % 3];
+                    int32_t const c = tri[(j + 2) % 3];
+                    int32_t const d = mTriangles[n][(GetEdge(n, b, a) + 2) % 3];
+                    if (InCircle(a, b, c, d) > 0)
+                    {
+                        uint32_t const id = static_cast<uint32_t>(3 * t + j);
+                        mLocks[t] = std::min(mLocks[t], id);
+                        mLocks[n] = std::min(mLocks[n], id);
+                    }
+                }
+            }
+        }
+
+        // Flip the edge <a,b> of triangle t = <a,b,c> adjacent to triangle
+        // n = <b,a,d> when the edge won both locks. The triangles become
+        // t = <c,a,d> and n = <d,b,c>. The events of t and n record the
+        // stamp and the other triangle. The return value is 1 when the edge
+        // is flipped, 0 otherwise.
+        int32_t Flip(int32_t t, int32_t stamp)
+        {
+            uint32_t const id = mLocks[t];
+            if (id == msNone || static_cast<int32_t>(id / 3) != t)
+            {
+                return 0;
+            }
+
+            int32_t const j = static_cast<int32_t>(id % 3);
+            int32_t const n = mAdjacent[t][j];
+            if (mLocks[n] != id)
+            {
+                return 0;
+            }
+
+            int32_t const j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            int32_t const a = mTriangles[t][j];
+            int32_t const b = mTriangles[t][j1];
+            int32_t const c = mTriangles[t][j2];
+            int32_t const k = GetEdge(n, b, a);
+            int32_t const k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+            int32_t const d = mTriangles[n][k2];
+            int32_t const adjBC = mAdjacent[t][j1];
+            int32_t const adjCA = mAdjacent[t][j2];
+            int32_t const adjAD = mAdjacent[n][k1];
+            int32_t const adjDB = mAdjacent[n][k2];
+
+            mTriangles[t] = { c, a, d, -1 };
+            mTriangles[n] = { d, b, c, -1 };
+            mAdjacent[t] = { adjCA, adjAD, n, -1 };
+            mAdjacent[n] = { adjDB, adjBC, t, -1 };
+            mEvents[t] = { stamp, n, -1, -1 };
+            mEvents[n] = { stamp, t, -1, -1 };
+            return 1;
+        }
+
+        // The adjacency of an edge of triangle t is stale when the adjacent
+        // triangle m was split or flipped by the pass with the specified
+        // stamp. The edge is then in one of the triangles recorded by the
+        // event of m. The function also resets the vote and releases the
+        // flip lock of t.
+        void UpdateAdjacent(int32_t t, int32_t stamp)
+        {
+            mVotes[t] = msNone;
+            mLocks[t] = msNone;
+            auto const& tri = mTriangles[t];
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                int32_t const m = mAdjacent[t][j];
+                if (m >= 0)
+                {
+                    int32_t const a = tri[j];
+                    int32_t const b = tri[(j + 1) % 3];
+                    auto const& event = mEvents[m];
+                    if (event[0] == stamp && GetEdge(m, b, a) < 0)
+                    {
+                        mAdjacent[t][j] = (GetEdge(event[1], b, a) >= 0 ? event[1] : event[2]);
+                    }
+                }
+            }
+        }
+
+        // Move an uninserted point from a split or flipped triangle to the
+        // new triangle that contains it. When the point is on (or, because
+        // of rounding errors, near) a new edge, it is moved to either of the
+        // triangles sharing the edge. The inserted point of a split is
+        // marked by the location -1.
+        void Relocate(int32_t p, int32_t stamp)
+        {
+            int32_t const t = mLocations[p];
+            if (t < 0 || mEvents[t][0] != stamp)
+            {
+                return;
+            }
+
+            auto const& event = mEvents[t];
+            int32_t const q = event[3];
+            if (q == p)
+            {
+                mLocations[p] = -1;
+            }
+            else if (q < 0)
+            {
+                // The triangle was flipped with its partner. The triangle
+                // with smaller index is <c,a,d> and the common edge is <d,c>.
+                int32_t const owner = std::min(t, event[1]);
+                int32_t const other = std::max(t, event[1]);
+                auto const& tri = mTriangles[owner];
+                mLocations[p] = (Orient(tri[2], tri[0], p) >= 0 ? owner : other);
+            }
+            else if (event[2] >= 0)
+            {
+                // The triangle was split at q into t = <v0,v1,q>,
+                // s1 = <v1,v2,q> and s2 = <v2,v0,q>.
+                int32_t const v0 = mTriangles[t][0];
+                int32_t const v1 = mTriangles[t][1];
+                int32_t const v2 = mTriangles[event[1]][1];
+                int const sign0 = Orient(q, v0, p);
+                int const sign1 = Orient(q, v1, p);
+                int const sign2 = Orient(q, v2, p);
+                if (sign0 >= 0 && sign1 <= 0)
+                {
+                    mLocations[p] = t;
+                }
+                else if (sign1 >= 0 && sign2 <= 0)
+                {
+                    mLocations[p] = event[1];
+                }
+                else
+                {
+                    mLocations[p] = event[2];
+                }
+            }
+            else
+            {
+                // The edge of the triangle was split at q. The triangle is
+                // left of its new edge <q,V[2]> and the sibling is right.
+                mLocations[p] = (Orient(q, mTriangles[t][2], p) >= 0 ? t : event[1]);
+            }
+        }
+
+        void UpdatePass(int32_t stamp)
+        {
+            for (int32_t t = 0; t < mNumTriangles; ++t)
+            {
+                UpdateAdjacent(t, stamp);
+            }
+
+            for (int32_t p = 0; p < mNumPoints; ++p)
+            {
+                Relocate(p, stamp);
+            }
+        }
+
+        // The floating-point predicates of the parallel phase, which return
+        // 0 when the sign is not certified. Orient returns +1 when
+        // <v0,v1,p> is counterclockwise and -1 when it is clockwise.
+        // InCircle returns +1 when p is inside the circumcircle of the
+        // counterclockwise triangle <v0,v1,v2> and -1 when it is outside.
+        // When mExactOrient is true, the 'double' orientation determinant
+        // is exact and Orient returns 0 only for collinear points.
+        int Orient(int32_t v0, int32_t v1, int32_t p) const
+        {
+            if (mExactOrient)
+            {
+                double const x0 = static_cast<double>(mPoints[v0][0]);
+                double const y0 = static_cast<double>(mPoints[v0][1]);
+                double const x1 = static_cast<double>(mPoints[v1][0]) - x0;
+                double const y1 = static_cast<double>(mPoints[v1][1]) - y0;
+                double const x2 = static_cast<double>(mPoints[p][0]) - x0;
+                double const y2 = static_cast<double>(mPoints[p][1]) - y0;
+                double const det = x1 * y2 - x2 * y1;
+                return (det > 0.0 ? +1 : (det < 0.0 ? -1 : 0));
+            }
+
+            int sign;
+            Query::FilterToLine(1, &mPoints[p], mPoints[v0], mPoints[v1], &sign);
+            return -sign;
+        }
+
+        int InCircle(int32_t v0, int32_t v1, int32_t v2, int32_t p) const
+        {
+            int sign;
+            Query::FilterToCircumcircle(1, &mPoints[p], mPoints[v0], mPoints[v1],
+                mPoints[v2], &sign);
+            return -sign;
+        }
+
+        // Return j for which <V[j],V[(j+1)%3]> = <a,b>, where V[] are the
+        // vertices of triangle t, or -1 when t does not have the edge.
+        int32_t GetEdge(int32_t t, int32_t a, int32_t b) const
+        {
+            auto const& tri = mTriangles[t];
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                if (tri[j] == a && tri[(j + 1) % 3] == b)
+                {
+                    return j;
+                }
+            }
+            return -1;
+        }
+
+        int mMaxFlipPasses;
+        int32_t mNumPoints;
+        Vector2<float> const* mPoints;
+        Query mQuery;
+
+        // The orientation determinant is exact when the coordinates are
+        // integer multiples of a power of two 2^e and their magnitudes are
+        // at most 2^{25+e}, as for points sampled from a grid. The
+        // coordinate differences are then multiples of 2^e bounded by
+        // 2^{26+e} and the determinant terms are multiples of 2^{2e}
+        // bounded by 2^{52+2e}, so all operations are exact in 'double'.
+        bool mExactOrient;
+
+        // The triangulation state shared with GPUFlipDelaunay2. The storage
+        // is allocated for the maximum number of triangles, 2*mNumPoints.
+        int32_t mNumTriangles;
+        std::vector<std::array<int32_t, 4>> mTriangles;
+        std::vector<std::array<int32_t, 4>> mAdjacent;
+        std::vector<std::array<int32_t, 4>> mEvents;
+        std::vector<uint32_t> mVotes;
+        std::vector<uint32_t> mLocks;
+        std::vector<int32_t> mLocations;
+        std::vector<int32_t> mNeighbors;
+
+    private:
+        // Triangulate the convex hull by the fan of its first vertex and
+        // locate the other points in the fan triangles.
+        bool CreateHullFan()
+        {
+            if (mNumPoints < 3)
+            {
+                return false;
+            }
+
+            std::vector<float> x(mNumPoints), y(mNumPoints);
+            for (int32_t p = 0; p < mNumPoints; ++p)
+            {
+                x[p] = mPoints[p][0];
+                y[p] = mPoints[p][1];
+            }
+
+            ConvexHull2MonotoneChain<float> hull;
+            if (!hull(mNumPoints, x.data(), y.data(), 0.0f))
+            {
+                return false;
+            }
+
+            ComputeExactOrient();
+            size_t const capacity = 2 * static_cast<size_t>(mNumPoints);
+            mTriangles.resize(capacity);
+            mAdjacent.resize(capacity);
+            mEvents.assign(capacity, { -1, -1, -1, -1 });
+            uint32_t const none = msNone;
+            mVotes.assign(capacity, none);
+            mLocks.assign(capacity, none);
+            mLocations.assign(mNumPoints, 0);
+            mNeighbors.assign(mNumPoints, -1);
+
+            auto const& h = hull.GetHull();
+            int32_t const numHull = static_cast<int32_t>(h.size());
+            mNumTriangles = numHull - 2;
+            for (int32_t t = 0; t < mNumTriangles; ++t)
+            {
+                mTriangles[t] = { h[0], h[t + 1], h[t + 2], -1 };
+                mAdjacent[t] = { t - 1, -1, (t + 1 < mNumTriangles ? t + 1 : -1), -1 };
+            }
+
+            // The rays from h[0] through h[1], ..., h[numHull-1] are
+            // counterclockwise, so a binary search finds the last ray with
+            // the point on its left. An uncertain orientation is treated as
+            // being on the left, which places the point in a triangle whose
+            // closure contains it or in a neighbor of that triangle.
+            for (int32_t i = 0; i < numHull; ++i)
+            {
+                mLocations[h[i]] = -1;
+            }
+            for (int32_t p = 0; p < mNumPoints; ++p)
+            {
+                if (mLocations[p] == 0)
+                {
+                    int32_t lo = 1, hi = numHull - 2;
+                    while (lo < hi)
+                    {
+                        int32_t const mid = (lo + hi + 1) / 2;
+                        if (Orient(h[0], h[mid], p) >= 0)
+                        {
+                            lo = mid;
+                        }
+                        else
+                        {
+                            hi = mid - 1;
+                        }
+                    }
+                    mLocations[p] = lo - 1;
+                }
+            }
+            return true;
+        }
+
+        // Determine whether the 'double' orientation determinant is exact.
+        // See the comments for mExactOrient.
+        void ComputeExactOrient()
+        {
+            int32_t minExponent = std::numeric_limits<int32_t>::max();
+            float maxMagnitude = 0.0f;
+            for (int32_t p = 0; p < mNumPoints; ++p)
+            {
+                for (int32_t i = 0; i < 2; ++i)
+                {
+                    float const value = mPoints[p][i];
+                    if (!std::isfinite(value))
+                    {
+                        mExactOrient = false;
+                        return;
+                    }
+                    if (value == 0.0f)
+                    {
+                        continue;
+                    }
+
+                    // The value is significand*2^exponent. The lowest set
+                    // bit of the significand is converted exactly to a
+                    // 'float' whose biased exponent is then extracted.
+                    uint32_t bits;
+                    std::memcpy(&bits, &value, sizeof(bits));
+                    uint32_t const biased = (bits >> 23) & 0x000000FFu;
+                    uint32_t significand = bits & 0x007FFFFFu;
+                    int32_t exponent = -149;
+                    if (biased > 0)
+                    {
+                        significand |= 0x00800000u;
+                        exponent = static_cast<int32_t>(biased) - 150;
+                    }
+                    float const lowBit = static_cast<float>(significand & (0u - significand));
+                    std::memcpy(&bits, &lowBit, sizeof(bits));
+                    exponent += static_cast<int32_t>((bits >> 23) & 0x000000FFu) - 127;
+                    minExponent = std::min(minExponent, exponent);
+                    maxMagnitude = std::max(maxMagnitude, std::fabs(value));
+                }
+            }
+
+            mExactOrient = (maxMagnitude == 0.0f ||
+                static_cast<double>(maxMagnitude) <= std::ldexp(1.0, 25 + minExponent));
+        }
+
+        // Apply exact edge flips until the triangulation is Delaunay and
+        // insert the points that the parallel phase did not insert.
+        void FixupTriangulation()
+        {
+            for (int32_t t = 0; t < mNumTriangles; ++t)
+            {
+                auto const& tri = mTriangles[t];
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    if (mAdjacent[t][j] > t)
+                    {
+                        mEdgeStack.push_back({ t, tri[j], tri[(j + 1) % 3] });
+                    }
+                }
+            }
+            Legalize();
+
+            for (int32_t p = 0; p < mNumPoints; ++p)
+            {
+                if (mLocations[p] >= 0)
+                {
+                    InsertExact(p, mLocations[p]);
+                }
+            }
+        }
+
+        // Flip the stacked edges <a,b> of triangles t that are not locally
+        // Delaunay. A stacked edge that no longer exists is ignored.
+        void Legalize()
+        {
+            while (mEdgeStack.size() > 0)
+            {
+                auto const edge = mEdgeStack.back();
+                mEdgeStack.pop_back();
+                int32_t const t = edge[0];
+                int32_t const j = GetEdge(t, edge[1], edge[2]);
+                if (j < 0)
+                {
+                    continue;
+                }
+                int32_t const n = mAdjacent[t][j];
+                if (n < 0)
+                {
+                    continue;
+                }
+
+                int32_t const j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+                int32_t const a = mTriangles[t][j];
+                int32_t const b = mTriangles[t][j1];
+                int32_t const c = mTriangles[t][j2];
+                int32_t const k = GetEdge(n, b, a);
+                int32_t const k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+                int32_t const d = mTriangles[n][k2];
+                if (mQuery.ToCircumcircle(d, a, b, c) >= 0)
+                {
+                    continue;
+                }
+
+                int32_t const adjBC = mAdjacent[t][j1];
+                int32_t const adjCA = mAdjacent[t][j2];
+                int32_t const adjAD = mAdjacent[n][k1];
+                int32_t const adjDB = mAdjacent[n][k2];
+                mTriangles[t] = { c, a, d, -1 };
+                mTriangles[n] = { d, b, c, -1 };
+                mAdjacent[t] = { adjCA, adjAD, n, -1 };
+                mAdjacent[n] = { adjDB, adjBC, t, -1 };
+                SetAdjacent(adjAD, d, a, t);
+                SetAdjacent(adjBC, c, b, n);
+                ++mNumFixupFlips;
+
+                mEdgeStack.push_back({ t, c, a });
+                mEdgeStack.push_back({ t, a, d });
+                mEdgeStack.push_back({ n, d, b });
+                mEdgeStack.push_back({ n, b, c });
+            }
+        }
+
+        // Insert point p using exact predicates. The search for its
+        // triangle starts at triangle t. The visibility walk terminates
+        // because the triangulation is Delaunay.
+        void InsertExact(int32_t p, int32_t t)
+        {
+            std::array<int, 3> signs{};
+            for (;;)
+            {
+                auto const& tri = mTriangles[t];
+                int32_t j;
+                for (j = 0; j < 3; ++j)
+                {
+                    // ToLine returns +1 when p is right of the edge, so p is
+                    // outside the triangle.
+                    signs[j] = mQuery.ToLine(p, tri[j], tri[(j + 1) % 3]);
+                    if (signs[j] > 0)
+                    {
+                        break;
+                    }
+                }
+                if (j == 3)
+                {
+                    break;
+                }
+                t = mAdjacent[t][j];
+                LogAssert(t >= 0, "Unexpected condition.");
+            }
+
+            int32_t numZeros = 0, zero = -1;
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                if (signs[j] == 0)
+                {
+                    ++numZeros;
+                    zero = j;
+                }
+            }
+            if (numZeros >= 2)
+            {
+                // The point is a duplicate of a vertex of t.
+                return;
+            }
+
+            ++mNumFixupInsertions;
+            if (numZeros == 0)
+            {
+                SplitExact(t, p);
+            }
+            else
+            {
+                SplitEdgeExact(t, zero, p);
+            }
+            Legalize();
+        }
+
+        // Split triangle t at point p strictly inside it.
+        void SplitExact(int32_t t, int32_t p)
+        {
+            int32_t const s1 = AllocateTriangle();
+            int32_t const s2 = AllocateTriangle();
+            auto const tri = mTriangles[t];
+            auto const adj = mAdjacent[t];
+            mTriangles[t] = { tri[0], tri[1], p, -1 };
+            mTriangles[s1] = { tri[1], tri[2], p, -1 };
+            mTriangles[s2] = { tri[2], tri[0], p, -1 };
+            mAdjacent[t] = { adj[0], s1, s2, -1 };
+            mAdjacent[s1] = { adj[1], s2, t, -1 };
+            mAdjacent[s2] = { adj[2], t, s1, -1 };
+            SetAdjacent(adj[1], tri[2], tri[1], s1);
+            SetAdjacent(adj[2], tri[0], tri[2], s2);
+            mLocations[p] = -1;
+
+            mEdgeStack.push_back({ t, tri[0], tri[1] });
+            mEdgeStack.push_back({ s1, tri[1], tri[2] });
+            mEdgeStack.push_back({ s2, tri[2], tri[0] });
+        }
+
+        // Split the edge <a,b> = <V[j],V[(j+1)%3]> of triangle t = <a,b,c>
+        // at point p strictly inside the edge. The triangle becomes
+        // t = <a,p,c> and s = <p,b,c>. The adjacent triangle n = <b,a,d>,
+        // if any, becomes n = <b,p,d> and m = <p,a,d>.
+        void SplitEdgeExact(int32_t t, int32_t j, int32_t p)
+        {
+            int32_t const j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+            int32_t const a = mTriangles[t][j];
+            int32_t const b = mTriangles[t][j1];
+            int32_t const c = mTriangles[t][j2];
+            int32_t const adjBC = mAdjacent[t][j1];
+            int32_t const adjCA = mAdjacent[t][j2];
+            int32_t const n = mAdjacent[t][j];
+            int32_t const s = AllocateTriangle();
+
+            if (n >= 0)
+            {
+                int32_t const k = GetEdge(n, b, a);
+                int32_t const d = mTriangles[n][(k + 2) % 3];
+                int32_t const adjAD = mAdjacent[n][(k + 1) % 3];
+                int32_t const adjDB = mAdjacent[n][(k + 2) % 3];
+                int32_t const m = AllocateTriangle();
+                mTriangles[n] = { b, p, d, -1 };
+                mTriangles[m] = { p, a, d, -1 };
+                mAdjacent[n] = { s, m, adjDB, -1 };
+                mAdjacent[m] = { t, adjAD, n, -1 };
+                SetAdjacent(adjAD, d, a, m);
+                mAdjacent[t] = { m, s, adjCA, -1 };
+                mAdjacent[s] = { n, adjBC, t, -1 };
+                mEdgeStack.push_back({ n, d, b });
+                mEdgeStack.push_back({ m, a, d });
+            }
+            else
+            {
+                mAdjacent[t] = { -1, s, adjCA, -1 };
+                mAdjacent[s] = { -1, adjBC, t, -1 };
+            }
+            mTriangles[t] = { a, p, c, -1 };
+            mTriangles[s] = { p, b, c, -1 };
+            SetAdjacent(adjBC, c, b, s);
+            mLocations[p] = -1;
+
+            mEdgeStack.push_back({ t, c, a });
+            mEdgeStack.push_back({ s, b, c });
+        }
+
+        int32_t AllocateTriangle()
+        {
+            LogAssert(static_cast<size_t>(mNumTriangles) < mTriangles.size(),
+                "Unexpected condition.");
+            return mNumTriangles++;
+        }
+
+        // Set the adjacent triangle of the edge <a,b> of triangle t.
+        void SetAdjacent(int32_t t, int32_t a, int32_t b, int32_t adjacent)
+        {
+            if (t >= 0)
+            {
+                mAdjacent[t][GetEdge(t, a, b)] = adjacent;
+            }
+        }
+
+        size_t mNumFixupFlips;
+        size_t mNumFixupInsertions;
+        std::vector<std::array<int32_t, 3>> mEdgeStack;
+        std::vector<int> mIndices;
+        std::vector<int> mAdjacencies;
+    };
+}
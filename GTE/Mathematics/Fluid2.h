@@ -0,0 +1,479 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Vector4.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// A CPU implementation of the 2D fluid solver GPUFluid2 for machines without
+// a GPU and for validating the GPU results. The stages InitializeSource,
+// InitializeState, UpdateState, EnforceStateBoundary, ComputeDivergence,
+// SolvePoisson (Jacobi method) and AdjustVelocity compute what the compute
+// shaders of the same names compute, in the same order. The random numbers
+// of the source vortices and the initial density are generated in the same
+// order as by GPUFluid2, so the states agree up to rounding errors and the
+// precision of the texture filtering of the GPU advection.
+//
+// The state is stored as structure of arrays, one array per channel, in
+// row-major order: channel[c][x + xSize * y]. Each stage is one parallel
+// pass over bands of rows. The loops over the interior of a row have no
+// clamping or branches, so the compiler can vectorize the stencils. The
+// advection samples the previous state at positions that depend on the
+// velocity and is not vectorized.
+
+namespace gte
+{
+    template <typename Real>
+    class Fluid2
+    {
+    public:
+        // The state channels.
+        enum
+        {
+            VELOCITY_X,
+            VELOCITY_Y,
+            DENSITY,
+            NUM_CHANNELS
+        };
+
+        using Grid = std::array<std::vector<Real>, NUM_CHANNELS>;
+
+        // Construction. The (x,y) grid covers [0,1]^2 and the sizes must be
+        // at least 3. The Poisson equation of each step is solved by
+        // numPoissonIterations Jacobi iterations. The rows are processed by
+        // the threads of the scheduler when it is not null.
+        Fluid2(int xSize, int ySize, Real dt, Real densityViscosity,
+            Real velocityViscosity, int numPoissonIterations = 32,
+            TaskScheduler* scheduler = nullptr)
+            :
+            mXSize(xSize),
+            mYSize(ySize),
+            mDt(dt),
+            mTime((Real)0),
+            mNumPoissonIterations(numPoissonIterations),
+            mScheduler(scheduler)
+        {
+            mDx = (Real)1 / static_cast<Real>(xSize);
+            mDy = (Real)1 / static_cast<Real>(ySize);
+            mHalfDivDx = (Real)0.5 / mDx;
+            mHalfDivDy = (Real)0.5 / mDy;
+            mDtDivDx = dt / mDx;
+            mDtDivDy = dt / mDy;
+            Real const dtDivDxDx = (dt / mDx) / mDx;
+            Real const dtDivDyDy = (dt / mDy) / mDy;
+            Real const ratio = mDx / mDy;
+            Real const ratioSqr = ratio * ratio;
+            Real const factor = (Real)0.5 / ((Real)1 + ratioSqr);
+            mEpsilonX = factor;
+            mEpsilonY = ratioSqr * factor;
+            mEpsilon0 = mDx * mDx * factor;
+            mViscosityX = { velocityViscosity * dtDivDxDx,
+                velocityViscosity * dtDivDxDx, densityViscosity * dtDivDxDx };
+            mViscosityY = { velocityViscosity * dtDivDyDy,
+                velocityViscosity * dtDivDyDy, densityViscosity * dtDivDyDy };
+
+            size_t const numTexels = static_cast<size_t>(xSize) * static_cast<size_t>(ySize);
+            for (int c = 0; c < NUM_CHANNELS; ++c)
+            {
+                mSource[c].resize(numTexels, (Real)0);
+                mStateTm1[c].resize(numTexels, (Real)0);
+                mStateT[c].resize(numTexels, (Real)0);
+                mStateTp1[c].resize(numTexels, (Real)0);
+            }
+            mDivergence.resize(numTexels, (Real)0);
+            mPoisson0.resize(numTexels, (Real)0);
+            mPoisson1.resize(numTexels, (Real)0);
+        }
+
+        void Initialize()
+        {
+            InitializeSource();
+            InitializeState();
+            EnforceStateBoundary(mStateTm1);
+            EnforceStateBoundary(mStateT);
+            mTime = (Real)0;
+        }
+
+        void DoSimulationStep()
+        {
+            UpdateState();
+            EnforceStateBoundary(mStateTp1);
+            ComputeDivergence(mStateTp1);
+            SolvePoisson();
+            AdjustVelocity(mStateTp1, mStateTm1);
+            EnforceStateBoundary(mStateTm1);
+            std::swap(mStateTm1, mStateT);
+
+            mTime += mDt;
+        }
+
+        // Member access.
+        inline int GetXSize() const
+        {
+            return mXSize;
+        }
+
+        inline int GetYSize() const
+        {
+            return mYSize;
+        }
+
+        inline Real GetTime() const
+        {
+            return mTime;
+        }
+
+        inline Grid const& GetState() const
+        {
+            return mStateT;
+        }
+
+        inline Grid const& GetSource() const
+        {
+            return mSource;
+        }
+
+        // The state at (x,y) in the layout of a texel of
+        // GPUFluid2::GetState(), (velocity.xy, 0, density).
+        Vector4<Real> GetState(int x, int y) const
+        {
+            size_t const i = static_cast<size_t>(x) + static_cast<size_t>(mXSize) * static_cast<size_t>(y);
+            return Vector4<Real>{ mStateT[VELOCITY_X][i], mStateT[VELOCITY_Y][i],
+                (Real)0, mStateT[DENSITY][i] };
+        }
+
+    private:
+        // Execute function(ymin, ymax) for bands of rows ymin <= y < ymax
+        // that partition [rmin, rmax).
+        template <typename Function>
+        void ForEachBand(int rmin, int rmax, Function const& function) const
+        {
+            size_t const numRows = static_cast<size_t>(rmax - rmin);
+            size_t const numBands = (mScheduler ?
+                std::max(std::min(numRows / msMinBandSize, 4 * mScheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+
+            TaskScheduler::ParallelFor(mScheduler, numBands,
+                [rmin, numRows, numBands, &function](size_t band)
+                {
+                    int const ymin = rmin + static_cast<int>(numRows * band / numBands);
+                    int const ymax = rmin + static_cast<int>(numRows * (band + 1) / numBands);
+                    function(ymin, ymax);
+                });
+        }
+
+        inline size_t Row(int y) const
+        {
+            return static_cast<size_t>(mXSize) * static_cast<size_t>(y);
+        }
+
+        // The source consists of a density producer and consumer, wind,
+        // gravity and the velocity of NUM_VORTICES random vortices.
+        void InitializeSource()
+        {
+            std::mt19937 mte;
+            std::uniform_real_distribution<float> unirnd(0.0f, 1.0f);
+            std::uniform_real_distribution<float> symrnd(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> posrnd0(0.001f, 0.01f);
+            std::uniform_real_distribution<float> posrnd1(128.0f, 256.0f);
+
+            // (x, y, variance, amplitude)
+            std::vector<std::array<Real, 4>> vortices(NUM_VORTICES);
+            for (auto& vortex : vortices)
+            {
+                vortex[0] = static_cast<Real>(unirnd(mte));
+                vortex[1] = static_cast<Real>(unirnd(mte));
+                vortex[2] = static_cast<Real>(posrnd0(mte));
+                vortex[3] = static_cast<Real>(posrnd1(mte));
+                if (symrnd(mte) < 0.0f)
+                {
+                    vortex[3] = -vortex[3];
+                }
+            }
+
+            std::array<Real, 4> const densityProducer = { (Real)0.25, (Real)0.75, (Real)0.01, (Real)2 };
+            std::array<Real, 4> const densityConsumer = { (Real)0.75, (Real)0.25, (Real)0.01, (Real)2 };
+            std::array<Real, 2> const gravity = { (Real)0, (Real)0 };
+            std::array<Real, 4> const wind = { (Real)0, (Real)0.5, (Real)0.001, (Real)32 };
+
+            ForEachBand(0, mYSize, [&](int ymin, int ymax)
+            {
+                for (int y = ymin; y < ymax; ++y)
+                {
+                    Real* sourceX = mSource[VELOCITY_X].data() + Row(y);
+                    Real* sourceY = mSource[VELOCITY_Y].data() + Row(y);
+                    Real* sourceD = mSource[DENSITY].data() + Row(y);
+                    Real const locY = mDy * (static_cast<Real>(y) + (Real)0.5);
+                    for (int x = 0; x < mXSize; ++x)
+                    {
+                        Real const locX = mDx * (static_cast<Real>(x) + (Real)0.5);
+                        Real velX = (Real)0, velY = (Real)0;
+                        for (auto const& vortex : vortices)
+                        {
+                            Real const diffX = locX - vortex[0];
+                            Real const diffY = locY - vortex[1];
+                            Real const arg = -(diffX * diffX + diffY * diffY) / vortex[2];
+                            Real const magnitude = vortex[3] * std::exp(arg);
+                            velX += magnitude * diffY;
+                            velY -= magnitude * diffX;
+                        }
+
+                        Real diffX = locX - densityProducer[0];
+                        Real diffY = locY - densityProducer[1];
+                        Real arg = -(diffX * diffX + diffY * diffY) / densityProducer[2];
+                        Real density = densityProducer[3] * std::exp(arg);
+                        diffX = locX - densityConsumer[0];
+                        diffY = locY - densityConsumer[1];
+                        arg = -(diffX * diffX + diffY * diffY) / densityConsumer[2];
+                        density -= densityConsumer[3] * std::exp(arg);
+
+                        Real const windDiff = locY - wind[1];
+                        Real const windArg = -windDiff * windDiff / wind[2];
+                        sourceX[x] = gravity[0] + wind[3] * std::exp(windArg) + velX;
+                        sourceY[x] = gravity[1] + velY;
+                        sourceD[x] = density;
+                    }
+                }
+            });
+        }
+
+        // The initial density is random and the initial velocity is zero.
+        void InitializeState()
+        {
+            std::mt19937 mte;
+            std::uniform_real_distribution<float> unirnd(0.0f, 1.0f);
+            for (auto& density : mStateT[DENSITY])
+            {
+                density = static_cast<Real>(unirnd(mte));
+            }
+            std::fill(mStateT[VELOCITY_X].begin(), mStateT[VELOCITY_X].end(), (Real)0);
+            std::fill(mStateT[VELOCITY_Y].begin(), mStateT[VELOCITY_Y].end(), (Real)0);
+            mStateTm1 = mStateT;
+        }
+
+        // Advect the state at time t-dt by the velocity at time t, then add
+        // the diffusion and the source.
+        void UpdateState()
+        {
+            ForEachBand(0, mYSize, [this](int ymin, int ymax)
+            {
+                Real const xMax = static_cast<Real>(mXSize - 1);
+                Real const yMax = static_cast<Real>(mYSize - 1);
+                for (int y = ymin; y < ymax; ++y)
+                {
+                    int const ym = std::max(y - 1, 0);
+                    int const yp = std::min(y + 1, mYSize - 1);
+
+                    // Bilinear interpolation of the state at time t-dt, with
+                    // the sample positions clamped to the grid.
+                    Real const* velX = mStateT[VELOCITY_X].data() + Row(y);
+                    Real const* velY = mStateT[VELOCITY_Y].data() + Row(y);
+                    for (int x = 0; x < mXSize; ++x)
+                    {
+                        Real const px = std::min(std::max(static_cast<Real>(x) - mDtDivDx * velX[x], (Real)0), xMax);
+                        Real const py = std::min(std::max(static_cast<Real>(y) - mDtDivDy * velY[x], (Real)0), yMax);
+                        int const x0 = std::min(static_cast<int>(px), mXSize - 2);
+                        int const y0 = std::min(static_cast<int>(py), mYSize - 2);
+                        Real const u = px - static_cast<Real>(x0);
+                        Real const v = py - static_cast<Real>(y0);
+                        size_t const i00 = static_cast<size_t>(x0) + Row(y0);
+                        size_t const i01 = i00 + static_cast<size_t>(mXSize);
+                        for (int c = 0; c < NUM_CHANNELS; ++c)
+                        {
+                            Real const* tm1 = mStateTm1[c].data();
+                            Real const s0 = tm1[i00] + u * (tm1[i00 + 1] - tm1[i00]);
+                            Real const s1 = tm1[i01] + u * (tm1[i01 + 1] - tm1[i01]);
+                            mStateTp1[c][Row(y) + static_cast<size_t>(x)] = s0 + v * (s1 - s0);
+                        }
+                    }
+
+                    for (int c = 0; c < NUM_CHANNELS; ++c)
+                    {
+                        Real const* center = mStateT[c].data() + Row(y);
+                        Real const* south = mStateT[c].data() + Row(ym);
+                        Real const* north = mStateT[c].data() + Row(yp);
+                        Real const* source = mSource[c].data() + Row(y);
+                        Real* output = mStateTp1[c].data() + Row(y);
+                        Real const vx = mViscosityX[c], vy = mViscosityY[c], dt = mDt;
+
+                        auto Diffuse = [=](int x, int xm, int xp)
+                        {
+                            Real const dxx = center[xp] - (Real)2 * center[x] + center[xm];
+                            Real const dyy = north[x] - (Real)2 * center[x] + south[x];
+                            output[x] += vx * dxx + vy * dyy + dt * source[x];
+                        };
+
+                        Diffuse(0, 0, 1);
+                        for (int x = 1; x < mXSize - 1; ++x)
+                        {
+                            Real const dxx = center[x + 1] - (Real)2 * center[x] + center[x - 1];
+                            Real const dyy = north[x] - (Real)2 * center[x] + south[x];
+                            output[x] += vx * dxx + vy * dyy + dt * source[x];
+                        }
+                        Diffuse(mXSize - 1, mXSize - 2, mXSize - 1);
+                    }
+                }
+            });
+        }
+
+        // The velocity component tangent to an edge is copied from the
+        // adjacent interior texels, and the normal component and the
+        // density are set to zero. The x-edges are processed first, so the
+        // corners are set by the y-edges, as on the GPU.
+        void EnforceStateBoundary(Grid& state)
+        {
+            size_t const xLast = static_cast<size_t>(mXSize - 1);
+            for (int y = 0; y < mYSize; ++y)
+            {
+                size_t const row = Row(y);
+                state[VELOCITY_X][row] = (Real)0;
+                state[VELOCITY_Y][row] = state[VELOCITY_Y][row + 1];
+                state[DENSITY][row] = (Real)0;
+                state[VELOCITY_X][row + xLast] = (Real)0;
+                state[VELOCITY_Y][row + xLast] = state[VELOCITY_Y][row + xLast - 1];
+                state[DENSITY][row + xLast] = (Real)0;
+            }
+
+            size_t const row0 = Row(0), row1 = Row(1);
+            size_t const rowN2 = Row(mYSize - 2), rowN1 = Row(mYSize - 1);
+            for (int x = 0; x < mXSize; ++x)
+            {
+                state[VELOCITY_X][row0 + x] = state[VELOCITY_X][row1 + x];
+                state[VELOCITY_Y][row0 + x] = (Real)0;
+                state[DENSITY][row0 + x] = (Real)0;
+                state[VELOCITY_X][rowN1 + x] = state[VELOCITY_X][rowN2 + x];
+                state[VELOCITY_Y][rowN1 + x] = (Real)0;
+                state[DENSITY][rowN1 + x] = (Real)0;
+            }
+        }
+
+        // Centered differences for the divergence of the velocity.
+        void ComputeDivergence(Grid const& state)
+        {
+            ForEachBand(0, mYSize, [this, &state](int ymin, int ymax)
+            {
+                for (int y = ymin; y < ymax; ++y)
+                {
+                    int const ym = std::max(y - 1, 0);
+                    int const yp = std::min(y + 1, mYSize - 1);
+                    Real const* velX = state[VELOCITY_X].data() + Row(y);
+                    Real const* velYSouth = state[VELOCITY_Y].data() + Row(ym);
+                    Real const* velYNorth = state[VELOCITY_Y].data() + Row(yp);
+                    Real* divergence = mDivergence.data() + Row(y);
+                    Real const hx = mHalfDivDx, hy = mHalfDivDy;
+                    int const xLast = mXSize - 1;
+
+                    divergence[0] = hx * (velX[1] - velX[0]) + hy * (velYNorth[0] - velYSouth[0]);
+                    for (int x = 1; x < xLast; ++x)
+                    {
+                        divergence[x] = hx * (velX[x + 1] - velX[x - 1]) +
+                            hy * (velYNorth[x] - velYSouth[x]);
+                    }
+                    divergence[xLast] = hx * (velX[xLast] - velX[xLast - 1]) +
+                        hy * (velYNorth[xLast] - velYSouth[xLast]);
+                }
+            });
+        }
+
+        // Jacobi iterations for the Poisson equation with zero boundary
+        // values. The boundary texels are never written by the iterations,
+        // so they remain zero.
+        void SolvePoisson()
+        {
+            std::fill(mPoisson0.begin(), mPoisson0.end(), (Real)0);
+            std::fill(mPoisson1.begin(), mPoisson1.end(), (Real)0);
+            for (int i = 0; i < mNumPoissonIterations; ++i)
+            {
+                ForEachBand(1, mYSize - 1, [this](int ymin, int ymax)
+                {
+                    for (int y = ymin; y < ymax; ++y)
+                    {
+                        Real const* center = mPoisson0.data() + Row(y);
+                        Real const* south = mPoisson0.data() + Row(y - 1);
+                        Real const* north = mPoisson0.data() + Row(y + 1);
+                        Real const* divergence = mDivergence.data() + Row(y);
+                        Real* output = mPoisson1.data() + Row(y);
+                        Real const ex = mEpsilonX, ey = mEpsilonY, e0 = mEpsilon0;
+                        for (int x = 1; x < mXSize - 1; ++x)
+                        {
+                            output[x] = ex * (center[x + 1] + center[x - 1]) +
+                                ey * (north[x] + south[x]) + e0 * divergence[x];
+                        }
+                    }
+                });
+                std::swap(mPoisson0, mPoisson1);
+            }
+        }
+
+        // Add the scaled gradient of the Poisson solution to the velocity,
+        // which makes the velocity approximately divergence free.
+        void AdjustVelocity(Grid const& inState, Grid& outState)
+        {
+            ForEachBand(0, mYSize, [this, &inState, &outState](int ymin, int ymax)
+            {
+                for (int y = ymin; y < ymax; ++y)
+                {
+                    int const ym = std::max(y - 1, 0);
+                    int const yp = std::min(y + 1, mYSize - 1);
+                    Real const* center = mPoisson0.data() + Row(y);
+                    Real const* south = mPoisson0.data() + Row(ym);
+                    Real const* north = mPoisson0.data() + Row(yp);
+                    Real const* inX = inState[VELOCITY_X].data() + Row(y);
+                    Real const* inY = inState[VELOCITY_Y].data() + Row(y);
+                    Real* outX = outState[VELOCITY_X].data() + Row(y);
+                    Real* outY = outState[VELOCITY_Y].data() + Row(y);
+                    Real const hx = mHalfDivDx, hy = mHalfDivDy;
+                    int const xLast = mXSize - 1;
+
+                    outX[0] = inX[0] + hx * (center[1] - center[0]);
+                    for (int x = 1; x < xLast; ++x)
+                    {
+                        outX[x] = inX[x] + hx * (center[x + 1] - center[x - 1]);
+                    }
+                    outX[xLast] = inX[xLast] + hx * (center[xLast] - center[xLast - 1]);
+
+                    for (int x = 0; x <= xLast; ++x)
+                    {
+                        outY[x] = inY[x] + hy * (north[x] - south[x]);
+                    }
+
+                    std::copy(inState[DENSITY].begin() + Row(y), inState[DENSITY].begin() + Row(y + 1),
+                        outState[DENSITY].begin() + Row(y));
+                }
+            });
+        }
+
+        enum { NUM_VORTICES = 1024 };
+
+        // The smallest number of rows of a band for multithreading.
+        static size_t constexpr msMinBandSize = 16;
+
+        // Constructor inputs.
+        int mXSize, mYSize;
+        Real mDt;
+
+        // Current simulation time.
+        Real mTime;
+
+        int mNumPoissonIterations;
+        TaskScheduler* mScheduler;
+
+        // The parameters of GPUFluid2Parameters.
+        Real mDx, mDy, mHalfDivDx, mHalfDivDy, mDtDivDx, mDtDivDy;
+        Real mEpsilonX, mEpsilonY, mEpsilon0;
+        std::array<Real, NUM_CHANNELS> mViscosityX, mViscosityY;
+
+        Grid mSource, mStateTm1, mStateT, mStateTp1;
+        std::vector<Real> mDivergence, mPoisson0, mPoisson1;
+    };
+}
@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
+#include <Mathematics/BlockedMatrixProduct.h>
 #include <Mathematics/GVector.h>
 #include <Mathematics/GaussianElimination.h>
 #include <algorithm>
@@ -486,15 +487,32 @@ namespace gte
     {
         if (V.GetSize() == M.GetNumCols())
         {
-            GVector<Real> result(M.GetNumRows());
-            for (int r = 0; r < M.GetNumRows(); ++r)
+            // The storage is accessed directly, traversing the matrix in
+            // storage order. The terms of result[r] are added in the order
+            // of c for both storage conventions.
+            int const numRows = M.GetNumRows(), numCols = M.GetNumCols();
+            GVector<Real> result(numRows);
+            result.MakeZero();
+#if defined(GTE_USE_ROW_MAJOR)
+            for (int r = 0, i = 0; r < numRows; ++r)
+            {
+                Real sum = (Real)0;
+                for (int c = 0; c < numCols; ++c, ++i)
+                {
+                    sum += M[i] * V[c];
+                }
+                result[r] = sum;
+            }
+#else
+            for (int c = 0, i = 0; c < numCols; ++c)
             {
-                result[r] = (Real)0;
-                for (int c = 0; c < M.GetNumCols(); ++c)
+                Real const& vc = V[c];
+                for (int r = 0; r < numRows; ++r, ++i)
                 {
-                    result[r] += M(r, c) * V[c];
+                    result[r] += M[i] * vc;
                 }
             }
+#endif
             return result;
         }
         LogError("Mismatched sizes.");
@@ -506,20 +524,83 @@ namespace gte
     {
         if (V.GetSize() == M.GetNumRows())
         {
-            GVector<Real> result(M.GetNumCols());
-            for (int c = 0; c < M.GetNumCols(); ++c)
+            // The storage is accessed directly, traversing the matrix in
+            // storage order. The terms of result[c] are added in the order
+            // of r for both storage conventions.
+            int const numRows = M.GetNumRows(), numCols = M.GetNumCols();
+            GVector<Real> result(numCols);
+            result.MakeZero();
+#if defined(GTE_USE_ROW_MAJOR)
+            for (int r = 0, i = 0; r < numRows; ++r)
+            {
+                Real const& vr = V[r];
+                for (int c = 0; c < numCols; ++c, ++i)
+                {
+                    result[c] += vr * M[i];
+                }
+            }
+#else
+            for (int c = 0, i = 0; c < numCols; ++c)
             {
-                result[c] = (Real)0;
-                for (int r = 0; r < M.GetNumRows(); ++r)
+                Real sum = (Real)0;
+                for (int r = 0; r < numRows; ++r, ++i)
                 {
-                    result[c] += V[r] * M(r, c);
+                    sum += V[r] * M[i];
                 }
+                result[c] = sum;
             }
+#endif
             return result;
         }
         LogError("Mismatched sizes.");
     }
 
+    // Support for the matrix products. The products with at least
+    // BlockedMatrixProduct<Real>::THRESHOLD multiply-adds are computed by
+    // the cache-blocked BlockedMatrixProduct, with the rows of the result
+    // partitioned among numThreads threads. Its results are the same as
+    // those of the triple loops used for the smaller products. The inputs
+    // are transposed when transposeA or transposeB are 'true'.
+    template <typename Real>
+    bool MultiplyBlocked(GMatrix<Real> const& A, bool transposeA,
+        GMatrix<Real> const& B, bool transposeB, GMatrix<Real>& result,
+        size_t numThreads)
+    {
+        int const numRows = result.GetNumRows();
+        int const numCols = result.GetNumCols();
+        int const numCommon = (transposeA ? A.GetNumRows() : A.GetNumCols());
+        if (static_cast<double>(numRows) * static_cast<double>(numCols) *
+            static_cast<double>(numCommon) < static_cast<double>(BlockedMatrixProduct<Real>::THRESHOLD))
+        {
+            return false;
+        }
+
+        // The strides of element (r,c) for the storage convention.
+        auto GetStrides = [](GMatrix<Real> const& M, bool transpose, int& rowStride, int& colStride)
+        {
+#if defined(GTE_USE_ROW_MAJOR)
+            rowStride = M.GetNumCols();
+            colStride = 1;
+#else
+            rowStride = 1;
+            colStride = M.GetNumRows();
+#endif
+            if (transpose)
+            {
+                std::swap(rowStride, colStride);
+            }
+        };
+
+        int aRowStride, aColStride, bRowStride, bColStride, cRowStride, cColStride;
+        GetStrides(A, transposeA, aRowStride, aColStride);
+        GetStrides(B, transposeB, bRowStride, bColStride);
+        GetStrides(result, false, cRowStride, cColStride);
+        BlockedMatrixProduct<Real>::Execute(numRows, numCols, numCommon,
+            &A[0], aRowStride, aColStride, &B[0], bRowStride, bColStride,
+            &result[0], cRowStride, cColStride, numThreads);
+        return true;
+    }
+
     // A*B
     template <typename Real>
     GMatrix<Real> operator*(GMatrix<Real> const& A, GMatrix<Real> const& B)
@@ -528,11 +609,17 @@ namespace gte
     }
 
     template <typename Real>
-    GMatrix<Real> MultiplyAB(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyAB(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        size_t numThreads = 1)
     {
         if (A.GetNumCols() == B.GetNumRows())
         {
             GMatrix<Real> result(A.GetNumRows(), B.GetNumCols());
+            if (MultiplyBlocked(A, false, B, false, result, numThreads))
+            {
+                return result;
+            }
+
             int const numCommon = A.GetNumCols();
             for (int r = 0; r < result.GetNumRows(); ++r)
             {
@@ -552,11 +639,17 @@ namespace gte
 
     // A*B^T
     template <typename Real>
-    GMatrix<Real> MultiplyABT(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyABT(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        size_t numThreads = 1)
     {
         if (A.GetNumCols() == B.GetNumCols())
         {
             GMatrix<Real> result(A.GetNumRows(), B.GetNumRows());
+            if (MultiplyBlocked(A, false, B, true, result, numThreads))
+            {
+                return result;
+            }
+
             int const numCommon = A.GetNumCols();
             for (int r = 0; r < result.GetNumRows(); ++r)
             {
@@ -576,11 +669,17 @@ namespace gte
 
     // A^T*B
     template <typename Real>
-    GMatrix<Real> MultiplyATB(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyATB(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        size_t numThreads = 1)
     {
         if (A.GetNumRows() == B.GetNumRows())
         {
             GMatrix<Real> result(A.GetNumCols(), B.GetNumCols());
+            if (MultiplyBlocked(A, true, B, false, result, numThreads))
+            {
+                return result;
+            }
+
             int const numCommon = A.GetNumRows();
             for (int r = 0; r < result.GetNumRows(); ++r)
             {
@@ -600,11 +699,17 @@ namespace gte
 
     // A^T*B^T
     template <typename Real>
-    GMatrix<Real> MultiplyATBT(GMatrix<Real> const& A, GMatrix<Real> const& B)
+    GMatrix<Real> MultiplyATBT(GMatrix<Real> const& A, GMatrix<Real> const& B,
+        size_t numThreads = 1)
     {
         if (A.GetNumRows() == B.GetNumCols())
         {
             GMatrix<Real> result(A.GetNumCols(), B.GetNumRows());
+            if (MultiplyBlocked(A, true, B, true, result, numThreads))
+            {
+                return result;
+            }
+
             int const numCommon = A.GetNumRows();
             for (int r = 0; r < result.GetNumRows(); ++r)
             {
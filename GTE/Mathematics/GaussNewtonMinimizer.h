@@ -3,12 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/CholeskyDecomposition.h>
+#include <Mathematics/CSRMatrix.h>
+#include <Mathematics/SparseCholesky.h>
+#include <Mathematics/TaskScheduler.h>
 #include <functional>
+#include <memory>
+#include <vector>
 
 // Let F(p) = (F_{0}(p), F_{1}(p), ..., F_{n-1}(p)) be a vector-valued
 // function of the parameters p = (p_{0}, p_{1}, ..., p_{m-1}).  The
@@ -49,6 +54,18 @@
 // advantage; for example, 3-tuples of components of F(p) might correspond to
 // vectors that can be manipulated using an already existing mathematics
 // library.  The implementation here supports both approaches.
+//
+// When many components of J are zero, J^T*J can be computed as a sparse
+// matrix, in which case the linear systems are solved by SparseCholesky
+// with the minimum degree ordering, which is effective for the normal
+// equations of problems such as bundle adjustment.
+// ResidualBlocks.h creates the function objects for problems whose F is
+// partitioned into blocks of components, computing J^T*J and J^T*F in
+// parallel as dense or sparse matrices.
+//
+// The minimizer can be run from several initial guesses concurrently, each
+// thread using its own minimizer, so the function objects must be
+// reentrant in that case.
 
 namespace gte
 {
@@ -66,6 +83,8 @@ namespace gte
         typedef std::function<void(DVector const&, RVector&)> FFunction;
         typedef std::function<void(DVector const&, JMatrix&)> JFunction;
         typedef std::function<void(DVector const&, JTJMatrix&, JTFVector&)> JPlusFunction;
+        typedef CSRMatrix<Real> SparseJTJMatrix;  // numPDimensions-by-numPDimensions
+        typedef std::function<void(DVector const&, SparseJTJMatrix&, JTFVector&)> SparseJPlusFunction;
 
         // Create the minimizer that computes F(p) and J(p) directly.
         GaussNewtonMinimizer(int numPDimensions, int numFDimensions,
@@ -80,7 +99,7 @@ namespace gte
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(true)
+            mMode(Mode::J_FUNCTION)
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
@@ -94,11 +113,28 @@ namespace gte
             mFFunction(inFFunction),
             mJPlusFunction(inJPlusFunction),
             mF(mNumFDimensions),
-            mJ(mNumFDimensions, mNumPDimensions),
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(false)
+            mMode(Mode::JPLUS_FUNCTION)
+        {
+            LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
+        }
+
+        // Create the minimizer that computes J^T(p)*J(p) as a sparse matrix
+        // and -J(p)*F(p). The function must set the structure of the matrix
+        // on its first call; it is then called with the same matrix.
+        GaussNewtonMinimizer(int numPDimensions, int numFDimensions,
+            FFunction const& inFFunction, SparseJPlusFunction const& inSparseJPlusFunction)
+            :
+            mNumPDimensions(numPDimensions),
+            mNumFDimensions(numFDimensions),
+            mFFunction(inFFunction),
+            mSparseJPlusFunction(inSparseJPlusFunction),
+            mF(mNumFDimensions),
+            mNegJTF(mNumPDimensions),
+            mDecomposer(mNumPDimensions),
+            mMode(Mode::SPARSE_JPLUS_FUNCTION)
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
@@ -153,7 +189,7 @@ namespace gte
             for (result.numIterations = 1; result.numIterations <= maxIterations; ++result.numIterations)
             {
                 ComputeLinearSystemInputs(pCurrent);
-                if (!mDecomposer.Factor(mJTJ))
+                if (!SolveLinearSystem())
                 {
                     // TODO: The matrix mJTJ is positive semi-definite, so the
                     // failure can occur when mJTJ has a zero eigenvalue in
@@ -161,8 +197,6 @@ namespace gte
                     // anyway, perhaps using gradient descent?
                     return result;
                 }
-                mDecomposer.SolveLower(mJTJ, mNegJTF);
-                mDecomposer.SolveUpper(mJTJ, mNegJTF);
 
                 auto pNext = pCurrent + mNegJTF;
                 mFFunction(pNext, mF);
@@ -187,34 +221,116 @@ namespace gte
             return result;
         }
 
+        // Run the minimizer from each of the initial guesses p0[i] and
+        // return the results in the same order. The guesses are distributed
+        // over numThreads threads, each with its own minimizer, so the
+        // function objects are called concurrently when numThreads > 1. The
+        // threads are tasks of the scheduler when it is not null.
+        std::vector<Result> operator()(std::vector<DVector> const& p0, size_t maxIterations,
+            Real updateLengthTolerance, Real errorDifferenceTolerance, size_t numThreads,
+            TaskScheduler* scheduler = nullptr)
+        {
+            std::vector<Result> results(p0.size());
+            numThreads = std::max(std::min(numThreads, p0.size()), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numThreads,
+                [this, &p0, &results, maxIterations, updateLengthTolerance,
+                errorDifferenceTolerance, numThreads](size_t t)
+                {
+                    auto minimizer = CreateMinimizer();
+                    for (size_t i = t; i < p0.size(); i += numThreads)
+                    {
+                        results[i] = (*minimizer)(p0[i], maxIterations, updateLengthTolerance,
+                            errorDifferenceTolerance);
+                    }
+                });
+            return results;
+        }
+
     private:
+        enum class Mode
+        {
+            J_FUNCTION,
+            JPLUS_FUNCTION,
+            SPARSE_JPLUS_FUNCTION
+        };
+
         void ComputeLinearSystemInputs(DVector const& pCurrent)
         {
-            if (mUseJFunction)
+            if (mMode == Mode::J_FUNCTION)
             {
                 mJFunction(pCurrent, mJ);
                 mJTJ = MultiplyATB(mJ, mJ);
                 mNegJTF = -(mF * mJ);
             }
-            else
+            else if (mMode == Mode::JPLUS_FUNCTION)
             {
                 mJPlusFunction(pCurrent, mJTJ, mNegJTF);
             }
+            else
+            {
+                mSparseJPlusFunction(pCurrent, mSparseJTJ, mNegJTF);
+            }
+        }
+
+        // Solve J^T*J*d = -J^T*F, storing d in mNegJTF. The return value is
+        // 'false' when the factorization of J^T*J fails.
+        bool SolveLinearSystem()
+        {
+            if (mMode == Mode::SPARSE_JPLUS_FUNCTION)
+            {
+                if (!mSparseDecomposer.Factor(mSparseJTJ,
+                    SparseCholesky<Real>::Ordering::MINIMUM_DEGREE))
+                {
+                    return false;
+                }
+                mSparseDecomposer.Solve(&mNegJTF[0], &mNegJTF[0]);
+                return true;
+            }
+
+            if (!mDecomposer.Factor(mJTJ))
+            {
+                return false;
+            }
+            mDecomposer.SolveLower(mJTJ, mNegJTF);
+            mDecomposer.SolveUpper(mJTJ, mNegJTF);
+            return true;
+        }
+
+        std::unique_ptr<GaussNewtonMinimizer> CreateMinimizer() const
+        {
+            if (mMode == Mode::J_FUNCTION)
+            {
+                return std::make_unique<GaussNewtonMinimizer>(mNumPDimensions,
+                    mNumFDimensions, mFFunction, mJFunction);
+            }
+            else if (mMode == Mode::JPLUS_FUNCTION)
+            {
+                return std::make_unique<GaussNewtonMinimizer>(mNumPDimensions,
+                    mNumFDimensions, mFFunction, mJPlusFunction);
+            }
+            else
+            {
+                return std::make_unique<GaussNewtonMinimizer>(mNumPDimensions,
+                    mNumFDimensions, mFFunction, mSparseJPlusFunction);
+            }
         }
 
         int mNumPDimensions, mNumFDimensions;
         FFunction mFFunction;
         JFunction mJFunction;
         JPlusFunction mJPlusFunction;
+        SparseJPlusFunction mSparseJPlusFunction;
 
         // Storage for J^T(p)*J(p) and -J^T(p)*F(p) during the iterations.
         RVector mF;
         JMatrix mJ;
         JTJMatrix mJTJ;
+        SparseJTJMatrix mSparseJTJ;
         JTFVector mNegJTF;
 
         CholeskyDecomposition<Real> mDecomposer;
+        SparseCholesky<Real> mSparseDecomposer;
 
-        bool mUseJFunction;
+        Mode mMode;
     };
 }
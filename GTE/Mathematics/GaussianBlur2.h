@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -38,12 +38,13 @@ namespace gte
     protected:
         virtual void OnUpdateSingle(int x, int y) override
         {
-            this->LookUp5(x, y);
+            typename PdeFilter2<Real>::Neighborhood u;
+            this->LookUp5(x, y, u);
 
-            Real uxx = this->mInvDxDx * (this->mUpz - (Real)2 * this->mUzz + this->mUmz);
-            Real uyy = this->mInvDyDy * (this->mUzp - (Real)2 * this->mUzz + this->mUzm);
+            Real uxx = this->mInvDxDx * (u.pz - (Real)2 * u.zz + u.mz);
+            Real uyy = this->mInvDyDy * (u.zp - (Real)2 * u.zz + u.zm);
 
-            this->mBuffer[this->mDst][y][x] = this->mUzz + this->mTimeStep * (uxx + uyy);
+            this->mBuffer[this->mDst][y][x] = u.zz + this->mTimeStep * (uxx + uyy);
         }
 
         Real mMaximumTimeStep;
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -37,13 +37,14 @@ namespace gte
     protected:
         virtual void OnUpdateSingle(int x, int y, int z) override
         {
-            this->LookUp7(x, y, z);
+            typename PdeFilter3<Real>::Neighborhood u;
+            this->LookUp7(x, y, z, u);
 
-            Real uxx = this->mInvDxDx * (this->mUpzz - (Real)2 * this->mUzzz + this->mUmzz);
-            Real uyy = this->mInvDyDy * (this->mUzpz - (Real)2 * this->mUzzz + this->mUzmz);
-            Real uzz = this->mInvDzDz * (this->mUzzp - (Real)2 * this->mUzzz + this->mUzzm);
+            Real uxx = this->mInvDxDx * (u.pzz - (Real)2 * u.zzz + u.mzz);
+            Real uyy = this->mInvDyDy * (u.zpz - (Real)2 * u.zzz + u.zmz);
+            Real uzz = this->mInvDzDz * (u.zzp - (Real)2 * u.zzz + u.zzm);
 
-            this->mBuffer[this->mDst][z][y][x] = this->mUzzz + this->mTimeStep * (uxx + uyy + uzz);
+            this->mBuffer[this->mDst][z][y][x] = u.zzz + this->mTimeStep * (uxx + uyy + uzz);
         }
 
         Real mMaximumTimeStep;
@@ -3,17 +3,21 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.25
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Vector2.h>
 #include <Mathematics/Vector3.h>
-#include <Mathematics/ETManifoldMesh.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/VertexAdjacency.h>
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <functional>
-#include <thread>
+#include <limits>
+#include <memory>
 
 // This class is an implementation of the barycentric mapping algorithm
 // described in Section 5.3 of the book
@@ -32,6 +36,12 @@
 // texture coordinates are propagated inward by updating the vertices in
 // topological distance order, leading to fast convergence for large numbers
 // of vertices.
+//
+// The vertex graph is built from a VertexAdjacency of the index buffer. The
+// topology is kept between calls of operator(), so when the mesh is
+// parameterized again with the same indices, for example after its
+// vertices were edited, only the weights and the texture coordinates are
+// recomputed.
 
 namespace gte
 {
@@ -47,13 +57,21 @@ namespace gte
         // std::numeric_limits<uint32_t>::max().  Provide a callback when you
         // want to monitor each iteration of the uv-solver.  The input to the
         // progress callback is the current iteration; it starts at 1 and
-        // increases to the numIterations input to the operator() member
-        // function.
+        // increases to at most the numIterations input to the operator()
+        // member function.
+        //
+        // The multithreaded solver partitions the vertices into numThreads
+        // subsets that are updated by the tasks of a scheduler. The threads
+        // of the scheduler are created once per call of operator() unless a
+        // scheduler is specified by SetScheduler(*).
         GenerateMeshUV(uint32_t numThreads,
             std::function<void(uint32_t)> const* progress = nullptr)
             :
             mNumThreads(numThreads),
+            mScheduler(nullptr),
             mProgress(progress),
+            mTolerance((Real)0),
+            mNumIterations(0),
             mNumVertices(0),
             mVertices(nullptr),
             mTCoords(nullptr),
@@ -64,6 +82,42 @@ namespace gte
 
         virtual ~GenerateMeshUV() = default;
 
+        // Execute the iterations of the multithreaded solver as tasks of the
+        // scheduler, which can be shared with other computations. The
+        // results do not depend on the scheduler.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // The iterations stop when no texture coordinate changes by more
+        // than the tolerance in an iteration, or when the numIterations
+        // input to operator() is reached. The default tolerance is zero,
+        // in which case all numIterations iterations are executed. The
+        // tolerance bounds the change per iteration, not the error, which
+        // is larger for meshes that converge slowly. The GPU-based derived
+        // classes test the changes every few iterations.
+        inline void SetTolerance(Real tolerance)
+        {
+            mTolerance = std::max(tolerance, (Real)0);
+        }
+
+        inline Real GetTolerance() const
+        {
+            return mTolerance;
+        }
+
+        // The number of iterations executed by the last call of operator().
+        inline uint32_t GetNumIterations() const
+        {
+            return mNumIterations;
+        }
+
         // The incoming mesh must be edge-triangle manifold and have rectangle
         // topology (simply connected, closed polyline boundary).  The arrays
         // 'vertices' and 'tcoords' must both have 'numVertices' elements.
@@ -82,6 +136,12 @@ namespace gte
                 ++numIterations;
             }
 
+            // The topology is reused when the indices are those of the
+            // previous call.
+            bool const sameTopology = (numVertices == mNumVertices &&
+                static_cast<size_t>(numIndices) == mIndices.size() &&
+                std::equal(mIndices.begin(), mIndices.end(), indices));
+
             mNumVertices = numVertices;
             mVertices = vertices;
             mTCoords = tcoords;
@@ -96,19 +156,13 @@ namespace gte
                 mTCoords[i][1] = (Real)-1;
             }
 
-            // Create the manifold mesh data structure.
-            mGraph.Clear();
-            int const numTriangles = numIndices / 3;
-            for (int t = 0; t < numTriangles; ++t)
+            if (!sameTopology)
             {
-                int v0 = *indices++;
-                int v1 = *indices++;
-                int v2 = *indices++;
-                mGraph.Insert(v0, v1, v2);
+                mIndices.assign(indices, indices + numIndices);
+                CreateVertexGraph();
+                TopologicalVertexDistanceTransform();
             }
 
-            TopologicalVertexDistanceTransform();
-
             if (useSquareTopology)
             {
                 AssignBoundaryTextureCoordinatesSquare();
@@ -125,6 +179,8 @@ namespace gte
     protected:
         // A CPU-based implementation is provided by this class.  The derived
         // classes using the GPU override this function.
+        // The function sets mNumIterations to the number of iterations
+        // executed.
         virtual void SolveSystemInternal(uint32_t numIterations)
         {
             if (mNumThreads > 1)
@@ -139,16 +195,20 @@ namespace gte
 
         // Constructor inputs.
         uint32_t mNumThreads;
+        TaskScheduler* mScheduler;
         std::function<void(uint32_t)> const* mProgress;
+        Real mTolerance;
+        uint32_t mNumIterations;
 
         // Convenience members that store the input parameters to operator().
         int mNumVertices;
         Vector3<Real> const* mVertices;
         Vector2<Real>* mTCoords;
 
-        // The edge-triangle manifold graph, where each edge is shared by at
-        // most two triangles.
-        ETManifoldMesh mGraph;
+        // The indices of the last call and their vertex adjacency. Each
+        // edge is shared by at most two triangles.
+        std::vector<int> mIndices;
+        VertexAdjacency mAdjacency;
 
         // The mVertexInfo array stores -1 for the interior vertices.  For a
         // boundary edge <v0,v1> that is counterclockwise,
@@ -156,8 +216,6 @@ namespace gte
         enum { INTERIOR_VERTEX = -1 };
         std::vector<int> mVertexInfo;
         int mNumBoundaryEdges, mBoundaryStart;
-        typedef ETManifoldMesh::Edge Edge;
-        std::set<Edge*> mInteriorEdges;
 
         // The vertex graph required to set up a sparse linear system of
         // equations to determine the texture coordinates.
@@ -168,7 +226,8 @@ namespace gte
 
             // The value range0 is the index into mVertexGraphData for the
             // first adjacent vertex.  The value range1 is the number of
-            // adjacent vertices.
+            // adjacent vertices.  These are the offsets and the row lengths
+            // of mAdjacency.
             int range0, range1;
 
             // Unused on the CPU. The padding is necessary for the HLSL and
@@ -188,119 +247,84 @@ namespace gte
         std::vector<int> mOrderedVertices;
 
     private:
-        void TopologicalVertexDistanceTransform()
+        void CreateVertexGraph()
         {
-            // Initialize the graph information.
+            // The adjacency is stored in a single array, which avoids a
+            // dynamic data structure with a large number of containers that
+            // take a very long time to destroy when a debugger is attached
+            // to the executable.  It is also necessary to bundle the data
+            // this way for a GPU version of the algorithm.
+            size_t const numTriangles = mIndices.size() / 3;
+            mAdjacency.Create(static_cast<size_t>(mNumVertices), numTriangles, mIndices.data());
+            auto const& offsets = mAdjacency.GetOffsets();
+            auto const& adjacent = mAdjacency.GetAdjacent();
+            auto const& numEdgeTriangles = mAdjacency.GetNumEdgeTriangles();
+
+            mVertexGraph.resize(mNumVertices);
+            for (int v = 0; v < mNumVertices; ++v)
+            {
+                mVertexGraph[v].range0 = static_cast<int>(offsets[v]);
+                mVertexGraph[v].range1 = static_cast<int>(offsets[v + 1] - offsets[v]);
+                mVertexGraph[v].padding = 0;
+            }
+
+            mVertexGraphData.resize(adjacent.size());
+            for (size_t k = 0; k < adjacent.size(); ++k)
+            {
+                mVertexGraphData[k] = std::make_pair(static_cast<int>(adjacent[k]), (Real)0);
+            }
+
+            // An edge shared by one triangle is a boundary edge.  The
+            // ordering of its vertex indices in the triangle makes the edge
+            // counterclockwise.
             mVertexInfo.resize(mNumVertices);
             std::fill(mVertexInfo.begin(), mVertexInfo.end(), INTERIOR_VERTEX);
-            mVertexGraph.resize(mNumVertices);
-            mVertexGraphData.resize(2 * mGraph.GetEdges().size());
-            std::pair<int, Real> initialData = std::make_pair(-1, (Real)-1);
-            std::fill(mVertexGraphData.begin(), mVertexGraphData.end(), initialData);
-            mOrderedVertices.resize(mNumVertices);
-            mInteriorEdges.clear();
             mNumBoundaryEdges = 0;
             mBoundaryStart = std::numeric_limits<int>::max();
-
-            // Count the number of adjacent vertices for each vertex.  For
-            // data sets with a large number of vertices, this is a
-            // preprocessing step to avoid a dynamic data structure that has
-            // a large number of std:map objects that take a very long time
-            // to destroy when a debugger is attached to the executable.
-            // Instead, we allocate a single array that stores all the
-            // adjacency information.  It is also necessary to bundle the
-            // data this way for a GPU version of the algorithm.
-            std::vector<int> numAdjacencies(mNumVertices);
-            std::fill(numAdjacencies.begin(), numAdjacencies.end(), 0);
-
-            for (auto const& element : mGraph.GetEdges())
+            for (size_t t = 0; t < numTriangles; ++t)
             {
-                ++numAdjacencies[element.first.V[0]];
-                ++numAdjacencies[element.first.V[1]];
-
-                if (element.second->T[1])
+                int const* triangle = &mIndices[3 * t];
+                for (size_t i = 0; i < 3; ++i)
                 {
-                    // This is an interior edge.
-                    mInteriorEdges.insert(element.second.get());
-                }
-                else
-                {
-                    // This is a boundary edge.  Determine the ordering of the
-                    // vertex indices to make the edge counterclockwise.
-                    ++mNumBoundaryEdges;
-                    int v0 = element.second->V[0], v1 = element.second->V[1];
-                    auto tri = element.second->T[0];
-                    int i;
-                    for (i = 0; i < 3; ++i)
+                    int v0 = triangle[i], v1 = triangle[(i + 1) % 3];
+                    size_t k = mAdjacency.Find(v0, v1);
+                    if (numEdgeTriangles[k] == 1)
                     {
-                        int v2 = tri->V[i];
-                        if (v2 != v0 && v2 != v1)
-                        {
-                            // The vertex is opposite the boundary edge.
-                            v0 = tri->V[(i + 1) % 3];
-                            v1 = tri->V[(i + 2) % 3];
-                            mVertexInfo[v0] = v1;
-                            mBoundaryStart = std::min(mBoundaryStart, v0);
-                            break;
-                        }
+                        ++mNumBoundaryEdges;
+                        mVertexInfo[v0] = v1;
+                        mBoundaryStart = std::min(mBoundaryStart, v0);
                     }
                 }
             }
+        }
 
-            // Set the range data for each vertex.
-            for (int vIndex = 0, aIndex = 0; vIndex < mNumVertices; ++vIndex)
-            {
-                int numAdjacent = numAdjacencies[vIndex];
-                mVertexGraph[vIndex].range0 = aIndex;
-                mVertexGraph[vIndex].range1 = numAdjacent;
-                aIndex += numAdjacent;
-                mVertexGraph[vIndex].padding = 0;
-            }
-
-            // Compute a topological distance transform of the vertices.
-            std::set<int> currFront;
-            for (auto const& element : mGraph.GetEdges())
+        void TopologicalVertexDistanceTransform()
+        {
+            // The boundary vertices have distance 0.
+            mOrderedVertices.resize(mNumVertices);
+            std::vector<int> currFront;
+            for (int v = 0; v < mNumVertices; ++v)
             {
-                int v0 = element.second->V[0], v1 = element.second->V[1];
-                for (int i = 0; i < 2; ++i)
+                if (mVertexInfo[v] == INTERIOR_VERTEX)
                 {
-                    if (mVertexInfo[v0] == INTERIOR_VERTEX)
-                    {
-                        mVertexGraph[v0].distance = -1;
-                    }
-                    else
-                    {
-                        mVertexGraph[v0].distance = 0;
-                        currFront.insert(v0);
-                    }
-
-                    // Insert v1 into the first available slot of the
-                    // adjacency array.
-                    int range0 = mVertexGraph[v0].range0;
-                    int range1 = mVertexGraph[v0].range1;
-                    for (int j = 0; j < range1; ++j)
-                    {
-                        std::pair<int, Real>& data = mVertexGraphData[range0 + j];
-                        if (data.second == (Real)-1)
-                        {
-                            data.first = v1;
-                            data.second = (Real)0;
-                            break;
-                        }
-                    }
-
-                    std::swap(v0, v1);
+                    mVertexGraph[v].distance = -1;
+                }
+                else
+                {
+                    mVertexGraph[v].distance = 0;
+                    currFront.push_back(v);
                 }
             }
 
             // Use a breadth-first search to propagate the distance
-            // information.
+            // information.  The vertices of each front are sorted.
             int nextDistance = 1;
             size_t numFrontVertices = currFront.size();
             std::copy(currFront.begin(), currFront.end(), mOrderedVertices.begin());
+            std::vector<int> nextFront;
             while (currFront.size() > 0)
             {
-                std::set<int> nextFront;
+                nextFront.clear();
                 for (auto v : currFront)
                 {
                     int range0 = mVertexGraph[v].range0;
@@ -312,13 +336,14 @@ namespace gte
                         if (mVertexGraph[a].distance == -1)
                         {
                             mVertexGraph[a].distance = nextDistance;
-                            nextFront.insert(a);
+                            nextFront.push_back(a);
                         }
                     }
                 }
+                std::sort(nextFront.begin(), nextFront.end());
                 std::copy(nextFront.begin(), nextFront.end(), mOrderedVertices.begin() + numFrontVertices);
                 numFrontVertices += nextFront.size();
-                currFront = std::move(nextFront);
+                std::swap(currFront, nextFront);
                 ++nextDistance;
             }
         }
@@ -448,70 +473,66 @@ namespace gte
 
         void ComputeMeanValueWeights()
         {
-            for (auto const& edge : mInteriorEdges)
+            // The weight for X0 associated with X1 is the sum of
+            // tan(angle/2) for the angles at X0 of the triangles sharing
+            // edge <X0,X1>, divided by the length of the edge.  Each
+            // triangle corner contributes to the weights of its two edges.
+            for (auto& data : mVertexGraphData)
             {
-                int v0 = edge->V[0], v1 = edge->V[1];
-                for (int i = 0; i < 2; ++i)
+                data.second = (Real)0;
+            }
+
+            size_t const numTriangles = mIndices.size() / 3;
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                int const* triangle = &mIndices[3 * t];
+                for (size_t i = 0; i < 3; ++i)
                 {
-                    // Compute the direction from X0 to X1 and compute the
-                    // length of the edge (X0,X1).
-                    Vector3<Real> X0 = mVertices[v0];
-                    Vector3<Real> X1 = mVertices[v1];
-                    Vector3<Real> X1mX0 = X1 - X0;
-                    Real x1mx0length = Normalize(X1mX0);
-                    Real weight;
-                    if (x1mx0length > (Real)0)
+                    int v0 = triangle[i];
+                    int v1 = triangle[(i + 1) % 3];
+                    int v2 = triangle[(i + 2) % 3];
+                    Vector3<Real> X1mX0 = mVertices[v1] - mVertices[v0];
+                    Vector3<Real> X2mX0 = mVertices[v2] - mVertices[v0];
+                    Real x1mx0Length = Normalize(X1mX0);
+                    Real x2mx0Length = Normalize(X2mX0);
+                    Real weight1, weight2;
+                    if (x1mx0Length > (Real)0 && x2mx0Length > (Real)0)
                     {
-                        // Compute the weight for X0 associated with X1.
-                        weight = (Real)0;
-                        for (int j = 0; j < 2; ++j)
-                        {
-                            // Find the vertex of triangle T[j] opposite edge
-                            // <X0,X1>.
-                            auto tri = edge->T[j];
-                            int k;
-                            for (k = 0; k < 3; ++k)
-                            {
-                                int v2 = tri->V[k];
-                                if (v2 != v0 && v2 != v1)
-                                {
-                                    Vector3<Real> X2 = mVertices[v2];
-                                    Vector3<Real> X2mX0 = X2 - X0;
-                                    Real x2mx0Length = Normalize(X2mX0);
-                                    if (x2mx0Length > (Real)0)
-                                    {
-                                        Real dot = Dot(X2mX0, X1mX0);
-                                        Real cs = std::min(std::max(dot, (Real)-1), (Real)1);
-                                        Real angle = std::acos(cs);
-                                        weight += std::tan(angle * (Real)0.5);
-                                    }
-                                    else
-                                    {
-                                        weight += (Real)1;
-                                    }
-                                    break;
-                                }
-                            }
-                        }
-                        weight /= x1mx0length;
+                        Real dot = Dot(X2mX0, X1mX0);
+                        Real cs = std::min(std::max(dot, (Real)-1), (Real)1);
+                        Real angle = std::acos(cs);
+                        weight1 = std::tan(angle * (Real)0.5);
+                        weight2 = weight1;
                     }
                     else
                     {
-                        weight = (Real)1;
+                        // The weight of a degenerate edge is replaced by 1
+                        // below.
+                        weight1 = (Real)1;
+                        weight2 = (Real)1;
                     }
 
-                    int range0 = mVertexGraph[v0].range0;
-                    int range1 = mVertexGraph[v0].range1;
-                    for (int j = 0; j < range1; ++j)
+                    mVertexGraphData[mAdjacency.Find(v0, v1)].second += weight1;
+                    mVertexGraphData[mAdjacency.Find(v0, v2)].second += weight2;
+                }
+            }
+
+            for (int v0 = 0; v0 < mNumVertices; ++v0)
+            {
+                int range0 = mVertexGraph[v0].range0;
+                int range1 = mVertexGraph[v0].range1;
+                for (int j = 0; j < range1; ++j)
+                {
+                    std::pair<int, Real>& data = mVertexGraphData[range0 + j];
+                    Real length = Length(mVertices[data.first] - mVertices[v0]);
+                    if (length > (Real)0)
                     {
-                        std::pair<int, Real>& data = mVertexGraphData[range0 + j];
-                        if (data.first == v1)
-                        {
-                            data.second = weight;
-                        }
+                        data.second /= length;
+                    }
+                    else
+                    {
+                        data.second = (Real)1;
                     }
-
-                    std::swap(v0, v1);
                 }
             }
         }
@@ -548,6 +569,40 @@ namespace gte
             SolveSystemInternal(numIterations);
         }
 
+        // Execute one iteration for the ordered vertices jmin through
+        // jmax-1 and return the maximum change of a texture coordinate
+        // channel, which is computed only when the tolerance is positive.
+        Real Iterate(int jmin, int jmax, Vector2<Real> const* inTCoords,
+            Vector2<Real>* outTCoords) const
+        {
+            Real maxChange = (Real)0;
+            for (int j = jmin; j < jmax; ++j)
+            {
+                int v0 = mOrderedVertices[j];
+                int range0 = mVertexGraph[v0].range0;
+                int range1 = mVertexGraph[v0].range1;
+                auto const* current = &mVertexGraphData[range0];
+                Vector2<Real> tcoord{ (Real)0, (Real)0 };
+                Real weight, weightSum = (Real)0;
+                for (int k = 0; k < range1; ++k, ++current)
+                {
+                    int v1 = current->first;
+                    weight = current->second;
+                    weightSum += weight;
+                    tcoord += weight * inTCoords[v1];
+                }
+                tcoord /= weightSum;
+                outTCoords[v0] = tcoord;
+
+                if (mTolerance > (Real)0)
+                {
+                    Vector2<Real> diff = tcoord - inTCoords[v0];
+                    maxChange = std::max(maxChange, std::max(std::fabs(diff[0]), std::fabs(diff[1])));
+                }
+            }
+            return maxChange;
+        }
+
         void SolveSystemCPUSingle(uint32_t numIterations)
         {
             // Use ping-pong buffers for the texture coordinates.
@@ -557,9 +612,7 @@ namespace gte
             Vector2<Real>* inTCoords = mTCoords;
             Vector2<Real>* outTCoords = &tcoords[0];
 
-            // The value numIterations is even, so we always swap an even
-            // number of times.  This ensures that on exit from the loop,
-            // outTCoords is tcoords.
+            mNumIterations = 0;
             for (uint32_t i = 1; i <= numIterations; ++i)
             {
                 if (mProgress)
@@ -567,26 +620,21 @@ namespace gte
                     (*mProgress)(i);
                 }
 
-                for (int j = mNumBoundaryEdges; j < mNumVertices; ++j)
+                Real maxChange = Iterate(mNumBoundaryEdges, mNumVertices, inTCoords, outTCoords);
+                std::swap(inTCoords, outTCoords);
+                ++mNumIterations;
+                if (mTolerance > (Real)0 && maxChange <= mTolerance)
                 {
-                    int v0 = mOrderedVertices[j];
-                    int range0 = mVertexGraph[v0].range0;
-                    int range1 = mVertexGraph[v0].range1;
-                    auto const* current = &mVertexGraphData[range0];
-                    Vector2<Real> tcoord{ (Real)0, (Real)0 };
-                    Real weight, weightSum = (Real)0;
-                    for (int k = 0; k < range1; ++k, ++current)
-                    {
-                        int v1 = current->first;
-                        weight = current->second;
-                        weightSum += weight;
-                        tcoord += weight * inTCoords[v1];
-                    }
-                    tcoord /= weightSum;
-                    outTCoords[v0] = tcoord;
+                    break;
                 }
+            }
 
-                std::swap(inTCoords, outTCoords);
+            // The final iterate is in inTCoords.  The value numIterations
+            // is even, so unless the iterations converged early, it is
+            // mTCoords.
+            if (inTCoords != mTCoords)
+            {
+                std::memcpy(mTCoords, inTCoords, numBytes);
             }
         }
 
@@ -609,10 +657,19 @@ namespace gte
                 vmax[t] = vmin[t] + numVPerThread - 1;
             }
             vmax[mNumThreads - 1] = mNumVertices - 1;
+            std::vector<Real> maxChanges(mNumThreads);
 
-            // The value numIterations is even, so we always swap an even
-            // number of times.  This ensures that on exit from the loop,
-            // outTCoords is tcoords.
+            // The threads are created once for all the iterations when no
+            // scheduler is specified.
+            std::unique_ptr<TaskScheduler> localScheduler;
+            TaskScheduler* scheduler = mScheduler;
+            if (!scheduler)
+            {
+                localScheduler = std::make_unique<TaskScheduler>(mNumThreads);
+                scheduler = localScheduler.get();
+            }
+
+            mNumIterations = 0;
             for (uint32_t i = 1; i <= numIterations; ++i)
             {
                 if (mProgress)
@@ -620,41 +677,25 @@ namespace gte
                     (*mProgress)(i);
                 }
 
-                // Execute Gauss-Seidel iterations in multiple threads.
-                std::vector<std::thread> process(mNumThreads);
-                for (uint32_t t = 0; t < mNumThreads; ++t)
-                {
-                    process[t] = std::thread([this, t, &vmin, &vmax, inTCoords,
-                        outTCoords]()
-                        {
-                            for (int j = vmin[t]; j <= vmax[t]; ++j)
-                            {
-                                int v0 = mOrderedVertices[j];
-                                int range0 = mVertexGraph[v0].range0;
-                                int range1 = mVertexGraph[v0].range1;
-                                auto const* current = &mVertexGraphData[range0];
-                                Vector2<Real> tcoord{ (Real)0, (Real)0 };
-                                Real weight, weightSum = (Real)0;
-                                for (int k = 0; k < range1; ++k, ++current)
-                                {
-                                    int v1 = current->first;
-                                    weight = current->second;
-                                    weightSum += weight;
-                                    tcoord += weight * inTCoords[v1];
-                                }
-                                tcoord /= weightSum;
-                                outTCoords[v0] = tcoord;
-                            }
-                        });
-                }
+                // Execute the iterations in multiple threads.
+                scheduler->ParallelFor(mNumThreads, [this, &vmin, &vmax, &maxChanges,
+                    inTCoords, outTCoords](size_t t)
+                    {
+                        maxChanges[t] = Iterate(vmin[t], vmax[t] + 1, inTCoords, outTCoords);
+                    });
 
-                // Wait for all threads to finish.
-                for (uint32_t t = 0; t < mNumThreads; ++t)
+                std::swap(inTCoords, outTCoords);
+                ++mNumIterations;
+                if (mTolerance > (Real)0 &&
+                    *std::max_element(maxChanges.begin(), maxChanges.end()) <= mTolerance)
                 {
-                    process[t].join();
+                    break;
                 }
+            }
 
-                std::swap(inTCoords, outTCoords);
+            if (inTCoords != mTCoords)
+            {
+                std::memcpy(mTCoords, inTCoords, numBytes);
             }
         }
     };
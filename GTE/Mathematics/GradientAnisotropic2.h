@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -34,15 +34,29 @@ namespace gte
     protected:
         void ComputeParameter()
         {
-            Real gradMagSqr = (Real)0;
-            for (int y = 1; y <= this->mYBound; ++y)
+            // The rows are summed in parallel and the row sums are added in
+            // order, so the sum does not depend on the number of threads.
+            // GetUx and GetUy take unpadded coordinates.
+            std::vector<Real> rowSum(static_cast<size_t>(this->mYBound), (Real)0);
+            this->Execute(0, this->mYBound, [this, &rowSum](int yBegin, int yEnd)
             {
-                for (int x = 1; x <= this->mXBound; ++x)
+                for (int y = yBegin; y < yEnd; ++y)
                 {
-                    Real ux = this->GetUx(x, y);
-                    Real uy = this->GetUy(x, y);
-                    gradMagSqr += ux * ux + uy * uy;
+                    Real sum = (Real)0;
+                    for (int x = 0; x < this->mXBound; ++x)
+                    {
+                        Real ux = this->GetUx(x, y);
+                        Real uy = this->GetUy(x, y);
+                        sum += ux * ux + uy * uy;
+                    }
+                    rowSum[y] = sum;
                 }
+            });
+
+            Real gradMagSqr = (Real)0;
+            for (auto sum : rowSum)
+            {
+                gradMagSqr += sum;
             }
             gradMagSqr /= (Real)this->mQuantity;
 
@@ -52,26 +66,30 @@ namespace gte
 
         virtual void OnPreUpdate() override
         {
+            // The base class recomputes the Neumann mask border, which the
+            // parameter depends on.
+            PdeFilter2<Real>::OnPreUpdate();
             ComputeParameter();
         }
 
         virtual void OnUpdateSingle(int x, int y) override
         {
-            this->LookUp9(x, y);
+            typename PdeFilter2<Real>::Neighborhood u;
+            this->LookUp9(x, y, u);
 
             // one-sided U-derivative estimates
-            Real uxFwd = this->mInvDx * (this->mUpz - this->mUzz);
-            Real uxBwd = this->mInvDx * (this->mUzz - this->mUmz);
-            Real uyFwd = this->mInvDy * (this->mUzp - this->mUzz);
-            Real uyBwd = this->mInvDy * (this->mUzz - this->mUzm);
+            Real uxFwd = this->mInvDx * (u.pz - u.zz);
+            Real uxBwd = this->mInvDx * (u.zz - u.mz);
+            Real uyFwd = this->mInvDy * (u.zp - u.zz);
+            Real uyBwd = this->mInvDy * (u.zz - u.zm);
 
             // centered U-derivative estimates
-            Real uxCenM = this->mHalfInvDx * (this->mUpm - this->mUmm);
-            Real uxCenZ = this->mHalfInvDx * (this->mUpz - this->mUmz);
-            Real uxCenP = this->mHalfInvDx * (this->mUpp - this->mUmp);
-            Real uyCenM = this->mHalfInvDy * (this->mUmp - this->mUmm);
-            Real uyCenZ = this->mHalfInvDy * (this->mUzp - this->mUzm);
-            Real uyCenP = this->mHalfInvDy * (this->mUpp - this->mUpm);
+            Real uxCenM = this->mHalfInvDx * (u.pm - u.mm);
+            Real uxCenZ = this->mHalfInvDx * (u.pz - u.mz);
+            Real uxCenP = this->mHalfInvDx * (u.pp - u.mp);
+            Real uyCenM = this->mHalfInvDy * (u.mp - u.mm);
+            Real uyCenZ = this->mHalfInvDy * (u.zp - u.zm);
+            Real uyCenP = this->mHalfInvDy * (u.pp - u.pm);
 
             Real uxCenZSqr = uxCenZ * uxCenZ;
             Real uyCenZSqr = uyCenZ * uyCenZ;
@@ -97,7 +115,7 @@ namespace gte
             gradMagSqr = uyCenZSqr + uxEstM * uxEstM;
             Real cym = std::exp(mMHalfParameter * gradMagSqr);
 
-            this->mBuffer[this->mDst][y][x] = this->mUzz + this->mTimeStep * (
+            this->mBuffer[this->mDst][y][x] = u.zz + this->mTimeStep * (
                 cxp * uxFwd - cxm * uxBwd +
                 cyp * uyFwd - cym * uyBwd);
         }
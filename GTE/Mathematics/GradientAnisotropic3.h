@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -34,19 +34,33 @@ namespace gte
     protected:
         void ComputeParameter()
         {
-            Real gradMagSqr = (Real)0;
-            for (int z = 1; z <= this->mZBound; ++z)
+            // The slices are summed in parallel and the slice sums are added
+            // in order, so the sum does not depend on the number of threads.
+            // GetUx, GetUy and GetUz take unpadded coordinates.
+            std::vector<Real> sliceSum(static_cast<size_t>(this->mZBound), (Real)0);
+            this->Execute(0, this->mZBound, [this, &sliceSum](int zBegin, int zEnd)
             {
-                for (int y = 1; y <= this->mYBound; ++y)
+                for (int z = zBegin; z < zEnd; ++z)
                 {
-                    for (int x = 1; x <= this->mXBound; ++x)
+                    Real sum = (Real)0;
+                    for (int y = 0; y < this->mYBound; ++y)
                     {
-                        Real ux = this->GetUx(x, y, z);
-                        Real uy = this->GetUy(x, y, z);
-                        Real uz = this->GetUz(x, y, z);
-                        gradMagSqr += ux * ux + uy * uy + uz * uz;
+                        for (int x = 0; x < this->mXBound; ++x)
+                        {
+                            Real ux = this->GetUx(x, y, z);
+                            Real uy = this->GetUy(x, y, z);
+                            Real uz = this->GetUz(x, y, z);
+                            sum += ux * ux + uy * uy + uz * uz;
+                        }
                     }
+                    sliceSum[z] = sum;
                 }
+            });
+
+            Real gradMagSqr = (Real)0;
+            for (auto sum : sliceSum)
+            {
+                gradMagSqr += sum;
             }
             gradMagSqr /= (Real)this->mQuantity;
 
@@ -56,39 +70,43 @@ namespace gte
 
         virtual void OnPreUpdate() override
         {
+            // The base class recomputes the Neumann mask border, which the
+            // parameter depends on.
+            PdeFilter3<Real>::OnPreUpdate();
             ComputeParameter();
         }
 
         virtual void OnUpdateSingle(int x, int y, int z) override
         {
-            this->LookUp27(x, y, z);
+            typename PdeFilter3<Real>::Neighborhood u;
+            this->LookUp27(x, y, z, u);
 
             // one-sided U-derivative estimates
-            Real uxFwd = this->mInvDx * (this->mUpzz - this->mUzzz);
-            Real uxBwd = this->mInvDx * (this->mUzzz - this->mUmzz);
-            Real uyFwd = this->mInvDy * (this->mUzpz - this->mUzzz);
-            Real uyBwd = this->mInvDy * (this->mUzzz - this->mUzmz);
-            Real uzFwd = this->mInvDz * (this->mUzzp - this->mUzzz);
-            Real uzBwd = this->mInvDz * (this->mUzzz - this->mUzzm);
+            Real uxFwd = this->mInvDx * (u.pzz - u.zzz);
+            Real uxBwd = this->mInvDx * (u.zzz - u.mzz);
+            Real uyFwd = this->mInvDy * (u.zpz - u.zzz);
+            Real uyBwd = this->mInvDy * (u.zzz - u.zmz);
+            Real uzFwd = this->mInvDz * (u.zzp - u.zzz);
+            Real uzBwd = this->mInvDz * (u.zzz - u.zzm);
 
             // centered U-derivative estimates
-            Real duvzz = this->mHalfInvDx * (this->mUpzz - this->mUmzz);
-            Real duvpz = this->mHalfInvDx * (this->mUppz - this->mUmpz);
-            Real duvmz = this->mHalfInvDx * (this->mUpmz - this->mUmmz);
-            Real duvzp = this->mHalfInvDx * (this->mUpzp - this->mUmzp);
-            Real duvzm = this->mHalfInvDx * (this->mUpzm - this->mUmzm);
-
-            Real duzvz = this->mHalfInvDy * (this->mUzpz - this->mUzmz);
-            Real dupvz = this->mHalfInvDy * (this->mUppz - this->mUpmz);
-            Real dumvz = this->mHalfInvDy * (this->mUmpz - this->mUmmz);
-            Real duzvp = this->mHalfInvDy * (this->mUzpp - this->mUzmp);
-            Real duzvm = this->mHalfInvDy * (this->mUzpm - this->mUzmm);
-
-            Real duzzv = this->mHalfInvDz * (this->mUzzp - this->mUzzm);
-            Real dupzv = this->mHalfInvDz * (this->mUpzp - this->mUpzm);
-            Real dumzv = this->mHalfInvDz * (this->mUmzp - this->mUmzm);
-            Real duzpv = this->mHalfInvDz * (this->mUzpp - this->mUzpm);
-            Real duzmv = this->mHalfInvDz * (this->mUzmp - this->mUzmm);
+            Real duvzz = this->mHalfInvDx * (u.pzz - u.mzz);
+            Real duvpz = this->mHalfInvDx * (u.ppz - u.mpz);
+            Real duvmz = this->mHalfInvDx * (u.pmz - u.mmz);
+            Real duvzp = this->mHalfInvDx * (u.pzp - u.mzp);
+            Real duvzm = this->mHalfInvDx * (u.pzm - u.mzm);
+
+            Real duzvz = this->mHalfInvDy * (u.zpz - u.zmz);
+            Real dupvz = this->mHalfInvDy * (u.ppz - u.pmz);
+            Real dumvz = this->mHalfInvDy * (u.mpz - u.mmz);
+            Real duzvp = this->mHalfInvDy * (u.zpp - u.zmp);
+            Real duzvm = this->mHalfInvDy * (u.zpm - u.zmm);
+
+            Real duzzv = this->mHalfInvDz * (u.zzp - u.zzm);
+            Real dupzv = this->mHalfInvDz * (u.pzp - u.pzm);
+            Real dumzv = this->mHalfInvDz * (u.mzp - u.mzm);
+            Real duzpv = this->mHalfInvDz * (u.zpp - u.zpm);
+            Real duzmv = this->mHalfInvDz * (u.zmp - u.zmm);
 
             Real uxCenSqr = duvzz * duvzz;
             Real uyCenSqr = duzvz * duzvz;
@@ -132,7 +150,7 @@ namespace gte
             gradMagSqr = uxEst * uxEst + uyEst * uyEst + uzCenSqr;
             Real czm = std::exp(mMHalfParameter * gradMagSqr);
 
-            this->mBuffer[this->mDst][z][y][x] = this->mUzzz + this->mTimeStep * (
+            this->mBuffer[this->mDst][z][y][x] = u.zzz + this->mTimeStep * (
                 cxp * uxFwd - cxm * uxBwd +
                 cyp * uyFwd - cym * uyBwd +
                 czp * uzFwd - czm * uzBwd);
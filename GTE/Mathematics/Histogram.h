@@ -3,14 +3,25 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
 #include <algorithm>
+#include <cstdint>
 #include <vector>
 
+// The constructors that bin arrays of samples accept a TaskScheduler. When
+// it is not null, the samples are partitioned into chunks that are binned
+// by the tasks of the scheduler into private buckets, and the buckets are
+// added when the tasks finish. The bin indices are computed for blocks of
+// samples by loops the compiler can vectorize, and consecutive samples are
+// counted in different copies of the buckets, so runs of equal samples,
+// which are common in images, do not serialize the increments of a bucket.
+// The counts do not depend on the scheduler.
+
 namespace gte
 {
     class Histogram
@@ -22,7 +33,8 @@ namespace gte
         // of numbers {0,1,...,numBuckets-1}, but in the event of out-of-range
         // values, the histogram stores a count for those numbers smaller than
         // 0 and those numbers larger or equal to numBuckets.
-        Histogram(int numBuckets, int numSamples, int const* samples, bool noRescaling)
+        Histogram(int numBuckets, int numSamples, int const* samples, bool noRescaling,
+            TaskScheduler* scheduler = nullptr)
             :
             mBuckets(numBuckets),
             mExcessLess(0),
@@ -35,65 +47,16 @@ namespace gte
             if (noRescaling)
             {
                 // Map to the buckets, also counting out-of-range pixels.
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    int value = samples[i];
-                    if (0 <= value)
-                    {
-                        if (value < numBuckets)
-                        {
-                            ++mBuckets[value];
-                        }
-                        else
-                        {
-                            ++mExcessGreater;
-                        }
-                    }
-                    else
-                    {
-                        ++mExcessLess;
-                    }
-                }
+                InsertCheck(numSamples, samples, scheduler);
             }
             else
             {
-                // Compute the extremes.
-                int minValue = samples[0], maxValue = minValue;
-                for (int i = 1; i < numSamples; ++i)
-                {
-                    int value = samples[i];
-                    if (value < minValue)
-                    {
-                        minValue = value;
-                    }
-                    else if (value > maxValue)
-                    {
-                        maxValue = value;
-                    }
-                }
-
-                // Map to the buckets.
-                if (minValue < maxValue)
-                {
-                    // The image is not constant.
-                    double numer = static_cast<double>(numBuckets - 1);
-                    double denom = static_cast<double>(maxValue - minValue);
-                    double mult = numer / denom;
-                    for (int i = 0; i < numSamples; ++i)
-                    {
-                        int index = static_cast<int>(mult * static_cast<double>(samples[i] - minValue));
-                        ++mBuckets[index];
-                    }
-                }
-                else
-                {
-                    // The image is constant.
-                    mBuckets[0] = numSamples;
-                }
+                Rescale(numSamples, samples, scheduler);
             }
         }
 
-        Histogram(int numBuckets, int numSamples, float const* samples)
+        Histogram(int numBuckets, int numSamples, float const* samples,
+            TaskScheduler* scheduler = nullptr)
             :
             mBuckets(numBuckets),
             mExcessLess(0),
@@ -102,43 +65,11 @@ namespace gte
             LogAssert(numBuckets > 0 && numSamples > 0 && samples != nullptr, "Invalid input.");
 
             std::fill(mBuckets.begin(), mBuckets.end(), 0);
-
-            // Compute the extremes.
-            float minValue = samples[0], maxValue = minValue;
-            for (int i = 1; i < numSamples; ++i)
-            {
-                float value = samples[i];
-                if (value < minValue)
-                {
-                    minValue = value;
-                }
-                else if (value > maxValue)
-                {
-                    maxValue = value;
-                }
-            }
-
-            // Map to the buckets.
-            if (minValue < maxValue)
-            {
-                // The image is not constant.
-                double numer = static_cast<double>(numBuckets - 1);
-                double denom = static_cast<double>(maxValue - minValue);
-                double mult = numer / denom;
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    int index = static_cast<int>(mult * static_cast<double>(samples[i] - minValue));
-                    ++mBuckets[index];
-                }
-            }
-            else
-            {
-                // The image is constant.
-                mBuckets[0] = numSamples;
-            }
+            Rescale(numSamples, samples, scheduler);
         }
 
-        Histogram(int numBuckets, int numSamples, double const* samples)
+        Histogram(int numBuckets, int numSamples, double const* samples,
+            TaskScheduler* scheduler = nullptr)
             :
             mBuckets(numBuckets),
             mExcessLess(0),
@@ -147,40 +78,23 @@ namespace gte
             LogAssert(numBuckets > 0 && numSamples > 0 && samples != nullptr, "Invalid input.");
 
             std::fill(mBuckets.begin(), mBuckets.end(), 0);
+            Rescale(numSamples, samples, scheduler);
+        }
 
-            // Compute the extremes.
-            double minValue = samples[0], maxValue = minValue;
-            for (int i = 1; i < numSamples; ++i)
-            {
-                double value = samples[i];
-                if (value < minValue)
-                {
-                    minValue = value;
-                }
-                else if (value > maxValue)
-                {
-                    maxValue = value;
-                }
-            }
+        // The samples of 16-bit images and volumes are mapped directly to
+        // the buckets, typically 65536 of them. The samples larger or equal
+        // to numBuckets are counted as excess.
+        Histogram(int numBuckets, int numSamples, uint16_t const* samples,
+            TaskScheduler* scheduler = nullptr)
+            :
+            mBuckets(numBuckets),
+            mExcessLess(0),
+            mExcessGreater(0)
+        {
+            LogAssert(numBuckets > 0 && numSamples > 0 && samples != nullptr, "Invalid input.");
 
-            // Map to the buckets.
-            if (minValue < maxValue)
-            {
-                // The image is not constant.
-                double numer = static_cast<double>(numBuckets - 1);
-                double denom = maxValue - minValue;
-                double mult = numer / denom;
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    int index = static_cast<int>(mult * (samples[i] - minValue));
-                    ++mBuckets[index];
-                }
-            }
-            else
-            {
-                // The image is constant.
-                mBuckets[0] = numSamples;
-            }
+            std::fill(mBuckets.begin(), mBuckets.end(), 0);
+            InsertCheck(numSamples, samples, scheduler);
         }
 
         // Construction when you plan on updating the histogram incrementally.
@@ -226,6 +140,50 @@ namespace gte
             }
         }
 
+        // Insert arrays of samples with bounds checking, for example, the
+        // slices of a volume as they are produced. The histogram must have
+        // been created by the Histogram(int) constructor or by one of the
+        // constructors without rescaling.
+        void InsertCheck(int numSamples, int const* samples, TaskScheduler* scheduler = nullptr)
+        {
+            int const numBuckets = static_cast<int>(mBuckets.size());
+            Count(numSamples, scheduler,
+                [samples, numBuckets](int i, int n, int* index)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        index[j] = std::min(std::max(samples[i + j], -1), numBuckets);
+                    }
+                });
+        }
+
+        void InsertCheck(int numSamples, uint16_t const* samples, TaskScheduler* scheduler = nullptr)
+        {
+            int const numBuckets = static_cast<int>(mBuckets.size());
+            Count(numSamples, scheduler,
+                [samples, numBuckets](int i, int n, int* index)
+                {
+                    for (int j = 0; j < n; ++j)
+                    {
+                        index[j] = std::min(static_cast<int>(samples[i + j]), numBuckets);
+                    }
+                });
+        }
+
+        // Add the counts of a histogram with the same number of buckets,
+        // for example, one computed by another thread.
+        void Merge(Histogram const& histogram)
+        {
+            LogAssert(histogram.mBuckets.size() == mBuckets.size(), "Mismatched number of buckets.");
+
+            for (size_t i = 0; i < mBuckets.size(); ++i)
+            {
+                mBuckets[i] += histogram.mBuckets[i];
+            }
+            mExcessLess += histogram.mExcessLess;
+            mExcessGreater += histogram.mExcessGreater;
+        }
+
         // Member access.
         inline std::vector<int> const& GetBuckets() const
         {
@@ -332,6 +290,159 @@ namespace gte
         }
 
     private:
+        // The number of samples whose bin indices are computed by a call of
+        // the binning function, and the number of copies of the buckets.
+        static int constexpr blockSize = 256;
+        static int constexpr numCopies = 4;
+
+        // Map the samples to the buckets for the range [minimum,maximum] of
+        // the samples.
+        template <typename T>
+        void Rescale(int numSamples, T const* samples, TaskScheduler* scheduler)
+        {
+            // Compute the extremes.
+            T minValue = samples[0], maxValue = minValue;
+            GetExtremes(numSamples, samples, scheduler, minValue, maxValue);
+
+            // Map to the buckets.
+            if (minValue < maxValue)
+            {
+                // The image is not constant.
+                double numer = static_cast<double>(mBuckets.size() - 1);
+                double denom = static_cast<double>(maxValue - minValue);
+                double mult = numer / denom;
+                Count(numSamples, scheduler,
+                    [samples, minValue, mult](int i, int n, int* index)
+                    {
+                        for (int j = 0; j < n; ++j)
+                        {
+                            index[j] = static_cast<int>(mult * static_cast<double>(samples[i + j] - minValue));
+                        }
+                    });
+            }
+            else
+            {
+                // The image is constant.
+                mBuckets[0] += numSamples;
+            }
+        }
+
+        template <typename T>
+        static void GetExtremes(int numSamples, T const* samples, TaskScheduler* scheduler,
+            T& minValue, T& maxValue)
+        {
+            size_t const numChunks = GetNumChunks(numSamples, scheduler);
+            std::vector<T> chunkMin(numChunks, samples[0]), chunkMax(numChunks, samples[0]);
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [numSamples, samples, numChunks, &chunkMin, &chunkMax](size_t chunk)
+                {
+                    int const imin = static_cast<int>(numSamples * chunk / numChunks);
+                    int const imax = static_cast<int>(numSamples * (chunk + 1) / numChunks);
+                    T cmin = chunkMin[chunk], cmax = cmin;
+                    for (int i = imin; i < imax; ++i)
+                    {
+                        T value = samples[i];
+                        if (value < cmin)
+                        {
+                            cmin = value;
+                        }
+                        else if (value > cmax)
+                        {
+                            cmax = value;
+                        }
+                    }
+                    chunkMin[chunk] = cmin;
+                    chunkMax[chunk] = cmax;
+                });
+
+            for (size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                if (chunkMin[chunk] < minValue)
+                {
+                    minValue = chunkMin[chunk];
+                }
+                if (chunkMax[chunk] > maxValue)
+                {
+                    maxValue = chunkMax[chunk];
+                }
+            }
+        }
+
+        // The function bin(i, n, index) stores the bin indices of samples
+        // i through i+n-1 in index[0] through index[n-1]. The index -1 is
+        // counted by mExcessLess and the index numBuckets is counted by
+        // mExcessGreater.
+        template <typename Binner>
+        void Count(int numSamples, TaskScheduler* scheduler, Binner const& bin)
+        {
+            // The counts of the chunks are stored with the excess counts
+            // at the ends, so the bucket of index i is at count[i+1].
+            size_t const numChunks = GetNumChunks(numSamples, scheduler);
+            size_t const stride = mBuckets.size() + 2;
+            std::vector<std::vector<int>> chunkCount(numChunks);
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [numSamples, numChunks, stride, &chunkCount, &bin](size_t chunk)
+                {
+                    int const imin = static_cast<int>(numSamples * chunk / numChunks);
+                    int const imax = static_cast<int>(numSamples * (chunk + 1) / numChunks);
+                    std::vector<int>& count = chunkCount[chunk];
+                    count.resize(numCopies * stride);
+                    std::fill(count.begin(), count.end(), 0);
+                    int* copies[numCopies];
+                    for (int c = 0; c < numCopies; ++c)
+                    {
+                        copies[c] = count.data() + c * stride + 1;
+                    }
+
+                    int index[blockSize];
+                    for (int i = imin; i < imax; i += blockSize)
+                    {
+                        int const n = (imax - i < blockSize ? imax - i : blockSize);
+                        bin(i, n, index);
+                        int j = 0;
+                        for (; j + numCopies <= n; j += numCopies)
+                        {
+                            for (int c = 0; c < numCopies; ++c)
+                            {
+                                ++copies[c][index[j + c]];
+                            }
+                        }
+                        for (; j < n; ++j)
+                        {
+                            ++copies[0][index[j]];
+                        }
+                    }
+
+                    for (int c = 1; c < numCopies; ++c)
+                    {
+                        for (size_t k = 0; k < stride; ++k)
+                        {
+                            count[k] += count[c * stride + k];
+                        }
+                    }
+                });
+
+            for (auto const& count : chunkCount)
+            {
+                mExcessLess += count[0];
+                for (size_t k = 0; k < mBuckets.size(); ++k)
+                {
+                    mBuckets[k] += count[k + 1];
+                }
+                mExcessGreater += count[stride - 1];
+            }
+        }
+
+        static size_t GetNumChunks(int numSamples, TaskScheduler* scheduler)
+        {
+            // A chunk has at least a few blocks to amortize the cost of its
+            // buckets.
+            size_t const numBlocks = (static_cast<size_t>(numSamples) + blockSize - 1) / blockSize;
+            return (scheduler ?
+                std::max(std::min(numBlocks / 16, scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+        }
+
         std::vector<int> mBuckets;
         int mExcessLess, mExcessGreater;
     };
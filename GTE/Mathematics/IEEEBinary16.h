@@ -3,13 +3,38 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.02.12
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/BitHacks.h>
 #include <Mathematics/Math.h>
 #include <Mathematics/IEEEBinary.h>
+#include <cstddef>
+#include <cstring>
+
+// The bulk conversions IEEEBinary16::Convert between arrays of float and
+// arrays of 16-bit encodings use the F16C instructions on x86 and x64 and
+// the NEON instructions on ARM64 when GTE_USE_SIMD is defined and the
+// compiler targets them (for example, GCC and Clang with -mf16c or
+// -march=native, Microsoft Visual Studio with /arch:AVX2). Otherwise, they
+// use tables, which are faster than the single-value conversions. All the
+// implementations round to nearest with ties to even and produce the same
+// results as the single-value conversions except for NaNs, whose payloads
+// and quiet bits can differ. GTE_HAS_SIMD_BINARY16 is defined when the
+// instructions are used.
+
+#if defined(GTE_USE_SIMD)
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define GTE_HAS_SIMD_BINARY16
+#define GTE_SIMD_BINARY16_F16C
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GTE_HAS_SIMD_BINARY16
+#define GTE_SIMD_BINARY16_NEON
+#endif
+#endif
 
 namespace gte
 {
@@ -111,6 +136,59 @@ namespace gte
             return static_cast<float>(*this) >= static_cast<float>(object);
         }
 
+        // Bulk conversions of arrays, for example, to pack the data of
+        // DF_R16G16B16A16_FLOAT textures and DF_R16G16_FLOAT vertex
+        // attributes for uploading to the GPU. The input and output arrays
+        // must not overlap.
+        static void Convert(size_t numElements, float const* input, uint16_t* output)
+        {
+            size_t i = 0;
+#if defined(GTE_SIMD_BINARY16_F16C)
+            for (; i + 8 <= numElements; i += 8)
+            {
+                __m128i result = _mm256_cvtps_ph(_mm256_loadu_ps(input + i), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), result);
+            }
+#elif defined(GTE_SIMD_BINARY16_NEON)
+            for (; i + 4 <= numElements; i += 4)
+            {
+                float16x4_t result = vcvt_f16_f32(vld1q_f32(input + i));
+                vst1_u16(output + i, vreinterpret_u16_f16(result));
+            }
+#endif
+            Tables const& tables = GetTables();
+            for (; i < numElements; ++i)
+            {
+                uint32_t encoding;
+                std::memcpy(&encoding, input + i, sizeof(encoding));
+                output[i] = ConvertTable32To16(tables, encoding);
+            }
+        }
+
+        static void Convert(size_t numElements, uint16_t const* input, float* output)
+        {
+            size_t i = 0;
+#if defined(GTE_SIMD_BINARY16_F16C)
+            for (; i + 8 <= numElements; i += 8)
+            {
+                __m128i source = _mm_loadu_si128(reinterpret_cast<__m128i const*>(input + i));
+                _mm256_storeu_ps(output + i, _mm256_cvtph_ps(source));
+            }
+#elif defined(GTE_SIMD_BINARY16_NEON)
+            for (; i + 4 <= numElements; i += 4)
+            {
+                float16x4_t source = vreinterpret_f16_u16(vld1_u16(input + i));
+                vst1q_f32(output + i, vcvt_f32_f16(source));
+            }
+#endif
+            Tables const& tables = GetTables();
+            for (; i < numElements; ++i)
+            {
+                uint32_t encoding = ConvertTable16To32(tables, input[i]);
+                std::memcpy(output + i, &encoding, sizeof(encoding));
+            }
+        }
+
     private:
         // Members from the base class IEEEBinary<int16_t, uint16_t, 16, 11>.
         //
@@ -365,6 +443,115 @@ namespace gte
             uint32_t maskPayload = (static_cast<uint32_t>(trailing16) << CONVERSION_TRAILING_SHIFT);
             return sign32 | F32::EXPONENT_MASK | maskPayload;
         }
+
+        // Tables for the bulk conversions. A 16-bit encoding h is converted
+        // to the 32-bit encoding
+        //   mantissa[offset[h >> 10] + (h & 0x03FF)] + exponent[h >> 10],
+        // which is the method of J. van der Zijp, "Fast Half Float
+        // Conversions". A 32-bit encoding with biased exponent e and
+        // trailing significand t is converted to the 16-bit encoding
+        //   base[e] + round(((t | 2^{23}) >> shift[e])),
+        // where the rounding is to nearest with ties to even. The carry of
+        // the rounding into the exponent channel produces the correct
+        // encoding, including the overflow to infinity. The NaNs are
+        // converted separately.
+        struct Tables
+        {
+            Tables()
+            {
+                mantissa[0] = 0;
+                for (uint32_t i = 1; i < 1024; ++i)
+                {
+                    mantissa[i] = Convert16To32(static_cast<uint16_t>(i));
+                }
+                for (uint32_t i = 1024; i < 2048; ++i)
+                {
+                    mantissa[i] = 0x38000000u + ((i - 1024) << 13);
+                }
+
+                for (uint32_t i = 0; i < 64; ++i)
+                {
+                    uint32_t biased = (i & 31);
+                    exponent[i] = (biased == 31 ? 0x47800000u : (biased << 23));
+                    if (i >= 32)
+                    {
+                        exponent[i] |= F32::SIGN_MASK;
+                    }
+                    offset[i] = static_cast<uint16_t>(biased == 0 ? 0 : 1024);
+                }
+
+                for (uint32_t e = 0; e < 256; ++e)
+                {
+                    if (e < 102)
+                    {
+                        // x < 2^{-25}, the nearest y is zero.
+                        base[e] = 0;
+                        shift[e] = 31;
+                    }
+                    else if (e < 113)
+                    {
+                        // 2^{-25} <= x < 2^{-14}, y is 16-subnormal or
+                        // 16-min-normal after rounding.
+                        base[e] = 0;
+                        shift[e] = static_cast<uint8_t>(126 - e);
+                    }
+                    else if (e < 143)
+                    {
+                        // 2^{-14} <= x < 2^{16}, y is 16-normal or
+                        // 16-infinite after rounding. The implied 1-bit of
+                        // x adds 1 to the biased exponent of base.
+                        base[e] = static_cast<uint16_t>((e - 113) << 10);
+                        shift[e] = 13;
+                    }
+                    else
+                    {
+                        // x >= 2^{16}, y is 16-infinite.
+                        base[e] = F16::POS_INFINITY;
+                        shift[e] = 31;
+                    }
+                }
+            }
+
+            uint32_t mantissa[2048];
+            uint32_t exponent[64];
+            uint16_t offset[64];
+            uint16_t base[256];
+            uint8_t shift[256];
+        };
+
+        static Tables const& GetTables()
+        {
+            static Tables const sTables;
+            return sTables;
+        }
+
+        static inline uint16_t ConvertTable32To16(Tables const& tables, uint32_t inEncoding)
+        {
+            uint16_t sign16 = static_cast<uint16_t>((inEncoding & F32::SIGN_MASK) >> CONVERSION_SIGN_SHIFT);
+            uint32_t biased32 = ((inEncoding & F32::EXPONENT_MASK) >> F32::NUM_TRAILING_BITS);
+            uint32_t trailing32 = (inEncoding & F32::TRAILING_MASK);
+            if (biased32 == static_cast<uint32_t>(F32::MAX_BIASED_EXPONENT))
+            {
+                // x is 32-infinite or 32-NaN.
+                return sign16 | F16::EXPONENT_MASK |
+                    static_cast<uint16_t>(trailing32 >> CONVERSION_TRAILING_SHIFT);
+            }
+
+            uint32_t significand = (trailing32 | F32::SUP_TRAILING);
+            uint32_t shift = tables.shift[biased32];
+            uint32_t quotient = (significand >> shift);
+            uint32_t remainder = significand & ((1u << shift) - 1u);
+            uint32_t half = (1u << (shift - 1));
+            quotient += (remainder + half - 1u + (quotient & 1u)) >> shift;
+            return sign16 | static_cast<uint16_t>(tables.base[biased32] + quotient);
+        }
+
+        static inline uint32_t ConvertTable16To32(Tables const& tables, uint16_t inEncoding)
+        {
+            uint32_t high = (inEncoding >> F16::NUM_TRAILING_BITS);
+            return tables.mantissa[tables.offset[high] + (inEncoding & F16::TRAILING_MASK)]
+                + tables.exponent[high];
+        }
     };
 
     // Arithmetic operations (high-precision).
@@ -3,11 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Image2.h>
+#include <Mathematics/ComponentLabeler.h>
+#include <Mathematics/SeparableFilter.h>
 #include <cmath>
 #include <functional>
 #include <limits>
@@ -25,6 +27,12 @@
 // image, make a copy of it before calling these functions.  Dilation and
 // erosion functions do not have the requirement that the boundary pixels of
 // the binary image inputs be zero.
+//
+// The functions with a numThreads parameter distribute their work among
+// numThreads threads, which are tasks of the 'scheduler' parameter when it
+// is not null. When numThreads > 1, the connected components are labeled by
+// the block-parallel union-find of ComponentLabeler, which has the same
+// output as the single-threaded depth-first search.
 
 namespace gte
 {
@@ -36,11 +44,19 @@ namespace gte
         // the image values are the labels for the components.  The array
         // components[k], k >= 1, contains the indices for the k-th component.
         static void GetComponents4(Image2<int>& image,
-            std::vector<std::vector<size_t>>& components)
+            std::vector<std::vector<size_t>>& components, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
         {
             std::array<int, 4> neighbors;
             image.GetNeighborhood(neighbors);
-            GetComponents(4, &neighbors[0], image, components);
+            if (numThreads > 1)
+            {
+                ComponentLabeler::GetComponents(4, &neighbors[0], image, components, numThreads, scheduler);
+            }
+            else
+            {
+                GetComponents(4, &neighbors[0], image, components);
+            }
         }
 
         // Compute the 8-connected components of a binary image.  The input
@@ -48,11 +64,19 @@ namespace gte
         // the image values are the labels for the components.  The array
         // components[k], k >= 1, contains the indices for the k-th component.
         static void GetComponents8(Image2<int>& image,
-            std::vector<std::vector<size_t>>& components)
+            std::vector<std::vector<size_t>>& components, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
         {
             std::array<int, 8> neighbors;
             image.GetNeighborhood(neighbors);
-            GetComponents(8, &neighbors[0], image, components);
+            if (numThreads > 1)
+            {
+                ComponentLabeler::GetComponents(8, &neighbors[0], image, components, numThreads, scheduler);
+            }
+            else
+            {
+                GetComponents(8, &neighbors[0], image, components);
+            }
         }
 
         // Compute a dilation with a structuring element consisting of the
@@ -276,6 +300,120 @@ namespace gte
             Erode(temp, zeroExterior, numNeighbors, neighbors, output);
         }
 
+        // The separable filters process the rows of the image in parallel
+        // using numThreads threads. The kernels are in SeparableFilter.h.
+        // The output image must be an object different from the input
+        // image; it is resized to the dimensions of the input image.
+
+        // Convolve the image with the separable kernel whose weight at
+        // (dx,dy) is kernel0[dx+r0]*kernel1[dy+r1], where the kernels have
+        // 2*r0+1 and 2*r1+1 weights, respectively. The pixels outside the
+        // image are the nearest boundary pixels.
+        template <typename Real>
+        static void ConvolveSeparable(Image2<Real> const& input,
+            std::vector<Real> const& kernel0, std::vector<Real> const& kernel1,
+            Image2<Real>& output, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(&output != &input, "Input and output must be different.");
+            LogAssert(kernel0.size() % 2 == 1 && kernel1.size() % 2 == 1, "Invalid kernel.");
+
+            int const dim0 = input.GetDimension(0);
+            int const dim1 = input.GetDimension(1);
+            int const radius0 = static_cast<int>(kernel0.size() / 2);
+            int const radius1 = static_cast<int>(kernel1.size() / 2);
+            Image2<Real> temp(dim0, dim1);
+            output.Reconstruct(dim0, dim1);
+
+            Real const* inPixels = input.GetPixels().data();
+            Real* tmpPixels = temp.GetPixels().data();
+            Real* outPixels = output.GetPixels().data();
+            size_t const rowSize = static_cast<size_t>(dim0);
+            auto getRow = [tmpPixels, rowSize](int y) { return tmpPixels + y * rowSize; };
+
+            SeparableFilter::Execute(numThreads, scheduler, static_cast<size_t>(dim1),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t y = begin; y < end; ++y)
+                    {
+                        SeparableFilter::ConvolveLine(inPixels + y * rowSize, dim0,
+                            kernel0.data(), radius0, tmpPixels + y * rowSize);
+                    }
+                });
+
+            SeparableFilter::Execute(numThreads, scheduler, static_cast<size_t>(dim1),
+                [&](size_t begin, size_t end)
+                {
+                    std::vector<Real const*> rows;
+                    for (size_t y = begin; y < end; ++y)
+                    {
+                        SeparableFilter::GetRows<Real>(static_cast<int>(y), dim1, radius1,
+                            nullptr, getRow, rows);
+                        SeparableFilter::ConvolveRows(rows.data(), dim0, kernel1.data(),
+                            radius1, outPixels + y * rowSize);
+                    }
+                });
+        }
+
+        // Compute a dilation with the structuring element that is the
+        // rectangle [-radius0,radius0]x[-radius1,radius1]. The output pixel
+        // is the maximum of the input pixels in the rectangle centered at
+        // it, so for binary images, DilateRectangle(input, 1, 1, output) is
+        // equivalent to Dilate8(input, output). The pixel type can be any
+        // type with operator<.
+        template <typename PixelType>
+        static void DilateRectangle(Image2<PixelType> const& input, int radius0,
+            int radius1, Image2<PixelType>& output, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            FilterRectangle(input, radius0, radius1, true, static_cast<PixelType const*>(nullptr),
+                output, numThreads, scheduler);
+        }
+
+        // Compute an erosion with the structuring element that is the
+        // rectangle [-radius0,radius0]x[-radius1,radius1]. The output pixel
+        // is the minimum of the input pixels in the rectangle centered at
+        // it. If zeroExterior is true, the image exterior is assumed to be
+        // 0; otherwise, the exterior pixels are ignored. For binary images,
+        // ErodeRectangle(input, 1, 1, zeroExterior, output) is equivalent to
+        // Erode8(input, zeroExterior, output).
+        template <typename PixelType>
+        static void ErodeRectangle(Image2<PixelType> const& input, int radius0,
+            int radius1, bool zeroExterior, Image2<PixelType>& output,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            PixelType const zero = static_cast<PixelType>(0);
+            FilterRectangle(input, radius0, radius1, false, (zeroExterior ? &zero : nullptr),
+                output, numThreads, scheduler);
+        }
+
+        // Create the binary image whose pixels are 1 where the input pixels
+        // are larger than or equal to the threshold and 0 otherwise. The
+        // output is the input to GetComponents4 or GetComponents8 for the
+        // labeling of the thresholded regions; the boundary pixels must be
+        // zeroed by the caller when they are 1.
+        template <typename PixelType>
+        static void Threshold(Image2<PixelType> const& input, PixelType threshold,
+            Image2<int>& output, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            int const dim0 = input.GetDimension(0);
+            int const dim1 = input.GetDimension(1);
+            output.Reconstruct(dim0, dim1);
+
+            PixelType const* inPixels = input.GetPixels().data();
+            int* outPixels = output.GetPixels().data();
+            size_t const rowSize = static_cast<size_t>(dim0);
+            SeparableFilter::Execute(numThreads, scheduler, static_cast<size_t>(dim1),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t i = begin * rowSize, iMax = end * rowSize; i < iMax; ++i)
+                    {
+                        outPixels[i] = static_cast<int>(!(inPixels[i] < threshold));
+                    }
+                });
+        }
+
         // Locate a pixel and walk around the edge of a component.  The input
         // (x,y) is where the search starts for a nonzero pixel.  If (x,y) is
         // outside the component, the walk is around the outside the
@@ -1229,6 +1367,75 @@ namespace gte
         }
 
     private:
+        // Dilation (maximum) or erosion (minimum) with a rectangle, first
+        // along the rows and then across the rows.
+        template <typename PixelType>
+        static void FilterRectangle(Image2<PixelType> const& input, int radius0,
+            int radius1, bool dilate, PixelType const* exterior,
+            Image2<PixelType>& output, size_t numThreads,
+            TaskScheduler* scheduler)
+        {
+            LogAssert(&output != &input, "Input and output must be different.");
+            LogAssert(radius0 >= 0 && radius1 >= 0, "Invalid radius.");
+
+            int const dim0 = input.GetDimension(0);
+            int const dim1 = input.GetDimension(1);
+            Image2<PixelType> temp(dim0, dim1);
+            output.Reconstruct(dim0, dim1);
+
+            PixelType const* inPixels = input.GetPixels().data();
+            PixelType* tmpPixels = temp.GetPixels().data();
+            PixelType* outPixels = output.GetPixels().data();
+            size_t const rowSize = static_cast<size_t>(dim0);
+            auto getRow = [tmpPixels, rowSize](int y) { return tmpPixels + y * rowSize; };
+            std::vector<PixelType> exteriorRow;
+            if (exterior)
+            {
+                exteriorRow.resize(rowSize, *exterior);
+            }
+            PixelType const* exteriorRowPtr = (exterior ? exteriorRow.data() : nullptr);
+
+            SeparableFilter::Execute(numThreads, scheduler, static_cast<size_t>(dim1),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t y = begin; y < end; ++y)
+                    {
+                        if (dilate)
+                        {
+                            SeparableFilter::DilateLine(inPixels + y * rowSize, dim0,
+                                radius0, tmpPixels + y * rowSize);
+                        }
+                        else
+                        {
+                            SeparableFilter::ErodeLine(inPixels + y * rowSize, dim0,
+                                radius0, exterior, tmpPixels + y * rowSize);
+                        }
+                    }
+                });
+
+            SeparableFilter::Execute(numThreads, scheduler, static_cast<size_t>(dim1),
+                [&](size_t begin, size_t end)
+                {
+                    std::vector<PixelType const*> rows;
+                    int const numRows = 2 * radius1 + 1;
+                    for (size_t y = begin; y < end; ++y)
+                    {
+                        SeparableFilter::GetRows<PixelType>(static_cast<int>(y), dim1,
+                            radius1, exteriorRowPtr, getRow, rows);
+                        if (dilate)
+                        {
+                            SeparableFilter::DilateRows(rows.data(), numRows, dim0,
+                                outPixels + y * rowSize);
+                        }
+                        else
+                        {
+                            SeparableFilter::ErodeRows(rows.data(), numRows, dim0,
+                                outPixels + y * rowSize);
+                        }
+                    }
+                });
+        }
+
         // Connected component labeling using depth-first search.
         static void GetComponents(int numNeighbors, int const* delta,
             Image2<int>& image, std::vector<std::vector<size_t>>& components)
@@ -3,11 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Image3.h>
+#include <Mathematics/ComponentLabeler.h>
+#include <Mathematics/SeparableFilter.h>
+#include <Mathematics/SparseImage3.h>
 #include <functional>
 
 // Image utilities for Image3<int> objects.  TODO: Extend this to a template
@@ -22,6 +25,17 @@
 // time the input image is modified by the algorithms.  If you need to
 // preserve the input image, make a copy of it before calling these
 // functions.
+//
+// The dilations and the flood fill have overloads for SparseImage3 objects.
+// The dilations skip the bricks that, with their neighboring bricks, are
+// constant 0, and the flood fill uses a stack whose size is proportional to
+// the filled region rather than to the image.
+//
+// The functions with a numThreads parameter distribute their work among
+// numThreads threads, which are tasks of the 'scheduler' parameter when it
+// is not null. When numThreads > 1, the connected components are labeled by
+// the block-parallel union-find of ComponentLabeler, which has the same
+// output as the single-threaded depth-first search.
 
 namespace gte
 {
@@ -33,11 +47,19 @@ namespace gte
         // the image values are the labels for the components.  The array
         // components[k], k >= 1, contains the indices for the k-th component.
         static void GetComponents6(Image3<int>& image,
-            std::vector<std::vector<size_t>>& components)
+            std::vector<std::vector<size_t>>& components, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
         {
             std::array<int, 6> neighbors;
             image.GetNeighborhood(neighbors);
-            GetComponents(6, &neighbors[0], image, components);
+            if (numThreads > 1)
+            {
+                ComponentLabeler::GetComponents(6, &neighbors[0], image, components, numThreads, scheduler);
+            }
+            else
+            {
+                GetComponents(6, &neighbors[0], image, components);
+            }
         }
 
         // Compute the 18-connected components of a binary image.  The input
@@ -45,11 +67,19 @@ namespace gte
         // the image values are the labels for the components.  The array
         // components[k], k >= 1, contains the indices for the k-th component.
         static void GetComponents18(Image3<int>& image,
-            std::vector<std::vector<size_t>>& components)
+            std::vector<std::vector<size_t>>& components, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
         {
             std::array<int, 18> neighbors;
             image.GetNeighborhood(neighbors);
-            GetComponents(18, &neighbors[0], image, components);
+            if (numThreads > 1)
+            {
+                ComponentLabeler::GetComponents(18, &neighbors[0], image, components, numThreads, scheduler);
+            }
+            else
+            {
+                GetComponents(18, &neighbors[0], image, components);
+            }
         }
 
         // Compute the 26-connected components of a binary image.  The input
@@ -57,11 +87,19 @@ namespace gte
         // the image values are the labels for the components.  The array
         // components[k], k >= 1, contains the indices for the k-th component.
         static void GetComponents26(Image3<int>& image,
-            std::vector<std::vector<size_t>>& components)
+            std::vector<std::vector<size_t>>& components, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
         {
             std::array<int, 26> neighbors;
             image.GetNeighborhood(neighbors);
-            GetComponents(26, &neighbors[0], image, components);
+            if (numThreads > 1)
+            {
+                ComponentLabeler::GetComponents(26, &neighbors[0], image, components, numThreads, scheduler);
+            }
+            else
+            {
+                GetComponents(26, &neighbors[0], image, components);
+            }
         }
 
         // Dilate the image using a structuring element that contains the
@@ -91,6 +129,158 @@ namespace gte
             Dilate(26, &neighbors[0], inImage, outImage);
         }
 
+        // Dilations of sparse images. The output image must have the same
+        // dimensions as the input image but can have a different brick size.
+        static void Dilate6(SparseImage3<int> const& inImage, SparseImage3<int>& outImage)
+        {
+            // The 3-tuple neighborhoods do not depend on the image
+            // dimensions.
+            std::array<std::array<int, 3>, 6> neighbors;
+            Image3<int>().GetNeighborhood(neighbors);
+            Dilate(6, &neighbors[0], inImage, outImage);
+        }
+
+        static void Dilate18(SparseImage3<int> const& inImage, SparseImage3<int>& outImage)
+        {
+            std::array<std::array<int, 3>, 18> neighbors;
+            Image3<int>().GetNeighborhood(neighbors);
+            Dilate(18, &neighbors[0], inImage, outImage);
+        }
+
+        static void Dilate26(SparseImage3<int> const& inImage, SparseImage3<int>& outImage)
+        {
+            std::array<std::array<int, 3>, 26> neighbors;
+            Image3<int>().GetNeighborhood(neighbors);
+            Dilate(26, &neighbors[0], inImage, outImage);
+        }
+
+        // The separable filters process the rows of the image in parallel
+        // using numThreads threads, first along the x-direction, then the
+        // y-direction and then the z-direction. The kernels are in
+        // SeparableFilter.h. The output image must be an object different
+        // from the input image; it is resized to the dimensions of the input
+        // image.
+
+        // Convolve the image with the separable kernel whose weight at
+        // (dx,dy,dz) is kernel0[dx+r0]*kernel1[dy+r1]*kernel2[dz+r2], where
+        // the kernels have 2*r0+1, 2*r1+1 and 2*r2+1 weights, respectively.
+        // The voxels outside the image are the nearest boundary voxels.
+        template <typename Real>
+        static void ConvolveSeparable(Image3<Real> const& inImage,
+            std::vector<Real> const& kernel0, std::vector<Real> const& kernel1,
+            std::vector<Real> const& kernel2, Image3<Real>& outImage,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(kernel0.size() % 2 == 1 && kernel1.size() % 2 == 1
+                && kernel2.size() % 2 == 1, "Invalid kernel.");
+
+            int const dim0 = inImage.GetDimension(0);
+            std::array<Real const*, 3> kernels = { kernel0.data(), kernel1.data(), kernel2.data() };
+            std::array<int, 3> radius =
+            {
+                static_cast<int>(kernel0.size() / 2),
+                static_cast<int>(kernel1.size() / 2),
+                static_cast<int>(kernel2.size() / 2)
+            };
+
+            FilterSeparable(inImage, radius, static_cast<Real const*>(nullptr),
+                [&](Real const* input, Real* output)
+                {
+                    SeparableFilter::ConvolveLine(input, dim0, kernels[0], radius[0], output);
+                },
+                [&](int d, Real const* const* rows, Real* output)
+                {
+                    SeparableFilter::ConvolveRows(rows, dim0, kernels[d], radius[d], output);
+                },
+                outImage, numThreads, scheduler);
+        }
+
+        // Compute a dilation with the structuring element that is the box
+        // [-radius0,radius0]x[-radius1,radius1]x[-radius2,radius2]. The
+        // output voxel is the maximum of the input voxels in the box
+        // centered at it, so for binary images with zero boundaries, the
+        // interior voxels of DilateBox(inImage, 1, 1, 1, outImage) are those
+        // of Dilate26(inImage, outImage); unlike Dilate26, the boundary
+        // voxels are dilated as well. The voxel type can be any type with
+        // operator<.
+        template <typename PixelType>
+        static void DilateBox(Image3<PixelType> const& inImage, int radius0,
+            int radius1, int radius2, Image3<PixelType>& outImage,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(radius0 >= 0 && radius1 >= 0 && radius2 >= 0, "Invalid radius.");
+
+            int const dim0 = inImage.GetDimension(0);
+            FilterSeparable(inImage, { radius0, radius1, radius2 }, static_cast<PixelType const*>(nullptr),
+                [&](PixelType const* input, PixelType* output)
+                {
+                    SeparableFilter::DilateLine(input, dim0, radius0, output);
+                },
+                [&](int d, PixelType const* const* rows, PixelType* output)
+                {
+                    int const numRows = 2 * (d == 1 ? radius1 : radius2) + 1;
+                    SeparableFilter::DilateRows(rows, numRows, dim0, output);
+                },
+                outImage, numThreads, scheduler);
+        }
+
+        // Compute an erosion with the structuring element that is the box
+        // [-radius0,radius0]x[-radius1,radius1]x[-radius2,radius2]. The
+        // output voxel is the minimum of the input voxels in the box
+        // centered at it. If zeroExterior is true, the image exterior is
+        // assumed to be 0; otherwise, the exterior voxels are ignored.
+        template <typename PixelType>
+        static void ErodeBox(Image3<PixelType> const& inImage, int radius0,
+            int radius1, int radius2, bool zeroExterior, Image3<PixelType>& outImage,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(radius0 >= 0 && radius1 >= 0 && radius2 >= 0, "Invalid radius.");
+
+            int const dim0 = inImage.GetDimension(0);
+            PixelType const zero = static_cast<PixelType>(0);
+            PixelType const* exterior = (zeroExterior ? &zero : nullptr);
+            FilterSeparable(inImage, { radius0, radius1, radius2 }, exterior,
+                [&](PixelType const* input, PixelType* output)
+                {
+                    SeparableFilter::ErodeLine(input, dim0, radius0, exterior, output);
+                },
+                [&](int d, PixelType const* const* rows, PixelType* output)
+                {
+                    int const numRows = 2 * (d == 1 ? radius1 : radius2) + 1;
+                    SeparableFilter::ErodeRows(rows, numRows, dim0, output);
+                },
+                outImage, numThreads, scheduler);
+        }
+
+        // Create the binary image whose voxels are 1 where the input voxels
+        // are larger than or equal to the threshold and 0 otherwise. The
+        // output is the input to GetComponents6, GetComponents18 or
+        // GetComponents26 for the labeling of the thresholded regions; the
+        // boundary voxels must be zeroed by the caller when they are 1.
+        template <typename PixelType>
+        static void Threshold(Image3<PixelType> const& inImage, PixelType threshold,
+            Image3<int>& outImage, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            int const dim0 = inImage.GetDimension(0);
+            int const dim1 = inImage.GetDimension(1);
+            int const dim2 = inImage.GetDimension(2);
+            outImage.Reconstruct(dim0, dim1, dim2);
+
+            PixelType const* inVoxels = inImage.GetPixels().data();
+            int* outVoxels = outImage.GetPixels().data();
+            size_t const rowSize = static_cast<size_t>(dim0);
+            SeparableFilter::Execute(numThreads, scheduler,
+                static_cast<size_t>(dim1) * static_cast<size_t>(dim2),
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t i = begin * rowSize, iMax = end * rowSize; i < iMax; ++i)
+                    {
+                        outVoxels[i] = static_cast<int>(!(inVoxels[i] < threshold));
+                    }
+                });
+        }
+
         // Compute coordinate-directional convex set.  For a given coordinate
         // direction (x, y, or z), identify the first and last 1-valued voxels
         // on a segment of voxels in that direction.  All voxels from first to
@@ -326,6 +516,52 @@ namespace gte
             }
         }
 
+        // The flood fill of a sparse image, which visits the voxels in the
+        // same order as the flood fill of Image3.
+        template <typename PixelType>
+        static void FloodFill6(SparseImage3<PixelType>& image, int x, int y, int z,
+            PixelType foreColor, PixelType backColor)
+        {
+            int const dim0 = image.GetDimension(0);
+            int const dim1 = image.GetDimension(1);
+            int const dim2 = image.GetDimension(2);
+            if (x < 0 || x >= dim0 || y < 0 || y >= dim1 || z < 0 || z >= dim2)
+            {
+                return;
+            }
+
+            std::array<std::array<int, 3>, 6> const delta =
+            { {
+                { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+            } };
+            std::array<int, 3> const dimension = { dim0, dim1, dim2 };
+            std::vector<std::array<int, 3>> stack;
+            stack.push_back({ x, y, z });
+            while (stack.size() > 0)
+            {
+                std::array<int, 3> const voxel = stack.back();
+                image.Set(voxel[0], voxel[1], voxel[2], foreColor);
+
+                bool pushed = false;
+                for (size_t n = 0; n < delta.size() && !pushed; ++n)
+                {
+                    std::array<int, 3> neighbor = voxel;
+                    int const j = static_cast<int>(n / 2);
+                    neighbor[j] += delta[n][j];
+                    if (0 <= neighbor[j] && neighbor[j] < dimension[j] && image(neighbor) == backColor)
+                    {
+                        stack.push_back(neighbor);
+                        pushed = true;
+                    }
+                }
+
+                if (!pushed)
+                {
+                    stack.pop_back();
+                }
+            }
+        }
+
         // Visit pixels using Bresenham's line drawing algorithm.  The callback
         // represents the action you want applied to each voxel as it is visited.
         static void DrawLine(int x0, int y0, int z0, int x1, int y1, int z1,
@@ -453,6 +689,80 @@ namespace gte
         }
 
     private:
+        // The three passes of a separable filter. The x-pass is
+        // lineOp(inRow, outRow) for the rows of the input. The y-pass and
+        // z-pass are rowsOp(d, rows, outRow) for d = 1 and d = 2, where the
+        // rows are those at offsets -radius[d] through radius[d] in
+        // direction d of the previous pass; the rows outside the image are
+        // clamped or, when 'exterior' is not null, have value *exterior.
+        template <typename T, typename LineOp, typename RowsOp>
+        static void FilterSeparable(Image3<T> const& inImage, std::array<int, 3> const& radius,
+            T const* exterior, LineOp const& lineOp, RowsOp const& rowsOp,
+            Image3<T>& outImage, size_t numThreads,
+            TaskScheduler* scheduler)
+        {
+            LogAssert(&outImage != &inImage, "Input and output must be different.");
+
+            int const dim0 = inImage.GetDimension(0);
+            int const dim1 = inImage.GetDimension(1);
+            int const dim2 = inImage.GetDimension(2);
+            size_t const rowSize = static_cast<size_t>(dim0);
+            size_t const numRows = static_cast<size_t>(dim1) * static_cast<size_t>(dim2);
+            std::vector<T> exteriorRow;
+            if (exterior)
+            {
+                exteriorRow.resize(rowSize, *exterior);
+            }
+            T const* exteriorRowPtr = (exterior ? exteriorRow.data() : nullptr);
+
+            // The x-pass writes to the output, the y-pass writes to the
+            // temporary image and the z-pass writes to the output.
+            Image3<T> temp(dim0, dim1, dim2);
+            outImage.Reconstruct(dim0, dim1, dim2);
+            T const* inVoxels = inImage.GetPixels().data();
+            T* outVoxels = outImage.GetPixels().data();
+            T* tmpVoxels = temp.GetPixels().data();
+
+            SeparableFilter::Execute(numThreads, scheduler, numRows,
+                [&](size_t begin, size_t end)
+                {
+                    for (size_t r = begin; r < end; ++r)
+                    {
+                        lineOp(inVoxels + r * rowSize, outVoxels + r * rowSize);
+                    }
+                });
+
+            SeparableFilter::Execute(numThreads, scheduler, numRows,
+                [&](size_t begin, size_t end)
+                {
+                    std::vector<T const*> rows;
+                    for (size_t r = begin; r < end; ++r)
+                    {
+                        int const y = static_cast<int>(r % dim1);
+                        T const* slice = outVoxels + (r - y) * rowSize;
+                        SeparableFilter::GetRows<T>(y, dim1, radius[1], exteriorRowPtr,
+                            [slice, rowSize](int i) { return slice + i * rowSize; }, rows);
+                        rowsOp(1, rows.data(), tmpVoxels + r * rowSize);
+                    }
+                });
+
+            SeparableFilter::Execute(numThreads, scheduler, numRows,
+                [&](size_t begin, size_t end)
+                {
+                    std::vector<T const*> rows;
+                    size_t const sliceSize = rowSize * dim1;
+                    for (size_t r = begin; r < end; ++r)
+                    {
+                        int const y = static_cast<int>(r % dim1);
+                        int const z = static_cast<int>(r / dim1);
+                        T const* column = tmpVoxels + y * rowSize;
+                        SeparableFilter::GetRows<T>(z, dim2, radius[2], exteriorRowPtr,
+                            [column, sliceSize](int i) { return column + i * sliceSize; }, rows);
+                        rowsOp(2, rows.data(), outVoxels + r * rowSize);
+                    }
+                });
+        }
+
         // Dilation using the specified structuring element.
         static void Dilate(int numNeighbors, std::array<int, 3> const* delta,
             Image3<int> const& inImage, Image3<int> & outImage)
@@ -489,6 +799,90 @@ namespace gte
             }
         }
 
+        static void Dilate(int numNeighbors, std::array<int, 3> const* delta,
+            SparseImage3<int> const& inImage, SparseImage3<int>& outImage)
+        {
+            int const bound0M1 = inImage.GetDimension(0) - 1;
+            int const bound1M1 = inImage.GetDimension(1) - 1;
+            int const bound2M1 = inImage.GetDimension(2) - 1;
+            int const bits = inImage.GetBrickBits();
+            int const size = inImage.GetBrickSize();
+            std::array<int, 3> const numBricks =
+            {
+                inImage.GetNumBricks(0), inImage.GetNumBricks(1), inImage.GetNumBricks(2)
+            };
+
+            for (int bz = 0; bz < numBricks[2]; ++bz)
+            {
+                for (int by = 0; by < numBricks[1]; ++by)
+                {
+                    for (int bx = 0; bx < numBricks[0]; ++bx)
+                    {
+                        // The voxels of the brick and their neighbors are in
+                        // the brick and its 26 neighboring bricks. When all
+                        // of these are constant 0, the dilation of the
+                        // brick is 0.
+                        bool isZero = true;
+                        for (int dz = -1; dz <= 1 && isZero; ++dz)
+                        {
+                            int const nz = bz + dz;
+                            for (int dy = -1; dy <= 1 && isZero; ++dy)
+                            {
+                                int const ny = by + dy;
+                                for (int dx = -1; dx <= 1; ++dx)
+                                {
+                                    int const nx = bx + dx;
+                                    if (0 <= nx && nx < numBricks[0] && 0 <= ny && ny < numBricks[1]
+                                        && 0 <= nz && nz < numBricks[2]
+                                        && (!inImage.IsConstantBrick(nx, ny, nz)
+                                        || inImage.GetBrickValue(nx, ny, nz) != 0))
+                                    {
+                                        isZero = false;
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+                        if (isZero)
+                        {
+                            continue;
+                        }
+
+                        int const i0min = std::max(1, bx << bits), i0max = std::min(bound0M1, (bx << bits) + size);
+                        int const i1min = std::max(1, by << bits), i1max = std::min(bound1M1, (by << bits) + size);
+                        int const i2min = std::max(1, bz << bits), i2max = std::min(bound2M1, (bz << bits) + size);
+                        for (int i2 = i2min; i2 < i2max; ++i2)
+                        {
+                            for (int i1 = i1min; i1 < i1max; ++i1)
+                            {
+                                for (int i0 = i0min; i0 < i0max; ++i0)
+                                {
+                                    if (inImage(i0, i1, i2) == 0)
+                                    {
+                                        for (int n = 0; n < numNeighbors; ++n)
+                                        {
+                                            int d0 = delta[n][0];
+                                            int d1 = delta[n][1];
+                                            int d2 = delta[n][2];
+                                            if (inImage(i0 + d0, i1 + d1, i2 + d2) == 1)
+                                            {
+                                                outImage.Set(i0, i1, i2, 1);
+                                                break;
+                                            }
+                                        }
+                                    }
+                                    else
+                                    {
+                                        outImage.Set(i0, i1, i2, 1);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         // Connected component labeling using depth-first search.
         static void GetComponents(int numNeighbors, int const* delta,
             Image3<int> & image, std::vector<std::vector<size_t>> & components)
@@ -0,0 +1,839 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+// Maintain the convex hull of a set of 3D points to which points are added
+// over time, for example the accumulated samples of a scanner. ConvexHull3
+// computes the hull from scratch; this class updates the hull by inserting
+// batches of points.
+//
+// While the points do not span 3D, the hull is computed by ConvexHull3 from
+// the vertices of the current hull and the new points. Once the points span
+// 3D, the hull is stored as an array of triangle facets with adjacency
+// information, starting with a large tetrahedron, and the points are
+// inserted using the conflict graph of the Quickhull algorithm,
+//   C. Bradford Barber, David P. Dobkin and Hannu Huhdanpaa,
+//   "The Quickhull Algorithm for Convex Hulls", ACM Transactions on
+//   Mathematical Software 22(4):469-483, December 1996.
+// Each point of the batch is assigned to one facet that is visible from the
+// point, its conflict facet; points inside the hull are discarded. The
+// facet is found by walking from the last facet found toward the ray from a
+// fixed point strictly inside the hull to the point, which is cheap because
+// the points of a batch are usually near each other. Then, while a facet
+// has conflict points, the point farthest from the facet is inserted: the
+// visible facets are removed, the new facets connecting the point to the
+// horizon edges are added and the conflict points of the removed facets
+// are reassigned to new facets. A conflict point that sees no new facet is
+// inside the hull and is discarded. The farthest-point order means that
+// points of a batch that end up inside the hull are usually discarded
+// without being inserted.
+//
+// The predicates are those of ConvexHull3, interval arithmetic with a
+// fallback to rational arithmetic, so the hull is exact. A point is a
+// conflict point only when it is strictly outside the hull, so a new point
+// on the hull boundary does not become a hull vertex. A hull vertex remains
+// a vertex while it is on the boundary, even when later points make it a
+// point of an edge or face of the hull. As for ConvexHull3, the vertices
+// and triangles can therefore differ from those of another computation,
+// but the hull is the same polyhedron.
+//
+// The output format is that of ConvexHull3. The indices refer to the
+// accumulated points, which are numbered in the order of insertion; see
+// GetPoints().
+
+#include <Mathematics/ConvexHull3.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/SWInterval.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace gte
+{
+    template <typename Real>
+    class IncrementalConvexHull3
+    {
+    public:
+        // Supporting constants and types for rational arithmetic used in
+        // the exact predicate for sign computations.
+        static int constexpr NumWords = BSPrecisionPredicates::ToPlane<Real>(true);
+        using Rational = BSNumber<UIntegerFP32<NumWords>>;
+
+        IncrementalConvexHull3()
+            :
+            mPoints{},
+            mRPoints{},
+            mDimension(0),
+            mVertices{},
+            mHull{},
+            mFacets{},
+            mFreeFacets{},
+            mNumFacets(0),
+            mCenter(Vector3<Real>::Zero()),
+            mRCenter{},
+            mHasCenter(false),
+            mLastFacet(invalid),
+            mPending{},
+            mVisible{},
+            mHorizon{},
+            mNewFacets{},
+            mReassign{},
+            mHorizonStart{},
+            mVertexMark{}
+        {
+        }
+
+        // Remove all the points.
+        void Clear()
+        {
+            mPoints.clear();
+            mRPoints.clear();
+            mDimension = 0;
+            mVertices.clear();
+            mHull.clear();
+            mFacets.clear();
+            mFreeFacets.clear();
+            mNumFacets = 0;
+            mHasCenter = false;
+            mLastFacet = invalid;
+            mVertexMark.clear();
+        }
+
+        // Insert a batch of points. The points are appended to the
+        // accumulated points, so the index of points[i] is
+        // GetNumPoints() + i, where GetNumPoints() is evaluated before the
+        // call. The hull is updated before the function returns.
+        void Insert(size_t numPoints, Vector3<Real> const* points)
+        {
+            if (numPoints == 0)
+            {
+                return;
+            }
+            LogAssert(points != nullptr, "Invalid argument.");
+            LogAssert(mPoints.size() + numPoints <=
+                static_cast<size_t>(std::numeric_limits<int32_t>::max()),
+                "Too many points.");
+
+            size_t const first = mPoints.size();
+            mPoints.insert(mPoints.end(), points, points + numPoints);
+
+            if (mDimension < 3)
+            {
+                // The new points might increase the dimension.
+                ComputeInitialHull(first);
+            }
+            else
+            {
+                for (size_t i = first; i < mPoints.size(); ++i)
+                {
+                    size_t facet = GetConflictFacet(static_cast<int32_t>(i));
+                    if (facet != invalid)
+                    {
+                        AddConflict(facet, static_cast<int32_t>(i));
+                    }
+                }
+                ProcessConflicts();
+                UpdateOutput();
+            }
+        }
+
+        void Insert(std::vector<Vector3<Real>> const& points)
+        {
+            Insert(points.size(), points.data());
+        }
+
+        // The accumulated points.
+        inline size_t GetNumPoints() const
+        {
+            return mPoints.size();
+        }
+
+        inline std::vector<Vector3<Real>> const& GetPoints() const
+        {
+            return mPoints;
+        }
+
+        // The dimension is 0 (hull is a single point), 1 (hull is a line
+        // segment), 2 (hull is a convex polygon in 3D) or 3 (hull is a convex
+        // polyhedron). The dimension is 0 when there are no points.
+        inline size_t GetDimension() const
+        {
+            return mDimension;
+        }
+
+        // Get the indices into GetPoints() that correspond to hull vertices.
+        // For dimension 3, the indices are sorted.
+        inline std::vector<size_t> const& GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // Get the indices into GetPoints() of the hull, organized according
+        // to the hull dimension as described for ConvexHull3::GetHull().
+        // For dimension 3, the triangle faces are counterclockwise when
+        // viewed by an observer outside the polyhedron.
+        inline std::vector<size_t> const& GetHull() const
+        {
+            return mHull;
+        }
+
+        // The number of triangle faces when the dimension is 3.
+        inline size_t GetNumFacets() const
+        {
+            return mNumFacets;
+        }
+
+    private:
+        static size_t constexpr invalid = std::numeric_limits<size_t>::max();
+
+        // The vertex index of the fixed point strictly inside the hull that
+        // is used by the walk in GetConflictFacet.
+        static int32_t constexpr centerIndex = -1;
+
+        // A triangle facet with vertices V[] counterclockwise when viewed
+        // from outside the hull. The adjacent facet A[i] shares the edge
+        // <V[i],V[(i+1)%3]>. The conflict points are strictly outside the
+        // plane of the facet. The normal is an approximation used only to
+        // select the farthest conflict point.
+        struct Facet
+        {
+            Facet()
+                :
+                V{ 0, 0, 0 },
+                A{ invalid, invalid, invalid },
+                normal(Vector3<Real>::Zero()),
+                conflicts{},
+                alive(false),
+                visible(false)
+            {
+            }
+
+            std::array<int32_t, 3> V;
+            std::array<size_t, 3> A;
+            Vector3<Real> normal;
+            std::vector<int32_t> conflicts;
+            bool alive, visible;
+        };
+
+        // A horizon edge <V[0],V[1]> of the visible region, listed in the
+        // order of the visible facet that contains it, and the invisible
+        // facet adjacent to it.
+        struct HorizonEdge
+        {
+            std::array<int32_t, 2> V;
+            size_t adjacent;
+        };
+
+        // The hull of the accumulated points is the hull of the vertices of
+        // the current hull and the new points, so only those are processed.
+        // When the points span 3D, the hull is initialized with a large
+        // tetrahedron and the other points are inserted as conflict points.
+        // Otherwise, ConvexHull3 computes the lower-dimensional hull.
+        void ComputeInitialHull(size_t first)
+        {
+            std::vector<int32_t> candidates;
+            candidates.reserve(mVertices.size() + mPoints.size() - first);
+            for (auto v : mVertices)
+            {
+                candidates.push_back(static_cast<int32_t>(v));
+            }
+            for (size_t i = first; i < mPoints.size(); ++i)
+            {
+                candidates.push_back(static_cast<int32_t>(i));
+            }
+
+            std::array<int32_t, 4> tetra{};
+            if (SelectTetrahedron(candidates, tetra))
+            {
+                CreateTetrahedron(tetra);
+                ComputeCenter(tetra);
+                for (auto c : candidates)
+                {
+                    if (c != tetra[0] && c != tetra[1] && c != tetra[2] && c != tetra[3])
+                    {
+                        size_t facet = GetConflictFacet(c);
+                        if (facet != invalid)
+                        {
+                            AddConflict(facet, c);
+                        }
+                    }
+                }
+                ProcessConflicts();
+                mDimension = 3;
+                UpdateOutput();
+                return;
+            }
+
+            std::vector<Vector3<Real>> points(candidates.size());
+            for (size_t i = 0; i < candidates.size(); ++i)
+            {
+                points[i] = mPoints[candidates[i]];
+            }
+            ConvexHull3<Real> ch3;
+            ch3(points, 0);
+            mDimension = ch3.GetDimension();
+            mVertices = ch3.GetVertices();
+            mHull = ch3.GetHull();
+            for (auto& v : mVertices)
+            {
+                v = static_cast<size_t>(candidates[v]);
+            }
+            for (auto& v : mHull)
+            {
+                v = static_cast<size_t>(candidates[v]);
+            }
+            if (mDimension < 3)
+            {
+                return;
+            }
+
+            // The tetrahedron selection failed only because of rounding
+            // errors. Copy the hull mesh to the facet array. All the points
+            // are inside or on the hull, so there are no conflicts.
+            auto const& tMap = ch3.GetHullMesh().GetTriangles();
+            std::unordered_map<VETManifoldMesh::Triangle const*, size_t> facetIndex;
+            mFacets.clear();
+            mFreeFacets.clear();
+            mFacets.resize(tMap.size());
+            size_t index = 0;
+            for (auto const& element : tMap)
+            {
+                auto const& tri = element.second;
+                Facet& facet = mFacets[index];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    facet.V[j] = candidates[tri->V[j]];
+                }
+                facet.alive = true;
+                ComputeNormal(facet);
+                facetIndex.insert(std::make_pair(tri.get(), index));
+                ++index;
+            }
+            for (auto const& element : tMap)
+            {
+                auto const& tri = element.second;
+                Facet& facet = mFacets[facetIndex[tri.get()]];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    auto iter = facetIndex.find(tri->T[j]);
+                    LogAssert(iter != facetIndex.end(), "Unexpected condition.");
+                    facet.A[j] = iter->second;
+                }
+            }
+            mNumFacets = mFacets.size();
+            mLastFacet = 0;
+            std::sort(mVertices.begin(), mVertices.end());
+
+            std::vector<int32_t> vertices(mVertices.begin(), mVertices.end());
+            mHasCenter = (SelectTetrahedron(vertices, tetra) && ComputeCenter(tetra));
+        }
+
+        // Select a large tetrahedron whose vertices are in the input. The
+        // vertices are the minimum point, the point farthest from it, the
+        // point farthest from the line of these and the point farthest
+        // from the plane of the three, computed with floating-point
+        // arithmetic. The return value is 'true' when the tetrahedron is
+        // not degenerate, which is tested exactly.
+        bool SelectTetrahedron(std::vector<int32_t> const& input, std::array<int32_t, 4>& tetra)
+        {
+            if (input.size() < 4)
+            {
+                return false;
+            }
+
+            int32_t v0 = input[0];
+            for (auto v : input)
+            {
+                if (mPoints[v] < mPoints[v0])
+                {
+                    v0 = v;
+                }
+            }
+            Vector3<Real> const P0 = mPoints[v0];
+
+            int32_t v1 = v0;
+            Real maxValue = static_cast<Real>(0);
+            for (auto v : input)
+            {
+                Vector3<Real> diff = mPoints[v] - P0;
+                Real value = Dot(diff, diff);
+                if (value > maxValue)
+                {
+                    maxValue = value;
+                    v1 = v;
+                }
+            }
+            Vector3<Real> const D1 = mPoints[v1] - P0;
+
+            int32_t v2 = v0;
+            maxValue = static_cast<Real>(0);
+            for (auto v : input)
+            {
+                Vector3<Real> cross = Cross(D1, mPoints[v] - P0);
+                Real value = Dot(cross, cross);
+                if (value > maxValue)
+                {
+                    maxValue = value;
+                    v2 = v;
+                }
+            }
+            Vector3<Real> const N = Cross(D1, mPoints[v2] - P0);
+
+            int32_t v3 = v0;
+            maxValue = static_cast<Real>(0);
+            for (auto v : input)
+            {
+                Real value = std::fabs(Dot(N, mPoints[v] - P0));
+                if (value > maxValue)
+                {
+                    maxValue = value;
+                    v3 = v;
+                }
+            }
+
+            tetra = { v0, v1, v2, v3 };
+            return ToPlane(v0, v1, v2, v3) != 0;
+        }
+
+        // Create the facets of a nondegenerate tetrahedron.
+        void CreateTetrahedron(std::array<int32_t, 4> const& tetra)
+        {
+            mFacets.clear();
+            mFreeFacets.clear();
+            mNumFacets = 0;
+
+            // Order the vertices so that tetra[3] is on the negative side
+            // of the plane of the facet <v0,v1,v2>.
+            int32_t v0 = tetra[0], v1 = tetra[1], v2 = tetra[2], v3 = tetra[3];
+            if (ToPlane(v0, v1, v2, v3) > 0)
+            {
+                std::swap(v1, v2);
+            }
+            CreateFacet(v0, v1, v2);
+            CreateFacet(v0, v3, v1);
+            CreateFacet(v1, v3, v2);
+            CreateFacet(v2, v3, v0);
+
+            for (size_t f = 0; f < 4; ++f)
+            {
+                Facet& facet = mFacets[f];
+                for (size_t j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                {
+                    for (size_t g = 0; g < 4; ++g)
+                    {
+                        Facet const& other = mFacets[g];
+                        for (size_t k0 = 0, k1 = 1; k0 < 3; ++k0, k1 = (k1 + 1) % 3)
+                        {
+                            if (other.V[k0] == facet.V[j1] && other.V[k1] == facet.V[j0])
+                            {
+                                facet.A[j0] = g;
+                            }
+                        }
+                    }
+                }
+            }
+            mLastFacet = 0;
+        }
+
+        // The fixed interior point is the centroid of a nondegenerate
+        // tetrahedron whose vertices are hull vertices. The return value
+        // and mHasCenter are 'false' if the rounding errors of the centroid
+        // computation place it on or outside the tetrahedron, which can
+        // occur only for extremely flat tetrahedra. In this case, the
+        // conflict facets are found by testing all the facets.
+        bool ComputeCenter(std::array<int32_t, 4> const& tetra)
+        {
+            Real const quarter = static_cast<Real>(0.25);
+            mCenter = quarter * (mPoints[tetra[0]] + mPoints[tetra[1]] +
+                mPoints[tetra[2]] + mPoints[tetra[3]]);
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                mRCenter[i] = mCenter[i];
+            }
+
+            // The center is strictly inside the tetrahedron when, for each
+            // face, it is strictly on the side of the opposite vertex.
+            mHasCenter = true;
+            for (size_t k = 0; k < 4 && mHasCenter; ++k)
+            {
+                int32_t u0 = tetra[(k + 1) % 4];
+                int32_t u1 = tetra[(k + 2) % 4];
+                int32_t u2 = tetra[(k + 3) % 4];
+                int32_t signVertex = ToPlane(u0, u1, u2, tetra[k]);
+                int32_t signCenter = ToPlane(u0, u1, u2, centerIndex);
+                mHasCenter = (signVertex != 0 && signCenter == signVertex);
+            }
+            return mHasCenter;
+        }
+
+        // Return a facet visible from point i, or 'invalid' when the point
+        // is inside or on the hull. The center is strictly inside the hull,
+        // so the ray from the center through point i leaves the hull
+        // through a facet whose cone, the union of the rays from the center
+        // through the facet, contains point i. Point i is outside the hull
+        // if and only if it is strictly outside that facet. The cone is
+        // found by a walk across the edges of the facets; the walk is
+        // bounded and falls back to testing all the facets.
+        size_t GetConflictFacet(int32_t i)
+        {
+            if (mHasCenter)
+            {
+                size_t f = mLastFacet, previous = invalid;
+                for (size_t step = 0; step < mNumFacets; ++step)
+                {
+                    Facet const& facet = mFacets[f];
+                    size_t next = invalid;
+                    for (size_t j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                    {
+                        // The point is on the inner side of the edge through
+                        // which the walk entered the facet.
+                        if (facet.A[j0] != previous &&
+                            ToPlane(centerIndex, facet.V[j0], facet.V[j1], i) < 0)
+                        {
+                            next = facet.A[j0];
+                            break;
+                        }
+                    }
+
+                    if (next == invalid)
+                    {
+                        mLastFacet = f;
+                        return (ToPlane(facet.V[0], facet.V[1], facet.V[2], i) > 0 ? f : invalid);
+                    }
+                    previous = f;
+                    f = next;
+                }
+            }
+
+            for (size_t f = 0; f < mFacets.size(); ++f)
+            {
+                Facet const& facet = mFacets[f];
+                if (facet.alive && ToPlane(facet.V[0], facet.V[1], facet.V[2], i) > 0)
+                {
+                    return f;
+                }
+            }
+            return invalid;
+        }
+
+        void AddConflict(size_t f, int32_t i)
+        {
+            Facet& facet = mFacets[f];
+            if (facet.conflicts.size() == 0)
+            {
+                mPending.push_back(f);
+            }
+            facet.conflicts.push_back(i);
+        }
+
+        void ProcessConflicts()
+        {
+            while (mPending.size() > 0)
+            {
+                size_t f = mPending.back();
+                mPending.pop_back();
+                Facet& facet = mFacets[f];
+                if (!facet.alive || facet.conflicts.size() == 0)
+                {
+                    continue;
+                }
+
+                // Insert the conflict point farthest from the facet plane.
+                Vector3<Real> const& origin = mPoints[facet.V[0]];
+                int32_t farthest = facet.conflicts[0];
+                Real maxDistance = Dot(facet.normal, mPoints[farthest] - origin);
+                for (size_t k = 1; k < facet.conflicts.size(); ++k)
+                {
+                    int32_t c = facet.conflicts[k];
+                    Real distance = Dot(facet.normal, mPoints[c] - origin);
+                    if (distance > maxDistance)
+                    {
+                        maxDistance = distance;
+                        farthest = c;
+                    }
+                }
+                InsertPoint(f, farthest);
+            }
+        }
+
+        // Insert point i, which is strictly outside facet f.
+        void InsertPoint(size_t f, int32_t i)
+        {
+            // Find the connected region of facets visible from the point
+            // and the horizon edges that bound it. The conflict points of
+            // the visible facets, other than point i, must be reassigned.
+            mVisible.clear();
+            mHorizon.clear();
+            mReassign.clear();
+            mFacets[f].visible = true;
+            mVisible.push_back(f);
+            for (size_t k = 0; k < mVisible.size(); ++k)
+            {
+                Facet& facet = mFacets[mVisible[k]];
+                for (size_t j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                {
+                    size_t a = facet.A[j0];
+                    Facet& adjacent = mFacets[a];
+                    if (adjacent.visible)
+                    {
+                        continue;
+                    }
+
+                    if (ToPlane(adjacent.V[0], adjacent.V[1], adjacent.V[2], i) > 0)
+                    {
+                        adjacent.visible = true;
+                        mVisible.push_back(a);
+                    }
+                    else
+                    {
+                        mHorizon.push_back({ { facet.V[j0], facet.V[j1] }, a });
+                    }
+                }
+            }
+
+            // Remove the visible facets.
+            for (auto v : mVisible)
+            {
+                Facet& facet = mFacets[v];
+                for (auto c : facet.conflicts)
+                {
+                    if (c != i)
+                    {
+                        mReassign.push_back(c);
+                    }
+                }
+                facet.conflicts.clear();
+                facet.alive = false;
+                facet.visible = false;
+                mFreeFacets.push_back(v);
+            }
+            mNumFacets -= mVisible.size();
+
+            // The horizon edges <u0,u1> form a cycle. Insert the new
+            // facets <u0,u1,i>. The facet of <u0,u1> is adjacent to that of
+            // the horizon edge starting at u1 and to that of the horizon
+            // edge ending at u0.
+            mNewFacets.clear();
+            mHorizonStart.clear();
+            for (auto const& edge : mHorizon)
+            {
+                size_t n = CreateFacet(edge.V[0], edge.V[1], i);
+                Facet& facet = mFacets[n];
+                facet.A[0] = edge.adjacent;
+                Facet& adjacent = mFacets[edge.adjacent];
+                for (size_t j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                {
+                    if (adjacent.V[j0] == edge.V[1] && adjacent.V[j1] == edge.V[0])
+                    {
+                        adjacent.A[j0] = n;
+                        break;
+                    }
+                }
+                mNewFacets.push_back(n);
+                mHorizonStart.insert(std::make_pair(edge.V[0], n));
+            }
+            for (auto n : mNewFacets)
+            {
+                Facet& facet = mFacets[n];
+                auto iter = mHorizonStart.find(facet.V[1]);
+                LogAssert(iter != mHorizonStart.end(), "Unexpected condition.");
+                facet.A[1] = iter->second;
+                mFacets[iter->second].A[2] = n;
+            }
+            mLastFacet = mNewFacets[0];
+
+            // Reassign the conflict points. A point outside the new hull
+            // that was outside a removed facet is outside a new facet.
+            for (auto c : mReassign)
+            {
+                for (auto n : mNewFacets)
+                {
+                    Facet const& facet = mFacets[n];
+                    if (ToPlane(facet.V[0], facet.V[1], facet.V[2], c) > 0)
+                    {
+                        AddConflict(n, c);
+                        break;
+                    }
+                }
+            }
+        }
+
+        size_t CreateFacet(int32_t v0, int32_t v1, int32_t v2)
+        {
+            size_t f;
+            if (mFreeFacets.size() > 0)
+            {
+                f = mFreeFacets.back();
+                mFreeFacets.pop_back();
+            }
+            else
+            {
+                f = mFacets.size();
+                mFacets.emplace_back();
+            }
+
+            Facet& facet = mFacets[f];
+            facet.V = { v0, v1, v2 };
+            facet.A = { invalid, invalid, invalid };
+            facet.alive = true;
+            facet.visible = false;
+            ComputeNormal(facet);
+            ++mNumFacets;
+            return f;
+        }
+
+        void ComputeNormal(Facet& facet)
+        {
+            Vector3<Real> const& P0 = mPoints[facet.V[0]];
+            facet.normal = Cross(mPoints[facet.V[1]] - P0, mPoints[facet.V[2]] - P0);
+        }
+
+        void UpdateOutput()
+        {
+            mHull.resize(3 * mNumFacets);
+            mVertices.clear();
+            mVertexMark.resize(mPoints.size(), 0u);
+            size_t index = 0;
+            for (auto const& facet : mFacets)
+            {
+                if (facet.alive)
+                {
+                    for (size_t j = 0; j < 3; ++j)
+                    {
+                        size_t v = static_cast<size_t>(facet.V[j]);
+                        mHull[index++] = v;
+                        if (mVertexMark[v] == 0)
+                        {
+                            mVertexMark[v] = 1;
+                            mVertices.push_back(v);
+                        }
+                    }
+                }
+            }
+            std::sort(mVertices.begin(), mVertices.end());
+
+            // Only the marks of the hull vertices are reset, so the cost
+            // does not depend on the number of accumulated points.
+            for (auto v : mVertices)
+            {
+                mVertexMark[v] = 0;
+            }
+        }
+
+        inline Vector3<Real> const& GetPoint(int32_t index) const
+        {
+            return (index >= 0 ? mPoints[index] : mCenter);
+        }
+
+        // Memoized access to the rational representation of the points.
+        // The rational points are stored in a hash map rather than in an
+        // array parallel to mPoints, because they are large and needed for
+        // few of the accumulated points.
+        Vector3<Rational> const& GetRationalPoint(int32_t index)
+        {
+            if (index < 0)
+            {
+                return mRCenter;
+            }
+
+            auto iter = mRPoints.find(index);
+            if (iter == mRPoints.end())
+            {
+                Vector3<Rational> rPoint;
+                for (int i = 0; i < 3; ++i)
+                {
+                    rPoint[i] = mPoints[index][i];
+                }
+                iter = mRPoints.insert(std::make_pair(index, rPoint)).first;
+            }
+            return iter->second;
+        }
+
+        // For a plane with origin V0 and normal N = Cross(V1-V0,V2-V0),
+        // ToPlane returns
+        //   +1, V3 on positive side of plane (side to which N points)
+        //   -1, V3 on negative side of plane (side to which -N points)
+        //    0, V3 on the plane
+        // The implementation is that of ConvexHull3::ToPlane.
+        int32_t ToPlane(int32_t v0, int32_t v1, int32_t v2, int32_t v3)
+        {
+            using SInterval = SWInterval<Real>;
+            using SVector3 = Vector3<SInterval>;
+
+            // Attempt to classify the sign using interval arithmetic.
+            Vector3<Real> const& p0 = GetPoint(v0);
+            Vector3<Real> const& p1 = GetPoint(v1);
+            Vector3<Real> const& p2 = GetPoint(v2);
+            Vector3<Real> const& p3 = GetPoint(v3);
+            SVector3 const s0{ p0[0], p0[1], p0[2] };
+            SVector3 const s1{ p1[0], p1[1], p1[2] };
+            SVector3 const s2{ p2[0], p2[1], p2[2] };
+            SVector3 const s3{ p3[0], p3[1], p3[2] };
+            auto const sDiff1 = s1 - s0;
+            auto const sDiff2 = s2 - s0;
+            auto const sDiff3 = s3 - s0;
+            auto const sDet = DotCross(sDiff1, sDiff2, sDiff3);
+            if (sDet[0] > 0)
+            {
+                return +1;
+            }
+            if (sDet[1] < 0)
+            {
+                return -1;
+            }
+
+            // The sign is indeterminate using interval arithmetic.
+            auto const& r0 = GetRationalPoint(v0);
+            auto const& r1 = GetRationalPoint(v1);
+            auto const& r2 = GetRationalPoint(v2);
+            auto const& r3 = GetRationalPoint(v3);
+            auto const rDiff1 = r1 - r0;
+            auto const rDiff2 = r2 - r0;
+            auto const rDiff3 = r3 - r0;
+            auto const rDet = DotCross(rDiff1, rDiff2, rDiff3);
+            return rDet.GetSign();
+        }
+
+        // The accumulated points and the memoized rational points.
+        std::vector<Vector3<Real>> mPoints;
+        std::unordered_map<int32_t, Vector3<Rational>> mRPoints;
+
+        // The output data.
+        size_t mDimension;
+        std::vector<size_t> mVertices;
+        std::vector<size_t> mHull;
+
+        // The facets of the hull when the dimension is 3. The slots of
+        // removed facets are reused.
+        std::vector<Facet> mFacets;
+        std::vector<size_t> mFreeFacets;
+        size_t mNumFacets;
+
+        // The fixed point strictly inside the hull, valid when mHasCenter
+        // is 'true', and the starting facet of the next walk.
+        Vector3<Real> mCenter;
+        Vector3<Rational> mRCenter;
+        bool mHasCenter;
+        size_t mLastFacet;
+
+        // Storage for the insertions, kept to avoid reallocations. The
+        // mPending facets might have conflict points.
+        std::vector<size_t> mPending;
+        std::vector<size_t> mVisible;
+        std::vector<HorizonEdge> mHorizon;
+        std::vector<size_t> mNewFacets;
+        std::vector<int32_t> mReassign;
+        std::unordered_map<int32_t, size_t> mHorizonStart;
+        std::vector<uint32_t> mVertexMark;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 5.8.2021.05.23
+// Version: 5.8.2026.10.14
 
 #pragma once
 
@@ -53,13 +53,18 @@
 // https://www.geometrictools.com/Documentation/IncrementalDelaunayTriangulation.pdf
 
 #include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/HashCombine.h>
 #include <Mathematics/MinHeap.h>
 #include <Mathematics/SWInterval.h>
+#include <Mathematics/SpatialSort.h>
 #include <Mathematics/Vector2.h>
 #include <Mathematics/VETManifoldMesh.h>
+#include <algorithm>
 #include <functional>
 #include <map>
+#include <numeric>
 #include <set>
+#include <unordered_map>
 
 namespace gte
     // The input type must be 'float' or 'double'. The compute type is defined
@@ -85,6 +90,7 @@ namespace gte
             mRectangleRemoved(0),
             mCRPool(maxNumCRPool),
             mGraph{},
+            mLastTriangle(nullptr),
             mIndex{ { { 0, 1 }, { 1, 2 }, { 2, 0 } } },
             mTriangles{},
             mAdjacencies{},
@@ -202,6 +208,27 @@ namespace gte
             return posIndex;
         }
 
+        // Insert a set of points into the triangulation. The requirements
+        // for the points are those of Insert(position). On return,
+        // indices[i] is the vertex map index for positions[i]. The points
+        // are inserted in a biased randomized insertion order with the
+        // rounds sorted along a Hilbert curve; see SpatialSort. Each point
+        // location starts at the most recently inserted triangle, so this
+        // order makes the walks to the containing triangles short, which
+        // is much faster for large sets than inserting the points in an
+        // arbitrary order.
+        void Insert(std::vector<Vector2<T>> const& positions, std::vector<size_t>& indices)
+        {
+            indices.resize(positions.size());
+            std::vector<size_t> order(positions.size());
+            std::iota(order.begin(), order.end(), 0);
+            SpatialSort::BRIO(positions.data(), order);
+            for (auto i : order)
+            {
+                indices[i] = Insert(positions[i]);
+            }
+        }
+
         // Remove a point from the triangulation. The return value is the index
         // associated with the vertex in the vertex map when that vertex exists.
         // If the vertex does not exist, the return value is
@@ -231,6 +258,10 @@ namespace gte
                 // The position is not a vertex of the triangulation.
                 return invalid;
             }
+
+            // The removal can delete the triangle at which the next point
+            // location starts.
+            mLastTriangle = nullptr;
             int32_t vRemovalIndex = static_cast<int32_t>(iter->second);
 
             if (mVertexIndexMap.size() == 4)
@@ -289,6 +320,111 @@ namespace gte
             return static_cast<size_t>(vRemovalIndex);
         }
 
+        // Move a vertex of the triangulation to a new position, which is
+        // faster than Remove(position) followed by Insert(newPosition) when
+        // the displacement is small relative to the local vertex spacing.
+        // The vertex keeps its index, which is returned. If 'position' is
+        // not a vertex, if 'newPosition' is already a vertex or if the input
+        // rectangle was removed, the triangulation is unchanged and
+        // std::numeric_limits<size_t>::max() is returned. The new position
+        // must be strictly inside the input rectangle; if it is not, an
+        // exception is thrown. The vertices of the input rectangle cannot be
+        // moved.
+        //
+        // When the new position is in the kernel of the star-shaped polygon
+        // formed by the triangles sharing the vertex, the triangles remain
+        // counterclockwise ordered after the vertex is relocated, and the
+        // Delaunay property is restored by edge flips that start with the
+        // edges of those triangles. Otherwise, the vertex is removed and
+        // then inserted at the new position.
+        size_t Move(Vector2<T> const& position, Vector2<T> const& newPosition)
+        {
+            LogAssert(
+                mXMin < newPosition[0] && newPosition[0] < mXMax &&
+                mYMin < newPosition[1] && newPosition[1] < mYMax,
+                "The position must be strictly inside the domain specified in the constructor.");
+
+            if (mRectangleRemoved != 0)
+            {
+                return invalid;
+            }
+
+            auto iter = mVertexIndexMap.find(position);
+            if (iter == mVertexIndexMap.end() || iter->second < 7)
+            {
+                return invalid;
+            }
+            if (newPosition == position)
+            {
+                return iter->second;
+            }
+            if (mVertexIndexMap.find(newPosition) != mVertexIndexMap.end())
+            {
+                return invalid;
+            }
+
+            size_t const vIndex = iter->second;
+            int32_t const v = static_cast<int32_t>(vIndex);
+            mTrianglesAndAdjacenciesNeedUpdate = true;
+            mVertexIndexMap.erase(iter);
+            mVertexIndexMap.emplace(newPosition, vIndex);
+
+            // Determine whether the new position is strictly inside the
+            // kernel of the star-shaped polygon. ToLine uses mQueryPoint
+            // when its first argument is 'invalid'.
+            mQueryPoint = newPosition;
+            mIRQueryPoint = IRVector{ newPosition[0], newPosition[1] };
+            auto const& vMap = mGraph.GetVertices();
+            auto vIter = vMap.find(v);
+            LogAssert(
+                vIter != vMap.end(),
+                "Expecting to find the to-be-moved vertex in the triangulation.");
+
+            auto const& adjacents = vIter->second->TAdjacent;
+            bool inKernel = true;
+            for (auto const& adj : adjacents)
+            {
+                size_t j = (adj->V[0] == v ? 0 : (adj->V[1] == v ? 1 : 2));
+                size_t v1 = static_cast<size_t>(adj->V[(j + 1) % 3]);
+                size_t v2 = static_cast<size_t>(adj->V[(j + 2) % 3]);
+                if (ToLine(invalid, v1, v2) >= 0)
+                {
+                    inKernel = false;
+                    break;
+                }
+            }
+
+            if (!inKernel)
+            {
+                std::vector<int32_t> polygon;
+                DeleteRemovalPolygon(v, adjacents, polygon);
+                RetriangulateInteriorRemovalPolygon(v, polygon);
+                mVertices[vIndex] = newPosition;
+                mIRVertices[vIndex] = mIRQueryPoint;
+                mLastTriangle = nullptr;
+                Update(vIndex);
+                return vIndex;
+            }
+
+            // Relocate the vertex. The triangles sharing the vertex remain
+            // counterclockwise ordered.
+            mVertices[vIndex] = newPosition;
+            mIRVertices[vIndex] = mIRQueryPoint;
+
+            // The only edges that might not be locally Delaunay are those of
+            // the triangles sharing the vertex.
+            mFlipEdges.clear();
+            for (auto const& adj : adjacents)
+            {
+                for (size_t j0 = 2, j1 = 0; j1 < 3; j0 = j1++)
+                {
+                    mFlipEdges.push_back(EdgeKey<false>(adj->V[j0], adj->V[j1]));
+                }
+            }
+            RestoreDelaunay();
+            return vIndex;
+        }
+
         // Call this only after you are finished inserting points into or
         // removing points from the triangulation.
         bool FinalizeTriangulation()
@@ -623,8 +759,18 @@ namespace gte
         // use Remove(position) without exceptions when the state is 1.
         uint32_t mRectangleRemoved;
 
-        // The current vertices.
-        std::map<Vector2<T>, size_t> mVertexIndexMap;
+        // The current vertices. The map from positions to vertex indices is
+        // hashed, so the lookups of Insert, Remove and Move are constant
+        // time on average.
+        struct VertexHash
+        {
+            std::size_t operator()(Vector2<T> const& v) const
+            {
+                return HashValue(v[0], v[1]);
+            }
+        };
+
+        std::unordered_map<Vector2<T>, size_t, VertexHash> mVertexIndexMap;
         std::vector<Vector2<T>> mVertices;
         std::vector<IRVector> mIRVertices;
 
@@ -640,6 +786,10 @@ namespace gte
         using TrianglePtrSet = std::set<Triangle*>;
         VETManifoldMesh mGraph;
 
+        // The most recently inserted triangle, where the point location of
+        // the next insertion starts. It is null after a removal.
+        Triangle* mLastTriangle;
+
         // Indexing for the vertices of the triangle adjacent to a vertex.
         // The edge adjacent to vertex j is <mIndex[j][0], mIndex[j][1]> and
         // is listed so that the triangle interior is to your left as you walk
@@ -650,6 +800,10 @@ namespace gte
         // polygon.
         std::function<int32_t(size_t, size_t, size_t)> mToLineWrapper;
 
+        // Storage that is reused by Remove and Move.
+        std::vector<std::pair<int32_t, int32_t>> mRemovalEdges;
+        std::vector<EdgeKey<false>> mFlipEdges;
+
 
         template <typename IntegerType>
         inline bool IsDelaunayVertex(IntegerType vIndex) const
@@ -767,7 +921,7 @@ namespace gte
         void Update(size_t pIndex)
         {
             auto const& tmap = mGraph.GetTriangles();
-            Triangle* tri = tmap.begin()->second.get();
+            Triangle* tri = (mLastTriangle ? mLastTriangle : tmap.begin()->second.get());
             if (GetContainingTriangle(pIndex, tri))
             {
                 // The point is inside the convex hull. The insertion polygon
@@ -798,6 +952,7 @@ namespace gte
                         LogAssert(
                             inserted != nullptr,
                             "Unexpected insertion failure.");
+                        mLastTriangle = inserted;
                     }
                 }
             }
@@ -882,6 +1037,7 @@ namespace gte
                         LogAssert(
                             inserted != nullptr,
                             "Unexpected insertion failure.");
+                        mLastTriangle = inserted;
                     }
                 }
                 for (auto const& key : visible)
@@ -891,6 +1047,7 @@ namespace gte
                     LogAssert(
                         inserted != nullptr,
                         "Unexpected insertion failure.");
+                    mLastTriangle = inserted;
                 }
             }
         }
@@ -1161,6 +1318,89 @@ namespace gte
         }
 
     private:
+        // Support for moving a vertex. The edges in mFlipEdges are tested
+        // and flipped when they are not locally Delaunay, in which case the
+        // outer edges of the flipped quadrilateral are tested next. The
+        // edges shared by a triangle with a supervertex are not flipped.
+        // The edges that are not in the graph, because they were flipped
+        // earlier, are skipped.
+        void RestoreDelaunay()
+        {
+            auto const& eMap = mGraph.GetEdges();
+            while (mFlipEdges.size() > 0)
+            {
+                EdgeKey<false> ekey = mFlipEdges.back();
+                mFlipEdges.pop_back();
+
+                auto eIter = eMap.find(ekey);
+                if (eIter == eMap.end())
+                {
+                    continue;
+                }
+
+                Triangle* tri0 = eIter->second->T[0];
+                Triangle* tri1 = eIter->second->T[1];
+                if (!tri0 || !tri1 ||
+                    !IsDelaunayTriangle(tri0->V[0], tri0->V[1], tri0->V[2]) ||
+                    !IsDelaunayTriangle(tri1->V[0], tri1->V[1], tri1->V[2]))
+                {
+                    continue;
+                }
+
+                // Order the triangles as <a,b,c> and <b,a,d>, both
+                // counterclockwise.
+                int32_t a = eIter->second->V[0], b = eIter->second->V[1];
+                size_t j;
+                for (j = 0; j < 3; ++j)
+                {
+                    if (tri0->V[j] == a)
+                    {
+                        break;
+                    }
+                }
+                if (tri0->V[(j + 1) % 3] != b)
+                {
+                    std::swap(a, b);
+                }
+                int32_t c = GetOppositeVertex(tri0, a, b);
+                int32_t d = GetOppositeVertex(tri1, a, b);
+
+                if (ToCircumcircle(static_cast<size_t>(d), static_cast<size_t>(a),
+                    static_cast<size_t>(b), static_cast<size_t>(c)) < 0)
+                {
+                    // Point d is strictly inside the circumcircle of <a,b,c>,
+                    // so the quadrilateral <a,d,b,c> is convex. Replace edge
+                    // <a,b> by <c,d>.
+                    bool removed = mGraph.Remove(a, b, c);
+                    LogAssert(removed, "Unexpected removal failure.");
+                    removed = mGraph.Remove(b, a, d);
+                    LogAssert(removed, "Unexpected removal failure.");
+                    auto inserted = mGraph.Insert(a, d, c);
+                    LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+                    inserted = mGraph.Insert(d, b, c);
+                    LogAssert(inserted != nullptr, "Unexpected insertion failure.");
+
+                    mFlipEdges.push_back(EdgeKey<false>(a, d));
+                    mFlipEdges.push_back(EdgeKey<false>(d, b));
+                    mFlipEdges.push_back(EdgeKey<false>(b, c));
+                    mFlipEdges.push_back(EdgeKey<false>(c, a));
+                    mLastTriangle = nullptr;
+                }
+            }
+        }
+
+        static int32_t GetOppositeVertex(Triangle const* tri, int32_t a, int32_t b)
+        {
+            for (size_t j = 0; j < 3; ++j)
+            {
+                if (tri->V[j] != a && tri->V[j] != b)
+                {
+                    return tri->V[j];
+                }
+            }
+            LogError("Unexpected condition.");
+        }
+
         // Support for triangulating the removal polygon.
 
         // Let Vc be a vertex in the removal polygon. If Vc is not an ear, its
@@ -1548,8 +1788,10 @@ namespace gte
             std::vector<int32_t>& polygon)
         {
             // Get the edges of the removal polygon. The polygon is star
-            // shaped relative to the removal position.
-            std::map<int32_t, int32_t> edges;
+            // shaped relative to the removal position. The edges are sorted
+            // by their first vertex so that the successor of a vertex can be
+            // found by a binary search.
+            mRemovalEdges.clear();
             for (auto const& adj : adjacents)
             {
                 size_t i;
@@ -1566,11 +1808,12 @@ namespace gte
 
                 int32_t opposite1 = adj->V[(i + 1) % 3];
                 int32_t opposite2 = adj->V[(i + 2) % 3];
-                edges.insert(std::make_pair(opposite1, opposite2));
+                mRemovalEdges.push_back(std::make_pair(opposite1, opposite2));
             }
+            std::sort(mRemovalEdges.begin(), mRemovalEdges.end());
 
             // Remove the triangles.
-            for (auto const& edge : edges)
+            for (auto const& edge : mRemovalEdges)
             {
                 bool removed = mGraph.Remove(vRemovalIndex, edge.first, edge.second);
                 LogAssert(
@@ -1580,17 +1823,18 @@ namespace gte
 
             // Create the removal polygon; its vertices are counterclockwise
             // ordered.
-            polygon.reserve(edges.size());
+            polygon.reserve(mRemovalEdges.size());
             polygon.clear();
-            int32_t vStart = edges.begin()->first;
-            int32_t vCurr = edges.begin()->second;
+            int32_t vStart = mRemovalEdges.front().first;
+            int32_t vCurr = mRemovalEdges.front().second;
             polygon.push_back(vStart);
             while (vCurr != vStart)
             {
                 polygon.push_back(vCurr);
-                auto eIter = edges.find(vCurr);
+                auto eIter = std::lower_bound(mRemovalEdges.begin(), mRemovalEdges.end(),
+                    std::make_pair(vCurr, std::numeric_limits<int32_t>::min()));
                 LogAssert(
-                    eIter != edges.end(),
+                    eIter != mRemovalEdges.end() && eIter->first == vCurr,
                     "Unexpected condition.");
 
                 vCurr = eIter->second;
@@ -3,13 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/RootsPolynomial.h>
 #include <array>
 #include <functional>
+#include <vector>
 
 namespace gte
 {
@@ -17,6 +18,17 @@ namespace gte
     class Integration
     {
     public:
+        // The batch versions of Romberg and GaussianQuadrature estimate
+        // numIntegrals integrals of integrand[i] over [a[i],b[i]] for
+        // 0 <= i < numIntegrals. The integrands are evaluated together by
+        // integrand(numIntegrals, x, f), which must set f[i] to the value of
+        // integrand[i] at x[i]; this is a single function of x when all
+        // integrals have the same integrand. The functions call the batch
+        // integrand once per sample index, so the calls may be vectorized
+        // over the integrals. The results are the same as those of the
+        // functions for one integral.
+        typedef std::function<void(size_t, Real const*, Real*)> BatchIntegrand;
+
         // A simple algorithm, but slow to converge as the number of samples
         // is increased.  The 'numSamples' needs to be two or larger.
         static Real TrapezoidRule(int numSamples, Real a, Real b,
@@ -69,6 +81,63 @@ namespace gte
             return result;
         }
 
+        static void Romberg(int order, size_t numIntegrals, Real const* a,
+            Real const* b, BatchIntegrand const& integrand, Real* results)
+        {
+            Real const half = (Real)0.5;
+            std::vector<std::array<Real, 2>> rom(static_cast<size_t>(order) * numIntegrals);
+            std::vector<Real> h(numIntegrals), x(numIntegrals), fa(numIntegrals), fb(numIntegrals);
+            std::vector<Real> sum(numIntegrals);
+            integrand(numIntegrals, a, fa.data());
+            integrand(numIntegrals, b, fb.data());
+            for (size_t j = 0; j < numIntegrals; ++j)
+            {
+                h[j] = b[j] - a[j];
+                rom[order * j][0] = half * h[j] * (fa[j] + fb[j]);
+            }
+
+            for (int i0 = 2, p0 = 1; i0 <= order; ++i0, p0 *= 2)
+            {
+                // Approximations via the trapezoid rule.
+                std::fill(sum.begin(), sum.end(), (Real)0);
+                for (int i1 = 1; i1 <= p0; ++i1)
+                {
+                    for (size_t j = 0; j < numIntegrals; ++j)
+                    {
+                        x[j] = a[j] + h[j] * (i1 - half);
+                    }
+                    integrand(numIntegrals, x.data(), fa.data());
+                    for (size_t j = 0; j < numIntegrals; ++j)
+                    {
+                        sum[j] += fa[j];
+                    }
+                }
+
+                // Richardson extrapolation. The estimates of integral j are
+                // rom[i + order * j] for 0 <= i < order.
+                for (size_t j = 0; j < numIntegrals; ++j)
+                {
+                    std::array<Real, 2>* r = &rom[order * j];
+                    r[0][1] = half * (r[0][0] + h[j] * sum[j]);
+                    for (int i2 = 1, p2 = 4; i2 < i0; ++i2, p2 *= 4)
+                    {
+                        r[i2][1] = (p2 * r[i2 - 1][1] - r[i2 - 1][0]) / (p2 - 1);
+                    }
+
+                    for (int i1 = 0; i1 < i0; ++i1)
+                    {
+                        r[i1][0] = r[i1][1];
+                    }
+                    h[j] *= half;
+                }
+            }
+
+            for (size_t j = 0; j < numIntegrals; ++j)
+            {
+                results[j] = rom[order - 1 + order * j][0];
+            }
+        }
+
         // Gaussian quadrature estimates the integral of a function f(x)
         // defined on [-1,1] using
         //   integral_{-1}^{1} f(t) dt = sum_{i=0}^{n-1} c[i]*f(r[i])
@@ -213,5 +282,39 @@ namespace gte
             result *= radius;
             return result;
         }
+
+        static void GaussianQuadrature(std::vector<Real> const& roots,
+            std::vector<Real>const& coefficients, size_t numIntegrals,
+            Real const* a, Real const* b, BatchIntegrand const& integrand,
+            Real* results)
+        {
+            Real const half = (Real)0.5;
+            std::vector<Real> radius(numIntegrals), center(numIntegrals);
+            std::vector<Real> x(numIntegrals), f(numIntegrals);
+            for (size_t j = 0; j < numIntegrals; ++j)
+            {
+                radius[j] = half * (b[j] - a[j]);
+                center[j] = half * (b[j] + a[j]);
+                results[j] = (Real)0;
+            }
+
+            for (size_t i = 0; i < roots.size(); ++i)
+            {
+                for (size_t j = 0; j < numIntegrals; ++j)
+                {
+                    x[j] = radius[j] * roots[i] + center[j];
+                }
+                integrand(numIntegrals, x.data(), f.data());
+                for (size_t j = 0; j < numIntegrals; ++j)
+                {
+                    results[j] += coefficients[i] * f[j];
+                }
+            }
+
+            for (size_t j = 0; j < numIntegrals; ++j)
+            {
+                results[j] *= radius[j];
+            }
+        }
     };
 }
@@ -3,22 +3,38 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/Math.h>
 #include <Mathematics/Array3.h>
+#include <Mathematics/IntpBatch.h>
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <limits>
+#include <vector>
 
 // The interpolator is for uniformly spaced(x,y z)-values.  The input samples
 // must be stored in lexicographical order to represent f(x,y,z); that is,
 // F[c + xBound*(r + yBound*s)] corresponds to f(x,y,z), where c is the index
 // corresponding to x, r is the index corresponding to y, and s is the index
 // corresponding to z.
+//
+// By default the constructor computes the polynomials of all cells, which
+// requires 64 numbers per sample. When the constructor is passed a positive
+// polynomialCacheSize, it computes only the derivative estimates at the
+// samples, which requires 7 numbers per sample, and the polynomial of a cell
+// is computed when the cell is first used and stored in a direct-mapped
+// cache of polynomialCacheSize polynomials. The cache is modified by the
+// single-point evaluations, which then must not be called concurrently.
+//
+// The batch evaluation sorts the query points by cell and partitions the
+// sorted points among threads; see IntpBatch.h. It computes the polynomial
+// of a cell at most once per block of sorted points when the polynomials
+// are not precomputed, and it does not use the cache.
 
 namespace gte
 {
@@ -29,7 +45,7 @@ namespace gte
         // Construction and destruction.
         IntpAkimaUniform3(int xBound, int yBound, int zBound, Real xMin,
             Real xSpacing, Real yMin, Real ySpacing, Real zMin, Real zSpacing,
-            Real const* F)
+            Real const* F, size_t polynomialCacheSize = 0)
             :
             mXBound(xBound),
             mYBound(yBound),
@@ -41,8 +57,7 @@ namespace gte
             mYSpacing(ySpacing),
             mZMin(zMin),
             mZSpacing(zSpacing),
-            mF(F),
-            mPoly(xBound - 1, yBound - 1, zBound - 1)
+            mF(F)
         {
             // At least a 3x3x3 block of data points is needed to construct
             // the estimates of the boundary derivatives.
@@ -54,30 +69,47 @@ namespace gte
             mZMax = mZMin + mZSpacing * static_cast<Real>(mZBound - 1);
 
             // Create a 3D wrapper for the 1D samples.
-            Array3<Real> Fmap(mXBound, mYBound, mZBound, const_cast<Real*>(mF));
+            mFmap = Array3<Real>(mXBound, mYBound, mZBound, const_cast<Real*>(mF));
 
             // Construct first-order derivatives.
-            Array3<Real> FX(mXBound, mYBound, mZBound);
-            Array3<Real> FY(mXBound, mYBound, mZBound);
-            Array3<Real> FZ(mXBound, mYBound, mZBound);
-            GetFX(Fmap, FX);
-            GetFX(Fmap, FY);
-            GetFX(Fmap, FZ);
+            mFX = Array3<Real>(mXBound, mYBound, mZBound);
+            mFY = Array3<Real>(mXBound, mYBound, mZBound);
+            mFZ = Array3<Real>(mXBound, mYBound, mZBound);
+            GetFX(mFmap, mFX);
+            GetFY(mFmap, mFY);
+            GetFZ(mFmap, mFZ);
 
             // Construct second-order derivatives.
-            Array3<Real> FXY(mXBound, mYBound, mZBound);
-            Array3<Real> FXZ(mXBound, mYBound, mZBound);
-            Array3<Real> FYZ(mXBound, mYBound, mZBound);
-            GetFX(Fmap, FXY);
-            GetFX(Fmap, FXZ);
-            GetFX(Fmap, FYZ);
+            mFXY = Array3<Real>(mXBound, mYBound, mZBound);
+            mFXZ = Array3<Real>(mXBound, mYBound, mZBound);
+            mFYZ = Array3<Real>(mXBound, mYBound, mZBound);
+            GetFXY(mFmap, mFXY);
+            GetFXZ(mFmap, mFXZ);
+            GetFYZ(mFmap, mFYZ);
 
             // Construct third-order derivatives.
-            Array3<Real> FXYZ(mXBound, mYBound, mZBound);
-            GetFXYZ(Fmap, FXYZ);
+            mFXYZ = Array3<Real>(mXBound, mYBound, mZBound);
+            GetFXYZ(mFmap, mFXYZ);
 
-            // Construct polynomials.
-            GetPolynomials(Fmap, FX, FY, FZ, FXY, FXZ, FYZ, FXYZ);
+            if (polynomialCacheSize == 0)
+            {
+                // Construct polynomials. The derivatives are no longer
+                // needed.
+                mPoly = Array3<Polynomial>(mXBound - 1, mYBound - 1, mZBound - 1);
+                GetPolynomials();
+                mFX = Array3<Real>();
+                mFY = Array3<Real>();
+                mFZ = Array3<Real>();
+                mFXY = Array3<Real>();
+                mFXZ = Array3<Real>();
+                mFYZ = Array3<Real>();
+                mFXYZ = Array3<Real>();
+            }
+            else
+            {
+                mCache.resize(polynomialCacheSize);
+                mCacheCell.resize(polynomialCacheSize, msInvalidCell);
+            }
         }
 
         ~IntpAkimaUniform3() = default;
@@ -153,6 +185,13 @@ namespace gte
             return mZSpacing;
         }
 
+        // The number of polynomials in the cache, which is 0 when the
+        // polynomials of all cells are precomputed.
+        inline size_t GetPolynomialCacheSize() const
+        {
+            return mCache.size();
+        }
+
         // Evaluate the function and its derivatives.  The functions clamp the
         // inputs to xmin <= x <= xmax, ymin <= y <= ymax and
         // zmin <= z <= zmax.  The first operator is for function evaluation.
@@ -163,28 +202,67 @@ namespace gte
         // function value itself.
         Real operator()(Real x, Real y, Real z) const
         {
-            x = std::min(std::max(x, mXMin), mXMax);
-            y = std::min(std::max(y, mYMin), mYMax);
-            z = std::min(std::max(z, mZMin), mZMax);
             int ix, iy, iz;
             Real dx, dy, dz;
-            XLookup(x, ix, dx);
-            YLookup(y, iy, dy);
-            ZLookup(z, iz, dz);
-            return mPoly[iz][iy][ix](dx, dy, dz);
+            Lookup(x, y, z, ix, iy, iz, dx, dy, dz);
+            return GetPolynomial(ix, iy, iz)(dx, dy, dz);
         }
 
         Real operator()(int xOrder, int yOrder, int zOrder, Real x, Real y, Real z) const
         {
-            x = std::min(std::max(x, mXMin), mXMax);
-            y = std::min(std::max(y, mYMin), mYMax);
-            z = std::min(std::max(z, mZMin), mZMax);
             int ix, iy, iz;
             Real dx, dy, dz;
-            XLookup(x, ix, dx);
-            YLookup(y, iy, dy);
-            ZLookup(z, iz, dz);
-            return mPoly[iz][iy][ix](xOrder, yOrder, zOrder, dx, dy, dz);
+            Lookup(x, y, z, ix, iy, iz, dx, dy, dz);
+            return GetPolynomial(ix, iy, iz)(xOrder, yOrder, zOrder, dx, dy, dz);
+        }
+
+        // Batch evaluation of the function at points[i] = (x,y,z), storing
+        // the result in values[i], for 0 <= i < numPoints. The results are
+        // those of the single-point evaluation. The code runs single-threaded
+        // when numThreads <= 1. Otherwise, the threads are tasks of the
+        // scheduler when it is not null.
+        void operator()(size_t numPoints, std::array<Real, 3> const* points,
+            Real* values, size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
+        {
+            std::vector<std::pair<size_t, size_t>> sorted;
+            size_t const numCells = static_cast<size_t>(mXBound - 1) * static_cast<size_t>(mYBound - 1) *
+                static_cast<size_t>(mZBound - 1);
+            IntpBatch::SortByCell(numPoints, numCells,
+                [this, points](size_t i)
+                {
+                    int ix, iy, iz;
+                    Real dx, dy, dz;
+                    Lookup(points[i][0], points[i][1], points[i][2], ix, iy, iz, dx, dy, dz);
+                    return GetCell(ix, iy, iz);
+                }, sorted);
+
+            IntpBatch::Execute(numThreads, scheduler, numPoints,
+                [this, points, values, &sorted](size_t first, size_t last)
+                {
+                    Polynomial local;
+                    size_t localCell = msInvalidCell;
+                    for (size_t j = first; j < last; ++j)
+                    {
+                        size_t const cell = sorted[j].first;
+                        size_t const i = sorted[j].second;
+                        int ix, iy, iz;
+                        Real dx, dy, dz;
+                        Lookup(points[i][0], points[i][1], points[i][2], ix, iy, iz, dx, dy, dz);
+                        if (mCache.size() == 0)
+                        {
+                            values[i] = mPoly[iz][iy][ix](dx, dy, dz);
+                        }
+                        else
+                        {
+                            if (cell != localCell)
+                            {
+                                ComputePolynomial(ix, iy, iz, local);
+                                localCell = cell;
+                            }
+                            values[i] = local(dx, dy, dz);
+                        }
+                    }
+                });
         }
 
     private:
@@ -941,9 +1019,7 @@ namespace gte
             }
         }
 
-        void GetPolynomials(Array3<Real> const& F, Array3<Real> const& FX,
-            Array3<Real> const& FY, Array3<Real> const& FZ, Array3<Real> const& FXY,
-            Array3<Real> const& FXZ, Array3<Real> const& FYZ, Array3<Real> const& FXYZ)
+        void GetPolynomials()
         {
             int xBoundM1 = mXBound - 1;
             int yBoundM1 = mYBound - 1;
@@ -954,204 +1030,223 @@ namespace gte
                 {
                     for (int ix = 0; ix < xBoundM1; ++ix)
                     {
-                        // Note the 'transposing' of the 2x2x2 blocks (to match
-                        // notation used in the polynomial definition).
-                        Real G[2][2][2] =
-                        {
-                            {
-                                {
-                                    F[iz][iy][ix],
-                                    F[iz + 1][iy][ix]
-                                },
-                                {
-                                    F[iz][iy + 1][ix],
-                                    F[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    F[iz][iy][ix + 1],
-                                    F[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    F[iz][iy + 1][ix + 1],
-                                    F[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+                        ComputePolynomial(ix, iy, iz, mPoly[iz][iy][ix]);
+                    }
+                }
+            }
+        }
 
-                        Real GX[2][2][2] =
-                        {
-                            {
-                                {
-                                    FX[iz][iy][ix],
-                                    FX[iz + 1][iy][ix]
-                                },
-                                {
-                                    FX[iz][iy + 1][ix],
-                                    FX[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FX[iz][iy][ix + 1],
-                                    FX[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FX[iz][iy + 1][ix + 1],
-                                    FX[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        // Compute the polynomial of cell (ix,iy,iz) from the samples and
+        // the derivative estimates.
+        void ComputePolynomial(int ix, int iy, int iz, Polynomial& poly) const
+        {
+            Array3<Real> const& F = mFmap;
+            Array3<Real> const& FX = mFX;
+            Array3<Real> const& FY = mFY;
+            Array3<Real> const& FZ = mFZ;
+            Array3<Real> const& FXY = mFXY;
+            Array3<Real> const& FXZ = mFXZ;
+            Array3<Real> const& FYZ = mFYZ;
+            Array3<Real> const& FXYZ = mFXYZ;
+
+            // Construct requires the coefficients to be initially zero.
+            poly = Polynomial();
+
+        // Note the 'transposing' of the 2x2x2 blocks (to match
+        // notation used in the polynomial definition).
+        Real G[2][2][2] =
+        {
+            {
+                {
+                    F[iz][iy][ix],
+                    F[iz + 1][iy][ix]
+                },
+                {
+                    F[iz][iy + 1][ix],
+                    F[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    F[iz][iy][ix + 1],
+                    F[iz + 1][iy][ix + 1]
+                },
+                {
+                    F[iz][iy + 1][ix + 1],
+                    F[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Real GY[2][2][2] =
-                        {
-                            {
-                                {
-                                    FY[iz][iy][ix],
-                                    FY[iz + 1][iy][ix]
-                                },
-                                {
-                                    FY[iz][iy + 1][ix],
-                                    FY[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FY[iz][iy][ix + 1],
-                                    FY[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FY[iz][iy + 1][ix + 1],
-                                    FY[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        Real GX[2][2][2] =
+        {
+            {
+                {
+                    FX[iz][iy][ix],
+                    FX[iz + 1][iy][ix]
+                },
+                {
+                    FX[iz][iy + 1][ix],
+                    FX[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FX[iz][iy][ix + 1],
+                    FX[iz + 1][iy][ix + 1]
+                },
+                {
+                    FX[iz][iy + 1][ix + 1],
+                    FX[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Real GZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FZ[iz][iy][ix],
-                                    FZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FZ[iz][iy + 1][ix],
-                                    FZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FZ[iz][iy][ix + 1],
-                                    FZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FZ[iz][iy + 1][ix + 1],
-                                    FZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        Real GY[2][2][2] =
+        {
+            {
+                {
+                    FY[iz][iy][ix],
+                    FY[iz + 1][iy][ix]
+                },
+                {
+                    FY[iz][iy + 1][ix],
+                    FY[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FY[iz][iy][ix + 1],
+                    FY[iz + 1][iy][ix + 1]
+                },
+                {
+                    FY[iz][iy + 1][ix + 1],
+                    FY[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Real GXY[2][2][2] =
-                        {
-                            {
-                                {
-                                    FXY[iz][iy][ix],
-                                    FXY[iz + 1][iy][ix]
-                                },
-                                {
-                                    FXY[iz][iy + 1][ix],
-                                    FXY[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FXY[iz][iy][ix + 1],
-                                    FXY[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FXY[iz][iy + 1][ix + 1],
-                                    FXY[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        Real GZ[2][2][2] =
+        {
+            {
+                {
+                    FZ[iz][iy][ix],
+                    FZ[iz + 1][iy][ix]
+                },
+                {
+                    FZ[iz][iy + 1][ix],
+                    FZ[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FZ[iz][iy][ix + 1],
+                    FZ[iz + 1][iy][ix + 1]
+                },
+                {
+                    FZ[iz][iy + 1][ix + 1],
+                    FZ[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Real GXZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FXZ[iz][iy][ix],
-                                    FXZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FXZ[iz][iy + 1][ix],
-                                    FXZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FXZ[iz][iy][ix + 1],
-                                    FXZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FXZ[iz][iy + 1][ix + 1],
-                                    FXZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        Real GXY[2][2][2] =
+        {
+            {
+                {
+                    FXY[iz][iy][ix],
+                    FXY[iz + 1][iy][ix]
+                },
+                {
+                    FXY[iz][iy + 1][ix],
+                    FXY[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FXY[iz][iy][ix + 1],
+                    FXY[iz + 1][iy][ix + 1]
+                },
+                {
+                    FXY[iz][iy + 1][ix + 1],
+                    FXY[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Real GYZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FYZ[iz][iy][ix],
-                                    FYZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FYZ[iz][iy + 1][ix],
-                                    FYZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FYZ[iz][iy][ix + 1],
-                                    FYZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FYZ[iz][iy + 1][ix + 1],
-                                    FYZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        Real GXZ[2][2][2] =
+        {
+            {
+                {
+                    FXZ[iz][iy][ix],
+                    FXZ[iz + 1][iy][ix]
+                },
+                {
+                    FXZ[iz][iy + 1][ix],
+                    FXZ[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FXZ[iz][iy][ix + 1],
+                    FXZ[iz + 1][iy][ix + 1]
+                },
+                {
+                    FXZ[iz][iy + 1][ix + 1],
+                    FXZ[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Real GXYZ[2][2][2] =
-                        {
-                            {
-                                {
-                                    FXYZ[iz][iy][ix],
-                                    FXYZ[iz + 1][iy][ix]
-                                },
-                                {
-                                    FXYZ[iz][iy + 1][ix],
-                                    FXYZ[iz + 1][iy + 1][ix]
-                                }
-                            },
-                            {
-                                {
-                                    FXYZ[iz][iy][ix + 1],
-                                    FXYZ[iz + 1][iy][ix + 1]
-                                },
-                                {
-                                    FXYZ[iz][iy + 1][ix + 1],
-                                    FXYZ[iz + 1][iy + 1][ix + 1]
-                                }
-                            }
-                        };
+        Real GYZ[2][2][2] =
+        {
+            {
+                {
+                    FYZ[iz][iy][ix],
+                    FYZ[iz + 1][iy][ix]
+                },
+                {
+                    FYZ[iz][iy + 1][ix],
+                    FYZ[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FYZ[iz][iy][ix + 1],
+                    FYZ[iz + 1][iy][ix + 1]
+                },
+                {
+                    FYZ[iz][iy + 1][ix + 1],
+                    FYZ[iz + 1][iy + 1][ix + 1]
+                }
+            }
+        };
 
-                        Construct(mPoly[iz][iy][ix], G, GX, GY, GZ, GXY, GXZ, GYZ, GXYZ);
-                    }
+        Real GXYZ[2][2][2] =
+        {
+            {
+                {
+                    FXYZ[iz][iy][ix],
+                    FXYZ[iz + 1][iy][ix]
+                },
+                {
+                    FXYZ[iz][iy + 1][ix],
+                    FXYZ[iz + 1][iy + 1][ix]
+                }
+            },
+            {
+                {
+                    FXYZ[iz][iy][ix + 1],
+                    FXYZ[iz + 1][iy][ix + 1]
+                },
+                {
+                    FXYZ[iz][iy + 1][ix + 1],
+                    FXYZ[iz + 1][iy + 1][ix + 1]
                 }
             }
+        };
+
+            Construct(poly, G, GX, GY, GZ, GXY, GXZ, GYZ, GXYZ);
         }
 
         Real ComputeDerivative(Real const* slope) const
@@ -1192,7 +1287,7 @@ namespace gte
         void Construct(Polynomial& poly,
             Real const F[2][2][2], Real const FX[2][2][2], Real const FY[2][2][2],
             Real const FZ[2][2][2], Real const FXY[2][2][2], Real const FXZ[2][2][2],
-            Real const FYZ[2][2][2], Real const FXYZ[2][2][2])
+            Real const FYZ[2][2][2], Real const FXYZ[2][2][2]) const
         {
             Real dx = mXSpacing, dy = mYSpacing, dz = mZSpacing;
             Real invDX = (Real)1 / dx, invDX2 = invDX * invDX;
@@ -1360,48 +1455,90 @@ namespace gte
                 invDX * invDY * invDZ;
         }
 
-        void XLookup(Real x, int& xIndex, Real& dx) const
+        // Clamp the point to the domain and compute its cell and its
+        // offsets from the cell origin.
+        void Lookup(Real x, Real y, Real z, int& ix, int& iy, int& iz,
+            Real& dx, Real& dy, Real& dz) const
         {
-            for (xIndex = 0; xIndex + 1 < mXBound; ++xIndex)
+            x = std::min(std::max(x, mXMin), mXMax);
+            y = std::min(std::max(y, mYMin), mYMax);
+            z = std::min(std::max(z, mZMin), mZMax);
+            XLookup(x, ix, dx);
+            YLookup(y, iy, dy);
+            ZLookup(z, iz, dz);
+        }
+
+        inline size_t GetCell(int ix, int iy, int iz) const
+        {
+            return static_cast<size_t>(ix) + static_cast<size_t>(mXBound - 1) *
+                (static_cast<size_t>(iy) + static_cast<size_t>(mYBound - 1) * static_cast<size_t>(iz));
+        }
+
+        Polynomial const& GetPolynomial(int ix, int iy, int iz) const
+        {
+            if (mCache.size() == 0)
             {
-                if (x < mXMin + mXSpacing * (xIndex + 1))
-                {
-                    dx = x - (mXMin + mXSpacing * xIndex);
-                    return;
-                }
+                return mPoly[iz][iy][ix];
             }
 
-            --xIndex;
-            dx = x - (mXMin + mXSpacing * xIndex);
+            size_t const cell = GetCell(ix, iy, iz);
+            size_t const slot = cell % mCache.size();
+            if (mCacheCell[slot] != cell)
+            {
+                ComputePolynomial(ix, iy, iz, mCache[slot]);
+                mCacheCell[slot] = cell;
+            }
+            return mCache[slot];
         }
 
-        void YLookup(Real y, int& yIndex, Real & dy) const
+        // The index is that of the first cell whose right endpoint is
+        // larger than x, or the last cell when there is none. It is
+        // computed from the spacing and then corrected for rounding errors.
+        void XLookup(Real x, int& xIndex, Real& dx) const
         {
-            for (yIndex = 0; yIndex + 1 < mYBound; ++yIndex)
+            xIndex = std::min(static_cast<int>((x - mXMin) / mXSpacing), mXBound - 2);
+            if (xIndex > 0 && x < mXMin + mXSpacing * xIndex)
             {
-                if (y < mYMin + mYSpacing * (yIndex + 1))
-                {
-                    dy = y - (mYMin + mYSpacing * yIndex);
-                    return;
-                }
+                --xIndex;
             }
+            else if (xIndex + 2 < mXBound && !(x < mXMin + mXSpacing * (xIndex + 1)))
+            {
+                ++xIndex;
+            }
+            dx = x - (mXMin + mXSpacing * xIndex);
+        }
 
-            --yIndex;
+        // The index is that of the first cell whose right endpoint is
+        // larger than y, or the last cell when there is none. It is
+        // computed from the spacing and then corrected for rounding errors.
+        void YLookup(Real y, int& yIndex, Real& dy) const
+        {
+            yIndex = std::min(static_cast<int>((y - mYMin) / mYSpacing), mYBound - 2);
+            if (yIndex > 0 && y < mYMin + mYSpacing * yIndex)
+            {
+                --yIndex;
+            }
+            else if (yIndex + 2 < mYBound && !(y < mYMin + mYSpacing * (yIndex + 1)))
+            {
+                ++yIndex;
+            }
             dy = y - (mYMin + mYSpacing * yIndex);
         }
 
-        void ZLookup(Real z, int& zIndex, Real & dz) const
+        // The index is that of the first cell whose right endpoint is
+        // larger than z, or the last cell when there is none. It is
+        // computed from the spacing and then corrected for rounding errors.
+        void ZLookup(Real z, int& zIndex, Real& dz) const
         {
-            for (zIndex = 0; zIndex + 1 < mZBound; ++zIndex)
+            zIndex = std::min(static_cast<int>((z - mZMin) / mZSpacing), mZBound - 2);
+            if (zIndex > 0 && z < mZMin + mZSpacing * zIndex)
             {
-                if (z < mZMin + mZSpacing * (zIndex + 1))
-                {
-                    dz = z - (mZMin + mZSpacing * zIndex);
-                    return;
-                }
+                --zIndex;
+            }
+            else if (zIndex + 2 < mZBound && !(z < mZMin + mZSpacing * (zIndex + 1)))
+            {
+                ++zIndex;
             }
-
-            --zIndex;
             dz = z - (mZMin + mZSpacing * zIndex);
         }
 
@@ -1410,6 +1547,20 @@ namespace gte
         Real mYMin, mYMax, mYSpacing;
         Real mZMin, mZMax, mZSpacing;
         Real const* mF;
+        Array3<Real> mFmap;
+
+        // The polynomials of all cells when they are precomputed.
         Array3<Polynomial> mPoly;
+
+        // The derivative estimates at the samples and the cache of
+        // polynomials when the polynomials are not precomputed. The cell of
+        // each cache slot is msInvalidCell when the slot is empty.
+        Array3<Real> mFX, mFY, mFZ, mFXY, mFXZ, mFYZ, mFXYZ;
+        mutable std::vector<Polynomial> mCache;
+        mutable std::vector<size_t> mCacheCell;
+        static size_t const msInvalidCell = std::numeric_limits<size_t>::max();
     };
+
+    template <typename Real>
+    size_t const IntpAkimaUniform3<Real>::msInvalidCell;
 }
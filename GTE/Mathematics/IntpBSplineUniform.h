@@ -3,13 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/Math.h>
 #include <Mathematics/Polynomial1.h>
+#include <algorithm>
 #include <array>
 
 // IntpBSplineUniform is the class for B-spline interpolation of uniformly
@@ -49,6 +50,15 @@
 //   // components).
 //   Type operator() (int i0, int i1, ..., int inm1) const;
 // }
+//
+// The specializations for dimensions 1, 2 and 3 also have batch
+// evaluations of an array of t-inputs. When caching is disabled and the
+// degrees are 1, 2 or 3, the batch evaluations use code that is compiled
+// for the degrees. The points are processed in blocks of BATCH_SIZE, and
+// the basis functions of a block are computed by loops over the points of
+// the block, which compilers can vectorize. The control points are then
+// combined point by point, because the Controls adapter is called for
+// each of them. The results are those of the single-point evaluations.
 
 namespace gte
 {
@@ -343,6 +353,58 @@ namespace gte
             }
         }
 
+        // Support for the batch evaluations of the specializations for
+        // dimensions 1, 2 and 3.
+        enum { BATCH_SIZE = 8 };
+        typedef std::array<int, BATCH_SIZE> IntBlock;
+        typedef std::array<Real, BATCH_SIZE> RealBlock;
+
+        // Compute the coefficients h[j][] of the polynomials in u of the
+        // basis functions j (or their derivatives of the specified order)
+        // for a compile-time degree D. The Horner evaluation of
+        // EvaluateNoCaching is
+        //   phi[j] = phi[j] * u + h[j][m]
+        // for 0 <= m <= D, starting with phi[j] = 0. The coefficients for
+        // m < order are 0, which leaves phi[j] = 0, so the remaining terms
+        // are those of EvaluateNoCaching.
+        template <int D>
+        static void GetHornerCoefficients(std::vector<Real> const& blender,
+            std::vector<Real> const& dCoefficient, std::vector<int> const& ellMax,
+            int order, std::array<std::array<Real, D + 1>, D + 1>& h)
+        {
+            for (int j = 0; j <= D; ++j)
+            {
+                int kjIndex = D + (D + 1) * j;
+                int ell = ellMax[order];
+                for (int m = 0; m <= D; ++m)
+                {
+                    h[j][m] = (m < order ? (Real)0 : blender[kjIndex--] * dCoefficient[ell--]);
+                }
+            }
+        }
+
+        // Evaluate the basis functions for the u-values of a block of
+        // points, phi[j][q] for point q.
+        template <int D>
+        static void ComputeBasis(std::array<std::array<Real, D + 1>, D + 1> const& h,
+            RealBlock const& u, std::array<RealBlock, D + 1>& phi)
+        {
+            for (int j = 0; j <= D; ++j)
+            {
+                for (int q = 0; q < BATCH_SIZE; ++q)
+                {
+                    phi[j][q] = (Real)0;
+                }
+                for (int m = 0; m <= D; ++m)
+                {
+                    for (int q = 0; q < BATCH_SIZE; ++q)
+                    {
+                        phi[j][q] = phi[j][q] * u[q] + h[j][m];
+                    }
+                }
+            }
+        }
+
         // The remaining functions are used only by the general-dimension
         // derived classes when caching is enabled.
 
@@ -863,7 +925,75 @@ namespace gte
             return result;
         }
 
+        // Batch evaluation, results[p] = Evaluate(order, t[p]) for
+        // 0 <= p < numPoints.
+        void Evaluate(std::array<int, 1> const& order, size_t numPoints,
+            std::array<Real, 1> const* t, typename Controls::Type* results)
+        {
+            if (0 <= order[0] && order[0] <= mDegree && mCacheMode == this->NO_CACHING)
+            {
+                switch (mDegree)
+                {
+                case 1:
+                    EvaluateBatch<1>(order, numPoints, t, results);
+                    return;
+                case 2:
+                    EvaluateBatch<2>(order, numPoints, t, results);
+                    return;
+                case 3:
+                    EvaluateBatch<3>(order, numPoints, t, results);
+                    return;
+                default:
+                    break;
+                }
+            }
+
+            for (size_t p = 0; p < numPoints; ++p)
+            {
+                results[p] = Evaluate(order, t[p]);
+            }
+        }
+
     protected:
+        typedef typename IntpBSplineUniformShared<Real, Controls>::IntBlock IntBlock;
+        typedef typename IntpBSplineUniformShared<Real, Controls>::RealBlock RealBlock;
+        static int const BATCH_SIZE = IntpBSplineUniformShared<Real, Controls>::BATCH_SIZE;
+
+        template <int D>
+        void EvaluateBatch(std::array<int, 1> const& order, size_t numPoints,
+            std::array<Real, 1> const* t, typename Controls::Type* results)
+        {
+            std::array<std::array<Real, D + 1>, D + 1> h;
+            this->template GetHornerCoefficients<D>(mBlender, mDCoefficient, mLMax, order[0], h);
+            Real const adjust = mPowerDSDT[order[0]];
+
+            for (size_t first = 0; first < numPoints; first += BATCH_SIZE)
+            {
+                int const n = static_cast<int>(std::min(numPoints - first,
+                    static_cast<size_t>(BATCH_SIZE)));
+                IntBlock i{};
+                RealBlock u{};
+                for (int q = 0; q < n; ++q)
+                {
+                    this->GetKey(t[first + q][0], mTMin, mTMax, mPowerDSDT[1], mNumControls,
+                        mDegree, i[q], u[q]);
+                }
+
+                std::array<RealBlock, D + 1> phi;
+                this->template ComputeBasis<D>(h, u, phi);
+
+                for (int q = 0; q < n; ++q)
+                {
+                    auto result = mCTZero;
+                    for (int j = 0; j <= D; ++j)
+                    {
+                        result = result + (*mControls)(i[q] + j) * phi[j][q];
+                    }
+                    results[first + q] = result * adjust;
+                }
+            }
+        }
+
         void ComputeTensor(int r, int c, int index)
         {
             auto element = mCTZero;
@@ -1093,6 +1223,124 @@ namespace gte
             return result;
         }
 
+        // Batch evaluation, results[p] = Evaluate(order, t[p]) for
+        // 0 <= p < numPoints.
+        void Evaluate(std::array<int, 2> const& order, size_t numPoints,
+            std::array<Real, 2> const* t, typename Controls::Type* results)
+        {
+            if (0 <= order[0] && order[0] <= mDegree[0]
+                && 0 <= order[1] && order[1] <= mDegree[1]
+                && mCacheMode == this->NO_CACHING)
+            {
+                switch (mDegree[0])
+                {
+                case 1:
+                    if (EvaluateBatch<1>(order, numPoints, t, results))
+                    {
+                        return;
+                    }
+                    break;
+                case 2:
+                    if (EvaluateBatch<2>(order, numPoints, t, results))
+                    {
+                        return;
+                    }
+                    break;
+                case 3:
+                    if (EvaluateBatch<3>(order, numPoints, t, results))
+                    {
+                        return;
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            for (size_t p = 0; p < numPoints; ++p)
+            {
+                results[p] = Evaluate(order, t[p]);
+            }
+        }
+
+    protected:
+        typedef typename IntpBSplineUniformShared<Real, Controls>::IntBlock IntBlock;
+        typedef typename IntpBSplineUniformShared<Real, Controls>::RealBlock RealBlock;
+        static int const BATCH_SIZE = IntpBSplineUniformShared<Real, Controls>::BATCH_SIZE;
+
+        // Dispatch on the degree for dimension 1. The function returns
+        // 'false' when the degree does not have compiled code.
+        template <int D0>
+        bool EvaluateBatch(std::array<int, 2> const& order, size_t numPoints,
+            std::array<Real, 2> const* t, typename Controls::Type* results)
+        {
+            switch (mDegree[1])
+            {
+            case 1:
+                EvaluateBatch<D0, 1>(order, numPoints, t, results);
+                return true;
+            case 2:
+                EvaluateBatch<D0, 2>(order, numPoints, t, results);
+                return true;
+            case 3:
+                EvaluateBatch<D0, 3>(order, numPoints, t, results);
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        template <int D0, int D1>
+        void EvaluateBatch(std::array<int, 2> const& order, size_t numPoints,
+            std::array<Real, 2> const* t, typename Controls::Type* results)
+        {
+            std::array<std::array<Real, D0 + 1>, D0 + 1> h0;
+            std::array<std::array<Real, D1 + 1>, D1 + 1> h1;
+            this->template GetHornerCoefficients<D0>(mBlender[0], mDCoefficient[0], mLMax[0], order[0], h0);
+            this->template GetHornerCoefficients<D1>(mBlender[1], mDCoefficient[1], mLMax[1], order[1], h1);
+            Real adjust(1);
+            for (int dim = 0; dim < 2; ++dim)
+            {
+                adjust *= mPowerDSDT[dim][order[dim]];
+            }
+
+            for (size_t first = 0; first < numPoints; first += BATCH_SIZE)
+            {
+                int const n = static_cast<int>(std::min(numPoints - first,
+                    static_cast<size_t>(BATCH_SIZE)));
+                std::array<IntBlock, 2> i{};
+                std::array<RealBlock, 2> u{};
+                for (int q = 0; q < n; ++q)
+                {
+                    for (int dim = 0; dim < 2; ++dim)
+                    {
+                        this->GetKey(t[first + q][dim], mTMin[dim], mTMax[dim], mPowerDSDT[dim][1],
+                            mNumControls[dim], mDegree[dim], i[dim][q], u[dim][q]);
+                    }
+                }
+
+                std::array<RealBlock, D0 + 1> phi0;
+                std::array<RealBlock, D1 + 1> phi1;
+                this->template ComputeBasis<D0>(h0, u[0], phi0);
+                this->template ComputeBasis<D1>(h1, u[1], phi1);
+
+                for (int q = 0; q < n; ++q)
+                {
+                    auto result = mCTZero;
+                    for (int j1 = 0; j1 <= D1; ++j1)
+                    {
+                        Real phi1q = phi1[j1][q];
+                        for (int j0 = 0; j0 <= D0; ++j0)
+                        {
+                            Real phi01 = phi0[j0][q] * phi1q;
+                            result = result + (*mControls)(i[0][q] + j0, i[1][q] + j1) * phi01;
+                        }
+                    }
+                    results[first + q] = result * adjust;
+                }
+            }
+        }
+
         void ComputeTensor(int r0, int r1, int c0, int c1, int index)
         {
             auto element = mCTZero;
@@ -1350,7 +1598,150 @@ namespace gte
             return result;
         }
 
+        // Batch evaluation, results[p] = Evaluate(order, t[p]) for
+        // 0 <= p < numPoints.
+        void Evaluate(std::array<int, 3> const& order, size_t numPoints,
+            std::array<Real, 3> const* t, typename Controls::Type* results)
+        {
+            if (0 <= order[0] && order[0] <= mDegree[0]
+                && 0 <= order[1] && order[1] <= mDegree[1]
+                && 0 <= order[2] && order[2] <= mDegree[2]
+                && mCacheMode == this->NO_CACHING)
+            {
+                switch (mDegree[0])
+                {
+                case 1:
+                    if (EvaluateBatch<1>(order, numPoints, t, results))
+                    {
+                        return;
+                    }
+                    break;
+                case 2:
+                    if (EvaluateBatch<2>(order, numPoints, t, results))
+                    {
+                        return;
+                    }
+                    break;
+                case 3:
+                    if (EvaluateBatch<3>(order, numPoints, t, results))
+                    {
+                        return;
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            for (size_t p = 0; p < numPoints; ++p)
+            {
+                results[p] = Evaluate(order, t[p]);
+            }
+        }
+
     protected:
+        typedef typename IntpBSplineUniformShared<Real, Controls>::IntBlock IntBlock;
+        typedef typename IntpBSplineUniformShared<Real, Controls>::RealBlock RealBlock;
+        static int const BATCH_SIZE = IntpBSplineUniformShared<Real, Controls>::BATCH_SIZE;
+
+        // Dispatch on the degrees for dimensions 1 and 2. The functions
+        // return 'false' when a degree does not have compiled code.
+        template <int D0>
+        bool EvaluateBatch(std::array<int, 3> const& order, size_t numPoints,
+            std::array<Real, 3> const* t, typename Controls::Type* results)
+        {
+            switch (mDegree[1])
+            {
+            case 1:
+                return EvaluateBatch<D0, 1>(order, numPoints, t, results);
+            case 2:
+                return EvaluateBatch<D0, 2>(order, numPoints, t, results);
+            case 3:
+                return EvaluateBatch<D0, 3>(order, numPoints, t, results);
+            default:
+                return false;
+            }
+        }
+
+        template <int D0, int D1>
+        bool EvaluateBatch(std::array<int, 3> const& order, size_t numPoints,
+            std::array<Real, 3> const* t, typename Controls::Type* results)
+        {
+            switch (mDegree[2])
+            {
+            case 1:
+                EvaluateBatch<D0, D1, 1>(order, numPoints, t, results);
+                return true;
+            case 2:
+                EvaluateBatch<D0, D1, 2>(order, numPoints, t, results);
+                return true;
+            case 3:
+                EvaluateBatch<D0, D1, 3>(order, numPoints, t, results);
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        template <int D0, int D1, int D2>
+        void EvaluateBatch(std::array<int, 3> const& order, size_t numPoints,
+            std::array<Real, 3> const* t, typename Controls::Type* results)
+        {
+            std::array<std::array<Real, D0 + 1>, D0 + 1> h0;
+            std::array<std::array<Real, D1 + 1>, D1 + 1> h1;
+            std::array<std::array<Real, D2 + 1>, D2 + 1> h2;
+            this->template GetHornerCoefficients<D0>(mBlender[0], mDCoefficient[0], mLMax[0], order[0], h0);
+            this->template GetHornerCoefficients<D1>(mBlender[1], mDCoefficient[1], mLMax[1], order[1], h1);
+            this->template GetHornerCoefficients<D2>(mBlender[2], mDCoefficient[2], mLMax[2], order[2], h2);
+            Real adjust(1);
+            for (int dim = 0; dim < 3; ++dim)
+            {
+                adjust *= mPowerDSDT[dim][order[dim]];
+            }
+
+            for (size_t first = 0; first < numPoints; first += BATCH_SIZE)
+            {
+                int const n = static_cast<int>(std::min(numPoints - first,
+                    static_cast<size_t>(BATCH_SIZE)));
+                std::array<IntBlock, 3> i{};
+                std::array<RealBlock, 3> u{};
+                for (int q = 0; q < n; ++q)
+                {
+                    for (int dim = 0; dim < 3; ++dim)
+                    {
+                        this->GetKey(t[first + q][dim], mTMin[dim], mTMax[dim], mPowerDSDT[dim][1],
+                            mNumControls[dim], mDegree[dim], i[dim][q], u[dim][q]);
+                    }
+                }
+
+                std::array<RealBlock, D0 + 1> phi0;
+                std::array<RealBlock, D1 + 1> phi1;
+                std::array<RealBlock, D2 + 1> phi2;
+                this->template ComputeBasis<D0>(h0, u[0], phi0);
+                this->template ComputeBasis<D1>(h1, u[1], phi1);
+                this->template ComputeBasis<D2>(h2, u[2], phi2);
+
+                for (int q = 0; q < n; ++q)
+                {
+                    auto result = mCTZero;
+                    for (int j2 = 0; j2 <= D2; ++j2)
+                    {
+                        Real phi2q = phi2[j2][q];
+                        for (int j1 = 0; j1 <= D1; ++j1)
+                        {
+                            Real phi12 = phi1[j1][q] * phi2q;
+                            for (int j0 = 0; j0 <= D0; ++j0)
+                            {
+                                Real phi012 = phi0[j0][q] * phi12;
+                                result = result + (*mControls)(i[0][q] + j0, i[1][q] + j1, i[2][q] + j2) * phi012;
+                            }
+                        }
+                    }
+                    results[first + q] = result * adjust;
+                }
+            }
+        }
+
         void ComputeTensor(int r0, int r1, int r2, int c0, int c1, int c2, int index)
         {
             auto element = mCTZero;
@@ -0,0 +1,92 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Support for the batch evaluation of the interpolators of uniformly spaced
+// samples, such as IntpAkimaUniform3 and IntpTricubic3. The query points
+// are sorted by the cells that contain them, so consecutive evaluations use
+// the same or nearby samples (and the same cell polynomial when there is
+// one). The sorted points are then partitioned into blocks of consecutive
+// points that are evaluated by the threads.
+
+namespace gte
+{
+    class IntpBatch
+    {
+    public:
+        // The number of consecutive sorted points fetched by a thread.
+        enum { BLOCK_SIZE = 1024 };
+
+        // Compute the pairs (cell(i), i) for 0 <= i < numPoints sorted by
+        // cell, where cell(i) < numCells is the index of the cell containing
+        // point i. The pairs are sorted by counting when the number of cells
+        // is not much larger than the number of points and by std::sort
+        // otherwise. The points of a cell are in increasing order.
+        template <typename CellFunction>
+        static void SortByCell(size_t numPoints, size_t numCells, CellFunction const& cell,
+            std::vector<std::pair<size_t, size_t>>& sorted)
+        {
+            sorted.resize(numPoints);
+            if (numCells <= 4 * numPoints)
+            {
+                std::vector<size_t> cells(numPoints);
+                std::vector<size_t> offsets(numCells + 1, 0);
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    cells[i] = static_cast<size_t>(cell(i));
+                    ++offsets[cells[i] + 1];
+                }
+                for (size_t c = 0; c < numCells; ++c)
+                {
+                    offsets[c + 1] += offsets[c];
+                }
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    sorted[offsets[cells[i]]++] = std::make_pair(cells[i], i);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    sorted[i] = std::make_pair(static_cast<size_t>(cell(i)), i);
+                }
+                std::sort(sorted.begin(), sorted.end());
+            }
+        }
+
+        // Execute function(first,last) for the subranges [first,last) of
+        // [0,numItems), where numThreads threads fetch subranges of
+        // BLOCK_SIZE items in order. The threads are tasks of the scheduler
+        // when it is not null.
+        template <typename Function>
+        static void Execute(size_t numThreads, TaskScheduler* scheduler, size_t numItems,
+            Function const& function)
+        {
+            size_t const numBlocks = (numItems + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            numThreads = std::min(numThreads, numBlocks);
+            if (numThreads <= 1)
+            {
+                function(static_cast<size_t>(0), numItems);
+                return;
+            }
+
+            TaskScheduler::ParallelForDynamic(scheduler, numBlocks, numThreads,
+                [&function, numItems](size_t block)
+                {
+                    size_t const first = block * BLOCK_SIZE;
+                    function(first, std::min(first + BLOCK_SIZE, numItems));
+                });
+        }
+    };
+}
@@ -0,0 +1,491 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/IntpBatch.h>
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Radial basis function interpolation with the compactly supported Wendland
+// function
+//   phi(r) = (1 - r/R)^4 * (4*r/R + 1) for 0 <= r < R, phi(r) = 0 for r >= R
+// of support radius R. An interpolator with a single radius is
+//   s(P) = sum_{i} a[i] * phi(|P - P[i]|)
+// where the coefficients are the solution to (M + lambda*I)*a = f with
+// M[i][j] = phi(|P[i] - P[j]|), f[i] the data value at P[i] and lambda >= 0
+// the smoothing parameter (0 for interpolation). The function phi is
+// positive definite in dimensions N <= 3, so the matrix is symmetric and
+// positive definite. It is sparse, with a row of nonzero entries for the
+// points within distance R of P[i], and it is solved by the conjugate
+// gradient method. The points are binned in a grid of cells of size R, so
+// the construction costs O(n*k) per iteration and O(n*k) memory, and an
+// evaluation costs O(k), where k is the average number of points within
+// distance R of a point. This is the scalable alternative to
+// IntpThinPlateSpline2 and IntpThinPlateSpline3, whose dense systems cost
+// O(n^3) time and O(n^2) memory.
+//
+// A single radius is a poor compromise: a small radius leaves the
+// interpolator near 0 between the points, and a large one makes k and the
+// condition number of the matrix large. The interpolator is therefore the
+// sum of the levels of the multilevel scheme of
+//   M.S. Floater and A. Iske, Multistep scattered data interpolation using
+//   compactly supported radial basis functions, Journal of Computational
+//   and Applied Mathematics 73 (1996), 65-78
+// Level l of L, 0 <= l < L, has radius R_l = R * 2^(L-1-l) and interpolates
+// the residual of the data after the levels 0 through l-1. The finest level
+// L-1 uses all the points and the radius R. The coarser levels use subsets
+// with one point per cell of size R_l/2, so their k is bounded by the area
+// or volume of the ball of radius 2 cells (about 13 in 2D and 34 in 3D) and
+// their systems are well conditioned. Choose R so that the points have a few
+// neighbors within distance R and L so that R_0 is of the order of the
+// size of the data. The interpolator is 0 farther than R_0 from the data;
+// subtract the mean of the data first when that matters.
+//
+// H. Wendland, Piecewise polynomial, positive definite and compactly
+// supported radial functions of minimal degree, Advances in Computational
+// Mathematics 4 (1995), 389-396.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class IntpCompactRBF
+    {
+    public:
+        // Construction. The data are (points[i],F[i]) for 0 <= i < numPoints.
+        // The radius must be positive, the number of levels must be positive
+        // and the smoothing parameter, used by the finest level, must be
+        // nonnegative. The conjugate gradient iterations of a level stop
+        // when the norm of the residual is at most tolerance times the norm
+        // of the right-hand side or after maxIterations iterations.
+        IntpCompactRBF(int numPoints, Vector<N, Real> const* points, Real const* F,
+            Real radius, int numLevels = 1, Real smooth = (Real)0,
+            unsigned int maxIterations = 1024, Real tolerance = (Real)1e-08)
+            :
+            mNumPoints(numPoints),
+            mRadius(radius),
+            mSmooth(smooth),
+            mLevels(numLevels > 0 ? numLevels : 0),
+            mInitialized(false)
+        {
+            static_assert(1 <= N && N <= 3, "Invalid dimension.");
+            LogAssert(numPoints > 0 && points != nullptr && F != nullptr &&
+                radius > (Real)0 && numLevels > 0 && smooth >= (Real)0,
+                "Invalid input.");
+
+            std::vector<Real> residual(F, F + numPoints);
+            std::vector<Vector<N, Real>> subsetPoints;
+            std::vector<Real> subsetValues;
+            mInitialized = true;
+            for (int l = 0; l < numLevels; ++l)
+            {
+                Level& level = mLevels[l];
+                Real levelRadius = std::ldexp(radius, numLevels - 1 - l);
+                if (l + 1 < numLevels)
+                {
+                    // Keep the first point in each cell of size R_l/2.
+                    Grid grid;
+                    std::vector<std::pair<size_t, size_t>> sorted;
+                    grid.Create(numPoints, points, levelRadius * (Real)0.5, sorted);
+                    subsetPoints.clear();
+                    subsetValues.clear();
+                    for (size_t i = 0; i < sorted.size(); ++i)
+                    {
+                        if (i == 0 || sorted[i].first != sorted[i - 1].first)
+                        {
+                            subsetPoints.push_back(points[sorted[i].second]);
+                            subsetValues.push_back(residual[sorted[i].second]);
+                        }
+                    }
+                    level.Create(static_cast<int>(subsetPoints.size()), subsetPoints.data(),
+                        subsetValues.data(), levelRadius, (Real)0, maxIterations, tolerance);
+                }
+                else
+                {
+                    level.Create(numPoints, points, residual.data(), radius, smooth,
+                        maxIterations, tolerance);
+                }
+                mInitialized = mInitialized && (level.GetNumIterations() <= maxIterations);
+
+                if (l + 1 < numLevels)
+                {
+                    for (int i = 0; i < numPoints; ++i)
+                    {
+                        residual[i] -= level(points[i]);
+                    }
+                }
+            }
+        }
+
+        // Member access.
+        inline int GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline Real GetRadius() const
+        {
+            return mRadius;
+        }
+
+        inline Real GetSmooth() const
+        {
+            return mSmooth;
+        }
+
+        inline int GetNumLevels() const
+        {
+            return static_cast<int>(mLevels.size());
+        }
+
+        // The number of points and the number of conjugate gradient
+        // iterations of level l. The number of iterations is
+        // maxIterations + 1 when the iterations did not converge, in which
+        // case IsInitialized() returns 'false' and the level uses the last
+        // iterate.
+        inline int GetNumPoints(int l) const
+        {
+            return mLevels[l].GetNumPoints();
+        }
+
+        inline unsigned int GetNumIterations(int l) const
+        {
+            return mLevels[l].GetNumIterations();
+        }
+
+        inline bool IsInitialized() const
+        {
+            return mInitialized;
+        }
+
+        // Evaluate the interpolator.
+        Real operator()(Vector<N, Real> const& P) const
+        {
+            Real result = (Real)0;
+            for (auto const& level : mLevels)
+            {
+                result += level(P);
+            }
+            return result;
+        }
+
+        // Batch evaluation, F[q] = operator()(P[q]) for 0 <= q < numQueries,
+        // with the queries partitioned among numThreads threads, which are
+        // tasks of the scheduler when it is not null.
+        void operator()(int numQueries, Vector<N, Real> const* P, Real* F,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
+        {
+            IntpBatch::Execute(numThreads, scheduler, static_cast<size_t>(numQueries),
+                [this, P, F](size_t first, size_t last)
+                {
+                    for (size_t q = first; q < last; ++q)
+                    {
+                        F[q] = operator()(P[q]);
+                    }
+                });
+        }
+
+    private:
+        // A grid of cubic cells whose origin is the minimum of a set of
+        // points.
+        class Grid
+        {
+        public:
+            // Compute the grid for the points and the pairs (cell(i),i)
+            // sorted by cell, with the points of a cell in increasing order.
+            void Create(int numPoints, Vector<N, Real> const* points, Real cellSize,
+                std::vector<std::pair<size_t, size_t>>& sorted)
+            {
+                mInvCellSize = (Real)1 / cellSize;
+                mNumCells = { 1, 1, 1 };
+                mMin = points[0];
+                Vector<N, Real> max = points[0];
+                for (int i = 1; i < numPoints; ++i)
+                {
+                    for (int d = 0; d < N; ++d)
+                    {
+                        mMin[d] = std::min(mMin[d], points[i][d]);
+                        max[d] = std::max(max[d], points[i][d]);
+                    }
+                }
+
+                size_t numCells = 1;
+                for (int d = 0; d < N; ++d)
+                {
+                    Real extent = (max[d] - mMin[d]) * mInvCellSize;
+                    LogAssert(extent < (Real)(1 << 20), "Radius too small for the point extent.");
+                    mNumCells[d] = static_cast<int64_t>(extent) + 1;
+                    numCells *= static_cast<size_t>(mNumCells[d]);
+                }
+
+                IntpBatch::SortByCell(static_cast<size_t>(numPoints), numCells,
+                    [this, points](size_t i) { return GetCell(points[i]); }, sorted);
+            }
+
+            size_t GetCell(Vector<N, Real> const& P) const
+            {
+                size_t cell = 0;
+                for (int d = N - 1; d >= 0; --d)
+                {
+                    int64_t c = static_cast<int64_t>((P[d] - mMin[d]) * mInvCellSize);
+                    c = std::min(c, mNumCells[d] - 1);
+                    cell = cell * static_cast<size_t>(mNumCells[d]) + static_cast<size_t>(c);
+                }
+                return cell;
+            }
+
+            inline size_t GetCell(int64_t c0, int64_t c1, int64_t c2) const
+            {
+                return static_cast<size_t>(c0) + static_cast<size_t>(mNumCells[0]) *
+                    (static_cast<size_t>(c1) + static_cast<size_t>(mNumCells[1]) * static_cast<size_t>(c2));
+            }
+
+            // The range of cells within distance of one cell size of the
+            // cell containing P. The function returns 'false' when the range
+            // is empty. The cell coordinates are clamped before conversion
+            // to integers so that points far from the grid are handled
+            // correctly.
+            bool GetNeighborCells(Vector<N, Real> const& P, std::array<int64_t, 3>& cmin,
+                std::array<int64_t, 3>& cmax) const
+            {
+                cmin = { 0, 0, 0 };
+                cmax = { 0, 0, 0 };
+                for (int d = 0; d < N; ++d)
+                {
+                    Real maxCell = static_cast<Real>(mNumCells[d]);
+                    Real u = (P[d] - mMin[d]) * mInvCellSize;
+                    u = std::min(std::max(u, (Real)-2), maxCell + (Real)1);
+                    int64_t c = static_cast<int64_t>(std::floor(u));
+                    cmin[d] = std::max(c - 1, static_cast<int64_t>(0));
+                    cmax[d] = std::min(c + 1, mNumCells[d] - 1);
+                    if (cmin[d] > cmax[d])
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            Vector<N, Real> mMin;
+            Real mInvCellSize;
+            std::array<int64_t, 3> mNumCells;  // 1 for unused dimensions
+        };
+
+        // The interpolator with a single radius.
+        class Level
+        {
+        public:
+            void Create(int numPoints, Vector<N, Real> const* points, Real const* F,
+                Real radius, Real smooth, unsigned int maxIterations, Real tolerance)
+            {
+                mRadius = radius;
+                mInvRadius = (Real)1 / radius;
+
+                // Store the points sorted by cell.
+                std::vector<std::pair<size_t, size_t>> sorted;
+                mGrid.Create(numPoints, points, radius, sorted);
+                mPoints.resize(numPoints);
+                std::vector<Real> B(numPoints);
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    mPoints[i] = points[sorted[i].second];
+                    B[i] = F[sorted[i].second];
+                    if (i == 0 || sorted[i].first != sorted[i - 1].first)
+                    {
+                        mCellKeys.push_back(sorted[i].first);
+                        mCellStart.push_back(i);
+                    }
+                }
+                mCellStart.push_back(numPoints);
+
+                // Compute the sparse matrix M + lambda*I, storing the rows
+                // in compressed form.
+                std::vector<size_t> rowStart(static_cast<size_t>(numPoints) + 1);
+                std::vector<int> columns;
+                std::vector<Real> values;
+                rowStart[0] = 0;
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    ForEachNeighbor(mPoints[i], [i, smooth, &columns, &values](int j, Real phi)
+                    {
+                        columns.push_back(j);
+                        values.push_back(i == j ? phi + smooth : phi);
+                    });
+                    rowStart[static_cast<size_t>(i) + 1] = columns.size();
+                }
+
+                mCoefficients.resize(numPoints);
+                mNumIterations = SolveCG(rowStart, columns, values, B, maxIterations, tolerance);
+            }
+
+            inline int GetNumPoints() const
+            {
+                return static_cast<int>(mPoints.size());
+            }
+
+            inline unsigned int GetNumIterations() const
+            {
+                return mNumIterations;
+            }
+
+            Real operator()(Vector<N, Real> const& P) const
+            {
+                Real result = (Real)0;
+                ForEachNeighbor(P, [this, &result](int j, Real phi)
+                {
+                    result += mCoefficients[j] * phi;
+                });
+                return result;
+            }
+
+        private:
+            static Real Kernel(Real r)
+            {
+                Real s = (Real)1 - r;
+                Real s2 = s * s;
+                return s2 * s2 * ((Real)4 * r + (Real)1);
+            }
+
+            // Call visit(j,phi) for the points j within distance R of P,
+            // where phi is the kernel value for the distance.
+            template <typename Visit>
+            void ForEachNeighbor(Vector<N, Real> const& P, Visit const& visit) const
+            {
+                std::array<int64_t, 3> cmin, cmax;
+                if (!mGrid.GetNeighborCells(P, cmin, cmax))
+                {
+                    return;
+                }
+
+                Real const rsqr = mRadius * mRadius;
+                for (int64_t c2 = cmin[2]; c2 <= cmax[2]; ++c2)
+                {
+                    for (int64_t c1 = cmin[1]; c1 <= cmax[1]; ++c1)
+                    {
+                        for (int64_t c0 = cmin[0]; c0 <= cmax[0]; ++c0)
+                        {
+                            size_t cell = mGrid.GetCell(c0, c1, c2);
+                            auto iter = std::lower_bound(mCellKeys.begin(), mCellKeys.end(), cell);
+                            if (iter == mCellKeys.end() || *iter != cell)
+                            {
+                                continue;
+                            }
+
+                            size_t k = static_cast<size_t>(iter - mCellKeys.begin());
+                            for (int j = mCellStart[k]; j < mCellStart[k + 1]; ++j)
+                            {
+                                Real sqrLength = (Real)0;
+                                for (int d = 0; d < N; ++d)
+                                {
+                                    Real diff = P[d] - mPoints[j][d];
+                                    sqrLength += diff * diff;
+                                }
+                                if (sqrLength < rsqr)
+                                {
+                                    visit(j, Kernel(std::sqrt(sqrLength) * mInvRadius));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // The conjugate gradient method of LinearSystem::SolveSymmetricCG
+            // for the compressed rows. The return value is maxIterations + 1
+            // when the iterations do not converge.
+            unsigned int SolveCG(std::vector<size_t> const& rowStart,
+                std::vector<int> const& columns, std::vector<Real> const& values,
+                std::vector<Real> const& B, unsigned int maxIterations, Real tolerance)
+            {
+                size_t const n = B.size();
+                std::vector<Real> R(B), P(B), W(n);
+                std::vector<Real>& X = mCoefficients;
+                std::fill(X.begin(), X.end(), (Real)0);
+
+                auto Dot = [n](std::vector<Real> const& U, std::vector<Real> const& V)
+                {
+                    Real dot = (Real)0;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        dot += U[i] * V[i];
+                    }
+                    return dot;
+                };
+
+                Real const root1 = std::sqrt(Dot(B, B));
+                Real rho1 = Dot(R, R);
+                if (rho1 == (Real)0)
+                {
+                    return 0;
+                }
+
+                Real rho0 = rho1;
+                unsigned int iteration;
+                for (iteration = 1; iteration <= maxIterations; ++iteration)
+                {
+                    if (iteration > 1)
+                    {
+                        Real beta = rho1 / rho0;
+                        for (size_t i = 0; i < n; ++i)
+                        {
+                            P[i] = R[i] + beta * P[i];
+                        }
+                    }
+
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Real sum = (Real)0;
+                        for (size_t k = rowStart[i]; k < rowStart[i + 1]; ++k)
+                        {
+                            sum += values[k] * P[columns[k]];
+                        }
+                        W[i] = sum;
+                    }
+
+                    Real alpha = rho1 / Dot(P, W);
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        X[i] += alpha * P[i];
+                        R[i] -= alpha * W[i];
+                    }
+                    rho0 = rho1;
+                    rho1 = Dot(R, R);
+                    if (std::sqrt(rho1) <= tolerance * root1)
+                    {
+                        break;
+                    }
+                }
+                return iteration;
+            }
+
+            Real mRadius, mInvRadius;
+            Grid mGrid;
+
+            // The points sorted by cell. The nonempty cells are stored by
+            // increasing key, and the points of cell mCellKeys[k] are
+            // mCellStart[k] <= j < mCellStart[k+1].
+            std::vector<Vector<N, Real>> mPoints;
+            std::vector<size_t> mCellKeys;
+            std::vector<int> mCellStart;
+
+            // The RBF coefficients of the sorted points.
+            std::vector<Real> mCoefficients;
+            unsigned int mNumIterations;
+        };
+
+        int mNumPoints;
+        Real mRadius, mSmooth;
+        std::vector<Level> mLevels;
+        bool mInitialized;
+    };
+}
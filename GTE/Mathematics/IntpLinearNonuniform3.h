@@ -3,12 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 // Linear interpolation of a network of triangles whose vertices are of the
 // form (x,y,z,f(x,y,z)).  The function samples are F[i] and represent
@@ -19,6 +23,11 @@
 //   int GetContainingTetrahedron(Vector3<Real> const&) const;
 //   bool GetIndices(int, std::array<int, 4>&) const;
 //   bool GetBarycentrics(int, Vector3<Real> const&, Real[4]) const;
+// The batch interpolation additionally requires
+//   void GetContainingTetrahedra(int, Vector3<Real> const*, int*,
+//       size_t) const;
+// where a point outside the tetrahedralization has tetrahedron index -1,
+// which is the case for Delaunay3Mesh.
 
 namespace gte
 {
@@ -30,11 +39,28 @@ namespace gte
         IntpLinearNonuniform3(TetrahedronMesh const& mesh, Real const* F)
             :
             mMesh(&mesh),
-            mF(F)
+            mF(F),
+            mScheduler(nullptr)
         {
             LogAssert(mF != nullptr, "Invalid input.");
         }
 
+        // Execute the batch interpolation as tasks of the scheduler, which
+        // can be shared with other computations, instead of creating threads
+        // for each call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again. The mesh
+        // locates the points with its own scheduler; see, for example,
+        // Delaunay3Mesh::SetScheduler(*).
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // Linear interpolation.  The return value is 'true' if and only if
         // the input point is in the convex hull of the input vertices, in
         // which case the interpolation is valid.
@@ -46,7 +72,44 @@ namespace gte
                 // The point is outside the tetrahedralization.
                 return false;
             }
+            return Interpolate(t, P, F);
+        }
 
+        // Batch linear interpolation. On return, valid[i] is 'true' if and
+        // only if P[i] is in the convex hull of the input vertices, in which
+        // case F[i] is the interpolated value; otherwise, F[i] is unchanged.
+        // The return value is the number of valid interpolations. The
+        // containing tetrahedra are located by a batch query that sorts the
+        // points spatially, and the points are located and interpolated in
+        // numThreads threads. Set numThreads to 0 or 1 to execute in the
+        // calling thread.
+        size_t operator()(size_t numPoints, Vector3<Real> const* P, Real* F, bool* valid,
+            size_t numThreads = 1) const
+        {
+            LogAssert(numPoints == 0 || (P != nullptr && F != nullptr && valid != nullptr),
+                "Invalid input.");
+
+            std::vector<int> tetrahedra(numPoints);
+            mMesh->GetContainingTetrahedra(static_cast<int>(numPoints), P, tetrahedra.data(),
+                numThreads);
+
+            size_t const numChunks = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numPoints, numChunks, P, F, valid, &tetrahedra](size_t c)
+                {
+                    size_t const imin = numPoints * c / numChunks;
+                    size_t const imax = numPoints * (c + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        valid[i] = (tetrahedra[i] != -1 && Interpolate(tetrahedra[i], P[i], F[i]));
+                    }
+                });
+            return static_cast<size_t>(std::count(valid, valid + numPoints, true));
+        }
+
+    private:
+        bool Interpolate(int t, Vector3<Real> const& P, Real& F) const
+        {
             // Get the barycentric coordinates of P with respect to the tetrahedron,
             // P = b0*V0 + b1*V1 + b2*V2 + b3*V3, where b0 + b1 + b2 + b3 = 1.
             std::array<Real, 4> bary;
@@ -58,15 +121,15 @@ namespace gte
             }
 
             // The result is a barycentric combination of function values.
-            std::array<int, 4> indices;
+            std::array<int, 4> indices = { 0, 0, 0, 0 };
             mMesh->GetIndices(t, indices);
             F = bary[0] * mF[indices[0]] + bary[1] * mF[indices[1]] +
-                bary[2] * mF[indices[2]] + bary[3] * mF[indices[4]];
+                bary[2] * mF[indices[2]] + bary[3] * mF[indices[3]];
             return true;
         }
 
-    private:
         TetrahedronMesh const* mMesh;
         Real const* mF;
+        TaskScheduler* mScheduler;
     };
 }
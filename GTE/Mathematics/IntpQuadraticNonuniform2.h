@@ -3,13 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.11.16
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Delaunay2.h>
 #include <Mathematics/ContScribeCircle2.h>
 #include <Mathematics/DistPointAlignedBox.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 // Quadratic interpolation of a network of triangles whose vertices are of
 // the form (x,y,f(x,y)).  This code is an implementation of the algorithm
@@ -31,6 +35,13 @@
 //   bool GetBarycentrics(int, Vector2<Real> const&,
 //      std::array<Real, 3>&) const;
 //   int GetContainingTriangle(Vector2<Real> const&) const;
+//   int GetInvalidIndex() const;
+// The batch interpolation additionally requires
+//   void GetContainingTriangles(size_t, Vector2<Real> const*, size_t*,
+//       size_t) const;
+// where a point outside the triangulation has triangle index
+// std::numeric_limits<size_t>::max(), which is the case for
+// PlanarMesh<Real,*,*>.
 
 namespace gte
 {
@@ -53,7 +64,8 @@ namespace gte
             mMesh(&mesh),
             mF(F),
             mFX(nullptr),
-            mFY(nullptr)
+            mFY(nullptr),
+            mScheduler(nullptr)
         {
             EstimateDerivatives(spatialDelta);
             ProcessTriangles();
@@ -64,11 +76,28 @@ namespace gte
             mMesh(&mesh),
             mF(F),
             mFX(FX),
-            mFY(FY)
+            mFY(FY),
+            mScheduler(nullptr)
         {
             ProcessTriangles();
         }
 
+        // Interpolate the batches of points as tasks of the scheduler, which
+        // can be shared with other computations, instead of creating threads
+        // for each call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again. The mesh
+        // locates the points with its own scheduler; for example, see
+        // PlanarMesh::SetScheduler(*).
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // Quadratic interpolation.  The return value is 'true' if and only if
         // the input point is in the convex hull of the input vertices, in
         // which case the interpolation is valid.
@@ -80,7 +109,48 @@ namespace gte
                 // The point is outside the triangulation.
                 return false;
             }
+            Interpolate(static_cast<size_t>(t), P, F, FX, FY);
+            return true;
+        }
+
+        // Batch quadratic interpolation. On return, valid[i] is 'true' if
+        // and only if P[i] is inside the triangulation, in which case F[i],
+        // FX[i] and FY[i] are the interpolated values; otherwise, they are
+        // unchanged. The return value is the number of valid
+        // interpolations. The containing triangles are located by a
+        // batch query, and the points are located and interpolated in
+        // numThreads threads. Set numThreads to 0 or 1 to execute in the
+        // calling thread.
+        size_t operator()(size_t numPoints, Vector2<Real> const* P, Real* F, Real* FX, Real* FY,
+            bool* valid, size_t numThreads = 1) const
+        {
+            LogAssert(numPoints == 0 || (P != nullptr && F != nullptr && FX != nullptr &&
+                FY != nullptr && valid != nullptr), "Invalid input.");
+
+            std::vector<size_t> triangles(numPoints);
+            mMesh->GetContainingTriangles(numPoints, P, triangles.data(), numThreads);
+
+            size_t const numChunks = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numPoints, numChunks, P, F, FX, FY, valid, &triangles](size_t c)
+                {
+                    size_t const imin = numPoints * c / numChunks;
+                    size_t const imax = numPoints * (c + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        valid[i] = (triangles[i] != std::numeric_limits<size_t>::max());
+                        if (valid[i])
+                        {
+                            Interpolate(triangles[i], P[i], F[i], FX[i], FY[i]);
+                        }
+                    }
+                });
+            return static_cast<size_t>(std::count(valid, valid + numPoints, true));
+        }
 
+    private:
+        void Interpolate(size_t t, Vector2<Real> const& P, Real& F, Real& FX, Real& FY) const
+        {
             // Get the vertices of the triangle.
             std::array<Vector2<Real>, 3> V;
             mMesh->GetVertices(t, V);
@@ -192,10 +262,8 @@ namespace gte
 
             FX = inv * (m11 * duw - m10 * dvw);
             FY = inv * (m00 * dvw - m01 * duw);
-            return true;
         }
 
-    private:
         void EstimateDerivatives(Real spatialDelta)
         {
             auto numVertices = mMesh->GetNumVertices();
@@ -464,5 +532,6 @@ namespace gte
         std::vector<Real> mFXStorage;
         std::vector<Real> mFYStorage;
         std::vector<TriangleData> mTData;
+        TaskScheduler* mScheduler;
     };
 }
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/GMatrix.h>
+#include <Mathematics/IntpBatch.h>
 #include <array>
 
 // WARNING.  The implementation allows you to transform the inputs (x,y,z) to
@@ -18,6 +19,10 @@
 // rotations of (x,y,z) but not to scaling.  The following document is about
 // thin plate splines.
 //   https://www.geometrictools.com/Documentation/ThinPlateSplines.pdf
+//
+// The construction solves a dense linear system, which costs O(n^3) time and
+// O(n^2) memory for n points, so it is practical for a few thousand points.
+// IntpCompactRBF is the scalable alternative for large data sets.
 
 namespace gte
 {
@@ -226,6 +231,23 @@ namespace gte
             return std::numeric_limits<Real>::max();
         }
 
+        // Batch evaluation, F[q] = operator()(X[q], Y[q], Z[q]) for
+        // 0 <= q < numQueries, with the queries partitioned among numThreads
+        // threads, which are tasks of the scheduler when it is not null. Each
+        // evaluation costs O(n).
+        void operator()(int numQueries, Real const* X, Real const* Y, Real const* Z, Real* F,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
+        {
+            IntpBatch::Execute(numThreads, scheduler, static_cast<size_t>(numQueries),
+                [this, X, Y, Z, F](size_t first, size_t last)
+                {
+                    for (size_t q = first; q < last; ++q)
+                    {
+                        F[q] = operator()(X[q], Y[q], Z[q]);
+                    }
+                });
+        }
+
         // Compute the functional value a^T*M*a when lambda is zero or
         // lambda*w^T*(M+lambda*I)*w when lambda is positive.  See the thin
         // plate splines PDF for a description of these quantities.
@@ -3,12 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <Mathematics/IntpBatch.h>
 #include <Mathematics/Logger.h>
+#include <algorithm>
 #include <array>
+#include <vector>
 
 // The interpolator is for uniformly spaced(x,y z)-values.  The input samples
 // must be stored in lexicographical order to represent f(x,y,z); that is,
@@ -18,6 +21,10 @@
 // to 'true', giving you the Catmull-Rom blending matrix.  If a smooth
 // interpolation is desired, set catmullRom to 'false' to obtain B-spline
 // blending.
+//
+// The batch evaluation sorts the query points by the sample whose 4x4x4
+// neighborhood is used and partitions the sorted points among threads; see
+// IntpBatch.h.
 
 namespace gte
 {
@@ -517,7 +524,45 @@ namespace gte
             return result;
         }
 
+        // Batch evaluation of the function at points[i] = (x,y,z), storing
+        // the result in values[i], for 0 <= i < numPoints. The results are
+        // those of the single-point evaluation. The code runs single-threaded
+        // when numThreads <= 1. Otherwise, the threads are tasks of the
+        // scheduler when it is not null.
+        void operator()(size_t numPoints, std::array<Real, 3> const* points,
+            Real* values, size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
+        {
+            std::vector<std::pair<size_t, size_t>> sorted;
+            size_t const numCells = static_cast<size_t>(mQuantity);
+            IntpBatch::SortByCell(numPoints, numCells,
+                [this, points](size_t i)
+                {
+                    return GetCell(points[i][0], points[i][1], points[i][2]);
+                }, sorted);
+
+            IntpBatch::Execute(numThreads, scheduler, numPoints,
+                [this, points, values, &sorted](size_t first, size_t last)
+                {
+                    for (size_t j = first; j < last; ++j)
+                    {
+                        size_t const i = sorted[j].second;
+                        values[i] = operator()(points[i][0], points[i][1], points[i][2]);
+                    }
+                });
+        }
+
     private:
+        // The index of the sample that is the origin of the cell containing
+        // (x,y,z), clamped to the image as in the evaluations.
+        size_t GetCell(Real x, Real y, Real z) const
+        {
+            int ix = std::min(std::max(static_cast<int>((x - mXMin) * mInvXSpacing), 0), mXBound - 1);
+            int iy = std::min(std::max(static_cast<int>((y - mYMin) * mInvYSpacing), 0), mYBound - 1);
+            int iz = std::min(std::max(static_cast<int>((z - mZMin) * mInvZSpacing), 0), mZBound - 1);
+            return static_cast<size_t>(ix) + static_cast<size_t>(mXBound) *
+                (static_cast<size_t>(iy) + static_cast<size_t>(mYBound) * static_cast<size_t>(iz));
+        }
+
         int mXBound, mYBound, mZBound, mQuantity;
         Real mXMin, mXMax, mXSpacing, mInvXSpacing;
         Real mYMin, mYMax, mYSpacing, mInvYSpacing;
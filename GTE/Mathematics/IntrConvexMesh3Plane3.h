@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.6.2020.09.18
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -12,7 +12,10 @@
 #include "ConvexMesh3.h"
 #include <Mathematics/EdgeKey.h>
 #include <Mathematics/Hyperplane.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/UniqueVerticesSimplices.h>
+#include <algorithm>
+#include <set>
 
 namespace gte
 {
@@ -126,6 +129,110 @@ namespace gte
             ConvexMesh3<Real> negativePolyhedron;
         };
 
+        // The adjacency of a convex polyhedron for repeated queries with
+        // different planes, such as the clipping of a Voronoi cell by the
+        // bisector planes of its neighbors. The polyhedron is referenced,
+        // not copied, so it must exist while the prepared mesh is used. The
+        // adjacent vertices of vertex v are
+        //   vertexAdjacent[vertexOffsets[v]..vertexOffsets[v+1]-1],
+        // the triangles sharing vertex v are
+        //   vertexTriangles[triangleOffsets[v]..triangleOffsets[v+1]-1],
+        // and triangleAdjacent[t][j] is the triangle sharing the edge
+        // <triangles[t][j],triangles[t][(j+1)%3]> with triangle t, or -1
+        // when the edge is not shared.
+        struct PreparedMesh
+        {
+            PreparedMesh(ConvexMesh3<Real> const& inPolyhedron)
+                :
+                polyhedron(inPolyhedron)
+            {
+                size_t const numVertices = polyhedron.vertices.size();
+                size_t const numTriangles = polyhedron.triangles.size();
+
+                // Sort the directed edges <v0,v1> of the triangles by their
+                // undirected keys, so the two triangles sharing an edge are
+                // adjacent in the array.
+                std::vector<std::array<int, 4>> edges(3 * numTriangles);
+                for (size_t t = 0; t < numTriangles; ++t)
+                {
+                    auto const& triangle = polyhedron.triangles[t];
+                    for (int j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                    {
+                        int v0 = triangle[j0], v1 = triangle[j1];
+                        edges[3 * t + j0] = { std::min(v0, v1), std::max(v0, v1),
+                            static_cast<int>(t), j0 };
+                    }
+                }
+                std::sort(edges.begin(), edges.end());
+
+                triangleAdjacent.resize(numTriangles);
+                for (auto& adjacent : triangleAdjacent)
+                {
+                    adjacent = { -1, -1, -1 };
+                }
+                vertexOffsets.assign(numVertices + 1, 0);
+                for (size_t e = 0; e < edges.size(); )
+                {
+                    size_t f = e + 1;
+                    while (f < edges.size() && edges[f][0] == edges[e][0] && edges[f][1] == edges[e][1])
+                    {
+                        ++f;
+                    }
+                    if (f == e + 2)
+                    {
+                        triangleAdjacent[edges[e][2]][edges[e][3]] = edges[e + 1][2];
+                        triangleAdjacent[edges[e + 1][2]][edges[e + 1][3]] = edges[e][2];
+                    }
+                    ++vertexOffsets[static_cast<size_t>(edges[e][0]) + 1];
+                    ++vertexOffsets[static_cast<size_t>(edges[e][1]) + 1];
+                    e = f;
+                }
+
+                triangleOffsets.assign(numVertices + 1, 0);
+                for (auto const& triangle : polyhedron.triangles)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        ++triangleOffsets[static_cast<size_t>(triangle[j]) + 1];
+                    }
+                }
+
+                for (size_t v = 0; v < numVertices; ++v)
+                {
+                    vertexOffsets[v + 1] += vertexOffsets[v];
+                    triangleOffsets[v + 1] += triangleOffsets[v];
+                }
+
+                std::vector<int> vertexNext(vertexOffsets.begin(), vertexOffsets.end() - 1);
+                vertexAdjacent.resize(vertexOffsets.back());
+                for (size_t e = 0; e < edges.size(); ++e)
+                {
+                    if (e == 0 || edges[e][0] != edges[e - 1][0] || edges[e][1] != edges[e - 1][1])
+                    {
+                        int v0 = edges[e][0], v1 = edges[e][1];
+                        vertexAdjacent[vertexNext[v0]++] = v1;
+                        vertexAdjacent[vertexNext[v1]++] = v0;
+                    }
+                }
+
+                std::vector<int> triangleNext(triangleOffsets.begin(), triangleOffsets.end() - 1);
+                vertexTriangles.resize(triangleOffsets.back());
+                for (size_t t = 0; t < numTriangles; ++t)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        vertexTriangles[triangleNext[polyhedron.triangles[t][j]]++] =
+                            static_cast<int>(t);
+                    }
+                }
+            }
+
+            ConvexMesh3<Real> const& polyhedron;
+            std::vector<int> vertexOffsets, vertexAdjacent;
+            std::vector<int> triangleOffsets, vertexTriangles;
+            std::vector<std::array<int, 3>> triangleAdjacent;
+        };
+
         Result operator() (ConvexMesh3<Real> const& polyhedron,
             Plane3<Real> const& plane, int requested)
         {
@@ -202,7 +309,356 @@ namespace gte
             return result;
         }
 
+        // The query for a prepared mesh. The results are the same as those
+        // of the query for prepared.polyhedron, but the vertices are
+        // classified lazily. The configuration is found by walking the
+        // vertex graph from vertex 0 toward the plane, and when the plane
+        // splits the polyhedron, only the triangles that touch the plane
+        // and those of the requested sides are visited, by a flood fill
+        // from the triangles at the end of the walk. The vertices of the
+        // other triangles are never classified.
+        Result operator() (PreparedMesh const& prepared, Plane3<Real> const& plane,
+            int requested)
+        {
+            static_assert(is_arbitrary_precision<Real>::value, "Real must be arbitrary precision.");
+            static_assert(has_division_operator<Real>::value, "Real must support division.");
+
+            CM const& polyhedron = prepared.polyhedron;
+            if (polyhedron.configuration != CM::CFG_POLYHEDRON)
+            {
+                return operator()(polyhedron, plane, requested);
+            }
+
+            Result result;
+            result.requested = requested;
+
+            Classifier classifier(prepared, plane);
+            int const sign0 = classifier.GetSign(0);
+            int positive = (sign0 > 0 ? 0 : -1), negative = (sign0 < 0 ? 0 : -1);
+            int extreme = 0, seedEdge0 = -1, seedEdge1 = -1;
+            if (sign0 >= 0)
+            {
+                int last = -1;
+                extreme = classifier.Walk(0, -1, last);
+                if (classifier.GetSign(extreme) < 0)
+                {
+                    negative = extreme;
+                    seedEdge0 = last;
+                    seedEdge1 = extreme;
+                }
+            }
+            if (sign0 <= 0)
+            {
+                int last = -1;
+                int vertex = classifier.Walk(0, +1, last);
+                if (classifier.GetSign(vertex) > 0)
+                {
+                    positive = vertex;
+                    seedEdge0 = last;
+                    seedEdge1 = vertex;
+                }
+                else
+                {
+                    extreme = vertex;
+                }
+            }
+
+            if (positive == -1 && negative == -1)
+            {
+                // The vertices are all in the plane, which is not possible
+                // for a polyhedron that is not degenerate.
+                return operator()(polyhedron, plane, requested);
+            }
+
+            if (positive == -1 || negative == -1)
+            {
+                // The polyhedron is on one side of the plane. The vertices
+                // in the plane, if any, are those of the extreme face, edge
+                // or vertex that contains the extreme vertex.
+                int const side = (positive == -1 ? -1 : +1);
+                std::vector<int> zeros;
+                if (classifier.GetSign(extreme) == 0)
+                {
+                    classifier.GetPlateau(extreme, zeros);
+                }
+                int const numZero = static_cast<int>(zeros.size());
+                result.configuration = (side > 0 ? CFG_POS_SIDE : CFG_NEG_SIDE) |
+                    (numZero < 3 ? numZero : 4);
+
+                if (side > 0 && (requested & REQ_POLYHEDRON_POS) != 0)
+                {
+                    result.positivePolyhedron = polyhedron;
+                }
+                if (side < 0 && (requested & REQ_POLYHEDRON_NEG) != 0)
+                {
+                    result.negativePolyhedron = polyhedron;
+                }
+
+                if (numZero > 0 && ((requested & REQ_INTR_BOTH) != 0))
+                {
+                    std::vector<int> sign(polyhedron.vertices.size(), side);
+                    for (auto v : zeros)
+                    {
+                        sign[v] = 0;
+                    }
+                    GetIntersection(polyhedron, numZero, sign, result);
+                }
+                return result;
+            }
+
+            result.configuration = CFG_SPLIT;
+            if (requested == REQ_CONFIGURATION_ONLY)
+            {
+                return result;
+            }
+
+            // The walk that found the vertex on the other side of the plane
+            // ended with an edge from a vertex not on that side. When vertex
+            // 0 is in the plane, no edge is needed.
+            int seed = -1;
+            int const v0 = (seedEdge0 >= 0 ? seedEdge0 : 0);
+            for (int k = prepared.triangleOffsets[v0]; k < prepared.triangleOffsets[v0 + 1]; ++k)
+            {
+                auto const& triangle = polyhedron.triangles[prepared.vertexTriangles[k]];
+                if (seedEdge1 < 0 || triangle[0] == seedEdge1 ||
+                    triangle[1] == seedEdge1 || triangle[2] == seedEdge1)
+                {
+                    seed = prepared.vertexTriangles[k];
+                    break;
+                }
+            }
+            LogAssert(seed >= 0, "Unexpected condition.");
+
+            // Flood fill the triangles that touch the plane and those on
+            // the requested sides. The triangles touching the plane are
+            // edge connected, and they separate the triangles strictly on
+            // the positive side from those strictly on the negative side.
+            bool const wantPosMesh = (requested & REQ_POLYHEDRON_POS) != 0;
+            bool const wantNegMesh = (requested & REQ_POLYHEDRON_NEG) != 0;
+            std::vector<char> visited(polyhedron.triangles.size(), 0);
+            std::vector<int> visit;
+            visit.push_back(seed);
+            visited[seed] = 1;
+            for (size_t i = 0; i < visit.size(); ++i)
+            {
+                for (auto t : prepared.triangleAdjacent[visit[i]])
+                {
+                    if (t >= 0 && visited[t] == 0)
+                    {
+                        visited[t] = 1;
+                        auto const& triangle = polyhedron.triangles[t];
+                        int minSign = +1, maxSign = -1;
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            int s = classifier.GetSign(triangle[j]);
+                            minSign = std::min(minSign, s);
+                            maxSign = std::max(maxSign, s);
+                        }
+                        if ((minSign <= 0 && maxSign >= 0) ||
+                            (minSign > 0 && wantPosMesh) || (maxSign < 0 && wantNegMesh))
+                        {
+                            visit.push_back(t);
+                        }
+                    }
+                }
+            }
+
+            // Split the visited triangles using the algorithm for the
+            // entire polyhedron. The visited triangles and their vertices
+            // are stored in the order of their indices, so the output is
+            // the same as that for the entire polyhedron.
+            std::sort(visit.begin(), visit.end());
+            std::vector<int> used;
+            used.reserve(3 * visit.size());
+            for (auto t : visit)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    used.push_back(polyhedron.triangles[t][j]);
+                }
+            }
+            std::sort(used.begin(), used.end());
+            used.erase(std::unique(used.begin(), used.end()), used.end());
+
+            CM band;
+            band.configuration = CM::CFG_POLYHEDRON;
+            band.vertices.resize(used.size());
+            std::vector<Real> dot(used.size());
+            std::vector<int> sign(used.size());
+            for (size_t i = 0; i < used.size(); ++i)
+            {
+                band.vertices[i] = polyhedron.vertices[used[i]];
+                dot[i] = classifier.GetDot(used[i]);
+                sign[i] = classifier.GetSign(used[i]);
+            }
+            band.triangles.resize(visit.size());
+            for (size_t i = 0; i < visit.size(); ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    auto iter = std::lower_bound(used.begin(), used.end(),
+                        polyhedron.triangles[visit[i]][j]);
+                    band.triangles[i][j] = static_cast<int>(iter - used.begin());
+                }
+            }
+
+            SplitPolyhedron(band, dot, sign, result);
+            return result;
+        }
+
+        // Execute the query for a prepared mesh and each of the planes. The
+        // planes are partitioned into chunks that are processed as tasks of
+        // the scheduler when it is not null.
+        void operator() (PreparedMesh const& prepared, size_t numPlanes,
+            Plane3<Real> const* planes, int requested, Result* results,
+            TaskScheduler* scheduler = nullptr)
+        {
+            size_t const numChunks = (scheduler ?
+                std::max(std::min(numPlanes, 4 * scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, &prepared, numPlanes, planes, requested, results, numChunks](size_t chunk)
+                {
+                    size_t const imin = numPlanes * chunk / numChunks;
+                    size_t const imax = numPlanes * (chunk + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        results[i] = operator()(prepared, planes[i], requested);
+                    }
+                });
+        }
+
     private:
+        // The signed distances (Dot(N,X) - c) of the vertices of a prepared
+        // mesh, computed when first needed.
+        class Classifier
+        {
+        public:
+            Classifier(PreparedMesh const& prepared, Plane3<Real> const& plane)
+                :
+                mPrepared(prepared),
+                mPlane(plane),
+                mSlot(prepared.polyhedron.vertices.size(), -1)
+            {
+            }
+
+            Real const& GetDot(int v)
+            {
+                return mDot[GetSlot(v)];
+            }
+
+            int GetSign(int v)
+            {
+                return mSign[GetSlot(v)];
+            }
+
+            // Walk from the start vertex to a vertex whose sign is the
+            // specified one, moving along the edge that decreases (side < 0)
+            // or increases (side > 0) the signed distance the most. If no
+            // such vertex exists, the walk ends at a vertex of minimum or
+            // maximum signed distance. The vertex before the last one of
+            // the walk is returned in 'last', or -1 when the walk ends at
+            // the start vertex.
+            int Walk(int start, int side, int& last)
+            {
+                int current = start;
+                last = -1;
+                while (GetSign(current) != side)
+                {
+                    int next = GetImprovingNeighbor(current, side);
+                    if (next == -1)
+                    {
+                        // The neighbors do not improve the signed distance.
+                        // Because the polyhedron is convex, the vertex is
+                        // extreme unless another vertex with the same
+                        // signed distance has an improving neighbor.
+                        std::vector<int> plateau;
+                        GetPlateau(current, plateau);
+                        for (auto v : plateau)
+                        {
+                            next = GetImprovingNeighbor(v, side);
+                            if (next != -1)
+                            {
+                                current = v;
+                                break;
+                            }
+                        }
+                        if (next == -1)
+                        {
+                            return current;
+                        }
+                    }
+                    last = current;
+                    current = next;
+                }
+                return current;
+            }
+
+            // Get the vertices that have the same signed distance as the
+            // start vertex and are connected to it by such vertices.
+            void GetPlateau(int start, std::vector<int>& plateau)
+            {
+                std::set<int> visited;
+                plateau.clear();
+                plateau.push_back(start);
+                visited.insert(start);
+                int const slot = GetSlot(start);
+                for (size_t i = 0; i < plateau.size(); ++i)
+                {
+                    int v = plateau[i];
+                    for (int k = mPrepared.vertexOffsets[v]; k < mPrepared.vertexOffsets[v + 1]; ++k)
+                    {
+                        int a = mPrepared.vertexAdjacent[k];
+                        if (visited.insert(a).second)
+                        {
+                            int slotA = GetSlot(a);
+                            if (mDot[slotA] == mDot[slot])
+                            {
+                                plateau.push_back(a);
+                            }
+                        }
+                    }
+                }
+            }
+
+        private:
+            int GetSlot(int v)
+            {
+                int& slot = mSlot[v];
+                if (slot == -1)
+                {
+                    slot = static_cast<int>(mDot.size());
+                    mDot.push_back(Dot(mPlane.normal, mPrepared.polyhedron.vertices[v]) - mPlane.constant);
+                    Real const& dot = mDot.back();
+                    mSign.push_back(dot > (Real)0 ? +1 : (dot < (Real)0 ? -1 : 0));
+                }
+                return slot;
+            }
+
+            int GetImprovingNeighbor(int v, int side)
+            {
+                int best = v;
+                for (int k = mPrepared.vertexOffsets[v]; k < mPrepared.vertexOffsets[v + 1]; ++k)
+                {
+                    int a = mPrepared.vertexAdjacent[k];
+                    int slotA = GetSlot(a);
+                    int slotBest = GetSlot(best);
+                    if (side > 0 ? mDot[slotA] > mDot[slotBest] : mDot[slotA] < mDot[slotBest])
+                    {
+                        best = a;
+                    }
+                }
+                return (best != v ? best : -1);
+            }
+
+            PreparedMesh const& mPrepared;
+            Plane3<Real> const& mPlane;
+            std::vector<int> mSlot;
+            std::vector<Real> mDot;
+            std::vector<int> mSign;
+        };
+
         static void GetIntersection(CM const& polyhedron, int numZero,
             std::vector<int> const& sign, Result& result)
         {
@@ -342,17 +798,22 @@ namespace gte
                     }
                 }
 
-                // Construct the boundary polygon.
-                std::vector<int> polygonIndices(edgeMap.size(), -1);
+                // Construct the boundary polygon by following the boundary
+                // edges. The face can have vertices that are not on its
+                // boundary, so the successor array is indexed by all the
+                // face vertices.
+                std::vector<int> polygonIndices(outVertices.size(), -1);
                 for (auto const& element : edgeMap)
                 {
                     polygonIndices[element.second[0]] = element.second[1];
                 }
 
                 result.intersectionPolygon.resize(edgeMap.size());
+                int current = edgeMap.begin()->second[0];
                 for (size_t i = 0; i < result.intersectionPolygon.size(); ++i)
                 {
-                    result.intersectionPolygon[i] = outVertices[polygonIndices[i]];
+                    result.intersectionPolygon[i] = outVertices[current];
+                    current = polygonIndices[current];
                 }
             }
 
@@ -0,0 +1,643 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/AlignedBox.h>
+#include <Mathematics/Hypersphere.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/OrientedBox.h>
+#include <Mathematics/PointCloud.h>
+#include <Mathematics/Ray.h>
+#include <Mathematics/Triangle.h>
+#include <Mathematics/Vector3.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Batch intersection queries of rays with aligned boxes, oriented boxes,
+// spheres and triangles: many rays with one primitive, or one ray with many
+// primitives. The rays and primitives of a batch are stored as structure of
+// arrays using PointCloudView, one view per vector member:
+//   rays: origins and directions
+//   aligned boxes: minima and maxima
+//   oriented boxes: centers, axes[0..2] and extents
+//   spheres: centers and an array of radii
+//   triangles: vertices v0, v1 and v2
+//
+// The Test* functions write intersect[i] = 1 when pair i intersects and 0
+// otherwise. The Find* functions also write the parameters of the
+// intersection, which are those of the single-pair FIQuery results:
+//   boxes, spheres: the ray t-interval [parameter0[i],parameter1[i]] of the
+//     intersection, which is a single point when the values are equal
+//   triangles: the ray parameter and the barycentric coordinates
+//     (1-bary1-bary2,bary1,bary2) of the intersection point
+// The parameters are 0 when there is no intersection. As in the single-pair
+// queries, the sphere queries require unit-length ray directions, and a
+// ray that is parallel to the plane of a triangle does not intersect it.
+//
+// The loops over the pairs have no branches; the conditions are selects of
+// values, so the compiler can vectorize them with 4 or 8 lanes of SSE, AVX
+// or NEON registers (as for PointCloud.h, this requires the vectorizer to be
+// enabled, for example by -O3 for GCC; the square roots of the sphere
+// queries also require -fno-math-errno). The slab computations divide by the
+// direction components rather than multiplying by their reciprocals, so the
+// parameters are those of the Liang-Barsky clipping of the single-pair
+// queries. The single-pair queries decide some comparisons with products
+// instead of quotients, so for rays that graze a primitive the
+// intersection results can differ.
+
+namespace gte
+{
+    template <typename T>
+    class IntrRay3Batch
+    {
+    public:
+        // Many rays with one aligned box.
+        static void TestAlignedBox(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, AlignedBox3<T> const& box,
+            uint8_t* intersect)
+        {
+            ForAlignedBox(origins, directions, box,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindAlignedBox(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, AlignedBox3<T> const& box,
+            uint8_t* intersect, T* parameter0, T* parameter1)
+        {
+            ForAlignedBox(origins, directions, box,
+                [intersect, parameter0, parameter1](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter0, parameter1);
+                });
+        }
+
+        // One ray with many aligned boxes.
+        static void TestAlignedBoxes(Ray3<T> const& ray, PointCloudView<3, T> const& minima,
+            PointCloudView<3, T> const& maxima, uint8_t* intersect)
+        {
+            ForAlignedBoxes(ray, minima, maxima,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindAlignedBoxes(Ray3<T> const& ray, PointCloudView<3, T> const& minima,
+            PointCloudView<3, T> const& maxima, uint8_t* intersect, T* parameter0, T* parameter1)
+        {
+            ForAlignedBoxes(ray, minima, maxima,
+                [intersect, parameter0, parameter1](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter0, parameter1);
+                });
+        }
+
+        // Many rays with one oriented box.
+        static void TestOrientedBox(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, OrientedBox3<T> const& box,
+            uint8_t* intersect)
+        {
+            ForOrientedBox(origins, directions, box,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindOrientedBox(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, OrientedBox3<T> const& box,
+            uint8_t* intersect, T* parameter0, T* parameter1)
+        {
+            ForOrientedBox(origins, directions, box,
+                [intersect, parameter0, parameter1](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter0, parameter1);
+                });
+        }
+
+        // One ray with many oriented boxes.
+        static void TestOrientedBoxes(Ray3<T> const& ray, PointCloudView<3, T> const& centers,
+            std::array<PointCloudView<3, T>, 3> const& axes, PointCloudView<3, T> const& extents,
+            uint8_t* intersect)
+        {
+            ForOrientedBoxes(ray, centers, axes, extents,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindOrientedBoxes(Ray3<T> const& ray, PointCloudView<3, T> const& centers,
+            std::array<PointCloudView<3, T>, 3> const& axes, PointCloudView<3, T> const& extents,
+            uint8_t* intersect, T* parameter0, T* parameter1)
+        {
+            ForOrientedBoxes(ray, centers, axes, extents,
+                [intersect, parameter0, parameter1](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter0, parameter1);
+                });
+        }
+
+        // Many rays with one sphere.
+        static void TestSphere(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, Sphere3<T> const& sphere,
+            uint8_t* intersect)
+        {
+            ForSphere(origins, directions, sphere,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindSphere(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, Sphere3<T> const& sphere,
+            uint8_t* intersect, T* parameter0, T* parameter1)
+        {
+            ForSphere(origins, directions, sphere,
+                [intersect, parameter0, parameter1](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter0, parameter1);
+                });
+        }
+
+        // One ray with many spheres.
+        static void TestSpheres(Ray3<T> const& ray, PointCloudView<3, T> const& centers,
+            T const* radii, uint8_t* intersect)
+        {
+            ForSpheres(ray, centers, radii,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindSpheres(Ray3<T> const& ray, PointCloudView<3, T> const& centers,
+            T const* radii, uint8_t* intersect, T* parameter0, T* parameter1)
+        {
+            ForSpheres(ray, centers, radii,
+                [intersect, parameter0, parameter1](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter0, parameter1);
+                });
+        }
+
+        // Many rays with one triangle.
+        static void TestTriangle(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, Triangle3<T> const& triangle,
+            uint8_t* intersect)
+        {
+            ForTriangle(origins, directions, triangle,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindTriangle(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, Triangle3<T> const& triangle,
+            uint8_t* intersect, T* parameter, T* bary1, T* bary2)
+        {
+            ForTriangle(origins, directions, triangle,
+                [intersect, parameter, bary1, bary2](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter, bary1, bary2);
+                });
+        }
+
+        // One ray with many triangles.
+        static void TestTriangles(Ray3<T> const& ray, PointCloudView<3, T> const& v0,
+            PointCloudView<3, T> const& v1, PointCloudView<3, T> const& v2,
+            uint8_t* intersect)
+        {
+            ForTriangles(ray, v0, v1, v2,
+                [intersect](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                });
+        }
+
+        static void FindTriangles(Ray3<T> const& ray, PointCloudView<3, T> const& v0,
+            PointCloudView<3, T> const& v1, PointCloudView<3, T> const& v2,
+            uint8_t* intersect, T* parameter, T* bary1, T* bary2)
+        {
+            ForTriangles(ray, v0, v1, v2,
+                [intersect, parameter, bary1, bary2](size_t i, size_t count, Block const& block)
+                {
+                    StoreHits(i, count, block, intersect);
+                    StoreParameters(i, count, block, parameter, bary1, bary2);
+                });
+        }
+
+    private:
+        // The pairs are processed in blocks of consecutive pairs. The lane
+        // kernels write their results to the arrays of a block, which is a
+        // local variable that does not alias the input arrays; this allows
+        // the compiler to vectorize the loop over the lanes of a block.
+        // The results are then copied to the output arrays. The kernels
+        // compute all values unconditionally and select among them, and
+        // they combine conditions with '&' instead of '&&'. Conditional
+        // evaluation is control flow that prevents the vectorization.
+        static size_t constexpr blockSize = 8;
+
+        struct Block
+        {
+            std::array<uint8_t, blockSize> hit;
+            std::array<T, blockSize> parameter0, parameter1, parameter2;
+        };
+
+        template <typename Lane, typename Output>
+        static void ForBlocks(size_t numPairs, Lane const& lane, Output const& output)
+        {
+            Block block;
+            size_t i = 0;
+            for (; i + blockSize <= numPairs; i += blockSize)
+            {
+                for (size_t j = 0; j < blockSize; ++j)
+                {
+                    lane(i + j, j, block);
+                }
+                output(i, blockSize, block);
+            }
+            if (i < numPairs)
+            {
+                size_t const count = numPairs - i;
+                for (size_t j = 0; j < count; ++j)
+                {
+                    lane(i + j, j, block);
+                }
+                output(i, count, block);
+            }
+        }
+
+        static inline void StoreHits(size_t i, size_t count, Block const& block,
+            uint8_t* intersect)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                intersect[i + j] = block.hit[j];
+            }
+        }
+
+        static inline void StoreParameters(size_t i, size_t count, Block const& block,
+            T* parameter0, T* parameter1)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                parameter0[i + j] = block.parameter0[j];
+                parameter1[i + j] = block.parameter1[j];
+            }
+        }
+
+        static inline void StoreParameters(size_t i, size_t count, Block const& block,
+            T* parameter0, T* parameter1, T* parameter2)
+        {
+            for (size_t j = 0; j < count; ++j)
+            {
+                parameter0[i + j] = block.parameter0[j];
+                parameter1[i + j] = block.parameter1[j];
+                parameter2[i + j] = block.parameter2[j];
+            }
+        }
+
+        static inline T Min(T x, T y)
+        {
+            return (x < y ? x : y);
+        }
+
+        static inline T Max(T x, T y)
+        {
+            return (x > y ? x : y);
+        }
+
+        // Clip the t-interval [tmin,tmax] against the slab |o + t*d| <= e.
+        static inline void Slab(T o, T d, T e, T& tmin, T& tmax)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const maxValue = std::numeric_limits<T>::max();
+            bool const parallel = (d == zero);
+            T const denom = (parallel ? one : d);
+            T const ta = (-e - o) / denom;
+            T const tb = (e - o) / denom;
+            T const tlow = Min(ta, tb);
+            T const thigh = Max(ta, tb);
+            T const tbound = (std::fabs(o) <= e ? maxValue : -maxValue);
+            T const tnear = (parallel ? -tbound : tlow);
+            T const tfar = (parallel ? tbound : thigh);
+            tmin = Max(tmin, tnear);
+            tmax = Min(tmax, tfar);
+        }
+
+        // The box is in centered form, and the ray origin is relative to
+        // the box center in the coordinate system of the box axes.
+        static inline void BoxKernel(T o0, T o1, T o2, T d0, T d1, T d2,
+            T e0, T e1, T e2, Block& block, size_t j)
+        {
+            T const zero = static_cast<T>(0);
+            T tmin = zero, tmax = std::numeric_limits<T>::max();
+            Slab(o0, d0, e0, tmin, tmax);
+            Slab(o1, d1, e1, tmin, tmax);
+            Slab(o2, d2, e2, tmin, tmax);
+            bool const intersect = (tmin <= tmax);
+            block.hit[j] = (intersect ? 1 : 0);
+            block.parameter0[j] = (intersect ? tmin : zero);
+            block.parameter1[j] = (intersect ? tmax : zero);
+        }
+
+        // The ray origin is relative to the sphere center.
+        static inline void SphereKernel(T o0, T o1, T o2, T d0, T d1, T d2,
+            T r, Block& block, size_t j)
+        {
+            T const zero = static_cast<T>(0);
+            T const a0 = o0 * o0 + o1 * o1 + o2 * o2 - r * r;
+            T const a1 = d0 * o0 + d1 * o1 + d2 * o2;
+            T const discr = a1 * a1 - a0;
+            T const root = std::sqrt(Max(discr, zero));
+            T const tmin = Max(-a1 - root, zero);
+            T const tmax = -a1 + root;
+            bool const intersect = (discr >= zero) & (tmax >= zero);
+            block.hit[j] = (intersect ? 1 : 0);
+            block.parameter0[j] = (intersect ? tmin : zero);
+            block.parameter1[j] = (intersect ? tmax : zero);
+        }
+
+        // The ray origin is relative to vertex v0, and the edges are
+        // v1 - v0 and v2 - v0. See IntrRay3Triangle3.h for the equations.
+        static inline void TriangleKernel(T q0, T q1, T q2, T d0, T d1, T d2,
+            T e10, T e11, T e12, T e20, T e21, T e22, Block& block, size_t j)
+        {
+            T const zero = static_cast<T>(0), one = static_cast<T>(1);
+            T const n0 = e11 * e22 - e12 * e21;
+            T const n1 = e12 * e20 - e10 * e22;
+            T const n2 = e10 * e21 - e11 * e20;
+            T const signedDdN = d0 * n0 + d1 * n1 + d2 * n2;
+            T const sign = (signedDdN > zero ? one : -one);
+            T const DdN = sign * signedDdN;
+
+            // Dot(D,Cross(Q,E2)) and Dot(D,Cross(E1,Q)).
+            T const DdQxE2 = sign * (d0 * (q1 * e22 - q2 * e21) +
+                d1 * (q2 * e20 - q0 * e22) + d2 * (q0 * e21 - q1 * e20));
+            T const DdE1xQ = sign * (d0 * (e11 * q2 - e12 * q1) +
+                d1 * (e12 * q0 - e10 * q2) + d2 * (e10 * q1 - e11 * q0));
+            T const QdN = -sign * (q0 * n0 + q1 * n1 + q2 * n2);
+
+            bool const intersect = (signedDdN != zero) & (DdQxE2 >= zero) &
+                (DdE1xQ >= zero) & (DdQxE2 + DdE1xQ <= DdN) & (QdN >= zero);
+            T const inv = one / (intersect ? DdN : one);
+            T const t = QdN * inv, b1 = DdQxE2 * inv, b2 = DdE1xQ * inv;
+            block.hit[j] = (intersect ? 1 : 0);
+            block.parameter0[j] = (intersect ? t : zero);
+            block.parameter1[j] = (intersect ? b1 : zero);
+            block.parameter2[j] = (intersect ? b2 : zero);
+        }
+
+        template <typename Output>
+        static void ForAlignedBox(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, AlignedBox3<T> const& box,
+            Output const& output)
+        {
+            size_t const numRays = origins.GetNumPoints();
+            LogAssert(directions.GetNumPoints() == numRays, "Mismatched ray arrays.");
+            Vector3<T> center{}, extent{};
+            box.GetCenteredForm(center, extent);
+            T const c0 = center[0], c1 = center[1], c2 = center[2];
+            T const e0 = extent[0], e1 = extent[1], e2 = extent[2];
+            T const* ox = origins.GetCoordinates(0);
+            T const* oy = origins.GetCoordinates(1);
+            T const* oz = origins.GetCoordinates(2);
+            T const* dx = directions.GetCoordinates(0);
+            T const* dy = directions.GetCoordinates(1);
+            T const* dz = directions.GetCoordinates(2);
+            ForBlocks(numRays,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    BoxKernel(ox[i] - c0, oy[i] - c1, oz[i] - c2,
+                        dx[i], dy[i], dz[i], e0, e1, e2, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForAlignedBoxes(Ray3<T> const& ray, PointCloudView<3, T> const& minima,
+            PointCloudView<3, T> const& maxima, Output const& output)
+        {
+            size_t const numBoxes = minima.GetNumPoints();
+            LogAssert(maxima.GetNumPoints() == numBoxes, "Mismatched box arrays.");
+            T const* minx = minima.GetCoordinates(0);
+            T const* miny = minima.GetCoordinates(1);
+            T const* minz = minima.GetCoordinates(2);
+            T const* maxx = maxima.GetCoordinates(0);
+            T const* maxy = maxima.GetCoordinates(1);
+            T const* maxz = maxima.GetCoordinates(2);
+            T const p0 = ray.origin[0], p1 = ray.origin[1], p2 = ray.origin[2];
+            T const d0 = ray.direction[0], d1 = ray.direction[1], d2 = ray.direction[2];
+            ForBlocks(numBoxes,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    // The centered form of AlignedBox3::GetCenteredForm.
+                    T const half = static_cast<T>(0.5);
+                    T const c0 = (maxx[i] + minx[i]) * half;
+                    T const c1 = (maxy[i] + miny[i]) * half;
+                    T const c2 = (maxz[i] + minz[i]) * half;
+                    T const e0 = (maxx[i] - minx[i]) * half;
+                    T const e1 = (maxy[i] - miny[i]) * half;
+                    T const e2 = (maxz[i] - minz[i]) * half;
+                    BoxKernel(p0 - c0, p1 - c1, p2 - c2, d0, d1, d2, e0, e1, e2, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForOrientedBox(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, OrientedBox3<T> const& box,
+            Output const& output)
+        {
+            size_t const numRays = origins.GetNumPoints();
+            LogAssert(directions.GetNumPoints() == numRays, "Mismatched ray arrays.");
+            T const c0 = box.center[0], c1 = box.center[1], c2 = box.center[2];
+            T const u00 = box.axis[0][0], u01 = box.axis[0][1], u02 = box.axis[0][2];
+            T const u10 = box.axis[1][0], u11 = box.axis[1][1], u12 = box.axis[1][2];
+            T const u20 = box.axis[2][0], u21 = box.axis[2][1], u22 = box.axis[2][2];
+            T const e0 = box.extent[0], e1 = box.extent[1], e2 = box.extent[2];
+            T const* ox = origins.GetCoordinates(0);
+            T const* oy = origins.GetCoordinates(1);
+            T const* oz = origins.GetCoordinates(2);
+            T const* dx = directions.GetCoordinates(0);
+            T const* dy = directions.GetCoordinates(1);
+            T const* dz = directions.GetCoordinates(2);
+            ForBlocks(numRays,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    T const q0 = ox[i] - c0, q1 = oy[i] - c1, q2 = oz[i] - c2;
+                    BoxKernel(
+                        q0 * u00 + q1 * u01 + q2 * u02,
+                        q0 * u10 + q1 * u11 + q2 * u12,
+                        q0 * u20 + q1 * u21 + q2 * u22,
+                        dx[i] * u00 + dy[i] * u01 + dz[i] * u02,
+                        dx[i] * u10 + dy[i] * u11 + dz[i] * u12,
+                        dx[i] * u20 + dy[i] * u21 + dz[i] * u22,
+                        e0, e1, e2, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForOrientedBoxes(Ray3<T> const& ray, PointCloudView<3, T> const& centers,
+            std::array<PointCloudView<3, T>, 3> const& axes, PointCloudView<3, T> const& extents,
+            Output const& output)
+        {
+            size_t const numBoxes = centers.GetNumPoints();
+            LogAssert(axes[0].GetNumPoints() == numBoxes && axes[1].GetNumPoints() == numBoxes &&
+                axes[2].GetNumPoints() == numBoxes && extents.GetNumPoints() == numBoxes,
+                "Mismatched box arrays.");
+            T const* cx = centers.GetCoordinates(0);
+            T const* cy = centers.GetCoordinates(1);
+            T const* cz = centers.GetCoordinates(2);
+            T const* u00 = axes[0].GetCoordinates(0);
+            T const* u01 = axes[0].GetCoordinates(1);
+            T const* u02 = axes[0].GetCoordinates(2);
+            T const* u10 = axes[1].GetCoordinates(0);
+            T const* u11 = axes[1].GetCoordinates(1);
+            T const* u12 = axes[1].GetCoordinates(2);
+            T const* u20 = axes[2].GetCoordinates(0);
+            T const* u21 = axes[2].GetCoordinates(1);
+            T const* u22 = axes[2].GetCoordinates(2);
+            T const* ex = extents.GetCoordinates(0);
+            T const* ey = extents.GetCoordinates(1);
+            T const* ez = extents.GetCoordinates(2);
+            T const p0 = ray.origin[0], p1 = ray.origin[1], p2 = ray.origin[2];
+            T const d0 = ray.direction[0], d1 = ray.direction[1], d2 = ray.direction[2];
+            ForBlocks(numBoxes,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    T const q0 = p0 - cx[i], q1 = p1 - cy[i], q2 = p2 - cz[i];
+                    BoxKernel(
+                        q0 * u00[i] + q1 * u01[i] + q2 * u02[i],
+                        q0 * u10[i] + q1 * u11[i] + q2 * u12[i],
+                        q0 * u20[i] + q1 * u21[i] + q2 * u22[i],
+                        d0 * u00[i] + d1 * u01[i] + d2 * u02[i],
+                        d0 * u10[i] + d1 * u11[i] + d2 * u12[i],
+                        d0 * u20[i] + d1 * u21[i] + d2 * u22[i],
+                        ex[i], ey[i], ez[i], block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForSphere(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, Sphere3<T> const& sphere,
+            Output const& output)
+        {
+            size_t const numRays = origins.GetNumPoints();
+            LogAssert(directions.GetNumPoints() == numRays, "Mismatched ray arrays.");
+            T const c0 = sphere.center[0], c1 = sphere.center[1], c2 = sphere.center[2];
+            T const radius = sphere.radius;
+            T const* ox = origins.GetCoordinates(0);
+            T const* oy = origins.GetCoordinates(1);
+            T const* oz = origins.GetCoordinates(2);
+            T const* dx = directions.GetCoordinates(0);
+            T const* dy = directions.GetCoordinates(1);
+            T const* dz = directions.GetCoordinates(2);
+            ForBlocks(numRays,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    SphereKernel(ox[i] - c0, oy[i] - c1, oz[i] - c2,
+                        dx[i], dy[i], dz[i], radius, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForSpheres(Ray3<T> const& ray, PointCloudView<3, T> const& centers,
+            T const* radii, Output const& output)
+        {
+            size_t const numSpheres = centers.GetNumPoints();
+            LogAssert(numSpheres == 0 || radii != nullptr, "Invalid radii.");
+            T const* cx = centers.GetCoordinates(0);
+            T const* cy = centers.GetCoordinates(1);
+            T const* cz = centers.GetCoordinates(2);
+            T const p0 = ray.origin[0], p1 = ray.origin[1], p2 = ray.origin[2];
+            T const d0 = ray.direction[0], d1 = ray.direction[1], d2 = ray.direction[2];
+            ForBlocks(numSpheres,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    SphereKernel(p0 - cx[i], p1 - cy[i], p2 - cz[i],
+                        d0, d1, d2, radii[i], block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForTriangle(PointCloudView<3, T> const& origins,
+            PointCloudView<3, T> const& directions, Triangle3<T> const& triangle,
+            Output const& output)
+        {
+            size_t const numRays = origins.GetNumPoints();
+            LogAssert(directions.GetNumPoints() == numRays, "Mismatched ray arrays.");
+            Vector3<T> const E1 = triangle.v[1] - triangle.v[0];
+            Vector3<T> const E2 = triangle.v[2] - triangle.v[0];
+            T const v0 = triangle.v[0][0], v1 = triangle.v[0][1], v2 = triangle.v[0][2];
+            T const e10 = E1[0], e11 = E1[1], e12 = E1[2];
+            T const e20 = E2[0], e21 = E2[1], e22 = E2[2];
+            T const* ox = origins.GetCoordinates(0);
+            T const* oy = origins.GetCoordinates(1);
+            T const* oz = origins.GetCoordinates(2);
+            T const* dx = directions.GetCoordinates(0);
+            T const* dy = directions.GetCoordinates(1);
+            T const* dz = directions.GetCoordinates(2);
+            ForBlocks(numRays,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    TriangleKernel(ox[i] - v0, oy[i] - v1, oz[i] - v2,
+                        dx[i], dy[i], dz[i], e10, e11, e12, e20, e21, e22, block, j);
+                },
+                output);
+        }
+
+        template <typename Output>
+        static void ForTriangles(Ray3<T> const& ray, PointCloudView<3, T> const& v0,
+            PointCloudView<3, T> const& v1, PointCloudView<3, T> const& v2,
+            Output const& output)
+        {
+            size_t const numTriangles = v0.GetNumPoints();
+            LogAssert(v1.GetNumPoints() == numTriangles && v2.GetNumPoints() == numTriangles,
+                "Mismatched triangle arrays.");
+            T const* x0 = v0.GetCoordinates(0);
+            T const* y0 = v0.GetCoordinates(1);
+            T const* z0 = v0.GetCoordinates(2);
+            T const* x1 = v1.GetCoordinates(0);
+            T const* y1 = v1.GetCoordinates(1);
+            T const* z1 = v1.GetCoordinates(2);
+            T const* x2 = v2.GetCoordinates(0);
+            T const* y2 = v2.GetCoordinates(1);
+            T const* z2 = v2.GetCoordinates(2);
+            T const p0 = ray.origin[0], p1 = ray.origin[1], p2 = ray.origin[2];
+            T const d0 = ray.direction[0], d1 = ray.direction[1], d2 = ray.direction[2];
+            ForBlocks(numTriangles,
+                [=](size_t i, size_t j, Block& block)
+                {
+                    TriangleKernel(p0 - x0[i], p1 - y0[i], p2 - z0[i], d0, d1, d2,
+                        x1[i] - x0[i], y1[i] - y0[i], z1[i] - z0[i],
+                        x2[i] - x0[i], y2[i] - y0[i], z2[i] - z0[i], block, j);
+                },
+                output);
+        }
+    };
+}
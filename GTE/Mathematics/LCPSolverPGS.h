@@ -0,0 +1,281 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/CSRMatrix.h>
+#include <Mathematics/LCPSolver.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// A projected Gauss-Seidel solver for the Linear Complementarity Problem
+// (LCP) w = q + M * z, w^T * z = 0, w >= 0, z >= 0, where the n-by-n matrix
+// M is sparse and is stored in compressed sparse row format. An iteration
+// visits the rows in order and updates
+//   z[i] = max(0, z[i] - omega * (q[i] + sum_j M[i][j] * z[j]) / M[i][i])
+// where omega in (0,2) is the relaxation factor. The cost of an iteration
+// is proportional to the number of nonzero entries of M. The iterations
+// converge when M is symmetric positive definite, which is the case for the
+// contact matrices of rigid-body simulations with independent contacts, and
+// they usually converge for symmetric positive semidefinite M with positive
+// diagonal entries.
+//
+// In a simulation the solution of a frame is a good estimate of the
+// solution of the next frame. Pass it as the input z with useInitialZ set to
+// 'true' to start the iterations from it (warm starting) rather than from
+// z = 0. The iterations stop when the natural residual
+//   max_i |min(z[i], w[i])|
+// is at most tolerance * max(1, max_i |q[i]|).
+//
+// When the iterations do not converge within the maximum number of
+// iterations or when a diagonal entry of M is not positive, the LCP is
+// solved exactly with Lemke's method by LCPSolver<Real>, which uses a dense
+// copy of M. This is done only when n is at most the maximum Lemke dimension
+// (default 64), because the cost of Lemke's method is cubic in n. Set that
+// dimension to 0 to disable the fallback; when the iterations then fail to
+// converge, z and w are the last iterates, which are approximate solutions
+// that are often acceptable for interactive simulations.
+
+namespace gte
+{
+    template <typename Real>
+    class LCPSolverPGS
+    {
+    public:
+        typedef typename LCPSolverShared<Real>::Result Result;
+
+        LCPSolverPGS(int maxIterations = 100, Real tolerance = (Real)1e-06,
+            Real relaxation = (Real)1)
+            :
+            mMaxIterations(0),
+            mTolerance((Real)0),
+            mRelaxation((Real)1),
+            mMaxLemkeDimension(64),
+            mNumIterations(0),
+            mResidual((Real)0),
+            mUsedLemke(false)
+        {
+            SetMaxIterations(maxIterations);
+            SetTolerance(tolerance);
+            SetRelaxation(relaxation);
+        }
+
+        // Member access.
+        inline void SetMaxIterations(int maxIterations)
+        {
+            mMaxIterations = std::max(maxIterations, 1);
+        }
+
+        inline int GetMaxIterations() const
+        {
+            return mMaxIterations;
+        }
+
+        inline void SetTolerance(Real tolerance)
+        {
+            mTolerance = std::max(tolerance, (Real)0);
+        }
+
+        inline Real GetTolerance() const
+        {
+            return mTolerance;
+        }
+
+        // The relaxation factor is clamped to (0,2).
+        inline void SetRelaxation(Real relaxation)
+        {
+            Real const minRelaxation = (Real)1e-03, maxRelaxation = (Real)2 - minRelaxation;
+            mRelaxation = std::min(std::max(relaxation, minRelaxation), maxRelaxation);
+        }
+
+        inline Real GetRelaxation() const
+        {
+            return mRelaxation;
+        }
+
+        inline void SetMaxLemkeDimension(int maxLemkeDimension)
+        {
+            mMaxLemkeDimension = std::max(maxLemkeDimension, 0);
+        }
+
+        inline int GetMaxLemkeDimension() const
+        {
+            return mMaxLemkeDimension;
+        }
+
+        // The results of the last call to Solve: the number of projected
+        // Gauss-Seidel iterations, the natural residual of the iterations
+        // and whether the solution was computed with Lemke's method.
+        inline int GetNumIterations() const
+        {
+            return mNumIterations;
+        }
+
+        inline Real GetResidual() const
+        {
+            return mResidual;
+        }
+
+        inline bool UsedLemke() const
+        {
+            return mUsedLemke;
+        }
+
+        // The input q must have n elements and M must be n-by-n. The outputs
+        // w and z have n elements. When useInitialZ is 'true', z must have n
+        // elements on input, which are the initial guess for the iterations.
+        // If you want to know specifically why 'true' or 'false' was
+        // returned, pass the address of a Result variable as the last
+        // parameter.
+        bool Solve(std::vector<Real> const& q, CSRMatrix<Real> const& M,
+            std::vector<Real>& w, std::vector<Real>& z, bool useInitialZ,
+            Result* result = nullptr)
+        {
+            Real const zero = (Real)0;
+            mNumIterations = 0;
+            mResidual = zero;
+            mUsedLemke = false;
+
+            int const n = M.GetNumRows();
+            size_t const size = static_cast<size_t>(n);
+            if (n != M.GetNumCols() || q.size() != size ||
+                (useInitialZ && z.size() != size))
+            {
+                SetResult(result, LCPSolverShared<Real>::INVALID_INPUT);
+                return false;
+            }
+
+            w.resize(size);
+            z.resize(size);
+
+            // Determine whether there is the trivial solution w = q, z = 0.
+            if (std::all_of(q.begin(), q.end(), [zero](Real value) { return value >= zero; }))
+            {
+                std::copy(q.begin(), q.end(), w.begin());
+                std::fill(z.begin(), z.end(), zero);
+                SetResult(result, LCPSolverShared<Real>::HAS_TRIVIAL_SOLUTION);
+                return true;
+            }
+
+            auto const& offsets = M.GetRowOffsets();
+            auto const& columns = M.GetColumns();
+            auto const& values = M.GetValues();
+
+            // The Gauss-Seidel updates require positive diagonal entries.
+            mInvDiagonal.resize(size);
+            bool positiveDiagonal = true;
+            for (int i = 0; i < n; ++i)
+            {
+                size_t index = M.GetIndex(i, i);
+                if (index < values.size() && values[index] > zero)
+                {
+                    mInvDiagonal[i] = mRelaxation / values[index];
+                }
+                else
+                {
+                    positiveDiagonal = false;
+                    break;
+                }
+            }
+
+            if (positiveDiagonal)
+            {
+                Real qMax = (Real)1;
+                for (auto value : q)
+                {
+                    qMax = std::max(qMax, std::fabs(value));
+                }
+                Real const threshold = mTolerance * qMax;
+
+                if (useInitialZ)
+                {
+                    for (auto& value : z)
+                    {
+                        value = std::max(value, zero);
+                    }
+                }
+                else
+                {
+                    std::fill(z.begin(), z.end(), zero);
+                }
+
+                for (mNumIterations = 1; mNumIterations <= mMaxIterations; ++mNumIterations)
+                {
+                    for (int i = 0; i < n; ++i)
+                    {
+                        Real wi = q[i];
+                        for (size_t k = offsets[i]; k < offsets[static_cast<size_t>(i) + 1]; ++k)
+                        {
+                            wi += values[k] * z[columns[k]];
+                        }
+                        z[i] = std::max(z[i] - mInvDiagonal[i] * wi, zero);
+                    }
+
+                    // Compute w = q + M * z and the natural residual.
+                    M.Multiply(z.data(), w.data());
+                    mResidual = zero;
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        w[i] += q[i];
+                        mResidual = std::max(mResidual, std::fabs(std::min(z[i], w[i])));
+                    }
+
+                    if (mResidual <= threshold)
+                    {
+                        SetResult(result, LCPSolverShared<Real>::HAS_NONTRIVIAL_SOLUTION);
+                        return true;
+                    }
+                }
+                mNumIterations = mMaxIterations;
+            }
+
+            if (n <= mMaxLemkeDimension)
+            {
+                // Solve the LCP exactly with Lemke's method.
+                std::vector<Real> denseM(size * size, zero);
+                for (int i = 0; i < n; ++i)
+                {
+                    for (size_t k = offsets[i]; k < offsets[static_cast<size_t>(i) + 1]; ++k)
+                    {
+                        denseM[columns[k] + size * i] = values[k];
+                    }
+                }
+
+                LCPSolver<Real> lemke(n);
+                mUsedLemke = true;
+                return lemke.Solve(q, denseM, w, z, result);
+            }
+
+#if defined(GTE_THROW_ON_LCPSOLVER_ERRORS)
+            LogError("LCPSolverPGS::Solve failed to converge.");
+#endif
+            SetResult(result, positiveDiagonal ?
+                LCPSolverShared<Real>::FAILED_TO_CONVERGE :
+                LCPSolverShared<Real>::INVALID_INPUT);
+            return false;
+        }
+
+    private:
+        static inline void SetResult(Result* result, Result value)
+        {
+            if (result)
+            {
+                *result = value;
+            }
+        }
+
+        int mMaxIterations;
+        Real mTolerance;
+        Real mRelaxation;
+        int mMaxLemkeDimension;
+        int mNumIterations;
+        Real mResidual;
+        bool mUsedLemke;
+        std::vector<Real> mInvDiagonal;
+    };
+}
@@ -3,15 +3,25 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/CholeskyDecomposition.h>
+#include <Mathematics/CSRMatrix.h>
+#include <Mathematics/SparseCholesky.h>
+#include <Mathematics/TaskScheduler.h>
 #include <functional>
+#include <memory>
+#include <vector>
 
 // See GaussNewtonMinimizer.h for a formulation of the minimization
-// problem and how Levenberg-Marquardt relates to Gauss-Newton.
+// problem and how Levenberg-Marquardt relates to Gauss-Newton. That file
+// also describes the sparse J^T*J and the concurrent minimizations from
+// several initial guesses, which are supported here in the same way.
+//
+// J^T*J and -J^T*F are computed once for each iterate p. The adjustments of
+// lambda at p modify a copy of J^T*J, so they do not evaluate J again.
 
 namespace gte
 {
@@ -29,6 +39,8 @@ namespace gte
         typedef std::function<void(DVector const&, RVector&)> FFunction;
         typedef std::function<void(DVector const&, JMatrix&)> JFunction;
         typedef std::function<void(DVector const&, JTJMatrix&, JTFVector&)> JPlusFunction;
+        typedef CSRMatrix<Real> SparseJTJMatrix;  // numPDimensions-by-numPDimensions
+        typedef std::function<void(DVector const&, SparseJTJMatrix&, JTFVector&)> SparseJPlusFunction;
 
         // Create the minimizer that computes F(p) and J(p) directly.
         LevenbergMarquardtMinimizer(int numPDimensions, int numFDimensions,
@@ -43,7 +55,7 @@ namespace gte
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(true)
+            mMode(Mode::J_FUNCTION)
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
@@ -57,11 +69,28 @@ namespace gte
             mFFunction(inFFunction),
             mJPlusFunction(inJPlusFunction),
             mF(mNumFDimensions),
-            mJ(mNumFDimensions, mNumPDimensions),
             mJTJ(mNumPDimensions, mNumPDimensions),
             mNegJTF(mNumPDimensions),
             mDecomposer(mNumPDimensions),
-            mUseJFunction(false)
+            mMode(Mode::JPLUS_FUNCTION)
+        {
+            LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
+        }
+
+        // Create the minimizer that computes J^T(p)*J(p) as a sparse matrix
+        // and -J(p)*F(p). The function must set the structure of the matrix
+        // on its first call; it is then called with the same matrix.
+        LevenbergMarquardtMinimizer(int numPDimensions, int numFDimensions,
+            FFunction const& inFFunction, SparseJPlusFunction const& inSparseJPlusFunction)
+            :
+            mNumPDimensions(numPDimensions),
+            mNumFDimensions(numFDimensions),
+            mFFunction(inFFunction),
+            mSparseJPlusFunction(inSparseJPlusFunction),
+            mF(mNumFDimensions),
+            mNegJTF(mNumPDimensions),
+            mDecomposer(mNumPDimensions),
+            mMode(Mode::SPARSE_JPLUS_FUNCTION)
         {
             LogAssert(mNumPDimensions > 0 && mNumFDimensions > 0, "Invalid dimensions.");
         }
@@ -126,6 +155,8 @@ namespace gte
             auto pCurrent = p0;
             for (result.numIterations = 1; result.numIterations <= maxIterations; ++result.numIterations)
             {
+                ComputeLinearSystemInputs(pCurrent);
+
                 std::pair<bool, bool> status;
                 DVector pNext;
                 for (result.numAdjustments = 0; result.numAdjustments < maxAdjustments; ++result.numAdjustments)
@@ -184,30 +215,145 @@ namespace gte
             return result;
         }
 
+        // Run the minimizer from each of the initial guesses p0[i] and
+        // return the results in the same order. The guesses are distributed
+        // over numThreads threads, each with its own minimizer, so the
+        // function objects are called concurrently when numThreads > 1. The
+        // threads are tasks of the scheduler when it is not null.
+        std::vector<Result> operator()(std::vector<DVector> const& p0, size_t maxIterations,
+            Real updateLengthTolerance, Real errorDifferenceTolerance,
+            Real lambdaFactor, Real lambdaAdjust, size_t maxAdjustments, size_t numThreads,
+            TaskScheduler* scheduler = nullptr)
+        {
+            std::vector<Result> results(p0.size());
+            numThreads = std::max(std::min(numThreads, p0.size()), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numThreads,
+                [this, &p0, &results, maxIterations, updateLengthTolerance,
+                errorDifferenceTolerance, lambdaFactor, lambdaAdjust, maxAdjustments,
+                numThreads](size_t t)
+                {
+                    auto minimizer = CreateMinimizer();
+                    for (size_t i = t; i < p0.size(); i += numThreads)
+                    {
+                        results[i] = (*minimizer)(p0[i], maxIterations, updateLengthTolerance,
+                            errorDifferenceTolerance, lambdaFactor, lambdaAdjust, maxAdjustments);
+                    }
+                });
+            return results;
+        }
+
     private:
-        void ComputeLinearSystemInputs(DVector const& pCurrent, Real lambda)
+        enum class Mode
         {
-            if (mUseJFunction)
+            J_FUNCTION,
+            JPLUS_FUNCTION,
+            SPARSE_JPLUS_FUNCTION
+        };
+
+        void ComputeLinearSystemInputs(DVector const& pCurrent)
+        {
+            if (mMode == Mode::J_FUNCTION)
             {
                 mJFunction(pCurrent, mJ);
                 mJTJ = MultiplyATB(mJ, mJ);
                 mNegJTF = -(mF * mJ);
             }
-            else
+            else if (mMode == Mode::JPLUS_FUNCTION)
             {
                 mJPlusFunction(pCurrent, mJTJ, mNegJTF);
             }
+            else
+            {
+                mSparseJPlusFunction(pCurrent, mSparseJTJ, mNegJTF);
+            }
+        }
+
+        // Solve (J^T*J + lambda*average(diagonal(J^T*J))*I)*d = -J^T*F,
+        // storing d in mUpdate. The return value is 'false' when the
+        // factorization fails.
+        bool SolveLinearSystem(Real lambda)
+        {
+            mUpdate = mNegJTF;
+            if (mMode == Mode::SPARSE_JPLUS_FUNCTION)
+            {
+                if (mAdjustedSparseJTJ.GetNumNonzeros() != mSparseJTJ.GetNumNonzeros())
+                {
+                    mAdjustedSparseJTJ = mSparseJTJ;
+                    mDiagonalIndices.resize(mNumPDimensions);
+                    for (int i = 0; i < mNumPDimensions; ++i)
+                    {
+                        mDiagonalIndices[i] = mSparseJTJ.GetIndex(i, i);
+                    }
+                }
+                else
+                {
+                    mAdjustedSparseJTJ.GetValues() = mSparseJTJ.GetValues();
+                }
+
+                std::vector<Real>& values = mAdjustedSparseJTJ.GetValues();
+                Real diagonalSum(0);
+                for (int i = 0; i < mNumPDimensions; ++i)
+                {
+                    if (mDiagonalIndices[i] < values.size())
+                    {
+                        diagonalSum += values[mDiagonalIndices[i]];
+                    }
+                }
+                Real diagonalAdjust = lambda * diagonalSum / static_cast<Real>(mNumPDimensions);
+                for (int i = 0; i < mNumPDimensions; ++i)
+                {
+                    if (mDiagonalIndices[i] < values.size())
+                    {
+                        values[mDiagonalIndices[i]] += diagonalAdjust;
+                    }
+                }
+
+                if (!mSparseDecomposer.Factor(mAdjustedSparseJTJ,
+                    SparseCholesky<Real>::Ordering::MINIMUM_DEGREE))
+                {
+                    return false;
+                }
+                mSparseDecomposer.Solve(&mUpdate[0], &mUpdate[0]);
+                return true;
+            }
 
+            mAdjustedJTJ = mJTJ;
             Real diagonalSum(0);
             for (int i = 0; i < mNumPDimensions; ++i)
             {
-                diagonalSum += mJTJ(i, i);
+                diagonalSum += mAdjustedJTJ(i, i);
             }
-
             Real diagonalAdjust = lambda * diagonalSum / static_cast<Real>(mNumPDimensions);
             for (int i = 0; i < mNumPDimensions; ++i)
             {
-                mJTJ(i, i) += diagonalAdjust;
+                mAdjustedJTJ(i, i) += diagonalAdjust;
+            }
+
+            if (!mDecomposer.Factor(mAdjustedJTJ))
+            {
+                return false;
+            }
+            mDecomposer.SolveLower(mAdjustedJTJ, mUpdate);
+            mDecomposer.SolveUpper(mAdjustedJTJ, mUpdate);
+            return true;
+        }
+
+        std::unique_ptr<LevenbergMarquardtMinimizer> CreateMinimizer() const
+        {
+            if (mMode == Mode::J_FUNCTION)
+            {
+                return std::make_unique<LevenbergMarquardtMinimizer>(mNumPDimensions,
+                    mNumFDimensions, mFFunction, mJFunction);
+            }
+            else if (mMode == Mode::JPLUS_FUNCTION)
+            {
+                return std::make_unique<LevenbergMarquardtMinimizer>(mNumPDimensions,
+                    mNumFDimensions, mFFunction, mJPlusFunction);
+            }
+            else
+            {
+                return std::make_unique<LevenbergMarquardtMinimizer>(mNumPDimensions,
+                    mNumFDimensions, mFFunction, mSparseJPlusFunction);
             }
         }
 
@@ -221,8 +367,7 @@ namespace gte
             Real updateLengthTolerance, Real errorDifferenceTolerance, DVector& pNext,
             Result& result)
         {
-            ComputeLinearSystemInputs(pCurrent, lambdaFactor);
-            if (!mDecomposer.Factor(mJTJ))
+            if (!SolveLinearSystem(lambdaFactor))
             {
                 // TODO: The matrix mJTJ is positive semi-definite, so the
                 // failure can occur when mJTJ has a zero eigenvalue in
@@ -230,16 +375,14 @@ namespace gte
                 // anyway, perhaps using gradient descent?
                 return std::make_pair(true, false);
             }
-            mDecomposer.SolveLower(mJTJ, mNegJTF);
-            mDecomposer.SolveUpper(mJTJ, mNegJTF);
 
-            pNext = pCurrent + mNegJTF;
+            pNext = pCurrent + mUpdate;
             mFFunction(pNext, mF);
             Real error = Dot(mF, mF);
             if (error < result.minError)
             {
                 result.minErrorDifference = result.minError - error;
-                result.minUpdateLength = Length(mNegJTF);
+                result.minUpdateLength = Length(mUpdate);
                 result.minLocation = pNext;
                 result.minError = error;
                 if (result.minErrorDifference <= errorDifferenceTolerance
@@ -263,15 +406,20 @@ namespace gte
         FFunction mFFunction;
         JFunction mJFunction;
         JPlusFunction mJPlusFunction;
+        SparseJPlusFunction mSparseJPlusFunction;
 
-        // Storage for J^T(p)*J(p) and -J^T(p)*F(p) during the iterations.
+        // Storage for J^T(p)*J(p) and -J^T(p)*F(p) during the iterations,
+        // the adjusted J^T(p)*J(p) and the update d.
         RVector mF;
         JMatrix mJ;
-        JTJMatrix mJTJ;
-        JTFVector mNegJTF;
+        JTJMatrix mJTJ, mAdjustedJTJ;
+        SparseJTJMatrix mSparseJTJ, mAdjustedSparseJTJ;
+        std::vector<size_t> mDiagonalIndices;
+        JTFVector mNegJTF, mUpdate;
 
         CholeskyDecomposition<Real> mDecomposer;
+        SparseCholesky<Real> mSparseDecomposer;
 
-        bool mUseJFunction;
+        Mode mMode;
     };
 }
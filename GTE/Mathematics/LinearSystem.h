@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -11,7 +11,10 @@
 #include <Mathematics/Matrix3x3.h>
 #include <Mathematics/Matrix4x4.h>
 #include <Mathematics/GaussianElimination.h>
+#include <Mathematics/CSRMatrix.h>
+#include <cmath>
 #include <map>
+#include <memory>
 
 // Solve linear systems of equations where the matrix A is NxN.  The return
 // value of a function is 'true' when A is invertible.  In this case the
@@ -24,6 +27,15 @@
 // on the discussion in "Matrix Computations, 2nd edition" by G. H. Golub
 // and Charles F. Van Loan, The Johns Hopkins Press, Baltimore MD, Fourth
 // Printing 1993.
+//
+// The solvers for CSRMatrix systems are the preconditioned conjugate
+// gradient method for symmetric positive (semi)definite matrices and the
+// BiCGSTAB method of
+//   H.A. van der Vorst, Bi-CGSTAB: A fast and smoothly converging variant
+//   of Bi-CG for the solution of nonsymmetric linear systems, SIAM Journal
+//   on Scientific and Statistical Computing 13 (1992), 631-644
+// for general matrices. The matrix-vector products are partitioned among
+// numThreads threads; the results do not depend on the number of threads.
 
 namespace gte
 {
@@ -269,7 +281,288 @@ namespace gte
             return iteration;
         }
 
+        // The preconditioners of the CSRMatrix solvers. JACOBI scales by the
+        // inverse of the diagonal of A; rows with a zero diagonal entry are
+        // not scaled. ILU0 is the incomplete LU factorization of A with the
+        // sparsity pattern of A, which requires the diagonal entries to be
+        // stored and the pivots to be nonzero. It is more effective than
+        // JACOBI for matrices such as discrete Laplacians, but its
+        // triangular solves are sequential.
+        enum class Preconditioner
+        {
+            NONE,
+            JACOBI,
+            ILU0
+        };
+
+        // Solve A*X = B using the preconditioned conjugate gradient method,
+        // where A is symmetric and positive definite, or positive
+        // semidefinite with B in its range. When useInitialX is 'false', the
+        // iterations start at X = 0; otherwise, they start at the input X.
+        // The iterations terminate when the residual satisfies
+        // |B - A*X| <= tolerance * |B|. The return value is the number of
+        // iterations when the method converged and maxIterations + 1 when
+        // it did not.
+        static unsigned int SolveSymmetricCG(CSRMatrix<Real> const& A, Real const* B,
+            Real* X, unsigned int maxIterations, Real tolerance,
+            Preconditioner preconditioner = Preconditioner::JACOBI,
+            size_t numThreads = 1, bool useInitialX = false)
+        {
+            int const N = A.GetNumRows();
+            LogAssert(A.GetNumCols() == N, "The matrix must be square.");
+            std::unique_ptr<TaskScheduler> scheduler;
+            if (numThreads > 1)
+            {
+                scheduler = std::make_unique<TaskScheduler>(numThreads);
+            }
+            SparsePreconditioner M(A, preconditioner);
+
+            std::vector<Real> R(N), Z(N), P(N), W(N);
+            Real const threshold = InitialResidual(A, B, X, tolerance, useInitialX, scheduler.get(), R.data());
+            if (std::sqrt(Dot(N, R.data(), R.data())) <= threshold)
+            {
+                return 0;
+            }
+
+            M.Apply(R.data(), Z.data(), scheduler.get());
+            std::copy(Z.begin(), Z.end(), P.begin());
+            Real rho0 = Dot(N, R.data(), Z.data());
+            for (unsigned int iteration = 1; iteration <= maxIterations; ++iteration)
+            {
+                A.Multiply(P.data(), W.data(), scheduler.get());
+                Real alpha = rho0 / Dot(N, P.data(), W.data());
+                UpdateX(N, X, alpha, P.data());
+                UpdateR(N, R.data(), alpha, W.data());
+                if (std::sqrt(Dot(N, R.data(), R.data())) <= threshold)
+                {
+                    return iteration;
+                }
+
+                M.Apply(R.data(), Z.data(), scheduler.get());
+                Real rho1 = Dot(N, R.data(), Z.data());
+                UpdateP(N, P.data(), rho1 / rho0, Z.data());
+                rho0 = rho1;
+            }
+            return maxIterations + 1;
+        }
+
+        // Solve A*X = B using the preconditioned BiCGSTAB method, where A is
+        // square and invertible (not necessarily symmetric). The initial X,
+        // the termination and the return value are those of the CSRMatrix
+        // SolveSymmetricCG. A breakdown of the method (division by zero) is
+        // reported as nonconvergence.
+        static unsigned int SolveBiCGSTAB(CSRMatrix<Real> const& A, Real const* B,
+            Real* X, unsigned int maxIterations, Real tolerance,
+            Preconditioner preconditioner = Preconditioner::JACOBI,
+            size_t numThreads = 1, bool useInitialX = false)
+        {
+            int const N = A.GetNumRows();
+            LogAssert(A.GetNumCols() == N, "The matrix must be square.");
+            std::unique_ptr<TaskScheduler> scheduler;
+            if (numThreads > 1)
+            {
+                scheduler = std::make_unique<TaskScheduler>(numThreads);
+            }
+            SparsePreconditioner M(A, preconditioner);
+
+            std::vector<Real> R(N);
+            Real const threshold = InitialResidual(A, B, X, tolerance, useInitialX, scheduler.get(), R.data());
+            if (std::sqrt(Dot(N, R.data(), R.data())) <= threshold)
+            {
+                return 0;
+            }
+
+            std::vector<Real> RHat(R), P(N, (Real)0), V(N, (Real)0), PHat(N), S(N), SHat(N), T(N);
+            Real rho0 = (Real)1, alpha = (Real)1, omega = (Real)1;
+            for (unsigned int iteration = 1; iteration <= maxIterations; ++iteration)
+            {
+                Real rho1 = Dot(N, RHat.data(), R.data());
+                if (rho1 == (Real)0 || omega == (Real)0)
+                {
+                    break;
+                }
+
+                Real beta = (rho1 / rho0) * (alpha / omega);
+                for (int i = 0; i < N; ++i)
+                {
+                    P[i] = R[i] + beta * (P[i] - omega * V[i]);
+                }
+                M.Apply(P.data(), PHat.data(), scheduler.get());
+                A.Multiply(PHat.data(), V.data(), scheduler.get());
+                Real denom = Dot(N, RHat.data(), V.data());
+                if (denom == (Real)0)
+                {
+                    break;
+                }
+                alpha = rho1 / denom;
+                for (int i = 0; i < N; ++i)
+                {
+                    S[i] = R[i] - alpha * V[i];
+                }
+                if (std::sqrt(Dot(N, S.data(), S.data())) <= threshold)
+                {
+                    UpdateX(N, X, alpha, PHat.data());
+                    return iteration;
+                }
+
+                M.Apply(S.data(), SHat.data(), scheduler.get());
+                A.Multiply(SHat.data(), T.data(), scheduler.get());
+                Real tt = Dot(N, T.data(), T.data());
+                omega = (tt > (Real)0 ? Dot(N, T.data(), S.data()) / tt : (Real)0);
+                for (int i = 0; i < N; ++i)
+                {
+                    X[i] += alpha * PHat[i] + omega * SHat[i];
+                    R[i] = S[i] - omega * T[i];
+                }
+                if (std::sqrt(Dot(N, R.data(), R.data())) <= threshold)
+                {
+                    return iteration;
+                }
+                rho0 = rho1;
+            }
+            return maxIterations + 1;
+        }
+
     private:
+        // The preconditioner M of the CSRMatrix solvers, where Apply
+        // computes Z = M^{-1} * R.
+        class SparsePreconditioner
+        {
+        public:
+            SparsePreconditioner(CSRMatrix<Real> const& A, Preconditioner type)
+                :
+                mType(type),
+                mA(A)
+            {
+                int const N = A.GetNumRows();
+                if (mType == Preconditioner::JACOBI)
+                {
+                    A.GetDiagonal(mInvDiagonal);
+                    for (auto& d : mInvDiagonal)
+                    {
+                        d = (d != (Real)0 ? (Real)1 / d : (Real)1);
+                    }
+                }
+                else if (mType == Preconditioner::ILU0)
+                {
+                    // The factorization L*U, where L is unit lower
+                    // triangular, is stored in the values of A, with
+                    // mInvDiagonal the inverses of the diagonal of U.
+                    auto const& offsets = A.GetRowOffsets();
+                    auto const& columns = A.GetColumns();
+                    mLU = A.GetValues();
+                    mDiagonal.resize(N);
+                    mInvDiagonal.resize(N);
+                    std::vector<size_t> position(N, A.GetNumNonzeros());
+                    for (int r = 0; r < N; ++r)
+                    {
+                        size_t const end = offsets[static_cast<size_t>(r) + 1];
+                        for (size_t i = offsets[r]; i < end; ++i)
+                        {
+                            position[columns[i]] = i;
+                        }
+
+                        size_t i = offsets[r];
+                        for (; i < end && columns[i] < r; ++i)
+                        {
+                            int const k = columns[i];
+                            mLU[i] *= mInvDiagonal[k];
+                            Real const lik = mLU[i];
+                            size_t const kEnd = offsets[static_cast<size_t>(k) + 1];
+                            for (size_t j = mDiagonal[k] + 1; j < kEnd; ++j)
+                            {
+                                size_t const p = position[columns[j]];
+                                if (p < A.GetNumNonzeros())
+                                {
+                                    mLU[p] -= lik * mLU[j];
+                                }
+                            }
+                        }
+                        LogAssert(i < end && columns[i] == r && mLU[i] != (Real)0,
+                            "ILU0 requires nonzero pivots.");
+                        mDiagonal[r] = i;
+                        mInvDiagonal[r] = (Real)1 / mLU[i];
+
+                        for (i = offsets[r]; i < end; ++i)
+                        {
+                            position[columns[i]] = A.GetNumNonzeros();
+                        }
+                    }
+                }
+            }
+
+            void Apply(Real const* R, Real* Z, TaskScheduler* scheduler) const
+            {
+                int const N = mA.GetNumRows();
+                if (mType == Preconditioner::JACOBI)
+                {
+                    mA.ExecuteRows(scheduler, [this, R, Z](int r0, int r1)
+                    {
+                        for (int r = r0; r < r1; ++r)
+                        {
+                            Z[r] = mInvDiagonal[r] * R[r];
+                        }
+                    });
+                }
+                else if (mType == Preconditioner::ILU0)
+                {
+                    auto const& offsets = mA.GetRowOffsets();
+                    auto const& columns = mA.GetColumns();
+                    for (int r = 0; r < N; ++r)
+                    {
+                        Real sum = R[r];
+                        for (size_t i = offsets[r]; i < mDiagonal[r]; ++i)
+                        {
+                            sum -= mLU[i] * Z[columns[i]];
+                        }
+                        Z[r] = sum;
+                    }
+                    for (int r = N - 1; r >= 0; --r)
+                    {
+                        Real sum = Z[r];
+                        size_t const end = offsets[static_cast<size_t>(r) + 1];
+                        for (size_t i = mDiagonal[r] + 1; i < end; ++i)
+                        {
+                            sum -= mLU[i] * Z[columns[i]];
+                        }
+                        Z[r] = sum * mInvDiagonal[r];
+                    }
+                }
+                else
+                {
+                    std::copy(R, R + N, Z);
+                }
+            }
+
+        private:
+            Preconditioner mType;
+            CSRMatrix<Real> const& mA;
+            std::vector<Real> mInvDiagonal, mLU;
+            std::vector<size_t> mDiagonal;
+        };
+
+        // Compute R = B - A*X, setting X to zero when useInitialX is
+        // 'false', and return the residual threshold tolerance * |B|.
+        static Real InitialResidual(CSRMatrix<Real> const& A, Real const* B, Real* X,
+            Real tolerance, bool useInitialX, TaskScheduler* scheduler, Real* R)
+        {
+            int const N = A.GetNumRows();
+            if (useInitialX)
+            {
+                A.Multiply(X, R, scheduler);
+                for (int i = 0; i < N; ++i)
+                {
+                    R[i] = B[i] - R[i];
+                }
+            }
+            else
+            {
+                std::fill(X, X + N, (Real)0);
+                std::copy(B, B + N, R);
+            }
+            return std::sqrt(Dot(N, B, B)) * tolerance;
+        }
+
         // Support for the conjugate gradient method.
         static Real Dot(int N, Real const* U, Real const* V)
         {
@@ -0,0 +1,176 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+// A bounded multiple-producer multiple-consumer queue with the interface
+// of ThreadSafeQueue, but the operations do not lock a mutex. The queue is
+// a ring of cells, each with a sequence number that tells the producers
+// and consumers whether the cell is free or full for the position they
+// claimed. A thread claims a position with a compare-exchange on the
+// enqueue or dequeue counter, so the only contention is between threads
+// on the same end of the queue. The algorithm is the one by Dmitry Vyukov,
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//
+// The Element type must be default constructible and assignable. Push
+// copies the element into its cell and Pop moves it out of the cell.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gte
+{
+    template <typename Element>
+    class LockFreeQueue
+    {
+    public:
+        // Construction and destruction. The capacity is fixed; as with
+        // ThreadSafeQueue, a queue with maxNumElements of 0 rejects every
+        // Push.
+        LockFreeQueue(size_t maxNumElements = 0)
+            :
+            mMaxNumElements(maxNumElements),
+            mCells(maxNumElements),
+            mEnqueuePosition(0),
+            mDequeuePosition(0)
+        {
+            for (size_t i = 0; i < mMaxNumElements; ++i)
+            {
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        virtual ~LockFreeQueue() = default;
+
+        // All the operations are thread-safe.
+        size_t GetMaxNumElements() const
+        {
+            return mMaxNumElements;
+        }
+
+        // The number of elements is a snapshot that is exact only when no
+        // other thread is pushing or popping.
+        size_t GetNumElements() const
+        {
+            size_t dequeuePosition = mDequeuePosition.load(std::memory_order_acquire);
+            size_t enqueuePosition = mEnqueuePosition.load(std::memory_order_acquire);
+            if (enqueuePosition > dequeuePosition)
+            {
+                size_t numElements = enqueuePosition - dequeuePosition;
+                return (numElements < mMaxNumElements ? numElements : mMaxNumElements);
+            }
+            return 0;
+        }
+
+        bool Push(Element const& element)
+        {
+            if (mMaxNumElements == 0)
+            {
+                return false;
+            }
+
+            Cell* cell;
+            size_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &mCells[position % mMaxNumElements];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) -
+                    static_cast<intptr_t>(position);
+                if (difference == 0)
+                {
+                    // The cell is free for this position. On failure the
+                    // compare-exchange loads the current position.
+                    if (mEnqueuePosition.compare_exchange_weak(position,
+                        position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // The cell still holds the element pushed one lap
+                    // earlier, so the queue is full.
+                    return false;
+                }
+                else
+                {
+                    // Another producer claimed the position.
+                    position = mEnqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->element = element;
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool Pop(Element& element)
+        {
+            if (mMaxNumElements == 0)
+            {
+                return false;
+            }
+
+            Cell* cell;
+            size_t position = mDequeuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &mCells[position % mMaxNumElements];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) -
+                    static_cast<intptr_t>(position + 1);
+                if (difference == 0)
+                {
+                    if (mDequeuePosition.compare_exchange_weak(position,
+                        position + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (difference < 0)
+                {
+                    // No element has been pushed for this position, so the
+                    // queue is empty.
+                    return false;
+                }
+                else
+                {
+                    position = mDequeuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            element = std::move(cell->element);
+            cell->sequence.store(position + mMaxNumElements, std::memory_order_release);
+            return true;
+        }
+
+    protected:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            Element element;
+        };
+
+        // The counters are padded to separate cache lines so that the
+        // producers and the consumers do not invalidate each other's line.
+        // Padding is used rather than alignas, because C++14 operator new
+        // does not honor alignments larger than that of std::max_align_t.
+        enum { CACHE_LINE_SIZE = 64 };
+
+        size_t mMaxNumElements;
+        std::vector<Cell> mCells;
+        char mPad0[CACHE_LINE_SIZE];
+        std::atomic<size_t> mEnqueuePosition;
+        char mPad1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t> mDequeuePosition;
+        char mPad2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -12,50 +12,41 @@
 
 namespace gte
 {
+    // The file is kept open and the messages are written to the buffer of
+    // the stream rather than opening and closing the file for each message.
+    // The buffer is written to the file when it is full, when Flush is
+    // called (Logger calls it after assertions and errors and in
+    // Logger::Flush) and when the listener is destroyed.
     class LogToFile : public Logger::Listener
     {
     public:
         LogToFile(std::string const& filename, int flags)
             :
             Logger::Listener(flags),
-            mFilename(filename)
+            mLogFile(filename)
         {
-            std::ofstream logFile(filename);
-            if (logFile)
-            {
-                // This clears the file contents from any previous runs.
-                logFile.close();
-            }
-            else
+            // Opening the file clears its contents from any previous runs.
+            // If the file cannot be opened, the stream is in a failed state
+            // and Report does not attempt to write to it.
+        }
+
+        virtual void Flush() override
+        {
+            if (mLogFile)
             {
-                // The file cannot be opened.  Use a null string for Report to
-                // know not to attempt opening the file for append.
-                mFilename = "";
+                mLogFile.flush();
             }
         }
 
     private:
         virtual void Report(std::string const& message)
         {
-            if (mFilename != "")
+            if (mLogFile)
             {
-                // Open for append.
-                std::ofstream logFile(mFilename, std::ios_base::out | std::ios_base::app);
-                if (logFile)
-                {
-                    logFile << message.c_str();
-                    logFile.close();
-                }
-                else
-                {
-                    // The file cannot be opened.  Use a null string for
-                    // Report not to attempt opening the file for append on
-                    // the next call.
-                    mFilename = "";
-                }
+                mLogFile << message.c_str();
             }
         }
 
-        std::string mFilename;
+        std::ofstream mLogFile;
     };
 }
@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <set>
 #include <stdexcept>
@@ -14,6 +15,10 @@
 
 namespace gte
 {
+    // The asynchronous mode of Logger, which is implemented in
+    // LoggerAsync.h.
+    class LoggerAsync;
+
     class Logger
     {
     public:
@@ -67,6 +72,14 @@ namespace gte
                 Report("\nGTE INFORMATION:\n" + message);
             }
 
+            // Write any buffered messages to their destination.  Logger
+            // calls this after an assertion or an error, which are followed
+            // by an exception, and in Logger::Flush.
+            virtual void Flush()
+            {
+                // Stub for derived classes.
+            }
+
         private:
             virtual void Report(std::string const& message)
             {
@@ -89,56 +102,39 @@ namespace gte
                 message + "\n\n";
         }
 
-        // Notify current listeners about the logged information.
+        // Notify current listeners about the logged information.  In
+        // asynchronous mode (see LoggerAsync), warnings and information are
+        // queued for the logging thread.  Assertions and errors are followed
+        // by an exception, so they are always reported before returning,
+        // after the queued messages are delivered.
         void Assertion()
         {
-            Mutex().lock();
-            for (auto listener : Listeners())
-            {
-                if (listener->GetFlags() & Listener::LISTEN_FOR_ASSERTION)
-                {
-                    listener->Assertion(mMessage);
-                }
-            }
-            Mutex().unlock();
+            ReportNow(Listener::LISTEN_FOR_ASSERTION, mMessage);
         }
 
         void Error()
         {
-            Mutex().lock();
-            for (auto listener : Listeners())
-            {
-                if (listener->GetFlags() & Listener::LISTEN_FOR_ERROR)
-                {
-                    listener->Error(mMessage);
-                }
-            }
-            Mutex().unlock();
+            ReportNow(Listener::LISTEN_FOR_ERROR, mMessage);
         }
 
         void Warning()
         {
-            Mutex().lock();
-            for (auto listener : Listeners())
+            if (!Post(Listener::LISTEN_FOR_WARNING, mMessage))
             {
-                if (listener->GetFlags() & Listener::LISTEN_FOR_WARNING)
-                {
-                    listener->Warning(mMessage);
-                }
+                Mutex().lock();
+                Dispatch(Listener::LISTEN_FOR_WARNING, mMessage);
+                Mutex().unlock();
             }
-            Mutex().unlock();
         }
+
         void Information()
         {
-            Mutex().lock();
-            for (auto listener : Listeners())
+            if (!Post(Listener::LISTEN_FOR_INFORMATION, mMessage))
             {
-                if (listener->GetFlags() & Listener::LISTEN_FOR_INFORMATION)
-                {
-                    listener->Information(mMessage);
-                }
+                Mutex().lock();
+                Dispatch(Listener::LISTEN_FOR_INFORMATION, mMessage);
+                Mutex().unlock();
             }
-            Mutex().unlock();
         }
 
         static void Subscribe(Listener* listener)
@@ -155,10 +151,98 @@ namespace gte
             Mutex().unlock();
         }
 
+        // Deliver the queued messages, including the pending summaries, and
+        // then call Flush for all listeners.
+        static void Flush()
+        {
+            Mutex().lock();
+            AsyncHook const* hook = Hook().load(std::memory_order_acquire);
+            if (hook)
+            {
+                hook->drain(false);
+            }
+            FlushListeners();
+            Mutex().unlock();
+        }
 
     private:
+        friend class LoggerAsync;
+
         std::string mMessage;
 
+        // The functions by which LoggerAsync queues the warnings and the
+        // information and delivers the queued messages.  The hook is
+        // installed while the logging thread runs.  The drain function
+        // must be called with Mutex() locked; it reports the counts of the
+        // repeated, suppressed and dropped messages, and it ends the
+        // sequence of identical messages when 'reset' is true.
+        struct AsyncHook
+        {
+            void (*post)(int type, std::string const& message);
+            void (*drain)(bool reset);
+        };
+
+        // Queue the message when in asynchronous mode.  The return value is
+        // false when the message must be reported by the caller.
+        static bool Post(int type, std::string const& message)
+        {
+            AsyncHook const* hook = Hook().load(std::memory_order_acquire);
+            if (hook)
+            {
+                hook->post(type, message);
+                return true;
+            }
+            return false;
+        }
+
+        static void ReportNow(int type, std::string const& message)
+        {
+            Mutex().lock();
+            AsyncHook const* hook = Hook().load(std::memory_order_acquire);
+            if (hook)
+            {
+                hook->drain(true);
+            }
+            Dispatch(type, message);
+            FlushListeners();
+            Mutex().unlock();
+        }
+
+        // The caller must lock Mutex().
+        static void Dispatch(int type, std::string const& message)
+        {
+            for (auto listener : Listeners())
+            {
+                if (listener->GetFlags() & type)
+                {
+                    switch (type)
+                    {
+                    case Listener::LISTEN_FOR_ASSERTION:
+                        listener->Assertion(message);
+                        break;
+                    case Listener::LISTEN_FOR_ERROR:
+                        listener->Error(message);
+                        break;
+                    case Listener::LISTEN_FOR_WARNING:
+                        listener->Warning(message);
+                        break;
+                    case Listener::LISTEN_FOR_INFORMATION:
+                        listener->Information(message);
+                        break;
+                    }
+                }
+            }
+        }
+
+        // The caller must lock Mutex().
+        static void FlushListeners()
+        {
+            for (auto listener : Listeners())
+            {
+                listener->Flush();
+            }
+        }
+
         static std::mutex& Mutex()
         {
             static std::mutex sMutex;
@@ -170,6 +254,12 @@ namespace gte
             static std::set<Listener*> sListeners;
             return sListeners;
         }
+
+        static std::atomic<AsyncHook const*>& Hook()
+        {
+            static std::atomic<AsyncHook const*> sHook(nullptr);
+            return sHook;
+        }
     };
 
 }
@@ -0,0 +1,275 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/LockFreeQueue.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Support for asynchronous logging.  By default the listeners of Logger are
+// called by the thread that logs the message, under a mutex shared by all
+// threads.  In asynchronous mode, a warning or information message is
+// pushed onto a lock-free queue and a logging thread delivers the queued
+// messages to the listeners every drainMilliseconds.  When the queue is
+// full, the message is dropped rather than blocking the caller, and the
+// number of dropped messages is reported later.  The logging thread also
+//   1. collapses consecutive identical messages (same type, file,
+//      function, line and text) into a single report followed by
+//      "The previous message was repeated N times", and
+//   2. when maxMessagesPerSecond is positive, reports at most that many
+//      distinct messages per second and the number of suppressed messages
+//      at the end of each second.
+// The summaries are reported as warnings.  Assertions and errors are
+// followed by an exception, so they are reported by the calling thread
+// after it delivers the queued messages.  Logger::Flush also delivers the
+// queued messages before it flushes the listeners.
+//
+// Switch the mode only when no other thread is logging.  Disabling the
+// mode stops the logging thread after it delivers the queued messages.
+
+namespace gte
+{
+    class LoggerAsync
+    {
+    public:
+        static void SetAsynchronous(bool enable, size_t maxQueueElements = 4096,
+            size_t maxMessagesPerSecond = 0, unsigned int drainMilliseconds = 10)
+        {
+            State& state = GetState();
+            state.Stop();
+            if (enable)
+            {
+                state.Start(maxQueueElements, maxMessagesPerSecond, drainMilliseconds);
+            }
+        }
+
+        static bool IsAsynchronous()
+        {
+            return Logger::Hook().load(std::memory_order_acquire) != nullptr;
+        }
+
+    private:
+        typedef Logger::Listener Listener;
+
+        // A queued message.  The type is one of the Listener::LISTEN_FOR_*
+        // flags.
+        struct Entry
+        {
+            Entry()
+                :
+                type(Listener::LISTEN_FOR_NOTHING)
+            {
+            }
+
+            int type;
+            std::string message;
+        };
+
+        class State
+        {
+        public:
+            State()
+                :
+                mRunning(false),
+                mNumDropped(0),
+                mMaxMessagesPerSecond(0),
+                mDrainMilliseconds(0),
+                mLastType(Listener::LISTEN_FOR_NOTHING),
+                mNumRepeats(0),
+                mNumReported(0),
+                mNumSuppressed(0)
+            {
+                // The mutex, the listeners and the hook must outlive this
+                // object, whose destructor stops the logging thread and
+                // delivers the queued messages.
+                Logger::Mutex();
+                Logger::Listeners();
+                Logger::Hook();
+            }
+
+            ~State()
+            {
+                Stop();
+            }
+
+            void Start(size_t maxQueueElements, size_t maxMessagesPerSecond,
+                unsigned int drainMilliseconds)
+            {
+                static Logger::AsyncHook const hook = { &LoggerAsync::Post, &LoggerAsync::Drain };
+
+                mQueue = std::make_unique<LockFreeQueue<Entry>>(maxQueueElements);
+                mNumDropped.store(0, std::memory_order_relaxed);
+                mMaxMessagesPerSecond = maxMessagesPerSecond;
+                mDrainMilliseconds = drainMilliseconds;
+                mWindowStart = std::chrono::steady_clock::now();
+                mNumReported = 0;
+                mRunning.store(true, std::memory_order_release);
+                mThread = std::thread([this]() { Run(); });
+                Logger::Hook().store(&hook, std::memory_order_release);
+            }
+
+            void Stop()
+            {
+                if (mRunning.load(std::memory_order_acquire))
+                {
+                    Logger::Hook().store(nullptr, std::memory_order_release);
+                    mRunning.store(false, std::memory_order_release);
+                    mThread.join();
+                    Logger::Mutex().lock();
+                    Drain(true);
+                    Logger::FlushListeners();
+                    Logger::Mutex().unlock();
+                }
+            }
+
+            void Push(int type, std::string const& message)
+            {
+                Entry entry;
+                entry.type = type;
+                entry.message = message;
+                if (!mQueue->Push(entry))
+                {
+                    mNumDropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            // Deliver the queued messages to the listeners.  The caller must
+            // lock Logger::Mutex().  When summarize is true or a rate-limit
+            // window has elapsed, the counts of the repeated, suppressed and
+            // dropped messages are reported.
+            void Drain(bool summarize)
+            {
+                if (!mQueue)
+                {
+                    return;
+                }
+
+                auto now = std::chrono::steady_clock::now();
+                if (now - mWindowStart >= std::chrono::seconds(1))
+                {
+                    summarize = true;
+                    mWindowStart = now;
+                    mNumReported = 0;
+                }
+
+                Entry entry;
+                while (mQueue->Pop(entry))
+                {
+                    if (entry.type == mLastType && entry.message == mLastMessage)
+                    {
+                        ++mNumRepeats;
+                        continue;
+                    }
+
+                    if (mMaxMessagesPerSecond > 0 && mNumReported >= mMaxMessagesPerSecond)
+                    {
+                        ++mNumSuppressed;
+                        continue;
+                    }
+
+                    ReportRepeats();
+                    Logger::Dispatch(entry.type, entry.message);
+                    ++mNumReported;
+                    mLastType = entry.type;
+                    mLastMessage = std::move(entry.message);
+                }
+
+                if (summarize)
+                {
+                    ReportRepeats();
+
+                    if (mNumSuppressed > 0)
+                    {
+                        Logger::Dispatch(Listener::LISTEN_FOR_WARNING, std::to_string(mNumSuppressed) +
+                            " messages were suppressed by the rate limit.\n\n");
+                        mNumSuppressed = 0;
+                    }
+
+                    size_t dropped = mNumDropped.exchange(0, std::memory_order_relaxed);
+                    if (dropped > 0)
+                    {
+                        Logger::Dispatch(Listener::LISTEN_FOR_WARNING, std::to_string(dropped) +
+                            " messages were dropped because the log queue was full.\n\n");
+                    }
+                }
+            }
+
+            // A message reported directly (an assertion or an error) ends
+            // the sequence of identical messages.
+            void ResetLastMessage()
+            {
+                mLastType = Listener::LISTEN_FOR_NOTHING;
+                mLastMessage.clear();
+            }
+
+        private:
+            void Run()
+            {
+                while (mRunning.load(std::memory_order_acquire))
+                {
+                    Logger::Mutex().lock();
+                    Drain(false);
+                    Logger::Mutex().unlock();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(mDrainMilliseconds));
+                }
+            }
+
+            void ReportRepeats()
+            {
+                if (mNumRepeats > 0)
+                {
+                    Logger::Dispatch(mLastType, "The previous message was repeated " +
+                        std::to_string(mNumRepeats) + " times.\n\n");
+                    mNumRepeats = 0;
+                }
+            }
+
+            std::atomic<bool> mRunning;
+            std::atomic<size_t> mNumDropped;
+            std::unique_ptr<LockFreeQueue<Entry>> mQueue;
+            std::thread mThread;
+            size_t mMaxMessagesPerSecond;
+            unsigned int mDrainMilliseconds;
+
+            // The state of the deduplication and the rate limiting, which
+            // are accessed only while Logger::Mutex() is locked.
+            int mLastType;
+            std::string mLastMessage;
+            size_t mNumRepeats;
+            std::chrono::steady_clock::time_point mWindowStart;
+            size_t mNumReported;
+            size_t mNumSuppressed;
+        };
+
+        // The functions of the Logger hook.
+        static void Post(int type, std::string const& message)
+        {
+            GetState().Push(type, message);
+        }
+
+        static void Drain(bool reset)
+        {
+            State& state = GetState();
+            state.Drain(true);
+            if (reset)
+            {
+                state.ResetLastMessage();
+            }
+        }
+
+        static State& GetState()
+        {
+            static State sState;
+            return sState;
+        }
+    };
+}
@@ -3,13 +3,32 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/ParticleSystem.h>
+#include <Mathematics/LinearSystem.h>
 #include <set>
 
+// The springs are integrated by the Runge-Kutta fourth-order solver of
+// ParticleSystem or by the linearized backward Euler method of
+//   D. Baraff and A. Witkin, Large steps in cloth simulation, Proceedings
+//   of SIGGRAPH 98, 43-54
+// Stiff springs require small time steps for the explicit solver to be
+// stable. The implicit step is stable for large time steps. Each step solves
+// the sparse linear system
+//   (M - h^2*K)*dV = h*(F + h*K*V)
+// for the change dV in velocity, where h is the time step, M is the diagonal
+// mass matrix, F are the forces at the current state and K is the Jacobian
+// of the spring forces with respect to the positions. The velocity is
+// V + dV and the position is X + h*(V + dV). The terms of K for compressed
+// springs that make M - h^2*K indefinite are discarded, as is common
+// practice, so the system is symmetric positive definite and is solved by
+// the Jacobi-preconditioned conjugate gradient method of LinearSystem. The
+// external accelerations are treated explicitly. The implicit method damps
+// the oscillations of the springs, more so for larger time steps.
+
 namespace gte
 {
     template <int N, typename Real>
@@ -26,10 +45,23 @@ namespace gte
             :
             ParticleSystem<N, Real>(numParticles, step),
             mSpring(numSprings, Spring()),
-            mAdjacent(numParticles)
+            mAdjacent(numParticles),
+            mIntegrator(Integrator::RUNGE_KUTTA),
+            mMaxIterations(0),
+            mTolerance((Real)0),
+            mNumThreads(1),
+            mNumIterations(0),
+            mStructureChanged(true)
         {
         }
 
+        // The integrators of Update(...).
+        enum class Integrator
+        {
+            RUNGE_KUTTA,
+            BACKWARD_EULER
+        };
+
         struct Spring
         {
             Spring()
@@ -56,6 +88,7 @@ namespace gte
             mSpring[index] = spring;
             mAdjacent[spring.particle0].insert(index);
             mAdjacent[spring.particle1].insert(index);
+            mStructureChanged = true;
         }
 
         inline Spring const& GetSpring(int index) const
@@ -63,6 +96,44 @@ namespace gte
             return mSpring[index];
         }
 
+        // Select the integrator. The parameters of the conjugate gradient
+        // solver are used only by BACKWARD_EULER. The iterations terminate
+        // when the residual satisfies |B - A*X| <= tolerance * |B| or after
+        // maxIterations iterations, and the matrix-vector products are
+        // computed by numThreads threads.
+        void SetIntegrator(Integrator integrator, unsigned int maxIterations = 100,
+            Real tolerance = (Real)1e-06, size_t numThreads = 1)
+        {
+            mIntegrator = integrator;
+            mMaxIterations = maxIterations;
+            mTolerance = tolerance;
+            mNumThreads = numThreads;
+        }
+
+        inline Integrator GetIntegrator() const
+        {
+            return mIntegrator;
+        }
+
+        // The number of conjugate gradient iterations of the last implicit
+        // step, which is maxIterations + 1 when the solver did not converge.
+        inline unsigned int GetNumIterations() const
+        {
+            return mNumIterations;
+        }
+
+        virtual void Update(Real time) override
+        {
+            if (mIntegrator == Integrator::BACKWARD_EULER)
+            {
+                UpdateBackwardEuler(time);
+            }
+            else
+            {
+                ParticleSystem<N, Real>::Update(time);
+            }
+        }
+
         // The default external force is zero.  Derive a class from this one
         // to provide nonzero external forces such as gravity, wind, friction,
         // and so on.  This function is called by Acceleration(...) to compute
@@ -111,11 +182,203 @@ namespace gte
             return acceleration;
         }
 
+        void UpdateBackwardEuler(Real time)
+        {
+            if (mStructureChanged)
+            {
+                CreateSystem();
+                mStructureChanged = false;
+            }
+
+            // The rows and columns of the immovable particles are those of
+            // the identity matrix and their right-hand sides are zero, so
+            // their velocities do not change.
+            int const numParticles = this->mNumParticles;
+            Real const h = this->mStep, hh = h * h;
+            std::vector<Real>& values = mSystem.GetValues();
+            std::fill(values.begin(), values.end(), (Real)0);
+            for (int i = 0; i < numParticles; ++i)
+            {
+                bool const movable = (this->mInvMass[i] > (Real)0);
+                Vector<N, Real> force = Vector<N, Real>::Zero();
+                if (movable)
+                {
+                    force = this->mMass[i] * ExternalAcceleration(i, time,
+                        this->mPosition, this->mVelocity);
+                }
+                for (int d = 0; d < N; ++d)
+                {
+                    values[mDiagonalIndex[N * i + d]] = (movable ? this->mMass[i] : (Real)1);
+                    mRHS[N * i + d] = h * force[d];
+                }
+            }
+
+            for (size_t s = 0; s < mSpring.size(); ++s)
+            {
+                Spring const& spring = mSpring[s];
+                int const i0 = spring.particle0, i1 = spring.particle1;
+                bool const movable0 = (this->mInvMass[i0] > (Real)0);
+                bool const movable1 = (this->mInvMass[i1] > (Real)0);
+                Vector<N, Real> diff = this->mPosition[i1] - this->mPosition[i0];
+                Real length = Length(diff);
+                if (length == (Real)0 || (!movable0 && !movable1))
+                {
+                    continue;
+                }
+
+                // The force on particle i0 is F = k*(1-L/|D|)*D for
+                // D = X[i1] - X[i0], and its derivative with respect to
+                // X[i1] is the matrix J = k*(U*U^T + (1-L/|D|)*(I-U*U^T))
+                // with U = D/|D|. The derivatives of the force on i0 with
+                // respect to X[i0] and of the force on i1 with respect to
+                // X[i1] are -J, and that of the force on i1 with respect to
+                // X[i0] is J.
+                Real const ratio = spring.length / length;
+                Vector<N, Real> force = (spring.constant * ((Real)1 - ratio)) * diff;
+                Vector<N, Real> unit = diff / length;
+                Real const tangent = spring.constant * std::max((Real)1 - ratio, (Real)0);
+                std::array<std::array<Real, N>, N> J;
+                for (int r = 0; r < N; ++r)
+                {
+                    for (int c = 0; c < N; ++c)
+                    {
+                        J[r][c] = (spring.constant - tangent) * unit[r] * unit[c];
+                    }
+                    J[r][r] += tangent;
+                }
+
+                // The impulse is h*(F + h*J*(V[i1] - V[i0])) for particle i0
+                // and its negation for particle i1.
+                Vector<N, Real> dV = this->mVelocity[i1] - this->mVelocity[i0];
+                size_t const* index = &mSpringIndex[4 * N * s];
+                for (int r = 0; r < N; ++r)
+                {
+                    Real impulse = force[r];
+                    for (int c = 0; c < N; ++c)
+                    {
+                        impulse += h * J[r][c] * dV[c];
+                    }
+                    impulse *= h;
+
+                    if (movable0)
+                    {
+                        mRHS[N * i0 + r] += impulse;
+                        for (int c = 0; c < N; ++c)
+                        {
+                            values[index[r] + c] += hh * J[r][c];
+                            if (movable1)
+                            {
+                                values[index[N + r] + c] -= hh * J[r][c];
+                            }
+                        }
+                    }
+                    if (movable1)
+                    {
+                        mRHS[N * i1 + r] -= impulse;
+                        for (int c = 0; c < N; ++c)
+                        {
+                            values[index[2 * N + r] + c] += hh * J[r][c];
+                            if (movable0)
+                            {
+                                values[index[3 * N + r] + c] -= hh * J[r][c];
+                            }
+                        }
+                    }
+                }
+            }
+
+            // The change in velocity of the previous step is the initial
+            // guess.
+            mNumIterations = LinearSystem<Real>::SolveSymmetricCG(mSystem, mRHS.data(),
+                mDeltaV.data(), mMaxIterations, mTolerance,
+                LinearSystem<Real>::Preconditioner::JACOBI, mNumThreads, true);
+
+            for (int i = 0; i < numParticles; ++i)
+            {
+                if (this->mInvMass[i] > (Real)0)
+                {
+                    for (int d = 0; d < N; ++d)
+                    {
+                        this->mVelocity[i][d] += mDeltaV[N * i + d];
+                    }
+                    this->mPosition[i] += h * this->mVelocity[i];
+                }
+            }
+        }
+
+        // Create the sparsity structure of the linear system, which has an
+        // NxN block for each particle and for each pair of particles
+        // connected by a spring, and look up the indices of the blocks.
+        void CreateSystem()
+        {
+            int const numParticles = this->mNumParticles;
+            using Triplet = typename CSRMatrix<Real>::Triplet;
+            std::vector<Triplet> triplets;
+            triplets.reserve(N * N * (static_cast<size_t>(numParticles) + 2 * mSpring.size()));
+            auto AddBlock = [&triplets](int i0, int i1)
+            {
+                for (int r = 0; r < N; ++r)
+                {
+                    for (int c = 0; c < N; ++c)
+                    {
+                        triplets.push_back(Triplet(N * i0 + r, N * i1 + c, (Real)0));
+                    }
+                }
+            };
+            for (int i = 0; i < numParticles; ++i)
+            {
+                AddBlock(i, i);
+            }
+            for (auto const& spring : mSpring)
+            {
+                AddBlock(spring.particle0, spring.particle1);
+                AddBlock(spring.particle1, spring.particle0);
+            }
+            mSystem.Create(N * numParticles, N * numParticles, triplets);
+
+            // The blocks are stored with their rows consecutive within the
+            // rows of the matrix, so the entry (r,c) of a block is at the
+            // index of its entry (r,0) plus c.
+            mDiagonalIndex.resize(N * static_cast<size_t>(numParticles));
+            for (int i = 0; i < N * numParticles; ++i)
+            {
+                mDiagonalIndex[i] = mSystem.GetIndex(i, i);
+            }
+            mSpringIndex.resize(4 * N * mSpring.size());
+            for (size_t s = 0; s < mSpring.size(); ++s)
+            {
+                int const i0 = mSpring[s].particle0, i1 = mSpring[s].particle1;
+                size_t* index = &mSpringIndex[4 * N * s];
+                for (int r = 0; r < N; ++r)
+                {
+                    index[r] = mSystem.GetIndex(N * i0 + r, N * i0);
+                    index[N + r] = mSystem.GetIndex(N * i0 + r, N * i1);
+                    index[2 * N + r] = mSystem.GetIndex(N * i1 + r, N * i1);
+                    index[3 * N + r] = mSystem.GetIndex(N * i1 + r, N * i0);
+                }
+            }
+
+            mRHS.assign(N * static_cast<size_t>(numParticles), (Real)0);
+            mDeltaV.assign(N * static_cast<size_t>(numParticles), (Real)0);
+        }
+
         std::vector<Spring> mSpring;
 
         // Each particle has an associated array of spring indices for those
         // springs adjacent to the particle.  The set elements are spring
         // indices, not indices of adjacent particles.
         std::vector<std::set<int>> mAdjacent;
+
+        // Support for the implicit integrator. The linear system is created
+        // by the first implicit step after the springs are modified.
+        Integrator mIntegrator;
+        unsigned int mMaxIterations;
+        Real mTolerance;
+        size_t mNumThreads;
+        unsigned int mNumIterations;
+        bool mStructureChanged;
+        CSRMatrix<Real> mSystem;
+        std::vector<size_t> mDiagonalIndex, mSpringIndex;
+        std::vector<Real> mRHS, mDeltaV;
     };
 }
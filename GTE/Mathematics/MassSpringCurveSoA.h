@@ -0,0 +1,102 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/ParticleSystemSoA.h>
+#include <type_traits>
+
+// The MassSpringCurve system for large numbers of particles, using the
+// structure-of-arrays storage and the multithreaded solver of
+// ParticleSystemSoA. The external acceleration is provided as described in
+// MassSpringSurfaceSoA.h.
+
+namespace gte
+{
+    template <int N, typename Real, typename Derived = void>
+    class MassSpringCurveSoA : public ParticleSystemSoA<N, Real,
+        typename std::conditional<std::is_void<Derived>::value,
+        MassSpringCurveSoA<N, Real, Derived>, Derived>::type>
+    {
+    public:
+        using Self = typename std::conditional<std::is_void<Derived>::value,
+            MassSpringCurveSoA<N, Real, Derived>, Derived>::type;
+        using Base = ParticleSystemSoA<N, Real, Self>;
+        friend Base;
+
+        // Construction. This class represents a set of N-1 springs
+        // connecting N masses that lie on a curve.
+        MassSpringCurveSoA(int numParticles, Real step)
+            :
+            Base(numParticles, step),
+            mConstant(numParticles - 1, (Real)0),
+            mLength(numParticles - 1, (Real)0)
+        {
+        }
+
+        // Member access. The parameters are spring constant and spring
+        // resting length.
+        inline int GetNumSprings() const
+        {
+            return this->mNumParticles - 1;
+        }
+
+        inline void SetConstant(int i, Real constant)
+        {
+            mConstant[i] = constant;
+        }
+
+        inline void SetLength(int i, Real length)
+        {
+            mLength[i] = length;
+        }
+
+        inline Real const& GetConstant(int i) const
+        {
+            return mConstant[i];
+        }
+
+        inline Real const& GetLength(int i) const
+        {
+            return mLength[i];
+        }
+
+        // The default external force is zero. The function must set
+        // acceleration[d][i] for imin <= i < imax to the impulse F/m
+        // generated by the external force F. It is called concurrently for
+        // disjoint blocks of particles.
+        void ExternalAcceleration(int imin, int imax, Real,
+            std::array<Real const*, N> const&, std::array<Real const*, N> const&,
+            std::array<Real*, N> const& acceleration)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                std::fill(acceleration[d] + imin, acceleration[d] + imax, (Real)0);
+            }
+        }
+
+    protected:
+        // Compute the accelerations of the particles imin <= i < imax. The
+        // endpoints of the curve have only one spring attached, which is
+        // handled by clipping the ranges of the springs.
+        void Acceleration(int imin, int imax, Real time,
+            std::array<Real const*, N> const& position,
+            std::array<Real const*, N> const& velocity,
+            std::array<Real*, N> const& acceleration)
+        {
+            static_cast<Self*>(this)->ExternalAcceleration(imin, imax, time, position,
+                velocity, acceleration);
+
+            this->AddSpringAccelerations(std::max(imin, 1), imax, -1, -1,
+                mConstant.data(), mLength.data(), position, acceleration);
+            this->AddSpringAccelerations(imin, std::min(imax, this->mNumParticles - 1), 1, 0,
+                mConstant.data(), mLength.data(), position, acceleration);
+        }
+
+        std::vector<Real> mConstant, mLength;
+    };
+}
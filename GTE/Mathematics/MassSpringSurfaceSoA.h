@@ -0,0 +1,196 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/ParticleSystemSoA.h>
+#include <type_traits>
+
+// The MassSpringSurface system for large numbers of particles, using the
+// structure-of-arrays storage and the multithreaded solver of
+// ParticleSystemSoA. The masses, springs and indexing are those of
+// MassSpringSurface. The external acceleration is provided by a class
+// Derived that derives from MassSpringSurfaceSoA<N, Real, Derived> and
+// has a public member function ExternalAcceleration with the signature of
+// the one of this class, which hides it. The default Derived = void uses
+// the zero external acceleration.
+
+namespace gte
+{
+    template <int N, typename Real, typename Derived = void>
+    class MassSpringSurfaceSoA : public ParticleSystemSoA<N, Real,
+        typename std::conditional<std::is_void<Derived>::value,
+        MassSpringSurfaceSoA<N, Real, Derived>, Derived>::type>
+    {
+    public:
+        using Self = typename std::conditional<std::is_void<Derived>::value,
+            MassSpringSurfaceSoA<N, Real, Derived>, Derived>::type;
+        using Base = ParticleSystemSoA<N, Real, Self>;
+        friend Base;
+
+        // Construction. This class represents an RxC array of masses lying
+        // on a surface and connected by an array of springs. The masses are
+        // arranged in row-major order: position[c+C*r] = X[r][c] for
+        // 0 <= r < R and 0 <= c < C.
+        MassSpringSurfaceSoA(int numRows, int numCols, Real step)
+            :
+            Base(numRows * numCols, step),
+            mNumRows(numRows),
+            mNumCols(numCols),
+            mConstantR(numRows * numCols, (Real)0),
+            mLengthR(numRows * numCols, (Real)0),
+            mConstantC(numRows * numCols, (Real)0),
+            mLengthC(numRows * numCols, (Real)0)
+        {
+        }
+
+        // Member access.
+        inline int GetNumRows() const
+        {
+            return mNumRows;
+        }
+
+        inline int GetNumCols() const
+        {
+            return mNumCols;
+        }
+
+        inline void SetMass(int r, int c, Real mass)
+        {
+            Base::SetMass(GetIndex(r, c), mass);
+        }
+
+        inline void SetPosition(int r, int c, Vector<N, Real> const& position)
+        {
+            Base::SetPosition(GetIndex(r, c), position);
+        }
+
+        inline void SetVelocity(int r, int c, Vector<N, Real> const& velocity)
+        {
+            Base::SetVelocity(GetIndex(r, c), velocity);
+        }
+
+        inline Real const& GetMass(int r, int c) const
+        {
+            return Base::GetMass(GetIndex(r, c));
+        }
+
+        inline Vector<N, Real> GetPosition(int r, int c) const
+        {
+            return Base::GetPosition(GetIndex(r, c));
+        }
+
+        inline Vector<N, Real> GetVelocity(int r, int c) const
+        {
+            return Base::GetVelocity(GetIndex(r, c));
+        }
+
+        // The mass at (r,c) provides access to the springs connecting to
+        // locations (r,c+1) and (r+1,c), as in MassSpringSurface.
+
+        // to (r+1,c)
+        inline void SetConstantR(int r, int c, Real constant)
+        {
+            mConstantR[GetIndex(r, c)] = constant;
+        }
+
+        // to (r+1,c)
+        inline void SetLengthR(int r, int c, Real length)
+        {
+            mLengthR[GetIndex(r, c)] = length;
+        }
+
+        // to (r,c+1)
+        inline void SetConstantC(int r, int c, Real constant)
+        {
+            mConstantC[GetIndex(r, c)] = constant;
+        }
+
+        // to (r,c+1)
+        inline void SetLengthC(int r, int c, Real length)
+        {
+            mLengthC[GetIndex(r, c)] = length;
+        }
+
+        inline Real const& GetConstantR(int r, int c) const
+        {
+            return mConstantR[GetIndex(r, c)];
+        }
+
+        inline Real const& GetLengthR(int r, int c) const
+        {
+            return mLengthR[GetIndex(r, c)];
+        }
+
+        inline Real const& GetConstantC(int r, int c) const
+        {
+            return mConstantC[GetIndex(r, c)];
+        }
+
+        inline Real const& GetLengthC(int r, int c) const
+        {
+            return mLengthC[GetIndex(r, c)];
+        }
+
+        // The default external force is zero. The function must set
+        // acceleration[d][i] for imin <= i < imax to the impulse F/m
+        // generated by the external force F. It is called concurrently for
+        // disjoint blocks of particles.
+        void ExternalAcceleration(int imin, int imax, Real,
+            std::array<Real const*, N> const&, std::array<Real const*, N> const&,
+            std::array<Real*, N> const& acceleration)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                std::fill(acceleration[d] + imin, acceleration[d] + imax, (Real)0);
+            }
+        }
+
+    protected:
+        inline int GetIndex(int r, int c) const
+        {
+            return c + mNumCols * r;
+        }
+
+        // Compute the accelerations of the particles imin <= i < imax. The
+        // blocks of consecutive particles are processed row by row, so the
+        // springs of a row are the same for all its particles except the
+        // springs to the previous and next columns at the ends of the row.
+        void Acceleration(int imin, int imax, Real time,
+            std::array<Real const*, N> const& position,
+            std::array<Real const*, N> const& velocity,
+            std::array<Real*, N> const& acceleration)
+        {
+            static_cast<Self*>(this)->ExternalAcceleration(imin, imax, time, position,
+                velocity, acceleration);
+
+            for (int r = imin / mNumCols; r * mNumCols < imax; ++r)
+            {
+                int const rowBegin = r * mNumCols, rowEnd = rowBegin + mNumCols;
+                int const jmin = std::max(imin, rowBegin), jmax = std::min(imax, rowEnd);
+                if (r > 0)
+                {
+                    this->AddSpringAccelerations(jmin, jmax, -mNumCols, -mNumCols,
+                        mConstantR.data(), mLengthR.data(), position, acceleration);
+                }
+                if (r < mNumRows - 1)
+                {
+                    this->AddSpringAccelerations(jmin, jmax, mNumCols, 0,
+                        mConstantR.data(), mLengthR.data(), position, acceleration);
+                }
+                this->AddSpringAccelerations(std::max(jmin, rowBegin + 1), jmax, -1, -1,
+                    mConstantC.data(), mLengthC.data(), position, acceleration);
+                this->AddSpringAccelerations(jmin, std::min(jmax, rowEnd - 1), 1, 0,
+                    mConstantC.data(), mLengthC.data(), position, acceleration);
+            }
+        }
+
+        int mNumRows, mNumCols;
+        std::vector<Real> mConstantR, mLengthR;
+        std::vector<Real> mConstantC, mLengthC;
+    };
+}
@@ -0,0 +1,237 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/ParticleSystemSoA.h>
+#include <type_traits>
+
+// The MassSpringVolume system for large numbers of particles, using the
+// structure-of-arrays storage and the multithreaded solver of
+// ParticleSystemSoA. The masses, springs and indexing are those of
+// MassSpringVolume. The external acceleration is provided as described in
+// MassSpringSurfaceSoA.h.
+
+namespace gte
+{
+    template <int N, typename Real, typename Derived = void>
+    class MassSpringVolumeSoA : public ParticleSystemSoA<N, Real,
+        typename std::conditional<std::is_void<Derived>::value,
+        MassSpringVolumeSoA<N, Real, Derived>, Derived>::type>
+    {
+    public:
+        using Self = typename std::conditional<std::is_void<Derived>::value,
+            MassSpringVolumeSoA<N, Real, Derived>, Derived>::type;
+        using Base = ParticleSystemSoA<N, Real, Self>;
+        friend Base;
+
+        // Construction. This class represents an SxRxC array of masses
+        // lying in a volume and connected by an array of springs. The
+        // masses are arranged in lexicographical order:
+        // position[c+C*(r+R*s)] = X[s][r][c] for 0 <= s < S, 0 <= r < R and
+        // 0 <= c < C.
+        MassSpringVolumeSoA(int numSlices, int numRows, int numCols, Real step)
+            :
+            Base(numSlices * numRows * numCols, step),
+            mNumSlices(numSlices),
+            mNumRows(numRows),
+            mNumCols(numCols),
+            mConstantS(numSlices * numRows * numCols, (Real)0),
+            mLengthS(numSlices * numRows * numCols, (Real)0),
+            mConstantR(numSlices * numRows * numCols, (Real)0),
+            mLengthR(numSlices * numRows * numCols, (Real)0),
+            mConstantC(numSlices * numRows * numCols, (Real)0),
+            mLengthC(numSlices * numRows * numCols, (Real)0)
+        {
+        }
+
+        // Member access.
+        inline int GetNumSlices() const
+        {
+            return mNumSlices;
+        }
+
+        inline int GetNumRows() const
+        {
+            return mNumRows;
+        }
+
+        inline int GetNumCols() const
+        {
+            return mNumCols;
+        }
+
+        inline void SetMass(int s, int r, int c, Real mass)
+        {
+            Base::SetMass(GetIndex(s, r, c), mass);
+        }
+
+        inline void SetPosition(int s, int r, int c, Vector<N, Real> const& position)
+        {
+            Base::SetPosition(GetIndex(s, r, c), position);
+        }
+
+        inline void SetVelocity(int s, int r, int c, Vector<N, Real> const& velocity)
+        {
+            Base::SetVelocity(GetIndex(s, r, c), velocity);
+        }
+
+        inline Real const& GetMass(int s, int r, int c) const
+        {
+            return Base::GetMass(GetIndex(s, r, c));
+        }
+
+        inline Vector<N, Real> GetPosition(int s, int r, int c) const
+        {
+            return Base::GetPosition(GetIndex(s, r, c));
+        }
+
+        inline Vector<N, Real> GetVelocity(int s, int r, int c) const
+        {
+            return Base::GetVelocity(GetIndex(s, r, c));
+        }
+
+        // The mass at (s,r,c) provides access to the springs connecting to
+        // locations (s+1,r,c), (s,r+1,c) and (s,r,c+1), as in
+        // MassSpringVolume.
+
+        // to (s+1,r,c)
+        inline void SetConstantS(int s, int r, int c, Real constant)
+        {
+            mConstantS[GetIndex(s, r, c)] = constant;
+        }
+
+        // to (s+1,r,c)
+        inline void SetLengthS(int s, int r, int c, Real length)
+        {
+            mLengthS[GetIndex(s, r, c)] = length;
+        }
+
+        // to (s,r+1,c)
+        inline void SetConstantR(int s, int r, int c, Real constant)
+        {
+            mConstantR[GetIndex(s, r, c)] = constant;
+        }
+
+        // to (s,r+1,c)
+        inline void SetLengthR(int s, int r, int c, Real length)
+        {
+            mLengthR[GetIndex(s, r, c)] = length;
+        }
+
+        // to (s,r,c+1)
+        inline void SetConstantC(int s, int r, int c, Real constant)
+        {
+            mConstantC[GetIndex(s, r, c)] = constant;
+        }
+
+        // to (s,r,c+1)
+        inline void SetLengthC(int s, int r, int c, Real length)
+        {
+            mLengthC[GetIndex(s, r, c)] = length;
+        }
+
+        inline Real const& GetConstantS(int s, int r, int c) const
+        {
+            return mConstantS[GetIndex(s, r, c)];
+        }
+
+        inline Real const& GetLengthS(int s, int r, int c) const
+        {
+            return mLengthS[GetIndex(s, r, c)];
+        }
+
+        inline Real const& GetConstantR(int s, int r, int c) const
+        {
+            return mConstantR[GetIndex(s, r, c)];
+        }
+
+        inline Real const& GetLengthR(int s, int r, int c) const
+        {
+            return mLengthR[GetIndex(s, r, c)];
+        }
+
+        inline Real const& GetConstantC(int s, int r, int c) const
+        {
+            return mConstantC[GetIndex(s, r, c)];
+        }
+
+        inline Real const& GetLengthC(int s, int r, int c) const
+        {
+            return mLengthC[GetIndex(s, r, c)];
+        }
+
+        // The default external force is zero. The function must set
+        // acceleration[d][i] for imin <= i < imax to the impulse F/m
+        // generated by the external force F. It is called concurrently for
+        // disjoint blocks of particles.
+        void ExternalAcceleration(int imin, int imax, Real,
+            std::array<Real const*, N> const&, std::array<Real const*, N> const&,
+            std::array<Real*, N> const& acceleration)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                std::fill(acceleration[d] + imin, acceleration[d] + imax, (Real)0);
+            }
+        }
+
+    protected:
+        inline int GetIndex(int s, int r, int c) const
+        {
+            return c + mNumCols * (r + mNumRows * s);
+        }
+
+        // Compute the accelerations of the particles imin <= i < imax. The
+        // blocks of consecutive particles are processed row by row as in
+        // MassSpringSurfaceSoA.
+        void Acceleration(int imin, int imax, Real time,
+            std::array<Real const*, N> const& position,
+            std::array<Real const*, N> const& velocity,
+            std::array<Real*, N> const& acceleration)
+        {
+            static_cast<Self*>(this)->ExternalAcceleration(imin, imax, time, position,
+                velocity, acceleration);
+
+            int const sliceSize = mNumRows * mNumCols;
+            for (int row = imin / mNumCols; row * mNumCols < imax; ++row)
+            {
+                int const r = row % mNumRows, s = row / mNumRows;
+                int const rowBegin = row * mNumCols, rowEnd = rowBegin + mNumCols;
+                int const jmin = std::max(imin, rowBegin), jmax = std::min(imax, rowEnd);
+                if (s > 0)
+                {
+                    this->AddSpringAccelerations(jmin, jmax, -sliceSize, -sliceSize,
+                        mConstantS.data(), mLengthS.data(), position, acceleration);
+                }
+                if (s < mNumSlices - 1)
+                {
+                    this->AddSpringAccelerations(jmin, jmax, sliceSize, 0,
+                        mConstantS.data(), mLengthS.data(), position, acceleration);
+                }
+                if (r > 0)
+                {
+                    this->AddSpringAccelerations(jmin, jmax, -mNumCols, -mNumCols,
+                        mConstantR.data(), mLengthR.data(), position, acceleration);
+                }
+                if (r < mNumRows - 1)
+                {
+                    this->AddSpringAccelerations(jmin, jmax, mNumCols, 0,
+                        mConstantR.data(), mLengthR.data(), position, acceleration);
+                }
+                this->AddSpringAccelerations(std::max(jmin, rowBegin + 1), jmax, -1, -1,
+                    mConstantC.data(), mLengthC.data(), position, acceleration);
+                this->AddSpringAccelerations(jmin, std::min(jmax, rowEnd - 1), 1, 0,
+                    mConstantC.data(), mLengthC.data(), position, acceleration);
+            }
+        }
+
+        int mNumSlices, mNumRows, mNumCols;
+        std::vector<Real> mConstantS, mLengthS;
+        std::vector<Real> mConstantR, mLengthR;
+        std::vector<Real> mConstantC, mLengthC;
+    };
+}
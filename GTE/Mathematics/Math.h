@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.08
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -323,7 +323,7 @@
 #define GTE_C_ACOS_DEG5_C3 -4.5130266382166440e-02
 #define GTE_C_ACOS_DEG5_C4 +1.9467466687281387e-02
 #define GTE_C_ACOS_DEG5_C5 -4.3601326117634898e-03
-#define GTE_C_ACOS_DEG5_MAX_ERROR 1.3861070257241426-6
+#define GTE_C_ACOS_DEG5_MAX_ERROR 1.3861070257241426e-6
 
 #define GTE_C_ACOS_DEG6_C0 +1.5707963267948966
 #define GTE_C_ACOS_DEG6_C1 -2.1458939285677325e-01
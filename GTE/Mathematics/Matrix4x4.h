@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Matrix.h>
+#include <Mathematics/SIMD4.h>
 #include <Mathematics/Vector4.h>
 
 namespace gte
@@ -135,6 +136,250 @@ namespace gte
         return trace;
     }
 
+#if defined(GTE_HAS_SIMD4_FLOAT) || defined(GTE_HAS_SIMD4_DOUBLE)
+    // SIMD implementations of the products, transpose and inverse for the
+    // types supported by SIMD4<Real> when GTE_USE_SIMD is defined. The
+    // non-template overloads after the class are selected instead of the
+    // template functions. The lanes of a register are the contiguous
+    // elements of a row (GTE_USE_ROW_MAJOR) or a column (GTE_USE_COL_MAJOR)
+    // of the storage. Each result is computed with the same operations in
+    // the same order as the scalar code, so the results are the same as
+    // long as the compiler does not fuse the scalar multiply-adds.
+    template <typename Real>
+    class Matrix4x4SIMD
+    {
+    public:
+        typedef SIMD4<Real> S;
+        typedef typename S::Register Register;
+
+        static Matrix4x4<Real> Multiply(Matrix4x4<Real> const& A, Matrix4x4<Real> const& B)
+        {
+            Matrix4x4<Real> result;
+#if defined(GTE_USE_ROW_MAJOR)
+            // row(r) of A*B = sum_i A(r,i)*row(i) of B
+            Register bLine[4];
+            LoadLines(B, bLine);
+            for (int r = 0; r < 4; ++r)
+            {
+                Register sum = S::Zero();
+                for (int i = 0; i < 4; ++i)
+                {
+                    sum = S::Add(sum, S::Mul(S::Set(A(r, i)), bLine[i]));
+                }
+                S::Store(&result(r, 0), sum);
+            }
+#else
+            // col(c) of A*B = sum_i col(i) of A * B(i,c)
+            Register aLine[4];
+            LoadLines(A, aLine);
+            for (int c = 0; c < 4; ++c)
+            {
+                Register sum = S::Zero();
+                for (int i = 0; i < 4; ++i)
+                {
+                    sum = S::Add(sum, S::Mul(aLine[i], S::Set(B(i, c))));
+                }
+                S::Store(&result(0, c), sum);
+            }
+#endif
+            return result;
+        }
+
+        static Vector4<Real> Multiply(Matrix4x4<Real> const& M, Vector4<Real> const& V)
+        {
+            // M*V = sum_c col(c) of M * V[c]
+            Register col[4];
+            LoadLines(M, col);
+#if defined(GTE_USE_ROW_MAJOR)
+            S::Transpose(col[0], col[1], col[2], col[3]);
+#endif
+            return SumLines(col, V);
+        }
+
+        static Vector4<Real> Multiply(Vector4<Real> const& V, Matrix4x4<Real> const& M)
+        {
+            // V*M = sum_r V[r] * row(r) of M
+            Register row[4];
+            LoadLines(M, row);
+#if !defined(GTE_USE_ROW_MAJOR)
+            S::Transpose(row[0], row[1], row[2], row[3]);
+#endif
+            return SumLines(row, V);
+        }
+
+        static Matrix4x4<Real> Transpose(Matrix4x4<Real> const& M)
+        {
+            Matrix4x4<Real> result;
+            Register line[4];
+            LoadLines(M, line);
+            S::Transpose(line[0], line[1], line[2], line[3]);
+            StoreLines(line, result);
+            return result;
+        }
+
+        static Matrix4x4<Real> Inverse(Matrix4x4<Real> const& M, bool* reportInvertibility)
+        {
+            // The 2x2 minors and the determinant are those of the scalar
+            // Inverse. Row r of the inverse is
+            //   (s0*X0*Y0 + s1*X1*Y1 + s2*X2*Y2) * invDet
+            // where Xi is a column of M with its pairs of elements swapped,
+            // Yi = (bj,bj,aj,aj) and si is a pattern of alternating signs.
+            Matrix4x4<Real> inverse;
+            bool invertible;
+            Real a0 = M(0, 0) * M(1, 1) - M(0, 1) * M(1, 0);
+            Real a1 = M(0, 0) * M(1, 2) - M(0, 2) * M(1, 0);
+            Real a2 = M(0, 0) * M(1, 3) - M(0, 3) * M(1, 0);
+            Real a3 = M(0, 1) * M(1, 2) - M(0, 2) * M(1, 1);
+            Real a4 = M(0, 1) * M(1, 3) - M(0, 3) * M(1, 1);
+            Real a5 = M(0, 2) * M(1, 3) - M(0, 3) * M(1, 2);
+            Real b0 = M(2, 0) * M(3, 1) - M(2, 1) * M(3, 0);
+            Real b1 = M(2, 0) * M(3, 2) - M(2, 2) * M(3, 0);
+            Real b2 = M(2, 0) * M(3, 3) - M(2, 3) * M(3, 0);
+            Real b3 = M(2, 1) * M(3, 2) - M(2, 2) * M(3, 1);
+            Real b4 = M(2, 1) * M(3, 3) - M(2, 3) * M(3, 1);
+            Real b5 = M(2, 2) * M(3, 3) - M(2, 3) * M(3, 2);
+            Real det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+            if (det != (Real)0)
+            {
+                Register col[4];
+                LoadLines(M, col);
+#if defined(GTE_USE_ROW_MAJOR)
+                S::Transpose(col[0], col[1], col[2], col[3]);
+#endif
+                Register X[4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    X[c] = S::SwapPairs(col[c]);
+                }
+
+                Register Y0 = S::Set(b0, b0, a0, a0);
+                Register Y1 = S::Set(b1, b1, a1, a1);
+                Register Y2 = S::Set(b2, b2, a2, a2);
+                Register Y3 = S::Set(b3, b3, a3, a3);
+                Register Y4 = S::Set(b4, b4, a4, a4);
+                Register Y5 = S::Set(b5, b5, a5, a5);
+                Register invDet = S::Set((Real)1 / det);
+
+                Register row[4];
+                row[0] = Cofactors(X[1], Y5, X[2], Y4, X[3], Y3, false, invDet);
+                row[1] = Cofactors(X[0], Y5, X[2], Y2, X[3], Y1, true, invDet);
+                row[2] = Cofactors(X[0], Y4, X[1], Y2, X[3], Y0, false, invDet);
+                row[3] = Cofactors(X[0], Y3, X[1], Y1, X[2], Y0, true, invDet);
+#if !defined(GTE_USE_ROW_MAJOR)
+                S::Transpose(row[0], row[1], row[2], row[3]);
+#endif
+                StoreLines(row, inverse);
+                invertible = true;
+            }
+            else
+            {
+                invertible = false;
+            }
+
+            if (reportInvertibility)
+            {
+                *reportInvertibility = invertible;
+            }
+            return inverse;
+        }
+
+    private:
+        static inline void LoadLines(Matrix4x4<Real> const& M, Register line[4])
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                line[i] = S::Load(&M[4 * i]);
+            }
+        }
+
+        static inline void StoreLines(Register const line[4], Matrix4x4<Real>& M)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                S::Store(&M[4 * i], line[i]);
+            }
+        }
+
+        static inline Vector4<Real> SumLines(Register const line[4], Vector4<Real> const& V)
+        {
+            Register sum = S::Zero();
+            for (int i = 0; i < 4; ++i)
+            {
+                sum = S::Add(sum, S::Mul(line[i], S::Set(V[i])));
+            }
+            Vector4<Real> result;
+            S::Store(&result[0], sum);
+            return result;
+        }
+
+        // The signs of the terms of a row of the inverse alternate in each
+        // term and from term to term. The first term of rows 0 and 2 is
+        // +, -, +, - and that of rows 1 and 3 is -, +, -, +.
+        static inline Register Cofactors(Register X0, Register Y0, Register X1,
+            Register Y1, Register X2, Register Y2, bool negateFirst, Register invDet)
+        {
+            Register t0 = S::NegateAlternate(S::Mul(X0, Y0), !negateFirst);
+            Register t1 = S::NegateAlternate(S::Mul(X1, Y1), negateFirst);
+            Register t2 = S::NegateAlternate(S::Mul(X2, Y2), !negateFirst);
+            return S::Mul(S::Add(S::Add(t0, t1), t2), invDet);
+        }
+    };
+#endif
+
+#if defined(GTE_HAS_SIMD4_FLOAT)
+    inline Matrix4x4<float> operator*(Matrix4x4<float> const& A, Matrix4x4<float> const& B)
+    {
+        return Matrix4x4SIMD<float>::Multiply(A, B);
+    }
+
+    inline Vector4<float> operator*(Matrix4x4<float> const& M, Vector4<float> const& V)
+    {
+        return Matrix4x4SIMD<float>::Multiply(M, V);
+    }
+
+    inline Vector4<float> operator*(Vector4<float> const& V, Matrix4x4<float> const& M)
+    {
+        return Matrix4x4SIMD<float>::Multiply(V, M);
+    }
+
+    inline Matrix4x4<float> Transpose(Matrix4x4<float> const& M)
+    {
+        return Matrix4x4SIMD<float>::Transpose(M);
+    }
+
+    inline Matrix4x4<float> Inverse(Matrix4x4<float> const& M, bool* reportInvertibility = nullptr)
+    {
+        return Matrix4x4SIMD<float>::Inverse(M, reportInvertibility);
+    }
+#endif
+
+#if defined(GTE_HAS_SIMD4_DOUBLE)
+    inline Matrix4x4<double> operator*(Matrix4x4<double> const& A, Matrix4x4<double> const& B)
+    {
+        return Matrix4x4SIMD<double>::Multiply(A, B);
+    }
+
+    inline Vector4<double> operator*(Matrix4x4<double> const& M, Vector4<double> const& V)
+    {
+        return Matrix4x4SIMD<double>::Multiply(M, V);
+    }
+
+    inline Vector4<double> operator*(Vector4<double> const& V, Matrix4x4<double> const& M)
+    {
+        return Matrix4x4SIMD<double>::Multiply(V, M);
+    }
+
+    inline Matrix4x4<double> Transpose(Matrix4x4<double> const& M)
+    {
+        return Matrix4x4SIMD<double>::Transpose(M);
+    }
+
+    inline Matrix4x4<double> Inverse(Matrix4x4<double> const& M, bool* reportInvertibility = nullptr)
+    {
+        return Matrix4x4SIMD<double>::Inverse(M, reportInvertibility);
+    }
+#endif
+
     // Multiply M and V according to the user-selected convention.  If it is
     // GTE_USE_MAT_VEC, the function returns M*V.  If it is GTE_USE_VEC_MAT,
     // the function returns V*M.  This function is provided to hide the
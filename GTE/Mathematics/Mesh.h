@@ -3,16 +3,19 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/Matrix.h>
 #include <Mathematics/IndexAttribute.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/VertexAttribute.h>
 #include <Mathematics/Vector2.h>
 #include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <vector>
 
 // The Mesh class is designed to support triangulations of surfaces of a small
 // number of topologies. See the documents
@@ -48,6 +51,16 @@
 // For each provided vertex attribute, a derived class can initialize
 // that attribute by overriding one of the Initialize*() functions whose
 // stubs are defined in this class.
+//
+// The vertex attributes are written directly to their sources, which are
+// usually the memory of a VertexBuffer, so a dynamic mesh is updated by
+// calling Update() followed by uploading the buffer to the GPU. When a
+// TaskScheduler is set, Update() computes the positions, normals and frames
+// in parallel. The normals and frames are computed by gathering the
+// contributions of the triangles sharing each vertex in the order of the
+// triangles, so the results do not depend on the scheduler. The triangles
+// sharing the vertices are computed on the first update, so the indices
+// must not change after that.
 
 namespace gte
 {
@@ -214,7 +227,8 @@ namespace gte
             mBitangentStride(0),
             mDPDUStride(0),
             mDPDVStride(0),
-            mTCoordStride(0)
+            mTCoordStride(0),
+            mScheduler(nullptr)
         {
             mDescription.constructed = false;
             for (auto const& topology : validTopologies)
@@ -334,6 +348,19 @@ namespace gte
             return mDescription;
         }
 
+        // Execute the updates as tasks of the scheduler, one range of
+        // vertices or triangles per scheduler thread. Set the scheduler to
+        // null to update in the calling thread.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // If the underlying geometric data varies dynamically, call this
         // function to update whatever vertex attributes are specified by
         // the vertex pool.
@@ -489,43 +516,46 @@ namespace gte
         {
             // Compute normal vector as normalized weighted averages of triangle
             // normal vectors.
+            CreateVertexCorners();
 
-            // Set the normals to zero to allow accumulation of triangle normals.
-            Vector3<Real> zero{ (Real)0, (Real)0, (Real)0 };
-            for (uint32_t i = 0; i < mDescription.numVertices; ++i)
-            {
-                Normal(i) = zero;
-            }
-
-            // Accumulate the triangle normals.
-            for (uint32_t t = 0; t < mDescription.numTriangles; ++t)
-            {
-                // Get the positions for the triangle.
-                uint32_t v0, v1, v2;
-                mDescription.indexAttribute.GetTriangle(t, v0, v1, v2);
-                Vector3<Real> P0 = Position(v0);
-                Vector3<Real> P1 = Position(v1);
-                Vector3<Real> P2 = Position(v2);
-
-                // Get the edge vectors.
-                Vector3<Real> E1 = P1 - P0;
-                Vector3<Real> E2 = P2 - P0;
-
-                // Compute a triangle normal show length is twice the area of the
-                // triangle.
-                Vector3<Real> triangleNormal = Cross(E1, E2);
-
-                // Accumulate the triangle normals.
-                Normal(v0) += triangleNormal;
-                Normal(v1) += triangleNormal;
-                Normal(v2) += triangleNormal;
-            }
+            // Compute triangle normals whose lengths are twice the areas of
+            // the triangles.
+            mTriangleNormals.resize(mDescription.numTriangles);
+            ParallelFor(mDescription.numTriangles,
+                [this](uint32_t tmin, uint32_t tmax)
+                {
+                    for (uint32_t t = tmin; t < tmax; ++t)
+                    {
+                        // Get the positions for the triangle.
+                        uint32_t v0, v1, v2;
+                        mDescription.indexAttribute.GetTriangle(t, v0, v1, v2);
+                        Vector3<Real> P0 = Position(v0);
+                        Vector3<Real> P1 = Position(v1);
+                        Vector3<Real> P2 = Position(v2);
+
+                        // Get the edge vectors.
+                        Vector3<Real> E1 = P1 - P0;
+                        Vector3<Real> E2 = P2 - P0;
+                        mTriangleNormals[t] = Cross(E1, E2);
+                    }
+                });
 
-            // Normalize the normals.
-            for (uint32_t i = 0; i < mDescription.numVertices; ++i)
-            {
-                Normalize(Normal(i), true);
-            }
+            // Accumulate the normals of the triangles sharing each vertex
+            // and normalize the sums.
+            ParallelFor(mDescription.numVertices,
+                [this](uint32_t vmin, uint32_t vmax)
+                {
+                    for (uint32_t i = vmin; i < vmax; ++i)
+                    {
+                        Vector3<Real> normal{ (Real)0, (Real)0, (Real)0 };
+                        for (size_t k = mCornerOffsets[i]; k < mCornerOffsets[i + 1]; ++k)
+                        {
+                            normal += mTriangleNormals[mCorners[k] / 3];
+                        }
+                        Normal(i) = normal;
+                        Normalize(Normal(i), true);
+                    }
+                });
         }
 
         virtual void UpdateFrame()
@@ -537,111 +567,193 @@ namespace gte
                 // later based on estimated tangent vectors.
                 UpdateNormals();
             }
-
-            // Use the least-squares algorithm to estimate the tangent-space vectors
-            // and, if requested, normal vectors.
-            Matrix<2, 2, Real> zero2x2;  // initialized to zero
-            Matrix<3, 2, Real> zero3x2;  // initialized to zero
-            std::fill(mUTU.begin(), mUTU.end(), zero2x2);
-            std::fill(mDTU.begin(), mDTU.end(), zero3x2);
-            for (uint32_t t = 0; t < mDescription.numTriangles; ++t)
-            {
-                // Get the positions and differences for the triangle.
-                uint32_t v0, v1, v2;
-                mDescription.indexAttribute.GetTriangle(t, v0, v1, v2);
-                Vector3<Real> P0 = Position(v0);
-                Vector3<Real> P1 = Position(v1);
-                Vector3<Real> P2 = Position(v2);
-                Vector3<Real> D10 = P1 - P0;
-                Vector3<Real> D20 = P2 - P0;
-                Vector3<Real> D21 = P2 - P1;
-
-                if (mTCoords)
+            CreateVertexCorners();
+
+            // Use the least-squares algorithm to estimate the tangent-space
+            // vectors and, if requested, normal vectors.  The contributions
+            // of each triangle to U^T*U and D^T*U of its vertices are
+            // computed first, one per triangle corner.
+            uint32_t const numCorners = 3 * mDescription.numTriangles;
+            mCornerUTU.resize(numCorners);
+            mCornerDTU.resize(numCorners);
+            ParallelFor(mDescription.numTriangles,
+                [this](uint32_t tmin, uint32_t tmax)
                 {
-                    // Get the texture coordinates and differences for the triangle.
-                    Vector2<Real> C0 = TCoord(v0);
-                    Vector2<Real> C1 = TCoord(v1);
-                    Vector2<Real> C2 = TCoord(v2);
-                    Vector2<Real> U10 = C1 - C0;
-                    Vector2<Real> U20 = C2 - C0;
-                    Vector2<Real> U21 = C2 - C1;
-
-                    // Compute the outer products.
-                    Matrix<2, 2, Real> outerU10 = OuterProduct(U10, U10);
-                    Matrix<2, 2, Real> outerU20 = OuterProduct(U20, U20);
-                    Matrix<2, 2, Real> outerU21 = OuterProduct(U21, U21);
-                    Matrix<3, 2, Real> outerD10 = OuterProduct(D10, U10);
-                    Matrix<3, 2, Real> outerD20 = OuterProduct(D20, U20);
-                    Matrix<3, 2, Real> outerD21 = OuterProduct(D21, U21);
-
-                    // Keep a running sum of U^T*U and D^T*U.
-                    mUTU[v0] += outerU10 + outerU20;
-                    mUTU[v1] += outerU10 + outerU21;
-                    mUTU[v2] += outerU20 + outerU21;
-                    mDTU[v0] += outerD10 + outerD20;
-                    mDTU[v1] += outerD10 + outerD21;
-                    mDTU[v2] += outerD20 + outerD21;
-                }
-                else
+                    for (uint32_t t = tmin; t < tmax; ++t)
+                    {
+                        // Get the positions and differences for the triangle.
+                        uint32_t v0, v1, v2;
+                        mDescription.indexAttribute.GetTriangle(t, v0, v1, v2);
+                        Vector3<Real> P0 = Position(v0);
+                        Vector3<Real> P1 = Position(v1);
+                        Vector3<Real> P2 = Position(v2);
+                        Vector3<Real> D10 = P1 - P0;
+                        Vector3<Real> D20 = P2 - P0;
+                        Vector3<Real> D21 = P2 - P1;
+                        Matrix<2, 2, Real>* UTU = &mCornerUTU[3 * static_cast<size_t>(t)];
+                        Matrix<3, 2, Real>* DTU = &mCornerDTU[3 * static_cast<size_t>(t)];
+
+                        if (mTCoords)
+                        {
+                            // Get the texture coordinates and differences for the triangle.
+                            Vector2<Real> C0 = TCoord(v0);
+                            Vector2<Real> C1 = TCoord(v1);
+                            Vector2<Real> C2 = TCoord(v2);
+                            Vector2<Real> U10 = C1 - C0;
+                            Vector2<Real> U20 = C2 - C0;
+                            Vector2<Real> U21 = C2 - C1;
+
+                            // Compute the outer products.
+                            Matrix<2, 2, Real> outerU10 = OuterProduct(U10, U10);
+                            Matrix<2, 2, Real> outerU20 = OuterProduct(U20, U20);
+                            Matrix<2, 2, Real> outerU21 = OuterProduct(U21, U21);
+                            Matrix<3, 2, Real> outerD10 = OuterProduct(D10, U10);
+                            Matrix<3, 2, Real> outerD20 = OuterProduct(D20, U20);
+                            Matrix<3, 2, Real> outerD21 = OuterProduct(D21, U21);
+
+                            // Compute the terms of U^T*U and D^T*U.
+                            UTU[0] = outerU10 + outerU20;
+                            UTU[1] = outerU10 + outerU21;
+                            UTU[2] = outerU20 + outerU21;
+                            DTU[0] = outerD10 + outerD20;
+                            DTU[1] = outerD10 + outerD21;
+                            DTU[2] = outerD20 + outerD21;
+                        }
+                        else
+                        {
+                            // Compute local coordinates and differences for the triangle.
+                            Vector3<Real> basis[3];
+
+                            basis[0] = Normal(v0);
+                            ComputeOrthogonalComplement(1, basis, true);
+                            Vector2<Real> U10{ Dot(basis[1], D10), Dot(basis[2], D10) };
+                            Vector2<Real> U20{ Dot(basis[1], D20), Dot(basis[2], D20) };
+                            UTU[0] = OuterProduct(U10, U10) + OuterProduct(U20, U20);
+                            DTU[0] = OuterProduct(D10, U10) + OuterProduct(D20, U20);
+
+                            basis[0] = Normal(v1);
+                            ComputeOrthogonalComplement(1, basis, true);
+                            Vector2<Real> U01{ Dot(basis[1], D10), Dot(basis[2], D10) };
+                            Vector2<Real> U21{ Dot(basis[1], D21), Dot(basis[2], D21) };
+                            UTU[1] = OuterProduct(U01, U01) + OuterProduct(U21, U21);
+                            DTU[1] = OuterProduct(D10, U01) + OuterProduct(D21, U21);
+
+                            basis[0] = Normal(v2);
+                            ComputeOrthogonalComplement(1, basis, true);
+                            Vector2<Real> U02{ Dot(basis[1], D20), Dot(basis[2], D20) };
+                            Vector2<Real> U12{ Dot(basis[1], D21), Dot(basis[2], D21) };
+                            UTU[2] = OuterProduct(U02, U02) + OuterProduct(U12, U12);
+                            DTU[2] = OuterProduct(D20, U02) + OuterProduct(D21, U12);
+                        }
+                    }
+                });
+
+            mUTU.resize(mDescription.numVertices);
+            mDTU.resize(mDescription.numVertices);
+            ParallelFor(mDescription.numVertices,
+                [this](uint32_t vmin, uint32_t vmax)
                 {
-                    // Compute local coordinates and differences for the triangle.
-                    Vector3<Real> basis[3];
-
-                    basis[0] = Normal(v0);
-                    ComputeOrthogonalComplement(1, basis, true);
-                    Vector2<Real> U10{ Dot(basis[1], D10), Dot(basis[2], D10) };
-                    Vector2<Real> U20{ Dot(basis[1], D20), Dot(basis[2], D20) };
-                    mUTU[v0] += OuterProduct(U10, U10) + OuterProduct(U20, U20);
-                    mDTU[v0] += OuterProduct(D10, U10) + OuterProduct(D20, U20);
-
-                    basis[0] = Normal(v1);
-                    ComputeOrthogonalComplement(1, basis, true);
-                    Vector2<Real> U01{ Dot(basis[1], D10), Dot(basis[2], D10) };
-                    Vector2<Real> U21{ Dot(basis[1], D21), Dot(basis[2], D21) };
-                    mUTU[v1] += OuterProduct(U01, U01) + OuterProduct(U21, U21);
-                    mDTU[v1] += OuterProduct(D10, U01) + OuterProduct(D21, U21);
-
-                    basis[0] = Normal(v2);
-                    ComputeOrthogonalComplement(1, basis, true);
-                    Vector2<Real> U02{ Dot(basis[1], D20), Dot(basis[2], D20) };
-                    Vector2<Real> U12{ Dot(basis[1], D21), Dot(basis[2], D21) };
-                    mUTU[v2] += OuterProduct(U02, U02) + OuterProduct(U12, U12);
-                    mDTU[v2] += OuterProduct(D20, U02) + OuterProduct(D21, U12);
-                }
+                    for (uint32_t i = vmin; i < vmax; ++i)
+                    {
+                        // Keep a running sum of U^T*U and D^T*U.
+                        Matrix<2, 2, Real> UTU;  // initialized to zero
+                        Matrix<3, 2, Real> DTU;  // initialized to zero
+                        for (size_t k = mCornerOffsets[i]; k < mCornerOffsets[i + 1]; ++k)
+                        {
+                            UTU += mCornerUTU[mCorners[k]];
+                            DTU += mCornerDTU[mCorners[k]];
+                        }
+                        mUTU[i] = UTU;
+                        mDTU[i] = DTU;
+
+                        Matrix<3, 2, Real> jacobian = DTU * Inverse(UTU);
+
+                        Vector3<Real> basis[3];
+                        basis[0] = { jacobian(0, 0), jacobian(1, 0), jacobian(2, 0) };
+                        basis[1] = { jacobian(0, 1), jacobian(1, 1), jacobian(2, 1) };
+
+                        if (mDPDUs)
+                        {
+                            DPDU(i) = basis[0];
+                        }
+                        if (mDPDVs)
+                        {
+                            DPDV(i) = basis[1];
+                        }
+
+                        ComputeOrthogonalComplement(2, basis, true);
+
+                        if (mNormals)
+                        {
+                            Normal(i) = basis[2];
+                        }
+                        if (mTangents)
+                        {
+                            Tangent(i) = basis[0];
+                        }
+                        if (mBitangents)
+                        {
+                            Bitangent(i) = basis[1];
+                        }
+                    }
+                });
+        }
 
+        // Execute function(imin,imax) for contiguous subranges of
+        // [0,numItems), one per thread of the scheduler.
+        template <typename Function>
+        void ParallelFor(uint32_t numItems, Function const& function) const
+        {
+            uint32_t numChunks = 1;
+            if (mScheduler)
+            {
+                numChunks = std::max(std::min(numItems,
+                    static_cast<uint32_t>(mScheduler->GetNumThreads())), 1u);
             }
 
-            for (uint32_t i = 0; i < mDescription.numVertices; ++i)
-            {
-                Matrix<3, 2, Real> jacobian = mDTU[i] * Inverse(mUTU[i]);
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [numItems, numChunks, &function](size_t chunk)
+                {
+                    uint64_t const n = numItems, c = chunk;
+                    function(static_cast<uint32_t>(n * c / numChunks),
+                        static_cast<uint32_t>(n * (c + 1) / numChunks));
+                });
+        }
 
-                Vector3<Real> basis[3];
-                basis[0] = { jacobian(0, 0), jacobian(1, 0), jacobian(2, 0) };
-                basis[1] = { jacobian(0, 1), jacobian(1, 1), jacobian(2, 1) };
+        // The corners of the triangles sharing vertex v are mCorners[k] for
+        // mCornerOffsets[v] <= k < mCornerOffsets[v+1] in increasing order,
+        // where corner 3*t+j is vertex j of triangle t.
+        void CreateVertexCorners()
+        {
+            if (mCornerOffsets.size() > 0)
+            {
+                return;
+            }
 
-                if (mDPDUs)
-                {
-                    DPDU(i) = basis[0];
-                }
-                if (mDPDVs)
-                {
-                    DPDV(i) = basis[1];
-                }
+            uint32_t const numCorners = 3 * mDescription.numTriangles;
+            std::vector<uint32_t> vertices(numCorners);
+            for (uint32_t t = 0; t < mDescription.numTriangles; ++t)
+            {
+                mDescription.indexAttribute.GetTriangle(t, vertices[3 * t],
+                    vertices[3 * t + 1], vertices[3 * t + 2]);
+            }
 
-                ComputeOrthogonalComplement(2, basis, true);
+            mCornerOffsets.assign(static_cast<size_t>(mDescription.numVertices) + 1, 0);
+            for (auto v : vertices)
+            {
+                LogAssert(v < mDescription.numVertices, "Invalid index.");
+                ++mCornerOffsets[static_cast<size_t>(v) + 1];
+            }
+            for (uint32_t v = 0; v < mDescription.numVertices; ++v)
+            {
+                mCornerOffsets[v + 1] += mCornerOffsets[v];
+            }
 
-                if (mNormals)
-                {
-                    Normal(i) = basis[2];
-                }
-                if (mTangents)
-                {
-                    Tangent(i) = basis[0];
-                }
-                if (mBitangents)
-                {
-                    Bitangent(i) = basis[1];
-                }
+            std::vector<size_t> next(mCornerOffsets.begin(), mCornerOffsets.end() - 1);
+            mCorners.resize(numCorners);
+            for (uint32_t i = 0; i < numCorners; ++i)
+            {
+                mCorners[next[vertices[i]]++] = i;
             }
         }
 
@@ -678,5 +790,13 @@ namespace gte
         // PDF for details.
         std::vector<Matrix<2, 2, Real>> mUTU;
         std::vector<Matrix<3, 2, Real>> mDTU;
+
+        // Support for gathering the triangle contributions to the vertices.
+        TaskScheduler* mScheduler;
+        std::vector<size_t> mCornerOffsets;
+        std::vector<uint32_t> mCorners;
+        std::vector<Vector3<Real>> mTriangleNormals;
+        std::vector<Matrix<2, 2, Real>> mCornerUTU;
+        std::vector<Matrix<3, 2, Real>> mCornerDTU;
     };
 }
@@ -3,12 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Matrix2x2.h>
 #include <Mathematics/Matrix3x3.h>
+#include <Mathematics/VertexTriangleAdjacency.h>
 
 // The MeshCurvature class estimates principal curvatures and principal
 // directions at the vertices of a manifold triangle mesh.  The algorithm
@@ -21,7 +22,30 @@ namespace gte
     class MeshCurvature
     {
     public:
-        MeshCurvature() = default;
+        // The per-vertex computations are partitioned among numThreads
+        // threads.
+        MeshCurvature(size_t numThreads = 1)
+            :
+            mNumThreads(std::max(numThreads, static_cast<size_t>(1))),
+            mScheduler(nullptr)
+        {
+        }
+
+        // Execute the per-vertex computations as tasks of the scheduler,
+        // which can be shared with other computations, instead of creating
+        // threads for each call. The number of tasks is the number of
+        // threads of the scheduler. The results do not depend on the
+        // scheduler or on the number of threads. Set the scheduler to null
+        // to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
 
         // The input to operator() is a triangle mesh with the specified
         // vertex buffer and index buffer.  The number of elements of
@@ -32,63 +56,119 @@ namespace gte
         // used to characterize whether the DWTrn matrix is singular.  In
         // theory, set the threshold to zero.  In practice you might have
         // to set this to a small positive number.
+        //
+        // The curvatures at a vertex are computed from the triangles
+        // sharing the vertex, which are stored in a VertexTriangleAdjacency
+        // object, so the vertices are processed independently and in
+        // parallel. The adjacency is available after the call.
 
         void operator()(
             size_t numVertices, Vector3<Real> const* vertices,
             size_t numTriangles, unsigned int const* indices,
             Real singularityThreshold)
         {
+            mAdjacency.Create(numVertices, numTriangles, indices);
             mNormals.resize(numVertices);
             mMinCurvatures.resize(numVertices);
             mMaxCurvatures.resize(numVertices);
             mMinDirections.resize(numVertices);
             mMaxDirections.resize(numVertices);
 
-            // Compute the normal vectors for the vertices as an
-            // area-weighted sum of the triangles sharing a vertex.
-            Vector3<Real> vzero{ (Real)0, (Real)0, (Real)0 };
-            std::fill(mNormals.begin(), mNormals.end(), vzero);
-            unsigned int const* currentIndex = indices;
-            for (size_t i = 0; i < numTriangles; ++i)
-            {
-                // Get vertex indices.
-                unsigned int v0 = *currentIndex++;
-                unsigned int v1 = *currentIndex++;
-                unsigned int v2 = *currentIndex++;
-
-                // Compute the normal (length provides a weighted sum).
-                Vector3<Real> edge1 = vertices[v1] - vertices[v0];
-                Vector3<Real> edge2 = vertices[v2] - vertices[v0];
-                Vector3<Real> normal = Cross(edge1, edge2);
-
-                mNormals[v0] += normal;
-                mNormals[v1] += normal;
-                mNormals[v2] += normal;
-            }
-            for (size_t i = 0; i < numVertices; ++i)
+            size_t numChunks = mNumThreads;
+            if (mScheduler != nullptr)
             {
-                Normalize(mNormals[i]);
+                numChunks = static_cast<size_t>(mScheduler->GetNumThreads());
             }
+            numChunks = std::max(std::min(numChunks, numVertices), static_cast<size_t>(1));
+
+            // Compute the normal vectors for the vertices as an
+            // area-weighted sum of the triangles sharing a vertex.
+            mAdjacency.ComputeNormals(vertices, indices, mNormals.data(),
+                numChunks, mScheduler);
 
-            // Compute the matrix of normal derivatives.
-            Matrix3x3<Real> mzero;
-            std::vector<Matrix3x3<Real>> DNormal(numVertices, mzero);
-            std::vector<Matrix3x3<Real>> WWTrn(numVertices, mzero);
-            std::vector<Matrix3x3<Real>> DWTrn(numVertices, mzero);
-            std::vector<bool> DWTrnZero(numVertices, false);
+            // The normals of the one-ring neighbors of a vertex are used by
+            // the curvature computations, so all normals must be computed
+            // before the curvatures.
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numVertices, vertices, indices, singularityThreshold, numChunks](size_t chunk)
+                {
+                    size_t const vmin = numVertices * chunk / numChunks;
+                    size_t const vmax = numVertices * (chunk + 1) / numChunks;
+                    for (size_t i = vmin; i < vmax; ++i)
+                    {
+                        ComputeCurvatures(i, vertices, indices, singularityThreshold);
+                    }
+                });
+        }
+
+        void operator()(
+            std::vector<Vector3<Real>> const& vertices,
+            std::vector<unsigned int> const& indices,
+            Real singularityThreshold)
+        {
+            operator()(vertices.size(), vertices.data(), indices.size() / 3,
+                indices.data(), singularityThreshold);
+        }
 
-            currentIndex = indices;
-            for (size_t i = 0; i < numTriangles; ++i)
+        inline std::vector<Vector3<Real>> const& GetNormals() const
+        {
+            return mNormals;
+        }
+
+        inline std::vector<Real> const& GetMinCurvatures() const
+        {
+            return mMinCurvatures;
+        }
+
+        inline std::vector<Real> const& GetMaxCurvatures() const
+        {
+            return mMaxCurvatures;
+        }
+
+        inline std::vector<Vector3<Real>> const& GetMinDirections() const
+        {
+            return mMinDirections;
+        }
+
+        inline std::vector<Vector3<Real>> const& GetMaxDirections() const
+        {
+            return mMaxDirections;
+        }
+
+        inline VertexTriangleAdjacency const& GetAdjacency() const
+        {
+            return mAdjacency;
+        }
+
+    private:
+        void ComputeCurvatures(size_t i, Vector3<Real> const* vertices,
+            unsigned int const* indices, Real singularityThreshold)
+        {
+            // Compute the matrices W*W^T and D*W^T from the edges of the
+            // triangles sharing the vertex.
+            Matrix3x3<Real> WWTrn, DWTrn;
+            size_t const numAdjacent = mAdjacency.GetNumTriangles(i);
+            unsigned int const* adjacent = mAdjacency.GetTriangles(i);
+            for (size_t k = 0; k < numAdjacent; ++k)
             {
                 // Get vertex indices.
-                unsigned int v[3];
-                v[0] = *currentIndex++;
-                v[1] = *currentIndex++;
-                v[2] = *currentIndex++;
+                unsigned int const* v = &indices[3 * static_cast<size_t>(adjacent[k])];
+
+                // A triangle with repeated vertices occurs once in the
+                // adjacency for each occurrence of vertex i, so only the
+                // first occurrence is processed here.
+                if (k > 0 && adjacent[k] == adjacent[k - 1])
+                {
+                    continue;
+                }
 
                 for (size_t j = 0; j < 3; j++)
                 {
                     unsigned int v0 = v[j];
+                    if (v0 != i)
+                    {
+                        continue;
+                    }
                     unsigned int v1 = v[(j + 1) % 3];
                     unsigned int v2 = v[(j + 2) % 3];
 
@@ -102,8 +182,8 @@ namespace gte
                     {
                         for (int col = 0; col < 3; ++col)
                         {
-                            WWTrn[v0](row, col) += W[row] * W[col];
-                            DWTrn[v0](row, col) += D[row] * W[col];
+                            WWTrn(row, col) += W[row] * W[col];
+                            DWTrn(row, col) += D[row] * W[col];
                         }
                     }
 
@@ -117,8 +197,8 @@ namespace gte
                     {
                         for (int col = 0; col < 3; ++col)
                         {
-                            WWTrn[v0](row, col) += W[row] * W[col];
-                            DWTrn[v0](row, col) += D[row] * W[col];
+                            WWTrn(row, col) += W[row] * W[col];
+                            DWTrn(row, col) += D[row] * W[col];
                         }
                     }
                 }
@@ -127,38 +207,29 @@ namespace gte
             // Add in N*N^T to W*W^T for numerical stability.  In theory 0*0^T
             // is added to D*W^T, but of course no update is needed in the
             // implementation.  Compute the matrix of normal derivatives.
-            for (size_t i = 0; i < numVertices; ++i)
+            for (int row = 0; row < 3; ++row)
             {
-                for (int row = 0; row < 3; ++row)
+                for (int col = 0; col < 3; ++col)
                 {
-                    for (int col = 0; col < 3; ++col)
-                    {
-                        WWTrn[i](row, col) = (Real)0.5 * WWTrn[i](row, col) +
-                            mNormals[i][row] * mNormals[i][col];
-                        DWTrn[i](row, col) *= (Real)0.5;
-                    }
+                    WWTrn(row, col) = (Real)0.5 * WWTrn(row, col) +
+                        mNormals[i][row] * mNormals[i][col];
+                    DWTrn(row, col) *= (Real)0.5;
                 }
+            }
 
-                // Compute the max-abs entry of D*W^T.  If this entry is
-                // (nearly) zero, flag the DNormal matrix as singular.
-                Real maxAbs = (Real)0;
-                for (int row = 0; row < 3; ++row)
+            // Compute the max-abs entry of D*W^T.  If this entry is
+            // (nearly) zero, flag the DNormal matrix as singular.
+            Real maxAbs = (Real)0;
+            for (int row = 0; row < 3; ++row)
+            {
+                for (int col = 0; col < 3; ++col)
                 {
-                    for (int col = 0; col < 3; ++col)
+                    Real absEntry = std::fabs(DWTrn(row, col));
+                    if (absEntry > maxAbs)
                     {
-                        Real absEntry = std::fabs(DWTrn[i](row, col));
-                        if (absEntry > maxAbs)
-                        {
-                            maxAbs = absEntry;
-                        }
+                        maxAbs = absEntry;
                     }
                 }
-                if (maxAbs < singularityThreshold)
-                {
-                    DWTrnZero[i] = true;
-                }
-
-                DNormal[i] = DWTrn[i] * Inverse(WWTrn[i]);
             }
 
             // If N is a unit-length normal at a vertex, let U and V be
@@ -175,107 +246,75 @@ namespace gte
             // 2-by-1 eigenvector corresponding to it, then S*W = k*W (by
             // definition).  The corresponding 3-by-1 tangent vector at the
             // vertex is a principal direction for k and is J*W.
-            for (size_t i = 0; i < numVertices; ++i)
-            {
-                // Compute U and V given N.
-                Vector3<Real> basis[3];
-                basis[0] = mNormals[i];
-                ComputeOrthogonalComplement(1, basis);
-                Vector3<Real> const& U = basis[1];
-                Vector3<Real> const& V = basis[2];
-
-                if (DWTrnZero[i])
-                {
-                    // At a locally planar point.
-                    mMinCurvatures[i] = (Real)0;
-                    mMaxCurvatures[i] = (Real)0;
-                    mMinDirections[i] = U;
-                    mMaxDirections[i] = V;
-                    continue;
-                }
 
-                // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
-                // because dN/dX is estimated, we must ensure that the
-                // computed S is symmetric.
-                Real s00 = Dot(U, DNormal[i] * U);
-                Real s01 = Dot(U, DNormal[i] * V);
-                Real s10 = Dot(V, DNormal[i] * U);
-                Real s11 = Dot(V, DNormal[i] * V);
-                Real avr = (Real)0.5 * (s01 + s10);
-                Matrix2x2<Real> S{ s00, avr, avr, s11 };
-
-                // Compute the eigenvalues of S (min and max curvatures).
-                Real trace = S(0, 0) + S(1, 1);
-                Real det = S(0, 0) * S(1, 1) - S(0, 1) * S(1, 0);
-                Real discr = trace * trace - (Real)4.0 * det;
-                Real rootDiscr = std::sqrt(std::max(discr, (Real)0));
-                mMinCurvatures[i] = (Real)0.5* (trace - rootDiscr);
-                mMaxCurvatures[i] = (Real)0.5* (trace + rootDiscr);
-
-                // Compute the eigenvectors of S.
-                Vector2<Real> W0{ S(0, 1), mMinCurvatures[i] - S(0, 0) };
-                Vector2<Real> W1{ mMinCurvatures[i] - S(1, 1), S(1, 0) };
-                if (Dot(W0, W0) >= Dot(W1, W1))
-                {
-                    Normalize(W0);
-                    mMinDirections[i] = W0[0] * U + W0[1] * V;
-                }
-                else
-                {
-                    Normalize(W1);
-                    mMinDirections[i] = W1[0] * U + W1[1] * V;
-                }
+            // Compute U and V given N.
+            Vector3<Real> basis[3];
+            basis[0] = mNormals[i];
+            ComputeOrthogonalComplement(1, basis);
+            Vector3<Real> const& U = basis[1];
+            Vector3<Real> const& V = basis[2];
 
-                W0 = Vector2<Real>{ S(0, 1), mMaxCurvatures[i] - S(0, 0) };
-                W1 = Vector2<Real>{ mMaxCurvatures[i] - S(1, 1), S(1, 0) };
-                if (Dot(W0, W0) >= Dot(W1, W1))
-                {
-                    Normalize(W0);
-                    mMaxDirections[i] = W0[0] * U + W0[1] * V;
-                }
-                else
-                {
-                    Normalize(W1);
-                    mMaxDirections[i] = W1[0] * U + W1[1] * V;
-                }
+            if (maxAbs < singularityThreshold)
+            {
+                // At a locally planar point.
+                mMinCurvatures[i] = (Real)0;
+                mMaxCurvatures[i] = (Real)0;
+                mMinDirections[i] = U;
+                mMaxDirections[i] = V;
+                return;
             }
-        }
-
-        void operator()(
-            std::vector<Vector3<Real>> const& vertices,
-            std::vector<unsigned int> const& indices,
-            Real singularityThreshold)
-        {
-            operator()(vertices.size(), vertices.data(), indices.size() / 3,
-                indices.data(), singularityThreshold);
-        }
 
-        inline std::vector<Vector3<Real>> const& GetNormals() const
-        {
-            return mNormals;
-        }
+            Matrix3x3<Real> DNormal = DWTrn * Inverse(WWTrn);
 
-        inline std::vector<Real> const& GetMinCurvatures() const
-        {
-            return mMinCurvatures;
-        }
+            // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
+            // because dN/dX is estimated, we must ensure that the
+            // computed S is symmetric.
+            Real s00 = Dot(U, DNormal * U);
+            Real s01 = Dot(U, DNormal * V);
+            Real s10 = Dot(V, DNormal * U);
+            Real s11 = Dot(V, DNormal * V);
+            Real avr = (Real)0.5 * (s01 + s10);
+            Matrix2x2<Real> S{ s00, avr, avr, s11 };
 
-        inline std::vector<Real> const& GetMaxCurvatures() const
-        {
-            return mMaxCurvatures;
-        }
+            // Compute the eigenvalues of S (min and max curvatures).
+            Real trace = S(0, 0) + S(1, 1);
+            Real det = S(0, 0) * S(1, 1) - S(0, 1) * S(1, 0);
+            Real discr = trace * trace - (Real)4.0 * det;
+            Real rootDiscr = std::sqrt(std::max(discr, (Real)0));
+            mMinCurvatures[i] = (Real)0.5* (trace - rootDiscr);
+            mMaxCurvatures[i] = (Real)0.5* (trace + rootDiscr);
 
-        inline std::vector<Vector3<Real>> const& GetMinDirections() const
-        {
-            return mMinDirections;
-        }
+            // Compute the eigenvectors of S.
+            Vector2<Real> W0{ S(0, 1), mMinCurvatures[i] - S(0, 0) };
+            Vector2<Real> W1{ mMinCurvatures[i] - S(1, 1), S(1, 0) };
+            if (Dot(W0, W0) >= Dot(W1, W1))
+            {
+                Normalize(W0);
+                mMinDirections[i] = W0[0] * U + W0[1] * V;
+            }
+            else
+            {
+                Normalize(W1);
+                mMinDirections[i] = W1[0] * U + W1[1] * V;
+            }
 
-        inline std::vector<Vector3<Real>> const& GetMaxDirections() const
-        {
-            return mMaxDirections;
+            W0 = Vector2<Real>{ S(0, 1), mMaxCurvatures[i] - S(0, 0) };
+            W1 = Vector2<Real>{ mMaxCurvatures[i] - S(1, 1), S(1, 0) };
+            if (Dot(W0, W0) >= Dot(W1, W1))
+            {
+                Normalize(W0);
+                mMaxDirections[i] = W0[0] * U + W0[1] * V;
+            }
+            else
+            {
+                Normalize(W1);
+                mMaxDirections[i] = W1[0] * U + W1[1] * V;
+            }
         }
 
-    private:
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
+        VertexTriangleAdjacency mAdjacency;
         std::vector<Vector3<Real>> mNormals;
         std::vector<Real> mMinCurvatures;
         std::vector<Real> mMaxCurvatures;
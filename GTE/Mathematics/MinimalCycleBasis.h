@@ -3,16 +3,22 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <Mathematics/Logger.h>
 #include <Mathematics/MinHeap.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <set>
 #include <stack>
+#include <vector>
 
 // Extract the minimal cycle basis for a planar graph.  The input vertices and
 // edges must form a graph for which edges intersect only at vertices; that is,
@@ -29,6 +35,11 @@
 // arithmetic type BSNumber<UIntegerAP32> suffices for ComputeType when you
 // want to ensure a correct output.  (Floating-point rounding errors
 // potentially can lead to an incorrect output.)
+//
+// The connected components of the graph are independent, so they can be
+// processed concurrently. The forest has one tree per component, ordered by
+// the smallest vertex index of the component, regardless of the number of
+// threads.
 
 namespace gte
 {
@@ -44,11 +55,17 @@ namespace gte
 
         // The input positions and edges must form a planar graph for which
         // edges intersect only at vertices; that is, no two edges must
-        // intersect at an interior point of one of the edges.
+        // intersect at an interior point of one of the edges. The connected
+        // components are processed by numThreads threads. The components
+        // are distributed dynamically, because their sizes usually vary
+        // widely. The threads are tasks of the scheduler when it is not
+        // null. When numThreads is 0 or 1, the components are processed in
+        // the calling thread.
         MinimalCycleBasis(
             std::vector<std::array<Real, 2>> const& positions,
             std::vector<std::array<int, 2>> const& edges,
-            std::vector<std::shared_ptr<Tree>>& forest)
+            std::vector<std::shared_ptr<Tree>>& forest,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
         {
             forest.clear();
             if (positions.size() == 0 || edges.size() == 0)
@@ -57,67 +74,92 @@ namespace gte
                 return;
             }
 
-            // Determine the unique positions referenced by the edges.
-            std::map<int, std::shared_ptr<Vertex>> unique;
+            // Determine the unique positions referenced by the edges. The
+            // vertices are stored in increasing order of their names.
+            int const numPositions = static_cast<int>(positions.size());
+            std::vector<int> lookup(positions.size(), -1);
+            std::vector<size_t> degree(positions.size(), 0);
             for (auto const& edge : edges)
             {
                 for (int i = 0; i < 2; ++i)
                 {
-                    int name = edge[i];
-                    if (unique.find(name) == unique.end())
-                    {
-                        auto vertex = std::make_shared<Vertex>(name, &positions[name]);
-                        unique.insert(std::make_pair(name, vertex));
+                    LogAssert(edge[i] >= 0 && edge[i] < numPositions, "Invalid edge index.");
+                    lookup[edge[i]] = 0;
+                    ++degree[edge[i]];
+                }
+            }
 
-                    }
+            int numVertices = 0;
+            for (int name = 0; name < numPositions; ++name)
+            {
+                if (lookup[name] == 0)
+                {
+                    lookup[name] = numVertices++;
                 }
             }
 
-            // Assign responsibility for ownership of the Vertex objects.
-            std::vector<Vertex*> vertices;
-            mVertexStorage.reserve(unique.size());
-            vertices.reserve(unique.size());
-            for (auto const& element : unique)
+            mVertices.reserve(static_cast<size_t>(numVertices));
+            for (int name = 0; name < numPositions; ++name)
             {
-                mVertexStorage.push_back(element.second);
-                vertices.push_back(element.second.get());
+                if (lookup[name] >= 0)
+                {
+                    mVertices.emplace_back(name, &positions[name]);
+                    mVertices.back().adjacent.reserve(degree[name]);
+                }
             }
 
             // Determine the adjacencies from the edge information.
             for (auto const& edge : edges)
             {
-                auto iter0 = unique.find(edge[0]);
-                auto iter1 = unique.find(edge[1]);
-                iter0->second->adjacent.insert(iter1->second.get());
-                iter1->second->adjacent.insert(iter0->second.get());
+                Attach(&mVertices[lookup[edge[0]]], &mVertices[lookup[edge[1]]]);
             }
 
             // Get the connected components of the graph.  The 'visited' flags
             // are 0 (unvisited), 1 (discovered), 2 (finished).  The Vertex
             // constructor sets all 'visited' flags to 0.
             std::vector<std::vector<Vertex*>> components;
-            for (auto vInitial : mVertexStorage)
+            for (auto& vInitial : mVertices)
             {
-                if (vInitial->visited == 0)
+                if (vInitial.visited == 0)
                 {
                     components.push_back(std::vector<Vertex*>());
-                    DepthFirstSearch(vInitial.get(), components.back());
+                    DepthFirstSearch(&vInitial, components.back());
                 }
             }
 
             // The depth-first search is used later for collecting vertices
             // for subgraphs that are detached from the main graph, so the
             // 'visited' flags must be reset to zero after component finding.
-            for (auto vertex : mVertexStorage)
+            for (auto& vertex : mVertices)
             {
-                vertex->visited = 0;
+                vertex.visited = 0;
             }
 
-            // Get the primitives for the components.
-            for (auto& component : components)
-            {
-                forest.push_back(ExtractBasis(component));
-            }
+            // Get the primitives for the components. The components have
+            // disjoint sets of vertices, and each thread has its own storage
+            // for the vertices cloned during the extraction, so the threads
+            // do not share any modified data.
+            size_t const numComponents = components.size();
+            forest.resize(numComponents);
+            numThreads = std::max(std::min(numThreads, numComponents), static_cast<size_t>(1));
+            mClones.resize(numThreads);
+            std::atomic<size_t> nextComponent(0);
+            TaskScheduler::ParallelFor(scheduler, numThreads,
+                [this, &components, &forest, &nextComponent, numComponents](size_t t)
+                {
+                    try
+                    {
+                        for (size_t c = nextComponent++; c < numComponents; c = nextComponent++)
+                        {
+                            forest[c] = ExtractBasis(components[c], mClones[t]);
+                        }
+                    }
+                    catch (...)
+                    {
+                        nextComponent = numComponents;
+                        throw;
+                    }
+                });
         }
 
         // No copy or assignment allowed.
@@ -149,16 +191,51 @@ namespace gte
             // graph components.
             std::array<Real, 2> const* position;
 
-            // The mVertexStorage member owns the Vertex objects and maintains
-            // the reference counts on those objects.  The adjacent pointers
-            // are considered to be weak pointers; neither object ownership
-            // nor reference counting is required by 'adjacent'.
-            std::set<Vertex*> adjacent;
+            // The mVertices and mClones members own the Vertex objects.
+            // The adjacency array is unordered and has no duplicates. The
+            // degrees of planar graphs are small on average, so linear
+            // searches of the array are faster than the searches of an
+            // ordered set, and the array does not allocate a node per edge.
+            std::vector<Vertex*> adjacent;
 
             // Support for depth-first traversal of a graph.
             int visited;
         };
 
+        // Storage for the vertices cloned while extracting the basis of a
+        // component. A deque does not move its elements when it grows, so
+        // pointers to the clones remain valid.
+        using CloneStorage = std::deque<Vertex>;
+
+        // Edge insertion and removal for the adjacency arrays.
+        static void Attach(Vertex* v0, Vertex* v1)
+        {
+            if (std::find(v0->adjacent.begin(), v0->adjacent.end(), v1) == v0->adjacent.end())
+            {
+                v0->adjacent.push_back(v1);
+            }
+            if (std::find(v1->adjacent.begin(), v1->adjacent.end(), v0) == v1->adjacent.end())
+            {
+                v1->adjacent.push_back(v0);
+            }
+        }
+
+        static void Erase(Vertex* vertex, Vertex* adjacent)
+        {
+            auto iter = std::find(vertex->adjacent.begin(), vertex->adjacent.end(), adjacent);
+            if (iter != vertex->adjacent.end())
+            {
+                *iter = vertex->adjacent.back();
+                vertex->adjacent.pop_back();
+            }
+        }
+
+        static void Detach(Vertex* v0, Vertex* v1)
+        {
+            Erase(v0, v1);
+            Erase(v1, v0);
+        }
+
         // The constructor uses GetComponents(...) and DepthFirstSearch(...)
         // to get the connected components of the graph implied by the input
         // 'edges'.  Recursive processing uses only DepthFirstSearch(...) to
@@ -192,7 +269,8 @@ namespace gte
         }
 
         // Support for traversing a simply connected component of the graph.
-        std::shared_ptr<Tree> ExtractBasis(std::vector<Vertex*>& component)
+        std::shared_ptr<Tree> ExtractBasis(std::vector<Vertex*>& component,
+            CloneStorage& clones)
         {
             // The root will not have its 'cycle' member set.  The children
             // are the cycle trees extracted from the component.
@@ -202,7 +280,7 @@ namespace gte
                 RemoveFilaments(component);
                 if (component.size() > 0)
                 {
-                    tree->children.push_back(ExtractCycleFromComponent(component));
+                    tree->children.push_back(ExtractCycleFromComponent(component, clones));
                 }
             }
 
@@ -245,9 +323,8 @@ namespace gte
                         while (vertex->adjacent.size() == 1)
                         {
                             // Break the connection between the two vertices.
-                            Vertex* adjacent = *vertex->adjacent.begin();
-                            adjacent->adjacent.erase(vertex);
-                            vertex->adjacent.erase(adjacent);
+                            Vertex* adjacent = vertex->adjacent.front();
+                            Detach(vertex, adjacent);
 
                             // Traverse to the adjacent vertex.
                             vertex = adjacent;
@@ -272,7 +349,8 @@ namespace gte
             }
         }
 
-        std::shared_ptr<Tree> ExtractCycleFromComponent(std::vector<Vertex*>& component)
+        std::shared_ptr<Tree> ExtractCycleFromComponent(std::vector<Vertex*>& component,
+            CloneStorage& clones)
         {
             // Search for the left-most vertex of the component.  If two or
             // more vertices attain minimum x-value, select the one that has
@@ -303,7 +381,7 @@ namespace gte
             closedWalk.push_back(vStart);
 
             // Recursively process the closed walk to extract cycles.
-            auto tree = ExtractCycleFromClosedWalk(closedWalk);
+            auto tree = ExtractCycleFromClosedWalk(closedWalk, clones);
 
             // The isolated vertices generated by cycle removal are also
             // removed from the component.
@@ -321,7 +399,8 @@ namespace gte
             return tree;
         }
 
-        std::shared_ptr<Tree> ExtractCycleFromClosedWalk(std::vector<Vertex*>& closedWalk)
+        std::shared_ptr<Tree> ExtractCycleFromClosedWalk(std::vector<Vertex*>& closedWalk,
+            CloneStorage& clones)
         {
             auto tree = std::make_shared<Tree>();
 
@@ -387,9 +466,8 @@ namespace gte
                     bool isConvex = (dMax[0] * dMin[1] >= dMax[1] * dMin[0]);
                     (void)isConvex;
 
-                    std::set<Vertex*> inWedge;
-                    std::set<Vertex*> adjacent = original->adjacent;
-                    for (auto vertex : adjacent)
+                    std::vector<Vertex*> inWedge;
+                    for (auto vertex : original->adjacent)
                     {
                         if (vertex->name == minVertex->name || vertex->name == maxVertex->name)
                         {
@@ -417,7 +495,7 @@ namespace gte
                         }
                         if (containsVertex)
                         {
-                            inWedge.insert(vertex);
+                            inWedge.push_back(vertex);
                         }
                     }
 
@@ -427,25 +505,23 @@ namespace gte
                         // that lie inside the wedge defined by the first and
                         // last edges of the subgraph rooted at 'original'.
                         // The sorting is in the clockwise direction.
-                        auto clone = std::make_shared<Vertex>(original->name, original->position);
-                        mVertexStorage.push_back(clone);
+                        clones.emplace_back(original->name, original->position);
+                        Vertex* clone = &clones.back();
 
                         // Detach the edges inside the wedge.
                         for (auto vertex : inWedge)
                         {
-                            original->adjacent.erase(vertex);
-                            vertex->adjacent.erase(original);
-                            clone->adjacent.insert(vertex);
-                            vertex->adjacent.insert(clone.get());
+                            Detach(original, vertex);
+                            Attach(clone, vertex);
                         }
 
                         // Get the subgraph (it is a single connected
                         // component).
                         std::vector<Vertex*> component;
-                        DepthFirstSearch(clone.get(), component);
+                        DepthFirstSearch(clone, component);
 
                         // Extract the cycles of the subgraph.
-                        tree->children.push_back(ExtractBasis(component));
+                        tree->children.push_back(ExtractBasis(component, clones));
                     }
                     // else the candidate was closedWalk[0] and it has no
                     // subgraph to detach.
@@ -460,20 +536,18 @@ namespace gte
                 Vertex* original = closedWalk[0];
                 Vertex* adjacent = closedWalk[1];
 
-                auto clone = std::make_shared<Vertex>(original->name, original->position);
-                mVertexStorage.push_back(clone);
+                clones.emplace_back(original->name, original->position);
+                Vertex* clone = &clones.back();
 
-                original->adjacent.erase(adjacent);
-                adjacent->adjacent.erase(original);
-                clone->adjacent.insert(adjacent);
-                adjacent->adjacent.insert(clone.get());
+                Detach(original, adjacent);
+                Attach(clone, adjacent);
 
                 // Get the subgraph (it is a single connected component).
                 std::vector<Vertex*> component;
-                DepthFirstSearch(clone.get(), component);
+                DepthFirstSearch(clone, component);
 
                 // Extract the cycles of the subgraph.
-                tree->children.push_back(ExtractBasis(component));
+                tree->children.push_back(ExtractBasis(component, clones));
                 if (tree->cycle.size() == 0 && tree->children.size() == 1)
                 {
                     // Replace the parent by the child to avoid having two
@@ -505,15 +579,13 @@ namespace gte
             Vertex* v0 = closedWalk[0];
             Vertex* v1 = closedWalk[1];
             Vertex* vBranch = (v0->adjacent.size() > 2 ? v0 : nullptr);
-            v0->adjacent.erase(v1);
-            v1->adjacent.erase(v0);
+            Detach(v0, v1);
 
             // Remove edges while traversing counterclockwise.
             while (v1 != vBranch && v1->adjacent.size() == 1)
             {
-                Vertex* adj = *v1->adjacent.begin();
-                v1->adjacent.erase(adj);
-                adj->adjacent.erase(v1);
+                Vertex* adj = v1->adjacent.front();
+                Detach(v1, adj);
                 v1 = adj;
             }
 
@@ -531,9 +603,8 @@ namespace gte
                 // Remove edges while traversing clockwise.
                 while (v0 != vBranch && v0->adjacent.size() == 1)
                 {
-                    v1 = *v0->adjacent.begin();
-                    v0->adjacent.erase(v1);
-                    v1->adjacent.erase(v0);
+                    v1 = v0->adjacent.front();
+                    Detach(v0, v1);
                     v0 = v1;
                 }
             }
@@ -674,8 +745,10 @@ namespace gte
             return vNext;
         }
 
-        // Storage for referenced vertices of the original graph and for new
-        // vertices added during graph traversal.
-        std::vector<std::shared_ptr<Vertex>> mVertexStorage;
+        // Storage for referenced vertices of the original graph and, one
+        // container per thread, for new vertices added during graph
+        // traversal.
+        std::vector<Vertex> mVertices;
+        std::vector<CloneStorage> mClones;
     };
 }
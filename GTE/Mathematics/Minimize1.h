@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.06.09
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -12,6 +12,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <vector>
 
 // Search for a minimum of F(t) on [t0,t1] using successive parabolic
 // interpolation. The search is recursive based on the polyline associated
@@ -28,6 +30,15 @@
 //
 // If the polyline is not V-shaped, both subintervals [t0,tm] and [tm,t1]
 // are searched for a minimum.
+//
+// The function can be provided in batch form, F(numT, t, f), which must
+// store F(t[i]) in f[i] for 0 <= i < numT. The subintervals are then
+// processed concurrently rather than recursively. The samples of all the
+// subintervals and brackets that are active are passed in a single call to
+// the batch function, so that it can evaluate them in parallel. The result
+// is the same as that of the recursive search with the corresponding scalar
+// function; when several samples have the minimum function value, the one
+// found first by the recursive search is reported.
 
 namespace gte
 {
@@ -54,6 +65,26 @@ namespace gte
             SetTolerance(tolerance);
         }
 
+        typedef std::function<void(size_t, T const*, T*)> BatchFunction;
+
+        Minimize1(BatchFunction const& F, int32_t maxSubdivisions,
+            int32_t maxBisections, T epsilon = static_cast<T>(1e-08),
+            T tolerance = static_cast<T>(1e-04))
+            :
+            mBatchFunction(F),
+            mMaxSubdivisions(maxSubdivisions),
+            mMaxBisections(maxBisections),
+            mEpsilon(std::max(epsilon, static_cast<T>(0))),
+            mTolerance(std::max(tolerance, static_cast<T>(0)))
+        {
+            LogAssert(
+                mMaxSubdivisions > 0 && mMaxBisections > 0,
+                "Invalid argument.");
+
+            SetEpsilon(epsilon);
+            SetTolerance(tolerance);
+        }
+
         // Member access.
         inline void SetEpsilon(T epsilon)
         {
@@ -92,6 +123,12 @@ namespace gte
                 t0 <= tInitial && tInitial <= t1,
                 "Invalid initial t value.");
 
+            if (mBatchFunction)
+            {
+                GetBatchMinimum(t0, t1, tInitial, tMin, fMin);
+                return;
+            }
+
             // Compute the minimum for the 3 initial points.
             mTMin = std::numeric_limits<T>::max();
             mFMin = std::numeric_limits<T>::max();
@@ -119,8 +156,7 @@ namespace gte
 
             // Search for the global minimum on [t0,t1] with tInitial chosen
             // hopefully to start with a minimum bracket.
-            if (((fInitial < f0) && (f1 >= fInitial)) ||
-                ((f1 > fInitial) && (f0 >= fInitial)))
+            if (IsVShaped(f0, fInitial, f1))
             {
                 // The polyline {(f0,f0), (tInitial,fInitial), (t1,f1)} is V-shaped.
                 GetBracketedMinimum(t0, f0, tInitial, fInitial, t1, f1);
@@ -157,7 +193,7 @@ namespace gte
                 mFMin = fm;
             }
 
-            if (((fm < f0) && (f1 >= fm)) || ((f1 > fm) && (f0 >= fm)))
+            if (IsVShaped(f0, fm, f1))
             {
                 // The polyline {(f0,f0), (tm,fm), (t1,f1)} is V-shaped.
                 GetBracketedMinimum(t0, f0, tm, fm, t1, f1);
@@ -174,7 +210,6 @@ namespace gte
         // This is called when {f0,f1,f2} brackets a minimum.
         void GetBracketedMinimum(T t0, T f0, T tm, T fm, T t1, T f1)
         {
-            T const two = static_cast<T>(2);
             T const half = static_cast<T>(0.5);
 
             for (int32_t i = 0; i < mMaxBisections; ++i)
@@ -186,31 +221,13 @@ namespace gte
                     mFMin = fm;
                 }
 
-                // Test for convergence.
-                T dt10 = t1 - t0;
-                T dtBound = two * mTolerance * std::fabs(tm) + mEpsilon;
-                if (dt10 <= dtBound)
-                {
-                    break;
-                }
-
                 // Compute the vertex of the interpolating parabola.
-                T dt0m = t0 - tm;
-                T dt1m = t1 - tm;
-                T df0m = f0 - fm;
-                T df1m = f1 - fm;
-                T tmp0 = dt0m * df1m;
-                T tmp1 = dt1m * df0m;
-                T denom = tmp1 - tmp0;
-                if (std::fabs(denom) <= mEpsilon)
+                T tv;
+                if (!GetParabolaVertex(t0, f0, tm, fm, t1, f1, tv))
                 {
                     return;
                 }
 
-                // Compute tv and clamp to [t0,t1] to offset floating-point
-                // rounding errors.
-                T tv = tm + half * (dt1m * tmp1 - dt0m * tmp0) / denom;
-                tv = std::max(t0, std::min(tv, t1));
                 T fv = mFunction(tv);
                 if (fv < mFMin)
                 {
@@ -218,35 +235,9 @@ namespace gte
                     mFMin = fv;
                 }
 
-                if (tv < tm)
+                if (tv < tm || tv > tm)
                 {
-                    if (fv < fm)
-                    {
-                        t1 = tm;
-                        f1 = fm;
-                        tm = tv;
-                        fm = fv;
-                    }
-                    else
-                    {
-                        t0 = tv;
-                        f0 = fv;
-                    }
-                }
-                else if (tv > tm)
-                {
-                    if (fv < fm)
-                    {
-                        t0 = tm;
-                        f0 = fm;
-                        tm = tv;
-                        fm = fv;
-                    }
-                    else
-                    {
-                        t1 = tv;
-                        f1 = fv;
-                    }
+                    UpdateBracket(tv, fv, t0, f0, tm, fm, t1, f1);
                 }
                 else
                 {
@@ -254,90 +245,347 @@ namespace gte
                     // point. A minimum could occur on either subinterval, but
                     // it is also possible the minimum occurs at the vertex.
                     // In either case, the search is continued by examining a
-                    // neighborhood of the vertex. When two choices exist for
-                    // a bracket, the one with the smallest function value at
-                    // the midpoint is used.
+                    // neighborhood of the vertex.
                     T tm0 = half * (t0 + tm);
                     T fm0 = mFunction(tm0);
                     T tm1 = half * (tm + t1);
                     T fm1 = mFunction(tm1);
+                    UpdateBracket(tm0, fm0, tm1, fm1, t0, f0, tm, fm, t1, f1);
+                }
+            }
+        }
+
+        // The state of a subinterval or a bracket of the batch search. The
+        // path is the sequence of left (0) and right (1) choices of the
+        // subdivisions that led to the search, and the samples of the search
+        // are numbered consecutively. The order of the pairs (path,number)
+        // is the order in which the recursive search computes the samples.
+        struct Search
+        {
+            std::vector<int32_t> path;
+            int32_t number;
+            bool bracketed;
+            int32_t remaining;
+            T t0, f0, tm, fm, t1, f1;
+            size_t first, count;
+        };
+
+        void GetBatchMinimum(T t0, T t1, T tInitial, T& tMin, T& fMin)
+        {
+            T const half = static_cast<T>(0.5);
+
+            mTMin = std::numeric_limits<T>::max();
+            mFMin = std::numeric_limits<T>::max();
+            mMinPath.clear();
+            mMinNumber = -1;
+
+            // Compute the function for the 3 initial points.
+            mT.resize(3);
+            mF.resize(3);
+            mT[0] = t0;
+            mT[1] = tInitial;
+            mT[2] = t1;
+            mBatchFunction(3, mT.data(), mF.data());
+            std::vector<int32_t> const empty{};
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                UpdateMinimum(mT[j], mF[j], empty, j);
+            }
+            T f0 = mF[0], fInitial = mF[1], f1 = mF[2];
+
+            std::vector<Search> active, next;
+            if (IsVShaped(f0, fInitial, f1))
+            {
+                active.push_back({ empty, 3, true, mMaxBisections,
+                    t0, f0, tInitial, fInitial, t1, f1, 0, 0 });
+            }
+            else
+            {
+                active.push_back({ std::vector<int32_t>{ 0 }, 0, false, mMaxSubdivisions,
+                    t0, f0, (T)0, (T)0, tInitial, fInitial, 0, 0 });
+                active.push_back({ std::vector<int32_t>{ 1 }, 0, false, mMaxSubdivisions,
+                    tInitial, fInitial, (T)0, (T)0, t1, f1, 0, 0 });
+            }
 
-                    if (fm0 < fm)
+            while (active.size() > 0)
+            {
+                // Generate the samples of all the active searches.
+                mT.clear();
+                next.clear();
+                for (auto& search : active)
+                {
+                    search.first = mT.size();
+                    if (search.remaining-- == 0)
+                    {
+                        continue;
+                    }
+
+                    if (search.bracketed)
                     {
-                        if (fm1 < fm)
+                        T tv;
+                        if (GetParabolaVertex(search.t0, search.f0, search.tm,
+                            search.fm, search.t1, search.f1, tv))
                         {
-                            if (fm0 < fm1)
+                            mT.push_back(tv);
+                            if (!(tv < search.tm || tv > search.tm))
                             {
-                                // {(t0,f0),(tm0,fm0),(tm,fm)}
-                                t1 = tm;
-                                f1 = fm;
-                                tm = tm0;
-                                fm = fm0;
+                                mT.push_back(half * (search.t0 + search.tm));
+                                mT.push_back(half * (search.tm + search.t1));
                             }
-                            else
-                            {
-                                // {(tm,fm),(tm1,fm1),(t1,f1)}
-                                t0 = tm;
-                                f0 = fm;
-                                tm = tm1;
-                                fm = fm1;
-                            }
-                        }
-                        else // fm1 >= fm
-                        {
-                            // {(t0,f0),(tm0,fm0),(tm,fm)}
-                            t1 = tm;
-                            f1 = fm;
-                            tm = tm0;
-                            fm = fm0;
                         }
                     }
-                    else if (fm0 > fm)
+                    else
                     {
-                        if (fm1 < fm)
-                        {
-                            // {(tm,fm),(tm1,fm1),(t1,f1)}
-                            t0 = tm;
-                            f0 = fm;
-                            tm = tm1;
-                            fm = fm1;
-                        }
-                        else // fm1 >= fm
-                        {
-                            // {(tm0,fm0),(tm,fm),(tm1,fm1)}
-                            t0 = tm0;
-                            f0 = fm0;
-                            t1 = tm1;
-                            f1 = fm1;
-                        }
+                        mT.push_back(half * (search.t0 + search.t1));
                     }
-                    else  // fm0 = fm
+                    search.count = mT.size() - search.first;
+                    if (search.count > 0)
                     {
-                        if (fm1 < fm)
+                        next.push_back(search);
+                    }
+                }
+
+                if (mT.size() == 0)
+                {
+                    break;
+                }
+
+                mF.resize(mT.size());
+                mBatchFunction(mT.size(), mT.data(), mF.data());
+
+                // Update the searches using the function values.
+                active.clear();
+                for (auto& search : next)
+                {
+                    T const* t = &mT[search.first];
+                    T const* f = &mF[search.first];
+                    for (size_t j = 0; j < search.count; ++j)
+                    {
+                        UpdateMinimum(t[j], f[j], search.path,
+                            search.number + static_cast<int32_t>(j));
+                    }
+                    search.number += static_cast<int32_t>(search.count);
+
+                    if (search.bracketed)
+                    {
+                        if (search.count == 1)
                         {
-                            // {(tm,fm),(tm1,fm1),(t1,f1)}
-                            t0 = tm;
-                            f0 = fm;
-                            tm = tm1;
-                            fm = fm1;
+                            UpdateBracket(t[0], f[0], search.t0, search.f0,
+                                search.tm, search.fm, search.t1, search.f1);
                         }
-                        else // fm1 >= fm
+                        else
                         {
-                            // {(tm0,fm0),(tm,fm),(tm1,fm1)}
-                            t0 = tm0;
-                            f0 = fm0;
-                            t1 = tm1;
-                            f1 = fm1;
+                            UpdateBracket(t[1], f[1], t[2], f[2], search.t0,
+                                search.f0, search.tm, search.fm, search.t1,
+                                search.f1);
                         }
+                        active.push_back(search);
+                    }
+                    else if (IsVShaped(search.f0, f[0], search.f1))
+                    {
+                        search.bracketed = true;
+                        search.remaining = mMaxBisections;
+                        search.tm = t[0];
+                        search.fm = f[0];
+                        active.push_back(search);
+                    }
+                    else
+                    {
+                        Search left = search, right = search;
+                        left.path.push_back(0);
+                        left.number = 0;
+                        left.t1 = t[0];
+                        left.f1 = f[0];
+                        right.path.push_back(1);
+                        right.number = 0;
+                        right.t0 = t[0];
+                        right.f0 = f[0];
+                        active.push_back(std::move(left));
+                        active.push_back(std::move(right));
                     }
                 }
             }
+
+            tMin = mTMin;
+            fMin = mFMin;
+        }
+
+        // Keep the sample with the smallest function value. For equal
+        // values, keep the sample computed first by the recursive search.
+        void UpdateMinimum(T t, T f, std::vector<int32_t> const& path, int32_t number)
+        {
+            if (f < mFMin || (f == mFMin && mMinNumber >= 0 &&
+                (path < mMinPath || (path == mMinPath && number < mMinNumber))))
+            {
+                mTMin = t;
+                mFMin = f;
+                mMinPath = path;
+                mMinNumber = number;
+            }
+        }
+
+        static inline bool IsVShaped(T f0, T fm, T f1)
+        {
+            return ((fm < f0) && (f1 >= fm)) || ((f1 > fm) && (f0 >= fm));
+        }
+
+        // Compute the vertex tv of the parabola interpolating the bracket
+        // {(t0,f0),(tm,fm),(t1,f1)}. The return value is false when the
+        // bracket has converged or when the parabola is degenerate.
+        bool GetParabolaVertex(T t0, T f0, T tm, T fm, T t1, T f1, T& tv) const
+        {
+            T const two = static_cast<T>(2);
+            T const half = static_cast<T>(0.5);
+
+            // Test for convergence.
+            T dt10 = t1 - t0;
+            T dtBound = two * mTolerance * std::fabs(tm) + mEpsilon;
+            if (dt10 <= dtBound)
+            {
+                return false;
+            }
+
+            T dt0m = t0 - tm;
+            T dt1m = t1 - tm;
+            T df0m = f0 - fm;
+            T df1m = f1 - fm;
+            T tmp0 = dt0m * df1m;
+            T tmp1 = dt1m * df0m;
+            T denom = tmp1 - tmp0;
+            if (std::fabs(denom) <= mEpsilon)
+            {
+                return false;
+            }
+
+            // Compute tv and clamp to [t0,t1] to offset floating-point
+            // rounding errors.
+            tv = tm + half * (dt1m * tmp1 - dt0m * tmp0) / denom;
+            tv = std::max(t0, std::min(tv, t1));
+            return true;
+        }
+
+        // Update the bracket using the sample (tv,fv) for tv != tm.
+        static void UpdateBracket(T tv, T fv, T& t0, T& f0, T& tm, T& fm, T& t1, T& f1)
+        {
+            if (tv < tm)
+            {
+                if (fv < fm)
+                {
+                    t1 = tm;
+                    f1 = fm;
+                    tm = tv;
+                    fm = fv;
+                }
+                else
+                {
+                    t0 = tv;
+                    f0 = fv;
+                }
+            }
+            else
+            {
+                if (fv < fm)
+                {
+                    t0 = tm;
+                    f0 = fm;
+                    tm = tv;
+                    fm = fv;
+                }
+                else
+                {
+                    t1 = tv;
+                    f1 = fv;
+                }
+            }
+        }
+
+        // Update the bracket using the samples (tm0,fm0) and (tm1,fm1) at
+        // the midpoints of [t0,tm] and [tm,t1]. When two choices exist for
+        // a bracket, the one with the smallest function value at the
+        // midpoint is used.
+        static void UpdateBracket(T tm0, T fm0, T tm1, T fm1,
+            T& t0, T& f0, T& tm, T& fm, T& t1, T& f1)
+        {
+            if (fm0 < fm)
+            {
+                if (fm1 < fm)
+                {
+                    if (fm0 < fm1)
+                    {
+                        // {(t0,f0),(tm0,fm0),(tm,fm)}
+                        t1 = tm;
+                        f1 = fm;
+                        tm = tm0;
+                        fm = fm0;
+                    }
+                    else
+                    {
+                        // {(tm,fm),(tm1,fm1),(t1,f1)}
+                        t0 = tm;
+                        f0 = fm;
+                        tm = tm1;
+                        fm = fm1;
+                    }
+                }
+                else // fm1 >= fm
+                {
+                    // {(t0,f0),(tm0,fm0),(tm,fm)}
+                    t1 = tm;
+                    f1 = fm;
+                    tm = tm0;
+                    fm = fm0;
+                }
+            }
+            else if (fm0 > fm)
+            {
+                if (fm1 < fm)
+                {
+                    // {(tm,fm),(tm1,fm1),(t1,f1)}
+                    t0 = tm;
+                    f0 = fm;
+                    tm = tm1;
+                    fm = fm1;
+                }
+                else // fm1 >= fm
+                {
+                    // {(tm0,fm0),(tm,fm),(tm1,fm1)}
+                    t0 = tm0;
+                    f0 = fm0;
+                    t1 = tm1;
+                    f1 = fm1;
+                }
+            }
+            else  // fm0 = fm
+            {
+                if (fm1 < fm)
+                {
+                    // {(tm,fm),(tm1,fm1),(t1,f1)}
+                    t0 = tm;
+                    f0 = fm;
+                    tm = tm1;
+                    fm = fm1;
+                }
+                else // fm1 >= fm
+                {
+                    // {(tm0,fm0),(tm,fm),(tm1,fm1)}
+                    t0 = tm0;
+                    f0 = fm0;
+                    t1 = tm1;
+                    f1 = fm1;
+                }
+            }
         }
 
         std::function<T(T)> mFunction;
+        BatchFunction mBatchFunction;
         int32_t mMaxSubdivisions;
         int32_t mMaxBisections;
         T mTMin, mFMin;
         T mEpsilon, mTolerance;
+
+        // Support for the batch search.
+        std::vector<T> mT, mF;
+        std::vector<int32_t> mMinPath;
+        int32_t mMinNumber;
     };
 }
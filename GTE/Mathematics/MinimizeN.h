@@ -3,13 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/GVector.h>
 #include <Mathematics/Minimize1.h>
+#include <Mathematics/TaskScheduler.h>
+#include <cmath>
 #include <cstring>
+#include <memory>
 
 // The Cartesian-product domain provided to GetMinimum(*) has minimum values
 // stored in t0[0..d-1] and maximum values stored in t1[0..d-1], where d is
@@ -20,6 +23,22 @@
 // Minimize1<Real>, so read the documentation for that class (in its header
 // file) to understand what these mean. The input 'maxIterations' is the
 // number of iterations for the direction-set method.
+//
+// The function can be provided in batch form, F(numPoints, points, values),
+// which must store in values[i] the function value at the point stored in
+// points[d*i..d*i+d-1] for 0 <= i < numPoints. The line searches then pass
+// the samples of their concurrent subintervals and brackets to F in a single
+// call; see Minimize1.h. MakeBatchFunction(*) creates a batch function that
+// evaluates a function F(point) in parallel using a TaskScheduler object, in
+// which case F must be safe to call concurrently. The results are the same
+// as those for the function itself.
+//
+// Functions with many local minima, such as the error functions of fitting
+// algorithms with bad initial guesses, can be searched from multiple initial
+// guesses with GetMinimum(t0, t1, numStarts, tInitials, ...). These searches
+// are independent and are distributed among threads. GeneratePopulation(*)
+// computes a population of initial guesses that are uniformly distributed
+// in the domain.
 
 namespace gte
 {
@@ -40,7 +59,9 @@ namespace gte
             mDCurrIndex(0),
             mTCurr(dimensions),
             mTSave(dimensions),
-            mMinimizer([this](Real t){ return mFunction(&(mTCurr + t * mDirections[mDCurrIndex])[0]); }, maxLevel, maxBracket)
+            mMinimizer([this](Real t){ return mFunction(&(mTCurr + t * mDirections[mDCurrIndex])[0]); }, maxLevel, maxBracket),
+            mMaxLevel(maxLevel),
+            mMaxBracket(maxBracket)
         {
             SetEpsilon(epsilon);
             for (auto& direction : mDirections)
@@ -49,6 +70,115 @@ namespace gte
             }
         }
 
+        typedef std::function<void(size_t, Real const*, Real*)> BatchFunction;
+
+        MinimizeN(int dimensions, BatchFunction const& F, int maxLevel,
+            int maxBracket, int maxIterations, Real epsilon = (Real)1e-06)
+            :
+            mDimensions(dimensions),
+            mBatchFunction(F),
+            mMaxIterations(maxIterations),
+            mEpsilon(0),
+            mDirections(dimensions + 1),
+            mDConjIndex(dimensions),
+            mDCurrIndex(0),
+            mTCurr(dimensions),
+            mTSave(dimensions),
+            mMinimizer([this](size_t numT, Real const* t, Real* f){ EvaluateLine(numT, t, f); }, maxLevel, maxBracket),
+            mMaxLevel(maxLevel),
+            mMaxBracket(maxBracket)
+        {
+            SetEpsilon(epsilon);
+            for (auto& direction : mDirections)
+            {
+                direction.SetSize(dimensions);
+            }
+        }
+
+        // Create a batch function that evaluates F at the points in parallel
+        // using the scheduler. If the scheduler is null, the points are
+        // evaluated sequentially.
+        static BatchFunction MakeBatchFunction(int dimensions,
+            std::function<Real(Real const*)> const& F, TaskScheduler* scheduler)
+        {
+            return [dimensions, F, scheduler](size_t numPoints, Real const* points, Real* values)
+            {
+                size_t const numChunks = (scheduler ? std::min(numPoints,
+                    4 * scheduler->GetNumThreads()) : 1);
+                if (numChunks <= 1)
+                {
+                    for (size_t i = 0; i < numPoints; ++i)
+                    {
+                        values[i] = F(points + i * static_cast<size_t>(dimensions));
+                    }
+                    return;
+                }
+
+                auto evaluate = [dimensions, &F, points, values](size_t i0, size_t i1)
+                {
+                    for (size_t i = i0; i < i1; ++i)
+                    {
+                        values[i] = F(points + i * static_cast<size_t>(dimensions));
+                    }
+                };
+
+                TaskScheduler::TaskGroup group;
+                for (size_t c = 1; c < numChunks; ++c)
+                {
+                    size_t i0 = c * numPoints / numChunks;
+                    size_t i1 = (c + 1) * numPoints / numChunks;
+                    scheduler->Spawn(group, [&evaluate, i0, i1]() { evaluate(i0, i1); });
+                }
+                evaluate(0, numPoints / numChunks);
+                scheduler->Wait(group);
+            };
+        }
+
+        // Compute numStarts points of the Halton sequence in the
+        // Cartesian-product domain whose minimum values are stored in
+        // t0[0..d-1] and whose maximum values are stored in t1[0..d-1]. The
+        // points are stored in tInitials[d*i..d*i+d-1] for
+        // 0 <= i < numStarts.
+        static void GeneratePopulation(int dimensions, Real const* t0, Real const* t1,
+            size_t numStarts, Real* tInitials)
+        {
+            // The prime bases of the coordinates.
+            std::vector<size_t> bases;
+            for (size_t candidate = 2; static_cast<int>(bases.size()) < dimensions; ++candidate)
+            {
+                bool isPrime = true;
+                for (auto base : bases)
+                {
+                    if (candidate % base == 0)
+                    {
+                        isPrime = false;
+                        break;
+                    }
+                }
+                if (isPrime)
+                {
+                    bases.push_back(candidate);
+                }
+            }
+
+            for (size_t i = 0; i < numStarts; ++i)
+            {
+                Real* tInitial = tInitials + i * static_cast<size_t>(dimensions);
+                for (int j = 0; j < dimensions; ++j)
+                {
+                    // The radical inverse of i+1 in the base.
+                    Real inverse = (Real)1 / (Real)bases[j];
+                    Real scale = inverse, u = (Real)0;
+                    for (size_t k = i + 1; k > 0; k /= bases[j])
+                    {
+                        u += scale * (Real)(k % bases[j]);
+                        scale *= inverse;
+                    }
+                    tInitial[j] = t0[j] + u * (t1[j] - t0[j]);
+                }
+            }
+        }
+
         // Member access.
         inline void SetEpsilon(Real epsilon)
         {
@@ -69,7 +199,14 @@ namespace gte
         {
             // The initial guess.
             size_t numBytes = mDimensions * sizeof(Real);
-            mFCurr = mFunction(tInitial);
+            if (mFunction)
+            {
+                mFCurr = mFunction(tInitial);
+            }
+            else
+            {
+                mBatchFunction(1, tInitial, &mFCurr);
+            }
             std::memcpy(&mTSave[0], tInitial, numBytes);
             std::memcpy(&mTCurr[0], tInitial, numBytes);
 
@@ -124,7 +261,98 @@ namespace gte
             fMin = mFCurr;
         }
 
+        // Find the minimum using each of the initial guesses stored in
+        // tInitials[d*i..d*i+d-1] for 0 <= i < numStarts. The searches are
+        // distributed among numThreads threads, which are tasks of the
+        // scheduler when it is not null, so the function must be safe to
+        // call concurrently when numThreads > 1. The location of the
+        // smallest minimum is tMin[0..d-1] and the value of the minimum is
+        // 'fMin'. The return value is the index of the initial guess that
+        // led to it; when several searches lead to the same value, the index
+        // is the smallest one. The result does not depend on numThreads.
+        size_t GetMinimum(Real const* t0, Real const* t1, size_t numStarts,
+            Real const* tInitials, Real* tMin, Real& fMin, size_t numThreads,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(numStarts > 0, "Invalid input.");
+
+            size_t const d = static_cast<size_t>(mDimensions);
+            std::vector<Real> locations(numStarts * d), values(numStarts);
+            numThreads = std::max(std::min(numThreads, numStarts), static_cast<size_t>(1));
+            if (numThreads == 1)
+            {
+                for (size_t i = 0; i < numStarts; ++i)
+                {
+                    GetMinimum(t0, t1, tInitials + i * d, &locations[i * d], values[i]);
+                }
+            }
+            else
+            {
+                // Each thread uses its own minimizer, because the object
+                // stores the state of the search.
+                TaskScheduler::ParallelFor(scheduler, numThreads,
+                    [this, numThreads, numStarts, d, t0, t1, tInitials, &locations, &values](size_t t)
+                    {
+                        std::unique_ptr<MinimizeN> minimizer = CreateMinimizer();
+                        for (size_t i = t; i < numStarts; i += numThreads)
+                        {
+                            minimizer->GetMinimum(t0, t1, tInitials + i * d,
+                                &locations[i * d], values[i]);
+                        }
+                    });
+            }
+
+            size_t best = 0;
+            for (size_t i = 1; i < numStarts; ++i)
+            {
+                if (values[i] < values[best] ||
+                    (std::isnan(values[best]) && !std::isnan(values[i])))
+                {
+                    best = i;
+                }
+            }
+
+            std::memcpy(tMin, &locations[best * d], d * sizeof(Real));
+            fMin = values[best];
+            return best;
+        }
+
     private:
+        // Create a minimizer with the same function and parameters.
+        std::unique_ptr<MinimizeN> CreateMinimizer() const
+        {
+            std::unique_ptr<MinimizeN> minimizer;
+            if (mFunction)
+            {
+                minimizer = std::make_unique<MinimizeN>(mDimensions, mFunction,
+                    mMaxLevel, mMaxBracket, mMaxIterations, mEpsilon);
+            }
+            else
+            {
+                minimizer = std::make_unique<MinimizeN>(mDimensions, mBatchFunction,
+                    mMaxLevel, mMaxBracket, mMaxIterations, mEpsilon);
+            }
+            return minimizer;
+        }
+
+        // Evaluate the batch function at the points mTCurr + t[i] * D of the
+        // current line, where D is the current direction.
+        void EvaluateLine(size_t numT, Real const* t, Real* f)
+        {
+            size_t const d = static_cast<size_t>(mDimensions);
+            mPoints.resize(numT * d);
+            GVector<Real> const& direction = mDirections[mDCurrIndex];
+            for (size_t i = 0; i < numT; ++i)
+            {
+                Real* point = &mPoints[i * d];
+                for (size_t j = 0; j < d; ++j)
+                {
+                    point[j] = mTCurr[j] + t[i] * direction[j];
+                }
+            }
+            mBatchFunction(numT, mPoints.data(), f);
+        }
+
         // The current estimate of the minimum location is mTCurr[0..d-1]. The
         // direction of the current line to search is mDCurr[0..d-1]. This
         // line must be clipped against the Cartesian-product domain, a
@@ -187,6 +415,7 @@ namespace gte
 
         int mDimensions;
         std::function<Real(Real const*)> mFunction;
+        BatchFunction mBatchFunction;
         int mMaxIterations;
         Real mEpsilon;
         std::vector<GVector<Real>> mDirections;
@@ -196,5 +425,7 @@ namespace gte
         GVector<Real> mTSave;
         Real mFCurr;
         Minimize1<Real> mMinimizer;
+        int mMaxLevel, mMaxBracket;
+        std::vector<Real> mPoints;
     };
 }
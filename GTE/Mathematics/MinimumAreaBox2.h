@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.01
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -38,7 +38,11 @@ namespace gte
     {
     public:
         // The class is a functor to support computing the minimum-area box of
-        // multiple data sets using the same class object.
+        // multiple data sets using the same class object.  The convex hull
+        // object and the arrays used by the algorithm are class members
+        // whose storage is reused by later calls, so computing the boxes of
+        // many small data sets does not allocate memory per call.  See
+        // MinimumAreaBox2Batch for processing many data sets in parallel.
         MinimumAreaBox2()
             :
             mNumPoints(0),
@@ -64,9 +68,11 @@ namespace gte
             mNumPoints = numPoints;
             mPoints = points;
             mHull.clear();
+            mSupportIndices = { 0, 0, 0, 0 };
+            mArea = (InputType)0;
 
             // Get the convex hull of the points.
-            ConvexHull2<InputType> ch2;
+            ConvexHull2<InputType>& ch2 = mConvexHull2;
             ch2(mNumPoints, mPoints, (InputType)0);
             int dimension = ch2.GetDimension();
 
@@ -89,42 +95,25 @@ namespace gte
             if (dimension == 1)
             {
                 // The points effectively lie on a line (using fuzzy epsilon).
-                // Determine the extreme t-values for the points represented
-                // as P = origin + t*direction.  We know that 'origin' is an
-                // input vertex, so we can start both t-extremes at zero.
                 Line2<InputType> const& line = ch2.GetLine();
-                InputType tmin = (InputType)0, tmax = (InputType)0;
-                int imin = 0, imax = 0;
-                for (int i = 0; i < mNumPoints; ++i)
-                {
-                    Vector2<InputType> diff = mPoints[i] - line.origin;
-                    InputType t = Dot(diff, line.direction);
-                    if (t > tmax)
-                    {
-                        tmax = t;
-                        imax = i;
-                    }
-                    else if (t < tmin)
-                    {
-                        tmin = t;
-                        imin = i;
-                    }
-                }
-
-                minBox.center = line.origin + (InputType)0.5 * (tmin + tmax) * line.direction;
-                minBox.extent[0] = (InputType)0.5 * (tmax - tmin);
-                minBox.extent[1] = (InputType)0;
-                minBox.axis[0] = line.direction;
-                minBox.axis[1] = -Perp(line.direction);
-                mHull.resize(2);
-                mHull[0] = imin;
-                mHull[1] = imax;
-                return minBox;
+                return ComputeBoxForLine(line.origin, line.direction);
             }
 
             mHull = ch2.GetHull();
             Vector2<InputType> const* vertices = ch2.GetPoints();
-            std::vector<Vector2<ComputeType>> computePoints(mHull.size());
+            if (mHull.size() < 3)
+            {
+                // The floating-point test for the dimension can classify
+                // (nearly) collinear points as 2-dimensional, in which case
+                // the exact hull is a line segment.
+                Vector2<InputType> const& origin = vertices[mHull.front()];
+                Vector2<InputType> direction = vertices[mHull.back()] - origin;
+                Normalize(direction);
+                return ComputeBoxForLine(origin, direction);
+            }
+
+            std::vector<Vector2<ComputeType>>& computePoints = mComputePoints;
+            computePoints.resize(mHull.size());
             for (size_t i = 0; i < mHull.size(); ++i)
             {
                 for (int j = 0; j < 2; ++j)
@@ -159,6 +148,8 @@ namespace gte
             bool useRotatingCalipers = !std::is_floating_point<ComputeType>::value)
         {
             mHull.clear();
+            mSupportIndices = { 0, 0, 0, 0 };
+            mArea = (InputType)0;
 
             OrientedBox2<InputType> minBox;
 
@@ -186,7 +177,8 @@ namespace gte
                 }
             }
 
-            std::vector<Vector2<ComputeType>> computePoints(numIndices);
+            std::vector<Vector2<ComputeType>>& computePoints = mComputePoints;
+            computePoints.resize(numIndices);
             for (int i = 0; i < numIndices; ++i)
             {
                 int h = mHull[i];
@@ -249,13 +241,51 @@ namespace gte
             ComputeType sqrLenU0, area;
         };
 
+        // The points effectively lie on a line.  Determine the extreme
+        // t-values for the points represented as P = origin + t*direction,
+        // where 'direction' is unit length.  We know that 'origin' is an
+        // input vertex, so we can start both t-extremes at zero.
+        OrientedBox2<InputType> ComputeBoxForLine(Vector2<InputType> const& origin,
+            Vector2<InputType> const& direction)
+        {
+            InputType tmin = (InputType)0, tmax = (InputType)0;
+            int imin = 0, imax = 0;
+            for (int i = 0; i < mNumPoints; ++i)
+            {
+                Vector2<InputType> diff = mPoints[i] - origin;
+                InputType t = Dot(diff, direction);
+                if (t > tmax)
+                {
+                    tmax = t;
+                    imax = i;
+                }
+                else if (t < tmin)
+                {
+                    tmin = t;
+                    imin = i;
+                }
+            }
+
+            OrientedBox2<InputType> minBox;
+            minBox.center = origin + (InputType)0.5 * (tmin + tmax) * direction;
+            minBox.extent[0] = (InputType)0.5 * (tmax - tmin);
+            minBox.extent[1] = (InputType)0;
+            minBox.axis[0] = direction;
+            minBox.axis[1] = -Perp(direction);
+            mHull.resize(2);
+            mHull[0] = imin;
+            mHull[1] = imax;
+            return minBox;
+        }
+
         // The rotating calipers algorithm has a loop invariant that requires
         // the convex polygon not to have collinear points.  Any such points
         // must be removed first.  The code is also executed for the O(n^2)
         // algorithm to reduce the number of process edges.
         void RemoveCollinearPoints(std::vector<Vector2<ComputeType>>& vertices)
         {
-            std::vector<Vector2<ComputeType>> tmpVertices = vertices;
+            std::vector<Vector2<ComputeType>>& tmpVertices = mTmpVertices;
+            tmpVertices = vertices;
 
             int const numVertices = static_cast<int>(vertices.size());
             int numNoncollinear = 0;
@@ -307,8 +337,8 @@ namespace gte
             // When the bounding box corresponding to a polygon edge is
             // computed, we mark the edge as visited.  If the edge is
             // encountered later, the algorithm terminates.
-            std::vector<bool> visited(vertices.size());
-            std::fill(visited.begin(), visited.end(), false);
+            std::vector<bool>& visited = mVisited;
+            visited.assign(vertices.size(), false);
 
             // Start the minimum-area rectangle search with the edge from the
             // last polygon vertex to the first.  When updating the extremes,
@@ -636,6 +666,11 @@ namespace gte
         // vertices.
         std::vector<int> mHull;
 
+        // Storage that is reused by the calls to operator().
+        ConvexHull2<InputType> mConvexHull2;
+        std::vector<Vector2<ComputeType>> mComputePoints, mTmpVertices;
+        std::vector<bool> mVisited;
+
         // The support indices for the minimum-area box.
         std::array<int, 4> mSupportIndices;
 
@@ -0,0 +1,108 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/BSPrecisionPredicates.h>
+#include <Mathematics/MinimumAreaBox2.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Compute the minimum-area oriented boxes of many data sets, typically small
+// polygons, with MinimumAreaBox2. The data sets are stored contiguously:
+// data set i has the points[offsets[i]] through points[offsets[i+1]-1], so
+// the offsets array has numSets+1 elements. The data sets are partitioned
+// into chunks that are processed by the threads of a scheduler when it is
+// not null. Each chunk has its own MinimumAreaBox2 object, which is a class
+// member of the batch object, so the convex hull object and the storage of
+// the algorithm are created once and reused for all the data sets of the
+// chunk and for later calls.
+//
+// The ComputeType is chosen for the exact computation of the boxes. For
+// 'float' inputs, it is BSRational<UIntegerFP32<N>> where the N of
+// BSPrecisionPredicates::MinimumAreaBox2<float>() suffices for the
+// worst-case computational path, so no memory is allocated by the
+// arithmetic. For 'double' inputs, that N is 4198, which makes the numbers
+// too large for stack storage, so ComputeType is BSRational<UIntegerAP32>.
+
+namespace gte
+{
+    template <typename InputType>
+    class MinimumAreaBox2Batch
+    {
+    public:
+        using ComputeType = typename std::conditional<std::is_same<InputType, float>::value,
+            BSPrecisionPredicates::MinimumAreaBox2Rational<float>,
+            BSRational<UIntegerAP32>>::type;
+
+        using Solver = MinimumAreaBox2<InputType, ComputeType>;
+
+        MinimumAreaBox2Batch()
+        {
+            static_assert(std::is_floating_point<InputType>::value,
+                "The input type must be 'float' or 'double'.");
+        }
+
+        // Each data set consists of arbitrary points whose convex hull is
+        // computed by the MinimumAreaBox2 solver. If the data sets are
+        // already counterclockwise-ordered, nondegenerate convex polygons,
+        // set areConvexPolygons to 'true' to skip the hull construction. The
+        // array 'boxes' must have numSets elements. The array 'areas' is
+        // optional; when not null, it must have numSets elements and
+        // receives the areas computed by the solver.
+        void operator()(size_t numSets, int32_t const* offsets,
+            Vector2<InputType> const* points, bool areConvexPolygons,
+            OrientedBox2<InputType>* boxes, InputType* areas = nullptr,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(offsets != nullptr && points != nullptr && boxes != nullptr,
+                "Invalid input.");
+
+            size_t const numChunks = (scheduler ?
+                std::max(std::min(numSets, 4 * scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+            if (mSolvers.size() < numChunks)
+            {
+                mSolvers.resize(numChunks);
+            }
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numSets, offsets, points, areConvexPolygons, boxes, areas,
+                numChunks](size_t chunk)
+                {
+                    Solver& solver = mSolvers[chunk];
+                    size_t const imin = numSets * chunk / numChunks;
+                    size_t const imax = numSets * (chunk + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        int32_t const numPoints = offsets[i + 1] - offsets[i];
+                        Vector2<InputType> const* setPoints = points + offsets[i];
+                        if (areConvexPolygons)
+                        {
+                            boxes[i] = solver(numPoints, setPoints, 0, nullptr);
+                        }
+                        else
+                        {
+                            boxes[i] = solver(numPoints, setPoints);
+                        }
+
+                        if (areas)
+                        {
+                            areas[i] = solver.GetArea();
+                        }
+                    }
+                });
+        }
+
+    private:
+        std::vector<Solver> mSolvers;
+    };
+}
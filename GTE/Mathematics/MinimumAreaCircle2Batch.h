@@ -0,0 +1,262 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/BSPrecisionPredicates.h>
+#include <Mathematics/FilteredPrimalQuery2.h>
+#include <Mathematics/Hypersphere.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// Compute the minimum-area circles of many data sets, typically small
+// polygons. The data sets are stored contiguously: data set i has the
+// points[offsets[i]] through points[offsets[i+1]-1], so the offsets array
+// has numSets+1 elements. The data sets are partitioned into chunks that are
+// processed by the threads of a scheduler when it is not null. Each chunk
+// has its own random number generator, permuted copy of the points and
+// query object, which are class members of the batch object, so their
+// storage is reused for all the data sets of the chunk and for later calls.
+//
+// The algorithm is the randomized incremental construction of Welzl's
+// algorithm with the loops
+//   for i: if P[i] not in C, C = circle(P[i]) and
+//     for j < i: if P[j] not in C, C = circle(P[i],P[j]) and
+//       for k < j: if P[k] not in C, C = circle(P[i],P[j],P[k])
+// which has expected O(n) time for a random permutation of the n points.
+// Unlike MinimumAreaCircle2, the circles are not computed during the
+// iteration. A circle is represented by its 1, 2 or 3 support points, and
+// the containment tests are the sign tests of FilteredPrimalQuery2, which
+// are decided in double precision for nearly all points and otherwise by
+// BSNumber<UIntegerFP32<N>> arithmetic with the minimal N. The containment
+// tests are therefore exact without dynamic allocations for 'float' and
+// 'double' inputs, and no rational arithmetic with divisions is needed.
+// Only the final circle is constructed, using exact BSNumber arithmetic for
+// the homogeneous form of the center and squared radius, and converted to
+// InputType; see BSPrecisionPredicates::Circumcircle2. As in
+// MinimumAreaCircle2, the only rounding errors are those of the conversions
+// and of the square root of the squared radius.
+
+namespace gte
+{
+    template <typename InputType>
+    class MinimumAreaCircle2Batch
+    {
+    public:
+        using PredicateNumber = BSPrecisionPredicates::ToCircumcircleNumber<InputType>;
+        using ConstructionNumber = BSPrecisionPredicates::Circumcircle2Number<InputType>;
+        using ConstructionRational = BSRational<UIntegerFP32<BSPrecisionPredicates::Circumcircle2<InputType>()>>;
+
+        MinimumAreaCircle2Batch()
+        {
+            static_assert(std::is_floating_point<InputType>::value,
+                "The input type must be 'float' or 'double'.");
+        }
+
+        // The array 'circles' must have numSets elements. The array
+        // 'supports' is optional; when not null, it must have numSets
+        // elements. The number of support points of circle i is
+        // supports[i].first, which is 1, 2 or 3, and their indices relative
+        // to points[offsets[i]] are the first elements of supports[i].second.
+        // Each data set must have at least one point.
+        void operator()(size_t numSets, int32_t const* offsets,
+            Vector2<InputType> const* points, Circle2<InputType>* circles,
+            std::pair<int32_t, std::array<int32_t, 3>>* supports = nullptr,
+            TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(offsets != nullptr && points != nullptr && circles != nullptr,
+                "Invalid input.");
+
+            size_t const numChunks = (scheduler ?
+                std::max(std::min(numSets, 4 * scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+            if (mWorkers.size() < numChunks)
+            {
+                mWorkers.resize(numChunks);
+            }
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numSets, offsets, points, circles, supports, numChunks](size_t chunk)
+                {
+                    Worker& worker = mWorkers[chunk];
+                    size_t const imin = numSets * chunk / numChunks;
+                    size_t const imax = numSets * (chunk + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        int32_t const numPoints = offsets[i + 1] - offsets[i];
+                        LogAssert(numPoints >= 1, "Each data set must contain points.");
+                        Compute(worker, numPoints, points + offsets[i], circles[i],
+                            (supports ? &supports[i] : nullptr));
+                    }
+                });
+        }
+
+    private:
+        struct Worker
+        {
+            std::default_random_engine dre;
+            std::vector<int32_t> permuted;
+            std::vector<Vector2<InputType>> points;
+            FilteredPrimalQuery2<InputType, PredicateNumber> query;
+        };
+
+        // The support points are indices into worker.points. For three
+        // support points, the triangle <support[0],support[1],support[2]>
+        // is counterclockwise.
+        static bool Contains(Worker const& worker, int32_t i, int32_t numSupport,
+            std::array<int32_t, 3> const& support)
+        {
+            if (numSupport == 1)
+            {
+                return worker.points[i] == worker.points[support[0]];
+            }
+            else if (numSupport == 2)
+            {
+                return worker.query.ToDiametralCircle(i, support[0], support[1]) <= 0;
+            }
+            else
+            {
+                return worker.query.ToCircumcircle(i, support[0], support[1], support[2]) <= 0;
+            }
+        }
+
+        void Compute(Worker& worker, int32_t numPoints, Vector2<InputType> const* points,
+            Circle2<InputType>& circle, std::pair<int32_t, std::array<int32_t, 3>>* supportOutput)
+        {
+            // Create a random permutation of the points.
+            worker.permuted.resize(numPoints);
+            for (int32_t i = 0; i < numPoints; ++i)
+            {
+                worker.permuted[i] = i;
+            }
+            std::shuffle(worker.permuted.begin(), worker.permuted.end(), worker.dre);
+            worker.points.resize(numPoints);
+            for (int32_t i = 0; i < numPoints; ++i)
+            {
+                worker.points[i] = points[worker.permuted[i]];
+            }
+            worker.query.Set(numPoints, worker.points.data());
+
+            int32_t numSupport = 1;
+            std::array<int32_t, 3> support = { 0, 0, 0 };
+            for (int32_t i = 1; i < numPoints; ++i)
+            {
+                if (Contains(worker, i, numSupport, support))
+                {
+                    continue;
+                }
+
+                numSupport = 1;
+                support[0] = i;
+                for (int32_t j = 0; j < i; ++j)
+                {
+                    if (Contains(worker, j, numSupport, support))
+                    {
+                        continue;
+                    }
+
+                    numSupport = 2;
+                    support[0] = i;
+                    support[1] = j;
+                    for (int32_t k = 0; k < j; ++k)
+                    {
+                        if (Contains(worker, k, numSupport, support))
+                        {
+                            continue;
+                        }
+
+                        // P[k] is outside the circle whose boundary contains
+                        // P[i] and P[j], so the theory guarantees that P[k]
+                        // is not on the line through P[i] and P[j].
+                        int32_t const sign = worker.query.ToLine(k, i, j);
+                        LogAssert(sign != 0, "Unexpected collinear support points.");
+                        numSupport = 3;
+                        support[0] = (sign < 0 ? i : j);
+                        support[1] = (sign < 0 ? j : i);
+                        support[2] = k;
+                    }
+                }
+            }
+
+            ConstructCircle(worker, numSupport, support, circle);
+
+            if (supportOutput)
+            {
+                supportOutput->first = numSupport;
+                supportOutput->second = { 0, 0, 0 };
+                for (int32_t i = 0; i < numSupport; ++i)
+                {
+                    supportOutput->second[i] = worker.permuted[support[i]];
+                }
+            }
+        }
+
+        static void ConstructCircle(Worker const& worker, int32_t numSupport,
+            std::array<int32_t, 3> const& support, Circle2<InputType>& circle)
+        {
+            std::array<Vector2<ConstructionNumber>, 3> P;
+            for (int32_t i = 0; i < numSupport; ++i)
+            {
+                for (int32_t j = 0; j < 2; ++j)
+                {
+                    P[i][j] = worker.points[support[i]][j];
+                }
+            }
+
+            if (numSupport == 1)
+            {
+                circle.center = worker.points[support[0]];
+                circle.radius = (InputType)0;
+            }
+            else if (numSupport == 2)
+            {
+                // C = (P0 + P1)/2 and r^2 = |P1 - P0|^2/4, where the
+                // multiplications by powers of 2 are exact.
+                ConstructionNumber const half(0.5), quarter(0.25);
+                Vector2<ConstructionNumber> diff = P[1] - P[0];
+                for (int32_t j = 0; j < 2; ++j)
+                {
+                    circle.center[j] = (InputType)(half * (P[0][j] + P[1][j]));
+                }
+                circle.radius = std::sqrt((InputType)(quarter * Dot(diff, diff)));
+            }
+            else
+            {
+                // C = P2 + N/D and r^2 = |N|^2/D^2, where D = 2*det and
+                // (N,D) is the solution of 2*Dot(Ei,C-P2) = |Ei|^2 by
+                // Cramer's rule.
+                Vector2<ConstructionNumber> E0 = P[0] - P[2];
+                Vector2<ConstructionNumber> E1 = P[1] - P[2];
+                ConstructionNumber sqrLen0 = Dot(E0, E0);
+                ConstructionNumber sqrLen1 = Dot(E1, E1);
+                ConstructionNumber det = DotPerp(E0, E1);
+                ConstructionNumber D = det + det;
+                Vector2<ConstructionNumber> N
+                {
+                    sqrLen0 * E1[1] - sqrLen1 * E0[1],
+                    sqrLen1 * E0[0] - sqrLen0 * E1[0]
+                };
+                for (int32_t j = 0; j < 2; ++j)
+                {
+                    ConstructionRational cj(P[2][j] * D + N[j], D);
+                    circle.center[j] = (InputType)cj;
+                }
+                ConstructionRational sqrRadius(Dot(N, N), D * D);
+                circle.radius = std::sqrt((InputType)sqrRadius);
+            }
+        }
+
+        std::vector<Worker> mWorkers;
+    };
+}
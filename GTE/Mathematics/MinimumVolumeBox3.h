@@ -3,12 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.9.2021.04.22
+// Version: 4.9.2026.10.15
 
 #pragma once
 #include <Mathematics/Logger.h>
 #include <Mathematics/ConvexHull3.h>
 #include <Mathematics/MinimumAreaBox2.h>
+#include <Mathematics/Profiler.h>
 #include <Mathematics/VETManifoldMesh.h>
 #include <Mathematics/AlignedBox.h>
 #include <Mathematics/UniqueVerticesSimplices.h>
@@ -153,10 +154,14 @@ namespace gte
     public:
         // Construction and destruction. To execute in the main thread, set
         // numThreads to 0. To run multithreaded on the CPU, set numThreads
-        // to a positive number.
+        // to a positive number. The edge pairs are then partitioned into
+        // numThreads subsets that are processed by std::thread objects
+        // created for each call unless a scheduler is specified by
+        // SetScheduler(*).
         MinimumVolumeBox3(size_t numThreads = 0)
             :
             mNumThreads(numThreads),
+            mScheduler(nullptr),
             mDomainIndex{},
             mZero(static_cast<ComputeType>(0)),
             mOne(static_cast<ComputeType>(1)),
@@ -188,6 +193,20 @@ namespace gte
         MinimumVolumeBox3(MinimumVolumeBox3 const&) = delete;
         MinimumVolumeBox3& operator=(MinimumVolumeBox3 const&) = delete;
 
+        // Process the subsets of edge pairs as tasks of the scheduler, which
+        // can be shared with other computations, instead of creating threads
+        // for each call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // The convex hull of the input points is computed. The output
         // box is determined by the dimension of the hull.
         //   0D: The hull is a single point. The box has center at that
@@ -219,6 +238,8 @@ namespace gte
             LogAssert(numPoints > 0 && points != nullptr && lgMaxSample >= 2,
                 "Invalid argument.");
 
+            GTE_PROFILE_ZONE("MinimumVolumeBox3");
+
             InputType const zero = static_cast<InputType>(0);
             InputType const one = static_cast<InputType>(1);
             InputType const half = static_cast<InputType>(0.5);
@@ -336,7 +357,7 @@ namespace gte
         // computational costs are excessive. You can override the minimizer
         // functions to use your own minimization algorithm; see the comments
         // before MinimizerConstantT.
-        void operator()(
+        virtual void operator()(
             int numVertices,
             Vector3<InputType> const* inVertices,
             int numIndices,
@@ -363,11 +384,19 @@ namespace gte
                 std::memcpy(indices.data(), inIndices,
                     indices.size() * sizeof(int));
 
-                GenerateSubdivision(lgMaxSample);
-                CreateCompactMesh(vertices, indices);
-                PrepareVerticesAndNormals(vertices);
-                ComputeAlignedCandidate();
-                GetMinimumVolumeCandidate();
+                GTE_PROFILE_ZONE("MinimumVolumeBox3::Polyhedron");
+                {
+                    GTE_PROFILE_ZONE("MinimumVolumeBox3::Prepare");
+                    GenerateSubdivision(lgMaxSample);
+                    CreateCompactMesh(vertices, indices);
+                    CreateEdgePairs();
+                    PrepareVerticesAndNormals(vertices);
+                    ComputeAlignedCandidate();
+                }
+                {
+                    GTE_PROFILE_ZONE("MinimumVolumeBox3::GetMinimumVolumeCandidate");
+                    GetMinimumVolumeCandidate();
+                }
                 GetMinimumVolumeBox(box, volume);
         }
 
@@ -525,9 +554,14 @@ namespace gte
                 }
                 ++index;
             }
+        }
 
+        // The edge pairs are processed by GetMinimumVolumeCandidate().
+        void CreateEdgePairs()
+        {
             size_t const numEdges = mEdges.size();
-            mEdgeIndices.reserve(mEdges.size() * mEdges.size());
+            mEdgeIndices.clear();
+            mEdgeIndices.reserve(numEdges * numEdges);
             for (size_t e0 = 0; e0 < numEdges; ++e0)
             {
                 for (size_t e1 = e0 + 1; e1 < numEdges; ++e1)
@@ -631,7 +665,10 @@ namespace gte
             return vMax;
         }
 
-        void ComputeVolume(Candidate& candidate)
+        // A derived class can override this to compute a different measure
+        // of the candidate, which is stored in candidate.volume and is
+        // minimized over the candidates.
+        virtual void ComputeVolume(Candidate& candidate)
         {
             // The last axis is needed only when computing the volume for
             // comparison to the current candidate volume, so compute this
@@ -717,23 +754,18 @@ namespace gte
                 imax.back() = mEdgeIndices.size();
 
                 std::vector<Candidate> candidates(mNumThreads);
-                std::vector<std::thread> process(mNumThreads);
-                for (size_t t = 0; t < mNumThreads; ++t)
-                {
-                    process[t] = std::thread(
-                        [this, t, &imin, &imax, &candidates]()
+                TaskScheduler::ParallelFor(mScheduler, mNumThreads,
+                    [this, &imin, &imax, &candidates](size_t t)
+                    {
+                        candidates[t] = mAlignedCandidate;
+                        for (size_t i = imin[t]; i < imax[t]; ++i)
                         {
-                            candidates[t] = mAlignedCandidate;
-                            for (size_t i = imin[t]; i < imax[t]; ++i)
-                            {
-                                ProcessEdgePair(mEdgeIndices[i], candidates[t]);
-                            }
-                        });
-                }
+                            ProcessEdgePair(mEdgeIndices[i], candidates[t]);
+                        }
+                    });
 
                 for (size_t t = 0; t < mNumThreads; ++t)
                 {
-                    process[t].join();
                     if (candidates[t].volume < mMinimumVolumeObject.volume)
                     {
                         mMinimumVolumeObject = candidates[t];
@@ -799,8 +831,10 @@ namespace gte
         }
 
         // The number of threads to use for computing. If 0, the main thread
-        // is used. If positive, std::thread objects are used.
+        // is used. If positive, the threads of mScheduler are used when it
+        // is not null; otherwise, std::thread objects are used.
         size_t mNumThreads;
+        TaskScheduler* mScheduler;
 
         // The maximum sample index used to search each level curve for
         // non-face-supporting boxes (mMaxSample + 1 values). The samples are
@@ -0,0 +1,433 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.9.2026.10.14
+
+#pragma once
+
+#include <Mathematics/MinimumVolumeBox3.h>
+#include <Mathematics/ArbitraryPrecision.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// A filtered version of MinimumVolumeBox3<InputType, false>. The candidate
+// boxes are those of MinimumVolumeBox3<InputType, true>: the edge pairs and
+// the samples of the level curves are processed in double, so the box axes
+// are double-precision vectors. For each candidate, with axes a0 and a1,
+// define the exact box whose axes are u0 = a0, u1 = |a0|^2*a1 - Dot(a0,a1)*a0
+// and u2 = Cross(u0,u1), which are computed exactly. The candidates are
+// evaluated in double to obtain a lower bound L on the volume of the exact
+// box; the bound accounts for the rounding errors of the axes and of the
+// dot products using first-order error bounds with conservative constants.
+// The extreme vertices found by the double-precision search need not be the
+// exact extremes, but every vertex provides a lower bound on the extent.
+//
+// The edge pairs are partitioned into chunks of consecutive first edges,
+// which are processed by the threads of a TaskScheduler or by std::thread
+// objects. Each chunk keeps the edge pairs whose candidates have the
+// smallest lower bounds. These candidates are then verified in order of
+// increasing lower bound with arbitrary-precision arithmetic, evaluating
+// the exact volume of the candidate box, until the lower bound is not
+// smaller than the smallest exact volume. The axis-aligned box is always
+// verified. The output box is the candidate of smallest exact volume among
+// those verified. GetVolumeLowerBound() returns a rigorous lower bound on
+// the volumes of all candidates, so the output is the minimum-volume
+// candidate when the lower bound equals the exact volume, and otherwise
+// its volume exceeds the minimum by at most the difference, which is
+// typically a rounding error when several edge pairs produce the same box.
+//
+// The exact computations use BSNumber<UIntegerAP32> and only visit the
+// vertices of the hill-climbing searches for the verified candidates, so
+// the memory and time costs of the fixed-precision types of
+// MinimumVolumeBox3<InputType, false> are avoided.
+
+namespace gte
+{
+    template <typename InputType>
+    class MinimumVolumeBox3Filtered : public MinimumVolumeBox3<InputType, true>
+    {
+    public:
+        using Base = MinimumVolumeBox3<InputType, true>;
+        using Candidate = typename Base::Candidate;
+        using Edge = typename Base::Edge;
+        using Number = BSNumber<UIntegerAP32>;
+        using Rational = BSRational<UIntegerAP32>;
+        using Base::operator();
+
+        // The numThreads parameter is that of MinimumVolumeBox3. Each chunk
+        // of edge pairs keeps the numCandidates edge pairs of smallest lower
+        // bound for exact verification.
+        MinimumVolumeBox3Filtered(size_t numThreads = 0, size_t numCandidates = 16)
+            :
+            Base(numThreads),
+            mNumCandidates(std::max(numCandidates, static_cast<size_t>(1))),
+            mMaxLength(0.0),
+            mExactVolume(0),
+            mVolumeLowerBound(0.0),
+            mNumVerified(0)
+        {
+        }
+
+        virtual ~MinimumVolumeBox3Filtered() = default;
+
+        // The inputs are those of MinimumVolumeBox3::operator()(*) for a
+        // convex polyhedron. The output volume is the exact volume of the
+        // output box rounded to InputType.
+        virtual void operator()(
+            int numVertices,
+            Vector3<InputType> const* inVertices,
+            int numIndices,
+            int const* inIndices,
+            size_t lgMaxSample,
+            OrientedBox3<InputType>& box,
+            InputType& volume) override
+        {
+            LogAssert(
+                numVertices > 0 && inVertices != nullptr &&
+                numIndices > 0 && inIndices != nullptr &&
+                (numIndices % 3) == 0 && lgMaxSample >= 2,
+                "Invalid argument.");
+            for (int i = 0; i < numIndices; ++i)
+            {
+                LogAssert(0 <= inIndices[i] && inIndices[i] < numVertices,
+                    "Invalid index.");
+            }
+
+            mInputVertices.assign(inVertices, inVertices + numVertices);
+            std::vector<int> indices(inIndices, inIndices + numIndices);
+
+            this->GenerateSubdivision(lgMaxSample);
+            this->CreateCompactMesh(mInputVertices, indices);
+            this->PrepareVerticesAndNormals(mInputVertices);
+            this->ComputeAlignedCandidate();
+
+            mMaxLength = 0.0;
+            for (auto const& vertex : this->mVertices)
+            {
+                mMaxLength = std::max(mMaxLength, Length(vertex));
+            }
+            mMaxLength *= 1.0 + 4.0 * std::numeric_limits<double>::epsilon();
+
+            std::vector<Candidate> candidates;
+            double threshold = std::numeric_limits<double>::max();
+            SelectCandidates(candidates, threshold);
+            VerifyCandidates(candidates, threshold);
+            GetBox(box, volume);
+        }
+
+        // The exact volume of the output box.
+        inline Rational const& GetExactVolume() const
+        {
+            return mExactVolume;
+        }
+
+        // A lower bound on the exact volumes of all candidate boxes.
+        inline double GetVolumeLowerBound() const
+        {
+            return mVolumeLowerBound;
+        }
+
+        // The number of candidates whose exact volumes were computed.
+        inline size_t GetNumVerified() const
+        {
+            return mNumVerified;
+        }
+
+    protected:
+        // The lower bound on the volume of the exact box of the candidate.
+        // The axes are normalized in double. The error of the normalized
+        // direction relative to the exact unit-length direction is bounded
+        // by eta[i], and a dot product of a normalized axis with a vertex
+        // has rounding error at most rho.
+        virtual void ComputeVolume(Candidate& candidate) override
+        {
+            double const epsilon = std::numeric_limits<double>::epsilon();
+            Vector3<double> const& a0 = candidate.axis[0];
+            Vector3<double> const& a1 = candidate.axis[1];
+            std::array<Vector3<double>, 3> axis;
+            std::array<double, 3> eta;
+
+            axis[0] = a0;
+            Normalize(axis[0]);
+            eta[0] = 4.0 * epsilon;
+
+            axis[1] = a1 - (Dot(a0, a1) / Dot(a0, a0)) * a0;
+            double length1 = Normalize(axis[1]);
+            if (length1 == 0.0)
+            {
+                candidate.volume = std::numeric_limits<double>::max();
+                return;
+            }
+            eta[1] = 16.0 * epsilon * Length(a1) / length1 + 4.0 * epsilon;
+
+            axis[2] = Cross(axis[0], axis[1]);
+            Normalize(axis[2]);
+            eta[2] = 2.0 * (eta[0] + eta[1]) + 8.0 * epsilon;
+            candidate.axis[2] = axis[2];
+
+            double const rho = 4.0 * epsilon * mMaxLength;
+            double bound = 1.0;
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                double dmin, dmax;
+                if (i < 2)
+                {
+                    candidate.minSupportIndex[i] = this->mEdges[candidate.edgeIndex[i]].V[0];
+                    dmin = Dot(axis[i], this->mVertices[candidate.minSupportIndex[i]]);
+                }
+                else
+                {
+                    candidate.minSupportIndex[i] = this->GetExtreme(-axis[i], dmin);
+                    dmin = -dmin;
+                }
+                candidate.maxSupportIndex[i] = this->GetExtreme(axis[i], dmax);
+                double extent = dmax - dmin - 2.0 * (rho + eta[i] * mMaxLength);
+                bound *= std::max(extent, 0.0);
+            }
+            candidate.volume = bound * (1.0 - 8.0 * epsilon);
+        }
+
+        // A max-heap of the candidates of smallest lower bound of a chunk.
+        struct Selection
+        {
+            static bool Less(Candidate const& c0, Candidate const& c1)
+            {
+                return c0.volume < c1.volume;
+            }
+
+            void Push(Candidate const& candidate, size_t maxSize)
+            {
+                if (heap.size() < maxSize)
+                {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end(), Less);
+                }
+                else if (candidate.volume < heap.front().volume)
+                {
+                    std::pop_heap(heap.begin(), heap.end(), Less);
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end(), Less);
+                }
+            }
+
+            std::vector<Candidate> heap;
+        };
+
+        // Process the edge pairs (e0,e1), e0 < e1, in chunks of consecutive
+        // e0 with approximately equal numbers of pairs. The threshold is the
+        // smallest lower bound of the candidates that were discarded.
+        void SelectCandidates(std::vector<Candidate>& candidates, double& threshold)
+        {
+            size_t const numEdges = this->mEdges.size();
+            size_t numChunks = std::max(this->mNumThreads, static_cast<size_t>(1));
+            if (this->mScheduler)
+            {
+                numChunks = std::max(numChunks, 4 * this->mScheduler->GetNumThreads());
+            }
+
+            std::vector<size_t> first(numChunks + 1, numEdges);
+            first[0] = 0;
+            double const numPairs = 0.5 * static_cast<double>(numEdges) *
+                static_cast<double>(numEdges > 0 ? numEdges - 1 : 0);
+            double accumulated = 0.0;
+            for (size_t e0 = 0, c = 1; e0 < numEdges && c < numChunks; ++e0)
+            {
+                accumulated += static_cast<double>(numEdges - 1 - e0);
+                if (accumulated >= numPairs * static_cast<double>(c) / static_cast<double>(numChunks))
+                {
+                    first[c++] = e0 + 1;
+                }
+            }
+
+            std::vector<Selection> selections(numChunks);
+            TaskScheduler::ParallelFor(this->mScheduler, numChunks,
+                [this, numEdges, &first, &selections](size_t c)
+                {
+                    Candidate best;
+                    for (size_t e0 = first[c]; e0 < first[c + 1]; ++e0)
+                    {
+                        for (size_t e1 = e0 + 1; e1 < numEdges; ++e1)
+                        {
+                            best = this->mAlignedCandidate;
+                            best.volume = std::numeric_limits<double>::max();
+                            this->ProcessEdgePair({ e0, e1 }, best);
+                            if (best.volume < std::numeric_limits<double>::max())
+                            {
+                                selections[c].Push(best, mNumCandidates);
+                            }
+                        }
+                    }
+                });
+
+            candidates.clear();
+            threshold = std::numeric_limits<double>::max();
+            for (auto const& selection : selections)
+            {
+                candidates.insert(candidates.end(), selection.heap.begin(), selection.heap.end());
+                if (selection.heap.size() == mNumCandidates)
+                {
+                    threshold = std::min(threshold, selection.heap.front().volume);
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), Selection::Less);
+        }
+
+        void VerifyCandidates(std::vector<Candidate> const& candidates, double threshold)
+        {
+            // The aligned box is exact.
+            mBest = this->mAlignedCandidate;
+            mBest.edgeIndex = { Base::invalidIndex, Base::invalidIndex };
+            mExactVolume = ComputeExactVolume(mBest, mBestAxis);
+            mNumVerified = 1;
+
+            // The rounding of the exact volume is compensated so that the
+            // comparisons with the lower bounds are conservative.
+            double const factor = 1.0 - std::numeric_limits<double>::epsilon();
+            double bestVolume = factor * static_cast<double>(mExactVolume);
+
+            std::array<Vector3<Number>, 3> axis;
+            for (auto const& candidate : candidates)
+            {
+                if (candidate.volume >= bestVolume)
+                {
+                    break;
+                }
+
+                Candidate verified = candidate;
+                Rational exactVolume = ComputeExactVolume(verified, axis);
+                ++mNumVerified;
+                if (exactVolume < mExactVolume)
+                {
+                    mExactVolume = exactVolume;
+                    mBest = verified;
+                    mBestAxis = axis;
+                    bestVolume = factor * static_cast<double>(mExactVolume);
+                }
+            }
+            mVolumeLowerBound = std::min(bestVolume, threshold);
+        }
+
+        Vector3<Number> GetExactVertex(size_t v) const
+        {
+            Vector3<Number> vertex;
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                vertex[j] = Number(mInputVertices[v][j]) - Number(mInputVertices[0][j]);
+            }
+            return vertex;
+        }
+
+        // Hill climbing on the vertex adjacency graph with exact arithmetic,
+        // starting at the vertex found in double.
+        size_t GetExactExtreme(Vector3<Number> const& direction, size_t vMax, Number& dMax) const
+        {
+            dMax = Dot(direction, GetExactVertex(vMax));
+            for (size_t i = 0; i < this->mNumVertices; ++i)
+            {
+                size_t vLocalMax = vMax;
+                Number dLocalMax = dMax;
+                size_t const* adjacent = &this->mAdjacentPool[this->mVertexAdjacent[vMax]];
+                size_t numAdjacent = *adjacent++;
+                for (size_t j = 1; j <= numAdjacent; ++j)
+                {
+                    size_t vCandidate = *adjacent++;
+                    Number dCandidate = Dot(direction, GetExactVertex(vCandidate));
+                    if (dCandidate > dLocalMax)
+                    {
+                        vLocalMax = vCandidate;
+                        dLocalMax = dCandidate;
+                    }
+                }
+                if (vMax != vLocalMax)
+                {
+                    vMax = vLocalMax;
+                    dMax = dLocalMax;
+                }
+                else
+                {
+                    break;
+                }
+            }
+            return vMax;
+        }
+
+        // The exact box of the candidate. The support indices are replaced
+        // by the exact extremes.
+        Rational ComputeExactVolume(Candidate& candidate, std::array<Vector3<Number>, 3>& axis) const
+        {
+            Vector3<Number> a0, a1;
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                a0[j] = Number(candidate.axis[0][j]);
+                a1[j] = Number(candidate.axis[1][j]);
+            }
+            axis[0] = a0;
+            axis[1] = Dot(a0, a0) * a1 - Dot(a0, a1) * a0;
+            axis[2] = Cross(axis[0], axis[1]);
+
+            std::array<Number, 3> difference;
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                Number dmin, dmax;
+                candidate.maxSupportIndex[i] = GetExactExtreme(axis[i],
+                    candidate.maxSupportIndex[i], dmax);
+                candidate.minSupportIndex[i] = GetExactExtreme(-axis[i],
+                    candidate.minSupportIndex[i], dmin);
+                difference[i] = dmax + dmin;
+            }
+
+            return Rational(difference[0] * difference[1] * difference[2]) /
+                Rational(Dot(axis[2], axis[2]));
+        }
+
+        void GetBox(OrientedBox3<InputType>& box, InputType& volume) const
+        {
+            Vector3<Rational> center;
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                center[j] = Rational(mInputVertices[0][j]);
+            }
+
+            Rational const half(0.5);
+            for (int32_t i = 0; i < 3; ++i)
+            {
+                Number pmin = Dot(mBestAxis[i], GetExactVertex(mBest.minSupportIndex[i]));
+                Number pmax = Dot(mBestAxis[i], GetExactVertex(mBest.maxSupportIndex[i]));
+                Number sqrLength = Dot(mBestAxis[i], mBestAxis[i]);
+                Rational average = half * Rational(pmin + pmax) / Rational(sqrLength);
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    center[j] += average * Rational(mBestAxis[i][j]);
+                }
+
+                double length = std::sqrt(static_cast<double>(sqrLength));
+                for (int32_t j = 0; j < 3; ++j)
+                {
+                    box.axis[i][j] = static_cast<InputType>(static_cast<double>(mBestAxis[i][j]) / length);
+                }
+                box.extent[i] = static_cast<InputType>(
+                    static_cast<double>(half * Rational(pmax - pmin)) / length);
+            }
+
+            for (int32_t j = 0; j < 3; ++j)
+            {
+                box.center[j] = static_cast<InputType>(center[j]);
+            }
+            volume = static_cast<InputType>(mExactVolume);
+        }
+
+        size_t mNumCandidates;
+        std::vector<Vector3<InputType>> mInputVertices;
+        double mMaxLength;
+
+        Candidate mBest;
+        std::array<Vector3<Number>, 3> mBestAxis;
+        Rational mExactVolume;
+        double mVolumeLowerBound;
+        size_t mNumVerified;
+    };
+}
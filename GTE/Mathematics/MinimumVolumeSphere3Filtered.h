@@ -0,0 +1,516 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/BSPrecisionPredicates.h>
+#include <Mathematics/Hypersphere.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// Compute the minimum volume sphere containing the input set of points. The
+// result is the exact minimum-volume sphere, as for MinimumVolumeSphere3
+// with ComputeType BSRational, rounded to InputType. The InputType must be
+// 'float' or 'double'.
+//
+// The algorithm is designed for large point sets. The points are not
+// permuted or converted to exact arithmetic. Instead, the algorithm
+// maintains a small set of candidate points whose minimum-volume sphere is
+// computed exactly, and it grows the set until the sphere contains all the
+// points:
+//   1. A parallel pass computes the extreme points of the input in the 7
+//      directions (1,0,0), (0,1,0), (0,0,1) and (1,+-1,+-1). These points
+//      are the initial candidates.
+//   2. The minimum-volume sphere of the candidates is computed with Welzl's
+//      algorithm using the move-to-front heuristic.
+//   3. A parallel pass finds the points outside the sphere. Each chunk of
+//      points keeps its farthest outside points, and the maxViolators
+//      farthest of all are added to the candidates, in which case the
+//      algorithm repeats step 2. The minimum-volume sphere of a subset has
+//      radius at most that of the entire set, so when no point is outside,
+//      the sphere is that of the entire set by uniqueness.
+// The cost is dominated by the passes over the input, which for typical
+// data are 2 or 3, and by the point-in-sphere tests of the passes. A
+// sphere is represented by its 1 to 4 support points and the homogeneous
+// form of its center and squared radius, which are computed exactly using
+// BSNumber<UIntegerFP32<N>> where the N of
+// BSPrecisionPredicates::MinimumVolumeSphere3 suffices for the worst-case
+// computational path. The exact center and squared radius are rounded to
+// 'double', and the point-in-sphere tests compare the squared distance from
+// the rounded center with thresholds whose a priori error bounds certify
+// the results. Only the points that are nearly on the sphere are tested
+// with exact arithmetic, so the classification of every point is exact.
+// Data sets whose points are all nearly on a sphere, for example unit-length
+// vectors, are the worst case, because most of them require exact tests.
+//
+// Large inputs correspond to scenes processed per frame, so a TaskScheduler
+// can be passed for executing the passes in parallel.
+
+namespace gte
+{
+    template <typename InputType>
+    class MinimumVolumeSphere3Filtered
+    {
+    public:
+        using Number = BSPrecisionPredicates::MinimumVolumeSphere3Number<InputType>;
+        using Rational = BSRational<UIntegerFP32<BSPrecisionPredicates::MinimumVolumeSphere3<InputType>()>>;
+
+        // The maximum number of outside points added to the candidates in
+        // each iteration is maxViolators, which must be positive.
+        MinimumVolumeSphere3Filtered(size_t maxViolators = 64)
+            :
+            mMaxViolators(maxViolators),
+            mNumPoints(0),
+            mPoints(nullptr),
+            mNumSupport(0),
+            mSupport{ 0, 0, 0, 0 },
+            mNumIterations(0)
+        {
+            static_assert(std::is_floating_point<InputType>::value,
+                "The input type must be 'float' or 'double'.");
+            LogAssert(mMaxViolators > 0, "The maximum number of violators must be positive.");
+        }
+
+        // The return value is 'true', because the computations are exact.
+        // It exists for consistency with MinimumVolumeSphere3.
+        bool operator()(int numPoints, Vector3<InputType> const* points,
+            Sphere3<InputType>& minimal, TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(numPoints >= 1 && points != nullptr, "Input must contain points.");
+
+            mNumPoints = numPoints;
+            mPoints = points;
+            mCandidates.clear();
+            mNumIterations = 0;
+
+            size_t const numChunks = (scheduler ?
+                std::max(std::min(static_cast<size_t>(numPoints), 4 * scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+
+            ComputeExtremes(numChunks, scheduler);
+            InitializeList();
+
+            for (;;)
+            {
+                ++mNumIterations;
+                MoveToFront(0, 0);
+                if (!AddViolators(numChunks, scheduler))
+                {
+                    break;
+                }
+            }
+
+            Sphere const& sphere = mSpheres[0];
+            mNumSupport = sphere.numSupport;
+            mSupport = { 0, 0, 0, 0 };
+            for (int i = 0; i < mNumSupport; ++i)
+            {
+                mSupport[i] = mCandidates[sphere.support[i]];
+            }
+
+            for (int j = 0; j < 3; ++j)
+            {
+                minimal.center[j] = static_cast<InputType>(sphere.rCenter[j]);
+            }
+            minimal.radius = std::sqrt(static_cast<InputType>(sphere.rSqrRadius));
+            return true;
+        }
+
+        // Member access. The support indices are those of the input points.
+        inline int GetNumSupport() const
+        {
+            return mNumSupport;
+        }
+
+        inline std::array<int, 4> const& GetSupport() const
+        {
+            return mSupport;
+        }
+
+        // The number of candidate points and of the executions of Welzl's
+        // algorithm for the last call of operator().
+        inline size_t GetNumCandidates() const
+        {
+            return mCandidates.size();
+        }
+
+        inline size_t GetNumIterations() const
+        {
+            return mNumIterations;
+        }
+
+    private:
+        // The support indices are those of mCandidates. The exact sphere has
+        // center A + N/D and squared radius |N|^2/D^2, where A is the first
+        // support point. The filter uses the center rounded to 'double' and
+        // the thresholds tIn and tOut of the squared distance from that
+        // center.
+        struct Sphere
+        {
+            int numSupport;
+            std::array<size_t, 4> support;
+            Vector3<Number> origin, N;
+            Number D;
+            Vector3<Rational> rCenter;
+            Rational rSqrRadius;
+            Vector3<double> center;
+            double tIn, tOut;
+        };
+
+        Vector3<double> GetPoint(size_t i) const
+        {
+            Vector3<InputType> const& P = mPoints[i];
+            return Vector3<double>{ static_cast<double>(P[0]),
+                static_cast<double>(P[1]), static_cast<double>(P[2]) };
+        }
+
+        Vector3<Number> GetExactPoint(size_t i) const
+        {
+            Vector3<InputType> const& P = mPoints[i];
+            return Vector3<Number>{ Number(P[0]), Number(P[1]), Number(P[2]) };
+        }
+
+        // Step 1. The extremes are computed with floating-point arithmetic,
+        // because the candidates are only a starting point.
+        void ComputeExtremes(size_t numChunks, TaskScheduler* scheduler)
+        {
+            size_t const numPoints = static_cast<size_t>(mNumPoints);
+            std::vector<std::array<size_t, 14>> extremes(numChunks);
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numPoints, numChunks, &extremes](size_t chunk)
+                {
+                    size_t const imin = numPoints * chunk / numChunks;
+                    size_t const imax = numPoints * (chunk + 1) / numChunks;
+                    std::array<size_t, 14>& index = extremes[chunk];
+                    std::array<double, 14> value;
+                    index.fill(imin);
+                    value.fill(-std::numeric_limits<double>::infinity());
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        Vector3<double> P = GetPoint(i);
+                        std::array<double, 7> const dot =
+                        {
+                            P[0], P[1], P[2],
+                            P[0] + P[1] + P[2],
+                            P[0] + P[1] - P[2],
+                            P[0] - P[1] + P[2],
+                            P[0] - P[1] - P[2]
+                        };
+                        for (size_t k = 0; k < 7; ++k)
+                        {
+                            if (dot[k] > value[2 * k])
+                            {
+                                value[2 * k] = dot[k];
+                                index[2 * k] = i;
+                            }
+                            if (-dot[k] > value[2 * k + 1])
+                            {
+                                value[2 * k + 1] = -dot[k];
+                                index[2 * k + 1] = i;
+                            }
+                        }
+                    }
+                });
+
+            // The extremes of the chunks are all candidates, which avoids
+            // recomputing the dot products for the reduction. Duplicate
+            // indices are removed.
+            for (auto const& index : extremes)
+            {
+                mCandidates.insert(mCandidates.end(), index.begin(), index.end());
+            }
+            std::sort(mCandidates.begin(), mCandidates.end());
+            mCandidates.erase(std::unique(mCandidates.begin(), mCandidates.end()),
+                mCandidates.end());
+        }
+
+        // The move-to-front list of candidates is a doubly linked list whose
+        // sentinel is node 0. Candidate c is node c+1.
+        void InitializeList()
+        {
+            size_t const numNodes = mCandidates.size() + 1;
+            mNext.resize(numNodes);
+            mPrev.resize(numNodes);
+            for (size_t i = 0; i < numNodes; ++i)
+            {
+                mNext[i] = (i + 1) % numNodes;
+                mPrev[i] = (i + numNodes - 1) % numNodes;
+            }
+        }
+
+        void PushFront(size_t node)
+        {
+            mNext[node] = mNext[0];
+            mPrev[node] = 0;
+            mPrev[mNext[0]] = node;
+            mNext[0] = node;
+        }
+
+        void MoveNodeToFront(size_t node)
+        {
+            mNext[mPrev[node]] = mNext[node];
+            mPrev[mNext[node]] = mPrev[node];
+            PushFront(node);
+        }
+
+        // Step 2. Welzl's algorithm with the move-to-front heuristic for the
+        // candidates that precede node 'end' in the list (all candidates
+        // when 'end' is the sentinel), where the
+        // support points mSpheres[numSupport].support[0..numSupport-1] are
+        // on the boundary of the sphere. On return, mSpheres[0] is the
+        // minimum-volume sphere of the candidates. The recursion depth is at
+        // most 4.
+        void MoveToFront(int numSupport, size_t end)
+        {
+            Sphere& sphere = mSpheres[0];
+            if (numSupport > 0)
+            {
+                sphere.support = mSpheres[numSupport].support;
+                Construct(numSupport, sphere);
+            }
+            else
+            {
+                // Start with the first candidate.
+                sphere.support[0] = mNext[0] - 1;
+                Construct(1, sphere);
+            }
+
+            if (numSupport == 4)
+            {
+                return;
+            }
+
+            for (size_t node = mNext[0]; node != end;)
+            {
+                size_t const next = mNext[node];
+                size_t const c = node - 1;
+                if (!Contains(mSpheres[0], mCandidates[c]))
+                {
+                    auto& support = mSpheres[numSupport + 1].support;
+                    for (int k = 0; k < numSupport; ++k)
+                    {
+                        support[k] = mSpheres[numSupport].support[k];
+                    }
+                    support[numSupport] = c;
+                    MoveToFront(numSupport + 1, node);
+                    MoveNodeToFront(node);
+                }
+                node = next;
+            }
+        }
+
+        // Compute the exact sphere and its filter for the support points
+        // sphere.support[0..numSupport-1], which are on the boundary of the
+        // smallest sphere containing them.
+        void Construct(int numSupport, Sphere& sphere) const
+        {
+            sphere.numSupport = numSupport;
+            sphere.origin = GetExactPoint(mCandidates[sphere.support[0]]);
+            if (numSupport == 1)
+            {
+                sphere.D = Number(1);
+                sphere.N = { Number(0), Number(0), Number(0) };
+            }
+            else if (numSupport == 2)
+            {
+                sphere.D = Number(2);
+                sphere.N = GetExactPoint(mCandidates[sphere.support[1]]) - sphere.origin;
+            }
+            else if (numSupport == 3)
+            {
+                Vector3<Number> U = GetExactPoint(mCandidates[sphere.support[1]]) - sphere.origin;
+                Vector3<Number> V = GetExactPoint(mCandidates[sphere.support[2]]) - sphere.origin;
+                Vector3<Number> W = Cross(U, V);
+                Number sqrLenW = Dot(W, W);
+                LogAssert(sqrLenW.GetSign() != 0, "Unexpected collinear support points.");
+                sphere.D = sqrLenW + sqrLenW;
+                sphere.N = Dot(U, U) * Cross(V, W) + Dot(V, V) * Cross(W, U);
+            }
+            else
+            {
+                Vector3<Number> U = GetExactPoint(mCandidates[sphere.support[1]]) - sphere.origin;
+                Vector3<Number> V = GetExactPoint(mCandidates[sphere.support[2]]) - sphere.origin;
+                Vector3<Number> W = GetExactPoint(mCandidates[sphere.support[3]]) - sphere.origin;
+                Vector3<Number> crossVW = Cross(V, W);
+                Number det = Dot(U, crossVW);
+                LogAssert(det.GetSign() != 0, "Unexpected coplanar support points.");
+                sphere.D = det + det;
+                sphere.N = Dot(U, U) * crossVW + Dot(V, V) * Cross(W, U) + Dot(W, W) * Cross(U, V);
+            }
+
+            for (int j = 0; j < 3; ++j)
+            {
+                sphere.rCenter[j] = Rational(sphere.origin[j] * sphere.D + sphere.N[j], sphere.D);
+                sphere.center[j] = static_cast<double>(sphere.rCenter[j]);
+            }
+            sphere.rSqrRadius = Rational(Dot(sphere.N, sphere.N), sphere.D * sphere.D);
+            double const sqrRadius = static_cast<double>(sphere.rSqrRadius);
+
+            // The rounding errors of the center and squared radius are at
+            // most u = 2^{-53} relative to the rounded values. The squared
+            // distance s from the rounded center is computed with relative
+            // error at most 6u. The thresholds include factors that bound
+            // the rounding errors of their own computations. A point is
+            // inside the sphere when s <= tIn and outside when s > tOut.
+            // Squared distances that are nearly subnormal or not finite are
+            // not classified by the filter.
+            double const u = std::ldexp(1.0, -53);
+            double const minThreshold = std::ldexp(1.0, -900);
+            double const centerError = 3.0 * u * (std::fabs(sphere.center[0]) +
+                std::fabs(sphere.center[1]) + std::fabs(sphere.center[2])) +
+                std::ldexp(1.0, -1070);
+            double const radius = std::sqrt(sqrRadius);
+            double const rMin = radius * (1.0 - 4.0 * u) - centerError;
+            double const rMax = radius * (1.0 + 4.0 * u) + centerError;
+            sphere.tIn = rMin * rMin * (1.0 - 16.0 * u);
+            sphere.tOut = std::max(rMax * rMax * (1.0 + 16.0 * u), minThreshold);
+            bool const finite = std::isfinite(sphere.center[0]) &&
+                std::isfinite(sphere.center[1]) && std::isfinite(sphere.center[2]) &&
+                std::isfinite(sphere.tIn) && std::isfinite(sphere.tOut);
+            if (!finite || rMin <= 0.0 || sphere.tIn < minThreshold)
+            {
+                sphere.tIn = -1.0;
+            }
+            if (!finite)
+            {
+                sphere.tOut = std::numeric_limits<double>::infinity();
+            }
+        }
+
+        // The squared distance from the rounded center of the sphere.
+        double GetSqrDistance(Sphere const& sphere, size_t i) const
+        {
+            Vector3<double> diff = GetPoint(i) - sphere.center;
+            return Dot(diff, diff);
+        }
+
+        // The sign of D*(D*|Q|^2 - 2*Dot(Q,N)), Q = P - A, is positive if
+        // and only if the point P is outside the sphere.
+        bool ExactContains(Sphere const& sphere, size_t i) const
+        {
+            Vector3<Number> Q = GetExactPoint(i) - sphere.origin;
+            Number dotQN = Dot(Q, sphere.N);
+            Number test = sphere.D * Dot(Q, Q) - (dotQN + dotQN);
+            return test.GetSign() * sphere.D.GetSign() <= 0;
+        }
+
+        bool Contains(Sphere const& sphere, size_t i) const
+        {
+            double const sqrDistance = GetSqrDistance(sphere, i);
+            if (sqrDistance <= sphere.tIn)
+            {
+                return true;
+            }
+            if (sqrDistance > sphere.tOut)
+            {
+                return false;
+            }
+            return ExactContains(sphere, i);
+        }
+
+        // Step 3. The return value is 'true' when outside points were found
+        // and added to the candidates.
+        bool AddViolators(size_t numChunks, TaskScheduler* scheduler)
+        {
+            Sphere const& sphere = mSpheres[0];
+            size_t const numPoints = static_cast<size_t>(mNumPoints);
+            size_t const maxPerChunk = std::max((mMaxViolators + numChunks - 1) / numChunks,
+                static_cast<size_t>(1));
+
+            // Each chunk stores its farthest outside points in a min-heap
+            // ordered by squared distance.
+            std::vector<std::vector<std::pair<double, size_t>>> violators(numChunks);
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, &sphere, numPoints, numChunks, maxPerChunk, &violators](size_t chunk)
+                {
+                    size_t const imin = numPoints * chunk / numChunks;
+                    size_t const imax = numPoints * (chunk + 1) / numChunks;
+                    auto& heap = violators[chunk];
+                    std::greater<std::pair<double, size_t>> const compare{};
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        double const sqrDistance = GetSqrDistance(sphere, i);
+                        if (sqrDistance <= sphere.tIn)
+                        {
+                            continue;
+                        }
+                        if (sqrDistance <= sphere.tOut && ExactContains(sphere, i))
+                        {
+                            continue;
+                        }
+
+                        if (heap.size() < maxPerChunk)
+                        {
+                            heap.push_back(std::make_pair(sqrDistance, i));
+                            std::push_heap(heap.begin(), heap.end(), compare);
+                        }
+                        else if (sqrDistance > heap.front().first)
+                        {
+                            std::pop_heap(heap.begin(), heap.end(), compare);
+                            heap.back() = std::make_pair(sqrDistance, i);
+                            std::push_heap(heap.begin(), heap.end(), compare);
+                        }
+                    }
+                });
+
+            std::vector<std::pair<double, size_t>> all;
+            for (auto const& heap : violators)
+            {
+                all.insert(all.end(), heap.begin(), heap.end());
+            }
+            if (all.empty())
+            {
+                return false;
+            }
+
+            if (all.size() > mMaxViolators)
+            {
+                std::nth_element(all.begin(), all.begin() + mMaxViolators, all.end(),
+                    std::greater<std::pair<double, size_t>>());
+                all.resize(mMaxViolators);
+            }
+
+            // The new candidates are inserted at the front of the list,
+            // where the move-to-front heuristic places the points that are
+            // likely to be support points.
+            for (auto const& violator : all)
+            {
+                mCandidates.push_back(violator.second);
+                mNext.push_back(0);
+                mPrev.push_back(0);
+                PushFront(mCandidates.size());
+            }
+            return true;
+        }
+
+        size_t mMaxViolators;
+        int mNumPoints;
+        Vector3<InputType> const* mPoints;
+        int mNumSupport;
+        std::array<int, 4> mSupport;
+        size_t mNumIterations;
+
+        // The indices of the candidate points and the move-to-front list.
+        std::vector<size_t> mCandidates;
+        std::vector<size_t> mNext, mPrev;
+
+        // mSpheres[0] is the current sphere of Welzl's algorithm and
+        // mSpheres[k].support stores the support points passed to the
+        // recursive call with k support points.
+        std::array<Sphere, 5> mSpheres;
+    };
+}
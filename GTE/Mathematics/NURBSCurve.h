@@ -3,12 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/BasisFunction.h>
 #include <Mathematics/ParametricCurve.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <vector>
 
 namespace gte
 {
@@ -93,6 +96,7 @@ namespace gte
             if (0 <= i && i < GetNumControls())
             {
                 mControls[i] = control;
+                this->InvalidateArcLengthTable();
             }
         }
 
@@ -114,6 +118,7 @@ namespace gte
             if (0 <= i && i < GetNumControls())
             {
                 mWeights[i] = weight;
+                this->InvalidateArcLengthTable();
             }
         }
 
@@ -150,13 +155,16 @@ namespace gte
                 return;
             }
 
-            int imin, imax;
-            mBasisFunction.Evaluate(t, order, imin, imax);
+            // The basis function values are stored per thread, so the
+            // function can be called concurrently.
+            thread_local BasisFunctionValues<Real> values;
+            mBasisFunction.Evaluate(t, order, values);
+            int imin = values.minIndex, imax = values.maxIndex;
 
             // Compute position.
             Vector<N, Real> X;
             Real w;
-            Compute(0, imin, imax, X, w);
+            Compute(values, 0, imin, imax, X, w);
             Real invW = (Real)1 / w;
             jet[0] = invW * X;
 
@@ -165,7 +173,7 @@ namespace gte
                 // Compute first derivative.
                 Vector<N, Real> XDer1;
                 Real wDer1;
-                Compute(1, imin, imax, XDer1, wDer1);
+                Compute(values, 1, imin, imax, XDer1, wDer1);
                 jet[1] = invW * (XDer1 - wDer1 * jet[0]);
 
                 if (order >= 2)
@@ -173,7 +181,7 @@ namespace gte
                     // Compute second derivative.
                     Vector<N, Real> XDer2;
                     Real wDer2;
-                    Compute(2, imin, imax, XDer2, wDer2);
+                    Compute(values, 2, imin, imax, XDer2, wDer2);
                     jet[2] = invW * (XDer2 - (Real)2 * wDer1 * jet[1] - wDer2 * jet[0]);
 
                     if (order == 3)
@@ -181,7 +189,7 @@ namespace gte
                         // Compute third derivative.
                         Vector<N, Real> XDer3;
                         Real wDer3;
-                        Compute(3, imin, imax, XDer3, wDer3);
+                        Compute(values, 3, imin, imax, XDer3, wDer3);
                         jet[3] = invW * (XDer3 - (Real)3 * wDer1 * jet[2] -
                             (Real)3 * wDer2 * jet[1] - wDer3 * jet[0]);
                     }
@@ -189,9 +197,77 @@ namespace gte
             }
         }
 
+        // Evaluate the curve and its derivatives through the specified order
+        // at numTimes times. The output 'jets' must have
+        // numTimes * (order + 1) elements, and jets[(order + 1) * m + k] is
+        // the derivative of order k at times[m]; the values are the same as
+        // those of Evaluate(...). Like Evaluate(...), the function may be
+        // called concurrently for the same curve. The knot span of a time is
+        // searched starting at the span of the previous time, so sorted times
+        // are the most efficient. The times are partitioned among the threads
+        // of an optional TaskScheduler.
+        void EvaluateBatch(size_t numTimes, Real const* times, unsigned int order,
+            Vector<N, Real>* jets, TaskScheduler* scheduler = nullptr) const
+        {
+            LogAssert(order < static_cast<unsigned int>(ParametricCurve<N, Real>::SUP_ORDER),
+                "Invalid order.");
+
+            size_t numChunks = 1;
+            if (scheduler != nullptr)
+            {
+                numChunks = std::max(std::min(numTimes,
+                    static_cast<size_t>(scheduler->GetNumThreads())), static_cast<size_t>(1));
+            }
+
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numTimes, times, order, jets, numChunks](size_t chunk)
+                {
+                    BasisFunctionValues<Real> values;
+                    size_t const first = numTimes * chunk / numChunks;
+                    size_t const last = numTimes * (chunk + 1) / numChunks;
+                    for (size_t m = first; m < last; ++m)
+                    {
+                        mBasisFunction.Evaluate(times[m], order, values);
+                        int imin = values.minIndex, imax = values.maxIndex;
+                        Vector<N, Real>* jet = jets + (order + 1) * m;
+                        Vector<N, Real> X;
+                        Real w;
+                        Compute(values, 0, imin, imax, X, w);
+                        Real invW = (Real)1 / w;
+                        jet[0] = invW * X;
+
+                        if (order >= 1)
+                        {
+                            Vector<N, Real> XDer1;
+                            Real wDer1;
+                            Compute(values, 1, imin, imax, XDer1, wDer1);
+                            jet[1] = invW * (XDer1 - wDer1 * jet[0]);
+
+                            if (order >= 2)
+                            {
+                                Vector<N, Real> XDer2;
+                                Real wDer2;
+                                Compute(values, 2, imin, imax, XDer2, wDer2);
+                                jet[2] = invW * (XDer2 - (Real)2 * wDer1 * jet[1] - wDer2 * jet[0]);
+
+                                if (order == 3)
+                                {
+                                    Vector<N, Real> XDer3;
+                                    Real wDer3;
+                                    Compute(values, 3, imin, imax, XDer3, wDer3);
+                                    jet[3] = invW * (XDer3 - (Real)3 * wDer1 * jet[2] -
+                                        (Real)3 * wDer2 * jet[1] - wDer3 * jet[0]);
+                                }
+                            }
+                        }
+                    }
+                });
+        }
+
     protected:
         // Support for Evaluate(...).
-        void Compute(unsigned int order, int imin, int imax, Vector<N, Real>& X, Real& w) const
+        void Compute(BasisFunctionValues<Real> const& values, unsigned int order,
+            int imin, int imax, Vector<N, Real>& X, Real& w) const
         {
             // The j-index introduces a tiny amount of overhead in order to
             // handle both aperiodic and periodic splines.  For aperiodic
@@ -203,7 +279,7 @@ namespace gte
             for (int i = imin; i <= imax; ++i)
             {
                 int j = (i >= numControls ? i - numControls : i);
-                Real tmp = mBasisFunction.GetValue(order, i) * mWeights[j];
+                Real tmp = values.Get(order, i) * mWeights[j];
                 X += tmp * mControls[j];
                 w += tmp;
             }
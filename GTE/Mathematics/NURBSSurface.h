@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.12.28
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -161,14 +161,18 @@ namespace gte
                 return;
             }
 
-            int iumin, iumax, ivmin, ivmax;
-            mBasisFunction[0].Evaluate(u, order, iumin, iumax);
-            mBasisFunction[1].Evaluate(v, order, ivmin, ivmax);
+            // The basis function values are stored per thread, so the
+            // function can be called concurrently.
+            thread_local std::array<BasisFunctionValues<Real>, 2> values;
+            mBasisFunction[0].Evaluate(u, order, values[0]);
+            mBasisFunction[1].Evaluate(v, order, values[1]);
+            int iumin = values[0].minIndex, iumax = values[0].maxIndex;
+            int ivmin = values[1].minIndex, ivmax = values[1].maxIndex;
 
             // Compute position.
             Vector<N, Real> X;
             Real w;
-            Compute(0, 0, iumin, iumax, ivmin, ivmax, X, w);
+            Compute(values, 0, 0, iumin, iumax, ivmin, ivmax, X, w);
             Real invW = (Real)1 / w;
             jet[0] = invW * X;
 
@@ -177,12 +181,12 @@ namespace gte
                 // Compute first-order derivatives.
                 Vector<N, Real> XDerU;
                 Real wDerU;
-                Compute(1, 0, iumin, iumax, ivmin, ivmax, XDerU, wDerU);
+                Compute(values, 1, 0, iumin, iumax, ivmin, ivmax, XDerU, wDerU);
                 jet[1] = invW * (XDerU - wDerU * jet[0]);
 
                 Vector<N, Real> XDerV;
                 Real wDerV;
-                Compute(0, 1, iumin, iumax, ivmin, ivmax, XDerV, wDerV);
+                Compute(values, 0, 1, iumin, iumax, ivmin, ivmax, XDerV, wDerV);
                 jet[2] = invW * (XDerV - wDerV * jet[0]);
 
                 if (order >= 2)
@@ -190,18 +194,18 @@ namespace gte
                     // Compute second-order derivatives.
                     Vector<N, Real> XDerUU;
                     Real wDerUU;
-                    Compute(2, 0, iumin, iumax, ivmin, ivmax, XDerUU, wDerUU);
+                    Compute(values, 2, 0, iumin, iumax, ivmin, ivmax, XDerUU, wDerUU);
                     jet[3] = invW * (XDerUU - (Real)2 * wDerU * jet[1] - wDerUU * jet[0]);
 
                     Vector<N, Real> XDerUV;
                     Real wDerUV;
-                    Compute(1, 1, iumin, iumax, ivmin, ivmax, XDerUV, wDerUV);
+                    Compute(values, 1, 1, iumin, iumax, ivmin, ivmax, XDerUV, wDerUV);
                     jet[4] = invW * (XDerUV - wDerU * jet[2] - wDerV * jet[1]
                         - wDerUV * jet[0]);
 
                     Vector<N, Real> XDerVV;
                     Real wDerVV;
-                    Compute(0, 2, iumin, iumax, ivmin, ivmax, XDerVV, wDerVV);
+                    Compute(values, 0, 2, iumin, iumax, ivmin, ivmax, XDerVV, wDerVV);
                     jet[5] = invW * (XDerVV - (Real)2 * wDerV * jet[2] - wDerVV * jet[0]);
                 }
             }
@@ -209,7 +213,8 @@ namespace gte
 
     protected:
         // Support for Evaluate(...).
-        void Compute(unsigned int uOrder, unsigned int vOrder, int iumin,
+        void Compute(std::array<BasisFunctionValues<Real>, 2> const& values,
+            unsigned int uOrder, unsigned int vOrder, int iumin,
             int iumax, int ivmin, int ivmax, Vector<N, Real>& X, Real& w) const
         {
             // The j*-indices introduce a tiny amount of overhead in order to handle
@@ -222,11 +227,11 @@ namespace gte
             w = (Real)0;
             for (int iv = ivmin; iv <= ivmax; ++iv)
             {
-                Real tmpv = mBasisFunction[1].GetValue(vOrder, iv);
+                Real tmpv = values[1].Get(vOrder, iv);
                 int jv = (iv >= numControls1 ? iv - numControls1 : iv);
                 for (int iu = iumin; iu <= iumax; ++iu)
                 {
-                    Real tmpu = mBasisFunction[0].GetValue(uOrder, iu);
+                    Real tmpu = values[0].Get(uOrder, iu);
                     int ju = (iu >= numControls0 ? iu - numControls0 : iu);
                     int index = ju + numControls0 * jv;
                     Real tmp = tmpu * tmpv * mWeights[index];
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.12.28
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -134,15 +134,20 @@ namespace gte
                 return;
             }
 
-            int iumin, iumax, ivmin, ivmax, iwmin, iwmax;
-            mBasisFunction[0].Evaluate(u, order, iumin, iumax);
-            mBasisFunction[1].Evaluate(v, order, ivmin, ivmax);
-            mBasisFunction[2].Evaluate(w, order, iwmin, iwmax);
+            // The basis function values are stored per thread, so the
+            // function can be called concurrently.
+            thread_local std::array<BasisFunctionValues<Real>, 3> values;
+            mBasisFunction[0].Evaluate(u, order, values[0]);
+            mBasisFunction[1].Evaluate(v, order, values[1]);
+            mBasisFunction[2].Evaluate(w, order, values[2]);
+            int iumin = values[0].minIndex, iumax = values[0].maxIndex;
+            int ivmin = values[1].minIndex, ivmax = values[1].maxIndex;
+            int iwmin = values[2].minIndex, iwmax = values[2].maxIndex;
 
             // Compute position.
             Vector<N, Real> X;
             Real h;
-            Compute(0, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, X, h);
+            Compute(values, 0, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, X, h);
             Real invH = (Real)1 / h;
             jet[0] = invH * X;
 
@@ -151,17 +156,17 @@ namespace gte
                 // Compute first-order derivatives.
                 Vector<N, Real> XDerU;
                 Real hDerU;
-                Compute(1, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerU, hDerU);
+                Compute(values, 1, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerU, hDerU);
                 jet[1] = invH * (XDerU - hDerU * jet[0]);
 
                 Vector<N, Real> XDerV;
                 Real hDerV;
-                Compute(0, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerV, hDerV);
+                Compute(values, 0, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerV, hDerV);
                 jet[2] = invH * (XDerV - hDerV * jet[0]);
 
                 Vector<N, Real> XDerW;
                 Real hDerW;
-                Compute(0, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerW, hDerW);
+                Compute(values, 0, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerW, hDerW);
                 jet[3] = invH * (XDerW - hDerW * jet[0]);
 
                 if (order >= 2)
@@ -169,32 +174,32 @@ namespace gte
                     // Compute second-order derivatives.
                     Vector<N, Real> XDerUU;
                     Real hDerUU;
-                    Compute(2, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerUU, hDerUU);
+                    Compute(values, 2, 0, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerUU, hDerUU);
                     jet[4] = invH * (XDerUU - (Real)2 * hDerU * jet[1] - hDerUU * jet[0]);
 
                     Vector<N, Real> XDerVV;
                     Real hDerVV;
-                    Compute(0, 2, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerVV, hDerVV);
+                    Compute(values, 0, 2, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerVV, hDerVV);
                     jet[5] = invH * (XDerVV - (Real)2 * hDerV * jet[2] - hDerVV * jet[0]);
 
                     Vector<N, Real> XDerWW;
                     Real hDerWW;
-                    Compute(0, 0, 2, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerWW, hDerWW);
+                    Compute(values, 0, 0, 2, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerWW, hDerWW);
                     jet[6] = invH * (XDerWW - (Real)2 * hDerW * jet[3] - hDerWW * jet[0]);
 
                     Vector<N, Real> XDerUV;
                     Real hDerUV;
-                    Compute(1, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerUV, hDerUV);
+                    Compute(values, 1, 1, 0, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerUV, hDerUV);
                     jet[7] = invH * (XDerUV - hDerU * jet[2] - hDerV * jet[1] - hDerUV * jet[0]);
 
                     Vector<N, Real> XDerUW;
                     Real hDerUW;
-                    Compute(1, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerUW, hDerUW);
+                    Compute(values, 1, 0, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerUW, hDerUW);
                     jet[8] = invH * (XDerUW - hDerU * jet[3] - hDerW * jet[1] - hDerUW * jet[0]);
 
                     Vector<N, Real> XDerVW;
                     Real hDerVW;
-                    Compute(0, 1, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerVW, hDerVW);
+                    Compute(values, 0, 1, 1, iumin, iumax, ivmin, ivmax, iwmin, iwmax, XDerVW, hDerVW);
                     jet[9] = invH * (XDerVW - hDerV * jet[3] - hDerW * jet[2] - hDerVW * jet[0]);
                 }
             }
@@ -202,7 +207,8 @@ namespace gte
 
     private:
         // Support for Evaluate(...).
-        void Compute(unsigned int uOrder, unsigned int vOrder,
+        void Compute(std::array<BasisFunctionValues<Real>, 3> const& values,
+            unsigned int uOrder, unsigned int vOrder,
             unsigned int wOrder, int iumin, int iumax, int ivmin, int ivmax,
             int iwmin, int iwmax, Vector<N, Real>& X, Real& h) const
         {
@@ -217,16 +223,16 @@ namespace gte
             h = (Real)0;
             for (int iw = iwmin; iw <= iwmax; ++iw)
             {
-                Real tmpw = mBasisFunction[2].GetValue(wOrder, iw);
+                Real tmpw = values[2].Get(wOrder, iw);
                 int jw = (iw >= numControls2 ? iw - numControls2 : iw);
                 for (int iv = ivmin; iv <= ivmax; ++iv)
                 {
-                    Real tmpv = mBasisFunction[1].GetValue(vOrder, iv);
+                    Real tmpv = values[1].Get(vOrder, iv);
                     Real tmpvw = tmpv * tmpw;
                     int jv = (iv >= numControls1 ? iv - numControls1 : iv);
                     for (int iu = iumin; iu <= iumax; ++iu)
                     {
-                        Real tmpu = mBasisFunction[0].GetValue(uOrder, iu);
+                        Real tmpu = values[0].Get(uOrder, iu);
                         int ju = (iu >= numControls0 ? iu - numControls0 : iu);
                         int index = ju + numControls0 * (jv + numControls1 * jw);
                         Real tmp = (tmpu * tmpvw) * mWeights[index];
@@ -3,12 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <vector>
 
 // TODO: This is not a KD-tree nearest neighbor query. Instead, it is an
@@ -24,6 +28,23 @@
 // 'Vector<N,Real> GetPosition () const'. The Site template parameter
 // allows the query to be applied even when it has more local information
 // than just point location.
+//
+// The leaf points are also stored in structure-of-arrays form, one array of
+// coordinates per dimension, so that the squared distances from a query
+// point to the points of a leaf are computed by fixed-length loops that the
+// compiler can vectorize. Once MaxNeighbors candidates are known, subtrees
+// farther than the current MaxNeighbors-th distance are skipped; the
+// skipped points could not have been accepted, so the results are those of
+// the exhaustive traversal. The batch queries partition the query points
+// among threads and are equivalent to the single-point queries.
+//
+// FindApproximateNeighbors trades accuracy for speed. It visits the nearer
+// child of a node first and skips a subtree when (1+epsilon) times its
+// distance exceeds the distance of the last neighbor found, so each
+// returned distance is at most (1+epsilon) times the exact one. It also
+// stops after visiting 'maxLeafVisits' leaves. With epsilon zero and no
+// leaf limit, the neighbors are the exact ones, although equidistant sites
+// can be reported in a different order than FindNeighbors reports them.
 
 namespace gte
 {
@@ -82,6 +103,23 @@ namespace gte
             int right;
         };
 
+        // Counters for FindApproximateNeighbors. The nodes include the
+        // leaves, and the sites are those whose distances were computed.
+        struct Statistics
+        {
+            Statistics()
+                :
+                numNodesVisited(0),
+                numLeavesVisited(0),
+                numSitesTested(0)
+            {
+            }
+
+            size_t numNodesVisited;
+            size_t numLeavesVisited;
+            size_t numSitesTested;
+        };
+
         // Construction.
         NearestNeighborQuery(std::vector<Site> const& sites, int maxLeafSize, int maxLevel)
             :
@@ -101,6 +139,15 @@ namespace gte
 
             mNodes.push_back(Node());
             Build(numSites, 0, 0, 0);
+
+            for (int d = 0; d < N; ++d)
+            {
+                mCoordinates[d].resize(numSites);
+                for (int i = 0; i < numSites; ++i)
+                {
+                    mCoordinates[d][i] = mSortedPoints[i].first[d];
+                }
+            }
         }
 
         // Member access.
@@ -155,10 +202,11 @@ namespace gte
             // a stack. The maximum depth is limited to 32, because the number
             // of sites is limited to 2^{32} (the number of 32-bit integer
             // indices).
-            std::array<int, 32> stack;
+            std::array<int, 34> stack;
             int top = 0;
             stack[0] = 0;
 
+            std::array<Real, msBlockSize> sqrLengths;
             int maxNeighbors = MaxNeighbors;
             if (maxNeighbors == 1)
             {
@@ -168,32 +216,29 @@ namespace gte
 
                     if (node.siteOffset != -1)
                     {
-                        for (int i = 0, j = node.siteOffset; i < node.numSites; ++i, ++j)
+                        int const numSites = node.numSites;
+                        for (int i0 = 0; i0 < numSites; i0 += msBlockSize)
                         {
-                            auto diff = mSortedPoints[j].first - point;
-                            auto sqrLength = Dot(diff, diff);
-                            if (sqrLength <= sqrRadius)
+                            int const numBlock = ComputeSqrLengths(point, node.siteOffset + i0,
+                                numSites - i0, sqrLengths);
+                            for (int i = 0, j = node.siteOffset + i0; i < numBlock; ++i, ++j)
                             {
-                                // Maintain the nearest neighbors.
-                                if (sqrLength <= neighborSqrLength[0])
+                                Real sqrLength = sqrLengths[i];
+                                if (sqrLength <= sqrRadius)
                                 {
-                                    localNeighbors[0] = mSortedPoints[j].second;
-                                    neighborSqrLength[0] = sqrLength;
-                                    numNeighbors = 1;
+                                    // Maintain the nearest neighbors.
+                                    if (sqrLength <= neighborSqrLength[0])
+                                    {
+                                        localNeighbors[0] = mSortedPoints[j].second;
+                                        neighborSqrLength[0] = sqrLength;
+                                        numNeighbors = 1;
+                                    }
                                 }
                             }
                         }
                     }
 
-                    if (node.left != -1 && point[node.axis] - radius <= node.split)
-                    {
-                        stack[++top] = node.left;
-                    }
-
-                    if (node.right != -1 && point[node.axis] + radius >= node.split)
-                    {
-                        stack[++top] = node.right;
-                    }
+                    Push(node, point, radius, neighborSqrLength[0], stack, top);
                 }
             }
             else
@@ -204,58 +249,299 @@ namespace gte
 
                     if (node.siteOffset != -1)
                     {
-                        for (int i = 0, j = node.siteOffset; i < node.numSites; ++i, ++j)
+                        int const numSites = node.numSites;
+                        for (int i0 = 0; i0 < numSites; i0 += msBlockSize)
                         {
-                            Vector<N, Real> diff = mSortedPoints[j].first - point;
-                            Real sqrLength = Dot(diff, diff);
-                            if (sqrLength <= sqrRadius)
+                            int const numBlock = ComputeSqrLengths(point, node.siteOffset + i0,
+                                numSites - i0, sqrLengths);
+                            for (int i = 0, j = node.siteOffset + i0; i < numBlock; ++i, ++j)
                             {
-                                // Maintain the nearest neighbors.
-                                int k;
-                                for (k = 0; k < numNeighbors; ++k)
+                                Real sqrLength = sqrLengths[i];
+                                if (sqrLength <= sqrRadius)
                                 {
-                                    if (sqrLength <= neighborSqrLength[k])
+                                    // Maintain the nearest neighbors.
+                                    int k;
+                                    for (k = 0; k < numNeighbors; ++k)
                                     {
-                                        for (int n = numNeighbors; n > k; --n)
+                                        if (sqrLength <= neighborSqrLength[k])
                                         {
-                                            localNeighbors[n] = localNeighbors[n - 1];
-                                            neighborSqrLength[n] = neighborSqrLength[n - 1];
+                                            for (int n = numNeighbors; n > k; --n)
+                                            {
+                                                localNeighbors[n] = localNeighbors[n - 1];
+                                                neighborSqrLength[n] = neighborSqrLength[n - 1];
+                                            }
+                                            break;
                                         }
-                                        break;
+                                    }
+                                    if (k < MaxNeighbors)
+                                    {
+                                        localNeighbors[k] = mSortedPoints[j].second;
+                                        neighborSqrLength[k] = sqrLength;
+                                    }
+                                    if (numNeighbors < MaxNeighbors)
+                                    {
+                                        ++numNeighbors;
                                     }
                                 }
-                                if (k < MaxNeighbors)
+                            }
+                        }
+                    }
+
+                    Push(node, point, radius, neighborSqrLength[MaxNeighbors - 1], stack, top);
+                }
+            }
+
+
+            for (int i = 0; i < numNeighbors; ++i)
+            {
+                neighbors[i] = localNeighbors[i];
+            }
+
+            return numNeighbors;
+        }
+
+        // Compute up to MaxNeighbors approximate nearest neighbors within
+        // the specified radius of the point; see the comments at the
+        // beginning of this file. The counters are added to 'statistics'
+        // when it is not null.
+        template <int MaxNeighbors>
+        int FindApproximateNeighbors(Vector<N, Real> const& point, Real radius, Real epsilon,
+            int maxLeafVisits, std::array<int, MaxNeighbors>& neighbors,
+            Statistics* statistics = nullptr) const
+        {
+            LogAssert(epsilon >= (Real)0 && maxLeafVisits > 0, "Invalid input.");
+
+            Real sqrRadius = radius * radius;
+            Real sqrScale = ((Real)1 + epsilon) * ((Real)1 + epsilon);
+            int numNeighbors = 0;
+            std::array<Real, MaxNeighbors> neighborSqrLength;
+            Real sqrBound = sqrRadius;
+
+            // Each stack element stores a node and a lower bound for the
+            // squared distance from the point to the node's sites.
+            std::array<std::pair<int, Real>, 34> stack;
+            int top = 0;
+            stack[0] = std::make_pair(0, (Real)0);
+
+            Statistics counters;
+            std::array<Real, msBlockSize> sqrLengths;
+            while (top >= 0 && static_cast<int>(counters.numLeavesVisited) < maxLeafVisits)
+            {
+                Node const& node = mNodes[stack[top].first];
+                Real lowerBound = stack[top--].second;
+                if (sqrScale * lowerBound > sqrBound)
+                {
+                    continue;
+                }
+                ++counters.numNodesVisited;
+
+                if (node.siteOffset != -1)
+                {
+                    ++counters.numLeavesVisited;
+                    counters.numSitesTested += static_cast<size_t>(node.numSites);
+                    int const numSites = node.numSites;
+                    for (int i0 = 0; i0 < numSites; i0 += msBlockSize)
+                    {
+                        int const numBlock = ComputeSqrLengths(point, node.siteOffset + i0,
+                            numSites - i0, sqrLengths);
+                        for (int i = 0, j = node.siteOffset + i0; i < numBlock; ++i, ++j)
+                        {
+                            Real sqrLength = sqrLengths[i];
+                            if (sqrLength <= sqrBound)
+                            {
+                                // Maintain the nearest neighbors sorted by
+                                // distance. The bound shrinks to the last
+                                // distance once the array is full.
+                                int k = std::min(numNeighbors, MaxNeighbors - 1);
+                                for (; k > 0 && sqrLength < neighborSqrLength[k - 1]; --k)
                                 {
-                                    localNeighbors[k] = mSortedPoints[j].second;
-                                    neighborSqrLength[k] = sqrLength;
+                                    neighbors[k] = neighbors[k - 1];
+                                    neighborSqrLength[k] = neighborSqrLength[k - 1];
                                 }
+                                neighbors[k] = mSortedPoints[j].second;
+                                neighborSqrLength[k] = sqrLength;
                                 if (numNeighbors < MaxNeighbors)
                                 {
                                     ++numNeighbors;
                                 }
+                                if (numNeighbors == MaxNeighbors)
+                                {
+                                    sqrBound = neighborSqrLength[MaxNeighbors - 1];
+                                }
                             }
                         }
                     }
-
-                    if (node.left != -1 && point[node.axis] - radius <= node.split)
+                }
+                else
+                {
+                    // Push the farther child first so that the nearer child
+                    // is visited next.
+                    Real diff = point[node.axis] - node.split;
+                    Real farBound = std::max(lowerBound, diff * diff);
+                    if (diff < (Real)0)
                     {
-                        stack[++top] = node.left;
+                        stack[++top] = std::make_pair(node.right, farBound);
+                        stack[++top] = std::make_pair(node.left, lowerBound);
                     }
+                    else
+                    {
+                        stack[++top] = std::make_pair(node.left, farBound);
+                        stack[++top] = std::make_pair(node.right, lowerBound);
+                    }
+                }
+            }
+
+            if (statistics)
+            {
+                statistics->numNodesVisited += counters.numNodesVisited;
+                statistics->numLeavesVisited += counters.numLeavesVisited;
+                statistics->numSitesTested += counters.numSitesTested;
+            }
+            return numNeighbors;
+        }
+
+        // Compute all the neighbors within the specified radius of the
+        // point, regardless of their number. The neighbors are indices into
+        // the array passed to the constructor, listed in the order the
+        // traversal visits them (not sorted by distance).
+        void FindAllNeighbors(Vector<N, Real> const& point, Real radius, std::vector<int>& neighbors) const
+        {
+            neighbors.clear();
+
+            Real sqrRadius = radius * radius;
+            Real const noBound = std::numeric_limits<Real>::max();
+            std::array<int, 34> stack;
+            int top = 0;
+            stack[0] = 0;
+
+            std::array<Real, msBlockSize> sqrLengths;
+            while (top >= 0)
+            {
+                Node node = mNodes[stack[top--]];
 
-                    if (node.right != -1 && point[node.axis] + radius >= node.split)
+                if (node.siteOffset != -1)
+                {
+                    int const numSites = node.numSites;
+                    for (int i0 = 0; i0 < numSites; i0 += msBlockSize)
                     {
-                        stack[++top] = node.right;
+                        int const numBlock = ComputeSqrLengths(point, node.siteOffset + i0,
+                            numSites - i0, sqrLengths);
+                        for (int i = 0, j = node.siteOffset + i0; i < numBlock; ++i, ++j)
+                        {
+                            if (sqrLengths[i] <= sqrRadius)
+                            {
+                                neighbors.push_back(mSortedPoints[j].second);
+                            }
+                        }
                     }
                 }
+
+                Push(node, point, radius, noBound, stack, top);
             }
+        }
+
+        // Batch queries. The query points are partitioned into contiguous
+        // ranges, one per thread, and the threads are tasks of the scheduler
+        // when it is not null. The results for points[i] are those of the
+        // single-point query: numNeighbors[i] is the number of neighbors and
+        // neighbors[i][0..numNeighbors[i]-1] are the indices.
+        template <int MaxNeighbors>
+        void FindNeighbors(std::vector<Vector<N, Real>> const& points, Real radius,
+            std::vector<std::array<int, MaxNeighbors>>& neighbors,
+            std::vector<int>& numNeighbors, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            neighbors.resize(points.size());
+            numNeighbors.resize(points.size());
+            size_t const numPoints = points.size();
+            size_t const numChunks = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, &points, radius, &neighbors, &numNeighbors, numPoints, numChunks](size_t c)
+                {
+                    size_t const begin = numPoints * c / numChunks;
+                    size_t const end = numPoints * (c + 1) / numChunks;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        numNeighbors[i] = FindNeighbors<MaxNeighbors>(points[i], radius, neighbors[i]);
+                    }
+                });
+        }
 
+        // Batch version of FindApproximateNeighbors. The counters of all
+        // the queries are added to 'statistics' when it is not null.
+        template <int MaxNeighbors>
+        void FindApproximateNeighbors(std::vector<Vector<N, Real>> const& points, Real radius,
+            Real epsilon, int maxLeafVisits, std::vector<std::array<int, MaxNeighbors>>& neighbors,
+            std::vector<int>& numNeighbors, Statistics* statistics = nullptr,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr) const
+        {
+            neighbors.resize(points.size());
+            numNeighbors.resize(points.size());
+            size_t const numRanges = std::max(std::min(numThreads, points.size()), static_cast<size_t>(1));
+            std::vector<Statistics> rangeStatistics(numRanges);
+            TaskScheduler::ParallelFor(scheduler, numRanges,
+                [this, &points, radius, epsilon, maxLeafVisits, &neighbors, &numNeighbors,
+                &rangeStatistics, numRanges](size_t r)
+                {
+                    size_t const begin = r * points.size() / numRanges;
+                    size_t const end = (r + 1) * points.size() / numRanges;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        numNeighbors[i] = FindApproximateNeighbors<MaxNeighbors>(points[i],
+                            radius, epsilon, maxLeafVisits, neighbors[i], &rangeStatistics[r]);
+                    }
+                });
 
-            for (int i = 0; i < numNeighbors; ++i)
+            if (statistics)
             {
-                neighbors[i] = localNeighbors[i];
+                for (auto const& counters : rangeStatistics)
+                {
+                    statistics->numNodesVisited += counters.numNodesVisited;
+                    statistics->numLeavesVisited += counters.numLeavesVisited;
+                    statistics->numSitesTested += counters.numSitesTested;
+                }
             }
+        }
 
-            return numNeighbors;
+        // The neighbors of points[i] within the radius are stored in
+        // neighbors[offsets[i]] through neighbors[offsets[i+1]-1], so the
+        // offsets array has points.size()+1 elements.
+        void FindAllNeighbors(std::vector<Vector<N, Real>> const& points, Real radius,
+            std::vector<int>& offsets, std::vector<int>& neighbors, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            size_t const numPoints = points.size();
+            offsets.resize(numPoints + 1);
+            offsets[0] = 0;
+            neighbors.clear();
+
+            // Each thread appends the neighbors of its range to that range's
+            // array. The arrays are concatenated in range order.
+            size_t const numRanges = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            std::vector<std::vector<int>> rangeNeighbors(numRanges);
+            TaskScheduler::ParallelFor(scheduler, numRanges,
+                [this, &points, radius, &offsets, &rangeNeighbors, numRanges, numPoints](size_t r)
+                {
+                    size_t const begin = r * numPoints / numRanges;
+                    size_t const end = (r + 1) * numPoints / numRanges;
+                    std::vector<int> current;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        FindAllNeighbors(points[i], radius, current);
+                        rangeNeighbors[r].insert(rangeNeighbors[r].end(), current.begin(), current.end());
+                        offsets[i + 1] = static_cast<int>(current.size());
+                    }
+                });
+
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                offsets[i + 1] += offsets[i];
+            }
+            neighbors.reserve(static_cast<size_t>(offsets[numPoints]));
+            for (auto const& output : rangeNeighbors)
+            {
+                neighbors.insert(neighbors.end(), output.begin(), output.end());
+            }
         }
 
         inline std::vector<SortedPoint> const& GetSortedPoints() const
@@ -264,6 +550,82 @@ namespace gte
         }
 
     private:
+        // The leaf points are processed in blocks of this size.
+        enum { msBlockSize = 8 };
+
+        // Compute the squared distances from the point to the sorted points
+        // j0 through j0+numBlock-1, where numBlock = min(numRemaining,
+        // msBlockSize). Full blocks use a fixed trip count. The terms are
+        // accumulated in the order of Dot(diff,diff).
+        int ComputeSqrLengths(Vector<N, Real> const& point, int j0, int numRemaining,
+            std::array<Real, msBlockSize>& sqrLengths) const
+        {
+            if (numRemaining >= msBlockSize)
+            {
+                for (int d = 0; d < N; ++d)
+                {
+                    Real const* coordinates = mCoordinates[d].data() + j0;
+                    Real const p = point[d];
+                    if (d == 0)
+                    {
+                        for (int i = 0; i < msBlockSize; ++i)
+                        {
+                            Real diff = coordinates[i] - p;
+                            sqrLengths[i] = diff * diff;
+                        }
+                    }
+                    else
+                    {
+                        for (int i = 0; i < msBlockSize; ++i)
+                        {
+                            Real diff = coordinates[i] - p;
+                            sqrLengths[i] += diff * diff;
+                        }
+                    }
+                }
+                return msBlockSize;
+            }
+            else
+            {
+                for (int i = 0, j = j0; i < numRemaining; ++i, ++j)
+                {
+                    Real diff = mCoordinates[0][j] - point[0];
+                    Real sqrLength = diff * diff;
+                    for (int d = 1; d < N; ++d)
+                    {
+                        diff = mCoordinates[d][j] - point[d];
+                        sqrLength += diff * diff;
+                    }
+                    sqrLengths[i] = sqrLength;
+                }
+                return numRemaining;
+            }
+        }
+
+        // Push the children of an interior node that intersect the query
+        // ball. A child on the far side of the splitting plane is also
+        // skipped when the squared distance to the plane exceeds sqrBound,
+        // the squared distance of the last allowed neighbor.
+        inline void Push(Node const& node, Vector<N, Real> const& point, Real radius, Real sqrBound,
+            std::array<int, 34>& stack, int& top) const
+        {
+            if (node.left != -1)
+            {
+                Real diff = point[node.axis] - node.split;
+                if (point[node.axis] - radius <= node.split
+                    && (diff <= (Real)0 || diff * diff <= sqrBound))
+                {
+                    stack[++top] = node.left;
+                }
+
+                if (point[node.axis] + radius >= node.split
+                    && (diff >= (Real)0 || diff * diff <= sqrBound))
+                {
+                    stack[++top] = node.right;
+                }
+            }
+        }
+
         // Populate the node so that it contains the points split along the
         // coordinate axes.
         void Build(int numSites, int siteOffset, int nodeIndex, int level)
@@ -329,6 +691,7 @@ namespace gte
         int mMaxLeafSize;
         int mMaxLevel;
         std::vector<SortedPoint> mSortedPoints;
+        std::array<std::vector<Real>, N> mCoordinates;
         std::vector<Node> mNodes;
         int mDepth;
         int mLargestNodeSize;
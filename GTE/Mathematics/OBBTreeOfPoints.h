@@ -3,12 +3,14 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/BitHacks.h>
 #include <Mathematics/ContOrientedBox3.h>
+#include <Mathematics/TaskScheduler.h>
+#include <vector>
 
 // The depth of a node in a (nonempty) tree is the distance from the node to
 // the root of the tree.  The height is the maximum depth.  A tree with a
@@ -17,6 +19,14 @@
 // complete binary tree of height H has 2^{H+1}-1 nodes.  The level
 // corresponding to depth D has 2^D nodes, in which case the number of
 // leaf nodes (depth H) is 2^H.
+//
+// The nodes are stored in depth-first order. The left child of a node
+// immediately follows it, and the right child follows the left subtree, so
+// every subtree occupies a contiguous block of the node array. A node with
+// n points splits them into ceil(n/2) and floor(n/2) points, so the size of
+// each subtree is known before it is built. The subtrees below the top
+// levels of the tree are therefore built concurrently when more than one
+// thread is requested, and the tree is the same for any number of threads.
 
 namespace gte
 {
@@ -49,9 +59,11 @@ namespace gte
         // 'height' specifies the height of the tree and must be no larger
         // than 31.  If it is set to std::numeric_limits<uint32_t>::max(),
         // then the entire tree is built and the actual height is computed
-        // from 'numPoints'.
+        // from 'numPoints'. The subtrees are distributed among 'numThreads'
+        // threads, which are tasks of the scheduler when it is not null.
         OBBTreeForPoints(uint32_t numPoints, char const* points, size_t stride,
-            uint32_t height = std::numeric_limits<uint32_t>::max())
+            uint32_t height = std::numeric_limits<uint32_t>::max(),
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
             :
             mNumPoints(numPoints),
             mPoints(points),
@@ -63,50 +75,52 @@ namespace gte
             // the number of nodes can be at most 2^{32} - 1.  This limits
             // the height to 31.
 
-            uint32_t numNodes;
             if (mHeight == std::numeric_limits<uint32_t>::max())
             {
                 uint32_t minPowerOfTwo =
                     static_cast<uint32_t>(BitHacks::RoundUpToPowerOfTwo(mNumPoints));
                 mHeight = BitHacks::Log2OfPowerOfTwo(minPowerOfTwo);
-                numNodes = 2 * mNumPoints - 1;
             }
-            else
+            else if (mHeight >= 32)
             {
-                // The maximum level cannot exceed 30 because we are storing
+                // The maximum level cannot exceed 31 because we are storing
                 // the indices into the node array as 32-bit unsigned
-                // integers.
-                if (mHeight < 32)
-                {
-                    numNodes = (uint32_t)(1ULL << (mHeight + 1)) - 1;
-                }
-                else
-                {
-                    // When the precondition is not met, return a tree of
-                    // height 0 (a single node).
-                    mHeight = 0;
-                    numNodes = 1;
-                }
+                // integers. When the precondition is not met, return a tree
+                // of height 0 (a single node).
+                mHeight = 0;
             }
 
-            // The tree is built recursively.  A reference to a Node is
-            // passed to BuildTree and nodes are appended to a std::vector.
-            // Because the references are on the stack, we must guarantee no
-            // reallocations to avoid invalidating the references.  TODO:
-            // This design can be modified to pass indices to the nodes so
-            // that reallocation is not a problem.
-            mTree.reserve(numNodes);
-
             // Build the tree recursively.  The array mPartition stores the
             // indices into the 'points' array so that at a node, the points
             // represented by the node are those indexed by the range
             // [node.minIndex, node.maxIndex].
+            mTree.resize(GetNumSubtreeNodes(mNumPoints, mHeight));
             for (uint32_t i = 0; i < mNumPoints; ++i)
             {
                 mPartition[i] = i;
             }
-            mTree.push_back(Node());
-            BuildTree(mTree.back(), 0, mNumPoints - 1);
+
+            if (numThreads <= 1)
+            {
+                BuildTree(0, 0, 0, mNumPoints - 1, nullptr);
+                return;
+            }
+
+            // Build the top levels of the tree in the calling thread. The
+            // subtrees with at most 'maxTaskPoints' points are deferred and
+            // then built by the threads, which fetch the next unbuilt
+            // subtree when they finish one.
+            uint32_t const maxTaskPoints = std::max(mNumPoints / static_cast<uint32_t>(
+                std::min(4 * numThreads, static_cast<size_t>(mNumPoints))), 1024u);
+            std::vector<Task> tasks;
+            BuildTree(0, 0, 0, mNumPoints - 1, &tasks, maxTaskPoints);
+
+            TaskScheduler::ParallelForDynamic(scheduler, tasks.size(), numThreads,
+                [this, &tasks](size_t k)
+                {
+                    Task const& task = tasks[k];
+                    BuildTree(task.nodeIndex, task.depth, task.i0, task.i1, nullptr);
+                });
         }
 
         // Member access.
@@ -146,8 +160,39 @@ namespace gte
             return *reinterpret_cast<Vector3<Real> const*>(mPoints + index * mStride);
         }
 
-        void BuildTree(Node& node, uint32_t i0, uint32_t i1)
+        // A subtree whose construction is deferred to a thread.
+        struct Task
         {
+            uint32_t nodeIndex, depth, i0, i1;
+        };
+
+        // The number of nodes of a subtree with 'numPoints' points and at
+        // most 'height' levels below its root. The subtree is complete when
+        // numPoints >= 2^height; otherwise, the points are split until each
+        // leaf has one point.
+        static uint32_t GetNumSubtreeNodes(uint32_t numPoints, uint32_t height)
+        {
+            if (height < 32 && static_cast<uint64_t>(numPoints) > (1ULL << height))
+            {
+                return static_cast<uint32_t>((1ULL << (height + 1)) - 1);
+            }
+            return 2 * numPoints - 1;
+        }
+
+        // Build the subtree whose root is mTree[nodeIndex]. When 'tasks'
+        // is not null, subtrees with at most 'maxTaskPoints' points are
+        // appended to it instead of being built.
+        void BuildTree(uint32_t nodeIndex, uint32_t depth, uint32_t i0, uint32_t i1,
+            std::vector<Task>* tasks, uint32_t maxTaskPoints = 0)
+        {
+            if (tasks && i1 - i0 + 1 <= maxTaskPoints)
+            {
+                tasks->push_back(Task{ nodeIndex, depth, i0, i1 });
+                return;
+            }
+
+            Node& node = mTree[nodeIndex];
+            node.depth = depth;
             node.minIndex = i0;
             node.maxIndex = i1;
 
@@ -184,16 +229,15 @@ namespace gte
                 uint32_t j0, j1;
                 SplitPoints(i0, i1, j0, j1, node.box.center, axis2);
 
-                node.leftChild = static_cast<uint32_t>(mTree.size());
-                node.rightChild = node.leftChild + 1;
-                mTree.push_back(Node());
-                Node& leftTree = mTree.back();
-                mTree.push_back(Node());
-                Node& rightTree = mTree.back();
-                leftTree.depth = node.depth + 1;
-                rightTree.depth = node.depth + 1;
-                BuildTree(leftTree, i0, j0);
-                BuildTree(rightTree, j1, i1);
+                // The left subtree immediately follows the node and the
+                // right subtree follows the left subtree.
+                node.leftChild = nodeIndex + 1;
+                node.rightChild = node.leftChild +
+                    GetNumSubtreeNodes(j0 - i0 + 1, mHeight - depth - 1);
+                uint32_t const leftChild = node.leftChild;
+                uint32_t const rightChild = node.rightChild;
+                BuildTree(leftChild, depth + 1, i0, j0, tasks, maxTaskPoints);
+                BuildTree(rightChild, depth + 1, j1, i1, tasks, maxTaskPoints);
             }
         }
 
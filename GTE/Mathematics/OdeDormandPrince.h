@@ -0,0 +1,705 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/OdeSolver.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// The Dormand-Prince embedded Runge-Kutta method of orders 5 and 4 with
+// adaptive step size control. A step computes a 5th-order estimate of
+// x(t + tDelta) and an error estimate, the difference between it and a
+// 4th-order estimate, from 7 evaluations of F, the last of which is the
+// first evaluation of the next step. The step is accepted when the error
+// satisfies
+//   sqrt(sum_i (e[i] / (absTol + relTol * max(|x[i]|, |xNext[i]|)))^2 / n)
+//     <= 1
+// and is rejected otherwise, and in both cases the step size is adjusted
+// by the factor 0.9 * error^(-1/5) clamped to [0.2,5]. The step size is
+// also clamped to [minTDelta, maxTDelta]. A step of size minTDelta is
+// accepted regardless of the error.
+//
+// OdeDormandPrince is an OdeSolver whose Update performs one accepted step,
+// starting with step size GetTDelta() and replacing it by the proposed
+// size of the next step. Integrate advances a state to a specified time.
+// The TVector template parameter allows you to create solvers with
+// Vector<N,Real> when the dimension N is known at compile time, GVector<Real>
+// when the dimension N is known at run time, or Real for a scalar equation.
+//
+// OdeDormandPrinceBatch integrates many independent systems dx/dt = F(t,x)
+// of the same dimension N. The states are stored in structure-of-arrays
+// form: component i of system s is x[s + numSystems * i]. The systems are
+// processed in blocks of BLOCK_SIZE systems. Each system of a block has its
+// own time and step size, and F is evaluated for all systems of the block in
+// one call, as are the stage combinations, whose loops over the systems have
+// unit stride and are vectorized by the compiler. The blocks are
+// distributed among the threads of an optional TaskScheduler; the results
+// do not depend on the number of threads.
+
+namespace gte
+{
+    template <typename Real>
+    class OdeDormandPrinceTableau
+    {
+    public:
+        OdeDormandPrinceTableau()
+        {
+            c = { (Real)0, (Real)1 / (Real)5, (Real)3 / (Real)10, (Real)4 / (Real)5,
+                (Real)8 / (Real)9, (Real)1, (Real)1 };
+
+            for (auto& row : a)
+            {
+                row.fill((Real)0);
+            }
+            a[1][0] = (Real)1 / (Real)5;
+            a[2][0] = (Real)3 / (Real)40;
+            a[2][1] = (Real)9 / (Real)40;
+            a[3][0] = (Real)44 / (Real)45;
+            a[3][1] = (Real)-56 / (Real)15;
+            a[3][2] = (Real)32 / (Real)9;
+            a[4][0] = (Real)19372 / (Real)6561;
+            a[4][1] = (Real)-25360 / (Real)2187;
+            a[4][2] = (Real)64448 / (Real)6561;
+            a[4][3] = (Real)-212 / (Real)729;
+            a[5][0] = (Real)9017 / (Real)3168;
+            a[5][1] = (Real)-355 / (Real)33;
+            a[5][2] = (Real)46732 / (Real)5247;
+            a[5][3] = (Real)49 / (Real)176;
+            a[5][4] = (Real)-5103 / (Real)18656;
+
+            // The 5th-order weights, which are also the coefficients of the
+            // last stage.
+            b = { (Real)35 / (Real)384, (Real)0, (Real)500 / (Real)1113,
+                (Real)125 / (Real)192, (Real)-2187 / (Real)6784, (Real)11 / (Real)84,
+                (Real)0 };
+
+            // The differences of the 5th-order and 4th-order weights.
+            e = { (Real)71 / (Real)57600, (Real)0, (Real)-71 / (Real)16695,
+                (Real)71 / (Real)1920, (Real)-17253 / (Real)339200,
+                (Real)22 / (Real)525, (Real)-1 / (Real)40 };
+        }
+
+        std::array<Real, 7> c, b, e;
+        std::array<std::array<Real, 6>, 7> a;
+    };
+
+    template <typename Real, typename TVector>
+    class OdeDormandPrince : public OdeSolver<Real, TVector>
+    {
+    public:
+        // Construction and destruction.
+        virtual ~OdeDormandPrince() = default;
+
+        OdeDormandPrince(Real tDelta, std::function<TVector(Real, TVector const&)> const& F,
+            Real absTolerance = (Real)1e-06, Real relTolerance = (Real)1e-06)
+            :
+            OdeSolver<Real, TVector>(tDelta, F),
+            mAbsTolerance(absTolerance),
+            mRelTolerance(relTolerance),
+            mMinTDelta((Real)0),
+            mMaxTDelta(std::numeric_limits<Real>::max()),
+            mMaxSteps(100000),
+            mNumAccepted(0),
+            mNumRejected(0),
+            mHasDerivative(false),
+            mTLast((Real)0)
+        {
+        }
+
+        // Member access.
+        inline void SetTolerances(Real absTolerance, Real relTolerance)
+        {
+            mAbsTolerance = absTolerance;
+            mRelTolerance = relTolerance;
+        }
+
+        inline Real GetAbsoluteTolerance() const
+        {
+            return mAbsTolerance;
+        }
+
+        inline Real GetRelativeTolerance() const
+        {
+            return mRelTolerance;
+        }
+
+        // The bounds on the magnitude of the step size, 0 and the maximum
+        // finite Real by default.
+        inline void SetTDeltaBounds(Real minTDelta, Real maxTDelta)
+        {
+            mMinTDelta = std::max(minTDelta, (Real)0);
+            mMaxTDelta = std::max(maxTDelta, mMinTDelta);
+        }
+
+        inline Real GetMinTDelta() const
+        {
+            return mMinTDelta;
+        }
+
+        inline Real GetMaxTDelta() const
+        {
+            return mMaxTDelta;
+        }
+
+        // The maximum number of accepted steps of Integrate.
+        inline void SetMaxSteps(size_t maxSteps)
+        {
+            mMaxSteps = maxSteps;
+        }
+
+        inline size_t GetMaxSteps() const
+        {
+            return mMaxSteps;
+        }
+
+        // The numbers of accepted and rejected steps since construction.
+        inline size_t GetNumAccepted() const
+        {
+            return mNumAccepted;
+        }
+
+        inline size_t GetNumRejected() const
+        {
+            return mNumRejected;
+        }
+
+        // Estimate x(t + h) from x(t) using dx/dt = F(t,x), where h is the
+        // step size that is accepted, GetTDelta() or smaller. The step size
+        // is set to the proposed size of the next step. When xIn and tIn are
+        // the outputs of the previous call, the evaluation of F at them is
+        // reused. You may allow xIn and xOut to be the same object.
+        virtual void Update(Real tIn, TVector const& xIn, Real& tOut, TVector& xOut) override
+        {
+            if (!mHasDerivative || tIn != mTLast || !(xIn == mXLast))
+            {
+                mFLast = this->mFunction(tIn, xIn);
+            }
+
+            Real h = this->mTDelta;
+            Real sign = (h >= (Real)0 ? (Real)1 : (Real)-1);
+            h = sign * std::min(std::max(std::fabs(h), mMinTDelta), mMaxTDelta);
+            Step(tIn, xIn, h, sign, (Real)0, false);
+            tOut = mTLast;
+            xOut = mXLast;
+        }
+
+        // Estimate x(t1) from x(t0), which you may do with t1 < t0. The
+        // integration starts with step size |GetTDelta()| and ends exactly
+        // at t1; GetTDelta() is set to the proposed size of the next step.
+        // The function returns 'false' when t1 is not reached within the
+        // maximum number of steps, in which case x1 is the estimate at the
+        // time returned by GetTime(). You may allow x0 and x1 to be the same
+        // object.
+        bool Integrate(Real t0, TVector const& x0, Real t1, TVector& x1)
+        {
+            Real sign = (t1 >= t0 ? (Real)1 : (Real)-1);
+            mTLast = t0;
+            mXLast = x0;
+            mFLast = this->mFunction(t0, x0);
+            mHasDerivative = true;
+
+            Real h = std::min(std::max(std::fabs(this->mTDelta), mMinTDelta), mMaxTDelta);
+            for (size_t step = 0; step < mMaxSteps && mTLast != t1; ++step)
+            {
+                Real remaining = std::fabs(t1 - mTLast);
+                bool isLast = (h >= remaining);
+                Step(mTLast, mXLast, sign * (isLast ? remaining : h), sign, t1, isLast);
+                if (mTLast == t1)
+                {
+                    break;
+                }
+                h = std::fabs(this->mTDelta);
+            }
+
+            x1 = mXLast;
+            return mTLast == t1;
+        }
+
+        // The time of the last estimate.
+        inline Real GetTime() const
+        {
+            return mTLast;
+        }
+
+    private:
+        // Compute an accepted step from (t,x) starting with step size h.
+        // The derivative F(t,x) is mFLast on input. On output, mTLast, mXLast
+        // and mFLast are the time, state and derivative at the end of the
+        // step. When isLast is 'true', t + h is t1; if the first try is
+        // accepted, the time is set to t1 exactly.
+        void Step(Real t, TVector const& x, Real h, Real sign, Real t1, bool isLast)
+        {
+            auto const& T = mTableau;
+            TVector const k1 = mFLast;
+            bool rejected = false;
+            for (;;)
+            {
+                TVector k2 = this->mFunction(t + T.c[1] * h,
+                    x + h * (T.a[1][0] * k1));
+                TVector k3 = this->mFunction(t + T.c[2] * h,
+                    x + h * (T.a[2][0] * k1 + T.a[2][1] * k2));
+                TVector k4 = this->mFunction(t + T.c[3] * h,
+                    x + h * (T.a[3][0] * k1 + T.a[3][1] * k2 + T.a[3][2] * k3));
+                TVector k5 = this->mFunction(t + T.c[4] * h,
+                    x + h * (T.a[4][0] * k1 + T.a[4][1] * k2 + T.a[4][2] * k3 +
+                    T.a[4][3] * k4));
+                TVector k6 = this->mFunction(t + h,
+                    x + h * (T.a[5][0] * k1 + T.a[5][1] * k2 + T.a[5][2] * k3 +
+                    T.a[5][3] * k4 + T.a[5][4] * k5));
+                TVector xNext = x + h * (T.b[0] * k1 + T.b[2] * k3 + T.b[3] * k4 +
+                    T.b[4] * k5 + T.b[5] * k6);
+                Real tNext = (isLast ? t1 : t + h);
+                TVector k7 = this->mFunction(tNext, xNext);
+                TVector error = h * (T.e[0] * k1 + T.e[2] * k3 + T.e[3] * k4 +
+                    T.e[4] * k5 + T.e[5] * k6 + T.e[6] * k7);
+
+                Real norm = GetErrorNorm(error, x, xNext, std::is_arithmetic<TVector>());
+                Real factor = GetFactor(norm);
+                Real magnitude = std::fabs(h);
+                if (norm <= (Real)1 || magnitude <= mMinTDelta)
+                {
+                    ++mNumAccepted;
+                    mTLast = tNext;
+                    mXLast = xNext;
+                    mFLast = k7;
+                    mHasDerivative = true;
+                    if (rejected)
+                    {
+                        factor = std::min(factor, (Real)1);
+                    }
+                    this->mTDelta = sign * std::min(std::max(magnitude * factor, mMinTDelta), mMaxTDelta);
+                    return;
+                }
+
+                ++mNumRejected;
+                rejected = true;
+                isLast = false;
+                h = sign * std::max(magnitude * factor, mMinTDelta);
+            }
+        }
+
+        Real GetErrorNorm(TVector const& error, TVector const& x, TVector const& xNext,
+            std::true_type) const
+        {
+            Real scale = mAbsTolerance + mRelTolerance * std::max(std::fabs(x), std::fabs(xNext));
+            return std::fabs(error) / scale;
+        }
+
+        Real GetErrorNorm(TVector const& error, TVector const& x, TVector const& xNext,
+            std::false_type) const
+        {
+            int const n = x.GetSize();
+            Real sum = (Real)0;
+            for (int i = 0; i < n; ++i)
+            {
+                Real scale = mAbsTolerance + mRelTolerance * std::max(std::fabs(x[i]), std::fabs(xNext[i]));
+                Real ratio = error[i] / scale;
+                sum += ratio * ratio;
+            }
+            return (n > 0 ? std::sqrt(sum / (Real)n) : (Real)0);
+        }
+
+        static Real GetFactor(Real norm)
+        {
+            Real const minFactor = (Real)0.2, maxFactor = (Real)5;
+            if (norm > (Real)0)
+            {
+                Real factor = (Real)0.9 * std::pow(norm, (Real)-0.2);
+                return std::min(std::max(factor, minFactor), maxFactor);
+            }
+            // The norm is zero or NaN.
+            return (norm == (Real)0 ? maxFactor : minFactor);
+        }
+
+        OdeDormandPrinceTableau<Real> mTableau;
+        Real mAbsTolerance, mRelTolerance;
+        Real mMinTDelta, mMaxTDelta;
+        size_t mMaxSteps;
+        size_t mNumAccepted, mNumRejected;
+
+        // The state at the end of the last step and its derivative.
+        bool mHasDerivative;
+        Real mTLast;
+        TVector mXLast, mFLast;
+    };
+
+    template <typename Real>
+    class OdeDormandPrinceBatch
+    {
+    public:
+        enum { BLOCK_SIZE = 64 };
+
+        // The function F(numSystems, t, x, dxdt) evaluates F for systems
+        // with times t[s] and states x in structure-of-arrays form,
+        // component i of system s at x[s + numSystems * i], and stores the
+        // derivatives in dxdt in the same form. It is called for blocks of
+        // at most BLOCK_SIZE systems. When a TaskScheduler is used, it is
+        // called concurrently for different blocks.
+        typedef std::function<void(size_t, Real const*, Real const*, Real*)> Function;
+
+        OdeDormandPrinceBatch(int32_t dimension, Function const& F,
+            Real absTolerance = (Real)1e-06, Real relTolerance = (Real)1e-06)
+            :
+            mDimension(dimension),
+            mFunction(F),
+            mAbsTolerance(absTolerance),
+            mRelTolerance(relTolerance),
+            mTDelta((Real)1e-03),
+            mMinTDelta((Real)0),
+            mMaxTDelta(std::numeric_limits<Real>::max()),
+            mMaxSteps(100000)
+        {
+            LogAssert(dimension > 0 && F, "Invalid input.");
+        }
+
+        // Member access. The initial step size is 1e-03 by default. See
+        // OdeDormandPrince for the meaning of the other parameters.
+        inline int32_t GetDimension() const
+        {
+            return mDimension;
+        }
+
+        inline void SetTolerances(Real absTolerance, Real relTolerance)
+        {
+            mAbsTolerance = absTolerance;
+            mRelTolerance = relTolerance;
+        }
+
+        inline Real GetAbsoluteTolerance() const
+        {
+            return mAbsTolerance;
+        }
+
+        inline Real GetRelativeTolerance() const
+        {
+            return mRelTolerance;
+        }
+
+        inline void SetTDelta(Real tDelta)
+        {
+            mTDelta = std::fabs(tDelta);
+        }
+
+        inline Real GetTDelta() const
+        {
+            return mTDelta;
+        }
+
+        inline void SetTDeltaBounds(Real minTDelta, Real maxTDelta)
+        {
+            mMinTDelta = std::max(minTDelta, (Real)0);
+            mMaxTDelta = std::max(maxTDelta, mMinTDelta);
+        }
+
+        inline Real GetMinTDelta() const
+        {
+            return mMinTDelta;
+        }
+
+        inline Real GetMaxTDelta() const
+        {
+            return mMaxTDelta;
+        }
+
+        // The maximum number of steps, accepted or rejected, per system.
+        inline void SetMaxSteps(size_t maxSteps)
+        {
+            mMaxSteps = maxSteps;
+        }
+
+        inline size_t GetMaxSteps() const
+        {
+            return mMaxSteps;
+        }
+
+        // Replace the states x(t0) of the systems by the estimates of x(t1),
+        // which you may do with t1 < t0. The function returns the number of
+        // systems that reach t1 within the maximum number of steps; the
+        // other systems have the estimates at the times they reached. If you
+        // pass a non-null numSteps, it must have numSystems elements and it
+        // is set to the numbers of accepted steps of the systems.
+        size_t Integrate(size_t numSystems, Real t0, Real t1, Real* x,
+            uint32_t* numSteps = nullptr, TaskScheduler* scheduler = nullptr) const
+        {
+            LogAssert(numSystems == 0 || x != nullptr, "Invalid input.");
+
+            size_t const numBlocks = (numSystems + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            size_t numChunks = 1;
+            if (scheduler != nullptr)
+            {
+                numChunks = std::min(numBlocks, static_cast<size_t>(scheduler->GetNumThreads()));
+            }
+            numChunks = std::max(numChunks, static_cast<size_t>(1));
+
+            std::vector<size_t> numReached(numChunks, 0);
+            auto integrate = [this, numSystems, numBlocks, numChunks, t0, t1, x,
+                numSteps, &numReached](size_t chunk)
+            {
+                Workspace workspace(mDimension);
+                for (size_t block = chunk; block < numBlocks; block += numChunks)
+                {
+                    size_t first = block * BLOCK_SIZE;
+                    size_t count = std::min(static_cast<size_t>(BLOCK_SIZE), numSystems - first);
+                    numReached[chunk] += IntegrateBlock(first, count, numSystems,
+                        t0, t1, x, numSteps, workspace);
+                }
+            };
+
+            if (scheduler != nullptr && numChunks > 1)
+            {
+                scheduler->ParallelFor(numChunks, integrate);
+            }
+            else
+            {
+                integrate(0);
+            }
+
+            size_t total = 0;
+            for (auto value : numReached)
+            {
+                total += value;
+            }
+            return total;
+        }
+
+    private:
+        struct Workspace
+        {
+            Workspace(int32_t dimension)
+                :
+                x(static_cast<size_t>(dimension) * BLOCK_SIZE),
+                xStage(x.size()),
+                xNext(x.size())
+            {
+                for (auto& k : K)
+                {
+                    k.resize(x.size());
+                }
+            }
+
+            std::vector<Real> x, xStage, xNext;
+            std::array<std::vector<Real>, 7> K;
+            std::array<Real, BLOCK_SIZE> t, tStage, h, norm;
+            std::array<uint8_t, BLOCK_SIZE> accepted, rejected, isLast;
+            std::array<uint32_t, BLOCK_SIZE> steps;
+        };
+
+        size_t IntegrateBlock(size_t first, size_t count, size_t numSystems,
+            Real t0, Real t1, Real* xSystems, uint32_t* numSteps, Workspace& W) const
+        {
+            auto const& T = mTableau;
+            size_t const n = static_cast<size_t>(mDimension);
+            Real const zero = (Real)0, one = (Real)1;
+            Real const sign = (t1 >= t0 ? one : -one);
+            Real const remaining = std::fabs(t1 - t0);
+            Real const h0 = std::min(std::max(mTDelta, mMinTDelta), mMaxTDelta);
+
+            // Copy the states into the block, which has stride 'count'.
+            for (size_t i = 0; i < n; ++i)
+            {
+                std::copy(xSystems + first + numSystems * i,
+                    xSystems + first + numSystems * i + count, W.x.data() + count * i);
+            }
+
+            // A step size of zero marks a system that has reached t1 or has
+            // used the maximum number of steps. Such a system does not
+            // change in the updates.
+            for (size_t s = 0; s < count; ++s)
+            {
+                W.t[s] = t0;
+                W.isLast[s] = (h0 >= remaining ? 1 : 0);
+                W.h[s] = sign * (W.isLast[s] ? remaining : h0);
+                W.rejected[s] = 0;
+                W.steps[s] = 0;
+            }
+            mFunction(count, W.t.data(), W.x.data(), W.K[0].data());
+
+            for (size_t iteration = 0; iteration < mMaxSteps; ++iteration)
+            {
+                bool active = false;
+                for (size_t s = 0; s < count; ++s)
+                {
+                    active = active || (W.h[s] != zero);
+                }
+                if (!active)
+                {
+                    break;
+                }
+
+                // Stages 2 through 6, the 5th-order estimate and stage 7.
+                for (size_t stage = 1; stage <= 6; ++stage)
+                {
+                    Real const* weights = (stage < 6 ? T.a[stage].data() : T.b.data());
+                    Real* target = (stage < 6 ? W.xStage.data() : W.xNext.data());
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Real const* x = W.x.data() + count * i;
+                        Real* y = target + count * i;
+                        for (size_t s = 0; s < count; ++s)
+                        {
+                            y[s] = zero;
+                        }
+                        for (size_t j = 0; j < stage; ++j)
+                        {
+                            Real const weight = weights[j];
+                            if (weight != zero)
+                            {
+                                Real const* k = W.K[j].data() + count * i;
+                                for (size_t s = 0; s < count; ++s)
+                                {
+                                    y[s] += weight * k[s];
+                                }
+                            }
+                        }
+                        for (size_t s = 0; s < count; ++s)
+                        {
+                            y[s] = x[s] + W.h[s] * y[s];
+                        }
+                    }
+
+                    for (size_t s = 0; s < count; ++s)
+                    {
+                        W.tStage[s] = (stage < 6 ? W.t[s] + T.c[stage] * W.h[s] : W.t[s] + W.h[s]);
+                    }
+                    mFunction(count, W.tStage.data(), target, W.K[stage].data());
+                }
+
+                // Compute the error norms.
+                for (size_t s = 0; s < count; ++s)
+                {
+                    W.norm[s] = zero;
+                }
+                for (size_t i = 0; i < n; ++i)
+                {
+                    Real const* x = W.x.data() + count * i;
+                    Real const* xNext = W.xNext.data() + count * i;
+                    for (size_t s = 0; s < count; ++s)
+                    {
+                        Real error = zero;
+                        for (size_t j = 0; j < 7; ++j)
+                        {
+                            error += T.e[j] * W.K[j][s + count * i];
+                        }
+                        error *= W.h[s];
+                        Real scale = mAbsTolerance + mRelTolerance *
+                            std::max(std::fabs(x[s]), std::fabs(xNext[s]));
+                        Real ratio = error / scale;
+                        W.norm[s] += ratio * ratio;
+                    }
+                }
+
+                // Accept or reject the steps and choose the next step sizes.
+                for (size_t s = 0; s < count; ++s)
+                {
+                    Real h = W.h[s];
+                    Real magnitude = std::fabs(h);
+                    Real norm = std::sqrt(W.norm[s] / (Real)n);
+                    Real factor = GetFactor(norm);
+                    W.accepted[s] = 0;
+                    if (h == zero)
+                    {
+                        continue;
+                    }
+
+                    if (norm <= one || magnitude <= mMinTDelta)
+                    {
+                        W.accepted[s] = 1;
+                        ++W.steps[s];
+                        if (W.isLast[s])
+                        {
+                            W.t[s] = t1;
+                            W.h[s] = zero;
+                            continue;
+                        }
+
+                        W.t[s] += h;
+                        if (W.rejected[s])
+                        {
+                            factor = std::min(factor, one);
+                        }
+                        W.rejected[s] = 0;
+                        magnitude = std::min(std::max(magnitude * factor, mMinTDelta), mMaxTDelta);
+                    }
+                    else
+                    {
+                        W.rejected[s] = 1;
+                        magnitude = std::max(magnitude * factor, mMinTDelta);
+                    }
+
+                    Real left = std::fabs(t1 - W.t[s]);
+                    W.isLast[s] = (magnitude >= left ? 1 : 0);
+                    W.h[s] = sign * (W.isLast[s] ? left : magnitude);
+                    if (left == zero)
+                    {
+                        W.t[s] = t1;
+                        W.h[s] = zero;
+                    }
+                }
+
+                // Replace the states and derivatives of the accepted steps.
+                for (size_t i = 0; i < n; ++i)
+                {
+                    Real* x = W.x.data() + count * i;
+                    Real* k1 = W.K[0].data() + count * i;
+                    Real const* xNext = W.xNext.data() + count * i;
+                    Real const* k7 = W.K[6].data() + count * i;
+                    for (size_t s = 0; s < count; ++s)
+                    {
+                        x[s] = (W.accepted[s] ? xNext[s] : x[s]);
+                        k1[s] = (W.accepted[s] ? k7[s] : k1[s]);
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                std::copy(W.x.data() + count * i, W.x.data() + count * (i + 1),
+                    xSystems + first + numSystems * i);
+            }
+
+            size_t numReached = 0;
+            for (size_t s = 0; s < count; ++s)
+            {
+                if (W.t[s] == t1)
+                {
+                    ++numReached;
+                }
+                if (numSteps)
+                {
+                    numSteps[first + s] = W.steps[s];
+                }
+            }
+            return numReached;
+        }
+
+        static Real GetFactor(Real norm)
+        {
+            Real const minFactor = (Real)0.2, maxFactor = (Real)5;
+            if (norm > (Real)0)
+            {
+                Real factor = (Real)0.9 * std::pow(norm, (Real)-0.2);
+                return std::min(std::max(factor, minFactor), maxFactor);
+            }
+            return (norm == (Real)0 ? maxFactor : minFactor);
+        }
+
+        OdeDormandPrinceTableau<Real> mTableau;
+        int32_t mDimension;
+        Function mFunction;
+        Real mAbsTolerance, mRelTolerance;
+        Real mTDelta, mMinTDelta, mMaxTDelta;
+        size_t mMaxSteps;
+    };
+}
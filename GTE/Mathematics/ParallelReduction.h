@@ -0,0 +1,95 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <vector>
+
+// Reduction of a sequence of terms, for example, the sums of products of
+// the points processed by the fitters, in multiple threads. The index range
+// [0,numElements) is partitioned into one contiguous subrange per thread.
+// Each thread accumulates the terms of its subrange into a partial result,
+// and the partial results are combined pairwise in a tree of depth
+// ceil(log2(numThreads)), where the combinations of each level of the tree
+// are also executed in parallel.
+//
+// The reduction is intended for arbitrary-precision types such as
+// BSRational, where the cost of an addition grows with the sizes of the
+// operands, so a serial accumulation is dominated by the additions of
+// small terms to one large sum. For an exact type the result is the same
+// as that of a serial accumulation. For floating-point types the order of
+// the additions differs from that of a serial accumulation, so the
+// rounding errors differ.
+//
+// The Accumulate functor has the signature
+//   void accumulate(size_t imin, size_t imax, T& partial)
+// and must add the terms for the indices in [imin,imax) to 'partial', which
+// on entry is a copy of 'zero'. The Combine functor has the signature
+//   void combine(T& partial0, T const& partial1)
+// and must add 'partial1' to 'partial0'. The functors are called
+// concurrently from multiple threads, so they must not modify shared
+// state other than their 'partial' arguments.
+
+namespace gte
+{
+    template <typename T>
+    class ParallelReduction
+    {
+    public:
+        // Set numThreads to 0 or 1 to execute in the calling thread. The
+        // number of threads is clamped to numElements so that every thread
+        // has at least one element. The threads are tasks of the scheduler
+        // when it is not null.
+        template <typename Accumulate, typename Combine>
+        static T Execute(size_t numElements, size_t numThreads, T const& zero,
+            Accumulate const& accumulate, Combine const& combine,
+            TaskScheduler* scheduler = nullptr)
+        {
+            T result = zero;
+            numThreads = std::min(numThreads, numElements);
+            if (numThreads <= 1)
+            {
+                if (numElements > 0)
+                {
+                    accumulate(0, numElements, result);
+                }
+                return result;
+            }
+
+            // Compute the partial results. The first numRemaining threads
+            // each have one additional element.
+            std::vector<T> partial(numThreads, zero);
+            size_t const numPerThread = numElements / numThreads;
+            size_t const numRemaining = numElements % numThreads;
+            TaskScheduler::ParallelFor(scheduler, numThreads,
+                [&accumulate, &partial, numPerThread, numRemaining](size_t t)
+                {
+                    size_t imin = t * numPerThread + std::min(t, numRemaining);
+                    size_t imax = imin + numPerThread + (t < numRemaining ? 1 : 0);
+                    accumulate(imin, imax, partial[t]);
+                });
+
+            // Combine the partial results pairwise. At the level with
+            // stride s, partial[i] += partial[i+s] for i a multiple of 2*s.
+            for (size_t stride = 1; stride < numThreads; stride *= 2)
+            {
+                size_t const numPairs = (numThreads - stride + 2 * stride - 1) / (2 * stride);
+                TaskScheduler::ParallelFor(scheduler, numPairs,
+                    [&combine, &partial, stride](size_t k)
+                    {
+                        size_t i = 2 * stride * k;
+                        combine(partial[i], partial[i + stride]);
+                    });
+            }
+
+            result = std::move(partial[0]);
+            return result;
+        }
+    };
+}
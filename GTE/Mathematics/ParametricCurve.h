@@ -3,13 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.03.08
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Integration.h>
 #include <Mathematics/RootsBisection.h>
 #include <Mathematics/Vector.h>
+#include <algorithm>
+#include <limits>
 
 namespace gte
 {
@@ -28,6 +30,8 @@ namespace gte
             mAccumulatedLength(1, (Real)0),
             mRombergOrder(DEFAULT_ROMBERG_ORDER),
             mMaxBisections(DEFAULT_MAX_BISECTIONS),
+            mArcLengthSamples(DEFAULT_ARC_LENGTH_SAMPLES),
+            mArcLengthTolerance((Real)0),
             mConstructed(false)
         {
             mTime[0] = tmin;
@@ -41,6 +45,8 @@ namespace gte
             mAccumulatedLength(numSegments, (Real)0),
             mRombergOrder(DEFAULT_ROMBERG_ORDER),
             mMaxBisections(DEFAULT_MAX_BISECTIONS),
+            mArcLengthSamples(DEFAULT_ARC_LENGTH_SAMPLES),
+            mArcLengthTolerance((Real)0),
             mConstructed(false)
         {
             std::copy(times, times + numSegments + 1, mTime.begin());
@@ -88,6 +94,7 @@ namespace gte
             {
                 mTime[0] = tmin;
                 mTime[1] = tmax;
+                InvalidateArcLengthTable();
             }
         }
 
@@ -98,14 +105,65 @@ namespace gte
         inline void SetRombergOrder(int order)
         {
             mRombergOrder = std::max(order, 1);
+            InvalidateArcLengthTable();
         }
 
-        // The default value is 1024.
+        // The default value is 1024. This is the maximum number of
+        // iterations of the root finder of GetTime(...).
         inline void SetMaxBisections(unsigned int maxBisections)
         {
             mMaxBisections = std::max(maxBisections, 1u);
         }
 
+        // The lengths are computed from a table of arc lengths. The table
+        // times split each segment into the specified number of subsegments
+        // of equal duration, which are bisected until the Romberg estimates
+        // of their lengths are consistent with those of their halves. The
+        // table is computed on the first call to a length function. The
+        // default value is 4.
+        inline void SetArcLengthSamples(int numSamples)
+        {
+            mArcLengthSamples = std::max(numSamples, 1);
+            InvalidateArcLengthTable();
+        }
+
+        inline int GetArcLengthSamples() const
+        {
+            return mArcLengthSamples;
+        }
+
+        // When the tolerance is positive, GetLength(...) and GetTime(...)
+        // interpolate the arc length table by monotone cubic Hermite
+        // polynomials, whose derivatives are the speeds at the table times,
+        // and they take O(log n) time for a table with n subsegments. The
+        // subsegments are bisected until the interpolated length and the
+        // interpolated time at their midpoints are within 'tolerance' of
+        // the integrated values, measured in units of length. When the
+        // tolerance is zero, the default, the lengths and times are refined
+        // by integration, which is accurate to the Romberg estimates.
+        inline void SetArcLengthInterpolation(Real tolerance)
+        {
+            mArcLengthTolerance = std::max(tolerance, (Real)0);
+            InvalidateArcLengthTable();
+        }
+
+        inline Real GetArcLengthInterpolation() const
+        {
+            return mArcLengthTolerance;
+        }
+
+        // The table is recomputed on the next call to a length function.
+        // The curve classes call this when their defining data is modified
+        // through their Set* functions. You must call it when you modify
+        // the defining data some other way, for example, through a pointer
+        // to the control points.
+        inline void InvalidateArcLengthTable()
+        {
+            mTableTime.clear();
+            mTableLength.clear();
+            mTableSpeed.clear();
+        }
+
         // Evaluation of the curve.  The function supports derivative
         // calculation through order 3; that is, order <= 3 is required.  If
         // you want/ only the position, pass in order of 0.  If you want the
@@ -146,126 +204,112 @@ namespace gte
 
         Real GetLength(Real t0, Real t1) const
         {
-            std::function<Real(Real)> speed = [this](Real t)
+            UpdateArcLengthTable();
+            t0 = std::min(std::max(t0, GetTMin()), GetTMax());
+            t1 = std::min(std::max(t1, GetTMin()), GetTMax());
+            if (t0 >= t1)
             {
-                return GetSpeed(t);
-            };
-
-            if (mSegmentLength[0] == (Real)0)
-            {
-                // Lazy initialization of lengths of segments.
-                int const numSegments = static_cast<int>(mSegmentLength.size());
-                Real accumulated = (Real)0;
-                for (int i = 0; i < numSegments; ++i)
-                {
-                    mSegmentLength[i] = Integration<Real>::Romberg(mRombergOrder,
-                        mTime[i], mTime[i + 1], speed);
-                    accumulated += mSegmentLength[i];
-                    mAccumulatedLength[i] = accumulated;
-                }
+                return (Real)0;
             }
 
-            t0 = std::max(t0, GetTMin());
-            t1 = std::min(t1, GetTMax());
-            auto iter0 = std::lower_bound(mTime.begin(), mTime.end(), t0);
-            int index0 = static_cast<int>(iter0 - mTime.begin());
-            auto iter1 = std::lower_bound(mTime.begin(), mTime.end(), t1);
-            int index1 = static_cast<int>(iter1 - mTime.begin());
-
-            Real length;
-            if (index0 < index1)
-            {
-                length = (Real)0;
-                if (t0 < *iter0)
-                {
-                    length += Integration<Real>::Romberg(mRombergOrder, t0,
-                        mTime[index0], speed);
-                }
-
-                int isup;
-                if (t1 < *iter1)
-                {
-                    length += Integration<Real>::Romberg(mRombergOrder,
-                        mTime[index1 - 1], t1, speed);
-                    isup = index1 - 1;
-                }
-                else
-                {
-                    isup = index1;
-                }
-                for (int i = index0; i < isup; ++i)
-                {
-                    length += mSegmentLength[i];
-                }
-            }
-            else
+            size_t k0 = GetTableIndex(t0);
+            size_t k1 = GetTableIndex(t1);
+            if (k0 == k1 && mArcLengthTolerance == (Real)0)
             {
-                length = Integration<Real>::Romberg(mRombergOrder, t0, t1, speed);
+                return Integrate(t0, t1);
             }
-            return length;
+            return GetArcLength(k1, t1) - GetArcLength(k0, t0);
         }
 
         Real GetTotalLength() const
         {
-            if (mAccumulatedLength.back() == (Real)0)
-            {
-                // Lazy evaluation of the accumulated length array.
-                return GetLength(mTime.front(), mTime.back());
-            }
-
-            return mAccumulatedLength.back();
+            UpdateArcLengthTable();
+            return mTableLength.back();
         }
 
         // Inverse mapping of s = Length(t) given by t = Length^{-1}(s).  The
         // inverse length function generally cannot be written in closed form,
         // in which case it is not directly computable.  Instead, we can
         // specify s and estimate the root t for F(t) = Length(t) - s.  The
-        // derivative is F'(t) = Speed(t) >= 0, so F(t) is nondecreasing.  To
-        // be robust, we use bisection to locate the root, although it is
-        // possible to use a hybrid of Newton's method and bisection.  For
+        // derivative is F'(t) = Speed(t) >= 0, so F(t) is nondecreasing.  For
         // details, see the document
         // https://www.geometrictools.com/Documentation/MovingAlongCurveSpecifiedSpeed.pdf
+        // The arc length table provides the subsegment that contains the
+        // root and an initial estimate from Hermite interpolation of the
+        // inverse function. Unless SetArcLengthInterpolation was called with
+        // a positive tolerance, the estimate is refined by Newton's method,
+        // safeguarded by bisection, where F is evaluated by integrating the
+        // speed from the start of the subsegment.
         Real GetTime(Real length) const
         {
-            if (length > (Real)0)
+            if (length <= (Real)0)
+            {
+                return mTime.front();
+            }
+
+            UpdateArcLengthTable();
+            if (length >= mTableLength.back())
+            {
+                return mTime.back();
+            }
+
+            auto iter = std::upper_bound(mTableLength.begin(), mTableLength.end(), length);
+            size_t k = static_cast<size_t>(iter - mTableLength.begin()) - 1;
+            Real tmin = mTableTime[k], tmax = mTableTime[k + 1];
+            Real smin = mTableLength[k], smax = mTableLength[k + 1];
+            if (length - smin <= (Real)0)
             {
-                if (length < GetTotalLength())
+                return tmin;
+            }
+
+            // Hermite interpolation of t(s) with dt/ds = 1/Speed(t).
+            Real t = InterpolateTime(smin, smax, tmin, tmax, mTableSpeed[k],
+                mTableSpeed[k + 1], length);
+            if (mArcLengthTolerance > (Real)0)
+            {
+                return t;
+            }
+            if (!(tmin < t && t < tmax))
+            {
+                t = tmin + (length - smin) / (smax - smin) * (tmax - tmin);
+            }
+
+            Real const epsilon = (Real)4 * std::numeric_limits<Real>::epsilon() *
+                std::max(std::max(std::fabs(mTime.front()), std::fabs(mTime.back())), (Real)1);
+            for (unsigned int i = 0; i < mMaxBisections; ++i)
+            {
+                Real integral = Integrate(tmin, t);
+                Real f = integral - (length - smin);
+                if (f == (Real)0)
                 {
-                    std::function<Real(Real)> F = [this, &length](Real t)
-                    {
-                        return Integration<Real>::Romberg(mRombergOrder,
-                            mTime.front(), t, [this](Real z) { return GetSpeed(z); })
-                            - length;
-                    };
-
-                    // We know that F(tmin) < 0 and F(tmax) > 0, which allows us to
-                    // use bisection.  Rather than bisect the entire interval, let's
-                    // narrow it down with a reasonable initial guess.
-                    Real ratio = length / GetTotalLength();
-                    Real omratio = (Real)1 - ratio;
-                    Real tmid = omratio * mTime.front() + ratio * mTime.back();
-                    Real fmid = F(tmid);
-                    if (fmid > (Real)0)
-                    {
-                        RootsBisection<Real>::Find(F, mTime.front(), tmid, (Real)-1,
-                            (Real)1, mMaxBisections, tmid);
-                    }
-                    else if (fmid < (Real)0)
-                    {
-                        RootsBisection<Real>::Find(F, tmid, mTime.back(), (Real)-1,
-                            (Real)1, mMaxBisections, tmid);
-                    }
-                    return tmid;
+                    break;
+                }
+
+                if (f < (Real)0)
+                {
+                    smin += integral;
+                    tmin = t;
                 }
                 else
                 {
-                    return mTime.back();
+                    tmax = t;
                 }
+
+                Real speed = GetSpeed(t);
+                Real tNext = (speed > (Real)0 ? t - f / speed : tmin);
+                if (!(tmin < tNext && tNext < tmax))
+                {
+                    tNext = (Real)0.5 * (tmin + tmax);
+                }
+
+                if (std::fabs(tNext - t) <= epsilon || tmax - tmin <= epsilon)
+                {
+                    t = tNext;
+                    break;
+                }
+                t = tNext;
             }
-            else
-            {
-                return mTime.front();
-            }
+            return t;
         }
 
         // Compute a subset of curve points according to the specified attribute.
@@ -295,14 +339,241 @@ namespace gte
         enum
         {
             DEFAULT_ROMBERG_ORDER = 8,
-            DEFAULT_MAX_BISECTIONS = 1024
+            DEFAULT_MAX_BISECTIONS = 1024,
+            DEFAULT_ARC_LENGTH_SAMPLES = 4,
+            MAX_ARC_LENGTH_BISECTIONS = 16
         };
 
+        Real Integrate(Real t0, Real t1) const
+        {
+            return Integration<Real>::Romberg(mRombergOrder, t0, t1,
+                [this](Real t) { return GetSpeed(t); });
+        }
+
+        // The index k of the table subsegment [mTableTime[k],mTableTime[k+1])
+        // that contains t, where t in [tmin,tmax].
+        size_t GetTableIndex(Real t) const
+        {
+            auto iter = std::upper_bound(mTableTime.begin(), mTableTime.end(), t);
+            size_t k = static_cast<size_t>(iter - mTableTime.begin());
+            return std::min(std::max(k, static_cast<size_t>(1)), mTableTime.size() - 1) - 1;
+        }
+
+        Real GetArcLength(size_t k, Real t) const
+        {
+            if (t <= mTableTime[k])
+            {
+                return mTableLength[k];
+            }
+
+            if (mArcLengthTolerance > (Real)0)
+            {
+                return Interpolate(mTableTime[k], mTableTime[k + 1], mTableLength[k],
+                    mTableLength[k + 1], mTableSpeed[k], mTableSpeed[k + 1], t);
+            }
+            return mTableLength[k] + Integrate(mTableTime[k], t);
+        }
+
+        // Monotone cubic Hermite interpolation of y(x) on [x0,x1], where
+        // y0 <= y1 and the derivatives d0 and d1 are nonnegative. The
+        // derivatives are scaled so that the interpolant is nondecreasing
+        // (Fritsch and Carlson).
+        static Real Interpolate(Real x0, Real x1, Real y0, Real y1, Real d0, Real d1, Real x)
+        {
+            Real h = x1 - x0, dy = y1 - y0;
+            if (h <= (Real)0)
+            {
+                return y0;
+            }
+
+            Real u = std::min(std::max((x - x0) / h, (Real)0), (Real)1);
+            Real m0 = d0 * h, m1 = d1 * h;
+            Real sqrLength = m0 * m0 + m1 * m1;
+            if (sqrLength > (Real)9 * dy * dy)
+            {
+                Real tau = (Real)3 * dy / std::sqrt(sqrLength);
+                m0 *= tau;
+                m1 *= tau;
+            }
+
+            Real omu = (Real)1 - u;
+            return omu * omu * (((Real)1 + (Real)2 * u) * y0 + u * m0) +
+                u * u * (((Real)3 - (Real)2 * u) * y1 - omu * m1);
+        }
+
+        // Interpolation of the inverse t(s) on [s0,s1] with derivatives
+        // dt/ds = 1/speed. A zero speed has an infinite derivative, which is
+        // clamped to 3 times the secant slope, the largest value for which
+        // the interpolant is monotone.
+        static Real InterpolateTime(Real s0, Real s1, Real t0, Real t1, Real v0, Real v1, Real s)
+        {
+            Real ds = s1 - s0, dt = t1 - t0;
+            if (ds <= (Real)0)
+            {
+                return t0;
+            }
+
+            Real d0 = ((Real)3 * dt * v0 > ds ? (Real)1 / v0 : (Real)3 * dt / ds);
+            Real d1 = ((Real)3 * dt * v1 > ds ? (Real)1 / v1 : (Real)3 * dt / ds);
+            return Interpolate(s0, s1, t0, t1, d0, d1, s);
+        }
+
+        void UpdateArcLengthTable() const
+        {
+            if (!mTableTime.empty())
+            {
+                return;
+            }
+
+            // Start with the subsegments of equal duration and bisect each
+            // subsegment until the sum of the lengths of its halves agrees
+            // with its length. The lengths of the subsegments of a level are
+            // computed in one batch.
+            struct Interval
+            {
+                Real t0, t1, length;
+            };
+
+            size_t const numSegments = mSegmentLength.size();
+            size_t const numSamples = static_cast<size_t>(mArcLengthSamples);
+            std::vector<Interval> pending(numSegments * numSamples);
+            for (size_t i = 0, k = 0; i < numSegments; ++i)
+            {
+                Real delta = (mTime[i + 1] - mTime[i]) / (Real)numSamples;
+                for (size_t j = 0; j < numSamples; ++j, ++k)
+                {
+                    pending[k].t0 = mTime[i] + delta * (Real)j;
+                    pending[k].t1 = (j + 1 < numSamples ? mTime[i] + delta * (Real)(j + 1) : mTime[i + 1]);
+                }
+            }
+
+            std::vector<Real> t0(pending.size()), t1(pending.size()), lengths(pending.size());
+            for (size_t k = 0; k < pending.size(); ++k)
+            {
+                t0[k] = pending[k].t0;
+                t1[k] = pending[k].t1;
+            }
+            IntegrateBatch(t0, t1, lengths);
+            for (size_t k = 0; k < pending.size(); ++k)
+            {
+                pending[k].length = lengths[k];
+            }
+
+            Real const tolerance = std::sqrt(std::numeric_limits<Real>::epsilon());
+            std::vector<Interval> accepted, next;
+            for (int level = 0; !pending.empty(); ++level)
+            {
+                size_t const numPending = pending.size();
+                t0.resize(2 * numPending);
+                t1.resize(2 * numPending);
+                lengths.resize(2 * numPending);
+                for (size_t k = 0; k < numPending; ++k)
+                {
+                    Real tmid = (Real)0.5 * (pending[k].t0 + pending[k].t1);
+                    t0[2 * k] = pending[k].t0;
+                    t1[2 * k] = tmid;
+                    t0[2 * k + 1] = tmid;
+                    t1[2 * k + 1] = pending[k].t1;
+                }
+                IntegrateBatch(t0, t1, lengths);
+
+                next.clear();
+                for (size_t k = 0; k < numPending; ++k)
+                {
+                    Interval left{ t0[2 * k], t1[2 * k], lengths[2 * k] };
+                    Interval right{ t0[2 * k + 1], t1[2 * k + 1], lengths[2 * k + 1] };
+                    Real sum = left.length + right.length;
+                    if ((std::fabs(pending[k].length - sum) <= tolerance * sum &&
+                        IsInterpolationAccurate(left, right)) ||
+                        level == MAX_ARC_LENGTH_BISECTIONS)
+                    {
+                        accepted.push_back(left);
+                        accepted.push_back(right);
+                    }
+                    else
+                    {
+                        next.push_back(left);
+                        next.push_back(right);
+                    }
+                }
+                std::swap(pending, next);
+            }
+
+            std::sort(accepted.begin(), accepted.end(),
+                [](Interval const& i0, Interval const& i1) { return i0.t0 < i1.t0; });
+
+            size_t const numIntervals = accepted.size();
+            mTableTime.resize(numIntervals + 1);
+            mTableLength.resize(numIntervals + 1);
+            mTableSpeed.resize(numIntervals + 1);
+            mTableLength[0] = (Real)0;
+            for (size_t k = 0; k < numIntervals; ++k)
+            {
+                mTableTime[k] = accepted[k].t0;
+                mTableLength[k + 1] = mTableLength[k] + accepted[k].length;
+                mTableSpeed[k] = GetSpeed(mTableTime[k]);
+            }
+            mTableTime.back() = mTime.back();
+            mTableSpeed.back() = GetSpeed(mTableTime.back());
+
+            // The segment times are table times.
+            size_t k0 = 0;
+            for (size_t i = 0; i < numSegments; ++i)
+            {
+                auto iter = std::lower_bound(mTableTime.begin() + k0, mTableTime.end(), mTime[i + 1]);
+                size_t k1 = static_cast<size_t>(iter - mTableTime.begin());
+                mSegmentLength[i] = mTableLength[k1] - mTableLength[k0];
+                mAccumulatedLength[i] = mTableLength[k1];
+                k0 = k1;
+            }
+        }
+
+        // Test whether the Hermite interpolants of s(t) and t(s) on the union
+        // of two adjacent intervals are accurate at their common endpoint.
+        template <typename Interval>
+        bool IsInterpolationAccurate(Interval const& left, Interval const& right) const
+        {
+            if (mArcLengthTolerance == (Real)0)
+            {
+                return true;
+            }
+
+            Real v0 = GetSpeed(left.t0), vmid = GetSpeed(left.t1), v1 = GetSpeed(right.t1);
+            Real sum = left.length + right.length;
+            Real length = Interpolate(left.t0, right.t1, (Real)0, sum, v0, v1, left.t1);
+            Real time = InterpolateTime((Real)0, sum, left.t0, right.t1, v0, v1, left.length);
+            return std::fabs(length - left.length) <= mArcLengthTolerance
+                && std::fabs(time - left.t1) * vmid <= mArcLengthTolerance;
+        }
+
+        void IntegrateBatch(std::vector<Real> const& t0, std::vector<Real> const& t1,
+            std::vector<Real>& lengths) const
+        {
+            Integration<Real>::Romberg(mRombergOrder, t0.size(), t0.data(), t1.data(),
+                [this](size_t numPoints, Real const* t, Real* speed)
+                {
+                    for (size_t i = 0; i < numPoints; ++i)
+                    {
+                        speed[i] = GetSpeed(t[i]);
+                    }
+                },
+                lengths.data());
+        }
+
         std::vector<Real> mTime;
         mutable std::vector<Real> mSegmentLength;
         mutable std::vector<Real> mAccumulatedLength;
         int mRombergOrder;
         unsigned int mMaxBisections;
+        int mArcLengthSamples;
+        Real mArcLengthTolerance;
         bool mConstructed;
+
+        // The arc length table: mTableLength[k] is the length of the curve
+        // on [tmin,mTableTime[k]] and mTableSpeed[k] is the speed at
+        // mTableTime[k].
+        mutable std::vector<Real> mTableTime;
+        mutable std::vector<Real> mTableLength;
+        mutable std::vector<Real> mTableSpeed;
     };
 }
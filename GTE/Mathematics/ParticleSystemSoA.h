@@ -0,0 +1,288 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// A particle system with the Runge-Kutta fourth-order solver of
+// ParticleSystem for large numbers of particles. The differences are
+//   1. The positions and velocities are stored as structure of arrays, one
+//      array per coordinate.
+//   2. The accelerations are computed for blocks of consecutive particles
+//      by Derived::Acceleration, which is called through the curiously
+//      recurring template pattern (CRTP) rather than a virtual function
+//      per particle. The loops over the particles of a block have no
+//      virtual calls, so the compiler can inline and vectorize them.
+//   3. When a TaskScheduler is passed to Update, the blocks are processed
+//      by its threads. Each stage of the solver is one parallel pass over
+//      the blocks, and the stages read and write different temporary
+//      arrays, so the blocks of a pass are independent.
+// The class Derived must have a member function
+//   void Acceleration(int imin, int imax, Real time,
+//       std::array<Real const*, N> const& position,
+//       std::array<Real const*, N> const& velocity,
+//       std::array<Real*, N> const& acceleration);
+// that sets acceleration[d][i] for 0 <= d < N and imin <= i < imax. The
+// function is called concurrently for disjoint blocks. The results are
+// those of ParticleSystem up to rounding errors.
+
+namespace gte
+{
+    template <int N, typename Real, typename Derived>
+    class ParticleSystemSoA
+    {
+    public:
+        // Construction. If a particle is to be immovable, set its mass to
+        // std::numeric_limits<Real>::max().
+        ParticleSystemSoA(int numParticles, Real step)
+            :
+            mNumParticles(numParticles),
+            mMass(numParticles, (Real)0),
+            mInvMass(numParticles, (Real)0),
+            mStep(step),
+            mHalfStep(step / (Real)2),
+            mSixthStep(step / (Real)6)
+        {
+            size_t const size = static_cast<size_t>(numParticles);
+            for (int d = 0; d < N; ++d)
+            {
+                mPosition[d].resize(size, (Real)0);
+                mVelocity[d].resize(size, (Real)0);
+                mPTmp[0][d].resize(size, (Real)0);
+                mPTmp[1][d].resize(size, (Real)0);
+                mVTmp[0][d].resize(size, (Real)0);
+                mVTmp[1][d].resize(size, (Real)0);
+                mPSum[d].resize(size, (Real)0);
+                mVSum[d].resize(size, (Real)0);
+                mAcceleration[d].resize(size, (Real)0);
+            }
+        }
+
+        // Member access.
+        inline int GetNumParticles() const
+        {
+            return mNumParticles;
+        }
+
+        void SetMass(int i, Real mass)
+        {
+            if ((Real)0 < mass && mass < std::numeric_limits<Real>::max())
+            {
+                mMass[i] = mass;
+                mInvMass[i] = (Real)1 / mass;
+            }
+            else
+            {
+                mMass[i] = std::numeric_limits<Real>::max();
+                mInvMass[i] = (Real)0;
+            }
+        }
+
+        void SetPosition(int i, Vector<N, Real> const& position)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                mPosition[d][i] = position[d];
+            }
+        }
+
+        void SetVelocity(int i, Vector<N, Real> const& velocity)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                mVelocity[d][i] = velocity[d];
+            }
+        }
+
+        void SetStep(Real step)
+        {
+            mStep = step;
+            mHalfStep = mStep / (Real)2;
+            mSixthStep = mStep / (Real)6;
+        }
+
+        inline Real const& GetMass(int i) const
+        {
+            return mMass[i];
+        }
+
+        Vector<N, Real> GetPosition(int i) const
+        {
+            Vector<N, Real> position;
+            for (int d = 0; d < N; ++d)
+            {
+                position[d] = mPosition[d][i];
+            }
+            return position;
+        }
+
+        Vector<N, Real> GetVelocity(int i) const
+        {
+            Vector<N, Real> velocity;
+            for (int d = 0; d < N; ++d)
+            {
+                velocity[d] = mVelocity[d][i];
+            }
+            return velocity;
+        }
+
+        inline Real GetStep() const
+        {
+            return mStep;
+        }
+
+        // The coordinate arrays, GetPositions()[d][i] is coordinate d of
+        // particle i, for example to copy to a vertex buffer.
+        inline std::array<std::vector<Real>, N> const& GetPositions() const
+        {
+            return mPosition;
+        }
+
+        inline std::array<std::vector<Real>, N> const& GetVelocities() const
+        {
+            return mVelocity;
+        }
+
+        // Update the particle positions based on current time and particle
+        // state. The blocks of particles are processed by the threads of
+        // the scheduler when it is not null.
+        void Update(Real time, TaskScheduler* scheduler = nullptr)
+        {
+            // Runge-Kutta fourth-order solver.
+            Real const halfTime = time + mHalfStep;
+            Real const fullTime = time + mStep;
+            Stage(scheduler, 0, time);
+            Stage(scheduler, 1, halfTime);
+            Stage(scheduler, 2, halfTime);
+            Stage(scheduler, 3, fullTime);
+        }
+
+    protected:
+        // Add the accelerations of the springs from particle i to particle
+        // i + offset, for imin <= i < imax, where the spring of particle i
+        // has constant[i + shift] and resting length length[i + shift].
+        void AddSpringAccelerations(int imin, int imax, int offset, int shift,
+            Real const* constant, Real const* length,
+            std::array<Real const*, N> const& position,
+            std::array<Real*, N> const& acceleration) const
+        {
+            Real const* invMass = mInvMass.data();
+            for (int i = imin; i < imax; ++i)
+            {
+                std::array<Real, N> diff;
+                Real sqrLength = (Real)0;
+                for (int d = 0; d < N; ++d)
+                {
+                    diff[d] = position[d][i + offset] - position[d][i];
+                    sqrLength += diff[d] * diff[d];
+                }
+
+                Real const scale = invMass[i] * constant[i + shift] *
+                    ((Real)1 - length[i + shift] / std::sqrt(sqrLength));
+                for (int d = 0; d < N; ++d)
+                {
+                    acceleration[d][i] += scale * diff[d];
+                }
+            }
+        }
+
+        int mNumParticles;
+        std::vector<Real> mMass, mInvMass;
+        std::array<std::vector<Real>, N> mPosition, mVelocity;
+        Real mStep, mHalfStep, mSixthStep;
+
+    private:
+        // Stage k of the solver evaluates the derivatives at the state
+        // written by stage k-1, or at the current state for k = 0, and
+        // writes the state at which stage k+1 evaluates them. The weighted
+        // sums of the derivatives are accumulated, and stage 3 updates the
+        // current state.
+        void Stage(TaskScheduler* scheduler, int stage, Real time)
+        {
+            std::array<Real const*, N> pIn, vIn;
+            std::array<Real*, N> pOut, vOut, acceleration;
+            for (int d = 0; d < N; ++d)
+            {
+                pIn[d] = (stage == 0 ? mPosition[d].data() : mPTmp[(stage + 1) % 2][d].data());
+                vIn[d] = (stage == 0 ? mVelocity[d].data() : mVTmp[(stage + 1) % 2][d].data());
+                pOut[d] = mPTmp[stage % 2][d].data();
+                vOut[d] = mVTmp[stage % 2][d].data();
+                acceleration[d] = mAcceleration[d].data();
+            }
+            Real const step = (stage < 2 ? mHalfStep : mStep);
+
+            size_t const numParticles = static_cast<size_t>(mNumParticles);
+            size_t const numBlocks = (scheduler ?
+                std::max(std::min(numParticles / msMinBlockSize, 4 * scheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+
+            TaskScheduler::ParallelFor(scheduler, numBlocks,
+                [this, stage, time, step, numParticles, numBlocks, &pIn, &vIn, &pOut, &vOut,
+                &acceleration](size_t block)
+                {
+                    int const imin = static_cast<int>(numParticles * block / numBlocks);
+                    int const imax = static_cast<int>(numParticles * (block + 1) / numBlocks);
+                    static_cast<Derived*>(this)->Acceleration(imin, imax, time, pIn, vIn,
+                        acceleration);
+
+                    Real const zero = (Real)0, two = (Real)2;
+                    Real const* invMass = mInvMass.data();
+                    for (int d = 0; d < N; ++d)
+                    {
+                        Real* position = mPosition[d].data();
+                        Real* velocity = mVelocity[d].data();
+                        Real* pSum = mPSum[d].data();
+                        Real* vSum = mVSum[d].data();
+                        Real const* vCurrent = vIn[d];
+                        Real const* aCurrent = acceleration[d];
+                        if (stage < 3)
+                        {
+                            Real* pNext = pOut[d];
+                            Real* vNext = vOut[d];
+                            for (int i = imin; i < imax; ++i)
+                            {
+                                // Immovable particles have zero derivatives.
+                                bool const movable = (invMass[i] > zero);
+                                Real const dP = (movable ? vCurrent[i] : zero);
+                                Real const dV = (movable ? aCurrent[i] : zero);
+                                pSum[i] = (stage == 0 ? dP : pSum[i] + two * dP);
+                                vSum[i] = (stage == 0 ? dV : vSum[i] + two * dV);
+                                pNext[i] = position[i] + step * dP;
+                                vNext[i] = (movable ? velocity[i] + step * dV : zero);
+                            }
+                        }
+                        else
+                        {
+                            for (int i = imin; i < imax; ++i)
+                            {
+                                bool const movable = (invMass[i] > zero);
+                                Real const dP = (movable ? vCurrent[i] : zero);
+                                Real const dV = (movable ? aCurrent[i] : zero);
+                                position[i] += mSixthStep * (pSum[i] + dP);
+                                velocity[i] += mSixthStep * (vSum[i] + dV);
+                            }
+                        }
+                    }
+                });
+        }
+
+        // The smallest number of particles of a block for multithreading.
+        static size_t constexpr msMinBlockSize = 1024;
+
+        // Temporary storage for the Runge-Kutta differential equation
+        // solver. The stages alternate between the two intermediate states.
+        std::array<std::array<std::vector<Real>, N>, 2> mPTmp, mVTmp;
+        std::array<std::vector<Real>, N> mPSum, mVSum, mAcceleration;
+    };
+}
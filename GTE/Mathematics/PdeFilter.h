@@ -3,10 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
 namespace gte
 {
     template <typename Real>
@@ -63,6 +68,37 @@ namespace gte
             return mTimeStep;
         }
 
+        // The number of threads for OnUpdate of the 2D and 3D classes, which
+        // update the rows (2D) or slices (3D) in parallel. The default is 1.
+        // The updates of the filters in this library write only their own
+        // elements of the destination buffer, so they are thread safe. A
+        // derived class whose OnUpdateSingle modifies other members, for
+        // example, by calling the LookUp* functions without a Neighborhood
+        // parameter, must use 1 thread.
+        inline void SetNumThreads(size_t numThreads)
+        {
+            mNumThreads = std::max(numThreads, static_cast<size_t>(1));
+        }
+
+        inline size_t GetNumThreads() const
+        {
+            return mNumThreads;
+        }
+
+        // Execute the updates as tasks of the scheduler, which can be shared
+        // with other computations, instead of creating threads for each
+        // call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // This function executes one iteration of the filter.  It calls
         // OnPreUpdate, OnUpdate and OnPostUpdate, in that order.
         void Update()
@@ -78,7 +114,9 @@ namespace gte
             mQuantity(quantity),
             mBorderValue(borderValue),
             mScaleType(scaleType),
-            mTimeStep(0)
+            mTimeStep(0),
+            mNumThreads(1),
+            mScheduler(nullptr)
         {
             Real maxValue = data[0];
             mMin = maxValue;
@@ -142,6 +180,29 @@ namespace gte
         // OnPostUpdate last. 
         virtual void OnPostUpdate() = 0;
 
+        // Execute function(first,last) for the subranges [first,last) of
+        // [begin,end), where mNumThreads threads fetch subranges of
+        // blockSize items from an atomic counter.
+        template <typename Function>
+        void Execute(int begin, int end, Function const& function, int blockSize = 1) const
+        {
+            int const numBlocks = (end - begin + blockSize - 1) / blockSize;
+            size_t const numThreads = std::min(mNumThreads, static_cast<size_t>(std::max(numBlocks, 0)));
+            if (numThreads <= 1)
+            {
+                function(begin, end);
+                return;
+            }
+
+            TaskScheduler::ParallelForDynamic(mScheduler, static_cast<size_t>(numBlocks), numThreads,
+                [&function, begin, end, blockSize](size_t b)
+                {
+                    int const block = static_cast<int>(b);
+                    int const first = begin + block * blockSize;
+                    function(first, std::min(first + blockSize, end));
+                });
+        }
+
         // The number of image elements.
         int mQuantity;
 
@@ -160,5 +221,9 @@ namespace gte
         // depends on the magnitude of the time step, but the magnitude itself
         // depends on the algorithm.
         Real mTimeStep;
+
+        // The number of threads for the updates.
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -411,18 +411,34 @@ namespace gte
 
         // Iterate over all the pixels and call OnUpdate(x,y) for each pixel
         // that is not masked out.
+        // The rows are updated in parallel when GetNumThreads() > 1. The mask
+        // test is not in the loop when there is no mask.
         virtual void OnUpdate() override
         {
-            for (int y = 1; y <= mYBound; ++y)
+            this->Execute(1, mYBound + 1, [this](int yBegin, int yEnd)
             {
-                for (int x = 1; x <= mXBound; ++x)
+                for (int y = yBegin; y < yEnd; ++y)
                 {
-                    if (!mHasMask || mMask[y][x])
+                    if (mHasMask)
+                    {
+                        int const* mask = mMask[y];
+                        for (int x = 1; x <= mXBound; ++x)
+                        {
+                            if (mask[x])
+                            {
+                                OnUpdateSingle(x, y);
+                            }
+                        }
+                    }
+                    else
                     {
-                        OnUpdateSingle(x, y);
+                        for (int x = 1; x <= mXBound; ++x)
+                        {
+                            OnUpdateSingle(x, y);
+                        }
                     }
                 }
-            }
+            });
         }
 
         // If a derived class overrides this, it must call the base-class
@@ -438,6 +454,46 @@ namespace gte
         // 1 <= y <= ybound.
         virtual void OnUpdateSingle(int x, int y) = 0;
 
+        // A 3x3 neighborhood. In the notation xy, the x and y indices are in
+        // {m,z,p}, referring to subtract 1 (m), no change (z), or add 1 (p)
+        // to the appropriate index.
+        struct Neighborhood
+        {
+            Real mm, zm, pm;
+            Real mz, zz, pz;
+            Real mp, zp, pp;
+        };
+
+        // Copy source data to a neighborhood. These are thread safe. LookUp5
+        // assigns only zm, mz, zz, pz and zp.
+        void LookUp5(int x, int y, Neighborhood& u) const
+        {
+            auto const& F = mBuffer[mSrc];
+            int xm = x - 1, xp = x + 1;
+            int ym = y - 1, yp = y + 1;
+            u.zm = F[ym][x];
+            u.mz = F[y][xm];
+            u.zz = F[y][x];
+            u.pz = F[y][xp];
+            u.zp = F[yp][x];
+        }
+
+        void LookUp9(int x, int y, Neighborhood& u) const
+        {
+            auto const& F = mBuffer[mSrc];
+            int xm = x - 1, xp = x + 1;
+            int ym = y - 1, yp = y + 1;
+            u.mm = F[ym][xm];
+            u.zm = F[ym][x];
+            u.pm = F[ym][xp];
+            u.mz = F[y][xm];
+            u.zz = F[y][x];
+            u.pz = F[y][xp];
+            u.mp = F[yp][xm];
+            u.zp = F[yp][x];
+            u.pp = F[yp][xp];
+        }
+
         // Copy source data to temporary storage.
         void LookUp5(int x, int y)
         {
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.11
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -830,21 +830,37 @@ namespace gte
 
         // Iterate over all the pixels and call OnUpdate(x,y,z) for each voxel
         // that is not masked out.
+        // The slices are updated in parallel when GetNumThreads() > 1. The
+        // mask test is not in the loop when there is no mask.
         virtual void OnUpdate() override
         {
-            for (int z = 1; z <= mZBound; ++z)
+            this->Execute(1, mZBound + 1, [this](int zBegin, int zEnd)
             {
-                for (int y = 1; y <= mYBound; ++y)
+                for (int z = zBegin; z < zEnd; ++z)
                 {
-                    for (int x = 1; x <= mXBound; ++x)
+                    for (int y = 1; y <= mYBound; ++y)
                     {
-                        if (!mHasMask || mMask[z][y][x])
+                        if (mHasMask)
+                        {
+                            int const* mask = mMask[z][y];
+                            for (int x = 1; x <= mXBound; ++x)
+                            {
+                                if (mask[x])
+                                {
+                                    OnUpdateSingle(x, y, z);
+                                }
+                            }
+                        }
+                        else
                         {
-                            OnUpdateSingle(x, y, z);
+                            for (int x = 1; x <= mXBound; ++x)
+                            {
+                                OnUpdateSingle(x, y, z);
+                            }
                         }
                     }
                 }
-            }
+            });
         }
 
         // If a derived class overrides this, it must call the base-class
@@ -860,6 +876,74 @@ namespace gte
         // and 1 <= z <= zbound.
         virtual void OnUpdateSingle(int x, int y, int z) = 0;
 
+        // A 3x3x3 neighborhood. In the notation xyz, the x, y and z indices
+        // are in {m,z,p}, referring to subtract 1 (m), no change (z), or add
+        // 1 (p) to the appropriate index.
+        struct Neighborhood
+        {
+            Real mmm, zmm, pmm;
+            Real mzm, zzm, pzm;
+            Real mpm, zpm, ppm;
+            Real mmz, zmz, pmz;
+            Real mzz, zzz, pzz;
+            Real mpz, zpz, ppz;
+            Real mmp, zmp, pmp;
+            Real mzp, zzp, pzp;
+            Real mpp, zpp, ppp;
+        };
+
+        // Copy source data to a neighborhood. These are thread safe. LookUp7
+        // assigns only zzm, zmz, mzz, zzz, pzz, zpz and zzp.
+        void LookUp7(int x, int y, int z, Neighborhood& u) const
+        {
+            auto const& F = mBuffer[mSrc];
+            int xm = x - 1, xp = x + 1;
+            int ym = y - 1, yp = y + 1;
+            int zm = z - 1, zp = z + 1;
+            u.zzm = F[zm][y][x];
+            u.zmz = F[z][ym][x];
+            u.mzz = F[z][y][xm];
+            u.zzz = F[z][y][x];
+            u.pzz = F[z][y][xp];
+            u.zpz = F[z][yp][x];
+            u.zzp = F[zp][y][x];
+        }
+
+        void LookUp27(int x, int y, int z, Neighborhood& u) const
+        {
+            auto const& F = mBuffer[mSrc];
+            int xm = x - 1, xp = x + 1;
+            int ym = y - 1, yp = y + 1;
+            int zm = z - 1, zp = z + 1;
+            u.mmm = F[zm][ym][xm];
+            u.zmm = F[zm][ym][x];
+            u.pmm = F[zm][ym][xp];
+            u.mzm = F[zm][y][xm];
+            u.zzm = F[zm][y][x];
+            u.pzm = F[zm][y][xp];
+            u.mpm = F[zm][yp][xm];
+            u.zpm = F[zm][yp][x];
+            u.ppm = F[zm][yp][xp];
+            u.mmz = F[z][ym][xm];
+            u.zmz = F[z][ym][x];
+            u.pmz = F[z][ym][xp];
+            u.mzz = F[z][y][xm];
+            u.zzz = F[z][y][x];
+            u.pzz = F[z][y][xp];
+            u.mpz = F[z][yp][xm];
+            u.zpz = F[z][yp][x];
+            u.ppz = F[z][yp][xp];
+            u.mmp = F[zp][ym][xm];
+            u.zmp = F[zp][ym][x];
+            u.pmp = F[zp][ym][xp];
+            u.mzp = F[zp][y][xm];
+            u.zzp = F[zp][y][x];
+            u.pzp = F[zp][y][xp];
+            u.mpp = F[zp][yp][xm];
+            u.zpp = F[zp][yp][x];
+            u.ppp = F[zp][yp][xp];
+        }
+
         // Copy source data to temporary storage.
         void LookUp7(int x, int y, int z)
         {
@@ -3,37 +3,36 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <Mathematics/AlignedBox.h>
 #include <Mathematics/ContPointInPolygon2.h>
 #include <Mathematics/ETManifoldMesh.h>
 #include <Mathematics/PrimalQuery2.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
 
 // The planar mesh class is convenient for many applications involving
-// searches for triangles containing a specified point.  A couple of
-// issues can show up in practice when the input data to the constructors
-// is very large (number of triangles on the order of 10^5 or larger).
+// searches for triangles containing a specified point.
 //
-// The first constructor builds an ETManifoldMesh mesh that contains
-// std::map objects.  When such maps are large, the amount of time it
-// takes to delete them is enormous.  Although you can control the level
-// of debug support in MSVS 2013 (see _ITERATOR_DEBUG_LEVEL), turning off
-// checking might very well affect other classes for which you want
-// iterator checking to be on.  An alternative to reduce debugging time
-// is to dynamically allocate the PlanarMesh object in the main thread but
-// then launch another thread to delete the object and avoid stalling
-// the main thread.  For example,
-//
-//    PlanarMesh<IT,CT,RT>* pmesh =
-//        new PlanarMesh<IT,CT,RT>(numV, vertices, numT, indices);
-//    <make various calls to pmesh>;
-//    std::thread deleter = [pmesh](){ delete pmesh; };
-//    deleter.detach();  // Do not wait for the thread to finish.
-//
-// The second constructor has the mesh passed in, but mTriIndexMap is used
-// in both constructors and can take time to delete.
+// The triangle adjacencies are computed by sorting the edges of the
+// triangles, not by building an ETManifoldMesh object, which is slow to
+// create and to delete for meshes with 10^5 or more triangles. The
+// constructors also build a point-location index, which is a uniform grid
+// over the bounding box of the triangles with approximately one cell per
+// triangle. Each cell stores the triangles whose bounding boxes overlap
+// the cell, so GetContainingTriangle(P) tests only the few triangles of
+// the cell containing P. The grid search is correct for nonconvex meshes,
+// and the batch queries GetContainingTriangles and GetBarycentrics process
+// the points in numThreads threads. The constructors convert the vertices,
+// sort the edges and bound the triangles in numThreads threads.
 //
 // The input mesh should be consistently oriented, say, the triangles are
 // counterclockwise ordered.  The vertices should be consistent with this
@@ -41,37 +40,30 @@
 // vertices can cause apparent fold-over of the mesh; that is, theoretically
 // the vertex geometry supports counterclockwise geometry but numerical
 // errors cause an inconsistency.  This can manifest in the mQuery.ToLine
-// tests whereby cycles of triangles occur in the linear walk.  When cycles
-// occur, GetContainingTriangle(P,startTriangle) will iterate numTriangle
-// times before reporting that the triangle cannot be found, which is a
-// very slow process (in debug or release builds).  The function
-// GetContainingTriangle(P,startTriangle,visited) is provided to avoid the
-// performance loss, trapping a cycle the first time and exiting, but
-// again reporting that the triangle cannot be found.  If you know that the
-// query should be (theoretically) successful, use the second version of
-// GetContainingTriangle.  If it fails by returning -1, then perform an
-// exhaustive search over the triangles.  For example,
+// tests whereby cycles of triangles occur in the linear walk of
+// GetContainingTriangle(P,startTriangle), which is useful when consecutive
+// queries are near each other.  When cycles occur, the function will
+// iterate numTriangle times before reporting that the triangle cannot be
+// found, which is a very slow process (in debug or release builds).  The
+// function GetContainingTriangle(P,startTriangle,visited) is provided to
+// avoid the performance loss, trapping a cycle the first time and exiting,
+// but again reporting that the triangle cannot be found.  If you know that
+// the query should be (theoretically) successful, use the second version of
+// GetContainingTriangle.  If it fails by returning -1, then use the grid
+// search.  For example,
 //
 //    int triangle = pmesh->GetContainingTriangle(P,startTriangle,visited);
+//    if (triangle == -1)
+//    {
+//        triangle = pmesh->GetContainingTriangle(P);
+//    }
 //    if (triangle >= 0)
 //    {
 //        <take action; for example, compute barycenteric coordinates>;
 //    }
 //    else
 //    {
-//        int numTriangles = pmesh->GetNumTriangles();
-//        for (triangle = 0; triangle < numTriangles; ++triangle)
-//        {
-//            if (pmesh->Contains(triangle, P))
-//            {
-//                <take action>;
-//                break;
-//            }
-//        }
-//        if (triangle == numTriangles)
-//        {
-//            <Triangle still not found, take appropriate action>;
-//        }
+//        <Triangle not found, take appropriate action>;
 //    }
 //
 // The PlanarMesh<*>::Contains function does not require the triangles to
@@ -86,126 +78,74 @@ namespace gte
         // Construction.  The inputs must represent a manifold mesh of
         // triangles in the plane.  The index array must have 3*numTriangles
         // elements, each triple of indices representing a triangle in the
-        // mesh.  Each index is into the 'vertices' array.
-        PlanarMesh(int numVertices, Vector2<InputType> const* vertices, int numTriangles, int const* indices)
+        // mesh.  Each index is into the 'vertices' array.  Set numThreads
+        // to 0 or 1 to construct the mesh in the calling thread.  The
+        // threads are tasks of the scheduler when it is not null, and the
+        // scheduler is also used by the batch queries; see SetScheduler.
+        PlanarMesh(int numVertices, Vector2<InputType> const* vertices, int numTriangles, int const* indices,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
             :
             mNumVertices(0),
             mVertices(nullptr),
-            mNumTriangles(0)
+            mNumTriangles(0),
+            mScheduler(scheduler)
         {
             LogAssert(numVertices >= 3 && vertices != nullptr && numTriangles >= 1
                 && indices != nullptr, "Invalid input.");
 
-            // Create a mesh in order to get adjacency information.
-            int const* current = indices;
-            for (int t = 0; t < numTriangles; ++t)
+            int const numIndices = 3 * numTriangles;
+            for (int i = 0; i < numIndices; ++i)
             {
-                int v0 = *current++;
-                int v1 = *current++;
-                int v2 = *current++;
-                if (!mMesh.Insert(v0, v1, v2))
-                {
-                    // TODO: Fix this comment once the exception handling is
-                    // tested.
-                    //
-                    // The 'mesh' object will throw on nonmanifold inputs.
-                    return;
-                }
+                LogAssert(0 <= indices[i] && indices[i] < numVertices, "Invalid index.");
             }
 
-            // We have a valid mesh.
-            CreateVertices(numVertices, vertices);
-
-            // Build the adjacency graph using the triangle ordering implied
-            // by the indices, not the mesh triangle map, to preserve the
-            // triangle ordering of the input indices.
+            // Preserve the triangle ordering of the input indices.
             mNumTriangles = numTriangles;
-            int const numIndices = 3 * numTriangles;
             mIndices.resize(numIndices);
-
             std::copy(indices, indices + numIndices, mIndices.begin());
-            for (int t = 0, vIndex = 0; t < numTriangles; ++t)
-            {
-                int v0 = indices[vIndex++];
-                int v1 = indices[vIndex++];
-                int v2 = indices[vIndex++];
-                TriangleKey<true> key(v0, v1, v2);
-                mTriIndexMap.insert(std::make_pair(key, t));
-            }
-
-            mAdjacencies.resize(numIndices);
-            auto const& tmap = mMesh.GetTriangles();
-            for (int t = 0, base = 0; t < numTriangles; ++t, base += 3)
-            {
-                int v0 = indices[base];
-                int v1 = indices[base + 1];
-                int v2 = indices[base + 2];
-                TriangleKey<true> key(v0, v1, v2);
-                auto element = tmap.find(key);
-                for (int i = 0; i < 3; ++i)
-                {
-                    auto adj = element->second->T[i];
-                    if (adj)
-                    {
-                        key = TriangleKey<true>(adj->V[0], adj->V[1], adj->V[2]);
-                        mAdjacencies[base + i] = mTriIndexMap.find(key)->second;
-                    }
-                    else
-                    {
-                        mAdjacencies[base + i] = -1;
-                    }
-                }
-            }
+            Initialize(numVertices, vertices, numThreads);
         }
 
-        PlanarMesh(int numVertices, Vector2<InputType> const* vertices, ETManifoldMesh const& mesh)
+        PlanarMesh(int numVertices, Vector2<InputType> const* vertices, ETManifoldMesh const& mesh,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
             :
             mNumVertices(0),
             mVertices(nullptr),
-            mNumTriangles(0)
+            mNumTriangles(0),
+            mScheduler(scheduler)
         {
             if (numVertices < 3 || !vertices || mesh.GetTriangles().size() < 1)
             {
                 throw std::invalid_argument("Invalid input in PlanarMesh constructor.");
             }
 
-            // We have a valid mesh.
-            CreateVertices(numVertices, vertices);
-
-            // Build the adjacency graph using the triangle ordering implied
-            // by the mesh triangle map.
+            // Use the triangle ordering implied by the mesh triangle map.
             auto const& tmap = mesh.GetTriangles();
             mNumTriangles = static_cast<int>(tmap.size());
             mIndices.resize(3 * mNumTriangles);
-
-            int tIndex = 0, vIndex = 0;
+            int vIndex = 0;
             for (auto const& element : tmap)
             {
-                mTriIndexMap.insert(std::make_pair(element.first, tIndex++));
                 for (int i = 0; i < 3; ++i, ++vIndex)
                 {
                     mIndices[vIndex] = element.second->V[i];
                 }
             }
+            Initialize(numVertices, vertices, numThreads);
+        }
 
-            mAdjacencies.resize(3 * mNumTriangles);
-            vIndex = 0;
-            for (auto const& element : tmap)
-            {
-                for (int i = 0; i < 3; ++i, ++vIndex)
-                {
-                    auto adj = element.second->T[i];
-                    if (adj)
-                    {
-                        TriangleKey<true> key(adj->V[0], adj->V[1], adj->V[2]);
-                        mAdjacencies[vIndex] = mTriIndexMap.find(key)->second;
-                    }
-                    else
-                    {
-                        mAdjacencies[vIndex] = -1;
-                    }
-                }
-            }
+        // Execute the batch queries as tasks of the scheduler, which can be
+        // shared with other computations, instead of creating threads for
+        // each call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
         }
 
         // Mesh information.
@@ -234,17 +174,93 @@ namespace gte
             return mAdjacencies.data();
         }
 
-        // Containment queries.  The function GetContainingTriangle works
+        // The triangle index returned by GetContainingTriangle when the
+        // point is not in the mesh.
+        inline int GetInvalidIndex() const
+        {
+            return -1;
+        }
+
+        // Containment query using the point-location grid.  The return
+        // value is the index of a triangle containing P or -1 when P is
+        // not in the mesh.  The mesh does not have to be convex.
+        int GetContainingTriangle(Vector2<InputType> const& P) const
+        {
+            if (!(mGridBox.min[0] <= P[0] && P[0] <= mGridBox.max[0] &&
+                mGridBox.min[1] <= P[1] && P[1] <= mGridBox.max[1]))
+            {
+                // P is outside the bounding box of the triangles or is
+                // not a number.
+                return -1;
+            }
+
+            size_t const cell = static_cast<size_t>(GetCell(P, 0)) +
+                static_cast<size_t>(mNumCells[0]) * static_cast<size_t>(GetCell(P, 1));
+            Vector2<ComputeType> test{ P[0], P[1] };
+            for (size_t k = mCellOffsets[cell]; k < mCellOffsets[cell + 1]; ++k)
+            {
+                int const triangle = mCellTriangles[k];
+                AlignedBox2<InputType> const& box = mTriangleBoxes[triangle];
+                if (box.min[0] <= P[0] && P[0] <= box.max[0] &&
+                    box.min[1] <= P[1] && P[1] <= box.max[1])
+                {
+                    int const* v = &mIndices[3 * static_cast<size_t>(triangle)];
+                    if (mQuery.ToLine(test, v[0], v[1]) <= 0 &&
+                        mQuery.ToLine(test, v[1], v[2]) <= 0 &&
+                        mQuery.ToLine(test, v[2], v[0]) <= 0)
+                    {
+                        return triangle;
+                    }
+                }
+            }
+            return -1;
+        }
+
+        // Batch containment query using the point-location grid.  On
+        // return, triangles[i] is the index of a triangle containing
+        // points[i] or std::numeric_limits<size_t>::max() when the point is
+        // not in the mesh.  The points are partitioned into numThreads
+        // contiguous subsets that are located in parallel.  Set numThreads
+        // to 0 or 1 to locate the points in the calling thread.
+        void GetContainingTriangles(size_t numPoints, Vector2<InputType> const* points,
+            size_t* triangles, size_t numThreads = 1) const
+        {
+            LogAssert(numPoints == 0 || (points != nullptr && triangles != nullptr),
+                "Invalid input.");
+
+            size_t const numChunks = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numPoints, numChunks, points, triangles](size_t c)
+                {
+                    size_t const imin = numPoints * c / numChunks;
+                    size_t const imax = numPoints * (c + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        int const triangle = GetContainingTriangle(points[i]);
+                        triangles[i] = (triangle >= 0 ? static_cast<size_t>(triangle) :
+                            std::numeric_limits<size_t>::max());
+                    }
+                });
+        }
+
+        void GetContainingTriangles(std::vector<Vector2<InputType>> const& points,
+            std::vector<size_t>& triangles, size_t numThreads = 1) const
+        {
+            triangles.resize(points.size());
+            GetContainingTriangles(points.size(), points.data(), triangles.data(), numThreads);
+        }
+
+        // Containment queries by linear walks from startTriangle, which are
+        // fast when startTriangle is near P, for example, the result of the
+        // previous query for a sequence of nearby points.  The walk works
         // correctly when the planar mesh is a convex set.  If the mesh is not
         // convex, it is possible that the linear-walk search algorithm exits
         // the mesh before finding a containing triangle.  For example, a
         // C-shaped mesh can contain a point in the top branch of the "C".
         // A starting point in the bottom branch of the "C" will lead to the
         // search exiting the bottom branch and having no path to walk to the
-        // top branch.  If your mesh is not convex and you want a correct
-        // containment query, you will have to append "outside" triangles to
-        // your mesh to form a convex set.
-        int GetContainingTriangle(Vector2<InputType> const& P, int startTriangle = 0) const
+        // top branch.  Use GetContainingTriangle(P) for such meshes.
+        int GetContainingTriangle(Vector2<InputType> const& P, int startTriangle) const
         {
             Vector2<ComputeType> test{ P[0], P[1] };
 
@@ -408,6 +424,34 @@ namespace gte
             return false;
         }
 
+        // Batch barycentric coordinates for the triangles returned by
+        // GetContainingTriangles.  On return, valid[i] is 'true' if and only
+        // if triangles[i] is a triangle index and the barycentric
+        // coordinates of points[i] with respect to it are computed, in which
+        // case they are stored in bary[i]; otherwise, bary[i] is unchanged.
+        // The return value is the number of valid points.
+        size_t GetBarycentrics(size_t numPoints, Vector2<InputType> const* points,
+            size_t const* triangles, std::array<InputType, 3>* bary, bool* valid,
+            size_t numThreads = 1) const
+        {
+            LogAssert(numPoints == 0 || (points != nullptr && triangles != nullptr &&
+                bary != nullptr && valid != nullptr), "Invalid input.");
+
+            size_t const numChunks = std::max(std::min(numThreads, numPoints), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numPoints, numChunks, points, triangles, bary, valid](size_t c)
+                {
+                    size_t const imin = numPoints * c / numChunks;
+                    size_t const imax = numPoints * (c + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        valid[i] = (triangles[i] < static_cast<size_t>(mNumTriangles) &&
+                            GetBarycentrics(static_cast<int>(triangles[i]), points[i], bary[i]));
+                    }
+                });
+            return static_cast<size_t>(std::count(valid, valid + numPoints, true));
+        }
+
         bool Contains(int triangle, Vector2<InputType> const& P) const
         {
             Vector2<ComputeType> test{ P[0], P[1] };
@@ -419,30 +463,267 @@ namespace gte
             return pip.Contains(test);
         }
 
-    public:
-        void CreateVertices(int numVertices, Vector2<InputType> const* vertices)
+
+    private:
+        void Initialize(int numVertices, Vector2<InputType> const* vertices, size_t numThreads)
+        {
+            CreateVertices(numVertices, vertices, numThreads);
+            CreateAdjacencies(numThreads);
+            CreateGrid(numThreads);
+        }
+
+        void CreateVertices(int numVertices, Vector2<InputType> const* vertices, size_t numThreads)
         {
             mNumVertices = numVertices;
             mVertices = vertices;
             mComputeVertices.resize(mNumVertices);
-            for (int i = 0; i < mNumVertices; ++i)
+            size_t const numElements = static_cast<size_t>(mNumVertices);
+            size_t const numChunks = std::max(std::min(numThreads, numElements), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numElements, numChunks](size_t c)
+                {
+                    size_t const imin = numElements * c / numChunks;
+                    size_t const imax = numElements * (c + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        for (int j = 0; j < 2; ++j)
+                        {
+                            mComputeVertices[i][j] = (ComputeType)mVertices[i][j];
+                        }
+                    }
+                });
+            mQuery.Set(mNumVertices, &mComputeVertices[0]);
+        }
+
+        // The edge <V[i],V[(i+1)%3]> of triangle t is shared with the
+        // triangle mAdjacencies[3*t+i], which is -1 when the edge is on the
+        // boundary of the mesh.  The edges are sorted by a counting sort on
+        // their smaller vertex index followed by sorts of the edges of each
+        // vertex on their larger vertex index, so the triangles sharing an
+        // edge are adjacent in the sorted order.
+        void CreateAdjacencies(size_t numThreads)
+        {
+            struct Edge
+            {
+                int other, slot;
+            };
+
+            size_t const numVertices = static_cast<size_t>(mNumVertices);
+            size_t const numIndices = mIndices.size();
+            std::vector<size_t> offsets(numVertices + 1, 0);
+            for (size_t t = 0; t < numIndices; t += 3)
+            {
+                for (size_t i0 = 2, i1 = 0; i1 < 3; i0 = i1++)
+                {
+                    int const v = std::min(mIndices[t + i0], mIndices[t + i1]);
+                    ++offsets[static_cast<size_t>(v) + 1];
+                }
+            }
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                offsets[v + 1] += offsets[v];
+            }
+
+            std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+            std::vector<Edge> edges(numIndices);
+            for (size_t t = 0; t < numIndices; t += 3)
+            {
+                for (size_t i0 = 0; i0 < 3; ++i0)
+                {
+                    int const v0 = mIndices[t + i0];
+                    int const v1 = mIndices[t + (i0 + 1) % 3];
+                    Edge& edge = edges[next[static_cast<size_t>(std::min(v0, v1))]++];
+                    edge.other = std::max(v0, v1);
+                    edge.slot = static_cast<int>(t + i0);
+                }
+            }
+
+            // The rows of the vertices are processed in parallel. Each slot
+            // occurs in exactly one row, so the threads write disjoint
+            // elements of mAdjacencies.
+            mAdjacencies.assign(numIndices, -1);
+            numThreads = std::max(std::min(numThreads, numVertices), static_cast<size_t>(1));
+            std::vector<int> numNonmanifold(numThreads, 0);
+            TaskScheduler::ParallelFor(mScheduler, numThreads,
+                [this, numVertices, numThreads, &offsets, &edges, &numNonmanifold](size_t c)
+                {
+                    size_t const vmin = numVertices * c / numThreads;
+                    size_t const vmax = numVertices * (c + 1) / numThreads;
+                    auto first = edges.begin() + offsets[vmin];
+                    for (size_t v = vmin; v < vmax; ++v)
+                    {
+                        auto last = edges.begin() + offsets[v + 1];
+                        std::sort(first, last,
+                            [](Edge const& edge0, Edge const& edge1)
+                            {
+                                return edge0.other < edge1.other;
+                            });
+
+                        while (first != last)
+                        {
+                            auto end = first + 1;
+                            while (end != last && end->other == first->other)
+                            {
+                                ++end;
+                            }
+
+                            if (end - first == 2)
+                            {
+                                mAdjacencies[first[0].slot] = first[1].slot / 3;
+                                mAdjacencies[first[1].slot] = first[0].slot / 3;
+                            }
+                            else if (end - first > 2)
+                            {
+                                ++numNonmanifold[c];
+                            }
+                            first = end;
+                        }
+                    }
+                });
+
+            for (auto number : numNonmanifold)
+            {
+                LogAssert(number == 0, "Attempt to create nonmanifold mesh.");
+            }
+        }
+
+        // The grid has approximately one cell per triangle with cells of
+        // approximately square shape.  The cell of a point is a monotonic
+        // function of its coordinates, so a point in a triangle is in a
+        // cell overlapped by the bounding box of the triangle.
+        void CreateGrid(size_t numThreads)
+        {
+            size_t const numTriangles = static_cast<size_t>(mNumTriangles);
+            mTriangleBoxes.resize(numTriangles);
+            size_t const numChunks = std::max(std::min(numThreads, numTriangles), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numTriangles, numChunks](size_t c)
+                {
+                    size_t const tmin = numTriangles * c / numChunks;
+                    size_t const tmax = numTriangles * (c + 1) / numChunks;
+                    for (size_t t = tmin; t < tmax; ++t)
+                    {
+                        int const* v = &mIndices[3 * t];
+                        AlignedBox2<InputType>& box = mTriangleBoxes[t];
+                        box.min = mVertices[v[0]];
+                        box.max = box.min;
+                        for (int i = 1; i < 3; ++i)
+                        {
+                            for (int j = 0; j < 2; ++j)
+                            {
+                                box.min[j] = std::min(box.min[j], mVertices[v[i]][j]);
+                                box.max[j] = std::max(box.max[j], mVertices[v[i]][j]);
+                            }
+                        }
+                    }
+                });
+
+            mGridBox = mTriangleBoxes[0];
+            for (auto const& box : mTriangleBoxes)
             {
                 for (int j = 0; j < 2; ++j)
                 {
-                    mComputeVertices[i][j] = (ComputeType)mVertices[i][j];
+                    mGridBox.min[j] = std::min(mGridBox.min[j], box.min[j]);
+                    mGridBox.max[j] = std::max(mGridBox.max[j], box.max[j]);
+                }
+            }
+
+            double const width = static_cast<double>(mGridBox.max[0] - mGridBox.min[0]);
+            double const height = static_cast<double>(mGridBox.max[1] - mGridBox.min[1]);
+            double const maxNumCells = static_cast<double>(numTriangles);
+            double numCells0 = 1.0;
+            if (width > 0.0)
+            {
+                numCells0 = (height > 0.0 ? std::ceil(std::sqrt(maxNumCells * width / height)) : maxNumCells);
+            }
+            numCells0 = std::min(std::max(numCells0, 1.0), maxNumCells);
+            double numCells1 = (height > 0.0 ? std::ceil(maxNumCells / numCells0) : 1.0);
+            mNumCells[0] = static_cast<int>(numCells0);
+            mNumCells[1] = static_cast<int>(std::min(std::max(numCells1, 1.0), maxNumCells));
+            for (int j = 0; j < 2; ++j)
+            {
+                InputType const extent = mGridBox.max[j] - mGridBox.min[j];
+                mInvCellSize[j] = (extent > (InputType)0 ?
+                    static_cast<InputType>(mNumCells[j]) / extent : (InputType)0);
+            }
+
+            // Bucket the triangles by a counting sort on the cells.
+            std::vector<std::array<int, 4>> cellRanges(numTriangles);
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numTriangles, numChunks, &cellRanges](size_t c)
+                {
+                    size_t const tmin = numTriangles * c / numChunks;
+                    size_t const tmax = numTriangles * (c + 1) / numChunks;
+                    for (size_t t = tmin; t < tmax; ++t)
+                    {
+                        AlignedBox2<InputType> const& box = mTriangleBoxes[t];
+                        cellRanges[t] =
+                        {
+                            GetCell(box.min, 0), GetCell(box.max, 0),
+                            GetCell(box.min, 1), GetCell(box.max, 1)
+                        };
+                    }
+                });
+
+            size_t const numCells = static_cast<size_t>(mNumCells[0]) * static_cast<size_t>(mNumCells[1]);
+            mCellOffsets.assign(numCells + 1, 0);
+            for (auto const& range : cellRanges)
+            {
+                for (int y = range[2]; y <= range[3]; ++y)
+                {
+                    size_t const row = static_cast<size_t>(mNumCells[0]) * static_cast<size_t>(y);
+                    for (int x = range[0]; x <= range[1]; ++x)
+                    {
+                        ++mCellOffsets[row + static_cast<size_t>(x) + 1];
+                    }
+                }
+            }
+            for (size_t cell = 0; cell < numCells; ++cell)
+            {
+                mCellOffsets[cell + 1] += mCellOffsets[cell];
+            }
+
+            std::vector<size_t> next(mCellOffsets.begin(), mCellOffsets.end() - 1);
+            mCellTriangles.resize(mCellOffsets.back());
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                auto const& range = cellRanges[t];
+                for (int y = range[2]; y <= range[3]; ++y)
+                {
+                    size_t const row = static_cast<size_t>(mNumCells[0]) * static_cast<size_t>(y);
+                    for (int x = range[0]; x <= range[1]; ++x)
+                    {
+                        mCellTriangles[next[row + static_cast<size_t>(x)]++] = static_cast<int>(t);
+                    }
                 }
             }
-            mQuery.Set(mNumVertices, &mComputeVertices[0]);
+        }
+
+        // The point must be in mGridBox.
+        inline int GetCell(Vector2<InputType> const& P, int j) const
+        {
+            int cell = static_cast<int>((P[j] - mGridBox.min[j]) * mInvCellSize[j]);
+            return std::min(std::max(cell, 0), mNumCells[j] - 1);
         }
 
         int mNumVertices;
         Vector2<InputType> const* mVertices;
         int mNumTriangles;
         std::vector<int> mIndices;
-        ETManifoldMesh mMesh;
-        std::map<TriangleKey<true>, int> mTriIndexMap;
         std::vector<int> mAdjacencies;
         std::vector<Vector2<ComputeType>> mComputeVertices;
         PrimalQuery2<ComputeType> mQuery;
+
+        // The point-location grid. The triangles overlapping cell
+        // x + mNumCells[0] * y are mCellTriangles[k] for
+        // mCellOffsets[cell] <= k < mCellOffsets[cell + 1].
+        std::vector<AlignedBox2<InputType>> mTriangleBoxes;
+        AlignedBox2<InputType> mGridBox;
+        std::array<int, 2> mNumCells;
+        Vector2<InputType> mInvCellSize;
+        std::vector<size_t> mCellOffsets;
+        std::vector<int> mCellTriangles;
+
+        TaskScheduler* mScheduler;
     };
 }
@@ -0,0 +1,403 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// Point clouds stored as structure of arrays, one array per coordinate.
+// PointCloudView is a lightweight nonowning view of the coordinate
+// arrays, which is how the fitters and containers accept the points. A
+// PointCloud object owns its arrays and can be created from an array of
+// points. Many fits on the same cloud should convert the points once and
+// pass the view to each fit.
+//
+// The functions at the end of the file are the accumulations used by the
+// fitters and containers, for the points with indices in [imin,imax). The
+// loops process blocks of 8 consecutive points in 8 independent partial
+// results per coordinate and have no branches, so the compiler can
+// vectorize them. The order of the additions differs from that of a loop
+// over an array of Vector<N,Real>, so for floating-point types the rounding
+// errors differ.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class PointCloudView
+    {
+    public:
+        PointCloudView()
+            :
+            mNumPoints(0)
+        {
+            mCoordinates.fill(nullptr);
+        }
+
+        // Point i is (coordinates[0][i], ..., coordinates[N-1][i]). The view
+        // does not copy the arrays, so be careful about their persistence.
+        PointCloudView(size_t numPoints, std::array<Real const*, N> const& coordinates)
+            :
+            mNumPoints(numPoints),
+            mCoordinates(coordinates)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                LogAssert(numPoints == 0 || coordinates[d] != nullptr, "Invalid input.");
+            }
+        }
+
+        inline size_t GetNumPoints() const
+        {
+            return mNumPoints;
+        }
+
+        inline Real const* GetCoordinates(int d) const
+        {
+            return mCoordinates[d];
+        }
+
+        inline Vector<N, Real> GetPoint(size_t i) const
+        {
+            Vector<N, Real> point;
+            for (int d = 0; d < N; ++d)
+            {
+                point[d] = mCoordinates[d][i];
+            }
+            return point;
+        }
+
+    private:
+        size_t mNumPoints;
+        std::array<Real const*, N> mCoordinates;
+    };
+
+    template <int N, typename Real>
+    class PointCloud
+    {
+    public:
+        PointCloud() = default;
+
+        PointCloud(size_t numPoints, Vector<N, Real> const* points)
+        {
+            Set(numPoints, points);
+        }
+
+        explicit PointCloud(std::vector<Vector<N, Real>> const& points)
+        {
+            Set(points.size(), points.data());
+        }
+
+        // Copy the points into the coordinate arrays.
+        void Set(size_t numPoints, Vector<N, Real> const* points)
+        {
+            Resize(numPoints);
+            for (size_t i = 0; i < numPoints; ++i)
+            {
+                for (int d = 0; d < N; ++d)
+                {
+                    mCoordinates[d][i] = points[i][d];
+                }
+            }
+        }
+
+        void Resize(size_t numPoints)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                mCoordinates[d].resize(numPoints);
+            }
+        }
+
+        inline size_t GetNumPoints() const
+        {
+            return mCoordinates[0].size();
+        }
+
+        inline std::vector<Real>& GetCoordinates(int d)
+        {
+            return mCoordinates[d];
+        }
+
+        inline std::vector<Real> const& GetCoordinates(int d) const
+        {
+            return mCoordinates[d];
+        }
+
+        PointCloudView<N, Real> GetView() const
+        {
+            std::array<Real const*, N> coordinates;
+            for (int d = 0; d < N; ++d)
+            {
+                coordinates[d] = mCoordinates[d].data();
+            }
+            return PointCloudView<N, Real>(GetNumPoints(), coordinates);
+        }
+
+    private:
+        std::array<std::vector<Real>, N> mCoordinates;
+    };
+
+    // The sum of the points.
+    template <int N, typename Real>
+    Vector<N, Real> ComputeSum(PointCloudView<N, Real> const& cloud,
+        size_t imin, size_t imax)
+    {
+        std::array<std::array<Real, 8>, N> partial;
+        for (int d = 0; d < N; ++d)
+        {
+            partial[d].fill((Real)0);
+        }
+
+        for (int d = 0; d < N; ++d)
+        {
+            Real const* x = cloud.GetCoordinates(d);
+            size_t i = imin;
+            for (; i + 8 <= imax; i += 8)
+            {
+                for (size_t lane = 0; lane < 8; ++lane)
+                {
+                    partial[d][lane] += x[i + lane];
+                }
+            }
+            for (size_t lane = 0; i < imax; ++i, ++lane)
+            {
+                partial[d][lane] += x[i];
+            }
+        }
+
+        Vector<N, Real> sum;
+        for (int d = 0; d < N; ++d)
+        {
+            sum[d] = (Real)0;
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                sum[d] += partial[d][lane];
+            }
+        }
+        return sum;
+    }
+
+    // The sums of the products (P[r]-C[r])*(P[c]-C[c]) for r <= c, stored
+    // in row-major order of the upper triangle. For N = 3 the elements are
+    // the sums for 00, 01, 02, 11, 12 and 22.
+    template <int N, typename Real>
+    std::array<Real, N * (N + 1) / 2> ComputeCovarianceSum(
+        PointCloudView<N, Real> const& cloud, Vector<N, Real> const& center,
+        size_t imin, size_t imax)
+    {
+        std::array<std::array<Real, 8>, N * (N + 1) / 2> partial;
+        for (auto& element : partial)
+        {
+            element.fill((Real)0);
+        }
+
+        std::array<Real const*, N> x;
+        for (int d = 0; d < N; ++d)
+        {
+            x[d] = cloud.GetCoordinates(d);
+        }
+
+        std::array<std::array<Real, 8>, N> diff;
+        size_t i = imin;
+        for (; i + 8 <= imax; i += 8)
+        {
+            for (int d = 0; d < N; ++d)
+            {
+                for (size_t lane = 0; lane < 8; ++lane)
+                {
+                    diff[d][lane] = x[d][i + lane] - center[d];
+                }
+            }
+            for (int r = 0, k = 0; r < N; ++r)
+            {
+                for (int c = r; c < N; ++c, ++k)
+                {
+                    for (size_t lane = 0; lane < 8; ++lane)
+                    {
+                        partial[k][lane] += diff[r][lane] * diff[c][lane];
+                    }
+                }
+            }
+        }
+        for (size_t lane = 0; i < imax; ++i, ++lane)
+        {
+            for (int r = 0, k = 0; r < N; ++r)
+            {
+                Real const diffR = x[r][i] - center[r];
+                for (int c = r; c < N; ++c, ++k)
+                {
+                    partial[k][lane] += diffR * (x[c][i] - center[c]);
+                }
+            }
+        }
+
+        std::array<Real, N * (N + 1) / 2> sum;
+        for (size_t k = 0; k < sum.size(); ++k)
+        {
+            sum[k] = (Real)0;
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                sum[k] += partial[k][lane];
+            }
+        }
+        return sum;
+    }
+
+    // The extreme values of the projections Dot(P-C,axis[j]) for
+    // 0 <= j < numAxes. The range [imin,imax) must be nonempty.
+    template <int N, typename Real>
+    void ComputeProjectionExtremes(PointCloudView<N, Real> const& cloud,
+        Vector<N, Real> const& center, int numAxes, Vector<N, Real> const* axis,
+        size_t imin, size_t imax, Real* pmin, Real* pmax)
+    {
+        LogAssert(imin < imax && imax <= cloud.GetNumPoints(), "Invalid input.");
+
+        std::array<Real const*, N> x;
+        for (int d = 0; d < N; ++d)
+        {
+            x[d] = cloud.GetCoordinates(d);
+        }
+
+        for (int j = 0; j < numAxes; ++j)
+        {
+            auto project = [&x, &center, &axis, j](size_t i)
+            {
+                Real dot = (Real)0;
+                for (int d = 0; d < N; ++d)
+                {
+                    dot += (x[d][i] - center[d]) * axis[j][d];
+                }
+                return dot;
+            };
+
+            std::array<Real, 8> lmin, lmax;
+            lmin.fill(project(imin));
+            lmax = lmin;
+            size_t i = imin;
+            for (; i + 8 <= imax; i += 8)
+            {
+                for (size_t lane = 0; lane < 8; ++lane)
+                {
+                    Real const dot = project(i + lane);
+                    lmin[lane] = (dot < lmin[lane] ? dot : lmin[lane]);
+                    lmax[lane] = (dot > lmax[lane] ? dot : lmax[lane]);
+                }
+            }
+            for (size_t lane = 0; i < imax; ++i, ++lane)
+            {
+                Real const dot = project(i);
+                lmin[lane] = (dot < lmin[lane] ? dot : lmin[lane]);
+                lmax[lane] = (dot > lmax[lane] ? dot : lmax[lane]);
+            }
+
+            pmin[j] = lmin[0];
+            pmax[j] = lmax[0];
+            for (size_t lane = 1; lane < 8; ++lane)
+            {
+                pmin[j] = std::min(pmin[j], lmin[lane]);
+                pmax[j] = std::max(pmax[j], lmax[lane]);
+            }
+        }
+    }
+
+    // The axis-aligned bounding box of the points. The return value is
+    // 'true' iff the range is nonempty, in which case vmin and vmax have
+    // valid values.
+    template <int N, typename Real>
+    bool ComputeExtremes(PointCloudView<N, Real> const& cloud, size_t imin, size_t imax,
+        Vector<N, Real>& vmin, Vector<N, Real>& vmax)
+    {
+        if (imin >= imax || imax > cloud.GetNumPoints())
+        {
+            return false;
+        }
+
+        for (int d = 0; d < N; ++d)
+        {
+            Real const* x = cloud.GetCoordinates(d);
+            std::array<Real, 8> lmin, lmax;
+            lmin.fill(x[imin]);
+            lmax = lmin;
+            size_t i = imin;
+            for (; i + 8 <= imax; i += 8)
+            {
+                for (size_t lane = 0; lane < 8; ++lane)
+                {
+                    Real const value = x[i + lane];
+                    lmin[lane] = (value < lmin[lane] ? value : lmin[lane]);
+                    lmax[lane] = (value > lmax[lane] ? value : lmax[lane]);
+                }
+            }
+            for (size_t lane = 0; i < imax; ++i, ++lane)
+            {
+                lmin[lane] = (x[i] < lmin[lane] ? x[i] : lmin[lane]);
+                lmax[lane] = (x[i] > lmax[lane] ? x[i] : lmax[lane]);
+            }
+
+            vmin[d] = lmin[0];
+            vmax[d] = lmax[0];
+            for (size_t lane = 1; lane < 8; ++lane)
+            {
+                vmin[d] = std::min(vmin[d], lmin[lane]);
+                vmax[d] = std::max(vmax[d], lmax[lane]);
+            }
+        }
+        return true;
+    }
+
+    // The maximum squared distance from the points to C, which is zero for
+    // an empty range.
+    template <int N, typename Real>
+    Real ComputeMaxSqrDistance(PointCloudView<N, Real> const& cloud,
+        Vector<N, Real> const& center, size_t imin, size_t imax)
+    {
+        std::array<Real const*, N> x;
+        for (int d = 0; d < N; ++d)
+        {
+            x[d] = cloud.GetCoordinates(d);
+        }
+
+        auto sqrDistance = [&x, &center](size_t i)
+        {
+            Real sqrLength = (Real)0;
+            for (int d = 0; d < N; ++d)
+            {
+                Real const diff = x[d][i] - center[d];
+                sqrLength += diff * diff;
+            }
+            return sqrLength;
+        };
+
+        std::array<Real, 8> lmax;
+        lmax.fill((Real)0);
+        size_t i = imin;
+        for (; i + 8 <= imax; i += 8)
+        {
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                Real const sqrLength = sqrDistance(i + lane);
+                lmax[lane] = (sqrLength > lmax[lane] ? sqrLength : lmax[lane]);
+            }
+        }
+        for (size_t lane = 0; i < imax; ++i, ++lane)
+        {
+            Real const sqrLength = sqrDistance(i);
+            lmax[lane] = (sqrLength > lmax[lane] ? sqrLength : lmax[lane]);
+        }
+
+        Real result = lmax[0];
+        for (size_t lane = 1; lane < 8; ++lane)
+        {
+            result = std::max(result, lmax[lane]);
+        }
+        return result;
+    }
+}
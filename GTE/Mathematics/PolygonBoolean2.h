@@ -0,0 +1,938 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/Vector2.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <set>
+#include <type_traits>
+#include <vector>
+
+// Boolean operations on polygonal regions by a plane sweep, an alternative
+// to BSPPolygon2 for large inputs. The subject and the clip region are
+// each a set of any number of closed contours; the contours may intersect
+// themselves and each other, and the interior of each region is defined by
+// its fill rule applied to the winding numbers of its contours. A union of
+// many polygons is the UNION of a subject containing all of them, with
+// the NON_ZERO rule, and an empty clip region.
+//
+// The algorithm is that of
+//   Francisco Martinez, Carlos Ogayar, Juan R. Jimenez, Antonio J. Rueda,
+//   "A simple algorithm for Boolean operations on polygons", Advances in
+//   Engineering Software 64:11-19, 2013,
+// with the in/out flags generalized to winding numbers. A first sweep
+// splits the edges at their intersections until no two edges cross and
+// overlapping edges coincide. A second sweep merges coincident edges and
+// computes the winding numbers of both regions below each edge from its
+// predecessor in the sweep structure. An edge is on the boundary of the
+// result when the result contains the points on one side of it but not
+// those on the other. The boundary is assembled into contours by one pass
+// over the vertices in sweep order, so the cost is O((n + k) log(n)) for
+// n input edges and k intersections.
+//
+// The sweeps use exact predicates. The Real inputs, 'float' or 'double',
+// are converted exactly to 'double', and an intersection point is stored
+// as a pair of Rational numbers together with its 'double' rounding. Point
+// comparisons and orientation tests are decided in floating-point
+// arithmetic when the error bounds allow, which is nearly always, and
+// otherwise in Rational arithmetic. Every edge remembers the input segment
+// it came from, and orientations are computed relative to that segment,
+// so the Rational computations involve at most one constructed point. The
+// Rational type must support division; the default is BSRational.
+//
+// The output contours have the interior of the result on their left, so
+// the outer boundaries are counterclockwise and the holes are clockwise.
+// Contours touch only at isolated vertices, and vertices interior to a
+// straight boundary run are removed. The intersection points are rounded
+// to Real in the output.
+
+namespace gte
+{
+    template <typename Real, typename Rational = BSRational<UIntegerAP32>>
+    class PolygonBoolean2
+    {
+    public:
+        enum class Operation
+        {
+            UNION,
+            INTERSECTION,
+            DIFFERENCE,
+            EXCLUSIVE_OR
+        };
+
+        enum class FillRule
+        {
+            EVEN_ODD,
+            NON_ZERO
+        };
+
+        typedef std::vector<Vector2<Real>> Contour;
+
+        PolygonBoolean2()
+            :
+            mOperation(Operation::UNION),
+            mFillRule{ FillRule::EVEN_ODD, FillRule::EVEN_ODD },
+            mNumExactQueries(0)
+        {
+            static_assert(std::is_same<Real, float>::value || std::is_same<Real, double>::value,
+                "Real must be 'float' or 'double'.");
+        }
+
+        // The result of 'subject operation clip'. Each contour is a closed
+        // polyline whose last vertex connects to its first vertex. The
+        // coordinates must be finite. Contours with fewer than 3 distinct
+        // vertices contribute nothing.
+        void operator()(Operation operation,
+            std::vector<Contour> const& subject, FillRule subjectFillRule,
+            std::vector<Contour> const& clip, FillRule clipFillRule,
+            std::vector<Contour>& result)
+        {
+            mOperation = operation;
+            mFillRule[0] = subjectFillRule;
+            mFillRule[1] = clipFillRule;
+            mNumExactQueries = 0;
+            mPoints.clear();
+            mRationals.clear();
+            mFragments.clear();
+            mEvents.clear();
+            mVertexPoints.clear();
+            result.clear();
+
+            AddContours(0, subject);
+            AddContours(1, clip);
+            Subdivide();
+            std::vector<Edge> edges;
+            ComputeBoundary(edges);
+            AssembleContours(edges, result);
+        }
+
+        void operator()(Operation operation, std::vector<Contour> const& subject,
+            std::vector<Contour> const& clip, std::vector<Contour>& result)
+        {
+            operator()(operation, subject, FillRule::EVEN_ODD, clip, FillRule::EVEN_ODD, result);
+        }
+
+        // Statistics of the last operation. The fragments are the pieces
+        // of the input edges after splitting at the intersections. The
+        // exact queries are the predicates that the floating-point filters
+        // could not decide.
+        inline size_t GetNumFragments() const
+        {
+            return mFragments.size();
+        }
+
+        inline size_t GetNumExactQueries() const
+        {
+            return mNumExactQueries;
+        }
+
+    private:
+        // A point is an input vertex, whose coordinates are exact in
+        // 'double', or an intersection point, whose exact coordinates are
+        // mRationals[rational] and mRationals[rational + 1]. The error is a
+        // bound on the difference between the exact coordinates and the
+        // 'double' approximation. An intersection point lies on the input
+        // segments segment[0] and segment[1], which lets the orientation
+        // tests of the point and the fragments that it splits skip the
+        // Rational arithmetic.
+        struct Point
+        {
+            Vector2<double> position;
+            Vector2<double> error;
+            int rational;
+            int segment[2];
+        };
+
+        class EventOrder
+        {
+        public:
+            EventOrder(PolygonBoolean2 const* boolean) : mBoolean(boolean) {}
+
+            // The priority queue returns the event that is not after any
+            // other event.
+            bool operator()(int event0, int event1) const
+            {
+                return mBoolean->IsEventAfter(event0, event1);
+            }
+
+        private:
+            PolygonBoolean2 const* mBoolean;
+        };
+
+        class StatusOrder
+        {
+        public:
+            StatusOrder(PolygonBoolean2 const* boolean) : mBoolean(boolean) {}
+
+            bool operator()(int fragment0, int fragment1) const
+            {
+                return mBoolean->IsBelow(fragment0, fragment1);
+            }
+
+        private:
+            PolygonBoolean2 const* mBoolean;
+        };
+
+        typedef std::set<int, StatusOrder> Status;
+        typedef std::priority_queue<int, std::vector<int>, EventOrder> EventQueue;
+
+        // A fragment lies on the input segment <a,b>, where a precedes b in
+        // the sweep order (increasing x, then increasing y). Its endpoints
+        // 'left' and 'right' are point indices in the same order. Crossing
+        // the fragment from below (the right side of <a,b>) to above (the
+        // left side) changes the winding number of the subject by delta[0]
+        // and that of the clip region by delta[1]. The segment is the index
+        // of the input edge.
+        struct Fragment
+        {
+            Vector2<double> a, b;
+            int segment;
+            int left, right;
+            int rightEvent;
+            int delta[2];
+            int below[2];
+            int leftVertex, rightVertex;
+            bool merged;
+            typename Status::iterator position;
+        };
+
+        struct Event
+        {
+            int point;
+            int fragment;
+            bool isLeft;
+        };
+
+        // A directed boundary edge of the result, from vertex v0 to vertex
+        // v1, with the result interior on its left. The direction is
+        // sign * (b - a) for the input segment <a,b> of the fragment.
+        struct Edge
+        {
+            int v0, v1;
+            int fragment;
+            int sign;
+        };
+
+        void AddContours(int operand, std::vector<Contour> const& contours)
+        {
+            for (auto const& contour : contours)
+            {
+                size_t const numVertices = contour.size();
+                if (numVertices < 3)
+                {
+                    continue;
+                }
+
+                int const first = static_cast<int>(mPoints.size());
+                for (auto const& vertex : contour)
+                {
+                    Point point;
+                    point.position = { static_cast<double>(vertex[0]), static_cast<double>(vertex[1]) };
+                    point.error = { 0.0, 0.0 };
+                    point.rational = -1;
+                    point.segment[0] = -1;
+                    point.segment[1] = -1;
+                    mPoints.push_back(point);
+                }
+
+                for (size_t i0 = numVertices - 1, i1 = 0; i1 < numVertices; i0 = i1++)
+                {
+                    int p0 = first + static_cast<int>(i0);
+                    int p1 = first + static_cast<int>(i1);
+                    int order = ComparePoints(p0, p1);
+                    if (order == 0)
+                    {
+                        continue;
+                    }
+
+                    Fragment fragment;
+                    fragment.left = (order < 0 ? p0 : p1);
+                    fragment.right = (order < 0 ? p1 : p0);
+                    fragment.a = mPoints[fragment.left].position;
+                    fragment.b = mPoints[fragment.right].position;
+                    fragment.segment = static_cast<int>(mFragments.size());
+                    fragment.rightEvent = -1;
+                    fragment.delta[operand] = (order < 0 ? +1 : -1);
+                    fragment.delta[1 - operand] = 0;
+                    fragment.below[0] = 0;
+                    fragment.below[1] = 0;
+                    fragment.leftVertex = -1;
+                    fragment.rightVertex = -1;
+                    fragment.merged = false;
+                    mFragments.push_back(fragment);
+                }
+            }
+        }
+
+        // The first sweep. When two fragments become adjacent in the sweep
+        // structure, they are split at their intersection, which creates
+        // events ahead of the sweep line.
+        void Subdivide()
+        {
+            EventQueue queue(EventOrder(this));
+            Status status(StatusOrder(this));
+            int const numInputFragments = static_cast<int>(mFragments.size());
+            mEvents.reserve(2 * static_cast<size_t>(numInputFragments));
+            for (int f = 0; f < numInputFragments; ++f)
+            {
+                queue.push(AddEvent(mFragments[f].left, f, true));
+                mFragments[f].rightEvent = AddEvent(mFragments[f].right, f, false);
+                queue.push(mFragments[f].rightEvent);
+            }
+
+            while (!queue.empty())
+            {
+                Event event = mEvents[queue.top()];
+                queue.pop();
+                if (event.isLeft)
+                {
+                    auto position = status.insert(event.fragment).first;
+                    mFragments[event.fragment].position = position;
+                    auto next = std::next(position);
+                    if (next != status.end())
+                    {
+                        SplitAtIntersection(event.fragment, *next, queue);
+                    }
+                    if (position != status.begin())
+                    {
+                        SplitAtIntersection(*std::prev(position), event.fragment, queue);
+                    }
+                }
+                else
+                {
+                    auto position = mFragments[event.fragment].position;
+                    auto next = std::next(position);
+                    if (position != status.begin() && next != status.end())
+                    {
+                        int const below = *std::prev(position);
+                        int const above = *next;
+                        status.erase(position);
+                        SplitAtIntersection(below, above, queue);
+                    }
+                    else
+                    {
+                        status.erase(position);
+                    }
+                }
+            }
+        }
+
+        void SplitAtIntersection(int f0, int f1, EventQueue& queue)
+        {
+            int const left0 = mFragments[f0].left, right0 = mFragments[f0].right;
+            int const left1 = mFragments[f1].left, right1 = mFragments[f1].right;
+            int const o0 = Orientation(f0, left1);
+            int const o1 = Orientation(f0, right1);
+            if (o0 * o1 > 0)
+            {
+                return;
+            }
+
+            if (o0 == 0 && o1 == 0)
+            {
+                // The fragments are collinear. If they overlap, split one
+                // of them at an endpoint of the other. Further splits, if
+                // needed, occur when the new fragment is inserted.
+                int order = ComparePoints(left0, left1);
+                if (order < 0)
+                {
+                    if (ComparePoints(left1, right0) < 0)
+                    {
+                        Split(f0, left1, queue);
+                    }
+                }
+                else if (order > 0)
+                {
+                    if (ComparePoints(left0, right1) < 0)
+                    {
+                        Split(f1, left0, queue);
+                    }
+                }
+                else
+                {
+                    order = ComparePoints(right0, right1);
+                    if (order < 0)
+                    {
+                        Split(f1, right0, queue);
+                    }
+                    else if (order > 0)
+                    {
+                        Split(f0, right1, queue);
+                    }
+                }
+                return;
+            }
+
+            int const o2 = Orientation(f1, left0);
+            int const o3 = Orientation(f1, right0);
+            if (o2 * o3 > 0)
+            {
+                return;
+            }
+
+            // The fragments intersect in a single point. An endpoint on the
+            // line of the other fragment is the intersection point.
+            int point;
+            if (o0 == 0)
+            {
+                point = left1;
+            }
+            else if (o1 == 0)
+            {
+                point = right1;
+            }
+            else if (o2 == 0)
+            {
+                point = left0;
+            }
+            else if (o3 == 0)
+            {
+                point = right0;
+            }
+            else
+            {
+                point = AddIntersection(f0, f1);
+            }
+
+            if (o2 != 0 && o3 != 0)
+            {
+                Split(f0, point, queue);
+            }
+            if (o0 != 0 && o1 != 0)
+            {
+                Split(f1, point, queue);
+            }
+        }
+
+        // Split fragment f at a point interior to it. The fragment keeps
+        // its left part and a new fragment is created for the right part,
+        // which takes over the right event of f.
+        void Split(int f, int point, EventQueue& queue)
+        {
+            int const g = static_cast<int>(mFragments.size());
+            Fragment piece = mFragments[f];
+            piece.left = point;
+            mFragments.push_back(piece);
+            mEvents[piece.rightEvent].fragment = g;
+
+            Fragment& fragment = mFragments[f];
+            fragment.right = point;
+            fragment.rightEvent = AddEvent(point, f, false);
+            queue.push(fragment.rightEvent);
+            queue.push(AddEvent(point, g, true));
+        }
+
+        // The second sweep. The winding numbers below a fragment are those
+        // above its predecessor in the sweep structure. Coincident
+        // fragments are adjacent in the sweep structure, and the later
+        // ones are merged into the first.
+        void ComputeBoundary(std::vector<Edge>& edges)
+        {
+            EventQueue queue(EventOrder(this));
+            Status status(StatusOrder(this));
+            int const numFragments = static_cast<int>(mFragments.size());
+            mEvents.clear();
+            mEvents.reserve(2 * static_cast<size_t>(numFragments));
+            for (int f = 0; f < numFragments; ++f)
+            {
+                queue.push(AddEvent(mFragments[f].left, f, true));
+                mFragments[f].rightEvent = AddEvent(mFragments[f].right, f, false);
+                queue.push(mFragments[f].rightEvent);
+            }
+
+            // The events at a point are consecutive, so the vertices are
+            // numbered in sweep order.
+            int previousPoint = -1;
+            while (!queue.empty())
+            {
+                Event event = mEvents[queue.top()];
+                queue.pop();
+                if (previousPoint < 0 || ComparePoints(previousPoint, event.point) != 0)
+                {
+                    mVertexPoints.push_back(event.point);
+                }
+                previousPoint = event.point;
+                int const vertex = static_cast<int>(mVertexPoints.size()) - 1;
+
+                Fragment& fragment = mFragments[event.fragment];
+                if (event.isLeft)
+                {
+                    fragment.leftVertex = vertex;
+                    auto position = status.insert(event.fragment).first;
+                    if (position != status.begin())
+                    {
+                        Fragment& below = mFragments[*std::prev(position)];
+                        if (ComparePoints(below.left, fragment.left) == 0 &&
+                            ComparePoints(below.right, fragment.right) == 0)
+                        {
+                            below.delta[0] += fragment.delta[0];
+                            below.delta[1] += fragment.delta[1];
+                            fragment.merged = true;
+                            status.erase(position);
+                            continue;
+                        }
+
+                        fragment.below[0] = below.below[0] + below.delta[0];
+                        fragment.below[1] = below.below[1] + below.delta[1];
+                    }
+                    fragment.position = position;
+                }
+                else if (!fragment.merged)
+                {
+                    // The deltas are final, because coincident fragments
+                    // are merged at their common left vertex.
+                    fragment.rightVertex = vertex;
+                    status.erase(fragment.position);
+
+                    int const above[2] =
+                    {
+                        fragment.below[0] + fragment.delta[0],
+                        fragment.below[1] + fragment.delta[1]
+                    };
+                    bool const insideBelow = InResult(fragment.below);
+                    bool const insideAbove = InResult(above);
+                    if (insideBelow != insideAbove)
+                    {
+                        Edge edge;
+                        edge.fragment = event.fragment;
+                        if (insideAbove)
+                        {
+                            edge.v0 = fragment.leftVertex;
+                            edge.v1 = fragment.rightVertex;
+                            edge.sign = +1;
+                        }
+                        else
+                        {
+                            edge.v0 = fragment.rightVertex;
+                            edge.v1 = fragment.leftVertex;
+                            edge.sign = -1;
+                        }
+                        edges.push_back(edge);
+                    }
+                }
+            }
+        }
+
+        bool InResult(int const* winding) const
+        {
+            bool const inSubject = IsInside(winding[0], mFillRule[0]);
+            bool const inClip = IsInside(winding[1], mFillRule[1]);
+            switch (mOperation)
+            {
+            case Operation::UNION:
+                return inSubject || inClip;
+            case Operation::INTERSECTION:
+                return inSubject && inClip;
+            case Operation::DIFFERENCE:
+                return inSubject && !inClip;
+            default:  // Operation::EXCLUSIVE_OR
+                return inSubject != inClip;
+            }
+        }
+
+        static bool IsInside(int winding, FillRule fillRule)
+        {
+            return (fillRule == FillRule::EVEN_ODD ? (winding & 1) != 0 : winding != 0);
+        }
+
+        // At each vertex the outgoing and incoming edges alternate in
+        // angular order, and a traversal with the interior on the left
+        // leaves a vertex on the first outgoing edge clockwise from the
+        // reversed incoming edge. The outgoing edges of a vertex are
+        // sorted only when there are several.
+        void AssembleContours(std::vector<Edge> const& edges, std::vector<Contour>& result)
+        {
+            int const numEdges = static_cast<int>(edges.size());
+            int const numVertices = static_cast<int>(mVertexPoints.size());
+            std::vector<int> outStart(static_cast<size_t>(numVertices) + 1, 0);
+            for (auto const& edge : edges)
+            {
+                ++outStart[static_cast<size_t>(edge.v0) + 1];
+            }
+            for (int v = 0; v < numVertices; ++v)
+            {
+                outStart[v + 1] += outStart[v];
+            }
+
+            std::vector<int> outEdges(edges.size());
+            std::vector<int> fill(outStart.begin(), outStart.end() - 1);
+            for (int e = 0; e < numEdges; ++e)
+            {
+                outEdges[fill[edges[e].v0]++] = e;
+            }
+
+            for (int v = 0; v < numVertices; ++v)
+            {
+                if (outStart[v + 1] - outStart[v] > 1)
+                {
+                    std::sort(outEdges.begin() + outStart[v], outEdges.begin() + outStart[v + 1],
+                        [this, &edges](int e0, int e1)
+                        {
+                            Edge const& edge0 = edges[e0];
+                            Edge const& edge1 = edges[e1];
+                            return IsAngleLess(edge0.fragment, edge0.sign, edge1.fragment, edge1.sign);
+                        });
+                }
+            }
+
+            std::vector<bool> visited(edges.size(), false);
+            std::vector<int> cycle;
+            for (int first = 0; first < numEdges; ++first)
+            {
+                if (visited[first])
+                {
+                    continue;
+                }
+
+                cycle.clear();
+                int e = first;
+                do
+                {
+                    visited[e] = true;
+                    cycle.push_back(e);
+                    e = GetNextEdge(edges, outStart, outEdges, e);
+                } while (!visited[e]);
+
+                // Remove the vertices between collinear edges.
+                Contour contour;
+                size_t const numCycle = cycle.size();
+                for (size_t i0 = numCycle - 1, i1 = 0; i1 < numCycle; i0 = i1++)
+                {
+                    Edge const& edge0 = edges[cycle[i0]];
+                    Edge const& edge1 = edges[cycle[i1]];
+                    if (CrossSign(mFragments[edge0.fragment], mFragments[edge1.fragment]) != 0)
+                    {
+                        contour.push_back(GetPosition(mVertexPoints[edge1.v0]));
+                    }
+                }
+                result.push_back(std::move(contour));
+            }
+        }
+
+        int GetNextEdge(std::vector<Edge> const& edges, std::vector<int> const& outStart,
+            std::vector<int> const& outEdges, int e) const
+        {
+            Edge const& edge = edges[e];
+            int const begin = outStart[edge.v1];
+            int const end = outStart[edge.v1 + 1];
+            if (end - begin == 1)
+            {
+                return outEdges[begin];
+            }
+
+            // The reversed incoming edge has the opposite direction. Find
+            // the last outgoing edge whose angle is smaller, cyclically.
+            auto first = outEdges.begin() + begin;
+            auto last = outEdges.begin() + end;
+            auto iter = std::lower_bound(first, last, e,
+                [this, &edges, &edge](int outEdge, int)
+                {
+                    Edge const& out = edges[outEdge];
+                    return IsAngleLess(out.fragment, out.sign, edge.fragment, -edge.sign);
+                });
+            return (iter == first ? *(last - 1) : *(iter - 1));
+        }
+
+        // Angular order of the directions sign * (b - a) of the input
+        // segments of fragments, counterclockwise from the positive x-axis.
+        bool IsAngleLess(int f0, int sign0, int f1, int sign1) const
+        {
+            Fragment const& fragment0 = mFragments[f0];
+            Fragment const& fragment1 = mFragments[f1];
+            int const half0 = GetHalfPlane(fragment0, sign0);
+            int const half1 = GetHalfPlane(fragment1, sign1);
+            if (half0 != half1)
+            {
+                return half0 < half1;
+            }
+            return sign0 * sign1 * CrossSign(fragment0, fragment1) > 0;
+        }
+
+        // Returns 0 for the directions with angles in [0,pi) and 1 for those
+        // with angles in [pi,2*pi). Because a precedes b in the sweep order,
+        // b - a has angle in (-pi/2,pi/2].
+        static int GetHalfPlane(Fragment const& fragment, int sign)
+        {
+            bool const upper = (fragment.b[1] > fragment.a[1] ||
+                (fragment.b[1] == fragment.a[1] && fragment.b[0] > fragment.a[0]));
+            return (upper == (sign > 0) ? 0 : 1);
+        }
+
+        Vector2<Real> GetPosition(int point) const
+        {
+            Point const& p = mPoints[point];
+            if (p.rational < 0)
+            {
+                return { static_cast<Real>(p.position[0]), static_cast<Real>(p.position[1]) };
+            }
+            return
+            {
+                static_cast<Real>(mRationals[p.rational]),
+                static_cast<Real>(mRationals[static_cast<size_t>(p.rational) + 1])
+            };
+        }
+
+        int AddEvent(int point, int fragment, bool isLeft)
+        {
+            Event event;
+            event.point = point;
+            event.fragment = fragment;
+            event.isLeft = isLeft;
+            mEvents.push_back(event);
+            return static_cast<int>(mEvents.size()) - 1;
+        }
+
+        // The intersection of the lines of the input segments of two
+        // fragments that cross at interior points.
+        int AddIntersection(int f0, int f1)
+        {
+            Fragment const& fragment0 = mFragments[f0];
+            Fragment const& fragment1 = mFragments[f1];
+            Rational const a0x(fragment0.a[0]), a0y(fragment0.a[1]);
+            Rational const d0x = Rational(fragment0.b[0]) - a0x;
+            Rational const d0y = Rational(fragment0.b[1]) - a0y;
+            Rational const a1x(fragment1.a[0]), a1y(fragment1.a[1]);
+            Rational const d1x = Rational(fragment1.b[0]) - a1x;
+            Rational const d1y = Rational(fragment1.b[1]) - a1y;
+            Rational const denominator = d0x * d1y - d0y * d1x;
+            Rational const t = ((a1x - a0x) * d1y - (a1y - a0y) * d1x) / denominator;
+
+            Point point;
+            point.rational = static_cast<int>(mRationals.size());
+            point.segment[0] = fragment0.segment;
+            point.segment[1] = fragment1.segment;
+            mRationals.push_back(a0x + t * d0x);
+            mRationals.push_back(a0y + t * d0y);
+            for (int i = 0; i < 2; ++i)
+            {
+                double const value = static_cast<double>(mRationals[static_cast<size_t>(point.rational) + i]);
+                point.position[i] = value;
+                point.error[i] = GetApproximationError(value);
+            }
+            mPoints.push_back(point);
+            return static_cast<int>(mPoints.size()) - 1;
+        }
+
+        // The conversion to 'double' rounds to nearest, so the error is at
+        // most half an ulp. The bound is several ulps so that it absorbs
+        // the rounding errors of the filters that use it.
+        static double GetApproximationError(double value)
+        {
+            return std::ldexp(std::fabs(value), -50) + std::numeric_limits<double>::min();
+        }
+
+        Rational GetCoordinate(int point, int i) const
+        {
+            Point const& p = mPoints[point];
+            if (p.rational < 0)
+            {
+                return Rational(p.position[i]);
+            }
+            return mRationals[static_cast<size_t>(p.rational) + i];
+        }
+
+        // Returns -1, 0 or +1 when p0 precedes, equals or follows p1 in the
+        // sweep order.
+        int ComparePoints(int p0, int p1) const
+        {
+            if (p0 == p1)
+            {
+                return 0;
+            }
+
+            int order = CompareCoordinates(p0, p1, 0);
+            return (order != 0 ? order : CompareCoordinates(p0, p1, 1));
+        }
+
+        int CompareCoordinates(int p0, int p1, int i) const
+        {
+            Point const& point0 = mPoints[p0];
+            Point const& point1 = mPoints[p1];
+            double const value0 = point0.position[i];
+            double const value1 = point1.position[i];
+            if (point0.rational < 0 && point1.rational < 0)
+            {
+                return (value0 < value1 ? -1 : (value0 > value1 ? +1 : 0));
+            }
+            if (value0 + point0.error[i] < value1 - point1.error[i])
+            {
+                return -1;
+            }
+            if (value0 - point0.error[i] > value1 + point1.error[i])
+            {
+                return +1;
+            }
+
+            ++mNumExactQueries;
+            Rational const r0 = GetCoordinate(p0, i);
+            Rational const r1 = GetCoordinate(p1, i);
+            return (r0 < r1 ? -1 : (r1 < r0 ? +1 : 0));
+        }
+
+        // Returns +1 when the point is above the fragment (on the left of
+        // its input segment <a,b>), -1 when it is below and 0 when it is on
+        // the line of the segment. The bound on the rounding error follows
+        // Shewchuk's orient2d bound, generously rounded up, plus the error
+        // of an approximated point.
+        int Orientation(int f, int point) const
+        {
+            Fragment const& fragment = mFragments[f];
+            Point const& p = mPoints[point];
+            if (p.rational < 0 ?
+                (p.position == fragment.a || p.position == fragment.b) :
+                (p.segment[0] == fragment.segment || p.segment[1] == fragment.segment))
+            {
+                return 0;
+            }
+
+            double const dx0 = fragment.b[0] - fragment.a[0];
+            double const dy0 = fragment.b[1] - fragment.a[1];
+            double const dx1 = p.position[0] - fragment.a[0];
+            double const dy1 = p.position[1] - fragment.a[1];
+            double const t0 = dx0 * dy1;
+            double const t1 = dy0 * dx1;
+            double const det = t0 - t1;
+            double const epsilon = std::numeric_limits<double>::epsilon();
+            double const errorBound = 2.0 * epsilon * (std::fabs(t0) + std::fabs(t1)) +
+                2.0 * (std::fabs(dx0) * p.error[1] + std::fabs(dy0) * p.error[0]) +
+                std::numeric_limits<double>::min();
+            if (det > errorBound)
+            {
+                return +1;
+            }
+            if (-det > errorBound)
+            {
+                return -1;
+            }
+
+            ++mNumExactQueries;
+            Rational const ax(fragment.a[0]), ay(fragment.a[1]);
+            Rational const rdet = (Rational(fragment.b[0]) - ax) * (GetCoordinate(point, 1) - ay) -
+                (Rational(fragment.b[1]) - ay) * (GetCoordinate(point, 0) - ax);
+            return rdet.GetSign();
+        }
+
+        // The sign of Cross(b0 - a0, b1 - a1) for the input segments of two
+        // fragments, whose endpoints are exact in 'double'.
+        int CrossSign(Fragment const& fragment0, Fragment const& fragment1) const
+        {
+            double const dx0 = fragment0.b[0] - fragment0.a[0];
+            double const dy0 = fragment0.b[1] - fragment0.a[1];
+            double const dx1 = fragment1.b[0] - fragment1.a[0];
+            double const dy1 = fragment1.b[1] - fragment1.a[1];
+            double const t0 = dx0 * dy1;
+            double const t1 = dy0 * dx1;
+            double const det = t0 - t1;
+            double const epsilon = std::numeric_limits<double>::epsilon();
+            double const errorBound = 2.0 * epsilon * (std::fabs(t0) + std::fabs(t1)) +
+                std::numeric_limits<double>::min();
+            if (det > errorBound)
+            {
+                return +1;
+            }
+            if (-det > errorBound)
+            {
+                return -1;
+            }
+
+            ++mNumExactQueries;
+            Rational const rdet =
+                (Rational(fragment0.b[0]) - Rational(fragment0.a[0])) *
+                (Rational(fragment1.b[1]) - Rational(fragment1.a[1])) -
+                (Rational(fragment0.b[1]) - Rational(fragment0.a[1])) *
+                (Rational(fragment1.b[0]) - Rational(fragment1.a[0]));
+            return rdet.GetSign();
+        }
+
+        // The event order: by point, then right events before left events,
+        // then the event of the lower fragment first, then by fragment
+        // index for collinear fragments.
+        bool IsEventAfter(int e0, int e1) const
+        {
+            Event const& event0 = mEvents[e0];
+            Event const& event1 = mEvents[e1];
+            int order = ComparePoints(event0.point, event1.point);
+            if (order != 0)
+            {
+                return order > 0;
+            }
+
+            if (event0.isLeft != event1.isLeft)
+            {
+                return event0.isLeft;
+            }
+
+            Fragment const& fragment1 = mFragments[event1.fragment];
+            int const other1 = (event1.isLeft ? fragment1.right : fragment1.left);
+            int const orientation = Orientation(event0.fragment, other1);
+            if (orientation != 0)
+            {
+                return orientation < 0;
+            }
+            return event0.fragment > event1.fragment;
+        }
+
+        // The order of the fragments that intersect the sweep line.
+        bool IsBelow(int f0, int f1) const
+        {
+            if (f0 == f1)
+            {
+                return false;
+            }
+
+            Fragment const& fragment0 = mFragments[f0];
+            Fragment const& fragment1 = mFragments[f1];
+            int const o0 = Orientation(f0, fragment1.left);
+            int const o1 = Orientation(f0, fragment1.right);
+            if (o0 != 0 || o1 != 0)
+            {
+                int const order = ComparePoints(fragment0.left, fragment1.left);
+                if (order == 0)
+                {
+                    // The fragments share their left endpoint.
+                    return o1 > 0;
+                }
+
+                if (CompareCoordinates(fragment0.left, fragment1.left, 0) == 0)
+                {
+                    // The left endpoints are on the same vertical line.
+                    return order < 0;
+                }
+
+                if (order > 0)
+                {
+                    // Fragment 0 was inserted after fragment 1.
+                    return Orientation(f1, fragment0.left) <= 0;
+                }
+                return o0 > 0;
+            }
+
+            // The fragments are collinear.
+            int const order = ComparePoints(fragment0.left, fragment1.left);
+            if (order == 0)
+            {
+                return f0 < f1;
+            }
+            return order > 0;
+        }
+
+        Operation mOperation;
+        FillRule mFillRule[2];
+        std::vector<Point> mPoints;
+        std::vector<Rational> mRationals;
+        std::vector<Fragment> mFragments;
+        std::vector<Event> mEvents;
+        std::vector<int> mVertexPoints;
+        mutable size_t mNumExactQueries;
+    };
+}
@@ -3,140 +3,347 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <Mathematics/Logger.h>
 #include <Mathematics/Matrix3x3.h>
+#include <Mathematics/SIMD4.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
 
 namespace gte
 {
-    // The input triangle mesh must represent a polyhedron.  The triangles are
-    // represented as triples of indices <V0,V1,V2> into the vertex array.
-    // The index array has numTriangles such triples.  The Boolean value
-    // 'bodyCoords is' 'true' if you want the inertia tensor to be relative to
-    // body coordinates but 'false' if you want it to be relative to world
-    // coordinates.
-    //
-    // The code assumes the rigid body has a constant density of 1.  If your
-    // application assigns a constant density of 'd', then you must multiply
-    // the output 'mass' by 'd' and the output 'inertia' by 'd'.
+    // Mass properties of polyhedra with the conventions described for
+    // ComputeMassProperties at the end of this file, for large meshes
+    // partitioned among threads and for many meshes. The triangles are
+    // processed 4 at a time in SIMD4Value<Real> registers, so the order of
+    // the additions, and therefore the rounding errors, differ from those of
+    // a summation of one triangle at a time.
 
     template <typename Real>
-    void ComputeMassProperties(Vector3<Real> const* vertices, int numTriangles,
-        int const* indices, bool bodyCoords, Real& mass, Vector3<Real>& center,
-        Matrix3x3<Real>& inertia)
+    class PolyhedralMassProperties
     {
-        Real const oneDiv6 = (Real)1 / (Real)6;
-        Real const oneDiv24 = (Real)1 / (Real)24;
-        Real const oneDiv60 = (Real)1 / (Real)60;
-        Real const oneDiv120 = (Real)1 / (Real)120;
+    public:
+        // The mass properties of one polyhedron, the triangles partitioned
+        // into numThreads contiguous ranges that are processed by the
+        // scheduler or, when it is null, by std::thread objects. For a
+        // scheduler, numThreads is replaced by the number of threads of the
+        // scheduler. The partial integrals are added in the order of the
+        // ranges, so the results depend only on the number of ranges.
+        static void Compute(Vector3<Real> const* vertices, int numTriangles,
+            int const* indices, bool bodyCoords, Real& mass, Vector3<Real>& center,
+            Matrix3x3<Real>& inertia, size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            size_t const numElements = static_cast<size_t>(std::max(numTriangles, 0));
+            size_t const numChunks = GetNumChunks(numElements, numThreads, scheduler);
+            std::vector<Integrals> partial(numChunks, Zero());
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [vertices, indices, numElements, numChunks, &partial](size_t chunk)
+                {
+                    size_t const tmin = numElements * chunk / numChunks;
+                    size_t const tmax = numElements * (chunk + 1) / numChunks;
+                    Accumulate(vertices, indices, tmin, tmax, partial[chunk]);
+                });
+
+            Integrals integral = partial[0];
+            for (size_t chunk = 1; chunk < numChunks; ++chunk)
+            {
+                Add(partial[chunk], integral);
+            }
+            Finish(integral, bodyCoords, mass, center, inertia);
+        }
 
+        // The mass properties of numMeshes polyhedra, for example the
+        // pieces of a convex decomposition, whose triangles are stored
+        // consecutively in one index array. The triangles of mesh m are
+        // those with indices t in [triangleOffsets[m],triangleOffsets[m+1]),
+        // so triangleOffsets has numMeshes+1 elements. The output arrays
+        // have numMeshes elements. The meshes are partitioned among the
+        // threads, each mesh processed by one thread, which is efficient
+        // for many small meshes.
+        static void ComputeBatch(Vector3<Real> const* vertices, int numMeshes,
+            int const* triangleOffsets, int const* indices, bool bodyCoords, Real* masses,
+            Vector3<Real>* centers, Matrix3x3<Real>* inertias, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            size_t const numElements = static_cast<size_t>(std::max(numMeshes, 0));
+            size_t const numChunks = GetNumChunks(numElements, numThreads, scheduler);
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [=](size_t chunk)
+                {
+                    size_t const mmin = numElements * chunk / numChunks;
+                    size_t const mmax = numElements * (chunk + 1) / numChunks;
+                    for (size_t m = mmin; m < mmax; ++m)
+                    {
+                        Integrals integral = Zero();
+                        Accumulate(vertices, indices,
+                            static_cast<size_t>(triangleOffsets[m]),
+                            static_cast<size_t>(triangleOffsets[m + 1]), integral);
+                        Finish(integral, bodyCoords, masses[m], centers[m], inertias[m]);
+                    }
+                });
+        }
+
+        // The mass properties of the numComponents polyhedra of a mesh
+        // whose triangles are labeled by component, triangle t belonging to
+        // polyhedron components[t] in {0..numComponents-1}. The triangles
+        // are visited once, partitioned among the threads as in Compute,
+        // and each thread accumulates the integrals of all components. The
+        // output arrays have numComponents elements.
+        static void ComputeComponents(Vector3<Real> const* vertices, int numTriangles,
+            int const* indices, int const* components, int numComponents, bool bodyCoords,
+            Real* masses, Vector3<Real>* centers, Matrix3x3<Real>* inertias,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            size_t const numElements = static_cast<size_t>(std::max(numTriangles, 0));
+            size_t const numLabels = static_cast<size_t>(std::max(numComponents, 0));
+            size_t const numChunks = GetNumChunks(numElements, numThreads, scheduler);
+            std::vector<std::vector<Integrals>> partial(numChunks,
+                std::vector<Integrals>(numLabels, Zero()));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [vertices, indices, components, numElements, numChunks, &partial](size_t chunk)
+                {
+                    size_t const tmin = numElements * chunk / numChunks;
+                    size_t const tmax = numElements * (chunk + 1) / numChunks;
+                    std::vector<Integrals>& integrals = partial[chunk];
+                    for (size_t t = tmin; t < tmax; ++t)
+                    {
+                        LogAssert(components[t] >= 0 &&
+                            static_cast<size_t>(components[t]) < integrals.size(),
+                            "Invalid component.");
+                        AccumulateScalar(vertices, &indices[3 * t], integrals[components[t]]);
+                    }
+                });
+
+            for (size_t c = 0; c < numLabels; ++c)
+            {
+                Integrals integral = partial[0][c];
+                for (size_t chunk = 1; chunk < numChunks; ++chunk)
+                {
+                    Add(partial[chunk][c], integral);
+                }
+                Finish(integral, bodyCoords, masses[c], centers[c], inertias[c]);
+            }
+        }
+
+    private:
         // order:  1, x, y, z, x^2, y^2, z^2, xy, yz, zx
-        std::array<Real, 10> integral;
-        integral.fill((Real)0);
+        typedef std::array<Real, 10> Integrals;
+        typedef SIMD4<Real> S;
+        typedef SIMD4Value<Real> V;
+
+        static Integrals Zero()
+        {
+            Integrals integral;
+            integral.fill((Real)0);
+            return integral;
+        }
+
+        static void Add(Integrals const& source, Integrals& target)
+        {
+            for (size_t k = 0; k < 10; ++k)
+            {
+                target[k] += source[k];
+            }
+        }
+
+        static size_t GetNumChunks(size_t numElements, size_t numThreads,
+            TaskScheduler* scheduler)
+        {
+            if (scheduler != nullptr)
+            {
+                numThreads = static_cast<size_t>(scheduler->GetNumThreads());
+            }
+            return std::max(std::min(numThreads, numElements), static_cast<size_t>(1));
+        }
 
-        int const* index = indices;
-        for (int i = 0; i < numTriangles; ++i)
+        // The subexpressions of the integral terms for one coordinate of a
+        // triangle. The function is used for both Real and V.
+        template <typename T>
+        static void Subexpressions(T const& w0, T const& w1, T const& w2,
+            T& f1, T& f2, T& f3, T& g0, T& g1, T& g2)
         {
-            // Get vertices of triangle i.
-            Vector3<Real> v0 = vertices[*index++];
-            Vector3<Real> v1 = vertices[*index++];
-            Vector3<Real> v2 = vertices[*index++];
+            T tmp0 = w0 + w1;
+            f1 = tmp0 + w2;
+            T tmp1 = w0 * w0;
+            T tmp2 = tmp1 + w1 * tmp0;
+            f2 = tmp2 + w2 * f1;
+            f3 = w0 * tmp1 + w1 * tmp2 + w2 * f2;
+            g0 = f2 + w0 * (f1 + w0);
+            g1 = f2 + w1 * (f1 + w1);
+            g2 = f2 + w2 * (f1 + w2);
+        }
 
+        // Add the integral terms of one triangle, whose vertex coordinates
+        // are v[i][j] for vertex i and coordinate j, to 'integral'. The
+        // function is used for both Real and V.
+        template <typename T>
+        static void AddTerms(std::array<std::array<T, 3>, 3> const& v,
+            std::array<T, 10>& integral)
+        {
             // Get cross product of edges and normal vector.
-            Vector3<Real> V1mV0 = v1 - v0;
-            Vector3<Real> V2mV0 = v2 - v0;
-            Vector3<Real> N = Cross(V1mV0, V2mV0);
+            std::array<T, 3> e1, e2;
+            for (int j = 0; j < 3; ++j)
+            {
+                e1[j] = v[1][j] - v[0][j];
+                e2[j] = v[2][j] - v[0][j];
+            }
+            T N0 = e1[1] * e2[2] - e1[2] * e2[1];
+            T N1 = e1[2] * e2[0] - e1[0] * e2[2];
+            T N2 = e1[0] * e2[1] - e1[1] * e2[0];
 
             // Compute integral terms.
-            Real tmp0, tmp1, tmp2;
-            Real f1x, f2x, f3x, g0x, g1x, g2x;
-            tmp0 = v0[0] + v1[0];
-            f1x = tmp0 + v2[0];
-            tmp1 = v0[0] * v0[0];
-            tmp2 = tmp1 + v1[0] * tmp0;
-            f2x = tmp2 + v2[0] * f1x;
-            f3x = v0[0] * tmp1 + v1[0] * tmp2 + v2[0] * f2x;
-            g0x = f2x + v0[0] * (f1x + v0[0]);
-            g1x = f2x + v1[0] * (f1x + v1[0]);
-            g2x = f2x + v2[0] * (f1x + v2[0]);
-
-            Real f1y, f2y, f3y, g0y, g1y, g2y;
-            tmp0 = v0[1] + v1[1];
-            f1y = tmp0 + v2[1];
-            tmp1 = v0[1] * v0[1];
-            tmp2 = tmp1 + v1[1] * tmp0;
-            f2y = tmp2 + v2[1] * f1y;
-            f3y = v0[1] * tmp1 + v1[1] * tmp2 + v2[1] * f2y;
-            g0y = f2y + v0[1] * (f1y + v0[1]);
-            g1y = f2y + v1[1] * (f1y + v1[1]);
-            g2y = f2y + v2[1] * (f1y + v2[1]);
-
-            Real f1z, f2z, f3z, g0z, g1z, g2z;
-            tmp0 = v0[2] + v1[2];
-            f1z = tmp0 + v2[2];
-            tmp1 = v0[2] * v0[2];
-            tmp2 = tmp1 + v1[2] * tmp0;
-            f2z = tmp2 + v2[2] * f1z;
-            f3z = v0[2] * tmp1 + v1[2] * tmp2 + v2[2] * f2z;
-            g0z = f2z + v0[2] * (f1z + v0[2]);
-            g1z = f2z + v1[2] * (f1z + v1[2]);
-            g2z = f2z + v2[2] * (f1z + v2[2]);
+            T f1x, f2x, f3x, g0x, g1x, g2x;
+            Subexpressions(v[0][0], v[1][0], v[2][0], f1x, f2x, f3x, g0x, g1x, g2x);
+            T f1y, f2y, f3y, g0y, g1y, g2y;
+            Subexpressions(v[0][1], v[1][1], v[2][1], f1y, f2y, f3y, g0y, g1y, g2y);
+            T f1z, f2z, f3z, g0z, g1z, g2z;
+            Subexpressions(v[0][2], v[1][2], v[2][2], f1z, f2z, f3z, g0z, g1z, g2z);
 
             // Update integrals.
-            integral[0] += N[0] * f1x;
-            integral[1] += N[0] * f2x;
-            integral[2] += N[1] * f2y;
-            integral[3] += N[2] * f2z;
-            integral[4] += N[0] * f3x;
-            integral[5] += N[1] * f3y;
-            integral[6] += N[2] * f3z;
-            integral[7] += N[0] * (v0[1] * g0x + v1[1] * g1x + v2[1] * g2x);
-            integral[8] += N[1] * (v0[2] * g0y + v1[2] * g1y + v2[2] * g2y);
-            integral[9] += N[2] * (v0[0] * g0z + v1[0] * g1z + v2[0] * g2z);
+            integral[0] = integral[0] + N0 * f1x;
+            integral[1] = integral[1] + N0 * f2x;
+            integral[2] = integral[2] + N1 * f2y;
+            integral[3] = integral[3] + N2 * f2z;
+            integral[4] = integral[4] + N0 * f3x;
+            integral[5] = integral[5] + N1 * f3y;
+            integral[6] = integral[6] + N2 * f3z;
+            integral[7] = integral[7] + N0 * (v[0][1] * g0x + v[1][1] * g1x + v[2][1] * g2x);
+            integral[8] = integral[8] + N1 * (v[0][2] * g0y + v[1][2] * g1y + v[2][2] * g2y);
+            integral[9] = integral[9] + N2 * (v[0][0] * g0z + v[1][0] * g1z + v[2][0] * g2z);
+        }
+
+        static void AccumulateScalar(Vector3<Real> const* vertices, int const* triangle,
+            Integrals& integral)
+        {
+            std::array<std::array<Real, 3>, 3> v;
+            for (int i = 0; i < 3; ++i)
+            {
+                Vector3<Real> const& vertex = vertices[triangle[i]];
+                v[i] = { vertex[0], vertex[1], vertex[2] };
+            }
+            AddTerms(v, integral);
+        }
+
+        // Add the integral terms of the triangles t in [tmin,tmax) to
+        // 'integral'. The triangles are processed 4 at a time, lane j of
+        // the registers storing triangle t+j. The lanes past tmax store the
+        // triangle whose vertices are all zero, whose terms are zero.
+        static void Accumulate(Vector3<Real> const* vertices, int const* indices,
+            size_t tmin, size_t tmax, Integrals& integral)
+        {
+            std::array<V, 10> sums;
+            sums.fill(V((Real)0));
+            for (size_t t = tmin; t < tmax; t += 4)
+            {
+                std::array<std::array<std::array<Real, 4>, 3>, 3> coordinates{};
+                size_t const count = std::min(tmax - t, static_cast<size_t>(4));
+                for (size_t lane = 0; lane < count; ++lane)
+                {
+                    int const* triangle = &indices[3 * (t + lane)];
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        Vector3<Real> const& vertex = vertices[triangle[i]];
+                        for (int j = 0; j < 3; ++j)
+                        {
+                            coordinates[i][j][lane] = vertex[j];
+                        }
+                    }
+                }
+
+                std::array<std::array<V, 3>, 3> v;
+                for (int i = 0; i < 3; ++i)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        v[i][j] = V(S::Load(coordinates[i][j].data()));
+                    }
+                }
+                AddTerms(v, sums);
+            }
+
+            for (size_t k = 0; k < 10; ++k)
+            {
+                std::array<Real, 4> lanes;
+                S::Store(lanes.data(), sums[k].value);
+                integral[k] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            }
         }
 
-        integral[0] *= oneDiv6;
-        integral[1] *= oneDiv24;
-        integral[2] *= oneDiv24;
-        integral[3] *= oneDiv24;
-        integral[4] *= oneDiv60;
-        integral[5] *= oneDiv60;
-        integral[6] *= oneDiv60;
-        integral[7] *= oneDiv120;
-        integral[8] *= oneDiv120;
-        integral[9] *= oneDiv120;
-
-        // mass
-        mass = integral[0];
-
-        // center of mass
-        center = Vector3<Real>{ integral[1], integral[2], integral[3] } / mass;
-
-        // inertia relative to world origin
-        inertia(0, 0) = integral[5] + integral[6];
-        inertia(0, 1) = -integral[7];
-        inertia(0, 2) = -integral[9];
-        inertia(1, 0) = inertia(0, 1);
-        inertia(1, 1) = integral[4] + integral[6];
-        inertia(1, 2) = -integral[8];
-        inertia(2, 0) = inertia(0, 2);
-        inertia(2, 1) = inertia(1, 2);
-        inertia(2, 2) = integral[4] + integral[5];
-
-        // inertia relative to center of mass
-        if (bodyCoords)
+        static void Finish(Integrals integral, bool bodyCoords, Real& mass,
+            Vector3<Real>& center, Matrix3x3<Real>& inertia)
         {
-            inertia(0, 0) -= mass * (center[1] * center[1] + center[2] * center[2]);
-            inertia(0, 1) += mass * center[0] * center[1];
-            inertia(0, 2) += mass * center[2] * center[0];
+            Real const oneDiv6 = (Real)1 / (Real)6;
+            Real const oneDiv24 = (Real)1 / (Real)24;
+            Real const oneDiv60 = (Real)1 / (Real)60;
+            Real const oneDiv120 = (Real)1 / (Real)120;
+
+            integral[0] *= oneDiv6;
+            integral[1] *= oneDiv24;
+            integral[2] *= oneDiv24;
+            integral[3] *= oneDiv24;
+            integral[4] *= oneDiv60;
+            integral[5] *= oneDiv60;
+            integral[6] *= oneDiv60;
+            integral[7] *= oneDiv120;
+            integral[8] *= oneDiv120;
+            integral[9] *= oneDiv120;
+
+            // mass
+            mass = integral[0];
+
+            // center of mass
+            center = Vector3<Real>{ integral[1], integral[2], integral[3] } / mass;
+
+            // inertia relative to world origin
+            inertia(0, 0) = integral[5] + integral[6];
+            inertia(0, 1) = -integral[7];
+            inertia(0, 2) = -integral[9];
             inertia(1, 0) = inertia(0, 1);
-            inertia(1, 1) -= mass * (center[2] * center[2] + center[0] * center[0]);
-            inertia(1, 2) += mass * center[1] * center[2];
+            inertia(1, 1) = integral[4] + integral[6];
+            inertia(1, 2) = -integral[8];
             inertia(2, 0) = inertia(0, 2);
             inertia(2, 1) = inertia(1, 2);
-            inertia(2, 2) -= mass * (center[0] * center[0] + center[1] * center[1]);
+            inertia(2, 2) = integral[4] + integral[5];
+
+            // inertia relative to center of mass
+            if (bodyCoords)
+            {
+                inertia(0, 0) -= mass * (center[1] * center[1] + center[2] * center[2]);
+                inertia(0, 1) += mass * center[0] * center[1];
+                inertia(0, 2) += mass * center[2] * center[0];
+                inertia(1, 0) = inertia(0, 1);
+                inertia(1, 1) -= mass * (center[2] * center[2] + center[0] * center[0]);
+                inertia(1, 2) += mass * center[1] * center[2];
+                inertia(2, 0) = inertia(0, 2);
+                inertia(2, 1) = inertia(1, 2);
+                inertia(2, 2) -= mass * (center[0] * center[0] + center[1] * center[1]);
+            }
         }
+    };
+
+    // The input triangle mesh must represent a polyhedron.  The triangles are
+    // represented as triples of indices <V0,V1,V2> into the vertex array.
+    // The index array has numTriangles such triples.  The Boolean value
+    // 'bodyCoords is' 'true' if you want the inertia tensor to be relative to
+    // body coordinates but 'false' if you want it to be relative to world
+    // coordinates.
+    //
+    // The code assumes the rigid body has a constant density of 1.  If your
+    // application assigns a constant density of 'd', then you must multiply
+    // the output 'mass' by 'd' and the output 'inertia' by 'd'.
+
+    template <typename Real>
+    void ComputeMassProperties(Vector3<Real> const* vertices, int numTriangles,
+        int const* indices, bool bodyCoords, Real& mass, Vector3<Real>& center,
+        Matrix3x3<Real>& inertia)
+    {
+        PolyhedralMassProperties<Real>::Compute(vertices, numTriangles, indices,
+            bodyCoords, mass, center, inertia);
     }
 }
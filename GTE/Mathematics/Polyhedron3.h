@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -110,7 +110,7 @@ namespace gte
             Vector3<Real> average = Vector3<Real>::Zero();
             if (mVertexPool)
             {
-                auto vertexPool = GetVertices();
+                auto const& vertexPool = GetVertices();
                 for (int index : mUniqueIndices)
                 {
                     average += vertexPool[index];
@@ -125,7 +125,7 @@ namespace gte
             Real surfaceArea(0);
             if (mVertexPool)
             {
-                auto vertexPool = GetVertices();
+                auto const& vertexPool = GetVertices();
                 int const numTriangles = static_cast<int>(mIndices.size()) / 3;
                 int const* indices = mIndices.data();
                 for (int t = 0; t < numTriangles; ++t)
@@ -148,7 +148,7 @@ namespace gte
             Real volume(0);
             if (mVertexPool)
             {
-                auto vertexPool = GetVertices();
+                auto const& vertexPool = GetVertices();
                 int const numTriangles = static_cast<int>(mIndices.size()) / 3;
                 int const* indices = mIndices.data();
                 for (int t = 0; t < numTriangles; ++t)
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -48,6 +48,7 @@ namespace gte
             mDer1Polynomial[i] = mPolynomial[i].GetDerivative();
             mDer2Polynomial[i] = mDer1Polynomial[i].GetDerivative();
             mDer3Polynomial[i] = mDer2Polynomial[i].GetDerivative();
+            this->InvalidateArcLengthTable();
         }
 
         inline Polynomial1<Real> const& GetPolynomial(int i) const
@@ -0,0 +1,296 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BSNumber.h>
+#include <Mathematics/Vector3.h>
+#include <array>
+
+// The queries ToPlane, ToTetrahedron and ToCircumsphere of PrimalQuery3
+// evaluated with scratch registers that are members of the class. The
+// queries of PrimalQuery3 create a local Real object for each intermediate
+// value of the expressions, so for BSNumber<UIntegerAP32> each call
+// allocates and frees the storage of several dozen numbers. An object of
+// this class owns the registers for the largest expression, ToCircumsphere,
+// and for BSNumber the results of the operations are computed in place
+// using BSNumber::Add, Sub and Mul. The storage of the registers grows to
+// the size required by the input and then is reused by all later calls.
+// For other Real types, the registers are assigned the results of the
+// usual operators. The signs returned by the queries are those returned by
+// PrimalQuery3.
+//
+// An object of this class is not thread-safe, because the queries modify
+// the registers. Use one object per thread.
+
+namespace gte
+{
+    template <typename Real>
+    class PrimalQueryEvaluator3
+    {
+    public:
+        // The caller is responsible for ensuring that the array is not empty
+        // before calling queries and that the indices passed to the queries
+        // are valid. The class does no range checking.
+        PrimalQueryEvaluator3()
+            :
+            mNumVertices(0),
+            mVertices(nullptr)
+        {
+        }
+
+        PrimalQueryEvaluator3(int numVertices, Vector3<Real> const* vertices)
+            :
+            mNumVertices(numVertices),
+            mVertices(vertices)
+        {
+        }
+
+        // Member access.
+        inline void Set(int numVertices, Vector3<Real> const* vertices)
+        {
+            mNumVertices = numVertices;
+            mVertices = vertices;
+        }
+
+        inline int GetNumVertices() const
+        {
+            return mNumVertices;
+        }
+
+        inline Vector3<Real> const* GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // The queries have the same semantics as those of PrimalQuery3.
+        int ToPlane(int i, int v0, int v1, int v2)
+        {
+            return ToPlane(mVertices[i], v0, v1, v2);
+        }
+
+        int ToPlane(Vector3<Real> const& test, int v0, int v1, int v2)
+        {
+            Vector3<Real> const& vec0 = mVertices[v0];
+            Vector3<Real> const& vec1 = mVertices[v1];
+            Vector3<Real> const& vec2 = mVertices[v2];
+
+            // The registers for the differences are those of x[0..2],
+            // y[0..2] and z[0..2] of ToCircumsphere.
+            Real* x = &mRegister[X];
+            Real* y = &mRegister[Y];
+            Real* z = &mRegister[Z];
+            Sub(test[0], vec0[0], x[0]);
+            Sub(test[1], vec0[1], y[0]);
+            Sub(test[2], vec0[2], z[0]);
+            Sub(vec1[0], vec0[0], x[1]);
+            Sub(vec1[1], vec0[1], y[1]);
+            Sub(vec1[2], vec0[2], z[1]);
+            Sub(vec2[0], vec0[0], x[2]);
+            Sub(vec2[1], vec0[1], y[2]);
+            Sub(vec2[2], vec0[2], z[2]);
+
+            // c0 = y1*z2 - y2*z1, c1 = y2*z0 - y0*z2, c2 = y0*z1 - y1*z0
+            Real* c = &mRegister[A];
+            Det2(y[1], z[2], y[2], z[1], c[0]);
+            Det2(y[2], z[0], y[0], z[2], c[1]);
+            Det2(y[0], z[1], y[1], z[0], c[2]);
+
+            // det = x0*c0 + x1*c1 + x2*c2
+            Real& product = mRegister[PRODUCT0];
+            Real& sum0 = mRegister[SUM0];
+            Real& sum1 = mRegister[SUM1];
+            Mul(x[0], c[0], sum0);
+            Mul(x[1], c[1], product);
+            Add(sum0, product, sum1);
+            Mul(x[2], c[2], product);
+            Add(sum1, product, sum0);
+            return GetSign(sum0);
+        }
+
+        int ToTetrahedron(int i, int v0, int v1, int v2, int v3)
+        {
+            return ToTetrahedron(mVertices[i], v0, v1, v2, v3);
+        }
+
+        int ToTetrahedron(Vector3<Real> const& test, int v0, int v1, int v2, int v3)
+        {
+            int sign0 = ToPlane(test, v1, v2, v3);
+            if (sign0 > 0)
+            {
+                return +1;
+            }
+
+            int sign1 = ToPlane(test, v0, v2, v3);
+            if (sign1 < 0)
+            {
+                return +1;
+            }
+
+            int sign2 = ToPlane(test, v0, v1, v3);
+            if (sign2 > 0)
+            {
+                return +1;
+            }
+
+            int sign3 = ToPlane(test, v0, v1, v2);
+            if (sign3 < 0)
+            {
+                return +1;
+            }
+
+            return ((sign0 && sign1 && sign2 && sign3) ? -1 : 0);
+        }
+
+        int ToCircumsphere(int i, int v0, int v1, int v2, int v3)
+        {
+            return ToCircumsphere(mVertices[i], v0, v1, v2, v3);
+        }
+
+        int ToCircumsphere(Vector3<Real> const& test, int v0, int v1, int v2, int v3)
+        {
+            std::array<Vector3<Real> const*, 4> const vec =
+            {
+                &mVertices[v0], &mVertices[v1], &mVertices[v2], &mVertices[v3]
+            };
+
+            // For each vertex k, compute the differences x[k], y[k], z[k]
+            // of vertex and test point and
+            //   w[k] = (vk0+t0)*x[k] + (vk1+t1)*y[k] + (vk2+t2)*z[k]
+            Real* x = &mRegister[X];
+            Real* y = &mRegister[Y];
+            Real* z = &mRegister[Z];
+            Real* w = &mRegister[W];
+            Real& product0 = mRegister[PRODUCT0];
+            Real& product1 = mRegister[PRODUCT1];
+            Real& sum0 = mRegister[SUM0];
+            Real& sum1 = mRegister[SUM1];
+            for (int k = 0; k < 4; ++k)
+            {
+                Vector3<Real> const& vk = *vec[k];
+                Sub(vk[0], test[0], x[k]);
+                Sub(vk[1], test[1], y[k]);
+                Sub(vk[2], test[2], z[k]);
+                Add(vk[0], test[0], sum0);
+                Mul(sum0, x[k], product0);
+                Add(vk[1], test[1], sum0);
+                Mul(sum0, y[k], product1);
+                Add(product0, product1, sum1);
+                Add(vk[2], test[2], sum0);
+                Mul(sum0, z[k], product0);
+                Add(sum1, product0, w[k]);
+            }
+
+            // a[m] = x[i]*y[j] - x[j]*y[i] and b[m] = z[i]*w[j] - z[j]*w[i]
+            // for the index pairs (i,j) = (0,1), (0,2), (0,3), (1,2), (1,3)
+            // and (2,3).
+            Real* a = &mRegister[A];
+            Real* b = &mRegister[B];
+            static int const pairs[6][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 } };
+            for (int m = 0; m < 6; ++m)
+            {
+                int const i = pairs[m][0], j = pairs[m][1];
+                Det2(x[i], y[j], x[j], y[i], a[m]);
+                Det2(z[i], w[j], z[j], w[i], b[m]);
+            }
+
+            // det = a0*b5 - a1*b4 + a2*b3 + a3*b2 - a4*b1 + a5*b0
+            Mul(a[0], b[5], sum0);
+            Mul(a[1], b[4], product0);
+            Sub(sum0, product0, sum1);
+            Mul(a[2], b[3], product0);
+            Add(sum1, product0, sum0);
+            Mul(a[3], b[2], product0);
+            Add(sum0, product0, sum1);
+            Mul(a[4], b[1], product0);
+            Sub(sum1, product0, sum0);
+            Mul(a[5], b[0], product0);
+            Add(sum0, product0, sum1);
+            return GetSign(sum1);
+        }
+
+    private:
+        // The register layout. The ToPlane registers overlap those of
+        // ToCircumsphere.
+        enum
+        {
+            X = 0,
+            Y = X + 4,
+            Z = Y + 4,
+            W = Z + 4,
+            A = W + 4,
+            B = A + 6,
+            PRODUCT0 = B + 6,
+            PRODUCT1,
+            SUM0,
+            SUM1,
+            NUM_REGISTERS
+        };
+
+        // result = a0*a1 - b0*b1
+        void Det2(Real const& a0, Real const& a1, Real const& b0, Real const& b1, Real& result)
+        {
+            Real& product0 = mRegister[PRODUCT0];
+            Real& product1 = mRegister[PRODUCT1];
+            Mul(a0, a1, product0);
+            Mul(b0, b1, product1);
+            Sub(product0, product1, result);
+        }
+
+        // In-place arithmetic for BSNumber.
+        template <typename UInteger>
+        inline void Add(BSNumber<UInteger> const& n0, BSNumber<UInteger> const& n1,
+            BSNumber<UInteger>& result)
+        {
+            BSNumber<UInteger>::Add(n0, n1, result, mTemp);
+        }
+
+        template <typename UInteger>
+        inline void Sub(BSNumber<UInteger> const& n0, BSNumber<UInteger> const& n1,
+            BSNumber<UInteger>& result)
+        {
+            BSNumber<UInteger>::Sub(n0, n1, result, mTemp);
+        }
+
+        template <typename UInteger>
+        inline void Mul(BSNumber<UInteger> const& n0, BSNumber<UInteger> const& n1,
+            BSNumber<UInteger>& result)
+        {
+            BSNumber<UInteger>::Mul(n0, n1, result);
+        }
+
+        // The arithmetic for all other types.
+        template <typename T>
+        inline void Add(T const& n0, T const& n1, T& result)
+        {
+            result = n0 + n1;
+        }
+
+        template <typename T>
+        inline void Sub(T const& n0, T const& n1, T& result)
+        {
+            result = n0 - n1;
+        }
+
+        template <typename T>
+        inline void Mul(T const& n0, T const& n1, T& result)
+        {
+            result = n0 * n1;
+        }
+
+        inline static int GetSign(Real const& value)
+        {
+            Real const zero(0);
+            return (value > zero ? +1 : (value < zero ? -1 : 0));
+        }
+
+        int mNumVertices;
+        Vector3<Real> const* mVertices;
+        std::array<Real, NUM_REGISTERS> mRegister;
+        Real mTemp;
+    };
+}
@@ -0,0 +1,316 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/SIntegerFixed32.h>
+#include <Mathematics/Vector2.h>
+#include <Mathematics/Vector3.h>
+
+// Exact queries of PrimalQuery2 and PrimalQuery3 for 'float' input,
+// computed with fixed-size integers rather than with BSNumber. Every finite
+// 'float' number x is an integer multiple of 2^{-149}, so x * 2^{149} is an
+// integer of at most 277 bits, and the expressions of the queries are
+// polynomials in the scaled inputs. The polynomials are evaluated with
+// SIntegerFixed32, whose result types are sized at compile time for the
+// worst case, so the signs are exact for all finite inputs, including
+// subnormals, and no memory is allocated. The numbers of 32-bit words of
+// the determinants are those listed for BSNumber and 'float' input in
+// PrimalQuery2 and PrimalQuery3: ToLine 18, ToCircumcircle 35, ToPlane 27
+// and ToCircumsphere 44. The return values are those of PrimalQuery2 and
+// PrimalQuery3 with an exact compute type.
+//
+// For 'double' input, the scaled inputs have up to 2098 bits, and the
+// fixed-size words of the determinants would be mostly zero for typical
+// data, so use PrimalQuery2 and PrimalQuery3 with BSNumber, whose storage
+// grows only to the size required by the data.
+
+namespace gte
+{
+    class PrimalQuery2Float
+    {
+    public:
+        using Input = SIntegerFixed32<277>;
+
+        // The caller is responsible for ensuring that the array is not empty
+        // before calling queries and that the indices passed to the queries
+        // are valid. The class does no range checking.
+        PrimalQuery2Float()
+            :
+            mNumVertices(0),
+            mVertices(nullptr)
+        {
+        }
+
+        PrimalQuery2Float(int numVertices, Vector2<float> const* vertices)
+            :
+            mNumVertices(numVertices),
+            mVertices(vertices)
+        {
+        }
+
+        // Member access.
+        inline void Set(int numVertices, Vector2<float> const* vertices)
+        {
+            mNumVertices = numVertices;
+            mVertices = vertices;
+        }
+
+        inline int GetNumVertices() const
+        {
+            return mNumVertices;
+        }
+
+        inline Vector2<float> const* GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // The queries have the same semantics as those of PrimalQuery2.
+        int ToLine(int i, int v0, int v1) const
+        {
+            return ToLine(mVertices[i], v0, v1);
+        }
+
+        int ToLine(Vector2<float> const& test, int v0, int v1) const
+        {
+            Vector2<float> const& vec0 = mVertices[v0];
+            Vector2<float> const& vec1 = mVertices[v1];
+            Input const p0 = Input::FromFloat(test[0]);
+            Input const p1 = Input::FromFloat(test[1]);
+            Input const v00 = Input::FromFloat(vec0[0]);
+            Input const v01 = Input::FromFloat(vec0[1]);
+            Input const v10 = Input::FromFloat(vec1[0]);
+            Input const v11 = Input::FromFloat(vec1[1]);
+
+            auto const x0 = p0 - v00;
+            auto const y0 = p1 - v01;
+            auto const x1 = v10 - v00;
+            auto const y1 = v11 - v01;
+            auto const det = x0 * y1 - x1 * y0;
+            return det.GetSign();
+        }
+
+        int ToTriangle(int i, int v0, int v1, int v2) const
+        {
+            return ToTriangle(mVertices[i], v0, v1, v2);
+        }
+
+        int ToTriangle(Vector2<float> const& test, int v0, int v1, int v2) const
+        {
+            int sign0 = ToLine(test, v1, v2);
+            if (sign0 > 0)
+            {
+                return +1;
+            }
+
+            int sign1 = ToLine(test, v0, v2);
+            if (sign1 < 0)
+            {
+                return +1;
+            }
+
+            int sign2 = ToLine(test, v0, v1);
+            if (sign2 > 0)
+            {
+                return +1;
+            }
+
+            return ((sign0 && sign1 && sign2) ? -1 : 0);
+        }
+
+        int ToCircumcircle(int i, int v0, int v1, int v2) const
+        {
+            return ToCircumcircle(mVertices[i], v0, v1, v2);
+        }
+
+        int ToCircumcircle(Vector2<float> const& test, int v0, int v1, int v2) const
+        {
+            Input const p0 = Input::FromFloat(test[0]);
+            Input const p1 = Input::FromFloat(test[1]);
+
+            // x[k] and y[k] are the differences of vertex k and the test
+            // point, z[k] = (vk0+p0)*x[k] + (vk1+p1)*y[k].
+            int const indices[3] = { v0, v1, v2 };
+            SIntegerFixed32<Input::NUM_BITS + 1> x[3], y[3];
+            SIntegerFixed32<2 * Input::NUM_BITS + 3> z[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                Vector2<float> const& vec = mVertices[indices[k]];
+                Input const q0 = Input::FromFloat(vec[0]);
+                Input const q1 = Input::FromFloat(vec[1]);
+                x[k] = q0 - p0;
+                y[k] = q1 - p1;
+                z[k] = (q0 + p0) * x[k] + (q1 + p1) * y[k];
+            }
+
+            auto const c0 = y[1] * z[2] - y[2] * z[1];
+            auto const c1 = y[2] * z[0] - y[0] * z[2];
+            auto const c2 = y[0] * z[1] - y[1] * z[0];
+            auto const det = x[0] * c0 + x[1] * c1 + x[2] * c2;
+            return -det.GetSign();
+        }
+
+    private:
+        int mNumVertices;
+        Vector2<float> const* mVertices;
+    };
+
+    class PrimalQuery3Float
+    {
+    public:
+        using Input = SIntegerFixed32<277>;
+
+        // The caller is responsible for ensuring that the array is not empty
+        // before calling queries and that the indices passed to the queries
+        // are valid. The class does no range checking.
+        PrimalQuery3Float()
+            :
+            mNumVertices(0),
+            mVertices(nullptr)
+        {
+        }
+
+        PrimalQuery3Float(int numVertices, Vector3<float> const* vertices)
+            :
+            mNumVertices(numVertices),
+            mVertices(vertices)
+        {
+        }
+
+        // Member access.
+        inline void Set(int numVertices, Vector3<float> const* vertices)
+        {
+            mNumVertices = numVertices;
+            mVertices = vertices;
+        }
+
+        inline int GetNumVertices() const
+        {
+            return mNumVertices;
+        }
+
+        inline Vector3<float> const* GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // The queries have the same semantics as those of PrimalQuery3.
+        int ToPlane(int i, int v0, int v1, int v2) const
+        {
+            return ToPlane(mVertices[i], v0, v1, v2);
+        }
+
+        int ToPlane(Vector3<float> const& test, int v0, int v1, int v2) const
+        {
+            Vector3<float> const& vec0 = mVertices[v0];
+            Vector3<float> const& vec1 = mVertices[v1];
+            Vector3<float> const& vec2 = mVertices[v2];
+            Input const v00 = Input::FromFloat(vec0[0]);
+            Input const v01 = Input::FromFloat(vec0[1]);
+            Input const v02 = Input::FromFloat(vec0[2]);
+
+            auto const x0 = Input::FromFloat(test[0]) - v00;
+            auto const y0 = Input::FromFloat(test[1]) - v01;
+            auto const z0 = Input::FromFloat(test[2]) - v02;
+            auto const x1 = Input::FromFloat(vec1[0]) - v00;
+            auto const y1 = Input::FromFloat(vec1[1]) - v01;
+            auto const z1 = Input::FromFloat(vec1[2]) - v02;
+            auto const x2 = Input::FromFloat(vec2[0]) - v00;
+            auto const y2 = Input::FromFloat(vec2[1]) - v01;
+            auto const z2 = Input::FromFloat(vec2[2]) - v02;
+            auto const c0 = y1 * z2 - y2 * z1;
+            auto const c1 = y2 * z0 - y0 * z2;
+            auto const c2 = y0 * z1 - y1 * z0;
+            auto const det = x0 * c0 + x1 * c1 + x2 * c2;
+            return det.GetSign();
+        }
+
+        int ToTetrahedron(int i, int v0, int v1, int v2, int v3) const
+        {
+            return ToTetrahedron(mVertices[i], v0, v1, v2, v3);
+        }
+
+        int ToTetrahedron(Vector3<float> const& test, int v0, int v1, int v2, int v3) const
+        {
+            int sign0 = ToPlane(test, v1, v2, v3);
+            if (sign0 > 0)
+            {
+                return +1;
+            }
+
+            int sign1 = ToPlane(test, v0, v2, v3);
+            if (sign1 < 0)
+            {
+                return +1;
+            }
+
+            int sign2 = ToPlane(test, v0, v1, v3);
+            if (sign2 > 0)
+            {
+                return +1;
+            }
+
+            int sign3 = ToPlane(test, v0, v1, v2);
+            if (sign3 < 0)
+            {
+                return +1;
+            }
+
+            return ((sign0 && sign1 && sign2 && sign3) ? -1 : 0);
+        }
+
+        int ToCircumsphere(int i, int v0, int v1, int v2, int v3) const
+        {
+            return ToCircumsphere(mVertices[i], v0, v1, v2, v3);
+        }
+
+        int ToCircumsphere(Vector3<float> const& test, int v0, int v1, int v2, int v3) const
+        {
+            Input const p0 = Input::FromFloat(test[0]);
+            Input const p1 = Input::FromFloat(test[1]);
+            Input const p2 = Input::FromFloat(test[2]);
+
+            // x[k], y[k] and z[k] are the differences of vertex k and the
+            // test point, w[k] = (vk0+p0)*x[k] + (vk1+p1)*y[k] +
+            // (vk2+p2)*z[k].
+            int const indices[4] = { v0, v1, v2, v3 };
+            SIntegerFixed32<Input::NUM_BITS + 1> x[4], y[4], z[4];
+            SIntegerFixed32<2 * Input::NUM_BITS + 4> w[4];
+            for (int k = 0; k < 4; ++k)
+            {
+                Vector3<float> const& vec = mVertices[indices[k]];
+                Input const q0 = Input::FromFloat(vec[0]);
+                Input const q1 = Input::FromFloat(vec[1]);
+                Input const q2 = Input::FromFloat(vec[2]);
+                x[k] = q0 - p0;
+                y[k] = q1 - p1;
+                z[k] = q2 - p2;
+                w[k] = (q0 + p0) * x[k] + (q1 + p1) * y[k] + (q2 + p2) * z[k];
+            }
+
+            auto const a0 = x[0] * y[1] - x[1] * y[0];
+            auto const a1 = x[0] * y[2] - x[2] * y[0];
+            auto const a2 = x[0] * y[3] - x[3] * y[0];
+            auto const a3 = x[1] * y[2] - x[2] * y[1];
+            auto const a4 = x[1] * y[3] - x[3] * y[1];
+            auto const a5 = x[2] * y[3] - x[3] * y[2];
+            auto const b0 = z[0] * w[1] - z[1] * w[0];
+            auto const b1 = z[0] * w[2] - z[2] * w[0];
+            auto const b2 = z[0] * w[3] - z[3] * w[0];
+            auto const b3 = z[1] * w[2] - z[2] * w[1];
+            auto const b4 = z[1] * w[3] - z[3] * w[1];
+            auto const b5 = z[2] * w[3] - z[3] * w[2];
+            auto const det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+            return det.GetSign();
+        }
+
+    private:
+        int mNumVertices;
+        Vector3<float> const* mVertices;
+    };
+}
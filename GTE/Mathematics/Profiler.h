@@ -0,0 +1,265 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+// Scoped timing zones for measuring where time goes inside the algorithms.
+// A ProfileZone object records, on destruction, its name, the thread that
+// created it, its nesting depth within that thread and its start time and
+// duration, measured by a Timer shared by all zones. The recorded events
+// are summarized per zone name by Profiler::GetStatistics and are exported
+// in the Chrome trace event format (chrome://tracing or ui.perfetto.dev)
+// by Profiler::ExportChromeTrace.
+//
+// The algorithms are annotated with GTE_PROFILE_ZONE(name), which creates
+// a ProfileZone for the remainder of the enclosing scope when
+// GTE_COLLECT_PROFILE_ZONES is defined and expands to nothing otherwise.
+// Even when the zones are compiled, they record nothing until
+// Profiler::Enable(true) is called. The name must be a string with static
+// storage duration, typically a literal, because only the pointer is
+// stored.
+//
+// Recording an event locks a mutex, so the zones are intended for the
+// phases of an algorithm, not for its innermost loops.
+
+#include <Mathematics/Timer.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gte
+{
+    class Profiler
+    {
+    public:
+        // The times are in nanoseconds relative to the creation of the
+        // profiler. The thread identifiers are small integers assigned in
+        // the order the threads first record a zone. A depth of 0 is an
+        // outermost zone of its thread.
+        struct Event
+        {
+            char const* name;
+            uint32_t threadId;
+            uint32_t depth;
+            int64_t start;
+            int64_t duration;
+        };
+
+        // The durations of the events with the same name, in nanoseconds.
+        // The 99th percentile is the nearest-rank value.
+        struct Statistics
+        {
+            Statistics()
+                :
+                count(0),
+                total(0),
+                minimum(0),
+                maximum(0),
+                p99(0),
+                mean(0.0)
+            {
+            }
+
+            size_t count;
+            int64_t total, minimum, maximum, p99;
+            double mean;
+        };
+
+        static void Enable(bool enable)
+        {
+            GetState().enabled.store(enable, std::memory_order_release);
+        }
+
+        static bool IsEnabled()
+        {
+            return GetState().enabled.load(std::memory_order_acquire);
+        }
+
+        // Discard the recorded events.
+        static void Clear()
+        {
+            State& state = GetState();
+            state.mutex.lock();
+            state.events.clear();
+            state.mutex.unlock();
+        }
+
+        static std::vector<Event> GetEvents()
+        {
+            State& state = GetState();
+            state.mutex.lock();
+            std::vector<Event> events = state.events;
+            state.mutex.unlock();
+            return events;
+        }
+
+        static std::map<std::string, Statistics> GetStatistics()
+        {
+            std::map<std::string, std::vector<int64_t>> durations;
+            for (auto const& event : GetEvents())
+            {
+                durations[event.name].push_back(event.duration);
+            }
+
+            std::map<std::string, Statistics> statistics;
+            for (auto& element : durations)
+            {
+                std::vector<int64_t>& d = element.second;
+                std::sort(d.begin(), d.end());
+
+                Statistics& s = statistics[element.first];
+                s.count = d.size();
+                for (auto value : d)
+                {
+                    s.total += value;
+                }
+                s.minimum = d.front();
+                s.maximum = d.back();
+                size_t rank = (99 * s.count + 99) / 100;
+                s.p99 = d[rank - 1];
+                s.mean = static_cast<double>(s.total) / static_cast<double>(s.count);
+            }
+            return statistics;
+        }
+
+        // Write the recorded events as complete ("X") events of the Chrome
+        // trace event format. The times of the format are in microseconds.
+        static void WriteChromeTrace(std::ostream& output)
+        {
+            std::vector<Event> events = GetEvents();
+            output << "{\"traceEvents\":[";
+            for (size_t i = 0; i < events.size(); ++i)
+            {
+                Event const& event = events[i];
+                output << (i > 0 ? ",\n" : "\n");
+                output << "{\"name\":\"";
+                for (char const* c = event.name; *c; ++c)
+                {
+                    if (*c == '"' || *c == '\\')
+                    {
+                        output << '\\';
+                    }
+                    output << *c;
+                }
+                output << "\",\"cat\":\"GTE\",\"ph\":\"X\""
+                    << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+                    << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0
+                    << ",\"pid\":0,\"tid\":" << event.threadId
+                    << ",\"args\":{\"depth\":" << event.depth << "}}";
+            }
+            output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        }
+
+        static bool ExportChromeTrace(std::string const& filename)
+        {
+            std::ofstream output(filename);
+            if (output)
+            {
+                output.precision(15);
+                WriteChromeTrace(output);
+                return static_cast<bool>(output);
+            }
+            return false;
+        }
+
+    private:
+        friend class ProfileZone;
+
+        struct State
+        {
+            State()
+                :
+                enabled(false),
+                nextThreadId(0)
+            {
+            }
+
+            Timer timer;
+            std::atomic<bool> enabled;
+            std::atomic<uint32_t> nextThreadId;
+            std::mutex mutex;
+            std::vector<Event> events;
+        };
+
+        static State& GetState()
+        {
+            static State sState;
+            return sState;
+        }
+
+        static uint32_t GetThreadId()
+        {
+            static thread_local uint32_t sThreadId =
+                GetState().nextThreadId.fetch_add(1, std::memory_order_relaxed);
+            return sThreadId;
+        }
+
+        static uint32_t& GetDepth()
+        {
+            static thread_local uint32_t sDepth = 0;
+            return sDepth;
+        }
+
+        static void Record(Event const& event)
+        {
+            State& state = GetState();
+            state.mutex.lock();
+            state.events.push_back(event);
+            state.mutex.unlock();
+        }
+    };
+
+    class ProfileZone
+    {
+    public:
+        ProfileZone(char const* name)
+            :
+            mActive(Profiler::IsEnabled()),
+            mEvent{ name, 0, 0, 0, 0 }
+        {
+            if (mActive)
+            {
+                mEvent.threadId = Profiler::GetThreadId();
+                mEvent.depth = Profiler::GetDepth()++;
+                mEvent.start = Profiler::GetState().timer.GetNanoseconds();
+            }
+        }
+
+        ~ProfileZone()
+        {
+            if (mActive)
+            {
+                mEvent.duration = Profiler::GetState().timer.GetNanoseconds() - mEvent.start;
+                --Profiler::GetDepth();
+                Profiler::Record(mEvent);
+            }
+        }
+
+        // Zones are tied to their scope.
+        ProfileZone(ProfileZone const&) = delete;
+        ProfileZone& operator=(ProfileZone const&) = delete;
+
+    private:
+        bool mActive;
+        Profiler::Event mEvent;
+    };
+}
+
+#if defined(GTE_COLLECT_PROFILE_ZONES)
+#define GTE_PROFILE_ZONE_CONCATENATE_(a, b) a##b
+#define GTE_PROFILE_ZONE_CONCATENATE(a, b) GTE_PROFILE_ZONE_CONCATENATE_(a, b)
+#define GTE_PROFILE_ZONE(name) \
+    gte::ProfileZone GTE_PROFILE_ZONE_CONCATENATE(gteProfileZone, __LINE__)(name)
+#else
+#define GTE_PROFILE_ZONE(name)
+#endif
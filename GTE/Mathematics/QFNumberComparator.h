@@ -0,0 +1,228 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/QFNumber.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Comparisons of many numbers x[0] + x[1] * sqrt(d) of a quadratic field
+// with one square root term and a common d, for example, to sort the
+// parameters of the intersection points computed by exact queries. The
+// operator< for QFNumber<T,1> computes the difference of the numbers and
+// squares its terms for each comparison. QFNumberComparator computes for
+// each number, once, a 'double' approximation and an error bound. Two
+// numbers whose error intervals are disjoint are compared using only the
+// approximations. The others are compared exactly, using the same
+// algorithm as operator<.
+//
+// The approximations require the conversion of T to 'double', which is
+// available for 'float', 'double', BSNumber and BSRational. The error
+// bounds assume that the conversions are rounded to nearest, so the
+// relative error of each is at most 2^{-53}. A number with a coefficient
+// that is infinite, not-a-number or subnormal after conversion is always
+// compared exactly.
+
+namespace gte
+{
+    template <typename T>
+    class QFNumberComparator
+    {
+    public:
+        using QFN1 = QFNumber<T, 1>;
+
+        // Construction. The numbers are referenced, not copied, so they
+        // must persist while the comparator is used. All numbers must have
+        // the same d, which must be nonnegative.
+        QFNumberComparator()
+            :
+            mNumbers(nullptr)
+        {
+        }
+
+        QFNumberComparator(size_t numNumbers, QFN1 const* numbers)
+            :
+            mNumbers(nullptr)
+        {
+            Set(numNumbers, numbers);
+        }
+
+        void Set(size_t numNumbers, QFN1 const* numbers)
+        {
+            mNumbers = numbers;
+            mApproximations.resize(numNumbers);
+            if (numNumbers == 0)
+            {
+                return;
+            }
+
+            T const& d = numbers[0].d;
+            LogAssert(d >= T(0), "The d-value must be nonnegative.");
+            double const sqrtD = std::sqrt(static_cast<double>(d));
+
+            // The relative error of sqrtD is at most 3u/2, with u = 2^{-53}
+            // the unit roundoff, which includes the errors of the
+            // conversion of d and of sqrt. Each approximation
+            // a = x[0] + x[1] * sqrtD has 3 more rounding errors. The
+            // bound 8u*(|x[0]| + |x[1] * sqrtD|) is conservative and
+            // accounts for the rounding errors of the bound itself.
+            double const coefficient = 8.0 * GetEpsilon();
+            for (size_t i = 0; i < numNumbers; ++i)
+            {
+#if defined(GTE_ASSERT_ON_QFNUMBER_MISMATCHED_D)
+                LogAssert(numbers[i].d == d, "Mismatched d-value.");
+#endif
+                Approximation& approx = mApproximations[i];
+                double const x0 = static_cast<double>(numbers[i].x[0]);
+                double const x1 = static_cast<double>(numbers[i].x[1]);
+                double const x1SqrtD = x1 * sqrtD;
+                approx.value = x0 + x1SqrtD;
+                approx.error = coefficient * (std::fabs(x0) + std::fabs(x1SqrtD));
+                approx.valid = IsValid(x0) && IsValid(x1) && IsValid(sqrtD) && IsValid(x1SqrtD)
+                    && IsValid(approx.value) && std::isfinite(approx.error);
+            }
+        }
+
+        // Member access.
+        inline size_t GetNumNumbers() const
+        {
+            return mApproximations.size();
+        }
+
+        inline QFN1 const* GetNumbers() const
+        {
+            return mNumbers;
+        }
+
+        // Compare numbers[i0] and numbers[i1]. The return value is -1 when
+        // numbers[i0] < numbers[i1], 0 when they are equal or +1 when
+        // numbers[i0] > numbers[i1].
+        int32_t Compare(size_t i0, size_t i1) const
+        {
+            Approximation const& approx0 = mApproximations[i0];
+            Approximation const& approx1 = mApproximations[i1];
+            if (approx0.valid && approx1.valid)
+            {
+                // The sum of the error bounds is inflated by a factor of 2
+                // to account for the rounding errors of the difference and
+                // the sum.
+                double const difference = approx0.value - approx1.value;
+                double const error = 2.0 * (approx0.error + approx1.error);
+                if (difference > error)
+                {
+                    return +1;
+                }
+                if (-difference > error)
+                {
+                    return -1;
+                }
+            }
+
+            return CompareExact(mNumbers[i0], mNumbers[i1]);
+        }
+
+        inline bool Less(size_t i0, size_t i1) const
+        {
+            return Compare(i0, i1) < 0;
+        }
+
+        // Sort the indices so that the numbers are in increasing order.
+        void Sort(std::vector<size_t>& indices) const
+        {
+            indices.resize(mApproximations.size());
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                indices[i] = i;
+            }
+
+            std::sort(indices.begin(), indices.end(),
+                [this](size_t i0, size_t i1)
+                {
+                    return Less(i0, i1);
+                });
+        }
+
+        // The exact comparison, which is the algorithm of operator< for
+        // QFNumber<T,1> applied to q0 - q1.
+        static int32_t CompareExact(QFN1 const& q0, QFN1 const& q1)
+        {
+            T const zero(0);
+            T const diff0 = q0.x[0] - q1.x[0];
+            if (q0.d == zero || q0.x[1] == q1.x[1])
+            {
+                return (diff0 > zero ? +1 : (diff0 < zero ? -1 : 0));
+            }
+
+            T const diff1 = q0.x[1] - q1.x[1];
+            if (diff1 > zero)
+            {
+                if (diff0 >= zero)
+                {
+                    return +1;
+                }
+            }
+            else // diff1 < zero
+            {
+                if (diff0 <= zero)
+                {
+                    return -1;
+                }
+            }
+
+            // The signs of diff0 and diff1 are opposite, so the sign of
+            // diff0 + diff1 * sqrt(d) is the sign of diff0 when
+            // diff0^2 > diff1^2 * d.
+            T const lhs = diff0 * diff0;
+            T const rhs = diff1 * diff1 * q0.d;
+            if (lhs > rhs)
+            {
+                return (diff0 > zero ? +1 : -1);
+            }
+            if (lhs < rhs)
+            {
+                return (diff1 > zero ? +1 : -1);
+            }
+            return 0;
+        }
+
+    private:
+        struct Approximation
+        {
+            Approximation()
+                :
+                value(0.0),
+                error(0.0),
+                valid(false)
+            {
+            }
+
+            double value, error;
+            bool valid;
+        };
+
+        // The unit roundoff for 'double', 2^{-53}.
+        inline static double GetEpsilon()
+        {
+            return 0.5 * std::numeric_limits<double>::epsilon();
+        }
+
+        // Zero is exact. The relative error bounds do not apply to
+        // subnormal numbers.
+        inline static bool IsValid(double x)
+        {
+            return x == 0.0 || std::isnormal(x);
+        }
+
+        QFN1 const* mNumbers;
+        std::vector<Approximation> mApproximations;
+    };
+}
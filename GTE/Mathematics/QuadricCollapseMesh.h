@@ -0,0 +1,608 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Simplification of a manifold triangle mesh by edge collapses ordered by
+// the quadric error metric, as described in
+//   Michael Garland and Paul S. Heckbert, "Surface Simplification Using
+//   Quadric Error Metrics", SIGGRAPH 1997.
+// Whereas VertexCollapseMesh removes one vertex at a time, this class
+// collapses edges in passes. Each pass computes the collapse costs of all
+// edges concurrently, selects by increasing cost a set of edges whose
+// triangles are disjoint, and then collapses the selected edges
+// concurrently. The collapses of a pass do not interact, so the result does
+// not depend on the number of threads. The costs of the edges near a
+// collapse change only between passes, so the collapse order differs
+// somewhat from that of a strictly serial quadric simplification.
+//
+// An edge <v0,v1> is collapsed to its smaller index v0, which is moved to
+// the position that minimizes the sum of the quadrics of v0 and v1. An edge
+// is not collapsed when the result would be nonmanifold, when it would flip
+// the normal of a triangle or when it connects two boundary vertices but is
+// not a boundary edge. The boundary edges contribute quadrics for planes
+// perpendicular to their triangles so that the boundary is preserved.
+//
+// The input mesh must be manifold and its triangles must be consistently
+// ordered. Simplify(...) may be called with decreasing targets to generate
+// levels of detail; GetMesh(...) returns the current mesh in the format of
+// the constructor inputs.
+
+namespace gte
+{
+    template <typename Real>
+    class QuadricCollapseMesh
+    {
+    public:
+        // Construction. The collapse costs and the collapses of a pass are
+        // computed by numThreads threads, which are std::thread objects
+        // created for each pass unless a scheduler is specified by
+        // SetScheduler(*).
+        QuadricCollapseMesh(int numPositions, Vector3<Real> const* positions,
+            int numIndices, int const* indices, size_t numThreads = 1)
+            :
+            mNumThreads(std::max(numThreads, static_cast<size_t>(1))),
+            mScheduler(nullptr),
+            mNumTriangles(0)
+        {
+            LogAssert(numPositions > 0 && positions != nullptr && numIndices >= 3
+                && indices != nullptr, "Invalid input.");
+
+            mPositions.assign(positions, positions + numPositions);
+            mQuadrics.resize(static_cast<size_t>(numPositions));
+            mVertexTriangles.resize(static_cast<size_t>(numPositions));
+            mIsBoundary.resize(static_cast<size_t>(numPositions), 0);
+            mLocked.resize(static_cast<size_t>(numPositions), UNLOCKED);
+
+            int const numTriangles = numIndices / 3;
+            mTriangles.resize(static_cast<size_t>(numTriangles));
+            for (int t = 0; t < numTriangles; ++t)
+            {
+                auto& tri = mTriangles[t];
+                for (int j = 0; j < 3; ++j)
+                {
+                    tri[j] = indices[3 * t + j];
+                    LogAssert(0 <= tri[j] && tri[j] < numPositions, "Invalid index.");
+                    mVertexTriangles[tri[j]].push_back(t);
+                }
+            }
+            mNumTriangles = static_cast<size_t>(numTriangles);
+
+            ComputeQuadrics();
+        }
+
+        // Execute the passes as tasks of the scheduler, which can be shared
+        // with other computations, instead of creating threads for each
+        // call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // Collapse edges until the mesh has at most targetNumTriangles
+        // triangles or no more edges can be collapsed. The return value is
+        // the number of triangles of the simplified mesh.
+        size_t Simplify(size_t targetNumTriangles)
+        {
+            std::vector<Candidate> candidates, selected;
+            std::vector<int> locked;
+            while (mNumTriangles > targetNumTriangles)
+            {
+                ComputeCandidates(candidates);
+
+                // Select the edges of the pass by increasing cost. An edge
+                // of a boundary removes 1 triangle and an interior edge
+                // removes 2 triangles.
+                selected.clear();
+                size_t numRemoved = 0;
+                for (auto const& candidate : candidates)
+                {
+                    if (numRemoved + candidate.numRemoved > mNumTriangles - targetNumTriangles)
+                    {
+                        continue;
+                    }
+
+                    if (Lock(candidate.v0, candidate.v1, locked))
+                    {
+                        selected.push_back(candidate);
+                        numRemoved += candidate.numRemoved;
+                    }
+                }
+
+                for (auto v : locked)
+                {
+                    mLocked[v] = UNLOCKED;
+                }
+                locked.clear();
+
+                if (selected.size() == 0)
+                {
+                    break;
+                }
+
+                size_t const numSelected = selected.size();
+                size_t const numChunks = std::max(std::min(mNumThreads, numSelected), static_cast<size_t>(1));
+                TaskScheduler::ParallelFor(mScheduler, numChunks,
+                    [this, &selected, numSelected, numChunks](size_t c)
+                {
+                    size_t const imin = numSelected * c / numChunks;
+                    size_t const imax = numSelected * (c + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        Collapse(selected[i]);
+                    }
+                });
+                mNumTriangles -= numRemoved;
+            }
+            return mNumTriangles;
+        }
+
+        // The current mesh. The remaining vertices are in their original
+        // order and are reindexed consecutively, and the remaining triangles
+        // are in their original order.
+        void GetMesh(std::vector<Vector3<Real>>& positions, std::vector<int>& indices) const
+        {
+            std::vector<int> remap(mPositions.size(), -1);
+            positions.clear();
+            for (size_t v = 0; v < mPositions.size(); ++v)
+            {
+                if (mVertexTriangles[v].size() > 0)
+                {
+                    remap[v] = static_cast<int>(positions.size());
+                    positions.push_back(mPositions[v]);
+                }
+            }
+
+            indices.clear();
+            indices.reserve(3 * mNumTriangles);
+            for (auto const& tri : mTriangles)
+            {
+                if (tri[0] >= 0)
+                {
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        indices.push_back(remap[tri[j]]);
+                    }
+                }
+            }
+        }
+
+        inline size_t GetNumTriangles() const
+        {
+            return mNumTriangles;
+        }
+
+    private:
+        // The quadric Q(p) = p^T*A*p + 2*B^T*p + C, where A is symmetric,
+        // is stored as {a00,a01,a02,a11,a12,a22,b0,b1,b2,c}.
+        using Quadric = std::array<Real, 10>;
+
+        struct Candidate
+        {
+            bool operator<(Candidate const& other) const
+            {
+                if (cost < other.cost)
+                {
+                    return true;
+                }
+                if (cost > other.cost)
+                {
+                    return false;
+                }
+                return v0 < other.v0 || (v0 == other.v0 && v1 < other.v1);
+            }
+
+            Real cost;
+            int v0, v1;
+            size_t numRemoved;
+            Vector3<Real> position;
+        };
+
+        // Add the quadric of the plane Dot(N,p)+d = 0 with unit-length N.
+        static void AddPlane(Vector3<Real> const& N, Real d, Real weight, Quadric& q)
+        {
+            q[0] += weight * N[0] * N[0];
+            q[1] += weight * N[0] * N[1];
+            q[2] += weight * N[0] * N[2];
+            q[3] += weight * N[1] * N[1];
+            q[4] += weight * N[1] * N[2];
+            q[5] += weight * N[2] * N[2];
+            q[6] += weight * d * N[0];
+            q[7] += weight * d * N[1];
+            q[8] += weight * d * N[2];
+            q[9] += weight * d * d;
+        }
+
+        static Real Evaluate(Quadric const& q, Vector3<Real> const& p)
+        {
+            Real const two = static_cast<Real>(2);
+            return q[0] * p[0] * p[0] + q[3] * p[1] * p[1] + q[5] * p[2] * p[2]
+                + two * (q[1] * p[0] * p[1] + q[2] * p[0] * p[2] + q[4] * p[1] * p[2])
+                + two * (q[6] * p[0] + q[7] * p[1] + q[8] * p[2]) + q[9];
+        }
+
+        // The quadric of a vertex is the area-weighted sum of the quadrics
+        // of the planes of its triangles. Each boundary edge adds the
+        // quadric of the plane containing the edge and perpendicular to its
+        // triangle, weighted by the squared edge length.
+        void ComputeQuadrics()
+        {
+            Real const boundaryWeight = static_cast<Real>(1000);
+            Real const half = static_cast<Real>(0.5);
+            for (auto& q : mQuadrics)
+            {
+                q.fill(static_cast<Real>(0));
+            }
+
+            for (auto const& tri : mTriangles)
+            {
+                Vector3<Real> const& P0 = mPositions[tri[0]];
+                Vector3<Real> N = Cross(mPositions[tri[1]] - P0, mPositions[tri[2]] - P0);
+                Real length = Normalize(N);
+                Real d = -Dot(N, P0);
+                for (int j = 0; j < 3; ++j)
+                {
+                    AddPlane(N, d, half * length, mQuadrics[tri[j]]);
+                }
+
+                for (int j0 = 0, j1 = 1; j0 < 3; ++j0, j1 = (j1 + 1) % 3)
+                {
+                    int v0 = tri[j0], v1 = tri[j1];
+                    if (GetNumSharedTriangles(v0, v1) == 1)
+                    {
+                        Vector3<Real> E = mPositions[v1] - mPositions[v0];
+                        Vector3<Real> M = Cross(E, N);
+                        Normalize(M);
+                        Real dM = -Dot(M, mPositions[v0]);
+                        Real weight = boundaryWeight * Dot(E, E);
+                        AddPlane(M, dM, weight, mQuadrics[v0]);
+                        AddPlane(M, dM, weight, mQuadrics[v1]);
+                        mIsBoundary[v0] = 1;
+                        mIsBoundary[v1] = 1;
+                    }
+                }
+            }
+        }
+
+        size_t GetNumSharedTriangles(int v0, int v1) const
+        {
+            size_t count = 0;
+            for (auto t : mVertexTriangles[v0])
+            {
+                auto const& tri = mTriangles[t];
+                if (tri[0] == v1 || tri[1] == v1 || tri[2] == v1)
+                {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        // Get the vertices adjacent to v, sorted and without duplicates.
+        void GetNeighbors(int v, std::vector<int>& neighbors) const
+        {
+            neighbors.clear();
+            for (auto t : mVertexTriangles[v])
+            {
+                for (auto w : mTriangles[t])
+                {
+                    if (w != v)
+                    {
+                        neighbors.push_back(w);
+                    }
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        }
+
+        // Compute the valid collapses <v0,v1> with v0 < v1, sorted by cost.
+        // The vertices are partitioned into contiguous ranges, one per
+        // thread, and the candidates of the ranges are concatenated in
+        // order.
+        void ComputeCandidates(std::vector<Candidate>& candidates) const
+        {
+            size_t const numVertices = mPositions.size();
+            size_t const numRanges = std::min(mNumThreads, numVertices);
+            std::vector<std::vector<Candidate>> rangeCandidates(numRanges);
+            TaskScheduler::ParallelFor(mScheduler, numRanges, [this, numVertices, numRanges, &rangeCandidates](size_t r)
+            {
+                std::vector<int> neighbors0, neighbors1;
+                auto& output = rangeCandidates[r];
+                size_t const vmin = numVertices * r / numRanges;
+                size_t const vmax = numVertices * (r + 1) / numRanges;
+                for (size_t v = vmin; v < vmax; ++v)
+                {
+                    int v0 = static_cast<int>(v);
+                    if (mVertexTriangles[v0].size() == 0)
+                    {
+                        continue;
+                    }
+
+                    GetNeighbors(v0, neighbors0);
+                    for (auto v1 : neighbors0)
+                    {
+                        Candidate candidate;
+                        if (v1 > v0 && ComputeCandidate(v0, v1, neighbors0, neighbors1, candidate))
+                        {
+                            output.push_back(candidate);
+                        }
+                    }
+                }
+            });
+
+            candidates.clear();
+            for (auto& output : rangeCandidates)
+            {
+                candidates.insert(candidates.end(), output.begin(), output.end());
+            }
+            std::sort(candidates.begin(), candidates.end());
+        }
+
+        bool ComputeCandidate(int v0, int v1, std::vector<int> const& neighbors0,
+            std::vector<int>& neighbors1, Candidate& candidate) const
+        {
+            // The link condition: the common neighbors of v0 and v1 must be
+            // the vertices opposite the edge.
+            size_t const numShared = GetNumSharedTriangles(v0, v1);
+            if (numShared != 1 && numShared != 2)
+            {
+                return false;
+            }
+            if (numShared == 2 && mIsBoundary[v0] && mIsBoundary[v1])
+            {
+                return false;
+            }
+
+            GetNeighbors(v1, neighbors1);
+            size_t numCommon = 0;
+            for (size_t i0 = 0, i1 = 0; i0 < neighbors0.size() && i1 < neighbors1.size(); )
+            {
+                if (neighbors0[i0] < neighbors1[i1])
+                {
+                    ++i0;
+                }
+                else if (neighbors1[i1] < neighbors0[i0])
+                {
+                    ++i1;
+                }
+                else
+                {
+                    ++numCommon;
+                    ++i0;
+                    ++i1;
+                }
+            }
+            if (numCommon != numShared)
+            {
+                return false;
+            }
+
+            // The merged vertex must have enough neighbors that its
+            // triangles are not degenerate, which excludes the collapse of
+            // an edge of a tetrahedron.
+            size_t const numMerged = neighbors0.size() + neighbors1.size() - numCommon - 2;
+            if (numMerged < (numShared == 2 ? 3u : 2u))
+            {
+                return false;
+            }
+
+            Quadric q = mQuadrics[v0];
+            for (size_t i = 0; i < q.size(); ++i)
+            {
+                q[i] += mQuadrics[v1][i];
+            }
+            candidate.v0 = v0;
+            candidate.v1 = v1;
+            candidate.numRemoved = numShared;
+            ComputePosition(q, mPositions[v0], mPositions[v1], candidate.position, candidate.cost);
+
+            // The collapse must not flip the normals of the remaining
+            // triangles of v0 and v1.
+            for (int v : { v0, v1 })
+            {
+                for (auto t : mVertexTriangles[v])
+                {
+                    auto const& tri = mTriangles[t];
+                    if (tri[0] == v0 + v1 - v || tri[1] == v0 + v1 - v || tri[2] == v0 + v1 - v)
+                    {
+                        continue;
+                    }
+
+                    std::array<Vector3<Real>, 3> P;
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        P[j] = mPositions[tri[j]];
+                    }
+                    Vector3<Real> oldNormal = Cross(P[1] - P[0], P[2] - P[0]);
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        if (tri[j] == v)
+                        {
+                            P[j] = candidate.position;
+                        }
+                    }
+                    Vector3<Real> newNormal = Cross(P[1] - P[0], P[2] - P[0]);
+                    if (Dot(oldNormal, newNormal) <= static_cast<Real>(0))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Compute the position minimizing the quadric. When the quadric
+        // matrix is nearly singular, the best of the endpoints and the
+        // midpoint is used.
+        static void ComputePosition(Quadric const& q, Vector3<Real> const& P0,
+            Vector3<Real> const& P1, Vector3<Real>& position, Real& cost)
+        {
+            Real const c00 = q[3] * q[5] - q[4] * q[4];
+            Real const c01 = q[2] * q[4] - q[1] * q[5];
+            Real const c02 = q[1] * q[4] - q[2] * q[3];
+            Real const det = q[0] * c00 + q[1] * c01 + q[2] * c02;
+            Real const trace = q[0] + q[3] + q[5];
+            Real const epsilon = static_cast<Real>(1e-06);
+            if (std::fabs(det) > epsilon * trace * trace * trace)
+            {
+                Real const c11 = q[0] * q[5] - q[2] * q[2];
+                Real const c12 = q[1] * q[2] - q[0] * q[4];
+                Real const c22 = q[0] * q[3] - q[1] * q[1];
+                position[0] = -(c00 * q[6] + c01 * q[7] + c02 * q[8]) / det;
+                position[1] = -(c01 * q[6] + c11 * q[7] + c12 * q[8]) / det;
+                position[2] = -(c02 * q[6] + c12 * q[7] + c22 * q[8]) / det;
+                cost = Evaluate(q, position);
+                return;
+            }
+
+            Real const half = static_cast<Real>(0.5);
+            std::array<Vector3<Real>, 3> points = { P0, P1, half * (P0 + P1) };
+            cost = std::numeric_limits<Real>::max();
+            for (auto const& point : points)
+            {
+                Real pointCost = Evaluate(q, point);
+                if (pointCost < cost)
+                {
+                    cost = pointCost;
+                    position = point;
+                }
+            }
+        }
+
+        // The collapses of a pass are independent when the endpoints of
+        // each edge are not neighbors of the endpoints of the other edges,
+        // so the triangles of the edges are disjoint, and when no vertex
+        // is opposite two edges, so the triangle lists modified by the
+        // collapses are disjoint. The other neighbors may be shared. The
+        // function returns 'false' without locking when the edge <v0,v1> is
+        // not independent of the edges locked previously.
+        enum
+        {
+            UNLOCKED,
+            NEIGHBOR,
+            OPPOSITE,
+            ENDPOINT
+        };
+
+        bool Lock(int v0, int v1, std::vector<int>& locked)
+        {
+            if (mLocked[v0] != UNLOCKED || mLocked[v1] != UNLOCKED)
+            {
+                return false;
+            }
+
+            for (int v : { v0, v1 })
+            {
+                for (auto t : mVertexTriangles[v])
+                {
+                    auto const& tri = mTriangles[t];
+                    bool isShared = (tri[0] == v0 + v1 - v || tri[1] == v0 + v1 - v || tri[2] == v0 + v1 - v);
+                    for (auto w : tri)
+                    {
+                        if (mLocked[w] == ENDPOINT || (isShared && mLocked[w] == OPPOSITE))
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            for (int v : { v0, v1 })
+            {
+                for (auto t : mVertexTriangles[v])
+                {
+                    auto const& tri = mTriangles[t];
+                    bool isShared = (tri[0] == v0 + v1 - v || tri[1] == v0 + v1 - v || tri[2] == v0 + v1 - v);
+                    for (auto w : tri)
+                    {
+                        uint8_t state = (w == v0 || w == v1 ? ENDPOINT : (isShared ? OPPOSITE : NEIGHBOR));
+                        if (mLocked[w] == UNLOCKED)
+                        {
+                            locked.push_back(w);
+                        }
+                        mLocked[w] = std::max(mLocked[w], state);
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Collapse v1 into v0. The function modifies only the triangles of
+        // v0 and v1 and the triangle lists of v0, v1 and the opposite
+        // vertices, which are locked exclusively by the collapse.
+        void Collapse(Candidate const& candidate)
+        {
+            int const v0 = candidate.v0, v1 = candidate.v1;
+            auto& triangles0 = mVertexTriangles[v0];
+            auto& triangles1 = mVertexTriangles[v1];
+            for (auto t : triangles1)
+            {
+                auto& tri = mTriangles[t];
+                if (tri[0] == v0 || tri[1] == v0 || tri[2] == v0)
+                {
+                    // The triangle is degenerate after the collapse.
+                    for (auto w : tri)
+                    {
+                        if (w != v1)
+                        {
+                            auto& trianglesW = mVertexTriangles[w];
+                            auto iter = std::find(trianglesW.begin(), trianglesW.end(), t);
+                            *iter = trianglesW.back();
+                            trianglesW.pop_back();
+                        }
+                    }
+                    tri = { -1, -1, -1 };
+                }
+                else
+                {
+                    for (auto& w : tri)
+                    {
+                        if (w == v1)
+                        {
+                            w = v0;
+                        }
+                    }
+                    triangles0.push_back(t);
+                }
+            }
+            triangles1.clear();
+            triangles1.shrink_to_fit();
+
+            mPositions[v0] = candidate.position;
+            for (size_t i = 0; i < mQuadrics[v0].size(); ++i)
+            {
+                mQuadrics[v0][i] += mQuadrics[v1][i];
+            }
+            mIsBoundary[v0] = (mIsBoundary[v0] || mIsBoundary[v1] ? 1 : 0);
+        }
+
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
+        std::vector<Vector3<Real>> mPositions;
+        std::vector<Quadric> mQuadrics;
+        std::vector<std::array<int, 3>> mTriangles;
+        std::vector<std::vector<int>> mVertexTriangles;
+        std::vector<uint8_t> mIsBoundary, mLocked;
+        size_t mNumTriangles;
+    };
+}
@@ -0,0 +1,300 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// A streaming estimate of the quantiles of a sequence of numbers whose
+// range is not known in advance, for which a Histogram cannot be used. The
+// sketch is that of C. Masson, J. E. Rim and H. K. Lee, "DDSketch: A Fast
+// and Fully-Mergeable Quantile Sketch with Relative-Error Guarantees". A
+// positive number x is counted in bin i = ceil(log(x)/log(g)), where
+// g = (1+a)/(1-a) for the relative accuracy a, so the bin of x contains the
+// numbers in (g^{i-1},g^i]. The estimate of the numbers of a bin is
+// 2*g^i/(g+1), whose relative error is at most a. Negative numbers are
+// counted in bins of their magnitudes, and the numbers whose magnitudes are
+// smaller than the smallest positive normal number are counted as zeros.
+//
+// The quantile estimates have relative error at most a, and the minimum
+// and maximum are exact. The memory is bounded by maxNumBins bins per
+// sign. When a sign has more bins, the bins of the smallest magnitudes are
+// combined, which loses the accuracy only of the quantiles of those
+// numbers. For a = 0.01 and numbers in [1,10^6], there are about 700 bins.
+// Sketches with the same parameters can be merged, so a sketch can be
+// computed for each thread or each part of the data and then combined.
+// NaNs are ignored.
+
+namespace gte
+{
+    template <typename Real>
+    class QuantileSketch
+    {
+    public:
+        QuantileSketch(Real relativeAccuracy = (Real)0.01, size_t maxNumBins = 2048)
+            :
+            mRelativeAccuracy(relativeAccuracy),
+            mMaxNumBins(maxNumBins),
+            mGamma((1 + relativeAccuracy) / (1 - relativeAccuracy)),
+            mInvLogGamma((Real)1 / std::log(mGamma)),
+            mNumZeros(0),
+            mCount(0),
+            mMinimum(std::numeric_limits<Real>::max()),
+            mMaximum(-std::numeric_limits<Real>::max())
+        {
+            LogAssert((Real)0 < relativeAccuracy && relativeAccuracy < (Real)1 && maxNumBins > 0,
+                "Invalid input.");
+        }
+
+        void Insert(Real value)
+        {
+            if (value > std::numeric_limits<Real>::min())
+            {
+                mPositive.Add(GetIndex(value), 1, mMaxNumBins);
+            }
+            else if (value < -std::numeric_limits<Real>::min())
+            {
+                mNegative.Add(GetIndex(-value), 1, mMaxNumBins);
+            }
+            else if (value == value)
+            {
+                ++mNumZeros;
+            }
+            else
+            {
+                // The value is a NaN.
+                return;
+            }
+
+            ++mCount;
+            mMinimum = std::min(mMinimum, value);
+            mMaximum = std::max(mMaximum, value);
+        }
+
+        void Insert(size_t numValues, Real const* values)
+        {
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                Insert(values[i]);
+            }
+        }
+
+        // Add the counts of a sketch with the same parameters.
+        void Merge(QuantileSketch const& sketch)
+        {
+            LogAssert(sketch.mRelativeAccuracy == mRelativeAccuracy && sketch.mMaxNumBins == mMaxNumBins,
+                "Mismatched parameters.");
+
+            mPositive.Merge(sketch.mPositive, mMaxNumBins);
+            mNegative.Merge(sketch.mNegative, mMaxNumBins);
+            mNumZeros += sketch.mNumZeros;
+            mCount += sketch.mCount;
+            mMinimum = std::min(mMinimum, sketch.mMinimum);
+            mMaximum = std::max(mMaximum, sketch.mMaximum);
+        }
+
+        void Clear()
+        {
+            mPositive = Bins();
+            mNegative = Bins();
+            mNumZeros = 0;
+            mCount = 0;
+            mMinimum = std::numeric_limits<Real>::max();
+            mMaximum = -std::numeric_limits<Real>::max();
+        }
+
+        // Member access.
+        inline Real GetRelativeAccuracy() const
+        {
+            return mRelativeAccuracy;
+        }
+
+        inline uint64_t GetCount() const
+        {
+            return mCount;
+        }
+
+        // The extremes are exact. They are valid only when GetCount() is
+        // positive.
+        inline Real GetMinimum() const
+        {
+            return mMinimum;
+        }
+
+        inline Real GetMaximum() const
+        {
+            return mMaximum;
+        }
+
+        // Estimate the number of rank floor(q*(count-1)) in the sorted
+        // sequence, where q is in [0,1]. The function returns 0 when no
+        // numbers have been inserted.
+        Real GetQuantile(Real q) const
+        {
+            if (mCount == 0)
+            {
+                return (Real)0;
+            }
+
+            q = std::min(std::max(q, (Real)0), (Real)1);
+            uint64_t rank = static_cast<uint64_t>(q * static_cast<Real>(mCount - 1));
+            Real estimate;
+
+            // The negative numbers are ordered by decreasing magnitude.
+            uint64_t numNegative = mNegative.GetTotal();
+            if (rank < numNegative)
+            {
+                estimate = -GetValue(mNegative.GetIndexFromTop(rank));
+            }
+            else if (rank < numNegative + mNumZeros)
+            {
+                estimate = (Real)0;
+            }
+            else
+            {
+                estimate = GetValue(mPositive.GetIndexFromBottom(rank - numNegative - mNumZeros));
+            }
+            return std::min(std::max(estimate, mMinimum), mMaximum);
+        }
+
+    private:
+        // The counts of bins offset through offset+counts.size()-1.
+        class Bins
+        {
+        public:
+            Bins()
+                :
+                mOffset(0),
+                mTotal(0)
+            {
+            }
+
+            void Add(int index, uint64_t count, size_t maxNumBins)
+            {
+                if (mCounts.size() == 0)
+                {
+                    mOffset = index;
+                    mCounts.push_back(0);
+                }
+                else if (index < mOffset)
+                {
+                    // Grow the bins at the bottom unless the limit is
+                    // reached, in which case the count is added to the
+                    // lowest bin.
+                    size_t grow = static_cast<size_t>(mOffset - index);
+                    if (mCounts.size() + grow > maxNumBins)
+                    {
+                        grow = maxNumBins - std::min(mCounts.size(), maxNumBins);
+                        index = mOffset - static_cast<int>(grow);
+                    }
+                    mCounts.insert(mCounts.begin(), grow, 0);
+                    mOffset -= static_cast<int>(grow);
+                }
+                else if (index >= mOffset + static_cast<int>(mCounts.size()))
+                {
+                    mCounts.resize(static_cast<size_t>(index - mOffset) + 1, 0);
+                    Collapse(maxNumBins);
+                }
+
+                mCounts[static_cast<size_t>(std::max(index, mOffset) - mOffset)] += count;
+                mTotal += count;
+            }
+
+            void Merge(Bins const& bins, size_t maxNumBins)
+            {
+                for (size_t i = 0; i < bins.mCounts.size(); ++i)
+                {
+                    if (bins.mCounts[i] > 0)
+                    {
+                        Add(bins.mOffset + static_cast<int>(i), bins.mCounts[i], maxNumBins);
+                    }
+                }
+            }
+
+            inline uint64_t GetTotal() const
+            {
+                return mTotal;
+            }
+
+            // Get the index of the bin containing the number of the
+            // specified rank, counting from the lowest or highest bin. The
+            // rank must be smaller than GetTotal().
+            int GetIndexFromBottom(uint64_t rank) const
+            {
+                uint64_t sum = 0;
+                for (size_t i = 0; i < mCounts.size(); ++i)
+                {
+                    sum += mCounts[i];
+                    if (sum > rank)
+                    {
+                        return mOffset + static_cast<int>(i);
+                    }
+                }
+                return mOffset + static_cast<int>(mCounts.size()) - 1;
+            }
+
+            int GetIndexFromTop(uint64_t rank) const
+            {
+                uint64_t sum = 0;
+                for (size_t i = mCounts.size(); i > 0; --i)
+                {
+                    sum += mCounts[i - 1];
+                    if (sum > rank)
+                    {
+                        return mOffset + static_cast<int>(i) - 1;
+                    }
+                }
+                return mOffset;
+            }
+
+        private:
+            // Combine the lowest bins so that there are at most maxNumBins
+            // bins.
+            void Collapse(size_t maxNumBins)
+            {
+                if (mCounts.size() > maxNumBins)
+                {
+                    size_t excess = mCounts.size() - maxNumBins;
+                    uint64_t sum = 0;
+                    for (size_t i = 0; i <= excess; ++i)
+                    {
+                        sum += mCounts[i];
+                    }
+                    mCounts.erase(mCounts.begin(), mCounts.begin() + excess);
+                    mCounts[0] = sum;
+                    mOffset += static_cast<int>(excess);
+                }
+            }
+
+            int mOffset;
+            uint64_t mTotal;
+            std::vector<uint64_t> mCounts;
+        };
+
+        inline int GetIndex(Real magnitude) const
+        {
+            return static_cast<int>(std::ceil(std::log(magnitude) * mInvLogGamma));
+        }
+
+        inline Real GetValue(int index) const
+        {
+            return (Real)2 * std::pow(mGamma, static_cast<Real>(index)) / (mGamma + (Real)1);
+        }
+
+        Real mRelativeAccuracy;
+        size_t mMaxNumBins;
+        Real mGamma, mInvLogGamma;
+        Bins mPositive, mNegative;
+        uint64_t mNumZeros, mCount;
+        Real mMinimum, mMaximum;
+    };
+}
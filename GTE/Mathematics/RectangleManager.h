@@ -3,25 +3,62 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/IntrAlignedBox2AlignedBox2.h>
 #include <Mathematics/EdgeKey.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <set>
 #include <vector>
 
+// The manager supports two modes. Mode::INCREMENTAL is the sort-and-sweep
+// on both axes. The overlap set is updated by the swaps of an insertion
+// sort of the endpoints, which is fast when the motion is coherent and the
+// number of rectangles is small. With multiple threads the two axes are
+// sorted concurrently; the swaps are recorded and then applied to the
+// overlap set in the order x, y, so the set is the same as for one thread.
+//
+// Mode::SWEEP is for large numbers of rectangles. Each update selects the
+// axis along which the rectangle centers have the larger variance, sorts
+// the rectangles by their minima on that axis (an insertion sort when the
+// axis is that of the previous update and the order has not changed much)
+// and sweeps the sorted rectangles. The sweep is partitioned into blocks
+// of rectangles that are processed concurrently. The overlapping pairs are
+// stored in an array whose order does not depend on the number of threads,
+// and a flat hash table of the pairs supports HasOverlap(i,j).
+
 namespace gte
 {
     template <typename Real>
     class RectangleManager
     {
     public:
-        // Construction.
-        RectangleManager(std::vector<AlignedBox2<Real>>& rectangles)
+        enum class Mode
+        {
+            INCREMENTAL,
+            SWEEP
+        };
+
+        // Construction. The parallel parts of the updates are executed by
+        // numThreads threads, which are std::thread objects created for each
+        // call unless a scheduler is passed to the constructor or specified
+        // by SetScheduler(*).
+        RectangleManager(std::vector<AlignedBox2<Real>>& rectangles,
+            Mode mode = Mode::INCREMENTAL, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
             :
-            mRectangles(rectangles)
+            mRectangles(rectangles),
+            mMode(mode),
+            mNumThreads(numThreads),
+            mScheduler(scheduler),
+            mSweepAxis(-1),
+            mHashShift(60)
         {
             Initialize();
         }
@@ -32,6 +69,21 @@ namespace gte
         RectangleManager(RectangleManager const&) = delete;
         RectangleManager& operator=(RectangleManager const&) = delete;
 
+        // Execute the parallel parts of the updates as tasks of the
+        // scheduler, which can be shared with other computations, instead
+        // of creating threads for each call. The results do not depend on
+        // the scheduler. Set the scheduler to null to use std::thread
+        // objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
         // This function is called by the constructor and does the
         // sort-and-sweep to initialize the update system.  However, if you
         // add or remove items from the array of rectangles after the
@@ -39,6 +91,13 @@ namespace gte
         // you start the multiple calls of the update function.
         void Initialize()
         {
+            if (mMode == Mode::SWEEP)
+            {
+                mSweepAxis = -1;
+                Sweep();
+                return;
+            }
+
             // Get the rectangle endpoints.
             int intrSize = static_cast<int>(mRectangles.size()), endpSize = 2 * intrSize;
             mXEndpoints.resize(endpSize);
@@ -128,6 +187,11 @@ namespace gte
         void SetRectangle(int i, AlignedBox2<Real> const& rectangle)
         {
             mRectangles[i] = rectangle;
+            if (mMode == Mode::SWEEP)
+            {
+                return;
+            }
+
             mXEndpoints[mXLookup[2 * i]].value = rectangle.min[0];
             mXEndpoints[mXLookup[2 * i + 1]].value = rectangle.max[0];
             mYEndpoints[mYLookup[2 * i]].value = rectangle.min[1];
@@ -144,18 +208,104 @@ namespace gte
         // applied to determine the new set of overlapping rectangles.
         void Update()
         {
-            InsertionSort(mXEndpoints, mXLookup);
-            InsertionSort(mYEndpoints, mYLookup);
+            if (mMode == Mode::SWEEP)
+            {
+                Sweep();
+                return;
+            }
+
+            if (mNumThreads <= 1)
+            {
+                InsertionSort(mXEndpoints, mXLookup, nullptr);
+                InsertionSort(mYEndpoints, mYLookup, nullptr);
+                return;
+            }
+
+            std::array<std::vector<OverlapEvent>, 2> events;
+            TaskScheduler::ParallelForDynamic(mScheduler, 2, mNumThreads,
+                [this, &events](size_t axis)
+                {
+                    if (axis == 0)
+                    {
+                        InsertionSort(mXEndpoints, mXLookup, &events[0]);
+                    }
+                    else
+                    {
+                        InsertionSort(mYEndpoints, mYLookup, &events[1]);
+                    }
+                });
+
+            for (auto const& axisEvents : events)
+            {
+                for (auto const& event : axisEvents)
+                {
+                    if (event.insert)
+                    {
+                        mOverlap.insert(event.key);
+                    }
+                    else
+                    {
+                        mOverlap.erase(event.key);
+                    }
+                }
+            }
+        }
+
+        inline Mode GetMode() const
+        {
+            return mMode;
         }
 
         // If (i,j) is in the overlap set, then rectangle i and rectangle j
         // are overlapping.  The indices are those for the the input array.
-        // The set elements (i,j) are stored so that i < j.
+        // The set elements (i,j) are stored so that i < j.  The set is used
+        // only for Mode::INCREMENTAL.
         inline std::set<EdgeKey<false>> const& GetOverlap() const
         {
             return mOverlap;
         }
 
+        // The overlapping pairs (i,j), i < j, for Mode::SWEEP.
+        inline std::vector<EdgeKey<false>> const& GetOverlapPairs() const
+        {
+            return mOverlapPairs;
+        }
+
+        // The axis used by the last sweep of Mode::SWEEP.
+        inline int GetSweepAxis() const
+        {
+            return mSweepAxis;
+        }
+
+        // Test whether rectangles i and j overlap, for either mode.
+        bool HasOverlap(int i, int j) const
+        {
+            EdgeKey<false> key(i, j);
+            if (mMode == Mode::INCREMENTAL)
+            {
+                return mOverlap.find(key) != mOverlap.end();
+            }
+
+            if (mHashKeys.size() == 0)
+            {
+                return false;
+            }
+            uint64_t hashKey = GetHashKey(key);
+            size_t const mask = mHashKeys.size() - 1;
+            for (size_t slot = GetHashSlot(hashKey); ; slot = (slot + 1) & mask)
+            {
+                if (mHashKeys[slot] == hashKey)
+                {
+                    return true;
+                }
+                if (mHashKeys[slot] == msEmptyHashKey)
+                {
+                    return false;
+                }
+            }
+        }
+
+
     private:
         class Endpoint
         {
@@ -179,7 +329,17 @@ namespace gte
             }
         };
 
-        void InsertionSort(std::vector<Endpoint>& endpoint, std::vector<int>& lookup)
+        // A change to the overlap set found by InsertionSort.
+        struct OverlapEvent
+        {
+            EdgeKey<false> key;
+            bool insert;
+        };
+
+        // The overlap set is modified directly when 'events' is null;
+        // otherwise, the changes are appended to 'events'.
+        void InsertionSort(std::vector<Endpoint>& endpoint, std::vector<int>& lookup,
+            std::vector<OverlapEvent>* events)
         {
             // Apply an insertion sort.  Under the assumption that the
             // rectangles have not changed much since the last call, the
@@ -212,7 +372,14 @@ namespace gte
                             // expensive part of the operation, so there is no
                             // real time savings in testing for existence
                             // first, then deleting if it does.
-                            mOverlap.erase(EdgeKey<false>(e0.index, e1.index));
+                            if (events)
+                            {
+                                events->push_back(OverlapEvent{ EdgeKey<false>(e0.index, e1.index), false });
+                            }
+                            else
+                            {
+                                mOverlap.erase(EdgeKey<false>(e0.index, e1.index));
+                            }
                         }
                     }
                     else
@@ -227,7 +394,14 @@ namespace gte
                             // and then insert.
                             if (query(mRectangles[e0.index], mRectangles[e1.index]).intersect)
                             {
-                                mOverlap.insert(EdgeKey<false>(e0.index, e1.index));
+                                if (events)
+                                {
+                                    events->push_back(OverlapEvent{ EdgeKey<false>(e0.index, e1.index), true });
+                                }
+                                else
+                                {
+                                    mOverlap.insert(EdgeKey<false>(e0.index, e1.index));
+                                }
                             }
                         }
                     }
@@ -244,6 +418,191 @@ namespace gte
             }
         }
 
+        // The sweep of Mode::SWEEP.
+        void Sweep()
+        {
+            int const numRectangles = static_cast<int>(mRectangles.size());
+            mOverlapPairs.clear();
+            if (numRectangles == 0)
+            {
+                mHashKeys.clear();
+                return;
+            }
+
+            // Select the axis along which the rectangle centers have the largest
+            // variance. The centers are scaled by 2 to avoid divisions.
+            std::array<Real, 2> sum{ (Real)0, (Real)0 };
+            std::array<Real, 2> sumSqr{ (Real)0, (Real)0 };
+            for (auto const& rectangle : mRectangles)
+            {
+                for (int d = 0; d < 2; ++d)
+                {
+                    Real center = rectangle.min[d] + rectangle.max[d];
+                    sum[d] += center;
+                    sumSqr[d] += center * center;
+                }
+            }
+            Real const numRectanglesReal = static_cast<Real>(numRectangles);
+            int axis = 0;
+            Real maxVariance = sumSqr[0] - sum[0] * sum[0] / numRectanglesReal;
+            for (int d = 1; d < 2; ++d)
+            {
+                Real variance = sumSqr[d] - sum[d] * sum[d] / numRectanglesReal;
+                if (variance > maxVariance)
+                {
+                    maxVariance = variance;
+                    axis = d;
+                }
+            }
+
+            // Sort the rectangles by their minima on the sweep axis. When the
+            // axis has not changed, the previous order is nearly sorted.
+            bool presorted = (axis == mSweepAxis && mSweepOrder.size() == mRectangles.size());
+            if (!presorted)
+            {
+                mSweepOrder.resize(mRectangles.size());
+                for (int i = 0; i < numRectangles; ++i)
+                {
+                    mSweepOrder[i].second = i;
+                }
+            }
+            for (auto& element : mSweepOrder)
+            {
+                element.first = mRectangles[element.second].min[axis];
+            }
+            if (!presorted || !InsertionSort(mSweepOrder))
+            {
+                std::sort(mSweepOrder.begin(), mSweepOrder.end());
+            }
+            mSweepAxis = axis;
+
+            // Copy the rectangle extremes in sorted order for the sweep.
+            for (int d = 0; d < 2; ++d)
+            {
+                mSortedMin[d].resize(mRectangles.size());
+                mSortedMax[d].resize(mRectangles.size());
+            }
+            for (int r = 0; r < numRectangles; ++r)
+            {
+                AlignedBox2<Real> const& rectangle = mRectangles[mSweepOrder[r].second];
+                for (int d = 0; d < 2; ++d)
+                {
+                    mSortedMin[d][r] = rectangle.min[d];
+                    mSortedMax[d][r] = rectangle.max[d];
+                }
+            }
+
+            // Sweep blocks of rectangles concurrently. The rectangle of rank r
+            // overlaps on the sweep axis the rectangles of ranks r+1, r+2, ...
+            // whose minima are not larger than its maximum.
+            int const b0 = 1 - axis;
+            size_t const numBlocks = (static_cast<size_t>(numRectangles) + msBlockSize - 1) / msBlockSize;
+            std::vector<std::vector<EdgeKey<false>>> blockPairs(numBlocks);
+            TaskScheduler::ParallelForDynamic(mScheduler, numBlocks, mNumThreads,
+                [this, numRectangles, axis, b0, &blockPairs](size_t block)
+                {
+                    Real const* min0 = mSortedMin[axis].data();
+                    Real const* max0 = mSortedMax[axis].data();
+                    Real const* min1 = mSortedMin[b0].data();
+                    Real const* max1 = mSortedMax[b0].data();
+                    std::vector<EdgeKey<false>>& pairs = blockPairs[block];
+                    int rmin = static_cast<int>(block * msBlockSize);
+                    int rmax = std::min(rmin + static_cast<int>(msBlockSize), numRectangles);
+                    for (int r = rmin; r < rmax; ++r)
+                    {
+                        // The candidates are tested without early outs so
+                        // that the compiler can vectorize the loop.
+                        int qmax = r + 1;
+                        while (qmax < numRectangles && min0[qmax] <= max0[r])
+                        {
+                            ++qmax;
+                        }
+                        Real const rmin1 = min1[r], rmax1 = max1[r];
+                        for (int q = r + 1; q < qmax; ++q)
+                        {
+                            if ((rmax1 >= min1[q]) & (rmin1 <= max1[q]))
+                            {
+                                pairs.push_back(EdgeKey<false>(
+                                    mSweepOrder[r].second, mSweepOrder[q].second));
+                            }
+                        }
+                    }
+                });
+
+            size_t numPairs = 0;
+            for (auto const& pairs : blockPairs)
+            {
+                numPairs += pairs.size();
+            }
+            mOverlapPairs.reserve(numPairs);
+            for (auto const& pairs : blockPairs)
+            {
+                mOverlapPairs.insert(mOverlapPairs.end(), pairs.begin(), pairs.end());
+            }
+
+            // Build the hash table of pairs with load factor at most 1/2.
+            size_t capacity = 16;
+            mHashShift = 60;
+            while (capacity < 2 * numPairs)
+            {
+                capacity *= 2;
+                --mHashShift;
+            }
+            mHashKeys.assign(capacity, static_cast<uint64_t>(msEmptyHashKey));
+            size_t const mask = capacity - 1;
+            for (auto const& key : mOverlapPairs)
+            {
+                uint64_t hashKey = GetHashKey(key);
+                size_t slot = GetHashSlot(hashKey);
+                while (mHashKeys[slot] != msEmptyHashKey)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                mHashKeys[slot] = hashKey;
+            }
+        }
+
+        // Sort nearly sorted (value,index) pairs. The function returns
+        // 'false' without completing the sort when the number of moves
+        // indicates that the order has changed too much.
+        static bool InsertionSort(std::vector<std::pair<Real, int>>& elements)
+        {
+            size_t const maxMoves = 8 * elements.size();
+            size_t numMoves = 0;
+            for (size_t j = 1; j < elements.size(); ++j)
+            {
+                std::pair<Real, int> key = elements[j];
+                size_t i = j;
+                while (i > 0 && key < elements[i - 1])
+                {
+                    elements[i] = elements[i - 1];
+                    --i;
+                }
+                elements[i] = key;
+                numMoves += j - i;
+                if (numMoves > maxMoves)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        inline static uint64_t GetHashKey(EdgeKey<false> const& key)
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(key.V[0])) << 32)
+                | static_cast<uint64_t>(static_cast<uint32_t>(key.V[1]));
+        }
+
+        inline size_t GetHashSlot(uint64_t hashKey) const
+        {
+            return static_cast<size_t>((hashKey * 0x9E3779B97F4A7C15ull) >> mHashShift);
+        }
+
+        // The number of sorted rectangles in a block of the sweep.
+        enum { msBlockSize = 256 };
+        static uint64_t constexpr msEmptyHashKey = std::numeric_limits<uint64_t>::max();
+
         std::vector<AlignedBox2<Real>>& mRectangles;
         std::vector<Endpoint> mXEndpoints, mYEndpoints;
         std::set<EdgeKey<false>> mOverlap;
@@ -259,5 +618,20 @@ namespace gte
         // endpoint array.  The value mLookup[2*i+1] is the index of e[i]
         // in the endpoint array.
         std::vector<int> mXLookup, mYLookup;
+
+        Mode mMode;
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
+
+        // The data of Mode::SWEEP. The (value,index) pairs are the minima
+        // on the sweep axis of the rectangles in sorted order. The hash
+        // table stores pairs (i,j) as (i << 32) | j, and the slot of a key
+        // is given by the high-order bits of a multiplicative hash.
+        int mSweepAxis;
+        std::vector<std::pair<Real, int>> mSweepOrder;
+        std::array<std::vector<Real>, 2> mSortedMin, mSortedMax;
+        std::vector<EdgeKey<false>> mOverlapPairs;
+        std::vector<uint64_t> mHashKeys;
+        int mHashShift;
     };
 }
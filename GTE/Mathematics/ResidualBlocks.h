@@ -0,0 +1,544 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BlockedMatrixProduct.h>
+#include <Mathematics/CSRMatrix.h>
+#include <Mathematics/GMatrix.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+// The function F(p) of a nonlinear least-squares problem (see
+// GaussNewtonMinimizer.h) partitioned into blocks of residuals. Block b
+// has numRows residuals F_b(p) that depend only on the parameters
+// p[parameters[k]] for 0 <= k < parameters.size(); an empty list means that
+// the block depends on all the parameters in their natural order. The
+// Jacobian of the block is the numRows-by-parameters.size() matrix J_b of
+// the derivatives with respect to those parameters. The caller provides a
+// function that computes F_b and, when its pointer is not null, J_b stored
+// in row-major order. The function is called concurrently for different
+// blocks when a TaskScheduler is provided, so it must be reentrant.
+//
+// The class computes F(p), J^T*J and -J^T*F from the blocks in parallel,
+// never storing J. Its GetFFunction, GetJPlusFunction and
+// GetSparseJPlusFunction create the function objects for the constructors
+// of GaussNewtonMinimizer and LevenbergMarquardtMinimizer.
+//
+// DENSE assembly computes J^T*J as a GMatrix. The rows of consecutive
+// blocks are gathered into dense chunks of at least CHUNK_ROWS rows whose
+// products are accumulated with BlockedMatrixProduct. SPARSE assembly is
+// for problems where every block depends on a few parameters, such as the
+// camera and point parameters of a bundle adjustment. J^T*J is a CSRMatrix
+// with the structure of the union of the parameter pairs of the blocks,
+// which is computed once by the constructor, and the normal equations are
+// solved by SparseCholesky. In both cases the terms of every sum are added
+// in an order that depends only on the blocks, so the results do not
+// depend on the number of threads.
+
+namespace gte
+{
+    template <typename Real>
+    class ResidualBlocks
+    {
+    public:
+        struct Block
+        {
+            Block()
+                :
+                numRows(0)
+            {
+            }
+
+            Block(int inNumRows, std::vector<int> const& inParameters)
+                :
+                numRows(inNumRows),
+                parameters(inParameters)
+            {
+            }
+
+            int numRows;
+            std::vector<int> parameters;
+        };
+
+        enum class Assembly
+        {
+            DENSE,
+            SPARSE
+        };
+
+        typedef GVector<Real> DVector;
+        typedef GVector<Real> RVector;
+        typedef GMatrix<Real> JTJMatrix;
+        typedef CSRMatrix<Real> SparseJTJMatrix;
+        typedef GVector<Real> JTFVector;
+        typedef std::function<void(DVector const&, int, Real*, Real*)> BlockFunction;
+        typedef std::function<void(DVector const&, RVector&)> FFunction;
+        typedef std::function<void(DVector const&, JTJMatrix&, JTFVector&)> JPlusFunction;
+        typedef std::function<void(DVector const&, SparseJTJMatrix&, JTFVector&)> SparseJPlusFunction;
+
+        ResidualBlocks(int numPDimensions, std::vector<Block> const& blocks,
+            BlockFunction const& function, Assembly assembly = Assembly::DENSE,
+            TaskScheduler* scheduler = nullptr)
+            :
+            mNumPDimensions(numPDimensions),
+            mBlocks(blocks),
+            mFunction(function),
+            mAssembly(assembly),
+            mScheduler(scheduler)
+        {
+            LogAssert(numPDimensions > 0 && blocks.size() > 0, "Invalid input.");
+
+            int const numBlocks = GetNumBlocks();
+            mRowOffsets.resize(static_cast<size_t>(numBlocks) + 1);
+            mRowOffsets[0] = 0;
+            std::vector<bool> used(numPDimensions);
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                Block& block = mBlocks[b];
+                LogAssert(block.numRows > 0, "Invalid input.");
+                if (block.parameters.size() == 0)
+                {
+                    block.parameters.resize(numPDimensions);
+                    for (int j = 0; j < numPDimensions; ++j)
+                    {
+                        block.parameters[j] = j;
+                    }
+                }
+                for (auto j : block.parameters)
+                {
+                    LogAssert(0 <= j && j < numPDimensions && !used[j], "Invalid parameter index.");
+                    used[j] = true;
+                }
+                for (auto j : block.parameters)
+                {
+                    used[j] = false;
+                }
+                mRowOffsets[b + 1] = mRowOffsets[b] + block.numRows;
+            }
+
+            if (assembly == Assembly::DENSE)
+            {
+                CreateChunks();
+            }
+            else
+            {
+                CreateSparsity();
+            }
+        }
+
+        // Member access.
+        inline int GetNumPDimensions() const
+        {
+            return mNumPDimensions;
+        }
+
+        inline int GetNumFDimensions() const
+        {
+            return mRowOffsets.back();
+        }
+
+        inline int GetNumBlocks() const
+        {
+            return static_cast<int>(mBlocks.size());
+        }
+
+        inline std::vector<Block> const& GetBlocks() const
+        {
+            return mBlocks;
+        }
+
+        inline Assembly GetAssembly() const
+        {
+            return mAssembly;
+        }
+
+        // The structure of J^T*J for SPARSE assembly, with zero values.
+        inline SparseJTJMatrix const& GetSparsity() const
+        {
+            return mSparsity;
+        }
+
+        // Compute F(p), which has GetNumFDimensions() elements; the residuals
+        // of block b are at the indices starting at the sum of the numRows
+        // of the blocks before b.
+        void ComputeF(DVector const& p, RVector& F) const
+        {
+            F.SetSize(GetNumFDimensions());
+            Execute(mBlocks.size(), [this, &p, &F](size_t b0, size_t b1)
+            {
+                for (size_t b = b0; b < b1; ++b)
+                {
+                    mFunction(p, static_cast<int>(b), &F[mRowOffsets[b]], nullptr);
+                }
+            });
+        }
+
+        // Compute J^T*J and -J^T*F at p for DENSE assembly.
+        void ComputeJTJ(DVector const& p, JTJMatrix& JTJ, JTFVector& negJTF) const
+        {
+            LogAssert(mAssembly == Assembly::DENSE, "The assembly is not DENSE.");
+            int const m = mNumPDimensions;
+            size_t const mm = static_cast<size_t>(m) * m;
+            size_t const numGroups = mGroupStarts.size() - 1;
+            std::vector<Real> groupJTJ(numGroups * mm, (Real)0);
+            std::vector<Real> groupJTF(numGroups * m, (Real)0);
+
+            Execute(numGroups, [this, &p, &groupJTJ, &groupJTF, m, mm](size_t g0, size_t g1)
+            {
+                std::vector<Real> chunkJ, chunkF, blockJ;
+                for (size_t g = g0; g < g1; ++g)
+                {
+                    Real* partialJTJ = &groupJTJ[g * mm];
+                    Real* partialJTF = &groupJTF[g * m];
+                    for (size_t c = mGroupStarts[g]; c < mGroupStarts[g + 1]; ++c)
+                    {
+                        int const firstBlock = mChunkStarts[c];
+                        int const lastBlock = mChunkStarts[c + 1];
+                        int const firstRow = mRowOffsets[firstBlock];
+                        int const numRows = mRowOffsets[lastBlock] - firstRow;
+                        chunkJ.assign(static_cast<size_t>(numRows) * m, (Real)0);
+                        chunkF.resize(numRows);
+                        for (int b = firstBlock; b < lastBlock; ++b)
+                        {
+                            Block const& block = mBlocks[b];
+                            int const numParameters = static_cast<int>(block.parameters.size());
+                            int const row0 = mRowOffsets[b] - firstRow;
+                            blockJ.resize(static_cast<size_t>(block.numRows) * numParameters);
+                            mFunction(p, b, &chunkF[row0], blockJ.data());
+                            for (int r = 0; r < block.numRows; ++r)
+                            {
+                                Real* target = &chunkJ[static_cast<size_t>(row0 + r) * m];
+                                Real const* source = &blockJ[static_cast<size_t>(r) * numParameters];
+                                for (int k = 0; k < numParameters; ++k)
+                                {
+                                    target[block.parameters[k]] = source[k];
+                                }
+                            }
+                        }
+
+                        // partialJTJ += chunkJ^T * chunkJ, partialJTF +=
+                        // chunkJ^T * chunkF.
+                        AccumulateATA(numRows, m, chunkJ.data(), partialJTJ);
+                        for (int r = 0; r < numRows; ++r)
+                        {
+                            Real const* row = &chunkJ[static_cast<size_t>(r) * m];
+                            for (int j = 0; j < m; ++j)
+                            {
+                                partialJTF[j] += row[j] * chunkF[r];
+                            }
+                        }
+                    }
+                }
+            });
+
+            JTJ.SetSize(m, m);
+            negJTF.SetSize(m);
+            for (int r = 0; r < m; ++r)
+            {
+                for (int c = 0; c < m; ++c)
+                {
+                    Real sum = (Real)0;
+                    for (size_t g = 0; g < numGroups; ++g)
+                    {
+                        sum += groupJTJ[g * mm + static_cast<size_t>(r) * m + c];
+                    }
+                    JTJ(r, c) = sum;
+                }
+
+                Real sum = (Real)0;
+                for (size_t g = 0; g < numGroups; ++g)
+                {
+                    sum += groupJTF[g * m + r];
+                }
+                negJTF[r] = -sum;
+            }
+        }
+
+        // Compute J^T*J and -J^T*F at p for SPARSE assembly. JTJ is assigned
+        // GetSparsity() when it does not have the same number of nonzeros.
+        void ComputeJTJ(DVector const& p, SparseJTJMatrix& JTJ, JTFVector& negJTF) const
+        {
+            LogAssert(mAssembly == Assembly::SPARSE, "The assembly is not SPARSE.");
+            if (JTJ.GetNumRows() != mNumPDimensions
+                || JTJ.GetNumNonzeros() != mSparsity.GetNumNonzeros())
+            {
+                JTJ = mSparsity;
+            }
+
+            // The products J_b^T*J_b and J_b^T*F_b of the blocks.
+            std::vector<Real> products(mProductOffsets.back());
+            std::vector<Real> gradients(mGradientOffsets.back());
+            Execute(mBlocks.size(), [this, &p, &products, &gradients](size_t b0, size_t b1)
+            {
+                std::vector<Real> blockF, blockJ;
+                for (size_t b = b0; b < b1; ++b)
+                {
+                    Block const& block = mBlocks[b];
+                    int const numParameters = static_cast<int>(block.parameters.size());
+                    blockF.resize(block.numRows);
+                    blockJ.resize(static_cast<size_t>(block.numRows) * numParameters);
+                    mFunction(p, static_cast<int>(b), blockF.data(), blockJ.data());
+
+                    Real* product = &products[mProductOffsets[b]];
+                    Real* gradient = &gradients[mGradientOffsets[b]];
+                    std::fill(product, product + static_cast<size_t>(numParameters) * numParameters, (Real)0);
+                    std::fill(gradient, gradient + numParameters, (Real)0);
+                    AccumulateATA(block.numRows, numParameters, blockJ.data(), product);
+                    for (int r = 0; r < block.numRows; ++r)
+                    {
+                        Real const* row = &blockJ[static_cast<size_t>(r) * numParameters];
+                        for (int k = 0; k < numParameters; ++k)
+                        {
+                            gradient[k] += row[k] * blockF[r];
+                        }
+                    }
+                }
+            });
+
+            // Add the contributions to each entry in block order.
+            std::vector<Real>& values = JTJ.GetValues();
+            negJTF.SetSize(mNumPDimensions);
+            Execute(static_cast<size_t>(mNumPDimensions), [this, &products, &gradients,
+                &values, &negJTF](size_t r0, size_t r1)
+            {
+                auto const& rowOffsets = mSparsity.GetRowOffsets();
+                for (size_t r = r0; r < r1; ++r)
+                {
+                    for (size_t e = rowOffsets[r]; e < rowOffsets[r + 1]; ++e)
+                    {
+                        Real sum = (Real)0;
+                        for (size_t i = mEntryOffsets[e]; i < mEntryOffsets[e + 1]; ++i)
+                        {
+                            sum += products[mEntrySlots[i]];
+                        }
+                        values[e] = sum;
+                    }
+
+                    Real sum = (Real)0;
+                    for (size_t i = mParameterOffsets[r]; i < mParameterOffsets[r + 1]; ++i)
+                    {
+                        sum += gradients[mParameterSlots[i]];
+                    }
+                    negJTF[static_cast<int>(r)] = -sum;
+                }
+            });
+        }
+
+        // Function objects for the minimizer constructors. The object must
+        // exist while the function objects are used.
+        FFunction GetFFunction() const
+        {
+            return [this](DVector const& p, RVector& F) { ComputeF(p, F); };
+        }
+
+        JPlusFunction GetJPlusFunction() const
+        {
+            return [this](DVector const& p, JTJMatrix& JTJ, JTFVector& negJTF)
+            {
+                ComputeJTJ(p, JTJ, negJTF);
+            };
+        }
+
+        SparseJPlusFunction GetSparseJPlusFunction() const
+        {
+            return [this](DVector const& p, SparseJTJMatrix& JTJ, JTFVector& negJTF)
+            {
+                ComputeJTJ(p, JTJ, negJTF);
+            };
+        }
+
+    private:
+        // The minimum number of residuals of a chunk and the maximum number
+        // of partial sums of J^T*J for DENSE assembly; the number of partial
+        // sums is also limited to use at most MAX_GROUP_ELEMENTS elements.
+        enum
+        {
+            CHUNK_ROWS = 128,
+            MAX_GROUPS = 32,
+            MAX_GROUP_ELEMENTS = 1 << 22
+        };
+
+        void CreateChunks()
+        {
+            int const numBlocks = GetNumBlocks();
+            mChunkStarts.clear();
+            for (int b = 0; b < numBlocks; )
+            {
+                mChunkStarts.push_back(b);
+                int const firstRow = mRowOffsets[b];
+                while (b < numBlocks && mRowOffsets[b] - firstRow < CHUNK_ROWS)
+                {
+                    ++b;
+                }
+            }
+            size_t const numChunks = mChunkStarts.size();
+            mChunkStarts.push_back(numBlocks);
+
+            size_t const mm = static_cast<size_t>(mNumPDimensions) * mNumPDimensions;
+            size_t numGroups = std::min(static_cast<size_t>(MAX_GROUPS), numChunks);
+            numGroups = std::max(std::min(numGroups, MAX_GROUP_ELEMENTS / mm), static_cast<size_t>(1));
+            mGroupStarts.resize(numGroups + 1);
+            for (size_t g = 0; g <= numGroups; ++g)
+            {
+                mGroupStarts[g] = g * numChunks / numGroups;
+            }
+        }
+
+        void CreateSparsity()
+        {
+            int const numBlocks = GetNumBlocks();
+            mProductOffsets.resize(static_cast<size_t>(numBlocks) + 1);
+            mGradientOffsets.resize(static_cast<size_t>(numBlocks) + 1);
+            mProductOffsets[0] = 0;
+            mGradientOffsets[0] = 0;
+            std::vector<typename SparseJTJMatrix::Triplet> triplets;
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                auto const& parameters = mBlocks[b].parameters;
+                size_t const numParameters = parameters.size();
+                for (auto r : parameters)
+                {
+                    for (auto c : parameters)
+                    {
+                        triplets.push_back(typename SparseJTJMatrix::Triplet(r, c, (Real)0));
+                    }
+                }
+                mProductOffsets[b + 1] = mProductOffsets[b] + numParameters * numParameters;
+                mGradientOffsets[b + 1] = mGradientOffsets[b] + numParameters;
+            }
+            mSparsity.Create(mNumPDimensions, mNumPDimensions, triplets);
+            triplets.clear();
+            triplets.shrink_to_fit();
+
+            // The slots of the block products that contribute to each entry
+            // and to each parameter, in block order.
+            size_t const numNonzeros = mSparsity.GetNumNonzeros();
+            std::vector<size_t> entryOfSlot(mProductOffsets.back());
+            mEntryOffsets.assign(numNonzeros + 1, 0);
+            mParameterOffsets.assign(static_cast<size_t>(mNumPDimensions) + 1, 0);
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                auto const& parameters = mBlocks[b].parameters;
+                size_t slot = mProductOffsets[b];
+                for (auto r : parameters)
+                {
+                    for (auto c : parameters)
+                    {
+                        size_t e = mSparsity.GetIndex(r, c);
+                        entryOfSlot[slot++] = e;
+                        ++mEntryOffsets[e + 1];
+                    }
+                    ++mParameterOffsets[static_cast<size_t>(r) + 1];
+                }
+            }
+            for (size_t e = 0; e < numNonzeros; ++e)
+            {
+                mEntryOffsets[e + 1] += mEntryOffsets[e];
+            }
+            for (int j = 0; j < mNumPDimensions; ++j)
+            {
+                mParameterOffsets[j + 1] += mParameterOffsets[j];
+            }
+
+            mEntrySlots.resize(mEntryOffsets.back());
+            std::vector<size_t> next(mEntryOffsets.begin(), mEntryOffsets.end() - 1);
+            for (size_t slot = 0; slot < entryOfSlot.size(); ++slot)
+            {
+                mEntrySlots[next[entryOfSlot[slot]]++] = slot;
+            }
+
+            mParameterSlots.resize(mParameterOffsets.back());
+            next.assign(mParameterOffsets.begin(), mParameterOffsets.end() - 1);
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                size_t slot = mGradientOffsets[b];
+                for (auto r : mBlocks[b].parameters)
+                {
+                    mParameterSlots[next[r]++] = slot++;
+                }
+            }
+        }
+
+        // C += A^T*A, where A is numRows-by-numCols and C is
+        // numCols-by-numCols, both row-major. The terms of C(r,c) are added
+        // in row order.
+        static void AccumulateATA(int numRows, int numCols, Real const* A, Real* C)
+        {
+            if (static_cast<double>(numRows) * static_cast<double>(numCols) *
+                static_cast<double>(numCols) >= static_cast<double>(BlockedMatrixProduct<Real>::THRESHOLD))
+            {
+                BlockedMatrixProduct<Real>::Execute(numCols, numCols, numRows,
+                    A, 1, numCols, A, numCols, 1, C, numCols, 1);
+                return;
+            }
+
+            for (int i = 0; i < numRows; ++i)
+            {
+                Real const* row = A + static_cast<size_t>(i) * numCols;
+                for (int r = 0; r < numCols; ++r)
+                {
+                    Real const value = row[r];
+                    Real* target = C + static_cast<size_t>(r) * numCols;
+                    for (int c = 0; c < numCols; ++c)
+                    {
+                        target[c] += value * row[c];
+                    }
+                }
+            }
+        }
+
+        // Execute function(i0,i1) for subranges [i0,i1) of the items, in
+        // parallel when the scheduler is not null.
+        template <typename Function>
+        void Execute(size_t numItems, Function const& function) const
+        {
+            size_t const numChunks = std::min(numItems,
+                (mScheduler ? 4 * mScheduler->GetNumThreads() : 1));
+            if (numChunks <= 1)
+            {
+                function(0, numItems);
+                return;
+            }
+
+            TaskScheduler::TaskGroup group;
+            for (size_t c = 1; c < numChunks; ++c)
+            {
+                size_t i0 = c * numItems / numChunks;
+                size_t i1 = (c + 1) * numItems / numChunks;
+                mScheduler->Spawn(group, [&function, i0, i1]() { function(i0, i1); });
+            }
+            function(0, numItems / numChunks);
+            mScheduler->Wait(group);
+        }
+
+        int mNumPDimensions;
+        std::vector<Block> mBlocks;
+        BlockFunction mFunction;
+        Assembly mAssembly;
+        TaskScheduler* mScheduler;
+        std::vector<int> mRowOffsets;
+
+        // DENSE assembly. Chunk c has the blocks mChunkStarts[c] <= b <
+        // mChunkStarts[c+1] and group g has the chunks mGroupStarts[g] <= c
+        // < mGroupStarts[g+1].
+        std::vector<int> mChunkStarts;
+        std::vector<size_t> mGroupStarts;
+
+        // SPARSE assembly. The products of block b start at
+        // mProductOffsets[b] and its gradient at mGradientOffsets[b]. The
+        // slots of the products contributing to entry e of mSparsity are
+        // mEntrySlots[i] for mEntryOffsets[e] <= i < mEntryOffsets[e+1] and
+        // likewise for the gradient of parameter j.
+        SparseJTJMatrix mSparsity;
+        std::vector<size_t> mProductOffsets, mGradientOffsets;
+        std::vector<size_t> mEntryOffsets, mEntrySlots;
+        std::vector<size_t> mParameterOffsets, mParameterSlots;
+    };
+}
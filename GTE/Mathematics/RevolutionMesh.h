@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -220,88 +220,70 @@ namespace gte
             }
         }
 
+        // The curve samples and the rows are computed in parallel when a
+        // scheduler is set, which requires the evaluation of the curve to
+        // be safe to call concurrently, as it is for the curves of this
+        // library. The arc length table of the curve is updated before the
+        // samples are computed.
         virtual void UpdatePositions() override
         {
-            unsigned int const numSamples = static_cast<unsigned int>(mSamples.size());
-            for (unsigned int i = 0; i < numSamples; ++i)
+            if (mSampleByArcLength)
             {
-                Real t = mTSampler(i);
-                Vector2<Real> position = mCurve->GetPosition(t);
-                mSamples[i][0] = position[0];
-                mSamples[i][1] = (Real)0;
-                mSamples[i][2] = position[1];
+                (void)mCurve->GetTotalLength();
             }
 
+            this->ParallelFor(static_cast<uint32_t>(mSamples.size()),
+                [this](uint32_t imin, uint32_t imax)
+                {
+                    for (uint32_t i = imin; i < imax; ++i)
+                    {
+                        Real t = mTSampler(i);
+                        Vector2<Real> position = mCurve->GetPosition(t);
+                        mSamples[i][0] = position[0];
+                        mSamples[i][1] = (Real)0;
+                        mSamples[i][2] = position[1];
+                    }
+                });
+
             switch (this->mDescription.topology)
             {
             case MeshTopology::CYLINDER:
-                UpdateCylinderPositions();
-                break;
             case MeshTopology::TORUS:
-                UpdateTorusPositions();
+                UpdateRowPositions(0);
                 break;
             case MeshTopology::DISK:
-                UpdateDiskPositions();
+                UpdateRowPositions(1);
+                this->Position(this->mDescription.numVertices - 1) = { (Real)0, (Real)0, mSamples.front()[2] };
                 break;
             case MeshTopology::SPHERE:
-                UpdateSpherePositions();
+                UpdateRowPositions(1);
+                this->Position(this->mDescription.numVertices - 2) = { (Real)0, (Real)0, mSamples.front()[2] };
+                this->Position(this->mDescription.numVertices - 1) = { (Real)0, (Real)0, mSamples.back()[2] };
                 break;
             default:
                 break;
             }
         }
 
-        void UpdateCylinderPositions()
-        {
-            for (unsigned int r = 0, i = 0; r <= this->mDescription.rMax; ++r)
-            {
-                Real radius = mSamples[r][0];
-                for (unsigned int c = 0; c <= this->mDescription.cMax; ++c, ++i)
-                {
-                    this->Position(i) = { radius * mCosAngle[c], radius * mSinAngle[c], mSamples[r][2] };
-                }
-            }
-        }
-
-        void UpdateTorusPositions()
-        {
-            for (unsigned int r = 0, i = 0; r <= this->mDescription.rMax; ++r)
-            {
-                Real radius = mSamples[r][0];
-                for (unsigned int c = 0; c <= this->mDescription.cMax; ++c, ++i)
-                {
-                    this->Position(i) = { radius * mCosAngle[c], radius * mSinAngle[c], mSamples[r][2] };
-                }
-            }
-        }
-
-        void UpdateDiskPositions()
+        // Row r of the vertices is the circle of revolution of sample
+        // r+firstSample. The disk and sphere topologies skip the first
+        // sample, which is at a pole.
+        void UpdateRowPositions(uint32_t firstSample)
         {
-            for (unsigned int r = 0, rp1 = 1, i = 0; r <= this->mDescription.rMax; ++r, ++rp1)
-            {
-                Real radius = mSamples[rp1][0];
-                for (unsigned int c = 0; c <= this->mDescription.cMax; ++c, ++i)
+            uint32_t const rowSize = this->mDescription.cMax + 1;
+            this->ParallelFor(this->mDescription.rMax + 1,
+                [this, firstSample, rowSize](uint32_t rmin, uint32_t rmax)
                 {
-                    this->Position(i) = { radius * mCosAngle[c], radius * mSinAngle[c], mSamples[rp1][2] };
-                }
-            }
-
-            this->Position(this->mDescription.numVertices - 1) = { (Real)0, (Real)0, mSamples.front()[2] };
-        }
-
-        void UpdateSpherePositions()
-        {
-            for (unsigned int r = 0, rp1 = 1, i = 0; r <= this->mDescription.rMax; ++r, ++rp1)
-            {
-                Real radius = mSamples[rp1][0];
-                for (unsigned int c = 0; c <= this->mDescription.cMax; ++c, ++i)
-                {
-                    this->Position(i) = { radius * mCosAngle[c], radius * mSinAngle[c], mSamples[rp1][2] };
-                }
-            }
-
-            this->Position(this->mDescription.numVertices - 2) = { (Real)0, (Real)0, mSamples.front()[2] };
-            this->Position(this->mDescription.numVertices - 1) = { (Real)0, (Real)0, mSamples.back()[2] };
+                    for (uint32_t r = rmin; r < rmax; ++r)
+                    {
+                        Real radius = mSamples[r + firstSample][0];
+                        Real height = mSamples[r + firstSample][2];
+                        for (uint32_t c = 0, i = r * rowSize; c < rowSize; ++c, ++i)
+                        {
+                            this->Position(i) = { radius * mCosAngle[c], radius * mSinAngle[c], height };
+                        }
+                    }
+                });
         }
 
         std::shared_ptr<ParametricCurve<2, Real>> mCurve;
@@ -0,0 +1,1333 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/DistPointOrientedBox.h>
+#include <Mathematics/DistSegmentSegment.h>
+#include <Mathematics/DistSegment3OrientedBox3.h>
+#include <Mathematics/DynamicAABBTree.h>
+#include <Mathematics/IntrCapsule3Capsule3.h>
+#include <Mathematics/IntrOrientedBox3OrientedBox3.h>
+#include <Mathematics/RigidBody.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// A collision pipeline for rigid bodies whose shapes are oriented boxes and
+// capsules. Each call to Update(dt) executes
+//   1. the broad phase: the boxes that bound the awake bodies are updated in
+//      a DynamicAABBTree and the tree is queried for the pairs of bodies
+//      whose bounding boxes overlap;
+//   2. the narrow phase: the contact manifolds of the pairs are computed,
+//      up to 4 points for a pair of boxes, and the impulses of the
+//      manifolds of the previous step are carried over to the matching
+//      contact points (warm starting);
+//   3. the construction of the islands, the sets of bodies connected by
+//      contacts, where the static bodies do not connect islands;
+//   4. the solver: the islands are solved independently by sequential
+//      impulses with friction and restitution, followed by semi-implicit
+//      Euler integration of the velocities and positions;
+//   5. sleeping: an island whose bodies have been slow for timeToSleep
+//      seconds is put to sleep and is no longer simulated until an awake
+//      body touches it or WakeUp is called.
+// The narrow phase and the solver are multithreaded when a TaskScheduler is
+// passed to the constructor. The cost of a step is proportional to the
+// number of awake bodies and contacts, so worlds with tens of thousands of
+// mostly sleeping bodies are practical.
+//
+// The rigid bodies are RigidBody<Real> objects whose state is read and
+// written by the world, but the contact solver does not use the RK4 solver
+// RigidBody::Update, which does not support impulses. A body with mass 0 or
+// infinite mass is static. The body coordinates of a box are those of
+// OrientedBox3 with the box center at the body position and the box axes
+// the columns of the rotation matrix. The segment of a capsule is along the
+// body z-axis and centered at the body position. After changing the state
+// of a body through GetBody, call WakeUp for the body.
+
+namespace gte
+{
+    template <typename Real>
+    class RigidBodyWorld
+    {
+    public:
+        enum class Shape
+        {
+            BOX,
+            CAPSULE
+        };
+
+        struct Parameters
+        {
+            Parameters()
+                :
+                gravity{ (Real)0, (Real)0, (Real)-9.81 },
+                numIterations(10),
+                baumgarte((Real)0.2),
+                slop((Real)0.005),
+                contactDistance((Real)0.02),
+                matchDistance((Real)0.05),
+                aabbMargin((Real)0.1),
+                restitutionThreshold((Real)1),
+                linearSleepSpeed((Real)0.05),
+                angularSleepSpeed((Real)0.05),
+                timeToSleep((Real)0.5)
+            {
+            }
+
+            Vector3<Real> gravity;
+
+            // The number of velocity iterations of the contact solver.
+            int numIterations;
+
+            // The fraction of the penetration in excess of the slop that is
+            // removed per step.
+            Real baumgarte, slop;
+
+            // Contact points are generated for separations smaller than
+            // contactDistance, which lets the solver stop bodies before they
+            // penetrate. A contact point inherits the impulses of a contact
+            // point of the previous step that is within matchDistance in the
+            // coordinates of the first body.
+            Real contactDistance, matchDistance;
+
+            // The enlargement of the boxes of the broad phase.
+            Real aabbMargin;
+
+            // Restitution is applied when the approaching speed exceeds
+            // the threshold.
+            Real restitutionThreshold;
+
+            // A body is slow when its speeds are smaller than these.
+            Real linearSleepSpeed, angularSleepSpeed, timeToSleep;
+        };
+
+        struct Contact
+        {
+            Vector3<Real> point;    // world coordinates
+            Vector3<Real> localA, localB;
+            Real separation;        // negative when penetrating
+            Real normalImpulse;
+            std::array<Real, 2> tangentImpulse;
+        };
+
+        // The normal is unit length and points from body[0] to body[1].
+        struct Manifold
+        {
+            std::array<int, 2> body;
+            Vector3<Real> normal;
+            int numContacts;
+            std::array<Contact, 4> contacts;
+        };
+
+        RigidBodyWorld(Parameters const& parameters = Parameters(),
+            TaskScheduler* scheduler = nullptr)
+            :
+            mParameters(parameters),
+            mScheduler(scheduler),
+            mNumBodies(0)
+        {
+        }
+
+        // Add a body and return its identifier. The extents of a box are
+        // those of OrientedBox3. The capsule segment has the specified half
+        // length. The inertia tensor is computed for a uniform density.
+        int AddBox(Vector3<Real> const& extent, Real mass,
+            Vector3<Real> const& position, Quaternion<Real> const& orientation,
+            Real friction = (Real)0.5, Real restitution = (Real)0)
+        {
+            Real const e0 = extent[0] * extent[0];
+            Real const e1 = extent[1] * extent[1];
+            Real const e2 = extent[2] * extent[2];
+            Real const third = mass / (Real)3;
+            Matrix3x3<Real> inertia{};
+            inertia(0, 0) = third * (e1 + e2);
+            inertia(1, 1) = third * (e0 + e2);
+            inertia(2, 2) = third * (e0 + e1);
+
+            int id = AllocateBody();
+            Body& body = mBodies[id];
+            body.shape = Shape::BOX;
+            body.extent = extent;
+            InitializeBody(id, mass, inertia, position, orientation, friction, restitution);
+            return id;
+        }
+
+        int AddCapsule(Real halfLength, Real radius, Real mass,
+            Vector3<Real> const& position, Quaternion<Real> const& orientation,
+            Real friction = (Real)0.5, Real restitution = (Real)0)
+        {
+            // The mass is split between the cylinder and the hemispheres in
+            // proportion to their volumes.
+            Real const r2 = radius * radius;
+            Real const h = (Real)2 * halfLength;
+            Real const cylinderVolume = h;
+            Real const sphereVolume = (Real)4 / (Real)3 * radius;
+            Real const cylinderMass = mass * cylinderVolume / (cylinderVolume + sphereVolume);
+            Real const sphereMass = mass - cylinderMass;
+            Real const axial = (Real)0.5 * cylinderMass * r2 + (Real)0.4 * sphereMass * r2;
+            Real const transverse =
+                cylinderMass * ((Real)0.25 * r2 + h * h / (Real)12) +
+                sphereMass * ((Real)0.4 * r2 + (Real)0.25 * h * h + (Real)0.375 * h * radius);
+            Matrix3x3<Real> inertia{};
+            inertia(0, 0) = transverse;
+            inertia(1, 1) = transverse;
+            inertia(2, 2) = axial;
+
+            int id = AllocateBody();
+            Body& body = mBodies[id];
+            body.shape = Shape::CAPSULE;
+            body.extent = { halfLength, radius, (Real)0 };
+            InitializeBody(id, mass, inertia, position, orientation, friction, restitution);
+            return id;
+        }
+
+        void RemoveBody(int id)
+        {
+            LogAssert(IsValid(id), "Invalid body.");
+            Body& body = mBodies[id];
+            mTree.Remove(body.proxy);
+            body.valid = false;
+            mFreeBodies.push_back(id);
+            --mNumBodies;
+
+            // Wake the bodies that were touching the removed body.
+            for (auto iter = mManifolds.begin(); iter != mManifolds.end(); )
+            {
+                if (iter->first.first == id || iter->first.second == id)
+                {
+                    WakeUp(iter->first.first == id ? iter->first.second : iter->first.first);
+                    iter = mManifolds.erase(iter);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+        }
+
+        // Member access.
+        inline Parameters& GetParameters()
+        {
+            return mParameters;
+        }
+
+        inline bool IsValid(int id) const
+        {
+            return 0 <= id && id < static_cast<int>(mBodies.size()) && mBodies[id].valid;
+        }
+
+        inline int GetNumBodies() const
+        {
+            return mNumBodies;
+        }
+
+        inline RigidBody<Real>& GetBody(int id)
+        {
+            return mBodies[id].rigid;
+        }
+
+        inline RigidBody<Real> const& GetBody(int id) const
+        {
+            return mBodies[id].rigid;
+        }
+
+        inline Shape GetShape(int id) const
+        {
+            return mBodies[id].shape;
+        }
+
+        inline bool IsStatic(int id) const
+        {
+            return mBodies[id].rigid.GetInverseMass() == (Real)0;
+        }
+
+        inline bool IsSleeping(int id) const
+        {
+            return !mBodies[id].awake;
+        }
+
+        OrientedBox3<Real> GetBox(int id) const
+        {
+            RigidBody<Real> const& rigid = mBodies[id].rigid;
+            Matrix3x3<Real> const& rotate = rigid.GetROrientation();
+            OrientedBox3<Real> box;
+            box.center = rigid.GetPosition();
+            for (int i = 0; i < 3; ++i)
+            {
+                box.axis[i] = rotate.GetCol(i);
+            }
+            box.extent = mBodies[id].extent;
+            return box;
+        }
+
+        Capsule3<Real> GetCapsule(int id) const
+        {
+            RigidBody<Real> const& rigid = mBodies[id].rigid;
+            Vector3<Real> offset = mBodies[id].extent[0] * rigid.GetROrientation().GetCol(2);
+            Capsule3<Real> capsule;
+            capsule.segment.p[0] = rigid.GetPosition() - offset;
+            capsule.segment.p[1] = rigid.GetPosition() + offset;
+            capsule.radius = mBodies[id].extent[1];
+            return capsule;
+        }
+
+        // The contact manifolds of the last step, keyed by the pairs of
+        // bodies (i0,i1) with i0 < i1.
+        inline std::map<std::pair<int, int>, Manifold> const& GetManifolds() const
+        {
+            return mManifolds;
+        }
+
+        void WakeUp(int id)
+        {
+            Body& body = mBodies[id];
+            if (body.valid && !IsStatic(id))
+            {
+                body.awake = true;
+                body.sleepTime = (Real)0;
+            }
+        }
+
+        // Advance the simulation by the time step.
+        void Update(Real dt)
+        {
+            UpdateBroadPhase();
+            FindPairs();
+            ComputeManifolds();
+            BuildIslands();
+            SolveIslands(dt);
+        }
+
+    private:
+        struct Body
+        {
+            RigidBody<Real> rigid;
+            Shape shape;
+            Vector3<Real> extent;  // box extents or (halfLength, radius, 0)
+            Real friction, restitution;
+            Real sleepTime;
+            int proxy;
+            bool valid, awake;
+        };
+
+        struct SolverBody
+        {
+            Vector3<Real> position, linearVelocity, angularVelocity;
+            Quaternion<Real> orientation;
+            Matrix3x3<Real> invInertia;
+            Real invMass;
+        };
+
+        struct SolverContact
+        {
+            Vector3<Real> rA, rB;
+            std::array<Vector3<Real>, 2> tangent;
+            Real normalMass;
+            std::array<Real, 2> tangentMass;
+            Real velocityTarget;
+        };
+
+        struct Island
+        {
+            std::vector<int> bodies;
+            std::vector<Manifold*> manifolds;
+            bool awake;
+        };
+
+        int AllocateBody()
+        {
+            int id;
+            if (mFreeBodies.size() > 0)
+            {
+                id = mFreeBodies.back();
+                mFreeBodies.pop_back();
+                mBodies[id] = Body();
+            }
+            else
+            {
+                id = static_cast<int>(mBodies.size());
+                mBodies.push_back(Body());
+            }
+            ++mNumBodies;
+            return id;
+        }
+
+        void InitializeBody(int id, Real mass, Matrix3x3<Real> const& inertia,
+            Vector3<Real> const& position, Quaternion<Real> const& orientation,
+            Real friction, Real restitution)
+        {
+            Body& body = mBodies[id];
+            body.rigid.SetMass(static_cast<float>(mass));
+            if (body.rigid.GetInverseMass() > (Real)0)
+            {
+                body.rigid.SetBodyInertia(inertia);
+            }
+            body.rigid.SetPosition(position);
+            body.rigid.SetQOrientation(orientation);
+            body.friction = friction;
+            body.restitution = restitution;
+            body.sleepTime = (Real)0;
+            body.valid = true;
+            body.awake = (body.rigid.GetInverseMass() > (Real)0);
+            body.proxy = mTree.Insert(ComputeBounds(id), mParameters.aabbMargin, id);
+        }
+
+        AlignedBox3<Real> ComputeBounds(int id) const
+        {
+            Body const& body = mBodies[id];
+            Matrix3x3<Real> const& rotate = body.rigid.GetROrientation();
+            Vector3<Real> const& center = body.rigid.GetPosition();
+            Vector3<Real> halfSize;
+            if (body.shape == Shape::BOX)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    halfSize[i] = std::fabs(rotate(i, 0)) * body.extent[0]
+                        + std::fabs(rotate(i, 1)) * body.extent[1]
+                        + std::fabs(rotate(i, 2)) * body.extent[2];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    halfSize[i] = std::fabs(rotate(i, 2)) * body.extent[0] + body.extent[1];
+                }
+            }
+            return AlignedBox3<Real>(center - halfSize, center + halfSize);
+        }
+
+        inline size_t GetNumChunks(size_t numItems, size_t minChunkSize) const
+        {
+            return (mScheduler ?
+                std::max(std::min(numItems / minChunkSize, 4 * mScheduler->GetNumThreads()),
+                    static_cast<size_t>(1)) : 1);
+        }
+
+        // Stage 1. Only the awake bodies move.
+        void UpdateBroadPhase()
+        {
+            mAwake.clear();
+            for (int id = 0; id < static_cast<int>(mBodies.size()); ++id)
+            {
+                Body const& body = mBodies[id];
+                if (body.valid && body.awake)
+                {
+                    mTree.Move(body.proxy, ComputeBounds(id), mParameters.aabbMargin);
+                    mAwake.push_back(id);
+                }
+            }
+        }
+
+        // Stage 2. The pairs contain at least one awake body, so the pairs
+        // of sleeping bodies are not tested.
+        void FindPairs()
+        {
+            size_t const numAwake = mAwake.size();
+            size_t const numChunks = GetNumChunks(numAwake, msMinChunkSize);
+            std::vector<std::vector<std::pair<int, int>>> chunkPairs(numChunks);
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numAwake, numChunks, &chunkPairs](size_t chunk)
+                {
+                    size_t const imin = numAwake * chunk / numChunks;
+                    size_t const imax = numAwake * (chunk + 1) / numChunks;
+                    auto& pairs = chunkPairs[chunk];
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        int const id = mAwake[i];
+                        mTree.Query(mTree.GetBox(mBodies[id].proxy),
+                            [this, id, &pairs](int proxy)
+                            {
+                                int const other = mTree.GetUserData(proxy);
+                                // An awake pair is found from both bodies;
+                                // keep it once.
+                                if (other != id && (other > id || !mBodies[other].awake))
+                                {
+                                    pairs.push_back(std::make_pair(std::min(id, other),
+                                        std::max(id, other)));
+                                }
+                                return true;
+                            });
+                    }
+                });
+
+            mPairs.clear();
+            for (auto const& pairs : chunkPairs)
+            {
+                mPairs.insert(mPairs.end(), pairs.begin(), pairs.end());
+            }
+            std::sort(mPairs.begin(), mPairs.end());
+        }
+
+        // Stage 3. The manifolds of the pairs of bodies that do not move are
+        // kept, so the islands of sleeping bodies are preserved.
+        void ComputeManifolds()
+        {
+            size_t const numPairs = mPairs.size();
+            std::vector<Manifold> manifolds(numPairs);
+            size_t const numChunks = GetNumChunks(numPairs, msMinChunkSize);
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, numPairs, numChunks, &manifolds](size_t chunk)
+                {
+                    size_t const imin = numPairs * chunk / numChunks;
+                    size_t const imax = numPairs * (chunk + 1) / numChunks;
+                    for (size_t i = imin; i < imax; ++i)
+                    {
+                        Collide(mPairs[i].first, mPairs[i].second, manifolds[i]);
+                    }
+                });
+
+            std::map<std::pair<int, int>, Manifold> cache;
+            for (auto const& element : mManifolds)
+            {
+                int const i0 = element.first.first, i1 = element.first.second;
+                if (!mBodies[i0].awake && !mBodies[i1].awake)
+                {
+                    cache.insert(element);
+                }
+            }
+
+            Real const sqrMatchDistance = mParameters.matchDistance * mParameters.matchDistance;
+            for (size_t i = 0; i < numPairs; ++i)
+            {
+                Manifold& manifold = manifolds[i];
+                if (manifold.numContacts == 0)
+                {
+                    continue;
+                }
+
+                auto iter = mManifolds.find(mPairs[i]);
+                if (iter != mManifolds.end())
+                {
+                    Manifold const& old = iter->second;
+                    for (int j = 0; j < manifold.numContacts; ++j)
+                    {
+                        Contact& contact = manifold.contacts[j];
+                        for (int k = 0; k < old.numContacts; ++k)
+                        {
+                            Contact const& oldContact = old.contacts[k];
+                            Vector3<Real> diff = contact.localA - oldContact.localA;
+                            if (Dot(diff, diff) <= sqrMatchDistance)
+                            {
+                                contact.normalImpulse = oldContact.normalImpulse;
+                                contact.tangentImpulse = oldContact.tangentImpulse;
+                                break;
+                            }
+                        }
+                    }
+                }
+                cache.insert(std::make_pair(mPairs[i], manifold));
+            }
+            mManifolds = std::move(cache);
+        }
+
+        // Stage 4. The islands are the connected components of the graph
+        // whose vertices are the nonstatic bodies and whose edges are the
+        // manifolds. An island is awake when one of its bodies is awake.
+        void BuildIslands()
+        {
+            int const numBodies = static_cast<int>(mBodies.size());
+            std::vector<int> parent(numBodies);
+            std::iota(parent.begin(), parent.end(), 0);
+            auto find = [&parent](int i)
+            {
+                while (parent[i] != i)
+                {
+                    parent[i] = parent[parent[i]];
+                    i = parent[i];
+                }
+                return i;
+            };
+
+            for (auto const& element : mManifolds)
+            {
+                int const i0 = element.first.first, i1 = element.first.second;
+                if (!IsStatic(i0) && !IsStatic(i1))
+                {
+                    int r0 = find(i0), r1 = find(i1);
+                    if (r0 != r1)
+                    {
+                        parent[std::max(r0, r1)] = std::min(r0, r1);
+                    }
+                }
+            }
+
+            mIslands.clear();
+            std::vector<int> islandOf(numBodies, -1);
+            for (int id = 0; id < numBodies; ++id)
+            {
+                if (mBodies[id].valid && !IsStatic(id))
+                {
+                    int root = find(id);
+                    if (islandOf[root] == -1)
+                    {
+                        islandOf[root] = static_cast<int>(mIslands.size());
+                        mIslands.push_back(Island());
+                        mIslands.back().awake = false;
+                    }
+                    Island& island = mIslands[islandOf[root]];
+                    island.bodies.push_back(id);
+                    island.awake = island.awake || mBodies[id].awake;
+                }
+            }
+
+            for (auto& element : mManifolds)
+            {
+                int const i0 = element.first.first, i1 = element.first.second;
+                int const id = (IsStatic(i0) ? i1 : i0);
+                mIslands[islandOf[find(id)]].manifolds.push_back(&element.second);
+            }
+
+            for (auto& island : mIslands)
+            {
+                if (island.awake)
+                {
+                    for (auto id : island.bodies)
+                    {
+                        if (!mBodies[id].awake)
+                        {
+                            WakeUp(id);
+                        }
+                    }
+                }
+            }
+        }
+
+        // Stage 5. The islands are distributed over the chunks in an
+        // interleaved manner to balance the work of large islands.
+        void SolveIslands(Real dt)
+        {
+            std::vector<Island*> awakeIslands;
+            for (auto& island : mIslands)
+            {
+                if (island.awake)
+                {
+                    awakeIslands.push_back(&island);
+                }
+            }
+
+            size_t const numIslands = awakeIslands.size();
+            size_t const numChunks = GetNumChunks(numIslands, msMinIslandsPerChunk);
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [this, dt, numIslands, numChunks, &awakeIslands](size_t chunk)
+                {
+                    for (size_t i = chunk; i < numIslands; i += numChunks)
+                    {
+                        SolveIsland(*awakeIslands[i], dt);
+                    }
+                });
+        }
+
+        void SolveIsland(Island& island, Real dt)
+        {
+            // Local copies of the bodies of the island and of the static
+            // bodies touching it, so that the islands share no data.
+            std::map<int, int> local;
+            std::vector<SolverBody> bodies;
+            auto addBody = [this, &local, &bodies](int id)
+            {
+                auto iter = local.find(id);
+                if (iter != local.end())
+                {
+                    return iter->second;
+                }
+
+                RigidBody<Real> const& rigid = mBodies[id].rigid;
+                SolverBody body;
+                body.position = rigid.GetPosition();
+                body.orientation = rigid.GetQOrientation();
+                body.linearVelocity = rigid.GetLinearVelocity();
+                body.angularVelocity = rigid.GetAngularVelocity();
+                body.invMass = rigid.GetInverseMass();
+                body.invInertia = rigid.GetWorldInverseInertia();
+                int index = static_cast<int>(bodies.size());
+                bodies.push_back(body);
+                local.insert(std::make_pair(id, index));
+                return index;
+            };
+
+            for (auto id : island.bodies)
+            {
+                SolverBody& body = bodies[addBody(id)];
+                body.linearVelocity += dt * mParameters.gravity;
+            }
+
+            struct Constraint
+            {
+                Manifold* manifold;
+                int body[2];
+                Real friction;
+                std::array<SolverContact, 4> contacts;
+            };
+
+            Real const invDt = (Real)1 / dt;
+            std::vector<Constraint> constraints(island.manifolds.size());
+            for (size_t c = 0; c < constraints.size(); ++c)
+            {
+                Constraint& constraint = constraints[c];
+                Manifold& manifold = *island.manifolds[c];
+                constraint.manifold = &manifold;
+                constraint.body[0] = addBody(manifold.body[0]);
+                constraint.body[1] = addBody(manifold.body[1]);
+                Body const& body0 = mBodies[manifold.body[0]];
+                Body const& body1 = mBodies[manifold.body[1]];
+                constraint.friction = std::sqrt(body0.friction * body1.friction);
+                Real const restitution = std::max(body0.restitution, body1.restitution);
+
+                SolverBody const& A = bodies[constraint.body[0]];
+                SolverBody const& B = bodies[constraint.body[1]];
+                Vector3<Real> const& normal = manifold.normal;
+                std::array<Vector3<Real>, 3> basis{ normal };
+                ComputeOrthogonalComplement(1, basis.data());
+
+                for (int j = 0; j < manifold.numContacts; ++j)
+                {
+                    Contact& contact = manifold.contacts[j];
+                    SolverContact& sc = constraint.contacts[j];
+                    sc.rA = contact.point - A.position;
+                    sc.rB = contact.point - B.position;
+                    sc.normalMass = EffectiveMass(A, B, sc.rA, sc.rB, normal);
+                    for (int k = 0; k < 2; ++k)
+                    {
+                        sc.tangent[k] = basis[k + 1];
+                        sc.tangentMass[k] = EffectiveMass(A, B, sc.rA, sc.rB, sc.tangent[k]);
+                    }
+
+                    // A gap may be closed in one step; a penetration in
+                    // excess of the slop is removed gradually.
+                    if (contact.separation > (Real)0)
+                    {
+                        sc.velocityTarget = -contact.separation * invDt;
+                    }
+                    else
+                    {
+                        sc.velocityTarget = mParameters.baumgarte * invDt *
+                            std::max(-contact.separation - mParameters.slop, (Real)0);
+
+                        Real const speed = Dot(normal, RelativeVelocity(A, B, sc.rA, sc.rB));
+                        if (speed < -mParameters.restitutionThreshold)
+                        {
+                            sc.velocityTarget = std::max(sc.velocityTarget, -restitution * speed);
+                        }
+                    }
+                }
+            }
+
+            // Warm starting.
+            for (auto& constraint : constraints)
+            {
+                Manifold const& manifold = *constraint.manifold;
+                SolverBody& A = bodies[constraint.body[0]];
+                SolverBody& B = bodies[constraint.body[1]];
+                for (int j = 0; j < manifold.numContacts; ++j)
+                {
+                    Contact const& contact = manifold.contacts[j];
+                    SolverContact const& sc = constraint.contacts[j];
+                    Vector3<Real> impulse = contact.normalImpulse * manifold.normal
+                        + contact.tangentImpulse[0] * sc.tangent[0]
+                        + contact.tangentImpulse[1] * sc.tangent[1];
+                    ApplyImpulse(A, B, sc.rA, sc.rB, impulse);
+                }
+            }
+
+            // Sequential impulses. The friction is solved first because the
+            // nonpenetration is more important.
+            for (int iteration = 0; iteration < mParameters.numIterations; ++iteration)
+            {
+                for (auto& constraint : constraints)
+                {
+                    Manifold& manifold = *constraint.manifold;
+                    SolverBody& A = bodies[constraint.body[0]];
+                    SolverBody& B = bodies[constraint.body[1]];
+                    for (int j = 0; j < manifold.numContacts; ++j)
+                    {
+                        Contact& contact = manifold.contacts[j];
+                        SolverContact const& sc = constraint.contacts[j];
+                        Real const maxFriction = constraint.friction * contact.normalImpulse;
+                        for (int k = 0; k < 2; ++k)
+                        {
+                            Real speed = Dot(sc.tangent[k], RelativeVelocity(A, B, sc.rA, sc.rB));
+                            Real oldImpulse = contact.tangentImpulse[k];
+                            contact.tangentImpulse[k] = std::min(std::max(
+                                oldImpulse - sc.tangentMass[k] * speed, -maxFriction), maxFriction);
+                            ApplyImpulse(A, B, sc.rA, sc.rB,
+                                (contact.tangentImpulse[k] - oldImpulse) * sc.tangent[k]);
+                        }
+
+                        Real speed = Dot(manifold.normal, RelativeVelocity(A, B, sc.rA, sc.rB));
+                        Real oldImpulse = contact.normalImpulse;
+                        contact.normalImpulse = std::max(
+                            oldImpulse + sc.normalMass * (sc.velocityTarget - speed), (Real)0);
+                        ApplyImpulse(A, B, sc.rA, sc.rB,
+                            (contact.normalImpulse - oldImpulse) * manifold.normal);
+                    }
+                }
+            }
+
+            // Integrate the positions and update the sleep times.
+            Real const sqrLinearSleepSpeed =
+                mParameters.linearSleepSpeed * mParameters.linearSleepSpeed;
+            Real const sqrAngularSleepSpeed =
+                mParameters.angularSleepSpeed * mParameters.angularSleepSpeed;
+            Real minSleepTime = std::numeric_limits<Real>::max();
+            for (auto id : island.bodies)
+            {
+                SolverBody& solverBody = bodies[local[id]];
+                solverBody.position += dt * solverBody.linearVelocity;
+                Vector3<Real> const& w = solverBody.angularVelocity;
+                Quaternion<Real> W(w[0], w[1], w[2], (Real)0);
+                solverBody.orientation = solverBody.orientation +
+                    ((Real)0.5 * dt) * W * solverBody.orientation;
+                Normalize(solverBody.orientation);
+
+                Body& body = mBodies[id];
+                body.rigid.SetPosition(solverBody.position);
+                body.rigid.SetQOrientation(solverBody.orientation);
+                body.rigid.SetLinearVelocity(solverBody.linearVelocity);
+                body.rigid.SetAngularVelocity(solverBody.angularVelocity);
+
+                if (Dot(solverBody.linearVelocity, solverBody.linearVelocity) > sqrLinearSleepSpeed ||
+                    Dot(w, w) > sqrAngularSleepSpeed)
+                {
+                    body.sleepTime = (Real)0;
+                }
+                else
+                {
+                    body.sleepTime += dt;
+                }
+                minSleepTime = std::min(minSleepTime, body.sleepTime);
+            }
+
+            if (minSleepTime >= mParameters.timeToSleep)
+            {
+                for (auto id : island.bodies)
+                {
+                    Body& body = mBodies[id];
+                    body.awake = false;
+                    body.rigid.SetLinearVelocity(Vector3<Real>::Zero());
+                    body.rigid.SetAngularVelocity(Vector3<Real>::Zero());
+                }
+            }
+        }
+
+        static Real EffectiveMass(SolverBody const& A, SolverBody const& B,
+            Vector3<Real> const& rA, Vector3<Real> const& rB, Vector3<Real> const& direction)
+        {
+            Vector3<Real> cA = Cross(rA, direction), cB = Cross(rB, direction);
+            Real sum = A.invMass + B.invMass
+                + Dot(cA, A.invInertia * cA) + Dot(cB, B.invInertia * cB);
+            return (sum > (Real)0 ? (Real)1 / sum : (Real)0);
+        }
+
+        static Vector3<Real> RelativeVelocity(SolverBody const& A, SolverBody const& B,
+            Vector3<Real> const& rA, Vector3<Real> const& rB)
+        {
+            return B.linearVelocity + Cross(B.angularVelocity, rB)
+                - A.linearVelocity - Cross(A.angularVelocity, rA);
+        }
+
+        static void ApplyImpulse(SolverBody& A, SolverBody& B,
+            Vector3<Real> const& rA, Vector3<Real> const& rB, Vector3<Real> const& impulse)
+        {
+            A.linearVelocity -= A.invMass * impulse;
+            A.angularVelocity -= A.invInertia * Cross(rA, impulse);
+            B.linearVelocity += B.invMass * impulse;
+            B.angularVelocity += B.invInertia * Cross(rB, impulse);
+        }
+
+        // Narrow phase. The contact points are computed in world coordinates
+        // and the body coordinates are computed last.
+        void Collide(int i0, int i1, Manifold& manifold) const
+        {
+            manifold.body = { i0, i1 };
+            manifold.numContacts = 0;
+            Shape const shape0 = mBodies[i0].shape, shape1 = mBodies[i1].shape;
+            if (shape0 == Shape::BOX && shape1 == Shape::BOX)
+            {
+                CollideBoxes(GetBox(i0), GetBox(i1), manifold);
+            }
+            else if (shape0 == Shape::CAPSULE && shape1 == Shape::CAPSULE)
+            {
+                CollideCapsules(GetCapsule(i0), GetCapsule(i1), manifold);
+            }
+            else if (shape0 == Shape::CAPSULE)
+            {
+                CollideCapsuleBox(GetCapsule(i0), GetBox(i1), manifold);
+            }
+            else
+            {
+                CollideCapsuleBox(GetCapsule(i1), GetBox(i0), manifold);
+                manifold.normal = -manifold.normal;
+            }
+
+            RigidBody<Real> const& rigid0 = mBodies[i0].rigid;
+            RigidBody<Real> const& rigid1 = mBodies[i1].rigid;
+            for (int j = 0; j < manifold.numContacts; ++j)
+            {
+                Contact& contact = manifold.contacts[j];
+                contact.localA = (contact.point - rigid0.GetPosition()) * rigid0.GetROrientation();
+                contact.localB = (contact.point - rigid1.GetPosition()) * rigid1.GetROrientation();
+                contact.normalImpulse = (Real)0;
+                contact.tangentImpulse = { (Real)0, (Real)0 };
+            }
+        }
+
+        void AddContact(Manifold& manifold, Vector3<Real> const& point, Real separation) const
+        {
+            Contact& contact = manifold.contacts[manifold.numContacts++];
+            contact.point = point;
+            contact.separation = separation;
+        }
+
+        // The separating axis test for the 15 potential separating axes.
+        // The axis of least penetration is selected, with a preference for
+        // the face normals, which produce stable manifolds. For a face axis,
+        // the incident face of the other box is clipped by the side planes
+        // of the reference face; for an edge axis, the contact point is the
+        // midpoint of the closest points of the two edges.
+        void CollideBoxes(OrientedBox3<Real> const& box0, OrientedBox3<Real> const& box1,
+            Manifold& manifold) const
+        {
+            TIQuery<Real, OrientedBox3<Real>, OrientedBox3<Real>> tiQuery;
+            OrientedBox3<Real> inflated = box0;
+            for (int i = 0; i < 3; ++i)
+            {
+                inflated.extent[i] += mParameters.contactDistance;
+            }
+            if (!tiQuery(inflated, box1).intersect)
+            {
+                return;
+            }
+
+            Vector3<Real> const diff = box1.center - box0.center;
+            auto separation = [&box0, &box1, &diff](Vector3<Real> const& axis)
+            {
+                Real r0 = (Real)0, r1 = (Real)0;
+                for (int i = 0; i < 3; ++i)
+                {
+                    r0 += box0.extent[i] * std::fabs(Dot(box0.axis[i], axis));
+                    r1 += box1.extent[i] * std::fabs(Dot(box1.axis[i], axis));
+                }
+                return std::fabs(Dot(diff, axis)) - r0 - r1;
+            };
+
+            // The face axes. The type is 0 or 1 for the face of box0 or
+            // box1 and 2 for an edge pair.
+            Real bestSeparation[2] = { -std::numeric_limits<Real>::max(),
+                -std::numeric_limits<Real>::max() };
+            int bestIndex[2] = { 0, 0 };
+            for (int b = 0; b < 2; ++b)
+            {
+                OrientedBox3<Real> const& box = (b == 0 ? box0 : box1);
+                for (int i = 0; i < 3; ++i)
+                {
+                    Real s = separation(box.axis[i]);
+                    if (s > mParameters.contactDistance)
+                    {
+                        return;
+                    }
+                    if (s > bestSeparation[b])
+                    {
+                        bestSeparation[b] = s;
+                        bestIndex[b] = i;
+                    }
+                }
+            }
+
+            Real const relTolerance = (Real)0.95;
+            Real const absTolerance = (Real)0.5 * mParameters.slop;
+            int type = (bestSeparation[1] > relTolerance * bestSeparation[0] + absTolerance ? 1 : 0);
+            Real faceSeparation = bestSeparation[type];
+
+            Real edgeSeparation = -std::numeric_limits<Real>::max();
+            int edge0 = 0, edge1 = 0;
+            Vector3<Real> edgeAxis{};
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    Vector3<Real> axis = Cross(box0.axis[i], box1.axis[j]);
+                    Real length = Normalize(axis);
+                    if (length < (Real)1e-06)
+                    {
+                        // The edges are parallel and the face axes cover
+                        // this case.
+                        continue;
+                    }
+                    Real s = separation(axis);
+                    if (s > mParameters.contactDistance)
+                    {
+                        return;
+                    }
+                    if (s > edgeSeparation)
+                    {
+                        edgeSeparation = s;
+                        edge0 = i;
+                        edge1 = j;
+                        edgeAxis = axis;
+                    }
+                }
+            }
+
+            if (edgeSeparation > relTolerance * faceSeparation + absTolerance)
+            {
+                if (Dot(edgeAxis, diff) < (Real)0)
+                {
+                    edgeAxis = -edgeAxis;
+                }
+                manifold.normal = edgeAxis;
+
+                // The supporting edges of box0 in the direction of the
+                // normal and of box1 in the opposite direction.
+                Segment3<Real> segment0, segment1;
+                Vector3<Real> center0 = box0.center, center1 = box1.center;
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (k != edge0)
+                    {
+                        Real sign = (Dot(box0.axis[k], edgeAxis) > (Real)0 ? (Real)1 : (Real)-1);
+                        center0 += (sign * box0.extent[k]) * box0.axis[k];
+                    }
+                    if (k != edge1)
+                    {
+                        Real sign = (Dot(box1.axis[k], edgeAxis) > (Real)0 ? (Real)-1 : (Real)1);
+                        center1 += (sign * box1.extent[k]) * box1.axis[k];
+                    }
+                }
+                segment0.p[0] = center0 - box0.extent[edge0] * box0.axis[edge0];
+                segment0.p[1] = center0 + box0.extent[edge0] * box0.axis[edge0];
+                segment1.p[0] = center1 - box1.extent[edge1] * box1.axis[edge1];
+                segment1.p[1] = center1 + box1.extent[edge1] * box1.axis[edge1];
+                DCPQuery<Real, Segment3<Real>, Segment3<Real>> ssQuery;
+                auto ssResult = ssQuery(segment0, segment1);
+                AddContact(manifold, (Real)0.5 * (ssResult.closest[0] + ssResult.closest[1]),
+                    edgeSeparation);
+                return;
+            }
+
+            // The reference face is on box 'type' and has outer normal
+            // pointing to the incident box.
+            OrientedBox3<Real> const& reference = (type == 0 ? box0 : box1);
+            OrientedBox3<Real> const& incident = (type == 0 ? box1 : box0);
+            int const r = bestIndex[type];
+            Vector3<Real> refNormal = reference.axis[r];
+            Real const sign = (type == 0 ? (Real)1 : (Real)-1);
+            if (sign * Dot(refNormal, diff) < (Real)0)
+            {
+                refNormal = -refNormal;
+            }
+            manifold.normal = sign * refNormal;
+
+            // The incident face is the face of the incident box whose normal
+            // is most antiparallel to the reference normal.
+            int incIndex = 0;
+            Real maxAbsDot = (Real)-1;
+            for (int k = 0; k < 3; ++k)
+            {
+                Real absDot = std::fabs(Dot(incident.axis[k], refNormal));
+                if (absDot > maxAbsDot)
+                {
+                    maxAbsDot = absDot;
+                    incIndex = k;
+                }
+            }
+            Real incSign = (Dot(incident.axis[incIndex], refNormal) > (Real)0 ? (Real)-1 : (Real)1);
+            Vector3<Real> incCenter = incident.center +
+                (incSign * incident.extent[incIndex]) * incident.axis[incIndex];
+            int const u = (incIndex + 1) % 3, v = (incIndex + 2) % 3;
+            Vector3<Real> U = incident.extent[u] * incident.axis[u];
+            Vector3<Real> V = incident.extent[v] * incident.axis[v];
+            std::vector<Vector3<Real>> polygon =
+            {
+                incCenter - U - V, incCenter + U - V, incCenter + U + V, incCenter - U + V
+            };
+
+            // Clip against the side planes of the reference face.
+            for (int k = 1; k <= 2; ++k)
+            {
+                int const side = (r + k) % 3;
+                for (Real s : { (Real)1, (Real)-1 })
+                {
+                    Vector3<Real> planeNormal = s * reference.axis[side];
+                    Real planeConstant = Dot(planeNormal, reference.center) + reference.extent[side];
+                    polygon = ClipPolygon(polygon, planeNormal, planeConstant);
+                    if (polygon.size() == 0)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            Vector3<Real> refCenter = reference.center + reference.extent[r] * refNormal;
+            std::array<Vector3<Real>, 8> points;
+            std::array<Real, 8> separations;
+            int numPoints = 0;
+            for (auto const& point : polygon)
+            {
+                Real s = Dot(refNormal, point - refCenter);
+                if (s <= mParameters.contactDistance && numPoints < 8)
+                {
+                    // Use the midpoint of the incident and reference points.
+                    points[numPoints] = point - ((Real)0.5 * s) * refNormal;
+                    separations[numPoints] = s;
+                    ++numPoints;
+                }
+            }
+
+            ReduceContacts(numPoints, points, separations, refNormal, manifold);
+        }
+
+        // Sutherland-Hodgman clipping of a convex polygon to the halfspace
+        // Dot(N,X) <= c.
+        static std::vector<Vector3<Real>> ClipPolygon(std::vector<Vector3<Real>> const& polygon,
+            Vector3<Real> const& N, Real c)
+        {
+            std::vector<Vector3<Real>> clipped;
+            size_t const numVertices = polygon.size();
+            for (size_t i0 = numVertices - 1, i1 = 0; i1 < numVertices; i0 = i1++)
+            {
+                Vector3<Real> const& P0 = polygon[i0];
+                Vector3<Real> const& P1 = polygon[i1];
+                Real d0 = Dot(N, P0) - c, d1 = Dot(N, P1) - c;
+                if (d0 <= (Real)0)
+                {
+                    clipped.push_back(P0);
+                }
+                if ((d0 < (Real)0 && d1 > (Real)0) || (d0 > (Real)0 && d1 < (Real)0))
+                {
+                    clipped.push_back(P0 + (d0 / (d0 - d1)) * (P1 - P0));
+                }
+            }
+            return clipped;
+        }
+
+        // Keep at most 4 points that span a large area: the deepest point,
+        // the point farthest from it, the point farthest from the line of
+        // those two and the point farthest outside the triangle of the
+        // three points.
+        static void ReduceContacts(int numPoints, std::array<Vector3<Real>, 8> const& points,
+            std::array<Real, 8> const& separations, Vector3<Real> const& normal,
+            Manifold& manifold)
+        {
+            if (numPoints <= 4)
+            {
+                for (int i = 0; i < numPoints; ++i)
+                {
+                    Contact& contact = manifold.contacts[manifold.numContacts++];
+                    contact.point = points[i];
+                    contact.separation = separations[i];
+                }
+                return;
+            }
+
+            std::array<int, 4> selected{};
+            selected[0] = static_cast<int>(std::min_element(separations.begin(),
+                separations.begin() + numPoints) - separations.begin());
+
+            Real maxValue = (Real)-1;
+            for (int i = 0; i < numPoints; ++i)
+            {
+                Vector3<Real> diff = points[i] - points[selected[0]];
+                Real value = Dot(diff, diff);
+                if (value > maxValue)
+                {
+                    maxValue = value;
+                    selected[1] = i;
+                }
+            }
+
+            maxValue = (Real)-1;
+            Vector3<Real> edge = points[selected[1]] - points[selected[0]];
+            for (int i = 0; i < numPoints; ++i)
+            {
+                Real value = std::fabs(Dot(normal, Cross(edge, points[i] - points[selected[0]])));
+                if (value > maxValue)
+                {
+                    maxValue = value;
+                    selected[2] = i;
+                }
+            }
+
+            // The triangle is oriented counterclockwise with respect to the
+            // normal; a point outside an edge has negative signed area.
+            if (Dot(normal, Cross(edge, points[selected[2]] - points[selected[0]])) < (Real)0)
+            {
+                std::swap(selected[1], selected[2]);
+            }
+            maxValue = (Real)0;
+            selected[3] = -1;
+            for (int i = 0; i < numPoints; ++i)
+            {
+                for (int k0 = 2, k1 = 0; k1 < 3; k0 = k1++)
+                {
+                    Vector3<Real> const& P0 = points[selected[k0]];
+                    Vector3<Real> const& P1 = points[selected[k1]];
+                    Real value = -Dot(normal, Cross(P1 - P0, points[i] - P0));
+                    if (value > maxValue)
+                    {
+                        maxValue = value;
+                        selected[3] = i;
+                    }
+                }
+            }
+
+            int const numSelected = (selected[3] >= 0 ? 4 : 3);
+            for (int k = 0; k < numSelected; ++k)
+            {
+                Contact& contact = manifold.contacts[manifold.numContacts++];
+                contact.point = points[selected[k]];
+                contact.separation = separations[selected[k]];
+            }
+        }
+
+        void CollideCapsules(Capsule3<Real> const& capsule0, Capsule3<Real> const& capsule1,
+            Manifold& manifold) const
+        {
+            Capsule3<Real> inflated = capsule0;
+            inflated.radius += mParameters.contactDistance;
+            TIQuery<Real, Capsule3<Real>, Capsule3<Real>> tiQuery;
+            if (!tiQuery(inflated, capsule1).intersect)
+            {
+                return;
+            }
+
+            DCPQuery<Real, Segment3<Real>, Segment3<Real>> ssQuery;
+            auto ssResult = ssQuery(capsule0.segment, capsule1.segment);
+            Vector3<Real> normal = ssResult.closest[1] - ssResult.closest[0];
+            if (Normalize(normal) == (Real)0)
+            {
+                // The segments intersect. Separate along the common
+                // perpendicular, or any perpendicular when the segments are
+                // parallel.
+                Vector3<Real> D0 = capsule0.segment.p[1] - capsule0.segment.p[0];
+                Vector3<Real> D1 = capsule1.segment.p[1] - capsule1.segment.p[0];
+                normal = UnitCross(D0, D1);
+                if (normal == Vector3<Real>::Zero())
+                {
+                    std::array<Vector3<Real>, 3> basis{ D0 };
+                    ComputeOrthogonalComplement(1, basis.data());
+                    normal = basis[1];
+                }
+            }
+            manifold.normal = normal;
+
+            Vector3<Real> P0 = ssResult.closest[0] + capsule0.radius * normal;
+            Vector3<Real> P1 = ssResult.closest[1] - capsule1.radius * normal;
+            AddContact(manifold, (Real)0.5 * (P0 + P1),
+                ssResult.distance - capsule0.radius - capsule1.radius);
+        }
+
+        // The normal points from the capsule to the box. When the capsule
+        // lies on a face, the end points of the segment produce a second
+        // contact point. When the segment intersects the box, the contact is
+        // approximated by the face of the box nearest to the deepest point
+        // of the segment.
+        void CollideCapsuleBox(Capsule3<Real> const& capsule, OrientedBox3<Real> const& box,
+            Manifold& manifold) const
+        {
+            Real const radius = capsule.radius;
+            Real const maxDistance = radius + mParameters.contactDistance;
+            DCPQuery<Real, Segment3<Real>, OrientedBox3<Real>> sbQuery;
+            auto sbResult = sbQuery(capsule.segment, box);
+            if (sbResult.distance > maxDistance)
+            {
+                return;
+            }
+
+            if (sbResult.distance > (Real)0)
+            {
+                Vector3<Real> normal = (sbResult.closestPoint[1] - sbResult.closestPoint[0])
+                    / sbResult.distance;
+                manifold.normal = normal;
+                Vector3<Real> point = sbResult.closestPoint[0] + radius * normal;
+                AddContact(manifold, (Real)0.5 * (point + sbResult.closestPoint[1]),
+                    sbResult.distance - radius);
+
+                DCPQuery<Real, Vector3<Real>, OrientedBox3<Real>> pbQuery;
+                for (int k = 0; k < 2; ++k)
+                {
+                    Vector3<Real> const& end = capsule.segment.p[k];
+                    Vector3<Real> diff = end - sbResult.closestPoint[0];
+                    if (Dot(diff, diff) <= mParameters.matchDistance * mParameters.matchDistance)
+                    {
+                        continue;
+                    }
+
+                    auto pbResult = pbQuery(end, box);
+                    Real separation = Dot(normal, pbResult.boxClosest - end) - radius;
+                    if (separation <= mParameters.contactDistance && manifold.numContacts < 4)
+                    {
+                        point = end + radius * normal;
+                        AddContact(manifold, (Real)0.5 * (point + pbResult.boxClosest),
+                            separation);
+                    }
+                }
+                return;
+            }
+
+            // Use the segment point that is deepest inside the box and the
+            // box face nearest to it.
+            Vector3<Real> const candidates[3] =
+            {
+                capsule.segment.p[0], capsule.segment.p[1], sbResult.closestPoint[0]
+            };
+            Real bestDepth = -std::numeric_limits<Real>::max();
+            Vector3<Real> bestPoint{}, outward{};
+            for (auto const& candidate : candidates)
+            {
+                // The depth of a point is its distance to the nearest face.
+                Vector3<Real> diff = candidate - box.center;
+                for (int i = 0; i < 3; ++i)
+                {
+                    Real y = Dot(box.axis[i], diff);
+                    Real depth = box.extent[i] - std::fabs(y);
+                    bool nearest = true;
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        if (j != i && box.extent[j] - std::fabs(Dot(box.axis[j], diff)) < depth)
+                        {
+                            nearest = false;
+                        }
+                    }
+                    if (nearest && depth > bestDepth)
+                    {
+                        bestDepth = depth;
+                        bestPoint = candidate;
+                        outward = (y >= (Real)0 ? box.axis[i] : -box.axis[i]);
+                    }
+                }
+            }
+
+            manifold.normal = -outward;
+            AddContact(manifold, bestPoint + ((Real)0.5 * (bestDepth - radius)) * outward,
+                -bestDepth - radius);
+        }
+
+        Parameters mParameters;
+        TaskScheduler* mScheduler;
+        std::vector<Body> mBodies;
+        std::vector<int> mFreeBodies;
+        int mNumBodies;
+        DynamicAABBTree<3, Real> mTree;
+        std::map<std::pair<int, int>, Manifold> mManifolds;
+
+        // Storage for the stages of Update.
+        std::vector<int> mAwake;
+        std::vector<std::pair<int, int>> mPairs;
+        std::vector<Island> mIslands;
+
+        // The smallest numbers of items of a chunk for multithreading.
+        static size_t constexpr msMinChunkSize = 256;
+        static size_t constexpr msMinIslandsPerChunk = 4;
+    };
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.12.05
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -403,8 +403,8 @@ namespace gte
                 // Three simple roots.
                 Rational deltaDiv108 = delta / rat108;
                 Rational betaRe = -c0 / rat2;
-                Rational betaIm = std::sqrt(deltaDiv108);
-                Rational theta = std::atan2(betaIm, betaRe);
+                Rational betaIm = (Rational)std::sqrt((double)deltaDiv108);
+                Rational theta = (Rational)std::atan2((double)betaIm, (double)betaRe);
                 Rational thetaDiv3 = theta / rat3;
                 double angle = (double)thetaDiv3;
                 Rational cs = (Rational)std::cos(angle);
@@ -0,0 +1,493 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/RootsPolynomial.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Compute the real-valued roots of many monic polynomials of degree d in
+// {1,2,3,4},
+//   p(x) = c[0] + c[1] * x + ... + c[d-1] * x^{d-1} + x^d
+// which is the form of the polynomials of CubicRootsQR and QuarticRootsQR.
+// The coefficients of polynomial i are coefficients[d*i..d*i+d-1]. Its
+// number of real roots, counting multiplicities, is numRoots[i] and the
+// roots are roots[d*i..d*i+numRoots[i]-1] in increasing order.
+//
+// The roots are computed with floating-point arithmetic only, using the
+// closed-form solutions for the quadratic and cubic and Ferrari's method for
+// the quartic, whose resolvent cubic is solved by the cubic solver. The
+// roots are then polished by Newton's method. The polynomials are processed
+// in blocks of BLOCK_SIZE whose coefficients and roots are stored in
+// structure-of-arrays form, so that the Newton iterations for the block are
+// loops without branches that compilers can vectorize.
+//
+// The classification of the roots is sensitive to rounding errors when a
+// polynomial is nearly one with a multiple root, which is the case when its
+// discriminant is small relative to the sum of the magnitudes of the terms
+// of the discriminant. The indices of such polynomials, and of those for
+// which Ferrari's method is inconsistent with the sign of the discriminant,
+// are reported as ill conditioned; the roots computed for them are only
+// estimates. Resolve<Rational>(*) recomputes their roots with the
+// RootsPolynomial solvers, which classify the roots using exact rational
+// arithmetic.
+
+namespace gte
+{
+    template <typename Real>
+    class RootsPolynomialBatch
+    {
+    public:
+        enum { BLOCK_SIZE = 64 };
+
+        // The polynomials are ill conditioned when the magnitudes of their
+        // discriminants are at most tolerance times the sums of the
+        // magnitudes of the terms of the discriminants.
+        RootsPolynomialBatch(Real tolerance = std::sqrt(std::numeric_limits<Real>::epsilon()))
+            :
+            mTolerance(std::max(tolerance, static_cast<Real>(0)))
+        {
+        }
+
+        inline void SetTolerance(Real tolerance)
+        {
+            mTolerance = std::max(tolerance, static_cast<Real>(0));
+        }
+
+        inline Real GetTolerance() const
+        {
+            return mTolerance;
+        }
+
+        // The arrays 'numRoots' and 'roots' must have numPolynomials and
+        // degree*numPolynomials elements, respectively. The indices of the
+        // ill-conditioned polynomials are stored in increasing order in
+        // 'illConditioned'. The blocks are processed by the threads of the
+        // scheduler when it is not null.
+        void operator()(int32_t degree, size_t numPolynomials,
+            Real const* coefficients, uint32_t* numRoots, Real* roots,
+            std::vector<size_t>& illConditioned, TaskScheduler* scheduler = nullptr) const
+        {
+            LogAssert(degree >= 1 && degree <= 4, "Invalid degree.");
+
+            size_t const numBlocks = (numPolynomials + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            std::vector<std::vector<size_t>> flagged(numBlocks);
+            auto solveBlocks = [this, degree, numPolynomials, coefficients,
+                numRoots, roots, &flagged](size_t bmin, size_t bmax)
+            {
+                for (size_t b = bmin; b < bmax; ++b)
+                {
+                    size_t const imin = b * BLOCK_SIZE;
+                    size_t const imax = std::min(imin + BLOCK_SIZE, numPolynomials);
+                    SolveBlock(degree, imin, imax, coefficients, numRoots, roots, flagged[b]);
+                }
+            };
+
+            size_t const numChunks = (scheduler ?
+                std::min(numBlocks, 4 * scheduler->GetNumThreads()) : 1);
+            if (numChunks > 1)
+            {
+                scheduler->ParallelFor(numChunks, [&solveBlocks, numBlocks, numChunks](size_t c)
+                {
+                    solveBlocks(c * numBlocks / numChunks, (c + 1) * numBlocks / numChunks);
+                });
+            }
+            else
+            {
+                solveBlocks(0, numBlocks);
+            }
+
+            illConditioned.clear();
+            for (auto const& indices : flagged)
+            {
+                illConditioned.insert(illConditioned.end(), indices.begin(), indices.end());
+            }
+        }
+
+        // Recompute the roots of the ill-conditioned polynomials using
+        // RootsPolynomial<Real>::Solve*<Rational>(*). See RootsPolynomial.h
+        // for the requirements of the Rational type.
+        template <typename Rational>
+        static void Resolve(int32_t degree, Real const* coefficients,
+            std::vector<size_t> const& illConditioned, uint32_t* numRoots, Real* roots)
+        {
+            LogAssert(degree >= 1 && degree <= 4, "Invalid degree.");
+
+            size_t const d = static_cast<size_t>(degree);
+            Rational const one(static_cast<Real>(1));
+            std::map<Real, int> rmMap;
+            for (auto i : illConditioned)
+            {
+                Real const* c = coefficients + d * i;
+                switch (degree)
+                {
+                case 1:
+                    rmMap.clear();
+                    rmMap.insert(std::make_pair(-c[0], 1));
+                    break;
+                case 2:
+                    RootsPolynomial<Real>::SolveQuadratic(Rational(c[0]),
+                        Rational(c[1]), one, rmMap);
+                    break;
+                case 3:
+                    RootsPolynomial<Real>::SolveCubic(Rational(c[0]),
+                        Rational(c[1]), Rational(c[2]), one, rmMap);
+                    break;
+                default:
+                    RootsPolynomial<Real>::SolveQuartic(Rational(c[0]),
+                        Rational(c[1]), Rational(c[2]), Rational(c[3]), one, rmMap);
+                    break;
+                }
+
+                uint32_t count = 0;
+                Real* output = roots + d * i;
+                for (auto const& rm : rmMap)
+                {
+                    for (int k = 0; k < rm.second && count < static_cast<uint32_t>(d); ++k)
+                    {
+                        output[count++] = rm.first;
+                    }
+                }
+                numRoots[i] = count;
+            }
+        }
+
+    private:
+        void SolveBlock(int32_t degree, size_t imin, size_t imax,
+            Real const* coefficients, uint32_t* numRoots, Real* roots,
+            std::vector<size_t>& flagged) const
+        {
+            size_t const d = static_cast<size_t>(degree);
+            size_t const n = imax - imin;
+
+            // Compute the initial estimates of the roots.
+            for (size_t i = imin; i < imax; ++i)
+            {
+                Real const* c = coefficients + d * i;
+                Real* r = roots + d * i;
+                uint32_t count = 0;
+                bool isIllConditioned = false;
+                switch (degree)
+                {
+                case 1:
+                    r[0] = -c[0];
+                    count = 1;
+                    break;
+                case 2:
+                    SolveQuadratic(c[0], c[1], r, count, isIllConditioned);
+                    break;
+                case 3:
+                    SolveCubic(c[0], c[1], c[2], r, count, isIllConditioned);
+                    break;
+                default:
+                    SolveQuartic(c[0], c[1], c[2], c[3], r, count, isIllConditioned);
+                    break;
+                }
+                numRoots[i] = count;
+                if (isIllConditioned)
+                {
+                    flagged.push_back(i);
+                }
+            }
+
+            if (degree == 1)
+            {
+                return;
+            }
+
+            // Copy the coefficients and roots to structure-of-arrays form
+            // and polish the roots. Unused root slots are set to zero; they
+            // are polished but not copied back.
+            std::array<std::array<Real, BLOCK_SIZE>, 4> C, X;
+            for (size_t i = 0; i < n; ++i)
+            {
+                Real const* c = coefficients + d * (imin + i);
+                Real const* r = roots + d * (imin + i);
+                uint32_t const count = numRoots[imin + i];
+                for (size_t j = 0; j < d; ++j)
+                {
+                    C[j][i] = c[j];
+                    X[j][i] = (j < count ? r[j] : static_cast<Real>(0));
+                }
+            }
+
+            switch (degree)
+            {
+            case 2:
+                Polish<2>(n, C, X);
+                break;
+            case 3:
+                Polish<3>(n, C, X);
+                break;
+            default:
+                Polish<4>(n, C, X);
+                break;
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                Real* r = roots + d * (imin + i);
+                uint32_t const count = numRoots[imin + i];
+                for (uint32_t j = 0; j < count; ++j)
+                {
+                    r[j] = X[j][i];
+                }
+                std::sort(r, r + count);
+            }
+        }
+
+        // Evaluate the monic polynomial and its derivative.
+        template <int D>
+        static inline void Evaluate(Real const* c, Real x, Real& p, Real& dp)
+        {
+            p = static_cast<Real>(1);
+            dp = static_cast<Real>(0);
+            for (int j = D - 1; j >= 0; --j)
+            {
+                dp = dp * x + p;
+                p = p * x + c[j];
+            }
+        }
+
+        // Apply Newton's method to the roots of the block. A Newton step is
+        // accepted only when it reduces the magnitude of the polynomial.
+        template <int D>
+        static void Polish(size_t n,
+            std::array<std::array<Real, BLOCK_SIZE>, 4> const& C,
+            std::array<std::array<Real, BLOCK_SIZE>, 4>& X)
+        {
+            int const numIterations = 2;
+            for (int k = 0; k < D; ++k)
+            {
+                Real* x = X[k].data();
+                for (int iteration = 0; iteration < numIterations; ++iteration)
+                {
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        Real c[D];
+                        for (int j = 0; j < D; ++j)
+                        {
+                            c[j] = C[j][i];
+                        }
+
+                        // The division is not guarded so that the loop has
+                        // no branches. When dp = 0, xNext is infinite or NaN
+                        // and the comparison rejects it.
+                        Real p, dp, pNext, dpNext;
+                        Evaluate<D>(c, x[i], p, dp);
+                        Real xNext = x[i] - p / dp;
+                        Evaluate<D>(c, xNext, pNext, dpNext);
+                        x[i] = (std::fabs(pNext) < std::fabs(p) ? xNext : x[i]);
+                    }
+                }
+            }
+        }
+
+        // Solve x^2 + c1 * x + c0 = 0.
+        void SolveQuadratic(Real c0, Real c1, Real* roots, uint32_t& numRoots,
+            bool& isIllConditioned) const
+        {
+            Real const zero = static_cast<Real>(0);
+            Real half = static_cast<Real>(0.5) * c1;
+            Real discriminant = half * half - c0;
+            Real scale = half * half + std::fabs(c0);
+            isIllConditioned = (std::fabs(discriminant) <= mTolerance * scale);
+            numRoots = 0;
+            if (discriminant >= zero)
+            {
+                // Avoid the subtractive cancellation of -half + sqrt(D)
+                // for one root and compute the other from the product c0
+                // of the roots.
+                Real sqrtDiscriminant = std::sqrt(discriminant);
+                Real root0 = -(half >= zero ? half + sqrtDiscriminant : half - sqrtDiscriminant);
+                Real root1 = (root0 != zero ? c0 / root0 : zero);
+                roots[numRoots++] = root0;
+                roots[numRoots++] = root1;
+            }
+        }
+
+        // Solve x^3 + c2 * x^2 + c1 * x + c0 = 0.
+        void SolveCubic(Real c0, Real c1, Real c2, Real* roots, uint32_t& numRoots,
+            bool& isIllConditioned) const
+        {
+            Real const zero = static_cast<Real>(0);
+            Real const two = static_cast<Real>(2), three = static_cast<Real>(3);
+            Real const four = static_cast<Real>(4), twentySeven = static_cast<Real>(27);
+
+            // Solve the depressed cubic y^3 + p * y + q = 0 for x = y - shift.
+            Real shift = c2 / three;
+            Real p = c1 - c2 * shift;
+            Real q = c0 - shift * (c1 - two * shift * shift);
+            Real p3 = four * p * p * p, q2 = twentySeven * q * q;
+            Real delta = -(p3 + q2);
+            isIllConditioned = (std::fabs(delta) <= mTolerance * (std::fabs(p3) + q2));
+
+            if (delta > zero)
+            {
+                // Three simple roots y = 2 * r * cos(theta), where p = -3*r^2
+                // and cos(3 * theta) = -q / (2 * r^3).
+                Real const twoPiDiv3 = static_cast<Real>(2.0943951023931955);
+                Real r = std::sqrt(-p / three);
+                Real cs = std::min(std::max(-q / (two * r * r * r),
+                    static_cast<Real>(-1)), static_cast<Real>(1));
+                Real theta = std::acos(cs) / three;
+                roots[0] = two * r * std::cos(theta) - shift;
+                roots[1] = two * r * std::cos(theta - twoPiDiv3) - shift;
+                roots[2] = two * r * std::cos(theta + twoPiDiv3) - shift;
+                numRoots = 3;
+            }
+            else if (delta < zero)
+            {
+                // One simple root using Cardano's formula, choosing the sign
+                // of the square root to avoid subtractive cancellation.
+                Real t = -q / two;
+                Real u = std::sqrt(t * t + p * p * p / twentySeven);
+                Real a = std::cbrt(t >= zero ? t + u : t - u);
+                roots[0] = (a != zero ? a - p / (three * a) : zero) - shift;
+                numRoots = 1;
+            }
+            else if (p != zero)
+            {
+                // One simple root and one double root.
+                Real root0 = three * q / p;
+                Real root1 = -root0 / two;
+                roots[0] = root0 - shift;
+                roots[1] = root1 - shift;
+                roots[2] = root1 - shift;
+                numRoots = 3;
+            }
+            else
+            {
+                // One triple root.
+                roots[0] = -shift;
+                roots[1] = -shift;
+                roots[2] = -shift;
+                numRoots = 3;
+            }
+        }
+
+        // Solve x^4 + c3 * x^3 + c2 * x^2 + c1 * x + c0 = 0.
+        void SolveQuartic(Real c0, Real c1, Real c2, Real c3, Real* roots,
+            uint32_t& numRoots, bool& isIllConditioned) const
+        {
+            Real const zero = static_cast<Real>(0), half = static_cast<Real>(0.5);
+            Real const two = static_cast<Real>(2), three = static_cast<Real>(3);
+            Real const four = static_cast<Real>(4), six = static_cast<Real>(6);
+            Real const eight = static_cast<Real>(8);
+
+            // Solve the depressed quartic y^4 + a * y^2 + b * y + c = 0 for
+            // x = y - shift.
+            Real shift = c3 / four;
+            Real shiftSqr = shift * shift;
+            Real a = c2 - six * shiftSqr;
+            Real b = c1 - two * shift * (c2 - four * shiftSqr);
+            Real c = c0 - shift * (c1 - shift * (c2 - three * shiftSqr));
+
+            // The discriminant of the depressed quartic.
+            Real aa = a * a, bb = b * b, cc = c * c;
+            std::array<Real, 6> terms =
+            {
+                static_cast<Real>(256) * cc * c,
+                static_cast<Real>(-128) * aa * cc,
+                static_cast<Real>(144) * a * bb * c,
+                static_cast<Real>(-27) * bb * bb,
+                static_cast<Real>(16) * aa * aa * c,
+                static_cast<Real>(-4) * aa * a * bb
+            };
+            Real discriminant = zero, scale = zero;
+            for (auto term : terms)
+            {
+                discriminant += term;
+                scale += std::fabs(term);
+            }
+            isIllConditioned = (std::fabs(discriminant) <= mTolerance * scale);
+
+            std::array<Real, 4> y{};
+            uint32_t numY = 0;
+            bool factorIllConditioned = false;
+            if (b == zero)
+            {
+                // Solve the biquadratic z^2 + a * z + c = 0 for z = y^2.
+                std::array<Real, 2> z{};
+                uint32_t numZ = 0;
+                SolveQuadratic(c, a, z.data(), numZ, factorIllConditioned);
+                for (uint32_t k = 0; k < numZ; ++k)
+                {
+                    if (z[k] >= zero)
+                    {
+                        Real sqrtZ = std::sqrt(z[k]);
+                        y[numY++] = -sqrtZ;
+                        y[numY++] = sqrtZ;
+                    }
+                }
+            }
+            else
+            {
+                // The largest root m of the resolvent cubic
+                // m^3 + a * m^2 + (a^2/4 - c) * m - b^2/8 = 0 is positive.
+                // The depressed quartic factors into the quadratics
+                // y^2 + s * y + (a/2 + m - h) and y^2 - s * y + (a/2 + m + h),
+                // where s = sqrt(2 * m) and h = b / (2 * s).
+                std::array<Real, 3> mRoots{};
+                uint32_t numM = 0;
+                bool resolventIllConditioned = false;
+                SolveCubic(-bb / eight, aa / four - c, a, mRoots.data(), numM,
+                    resolventIllConditioned);
+                Real m = *std::max_element(mRoots.begin(), mRoots.begin() + numM);
+
+                // Polish m, because the factors are sensitive to its errors.
+                for (int iteration = 0; iteration < 2; ++iteration)
+                {
+                    Real rc[3] = { -bb / eight, aa / four - c, a };
+                    Real p, dp, pNext, dpNext;
+                    Evaluate<3>(rc, m, p, dp);
+                    Real mNext = (dp != zero ? m - p / dp : m);
+                    Evaluate<3>(rc, mNext, pNext, dpNext);
+                    m = (std::fabs(pNext) < std::fabs(p) ? mNext : m);
+                }
+
+                if (m > zero)
+                {
+                    Real s = std::sqrt(two * m);
+                    Real h = b / (two * s);
+                    Real base = half * a + m;
+                    bool illConditioned0 = false, illConditioned1 = false;
+                    SolveQuadratic(base - h, s, y.data(), numY, illConditioned0);
+                    uint32_t numY1 = 0;
+                    SolveQuadratic(base + h, -s, y.data() + numY, numY1, illConditioned1);
+                    numY += numY1;
+                    factorIllConditioned = illConditioned0 || illConditioned1;
+                }
+                else
+                {
+                    // Rounding errors led to a nonpositive m.
+                    factorIllConditioned = true;
+                }
+            }
+
+            // The number of real roots is 2 when the discriminant is negative
+            // and 0 or 4 when it is positive.
+            bool consistent = (discriminant < zero ? numY == 2 : numY != 2);
+            isIllConditioned = isIllConditioned || factorIllConditioned || !consistent;
+
+            for (uint32_t k = 0; k < numY; ++k)
+            {
+                roots[k] = y[k] - shift;
+            }
+            numRoots = numY;
+        }
+
+        Real mTolerance;
+    };
+}
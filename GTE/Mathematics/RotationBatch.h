@@ -0,0 +1,353 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/AxisAngle.h>
+#include <Mathematics/ChebyshevRatio.h>
+#include <Mathematics/CosEstimate.h>
+#include <Mathematics/Matrix.h>
+#include <Mathematics/Quaternion.h>
+#include <Mathematics/SinEstimate.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+// Interpolation and conversion of arrays of rotations, for example the
+// quaternions of the bones of many skeletons in an animation. The elements
+// are processed 4 at a time, each register of SIMD4Value<Real> storing one
+// component of 4 quaternions, so with GTE_USE_SIMD defined the arithmetic
+// uses SSE2 or NEON for float and AVX for double. The results are those of
+// the functions for single rotations:
+//   SlerpEstimate<D>   SLERP<Real>::Estimate<D>
+//   SlerpEstimateR<D>  SLERP<Real>::EstimateR<D>
+//   Convert            Rotation<N,Real> from Quaternion<Real>
+//   ConvertEstimate<D> Rotation<N,Real> from AxisAngle<N,Real>, but with
+//                      CosEstimate<Real>::DegreeRR<D> and
+//                      SinEstimate<Real>::DegreeRR<D+1> for the cosine and
+//                      sine of the angle
+// The interpolations have overloads for an array of times and for a time
+// shared by all elements, which is the case for blending two poses. The
+// output array may be one of the input arrays.
+
+namespace gte
+{
+    template <int N, typename Real>
+    class RotationBatch
+    {
+    public:
+        // Compute q[i] = SLERP<Real>::Estimate<D>(t[i], q0[i], q1[i]). The
+        // angle between q0[i] and q1[i] must be in [0,pi).
+        template <int D>
+        static void SlerpEstimate(size_t numElements, Real const* t,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q)
+        {
+            Interpolate(numElements, t, 1, q0, q1, q, EstimateFunction<D>);
+        }
+
+        template <int D>
+        static void SlerpEstimate(size_t numElements, Real t,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q)
+        {
+            Interpolate(numElements, &t, 0, q0, q1, q, EstimateFunction<D>);
+        }
+
+        // Compute q[i] = SLERP<Real>::EstimateR<D>(t[i], q0[i], q1[i]). The
+        // angle between q0[i] and q1[i] must be in [0,pi/2], which is the
+        // case when the keys of an animation are preprocessed as described
+        // in SlerpEstimate.h.
+        template <int D>
+        static void SlerpEstimateR(size_t numElements, Real const* t,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q)
+        {
+            Interpolate(numElements, t, 1, q0, q1, q, EstimateRFunction<D>);
+        }
+
+        template <int D>
+        static void SlerpEstimateR(size_t numElements, Real t,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q)
+        {
+            Interpolate(numElements, &t, 0, q0, q1, q, EstimateRFunction<D>);
+        }
+
+        // Compute the normalized linear interpolation
+        //   q[i] = ((1-t[i])*q0[i] + t[i]*s*q1[i])/|(1-t[i])*q0[i] + t[i]*s*q1[i]|
+        // where s = sign(Dot(q0[i],q1[i])) selects the shorter arc. The
+        // angular speed is not constant, but the interpolation is cheaper
+        // than slerp and is accurate for the small angles between the
+        // poses of consecutive keys.
+        static void Nlerp(size_t numElements, Real const* t,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q)
+        {
+            Interpolate(numElements, t, 1, q0, q1, q, NlerpFunction);
+        }
+
+        static void Nlerp(size_t numElements, Real t,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q)
+        {
+            Interpolate(numElements, &t, 0, q0, q1, q, NlerpFunction);
+        }
+
+        // Convert unit-length quaternions to rotation matrices. For N = 4,
+        // the matrices are affine with zero translation.
+        static void Convert(size_t numElements, Quaternion<Real> const* q, Matrix<N, N, Real>* r)
+        {
+            static_assert(N == 3 || N == 4, "Dimension must be 3 or 4.");
+
+            for (size_t i = 0; i < numElements; i += 4)
+            {
+                Lanes lanes = Load(q, i, numElements);
+                V const& x = lanes[0];
+                V const& y = lanes[1];
+                V const& z = lanes[2];
+                V const& w = lanes[3];
+
+                V twoX = (Real)2 * x;
+                V twoY = (Real)2 * y;
+                V twoZ = (Real)2 * z;
+                V twoXX = twoX * x;
+                V twoXY = twoX * y;
+                V twoXZ = twoX * z;
+                V twoXW = twoX * w;
+                V twoYY = twoY * y;
+                V twoYZ = twoY * z;
+                V twoYW = twoY * w;
+                V twoZZ = twoZ * z;
+                V twoZW = twoZ * w;
+
+                std::array<V, 9> entries;
+                entries[0] = (Real)1 - twoYY - twoZZ;
+                entries[4] = (Real)1 - twoXX - twoZZ;
+                entries[8] = (Real)1 - twoXX - twoYY;
+#if defined(GTE_USE_MAT_VEC)
+                entries[1] = twoXY - twoZW;
+                entries[2] = twoXZ + twoYW;
+                entries[3] = twoXY + twoZW;
+                entries[5] = twoYZ - twoXW;
+                entries[6] = twoXZ - twoYW;
+                entries[7] = twoYZ + twoXW;
+#else
+                entries[3] = twoXY - twoZW;
+                entries[6] = twoXZ + twoYW;
+                entries[1] = twoXY + twoZW;
+                entries[7] = twoYZ - twoXW;
+                entries[2] = twoXZ - twoYW;
+                entries[5] = twoYZ + twoXW;
+#endif
+                StoreMatrices(entries, i, numElements, r);
+            }
+        }
+
+        // Convert axis-angle pairs with unit-length axes to rotation
+        // matrices using estimates of the cosine and sine of the angles.
+        // The degree D is that of the cosine estimate, one of 2, 4, 6, 8 or
+        // 10; the sine estimate has degree D+1. The angles may be any real
+        // numbers.
+        template <int D>
+        static void ConvertEstimate(size_t numElements, AxisAngle<N, Real> const* a,
+            Matrix<N, N, Real>* r)
+        {
+            static_assert(N == 3 || N == 4, "Dimension must be 3 or 4.");
+
+            for (size_t i = 0; i < numElements; i += 4)
+            {
+                std::array<std::array<Real, 4>, 4> values;
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    AxisAngle<N, Real> const& element = a[std::min(i + j, numElements - 1)];
+                    values[0][j] = element.axis[0];
+                    values[1][j] = element.axis[1];
+                    values[2][j] = element.axis[2];
+                    values[3][j] = element.angle;
+                }
+                V x0(S::Load(values[0].data()));
+                V x1(S::Load(values[1].data()));
+                V x2(S::Load(values[2].data()));
+                V angle(S::Load(values[3].data()));
+
+                V cs = CosEstimate<Real>::template DegreeRR<D>(angle);
+                V sn = SinEstimate<Real>::template DegreeRR<D + 1>(angle);
+                V oneMinusCos = (Real)1 - cs;
+                V x0sqr = x0 * x0;
+                V x1sqr = x1 * x1;
+                V x2sqr = x2 * x2;
+                V x0x1m = x0 * x1 * oneMinusCos;
+                V x0x2m = x0 * x2 * oneMinusCos;
+                V x1x2m = x1 * x2 * oneMinusCos;
+                V x0Sin = x0 * sn;
+                V x1Sin = x1 * sn;
+                V x2Sin = x2 * sn;
+
+                std::array<V, 9> entries;
+                entries[0] = x0sqr * oneMinusCos + cs;
+                entries[4] = x1sqr * oneMinusCos + cs;
+                entries[8] = x2sqr * oneMinusCos + cs;
+#if defined(GTE_USE_MAT_VEC)
+                entries[1] = x0x1m - x2Sin;
+                entries[2] = x0x2m + x1Sin;
+                entries[3] = x0x1m + x2Sin;
+                entries[5] = x1x2m - x0Sin;
+                entries[6] = x0x2m - x1Sin;
+                entries[7] = x1x2m + x0Sin;
+#else
+                entries[3] = x0x1m - x2Sin;
+                entries[6] = x0x2m + x1Sin;
+                entries[1] = x0x1m + x2Sin;
+                entries[7] = x1x2m - x0Sin;
+                entries[2] = x0x2m - x1Sin;
+                entries[5] = x1x2m + x0Sin;
+#endif
+                StoreMatrices(entries, i, numElements, r);
+            }
+        }
+
+    private:
+        typedef SIMD4<Real> S;
+        typedef SIMD4Value<Real> V;
+        typedef typename S::Register Register;
+
+        // The components x, y, z and w of 4 quaternions.
+        typedef std::array<V, 4> Lanes;
+
+        // Load the quaternions q[i] through q[i+3]. The last quaternion is
+        // repeated for indices past the end of the array.
+        static Lanes Load(Quaternion<Real> const* q, size_t i, size_t numElements)
+        {
+            size_t const last = numElements - 1;
+            Register r0 = S::Load(&q[std::min(i, last)][0]);
+            Register r1 = S::Load(&q[std::min(i + 1, last)][0]);
+            Register r2 = S::Load(&q[std::min(i + 2, last)][0]);
+            Register r3 = S::Load(&q[std::min(i + 3, last)][0]);
+            S::Transpose(r0, r1, r2, r3);
+            return Lanes{ V(r0), V(r1), V(r2), V(r3) };
+        }
+
+        static void Store(Lanes const& lanes, size_t i, size_t numElements, Quaternion<Real>* q)
+        {
+            Register r[4] = { lanes[0].value, lanes[1].value, lanes[2].value, lanes[3].value };
+            S::Transpose(r[0], r[1], r[2], r[3]);
+            size_t const count = std::min(numElements - i, static_cast<size_t>(4));
+            for (size_t j = 0; j < count; ++j)
+            {
+                S::Store(&q[i + j][0], r[j]);
+            }
+        }
+
+        // Store the 3x3 rotation blocks, entries[3*row+column], of the
+        // matrices r[i] through r[i+3] that are in the array.
+        static void StoreMatrices(std::array<V, 9> const& entries, size_t i, size_t numElements,
+            Matrix<N, N, Real>* r)
+        {
+            std::array<std::array<Real, 4>, 9> values;
+            for (size_t k = 0; k < 9; ++k)
+            {
+                S::Store(values[k].data(), entries[k].value);
+            }
+
+            size_t const count = std::min(numElements - i, static_cast<size_t>(4));
+            for (size_t j = 0; j < count; ++j)
+            {
+                Matrix<N, N, Real>& matrix = r[i + j];
+                matrix.MakeIdentity();
+                for (int row = 0, k = 0; row < 3; ++row)
+                {
+                    for (int column = 0; column < 3; ++column, ++k)
+                    {
+                        matrix(row, column) = values[k][j];
+                    }
+                }
+            }
+        }
+
+        static V Dot(Lanes const& q0, Lanes const& q1)
+        {
+            V dot = q0[0] * q1[0];
+            for (int k = 1; k < 4; ++k)
+            {
+                dot = dot + q0[k] * q1[k];
+            }
+            return dot;
+        }
+
+        // Evaluate function(t, q0, q1) for blocks of 4 elements. The times
+        // are t[0] for all elements when tStride is 0.
+        template <typename Function>
+        static void Interpolate(size_t numElements, Real const* t, size_t tStride,
+            Quaternion<Real> const* q0, Quaternion<Real> const* q1, Quaternion<Real>* q,
+            Function const& function)
+        {
+            for (size_t i = 0; i < numElements; i += 4)
+            {
+                V time;
+                if (tStride == 0)
+                {
+                    time = V(t[0]);
+                }
+                else
+                {
+                    size_t const last = numElements - 1;
+                    time = V(S::Set(t[std::min(i, last)], t[std::min(i + 1, last)],
+                        t[std::min(i + 2, last)], t[std::min(i + 3, last)]));
+                }
+
+                Lanes lanes0 = Load(q0, i, numElements);
+                Lanes lanes1 = Load(q1, i, numElements);
+                Store(function(time, lanes0, lanes1), i, numElements, q);
+            }
+        }
+
+        template <int D>
+        static Lanes EstimateFunction(V const& t, Lanes const& q0, Lanes const& q1)
+        {
+            V cs = Dot(q0, q1);
+            V sign = V::Select(cs < V((Real)0), V((Real)-1), V((Real)1));
+            V f0, f1;
+            ChebyshevRatio<Real>::template GetEstimate<D>(t, (Real)1 - sign * cs, f0, f1);
+            f1 = sign * f1;
+
+            Lanes q;
+            for (int k = 0; k < 4; ++k)
+            {
+                q[k] = q0[k] * f0 + q1[k] * f1;
+            }
+            return q;
+        }
+
+        template <int D>
+        static Lanes EstimateRFunction(V const& t, Lanes const& q0, Lanes const& q1)
+        {
+            V f0, f1;
+            ChebyshevRatio<Real>::template GetEstimate<D>(t, (Real)1 - Dot(q0, q1), f0, f1);
+
+            Lanes q;
+            for (int k = 0; k < 4; ++k)
+            {
+                q[k] = q0[k] * f0 + q1[k] * f1;
+            }
+            return q;
+        }
+
+        static Lanes NlerpFunction(V const& t, Lanes const& q0, Lanes const& q1)
+        {
+            V sign = V::Select(Dot(q0, q1) < V((Real)0), V((Real)-1), V((Real)1));
+            V f0 = (Real)1 - t;
+            V f1 = sign * t;
+
+            Lanes q;
+            for (int k = 0; k < 4; ++k)
+            {
+                q[k] = q0[k] * f0 + q1[k] * f1;
+            }
+            V invLength = (Real)1 / V::Sqrt(Dot(q, q));
+            for (int k = 0; k < 4; ++k)
+            {
+                q[k] = q[k] * invLength;
+            }
+            return q;
+        }
+    };
+}
@@ -0,0 +1,740 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+// Registers of 4 floating-point numbers for the SIMD implementations of the
+// 4x4 matrix operations in Matrix4x4.h and the batch operations of
+// Transform.h. They are enabled by defining GTE_USE_SIMD. SIMD4<float> is
+// implemented with SSE2 on x86 and x64 and with NEON on ARM, and
+// SIMD4<double> is implemented with AVX when the compiler targets it.
+// GTE_HAS_SIMD4_FLOAT and GTE_HAS_SIMD4_DOUBLE are defined for the available
+// implementations. For other types or when GTE_USE_SIMD is not defined, the
+// general template implements the operations with scalar arithmetic.
+//
+// The operations are those needed to evaluate the scalar expressions of the
+// matrix operations in the lanes of the registers with the same additions
+// and multiplications in the same order, so the results are the same as
+// those of the scalar code. Multiply-adds are not fused, so this is the case
+// when the scalar code is also not compiled with fused multiply-adds (for
+// example, with Microsoft Visual Studio /fp:precise, or with GCC and Clang
+// -ffp-contract=off when FMA instructions are enabled).
+//
+// SIMD4Value<Real> wraps a register with arithmetic operators, so code that
+// is templated on its number type, such as the polynomial evaluations of the
+// estimates SinEstimate, Exp2Estimate and the others, can be evaluated in the
+// 4 lanes. Its Apply function evaluates such code over arrays. The lane
+// operations for range reduction (Truncate, Select, LdExp, FrExp) have the
+// restrictions described at their declarations.
+
+#if defined(GTE_USE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GTE_HAS_SIMD4_FLOAT
+#define GTE_SIMD4_FLOAT_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define GTE_HAS_SIMD4_FLOAT
+#define GTE_SIMD4_FLOAT_NEON
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GTE_HAS_SIMD4_DOUBLE
+#endif
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace gte
+{
+    template <typename Real>
+    class SIMD4
+    {
+    public:
+        typedef std::array<Real, 4> Register;
+
+        static inline Register Load(Real const* source)
+        {
+            return Register{ source[0], source[1], source[2], source[3] };
+        }
+
+        static inline void Store(Real* target, Register const& x)
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                target[i] = x[i];
+            }
+        }
+
+        // Store lanes 0, 1 and 2.
+        static inline void Store3(Real* target, Register const& x)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                target[i] = x[i];
+            }
+        }
+
+        static inline Register Zero()
+        {
+            return Register{ (Real)0, (Real)0, (Real)0, (Real)0 };
+        }
+
+        static inline Register Set(Real x)
+        {
+            return Register{ x, x, x, x };
+        }
+
+        static inline Register Set(Real x0, Real x1, Real x2, Real x3)
+        {
+            return Register{ x0, x1, x2, x3 };
+        }
+
+        static inline Register Add(Register const& x, Register const& y)
+        {
+            return Register{ x[0] + y[0], x[1] + y[1], x[2] + y[2], x[3] + y[3] };
+        }
+
+        static inline Register Mul(Register const& x, Register const& y)
+        {
+            return Register{ x[0] * y[0], x[1] * y[1], x[2] * y[2], x[3] * y[3] };
+        }
+
+        static inline Register Sub(Register const& x, Register const& y)
+        {
+            return Register{ x[0] - y[0], x[1] - y[1], x[2] - y[2], x[3] - y[3] };
+        }
+
+        static inline Register Div(Register const& x, Register const& y)
+        {
+            return Register{ x[0] / y[0], x[1] / y[1], x[2] / y[2], x[3] / y[3] };
+        }
+
+        static inline Register Sqrt(Register const& x)
+        {
+            return Register{ std::sqrt(x[0]), std::sqrt(x[1]), std::sqrt(x[2]), std::sqrt(x[3]) };
+        }
+
+        static inline Register Abs(Register const& x)
+        {
+            return Register{ std::fabs(x[0]), std::fabs(x[1]), std::fabs(x[2]), std::fabs(x[3]) };
+        }
+
+        // Round toward zero. The lanes must be smaller than 2^31 in
+        // magnitude.
+        static inline Register Truncate(Register const& x)
+        {
+            return Register{ std::trunc(x[0]), std::trunc(x[1]), std::trunc(x[2]), std::trunc(x[3]) };
+        }
+
+        // Comparisons return masks for Select(mask, x, y), which chooses
+        // the lanes of x where the mask is set and the lanes of y elsewhere.
+        static inline Register Less(Register const& x, Register const& y)
+        {
+            return Register{ (Real)(x[0] < y[0]), (Real)(x[1] < y[1]),
+                (Real)(x[2] < y[2]), (Real)(x[3] < y[3]) };
+        }
+
+        static inline Register Select(Register const& mask, Register const& x, Register const& y)
+        {
+            return Register{ mask[0] != (Real)0 ? x[0] : y[0], mask[1] != (Real)0 ? x[1] : y[1],
+                mask[2] != (Real)0 ? x[2] : y[2], mask[3] != (Real)0 ? x[3] : y[3] };
+        }
+
+        // Compute x*2^n for lanes n that are integers. The SIMD versions
+        // clamp n to the range for which the result can be finite and
+        // nonzero.
+        static inline Register LdExp(Register const& x, Register const& n)
+        {
+            Register result;
+            for (int i = 0; i < 4; ++i)
+            {
+                result[i] = std::ldexp(x[i], static_cast<int>(n[i]));
+            }
+            return result;
+        }
+
+        // Decompose x = m*2^e with m in [1/2,1). The SIMD versions require
+        // x to be positive and normal.
+        static inline Register FrExp(Register const& x, Register& e)
+        {
+            Register result;
+            for (int i = 0; i < 4; ++i)
+            {
+                int p;
+                result[i] = std::frexp(x[i], &p);
+                e[i] = static_cast<Real>(p);
+            }
+            return result;
+        }
+
+        // Negate the lanes 1 and 3 (odd = true) or 0 and 2 (odd = false).
+        static inline Register NegateAlternate(Register const& x, bool odd)
+        {
+            return (odd ?
+                Register{ x[0], -x[1], x[2], -x[3] } :
+                Register{ -x[0], x[1], -x[2], x[3] });
+        }
+
+        // (x0,x1,x2,x3) -> (x1,x0,x3,x2).
+        static inline Register SwapPairs(Register const& x)
+        {
+            return Register{ x[1], x[0], x[3], x[2] };
+        }
+
+        static inline void Transpose(Register& x0, Register& x1, Register& x2, Register& x3)
+        {
+            std::swap(x0[1], x1[0]);
+            std::swap(x0[2], x2[0]);
+            std::swap(x0[3], x3[0]);
+            std::swap(x1[2], x2[1]);
+            std::swap(x1[3], x3[1]);
+            std::swap(x2[3], x3[2]);
+        }
+    };
+
+#if defined(GTE_HAS_SIMD4_FLOAT)
+    template <>
+    class SIMD4<float>
+    {
+    public:
+#if defined(GTE_SIMD4_FLOAT_SSE2)
+        typedef __m128 Register;
+
+        static inline Register Load(float const* source)
+        {
+            return _mm_loadu_ps(source);
+        }
+
+        static inline void Store(float* target, Register x)
+        {
+            _mm_storeu_ps(target, x);
+        }
+
+        static inline void Store3(float* target, Register x)
+        {
+            _mm_storel_pi(reinterpret_cast<__m64*>(target), x);
+            _mm_store_ss(target + 2, _mm_movehl_ps(x, x));
+        }
+
+        static inline Register Zero()
+        {
+            return _mm_setzero_ps();
+        }
+
+        static inline Register Set(float x)
+        {
+            return _mm_set1_ps(x);
+        }
+
+        static inline Register Set(float x0, float x1, float x2, float x3)
+        {
+            return _mm_setr_ps(x0, x1, x2, x3);
+        }
+
+        static inline Register Add(Register x, Register y)
+        {
+            return _mm_add_ps(x, y);
+        }
+
+        static inline Register Mul(Register x, Register y)
+        {
+            return _mm_mul_ps(x, y);
+        }
+
+        static inline Register Sub(Register x, Register y)
+        {
+            return _mm_sub_ps(x, y);
+        }
+
+        static inline Register Div(Register x, Register y)
+        {
+            return _mm_div_ps(x, y);
+        }
+
+        static inline Register Sqrt(Register x)
+        {
+            return _mm_sqrt_ps(x);
+        }
+
+        static inline Register Abs(Register x)
+        {
+            return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+        }
+
+        static inline Register Truncate(Register x)
+        {
+            return _mm_cvtepi32_ps(_mm_cvttps_epi32(x));
+        }
+
+        static inline Register Less(Register x, Register y)
+        {
+            return _mm_cmplt_ps(x, y);
+        }
+
+        static inline Register Select(Register mask, Register x, Register y)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+        }
+
+        // The product x*2^n1*2^n2 with n1 + n2 = n avoids the overflow of
+        // 2^n for the n whose results are representable.
+        static inline Register LdExp(Register x, Register n)
+        {
+            __m128i p = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(n, _mm_set1_ps(-252.0f)),
+                _mm_set1_ps(254.0f)));
+            __m128i p1 = _mm_srai_epi32(p, 1);
+            __m128i p2 = _mm_sub_epi32(p, p1);
+            __m128i const bias = _mm_set1_epi32(127);
+            Register s1 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(p1, bias), 23));
+            Register s2 = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(p2, bias), 23));
+            return _mm_mul_ps(_mm_mul_ps(x, s1), s2);
+        }
+
+        static inline Register FrExp(Register x, Register& e)
+        {
+            __m128i bits = _mm_castps_si128(x);
+            __m128i biased = _mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xff));
+            e = _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(126)));
+            bits = _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x807fffffu))),
+                _mm_set1_epi32(0x3f000000));
+            return _mm_castsi128_ps(bits);
+        }
+
+        static inline Register NegateAlternate(Register x, bool odd)
+        {
+            Register const mask = (odd ?
+                _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f) :
+                _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f));
+            return _mm_xor_ps(x, mask);
+        }
+
+        static inline Register SwapPairs(Register x)
+        {
+            return _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+
+        static inline void Transpose(Register& x0, Register& x1, Register& x2, Register& x3)
+        {
+            _MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+        }
+#else
+        typedef float32x4_t Register;
+
+        static inline Register Load(float const* source)
+        {
+            return vld1q_f32(source);
+        }
+
+        static inline void Store(float* target, Register x)
+        {
+            vst1q_f32(target, x);
+        }
+
+        static inline void Store3(float* target, Register x)
+        {
+            vst1_f32(target, vget_low_f32(x));
+            vst1q_lane_f32(target + 2, x, 2);
+        }
+
+        static inline Register Zero()
+        {
+            return vdupq_n_f32(0.0f);
+        }
+
+        static inline Register Set(float x)
+        {
+            return vdupq_n_f32(x);
+        }
+
+        static inline Register Set(float x0, float x1, float x2, float x3)
+        {
+            float const values[4] = { x0, x1, x2, x3 };
+            return vld1q_f32(values);
+        }
+
+        static inline Register Add(Register x, Register y)
+        {
+            return vaddq_f32(x, y);
+        }
+
+        static inline Register Mul(Register x, Register y)
+        {
+            return vmulq_f32(x, y);
+        }
+
+        static inline Register Sub(Register x, Register y)
+        {
+            return vsubq_f32(x, y);
+        }
+
+        // ARMv7 NEON has no division or square root. They are computed
+        // from the reciprocal estimates with two Newton iterations, so they
+        // are not correctly rounded.
+        static inline Register Div(Register x, Register y)
+        {
+#if defined(__aarch64__) || defined(_M_ARM64)
+            return vdivq_f32(x, y);
+#else
+            Register r = vrecpeq_f32(y);
+            r = vmulq_f32(vrecpsq_f32(y, r), r);
+            r = vmulq_f32(vrecpsq_f32(y, r), r);
+            return vmulq_f32(x, r);
+#endif
+        }
+
+        static inline Register Sqrt(Register x)
+        {
+#if defined(__aarch64__) || defined(_M_ARM64)
+            return vsqrtq_f32(x);
+#else
+            Register r = vrsqrteq_f32(x);
+            r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+            r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, r), r), r);
+            Register zero = vdupq_n_f32(0.0f);
+            return vbslq_f32(vceqq_f32(x, zero), zero, vmulq_f32(x, r));
+#endif
+        }
+
+        static inline Register Abs(Register x)
+        {
+            return vabsq_f32(x);
+        }
+
+        static inline Register Truncate(Register x)
+        {
+            return vcvtq_f32_s32(vcvtq_s32_f32(x));
+        }
+
+        static inline Register Less(Register x, Register y)
+        {
+            return vreinterpretq_f32_u32(vcltq_f32(x, y));
+        }
+
+        static inline Register Select(Register mask, Register x, Register y)
+        {
+            return vbslq_f32(vreinterpretq_u32_f32(mask), x, y);
+        }
+
+        static inline Register LdExp(Register x, Register n)
+        {
+            int32x4_t p = vcvtq_s32_f32(vminq_f32(vmaxq_f32(n, vdupq_n_f32(-252.0f)),
+                vdupq_n_f32(254.0f)));
+            int32x4_t p1 = vshrq_n_s32(p, 1);
+            int32x4_t p2 = vsubq_s32(p, p1);
+            int32x4_t const bias = vdupq_n_s32(127);
+            Register s1 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(p1, bias), 23));
+            Register s2 = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(p2, bias), 23));
+            return vmulq_f32(vmulq_f32(x, s1), s2);
+        }
+
+        static inline Register FrExp(Register x, Register& e)
+        {
+            uint32x4_t bits = vreinterpretq_u32_f32(x);
+            uint32x4_t biased = vandq_u32(vshrq_n_u32(bits, 23), vdupq_n_u32(0xffu));
+            e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(biased), vdupq_n_s32(126)));
+            bits = vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x807fffffu)), vdupq_n_u32(0x3f000000u));
+            return vreinterpretq_f32_u32(bits);
+        }
+
+        static inline Register NegateAlternate(Register x, bool odd)
+        {
+            uint32_t const s = 0x80000000u;
+            uint32_t const bits[4] = { odd ? 0u : s, odd ? s : 0u, odd ? 0u : s, odd ? s : 0u };
+            return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(x), vld1q_u32(bits)));
+        }
+
+        static inline Register SwapPairs(Register x)
+        {
+            return vrev64q_f32(x);
+        }
+
+        static inline void Transpose(Register& x0, Register& x1, Register& x2, Register& x3)
+        {
+            float32x4x2_t t01 = vtrnq_f32(x0, x1);
+            float32x4x2_t t23 = vtrnq_f32(x2, x3);
+            x0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+            x1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+            x2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+            x3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+        }
+#endif
+    };
+#endif
+
+#if defined(GTE_HAS_SIMD4_DOUBLE)
+    template <>
+    class SIMD4<double>
+    {
+    public:
+        typedef __m256d Register;
+
+        static inline Register Load(double const* source)
+        {
+            return _mm256_loadu_pd(source);
+        }
+
+        static inline void Store(double* target, Register x)
+        {
+            _mm256_storeu_pd(target, x);
+        }
+
+        static inline void Store3(double* target, Register x)
+        {
+            _mm_storeu_pd(target, _mm256_castpd256_pd128(x));
+            _mm_store_sd(target + 2, _mm256_extractf128_pd(x, 1));
+        }
+
+        static inline Register Zero()
+        {
+            return _mm256_setzero_pd();
+        }
+
+        static inline Register Set(double x)
+        {
+            return _mm256_set1_pd(x);
+        }
+
+        static inline Register Set(double x0, double x1, double x2, double x3)
+        {
+            return _mm256_setr_pd(x0, x1, x2, x3);
+        }
+
+        static inline Register Add(Register x, Register y)
+        {
+            return _mm256_add_pd(x, y);
+        }
+
+        static inline Register Mul(Register x, Register y)
+        {
+            return _mm256_mul_pd(x, y);
+        }
+
+        static inline Register Sub(Register x, Register y)
+        {
+            return _mm256_sub_pd(x, y);
+        }
+
+        static inline Register Div(Register x, Register y)
+        {
+            return _mm256_div_pd(x, y);
+        }
+
+        static inline Register Sqrt(Register x)
+        {
+            return _mm256_sqrt_pd(x);
+        }
+
+        static inline Register Abs(Register x)
+        {
+            return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+        }
+
+        static inline Register Truncate(Register x)
+        {
+            return _mm256_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        }
+
+        static inline Register Less(Register x, Register y)
+        {
+            return _mm256_cmp_pd(x, y, _CMP_LT_OQ);
+        }
+
+        static inline Register Select(Register mask, Register x, Register y)
+        {
+            return _mm256_blendv_pd(y, x, mask);
+        }
+
+        // AVX has no 256-bit integer arithmetic, so the exponents are
+        // processed as 32-bit integers in 128-bit registers.
+        static inline Register LdExp(Register x, Register n)
+        {
+            __m128i p = _mm256_cvttpd_epi32(_mm256_min_pd(_mm256_max_pd(n,
+                _mm256_set1_pd(-2044.0)), _mm256_set1_pd(2046.0)));
+            __m128i p1 = _mm_srai_epi32(p, 1);
+            __m128i p2 = _mm_sub_epi32(p, p1);
+            return _mm256_mul_pd(_mm256_mul_pd(x, PowerOfTwo(p1)), PowerOfTwo(p2));
+        }
+
+        static inline Register FrExp(Register x, Register& e)
+        {
+            __m256i bits = _mm256_castpd_si256(x);
+            __m128i lo = _mm_srli_epi64(_mm256_castsi256_si128(bits), 52);
+            __m128i hi = _mm_srli_epi64(_mm256_extractf128_si256(bits, 1), 52);
+            __m128i biased = _mm_unpacklo_epi64(
+                _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 2, 0)),
+                _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 2, 0)));
+            biased = _mm_and_si128(biased, _mm_set1_epi32(0x7ff));
+            e = _mm256_cvtepi32_pd(_mm_sub_epi32(biased, _mm_set1_epi32(1022)));
+            Register mantissa = _mm256_and_pd(x,
+                _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(0x800fffffffffffffull))));
+            return _mm256_or_pd(mantissa,
+                _mm256_castsi256_pd(_mm256_set1_epi64x(0x3fe0000000000000ll)));
+        }
+
+        static inline Register NegateAlternate(Register x, bool odd)
+        {
+            Register const mask = (odd ?
+                _mm256_setr_pd(0.0, -0.0, 0.0, -0.0) :
+                _mm256_setr_pd(-0.0, 0.0, -0.0, 0.0));
+            return _mm256_xor_pd(x, mask);
+        }
+
+        static inline Register SwapPairs(Register x)
+        {
+            return _mm256_permute_pd(x, 0x5);
+        }
+
+        static inline void Transpose(Register& x0, Register& x1, Register& x2, Register& x3)
+        {
+            Register t0 = _mm256_unpacklo_pd(x0, x1);  // x00 x10 x02 x12
+            Register t1 = _mm256_unpackhi_pd(x0, x1);  // x01 x11 x03 x13
+            Register t2 = _mm256_unpacklo_pd(x2, x3);  // x20 x30 x22 x32
+            Register t3 = _mm256_unpackhi_pd(x2, x3);  // x21 x31 x23 x33
+            x0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+            x1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+            x2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+            x3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+        }
+
+    private:
+        // Compute 2^p for the integers p in [-1022,1023].
+        static inline Register PowerOfTwo(__m128i p)
+        {
+            __m128i biased = _mm_add_epi32(p, _mm_set1_epi32(1023));
+            __m128i zero = _mm_setzero_si128();
+            __m128i lo = _mm_slli_epi64(_mm_unpacklo_epi32(biased, zero), 52);
+            __m128i hi = _mm_slli_epi64(_mm_unpackhi_epi32(biased, zero), 52);
+            return _mm256_castsi256_pd(_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1));
+        }
+    };
+#endif
+
+    template <typename Real>
+    class SIMD4Value
+    {
+    public:
+        typedef SIMD4<Real> S;
+        typedef typename S::Register Register;
+
+        // The default constructor leaves the lanes uninitialized. A number
+        // is broadcast to all lanes.
+        SIMD4Value() = default;
+
+        SIMD4Value(Real x)
+            :
+            value(S::Set(x))
+        {
+        }
+
+        explicit SIMD4Value(Register const& x)
+            :
+            value(x)
+        {
+        }
+
+        friend inline SIMD4Value operator+(SIMD4Value const& x, SIMD4Value const& y)
+        {
+            return SIMD4Value(S::Add(x.value, y.value));
+        }
+
+        friend inline SIMD4Value operator-(SIMD4Value const& x, SIMD4Value const& y)
+        {
+            return SIMD4Value(S::Sub(x.value, y.value));
+        }
+
+        friend inline SIMD4Value operator*(SIMD4Value const& x, SIMD4Value const& y)
+        {
+            return SIMD4Value(S::Mul(x.value, y.value));
+        }
+
+        friend inline SIMD4Value operator/(SIMD4Value const& x, SIMD4Value const& y)
+        {
+            return SIMD4Value(S::Div(x.value, y.value));
+        }
+
+        friend inline SIMD4Value operator-(SIMD4Value const& x)
+        {
+            return SIMD4Value(S::Sub(S::Zero(), x.value));
+        }
+
+        // The comparison returns a mask for Select.
+        friend inline SIMD4Value operator<(SIMD4Value const& x, SIMD4Value const& y)
+        {
+            return SIMD4Value(S::Less(x.value, y.value));
+        }
+
+        static inline SIMD4Value Select(SIMD4Value const& mask, SIMD4Value const& x,
+            SIMD4Value const& y)
+        {
+            return SIMD4Value(S::Select(mask.value, x.value, y.value));
+        }
+
+        static inline SIMD4Value Sqrt(SIMD4Value const& x)
+        {
+            return SIMD4Value(S::Sqrt(x.value));
+        }
+
+        static inline SIMD4Value Abs(SIMD4Value const& x)
+        {
+            return SIMD4Value(S::Abs(x.value));
+        }
+
+        static inline SIMD4Value Truncate(SIMD4Value const& x)
+        {
+            return SIMD4Value(S::Truncate(x.value));
+        }
+
+        static inline SIMD4Value Floor(SIMD4Value const& x)
+        {
+            SIMD4Value t = Truncate(x);
+            return Select(x < t, t - (Real)1, t);
+        }
+
+        static inline SIMD4Value LdExp(SIMD4Value const& x, SIMD4Value const& n)
+        {
+            return SIMD4Value(S::LdExp(x.value, n.value));
+        }
+
+        static inline SIMD4Value FrExp(SIMD4Value const& x, SIMD4Value& e)
+        {
+            return SIMD4Value(S::FrExp(x.value, e.value));
+        }
+
+        // Compute result[i] = function(x[i]) for 0 <= i < numElements,
+        // where function maps a SIMD4Value to a SIMD4Value. The last
+        // elements are padded to a full register by repeating the last
+        // input. The arrays x and result may be the same.
+        template <typename Function>
+        static void Apply(size_t numElements, Real const* x, Real* result,
+            Function const& function)
+        {
+            size_t i = 0;
+            for (; i + 4 <= numElements; i += 4)
+            {
+                S::Store(result + i, function(SIMD4Value(S::Load(x + i))).value);
+            }
+
+            if (i < numElements)
+            {
+                std::array<Real, 4> input, output;
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    input[j] = x[std::min(i + j, numElements - 1)];
+                }
+                S::Store(output.data(), function(SIMD4Value(S::Load(input.data()))).value);
+                std::copy(output.begin(), output.begin() + (numElements - i), result + i);
+            }
+        }
+
+        Register value;
+    };
+}
@@ -0,0 +1,377 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+// Class SIntegerFixed32<NumBits> is a signed integer x with |x| < 2^NumBits
+// stored in sign-magnitude form with the magnitude in NumBits/32 + 1 words
+// of 32 bits. It is designed for exact sign predicates whose inputs are
+// integers of bounded size, for example, 'float' numbers scaled by 2^{149},
+// and it is not a general-purpose integer class. The number of bits of the
+// result of each operation is known at compile time,
+//   SIntegerFixed32<B0> + SIntegerFixed32<B1> is SIntegerFixed32<max(B0,B1)+1>
+//   SIntegerFixed32<B0> - SIntegerFixed32<B1> is SIntegerFixed32<max(B0,B1)+1>
+//   SIntegerFixed32<B0> * SIntegerFixed32<B1> is SIntegerFixed32<B0+B1>
+// so the results never overflow and the type of an expression is the
+// worst-case type that BSPrecision computes for BSNumber. No memory is
+// allocated and the class is trivially copyable. The binary point of all
+// numbers is the same, so unlike BSNumber there are no exponents to align by
+// shifting and no normalization of the results to odd integers. Each number
+// stores the range [first,last) of its nonzero words, and the operations
+// loop only over those ranges, which matters because scaled 'float' numbers
+// are sparse: a number of the range [1,2) with 24-bit significand occupies 1
+// or 2 of the 9 words of the 277-bit input type.
+
+namespace gte
+{
+    template <int NumBits>
+    class SIntegerFixed32
+    {
+    public:
+        static_assert(NumBits > 0, "The number of bits must be positive.");
+
+        enum
+        {
+            NUM_BITS = NumBits,
+            NUM_WORDS = NumBits / 32 + 1
+        };
+
+        // Construction. The default constructor creates zero.
+        SIntegerFixed32()
+            :
+            mSign(0),
+            mFirst(0),
+            mLast(0),
+            mWords{}
+        {
+        }
+
+        // The number must satisfy |number| < 2^NumBits.
+        SIntegerFixed32(int64_t number)
+            :
+            mSign(0),
+            mFirst(0),
+            mLast(0),
+            mWords{}
+        {
+            if (number != 0)
+            {
+                uint64_t magnitude;
+                if (number > 0)
+                {
+                    mSign = +1;
+                    magnitude = static_cast<uint64_t>(number);
+                }
+                else
+                {
+                    mSign = -1;
+                    magnitude = ~static_cast<uint64_t>(number) + 1;
+                }
+                SetMagnitude(0, magnitude);
+            }
+        }
+
+        // The number x is converted to the integer x * 2^{149}, which is
+        // exact for all finite 'float' numbers including the subnormals.
+        // The magnitude of the integer is smaller than 2^{277}.
+        static SIntegerFixed32 FromFloat(float number)
+        {
+            static_assert(NumBits >= 277, "The number of bits must be at least 277.");
+
+            uint32_t encoding;
+            std::memcpy(&encoding, &number, sizeof(encoding));
+            uint32_t const biased = (encoding >> 23) & 0x000000FFu;
+            uint32_t const trailing = encoding & 0x007FFFFFu;
+            LogAssert(biased < 255, "Infinities and NaNs are not supported.");
+
+            // The integer is significand * 2^shift.
+            SIntegerFixed32 result;
+            if (biased > 0)
+            {
+                int32_t const shift = static_cast<int32_t>(biased) - 1;
+                uint64_t const significand = static_cast<uint64_t>(trailing | 0x00800000u);
+                result.SetMagnitude(shift / 32, significand << (shift % 32));
+            }
+            else if (trailing > 0)
+            {
+                result.SetMagnitude(0, static_cast<uint64_t>(trailing));
+            }
+            else
+            {
+                return result;
+            }
+            result.mSign = ((encoding & 0x80000000u) != 0 ? -1 : +1);
+            return result;
+        }
+
+        // Member access.
+        inline int32_t GetSign() const
+        {
+            return mSign;
+        }
+
+        // The nonzero words of the magnitude are in the range [first,last).
+        // The words outside the range are zero.
+        inline int32_t GetFirst() const
+        {
+            return mFirst;
+        }
+
+        inline int32_t GetLast() const
+        {
+            return mLast;
+        }
+
+        inline std::array<uint32_t, NUM_WORDS> const& GetWords() const
+        {
+            return mWords;
+        }
+
+        // Comparisons.
+        bool operator==(SIntegerFixed32 const& number) const
+        {
+            return mSign == number.mSign && mWords == number.mWords;
+        }
+
+        bool operator!=(SIntegerFixed32 const& number) const
+        {
+            return !operator==(number);
+        }
+
+        // Unary operations.
+        SIntegerFixed32 operator+() const
+        {
+            return *this;
+        }
+
+        SIntegerFixed32 operator-() const
+        {
+            SIntegerFixed32 result = *this;
+            result.mSign = -mSign;
+            return result;
+        }
+
+        // Arithmetic. The functions are the implementations of the
+        // operators +, - and * that follow the class.
+        template <int B0, int B1>
+        static void Add(SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1,
+            int32_t sign1, SIntegerFixed32& result)
+        {
+            if (n0.GetSign() == 0)
+            {
+                result.CopyFrom(n1, sign1);
+            }
+            else if (sign1 == 0)
+            {
+                result.CopyFrom(n0, n0.GetSign());
+            }
+            else if (n0.GetSign() == sign1)
+            {
+                result.AddMagnitudes(n0, n1);
+                result.mSign = sign1;
+            }
+            else
+            {
+                int32_t order = CompareMagnitudes(n0, n1);
+                if (order > 0)
+                {
+                    result.SubMagnitudes(n0, n1);
+                    result.mSign = n0.GetSign();
+                }
+                else if (order < 0)
+                {
+                    result.SubMagnitudes(n1, n0);
+                    result.mSign = sign1;
+                }
+                // else the result is zero
+            }
+        }
+
+        template <int B0, int B1>
+        static void Mul(SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1,
+            SIntegerFixed32& result)
+        {
+            int32_t const sign = n0.GetSign() * n1.GetSign();
+            if (sign == 0)
+            {
+                return;
+            }
+
+            // The product of the magnitudes is smaller than 2^{B0+B1}, so
+            // the words of index NUM_WORDS or larger are zero and are not
+            // computed.
+            auto const& words0 = n0.GetWords();
+            auto const& words1 = n1.GetWords();
+            int32_t const first0 = n0.GetFirst(), last0 = n0.GetLast();
+            int32_t const first1 = n1.GetFirst(), last1 = n1.GetLast();
+            int32_t const numWords = std::min(last0 + last1, static_cast<int32_t>(NUM_WORDS));
+            for (int32_t i0 = first0; i0 < last0; ++i0)
+            {
+                uint64_t const factor = words0[i0];
+                uint64_t carry = 0;
+                int32_t i = i0 + first1;
+                for (int32_t i1 = first1; i1 < last1 && i < numWords; ++i1, ++i)
+                {
+                    uint64_t term = factor * static_cast<uint64_t>(words1[i1]) +
+                        static_cast<uint64_t>(result.mWords[i]) + carry;
+                    result.mWords[i] = static_cast<uint32_t>(term & 0x00000000FFFFFFFFull);
+                    carry = (term >> 32);
+                }
+                if (i < numWords)
+                {
+                    result.mWords[i] = static_cast<uint32_t>(carry);
+                }
+            }
+
+            result.mSign = sign;
+            result.mFirst = first0 + first1;
+            result.mLast = numWords;
+            result.Trim();
+        }
+
+    private:
+        template <int>
+        friend class SIntegerFixed32;
+
+        // Set the magnitude to value * 2^{32*index}.
+        void SetMagnitude(int32_t index, uint64_t value)
+        {
+            uint32_t const low = static_cast<uint32_t>(value & 0x00000000FFFFFFFFull);
+            uint32_t const high = static_cast<uint32_t>(value >> 32);
+            mWords[index] = low;
+            mFirst = (low != 0 ? index : index + 1);
+            mLast = index + 1;
+            if (high != 0)
+            {
+                mWords[index + 1] = high;
+                mLast = index + 2;
+            }
+        }
+
+        template <int B>
+        void CopyFrom(SIntegerFixed32<B> const& number, int32_t sign)
+        {
+            mSign = sign;
+            mFirst = number.mFirst;
+            mLast = number.mLast;
+            std::copy(number.mWords.begin() + mFirst, number.mWords.begin() + mLast,
+                mWords.begin() + mFirst);
+        }
+
+        template <int B0, int B1>
+        static int32_t CompareMagnitudes(SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1)
+        {
+            if (n0.mLast != n1.mLast)
+            {
+                return (n0.mLast > n1.mLast ? +1 : -1);
+            }
+            int32_t const first = std::max(n0.mFirst, n1.mFirst);
+            for (int32_t i = n0.mLast - 1; i >= first; --i)
+            {
+                if (n0.mWords[i] != n1.mWords[i])
+                {
+                    return (n0.mWords[i] > n1.mWords[i] ? +1 : -1);
+                }
+            }
+            return (n0.mFirst < n1.mFirst ? +1 : (n0.mFirst > n1.mFirst ? -1 : 0));
+        }
+
+        // Compute |n0| + |n1|.
+        template <int B0, int B1>
+        void AddMagnitudes(SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1)
+        {
+            int32_t const first = std::min(n0.mFirst, n1.mFirst);
+            int32_t const last = std::max(n0.mLast, n1.mLast);
+            uint64_t carry = 0;
+            for (int32_t i = first; i < last; ++i)
+            {
+                uint64_t sum = static_cast<uint64_t>(i < n0.mLast ? n0.mWords[i] : 0u) +
+                    static_cast<uint64_t>(i < n1.mLast ? n1.mWords[i] : 0u) + carry;
+                mWords[i] = static_cast<uint32_t>(sum & 0x00000000FFFFFFFFull);
+                carry = (sum >> 32);
+            }
+            mFirst = first;
+            mLast = last;
+            if (carry > 0)
+            {
+                mWords[mLast++] = static_cast<uint32_t>(carry);
+            }
+            while (mWords[mFirst] == 0)
+            {
+                ++mFirst;
+            }
+        }
+
+        // Compute |n0| - |n1| > 0.
+        template <int B0, int B1>
+        void SubMagnitudes(SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1)
+        {
+            int32_t const first = std::min(n0.mFirst, n1.mFirst);
+            int64_t borrow = 0;
+            for (int32_t i = first; i < n0.mLast; ++i)
+            {
+                int64_t diff = static_cast<int64_t>(n0.mWords[i]) -
+                    static_cast<int64_t>(i < n1.mLast ? n1.mWords[i] : 0u) - borrow;
+                borrow = (diff < 0 ? 1 : 0);
+                mWords[i] = static_cast<uint32_t>(diff + (borrow << 32));
+            }
+            mFirst = first;
+            mLast = n0.mLast;
+            Trim();
+        }
+
+        // Remove the leading and trailing zero words from the range of the
+        // nonzero magnitude.
+        void Trim()
+        {
+            while (mWords[mLast - 1] == 0)
+            {
+                --mLast;
+            }
+            while (mWords[mFirst] == 0)
+            {
+                ++mFirst;
+            }
+        }
+
+        int32_t mSign, mFirst, mLast;
+        std::array<uint32_t, NUM_WORDS> mWords;
+    };
+
+    template <int B0, int B1>
+    SIntegerFixed32<(B0 > B1 ? B0 : B1) + 1> operator+(
+        SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1)
+    {
+        SIntegerFixed32<(B0 > B1 ? B0 : B1) + 1> result;
+        decltype(result)::Add(n0, n1, n1.GetSign(), result);
+        return result;
+    }
+
+    template <int B0, int B1>
+    SIntegerFixed32<(B0 > B1 ? B0 : B1) + 1> operator-(
+        SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1)
+    {
+        SIntegerFixed32<(B0 > B1 ? B0 : B1) + 1> result;
+        decltype(result)::Add(n0, n1, -n1.GetSign(), result);
+        return result;
+    }
+
+    template <int B0, int B1>
+    SIntegerFixed32<B0 + B1> operator*(
+        SIntegerFixed32<B0> const& n0, SIntegerFixed32<B1> const& n1)
+    {
+        SIntegerFixed32<B0 + B1> result;
+        decltype(result)::Mul(n0, n1, result);
+        return result;
+    }
+}
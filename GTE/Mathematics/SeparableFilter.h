@@ -0,0 +1,218 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <vector>
+
+// The 1-dimensional kernels of separable image filters, which are used by
+// ImageUtility2 and ImageUtility3 for convolution and for dilation and
+// erosion with rectangular structuring elements. A filter of radius r
+// combines the 2*r+1 values at offsets -r through r.
+//
+// The line functions filter n contiguous values. The row functions
+// combine rows of n contiguous values elementwise, which is how a filter
+// is applied in the directions that are not contiguous in memory. Each
+// loop applies one offset to a contiguous range of values and has no
+// branches, so the compiler can vectorize it. The caller chooses the rows
+// for the offsets, which is how the boundary of the image is handled.
+//
+// The values at offsets outside [0,n) of a line are replaced by the value
+// at the nearest end of the line (clamping). For dilation and erosion,
+// clamping is equivalent to ignoring the exterior. The erosion of a line
+// can use instead a constant exterior value.
+
+namespace gte
+{
+    class SeparableFilter
+    {
+    public:
+        // output[x] = sum_{k=-r}^{r} kernel[k+r] * input[clamp(x+k)] for
+        // 0 <= x < n. The output must not overlap the input.
+        template <typename Real>
+        static void ConvolveLine(Real const* input, int n, Real const* kernel,
+            int radius, Real* output)
+        {
+            std::fill(output, output + n, (Real)0);
+            for (int k = -radius; k <= radius; ++k)
+            {
+                Real const weight = kernel[k + radius];
+                int const x0 = std::min(std::max(-k, 0), n);
+                int const x1 = std::max(std::min(n - k, n), x0);
+                for (int x = x0; x < x1; ++x)
+                {
+                    output[x] += weight * input[x + k];
+                }
+
+                Real const w0 = weight * input[0];
+                for (int x = 0; x < x0; ++x)
+                {
+                    output[x] += w0;
+                }
+
+                Real const w1 = weight * input[n - 1];
+                for (int x = x1; x < n; ++x)
+                {
+                    output[x] += w1;
+                }
+            }
+        }
+
+        // output[x] = sum_{k=0}^{2*r} kernel[k] * rows[k][x] for 0 <= x < n.
+        template <typename Real>
+        static void ConvolveRows(Real const* const* rows, int n, Real const* kernel,
+            int radius, Real* output)
+        {
+            std::fill(output, output + n, (Real)0);
+            for (int k = 0; k <= 2 * radius; ++k)
+            {
+                Real const weight = kernel[k];
+                Real const* row = rows[k];
+                for (int x = 0; x < n; ++x)
+                {
+                    output[x] += weight * row[x];
+                }
+            }
+        }
+
+        // output[x] = max_{k=-r}^{r} input[clamp(x+k)] for 0 <= x < n.
+        template <typename T>
+        static void DilateLine(T const* input, int n, int radius, T* output)
+        {
+            ReduceLine(input, n, radius, static_cast<T const*>(nullptr), output,
+                [](T const& a, T const& b) { return (a < b ? b : a); });
+        }
+
+        // output[x] = min_{k=-r}^{r} input[x+k] for 0 <= x < n, where the
+        // values outside the line are the exterior value when it is not
+        // null or the values at the nearest end of the line when it is null.
+        template <typename T>
+        static void ErodeLine(T const* input, int n, int radius, T const* exterior, T* output)
+        {
+            ReduceLine(input, n, radius, exterior, output,
+                [](T const& a, T const& b) { return (b < a ? b : a); });
+        }
+
+        // output[x] = max_{k} rows[k][x] and output[x] = min_{k} rows[k][x]
+        // for 0 <= x < n and 0 <= k < numRows.
+        template <typename T>
+        static void DilateRows(T const* const* rows, int numRows, int n, T* output)
+        {
+            ReduceRows(rows, numRows, n, output,
+                [](T const& a, T const& b) { return (a < b ? b : a); });
+        }
+
+        template <typename T>
+        static void ErodeRows(T const* const* rows, int numRows, int n, T* output)
+        {
+            ReduceRows(rows, numRows, n, output,
+                [](T const& a, T const& b) { return (b < a ? b : a); });
+        }
+
+        // The rows for offsets -r through r of row j of a direction with
+        // numRows rows, where getRow(i) is the pointer to row i. Rows
+        // outside the image are clamped to the first or last row when
+        // 'exterior' is null; otherwise, they are 'exterior'.
+        template <typename T, typename GetRow>
+        static void GetRows(int j, int numRows, int radius, T const* exterior,
+            GetRow const& getRow, std::vector<T const*>& rows)
+        {
+            rows.resize(2 * static_cast<size_t>(radius) + 1);
+            for (int k = -radius; k <= radius; ++k)
+            {
+                int const i = j + k;
+                if (0 <= i && i < numRows)
+                {
+                    rows[k + radius] = getRow(i);
+                }
+                else
+                {
+                    rows[k + radius] = (exterior ? exterior : getRow(std::min(std::max(i, 0), numRows - 1)));
+                }
+            }
+        }
+
+        // Execute function(begin,end) for the subranges of [0,numItems),
+        // where the threads fetch the subranges of blockSize items in order.
+        // The threads are tasks of the scheduler when it is not null.
+        template <typename Function>
+        static void Execute(size_t numThreads, TaskScheduler* scheduler, size_t numItems,
+            Function const& function, size_t blockSize = 1)
+        {
+            size_t const numBlocks = (numItems + blockSize - 1) / blockSize;
+            numThreads = std::min(numThreads, numBlocks);
+            if (numThreads <= 1)
+            {
+                function(0, numItems);
+                return;
+            }
+
+            TaskScheduler::ParallelForDynamic(scheduler, numBlocks, numThreads,
+                [&function, numItems, blockSize](size_t block)
+                {
+                    size_t begin = block * blockSize;
+                    function(begin, std::min(begin + blockSize, numItems));
+                });
+        }
+
+    private:
+        template <typename T, typename Operation>
+        static void ReduceLine(T const* input, int n, int radius, T const* exterior,
+            T* output, Operation const& operation)
+        {
+            std::copy(input, input + n, output);
+            for (int k = -radius; k <= radius; ++k)
+            {
+                if (k == 0)
+                {
+                    continue;
+                }
+
+                int const x0 = std::min(std::max(-k, 0), n);
+                int const x1 = std::max(std::min(n - k, n), x0);
+                for (int x = x0; x < x1; ++x)
+                {
+                    output[x] = operation(output[x], input[x + k]);
+                }
+
+                // The clamped values are in the range of offsets, so they
+                // do not change the output.
+                if (exterior)
+                {
+                    T const value = *exterior;
+                    for (int x = 0; x < x0; ++x)
+                    {
+                        output[x] = operation(output[x], value);
+                    }
+                    for (int x = x1; x < n; ++x)
+                    {
+                        output[x] = operation(output[x], value);
+                    }
+                }
+            }
+        }
+
+        template <typename T, typename Operation>
+        static void ReduceRows(T const* const* rows, int numRows, int n, T* output,
+            Operation const& operation)
+        {
+            LogAssert(numRows > 0, "Invalid input.");
+            std::copy(rows[0], rows[0] + n, output);
+            for (int k = 1; k < numRows; ++k)
+            {
+                T const* row = rows[k];
+                for (int x = 0; x < n; ++x)
+                {
+                    output[x] = operation(output[x], row[x]);
+                }
+            }
+        }
+    };
+}
@@ -0,0 +1,180 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+// A map with the interface of ThreadSafeMap whose elements are split among
+// NumShards std::map objects, each with its own mutex. A key is assigned
+// to a shard by its std::hash value, so threads that access different
+// keys usually lock different mutexes. The operations on a single key
+// lock one shard. HasElements, RemoveAll and GatherAll visit the shards
+// one at a time, so they are not atomic with respect to concurrent
+// Insert and Remove calls. GatherAll returns the values in key order
+// within each shard, not in key order over the entire map.
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace gte
+{
+    template <typename Key, typename Value, size_t NumShards = 16>
+    class ShardedMap
+    {
+    public:
+        static_assert(NumShards > 0, "The number of shards must be positive.");
+
+        // Construction and destruction.
+        ShardedMap() = default;
+        virtual ~ShardedMap() = default;
+
+        // All the operations are thread-safe.
+        bool HasElements() const
+        {
+            for (auto const& shard : mShards)
+            {
+                bool hasElements;
+                shard.mutex.lock();
+                {
+                    hasElements = (shard.map.size() > 0);
+                }
+                shard.mutex.unlock();
+                if (hasElements)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool Exists(Key key) const
+        {
+            Shard const& shard = GetShard(key);
+            bool exists;
+            shard.mutex.lock();
+            {
+                exists = (shard.map.find(key) != shard.map.end());
+            }
+            shard.mutex.unlock();
+            return exists;
+        }
+
+        void Insert(Key key, Value value)
+        {
+            Shard& shard = GetShard(key);
+            shard.mutex.lock();
+            {
+                shard.map[key] = value;
+            }
+            shard.mutex.unlock();
+        }
+
+        bool Remove(Key key, Value& value)
+        {
+            Shard& shard = GetShard(key);
+            bool exists;
+            shard.mutex.lock();
+            {
+                auto iter = shard.map.find(key);
+                if (iter != shard.map.end())
+                {
+                    value = iter->second;
+                    shard.map.erase(iter);
+                    exists = true;
+                }
+                else
+                {
+                    exists = false;
+                }
+            }
+            shard.mutex.unlock();
+            return exists;
+        }
+
+        void RemoveAll()
+        {
+            for (auto& shard : mShards)
+            {
+                shard.mutex.lock();
+                {
+                    shard.map.clear();
+                }
+                shard.mutex.unlock();
+            }
+        }
+
+        bool Get(Key key, Value& value) const
+        {
+            Shard const& shard = GetShard(key);
+            bool exists;
+            shard.mutex.lock();
+            {
+                auto iter = shard.map.find(key);
+                if (iter != shard.map.end())
+                {
+                    value = iter->second;
+                    exists = true;
+                }
+                else
+                {
+                    exists = false;
+                }
+            }
+            shard.mutex.unlock();
+            return exists;
+        }
+
+        void GatherAll(std::vector<Value>& values) const
+        {
+            values.clear();
+            for (auto const& shard : mShards)
+            {
+                shard.mutex.lock();
+                {
+                    for (auto const& m : shard.map)
+                    {
+                        values.push_back(m.second);
+                    }
+                }
+                shard.mutex.unlock();
+            }
+        }
+
+    protected:
+        struct Shard
+        {
+            std::map<Key, Value> map;
+            mutable std::mutex mutex;
+        };
+
+        // The hash of a pointer is its address for the common standard
+        // libraries, whose low-order bits are zero because of alignment.
+        // The high-order bits are folded into the low-order bits before
+        // the shard index is computed.
+        size_t GetShardIndex(Key const& key) const
+        {
+            size_t h = std::hash<Key>()(key);
+            h ^= (h >> 4) ^ (h >> 12) ^ (h >> 20);
+            return h % NumShards;
+        }
+
+        Shard& GetShard(Key const& key)
+        {
+            return mShards[GetShardIndex(key)];
+        }
+
+        Shard const& GetShard(Key const& key) const
+        {
+            return mShards[GetShardIndex(key)];
+        }
+
+        std::array<Shard, NumShards> mShards;
+    };
+}
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Minimax polynomial approximations to sin(x).  The polynomial p(x) of
 // degree D has only odd-power terms, is required to have linear term x,
@@ -41,25 +42,58 @@ namespace gte
             return Degree<D>(Reduce(x));
         }
 
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Evaluate(degree<D>(), x);
+        }
+
+        template <int D>
+        inline static SIMD4Value<Real> DegreeRR(SIMD4Value<Real> const& x)
+        {
+            return Degree<D>(Reduce(x));
+        }
+
+        // Evaluate the estimates for arrays, result[i] = Degree<D>(x[i]) or
+        // result[i] = DegreeRR<D>(x[i]), 4 elements at a time. The arrays
+        // may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
+        template <int D>
+        static void DegreeRR(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return DegreeRR<D>(v); });
+        }
+
     private:
         // Metaprogramming and private implementation to allow specialization
         // of a template member function.
         template <int D> struct degree {};
 
-        inline static Real Evaluate(degree<3>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<3>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_SIN_DEG3_C1;
             poly = (Real)GTE_C_SIN_DEG3_C0 + poly * xsqr;
             poly = poly * x;
             return poly;
         }
 
-        inline static Real Evaluate(degree<5>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<5>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_SIN_DEG5_C2;
             poly = (Real)GTE_C_SIN_DEG5_C1 + poly * xsqr;
             poly = (Real)GTE_C_SIN_DEG5_C0 + poly * xsqr;
@@ -67,10 +101,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<7>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<7>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_SIN_DEG7_C3;
             poly = (Real)GTE_C_SIN_DEG7_C2 + poly * xsqr;
             poly = (Real)GTE_C_SIN_DEG7_C1 + poly * xsqr;
@@ -79,10 +114,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<9>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<9>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_SIN_DEG9_C4;
             poly = (Real)GTE_C_SIN_DEG9_C3 + poly * xsqr;
             poly = (Real)GTE_C_SIN_DEG9_C2 + poly * xsqr;
@@ -92,10 +128,11 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<11>, Real x)
+        template <typename T>
+        inline static T Evaluate(degree<11>, T const& x)
         {
-            Real xsqr = x * x;
-            Real poly;
+            T xsqr = x * x;
+            T poly;
             poly = (Real)GTE_C_SIN_DEG11_C5;
             poly = (Real)GTE_C_SIN_DEG11_C4 + poly * xsqr;
             poly = (Real)GTE_C_SIN_DEG11_C3 + poly * xsqr;
@@ -132,5 +169,16 @@ namespace gte
             }
             return y;
         }
+
+        inline static SIMD4Value<Real> Reduce(SIMD4Value<Real> const& x)
+        {
+            typedef SIMD4Value<Real> V;
+            V quotient = (Real)GTE_C_INV_TWO_PI * x;
+            quotient = V::Truncate(V::Select(x < (Real)0,
+                quotient - (Real)0.5, quotient + (Real)0.5));
+            V y = x - (Real)GTE_C_TWO_PI * quotient;
+            return V::Select((Real)GTE_C_HALF_PI < y, (Real)GTE_C_PI - y,
+                V::Select(y < (Real)-GTE_C_HALF_PI, (Real)-GTE_C_PI - y, y));
+        }
     };
 }
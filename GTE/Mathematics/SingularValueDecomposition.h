@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -105,6 +105,11 @@
 // Householder reflections and Givens rotations to obtain the orthogonal
 // matrices of the decomposigion, and comperr is the computation E =
 // U^T*A*V - S.
+//
+// For MxN matrices with M much larger than N, use
+// SingularValueDecompositionThin, which computes the MxN matrix U of the
+// thin decomposition instead of the MxM matrix U, with a blocked QR
+// factorization that reduces the problem to an NxN matrix.
 
 namespace gte
 {
@@ -0,0 +1,330 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BlockedMatrixProduct.h>
+#include <Mathematics/SingularValueDecomposition.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// The thin singular value decomposition A = U*S*V^T of an MxN matrix A with
+// M >= N, where U is MxN with orthonormal columns, S is NxN diagonal and V
+// is NxN orthogonal. This is the decomposition needed for principal
+// component analysis and least squares, where M is the number of samples
+// and can be much larger than N. SingularValueDecomposition computes the
+// MxM matrix U, which is not feasible for large M.
+//
+// The algorithm is that of
+//   T.F. Chan, An improved algorithm for computing the singular value
+//   decomposition, ACM Transactions on Mathematical Software 8 (1982),
+//   72-83
+// A is factored as A = Q*R with Householder reflections, where Q is MxN
+// with orthonormal columns and R is NxN upper triangular, and then
+// SingularValueDecomposition computes R = U'*S*V^T, so U = Q*U'. For M much
+// larger than N, the QR factorization is most of the work. It is blocked:
+// the reflections of a panel of BLOCK_SIZE columns are combined into the
+// compact WY form I - Y*T*Y^T of
+//   R. Schreiber and C. Van Loan, A storage-efficient WY representation for
+//   products of Householder transformations, SIAM Journal on Scientific and
+//   Statistical Computing 10 (1989), 53-57
+// and applied to the remaining columns with the matrix products of
+// BlockedMatrixProduct, which are distributed over numThreads threads. The
+// product Q*U' is computed the same way, and only when GetU is called.
+// The results do not depend on the number of threads.
+
+namespace gte
+{
+    template <typename Real>
+    class SingularValueDecompositionThin
+    {
+    public:
+        // The number of columns of a panel of the blocked QR factorization.
+        enum { BLOCK_SIZE = 32 };
+
+        // The solver processes MxN matrices with M >= N > 1 ('numRows' is
+        // M and 'numCols' is N) stored in row-major order. The maximum
+        // number of iterations is that of SingularValueDecomposition.
+        SingularValueDecompositionThin(int numRows, int numCols,
+            unsigned int maxIterations, size_t numThreads = 1)
+            :
+            mNumRows(0),
+            mNumCols(0),
+            mNumThreads(std::max(numThreads, static_cast<size_t>(1))),
+            mSVD(numCols, numCols, maxIterations)
+        {
+            if (numCols > 1 && numRows >= numCols && maxIterations > 0)
+            {
+                mNumRows = numRows;
+                mNumCols = numCols;
+                mQR.resize(static_cast<size_t>(numRows) * static_cast<size_t>(numCols));
+                size_t numPanels = static_cast<size_t>((numCols + BLOCK_SIZE - 1) / BLOCK_SIZE);
+                mT.resize(numPanels * BLOCK_SIZE * BLOCK_SIZE);
+            }
+        }
+
+        // The order of the singular values is specified by sortType: -1
+        // (decreasing), 0 (no sorting) or +1 (increasing). The return value
+        // is that of SingularValueDecomposition::Solve for R.
+        unsigned int Solve(Real const* input, int sortType)
+        {
+            if (mNumRows == 0)
+            {
+                return 0;
+            }
+
+            int const M = mNumRows, N = mNumCols;
+
+            // The QR factorization is computed in column-major storage so
+            // that the columns are contiguous.
+            for (int r = 0; r < M; ++r)
+            {
+                Real const* row = input + static_cast<size_t>(r) * N;
+                for (int c = 0; c < N; ++c)
+                {
+                    mQR[r + static_cast<size_t>(c) * M] = row[c];
+                }
+            }
+            FactorQR();
+
+            std::vector<Real> R(static_cast<size_t>(N) * N, (Real)0);
+            for (int r = 0; r < N; ++r)
+            {
+                for (int c = r; c < N; ++c)
+                {
+                    R[static_cast<size_t>(r) * N + c] = mQR[r + static_cast<size_t>(c) * M];
+                }
+            }
+            return mSVD.Solve(R.data(), sortType);
+        }
+
+        // The singular values, N elements.
+        inline void GetSingularValues(Real* singularValues) const
+        {
+            mSVD.GetSingularValues(singularValues);
+        }
+
+        inline Real GetSingularValue(int index) const
+        {
+            return mSVD.GetSingularValue(index);
+        }
+
+        // The MxN matrix U stored in row-major order.
+        void GetU(Real* uMatrix) const
+        {
+            if (!uMatrix || mNumRows == 0)
+            {
+                return;
+            }
+
+            int const M = mNumRows, N = mNumCols;
+            std::vector<Real> uPrime(static_cast<size_t>(N) * N);
+            mSVD.GetU(uPrime.data());
+            std::copy(uPrime.begin(), uPrime.end(), uMatrix);
+            std::fill(uMatrix + static_cast<size_t>(N) * N, uMatrix + static_cast<size_t>(M) * N, (Real)0);
+
+            // U = Q*U' = Q_0*Q_1*...*Q_{b-1}*U', where Q_k = I - Y*T*Y^T is
+            // the product of the reflections of panel k. The rows of U
+            // before the panel are unchanged.
+            int const numPanels = (N + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            for (int panel = numPanels - 1; panel >= 0; --panel)
+            {
+                int const j0 = panel * BLOCK_SIZE;
+                int const nb = std::min(static_cast<int>(BLOCK_SIZE), N - j0);
+                ApplyBlockReflector(j0, nb, false, uMatrix + static_cast<size_t>(j0) * N, N, 1, N);
+            }
+        }
+
+        // The NxN matrix V stored in row-major order.
+        inline void GetV(Real* vMatrix) const
+        {
+            mSVD.GetV(vMatrix);
+        }
+
+    private:
+        // Factor the column-major MxN mQR as Q*R. On return, R is in the
+        // upper triangle and the essential parts of the Householder vectors
+        // (the elements after the leading 1) are below the diagonal. The
+        // upper triangular matrices T of the panels are in mT, the one of
+        // the panel at column j0 at mT[j0 * BLOCK_SIZE].
+        void FactorQR()
+        {
+            int const M = mNumRows, N = mNumCols;
+            std::vector<Real> tau(BLOCK_SIZE);
+            for (int j0 = 0; j0 < N; j0 += BLOCK_SIZE)
+            {
+                int const nb = std::min(static_cast<int>(BLOCK_SIZE), N - j0);
+
+                // Factor the panel with unblocked Householder reflections
+                // H = I - tau*v*v^T, where v[0] = 1.
+                for (int k = 0; k < nb; ++k)
+                {
+                    int const j = j0 + k;
+                    Real* x = &mQR[j + static_cast<size_t>(j) * M];
+                    int const m = M - j;
+                    tau[k] = MakeReflection(m, x);
+
+                    for (int c = j + 1; c < j0 + nb; ++c)
+                    {
+                        Real* y = &mQR[j + static_cast<size_t>(c) * M];
+                        Real dot = y[0];
+                        for (int i = 1; i < m; ++i)
+                        {
+                            dot += x[i] * y[i];
+                        }
+                        dot *= tau[k];
+                        y[0] -= dot;
+                        for (int i = 1; i < m; ++i)
+                        {
+                            y[i] -= dot * x[i];
+                        }
+                    }
+                }
+
+                // Compute T for H_0*...*H_{nb-1} = I - Y*T*Y^T, column by
+                // column with T(0:k,k) = -tau[k] * T(0:k,0:k) * Y(:,0:k)^T
+                // * y_k and T(k,k) = tau[k]. T is stored in row-major order.
+                Real* T = &mT[static_cast<size_t>(j0) * BLOCK_SIZE];
+                std::fill(T, T + static_cast<size_t>(BLOCK_SIZE) * BLOCK_SIZE, (Real)0);
+                std::vector<Real> z(nb);
+                for (int k = 0; k < nb; ++k)
+                {
+                    int const jk = j0 + k;
+                    Real const* yk = &mQR[static_cast<size_t>(jk) * M];
+                    for (int i = 0; i < k; ++i)
+                    {
+                        // Dot(y_i, y_k), where y_i[j0+i] = 1 and y_k is zero
+                        // before row jk with y_k[jk] = 1.
+                        Real const* yi = &mQR[static_cast<size_t>(j0 + i) * M];
+                        Real dot = yi[jk];
+                        for (int r = jk + 1; r < M; ++r)
+                        {
+                            dot += yi[r] * yk[r];
+                        }
+                        z[i] = dot;
+                    }
+                    for (int i = 0; i < k; ++i)
+                    {
+                        Real sum = (Real)0;
+                        for (int l = i; l < k; ++l)
+                        {
+                            sum += T[i * BLOCK_SIZE + l] * z[l];
+                        }
+                        T[i * BLOCK_SIZE + k] = -tau[k] * sum;
+                    }
+                    T[k * BLOCK_SIZE + k] = tau[k];
+                }
+
+                // Apply Q_k^T = I - Y*T^T*Y^T to the remaining columns.
+                int const c0 = j0 + nb;
+                if (c0 < N)
+                {
+                    ApplyBlockReflector(j0, nb, true, &mQR[j0 + static_cast<size_t>(c0) * M],
+                        1, M, N - c0);
+                }
+            }
+        }
+
+        // Compute the reflection H = I - tau*v*v^T with H*x = (beta,0,...,0)
+        // for the m elements of x. On return, x[0] is beta and x[1..m-1]
+        // are v[1..m-1] (v[0] = 1). The return value is tau, which is zero
+        // when x[1..m-1] is zero.
+        static Real MakeReflection(int m, Real* x)
+        {
+            Real sqrLength = (Real)0;
+            for (int i = 1; i < m; ++i)
+            {
+                sqrLength += x[i] * x[i];
+            }
+            if (sqrLength == (Real)0)
+            {
+                return (Real)0;
+            }
+
+            Real const alpha = x[0];
+            Real const length = std::sqrt(alpha * alpha + sqrLength);
+            Real const beta = (alpha >= (Real)0 ? -length : length);
+            Real const invDenom = (Real)1 / (alpha - beta);
+            for (int i = 1; i < m; ++i)
+            {
+                x[i] *= invDenom;
+            }
+            x[0] = beta;
+            return (beta - alpha) / beta;
+        }
+
+        // Compute C <- (I - Y*T*Y^T)*C, or C <- (I - Y*T^T*Y^T)*C when
+        // 'transpose' is 'true', where Y is the (M-j0)xnb matrix of the
+        // Householder vectors of the panel at column j0 and C is the
+        // (M-j0)xnumCols matrix with element (r,c) at C[r*rowStride +
+        // c*colStride], r = 0 the row j0 of the full matrix.
+        void ApplyBlockReflector(int j0, int nb, bool transpose, Real* C,
+            int rowStride, int colStride, int numCols) const
+        {
+            int const M = mNumRows;
+            int const m = M - j0;
+
+            // Copy Y with the implied ones and zeros; column-major with
+            // leading dimension m.
+            std::vector<Real> Y(static_cast<size_t>(m) * nb, (Real)0);
+            for (int k = 0; k < nb; ++k)
+            {
+                Real* y = &Y[static_cast<size_t>(k) * m];
+                Real const* source = &mQR[static_cast<size_t>(j0 + k) * M + j0];
+                y[k] = (Real)1;
+                std::copy(source + k + 1, source + m, y + k + 1);
+            }
+
+            // W = C^T*Y is numCols x nb, stored in row-major order.
+            std::vector<Real> W(static_cast<size_t>(numCols) * nb, (Real)0);
+            BlockedMatrixProduct<Real>::Execute(numCols, nb, m,
+                C, colStride, rowStride, Y.data(), 1, m, W.data(), nb, 1, mNumThreads);
+
+            // Z = -op(T)*W^T is nb x numCols, stored in row-major order.
+            Real const* T = &mT[static_cast<size_t>(j0) * BLOCK_SIZE];
+            std::vector<Real> Z(static_cast<size_t>(nb) * numCols);
+            for (int i = 0; i < nb; ++i)
+            {
+                for (int c = 0; c < numCols; ++c)
+                {
+                    Real const* w = &W[static_cast<size_t>(c) * nb];
+                    Real sum = (Real)0;
+                    if (transpose)
+                    {
+                        for (int l = 0; l <= i; ++l)
+                        {
+                            sum += T[l * BLOCK_SIZE + i] * w[l];
+                        }
+                    }
+                    else
+                    {
+                        for (int l = i; l < nb; ++l)
+                        {
+                            sum += T[i * BLOCK_SIZE + l] * w[l];
+                        }
+                    }
+                    Z[static_cast<size_t>(i) * numCols + c] = -sum;
+                }
+            }
+
+            // C <- C + Y*Z.
+            BlockedMatrixProduct<Real>::Execute(m, numCols, nb,
+                Y.data(), 1, m, Z.data(), numCols, 1, C, rowStride, colStride, mNumThreads);
+        }
+
+        int mNumRows, mNumCols;
+        size_t mNumThreads;
+
+        // The QR factorization in column-major order and the T matrices of
+        // its panels.
+        std::vector<Real> mQR, mT;
+
+        // The decomposition of R.
+        SingularValueDecomposition<Real> mSVD;
+    };
+}
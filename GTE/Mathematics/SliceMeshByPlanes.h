@@ -0,0 +1,324 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/EdgeKey.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Cross sections of a triangle mesh by many parallel planes Dot(N,X) = c,
+// for example the layers of a 3D print. SplitMeshByPlane classifies every
+// vertex and triangle of the mesh for each plane. SliceMeshByPlanes
+// computes the heights h = Dot(N,V) of the vertices and the height
+// intervals [hmin,hmax] of the triangles once, in the constructor. For a
+// set of plane constants, each triangle is assigned to the planes whose
+// constants are in its height interval by binary searches of the sorted
+// constants, and the triangles of each plane are stored contiguously, so
+// the work per plane is proportional to the number of triangles it
+// intersects. The planes are sliced independently and in parallel.
+//
+// The segment of a triangle and a plane is computed with the symbolic
+// perturbation that a vertex with h = c is above the plane, so every
+// triangle has 0 or 2 edges crossing the plane, a crossing edge having one
+// vertex below and one vertex above. An endpoint of a segment is the
+// intersection of a crossing edge with the plane, computed from the edge
+// vertices in increasing index order, so the triangles sharing the edge
+// compute the same point. The segments are linked into contours by
+// matching their edges in a hash table, which is exact and does not
+// compare floating-point endpoints. For a mesh whose triangles are
+// counterclockwise when viewed from outside the solid, the segments are
+// oriented so that the closed contours are counterclockwise when viewed
+// from the side of the planes to which N points, holes being clockwise.
+// Contours of meshes with boundary or nonmanifold edges can be open.
+
+namespace gte
+{
+    template <typename Real>
+    class SliceMeshByPlanes
+    {
+    public:
+        struct Contour
+        {
+            Contour()
+                :
+                points{},
+                edges{},
+                closed(false)
+            {
+            }
+
+            // The points of the contour and the mesh edges containing
+            // them, edges[i] the vertex indices of the edge containing
+            // points[i]. For a closed contour, the last point is connected
+            // to the first point, and the first point is not repeated.
+            std::vector<Vector3<Real>> points;
+            std::vector<EdgeKey<false>> edges;
+            bool closed;
+        };
+
+        // The mesh has numTriangles triangles, triangle t having vertices
+        // vertices[indices[3*t+j]] for 0 <= j <= 2. The normal N of the
+        // planes need not be unit length, in which case the plane
+        // constants are scaled by its length. The arrays must persist
+        // until the last slicing of the mesh.
+        SliceMeshByPlanes(size_t numVertices, Vector3<Real> const* vertices,
+            size_t numTriangles, int const* indices, Vector3<Real> const& normal)
+            :
+            mVertices(vertices),
+            mIndices(indices),
+            mHeights(numVertices),
+            mIntervals(numTriangles)
+        {
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                mHeights[v] = Dot(normal, vertices[v]);
+            }
+
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                int const* triangle = &indices[3 * t];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    LogAssert(triangle[j] >= 0 && static_cast<size_t>(triangle[j]) < numVertices,
+                        "Invalid index.");
+                }
+                Real h0 = mHeights[triangle[0]];
+                Real h1 = mHeights[triangle[1]];
+                Real h2 = mHeights[triangle[2]];
+                mIntervals[t][0] = std::min(std::min(h0, h1), h2);
+                mIntervals[t][1] = std::max(std::max(h0, h1), h2);
+            }
+        }
+
+        // Compute the contours of the planes Dot(N,X) = constants[k]. The
+        // constants need not be sorted, and contours[k] are the contours
+        // of the plane with constants[k]. The planes are partitioned into
+        // numThreads ranges that are processed by the scheduler or, when
+        // it is null, by std::thread objects. For a scheduler, numThreads
+        // is replaced by the number of threads of the scheduler. The
+        // results do not depend on the number of threads.
+        void operator()(std::vector<Real> const& constants,
+            std::vector<std::vector<Contour>>& contours, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            size_t const numPlanes = constants.size();
+            contours.clear();
+            contours.resize(numPlanes);
+            if (numPlanes == 0)
+            {
+                return;
+            }
+
+            // Sort the plane constants. The triangle t intersects the
+            // planes sorted[k] for kmin <= k < kmax, where
+            // [kmin,kmax) is the range of the sorted constants in the
+            // height interval of the triangle.
+            std::vector<size_t> sorted(numPlanes);
+            std::iota(sorted.begin(), sorted.end(), static_cast<size_t>(0));
+            std::sort(sorted.begin(), sorted.end(),
+                [&constants](size_t k0, size_t k1) { return constants[k0] < constants[k1]; });
+            std::vector<Real> sortedConstants(numPlanes);
+            for (size_t k = 0; k < numPlanes; ++k)
+            {
+                sortedConstants[k] = constants[sorted[k]];
+            }
+
+            // Store the triangles of each plane contiguously, the
+            // triangles of sorted plane k being
+            // triangles[offsets[k]] through triangles[offsets[k+1]-1] in
+            // increasing order.
+            size_t const numTriangles = mIntervals.size();
+            std::vector<std::array<size_t, 2>> ranges(numTriangles);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                ranges[t][0] = static_cast<size_t>(std::lower_bound(sortedConstants.begin(),
+                    sortedConstants.end(), mIntervals[t][0]) - sortedConstants.begin());
+                ranges[t][1] = static_cast<size_t>(std::upper_bound(sortedConstants.begin(),
+                    sortedConstants.end(), mIntervals[t][1]) - sortedConstants.begin());
+            }
+
+            std::vector<size_t> offsets(numPlanes + 1, 0);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                for (size_t k = ranges[t][0]; k < ranges[t][1]; ++k)
+                {
+                    ++offsets[k + 1];
+                }
+            }
+            for (size_t k = 0; k < numPlanes; ++k)
+            {
+                offsets[k + 1] += offsets[k];
+            }
+            std::vector<size_t> triangles(offsets[numPlanes]);
+            std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                for (size_t k = ranges[t][0]; k < ranges[t][1]; ++k)
+                {
+                    triangles[next[k]++] = t;
+                }
+            }
+
+            if (scheduler != nullptr)
+            {
+                numThreads = static_cast<size_t>(scheduler->GetNumThreads());
+            }
+            size_t const numChunks = std::max(std::min(numThreads, numPlanes),
+                static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, numPlanes, numChunks, &sorted, &sortedConstants, &offsets, &triangles,
+                &contours](size_t chunk)
+                {
+                    size_t const kmin = numPlanes * chunk / numChunks;
+                    size_t const kmax = numPlanes * (chunk + 1) / numChunks;
+                    std::vector<Segment> segments;
+                    for (size_t k = kmin; k < kmax; ++k)
+                    {
+                        Slice(sortedConstants[k], &triangles[offsets[k]],
+                            offsets[k + 1] - offsets[k], segments, contours[sorted[k]]);
+                    }
+                });
+        }
+
+        inline std::vector<Real> const& GetHeights() const
+        {
+            return mHeights;
+        }
+
+    private:
+        // A segment from the intersection of the plane with edge 0 to the
+        // intersection with edge 1.
+        struct Segment
+        {
+            std::array<EdgeKey<false>, 2> edges;
+        };
+
+        void Slice(Real c, size_t const* triangles, size_t numTriangles,
+            std::vector<Segment>& segments, std::vector<Contour>& contours) const
+        {
+            // Compute the segments. Edge <v[j],v[j+1]> crosses the plane
+            // from below to above when v[j] is below and v[j+1] is above.
+            // The triangles sharing a crossing edge traverse it in opposite
+            // directions, so the segment starting at the downward crossing
+            // and ending at the upward crossing is oriented consistently
+            // with the segments of the adjacent triangles.
+            segments.clear();
+            for (size_t i = 0; i < numTriangles; ++i)
+            {
+                int const* v = &mIndices[3 * triangles[i]];
+                std::array<bool, 3> above =
+                {
+                    mHeights[v[0]] >= c,
+                    mHeights[v[1]] >= c,
+                    mHeights[v[2]] >= c
+                };
+
+                Segment segment;
+                int found = 0;
+                for (int j0 = 0; j0 < 3; ++j0)
+                {
+                    int j1 = (j0 + 1) % 3;
+                    if (above[j0] && !above[j1])
+                    {
+                        segment.edges[0] = EdgeKey<false>(v[j0], v[j1]);
+                        found |= 1;
+                    }
+                    else if (!above[j0] && above[j1])
+                    {
+                        segment.edges[1] = EdgeKey<false>(v[j0], v[j1]);
+                        found |= 2;
+                    }
+                }
+                if (found == 3)
+                {
+                    segments.push_back(segment);
+                }
+            }
+
+            // Link the segments. The successor of a segment is the segment
+            // that starts at its final edge. For a nonmanifold edge shared
+            // by more than two triangles, the first segment starting at the
+            // edge is chosen.
+            size_t const numSegments = segments.size();
+            std::unordered_map<EdgeKey<false>, size_t, EdgeKey<false>, EdgeKey<false>> starts;
+            starts.reserve(numSegments);
+            for (size_t s = 0; s < numSegments; ++s)
+            {
+                starts.insert(std::make_pair(segments[s].edges[0], s));
+            }
+
+            size_t const invalid = std::numeric_limits<size_t>::max();
+            std::vector<size_t> successor(numSegments, invalid);
+            std::vector<bool> hasPredecessor(numSegments, false);
+            for (size_t s = 0; s < numSegments; ++s)
+            {
+                auto iter = starts.find(segments[s].edges[1]);
+                if (iter != starts.end() && !hasPredecessor[iter->second])
+                {
+                    successor[s] = iter->second;
+                    hasPredecessor[iter->second] = true;
+                }
+            }
+
+            // Traverse the open contours from their first segments and
+            // then the closed contours.
+            std::vector<bool> visited(numSegments, false);
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (size_t s = 0; s < numSegments; ++s)
+                {
+                    if (visited[s] || (pass == 0 && hasPredecessor[s]))
+                    {
+                        continue;
+                    }
+
+                    Contour contour;
+                    size_t current = s;
+                    AddPoint(c, segments[current].edges[0], contour);
+                    while (current != invalid && !visited[current])
+                    {
+                        visited[current] = true;
+                        AddPoint(c, segments[current].edges[1], contour);
+                        current = successor[current];
+                    }
+                    if (current == s)
+                    {
+                        // The final point duplicates the first point.
+                        contour.points.pop_back();
+                        contour.edges.pop_back();
+                        contour.closed = true;
+                    }
+                    contours.push_back(std::move(contour));
+                }
+            }
+        }
+
+        void AddPoint(Real c, EdgeKey<false> const& edge, Contour& contour) const
+        {
+            // EdgeKey<false> stores the vertex indices in increasing order.
+            int v0 = edge.V[0], v1 = edge.V[1];
+            Real t = (c - mHeights[v0]) / (mHeights[v1] - mHeights[v0]);
+            contour.points.push_back(mVertices[v0] + t * (mVertices[v1] - mVertices[v0]));
+            contour.edges.push_back(edge);
+        }
+
+        Vector3<Real> const* mVertices;
+        int const* mIndices;
+        std::vector<Real> mHeights;
+        std::vector<std::array<Real, 2>> mIntervals;
+    };
+}
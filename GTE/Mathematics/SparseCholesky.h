@@ -0,0 +1,874 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/CSRMatrix.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+#include <vector>
+
+// The sparse Cholesky factorization P*A*P^T = L*L^T of a symmetric positive
+// definite matrix A, where P is a fill-reducing permutation and L is lower
+// triangular. Factor computes the factorization once; Solve can then be
+// called for any number of right-hand sides. Both triangles of A must be
+// stored in the CSRMatrix (as created by its std::map constructor with
+// 'symmetric' set to 'true').
+//
+// The default permutation is a nested dissection ordering computed from
+// level structures of the adjacency graph of A. A connected subgraph is
+// split by the vertices of the middle level of a breadth-first search from
+// a pseudoperipheral vertex, which are ordered after the two parts, and the
+// parts are split recursively. This is effective for the graphs of meshes,
+// whose level structures have small levels. It is not effective for graphs
+// of small diameter, such as those of the normal equations of a bundle
+// adjustment where every point is adjacent to the cameras that observe it.
+// For these, the minimum degree ordering repeatedly eliminates a vertex of
+// smallest degree in the elimination graph, which orders the points before
+// the cameras. The elimination tree of the
+// permuted matrix is then postordered, so the columns of L with the same
+// structure (the fundamental supernodes) are consecutive.
+//
+// The numerical factorization is the left-looking supernodal algorithm in
+//   E.G. Ng and B.W. Peyton, Block sparse Cholesky algorithms on advanced
+//   uniprocessor computers, SIAM Journal on Scientific Computing 14 (1993),
+//   1034-1056
+// The columns of a supernode are stored as a dense column-major block with
+// the rows of the supernode structure, so the updates by descendant
+// supernodes and the factorization of a supernode are dense matrix
+// operations.
+
+namespace gte
+{
+    template <typename Real>
+    class SparseCholesky
+    {
+    public:
+        enum class Ordering
+        {
+            NATURAL,
+            NESTED_DISSECTION,
+            MINIMUM_DEGREE
+        };
+
+        SparseCholesky()
+            :
+            mNumRows(0)
+        {
+        }
+
+        // Compute the factorization. The return value is 'false' when A is
+        // not square or a pivot is not positive, in which case A is not
+        // positive definite (in floating-point arithmetic) and Solve must
+        // not be called.
+        bool Factor(CSRMatrix<Real> const& A, Ordering ordering = Ordering::NESTED_DISSECTION)
+        {
+            mNumRows = 0;
+            if (A.GetNumRows() != A.GetNumCols())
+            {
+                return false;
+            }
+
+            ComputeOrdering(A, ordering);
+            ComputeSymbolic(A);
+            if (!ComputeNumeric(A))
+            {
+                return false;
+            }
+            mNumRows = A.GetNumRows();
+            return true;
+        }
+
+        // Solve A*X = B for numRightHandSides right-hand sides, where
+        // column k of B has elements B[k * N + i] for 0 <= i < N and the
+        // same for X. The right-hand sides are solved together, so each
+        // block of L is traversed once for all of them. B and X may be the
+        // same array.
+        void Solve(int numRightHandSides, Real const* B, Real* X) const
+        {
+            LogAssert(mNumRows > 0 || mPermutation.empty(), "The matrix is not factored.");
+            int const N = mNumRows;
+            size_t const m = static_cast<size_t>(numRightHandSides);
+            std::vector<Real> Y(static_cast<size_t>(N) * m);
+            for (int i = 0; i < N; ++i)
+            {
+                for (size_t k = 0; k < m; ++k)
+                {
+                    Y[i * m + k] = B[k * N + mPermutation[i]];
+                }
+            }
+
+            // Solve L*Z = Y.
+            std::vector<Real> sum(m);
+            int const numSupernodes = static_cast<int>(mSuperStart.size()) - 1;
+            for (int s = 0; s < numSupernodes; ++s)
+            {
+                int const first = mSuperStart[s], numCols = mSuperStart[s + 1] - first;
+                int const* rows = &mSuperRows[mSuperRowOffsets[s]];
+                int const numRows = mSuperRowOffsets[s + 1] - mSuperRowOffsets[s];
+                Real const* block = &mValues[mSuperValueOffsets[s]];
+                for (int j = 0; j < numCols; ++j)
+                {
+                    Real const* column = block + static_cast<size_t>(j) * numRows;
+                    Real* y = &Y[(first + j) * m];
+                    Real const inverse = (Real)1 / column[j];
+                    for (size_t k = 0; k < m; ++k)
+                    {
+                        y[k] *= inverse;
+                    }
+                    for (int r = j + 1; r < numRows; ++r)
+                    {
+                        Real* target = &Y[rows[r] * m];
+                        Real const value = column[r];
+                        for (size_t k = 0; k < m; ++k)
+                        {
+                            target[k] -= value * y[k];
+                        }
+                    }
+                }
+            }
+
+            // Solve L^T*Y = Z.
+            for (int s = numSupernodes - 1; s >= 0; --s)
+            {
+                int const first = mSuperStart[s], numCols = mSuperStart[s + 1] - first;
+                int const* rows = &mSuperRows[mSuperRowOffsets[s]];
+                int const numRows = mSuperRowOffsets[s + 1] - mSuperRowOffsets[s];
+                Real const* block = &mValues[mSuperValueOffsets[s]];
+                for (int j = numCols - 1; j >= 0; --j)
+                {
+                    Real const* column = block + static_cast<size_t>(j) * numRows;
+                    Real* y = &Y[(first + j) * m];
+                    std::fill(sum.begin(), sum.end(), (Real)0);
+                    for (int r = j + 1; r < numRows; ++r)
+                    {
+                        Real const* source = &Y[rows[r] * m];
+                        Real const value = column[r];
+                        for (size_t k = 0; k < m; ++k)
+                        {
+                            sum[k] += value * source[k];
+                        }
+                    }
+                    Real const inverse = (Real)1 / column[j];
+                    for (size_t k = 0; k < m; ++k)
+                    {
+                        y[k] = (y[k] - sum[k]) * inverse;
+                    }
+                }
+            }
+
+            for (int i = 0; i < N; ++i)
+            {
+                for (size_t k = 0; k < m; ++k)
+                {
+                    X[k * N + mPermutation[i]] = Y[i * m + k];
+                }
+            }
+        }
+
+        // Solve A*X = B for one right-hand side.
+        inline void Solve(Real const* B, Real* X) const
+        {
+            Solve(1, B, X);
+        }
+
+        // Member access. The permutation satisfies P(i,j) = 1 when
+        // j = GetPermutation()[i].
+        inline int GetNumRows() const
+        {
+            return mNumRows;
+        }
+
+        inline std::vector<int> const& GetPermutation() const
+        {
+            return mPermutation;
+        }
+
+        inline int GetNumSupernodes() const
+        {
+            return static_cast<int>(mSuperStart.size()) - 1;
+        }
+
+        // The number of nonzero entries of L, including the diagonal.
+        size_t GetNumNonzeros() const
+        {
+            size_t numNonzeros = 0;
+            for (int s = 0; s + 1 < static_cast<int>(mSuperStart.size()); ++s)
+            {
+                size_t numCols = static_cast<size_t>(mSuperStart[s + 1] - mSuperStart[s]);
+                size_t numRows = static_cast<size_t>(mSuperRowOffsets[s + 1] - mSuperRowOffsets[s]);
+                numNonzeros += numCols * numRows - numCols * (numCols - 1) / 2;
+            }
+            return numNonzeros;
+        }
+
+    private:
+        // Subgraphs with at most this number of vertices are not dissected.
+        enum { ND_LEAF_SIZE = 64 };
+
+        // Compute mPermutation, where vertex mPermutation[i] of the graph
+        // of A is the i-th pivot, and mInvPermutation.
+        void ComputeOrdering(CSRMatrix<Real> const& A, Ordering ordering)
+        {
+            int const N = A.GetNumRows();
+            mPermutation.resize(N);
+            for (int i = 0; i < N; ++i)
+            {
+                mPermutation[i] = i;
+            }
+
+            if (ordering == Ordering::NESTED_DISSECTION)
+            {
+                NestedDissection(A);
+            }
+            else if (ordering == Ordering::MINIMUM_DEGREE)
+            {
+                MinimumDegree(A);
+            }
+
+            mInvPermutation.resize(N);
+            for (int i = 0; i < N; ++i)
+            {
+                mInvPermutation[mPermutation[i]] = i;
+            }
+        }
+
+        // Minimum degree ordering on the quotient graph. When a vertex v is
+        // eliminated, its neighbors in the elimination graph, which are its
+        // uneliminated adjacent vertices and the vertices of the elements
+        // adjacent to it, form a new element that absorbs those elements.
+        // The exact degrees of the neighbors are expensive to compute, so
+        // they are replaced by the upper bounds degree - 1 + |element| - 1,
+        // which are also bounded by the number of uneliminated vertices.
+        // Ties are broken by the smallest vertex index.
+        void MinimumDegree(CSRMatrix<Real> const& A)
+        {
+            int const N = A.GetNumRows();
+            auto const& offsets = A.GetRowOffsets();
+            auto const& columns = A.GetColumns();
+
+            std::vector<size_t> degree(N);
+            std::set<std::pair<size_t, int>> queue;
+            for (int i = 0; i < N; ++i)
+            {
+                degree[i] = offsets[static_cast<size_t>(i) + 1] - offsets[i];
+                queue.insert(std::make_pair(degree[i], i));
+            }
+
+            // Element v is the vertex v after its elimination.
+            std::vector<std::vector<int>> vertexElements(N), elementVertices(N);
+            std::vector<bool> eliminated(N, false), absorbed(N, false);
+            std::vector<int> mark(N, -1);
+            for (int k = 0; k < N; ++k)
+            {
+                int const v = queue.begin()->second;
+                queue.erase(queue.begin());
+                mPermutation[k] = v;
+                eliminated[v] = true;
+                mark[v] = k;
+
+                std::vector<int> element;
+                for (size_t e = offsets[v]; e < offsets[static_cast<size_t>(v) + 1]; ++e)
+                {
+                    int const j = columns[e];
+                    if (!eliminated[j] && mark[j] != k)
+                    {
+                        mark[j] = k;
+                        element.push_back(j);
+                    }
+                }
+                for (auto e : vertexElements[v])
+                {
+                    if (!absorbed[e])
+                    {
+                        for (auto j : elementVertices[e])
+                        {
+                            if (!eliminated[j] && mark[j] != k)
+                            {
+                                mark[j] = k;
+                                element.push_back(j);
+                            }
+                        }
+                        absorbed[e] = true;
+                        std::vector<int>().swap(elementVertices[e]);
+                    }
+                }
+                std::vector<int>().swap(vertexElements[v]);
+
+                size_t const numRemaining = static_cast<size_t>(N) - k - 1;
+                for (auto i : element)
+                {
+                    vertexElements[i].push_back(v);
+                    queue.erase(std::make_pair(degree[i], i));
+                    degree[i] = std::min(degree[i] + element.size() - 2, numRemaining - 1);
+                    queue.insert(std::make_pair(degree[i], i));
+                }
+                elementVertices[v] = std::move(element);
+            }
+        }
+
+        void NestedDissection(CSRMatrix<Real> const& A)
+        {
+            int const N = A.GetNumRows();
+            auto const& offsets = A.GetRowOffsets();
+            auto const& columns = A.GetColumns();
+
+            // A subgraph is a range of vertices in 'vertices', which are
+            // ordered in the same range of mPermutation. The vertices of the
+            // subgraph being processed have 'part' equal to its index.
+            struct Subgraph
+            {
+                int begin, end;
+            };
+
+            std::vector<int> vertices(mPermutation), part(N, 0), level(N, -1);
+            std::vector<int> queue(N), levelStart;
+            std::vector<Subgraph> stack;
+            stack.push_back({ 0, N });
+            int numParts = 1;
+            while (stack.size() > 0)
+            {
+                Subgraph subgraph = stack.back();
+                stack.pop_back();
+                int const size = subgraph.end - subgraph.begin;
+                int const* sub = &vertices[subgraph.begin];
+                int const id = part[sub[0]];
+
+                auto BreadthFirstSearch = [&](int root)
+                {
+                    // Compute the level structure rooted at 'root' in
+                    // 'queue', with level L the vertices at indices
+                    // levelStart[L] <= i < levelStart[L+1]. The return
+                    // value is the number of vertices reached.
+                    for (int i = 0; i < size; ++i)
+                    {
+                        level[sub[i]] = -1;
+                    }
+                    levelStart.clear();
+                    levelStart.push_back(0);
+                    int numQueued = 1;
+                    queue[0] = root;
+                    level[root] = 0;
+                    for (int i = 0; i < numQueued; ++i)
+                    {
+                        int v = queue[i];
+                        if (level[v] == static_cast<int>(levelStart.size()))
+                        {
+                            levelStart.push_back(i);
+                        }
+                        for (size_t j = offsets[v]; j < offsets[static_cast<size_t>(v) + 1]; ++j)
+                        {
+                            int w = columns[j];
+                            if (part[w] == id && level[w] == -1)
+                            {
+                                level[w] = level[v] + 1;
+                                queue[numQueued++] = w;
+                            }
+                        }
+                    }
+                    levelStart.push_back(numQueued);
+                    return numQueued;
+                };
+
+                if (size <= ND_LEAF_SIZE)
+                {
+                    std::copy(sub, sub + size, &mPermutation[subgraph.begin]);
+                    continue;
+                }
+
+                // Split off a connected component when the subgraph is not
+                // connected.
+                int numReached = BreadthFirstSearch(sub[0]);
+                if (numReached < size)
+                {
+                    int const componentId = numParts++;
+                    int const restId = numParts++;
+                    int* out = &vertices[subgraph.begin];
+                    int numRest = 0;
+                    for (int i = 0; i < size; ++i)
+                    {
+                        int v = sub[i];
+                        if (level[v] == -1)
+                        {
+                            queue[numReached + numRest++] = v;
+                            part[v] = restId;
+                        }
+                        else
+                        {
+                            part[v] = componentId;
+                        }
+                    }
+                    std::copy(queue.begin(), queue.begin() + size, out);
+                    stack.push_back({ subgraph.begin, subgraph.begin + numReached });
+                    stack.push_back({ subgraph.begin + numReached, subgraph.end });
+                    continue;
+                }
+
+                // Find a pseudoperipheral vertex, repeating the search from
+                // a vertex of minimum degree in the last level while the
+                // number of levels increases.
+                int root = sub[0];
+                int numLevels = static_cast<int>(levelStart.size()) - 1;
+                for (int trial = 0; trial < 8; ++trial)
+                {
+                    int candidate = -1;
+                    size_t minDegree = static_cast<size_t>(-1);
+                    for (int i = levelStart[numLevels - 1]; i < levelStart[numLevels]; ++i)
+                    {
+                        int v = queue[i];
+                        size_t degree = offsets[static_cast<size_t>(v) + 1] - offsets[v];
+                        if (degree < minDegree)
+                        {
+                            minDegree = degree;
+                            candidate = v;
+                        }
+                    }
+                    BreadthFirstSearch(candidate);
+                    int candidateLevels = static_cast<int>(levelStart.size()) - 1;
+                    if (candidateLevels <= numLevels)
+                    {
+                        BreadthFirstSearch(root);
+                        break;
+                    }
+                    root = candidate;
+                    numLevels = candidateLevels;
+                }
+
+                if (numLevels < 3)
+                {
+                    std::copy(sub, sub + size, &mPermutation[subgraph.begin]);
+                    continue;
+                }
+
+                // The separator is the set of vertices of the middle level
+                // that are adjacent to the next level. The other vertices
+                // of the middle level join the first part.
+                int middle = 1;
+                while (middle < numLevels - 2 && levelStart[middle + 1] <= size / 2)
+                {
+                    ++middle;
+                }
+
+                int const firstId = numParts++;
+                int const secondId = numParts++;
+                int numFirst = 0, numSeparator = 0, numSecond = 0;
+                int* out = &vertices[subgraph.begin];
+                for (int i = 0; i < size; ++i)
+                {
+                    int v = queue[i];
+                    int lv = level[v];
+                    if (lv < middle)
+                    {
+                        part[v] = firstId;
+                    }
+                    else if (lv > middle)
+                    {
+                        part[v] = secondId;
+                    }
+                    else
+                    {
+                        bool isSeparator = false;
+                        for (size_t j = offsets[v]; j < offsets[static_cast<size_t>(v) + 1]; ++j)
+                        {
+                            int w = columns[j];
+                            if (part[w] == id && level[w] == middle + 1)
+                            {
+                                isSeparator = true;
+                                break;
+                            }
+                        }
+                        part[v] = (isSeparator ? -1 : firstId);
+                    }
+                }
+                for (int i = 0; i < size; ++i)
+                {
+                    int v = queue[i];
+                    if (part[v] == firstId)
+                    {
+                        ++numFirst;
+                    }
+                    else if (part[v] == secondId)
+                    {
+                        ++numSecond;
+                    }
+                    else
+                    {
+                        ++numSeparator;
+                    }
+                }
+
+                int iFirst = 0, iSecond = numFirst, iSeparator = numFirst + numSecond;
+                for (int i = 0; i < size; ++i)
+                {
+                    int v = queue[i];
+                    if (part[v] == firstId)
+                    {
+                        out[iFirst++] = v;
+                    }
+                    else if (part[v] == secondId)
+                    {
+                        out[iSecond++] = v;
+                    }
+                    else
+                    {
+                        out[iSeparator++] = v;
+                        part[v] = -1;
+                    }
+                }
+
+                int const separatorBegin = subgraph.begin + numFirst + numSecond;
+                std::copy(out + numFirst + numSecond, out + size, &mPermutation[separatorBegin]);
+                if (numFirst > 0)
+                {
+                    stack.push_back({ subgraph.begin, subgraph.begin + numFirst });
+                }
+                if (numSecond > 0)
+                {
+                    stack.push_back({ subgraph.begin + numFirst, separatorBegin });
+                }
+            }
+        }
+
+        // Compute the elimination tree of P*A*P^T with the algorithm of
+        // J.W.H. Liu, where parent[j] = -1 for a root.
+        void ComputeEliminationTree(CSRMatrix<Real> const& A, std::vector<int>& parent) const
+        {
+            int const N = A.GetNumRows();
+            auto const& offsets = A.GetRowOffsets();
+            auto const& columns = A.GetColumns();
+            std::vector<int> ancestor(N, -1);
+            parent.assign(N, -1);
+            for (int k = 0; k < N; ++k)
+            {
+                int v = mPermutation[k];
+                for (size_t j = offsets[v]; j < offsets[static_cast<size_t>(v) + 1]; ++j)
+                {
+                    int i = mInvPermutation[columns[j]];
+                    while (i != -1 && i < k)
+                    {
+                        int next = ancestor[i];
+                        ancestor[i] = k;
+                        if (next == -1)
+                        {
+                            parent[i] = k;
+                        }
+                        i = next;
+                    }
+                }
+            }
+        }
+
+        void ComputeSymbolic(CSRMatrix<Real> const& A)
+        {
+            int const N = A.GetNumRows();
+            auto const& offsets = A.GetRowOffsets();
+            auto const& columns = A.GetColumns();
+
+            // Postorder the elimination tree and compose the postorder with
+            // the permutation. The children of a node are visited in
+            // increasing order, so a postordered tree is unchanged.
+            std::vector<int> parent;
+            ComputeEliminationTree(A, parent);
+            std::vector<int> childHead(N, -1), childNext(N, -1), postorder, stack;
+            postorder.reserve(N);
+            for (int j = N - 1; j >= 0; --j)
+            {
+                if (parent[j] != -1)
+                {
+                    childNext[j] = childHead[parent[j]];
+                    childHead[parent[j]] = j;
+                }
+            }
+            for (int root = 0; root < N; ++root)
+            {
+                if (parent[root] != -1)
+                {
+                    continue;
+                }
+                stack.push_back(root);
+                while (stack.size() > 0)
+                {
+                    int j = stack.back();
+                    int child = childHead[j];
+                    if (child == -1)
+                    {
+                        postorder.push_back(j);
+                        stack.pop_back();
+                    }
+                    else
+                    {
+                        childHead[j] = childNext[child];
+                        stack.push_back(child);
+                    }
+                }
+            }
+
+            std::vector<int> permutation(N);
+            for (int k = 0; k < N; ++k)
+            {
+                permutation[k] = mPermutation[postorder[k]];
+            }
+            mPermutation = std::move(permutation);
+            for (int k = 0; k < N; ++k)
+            {
+                mInvPermutation[mPermutation[k]] = k;
+            }
+            ComputeEliminationTree(A, parent);
+
+            // Compute the number of nonzero entries of each column of L
+            // from the row subtrees: the nonzero entries of row k of L are
+            // in the columns on the paths from the nonzero entries of row k
+            // of P*A*P^T to k in the elimination tree.
+            std::vector<int> count(N, 1), mark(N, -1), numChildren(N, 0);
+            for (int k = 0; k < N; ++k)
+            {
+                mark[k] = k;
+                if (parent[k] != -1)
+                {
+                    ++numChildren[parent[k]];
+                }
+                int v = mPermutation[k];
+                for (size_t j = offsets[v]; j < offsets[static_cast<size_t>(v) + 1]; ++j)
+                {
+                    for (int i = mInvPermutation[columns[j]]; i < k && mark[i] != k; i = parent[i])
+                    {
+                        ++count[i];
+                        mark[i] = k;
+                    }
+                }
+            }
+
+            // Partition the columns into fundamental supernodes: column j+1
+            // is in the supernode of column j when it is the only child of
+            // j+1 and the structure of column j is that of column j+1 with
+            // row j+1 added.
+            mSuperStart.clear();
+            mSuperStart.push_back(0);
+            for (int j = 1; j < N; ++j)
+            {
+                if (parent[j - 1] != j || count[j - 1] != count[j] + 1 || numChildren[j] != 1)
+                {
+                    mSuperStart.push_back(j);
+                }
+            }
+            mSuperStart.push_back(N);
+            int const numSupernodes = static_cast<int>(mSuperStart.size()) - 1;
+            mSupernode.resize(N);
+            for (int s = 0; s < numSupernodes; ++s)
+            {
+                std::fill(mSupernode.begin() + mSuperStart[s], mSupernode.begin() + mSuperStart[s + 1], s);
+            }
+
+            // The structure of a supernode is its columns followed by the
+            // rows below its last column in the columns of P*A*P^T and in
+            // the structures of its children.
+            std::vector<int> superChildHead(numSupernodes, -1), superChildNext(numSupernodes, -1);
+            for (int s = numSupernodes - 1; s >= 0; --s)
+            {
+                int p = parent[mSuperStart[s + 1] - 1];
+                if (p != -1)
+                {
+                    int ps = mSupernode[p];
+                    superChildNext[s] = superChildHead[ps];
+                    superChildHead[ps] = s;
+                }
+            }
+
+            mSuperRowOffsets.assign(1, 0);
+            mSuperValueOffsets.assign(1, 0);
+            mSuperRows.clear();
+            std::fill(mark.begin(), mark.end(), -1);
+            for (int s = 0; s < numSupernodes; ++s)
+            {
+                int const first = mSuperStart[s], last = mSuperStart[s + 1] - 1;
+                size_t const rowBegin = mSuperRows.size();
+                for (int j = first; j <= last; ++j)
+                {
+                    mSuperRows.push_back(j);
+                }
+                for (int j = first; j <= last; ++j)
+                {
+                    int v = mPermutation[j];
+                    for (size_t i = offsets[v]; i < offsets[static_cast<size_t>(v) + 1]; ++i)
+                    {
+                        int r = mInvPermutation[columns[i]];
+                        if (r > last && mark[r] != s)
+                        {
+                            mark[r] = s;
+                            mSuperRows.push_back(r);
+                        }
+                    }
+                }
+                for (int c = superChildHead[s]; c != -1; c = superChildNext[c])
+                {
+                    for (int i = mSuperRowOffsets[c]; i < mSuperRowOffsets[c + 1]; ++i)
+                    {
+                        int r = mSuperRows[i];
+                        if (r > last && mark[r] != s)
+                        {
+                            mark[r] = s;
+                            mSuperRows.push_back(r);
+                        }
+                    }
+                }
+                std::sort(mSuperRows.begin() + rowBegin + (last - first + 1), mSuperRows.end());
+
+                int const numRows = static_cast<int>(mSuperRows.size() - rowBegin);
+                LogAssert(numRows == count[first], "Unexpected supernode structure.");
+                mSuperRowOffsets.push_back(static_cast<int>(mSuperRows.size()));
+                mSuperValueOffsets.push_back(mSuperValueOffsets.back() +
+                    static_cast<size_t>(numRows) * static_cast<size_t>(last - first + 1));
+            }
+        }
+
+        bool ComputeNumeric(CSRMatrix<Real> const& A)
+        {
+            int const N = A.GetNumRows();
+            auto const& offsets = A.GetRowOffsets();
+            auto const& columns = A.GetColumns();
+            auto const& values = A.GetValues();
+            int const numSupernodes = static_cast<int>(mSuperStart.size()) - 1;
+            mValues.assign(mSuperValueOffsets.back(), (Real)0);
+
+            // The supernodes d that update supernode s are in a linked list
+            // (head[s], next[d]), where mSuperRows[position[d]] is the first
+            // row of d not yet used for an update, which is a column of s.
+            std::vector<int> head(numSupernodes, -1), next(numSupernodes, -1);
+            std::vector<int> position(numSupernodes), relative(N);
+            std::vector<Real> update;
+
+            for (int s = 0; s < numSupernodes; ++s)
+            {
+                int const first = mSuperStart[s], numCols = mSuperStart[s + 1] - first;
+                int const* rows = &mSuperRows[mSuperRowOffsets[s]];
+                int const numRows = mSuperRowOffsets[s + 1] - mSuperRowOffsets[s];
+                Real* block = &mValues[mSuperValueOffsets[s]];
+                for (int r = 0; r < numRows; ++r)
+                {
+                    relative[rows[r]] = r;
+                }
+
+                // Copy the lower triangle of the columns of P*A*P^T.
+                for (int j = 0; j < numCols; ++j)
+                {
+                    int v = mPermutation[first + j];
+                    Real* column = block + static_cast<size_t>(j) * numRows;
+                    for (size_t i = offsets[v]; i < offsets[static_cast<size_t>(v) + 1]; ++i)
+                    {
+                        int r = mInvPermutation[columns[i]];
+                        if (r >= first + j)
+                        {
+                            column[relative[r]] += values[i];
+                        }
+                    }
+                }
+
+                // Apply the updates of the descendant supernodes.
+                for (int d = head[s]; d != -1; )
+                {
+                    int const nextD = next[d];
+                    int const* dRows = &mSuperRows[mSuperRowOffsets[d]];
+                    int const dNumRows = mSuperRowOffsets[d + 1] - mSuperRowOffsets[d];
+                    int const dNumCols = mSuperStart[d + 1] - mSuperStart[d];
+                    Real const* dBlock = &mValues[mSuperValueOffsets[d]];
+                    int const p0 = position[d];
+                    int p1 = p0;
+                    while (p1 < dNumRows && dRows[p1] < first + numCols)
+                    {
+                        ++p1;
+                    }
+
+                    // update(r,c) = sum_k Ld(p0+r,k) * Ld(p0+c,k) for
+                    // 0 <= c < p1-p0 and c <= r < dNumRows-p0.
+                    int const m = dNumRows - p0, n = p1 - p0;
+                    update.assign(static_cast<size_t>(m) * n, (Real)0);
+                    for (int k = 0; k < dNumCols; ++k)
+                    {
+                        Real const* dColumn = dBlock + static_cast<size_t>(k) * dNumRows + p0;
+                        for (int c = 0; c < n; ++c)
+                        {
+                            Real const a = dColumn[c];
+                            Real* uColumn = &update[static_cast<size_t>(c) * m];
+                            for (int r = c; r < m; ++r)
+                            {
+                                uColumn[r] += dColumn[r] * a;
+                            }
+                        }
+                    }
+                    for (int c = 0; c < n; ++c)
+                    {
+                        Real* column = block + static_cast<size_t>(dRows[p0 + c] - first) * numRows;
+                        Real const* uColumn = &update[static_cast<size_t>(c) * m];
+                        for (int r = c; r < m; ++r)
+                        {
+                            column[relative[dRows[p0 + r]]] -= uColumn[r];
+                        }
+                    }
+
+                    position[d] = p1;
+                    if (p1 < dNumRows)
+                    {
+                        int target = mSupernode[dRows[p1]];
+                        next[d] = head[target];
+                        head[target] = d;
+                    }
+                    d = nextD;
+                }
+
+                // Factor the dense block.
+                for (int j = 0; j < numCols; ++j)
+                {
+                    Real* column = block + static_cast<size_t>(j) * numRows;
+                    if (!(column[j] > (Real)0))
+                    {
+                        return false;
+                    }
+                    Real const pivot = std::sqrt(column[j]);
+                    Real const inverse = (Real)1 / pivot;
+                    column[j] = pivot;
+                    for (int r = j + 1; r < numRows; ++r)
+                    {
+                        column[r] *= inverse;
+                    }
+                    for (int k = j + 1; k < numCols; ++k)
+                    {
+                        Real* target = block + static_cast<size_t>(k) * numRows;
+                        Real const a = column[k];
+                        for (int r = k; r < numRows; ++r)
+                        {
+                            target[r] -= column[r] * a;
+                        }
+                    }
+                }
+
+                if (numCols < numRows)
+                {
+                    position[s] = numCols;
+                    int target = mSupernode[rows[numCols]];
+                    next[s] = head[target];
+                    head[target] = s;
+                }
+            }
+            return true;
+        }
+
+        int mNumRows;
+        std::vector<int> mPermutation, mInvPermutation;
+
+        // Supernode s has columns mSuperStart[s] <= j < mSuperStart[s+1]
+        // and rows mSuperRows[i] for mSuperRowOffsets[s] <= i <
+        // mSuperRowOffsets[s+1]. Its values are a column-major block at
+        // mValues[mSuperValueOffsets[s]]. The supernode of column j is
+        // mSupernode[j].
+        std::vector<int> mSuperStart, mSuperRowOffsets, mSuperRows, mSupernode;
+        std::vector<size_t> mSuperValueOffsets;
+        std::vector<Real> mValues;
+    };
+}
@@ -0,0 +1,372 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/Image3.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// A 3D image stored as a grid of cubical bricks of B-by-B-by-B voxels,
+// where B = 2^brickBits. A brick is either constant, in which case only
+// its value is stored, or allocated, in which case its B^3 values are
+// stored in a pool shared by all bricks. A brick is allocated on demand by
+// the first Set call that differs from its constant value, and Compact()
+// releases the allocated bricks whose values became equal. The storage is
+// 4 bytes plus sizeof(PixelType) per brick plus B^3*sizeof(PixelType) per
+// allocated brick. For example, a 2048^3 mask of uint8_t with B = 16 has
+// 2^21 bricks, which require 10 MB when all are constant, compared to the
+// 8 GB of the dense Image3<uint8_t>.
+//
+// The read interface is that of Image3 (GetDimension, GetNumPixels,
+// GetIndex, GetCorners, operator() and operator[]), so the Image3-based
+// algorithms that only read pixels can be instantiated for SparseImage3.
+// The values are returned by value because a constant brick does not store
+// its voxels; use Set to modify a voxel. Reading through operator[]
+// converts the 1-dimensional index to coordinates, so operator() is the
+// faster accessor.
+
+namespace gte
+{
+    template <typename PixelType>
+    class SparseImage3
+    {
+    public:
+        // Construction. The dimensions must be positive and brickBits must
+        // be in {1,...,8}. All voxels have the value 'background'.
+        SparseImage3(int dimension0, int dimension1, int dimension2,
+            PixelType const& background = PixelType(), int brickBits = 4)
+            :
+            mDimensions{ dimension0, dimension1, dimension2 },
+            mBrickBits(brickBits),
+            mBrickSize(1 << brickBits),
+            mBrickMask((1 << brickBits) - 1),
+            mBrickVolume(static_cast<size_t>(1) << (3 * brickBits))
+        {
+            LogAssert(dimension0 > 0 && dimension1 > 0 && dimension2 > 0
+                && 1 <= brickBits && brickBits <= 8, "Invalid input.");
+
+            for (int d = 0; d < 3; ++d)
+            {
+                mNumBricks[d] = (mDimensions[d] + mBrickMask) >> mBrickBits;
+            }
+            size_t const numBricks = static_cast<size_t>(mNumBricks[0]) *
+                static_cast<size_t>(mNumBricks[1]) * static_cast<size_t>(mNumBricks[2]);
+            mSlots.resize(numBricks, -1);
+            mValues.resize(numBricks, background);
+        }
+
+        // Create a sparse copy of a dense image. The bricks whose values
+        // are all equal are constant.
+        SparseImage3(Image3<PixelType> const& image, int brickBits = 4)
+            :
+            SparseImage3(image.GetDimension(0), image.GetDimension(1),
+                image.GetDimension(2), image.GetNumPixels() > 0 ? image[0] : PixelType(),
+                brickBits)
+        {
+            for (int z = 0; z < mDimensions[2]; ++z)
+            {
+                for (int y = 0; y < mDimensions[1]; ++y)
+                {
+                    for (int x = 0; x < mDimensions[0]; ++x)
+                    {
+                        Set(x, y, z, image(x, y, z));
+                    }
+                }
+            }
+            Compact();
+        }
+
+        // Create a dense copy of the image.
+        void GetDense(Image3<PixelType>& image) const
+        {
+            image.Reconstruct(mDimensions[0], mDimensions[1], mDimensions[2]);
+            for (int z = 0; z < mDimensions[2]; ++z)
+            {
+                for (int y = 0; y < mDimensions[1]; ++y)
+                {
+                    for (int x = 0; x < mDimensions[0]; ++x)
+                    {
+                        image(x, y, z) = (*this)(x, y, z);
+                    }
+                }
+            }
+        }
+
+        // Member access.
+        inline int GetNumDimensions() const
+        {
+            return 3;
+        }
+
+        inline int GetDimension(int d) const
+        {
+            return mDimensions[d];
+        }
+
+        inline size_t GetNumPixels() const
+        {
+            return static_cast<size_t>(mDimensions[0]) *
+                static_cast<size_t>(mDimensions[1]) * static_cast<size_t>(mDimensions[2]);
+        }
+
+        inline int GetBrickBits() const
+        {
+            return mBrickBits;
+        }
+
+        inline int GetBrickSize() const
+        {
+            return mBrickSize;
+        }
+
+        inline int GetNumBricks(int d) const
+        {
+            return mNumBricks[d];
+        }
+
+        // The number of allocated bricks and the number of bytes of the
+        // storage, excluding the object itself.
+        inline size_t GetNumAllocatedBricks() const
+        {
+            return mPool.size() / mBrickVolume - mFreeSlots.size();
+        }
+
+        size_t GetNumBytes() const
+        {
+            return mSlots.size() * sizeof(int32_t) + mValues.size() * sizeof(PixelType)
+                + mPool.size() * sizeof(PixelType) + mFreeSlots.size() * sizeof(int32_t);
+        }
+
+        // Conversion between 1-dimensional indices and 3-dimensional
+        // coordinates, which use the lexicographical order of Image3.
+        inline size_t GetIndex(int x, int y, int z) const
+        {
+            return static_cast<size_t>(x) + static_cast<size_t>(mDimensions[0]) *
+                (static_cast<size_t>(y) + static_cast<size_t>(mDimensions[1]) * static_cast<size_t>(z));
+        }
+
+        inline std::array<int, 3> GetCoordinates(size_t index) const
+        {
+            std::array<int, 3> coord;
+            coord[0] = static_cast<int>(index % static_cast<size_t>(mDimensions[0]));
+            index /= static_cast<size_t>(mDimensions[0]);
+            coord[1] = static_cast<int>(index % static_cast<size_t>(mDimensions[1]));
+            coord[2] = static_cast<int>(index / static_cast<size_t>(mDimensions[1]));
+            return coord;
+        }
+
+        // The indices of the corners of the voxel (x,y,z), in the order of
+        // Image3::GetCorners.
+        void GetCorners(int x, int y, int z, std::array<size_t, 8>& nbr) const
+        {
+            size_t const index = GetIndex(x, y, z);
+            size_t const dim0 = static_cast<size_t>(mDimensions[0]);
+            size_t const dim01 = dim0 * static_cast<size_t>(mDimensions[1]);
+            nbr[0] = index;
+            nbr[1] = index + 1;
+            nbr[2] = index + dim0;
+            nbr[3] = index + dim0 + 1;
+            nbr[4] = index + dim01;
+            nbr[5] = index + dim01 + 1;
+            nbr[6] = index + dim01 + dim0;
+            nbr[7] = index + dim01 + dim0 + 1;
+        }
+
+        // Read the voxel values. The coordinates must be in the image.
+        inline PixelType operator() (int x, int y, int z) const
+        {
+            size_t const brick = GetBrick(x >> mBrickBits, y >> mBrickBits, z >> mBrickBits);
+            int32_t const slot = mSlots[brick];
+            if (slot < 0)
+            {
+                return mValues[brick];
+            }
+            return mPool[GetPoolIndex(slot, x, y, z)];
+        }
+
+        inline PixelType operator() (std::array<int, 3> const& coord) const
+        {
+            return (*this)(coord[0], coord[1], coord[2]);
+        }
+
+        inline PixelType operator[] (size_t i) const
+        {
+            return (*this)(GetCoordinates(i));
+        }
+
+        // Modify a voxel value, allocating its brick when the brick is
+        // constant with a different value.
+        void Set(int x, int y, int z, PixelType const& value)
+        {
+            size_t const brick = GetBrick(x >> mBrickBits, y >> mBrickBits, z >> mBrickBits);
+            int32_t slot = mSlots[brick];
+            if (slot < 0)
+            {
+                if (mValues[brick] == value)
+                {
+                    return;
+                }
+                slot = Allocate(brick);
+            }
+            mPool[GetPoolIndex(slot, x, y, z)] = value;
+        }
+
+        // Set all voxels to 'value', releasing all bricks.
+        void Fill(PixelType const& value)
+        {
+            std::fill(mSlots.begin(), mSlots.end(), -1);
+            std::fill(mValues.begin(), mValues.end(), value);
+            mPool.clear();
+            mFreeSlots.clear();
+        }
+
+        // Access to brick (bx,by,bz) with 0 <= bx < GetNumBricks(0), and so
+        // on. A constant brick has GetBrickData(...) == nullptr and value
+        // GetBrickValue(...). The voxel (x,y,z) of an allocated brick, with
+        // brick-relative coordinates (x,y,z) in [0,B)^3, is stored at
+        // index x + B*(y + B*z) of GetBrickData(...). The voxels of bricks
+        // on the maximum faces of the image that are outside the image are
+        // stored but not used.
+        inline bool IsConstantBrick(int bx, int by, int bz) const
+        {
+            return mSlots[GetBrick(bx, by, bz)] < 0;
+        }
+
+        inline PixelType GetBrickValue(int bx, int by, int bz) const
+        {
+            return mValues[GetBrick(bx, by, bz)];
+        }
+
+        PixelType const* GetBrickData(int bx, int by, int bz) const
+        {
+            int32_t const slot = mSlots[GetBrick(bx, by, bz)];
+            return (slot >= 0 ? &mPool[static_cast<size_t>(slot) * mBrickVolume] : nullptr);
+        }
+
+        // Make brick (bx,by,bz) constant with the specified value.
+        void SetBrickValue(int bx, int by, int bz, PixelType const& value)
+        {
+            size_t const brick = GetBrick(bx, by, bz);
+            Release(brick);
+            mValues[brick] = value;
+        }
+
+        // Release the allocated bricks whose voxels in the image all have
+        // the same value. The return value is the number of released
+        // bricks. The pool is not shrunk; its released slots are reused by
+        // later allocations.
+        size_t Compact()
+        {
+            size_t numReleased = 0;
+            for (int bz = 0; bz < mNumBricks[2]; ++bz)
+            {
+                for (int by = 0; by < mNumBricks[1]; ++by)
+                {
+                    for (int bx = 0; bx < mNumBricks[0]; ++bx)
+                    {
+                        size_t const brick = GetBrick(bx, by, bz);
+                        if (mSlots[brick] < 0)
+                        {
+                            continue;
+                        }
+
+                        int const x0 = bx << mBrickBits, y0 = by << mBrickBits, z0 = bz << mBrickBits;
+                        int const x1 = std::min(x0 + mBrickSize, mDimensions[0]);
+                        int const y1 = std::min(y0 + mBrickSize, mDimensions[1]);
+                        int const z1 = std::min(z0 + mBrickSize, mDimensions[2]);
+                        PixelType const value = (*this)(x0, y0, z0);
+                        bool isConstant = true;
+                        for (int z = z0; z < z1 && isConstant; ++z)
+                        {
+                            for (int y = y0; y < y1 && isConstant; ++y)
+                            {
+                                for (int x = x0; x < x1; ++x)
+                                {
+                                    if (!((*this)(x, y, z) == value))
+                                    {
+                                        isConstant = false;
+                                        break;
+                                    }
+                                }
+                            }
+                        }
+
+                        if (isConstant)
+                        {
+                            Release(brick);
+                            mValues[brick] = value;
+                            ++numReleased;
+                        }
+                    }
+                }
+            }
+            return numReleased;
+        }
+
+    private:
+        inline size_t GetBrick(int bx, int by, int bz) const
+        {
+            return static_cast<size_t>(bx) + static_cast<size_t>(mNumBricks[0]) *
+                (static_cast<size_t>(by) + static_cast<size_t>(mNumBricks[1]) * static_cast<size_t>(bz));
+        }
+
+        inline size_t GetPoolIndex(int32_t slot, int x, int y, int z) const
+        {
+            size_t const local = static_cast<size_t>(x & mBrickMask) +
+                (static_cast<size_t>(y & mBrickMask) << mBrickBits) +
+                (static_cast<size_t>(z & mBrickMask) << (2 * mBrickBits));
+            return static_cast<size_t>(slot) * mBrickVolume + local;
+        }
+
+        // Allocate storage for a constant brick, initialized to its value.
+        int32_t Allocate(size_t brick)
+        {
+            int32_t slot;
+            if (mFreeSlots.size() > 0)
+            {
+                slot = mFreeSlots.back();
+                mFreeSlots.pop_back();
+                std::fill(mPool.begin() + static_cast<size_t>(slot) * mBrickVolume,
+                    mPool.begin() + static_cast<size_t>(slot + 1) * mBrickVolume,
+                    mValues[brick]);
+            }
+            else
+            {
+                slot = static_cast<int32_t>(mPool.size() / mBrickVolume);
+                mPool.resize(mPool.size() + mBrickVolume, mValues[brick]);
+            }
+            mSlots[brick] = slot;
+            return slot;
+        }
+
+        void Release(size_t brick)
+        {
+            if (mSlots[brick] >= 0)
+            {
+                mFreeSlots.push_back(mSlots[brick]);
+                mSlots[brick] = -1;
+            }
+        }
+
+        std::array<int, 3> mDimensions;
+        int mBrickBits, mBrickSize, mBrickMask;
+        size_t mBrickVolume;
+        std::array<int, 3> mNumBricks;
+
+        // The pool slot of each brick, which is -1 for constant bricks, and
+        // the value of each constant brick.
+        std::vector<int32_t> mSlots;
+        std::vector<PixelType> mValues;
+
+        // The voxels of the allocated bricks, mBrickVolume per slot.
+        std::vector<PixelType> mPool;
+        std::vector<int32_t> mFreeSlots;
+    };
+}
@@ -0,0 +1,223 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Vector.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Insertion orders of points for incremental algorithms such as Delaunay
+// triangulation, where each insertion starts with a walk from the most
+// recently inserted simplex to the simplex containing the new point.
+//
+// SortHilbert sorts 2D or 3D points along a Hilbert curve on a grid with
+// 2^16 cells per dimension that covers the bounding box of the points, so
+// consecutive points are close to each other and the walks are short. The
+// sort is also useful for batches of point-location queries. BRIO computes a
+// biased randomized insertion order: the points are shuffled and
+// partitioned into rounds, the last round containing about half of the
+// points, the previous round about a quarter and so on. The points of each
+// round are sorted along the Hilbert curve. The randomization bounds the
+// expected size of the triangulation changes, which is not the case for a
+// purely spatial order, and the spatial sorting keeps the walks short. The
+// shuffling uses a fixed seed, so the order is reproducible.
+
+namespace gte
+{
+    class SpatialSort
+    {
+    public:
+        // The minimum number of points of a BRIO round. The first round has
+        // all remaining points when there are fewer.
+        static size_t constexpr minRoundSize = 64;
+
+        // Sort indices[begin..end-1] along the Hilbert curve of the points
+        // vertices[indices[i]].
+        template <int N, typename T>
+        static void SortHilbert(Vector<N, T> const* vertices, std::vector<size_t>& indices,
+            size_t begin, size_t end)
+        {
+            BoxExtreme vmin, vmax;
+            GetBoundingBox(vertices, indices, begin, end, vmin, vmax);
+            SortHilbert(vertices, indices, begin, end, vmin, vmax);
+        }
+
+        template <int N, typename T>
+        static void SortHilbert(Vector<N, T> const* vertices, std::vector<size_t>& indices)
+        {
+            SortHilbert(vertices, indices, 0, indices.size());
+        }
+
+        // Reorder the indices into a biased randomized insertion order of
+        // the points vertices[indices[i]].
+        template <int N, typename T>
+        static void BRIO(Vector<N, T> const* vertices, std::vector<size_t>& indices)
+        {
+            std::mt19937 mte(static_cast<std::mt19937::result_type>(indices.size()));
+            std::shuffle(indices.begin(), indices.end(), mte);
+
+            BoxExtreme vmin, vmax;
+            GetBoundingBox(vertices, indices, 0, indices.size(), vmin, vmax);
+
+            size_t end = indices.size();
+            for (size_t begin = end / 2; end > 0; begin /= 2)
+            {
+                if (begin < minRoundSize)
+                {
+                    begin = 0;
+                }
+                SortHilbert(vertices, indices, begin, end, vmin, vmax);
+                end = begin;
+            }
+        }
+
+        // The index of the cell (x,y) along the Hilbert curve of a
+        // 2^16-by-2^16 grid.
+        static uint64_t GetHilbertIndex(uint32_t x, uint32_t y)
+        {
+            uint64_t index = 0;
+            for (uint32_t s = (1u << 15); s > 0; s >>= 1)
+            {
+                uint32_t rx = ((x & s) > 0 ? 1u : 0u);
+                uint32_t ry = ((y & s) > 0 ? 1u : 0u);
+                index += static_cast<uint64_t>(s) * static_cast<uint64_t>(s) * ((3u * rx) ^ ry);
+
+                // Rotate the quadrant so that the curve is continuous.
+                if (ry == 0)
+                {
+                    if (rx == 1)
+                    {
+                        x = s - 1 - (x & (s - 1));
+                        y = s - 1 - (y & (s - 1));
+                    }
+                    std::swap(x, y);
+                }
+            }
+            return index;
+        }
+
+        // The index of the cell (x,y,z) along the Hilbert curve of a
+        // 2^16-by-2^16-by-2^16 grid. The coordinates are transformed to the
+        // transposed Hilbert index using the algorithm in
+        //   John Skilling, "Programming the Hilbert curve",
+        //   AIP Conference Proceedings 707, 381 (2004)
+        // and the bits of the transposed index are interleaved.
+        static uint64_t GetHilbertIndex(uint32_t x, uint32_t y, uint32_t z)
+        {
+            std::array<uint32_t, 3> X = { x, y, z };
+            uint32_t const M = (1u << 15);
+            for (uint32_t Q = M; Q > 1; Q >>= 1)
+            {
+                uint32_t P = Q - 1;
+                for (int i = 0; i < 3; ++i)
+                {
+                    if (X[i] & Q)
+                    {
+                        X[0] ^= P;
+                    }
+                    else
+                    {
+                        uint32_t t = (X[0] ^ X[i]) & P;
+                        X[0] ^= t;
+                        X[i] ^= t;
+                    }
+                }
+            }
+
+            // Gray encode.
+            X[1] ^= X[0];
+            X[2] ^= X[1];
+            uint32_t t = 0;
+            for (uint32_t Q = M; Q > 1; Q >>= 1)
+            {
+                if (X[2] & Q)
+                {
+                    t ^= Q - 1;
+                }
+            }
+            for (int i = 0; i < 3; ++i)
+            {
+                X[i] ^= t;
+            }
+
+            uint64_t index = 0;
+            for (int q = 15; q >= 0; --q)
+            {
+                for (int i = 0; i < 3; ++i)
+                {
+                    index = (index << 1) | ((X[i] >> q) & 1u);
+                }
+            }
+            return index;
+        }
+
+    private:
+        // The extremes of the bounding box. Only the first N components are
+        // used for N-dimensional points.
+        typedef std::array<double, 3> BoxExtreme;
+
+        static inline uint64_t GetHilbertIndex(std::array<uint32_t, 2> const& cell)
+        {
+            return GetHilbertIndex(cell[0], cell[1]);
+        }
+
+        static inline uint64_t GetHilbertIndex(std::array<uint32_t, 3> const& cell)
+        {
+            return GetHilbertIndex(cell[0], cell[1], cell[2]);
+        }
+
+        template <int N, typename T>
+        static void GetBoundingBox(Vector<N, T> const* vertices, std::vector<size_t> const& indices,
+            size_t begin, size_t end, BoxExtreme& vmin, BoxExtreme& vmax)
+        {
+            vmin.fill(std::numeric_limits<double>::max());
+            vmax.fill(-std::numeric_limits<double>::max());
+            for (size_t i = begin; i < end; ++i)
+            {
+                Vector<N, T> const& vertex = vertices[indices[i]];
+                for (int j = 0; j < N; ++j)
+                {
+                    double value = static_cast<double>(vertex[j]);
+                    vmin[j] = std::min(vmin[j], value);
+                    vmax[j] = std::max(vmax[j], value);
+                }
+            }
+        }
+
+        template <int N, typename T>
+        static void SortHilbert(Vector<N, T> const* vertices, std::vector<size_t>& indices,
+            size_t begin, size_t end, BoxExtreme const& vmin,
+            BoxExtreme const& vmax)
+        {
+            static_assert(N == 2 || N == 3, "Invalid dimension.");
+            std::vector<std::pair<uint64_t, size_t>> keys(end - begin);
+            for (size_t i = begin; i < end; ++i)
+            {
+                Vector<N, T> const& vertex = vertices[indices[i]];
+                std::array<uint32_t, N> cell;
+                for (int j = 0; j < N; ++j)
+                {
+                    double range = vmax[j] - vmin[j];
+                    double t = (range > 0.0 ? (static_cast<double>(vertex[j]) - vmin[j]) / range : 0.0);
+                    cell[j] = static_cast<uint32_t>(t * 65535.0);
+                }
+                keys[i - begin] = std::make_pair(GetHilbertIndex(cell), indices[i]);
+            }
+
+            std::sort(keys.begin(), keys.end());
+            for (size_t i = begin; i < end; ++i)
+            {
+                indices[i] = keys[i - begin].second;
+            }
+        }
+    };
+}
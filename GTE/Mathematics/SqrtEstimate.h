@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Math.h>
+#include <Mathematics/SIMD4.h>
 
 // Minimax polynomial approximations to sqrt(x).  The polynomial p(x) of
 // degree D minimizes the quantity maximum{|sqrt(x) - p(x)| : x in [1,2]}
@@ -46,31 +47,70 @@ namespace gte
             return result;
         }
 
+        // Evaluate the estimates in the 4 lanes of a SIMD4Value with the same
+        // input constraints as the scalar functions.
+        // The range reduction of the SIMD versions requires x to be a normal
+        // floating-point number.
+        template <int D>
+        inline static SIMD4Value<Real> Degree(SIMD4Value<Real> const& x)
+        {
+            return Evaluate(degree<D>(), x - (Real)1);
+        }
+
+        template <int D>
+        inline static SIMD4Value<Real> DegreeRR(SIMD4Value<Real> const& x)
+        {
+            SIMD4Value<Real> adj, y, p;
+            Reduce(x, adj, y, p);
+            SIMD4Value<Real> poly = Degree<D>(y);
+            return Combine(adj, poly, p);
+        }
+
+        // Evaluate the estimates for arrays, result[i] = Degree<D>(x[i]) or
+        // result[i] = DegreeRR<D>(x[i]), 4 elements at a time. The arrays
+        // may be the same.
+        template <int D>
+        static void Degree(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return Degree<D>(v); });
+        }
+
+        template <int D>
+        static void DegreeRR(size_t numElements, Real const* x, Real* result)
+        {
+            SIMD4Value<Real>::Apply(numElements, x, result,
+                [](SIMD4Value<Real> const& v) { return DegreeRR<D>(v); });
+        }
+
     private:
         // Metaprogramming and private implementation to allow specialization
         // of a template member function.
         template <int D> struct degree {};
 
-        inline static Real Evaluate(degree<1>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<1>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG1_C1;
             poly = (Real)GTE_C_SQRT_DEG1_C0 + poly * t;
             return poly;
         }
 
-        inline static Real Evaluate(degree<2>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<2>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG2_C2;
             poly = (Real)GTE_C_SQRT_DEG2_C1 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG2_C0 + poly * t;
             return poly;
         }
 
-        inline static Real Evaluate(degree<3>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<3>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG3_C3;
             poly = (Real)GTE_C_SQRT_DEG3_C2 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG3_C1 + poly * t;
@@ -78,9 +118,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<4>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<4>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG4_C4;
             poly = (Real)GTE_C_SQRT_DEG4_C3 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG4_C2 + poly * t;
@@ -89,9 +130,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<5>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<5>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG5_C5;
             poly = (Real)GTE_C_SQRT_DEG5_C4 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG5_C3 + poly * t;
@@ -101,9 +143,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<6>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<6>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG6_C6;
             poly = (Real)GTE_C_SQRT_DEG6_C5 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG6_C4 + poly * t;
@@ -114,9 +157,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<7>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<7>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG7_C7;
             poly = (Real)GTE_C_SQRT_DEG7_C6 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG7_C5 + poly * t;
@@ -128,9 +172,10 @@ namespace gte
             return poly;
         }
 
-        inline static Real Evaluate(degree<8>, Real t)
+        template <typename T>
+        inline static T Evaluate(degree<8>, T const& t)
         {
-            Real poly;
+            T poly;
             poly = (Real)GTE_C_SQRT_DEG8_C8;
             poly = (Real)GTE_C_SQRT_DEG8_C7 + poly * t;
             poly = (Real)GTE_C_SQRT_DEG8_C6 + poly * t;
@@ -157,5 +202,24 @@ namespace gte
         {
             return adj * std::ldexp(y, p);
         }
+
+        // The exponent p is stored as a floating-point number.
+        inline static void Reduce(SIMD4Value<Real> const& x, SIMD4Value<Real>& adj,
+            SIMD4Value<Real>& y, SIMD4Value<Real>& p)
+        {
+            typedef SIMD4Value<Real> V;
+            y = V::FrExp(x, p);  // y in [1/2,1)
+            y = (Real)2 * y;  // y in [1,2)
+            p = p - (Real)1;
+            V half = V::Floor((Real)0.5 * p);
+            adj = V::Select((Real)0 < p - (Real)2 * half, (Real)GTE_C_SQRT_2, (Real)1);
+            p = half;
+        }
+
+        inline static SIMD4Value<Real> Combine(SIMD4Value<Real> const& adj,
+            SIMD4Value<Real> const& y, SIMD4Value<Real> const& p)
+        {
+            return adj * SIMD4Value<Real>::LdExp(y, p);
+        }
     };
 }
@@ -0,0 +1,1113 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+// Streaming computation of the Delaunay triangulation of point sets that are
+// too large to be stored in memory, based on
+//     Martin Isenburg, Yuanxin Liu, Jonathan Shewchuk and Jack Snoeyink,
+//     "Streaming Computation of Delaunay Triangulations",
+//     ACM Transactions on Graphics, 25(3), 2006, pp. 1049-1056.
+// The bounding rectangle of the points is partitioned into a grid of cells.
+// The points are inserted in chunks, typically one or a few cells at a
+// time. Once all the points of a cell are inserted, the caller finalizes
+// the cell using FinalizeCell(x,y), which promises that no more points will
+// be inserted into the cell. A triangle is final when its circumscribed
+// disk is contained in the finalized cells and the region outside the
+// rectangle, because no point that is inserted later can be inside the
+// disk, so the triangle can no longer change. The final triangles are
+// passed to a callback, which can write them to a file, and they are
+// removed from memory. A vertex is removed from memory when all of its
+// triangles are final. The memory usage is proportional to the number of
+// triangles whose disks overlap cells that are not finalized, not to the
+// number of points. For a grid traversed row by row, this is about the
+// number of triangles in two rows of cells.
+//
+// The insertion algorithm and the exact predicates are those of
+// IncrementalDelaunay2. The triangulation starts with a supertriangle and
+// the corners of the rectangle, so the output is the Delaunay triangulation
+// of the points and the 4 corners; the triangles with a supertriangle
+// vertex are not reported. The input points must be strictly inside the
+// rectangle. The triangles are stored in index-based arrays whose slots
+// are reused, so the memory of the final triangles and vertices is
+// recycled by the later insertions.
+//
+// The global indices of the vertices passed to the callback are 3, 4, 5
+// and 6 for the rectangle corners (xmin,ymin), (xmax,ymin), (xmin,ymax) and
+// (xmax,ymax). The distinct inserted points have global indices 7, 8, ...
+// in the order of insertion.
+
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/HashCombine.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/SWInterval.h>
+#include <Mathematics/SpatialSort.h>
+#include <Mathematics/Vector2.h>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace gte
+{
+    // The input type must be 'float' or 'double'. The compute type is defined
+    // internally and has enough bits of precision to handle any
+    // floating-point inputs.
+    template <typename T>
+    class StreamingDelaunay2
+    {
+    public:
+        // The callback is passed the global indices and positions of the
+        // counterclockwise-ordered vertices of each final triangle.
+        using Callback = std::function<void(std::array<size_t, 3> const&,
+            std::array<Vector2<T>, 3> const&)>;
+
+        // Construction. The bounding rectangle for the input points is
+        // partitioned into numXCells-by-numYCells cells.
+        StreamingDelaunay2(T const& xMin, T const& yMin, T const& xMax, T const& yMax,
+            size_t numXCells, size_t numYCells, Callback const& callback)
+            :
+            mXMin(xMin),
+            mYMin(yMin),
+            mXMax(xMax),
+            mYMax(yMax),
+            mNumXCells(numXCells),
+            mNumYCells(numYCells),
+            mXScale(static_cast<T>(numXCells) / (xMax - xMin)),
+            mYScale(static_cast<T>(numYCells) / (yMax - yMin)),
+            mCallback(callback),
+            mFinished(false),
+            mCellFinalized(numXCells * numYCells, 0),
+            mWaiting(numXCells * numYCells),
+            mVertexIndexMap{},
+            mVertices{},
+            mIRVertices{},
+            mGlobalIndices{},
+            mNumVertexTriangles{},
+            mFreeVertices{},
+            mNextGlobalIndex(0),
+            mTriangles{},
+            mAdjacencies{},
+            mStamps{},
+            mMarks{},
+            mFreeTriangles{},
+            mNumTriangles(0),
+            mLastTriangle(invalid),
+            mMark(0),
+            mCRPool(maxNumCRPool),
+            mStack{},
+            mCavity{},
+            mBoundary{},
+            mNewTriangles{}
+        {
+            static_assert(
+                std::is_floating_point<T>::value,
+                "Invalid floating-point type.");
+
+            LogAssert(
+                mXMin < mXMax && mYMin < mYMax,
+                "Invalid bounding rectangle.");
+
+            LogAssert(
+                mNumXCells > 0 && mNumYCells > 0,
+                "Invalid number of cells.");
+
+            LogAssert(
+                static_cast<bool>(mCallback),
+                "Invalid callback.");
+
+            // Create the vertices for a supertriangle that contains the
+            // input rectangle and the vertices for the input rectangle. See
+            // the constructor of IncrementalDelaunay2.
+            T xDelta = mXMax - mXMin;
+            T yDelta = mYMax - mYMin;
+            T x0 = mXMin - xDelta;
+            T y0 = mYMin - yDelta;
+            T x1 = mXMin + static_cast<T>(5) * xDelta;
+            T y1 = y0;
+            T x2 = x0;
+            T y2 = mYMin + static_cast<T>(5) * yDelta;
+            std::array<Vector2<T>, 7> vertices
+            {
+                Vector2<T>{ x0, y0 },
+                Vector2<T>{ x1, y1 },
+                Vector2<T>{ x2, y2 },
+                Vector2<T>{ mXMin, mYMin },
+                Vector2<T>{ mXMax, mYMin },
+                Vector2<T>{ mXMin, mYMax },
+                Vector2<T>{ mXMax, mYMax }
+            };
+
+            for (auto const& vertex : vertices)
+            {
+                size_t v = CreateVertex(vertex);
+                mVertexIndexMap.emplace(vertex, v);
+            }
+
+            // Create the triangles formed by the supervertices and the
+            // input rectangle vertices.
+            std::array<std::array<size_t, 3>, 9> const triangles
+            { {
+                { 0, 5, 2 }, { 0, 3, 5 }, { 0, 4, 3 }, { 0, 1, 4 }, { 1, 6, 4 },
+                { 1, 2, 6 }, { 2, 5, 6 }, { 3, 4, 6 }, { 3, 6, 5 }
+            } };
+
+            std::map<std::pair<size_t, size_t>, size_t> edgeMap;
+            for (auto const& tri : triangles)
+            {
+                size_t t = CreateTriangle(tri[0], tri[1], tri[2]);
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    edgeMap.emplace(std::make_pair(tri[j], tri[(j + 1) % 3]), t);
+                }
+            }
+            for (size_t t = 0; t < triangles.size(); ++t)
+            {
+                auto const& tri = triangles[t];
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    auto iter = edgeMap.find(std::make_pair(tri[(j + 1) % 3], tri[j]));
+                    mAdjacencies[t][j] = (iter != edgeMap.end() ? iter->second : invalid);
+                }
+            }
+
+            // The triangles of the rectangle are the only ones that can be
+            // final. They wait for the finalization of the first cell.
+            mWaiting[0].push_back({ 7, mStamps[7] });
+            mWaiting[0].push_back({ 8, mStamps[8] });
+            mLastTriangle = 7;
+        }
+
+        ~StreamingDelaunay2() = default;
+
+        // Insert a point into the triangulation. It is required that the
+        // point be strictly inside the input rectangle and that its cell is
+        // not finalized; if it is not, an exception is thrown. If the point
+        // is already a vertex, its global index is returned; otherwise, the
+        // point is inserted and its new global index is returned.
+        size_t Insert(Vector2<T> const& position)
+        {
+            LogAssert(
+                !mFinished,
+                "The triangulation is finished.");
+
+            LogAssert(
+                mXMin < position[0] && position[0] < mXMax &&
+                mYMin < position[1] && position[1] < mYMax,
+                "The position is outside the domain specified in the constructor.");
+
+            size_t cell = GetYCell(position[1]) * mNumXCells + GetXCell(position[0]);
+            LogAssert(
+                mCellFinalized[cell] == 0,
+                "The cell of the position is finalized.");
+
+            auto iter = mVertexIndexMap.find(position);
+            if (iter != mVertexIndexMap.end())
+            {
+                return mGlobalIndices[iter->second];
+            }
+
+            size_t v = CreateVertex(position);
+            mVertexIndexMap.emplace(position, v);
+            Update(v, cell);
+            return mGlobalIndices[v];
+        }
+
+        // Insert a chunk of points into the triangulation. The requirements
+        // for the points are those of Insert(position). On return,
+        // indices[i] is the global index for positions[i]. The points are
+        // inserted in a biased randomized insertion order with the rounds
+        // sorted along a Hilbert curve; see SpatialSort.
+        void Insert(std::vector<Vector2<T>> const& positions, std::vector<size_t>& indices)
+        {
+            std::vector<size_t> order(positions.size());
+            std::iota(order.begin(), order.end(), 0);
+            SpatialSort::BRIO(positions.data(), order);
+
+            indices.resize(positions.size());
+            for (auto i : order)
+            {
+                indices[i] = Insert(positions[i]);
+            }
+        }
+
+        // Promise that no more points will be inserted into the cell (x,y).
+        // The triangles that become final are passed to the callback.
+        void FinalizeCell(size_t x, size_t y)
+        {
+            LogAssert(
+                x < mNumXCells && y < mNumYCells,
+                "Invalid cell.");
+
+            size_t cell = y * mNumXCells + x;
+            if (mCellFinalized[cell] != 0)
+            {
+                return;
+            }
+            mCellFinalized[cell] = 1;
+
+            // Each triangle that waits for the cell is either final or
+            // waits for another cell that its disk overlaps. The swap
+            // releases the memory of the list.
+            std::vector<std::pair<size_t, size_t>> waiting;
+            waiting.swap(mWaiting[cell]);
+            for (auto const& element : waiting)
+            {
+                size_t t = element.first;
+                if (mStamps[t] != element.second)
+                {
+                    // The triangle was removed by an insertion.
+                    continue;
+                }
+
+                size_t other = GetOverlappedCell(t);
+                if (other != invalid)
+                {
+                    mWaiting[other].push_back(element);
+                }
+                else
+                {
+                    FinalizeTriangle(t);
+                }
+            }
+        }
+
+        // Finalize all cells, which passes the remaining triangles to the
+        // callback. After this call, you cannot insert points.
+        void Finish()
+        {
+            for (size_t y = 0; y < mNumYCells; ++y)
+            {
+                for (size_t x = 0; x < mNumXCells; ++x)
+                {
+                    FinalizeCell(x, y);
+                }
+            }
+            mFinished = true;
+
+            // Only the triangles with a supervertex remain.
+            LogAssert(
+                mNumTriangles == 7,
+                "Unexpected condition.");
+        }
+
+        // Member access.
+        inline T GetXMin() const
+        {
+            return mXMin;
+        }
+
+        inline T GetYMin() const
+        {
+            return mYMin;
+        }
+
+        inline T GetXMax() const
+        {
+            return mXMax;
+        }
+
+        inline T GetYMax() const
+        {
+            return mYMax;
+        }
+
+        inline size_t GetNumXCells() const
+        {
+            return mNumXCells;
+        }
+
+        inline size_t GetNumYCells() const
+        {
+            return mNumYCells;
+        }
+
+        // Get the cell (x,y) containing the position. The cells are
+        // half-open, except the last cells in each dimension that contain
+        // the maximum rectangle edges.
+        void GetCell(Vector2<T> const& position, size_t& x, size_t& y) const
+        {
+            x = GetXCell(position[0]);
+            y = GetYCell(position[1]);
+        }
+
+        inline bool IsFinalized(size_t x, size_t y) const
+        {
+            return mCellFinalized[y * mNumXCells + x] != 0;
+        }
+
+        // The number of vertices and triangles currently in memory,
+        // including the supervertices and the triangles containing a
+        // supervertex.
+        inline size_t GetNumVertices() const
+        {
+            return mVertexIndexMap.size();
+        }
+
+        inline size_t GetNumTriangles() const
+        {
+            return mNumTriangles;
+        }
+
+        // The number of global indices that have been assigned, including
+        // the supervertices and the rectangle corners.
+        inline size_t GetNumGlobalIndices() const
+        {
+            return mNextGlobalIndex;
+        }
+
+    private:
+        // The minimum-size rational type of the input points.
+        static int32_t constexpr InputNumWords = std::is_same<T, float>::value ? 2 : 4;
+        using InputRational = BSNumber<UIntegerFP32<InputNumWords>>;
+        using IRVector = Vector2<InputRational>;
+
+        // The compute type used for exact sign classification.
+        static int32_t constexpr ComputeNumWords = std::is_same<T, float>::value ? 36 : 264;
+        using ComputeRational = BSNumber<UIntegerFP32<ComputeNumWords>>;
+
+        // The value 'invalid' is the adjacent of an edge of the
+        // supertriangle. The value 'finalized' is the adjacent of an edge shared
+        // with a final triangle that was removed from memory.
+        static size_t constexpr invalid = std::numeric_limits<size_t>::max();
+        static size_t constexpr finalized = invalid - 1;
+
+        template <typename IntegerType>
+        inline bool IsDelaunayTriangle(IntegerType v0, IntegerType v1, IntegerType v2) const
+        {
+            return v0 >= 3 && v1 >= 3 && v2 >= 3;
+        }
+
+        inline bool IsDelaunayTriangle(size_t t) const
+        {
+            auto const& tri = mTriangles[t];
+            return IsDelaunayTriangle(tri[0], tri[1], tri[2]);
+        }
+
+        // The cell mapping must be the same for the points and for the
+        // bounding boxes of the disks. The floating-point operations are
+        // nondecreasing functions of their inputs, so a point inside a box
+        // is in a cell between the cells of the box extremes.
+        size_t GetXCell(T const& x) const
+        {
+            T t = (x - mXMin) * mXScale;
+            if (!(t > static_cast<T>(0)))
+            {
+                return 0;
+            }
+            if (t >= static_cast<T>(mNumXCells))
+            {
+                return mNumXCells - 1;
+            }
+            return static_cast<size_t>(t);
+        }
+
+        size_t GetYCell(T const& y) const
+        {
+            T t = (y - mYMin) * mYScale;
+            if (!(t > static_cast<T>(0)))
+            {
+                return 0;
+            }
+            if (t >= static_cast<T>(mNumYCells))
+            {
+                return mNumYCells - 1;
+            }
+            return static_cast<size_t>(t);
+        }
+
+        // Return a cell that is not finalized and that is overlapped by the
+        // bounding box of the disk of triangle t. If there is no such cell,
+        // the triangle is final and 'invalid' is returned. The disk is
+        // computed with interval arithmetic, so the box contains the exact
+        // disk. For a nearly degenerate triangle, the box can be unbounded,
+        // in which case the triangle is final only after all cells are
+        // finalized.
+        size_t GetOverlappedCell(size_t t) const
+        {
+            auto const& tri = mTriangles[t];
+            Vector2<T> const& a = mVertices[tri[0]];
+            Vector2<T> const& b = mVertices[tri[1]];
+            Vector2<T> const& c = mVertices[tri[2]];
+
+            // The center relative to A is U = (ux,uy) and the radius is |U|.
+            auto bx = SWInterval<T>::Sub(b[0], a[0]);
+            auto by = SWInterval<T>::Sub(b[1], a[1]);
+            auto cx = SWInterval<T>::Sub(c[0], a[0]);
+            auto cy = SWInterval<T>::Sub(c[1], a[1]);
+            auto bsqr = bx * bx + by * by;
+            auto csqr = cx * cx + cy * cy;
+            auto det = static_cast<T>(2) * (bx * cy - by * cx);
+            auto ux = (cy * bsqr - by * csqr) / det;
+            auto uy = (bx * csqr - cx * bsqr) / det;
+            auto rsqr = ux * ux + uy * uy;
+            T radius = std::sqrt(rsqr[1]) * (static_cast<T>(1) +
+                static_cast<T>(4) * std::numeric_limits<T>::epsilon());
+
+            T xmin = ((ux - radius) + a[0])[0];
+            T xmax = ((ux + radius) + a[0])[1];
+            T ymin = ((uy - radius) + a[1])[0];
+            T ymax = ((uy + radius) + a[1])[1];
+            if (!(xmax > mXMin && xmin < mXMax && ymax > mYMin && ymin < mYMax))
+            {
+                // The box does not overlap the rectangle. This branch also
+                // handles NaN values, which cannot occur for triangles that
+                // are not degenerate.
+                if (std::isnan(xmin) || std::isnan(xmax) || std::isnan(ymin) || std::isnan(ymax))
+                {
+                    xmin = mXMin;
+                    xmax = mXMax;
+                    ymin = mYMin;
+                    ymax = mYMax;
+                }
+                else
+                {
+                    return invalid;
+                }
+            }
+
+            size_t x0 = GetXCell(xmin), x1 = GetXCell(xmax);
+            size_t y0 = GetYCell(ymin), y1 = GetYCell(ymax);
+            for (size_t y = y0; y <= y1; ++y)
+            {
+                for (size_t x = x0; x <= x1; ++x)
+                {
+                    size_t cell = y * mNumXCells + x;
+                    if (mCellFinalized[cell] == 0)
+                    {
+                        return cell;
+                    }
+                }
+            }
+            return invalid;
+        }
+
+        // Storage management for the vertices and triangles.
+        size_t CreateVertex(Vector2<T> const& position)
+        {
+            size_t v;
+            if (mFreeVertices.size() > 0)
+            {
+                v = mFreeVertices.back();
+                mFreeVertices.pop_back();
+                mVertices[v] = position;
+                mIRVertices[v] = IRVector{ position[0], position[1] };
+                mGlobalIndices[v] = mNextGlobalIndex++;
+                mNumVertexTriangles[v] = 0;
+            }
+            else
+            {
+                v = mVertices.size();
+                mVertices.push_back(position);
+                mIRVertices.push_back(IRVector{ position[0], position[1] });
+                mGlobalIndices.push_back(mNextGlobalIndex++);
+                mNumVertexTriangles.push_back(0);
+            }
+            return v;
+        }
+
+        size_t CreateTriangle(size_t v0, size_t v1, size_t v2)
+        {
+            size_t t;
+            if (mFreeTriangles.size() > 0)
+            {
+                t = mFreeTriangles.back();
+                mFreeTriangles.pop_back();
+                mTriangles[t] = { v0, v1, v2 };
+            }
+            else
+            {
+                t = mTriangles.size();
+                mTriangles.push_back({ v0, v1, v2 });
+                mAdjacencies.push_back({ invalid, invalid, invalid });
+                mStamps.push_back(0);
+                mMarks.push_back(0);
+            }
+            ++mNumVertexTriangles[v0];
+            ++mNumVertexTriangles[v1];
+            ++mNumVertexTriangles[v2];
+            ++mNumTriangles;
+            return t;
+        }
+
+        // The stamp of the slot is incremented so that the entries of the
+        // waiting lists for the removed triangle are ignored.
+        void RemoveTriangle(size_t t)
+        {
+            for (auto v : mTriangles[t])
+            {
+                if (--mNumVertexTriangles[v] == 0 && v >= 7)
+                {
+                    mVertexIndexMap.erase(mVertices[v]);
+                    mFreeVertices.push_back(v);
+                }
+            }
+            mTriangles[t][0] = invalid;
+            ++mStamps[t];
+            mFreeTriangles.push_back(t);
+            --mNumTriangles;
+        }
+
+        inline bool IsLive(size_t t) const
+        {
+            return t < mTriangles.size() && mTriangles[t][0] != invalid;
+        }
+
+        // Pass the final triangle t to the callback and remove it from
+        // memory.
+        void FinalizeTriangle(size_t t)
+        {
+            auto const& tri = mTriangles[t];
+            std::array<size_t, 3> indices =
+            {
+                mGlobalIndices[tri[0]], mGlobalIndices[tri[1]], mGlobalIndices[tri[2]]
+            };
+            std::array<Vector2<T>, 3> positions =
+            {
+                mVertices[tri[0]], mVertices[tri[1]], mVertices[tri[2]]
+            };
+            mCallback(indices, positions);
+
+            for (auto adj : mAdjacencies[t])
+            {
+                if (adj < finalized)
+                {
+                    for (auto& adjAdj : mAdjacencies[adj])
+                    {
+                        if (adjAdj == t)
+                        {
+                            adjAdj = finalized;
+                            break;
+                        }
+                    }
+                }
+            }
+            RemoveTriangle(t);
+        }
+
+        // Walk from triangle t toward the triangle containing the point at
+        // index p. The function returns 'false' when the walk reaches a
+        // final triangle.
+        bool Walk(size_t p, size_t& t) const
+        {
+            size_t const numSlots = mTriangles.size();
+            for (size_t k = 0; k < numSlots; ++k)
+            {
+                auto const& v = mTriangles[t];
+                size_t i0, i1, i2;
+                for (i0 = 1, i1 = 2, i2 = 0; i2 < 3; i0 = i1, i1 = i2++)
+                {
+                    if (ToLine(p, v[i0], v[i1]) > 0)
+                    {
+                        // Point p sees edge <v[i0],v[i1]> from outside the
+                        // triangle. The point is inside the rectangle, so
+                        // the edge is not an edge of the supertriangle.
+                        size_t adj = mAdjacencies[t][i0];
+                        if (adj >= finalized)
+                        {
+                            return false;
+                        }
+                        t = adj;
+                        break;
+                    }
+                }
+                if (i2 == 3)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Locate the triangle containing the point at index p in the cell.
+        // The walk starts at the most recently inserted triangle. The
+        // unfinalized region need not be convex, so the walk can reach a
+        // final triangle, in which case it is restarted from a triangle of
+        // the cell of p. As a last resort, all triangles are searched.
+        size_t GetContainingTriangle(size_t p, size_t cell) const
+        {
+            size_t t = mLastTriangle;
+            if (IsLive(t) && Walk(p, t))
+            {
+                return t;
+            }
+
+            auto const& waiting = mWaiting[cell];
+            for (auto iter = waiting.rbegin(); iter != waiting.rend(); ++iter)
+            {
+                if (mStamps[iter->first] == iter->second)
+                {
+                    t = iter->first;
+                    if (Walk(p, t))
+                    {
+                        return t;
+                    }
+                    break;
+                }
+            }
+
+            for (t = 0; t < mTriangles.size(); ++t)
+            {
+                if (IsLive(t) && IsDelaunayTriangle(t))
+                {
+                    auto const& v = mTriangles[t];
+                    if (ToTriangle(p, v[0], v[1], v[2]) <= 0)
+                    {
+                        return t;
+                    }
+                }
+            }
+
+            LogError(
+                "Unexpected condition.");
+        }
+
+        // Insert the point at index p in the cell into the triangulation.
+        void Update(size_t p, size_t cell)
+        {
+            size_t t = GetContainingTriangle(p, cell);
+
+            // Use a depth-first search for those triangles whose
+            // circumcircles contain point P. A triangle is marked with
+            // mMark when it is in the insertion polygon and with mMark + 1
+            // when it has been rejected.
+            mMark += 2;
+            mCavity.clear();
+            mStack.clear();
+            mStack.push_back(t);
+            mMarks[t] = mMark;
+            while (mStack.size() > 0)
+            {
+                size_t s = mStack.back();
+                mStack.pop_back();
+                mCavity.push_back(s);
+                for (auto adj : mAdjacencies[s])
+                {
+                    if (adj < finalized && mMarks[adj] != mMark && mMarks[adj] != mMark + 1)
+                    {
+                        auto const& v = mTriangles[adj];
+                        if (IsDelaunayTriangle(v[0], v[1], v[2]) &&
+                            ToCircumcircle(p, v[0], v[1], v[2]) <= 0)
+                        {
+                            // Point P is in the circumcircle.
+                            mMarks[adj] = mMark;
+                            mStack.push_back(adj);
+                        }
+                        else
+                        {
+                            mMarks[adj] = mMark + 1;
+                        }
+                    }
+                }
+            }
+
+            // Get the boundary edges of the insertion polygon and, for each
+            // edge, the outside triangle and the index of the edge in that
+            // triangle.
+            mBoundary.clear();
+            for (auto s : mCavity)
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    size_t adj = mAdjacencies[s][j];
+                    if (adj >= finalized || mMarks[adj] != mMark)
+                    {
+                        BoundaryEdge edge;
+                        edge.v0 = mTriangles[s][j];
+                        edge.v1 = mTriangles[s][(j + 1) % 3];
+                        edge.adj = adj;
+                        edge.adjEdge = 0;
+                        if (adj < finalized)
+                        {
+                            while (mAdjacencies[adj][edge.adjEdge] != s)
+                            {
+                                ++edge.adjEdge;
+                            }
+                        }
+                        mBoundary.push_back(edge);
+                    }
+                }
+            }
+
+            // The insertion polygon is replaced by the triangles formed by
+            // point P and the boundary edges. The triangles are created
+            // before the insertion polygon triangles are removed so that
+            // the reference counts of the boundary vertices do not reach
+            // zero.
+            mNewTriangles.clear();
+            size_t const numCavity = mCavity.size();
+            for (auto const& edge : mBoundary)
+            {
+                size_t u = CreateTriangle(p, edge.v0, edge.v1);
+                mAdjacencies[u][1] = edge.adj;
+                if (edge.adj < finalized)
+                {
+                    mAdjacencies[edge.adj][edge.adjEdge] = u;
+                }
+                mNewTriangles.emplace(edge.v0, u);
+                mWaiting[cell].push_back({ u, mStamps[u] });
+                mLastTriangle = u;
+            }
+            for (size_t i = 0; i < numCavity; ++i)
+            {
+                RemoveTriangle(mCavity[i]);
+            }
+
+            // Connect the new triangles. The triangle <P,V0,V1> shares its
+            // edge <V1,P> with the triangle <P,V1,V2>.
+            for (auto const& element : mNewTriangles)
+            {
+                size_t u = element.second;
+                auto iter = mNewTriangles.find(mTriangles[u][2]);
+                LogAssert(
+                    iter != mNewTriangles.end(),
+                    "Unexpected condition.");
+                mAdjacencies[u][2] = iter->second;
+                mAdjacencies[iter->second][0] = u;
+            }
+        }
+
+        static ComputeRational const& Copy(InputRational const& source,
+            ComputeRational& target)
+        {
+            target.SetSign(source.GetSign());
+            target.SetBiasedExponent(source.GetBiasedExponent());
+            target.GetUInteger().CopyFrom(source.GetUInteger());
+            return target;
+        }
+
+        // Given a line with origin V0 and direction <V0,V1> and a query
+        // point P, ToLine returns
+        //   +1, P on right of line
+        //   -1, P on left of line
+        //    0, P on the line
+        int32_t ToLine(size_t pIndex, size_t v0Index, size_t v1Index) const
+        {
+            // The expression tree has 13 nodes consisting of 6 input
+            // leaves and 7 compute nodes.
+
+            // Use interval arithmetic to determine the sign if possible.
+            Vector2<T> const& inP = mVertices[pIndex];
+            Vector2<T> const& inV0 = mVertices[v0Index];
+            Vector2<T> const& inV1 = mVertices[v1Index];
+
+            auto x0 = SWInterval<T>::Sub(inP[0], inV0[0]);
+            auto y0 = SWInterval<T>::Sub(inP[1], inV0[1]);
+            auto x1 = SWInterval<T>::Sub(inV1[0], inV0[0]);
+            auto y1 = SWInterval<T>::Sub(inV1[1], inV0[1]);
+            auto x0y1 = x0 * y1;
+            auto x1y0 = x1 * y0;
+            auto det = x0y1 - x1y0;
+
+            T constexpr zero = 0;
+            if (det[0] > zero)
+            {
+                return +1;
+            }
+            else if (det[1] < zero)
+            {
+                return -1;
+            }
+
+            // The exact sign of the determinant is not known, so compute
+            // the determinant using rational arithmetic.
+
+            // Name the nodes of the expression tree.
+            IRVector const& irP = mIRVertices[pIndex];
+            IRVector const& irV0 = mIRVertices[v0Index];
+            IRVector const& irV1 = mIRVertices[v1Index];
+
+            auto const& crP0 = Copy(irP[0], mCRPool[0]);
+            auto const& crP1 = Copy(irP[1], mCRPool[1]);
+            auto const& crV00 = Copy(irV0[0], mCRPool[2]);
+            auto const& crV01 = Copy(irV0[1], mCRPool[3]);
+            auto const& crV10 = Copy(irV1[0], mCRPool[4]);
+            auto const& crV11 = Copy(irV1[1], mCRPool[5]);
+            auto& crX0 = mCRPool[6];
+            auto& crY0 = mCRPool[7];
+            auto& crX1 = mCRPool[8];
+            auto& crY1 = mCRPool[9];
+            auto& crX0Y1 = mCRPool[10];
+            auto& crX1Y0 = mCRPool[11];
+            auto& crDet = mCRPool[12];
+
+            // Evaluate the expression tree.
+            crX0 = crP0 - crV00;
+            crY0 = crP1 - crV01;
+            crX1 = crV10 - crV00;
+            crY1 = crV11 - crV01;
+            crX0Y1 = crX0 * crY1;
+            crX1Y0 = crX1 * crY0;
+            crDet = crX0Y1 - crX1Y0;
+            return crDet.GetSign();
+        }
+
+        // For a triangle with counterclockwise vertices V0, V1 and V2, operator()
+        // returns
+        //   +1, P outside triangle
+        //   -1, P inside triangle
+        //    0, P on triangle
+        int32_t ToTriangle(size_t pIndex, size_t v0Index, size_t v1Index, size_t v2Index) const
+        {
+            int32_t sign0 = ToLine(pIndex, v1Index, v2Index);
+            if (sign0 > 0)
+            {
+                return +1;
+            }
+
+            int32_t sign1 = ToLine(pIndex, v0Index, v2Index);
+            if (sign1 < 0)
+            {
+                return +1;
+            }
+
+            int32_t sign2 = ToLine(pIndex, v0Index, v1Index);
+            if (sign2 > 0)
+            {
+                return +1;
+            }
+
+            return ((sign0 && sign1 && sign2) ? -1 : 0);
+        }
+
+        // For a triangle with counterclockwise vertices V0, V1 and V2 and a
+        // query point P, ToCircumcircle returns
+        //   +1, P outside circumcircle of triangle
+        //   -1, P inside circumcircle of triangle
+        //    0, P on circumcircle of triangle
+        int32_t ToCircumcircle(size_t pIndex, size_t v0Index, size_t v1Index, size_t v2Index) const
+        {
+            // The expression tree has 43 nodes consisting of 8 input
+            // leaves and 35 compute nodes.
+
+            // Use interval arithmetic to determine the sign if possible.
+            Vector2<T> const& inP = mVertices[pIndex];
+            Vector2<T> const& inV0 = mVertices[v0Index];
+            Vector2<T> const& inV1 = mVertices[v1Index];
+            Vector2<T> const& inV2 = mVertices[v2Index];
+
+            auto x0 = SWInterval<T>::Sub(inV0[0], inP[0]);
+            auto y0 = SWInterval<T>::Sub(inV0[1], inP[1]);
+            auto s00 = SWInterval<T>::Add(inV0[0], inP[0]);
+            auto s01 = SWInterval<T>::Add(inV0[1], inP[1]);
+            auto x1 = SWInterval<T>::Sub(inV1[0], inP[0]);
+            auto y1 = SWInterval<T>::Sub(inV1[1], inP[1]);
+            auto s10 = SWInterval<T>::Add(inV1[0], inP[0]);
+            auto s11 = SWInterval<T>::Add(inV1[1], inP[1]);
+            auto x2 = SWInterval<T>::Sub(inV2[0], inP[0]);
+            auto y2 = SWInterval<T>::Sub(inV2[1], inP[1]);
+            auto s20 = SWInterval<T>::Add(inV2[0], inP[0]);
+            auto s21 = SWInterval<T>::Add(inV2[1], inP[1]);
+            auto t00 = s00 * x0;
+            auto t01 = s01 * y0;
+            auto t10 = s10 * x1;
+            auto t11 = s11 * y1;
+            auto t20 = s20 * x2;
+            auto t21 = s21 * y2;
+            auto z0 = t00 + t01;
+            auto z1 = t10 + t11;
+            auto z2 = t20 + t21;
+            auto y0z1 = y0 * z1;
+            auto y0z2 = y0 * z2;
+            auto y1z0 = y1 * z0;
+            auto y1z2 = y1 * z2;
+            auto y2z0 = y2 * z0;
+            auto y2z1 = y2 * z1;
+            auto c0 = y1z2 - y2z1;
+            auto c1 = y2z0 - y0z2;
+            auto c2 = y0z1 - y1z0;
+            auto x0c0 = x0 * c0;
+            auto x1c1 = x1 * c1;
+            auto x2c2 = x2 * c2;
+            auto det = x0c0 + x1c1 + x2c2;
+
+            T constexpr zero = 0;
+            if (det[0] > zero)
+            {
+                return -1;
+            }
+            else if (det[1] < zero)
+            {
+                return +1;
+            }
+
+            // The exact sign of the determinant is not known, so compute
+            // the determinant using rational arithmetic.
+
+            // Name the nodes of the expression tree.
+            IRVector const& irP = mIRVertices[pIndex];
+            IRVector const& irV0 = mIRVertices[v0Index];
+            IRVector const& irV1 = mIRVertices[v1Index];
+            IRVector const& irV2 = mIRVertices[v2Index];
+
+            auto const& crP0 = Copy(irP[0], mCRPool[0]);
+            auto const& crP1 = Copy(irP[1], mCRPool[1]);
+            auto const& crV00 = Copy(irV0[0], mCRPool[2]);
+            auto const& crV01 = Copy(irV0[1], mCRPool[3]);
+            auto const& crV10 = Copy(irV1[0], mCRPool[4]);
+            auto const& crV11 = Copy(irV1[1], mCRPool[5]);
+            auto const& crV20 = Copy(irV2[0], mCRPool[6]);
+            auto const& crV21 = Copy(irV2[1], mCRPool[7]);
+
+            auto& crX0 = mCRPool[8];
+            auto& crY0 = mCRPool[9];
+            auto& crS00 = mCRPool[10];
+            auto& crS01 = mCRPool[11];
+            auto& crT00 = mCRPool[12];
+            auto& crT01 = mCRPool[13];
+            auto& crZ0 = mCRPool[14];
+
+            auto& crX1 = mCRPool[15];
+            auto& crY1 = mCRPool[16];
+            auto& crS10 = mCRPool[17];
+            auto& crS11 = mCRPool[18];
+            auto& crT10 = mCRPool[19];
+            auto& crT11 = mCRPool[20];
+            auto& crZ1 = mCRPool[21];
+
+            auto& crX2 = mCRPool[22];
+            auto& crY2 = mCRPool[23];
+            auto& crS20 = mCRPool[24];
+            auto& crS21 = mCRPool[25];
+            auto& crT20 = mCRPool[26];
+            auto& crT21 = mCRPool[27];
+            auto& crZ2 = mCRPool[28];
+
+            auto& crY0Z1 = mCRPool[29];
+            auto& crY0Z2 = mCRPool[30];
+            auto& crY1Z0 = mCRPool[31];
+            auto& crY1Z2 = mCRPool[32];
+            auto& crY2Z0 = mCRPool[33];
+            auto& crY2Z1 = mCRPool[34];
+
+            auto& crC0 = mCRPool[35];
+            auto& crC1 = mCRPool[36];
+            auto& crC2 = mCRPool[37];
+            auto& crX0C0 = mCRPool[38];
+            auto& crX1C1 = mCRPool[39];
+            auto& crX2C2 = mCRPool[40];
+            auto& crTerm = mCRPool[41];
+            auto& crDet = mCRPool[42];
+
+            // Evaluate the expression tree.
+            crX0 = crV00 - crP0;
+            crY0 = crV01 - crP1;
+            crS00 = crV00 + crP0;
+            crS01 = crV01 + crP1;
+            crT00 = crS00 * crX0;
+            crT01 = crS01 * crY0;
+            crZ0 = crT00 + crT01;
+
+            crX1 = crV10 - crP0;
+            crY1 = crV11 - crP1;
+            crS10 = crV10 + crP0;
+            crS11 = crV11 + crP1;
+            crT10 = crS10 * crX1;
+            crT11 = crS11 * crY1;
+            crZ1 = crT10 + crT11;
+
+            crX2 = crV20 - crP0;
+            crY2 = crV21 - crP1;
+            crS20 = crV20 + crP0;
+            crS21 = crV21 + crP1;
+            crT20 = crS20 * crX2;
+            crT21 = crS21 * crY2;
+            crZ2 = crT20 + crT21;
+
+            crY0Z1 = crY0 * crZ1;
+            crY0Z2 = crY0 * crZ2;
+            crY1Z0 = crY1 * crZ0;
+            crY1Z2 = crY1 * crZ2;
+            crY2Z0 = crY2 * crZ0;
+            crY2Z1 = crY2 * crZ1;
+
+            crC0 = crY1Z2 - crY2Z1;
+            crC1 = crY2Z0 - crY0Z2;
+            crC2 = crY0Z1 - crY1Z0;
+            crX0C0 = crX0 * crC0;
+            crX1C1 = crX1 * crC1;
+            crX2C2 = crX2 * crC2;
+            crTerm = crX0C0 + crX1C1;
+            crDet = crTerm + crX2C2;
+            return -crDet.GetSign();
+        }
+
+        // The rectangular domain in which all input points live and its
+        // partition into cells.
+        T mXMin, mYMin, mXMax, mYMax;
+        size_t mNumXCells, mNumYCells;
+        T mXScale, mYScale;
+
+        Callback mCallback;
+        bool mFinished;
+
+        // The finalization state of the cells and, for each cell that is
+        // not finalized, the triangles that wait for its finalization. An
+        // element of a list is a triangle slot and the stamp of the slot
+        // when the element was created.
+        std::vector<uint8_t> mCellFinalized;
+        std::vector<std::vector<std::pair<size_t, size_t>>> mWaiting;
+
+        // The vertices in memory. The slots 0, 1 and 2 store the
+        // supervertices and the slots 3 through 6 store the rectangle
+        // corners. The slots of removed vertices are reused.
+        struct VertexHash
+        {
+            std::size_t operator()(Vector2<T> const& v) const
+            {
+                return HashValue(v[0], v[1]);
+            }
+        };
+
+        std::unordered_map<Vector2<T>, size_t, VertexHash> mVertexIndexMap;
+        std::vector<Vector2<T>> mVertices;
+        std::vector<IRVector> mIRVertices;
+        std::vector<size_t> mGlobalIndices;
+        std::vector<size_t> mNumVertexTriangles;
+        std::vector<size_t> mFreeVertices;
+        size_t mNextGlobalIndex;
+
+        // The triangles in memory. The counterclockwise vertices of slot t
+        // are mTriangles[t][0,1,2] and mAdjacencies[t][j] is the slot of
+        // the triangle sharing the edge <mTriangles[t][j],
+        // mTriangles[t][(j+1)%3]>. The slot of a removed triangle has
+        // mTriangles[t][0] = invalid.
+        std::vector<std::array<size_t, 3>> mTriangles;
+        std::vector<std::array<size_t, 3>> mAdjacencies;
+        std::vector<size_t> mStamps;
+        std::vector<size_t> mMarks;
+        std::vector<size_t> mFreeTriangles;
+        size_t mNumTriangles;
+
+        // The most recently inserted triangle, where the point location of
+        // the next insertion starts.
+        size_t mLastTriangle;
+
+        // The mark of the insertion polygon search.
+        size_t mMark;
+
+        // Sufficient storage for the expression trees related to computing
+        // the exact signs in ToLine(...) and ToCircumcircle(...).
+        static size_t constexpr maxNumCRPool = 43;
+        mutable std::vector<ComputeRational> mCRPool;
+
+        // Storage that is reused by the insertions.
+        struct BoundaryEdge
+        {
+            size_t v0, v1, adj, adjEdge;
+        };
+
+        std::vector<size_t> mStack;
+        std::vector<size_t> mCavity;
+        std::vector<BoundaryEdge> mBoundary;
+        std::unordered_map<size_t, size_t> mNewTriangles;
+    };
+}
@@ -3,12 +3,13 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/Math.h>
+#include <Mathematics/Profiler.h>
 #include <algorithm>
 #include <array>
 #include <cstdint>
@@ -210,6 +211,7 @@ namespace gte
             Extract(level, rationalVertices, triangles);
             if (removeDuplicateVertices)
             {
+                GTE_PROFILE_ZONE("SurfaceExtractor::MakeUnique");
                 MakeUnique(rationalVertices, triangles);
             }
             Convert(rationalVertices, vertices);
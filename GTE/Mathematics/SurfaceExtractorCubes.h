@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -45,6 +45,8 @@ namespace gte
         virtual void Extract(T level, std::vector<Vertex>& vertices,
             std::vector<Triangle>& triangles) override
         {
+            GTE_PROFILE_ZONE("SurfaceExtractorCubes::Extract");
+
             // Adjust the image so that the level set is F(x,y,z) = 0.  The
             // precondition for 'level' is that it is not exactly a voxel
             // value.  However, T is an integer type, so we cannot pass in
@@ -3,18 +3,26 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.18
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/MarchingCubes.h>
 #include <Mathematics/Image3.h>
+#include <Mathematics/Profiler.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/UniqueVerticesSimplices.h>
 #include <Mathematics/Vector3.h>
+#include <atomic>
+#include <vector>
+
+// The image type is Image3<Real> or any type with the same read interface,
+// such as SparseImage3<Real>. The functions use GetDimension, GetCorners,
+// operator[] and operator().
 
 namespace gte
 {
-    template <typename Real>
+    template <typename Real, typename ImageType = Image3<Real>>
     class SurfaceExtractorMC : public MarchingCubes
     {
     public:
@@ -23,7 +31,7 @@ namespace gte
         {
         }
 
-        SurfaceExtractorMC(Image3<Real> const& image)
+        SurfaceExtractorMC(ImageType const& image)
             :
             mImage(image)
         {
@@ -107,6 +115,7 @@ namespace gte
         // triple of indices into 'vertices'
         bool Extract(Real level, std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const
         {
+            GTE_PROFILE_ZONE("SurfaceExtractorMC::Extract");
             vertices.clear();
             indices.clear();
 
@@ -132,7 +141,7 @@ namespace gte
                             int vbase = static_cast<int>(vertices.size());
                             for (int i = 0; i < mesh.topology.numVertices; ++i)
                             {
-                                Vector3<float> position = mesh.vertices[i];
+                                Vector3<Real> position = mesh.vertices[i];
                                 position[0] += static_cast<Real>(x);
                                 position[1] += static_cast<Real>(y);
                                 position[2] += static_cast<Real>(z);
@@ -160,6 +169,191 @@ namespace gte
             return true;
         }
 
+        // Extract the same level surface as Extract(level, vertices, indices)
+        // but with one vertex per lattice edge that the surface crosses, so
+        // the triangles of adjacent voxels share vertices and MakeUnique is
+        // not required. The voxels are partitioned into slabs of z-layers
+        // that are processed concurrently by 'numThreads' threads, which are
+        // tasks of the scheduler when it is not null. A first pass counts the
+        // vertices and triangles of each slab, the prefix sums of the counts
+        // determine where each slab stores its output, and a second pass
+        // stores the vertices and triangles, so the output arrays are
+        // allocated once. A vertex is identified by its lattice edge, which
+        // is the lattice point at the minimum end and the axis of the edge.
+        // The vertices are ordered by lattice point in lexicographic order
+        // and then by axis, and the triangles are ordered by voxel, so the
+        // output is the same for any number of threads.
+        bool ExtractParallel(Real level, std::vector<Vector3<Real>>& vertices,
+            std::vector<int>& indices, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            GTE_PROFILE_ZONE("SurfaceExtractorMC::ExtractParallel");
+            vertices.clear();
+            indices.clear();
+
+            int const dim0 = mImage.GetDimension(0);
+            int const dim1 = mImage.GetDimension(1);
+            int const dim2 = mImage.GetDimension(2);
+            if (dim0 < 2 || dim1 < 2 || dim2 < 2)
+            {
+                return true;
+            }
+
+            // Slab s has the voxels with z in [slabZ[s],slabZ[s+1]) and
+            // the edges whose minimum end has z in the same range. The last
+            // slab also has the edges in the plane z = dim2 - 1.
+            size_t const numLayers = static_cast<size_t>(dim2) - 1;
+            size_t const numSlabs = std::min(numLayers,
+                std::max(numThreads, static_cast<size_t>(1)) * 4);
+            std::vector<int> slabZ(numSlabs + 1);
+            for (size_t s = 0; s <= numSlabs; ++s)
+            {
+                slabZ[s] = static_cast<int>(s * numLayers / numSlabs);
+            }
+            slabZ[numSlabs] = dim2 - 1;
+
+            // The count pass. Each slab also stores the slab-relative
+            // indices of the vertices on the x-edges and y-edges of its
+            // first plane, which are used by the voxels of the previous
+            // slab.
+            size_t const planeSize = static_cast<size_t>(dim0) * static_cast<size_t>(dim1);
+            std::vector<int> numSlabVertices(numSlabs), numSlabTriangles(numSlabs);
+            std::vector<std::array<std::vector<int>, 2>> firstPlanes(numSlabs);
+            std::atomic<bool> hasZero(false);
+            TaskScheduler::ParallelForDynamic(scheduler, numSlabs, numThreads, [&](size_t s)
+            {
+                GTE_PROFILE_ZONE("SurfaceExtractorMC::CountSlab");
+                std::array<std::vector<int>, 3> plane;
+                for (auto& edges : plane)
+                {
+                    edges.resize(planeSize);
+                }
+
+                int numVertices = 0, numTriangles = 0;
+                int const z0 = slabZ[s], z1 = (s + 1 == numSlabs ? dim2 : slabZ[s + 1]);
+                for (int z = z0; z < z1; ++z)
+                {
+                    if (!NumberPlane(z, level, numVertices, plane, nullptr))
+                    {
+                        hasZero = true;
+                        return;
+                    }
+                    if (z == z0)
+                    {
+                        firstPlanes[s][0] = plane[0];
+                        firstPlanes[s][1] = plane[1];
+                    }
+                }
+
+                for (int z = z0; z < slabZ[s + 1]; ++z)
+                {
+                    for (int y = 0; y + 1 < dim1; ++y)
+                    {
+                        for (int x = 0; x + 1 < dim0; ++x)
+                        {
+                            numTriangles += GetTable(GetEntry(x, y, z, level)).numTriangles;
+                        }
+                    }
+                }
+
+                numSlabVertices[s] = numVertices;
+                numSlabTriangles[s] = numTriangles;
+            });
+
+            if (hasZero)
+            {
+                return false;
+            }
+
+            std::vector<int> vertexOffsets(numSlabs + 1), triangleOffsets(numSlabs + 1);
+            vertexOffsets[0] = 0;
+            triangleOffsets[0] = 0;
+            for (size_t s = 0; s < numSlabs; ++s)
+            {
+                vertexOffsets[s + 1] = vertexOffsets[s] + numSlabVertices[s];
+                triangleOffsets[s + 1] = triangleOffsets[s] + numSlabTriangles[s];
+            }
+            vertices.resize(static_cast<size_t>(vertexOffsets[numSlabs]));
+            indices.resize(3 * static_cast<size_t>(triangleOffsets[numSlabs]));
+
+            // The emit pass. At voxel layer z, the vertex indices are known
+            // for the edges of plane z and for the x-edges and y-edges of
+            // plane z+1.
+            TaskScheduler::ParallelForDynamic(scheduler, numSlabs, numThreads, [&](size_t s)
+            {
+                GTE_PROFILE_ZONE("SurfaceExtractorMC::EmitSlab");
+                std::array<std::vector<int>, 3> plane0, plane1;
+                for (int j = 0; j < 3; ++j)
+                {
+                    plane0[j].resize(planeSize);
+                    plane1[j].resize(planeSize);
+                }
+
+                int next = vertexOffsets[s];
+                int* triangle = indices.data() + 3 * static_cast<size_t>(triangleOffsets[s]);
+                int const z0 = slabZ[s], z1 = slabZ[s + 1];
+                NumberPlane(z0, level, next, plane0, vertices.data());
+                for (int z = z0; z < z1; ++z)
+                {
+                    if (z + 1 < z1 || s + 1 == numSlabs)
+                    {
+                        NumberPlane(z + 1, level, next, plane1, vertices.data());
+                    }
+                    else
+                    {
+                        int const base = vertexOffsets[s + 1];
+                        for (int j = 0; j < 2; ++j)
+                        {
+                            for (size_t i = 0; i < planeSize; ++i)
+                            {
+                                plane1[j][i] = base + firstPlanes[s + 1][j][i];
+                            }
+                        }
+                    }
+
+                    for (int y = 0; y + 1 < dim1; ++y)
+                    {
+                        for (int x = 0; x + 1 < dim0; ++x)
+                        {
+                            Topology const& topology = GetTable(GetEntry(x, y, z, level));
+                            if (topology.numTriangles == 0)
+                            {
+                                continue;
+                            }
+
+                            std::array<int, MAX_VERTICES> vertexIndex;
+                            for (int i = 0; i < topology.numVertices; ++i)
+                            {
+                                // The voxel corners j0 and j1 differ in the
+                                // bit of the axis of their edge, and the
+                                // minimum end is the corner j0 & j1.
+                                int const j0 = topology.vpair[i][0];
+                                int const j1 = topology.vpair[i][1];
+                                int const corner = (j0 & j1);
+                                int const bit = (j0 ^ j1);
+                                int const axis = (bit == 1 ? 0 : (bit == 2 ? 1 : 2));
+                                size_t const k = static_cast<size_t>(x + (corner & 1))
+                                    + static_cast<size_t>(dim0) * static_cast<size_t>(y + ((corner >> 1) & 1));
+                                vertexIndex[i] = ((corner & 4) == 0 ? plane0[axis][k] : plane1[axis][k]);
+                            }
+
+                            for (int i = 0; i < topology.numTriangles; ++i)
+                            {
+                                for (int j = 0; j < 3; ++j)
+                                {
+                                    *triangle++ = vertexIndex[topology.itriple[i][j]];
+                                }
+                            }
+                        }
+                    }
+
+                    std::swap(plane0, plane1);
+                }
+            });
+
+            return true;
+        }
+
         // The extraction has duplicate vertices on edges shared by voxels.
         // This function will eliminate the duplication.
         void MakeUnique(std::vector<Vector3<Real>>& vertices, std::vector<int>& indices) const
@@ -272,6 +466,72 @@ namespace gte
         }
 
     protected:
+        // The table entry for the voxel with minimum corner (x,y,z).
+        int GetEntry(int x, int y, int z, Real level) const
+        {
+            int entry = 0;
+            entry |= (mImage(x, y, z) < level ? 0x01 : 0);
+            entry |= (mImage(x + 1, y, z) < level ? 0x02 : 0);
+            entry |= (mImage(x, y + 1, z) < level ? 0x04 : 0);
+            entry |= (mImage(x + 1, y + 1, z) < level ? 0x08 : 0);
+            entry |= (mImage(x, y, z + 1) < level ? 0x10 : 0);
+            entry |= (mImage(x + 1, y, z + 1) < level ? 0x20 : 0);
+            entry |= (mImage(x, y + 1, z + 1) < level ? 0x40 : 0);
+            entry |= (mImage(x + 1, y + 1, z + 1) < level ? 0x80 : 0);
+            return entry;
+        }
+
+        // Assign consecutive indices, starting with 'next', to the edges of
+        // plane z that the level surface crosses, visiting the lattice
+        // points in lexicographic order and the axes x, y, z at each point.
+        // The index of the edge at lattice point (x,y) of the plane with
+        // axis j is stored in plane[j][x + dim0 * y], or -1 when the edge is
+        // not crossed. The vertex positions are stored at their indices
+        // when 'positions' is not null. The return value is 'false' when a
+        // lattice point has value 'level'.
+        bool NumberPlane(int z, Real level, int& next,
+            std::array<std::vector<int>, 3>& plane, Vector3<Real>* positions) const
+        {
+            int const dim0 = mImage.GetDimension(0);
+            int const dim1 = mImage.GetDimension(1);
+            bool const hasZEdges = (z + 1 < mImage.GetDimension(2));
+            for (int y = 0, k = 0; y < dim1; ++y)
+            {
+                for (int x = 0; x < dim0; ++x, ++k)
+                {
+                    Real const f0 = mImage(x, y, z) - level;
+                    if (f0 == (Real)0)
+                    {
+                        return false;
+                    }
+
+                    std::array<bool, 3> const hasEdge = { x + 1 < dim0, y + 1 < dim1, hasZEdges };
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        plane[j][k] = -1;
+                        if (hasEdge[j])
+                        {
+                            Real const f1 = mImage(x + (j == 0 ? 1 : 0), y + (j == 1 ? 1 : 0),
+                                z + (j == 2 ? 1 : 0)) - level;
+                            if ((f0 < (Real)0) != (f1 < (Real)0))
+                            {
+                                if (positions)
+                                {
+                                    Vector3<Real>& position = positions[next];
+                                    position[0] = static_cast<Real>(x);
+                                    position[1] = static_cast<Real>(y);
+                                    position[2] = static_cast<Real>(z);
+                                    position[j] += f0 / (f0 - f1);
+                                }
+                                plane[j][k] = next++;
+                            }
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
         Vector3<Real> GetGradient(Vector3<Real> position) const
         {
             int x = static_cast<int>(std::floor(position[0]));
@@ -328,6 +588,6 @@ namespace gte
             return gradient;
         }
 
-        Image3<Real> const& mImage;
+        ImageType const& mImage;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -47,6 +47,8 @@ namespace gte
         virtual void Extract(T level, std::vector<Vertex>& vertices,
             std::vector<Triangle>& triangles) override
         {
+            GTE_PROFILE_ZONE("SurfaceExtractorTetrahedra::Extract");
+
             // Adjust the image so that the level set is F(x,y,z) = 0.
             int64_t levelI64 = static_cast<int64_t>(level);
             for (size_t i = 0; i < this->mVoxels.size(); ++i)
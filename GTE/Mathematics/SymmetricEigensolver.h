@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -99,6 +99,9 @@
 // comperr is the computation E = Q^T*A*Q - D.  The construction of the full
 // eigenvector matrix is, of course, quite expensive.  If you need only a
 // small number of eigenvectors, use function GetEigenvector(int,Real*).
+// For large N, use SymmetricEigensolverDC, which has the same interface and
+// computes the eigenvectors with a blocked tridiagonalization and the
+// divide-and-conquer algorithm.
 
 namespace gte
 {
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -79,5 +79,55 @@ namespace gte
                 evec[1][1] = s;
             }
         }
+
+        // Solve the eigensystems of numMatrices matrices, where the
+        // elements of matrices[i] are {a00, a01, a11}. The outputs eval[i]
+        // and evec[i] are those of the single-matrix operator() for
+        // matrices[i], up to rounding errors when the compiler contracts
+        // multiply-adds into fused multiply-adds. The branches of
+        // operator() are replaced by selections between the results of both
+        // cases, so the loop has no branches and compilers can vectorize it.
+        void operator()(size_t numMatrices, std::array<Real, 3> const* matrices,
+            int sortType, std::array<Real, 2>* eval,
+            std::array<std::array<Real, 2>, 2>* evec) const
+        {
+            Real const zero = (Real)0, one = (Real)1, half = (Real)0.5;
+            Real const realSortType = static_cast<Real>(sortType);
+            for (size_t i = 0; i < numMatrices; ++i)
+            {
+                Real a00 = matrices[i][0], a01 = matrices[i][1], a11 = matrices[i][2];
+                Real c2 = half * (a00 - a11), s2 = a01;
+                Real maxAbsComp = std::max(std::fabs(c2), std::fabs(s2));
+                bool const isPositive = (maxAbsComp > zero);
+
+                // The divisions are not finite when maxAbsComp is zero, and
+                // their results are replaced by (-1,0).
+                Real nc2 = c2 / maxAbsComp, ns2 = s2 / maxAbsComp;
+                Real length = std::sqrt(nc2 * nc2 + ns2 * ns2);
+                nc2 /= length;
+                ns2 /= length;
+                bool const negate = (nc2 > zero);
+                nc2 = (negate ? -nc2 : nc2);
+                ns2 = (negate ? -ns2 : ns2);
+                c2 = (isPositive ? nc2 : -one);
+                s2 = (isPositive ? ns2 : zero);
+
+                Real s = std::sqrt(half * (one - c2));
+                Real c = half * s2 / s;
+
+                Real csqr = c * c, ssqr = s * s, mid = s2 * a01;
+                Real diagonal0 = csqr * a00 + mid + ssqr * a11;
+                Real diagonal1 = csqr * a11 - mid + ssqr * a00;
+
+                bool const keep = (sortType == 0 ||
+                    realSortType * diagonal0 <= realSortType * diagonal1);
+                eval[i][0] = (keep ? diagonal0 : diagonal1);
+                eval[i][1] = (keep ? diagonal1 : diagonal0);
+                evec[i][0][0] = (keep ? c : s);
+                evec[i][0][1] = (keep ? s : -c);
+                evec[i][1][0] = (keep ? -s : c);
+                evec[i][1][1] = (keep ? c : s);
+            }
+        }
     };
 }
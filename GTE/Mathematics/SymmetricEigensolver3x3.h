@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.16
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -18,6 +18,18 @@
 // by class SymmmetricEigensolver3x3.  The noniterative algorithm is
 // implemented by class NISymmetricEigensolver3x3.  The code does not use
 // GTEngine objects.
+//
+// NISymmetricEigensolver3x3 also has a batch operator() for arrays of
+// matrices, such as the covariance matrices of per-point normal estimation.
+// The matrices are processed in blocks of BATCH_SIZE, stored as arrays of
+// the matrix elements in the lanes of the block.  The degenerate cases are
+// handled by selecting among the results of all cases, so the loops over
+// the lanes have no branches and compilers can vectorize them.  Each lane
+// evaluates the same expressions as the single-matrix operator(), so the
+// results are the same as those of the single-matrix operator(). (When the
+// compiler contracts multiply-adds into fused multiply-adds, it can do so
+// differently in the two functions, and the results can differ by
+// rounding errors.)
 
 namespace gte
 {
@@ -522,7 +534,233 @@ namespace gte
             SortEigenstuff<Real>()(sortType, true, eval, evec);
         }
 
+        // The number of matrices processed together by the batch
+        // operator().
+        enum { BATCH_SIZE = 8 };
+
+        // Solve the eigensystems of numMatrices matrices, where the
+        // elements of matrices[i] are {a00, a01, a02, a11, a12, a22}. The
+        // outputs eval[i] and evec[i] are those of the single-matrix
+        // operator() for matrices[i].
+        void operator()(size_t numMatrices, std::array<Real, 6> const* matrices,
+            int sortType, std::array<Real, 3>* eval,
+            std::array<std::array<Real, 3>, 3>* evec) const
+        {
+            Batch batch;
+            for (size_t i0 = 0; i0 < numMatrices; i0 += BATCH_SIZE)
+            {
+                size_t const numLanes = std::min(static_cast<size_t>(BATCH_SIZE), numMatrices - i0);
+                for (size_t k = 0; k < BATCH_SIZE; ++k)
+                {
+                    for (size_t e = 0; e < 6; ++e)
+                    {
+                        batch.a[e][k] = (k < numLanes ? matrices[i0 + k][e] : (Real)0);
+                    }
+                }
+
+                SolveBatch(batch);
+
+                for (size_t k = 0; k < numLanes; ++k)
+                {
+                    std::array<Real, 3>& outEVal = eval[i0 + k];
+                    std::array<std::array<Real, 3>, 3>& outEVec = evec[i0 + k];
+                    for (size_t i = 0; i < 3; ++i)
+                    {
+                        outEVal[i] = batch.eval[i][k];
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            outEVec[i][j] = batch.evec[i][j][k];
+                        }
+                    }
+
+                    if (!batch.isZero[k])
+                    {
+                        SortEigenstuff<Real>()(sortType, true, outEVal, outEVec);
+                    }
+                }
+            }
+        }
+
     private:
+        // The lanes of a block of the batch operator().
+        struct Batch
+        {
+            Real a[6][BATCH_SIZE];
+            Real eval[3][BATCH_SIZE];
+            Real evec[3][3][BATCH_SIZE];
+            bool isZero[BATCH_SIZE];
+
+            // Intermediate values.
+            Real maxAbsElement[BATCH_SIZE], q[BATCH_SIZE], p[BATCH_SIZE];
+            Real halfDet[BATCH_SIZE];
+        };
+
+        // The computations of the single-matrix operator() for the lanes of
+        // a batch, without the sorting. The comments of operator() and of
+        // the ComputeEigenvector* functions describe the steps.
+        void SolveBatch(Batch& batch) const
+        {
+            // Precondition the matrices and compute the arguments of acos.
+            for (size_t k = 0; k < BATCH_SIZE; ++k)
+            {
+                Real max0 = std::max(std::fabs(batch.a[0][k]), std::fabs(batch.a[1][k]));
+                Real max1 = std::max(std::fabs(batch.a[2][k]), std::fabs(batch.a[3][k]));
+                Real max2 = std::max(std::fabs(batch.a[4][k]), std::fabs(batch.a[5][k]));
+                Real maxAbsElement = std::max(std::max(max0, max1), max2);
+                batch.isZero[k] = (maxAbsElement == (Real)0);
+                batch.maxAbsElement[k] = maxAbsElement;
+
+                // The scaled elements of the zero matrix are not finite,
+                // and its results are replaced at the end.
+                Real invMaxAbsElement = (Real)1 / maxAbsElement;
+                for (size_t e = 0; e < 6; ++e)
+                {
+                    batch.a[e][k] *= invMaxAbsElement;
+                }
+
+                Real a00 = batch.a[0][k], a01 = batch.a[1][k], a02 = batch.a[2][k];
+                Real a11 = batch.a[3][k], a12 = batch.a[4][k], a22 = batch.a[5][k];
+                Real norm = a01 * a01 + a02 * a02 + a12 * a12;
+                Real q = (a00 + a11 + a22) / (Real)3;
+                Real b00 = a00 - q;
+                Real b11 = a11 - q;
+                Real b22 = a22 - q;
+                Real p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + norm * (Real)2) / (Real)6);
+                Real c00 = b11 * b22 - a12 * a12;
+                Real c01 = a01 * b22 - a12 * a02;
+                Real c02 = a01 * a12 - b11 * a02;
+                Real det = (b00 * c00 - a01 * c01 + a02 * c02) / (p * p * p);
+                Real halfDet = det * (Real)0.5;
+                batch.halfDet[k] = std::min(std::max(halfDet, (Real)-1), (Real)1);
+                batch.q[k] = q;
+                batch.p[k] = p;
+            }
+
+            // Compute the eigenvalues.
+            Real const twoThirdsPi = (Real)2.09439510239319549;
+            for (size_t k = 0; k < BATCH_SIZE; ++k)
+            {
+                Real angle = std::acos(batch.halfDet[k]) / (Real)3;
+                Real beta2 = std::cos(angle) * (Real)2;
+                Real beta0 = std::cos(angle + twoThirdsPi) * (Real)2;
+                Real beta1 = -(beta0 + beta2);
+                batch.eval[0][k] = batch.q[k] + batch.p[k] * beta0;
+                batch.eval[1][k] = batch.q[k] + batch.p[k] * beta1;
+                batch.eval[2][k] = batch.q[k] + batch.p[k] * beta2;
+            }
+
+            // Compute the eigenvectors and select the results of the
+            // degenerate cases.
+            for (size_t k = 0; k < BATCH_SIZE; ++k)
+            {
+                Real a00 = batch.a[0][k], a01 = batch.a[1][k], a02 = batch.a[2][k];
+                Real a11 = batch.a[3][k], a12 = batch.a[4][k], a22 = batch.a[5][k];
+                bool const useEVal2 = (batch.halfDet[k] >= (Real)0);
+
+                // ComputeEigenvector0 for eval[2] or eval[0].
+                Real eval0 = (useEVal2 ? batch.eval[2][k] : batch.eval[0][k]);
+                std::array<Real, 3> row0 = { a00 - eval0, a01, a02 };
+                std::array<Real, 3> row1 = { a01, a11 - eval0, a12 };
+                std::array<Real, 3> row2 = { a02, a12, a22 - eval0 };
+                std::array<Real, 3> r0xr1 = Cross(row0, row1);
+                std::array<Real, 3> r0xr2 = Cross(row0, row2);
+                std::array<Real, 3> r1xr2 = Cross(row1, row2);
+                Real d0 = Dot(r0xr1, r0xr1);
+                Real d1 = Dot(r0xr2, r0xr2);
+                Real d2 = Dot(r1xr2, r1xr2);
+                bool const select1 = (d1 > d0);
+                Real dmax = (select1 ? d1 : d0);
+                bool const select2 = (d2 > dmax);
+                Real dselect = (select2 ? d2 : dmax);
+                std::array<Real, 3> evec0;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    evec0[i] = (select2 ? r1xr2[i] : (select1 ? r0xr2[i] : r0xr1[i]));
+                }
+                evec0 = Divide(evec0, std::sqrt(dselect));
+
+                // ComputeOrthogonalComplement for evec0.
+                bool const useW0 = (std::fabs(evec0[0]) > std::fabs(evec0[1]));
+                Real w = (useW0 ? evec0[0] : evec0[1]);
+                Real invLength = (Real)1 / std::sqrt(w * w + evec0[2] * evec0[2]);
+                std::array<Real, 3> U;
+                U[0] = (useW0 ? -evec0[2] * invLength : (Real)0);
+                U[1] = (useW0 ? (Real)0 : +evec0[2] * invLength);
+                U[2] = (useW0 ? +w * invLength : -w * invLength);
+                std::array<Real, 3> V = Cross(evec0, U);
+
+                // ComputeEigenvector1 for eval[1].
+                Real eval1 = batch.eval[1][k];
+                std::array<Real, 3> AU =
+                {
+                    a00 * U[0] + a01 * U[1] + a02 * U[2],
+                    a01 * U[0] + a11 * U[1] + a12 * U[2],
+                    a02 * U[0] + a12 * U[1] + a22 * U[2]
+                };
+                std::array<Real, 3> AV =
+                {
+                    a00 * V[0] + a01 * V[1] + a02 * V[2],
+                    a01 * V[0] + a11 * V[1] + a12 * V[2],
+                    a02 * V[0] + a12 * V[1] + a22 * V[2]
+                };
+                Real m00 = U[0] * AU[0] + U[1] * AU[1] + U[2] * AU[2] - eval1;
+                Real m01 = U[0] * AV[0] + U[1] * AV[1] + U[2] * AV[2];
+                Real m11 = V[0] * AV[0] + V[1] * AV[1] + V[2] * AV[2] - eval1;
+                Real absM00 = std::fabs(m00);
+                Real absM01 = std::fabs(m01);
+                Real absM11 = std::fabs(m11);
+
+                // The row (x,m01) of M used for the eigenvector is (m00,m01)
+                // or (m01,m11). The larger-magnitude element of the row is
+                // normalized to the other.
+                bool const useRow0 = (absM00 >= absM11);
+                Real x = (useRow0 ? m00 : m11);
+                Real absX = (useRow0 ? absM00 : absM11);
+                bool const isPositive = (std::max(absX, absM01) > (Real)0);
+                bool const xIsBig = (absX >= absM01);
+                Real big = (xIsBig ? x : m01);
+                Real small = (xIsBig ? m01 : x);
+                small /= big;
+                big = (Real)1 / std::sqrt((Real)1 + small * small);
+                small *= big;
+                Real xNormalized = (xIsBig ? big : small);
+                Real yNormalized = (xIsBig ? small : big);
+                Real cu = (useRow0 ? yNormalized : xNormalized);
+                Real cv = (useRow0 ? xNormalized : yNormalized);
+                std::array<Real, 3> evec1;
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    evec1[i] = (isPositive ? cu * U[i] - cv * V[i] : U[i]);
+                }
+
+                // The right-handed set of eigenvectors.
+                std::array<Real, 3> evec2 = (useEVal2 ? Cross(evec1, evec0) : Cross(evec0, evec1));
+
+                // Select the results of diagonal and zero matrices. The
+                // eigenvalues of a diagonal matrix are its scaled elements,
+                // and the zero matrix has zero eigenvalues.
+                Real const norm = a01 * a01 + a02 * a02 + a12 * a12;
+                bool const isDiagonal = !(norm > (Real)0);
+                bool const isZero = batch.isZero[k];
+                bool const isIdentity = (isDiagonal || isZero);
+                Real const maxAbsElement = batch.maxAbsElement[k];
+                Real const diagonal[3] = { a00, a11, a22 };
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    Real value = (isDiagonal ? diagonal[i] : batch.eval[i][k]) * maxAbsElement;
+                    batch.eval[i][k] = (isZero ? (Real)0 : value);
+                }
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    Real const e0 = (useEVal2 ? evec2[j] : evec0[j]);
+                    Real const e2 = (useEVal2 ? evec0[j] : evec2[j]);
+                    batch.evec[0][j][k] = (isIdentity ? (j == 0 ? (Real)1 : (Real)0) : e0);
+                    batch.evec[1][j][k] = (isIdentity ? (j == 1 ? (Real)1 : (Real)0) : evec1[j]);
+                    batch.evec[2][j][k] = (isIdentity ? (j == 2 ? (Real)1 : (Real)0) : e2);
+                }
+            }
+        }
+
         static std::array<Real, 3> Multiply(Real s, std::array<Real, 3> const& U)
         {
             std::array<Real, 3> product = { s * U[0], s * U[1], s * U[2] };
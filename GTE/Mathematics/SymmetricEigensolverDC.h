@@ -0,0 +1,1221 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/BlockedMatrixProduct.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// The eigendecomposition of large NxN symmetric matrices, for example the
+// Laplacian matrices of meshes used in spectral mesh processing. The
+// interface is that of SymmetricEigensolver, which uses an unblocked
+// Householder tridiagonalization and the implicit QR algorithm for the
+// tridiagonal matrix. That is fine for small N, but the eigenvector
+// computation applies O(N^2) Givens rotations to the columns of an NxN
+// matrix and has poor cache reuse.
+//
+// The matrix A is reduced to a tridiagonal matrix T = Q^T*A*Q with the
+// blocked algorithm of LAPACK's DSYTRD and DLATRD,
+//   J.J. Dongarra, S.J. Hammarling and D.C. Sorensen, Block reduction of
+//   matrices to condensed forms for eigenvalue computations, Journal of
+//   Computational and Applied Mathematics 27 (1989), 215-227
+// where the reflections of a panel of PANEL_SIZE columns are accumulated
+// and applied to the trailing matrix as a rank-2k update with the products
+// of BlockedMatrixProduct. The eigenvectors of T are computed with the
+// divide-and-conquer algorithm of
+//   J.J.M. Cuppen, A divide and conquer method for the symmetric
+//   tridiagonal eigenproblem, Numerische Mathematik 36 (1981), 177-195
+// using the deflation of LAPACK's DLAED2 and the computation of the
+// eigenvectors of
+//   M. Gu and S.C. Eisenstat, A divide-and-conquer algorithm for the
+//   symmetric tridiagonal eigenproblem, SIAM Journal on Matrix Analysis
+//   and Applications 16 (1995), 172-191
+// which guarantees their numerical orthogonality. T is split into two
+// tridiagonal matrices plus a rank-1 matrix, the halves are solved
+// recursively (with the implicit QR algorithm for at most LEAF_SIZE rows)
+// and the solutions are merged by solving the secular equation. Most of
+// the work of a merge is the product of the eigenvector matrices of the
+// halves with the eigenvectors of the rank-1 update, which is computed by
+// BlockedMatrixProduct. Deflation makes the cost much less than O(N^3) for
+// many matrices. The eigenvectors of A are Q times those of T, computed
+// with the reflections of each panel in the compact WY form
+//   R. Schreiber and C. Van Loan, A storage-efficient WY representation for
+//   products of Householder transformations, SIAM Journal on Scientific and
+//   Statistical Computing 10 (1989), 53-57
+//
+// The work is distributed over numThreads threads: the halves of the
+// divide-and-conquer are solved concurrently, and the matrix products, the
+// symmetric matrix-vector products of the tridiagonalization and the roots
+// of the secular equations are partitioned among the threads. The
+// partitions are chosen so that the results do not depend on the number of
+// threads. The threads are std::thread objects created for each call unless
+// a scheduler is specified by SetScheduler(*).
+//
+// The storage is 2*N^2 elements plus at most 2*N^2 elements for the merge
+// of the two largest halves.
+
+namespace gte
+{
+    template <typename Real>
+    class SymmetricEigensolverDC
+    {
+    public:
+        // The number of columns of a panel of the tridiagonalization, the
+        // number of columns of the blocks of its updates, the number of
+        // columns of the blocks of its symmetric matrix-vector products and
+        // the number of rows of the tridiagonal matrices solved with the
+        // implicit QR algorithm.
+        enum
+        {
+            PANEL_SIZE = 32,
+            UPDATE_BLOCK_SIZE = 256,
+            PRODUCT_BLOCK_SIZE = 512,
+            LEAF_SIZE = 32
+        };
+
+        // The solver processes NxN symmetric matrices, where N > 1 ('size'
+        // is N) and the matrix is stored in row-major order.
+        SymmetricEigensolverDC(int size, size_t numThreads = 1)
+            :
+            mSize(0),
+            mNumThreads(std::max(numThreads, static_cast<size_t>(1))),
+            mScheduler(nullptr),
+            mHasEigenvectors(false)
+        {
+            if (size > 1)
+            {
+                mSize = size;
+                mMatrix.resize(static_cast<size_t>(size) * static_cast<size_t>(size));
+                mDiagonal.resize(size);
+                mSubdiagonal.resize(static_cast<size_t>(size) - 1);
+                mTau.resize(static_cast<size_t>(size) - 1);
+            }
+        }
+
+        // Execute the work as tasks of the scheduler, which can be shared
+        // with other computations, instead of creating threads for each
+        // call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
+
+        // A copy of the NxN symmetric input is made internally. The order of
+        // the eigenvalues is specified by sortType: -1 (decreasing) or +1
+        // (increasing); the divide-and-conquer produces increasing
+        // eigenvalues, so 0 (no sorting) is the same as +1. When sorted, the
+        // eigenvectors are ordered accordingly. When 'computeEigenvectors'
+        // is 'false', only the eigenvalues are computed, with the implicit
+        // QR algorithm for the tridiagonal matrix. The return value is
+        // 'true' when the iterations converged, 'false' when they did not
+        // or when N <= 1 was passed to the constructor.
+        bool Solve(Real const* input, int sortType, bool computeEigenvectors = true)
+        {
+            mHasEigenvectors = false;
+            if (mSize == 0)
+            {
+                return false;
+            }
+
+            // The symmetric matrix in row-major order is also the matrix
+            // in column-major order. The lower triangle is used.
+            std::copy(input, input + mMatrix.size(), mMatrix.begin());
+            Tridiagonalize();
+
+            bool converged;
+            if (computeEigenvectors)
+            {
+                mEigenvectors.assign(mMatrix.size(), (Real)0);
+                converged = Divide(0, mSize, mNumThreads);
+                if (converged)
+                {
+                    ApplyQ();
+                    mHasEigenvectors = true;
+                }
+            }
+            else
+            {
+                mEigenvectors.clear();
+                converged = SolveLeaf(0, mSize);
+            }
+
+            if (converged && sortType < 0)
+            {
+                std::reverse(mDiagonal.begin(), mDiagonal.end());
+                if (mHasEigenvectors)
+                {
+                    size_t const N = static_cast<size_t>(mSize);
+                    for (size_t c0 = 0, c1 = N - 1; c0 < c1; ++c0, --c1)
+                    {
+                        std::swap_ranges(&mEigenvectors[c0 * N], &mEigenvectors[c0 * N] + N,
+                            &mEigenvectors[c1 * N]);
+                    }
+                }
+            }
+            return converged;
+        }
+
+        // Get the eigenvalues of the matrix passed to Solve(...). The input
+        // 'eigenvalues' must have N elements.
+        void GetEigenvalues(Real* eigenvalues) const
+        {
+            if (eigenvalues && mSize > 0)
+            {
+                std::copy(mDiagonal.begin(), mDiagonal.end(), eigenvalues);
+            }
+        }
+
+        Real GetEigenvalue(int c) const
+        {
+            if (0 <= c && c < mSize)
+            {
+                return mDiagonal[c];
+            }
+            else
+            {
+                return std::numeric_limits<Real>::max();
+            }
+        }
+
+        // Get the orthogonal matrix Q for which Q^T*A*Q = D. The input
+        // 'eigenvectors' must have N*N elements. As in SymmetricEigensolver,
+        // the array is filled in as if the matrix is stored in row-major
+        // order and the i-th eigenvector is the i-th column of the matrix.
+        // The eigenvectors are available only when Solve(...) was called
+        // with computeEigenvectors set to 'true'.
+        void GetEigenvectors(Real* eigenvectors) const
+        {
+            if (eigenvectors && mHasEigenvectors)
+            {
+                size_t const N = static_cast<size_t>(mSize);
+                for (size_t r = 0; r < N; ++r)
+                {
+                    for (size_t c = 0; c < N; ++c)
+                    {
+                        eigenvectors[r * N + c] = mEigenvectors[r + c * N];
+                    }
+                }
+            }
+        }
+
+        // Get the eigenvector for eigenvalue c. The input 'eigenvector'
+        // must have N elements.
+        void GetEigenvector(int c, Real* eigenvector) const
+        {
+            if (eigenvector && mHasEigenvectors && 0 <= c && c < mSize)
+            {
+                size_t const N = static_cast<size_t>(mSize);
+                Real const* source = &mEigenvectors[static_cast<size_t>(c) * N];
+                std::copy(source, source + N, eigenvector);
+            }
+        }
+
+    private:
+        // Reduce the column-major mMatrix to tridiagonal form. On output,
+        // the diagonal and subdiagonal are in mDiagonal and mSubdiagonal.
+        // The reflection H_k = I - tau*v*v^T that annihilates column k
+        // below the subdiagonal has v[k+1] = 1, the elements v[k+2..N-1]
+        // below the subdiagonal of column k of mMatrix and tau in mTau[k].
+        void Tridiagonalize()
+        {
+            int const N = mSize;
+            size_t const ld = static_cast<size_t>(N);
+            std::vector<Real> W(ld * PANEL_SIZE), negV, negW;
+            for (int j0 = 0; j0 < N - 1; j0 += PANEL_SIZE)
+            {
+                int const nb = std::min(static_cast<int>(PANEL_SIZE), N - 1 - j0);
+                int const m = N - j0;
+                Real* P = &mMatrix[j0 + ld * j0];
+                ReducePanel(j0, m, nb, P, W.data());
+
+                // Apply the rank-2k update A <- A - V*W^T - W*V^T to the
+                // lower triangle of the trailing matrix, by blocks of
+                // columns. The diagonal blocks are updated as full blocks.
+                int const mt = m - nb;
+                negV.resize(static_cast<size_t>(mt) * nb);
+                negW.resize(static_cast<size_t>(mt) * nb);
+                for (int c = 0; c < nb; ++c)
+                {
+                    for (int r = 0; r < mt; ++r)
+                    {
+                        negV[r + static_cast<size_t>(c) * mt] = -P[(nb + r) + ld * c];
+                        negW[r + static_cast<size_t>(c) * mt] = -W[(nb + r) + ld * c];
+                    }
+                }
+
+                Real* C = P + nb + ld * nb;
+                for (int cb = 0; cb < mt; cb += UPDATE_BLOCK_SIZE)
+                {
+                    int const cw = std::min(static_cast<int>(UPDATE_BLOCK_SIZE), mt - cb);
+                    int const rows = mt - cb;
+                    Real* block = C + cb + ld * cb;
+                    BlockedMatrixProduct<Real>::Execute(rows, cw, nb,
+                        negV.data() + cb, 1, mt, W.data() + nb + cb, N, 1,
+                        block, 1, N, mNumThreads, mScheduler);
+                    BlockedMatrixProduct<Real>::Execute(rows, cw, nb,
+                        negW.data() + cb, 1, mt, P + nb + cb, N, 1,
+                        block, 1, N, mNumThreads, mScheduler);
+                }
+            }
+            mDiagonal[N - 1] = mMatrix[(ld - 1) + ld * (ld - 1)];
+        }
+
+        // Reduce the first nb columns of the mxm trailing matrix P at row
+        // and column j0, where element (r,c) is P[r + N*c]. The vectors v of
+        // the reflections are stored in the columns of P with v[k+1] = 1
+        // explicit, and W is the mxnb matrix, element (r,c) at W[r + N*c],
+        // for which the update of the trailing matrix is P - V*W^T - W*V^T.
+        void ReducePanel(int j0, int m, int nb, Real* P, Real* W)
+        {
+            size_t const ld = static_cast<size_t>(mSize);
+            for (int i = 0; i < nb; ++i)
+            {
+                // Update column i with the reflections of columns 0..i-1.
+                Real* a = P + ld * i;
+                for (int c = 0; c < i; ++c)
+                {
+                    Real const* pc = P + ld * c;
+                    Real const* wc = W + ld * c;
+                    Real const wic = wc[i], pic = pc[i];
+                    for (int r = i; r < m; ++r)
+                    {
+                        a[r] -= pc[r] * wic + wc[r] * pic;
+                    }
+                }
+                mDiagonal[j0 + i] = a[i];
+
+                // Generate the reflection that annihilates a[i+2..m-1].
+                int const l = m - i - 1;
+                Real* v = a + i + 1;
+                Real const tau = MakeReflection(l, v);
+                mTau[j0 + i] = tau;
+                mSubdiagonal[j0 + i] = v[0];
+                v[0] = (Real)1;
+
+                // Compute column i of W, w = tau*(A - V*W^T - W*V^T)*v
+                // (with the columns 0..i-1 of V and W) followed by
+                // w <- w - (tau/2)*Dot(w,v)*v.
+                Real* w = W + ld * i + i + 1;
+                SymmetricProduct(l, P + (i + 1) + ld * (i + 1), v, w);
+                if (i > 0)
+                {
+                    // The rows 0..i-1 of column i of W are temporary
+                    // storage.
+                    Real* t = W + ld * i;
+                    for (int c = 0; c < i; ++c)
+                    {
+                        Real const* wc = W + ld * c + i + 1;
+                        Real sum = (Real)0;
+                        for (int r = 0; r < l; ++r)
+                        {
+                            sum += wc[r] * v[r];
+                        }
+                        t[c] = sum;
+                    }
+                    for (int c = 0; c < i; ++c)
+                    {
+                        Real const* pc = P + ld * c + i + 1;
+                        for (int r = 0; r < l; ++r)
+                        {
+                            w[r] -= pc[r] * t[c];
+                        }
+                    }
+                    for (int c = 0; c < i; ++c)
+                    {
+                        Real const* pc = P + ld * c + i + 1;
+                        Real sum = (Real)0;
+                        for (int r = 0; r < l; ++r)
+                        {
+                            sum += pc[r] * v[r];
+                        }
+                        t[c] = sum;
+                    }
+                    for (int c = 0; c < i; ++c)
+                    {
+                        Real const* wc = W + ld * c + i + 1;
+                        for (int r = 0; r < l; ++r)
+                        {
+                            w[r] -= wc[r] * t[c];
+                        }
+                    }
+                }
+
+                Real dot = (Real)0;
+                for (int r = 0; r < l; ++r)
+                {
+                    w[r] *= tau;
+                    dot += w[r] * v[r];
+                }
+                Real const alpha = (Real)-0.5 * tau * dot;
+                for (int r = 0; r < l; ++r)
+                {
+                    w[r] += alpha * v[r];
+                }
+            }
+        }
+
+        // Compute y = S*v for the lxl symmetric S stored in the lower
+        // triangle, element (r,c) at S[r + N*c]. The columns are processed
+        // in blocks of PRODUCT_BLOCK_SIZE, each block computing its own
+        // partial sums, and the partial sums are added in the order of the
+        // blocks. The blocks are distributed cyclically over the threads.
+        void SymmetricProduct(int l, Real const* S, Real const* v, Real* y) const
+        {
+            size_t const ld = static_cast<size_t>(mSize);
+            int const numBlocks = (l + PRODUCT_BLOCK_SIZE - 1) / PRODUCT_BLOCK_SIZE;
+            std::vector<Real> partial(static_cast<size_t>(numBlocks) * l);
+
+            auto computeBlocks = [l, S, v, ld, numBlocks, &partial](size_t t, size_t numThreads)
+            {
+                for (int b = static_cast<int>(t); b < numBlocks; b += static_cast<int>(numThreads))
+                {
+                    int const c0 = b * PRODUCT_BLOCK_SIZE;
+                    int const c1 = std::min(c0 + static_cast<int>(PRODUCT_BLOCK_SIZE), l);
+                    Real* sum = &partial[static_cast<size_t>(b) * l];
+                    std::fill(sum + c0, sum + l, (Real)0);
+                    for (int c = c0; c < c1; ++c)
+                    {
+                        Real const* column = S + ld * c;
+                        Real const vc = v[c];
+                        Real dot = column[c] * vc;
+                        for (int r = c + 1; r < l; ++r)
+                        {
+                            sum[r] += column[r] * vc;
+                            dot += column[r] * v[r];
+                        }
+                        sum[c] += dot;
+                    }
+                }
+            };
+
+            size_t const numThreads = std::max(std::min(mNumThreads, static_cast<size_t>(numBlocks)), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numThreads, [&computeBlocks, numThreads](size_t t)
+            {
+                computeBlocks(t, numThreads);
+            });
+
+            // The block b has no contribution to the rows before it.
+            for (int r = 0; r < l; ++r)
+            {
+                Real sum = (Real)0;
+                for (int b = 0; b <= r / PRODUCT_BLOCK_SIZE; ++b)
+                {
+                    sum += partial[static_cast<size_t>(b) * l + r];
+                }
+                y[r] = sum;
+            }
+        }
+
+        // Compute the reflection H = I - tau*v*v^T with H*x = (beta,0,...,0)
+        // for the m elements of x. On return, x[0] is beta and x[1..m-1]
+        // are v[1..m-1] (v[0] = 1). The return value is tau, which is zero
+        // when x[1..m-1] is zero.
+        static Real MakeReflection(int m, Real* x)
+        {
+            Real sqrLength = (Real)0;
+            for (int i = 1; i < m; ++i)
+            {
+                sqrLength += x[i] * x[i];
+            }
+            if (sqrLength == (Real)0)
+            {
+                return (Real)0;
+            }
+
+            Real const alpha = x[0];
+            Real const length = std::sqrt(alpha * alpha + sqrLength);
+            Real const beta = (alpha >= (Real)0 ? -length : length);
+            Real const invDenom = (Real)1 / (alpha - beta);
+            for (int i = 1; i < m; ++i)
+            {
+                x[i] *= invDenom;
+            }
+            x[0] = beta;
+            return (beta - alpha) / beta;
+        }
+
+        // Compute the eigenvalues and eigenvectors of the tridiagonal
+        // block of rows lo..lo+m-1. On return, the eigenvalues are in
+        // mDiagonal[lo..lo+m-1] in increasing order and the eigenvectors
+        // are the columns of the block of mEigenvectors at row and column
+        // lo. The blocks of mEigenvectors outside the diagonal blocks of
+        // the halves are zero on input.
+        bool Divide(int lo, int m, size_t numThreads)
+        {
+            if (m <= LEAF_SIZE)
+            {
+                return SolveLeaf(lo, m);
+            }
+
+            // T = diag(T0,T1) + |beta|*u*u^T, where beta is the subdiagonal
+            // element that couples the halves, u[m1-1] = 1, u[m1] =
+            // sign(beta) and the other elements of u are zero.
+            int const m1 = m / 2;
+            Real const absBeta = std::fabs(mSubdiagonal[static_cast<size_t>(lo) + m1 - 1]);
+            mDiagonal[static_cast<size_t>(lo) + m1 - 1] -= absBeta;
+            mDiagonal[static_cast<size_t>(lo) + m1] -= absBeta;
+
+            bool converged0, converged1;
+            if (numThreads > 1)
+            {
+                size_t const numThreads0 = numThreads / 2;
+                TaskScheduler::ParallelFor(mScheduler, 2,
+                    [this, &converged0, &converged1, lo, m1, m, numThreads, numThreads0](size_t half)
+                    {
+                        if (half == 0)
+                        {
+                            converged0 = Divide(lo, m1, numThreads0);
+                        }
+                        else
+                        {
+                            converged1 = Divide(lo + m1, m - m1, numThreads - numThreads0);
+                        }
+                    });
+            }
+            else
+            {
+                converged0 = Divide(lo, m1, 1);
+                converged1 = Divide(lo + m1, m - m1, 1);
+            }
+
+            if (converged0 && converged1)
+            {
+                Merge(lo, m1, m, numThreads);
+                return true;
+            }
+            return false;
+        }
+
+        // Merge the solutions of the halves of the block of rows lo..lo+m-1,
+        // the first half having m1 rows. With Q = diag(Q0,Q1) and
+        // D = diag(D0,D1) the eigendecompositions of the halves,
+        // T = Q*(D + rho*z*z^T)*Q^T with z = Q^T*u/sqrt(2) of unit length
+        // and rho = 2*|beta|.
+        void Merge(int lo, int m1, int m, size_t numThreads)
+        {
+            size_t const ld = static_cast<size_t>(mSize);
+            size_t const um = static_cast<size_t>(m);
+            int const m2 = m - m1;
+            Real* Q = &mEigenvectors[lo + ld * lo];
+            Real* D = &mDiagonal[lo];
+            Real const beta = mSubdiagonal[static_cast<size_t>(lo) + m1 - 1];
+            Real const rho = std::fabs(beta) * (Real)2;
+            Real const sgn = (beta >= (Real)0 ? (Real)1 : (Real)-1);
+            Real const invSqrt2 = std::sqrt((Real)0.5);
+
+            // z is the last row of Q0 and sign(beta) times the first row of
+            // Q1, divided by sqrt(2).
+            std::vector<Real> z(m);
+            for (int k = 0; k < m1; ++k)
+            {
+                z[k] = Q[(m1 - 1) + ld * k] * invSqrt2;
+            }
+            for (int k = 0; k < m2; ++k)
+            {
+                z[m1 + k] = sgn * Q[m1 + ld * (m1 + k)] * invSqrt2;
+            }
+
+            // Merge the increasing eigenvalues of the halves.
+            std::vector<int> order(m);
+            for (int k = 0; k < m; ++k)
+            {
+                order[k] = k;
+            }
+            std::inplace_merge(order.begin(), order.begin() + m1, order.end(),
+                [D](int k0, int k1) { return D[k0] < D[k1]; });
+
+            // Deflation. A pair (d,z) with rho*|z| small is an eigenpair of
+            // D + rho*z*z^T. Of two nearly equal d, a rotation of their
+            // columns zeroes one z, which is then deflated. The column
+            // types are 1 (nonzero only in the rows of the first half), 2
+            // (nonzero in all rows, the result of a rotation of columns of
+            // different halves) or 3 (nonzero only in the rows of the
+            // second half).
+            Real dmax = (Real)0, zmax = (Real)0;
+            for (int k = 0; k < m; ++k)
+            {
+                dmax = std::max(dmax, std::fabs(D[k]));
+                zmax = std::max(zmax, std::fabs(z[k]));
+            }
+            Real const tol = (Real)8 * std::numeric_limits<Real>::epsilon() * std::max(dmax, zmax);
+
+            std::vector<int> type(m), nondeflated, deflated;
+            nondeflated.reserve(m);
+            deflated.reserve(m);
+            for (int k = 0; k < m; ++k)
+            {
+                type[k] = (k < m1 ? 1 : 3);
+            }
+            int prev = -1;
+            for (int t = 0; t < m; ++t)
+            {
+                int const k = order[t];
+                if (rho * std::fabs(z[k]) <= tol)
+                {
+                    deflated.push_back(k);
+                    continue;
+                }
+                if (prev < 0)
+                {
+                    prev = k;
+                    continue;
+                }
+
+                Real s = z[prev], c = z[k];
+                Real const tau = std::sqrt(c * c + s * s);
+                Real const d = D[k] - D[prev];
+                c /= tau;
+                s = -s / tau;
+                if (std::fabs(d * c * s) <= tol)
+                {
+                    z[k] = tau;
+                    z[prev] = (Real)0;
+                    Real* q0 = Q + ld * prev;
+                    Real* q1 = Q + ld * k;
+                    for (int r = 0; r < m; ++r)
+                    {
+                        Real const x = q0[r], y = q1[r];
+                        q0[r] = c * x + s * y;
+                        q1[r] = c * y - s * x;
+                    }
+                    if (type[prev] != type[k])
+                    {
+                        type[prev] = 2;
+                        type[k] = 2;
+                    }
+                    Real const c2 = c * c, s2 = s * s;
+                    Real const dprev = D[prev] * c2 + D[k] * s2;
+                    D[k] = D[prev] * s2 + D[k] * c2;
+                    D[prev] = dprev;
+                    deflated.push_back(prev);
+                }
+                else
+                {
+                    nondeflated.push_back(prev);
+                }
+                prev = k;
+            }
+            if (prev >= 0)
+            {
+                nondeflated.push_back(prev);
+            }
+
+            // Copy the nondeflated columns to Qc grouped by type, and the
+            // deflated columns to Qd. The row of the secular eigenvector
+            // matrix S for nondeflated column j is group[j].
+            int const K = static_cast<int>(nondeflated.size());
+            size_t const uK = static_cast<size_t>(K);
+            int numType[4] = { 0, 0, 0, 0 };
+            for (auto k : nondeflated)
+            {
+                ++numType[type[k]];
+            }
+            int next[4] = { 0, 0, numType[1], numType[1] + numType[2] };
+            std::vector<int> group(K);
+            std::vector<Real> Qc(um * uK), Qd(um * (um - uK));
+            for (int j = 0; j < K; ++j)
+            {
+                int const k = nondeflated[j];
+                group[j] = next[type[k]]++;
+                Real const* source = Q + ld * k;
+                std::copy(source, source + m, &Qc[um * group[j]]);
+            }
+            for (size_t j = 0; j < deflated.size(); ++j)
+            {
+                Real const* source = Q + ld * deflated[j];
+                std::copy(source, source + m, &Qd[um * j]);
+            }
+
+            // Solve the secular equation for the nondeflated eigenvalues.
+            std::vector<Real> dK(K), wK(K), tauK(K);
+            std::vector<int> originK(K);
+            for (int j = 0; j < K; ++j)
+            {
+                dK[j] = D[nondeflated[j]];
+                wK[j] = rho * z[nondeflated[j]] * z[nondeflated[j]];
+            }
+            Real sumW = (Real)0;
+            for (int j = 0; j < K; ++j)
+            {
+                sumW += wK[j];
+            }
+            size_t const numChunks = std::max(std::min(numThreads, static_cast<size_t>(K)), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks, [&](size_t c)
+            {
+                int const first = static_cast<int>(K * c / numChunks);
+                int const last = static_cast<int>(K * (c + 1) / numChunks);
+                for (int i = first; i < last; ++i)
+                {
+                    SolveSecular(K, dK.data(), wK.data(), sumW, i, originK[i], tauK[i]);
+                }
+            });
+
+            // S(group[j],i) = d[j] - lambda[i], with the difference computed
+            // relative to the pole at which the root i is computed.
+            std::vector<Real> S(uK * uK);
+            TaskScheduler::ParallelFor(mScheduler, numChunks, [&](size_t c)
+            {
+                int const first = static_cast<int>(K * c / numChunks);
+                int const last = static_cast<int>(K * (c + 1) / numChunks);
+                for (int i = first; i < last; ++i)
+                {
+                    Real const dOrigin = dK[originK[i]];
+                    Real* column = &S[uK * i];
+                    for (int j = 0; j < K; ++j)
+                    {
+                        column[group[j]] = (dK[j] - dOrigin) - tauK[i];
+                    }
+                }
+            });
+
+            // Recompute z so that the computed eigenvalues are the exact
+            // eigenvalues of D + rho*zhat*zhat^T. The common factor rho is
+            // omitted, because the eigenvectors are normalized.
+            std::vector<Real> zhat(K);
+            TaskScheduler::ParallelFor(mScheduler, numChunks, [&](size_t c)
+            {
+                int const first = static_cast<int>(K * c / numChunks);
+                int const last = static_cast<int>(K * (c + 1) / numChunks);
+                for (int j = first; j < last; ++j)
+                {
+                    zhat[j] = S[group[j] + uK * j];
+                }
+                for (int i = 0; i < K; ++i)
+                {
+                    Real const* column = &S[uK * i];
+                    for (int j = first; j < last; ++j)
+                    {
+                        if (j != i)
+                        {
+                            zhat[j] *= column[group[j]] / (dK[j] - dK[i]);
+                        }
+                    }
+                }
+                for (int j = first; j < last; ++j)
+                {
+                    Real const magnitude = std::sqrt(std::max(-zhat[j], (Real)0));
+                    zhat[j] = (z[nondeflated[j]] >= (Real)0 ? magnitude : -magnitude);
+                }
+            });
+
+            // The eigenvector for root i has elements zhat[j]/(d[j] -
+            // lambda[i]).
+            TaskScheduler::ParallelFor(mScheduler, numChunks, [&](size_t c)
+            {
+                int const first = static_cast<int>(K * c / numChunks);
+                int const last = static_cast<int>(K * (c + 1) / numChunks);
+                for (int i = first; i < last; ++i)
+                {
+                    Real* column = &S[uK * i];
+                    Real sqrLength = (Real)0;
+                    for (int j = 0; j < K; ++j)
+                    {
+                        Real& element = column[group[j]];
+                        element = zhat[j] / element;
+                        sqrLength += element * element;
+                    }
+                    Real const invLength = (Real)1 / std::sqrt(sqrLength);
+                    for (int j = 0; j < K; ++j)
+                    {
+                        column[j] *= invLength;
+                    }
+                }
+            });
+
+            // The eigenvectors for the roots are Qc*S, where the types 1
+            // and 2 contribute to the first m1 rows and the types 2 and 3
+            // to the last m2 rows. They are stored in columns 0..K-1 and
+            // are followed by the deflated columns.
+            for (int c = 0; c < m; ++c)
+            {
+                std::fill(Q + ld * c, Q + ld * c + m, (Real)0);
+            }
+            int const N = mSize;
+            BlockedMatrixProduct<Real>::Execute(m1, K, numType[1] + numType[2],
+                Qc.data(), 1, m, S.data(), 1, K, Q, 1, N, numThreads, mScheduler);
+            BlockedMatrixProduct<Real>::Execute(m2, K, numType[2] + numType[3],
+                Qc.data() + m1 + um * numType[1], 1, m, S.data() + numType[1], 1, K,
+                Q + m1, 1, N, numThreads, mScheduler);
+            for (size_t j = 0; j < deflated.size(); ++j)
+            {
+                std::copy(&Qd[um * j], &Qd[um * j] + m, Q + ld * (uK + j));
+            }
+
+            // Sort the eigenvalues and permute the columns accordingly.
+            // The column at position p is the one at position source[p].
+            std::vector<Real> value(m);
+            for (int i = 0; i < K; ++i)
+            {
+                value[i] = dK[originK[i]] + tauK[i];
+            }
+            for (size_t j = 0; j < deflated.size(); ++j)
+            {
+                value[uK + j] = D[deflated[j]];
+            }
+            std::vector<int> source(m);
+            for (int p = 0; p < m; ++p)
+            {
+                source[p] = p;
+            }
+            std::stable_sort(source.begin(), source.end(),
+                [&value](int p0, int p1) { return value[p0] < value[p1]; });
+            for (int p = 0; p < m; ++p)
+            {
+                D[p] = value[source[p]];
+            }
+
+            std::vector<char> visited(m, 0);
+            std::vector<Real> save(m);
+            for (int p = 0; p < m; ++p)
+            {
+                if (visited[p] == 0 && source[p] != p)
+                {
+                    std::copy(Q + ld * p, Q + ld * p + m, save.begin());
+                    int current = p, k;
+                    while ((k = source[current]) != p)
+                    {
+                        visited[current] = 1;
+                        std::copy(Q + ld * k, Q + ld * k + m, Q + ld * current);
+                        current = k;
+                    }
+                    visited[current] = 1;
+                    std::copy(save.begin(), save.end(), Q + ld * current);
+                }
+            }
+        }
+
+        // Compute root i of the secular equation
+        //   f(lambda) = 1 + sum_j w[j]/(d[j] - lambda) = 0
+        // for increasing d[j], w[j] = rho*z[j]^2 > 0 and sumW the sum of the
+        // w[j]. The root is in (d[i],d[i+1]) for i < K-1 and in
+        // (d[K-1],d[K-1]+sumW) for i = K-1. It is computed as
+        // lambda = d[origin] + tau with origin the closer of the poles, so
+        // the differences d[j] - lambda are accurate. Each iteration solves
+        // the equation for a model of f with the poles d[i] and d[i+1] that
+        // matches the values and derivatives of the sums over j <= i and
+        // j > i, as in
+        //   J.R. Bunch, C.P. Nielsen and D.C. Sorensen, Rank-one modification
+        //   of the symmetric eigenproblem, Numerische Mathematik 31 (1978),
+        //   31-48
+        // with bisection when the solution of the model is not in the
+        // bracket of the root.
+        static void SolveSecular(int K, Real const* d, Real const* w, Real sumW,
+            int i, int& origin, Real& tau)
+        {
+            Real const eps = std::numeric_limits<Real>::epsilon();
+            bool const isLast = (i == K - 1);
+            Real lo, hi;
+            if (isLast)
+            {
+                origin = i;
+                lo = (Real)0;
+                hi = sumW;
+            }
+            else
+            {
+                Real const halfGap = (d[i + 1] - d[i]) * (Real)0.5;
+                Real f = (Real)1;
+                for (int j = 0; j < K; ++j)
+                {
+                    f += w[j] / ((d[j] - d[i]) - halfGap);
+                }
+                if (f >= (Real)0)
+                {
+                    origin = i;
+                    lo = (Real)0;
+                    hi = halfGap;
+                }
+                else
+                {
+                    origin = i + 1;
+                    lo = -halfGap;
+                    hi = (Real)0;
+                }
+            }
+
+            Real const dOrigin = d[origin];
+            Real const a = d[i] - dOrigin;
+            Real const b = (isLast ? (Real)0 : d[i + 1] - dOrigin);
+            tau = (lo + hi) * (Real)0.5;
+            for (int iteration = 0; iteration < 128; ++iteration)
+            {
+                // psi is the sum over j <= i, phi the sum over j > i.
+                Real psi = (Real)0, dpsi = (Real)0, phi = (Real)0, dphi = (Real)0;
+                for (int j = 0; j <= i; ++j)
+                {
+                    Real const invDelta = (Real)1 / ((d[j] - dOrigin) - tau);
+                    Real const term = w[j] * invDelta;
+                    psi += term;
+                    dpsi += term * invDelta;
+                }
+                for (int j = i + 1; j < K; ++j)
+                {
+                    Real const invDelta = (Real)1 / ((d[j] - dOrigin) - tau);
+                    Real const term = w[j] * invDelta;
+                    phi += term;
+                    dphi += term * invDelta;
+                }
+
+                Real const f = (Real)1 + psi + phi;
+                if (f == (Real)0)
+                {
+                    return;
+                }
+                if (f > (Real)0)
+                {
+                    hi = tau;
+                }
+                else
+                {
+                    lo = tau;
+                }
+                Real const error = eps * ((Real)8 * (phi - psi) + (Real)2 +
+                    (Real)3 * std::fabs(tau) * (dpsi + dphi));
+                if (std::fabs(f) <= error)
+                {
+                    return;
+                }
+
+                // The model c + q/(a - tau) + s/(b - tau), where the last
+                // term is not present for the last root.
+                Real const deltaI = a - tau;
+                Real const q = dpsi * deltaI * deltaI;
+                Real c = (Real)1 + psi - dpsi * deltaI;
+                Real next;
+                if (isLast)
+                {
+                    next = (c > (Real)0 ? a + q / c : hi + (Real)1);
+                }
+                else
+                {
+                    Real const deltaI1 = b - tau;
+                    Real const s = dphi * deltaI1 * deltaI1;
+                    c += phi - dphi * deltaI1;
+
+                    // c*tau^2 + B*tau + C = 0.
+                    Real const B = -(c * (a + b) + q + s);
+                    Real const C = c * a * b + q * b + s * a;
+                    Real const discr = B * B - (Real)4 * c * C;
+                    next = hi + (Real)1;
+                    if (discr >= (Real)0)
+                    {
+                        Real const root = std::sqrt(discr);
+                        Real const temp = (Real)-0.5 * (B >= (Real)0 ? B + root : B - root);
+                        if (temp != (Real)0)
+                        {
+                            Real const t0 = C / temp;
+                            if (lo < t0 && t0 < hi)
+                            {
+                                next = t0;
+                            }
+                            else if (c != (Real)0)
+                            {
+                                next = temp / c;
+                            }
+                        }
+                    }
+                }
+
+                if (!(lo < next && next < hi))
+                {
+                    next = (lo + hi) * (Real)0.5;
+                    if (!(lo < next && next < hi))
+                    {
+                        // The bracket cannot be reduced further.
+                        return;
+                    }
+                }
+                tau = next;
+            }
+        }
+
+        // Compute the eigenvalues and, when mEigenvectors is not empty, the
+        // eigenvectors of the tridiagonal block of rows lo..lo+m-1 with the
+        // implicit QR algorithm of SymmetricEigensolver, applying the
+        // Givens rotations to the eigenvectors as they are generated. The
+        // eigenvalues are sorted in increasing order.
+        bool SolveLeaf(int lo, int m)
+        {
+            size_t const ld = static_cast<size_t>(mSize);
+            Real* d = &mDiagonal[lo];
+            std::vector<Real> e(mSubdiagonal.begin() + lo, mSubdiagonal.begin() + lo + m - 1);
+            Real* Q = (mEigenvectors.empty() ? nullptr : &mEigenvectors[lo + ld * lo]);
+            if (Q)
+            {
+                for (int c = 0; c < m; ++c)
+                {
+                    std::fill(Q + ld * c, Q + ld * c + m, (Real)0);
+                    Q[c + ld * c] = (Real)1;
+                }
+            }
+
+            bool converged = false;
+            unsigned int const maxIterations = 32 * static_cast<unsigned int>(m);
+            for (unsigned int j = 0; j < maxIterations; ++j)
+            {
+                int imin = -1, imax = -1;
+                for (int i = m - 2; i >= 0; --i)
+                {
+                    Real sum = std::fabs(d[i]) + std::fabs(d[i + 1]);
+                    if (sum + std::fabs(e[i]) != sum)
+                    {
+                        if (imax == -1)
+                        {
+                            imax = i;
+                        }
+                        imin = i;
+                    }
+                    else if (imin >= 0)
+                    {
+                        break;
+                    }
+                }
+
+                if (imax == -1)
+                {
+                    converged = true;
+                    break;
+                }
+                DoQRImplicitShift(d, e.data(), imin, imax, Q, m);
+            }
+            if (!converged)
+            {
+                return false;
+            }
+
+            std::vector<int> source(m);
+            for (int p = 0; p < m; ++p)
+            {
+                source[p] = p;
+            }
+            std::stable_sort(source.begin(), source.end(),
+                [d](int p0, int p1) { return d[p0] < d[p1]; });
+            std::vector<Real> sorted(m);
+            for (int p = 0; p < m; ++p)
+            {
+                sorted[p] = d[source[p]];
+            }
+            std::copy(sorted.begin(), sorted.end(), d);
+            if (Q)
+            {
+                size_t const um = static_cast<size_t>(m);
+                std::vector<Real> columns(um * um);
+                for (int p = 0; p < m; ++p)
+                {
+                    std::copy(Q + ld * source[p], Q + ld * source[p] + m, &columns[um * p]);
+                }
+                for (int p = 0; p < m; ++p)
+                {
+                    std::copy(&columns[um * p], &columns[um * p] + m, Q + ld * p);
+                }
+            }
+            return true;
+        }
+
+        // The QR step with implicit shift of SymmetricEigensolver for the
+        // block imin..imax+1 of the tridiagonal matrix (d,e). The rotations
+        // are applied to the columns of the mxm Q (element (r,c) at
+        // Q[r + N*c]) when it is not null.
+        void DoQRImplicitShift(Real* d, Real* e, int imin, int imax, Real* Q, int m) const
+        {
+            size_t const ld = static_cast<size_t>(mSize);
+            Real a00 = d[imax];
+            Real a01 = e[imax];
+            Real a11 = d[imax + 1];
+            Real dif = (a00 - a11) * (Real)0.5;
+            Real sgn = (dif >= (Real)0 ? (Real)1 : (Real)-1);
+            Real a01sqr = a01 * a01;
+            Real u = a11 - a01sqr / (dif + sgn * std::sqrt(dif * dif + a01sqr));
+            Real x = d[imin] - u;
+            Real y = e[imin];
+
+            Real a12, a22, a23, tmp11, tmp12, tmp21, tmp22, cs, sn;
+            Real a02 = (Real)0;
+            int i0 = imin - 1, i1 = imin, i2 = imin + 1;
+            for (/**/; i1 <= imax; ++i0, ++i1, ++i2)
+            {
+                GetSinCos(x, y, cs, sn);
+                if (Q)
+                {
+                    Real* q0 = Q + ld * i1;
+                    Real* q1 = q0 + ld;
+                    for (int r = 0; r < m; ++r)
+                    {
+                        Real prd0 = cs * q0[r] - sn * q1[r];
+                        Real prd1 = sn * q0[r] + cs * q1[r];
+                        q0[r] = prd0;
+                        q1[r] = prd1;
+                    }
+                }
+
+                if (i1 > imin)
+                {
+                    e[i0] = cs * e[i0] - sn * a02;
+                }
+
+                a11 = d[i1];
+                a12 = e[i1];
+                a22 = d[i2];
+                tmp11 = cs * a11 - sn * a12;
+                tmp12 = cs * a12 - sn * a22;
+                tmp21 = sn * a11 + cs * a12;
+                tmp22 = sn * a12 + cs * a22;
+                d[i1] = cs * tmp11 - sn * tmp12;
+                e[i1] = sn * tmp11 + cs * tmp12;
+                d[i2] = sn * tmp21 + cs * tmp22;
+
+                if (i1 < imax)
+                {
+                    a23 = e[i2];
+                    a02 = -sn * a23;
+                    e[i2] = cs * a23;
+                    x = e[i1];
+                    y = a02;
+                }
+            }
+        }
+
+        static void GetSinCos(Real x, Real y, Real& cs, Real& sn)
+        {
+            // Solves sn*x + cs*y = 0 robustly.
+            Real tau;
+            if (y != (Real)0)
+            {
+                if (std::fabs(y) > std::fabs(x))
+                {
+                    tau = -x / y;
+                    sn = (Real)1 / std::sqrt((Real)1 + tau * tau);
+                    cs = sn * tau;
+                }
+                else
+                {
+                    tau = -y / x;
+                    cs = (Real)1 / std::sqrt((Real)1 + tau * tau);
+                    sn = cs * tau;
+                }
+            }
+            else
+            {
+                cs = (Real)1;
+                sn = (Real)0;
+            }
+        }
+
+        // Replace the eigenvectors X of the tridiagonal matrix by Q*X, where
+        // Q = H_0*...*H_{N-2}. The reflections of a panel at column j0 are
+        // H_{j0}*...*H_{j0+nb-1} = I - Y*T*Y^T, applied to the rows j0+1..N-1
+        // of X, the last panel first.
+        void ApplyQ()
+        {
+            int const N = mSize;
+            size_t const ld = static_cast<size_t>(N);
+            int const numPanels = (N - 1 + PANEL_SIZE - 1) / PANEL_SIZE;
+            std::vector<Real> T(static_cast<size_t>(PANEL_SIZE) * PANEL_SIZE);
+            for (int panel = numPanels - 1; panel >= 0; --panel)
+            {
+                int const j0 = panel * PANEL_SIZE;
+                int const nb = std::min(static_cast<int>(PANEL_SIZE), N - 1 - j0);
+                int const m = N - 1 - j0;
+                size_t const um = static_cast<size_t>(m);
+
+                // Copy Y with the implied ones and zeros; column-major with
+                // leading dimension m, row 0 the row j0+1 of the matrix.
+                std::vector<Real> Y(um * nb, (Real)0);
+                for (int k = 0; k < nb; ++k)
+                {
+                    Real* y = &Y[um * k];
+                    Real const* source = &mMatrix[(j0 + 1) + ld * (j0 + k)];
+                    y[k] = (Real)1;
+                    std::copy(source + k + 1, source + m, y + k + 1);
+                }
+
+                // T(0:k,k) = -tau[k] * T(0:k,0:k) * Y(:,0:k)^T * y_k and
+                // T(k,k) = tau[k], stored in row-major order.
+                std::fill(T.begin(), T.end(), (Real)0);
+                std::vector<Real> z(nb);
+                for (int k = 0; k < nb; ++k)
+                {
+                    Real const* yk = &Y[um * k];
+                    for (int i = 0; i < k; ++i)
+                    {
+                        Real const* yi = &Y[um * i];
+                        Real dot = (Real)0;
+                        for (int r = k; r < m; ++r)
+                        {
+                            dot += yi[r] * yk[r];
+                        }
+                        z[i] = dot;
+                    }
+                    Real const tau = mTau[static_cast<size_t>(j0) + k];
+                    for (int i = 0; i < k; ++i)
+                    {
+                        Real sum = (Real)0;
+                        for (int l = i; l < k; ++l)
+                        {
+                            sum += T[static_cast<size_t>(i) * PANEL_SIZE + l] * z[l];
+                        }
+                        T[static_cast<size_t>(i) * PANEL_SIZE + k] = -tau * sum;
+                    }
+                    T[static_cast<size_t>(k) * PANEL_SIZE + k] = tau;
+                }
+
+                // W = X^T*Y is N x nb, stored in row-major order.
+                Real* X = &mEigenvectors[j0 + 1];
+                std::vector<Real> W(ld * nb, (Real)0);
+                BlockedMatrixProduct<Real>::Execute(N, nb, m,
+                    X, N, 1, Y.data(), 1, m, W.data(), nb, 1, mNumThreads, mScheduler);
+
+                // Z = -T*W^T is nb x N, stored in row-major order.
+                std::vector<Real> Z(static_cast<size_t>(nb) * ld);
+                for (int i = 0; i < nb; ++i)
+                {
+                    for (int c = 0; c < N; ++c)
+                    {
+                        Real const* wc = &W[static_cast<size_t>(c) * nb];
+                        Real sum = (Real)0;
+                        for (int l = i; l < nb; ++l)
+                        {
+                            sum += T[static_cast<size_t>(i) * PANEL_SIZE + l] * wc[l];
+                        }
+                        Z[static_cast<size_t>(i) * ld + c] = -sum;
+                    }
+                }
+
+                // X <- X + Y*Z.
+                BlockedMatrixProduct<Real>::Execute(m, N, nb,
+                    Y.data(), 1, m, Z.data(), N, 1, X, 1, N, mNumThreads, mScheduler);
+            }
+        }
+
+        int mSize;
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
+
+        // The column-major copy of the input, which stores the Householder
+        // vectors of the tridiagonalization below the subdiagonal.
+        std::vector<Real> mMatrix;
+
+        // The tridiagonal matrix and the scales of the reflections. The
+        // diagonal is replaced by the eigenvalues.
+        std::vector<Real> mDiagonal, mSubdiagonal, mTau;
+
+        // The eigenvectors in column-major storage.
+        std::vector<Real> mEigenvectors;
+        bool mHasEigenvectors;
+    };
+}
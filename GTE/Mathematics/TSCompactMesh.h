@@ -0,0 +1,218 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/TetrahedronKey.h>
+#include <Mathematics/TriangleKey.h>
+#include <array>
+#include <map>
+#include <vector>
+
+// A manifold tetrahedral mesh with index-based storage, an alternative to
+// TSManifoldMesh for algorithms that insert and remove many tetrahedra,
+// such as Delaunay3. TSManifoldMesh allocates a Tetrahedron and a Triangle
+// object per simplex, each managed by std::shared_ptr and stored in a
+// std::map, and adjacency is represented by std::weak_ptr. TSCompactMesh
+// stores the vertex indices and the adjacent tetrahedron indices of the
+// tetrahedra in contiguous arrays. The slots of removed tetrahedra are
+// kept on a free list and reused by later insertions. The only map is the
+// set of open faces, those faces shared by one tetrahedron, which is used
+// to connect a new tetrahedron to its neighbors. For a mesh of a convex
+// region these are the faces of the boundary. A tetrahedron occupies 32
+// bytes compared to several hundred bytes for TSManifoldMesh.
+//
+// The vertex and face orderings are those of TSManifoldMesh. The vertices
+// of face j, which is opposite vertex j, are V[GetOppositeFace()[j][k]]
+// for k = 0,1,2, where GetOppositeFace() is that of TetrahedronKey. The
+// face vertices are counterclockwise when viewed from outside the
+// tetrahedron. S[j] is the index of the tetrahedron sharing face j or -1
+// when face j is open.
+//
+// Unlike TSManifoldMesh, the mesh does not store the faces with two
+// tetrahedra, so the insertion of a tetrahedron with a face that is
+// already shared by two tetrahedra cannot be detected. It is detected
+// when the face is open, in which case the orientation of the face must be
+// opposite that of the open face.
+
+namespace gte
+{
+    class TSCompactMesh
+    {
+    public:
+        // The open faces are keyed by their unordered vertices.
+        typedef std::map<TriangleKey<false>, int> OpenFaceMap;
+
+        TSCompactMesh()
+            :
+            mNumTetrahedra(0)
+        {
+        }
+
+        void Clear()
+        {
+            mV.clear();
+            mS.clear();
+            mFree.clear();
+            mOpenFaces.clear();
+            mNumTetrahedra = 0;
+        }
+
+        // Preallocate storage for the specified number of tetrahedra.
+        void Reserve(size_t numTetrahedra)
+        {
+            mV.reserve(numTetrahedra);
+            mS.reserve(numTetrahedra);
+        }
+
+        // Insert the tetrahedron <v0,v1,v2,v3> and return its index. The
+        // insertion fails when a face of the tetrahedron matches an open
+        // face with the same orientation, in which case -1 is returned and
+        // the mesh is unchanged.
+        int Insert(int v0, int v1, int v2, int v3)
+        {
+            std::array<int, 4> const V = { v0, v1, v2, v3 };
+            auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+            std::array<OpenFaceMap::iterator, 4> iters;
+            for (int j = 0; j < 4; ++j)
+            {
+                int f0 = V[opposite[j][0]];
+                int f1 = V[opposite[j][1]];
+                int f2 = V[opposite[j][2]];
+                iters[j] = mOpenFaces.find(TriangleKey<false>(f0, f1, f2));
+                if (iters[j] != mOpenFaces.end())
+                {
+                    // The shared face must have the opposite orientation in
+                    // the adjacent tetrahedron.
+                    int adj = iters[j]->second / 4;
+                    int k = iters[j]->second % 4;
+                    TriangleKey<true> key(f0, f1, f2);
+                    TriangleKey<true> adjKey(mV[adj][opposite[k][0]], mV[adj][opposite[k][2]],
+                        mV[adj][opposite[k][1]]);
+                    if (key != adjKey)
+                    {
+                        return -1;
+                    }
+                }
+            }
+
+            int t;
+            if (mFree.size() > 0)
+            {
+                t = mFree.back();
+                mFree.pop_back();
+                mV[t] = V;
+            }
+            else
+            {
+                t = static_cast<int>(mV.size());
+                mV.push_back(V);
+                mS.push_back(std::array<int, 4>{});
+            }
+            ++mNumTetrahedra;
+
+            for (int j = 0; j < 4; ++j)
+            {
+                if (iters[j] != mOpenFaces.end())
+                {
+                    int adj = iters[j]->second / 4;
+                    int k = iters[j]->second % 4;
+                    mS[t][j] = adj;
+                    mS[adj][k] = t;
+                    mOpenFaces.erase(iters[j]);
+                }
+                else
+                {
+                    mS[t][j] = -1;
+                    mOpenFaces.insert(std::make_pair(TriangleKey<false>(V[opposite[j][0]],
+                        V[opposite[j][1]], V[opposite[j][2]]), 4 * t + j));
+                }
+            }
+            return t;
+        }
+
+        // Remove the tetrahedron with index t. The faces shared with
+        // adjacent tetrahedra become open faces of those tetrahedra.
+        bool Remove(int t)
+        {
+            if (!IsValid(t))
+            {
+                return false;
+            }
+
+            auto const& opposite = TetrahedronKey<true>::GetOppositeFace();
+            std::array<int, 4> const& V = mV[t];
+            for (int j = 0; j < 4; ++j)
+            {
+                TriangleKey<false> key(V[opposite[j][0]], V[opposite[j][1]], V[opposite[j][2]]);
+                int adj = mS[t][j];
+                if (adj >= 0)
+                {
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        if (mS[adj][k] == t)
+                        {
+                            mS[adj][k] = -1;
+                            mOpenFaces.insert(std::make_pair(key, 4 * adj + k));
+                            break;
+                        }
+                    }
+                }
+                else
+                {
+                    mOpenFaces.erase(key);
+                }
+            }
+
+            mV[t][0] = -1;
+            mFree.push_back(t);
+            --mNumTetrahedra;
+            return true;
+        }
+
+        // Member access. The indices of the tetrahedra are in
+        // [0,GetNumSlots()), where the slots of removed tetrahedra are not
+        // valid.
+        inline int GetNumSlots() const
+        {
+            return static_cast<int>(mV.size());
+        }
+
+        inline int GetNumTetrahedra() const
+        {
+            return mNumTetrahedra;
+        }
+
+        inline bool IsValid(int t) const
+        {
+            return 0 <= t && t < static_cast<int>(mV.size()) && mV[t][0] >= 0;
+        }
+
+        inline std::array<int, 4> const& GetVertices(int t) const
+        {
+            return mV[t];
+        }
+
+        inline std::array<int, 4> const& GetAdjacents(int t) const
+        {
+            return mS[t];
+        }
+
+        // The open faces of the mesh. The value 4*t+j of an element
+        // identifies face j of tetrahedron t.
+        inline OpenFaceMap const& GetOpenFaces() const
+        {
+            return mOpenFaces;
+        }
+
+    private:
+        std::vector<std::array<int, 4>> mV, mS;
+        std::vector<int> mFree;
+        OpenFaceMap mOpenFaces;
+        int mNumTetrahedra;
+    };
+}
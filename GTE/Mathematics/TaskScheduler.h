@@ -0,0 +1,402 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// A fork-join task scheduler with work stealing for divide-and-conquer
+// algorithms. The scheduler owns numThreads-1 worker threads that are
+// created once and reused for all tasks, so an object can be shared by many
+// calls of an algorithm without the cost of creating threads per call. The
+// thread that calls Wait also executes tasks, so numThreads threads execute
+// tasks in total.
+//
+// Each worker has a queue of tasks. A task spawned by a worker is added to
+// the back of the worker's queue and the worker executes the tasks of its
+// queue from the back, which is the most recently spawned and usually the
+// smallest subproblem. An idle worker steals tasks from the fronts of the
+// queues of the other workers, which are the oldest and usually the largest
+// subproblems. Tasks spawned by threads that are not workers of the
+// scheduler are added to a queue shared by those threads. A thread that
+// waits for a group of tasks executes other tasks until the group is
+// finished, so nested Spawn/Wait pairs do not block workers.
+//
+// A typical use is
+//   TaskScheduler::TaskGroup group;
+//   scheduler.Spawn(group, [&]() { Solve(subproblem0); });
+//   Solve(subproblem1);
+//   scheduler.Wait(group);
+//   Merge(subproblem0, subproblem1);
+//
+// Loops whose iterations are partitioned into independent chunks are
+// executed by ParallelFor. The static ParallelFor accepts a null scheduler,
+// in which case a std::thread is created for each chunk, so algorithms can
+// support both a shared scheduler and their own threads with one code path.
+// Sharing one scheduler among the algorithms avoids the cost of creating
+// threads per call, and nested calls do not oversubscribe the machine
+// because all tasks are executed by the threads of the scheduler.
+//
+// Spawn and Wait may be called concurrently from any threads. A TaskGroup
+// must not be destroyed before Wait returns for it. Tasks must not throw
+// exceptions. The chunks of ParallelFor may throw; the first exception is
+// rethrown by ParallelFor after all the chunks are finished.
+
+namespace gte
+{
+    class TaskScheduler
+    {
+    public:
+        class TaskGroup
+        {
+        public:
+            TaskGroup()
+                :
+                mNumPending(0)
+            {
+            }
+
+            inline bool IsFinished() const
+            {
+                return mNumPending.load(std::memory_order_acquire) == 0;
+            }
+
+        private:
+            friend class TaskScheduler;
+            std::atomic<size_t> mNumPending;
+        };
+
+        // The number of threads that execute tasks includes the thread
+        // that calls Wait, so numThreads-1 workers are created. A value of
+        // 0 is treated as 1, in which case all tasks are executed by the
+        // thread that calls Wait.
+        TaskScheduler(size_t numThreads)
+            :
+            mQueues(numThreads > 1 ? numThreads : 1),
+            mNumQueued(0),
+            mStop(false)
+        {
+            size_t const numWorkers = mQueues.size() - 1;
+            mWorkers.reserve(numWorkers);
+            for (size_t i = 0; i < numWorkers; ++i)
+            {
+                mWorkers.emplace_back([this, i]() { WorkerLoop(i); });
+            }
+        }
+
+        ~TaskScheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mSleepMutex);
+                mStop = true;
+            }
+            mSleepCondition.notify_all();
+            for (auto& worker : mWorkers)
+            {
+                worker.join();
+            }
+        }
+
+        TaskScheduler(TaskScheduler const&) = delete;
+        TaskScheduler& operator=(TaskScheduler const&) = delete;
+
+        inline size_t GetNumThreads() const
+        {
+            return mQueues.size();
+        }
+
+        template <typename Function>
+        void Spawn(TaskGroup& group, Function&& function)
+        {
+            group.mNumPending.fetch_add(1, std::memory_order_relaxed);
+            Queue& queue = mQueues[GetQueueIndex()];
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.emplace_back(std::forward<Function>(function), &group);
+            }
+            mNumQueued.fetch_add(1, std::memory_order_release);
+
+            // Acquiring the mutex ensures that a worker that found no tasks
+            // is either waiting on the condition variable or will see the
+            // incremented mNumQueued.
+            {
+                std::lock_guard<std::mutex> lock(mSleepMutex);
+            }
+            mSleepCondition.notify_one();
+        }
+
+        // Execute tasks until all tasks of the group are finished.
+        void Wait(TaskGroup& group)
+        {
+            size_t const index = GetQueueIndex();
+            while (!group.IsFinished())
+            {
+                if (!ExecuteOne(index))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        // Execute function(c) for 0 <= c < numChunks, the chunks c > 0 as
+        // tasks of the scheduler and the chunk 0 in the calling thread.
+        template <typename Function>
+        void ParallelFor(size_t numChunks, Function const& function)
+        {
+            ChunkExceptions exceptions;
+            TaskGroup group;
+            for (size_t c = 1; c < numChunks; ++c)
+            {
+                Spawn(group, [&function, &exceptions, c]() { exceptions.Execute(function, c); });
+            }
+            if (numChunks > 0)
+            {
+                exceptions.Execute(function, 0);
+            }
+            Wait(group);
+            exceptions.Rethrow();
+        }
+
+        // Execute function(c) for 0 <= c < numChunks using the scheduler
+        // when it is not null. Otherwise, the chunks are executed by
+        // std::thread objects created for the call when numChunks > 1 or in
+        // the calling thread when numChunks = 1.
+        template <typename Function>
+        static void ParallelFor(TaskScheduler* scheduler, size_t numChunks,
+            Function const& function)
+        {
+            if (scheduler)
+            {
+                scheduler->ParallelFor(numChunks, function);
+            }
+            else if (numChunks == 1)
+            {
+                function(0);
+            }
+            else if (numChunks > 1)
+            {
+                ChunkExceptions exceptions;
+                std::vector<std::thread> process(numChunks);
+                for (size_t c = 0; c < numChunks; ++c)
+                {
+                    process[c] = std::thread([&function, &exceptions, c]() { exceptions.Execute(function, c); });
+                }
+                for (size_t c = 0; c < numChunks; ++c)
+                {
+                    process[c].join();
+                }
+                exceptions.Rethrow();
+            }
+        }
+
+        // Execute function(i) for 0 <= i < numItems, where numWorkers chunks
+        // of ParallelFor fetch the items in increasing order from an atomic
+        // counter. This balances the load when the costs of the items
+        // differ. When an item throws an exception, the workers stop
+        // fetching items and the exception is rethrown. The items are
+        // executed in order in the calling thread when numWorkers <= 1.
+        template <typename Function>
+        static void ParallelForDynamic(TaskScheduler* scheduler, size_t numItems,
+            size_t numWorkers, Function const& function)
+        {
+            numWorkers = std::min(numWorkers, numItems);
+            if (numWorkers <= 1)
+            {
+                for (size_t i = 0; i < numItems; ++i)
+                {
+                    function(i);
+                }
+                return;
+            }
+
+            std::atomic<size_t> next(0);
+            ParallelFor(scheduler, numWorkers, [&function, &next, numItems](size_t)
+            {
+                try
+                {
+                    for (size_t i = next.fetch_add(1); i < numItems; i = next.fetch_add(1))
+                    {
+                        function(i);
+                    }
+                }
+                catch (...)
+                {
+                    next.store(numItems);
+                    throw;
+                }
+            });
+        }
+
+    private:
+        // The first exception thrown by the chunks of a ParallelFor call.
+        class ChunkExceptions
+        {
+        public:
+            template <typename Function>
+            void Execute(Function const& function, size_t c)
+            {
+                try
+                {
+                    function(c);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    if (!mException)
+                    {
+                        mException = std::current_exception();
+                    }
+                }
+            }
+
+            void Rethrow() const
+            {
+                if (mException)
+                {
+                    std::rethrow_exception(mException);
+                }
+            }
+
+        private:
+            std::mutex mMutex;
+            std::exception_ptr mException;
+        };
+
+        struct Task
+        {
+            Task()
+                :
+                group(nullptr)
+            {
+            }
+
+            template <typename Function>
+            Task(Function&& inFunction, TaskGroup* inGroup)
+                :
+                function(std::forward<Function>(inFunction)),
+                group(inGroup)
+            {
+            }
+
+            std::function<void()> function;
+            TaskGroup* group;
+        };
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct ThreadInfo
+        {
+            TaskScheduler const* scheduler;
+            size_t index;
+        };
+
+        static ThreadInfo& GetThreadInfo()
+        {
+            static thread_local ThreadInfo info{ nullptr, 0 };
+            return info;
+        }
+
+        // Workers use their own queues. All other threads use the last
+        // queue.
+        size_t GetQueueIndex() const
+        {
+            ThreadInfo const& info = GetThreadInfo();
+            return (info.scheduler == this ? info.index : mQueues.size() - 1);
+        }
+
+        bool Pop(size_t index, Task& task)
+        {
+            Queue& queue = mQueues[index];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                return false;
+            }
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            mNumQueued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        bool Steal(size_t index, Task& task)
+        {
+            size_t const numQueues = mQueues.size();
+            for (size_t k = 1; k < numQueues; ++k)
+            {
+                Queue& queue = mQueues[(index + k) % numQueues];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty())
+                {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    mNumQueued.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool ExecuteOne(size_t index)
+        {
+            Task task;
+            if (!Pop(index, task) && !Steal(index, task))
+            {
+                return false;
+            }
+
+            task.function();
+            task.group->mNumPending.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        void WorkerLoop(size_t index)
+        {
+            ThreadInfo& info = GetThreadInfo();
+            info.scheduler = this;
+            info.index = index;
+
+            for (;;)
+            {
+                if (ExecuteOne(index))
+                {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mSleepMutex);
+                mSleepCondition.wait(lock, [this]()
+                {
+                    return mStop || mNumQueued.load(std::memory_order_acquire) > 0;
+                });
+                if (mStop)
+                {
+                    break;
+                }
+            }
+        }
+
+        std::vector<Queue> mQueues;
+        std::vector<std::thread> mWorkers;
+        std::atomic<size_t> mNumQueued;
+        std::mutex mSleepMutex;
+        std::condition_variable mSleepCondition;
+        bool mStop;
+    };
+}
@@ -3,15 +3,17 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 5.5.2020.12.18
+// Version: 5.5.2026.10.15
 
 #pragma once
 
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <stdexcept>
-#include <thread>
 #include <vector>
 
 namespace gte
@@ -70,9 +72,82 @@ namespace gte
         // available hardware threads. You might want to keep 1 or 2 threads
         // available for the operating system and other applications running
         // on the machine.
+        //
+        // For multithreading, the grid is partitioned into bricks of
+        // msBrickBound^3 points, and each tetrahedron is binned by the
+        // bricks that its grid-aligned bounding box overlaps. A thread
+        // rasterizes a brick at a time using only the tetrahedra of its bin,
+        // so the threads do not reject the tetrahedra of the other bricks
+        // and each grid value is written by a single thread. The tetrahedra
+        // of a bin are in increasing order of index, so when a grid point is
+        // contained by several tetrahedra, grid[i] is the largest of their
+        // indices, which is the same result as for a single thread.
         void operator()(size_t numThreads, std::array<T, 3> const& regionMin,
             std::array<T, 3> const& regionMax, std::array<size_t, 3> const& bound,
             std::vector<int32_t>& grid)
+        {
+            Execute(nullptr, numThreads, regionMin, regionMax, bound, grid);
+        }
+
+        // Rasterize the tetrahedra using the threads of a scheduler, which
+        // can be shared with other computations, instead of creating threads
+        // for each call. The tetrahedra are partitioned into one subset per
+        // thread of the scheduler.
+        void operator()(TaskScheduler& scheduler, std::array<T, 3> const& regionMin,
+            std::array<T, 3> const& regionMax, std::array<size_t, 3> const& bound,
+            std::vector<int32_t>& grid)
+        {
+            Execute(&scheduler, scheduler.GetNumThreads(), regionMin, regionMax,
+                bound, grid);
+        }
+
+        // Rasterize the tetrahedra into a grid stored in bricked order. The
+        // grid is partitioned into bricks of brickBound[0]-by-brickBound[1]-
+        // by-brickBound[2] points, where the bricks at the upper boundaries
+        // of the grid are padded with points that are not in the grid. The
+        // values of a brick are contiguous in grid[], in the order of the
+        // points of the brick. The bricks are ordered lexicographically, so
+        // grid[] has numBricks[0]*numBricks[1]*numBricks[2] bricks, where
+        // numBricks[i] = ceil(bound[i]/brickBound[i]). The index of point
+        // (x,y,z) is GetBrickedIndex(bound, brickBound, x, y, z) and the
+        // values of the padding points are -1. A thread rasterizes a brick
+        // at a time as described for operator(), and a brick is a small
+        // contiguous block of memory for large grids. The number of threads
+        // is interpreted as for operator().
+        void RasterizeBricked(size_t numThreads, std::array<T, 3> const& regionMin,
+            std::array<T, 3> const& regionMax, std::array<size_t, 3> const& bound,
+            std::array<size_t, 3> const& brickBound, std::vector<int32_t>& grid)
+        {
+            ExecuteBricked(nullptr, numThreads, regionMin, regionMax, bound,
+                brickBound, grid);
+        }
+
+        void RasterizeBricked(TaskScheduler& scheduler, std::array<T, 3> const& regionMin,
+            std::array<T, 3> const& regionMax, std::array<size_t, 3> const& bound,
+            std::array<size_t, 3> const& brickBound, std::vector<int32_t>& grid)
+        {
+            ExecuteBricked(&scheduler, scheduler.GetNumThreads(), regionMin,
+                regionMax, bound, brickBound, grid);
+        }
+
+        static size_t GetBrickedIndex(std::array<size_t, 3> const& bound,
+            std::array<size_t, 3> const& brickBound, size_t x, size_t y, size_t z)
+        {
+            size_t const numBricks0 = (bound[0] + brickBound[0] - 1) / brickBound[0];
+            size_t const numBricks1 = (bound[1] + brickBound[1] - 1) / brickBound[1];
+            size_t const brick = x / brickBound[0] + numBricks0 *
+                (y / brickBound[1] + numBricks1 * (z / brickBound[2]));
+            return brickBound[0] * (brickBound[1] * (brickBound[2] * brick +
+                z % brickBound[2]) + y % brickBound[1]) + x % brickBound[0];
+        }
+
+    private:
+        // The bricks used by operator() for multithreading.
+        static size_t constexpr msBrickBound = 32;
+
+        void Execute(TaskScheduler* scheduler, size_t numThreads,
+            std::array<T, 3> const& regionMin, std::array<T, 3> const& regionMax,
+            std::array<size_t, 3> const& bound, std::vector<int32_t>& grid)
         {
             if (bound[0] < 2 || bound[1] < 2 || bound[2] < 2)
             {
@@ -92,17 +167,68 @@ namespace gte
             // grid coordinates.
             TransformToGridCoordinates(regionMin, regionMax, bound);
 
-            if (numThreads > 0)
+            auto store = [&bound, &grid](size_t i0min, size_t i0max, size_t i1,
+                size_t i2, int32_t tetrahedronIndex)
             {
-                MultiThreadedRasterizer(numThreads, bound, grid);
+                size_t const base = bound[0] * (i1 + bound[1] * i2);
+                for (size_t j = base + i0min; j <= base + i0max; ++j)
+                {
+                    grid[j] = tetrahedronIndex;
+                }
+            };
+
+            if (numThreads > 1)
+            {
+                std::array<size_t, 3> const brickBound{ msBrickBound, msBrickBound, msBrickBound };
+                BinnedRasterizer(scheduler, numThreads, bound, brickBound, store);
             }
             else
             {
-                SingleThreadedRasterizer(bound, grid);
+                SingleThreadedRasterizer(bound, store);
             }
         }
 
-    private:
+        void ExecuteBricked(TaskScheduler* scheduler, size_t numThreads,
+            std::array<T, 3> const& regionMin, std::array<T, 3> const& regionMax,
+            std::array<size_t, 3> const& bound, std::array<size_t, 3> const& brickBound,
+            std::vector<int32_t>& grid)
+        {
+            if (bound[0] < 2 || bound[1] < 2 || bound[2] < 2 ||
+                brickBound[0] == 0 || brickBound[1] == 0 || brickBound[2] == 0)
+            {
+                throw std::invalid_argument("Invalid argument.");
+            }
+
+            std::array<size_t, 3> numBricks{};
+            for (size_t i = 0; i < 3; ++i)
+            {
+                numBricks[i] = (bound[i] + brickBound[i] - 1) / brickBound[i];
+            }
+            grid.resize(numBricks[0] * numBricks[1] * numBricks[2] *
+                brickBound[0] * brickBound[1] * brickBound[2]);
+            std::fill(grid.begin(), grid.end(), -1);
+
+            ClipCullAABBs(regionMin, regionMax);
+            TransformToGridCoordinates(regionMin, regionMax, bound);
+
+            // The row of grid points from (i0min,i1,i2) to (i0max,i1,i2) is
+            // contained in a brick, so its values are contiguous.
+            auto store = [&bound, &brickBound, &grid](size_t i0min, size_t i0max,
+                size_t i1, size_t i2, int32_t tetrahedronIndex)
+            {
+                size_t const base = GetBrickedIndex(bound, brickBound, i0min, i1, i2);
+                for (size_t j = base; j <= base + (i0max - i0min); ++j)
+                {
+                    grid[j] = tetrahedronIndex;
+                }
+            };
+
+            // The rasterization is by bricks even for a single thread, so
+            // that each row is contained in a brick.
+            BinnedRasterizer(scheduler, std::max(numThreads, static_cast<size_t>(1)),
+                bound, brickBound, store);
+        }
+
         // Compute the axis-aligned bounding boxes of the tetrahedra.
         void ComputeTetrahedraAABBs()
         {
@@ -189,57 +315,159 @@ namespace gte
             }
         }
 
+        template <typename Store>
         void SingleThreadedRasterizer(std::array<size_t, 3> const& bound,
-            std::vector<int32_t>& grid)
+            Store const& store)
         {
+            std::array<size_t, 3> const lower{ 0, 0, 0 };
+            std::array<size_t, 3> const upper{ bound[0] - 1, bound[1] - 1, bound[2] - 1 };
             for (size_t t = 0; t < mNumTetrahedra; ++t)
             {
                 if (mValid[t])
                 {
-                    Rasterize(t, bound, grid);
+                    Rasterize(t, lower, upper, store);
                 }
             }
         }
 
-        void MultiThreadedRasterizer(size_t numThreads,
-            std::array<size_t, 3> const& bound, std::vector<int32_t>& grid)
+        template <typename Store>
+        void BinnedRasterizer(TaskScheduler* scheduler, size_t numThreads,
+            std::array<size_t, 3> const& bound, std::array<size_t, 3> const& brickBound,
+            Store const& store)
         {
-            // Partition the data for multiple threads.
-            size_t const numTetrahedraPerThread = mNumTetrahedra / numThreads;
-            std::vector<size_t> nmin(numThreads), nsup(numThreads);
-            for (size_t k = 0; k < numThreads; ++k)
+            std::array<size_t, 3> numBricks{};
+            for (size_t i = 0; i < 3; ++i)
             {
-                nmin[k] = k * numTetrahedraPerThread;
-                nsup[k] = (k + 1) * numTetrahedraPerThread;
+                numBricks[i] = (bound[i] + brickBound[i] - 1) / brickBound[i];
             }
-            nsup[numThreads - 1] = mNumTetrahedra;
+            BinTetrahedra(scheduler, numThreads, numBricks, brickBound);
+
+            // The threads fetch the bricks in increasing order. The bins of
+            // nearby bricks share many tetrahedra, so consecutive bricks of
+            // a thread reuse the cached tetrahedron data.
+            size_t const totalBricks = numBricks[0] * numBricks[1] * numBricks[2];
+            std::atomic<size_t> next(0);
+            TaskScheduler::ParallelFor(scheduler, numThreads,
+                [this, &numBricks, &brickBound, &bound, &store, &next, totalBricks](size_t)
+                {
+                    for (size_t b = next.fetch_add(1); b < totalBricks; b = next.fetch_add(1))
+                    {
+                        std::array<size_t, 3> const brick
+                        {
+                            b % numBricks[0],
+                            (b / numBricks[0]) % numBricks[1],
+                            b / (numBricks[0] * numBricks[1])
+                        };
+                        std::array<size_t, 3> lower{}, upper{};
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            lower[i] = brick[i] * brickBound[i];
+                            upper[i] = std::min(lower[i] + brickBound[i], bound[i]) - 1;
+                        }
 
-            std::vector<std::thread> process(numThreads);
-            for (size_t k = 0; k < numThreads; ++k)
+                        for (size_t k = mBrickStart[b]; k < mBrickStart[b + 1]; ++k)
+                        {
+                            Rasterize(static_cast<size_t>(mBrickTetrahedra[k]), lower, upper, store);
+                        }
+                    }
+                });
+        }
+
+        // Bin the valid tetrahedra by the bricks that their grid-aligned
+        // bounding boxes overlap. The tetrahedra of brick b are
+        // mBrickTetrahedra[mBrickStart[b]] through
+        // mBrickTetrahedra[mBrickStart[b+1]-1] in increasing order. The
+        // bins are computed by a counting sort of chunks of the tetrahedra,
+        // one chunk per thread, whose offsets are ordered by brick and then
+        // by chunk.
+        void BinTetrahedra(TaskScheduler* scheduler, size_t numThreads,
+            std::array<size_t, 3> const& numBricks, std::array<size_t, 3> const& brickBound)
+        {
+            size_t const totalBricks = numBricks[0] * numBricks[1] * numBricks[2];
+            size_t const numChunks = std::max(numThreads, static_cast<size_t>(1));
+            size_t const numTetrahedraPerChunk = (mNumTetrahedra + numChunks - 1) / numChunks;
+
+            auto visit = [this, &numBricks, &brickBound](size_t t, size_t* offsets,
+                int32_t* binned)
             {
-                process[k] = std::thread([this, k, &nmin, &nsup, &bound, &grid]()
+                auto const& imin = mGridTetraMin[t];
+                auto const& imax = mGridTetraMax[t];
+                if (!mValid[t] || imin[0] > imax[0] || imin[1] > imax[1] || imin[2] > imax[2])
                 {
-                    for (size_t t = nmin[k]; t < nsup[k]; ++t)
+                    return;
+                }
+
+                for (size_t b2 = imin[2] / brickBound[2]; b2 <= imax[2] / brickBound[2]; ++b2)
+                {
+                    for (size_t b1 = imin[1] / brickBound[1]; b1 <= imax[1] / brickBound[1]; ++b1)
                     {
-                        if (mValid[t])
+                        size_t const base = numBricks[0] * (b1 + numBricks[1] * b2);
+                        for (size_t b0 = imin[0] / brickBound[0]; b0 <= imax[0] / brickBound[0]; ++b0)
                         {
-                            Rasterize(t, bound, grid);
+                            size_t& offset = offsets[base + b0];
+                            if (binned)
+                            {
+                                binned[offset] = static_cast<int32_t>(t);
+                            }
+                            ++offset;
                         }
                     }
-                });
-            }
+                }
+            };
 
-            for (size_t t = 0; t < numThreads; ++t)
+            // Count the tetrahedra of each chunk in each brick.
+            std::vector<size_t> offsets(numChunks * totalBricks, 0);
+            auto forChunk = [this, &visit, &offsets, numTetrahedraPerChunk, totalBricks](
+                size_t c, int32_t* binned)
             {
-                process[t].join();
+                size_t const tmin = c * numTetrahedraPerChunk;
+                size_t const tsup = std::min(tmin + numTetrahedraPerChunk, mNumTetrahedra);
+                for (size_t t = tmin; t < tsup; ++t)
+                {
+                    visit(t, &offsets[c * totalBricks], binned);
+                }
+            };
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [&forChunk](size_t c) { forChunk(c, nullptr); });
+
+            // Replace the counts by their exclusive prefix sums.
+            mBrickStart.resize(totalBricks + 1);
+            size_t sum = 0;
+            for (size_t b = 0; b < totalBricks; ++b)
+            {
+                mBrickStart[b] = sum;
+                for (size_t c = 0; c < numChunks; ++c)
+                {
+                    size_t const count = offsets[c * totalBricks + b];
+                    offsets[c * totalBricks + b] = sum;
+                    sum += count;
+                }
             }
+            mBrickStart[totalBricks] = sum;
+
+            // Store the tetrahedra of each chunk in the bins.
+            mBrickTetrahedra.resize(sum);
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, &forChunk](size_t c) { forChunk(c, mBrickTetrahedra.data()); });
         }
 
-        void Rasterize(size_t t, std::array<size_t, 3> const& bound,
-            std::vector<int32_t>& grid)
+        // Rasterize tetrahedron t in the box of grid points [lower,upper],
+        // calling store(i0min, i0max, i1, i2, t) for each row of grid points
+        // (i0,i1,i2) contained by the tetrahedron, i0min <= i0 <= i0max.
+        template <typename Store>
+        void Rasterize(size_t t, std::array<size_t, 3> const& lower,
+            std::array<size_t, 3> const& upper, Store const& store)
         {
-            auto const& imin = mGridTetraMin[t];
-            auto const& imax = mGridTetraMax[t];
+            std::array<size_t, 3> imin{}, imax{};
+            for (size_t i = 0; i < 3; ++i)
+            {
+                imin[i] = std::max(mGridTetraMin[t][i], lower[i]);
+                imax[i] = std::min(mGridTetraMax[t][i], upper[i]);
+                if (imin[i] > imax[i])
+                {
+                    return;
+                }
+            }
             std::array<T, 3> gridP{};
 
             for (size_t i2 = imin[2]; i2 <= imax[2]; ++i2)
@@ -283,12 +511,7 @@ namespace gte
                         }
                     }
 
-                    size_t const base = bound[0] * (i1 + bound[1] * i2);
-                    int32_t const tetrahedronIndex = static_cast<int32_t>(t);
-                    for (size_t i0 = i0min, j = i0 + base; i0 <= i0max; ++i0, ++j)
-                    {
-                        grid[j] = tetrahedronIndex;
-                    }
+                    store(i0min, i0max, i1, i2, static_cast<int32_t>(t));
                 }
             }
         }
@@ -375,5 +598,9 @@ namespace gte
         std::vector<std::array<T, 3>> mGridVertices;
         std::vector<std::array<size_t, 3>> mGridTetraMin;
         std::vector<std::array<size_t, 3>> mGridTetraMax;
+
+        // The bins of the bricks for multithreading.
+        std::vector<size_t> mBrickStart;
+        std::vector<int32_t> mBrickTetrahedra;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.01.10
+// Version: 4.0.2026.10.14
 
 #pragma once
 
@@ -11,6 +11,8 @@
 #include <Mathematics/Matrix3x3.h>
 #include <Mathematics/Matrix4x4.h>
 #include <Mathematics/Rotation.h>
+#include <Mathematics/SIMD4.h>
+#include <Mathematics/TaskScheduler.h>
 
 // Transforms when GTE_USE_MAT_VEC is defined in the preprocessor symbols.
 //
@@ -531,6 +533,46 @@ namespace gte
             return mInvHMatrix;
         }
 
+        // Batch transformation of arrays of 3-tuples, such as the positions
+        // and normals of a vertex buffer. The tuple i of the input starts at
+        // byte i*inStride of 'input' and the tuple i of the output starts at
+        // byte i*outStride of 'output'. For a vertex buffer, the stride is
+        // the vertex size of the VertexFormat and the buffer pointer is the
+        // data pointer plus the offset of the attribute. The transformation
+        // is in place when input and output are the same with the same
+        // stride; otherwise, the buffers must not overlap. The elements are
+        // partitioned among the threads of the scheduler when it is not
+        // null. The results are those of the Vector4 operators applied to
+        // each tuple (with w = 1 for points and w = 0 otherwise), but the
+        // products are computed with SIMD4<Real>.
+        //
+        // TransformPoints applies H, TransformVectors applies H without the
+        // translation and TransformNormals applies the inverse transpose of
+        // M, which maps the normals of a surface to the normals of the
+        // transformed surface. The transformed normals are not normalized.
+        void TransformPoints(size_t numElements, void const* input, size_t inStride,
+            void* output, size_t outStride, TaskScheduler* scheduler = nullptr) const
+        {
+            TransformTuples(GetHMatrix(), true, true, numElements, input, inStride,
+                output, outStride, scheduler);
+        }
+
+        void TransformVectors(size_t numElements, void const* input, size_t inStride,
+            void* output, size_t outStride, TaskScheduler* scheduler = nullptr) const
+        {
+            TransformTuples(GetHMatrix(), true, false, numElements, input, inStride,
+                output, outStride, scheduler);
+        }
+
+        void TransformNormals(size_t numElements, void const* input, size_t inStride,
+            void* output, size_t outStride, TaskScheduler* scheduler = nullptr) const
+        {
+            // GTE_USE_MAT_VEC: N' = M^{-T}*N = (N^T*M^{-1})^T
+            // GTE_USE_VEC_MAT: N' = N*M^{-T} = (M^{-1}*N^T)^T
+            TransformTuples(GetHInverse(), false, false, numElements, input, inStride,
+                output, outStride, scheduler);
+        }
+
         // Invert the transform.  If possible, the channels are properly
         // assigned.  For example, if the input has mIsRSMatrix equal to
         // 'true', then the inverse also has mIsRSMatrix equal to 'true'
@@ -642,6 +684,75 @@ namespace gte
             mInverseNeedsUpdate = true;
         }
 
+        // Apply H (or its transpose when 'convention' is false) to the
+        // tuples (x,y,z,w) with w = 1 when 'point' is true and w = 0 when it
+        // is false. The lines of H are the columns (GTE_USE_MAT_VEC) or rows
+        // (GTE_USE_VEC_MAT) that multiply the components x, y, z and w.
+        static void TransformTuples(Matrix4x4<Real> const& H, bool convention,
+            bool point, size_t numElements, void const* input, size_t inStride,
+            void* output, size_t outStride, TaskScheduler* scheduler)
+        {
+            typedef SIMD4<Real> S;
+            typedef typename S::Register Register;
+
+#if defined(GTE_USE_MAT_VEC)
+            bool const byColumn = convention;
+#else
+            bool const byColumn = !convention;
+#endif
+            Vector4<Real> L0 = (byColumn ? H.GetCol(0) : H.GetRow(0));
+            Vector4<Real> L1 = (byColumn ? H.GetCol(1) : H.GetRow(1));
+            Vector4<Real> L2 = (byColumn ? H.GetCol(2) : H.GetRow(2));
+            Vector4<Real> L3 = (byColumn ? H.GetCol(3) : H.GetRow(3));
+
+            char const* source = static_cast<char const*>(input);
+            char* target = static_cast<char*>(output);
+            auto function = [&L0, &L1, &L2, &L3, point, source, inStride, target, outStride](
+                size_t first, size_t last)
+            {
+                Register line[4] =
+                {
+                    S::Set(L0[0], L0[1], L0[2], L0[3]),
+                    S::Set(L1[0], L1[1], L1[2], L1[3]),
+                    S::Set(L2[0], L2[1], L2[2], L2[3]),
+                    S::Set(L3[0], L3[1], L3[2], L3[3])
+                };
+
+                for (size_t i = first; i < last; ++i)
+                {
+                    Real const* X = reinterpret_cast<Real const*>(source + i * inStride);
+                    Register sum = S::Zero();
+                    sum = S::Add(sum, S::Mul(line[0], S::Set(X[0])));
+                    sum = S::Add(sum, S::Mul(line[1], S::Set(X[1])));
+                    sum = S::Add(sum, S::Mul(line[2], S::Set(X[2])));
+                    if (point)
+                    {
+                        sum = S::Add(sum, line[3]);
+                    }
+                    S::Store3(reinterpret_cast<Real*>(target + i * outStride), sum);
+                }
+            };
+
+            size_t const minChunkSize = 1024;
+            size_t numChunks = (scheduler ? 4 * scheduler->GetNumThreads() : 1);
+            numChunks = std::min(numChunks, numElements / minChunkSize);
+            if (numChunks <= 1)
+            {
+                function(0, numElements);
+                return;
+            }
+
+            TaskScheduler::TaskGroup group;
+            for (size_t c = 1; c < numChunks; ++c)
+            {
+                size_t first = c * numElements / numChunks;
+                size_t last = (c + 1) * numElements / numChunks;
+                scheduler->Spawn(group, [&function, first, last]() { function(first, last); });
+            }
+            function(0, numElements / numChunks);
+            scheduler->Wait(group);
+        }
+
         // Invert the 3x3 upper-left block of the input matrix.
         static void Invert3x3(Matrix4x4<Real> const& mat, Matrix4x4<Real>& invMat)
         {
@@ -3,13 +3,15 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/PolygonTree.h>
 #include <Mathematics/ConstrainedDelaunay2.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
 #include <numeric>
 
 // The fundamental problem is to compute the triangulation of a polygon tree.
@@ -627,6 +629,57 @@ namespace gte
             Triangulate(numInputPoints, inputPoints, outputTree);
         }
 
+        // Triangulate a forest of polygon trees whose polygons reference
+        // the same input points, for example the outlines of the glyphs of
+        // a text string. Each tree is triangulated independently, so the
+        // trees must not overlap, and outputTrees[i] is the triangulation
+        // of inputTrees[i]. The output indices are relative to inputPoints[]
+        // as for a single tree, so the triangles of all the trees can be
+        // concatenated without index offsets.
+        //
+        // The trees are triangulated by numThreads threads, which are tasks
+        // of the scheduler when it is not null. Each thread takes the next
+        // untriangulated tree, which balances the load when the tree sizes
+        // vary. Set numThreads to 0 or 1 to triangulate the
+        // trees in the calling thread. If the triangulation of a tree
+        // throws an exception, the first such exception is rethrown after
+        // all threads finish.
+        void operator()(
+            std::vector<Vector2<T>> const& inputPoints,
+            std::vector<std::shared_ptr<PolygonTree>> const& inputTrees,
+            std::vector<PolygonTreeEx>& outputTrees,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            operator()(inputPoints.size(), inputPoints.data(), inputTrees,
+                outputTrees, numThreads, scheduler);
+        }
+
+        void operator()(
+            size_t numInputPoints,
+            Vector2<T> const* inputPoints,
+            std::vector<std::shared_ptr<PolygonTree>> const& inputTrees,
+            std::vector<PolygonTreeEx>& outputTrees,
+            size_t numThreads = 1, TaskScheduler* scheduler = nullptr)
+        {
+            LogAssert(numInputPoints >= 3 && inputPoints != nullptr, "Invalid argument.");
+            for (auto const& inputTree : inputTrees)
+            {
+                LogAssert(inputTree != nullptr, "Invalid argument.");
+            }
+
+            size_t const numTrees = inputTrees.size();
+            outputTrees.resize(numTrees);
+
+            // The class has no data members, so the threads can share this
+            // object.
+            TaskScheduler::ParallelForDynamic(scheduler, numTrees, numThreads,
+                [this, numInputPoints, inputPoints, &inputTrees, &outputTrees](size_t i)
+                {
+                    CopyAndCompactify(inputTrees[i], outputTrees[i]);
+                    Triangulate(numInputPoints, inputPoints, outputTrees[i]);
+                });
+        }
+
     private:
         void CopyAndCompactify(std::shared_ptr<PolygonTree> const& input,
             PolygonTreeEx& output)
@@ -722,12 +775,14 @@ namespace gte
             std::vector<int32_t>& remapping)
         {
             std::map<Vector2<T>, int32_t> pointMap;
-            points.reserve(numInputPoints);
             int32_t currentIndex = 0;
 
-            // The remapping is initially the identity, remapping[j] = j.
-            remapping.resize(numInputPoints);
-            std::iota(remapping.begin(), remapping.end(), 0);
+            // The remapping[j] is the inputPoints[] index for points[j]. Only
+            // the points referenced by the tree are visited, so the cost is
+            // proportional to the size of the tree rather than to
+            // numInputPoints. This matters when many small trees share a
+            // large array of points.
+            remapping.clear();
 
             std::queue<size_t> queue;
             queue.push(0);
@@ -738,13 +793,15 @@ namespace gte
                 size_t const numIndices = node.polygon.size();
                 for (size_t i = 0; i < numIndices; ++i)
                 {
+                    LogAssert(static_cast<size_t>(node.polygon[i]) < numInputPoints,
+                        "Invalid polygon index.");
                     auto const& point = inputPoints[node.polygon[i]];
                     auto iter = pointMap.find(point);
                     if (iter == pointMap.end())
                     {
                         // The point is encountered the first time.
                         pointMap.insert(std::make_pair(point, currentIndex));
-                        remapping[currentIndex] = node.polygon[i];
+                        remapping.push_back(node.polygon[i]);
                         node.polygon[i] = currentIndex;
                         points.push_back(point);
                         ++currentIndex;
@@ -3,13 +3,16 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.10.26
+// Version: 4.0.2026.10.14
 
 #pragma once
 
 #include <Mathematics/Logger.h>
 #include <Mathematics/PolygonTree.h>
 #include <Mathematics/PrimalQuery2.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <map>
 #include <queue>
@@ -20,6 +23,15 @@
 // The algorithm for processing nested polygons involves a division, so the
 // ComputeType must be rational-based, say, BSRational.  If you process only
 // triangles that are simple, you may use BSNumber for the ComputeType.
+//
+// The ear test searches the reflex vertices for one inside the candidate
+// ear. For polygons with many reflex vertices, such as large CAD outlines
+// or polygons with many holes, the reflex vertices are stored in a uniform
+// grid so that only those near the candidate ear are searched, which
+// avoids the O(N^2) behavior of searching all of them. The grid is used
+// only to select the candidates; the containment tests are the exact
+// queries of ComputeType, so the triangulation is the same as without the
+// grid.
 
 namespace gte
 {
@@ -48,7 +60,14 @@ namespace gte
             mRFirst(-1),
             mRLast(-1),
             mEFirst(-1),
-            mELast(-1)
+            mELast(-1),
+            mUseReflexGrid(true),
+            mGridActive(false),
+            mGridNumCells(0),
+            mGridXMin(0.0),
+            mGridYMin(0.0),
+            mGridXScale(0.0),
+            mGridYScale(0.0)
         {
             LogAssert(numPoints >= 3 && points != nullptr, "Invalid input.");
             mComputePoints.resize(mNumPoints);
@@ -66,7 +85,14 @@ namespace gte
             mRFirst(-1),
             mRLast(-1),
             mEFirst(-1),
-            mELast(-1)
+            mELast(-1),
+            mUseReflexGrid(true),
+            mGridActive(false),
+            mGridNumCells(0),
+            mGridXMin(0.0),
+            mGridYMin(0.0),
+            mGridXScale(0.0),
+            mGridYScale(0.0)
         {
             LogAssert(mNumPoints >= 3 && mPoints != nullptr, "Invalid input.");
             mComputePoints.resize(mNumPoints);
@@ -81,6 +107,22 @@ namespace gte
             return mTriangles;
         }
 
+        // Enable or disable the grid of reflex vertices for the ear tests.
+        // It is enabled by default and is used only when a polygon to be
+        // ear-clipped has at least minNumGridReflex reflex vertices. The
+        // triangulation does not depend on this setting.
+        static int constexpr minNumGridReflex = 64;
+
+        inline void UseReflexGrid(bool useReflexGrid)
+        {
+            mUseReflexGrid = useReflexGrid;
+        }
+
+        inline bool UsesReflexGrid() const
+        {
+            return mUseReflexGrid;
+        }
+
         // The input 'points' represents an array of vertices for a simple
         // polygon. The vertices are points[0] through points[numPoints-1] and
         // are listed in counterclockwise order.
@@ -417,6 +459,7 @@ namespace gte
             mRLast = -1;
             mEFirst = -1;
             mELast = -1;
+            mGridActive = false;
 
             // Create a circular list of the polygon vertices for dynamic
             // removal of vertices.
@@ -474,6 +517,10 @@ namespace gte
                 return;
             }
 
+            // Store the reflex vertices in a grid for the ear tests when
+            // there are many of them.
+            CreateReflexGrid();
+
             // Identify the ears and build a circular list of them.  Let V0,
             // V1, and V2 be consecutive vertices forming a triangle T.  The
             // vertex V1 is an ear if no other vertices of the polygon lie
@@ -1076,39 +1123,172 @@ namespace gte
             int curr = vertex.index;
             int next = V(vertex.vNext).index;
             vertex.isEar = true;
-            for (int j = mRFirst; j != -1; j = V(j).sNext)
+            if (mGridActive)
             {
-                // Check if the test vertex is already one of the triangle
-                // vertices.
-                if (j == vertex.vPrev || j == i || j == vertex.vNext)
-                {
-                    continue;
-                }
-
-                // V[j] has been ruled out as one of the original vertices of
-                // the triangle <V[prev],V[curr],V[next]>.  When triangulating
-                // polygons with holes, V[j] might be a duplicated vertex, in
-                // which case it does not affect the earness of V[curr].
-                int test = V(j).index;
-                if (mComputePoints[test] == mComputePoints[prev]
-                    || mComputePoints[test] == mComputePoints[curr]
-                    || mComputePoints[test] == mComputePoints[next])
+                // Search only the reflex vertices in the grid cells that
+                // overlap the bounding box of the triangle.
+                std::array<double, 2> const& p0 = mGridPositions[vertex.vPrev];
+                std::array<double, 2> const& p1 = mGridPositions[i];
+                std::array<double, 2> const& p2 = mGridPositions[vertex.vNext];
+                int x0 = GetGridCell(std::min(std::min(p0[0], p1[0]), p2[0]), mGridXMin, mGridXScale);
+                int x1 = GetGridCell(std::max(std::max(p0[0], p1[0]), p2[0]), mGridXMin, mGridXScale);
+                int y0 = GetGridCell(std::min(std::min(p0[1], p1[1]), p2[1]), mGridYMin, mGridYScale);
+                int y1 = GetGridCell(std::max(std::max(p0[1], p1[1]), p2[1]), mGridYMin, mGridYScale);
+                for (int y = y0; y <= y1; ++y)
                 {
-                    continue;
+                    for (int x = x0; x <= x1; ++x)
+                    {
+                        for (auto j : mGridCells[y * mGridNumCells + x])
+                        {
+                            if (IsInTriangle(i, j, prev, curr, next))
+                            {
+                                vertex.isEar = false;
+                                return false;
+                            }
+                        }
+                    }
                 }
-
-                // Test if the vertex is inside or on the triangle.  When it
-                // is, it causes V[curr] not to be an ear.
-                if (mQuery.ToTriangle(test, prev, curr, next) <= 0)
+            }
+            else
+            {
+                for (int j = mRFirst; j != -1; j = V(j).sNext)
                 {
-                    vertex.isEar = false;
-                    break;
+                    if (IsInTriangle(i, j, prev, curr, next))
+                    {
+                        vertex.isEar = false;
+                        break;
+                    }
                 }
             }
 
             return vertex.isEar;
         }
 
+        // Test whether the reflex vertex j causes vertex i with triangle
+        // <V[prev],V[curr],V[next]> not to be an ear.
+        bool IsInTriangle(int i, int j, int prev, int curr, int next)
+        {
+            // Check if the test vertex is already one of the triangle
+            // vertices.
+            Vertex& vertex = V(i);
+            if (j == vertex.vPrev || j == i || j == vertex.vNext)
+            {
+                return false;
+            }
+
+            // V[j] has been ruled out as one of the original vertices of
+            // the triangle <V[prev],V[curr],V[next]>.  When triangulating
+            // polygons with holes, V[j] might be a duplicated vertex, in
+            // which case it does not affect the earness of V[curr].
+            int test = V(j).index;
+            if (mComputePoints[test] == mComputePoints[prev]
+                || mComputePoints[test] == mComputePoints[curr]
+                || mComputePoints[test] == mComputePoints[next])
+            {
+                return false;
+            }
+
+            // Test if the vertex is inside or on the triangle.  When it
+            // is, it causes V[curr] not to be an ear.
+            return mQuery.ToTriangle(test, prev, curr, next) <= 0;
+        }
+
+        // Store the reflex vertices in a grid of about one vertex per cell
+        // that covers the bounding box of the polygon vertices. The cells
+        // are computed from the vertices converted to 'double'. The
+        // conversion and the cell computation are nondecreasing functions
+        // of the coordinates, so a vertex inside a triangle is in a cell
+        // overlapped by the bounding box of the converted triangle vertices.
+        void CreateReflexGrid()
+        {
+            mGridActive = false;
+            if (!mUseReflexGrid)
+            {
+                return;
+            }
+
+            int numReflex = 0;
+            for (int j = mRFirst; j != -1; j = V(j).sNext)
+            {
+                ++numReflex;
+            }
+            if (numReflex < minNumGridReflex)
+            {
+                return;
+            }
+
+            int const numVertices = static_cast<int>(mVertices.size());
+            mGridPositions.resize(numVertices);
+            double xmin = std::numeric_limits<double>::max(), xmax = -xmin;
+            double ymin = xmin, ymax = xmax;
+            for (int i = 0; i < numVertices; ++i)
+            {
+                Vector2<ComputeType> const& point = mComputePoints[V(i).index];
+                auto& position = mGridPositions[i];
+                position[0] = static_cast<double>(point[0]);
+                position[1] = static_cast<double>(point[1]);
+                xmin = std::min(xmin, position[0]);
+                xmax = std::max(xmax, position[0]);
+                ymin = std::min(ymin, position[1]);
+                ymax = std::max(ymax, position[1]);
+            }
+
+            mGridNumCells = std::max(static_cast<int>(std::sqrt(static_cast<double>(numReflex))), 1);
+            mGridXMin = xmin;
+            mGridYMin = ymin;
+            mGridXScale = (xmax > xmin ? static_cast<double>(mGridNumCells) / (xmax - xmin) : 0.0);
+            mGridYScale = (ymax > ymin ? static_cast<double>(mGridNumCells) / (ymax - ymin) : 0.0);
+            mGridCells.resize(static_cast<size_t>(mGridNumCells) * static_cast<size_t>(mGridNumCells));
+            for (auto& cell : mGridCells)
+            {
+                cell.clear();
+            }
+            mGridCell.assign(numVertices, -1);
+            mGridSlot.assign(numVertices, -1);
+
+            for (int j = mRFirst; j != -1; j = V(j).sNext)
+            {
+                auto const& position = mGridPositions[j];
+                int x = GetGridCell(position[0], mGridXMin, mGridXScale);
+                int y = GetGridCell(position[1], mGridYMin, mGridYScale);
+                int cell = y * mGridNumCells + x;
+                mGridCell[j] = cell;
+                mGridSlot[j] = static_cast<int>(mGridCells[cell].size());
+                mGridCells[cell].push_back(j);
+            }
+            mGridActive = true;
+        }
+
+        int GetGridCell(double value, double vmin, double scale) const
+        {
+            double t = (value - vmin) * scale;
+            if (!(t > 0.0))
+            {
+                return 0;
+            }
+            if (t >= static_cast<double>(mGridNumCells))
+            {
+                return mGridNumCells - 1;
+            }
+            return static_cast<int>(t);
+        }
+
+        // Remove a reflex vertex that has become convex from the grid.
+        void RemoveFromReflexGrid(int i)
+        {
+            int cell = mGridCell[i];
+            if (cell >= 0)
+            {
+                auto& vertices = mGridCells[cell];
+                int last = vertices.back();
+                vertices[mGridSlot[i]] = last;
+                mGridSlot[last] = mGridSlot[i];
+                vertices.pop_back();
+                mGridCell[i] = -1;
+                mGridSlot[i] = -1;
+            }
+        }
+
         // insert convex vertex
         void InsertAfterC(int i)
         {
@@ -1203,6 +1383,11 @@ namespace gte
         {
             LogAssert(mRFirst != -1 && mRLast != -1, "Reflex vertices must exist.");
 
+            if (mGridActive)
+            {
+                RemoveFromReflexGrid(i);
+            }
+
             if (i == mRFirst)
             {
                 mRFirst = V(i).sNext;
@@ -1237,5 +1422,15 @@ namespace gte
         int mCFirst, mCLast;  // linear list of convex vertices
         int mRFirst, mRLast;  // linear list of reflex vertices
         int mEFirst, mELast;  // cyclical list of ears
+
+        // The grid of reflex vertices for the ear tests. The cells store
+        // indices into mVertices. For vertex i in the grid, the cell is
+        // mGridCell[i] and the location in the cell is mGridSlot[i].
+        bool mUseReflexGrid, mGridActive;
+        int mGridNumCells;
+        double mGridXMin, mGridYMin, mGridXScale, mGridYScale;
+        std::vector<std::array<double, 2>> mGridPositions;
+        std::vector<std::vector<int>> mGridCells;
+        std::vector<int> mGridCell, mGridSlot;
     };
 }
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -187,29 +187,44 @@ namespace gte
             }
         }
 
+        // The rows are computed in parallel when a scheduler is set, which
+        // requires the evaluation of the medial curve and of the radial
+        // function to be safe to call concurrently, as it is for the curves
+        // of this library. The arc length table of the curve is updated
+        // before the rows are processed.
         virtual void UpdatePositions() override
         {
-            uint32_t row, col, v, save;
-            for (row = 0, v = 0; row < this->mDescription.numRows; ++row, ++v)
+            if (mSampleByArcLength)
             {
-                Real t = mTSampler(row);
-                Real radius = mRadial(t);
-                // frame = (position, tangent, normal, binormal)
-                std::array<Vector3<Real>, 4> frame = mFSampler(t);
-                for (col = 0, save = v; col < this->mDescription.numCols; ++col, ++v)
-                {
-                    this->Position(v) = frame[0] + radius * (mCosAngle[col] * frame[2] +
-                        mSinAngle[col] * frame[3]);
-                }
-                this->Position(v) = this->Position(save);
+                (void)mMedial->GetTotalLength();
             }
 
+            uint32_t const numCols = this->mDescription.numCols;
+            this->ParallelFor(this->mDescription.numRows,
+                [this, numCols](uint32_t rmin, uint32_t rmax)
+                {
+                    for (uint32_t row = rmin; row < rmax; ++row)
+                    {
+                        Real t = mTSampler(row);
+                        Real radius = mRadial(t);
+                        // frame = (position, tangent, normal, binormal)
+                        std::array<Vector3<Real>, 4> frame = mFSampler(t);
+                        uint32_t const save = row * (numCols + 1);
+                        for (uint32_t col = 0, v = save; col < numCols; ++col, ++v)
+                        {
+                            this->Position(v) = frame[0] + radius * (mCosAngle[col] * frame[2] +
+                                mSinAngle[col] * frame[3]);
+                        }
+                        this->Position(save + numCols) = this->Position(save);
+                    }
+                });
+
             if (mClosed)
             {
-                for (col = 0; col < this->mDescription.numCols; ++col)
+                for (uint32_t col = 0; col < numCols; ++col)
                 {
                     uint32_t i0 = col;
-                    uint32_t i1 = col + this->mDescription.numCols * (this->mDescription.numRows - 1);
+                    uint32_t i1 = col + numCols * (this->mDescription.numRows - 1);
                     this->Position(i1) = this->Position(i0);
                 }
             }
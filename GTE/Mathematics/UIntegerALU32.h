@@ -3,17 +3,46 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.02.21
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/BitHacks.h>
+#include <Mathematics/UIntegerStatistics.h>
 #include <algorithm>
+#include <vector>
 
 // Support for unsigned integer arithmetic in BSNumber and BSRational.  The
 // Curiously Recurring Template Paradigm is used to allow the UInteger
 // types to share code without introducing virtual functions.
 
+// The multiplication uses the schoolbook algorithm, which is O(n*m) for
+// inputs with n and m 32-bit blocks.  When both inputs have at least
+// GTE_UINTEGERALU32_KARATSUBA_THRESHOLD blocks, the multiplication uses the
+// Karatsuba algorithm, which is O(n^{log2(3)}) for inputs with n blocks.
+// This is important for rational arithmetic with thousands of blocks, for
+// example, in MinimumVolumeBox3 with NumWords = 2561 for 'double' inputs.
+// Define the threshold before including this file to tune it for your
+// platform.  The value must be at least 4.
+#if !defined(GTE_UINTEGERALU32_KARATSUBA_THRESHOLD)
+#define GTE_UINTEGERALU32_KARATSUBA_THRESHOLD 48
+#endif
+
+// On compilers that support unsigned __int128 (GCC and Clang on 64-bit
+// targets), the schoolbook multiplication processes pairs of 32-bit blocks
+// as 64-bit blocks, which reduces the number of multiply-accumulate steps by
+// a factor of 4.  The products are computed with all na+nb output blocks
+// rather than accumulated in place, so this applies only when both inputs
+// have at least GTE_UINTEGERALU32_INT128_THRESHOLD blocks; the smaller
+// products are accumulated directly into the output.  Define GTE_DISABLE_INT128 to use
+// only the portable 32-bit code.
+#if defined(__SIZEOF_INT128__) && !defined(GTE_DISABLE_INT128)
+#define GTE_UINTEGERALU32_USE_INT128
+#if !defined(GTE_UINTEGERALU32_INT128_THRESHOLD)
+#define GTE_UINTEGERALU32_INT128_THRESHOLD 12
+#endif
+#endif
+
 namespace gte
 {
     template <typename UInteger>
@@ -196,6 +225,7 @@ namespace gte
             {
                 self.SetNumBits(--numBits);
             }
+            RecordStatistics(UIntegerStatistics::ADD);
         }
 
         void Sub(UInteger const& n0, UInteger const& n1)
@@ -283,6 +313,7 @@ namespace gte
                 LogWarning("The difference of the number is zero, which violates the precondition n0 > n1.");
                 self.SetNumBits(0);
             }
+            RecordStatistics(UIntegerStatistics::SUB);
         }
 
         void Mul(UInteger const& n0, UInteger const& n1)
@@ -298,65 +329,103 @@ namespace gte
             self.SetNumBits(numBits);
             auto& bits = self.GetBits();
 
-            // Product of a single-block number with a multiple-block number.
-            UInteger product;
-            product.SetNumBits(numBits);
-            auto& pBits = product.GetBits();
+            // The large products are computed in a temporary array by
+            // MulKaratsuba, which uses MulSchoolbook for the small
+            // subproducts.
+#if defined(GTE_UINTEGERALU32_USE_INT128)
+            int32_t const minElements = std::min(GTE_UINTEGERALU32_INT128_THRESHOLD,
+                GTE_UINTEGERALU32_KARATSUBA_THRESHOLD);
+#else
+            int32_t const minElements = GTE_UINTEGERALU32_KARATSUBA_THRESHOLD;
+#endif
+            if (std::min(n0.GetSize(), n1.GetSize()) >= minElements)
+            {
+                // The product has numElements0 + numElements1 blocks, but
+                // 'self' might have one block fewer, in which case the
+                // leading block of the product is zero. The product is
+                // computed in the storage of 'self' when it has all the
+                // blocks; otherwise, it is computed in the workspace and
+                // copied.
+                int32_t const numElements0 = n0.GetSize();
+                int32_t const numElements1 = n1.GetSize();
+                int32_t const numElements = self.GetSize();
+                size_t const numProduct = static_cast<size_t>(numElements0) + static_cast<size_t>(numElements1);
+                size_t const numScratch = GetKaratsubaScratchSize(numElements0, numElements1);
+                if (static_cast<size_t>(numElements) == numProduct)
+                {
+                    uint32_t* scratch = GetWorkspace(numScratch);
+                    MulKaratsuba(&n0Bits[0], numElements0, &n1Bits[0], numElements1, &bits[0], scratch);
+                }
+                else
+                {
+                    uint32_t* product = GetWorkspace(numProduct + numScratch);
+                    MulKaratsuba(&n0Bits[0], numElements0, &n1Bits[0], numElements1, product, product + numProduct);
+                    std::copy(product, product + numElements, &bits[0]);
+                }
+
+                // Reduce the number of bits if there was not a carry-out.
+                uint32_t firstBitIndex = (numBits - 1) % 32;
+                uint32_t mask = (1 << firstBitIndex);
+                if ((mask & self.GetBack()) == 0)
+                {
+                    self.SetNumBits(--numBits);
+                }
+                RecordStatistics(UIntegerStatistics::MUL);
+                return;
+            }
 
             // Get the array sizes.
             int32_t const numElements0 = n0.GetSize();
             int32_t const numElements1 = n1.GetSize();
             int32_t const numElements = self.GetSize();
 
-            // Compute the product v = u0*u1.
+            // Compute the product v = u0*u1.  The products of the blocks of
+            // u1 with a block of u0 are accumulated directly into v.  The
+            // sum block0*u1[i1] + v[i2] + carry is at most 2^{64}-1, so it
+            // fits in a uint64_t and no intermediate number is needed.  The
+            // loops use raw pointers so that the compiler does not reload
+            // the storage of the UInteger objects on each iteration.
+            uint32_t const* u0 = &n0Bits[0];
+            uint32_t const* u1 = &n1Bits[0];
+            uint32_t* v = &bits[0];
             int32_t i0, i1, i2;
-            uint64_t term, sum;
+            uint64_t term;
 
             // The case i0 == 0 is handled separately to initialize the
             // accumulator with u0[0]*v.  This avoids having to fill the bytes
             // of 'bits' with zeros outside the double loop, something that
             // can be a performance issue when 'numBits' is large.
-            uint64_t block0 = n0Bits[0];
+            uint64_t block0 = u0[0];
             uint64_t carry = 0;
             for (i1 = 0; i1 < numElements1; ++i1)
             {
-                term = block0 * n1Bits[i1] + carry;
-                bits[i1] = (uint32_t)(term & 0x00000000FFFFFFFFull);
+                term = block0 * u1[i1] + carry;
+                v[i1] = (uint32_t)(term & 0x00000000FFFFFFFFull);
                 carry = (term >> 32);
             }
             if (i1 < numElements)
             {
-                bits[i1] = (uint32_t)(carry & 0x00000000FFFFFFFFull);
+                v[i1] = (uint32_t)(carry & 0x00000000FFFFFFFFull);
             }
 
             for (i0 = 1; i0 < numElements0; ++i0)
             {
-                // Compute the product p = u0[i0]*u1.
-                block0 = n0Bits[i0];
+                // Add the product u0[i0]*u1 to the accumulator v.  The block
+                // v[i0 + numElements1] has not yet been written, so it is
+                // assigned the carry-out.
+                block0 = u0[i0];
                 carry = 0;
-                for (i1 = 0, i2 = i0; i1 < numElements1; ++i1, ++i2)
+                uint32_t* vShifted = v + i0;
+                for (i1 = 0; i1 < numElements1; ++i1)
                 {
-                    term = block0 * n1Bits[i1] + carry;
-                    pBits[i2] = (uint32_t)(term & 0x00000000FFFFFFFFull);
+                    term = block0 * u1[i1] + vShifted[i1] + carry;
+                    vShifted[i1] = (uint32_t)(term & 0x00000000FFFFFFFFull);
                     carry = (term >> 32);
                 }
+                i2 = i0 + numElements1;
                 if (i2 < numElements)
                 {
-                    pBits[i2] = (uint32_t)(carry & 0x00000000FFFFFFFFull);
-                }
-
-                // Add p to the accumulator v.
-                carry = 0;
-                for (i1 = 0, i2 = i0; i1 < numElements1; ++i1, ++i2)
-                {
-                    sum = pBits[i2] + (bits[i2] + carry);
-                    bits[i2] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
-                    carry = (sum >> 32);
-                }
-                if (i2 < numElements)
-                {
-                    sum = pBits[i2] + carry;
-                    bits[i2] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                    v[i2] = (uint32_t)(carry & 0x00000000FFFFFFFFull);
                 }
             }
 
@@ -367,6 +436,7 @@ namespace gte
             {
                 self.SetNumBits(--numBits);
             }
+            RecordStatistics(UIntegerStatistics::MUL);
         }
 
         // The shift is performed in-place; that is, the result is stored in
@@ -423,6 +493,7 @@ namespace gte
                     bits[i] = nBits[j];
                 }
             }
+            RecordStatistics(UIntegerStatistics::SHIFT_LEFT);
         }
 
         // The 'number' is even and positive.  It is shifted right to become
@@ -483,6 +554,8 @@ namespace gte
                 }
             }
 
+            RecordStatistics(UIntegerStatistics::SHIFT_RIGHT_TO_ODD);
+
             return rshift + 32 * shiftBlock;
         }
 
@@ -553,5 +626,279 @@ namespace gte
 
             return prefix;
         }
+
+    private:
+        // Support for UIntegerStatistics.  The call is compiled out unless
+        // GTE_COLLECT_UINTEGER_STATISTICS is defined.
+        inline void RecordStatistics(UIntegerStatistics::Operation operation) const
+        {
+#if defined(GTE_COLLECT_UINTEGER_STATISTICS)
+            UInteger const& self = *(UInteger const*)this;
+            UIntegerStatistics::Record(operation, self.GetSize(), self.GetNumBits());
+#else
+            (void)operation;
+#endif
+        }
+
+        // Support for Karatsuba multiplication.  The functions operate on
+        // arrays of 32-bit blocks, least significant block first.  The
+        // product of a[0..na-1] and b[0..nb-1] is stored in r[0..na+nb-1],
+        // where 'r' must not overlap the inputs.
+        static void MulSchoolbook(uint32_t const* a, int32_t na,
+            uint32_t const* b, int32_t nb, uint32_t* r)
+        {
+#if defined(GTE_UINTEGERALU32_USE_INT128)
+            // Multiply the even-length prefixes using 64-bit blocks, then
+            // add the products involving the leading block of an input of
+            // odd length.
+            int32_t const na2 = (na & ~1), nb2 = (nb & ~1);
+            std::fill(r + na2 + nb2, r + na + nb, 0u);
+            MulSchoolbook64(a, na2 / 2, b, nb2 / 2, r);
+            if (nb2 < nb)
+            {
+                AddMulInPlace(r + nb2, na + 1, b[nb2], a, na2);
+            }
+            if (na2 < na)
+            {
+                AddMulInPlace(r + na2, nb + 1, a[na2], b, nb);
+            }
+#else
+            std::fill(r, r + na + nb, 0u);
+            for (int32_t i = 0; i < na; ++i)
+            {
+                uint64_t block = a[i];
+                uint64_t carry = 0, term;
+                for (int32_t j = 0; j < nb; ++j)
+                {
+                    term = block * b[j] + r[i + j] + carry;
+                    r[i + j] = (uint32_t)(term & 0x00000000FFFFFFFFull);
+                    carry = (term >> 32);
+                }
+                r[i + nb] = (uint32_t)(carry & 0x00000000FFFFFFFFull);
+            }
+#endif
+        }
+
+#if defined(GTE_UINTEGERALU32_USE_INT128)
+        // The inputs have 2*na and 2*nb blocks, processed as na and nb
+        // 64-bit blocks.  The product is stored in r[0..2*(na+nb)-1].
+        static void MulSchoolbook64(uint32_t const* a, int32_t na,
+            uint32_t const* b, int32_t nb, uint32_t* r)
+        {
+            std::fill(r, r + 2 * (na + nb), 0u);
+            for (int32_t i = 0; i < na; ++i)
+            {
+                unsigned __int128 block = Load64(a + 2 * i);
+                uint64_t carry = 0;
+                uint32_t* rShifted = r + 2 * i;
+                for (int32_t j = 0; j < nb; ++j)
+                {
+                    unsigned __int128 term = block * Load64(b + 2 * j)
+                        + Load64(rShifted + 2 * j) + carry;
+                    Store64(rShifted + 2 * j, (uint64_t)term);
+                    carry = (uint64_t)(term >> 64);
+                }
+                Store64(rShifted + 2 * nb, carry);
+            }
+        }
+
+        static inline uint64_t Load64(uint32_t const* source)
+        {
+            return (uint64_t)source[0] | ((uint64_t)source[1] << 32);
+        }
+
+        static inline void Store64(uint32_t* target, uint64_t value)
+        {
+            target[0] = (uint32_t)(value & 0x00000000FFFFFFFFull);
+            target[1] = (uint32_t)(value >> 32);
+        }
+
+        // Compute r[0..nr-1] += block * a[0..na-1] for na < nr.  The caller
+        // must ensure that the sum does not overflow.
+        static void AddMulInPlace(uint32_t* r, int32_t nr, uint32_t block,
+            uint32_t const* a, int32_t na)
+        {
+            uint64_t carry = 0, term;
+            int32_t i;
+            for (i = 0; i < na; ++i)
+            {
+                term = (uint64_t)block * a[i] + r[i] + carry;
+                r[i] = (uint32_t)(term & 0x00000000FFFFFFFFull);
+                carry = (term >> 32);
+            }
+            for (/**/; carry > 0 && i < nr; ++i)
+            {
+                term = (uint64_t)r[i] + carry;
+                r[i] = (uint32_t)(term & 0x00000000FFFFFFFFull);
+                carry = (term >> 32);
+            }
+        }
+#endif
+
+        // Compute r[0..nr-1] += a[0..na-1] for na <= nr.  The carry-out
+        // from r[nr-1] is returned.
+        static uint32_t AddInPlace(uint32_t* r, int32_t nr, uint32_t const* a, int32_t na)
+        {
+            uint64_t carry = 0, sum;
+            int32_t i;
+            for (i = 0; i < na; ++i)
+            {
+                sum = (uint64_t)r[i] + (uint64_t)a[i] + carry;
+                r[i] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                carry = (sum >> 32);
+            }
+            for (/**/; carry > 0 && i < nr; ++i)
+            {
+                sum = (uint64_t)r[i] + carry;
+                r[i] = (uint32_t)(sum & 0x00000000FFFFFFFFull);
+                carry = (sum >> 32);
+            }
+            return (uint32_t)carry;
+        }
+
+        // Compute r[0..nr-1] -= a[0..na-1] for na <= nr.  The caller must
+        // ensure the difference is nonnegative.
+        static void SubInPlace(uint32_t* r, int32_t nr, uint32_t const* a, int32_t na)
+        {
+            int64_t borrow = 0, diff;
+            int32_t i;
+            for (i = 0; i < na; ++i)
+            {
+                diff = (int64_t)r[i] - (int64_t)a[i] - borrow;
+                borrow = (diff < 0 ? 1 : 0);
+                r[i] = (uint32_t)(diff + (borrow << 32));
+            }
+            for (/**/; borrow > 0 && i < nr; ++i)
+            {
+                diff = (int64_t)r[i] - borrow;
+                borrow = (diff < 0 ? 1 : 0);
+                r[i] = (uint32_t)(diff + (borrow << 32));
+            }
+        }
+
+        // The temporary arrays of MulKaratsuba are in a per-thread
+        // workspace that grows as needed and is reused, so a multiplication
+        // does not allocate once the workspace is large enough. This keeps
+        // UIntegerSB32 and UIntegerArena32 off the global heap.
+        static uint32_t* GetWorkspace(size_t numWords)
+        {
+            static thread_local std::vector<uint32_t> workspace;
+            if (workspace.size() < numWords)
+            {
+                workspace.resize(numWords);
+            }
+            return workspace.data();
+        }
+
+        // The number of blocks of scratch memory used by MulKaratsuba for
+        // inputs with na and nb blocks.
+        static size_t GetKaratsubaScratchSize(int32_t na, int32_t nb)
+        {
+            if (na < nb)
+            {
+                std::swap(na, nb);
+            }
+
+            if (nb < GTE_UINTEGERALU32_KARATSUBA_THRESHOLD)
+            {
+                return 0;
+            }
+
+            if (na > nb)
+            {
+                // The partial product is followed by the scratch memory of
+                // the products of the chunks of a.
+                size_t numChunkScratch = GetKaratsubaScratchSize(nb, nb);
+                int32_t const remainder = na % nb;
+                if (remainder > 0)
+                {
+                    numChunkScratch = std::max(numChunkScratch,
+                        GetKaratsubaScratchSize(remainder, nb));
+                }
+                return 2 * static_cast<size_t>(nb) + numChunkScratch;
+            }
+
+            // The sums and z1 are followed by the scratch memory of the
+            // subproducts, the largest of which has h+1 blocks per input.
+            int32_t const h = na - na / 2;
+            return 4 * (static_cast<size_t>(h) + 1) + GetKaratsubaScratchSize(h + 1, h + 1);
+        }
+
+        // The product is stored in r[0..na+nb-1]. The scratch array must
+        // have GetKaratsubaScratchSize(na, nb) blocks.
+        static void MulKaratsuba(uint32_t const* a, int32_t na,
+            uint32_t const* b, int32_t nb, uint32_t* r, uint32_t* scratch)
+        {
+            static_assert(GTE_UINTEGERALU32_KARATSUBA_THRESHOLD >= 4,
+                "The Karatsuba threshold must be at least 4.");
+
+            if (na < nb)
+            {
+                std::swap(a, b);
+                std::swap(na, nb);
+            }
+
+            if (nb < GTE_UINTEGERALU32_KARATSUBA_THRESHOLD)
+            {
+                MulSchoolbook(a, na, b, nb, r);
+                return;
+            }
+
+            if (na > nb)
+            {
+                // The inputs are unbalanced.  Multiply b by nb-block chunks
+                // of a and accumulate the partial products.
+                std::fill(r, r + na + nb, 0u);
+                uint32_t* partial = scratch;
+                for (int32_t offset = 0; offset < na; offset += nb)
+                {
+                    int32_t numChunk = std::min(nb, na - offset);
+                    MulKaratsuba(a + offset, numChunk, b, nb, partial, scratch + 2 * nb);
+                    AddInPlace(r + offset, na + nb - offset, partial, numChunk + nb);
+                }
+                return;
+            }
+
+            // The inputs have the same number of blocks n.  Split them as
+            // a = a1*B^m + a0 and b = b1*B^m + b0, where B = 2^32, a0 and b0
+            // have m blocks, and a1 and b1 have h = n - m >= m blocks.  The
+            // product is z2*B^{2m} + z1*B^m + z0, where z0 = a0*b0,
+            // z2 = a1*b1 and z1 = (a0+a1)*(b0+b1) - z0 - z2.
+            int32_t const n = na;
+            int32_t const m = n / 2;
+            int32_t const h = n - m;
+            uint32_t const* a0 = a;
+            uint32_t const* a1 = a + m;
+            uint32_t const* b0 = b;
+            uint32_t const* b1 = b + m;
+
+            // The scratch memory stores sa, sb and z1, each with at most
+            // 2h+2 blocks, followed by that of the subproducts.
+            uint32_t* sa = scratch;
+            uint32_t* sb = sa + h + 1;
+            uint32_t* z1 = sb + h + 1;
+            uint32_t* subScratch = z1 + 2 * (h + 1);
+
+            // r[0..2m-1] = z0, r[2m..2n-1] = z2.
+            MulKaratsuba(a0, m, b0, m, r, subScratch);
+            MulKaratsuba(a1, h, b1, h, r + 2 * m, subScratch);
+
+            // sa = a0 + a1 and sb = b0 + b1, each with h+1 blocks.
+            std::copy(a1, a1 + h, sa);
+            sa[h] = AddInPlace(sa, h, a0, m);
+            std::copy(b1, b1 + h, sb);
+            sb[h] = AddInPlace(sb, h, b0, m);
+
+            // z1 = sa*sb - z0 - z2, which has at most 2h+2 blocks.
+            int32_t const nz1 = 2 * (h + 1);
+            MulKaratsuba(sa, h + 1, sb, h + 1, z1, subScratch);
+            SubInPlace(z1, nz1, r, 2 * m);
+            SubInPlace(z1, nz1, r + 2 * m, 2 * h);
+
+            // Add z1*B^m to the result.  The sum fits in 2n blocks, so the
+            // leading blocks of z1 beyond that are zero.
+            int32_t const numAdd = std::min(nz1, 2 * n - m);
+            AddInPlace(r + m, 2 * n - m, z1, numAdd);
+        }
     };
 }
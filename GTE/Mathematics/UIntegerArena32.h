@@ -0,0 +1,521 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/UIntegerALU32.h>
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Class UIntegerArena32 is designed to support arbitrary precision arithmetic
+// using BSNumber and BSRational. It is not a general-purpose class for
+// arithmetic of unsigned integers. The class has the same semantics as
+// UIntegerAP32, but its storage is obtained from a per-thread arena,
+// UIntegerArena32::Arena, rather than from the global heap. Long BSRational
+// computations allocate and free many short-lived blocks of 32-bit words.
+// In multithreaded code, the global heap is shared by the threads and the
+// allocations contend. The arena of a thread is accessed only by that
+// thread, so no locking is required.
+//
+// The arena stores the blocks in large chunks. A block has a capacity that
+// is a power of two. When a block is released, it is placed on a free list
+// for its capacity and reused by later requests of the same capacity. The
+// chunks are released when the thread exits.
+//
+// The arena also supports a scoped reset. Create an object of type
+// UIntegerArena32::Scope before a batch of computations. When the object
+// is destroyed, all arena memory obtained since its construction is
+// recycled in one step. No UIntegerArena32 object created in the scope may
+// be used after the scope ends. Convert the results that must persist, for
+// example, to 'double' or to a BSNumber that uses UIntegerAP32, before the
+// scope ends. An object created before the scope must not obtain memory
+// inside the scope, because that memory is recycled while the object still
+// uses it; such an allocation is an error. Each block is tagged with the
+// depth of the scope in which it was allocated, and a scope does not
+// recycle its memory while blocks of its depth or deeper are in use, for
+// example, when a block of the scope is moved to an object created before
+// the scope.
+//
+// A UIntegerArena32 object must be created and destroyed by the same thread,
+// which is natural for the temporaries of exact predicates. Objects may not
+// be passed between threads.
+
+namespace gte
+{
+    class UIntegerArena32 : public UIntegerALU32<UIntegerArena32>
+    {
+    public:
+        // The per-thread arena of blocks of 32-bit words.
+        class Arena
+        {
+        public:
+            // Access the arena of the calling thread.
+            static Arena& Get()
+            {
+                static thread_local Arena arena;
+                return arena;
+            }
+
+            Arena(Arena const&) = delete;
+            Arena& operator=(Arena const&) = delete;
+
+            // Allocate a block with at least the requested number of words.
+            // On return, 'capacity' is the actual number of words, a power
+            // of two.
+            uint32_t* Allocate(int32_t numRequested, int32_t& capacity)
+            {
+                int32_t index = GetCapacityIndex(numRequested);
+                capacity = (1 << index);
+                ++mNumLive;
+                ++mNumLiveAtDepth[mDepth];
+
+                uint32_t* block = mFreeList[index];
+                if (block)
+                {
+                    mFreeList[index] = ToLink(block);
+                    return block;
+                }
+
+                size_t const numWords = static_cast<size_t>(capacity);
+                while (mCurrentChunk < mChunks.size())
+                {
+                    Chunk& chunk = mChunks[mCurrentChunk];
+                    if (mCurrentOffset + numWords <= chunk.size)
+                    {
+                        block = chunk.words.get() + mCurrentOffset;
+                        mCurrentOffset += numWords;
+                        return block;
+                    }
+                    ++mCurrentChunk;
+                    mCurrentOffset = 0;
+                }
+
+                // The arena is full, so allocate a new chunk.
+                Chunk chunk;
+                chunk.size = std::max(numWords, GetChunkSize());
+                chunk.words = std::make_unique<uint32_t[]>(chunk.size);
+                block = chunk.words.get();
+                mChunks.push_back(std::move(chunk));
+                mCurrentChunk = mChunks.size() - 1;
+                mCurrentOffset = numWords;
+                return block;
+            }
+
+            // Release a block to the free list for its capacity. The depth
+            // is that of the arena when the block was allocated.
+            void Deallocate(uint32_t* block, int32_t capacity, int32_t depth)
+            {
+                if (block)
+                {
+                    int32_t index = GetCapacityIndex(capacity);
+                    ToLink(block) = mFreeList[index];
+                    mFreeList[index] = block;
+                    --mNumLive;
+                    --mNumLiveAtDepth[depth];
+                }
+            }
+
+            // Recycle all memory of the arena. No block obtained from the
+            // arena may be used after the call. The chunks are retained for
+            // reuse.
+            void Reset()
+            {
+                mFreeList.fill(nullptr);
+                mCurrentChunk = 0;
+                mCurrentOffset = 0;
+                mNumLive = 0;
+                mNumLiveAtDepth.fill(0);
+            }
+
+            // Release the chunks to the global heap. The arena must not have
+            // live blocks.
+            void Release()
+            {
+                LogAssert(mNumLive == 0, "The arena has live blocks.");
+                Reset();
+                mChunks.clear();
+            }
+
+            // Statistics.
+            inline size_t GetNumChunks() const
+            {
+                return mChunks.size();
+            }
+
+            inline int64_t GetNumLiveBlocks() const
+            {
+                return mNumLive;
+            }
+
+            // The number of Scope objects of the thread that are alive.
+            inline int32_t GetDepth() const
+            {
+                return mDepth;
+            }
+
+        private:
+            friend class UIntegerArena32;
+
+            Arena()
+                :
+                mCurrentChunk(0),
+                mCurrentOffset(0),
+                mNumLive(0),
+                mDepth(0)
+            {
+                mFreeList.fill(nullptr);
+                mNumLiveAtDepth.fill(0);
+            }
+
+            struct Chunk
+            {
+                Chunk()
+                    :
+                    size(0)
+                {
+                }
+
+                size_t size;
+                std::unique_ptr<uint32_t[]> words;
+            };
+
+            // The capacity of a block is 2^index words, where the minimum
+            // index is 2 so that a free block can store a link pointer.
+            static int32_t GetCapacityIndex(int32_t numRequested)
+            {
+                int32_t index = 2;
+                while ((1 << index) < numRequested)
+                {
+                    ++index;
+                }
+                return index;
+            }
+
+            static uint32_t*& ToLink(uint32_t* block)
+            {
+                return *reinterpret_cast<uint32_t**>(block);
+            }
+
+            // The number of words in a chunk, 256 KB.
+            inline static size_t GetChunkSize()
+            {
+                return 65536;
+            }
+
+            // The maximum nesting of Scope objects.
+            static int32_t constexpr maxDepth = 32;
+
+            std::vector<Chunk> mChunks;
+            size_t mCurrentChunk, mCurrentOffset;
+            std::array<uint32_t*, 32> mFreeList;
+            int64_t mNumLive;
+
+            // The live blocks by the depth at their allocation.
+            int32_t mDepth;
+            std::array<int64_t, maxDepth + 1> mNumLiveAtDepth;
+        };
+
+        // The scoped reset of the arena of the calling thread. On
+        // destruction, the bump allocation is rewound to its state at
+        // construction and the free lists are cleared, because they might
+        // contain blocks of the rewound memory. Blocks that were free before
+        // the scope are not reused until the next Arena::Reset(). When
+        // blocks allocated in the scope or in scopes nested in it are still
+        // in use, the memory is not rewound; it is recycled by an enclosing
+        // scope or by Arena::Reset() after the blocks are released.
+        class Scope
+        {
+        public:
+            Scope()
+                :
+                mArena(Arena::Get()),
+                mCurrentChunk(mArena.mCurrentChunk),
+                mCurrentOffset(mArena.mCurrentOffset),
+                mDepth(mArena.mDepth + 1)
+            {
+                LogAssert(mDepth <= Arena::maxDepth, "Too many nested scopes.");
+                mArena.mDepth = mDepth;
+            }
+
+            ~Scope()
+            {
+                mArena.mDepth = mDepth - 1;
+
+                int64_t numLive = 0;
+                for (int32_t depth = mDepth; depth <= Arena::maxDepth; ++depth)
+                {
+                    numLive += mArena.mNumLiveAtDepth[depth];
+                }
+                if (numLive > 0)
+                {
+                    // A destructor must not throw, so the error is reported
+                    // as a warning. The memory remains valid.
+                    LogWarning("Arena blocks of the scope are in use, so its memory is not recycled.");
+                    return;
+                }
+
+                mArena.mCurrentChunk = mCurrentChunk;
+                mArena.mCurrentOffset = mCurrentOffset;
+                mArena.mFreeList.fill(nullptr);
+            }
+
+            Scope(Scope const&) = delete;
+            Scope& operator=(Scope const&) = delete;
+
+        private:
+            Arena& mArena;
+            size_t mCurrentChunk, mCurrentOffset;
+            int32_t mDepth;
+        };
+
+        // Construction and destruction.
+        UIntegerArena32()
+            :
+            mNumBits(0),
+            mSize(0),
+            mCapacity(0),
+            mBits(nullptr),
+            mBlockDepth(0),
+            mScopeDepth(Arena::Get().GetDepth())
+        {
+        }
+
+        UIntegerArena32(UIntegerArena32 const& number)
+            :
+            mNumBits(0),
+            mSize(0),
+            mCapacity(0),
+            mBits(nullptr),
+            mBlockDepth(0),
+            mScopeDepth(Arena::Get().GetDepth())
+        {
+            *this = number;
+        }
+
+        UIntegerArena32(uint32_t number)
+            :
+            mNumBits(0),
+            mSize(0),
+            mCapacity(0),
+            mBits(nullptr),
+            mBlockDepth(0),
+            mScopeDepth(Arena::Get().GetDepth())
+        {
+            if (number > 0)
+            {
+                int32_t first = BitHacks::GetLeadingBit(number);
+                int32_t last = BitHacks::GetTrailingBit(number);
+                SetNumBits(first - last + 1);
+                mBits[0] = (number >> last);
+            }
+        }
+
+        UIntegerArena32(uint64_t number)
+            :
+            mNumBits(0),
+            mSize(0),
+            mCapacity(0),
+            mBits(nullptr),
+            mBlockDepth(0),
+            mScopeDepth(Arena::Get().GetDepth())
+        {
+            if (number > 0)
+            {
+                int32_t first = BitHacks::GetLeadingBit(number);
+                int32_t last = BitHacks::GetTrailingBit(number);
+                number >>= last;
+                SetNumBits(first - last + 1);
+                mBits[0] = (uint32_t)(number & 0x00000000FFFFFFFFull);
+                if (mSize > 1)
+                {
+                    mBits[1] = (uint32_t)((number >> 32) & 0x00000000FFFFFFFFull);
+                }
+            }
+        }
+
+        ~UIntegerArena32()
+        {
+            Arena::Get().Deallocate(mBits, mCapacity, mBlockDepth);
+        }
+
+        // Assignment.  Only mSize elements are copied.
+        UIntegerArena32& operator=(UIntegerArena32 const& number)
+        {
+            if (this != &number)
+            {
+                mSize = 0;
+                SetNumBits(number.mNumBits);
+                std::copy(number.mBits, number.mBits + mSize, mBits);
+            }
+            return *this;
+        }
+
+        // Support for std::move.  The block of 'number' is stolen.
+        UIntegerArena32(UIntegerArena32&& number) noexcept
+            :
+            mNumBits(number.mNumBits),
+            mSize(number.mSize),
+            mCapacity(number.mCapacity),
+            mBits(number.mBits),
+            mBlockDepth(number.mBlockDepth),
+            mScopeDepth(Arena::Get().GetDepth())
+        {
+            number.mNumBits = 0;
+            number.mSize = 0;
+            number.mCapacity = 0;
+            number.mBits = nullptr;
+        }
+
+        UIntegerArena32& operator=(UIntegerArena32&& number) noexcept
+        {
+            if (this != &number)
+            {
+                Arena::Get().Deallocate(mBits, mCapacity, mBlockDepth);
+                mNumBits = number.mNumBits;
+                mSize = number.mSize;
+                mCapacity = number.mCapacity;
+                mBits = number.mBits;
+                mBlockDepth = number.mBlockDepth;
+                number.mNumBits = 0;
+                number.mSize = 0;
+                number.mCapacity = 0;
+                number.mBits = nullptr;
+            }
+            return *this;
+        }
+
+        // Member access.  The active bits are preserved when the storage is
+        // resized, which is required by UIntegerALU32.
+        void SetNumBits(int32_t numBits)
+        {
+            if (numBits > 0)
+            {
+                int32_t size = 1 + (numBits - 1) / 32;
+                if (size > mCapacity)
+                {
+                    Arena& arena = Arena::Get();
+                    if (mScopeDepth < arena.GetDepth())
+                    {
+                        LogError("An object created before a scope cannot allocate in the scope.");
+                    }
+                    int32_t capacity;
+                    uint32_t* bits = arena.Allocate(size, capacity);
+                    std::copy(mBits, mBits + mSize, bits);
+                    arena.Deallocate(mBits, mCapacity, mBlockDepth);
+                    mBits = bits;
+                    mCapacity = capacity;
+                    mBlockDepth = arena.GetDepth();
+                }
+                mNumBits = numBits;
+                mSize = size;
+            }
+            else if (numBits == 0)
+            {
+                mNumBits = 0;
+                mSize = 0;
+            }
+            else
+            {
+                LogError("The number of bits must be nonnegative.");
+            }
+        }
+
+        inline int32_t GetNumBits() const
+        {
+            return mNumBits;
+        }
+
+        inline uint32_t const* GetBits() const
+        {
+            return mBits;
+        }
+
+        inline uint32_t*& GetBits()
+        {
+            return mBits;
+        }
+
+        inline void SetBack(uint32_t value)
+        {
+            mBits[mSize - 1] = value;
+        }
+
+        inline uint32_t GetBack() const
+        {
+            return mBits[mSize - 1];
+        }
+
+        inline int32_t GetSize() const
+        {
+            return mSize;
+        }
+
+        inline static int32_t GetMaxSize()
+        {
+            return std::numeric_limits<int32_t>::max();
+        }
+
+        inline void SetAllBitsToZero()
+        {
+            std::fill(mBits, mBits + mSize, 0u);
+        }
+
+        // Disk input/output.  The fstream objects should be created using
+        // std::ios::binary.  The return value is 'true' iff the operation
+        // was successful.  The format is the same as that of UIntegerFP32.
+        bool Write(std::ostream& output) const
+        {
+            if (output.write((char const*)& mNumBits, sizeof(mNumBits)).bad())
+            {
+                return false;
+            }
+
+            if (output.write((char const*)& mSize, sizeof(mSize)).bad())
+            {
+                return false;
+            }
+
+            return output.write((char const*)mBits, mSize * sizeof(mBits[0])).good();
+        }
+
+        bool Read(std::istream& input)
+        {
+            int32_t numBits, size;
+            if (input.read((char*)& numBits, sizeof(numBits)).bad())
+            {
+                return false;
+            }
+
+            if (input.read((char*)& size, sizeof(size)).bad())
+            {
+                return false;
+            }
+
+            mSize = 0;
+            SetNumBits(numBits);
+            if (mSize != size)
+            {
+                return false;
+            }
+            return input.read((char*)mBits, mSize * sizeof(mBits[0])).good();
+        }
+
+    private:
+        int32_t mNumBits, mSize, mCapacity;
+        uint32_t* mBits;
+
+        // The depth of the arena when mBits was allocated and when the
+        // object was created.
+        int32_t mBlockDepth, mScopeDepth;
+    };
+}
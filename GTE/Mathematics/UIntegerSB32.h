@@ -0,0 +1,347 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/UIntegerALU32.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+// Class UIntegerSB32 is designed to support arbitrary precision arithmetic
+// using BSNumber and BSRational.  It is not a general-purpose class for
+// arithmetic of unsigned integers.  The class is a drop-in replacement for
+// UIntegerAP32 that uses small-buffer storage.  The template parameter N is
+// the number of 32-bit words stored inline in the object.  As long as a
+// number requires at most N words, no dynamic memory allocations occur.
+// When a number requires more than N words, the storage grows to the heap
+// using std::vector<uint32_t>, so there is no upper bound on the precision
+// as there is for UIntegerFP32<N>.  The typical exact predicates for 'float'
+// or 'double' inputs of PrimalQuery2 and PrimalQuery3 fit in N = 16 words
+// or fewer, depending on the predicate; see BSPrecision for computing the
+// precise bounds.
+//
+// The GetBits() functions return a pointer to the active storage, either the
+// inline array or the heap array.  The UIntegerALU32 and BSNumber code
+// accesses the bits only through operator[], so the pointer is a valid
+// substitute for a std::vector or std::array.
+
+// Uncomment this to collect statistics on how large the UIntegerSB32 storage
+// becomes when using it for the UInteger of BSNumber and how often the
+// storage grows to the heap.  If you use this feature, you must define
+// gsUIntegerSB32MaxSize and gsUIntegerSB32NumHeapAllocations somewhere in
+// your code.  If gsUIntegerSB32MaxSize is at most N after a sequence of
+// BSNumber operations, the computations never allocated memory.
+//
+//#define GTE_COLLECT_UINTEGERSB32_STATISTICS
+
+#if defined(GTE_COLLECT_UINTEGERSB32_STATISTICS)
+#include <Mathematics/AtomicMinMax.h>
+namespace gte
+{
+    extern std::atomic<int32_t> gsUIntegerSB32MaxSize;
+    extern std::atomic<size_t> gsUIntegerSB32NumHeapAllocations;
+}
+#endif
+
+namespace gte
+{
+    template <int N = 16>
+    class UIntegerSB32 : public UIntegerALU32<UIntegerSB32<N>>
+    {
+    public:
+        // Construction.
+        UIntegerSB32()
+            :
+            mNumBits(0),
+            mSize(0),
+            mData(nullptr)
+        {
+            static_assert(N >= 2, "Invalid size N.");
+
+            mData = mInline.data();
+        }
+
+        UIntegerSB32(UIntegerSB32 const& number)
+            :
+            mNumBits(0),
+            mSize(0),
+            mData(nullptr)
+        {
+            static_assert(N >= 2, "Invalid size N.");
+
+            mData = mInline.data();
+
+            *this = number;
+        }
+
+        UIntegerSB32(uint32_t number)
+            :
+            mNumBits(0),
+            mSize(0),
+            mData(nullptr)
+        {
+            static_assert(N >= 2, "Invalid size N.");
+
+            mData = mInline.data();
+
+            if (number > 0)
+            {
+                int32_t first = BitHacks::GetLeadingBit(number);
+                int32_t last = BitHacks::GetTrailingBit(number);
+                mNumBits = first - last + 1;
+                mSize = 1;
+                mData[0] = (number >> last);
+            }
+
+#if defined(GTE_COLLECT_UINTEGERSB32_STATISTICS)
+            AtomicMax(gsUIntegerSB32MaxSize, mSize);
+#endif
+        }
+
+        UIntegerSB32(uint64_t number)
+            :
+            mNumBits(0),
+            mSize(0),
+            mData(nullptr)
+        {
+            static_assert(N >= 2, "Invalid size N.");
+
+            mData = mInline.data();
+
+            if (number > 0)
+            {
+                int32_t first = BitHacks::GetLeadingBit(number);
+                int32_t last = BitHacks::GetTrailingBit(number);
+                number >>= last;
+                mNumBits = first - last + 1;
+                mSize = 1 + (mNumBits - 1) / 32;
+                mData[0] = (uint32_t)(number & 0x00000000FFFFFFFFull);
+                if (mSize > 1)
+                {
+                    mData[1] = (uint32_t)((number >> 32) & 0x00000000FFFFFFFFull);
+                }
+            }
+
+#if defined(GTE_COLLECT_UINTEGERSB32_STATISTICS)
+            AtomicMax(gsUIntegerSB32MaxSize, mSize);
+#endif
+        }
+
+        // Assignment.  Only mSize elements are copied.  The heap storage of
+        // 'this' is reused when it is large enough.
+        UIntegerSB32& operator=(UIntegerSB32 const& number)
+        {
+            if (this != &number)
+            {
+                mNumBits = number.mNumBits;
+                mSize = number.mSize;
+                if (mSize <= N)
+                {
+                    mData = mInline.data();
+                }
+                else
+                {
+                    GrowHeap(false);
+                }
+                std::copy(number.mData, number.mData + mSize, mData);
+            }
+            return *this;
+        }
+
+        // Support for std::move.  When 'number' uses heap storage, the
+        // pointer is stolen.  When 'number' uses inline storage, only the
+        // mSize active elements are copied.  In either case 'number' is
+        // modified as if its data were stolen (mNumBits and mSize set to
+        // zero).
+        UIntegerSB32(UIntegerSB32&& number) noexcept
+            :
+            mNumBits(0),
+            mSize(0),
+            mData(nullptr)
+        {
+            mData = mInline.data();
+            *this = std::move(number);
+        }
+
+        UIntegerSB32& operator=(UIntegerSB32&& number) noexcept
+        {
+            if (this != &number)
+            {
+                mNumBits = number.mNumBits;
+                mSize = number.mSize;
+                if (number.mData == number.mInline.data())
+                {
+                    mData = mInline.data();
+                    std::copy(number.mData, number.mData + mSize, mData);
+                }
+                else
+                {
+                    mHeap = std::move(number.mHeap);
+                    mData = mHeap.data();
+                }
+                number.mNumBits = 0;
+                number.mSize = 0;
+                number.mData = number.mInline.data();
+            }
+            return *this;
+        }
+
+        // Member access.  The active bits are preserved when the storage is
+        // resized, which is required by UIntegerALU32.
+        void SetNumBits(int32_t numBits)
+        {
+            if (numBits > 0)
+            {
+                mNumBits = numBits;
+                mSize = 1 + (numBits - 1) / 32;
+                if (mSize > N)
+                {
+                    GrowHeap(true);
+                }
+            }
+            else if (numBits == 0)
+            {
+                mNumBits = 0;
+                mSize = 0;
+            }
+            else
+            {
+                LogError("The number of bits must be nonnegative.");
+            }
+
+#if defined(GTE_COLLECT_UINTEGERSB32_STATISTICS)
+            AtomicMax(gsUIntegerSB32MaxSize, mSize);
+#endif
+        }
+
+        inline int32_t GetNumBits() const
+        {
+            return mNumBits;
+        }
+
+        inline uint32_t const* GetBits() const
+        {
+            return mData;
+        }
+
+        inline uint32_t*& GetBits()
+        {
+            return mData;
+        }
+
+        inline void SetBack(uint32_t value)
+        {
+            mData[mSize - 1] = value;
+        }
+
+        inline uint32_t GetBack() const
+        {
+            return mData[mSize - 1];
+        }
+
+        inline int32_t GetSize() const
+        {
+            return mSize;
+        }
+
+        inline static int32_t GetMaxSize()
+        {
+            return std::numeric_limits<int32_t>::max();
+        }
+
+        inline void SetAllBitsToZero()
+        {
+            std::fill(mData, mData + mSize, 0u);
+        }
+
+        // Query whether the number fits in the inline storage.  This is
+        // useful for tuning N.
+        inline bool IsInline() const
+        {
+            return mData == mInline.data();
+        }
+
+        inline static int32_t GetInlineSize()
+        {
+            return N;
+        }
+
+        // Disk input/output.  The fstream objects should be created using
+        // std::ios::binary.  The return value is 'true' iff the operation
+        // was successful.  The format is the same as that of UIntegerFP32.
+        bool Write(std::ostream& output) const
+        {
+            if (output.write((char const*)& mNumBits, sizeof(mNumBits)).bad())
+            {
+                return false;
+            }
+
+            if (output.write((char const*)& mSize, sizeof(mSize)).bad())
+            {
+                return false;
+            }
+
+            return output.write((char const*)mData, mSize * sizeof(mData[0])).good();
+        }
+
+        bool Read(std::istream& input)
+        {
+            if (input.read((char*)& mNumBits, sizeof(mNumBits)).bad())
+            {
+                return false;
+            }
+
+            int32_t size;
+            if (input.read((char*)& size, sizeof(size)).bad())
+            {
+                return false;
+            }
+
+            mSize = size;
+            if (mSize <= N)
+            {
+                mData = mInline.data();
+            }
+            else
+            {
+                GrowHeap(false);
+            }
+            return input.read((char*)mData, mSize * sizeof(mData[0])).good();
+        }
+
+    private:
+        // Ensure the heap storage has at least mSize elements and make it the
+        // active storage.  If 'preserve' is true and the inline storage is
+        // active, its contents are copied to the heap.
+        void GrowHeap(bool preserve)
+        {
+            bool wasInline = (mData == mInline.data());
+            if (static_cast<int32_t>(mHeap.size()) < mSize)
+            {
+#if defined(GTE_COLLECT_UINTEGERSB32_STATISTICS)
+                ++gsUIntegerSB32NumHeapAllocations;
+#endif
+                mHeap.resize(mSize);
+            }
+            mData = mHeap.data();
+            if (preserve && wasInline)
+            {
+                std::copy(mInline.begin(), mInline.end(), mData);
+            }
+        }
+
+        int32_t mNumBits, mSize;
+        uint32_t* mData;
+        std::array<uint32_t, N> mInline;
+        std::vector<uint32_t> mHeap;
+    };
+}
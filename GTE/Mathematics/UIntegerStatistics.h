@@ -0,0 +1,287 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/AtomicMinMax.h>
+#include <Mathematics/Logger.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+// Instrumentation of the arbitrary-precision arithmetic of UIntegerALU32,
+// which is shared by all UInteger types of BSNumber and BSRational. The
+// instrumentation is compiled out by default. To enable it, define
+// GTE_COLLECT_UINTEGER_STATISTICS before including any of the arbitrary
+// precision headers, typically in the project settings. The following data
+// are collected:
+//   1. The number of calls to Add, Sub, Mul, ShiftLeft and ShiftRightToOdd,
+//      the last used by BSNumber to normalize results.
+//   2. For each operation, a histogram of the number of 32-bit blocks of the
+//      results. Bucket b counts the results with a number of blocks in
+//      (2^{b-1},2^b], where bucket 0 counts the results with 1 block.
+//   3. The peak number of bits of the results, both globally and for each
+//      call site. A call site is a named scope created by the macro
+//      GTE_UINTEGER_STATISTICS_SITE("name"). The operations called while
+//      the scope is active, directly or through nested function calls, are
+//      recorded for that site. The macro expands to nothing when the
+//      instrumentation is compiled out.
+// Call UIntegerStatistics::Report() to send the data to the Logger listeners
+// as an information message. The numbers are useful for choosing N for
+// UIntegerFP32<N> or UIntegerSB32<N> and for validating BSPrecision bounds
+// on production data.
+
+//#define GTE_COLLECT_UINTEGER_STATISTICS
+
+namespace gte
+{
+    class UIntegerStatistics
+    {
+    public:
+        enum Operation
+        {
+            ADD,
+            SUB,
+            MUL,
+            SHIFT_LEFT,
+            SHIFT_RIGHT_TO_ODD,
+            NUM_OPERATIONS
+        };
+
+        enum
+        {
+            NUM_BUCKETS = 32
+        };
+
+        class Site
+        {
+        public:
+            Site()
+                :
+                numCalls{},
+                maxNumBits(0)
+            {
+            }
+
+            std::array<std::atomic<uint64_t>, NUM_OPERATIONS> numCalls;
+            std::atomic<int32_t> maxNumBits;
+        };
+
+        // Activate a call site for the lifetime of the object. Call sites
+        // may be nested; the innermost one receives the data.
+        class ScopedSite
+        {
+        public:
+            ScopedSite(Site& site)
+                :
+                mPrevious(CurrentSite())
+            {
+                CurrentSite() = &site;
+            }
+
+            ~ScopedSite()
+            {
+                CurrentSite() = mPrevious;
+            }
+
+            ScopedSite(ScopedSite const&) = delete;
+            ScopedSite& operator=(ScopedSite const&) = delete;
+
+        private:
+            Site* mPrevious;
+        };
+
+        // Get the call-site record for the specified name, creating it if
+        // necessary. The returned reference is valid for the lifetime of
+        // the program.
+        static Site& GetSite(std::string const& name)
+        {
+            std::lock_guard<std::mutex> lock(Mutex());
+            auto& sites = Sites();
+            auto iter = sites.find(name);
+            if (iter == sites.end())
+            {
+                iter = sites.insert(std::make_pair(name, std::make_unique<Site>())).first;
+            }
+            return *iter->second;
+        }
+
+        // Record an operation whose result has the specified number of
+        // blocks and bits. This is called by UIntegerALU32.
+        static void Record(Operation operation, int32_t numBlocks, int32_t numBits)
+        {
+            Data& data = GetData();
+            data.numCalls[operation].fetch_add(1, std::memory_order_relaxed);
+            data.histogram[operation][GetBucket(numBlocks)].fetch_add(1, std::memory_order_relaxed);
+            if (numBits > data.maxNumBits.load(std::memory_order_relaxed))
+            {
+                AtomicMax(data.maxNumBits, numBits);
+            }
+
+            Site* site = CurrentSite();
+            if (site)
+            {
+                site->numCalls[operation].fetch_add(1, std::memory_order_relaxed);
+                if (numBits > site->maxNumBits.load(std::memory_order_relaxed))
+                {
+                    AtomicMax(site->maxNumBits, numBits);
+                }
+            }
+        }
+
+        // Member access to the global data.
+        static uint64_t GetNumCalls(Operation operation)
+        {
+            return GetData().numCalls[operation];
+        }
+
+        static uint64_t GetHistogram(Operation operation, int32_t bucket)
+        {
+            return GetData().histogram[operation][bucket];
+        }
+
+        static int32_t GetMaxNumBits()
+        {
+            return GetData().maxNumBits;
+        }
+
+        // Set all counters of the global data and of the call sites to zero.
+        static void Reset()
+        {
+            Data& data = GetData();
+            for (int32_t op = 0; op < NUM_OPERATIONS; ++op)
+            {
+                data.numCalls[op] = 0;
+                for (auto& count : data.histogram[op])
+                {
+                    count = 0;
+                }
+            }
+            data.maxNumBits = 0;
+
+            std::lock_guard<std::mutex> lock(Mutex());
+            for (auto& element : Sites())
+            {
+                for (auto& count : element.second->numCalls)
+                {
+                    count = 0;
+                }
+                element.second->maxNumBits = 0;
+            }
+        }
+
+        // Send the statistics to the Logger listeners as an information
+        // message.
+        static void Report()
+        {
+            static char const* operationName[NUM_OPERATIONS] =
+            {
+                "Add", "Sub", "Mul", "ShiftLeft", "ShiftRightToOdd"
+            };
+
+            std::ostringstream ostream;
+            Data& data = GetData();
+            ostream << "UInteger statistics: max bits = " << data.maxNumBits
+                << " (" << (data.maxNumBits + 31) / 32 << " blocks)\n";
+            for (int32_t op = 0; op < NUM_OPERATIONS; ++op)
+            {
+                ostream << operationName[op] << ": calls = " << data.numCalls[op]
+                    << ", blocks histogram";
+                for (int32_t b = 0; b < NUM_BUCKETS; ++b)
+                {
+                    uint64_t count = data.histogram[op][b];
+                    if (count > 0)
+                    {
+                        ostream << " [<=" << (1ull << b) << "]=" << count;
+                    }
+                }
+                ostream << "\n";
+            }
+
+            std::lock_guard<std::mutex> lock(Mutex());
+            for (auto const& element : Sites())
+            {
+                Site const& site = *element.second;
+                ostream << "site " << element.first << ": max bits = " << site.maxNumBits;
+                for (int32_t op = 0; op < NUM_OPERATIONS; ++op)
+                {
+                    ostream << ", " << operationName[op] << " = " << site.numCalls[op];
+                }
+                ostream << "\n";
+            }
+
+            LogInformation(ostream.str());
+        }
+
+    private:
+        struct Data
+        {
+            Data()
+                :
+                numCalls{},
+                histogram{},
+                maxNumBits(0)
+            {
+            }
+
+            std::array<std::atomic<uint64_t>, NUM_OPERATIONS> numCalls;
+            std::array<std::array<std::atomic<uint64_t>, NUM_BUCKETS>, NUM_OPERATIONS> histogram;
+            std::atomic<int32_t> maxNumBits;
+        };
+
+        static int32_t GetBucket(int32_t numBlocks)
+        {
+            int32_t bucket = 0;
+            while (bucket < NUM_BUCKETS - 1 && (1 << bucket) < numBlocks)
+            {
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        static Data& GetData()
+        {
+            static Data sData;
+            return sData;
+        }
+
+        static Site*& CurrentSite()
+        {
+            static thread_local Site* sSite = nullptr;
+            return sSite;
+        }
+
+        static std::mutex& Mutex()
+        {
+            static std::mutex sMutex;
+            return sMutex;
+        }
+
+        static std::map<std::string, std::unique_ptr<Site>>& Sites()
+        {
+            static std::map<std::string, std::unique_ptr<Site>> sSites;
+            return sSites;
+        }
+    };
+}
+
+#if defined(GTE_COLLECT_UINTEGER_STATISTICS)
+#define GTE_UINTEGER_STATISTICS_CONCATENATE_(a, b) a##b
+#define GTE_UINTEGER_STATISTICS_CONCATENATE(a, b) GTE_UINTEGER_STATISTICS_CONCATENATE_(a, b)
+#define GTE_UINTEGER_STATISTICS_SITE(name) \
+    static gte::UIntegerStatistics::Site& GTE_UINTEGER_STATISTICS_CONCATENATE(gteUIntegerSite, __LINE__) = \
+        gte::UIntegerStatistics::GetSite(name); \
+    gte::UIntegerStatistics::ScopedSite GTE_UINTEGER_STATISTICS_CONCATENATE(gteUIntegerScopedSite, __LINE__)( \
+        GTE_UINTEGER_STATISTICS_CONCATENATE(gteUIntegerSite, __LINE__))
+#else
+#define GTE_UINTEGER_STATISTICS_SITE(name)
+#endif
@@ -0,0 +1,1045 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/AlignedBox.h>
+#include <Mathematics/ContPointInPolygon2.h>
+#include <Mathematics/IntrSegment2Segment2.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// Uniform grids that accelerate queries on large sets of 2D objects.
+//
+// UniformGrid2 partitions the bounding rectangle of a set of aligned boxes
+// into square cells and stores for each cell the indices of the boxes that
+// overlap it, in compressed row format (an offset array into a single
+// array of indices). The queries return the boxes that overlap a query box
+// or contain a query point. A box that overlaps several cells is reported
+// once, by the cell that contains the minimum corner of its intersection
+// with the query box.
+//
+// SegmentGrid2 stores the bounding boxes of segments in a UniformGrid2. It
+// enumerates the pairs of intersecting segments of the set and finds the
+// segments of the set that intersect a query segment, using the TIQuery
+// for Segment2 and Segment2 on the candidate pairs.
+//
+// PolygonGrid2 stores for each cell and each polygon whose bounding box
+// overlaps the cell the edges of the polygon that intersect the cell and
+// whether a reference point of the cell is inside the polygon. A query
+// point P is inside the polygon when the reference point is inside and the
+// segment from the reference point to P crosses an even number of edges of
+// the cell, or the reference point is outside and the segment crosses an
+// odd number of edges. The reference point is the cell center unless an
+// edge of the cell passes too close to it. A query therefore processes only
+// the edges in the cell of the point, regardless of the number of vertices
+// of the polygons. The reference points are classified with the crossing
+// rule of PointInPolygon2::Contains, and the classification of a point
+// that is not on an edge is the same as that of PointInPolygon2::Contains.
+// A point on an edge, or within rounding error of an edge, can be
+// classified either way.
+//
+// The grid dimensions are chosen automatically when 'cellSize' is zero.
+// The batch queries distribute the inputs among threads, which are tasks of
+// the 'scheduler' parameter when it is not null, and return the same
+// results as the single queries. Their outputs of variable length
+// are stored in compressed row format, so the results of input i are
+// items[offsets[i]] through items[offsets[i + 1] - 1].
+
+namespace gte
+{
+    template <typename Real>
+    class UniformGrid2
+    {
+    public:
+        // The cells of the grid. Cell (x,y) has minimum corner
+        // origin + cellSize * (x,y) and index x + numX * y. Points outside
+        // the grid are clamped to the boundary cells.
+        class Geometry
+        {
+        public:
+            Geometry()
+                :
+                origin(Vector2<Real>::Zero()),
+                cellSize((Real)1),
+                invCellSize((Real)1),
+                numX(1),
+                numY(1)
+            {
+            }
+
+            // The cell size is increased when necessary so that the number
+            // of cells is at most 'maxNumCells'.
+            Geometry(AlignedBox2<Real> const& bounds, Real inCellSize, int maxNumCells)
+                :
+                origin(bounds.min),
+                cellSize(inCellSize),
+                invCellSize((Real)1),
+                numX(1),
+                numY(1)
+            {
+                Real const width = bounds.max[0] - bounds.min[0];
+                Real const height = bounds.max[1] - bounds.min[1];
+                if (!(cellSize > (Real)0))
+                {
+                    cellSize = std::max(std::max(width, height), (Real)1);
+                }
+
+                maxNumCells = std::max(maxNumCells, 1);
+                for (;;)
+                {
+                    Real const cellsX = std::floor(width / cellSize) + (Real)1;
+                    Real const cellsY = std::floor(height / cellSize) + (Real)1;
+                    if (cellsX * cellsY <= static_cast<Real>(maxNumCells))
+                    {
+                        numX = static_cast<int>(cellsX);
+                        numY = static_cast<int>(cellsY);
+                        break;
+                    }
+                    cellSize *= (Real)2;
+                }
+                invCellSize = (Real)1 / cellSize;
+            }
+
+            inline int GetX(Real x) const
+            {
+                return Clamp((x - origin[0]) * invCellSize, numX);
+            }
+
+            inline int GetY(Real y) const
+            {
+                return Clamp((y - origin[1]) * invCellSize, numY);
+            }
+
+            inline int GetNumCells() const
+            {
+                return numX * numY;
+            }
+
+            AlignedBox2<Real> GetCellBox(int x, int y) const
+            {
+                AlignedBox2<Real> box;
+                box.min[0] = origin[0] + cellSize * static_cast<Real>(x);
+                box.min[1] = origin[1] + cellSize * static_cast<Real>(y);
+                box.max[0] = origin[0] + cellSize * static_cast<Real>(x + 1);
+                box.max[1] = origin[1] + cellSize * static_cast<Real>(y + 1);
+                return box;
+            }
+
+            // The point origin + cellSize * (x + u, y + v) for the cell
+            // (x,y). The center of the cell has u = v = 1/2.
+            Vector2<Real> GetCellPoint(int x, int y, Real u, Real v) const
+            {
+                Vector2<Real> point;
+                point[0] = origin[0] + cellSize * (static_cast<Real>(x) + u);
+                point[1] = origin[1] + cellSize * (static_cast<Real>(y) + v);
+                return point;
+            }
+
+            Vector2<Real> origin;
+            Real cellSize, invCellSize;
+            int numX, numY;
+
+        private:
+            static inline int Clamp(Real t, int numCells)
+            {
+                if (t <= (Real)0)
+                {
+                    return 0;
+                }
+                if (t >= static_cast<Real>(numCells - 1))
+                {
+                    return numCells - 1;
+                }
+                return static_cast<int>(t);
+            }
+        };
+
+        // The class object stores a copy of 'boxes'. A 'cellSize' of zero
+        // selects the larger of the mean box extent and the cell size for
+        // which the number of cells equals the number of boxes. The number
+        // of cells is at most 4 times the number of boxes.
+        UniformGrid2(std::vector<AlignedBox2<Real>> const& boxes, Real cellSize = (Real)0)
+            :
+            mBoxes(boxes)
+        {
+            AlignedBox2<Real> bounds;
+            bounds.min = Vector2<Real>::Zero();
+            bounds.max = Vector2<Real>::Zero();
+            Real meanExtent = (Real)0;
+            for (size_t i = 0; i < mBoxes.size(); ++i)
+            {
+                AlignedBox2<Real> const& box = mBoxes[i];
+                LogAssert(box.min[0] <= box.max[0] && box.min[1] <= box.max[1], "Invalid box.");
+                for (int j = 0; j < 2; ++j)
+                {
+                    bounds.min[j] = (i > 0 ? std::min(bounds.min[j], box.min[j]) : box.min[j]);
+                    bounds.max[j] = (i > 0 ? std::max(bounds.max[j], box.max[j]) : box.max[j]);
+                }
+                meanExtent += std::max(box.max[0] - box.min[0], box.max[1] - box.min[1]);
+            }
+
+            int const numBoxes = static_cast<int>(mBoxes.size());
+            if (cellSize == (Real)0 && numBoxes > 0)
+            {
+                meanExtent /= static_cast<Real>(numBoxes);
+                cellSize = std::max(GetDensityCellSize(bounds, numBoxes), meanExtent);
+            }
+            mGeometry = Geometry(bounds, cellSize, 4 * numBoxes);
+
+            // Count the boxes per cell, then fill the cells in the order of
+            // the boxes so that the indices of a cell are increasing.
+            mOffsets.assign(static_cast<size_t>(mGeometry.GetNumCells()) + 1, 0);
+            for (auto const& box : mBoxes)
+            {
+                ForEachCell(box, [this](int cell) { ++mOffsets[static_cast<size_t>(cell) + 1]; });
+            }
+            for (size_t i = 1; i < mOffsets.size(); ++i)
+            {
+                mOffsets[i] += mOffsets[i - 1];
+            }
+            mItems.resize(static_cast<size_t>(mOffsets.back()));
+            std::vector<int> next(mOffsets.begin(), mOffsets.end() - 1);
+            for (int i = 0; i < numBoxes; ++i)
+            {
+                ForEachCell(mBoxes[i], [this, &next, i](int cell) { mItems[next[cell]++] = i; });
+            }
+        }
+
+        // Member access.
+        inline std::vector<AlignedBox2<Real>> const& GetBoxes() const
+        {
+            return mBoxes;
+        }
+
+        inline Geometry const& GetGeometry() const
+        {
+            return mGeometry;
+        }
+
+        // The boxes overlapping cell c are mItems[offsets[c]] through
+        // mItems[offsets[c + 1] - 1], in increasing order.
+        inline std::vector<int> const& GetOffsets() const
+        {
+            return mOffsets;
+        }
+
+        inline std::vector<int> const& GetItems() const
+        {
+            return mItems;
+        }
+
+        // The boxes that overlap the query box, where boxes that touch are
+        // overlapping, in increasing order.
+        void FindBoxes(AlignedBox2<Real> const& query, std::vector<int>& items) const
+        {
+            items.clear();
+            AppendBoxes(query, items);
+        }
+
+        // The boxes that contain the query point, in increasing order.
+        void FindBoxes(Vector2<Real> const& point, std::vector<int>& items) const
+        {
+            items.clear();
+            AppendBoxes(point, items);
+        }
+
+        // Batch versions of the queries.
+        void FindBoxes(std::vector<AlignedBox2<Real>> const& queries,
+            std::vector<int>& offsets, std::vector<int>& items, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            FindAll(queries, offsets, items, numThreads, scheduler);
+        }
+
+        void FindBoxes(std::vector<Vector2<Real>> const& points,
+            std::vector<int>& offsets, std::vector<int>& items, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            FindAll(points, offsets, items, numThreads, scheduler);
+        }
+
+        // The cell size for which the number of cells is the number of
+        // items distributed uniformly over the bounding rectangle.
+        static Real GetDensityCellSize(AlignedBox2<Real> const& bounds, int numItems)
+        {
+            Real const width = bounds.max[0] - bounds.min[0];
+            Real const height = bounds.max[1] - bounds.min[1];
+            Real const n = static_cast<Real>(std::max(numItems, 1));
+            Real cellSize = std::sqrt(width * height / n);
+            if (!(cellSize > (Real)0))
+            {
+                cellSize = std::max(width, height) / n;
+            }
+            return cellSize;
+        }
+
+        // Execute function(begin, end) on blocks of [0,numItems) that
+        // threads fetch from an atomic counter. The blocks are
+        // contiguous ranges of 'blockSize' items, or one range per thread
+        // when 'blockSize' is zero. The threads are tasks of the scheduler
+        // when it is not null.
+        template <typename Function>
+        static void Execute(size_t numThreads, TaskScheduler* scheduler, size_t numItems,
+            Function const& function, size_t blockSize = 0)
+        {
+            if (blockSize == 0)
+            {
+                blockSize = std::max(numItems / std::max(numThreads, static_cast<size_t>(1)),
+                    static_cast<size_t>(1));
+            }
+            size_t const numBlocks = (numItems + blockSize - 1) / blockSize;
+            numThreads = std::min(numThreads, numBlocks);
+            if (numThreads <= 1)
+            {
+                function(0, numItems);
+                return;
+            }
+
+            TaskScheduler::ParallelForDynamic(scheduler, numBlocks, numThreads,
+                [&function, numItems, blockSize](size_t block)
+                {
+                    size_t begin = block * blockSize;
+                    function(begin, std::min(begin + blockSize, numItems));
+                });
+        }
+
+        // Execute query(i, items) for each input i, appending the results
+        // of input i to 'items', and store the results in compressed row
+        // format. Each thread processes blocks of inputs into its own
+        // arrays, which are then concatenated in input order.
+        template <typename Query>
+        static void ExecuteBatch(size_t numInputs, Query const& query,
+            std::vector<int>& offsets, std::vector<int>& items, size_t numThreads,
+            TaskScheduler* scheduler)
+        {
+            enum { msBlockSize = 256 };
+            size_t const numBlocks = (numInputs + msBlockSize - 1) / msBlockSize;
+            std::vector<std::vector<int>> blockItems(numBlocks);
+            offsets.resize(numInputs + 1);
+            offsets[0] = 0;
+            Execute(numThreads, scheduler, numBlocks, [&](size_t begin, size_t end)
+            {
+                for (size_t block = begin; block < end; ++block)
+                {
+                    size_t const i0 = block * msBlockSize;
+                    size_t const i1 = std::min(i0 + msBlockSize, numInputs);
+                    std::vector<int>& local = blockItems[block];
+                    for (size_t i = i0; i < i1; ++i)
+                    {
+                        query(i, local);
+                        offsets[i + 1] = static_cast<int>(local.size());
+                    }
+                }
+            }, 1);
+
+            items.clear();
+            for (size_t block = 0; block < numBlocks; ++block)
+            {
+                int const base = static_cast<int>(items.size());
+                size_t const i0 = block * msBlockSize;
+                size_t const i1 = std::min(i0 + msBlockSize, numInputs);
+                for (size_t i = i0; i < i1; ++i)
+                {
+                    offsets[i + 1] += base;
+                }
+                items.insert(items.end(), blockItems[block].begin(), blockItems[block].end());
+                std::vector<int>().swap(blockItems[block]);
+            }
+        }
+
+    private:
+        template <typename Function>
+        void ForEachCell(AlignedBox2<Real> const& box, Function const& function) const
+        {
+            int const x0 = mGeometry.GetX(box.min[0]), x1 = mGeometry.GetX(box.max[0]);
+            int const y0 = mGeometry.GetY(box.min[1]), y1 = mGeometry.GetY(box.max[1]);
+            for (int y = y0; y <= y1; ++y)
+            {
+                for (int x = x0, cell = x0 + mGeometry.numX * y; x <= x1; ++x, ++cell)
+                {
+                    function(cell);
+                }
+            }
+        }
+
+        static inline bool Overlap(AlignedBox2<Real> const& box0, AlignedBox2<Real> const& box1)
+        {
+            return box0.min[0] <= box1.max[0] && box1.min[0] <= box0.max[0]
+                && box0.min[1] <= box1.max[1] && box1.min[1] <= box0.max[1];
+        }
+
+        void AppendBoxes(AlignedBox2<Real> const& query, std::vector<int>& items) const
+        {
+            if (mBoxes.size() == 0)
+            {
+                return;
+            }
+
+            size_t const first = items.size();
+            int const x0 = mGeometry.GetX(query.min[0]), x1 = mGeometry.GetX(query.max[0]);
+            int const y0 = mGeometry.GetY(query.min[1]), y1 = mGeometry.GetY(query.max[1]);
+            for (int y = y0; y <= y1; ++y)
+            {
+                for (int x = x0, cell = x0 + mGeometry.numX * y; x <= x1; ++x, ++cell)
+                {
+                    for (int k = mOffsets[cell]; k < mOffsets[cell + 1]; ++k)
+                    {
+                        int const i = mItems[k];
+                        AlignedBox2<Real> const& box = mBoxes[i];
+                        if (Overlap(box, query)
+                            && mGeometry.GetX(std::max(box.min[0], query.min[0])) == x
+                            && mGeometry.GetY(std::max(box.min[1], query.min[1])) == y)
+                        {
+                            items.push_back(i);
+                        }
+                    }
+                }
+            }
+            std::sort(items.begin() + first, items.end());
+        }
+
+        void AppendBoxes(Vector2<Real> const& point, std::vector<int>& items) const
+        {
+            if (mBoxes.size() == 0)
+            {
+                return;
+            }
+
+            int const cell = mGeometry.GetX(point[0]) + mGeometry.numX * mGeometry.GetY(point[1]);
+            for (int k = mOffsets[cell]; k < mOffsets[cell + 1]; ++k)
+            {
+                int const i = mItems[k];
+                AlignedBox2<Real> const& box = mBoxes[i];
+                if (box.min[0] <= point[0] && point[0] <= box.max[0]
+                    && box.min[1] <= point[1] && point[1] <= box.max[1])
+                {
+                    items.push_back(i);
+                }
+            }
+        }
+
+        template <typename Input>
+        void FindAll(std::vector<Input> const& inputs, std::vector<int>& offsets,
+            std::vector<int>& items, size_t numThreads, TaskScheduler* scheduler) const
+        {
+            ExecuteBatch(inputs.size(), [this, &inputs](size_t i, std::vector<int>& local)
+            {
+                AppendBoxes(inputs[i], local);
+            }, offsets, items, numThreads, scheduler);
+        }
+
+        std::vector<AlignedBox2<Real>> mBoxes;
+        Geometry mGeometry;
+        std::vector<int> mOffsets;
+        std::vector<int> mItems;
+    };
+
+    template <typename Real>
+    class SegmentGrid2
+    {
+    public:
+        // The class object stores a copy of 'segments'. See UniformGrid2
+        // for the meaning of 'cellSize'.
+        SegmentGrid2(std::vector<Segment2<Real>> const& segments, Real cellSize = (Real)0)
+            :
+            mSegments(segments),
+            mGrid(GetBoxes(segments), cellSize)
+        {
+        }
+
+        // Member access.
+        inline std::vector<Segment2<Real>> const& GetSegments() const
+        {
+            return mSegments;
+        }
+
+        inline UniformGrid2<Real> const& GetGrid() const
+        {
+            return mGrid;
+        }
+
+        // The pairs (i,j) with i < j of intersecting segments, in
+        // lexicographical order. The cells are processed concurrently.
+        void FindIntersections(std::vector<std::array<int, 2>>& pairs, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            enum { msBlockSize = 64 };
+            auto const& geometry = mGrid.GetGeometry();
+            auto const& offsets = mGrid.GetOffsets();
+            auto const& cellItems = mGrid.GetItems();
+            auto const& boxes = mGrid.GetBoxes();
+            size_t const numCells = static_cast<size_t>(geometry.GetNumCells());
+            size_t const numBlocks = (numCells + msBlockSize - 1) / msBlockSize;
+            std::vector<std::vector<std::array<int, 2>>> blockPairs(numBlocks);
+
+            UniformGrid2<Real>::Execute(numThreads, scheduler, numBlocks, [&](size_t begin, size_t end)
+            {
+                TIQuery<Real, Segment2<Real>, Segment2<Real>> query;
+                for (size_t block = begin; block < end; ++block)
+                {
+                    size_t const c1 = std::min((block + 1) * msBlockSize, numCells);
+                    for (size_t c = block * msBlockSize; c < c1; ++c)
+                    {
+                        int const cell = static_cast<int>(c);
+                        int const x = cell % geometry.numX, y = cell / geometry.numX;
+                        for (int k0 = offsets[cell]; k0 < offsets[cell + 1]; ++k0)
+                        {
+                            int const i = cellItems[k0];
+                            AlignedBox2<Real> const& box0 = boxes[i];
+                            for (int k1 = k0 + 1; k1 < offsets[cell + 1]; ++k1)
+                            {
+                                // Each pair is tested by the cell that
+                                // contains the minimum corner of the
+                                // intersection of the bounding boxes.
+                                int const j = cellItems[k1];
+                                AlignedBox2<Real> const& box1 = boxes[j];
+                                if (box0.min[0] <= box1.max[0] && box1.min[0] <= box0.max[0]
+                                    && box0.min[1] <= box1.max[1] && box1.min[1] <= box0.max[1]
+                                    && geometry.GetX(std::max(box0.min[0], box1.min[0])) == x
+                                    && geometry.GetY(std::max(box0.min[1], box1.min[1])) == y
+                                    && query(mSegments[i], mSegments[j]).intersect)
+                                {
+                                    blockPairs[block].push_back({ i, j });
+                                }
+                            }
+                        }
+                    }
+                }
+            }, 1);
+
+            pairs.clear();
+            for (auto& local : blockPairs)
+            {
+                pairs.insert(pairs.end(), local.begin(), local.end());
+            }
+            std::sort(pairs.begin(), pairs.end());
+        }
+
+        // The segments that intersect the query segment, in increasing
+        // order.
+        void FindSegments(Segment2<Real> const& segment, std::vector<int>& items) const
+        {
+            items.clear();
+            AppendSegments(segment, items);
+        }
+
+        // Batch version of the query.
+        void FindSegments(std::vector<Segment2<Real>> const& segments,
+            std::vector<int>& offsets, std::vector<int>& items, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            UniformGrid2<Real>::ExecuteBatch(segments.size(),
+                [this, &segments](size_t i, std::vector<int>& local)
+                {
+                    AppendSegments(segments[i], local);
+                }, offsets, items, numThreads, scheduler);
+        }
+
+    private:
+        static AlignedBox2<Real> GetBox(Segment2<Real> const& segment)
+        {
+            AlignedBox2<Real> box;
+            for (int j = 0; j < 2; ++j)
+            {
+                box.min[j] = std::min(segment.p[0][j], segment.p[1][j]);
+                box.max[j] = std::max(segment.p[0][j], segment.p[1][j]);
+            }
+            return box;
+        }
+
+        static std::vector<AlignedBox2<Real>> GetBoxes(std::vector<Segment2<Real>> const& segments)
+        {
+            std::vector<AlignedBox2<Real>> boxes(segments.size());
+            for (size_t i = 0; i < segments.size(); ++i)
+            {
+                boxes[i] = GetBox(segments[i]);
+            }
+            return boxes;
+        }
+
+        void AppendSegments(Segment2<Real> const& segment, std::vector<int>& items) const
+        {
+            std::vector<int> candidates;
+            mGrid.FindBoxes(GetBox(segment), candidates);
+            TIQuery<Real, Segment2<Real>, Segment2<Real>> query;
+            for (auto i : candidates)
+            {
+                if (query(segment, mSegments[i]).intersect)
+                {
+                    items.push_back(i);
+                }
+            }
+        }
+
+        std::vector<Segment2<Real>> mSegments;
+        UniformGrid2<Real> mGrid;
+    };
+
+    template <typename Real>
+    class PolygonGrid2
+    {
+    public:
+        // Each polygon is an ordered list of at least 3 vertices, as for
+        // PointInPolygon2. The polygons may overlap. The class object stores
+        // a copy of 'polygons'. A 'cellSize' of zero selects the cell size
+        // for which the number of cells equals the total number of edges.
+        // The polygons are processed concurrently, and the grid is the same
+        // for any number of threads.
+        PolygonGrid2(std::vector<std::vector<Vector2<Real>>> const& polygons,
+            Real cellSize = (Real)0, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+            :
+            mPolygons(polygons)
+        {
+            int numEdges = 0;
+            for (size_t p = 0; p < mPolygons.size(); ++p)
+            {
+                LogAssert(mPolygons[p].size() >= 3, "Invalid polygon.");
+                for (size_t i = 0; i < mPolygons[p].size(); ++i)
+                {
+                    Vector2<Real> const& v = mPolygons[p][i];
+                    for (int j = 0; j < 2; ++j)
+                    {
+                        mBounds.min[j] = (numEdges > 0 ? std::min(mBounds.min[j], v[j]) : v[j]);
+                        mBounds.max[j] = (numEdges > 0 ? std::max(mBounds.max[j], v[j]) : v[j]);
+                    }
+                    ++numEdges;
+                }
+            }
+            if (numEdges == 0)
+            {
+                mBounds.min = Vector2<Real>::Zero();
+                mBounds.max = Vector2<Real>::Zero();
+            }
+
+            if (cellSize == (Real)0)
+            {
+                cellSize = UniformGrid2<Real>::GetDensityCellSize(mBounds, numEdges);
+            }
+            mGeometry = typename UniformGrid2<Real>::Geometry(mBounds, cellSize, 4 * numEdges);
+
+            // Build the cells of each polygon.
+            size_t const numPolygons = mPolygons.size();
+            std::vector<std::vector<std::pair<int, Entry>>> polygonEntries(numPolygons);
+            std::vector<std::vector<Edge>> polygonEdges(numPolygons);
+            UniformGrid2<Real>::Execute(numThreads, scheduler, numPolygons, [&](size_t begin, size_t end)
+            {
+                for (size_t p = begin; p < end; ++p)
+                {
+                    BuildPolygon(static_cast<int>(p), polygonEntries[p], polygonEdges[p]);
+                }
+            }, 1);
+
+            // Sort the entries by cell, keeping the polygons of a cell in
+            // increasing order, and store the edges of a cell contiguously.
+            size_t const numCells = static_cast<size_t>(mGeometry.GetNumCells());
+            mOffsets.assign(numCells + 1, 0);
+            for (auto const& entries : polygonEntries)
+            {
+                for (auto const& entry : entries)
+                {
+                    ++mOffsets[static_cast<size_t>(entry.first) + 1];
+                }
+            }
+            for (size_t c = 1; c <= numCells; ++c)
+            {
+                mOffsets[c] += mOffsets[c - 1];
+            }
+
+            std::vector<int> next(mOffsets.begin(), mOffsets.end() - 1);
+            std::vector<std::pair<size_t, int>> sources(static_cast<size_t>(mOffsets.back()));
+            mEntries.resize(sources.size());
+            for (size_t p = 0; p < numPolygons; ++p)
+            {
+                for (size_t k = 0; k < polygonEntries[p].size(); ++k)
+                {
+                    int const slot = next[polygonEntries[p][k].first]++;
+                    mEntries[slot] = polygonEntries[p][k].second;
+                    sources[slot] = std::make_pair(p, static_cast<int>(k));
+                }
+            }
+            for (size_t k = 0; k < mEntries.size(); ++k)
+            {
+                Entry& entry = mEntries[k];
+                auto const& edges = polygonEdges[sources[k].first];
+                int const edgeBegin = static_cast<int>(mEdges.size());
+                mEdges.insert(mEdges.end(), edges.begin() + entry.edgeBegin, edges.begin() + entry.edgeEnd);
+                entry.edgeBegin = edgeBegin;
+                entry.edgeEnd = static_cast<int>(mEdges.size());
+            }
+        }
+
+        // Member access.
+        inline std::vector<std::vector<Vector2<Real>>> const& GetPolygons() const
+        {
+            return mPolygons;
+        }
+
+        inline typename UniformGrid2<Real>::Geometry const& GetGeometry() const
+        {
+            return mGeometry;
+        }
+
+        // The smallest index of a polygon that contains the point, or -1
+        // when no polygon contains the point.
+        int FindPolygon(Vector2<Real> const& point) const
+        {
+            int const cell = GetCell(point);
+            if (cell >= 0)
+            {
+                for (int k = mOffsets[cell]; k < mOffsets[cell + 1]; ++k)
+                {
+                    if (Contains(mEntries[k], point))
+                    {
+                        return mEntries[k].polygon;
+                    }
+                }
+            }
+            return -1;
+        }
+
+        // The polygons that contain the point, in increasing order.
+        void FindPolygons(Vector2<Real> const& point, std::vector<int>& polygons) const
+        {
+            polygons.clear();
+            AppendPolygons(point, polygons);
+        }
+
+        // Batch versions of the queries.
+        void FindPolygon(std::vector<Vector2<Real>> const& points,
+            std::vector<int>& polygons, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            polygons.resize(points.size());
+            UniformGrid2<Real>::Execute(numThreads, scheduler, points.size(), [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    polygons[i] = FindPolygon(points[i]);
+                }
+            }, 1024);
+        }
+
+        void FindPolygons(std::vector<Vector2<Real>> const& points,
+            std::vector<int>& offsets, std::vector<int>& polygons, size_t numThreads,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            UniformGrid2<Real>::ExecuteBatch(points.size(),
+                [this, &points](size_t i, std::vector<int>& local)
+                {
+                    AppendPolygons(points[i], local);
+                }, offsets, polygons, numThreads, scheduler);
+        }
+
+    private:
+        // The edge from vertex i to vertex i-1 of a polygon, which is the
+        // order in which PointInPolygon2::Contains visits the edges.
+        struct Edge
+        {
+            Vector2<Real> U0, U1;
+        };
+
+        // The part of a polygon in a cell. The reference point R is inside
+        // the polygon when 'inside' is 1. The entry has no edges when the
+        // cell is inside the polygon.
+        struct Entry
+        {
+            Vector2<Real> R;
+            int polygon, inside;
+            int edgeBegin, edgeEnd;
+        };
+
+        inline int GetCell(Vector2<Real> const& point) const
+        {
+            if (point[0] < mBounds.min[0] || point[0] > mBounds.max[0]
+                || point[1] < mBounds.min[1] || point[1] > mBounds.max[1]
+                || mEntries.size() == 0)
+            {
+                return -1;
+            }
+            return mGeometry.GetX(point[0]) + mGeometry.numX * mGeometry.GetY(point[1]);
+        }
+
+        void AppendPolygons(Vector2<Real> const& point, std::vector<int>& polygons) const
+        {
+            int const cell = GetCell(point);
+            if (cell >= 0)
+            {
+                for (int k = mOffsets[cell]; k < mOffsets[cell + 1]; ++k)
+                {
+                    if (Contains(mEntries[k], point))
+                    {
+                        polygons.push_back(mEntries[k].polygon);
+                    }
+                }
+            }
+        }
+
+        bool Contains(Entry const& entry, Vector2<Real> const& P) const
+        {
+            bool inside = (entry.inside != 0);
+            for (int k = entry.edgeBegin; k < entry.edgeEnd; ++k)
+            {
+                if (Crosses(entry.R, P, mEdges[k].U0, mEdges[k].U1))
+                {
+                    inside = !inside;
+                }
+            }
+            return inside;
+        }
+
+        static inline Real Orient(Vector2<Real> const& A, Vector2<Real> const& B, Vector2<Real> const& C)
+        {
+            return (B[0] - A[0]) * (C[1] - A[1]) - (B[1] - A[1]) * (C[0] - A[0]);
+        }
+
+        // Test whether segment <R,P> crosses edge <A,B>. A vertex on the
+        // line of <R,P> is on the negative side of the line, and it is
+        // processed the same for both of its edges. A reference point on
+        // the line of <A,B> is moved by (dx,dy) with 0 < dy << dx << 1,
+        // which is the perturbation of the point implied by the crossing
+        // rule of PointInPolygon2::Contains.
+        static inline bool Crosses(Vector2<Real> const& R, Vector2<Real> const& P,
+            Vector2<Real> const& A, Vector2<Real> const& B)
+        {
+            if ((Orient(R, P, A) > (Real)0) == (Orient(R, P, B) > (Real)0))
+            {
+                return false;
+            }
+            Real orientR = Orient(A, B, R);
+            if (orientR == (Real)0)
+            {
+                orientR = (B[1] != A[1] ? A[1] - B[1] : B[0] - A[0]);
+            }
+            return (orientR > (Real)0) != (Orient(A, B, P) > (Real)0);
+        }
+
+        // The edge test of PointInPolygon2::Contains, which is true when the
+        // edge crosses the ray from P in the +x direction.
+        static inline bool CrossesRay(Vector2<Real> const& U0, Vector2<Real> const& U1,
+            Vector2<Real> const& P)
+        {
+            if (P[1] < U1[1])
+            {
+                if (U0[1] <= P[1])
+                {
+                    return (P[1] - U0[1]) * (U1[0] - U0[0]) > (P[0] - U0[0]) * (U1[1] - U0[1]);
+                }
+            }
+            else if (P[1] < U0[1])
+            {
+                return (P[1] - U0[1]) * (U1[0] - U0[0]) < (P[0] - U0[0]) * (U1[1] - U0[1]);
+            }
+            return false;
+        }
+
+        // Test whether the segment intersects the cell box expanded by a
+        // small amount, using slabs in the parameter of the segment.
+        static bool Intersects(Vector2<Real> const& U0, Vector2<Real> const& U1,
+            AlignedBox2<Real> const& box, Real epsilon)
+        {
+            Real t0 = (Real)0, t1 = (Real)1;
+            for (int j = 0; j < 2; ++j)
+            {
+                Real const bmin = box.min[j] - epsilon, bmax = box.max[j] + epsilon;
+                Real const d = U1[j] - U0[j];
+                if (d == (Real)0)
+                {
+                    if (U0[j] < bmin || U0[j] > bmax)
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    Real s0 = (bmin - U0[j]) / d, s1 = (bmax - U0[j]) / d;
+                    if (s0 > s1)
+                    {
+                        std::swap(s0, s1);
+                    }
+                    t0 = std::max(t0, s0);
+                    t1 = std::min(t1, s1);
+                    if (t0 > t1)
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Select the reference point of a cell, preferring the center, that
+        // is not within rounding error of the lines of the edges of the
+        // cell. Return true when the center is selected.
+        bool SelectReferencePoint(int x, int y, Edge const* edges,
+            size_t numEdges, Vector2<Real>& R) const
+        {
+            static std::array<std::array<Real, 2>, 9> const candidates =
+            { {
+                { (Real)0.5, (Real)0.5 }, { (Real)0.25, (Real)0.25 }, { (Real)0.75, (Real)0.25 },
+                { (Real)0.25, (Real)0.75 }, { (Real)0.75, (Real)0.75 }, { (Real)0.375, (Real)0.625 },
+                { (Real)0.625, (Real)0.375 }, { (Real)0.125, (Real)0.875 }, { (Real)0.875, (Real)0.125 }
+            } };
+
+            Real const relative = static_cast<Real>(1024) * std::numeric_limits<Real>::epsilon();
+            Real const absolute = static_cast<Real>(1e-6) * mGeometry.cellSize;
+            for (auto const& candidate : candidates)
+            {
+                R = mGeometry.GetCellPoint(x, y, candidate[0], candidate[1]);
+                bool valid = true;
+                for (size_t k = 0; k < numEdges && valid; ++k)
+                {
+                    Vector2<Real> const& A = edges[k].U0;
+                    Vector2<Real> const& B = edges[k].U1;
+                    Real const tolerance = std::max(absolute, relative * (
+                        std::fabs(R[0]) + std::fabs(R[1]) + std::fabs(A[0]) + std::fabs(A[1])
+                        + std::fabs(B[0]) + std::fabs(B[1])));
+                    Real const orient = Orient(A, B, R);
+                    Real const sqrLength = (B[0] - A[0]) * (B[0] - A[0]) + (B[1] - A[1]) * (B[1] - A[1]);
+                    valid = (orient * orient > tolerance * tolerance * sqrLength);
+                }
+                if (valid)
+                {
+                    return &candidate == &candidates[0];
+                }
+            }
+
+            R = mGeometry.GetCellPoint(x, y, (Real)0.5, (Real)0.5);
+            return true;
+        }
+
+        void BuildPolygon(int p, std::vector<std::pair<int, Entry>>& entries,
+            std::vector<Edge>& edges) const
+        {
+            std::vector<Vector2<Real>> const& polygon = mPolygons[p];
+            int const numVertices = static_cast<int>(polygon.size());
+            Real const epsilon = static_cast<Real>(1e-6) * mGeometry.cellSize;
+
+            AlignedBox2<Real> box;
+            box.min = polygon[0];
+            box.max = polygon[0];
+            for (auto const& v : polygon)
+            {
+                for (int j = 0; j < 2; ++j)
+                {
+                    box.min[j] = std::min(box.min[j], v[j]);
+                    box.max[j] = std::max(box.max[j], v[j]);
+                }
+            }
+            int const x0 = mGeometry.GetX(box.min[0]), x1 = mGeometry.GetX(box.max[0]);
+            int const y0 = mGeometry.GetY(box.min[1]), y1 = mGeometry.GetY(box.max[1]);
+
+            // The (cell, edge) pairs of the edges that intersect the cells,
+            // and the edges that cross the horizontal line through the
+            // centers of each row of cells.
+            std::vector<std::pair<int, int>> cellEdges;
+            std::vector<std::vector<std::pair<Real, int>>> rowCrossings(static_cast<size_t>(y1 - y0) + 1);
+            for (int i = 0, j = numVertices - 1; i < numVertices; j = i++)
+            {
+                Vector2<Real> const& U0 = polygon[i];
+                Vector2<Real> const& U1 = polygon[j];
+                int const ex0 = mGeometry.GetX(std::min(U0[0], U1[0]));
+                int const ex1 = mGeometry.GetX(std::max(U0[0], U1[0]));
+                int const ey0 = mGeometry.GetY(std::min(U0[1], U1[1]));
+                int const ey1 = mGeometry.GetY(std::max(U0[1], U1[1]));
+                for (int y = ey0; y <= ey1; ++y)
+                {
+                    for (int x = ex0; x <= ex1; ++x)
+                    {
+                        if (Intersects(U0, U1, mGeometry.GetCellBox(x, y), epsilon))
+                        {
+                            cellEdges.push_back(std::make_pair(x + mGeometry.numX * y, i));
+                        }
+                    }
+
+                    Real const cy = mGeometry.GetCellPoint(0, y, (Real)0.5, (Real)0.5)[1];
+                    if ((U0[1] <= cy && cy < U1[1]) || (U1[1] <= cy && cy < U0[1]))
+                    {
+                        Real const xCross = U0[0] + (cy - U0[1]) * (U1[0] - U0[0]) / (U1[1] - U0[1]);
+                        rowCrossings[static_cast<size_t>(y - y0)].push_back(std::make_pair(xCross, i));
+                    }
+                }
+            }
+            std::sort(cellEdges.begin(), cellEdges.end());
+
+            // Classify the reference points row by row. The center of a cell
+            // is inside when it is left of an odd number of crossings. The
+            // crossings within rounding error of the center are tested with
+            // the rule of PointInPolygon2::Contains.
+            PointInPolygon2<Real> pip(numVertices, polygon.data());
+            Real const relative = static_cast<Real>(1024) * std::numeric_limits<Real>::epsilon();
+            size_t next = 0;
+            for (int y = y0; y <= y1; ++y)
+            {
+                auto& crossings = rowCrossings[static_cast<size_t>(y - y0)];
+                std::sort(crossings.begin(), crossings.end());
+                for (int x = x0; x <= x1; ++x)
+                {
+                    int const cell = x + mGeometry.numX * y;
+                    Vector2<Real> const center = mGeometry.GetCellPoint(x, y, (Real)0.5, (Real)0.5);
+
+                    Real const tolerance = std::max(epsilon, relative * std::fabs(center[0])
+                        + (crossings.size() > 0 ? relative * std::max(
+                            std::fabs(crossings.front().first), std::fabs(crossings.back().first)) : (Real)0));
+                    auto lower = std::lower_bound(crossings.begin(), crossings.end(),
+                        std::make_pair(center[0] - tolerance, std::numeric_limits<int>::min()));
+                    auto upper = std::upper_bound(lower, crossings.end(),
+                        std::make_pair(center[0] + tolerance, std::numeric_limits<int>::max()));
+                    bool inside = (((crossings.end() - upper) & 1) != 0);
+                    for (auto iter = lower; iter != upper; ++iter)
+                    {
+                        int const i = iter->second;
+                        if (CrossesRay(polygon[i], polygon[i > 0 ? i - 1 : numVertices - 1], center))
+                        {
+                            inside = !inside;
+                        }
+                    }
+
+                    size_t const first = edges.size();
+                    for (; next < cellEdges.size() && cellEdges[next].first == cell; ++next)
+                    {
+                        int const i = cellEdges[next].second;
+                        edges.push_back({ polygon[i], polygon[i > 0 ? i - 1 : numVertices - 1] });
+                    }
+
+                    Entry entry;
+                    entry.R = center;
+                    entry.polygon = p;
+                    entry.edgeBegin = static_cast<int>(first);
+                    entry.edgeEnd = static_cast<int>(edges.size());
+                    if (entry.edgeEnd > entry.edgeBegin)
+                    {
+                        if (!SelectReferencePoint(x, y, edges.data() + first,
+                            edges.size() - first, entry.R))
+                        {
+                            inside = pip.Contains(entry.R);
+                        }
+                    }
+                    else if (!inside)
+                    {
+                        continue;
+                    }
+                    entry.inside = (inside ? 1 : 0);
+                    entries.push_back(std::make_pair(cell, entry));
+                }
+            }
+        }
+
+        std::vector<std::vector<Vector2<Real>>> mPolygons;
+        AlignedBox2<Real> mBounds;
+        typename UniformGrid2<Real>::Geometry mGeometry;
+        std::vector<int> mOffsets;
+        std::vector<Entry> mEntries;
+        std::vector<Edge> mEdges;
+    };
+}
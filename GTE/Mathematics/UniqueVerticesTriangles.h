@@ -3,19 +3,25 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.11.16
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
 #include <algorithm>
-#include <map>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
 #include <vector>
 
 // UniqueVerticesTriangles is a helper class that provides support for several
 // mesh generation and mesh reduction operations. The vertices have type
 // VertexType, which must have a less-than comparison predicate because
-// duplicate vertices are eliminated in the operations.
+// duplicate vertices are eliminated in the operations. The duplicates are
+// found by sorting the vertices, and the sorting is partitioned among the
+// number of threads passed to the constructor.
 //
 //   1. Generate an indexed triangle representation from an array of
 //      triples of VertexType. Each triple represents the vertices of
@@ -36,6 +42,10 @@
 //
 //   4. Remove duplicate and unused vertices from a vertex pool, a combination
 //      of the operations in #2 and #3.
+//
+//   5. Weld the vertices of #1 or #2 that are in the same cell of a grid
+//      with a specified cell size. VertexType must provide its coordinates
+//      through operator[].
 
 // Uncomment this preprocessor symbol to validate the preconditions of the
 // inputs of the class member functions.
@@ -48,9 +58,28 @@ namespace gte
         UniqueVerticesTriangles
     {
     public:
-        // The class has no state, so the constructors, destructors, copy
-        // semantics and move semantics are all the defaults generated by the
-        // compiler.
+        // The only state is the number of threads used for sorting, where a
+        // value of 0 is treated as 1, and the scheduler of SetScheduler(*).
+        UniqueVerticesTriangles(size_t numThreads = 1)
+            :
+            mNumThreads(std::max(numThreads, static_cast<size_t>(1))),
+            mScheduler(nullptr)
+        {
+        }
+
+        // Execute the parallel loops as tasks of the scheduler, which can be
+        // shared with other computations, instead of creating threads for
+        // each call. The results do not depend on the scheduler. Set the
+        // scheduler to null to use std::thread objects again.
+        inline void SetScheduler(TaskScheduler* scheduler)
+        {
+            mScheduler = scheduler;
+        }
+
+        inline TaskScheduler* GetScheduler() const
+        {
+            return mScheduler;
+        }
 
         // See #1 in the comments at the beginning of this file. The
         // preconditions are
@@ -267,41 +296,204 @@ namespace gte
             RemoveUnusedVertices(tempVertices, tempTriangles, outVertices, outTriangles);
         }
 
+        // See #5 in the comments at the beginning of this file. The first
+        // NumComponents coordinates of each vertex are quantized to the
+        // grid of cells [i*epsilon,(i+1)*epsilon) for integers i, where
+        // epsilon > 0. The vertices in the same cell are duplicates, and
+        // each set of duplicates is replaced by its first-found vertex.
+        // Vertices within epsilon of each other but in different cells are
+        // not welded. The preconditions and postconditions are those of
+        // the GenerateIndexedTriangles function with 'outIndices'.
+        template <size_t NumComponents = 3, typename Real>
+        void GenerateIndexedTriangles(
+            std::vector<VertexType> const& inVertices,
+            Real epsilon,
+            std::vector<VertexType>& outVertices,
+            std::vector<int>& outIndices)
+        {
+#if defined(GTL_VALIDATE_UNIQUE_VERTICES_TRIANGLES)
+            LogAssert(inVertices.size() > 0 && inVertices.size() % 3 == 0,
+                "Invalid number of vertices.");
+#endif
+            outIndices.resize(inVertices.size());
+            WeldDuplicates<NumComponents>(inVertices, epsilon, outVertices, outIndices.data());
+        }
+
+        // See #5 in the comments at the beginning of this file and the
+        // comments for the previous function. The preconditions and
+        // postconditions are those of the RemoveDuplicateVertices function
+        // with 'inIndices' and 'outIndices'.
+        template <size_t NumComponents = 3, typename Real>
+        void RemoveDuplicateVertices(
+            std::vector<VertexType> const& inVertices,
+            std::vector<int> const& inIndices,
+            Real epsilon,
+            std::vector<VertexType>& outVertices,
+            std::vector<int>& outIndices)
+        {
+#if defined(GTL_VALIDATE_UNIQUE_VERTICES_TRIANGLES)
+            LogAssert(inVertices.size() > 0, "Invalid number of vertices.");
+            LogAssert(inIndices.size() > 0 && inIndices.size() % 3 == 0,
+                "Invalid number of indices.");
+            int const numVertices = static_cast<int>(inVertices.size());
+            for (auto index : inIndices)
+            {
+                LogAssert(0 <= index && index < numVertices, "Invalid index.");
+            }
+#endif
+
+            std::vector<int> inToOutMapping(inVertices.size());
+            WeldDuplicates<NumComponents>(inVertices, epsilon, outVertices, inToOutMapping.data());
+
+            outIndices.resize(inIndices.size());
+            for (size_t i = 0; i < inIndices.size(); ++i)
+            {
+                outIndices[i] = inToOutMapping[inIndices[i]];
+            }
+        }
+
     private:
         void RemoveDuplicates(
             std::vector<VertexType> const& inVertices,
             std::vector<VertexType>& outVertices,
             int* inToOutMapping)
         {
-            // Construct the unique vertices.
+            auto less = [&inVertices](int i0, int i1)
+            {
+                return inVertices[i0] < inVertices[i1];
+            };
+            RemoveDuplicates(inVertices, less, outVertices, inToOutMapping);
+        }
+
+        template <size_t NumComponents, typename Real>
+        void WeldDuplicates(
+            std::vector<VertexType> const& inVertices,
+            Real epsilon,
+            std::vector<VertexType>& outVertices,
+            int* inToOutMapping)
+        {
+            LogAssert(epsilon > static_cast<Real>(0), "Invalid epsilon.");
+
+            size_t const numInVertices = inVertices.size();
+            std::vector<std::array<int64_t, NumComponents>> cells(numInVertices);
+            size_t const numChunks = std::max(std::min(mNumThreads, numInVertices), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(mScheduler, numChunks,
+                [&inVertices, epsilon, &cells, numInVertices, numChunks](size_t c)
+            {
+                size_t const imin = numInVertices * c / numChunks;
+                size_t const imax = numInVertices * (c + 1) / numChunks;
+                for (size_t i = imin; i < imax; ++i)
+                {
+                    for (size_t j = 0; j < NumComponents; ++j)
+                    {
+                        cells[i][j] = static_cast<int64_t>(std::floor(inVertices[i][j] / epsilon));
+                    }
+                }
+            });
+
+            auto less = [&cells](int i0, int i1)
+            {
+                return cells[i0] < cells[i1];
+            };
+            RemoveDuplicates(inVertices, less, outVertices, inToOutMapping);
+        }
+
+        // The vertices i0 and i1 are duplicates when neither less(i0,i1) nor
+        // less(i1,i0) is true. The unique vertices are stored in the order
+        // in which they are first found in inVertices, so the output is
+        // the same as that of inserting the vertices into a std::map in
+        // order.
+        template <typename Less>
+        void RemoveDuplicates(
+            std::vector<VertexType> const& inVertices,
+            Less const& less,
+            std::vector<VertexType>& outVertices,
+            int* inToOutMapping)
+        {
+            // Sort the vertex indices. Duplicate vertices are sorted by
+            // index, so the first index of a run of duplicates is that of
+            // the first-found vertex.
             size_t const numInVertices = inVertices.size();
-            size_t numOutVertices = 0;
-            std::map<VertexType, int> vmap;
-            for (size_t i = 0; i < numInVertices; ++i, ++inToOutMapping)
+            std::vector<int> sorted(numInVertices);
+            std::iota(sorted.begin(), sorted.end(), 0);
+            auto compare = [&less](int i0, int i1)
             {
-                auto const iter = vmap.find(inVertices[i]);
-                if (iter != vmap.end())
+                return less(i0, i1) || (!less(i1, i0) && i0 < i1);
+            };
+            Sort(sorted, compare);
+
+            std::vector<int> firstFound(numInVertices);
+            for (size_t k0 = 0; k0 < numInVertices; )
+            {
+                size_t k1 = k0 + 1;
+                while (k1 < numInVertices && !less(sorted[k0], sorted[k1]))
                 {
-                    // The vertex is a duplicate of one inserted earlier into
-                    // the map. Its index i will be modified to that of the
-                    // first-found vertex.
-                    *inToOutMapping = iter->second;
+                    ++k1;
+                }
+                for (size_t k = k0; k < k1; ++k)
+                {
+                    firstFound[sorted[k]] = sorted[k0];
+                }
+                k0 = k1;
+            }
+
+            // Construct the unique vertices. The first-found vertex of a
+            // duplicate has a smaller index, so its mapping is known.
+            outVertices.clear();
+            for (size_t i = 0; i < numInVertices; ++i)
+            {
+                if (firstFound[i] == static_cast<int>(i))
+                {
+                    inToOutMapping[i] = static_cast<int>(outVertices.size());
+                    outVertices.push_back(inVertices[i]);
                 }
                 else
                 {
-                    // The vertex occurs for the first time.
-                    vmap.insert(std::make_pair(inVertices[i],
-                        static_cast<int>(numOutVertices)));
-                    *inToOutMapping = static_cast<int>(numOutVertices);
-                    ++numOutVertices;
+                    inToOutMapping[i] = inToOutMapping[firstFound[i]];
                 }
             }
+        }
 
-            // Pack the unique vertices into an array.
-            outVertices.resize(numOutVertices);
-            for (auto const& element : vmap)
+        // Sort mNumThreads blocks of the elements concurrently and then
+        // merge pairs of adjacent blocks concurrently until one block
+        // remains.
+        template <typename Compare>
+        void Sort(std::vector<int>& elements, Compare const& compare) const
+        {
+            size_t const numElements = elements.size();
+            size_t const numBlocks = std::max(std::min(mNumThreads, numElements / 2), static_cast<size_t>(1));
+            std::vector<size_t> bounds(numBlocks + 1);
+            for (size_t b = 0; b <= numBlocks; ++b)
             {
-                outVertices[element.second] = element.first;
+                bounds[b] = numElements * b / numBlocks;
+            }
+
+            auto begin = elements.begin();
+            TaskScheduler::ParallelFor(mScheduler, numBlocks, [&bounds, begin, &compare](size_t b)
+            {
+                std::sort(begin + bounds[b], begin + bounds[b + 1], compare);
+            });
+
+            while (bounds.size() > 2)
+            {
+                size_t const numMerges = (bounds.size() - 1) / 2;
+                TaskScheduler::ParallelFor(mScheduler, numMerges, [&bounds, begin, &compare](size_t m)
+                {
+                    std::inplace_merge(begin + bounds[2 * m],
+                        begin + bounds[2 * m + 1], begin + bounds[2 * m + 2], compare);
+                });
+
+                std::vector<size_t> merged;
+                merged.reserve(numMerges + 2);
+                for (size_t b = 0; b < bounds.size(); b += 2)
+                {
+                    merged.push_back(bounds[b]);
+                }
+                if (merged.back() != numElements)
+                {
+                    merged.push_back(numElements);
+                }
+                bounds = std::move(merged);
             }
         }
 
@@ -312,28 +504,32 @@ namespace gte
             std::vector<VertexType>& outVertices,
             int* outIndices)
         {
-            std::set<int> usedIndices;
+            // Locate the used vertices and pack them into an array in the
+            // order of their indices.
+            std::vector<int> inToOutMapping(inVertices.size(), -1);
             for (size_t i = 0; i < numInIndices; ++i)
             {
-                usedIndices.insert(inIndices[i]);
+                inToOutMapping[inIndices[i]] = 0;
             }
 
-            // Locate the used vertices and pack them into an array.
-            outVertices.resize(usedIndices.size());
-            size_t numOutVertices = 0;
-            std::map<int, int> vmap;
-            for (auto oldIndex : usedIndices)
+            outVertices.clear();
+            for (size_t j = 0; j < inVertices.size(); ++j)
             {
-                outVertices[numOutVertices] = inVertices[oldIndex];
-                vmap.insert(std::make_pair(oldIndex, static_cast<int>(numOutVertices)));
-                ++numOutVertices;
+                if (inToOutMapping[j] == 0)
+                {
+                    inToOutMapping[j] = static_cast<int>(outVertices.size());
+                    outVertices.push_back(inVertices[j]);
+                }
             }
 
             // Reassign the old indices to the new indices.
             for (size_t i = 0; i < numInIndices; ++i)
             {
-                outIndices[i] = vmap.find(inIndices[i])->second;
+                outIndices[i] = inToOutMapping[inIndices[i]];
             }
         }
+
+        size_t mNumThreads;
+        TaskScheduler* mScheduler;
     };
 }
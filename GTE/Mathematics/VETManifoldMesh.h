@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/ETManifoldMesh.h>
+#include <Mathematics/TaskScheduler.h>
 #include <map>
 
 // The VETManifoldMesh class represents an edge-triangle manifold mesh
@@ -61,6 +62,9 @@ namespace gte
         // problematic.  Allowing sharing, say, via std::shared_ptr, is an
         // option but not really the intent of copying the mesh graph.
         VETManifoldMesh(VETManifoldMesh const& mesh)
+            :
+            ETManifoldMesh(mesh.mECreator, mesh.mTCreator),
+            mVCreator(mesh.mVCreator)
         {
             *this = mesh;
         }
@@ -68,6 +72,11 @@ namespace gte
         VETManifoldMesh& operator=(VETManifoldMesh const& mesh)
         {
             Clear();
+            if (mVCreator != mesh.mVCreator)
+            {
+                // The kept objects were created by the previous creator.
+                mVFree.clear();
+            }
             mVCreator = mesh.mVCreator;
             ETManifoldMesh::operator=(mesh);
             return *this;
@@ -79,6 +88,112 @@ namespace gte
             return mVMap;
         }
 
+        // The vertex objects of the default creator are also reused when
+        // the capacity is retained. See ETManifoldMesh::RetainCapacity.
+        virtual void RetainCapacity(bool retain) override
+        {
+            ETManifoldMesh::RetainCapacity(retain);
+            if (!retain)
+            {
+                mVFree.clear();
+                mVFree.shrink_to_fit();
+            }
+        }
+
+        using ETManifoldMesh::Reserve;
+
+        void Reserve(size_t numVertices, size_t numEdges, size_t numTriangles)
+        {
+            mVMap.reserve(numVertices);
+            ETManifoldMesh::Reserve(numEdges, numTriangles);
+        }
+
+        // Build the mesh from an index buffer. See ETManifoldMesh::Create for
+        // the details. The vertices are matched by sorting the triangle
+        // corners, and the vertex adjacency sets are filled concurrently,
+        // each vertex by one thread.
+        virtual bool Create(size_t numTriangles, int const* indices, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr) override
+        {
+            std::vector<Triangle*> triangles;
+            if (!CreateEdgesAndTriangles(numTriangles, indices, numThreads, scheduler, triangles))
+            {
+                return false;
+            }
+
+            // Sort the corners c = 3*t+i, where corner i of triangles[t] is
+            // V[i], by vertex index.
+            size_t const numUnique = triangles.size();
+            size_t const numCorners = 3 * numUnique;
+            std::vector<SortElement> corners(numCorners);
+            size_t numChunks = std::max(std::min(numThreads, numUnique), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks, [&triangles, &corners, numUnique, numChunks](size_t chunk)
+            {
+                size_t const tmin = numUnique * chunk / numChunks;
+                size_t const tmax = numUnique * (chunk + 1) / numChunks;
+                for (size_t t = tmin, c = 3 * tmin; t < tmax; ++t)
+                {
+                    auto const& V = triangles[t]->V;
+                    for (size_t i = 0; i < 3; ++i, ++c)
+                    {
+                        corners[c] = std::make_pair(static_cast<uint64_t>(static_cast<uint32_t>(V[i])), c);
+                    }
+                }
+            });
+            SortElements(numThreads, scheduler, corners);
+
+            // Create the vertices, each a range [groups[v],groups[v+1]) of
+            // sorted corners.
+            std::vector<size_t> groups;
+            for (size_t i = 0; i < numCorners; ++i)
+            {
+                if (i == 0 || corners[i].first != corners[i - 1].first)
+                {
+                    groups.push_back(i);
+                }
+            }
+            groups.push_back(numCorners);
+
+            size_t const numVertices = groups.size() - 1;
+            std::vector<Vertex*> vertices(numVertices);
+            mVMap.reserve(numVertices);
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                size_t c = corners[groups[v]].second;
+                int vIndex = triangles[c / 3]->V[c % 3];
+                std::unique_ptr<Vertex> newVertex = AcquireVertex(vIndex);
+                vertices[v] = newVertex.get();
+                mVMap.emplace(vIndex, std::move(newVertex));
+            }
+
+            // The corner V[i] of a triangle is shared by the edges E[i] and
+            // E[(i+2)%3].
+            numChunks = std::max(std::min(numThreads, numVertices), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [&triangles, &corners, &groups, &vertices, numVertices, numChunks](size_t chunk)
+            {
+                size_t const vmin = numVertices * chunk / numChunks;
+                size_t const vmax = numVertices * (chunk + 1) / numChunks;
+                for (size_t v = vmin; v < vmax; ++v)
+                {
+                    Vertex* vertex = vertices[v];
+                    vertex->TAdjacent.reserve(groups[v + 1] - groups[v]);
+                    for (size_t k = groups[v]; k < groups[v + 1]; ++k)
+                    {
+                        size_t c = corners[k].second;
+                        Triangle* tri = triangles[c / 3];
+                        size_t i0 = c % 3, i1 = (i0 + 1) % 3, i2 = (i0 + 2) % 3;
+                        vertex->TAdjacent.insert(tri);
+                        vertex->VAdjacent.insert(tri->V[i1]);
+                        vertex->VAdjacent.insert(tri->V[i2]);
+                        vertex->EAdjacent.insert(tri->E[i0]);
+                        vertex->EAdjacent.insert(tri->E[i2]);
+                    }
+                }
+            });
+            return true;
+        }
+
         // If <v0,v1,v2> is not in the mesh, a Triangle object is created and
         // returned; otherwise, <v0,v1,v2> is in the mesh and nullptr is
         // returned.  If the insertion leads to a nonmanifold mesh, the call
@@ -98,7 +213,7 @@ namespace gte
                 Vertex* vertex;
                 if (vItem == mVMap.end())
                 {
-                    std::unique_ptr<Vertex> newVertex = mVCreator(vIndex);
+                    std::unique_ptr<Vertex> newVertex = AcquireVertex(vIndex);
                     vertex = newVertex.get();
                     mVMap[vIndex] = std::move(newVertex);
                 }
@@ -172,6 +287,7 @@ namespace gte
                     LogAssert(vertex->VAdjacent.size() == 0 && vertex->EAdjacent.size() == 0,
                         "Malformed mesh: Inconsistent vertex adjacency information.");
 
+                    ReleaseVertex(vItem->second);
                     mVMap.erase(vItem);
                 }
             }
@@ -182,6 +298,13 @@ namespace gte
         // Destroy the vertices, edges, and triangles to obtain an empty mesh.
         virtual void Clear() override
         {
+            if (mRetainCapacity)
+            {
+                for (auto& element : mVMap)
+                {
+                    ReleaseVertex(element.second);
+                }
+            }
             mVMap.clear();
             ETManifoldMesh::Clear();
         }
@@ -195,5 +318,32 @@ namespace gte
 
         VCreator mVCreator;
         VMap mVMap;
+
+        // Reuse of the vertex objects when the capacity is retained. The
+        // adjacency sets of a reused vertex keep their buckets.
+        std::unique_ptr<Vertex> AcquireVertex(int vIndex)
+        {
+            if (mVFree.size() > 0)
+            {
+                std::unique_ptr<Vertex> vertex = std::move(mVFree.back());
+                mVFree.pop_back();
+                vertex->V = vIndex;
+                return vertex;
+            }
+            return mVCreator(vIndex);
+        }
+
+        void ReleaseVertex(std::unique_ptr<Vertex>& vertex)
+        {
+            if (mRetainCapacity && mVCreator == CreateVertex)
+            {
+                vertex->VAdjacent.clear();
+                vertex->EAdjacent.clear();
+                vertex->TAdjacent.clear();
+                mVFree.push_back(std::move(vertex));
+            }
+        }
+
+        std::vector<std::unique_ptr<Vertex>> mVFree;
     };
 }
@@ -0,0 +1,144 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// The vertices adjacent to each vertex of a triangle mesh, stored in the
+// compressed sparse row (CSR) format: the vertices adjacent to vertex v are
+//   GetAdjacent()[GetOffsets()[v]] through GetAdjacent()[GetOffsets()[v+1]-1]
+// in increasing order. The mesh is an index buffer of numTriangles triples,
+// (indices[3*t], indices[3*t+1], indices[3*t+2]) being the vertices of
+// triangle t. Each edge <v0,v1> has an entry in the rows of v0 and of v1,
+// and GetNumEdgeTriangles()[k] is the number of triangles sharing the edge
+// of entry k, which is 1 for a boundary edge and 2 for an interior edge of
+// a manifold mesh. The adjacency is built by counting sorts of the triangle
+// corners, which is much faster than building ETManifoldMesh when only the
+// one-rings of the vertices are needed, and the arrays can be used directly
+// as the sparsity pattern of a linear system or uploaded to a GPU.
+
+namespace gte
+{
+    class VertexAdjacency
+    {
+    public:
+        VertexAdjacency() = default;
+
+        template <typename Index>
+        VertexAdjacency(size_t numVertices, size_t numTriangles, Index const* indices)
+        {
+            Create(numVertices, numTriangles, indices);
+        }
+
+        template <typename Index>
+        void Create(size_t numVertices, size_t numTriangles, Index const* indices)
+        {
+            // Each triangle corner contributes the two edges at its vertex.
+            size_t const numIndices = 3 * numTriangles;
+            std::vector<size_t> cornerOffsets(numVertices + 1, 0);
+            for (size_t i = 0; i < numIndices; ++i)
+            {
+                LogAssert(static_cast<size_t>(indices[i]) < numVertices, "Invalid index.");
+                cornerOffsets[static_cast<size_t>(indices[i]) + 1] += 2;
+            }
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                cornerOffsets[v + 1] += cornerOffsets[v];
+            }
+
+            std::vector<size_t> next(cornerOffsets.begin(), cornerOffsets.end() - 1);
+            std::vector<unsigned int> cornerAdjacent(2 * numIndices);
+            for (size_t t = 0; t < numTriangles; ++t)
+            {
+                Index const* triangle = &indices[3 * t];
+                for (size_t i = 0; i < 3; ++i)
+                {
+                    size_t& k = next[static_cast<size_t>(triangle[i])];
+                    cornerAdjacent[k++] = static_cast<unsigned int>(triangle[(i + 1) % 3]);
+                    cornerAdjacent[k++] = static_cast<unsigned int>(triangle[(i + 2) % 3]);
+                }
+            }
+
+            // Sort each row and combine the entries of the same edge, whose
+            // number is the number of triangles sharing the edge.
+            mOffsets.assign(numVertices + 1, 0);
+            mAdjacent.clear();
+            mNumEdgeTriangles.clear();
+            mAdjacent.reserve(numIndices);
+            mNumEdgeTriangles.reserve(numIndices);
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                auto first = cornerAdjacent.begin() + cornerOffsets[v];
+                auto last = cornerAdjacent.begin() + cornerOffsets[v + 1];
+                std::sort(first, last);
+                while (first != last)
+                {
+                    auto end = std::upper_bound(first, last, *first);
+                    mAdjacent.push_back(*first);
+                    mNumEdgeTriangles.push_back(static_cast<unsigned int>(end - first));
+                    first = end;
+                }
+                mOffsets[v + 1] = mAdjacent.size();
+            }
+        }
+
+        inline size_t GetNumVertices() const
+        {
+            return (mOffsets.size() > 0 ? mOffsets.size() - 1 : 0);
+        }
+
+        inline std::vector<size_t> const& GetOffsets() const
+        {
+            return mOffsets;
+        }
+
+        inline std::vector<unsigned int> const& GetAdjacent() const
+        {
+            return mAdjacent;
+        }
+
+        inline std::vector<unsigned int> const& GetNumEdgeTriangles() const
+        {
+            return mNumEdgeTriangles;
+        }
+
+        inline size_t GetNumAdjacent(size_t v) const
+        {
+            return mOffsets[v + 1] - mOffsets[v];
+        }
+
+        inline unsigned int const* GetAdjacent(size_t v) const
+        {
+            return mAdjacent.data() + mOffsets[v];
+        }
+
+        // Get the index k of the entry of the edge <v0,v1> in the row of
+        // v0. The function returns std::numeric_limits<size_t>::max() when
+        // the vertices are not adjacent.
+        size_t Find(size_t v0, size_t v1) const
+        {
+            auto first = mAdjacent.begin() + mOffsets[v0];
+            auto last = mAdjacent.begin() + mOffsets[v0 + 1];
+            auto iter = std::lower_bound(first, last, static_cast<unsigned int>(v1));
+            if (iter != last && *iter == static_cast<unsigned int>(v1))
+            {
+                return static_cast<size_t>(iter - mAdjacent.begin());
+            }
+            return std::numeric_limits<size_t>::max();
+        }
+
+    private:
+        std::vector<size_t> mOffsets;
+        std::vector<unsigned int> mAdjacent;
+        std::vector<unsigned int> mNumEdgeTriangles;
+    };
+}
@@ -3,15 +3,18 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.22
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/MinHeap.h>
 #include <Mathematics/Polygon2.h>
+#include <Mathematics/TaskScheduler.h>
 #include <Mathematics/TriangulateEC.h>
 #include <Mathematics/Vector3.h>
 #include <Mathematics/VETManifoldMesh.h>
+#include <algorithm>
+#include <cstdint>
 #include <set>
 
 namespace gte
@@ -35,16 +38,10 @@ namespace gte
                 return;
             }
 
-            // Build the manifold mesh from the inputs.
-            int numTriangles = numIndices / 3;
-            int const* current = indices;
-            for (int t = 0; t < numTriangles; ++t)
-            {
-                int v0 = *current++;
-                int v1 = *current++;
-                int v2 = *current++;
-                mMesh.Insert(v0, v1, v2);
-            }
+            // Build the manifold mesh from the inputs. The collapses remove
+            // and insert many triangles, so the mesh objects are recycled.
+            mMesh.RetainCapacity(true);
+            mMesh.Create(static_cast<size_t>(numIndices / 3), indices);
 
             // Locate the vertices (if any) on the mesh boundary.
             auto const& vmap = mMesh.GetVertices();
@@ -63,7 +60,12 @@ namespace gte
             }
 
             // Build the priority queue of weights for the interior vertices.
+            // The heap records and the lazy-update states are stored in
+            // arrays indexed by vertex.
             mMinHeap.Reset((int)vmap.size());
+            mHeapRecords.resize(static_cast<size_t>(mNumPositions), nullptr);
+            mInvalid.resize(static_cast<size_t>(mNumPositions), 0);
+            mMarked.resize(static_cast<size_t>(mNumPositions), 0);
             for (auto const& velement : vmap)
             {
                 auto vertex = static_cast<VCVertex*>(velement.second.get());
@@ -78,8 +80,7 @@ namespace gte
                     weight = vertex->ComputeWeight(mPositions);
                 }
 
-                auto record = mMinHeap.Insert(velement.first, weight);
-                mHeapRecords.insert(std::make_pair(velement.first, record));
+                mHeapRecords[velement.first] = mMinHeap.Insert(velement.first, weight);
             }
         }
 
@@ -136,6 +137,14 @@ namespace gte
                 }
 
                 auto vertex = static_cast<VCVertex*>(velement->second.get());
+                if (mInvalid[v])
+                {
+                    // The weight was invalidated by DoCollapses(...).
+                    mInvalid[v] = 0;
+                    mMinHeap.Update(mHeapRecords[v], vertex->ComputeWeight(mPositions));
+                    continue;
+                }
+
                 std::vector<TriangleKey<true>> removed, inserted;
                 std::vector<int> linkVertices;
                 int result = TriangulateLink(vertex, removed, inserted, linkVertices);
@@ -156,7 +165,7 @@ namespace gte
                     {
                         // Remove the vertex and associated weight.
                         mMinHeap.Remove(v, weight);
-                        mHeapRecords.erase(v);
+                        mHeapRecords[v] = nullptr;
 
                         // Update the weights of the link vertices.
                         for (auto vlink : linkVertices)
@@ -171,15 +180,16 @@ namespace gte
                             vertex = static_cast<VCVertex*>(velement->second.get());
                             if (!vertex->isBoundary)
                             {
-                                auto iter = mHeapRecords.find(vlink);
-                                if (iter == mHeapRecords.end())
+                                auto heapRecord = mHeapRecords[vlink];
+                                if (!heapRecord)
                                 {
                                     // Unexpected condition.
                                     return false;
                                 }
 
                                 weight = vertex->ComputeWeight(mPositions);
-                                mMinHeap.Update(iter->second, weight);
+                                mMinHeap.Update(heapRecord, weight);
+                                mInvalid[vlink] = 0;
                             }
                         }
 
@@ -196,13 +206,7 @@ namespace gte
                 // edge weight to infinity.  After removal of other triangles,
                 // the vertex weight will be updated to a finite value and the
                 // vertex possibly can be removed at that time.
-                auto iter = mHeapRecords.find(v);
-                if (iter == mHeapRecords.end())
-                {
-                    // Unexpected condition.
-                    return false;
-                }
-                mMinHeap.Update(iter->second, std::numeric_limits<Real>::max());
+                mMinHeap.Update(mHeapRecords[v], std::numeric_limits<Real>::max());
             }
 
             // We do not expect to reach this line of code, even for a closed
@@ -211,6 +215,209 @@ namespace gte
             return false;
         }
 
+        // A faster decimation that collapses a batch of vertices per call.
+        // Up to maxCollapses vertices of smallest weights are selected for
+        // which no vertex is in the link of another and the links are
+        // disjoint, so the collapses are independent of each other. The
+        // links of the selected vertices are triangulated concurrently by
+        // numThreads threads, which are tasks of the scheduler when it is
+        // not null, and then the vertices are collapsed. The
+        // weights of the link vertices are invalidated rather than
+        // recomputed; a weight is recomputed only when its vertex reaches
+        // the top of the heap. The collapse order is therefore not the
+        // order of DoCollapse(...), which always uses current weights. The
+        // return value is 'true' when at least one vertex collapse occurs,
+        // in which case 'records' contains the collapses in the order they
+        // were applied. The function returns 'false' when no more vertex
+        // collapses are allowed or when a consistency test fails (see
+        // DoCollapse).
+        bool DoCollapses(size_t maxCollapses, std::vector<Record>& records, size_t numThreads = 1,
+            TaskScheduler* scheduler = nullptr)
+        {
+            records.clear();
+            if (mNumPositions == 0 || maxCollapses == 0)
+            {
+                return false;
+            }
+
+            auto const& vmap = mMesh.GetVertices();
+            std::vector<VCVertex*> selected;
+            std::vector<std::pair<int, Real>> postponed;
+            std::vector<int> marked, invalidated;
+            while (records.size() == 0)
+            {
+                // Select the vertices of the batch. A vertex that is not
+                // independent of the selected ones is removed from the heap
+                // and reinserted at the end of the batch.
+                selected.clear();
+                postponed.clear();
+                while (selected.size() < maxCollapses && mMinHeap.GetNumElements() > 0)
+                {
+                    int v = -1;
+                    Real weight = std::numeric_limits<Real>::max();
+                    mMinHeap.GetMinimum(v, weight);
+                    if (weight == std::numeric_limits<Real>::max())
+                    {
+                        // There are no more interior vertices to collapse.
+                        break;
+                    }
+
+                    auto velement = vmap.find(v);
+                    if (velement == vmap.end())
+                    {
+                        // Unexpected condition.
+                        return false;
+                    }
+
+                    auto vertex = static_cast<VCVertex*>(velement->second.get());
+                    if (mInvalid[v])
+                    {
+                        mInvalid[v] = 0;
+                        mMinHeap.Update(mHeapRecords[v], vertex->ComputeWeight(mPositions));
+                        continue;
+                    }
+
+                    mMinHeap.Remove(v, weight);
+                    mHeapRecords[v] = nullptr;
+
+                    bool isIndependent = (mMarked[v] == 0);
+                    for (auto vlink : vertex->VAdjacent)
+                    {
+                        if (mMarked[vlink])
+                        {
+                            isIndependent = false;
+                            break;
+                        }
+                    }
+
+                    if (isIndependent)
+                    {
+                        mMarked[v] = 1;
+                        marked.push_back(v);
+                        for (auto vlink : vertex->VAdjacent)
+                        {
+                            mMarked[vlink] = 1;
+                            marked.push_back(vlink);
+                        }
+                        selected.push_back(vertex);
+                    }
+                    else
+                    {
+                        postponed.push_back(std::make_pair(v, weight));
+                    }
+                }
+
+                for (auto v : marked)
+                {
+                    mMarked[v] = 0;
+                }
+                marked.clear();
+
+                if (selected.size() == 0)
+                {
+                    for (auto const& element : postponed)
+                    {
+                        mHeapRecords[element.first] = mMinHeap.Insert(element.first, element.second);
+                    }
+                    return false;
+                }
+
+                // Triangulate the links. The mesh is only read.
+                size_t const numSelected = selected.size();
+                std::vector<int> results(numSelected);
+                std::vector<std::vector<TriangleKey<true>>> removed(numSelected), inserted(numSelected);
+                std::vector<std::vector<int>> linkVertices(numSelected);
+                // A failed triangulation stops the fetching of the others.
+                TaskScheduler::ParallelForDynamic(scheduler, numSelected, numThreads,
+                    [this, &selected, &results, &removed, &inserted, &linkVertices](size_t i)
+                    {
+                        results[i] = TriangulateLink(selected[i], removed[i], inserted[i], linkVertices[i]);
+                    });
+
+                // Apply the collapses and invalidate the weights of the
+                // link vertices. A vertex whose collapse is deferred is
+                // reinserted with infinite weight, as in DoCollapse(...).
+                for (size_t i = 0; i < numSelected; ++i)
+                {
+                    int v = selected[i]->V;
+                    int result = results[i];
+                    if (result == VCM_UNEXPECTED_ERROR)
+                    {
+                        return false;
+                    }
+
+                    if (result == VCM_ALLOWED)
+                    {
+                        result = Collapsed(removed[i], inserted[i], linkVertices[i]);
+                        if (result == VCM_UNEXPECTED_ERROR)
+                        {
+                            return false;
+                        }
+                    }
+
+                    if (result == VCM_ALLOWED)
+                    {
+                        for (auto vlink : linkVertices[i])
+                        {
+                            if (!mInvalid[vlink])
+                            {
+                                mInvalid[vlink] = 1;
+                                invalidated.push_back(vlink);
+                            }
+                        }
+
+                        Record record;
+                        record.vertex = v;
+                        record.removed = std::move(removed[i]);
+                        record.inserted = std::move(inserted[i]);
+                        records.push_back(std::move(record));
+                    }
+                    else
+                    {
+                        mHeapRecords[v] = mMinHeap.Insert(v, std::numeric_limits<Real>::max());
+                    }
+                }
+
+                for (auto const& element : postponed)
+                {
+                    mHeapRecords[element.first] = mMinHeap.Insert(element.first, element.second);
+                }
+
+                // The invalidated vertices with infinite weights, which are
+                // the boundary vertices and the deferred vertices, never
+                // reach the top of the heap. Recompute the weights of the
+                // deferred vertices now so that they can be collapsed later.
+                for (auto vlink : invalidated)
+                {
+                    auto heapRecord = mHeapRecords[vlink];
+                    if (!heapRecord)
+                    {
+                        // Unexpected condition.
+                        return false;
+                    }
+
+                    if (heapRecord->value == std::numeric_limits<Real>::max())
+                    {
+                        mInvalid[vlink] = 0;
+                        auto velement = vmap.find(vlink);
+                        if (velement == vmap.end())
+                        {
+                            // Unexpected condition.
+                            return false;
+                        }
+
+                        auto vertex = static_cast<VCVertex*>(velement->second.get());
+                        if (!vertex->isBoundary)
+                        {
+                            mMinHeap.Update(heapRecord, vertex->ComputeWeight(mPositions));
+                        }
+                    }
+                }
+                invalidated.clear();
+            }
+            return true;
+        }
+
         // Access the current state of the mesh, whether the original built
         // in the constructor or a decimated mesh during DoCollapse calls.
         inline ETManifoldMesh const& GetMesh() const
@@ -319,36 +526,52 @@ namespace gte
             // vertex normal has already been computed.
 
             // Get the edges of the link that are opposite the incoming
-            // vertex.
+            // vertex. The edges are stored in a sorted array because there
+            // are only a few of them.
             int const numVertices = static_cast<int>(vertex->TAdjacent.size());
             removed.resize(numVertices);
             int j = 0;
-            std::map<int, int> edgeMap;
+            std::vector<std::pair<int, int>> edges;
+            edges.reserve(numVertices);
             for (auto tri : vertex->TAdjacent)
             {
                 for (int i = 0; i < 3; ++i)
                 {
                     if (tri->V[i] == vertex->V)
                     {
-                        edgeMap.insert(std::make_pair(tri->V[(i + 1) % 3], tri->V[(i + 2) % 3]));
+                        edges.push_back(std::make_pair(tri->V[(i + 1) % 3], tri->V[(i + 2) % 3]));
                         break;
                     }
                 }
                 removed[j++] = TriangleKey<true>(tri->V[0], tri->V[1], tri->V[2]);
             }
-            if (edgeMap.size() != vertex->TAdjacent.size())
+            std::sort(edges.begin(), edges.end());
+            for (size_t i = 1; i < edges.size(); ++i)
+            {
+                if (edges[i].first == edges[i - 1].first)
+                {
+                    return VCM_UNEXPECTED_ERROR;
+                }
+            }
+            if (static_cast<int>(edges.size()) != numVertices)
             {
                 return VCM_UNEXPECTED_ERROR;
             }
 
             // Connect the edges into a polygon.
             linkVertices.resize(numVertices);
-            auto iter = edgeMap.begin();
+            auto findEdge = [&edges](int v)
+            {
+                auto iter = std::lower_bound(edges.begin(), edges.end(),
+                    std::make_pair(v, std::numeric_limits<int>::min()));
+                return (iter != edges.end() && iter->first == v ? iter : edges.end());
+            };
+            auto iter = edges.begin();
             for (int i = 0; i < numVertices; ++i)
             {
                 linkVertices[i] = iter->first;
-                iter = edgeMap.find(iter->second);
-                if (iter == edgeMap.end())
+                iter = findEdge(iter->second);
+                if (iter == edges.end())
                 {
                     return VCM_UNEXPECTED_ERROR;
                 }
@@ -512,6 +735,10 @@ namespace gte
         VETManifoldMesh mMesh;
 
         MinHeap<int, Real> mMinHeap;
-        std::map<int, typename MinHeap<int, Real>::Record*> mHeapRecords;
+        std::vector<typename MinHeap<int, Real>::Record*> mHeapRecords;
+
+        // Support for DoCollapses(...). The flags are indexed by vertex.
+        std::vector<uint8_t> mInvalid;
+        std::vector<uint8_t> mMarked;
     };
 }
@@ -0,0 +1,131 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/TaskScheduler.h>
+#include <Mathematics/Vector3.h>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// The triangles sharing each vertex of a triangle mesh, stored in the
+// compressed sparse row (CSR) format: the triangles sharing vertex v are
+//   GetTriangles()[GetOffsets()[v]] through GetTriangles()[GetOffsets()[v+1]-1]
+// in increasing order. The mesh is an index buffer of numTriangles triples,
+// (indices[3*t], indices[3*t+1], indices[3*t+2]) being the vertices of
+// triangle t. The adjacency uses 4 bytes per triangle corner plus the
+// offsets, which is much smaller than the edge and triangle objects of
+// ETManifoldMesh or VETManifoldMesh, and it allows per-vertex quantities to
+// be computed by gathering from the one-ring triangles of a vertex. Unlike
+// scattering the triangle contributions to the vertices, gathering may be
+// partitioned among threads without synchronization.
+
+namespace gte
+{
+    class VertexTriangleAdjacency
+    {
+    public:
+        VertexTriangleAdjacency() = default;
+
+        VertexTriangleAdjacency(size_t numVertices, size_t numTriangles,
+            unsigned int const* indices)
+        {
+            Create(numVertices, numTriangles, indices);
+        }
+
+        void Create(size_t numVertices, size_t numTriangles, unsigned int const* indices)
+        {
+            size_t const numIndices = 3 * numTriangles;
+            mOffsets.assign(numVertices + 1, 0);
+            for (size_t i = 0; i < numIndices; ++i)
+            {
+                LogAssert(indices[i] < numVertices, "Invalid index.");
+                ++mOffsets[static_cast<size_t>(indices[i]) + 1];
+            }
+            for (size_t v = 0; v < numVertices; ++v)
+            {
+                mOffsets[v + 1] += mOffsets[v];
+            }
+
+            // Visiting the triangles in order sorts the triangles of each
+            // vertex. A triangle with a repeated vertex is stored once for
+            // each occurrence.
+            std::vector<size_t> next(mOffsets.begin(), mOffsets.end() - 1);
+            mTriangles.resize(numIndices);
+            for (size_t i = 0; i < numIndices; ++i)
+            {
+                mTriangles[next[indices[i]]++] = static_cast<unsigned int>(i / 3);
+            }
+        }
+
+        inline size_t GetNumVertices() const
+        {
+            return (mOffsets.size() > 0 ? mOffsets.size() - 1 : 0);
+        }
+
+        inline std::vector<size_t> const& GetOffsets() const
+        {
+            return mOffsets;
+        }
+
+        inline std::vector<unsigned int> const& GetTriangles() const
+        {
+            return mTriangles;
+        }
+
+        inline size_t GetNumTriangles(size_t v) const
+        {
+            return mOffsets[v + 1] - mOffsets[v];
+        }
+
+        inline unsigned int const* GetTriangles(size_t v) const
+        {
+            return mTriangles.data() + mOffsets[v];
+        }
+
+        // Compute the unit-length vertex normals as the normalized sums of
+        // the cross products of the edges of the one-ring triangles, which
+        // weights the triangle normals by twice the triangle areas. The
+        // normal of a vertex not shared by triangles is the zero vector.
+        // The vertices are partitioned into numChunks ranges that are
+        // processed by the scheduler or, when it is null, by std::thread
+        // objects. The results do not depend on numChunks.
+        template <typename Real>
+        void ComputeNormals(Vector3<Real> const* vertices, unsigned int const* indices,
+            Vector3<Real>* normals, size_t numChunks = 1,
+            TaskScheduler* scheduler = nullptr) const
+        {
+            size_t const numVertices = GetNumVertices();
+            numChunks = std::max(std::min(numChunks, numVertices), static_cast<size_t>(1));
+            TaskScheduler::ParallelFor(scheduler, numChunks,
+                [this, vertices, indices, normals, numVertices, numChunks](size_t chunk)
+                {
+                    size_t const vmin = numVertices * chunk / numChunks;
+                    size_t const vmax = numVertices * (chunk + 1) / numChunks;
+                    for (size_t v = vmin; v < vmax; ++v)
+                    {
+                        Vector3<Real> normal{ (Real)0, (Real)0, (Real)0 };
+                        for (size_t k = mOffsets[v]; k < mOffsets[v + 1]; ++k)
+                        {
+                            unsigned int const* triangle = &indices[3 * static_cast<size_t>(mTriangles[k])];
+                            Vector3<Real> edge1 = vertices[triangle[1]] - vertices[triangle[0]];
+                            Vector3<Real> edge2 = vertices[triangle[2]] - vertices[triangle[0]];
+                            normal += Cross(edge1, edge2);
+                        }
+                        Normalize(normal);
+                        normals[v] = normal;
+                    }
+                });
+        }
+
+    private:
+        std::vector<size_t> mOffsets;
+        std::vector<unsigned int> mTriangles;
+    };
+}
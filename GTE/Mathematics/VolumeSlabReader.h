@@ -0,0 +1,236 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/Image3.h>
+#include <Mathematics/Logger.h>
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// Read z-slabs of a raw volume file, the format of the .binary volumes in
+// Samples/Data such as Head_U16_X128_Y128_Z64.binary. The file has no
+// header; it stores dim0*dim1*dim2 values of PixelType in lexicographical
+// order, so slice z is the contiguous block of dim0*dim1 values starting
+// at value z*dim0*dim1. The dimensions and type are encoded in the file
+// name, which GetDimensions parses.
+//
+// Stream processes the volume one slab at a time, so only two slabs are in
+// memory. The next slab is read by a second thread while the current slab
+// is processed, which overlaps the I/O with the computation. A slab can
+// have ghost slices on each side for filters with a z-neighborhood. For
+// example, a level surface is extracted with bounded memory by
+//
+//   VolumeSlabReader<uint8_t> reader(filename, 100, 100, 120);
+//   reader.Stream(16, 1, [&](Image3<uint8_t> const& slab, int zFirst,
+//       int zBegin, int zEnd)
+//   {
+//       // The owned voxels are [zBegin,zEnd-1]; the cubes between them and
+//       // the next slab need the one ghost slice at zEnd. Extract from the
+//       // slices [zBegin,min(zEnd+1,dim2)) of the slab, which start at
+//       // slab slice zBegin-zFirst, and translate the vertices by zFirst.
+//   });
+
+namespace gte
+{
+    template <typename PixelType>
+    class VolumeSlabReader
+    {
+    public:
+        // Open the file and verify that its size is that of the dimensions.
+        // Use IsOpen() to test for success.
+        VolumeSlabReader(std::string const& filename, int dim0, int dim1, int dim2)
+            :
+            mInput(filename, std::ios::in | std::ios::binary),
+            mDim0(dim0),
+            mDim1(dim1),
+            mDim2(dim2),
+            mSliceSize(static_cast<size_t>(dim0) * static_cast<size_t>(dim1))
+        {
+            LogAssert(dim0 > 0 && dim1 > 0 && dim2 > 0, "Invalid dimensions.");
+
+            if (mInput)
+            {
+                mInput.seekg(0, std::ios::end);
+                std::streamoff const numBytes = mInput.tellg();
+                mInput.seekg(0, std::ios::beg);
+                if (numBytes != static_cast<std::streamoff>(mSliceSize * dim2 * sizeof(PixelType)))
+                {
+                    mInput.close();
+                }
+            }
+        }
+
+        // Parse the dimensions and the type of a file name of the form
+        // <name>_<type>_X<dim0>_Y<dim1>_Z<dim2>.binary, where <type> is
+        // U8, U16, etc. The path and the file extension are ignored. The
+        // function returns 'false' when the name does not have this form.
+        static bool GetDimensions(std::string const& filename, std::string& type,
+            int& dim0, int& dim1, int& dim2)
+        {
+            size_t const slash = filename.find_last_of("/\\");
+            std::string name = filename.substr(slash == std::string::npos ? 0 : slash + 1);
+            name = name.substr(0, name.find_last_of('.'));
+
+            size_t const zPos = name.rfind("_Z");
+            size_t const yPos = name.rfind("_Y", zPos);
+            size_t const xPos = name.rfind("_X", yPos);
+            if (zPos == std::string::npos || yPos == std::string::npos
+                || xPos == std::string::npos || xPos == 0)
+            {
+                return false;
+            }
+
+            size_t const tPos = name.rfind('_', xPos - 1);
+            if (tPos == std::string::npos)
+            {
+                return false;
+            }
+
+            try
+            {
+                type = name.substr(tPos + 1, xPos - tPos - 1);
+                dim0 = std::stoi(name.substr(xPos + 2, yPos - xPos - 2));
+                dim1 = std::stoi(name.substr(yPos + 2, zPos - yPos - 2));
+                dim2 = std::stoi(name.substr(zPos + 2));
+            }
+            catch (std::exception const&)
+            {
+                return false;
+            }
+            return dim0 > 0 && dim1 > 0 && dim2 > 0;
+        }
+
+        inline bool IsOpen() const
+        {
+            return mInput.is_open();
+        }
+
+        inline int GetDimension(int i) const
+        {
+            return (i == 0 ? mDim0 : (i == 1 ? mDim1 : mDim2));
+        }
+
+        // Read the slices [zBegin,zEnd) into slab, which is resized to
+        // dim0-by-dim1-by-(zEnd-zBegin). The function returns 'false' when
+        // the read fails.
+        bool ReadSlab(int zBegin, int zEnd, Image3<PixelType>& slab)
+        {
+            LogAssert(0 <= zBegin && zBegin < zEnd && zEnd <= mDim2, "Invalid slab.");
+
+            if (!mInput.is_open())
+            {
+                return false;
+            }
+
+            int const numSlices = zEnd - zBegin;
+            if (slab.GetNumDimensions() != 3 || slab.GetDimension(0) != mDim0
+                || slab.GetDimension(1) != mDim1 || slab.GetDimension(2) != numSlices)
+            {
+                slab.Reconstruct(mDim0, mDim1, numSlices);
+            }
+
+            size_t const numBytes = mSliceSize * numSlices * sizeof(PixelType);
+            mInput.clear();
+            mInput.seekg(static_cast<std::streamoff>(mSliceSize * zBegin * sizeof(PixelType)),
+                std::ios::beg);
+            mInput.read(reinterpret_cast<char*>(slab.GetPixels().data()),
+                static_cast<std::streamsize>(numBytes));
+            return static_cast<bool>(mInput);
+        }
+
+        // Call function(slab, zFirst, zBegin, zEnd) for the slabs that own
+        // the slices [zBegin,zEnd) = [s*slabSize,min((s+1)*slabSize,dim2))
+        // for s = 0, 1, .... Each slab also has up to numGhosts slices on
+        // each side, clamped to the volume, so slab slice 0 is volume slice
+        // zFirst = max(zBegin-numGhosts,0). While the function processes a
+        // slab, the next slab is read by another thread. The function
+        // returns 'false' when a read fails; the slabs before the failure
+        // have been processed.
+        template <typename Function>
+        bool Stream(int slabSize, int numGhosts, Function const& function)
+        {
+            LogAssert(slabSize > 0 && numGhosts >= 0, "Invalid input.");
+
+            auto getRange = [this, slabSize, numGhosts](int z, int& zFirst, int& zLast)
+            {
+                zFirst = std::max(z - numGhosts, 0);
+                zLast = std::min(z + slabSize + numGhosts, mDim2);
+            };
+
+            Image3<PixelType> current, next;
+            int zFirst, zLast;
+            getRange(0, zFirst, zLast);
+            if (!ReadSlab(zFirst, zLast, current))
+            {
+                return false;
+            }
+
+            for (int zBegin = 0; zBegin < mDim2; zBegin += slabSize)
+            {
+                int const zEnd = std::min(zBegin + slabSize, mDim2);
+                int nextFirst = 0, nextLast = 0;
+                bool nextRead = true;
+                std::exception_ptr exception = nullptr;
+                std::thread reader;
+                if (zEnd < mDim2)
+                {
+                    getRange(zEnd, nextFirst, nextLast);
+                    reader = std::thread([this, &next, &nextRead, &exception, nextFirst, nextLast]()
+                    {
+                        try
+                        {
+                            nextRead = ReadSlab(nextFirst, nextLast, next);
+                        }
+                        catch (...)
+                        {
+                            exception = std::current_exception();
+                        }
+                    });
+                }
+
+                try
+                {
+                    function(static_cast<Image3<PixelType> const&>(current), zFirst, zBegin, zEnd);
+                }
+                catch (...)
+                {
+                    if (reader.joinable())
+                    {
+                        reader.join();
+                    }
+                    throw;
+                }
+
+                if (reader.joinable())
+                {
+                    reader.join();
+                    if (exception)
+                    {
+                        std::rethrow_exception(exception);
+                    }
+                    if (!nextRead)
+                    {
+                        return false;
+                    }
+                    std::swap(current, next);
+                    zFirst = nextFirst;
+                }
+            }
+            return true;
+        }
+
+    private:
+        std::ifstream mInput;
+        int mDim0, mDim1, mDim2;
+        size_t mSliceSize;
+    };
+}
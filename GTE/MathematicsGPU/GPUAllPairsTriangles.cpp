@@ -0,0 +1,567 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUAllPairsTriangles.h>
+#include <cstring>
+using namespace gte;
+
+GPUAllPairsTriangles::GPUAllPairsTriangles(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, unsigned int maxPairs, int numThreads)
+    :
+    mEngine(engine),
+    mNumThreads(numThreads),
+    mMaxPairs(maxPairs),
+    mLeafPairCapacity(0)
+{
+    LogAssert(engine != nullptr && factory != nullptr && maxPairs > 0 && numThreads > 0,
+        "Invalid argument.");
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), true);
+    mPairs = CreateBuffer(maxPairs, sizeof(std::array<int32_t, 2>));
+    mCounter = CreateBuffer(1, sizeof(uint32_t));
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numThreads);
+    mKernel = factory->CreateFromSource(api == ProgramFactory::PF_GLSL ?
+        msGLSLSource : msHLSLSource);
+    LogAssert(mKernel != nullptr, "Failed to compile shader.");
+    factory->PopDefines();
+
+    auto cshader = mKernel->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("pairs", mPairs);
+    cshader->Set("counter", mCounter);
+}
+
+unsigned int GPUAllPairsTriangles::FindIntersections(AABBTreeForTriangles<float> const& tree0,
+    AABBTreeForTriangles<float> const& tree1, std::vector<std::array<int, 2>>& pairs)
+{
+    return Execute(tree0, tree1, false, pairs);
+}
+
+unsigned int GPUAllPairsTriangles::FindSelfIntersections(AABBTreeForTriangles<float> const& tree,
+    std::vector<std::array<int, 2>>& pairs)
+{
+    return Execute(tree, tree, true, pairs);
+}
+
+unsigned int GPUAllPairsTriangles::Execute(AABBTreeForTriangles<float> const& tree0,
+    AABBTreeForTriangles<float> const& tree1, bool self,
+    std::vector<std::array<int, 2>>& pairs)
+{
+    pairs.clear();
+
+    // The broadphase is computed on the CPU.
+    tree0.FindOverlappingLeaves(tree1, self, mLeafNodePairs);
+    if (mLeafNodePairs.size() == 0)
+    {
+        return 0;
+    }
+
+    auto const& nodes0 = tree0.GetNodes();
+    auto const& nodes1 = tree1.GetNodes();
+    size_t const numLeafPairs = mLeafNodePairs.size();
+    mLeafData.resize(numLeafPairs);
+    for (size_t i = 0; i < numLeafPairs; ++i)
+    {
+        auto const& node0 = nodes0[mLeafNodePairs[i][0]];
+        auto const& node1 = nodes1[mLeafNodePairs[i][1]];
+        mLeafData[i] =
+        {
+            static_cast<int32_t>(node0.offset), static_cast<int32_t>(node0.count),
+            static_cast<int32_t>(node1.offset), static_cast<int32_t>(node1.count)
+        };
+    }
+
+    if (numLeafPairs > mLeafPairCapacity)
+    {
+        mLeafPairCapacity = static_cast<unsigned int>(numLeafPairs);
+        mLeafPairs = CreateBuffer(mLeafPairCapacity, sizeof(std::array<int32_t, 4>));
+    }
+    Upload(mLeafPairs, mLeafData.data(), numLeafPairs);
+
+    // For self-intersection, the triangles of the single mesh are bound to
+    // the buffers of both meshes.
+    UploadMesh(tree0, self, mMeshes[0]);
+    if (!self)
+    {
+        UploadMesh(tree1, false, mMeshes[1]);
+    }
+    Mesh const& mesh1 = (self ? mMeshes[0] : mMeshes[1]);
+
+    uint32_t numPairs = 0;
+    Upload(mCounter, &numPairs, 1);
+
+    auto cshader = mKernel->GetComputeShader();
+    cshader->Set("vertices0", mMeshes[0].vertices);
+    cshader->Set("order0", mMeshes[0].order);
+    cshader->Set("indices0", mMeshes[0].indices);
+    cshader->Set("vertices1", mesh1.vertices);
+    cshader->Set("order1", mesh1.order);
+    cshader->Set("leafPairs", mLeafPairs);
+
+    // The D3D11 limit on the number of thread groups per dimension is
+    // 65535, so large dispatches use rows of thread groups.
+    unsigned int const numThreads = static_cast<unsigned int>(mNumThreads);
+    unsigned int const numGroups = (static_cast<unsigned int>(numLeafPairs) + numThreads - 1) / numThreads;
+    unsigned int const numXGroups = std::min(numGroups, 4096u);
+    unsigned int const numYGroups = (numGroups + numXGroups - 1) / numXGroups;
+
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->numLeafPairs = static_cast<int32_t>(numLeafPairs);
+    parameters->maxPairs = static_cast<int32_t>(mMaxPairs);
+    parameters->selfIntersect = (self ? 1 : 0);
+    parameters->rowSize = static_cast<int32_t>(numXGroups * numThreads);
+    mEngine->Update(mParameters);
+    mEngine->Execute(mKernel, numXGroups, numYGroups, 1);
+
+    // Read back only the compacted pairs. The order in which the threads
+    // append the pairs is not deterministic, so the pairs are sorted.
+    Download(mCounter, &numPairs, 1);
+    size_t const numStored = static_cast<size_t>(std::min(numPairs, mMaxPairs));
+    if (numStored > 0)
+    {
+        pairs.resize(numStored);
+        Download(mPairs, pairs.data(), numStored);
+        std::sort(pairs.begin(), pairs.end());
+    }
+    return numPairs;
+}
+
+void GPUAllPairsTriangles::UploadMesh(AABBTreeForTriangles<float> const& tree,
+    bool uploadIndices, Mesh& mesh)
+{
+    auto const& triangles = tree.GetTriangles();
+    size_t const numTriangles = triangles.size();
+    if (numTriangles > mesh.capacity)
+    {
+        mesh.capacity = static_cast<unsigned int>(numTriangles);
+        mesh.vertices = CreateBuffer(3 * mesh.capacity, sizeof(Vector4<float>));
+        mesh.order = CreateBuffer(mesh.capacity, sizeof(int32_t));
+        mesh.indices = CreateBuffer(mesh.capacity, sizeof(std::array<int32_t, 4>));
+    }
+
+    mVertexData.resize(3 * numTriangles);
+    for (size_t t = 0; t < numTriangles; ++t)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            Vector3<float> const& V = triangles[t].v[j];
+            mVertexData[3 * t + j] = { V[0], V[1], V[2], 1.0f };
+        }
+    }
+    Upload(mesh.vertices, mVertexData.data(), mVertexData.size());
+    Upload(mesh.order, tree.GetOrder().data(), numTriangles);
+
+    if (uploadIndices)
+    {
+        auto const& indices = tree.GetIndices();
+        mIndexData.resize(numTriangles);
+        for (size_t t = 0; t < numTriangles; ++t)
+        {
+            mIndexData[t] = { indices[t][0], indices[t][1], indices[t][2], -1 };
+        }
+        Upload(mesh.indices, mIndexData.data(), numTriangles);
+    }
+}
+
+std::shared_ptr<StructuredBuffer> GPUAllPairsTriangles::CreateBuffer(unsigned int numElements,
+    size_t elementSize)
+{
+    auto buffer = std::make_shared<StructuredBuffer>(numElements, elementSize);
+    buffer->SetUsage(Resource::SHADER_OUTPUT);
+    buffer->SetCopyType(Resource::COPY_BIDIRECTIONAL);
+    return buffer;
+}
+
+void GPUAllPairsTriangles::Upload(std::shared_ptr<StructuredBuffer> const& buffer,
+    void const* data, size_t numElements)
+{
+    buffer->SetNumActiveElements(static_cast<unsigned int>(numElements));
+    std::memcpy(buffer->GetData(), data, numElements * buffer->GetElementSize());
+    mEngine->CopyCpuToGpu(buffer);
+}
+
+void GPUAllPairsTriangles::Download(std::shared_ptr<StructuredBuffer> const& buffer,
+    void* data, size_t numElements)
+{
+    buffer->SetNumActiveElements(static_cast<unsigned int>(numElements));
+    mEngine->CopyGpuToCpu(buffer);
+    std::memcpy(data, buffer->GetData(), numElements * buffer->GetElementSize());
+}
+
+
+std::string const GPUAllPairsTriangles::msGLSLSource =
+R"(
+    uniform Parameters
+    {
+        int numLeafPairs;
+        int maxPairs;
+        int selfIntersect;
+        int rowSize;
+    };
+
+    // The triangles of the meshes in leaf order, stored as triples of
+    // vertices with w-component 1, and the input indices of the triangles.
+    // The vertex indices are used only for self-intersection.
+    buffer vertices0 { vec4 data[]; } vertices0SB;
+    buffer vertices1 { vec4 data[]; } vertices1SB;
+    buffer order0 { int data[]; } order0SB;
+    buffer order1 { int data[]; } order1SB;
+    buffer indices0 { ivec4 data[]; } indices0SB;
+
+    // The leaf pairs (offset0, count0, offset1, count1) and the compacted
+    // intersecting pairs, whose number is counterSB.data[0].
+    buffer leafPairs { ivec4 data[]; } leafPairsSB;
+    buffer pairs { ivec2 data[]; } pairsSB;
+    buffer counter { uint data[]; } counterSB;
+
+    // The first input is the plane (determined by triangle U) and the
+    // second input is the triangle.
+    bool Intersects(vec3 U[3], vec3 V[3], out vec3 segment[2])
+    {
+        // Compute the plane normal for triangle U.
+        vec3 normal = normalize(cross(U[1] - U[0], U[2] - U[0]));
+
+        // Test whether the edges of triangle V transversely intersect the
+        // plane of triangle U.
+        float d[3];
+        int positive = 0, negative = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            d[i] = dot(normal, V[i] - U[0]);
+            if (d[i] > 0.0f)
+            {
+                ++positive;
+            }
+            else if (d[i] < 0.0f)
+            {
+                ++negative;
+            }
+        }
+
+        if (positive == 0 || negative == 0)
+        {
+            // Triangle V does not transversely intersect triangle U,
+            // although it is possible a vertex or edge of V is just
+            // touching U. In this case, we do not call this an
+            // intersection.
+            return false;
+        }
+
+        // The vertex i0 is the one on the side of the plane opposite the
+        // other two vertices or, when one vertex is on the plane, the
+        // vertex on the plane.
+        int i0;
+        if (positive == 2 || negative == 2)
+        {
+            i0 = ((positive == 2) == (d[0] < 0.0f) ? 0 : ((positive == 2) == (d[1] < 0.0f) ? 1 : 2));
+        }
+        else
+        {
+            i0 = (d[0] == 0.0f ? 0 : (d[1] == 0.0f ? 1 : 2));
+        }
+        int i1 = (i0 + 1) % 3, i2 = (i0 + 2) % 3;
+        if (d[i0] != 0.0f)
+        {
+            segment[0] = (d[i1] * V[i0] - d[i0] * V[i1]) / (d[i1] - d[i0]);
+            segment[1] = (d[i2] * V[i0] - d[i0] * V[i2]) / (d[i2] - d[i0]);
+        }
+        else
+        {
+            segment[0] = V[i0];
+            segment[1] = (d[i2] * V[i1] - d[i1] * V[i2]) / (d[i2] - d[i1]);
+        }
+        return true;
+    }
+
+    bool TrianglesIntersect(vec3 U[3], vec3 V[3])
+    {
+        vec3 S0[2], S1[2];
+        if (Intersects(V, U, S0) && Intersects(U, V, S1))
+        {
+            // Theoretically, the segments lie on the same line. A direction
+            // D of the line is Cross(NormalOf(U),NormalOf(V)). The average
+            // A of the segment endpoints is the line origin.
+            vec3 uNormal = cross(U[1] - U[0], U[2] - U[0]);
+            vec3 vNormal = cross(V[1] - V[0], V[2] - V[0]);
+            vec3 D = normalize(cross(uNormal, vNormal));
+            vec3 A = 0.25f * (S0[0] + S0[1] + S1[0] + S1[1]);
+
+            // The segments intersect when their intervals of t-values of
+            // A + t * D overlap.
+            float t00 = dot(D, S0[0] - A), t01 = dot(D, S0[1] - A);
+            float t10 = dot(D, S1[0] - A), t11 = dot(D, S1[1] - A);
+            return max(t00, t01) > min(t10, t11) && min(t00, t01) < max(t10, t11);
+        }
+        return false;
+    }
+
+    bool BoxesOverlap(vec3 U[3], vec3 V[3])
+    {
+        vec3 uMin = min(min(U[0], U[1]), U[2]), uMax = max(max(U[0], U[1]), U[2]);
+        vec3 vMin = min(min(V[0], V[1]), V[2]), vMax = max(max(V[0], V[1]), V[2]);
+        return all(lessThanEqual(uMin, vMax)) && all(lessThanEqual(vMin, uMax));
+    }
+
+    bool ShareVertex(ivec4 u, ivec4 v)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (u[i] == v[0] || u[i] == v[1] || u[i] == v[2])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int p = int(gl_GlobalInvocationID.x) + rowSize * int(gl_GlobalInvocationID.y);
+        if (p >= numLeafPairs)
+        {
+            return;
+        }
+
+        // For self-intersection, the distinct triangles of a leaf paired
+        // with itself are tested once.
+        ivec4 leafPair = leafPairsSB.data[p];
+        bool diagonal = (selfIntersect != 0 && leafPair.x == leafPair.z);
+        for (int k0 = leafPair.x; k0 < leafPair.x + leafPair.y; ++k0)
+        {
+            vec3 U[3];
+            for (int j = 0; j < 3; ++j)
+            {
+                U[j] = vertices0SB.data[3 * k0 + j].xyz;
+            }
+
+            for (int k1 = (diagonal ? k0 + 1 : leafPair.z); k1 < leafPair.z + leafPair.w; ++k1)
+            {
+                if (selfIntersect != 0 && ShareVertex(indices0SB.data[k0], indices0SB.data[k1]))
+                {
+                    continue;
+                }
+
+                vec3 V[3];
+                for (int j = 0; j < 3; ++j)
+                {
+                    V[j] = vertices1SB.data[3 * k1 + j].xyz;
+                }
+
+                if (BoxesOverlap(U, V) && TrianglesIntersect(U, V))
+                {
+                    int t0 = order0SB.data[k0], t1 = order1SB.data[k1];
+                    if (selfIntersect != 0 && t0 > t1)
+                    {
+                        int save = t0;
+                        t0 = t1;
+                        t1 = save;
+                    }
+
+                    uint i = atomicAdd(counterSB.data[0], 1u);
+                    if (i < uint(maxPairs))
+                    {
+                        pairsSB.data[i] = ivec2(t0, t1);
+                    }
+                }
+            }
+        }
+    }
+)";
+
+std::string const GPUAllPairsTriangles::msHLSLSource =
+R"(
+    cbuffer Parameters
+    {
+        int numLeafPairs;
+        int maxPairs;
+        int selfIntersect;
+        int rowSize;
+    };
+
+    // The triangles of the meshes in leaf order, stored as triples of
+    // vertices with w-component 1, and the input indices of the triangles.
+    // The vertex indices are used only for self-intersection.
+    StructuredBuffer<float4> vertices0;
+    StructuredBuffer<float4> vertices1;
+    StructuredBuffer<int> order0;
+    StructuredBuffer<int> order1;
+    StructuredBuffer<int4> indices0;
+
+    // The leaf pairs (offset0, count0, offset1, count1) and the compacted
+    // intersecting pairs, whose number is counter[0].
+    StructuredBuffer<int4> leafPairs;
+    RWStructuredBuffer<int2> pairs;
+    RWStructuredBuffer<uint> counter;
+
+    // The first input is the plane (determined by triangle U) and the
+    // second input is the triangle.
+    bool Intersects(float3 U[3], float3 V[3], out float3 segment[2])
+    {
+        // Compute the plane normal for triangle U.
+        float3 normal = normalize(cross(U[1] - U[0], U[2] - U[0]));
+
+        // Test whether the edges of triangle V transversely intersect the
+        // plane of triangle U.
+        float d[3];
+        int positive = 0, negative = 0;
+        [unroll]
+        for (int i = 0; i < 3; ++i)
+        {
+            d[i] = dot(normal, V[i] - U[0]);
+            if (d[i] > 0.0f)
+            {
+                ++positive;
+            }
+            else if (d[i] < 0.0f)
+            {
+                ++negative;
+            }
+        }
+
+        segment[0] = V[0];
+        segment[1] = V[0];
+        if (positive == 0 || negative == 0)
+        {
+            // Triangle V does not transversely intersect triangle U,
+            // although it is possible a vertex or edge of V is just
+            // touching U. In this case, we do not call this an
+            // intersection.
+            return false;
+        }
+
+        // The vertex i0 is the one on the side of the plane opposite the
+        // other two vertices or, when one vertex is on the plane, the
+        // vertex on the plane.
+        int i0;
+        if (positive == 2 || negative == 2)
+        {
+            i0 = ((positive == 2) == (d[0] < 0.0f) ? 0 : ((positive == 2) == (d[1] < 0.0f) ? 1 : 2));
+        }
+        else
+        {
+            i0 = (d[0] == 0.0f ? 0 : (d[1] == 0.0f ? 1 : 2));
+        }
+        int i1 = (i0 + 1) % 3, i2 = (i0 + 2) % 3;
+        if (d[i0] != 0.0f)
+        {
+            segment[0] = (d[i1] * V[i0] - d[i0] * V[i1]) / (d[i1] - d[i0]);
+            segment[1] = (d[i2] * V[i0] - d[i0] * V[i2]) / (d[i2] - d[i0]);
+        }
+        else
+        {
+            segment[0] = V[i0];
+            segment[1] = (d[i2] * V[i1] - d[i1] * V[i2]) / (d[i2] - d[i1]);
+        }
+        return true;
+    }
+
+    bool TrianglesIntersect(float3 U[3], float3 V[3])
+    {
+        float3 S0[2], S1[2];
+        if (Intersects(V, U, S0) && Intersects(U, V, S1))
+        {
+            // Theoretically, the segments lie on the same line. A direction
+            // D of the line is Cross(NormalOf(U),NormalOf(V)). The average
+            // A of the segment endpoints is the line origin.
+            float3 uNormal = cross(U[1] - U[0], U[2] - U[0]);
+            float3 vNormal = cross(V[1] - V[0], V[2] - V[0]);
+            float3 D = normalize(cross(uNormal, vNormal));
+            float3 A = 0.25f * (S0[0] + S0[1] + S1[0] + S1[1]);
+
+            // The segments intersect when their intervals of t-values of
+            // A + t * D overlap.
+            float t00 = dot(D, S0[0] - A), t01 = dot(D, S0[1] - A);
+            float t10 = dot(D, S1[0] - A), t11 = dot(D, S1[1] - A);
+            return max(t00, t01) > min(t10, t11) && min(t00, t01) < max(t10, t11);
+        }
+        return false;
+    }
+
+    bool BoxesOverlap(float3 U[3], float3 V[3])
+    {
+        float3 uMin = min(min(U[0], U[1]), U[2]), uMax = max(max(U[0], U[1]), U[2]);
+        float3 vMin = min(min(V[0], V[1]), V[2]), vMax = max(max(V[0], V[1]), V[2]);
+        return all(uMin <= vMax) && all(vMin <= uMax);
+    }
+
+    bool ShareVertex(int4 u, int4 v)
+    {
+        [unroll]
+        for (int i = 0; i < 3; ++i)
+        {
+            if (u[i] == v[0] || u[i] == v[1] || u[i] == v[2])
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int p = int(dt.x) + rowSize * int(dt.y);
+        if (p >= numLeafPairs)
+        {
+            return;
+        }
+
+        // For self-intersection, the distinct triangles of a leaf paired
+        // with itself are tested once.
+        int4 leafPair = leafPairs[p];
+        bool diagonal = (selfIntersect != 0 && leafPair.x == leafPair.z);
+        [loop]
+        for (int k0 = leafPair.x; k0 < leafPair.x + leafPair.y; ++k0)
+        {
+            float3 U[3];
+            [unroll]
+            for (int j = 0; j < 3; ++j)
+            {
+                U[j] = vertices0[3 * k0 + j].xyz;
+            }
+
+            [loop]
+            for (int k1 = (diagonal ? k0 + 1 : leafPair.z); k1 < leafPair.z + leafPair.w; ++k1)
+            {
+                if (selfIntersect != 0 && ShareVertex(indices0[k0], indices0[k1]))
+                {
+                    continue;
+                }
+
+                float3 V[3];
+                [unroll]
+                for (int j = 0; j < 3; ++j)
+                {
+                    V[j] = vertices1[3 * k1 + j].xyz;
+                }
+
+                if (BoxesOverlap(U, V) && TrianglesIntersect(U, V))
+                {
+                    int t0 = order0[k0], t1 = order1[k1];
+                    if (selfIntersect != 0 && t0 > t1)
+                    {
+                        int save = t0;
+                        t0 = t1;
+                        t1 = save;
+                    }
+
+                    uint i;
+                    InterlockedAdd(counter[0], 1u, i);
+                    if (i < uint(maxPairs))
+                    {
+                        pairs[i] = int2(t0, t1);
+                    }
+                }
+            }
+        }
+    }
+)";
@@ -0,0 +1,139 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/AABBTreeOfTriangles.h>
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+
+// A GPU-based search for the pairs of intersecting triangles of two meshes,
+// or of one mesh with itself, using DX11/HLSL or GL45/GLSL. It is the
+// library version of the sample Samples/Intersection/AllPairsTriangles,
+// which tests all pairs of triangles. Testing all pairs is not practical
+// for large meshes, so the broadphase is that of AABBTreeForTriangles.
+//   1. The pairs of leaves of the trees whose boxes overlap are computed on
+//      the CPU by AABBTreeForTriangles::FindOverlappingLeaves.
+//   2. A compute shader has one thread per leaf pair, which tests the
+//      triangle pairs of the leaves. A triangle pair whose bounding boxes
+//      overlap is tested for intersection by the test of the sample.
+//   3. The intersecting pairs are compacted by appending them to a
+//      structured buffer at indices obtained by an atomic increment of a
+//      counter, so only the counter and the intersecting pairs are read
+//      back.
+// The CPU version of the search is AABBTreeForTriangles::FindIntersections
+// and AABBTreeForTriangles::FindSelfIntersections, which use the TIQuery
+// for Triangle3 and Triangle3. The pairs are reported in the same format,
+// but the test of the shader is that of the sample, which reports only
+// transverse intersections in 'float' arithmetic; that is, coplanar
+// triangles and triangles that only touch do not intersect. As in the CPU
+// version, the pairs of triangles of a single mesh that share a vertex are
+// not tested.
+//
+// The GPU buffers are reused by later calls with at most as many triangles
+// and leaf pairs, so a single object should be used for a sequence of
+// meshes.
+
+namespace gte
+{
+    class GPUAllPairsTriangles
+    {
+    public:
+        // Construction. At most maxPairs intersecting pairs are stored. The
+        // kernel is dispatched with 1D thread groups of numThreads threads.
+        GPUAllPairsTriangles(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            unsigned int maxPairs, int numThreads = 64);
+
+        ~GPUAllPairsTriangles() = default;
+
+        // Find the pairs (i,j) of intersecting triangles, where i is a
+        // triangle of the first mesh and j is a triangle of the second
+        // mesh. The pairs are sorted. The return value is the number of
+        // intersecting pairs, which is larger than the number of stored
+        // pairs when it exceeds maxPairs.
+        unsigned int FindIntersections(AABBTreeForTriangles<float> const& tree0,
+            AABBTreeForTriangles<float> const& tree1,
+            std::vector<std::array<int, 2>>& pairs);
+
+        // Find the pairs (i,j), i < j, of intersecting triangles of the
+        // mesh that do not share a vertex. The pairs are sorted and the
+        // return value is that of FindIntersections.
+        unsigned int FindSelfIntersections(AABBTreeForTriangles<float> const& tree,
+            std::vector<std::array<int, 2>>& pairs);
+
+    private:
+        // The layout of the constant buffer "Parameters".
+        struct Parameters
+        {
+            int32_t numLeafPairs;
+            int32_t maxPairs;
+            int32_t selfIntersect;
+            int32_t rowSize;
+        };
+
+        // The buffers of the triangles of a tree in leaf order: three
+        // vertices per triangle, the input index of each triangle and, for
+        // self-intersection, the vertex indices of each triangle. The
+        // buffers are allocated for 'capacity' triangles.
+        struct Mesh
+        {
+            Mesh()
+                :
+                capacity(0)
+            {
+            }
+
+            unsigned int capacity;
+            std::shared_ptr<StructuredBuffer> vertices;
+            std::shared_ptr<StructuredBuffer> order;
+            std::shared_ptr<StructuredBuffer> indices;
+        };
+
+        unsigned int Execute(AABBTreeForTriangles<float> const& tree0,
+            AABBTreeForTriangles<float> const& tree1, bool self,
+            std::vector<std::array<int, 2>>& pairs);
+
+        void UploadMesh(AABBTreeForTriangles<float> const& tree, bool uploadIndices,
+            Mesh& mesh);
+
+        std::shared_ptr<StructuredBuffer> CreateBuffer(unsigned int numElements,
+            size_t elementSize);
+
+        void Upload(std::shared_ptr<StructuredBuffer> const& buffer,
+            void const* data, size_t numElements);
+
+        void Download(std::shared_ptr<StructuredBuffer> const& buffer,
+            void* data, size_t numElements);
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        int mNumThreads;
+        unsigned int mMaxPairs;
+        std::shared_ptr<ComputeProgram> mKernel;
+        std::shared_ptr<ConstantBuffer> mParameters;
+        std::array<Mesh, 2> mMeshes;
+
+        // The leaf pairs are stored as (offset0, count0, offset1, count1)
+        // and the buffer is allocated for mLeafPairCapacity pairs.
+        unsigned int mLeafPairCapacity;
+        std::shared_ptr<StructuredBuffer> mLeafPairs;
+        std::shared_ptr<StructuredBuffer> mPairs;
+        std::shared_ptr<StructuredBuffer> mCounter;
+
+        // Scratch storage for the uploads.
+        std::vector<std::array<uint32_t, 2>> mLeafNodePairs;
+        std::vector<std::array<int32_t, 4>> mLeafData;
+        std::vector<Vector4<float>> mVertexData;
+        std::vector<std::array<int32_t, 4>> mIndexData;
+
+        // Shader source code as strings.
+        static std::string const msGLSLSource;
+        static std::string const msHLSLSource;
+    };
+}
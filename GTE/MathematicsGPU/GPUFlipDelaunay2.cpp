@@ -0,0 +1,1139 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUFlipDelaunay2.h>
+#include <cstring>
+using namespace gte;
+
+GPUFlipDelaunay2::GPUFlipDelaunay2(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, int maxFlipPasses, int numThreads)
+    :
+    FlipDelaunay2(maxFlipPasses),
+    mEngine(engine),
+    mNumThreads(numThreads),
+    mCapacity(0)
+{
+    LogAssert(engine != nullptr && factory != nullptr && numThreads > 0,
+        "Invalid argument.");
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), true);
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numThreads);
+    for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+    {
+        std::string source;
+        if (api == ProgramFactory::PF_GLSL)
+        {
+            source = msGLSLCommonSource;
+            if (msUsesPredicates[kernel])
+            {
+                source += msGLSLPredicateSource;
+            }
+            source += msGLSLKernelSource[kernel];
+        }
+        else  // api == ProgramFactory::PF_HLSL
+        {
+            source = msHLSLCommonSource;
+            if (msUsesPredicates[kernel])
+            {
+                source += msHLSLPredicateSource;
+            }
+            source += msHLSLKernelSource[kernel];
+        }
+
+        mKernels[kernel] = factory->CreateFromSource(source);
+        LogAssert(mKernels[kernel] != nullptr, "Failed to compile shader.");
+        mKernels[kernel]->GetComputeShader()->Set("Parameters", mParameters);
+    }
+    factory->PopDefines();
+}
+
+void GPUFlipDelaunay2::InsertPoints()
+{
+    CreateBuffers();
+
+    size_t const numPoints = static_cast<size_t>(mNumPoints);
+    size_t const capacity = mTriangles.size();
+    Upload(mPointBuffer, mPoints, numPoints);
+    Upload(mTriangleBuffer, mTriangles.data(), capacity);
+    Upload(mAdjacentBuffer, mAdjacent.data(), capacity);
+    Upload(mEventBuffer, mEvents.data(), capacity);
+    Upload(mVoteBuffer, mVotes.data(), capacity);
+    Upload(mLockBuffer, mLocks.data(), capacity);
+    Upload(mLocationBuffer, mLocations.data(), numPoints);
+    Upload(mNeighborBuffer, mNeighbors.data(), numPoints);
+    std::array<uint32_t, 4> counters = { static_cast<uint32_t>(mNumTriangles), 0, 0, 0 };
+    Upload(mCounterBuffer, counters.data(), counters.size());
+
+    // The counters are the number of triangles, the number of splits and
+    // the number of flips. The last two are cumulative.
+    uint32_t numSplits = 0, numFlips = 0;
+    int32_t stamp = 0;
+    for (;;)
+    {
+        Execute(VOTE, mNumPoints, mNumTriangles, stamp);
+        Execute(SPLIT, mNumTriangles, mNumTriangles, stamp);
+        counters = GetCounters();
+        if (counters[1] == numSplits)
+        {
+            break;
+        }
+        numSplits = counters[1];
+        mNumTriangles = static_cast<int32_t>(counters[0]);
+
+        Execute(UPDATE_ADJACENT, mNumTriangles, mNumTriangles, stamp);
+        Execute(RELOCATE, mNumPoints, mNumTriangles, stamp);
+        ++stamp;
+
+        for (int pass = 0; pass < mMaxFlipPasses; ++pass)
+        {
+            Execute(MARK_FLIP, mNumTriangles, mNumTriangles, stamp);
+            Execute(FLIP, mNumTriangles, mNumTriangles, stamp);
+            counters = GetCounters();
+            if (counters[2] == numFlips)
+            {
+                break;
+            }
+            numFlips = counters[2];
+
+            Execute(UPDATE_ADJACENT, mNumTriangles, mNumTriangles, stamp);
+            Execute(RELOCATE, mNumPoints, mNumTriangles, stamp);
+            ++stamp;
+        }
+    }
+
+    // The fix-up pass needs only the triangles, their adjacencies and the
+    // point locations.
+    size_t const numTriangles = static_cast<size_t>(mNumTriangles);
+    Download(mTriangleBuffer, mTriangles.data(), numTriangles);
+    Download(mAdjacentBuffer, mAdjacent.data(), numTriangles);
+    Download(mLocationBuffer, mLocations.data(), numPoints);
+}
+
+void GPUFlipDelaunay2::CreateBuffers()
+{
+    if (mNumPoints <= mCapacity)
+    {
+        return;
+    }
+
+    mCapacity = mNumPoints;
+    unsigned int const numPoints = static_cast<unsigned int>(mCapacity);
+    unsigned int const numTriangles = 2 * numPoints;
+    auto create = [](unsigned int numElements, size_t elementSize)
+    {
+        auto buffer = std::make_shared<StructuredBuffer>(numElements, elementSize);
+        buffer->SetUsage(Resource::SHADER_OUTPUT);
+        buffer->SetCopyType(Resource::COPY_BIDIRECTIONAL);
+        return buffer;
+    };
+
+    mPointBuffer = create(numPoints, sizeof(Vector2<float>));
+    mTriangleBuffer = create(numTriangles, sizeof(std::array<int32_t, 4>));
+    mAdjacentBuffer = create(numTriangles, sizeof(std::array<int32_t, 4>));
+    mEventBuffer = create(numTriangles, sizeof(std::array<int32_t, 4>));
+    mVoteBuffer = create(numTriangles, sizeof(uint32_t));
+    mLockBuffer = create(numTriangles, sizeof(uint32_t));
+    mLocationBuffer = create(numPoints, sizeof(int32_t));
+    mNeighborBuffer = create(numPoints, sizeof(int32_t));
+    mCounterBuffer = create(4, sizeof(uint32_t));
+
+    // Each kernel is bound to the buffers that its shader uses.
+    auto cshader = mKernels[VOTE]->GetComputeShader();
+    cshader->Set("points", mPointBuffer);
+    cshader->Set("triangles", mTriangleBuffer);
+    cshader->Set("adjacent", mAdjacentBuffer);
+    cshader->Set("votes", mVoteBuffer);
+    cshader->Set("locations", mLocationBuffer);
+    cshader->Set("neighbors", mNeighborBuffer);
+
+    cshader = mKernels[SPLIT]->GetComputeShader();
+    cshader->Set("points", mPointBuffer);
+    cshader->Set("triangles", mTriangleBuffer);
+    cshader->Set("adjacent", mAdjacentBuffer);
+    cshader->Set("events", mEventBuffer);
+    cshader->Set("votes", mVoteBuffer);
+    cshader->Set("locations", mLocationBuffer);
+    cshader->Set("neighbors", mNeighborBuffer);
+    cshader->Set("counters", mCounterBuffer);
+
+    cshader = mKernels[UPDATE_ADJACENT]->GetComputeShader();
+    cshader->Set("triangles", mTriangleBuffer);
+    cshader->Set("adjacent", mAdjacentBuffer);
+    cshader->Set("events", mEventBuffer);
+    cshader->Set("votes", mVoteBuffer);
+    cshader->Set("locks", mLockBuffer);
+
+    cshader = mKernels[RELOCATE]->GetComputeShader();
+    cshader->Set("points", mPointBuffer);
+    cshader->Set("triangles", mTriangleBuffer);
+    cshader->Set("events", mEventBuffer);
+    cshader->Set("locations", mLocationBuffer);
+
+    cshader = mKernels[MARK_FLIP]->GetComputeShader();
+    cshader->Set("points", mPointBuffer);
+    cshader->Set("triangles", mTriangleBuffer);
+    cshader->Set("adjacent", mAdjacentBuffer);
+    cshader->Set("locks", mLockBuffer);
+
+    cshader = mKernels[FLIP]->GetComputeShader();
+    cshader->Set("triangles", mTriangleBuffer);
+    cshader->Set("adjacent", mAdjacentBuffer);
+    cshader->Set("events", mEventBuffer);
+    cshader->Set("locks", mLockBuffer);
+    cshader->Set("counters", mCounterBuffer);
+}
+
+void GPUFlipDelaunay2::Upload(std::shared_ptr<StructuredBuffer> const& buffer,
+    void const* data, size_t numElements)
+{
+    buffer->SetNumActiveElements(static_cast<unsigned int>(numElements));
+    std::memcpy(buffer->GetData(), data, numElements * buffer->GetElementSize());
+    mEngine->CopyCpuToGpu(buffer);
+}
+
+void GPUFlipDelaunay2::Download(std::shared_ptr<StructuredBuffer> const& buffer,
+    void* data, size_t numElements)
+{
+    buffer->SetNumActiveElements(static_cast<unsigned int>(numElements));
+    mEngine->CopyGpuToCpu(buffer);
+    std::memcpy(data, buffer->GetData(), numElements * buffer->GetElementSize());
+}
+
+std::array<uint32_t, 4> GPUFlipDelaunay2::GetCounters()
+{
+    std::array<uint32_t, 4> counters;
+    Download(mCounterBuffer, counters.data(), counters.size());
+    return counters;
+}
+
+void GPUFlipDelaunay2::Execute(int kernel, int32_t numElements, int32_t numTriangles,
+    int32_t stamp)
+{
+    // The D3D11 limit on the number of thread groups per dimension is
+    // 65535, so large dispatches use rows of thread groups.
+    unsigned int const numThreads = static_cast<unsigned int>(mNumThreads);
+    unsigned int const numGroups = (static_cast<unsigned int>(numElements) + numThreads - 1) / numThreads;
+    unsigned int const numXGroups = std::min(numGroups, 4096u);
+    unsigned int const numYGroups = (numGroups + numXGroups - 1) / numXGroups;
+
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->numPoints = mNumPoints;
+    parameters->numTriangles = numTriangles;
+    parameters->stamp = stamp;
+    parameters->exactOrient = (mExactOrient ? 1 : 0);
+    parameters->rowSize = static_cast<int32_t>(numXGroups * numThreads);
+    mEngine->Update(mParameters);
+    mEngine->Execute(mKernels[kernel], numXGroups, numYGroups, 1);
+}
+
+
+std::string const GPUFlipDelaunay2::msGLSLCommonSource =
+R"(
+    uniform Parameters
+    {
+        int numPoints;
+        int numTriangles;
+        int stamp;
+        int exactOrient;
+        int rowSize;
+        int padding0, padding1, padding2;
+    };
+
+    // The vertices of triangle t and the unused component -1.
+    buffer triangles { ivec4 data[]; } trianglesSB;
+
+    int GetIndex()
+    {
+        return int(gl_GlobalInvocationID.x) + rowSize * int(gl_GlobalInvocationID.y);
+    }
+
+    int GetEdge(int t, int a, int b)
+    {
+        ivec4 tri = trianglesSB.data[t];
+        for (int j = 0; j < 3; ++j)
+        {
+            if (tri[j] == a && tri[(j + 1) % 3] == b)
+            {
+                return j;
+            }
+        }
+        return -1;
+    }
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = 1, local_size_z = 1) in;
+)";
+
+std::string const GPUFlipDelaunay2::msGLSLPredicateSource =
+R"(
+    buffer points { vec2 data[]; } pointsSB;
+
+    double Abs(double x)
+    {
+        return (x >= 0.0lf ? x : -x);
+    }
+
+    // The floating-point filters of FlipDelaunay2::Orient and
+    // FlipDelaunay2::InCircle. The error bound coefficients are slightly
+    // larger than (3+16u)u and (10+96u)u for u = 2^{-53}.
+    int Orient(int v0, int v1, int p)
+    {
+        dvec2 P0 = dvec2(pointsSB.data[v0]);
+        dvec2 P1 = dvec2(pointsSB.data[v1]);
+        dvec2 P = dvec2(pointsSB.data[p]);
+        precise double x1 = P1.x - P0.x, y1 = P1.y - P0.y;
+        precise double x2 = P.x - P0.x, y2 = P.y - P0.y;
+        precise double x1y2 = x1 * y2, x2y1 = x2 * y1;
+        precise double det = x1y2 - x2y1;
+        if (exactOrient != 0)
+        {
+            return (det > 0.0lf ? 1 : (det < 0.0lf ? -1 : 0));
+        }
+        double errorBound = 3.3306690738754720e-16lf * (Abs(x1y2) + Abs(x2y1));
+        return (det > errorBound ? 1 : (-det > errorBound ? -1 : 0));
+    }
+
+    int InCircle(int v0, int v1, int v2, int p)
+    {
+        dvec2 P = dvec2(pointsSB.data[p]);
+        dvec2 P0 = dvec2(pointsSB.data[v0]);
+        dvec2 P1 = dvec2(pointsSB.data[v1]);
+        dvec2 P2 = dvec2(pointsSB.data[v2]);
+        precise double x0 = P0.x - P.x, y0 = P0.y - P.y;
+        precise double x1 = P1.x - P.x, y1 = P1.y - P.y;
+        precise double x2 = P2.x - P.x, y2 = P2.y - P.y;
+        precise double x1y2 = x1 * y2, x2y1 = x2 * y1;
+        precise double x2y0 = x2 * y0, x0y2 = x0 * y2;
+        precise double x0y1 = x0 * y1, x1y0 = x1 * y0;
+        precise double lift0 = x0 * x0 + y0 * y0;
+        precise double lift1 = x1 * x1 + y1 * y1;
+        precise double lift2 = x2 * x2 + y2 * y2;
+        precise double det =
+            lift0 * (x1y2 - x2y1) +
+            lift1 * (x2y0 - x0y2) +
+            lift2 * (x0y1 - x1y0);
+        precise double permanent =
+            (Abs(x1y2) + Abs(x2y1)) * lift0 +
+            (Abs(x2y0) + Abs(x0y2)) * lift1 +
+            (Abs(x0y1) + Abs(x1y0)) * lift2;
+        double errorBound = 1.1102230246251580e-15lf * permanent;
+        return (det > errorBound ? 1 : (-det > errorBound ? -1 : 0));
+    }
+)";
+
+std::array<std::string, GPUFlipDelaunay2::NUM_KERNELS> const GPUFlipDelaunay2::msGLSLKernelSource =
+{
+// VOTE
+R"(
+    buffer adjacent { ivec4 data[]; } adjacentSB;
+    buffer votes { uint data[]; } votesSB;
+    buffer locations { int data[]; } locationsSB;
+    buffer neighbors { int data[]; } neighborsSB;
+
+    void main()
+    {
+        int p = GetIndex();
+        if (p >= numPoints)
+        {
+            return;
+        }
+
+        int t = locationsSB.data[p];
+        if (t < 0)
+        {
+            return;
+        }
+
+        ivec4 tri = trianglesSB.data[t];
+        int numPositive = 0, zero = -1;
+        for (int j = 0; j < 3; ++j)
+        {
+            int sign = Orient(tri[j], tri[(j + 1) % 3], p);
+            if (sign > 0)
+            {
+                ++numPositive;
+            }
+            else if (sign == 0 && exactOrient != 0)
+            {
+                zero = j;
+            }
+        }
+
+        uint key = (uint(p) * 0x9E3779B1u) & 0x7FFFFFFFu;
+        if (numPositive == 3)
+        {
+            neighborsSB.data[p] = -1;
+            atomicMin(votesSB.data[t], key);
+        }
+        else if (numPositive == 2 && zero >= 0)
+        {
+            int n = adjacentSB.data[t][zero];
+            neighborsSB.data[p] = n;
+            key |= 0x80000000u;
+            atomicMin(votesSB.data[t], key);
+            if (n >= 0)
+            {
+                atomicMin(votesSB.data[n], key);
+            }
+        }
+    }
+)",
+
+// SPLIT
+R"(
+    buffer adjacent { ivec4 data[]; } adjacentSB;
+    buffer events { ivec4 data[]; } eventsSB;
+    buffer votes { uint data[]; } votesSB;
+    buffer locations { int data[]; } locationsSB;
+    buffer neighbors { int data[]; } neighborsSB;
+    buffer counters { uint data[]; } countersSB;
+
+    void SplitEdge(int t, int j, int q)
+    {
+        ivec4 tri = trianglesSB.data[t];
+        ivec4 adj = adjacentSB.data[t];
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        int a = tri[j], b = tri[j1], c = tri[j2];
+        int adjBC = adj[j1], adjCA = adj[j2];
+        int n = adj[j];
+        int s;
+        if (n >= 0)
+        {
+            s = int(atomicAdd(countersSB.data[0], 2u));
+            int m = s + 1;
+            int k = GetEdge(n, b, a);
+            ivec4 ntri = trianglesSB.data[n];
+            ivec4 nadj = adjacentSB.data[n];
+            int d = ntri[(k + 2) % 3];
+            int adjAD = nadj[(k + 1) % 3];
+            int adjDB = nadj[(k + 2) % 3];
+            trianglesSB.data[n] = ivec4(b, q, d, -1);
+            trianglesSB.data[m] = ivec4(q, a, d, -1);
+            adjacentSB.data[n] = ivec4(s, m, adjDB, -1);
+            adjacentSB.data[m] = ivec4(t, adjAD, n, -1);
+            adjacentSB.data[t] = ivec4(m, s, adjCA, -1);
+            adjacentSB.data[s] = ivec4(n, adjBC, t, -1);
+            eventsSB.data[n] = ivec4(stamp, m, -1, q);
+        }
+        else
+        {
+            s = int(atomicAdd(countersSB.data[0], 1u));
+            adjacentSB.data[t] = ivec4(-1, s, adjCA, -1);
+            adjacentSB.data[s] = ivec4(-1, adjBC, t, -1);
+        }
+        trianglesSB.data[t] = ivec4(a, q, c, -1);
+        trianglesSB.data[s] = ivec4(q, b, c, -1);
+        eventsSB.data[t] = ivec4(stamp, s, -1, q);
+    }
+
+    void main()
+    {
+        int t = GetIndex();
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        uint key = votesSB.data[t];
+        if (key == 0xFFFFFFFFu)
+        {
+            return;
+        }
+
+        int q = int((key * 0x0E8B2F51u) & 0x7FFFFFFFu);
+        int neighbor = neighborsSB.data[q];
+        if (neighbor >= 0)
+        {
+            int location = locationsSB.data[q];
+            int other = (location == t ? neighbor : location);
+            if (other < t || votesSB.data[other] != key)
+            {
+                return;
+            }
+            ivec4 adj = adjacentSB.data[t];
+            int j = (adj[0] == other ? 0 : (adj[1] == other ? 1 : 2));
+            SplitEdge(t, j, q);
+            atomicAdd(countersSB.data[1], 1u);
+            return;
+        }
+
+        ivec4 tri = trianglesSB.data[t];
+        if (exactOrient != 0)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                if (Orient(tri[j], tri[(j + 1) % 3], q) == 0)
+                {
+                    SplitEdge(t, j, q);
+                    atomicAdd(countersSB.data[1], 1u);
+                    return;
+                }
+            }
+        }
+
+        int s1 = int(atomicAdd(countersSB.data[0], 2u));
+        int s2 = s1 + 1;
+        ivec4 adj = adjacentSB.data[t];
+        trianglesSB.data[t] = ivec4(tri[0], tri[1], q, -1);
+        trianglesSB.data[s1] = ivec4(tri[1], tri[2], q, -1);
+        trianglesSB.data[s2] = ivec4(tri[2], tri[0], q, -1);
+        adjacentSB.data[t] = ivec4(adj[0], s1, s2, -1);
+        adjacentSB.data[s1] = ivec4(adj[1], s2, t, -1);
+        adjacentSB.data[s2] = ivec4(adj[2], t, s1, -1);
+        eventsSB.data[t] = ivec4(stamp, s1, s2, q);
+        atomicAdd(countersSB.data[1], 1u);
+    }
+)",
+
+// UPDATE_ADJACENT
+R"(
+    buffer adjacent { ivec4 data[]; } adjacentSB;
+    buffer events { ivec4 data[]; } eventsSB;
+    buffer votes { uint data[]; } votesSB;
+    buffer locks { uint data[]; } locksSB;
+
+    void main()
+    {
+        int t = GetIndex();
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        votesSB.data[t] = 0xFFFFFFFFu;
+        locksSB.data[t] = 0xFFFFFFFFu;
+        ivec4 tri = trianglesSB.data[t];
+        ivec4 adj = adjacentSB.data[t];
+        for (int j = 0; j < 3; ++j)
+        {
+            int m = adj[j];
+            if (m >= 0)
+            {
+                int a = tri[j], b = tri[(j + 1) % 3];
+                ivec4 event = eventsSB.data[m];
+                if (event[0] == stamp && GetEdge(m, b, a) < 0)
+                {
+                    adj[j] = (GetEdge(event[1], b, a) >= 0 ? event[1] : event[2]);
+                }
+            }
+        }
+        adjacentSB.data[t] = adj;
+    }
+)",
+
+// RELOCATE
+R"(
+    buffer events { ivec4 data[]; } eventsSB;
+    buffer locations { int data[]; } locationsSB;
+
+    void main()
+    {
+        int p = GetIndex();
+        if (p >= numPoints)
+        {
+            return;
+        }
+
+        int t = locationsSB.data[p];
+        if (t < 0)
+        {
+            return;
+        }
+
+        ivec4 event = eventsSB.data[t];
+        if (event[0] != stamp)
+        {
+            return;
+        }
+
+        int q = event[3];
+        int location;
+        if (q == p)
+        {
+            location = -1;
+        }
+        else if (q < 0)
+        {
+            int owner = min(t, event[1]);
+            int other = max(t, event[1]);
+            ivec4 tri = trianglesSB.data[owner];
+            location = (Orient(tri[2], tri[0], p) >= 0 ? owner : other);
+        }
+        else if (event[2] >= 0)
+        {
+            int v0 = trianglesSB.data[t][0];
+            int v1 = trianglesSB.data[t][1];
+            int v2 = trianglesSB.data[event[1]][1];
+            int sign0 = Orient(q, v0, p);
+            int sign1 = Orient(q, v1, p);
+            int sign2 = Orient(q, v2, p);
+            if (sign0 >= 0 && sign1 <= 0)
+            {
+                location = t;
+            }
+            else if (sign1 >= 0 && sign2 <= 0)
+            {
+                location = event[1];
+            }
+            else
+            {
+                location = event[2];
+            }
+        }
+        else
+        {
+            location = (Orient(q, trianglesSB.data[t][2], p) >= 0 ? t : event[1]);
+        }
+        locationsSB.data[p] = location;
+    }
+)",
+
+// MARK_FLIP
+R"(
+    buffer adjacent { ivec4 data[]; } adjacentSB;
+    buffer locks { uint data[]; } locksSB;
+
+    void main()
+    {
+        int t = GetIndex();
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        ivec4 tri = trianglesSB.data[t];
+        ivec4 adj = adjacentSB.data[t];
+        for (int j = 0; j < 3; ++j)
+        {
+            int n = adj[j];
+            if (n > t)
+            {
+                int a = tri[j], b = tri[(j + 1) % 3], c = tri[(j + 2) % 3];
+                int d = trianglesSB.data[n][(GetEdge(n, b, a) + 2) % 3];
+                if (InCircle(a, b, c, d) > 0)
+                {
+                    uint id = uint(3 * t + j);
+                    atomicMin(locksSB.data[t], id);
+                    atomicMin(locksSB.data[n], id);
+                }
+            }
+        }
+    }
+)",
+
+// FLIP
+R"(
+    buffer adjacent { ivec4 data[]; } adjacentSB;
+    buffer events { ivec4 data[]; } eventsSB;
+    buffer locks { uint data[]; } locksSB;
+    buffer counters { uint data[]; } countersSB;
+
+    void main()
+    {
+        int t = GetIndex();
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        uint id = locksSB.data[t];
+        if (id == 0xFFFFFFFFu || int(id / 3u) != t)
+        {
+            return;
+        }
+
+        int j = int(id % 3u);
+        ivec4 tri = trianglesSB.data[t];
+        ivec4 adj = adjacentSB.data[t];
+        int n = adj[j];
+        if (locksSB.data[n] != id)
+        {
+            return;
+        }
+
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        int a = tri[j], b = tri[j1], c = tri[j2];
+        int k = GetEdge(n, b, a);
+        ivec4 ntri = trianglesSB.data[n];
+        ivec4 nadj = adjacentSB.data[n];
+        int d = ntri[(k + 2) % 3];
+        int adjBC = adj[j1], adjCA = adj[j2];
+        int adjAD = nadj[(k + 1) % 3], adjDB = nadj[(k + 2) % 3];
+
+        trianglesSB.data[t] = ivec4(c, a, d, -1);
+        trianglesSB.data[n] = ivec4(d, b, c, -1);
+        adjacentSB.data[t] = ivec4(adjCA, adjAD, n, -1);
+        adjacentSB.data[n] = ivec4(adjDB, adjBC, t, -1);
+        eventsSB.data[t] = ivec4(stamp, n, -1, -1);
+        eventsSB.data[n] = ivec4(stamp, t, -1, -1);
+        atomicAdd(countersSB.data[2], 1u);
+    }
+)"
+};
+
+std::string const GPUFlipDelaunay2::msHLSLCommonSource =
+R"(
+    cbuffer Parameters
+    {
+        int numPoints;
+        int numTriangles;
+        int stamp;
+        int exactOrient;
+        int rowSize;
+        int padding0, padding1, padding2;
+    };
+
+    // The vertices of triangle t and the unused component -1.
+    RWStructuredBuffer<int4> triangles;
+
+    int GetEdge(int t, int a, int b)
+    {
+        int4 tri = triangles[t];
+        [unroll]
+        for (int j = 0; j < 3; ++j)
+        {
+            if (tri[j] == a && tri[(j + 1) % 3] == b)
+            {
+                return j;
+            }
+        }
+        return -1;
+    }
+)";
+
+std::string const GPUFlipDelaunay2::msHLSLPredicateSource =
+R"(
+    StructuredBuffer<float2> points;
+
+    double Abs(double x)
+    {
+        return (x >= 0.0l ? x : -x);
+    }
+
+    // The floating-point filters of FlipDelaunay2::Orient and
+    // FlipDelaunay2::InCircle. The error bound coefficients are slightly
+    // larger than (3+16u)u and (10+96u)u for u = 2^{-53}.
+    int Orient(int v0, int v1, int p)
+    {
+        double2 P0 = double2(points[v0].x, points[v0].y);
+        double2 P1 = double2(points[v1].x, points[v1].y);
+        double2 P = double2(points[p].x, points[p].y);
+        precise double x1 = P1.x - P0.x, y1 = P1.y - P0.y;
+        precise double x2 = P.x - P0.x, y2 = P.y - P0.y;
+        precise double x1y2 = x1 * y2, x2y1 = x2 * y1;
+        precise double det = x1y2 - x2y1;
+        if (exactOrient != 0)
+        {
+            return (det > 0.0l ? 1 : (det < 0.0l ? -1 : 0));
+        }
+        double errorBound = 3.3306690738754720e-16l * (Abs(x1y2) + Abs(x2y1));
+        return (det > errorBound ? 1 : (-det > errorBound ? -1 : 0));
+    }
+
+    int InCircle(int v0, int v1, int v2, int p)
+    {
+        double2 P = double2(points[p].x, points[p].y);
+        double2 P0 = double2(points[v0].x, points[v0].y);
+        double2 P1 = double2(points[v1].x, points[v1].y);
+        double2 P2 = double2(points[v2].x, points[v2].y);
+        precise double x0 = P0.x - P.x, y0 = P0.y - P.y;
+        precise double x1 = P1.x - P.x, y1 = P1.y - P.y;
+        precise double x2 = P2.x - P.x, y2 = P2.y - P.y;
+        precise double x1y2 = x1 * y2, x2y1 = x2 * y1;
+        precise double x2y0 = x2 * y0, x0y2 = x0 * y2;
+        precise double x0y1 = x0 * y1, x1y0 = x1 * y0;
+        precise double lift0 = x0 * x0 + y0 * y0;
+        precise double lift1 = x1 * x1 + y1 * y1;
+        precise double lift2 = x2 * x2 + y2 * y2;
+        precise double det =
+            lift0 * (x1y2 - x2y1) +
+            lift1 * (x2y0 - x0y2) +
+            lift2 * (x0y1 - x1y0);
+        precise double permanent =
+            (Abs(x1y2) + Abs(x2y1)) * lift0 +
+            (Abs(x2y0) + Abs(x0y2)) * lift1 +
+            (Abs(x0y1) + Abs(x1y0)) * lift2;
+        double errorBound = 1.1102230246251580e-15l * permanent;
+        return (det > errorBound ? 1 : (-det > errorBound ? -1 : 0));
+    }
+)";
+
+std::array<std::string, GPUFlipDelaunay2::NUM_KERNELS> const GPUFlipDelaunay2::msHLSLKernelSource =
+{
+// VOTE
+R"(
+    RWStructuredBuffer<int4> adjacent;
+    RWStructuredBuffer<uint> votes;
+    RWStructuredBuffer<int> locations;
+    RWStructuredBuffer<int> neighbors;
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int p = int(dt.x) + rowSize * int(dt.y);
+        if (p >= numPoints)
+        {
+            return;
+        }
+
+        int t = locations[p];
+        if (t < 0)
+        {
+            return;
+        }
+
+        int4 tri = triangles[t];
+        int numPositive = 0, zero = -1;
+        [unroll]
+        for (int j = 0; j < 3; ++j)
+        {
+            int sign = Orient(tri[j], tri[(j + 1) % 3], p);
+            if (sign > 0)
+            {
+                ++numPositive;
+            }
+            else if (sign == 0 && exactOrient != 0)
+            {
+                zero = j;
+            }
+        }
+
+        uint key = (uint(p) * 0x9E3779B1u) & 0x7FFFFFFFu;
+        if (numPositive == 3)
+        {
+            neighbors[p] = -1;
+            InterlockedMin(votes[t], key);
+        }
+        else if (numPositive == 2 && zero >= 0)
+        {
+            int n = adjacent[t][zero];
+            neighbors[p] = n;
+            key |= 0x80000000u;
+            InterlockedMin(votes[t], key);
+            if (n >= 0)
+            {
+                InterlockedMin(votes[n], key);
+            }
+        }
+    }
+)",
+
+// SPLIT
+R"(
+    RWStructuredBuffer<int4> adjacent;
+    RWStructuredBuffer<int4> events;
+    RWStructuredBuffer<uint> votes;
+    RWStructuredBuffer<int> locations;
+    RWStructuredBuffer<int> neighbors;
+    RWStructuredBuffer<uint> counters;
+
+    void SplitEdge(int t, int j, int q)
+    {
+        int4 tri = triangles[t];
+        int4 adj = adjacent[t];
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        int a = tri[j], b = tri[j1], c = tri[j2];
+        int adjBC = adj[j1], adjCA = adj[j2];
+        int n = adj[j];
+        uint first;
+        int s;
+        if (n >= 0)
+        {
+            InterlockedAdd(counters[0], 2u, first);
+            s = int(first);
+            int m = s + 1;
+            int k = GetEdge(n, b, a);
+            int4 ntri = triangles[n];
+            int4 nadj = adjacent[n];
+            int d = ntri[(k + 2) % 3];
+            int adjAD = nadj[(k + 1) % 3];
+            int adjDB = nadj[(k + 2) % 3];
+            triangles[n] = int4(b, q, d, -1);
+            triangles[m] = int4(q, a, d, -1);
+            adjacent[n] = int4(s, m, adjDB, -1);
+            adjacent[m] = int4(t, adjAD, n, -1);
+            adjacent[t] = int4(m, s, adjCA, -1);
+            adjacent[s] = int4(n, adjBC, t, -1);
+            events[n] = int4(stamp, m, -1, q);
+        }
+        else
+        {
+            InterlockedAdd(counters[0], 1u, first);
+            s = int(first);
+            adjacent[t] = int4(-1, s, adjCA, -1);
+            adjacent[s] = int4(-1, adjBC, t, -1);
+        }
+        triangles[t] = int4(a, q, c, -1);
+        triangles[s] = int4(q, b, c, -1);
+        events[t] = int4(stamp, s, -1, q);
+    }
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int t = int(dt.x) + rowSize * int(dt.y);
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        uint key = votes[t];
+        if (key == 0xFFFFFFFFu)
+        {
+            return;
+        }
+
+        int q = int((key * 0x0E8B2F51u) & 0x7FFFFFFFu);
+        int neighbor = neighbors[q];
+        if (neighbor >= 0)
+        {
+            int location = locations[q];
+            int other = (location == t ? neighbor : location);
+            if (other < t || votes[other] != key)
+            {
+                return;
+            }
+            int4 adj = adjacent[t];
+            int j = (adj[0] == other ? 0 : (adj[1] == other ? 1 : 2));
+            SplitEdge(t, j, q);
+            InterlockedAdd(counters[1], 1u);
+            return;
+        }
+
+        int4 tri = triangles[t];
+        if (exactOrient != 0)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                if (Orient(tri[j], tri[(j + 1) % 3], q) == 0)
+                {
+                    SplitEdge(t, j, q);
+                    InterlockedAdd(counters[1], 1u);
+                    return;
+                }
+            }
+        }
+
+        uint first;
+        InterlockedAdd(counters[0], 2u, first);
+        int s1 = int(first);
+        int s2 = s1 + 1;
+        int4 adj = adjacent[t];
+        triangles[t] = int4(tri[0], tri[1], q, -1);
+        triangles[s1] = int4(tri[1], tri[2], q, -1);
+        triangles[s2] = int4(tri[2], tri[0], q, -1);
+        adjacent[t] = int4(adj[0], s1, s2, -1);
+        adjacent[s1] = int4(adj[1], s2, t, -1);
+        adjacent[s2] = int4(adj[2], t, s1, -1);
+        events[t] = int4(stamp, s1, s2, q);
+        InterlockedAdd(counters[1], 1u);
+    }
+)",
+
+// UPDATE_ADJACENT
+R"(
+    RWStructuredBuffer<int4> adjacent;
+    RWStructuredBuffer<int4> events;
+    RWStructuredBuffer<uint> votes;
+    RWStructuredBuffer<uint> locks;
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int t = int(dt.x) + rowSize * int(dt.y);
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        votes[t] = 0xFFFFFFFFu;
+        locks[t] = 0xFFFFFFFFu;
+        int4 tri = triangles[t];
+        int4 adj = adjacent[t];
+        [unroll]
+        for (int j = 0; j < 3; ++j)
+        {
+            int m = adj[j];
+            if (m >= 0)
+            {
+                int a = tri[j], b = tri[(j + 1) % 3];
+                int4 event = events[m];
+                if (event[0] == stamp && GetEdge(m, b, a) < 0)
+                {
+                    adj[j] = (GetEdge(event[1], b, a) >= 0 ? event[1] : event[2]);
+                }
+            }
+        }
+        adjacent[t] = adj;
+    }
+)",
+
+// RELOCATE
+R"(
+    RWStructuredBuffer<int4> events;
+    RWStructuredBuffer<int> locations;
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int p = int(dt.x) + rowSize * int(dt.y);
+        if (p >= numPoints)
+        {
+            return;
+        }
+
+        int t = locations[p];
+        if (t < 0)
+        {
+            return;
+        }
+
+        int4 event = events[t];
+        if (event[0] != stamp)
+        {
+            return;
+        }
+
+        int q = event[3];
+        int location;
+        if (q == p)
+        {
+            location = -1;
+        }
+        else if (q < 0)
+        {
+            int owner = min(t, event[1]);
+            int other = max(t, event[1]);
+            int4 tri = triangles[owner];
+            location = (Orient(tri[2], tri[0], p) >= 0 ? owner : other);
+        }
+        else if (event[2] >= 0)
+        {
+            int v0 = triangles[t][0];
+            int v1 = triangles[t][1];
+            int v2 = triangles[event[1]][1];
+            int sign0 = Orient(q, v0, p);
+            int sign1 = Orient(q, v1, p);
+            int sign2 = Orient(q, v2, p);
+            if (sign0 >= 0 && sign1 <= 0)
+            {
+                location = t;
+            }
+            else if (sign1 >= 0 && sign2 <= 0)
+            {
+                location = event[1];
+            }
+            else
+            {
+                location = event[2];
+            }
+        }
+        else
+        {
+            location = (Orient(q, triangles[t][2], p) >= 0 ? t : event[1]);
+        }
+        locations[p] = location;
+    }
+)",
+
+// MARK_FLIP
+R"(
+    RWStructuredBuffer<int4> adjacent;
+    RWStructuredBuffer<uint> locks;
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int t = int(dt.x) + rowSize * int(dt.y);
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        int4 tri = triangles[t];
+        int4 adj = adjacent[t];
+        for (int j = 0; j < 3; ++j)
+        {
+            int n = adj[j];
+            if (n > t)
+            {
+                int a = tri[j], b = tri[(j + 1) % 3], c = tri[(j + 2) % 3];
+                int d = triangles[n][(GetEdge(n, b, a) + 2) % 3];
+                if (InCircle(a, b, c, d) > 0)
+                {
+                    uint id = uint(3 * t + j);
+                    InterlockedMin(locks[t], id);
+                    InterlockedMin(locks[n], id);
+                }
+            }
+        }
+    }
+)",
+
+// FLIP
+R"(
+    RWStructuredBuffer<int4> adjacent;
+    RWStructuredBuffer<int4> events;
+    RWStructuredBuffer<uint> locks;
+    RWStructuredBuffer<uint> counters;
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int t = int(dt.x) + rowSize * int(dt.y);
+        if (t >= numTriangles)
+        {
+            return;
+        }
+
+        uint id = locks[t];
+        if (id == 0xFFFFFFFFu || int(id / 3u) != t)
+        {
+            return;
+        }
+
+        int j = int(id % 3u);
+        int4 tri = triangles[t];
+        int4 adj = adjacent[t];
+        int n = adj[j];
+        if (locks[n] != id)
+        {
+            return;
+        }
+
+        int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        int a = tri[j], b = tri[j1], c = tri[j2];
+        int k = GetEdge(n, b, a);
+        int4 ntri = triangles[n];
+        int4 nadj = adjacent[n];
+        int d = ntri[(k + 2) % 3];
+        int adjBC = adj[j1], adjCA = adj[j2];
+        int adjAD = nadj[(k + 1) % 3], adjDB = nadj[(k + 2) % 3];
+
+        triangles[t] = int4(c, a, d, -1);
+        triangles[n] = int4(d, b, c, -1);
+        adjacent[t] = int4(adjCA, adjAD, n, -1);
+        adjacent[n] = int4(adjDB, adjBC, t, -1);
+        events[t] = int4(stamp, n, -1, -1);
+        events[n] = int4(stamp, t, -1, -1);
+        InterlockedAdd(counters[2], 1u);
+    }
+)"
+};
+
+std::array<bool, GPUFlipDelaunay2::NUM_KERNELS> const GPUFlipDelaunay2::msUsesPredicates =
+{
+    true,   // VOTE
+    true,   // SPLIT
+    false,  // UPDATE_ADJACENT
+    true,   // RELOCATE
+    true,   // MARK_FLIP
+    false   // FLIP
+};
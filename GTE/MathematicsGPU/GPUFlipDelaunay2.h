@@ -0,0 +1,104 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/FlipDelaunay2.h>
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+
+// Read the comments in Mathematics/FlipDelaunay2.h for information about
+// the algorithm. The class FlipDelaunay2 has a CPU-based implementation of
+// the parallel phase. The class GPUFlipDelaunay2 derives from FlipDelaunay2
+// and provides a GPU-based implementation using DX11/HLSL or GL45/GLSL. The
+// convex hull, the initial point location and the fix-up pass are computed
+// on the CPU. The predicates of the shaders use 'double' arithmetic, which
+// requires D3D11 double-precision shader support or OpenGL 4.0 or later.
+// The GPU buffers are reused by later calls with at most as many points, so
+// a single object should be used to triangulate a sequence of point sets.
+
+namespace gte
+{
+    class GPUFlipDelaunay2 : public FlipDelaunay2
+    {
+    public:
+        // Construction. The kernels are dispatched with 1D thread groups of
+        // numThreads threads.
+        GPUFlipDelaunay2(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            int maxFlipPasses = 16, int numThreads = 64);
+
+        virtual ~GPUFlipDelaunay2() = default;
+
+    protected:
+        virtual void InsertPoints() override;
+
+    private:
+        enum
+        {
+            VOTE,
+            SPLIT,
+            UPDATE_ADJACENT,
+            RELOCATE,
+            MARK_FLIP,
+            FLIP,
+            NUM_KERNELS
+        };
+
+        // The layout of the constant buffer "Parameters".
+        struct Parameters
+        {
+            int32_t numPoints;
+            int32_t numTriangles;
+            int32_t stamp;
+            int32_t exactOrient;
+            int32_t rowSize;
+            int32_t padding[3];
+        };
+
+        void CreateBuffers();
+        void Upload(std::shared_ptr<StructuredBuffer> const& buffer,
+            void const* data, size_t numElements);
+        void Download(std::shared_ptr<StructuredBuffer> const& buffer,
+            void* data, size_t numElements);
+        std::array<uint32_t, 4> GetCounters();
+
+        // Dispatch the kernel with one thread per element.
+        void Execute(int kernel, int32_t numElements, int32_t numTriangles,
+            int32_t stamp);
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        int mNumThreads;
+        std::array<std::shared_ptr<ComputeProgram>, NUM_KERNELS> mKernels;
+        std::shared_ptr<ConstantBuffer> mParameters;
+
+        // The buffers are allocated for mCapacity points.
+        int32_t mCapacity;
+        std::shared_ptr<StructuredBuffer> mPointBuffer;
+        std::shared_ptr<StructuredBuffer> mTriangleBuffer;
+        std::shared_ptr<StructuredBuffer> mAdjacentBuffer;
+        std::shared_ptr<StructuredBuffer> mEventBuffer;
+        std::shared_ptr<StructuredBuffer> mVoteBuffer;
+        std::shared_ptr<StructuredBuffer> mLockBuffer;
+        std::shared_ptr<StructuredBuffer> mLocationBuffer;
+        std::shared_ptr<StructuredBuffer> mNeighborBuffer;
+        std::shared_ptr<StructuredBuffer> mCounterBuffer;
+
+        // Shader source code as strings. The source of a kernel is the
+        // common code, followed by the predicates when the kernel needs
+        // them, followed by the kernel code.
+        static std::string const msGLSLCommonSource;
+        static std::string const msGLSLPredicateSource;
+        static std::array<std::string, NUM_KERNELS> const msGLSLKernelSource;
+        static std::string const msHLSLCommonSource;
+        static std::string const msHLSLPredicateSource;
+        static std::array<std::string, NUM_KERNELS> const msHLSLKernelSource;
+        static std::array<bool, NUM_KERNELS> const msUsesPredicates;
+    };
+}
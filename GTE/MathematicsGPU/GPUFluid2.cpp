@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid2.h>
@@ -11,7 +11,8 @@ using namespace gte;
 
 GPUFluid2::GPUFluid2(std::shared_ptr<GraphicsEngine> const& engine,
     std::shared_ptr<ProgramFactory> const& factory,
-    int xSize, int ySize, float dt, float densityViscosity, float velocityViscosity)
+    int xSize, int ySize, float dt, float densityViscosity, float velocityViscosity,
+    GPUFluid2SolvePoisson::Method poissonMethod, int numPoissonIterations)
     :
     mEngine(engine),
     mXSize(xSize),
@@ -66,7 +67,8 @@ GPUFluid2::GPUFluid2(std::shared_ptr<GraphicsEngine> const& engine,
     mDivergenceTexture = mComputeDivergence->GetDivergence();
 
     mSolvePoisson = std::make_shared<GPUFluid2SolvePoisson>(factory, mXSize,
-        mYSize, 16, 16, mParameters, 32);
+        mYSize, 16, 16, mParameters, numPoissonIterations,
+        poissonMethod);
     mPoissonTexture = mSolvePoisson->GetPoisson();
 
     mAdjustVelocity = std::make_shared<GPUFluid2AdjustVelocity>(factory, mXSize,
@@ -87,6 +89,7 @@ void GPUFluid2::DoSimulationStep()
     mEnforceStateBoundary->Execute(mEngine, mStateTp1Texture);
     mComputeDivergence->Execute(mEngine, mStateTp1Texture);
     mSolvePoisson->Execute(mEngine, mDivergenceTexture);
+    mPoissonTexture = mSolvePoisson->GetPoisson();
     mAdjustVelocity->Execute(mEngine, mStateTp1Texture, mPoissonTexture, mStateTm1Texture);
     mEnforceStateBoundary->Execute(mEngine, mStateTm1Texture);
     std::swap(mStateTm1Texture, mStateTTexture);
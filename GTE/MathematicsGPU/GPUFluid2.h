@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -20,10 +20,14 @@ namespace gte
     class GPUFluid2
     {
     public:
-        // Construction.  The (x,y) grid covers [0,1]^2.
+        // Construction.  The (x,y) grid covers [0,1]^2.  The Poisson
+        // equation of each step is solved by numPoissonIterations iterations
+        // of the specified method; see GPUFluid2SolvePoisson.h.
         GPUFluid2(std::shared_ptr<GraphicsEngine> const& engine,
             std::shared_ptr<ProgramFactory> const& factory,
-            int xSize, int ySize, float dt, float densityViscosity, float velocityViscosity);
+            int xSize, int ySize, float dt, float densityViscosity, float velocityViscosity,
+            GPUFluid2SolvePoisson::Method poissonMethod = GPUFluid2SolvePoisson::Method::JACOBI,
+            int numPoissonIterations = 32);
 
         void Initialize();
         void DoSimulationStep();
@@ -3,20 +3,23 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid2SolvePoisson.h>
+#include <algorithm>
 using namespace gte;
 
 GPUFluid2SolvePoisson::GPUFluid2SolvePoisson(
     std::shared_ptr<ProgramFactory> const& factory,
     int xSize, int ySize, int numXThreads, int numYThreads,
-    std::shared_ptr<ConstantBuffer> const& parameters, int numIterations)
+    std::shared_ptr<ConstantBuffer> const& parameters, int numIterations,
+    Method method)
     :
     mNumXGroups(xSize / numXThreads),
     mNumYGroups(ySize / numYThreads),
-    mNumIterations(numIterations)
+    mNumIterations(numIterations),
+    mMethod(method)
 {
     mPoisson0 = std::make_shared<Texture2>(DF_R32_FLOAT, xSize, ySize);
     mPoisson0->SetUsage(Resource::SHADER_OUTPUT);
@@ -53,11 +56,94 @@ GPUFluid2SolvePoisson::GPUFluid2SolvePoisson(
     mWriteYEdge = factory->CreateFromSource(*msPoissonEnforceBoundarySource[api]);
 
     factory->PopDefines();
+
+    if (mMethod == Method::MULTIGRID)
+    {
+        CreateMultigrid(factory, numXThreads, numYThreads, parameters);
+    }
 }
 
 void GPUFluid2SolvePoisson::Execute(
     std::shared_ptr<GraphicsEngine> const& engine,
     std::shared_ptr<Texture2> const& divergence)
+{
+    if (mMethod == Method::MULTIGRID)
+    {
+        ExecuteMultigrid(engine, divergence);
+    }
+    else
+    {
+        ExecuteJacobi(engine, divergence);
+    }
+}
+
+void GPUFluid2SolvePoisson::CreateMultigrid(std::shared_ptr<ProgramFactory> const& factory,
+    int numXThreads, int numYThreads, std::shared_ptr<ConstantBuffer> const& parameters)
+{
+    // The level sizes are not necessarily multiples of the numbers of
+    // threads, so the kernels test whether their texels are in the grid.
+    // The Poisson equation of level l has grid spacing (2^l*dx, 2^l*dy), so
+    // the epsilon0 term of the Jacobi step is scaled by 4^l.
+    Vector4<float> epsilon = parameters->Get<GPUFluid2Parameters>()->epsilon;
+    int xSize = mPoisson0->GetWidth(), ySize = mPoisson0->GetHeight();
+    for (;;)
+    {
+        Level level;
+        level.xSize = xSize;
+        level.ySize = ySize;
+        level.numXGroups = (xSize + numXThreads - 1) / numXThreads;
+        level.numYGroups = (ySize + numYThreads - 1) / numYThreads;
+        level.parameters = std::make_shared<ConstantBuffer>(sizeof(Vector4<float>), false);
+        *level.parameters->Get<Vector4<float>>() = epsilon;
+        if (mLevels.size() == 0)
+        {
+            level.poisson = mPoisson0;
+        }
+        else
+        {
+            level.poisson = std::make_shared<Texture2>(DF_R32_FLOAT, xSize, ySize);
+            level.poisson->SetUsage(Resource::SHADER_OUTPUT);
+            level.divergence = std::make_shared<Texture2>(DF_R32_FLOAT, xSize, ySize);
+            level.divergence->SetUsage(Resource::SHADER_OUTPUT);
+        }
+
+        bool coarsest = (xSize < 5 || ySize < 5);
+        if (!coarsest)
+        {
+            level.residual = std::make_shared<Texture2>(DF_R32_FLOAT, xSize, ySize);
+            level.residual->SetUsage(Resource::SHADER_OUTPUT);
+        }
+        mLevels.push_back(level);
+        if (coarsest)
+        {
+            break;
+        }
+
+        xSize = xSize / 2 + 1;
+        ySize = ySize / 2 + 1;
+        epsilon[3] *= 4.0f;
+    }
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numXThreads);
+    factory->defines.Set("NUM_Y_THREADS", numYThreads);
+    factory->defines.Set("PARITY", "0");
+    mSmoothRed = factory->CreateFromSource(*msPoissonSmoothSource[api]);
+    factory->defines.Set("PARITY", "1");
+    mSmoothBlack = factory->CreateFromSource(*msPoissonSmoothSource[api]);
+    factory->defines.Clear();
+    factory->defines.Set("NUM_X_THREADS", numXThreads);
+    factory->defines.Set("NUM_Y_THREADS", numYThreads);
+    mResidual = factory->CreateFromSource(*msPoissonResidualSource[api]);
+    mRestrict = factory->CreateFromSource(*msPoissonRestrictSource[api]);
+    mProlongate = factory->CreateFromSource(*msPoissonProlongateSource[api]);
+    factory->PopDefines();
+}
+
+void GPUFluid2SolvePoisson::ExecuteJacobi(
+    std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture2> const& divergence)
 {
     auto solve = mSolvePoisson->GetComputeShader();
     auto xwrite = mWriteXEdge->GetComputeShader();
@@ -82,6 +168,82 @@ void GPUFluid2SolvePoisson::Execute(
     }
 }
 
+void GPUFluid2SolvePoisson::ExecuteMultigrid(
+    std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture2> const& divergence)
+{
+    auto zero = mZeroPoisson->GetComputeShader();
+    auto residual = mResidual->GetComputeShader();
+    auto restriction = mRestrict->GetComputeShader();
+    auto prolongate = mProlongate->GetComputeShader();
+    size_t const numLevels = mLevels.size();
+
+    zero->Set("poisson", mPoisson0);
+    engine->Execute(mZeroPoisson, mLevels[0].numXGroups, mLevels[0].numYGroups, 1);
+    for (int i = 0; i < mNumIterations; ++i)
+    {
+        // Smooth the error and restrict the residual to the coarser levels.
+        // The coarse-level solutions are corrections, so they start at zero.
+        for (size_t l = 0; l + 1 < numLevels; ++l)
+        {
+            Level const& level = mLevels[l];
+            auto const& rhs = (l == 0 ? divergence : level.divergence);
+            if (l > 0)
+            {
+                zero->Set("poisson", level.poisson);
+                engine->Execute(mZeroPoisson, level.numXGroups, level.numYGroups, 1);
+            }
+            Smooth(engine, level, rhs, msNumSmoothingSweeps);
+
+            residual->Set("Level", level.parameters);
+            residual->Set("divergence", rhs);
+            residual->Set("poisson", level.poisson);
+            residual->Set("residual", level.residual);
+            engine->Execute(mResidual, level.numXGroups, level.numYGroups, 1);
+
+            Level const& coarse = mLevels[l + 1];
+            restriction->Set("residual", level.residual);
+            restriction->Set("coarseDivergence", coarse.divergence);
+            engine->Execute(mRestrict, coarse.numXGroups, coarse.numYGroups, 1);
+        }
+
+        Level const& coarsest = mLevels.back();
+        zero->Set("poisson", coarsest.poisson);
+        engine->Execute(mZeroPoisson, coarsest.numXGroups, coarsest.numYGroups, 1);
+        Smooth(engine, coarsest, coarsest.divergence,
+            std::max(coarsest.xSize, coarsest.ySize));
+
+        // Add the interpolated corrections and smooth the error.
+        for (size_t l = numLevels - 1; l > 0; --l)
+        {
+            Level const& level = mLevels[l - 1];
+            prolongate->Set("coarsePoisson", mLevels[l].poisson);
+            prolongate->Set("poisson", level.poisson);
+            engine->Execute(mProlongate, level.numXGroups, level.numYGroups, 1);
+            Smooth(engine, level, (l == 1 ? divergence : level.divergence),
+                msNumSmoothingSweeps);
+        }
+    }
+}
+
+void GPUFluid2SolvePoisson::Smooth(std::shared_ptr<GraphicsEngine> const& engine,
+    Level const& level, std::shared_ptr<Texture2> const& divergence, int numSweeps)
+{
+    for (auto const& program : { mSmoothRed, mSmoothBlack })
+    {
+        auto cshader = program->GetComputeShader();
+        cshader->Set("Level", level.parameters);
+        cshader->Set("divergence", divergence);
+        cshader->Set("poisson", level.poisson);
+    }
+
+    for (int i = 0; i < numSweeps; ++i)
+    {
+        engine->Execute(mSmoothRed, level.numXGroups, level.numYGroups, 1);
+        engine->Execute(mSmoothBlack, level.numXGroups, level.numYGroups, 1);
+    }
+}
+
 
 std::string const GPUFluid2SolvePoisson::msGLSLPoissonZeroSource =
 R"(
@@ -251,6 +413,277 @@ R"(
     #endif
 )";
 
+std::string const GPUFluid2SolvePoisson::msGLSLPoissonSmoothSource =
+R"(
+    uniform Level
+    {
+        vec4 epsilon;   // (epsilonX, epsilonY, 0, epsilon0) of the level
+    };
+
+    layout(r32f) uniform readonly image2D divergence;
+    layout(r32f) uniform image2D poisson;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        // Update the interior samples of one color of the red-black
+        // ordering. Their neighbors have the other color.
+        ivec2 c = ivec2(gl_GlobalInvocationID.xy);
+        ivec2 dim = imageSize(poisson);
+        if (c.x > 0 && c.x < dim.x - 1 && c.y > 0 && c.y < dim.y - 1
+            && ((c.x + c.y) & 1) == PARITY)
+        {
+            float div = imageLoad(divergence, c).x;
+            float poisPZ = imageLoad(poisson, ivec2(c.x + 1, c.y)).x;
+            float poisMZ = imageLoad(poisson, ivec2(c.x - 1, c.y)).x;
+            float poisZP = imageLoad(poisson, ivec2(c.x, c.y + 1)).x;
+            float poisZM = imageLoad(poisson, ivec2(c.x, c.y - 1)).x;
+
+            vec4 temp = vec4(poisPZ + poisMZ, poisZP + poisZM, 0.0f, div);
+            imageStore(poisson, c, vec4(dot(epsilon, temp), 0.0f, 0.0f, 0.0f));
+        }
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msGLSLPoissonResidualSource =
+R"(
+    uniform Level
+    {
+        vec4 epsilon;   // (epsilonX, epsilonY, 0, epsilon0) of the level
+    };
+
+    layout(r32f) uniform readonly image2D divergence;
+    layout(r32f) uniform readonly image2D poisson;
+    layout(r32f) uniform writeonly image2D residual;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        // The residual is zero on the boundary.
+        ivec2 c = ivec2(gl_GlobalInvocationID.xy);
+        ivec2 dim = imageSize(poisson);
+        if (c.x >= dim.x || c.y >= dim.y)
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (c.x > 0 && c.x < dim.x - 1 && c.y > 0 && c.y < dim.y - 1)
+        {
+            float div = imageLoad(divergence, c).x;
+            float pois = imageLoad(poisson, c).x;
+            float poisPZ = imageLoad(poisson, ivec2(c.x + 1, c.y)).x;
+            float poisMZ = imageLoad(poisson, ivec2(c.x - 1, c.y)).x;
+            float poisZP = imageLoad(poisson, ivec2(c.x, c.y + 1)).x;
+            float poisZM = imageLoad(poisson, ivec2(c.x, c.y - 1)).x;
+
+            vec2 temp = vec2(poisPZ + poisMZ, poisZP + poisZM);
+            value = div - (pois - dot(epsilon.xy, temp)) / epsilon.w;
+        }
+        imageStore(residual, c, vec4(value, 0.0f, 0.0f, 0.0f));
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msGLSLPoissonRestrictSource =
+R"(
+    layout(r32f) uniform readonly image2D residual;
+    layout(r32f) uniform writeonly image2D coarseDivergence;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        // Full weighting of the 3x3 fine samples centered at the fine
+        // sample 2*c. The right-hand side is zero on the boundary.
+        ivec2 c = ivec2(gl_GlobalInvocationID.xy);
+        ivec2 dim = imageSize(coarseDivergence);
+        if (c.x >= dim.x || c.y >= dim.y)
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (c.x > 0 && c.x < dim.x - 1 && c.y > 0 && c.y < dim.y - 1)
+        {
+            ivec2 f = 2 * c;
+            float center = imageLoad(residual, f).x;
+            float edges =
+                imageLoad(residual, ivec2(f.x + 1, f.y)).x +
+                imageLoad(residual, ivec2(f.x - 1, f.y)).x +
+                imageLoad(residual, ivec2(f.x, f.y + 1)).x +
+                imageLoad(residual, ivec2(f.x, f.y - 1)).x;
+            float corners =
+                imageLoad(residual, ivec2(f.x + 1, f.y + 1)).x +
+                imageLoad(residual, ivec2(f.x - 1, f.y + 1)).x +
+                imageLoad(residual, ivec2(f.x + 1, f.y - 1)).x +
+                imageLoad(residual, ivec2(f.x - 1, f.y - 1)).x;
+            value = 0.25f * center + 0.125f * edges + 0.0625f * corners;
+        }
+        imageStore(coarseDivergence, c, vec4(value, 0.0f, 0.0f, 0.0f));
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msGLSLPoissonProlongateSource =
+R"(
+    layout(r32f) uniform readonly image2D coarsePoisson;
+    layout(r32f) uniform image2D poisson;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        // Add the bilinear interpolation of the coarse correction, whose
+        // sample k is at the fine sample 2*k. The boundary remains zero.
+        ivec2 c = ivec2(gl_GlobalInvocationID.xy);
+        ivec2 dim = imageSize(poisson);
+        if (c.x > 0 && c.x < dim.x - 1 && c.y > 0 && c.y < dim.y - 1)
+        {
+            ivec2 c0 = c >> 1;
+            ivec2 c1 = (c + 1) >> 1;
+            float correction = 0.25f * (
+                imageLoad(coarsePoisson, ivec2(c0.x, c0.y)).x +
+                imageLoad(coarsePoisson, ivec2(c1.x, c0.y)).x +
+                imageLoad(coarsePoisson, ivec2(c0.x, c1.y)).x +
+                imageLoad(coarsePoisson, ivec2(c1.x, c1.y)).x);
+            float value = imageLoad(poisson, c).x + correction;
+            imageStore(poisson, c, vec4(value, 0.0f, 0.0f, 0.0f));
+        }
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msHLSLPoissonSmoothSource =
+R"(
+    cbuffer Level
+    {
+        float4 epsilon;   // (epsilonX, epsilonY, 0, epsilon0) of the level
+    };
+
+    Texture2D<float> divergence;
+    RWTexture2D<float> poisson;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(int2 c : SV_DispatchThreadID)
+    {
+        // Update the interior samples of one color of the red-black
+        // ordering. Their neighbors have the other color.
+        uint2 dim;
+        poisson.GetDimensions(dim.x, dim.y);
+        if (c.x > 0 && c.x < int(dim.x) - 1 && c.y > 0 && c.y < int(dim.y) - 1
+            && ((c.x + c.y) & 1) == PARITY)
+        {
+            float div = divergence[c];
+            float poisPZ = poisson[int2(c.x + 1, c.y)];
+            float poisMZ = poisson[int2(c.x - 1, c.y)];
+            float poisZP = poisson[int2(c.x, c.y + 1)];
+            float poisZM = poisson[int2(c.x, c.y - 1)];
+
+            float4 temp = float4(poisPZ + poisMZ, poisZP + poisZM, 0.0f, div);
+            poisson[c] = dot(epsilon, temp);
+        }
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msHLSLPoissonResidualSource =
+R"(
+    cbuffer Level
+    {
+        float4 epsilon;   // (epsilonX, epsilonY, 0, epsilon0) of the level
+    };
+
+    Texture2D<float> divergence;
+    Texture2D<float> poisson;
+    RWTexture2D<float> residual;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(int2 c : SV_DispatchThreadID)
+    {
+        // The residual is zero on the boundary.
+        uint2 dim;
+        poisson.GetDimensions(dim.x, dim.y);
+        if (c.x >= int(dim.x) || c.y >= int(dim.y))
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (c.x > 0 && c.x < int(dim.x) - 1 && c.y > 0 && c.y < int(dim.y) - 1)
+        {
+            float div = divergence[c];
+            float pois = poisson[c];
+            float poisPZ = poisson[int2(c.x + 1, c.y)];
+            float poisMZ = poisson[int2(c.x - 1, c.y)];
+            float poisZP = poisson[int2(c.x, c.y + 1)];
+            float poisZM = poisson[int2(c.x, c.y - 1)];
+
+            float2 temp = float2(poisPZ + poisMZ, poisZP + poisZM);
+            value = div - (pois - dot(epsilon.xy, temp)) / epsilon.w;
+        }
+        residual[c] = value;
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msHLSLPoissonRestrictSource =
+R"(
+    Texture2D<float> residual;
+    RWTexture2D<float> coarseDivergence;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(int2 c : SV_DispatchThreadID)
+    {
+        // Full weighting of the 3x3 fine samples centered at the fine
+        // sample 2*c. The right-hand side is zero on the boundary.
+        uint2 dim;
+        coarseDivergence.GetDimensions(dim.x, dim.y);
+        if (c.x >= int(dim.x) || c.y >= int(dim.y))
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (c.x > 0 && c.x < int(dim.x) - 1 && c.y > 0 && c.y < int(dim.y) - 1)
+        {
+            int2 f = 2 * c;
+            float center = residual[f];
+            float edges =
+                residual[int2(f.x + 1, f.y)] +
+                residual[int2(f.x - 1, f.y)] +
+                residual[int2(f.x, f.y + 1)] +
+                residual[int2(f.x, f.y - 1)];
+            float corners =
+                residual[int2(f.x + 1, f.y + 1)] +
+                residual[int2(f.x - 1, f.y + 1)] +
+                residual[int2(f.x + 1, f.y - 1)] +
+                residual[int2(f.x - 1, f.y - 1)];
+            value = 0.25f * center + 0.125f * edges + 0.0625f * corners;
+        }
+        coarseDivergence[c] = value;
+    }
+)";
+
+std::string const GPUFluid2SolvePoisson::msHLSLPoissonProlongateSource =
+R"(
+    Texture2D<float> coarsePoisson;
+    RWTexture2D<float> poisson;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(int2 c : SV_DispatchThreadID)
+    {
+        // Add the bilinear interpolation of the coarse correction, whose
+        // sample k is at the fine sample 2*k. The boundary remains zero.
+        uint2 dim;
+        poisson.GetDimensions(dim.x, dim.y);
+        if (c.x > 0 && c.x < int(dim.x) - 1 && c.y > 0 && c.y < int(dim.y) - 1)
+        {
+            int2 c0 = c >> 1;
+            int2 c1 = (c + 1) >> 1;
+            float correction = 0.25f * (
+                coarsePoisson[int2(c0.x, c0.y)] +
+                coarsePoisson[int2(c1.x, c0.y)] +
+                coarsePoisson[int2(c0.x, c1.y)] +
+                coarsePoisson[int2(c1.x, c1.y)]);
+            poisson[c] += correction;
+        }
+    }
+)";
+
 ProgramSources const GPUFluid2SolvePoisson::msPoissonZeroSource =
 {
     &msGLSLPoissonZeroSource,
@@ -268,3 +701,27 @@ ProgramSources const GPUFluid2SolvePoisson::msPoissonEnforceBoundarySource =
     &msGLSLPoissonEnforceBoundarySource,
     &msHLSLPoissonEnforceBoundarySource
 };
+
+ProgramSources const GPUFluid2SolvePoisson::msPoissonSmoothSource =
+{
+    &msGLSLPoissonSmoothSource,
+    &msHLSLPoissonSmoothSource
+};
+
+ProgramSources const GPUFluid2SolvePoisson::msPoissonResidualSource =
+{
+    &msGLSLPoissonResidualSource,
+    &msHLSLPoissonResidualSource
+};
+
+ProgramSources const GPUFluid2SolvePoisson::msPoissonRestrictSource =
+{
+    &msGLSLPoissonRestrictSource,
+    &msHLSLPoissonRestrictSource
+};
+
+ProgramSources const GPUFluid2SolvePoisson::msPoissonProlongateSource =
+{
+    &msGLSLPoissonProlongateSource,
+    &msHLSLPoissonProlongateSource
+};
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
@@ -12,17 +12,45 @@
 #include <Graphics/ProgramFactory.h>
 #include <Graphics/ConstantBuffer.h>
 #include <Graphics/Texture2.h>
+#include <vector>
+
+// The Poisson equation is solved with zero boundary values by one of two
+// methods.
+//   JACOBI: Each iteration is a Jacobi step, which reduces the
+//     low-frequency components of the error slowly on large grids.
+//   MULTIGRID: Each iteration is a geometric multigrid V-cycle. The grid
+//     of level l+1 has size n/2+1 for size n of level l, so its sample k
+//     is at sample 2*k of level l; the levels are coarsened until a
+//     dimension is smaller than 5. On each level, 2 red-black Gauss-Seidel
+//     sweeps are applied before the residual is restricted (full
+//     weighting) to the next level and 2 sweeps after the correction of
+//     the next level is prolongated (bilinear interpolation). The
+//     coarsest level is solved by as many sweeps as its largest size. The
+//     memory traffic of a V-cycle is about that of 8 Jacobi iterations. It
+//     reduces the error by a factor independent of the grid size,
+//     approximately 0.3 when the grid spacings dx and dy are comparable,
+//     whereas 32 Jacobi iterations reduce the residual of a 256x256 grid
+//     by only a factor of 10. Point smoothing is not effective for
+//     strongly anisotropic spacings.
 
 namespace gte
 {
     class GPUFluid2SolvePoisson
     {
     public:
-        // Construction.  Solve the Poisson equation where numIterations is the
-        // number of Gauss-Seidel steps to use in Execute.
+        enum class Method
+        {
+            JACOBI,
+            MULTIGRID
+        };
+
+        // Construction.  Solve the Poisson equation where numIterations is
+        // the number of Jacobi steps or multigrid V-cycles to use in
+        // Execute.
         GPUFluid2SolvePoisson(std::shared_ptr<ProgramFactory> const& factory,
             int xSize, int ySize, int numXThreads, int numYThreads,
-            std::shared_ptr<ConstantBuffer> const& parameters, int numIterations);
+            std::shared_ptr<ConstantBuffer> const& parameters, int numIterations,
+            Method method = Method::JACOBI);
 
         // Member access.  The texels are (velocity.x, velocity.y, 0, density).
         // The third component is unused in the simulation (a 3D simulation will
@@ -37,6 +65,31 @@ namespace gte
             std::shared_ptr<Texture2> const& divergence);
 
     private:
+        // A grid of the multigrid hierarchy. The right-hand side of level 0
+        // is the input divergence and its solution is mPoisson0.
+        struct Level
+        {
+            int xSize, ySize;
+            int numXGroups, numYGroups;
+            std::shared_ptr<ConstantBuffer> parameters;
+            std::shared_ptr<Texture2> poisson;
+            std::shared_ptr<Texture2> divergence;
+            std::shared_ptr<Texture2> residual;
+        };
+
+        void CreateMultigrid(std::shared_ptr<ProgramFactory> const& factory,
+            int numXThreads, int numYThreads,
+            std::shared_ptr<ConstantBuffer> const& parameters);
+
+        void ExecuteJacobi(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture2> const& divergence);
+
+        void ExecuteMultigrid(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture2> const& divergence);
+
+        void Smooth(std::shared_ptr<GraphicsEngine> const& engine, Level const& level,
+            std::shared_ptr<Texture2> const& divergence, int numSweeps);
+
         int mNumXGroups, mNumYGroups;
         std::shared_ptr<ComputeProgram> mZeroPoisson;
         std::shared_ptr<ComputeProgram> mSolvePoisson;
@@ -45,6 +98,16 @@ namespace gte
         std::shared_ptr<Texture2> mPoisson0;
         std::shared_ptr<Texture2> mPoisson1;
         int mNumIterations;
+        Method mMethod;
+
+        // Support for the multigrid method.
+        std::vector<Level> mLevels;
+        std::shared_ptr<ComputeProgram> mSmoothRed;
+        std::shared_ptr<ComputeProgram> mSmoothBlack;
+        std::shared_ptr<ComputeProgram> mResidual;
+        std::shared_ptr<ComputeProgram> mRestrict;
+        std::shared_ptr<ComputeProgram> mProlongate;
+        static int const msNumSmoothingSweeps = 2;
 
         // Shader source code as strings.
         static std::string const msGLSLPoissonZeroSource;
@@ -53,8 +116,20 @@ namespace gte
         static std::string const msHLSLPoissonZeroSource;
         static std::string const msHLSLPoissonSolveSource;
         static std::string const msHLSLPoissonEnforceBoundarySource;
+        static std::string const msGLSLPoissonSmoothSource;
+        static std::string const msGLSLPoissonResidualSource;
+        static std::string const msGLSLPoissonRestrictSource;
+        static std::string const msGLSLPoissonProlongateSource;
+        static std::string const msHLSLPoissonSmoothSource;
+        static std::string const msHLSLPoissonResidualSource;
+        static std::string const msHLSLPoissonRestrictSource;
+        static std::string const msHLSLPoissonProlongateSource;
         static ProgramSources const msPoissonZeroSource;
         static ProgramSources const msPoissonSolveSource;
         static ProgramSources const msPoissonEnforceBoundarySource;
+        static ProgramSources const msPoissonSmoothSource;
+        static ProgramSources const msPoissonResidualSource;
+        static ProgramSources const msPoissonRestrictSource;
+        static ProgramSources const msPoissonProlongateSource;
     };
 }
@@ -3,22 +3,28 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid3.h>
+#include <algorithm>
 using namespace gte;
 
 GPUFluid3::GPUFluid3(std::shared_ptr<GraphicsEngine> const& engine,
     std::shared_ptr<ProgramFactory> const& factory,
-    int xSize, int ySize, int zSize, float dt)
+    int xSize, int ySize, int zSize, float dt,
+    GPUFluid3SolvePoisson::Method poissonMethod, int numPoissonIterations,
+    bool sparseBricks, float occupancyThreshold)
     :
     mEngine(engine),
     mXSize(xSize),
     mYSize(ySize),
     mZSize(zSize),
     mDt(dt),
-    mTime(0.0f)
+    mTime(0.0f),
+    mReadbackLatency(0),
+    mNumStaged(0),
+    mReadbackTime(0.0f)
 {
     // Create the shared parameters for many of the simulation shaders.
     float dx = 1.0f / static_cast<float>(mXSize);
@@ -55,6 +61,12 @@ GPUFluid3::GPUFluid3(std::shared_ptr<GraphicsEngine> const& engine,
     p.viscosityZ = { velVZ, velVZ, velVZ, denVZ };
     p.epsilon = { epsilonX, epsilonY, epsilonZ, epsilon0 };
 
+    if (sparseBricks)
+    {
+        mBricks = std::make_shared<GPUFluid3ActiveBricks>(factory, mXSize,
+            mYSize, mZSize, 8, 8, 8, occupancyThreshold);
+    }
+
     // Create the compute shaders and textures for the simulation.
     mInitializeSource = std::make_shared<GPUFluid3InitializeSource>(factory,
         mXSize, mYSize, mZSize, 8, 8, 8, mParameters);
@@ -69,19 +81,20 @@ GPUFluid3::GPUFluid3(std::shared_ptr<GraphicsEngine> const& engine,
         factory, mXSize, mYSize, mZSize, 8, 8, 8);
 
     mUpdateState = std::make_shared<GPUFluid3UpdateState>(factory, mXSize,
-        mYSize, mZSize, 8, 8, 8, mParameters);
+        mYSize, mZSize, 8, 8, 8, mParameters, mBricks);
     mStateTp1Texture = mUpdateState->GetUpdateState();
 
     mComputeDivergence = std::make_shared<GPUFluid3ComputeDivergence>(factory,
-        mXSize, mYSize, mZSize, 8, 8, 8, mParameters);
+        mXSize, mYSize, mZSize, 8, 8, 8, mParameters, mBricks);
     mDivergenceTexture = mComputeDivergence->GetDivergence();
 
     mSolvePoisson = std::make_shared<GPUFluid3SolvePoisson>(factory, mXSize,
-        mYSize, mZSize, 8, 8, 8, mParameters, 32);
+        mYSize, mZSize, 8, 8, 8, mParameters, numPoissonIterations,
+        poissonMethod, mBricks);
     mPoissonTexture = mSolvePoisson->GetPoisson();
 
     mAdjustVelocity = std::make_shared<GPUFluid3AdjustVelocity>(factory, mXSize,
-        mYSize, mZSize, 8, 8, 8, mParameters);
+        mYSize, mZSize, 8, 8, 8, mParameters, mBricks);
 }
 
 void GPUFluid3::Initialize()
@@ -90,17 +103,83 @@ void GPUFluid3::Initialize()
     mInitializeState->Execute(mEngine);
     mEnforceStateBoundary->Execute(mEngine, mStateTm1Texture);
     mEnforceStateBoundary->Execute(mEngine, mStateTTexture);
+    if (mBricks)
+    {
+        mBricks->Initialize(mEngine, mStateTTexture, mSourceTexture);
+    }
 }
 
 void GPUFluid3::DoSimulationStep()
 {
+    if (mBricks)
+    {
+        // Update the active bricks for the current state. The kernels
+        // write only the active bricks, so the bricks that are no longer
+        // active are cleared in the textures that are read outside them.
+        mBricks->Execute(mEngine, mStateTTexture, mSourceTexture);
+        mBricks->ClearRetired(mEngine, mStateTm1Texture);
+        mBricks->ClearRetired(mEngine, mStateTTexture);
+        mBricks->ClearRetired(mEngine, mStateTp1Texture);
+        mBricks->ClearRetired(mEngine, mDivergenceTexture);
+    }
+
     mUpdateState->Execute(mEngine, mSourceTexture, mStateTm1Texture, mStateTTexture);
     mEnforceStateBoundary->Execute(mEngine, mStateTp1Texture);
     mComputeDivergence->Execute(mEngine, mStateTp1Texture);
     mSolvePoisson->Execute(mEngine, mDivergenceTexture);
+    mPoissonTexture = mSolvePoisson->GetPoisson();
     mAdjustVelocity->Execute(mEngine, mStateTp1Texture, mPoissonTexture, mStateTm1Texture);
     mEnforceStateBoundary->Execute(mEngine, mStateTm1Texture);
     std::swap(mStateTm1Texture, mStateTTexture);
 
     mTime += mDt;
+
+    if (mReadbackLatency > 0)
+    {
+        Readback();
+    }
+}
+
+void GPUFluid3::SetReadbackLatency(int latency)
+{
+    mReadbackLatency = std::max(latency, 0);
+    mNumStaged = 0;
+    mReadback.clear();
+    mReadbackTimes.clear();
+    mReadbackState = nullptr;
+    mReadbackTime = 0.0f;
+
+    if (mReadbackLatency > 0)
+    {
+        size_t const numSlots = static_cast<size_t>(mReadbackLatency) + 1;
+        mReadback.resize(numSlots);
+        mReadbackTimes.resize(numSlots);
+        for (auto& texture : mReadback)
+        {
+            texture = std::make_shared<Texture3>(mStateTTexture->GetFormat(),
+                mXSize, mYSize, mZSize);
+            texture->SetCopyType(Resource::COPY_STAGING_TO_CPU);
+        }
+    }
+}
+
+void GPUFluid3::Readback()
+{
+    // Snapshot the new state and stage it. The staging copy is executed by
+    // the GPU after the commands already submitted.
+    size_t const numSlots = mReadback.size();
+    size_t const slot = mNumStaged % numSlots;
+    mEngine->CopyGpuToGpu(mStateTTexture, mReadback[slot]);
+    mEngine->StageGpuToCpu(mReadback[slot]);
+    mReadbackTimes[slot] = mTime;
+
+    // The slot after it was staged 'latency' steps earlier.
+    if (mNumStaged >= static_cast<size_t>(mReadbackLatency))
+    {
+        size_t const oldest = (mNumStaged + 1) % numSlots;
+        mEngine->CopyStagingToCpu(mReadback[oldest]);
+        mReadbackState = mReadback[oldest];
+        mReadbackTime = mReadbackTimes[oldest];
+    }
+    ++mNumStaged;
 }
@@ -3,10 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
 #include <MathematicsGPU/GPUFluid3AdjustVelocity.h>
 #include <MathematicsGPU/GPUFluid3ComputeDivergence.h>
 #include <MathematicsGPU/GPUFluid3EnforceStateBoundary.h>
@@ -14,16 +15,32 @@
 #include <MathematicsGPU/GPUFluid3InitializeState.h>
 #include <MathematicsGPU/GPUFluid3SolvePoisson.h>
 #include <MathematicsGPU/GPUFluid3UpdateState.h>
+#include <vector>
 
 namespace gte
 {
     class GPUFluid3
     {
     public:
-        // Construction.  The (x,y,z) grid covers [0,1]^3.
+        // Construction.  The (x,y,z) grid covers [0,1]^3.  The Poisson
+        // equation of each step is solved by numPoissonIterations iterations
+        // of the specified method; see GPUFluid3SolvePoisson.h.
+        //
+        // When sparseBricks is true, the grid is partitioned into bricks of
+        // 8x8x8 texels and each step updates only the active bricks, those
+        // within one brick of a brick whose density or speed exceeds
+        // occupancyThreshold or that contains a source; see
+        // GPUFluid3ActiveBricks.h. The state is zero outside the active
+        // bricks. The textures remain dense, but the cost of a step is
+        // proportional to the number of active bricks, which is an
+        // advantage for smoke or liquid that occupies a small part of the
+        // domain. The multigrid Poisson solver remains dense.
         GPUFluid3(std::shared_ptr<GraphicsEngine> const& engine,
             std::shared_ptr<ProgramFactory> const& factory,
-            int xSize, int ySize, int zSize, float dt);
+            int xSize, int ySize, int zSize, float dt,
+            GPUFluid3SolvePoisson::Method poissonMethod = GPUFluid3SolvePoisson::Method::JACOBI,
+            int numPoissonIterations = 32, bool sparseBricks = false,
+            float occupancyThreshold = 1e-4f);
 
         void Initialize();
         void DoSimulationStep();
@@ -33,6 +50,37 @@ namespace gte
             return mStateTTexture;
         }
 
+        // Asynchronous readback of the state for sampling on the CPU. For a
+        // positive latency, each DoSimulationStep copies the new state on
+        // the GPU to one of latency+1 readback textures and enqueues the
+        // copy of that texture to its staging memory without waiting for
+        // the GPU. It then copies to CPU memory the readback texture staged
+        // 'latency' steps earlier, which the GPU normally has finished while
+        // the later steps were submitted. The simulation alternates between
+        // two state textures and never writes the readback textures, so the
+        // readback of the state of step n overlaps the simulation of the
+        // later steps. A latency of 0 (the default) disables the readback.
+        void SetReadbackLatency(int latency);
+
+        inline int GetReadbackLatency() const
+        {
+            return mReadbackLatency;
+        }
+
+        // The CPU copy of the state 'latency' steps before the current
+        // state and its simulation time. The texels are (velocity.xyz,
+        // density). The texture is null until 'latency' steps have been
+        // taken after SetReadbackLatency.
+        inline std::shared_ptr<Texture3> const& GetReadbackState() const
+        {
+            return mReadbackState;
+        }
+
+        inline float GetReadbackTime() const
+        {
+            return mReadbackTime;
+        }
+
     private:
         // Constructor inputs.
         std::shared_ptr<GraphicsEngine> mEngine;
@@ -43,6 +91,7 @@ namespace gte
         float mTime;
 
         std::shared_ptr<ConstantBuffer> mParameters;
+        std::shared_ptr<GPUFluid3ActiveBricks> mBricks;
         std::shared_ptr<GPUFluid3InitializeSource> mInitializeSource;
         std::shared_ptr<GPUFluid3InitializeState> mInitializeState;
         std::shared_ptr<GPUFluid3EnforceStateBoundary> mEnforceStateBoundary;
@@ -57,5 +106,16 @@ namespace gte
         std::shared_ptr<Texture3> mStateTp1Texture;
         std::shared_ptr<Texture3> mDivergenceTexture;
         std::shared_ptr<Texture3> mPoissonTexture;
+
+        // Support for the asynchronous readback. The state of step s is
+        // staged in mReadback[s % (latency + 1)].
+        void Readback();
+
+        int mReadbackLatency;
+        size_t mNumStaged;
+        std::vector<std::shared_ptr<Texture3>> mReadback;
+        std::vector<float> mReadbackTimes;
+        std::shared_ptr<Texture3> mReadbackState;
+        float mReadbackTime;
     };
 }
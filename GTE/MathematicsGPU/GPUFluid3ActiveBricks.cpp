@@ -0,0 +1,470 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
+#include <cstring>
+using namespace gte;
+
+GPUFluid3ActiveBricks::GPUFluid3ActiveBricks(
+    std::shared_ptr<ProgramFactory> const& factory,
+    int xSize, int ySize, int zSize, int numXThreads, int numYThreads,
+    int numZThreads, float threshold)
+    :
+    mNumXBricks(xSize / numXThreads),
+    mNumYBricks(ySize / numYThreads),
+    mNumZBricks(zSize / numZThreads),
+    mNumBricks(mNumXBricks * mNumYBricks * mNumZBricks),
+    mNumActivityGroups(static_cast<unsigned int>((mNumBricks + 63) / 64))
+{
+    LogAssert(mNumXBricks <= 1024 && mNumYBricks <= 1024 && mNumZBricks <= 1024,
+        "The brick coordinates must fit in 10 bits.");
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), false);
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->threshold = threshold;
+    parameters->padding[0] = 0.0f;
+    parameters->padding[1] = 0.0f;
+    parameters->padding[2] = 0.0f;
+    parameters->numBricks[0] = mNumXBricks;
+    parameters->numBricks[1] = mNumYBricks;
+    parameters->numBricks[2] = mNumZBricks;
+    parameters->numBricks[3] = mNumBricks;
+
+    unsigned int const numBricks = static_cast<unsigned int>(mNumBricks);
+    auto CreateBuffer = [](unsigned int numElements)
+    {
+        auto buffer = std::make_shared<StructuredBuffer>(numElements, sizeof(uint32_t));
+        buffer->SetUsage(Resource::SHADER_OUTPUT);
+        std::memset(buffer->GetData(), 0, buffer->GetNumBytes());
+        return buffer;
+    };
+
+    mOccupied = CreateBuffer(numBricks);
+    mActiveFlags = CreateBuffer(numBricks);
+    mActiveBricks = CreateBuffer(numBricks);
+    mRetiredBricks = CreateBuffer(numBricks);
+    mCounts = CreateBuffer(6);
+    mArguments = std::make_shared<IndirectArgumentsBuffer>(6);
+    auto arguments = mArguments->Get<uint32_t>();
+    arguments[0] = 0;
+    arguments[1] = 1;
+    arguments[2] = 1;
+    arguments[3] = 0;
+    arguments[4] = 1;
+    arguments[5] = 1;
+
+    int api = factory->GetAPI();
+    std::string const& texelSource = *msTexelSource[api];
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numXThreads);
+    factory->defines.Set("NUM_Y_THREADS", numYThreads);
+    factory->defines.Set("NUM_Z_THREADS", numZThreads);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        factory->defines.Set("USE_ACTIVE_BRICKS", i == 0 ? "0" : "1");
+        auto& occupancy = (i == 0 ? mOccupancyAll : mOccupancyActive);
+        occupancy = factory->CreateFromSource(texelSource + *msOccupancySource[api]);
+        if (occupancy)
+        {
+            auto cshader = occupancy->GetComputeShader();
+            cshader->Set("Bricks", mParameters);
+            cshader->Set("occupied", mOccupied);
+            if (i == 1)
+            {
+                cshader->Set("activeBricks", mActiveBricks);
+            }
+        }
+    }
+
+    mResetCounts = factory->CreateFromSource(*msResetCountsSource[api]);
+    if (mResetCounts)
+    {
+        mResetCounts->GetComputeShader()->Set("counts", mCounts);
+    }
+
+    mActivity = factory->CreateFromSource(*msActivitySource[api]);
+    if (mActivity)
+    {
+        auto cshader = mActivity->GetComputeShader();
+        cshader->Set("Bricks", mParameters);
+        cshader->Set("occupied", mOccupied);
+        cshader->Set("activeFlags", mActiveFlags);
+        cshader->Set("activeBricks", mActiveBricks);
+        cshader->Set("retiredBricks", mRetiredBricks);
+        cshader->Set("counts", mCounts);
+    }
+
+    // The clear programs process the list of retired bricks.
+    factory->defines.Set("USE_ACTIVE_BRICKS", "1");
+    for (int i = 0; i < 2; ++i)
+    {
+        factory->defines.Set("IMAGE_FORMAT", i == 0 ? "rgba32f" : "r32f");
+        factory->defines.Set("TEXEL_TYPE", i == 0 ? "float4" : "float");
+        auto& clear = (i == 0 ? mClearRGBA : mClearR);
+        clear = factory->CreateFromSource(texelSource + *msClearSource[api]);
+        if (clear)
+        {
+            clear->GetComputeShader()->Set("activeBricks", mRetiredBricks);
+        }
+    }
+
+    factory->PopDefines();
+}
+
+void GPUFluid3ActiveBricks::Initialize(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture3> const& state, std::shared_ptr<Texture3> const& source)
+{
+    auto cshader = mOccupancyAll->GetComputeShader();
+    cshader->Set("state", state);
+    cshader->Set("source", source);
+    engine->Execute(mOccupancyAll, mNumXBricks, mNumYBricks, mNumZBricks);
+    UpdateActiveBricks(engine);
+}
+
+void GPUFluid3ActiveBricks::Execute(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture3> const& state, std::shared_ptr<Texture3> const& source)
+{
+    auto cshader = mOccupancyActive->GetComputeShader();
+    cshader->Set("state", state);
+    cshader->Set("source", source);
+    engine->Execute(mOccupancyActive, mArguments, 0);
+    UpdateActiveBricks(engine);
+}
+
+void GPUFluid3ActiveBricks::ClearRetired(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture3> const& texture)
+{
+    auto const& clear = (texture->GetFormat() == DF_R32_FLOAT ? mClearR : mClearRGBA);
+    clear->GetComputeShader()->Set("target", texture);
+    engine->Execute(clear, mArguments, 3 * sizeof(uint32_t));
+}
+
+void GPUFluid3ActiveBricks::UpdateActiveBricks(std::shared_ptr<GraphicsEngine> const& engine)
+{
+    engine->Execute(mResetCounts, 1, 1, 1);
+    engine->Execute(mActivity, mNumActivityGroups, 1, 1);
+    engine->CopyGpuToGpu(mCounts, mArguments);
+}
+
+
+std::string const GPUFluid3ActiveBricks::msGLSLTexelSource =
+R"(
+#if USE_ACTIVE_BRICKS
+    buffer activeBricks { uint data[]; } activeBricksSB;
+
+    ivec3 GetTexel()
+    {
+        uint packed = activeBricksSB.data[gl_WorkGroupID.x];
+        ivec3 brick = ivec3(packed & 1023u, (packed >> 10) & 1023u, packed >> 20);
+        return brick * ivec3(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS) +
+            ivec3(gl_LocalInvocationID.xyz);
+    }
+#else
+    ivec3 GetTexel()
+    {
+        return ivec3(gl_GlobalInvocationID.xyz);
+    }
+#endif
+)";
+
+std::string const GPUFluid3ActiveBricks::msGLSLOccupancySource =
+R"(
+    uniform Bricks
+    {
+        vec4 threshold;     // (threshold, 0, 0, 0)
+        ivec4 numBricks;    // (numX, numY, numZ, numX*numY*numZ)
+    };
+
+    layout(rgba32f) uniform readonly image3D state;
+    layout(rgba32f) uniform readonly image3D source;
+    buffer occupied { uint data[]; } occupiedSB;
+
+    shared uint brickOccupied;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        if (gl_LocalInvocationIndex == 0u)
+        {
+            brickOccupied = 0u;
+        }
+        memoryBarrierShared();
+        barrier();
+
+        ivec3 c = GetTexel();
+        vec4 current = imageLoad(state, c);
+        vec4 src = imageLoad(source, c);
+        if (max(abs(current.w), length(current.xyz)) > threshold.x ||
+            any(notEqual(src, vec4(0.0f))))
+        {
+            atomicOr(brickOccupied, 1u);
+        }
+        memoryBarrierShared();
+        barrier();
+
+        if (gl_LocalInvocationIndex == 0u)
+        {
+            ivec3 brick = c / ivec3(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS);
+            occupiedSB.data[brick.x + numBricks.x * (brick.y + numBricks.y * brick.z)] = brickOccupied;
+        }
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msGLSLResetCountsSource =
+R"(
+    buffer counts { uint data[]; } countsSB;
+
+    layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        countsSB.data[0] = 0u;
+        countsSB.data[1] = 1u;
+        countsSB.data[2] = 1u;
+        countsSB.data[3] = 0u;
+        countsSB.data[4] = 1u;
+        countsSB.data[5] = 1u;
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msGLSLActivitySource =
+R"(
+    uniform Bricks
+    {
+        vec4 threshold;     // (threshold, 0, 0, 0)
+        ivec4 numBricks;    // (numX, numY, numZ, numX*numY*numZ)
+    };
+
+    buffer occupied { uint data[]; } occupiedSB;
+    buffer activeFlags { uint data[]; } activeFlagsSB;
+    buffer activeBricks { uint data[]; } activeBricksSB;
+    buffer retiredBricks { uint data[]; } retiredBricksSB;
+    buffer counts { uint data[]; } countsSB;
+
+    layout (local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int i = int(gl_GlobalInvocationID.x);
+        if (i < numBricks.w)
+        {
+            ivec3 brick = ivec3(i % numBricks.x, (i / numBricks.x) % numBricks.y,
+                i / (numBricks.x * numBricks.y));
+            ivec3 bmin = max(brick - 1, ivec3(0));
+            ivec3 bmax = min(brick + 1, numBricks.xyz - 1);
+
+            // A brick is active when it or one of its neighbors is occupied.
+            uint active = 0u;
+            for (int z = bmin.z; z <= bmax.z; ++z)
+            {
+                for (int y = bmin.y; y <= bmax.y; ++y)
+                {
+                    for (int x = bmin.x; x <= bmax.x; ++x)
+                    {
+                        active |= occupiedSB.data[x + numBricks.x * (y + numBricks.y * z)];
+                    }
+                }
+            }
+
+            uint packed = uint(brick.x) | (uint(brick.y) << 10) | (uint(brick.z) << 20);
+            if (active != 0u)
+            {
+                uint k = atomicAdd(countsSB.data[0], 1u);
+                activeBricksSB.data[k] = packed;
+            }
+            else if (activeFlagsSB.data[i] != 0u)
+            {
+                uint k = atomicAdd(countsSB.data[3], 1u);
+                retiredBricksSB.data[k] = packed;
+            }
+            activeFlagsSB.data[i] = active;
+        }
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msGLSLClearSource =
+R"(
+    layout(IMAGE_FORMAT) uniform writeonly image3D target;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        imageStore(target, GetTexel(), vec4(0.0f));
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msHLSLTexelSource =
+R"(
+#if USE_ACTIVE_BRICKS
+    StructuredBuffer<uint> activeBricks;
+
+    uint3 GetTexel(uint3 groupID, uint3 threadID)
+    {
+        uint packed = activeBricks[groupID.x];
+        uint3 brick = uint3(packed & 1023, (packed >> 10) & 1023, packed >> 20);
+        return brick * uint3(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS) + threadID;
+    }
+#else
+    uint3 GetTexel(uint3 groupID, uint3 threadID)
+    {
+        return groupID * uint3(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS) + threadID;
+    }
+#endif
+)";
+
+std::string const GPUFluid3ActiveBricks::msHLSLOccupancySource =
+R"(
+    cbuffer Bricks
+    {
+        float4 threshold;   // (threshold, 0, 0, 0)
+        int4 numBricks;     // (numX, numY, numZ, numX*numY*numZ)
+    };
+
+    Texture3D<float4> state;
+    Texture3D<float4> source;
+    RWStructuredBuffer<uint> occupied;
+
+    groupshared uint brickOccupied;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID,
+        uint index : SV_GroupIndex)
+    {
+        if (index == 0)
+        {
+            brickOccupied = 0;
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        uint3 c = GetTexel(groupID, threadID);
+        float4 current = state[c];
+        float4 src = source[c];
+        if (max(abs(current.w), length(current.xyz)) > threshold.x || any(src != 0.0f))
+        {
+            InterlockedOr(brickOccupied, 1);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        if (index == 0)
+        {
+            int3 brick = int3(c / uint3(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS));
+            occupied[brick.x + numBricks.x * (brick.y + numBricks.y * brick.z)] = brickOccupied;
+        }
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msHLSLResetCountsSource =
+R"(
+    RWStructuredBuffer<uint> counts;
+
+    [numthreads(1, 1, 1)]
+    void CSMain()
+    {
+        counts[0] = 0;
+        counts[1] = 1;
+        counts[2] = 1;
+        counts[3] = 0;
+        counts[4] = 1;
+        counts[5] = 1;
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msHLSLActivitySource =
+R"(
+    cbuffer Bricks
+    {
+        float4 threshold;   // (threshold, 0, 0, 0)
+        int4 numBricks;     // (numX, numY, numZ, numX*numY*numZ)
+    };
+
+    StructuredBuffer<uint> occupied;
+    RWStructuredBuffer<uint> activeFlags;
+    RWStructuredBuffer<uint> activeBricks;
+    RWStructuredBuffer<uint> retiredBricks;
+    RWStructuredBuffer<uint> counts;
+
+    [numthreads(64, 1, 1)]
+    void CSMain(uint3 t : SV_DispatchThreadID)
+    {
+        int i = int(t.x);
+        if (i < numBricks.w)
+        {
+            int3 brick = int3(i % numBricks.x, (i / numBricks.x) % numBricks.y,
+                i / (numBricks.x * numBricks.y));
+            int3 bmin = max(brick - 1, int3(0, 0, 0));
+            int3 bmax = min(brick + 1, numBricks.xyz - 1);
+
+            // A brick is active when it or one of its neighbors is occupied.
+            uint active = 0;
+            for (int z = bmin.z; z <= bmax.z; ++z)
+            {
+                for (int y = bmin.y; y <= bmax.y; ++y)
+                {
+                    for (int x = bmin.x; x <= bmax.x; ++x)
+                    {
+                        active |= occupied[x + numBricks.x * (y + numBricks.y * z)];
+                    }
+                }
+            }
+
+            uint packed = uint(brick.x) | (uint(brick.y) << 10) | (uint(brick.z) << 20);
+            uint k;
+            if (active != 0)
+            {
+                InterlockedAdd(counts[0], 1, k);
+                activeBricks[k] = packed;
+            }
+            else if (activeFlags[i] != 0)
+            {
+                InterlockedAdd(counts[3], 1, k);
+                retiredBricks[k] = packed;
+            }
+            activeFlags[i] = active;
+        }
+    }
+)";
+
+std::string const GPUFluid3ActiveBricks::msHLSLClearSource =
+R"(
+    RWTexture3D<TEXEL_TYPE> target;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
+    {
+        target[GetTexel(groupID, threadID)] = (TEXEL_TYPE)0;
+    }
+)";
+
+ProgramSources const GPUFluid3ActiveBricks::msTexelSource =
+{
+    &msGLSLTexelSource,
+    &msHLSLTexelSource
+};
+
+ProgramSources const GPUFluid3ActiveBricks::msOccupancySource =
+{
+    &msGLSLOccupancySource,
+    &msHLSLOccupancySource
+};
+
+ProgramSources const GPUFluid3ActiveBricks::msResetCountsSource =
+{
+    &msGLSLResetCountsSource,
+    &msHLSLResetCountsSource
+};
+
+ProgramSources const GPUFluid3ActiveBricks::msActivitySource =
+{
+    &msGLSLActivitySource,
+    &msHLSLActivitySource
+};
+
+ProgramSources const GPUFluid3ActiveBricks::msClearSource =
+{
+    &msGLSLClearSource,
+    &msHLSLClearSource
+};
@@ -0,0 +1,139 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/IndirectArgumentsBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+#include <Graphics/Texture3.h>
+
+// Support for the sparse-brick mode of GPUFluid3. The grid is partitioned
+// into bricks of numXThreads-by-numYThreads-by-numZThreads texels, so a
+// brick is processed by one thread group. A brick is occupied when the
+// density or the speed of one of its texels exceeds a threshold or when one
+// of its source texels is not zero. A brick is active when it or one of its
+// 26 neighbors is occupied; the margin of one brick contains the fluid that
+// flows out of the occupied bricks during a step, which requires the
+// advection to move less than a brick per step. The kernels of the
+// simulation are dispatched by GraphicsEngine::Execute with the indirect
+// arguments GetArguments() at offset 0, one thread group per active brick.
+//
+// The occupancy is computed only for the active bricks; an inactive brick
+// has no occupied neighbor, so its occupancy is zero. The bricks that were
+// active in the previous step but no longer are, the retired bricks, must be
+// zeroed in every texture that the simulation reads outside the active
+// bricks, which is done by ClearRetired. The active bricks are listed in an
+// arbitrary order determined by the GPU.
+
+namespace gte
+{
+    class GPUFluid3ActiveBricks
+    {
+    public:
+        // Construction. The grid sizes must be multiples of the numbers of
+        // threads, and the threshold applies to the density and to the
+        // length of the velocity.
+        GPUFluid3ActiveBricks(std::shared_ptr<ProgramFactory> const& factory,
+            int xSize, int ySize, int zSize, int numXThreads, int numYThreads,
+            int numZThreads, float threshold);
+
+        // Member access. GetActiveBricks() is the list bound to the
+        // "activeBricks" buffer of the kernels compiled with
+        // USE_ACTIVE_BRICKS set to 1. The arguments at offset 0 are the
+        // dispatch arguments for the active bricks.
+        inline std::shared_ptr<StructuredBuffer> const& GetActiveBricks() const
+        {
+            return mActiveBricks;
+        }
+
+        inline std::shared_ptr<IndirectArgumentsBuffer> const& GetArguments() const
+        {
+            return mArguments;
+        }
+
+        inline int GetNumBricks() const
+        {
+            return mNumBricks;
+        }
+
+        // Compute the occupancy of all the bricks and the active bricks for
+        // the initial state.
+        void Initialize(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture3> const& state, std::shared_ptr<Texture3> const& source);
+
+        // Update the active and retired bricks for the current state. The
+        // occupancy is computed for the bricks that were active.
+        void Execute(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture3> const& state, std::shared_ptr<Texture3> const& source);
+
+        // Set the texels of the retired bricks of the texture to zero. The
+        // format must be DF_R32G32B32A32_FLOAT or DF_R32_FLOAT.
+        void ClearRetired(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture3> const& texture);
+
+        // Kernel support. The source is prepended to the source of a kernel
+        // whose thread groups are bricks. It defines a function GetTexel()
+        // in GLSL and GetTexel(groupID, groupThreadID) in HLSL that returns
+        // the texel of the thread. When USE_ACTIVE_BRICKS is 1, the group
+        // x-index is the index of a brick in the list "activeBricks";
+        // otherwise, the dispatch is dense.
+        static ProgramSources const msTexelSource;
+
+    private:
+        // The layout of the constant buffer "Bricks". The brick coordinates
+        // are packed into a 32-bit value with 10 bits per coordinate.
+        struct Parameters
+        {
+            float threshold;
+            float padding[3];
+            int32_t numBricks[4];  // (numX, numY, numZ, numX*numY*numZ)
+        };
+
+        void UpdateActiveBricks(std::shared_ptr<GraphicsEngine> const& engine);
+
+        int mNumXBricks, mNumYBricks, mNumZBricks, mNumBricks;
+        unsigned int mNumActivityGroups;
+        std::shared_ptr<ConstantBuffer> mParameters;
+
+        // The brick occupancy and activity flags, the lists of active and
+        // retired bricks and their counts. The counts are stored as the
+        // dispatch arguments (numActive, 1, 1, numRetired, 1, 1) and copied
+        // to mArguments.
+        std::shared_ptr<StructuredBuffer> mOccupied;
+        std::shared_ptr<StructuredBuffer> mActiveFlags;
+        std::shared_ptr<StructuredBuffer> mActiveBricks;
+        std::shared_ptr<StructuredBuffer> mRetiredBricks;
+        std::shared_ptr<StructuredBuffer> mCounts;
+        std::shared_ptr<IndirectArgumentsBuffer> mArguments;
+
+        std::shared_ptr<ComputeProgram> mOccupancyAll;
+        std::shared_ptr<ComputeProgram> mOccupancyActive;
+        std::shared_ptr<ComputeProgram> mResetCounts;
+        std::shared_ptr<ComputeProgram> mActivity;
+        std::shared_ptr<ComputeProgram> mClearRGBA;
+        std::shared_ptr<ComputeProgram> mClearR;
+
+        // Shader source code as strings.
+        static std::string const msGLSLTexelSource;
+        static std::string const msGLSLOccupancySource;
+        static std::string const msGLSLResetCountsSource;
+        static std::string const msGLSLActivitySource;
+        static std::string const msGLSLClearSource;
+        static std::string const msHLSLTexelSource;
+        static std::string const msHLSLOccupancySource;
+        static std::string const msHLSLResetCountsSource;
+        static std::string const msHLSLActivitySource;
+        static std::string const msHLSLClearSource;
+        static ProgramSources const msOccupancySource;
+        static ProgramSources const msResetCountsSource;
+        static ProgramSources const msActivitySource;
+        static ProgramSources const msClearSource;
+    };
+}
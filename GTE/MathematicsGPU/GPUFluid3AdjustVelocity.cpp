@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid3AdjustVelocity.h>
@@ -11,22 +11,31 @@ using namespace gte;
 
 GPUFluid3AdjustVelocity::GPUFluid3AdjustVelocity(std::shared_ptr<ProgramFactory> const& factory,
     int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-    std::shared_ptr<ConstantBuffer> const& parameters)
+    std::shared_ptr<ConstantBuffer> const& parameters,
+    std::shared_ptr<GPUFluid3ActiveBricks> const& bricks)
     :
     mNumXGroups(xSize / numXThreads),
     mNumYGroups(ySize / numYThreads),
-    mNumZGroups(zSize / numZThreads)
+    mNumZGroups(zSize / numZThreads),
+    mBricks(bricks)
 {
     int api = factory->GetAPI();
     factory->PushDefines();
     factory->defines.Set("NUM_X_THREADS", numXThreads);
     factory->defines.Set("NUM_Y_THREADS", numYThreads);
     factory->defines.Set("NUM_Z_THREADS", numZThreads);
+    factory->defines.Set("USE_ACTIVE_BRICKS", mBricks ? "1" : "0");
 
-    mAdjustVelocity = factory->CreateFromSource(*msSource[api]);
+    mAdjustVelocity = factory->CreateFromSource(
+        *GPUFluid3ActiveBricks::msTexelSource[api] + *msSource[api]);
     if (mAdjustVelocity)
     {
-        mAdjustVelocity->GetComputeShader()->Set("Parameters", parameters);
+        auto cshader = mAdjustVelocity->GetComputeShader();
+        cshader->Set("Parameters", parameters);
+        if (mBricks)
+        {
+            cshader->Set("activeBricks", mBricks->GetActiveBricks());
+        }
     }
 
     factory->PopDefines();
@@ -41,7 +50,14 @@ void GPUFluid3AdjustVelocity::Execute(std::shared_ptr<GraphicsEngine> const& eng
     cshader->Set("inState", inState);
     cshader->Set("poisson", poisson);
     cshader->Set("outState", outState);
-    engine->Execute(mAdjustVelocity, mNumXGroups, mNumYGroups, mNumZGroups);
+    if (mBricks)
+    {
+        engine->Execute(mAdjustVelocity, mBricks->GetArguments(), 0);
+    }
+    else
+    {
+        engine->Execute(mAdjustVelocity, mNumXGroups, mNumYGroups, mNumZGroups);
+    }
 }
 
 
@@ -65,7 +81,7 @@ R"(
     layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
     void main()
     {
-        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 c = GetTexel();
         ivec3 dim = imageSize(inState);
 
         int x = int(c.x);
@@ -112,8 +128,9 @@ R"(
     RWTexture3D<float4> outState;
 
     [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
-    void CSMain(uint3 c : SV_DispatchThreadID)
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
     {
+        uint3 c = GetTexel(groupID, threadID);
         uint3 dim;
         inState.GetDimensions(dim.x, dim.y, dim.z);
 
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <MathematicsGPU/GPUFluid3Parameters.h>
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
 #include <Graphics/GraphicsEngine.h>
 #include <Graphics/ProgramFactory.h>
 #include <Graphics/ConstantBuffer.h>
@@ -19,10 +20,12 @@ namespace gte
     {
     public:
         // Construction.  Adjust the velocities using the solution to the
-        // Poisson equation.
+        // Poisson equation.  When 'bricks' is not null, only the velocities
+        // of the active bricks are adjusted.
         GPUFluid3AdjustVelocity(std::shared_ptr<ProgramFactory> const& factory,
             int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-            std::shared_ptr<ConstantBuffer> const& parameters);
+            std::shared_ptr<ConstantBuffer> const& parameters,
+            std::shared_ptr<GPUFluid3ActiveBricks> const& bricks = nullptr);
 
         // Update the state for the fluid simulation.
         void Execute(std::shared_ptr<GraphicsEngine> const& engine,
@@ -32,6 +35,7 @@ namespace gte
 
     private:
         int mNumXGroups, mNumYGroups, mNumZGroups;
+        std::shared_ptr<GPUFluid3ActiveBricks> mBricks;
         std::shared_ptr<ComputeProgram> mAdjustVelocity;
 
         // Shader source code as strings.
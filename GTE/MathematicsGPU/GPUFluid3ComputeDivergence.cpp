@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid3ComputeDivergence.h>
@@ -12,11 +12,13 @@ using namespace gte;
 GPUFluid3ComputeDivergence::GPUFluid3ComputeDivergence(
     std::shared_ptr<ProgramFactory> const& factory,
     int xSize, int ySize, int zSize, int numXThreads, int numYThreads,
-    int numZThreads, std::shared_ptr<ConstantBuffer> const& parameters)
+    int numZThreads, std::shared_ptr<ConstantBuffer> const& parameters,
+    std::shared_ptr<GPUFluid3ActiveBricks> const& bricks)
     :
     mNumXGroups(xSize / numXThreads),
     mNumYGroups(ySize / numYThreads),
-    mNumZGroups(zSize / numZThreads)
+    mNumZGroups(zSize / numZThreads),
+    mBricks(bricks)
 {
     mDivergence = std::make_shared<Texture3>(DF_R32_FLOAT, xSize, ySize, zSize);
     mDivergence->SetUsage(Resource::SHADER_OUTPUT);
@@ -26,12 +28,18 @@ GPUFluid3ComputeDivergence::GPUFluid3ComputeDivergence(
     factory->defines.Set("NUM_X_THREADS", numXThreads);
     factory->defines.Set("NUM_Y_THREADS", numYThreads);
     factory->defines.Set("NUM_Z_THREADS", numZThreads);
-    mComputeDivergence = factory->CreateFromSource(*msSource[api]);
+    factory->defines.Set("USE_ACTIVE_BRICKS", mBricks ? "1" : "0");
+    mComputeDivergence = factory->CreateFromSource(
+        *GPUFluid3ActiveBricks::msTexelSource[api] + *msSource[api]);
     if (mComputeDivergence)
     {
         auto cshader = mComputeDivergence->GetComputeShader();
         cshader->Set("Parameters", parameters);
         cshader->Set("divergence", mDivergence);
+        if (mBricks)
+        {
+            cshader->Set("activeBricks", mBricks->GetActiveBricks());
+        }
     }
 
     factory->PopDefines();
@@ -42,7 +50,14 @@ void GPUFluid3ComputeDivergence::Execute(
     std::shared_ptr<Texture3> const& state)
 {
     mComputeDivergence->GetComputeShader()->Set("state", state);
-    engine->Execute(mComputeDivergence, mNumXGroups, mNumYGroups, mNumZGroups);
+    if (mBricks)
+    {
+        engine->Execute(mComputeDivergence, mBricks->GetArguments(), 0);
+    }
+    else
+    {
+        engine->Execute(mComputeDivergence, mNumXGroups, mNumYGroups, mNumZGroups);
+    }
 }
 
 
@@ -65,7 +80,7 @@ R"(
     layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
     void main()
     {
-        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 c = GetTexel();
         ivec3 dim = imageSize(state);
 
         int x = int(c.x);
@@ -107,8 +122,9 @@ R"(
     RWTexture3D<float> divergence;
 
     [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
-    void CSMain(uint3 c : SV_DispatchThreadID)
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
     {
+        uint3 c = GetTexel(groupID, threadID);
         uint3 dim;
         state.GetDimensions(dim.x, dim.y, dim.z);
 
@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <MathematicsGPU/GPUFluid2Parameters.h>
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
 #include <Graphics/GraphicsEngine.h>
 #include <Graphics/ProgramFactory.h>
 #include <Graphics/ConstantBuffer.h>
@@ -24,9 +25,12 @@ namespace gte
         //   dV/dx = (V(x+dx,y,z) - V(x-dx,y,z))/(2*dx)
         //   dV/dy = (V(x,y+dy,z) - V(x,y-dy,z))/(2*dy)
         //   dV/dz = (V(x,y,z+dz) - V(x,y,z-dz))/(2*dz)
+        // When 'bricks' is not null, the divergence is computed only for the
+        // active bricks.
         GPUFluid3ComputeDivergence(std::shared_ptr<ProgramFactory> const& factory,
             int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-            std::shared_ptr<ConstantBuffer> const& parameters);
+            std::shared_ptr<ConstantBuffer> const& parameters,
+            std::shared_ptr<GPUFluid3ActiveBricks> const& bricks = nullptr);
 
         // Member access.
         inline std::shared_ptr<Texture3> const& GetDivergence() const
@@ -41,6 +45,7 @@ namespace gte
 
     private:
         int mNumXGroups, mNumYGroups, mNumZGroups;
+        std::shared_ptr<GPUFluid3ActiveBricks> mBricks;
         std::shared_ptr<ComputeProgram> mComputeDivergence;
         std::shared_ptr<Texture3> mDivergence;
 
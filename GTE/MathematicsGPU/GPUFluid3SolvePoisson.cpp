@@ -3,21 +3,25 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid3SolvePoisson.h>
+#include <algorithm>
 using namespace gte;
 
 GPUFluid3SolvePoisson::GPUFluid3SolvePoisson(
     std::shared_ptr<ProgramFactory> const& factory,
     int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-    std::shared_ptr<ConstantBuffer> const& parameters, int numIterations)
+    std::shared_ptr<ConstantBuffer> const& parameters, int numIterations,
+    Method method, std::shared_ptr<GPUFluid3ActiveBricks> const& bricks)
     :
     mNumXGroups(xSize / numXThreads),
     mNumYGroups(ySize / numYThreads),
     mNumZGroups(zSize / numZThreads),
-    mNumIterations(numIterations)
+    mBricks(method == Method::JACOBI ? bricks : nullptr),
+    mNumIterations(numIterations),
+    mMethod(method)
 {
     mPoisson0 = std::make_shared<Texture3>(DF_R32_FLOAT, xSize, ySize, zSize);
     mPoisson0->SetUsage(Resource::SHADER_OUTPUT);
@@ -29,19 +33,31 @@ GPUFluid3SolvePoisson::GPUFluid3SolvePoisson(
     factory->defines.Set("NUM_X_THREADS", numXThreads);
     factory->defines.Set("NUM_Y_THREADS", numYThreads);
     factory->defines.Set("NUM_Z_THREADS", numZThreads);
+    factory->defines.Set("USE_ACTIVE_BRICKS", mBricks ? "1" : "0");
+    std::string const& texelSource = *GPUFluid3ActiveBricks::msTexelSource[api];
 
     // For zeroing mPoisson0 on the GPU.
-    mZeroPoisson = factory->CreateFromSource(*msPoissonZeroSource[api]);
+    mZeroPoisson = factory->CreateFromSource(texelSource + *msPoissonZeroSource[api]);
     if (mZeroPoisson)
     {
-        mZeroPoisson->GetComputeShader()->Set("poisson", mPoisson0);
+        auto cshader = mZeroPoisson->GetComputeShader();
+        cshader->Set("poisson", mPoisson0);
+        if (mBricks)
+        {
+            cshader->Set("activeBricks", mBricks->GetActiveBricks());
+        }
     }
 
     // Create the shader for generating velocity from vortices.
-    mSolvePoisson = factory->CreateFromSource(*msPoissonSolveSource[api]);
+    mSolvePoisson = factory->CreateFromSource(texelSource + *msPoissonSolveSource[api]);
     if (mSolvePoisson)
     {
-        mSolvePoisson->GetComputeShader()->Set("Parameters", parameters);
+        auto cshader = mSolvePoisson->GetComputeShader();
+        cshader->Set("Parameters", parameters);
+        if (mBricks)
+        {
+            cshader->Set("activeBricks", mBricks->GetActiveBricks());
+        }
     }
 
     factory->defines.Clear();
@@ -63,11 +79,102 @@ GPUFluid3SolvePoisson::GPUFluid3SolvePoisson(
     mWriteZFace = factory->CreateFromSource(*msPoissonEnforceBoundarySource[api]);
 
     factory->PopDefines();
+
+    if (mMethod == Method::MULTIGRID)
+    {
+        CreateMultigrid(factory, numXThreads, numYThreads, numZThreads, parameters);
+    }
 }
 
 void GPUFluid3SolvePoisson::Execute(
     std::shared_ptr<GraphicsEngine> const& engine,
     std::shared_ptr<Texture3> const& divergence)
+{
+    if (mMethod == Method::MULTIGRID)
+    {
+        ExecuteMultigrid(engine, divergence);
+    }
+    else
+    {
+        ExecuteJacobi(engine, divergence);
+    }
+}
+
+void GPUFluid3SolvePoisson::CreateMultigrid(std::shared_ptr<ProgramFactory> const& factory,
+    int numXThreads, int numYThreads, int numZThreads,
+    std::shared_ptr<ConstantBuffer> const& parameters)
+{
+    // The level sizes are not necessarily multiples of the numbers of
+    // threads, so the kernels test whether their texels are in the grid.
+    // The Poisson equation of level l has grid spacing
+    // (2^l*dx, 2^l*dy, 2^l*dz), so the epsilon0 term of the Jacobi step is
+    // scaled by 4^l.
+    Vector4<float> epsilon = parameters->Get<GPUFluid3Parameters>()->epsilon;
+    int xSize = mPoisson0->GetWidth(), ySize = mPoisson0->GetHeight();
+    int zSize = mPoisson0->GetThickness();
+    for (;;)
+    {
+        Level level;
+        level.xSize = xSize;
+        level.ySize = ySize;
+        level.zSize = zSize;
+        level.numXGroups = (xSize + numXThreads - 1) / numXThreads;
+        level.numYGroups = (ySize + numYThreads - 1) / numYThreads;
+        level.numZGroups = (zSize + numZThreads - 1) / numZThreads;
+        level.parameters = std::make_shared<ConstantBuffer>(sizeof(Vector4<float>), false);
+        *level.parameters->Get<Vector4<float>>() = epsilon;
+        if (mLevels.size() == 0)
+        {
+            level.poisson = mPoisson0;
+        }
+        else
+        {
+            level.poisson = std::make_shared<Texture3>(DF_R32_FLOAT, xSize, ySize, zSize);
+            level.poisson->SetUsage(Resource::SHADER_OUTPUT);
+            level.divergence = std::make_shared<Texture3>(DF_R32_FLOAT, xSize, ySize, zSize);
+            level.divergence->SetUsage(Resource::SHADER_OUTPUT);
+        }
+
+        bool coarsest = (xSize < 5 || ySize < 5 || zSize < 5);
+        if (!coarsest)
+        {
+            level.residual = std::make_shared<Texture3>(DF_R32_FLOAT, xSize, ySize, zSize);
+            level.residual->SetUsage(Resource::SHADER_OUTPUT);
+        }
+        mLevels.push_back(level);
+        if (coarsest)
+        {
+            break;
+        }
+
+        xSize = xSize / 2 + 1;
+        ySize = ySize / 2 + 1;
+        zSize = zSize / 2 + 1;
+        epsilon[3] *= 4.0f;
+    }
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numXThreads);
+    factory->defines.Set("NUM_Y_THREADS", numYThreads);
+    factory->defines.Set("NUM_Z_THREADS", numZThreads);
+    factory->defines.Set("PARITY", "0");
+    mSmoothRed = factory->CreateFromSource(*msPoissonSmoothSource[api]);
+    factory->defines.Set("PARITY", "1");
+    mSmoothBlack = factory->CreateFromSource(*msPoissonSmoothSource[api]);
+    factory->defines.Clear();
+    factory->defines.Set("NUM_X_THREADS", numXThreads);
+    factory->defines.Set("NUM_Y_THREADS", numYThreads);
+    factory->defines.Set("NUM_Z_THREADS", numZThreads);
+    mResidual = factory->CreateFromSource(*msPoissonResidualSource[api]);
+    mRestrict = factory->CreateFromSource(*msPoissonRestrictSource[api]);
+    mProlongate = factory->CreateFromSource(*msPoissonProlongateSource[api]);
+    factory->PopDefines();
+}
+
+void GPUFluid3SolvePoisson::ExecuteJacobi(
+    std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture3> const& divergence)
 {
     auto solve = mSolvePoisson->GetComputeShader();
     auto xwrite = mWriteXFace->GetComputeShader();
@@ -75,13 +182,32 @@ void GPUFluid3SolvePoisson::Execute(
     auto zwrite = mWriteZFace->GetComputeShader();
 
     solve->Set("divergence", divergence);
-    engine->Execute(mZeroPoisson, mNumXGroups, mNumYGroups, mNumZGroups);
+    if (mBricks)
+    {
+        // The solver reads the texels of the neighboring inactive bricks,
+        // which must be zero.
+        mBricks->ClearRetired(engine, mPoisson0);
+        mBricks->ClearRetired(engine, mPoisson1);
+        engine->Execute(mZeroPoisson, mBricks->GetArguments(), 0);
+    }
+    else
+    {
+        engine->Execute(mZeroPoisson, mNumXGroups, mNumYGroups, mNumZGroups);
+    }
+
     for (int i = 0; i < mNumIterations; ++i)
     {
         // Take one step of the Poisson solver.
         solve->Set("poisson", mPoisson0);
         solve->Set("outPoisson", mPoisson1);
-        engine->Execute(mSolvePoisson, mNumXGroups, mNumYGroups, mNumZGroups);
+        if (mBricks)
+        {
+            engine->Execute(mSolvePoisson, mBricks->GetArguments(), 0);
+        }
+        else
+        {
+            engine->Execute(mSolvePoisson, mNumXGroups, mNumYGroups, mNumZGroups);
+        }
 
         // Set the boundary to zero.
         xwrite->Set("image", mPoisson1);
@@ -95,6 +221,88 @@ void GPUFluid3SolvePoisson::Execute(
     }
 }
 
+void GPUFluid3SolvePoisson::ExecuteMultigrid(
+    std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<Texture3> const& divergence)
+{
+    auto zero = mZeroPoisson->GetComputeShader();
+    auto residual = mResidual->GetComputeShader();
+    auto restriction = mRestrict->GetComputeShader();
+    auto prolongate = mProlongate->GetComputeShader();
+    size_t const numLevels = mLevels.size();
+
+    zero->Set("poisson", mPoisson0);
+    engine->Execute(mZeroPoisson, mLevels[0].numXGroups, mLevels[0].numYGroups,
+        mLevels[0].numZGroups);
+    for (int i = 0; i < mNumIterations; ++i)
+    {
+        // Smooth the error and restrict the residual to the coarser levels.
+        // The coarse-level solutions are corrections, so they start at zero.
+        for (size_t l = 0; l + 1 < numLevels; ++l)
+        {
+            Level const& level = mLevels[l];
+            auto const& rhs = (l == 0 ? divergence : level.divergence);
+            if (l > 0)
+            {
+                zero->Set("poisson", level.poisson);
+                engine->Execute(mZeroPoisson, level.numXGroups, level.numYGroups,
+                    level.numZGroups);
+            }
+            Smooth(engine, level, rhs, msNumSmoothingSweeps);
+
+            residual->Set("Level", level.parameters);
+            residual->Set("divergence", rhs);
+            residual->Set("poisson", level.poisson);
+            residual->Set("residual", level.residual);
+            engine->Execute(mResidual, level.numXGroups, level.numYGroups,
+                level.numZGroups);
+
+            Level const& coarse = mLevels[l + 1];
+            restriction->Set("residual", level.residual);
+            restriction->Set("coarseDivergence", coarse.divergence);
+            engine->Execute(mRestrict, coarse.numXGroups, coarse.numYGroups,
+                coarse.numZGroups);
+        }
+
+        Level const& coarsest = mLevels.back();
+        zero->Set("poisson", coarsest.poisson);
+        engine->Execute(mZeroPoisson, coarsest.numXGroups, coarsest.numYGroups,
+            coarsest.numZGroups);
+        Smooth(engine, coarsest, coarsest.divergence,
+            std::max({ coarsest.xSize, coarsest.ySize, coarsest.zSize }));
+
+        // Add the interpolated corrections and smooth the error.
+        for (size_t l = numLevels - 1; l > 0; --l)
+        {
+            Level const& level = mLevels[l - 1];
+            prolongate->Set("coarsePoisson", mLevels[l].poisson);
+            prolongate->Set("poisson", level.poisson);
+            engine->Execute(mProlongate, level.numXGroups, level.numYGroups,
+                level.numZGroups);
+            Smooth(engine, level, (l == 1 ? divergence : level.divergence),
+                msNumSmoothingSweeps);
+        }
+    }
+}
+
+void GPUFluid3SolvePoisson::Smooth(std::shared_ptr<GraphicsEngine> const& engine,
+    Level const& level, std::shared_ptr<Texture3> const& divergence, int numSweeps)
+{
+    for (auto const& program : { mSmoothRed, mSmoothBlack })
+    {
+        auto cshader = program->GetComputeShader();
+        cshader->Set("Level", level.parameters);
+        cshader->Set("divergence", divergence);
+        cshader->Set("poisson", level.poisson);
+    }
+
+    for (int i = 0; i < numSweeps; ++i)
+    {
+        engine->Execute(mSmoothRed, level.numXGroups, level.numYGroups, level.numZGroups);
+        engine->Execute(mSmoothBlack, level.numXGroups, level.numYGroups, level.numZGroups);
+    }
+}
+
 
 std::string const GPUFluid3SolvePoisson::msGLSLPoissonZeroSource =
 R"(
@@ -103,7 +311,7 @@ R"(
     layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
     void main()
     {
-        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 c = GetTexel();
         imageStore(poisson, c, vec4(0.0f, 0.0f, 0.0f, 0.0f));
     }
 )";
@@ -128,7 +336,7 @@ R"(
     layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
     void main()
     {
-        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 c = GetTexel();
         ivec3 dim = imageSize(divergence);
 
         int x = int(c.x);
@@ -200,13 +408,161 @@ R"(
     #endif
 )";
 
+std::string const GPUFluid3SolvePoisson::msGLSLPoissonSmoothSource =
+R"(
+    uniform Level
+    {
+        vec4 epsilon;   // (epsilonX, epsilonY, epsilonZ, epsilon0) of the level
+    };
+
+    layout(r32f) uniform readonly image3D divergence;
+    layout(r32f) uniform image3D poisson;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        // Update the interior samples of one color of the red-black
+        // ordering. Their neighbors have the other color.
+        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 dim = imageSize(poisson);
+        if (all(greaterThan(c, ivec3(0))) && all(lessThan(c, dim - 1))
+            && ((c.x + c.y + c.z) & 1) == PARITY)
+        {
+            float div = imageLoad(divergence, c).x;
+            float poisPZZ = imageLoad(poisson, ivec3(c.x + 1, c.y, c.z)).x;
+            float poisMZZ = imageLoad(poisson, ivec3(c.x - 1, c.y, c.z)).x;
+            float poisZPZ = imageLoad(poisson, ivec3(c.x, c.y + 1, c.z)).x;
+            float poisZMZ = imageLoad(poisson, ivec3(c.x, c.y - 1, c.z)).x;
+            float poisZZP = imageLoad(poisson, ivec3(c.x, c.y, c.z + 1)).x;
+            float poisZZM = imageLoad(poisson, ivec3(c.x, c.y, c.z - 1)).x;
+
+            vec4 temp = vec4(poisPZZ + poisMZZ, poisZPZ + poisZMZ, poisZZP + poisZZM, div);
+            imageStore(poisson, c, vec4(dot(epsilon, temp), 0.0f, 0.0f, 0.0f));
+        }
+    }
+)";
+
+std::string const GPUFluid3SolvePoisson::msGLSLPoissonResidualSource =
+R"(
+    uniform Level
+    {
+        vec4 epsilon;   // (epsilonX, epsilonY, epsilonZ, epsilon0) of the level
+    };
+
+    layout(r32f) uniform readonly image3D divergence;
+    layout(r32f) uniform readonly image3D poisson;
+    layout(r32f) uniform writeonly image3D residual;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        // The residual is zero on the boundary.
+        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 dim = imageSize(poisson);
+        if (any(greaterThanEqual(c, dim)))
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (all(greaterThan(c, ivec3(0))) && all(lessThan(c, dim - 1)))
+        {
+            float div = imageLoad(divergence, c).x;
+            float pois = imageLoad(poisson, c).x;
+            float poisPZZ = imageLoad(poisson, ivec3(c.x + 1, c.y, c.z)).x;
+            float poisMZZ = imageLoad(poisson, ivec3(c.x - 1, c.y, c.z)).x;
+            float poisZPZ = imageLoad(poisson, ivec3(c.x, c.y + 1, c.z)).x;
+            float poisZMZ = imageLoad(poisson, ivec3(c.x, c.y - 1, c.z)).x;
+            float poisZZP = imageLoad(poisson, ivec3(c.x, c.y, c.z + 1)).x;
+            float poisZZM = imageLoad(poisson, ivec3(c.x, c.y, c.z - 1)).x;
+
+            vec3 temp = vec3(poisPZZ + poisMZZ, poisZPZ + poisZMZ, poisZZP + poisZZM);
+            value = div - (pois - dot(epsilon.xyz, temp)) / epsilon.w;
+        }
+        imageStore(residual, c, vec4(value, 0.0f, 0.0f, 0.0f));
+    }
+)";
+
+std::string const GPUFluid3SolvePoisson::msGLSLPoissonRestrictSource =
+R"(
+    layout(r32f) uniform readonly image3D residual;
+    layout(r32f) uniform writeonly image3D coarseDivergence;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        // Full weighting of the 3x3x3 fine samples centered at the fine
+        // sample 2*c. The weight of the sample at offset (dx,dy,dz) is the
+        // product of the 1D weights w[d] = (0.25, 0.5, 0.25)[d+1]. The
+        // right-hand side is zero on the boundary.
+        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 dim = imageSize(coarseDivergence);
+        if (any(greaterThanEqual(c, dim)))
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (all(greaterThan(c, ivec3(0))) && all(lessThan(c, dim - 1)))
+        {
+            ivec3 f = 2 * c;
+            for (int dz = -1; dz <= 1; ++dz)
+            {
+                float wz = (dz == 0 ? 0.5f : 0.25f);
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    float wyz = (dy == 0 ? 0.5f : 0.25f) * wz;
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        float w = (dx == 0 ? 0.5f : 0.25f) * wyz;
+                        value += w * imageLoad(residual, f + ivec3(dx, dy, dz)).x;
+                    }
+                }
+            }
+        }
+        imageStore(coarseDivergence, c, vec4(value, 0.0f, 0.0f, 0.0f));
+    }
+)";
+
+std::string const GPUFluid3SolvePoisson::msGLSLPoissonProlongateSource =
+R"(
+    layout(r32f) uniform readonly image3D coarsePoisson;
+    layout(r32f) uniform image3D poisson;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        // Add the trilinear interpolation of the coarse correction, whose
+        // sample k is at the fine sample 2*k. The boundary remains zero.
+        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 dim = imageSize(poisson);
+        if (all(greaterThan(c, ivec3(0))) && all(lessThan(c, dim - 1)))
+        {
+            ivec3 c0 = c >> 1;
+            ivec3 c1 = (c + 1) >> 1;
+            float correction = 0.125f * (
+                imageLoad(coarsePoisson, ivec3(c0.x, c0.y, c0.z)).x +
+                imageLoad(coarsePoisson, ivec3(c1.x, c0.y, c0.z)).x +
+                imageLoad(coarsePoisson, ivec3(c0.x, c1.y, c0.z)).x +
+                imageLoad(coarsePoisson, ivec3(c1.x, c1.y, c0.z)).x +
+                imageLoad(coarsePoisson, ivec3(c0.x, c0.y, c1.z)).x +
+                imageLoad(coarsePoisson, ivec3(c1.x, c0.y, c1.z)).x +
+                imageLoad(coarsePoisson, ivec3(c0.x, c1.y, c1.z)).x +
+                imageLoad(coarsePoisson, ivec3(c1.x, c1.y, c1.z)).x);
+            float value = imageLoad(poisson, c).x + correction;
+            imageStore(poisson, c, vec4(value, 0.0f, 0.0f, 0.0f));
+        }
+    }
+)";
+
 std::string const GPUFluid3SolvePoisson::msHLSLPoissonZeroSource =
 R"(
     RWTexture3D<float> poisson;
 
     [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
-    void CSMain(uint3 c : SV_DispatchThreadID)
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
     {
+        uint3 c = GetTexel(groupID, threadID);
         poisson[c.xyz] = 0.0f;
     }
 )";
@@ -229,8 +585,9 @@ R"(
     RWTexture3D<float> outPoisson;
 
     [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
-    void CSMain(uint3 c : SV_DispatchThreadID)
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
     {
+        uint3 c = GetTexel(groupID, threadID);
         uint3 dim;
         divergence.GetDimensions(dim.x, dim.y, dim.z);
 
@@ -302,6 +659,154 @@ R"(
     #endif
 )";
 
+std::string const GPUFluid3SolvePoisson::msHLSLPoissonSmoothSource =
+R"(
+    cbuffer Level
+    {
+        float4 epsilon;   // (epsilonX, epsilonY, epsilonZ, epsilon0) of the level
+    };
+
+    Texture3D<float> divergence;
+    RWTexture3D<float> poisson;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(int3 c : SV_DispatchThreadID)
+    {
+        // Update the interior samples of one color of the red-black
+        // ordering. Their neighbors have the other color.
+        uint3 dim;
+        poisson.GetDimensions(dim.x, dim.y, dim.z);
+        if (all(c > 0) && all(c < int3(dim) - 1) && ((c.x + c.y + c.z) & 1) == PARITY)
+        {
+            float div = divergence[c];
+            float poisPZZ = poisson[int3(c.x + 1, c.y, c.z)];
+            float poisMZZ = poisson[int3(c.x - 1, c.y, c.z)];
+            float poisZPZ = poisson[int3(c.x, c.y + 1, c.z)];
+            float poisZMZ = poisson[int3(c.x, c.y - 1, c.z)];
+            float poisZZP = poisson[int3(c.x, c.y, c.z + 1)];
+            float poisZZM = poisson[int3(c.x, c.y, c.z - 1)];
+
+            float4 temp = float4(poisPZZ + poisMZZ, poisZPZ + poisZMZ, poisZZP + poisZZM, div);
+            poisson[c] = dot(epsilon, temp);
+        }
+    }
+)";
+
+std::string const GPUFluid3SolvePoisson::msHLSLPoissonResidualSource =
+R"(
+    cbuffer Level
+    {
+        float4 epsilon;   // (epsilonX, epsilonY, epsilonZ, epsilon0) of the level
+    };
+
+    Texture3D<float> divergence;
+    Texture3D<float> poisson;
+    RWTexture3D<float> residual;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(int3 c : SV_DispatchThreadID)
+    {
+        // The residual is zero on the boundary.
+        uint3 dim;
+        poisson.GetDimensions(dim.x, dim.y, dim.z);
+        if (any(c >= int3(dim)))
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (all(c > 0) && all(c < int3(dim) - 1))
+        {
+            float div = divergence[c];
+            float pois = poisson[c];
+            float poisPZZ = poisson[int3(c.x + 1, c.y, c.z)];
+            float poisMZZ = poisson[int3(c.x - 1, c.y, c.z)];
+            float poisZPZ = poisson[int3(c.x, c.y + 1, c.z)];
+            float poisZMZ = poisson[int3(c.x, c.y - 1, c.z)];
+            float poisZZP = poisson[int3(c.x, c.y, c.z + 1)];
+            float poisZZM = poisson[int3(c.x, c.y, c.z - 1)];
+
+            float3 temp = float3(poisPZZ + poisMZZ, poisZPZ + poisZMZ, poisZZP + poisZZM);
+            value = div - (pois - dot(epsilon.xyz, temp)) / epsilon.w;
+        }
+        residual[c] = value;
+    }
+)";
+
+std::string const GPUFluid3SolvePoisson::msHLSLPoissonRestrictSource =
+R"(
+    Texture3D<float> residual;
+    RWTexture3D<float> coarseDivergence;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(int3 c : SV_DispatchThreadID)
+    {
+        // Full weighting of the 3x3x3 fine samples centered at the fine
+        // sample 2*c. The weight of the sample at offset (dx,dy,dz) is the
+        // product of the 1D weights w[d] = (0.25, 0.5, 0.25)[d+1]. The
+        // right-hand side is zero on the boundary.
+        uint3 dim;
+        coarseDivergence.GetDimensions(dim.x, dim.y, dim.z);
+        if (any(c >= int3(dim)))
+        {
+            return;
+        }
+
+        float value = 0.0f;
+        if (all(c > 0) && all(c < int3(dim) - 1))
+        {
+            int3 f = 2 * c;
+            [unroll]
+            for (int dz = -1; dz <= 1; ++dz)
+            {
+                float wz = (dz == 0 ? 0.5f : 0.25f);
+                [unroll]
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    float wyz = (dy == 0 ? 0.5f : 0.25f) * wz;
+                    [unroll]
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        float w = (dx == 0 ? 0.5f : 0.25f) * wyz;
+                        value += w * residual[f + int3(dx, dy, dz)];
+                    }
+                }
+            }
+        }
+        coarseDivergence[c] = value;
+    }
+)";
+
+std::string const GPUFluid3SolvePoisson::msHLSLPoissonProlongateSource =
+R"(
+    Texture3D<float> coarsePoisson;
+    RWTexture3D<float> poisson;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(int3 c : SV_DispatchThreadID)
+    {
+        // Add the trilinear interpolation of the coarse correction, whose
+        // sample k is at the fine sample 2*k. The boundary remains zero.
+        uint3 dim;
+        poisson.GetDimensions(dim.x, dim.y, dim.z);
+        if (all(c > 0) && all(c < int3(dim) - 1))
+        {
+            int3 c0 = c >> 1;
+            int3 c1 = (c + 1) >> 1;
+            float correction = 0.125f * (
+                coarsePoisson[int3(c0.x, c0.y, c0.z)] +
+                coarsePoisson[int3(c1.x, c0.y, c0.z)] +
+                coarsePoisson[int3(c0.x, c1.y, c0.z)] +
+                coarsePoisson[int3(c1.x, c1.y, c0.z)] +
+                coarsePoisson[int3(c0.x, c0.y, c1.z)] +
+                coarsePoisson[int3(c1.x, c0.y, c1.z)] +
+                coarsePoisson[int3(c0.x, c1.y, c1.z)] +
+                coarsePoisson[int3(c1.x, c1.y, c1.z)]);
+            poisson[c] += correction;
+        }
+    }
+)";
+
 ProgramSources const GPUFluid3SolvePoisson::msPoissonZeroSource =
 {
     &msGLSLPoissonZeroSource,
@@ -319,3 +824,27 @@ ProgramSources const GPUFluid3SolvePoisson::msPoissonEnforceBoundarySource =
     &msGLSLPoissonEnforceBoundarySource,
     &msHLSLPoissonEnforceBoundarySource
 };
+
+ProgramSources const GPUFluid3SolvePoisson::msPoissonSmoothSource =
+{
+    &msGLSLPoissonSmoothSource,
+    &msHLSLPoissonSmoothSource
+};
+
+ProgramSources const GPUFluid3SolvePoisson::msPoissonResidualSource =
+{
+    &msGLSLPoissonResidualSource,
+    &msHLSLPoissonResidualSource
+};
+
+ProgramSources const GPUFluid3SolvePoisson::msPoissonRestrictSource =
+{
+    &msGLSLPoissonRestrictSource,
+    &msHLSLPoissonRestrictSource
+};
+
+ProgramSources const GPUFluid3SolvePoisson::msPoissonProlongateSource =
+{
+    &msGLSLPoissonProlongateSource,
+    &msHLSLPoissonProlongateSource
+};
@@ -3,26 +3,47 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
 #include <MathematicsGPU/GPUFluid3Parameters.h>
 #include <Graphics/GraphicsEngine.h>
 #include <Graphics/ProgramFactory.h>
 #include <Graphics/ConstantBuffer.h>
 #include <Graphics/Texture3.h>
+#include <vector>
+
+// The Poisson equation is solved with zero boundary values by one of the
+// methods of GPUFluid2SolvePoisson. The multigrid method is the 3D version
+// of that of GPUFluid2SolvePoisson, with full weighting of the 3x3x3 fine
+// samples around a coarse sample for restriction and trilinear
+// interpolation for prolongation. The memory traffic of a V-cycle is about
+// that of 8 Jacobi iterations and its error reduction factor is
+// approximately 0.3 when the grid spacings are comparable.
 
 namespace gte
 {
     class GPUFluid3SolvePoisson
     {
     public:
-        // Construction.  Solve the Poisson equation where numIterations is the
-        // number of Gauss-Seidel steps to use in Execute.
+        enum class Method
+        {
+            JACOBI,
+            MULTIGRID
+        };
+
+        // Construction.  Solve the Poisson equation where numIterations is
+        // the number of Jacobi steps or multigrid V-cycles to use in
+        // Execute.  When 'bricks' is not null, the Jacobi method updates
+        // only the active bricks and the solution is zero elsewhere; the
+        // multigrid method ignores 'bricks'.
         GPUFluid3SolvePoisson(std::shared_ptr<ProgramFactory> const& factory,
             int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-            std::shared_ptr<ConstantBuffer> const& parameters, int numIterations);
+            std::shared_ptr<ConstantBuffer> const& parameters, int numIterations,
+            Method method = Method::JACOBI,
+            std::shared_ptr<GPUFluid3ActiveBricks> const& bricks = nullptr);
 
         // Member access.  The texels are (velocity.xyz, density).
         inline std::shared_ptr<gte::Texture3> const& GetPoisson() const
@@ -35,7 +56,33 @@ namespace gte
             std::shared_ptr<Texture3> const& divergence);
 
     private:
+        // A grid of the multigrid hierarchy. The right-hand side of level 0
+        // is the input divergence and its solution is mPoisson0.
+        struct Level
+        {
+            int xSize, ySize, zSize;
+            int numXGroups, numYGroups, numZGroups;
+            std::shared_ptr<ConstantBuffer> parameters;
+            std::shared_ptr<Texture3> poisson;
+            std::shared_ptr<Texture3> divergence;
+            std::shared_ptr<Texture3> residual;
+        };
+
+        void CreateMultigrid(std::shared_ptr<ProgramFactory> const& factory,
+            int numXThreads, int numYThreads, int numZThreads,
+            std::shared_ptr<ConstantBuffer> const& parameters);
+
+        void ExecuteJacobi(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture3> const& divergence);
+
+        void ExecuteMultigrid(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<Texture3> const& divergence);
+
+        void Smooth(std::shared_ptr<GraphicsEngine> const& engine, Level const& level,
+            std::shared_ptr<Texture3> const& divergence, int numSweeps);
+
         int mNumXGroups, mNumYGroups, mNumZGroups;
+        std::shared_ptr<GPUFluid3ActiveBricks> mBricks;
         std::shared_ptr<ComputeProgram> mZeroPoisson;
         std::shared_ptr<ComputeProgram> mSolvePoisson;
         std::shared_ptr<ComputeProgram> mWriteXFace;
@@ -44,6 +91,16 @@ namespace gte
         std::shared_ptr<Texture3> mPoisson0;
         std::shared_ptr<Texture3> mPoisson1;
         int mNumIterations;
+        Method mMethod;
+
+        // Support for the multigrid method.
+        std::vector<Level> mLevels;
+        std::shared_ptr<ComputeProgram> mSmoothRed;
+        std::shared_ptr<ComputeProgram> mSmoothBlack;
+        std::shared_ptr<ComputeProgram> mResidual;
+        std::shared_ptr<ComputeProgram> mRestrict;
+        std::shared_ptr<ComputeProgram> mProlongate;
+        static int const msNumSmoothingSweeps = 2;
 
         // Shader source code as strings.
         static std::string const msGLSLPoissonZeroSource;
@@ -52,9 +109,21 @@ namespace gte
         static std::string const msHLSLPoissonZeroSource;
         static std::string const msHLSLPoissonSolveSource;
         static std::string const msHLSLPoissonEnforceBoundarySource;
+        static std::string const msGLSLPoissonSmoothSource;
+        static std::string const msGLSLPoissonResidualSource;
+        static std::string const msGLSLPoissonRestrictSource;
+        static std::string const msGLSLPoissonProlongateSource;
+        static std::string const msHLSLPoissonSmoothSource;
+        static std::string const msHLSLPoissonResidualSource;
+        static std::string const msHLSLPoissonRestrictSource;
+        static std::string const msHLSLPoissonProlongateSource;
         static ProgramSources const msPoissonZeroSource;
         static ProgramSources const msPoissonSolveSource;
         static ProgramSources const msPoissonEnforceBoundarySource;
+        static ProgramSources const msPoissonSmoothSource;
+        static ProgramSources const msPoissonResidualSource;
+        static ProgramSources const msPoissonRestrictSource;
+        static ProgramSources const msPoissonProlongateSource;
     };
 }
 
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #include <MathematicsGPU/GTMathematicsGPUPCH.h>
 #include <MathematicsGPU/GPUFluid3UpdateState.h>
@@ -12,11 +12,13 @@ using namespace gte;
 GPUFluid3UpdateState::GPUFluid3UpdateState(
     std::shared_ptr<ProgramFactory> const& factory,
     int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-    std::shared_ptr<ConstantBuffer> const& parameters)
+    std::shared_ptr<ConstantBuffer> const& parameters,
+    std::shared_ptr<GPUFluid3ActiveBricks> const& bricks)
     :
     mNumXGroups(xSize / numXThreads),
     mNumYGroups(ySize / numYThreads),
-    mNumZGroups(zSize / numZThreads)
+    mNumZGroups(zSize / numZThreads),
+    mBricks(bricks)
 {
     mUpdateState = std::make_shared<Texture3>(DF_R32G32B32A32_FLOAT, xSize, ySize, zSize);
     mUpdateState->SetUsage(Resource::SHADER_OUTPUT);
@@ -33,13 +35,19 @@ GPUFluid3UpdateState::GPUFluid3UpdateState(
     factory->defines.Set("NUM_X_THREADS", numXThreads);
     factory->defines.Set("NUM_Y_THREADS", numYThreads);
     factory->defines.Set("NUM_Z_THREADS", numZThreads);
+    factory->defines.Set("USE_ACTIVE_BRICKS", mBricks ? "1" : "0");
 
-    mComputeUpdateState = factory->CreateFromSource(*msSource[api]);
+    mComputeUpdateState = factory->CreateFromSource(
+        *GPUFluid3ActiveBricks::msTexelSource[api] + *msSource[api]);
     if (mComputeUpdateState)
     {
         auto cshader = mComputeUpdateState->GetComputeShader();
         cshader->Set("Parameters", parameters);
         cshader->Set("updateState", mUpdateState);
+        if (mBricks)
+        {
+            cshader->Set("activeBricks", mBricks->GetActiveBricks());
+        }
     }
 
     factory->PopDefines();
@@ -55,7 +63,14 @@ void GPUFluid3UpdateState::Execute(
     cshader->Set("source", source);
     cshader->Set("stateTm1", stateTm1, "advectionSampler", mAdvectionSampler);
     cshader->Set("stateT", stateT);
-    engine->Execute(mComputeUpdateState, mNumXGroups, mNumYGroups, mNumZGroups);
+    if (mBricks)
+    {
+        engine->Execute(mComputeUpdateState, mBricks->GetArguments(), 0);
+    }
+    else
+    {
+        engine->Execute(mComputeUpdateState, mNumXGroups, mNumYGroups, mNumZGroups);
+    }
 }
 
 
@@ -80,7 +95,7 @@ R"(
     layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
     void main()
     {
-        ivec3 c = ivec3(gl_GlobalInvocationID.xyz);
+        ivec3 c = GetTexel();
         ivec3 dim = imageSize(stateT);
 
         int x = int(c.x);
@@ -141,8 +156,9 @@ R"(
     RWTexture3D<float4> updateState;
 
     [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
-    void CSMain(uint3 c : SV_DispatchThreadID)
+    void CSMain(uint3 groupID : SV_GroupID, uint3 threadID : SV_GroupThreadID)
     {
+        uint3 c = GetTexel(groupID, threadID);
         uint3 dim;
         stateT.GetDimensions(dim.x, dim.y, dim.z);
 
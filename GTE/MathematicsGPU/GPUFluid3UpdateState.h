@@ -3,11 +3,12 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2020.09.28
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <MathematicsGPU/GPUFluid3Parameters.h>
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
 #include <Graphics/GraphicsEngine.h>
 #include <Graphics/ProgramFactory.h>
 #include <Graphics/ConstantBuffer.h>
@@ -19,10 +20,12 @@ namespace gte
     class GPUFluid3UpdateState
     {
     public:
-        // Construction.
+        // Construction.  When 'bricks' is not null, the state is updated
+        // only for the active bricks.
         GPUFluid3UpdateState(std::shared_ptr<ProgramFactory> const& factory,
             int xSize, int ySize, int zSize, int numXThreads, int numYThreads, int numZThreads,
-            std::shared_ptr<ConstantBuffer> const& parameters);
+            std::shared_ptr<ConstantBuffer> const& parameters,
+            std::shared_ptr<GPUFluid3ActiveBricks> const& bricks = nullptr);
 
         // Member access.  The texels are (velocity.xyz, density).
         inline std::shared_ptr<Texture3> const& GetUpdateState() const
@@ -38,6 +41,7 @@ namespace gte
 
     private:
         int mNumXGroups, mNumYGroups, mNumZGroups;
+        std::shared_ptr<GPUFluid3ActiveBricks> mBricks;
         std::shared_ptr<ComputeProgram> mComputeUpdateState;
         std::shared_ptr<SamplerState> mAdvectionSampler;
         std::shared_ptr<Texture3> mUpdateState;
@@ -3,18 +3,29 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2021.04.25
+// Version: 4.0.2026.10.15
 
 #pragma once
 
 #include <Mathematics/GenerateMeshUV.h>
 #include <Graphics/GraphicsEngine.h>
 #include <Graphics/ProgramFactory.h>
+#include <array>
+#include <cstring>
 
 // Read the comments in Mathematics/GenerateMeshUV.h for information about
 // the algorithm.  The class GenerateMeshUV header file has a CPU-based
 // implementation.  The class GPUGenerateMeshUV derives from GenerateMeshUV
 // and provides a GPU-based implementation using DX11/HLSL or GL45/GLSL.
+//
+// The compute program and the buffers of the vertex graph persist between
+// calls of operator(). When the mesh is parameterized again with the same
+// number of vertices and edges, only the ranges of the graph buffers whose
+// elements changed are copied to the GPU, which after a small edit of the
+// vertices is a small part of the mean value weights. When a tolerance is
+// set, the iterations record whether a texture coordinate changed by more
+// than the tolerance, and the record is read back every
+// CONVERGENCE_CHECK_INTERVAL iterations.
 
 namespace gte
 {
@@ -33,10 +44,135 @@ namespace gte
         {
         }
 
+        enum { CONVERGENCE_CHECK_INTERVAL = 8 };
+
         virtual ~GPUGenerateMeshUV() = default;
 
     protected:
         virtual void SolveSystemInternal(uint32_t numIterations) override
+        {
+            if (!mSolveSystem)
+            {
+                CreateProgram();
+            }
+
+            // Compute the number of thread groups.
+            int numInputs = this->mNumVertices - this->mNumBoundaryEdges;
+            Real factor0 = std::ceil(std::sqrt((Real)numInputs));
+            Real factor1 = std::ceil((Real)numInputs / factor0);
+            int xElements = static_cast<int>(factor0);
+            int yElements = static_cast<int>(factor1);
+            int xRem = (xElements % 8);
+            if (xRem > 0)
+            {
+                xElements += 8 - xRem;
+            }
+            int yRem = (yElements % 8);
+            if (yRem > 0)
+            {
+                yElements += 8 - yRem;
+            }
+            uint32_t numXGroups = xElements / 8;
+            uint32_t numYGroups = yElements / 8;
+
+            auto bounds = mBoundsBuffer->Get<Bounds>();
+            bounds->bound[0] = xElements;
+            bounds->bound[1] = yElements;
+            bounds->numBoundaryEdges = this->mNumBoundaryEdges;
+            bounds->numInputs = numInputs;
+            bounds->tolerance = static_cast<float>(this->mTolerance);
+            bounds->checkChange = 0;
+            mEngine->Update(mBoundsBuffer);
+
+            // The graph buffers are created on the first call and when the
+            // numbers of vertices or edges change. Otherwise, only the
+            // elements that changed are copied to the GPU.
+            Upload(mVertexGraphBuffer, this->mVertexGraph);
+            Upload(mVertexGraphDataBuffer, this->mVertexGraphData);
+            Upload(mOrderedVerticesBuffer, this->mOrderedVertices);
+
+            // The texture coordinates are the initial guess of the solver,
+            // which is copied to both ping-pong buffers because the shader
+            // writes only the interior vertices.
+            for (size_t j = 0; j < 2; ++j)
+            {
+                auto& buffer = mTCoordsBuffer[j];
+                if (!buffer || buffer->GetNumElements() != static_cast<unsigned int>(this->mNumVertices))
+                {
+                    buffer = std::make_shared<StructuredBuffer>(this->mNumVertices, sizeof(Vector2<Real>));
+                    buffer->SetUsage(Resource::SHADER_OUTPUT);
+                    buffer->SetCopyType(Resource::COPY_BIDIRECTIONAL);
+                    std::memcpy(buffer->GetData(), this->mTCoords, buffer->GetNumBytes());
+                }
+                else
+                {
+                    std::memcpy(buffer->GetData(), this->mTCoords, buffer->GetNumBytes());
+                    mEngine->CopyCpuToGpu(buffer);
+                }
+            }
+
+            auto cshader = mSolveSystem->GetComputeShader();
+            cshader->Set("Bounds", mBoundsBuffer);
+            cshader->Set("vertexGraph", mVertexGraphBuffer);
+            cshader->Set("vertexGraphData", mVertexGraphDataBuffer);
+            cshader->Set("orderedVertices", mOrderedVerticesBuffer);
+            cshader->Set("changed", mChangedBuffer);
+
+            // The last output is mTCoordsBuffer[0] after the swap of each
+            // iteration.
+            this->mNumIterations = 0;
+            for (uint32_t i = 1; i <= numIterations; ++i)
+            {
+                if (this->mProgress)
+                {
+                    (*this->mProgress)(i);
+                }
+
+                bool const checkChange = (this->mTolerance > (Real)0 &&
+                    i % CONVERGENCE_CHECK_INTERVAL == 0);
+                if (checkChange)
+                {
+                    bounds->checkChange = 1;
+                    mEngine->Update(mBoundsBuffer);
+                    *mChangedBuffer->Get<uint32_t>() = 0;
+                    mEngine->CopyCpuToGpu(mChangedBuffer);
+                }
+
+                cshader->Set("inTCoords", mTCoordsBuffer[0]);
+                cshader->Set("outTCoords", mTCoordsBuffer[1]);
+                mEngine->Execute(mSolveSystem, numXGroups, numYGroups, 1);
+                std::swap(mTCoordsBuffer[0], mTCoordsBuffer[1]);
+                ++this->mNumIterations;
+
+                if (checkChange)
+                {
+                    bounds->checkChange = 0;
+                    mEngine->Update(mBoundsBuffer);
+                    mEngine->CopyGpuToCpu(mChangedBuffer);
+                    if (*mChangedBuffer->Get<uint32_t>() == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            mEngine->CopyGpuToCpu(mTCoordsBuffer[0]);
+            std::memcpy(this->mTCoords, mTCoordsBuffer[0]->GetData(), mTCoordsBuffer[0]->GetNumBytes());
+        }
+
+    private:
+        // The layout of the constant buffer Bounds of the shaders.
+        struct Bounds
+        {
+            int bound[2];
+            int numBoundaryEdges;
+            int numInputs;
+            float tolerance;
+            int checkChange;
+            int padding[2];
+        };
+
+        void CreateProgram()
         {
             int api = mFactory->GetAPI();
             mFactory->defines.Set("NUM_X_THREADS", 8);
@@ -66,86 +202,71 @@ namespace gte
                 }
             }
 
-            // TODO: Test mSolveSystem for null and respond accordingly.
-            auto solveSystem = mFactory->CreateFromSource(ShaderSource(api));
-            LogAssert(solveSystem, "Failed to compile shader.");
-            auto cshader = solveSystem->GetComputeShader();
+            mSolveSystem = mFactory->CreateFromSource(ShaderSource(api));
+            LogAssert(mSolveSystem, "Failed to compile shader.");
 
-            // Compute the number of thread groups.
-            int numInputs = this->mNumVertices - this->mNumBoundaryEdges;
-            Real factor0 = std::ceil(std::sqrt((Real)numInputs));
-            Real factor1 = std::ceil((Real)numInputs / factor0);
-            int xElements = static_cast<int>(factor0);
-            int yElements = static_cast<int>(factor1);
-            int xRem = (xElements % 8);
-            if (xRem > 0)
+            mBoundsBuffer = std::make_shared<ConstantBuffer>(sizeof(Bounds), true);
+            std::memset(mBoundsBuffer->GetData(), 0, mBoundsBuffer->GetNumBytes());
+
+            mChangedBuffer = std::make_shared<StructuredBuffer>(1, sizeof(uint32_t));
+            mChangedBuffer->SetUsage(Resource::SHADER_OUTPUT);
+            mChangedBuffer->SetCopyType(Resource::COPY_BIDIRECTIONAL);
+            *mChangedBuffer->Get<uint32_t>() = 0;
+        }
+
+        // Create the buffer for the data when the number of elements has
+        // changed. Otherwise, copy to the GPU the smallest range of
+        // elements that contains the elements that differ from those of
+        // the previous call.
+        template <typename T>
+        void Upload(std::shared_ptr<StructuredBuffer>& buffer, std::vector<T> const& data)
+        {
+            unsigned int const numElements = static_cast<unsigned int>(data.size());
+            if (!buffer || buffer->GetNumElements() != numElements)
             {
-                xElements += 8 - xRem;
+                buffer = std::make_shared<StructuredBuffer>(numElements, sizeof(T));
+                buffer->SetCopyType(Resource::COPY_CPU_TO_STAGING);
+                std::memcpy(buffer->GetData(), data.data(), buffer->GetNumBytes());
+                return;
             }
-            int yRem = (yElements % 8);
-            if (yRem > 0)
+
+            T* target = buffer->Get<T>();
+            unsigned int first = 0;
+            while (first < numElements && std::memcmp(&target[first], &data[first], sizeof(T)) == 0)
             {
-                yElements += 8 - yRem;
+                ++first;
             }
-            uint32_t numXGroups = xElements / 8;
-            uint32_t numYGroups = yElements / 8;
-
-            auto boundBuffer = std::make_shared<ConstantBuffer>(4 * sizeof(int), false);
-            auto data = boundBuffer->Get<int>();
-            data[0] = xElements;
-            data[1] = yElements;
-            data[2] = this->mNumBoundaryEdges;
-            data[3] = numInputs;
-            cshader->Set("Bounds", boundBuffer);
-
-            uint32_t const vgSize = static_cast<uint32_t>(this->mVertexGraph.size());
-            auto vgBuffer = std::make_shared<StructuredBuffer>(vgSize, sizeof(typename GenerateMeshUV<Real>::Vertex));
-            std::memcpy(vgBuffer->GetData(), &this->mVertexGraph[0], vgBuffer->GetNumBytes());
-            cshader->Set("vertexGraph", vgBuffer);
-
-            uint32_t const vgdSize = static_cast<uint32_t>(this->mVertexGraphData.size());
-            auto vgdBuffer = std::make_shared<StructuredBuffer>(vgdSize, sizeof(std::pair<int, Real>));
-            std::memcpy(vgdBuffer->GetData(), &this->mVertexGraphData[0], vgdBuffer->GetNumBytes());
-            cshader->Set("vertexGraphData", vgdBuffer);
-
-            uint32_t const ovSize = static_cast<uint32_t>(this->mOrderedVertices.size());
-            auto ovBuffer = std::make_shared<StructuredBuffer>(ovSize, sizeof(int));
-            std::memcpy(ovBuffer->GetData(), &this->mOrderedVertices[0], ovBuffer->GetNumBytes());
-            cshader->Set("orderedVertices", ovBuffer);
-
-            std::array<std::shared_ptr<StructuredBuffer>, 2> tcoordsBuffer;
-            for (size_t j = 0; j < 2; ++j)
+            if (first == numElements)
             {
-                tcoordsBuffer[j] = std::make_shared<StructuredBuffer>(this->mNumVertices, sizeof(Vector2<Real>));
-                tcoordsBuffer[j]->SetUsage(Resource::SHADER_OUTPUT);
-                std::memcpy(tcoordsBuffer[j]->GetData(), this->mTCoords, tcoordsBuffer[j]->GetNumBytes());
+                return;
             }
-            tcoordsBuffer[0]->SetCopyType(Resource::COPY_STAGING_TO_CPU);
 
-            // The value numIterations is even, so we always swap an even
-            // number of times.  This ensures that on exit from the loop,
-            // mTCoordsBuffer[0] has the final output.
-            for (uint32_t i = 1; i <= numIterations; ++i)
+            unsigned int last = numElements - 1;
+            while (std::memcmp(&target[last], &data[last], sizeof(T)) == 0)
             {
-                if (this->mProgress)
-                {
-                    (*this->mProgress)(i);
-                }
-
-                cshader->Set("inTCoords", tcoordsBuffer[0]);
-                cshader->Set("outTCoords", tcoordsBuffer[1]);
-                mEngine->Execute(solveSystem, numXGroups, numYGroups, 1);
-                std::swap(tcoordsBuffer[0], tcoordsBuffer[1]);
+                --last;
             }
 
-            mEngine->CopyGpuToCpu(tcoordsBuffer[0]);
-            std::memcpy(this->mTCoords, tcoordsBuffer[0]->GetData(), tcoordsBuffer[0]->GetNumBytes());
+            std::memcpy(static_cast<void*>(&target[first]), &data[first], (last - first + 1) * sizeof(T));
+            buffer->SetOffset(first);
+            buffer->SetNumActiveElements(last - first + 1);
+            mEngine->CopyCpuToGpu(buffer);
+            buffer->SetOffset(0);
+            buffer->SetNumActiveElements(numElements);
         }
 
-    private:
         std::shared_ptr<GraphicsEngine> mEngine;
         std::shared_ptr<ProgramFactory> mFactory;
 
+        // The persistent GPU resources.
+        std::shared_ptr<ComputeProgram> mSolveSystem;
+        std::shared_ptr<ConstantBuffer> mBoundsBuffer;
+        std::shared_ptr<StructuredBuffer> mVertexGraphBuffer;
+        std::shared_ptr<StructuredBuffer> mVertexGraphDataBuffer;
+        std::shared_ptr<StructuredBuffer> mOrderedVerticesBuffer;
+        std::array<std::shared_ptr<StructuredBuffer>, 2> mTCoordsBuffer;
+        std::shared_ptr<StructuredBuffer> mChangedBuffer;
+
         static std::string const& ShaderSource(int api)
         {
             static std::array<std::string, 2> source =
@@ -157,6 +278,8 @@ namespace gte
                         ivec2 bound;
                         int numBoundaryEdges;
                         int numInputs;
+                        float tolerance;
+                        int checkChange;
                     };
 
                     struct VertexGraphData
@@ -170,6 +293,7 @@ namespace gte
                     buffer orderedVertices { int data[]; } orderedVerticesSB;
                     buffer inTCoords { Real2 data[]; } inTCoordsSB;
                     buffer outTCoords { Real2 data[]; } outTCoordsSB;
+                    buffer changed { uint data[]; } changedSB;
 
                     layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
                     void main()
@@ -190,6 +314,15 @@ namespace gte
                             }
                             tcoord /= weightSum;
                             outTCoordsSB.data[v] = tcoord;
+
+                            if (checkChange != 0)
+                            {
+                                Real2 diff = abs(tcoord - inTCoordsSB.data[v]);
+                                if (max(diff.x, diff.y) > tolerance)
+                                {
+                                    changedSB.data[0] = 1u;
+                                }
+                            }
                         }
                     }
                 )",
@@ -201,6 +334,8 @@ namespace gte
                         int2 bound;
                         int numBoundaryEdges;
                         int numInputs;
+                        float tolerance;
+                        int checkChange;
                     };
 
                     struct VertexGraphData
@@ -214,6 +349,7 @@ namespace gte
                     StructuredBuffer<int> orderedVertices;
                     StructuredBuffer<Real2> inTCoords;
                     RWStructuredBuffer<Real2> outTCoords;
+                    RWStructuredBuffer<uint> changed;
 
                     [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
                     void CSMain(int2 t : SV_DispatchThreadID)
@@ -233,6 +369,15 @@ namespace gte
                             }
                             tcoord /= weightSum;
                             outTCoords[v] = tcoord;
+
+                            if (checkChange != 0)
+                            {
+                                Real2 diff = abs(tcoord - inTCoords[v]);
+                                if (max(diff.x, diff.y) > tolerance)
+                                {
+                                    changed[0] = 1;
+                                }
+                            }
                         }
                     }
                 )"
@@ -0,0 +1,432 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUMassSpring.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+using namespace gte;
+
+GPUMassSpring::GPUMassSpring(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, int numParticles,
+    std::vector<Spring> const& springs, float step, int numThreads)
+    :
+    mEngine(engine),
+    mNumParticles(numParticles),
+    mNumSprings(static_cast<int>(springs.size())),
+    mStep(step),
+    mViscosity(0.0f),
+    mGravity{ 0.0f, 0.0f, 0.0f },
+    mMass(numParticles, std::numeric_limits<float>::max())
+{
+    LogAssert(engine != nullptr && factory != nullptr && numParticles > 0
+        && numThreads > 0, "Invalid argument.");
+
+    unsigned int const numElements = static_cast<unsigned int>(numParticles);
+
+    // Store the springs adjacent to each particle using a counting sort by
+    // particle.
+    mOffsets = std::make_shared<StructuredBuffer>(numElements + 1, sizeof(int32_t));
+    auto offsets = mOffsets->Get<int32_t>();
+    std::fill(offsets, offsets + numElements + 1, 0);
+    for (auto const& spring : springs)
+    {
+        LogAssert(0 <= spring.particle0 && spring.particle0 < numParticles &&
+            0 <= spring.particle1 && spring.particle1 < numParticles &&
+            spring.particle0 != spring.particle1, "Invalid spring.");
+        ++offsets[spring.particle0 + 1];
+        ++offsets[spring.particle1 + 1];
+    }
+    for (int i = 0; i < numParticles; ++i)
+    {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // A structured buffer must have at least one element.
+    unsigned int const numAdjacent = std::max(2 * static_cast<unsigned int>(mNumSprings), 1u);
+    mAdjacency = std::make_shared<StructuredBuffer>(numAdjacent, sizeof(Adjacent));
+    auto adjacency = mAdjacency->Get<Adjacent>();
+    std::memset(adjacency, 0, mAdjacency->GetNumBytes());
+    std::vector<int32_t> next(offsets, offsets + numElements);
+    for (auto const& spring : springs)
+    {
+        adjacency[next[spring.particle0]++] =
+            { spring.particle1, spring.constant, spring.length, 0.0f };
+        adjacency[next[spring.particle1]++] =
+            { spring.particle0, spring.constant, spring.length, 0.0f };
+    }
+
+    // The state buffers.
+    mInvMass = CreateBuffer(numElements, sizeof(float));
+    std::memset(mInvMass->GetData(), 0, mInvMass->GetNumBytes());
+    mPosition = CreateBuffer(numElements, sizeof(Vector4<float>));
+    auto position = mPosition->Get<Vector4<float>>();
+    std::fill(position, position + numElements, Vector4<float>{ 0.0f, 0.0f, 0.0f, 1.0f });
+    mVelocity = CreateBuffer(numElements, sizeof(Vector4<float>));
+    std::memset(mVelocity->GetData(), 0, mVelocity->GetNumBytes());
+    for (int j = 0; j < 2; ++j)
+    {
+        mPTmp[j] = CreateBuffer(numElements, sizeof(Vector4<float>));
+        mVTmp[j] = CreateBuffer(numElements, sizeof(Vector4<float>));
+    }
+    mPSum = CreateBuffer(numElements, sizeof(Vector4<float>));
+    mVSum = CreateBuffer(numElements, sizeof(Vector4<float>));
+
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32B32A32_FLOAT, 0);
+    mVertexBuffer = std::make_shared<VertexBuffer>(vformat, mPosition);
+
+    // The D3D11 limit on the number of thread groups per dimension is
+    // 65535, so large dispatches use rows of thread groups.
+    unsigned int const threads = static_cast<unsigned int>(numThreads);
+    unsigned int const numGroups = (numElements + threads - 1) / threads;
+    mNumXGroups = std::min(numGroups, 4096u);
+    mNumYGroups = (numGroups + mNumXGroups - 1) / mNumXGroups;
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), true);
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->gravity = { 0.0f, 0.0f, 0.0f, 0.0f };
+    parameters->numParticles = numParticles;
+    parameters->rowSize = static_cast<int32_t>(mNumXGroups * threads);
+    parameters->viscosity = 0.0f;
+    parameters->step = step;
+    parameters->halfStep = 0.5f * step;
+    parameters->sixthStep = step / 6.0f;
+    parameters->padding[0] = 0.0f;
+    parameters->padding[1] = 0.0f;
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numThreads);
+    for (int stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        factory->defines.Set("STAGE", stage);
+        mKernels[stage] = factory->CreateFromSource(api == ProgramFactory::PF_GLSL ?
+            msGLSLSource : msHLSLSource);
+        LogAssert(mKernels[stage] != nullptr, "Failed to compile shader.");
+
+        auto cshader = mKernels[stage]->GetComputeShader();
+        cshader->Set("Parameters", mParameters);
+        cshader->Set("offsets", mOffsets);
+        cshader->Set("adjacency", mAdjacency);
+        cshader->Set("invMass", mInvMass);
+        cshader->Set("position", mPosition);
+        cshader->Set("velocity", mVelocity);
+        cshader->Set("pSum", mPSum);
+        cshader->Set("vSum", mVSum);
+        if (stage > 0)
+        {
+            cshader->Set("pIn", mPTmp[(stage + 1) % 2]);
+            cshader->Set("vIn", mVTmp[(stage + 1) % 2]);
+        }
+        if (stage < NUM_STAGES - 1)
+        {
+            cshader->Set("pOut", mPTmp[stage % 2]);
+            cshader->Set("vOut", mVTmp[stage % 2]);
+        }
+    }
+    factory->PopDefines();
+
+    mEngine->CopyCpuToGpu(mOffsets);
+    mEngine->CopyCpuToGpu(mAdjacency);
+    CopyCpuToGpu();
+}
+
+void GPUMassSpring::SetMass(int i, float mass)
+{
+    if (0.0f < mass && mass < std::numeric_limits<float>::max())
+    {
+        mMass[i] = mass;
+        mInvMass->Get<float>()[i] = 1.0f / mass;
+    }
+    else
+    {
+        mMass[i] = std::numeric_limits<float>::max();
+        mInvMass->Get<float>()[i] = 0.0f;
+    }
+}
+
+void GPUMassSpring::SetPosition(int i, Vector3<float> const& position)
+{
+    mPosition->Get<Vector4<float>>()[i] = HLift(position, 1.0f);
+}
+
+void GPUMassSpring::SetVelocity(int i, Vector3<float> const& velocity)
+{
+    mVelocity->Get<Vector4<float>>()[i] = HLift(velocity, 0.0f);
+}
+
+float GPUMassSpring::GetMass(int i) const
+{
+    return mMass[i];
+}
+
+Vector3<float> GPUMassSpring::GetPosition(int i) const
+{
+    return HProject(mPosition->Get<Vector4<float>>()[i]);
+}
+
+Vector3<float> GPUMassSpring::GetVelocity(int i) const
+{
+    return HProject(mVelocity->Get<Vector4<float>>()[i]);
+}
+
+void GPUMassSpring::SetGravity(Vector3<float> const& gravity)
+{
+    mGravity = gravity;
+}
+
+void GPUMassSpring::SetViscosity(float viscosity)
+{
+    mViscosity = viscosity;
+}
+
+void GPUMassSpring::SetStep(float step)
+{
+    mStep = step;
+}
+
+void GPUMassSpring::CopyCpuToGpu()
+{
+    mEngine->CopyCpuToGpu(mInvMass);
+    mEngine->CopyCpuToGpu(mPosition);
+    mEngine->CopyCpuToGpu(mVelocity);
+}
+
+void GPUMassSpring::CopyGpuToCpu()
+{
+    mEngine->CopyGpuToCpu(mPosition);
+    mEngine->CopyGpuToCpu(mVelocity);
+}
+
+void GPUMassSpring::Update()
+{
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->gravity = HLift(mGravity, 0.0f);
+    parameters->viscosity = mViscosity;
+    parameters->step = mStep;
+    parameters->halfStep = 0.5f * mStep;
+    parameters->sixthStep = mStep / 6.0f;
+    mEngine->Update(mParameters);
+
+    for (int stage = 0; stage < NUM_STAGES; ++stage)
+    {
+        mEngine->Execute(mKernels[stage], mNumXGroups, mNumYGroups, 1);
+    }
+}
+
+std::shared_ptr<StructuredBuffer> GPUMassSpring::CreateBuffer(unsigned int numElements,
+    size_t elementSize)
+{
+    auto buffer = std::make_shared<StructuredBuffer>(numElements, elementSize);
+    buffer->SetUsage(Resource::SHADER_OUTPUT);
+    buffer->SetCopyType(Resource::COPY_BIDIRECTIONAL);
+    return buffer;
+}
+
+
+std::string const GPUMassSpring::msGLSLSource =
+R"(
+    uniform Parameters
+    {
+        vec4 gravity;
+        int numParticles;
+        int rowSize;
+        float viscosity;
+        float step;
+        float halfStep;
+        float sixthStep;
+        vec2 padding;
+    };
+
+    struct Adjacent
+    {
+        int neighbor;
+        float constant;
+        float length;
+        float padding;
+    };
+
+    // The springs of particle i are adjacencySB.data[k] for
+    // offsetsSB.data[i] <= k < offsetsSB.data[i+1].
+    buffer offsets { int data[]; } offsetsSB;
+    buffer adjacency { Adjacent data[]; } adjacencySB;
+    buffer invMass { float data[]; } invMassSB;
+    buffer position { vec4 data[]; } positionSB;
+    buffer velocity { vec4 data[]; } velocitySB;
+    buffer pSum { vec4 data[]; } pSumSB;
+    buffer vSum { vec4 data[]; } vSumSB;
+
+    // The state at which the derivatives are evaluated, which is the
+    // current state for the first stage.
+    #if STAGE == 0
+        #define P_IN positionSB
+        #define V_IN velocitySB
+    #else
+        buffer pIn { vec4 data[]; } pInSB;
+        buffer vIn { vec4 data[]; } vInSB;
+        #define P_IN pInSB
+        #define V_IN vInSB
+    #endif
+
+    #if STAGE < 3
+        buffer pOut { vec4 data[]; } pOutSB;
+        buffer vOut { vec4 data[]; } vOutSB;
+    #endif
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int i = int(gl_GlobalInvocationID.x) + rowSize * int(gl_GlobalInvocationID.y);
+        if (i >= numParticles)
+        {
+            return;
+        }
+
+        // Immovable particles have zero derivatives.
+        vec4 P = P_IN.data[i];
+        vec4 V = V_IN.data[i];
+        vec4 dP = vec4(0.0f);
+        vec4 dV = vec4(0.0f);
+        float invM = invMassSB.data[i];
+        if (invM > 0.0f)
+        {
+            vec4 acc = gravity - viscosity * V;
+            int kmax = offsetsSB.data[i + 1];
+            for (int k = offsetsSB.data[i]; k < kmax; ++k)
+            {
+                Adjacent adj = adjacencySB.data[k];
+                vec4 diff = P_IN.data[adj.neighbor] - P;
+                float ratio = adj.length / length(diff);
+                acc += (invM * adj.constant * (1.0f - ratio)) * diff;
+            }
+            dP = V;
+            dV = acc;
+        }
+
+    #if STAGE == 0
+        pSumSB.data[i] = dP;
+        vSumSB.data[i] = dV;
+    #elif STAGE < 3
+        pSumSB.data[i] += 2.0f * dP;
+        vSumSB.data[i] += 2.0f * dV;
+    #endif
+
+    #if STAGE < 2
+        pOutSB.data[i] = positionSB.data[i] + halfStep * dP;
+        vOutSB.data[i] = velocitySB.data[i] + halfStep * dV;
+    #elif STAGE == 2
+        pOutSB.data[i] = positionSB.data[i] + step * dP;
+        vOutSB.data[i] = velocitySB.data[i] + step * dV;
+    #else
+        positionSB.data[i] += sixthStep * (pSumSB.data[i] + dP);
+        velocitySB.data[i] += sixthStep * (vSumSB.data[i] + dV);
+    #endif
+    }
+)";
+
+std::string const GPUMassSpring::msHLSLSource =
+R"(
+    cbuffer Parameters
+    {
+        float4 gravity;
+        int numParticles;
+        int rowSize;
+        float viscosity;
+        float step;
+        float halfStep;
+        float sixthStep;
+        float2 padding;
+    };
+
+    struct Adjacent
+    {
+        int neighbor;
+        float constant;
+        float length;
+        float padding;
+    };
+
+    // The springs of particle i are adjacency[k] for
+    // offsets[i] <= k < offsets[i+1].
+    StructuredBuffer<int> offsets;
+    StructuredBuffer<Adjacent> adjacency;
+    StructuredBuffer<float> invMass;
+    RWStructuredBuffer<float4> position;
+    RWStructuredBuffer<float4> velocity;
+    RWStructuredBuffer<float4> pSum;
+    RWStructuredBuffer<float4> vSum;
+
+    // The state at which the derivatives are evaluated, which is the
+    // current state for the first stage.
+    #if STAGE == 0
+        #define P_IN position
+        #define V_IN velocity
+    #else
+        StructuredBuffer<float4> pIn;
+        StructuredBuffer<float4> vIn;
+        #define P_IN pIn
+        #define V_IN vIn
+    #endif
+
+    #if STAGE < 3
+        RWStructuredBuffer<float4> pOut;
+        RWStructuredBuffer<float4> vOut;
+    #endif
+
+    [numthreads(NUM_X_THREADS, 1, 1)]
+    void CSMain(uint2 dt : SV_DispatchThreadID)
+    {
+        int i = int(dt.x) + rowSize * int(dt.y);
+        if (i >= numParticles)
+        {
+            return;
+        }
+
+        // Immovable particles have zero derivatives.
+        float4 P = P_IN[i];
+        float4 V = V_IN[i];
+        float4 dP = float4(0.0f, 0.0f, 0.0f, 0.0f);
+        float4 dV = float4(0.0f, 0.0f, 0.0f, 0.0f);
+        float invM = invMass[i];
+        if (invM > 0.0f)
+        {
+            float4 acc = gravity - viscosity * V;
+            int kmax = offsets[i + 1];
+            [loop]
+            for (int k = offsets[i]; k < kmax; ++k)
+            {
+                Adjacent adj = adjacency[k];
+                float4 diff = P_IN[adj.neighbor] - P;
+                float ratio = adj.length / length(diff);
+                acc += (invM * adj.constant * (1.0f - ratio)) * diff;
+            }
+            dP = V;
+            dV = acc;
+        }
+
+    #if STAGE == 0
+        pSum[i] = dP;
+        vSum[i] = dV;
+    #elif STAGE < 3
+        pSum[i] += 2.0f * dP;
+        vSum[i] += 2.0f * dV;
+    #endif
+
+    #if STAGE < 2
+        pOut[i] = position[i] + halfStep * dP;
+        vOut[i] = velocity[i] + halfStep * dV;
+    #elif STAGE == 2
+        pOut[i] = position[i] + step * dP;
+        vOut[i] = velocity[i] + step * dV;
+    #else
+        position[i] += sixthStep * (pSum[i] + dP);
+        velocity[i] += sixthStep * (vSum[i] + dV);
+    #endif
+    }
+)";
@@ -0,0 +1,171 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/MassSpringArbitrary.h>
+#include <Mathematics/Vector3.h>
+#include <Mathematics/Vector4.h>
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+#include <Graphics/VertexBuffer.h>
+
+// A GPU-based mass-spring system in 3D with springs of arbitrary topology
+// using DX11/HLSL or GL45/GLSL. It is the GPU counterpart of
+// MassSpringArbitrary<3,float>, and it generalizes the volume-specific
+// shaders of the sample Samples/Physics/MassSprings3D. The external
+// acceleration is a constant gravity plus a viscous drag -viscosity*V.
+//
+// The springs adjacent to each particle are stored in compressed form: the
+// springs of particle i are adjacency[k] for offsets[i] <= k < offsets[i+1],
+// each storing the other particle, the spring constant and the resting
+// length. Every spring is stored for both of its particles, so each thread
+// gathers the forces on its particle without atomic operations.
+//
+// The Runge-Kutta fourth-order solver of ParticleSystem is implemented by
+// four compute shaders, one per stage, with one thread per particle. Stage
+// k evaluates the derivatives at the state written by stage k-1 (or at the
+// current state for k = 0), accumulates their weighted sum and writes the
+// state for stage k+1; the last stage updates the current state. The
+// intermediate states alternate between two pairs of buffers, so a stage
+// never reads a buffer that it writes.
+//
+// The positions remain on the GPU. They are stored as (x,y,z,1) in a
+// structured buffer that is the storage of a vertex buffer for
+// vertex-identifier-based drawing, so the particles can be drawn without a
+// GPU-to-CPU copy. The CPU copies of the state are used only to initialize
+// the system and by CopyGpuToCpu() for readback.
+
+namespace gte
+{
+    class GPUMassSpring
+    {
+    public:
+        using Spring = MassSpringArbitrary<3, float>::Spring;
+
+        // Construction. The spring topology is fixed at construction. The
+        // kernels are dispatched with 1D thread groups of numThreads
+        // threads.
+        GPUMassSpring(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory, int numParticles,
+            std::vector<Spring> const& springs, float step, int numThreads = 64);
+
+        ~GPUMassSpring() = default;
+
+        // Member access. The Set functions modify the CPU copies of the
+        // state; call CopyCpuToGpu() afterwards to copy them to the GPU. A
+        // particle with mass std::numeric_limits<float>::max() (or a
+        // nonpositive mass) is immovable.
+        inline int GetNumParticles() const
+        {
+            return mNumParticles;
+        }
+
+        inline int GetNumSprings() const
+        {
+            return mNumSprings;
+        }
+
+        void SetMass(int i, float mass);
+        void SetPosition(int i, Vector3<float> const& position);
+        void SetVelocity(int i, Vector3<float> const& velocity);
+        float GetMass(int i) const;
+        Vector3<float> GetPosition(int i) const;
+        Vector3<float> GetVelocity(int i) const;
+
+        // The external acceleration is gravity - viscosity * velocity. The
+        // parameters take effect at the next Update().
+        void SetGravity(Vector3<float> const& gravity);
+        void SetViscosity(float viscosity);
+        void SetStep(float step);
+
+        inline float GetStep() const
+        {
+            return mStep;
+        }
+
+        // Copy the masses, positions and velocities from the CPU to the GPU
+        // or copy the positions and velocities from the GPU to the CPU.
+        void CopyCpuToGpu();
+        void CopyGpuToCpu();
+
+        // Advance the state by one time step on the GPU.
+        void Update();
+
+        // The structured buffer of positions (x,y,z,1) and the vertex buffer
+        // that reads its vertices from it. The shader resource of the
+        // vertex shader must be set to GetPositions().
+        inline std::shared_ptr<StructuredBuffer> const& GetPositions() const
+        {
+            return mPosition;
+        }
+
+        inline std::shared_ptr<VertexBuffer> const& GetVertexBuffer() const
+        {
+            return mVertexBuffer;
+        }
+
+    private:
+        enum { NUM_STAGES = 4 };
+
+        // The layout of the constant buffer "Parameters".
+        struct Parameters
+        {
+            Vector4<float> gravity;
+            int32_t numParticles;
+            int32_t rowSize;
+            float viscosity;
+            float step;
+            float halfStep;
+            float sixthStep;
+            float padding[2];
+        };
+
+        // The layout of an element of the adjacency buffer.
+        struct Adjacent
+        {
+            int32_t neighbor;
+            float constant;
+            float length;
+            float padding;
+        };
+
+        std::shared_ptr<StructuredBuffer> CreateBuffer(unsigned int numElements,
+            size_t elementSize);
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        int mNumParticles, mNumSprings;
+        float mStep, mViscosity;
+        Vector3<float> mGravity;
+        unsigned int mNumXGroups, mNumYGroups;
+        std::array<std::shared_ptr<ComputeProgram>, NUM_STAGES> mKernels;
+        std::shared_ptr<ConstantBuffer> mParameters;
+
+        // The spring topology.
+        std::shared_ptr<StructuredBuffer> mOffsets;
+        std::shared_ptr<StructuredBuffer> mAdjacency;
+
+        // The state of the system. The masses are stored on the CPU and
+        // the inverse masses on the GPU.
+        std::vector<float> mMass;
+        std::shared_ptr<StructuredBuffer> mInvMass;
+        std::shared_ptr<StructuredBuffer> mPosition;
+        std::shared_ptr<StructuredBuffer> mVelocity;
+        std::shared_ptr<VertexBuffer> mVertexBuffer;
+
+        // Temporary storage for the Runge-Kutta solver.
+        std::array<std::shared_ptr<StructuredBuffer>, 2> mPTmp, mVTmp;
+        std::shared_ptr<StructuredBuffer> mPSum, mVSum;
+
+        // Shader source code as strings. The stage is selected by the
+        // preprocessor symbol STAGE.
+        static std::string const msGLSLSource;
+        static std::string const msHLSLSource;
+    };
+}
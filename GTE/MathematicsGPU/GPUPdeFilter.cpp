@@ -0,0 +1,445 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUPdeFilter.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+using namespace gte;
+
+GPUPdeFilter::GPUPdeFilter(std::shared_ptr<GraphicsEngine> const& engine,
+    std::array<int, 3> const& bounds, std::array<float, 3> const& spacings,
+    float const* data, bool const* mask, float borderValue,
+    PdeFilter<float>::ScaleType scaleType, Scheme scheme, float K,
+    bool hostReadback, int numDimensions)
+    :
+    mEngine(engine),
+    mNumPixelGroups{ 1, 1, 1 },
+    mNumRowGroups{ 1, 1, 1 },
+    mBounds(bounds),
+    mNumDimensions(numDimensions),
+    mQuantity(bounds[0] * bounds[1] * bounds[2]),
+    mNumRows(bounds[1] * bounds[2]),
+    mBorderValue(borderValue),
+    mTimeStep(0.0f),
+    mScheme(scheme),
+    mHasMask(mask != nullptr),
+    mHostReadback(hostReadback),
+    mSource(0)
+{
+    LogAssert(engine != nullptr && data != nullptr && bounds[0] > 0 && bounds[1] > 0
+        && bounds[2] > 0 && (numDimensions == 3 || bounds[2] == 1)
+        && (scheme != GRADIENT_ANISOTROPIC || K > 0.0f), "Invalid argument.");
+
+    mPaddedBounds[0] = bounds[0] + 2;
+    mPaddedBounds[1] = bounds[1] + 2;
+    mPaddedBounds[2] = (numDimensions == 3 ? bounds[2] + 2 : 1);
+
+    // The scaling of the data is that of the PdeFilter constructor.
+    float minValue = data[0], maxValue = data[0];
+    for (int i = 1; i < mQuantity; ++i)
+    {
+        minValue = std::min(minValue, data[i]);
+        maxValue = std::max(maxValue, data[i]);
+    }
+
+    float offset = 0.0f, scale = 1.0f;
+    if (minValue != maxValue)
+    {
+        switch (scaleType)
+        {
+        case PdeFilter<float>::ST_NONE:
+            break;
+        case PdeFilter<float>::ST_UNIT:
+            scale = 1.0f / (maxValue - minValue);
+            break;
+        case PdeFilter<float>::ST_SYMMETRIC:
+            offset = -1.0f;
+            scale = 2.0f / (maxValue - minValue);
+            break;
+        case PdeFilter<float>::ST_PRESERVE_ZERO:
+            scale = (maxValue >= -minValue ? 1.0f / maxValue : -1.0f / minValue);
+            minValue = 0.0f;
+            break;
+        }
+    }
+    else
+    {
+        minValue = 0.0f;
+    }
+
+    // Both ping-pong buffers start with the padded image and the image
+    // border values, which the kernels do not modify.
+    unsigned int const numPadded = static_cast<unsigned int>(mPaddedBounds[0] *
+        mPaddedBounds[1] * mPaddedBounds[2]);
+    mImage[0] = std::make_shared<StructuredBuffer>(numPadded, sizeof(float));
+    mMask = std::make_shared<StructuredBuffer>(numPadded, sizeof(int32_t));
+    float* image = mImage[0]->Get<float>();
+    int32_t* imageMask = mMask->Get<int32_t>();
+    std::memset(image, 0, mImage[0]->GetNumBytes());
+    std::memset(imageMask, 0, mMask->GetNumBytes());
+
+    int const zOffset = (numDimensions == 3 ? 1 : 0);
+    for (int z = 0, i = 0; z < mBounds[2]; ++z)
+    {
+        for (int y = 0; y < mBounds[1]; ++y)
+        {
+            for (int x = 0; x < mBounds[0]; ++x, ++i)
+            {
+                int const j = GetIndex(x + 1, y + 1, z + zOffset);
+                image[j] = offset + (data[i] - minValue) * scale;
+                imageMask[j] = (mHasMask ? (mask[i] ? 1 : 0) : 1);
+            }
+        }
+    }
+
+    AssignImageBorder(image);
+    if (mHasMask)
+    {
+        AssignMaskBorder(image, imageMask);
+    }
+
+    mImage[1] = std::make_shared<StructuredBuffer>(numPadded, sizeof(float));
+    std::memcpy(mImage[1]->GetData(), image, mImage[0]->GetNumBytes());
+    for (auto const& buffer : mImage)
+    {
+        buffer->SetUsage(Resource::SHADER_OUTPUT);
+        if (mHostReadback)
+        {
+            buffer->SetCopyType(Resource::COPY_STAGING_TO_CPU);
+        }
+    }
+
+    if (mScheme == GRADIENT_ANISOTROPIC)
+    {
+        mRowSums = std::make_shared<StructuredBuffer>(mNumRows, sizeof(float));
+        mRowSums->SetUsage(Resource::SHADER_OUTPUT);
+        mGradientParameter = std::make_shared<StructuredBuffer>(1, sizeof(float));
+        mGradientParameter->SetUsage(Resource::SHADER_OUTPUT);
+    }
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), true);
+    auto parameters = mParameters->Get<Parameters>();
+    std::memset(parameters, 0, sizeof(Parameters));
+    float sumInvDD = 0.0f;
+    for (int j = 0; j < 3; ++j)
+    {
+        parameters->bounds[j] = mBounds[j];
+        if (j < numDimensions)
+        {
+            parameters->invD[j] = 1.0f / spacings[j];
+            parameters->halfInvD[j] = 0.5f * parameters->invD[j];
+            parameters->invDD[j] = parameters->invD[j] * parameters->invD[j];
+            sumInvDD += parameters->invDD[j];
+        }
+    }
+    parameters->fourthInvDD[0] = parameters->halfInvD[0] * parameters->halfInvD[1];
+    parameters->fourthInvDD[1] = parameters->halfInvD[0] * parameters->halfInvD[2];
+    parameters->fourthInvDD[2] = parameters->halfInvD[1] * parameters->halfInvD[2];
+    parameters->timeStep = mTimeStep;
+    parameters->K = K;
+    parameters->invQuantity = 1.0f / static_cast<float>(mQuantity);
+    mMaximumTimeStep = 0.5f / sumInvDD;
+}
+
+void GPUPdeFilter::SetTimeStep(float timeStep)
+{
+    mTimeStep = timeStep;
+    mParameters->Get<Parameters>()->timeStep = timeStep;
+    mEngine->Update(mParameters);
+}
+
+void GPUPdeFilter::Update()
+{
+    auto const& source = mImage[mSource];
+    auto const& target = mImage[1 - mSource];
+
+    if (mHasMask && mBorderValue == std::numeric_limits<float>::max())
+    {
+        mKernels[MASK_BORDER]->GetComputeShader()->Set("source", source);
+        mEngine->Execute(mKernels[MASK_BORDER], mNumPixelGroups[0], mNumPixelGroups[1],
+            mNumPixelGroups[2]);
+    }
+
+    if (mScheme == GRADIENT_ANISOTROPIC)
+    {
+        mKernels[ROW_SUM]->GetComputeShader()->Set("source", source);
+        mEngine->Execute(mKernels[ROW_SUM], mNumRowGroups[0], mNumRowGroups[1],
+            mNumRowGroups[2]);
+        mEngine->Execute(mKernels[PARAMETER], 1, 1, 1);
+    }
+
+    auto cshader = mKernels[UPDATE]->GetComputeShader();
+    cshader->Set("source", source);
+    cshader->Set("target", target);
+    mEngine->Execute(mKernels[UPDATE], mNumPixelGroups[0], mNumPixelGroups[1],
+        mNumPixelGroups[2]);
+
+    mSource = 1 - mSource;
+}
+
+void GPUPdeFilter::GetImage(std::vector<float>& image)
+{
+    LogAssert(mHostReadback, "The filter was constructed without host readback.");
+
+    auto const& source = mImage[mSource];
+    mEngine->CopyGpuToCpu(source);
+    float const* padded = source->Get<float>();
+
+    image.resize(static_cast<size_t>(mQuantity));
+    int const zOffset = (mNumDimensions == 3 ? 1 : 0);
+    for (int z = 0, i = 0; z < mBounds[2]; ++z)
+    {
+        for (int y = 0; y < mBounds[1]; ++y)
+        {
+            int const j = GetIndex(1, y + 1, z + zOffset);
+            std::memcpy(&image[i], &padded[j], mBounds[0] * sizeof(float));
+            i += mBounds[0];
+        }
+    }
+}
+
+void GPUPdeFilter::CreateKernels(std::shared_ptr<ProgramFactory> const& factory,
+    std::string const& commonSource,
+    std::array<std::string, NUM_KERNELS> const& kernelSources,
+    std::array<unsigned int, 3> const& numThreads)
+{
+    LogAssert(factory != nullptr && numThreads[0] > 0 && numThreads[1] > 0
+        && numThreads[2] > 0, "Invalid argument.");
+
+    // The pixel kernels have a thread per pixel. The row-sum kernel has
+    // a thread per row, in 1D thread groups of GROUP_SIZE threads for 2D
+    // images and in 2D thread groups over (y,z) for 3D images.
+    for (int j = 0; j < 3; ++j)
+    {
+        mNumPixelGroups[j] = (static_cast<unsigned int>(mBounds[j]) + numThreads[j] - 1) / numThreads[j];
+    }
+    if (mNumDimensions == 2)
+    {
+        mNumRowGroups[0] = (static_cast<unsigned int>(mNumRows) + GROUP_SIZE - 1) / GROUP_SIZE;
+    }
+    else
+    {
+        mNumRowGroups[0] = (static_cast<unsigned int>(mBounds[1]) + numThreads[0] - 1) / numThreads[0];
+        mNumRowGroups[1] = (static_cast<unsigned int>(mBounds[2]) + numThreads[1] - 1) / numThreads[1];
+    }
+
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", static_cast<int>(numThreads[0]));
+    factory->defines.Set("NUM_Y_THREADS", static_cast<int>(numThreads[1]));
+    factory->defines.Set("NUM_Z_THREADS", static_cast<int>(numThreads[2]));
+    factory->defines.Set("GROUP_SIZE", static_cast<int>(GROUP_SIZE));
+    factory->defines.Set("SCHEME", static_cast<int>(mScheme));
+    for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+    {
+        bool const needed =
+            (kernel == UPDATE) ||
+            (kernel == MASK_BORDER && mHasMask && mBorderValue == std::numeric_limits<float>::max()) ||
+            ((kernel == ROW_SUM || kernel == PARAMETER) && mScheme == GRADIENT_ANISOTROPIC);
+        if (needed)
+        {
+            std::string source = commonSource;
+            if (kernel == PARAMETER)
+            {
+                source += (factory->GetAPI() == ProgramFactory::PF_GLSL ?
+                    msGLSLParameterSource : msHLSLParameterSource);
+            }
+            else
+            {
+                source += kernelSources[kernel];
+            }
+
+            mKernels[kernel] = factory->CreateFromSource(source);
+            LogAssert(mKernels[kernel] != nullptr, "Failed to compile shader.");
+        }
+    }
+    factory->PopDefines();
+
+    for (auto const& program : mKernels)
+    {
+        if (program)
+        {
+            auto cshader = program->GetComputeShader();
+            cshader->Set("Parameters", mParameters);
+        }
+    }
+
+    if (mKernels[MASK_BORDER])
+    {
+        mKernels[MASK_BORDER]->GetComputeShader()->Set("mask", mMask);
+    }
+
+    if (mScheme == GRADIENT_ANISOTROPIC)
+    {
+        mKernels[ROW_SUM]->GetComputeShader()->Set("rowSums", mRowSums);
+
+        auto cshader = mKernels[PARAMETER]->GetComputeShader();
+        cshader->Set("rowSums", mRowSums);
+        cshader->Set("gradientParameter", mGradientParameter);
+
+        mKernels[UPDATE]->GetComputeShader()->Set("gradientParameter", mGradientParameter);
+    }
+
+    mKernels[UPDATE]->GetComputeShader()->Set("mask", mMask);
+}
+
+void GPUPdeFilter::AssignImageBorder(float* image) const
+{
+    // Dirichlet conditions assign the border value and Neumann conditions
+    // duplicate the nearest image value, as in PdeFilter2/3.
+    bool const dirichlet = (mBorderValue != std::numeric_limits<float>::max());
+    for (int z = 0; z < mPaddedBounds[2]; ++z)
+    {
+        int const zc = (mNumDimensions == 3 ? std::min(std::max(z, 1), mBounds[2]) : 0);
+        bool const zBorder = (zc != z);
+        for (int y = 0; y < mPaddedBounds[1]; ++y)
+        {
+            int const yc = std::min(std::max(y, 1), mBounds[1]);
+            bool const yBorder = (yc != y);
+            for (int x = 0; x < mPaddedBounds[0]; ++x)
+            {
+                int const xc = std::min(std::max(x, 1), mBounds[0]);
+                if (zBorder || yBorder || xc != x)
+                {
+                    image[GetIndex(x, y, z)] = (dirichlet ? mBorderValue : image[GetIndex(xc, yc, zc)]);
+                }
+            }
+        }
+    }
+}
+
+void GPUPdeFilter::AssignMaskBorder(float* image, int32_t const* mask) const
+{
+    // The masked-out pixels that are neighbors of masked-in pixels are
+    // assigned the border value for Dirichlet conditions and the average
+    // of the masked-in neighbor values for Neumann conditions.
+    bool const dirichlet = (mBorderValue != std::numeric_limits<float>::max());
+    int const zMin = (mNumDimensions == 3 ? 1 : 0);
+    int const zMax = (mNumDimensions == 3 ? mBounds[2] : 0);
+    int const dz = (mNumDimensions == 3 ? 1 : 0);
+    for (int z = zMin; z <= zMax; ++z)
+    {
+        for (int y = 1; y <= mBounds[1]; ++y)
+        {
+            for (int x = 1; x <= mBounds[0]; ++x)
+            {
+                if (mask[GetIndex(x, y, z)])
+                {
+                    continue;
+                }
+
+                int count = 0;
+                float average = 0.0f;
+                for (int k2 = z - dz; k2 <= z + dz; ++k2)
+                {
+                    for (int k1 = y - 1; k1 <= y + 1; ++k1)
+                    {
+                        for (int k0 = x - 1; k0 <= x + 1; ++k0)
+                        {
+                            int const k = GetIndex(k0, k1, k2);
+                            if (mask[k])
+                            {
+                                average += image[k];
+                                ++count;
+                            }
+                        }
+                    }
+                }
+
+                if (count > 0)
+                {
+                    image[GetIndex(x, y, z)] = (dirichlet ? mBorderValue : average / static_cast<float>(count));
+                }
+            }
+        }
+    }
+}
+
+
+std::string const GPUPdeFilter::msGLSLParameterSource =
+R"(
+    buffer rowSums { float data[]; } rowSumsSB;
+    buffer gradientParameter { float data[]; } gradientParameterSB;
+
+    shared float partial[GROUP_SIZE];
+
+    // Reduce the row sums to the average of the squared gradient lengths
+    // and store -0.5/(K^2*average), the factor of the exponents of the
+    // diffusion coefficients.
+    layout (local_size_x = GROUP_SIZE, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int t = int(gl_LocalInvocationID.x);
+        int numRows = bounds.y * bounds.z;
+        float sum = 0.0f;
+        for (int i = t; i < numRows; i += GROUP_SIZE)
+        {
+            sum += rowSumsSB.data[i];
+        }
+        partial[t] = sum;
+        memoryBarrierShared();
+        barrier();
+
+        for (int d = GROUP_SIZE / 2; d > 0; d /= 2)
+        {
+            if (t < d)
+            {
+                partial[t] += partial[t + d];
+            }
+            memoryBarrierShared();
+            barrier();
+        }
+
+        if (t == 0)
+        {
+            float gradMagSqr = partial[0] * invQuantity;
+            gradientParameterSB.data[0] = -0.5f / (K * K * gradMagSqr);
+        }
+    }
+)";
+
+std::string const GPUPdeFilter::msHLSLParameterSource =
+R"(
+    StructuredBuffer<float> rowSums;
+    RWStructuredBuffer<float> gradientParameter;
+
+    groupshared float partial[GROUP_SIZE];
+
+    // Reduce the row sums to the average of the squared gradient lengths
+    // and store -0.5/(K^2*average), the factor of the exponents of the
+    // diffusion coefficients.
+    [numthreads(GROUP_SIZE, 1, 1)]
+    void CSMain(uint3 gtID : SV_GroupThreadID)
+    {
+        int t = int(gtID.x);
+        int numRows = bounds.y * bounds.z;
+        float sum = 0.0f;
+        for (int i = t; i < numRows; i += GROUP_SIZE)
+        {
+            sum += rowSums[i];
+        }
+        partial[t] = sum;
+        GroupMemoryBarrierWithGroupSync();
+
+        [unroll]
+        for (int d = GROUP_SIZE / 2; d > 0; d /= 2)
+        {
+            if (t < d)
+            {
+                partial[t] += partial[t + d];
+            }
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        if (t == 0)
+        {
+            float gradMagSqr = partial[0] * invQuantity;
+            gradientParameter[0] = -0.5f / (K * K * gradMagSqr);
+        }
+    }
+)";
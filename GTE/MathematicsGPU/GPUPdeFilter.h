@@ -0,0 +1,182 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/PdeFilter.h>
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+
+// The base class for GPU-based implementations of the PDE filters of
+// Mathematics/PdeFilter2.h and Mathematics/PdeFilter3.h using DX11/HLSL or
+// GL45/GLSL. The CPU classes are the reference implementations; the
+// update formulas of the compute shaders are those of GaussianBlur2/3,
+// GradientAnisotropic2/3 and CurvatureFlow2/3.
+//
+// The image is stored in a pair of ping-pong structured buffers with the
+// same 1-pixel padding as the CPU classes, so the padded image has
+// (xBound+2)*(yBound+2) values in 2D and (xBound+2)*(yBound+2)*(zBound+2)
+// values in 3D, in lexicographical order. An iteration of Update is a
+// sequence of compute shaders.
+//   1. When a mask and Neumann boundary conditions are used, recompute the
+//      values of the masked-out pixels that are neighbors of masked-in
+//      pixels.
+//   2. For gradient anisotropic diffusion, compute the sums of squared
+//      gradient lengths of the rows, and then reduce them in one thread
+//      group to the parameter of the diffusion coefficients. The row sums
+//      are reduced in a different order than by the CPU classes, so the
+//      results can differ by rounding errors.
+//   3. Update the pixels from the source buffer to the target buffer,
+//      copying the masked-out pixels, and swap the buffers.
+// The image never leaves the GPU unless the filter is constructed with
+// hostReadback set to 'true', in which case GetImage(std::vector<float>&)
+// copies the current image to the CPU.
+
+namespace gte
+{
+    class GPUPdeFilter
+    {
+    public:
+        enum Scheme
+        {
+            GAUSSIAN_BLUR,
+            GRADIENT_ANISOTROPIC,
+            CURVATURE_FLOW
+        };
+
+        // Abstract base class.
+        virtual ~GPUPdeFilter() = default;
+
+        // Member access.
+        inline Scheme GetScheme() const
+        {
+            return mScheme;
+        }
+
+        inline int GetQuantity() const
+        {
+            return mQuantity;
+        }
+
+        inline float GetBorderValue() const
+        {
+            return mBorderValue;
+        }
+
+        void SetTimeStep(float timeStep);
+
+        inline float GetTimeStep() const
+        {
+            return mTimeStep;
+        }
+
+        // The maximum time step for which the Gaussian blur is stable,
+        // 0.5/sum(1/spacing^2), the value of GaussianBlur2/3.
+        inline float GetMaximumTimeStep() const
+        {
+            return mMaximumTimeStep;
+        }
+
+        // Execute one iteration of the filter.
+        void Update();
+
+        // The current padded image, which can be used as an input to other
+        // compute shaders. The buffer is replaced by the other ping-pong
+        // buffer on each Update.
+        inline std::shared_ptr<StructuredBuffer> const& GetImage() const
+        {
+            return mImage[mSource];
+        }
+
+        // Copy the unpadded current image to the CPU. The values are in the
+        // order of the constructor input and are scaled according to the
+        // scale type, as are the values of PdeFilter2::GetU. The filter
+        // must have been constructed with hostReadback set to 'true'.
+        void GetImage(std::vector<float>& image);
+
+    protected:
+        // The bounds[2] is 1 for 2D images, which are not padded in z. The
+        // spacings are used only as their reciprocals.
+        GPUPdeFilter(std::shared_ptr<GraphicsEngine> const& engine,
+            std::array<int, 3> const& bounds, std::array<float, 3> const& spacings,
+            float const* data, bool const* mask, float borderValue,
+            PdeFilter<float>::ScaleType scaleType, Scheme scheme, float K,
+            bool hostReadback, int numDimensions);
+
+        enum
+        {
+            MASK_BORDER,
+            ROW_SUM,
+            PARAMETER,
+            UPDATE,
+            NUM_KERNELS
+        };
+
+        enum { GROUP_SIZE = 256 };
+
+        // Compile the kernels from their sources, which are for the API of
+        // the factory. Each source is the common source, which declares the
+        // constant buffer "Parameters", followed by the kernel source. The
+        // PARAMETER kernel does not depend on the dimension, so its source
+        // is provided by this class and kernelSources[PARAMETER] is ignored.
+        // The number of thread groups for the pixels and the rows is
+        // computed from the thread counts.
+        void CreateKernels(std::shared_ptr<ProgramFactory> const& factory,
+            std::string const& commonSource,
+            std::array<std::string, NUM_KERNELS> const& kernelSources,
+            std::array<unsigned int, 3> const& numThreads);
+
+        // The layout of the constant buffer "Parameters". The spacing
+        // members store x, y, z and 0 (2D images have z-components 0). The
+        // mixed member stores 1/(4*dx*dy), 1/(4*dx*dz), 1/(4*dy*dz) and 0.
+        struct Parameters
+        {
+            int32_t bounds[4];
+            float timeStep;
+            float K;
+            float invQuantity;
+            float padding;
+            float invD[4];
+            float halfInvD[4];
+            float invDD[4];
+            float fourthInvDD[4];
+        };
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        std::array<std::shared_ptr<ComputeProgram>, NUM_KERNELS> mKernels;
+        std::array<unsigned int, 3> mNumPixelGroups, mNumRowGroups;
+        std::shared_ptr<ConstantBuffer> mParameters;
+        std::array<std::shared_ptr<StructuredBuffer>, 2> mImage;
+        std::shared_ptr<StructuredBuffer> mMask;
+        std::shared_ptr<StructuredBuffer> mRowSums;
+        std::shared_ptr<StructuredBuffer> mGradientParameter;
+        std::array<int, 3> mBounds, mPaddedBounds;
+        int mNumDimensions, mQuantity, mNumRows;
+        float mBorderValue, mTimeStep, mMaximumTimeStep;
+        Scheme mScheme;
+        bool mHasMask, mHostReadback;
+        int mSource;
+
+    private:
+        // Return the padded index of (x,y,z).
+        inline int GetIndex(int x, int y, int z) const
+        {
+            return x + mPaddedBounds[0] * (y + mPaddedBounds[1] * z);
+        }
+
+        // Assign the values of the 1-pixel image border and the values of
+        // the masked-out pixels that are neighbors of masked-in pixels. The
+        // assignments are those of PdeFilter2/3.
+        void AssignImageBorder(float* image) const;
+        void AssignMaskBorder(float* image, int32_t const* mask) const;
+
+        static std::string const msGLSLParameterSource;
+        static std::string const msHLSLParameterSource;
+    };
+}
@@ -0,0 +1,394 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUPdeFilter2.h>
+using namespace gte;
+
+GPUPdeFilter2::GPUPdeFilter2(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, int xBound, int yBound,
+    float xSpacing, float ySpacing, float const* data, bool const* mask,
+    float borderValue, PdeFilter<float>::ScaleType scaleType, Scheme scheme,
+    float K, bool hostReadback, int numThreads)
+    :
+    GPUPdeFilter(engine, { xBound, yBound, 1 }, { xSpacing, ySpacing, 1.0f },
+        data, mask, borderValue, scaleType, scheme, K, hostReadback, 2)
+{
+    LogAssert(factory != nullptr && numThreads > 0, "Invalid argument.");
+
+    bool const useGLSL = (factory->GetAPI() == ProgramFactory::PF_GLSL);
+    std::array<std::string, NUM_KERNELS> kernelSources =
+        (useGLSL ? msGLSLKernelSource : msHLSLKernelSource);
+    kernelSources[UPDATE] = msUpdatePixelSource + kernelSources[UPDATE];
+
+    unsigned int const threads = static_cast<unsigned int>(numThreads);
+    CreateKernels(factory, useGLSL ? msGLSLCommonSource : msHLSLCommonSource,
+        kernelSources, { threads, threads, 1 });
+}
+
+
+std::string const GPUPdeFilter2::msUpdatePixelSource =
+R"(
+    // U(dx,dy) is the value at offset (dx,dy) of the pixel, where dx and dy
+    // are in {-1,0,1}. The formulas are those of OnUpdateSingle of the CPU
+    // classes.
+    #define U(dx, dy) u[(dx + 1) + 3 * (dy + 1)]
+
+    float UpdatePixel(float u[9], float mHalfParameter)
+    {
+        float zz = U(0, 0);
+        float mz = U(-1, 0), pz = U(1, 0);
+        float zm = U(0, -1), zp = U(0, 1);
+
+    #if SCHEME == 0
+        // GaussianBlur2
+        float uxx = invDD.x * (pz - 2.0f * zz + mz);
+        float uyy = invDD.y * (zp - 2.0f * zz + zm);
+        return zz + timeStep * (uxx + uyy);
+    #else
+        float mm = U(-1, -1), pm = U(1, -1);
+        float mp = U(-1, 1), pp = U(1, 1);
+    #if SCHEME == 1
+        // GradientAnisotropic2
+        float uxFwd = invD.x * (pz - zz);
+        float uxBwd = invD.x * (zz - mz);
+        float uyFwd = invD.y * (zp - zz);
+        float uyBwd = invD.y * (zz - zm);
+
+        float uxCenM = halfInvD.x * (pm - mm);
+        float uxCenZ = halfInvD.x * (pz - mz);
+        float uxCenP = halfInvD.x * (pp - mp);
+        float uyCenM = halfInvD.y * (mp - mm);
+        float uyCenZ = halfInvD.y * (zp - zm);
+        float uyCenP = halfInvD.y * (pp - pm);
+
+        float uxCenZSqr = uxCenZ * uxCenZ;
+        float uyCenZSqr = uyCenZ * uyCenZ;
+
+        float uyEstP = 0.5f * (uyCenZ + uyCenP);
+        float cxp = exp(mHalfParameter * (uxCenZSqr + uyEstP * uyEstP));
+        float uyEstM = 0.5f * (uyCenZ + uyCenM);
+        float cxm = exp(mHalfParameter * (uxCenZSqr + uyEstM * uyEstM));
+        float uxEstP = 0.5f * (uxCenZ + uxCenP);
+        float cyp = exp(mHalfParameter * (uyCenZSqr + uxEstP * uxEstP));
+        float uxEstM = 0.5f * (uxCenZ + uxCenM);
+        float cym = exp(mHalfParameter * (uyCenZSqr + uxEstM * uxEstM));
+
+        return zz + timeStep * (
+            cxp * uxFwd - cxm * uxBwd +
+            cyp * uyFwd - cym * uyBwd);
+    #else
+        // CurvatureFlow2
+        float ux = halfInvD.x * (pz - mz);
+        float uy = halfInvD.y * (zp - zm);
+        float uxx = invDD.x * (pz - 2.0f * zz + mz);
+        float uxy = fourthInvDD.x * (mm + pp - mp - pm);
+        float uyy = invDD.y * (zp - 2.0f * zz + zm);
+
+        float sqrUx = ux * ux;
+        float sqrUy = uy * uy;
+        float denom = sqrUx + sqrUy;
+        if (denom > 0.0f)
+        {
+            float numer = uxx * sqrUy + uyy * sqrUx - 0.5f * uxy * ux * uy;
+            return zz + timeStep * numer / denom;
+        }
+        return zz;
+    #endif
+    #endif
+    }
+)";
+
+std::string const GPUPdeFilter2::msGLSLCommonSource =
+R"(
+    uniform Parameters
+    {
+        ivec4 bounds;
+        float timeStep;
+        float K;
+        float invQuantity;
+        float padding;
+        vec4 invD;
+        vec4 halfInvD;
+        vec4 invDD;
+        vec4 fourthInvDD;
+    };
+
+    // The index of the padded pixel (x,y).
+    int GetIndex(int x, int y)
+    {
+        return x + (bounds.x + 2) * y;
+    }
+)";
+
+std::array<std::string, GPUPdeFilter::NUM_KERNELS> const GPUPdeFilter2::msGLSLKernelSource =
+{
+// MASK_BORDER
+R"(
+    buffer mask { int data[]; } maskSB;
+    buffer source { float data[]; } sourceSB;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        int x = int(gl_GlobalInvocationID.x) + 1;
+        int y = int(gl_GlobalInvocationID.y) + 1;
+        if (x > bounds.x || y > bounds.y)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y);
+        if (maskSB.data[i] != 0)
+        {
+            return;
+        }
+
+        // Only masked-in values are read and only masked-out values are
+        // written, so the update is in place.
+        int count = 0;
+        float average = 0.0f;
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                int j = GetIndex(x + dx, y + dy);
+                if (maskSB.data[j] != 0)
+                {
+                    average += sourceSB.data[j];
+                    ++count;
+                }
+            }
+        }
+
+        if (count > 0)
+        {
+            sourceSB.data[i] = average / float(count);
+        }
+    }
+)",
+
+// ROW_SUM
+R"(
+    buffer source { float data[]; } sourceSB;
+    buffer rowSums { float data[]; } rowSumsSB;
+
+    layout (local_size_x = GROUP_SIZE, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int y = int(gl_GlobalInvocationID.x);
+        if (y >= bounds.y)
+        {
+            return;
+        }
+
+        int dy = bounds.x + 2;
+        float sum = 0.0f;
+        for (int x = 1, i = GetIndex(1, y + 1); x <= bounds.x; ++x, ++i)
+        {
+            float ux = halfInvD.x * (sourceSB.data[i + 1] - sourceSB.data[i - 1]);
+            float uy = halfInvD.y * (sourceSB.data[i + dy] - sourceSB.data[i - dy]);
+            sum += ux * ux + uy * uy;
+        }
+        rowSumsSB.data[y] = sum;
+    }
+)",
+
+// PARAMETER
+"",
+
+// UPDATE
+R"(
+    buffer mask { int data[]; } maskSB;
+    buffer source { float data[]; } sourceSB;
+    buffer target { float data[]; } targetSB;
+#if SCHEME == 1
+    buffer gradientParameter { float data[]; } gradientParameterSB;
+#endif
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        int x = int(gl_GlobalInvocationID.x) + 1;
+        int y = int(gl_GlobalInvocationID.y) + 1;
+        if (x > bounds.x || y > bounds.y)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y);
+        if (maskSB.data[i] == 0)
+        {
+            targetSB.data[i] = sourceSB.data[i];
+            return;
+        }
+
+        float u[9];
+        for (int dy = -1, k = 0; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx, ++k)
+            {
+                u[k] = sourceSB.data[GetIndex(x + dx, y + dy)];
+            }
+        }
+
+#if SCHEME == 1
+        float mHalfParameter = gradientParameterSB.data[0];
+#else
+        float mHalfParameter = 0.0f;
+#endif
+        targetSB.data[i] = UpdatePixel(u, mHalfParameter);
+    }
+)"
+};
+
+std::string const GPUPdeFilter2::msHLSLCommonSource =
+R"(
+    cbuffer Parameters
+    {
+        int4 bounds;
+        float timeStep;
+        float K;
+        float invQuantity;
+        float padding;
+        float4 invD;
+        float4 halfInvD;
+        float4 invDD;
+        float4 fourthInvDD;
+    };
+
+    // The index of the padded pixel (x,y).
+    int GetIndex(int x, int y)
+    {
+        return x + (bounds.x + 2) * y;
+    }
+)";
+
+std::array<std::string, GPUPdeFilter::NUM_KERNELS> const GPUPdeFilter2::msHLSLKernelSource =
+{
+// MASK_BORDER
+R"(
+    StructuredBuffer<int> mask;
+    RWStructuredBuffer<float> source;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int x = int(dt.x) + 1;
+        int y = int(dt.y) + 1;
+        if (x > bounds.x || y > bounds.y)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y);
+        if (mask[i] != 0)
+        {
+            return;
+        }
+
+        // Only masked-in values are read and only masked-out values are
+        // written, so the update is in place.
+        int count = 0;
+        float average = 0.0f;
+        [unroll]
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            [unroll]
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                int j = GetIndex(x + dx, y + dy);
+                if (mask[j] != 0)
+                {
+                    average += source[j];
+                    ++count;
+                }
+            }
+        }
+
+        if (count > 0)
+        {
+            source[i] = average / float(count);
+        }
+    }
+)",
+
+// ROW_SUM
+R"(
+    StructuredBuffer<float> source;
+    RWStructuredBuffer<float> rowSums;
+
+    [numthreads(GROUP_SIZE, 1, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int y = int(dt.x);
+        if (y >= bounds.y)
+        {
+            return;
+        }
+
+        int dy = bounds.x + 2;
+        float sum = 0.0f;
+        for (int x = 1, i = GetIndex(1, y + 1); x <= bounds.x; ++x, ++i)
+        {
+            float ux = halfInvD.x * (source[i + 1] - source[i - 1]);
+            float uy = halfInvD.y * (source[i + dy] - source[i - dy]);
+            sum += ux * ux + uy * uy;
+        }
+        rowSums[y] = sum;
+    }
+)",
+
+// PARAMETER
+"",
+
+// UPDATE
+R"(
+    StructuredBuffer<int> mask;
+    StructuredBuffer<float> source;
+    RWStructuredBuffer<float> target;
+#if SCHEME == 1
+    StructuredBuffer<float> gradientParameter;
+#endif
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int x = int(dt.x) + 1;
+        int y = int(dt.y) + 1;
+        if (x > bounds.x || y > bounds.y)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y);
+        if (mask[i] == 0)
+        {
+            target[i] = source[i];
+            return;
+        }
+
+        float u[9];
+        [unroll]
+        for (int dy = -1, k = 0; dy <= 1; ++dy)
+        {
+            [unroll]
+            for (int dx = -1; dx <= 1; ++dx, ++k)
+            {
+                u[k] = source[GetIndex(x + dx, y + dy)];
+            }
+        }
+
+#if SCHEME == 1
+        float mHalfParameter = gradientParameter[0];
+#else
+        float mHalfParameter = 0.0f;
+#endif
+        target[i] = UpdatePixel(u, mHalfParameter);
+    }
+)"
+};
@@ -0,0 +1,53 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <MathematicsGPU/GPUPdeFilter.h>
+
+// A GPU-based implementation of the 2D PDE filters GaussianBlur2,
+// GradientAnisotropic2 and CurvatureFlow2. The constructor parameters are
+// those of the CPU classes followed by the scheme. K is used only by
+// GRADIENT_ANISOTROPIC. The padded image has (xBound+2)*(yBound+2) values,
+// so the unpadded pixel (x,y) has index (x+1) + (xBound+2)*(y+1).
+
+namespace gte
+{
+    class GPUPdeFilter2 : public GPUPdeFilter
+    {
+    public:
+        // The pixel kernels are dispatched in 2D thread groups of
+        // numThreads^2 threads.
+        GPUPdeFilter2(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            int xBound, int yBound, float xSpacing, float ySpacing,
+            float const* data, bool const* mask, float borderValue,
+            PdeFilter<float>::ScaleType scaleType, Scheme scheme,
+            float K = 0.0f, bool hostReadback = false, int numThreads = 8);
+
+        virtual ~GPUPdeFilter2() = default;
+
+        inline int GetXBound() const
+        {
+            return mBounds[0];
+        }
+
+        inline int GetYBound() const
+        {
+            return mBounds[1];
+        }
+
+    private:
+        // The per-pixel update of the schemes is written once for both
+        // shader languages.
+        static std::string const msUpdatePixelSource;
+        static std::string const msGLSLCommonSource;
+        static std::string const msHLSLCommonSource;
+        static std::array<std::string, NUM_KERNELS> const msGLSLKernelSource;
+        static std::array<std::string, NUM_KERNELS> const msHLSLKernelSource;
+    };
+}
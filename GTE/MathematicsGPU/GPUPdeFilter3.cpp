@@ -0,0 +1,467 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUPdeFilter3.h>
+using namespace gte;
+
+GPUPdeFilter3::GPUPdeFilter3(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, int xBound, int yBound, int zBound,
+    float xSpacing, float ySpacing, float zSpacing, float const* data, bool const* mask,
+    float borderValue, PdeFilter<float>::ScaleType scaleType, Scheme scheme,
+    float K, bool hostReadback, int numThreads)
+    :
+    GPUPdeFilter(engine, { xBound, yBound, zBound }, { xSpacing, ySpacing, zSpacing },
+        data, mask, borderValue, scaleType, scheme, K, hostReadback, 3)
+{
+    LogAssert(factory != nullptr && numThreads > 0, "Invalid argument.");
+
+    bool const useGLSL = (factory->GetAPI() == ProgramFactory::PF_GLSL);
+    std::array<std::string, NUM_KERNELS> kernelSources =
+        (useGLSL ? msGLSLKernelSource : msHLSLKernelSource);
+    kernelSources[UPDATE] = msUpdatePixelSource + kernelSources[UPDATE];
+
+    unsigned int const threads = static_cast<unsigned int>(numThreads);
+    CreateKernels(factory, useGLSL ? msGLSLCommonSource : msHLSLCommonSource,
+        kernelSources, { threads, threads, threads });
+}
+
+
+std::string const GPUPdeFilter3::msUpdatePixelSource =
+R"(
+    // U(dx,dy,dz) is the value at offset (dx,dy,dz) of the voxel, where dx,
+    // dy and dz are in {-1,0,1}. The formulas are those of OnUpdateSingle
+    // of the CPU classes.
+    #define U(dx, dy, dz) u[(dx + 1) + 3 * ((dy + 1) + 3 * (dz + 1))]
+
+    float UpdateVoxel(float u[27], float mHalfParameter)
+    {
+        float zzz = U(0, 0, 0);
+        float mzz = U(-1, 0, 0), pzz = U(1, 0, 0);
+        float zmz = U(0, -1, 0), zpz = U(0, 1, 0);
+        float zzm = U(0, 0, -1), zzp = U(0, 0, 1);
+
+    #if SCHEME == 0
+        // GaussianBlur3
+        float uxx = invDD.x * (pzz - 2.0f * zzz + mzz);
+        float uyy = invDD.y * (zpz - 2.0f * zzz + zmz);
+        float uzz = invDD.z * (zzp - 2.0f * zzz + zzm);
+        return zzz + timeStep * (uxx + uyy + uzz);
+    #else
+        float mmz = U(-1, -1, 0), pmz = U(1, -1, 0);
+        float mpz = U(-1, 1, 0), ppz = U(1, 1, 0);
+        float mzm = U(-1, 0, -1), pzm = U(1, 0, -1);
+        float mzp = U(-1, 0, 1), pzp = U(1, 0, 1);
+        float zmm = U(0, -1, -1), zpm = U(0, 1, -1);
+        float zmp = U(0, -1, 1), zpp = U(0, 1, 1);
+    #if SCHEME == 1
+        // GradientAnisotropic3
+        float uxFwd = invD.x * (pzz - zzz);
+        float uxBwd = invD.x * (zzz - mzz);
+        float uyFwd = invD.y * (zpz - zzz);
+        float uyBwd = invD.y * (zzz - zmz);
+        float uzFwd = invD.z * (zzp - zzz);
+        float uzBwd = invD.z * (zzz - zzm);
+
+        float duvzz = halfInvD.x * (pzz - mzz);
+        float duvpz = halfInvD.x * (ppz - mpz);
+        float duvmz = halfInvD.x * (pmz - mmz);
+        float duvzp = halfInvD.x * (pzp - mzp);
+        float duvzm = halfInvD.x * (pzm - mzm);
+
+        float duzvz = halfInvD.y * (zpz - zmz);
+        float dupvz = halfInvD.y * (ppz - pmz);
+        float dumvz = halfInvD.y * (mpz - mmz);
+        float duzvp = halfInvD.y * (zpp - zmp);
+        float duzvm = halfInvD.y * (zpm - zmm);
+
+        float duzzv = halfInvD.z * (zzp - zzm);
+        float dupzv = halfInvD.z * (pzp - pzm);
+        float dumzv = halfInvD.z * (mzp - mzm);
+        float duzpv = halfInvD.z * (zpp - zpm);
+        float duzmv = halfInvD.z * (zmp - zmm);
+
+        float uxCenSqr = duvzz * duvzz;
+        float uyCenSqr = duzvz * duzvz;
+        float uzCenSqr = duzzv * duzzv;
+
+        float uxEst, uyEst, uzEst;
+
+        // estimate for C(x+1,y,z)
+        uyEst = 0.5f * (duzvz + dupvz);
+        uzEst = 0.5f * (duzzv + dupzv);
+        float cxp = exp(mHalfParameter * (uxCenSqr + uyEst * uyEst + uzEst * uzEst));
+
+        // estimate for C(x-1,y,z)
+        uyEst = 0.5f * (duzvz + dumvz);
+        uzEst = 0.5f * (duzzv + dumzv);
+        float cxm = exp(mHalfParameter * (uxCenSqr + uyEst * uyEst + uzEst * uzEst));
+
+        // estimate for C(x,y+1,z)
+        uxEst = 0.5f * (duvzz + duvpz);
+        uzEst = 0.5f * (duzzv + duzpv);
+        float cyp = exp(mHalfParameter * (uxEst * uxEst + uyCenSqr + uzEst * uzEst));
+
+        // estimate for C(x,y-1,z)
+        uxEst = 0.5f * (duvzz + duvmz);
+        uzEst = 0.5f * (duzzv + duzmv);
+        float cym = exp(mHalfParameter * (uxEst * uxEst + uyCenSqr + uzEst * uzEst));
+
+        // estimate for C(x,y,z+1)
+        uxEst = 0.5f * (duvzz + duvzp);
+        uyEst = 0.5f * (duzvz + duzvp);
+        float czp = exp(mHalfParameter * (uxEst * uxEst + uyEst * uyEst + uzCenSqr));
+
+        // estimate for C(x,y,z-1)
+        uxEst = 0.5f * (duvzz + duvzm);
+        uyEst = 0.5f * (duzvz + duzvm);
+        float czm = exp(mHalfParameter * (uxEst * uxEst + uyEst * uyEst + uzCenSqr));
+
+        return zzz + timeStep * (
+            cxp * uxFwd - cxm * uxBwd +
+            cyp * uyFwd - cym * uyBwd +
+            czp * uzFwd - czm * uzBwd);
+    #else
+        // CurvatureFlow3
+        float ux = halfInvD.x * (pzz - mzz);
+        float uy = halfInvD.y * (zpz - zmz);
+        float uz = halfInvD.z * (zzp - zzm);
+        float uxx = invDD.x * (pzz - 2.0f * zzz + mzz);
+        float uxy = fourthInvDD.x * (mmz + ppz - pmz - mpz);
+        float uxz = fourthInvDD.y * (mzm + pzp - pzm - mzp);
+        float uyy = invDD.y * (zpz - 2.0f * zzz + zmz);
+        float uyz = fourthInvDD.z * (zmm + zpp - zpm - zmp);
+        float uzz = invDD.z * (zzp - 2.0f * zzz + zzm);
+
+        float denom = ux * ux + uy * uy + uz * uz;
+        if (denom > 0.0f)
+        {
+            float numer0 = uy * (uxx * uy - uxy * ux) + ux * (uyy * ux - uxy * uy);
+            float numer1 = uz * (uxx * uz - uxz * ux) + ux * (uzz * ux - uxz * uz);
+            float numer2 = uz * (uyy * uz - uyz * uy) + uy * (uzz * uy - uyz * uz);
+            float numer = numer0 + numer1 + numer2;
+            return zzz + timeStep * numer / denom;
+        }
+        return zzz;
+    #endif
+    #endif
+    }
+)";
+
+std::string const GPUPdeFilter3::msGLSLCommonSource =
+R"(
+    uniform Parameters
+    {
+        ivec4 bounds;
+        float timeStep;
+        float K;
+        float invQuantity;
+        float padding;
+        vec4 invD;
+        vec4 halfInvD;
+        vec4 invDD;
+        vec4 fourthInvDD;
+    };
+
+    // The index of the padded voxel (x,y,z).
+    int GetIndex(int x, int y, int z)
+    {
+        return x + (bounds.x + 2) * (y + (bounds.y + 2) * z);
+    }
+)";
+
+std::array<std::string, GPUPdeFilter::NUM_KERNELS> const GPUPdeFilter3::msGLSLKernelSource =
+{
+// MASK_BORDER
+R"(
+    buffer mask { int data[]; } maskSB;
+    buffer source { float data[]; } sourceSB;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        int x = int(gl_GlobalInvocationID.x) + 1;
+        int y = int(gl_GlobalInvocationID.y) + 1;
+        int z = int(gl_GlobalInvocationID.z) + 1;
+        if (x > bounds.x || y > bounds.y || z > bounds.z)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y, z);
+        if (maskSB.data[i] != 0)
+        {
+            return;
+        }
+
+        // Only masked-in values are read and only masked-out values are
+        // written, so the update is in place.
+        int count = 0;
+        float average = 0.0f;
+        for (int dz = -1; dz <= 1; ++dz)
+        {
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    int j = GetIndex(x + dx, y + dy, z + dz);
+                    if (maskSB.data[j] != 0)
+                    {
+                        average += sourceSB.data[j];
+                        ++count;
+                    }
+                }
+            }
+        }
+
+        if (count > 0)
+        {
+            sourceSB.data[i] = average / float(count);
+        }
+    }
+)",
+
+// ROW_SUM
+R"(
+    buffer source { float data[]; } sourceSB;
+    buffer rowSums { float data[]; } rowSumsSB;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        int y = int(gl_GlobalInvocationID.x);
+        int z = int(gl_GlobalInvocationID.y);
+        if (y >= bounds.y || z >= bounds.z)
+        {
+            return;
+        }
+
+        int dy = bounds.x + 2;
+        int dz = dy * (bounds.y + 2);
+        float sum = 0.0f;
+        for (int x = 1, i = GetIndex(1, y + 1, z + 1); x <= bounds.x; ++x, ++i)
+        {
+            float ux = halfInvD.x * (sourceSB.data[i + 1] - sourceSB.data[i - 1]);
+            float uy = halfInvD.y * (sourceSB.data[i + dy] - sourceSB.data[i - dy]);
+            float uz = halfInvD.z * (sourceSB.data[i + dz] - sourceSB.data[i - dz]);
+            sum += ux * ux + uy * uy + uz * uz;
+        }
+        rowSumsSB.data[y + bounds.y * z] = sum;
+    }
+)",
+
+// PARAMETER
+"",
+
+// UPDATE
+R"(
+    buffer mask { int data[]; } maskSB;
+    buffer source { float data[]; } sourceSB;
+    buffer target { float data[]; } targetSB;
+#if SCHEME == 1
+    buffer gradientParameter { float data[]; } gradientParameterSB;
+#endif
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+    void main()
+    {
+        int x = int(gl_GlobalInvocationID.x) + 1;
+        int y = int(gl_GlobalInvocationID.y) + 1;
+        int z = int(gl_GlobalInvocationID.z) + 1;
+        if (x > bounds.x || y > bounds.y || z > bounds.z)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y, z);
+        if (maskSB.data[i] == 0)
+        {
+            targetSB.data[i] = sourceSB.data[i];
+            return;
+        }
+
+        float u[27];
+        for (int dz = -1, k = 0; dz <= 1; ++dz)
+        {
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx, ++k)
+                {
+                    u[k] = sourceSB.data[GetIndex(x + dx, y + dy, z + dz)];
+                }
+            }
+        }
+
+#if SCHEME == 1
+        float mHalfParameter = gradientParameterSB.data[0];
+#else
+        float mHalfParameter = 0.0f;
+#endif
+        targetSB.data[i] = UpdateVoxel(u, mHalfParameter);
+    }
+)"
+};
+
+std::string const GPUPdeFilter3::msHLSLCommonSource =
+R"(
+    cbuffer Parameters
+    {
+        int4 bounds;
+        float timeStep;
+        float K;
+        float invQuantity;
+        float padding;
+        float4 invD;
+        float4 halfInvD;
+        float4 invDD;
+        float4 fourthInvDD;
+    };
+
+    // The index of the padded voxel (x,y,z).
+    int GetIndex(int x, int y, int z)
+    {
+        return x + (bounds.x + 2) * (y + (bounds.y + 2) * z);
+    }
+)";
+
+std::array<std::string, GPUPdeFilter::NUM_KERNELS> const GPUPdeFilter3::msHLSLKernelSource =
+{
+// MASK_BORDER
+R"(
+    StructuredBuffer<int> mask;
+    RWStructuredBuffer<float> source;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int x = int(dt.x) + 1;
+        int y = int(dt.y) + 1;
+        int z = int(dt.z) + 1;
+        if (x > bounds.x || y > bounds.y || z > bounds.z)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y, z);
+        if (mask[i] != 0)
+        {
+            return;
+        }
+
+        // Only masked-in values are read and only masked-out values are
+        // written, so the update is in place.
+        int count = 0;
+        float average = 0.0f;
+        [unroll]
+        for (int dz = -1; dz <= 1; ++dz)
+        {
+            [unroll]
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                [unroll]
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    int j = GetIndex(x + dx, y + dy, z + dz);
+                    if (mask[j] != 0)
+                    {
+                        average += source[j];
+                        ++count;
+                    }
+                }
+            }
+        }
+
+        if (count > 0)
+        {
+            source[i] = average / float(count);
+        }
+    }
+)",
+
+// ROW_SUM
+R"(
+    StructuredBuffer<float> source;
+    RWStructuredBuffer<float> rowSums;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int y = int(dt.x);
+        int z = int(dt.y);
+        if (y >= bounds.y || z >= bounds.z)
+        {
+            return;
+        }
+
+        int dy = bounds.x + 2;
+        int dz = dy * (bounds.y + 2);
+        float sum = 0.0f;
+        for (int x = 1, i = GetIndex(1, y + 1, z + 1); x <= bounds.x; ++x, ++i)
+        {
+            float ux = halfInvD.x * (source[i + 1] - source[i - 1]);
+            float uy = halfInvD.y * (source[i + dy] - source[i - dy]);
+            float uz = halfInvD.z * (source[i + dz] - source[i - dz]);
+            sum += ux * ux + uy * uy + uz * uz;
+        }
+        rowSums[y + bounds.y * z] = sum;
+    }
+)",
+
+// PARAMETER
+"",
+
+// UPDATE
+R"(
+    StructuredBuffer<int> mask;
+    StructuredBuffer<float> source;
+    RWStructuredBuffer<float> target;
+#if SCHEME == 1
+    StructuredBuffer<float> gradientParameter;
+#endif
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int x = int(dt.x) + 1;
+        int y = int(dt.y) + 1;
+        int z = int(dt.z) + 1;
+        if (x > bounds.x || y > bounds.y || z > bounds.z)
+        {
+            return;
+        }
+
+        int i = GetIndex(x, y, z);
+        if (mask[i] == 0)
+        {
+            target[i] = source[i];
+            return;
+        }
+
+        float u[27];
+        [unroll]
+        for (int dz = -1, k = 0; dz <= 1; ++dz)
+        {
+            [unroll]
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                [unroll]
+                for (int dx = -1; dx <= 1; ++dx, ++k)
+                {
+                    u[k] = source[GetIndex(x + dx, y + dy, z + dz)];
+                }
+            }
+        }
+
+#if SCHEME == 1
+        float mHalfParameter = gradientParameter[0];
+#else
+        float mHalfParameter = 0.0f;
+#endif
+        target[i] = UpdateVoxel(u, mHalfParameter);
+    }
+)"
+};
@@ -0,0 +1,59 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <MathematicsGPU/GPUPdeFilter.h>
+
+// A GPU-based implementation of the 3D PDE filters GaussianBlur3,
+// GradientAnisotropic3 and CurvatureFlow3. The constructor parameters are
+// those of the CPU classes followed by the scheme. K is used only by
+// GRADIENT_ANISOTROPIC. The padded image has (xBound+2)*(yBound+2)*
+// (zBound+2) values, so the unpadded voxel (x,y,z) has index (x+1) +
+// (xBound+2)*((y+1) + (yBound+2)*(z+1)).
+
+namespace gte
+{
+    class GPUPdeFilter3 : public GPUPdeFilter
+    {
+    public:
+        // The voxel kernels are dispatched in 3D thread groups of
+        // numThreads^3 threads.
+        GPUPdeFilter3(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            int xBound, int yBound, int zBound, float xSpacing, float ySpacing,
+            float zSpacing, float const* data, bool const* mask, float borderValue,
+            PdeFilter<float>::ScaleType scaleType, Scheme scheme,
+            float K = 0.0f, bool hostReadback = false, int numThreads = 4);
+
+        virtual ~GPUPdeFilter3() = default;
+
+        inline int GetXBound() const
+        {
+            return mBounds[0];
+        }
+
+        inline int GetYBound() const
+        {
+            return mBounds[1];
+        }
+
+        inline int GetZBound() const
+        {
+            return mBounds[2];
+        }
+
+    private:
+        // The per-voxel update of the schemes is written once for both
+        // shader languages.
+        static std::string const msUpdatePixelSource;
+        static std::string const msGLSLCommonSource;
+        static std::string const msHLSLCommonSource;
+        static std::array<std::string, NUM_KERNELS> const msGLSLKernelSource;
+        static std::array<std::string, NUM_KERNELS> const msHLSLKernelSource;
+    };
+}
@@ -0,0 +1,862 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUSplineSurfaceTessellator.h>
+#include <Mathematics/Vector2.h>
+#include <algorithm>
+#include <cstring>
+using namespace gte;
+
+void GPUSplineSurfaceTessellator::Initialize(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, std::array<Dimension, 2> const& dimension,
+    std::array<int, 2> const& numControls, unsigned int maxSegments0,
+    unsigned int maxSegments1, unsigned int maxSpanSegments, int numThreads)
+{
+    LogAssert(engine != nullptr && factory != nullptr && maxSpanSegments > 0
+        && numThreads > 0, "Invalid argument.");
+
+    std::array<unsigned int, 2> const maxSegments = { maxSegments0, maxSegments1 };
+    std::array<unsigned int, 2> numSpans;
+    for (int dim = 0; dim < 2; ++dim)
+    {
+        numSpans[dim] = static_cast<unsigned int>(dimension[dim].spans.size());
+        LogAssert(numSpans[dim] > 0 && maxSegments[dim] >= numSpans[dim],
+            "Invalid argument.");
+    }
+
+    mEngine = engine;
+    mNumControls = numControls;
+    mNumSamples = { 0, 0 };
+    mNumTriangles = 0;
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), true);
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->pvwMatrix.MakeIdentity();
+    parameters->viewportWidth = 1.0f;
+    parameters->viewportHeight = 1.0f;
+    parameters->pixelTolerance = 1.0f;
+    parameters->padding = 0.0f;
+    parameters->numControls0 = numControls[0];
+    parameters->numControls1 = numControls[1];
+    parameters->numSpans0 = static_cast<int32_t>(numSpans[0]);
+    parameters->numSpans1 = static_cast<int32_t>(numSpans[1]);
+    parameters->maxSegments0 = static_cast<int32_t>(maxSegments0);
+    parameters->maxSegments1 = static_cast<int32_t>(maxSegments1);
+    parameters->maxSpanSegments = static_cast<int32_t>(maxSpanSegments);
+    parameters->knotOffset1 = static_cast<int32_t>(dimension[0].knots.size());
+
+    mControls = std::make_shared<StructuredBuffer>(numControls[0] * numControls[1],
+        sizeof(Vector4<float>));
+    mControls->SetUsage(Resource::DYNAMIC_UPDATE);
+    std::memset(mControls->GetData(), 0, mControls->GetNumBytes());
+
+    // The knots and spans of dimension 1 follow those of dimension 0.
+    mKnots = std::make_shared<StructuredBuffer>(static_cast<unsigned int>(
+        dimension[0].knots.size() + dimension[1].knots.size()), sizeof(float));
+    auto knots = mKnots->Get<float>();
+    knots = std::copy(dimension[0].knots.begin(), dimension[0].knots.end(), knots);
+    std::copy(dimension[1].knots.begin(), dimension[1].knots.end(), knots);
+
+    mSpans = std::make_shared<StructuredBuffer>(numSpans[0] + numSpans[1],
+        sizeof(Vector4<float>));
+    auto spans = mSpans->Get<Vector4<float>>();
+    spans = std::copy(dimension[0].spans.begin(), dimension[0].spans.end(), spans);
+    std::copy(dimension[1].spans.begin(), dimension[1].spans.end(), spans);
+
+    // The scan kernel resets the segment counts to zero after reading
+    // them, so the counts are zero at the start of each tessellation.
+    mSegments = std::make_shared<StructuredBuffer>(numSpans[0] + numSpans[1],
+        sizeof(uint32_t));
+    mSegments->SetUsage(Resource::SHADER_OUTPUT);
+    std::memset(mSegments->GetData(), 0, mSegments->GetNumBytes());
+
+    // The samples (t,s) of dimension 1 start at index maxSegments0+1. The
+    // s-component is the span index of t.
+    mSamples = std::make_shared<StructuredBuffer>(maxSegments0 + maxSegments1 + 2,
+        sizeof(Vector2<float>));
+    mSamples->SetUsage(Resource::SHADER_OUTPUT);
+
+    mInfo = std::make_shared<StructuredBuffer>(2, sizeof(uint32_t));
+    mInfo->SetUsage(Resource::SHADER_OUTPUT);
+    mInfo->SetCopyType(Resource::COPY_STAGING_TO_CPU);
+    std::memset(mInfo->GetData(), 0, mInfo->GetNumBytes());
+
+    mGrid = std::make_shared<StructuredBuffer>((maxSegments0 + 1) * (maxSegments1 + 1),
+        sizeof(Vertex));
+    mGrid->SetUsage(Resource::SHADER_OUTPUT);
+
+    unsigned int const maxTriangles = 2 * maxSegments0 * maxSegments1;
+    mVertices = std::make_shared<StructuredBuffer>(3 * maxTriangles, sizeof(Vertex));
+    mVertices->SetUsage(Resource::SHADER_OUTPUT);
+
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32B32A32_FLOAT, 0);
+    vformat.Bind(VA_NORMAL, DF_R32G32B32A32_FLOAT, 0);
+    mVertexBuffer = std::make_shared<VertexBuffer>(vformat, mVertices);
+    mVertexBuffer->SetNumActiveElements(0);
+    mIndexBuffer = std::make_shared<IndexBuffer>(IP_TRIMESH, maxTriangles);
+    mIndexBuffer->SetNumActivePrimitives(0);
+
+    unsigned int const threads = static_cast<unsigned int>(numThreads);
+    for (int dim = 0; dim < 2; ++dim)
+    {
+        mNumSpanGroups[dim] = (numSpans[dim] + threads - 1) / threads;
+        mNumSampleGroups[dim] = (maxSegments[dim] + threads) / threads;
+        mNumSegmentGroups[dim] = (maxSegments[dim] + threads - 1) / threads;
+    }
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numThreads);
+    factory->defines.Set("NUM_Y_THREADS", numThreads);
+    factory->defines.Set("DEGREE0", dimension[0].degree);
+    factory->defines.Set("DEGREE1", dimension[1].degree);
+    factory->defines.Set("MAX_DEGREE", std::max(dimension[0].degree, dimension[1].degree));
+    for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+    {
+        std::string source = (api == ProgramFactory::PF_GLSL ?
+            msGLSLCommonSource + msGLSLKernelSource[kernel] :
+            msHLSLCommonSource + msHLSLKernelSource[kernel]);
+
+        mKernels[kernel] = factory->CreateFromSource(source);
+        LogAssert(mKernels[kernel] != nullptr, "Failed to compile shader.");
+    }
+    factory->PopDefines();
+
+    auto cshader = mKernels[ESTIMATE]->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("controls", mControls);
+    cshader->Set("spans", mSpans);
+    cshader->Set("segments", mSegments);
+
+    cshader = mKernels[SCAN]->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("spans", mSpans);
+    cshader->Set("segments", mSegments);
+    cshader->Set("samples", mSamples);
+    cshader->Set("info", mInfo);
+
+    cshader = mKernels[EVALUATE]->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("controls", mControls);
+    cshader->Set("knots", mKnots);
+    cshader->Set("samples", mSamples);
+    cshader->Set("info", mInfo);
+    cshader->Set("grid", mGrid);
+
+    cshader = mKernels[TRIANGULATE]->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("info", mInfo);
+    cshader->Set("grid", mGrid);
+    cshader->Set("vertices", mVertices);
+}
+
+void GPUSplineSurfaceTessellator::SetControl(int i0, int i1, Vector3<float> const& control,
+    float weight)
+{
+    LogAssert(0 <= i0 && i0 < mNumControls[0] && 0 <= i1 && i1 < mNumControls[1]
+        && weight > 0.0f, "Invalid argument.");
+
+    mControls->Get<Vector4<float>>()[i0 + mNumControls[0] * i1] =
+    {
+        weight * control[0],
+        weight * control[1],
+        weight * control[2],
+        weight
+    };
+}
+
+unsigned int GPUSplineSurfaceTessellator::Execute(Matrix4x4<float> const& pvwMatrix,
+    float viewportWidth, float viewportHeight, float pixelTolerance)
+{
+    LogAssert(viewportWidth > 0.0f && viewportHeight > 0.0f && pixelTolerance > 0.0f,
+        "Invalid argument.");
+
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->pvwMatrix = pvwMatrix;
+    parameters->viewportWidth = viewportWidth;
+    parameters->viewportHeight = viewportHeight;
+    parameters->pixelTolerance = pixelTolerance;
+    mEngine->Update(mParameters);
+
+    mEngine->Execute(mKernels[ESTIMATE], mNumSpanGroups[0], mNumSpanGroups[1], 1);
+    mEngine->Execute(mKernels[SCAN], 1, 1, 1);
+    mEngine->Execute(mKernels[EVALUATE], mNumSampleGroups[0], mNumSampleGroups[1], 1);
+    mEngine->Execute(mKernels[TRIANGULATE], mNumSegmentGroups[0], mNumSegmentGroups[1], 1);
+
+    mEngine->CopyGpuToCpu(mInfo);
+    auto info = mInfo->Get<uint32_t>();
+    mNumSamples = { info[0], info[1] };
+    mNumTriangles = 2 * (mNumSamples[0] - 1) * (mNumSamples[1] - 1);
+    mVertexBuffer->SetNumActiveElements(3 * mNumTriangles);
+    mIndexBuffer->SetNumActivePrimitives(mNumTriangles);
+    return mNumTriangles;
+}
+
+
+std::string const GPUSplineSurfaceTessellator::msGLSLCommonSource =
+R"(
+    uniform Parameters
+    {
+        mat4 pvwMatrix;
+        float viewportWidth;
+        float viewportHeight;
+        float pixelTolerance;
+        float padding;
+        int numControls0;
+        int numControls1;
+        int numSpans0;
+        int numSpans1;
+        int maxSegments0;
+        int maxSegments1;
+        int maxSpanSegments;
+        int knotOffset1;
+    };
+
+    struct Vertex
+    {
+        vec4 position;
+        vec4 normal;
+    };
+
+    // The index of control (i0,i1). The indices of the controls of a
+    // periodic spline are wrapped.
+    int GetControl(int i0, int i1)
+    {
+        int j0 = (i0 >= numControls0 ? i0 - numControls0 : i0);
+        int j1 = (i1 >= numControls1 ? i1 - numControls1 : i1);
+        return j0 + numControls0 * j1;
+    }
+)";
+
+std::array<std::string, GPUSplineSurfaceTessellator::NUM_KERNELS> const
+GPUSplineSurfaceTessellator::msGLSLKernelSource =
+{
+// ESTIMATE
+R"(
+    buffer controls { vec4 data[]; } controlsSB;
+    buffer spans { vec4 data[]; } spansSB;
+    buffer segments { uint data[]; } segmentsSB;
+
+    // The number of segments for which linear interpolation of a curve of
+    // the specified degree, whose control polygon has maximum second
+    // difference length d2, has error at most the pixel tolerance.
+    uint GetNumSegments(int degree, float d2)
+    {
+        float n = ceil(sqrt(float(degree * (degree - 1)) * d2 / (8.0f * pixelTolerance)));
+        return uint(clamp(n, 1.0f, float(maxSpanSegments)));
+    }
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        int a0 = int(gl_GlobalInvocationID.x);
+        int a1 = int(gl_GlobalInvocationID.y);
+        if (a0 >= numSpans0 || a1 >= numSpans1)
+        {
+            return;
+        }
+
+        // Project the controls of the span rectangle to window
+        // coordinates, up to translation.
+        int s0 = int(spansSB.data[a0].z);
+        int s1 = int(spansSB.data[numSpans0 + a1].z);
+        vec2 halfSize = vec2(0.5f * viewportWidth, 0.5f * viewportHeight);
+        vec2 window[(DEGREE0 + 1) * (DEGREE1 + 1)];
+        bool inFront = true;
+        for (int j1 = 0, j = 0; j1 <= DEGREE1; ++j1)
+        {
+            for (int j0 = 0; j0 <= DEGREE0; ++j0, ++j)
+            {
+                vec4 control = controlsSB.data[GetControl(s0 - DEGREE0 + j0, s1 - DEGREE1 + j1)];
+                vec4 position = vec4(control.xyz / control.w, 1.0f);
+#if GTE_USE_MAT_VEC
+                vec4 clipPosition = pvwMatrix * position;
+#else
+                vec4 clipPosition = position * pvwMatrix;
+#endif
+                if (clipPosition.w > 0.0f)
+                {
+                    window[j] = halfSize * clipPosition.xy / clipPosition.w;
+                }
+                else
+                {
+                    window[j] = vec2(0.0f, 0.0f);
+                    inFront = false;
+                }
+            }
+        }
+
+        uint numSegments0 = uint(maxSpanSegments);
+        uint numSegments1 = uint(maxSpanSegments);
+        if (inFront)
+        {
+            float d2Max0 = 0.0f;
+            for (int j1 = 0; j1 <= DEGREE1; ++j1)
+            {
+                for (int j0 = 1; j0 < DEGREE0; ++j0)
+                {
+                    int j = j0 + (DEGREE0 + 1) * j1;
+                    d2Max0 = max(d2Max0, length(window[j + 1] - 2.0f * window[j] + window[j - 1]));
+                }
+            }
+
+            float d2Max1 = 0.0f;
+            for (int j1 = 1; j1 < DEGREE1; ++j1)
+            {
+                for (int j0 = 0; j0 <= DEGREE0; ++j0)
+                {
+                    int j = j0 + (DEGREE0 + 1) * j1;
+                    d2Max1 = max(d2Max1, length(window[j + DEGREE0 + 1] - 2.0f * window[j]
+                        + window[j - DEGREE0 - 1]));
+                }
+            }
+
+            numSegments0 = GetNumSegments(DEGREE0, d2Max0);
+            numSegments1 = GetNumSegments(DEGREE1, d2Max1);
+        }
+
+        atomicMax(segmentsSB.data[a0], numSegments0);
+        atomicMax(segmentsSB.data[numSpans0 + a1], numSegments1);
+    }
+)",
+
+// SCAN
+R"(
+    buffer spans { vec4 data[]; } spansSB;
+    buffer segments { uint data[]; } segmentsSB;
+    buffer samples { vec2 data[]; } samplesSB;
+    buffer info { uint data[]; } infoSB;
+
+    // Thread d generates the samples of dimension d.
+    layout (local_size_x = 2, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int d = int(gl_LocalInvocationID.x);
+        int numSpans = (d == 0 ? numSpans0 : numSpans1);
+        int spanOffset = (d == 0 ? 0 : numSpans0);
+        uint maxSegments = uint(d == 0 ? maxSegments0 : maxSegments1);
+        int sampleOffset = (d == 0 ? 0 : maxSegments0 + 1);
+
+        // Halve the segment counts (rounding up) until their total fits.
+        // The loop terminates because numSpans <= maxSegments.
+        uint shift = 0u;
+        uint total;
+        for (;;)
+        {
+            total = 0u;
+            for (int a = 0; a < numSpans; ++a)
+            {
+                uint n = segmentsSB.data[spanOffset + a];
+                total += max((n + (1u << shift) - 1u) >> shift, 1u);
+            }
+            if (total <= maxSegments)
+            {
+                break;
+            }
+            ++shift;
+        }
+
+        int k = sampleOffset;
+        for (int a = 0; a < numSpans; ++a)
+        {
+            uint n = segmentsSB.data[spanOffset + a];
+            n = max((n + (1u << shift) - 1u) >> shift, 1u);
+            segmentsSB.data[spanOffset + a] = 0u;
+
+            vec4 span = spansSB.data[spanOffset + a];
+            float dt = (span.y - span.x) / float(n);
+            for (uint i = 0u; i < n; ++i, ++k)
+            {
+                samplesSB.data[k] = vec2(span.x + dt * float(i), span.z);
+            }
+        }
+
+        vec4 last = spansSB.data[spanOffset + numSpans - 1];
+        samplesSB.data[k] = vec2(last.y, last.z);
+        infoSB.data[d] = total + 1u;
+    }
+)",
+
+// EVALUATE
+R"(
+    buffer controls { vec4 data[]; } controlsSB;
+    buffer knots { float data[]; } knotsSB;
+    buffer samples { vec2 data[]; } samplesSB;
+    buffer info { uint data[]; } infoSB;
+    buffer grid { Vertex data[]; } gridSB;
+
+    // Compute the nonzero basis functions N[r] = N_{s-d+r,d}(t) and their
+    // derivatives D[r] for 0 <= r <= d, where knot[s] <= t <= knot[s+1].
+    // The knots of the dimension start at the specified offset. The
+    // algorithm is A2.2 of "The NURBS Book" by Les Piegl and Wayne Tiller.
+    void GetBasis(int offset, int s, float t, int d, out float N[MAX_DEGREE + 1],
+        out float D[MAX_DEGREE + 1])
+    {
+        float left[MAX_DEGREE + 1], right[MAX_DEGREE + 1];
+        N[0] = 1.0f;
+        D[0] = 0.0f;
+        for (int j = 1; j <= d; ++j)
+        {
+            left[j] = t - knotsSB.data[offset + s + 1 - j];
+            right[j] = knotsSB.data[offset + s + j] - t;
+
+            if (j == d)
+            {
+                // The derivatives are linear combinations of the basis
+                // functions of degree d-1.
+                for (int r = 0; r <= d; ++r)
+                {
+                    float value = 0.0f;
+                    if (r > 0)
+                    {
+                        value += N[r - 1] / (knotsSB.data[offset + s + r]
+                            - knotsSB.data[offset + s - d + r]);
+                    }
+                    if (r < d)
+                    {
+                        value -= N[r] / (knotsSB.data[offset + s + r + 1]
+                            - knotsSB.data[offset + s - d + r + 1]);
+                    }
+                    D[r] = float(d) * value;
+                }
+            }
+
+            float saved = 0.0f;
+            for (int r = 0; r < j; ++r)
+            {
+                float temp = N[r] / (right[r + 1] + left[j - r]);
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            N[j] = saved;
+        }
+    }
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        int i0 = int(gl_GlobalInvocationID.x);
+        int i1 = int(gl_GlobalInvocationID.y);
+        int numSamples0 = int(infoSB.data[0]);
+        int numSamples1 = int(infoSB.data[1]);
+        if (i0 >= numSamples0 || i1 >= numSamples1)
+        {
+            return;
+        }
+
+        vec2 sample0 = samplesSB.data[i0];
+        vec2 sample1 = samplesSB.data[maxSegments0 + 1 + i1];
+        int s0 = int(sample0.y);
+        int s1 = int(sample1.y);
+        float N0[MAX_DEGREE + 1], D0[MAX_DEGREE + 1];
+        float N1[MAX_DEGREE + 1], D1[MAX_DEGREE + 1];
+        GetBasis(0, s0, sample0.x, DEGREE0, N0, D0);
+        GetBasis(knotOffset1, s1, sample1.x, DEGREE1, N1, D1);
+
+        // Evaluate the homogeneous surface and its first-order partial
+        // derivatives.
+        vec4 H = vec4(0.0f), HDer0 = vec4(0.0f), HDer1 = vec4(0.0f);
+        for (int j1 = 0; j1 <= DEGREE1; ++j1)
+        {
+            for (int j0 = 0; j0 <= DEGREE0; ++j0)
+            {
+                vec4 control = controlsSB.data[GetControl(s0 - DEGREE0 + j0, s1 - DEGREE1 + j1)];
+                H += (N0[j0] * N1[j1]) * control;
+                HDer0 += (D0[j0] * N1[j1]) * control;
+                HDer1 += (N0[j0] * D1[j1]) * control;
+            }
+        }
+
+        vec3 position = H.xyz / H.w;
+        vec3 der0 = (HDer0.xyz - HDer0.w * position) / H.w;
+        vec3 der1 = (HDer1.xyz - HDer1.w * position) / H.w;
+        vec3 normal = cross(der0, der1);
+        float len = length(normal);
+        if (len > 0.0f)
+        {
+            normal /= len;
+        }
+
+        int v = i0 + numSamples0 * i1;
+        gridSB.data[v].position = vec4(position, 1.0f);
+        gridSB.data[v].normal = vec4(normal, 0.0f);
+    }
+)",
+
+// TRIANGULATE
+R"(
+    buffer info { uint data[]; } infoSB;
+    buffer grid { Vertex data[]; } gridSB;
+    buffer vertices { Vertex data[]; } verticesSB;
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = 1) in;
+    void main()
+    {
+        int i0 = int(gl_GlobalInvocationID.x);
+        int i1 = int(gl_GlobalInvocationID.y);
+        int numSamples0 = int(infoSB.data[0]);
+        int numSamples1 = int(infoSB.data[1]);
+        if (i0 + 1 >= numSamples0 || i1 + 1 >= numSamples1)
+        {
+            return;
+        }
+
+        int v00 = i0 + numSamples0 * i1;
+        int v10 = v00 + 1;
+        int v01 = v00 + numSamples0;
+        int v11 = v01 + 1;
+        int v = 6 * (i0 + (numSamples0 - 1) * i1);
+        verticesSB.data[v] = gridSB.data[v00];
+        verticesSB.data[v + 1] = gridSB.data[v10];
+        verticesSB.data[v + 2] = gridSB.data[v11];
+        verticesSB.data[v + 3] = gridSB.data[v00];
+        verticesSB.data[v + 4] = gridSB.data[v11];
+        verticesSB.data[v + 5] = gridSB.data[v01];
+    }
+)"
+};
+
+std::string const GPUSplineSurfaceTessellator::msHLSLCommonSource =
+R"(
+    cbuffer Parameters
+    {
+        float4x4 pvwMatrix;
+        float viewportWidth;
+        float viewportHeight;
+        float pixelTolerance;
+        float padding;
+        int numControls0;
+        int numControls1;
+        int numSpans0;
+        int numSpans1;
+        int maxSegments0;
+        int maxSegments1;
+        int maxSpanSegments;
+        int knotOffset1;
+    };
+
+    struct Vertex
+    {
+        float4 position;
+        float4 normal;
+    };
+
+    // The index of control (i0,i1). The indices of the controls of a
+    // periodic spline are wrapped.
+    int GetControl(int i0, int i1)
+    {
+        int j0 = (i0 >= numControls0 ? i0 - numControls0 : i0);
+        int j1 = (i1 >= numControls1 ? i1 - numControls1 : i1);
+        return j0 + numControls0 * j1;
+    }
+)";
+
+std::array<std::string, GPUSplineSurfaceTessellator::NUM_KERNELS> const
+GPUSplineSurfaceTessellator::msHLSLKernelSource =
+{
+// ESTIMATE
+R"(
+    StructuredBuffer<float4> controls;
+    StructuredBuffer<float4> spans;
+    RWStructuredBuffer<uint> segments;
+
+    // The number of segments for which linear interpolation of a curve of
+    // the specified degree, whose control polygon has maximum second
+    // difference length d2, has error at most the pixel tolerance.
+    uint GetNumSegments(int degree, float d2)
+    {
+        float n = ceil(sqrt(float(degree * (degree - 1)) * d2 / (8.0f * pixelTolerance)));
+        return uint(clamp(n, 1.0f, float(maxSpanSegments)));
+    }
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int a0 = int(dt.x);
+        int a1 = int(dt.y);
+        if (a0 >= numSpans0 || a1 >= numSpans1)
+        {
+            return;
+        }
+
+        // Project the controls of the span rectangle to window
+        // coordinates, up to translation.
+        int s0 = int(spans[a0].z);
+        int s1 = int(spans[numSpans0 + a1].z);
+        float2 halfSize = float2(0.5f * viewportWidth, 0.5f * viewportHeight);
+        float2 window[(DEGREE0 + 1) * (DEGREE1 + 1)];
+        bool inFront = true;
+        int j0, j1, j;
+        for (j1 = 0, j = 0; j1 <= DEGREE1; ++j1)
+        {
+            for (j0 = 0; j0 <= DEGREE0; ++j0, ++j)
+            {
+                float4 control = controls[GetControl(s0 - DEGREE0 + j0, s1 - DEGREE1 + j1)];
+                float4 position = float4(control.xyz / control.w, 1.0f);
+#if GTE_USE_MAT_VEC
+                float4 clipPosition = mul(pvwMatrix, position);
+#else
+                float4 clipPosition = mul(position, pvwMatrix);
+#endif
+                if (clipPosition.w > 0.0f)
+                {
+                    window[j] = halfSize * clipPosition.xy / clipPosition.w;
+                }
+                else
+                {
+                    window[j] = float2(0.0f, 0.0f);
+                    inFront = false;
+                }
+            }
+        }
+
+        uint numSegments0 = uint(maxSpanSegments);
+        uint numSegments1 = uint(maxSpanSegments);
+        if (inFront)
+        {
+            float d2Max0 = 0.0f;
+            for (j1 = 0; j1 <= DEGREE1; ++j1)
+            {
+                for (j0 = 1; j0 < DEGREE0; ++j0)
+                {
+                    j = j0 + (DEGREE0 + 1) * j1;
+                    d2Max0 = max(d2Max0, length(window[j + 1] - 2.0f * window[j] + window[j - 1]));
+                }
+            }
+
+            float d2Max1 = 0.0f;
+            for (j1 = 1; j1 < DEGREE1; ++j1)
+            {
+                for (j0 = 0; j0 <= DEGREE0; ++j0)
+                {
+                    j = j0 + (DEGREE0 + 1) * j1;
+                    d2Max1 = max(d2Max1, length(window[j + DEGREE0 + 1] - 2.0f * window[j]
+                        + window[j - DEGREE0 - 1]));
+                }
+            }
+
+            numSegments0 = GetNumSegments(DEGREE0, d2Max0);
+            numSegments1 = GetNumSegments(DEGREE1, d2Max1);
+        }
+
+        uint original;
+        InterlockedMax(segments[a0], numSegments0, original);
+        InterlockedMax(segments[numSpans0 + a1], numSegments1, original);
+    }
+)",
+
+// SCAN
+R"(
+    StructuredBuffer<float4> spans;
+    RWStructuredBuffer<uint> segments;
+    RWStructuredBuffer<float2> samples;
+    RWStructuredBuffer<uint> info;
+
+    // Thread d generates the samples of dimension d.
+    [numthreads(2, 1, 1)]
+    void CSMain(uint3 gtID : SV_GroupThreadID)
+    {
+        int d = int(gtID.x);
+        int numSpans = (d == 0 ? numSpans0 : numSpans1);
+        int spanOffset = (d == 0 ? 0 : numSpans0);
+        uint maxSegments = uint(d == 0 ? maxSegments0 : maxSegments1);
+        int sampleOffset = (d == 0 ? 0 : maxSegments0 + 1);
+
+        // Halve the segment counts (rounding up) until their total fits.
+        // The loop terminates because numSpans <= maxSegments.
+        uint shift = 0;
+        uint total = 0;
+        int a;
+        uint n;
+        [loop]
+        for (;;)
+        {
+            total = 0;
+            for (a = 0; a < numSpans; ++a)
+            {
+                n = segments[spanOffset + a];
+                total += max((n + (1u << shift) - 1u) >> shift, 1u);
+            }
+            if (total <= maxSegments)
+            {
+                break;
+            }
+            ++shift;
+        }
+
+        int k = sampleOffset;
+        for (a = 0; a < numSpans; ++a)
+        {
+            n = segments[spanOffset + a];
+            n = max((n + (1u << shift) - 1u) >> shift, 1u);
+            segments[spanOffset + a] = 0;
+
+            float4 span = spans[spanOffset + a];
+            float dt = (span.y - span.x) / float(n);
+            for (uint i = 0; i < n; ++i, ++k)
+            {
+                samples[k] = float2(span.x + dt * float(i), span.z);
+            }
+        }
+
+        float4 last = spans[spanOffset + numSpans - 1];
+        samples[k] = float2(last.y, last.z);
+        info[d] = total + 1;
+    }
+)",
+
+// EVALUATE
+R"(
+    StructuredBuffer<float4> controls;
+    StructuredBuffer<float> knots;
+    StructuredBuffer<float2> samples;
+    StructuredBuffer<uint> info;
+    RWStructuredBuffer<Vertex> grid;
+
+    // Compute the nonzero basis functions N[r] = N_{s-d+r,d}(t) and their
+    // derivatives D[r] for 0 <= r <= d, where knot[s] <= t <= knot[s+1].
+    // The knots of the dimension start at the specified offset. The
+    // algorithm is A2.2 of "The NURBS Book" by Les Piegl and Wayne Tiller.
+    void GetBasis(int offset, int s, float t, int d, out float N[MAX_DEGREE + 1],
+        out float D[MAX_DEGREE + 1])
+    {
+        float left[MAX_DEGREE + 1], right[MAX_DEGREE + 1];
+        int j, r;
+        for (j = 0; j <= MAX_DEGREE; ++j)
+        {
+            N[j] = 0.0f;
+            D[j] = 0.0f;
+            left[j] = 0.0f;
+            right[j] = 0.0f;
+        }
+
+        N[0] = 1.0f;
+        for (j = 1; j <= d; ++j)
+        {
+            left[j] = t - knots[offset + s + 1 - j];
+            right[j] = knots[offset + s + j] - t;
+
+            if (j == d)
+            {
+                // The derivatives are linear combinations of the basis
+                // functions of degree d-1.
+                for (r = 0; r <= d; ++r)
+                {
+                    float value = 0.0f;
+                    if (r > 0)
+                    {
+                        value += N[r - 1] / (knots[offset + s + r]
+                            - knots[offset + s - d + r]);
+                    }
+                    if (r < d)
+                    {
+                        value -= N[r] / (knots[offset + s + r + 1]
+                            - knots[offset + s - d + r + 1]);
+                    }
+                    D[r] = float(d) * value;
+                }
+            }
+
+            float saved = 0.0f;
+            for (r = 0; r < j; ++r)
+            {
+                float temp = N[r] / (right[r + 1] + left[j - r]);
+                N[r] = saved + right[r + 1] * temp;
+                saved = left[j - r] * temp;
+            }
+            N[j] = saved;
+        }
+    }
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int i0 = int(dt.x);
+        int i1 = int(dt.y);
+        int numSamples0 = int(info[0]);
+        int numSamples1 = int(info[1]);
+        if (i0 >= numSamples0 || i1 >= numSamples1)
+        {
+            return;
+        }
+
+        float2 sample0 = samples[i0];
+        float2 sample1 = samples[maxSegments0 + 1 + i1];
+        int s0 = int(sample0.y);
+        int s1 = int(sample1.y);
+        float N0[MAX_DEGREE + 1], D0[MAX_DEGREE + 1];
+        float N1[MAX_DEGREE + 1], D1[MAX_DEGREE + 1];
+        GetBasis(0, s0, sample0.x, DEGREE0, N0, D0);
+        GetBasis(knotOffset1, s1, sample1.x, DEGREE1, N1, D1);
+
+        // Evaluate the homogeneous surface and its first-order partial
+        // derivatives.
+        float4 H = float4(0.0f, 0.0f, 0.0f, 0.0f);
+        float4 HDer0 = H, HDer1 = H;
+        for (int j1 = 0; j1 <= DEGREE1; ++j1)
+        {
+            for (int j0 = 0; j0 <= DEGREE0; ++j0)
+            {
+                float4 control = controls[GetControl(s0 - DEGREE0 + j0, s1 - DEGREE1 + j1)];
+                H += (N0[j0] * N1[j1]) * control;
+                HDer0 += (D0[j0] * N1[j1]) * control;
+                HDer1 += (N0[j0] * D1[j1]) * control;
+            }
+        }
+
+        float3 position = H.xyz / H.w;
+        float3 der0 = (HDer0.xyz - HDer0.w * position) / H.w;
+        float3 der1 = (HDer1.xyz - HDer1.w * position) / H.w;
+        float3 normal = cross(der0, der1);
+        float len = length(normal);
+        if (len > 0.0f)
+        {
+            normal /= len;
+        }
+
+        int v = i0 + numSamples0 * i1;
+        Vertex vertex;
+        vertex.position = float4(position, 1.0f);
+        vertex.normal = float4(normal, 0.0f);
+        grid[v] = vertex;
+    }
+)",
+
+// TRIANGULATE
+R"(
+    StructuredBuffer<uint> info;
+    StructuredBuffer<Vertex> grid;
+    RWStructuredBuffer<Vertex> vertices;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, 1)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int i0 = int(dt.x);
+        int i1 = int(dt.y);
+        int numSamples0 = int(info[0]);
+        int numSamples1 = int(info[1]);
+        if (i0 + 1 >= numSamples0 || i1 + 1 >= numSamples1)
+        {
+            return;
+        }
+
+        int v00 = i0 + numSamples0 * i1;
+        int v10 = v00 + 1;
+        int v01 = v00 + numSamples0;
+        int v11 = v01 + 1;
+        int v = 6 * (i0 + (numSamples0 - 1) * i1);
+        vertices[v] = grid[v00];
+        vertices[v + 1] = grid[v10];
+        vertices[v + 2] = grid[v11];
+        vertices[v + 3] = grid[v00];
+        vertices[v + 4] = grid[v11];
+        vertices[v + 5] = grid[v01];
+    }
+)"
+};
@@ -0,0 +1,313 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/BSplineSurface.h>
+#include <Mathematics/NURBSSurface.h>
+#include <Mathematics/Matrix4x4.h>
+#include <Mathematics/Vector3.h>
+#include <Mathematics/Vector4.h>
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/IndexBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+#include <Graphics/VertexBuffer.h>
+
+// A GPU-based tessellation of a B-spline or NURBS surface in 3D using
+// DX11/HLSL or GL45/GLSL. The control points (in homogeneous form) and the
+// knots are stored in structured buffers and the tessellation is a sequence
+// of compute shaders.
+//   1. For each knot-span rectangle, project the controls that influence
+//      it to window coordinates and estimate the number of segments per
+//      span direction for which the distance between the surface and its
+//      piecewise-linear approximation is at most a pixel tolerance. The
+//      estimate uses the bound (1/8)*max|X''|/n^2 for linear interpolation
+//      at n+1 uniform samples, where max|X''| is bounded by d*(d-1) times
+//      the maximum length of the second differences of the projected
+//      controls of degree d. The estimate is exact for Bezier patches of
+//      polynomial surfaces and a good heuristic for B-spline and rational
+//      surfaces.
+//   2. Each u-span uses the maximum number of segments of its column of
+//      span rectangles and each v-span uses the maximum of its row. The
+//      counts are halved until their totals fit in the maximum number of
+//      segments, and the u- and v-samples are generated.
+//   3. Evaluate the position and unit-length normal at each sample of the
+//      tensor-product grid.
+//   4. Store two triangles for each grid cell as consecutive triples of
+//      vertices in a structured buffer.
+// The grid is a tensor-product of the u- and v-samples, so the adaptive
+// tessellation has no cracks. The vertex buffer reads its vertices from the
+// structured buffer, so the surface is drawn with an effect whose vertex
+// shader reads the vertices by identifier (SV_VertexID or gl_VertexID),
+// without a copy from GPU to CPU. The only data read back is the pair of
+// sample counts, which is used to set the number of active vertices and
+// primitives.
+//
+// Interactive editing modifies the controls by SetControl(...) followed by
+// engine->Update(GetControls()), which is the only CPU-to-GPU copy. The
+// knots are fixed at construction.
+
+namespace gte
+{
+    class GPUSplineSurfaceTessellator
+    {
+    public:
+        // The layout of a tessellation vertex. The w-component of the
+        // position is 1 and the w-component of the normal is 0. The normal
+        // is Xu cross Xv normalized, where Xu and Xv are the first-order
+        // partial derivatives; it is the zero vector at samples where the
+        // derivatives are parallel.
+        struct Vertex
+        {
+            Vector4<float> position;
+            Vector4<float> normal;
+        };
+
+        // Construction. The tessellation has at most maxSegments0 segments
+        // in the u-direction and at most maxSegments1 segments in the
+        // v-direction. These must be at least the number of knot spans of
+        // the corresponding dimension, because each span has at least one
+        // segment. A span has at most maxSpanSegments segments. The kernels
+        // are dispatched in 2D thread groups of numThreads^2 threads.
+        template <typename Real>
+        GPUSplineSurfaceTessellator(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            NURBSSurface<3, Real> const& surface, unsigned int maxSegments0,
+            unsigned int maxSegments1, unsigned int maxSpanSegments = 64,
+            int numThreads = 8)
+        {
+            std::array<BasisFunction<Real> const*, 2> basis =
+            {
+                &surface.GetBasisFunction(0),
+                &surface.GetBasisFunction(1)
+            };
+            std::array<int, 2> numControls =
+            {
+                surface.GetNumControls(0),
+                surface.GetNumControls(1)
+            };
+            Initialize(engine, factory, basis, numControls, maxSegments0,
+                maxSegments1, maxSpanSegments, numThreads);
+
+            Vector3<float> control;
+            for (int i1 = 0; i1 < numControls[1]; ++i1)
+            {
+                for (int i0 = 0; i0 < numControls[0]; ++i0)
+                {
+                    Vector<3, Real> const& P = surface.GetControl(i0, i1);
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        control[j] = static_cast<float>(P[j]);
+                    }
+                    SetControl(i0, i1, control, static_cast<float>(surface.GetWeight(i0, i1)));
+                }
+            }
+        }
+
+        template <typename Real>
+        GPUSplineSurfaceTessellator(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            BSplineSurface<3, Real> const& surface, unsigned int maxSegments0,
+            unsigned int maxSegments1, unsigned int maxSpanSegments = 64,
+            int numThreads = 8)
+        {
+            std::array<BasisFunction<Real> const*, 2> basis =
+            {
+                &surface.GetBasisFunction(0),
+                &surface.GetBasisFunction(1)
+            };
+            std::array<int, 2> numControls =
+            {
+                surface.GetNumControls(0),
+                surface.GetNumControls(1)
+            };
+            Initialize(engine, factory, basis, numControls, maxSegments0,
+                maxSegments1, maxSpanSegments, numThreads);
+
+            Vector3<float> control;
+            for (int i1 = 0; i1 < numControls[1]; ++i1)
+            {
+                for (int i0 = 0; i0 < numControls[0]; ++i0)
+                {
+                    Vector<3, Real> const& P = surface.GetControl(i0, i1);
+                    for (int j = 0; j < 3; ++j)
+                    {
+                        control[j] = static_cast<float>(P[j]);
+                    }
+                    SetControl(i0, i1, control, 1.0f);
+                }
+            }
+        }
+
+        virtual ~GPUSplineSurfaceTessellator() = default;
+
+        // The controls in homogeneous form (w*P,w), where P is the control
+        // point and w > 0 is the weight, stored as controls[i0 +
+        // numControls0*i1]. The weights are 1 for a B-spline surface.
+        // SetControl(...) modifies the CPU copy; after modifying controls,
+        // call engine->Update(GetControls()) to copy them to the GPU.
+        void SetControl(int i0, int i1, Vector3<float> const& control, float weight = 1.0f);
+
+        inline std::shared_ptr<StructuredBuffer> const& GetControls() const
+        {
+            return mControls;
+        }
+
+        // Tessellate the surface for drawing with the specified
+        // projection-view-world matrix in a viewport of the specified size.
+        // The pixel tolerance must be positive. The return value is the
+        // number of triangles of the tessellation. When a span rectangle
+        // has a control that is not in front of the eye, its spans use the
+        // maximum number of segments.
+        unsigned int Execute(Matrix4x4<float> const& pvwMatrix, float viewportWidth,
+            float viewportHeight, float pixelTolerance);
+
+        inline unsigned int GetNumTriangles() const
+        {
+            return mNumTriangles;
+        }
+
+        // The numbers of u- and v-samples of the last tessellation. The
+        // grid (i0,i1) has numSamples0*numSamples1 vertices and the cell
+        // (i0,i1) for 0 <= i0 < numSamples0-1 and 0 <= i1 < numSamples1-1
+        // has triangles 2*q and 2*q+1, where q = i0 + (numSamples0-1)*i1.
+        inline unsigned int GetNumSamples(int dim) const
+        {
+            return mNumSamples[dim];
+        }
+
+        // The structured buffer has 6*maxSegments0*maxSegments1 elements
+        // of type Vertex. Triangle t has vertices 3*t, 3*t+1 and 3*t+2,
+        // which are counterclockwise in the (u,v) parameter plane.
+        inline std::shared_ptr<StructuredBuffer> const& GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // The vertex buffer for vertex-identifier-based drawing of the
+        // vertices and the index buffer for the triangles, which have
+        // 3*GetNumTriangles() active vertices and GetNumTriangles() active
+        // primitives. The shader resource of the vertex shader must be set
+        // to GetVertices().
+        inline std::shared_ptr<VertexBuffer> const& GetVertexBuffer() const
+        {
+            return mVertexBuffer;
+        }
+
+        inline std::shared_ptr<IndexBuffer> const& GetIndexBuffer() const
+        {
+            return mIndexBuffer;
+        }
+
+    private:
+        enum
+        {
+            ESTIMATE,
+            SCAN,
+            EVALUATE,
+            TRIANGULATE,
+            NUM_KERNELS
+        };
+
+        // The layout of the constant buffer "Parameters".
+        struct Parameters
+        {
+            Matrix4x4<float> pvwMatrix;
+            float viewportWidth;
+            float viewportHeight;
+            float pixelTolerance;
+            float padding;
+            int32_t numControls0;
+            int32_t numControls1;
+            int32_t numSpans0;
+            int32_t numSpans1;
+            int32_t maxSegments0;
+            int32_t maxSegments1;
+            int32_t maxSpanSegments;
+            int32_t knotOffset1;
+        };
+
+        // The knots and the spans of the basis functions of a dimension.
+        // The span (tmin,tmax,s,0) is the interval [tmin,tmax] =
+        // [knot[s],knot[s+1]] of positive length.
+        struct Dimension
+        {
+            int degree;
+            std::vector<float> knots;
+            std::vector<Vector4<float>> spans;
+        };
+
+        template <typename Real>
+        void Initialize(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            std::array<BasisFunction<Real> const*, 2> const& basis,
+            std::array<int, 2> const& numControls, unsigned int maxSegments0,
+            unsigned int maxSegments1, unsigned int maxSpanSegments, int numThreads)
+        {
+            std::array<Dimension, 2> dimension;
+            for (int dim = 0; dim < 2; ++dim)
+            {
+                Dimension& current = dimension[dim];
+                int const numKnots = basis[dim]->GetNumKnots();
+                Real const* knots = basis[dim]->GetKnots();
+                current.degree = basis[dim]->GetDegree();
+                current.knots.resize(numKnots);
+                for (int i = 0; i < numKnots; ++i)
+                {
+                    current.knots[i] = static_cast<float>(knots[i]);
+                }
+
+                for (int s = current.degree; s < basis[dim]->GetNumControls(); ++s)
+                {
+                    if (knots[s] < knots[s + 1])
+                    {
+                        current.spans.push_back({ current.knots[s],
+                            current.knots[s + 1], static_cast<float>(s), 0.0f });
+                    }
+                }
+            }
+
+            Initialize(engine, factory, dimension, numControls, maxSegments0,
+                maxSegments1, maxSpanSegments, numThreads);
+        }
+
+        void Initialize(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            std::array<Dimension, 2> const& dimension,
+            std::array<int, 2> const& numControls, unsigned int maxSegments0,
+            unsigned int maxSegments1, unsigned int maxSpanSegments, int numThreads);
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        std::array<std::shared_ptr<ComputeProgram>, NUM_KERNELS> mKernels;
+        std::array<unsigned int, 2> mNumSpanGroups;
+        std::array<unsigned int, 2> mNumSampleGroups;
+        std::array<unsigned int, 2> mNumSegmentGroups;
+        std::array<int, 2> mNumControls;
+        std::shared_ptr<ConstantBuffer> mParameters;
+        std::shared_ptr<StructuredBuffer> mControls;
+        std::shared_ptr<StructuredBuffer> mKnots;
+        std::shared_ptr<StructuredBuffer> mSpans;
+        std::shared_ptr<StructuredBuffer> mSegments;
+        std::shared_ptr<StructuredBuffer> mSamples;
+        std::shared_ptr<StructuredBuffer> mInfo;
+        std::shared_ptr<StructuredBuffer> mGrid;
+        std::shared_ptr<StructuredBuffer> mVertices;
+        std::shared_ptr<VertexBuffer> mVertexBuffer;
+        std::shared_ptr<IndexBuffer> mIndexBuffer;
+        std::array<unsigned int, 2> mNumSamples;
+        unsigned int mNumTriangles;
+
+        // Shader source code as strings. The source of each kernel is the
+        // common source followed by the kernel source.
+        static std::string const msGLSLCommonSource;
+        static std::string const msHLSLCommonSource;
+        static std::array<std::string, NUM_KERNELS> const msGLSLKernelSource;
+        static std::array<std::string, NUM_KERNELS> const msHLSLKernelSource;
+    };
+}
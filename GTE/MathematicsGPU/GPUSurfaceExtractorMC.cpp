@@ -0,0 +1,615 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <MathematicsGPU/GTMathematicsGPUPCH.h>
+#include <MathematicsGPU/GPUSurfaceExtractorMC.h>
+#include <Mathematics/Vector4.h>
+#include <cstring>
+using namespace gte;
+
+GPUSurfaceExtractorMC::GPUSurfaceExtractorMC(std::shared_ptr<GraphicsEngine> const& engine,
+    std::shared_ptr<ProgramFactory> const& factory, int xBound, int yBound, int zBound,
+    unsigned int maxTriangles, int numThreads)
+    :
+    mEngine(engine),
+    mNumTriangles(0)
+{
+    LogAssert(engine != nullptr && factory != nullptr && xBound >= 2 && yBound >= 2
+        && zBound >= 2 && maxTriangles > 0 && numThreads > 0, "Invalid argument.");
+
+    mParameters = std::make_shared<ConstantBuffer>(sizeof(Parameters), true);
+    auto parameters = mParameters->Get<Parameters>();
+    parameters->xBound = xBound;
+    parameters->yBound = yBound;
+    parameters->zBound = zBound;
+    parameters->maxTriangles = static_cast<int32_t>(maxTriangles);
+    parameters->level = 0.0f;
+    parameters->padding[0] = 0;
+    parameters->padding[1] = 0;
+    parameters->padding[2] = 0;
+
+    mLookup = std::make_shared<StructuredBuffer>(256 * 41, sizeof(int32_t));
+    std::memcpy(mLookup->GetData(), GetTable(), mLookup->GetNumBytes());
+
+    unsigned int const numPixels = static_cast<unsigned int>(xBound) *
+        static_cast<unsigned int>(yBound) * static_cast<unsigned int>(zBound);
+    mImage = std::make_shared<StructuredBuffer>(numPixels, sizeof(float));
+    mImage->SetUsage(Resource::DYNAMIC_UPDATE);
+    std::memset(mImage->GetData(), 0, mImage->GetNumBytes());
+
+    std::array<unsigned int, 3> const numVoxels =
+    {
+        static_cast<unsigned int>(xBound - 1),
+        static_cast<unsigned int>(yBound - 1),
+        static_cast<unsigned int>(zBound - 1)
+    };
+    unsigned int const threads = static_cast<unsigned int>(numThreads);
+    for (int j = 0; j < 3; ++j)
+    {
+        mNumGroups[j] = (numVoxels[j] + threads - 1) / threads;
+    }
+
+    mEntries = std::make_shared<StructuredBuffer>(numVoxels[0] * numVoxels[1] * numVoxels[2],
+        sizeof(uint32_t));
+    mEntries->SetUsage(Resource::SHADER_OUTPUT);
+
+    // The D3D11 limit on the number of thread groups per dimension is
+    // 65535, so the scans of large levels use rows of thread groups.
+    unsigned int numElements = mEntries->GetNumElements();
+    for (;;)
+    {
+        Level level;
+        level.values = std::make_shared<StructuredBuffer>(numElements, sizeof(uint32_t));
+        level.values->SetUsage(Resource::SHADER_OUTPUT);
+        unsigned int const numGroups = (numElements + GROUP_SIZE - 1) / GROUP_SIZE;
+        level.numXGroups = std::min(numGroups, 4096u);
+        level.numYGroups = (numGroups + level.numXGroups - 1) / level.numXGroups;
+        level.scan = std::make_shared<ConstantBuffer>(sizeof(Scan), false);
+        auto scan = level.scan->Get<Scan>();
+        scan->numElements = static_cast<int32_t>(numElements);
+        scan->numXGroups = static_cast<int32_t>(level.numXGroups);
+        scan->padding[0] = 0;
+        scan->padding[1] = 0;
+        mLevels.push_back(level);
+
+        if (mLevels.size() > 1 && numElements == 1)
+        {
+            break;
+        }
+        numElements = numGroups;
+    }
+    mLevels.back().values->SetCopyType(Resource::COPY_STAGING_TO_CPU);
+
+    mVertices = std::make_shared<StructuredBuffer>(3 * maxTriangles, sizeof(Vector4<float>));
+    mVertices->SetUsage(Resource::SHADER_OUTPUT);
+
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32B32A32_FLOAT, 0);
+    mVertexBuffer = std::make_shared<VertexBuffer>(vformat, mVertices);
+    mIndexBuffer = std::make_shared<IndexBuffer>(IP_TRIMESH, maxTriangles);
+    mIndexBuffer->SetNumActivePrimitives(0);
+
+    int api = factory->GetAPI();
+    factory->PushDefines();
+    factory->defines.Set("NUM_X_THREADS", numThreads);
+    factory->defines.Set("NUM_Y_THREADS", numThreads);
+    factory->defines.Set("NUM_Z_THREADS", numThreads);
+    factory->defines.Set("GROUP_SIZE", static_cast<int>(GROUP_SIZE));
+    for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+    {
+        std::string source;
+        if (kernel == CLASSIFY || kernel == GENERATE)
+        {
+            source = (api == ProgramFactory::PF_GLSL ? msGLSLImageSource : msHLSLImageSource);
+        }
+        source += (api == ProgramFactory::PF_GLSL ? msGLSLKernelSource[kernel] :
+            msHLSLKernelSource[kernel]);
+
+        mKernels[kernel] = factory->CreateFromSource(source);
+        LogAssert(mKernels[kernel] != nullptr, "Failed to compile shader.");
+    }
+    factory->PopDefines();
+
+    auto cshader = mKernels[CLASSIFY]->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("lookup", mLookup);
+    cshader->Set("image", mImage);
+    cshader->Set("entries", mEntries);
+    cshader->Set("counts", mLevels[0].values);
+
+    cshader = mKernels[GENERATE]->GetComputeShader();
+    cshader->Set("Parameters", mParameters);
+    cshader->Set("lookup", mLookup);
+    cshader->Set("image", mImage);
+    cshader->Set("entries", mEntries);
+    cshader->Set("offsets", mLevels[0].values);
+    cshader->Set("vertices", mVertices);
+}
+
+unsigned int GPUSurfaceExtractorMC::Execute(float level)
+{
+    mParameters->Get<Parameters>()->level = level;
+    mEngine->Update(mParameters);
+    mEngine->Execute(mKernels[CLASSIFY], mNumGroups[0], mNumGroups[1], mNumGroups[2]);
+
+    // Scan the levels upward, each level storing its group totals in the
+    // next level, and then add the scanned totals downward.
+    auto cshader = mKernels[SCAN]->GetComputeShader();
+    for (size_t k = 0; k + 1 < mLevels.size(); ++k)
+    {
+        cshader->Set("Scan", mLevels[k].scan);
+        cshader->Set("values", mLevels[k].values);
+        cshader->Set("sums", mLevels[k + 1].values);
+        mEngine->Execute(mKernels[SCAN], mLevels[k].numXGroups, mLevels[k].numYGroups, 1);
+    }
+
+    cshader = mKernels[ADD_OFFSETS]->GetComputeShader();
+    for (size_t k = mLevels.size() - 2; k-- > 0; )
+    {
+        cshader->Set("Scan", mLevels[k].scan);
+        cshader->Set("values", mLevels[k].values);
+        cshader->Set("sums", mLevels[k + 1].values);
+        mEngine->Execute(mKernels[ADD_OFFSETS], mLevels[k].numXGroups, mLevels[k].numYGroups, 1);
+    }
+
+    mEngine->Execute(mKernels[GENERATE], mNumGroups[0], mNumGroups[1], mNumGroups[2]);
+
+    auto const& total = mLevels.back().values;
+    mEngine->CopyGpuToCpu(total);
+    unsigned int const numTriangles = total->Get<uint32_t>()[0];
+    mNumTriangles = std::min(numTriangles, mIndexBuffer->GetNumPrimitives());
+    mIndexBuffer->SetNumActivePrimitives(mNumTriangles);
+    return numTriangles;
+}
+
+
+std::string const GPUSurfaceExtractorMC::msGLSLImageSource =
+R"(
+    uniform Parameters
+    {
+        int xBound;
+        int yBound;
+        int zBound;
+        int maxTriangles;
+        float level;
+        int padding0, padding1, padding2;
+    };
+
+    // The Marching Cubes table of MarchingCubes::GetTable(), 41 integers
+    // per entry.
+    buffer lookup { int data[]; } lookupSB;
+
+    // The image in lexicographical order.
+    buffer image { float data[]; } imageSB;
+
+    int GetVoxel(int x, int y, int z)
+    {
+        return x + (xBound - 1) * (y + (yBound - 1) * z);
+    }
+
+    // F[k] is the value at corner (x + (k & 1), y + ((k & 2) >> 1),
+    // z + ((k & 4) >> 2)) minus the level.
+    void GetValues(int x, int y, int z, out float F[8])
+    {
+        int i000 = x + xBound * (y + yBound * z);
+        int i010 = i000 + xBound;
+        int i001 = i000 + xBound * yBound;
+        int i011 = i001 + xBound;
+        F[0] = imageSB.data[i000] - level;
+        F[1] = imageSB.data[i000 + 1] - level;
+        F[2] = imageSB.data[i010] - level;
+        F[3] = imageSB.data[i010 + 1] - level;
+        F[4] = imageSB.data[i001] - level;
+        F[5] = imageSB.data[i001 + 1] - level;
+        F[6] = imageSB.data[i011] - level;
+        F[7] = imageSB.data[i011 + 1] - level;
+    }
+
+    layout (local_size_x = NUM_X_THREADS, local_size_y = NUM_Y_THREADS, local_size_z = NUM_Z_THREADS) in;
+)";
+
+std::array<std::string, GPUSurfaceExtractorMC::NUM_KERNELS> const GPUSurfaceExtractorMC::msGLSLKernelSource =
+{
+// CLASSIFY
+R"(
+    buffer entries { uint data[]; } entriesSB;
+    buffer counts { uint data[]; } countsSB;
+
+    void main()
+    {
+        int x = int(gl_GlobalInvocationID.x);
+        int y = int(gl_GlobalInvocationID.y);
+        int z = int(gl_GlobalInvocationID.z);
+        if (x + 1 >= xBound || y + 1 >= yBound || z + 1 >= zBound)
+        {
+            return;
+        }
+
+        float F[8];
+        GetValues(x, y, z, F);
+        uint entry = 0u;
+        for (int k = 0; k < 8; ++k)
+        {
+            if (F[k] < 0.0f)
+            {
+                entry |= (1u << uint(k));
+            }
+        }
+
+        int voxel = GetVoxel(x, y, z);
+        entriesSB.data[voxel] = entry;
+        countsSB.data[voxel] = uint(lookupSB.data[41 * int(entry) + 1]);
+    }
+)",
+
+// SCAN
+R"(
+    uniform Scan
+    {
+        int numElements;
+        int numXGroups;
+        int padding0, padding1;
+    };
+
+    buffer values { uint data[]; } valuesSB;
+    buffer sums { uint data[]; } sumsSB;
+
+    shared uint partial[GROUP_SIZE];
+
+    // Replace the values of the group by their exclusive prefix sums and
+    // store the total of the group.
+    layout (local_size_x = GROUP_SIZE, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int t = int(gl_LocalInvocationID.x);
+        int group = int(gl_WorkGroupID.x) + numXGroups * int(gl_WorkGroupID.y);
+        int i = GROUP_SIZE * group + t;
+        uint value = 0u;
+        if (i < numElements)
+        {
+            value = valuesSB.data[i];
+        }
+        partial[t] = value;
+        memoryBarrierShared();
+        barrier();
+
+        for (int d = 1; d < GROUP_SIZE; d *= 2)
+        {
+            uint addend = 0u;
+            if (t >= d)
+            {
+                addend = partial[t - d];
+            }
+            memoryBarrierShared();
+            barrier();
+            partial[t] += addend;
+            memoryBarrierShared();
+            barrier();
+        }
+
+        if (i < numElements)
+        {
+            valuesSB.data[i] = partial[t] - value;
+        }
+        if (t == GROUP_SIZE - 1 && GROUP_SIZE * group < numElements)
+        {
+            sumsSB.data[group] = partial[t];
+        }
+    }
+)",
+
+// ADD_OFFSETS
+R"(
+    uniform Scan
+    {
+        int numElements;
+        int numXGroups;
+        int padding0, padding1;
+    };
+
+    buffer values { uint data[]; } valuesSB;
+    buffer sums { uint data[]; } sumsSB;
+
+    layout (local_size_x = GROUP_SIZE, local_size_y = 1, local_size_z = 1) in;
+    void main()
+    {
+        int group = int(gl_WorkGroupID.x) + numXGroups * int(gl_WorkGroupID.y);
+        int i = GROUP_SIZE * group + int(gl_LocalInvocationID.x);
+        if (i < numElements)
+        {
+            valuesSB.data[i] += sumsSB.data[group];
+        }
+    }
+)",
+
+// GENERATE
+R"(
+    buffer entries { uint data[]; } entriesSB;
+    buffer offsets { uint data[]; } offsetsSB;
+    buffer vertices { vec4 data[]; } verticesSB;
+
+    const vec3 corner[8] =
+    {
+        vec3(0.0f, 0.0f, 0.0f),
+        vec3(1.0f, 0.0f, 0.0f),
+        vec3(0.0f, 1.0f, 0.0f),
+        vec3(1.0f, 1.0f, 0.0f),
+        vec3(0.0f, 0.0f, 1.0f),
+        vec3(1.0f, 0.0f, 1.0f),
+        vec3(0.0f, 1.0f, 1.0f),
+        vec3(1.0f, 1.0f, 1.0f)
+    };
+
+    void main()
+    {
+        int x = int(gl_GlobalInvocationID.x);
+        int y = int(gl_GlobalInvocationID.y);
+        int z = int(gl_GlobalInvocationID.z);
+        if (x + 1 >= xBound || y + 1 >= yBound || z + 1 >= zBound)
+        {
+            return;
+        }
+
+        int voxel = GetVoxel(x, y, z);
+        int j = 41 * int(entriesSB.data[voxel]);
+        int numVertices = lookupSB.data[j];
+        int numTriangles = lookupSB.data[j + 1];
+        if (numTriangles == 0)
+        {
+            return;
+        }
+
+        float F[8];
+        GetValues(x, y, z, F);
+        vec3 origin = vec3(float(x), float(y), float(z));
+        vec3 position[12];
+        for (int i = 0; i < numVertices; ++i)
+        {
+            int j0 = lookupSB.data[j + 2 + 2 * i];
+            int j1 = lookupSB.data[j + 3 + 2 * i];
+            position[i] = origin + (F[j0] * corner[j1] - F[j1] * corner[j0]) / (F[j0] - F[j1]);
+        }
+
+        // The triangle indices start after the 12 pairs of corners.
+        int first = int(offsetsSB.data[voxel]);
+        for (int t = 0; t < numTriangles && first + t < maxTriangles; ++t)
+        {
+            int v = 3 * (first + t);
+            for (int k = 0; k < 3; ++k)
+            {
+                verticesSB.data[v + k] = vec4(position[lookupSB.data[j + 26 + 3 * t + k]], 1.0f);
+            }
+        }
+    }
+)"
+};
+
+std::string const GPUSurfaceExtractorMC::msHLSLImageSource =
+R"(
+    cbuffer Parameters
+    {
+        int xBound;
+        int yBound;
+        int zBound;
+        int maxTriangles;
+        float level;
+        int padding0, padding1, padding2;
+    };
+
+    // The Marching Cubes table of MarchingCubes::GetTable(), 41 integers
+    // per entry.
+    StructuredBuffer<int> lookup;
+
+    // The image in lexicographical order.
+    StructuredBuffer<float> image;
+
+    int GetVoxel(int x, int y, int z)
+    {
+        return x + (xBound - 1) * (y + (yBound - 1) * z);
+    }
+
+    // F[k] is the value at corner (x + (k & 1), y + ((k & 2) >> 1),
+    // z + ((k & 4) >> 2)) minus the level.
+    void GetValues(int x, int y, int z, out float F[8])
+    {
+        int i000 = x + xBound * (y + yBound * z);
+        int i010 = i000 + xBound;
+        int i001 = i000 + xBound * yBound;
+        int i011 = i001 + xBound;
+        F[0] = image[i000] - level;
+        F[1] = image[i000 + 1] - level;
+        F[2] = image[i010] - level;
+        F[3] = image[i010 + 1] - level;
+        F[4] = image[i001] - level;
+        F[5] = image[i001 + 1] - level;
+        F[6] = image[i011] - level;
+        F[7] = image[i011 + 1] - level;
+    }
+)";
+
+std::array<std::string, GPUSurfaceExtractorMC::NUM_KERNELS> const GPUSurfaceExtractorMC::msHLSLKernelSource =
+{
+// CLASSIFY
+R"(
+    RWStructuredBuffer<uint> entries;
+    RWStructuredBuffer<uint> counts;
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int x = int(dt.x);
+        int y = int(dt.y);
+        int z = int(dt.z);
+        if (x + 1 >= xBound || y + 1 >= yBound || z + 1 >= zBound)
+        {
+            return;
+        }
+
+        float F[8];
+        GetValues(x, y, z, F);
+        uint entry = 0;
+        [unroll]
+        for (int k = 0; k < 8; ++k)
+        {
+            if (F[k] < 0.0f)
+            {
+                entry |= (1u << uint(k));
+            }
+        }
+
+        int voxel = GetVoxel(x, y, z);
+        entries[voxel] = entry;
+        counts[voxel] = uint(lookup[41 * int(entry) + 1]);
+    }
+)",
+
+// SCAN
+R"(
+    cbuffer Scan
+    {
+        int numElements;
+        int numXGroups;
+        int padding0, padding1;
+    };
+
+    RWStructuredBuffer<uint> values;
+    RWStructuredBuffer<uint> sums;
+
+    groupshared uint partial[GROUP_SIZE];
+
+    // Replace the values of the group by their exclusive prefix sums and
+    // store the total of the group.
+    [numthreads(GROUP_SIZE, 1, 1)]
+    void CSMain(uint3 gID : SV_GroupID, uint3 gtID : SV_GroupThreadID)
+    {
+        int t = int(gtID.x);
+        int group = int(gID.x) + numXGroups * int(gID.y);
+        int i = GROUP_SIZE * group + t;
+        uint value = 0;
+        if (i < numElements)
+        {
+            value = values[i];
+        }
+        partial[t] = value;
+        GroupMemoryBarrierWithGroupSync();
+
+        [unroll]
+        for (int d = 1; d < GROUP_SIZE; d *= 2)
+        {
+            uint addend = 0;
+            if (t >= d)
+            {
+                addend = partial[t - d];
+            }
+            GroupMemoryBarrierWithGroupSync();
+            partial[t] += addend;
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        if (i < numElements)
+        {
+            values[i] = partial[t] - value;
+        }
+        if (t == GROUP_SIZE - 1 && GROUP_SIZE * group < numElements)
+        {
+            sums[group] = partial[t];
+        }
+    }
+)",
+
+// ADD_OFFSETS
+R"(
+    cbuffer Scan
+    {
+        int numElements;
+        int numXGroups;
+        int padding0, padding1;
+    };
+
+    RWStructuredBuffer<uint> values;
+    StructuredBuffer<uint> sums;
+
+    [numthreads(GROUP_SIZE, 1, 1)]
+    void CSMain(uint3 gID : SV_GroupID, uint3 gtID : SV_GroupThreadID)
+    {
+        int group = int(gID.x) + numXGroups * int(gID.y);
+        int i = GROUP_SIZE * group + int(gtID.x);
+        if (i < numElements)
+        {
+            values[i] += sums[group];
+        }
+    }
+)",
+
+// GENERATE
+R"(
+    StructuredBuffer<uint> entries;
+    StructuredBuffer<uint> offsets;
+    RWStructuredBuffer<float4> vertices;
+
+    static const float3 corner[8] =
+    {
+        float3(0.0f, 0.0f, 0.0f),
+        float3(1.0f, 0.0f, 0.0f),
+        float3(0.0f, 1.0f, 0.0f),
+        float3(1.0f, 1.0f, 0.0f),
+        float3(0.0f, 0.0f, 1.0f),
+        float3(1.0f, 0.0f, 1.0f),
+        float3(0.0f, 1.0f, 1.0f),
+        float3(1.0f, 1.0f, 1.0f)
+    };
+
+    [numthreads(NUM_X_THREADS, NUM_Y_THREADS, NUM_Z_THREADS)]
+    void CSMain(uint3 dt : SV_DispatchThreadID)
+    {
+        int x = int(dt.x);
+        int y = int(dt.y);
+        int z = int(dt.z);
+        if (x + 1 >= xBound || y + 1 >= yBound || z + 1 >= zBound)
+        {
+            return;
+        }
+
+        int voxel = GetVoxel(x, y, z);
+        int j = 41 * int(entries[voxel]);
+        int numVertices = lookup[j];
+        int numTriangles = lookup[j + 1];
+        if (numTriangles == 0)
+        {
+            return;
+        }
+
+        float F[8];
+        GetValues(x, y, z, F);
+        float3 origin = float3(float(x), float(y), float(z));
+        float3 position[12] =
+        {
+            float3(0,0,0), float3(0,0,0), float3(0,0,0), float3(0,0,0),
+            float3(0,0,0), float3(0,0,0), float3(0,0,0), float3(0,0,0),
+            float3(0,0,0), float3(0,0,0), float3(0,0,0), float3(0,0,0)
+        };
+        for (int i = 0; i < numVertices; ++i)
+        {
+            int j0 = lookup[j + 2 + 2 * i];
+            int j1 = lookup[j + 3 + 2 * i];
+            position[i] = origin + (F[j0] * corner[j1] - F[j1] * corner[j0]) / (F[j0] - F[j1]);
+        }
+
+        // The triangle indices start after the 12 pairs of corners.
+        int first = int(offsets[voxel]);
+        for (int t = 0; t < numTriangles && first + t < maxTriangles; ++t)
+        {
+            int v = 3 * (first + t);
+            [unroll]
+            for (int k = 0; k < 3; ++k)
+            {
+                vertices[v + k] = float4(position[lookup[j + 26 + 3 * t + k]], 1.0f);
+            }
+        }
+    }
+)"
+};
@@ -0,0 +1,164 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#pragma once
+
+#include <Mathematics/MarchingCubes.h>
+#include <Graphics/GraphicsEngine.h>
+#include <Graphics/ProgramFactory.h>
+#include <Graphics/ConstantBuffer.h>
+#include <Graphics/IndexBuffer.h>
+#include <Graphics/StructuredBuffer.h>
+#include <Graphics/VertexBuffer.h>
+
+// A GPU-based implementation of the level-surface extraction of
+// Mathematics/SurfaceExtractorMC.h using DX11/HLSL or GL45/GLSL. The image
+// is stored in a structured buffer and the extraction is a sequence of
+// compute shaders.
+//   1. Classify each voxel by its Marching Cubes table entry and store the
+//      number of triangles of the entry.
+//   2. Compute the exclusive prefix sums of the triangle counts. The sums
+//      are computed hierarchically in thread groups of GROUP_SIZE elements,
+//      where the totals of the groups of one level are the elements of the
+//      next level, followed by adding the offsets of the groups back down
+//      the levels. The top level has the total number of triangles.
+//   3. Store the triangles of each voxel, starting at its prefix sum, as
+//      consecutive triples of vertices in a structured buffer.
+// The vertex buffer reads its vertices from the structured buffer, so the
+// surface is drawn with an effect whose vertex shader reads the positions
+// by vertex identifier (SV_VertexID or gl_VertexID), without a copy from
+// GPU to CPU. The only data read back is the total number of triangles,
+// which is used to set the number of active primitives of the index
+// buffer. The vertices are in image coordinates, so voxel (x,y,z) is the
+// cube [x,x+1]x[y,y+1]x[z,z+1].
+//
+// Unlike SurfaceExtractorMC::Extract, an image value equal to the level
+// is not an error; such a value is treated as greater than the level. The
+// vertices are not shared by the triangles.
+
+namespace gte
+{
+    class GPUSurfaceExtractorMC : public MarchingCubes
+    {
+    public:
+        // Construction. The image has xBound-by-yBound-by-zBound values,
+        // each at least 2. At most maxTriangles triangles are stored. The
+        // classification and generation kernels are dispatched in 3D
+        // thread groups of numThreads^3 threads.
+        GPUSurfaceExtractorMC(std::shared_ptr<GraphicsEngine> const& engine,
+            std::shared_ptr<ProgramFactory> const& factory,
+            int xBound, int yBound, int zBound, unsigned int maxTriangles,
+            int numThreads = 4);
+
+        virtual ~GPUSurfaceExtractorMC() = default;
+
+        // The image values in lexicographical order; that is, image[i]
+        // corresponds to location (x,y,z) where i = x + xBound*(y +
+        // yBound*z). After modifying the values, call engine->Update(image)
+        // to copy them to the GPU.
+        inline std::shared_ptr<StructuredBuffer> const& GetImage() const
+        {
+            return mImage;
+        }
+
+        // Extract the triangles of the level surface. The return value is
+        // the number of triangles of the surface, which is larger than the
+        // number of stored triangles when it exceeds maxTriangles.
+        unsigned int Execute(float level);
+
+        inline unsigned int GetNumTriangles() const
+        {
+            return mNumTriangles;
+        }
+
+        // The structured buffer has 3*maxTriangles elements of type
+        // Vector4<float>. Triangle t has vertices 3*t, 3*t+1 and 3*t+2,
+        // each with w-component 1.
+        inline std::shared_ptr<StructuredBuffer> const& GetVertices() const
+        {
+            return mVertices;
+        }
+
+        // The vertex buffer for vertex-identifier-based drawing of the
+        // vertices and the index buffer for the triangles, which has
+        // GetNumTriangles() active primitives. The shader resource of the
+        // vertex shader must be set to GetVertices().
+        inline std::shared_ptr<VertexBuffer> const& GetVertexBuffer() const
+        {
+            return mVertexBuffer;
+        }
+
+        inline std::shared_ptr<IndexBuffer> const& GetIndexBuffer() const
+        {
+            return mIndexBuffer;
+        }
+
+    private:
+        enum
+        {
+            CLASSIFY,
+            SCAN,
+            ADD_OFFSETS,
+            GENERATE,
+            NUM_KERNELS
+        };
+
+        enum { GROUP_SIZE = 256 };
+
+        // The layout of the constant buffer "Parameters".
+        struct Parameters
+        {
+            int32_t xBound;
+            int32_t yBound;
+            int32_t zBound;
+            int32_t maxTriangles;
+            float level;
+            int32_t padding[3];
+        };
+
+        // The layout of the constant buffer "Scan", one per level.
+        struct Scan
+        {
+            int32_t numElements;
+            int32_t numXGroups;
+            int32_t padding[2];
+        };
+
+        struct Level
+        {
+            std::shared_ptr<StructuredBuffer> values;
+            std::shared_ptr<ConstantBuffer> scan;
+            unsigned int numXGroups, numYGroups;
+        };
+
+        std::shared_ptr<GraphicsEngine> mEngine;
+        std::array<std::shared_ptr<ComputeProgram>, NUM_KERNELS> mKernels;
+        std::array<unsigned int, 3> mNumGroups;
+        std::shared_ptr<ConstantBuffer> mParameters;
+        std::shared_ptr<StructuredBuffer> mLookup;
+        std::shared_ptr<StructuredBuffer> mImage;
+        std::shared_ptr<StructuredBuffer> mEntries;
+        std::shared_ptr<StructuredBuffer> mVertices;
+        std::shared_ptr<VertexBuffer> mVertexBuffer;
+        std::shared_ptr<IndexBuffer> mIndexBuffer;
+        unsigned int mNumTriangles;
+
+        // The level-0 values are the triangle counts of the voxels and the
+        // values of level k+1 are the totals of the groups of level k. The
+        // last level has the single value that is the total number of
+        // triangles.
+        std::vector<Level> mLevels;
+
+        // Shader source code as strings. The source of the classification
+        // and generation kernels is the image source followed by the kernel
+        // source.
+        static std::string const msGLSLImageSource;
+        static std::string const msHLSLImageSource;
+        static std::array<std::string, NUM_KERNELS> const msGLSLKernelSource;
+        static std::array<std::string, NUM_KERNELS> const msHLSLKernelSource;
+    };
+}
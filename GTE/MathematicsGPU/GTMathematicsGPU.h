@@ -8,7 +8,11 @@
 #pragma once
 
 // Mathematics/GPU/ComputationalGeometry
+#include <MathematicsGPU/GPUAllPairsTriangles.h>
+#include <MathematicsGPU/GPUFlipDelaunay2.h>
 #include <MathematicsGPU/GPUGenerateMeshUV.h>
+#include <MathematicsGPU/GPUSplineSurfaceTessellator.h>
+#include <MathematicsGPU/GPUSurfaceExtractorMC.h>
 
 // Mathematics/GPU/Physics/Fluids2
 #include <MathematicsGPU/GPUFluid2.h>
@@ -23,6 +27,7 @@
 
 // Mathematics/GPU/Physics/Fluids3
 #include <MathematicsGPU/GPUFluid3.h>
+#include <MathematicsGPU/GPUFluid3ActiveBricks.h>
 #include <MathematicsGPU/GPUFluid3AdjustVelocity.h>
 #include <MathematicsGPU/GPUFluid3ComputeDivergence.h>
 #include <MathematicsGPU/GPUFluid3EnforceStateBoundary.h>
@@ -31,3 +36,11 @@
 #include <MathematicsGPU/GPUFluid3Parameters.h>
 #include <MathematicsGPU/GPUFluid3SolvePoisson.h>
 #include <MathematicsGPU/GPUFluid3UpdateState.h>
+
+// Mathematics/GPU/Physics
+#include <MathematicsGPU/GPUMassSpring.h>
+
+// Mathematics/GPU/Imagics
+#include <MathematicsGPU/GPUPdeFilter.h>
+#include <MathematicsGPU/GPUPdeFilter2.h>
+#include <MathematicsGPU/GPUPdeFilter3.h>
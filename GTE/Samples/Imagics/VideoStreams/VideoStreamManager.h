@@ -3,11 +3,11 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// Version: 4.0.2019.08.13
+// Version: 4.0.2026.10.15
 
 #pragma once
 
-#include <Mathematics/ThreadSafeQueue.h>
+#include <Mathematics/LockFreeQueue.h>
 #include "VideoStream.h"
 #include <thread>
 
@@ -36,7 +36,7 @@ public:
     // all frames from the video streams.
     struct Frame
     {
-        Frame(size_t n)
+        Frame(size_t n = 0)
             :
             number(0xFFFFFFFF),
             frames(n),
@@ -108,8 +108,9 @@ protected:
     // The managed video streams.
     std::vector<std::shared_ptr<VideoStream>> mVideoStreams;
 
-    // The queue of frames to process.
-    mutable gte::ThreadSafeQueue<Frame> mFrameQueue;
+    // The queue of frames to process.  The capture thread pushes and the
+    // application thread pops, so the queue does not lock a mutex.
+    mutable gte::LockFreeQueue<Frame> mFrameQueue;
 
     // The timer is used to compute how long it takes to produce the frame.
     // The current frame counter is used for the Frame.number member.
@@ -0,0 +1,269 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Mathematics/ACosEstimate.h>
+#include <Mathematics/ASinEstimate.h>
+#include <Mathematics/ATanEstimate.h>
+#include <Mathematics/CosEstimate.h>
+#include <Mathematics/ExpEstimate.h>
+#include <Mathematics/InvSqrtEstimate.h>
+#include <Mathematics/LogEstimate.h>
+#include <Mathematics/SinEstimate.h>
+#include <Mathematics/SqrtEstimate.h>
+#include <Mathematics/TanEstimate.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+using namespace gte;
+
+// Throughput of the polynomial estimates compared to the functions of the
+// C++ standard library. For each function and floating-point type, the
+// following methods are timed over an array of inputs:
+//   std:    the standard library function, one element at a time
+//   scalar: the estimate Degree<D> or DegreeRR<D>, one element at a time
+//   array:  the estimate Degree<D> or DegreeRR<D> for arrays, which
+//           evaluates SIMD4Value<Real> registers
+// The inputs are uniformly distributed in the domain of the estimate, with
+// range reduction for the functions that support it. The results are
+// written as comma-separated values with a header line,
+//   function,type,method,degree,size,repetitions,min_ns,mean_ns,max_error
+// where min_ns and mean_ns are the minimum and the mean over the
+// repetitions of the time per element in nanoseconds and max_error is the
+// maximum absolute error relative to the standard library function (the
+// relative error for exp, sqrt and invsqrt). The SIMD registers are used
+// when GTE_USE_SIMD is defined, which the project files do; SIMD4<double>
+// additionally requires the compiler to target AVX.
+//
+// usage: EstimateBenchmark [-r repetitions] [-n size] [-f filter] [-o file]
+//   repetitions = number of timed repetitions of each benchmark (default 10)
+//   size        = number of elements of the arrays (default 65536)
+//   filter      = run only benchmarks whose function name contains filter
+//   file        = the output file (default is standard output)
+
+namespace
+{
+    struct Options
+    {
+        Options()
+            :
+            repetitions(10),
+            size(65536),
+            filter{},
+            output{}
+        {
+        }
+
+        int repetitions;
+        size_t size;
+        std::string filter;
+        std::string output;
+    };
+
+    class Benchmark
+    {
+    public:
+        Benchmark(Options const& options, std::ostream& output)
+            :
+            mOptions(options),
+            mOutput(output)
+        {
+            mOutput << "function,type,method,degree,size,repetitions,min_ns,mean_ns,max_error"
+                << std::endl;
+        }
+
+        // Time the three methods for inputs in [xmin,xmax]. The scalar and
+        // array estimates are the functions Estimate(x) and
+        // Estimate(numElements, x, result).
+        template <typename Real, typename StdFunction, typename ScalarEstimate,
+            typename ArrayEstimate>
+        void Run(std::string const& function, std::string const& type, int degree,
+            Real xmin, Real xmax, bool relativeError, StdFunction const& stdFunction,
+            ScalarEstimate const& scalarEstimate, ArrayEstimate const& arrayEstimate)
+        {
+            if (!mOptions.filter.empty() && function.find(mOptions.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            std::mt19937 mte(1234567u);
+            std::uniform_real_distribution<Real> urd(xmin, xmax);
+            std::vector<Real> x(mOptions.size), expected(mOptions.size), result(mOptions.size);
+            for (auto& value : x)
+            {
+                value = urd(mte);
+            }
+
+            size_t const n = mOptions.size;
+            Time(function, type, "std", 0,
+                [&]() { for (size_t i = 0; i < n; ++i) { expected[i] = stdFunction(x[i]); } },
+                expected, expected, relativeError);
+            Time(function, type, "scalar", degree,
+                [&]() { for (size_t i = 0; i < n; ++i) { result[i] = scalarEstimate(x[i]); } },
+                expected, result, relativeError);
+            Time(function, type, "array", degree,
+                [&]() { arrayEstimate(n, x.data(), result.data()); },
+                expected, result, relativeError);
+        }
+
+    private:
+        template <typename Real>
+        void Time(std::string const& function, std::string const& type, std::string const& method,
+            int degree, std::function<void()> const& evaluate, std::vector<Real> const& expected,
+            std::vector<Real> const& result, bool relativeError)
+        {
+            evaluate();
+            double minTime = std::numeric_limits<double>::max();
+            double sumTime = 0.0;
+            for (int r = 0; r < mOptions.repetitions; ++r)
+            {
+                auto start = std::chrono::steady_clock::now();
+                evaluate();
+                auto final = std::chrono::steady_clock::now();
+                double time = std::chrono::duration<double, std::nano>(final - start).count() /
+                    static_cast<double>(std::max(mOptions.size, static_cast<size_t>(1)));
+                minTime = std::min(minTime, time);
+                sumTime += time;
+            }
+
+            double maxError = 0.0;
+            for (size_t i = 0; i < mOptions.size; ++i)
+            {
+                double error = std::fabs(static_cast<double>(result[i]) - static_cast<double>(expected[i]));
+                if (relativeError && expected[i] != (Real)0)
+                {
+                    error /= std::fabs(static_cast<double>(expected[i]));
+                }
+                maxError = std::max(maxError, error);
+            }
+
+            mOutput << function << "," << type << "," << method << "," << degree << ","
+                << mOptions.size << "," << mOptions.repetitions << "," << minTime << ","
+                << sumTime / static_cast<double>(mOptions.repetitions) << "," << maxError
+                << std::endl;
+        }
+
+        Options mOptions;
+        std::ostream& mOutput;
+    };
+
+    // The macros expand to the scalar and array versions of an estimate.
+#define GTE_ESTIMATE(Estimate, Function, D) \
+    [](Real x) { return Estimate<Real>::template Function<D>(x); }, \
+    [](size_t n, Real const* x, Real* y) { Estimate<Real>::template Function<D>(n, x, y); }
+
+    template <typename Real>
+    void Estimates(Benchmark& benchmark, std::string const& type)
+    {
+        Real const pi = (Real)GTE_C_PI;
+        Real const halfPi = (Real)GTE_C_HALF_PI;
+
+        benchmark.Run<Real>("sin", type, 5, -halfPi, halfPi, false,
+            [](Real x) { return std::sin(x); }, GTE_ESTIMATE(SinEstimate, Degree, 5));
+        benchmark.Run<Real>("sin", type, 11, -halfPi, halfPi, false,
+            [](Real x) { return std::sin(x); }, GTE_ESTIMATE(SinEstimate, Degree, 11));
+        benchmark.Run<Real>("sinRR", type, 11, (Real)-100, (Real)100, false,
+            [](Real x) { return std::sin(x); }, GTE_ESTIMATE(SinEstimate, DegreeRR, 11));
+        benchmark.Run<Real>("cos", type, 10, -halfPi, halfPi, false,
+            [](Real x) { return std::cos(x); }, GTE_ESTIMATE(CosEstimate, Degree, 10));
+        benchmark.Run<Real>("cosRR", type, 10, (Real)-100, (Real)100, false,
+            [](Real x) { return std::cos(x); }, GTE_ESTIMATE(CosEstimate, DegreeRR, 10));
+        benchmark.Run<Real>("tan", type, 13, -pi / (Real)4, pi / (Real)4, false,
+            [](Real x) { return std::tan(x); }, GTE_ESTIMATE(TanEstimate, Degree, 13));
+        benchmark.Run<Real>("atan", type, 13, (Real)-1, (Real)1, false,
+            [](Real x) { return std::atan(x); }, GTE_ESTIMATE(ATanEstimate, Degree, 13));
+        benchmark.Run<Real>("atanRR", type, 13, (Real)-100, (Real)100, false,
+            [](Real x) { return std::atan(x); }, GTE_ESTIMATE(ATanEstimate, DegreeRR, 13));
+        benchmark.Run<Real>("asin", type, 8, (Real)0, (Real)1, false,
+            [](Real x) { return std::asin(x); }, GTE_ESTIMATE(ASinEstimate, Degree, 8));
+        benchmark.Run<Real>("acos", type, 8, (Real)0, (Real)1, false,
+            [](Real x) { return std::acos(x); }, GTE_ESTIMATE(ACosEstimate, Degree, 8));
+        benchmark.Run<Real>("exp2RR", type, 7, (Real)-60, (Real)60, true,
+            [](Real x) { return std::exp2(x); }, GTE_ESTIMATE(Exp2Estimate, DegreeRR, 7));
+        benchmark.Run<Real>("expRR", type, 7, (Real)-40, (Real)40, true,
+            [](Real x) { return std::exp(x); }, GTE_ESTIMATE(ExpEstimate, DegreeRR, 7));
+        benchmark.Run<Real>("log2RR", type, 8, (Real)1e-6, (Real)1e6, false,
+            [](Real x) { return std::log2(x); }, GTE_ESTIMATE(Log2Estimate, DegreeRR, 8));
+        benchmark.Run<Real>("logRR", type, 8, (Real)1e-6, (Real)1e6, false,
+            [](Real x) { return std::log(x); }, GTE_ESTIMATE(LogEstimate, DegreeRR, 8));
+        benchmark.Run<Real>("sqrtRR", type, 8, (Real)1e-6, (Real)1e6, true,
+            [](Real x) { return std::sqrt(x); }, GTE_ESTIMATE(SqrtEstimate, DegreeRR, 8));
+        benchmark.Run<Real>("invsqrtRR", type, 8, (Real)1e-6, (Real)1e6, true,
+            [](Real x) { return (Real)1 / std::sqrt(x); }, GTE_ESTIMATE(InvSqrtEstimate, DegreeRR, 8));
+    }
+
+#undef GTE_ESTIMATE
+
+    bool ParseOptions(int numArguments, char* arguments[], Options& options)
+    {
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string const argument = arguments[i];
+            if (i + 1 == numArguments)
+            {
+                return false;
+            }
+            std::string const value = arguments[++i];
+            if (argument == "-r")
+            {
+                options.repetitions = std::atoi(value.c_str());
+            }
+            else if (argument == "-n")
+            {
+                options.size = static_cast<size_t>(std::max(std::atoi(value.c_str()), 0));
+            }
+            else if (argument == "-f")
+            {
+                options.filter = value;
+            }
+            else if (argument == "-o")
+            {
+                options.output = value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return options.repetitions > 0 && options.size > 0;
+    }
+}
+
+int main(int numArguments, char* arguments[])
+{
+    Options options;
+    if (!ParseOptions(numArguments, arguments, options))
+    {
+        std::cerr << "usage: EstimateBenchmark [-r repetitions] [-n size] "
+            << "[-f filter] [-o file]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty())
+    {
+        file.open(options.output);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << options.output << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    Benchmark benchmark(options, output);
+    Estimates<float>(benchmark, "float");
+    Estimates<double>(benchmark, "double");
+    return 0;
+}
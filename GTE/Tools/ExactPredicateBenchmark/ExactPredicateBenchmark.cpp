@@ -0,0 +1,657 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.14
+
+#include <Mathematics/APInterval.h>
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/BSPrecisionPredicates.h>
+#include <Mathematics/ConvexHull3.h>
+#include <Mathematics/Delaunay2.h>
+#include <Mathematics/MinimumVolumeBox3.h>
+#include <Mathematics/PrimalQuery2.h>
+#include <Mathematics/PrimalQuery3.h>
+#include <Mathematics/PrimalQueryEvaluator3.h>
+#include <Mathematics/PrimalQueryFloat.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+using namespace gte;
+
+// Timings of the arithmetic stack used by the exact geometric algorithms:
+// the exact predicates of PrimalQuery2 and PrimalQuery3 and their variants
+// PrimalQueryEvaluator3, PrimalQuery2Float and PrimalQuery3Float, the
+// conversions between floating-point and arbitrary-precision numbers,
+// interval arithmetic and the algorithms ConvexHull3, Delaunay2 and
+// MinimumVolumeBox3. The inputs are generated with fixed seeds for three
+// distributions:
+//   uniform:    points uniformly distributed in [-1,1]^d
+//   clustered:  points normally distributed around 16 centers with a
+//               standard deviation of 1/1000
+//   degenerate: 2D, points of an integer grid, so there are many
+//               collinear and cocircular subsets; 3D, integer points on a
+//               sphere, so all points are cospherical and on the hull
+// The results are written as comma-separated values with a header line,
+//   category,name,type,distribution,size,repetitions,min_ns,mean_ns,checksum
+// where min_ns and mean_ns are the minimum and the mean over the
+// repetitions of the time per operation (predicates, conversions) or per
+// call (algorithms) in nanoseconds. The checksum depends only on the
+// results, so it must not change between runs or builds unless the
+// results change. The random distributions of the C++ standard library
+// are implementation defined, so the inputs and checksums of the uniform
+// and clustered points can differ between standard libraries.
+//
+// usage: ExactPredicateBenchmark [-r repetitions] [-s scale] [-f filter] [-o file]
+//   repetitions = number of timed repetitions of each benchmark (default 5)
+//   scale       = multiplier of the default input sizes (default 1)
+//   filter      = run only benchmarks whose category/name contains filter
+//   file        = the output file (default is standard output)
+
+namespace
+{
+    struct Options
+    {
+        Options()
+            :
+            repetitions(5),
+            scale(1),
+            filter{},
+            output{}
+        {
+        }
+
+        int repetitions;
+        int scale;
+        std::string filter;
+        std::string output;
+    };
+
+    class Benchmark
+    {
+    public:
+        Benchmark(Options const& options, std::ostream& output)
+            :
+            mOptions(options),
+            mOutput(output)
+        {
+            mOutput << "category,name,type,distribution,size,repetitions,min_ns,mean_ns,checksum"
+                << std::endl;
+        }
+
+        inline int GetScale() const
+        {
+            return mOptions.scale;
+        }
+
+        // Time 'function', which performs 'size' operations and returns a
+        // checksum of its results. The function is called once to warm up
+        // and then 'repetitions' times.
+        void Run(std::string const& category, std::string const& name,
+            std::string const& type, std::string const& distribution,
+            size_t size, std::function<int64_t()> const& function)
+        {
+            if (!mOptions.filter.empty() &&
+                (category + "/" + name).find(mOptions.filter) == std::string::npos)
+            {
+                return;
+            }
+
+            int64_t checksum = function();
+            double minTime = std::numeric_limits<double>::max();
+            double sumTime = 0.0;
+            for (int r = 0; r < mOptions.repetitions; ++r)
+            {
+                auto start = std::chrono::steady_clock::now();
+                int64_t result = function();
+                auto final = std::chrono::steady_clock::now();
+                LogAssert(result == checksum, "The results of " + name + " are not reproducible.");
+                double time = std::chrono::duration<double, std::nano>(final - start).count() /
+                    static_cast<double>(std::max(size, static_cast<size_t>(1)));
+                minTime = std::min(minTime, time);
+                sumTime += time;
+            }
+
+            mOutput << category << "," << name << "," << type << "," << distribution << ","
+                << size << "," << mOptions.repetitions << "," << minTime << ","
+                << sumTime / static_cast<double>(mOptions.repetitions) << "," << checksum
+                << std::endl;
+        }
+
+    private:
+        Options mOptions;
+        std::ostream& mOutput;
+    };
+
+    char const* const gsDistributions[3] = { "uniform", "clustered", "degenerate" };
+
+    // Generate 'size' points of the distribution specified by the index
+    // into gsDistributions.
+    std::vector<Vector2<double>> Generate2(int distribution, size_t size)
+    {
+        std::mt19937 mte(1234567u + static_cast<unsigned int>(distribution));
+        std::vector<Vector2<double>> points(size);
+        if (distribution == 0)
+        {
+            std::uniform_real_distribution<double> urd(-1.0, 1.0);
+            for (auto& p : points)
+            {
+                p = { urd(mte), urd(mte) };
+            }
+        }
+        else if (distribution == 1)
+        {
+            std::uniform_real_distribution<double> urd(-1.0, 1.0);
+            std::normal_distribution<double> nd(0.0, 0.001);
+            std::array<Vector2<double>, 16> centers;
+            for (auto& c : centers)
+            {
+                c = { urd(mte), urd(mte) };
+            }
+            for (size_t i = 0; i < size; ++i)
+            {
+                Vector2<double> const& c = centers[i % centers.size()];
+                points[i] = { c[0] + nd(mte), c[1] + nd(mte) };
+            }
+        }
+        else
+        {
+            size_t const k = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(size))));
+            for (size_t i = 0; i < size; ++i)
+            {
+                points[i] = { static_cast<double>(i % k), static_cast<double>(i / k) };
+            }
+            std::shuffle(points.begin(), points.end(), mte);
+        }
+        return points;
+    }
+
+    std::vector<Vector3<double>> Generate3(int distribution, size_t size)
+    {
+        std::mt19937 mte(7654321u + static_cast<unsigned int>(distribution));
+        std::vector<Vector3<double>> points;
+        if (distribution == 0)
+        {
+            std::uniform_real_distribution<double> urd(-1.0, 1.0);
+            points.resize(size);
+            for (auto& p : points)
+            {
+                p = { urd(mte), urd(mte), urd(mte) };
+            }
+        }
+        else if (distribution == 1)
+        {
+            std::uniform_real_distribution<double> urd(-1.0, 1.0);
+            std::normal_distribution<double> nd(0.0, 0.001);
+            std::array<Vector3<double>, 16> centers;
+            for (auto& c : centers)
+            {
+                c = { urd(mte), urd(mte), urd(mte) };
+            }
+            points.resize(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                Vector3<double> const& c = centers[i % centers.size()];
+                points[i] = { c[0] + nd(mte), c[1] + nd(mte), c[2] + nd(mte) };
+            }
+        }
+        else
+        {
+            // Collect the integer points on spheres of increasing radius
+            // until there are enough points. The number of points on the
+            // sphere of radius 2r is that of radius r, so the radius is
+            // incremented rather than doubled.
+            for (int64_t radius = 8; points.size() < size; ++radius)
+            {
+                points.clear();
+                int64_t const rsqr = radius * radius;
+                for (int64_t x = -radius; x <= radius; ++x)
+                {
+                    for (int64_t y = -radius; y <= radius; ++y)
+                    {
+                        int64_t const zsqr = rsqr - x * x - y * y;
+                        if (zsqr >= 0)
+                        {
+                            int64_t z = static_cast<int64_t>(std::sqrt(static_cast<double>(zsqr)));
+                            while (z * z > zsqr)
+                            {
+                                --z;
+                            }
+                            while ((z + 1) * (z + 1) <= zsqr)
+                            {
+                                ++z;
+                            }
+                            if (z * z == zsqr)
+                            {
+                                points.push_back({ static_cast<double>(x),
+                                    static_cast<double>(y), static_cast<double>(z) });
+                                if (z > 0)
+                                {
+                                    points.push_back({ static_cast<double>(x),
+                                        static_cast<double>(y), static_cast<double>(-z) });
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            std::shuffle(points.begin(), points.end(), mte);
+            points.resize(size);
+        }
+        return points;
+    }
+
+    // Random index tuples for the predicate queries.
+    template <size_t N>
+    std::vector<std::array<int, N>> GenerateTuples(size_t numPoints, size_t numTuples)
+    {
+        std::mt19937 mte(13579u);
+        std::uniform_int_distribution<int> uid(0, static_cast<int>(numPoints) - 1);
+        std::vector<std::array<int, N>> tuples(numTuples);
+        for (auto& tuple : tuples)
+        {
+            for (auto& index : tuple)
+            {
+                index = uid(mte);
+            }
+        }
+        return tuples;
+    }
+
+    template <typename Real, int N>
+    std::vector<Vector<N, Real>> ConvertPoints(std::vector<Vector<N, double>> const& input)
+    {
+        std::vector<Vector<N, Real>> output(input.size());
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+                output[i][j] = static_cast<Real>(input[i][j]);
+            }
+        }
+        return output;
+    }
+
+    size_t const gsNumPredicatePoints = 1024;
+    size_t const gsNumPredicateTuples = 4096;
+
+    template <typename Real>
+    void Predicates2(Benchmark& benchmark, std::string const& type)
+    {
+        size_t const numTuples = gsNumPredicateTuples * benchmark.GetScale();
+        auto const tuples = GenerateTuples<4>(gsNumPredicatePoints, numTuples);
+        for (int d = 0; d < 3; ++d)
+        {
+            auto const points = ConvertPoints<Real, 2>(Generate2(d, gsNumPredicatePoints));
+            PrimalQuery2<Real> query(static_cast<int>(points.size()), points.data());
+
+            benchmark.Run("predicate", "PrimalQuery2::ToLine", type, gsDistributions[d],
+                numTuples, [&query, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query.ToLine(t[0], t[1], t[2]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQuery2::ToCircumcircle", type, gsDistributions[d],
+                numTuples, [&query, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query.ToCircumcircle(t[0], t[1], t[2], t[3]);
+                    }
+                    return checksum;
+                });
+        }
+    }
+
+    template <typename Real>
+    void Predicates3(Benchmark& benchmark, std::string const& type)
+    {
+        size_t const numTuples = gsNumPredicateTuples * benchmark.GetScale();
+        auto const tuples = GenerateTuples<5>(gsNumPredicatePoints, numTuples);
+        for (int d = 0; d < 3; ++d)
+        {
+            auto const points = ConvertPoints<Real, 3>(Generate3(d, gsNumPredicatePoints));
+            PrimalQuery3<Real> query(static_cast<int>(points.size()), points.data());
+            PrimalQueryEvaluator3<Real> evaluator(static_cast<int>(points.size()), points.data());
+
+            benchmark.Run("predicate", "PrimalQuery3::ToPlane", type, gsDistributions[d],
+                numTuples, [&query, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query.ToPlane(t[0], t[1], t[2], t[3]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQuery3::ToCircumsphere", type, gsDistributions[d],
+                numTuples, [&query, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query.ToCircumsphere(t[0], t[1], t[2], t[3], t[4]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQueryEvaluator3::ToPlane", type, gsDistributions[d],
+                numTuples, [&evaluator, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += evaluator.ToPlane(t[0], t[1], t[2], t[3]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQueryEvaluator3::ToCircumsphere", type, gsDistributions[d],
+                numTuples, [&evaluator, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += evaluator.ToCircumsphere(t[0], t[1], t[2], t[3], t[4]);
+                    }
+                    return checksum;
+                });
+        }
+    }
+
+    // The exact queries for 'float' input using fixed-size integers.
+    void FloatPredicates(Benchmark& benchmark)
+    {
+        size_t const numTuples = gsNumPredicateTuples * benchmark.GetScale();
+        auto const tuples = GenerateTuples<5>(gsNumPredicatePoints, numTuples);
+        for (int d = 0; d < 3; ++d)
+        {
+            auto const points2 = ConvertPoints<float, 2>(Generate2(d, gsNumPredicatePoints));
+            auto const points3 = ConvertPoints<float, 3>(Generate3(d, gsNumPredicatePoints));
+            PrimalQuery2Float query2(static_cast<int>(points2.size()), points2.data());
+            PrimalQuery3Float query3(static_cast<int>(points3.size()), points3.data());
+
+            benchmark.Run("predicate", "PrimalQuery2Float::ToLine", "float", gsDistributions[d],
+                numTuples, [&query2, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query2.ToLine(t[0], t[1], t[2]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQuery2Float::ToCircumcircle", "float", gsDistributions[d],
+                numTuples, [&query2, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query2.ToCircumcircle(t[0], t[1], t[2], t[3]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQuery3Float::ToPlane", "float", gsDistributions[d],
+                numTuples, [&query3, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query3.ToPlane(t[0], t[1], t[2], t[3]);
+                    }
+                    return checksum;
+                });
+
+            benchmark.Run("predicate", "PrimalQuery3Float::ToCircumsphere", "float", gsDistributions[d],
+                numTuples, [&query3, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        checksum += query3.ToCircumsphere(t[0], t[1], t[2], t[3], t[4]);
+                    }
+                    return checksum;
+                });
+        }
+    }
+
+    // The sign of the 2x2 determinant of differences, the core of
+    // PrimalQuery2::ToLine, computed with interval arithmetic whose
+    // endpoints are arbitrary-precision numbers.
+    void Intervals(Benchmark& benchmark)
+    {
+        using Number = BSNumber<UIntegerAP32>;
+        using Interval = APInterval<Number>;
+        size_t const numTuples = gsNumPredicateTuples * benchmark.GetScale();
+        auto const tuples = GenerateTuples<3>(gsNumPredicatePoints, numTuples);
+        for (int d = 0; d < 3; ++d)
+        {
+            auto const points = ConvertPoints<Number, 2>(Generate2(d, gsNumPredicatePoints));
+            benchmark.Run("interval", "APInterval::ToLine", "APInterval<BSNumber<UIntegerAP32>>",
+                gsDistributions[d], numTuples, [&points, &tuples]()
+                {
+                    int64_t checksum = 0;
+                    for (auto const& t : tuples)
+                    {
+                        Vector2<Number> const& p = points[t[0]];
+                        Vector2<Number> const& v0 = points[t[1]];
+                        Vector2<Number> const& v1 = points[t[2]];
+                        Interval x0 = Interval(p[0]) - Interval(v0[0]);
+                        Interval y0 = Interval(p[1]) - Interval(v0[1]);
+                        Interval x1 = Interval(v1[0]) - Interval(v0[0]);
+                        Interval y1 = Interval(v1[1]) - Interval(v0[1]);
+                        Interval det = x0 * y1 - x1 * y0;
+                        checksum += det[0].GetSign() + det[1].GetSign();
+                    }
+                    return checksum;
+                });
+        }
+    }
+
+    void Conversions(Benchmark& benchmark)
+    {
+        using Number = BSNumber<UIntegerAP32>;
+        using Rational = BSRational<UIntegerAP32>;
+        size_t const size = 16384 * benchmark.GetScale();
+        std::mt19937 mte(24680u);
+        std::uniform_real_distribution<double> urd(-1.0, 1.0);
+        std::vector<double> input(size);
+        std::vector<Number> numbers(size);
+        std::vector<Rational> rationals(size);
+        for (size_t i = 0; i < size; ++i)
+        {
+            input[i] = urd(mte);
+            numbers[i] = input[i];
+            rationals[i] = Rational(urd(mte)) / Rational(urd(mte) + 2.0);
+        }
+
+        benchmark.Run("conversion", "double->BSNumber", "BSNumber<UIntegerAP32>", "uniform",
+            size, [&input]()
+            {
+                int64_t checksum = 0;
+                for (auto const& x : input)
+                {
+                    Number number(x);
+                    checksum += number.GetBiasedExponent();
+                }
+                return checksum;
+            });
+
+        benchmark.Run("conversion", "BSNumber->double", "BSNumber<UIntegerAP32>", "uniform",
+            size, [&numbers]()
+            {
+                int64_t checksum = 0;
+                for (auto const& number : numbers)
+                {
+                    checksum += static_cast<int64_t>(static_cast<double>(number) * 1.0e6);
+                }
+                return checksum;
+            });
+
+        benchmark.Run("conversion", "BSRational->double", "BSRational<UIntegerAP32>", "uniform",
+            size, [&rationals]()
+            {
+                int64_t checksum = 0;
+                for (auto const& rational : rationals)
+                {
+                    checksum += static_cast<int64_t>(static_cast<double>(rational) * 1.0e6);
+                }
+                return checksum;
+            });
+
+        benchmark.Run("conversion", "BSRational->BSNumber(53)", "BSRational<UIntegerAP32>", "uniform",
+            size, [&rationals]()
+            {
+                int64_t checksum = 0;
+                Number number;
+                for (auto const& rational : rationals)
+                {
+                    Convert(rational, 53, FE_TONEAREST, number);
+                    checksum += number.GetBiasedExponent();
+                }
+                return checksum;
+            });
+    }
+
+    void Algorithms(Benchmark& benchmark)
+    {
+        size_t const scale = static_cast<size_t>(benchmark.GetScale());
+        for (int d = 0; d < 3; ++d)
+        {
+            size_t const numPoints3 = 8192 * scale;
+            auto const points3 = Generate3(d, numPoints3);
+            benchmark.Run("algorithm", "ConvexHull3", "double", gsDistributions[d], 1,
+                [&points3]()
+                {
+                    ConvexHull3<double> hull;
+                    hull(points3, 0);
+                    return static_cast<int64_t>(hull.GetHull().size());
+                });
+
+            size_t const numPoints2 = 8192 * scale;
+            auto const points2 = Generate2(d, numPoints2);
+            benchmark.Run("algorithm", "Delaunay2", "double", gsDistributions[d], 1,
+                [&points2]()
+                {
+                    Delaunay2<double> delaunay;
+                    delaunay(points2);
+                    return static_cast<int64_t>(delaunay.GetNumTriangles());
+                });
+
+            size_t const numPointsBox = 256 * scale;
+            auto const pointsBox = Generate3(d, numPointsBox);
+            benchmark.Run("algorithm", "MinimumVolumeBox3", "double", gsDistributions[d], 1,
+                [&pointsBox]()
+                {
+                    MinimumVolumeBox3<double, true> mvb;
+                    OrientedBox3<double> box;
+                    double volume = 0.0;
+                    mvb(static_cast<int>(pointsBox.size()), pointsBox.data(), 5, box, volume);
+                    return static_cast<int64_t>(std::round(volume * 1.0e3));
+                });
+        }
+    }
+
+    bool ParseOptions(int numArguments, char* arguments[], Options& options)
+    {
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string const argument = arguments[i];
+            if (i + 1 == numArguments)
+            {
+                return false;
+            }
+            std::string const value = arguments[++i];
+            if (argument == "-r")
+            {
+                options.repetitions = std::atoi(value.c_str());
+            }
+            else if (argument == "-s")
+            {
+                options.scale = std::atoi(value.c_str());
+            }
+            else if (argument == "-f")
+            {
+                options.filter = value;
+            }
+            else if (argument == "-o")
+            {
+                options.output = value;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return options.repetitions > 0 && options.scale > 0;
+    }
+}
+
+int main(int numArguments, char* arguments[])
+{
+    Options options;
+    if (!ParseOptions(numArguments, arguments, options))
+    {
+        std::cerr << "usage: ExactPredicateBenchmark [-r repetitions] [-s scale] "
+            << "[-f filter] [-o file]" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty())
+    {
+        file.open(options.output);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << options.output << std::endl;
+            return 2;
+        }
+    }
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    try
+    {
+        Benchmark benchmark(options, output);
+
+        Predicates2<BSNumber<UIntegerAP32>>(benchmark, "BSNumber<UIntegerAP32>");
+        Predicates2<BSPrecisionPredicates::ToCircumcircleNumber<double>>(benchmark,
+            "BSNumber<UIntegerFP32<" + std::to_string(BSPrecisionPredicates::ToCircumcircle<double>(true)) + ">>");
+        Predicates2<BSRational<UIntegerAP32>>(benchmark, "BSRational<UIntegerAP32>");
+
+        Predicates3<BSNumber<UIntegerAP32>>(benchmark, "BSNumber<UIntegerAP32>");
+        Predicates3<BSPrecisionPredicates::ToCircumsphereNumber<double>>(benchmark,
+            "BSNumber<UIntegerFP32<" + std::to_string(BSPrecisionPredicates::ToCircumsphere<double>(true)) + ">>");
+        Predicates3<BSRational<UIntegerAP32>>(benchmark, "BSRational<UIntegerAP32>");
+
+        FloatPredicates(benchmark);
+        Intervals(benchmark);
+        Conversions(benchmark);
+        Algorithms(benchmark);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 3;
+    }
+    return 0;
+}
@@ -3,7 +3,7 @@
 // Distributed under the Boost Software License, Version 1.0.
 // https://www.boost.org/LICENSE_1_0.txt
 // https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
-// File Version: 4.5.2020.01.10
+// File Version: 4.0.2026.10.15
 
 #include <Mathematics/LogToFile.h>
 #include <Mathematics/LogToStdout.h>
@@ -18,6 +18,8 @@
 #include "FitExp2.h"
 #include "FitLog2.h"
 #include "FitReciprocal.h"
+#include "ShaderEstimates.h"
+#include <memory>
 
 int main()
 {
@@ -50,6 +52,13 @@ int main()
     double error;
     fitterSin.Generate<4>(poly, error);
 
+    // Generate the HLSL and GLSL include files for the estimates in the
+    // working directory. Copy them to Graphics/DX11 and Graphics/GL45.
+    ShaderEstimates hlslEstimates(ShaderEstimates::Language::HLSL);
+    ShaderEstimates glslEstimates(ShaderEstimates::Language::GLSL);
+    hlslEstimates.Write(".");
+    glslEstimates.Write(".");
+
     Logger::Unsubscribe(logToStringArray.get());
     Logger::Unsubscribe(logToStdout.get());
     Logger::Unsubscribe(logToFile.get());
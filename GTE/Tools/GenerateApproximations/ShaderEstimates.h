@@ -0,0 +1,1058 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// File Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <Mathematics/Logger.h>
+#include <Mathematics/Math.h>
+#include <Mathematics/RotationEstimate.h>
+#include <array>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace gte;
+
+// Generate HLSL and GLSL include files for the polynomial estimates of
+// Mathematics/*Estimate.h so that shaders evaluate the same polynomials as
+// the CPU code. The coefficients are written as GTE_C_* macros with the
+// values of Math.h, RotationEstimate.h and ChebyshevRatio.h. For the
+// functions of one variable, a file <Name>Estimate.{hlsli,glsl} contains
+//   <Name>EstimateDegree<D>(x)    the polynomial with the input constraints
+//                                 of <Name>Estimate<Real>::Degree<D>
+//   <Name>EstimateDegree<D>RR(x)  the range-reduced estimate of DegreeRR<D>
+// for all degrees D, overloaded for float and the float vectors of 2, 3 and
+// 4 components. SlerpEstimate and RotationEstimate contain the Chebyshev
+// ratio, slerp and rotation-matrix estimates.
+//
+// The range reductions are computed with vector operations, so they differ
+// slightly from the CPU versions in the same ways as the SIMD4Value
+// versions: the tangent reduction uses x - pi*trunc(x/pi) instead of fmod,
+// and the log2, sqrt and invsqrt reductions require positive normal inputs
+// (the HLSL frexp intrinsic does not handle subnormals).
+//
+// HLSL files are included with #include. GLSL has no include directive, so
+// the contents of a .glsl file must be prepended to the shader source;
+// GLSLProgramFactory inserts the #version line before it. ASinEstimate uses
+// the functions of ACosEstimate, which must be included first.
+
+class ShaderEstimates
+{
+public:
+    enum class Language
+    {
+        HLSL,
+        GLSL
+    };
+
+    ShaderEstimates(Language language);
+
+    // Write the include files to the specified directory. The function
+    // returns false when a file cannot be opened for writing.
+    bool Write(std::string const& directory) const;
+
+private:
+    struct Polynomial
+    {
+        int degree;
+        double maxError;
+        std::vector<double> coeff;
+    };
+
+    typedef void (ShaderEstimates::*Writer)(std::ostream&) const;
+
+    bool WriteFile(std::string const& directory, std::string const& name,
+        std::string const& description, Writer writer) const;
+
+    // The functions of one variable.
+    void WriteSin(std::ostream& output) const;
+    void WriteCos(std::ostream& output) const;
+    void WriteTan(std::ostream& output) const;
+    void WriteATan(std::ostream& output) const;
+    void WriteACos(std::ostream& output) const;
+    void WriteASin(std::ostream& output) const;
+    void WriteExp2(std::ostream& output) const;
+    void WriteLog2(std::ostream& output) const;
+    void WriteSqrt(std::ostream& output) const;
+    void WriteInvSqrt(std::ostream& output) const;
+    void WriteSqrtOrInvSqrt(std::ostream& output, std::string const& name,
+        std::string const& prefix, bool inverse) const;
+
+    // Quaternion slerp and rotation matrices.
+    void WriteSlerp(std::ostream& output) const;
+    void WriteRotation(std::ostream& output) const;
+
+    // Write the coefficients and maximum errors of the polynomials as
+    // macros. The coefficient names start with C<first>.
+    void WriteConstants(std::ostream& output, std::string const& prefix, int first) const;
+    void WriteMathConstants(std::ostream& output) const;
+
+    // Write the Horner evaluation 'poly = c[i] + poly * variable' of the
+    // coefficients c[first..] of prefix_DEG<degree> in decreasing order.
+    void WriteHorner(std::ostream& output, std::string const& type, std::string const& prefix,
+        Polynomial const& polynomial, int first, std::string const& variable) const;
+
+    // Language-dependent expressions.
+    std::string Splat(std::string const& type, std::string const& value) const;
+    std::string Compare(std::string const& type, std::string const& lhs,
+        std::string const& op, std::string const& rhs) const;
+    std::string Select(std::string const& type, std::string const& condition,
+        std::string const& ifTrue, std::string const& ifFalse) const;
+    void WriteFrExp(std::ostream& output, std::string const& type, size_t i,
+        std::string const& y, std::string const& x, std::string const& p, bool declare) const;
+    std::string LdExp(size_t i, std::string const& y, std::string const& p) const;
+
+    static std::string Literal(double value);
+
+    Language mLanguage;
+    std::string mExtension;
+    std::vector<std::string> mTypes, mIntTypes;
+    std::string mQuaternionType, mVector3Type, mMatrix3Type;
+    std::map<std::string, std::vector<Polynomial>> mPolynomials;
+};
+
+
+ShaderEstimates::ShaderEstimates(Language language)
+    :
+    mLanguage(language)
+{
+    if (mLanguage == Language::HLSL)
+    {
+        mExtension = ".hlsli";
+        mTypes = { "float", "float2", "float3", "float4" };
+        mIntTypes = { "int", "int2", "int3", "int4" };
+        mQuaternionType = "float4";
+        mVector3Type = "float3";
+        mMatrix3Type = "float3x3";
+    }
+    else
+    {
+        mExtension = ".glsl";
+        mTypes = { "float", "vec2", "vec3", "vec4" };
+        mIntTypes = { "int", "ivec2", "ivec3", "ivec4" };
+        mQuaternionType = "vec4";
+        mVector3Type = "vec3";
+        mMatrix3Type = "mat3";
+    }
+
+    mPolynomials["SQRT"] =
+    {
+        { 1, GTE_C_SQRT_DEG1_MAX_ERROR, {
+            GTE_C_SQRT_DEG1_C0, GTE_C_SQRT_DEG1_C1
+        } },
+        { 2, GTE_C_SQRT_DEG2_MAX_ERROR, {
+            GTE_C_SQRT_DEG2_C0, GTE_C_SQRT_DEG2_C1, GTE_C_SQRT_DEG2_C2
+        } },
+        { 3, GTE_C_SQRT_DEG3_MAX_ERROR, {
+            GTE_C_SQRT_DEG3_C0, GTE_C_SQRT_DEG3_C1, GTE_C_SQRT_DEG3_C2,
+            GTE_C_SQRT_DEG3_C3
+        } },
+        { 4, GTE_C_SQRT_DEG4_MAX_ERROR, {
+            GTE_C_SQRT_DEG4_C0, GTE_C_SQRT_DEG4_C1, GTE_C_SQRT_DEG4_C2,
+            GTE_C_SQRT_DEG4_C3, GTE_C_SQRT_DEG4_C4
+        } },
+        { 5, GTE_C_SQRT_DEG5_MAX_ERROR, {
+            GTE_C_SQRT_DEG5_C0, GTE_C_SQRT_DEG5_C1, GTE_C_SQRT_DEG5_C2,
+            GTE_C_SQRT_DEG5_C3, GTE_C_SQRT_DEG5_C4, GTE_C_SQRT_DEG5_C5
+        } },
+        { 6, GTE_C_SQRT_DEG6_MAX_ERROR, {
+            GTE_C_SQRT_DEG6_C0, GTE_C_SQRT_DEG6_C1, GTE_C_SQRT_DEG6_C2,
+            GTE_C_SQRT_DEG6_C3, GTE_C_SQRT_DEG6_C4, GTE_C_SQRT_DEG6_C5,
+            GTE_C_SQRT_DEG6_C6
+        } },
+        { 7, GTE_C_SQRT_DEG7_MAX_ERROR, {
+            GTE_C_SQRT_DEG7_C0, GTE_C_SQRT_DEG7_C1, GTE_C_SQRT_DEG7_C2,
+            GTE_C_SQRT_DEG7_C3, GTE_C_SQRT_DEG7_C4, GTE_C_SQRT_DEG7_C5,
+            GTE_C_SQRT_DEG7_C6, GTE_C_SQRT_DEG7_C7
+        } },
+        { 8, GTE_C_SQRT_DEG8_MAX_ERROR, {
+            GTE_C_SQRT_DEG8_C0, GTE_C_SQRT_DEG8_C1, GTE_C_SQRT_DEG8_C2,
+            GTE_C_SQRT_DEG8_C3, GTE_C_SQRT_DEG8_C4, GTE_C_SQRT_DEG8_C5,
+            GTE_C_SQRT_DEG8_C6, GTE_C_SQRT_DEG8_C7, GTE_C_SQRT_DEG8_C8
+        } }
+    };
+
+    mPolynomials["INVSQRT"] =
+    {
+        { 1, GTE_C_INVSQRT_DEG1_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG1_C0, GTE_C_INVSQRT_DEG1_C1
+        } },
+        { 2, GTE_C_INVSQRT_DEG2_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG2_C0, GTE_C_INVSQRT_DEG2_C1, GTE_C_INVSQRT_DEG2_C2
+        } },
+        { 3, GTE_C_INVSQRT_DEG3_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG3_C0, GTE_C_INVSQRT_DEG3_C1, GTE_C_INVSQRT_DEG3_C2,
+            GTE_C_INVSQRT_DEG3_C3
+        } },
+        { 4, GTE_C_INVSQRT_DEG4_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG4_C0, GTE_C_INVSQRT_DEG4_C1, GTE_C_INVSQRT_DEG4_C2,
+            GTE_C_INVSQRT_DEG4_C3, GTE_C_INVSQRT_DEG4_C4
+        } },
+        { 5, GTE_C_INVSQRT_DEG5_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG5_C0, GTE_C_INVSQRT_DEG5_C1, GTE_C_INVSQRT_DEG5_C2,
+            GTE_C_INVSQRT_DEG5_C3, GTE_C_INVSQRT_DEG5_C4, GTE_C_INVSQRT_DEG5_C5
+        } },
+        { 6, GTE_C_INVSQRT_DEG6_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG6_C0, GTE_C_INVSQRT_DEG6_C1, GTE_C_INVSQRT_DEG6_C2,
+            GTE_C_INVSQRT_DEG6_C3, GTE_C_INVSQRT_DEG6_C4, GTE_C_INVSQRT_DEG6_C5,
+            GTE_C_INVSQRT_DEG6_C6
+        } },
+        { 7, GTE_C_INVSQRT_DEG7_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG7_C0, GTE_C_INVSQRT_DEG7_C1, GTE_C_INVSQRT_DEG7_C2,
+            GTE_C_INVSQRT_DEG7_C3, GTE_C_INVSQRT_DEG7_C4, GTE_C_INVSQRT_DEG7_C5,
+            GTE_C_INVSQRT_DEG7_C6, GTE_C_INVSQRT_DEG7_C7
+        } },
+        { 8, GTE_C_INVSQRT_DEG8_MAX_ERROR, {
+            GTE_C_INVSQRT_DEG8_C0, GTE_C_INVSQRT_DEG8_C1, GTE_C_INVSQRT_DEG8_C2,
+            GTE_C_INVSQRT_DEG8_C3, GTE_C_INVSQRT_DEG8_C4, GTE_C_INVSQRT_DEG8_C5,
+            GTE_C_INVSQRT_DEG8_C6, GTE_C_INVSQRT_DEG8_C7, GTE_C_INVSQRT_DEG8_C8
+        } }
+    };
+
+    mPolynomials["SIN"] =
+    {
+        { 3, GTE_C_SIN_DEG3_MAX_ERROR, {
+            GTE_C_SIN_DEG3_C0, GTE_C_SIN_DEG3_C1
+        } },
+        { 5, GTE_C_SIN_DEG5_MAX_ERROR, {
+            GTE_C_SIN_DEG5_C0, GTE_C_SIN_DEG5_C1, GTE_C_SIN_DEG5_C2
+        } },
+        { 7, GTE_C_SIN_DEG7_MAX_ERROR, {
+            GTE_C_SIN_DEG7_C0, GTE_C_SIN_DEG7_C1, GTE_C_SIN_DEG7_C2,
+            GTE_C_SIN_DEG7_C3
+        } },
+        { 9, GTE_C_SIN_DEG9_MAX_ERROR, {
+            GTE_C_SIN_DEG9_C0, GTE_C_SIN_DEG9_C1, GTE_C_SIN_DEG9_C2,
+            GTE_C_SIN_DEG9_C3, GTE_C_SIN_DEG9_C4
+        } },
+        { 11, GTE_C_SIN_DEG11_MAX_ERROR, {
+            GTE_C_SIN_DEG11_C0, GTE_C_SIN_DEG11_C1, GTE_C_SIN_DEG11_C2,
+            GTE_C_SIN_DEG11_C3, GTE_C_SIN_DEG11_C4, GTE_C_SIN_DEG11_C5
+        } }
+    };
+
+    mPolynomials["COS"] =
+    {
+        { 2, GTE_C_COS_DEG2_MAX_ERROR, {
+            GTE_C_COS_DEG2_C0, GTE_C_COS_DEG2_C1
+        } },
+        { 4, GTE_C_COS_DEG4_MAX_ERROR, {
+            GTE_C_COS_DEG4_C0, GTE_C_COS_DEG4_C1, GTE_C_COS_DEG4_C2
+        } },
+        { 6, GTE_C_COS_DEG6_MAX_ERROR, {
+            GTE_C_COS_DEG6_C0, GTE_C_COS_DEG6_C1, GTE_C_COS_DEG6_C2,
+            GTE_C_COS_DEG6_C3
+        } },
+        { 8, GTE_C_COS_DEG8_MAX_ERROR, {
+            GTE_C_COS_DEG8_C0, GTE_C_COS_DEG8_C1, GTE_C_COS_DEG8_C2,
+            GTE_C_COS_DEG8_C3, GTE_C_COS_DEG8_C4
+        } },
+        { 10, GTE_C_COS_DEG10_MAX_ERROR, {
+            GTE_C_COS_DEG10_C0, GTE_C_COS_DEG10_C1, GTE_C_COS_DEG10_C2,
+            GTE_C_COS_DEG10_C3, GTE_C_COS_DEG10_C4, GTE_C_COS_DEG10_C5
+        } }
+    };
+
+    mPolynomials["TAN"] =
+    {
+        { 3, GTE_C_TAN_DEG3_MAX_ERROR, {
+            GTE_C_TAN_DEG3_C0, GTE_C_TAN_DEG3_C1
+        } },
+        { 5, GTE_C_TAN_DEG5_MAX_ERROR, {
+            GTE_C_TAN_DEG5_C0, GTE_C_TAN_DEG5_C1, GTE_C_TAN_DEG5_C2
+        } },
+        { 7, GTE_C_TAN_DEG7_MAX_ERROR, {
+            GTE_C_TAN_DEG7_C0, GTE_C_TAN_DEG7_C1, GTE_C_TAN_DEG7_C2,
+            GTE_C_TAN_DEG7_C3
+        } },
+        { 9, GTE_C_TAN_DEG9_MAX_ERROR, {
+            GTE_C_TAN_DEG9_C0, GTE_C_TAN_DEG9_C1, GTE_C_TAN_DEG9_C2,
+            GTE_C_TAN_DEG9_C3, GTE_C_TAN_DEG9_C4
+        } },
+        { 11, GTE_C_TAN_DEG11_MAX_ERROR, {
+            GTE_C_TAN_DEG11_C0, GTE_C_TAN_DEG11_C1, GTE_C_TAN_DEG11_C2,
+            GTE_C_TAN_DEG11_C3, GTE_C_TAN_DEG11_C4, GTE_C_TAN_DEG11_C5
+        } },
+        { 13, GTE_C_TAN_DEG13_MAX_ERROR, {
+            GTE_C_TAN_DEG13_C0, GTE_C_TAN_DEG13_C1, GTE_C_TAN_DEG13_C2,
+            GTE_C_TAN_DEG13_C3, GTE_C_TAN_DEG13_C4, GTE_C_TAN_DEG13_C5,
+            GTE_C_TAN_DEG13_C6
+        } }
+    };
+
+    mPolynomials["ACOS"] =
+    {
+        { 1, GTE_C_ACOS_DEG1_MAX_ERROR, {
+            GTE_C_ACOS_DEG1_C0, GTE_C_ACOS_DEG1_C1
+        } },
+        { 2, GTE_C_ACOS_DEG2_MAX_ERROR, {
+            GTE_C_ACOS_DEG2_C0, GTE_C_ACOS_DEG2_C1, GTE_C_ACOS_DEG2_C2
+        } },
+        { 3, GTE_C_ACOS_DEG3_MAX_ERROR, {
+            GTE_C_ACOS_DEG3_C0, GTE_C_ACOS_DEG3_C1, GTE_C_ACOS_DEG3_C2,
+            GTE_C_ACOS_DEG3_C3
+        } },
+        { 4, GTE_C_ACOS_DEG4_MAX_ERROR, {
+            GTE_C_ACOS_DEG4_C0, GTE_C_ACOS_DEG4_C1, GTE_C_ACOS_DEG4_C2,
+            GTE_C_ACOS_DEG4_C3, GTE_C_ACOS_DEG4_C4
+        } },
+        { 5, GTE_C_ACOS_DEG5_MAX_ERROR, {
+            GTE_C_ACOS_DEG5_C0, GTE_C_ACOS_DEG5_C1, GTE_C_ACOS_DEG5_C2,
+            GTE_C_ACOS_DEG5_C3, GTE_C_ACOS_DEG5_C4, GTE_C_ACOS_DEG5_C5
+        } },
+        { 6, GTE_C_ACOS_DEG6_MAX_ERROR, {
+            GTE_C_ACOS_DEG6_C0, GTE_C_ACOS_DEG6_C1, GTE_C_ACOS_DEG6_C2,
+            GTE_C_ACOS_DEG6_C3, GTE_C_ACOS_DEG6_C4, GTE_C_ACOS_DEG6_C5,
+            GTE_C_ACOS_DEG6_C6
+        } },
+        { 7, GTE_C_ACOS_DEG7_MAX_ERROR, {
+            GTE_C_ACOS_DEG7_C0, GTE_C_ACOS_DEG7_C1, GTE_C_ACOS_DEG7_C2,
+            GTE_C_ACOS_DEG7_C3, GTE_C_ACOS_DEG7_C4, GTE_C_ACOS_DEG7_C5,
+            GTE_C_ACOS_DEG7_C6, GTE_C_ACOS_DEG7_C7
+        } },
+        { 8, GTE_C_ACOS_DEG8_MAX_ERROR, {
+            GTE_C_ACOS_DEG8_C0, GTE_C_ACOS_DEG8_C1, GTE_C_ACOS_DEG8_C2,
+            GTE_C_ACOS_DEG8_C3, GTE_C_ACOS_DEG8_C4, GTE_C_ACOS_DEG8_C5,
+            GTE_C_ACOS_DEG8_C6, GTE_C_ACOS_DEG8_C7, GTE_C_ACOS_DEG8_C8
+        } }
+    };
+
+    mPolynomials["ATAN"] =
+    {
+        { 3, GTE_C_ATAN_DEG3_MAX_ERROR, {
+            GTE_C_ATAN_DEG3_C0, GTE_C_ATAN_DEG3_C1
+        } },
+        { 5, GTE_C_ATAN_DEG5_MAX_ERROR, {
+            GTE_C_ATAN_DEG5_C0, GTE_C_ATAN_DEG5_C1, GTE_C_ATAN_DEG5_C2
+        } },
+        { 7, GTE_C_ATAN_DEG7_MAX_ERROR, {
+            GTE_C_ATAN_DEG7_C0, GTE_C_ATAN_DEG7_C1, GTE_C_ATAN_DEG7_C2,
+            GTE_C_ATAN_DEG7_C3
+        } },
+        { 9, GTE_C_ATAN_DEG9_MAX_ERROR, {
+            GTE_C_ATAN_DEG9_C0, GTE_C_ATAN_DEG9_C1, GTE_C_ATAN_DEG9_C2,
+            GTE_C_ATAN_DEG9_C3, GTE_C_ATAN_DEG9_C4
+        } },
+        { 11, GTE_C_ATAN_DEG11_MAX_ERROR, {
+            GTE_C_ATAN_DEG11_C0, GTE_C_ATAN_DEG11_C1, GTE_C_ATAN_DEG11_C2,
+            GTE_C_ATAN_DEG11_C3, GTE_C_ATAN_DEG11_C4, GTE_C_ATAN_DEG11_C5
+        } },
+        { 13, GTE_C_ATAN_DEG13_MAX_ERROR, {
+            GTE_C_ATAN_DEG13_C0, GTE_C_ATAN_DEG13_C1, GTE_C_ATAN_DEG13_C2,
+            GTE_C_ATAN_DEG13_C3, GTE_C_ATAN_DEG13_C4, GTE_C_ATAN_DEG13_C5,
+            GTE_C_ATAN_DEG13_C6
+        } }
+    };
+
+    mPolynomials["EXP2"] =
+    {
+        { 1, GTE_C_EXP2_DEG1_MAX_ERROR, {
+            GTE_C_EXP2_DEG1_C0, GTE_C_EXP2_DEG1_C1
+        } },
+        { 2, GTE_C_EXP2_DEG2_MAX_ERROR, {
+            GTE_C_EXP2_DEG2_C0, GTE_C_EXP2_DEG2_C1, GTE_C_EXP2_DEG2_C2
+        } },
+        { 3, GTE_C_EXP2_DEG3_MAX_ERROR, {
+            GTE_C_EXP2_DEG3_C0, GTE_C_EXP2_DEG3_C1, GTE_C_EXP2_DEG3_C2,
+            GTE_C_EXP2_DEG3_C3
+        } },
+        { 4, GTE_C_EXP2_DEG4_MAX_ERROR, {
+            GTE_C_EXP2_DEG4_C0, GTE_C_EXP2_DEG4_C1, GTE_C_EXP2_DEG4_C2,
+            GTE_C_EXP2_DEG4_C3, GTE_C_EXP2_DEG4_C4
+        } },
+        { 5, GTE_C_EXP2_DEG5_MAX_ERROR, {
+            GTE_C_EXP2_DEG5_C0, GTE_C_EXP2_DEG5_C1, GTE_C_EXP2_DEG5_C2,
+            GTE_C_EXP2_DEG5_C3, GTE_C_EXP2_DEG5_C4, GTE_C_EXP2_DEG5_C5
+        } },
+        { 6, GTE_C_EXP2_DEG6_MAX_ERROR, {
+            GTE_C_EXP2_DEG6_C0, GTE_C_EXP2_DEG6_C1, GTE_C_EXP2_DEG6_C2,
+            GTE_C_EXP2_DEG6_C3, GTE_C_EXP2_DEG6_C4, GTE_C_EXP2_DEG6_C5,
+            GTE_C_EXP2_DEG6_C6
+        } },
+        { 7, GTE_C_EXP2_DEG7_MAX_ERROR, {
+            GTE_C_EXP2_DEG7_C0, GTE_C_EXP2_DEG7_C1, GTE_C_EXP2_DEG7_C2,
+            GTE_C_EXP2_DEG7_C3, GTE_C_EXP2_DEG7_C4, GTE_C_EXP2_DEG7_C5,
+            GTE_C_EXP2_DEG7_C6, GTE_C_EXP2_DEG7_C7
+        } }
+    };
+
+    mPolynomials["LOG2"] =
+    {
+        { 1, GTE_C_LOG2_DEG1_MAX_ERROR, {
+            GTE_C_LOG2_DEG1_C1
+        } },
+        { 2, GTE_C_LOG2_DEG2_MAX_ERROR, {
+            GTE_C_LOG2_DEG2_C1, GTE_C_LOG2_DEG2_C2
+        } },
+        { 3, GTE_C_LOG2_DEG3_MAX_ERROR, {
+            GTE_C_LOG2_DEG3_C1, GTE_C_LOG2_DEG3_C2, GTE_C_LOG2_DEG3_C3
+        } },
+        { 4, GTE_C_LOG2_DEG4_MAX_ERROR, {
+            GTE_C_LOG2_DEG4_C1, GTE_C_LOG2_DEG4_C2, GTE_C_LOG2_DEG4_C3,
+            GTE_C_LOG2_DEG4_C4
+        } },
+        { 5, GTE_C_LOG2_DEG5_MAX_ERROR, {
+            GTE_C_LOG2_DEG5_C1, GTE_C_LOG2_DEG5_C2, GTE_C_LOG2_DEG5_C3,
+            GTE_C_LOG2_DEG5_C4, GTE_C_LOG2_DEG5_C5
+        } },
+        { 6, GTE_C_LOG2_DEG6_MAX_ERROR, {
+            GTE_C_LOG2_DEG6_C1, GTE_C_LOG2_DEG6_C2, GTE_C_LOG2_DEG6_C3,
+            GTE_C_LOG2_DEG6_C4, GTE_C_LOG2_DEG6_C5, GTE_C_LOG2_DEG6_C6
+        } },
+        { 7, GTE_C_LOG2_DEG7_MAX_ERROR, {
+            GTE_C_LOG2_DEG7_C1, GTE_C_LOG2_DEG7_C2, GTE_C_LOG2_DEG7_C3,
+            GTE_C_LOG2_DEG7_C4, GTE_C_LOG2_DEG7_C5, GTE_C_LOG2_DEG7_C6,
+            GTE_C_LOG2_DEG7_C7
+        } },
+        { 8, GTE_C_LOG2_DEG8_MAX_ERROR, {
+            GTE_C_LOG2_DEG8_C1, GTE_C_LOG2_DEG8_C2, GTE_C_LOG2_DEG8_C3,
+            GTE_C_LOG2_DEG8_C4, GTE_C_LOG2_DEG8_C5, GTE_C_LOG2_DEG8_C6,
+            GTE_C_LOG2_DEG8_C7, GTE_C_LOG2_DEG8_C8
+        } }
+    };
+}
+
+bool ShaderEstimates::Write(std::string const& directory) const
+{
+    return WriteFile(directory, "SinEstimate",
+        "Minimax polynomial approximations to sin(x) for x in [-pi/2,pi/2].",
+        &ShaderEstimates::WriteSin)
+        && WriteFile(directory, "CosEstimate",
+        "Minimax polynomial approximations to cos(x) for x in [-pi/2,pi/2].",
+        &ShaderEstimates::WriteCos)
+        && WriteFile(directory, "TanEstimate",
+        "Minimax polynomial approximations to tan(x) for x in [-pi/4,pi/4].",
+        &ShaderEstimates::WriteTan)
+        && WriteFile(directory, "ATanEstimate",
+        "Minimax polynomial approximations to atan(x) for x in [-1,1].",
+        &ShaderEstimates::WriteATan)
+        && WriteFile(directory, "ACosEstimate",
+        "Approximations to acos(x) = sqrt(1-x)*p(x) for x in [0,1].",
+        &ShaderEstimates::WriteACos)
+        && WriteFile(directory, "ASinEstimate",
+        "Approximations to asin(x) = pi/2 - acos(x) for x in [0,1].",
+        &ShaderEstimates::WriteASin)
+        && WriteFile(directory, "Exp2Estimate",
+        "Minimax polynomial approximations to 2^x for x in [0,1].",
+        &ShaderEstimates::WriteExp2)
+        && WriteFile(directory, "Log2Estimate",
+        "Minimax polynomial approximations to log2(x) for x in [1,2].",
+        &ShaderEstimates::WriteLog2)
+        && WriteFile(directory, "SqrtEstimate",
+        "Minimax polynomial approximations to sqrt(x) for x in [1,2].",
+        &ShaderEstimates::WriteSqrt)
+        && WriteFile(directory, "InvSqrtEstimate",
+        "Minimax polynomial approximations to 1/sqrt(x) for x in [1,2].",
+        &ShaderEstimates::WriteInvSqrt)
+        && WriteFile(directory, "SlerpEstimate",
+        "Estimates of sin(t*A)/sin(A) and of the slerp of unit quaternions.",
+        &ShaderEstimates::WriteSlerp)
+        && WriteFile(directory, "RotationEstimate",
+        "Estimates of the rotation coefficients and of rotation matrices.",
+        &ShaderEstimates::WriteRotation);
+}
+
+bool ShaderEstimates::WriteFile(std::string const& directory, std::string const& name,
+    std::string const& description, Writer writer) const
+{
+    std::string filename = directory + "/" + name + mExtension;
+    std::ofstream output(filename);
+    if (!output)
+    {
+        LogError("Cannot open " + filename + ".");
+        return false;
+    }
+
+    std::string guard = "GTE_" + name + (mLanguage == Language::HLSL ? "_HLSLI" : "_GLSL");
+    for (auto& c : guard)
+    {
+        c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+
+    output << "// David Eberly, Geometric Tools, Redmond WA 98052\n";
+    output << "// Copyright (c) 1998-2021\n";
+    output << "// Distributed under the Boost Software License, Version 1.0.\n";
+    output << "// https://www.boost.org/LICENSE_1_0.txt\n";
+    output << "// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt\n";
+    output << "// Version: 4.0.2026.10.15\n\n";
+    output << "// " << description << "\n";
+    output << "// This file is generated by Tools/GenerateApproximations from the\n";
+    output << "// coefficients used by Mathematics/" << name << ".h. Do not edit it.\n\n";
+    output << "#ifndef " << guard << "\n";
+    output << "#define " << guard << "\n\n";
+    (this->*writer)(output);
+    output << "#endif\n";
+    return static_cast<bool>(output);
+}
+
+void ShaderEstimates::WriteSin(std::ostream& output) const
+{
+    WriteMathConstants(output);
+    WriteConstants(output, "SIN", 0);
+    for (size_t i = 0; i < mTypes.size(); ++i)
+    {
+        std::string const& T = mTypes[i];
+        output << T << " SinEstimateReduce(" << T << " x)\n{\n";
+        output << "    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.\n";
+        output << "    " << T << " quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));\n";
+        output << "    " << T << " y = x - GTE_C_TWO_PI * quotient;\n\n";
+        output << "    // Map y to [-pi/2,pi/2] with sin(y) = sin(x).\n";
+        output << "    return " << Select(T, Compare(T, "y", ">", "GTE_C_HALF_PI"), "GTE_C_PI - y",
+            Select(T, Compare(T, "y", "<", "-GTE_C_HALF_PI"), "-GTE_C_PI - y", "y")) << ";\n";
+        output << "}\n\n";
+    }
+
+    for (auto const& polynomial : mPolynomials.at("SIN"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " SinEstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    " << T << " xsqr = x * x;\n";
+            WriteHorner(output, T, "SIN", polynomial, 0, "xsqr");
+            output << "    poly = poly * x;\n";
+            output << "    return poly;\n}\n\n";
+
+            output << T << " SinEstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            output << "    return SinEstimateDegree" << D << "(SinEstimateReduce(x));\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteCos(std::ostream& output) const
+{
+    WriteMathConstants(output);
+    WriteConstants(output, "COS", 0);
+    for (size_t i = 0; i < mTypes.size(); ++i)
+    {
+        std::string const& T = mTypes[i];
+        output << "void CosEstimateReduce(" << T << " x, out " << T << " y, out " << T << " sgn)\n{\n";
+        output << "    // Map x to y in [-pi,pi], x = 2*pi*quotient + remainder.\n";
+        output << "    " << T << " quotient = trunc(GTE_C_INV_TWO_PI * x + 0.5 * sign(x));\n";
+        output << "    y = x - GTE_C_TWO_PI * quotient;\n\n";
+        output << "    // Map y to [-pi/2,pi/2] with cos(y) = sgn*cos(x).\n";
+        output << "    sgn = " << Select(T, Compare(T, "abs(y)", ">", "GTE_C_HALF_PI"),
+            Splat(T, "-1.0"), Splat(T, "1.0")) << ";\n";
+        output << "    y = " << Select(T, Compare(T, "y", ">", "GTE_C_HALF_PI"), "GTE_C_PI - y",
+            Select(T, Compare(T, "y", "<", "-GTE_C_HALF_PI"), "-GTE_C_PI - y", "y")) << ";\n";
+        output << "}\n\n";
+    }
+
+    for (auto const& polynomial : mPolynomials.at("COS"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " CosEstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    " << T << " xsqr = x * x;\n";
+            WriteHorner(output, T, "COS", polynomial, 0, "xsqr");
+            output << "    return poly;\n}\n\n";
+
+            output << T << " CosEstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            output << "    " << T << " y, sgn;\n";
+            output << "    CosEstimateReduce(x, y, sgn);\n";
+            output << "    return sgn * CosEstimateDegree" << D << "(y);\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteTan(std::ostream& output) const
+{
+    WriteMathConstants(output);
+    WriteConstants(output, "TAN", 0);
+    for (size_t i = 0; i < mTypes.size(); ++i)
+    {
+        std::string const& T = mTypes[i];
+        output << T << " TanEstimateReduce(" << T << " x)\n{\n";
+        output << "    // Map x to y in [-pi,pi], x = pi*quotient + remainder.\n";
+        output << "    " << T << " y = x - GTE_C_PI * trunc(x / GTE_C_PI);\n\n";
+        output << "    // Map y to [-pi/2,pi/2] with tan(y) = tan(x).\n";
+        output << "    return " << Select(T, Compare(T, "y", ">", "GTE_C_HALF_PI"), "y - GTE_C_PI",
+            Select(T, Compare(T, "y", "<", "-GTE_C_HALF_PI"), "y + GTE_C_PI", "y")) << ";\n";
+        output << "}\n\n";
+    }
+
+    for (auto const& polynomial : mPolynomials.at("TAN"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " TanEstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    " << T << " xsqr = x * x;\n";
+            WriteHorner(output, T, "TAN", polynomial, 0, "xsqr");
+            output << "    poly = poly * x;\n";
+            output << "    return poly;\n}\n\n";
+
+            // For |y| > pi/4, use tan(y) = (1 + tan(z))/(1 - tan(z)) for
+            // z = y - pi/4 and tan(y) = -(1 - tan(z))/(1 + tan(z)) for
+            // z = y + pi/4.
+            std::string const above = Compare(T, "y", ">", "GTE_C_QUARTER_PI");
+            std::string const below = Compare(T, "y", "<", "-GTE_C_QUARTER_PI");
+            output << T << " TanEstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            output << "    " << T << " y = TanEstimateReduce(x);\n";
+            output << "    " << T << " z = " << Select(T, above, "y - GTE_C_QUARTER_PI",
+                Select(T, below, "y + GTE_C_QUARTER_PI", "y")) << ";\n";
+            output << "    " << T << " poly = TanEstimateDegree" << D << "(z);\n";
+            output << "    return " << Select(T, above, "(1.0 + poly) / (1.0 - poly)",
+                Select(T, below, "-(1.0 - poly) / (1.0 + poly)", "poly")) << ";\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteATan(std::ostream& output) const
+{
+    WriteMathConstants(output);
+    WriteConstants(output, "ATAN", 0);
+    for (auto const& polynomial : mPolynomials.at("ATAN"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " ATanEstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    " << T << " xsqr = x * x;\n";
+            WriteHorner(output, T, "ATAN", polynomial, 0, "xsqr");
+            output << "    poly = poly * x;\n";
+            output << "    return poly;\n}\n\n";
+
+            // For |x| > 1, use atan(x) = sign(x)*pi/2 - atan(1/x).
+            std::string const inside = Compare(T, "abs(x)", "<=", "1.0");
+            output << T << " ATanEstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            output << "    " << T << " poly = ATanEstimateDegree" << D << "("
+                << Select(T, inside, "x", "1.0 / x") << ");\n";
+            output << "    return " << Select(T, inside, "poly",
+                Select(T, Compare(T, "x", ">", "0.0"), "GTE_C_HALF_PI - poly",
+                "-GTE_C_HALF_PI - poly")) << ";\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteACos(std::ostream& output) const
+{
+    WriteConstants(output, "ACOS", 0);
+    for (auto const& polynomial : mPolynomials.at("ACOS"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " ACosEstimateDegree" << D << "(" << T << " x)\n{\n";
+            WriteHorner(output, T, "ACOS", polynomial, 0, "x");
+            output << "    poly = poly * sqrt(1.0 - x);\n";
+            output << "    return poly;\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteASin(std::ostream& output) const
+{
+    WriteMathConstants(output);
+    if (mLanguage == Language::HLSL)
+    {
+        output << "#include \"ACosEstimate.hlsli\"\n\n";
+    }
+
+    for (auto const& polynomial : mPolynomials.at("ACOS"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " ASinEstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    return GTE_C_HALF_PI - ACosEstimateDegree" << D << "(x);\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteExp2(std::ostream& output) const
+{
+    WriteConstants(output, "EXP2", 0);
+    for (auto const& polynomial : mPolynomials.at("EXP2"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (size_t i = 0; i < mTypes.size(); ++i)
+        {
+            std::string const& T = mTypes[i];
+            output << T << " Exp2EstimateDegree" << D << "(" << T << " x)\n{\n";
+            WriteHorner(output, T, "EXP2", polynomial, 0, "x");
+            output << "    return poly;\n}\n\n";
+
+            output << T << " Exp2EstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            output << "    " << T << " p = floor(x);\n";
+            output << "    " << T << " poly = Exp2EstimateDegree" << D << "(x - p);\n";
+            output << "    return " << LdExp(i, "poly", "p") << ";\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteLog2(std::ostream& output) const
+{
+    WriteConstants(output, "LOG2", 1);
+    for (auto const& polynomial : mPolynomials.at("LOG2"))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (size_t i = 0; i < mTypes.size(); ++i)
+        {
+            std::string const& T = mTypes[i];
+            output << T << " Log2EstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    " << T << " t = x - 1.0;\n";
+            WriteHorner(output, T, "LOG2", polynomial, 1, "t");
+            output << "    poly = poly * t;\n";
+            output << "    return poly;\n}\n\n";
+
+            output << T << " Log2EstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            WriteFrExp(output, T, i, "y", "x", "p", true);
+            output << "    return Log2EstimateDegree" << D << "(2.0 * y) + (p - 1.0);\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteSqrt(std::ostream& output) const
+{
+    WriteSqrtOrInvSqrt(output, "Sqrt", "SQRT", false);
+}
+
+void ShaderEstimates::WriteInvSqrt(std::ostream& output) const
+{
+    WriteSqrtOrInvSqrt(output, "InvSqrt", "INVSQRT", true);
+}
+
+void ShaderEstimates::WriteSqrtOrInvSqrt(std::ostream& output, std::string const& name,
+    std::string const& prefix, bool inverse) const
+{
+    WriteMathConstants(output);
+    WriteConstants(output, prefix, 0);
+    for (size_t i = 0; i < mTypes.size(); ++i)
+    {
+        // Compute x = 2^{2*h+r}*y with y in [1,2) and r in {0,1}, so
+        // sqrt(x) = 2^h*adj*sqrt(y) with adj = sqrt(2)^r.
+        std::string const& T = mTypes[i];
+        output << "void " << name << "EstimateReduce(" << T << " x, out " << T << " adj, out "
+            << T << " y, out " << T << " p)\n{\n";
+        WriteFrExp(output, T, i, "y", "x", "p", false);
+        output << "    y = 2.0 * y;\n";
+        output << "    p = p - 1.0;\n";
+        output << "    " << T << " half = floor(0.5 * p);\n";
+        output << "    adj = " << Select(T, Compare(T, "p - 2.0 * half", ">", "0.0"),
+            Splat(T, inverse ? "GTE_C_INV_SQRT_2" : "GTE_C_SQRT_2"), Splat(T, "1.0")) << ";\n";
+        output << "    p = " << (inverse ? "-half" : "half") << ";\n}\n\n";
+
+        output << T << " " << name << "EstimateCombine(" << T << " adj, " << T << " y, "
+            << T << " p)\n{\n";
+        output << "    return adj * " << LdExp(i, "y", "p") << ";\n}\n\n";
+    }
+
+    for (auto const& polynomial : mPolynomials.at(prefix))
+    {
+        std::string const D = std::to_string(polynomial.degree);
+        for (auto const& T : mTypes)
+        {
+            output << T << " " << name << "EstimateDegree" << D << "(" << T << " x)\n{\n";
+            output << "    " << T << " t = x - 1.0;\n";
+            WriteHorner(output, T, prefix, polynomial, 0, "t");
+            output << "    return poly;\n}\n\n";
+
+            output << T << " " << name << "EstimateDegree" << D << "RR(" << T << " x)\n{\n";
+            output << "    " << T << " adj, y, p;\n";
+            output << "    " << name << "EstimateReduce(x, adj, y, p);\n";
+            output << "    " << T << " poly = " << name << "EstimateDegree" << D << "(y);\n";
+            output << "    return " << name << "EstimateCombine(adj, poly, p);\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteSlerp(std::ostream& output) const
+{
+    // The constants of ChebyshevRatio<Real>::GetEstimate<N>. The term i of
+    // the estimate of degree N = i + 1 has coefficients a[i] and b[i]
+    // multiplied by onePlusMu[i]; the other terms have a[i] = 1/(i*(2*i+1))
+    // and b[i] = i/(2*i+1) for 1-based i.
+    double const onePlusMu[16] =
+    {
+        1.62943436108234530,
+        1.73965850021313961,
+        1.79701067629566813,
+        1.83291820510335812,
+        1.85772477879039977,
+        1.87596835698904785,
+        1.88998444919711206,
+        1.90110745351730037,
+        1.91015881189952352,
+        1.91767344933047190,
+        1.92401541194159076,
+        1.92944142668012797,
+        1.93413793373091059,
+        1.93824371262559758,
+        1.94186426368404708,
+        1.94508125972497303
+    };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        double const j = static_cast<double>(i + 1);
+        output << "#define GTE_C_CHEBYSHEV_RATIO_A" << i << " " << Literal(1.0 / (j * (2.0 * j + 1.0))) << "\n";
+        output << "#define GTE_C_CHEBYSHEV_RATIO_B" << i << " " << Literal(j / (2.0 * j + 1.0)) << "\n";
+    }
+    output << "\n";
+    for (int i = 0; i < 16; ++i)
+    {
+        double const j = static_cast<double>(i + 1);
+        output << "#define GTE_C_CHEBYSHEV_RATIO_DEG" << (i + 1) << "_A "
+            << Literal(onePlusMu[i] / (j * (2.0 * j + 1.0))) << "\n";
+        output << "#define GTE_C_CHEBYSHEV_RATIO_DEG" << (i + 1) << "_B "
+            << Literal(onePlusMu[i] * j / (2.0 * j + 1.0)) << "\n";
+    }
+    output << "\n";
+
+    std::string const& Q = mQuaternionType;
+    for (int n = 1; n <= 16; ++n)
+    {
+        // Estimates f0 of f(1-t,y) and f1 of f(t,y) for f(t,y) =
+        // sin(t*A)/sin(A), t in [0,1], A in [0,pi/2] and y = 1 - cos(A).
+        std::string const N = std::to_string(n);
+        output << "void ChebyshevRatioEstimateDegree" << N
+            << "(float t, float y, out float f0, out float f1)\n{\n";
+        output << "    float term0 = 1.0 - t, term1 = t;\n";
+        output << "    float sqr0 = term0 * term0, sqr1 = term1 * term1;\n";
+        output << "    f0 = term0;\n";
+        output << "    f1 = term1;\n";
+        for (int i = 0; i < n; ++i)
+        {
+            std::string const a = (i + 1 < n ? "GTE_C_CHEBYSHEV_RATIO_A" + std::to_string(i) :
+                "GTE_C_CHEBYSHEV_RATIO_DEG" + N + "_A");
+            std::string const b = (i + 1 < n ? "GTE_C_CHEBYSHEV_RATIO_B" + std::to_string(i) :
+                "GTE_C_CHEBYSHEV_RATIO_DEG" + N + "_B");
+            output << "    term0 *= (" << b << " - " << a << " * sqr0) * y;\n";
+            output << "    term1 *= (" << b << " - " << a << " * sqr1) * y;\n";
+            output << "    f0 += term0;\n";
+            output << "    f1 += term1;\n";
+        }
+        output << "}\n\n";
+
+        // The angle between q0 and q1 is in [0,pi).
+        output << Q << " SlerpEstimateDegree" << N << "(float t, " << Q << " q0, " << Q << " q1)\n{\n";
+        output << "    float cs = dot(q0, q1);\n";
+        output << "    float sgn = (cs >= 0.0 ? 1.0 : -1.0);\n";
+        output << "    float f0, f1;\n";
+        output << "    ChebyshevRatioEstimateDegree" << N << "(t, 1.0 - sgn * cs, f0, f1);\n";
+        output << "    return q0 * f0 + q1 * (sgn * f1);\n}\n\n";
+
+        // The angle between q0 and q1 is in [0,pi/2].
+        output << Q << " SlerpEstimateRDegree" << N << "(float t, " << Q << " q0, " << Q << " q1)\n{\n";
+        output << "    float f0, f1;\n";
+        output << "    ChebyshevRatioEstimateDegree" << N << "(t, 1.0 - dot(q0, q1), f0, f1);\n";
+        output << "    return q0 * f0 + q1 * f1;\n}\n\n";
+    }
+}
+
+void ShaderEstimates::WriteRotation(std::ostream& output) const
+{
+    std::array<std::array<double, 9>, 7> const* coefficients[4] =
+    {
+        &C_ROTC0_EST_COEFF, &C_ROTC1_EST_COEFF, &C_ROTC2_EST_COEFF, &C_ROTC3_EST_COEFF
+    };
+    std::array<double, 7> const* maxErrors[4] =
+    {
+        &C_ROTC0_EST_MAX_ERROR, &C_ROTC1_EST_MAX_ERROR, &C_ROTC2_EST_MAX_ERROR, &C_ROTC3_EST_MAX_ERROR
+    };
+
+    for (int k = 0; k < 4; ++k)
+    {
+        std::string const prefix = "ROTC" + std::to_string(k);
+        for (size_t select = 0; select < 7; ++select)
+        {
+            std::string const D = std::to_string(2 * select + 4);
+            for (size_t i = 0; i <= select + 2; ++i)
+            {
+                output << "#define GTE_C_" << prefix << "_DEG" << D << "_C" << i << " "
+                    << Literal((*coefficients[k])[select][i]) << "\n";
+            }
+            output << "#define GTE_C_" << prefix << "_DEG" << D << "_MAX_ERROR "
+                << Literal((*maxErrors[k])[select]) << "\n";
+        }
+        output << "\n";
+    }
+
+    for (size_t select = 0; select < 7; ++select)
+    {
+        std::string const D = std::to_string(2 * select + 4);
+        for (int k = 0; k < 4; ++k)
+        {
+            std::string const prefix = "ROTC" + std::to_string(k);
+            Polynomial polynomial;
+            polynomial.degree = static_cast<int>(2 * select + 4);
+            polynomial.maxError = (*maxErrors[k])[select];
+            polynomial.coeff.assign((*coefficients[k])[select].begin(),
+                (*coefficients[k])[select].begin() + select + 3);
+
+            output << "float RotC" << k << "EstimateDegree" << D << "(float t)\n{\n";
+            output << "    float tsqr = t * t;\n";
+            WriteHorner(output, "float", prefix, polynomial, 0, "tsqr");
+            output << "    return poly;\n}\n\n";
+        }
+
+        // R = I + rotc0(t)*S + rotc1(t)*S^2 for t = |p| and the skew-
+        // symmetric matrix S = {{0,-p2,p1},{p2,0,-p0},{-p1,p0,0}}. The
+        // matrix multiplies column vectors: R*v in GLSL, mul(R,v) in HLSL.
+        std::string const& V = mVector3Type;
+        std::string const& M = mMatrix3Type;
+        output << M << " RotationEstimateDegree" << D << "(" << V << " p)\n{\n";
+        output << "    float t = length(p);\n";
+        output << "    float a = RotC0EstimateDegree" << D << "(t);\n";
+        output << "    float b = RotC1EstimateDegree" << D << "(t);\n";
+        output << "    float p0p0 = p.x * p.x, p0p1 = p.x * p.y, p0p2 = p.x * p.z;\n";
+        output << "    float p1p1 = p.y * p.y, p1p2 = p.y * p.z, p2p2 = p.z * p.z;\n";
+        output << "    float r00 = 1.0 - b * (p1p1 + p2p2);\n";
+        output << "    float r01 = -a * p.z + b * p0p1;\n";
+        output << "    float r02 = a * p.y + b * p0p2;\n";
+        output << "    float r10 = a * p.z + b * p0p1;\n";
+        output << "    float r11 = 1.0 - b * (p0p0 + p2p2);\n";
+        output << "    float r12 = -a * p.x + b * p1p2;\n";
+        output << "    float r20 = -a * p.y + b * p0p2;\n";
+        output << "    float r21 = a * p.x + b * p1p2;\n";
+        output << "    float r22 = 1.0 - b * (p0p0 + p1p1);\n";
+        if (mLanguage == Language::HLSL)
+        {
+            output << "    return " << M << "(r00, r01, r02, r10, r11, r12, r20, r21, r22);\n}\n\n";
+        }
+        else
+        {
+            output << "    return " << M << "(r00, r10, r20, r01, r11, r21, r02, r12, r22);\n}\n\n";
+        }
+    }
+}
+
+void ShaderEstimates::WriteConstants(std::ostream& output, std::string const& prefix, int first) const
+{
+    for (auto const& polynomial : mPolynomials.at(prefix))
+    {
+        std::string const name = "GTE_C_" + prefix + "_DEG" + std::to_string(polynomial.degree);
+        for (size_t i = 0; i < polynomial.coeff.size(); ++i)
+        {
+            output << "#define " << name << "_C" << (first + static_cast<int>(i)) << " "
+                << Literal(polynomial.coeff[i]) << "\n";
+        }
+        output << "#define " << name << "_MAX_ERROR " << Literal(polynomial.maxError) << "\n";
+    }
+    output << "\n";
+}
+
+void ShaderEstimates::WriteMathConstants(std::ostream& output) const
+{
+    output << "#ifndef GTE_C_PI\n";
+    output << "#define GTE_C_PI " << Literal(GTE_C_PI) << "\n";
+    output << "#define GTE_C_HALF_PI " << Literal(GTE_C_HALF_PI) << "\n";
+    output << "#define GTE_C_QUARTER_PI " << Literal(GTE_C_QUARTER_PI) << "\n";
+    output << "#define GTE_C_TWO_PI " << Literal(GTE_C_TWO_PI) << "\n";
+    output << "#define GTE_C_INV_TWO_PI " << Literal(GTE_C_INV_TWO_PI) << "\n";
+    output << "#define GTE_C_SQRT_2 " << Literal(GTE_C_SQRT_2) << "\n";
+    output << "#define GTE_C_INV_SQRT_2 " << Literal(GTE_C_INV_SQRT_2) << "\n";
+    output << "#endif\n\n";
+}
+
+void ShaderEstimates::WriteHorner(std::ostream& output, std::string const& type,
+    std::string const& prefix, Polynomial const& polynomial, int first,
+    std::string const& variable) const
+{
+    std::string const name = "GTE_C_" + prefix + "_DEG" + std::to_string(polynomial.degree) + "_C";
+    int i = first + static_cast<int>(polynomial.coeff.size()) - 1;
+    output << "    " << type << " poly;\n";
+    output << "    poly = " << Splat(type, name + std::to_string(i)) << ";\n";
+    while (--i >= first)
+    {
+        output << "    poly = " << name << i << " + poly * " << variable << ";\n";
+    }
+}
+
+std::string ShaderEstimates::Splat(std::string const& type, std::string const& value) const
+{
+    // HLSL converts scalars to vectors implicitly, GLSL requires a
+    // constructor.
+    if (mLanguage == Language::GLSL && type != "float")
+    {
+        return type + "(" + value + ")";
+    }
+    return value;
+}
+
+std::string ShaderEstimates::Compare(std::string const& type, std::string const& lhs,
+    std::string const& op, std::string const& rhs) const
+{
+    // The GLSL relational operators apply only to scalars. The vector
+    // comparisons are functions that return boolean vectors.
+    if (mLanguage == Language::GLSL && type != "float")
+    {
+        std::string function;
+        if (op == "<")
+        {
+            function = "lessThan";
+        }
+        else if (op == "<=")
+        {
+            function = "lessThanEqual";
+        }
+        else if (op == ">")
+        {
+            function = "greaterThan";
+        }
+        else
+        {
+            function = "greaterThanEqual";
+        }
+        return function + "(" + lhs + ", " + type + "(" + rhs + "))";
+    }
+    return "(" + lhs + " " + op + " " + rhs + ")";
+}
+
+std::string ShaderEstimates::Select(std::string const& type, std::string const& condition,
+    std::string const& ifTrue, std::string const& ifFalse) const
+{
+    // The HLSL conditional operator is componentwise for vectors. For GLSL
+    // vectors, mix with a boolean vector selects the components.
+    if (mLanguage == Language::GLSL && type != "float")
+    {
+        return "mix(" + ifFalse + ", " + ifTrue + ", " + condition + ")";
+    }
+    return "(" + condition + " ? " + ifTrue + " : " + ifFalse + ")";
+}
+
+void ShaderEstimates::WriteFrExp(std::ostream& output, std::string const& type, size_t i,
+    std::string const& y, std::string const& x, std::string const& p, bool declare) const
+{
+    // The HLSL exponent has the type of x, the GLSL exponent is an integer.
+    std::string const prefix = (declare ? type + " " : "");
+    if (mLanguage == Language::HLSL)
+    {
+        if (declare)
+        {
+            output << "    " << type << " " << p << ";\n";
+        }
+        output << "    " << prefix << y << " = frexp(" << x << ", " << p << ");\n";
+    }
+    else
+    {
+        output << "    " << mIntTypes[i] << " exponent;\n";
+        output << "    " << prefix << y << " = frexp(" << x << ", exponent);\n";
+        output << "    " << prefix << p << " = " << type << "(exponent);\n";
+    }
+}
+
+std::string ShaderEstimates::LdExp(size_t i, std::string const& y, std::string const& p) const
+{
+    if (mLanguage == Language::HLSL)
+    {
+        return "ldexp(" + y + ", " + p + ")";
+    }
+    return "ldexp(" + y + ", " + mIntTypes[i] + "(" + p + "))";
+}
+
+std::string ShaderEstimates::Literal(double value)
+{
+    std::ostringstream stream;
+    stream << std::showpos << std::scientific << std::setprecision(17) << value;
+    return stream.str();
+}
@@ -0,0 +1,188 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include <Graphics/MeshFileIO.h>
+#include <Mathematics/Logger.h>
+#include <Mathematics/LogToStdout.h>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+using namespace gte;
+
+// Convert a raw mesh of the sample data to the format of MeshFileIO. The
+// raw files, such as Samples/Data/Brain_V4098_T8192.binary, store the
+// vertices as 32-bit floating-point attributes followed by the 32-bit
+// unsigned indices of the triangles, with the counts encoded only in the
+// file names. The converted file is loaded without parsing by
+// MeshFileIO::Load.
+//
+// MeshConverter input output layout numVertices numTriangles
+//
+// The layout is a comma-separated list of attributes, each a semantic
+// letter and the number of channels: p (position), n (normal), t (texture
+// coordinate), c (color). For example, the brain mesh has layout "p3",
+// and a mesh with positions, normals and texture coordinates has layout
+// "p3,n3,t2". The texture coordinates and colors are assigned units in
+// the order they occur. A numTriangles of 0 converts a point set without
+// indices.
+
+namespace
+{
+    bool ParseLayout(std::string const& layout, VertexFormat& vformat)
+    {
+        DFType const types[4] =
+        {
+            DF_R32_FLOAT,
+            DF_R32G32_FLOAT,
+            DF_R32G32B32_FLOAT,
+            DF_R32G32B32A32_FLOAT
+        };
+
+        unsigned int tcoordUnit = 0, colorUnit = 0;
+        std::istringstream stream(layout);
+        std::string token;
+        while (std::getline(stream, token, ','))
+        {
+            if (token.size() != 2 || token[1] < '1' || token[1] > '4')
+            {
+                return false;
+            }
+
+            DFType type = types[token[1] - '1'];
+            switch (token[0])
+            {
+            case 'p':
+                vformat.Bind(VA_POSITION, type, 0);
+                break;
+            case 'n':
+                vformat.Bind(VA_NORMAL, type, 0);
+                break;
+            case 't':
+                vformat.Bind(VA_TEXCOORD, type, tcoordUnit++);
+                break;
+            case 'c':
+                vformat.Bind(VA_COLOR, type, colorUnit++);
+                break;
+            default:
+                return false;
+            }
+        }
+        return vformat.GetNumAttributes() > 0;
+    }
+}
+
+int main(int numArguments, char const* arguments[])
+{
+    // MeshFileIO reports its failures as warnings.
+    auto logToStdout = std::make_unique<LogToStdout>(
+        Logger::Listener::LISTEN_FOR_ALL);
+    Logger::Subscribe(logToStdout.get());
+
+    if (numArguments != 6)
+    {
+        std::cout << "usage: MeshConverter input output layout numVertices numTriangles" << std::endl;
+        std::cout << "example: MeshConverter Brain_V4098_T8192.binary Brain.gtemesh p3 4098 8192" << std::endl;
+        return 1;
+    }
+
+    std::string const input = arguments[1];
+    std::string const output = arguments[2];
+    VertexFormat vformat;
+    if (!ParseLayout(arguments[3], vformat))
+    {
+        std::cout << "Invalid layout " << arguments[3] << "." << std::endl;
+        return 1;
+    }
+
+    unsigned int const numVertices = static_cast<unsigned int>(std::strtoul(arguments[4], nullptr, 10));
+    uint32_t const numTriangles = static_cast<uint32_t>(std::strtoul(arguments[5], nullptr, 10));
+    if (numVertices == 0)
+    {
+        std::cout << "The number of vertices must be positive." << std::endl;
+        return 1;
+    }
+
+    auto vbuffer = std::make_shared<VertexBuffer>(vformat, numVertices);
+    std::shared_ptr<IndexBuffer> ibuffer;
+    if (numTriangles > 0)
+    {
+        ibuffer = std::make_shared<IndexBuffer>(IP_TRIMESH, numTriangles, sizeof(uint32_t));
+    }
+    else
+    {
+        ibuffer = std::make_shared<IndexBuffer>(IP_POLYPOINT, numVertices);
+    }
+
+    std::ifstream inFile(input, std::ios::in | std::ios::binary);
+    if (!inFile)
+    {
+        std::cout << "Cannot open " << input << "." << std::endl;
+        return 1;
+    }
+
+    // The file size must match the counts exactly, which catches a layout
+    // that does not match the data.
+    inFile.seekg(0, std::ios::end);
+    uint64_t const size = static_cast<uint64_t>(inFile.tellg());
+    inFile.seekg(0, std::ios::beg);
+    uint64_t const vertexBytes = vbuffer->GetNumBytes();
+    uint64_t const indexBytes = (ibuffer->GetData() ? ibuffer->GetNumBytes() : 0);
+    if (size != vertexBytes + indexBytes)
+    {
+        std::cout << "The file " << input << " has " << size << " bytes, but the layout and counts require "
+            << vertexBytes + indexBytes << " bytes." << std::endl;
+        return 1;
+    }
+
+    inFile.read(vbuffer->GetData(), static_cast<std::streamsize>(vertexBytes));
+    if (indexBytes > 0)
+    {
+        inFile.read(ibuffer->GetData(), static_cast<std::streamsize>(indexBytes));
+    }
+    if (inFile.fail())
+    {
+        std::cout << "Cannot read " << input << "." << std::endl;
+        return 1;
+    }
+    inFile.close();
+
+    if (indexBytes > 0)
+    {
+        uint32_t const* indices = ibuffer->Get<uint32_t>();
+        for (uint32_t i = 0; i < ibuffer->GetNumElements(); ++i)
+        {
+            if (indices[i] >= numVertices)
+            {
+                std::cout << "Index " << indices[i] << " is out of range." << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    if (!MeshFileIO::Save(output, *vbuffer, *ibuffer))
+    {
+        return 1;
+    }
+
+    // Verify the file by loading it as the applications do.
+    std::shared_ptr<VertexBuffer> loadedVBuffer;
+    std::shared_ptr<IndexBuffer> loadedIBuffer;
+    if (!MeshFileIO::Load(output, loadedVBuffer, loadedIBuffer))
+    {
+        return 1;
+    }
+
+    std::cout << "Converted " << numVertices << " vertices and " << numTriangles
+        << " triangles to " << output << "." << std::endl;
+
+    Logger::Unsubscribe(logToStdout.get());
+    return 0;
+}
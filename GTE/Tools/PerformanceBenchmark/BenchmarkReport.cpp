@@ -0,0 +1,465 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include "BenchmarkReport.h"
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+
+namespace
+{
+    // The subset of JSON needed to read a report: objects, arrays, strings
+    // without \u escapes, numbers, true, false and null.
+    struct JsonValue
+    {
+        enum Kind { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+        JsonValue()
+            :
+            kind(NUL),
+            number(0.0)
+        {
+        }
+
+        JsonValue const* Find(std::string const& key) const
+        {
+            for (auto const& member : members)
+            {
+                if (member.first == key)
+                {
+                    return member.second.get();
+                }
+            }
+            return nullptr;
+        }
+
+        Kind kind;
+        double number;
+        std::string text;
+        std::vector<std::unique_ptr<JsonValue>> elements;
+        std::vector<std::pair<std::string, std::unique_ptr<JsonValue>>> members;
+    };
+
+    class JsonParser
+    {
+    public:
+        JsonParser(std::string const& text)
+            :
+            mText(text),
+            mPosition(0)
+        {
+        }
+
+        // Parse the text, which must be a single JSON value.
+        bool Parse(JsonValue& value)
+        {
+            if (!ParseValue(value))
+            {
+                return false;
+            }
+            SkipSpace();
+            return mPosition == mText.size();
+        }
+
+        inline size_t GetPosition() const
+        {
+            return mPosition;
+        }
+
+    private:
+        void SkipSpace()
+        {
+            while (mPosition < mText.size() && std::isspace(static_cast<unsigned char>(mText[mPosition])))
+            {
+                ++mPosition;
+            }
+        }
+
+        bool Match(char c)
+        {
+            SkipSpace();
+            if (mPosition < mText.size() && mText[mPosition] == c)
+            {
+                ++mPosition;
+                return true;
+            }
+            return false;
+        }
+
+        bool MatchWord(char const* word)
+        {
+            size_t const length = std::char_traits<char>::length(word);
+            if (mText.compare(mPosition, length, word) == 0)
+            {
+                mPosition += length;
+                return true;
+            }
+            return false;
+        }
+
+        bool ParseString(std::string& text)
+        {
+            if (!Match('"'))
+            {
+                return false;
+            }
+            text.clear();
+            while (mPosition < mText.size())
+            {
+                char c = mText[mPosition++];
+                if (c == '"')
+                {
+                    return true;
+                }
+                if (c == '\\')
+                {
+                    if (mPosition == mText.size())
+                    {
+                        return false;
+                    }
+                    c = mText[mPosition++];
+                    switch (c)
+                    {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case '"': case '\\': case '/': break;
+                    default: return false;
+                    }
+                }
+                text.push_back(c);
+            }
+            return false;
+        }
+
+        bool ParseValue(JsonValue& value)
+        {
+            SkipSpace();
+            if (mPosition == mText.size())
+            {
+                return false;
+            }
+
+            char const c = mText[mPosition];
+            if (c == '{')
+            {
+                ++mPosition;
+                value.kind = JsonValue::OBJECT;
+                if (Match('}'))
+                {
+                    return true;
+                }
+                do
+                {
+                    std::string key;
+                    auto member = std::make_unique<JsonValue>();
+                    if (!ParseString(key) || !Match(':') || !ParseValue(*member))
+                    {
+                        return false;
+                    }
+                    value.members.emplace_back(key, std::move(member));
+                } while (Match(','));
+                return Match('}');
+            }
+
+            if (c == '[')
+            {
+                ++mPosition;
+                value.kind = JsonValue::ARRAY;
+                if (Match(']'))
+                {
+                    return true;
+                }
+                do
+                {
+                    auto element = std::make_unique<JsonValue>();
+                    if (!ParseValue(*element))
+                    {
+                        return false;
+                    }
+                    value.elements.push_back(std::move(element));
+                } while (Match(','));
+                return Match(']');
+            }
+
+            if (c == '"')
+            {
+                value.kind = JsonValue::STRING;
+                return ParseString(value.text);
+            }
+
+            if (MatchWord("true") || MatchWord("false"))
+            {
+                value.kind = JsonValue::BOOLEAN;
+                value.number = (c == 't' ? 1.0 : 0.0);
+                return true;
+            }
+
+            if (MatchWord("null"))
+            {
+                value.kind = JsonValue::NUL;
+                return true;
+            }
+
+            char const* begin = mText.c_str() + mPosition;
+            char* end = nullptr;
+            value.number = std::strtod(begin, &end);
+            if (end == begin)
+            {
+                return false;
+            }
+            value.kind = JsonValue::NUMBER;
+            value.text.assign(begin, static_cast<size_t>(end - begin));
+            mPosition += static_cast<size_t>(end - begin);
+            return true;
+        }
+
+        std::string const& mText;
+        size_t mPosition;
+    };
+
+    void WriteString(std::ostream& output, std::string const& text)
+    {
+        output << '"';
+        for (auto c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                output << '\\' << c;
+            }
+            else if (c == '\n')
+            {
+                output << "\\n";
+            }
+            else
+            {
+                output << c;
+            }
+        }
+        output << '"';
+    }
+}
+
+BenchmarkReport::Result::Result()
+    :
+    category{},
+    name{},
+    type{},
+    dataset{},
+    threads(1),
+    size(0),
+    repetitions(0),
+    minNs(0.0),
+    meanNs(0.0),
+    checksum(0)
+{
+}
+
+std::string BenchmarkReport::Result::GetKey() const
+{
+    return category + "/" + name + "/" + type + "/" + dataset + "/" + std::to_string(threads);
+}
+
+void BenchmarkReport::AddConfiguration(std::string const& key, std::string const& value)
+{
+    mConfiguration.emplace_back(key, value);
+}
+
+void BenchmarkReport::AddResult(Result const& result)
+{
+    mResults.push_back(result);
+}
+
+void BenchmarkReport::Write(std::ostream& output) const
+{
+    output << std::setprecision(6);
+    output << "{" << std::endl;
+    output << "  \"benchmark\": \"PerformanceBenchmark\"," << std::endl;
+    output << "  \"configuration\": {";
+    for (size_t i = 0; i < mConfiguration.size(); ++i)
+    {
+        output << (i > 0 ? ", " : " ");
+        WriteString(output, mConfiguration[i].first);
+        output << ": ";
+        WriteString(output, mConfiguration[i].second);
+    }
+    output << " }," << std::endl;
+    output << "  \"results\": [" << std::endl;
+    for (size_t i = 0; i < mResults.size(); ++i)
+    {
+        Result const& r = mResults[i];
+        output << "    { \"category\": ";
+        WriteString(output, r.category);
+        output << ", \"name\": ";
+        WriteString(output, r.name);
+        output << ", \"type\": ";
+        WriteString(output, r.type);
+        output << ", \"dataset\": ";
+        WriteString(output, r.dataset);
+        output << ", \"threads\": " << r.threads
+            << ", \"size\": " << r.size
+            << ", \"repetitions\": " << r.repetitions
+            << ", \"min_ns\": " << r.minNs
+            << ", \"mean_ns\": " << r.meanNs
+            << ", \"checksum\": " << r.checksum
+            << " }" << (i + 1 < mResults.size() ? "," : "") << std::endl;
+    }
+    output << "  ]" << std::endl;
+    output << "}" << std::endl;
+}
+
+bool BenchmarkReport::Read(std::string const& filename, std::string& error)
+{
+    std::ifstream input(filename);
+    if (!input)
+    {
+        error = "Cannot open " + filename;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    std::string const text = buffer.str();
+
+    JsonValue root;
+    JsonParser parser(text);
+    if (!parser.Parse(root))
+    {
+        error = filename + " is not valid JSON (offset " + std::to_string(parser.GetPosition()) + ")";
+        return false;
+    }
+
+    JsonValue const* results = (root.kind == JsonValue::OBJECT ? root.Find("results") : nullptr);
+    if (!results || results->kind != JsonValue::ARRAY)
+    {
+        error = filename + " does not have a results array";
+        return false;
+    }
+
+    mConfiguration.clear();
+    JsonValue const* configuration = root.Find("configuration");
+    if (configuration && configuration->kind == JsonValue::OBJECT)
+    {
+        for (auto const& member : configuration->members)
+        {
+            mConfiguration.emplace_back(member.first, member.second->text);
+        }
+    }
+
+    mResults.clear();
+    for (auto const& element : results->elements)
+    {
+        auto getString = [&element](char const* key, std::string& value)
+        {
+            JsonValue const* member = element->Find(key);
+            if (member && member->kind == JsonValue::STRING)
+            {
+                value = member->text;
+                return true;
+            }
+            return false;
+        };
+
+        auto getNumber = [&element](char const* key, double& value, std::string* text)
+        {
+            JsonValue const* member = element->Find(key);
+            if (member && member->kind == JsonValue::NUMBER)
+            {
+                value = member->number;
+                if (text)
+                {
+                    *text = member->text;
+                }
+                return true;
+            }
+            return false;
+        };
+
+        Result r;
+        double threads = 1.0, size = 0.0, repetitions = 0.0, checksum = 0.0;
+        std::string checksumText;
+        if (element->kind != JsonValue::OBJECT
+            || !getString("category", r.category) || !getString("name", r.name)
+            || !getString("type", r.type) || !getString("dataset", r.dataset)
+            || !getNumber("min_ns", r.minNs, nullptr))
+        {
+            error = filename + " has a result without category, name, type, dataset or min_ns";
+            return false;
+        }
+        getNumber("threads", threads, nullptr);
+        getNumber("size", size, nullptr);
+        getNumber("repetitions", repetitions, nullptr);
+        getNumber("mean_ns", r.meanNs, nullptr);
+        if (getNumber("checksum", checksum, &checksumText))
+        {
+            // The checksum can exceed the 53-bit precision of double.
+            r.checksum = std::strtoll(checksumText.c_str(), nullptr, 10);
+        }
+        r.threads = static_cast<size_t>(threads);
+        r.size = static_cast<size_t>(size);
+        r.repetitions = static_cast<int>(repetitions);
+        mResults.push_back(r);
+    }
+    return true;
+}
+
+size_t BenchmarkReport::Compare(BenchmarkReport const& baseline, double tolerance,
+    std::ostream& output) const
+{
+    std::map<std::string, Result const*> baselineResults;
+    for (auto const& r : baseline.mResults)
+    {
+        baselineResults[r.GetKey()] = &r;
+    }
+
+    size_t numRegressions = 0, numCompared = 0;
+    output << std::fixed;
+    output << std::setw(12) << "baseline_ns" << std::setw(12) << "current_ns"
+        << std::setw(8) << "ratio" << "  benchmark" << std::endl;
+    for (auto const& r : mResults)
+    {
+        std::string const key = r.GetKey();
+        auto iter = baselineResults.find(key);
+        if (iter == baselineResults.end())
+        {
+            output << std::setw(12) << "-" << std::setw(12) << std::setprecision(2) << r.minNs
+                << std::setw(8) << "-" << "  " << key << " (new)" << std::endl;
+            continue;
+        }
+
+        Result const& b = *iter->second;
+        double const ratio = (b.minNs > 0.0 ? r.minNs / b.minNs : 1.0);
+        bool const regression = (ratio > 1.0 + tolerance);
+        numRegressions += (regression ? 1 : 0);
+        ++numCompared;
+        output << std::setw(12) << std::setprecision(2) << b.minNs
+            << std::setw(12) << r.minNs
+            << std::setw(8) << std::setprecision(3) << ratio << "  " << key;
+        if (regression)
+        {
+            output << " (slower)";
+        }
+        if (r.size == b.size && r.checksum != b.checksum)
+        {
+            output << " (checksum differs)";
+        }
+        output << std::endl;
+        baselineResults.erase(iter);
+    }
+
+    output << numCompared << " compared, " << numRegressions
+        << " slower than the baseline by more than " << std::setprecision(0)
+        << 100.0 * tolerance << "%, " << baselineResults.size()
+        << " of the baseline not run" << std::endl;
+    output << std::defaultfloat << std::setprecision(6);
+    return numRegressions;
+}
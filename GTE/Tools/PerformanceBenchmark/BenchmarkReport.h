@@ -0,0 +1,79 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// The results of a PerformanceBenchmark run and their comparison with the
+// results of a previous run. A report is written as a JSON object,
+//   {
+//     "benchmark": "PerformanceBenchmark",
+//     "configuration": { "build": ..., "simd": ..., "graphics": ...,
+//       "repetitions": ..., "scale": ..., "threads": ... },
+//     "results": [
+//       { "category": ..., "name": ..., "type": ..., "dataset": ...,
+//         "threads": ..., "size": ..., "repetitions": ..., "min_ns": ...,
+//         "mean_ns": ..., "checksum": ... },
+//       ...
+//     ]
+//   }
+// with one result per line. A result is identified by its category, name,
+// type, dataset and number of threads. Read accepts any JSON file with this
+// layout, for example one reformatted by another tool, and ignores members
+// it does not know.
+
+class BenchmarkReport
+{
+public:
+    struct Result
+    {
+        Result();
+
+        // The identifier category/name/type/dataset/threads.
+        std::string GetKey() const;
+
+        std::string category, name, type, dataset;
+        size_t threads, size;
+        int repetitions;
+        double minNs, meanNs;
+        int64_t checksum;
+    };
+
+    // The configuration members are written as strings in the order of
+    // their insertion.
+    void AddConfiguration(std::string const& key, std::string const& value);
+    void AddResult(Result const& result);
+
+    inline std::vector<Result> const& GetResults() const
+    {
+        return mResults;
+    }
+
+    void Write(std::ostream& output) const;
+
+    // Read the results of a report written by Write. The function returns
+    // false and sets 'error' when the file cannot be read or is not such a
+    // report.
+    bool Read(std::string const& filename, std::string& error);
+
+    // Compare the results with those of a baseline report. The comparison
+    // table lists the minimum times of the results and, for those that are
+    // in both reports, their ratio current/baseline. A result is a regression
+    // when the ratio exceeds 1 + tolerance. A different checksum means
+    // that the results of the computation changed, which is also listed.
+    // The function returns the number of regressions.
+    size_t Compare(BenchmarkReport const& baseline, double tolerance,
+        std::ostream& output) const;
+
+private:
+    std::vector<std::pair<std::string, std::string>> mConfiguration;
+    std::vector<Result> mResults;
+};
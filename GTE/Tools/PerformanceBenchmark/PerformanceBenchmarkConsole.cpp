@@ -0,0 +1,836 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include "PerformanceBenchmarkConsole.h"
+#include <Graphics/ConstantColorEffect.h>
+#include <Graphics/DrawTarget.h>
+#include <Graphics/MeshFactory.h>
+#include <Mathematics/ArbitraryPrecision.h>
+#include <Mathematics/ConvexHull3.h>
+#include <Mathematics/Delaunay2.h>
+#include <Mathematics/Delaunay3.h>
+#include <Mathematics/DistPoint3Batch.h>
+#include <Mathematics/DistPointTriangle.h>
+#include <Mathematics/ImageUtility3.h>
+#include <Mathematics/IntrAlignedBox3AlignedBox3.h>
+#include <Mathematics/IntrOrientedBox3OrientedBox3.h>
+#include <Mathematics/IntrRay3Batch.h>
+#include <Mathematics/IntrRay3Triangle3.h>
+#include <Mathematics/IntrTriangle3Triangle3.h>
+#include <Mathematics/NearestNeighborQuery.h>
+#include <Mathematics/PrimalQuery2.h>
+#include <Mathematics/PrimalQuery3.h>
+#include <Mathematics/SurfaceExtractorMC.h>
+#include <Mathematics/TaskScheduler.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    char const* const gsDatasets[3] = { "uniform", "clustered", "degenerate" };
+}
+
+PerformanceBenchmarkConsole::Options::Options()
+    :
+    repetitions(5),
+    scale(1),
+    threads(std::max(std::thread::hardware_concurrency(), 1u)),
+    filter{},
+    output{},
+    baseline{},
+    tolerance(0.1)
+{
+}
+
+PerformanceBenchmarkConsole::PerformanceBenchmarkConsole(Parameters& parameters)
+    :
+    Console(parameters),
+    mStatus(0)
+{
+}
+
+void PerformanceBenchmarkConsole::Execute()
+{
+    std::ofstream file;
+    if (!mOptions.output.empty())
+    {
+        file.open(mOptions.output);
+        if (!file)
+        {
+            std::cerr << "Cannot open " << mOptions.output << std::endl;
+            mStatus = 1;
+            return;
+        }
+    }
+    std::ostream& output = (file.is_open() ? file : std::cout);
+
+    BenchmarkReport baseline;
+    if (!mOptions.baseline.empty())
+    {
+        std::string error;
+        if (!baseline.Read(mOptions.baseline, error))
+        {
+            std::cerr << error << std::endl;
+            mStatus = 1;
+            return;
+        }
+    }
+
+#if defined(NDEBUG)
+    mReport.AddConfiguration("build", "release");
+#else
+    mReport.AddConfiguration("build", "debug");
+#endif
+#if defined(GTE_USE_SIMD)
+    mReport.AddConfiguration("simd", "on");
+#else
+    mReport.AddConfiguration("simd", "off");
+#endif
+#if defined(GTE_USE_DIRECTX)
+    mReport.AddConfiguration("graphics", mEngine ? "DX11" : "none");
+#else
+    mReport.AddConfiguration("graphics", mEngine ? "GL45" : "none");
+#endif
+    mReport.AddConfiguration("repetitions", std::to_string(mOptions.repetitions));
+    mReport.AddConfiguration("scale", std::to_string(mOptions.scale));
+    mReport.AddConfiguration("threads", std::to_string(mOptions.threads));
+
+    try
+    {
+        Queries();
+        Predicates();
+        Algorithms();
+        Images();
+        Neighbors();
+        Graphics();
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << std::endl;
+        mStatus = 2;
+    }
+
+    mReport.Write(output);
+
+    if (mStatus == 0 && !mOptions.baseline.empty())
+    {
+        if (mReport.Compare(baseline, mOptions.tolerance, std::cerr) > 0)
+        {
+            mStatus = 3;
+        }
+    }
+}
+
+void PerformanceBenchmarkConsole::Run(std::string const& category, std::string const& name,
+    std::string const& type, std::string const& dataset, size_t threads, size_t size,
+    std::function<int64_t()> const& function)
+{
+    if (!mOptions.filter.empty() &&
+        (category + "/" + name).find(mOptions.filter) == std::string::npos)
+    {
+        return;
+    }
+
+    int64_t checksum = function();
+    double minTime = std::numeric_limits<double>::max();
+    double sumTime = 0.0;
+    for (int r = 0; r < mOptions.repetitions; ++r)
+    {
+        auto start = std::chrono::steady_clock::now();
+        int64_t result = function();
+        auto final = std::chrono::steady_clock::now();
+        LogAssert(result == checksum, "The results of " + name + " are not reproducible.");
+        double time = std::chrono::duration<double, std::nano>(final - start).count() /
+            static_cast<double>(std::max(size, static_cast<size_t>(1)));
+        minTime = std::min(minTime, time);
+        sumTime += time;
+    }
+
+    BenchmarkReport::Result result;
+    result.category = category;
+    result.name = name;
+    result.type = type;
+    result.dataset = dataset;
+    result.threads = threads;
+    result.size = size;
+    result.repetitions = mOptions.repetitions;
+    result.minNs = minTime;
+    result.meanNs = sumTime / static_cast<double>(mOptions.repetitions);
+    result.checksum = checksum;
+    mReport.AddResult(result);
+}
+
+double PerformanceBenchmarkConsole::Uniform(std::mt19937& mte)
+{
+    // The 32-bit outputs are exactly representable by double.
+    return static_cast<double>(mte()) / 2147483648.0 - 1.0;
+}
+
+std::vector<Vector2<double>> PerformanceBenchmarkConsole::Generate2(int dataset, size_t size)
+{
+    std::mt19937 mte(1234567u + static_cast<unsigned int>(dataset));
+    std::vector<Vector2<double>> points(size);
+    if (dataset == 0)
+    {
+        for (auto& p : points)
+        {
+            p[0] = Uniform(mte);
+            p[1] = Uniform(mte);
+        }
+    }
+    else if (dataset == 1)
+    {
+        std::array<Vector2<double>, 16> centers;
+        for (auto& c : centers)
+        {
+            c[0] = Uniform(mte);
+            c[1] = Uniform(mte);
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            Vector2<double> const& c = centers[i % centers.size()];
+            points[i][0] = c[0] + 0.001 * Uniform(mte);
+            points[i][1] = c[1] + 0.001 * Uniform(mte);
+        }
+    }
+    else
+    {
+        // The points of a k-by-k grid in a random order. The shuffle is
+        // written out, because the algorithm of std::shuffle is not
+        // specified by the standard.
+        size_t const k = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(size))));
+        for (size_t i = 0; i < size; ++i)
+        {
+            points[i] = { static_cast<double>(i % k), static_cast<double>(i / k) };
+        }
+        for (size_t i = size; i > 1; --i)
+        {
+            std::swap(points[i - 1], points[mte() % i]);
+        }
+    }
+    return points;
+}
+
+std::vector<Vector3<double>> PerformanceBenchmarkConsole::Generate3(int dataset, size_t size)
+{
+    std::mt19937 mte(7654321u + static_cast<unsigned int>(dataset));
+    std::vector<Vector3<double>> points(size);
+    if (dataset == 0)
+    {
+        for (auto& p : points)
+        {
+            p[0] = Uniform(mte);
+            p[1] = Uniform(mte);
+            p[2] = Uniform(mte);
+        }
+    }
+    else if (dataset == 1)
+    {
+        std::array<Vector3<double>, 16> centers;
+        for (auto& c : centers)
+        {
+            c[0] = Uniform(mte);
+            c[1] = Uniform(mte);
+            c[2] = Uniform(mte);
+        }
+        for (size_t i = 0; i < size; ++i)
+        {
+            Vector3<double> const& c = centers[i % centers.size()];
+            points[i][0] = c[0] + 0.001 * Uniform(mte);
+            points[i][1] = c[1] + 0.001 * Uniform(mte);
+            points[i][2] = c[2] + 0.001 * Uniform(mte);
+        }
+    }
+    else
+    {
+        size_t const k = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(size))));
+        for (size_t i = 0; i < size; ++i)
+        {
+            points[i] =
+            {
+                static_cast<double>(i % k),
+                static_cast<double>((i / k) % k),
+                static_cast<double>(i / (k * k))
+            };
+        }
+        for (size_t i = size; i > 1; --i)
+        {
+            std::swap(points[i - 1], points[mte() % i]);
+        }
+    }
+    return points;
+}
+
+void PerformanceBenchmarkConsole::Queries()
+{
+    size_t const numPairs = 65536 * static_cast<size_t>(mOptions.scale);
+    std::mt19937 mte(2468u);
+
+    // Many points with one triangle.
+    auto const points = Generate3(0, numPairs);
+    Triangle3<double> const triangle(
+        Vector3<double>{ -0.5, -0.5, 0.0 },
+        Vector3<double>{ 0.5, -0.5, 0.1 },
+        Vector3<double>{ 0.0, 0.5, -0.1 });
+    double const nearDistance = 0.25;
+
+    Run("query", "DCPQuery<Vector3,Triangle3>", "double", "uniform", 1, numPairs,
+        [&points, &triangle, nearDistance]()
+        {
+            DCPQuery<double, Vector3<double>, Triangle3<double>> query;
+            int64_t checksum = 0;
+            for (auto const& p : points)
+            {
+                checksum += (query(p, triangle).distance < nearDistance ? 1 : 0);
+            }
+            return checksum;
+        });
+
+    std::array<std::vector<double>, 3> coordinates;
+    for (int j = 0; j < 3; ++j)
+    {
+        coordinates[j].resize(numPairs);
+        for (size_t i = 0; i < numPairs; ++i)
+        {
+            coordinates[j][i] = points[i][j];
+        }
+    }
+    PointCloudView<3, double> const pointView(numPairs,
+        { coordinates[0].data(), coordinates[1].data(), coordinates[2].data() });
+    std::vector<double> distance(numPairs);
+    for (size_t threads : { static_cast<size_t>(1), mOptions.threads })
+    {
+        std::unique_ptr<TaskScheduler> scheduler;
+        if (threads > 1)
+        {
+            scheduler = std::make_unique<TaskScheduler>(threads);
+        }
+        Run("query", "DistPoint3Batch::Distance<Triangle3>", "double", "uniform", threads, numPairs,
+            [&pointView, &triangle, &distance, &scheduler, nearDistance]()
+            {
+                DistPoint3Batch<double>::Distance(pointView, triangle, distance.data(), scheduler.get());
+                return static_cast<int64_t>(std::count_if(distance.begin(), distance.end(),
+                    [nearDistance](double d) { return d < nearDistance; }));
+            });
+        if (mOptions.threads == 1)
+        {
+            break;
+        }
+    }
+
+    // One ray with many triangles.
+    std::vector<Triangle3<double>> triangles(numPairs);
+    std::array<std::vector<double>, 9> vertices;
+    for (auto& v : vertices)
+    {
+        v.resize(numPairs);
+    }
+    for (size_t i = 0; i < numPairs; ++i)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                double value = Uniform(mte);
+                triangles[i].v[k][j] = value;
+                vertices[3 * k + j][i] = value;
+            }
+        }
+    }
+    Ray3<double> ray(Vector3<double>{ -2.0, 0.1, 0.2 }, Vector3<double>{ 1.0, 0.01, 0.02 });
+    Normalize(ray.direction);
+
+    Run("query", "FIQuery<Ray3,Triangle3>", "double", "uniform", 1, numPairs,
+        [&ray, &triangles]()
+        {
+            FIQuery<double, Ray3<double>, Triangle3<double>> query;
+            int64_t checksum = 0;
+            for (auto const& t : triangles)
+            {
+                checksum += (query(ray, t).intersect ? 1 : 0);
+            }
+            return checksum;
+        });
+
+    std::array<PointCloudView<3, double>, 3> triangleViews;
+    for (int k = 0; k < 3; ++k)
+    {
+        triangleViews[k] = PointCloudView<3, double>(numPairs,
+            { vertices[3 * k].data(), vertices[3 * k + 1].data(), vertices[3 * k + 2].data() });
+    }
+    std::vector<uint8_t> intersect(numPairs);
+    std::vector<double> parameter(numPairs), bary1(numPairs), bary2(numPairs);
+    Run("query", "IntrRay3Batch::FindTriangles", "double", "uniform", 1, numPairs,
+        [&]()
+        {
+            IntrRay3Batch<double>::FindTriangles(ray, triangleViews[0], triangleViews[1],
+                triangleViews[2], intersect.data(), parameter.data(), bary1.data(), bary2.data());
+            return static_cast<int64_t>(std::count(intersect.begin(), intersect.end(), 1));
+        });
+
+    // Pairs of objects 2*i and 2*i+1 whose centers differ by at most
+    // twice the largest extent in each coordinate, so that a fraction of
+    // the pairs intersect.
+    auto const centers = Generate3(0, numPairs);
+    double const extent = 0.05;
+    std::vector<AlignedBox3<double>> alignedBoxes(2 * numPairs);
+    std::vector<OrientedBox3<double>> orientedBoxes(2 * numPairs);
+    std::vector<Triangle3<double>> smallTriangles(2 * numPairs);
+    for (size_t i = 0; i < 2 * numPairs; ++i)
+    {
+        Vector3<double> center = centers[i / 2];
+        if (i % 2 == 1)
+        {
+            center += Vector3<double>{ 2.0 * extent * Uniform(mte),
+                2.0 * extent * Uniform(mte), 2.0 * extent * Uniform(mte) };
+        }
+
+        Vector3<double> e{ extent * (0.5 + 0.5 * Uniform(mte)),
+            extent * (0.5 + 0.5 * Uniform(mte)), extent * (0.5 + 0.5 * Uniform(mte)) };
+        alignedBoxes[i] = AlignedBox3<double>(center - e, center + e);
+
+        OrientedBox3<double>& box = orientedBoxes[i];
+        box.center = center;
+        box.axis[0] = { Uniform(mte), Uniform(mte), 1.5 };
+        ComputeOrthogonalComplement(1, box.axis.data());
+        box.extent = e;
+
+        for (int k = 0; k < 3; ++k)
+        {
+            smallTriangles[i].v[k] = center + Vector3<double>{ 2.0 * extent * Uniform(mte),
+                2.0 * extent * Uniform(mte), 2.0 * extent * Uniform(mte) };
+        }
+    }
+
+    Run("query", "TIQuery<AlignedBox3,AlignedBox3>", "double", "uniform", 1, numPairs,
+        [&alignedBoxes, numPairs]()
+        {
+            TIQuery<double, AlignedBox3<double>, AlignedBox3<double>> query;
+            int64_t checksum = 0;
+            for (size_t i = 0; i < numPairs; ++i)
+            {
+                checksum += (query(alignedBoxes[2 * i], alignedBoxes[2 * i + 1]).intersect ? 1 : 0);
+            }
+            return checksum;
+        });
+
+    Run("query", "TIQuery<OrientedBox3,OrientedBox3>", "double", "uniform", 1, numPairs,
+        [&orientedBoxes, numPairs]()
+        {
+            TIQuery<double, OrientedBox3<double>, OrientedBox3<double>> query;
+            int64_t checksum = 0;
+            for (size_t i = 0; i < numPairs; ++i)
+            {
+                checksum += (query(orientedBoxes[2 * i], orientedBoxes[2 * i + 1]).intersect ? 1 : 0);
+            }
+            return checksum;
+        });
+
+    Run("query", "TIQuery<Triangle3,Triangle3>", "double", "uniform", 1, numPairs,
+        [&smallTriangles, numPairs]()
+        {
+            TIQuery<double, Triangle3<double>, Triangle3<double>> query;
+            int64_t checksum = 0;
+            for (size_t i = 0; i < numPairs; ++i)
+            {
+                checksum += (query(smallTriangles[2 * i], smallTriangles[2 * i + 1]).intersect ? 1 : 0);
+            }
+            return checksum;
+        });
+}
+
+void PerformanceBenchmarkConsole::Predicates()
+{
+    // The predicates of the exact algorithms for arbitrary-precision
+    // BSNumber. ExactPredicateBenchmark has the timings of the other
+    // number types and of the conversions.
+    typedef BSNumber<UIntegerAP32> Number;
+    size_t const numPoints = 1024;
+    size_t const numTuples = 4096 * static_cast<size_t>(mOptions.scale);
+    std::mt19937 mte(13579u);
+    std::vector<std::array<int, 5>> tuples(numTuples);
+    for (auto& t : tuples)
+    {
+        for (auto& index : t)
+        {
+            index = static_cast<int>(mte() % numPoints);
+        }
+    }
+
+    for (int d = 0; d < 3; d += 2)
+    {
+        auto const input2 = Generate2(d, numPoints);
+        std::vector<Vector2<Number>> points2(numPoints);
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            points2[i] = { input2[i][0], input2[i][1] };
+        }
+        PrimalQuery2<Number> query2(static_cast<int>(numPoints), points2.data());
+
+        Run("predicate", "PrimalQuery2::ToLine", "BSNumber<UIntegerAP32>", gsDatasets[d], 1,
+            numTuples, [&query2, &tuples]()
+            {
+                int64_t checksum = 0;
+                for (auto const& t : tuples)
+                {
+                    checksum += query2.ToLine(t[0], t[1], t[2]);
+                }
+                return checksum;
+            });
+
+        Run("predicate", "PrimalQuery2::ToCircumcircle", "BSNumber<UIntegerAP32>", gsDatasets[d], 1,
+            numTuples, [&query2, &tuples]()
+            {
+                int64_t checksum = 0;
+                for (auto const& t : tuples)
+                {
+                    checksum += query2.ToCircumcircle(t[0], t[1], t[2], t[3]);
+                }
+                return checksum;
+            });
+
+        auto const input3 = Generate3(d, numPoints);
+        std::vector<Vector3<Number>> points3(numPoints);
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            points3[i] = { input3[i][0], input3[i][1], input3[i][2] };
+        }
+        PrimalQuery3<Number> query3(static_cast<int>(numPoints), points3.data());
+
+        Run("predicate", "PrimalQuery3::ToPlane", "BSNumber<UIntegerAP32>", gsDatasets[d], 1,
+            numTuples, [&query3, &tuples]()
+            {
+                int64_t checksum = 0;
+                for (auto const& t : tuples)
+                {
+                    checksum += query3.ToPlane(t[0], t[1], t[2], t[3]);
+                }
+                return checksum;
+            });
+
+        Run("predicate", "PrimalQuery3::ToCircumsphere", "BSNumber<UIntegerAP32>", gsDatasets[d], 1,
+            numTuples, [&query3, &tuples]()
+            {
+                int64_t checksum = 0;
+                for (auto const& t : tuples)
+                {
+                    checksum += query3.ToCircumsphere(t[0], t[1], t[2], t[3], t[4]);
+                }
+                return checksum;
+            });
+    }
+}
+
+void PerformanceBenchmarkConsole::Algorithms()
+{
+    size_t const scale = static_cast<size_t>(mOptions.scale);
+    std::unique_ptr<TaskScheduler> scheduler;
+    if (mOptions.threads > 1)
+    {
+        scheduler = std::make_unique<TaskScheduler>(mOptions.threads);
+    }
+
+    for (int d = 0; d < 3; ++d)
+    {
+        auto const points2 = Generate2(d, 8192 * scale);
+        Run("algorithm", "Delaunay2", "double", gsDatasets[d], 1, 1,
+            [&points2]()
+            {
+                Delaunay2<double> delaunay;
+                delaunay(points2);
+                return static_cast<int64_t>(delaunay.GetNumTriangles());
+            });
+
+        typedef Delaunay3<double, BSNumber<UIntegerAP32>> Delaunay3BS;
+        auto const points3 = Generate3(d, 2048 * scale);
+        int const numPoints3 = static_cast<int>(points3.size());
+        Run("algorithm", "Delaunay3", "double", gsDatasets[d], 1, 1,
+            [&points3, numPoints3]()
+            {
+                Delaunay3BS delaunay;
+                delaunay(numPoints3, points3.data(), 0.0);
+                return static_cast<int64_t>(delaunay.GetNumTetrahedra());
+            });
+        if (scheduler)
+        {
+            Run("algorithm", "Delaunay3", "double", gsDatasets[d], mOptions.threads, 1,
+                [&points3, numPoints3, &scheduler]()
+                {
+                    Delaunay3BS delaunay;
+                    delaunay(numPoints3, points3.data(), 0.0, *scheduler);
+                    return static_cast<int64_t>(delaunay.GetNumTetrahedra());
+                });
+        }
+
+        auto const pointsHull = Generate3(d, 8192 * scale);
+        Run("algorithm", "ConvexHull3", "double", gsDatasets[d], 1, 1,
+            [&pointsHull]()
+            {
+                ConvexHull3<double> hull;
+                hull(pointsHull, 0);
+                return static_cast<int64_t>(hull.GetHull().size());
+            });
+        if (scheduler)
+        {
+            Run("algorithm", "ConvexHull3", "double", gsDatasets[d], mOptions.threads, 1,
+                [&pointsHull, &scheduler]()
+                {
+                    ConvexHull3<double> hull;
+                    hull(pointsHull, *scheduler);
+                    return static_cast<int64_t>(hull.GetHull().size());
+                });
+        }
+    }
+}
+
+void PerformanceBenchmarkConsole::Images()
+{
+    // A sum of Gaussian blobs sampled on a 64x64x(64*scale) lattice.
+    int const bound0 = 64, bound1 = 64, bound2 = 64 * mOptions.scale;
+    std::mt19937 mte(97531u);
+    std::array<Vector3<float>, 8> blobs;
+    for (auto& b : blobs)
+    {
+        b = { static_cast<float>(0.5 + 0.35 * Uniform(mte)),
+            static_cast<float>(0.5 + 0.35 * Uniform(mte)),
+            static_cast<float>(0.5 + 0.35 * Uniform(mte)) };
+    }
+
+    Image3<float> image(bound0, bound1, bound2);
+    for (int z = 0; z < bound2; ++z)
+    {
+        for (int y = 0; y < bound1; ++y)
+        {
+            for (int x = 0; x < bound0; ++x)
+            {
+                Vector3<float> p{ static_cast<float>(x) / bound0,
+                    static_cast<float>(y) / bound1, static_cast<float>(z) / bound2 };
+                float value = 0.0f;
+                for (auto const& b : blobs)
+                {
+                    Vector3<float> diff = p - b;
+                    value += std::exp(-64.0f * Dot(diff, diff));
+                }
+                image(x, y, z) = value;
+            }
+        }
+    }
+    size_t const numVoxels = image.GetNumPixels();
+    float const level = 0.5f;
+    auto countAbove = [level](std::vector<float> const& pixels)
+    {
+        return static_cast<int64_t>(std::count_if(pixels.begin(), pixels.end(),
+            [level](float value) { return value >= level; }));
+    };
+    auto countNonzero = [](std::vector<int> const& pixels)
+    {
+        return static_cast<int64_t>(std::count_if(pixels.begin(), pixels.end(),
+            [](int value) { return value != 0; }));
+    };
+
+    SurfaceExtractorMC<float> extractor(image);
+    std::vector<Vector3<float>> vertices;
+    std::vector<int> indices;
+    Run("image", "SurfaceExtractorMC::Extract", "float", "blobs", 1, numVoxels,
+        [&extractor, &vertices, &indices, level]()
+        {
+            extractor.Extract(level, vertices, indices);
+            return static_cast<int64_t>(indices.size() / 3);
+        });
+
+    std::vector<float> kernel = { 0.0625f, 0.25f, 0.375f, 0.25f, 0.0625f };
+    Image3<float> filtered;
+    Image3<int> binary, morphed;
+    for (size_t threads : { static_cast<size_t>(1), mOptions.threads })
+    {
+        Run("image", "SurfaceExtractorMC::ExtractParallel", "float", "blobs", threads, numVoxels,
+            [&extractor, &vertices, &indices, level, threads]()
+            {
+                extractor.ExtractParallel(level, vertices, indices, threads);
+                return static_cast<int64_t>(indices.size() / 3);
+            });
+
+        Run("image", "ImageUtility3::ConvolveSeparable", "float", "blobs", threads, numVoxels,
+            [&image, &kernel, &filtered, &countAbove, threads]()
+            {
+                ImageUtility3::ConvolveSeparable(image, kernel, kernel, kernel, filtered, threads);
+                return countAbove(filtered.GetPixels());
+            });
+
+        Run("image", "ImageUtility3::Threshold", "float", "blobs", threads, numVoxels,
+            [&image, &binary, &countNonzero, level, threads]()
+            {
+                ImageUtility3::Threshold(image, level, binary, threads);
+                return countNonzero(binary.GetPixels());
+            });
+
+        Run("image", "ImageUtility3::DilateBox", "int", "blobs", threads, numVoxels,
+            [&binary, &morphed, &countNonzero, threads]()
+            {
+                ImageUtility3::DilateBox(binary, 2, 2, 2, morphed, threads);
+                return countNonzero(morphed.GetPixels());
+            });
+
+        Run("image", "ImageUtility3::ErodeBox", "int", "blobs", threads, numVoxels,
+            [&binary, &morphed, &countNonzero, threads]()
+            {
+                ImageUtility3::ErodeBox(binary, 2, 2, 2, true, morphed, threads);
+                return countNonzero(morphed.GetPixels());
+            });
+
+        if (mOptions.threads == 1)
+        {
+            break;
+        }
+    }
+}
+
+void PerformanceBenchmarkConsole::Neighbors()
+{
+    typedef NearestNeighborQuery<3, double, PositionSite<3, double>> Query;
+    int const maxLeafSize = 8, maxLevel = 20;
+    int constexpr maxNeighbors = 16;
+    double const radius = 0.05;
+
+    for (int d = 0; d < 2; ++d)
+    {
+        size_t const numSites = 65536 * static_cast<size_t>(mOptions.scale);
+        auto const points = Generate3(d, numSites);
+        std::vector<PositionSite<3, double>> sites;
+        sites.reserve(numSites);
+        for (auto const& p : points)
+        {
+            sites.emplace_back(p);
+        }
+
+        Run("neighbor", "NearestNeighborQuery::Construct", "double", gsDatasets[d], 1, numSites,
+            [&sites, maxLeafSize, maxLevel]()
+            {
+                Query query(sites, maxLeafSize, maxLevel);
+                return static_cast<int64_t>(query.GetSortedPoints().size());
+            });
+
+        // The query points are the sites of the other dataset, so that the
+        // clustered sites are also queried at points away from them.
+        Query const query(sites, maxLeafSize, maxLevel);
+        auto const queryPoints = Generate3(1 - d, numSites / 4);
+        std::vector<std::array<int, maxNeighbors>> neighbors;
+        std::vector<int> numNeighbors;
+        auto sumNeighbors = [&numNeighbors]()
+        {
+            int64_t checksum = 0;
+            for (auto n : numNeighbors)
+            {
+                checksum += n;
+            }
+            return checksum;
+        };
+
+        for (size_t threads : { static_cast<size_t>(1), mOptions.threads })
+        {
+            Run("neighbor", "NearestNeighborQuery::FindNeighbors", "double", gsDatasets[d], threads,
+                queryPoints.size(), [&, threads]()
+                {
+                    query.FindNeighbors<maxNeighbors>(queryPoints, radius, neighbors,
+                        numNeighbors, threads);
+                    return sumNeighbors();
+                });
+
+            Run("neighbor", "NearestNeighborQuery::FindApproximateNeighbors", "double", gsDatasets[d],
+                threads, queryPoints.size(), [&, threads]()
+                {
+                    query.FindApproximateNeighbors<maxNeighbors>(queryPoints, radius, 0.5, 8,
+                        neighbors, numNeighbors, nullptr, threads);
+                    return sumNeighbors();
+                });
+
+            if (mOptions.threads == 1)
+            {
+                break;
+            }
+        }
+    }
+}
+
+void PerformanceBenchmarkConsole::Graphics()
+{
+    if (!mEngine)
+    {
+        return;
+    }
+
+#if defined(GTE_USE_DIRECTX)
+    std::string const type = "DX11";
+#else
+    std::string const type = "GL45";
+#endif
+
+    // Small spheres with individual vertex and index buffers that share 16
+    // effects, drawn to an offscreen target. The time per draw is the CPU
+    // cost of the submission; the GPU work of a sphere is negligible, and
+    // the frame ends with WaitForFinish so that the draws of a repetition
+    // do not overlap the next one.
+    size_t const numVisuals = 1024 * static_cast<size_t>(mOptions.scale);
+    VertexFormat vformat;
+    vformat.Bind(VA_POSITION, DF_R32G32B32_FLOAT, 0);
+    MeshFactory mf;
+    mf.SetVertexFormat(vformat);
+
+    std::vector<std::shared_ptr<ConstantColorEffect>> effects(16);
+    std::mt19937 mte(8642u);
+    for (auto& effect : effects)
+    {
+        Vector4<float> color{ static_cast<float>(0.5 + 0.5 * Uniform(mte)),
+            static_cast<float>(0.5 + 0.5 * Uniform(mte)),
+            static_cast<float>(0.5 + 0.5 * Uniform(mte)), 1.0f };
+        effect = std::make_shared<ConstantColorEffect>(mProgramFactory, color);
+        effect->SetPVWMatrix(Matrix4x4<float>::Identity());
+        mEngine->Update(effect->GetPVWMatrixConstant());
+    }
+
+    std::vector<std::shared_ptr<Visual>> visuals(numVisuals);
+    for (size_t i = 0; i < numVisuals; ++i)
+    {
+        visuals[i] = mf.CreateSphere(8, 8, 0.01f);
+        visuals[i]->SetEffect(effects[mte() % effects.size()]);
+    }
+
+    auto target = std::make_shared<DrawTarget>(1, DF_R8G8B8A8_UNORM, 256, 256, false, true,
+        DF_D24_UNORM_S8_UINT, false);
+
+    Run("graphics", "GraphicsEngine::Draw(Visual)", type, "spheres", 1, numVisuals,
+        [this, &visuals, &target]()
+        {
+            mEngine->Enable(target);
+            mEngine->ClearBuffers();
+            for (auto const& visual : visuals)
+            {
+                mEngine->Draw(visual);
+            }
+            mEngine->Disable(target);
+            mEngine->WaitForFinish();
+            return static_cast<int64_t>(visuals.size());
+        });
+
+    Run("graphics", "GraphicsEngine::Draw(visuals)", type, "spheres", 1, numVisuals,
+        [this, &visuals, &target]()
+        {
+            mEngine->Enable(target);
+            mEngine->ClearBuffers();
+            mEngine->Draw(visuals);
+            mEngine->Disable(target);
+            mEngine->WaitForFinish();
+            return static_cast<int64_t>(visuals.size());
+        });
+}
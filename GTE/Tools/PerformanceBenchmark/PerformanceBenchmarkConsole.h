@@ -0,0 +1,108 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#pragma once
+
+#include "BenchmarkReport.h"
+#include <Applications/Console.h>
+#include <Mathematics/Vector2.h>
+#include <Mathematics/Vector3.h>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+using namespace gte;
+
+// Timings of the algorithms of the Mathematics and Graphics libraries on
+// reproducible datasets. The categories of benchmarks are
+//   query:     distance and intersection queries, one pair at a time
+//              (DCPQuery, TIQuery, FIQuery) and in batches
+//              (DistPoint3Batch, IntrRay3Batch)
+//   predicate: the exact predicates of PrimalQuery2 and PrimalQuery3 for
+//              BSNumber<UIntegerAP32>
+//   algorithm: Delaunay2, Delaunay3 and ConvexHull3
+//   image:     SurfaceExtractorMC and the ImageUtility3 filters
+//   neighbor:  NearestNeighborQuery construction and queries
+//   graphics:  the CPU cost of GraphicsEngine draw submission
+// The algorithms that support threads are run with 1 thread and with the
+// number of threads of the options.
+//
+// The datasets are generated from std::mt19937 with fixed seeds. The
+// output of std::mt19937 is specified by the C++ standard, and the values
+// are converted to floating-point numbers without the implementation-
+// defined std distributions, so the datasets are the same on all platforms.
+// Each benchmark computes a checksum of its results, for example a count of
+// intersections or of triangles. The checksum must not change between
+// repetitions; a checksum that differs from that of a previous run means
+// the results of the algorithm have changed.
+//
+// The results are written in the JSON format of BenchmarkReport. When a
+// baseline report is specified, the results are compared with it and the
+// comparison table is written to standard error.
+
+class PerformanceBenchmarkConsole : public Console
+{
+public:
+    struct Options
+    {
+        Options();
+
+        int repetitions;
+        int scale;
+        size_t threads;
+        std::string filter;
+        std::string output;
+        std::string baseline;
+        double tolerance;
+    };
+
+    PerformanceBenchmarkConsole(Parameters& parameters);
+
+    // Set the options before Execute is called.
+    inline void SetOptions(Options const& options)
+    {
+        mOptions = options;
+    }
+
+    virtual void Execute() override;
+
+    // The result of Execute: 0 on success, 1 when the output or baseline
+    // files cannot be used, 2 when a benchmark throws and 3 when results
+    // are slower than the baseline by more than the tolerance.
+    inline int GetStatus() const
+    {
+        return mStatus;
+    }
+
+private:
+    // Time 'function', which performs 'size' operations and returns a
+    // checksum of its results. The function is called once to warm up and
+    // then 'repetitions' times. The times are per operation.
+    void Run(std::string const& category, std::string const& name,
+        std::string const& type, std::string const& dataset, size_t threads,
+        size_t size, std::function<int64_t()> const& function);
+
+    // Reproducible datasets. The uniform points are in [-1,1]^d, the
+    // clustered points are within 1/1000 of 16 centers and the degenerate
+    // points are those of an integer grid in a random order, which has
+    // many collinear, cocircular, coplanar and cospherical subsets.
+    static double Uniform(std::mt19937& mte);
+    static std::vector<Vector2<double>> Generate2(int dataset, size_t size);
+    static std::vector<Vector3<double>> Generate3(int dataset, size_t size);
+
+    void Queries();
+    void Predicates();
+    void Algorithms();
+    void Images();
+    void Neighbors();
+    void Graphics();
+
+    Options mOptions;
+    BenchmarkReport mReport;
+    int mStatus;
+};
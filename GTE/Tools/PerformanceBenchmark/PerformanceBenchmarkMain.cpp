@@ -0,0 +1,110 @@
+// David Eberly, Geometric Tools, Redmond WA 98052
+// Copyright (c) 1998-2021
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+// https://www.geometrictools.com/License/Boost/LICENSE_1_0.txt
+// Version: 4.0.2026.10.15
+
+#include "PerformanceBenchmarkConsole.h"
+#include <Applications/LogReporter.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+// usage: PerformanceBenchmark [-r repetitions] [-s scale] [-t threads]
+//            [-f filter] [-o file] [-c baseline] [-x tolerance]
+//   repetitions = number of timed repetitions of each benchmark (default 5)
+//   scale       = multiplier of the default dataset sizes (default 1)
+//   threads     = number of threads of the multithreaded algorithms
+//                 (default is the number of hardware threads)
+//   filter      = run only benchmarks whose category/name contains filter
+//   file        = the JSON output file (default is standard output)
+//   baseline    = a JSON output file of a previous run to compare with
+//   tolerance   = the relative slowdown, in percent, above which a result
+//                 is reported as slower than the baseline (default 10)
+// The exit code is 0 on success, 1 for invalid arguments or files, 2 when
+// a benchmark fails and 3 when results are slower than the baseline.
+
+namespace
+{
+    bool ParseOptions(int numArguments, char* arguments[],
+        PerformanceBenchmarkConsole::Options& options)
+    {
+        for (int i = 1; i < numArguments; ++i)
+        {
+            std::string const argument = arguments[i];
+            if (i + 1 == numArguments)
+            {
+                return false;
+            }
+            std::string const value = arguments[++i];
+            if (argument == "-r")
+            {
+                options.repetitions = std::atoi(value.c_str());
+            }
+            else if (argument == "-s")
+            {
+                options.scale = std::atoi(value.c_str());
+            }
+            else if (argument == "-t")
+            {
+                options.threads = static_cast<size_t>(std::max(std::atoi(value.c_str()), 0));
+            }
+            else if (argument == "-f")
+            {
+                options.filter = value;
+            }
+            else if (argument == "-o")
+            {
+                options.output = value;
+            }
+            else if (argument == "-c")
+            {
+                options.baseline = value;
+            }
+            else if (argument == "-x")
+            {
+                options.tolerance = 0.01 * std::atof(value.c_str());
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return options.repetitions > 0 && options.scale > 0 && options.threads > 0
+            && options.tolerance >= 0.0;
+    }
+}
+
+int main(int numArguments, char* arguments[])
+{
+#if defined(_DEBUG)
+    LogReporter reporter(
+        "LogReport.txt",
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL,
+        Logger::Listener::LISTEN_FOR_ALL);
+#endif
+
+    PerformanceBenchmarkConsole::Options options;
+    if (!ParseOptions(numArguments, arguments, options))
+    {
+        std::cerr << "usage: PerformanceBenchmark [-r repetitions] [-s scale] [-t threads] "
+            << "[-f filter] [-o file] [-c baseline] [-x tolerance]" << std::endl;
+        return 1;
+    }
+
+    Console::Parameters parameters(L"PerformanceBenchmarkConsole");
+    auto console = TheConsoleSystem.Create<PerformanceBenchmarkConsole>(parameters);
+    if (!console)
+    {
+        std::cerr << "Cannot create the graphics engine." << std::endl;
+        return 1;
+    }
+    console->SetOptions(options);
+    TheConsoleSystem.Execute(console);
+    int const status = console->GetStatus();
+    TheConsoleSystem.Destroy(console);
+    return status;
+}